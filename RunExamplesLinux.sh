@@ -29,6 +29,7 @@ options=(
 	"Animation"
 	"Stencil Buffer"
 	"Volume Rendering"
+	"GPU-Driven Culling"
 )
 select opt in "${options[@]}"
 do
@@ -78,6 +79,9 @@ do
 	"${options[14]}")
 		(cd examples/Cpp/VolumeRendering; ../../../$BUILD_DIR/Example_VolumeRendering)
 		;;
+	"${options[15]}")
+		(cd examples/Cpp/GPUDrivenCulling; ../../../$BUILD_DIR/Example_GPUDrivenCulling)
+		;;
 	*)
 		echo "invalid selection";;
 	esac
@@ -201,14 +201,29 @@ void ExampleBase::Run()
                 std::cout << "FRAME TIME RECORDS:\n";
                 std::cout << "-------------------\n";
                 for (const auto& rec : profilerObj_->frameProfile.timeRecords)
-                    std::cout << rec.annotation << ": " << rec.elapsedTime << " ns\n";
+                    std::cout << std::string(rec.depth * 2, ' ') << rec.annotation << ": " << rec.elapsedTime << " ns\n";
 
-                profilerObj_->timeRecordingEnabled = false;
+                std::cout << "\n";
+                std::cout << "FRAME STATE CHANGES:\n";
+                std::cout << "--------------------\n";
+                for (const auto& rec : profilerObj_->frameProfile.stateChangeRecords)
+                {
+                    const auto numSwitches = rec.numCalls - rec.numRedundantCalls;
+                    std::cout << (*rec.annotation != '\0' ? rec.annotation : "<global>") << ": " << rec.command << ": ";
+                    std::cout << rec.numCalls << " calls, " << rec.numRedundantCalls << " redundant";
+                    if (rec.numDistinctStates > 0 && rec.numDistinctStates < numSwitches)
+                        std::cout << " (switches could drop from " << numSwitches << " to " << rec.numDistinctStates << " if sorted by " << rec.sortKey << ")";
+                    std::cout << '\n';
+                }
+
+                profilerObj_->timeRecordingEnabled          = timeRecording_;
+                profilerObj_->stateChangeAnalysisEnabled    = false;
                 showTimeRecords = false;
             }
             else if (input.KeyDown(LLGL::Key::F1))
             {
-                profilerObj_->timeRecordingEnabled = true;
+                profilerObj_->timeRecordingEnabled          = true;
+                profilerObj_->stateChangeAnalysisEnabled    = true;
                 showTimeRecords = true;
             }
             profilerObj_->NextProfile();
@@ -414,6 +429,9 @@ LLGL::Shader* ExampleBase::LoadShaderInternal(
             case LLGL::ShaderType::Fragment:
                 deviceShaderDesc.fragment.outputAttribs = fragmentAttribs;
                 break;
+            case LLGL::ShaderType::Compute:
+                deviceShaderDesc.compute.workGroupSize = shaderDesc.workGroupSize;
+                break;
             default:
                 break;
         }
@@ -704,6 +722,13 @@ bool ExampleBase::Supported(const LLGL::ShadingLanguage shadingLanguage) const
     return (std::find(languages.begin(), languages.end(), shadingLanguage) != languages.end());
 }
 
+void ExampleBase::SetTimeRecording(bool enabled)
+{
+    timeRecording_ = enabled;
+    if (debuggerObj_)
+        profilerObj_->timeRecordingEnabled = enabled;
+}
+
 const std::string& ExampleBase::GetModuleName()
 {
     return rendererModule_;
@@ -102,6 +102,7 @@ protected:
         std::string         filename;
         std::string         entryPoint;
         std::string         profile;
+        LLGL::Extent3D      workGroupSize   = { 1, 1, 1 }; // Only required for Metal compute shaders
     };
 
 private:
@@ -134,6 +135,7 @@ private:
     std::unique_ptr<LLGL::RenderingDebugger>    debuggerObj_;
 
     bool                                        loadingDone_        = false;
+    bool                                        timeRecording_      = false;
 
     static std::string                          rendererModule_;
 
@@ -288,6 +290,9 @@ protected:
     // Returns true if the specified shading language is supported.
     bool Supported(const LLGL::ShadingLanguage shadingLanguage) const;
 
+    // Enables or disables time recording of the rendering profiler for all frames (if debugging is enabled). See RenderingProfiler::timeRecordingEnabled.
+    void SetTimeRecording(bool enabled);
+
     // Returns the number of samples that was used when the swap-chain was created.
     inline std::uint32_t GetSampleCount() const
     {
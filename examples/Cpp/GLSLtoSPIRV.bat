@@ -48,6 +48,11 @@ glslangValidator -V -S comp -o ComputeShader/Example.comp.spv ComputeShader/Exam
 glslangValidator -V -S vert -o ComputeShader/Example.vert.spv ComputeShader/Example.vert
 glslangValidator -V -S frag -o ComputeShader/Example.frag.spv ComputeShader/Example.frag
 
+echo ####### GPUDrivenCulling #######
+glslangValidator -V -S comp -o GPUDrivenCulling/Example.comp.spv GPUDrivenCulling/Example.comp
+glslangValidator -V -S vert -o GPUDrivenCulling/Example.vert.spv GPUDrivenCulling/Example.vert
+glslangValidator -V -S frag -o GPUDrivenCulling/Example.frag.spv GPUDrivenCulling/Example.frag
+
 echo ####### Instancing #######
 glslangValidator -V -S vert -o Instancing/Example.450core.vert.spv Instancing/Example.450core.vert
 glslangValidator -V -S frag -o Instancing/Example.450core.frag.spv Instancing/Example.450core.frag
@@ -0,0 +1,501 @@
+/*
+ * Example.cpp (Example_GPUDrivenCulling)
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <ExampleBase.h>
+#include <LLGL/ProfileFrameHistory.h>
+#include <cstring>
+
+
+class Example_GPUDrivenCulling : public ExampleBase
+{
+
+    static const std::uint32_t  numObjectsPerRow    = 64;
+    static const std::uint32_t  numObjects          = numObjectsPerRow * numObjectsPerRow;
+    static const std::uint32_t  numThreadsPerGroup  = 64;
+    static const std::uint32_t  numStatsFrames      = 120;
+
+    // Flags for the culling settings; must match the shaders
+    enum CullingFlags : std::uint32_t
+    {
+        FrustumCulling      = (1 << 0),
+        OcclusionCulling    = (1 << 1),
+        DrawCompaction      = (1 << 2),
+    };
+
+    LLGL::VertexFormat          vertexFormat[2];
+
+    LLGL::Buffer*               vertexBuffer        = nullptr;
+    LLGL::Buffer*               indexBuffer         = nullptr;
+    LLGL::Buffer*               instanceBuffer      = nullptr;
+    LLGL::BufferArray*          vertexBufferArray   = nullptr;
+
+    LLGL::Buffer*               cullingBuffer       = nullptr;
+    LLGL::Buffer*               sceneBuffer         = nullptr;
+    LLGL::Buffer*               drawArgBuffer       = nullptr;
+    LLGL::Buffer*               drawCountBuffer     = nullptr;
+
+    LLGL::Shader*               computeShader       = nullptr;
+    LLGL::PipelineLayout*       computeLayout       = nullptr;
+    LLGL::PipelineState*        computePipeline     = nullptr;
+    LLGL::ResourceHeap*         computeResourceHeap = nullptr;
+
+    ShaderPipeline              graphicsShaders;
+    LLGL::PipelineLayout*       graphicsLayout      = nullptr;
+    LLGL::PipelineState*        graphicsPipeline    = nullptr;
+    LLGL::ResourceHeap*         graphicsResourceHeap = nullptr;
+
+    std::uint32_t               numIndices          = 0;
+    std::uint32_t               cullingFlags        = (FrustumCulling | OcclusionCulling | DrawCompaction);
+    bool                        indirectCountDrawing = false;
+
+    LLGL::ProfileFrameHistory   frameHistory        { numStatsFrames };
+    std::uint32_t               frameCounter        = 0;
+
+    float                       cameraAngle         = 0.0f;
+    bool                        cameraPaused        = false;
+
+    // Per-instance data; the last instance is the occluder wall, which is drawn without culling
+    struct Instance
+    {
+        Gs::Vector4f    position;   // XYZ = world position
+        Gs::Vector4f    halfSize;   // XYZ = half extent of the box
+        LLGL::ColorRGBAf color;
+    };
+
+    struct CullingSettings
+    {
+        Gs::Vector4f    frustumPlanes[6];
+        Gs::Vector4f    viewPos;
+        Gs::Vector4f    occluderMin;
+        Gs::Vector4f    occluderMax;
+        std::uint32_t   numObjects;
+        std::uint32_t   numIndices;
+        std::uint32_t   flags;
+        std::uint32_t   _pad0;
+    }
+    cullingSettings;
+
+    struct SceneSettings
+    {
+        Gs::Matrix4f    vpMatrix;
+        Gs::Vector4f    lightDir;
+    }
+    sceneSettings;
+
+    Gs::Vector3f        occluderMin { -16.0f,  0.0f, -0.25f };
+    Gs::Vector3f        occluderMax { +16.0f, 10.0f, +0.25f };
+
+public:
+
+    Example_GPUDrivenCulling() :
+        ExampleBase { L"LLGL Example: GPU-Driven Culling" }
+    {
+        // Check if compute shaders and indirect drawing are supported
+        const auto& renderCaps = renderer->GetRenderingCaps();
+
+        if (!renderCaps.features.hasComputeShaders)
+            throw std::runtime_error("compute shaders are not supported by this renderer");
+        if (!renderCaps.features.hasIndirectDrawing)
+            throw std::runtime_error("indirect drawing is not supported by this renderer");
+
+        // Only Vulkan has no fallback for indirect draw commands with a count buffer
+        indirectCountDrawing = (renderCaps.features.hasIndirectCountDrawing || !IsVulkan());
+
+        // Create all graphics objects
+        CreateBuffers();
+        CreateComputePipeline();
+        CreateGraphicsPipeline();
+
+        // Add debugging names
+        commands->SetName("Commands");
+        vertexBuffer->SetName("Vertices");
+        indexBuffer->SetName("Indices");
+        instanceBuffer->SetName("Instances");
+        cullingBuffer->SetName("CullingSettings");
+        sceneBuffer->SetName("SceneSettings");
+        drawArgBuffer->SetName("DrawArguments");
+        drawCountBuffer->SetName("DrawCount");
+        computePipeline->SetName("Culling.Pipeline");
+        graphicsPipeline->SetName("Drawing.Pipeline");
+
+        // Record GPU times of the debug groups in every frame
+        SetTimeRecording(true);
+
+        // Print some information on the standard output
+        std::cout << "press TAB KEY to cycle through the culling modes" << std::endl;
+        std::cout << "press SPACE KEY to pause the camera" << std::endl;
+        PrintCullingMode();
+    }
+
+private:
+
+    void CreateBuffers()
+    {
+        // Specify vertex formats
+        vertexFormat[0].AppendAttribute({ "position", LLGL::Format::RGB32Float });
+
+        vertexFormat[1].attributes =
+        {
+            LLGL::VertexAttribute{ "instancePos",   LLGL::Format::RGBA32Float, /*location:*/ 1, /*offset:*/  0, /*stride:*/ sizeof(Instance), /*slot:*/ 1, /*instanceDivisor:*/ 1 },
+            LLGL::VertexAttribute{ "instanceSize",  LLGL::Format::RGBA32Float, /*location:*/ 2, /*offset:*/ 16, /*stride:*/ sizeof(Instance), /*slot:*/ 1, /*instanceDivisor:*/ 1 },
+            LLGL::VertexAttribute{ "instanceColor", LLGL::Format::RGBA32Float, /*location:*/ 3, /*offset:*/ 32, /*stride:*/ sizeof(Instance), /*slot:*/ 1, /*instanceDivisor:*/ 1 },
+        };
+
+        // Create vertex and index buffers for a unit cube
+        auto vertices = GenerateCubeVertices();
+        auto indices = GenerateCubeTriangleIndices();
+        numIndices = static_cast<std::uint32_t>(indices.size());
+
+        vertexBuffer = CreateVertexBuffer(vertices, vertexFormat[0]);
+        indexBuffer = CreateIndexBuffer(indices, LLGL::Format::R32UInt);
+
+        // Generate a grid of randomly sized boxes on the ground and one large occluder wall in the center
+        std::vector<Instance> instances(numObjects + 1);
+
+        std::mt19937 rng{ 1337u };
+        std::uniform_real_distribution<float> sizeDist{ 0.2f, 0.6f };
+        std::uniform_real_distribution<float> colorDist{ 0.3f, 1.0f };
+
+        const float spacing = 1.5f;
+        const float offset  = -spacing * static_cast<float>(numObjectsPerRow - 1) * 0.5f;
+
+        for (std::uint32_t i = 0; i < numObjects; ++i)
+        {
+            auto& inst = instances[i];
+            const float size = sizeDist(rng);
+            inst.position   = { offset + spacing * static_cast<float>(i % numObjectsPerRow), size, offset + spacing * static_cast<float>(i / numObjectsPerRow), 1.0f };
+            inst.halfSize   = { size, size, size, 0.0f };
+            inst.color      = { colorDist(rng), colorDist(rng), colorDist(rng), 1.0f };
+        }
+
+        auto& wall = instances[numObjects];
+        {
+            const auto center = (occluderMin + occluderMax) * 0.5f;
+            const auto extent = (occluderMax - occluderMin) * 0.5f;
+            wall.position   = { center.x, center.y, center.z, 1.0f };
+            wall.halfSize   = { extent.x, extent.y, extent.z, 0.0f };
+            wall.color      = { 0.5f, 0.5f, 0.5f, 1.0f };
+        }
+
+        // Create instance buffer, which is read by the culling shader and fed into the vertex shader per instance
+        LLGL::BufferDescriptor instanceBufferDesc;
+        {
+            instanceBufferDesc.size             = GetArraySize(instances);
+            instanceBufferDesc.bindFlags        = LLGL::BindFlags::VertexBuffer | LLGL::BindFlags::Storage;
+            instanceBufferDesc.vertexAttribs    = vertexFormat[1].attributes;
+            instanceBufferDesc.format           = LLGL::Format::RGBA32Float;
+        }
+        instanceBuffer = renderer->CreateBuffer(instanceBufferDesc, instances.data());
+
+        // Create vertex array buffer
+        LLGL::Buffer* buffers[] = { vertexBuffer, instanceBuffer };
+        vertexBufferArray = renderer->CreateBufferArray(2, buffers);
+
+        // Create constant buffers
+        cullingBuffer = renderer->CreateBuffer(LLGL::ConstantBufferDesc(sizeof(CullingSettings)));
+        sceneBuffer = renderer->CreateBuffer(LLGL::ConstantBufferDesc(sizeof(SceneSettings)));
+
+        // Create indirect argument buffer with one draw command per object; it's written as array of 32-bit integers by the culling shader
+        LLGL::BufferDescriptor argBufferDesc;
+        {
+            argBufferDesc.size      = sizeof(LLGL::DrawIndexedIndirectArguments) * numObjects;
+            argBufferDesc.bindFlags = LLGL::BindFlags::IndirectBuffer | LLGL::BindFlags::Storage;
+            argBufferDesc.format    = LLGL::Format::R32UInt;
+        }
+        drawArgBuffer = renderer->CreateBuffer(argBufferDesc);
+
+        // Create buffer for the number of compacted draw commands
+        LLGL::BufferDescriptor countBufferDesc;
+        {
+            countBufferDesc.size        = sizeof(std::uint32_t);
+            countBufferDesc.bindFlags   = LLGL::BindFlags::IndirectBuffer | LLGL::BindFlags::Storage | LLGL::BindFlags::CopyDst;
+            countBufferDesc.format      = LLGL::Format::R32UInt;
+        }
+        drawCountBuffer = renderer->CreateBuffer(countBufferDesc);
+    }
+
+    void CreateComputePipeline()
+    {
+        // Create compute shader
+        if (Supported(LLGL::ShadingLanguage::GLSL))
+            computeShader = LoadShader({ LLGL::ShaderType::Compute, "Example.comp" });
+        else if (Supported(LLGL::ShadingLanguage::SPIRV))
+            computeShader = LoadShader({ LLGL::ShaderType::Compute, "Example.comp.spv" });
+        else if (Supported(LLGL::ShadingLanguage::HLSL))
+            computeShader = LoadShader({ LLGL::ShaderType::Compute, "Example.hlsl", "CS", "cs_5_0" });
+        else if (Supported(LLGL::ShadingLanguage::Metal))
+        {
+            TutorialShaderDescriptor shaderDesc{ LLGL::ShaderType::Compute, "Example.metal", "CS", "1.1" };
+            shaderDesc.workGroupSize = { numThreadsPerGroup, 1, 1 };
+            computeShader = LoadShader(shaderDesc);
+        }
+        else
+            throw std::runtime_error("shaders not available for selected renderer in this example");
+
+        // Create compute pipeline layout
+        computeLayout = renderer->CreatePipelineLayout(
+            LLGL::PipelineLayoutDesc("cbuffer(1):comp, rwbuffer(2):comp, rwbuffer(3):comp, rwbuffer(4):comp")
+        );
+
+        // Create compute pipeline
+        LLGL::ComputePipelineDescriptor pipelineDesc;
+        {
+            pipelineDesc.computeShader  = computeShader;
+            pipelineDesc.pipelineLayout = computeLayout;
+        }
+        computePipeline = renderer->CreatePipelineState(pipelineDesc);
+        ThrowIfFailed(computePipeline);
+
+        // Create resource heap for compute pipeline
+        computeResourceHeap = renderer->CreateResourceHeap(computeLayout, { cullingBuffer, instanceBuffer, drawArgBuffer, drawCountBuffer });
+    }
+
+    void CreateGraphicsPipeline()
+    {
+        // Create graphics shaders
+        if (Supported(LLGL::ShadingLanguage::GLSL))
+        {
+            graphicsShaders.vs = LoadShader({ LLGL::ShaderType::Vertex,   "Example.vert" }, { vertexFormat[0], vertexFormat[1] });
+            graphicsShaders.ps = LoadShader({ LLGL::ShaderType::Fragment, "Example.frag" });
+        }
+        else if (Supported(LLGL::ShadingLanguage::SPIRV))
+        {
+            graphicsShaders.vs = LoadShader({ LLGL::ShaderType::Vertex,   "Example.vert.spv" }, { vertexFormat[0], vertexFormat[1] });
+            graphicsShaders.ps = LoadShader({ LLGL::ShaderType::Fragment, "Example.frag.spv" });
+        }
+        else if (Supported(LLGL::ShadingLanguage::HLSL))
+        {
+            graphicsShaders.vs = LoadShader({ LLGL::ShaderType::Vertex,   "Example.hlsl", "VS", "vs_5_0" }, { vertexFormat[0], vertexFormat[1] });
+            graphicsShaders.ps = LoadShader({ LLGL::ShaderType::Fragment, "Example.hlsl", "PS", "ps_5_0" });
+        }
+        else if (Supported(LLGL::ShadingLanguage::Metal))
+        {
+            graphicsShaders.vs = LoadShader({ LLGL::ShaderType::Vertex,   "Example.metal", "VS", "1.1" }, { vertexFormat[0], vertexFormat[1] });
+            graphicsShaders.ps = LoadShader({ LLGL::ShaderType::Fragment, "Example.metal", "PS", "1.1" });
+        }
+        else
+            throw std::runtime_error("shaders not available for selected renderer in this example");
+
+        // Create graphics pipeline layout
+        graphicsLayout = renderer->CreatePipelineLayout(LLGL::PipelineLayoutDesc("cbuffer(2):vert"));
+
+        // Create graphics pipeline
+        LLGL::GraphicsPipelineDescriptor pipelineDesc;
+        {
+            pipelineDesc.vertexShader                   = graphicsShaders.vs;
+            pipelineDesc.fragmentShader                 = graphicsShaders.ps;
+            pipelineDesc.pipelineLayout                 = graphicsLayout;
+            pipelineDesc.depth.testEnabled              = true;
+            pipelineDesc.depth.writeEnabled             = true;
+            pipelineDesc.rasterizer.cullMode            = LLGL::CullMode::Back;
+            pipelineDesc.rasterizer.multiSampleEnabled  = (GetSampleCount() > 1);
+        }
+        graphicsPipeline = renderer->CreatePipelineState(pipelineDesc);
+        ThrowIfFailed(graphicsPipeline);
+
+        // Create resource heap for graphics pipeline
+        graphicsResourceHeap = renderer->CreateResourceHeap(graphicsLayout, { sceneBuffer });
+    }
+
+    void PrintCullingMode()
+    {
+        std::cout << "culling mode: ";
+        if ((cullingFlags & (FrustumCulling | OcclusionCulling)) == 0)
+            std::cout << "none";
+        else
+        {
+            if ((cullingFlags & FrustumCulling) != 0)
+                std::cout << "frustum";
+            if ((cullingFlags & OcclusionCulling) != 0)
+                std::cout << ((cullingFlags & FrustumCulling) != 0 ? " + occlusion" : "occlusion");
+        }
+        if ((cullingFlags & DrawCompaction) != 0)
+            std::cout << ", compacted draws (" << (indirectCountDrawing ? "DrawIndexedIndirectCount" : "DrawIndexedIndirect") << ")";
+        else
+            std::cout << ", sparse draws (DrawIndexedIndirect)";
+        std::cout << std::endl;
+    }
+
+    void CycleCullingMode()
+    {
+        static const std::uint32_t modes[] =
+        {
+            0,
+            FrustumCulling,
+            FrustumCulling | OcclusionCulling,
+            FrustumCulling | OcclusionCulling | DrawCompaction,
+        };
+
+        std::size_t current = 0;
+        for (std::size_t i = 0; i < sizeof(modes)/sizeof(modes[0]); ++i)
+        {
+            if (modes[i] == cullingFlags)
+                current = i;
+        }
+        cullingFlags = modes[(current + 1) % (sizeof(modes)/sizeof(modes[0]))];
+
+        PrintCullingMode();
+        frameHistory.Clear();
+        frameCounter = 0;
+    }
+
+    // Extracts the normalized plane from the specified row combination of the view-projection matrix.
+    Gs::Vector4f MakeFrustumPlane(const Gs::Matrix4f& m, int row, float sign, bool addW)
+    {
+        Gs::Vector4f plane
+        {
+            m(row, 0) * sign + (addW ? m(3, 0) : 0.0f),
+            m(row, 1) * sign + (addW ? m(3, 1) : 0.0f),
+            m(row, 2) * sign + (addW ? m(3, 2) : 0.0f),
+            m(row, 3) * sign + (addW ? m(3, 3) : 0.0f),
+        };
+        const float len = Gs::Vector3f{ plane.x, plane.y, plane.z }.Length();
+        return plane / len;
+    }
+
+    void UpdateSettings()
+    {
+        // Update camera orbit around the occluder wall
+        if (!cameraPaused)
+            cameraAngle += static_cast<float>(timer.GetDeltaTime()) * 0.2f;
+
+        const Gs::Vector3f viewPos{ std::sin(cameraAngle) * 30.0f, 6.0f, std::cos(cameraAngle) * 30.0f };
+
+        Gs::Matrix4f vMatrix;
+        vMatrix.LoadIdentity();
+        Gs::Translate(vMatrix, viewPos);
+        Gs::RotateFree(vMatrix, Gs::Vector3f{ 0, 1, 0 }, cameraAngle + Gs::pi);
+        Gs::RotateFree(vMatrix, Gs::Vector3f{ 1, 0, 0 }, Gs::Deg2Rad(10.0f));
+
+        sceneSettings.vpMatrix = projection * vMatrix.Inverse();
+        sceneSettings.lightDir = Gs::Vector4f{ -0.3f, 0.8f, 0.5f, 0.0f }.Normalized();
+
+        // Extract frustum planes (Gribb-Hartmann); the near plane depends on the clipping range of the renderer
+        const auto& m = sceneSettings.vpMatrix;
+        const bool unitCube = (renderer->GetRenderingCaps().clippingRange == LLGL::ClippingRange::MinusOneToOne);
+
+        cullingSettings.frustumPlanes[0] = MakeFrustumPlane(m, 0, +1.0f, true);      // Left
+        cullingSettings.frustumPlanes[1] = MakeFrustumPlane(m, 0, -1.0f, true);      // Right
+        cullingSettings.frustumPlanes[2] = MakeFrustumPlane(m, 1, +1.0f, true);      // Bottom
+        cullingSettings.frustumPlanes[3] = MakeFrustumPlane(m, 1, -1.0f, true);      // Top
+        cullingSettings.frustumPlanes[4] = MakeFrustumPlane(m, 2, +1.0f, unitCube);  // Near
+        cullingSettings.frustumPlanes[5] = MakeFrustumPlane(m, 2, -1.0f, true);      // Far
+
+        cullingSettings.viewPos     = { viewPos.x, viewPos.y, viewPos.z, 1.0f };
+        cullingSettings.occluderMin = { occluderMin.x, occluderMin.y, occluderMin.z, 0.0f };
+        cullingSettings.occluderMax = { occluderMax.x, occluderMax.y, occluderMax.z, 0.0f };
+        cullingSettings.numObjects  = numObjects;
+        cullingSettings.numIndices  = numIndices;
+        cullingSettings.flags       = cullingFlags;
+    }
+
+    void PrintStatistics()
+    {
+        const auto& stats = frameHistory.GetStatistics();
+
+        std::cout << "frames: " << stats.numFrames;
+        for (const auto& scope : stats.scopes)
+        {
+            if (std::strcmp(scope.annotation, "Culling") == 0 || std::strcmp(scope.annotation, "Drawing") == 0)
+                std::cout << ", " << scope.annotation << ": " << (static_cast<double>(scope.averageTime) / 1.0e6) << " ms (max " << (static_cast<double>(scope.maxTime) / 1.0e6) << " ms)";
+        }
+        if (stats.scopes.empty())
+            std::cout << ", no GPU time records available (debugger disabled?)";
+        std::cout << std::endl;
+    }
+
+    void OnDrawFrame() override
+    {
+        timer.MeasureTime();
+
+        // Process user input
+        if (input.KeyDown(LLGL::Key::Tab))
+            CycleCullingMode();
+        if (input.KeyDown(LLGL::Key::Space))
+            cameraPaused = !cameraPaused;
+
+        UpdateSettings();
+
+        // Record and submit culling commands; debug groups can't span multiple command buffers
+        commands->Begin();
+        {
+            commands->PushDebugGroup("Culling");
+            {
+                commands->UpdateBuffer(*cullingBuffer, 0, &cullingSettings, sizeof(cullingSettings));
+                commands->FillBuffer(*drawCountBuffer, 0, 0, sizeof(std::uint32_t));
+
+                // Without a count buffer, all draw commands are submitted, so the ones after the compacted range must be empty
+                if ((cullingFlags & DrawCompaction) != 0 && !indirectCountDrawing)
+                    commands->FillBuffer(*drawArgBuffer, 0, 0);
+
+                // Cull one object per thread and write its draw command into the indirect argument buffer
+                commands->SetPipelineState(*computePipeline);
+                commands->SetResourceHeap(*computeResourceHeap);
+                commands->Dispatch((numObjects + numThreadsPerGroup - 1) / numThreadsPerGroup, 1, 1);
+
+                commands->ResetResourceSlots(LLGL::ResourceType::Buffer, 2, 3, LLGL::BindFlags::Storage, LLGL::StageFlags::ComputeStage);
+            }
+            commands->PopDebugGroup();
+        }
+        commands->End();
+        commandQueue->Submit(*commands);
+
+        // Record and submit graphics commands
+        commands->Begin();
+        {
+            commands->PushDebugGroup("Drawing");
+            {
+                commands->UpdateBuffer(*sceneBuffer, 0, &sceneSettings, sizeof(sceneSettings));
+
+                commands->BeginRenderPass(*swapChain);
+                {
+                    commands->Clear(LLGL::ClearFlags::ColorDepth, backgroundColor);
+                    commands->SetViewport(swapChain->GetResolution());
+
+                    commands->SetVertexBufferArray(*vertexBufferArray);
+                    commands->SetIndexBuffer(*indexBuffer);
+
+                    commands->SetPipelineState(*graphicsPipeline);
+                    commands->SetResourceHeap(*graphicsResourceHeap);
+
+                    // Draw occluder wall, which is stored after all culled objects in the instance buffer
+                    commands->DrawIndexedInstanced(numIndices, 1, 0, 0, numObjects);
+
+                    // Draw all objects that survived the culling pass
+                    const auto stride = static_cast<std::uint32_t>(sizeof(LLGL::DrawIndexedIndirectArguments));
+                    if ((cullingFlags & DrawCompaction) != 0 && indirectCountDrawing)
+                        commands->DrawIndexedIndirectCount(*drawArgBuffer, 0, *drawCountBuffer, 0, numObjects, stride);
+                    else
+                        commands->DrawIndexedIndirect(*drawArgBuffer, 0, numObjects, stride);
+
+                    commands->ResetResourceSlots(LLGL::ResourceType::Buffer, 1, 1, LLGL::BindFlags::VertexBuffer, LLGL::StageFlags::VertexStage);
+                }
+                commands->EndRenderPass();
+            }
+            commands->PopDebugGroup();
+        }
+        commands->End();
+        commandQueue->Submit(*commands);
+
+        // Report average culling and drawing times
+        frameHistory.Append(profiler.frameProfile);
+        if (++frameCounter == numStatsFrames)
+        {
+            PrintStatistics();
+            frameCounter = 0;
+        }
+
+        // Present result on the screen
+        swapChain->Present();
+    }
+
+};
+
+LLGL_IMPLEMENT_EXAMPLE(Example_GPUDrivenCulling);
+
+
+
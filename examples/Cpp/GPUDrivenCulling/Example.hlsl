@@ -0,0 +1,163 @@
+/*
+ * HLSL compute shader
+ */
+
+#define FRUSTUM_CULLING     ( 1u << 0 )
+#define OCCLUSION_CULLING   ( 1u << 1 )
+#define DRAW_COMPACTION     ( 1u << 2 )
+
+cbuffer CullingSettings : register(b1)
+{
+    float4  frustumPlanes[6];
+    float4  viewPos;
+    float4  occluderMin;
+    float4  occluderMax;
+    uint    numObjects;
+    uint    numIndices;
+    uint    flags;
+};
+
+// Array of instances, i.e. 3 vectors per instance (position, halfSize, color)
+RWBuffer<float4> instances : register(u2);
+
+// Array of DrawIndexedIndirectArguments, i.e. 5 integers per draw command
+RWBuffer<uint> drawArgs : register(u3);
+
+RWBuffer<uint> drawCount : register(u4);
+
+// Returns true if the bounding sphere is inside or intersects the view frustum
+bool IsInsideFrustum(float3 center, float radius)
+{
+    for (int i = 0; i < 6; ++i)
+    {
+        if (dot(frustumPlanes[i].xyz, center) + frustumPlanes[i].w < -radius)
+            return false;
+    }
+    return true;
+}
+
+// Returns true if the bounding box is entirely hidden behind the occluder wall as seen from the view position
+bool IsOccluded(float3 boxMin, float3 boxMax)
+{
+    // Select the occluder face that is facing the viewer
+    float planeZ;
+    if (viewPos.z < occluderMin.z)
+    {
+        if (boxMin.z <= occluderMin.z)
+            return false;
+        planeZ = occluderMin.z;
+    }
+    else if (viewPos.z > occluderMax.z)
+    {
+        if (boxMax.z >= occluderMax.z)
+            return false;
+        planeZ = occluderMax.z;
+    }
+    else
+        return false;
+
+    // Project all corners of the box onto the occluder plane and check if they are inside the occluder rectangle
+    for (int i = 0; i < 8; ++i)
+    {
+        float3 corner = float3(
+            ((i & 1) != 0 ? boxMax.x : boxMin.x),
+            ((i & 2) != 0 ? boxMax.y : boxMin.y),
+            ((i & 4) != 0 ? boxMax.z : boxMin.z)
+        );
+        float3 dir = corner - viewPos.xyz;
+        float2 p = viewPos.xy + dir.xy * ((planeZ - viewPos.z) / dir.z);
+        if (any(p < occluderMin.xy) || any(p > occluderMax.xy))
+            return false;
+    }
+
+    return true;
+}
+
+void WriteDrawArgs(uint idx, uint numInstances, uint firstInstance)
+{
+    idx *= 5;
+    drawArgs[idx    ] = numIndices;
+    drawArgs[idx + 1] = numInstances;
+    drawArgs[idx + 2] = 0;
+    drawArgs[idx + 3] = 0;
+    drawArgs[idx + 4] = firstInstance;
+}
+
+[numthreads(64, 1, 1)]
+void CS(uint3 threadID : SV_DispatchThreadID)
+{
+    uint id = threadID.x;
+    if (id >= numObjects)
+        return;
+
+    // Cull bounding volume of object
+    float3  center      = instances[id*3    ].xyz;
+    float3  halfSize    = instances[id*3 + 1].xyz;
+    bool    visible     = true;
+
+    if ((flags & FRUSTUM_CULLING) != 0)
+        visible = IsInsideFrustum(center, length(halfSize));
+    if (visible && (flags & OCCLUSION_CULLING) != 0)
+        visible = !IsOccluded(center - halfSize, center + halfSize);
+
+    // Write draw command either to the compacted range or to the slot of this object
+    if ((flags & DRAW_COMPACTION) != 0)
+    {
+        if (visible)
+        {
+            uint idx;
+            InterlockedAdd(drawCount[0], 1, idx);
+            WriteDrawArgs(idx, 1, id);
+        }
+    }
+    else
+        WriteDrawArgs(id, (visible ? 1 : 0), id);
+}
+
+
+/*
+ * HLSL vertex shader
+ */
+
+cbuffer SceneSettings : register(b2)
+{
+    float4x4    vpMatrix;
+    float4      lightDir;
+};
+
+struct VIn
+{
+    float3 position         : POSITION;
+    float4 instancePos      : INSTANCEPOS;
+    float4 instanceSize     : INSTANCESIZE;
+    float4 instanceColor    : INSTANCECOLOR;
+};
+
+struct VOut
+{
+    float4 position : SV_Position;
+    float4 color    : COLOR;
+};
+
+VOut VS(in VIn inp)
+{
+    VOut outp;
+    outp.position = mul(vpMatrix, float4(inp.position * inp.instanceSize.xyz + inp.instancePos.xyz, 1));
+
+    // Approximate lighting with the direction from the center to the corner of the cube
+    float NdotL = dot(normalize(inp.position), lightDir.xyz) * 0.5 + 0.5;
+    outp.color  = float4(inp.instanceColor.rgb * lerp(0.3, 1.0, NdotL), inp.instanceColor.a);
+
+    return outp;
+}
+
+
+/*
+ * HLSL pixel shader
+ */
+
+float4 PS(in VOut inp) : SV_Target0
+{
+    return inp.color;
+}
+
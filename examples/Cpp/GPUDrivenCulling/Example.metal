@@ -0,0 +1,174 @@
+/*
+ * Metal compute shader
+ */
+
+#include <metal_stdlib>
+#include <simd/simd.h>
+
+using namespace metal;
+
+#define FRUSTUM_CULLING     ( 1u << 0 )
+#define OCCLUSION_CULLING   ( 1u << 1 )
+#define DRAW_COMPACTION     ( 1u << 2 )
+
+struct CullingSettings
+{
+    float4  frustumPlanes[6];
+    float4  viewPos;
+    float4  occluderMin;
+    float4  occluderMax;
+    uint    numObjects;
+    uint    numIndices;
+    uint    flags;
+};
+
+struct Instance
+{
+    float4  position;
+    float4  halfSize;
+    float4  color;
+};
+
+// Returns true if the bounding sphere is inside or intersects the view frustum
+bool IsInsideFrustum(constant CullingSettings& settings, float3 center, float radius)
+{
+    for (int i = 0; i < 6; ++i)
+    {
+        if (dot(settings.frustumPlanes[i].xyz, center) + settings.frustumPlanes[i].w < -radius)
+            return false;
+    }
+    return true;
+}
+
+// Returns true if the bounding box is entirely hidden behind the occluder wall as seen from the view position
+bool IsOccluded(constant CullingSettings& settings, float3 boxMin, float3 boxMax)
+{
+    float3 viewPos = settings.viewPos.xyz;
+
+    // Select the occluder face that is facing the viewer
+    float planeZ;
+    if (viewPos.z < settings.occluderMin.z)
+    {
+        if (boxMin.z <= settings.occluderMin.z)
+            return false;
+        planeZ = settings.occluderMin.z;
+    }
+    else if (viewPos.z > settings.occluderMax.z)
+    {
+        if (boxMax.z >= settings.occluderMax.z)
+            return false;
+        planeZ = settings.occluderMax.z;
+    }
+    else
+        return false;
+
+    // Project all corners of the box onto the occluder plane and check if they are inside the occluder rectangle
+    for (int i = 0; i < 8; ++i)
+    {
+        float3 corner = float3(
+            ((i & 1) != 0 ? boxMax.x : boxMin.x),
+            ((i & 2) != 0 ? boxMax.y : boxMin.y),
+            ((i & 4) != 0 ? boxMax.z : boxMin.z)
+        );
+        float3 dir = corner - viewPos;
+        float2 p = viewPos.xy + dir.xy * ((planeZ - viewPos.z) / dir.z);
+        if (any(p < settings.occluderMin.xy) || any(p > settings.occluderMax.xy))
+            return false;
+    }
+
+    return true;
+}
+
+// Writes a DrawIndexedIndirectArguments structure, i.e. 5 integers per draw command
+void WriteDrawArgs(device uint* drawArgs, uint idx, uint numIndices, uint numInstances, uint firstInstance)
+{
+    idx *= 5;
+    drawArgs[idx    ] = numIndices;
+    drawArgs[idx + 1] = numInstances;
+    drawArgs[idx + 2] = 0;
+    drawArgs[idx + 3] = 0;
+    drawArgs[idx + 4] = firstInstance;
+}
+
+kernel void CS(
+    constant CullingSettings&   settings    [[buffer(1)]],
+    device const Instance*      instances   [[buffer(2)]],
+    device uint*                drawArgs    [[buffer(3)]],
+    device atomic_uint*         drawCount   [[buffer(4)]],
+    uint                        id          [[thread_position_in_grid]])
+{
+    if (id >= settings.numObjects)
+        return;
+
+    // Cull bounding volume of object
+    float3  center      = instances[id].position.xyz;
+    float3  halfSize    = instances[id].halfSize.xyz;
+    bool    visible     = true;
+
+    if ((settings.flags & FRUSTUM_CULLING) != 0)
+        visible = IsInsideFrustum(settings, center, length(halfSize));
+    if (visible && (settings.flags & OCCLUSION_CULLING) != 0)
+        visible = !IsOccluded(settings, center - halfSize, center + halfSize);
+
+    // Write draw command either to the compacted range or to the slot of this object
+    if ((settings.flags & DRAW_COMPACTION) != 0)
+    {
+        if (visible)
+        {
+            uint idx = atomic_fetch_add_explicit(drawCount, 1u, memory_order_relaxed);
+            WriteDrawArgs(drawArgs, idx, settings.numIndices, 1, id);
+        }
+    }
+    else
+        WriteDrawArgs(drawArgs, id, settings.numIndices, (visible ? 1 : 0), id);
+}
+
+
+/*
+ * Metal vertex shader
+ */
+
+struct SceneSettings
+{
+    float4x4    vpMatrix;
+    float4      lightDir;
+};
+
+struct VIn
+{
+    float3 position         [[attribute(0)]];
+    float4 instancePos      [[attribute(1)]];
+    float4 instanceSize     [[attribute(2)]];
+    float4 instanceColor    [[attribute(3)]];
+};
+
+struct VOut
+{
+    float4 position [[position]];
+    float4 color;
+};
+
+vertex VOut VS(
+    VIn                     inp         [[stage_in]],
+    constant SceneSettings& settings    [[buffer(2)]])
+{
+    VOut outp;
+    outp.position = settings.vpMatrix * float4(inp.position * inp.instanceSize.xyz + inp.instancePos.xyz, 1);
+
+    // Approximate lighting with the direction from the center to the corner of the cube
+    float NdotL = dot(normalize(inp.position), settings.lightDir.xyz) * 0.5 + 0.5;
+    outp.color  = float4(inp.instanceColor.rgb * mix(0.3, 1.0, NdotL), inp.instanceColor.a);
+
+    return outp;
+}
+
+
+/*
+ * Metal pixel shader
+ */
+
+fragment float4 PS(VOut inp [[stage_in]])
+{
+    return inp.color;
+}
+
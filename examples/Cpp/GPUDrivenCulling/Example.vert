@@ -0,0 +1,31 @@
+// GLSL vertex shader
+
+#version 450 core
+
+layout(std140, binding = 2) uniform SceneSettings
+{
+    mat4 vpMatrix;
+    vec4 lightDir;
+};
+
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec4 instancePos;
+layout(location = 2) in vec4 instanceSize;
+layout(location = 3) in vec4 instanceColor;
+
+layout(location = 0) out vec4 vColor;
+
+out gl_PerVertex
+{
+    vec4 gl_Position;
+};
+
+// Vertex shader main function
+void main()
+{
+    gl_Position = vpMatrix * vec4(position * instanceSize.xyz + instancePos.xyz, 1);
+
+    // Approximate lighting with the direction from the center to the corner of the cube
+    float NdotL = dot(normalize(position), lightDir.xyz) * 0.5 + 0.5;
+    vColor      = vec4(instanceColor.rgb * mix(0.3, 1.0, NdotL), instanceColor.a);
+}
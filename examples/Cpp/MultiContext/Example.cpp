@@ -18,7 +18,19 @@ int main(int argc, char* argv[])
 
         // Load render system module
         LLGL::RenderingDebugger debugger;
-        auto renderer = LLGL::RenderSystem::Load(GetSelectedRendererModule(argc, argv));//, nullptr, &debugger);
+        LLGL::RenderSystemDescriptor rendererDesc = GetSelectedRendererModule(argc, argv);
+
+        // Render both windows with a single GL context, so switching between them only switches the drawable
+        LLGL::RendererConfigurationOpenGL rendererConfigGL;
+        rendererConfigGL.singleContext = true;
+
+        if (rendererDesc.moduleName == "OpenGL")
+        {
+            rendererDesc.rendererConfig     = &rendererConfigGL;
+            rendererDesc.rendererConfigSize = sizeof(rendererConfigGL);
+        }
+
+        auto renderer = LLGL::RenderSystem::Load(rendererDesc);//, nullptr, &debugger);
 
         std::cout << "LLGL Renderer: " << renderer->GetName() << std::endl;
 
@@ -7,108 +7,48 @@
 
 #include <ExampleBase.h>
 #include <thread>
-#include <mutex>
-#include <chrono>
 #include <iomanip>
+#include <algorithm>
 
 
-// Enables/disables the use of two secondary command buffers
-#define ENABLE_SECONDARY_COMMAND_BUFFERS
+// Number of cubes along each axis of the grid, i.e. the number of draw calls per frame is the square of this value
+#define NUM_OBJECTS_PER_AXIS    32
 
-class Measure
-{
-
-        using Clock     = std::chrono::system_clock;
-        using TimePoint = std::chrono::time_point<Clock>;
-        using Ticks     = std::chrono::milliseconds;
-
-    public:
-
-        // Interval (in milliseconds) to the next measurement result.
-        Measure(std::uint64_t interval = 1000, const std::string& title = "Average Time") :
-            interval_ { interval },
-            title_    { title    }
-        {
-        }
-
-        void Start()
-        {
-            // Start timer
-            timer_.Start();
-        }
-
-        void Stop()
-        {
-            // Take sample
-            elapsed_ += timer_.Stop();
-            ++samples_;
-
-            // Check if average elapsed time can be printed again
-            auto end = Clock::now();
-            auto diff = std::chrono::duration_cast<Ticks>(end - intervalStartTime_);
-
-            if (diff.count() >= static_cast<long long>(interval_))
-            {
-                Print();
-                intervalStartTime_ = Clock::now();
-            }
-        }
-
-    private:
-
-        void Print()
-        {
-            if (samples_ > 0)
-            {
-                auto averageTime = static_cast<double>(elapsed_);
-                averageTime /= static_cast<double>(timer_.GetFrequency());
-                averageTime *= 1000000.0;
-                averageTime /= static_cast<double>(samples_);
-
-                std::cout << title_ << ": ";
-                std::cout << std::fixed << std::setprecision(6) << averageTime << " microseconds";
-                std::cout << "         \r";
-                std::flush(std::cout);
-
-                samples_ = 0;
-                elapsed_ = 0;
-            }
-        }
-
-    private:
+// Number of frames that are measured for each thread count of the benchmark
+#define NUM_BENCHMARK_FRAMES    100
 
-        Stopwatch       timer_;
-        std::uint64_t   interval_           = 0;
-        TimePoint       intervalStartTime_;
-        std::uint64_t   samples_            = 0;
-        std::uint64_t   elapsed_            = 0;
-        std::string     title_;
-
-};
+// Maximum number of worker threads that encode secondary command buffers
+#define MAX_NUM_WORKER_THREADS  8
 
 class Example_MultiThreading : public ExampleBase
 {
 
-    ShaderPipeline              shaderPipeline;
-    LLGL::Buffer*               vertexBuffer        = nullptr;
-    LLGL::Buffer*               indexBuffer         = nullptr;
-    LLGL::PipelineLayout*       pipelineLayout      = nullptr;
-    LLGL::CommandBuffer*        primaryCmdBuffer    = nullptr;
-
-    std::uint32_t               numIndices          = 0;
-    std::mutex                  logMutex;
+    ShaderPipeline                      shaderPipeline;
+    LLGL::Buffer*                       vertexBuffer        = nullptr;
+    LLGL::Buffer*                       indexBuffer         = nullptr;
+    LLGL::PipelineLayout*               pipelineLayout      = nullptr;
+    LLGL::PipelineState*                pipeline[2]         = {};
+    LLGL::RenderPass*                   renderPass          = nullptr;
+    LLGL::CommandBuffer*                primaryCmdBuffer    = nullptr;
 
-    Measure                     measure;
+    std::uint32_t                       numIndices          = 0;
 
-    struct Bundle
+    struct SceneObject
     {
-        LLGL::PipelineState*    pipeline            = nullptr;
-        LLGL::Buffer*           constantBuffer      = nullptr;
-        LLGL::ResourceHeap*     resourceHeap        = nullptr;
-        LLGL::CommandBuffer*    secondaryCmdBuffer  = nullptr;
-        Gs::Matrix4f            wvpMatrix;
-    }
-    bundle[2];
+        LLGL::Buffer*                   constantBuffer      = nullptr;
+        LLGL::ResourceHeap*             resourceHeap        = nullptr;
+        Gs::Matrix4f                    wvpMatrix;
+    };
+
+    std::vector<SceneObject>            objects;
+    std::vector<LLGL::CommandBuffer*>   secondaryCmdBuffers;
+
+    // Benchmark state: thread count of the current step and accumulated encoding time
+    Stopwatch                           timer;
+    std::uint32_t                       numThreads          = 1;
+    std::uint32_t                       numFramesMeasured   = 0;
+    std::uint64_t                       elapsedTicks        = 0;
+    std::vector<double>                 results;
 
 public:
 
@@ -119,6 +59,7 @@ public:
         LoadShaders(vertexFormat);
         CreatePipelines();
         CreateCommandBuffers();
+        UpdateScene();
     }
 
 private:
@@ -139,8 +80,10 @@ private:
         vertexBuffer = CreateVertexBuffer(vertices, vertexFormat);
         indexBuffer = CreateIndexBuffer(indices, LLGL::Format::R32UInt);
 
-        for (auto& bdl : bundle)
-            bdl.constantBuffer = CreateConstantBuffer(bdl.wvpMatrix);
+        // Create one constant buffer for each cube in the grid
+        objects.resize(NUM_OBJECTS_PER_AXIS * NUM_OBJECTS_PER_AXIS);
+        for (auto& obj : objects)
+            obj.constantBuffer = CreateConstantBuffer(obj.wvpMatrix);
 
         return vertexFormat;
     }
@@ -156,9 +99,18 @@ private:
         // Create pipeline layout
         pipelineLayout = renderer->CreatePipelineLayout(LLGL::PipelineLayoutDesc("cbuffer(Scene@1):vert"));
 
-        // Create resource view heap
-        for (auto& bdl : bundle)
-            bdl.resourceHeap = renderer->CreateResourceHeap(pipelineLayout, { bdl.constantBuffer });
+        // Create resource view heaps
+        for (auto& obj : objects)
+            obj.resourceHeap = renderer->CreateResourceHeap(pipelineLayout, { obj.constantBuffer });
+
+        // Create render pass that clears the swap-chain, since the primary command buffer must only execute secondary command buffers inside the render pass
+        LLGL::RenderPassDescriptor renderPassDesc;
+        {
+            renderPassDesc.colorAttachments[0]  = LLGL::AttachmentFormatDescriptor{ swapChain->GetColorFormat(), LLGL::AttachmentLoadOp::Clear, LLGL::AttachmentStoreOp::Store };
+            renderPassDesc.depthAttachment      = LLGL::AttachmentFormatDescriptor{ swapChain->GetDepthStencilFormat(), LLGL::AttachmentLoadOp::Clear };
+            renderPassDesc.samples              = GetSampleCount();
+        }
+        renderPass = renderer->CreateRenderPass(renderPassDesc);
 
         // Setup graphics pipeline descriptors
         LLGL::GraphicsPipelineDescriptor pipelineDesc;
@@ -178,7 +130,7 @@ private:
         }
 
         // Create first graphics pipeline
-        bundle[0].pipeline = renderer->CreatePipelineState(pipelineDesc);
+        pipeline[0] = renderer->CreatePipelineState(pipelineDesc);
 
         // Create second graphics pipeline
         {
@@ -188,133 +140,92 @@ private:
             targetDesc.srcColor         = LLGL::BlendOp::One;
             targetDesc.colorArithmetic  = LLGL::BlendArithmetic::Subtract;
         }
-        bundle[1].pipeline = renderer->CreatePipelineState(pipelineDesc);
+        pipeline[1] = renderer->CreatePipelineState(pipelineDesc);
     }
 
-    static void PrintThreadsafe(std::mutex& mtx, const std::string& text)
-    {
-        std::lock_guard<std::mutex> guard { mtx };
-        std::cout << text << std::endl;
-    }
-
-    static void EncodeSecondaryCommandBuffer(
-        Bundle&         bundle,
-        std::uint32_t   numIndices,
-        std::mutex&     mtx,
-        std::string     threadName)
+    void CreateCommandBuffers()
     {
-        // Print thread start
-        PrintThreadsafe(mtx, "Enter thread: " + threadName);
-
-        // Encode command buffer
-        auto& cmdBuffer = *bundle.secondaryCmdBuffer;
+        // Create primary command buffer
+        primaryCmdBuffer = renderer->CreateCommandBuffer();
 
-        cmdBuffer.Begin();
+        // Create one secondary command buffer for each worker thread; they are executed inside a render pass of the swap-chain
+        LLGL::CommandBufferDescriptor cmdBufferDesc;
         {
-            cmdBuffer.SetPipelineState(*bundle.pipeline);
-            cmdBuffer.SetResourceHeap(*bundle.resourceHeap);
-            cmdBuffer.DrawIndexed(numIndices, 0);
+            cmdBufferDesc.flags         = LLGL::CommandBufferFlags::Secondary;
+            cmdBufferDesc.renderTarget  = swapChain;
         }
-        cmdBuffer.End();
+        const auto maxNumThreads = std::max(1u, std::min(std::thread::hardware_concurrency(), static_cast<unsigned>(MAX_NUM_WORKER_THREADS)));
+        secondaryCmdBuffers.resize(maxNumThreads);
+        for (auto& cmdBuffer : secondaryCmdBuffers)
+            cmdBuffer = renderer->CreateCommandBuffer(cmdBufferDesc);
 
-        // Print thread end
-        PrintThreadsafe(mtx, "Leave thread: " + threadName);
+        std::cout << "Benchmark: encoding " << objects.size() << " draw calls per frame with 1 to " << maxNumThreads << " thread(s)" << std::endl;
     }
 
-    void EncodePrimaryCommandBuffer(const std::string& threadName)
+    // Encodes the draw calls of the specified range of scene objects. Each worker thread encodes its own command buffer.
+    void EncodeSecondaryCommandBuffer(LLGL::CommandBuffer& cmdBuffer, std::size_t firstObject, std::size_t numObjects)
     {
-        // Print thread start
-        if (!threadName.empty())
-            PrintThreadsafe(logMutex, "Enter thread: " + threadName);
-
-        // Encode command buffer
-        auto& cmdBuffer = *primaryCmdBuffer;
         cmdBuffer.Begin();
         {
-            // Set hardware buffers to draw the model
+            // Secondary command buffers do not inherit any state from the primary command buffer
+            cmdBuffer.SetViewport(swapChain->GetResolution());
             cmdBuffer.SetVertexBuffer(*vertexBuffer);
             cmdBuffer.SetIndexBuffer(*indexBuffer);
 
-            // Set the swap-chain as the initial render target
-            cmdBuffer.BeginRenderPass(*swapChain);
+            for (std::size_t i = firstObject; i < firstObject + numObjects; ++i)
             {
-                // Clear color- and depth buffers, and set viewport
-                cmdBuffer.Clear(LLGL::ClearFlags::ColorDepth, { backgroundColor });
-                cmdBuffer.SetViewport(swapChain->GetResolution());
-
-                // Draw scene with secondary command buffers
-                #ifdef ENABLE_SECONDARY_COMMAND_BUFFERS
-
-                for (auto& bdl : bundle)
-                    cmdBuffer.Execute(*bdl.secondaryCmdBuffer);
-
-                #else // ENABLE_SECONDARY_COMMAND_BUFFERS
-
-                for (auto& bdl : bundle)
-                {
-                    cmdBuffer.SetPipelineState(*bdl.pipeline);
-                    cmdBuffer.SetResourceHeap(*bdl.resourceHeap);
-                    cmdBuffer.DrawIndexed(numIndices, 0);
-                }
-
-                #endif // /ENABLE_SECONDARY_COMMAND_BUFFERS
+                cmdBuffer.SetPipelineState(*pipeline[i % 2]);
+                cmdBuffer.SetResourceHeap(*objects[i].resourceHeap);
+                cmdBuffer.DrawIndexed(numIndices, 0);
             }
-            cmdBuffer.EndRenderPass();
         }
         cmdBuffer.End();
-
-        // Print thread end
-        if (!threadName.empty())
-            PrintThreadsafe(logMutex, "Leave thread: " + threadName);
     }
 
-    void CreateCommandBuffers()
+    // Encodes all secondary command buffers on the specified number of worker threads.
+    void EncodeSecondaryCommandBuffers(std::uint32_t numWorkerThreads)
     {
-        // Create primary command buffer
-        LLGL::CommandBufferDescriptor cmdBufferDesc;
-        {
-            cmdBufferDesc.flags = LLGL::CommandBufferFlags::MultiSubmit;
-        }
-        primaryCmdBuffer = renderer->CreateCommandBuffer(cmdBufferDesc);
-
-        #ifdef ENABLE_SECONDARY_COMMAND_BUFFERS
-
-        // Create secondary command buffers
-        cmdBufferDesc.flags = (LLGL::CommandBufferFlags::Secondary | LLGL::CommandBufferFlags::MultiSubmit);
+        std::vector<std::thread> workerThreads;
+        workerThreads.reserve(numWorkerThreads);
 
-        // Start encoding secondary command buffers in parallel
-        std::thread workerThread[2];
+        const std::size_t numObjectsPerThread = (objects.size() + numWorkerThreads - 1) / numWorkerThreads;
 
-        for (int i = 0; i < 2; ++i)
+        for (std::uint32_t i = 0; i < numWorkerThreads; ++i)
         {
-            // Create secondary command buffer
-            bundle[i].secondaryCmdBuffer = renderer->CreateCommandBuffer(cmdBufferDesc);
-
-            // Start worker thread to encode secondary command buffer
-            workerThread[i] = std::thread(
-                Example_MultiThreading::EncodeSecondaryCommandBuffer,
-                std::ref(bundle[i]),
-                numIndices,
-                std::ref(logMutex),
-                "workerThread[" + std::to_string(i) + "]"
+            const std::size_t firstObject = numObjectsPerThread * i;
+            const std::size_t numObjects = std::min(numObjectsPerThread, objects.size() - std::min(firstObject, objects.size()));
+            workerThreads.emplace_back(
+                &Example_MultiThreading::EncodeSecondaryCommandBuffer,
+                this,
+                std::ref(*secondaryCmdBuffers[i]),
+                firstObject,
+                numObjects
             );
         }
 
-        #endif // /ENABLE_SECONDARY_COMMAND_BUFFERS
-
-        // Encode primary command buffer
-        EncodePrimaryCommandBuffer("mainThread");
+        // Wait for worker threads to finish
+        for (auto& worker : workerThreads)
+            worker.join();
+    }
 
-        #ifdef ENABLE_SECONDARY_COMMAND_BUFFERS
+    void EncodePrimaryCommandBuffer(std::uint32_t numWorkerThreads)
+    {
+        const LLGL::ClearValue clearValues[2] = { LLGL::ClearValue{ backgroundColor }, LLGL::ClearValue{ 1.0f } };
 
-        // Wait for worker threads to finish
-        for (auto& worker : workerThread)
+        // Encode command buffer
+        auto& cmdBuffer = *primaryCmdBuffer;
+        cmdBuffer.Begin();
         {
-            if (worker.joinable())
-                worker.join();
+            // Set the swap-chain as the render target and clear it with the render pass
+            cmdBuffer.BeginRenderPass(*swapChain, renderPass, 2, clearValues);
+            {
+                // Draw scene with secondary command buffers
+                for (std::uint32_t i = 0; i < numWorkerThreads; ++i)
+                    cmdBuffer.Execute(*secondaryCmdBuffers[i]);
+            }
+            cmdBuffer.EndRenderPass();
         }
-
-        #endif // /ENABLE_SECONDARY_COMMAND_BUFFERS
+        cmdBuffer.End();
     }
 
     void Transform(Gs::Matrix4f& matrix, const Gs::Vector3f& pos, float angle)
@@ -322,49 +233,80 @@ private:
         matrix.LoadIdentity();
         Gs::Translate(matrix, pos);
         Gs::RotateFree(matrix, Gs::Vector3f(1, 1, 1).Normalized(), angle);
+        Gs::Scale(matrix, Gs::Vector3f(0.25f));
         matrix = projection * matrix;
     }
 
+    // Updates the scene matrices of the cube grid. This is only done when the projection changes, so the benchmark only measures the encoding.
     void UpdateScene()
     {
-        // Animate rotation
-        static float rotation;
-        rotation += 0.01f;
+        const float gridOffset = static_cast<float>(NUM_OBJECTS_PER_AXIS - 1) * 0.5f;
 
-        // Update scene matrices
-        Transform(bundle[0].wvpMatrix, { -1, 0, 8 }, -rotation);
-        Transform(bundle[1].wvpMatrix, { +1, 0, 8 }, +rotation);
+        for (std::size_t i = 0; i < objects.size(); ++i)
+        {
+            auto& obj = objects[i];
+
+            const float x = static_cast<float>(i % NUM_OBJECTS_PER_AXIS) - gridOffset;
+            const float y = static_cast<float>(i / NUM_OBJECTS_PER_AXIS) - gridOffset;
+            Transform(obj.wvpMatrix, { x * 0.6f, y * 0.6f, 24.0f }, static_cast<float>(i) * 0.1f);
+
+            renderer->WriteBuffer(*obj.constantBuffer, 0, &(obj.wvpMatrix), sizeof(Gs::Matrix4f));
+        }
+    }
 
-        // Update constant buffer
-        for (auto& bdl : bundle)
+    // Prints the average encoding time of the current thread count and moves on to the next step of the benchmark.
+    void NextBenchmarkStep()
+    {
+        auto averageTime = static_cast<double>(elapsedTicks);
+        averageTime /= static_cast<double>(timer.GetFrequency());
+        averageTime *= 1000000.0;
+        averageTime /= static_cast<double>(numFramesMeasured);
+
+        results.push_back(averageTime);
+
+        std::cout << "  " << numThreads << " thread(s): ";
+        std::cout << std::fixed << std::setprecision(2) << averageTime << " microseconds";
+        std::cout << " (speedup " << std::setprecision(2) << (results.front() / averageTime) << "x)" << std::endl;
+
+        numFramesMeasured   = 0;
+        elapsedTicks        = 0;
+
+        if (numThreads < secondaryCmdBuffers.size())
+            ++numThreads;
+        else
         {
-            renderer->WriteBuffer(
-                *bdl.constantBuffer,
-                0,
-                &(bdl.wvpMatrix),
-                sizeof(Gs::Matrix4f)
-            );
+            // Start benchmark over again
+            numThreads = 1;
+            results.clear();
         }
     }
 
     void DrawScene()
     {
-        // Submit primary command buffer and present result
-        measure.Start();
+        // Measure encoding of all secondary command buffers with the current number of threads
+        timer.Start();
+        {
+            EncodeSecondaryCommandBuffers(numThreads);
+        }
+        elapsedTicks += timer.Stop();
+
+        if (++numFramesMeasured == NUM_BENCHMARK_FRAMES)
+            NextBenchmarkStep();
+
+        // Encode and submit primary command buffer and present result
+        EncodePrimaryCommandBuffer(numThreads);
         commandQueue->Submit(*primaryCmdBuffer);
-        measure.Stop();
         swapChain->Present();
     }
 
     void OnResize(const LLGL::Extent2D& /*resoluion*/) override
     {
-        // Encode primary command buffer again to update resolution in constant buffer
-        EncodePrimaryCommandBuffer("");
+        // Update scene matrices with the new projection
+        UpdateScene();
     }
 
     void OnDrawFrame() override
     {
-        UpdateScene();
         DrawScene();
     }
 
@@ -13,6 +13,7 @@ class Example_VolumeRendering : public ExampleBase
 {
 
     const std::uint32_t         noiseTextureSize        = 64;
+    const std::uint32_t         noiseBrickSize          = 16;
 
     LLGL::Shader*               vsScene                 = nullptr;
     LLGL::Shader*               fsScene                 = nullptr;
@@ -31,6 +32,8 @@ class Example_VolumeRendering : public ExampleBase
     LLGL::Buffer*               constantBuffer          = nullptr;
 
     LLGL::Texture*              noiseTexture            = nullptr;  // 3D noise texture
+    std::vector<std::uint8_t>   noiseVolume;                        // Source volume that is streamed into the noise texture
+    std::unique_ptr<LLGL::TextureBrickStreamer> noiseStreamer;
     LLGL::Sampler*              linearSampler           = nullptr;
 
     LLGL::Texture*              depthRangeTexture       = nullptr;
@@ -165,26 +168,33 @@ private:
 
     void CreateTextures()
     {
-        // Generate 3D perlin noise texture
-        std::vector<std::uint8_t> imageData;
-        {
-            perlinNoise.GenerateBuffer(imageData, noiseTextureSize, noiseTextureSize, noiseTextureSize, 4);
-        }
-        LLGL::SrcImageDescriptor imageDesc;
-        {
-            imageDesc.format    = LLGL::ImageFormat::R;
-            imageDesc.dataType  = LLGL::DataType::UInt8;
-            imageDesc.data      = imageData.data();
-            imageDesc.dataSize  = imageData.size();
-        }
+        // Generate 3D perlin noise volume
+        perlinNoise.GenerateBuffer(noiseVolume, noiseTextureSize, noiseTextureSize, noiseTextureSize, 4);
+
+        // Create empty 3D texture; the volume is streamed into it brick by brick while rendering
         LLGL::TextureDescriptor texDesc;
         {
             texDesc.type        = LLGL::TextureType::Texture3D;
+            texDesc.bindFlags   = LLGL::BindFlags::Sampled | LLGL::BindFlags::CopyDst;
             texDesc.format      = LLGL::Format::R8UNorm;
             texDesc.extent      = { noiseTextureSize, noiseTextureSize, noiseTextureSize };
             texDesc.mipLevels   = 1;
         }
-        noiseTexture = renderer->CreateTexture(texDesc, &imageDesc);
+        noiseTexture = renderer->CreateTexture(texDesc);
+
+        // Stream a few bricks per frame, so the volume builds up progressively
+        LLGL::TextureBrickSourceDescriptor sourceDesc;
+        {
+            sourceDesc.data     = noiseVolume.data();
+            sourceDesc.extent   = texDesc.extent;
+        }
+        LLGL::TextureBrickStreamerDescriptor streamerDesc;
+        {
+            streamerDesc.brickExtent        = { noiseBrickSize, noiseBrickSize, noiseBrickSize };
+            streamerDesc.stagingBufferSize  = 4 * noiseBrickSize * noiseBrickSize * noiseBrickSize;
+        }
+        noiseStreamer = std::unique_ptr<LLGL::TextureBrickStreamer>(new LLGL::TextureBrickStreamer{ *renderer, *noiseTexture, sourceDesc, streamerDesc });
+        noiseStreamer->RequestAll();
 
         // Create render target texture for depth-range
         CreateDepthRangeTextureAndRenderTarget(swapChain->GetResolution());
@@ -361,6 +371,9 @@ private:
 
         commands->Begin();
         {
+            // Upload next bricks of the noise volume outside of any render pass
+            noiseStreamer->Encode(*commands);
+
             // Bind vertex input assembly and update constant buffer with scene settings
             commands->SetVertexBuffer(*vertexBuffer);
             commands->UpdateBuffer(*constantBuffer, 0, &settings, sizeof(settings));
@@ -414,6 +427,7 @@ private:
         }
         commands->End();
         commandQueue->Submit(*commands);
+        noiseStreamer->NextBatch();
 
         // Present result on the screen
         swapChain->Present();
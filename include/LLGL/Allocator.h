@@ -0,0 +1,120 @@
+/*
+ * Allocator.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_ALLOCATOR_H
+#define LLGL_ALLOCATOR_H
+
+
+#include <LLGL/Export.h>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+/**
+\brief Namespace with functions to override and track the internal memory allocations of LLGL.
+\remarks By default, LLGL allocates its internal memory with the global <code>operator new</code> and <code>operator delete</code>.
+Host applications can redirect these allocations into their own allocator with SetCallbacks, e.g. to track the memory footprint of LLGL
+or to verify that no allocations happen in steady-state frames.
+This covers the allocations on the hot paths of LLGL, such as the memory chunks of virtual command buffers and the descriptor arrays that outgrow their local storage.
+Allocations of the standard library, the window system, and the native graphics drivers are not affected.
+*/
+namespace Allocator
+{
+
+
+/* ----- Types ----- */
+
+/**
+\brief Memory allocation callbacks.
+\remarks Either both function pointers must be specified or none of them, in which case the default allocator is used.
+\see SetCallbacks
+*/
+struct Callbacks
+{
+    /**
+    \brief Allocates a memory block of at least \c size bytes with the specified alignment.
+    \param[in] size Specifies the size (in bytes) of the memory block. This is always greater than zero.
+    \param[in] alignment Specifies the alignment (in bytes) of the memory block. This is always a power of two.
+    \param[in] userData Specifies the user data of this callback structure.
+    \return Pointer to the new memory block or null if the allocation failed.
+    */
+    void* (*allocate)(std::size_t size, std::size_t alignment, void* userData) = nullptr;
+
+    /**
+    \brief Releases a memory block that was allocated by the \c allocate callback.
+    \remarks The \c size and \c alignment parameters are equal to the ones that were passed to the \c allocate callback for this memory block.
+    */
+    void (*free)(void* block, std::size_t size, std::size_t alignment, void* userData) = nullptr;
+
+    //! User data that is passed to both callbacks.
+    void* userData = nullptr;
+};
+
+/**
+\brief Statistics of the internal memory allocations.
+\remarks All counters are monotonic since the start of the application.
+The difference of their values before and after a frame is the number of allocations in that frame.
+\see GetStatistics
+*/
+struct Statistics
+{
+    //! Number of memory blocks that have been allocated so far.
+    std::uint64_t numAllocations    = 0;
+
+    //! Number of memory blocks that have been released so far.
+    std::uint64_t numFrees          = 0;
+
+    //! Accumulated number of bytes that have been allocated so far.
+    std::uint64_t numBytesAllocated = 0;
+};
+
+
+/* ----- Functions ----- */
+
+/**
+\brief Sets the callbacks for all internal memory allocations of LLGL.
+\param[in] callbacks Specifies the new allocation callbacks. If both function pointers are null, the default allocator is restored.
+\remarks This must be called before the first render system is loaded, or after all render systems have been unloaded,
+since memory blocks must be released by the same allocator they have been allocated with.
+*/
+LLGL_EXPORT void SetCallbacks(const Callbacks& callbacks);
+
+//! Returns the current allocation callbacks. Both function pointers are null if the default allocator is used.
+LLGL_EXPORT Callbacks GetCallbacks();
+
+/**
+\brief Allocates a memory block with the current allocator.
+\remarks This throws \c std::bad_alloc if the allocation failed.
+\see Free
+*/
+LLGL_EXPORT void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+/**
+\brief Releases a memory block that was allocated with the Allocate function.
+\param[in] block Specifies the memory block. If this is null, the function call has no effect.
+\param[in] size Specifies the size that was passed to the Allocate function for this block.
+\param[in] alignment Specifies the alignment that was passed to the Allocate function for this block.
+*/
+LLGL_EXPORT void Free(void* block, std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+//! Returns the allocation statistics. This can be called from any thread.
+LLGL_EXPORT Statistics GetStatistics();
+
+
+} // /namespace Allocator
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
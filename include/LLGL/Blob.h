@@ -73,6 +73,32 @@ class LLGL_EXPORT Blob : public NonCopyable
         */
         static std::unique_ptr<Blob> CreateFromFile(const std::string& filename);
 
+        /**
+        \brief Creates a new Blob instance that maps the specified binary file into memory for read-only access.
+        \param[in] filename Specifies the file that is to be mapped.
+        \return New instance of Blob that refers to the memory-mapped file content or null if the file could not be mapped.
+        \remarks In contrast to CreateFromFile, the file content is not copied into heap memory, but read on demand from the page cache of the operating system.
+        This is useful for large resource packages, whose image data can be passed to RenderSystem::CreateTexture or RenderSystem::WriteTexture
+        with a SrcImageDescriptor that points directly into this Blob. The file must not be modified or truncated while it is mapped.
+        \code
+        auto texturePack = LLGL::Blob::CreateFromFileMapping("TexturePack.bin");
+        LLGL::SrcImageDescriptor imageDesc;
+        {
+            imageDesc.format    = LLGL::ImageFormat::BC1;
+            imageDesc.data      = static_cast<const char*>(texturePack->GetData()) + imageOffset;
+            imageDesc.dataSize  = imageSize;
+        }
+        auto texture = renderer->CreateTexture(textureDesc, &imageDesc);
+        \endcode
+        */
+        static std::unique_ptr<Blob> CreateFromFileMapping(const char* filename);
+
+        /**
+        \brief Creates a new Blob instance that maps the specified binary file into memory for read-only access.
+        \see CreateFromFileMapping(const char*)
+        */
+        static std::unique_ptr<Blob> CreateFromFileMapping(const std::string& filename);
+
     public:
 
         //! Returns a constant pointer to the internal buffer.
@@ -145,6 +145,59 @@ struct BufferViewDescriptor
     std::uint64_t   size    = Constants::wholeSize;
 };
 
+/**
+\brief Buffer write region structure for scattered buffer updates.
+\see RenderSystem::WriteBuffer(Buffer&, std::uint32_t, const BufferWriteRegion*)
+\see CommandBuffer::UpdateBuffer(Buffer&, std::uint32_t, const BufferWriteRegion*)
+*/
+struct BufferWriteRegion
+{
+    BufferWriteRegion() = default;
+
+    //! Initializes the region with a destination offset and source data.
+    inline BufferWriteRegion(std::uint64_t dstOffset, const void* data, std::uint64_t dataSize) :
+        dstOffset { dstOffset },
+        data      { data      },
+        dataSize  { dataSize  }
+    {
+    }
+
+    //! Destination offset (in bytes) at which the buffer is to be updated. By default 0.
+    std::uint64_t   dstOffset   = 0;
+
+    //! Raw pointer to the source data of this region. This must not be null. By default null.
+    const void*     data        = nullptr;
+
+    //! Size (in bytes) of the source data of this region. By default 0.
+    std::uint64_t   dataSize    = 0;
+};
+
+/**
+\brief Buffer copy region structure for batched buffer copies.
+\see CommandBuffer::CopyBuffer(Buffer&, Buffer&, std::uint32_t, const BufferCopyRegion*)
+*/
+struct BufferCopyRegion
+{
+    BufferCopyRegion() = default;
+
+    //! Initializes the region with destination offset, source offset, and size.
+    inline BufferCopyRegion(std::uint64_t dstOffset, std::uint64_t srcOffset, std::uint64_t size) :
+        dstOffset { dstOffset },
+        srcOffset { srcOffset },
+        size      { size      }
+    {
+    }
+
+    //! Destination offset (in bytes) at which the destination buffer is to be updated. By default 0.
+    std::uint64_t   dstOffset   = 0;
+
+    //! Source offset (in bytes) at which the source buffer is to be read from. By default 0.
+    std::uint64_t   srcOffset   = 0;
+
+    //! Size (in bytes) of the buffer region to copy. By default 0.
+    std::uint64_t   size        = 0;
+};
+
 
 /* ----- Functions ----- */
 
@@ -0,0 +1,101 @@
+/*
+ * CaptureReplay.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CAPTURE_REPLAY_H
+#define LLGL_CAPTURE_REPLAY_H
+
+
+#include <LLGL/NonCopyable.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class RenderSystem;
+
+/* ----- Classes ----- */
+
+/**
+\brief Replays a capture file that has been written by the capture layer.
+\remarks A capture file contains all calls to the render system, its command queue, command buffers, and swap-chains of a captured application,
+including the content of all buffers, textures, and shaders (see RenderSystemDescriptor::captureFilename).
+Replaying a capture issues the same command stream without any application logic,
+so the CPU time of the replay can be compared between two builds of LLGL or two renderers to detect performance regressions.
+\remarks Here is an example how to measure the CPU time of each frame of a capture:
+\code
+LLGL::CaptureReplay myReplay{ *myRenderer, "MyCapture.llglcap" };
+while (myReplay.ReplayFrame())
+{
+    std::uint64_t myFrameTicks = myReplay.GetLastFrameTicks();
+    ...
+}
+\endcode
+\note Capture files are only compatible with the version of LLGL they have been written with.
+A capture can be replayed with a different renderer only if the captured shaders are compatible with that renderer.
+\note This class is not thread-safe.
+\see RenderSystemDescriptor::captureFilename
+*/
+class LLGL_EXPORT CaptureReplay : public NonCopyable
+{
+
+    public:
+
+        /**
+        \brief Loads the specified capture file to be replayed with the specified render system.
+        \remarks The render system must outlive this replay. All objects that have been created by the replay are released with its destruction.
+        \throws std::runtime_error If the capture file cannot be read or has been written by a different version of LLGL.
+        \throws std::out_of_range If the capture file has been truncated.
+        */
+        CaptureReplay(RenderSystem& renderSystem, const char* filename);
+
+        //! Releases all objects that have been created by the replay and are still alive.
+        ~CaptureReplay();
+
+        /**
+        \brief Replays all calls up to and including the next swap-chain presentation.
+        \return True if a frame has been replayed, or false if the end of the capture has been reached.
+        \remarks The first frame also includes all calls that have been made before the first presentation, e.g. the creation of all initial resources.
+        */
+        bool ReplayFrame();
+
+        /**
+        \brief Resets the replay to the beginning of the capture.
+        \remarks This releases all objects that have been created by the replay, so the next frame creates them again.
+        */
+        void Reset();
+
+        //! Returns the number of frames that have been replayed since the beginning of the capture.
+        std::uint32_t GetFrameIndex() const;
+
+        /**
+        \brief Returns the CPU time (in ticks) of the last replayed frame.
+        \remarks This includes the time to decode the capture, which is negligible since the capture file is memory-mapped and read in place.
+        \see Timer::Frequency
+        */
+        std::uint64_t GetLastFrameTicks() const;
+
+        //! Returns the name of the renderer module the capture has been written with, e.g. "OpenGL".
+        const char* GetCapturedModuleName() const;
+
+    private:
+
+        struct Pimpl;
+        Pimpl* pimpl_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
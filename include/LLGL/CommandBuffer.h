@@ -25,6 +25,7 @@
 #include <LLGL/Shader.h>
 #include <LLGL/PipelineState.h>
 #include <LLGL/QueryHeap.h>
+#include <LLGL/IndirectArguments.h>
 
 #include <cstdint>
 
@@ -68,13 +69,57 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         */
         virtual void End() = 0;
 
+        /**
+        \brief Returns the number of calls to \c Begin that had to wait for the GPU since the last call to this function and resets that counter.
+        \remarks This happens when none of the native command buffers has been completed yet and no further one can be allocated.
+        Only the Vulkan backend reports such stalls; all other backends return 0.
+        \see CommandBufferDescriptor::maxNativeBuffers
+        \see FrameProfile::commandBufferStalls
+        */
+        virtual std::uint32_t QueryBeginStalls();
+
         /**
         \brief Executes the specified deferred command buffer.
         \param[in] deferredCommandBuffer Specifies the deferred command buffer which is meant to be executed.
         This command buffer must have been created with the CommandBufferFlags::Secondary flag.
         \remarks This function can only be used by primary command buffers, i.e. command buffers that have not been created with the flag CommandBufferFlags::Secondary.
+        \remarks If this function is called inside a render pass, the secondary command buffer must have been created with the same render target (see CommandBufferDescriptor::renderTarget)
+        and all other commands within this render pass must also be secondary command buffers that are executed with this function.
+        Here is an example of how secondary command buffers can be encoded on multiple threads:
+        \code
+        // Encode secondary command buffers on worker threads (each one created with CommandBufferFlags::Secondary and 'renderTarget' = mySwapChain)
+        for (std::size_t i = 0; i < numThreads; ++i)
+        {
+            myWorkers[i] = std::thread([i]() {
+                mySecondaryCmdBuffers[i]->Begin();
+                {
+                    mySecondaryCmdBuffers[i]->SetPipelineState(*myPipeline);
+                    mySecondaryCmdBuffers[i]->Draw(...);
+                }
+                mySecondaryCmdBuffers[i]->End();
+            });
+        }
+        for (auto& worker : myWorkers)
+            worker.join();
+
+        // Execute secondary command buffers inside the render pass of the primary command buffer
+        myPrimaryCmdBuffer->Begin();
+        {
+            myPrimaryCmdBuffer->BeginRenderPass(*mySwapChain);
+            {
+                for (auto secondaryCmdBuffer : mySecondaryCmdBuffers)
+                    myPrimaryCmdBuffer->Execute(*secondaryCmdBuffer);
+            }
+            myPrimaryCmdBuffer->EndRenderPass();
+        }
+        myPrimaryCmdBuffer->End();
+        \endcode
+        \remarks For the Metal backend, secondary command buffers only record their commands and are encoded when they are executed.
+        Inside a render pass, each executed secondary command buffer is encoded on a worker thread into its own sub-encoder of an \c MTLParallelRenderCommandEncoder,
+        which is ended with the render pass. Therefore, such secondary command buffers must not use tessellation and must not be executed more than once within the same render pass.
+        Outside a render pass, the recorded commands are encoded directly into the primary command buffer.
         \see CommandBufferFlags
-        \todo Incomplete for: D3D12, Vulkan, Metal.
+        \see CommandBufferDescriptor::renderTarget
         */
         virtual void Execute(CommandBuffer& deferredCommandBuffer) = 0;
 
@@ -99,6 +144,23 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
             std::uint16_t   dataSize
         ) = 0;
 
+        /**
+        \brief Updates multiple disjoint regions of the specified buffer during encoding the command buffer.
+        \param[in] dstBuffer Specifies the destination buffer whose data is to be updated.
+        \param[in] numRegions Specifies the number of entries in the \c regions array.
+        \param[in] regions Pointer to an array of buffer write regions. Each region must fit into the buffer and its size is limited to 65536 bytes.
+        The regions should not overlap.
+        \remarks This is equivalent to calling UpdateBuffer(Buffer&, std::uint64_t, const void*, std::uint16_t) for each region,
+        but backends that interrupt the render pass or insert barriers for buffer updates (i.e. Vulkan and Direct3D 12) do so only once per batch.
+        The default implementation calls UpdateBuffer for each region.
+        \see BufferWriteRegion
+        */
+        virtual void UpdateBuffer(
+            Buffer&                     dstBuffer,
+            std::uint32_t               numRegions,
+            const BufferWriteRegion*    regions
+        );
+
         /**
         \brief Encodes a buffer copy command for the specified buffer region.
         \param[in,out] dstBuffer Specifies the destination buffer whose data is to be updated.
@@ -119,6 +181,24 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
             std::uint64_t   size
         ) = 0;
 
+        /**
+        \brief Encodes a buffer copy command for multiple regions between the same two buffers.
+        \param[in,out] dstBuffer Specifies the destination buffer whose data is to be updated.
+        \param[in] srcBuffer Specifies the source buffer whose data is to be read from.
+        \param[in] numRegions Specifies the number of entries in the \c regions array.
+        \param[in] regions Pointer to an array of buffer copy regions. Each region must fit into both buffers. The destination ranges should not overlap.
+        \remarks This is equivalent to calling CopyBuffer(Buffer&, std::uint64_t, Buffer&, std::uint64_t, std::uint64_t) for each region,
+        but backends that interrupt the render pass or insert barriers for copy commands (i.e. Vulkan, Direct3D 12, and Metal) do so only once per batch.
+        The default implementation calls CopyBuffer for each region.
+        \see BufferCopyRegion
+        */
+        virtual void CopyBuffer(
+            Buffer&                     dstBuffer,
+            Buffer&                     srcBuffer,
+            std::uint32_t               numRegions,
+            const BufferCopyRegion*     regions
+        );
+
         /**
         \brief Encodes a buffer copy command that blits data from a source texture.
         \param[in,out] dstBuffer Specifies the destination buffer whose data is to be updated.
@@ -154,6 +234,40 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
             std::uint32_t           layerStride = 0
         ) = 0;
 
+        /**
+        \brief Encodes a copy of the specified buffer range into CPU accessible readback memory that is managed by the render system.
+        \param[in] srcBuffer Specifies the source buffer whose data is to be read from.
+        This buffer must have been created with the binding flag BindFlags::CopySrc.
+        \param[in] srcOffset Specifies the source offset (in bytes) at which the source buffer is to be read from.
+        \param[in] size Specifies the size (in bytes) of the buffer range to copy. This must not be zero.
+        \return Ticket to retrieve the data with RenderSystem::MapReadback once the GPU has executed this command,
+        or Constants::invalidReadbackTicket if the backend does not support asynchronous readbacks.
+        \remarks In contrast to RenderSystem::ReadBuffer, this command does not synchronize the CPU with the GPU.
+        The data becomes available after the command buffer has been submitted and executed,
+        so it is usually mapped one or more frames later, e.g. for GPU picking or video capture.
+        \note Only supported with: Vulkan, Direct3D 12.
+        \see RenderSystem::MapReadback
+        \see RenderSystem::UnmapReadback
+        */
+        virtual std::uint64_t CopyBufferToReadback(Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size);
+
+        /**
+        \brief Encodes a copy of the specified texture region into CPU accessible readback memory that is managed by the render system.
+        \param[in] srcTexture Specifies the source texture whose data is to be read from.
+        This texture must have been created with the binding flag BindFlags::CopySrc and
+        its format <b>must not</b> be compressed (see FormatFlags::IsCompressed) or packed (see FormatFlags::IsPacked).
+        \param[in] srcRegion Specifies the source region where the texture is to be read from.
+        Note that the \c numMipLevels attribute of this parameter \b must be 1.
+        \return Ticket to retrieve the data with RenderSystem::MapReadback once the GPU has executed this command,
+        or Constants::invalidReadbackTicket if the backend does not support asynchronous readbacks.
+        \remarks The texels are stored in the texture's format. The row and layer strides of the readback data depend on the backend
+        and are returned by RenderSystem::MapReadback (see ReadbackLayout).
+        \note Only supported with: Vulkan, Direct3D 12.
+        \see CopyBufferToReadback
+        \see RenderSystem::MapReadback
+        */
+        virtual std::uint64_t CopyTextureToReadback(Texture& srcTexture, const TextureRegion& srcRegion);
+
         /**
         \brief Fills the destination buffer with copies of the specified 32-bit value.
         \param[in,out] dstBuffer Specifies the destination buffer whose data is to be updated.
@@ -195,11 +309,33 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
             const Extent3D&         extent
         ) = 0;
 
+        /**
+        \brief Encodes a texture copy command for multiple regions between the same two textures.
+        \param[in,out] dstTexture Specifies the destination texture whose data is to be updated.
+        \param[in] srcTexture Specifies the source texture whose data is to be read from.
+        \param[in] numRegions Specifies the number of entries in the \c regions array.
+        \param[in] regions Pointer to an array of texture copy regions. Each region must fit into both textures. The destination regions should not overlap.
+        \remarks This is equivalent to calling CopyTexture(Texture&, const TextureLocation&, Texture&, const TextureLocation&, const Extent3D&) for each region,
+        but it is intended for atlas building and texture array packing where hundreds of sub-rectangles are copied at once:
+        Vulkan encodes a single \c vkCmdCopyImage command with all regions, Direct3D 12 encodes all \c CopyTextureRegion commands under one set of resource barriers,
+        and Metal encodes all regions into one blit command encoder.
+        The default implementation calls CopyTexture for each region.
+        \see TextureCopyRegion
+        */
+        virtual void CopyTexture(
+            Texture&                    dstTexture,
+            Texture&                    srcTexture,
+            std::uint32_t               numRegions,
+            const TextureCopyRegion*    regions
+        );
+
         /**
         \brief Encodes a texture copy command that blits data from a source buffer.
         \param[in,out] dstTexture Specifies the destination texture whose data is to be updated.
         This texture must have been created with the binding flag BindFlags::CopyDst and
-        its format <b>must not</b> be compressed (see FormatFlags::IsCompressed) or packed (see FormatFlags::IsPacked).
+        its format <b>must not</b> be packed (see FormatFlags::IsPacked).
+        Compressed formats (see FormatFlags::IsCompressed) are only supported by the Vulkan and OpenGL backends for source data with tightly packed rows of blocks,
+        i.e. \c rowStride and \c layerStride must be 0.
         \param[in] dstRegion Specifies the destination region where the texture is to be updated.
         Note that the \c numMipLevels attribute of this parameter \b must be 1.
         \param[in] srcBuffer Specifies the source buffer whose data is to be read from.
@@ -236,6 +372,9 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         This texture must have been created with the binding flags BindFlags::Sampled and BindFlags::ColorAttachment.
         \remarks For performance reasons, it is recommended to encode this command outside of a render pass.
         Otherwise, render pass interruptions might be inserted by LLGL.
+        \remarks On Vulkan, 2D, 2D-array, and cube textures that were additionally created with BindFlags::Storage generate their MIP-maps with compute shaders
+        if their format supports storage images, reducing two MIP-map levels per dispatch. This invalidates the compute pipeline state and its resource bindings.
+        Otherwise, all array layers of each MIP-map level are generated with a single image blit.
         \see GenerateMips(Texture&, const TextureSubresource&)
         */
         virtual void GenerateMips(Texture& texture) = 0;
@@ -364,6 +503,38 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
             const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined
         ) = 0;
 
+        /**
+        \brief Binds the specified resource heap to the respective pipeline and moves the buffer views of all dynamic-offset bindings.
+        \param[in] resourceHeap Specifies the resource heap that contains all shader resources that will be bound to the shader pipeline.
+        \param[in] descriptorSet Specifies the zero-based index of the first set of resource descriptors. This \b must be in the half-open range <code>[0, ResourceHeap::GetNumDescriptorSets)</code>.
+        \param[in] numDynamicOffsets Specifies the number of entries in the \c dynamicOffsets array.
+        This \b should be equal to the number of bindings with the BindingFlags::DynamicOffset flag in the pipeline layout of the resource heap.
+        Missing dynamic offsets are treated as zero.
+        \param[in] dynamicOffsets Pointer to an array of dynamic offsets (in bytes) ordered by the binding slots of all dynamic-offset bindings.
+        These offsets are added to the buffer view offsets of the respective bindings in the resource heap.
+        Each offset \b must be a multiple of RenderingLimits::minConstantBufferAlignment for constant buffers
+        or RenderingLimits::minStorageBufferAlignment for storage buffers respectively.
+        \param[in] bindPoint Specifies to which pipeline the resource heap is meant be bound. By default PipelineBindPoint::Undefined.
+        \remarks The following example draws a list of objects whose constant data is stored consecutively in a single buffer:
+        \code
+        for (std::uint32_t i = 0; i < numObjects; ++i) {
+            const std::uint32_t dynamicOffset = i * objectConstantsStride;
+            myCmdBuffer->SetResourceHeap(*myResourceHeap, 0, 1, &dynamicOffset);
+            myCmdBuffer->DrawIndexed(numIndices, 0);
+        }
+        \endcode
+        \remarks For all other renderers, the dynamic offsets are ignored and this function is equivalent to SetResourceHeap(ResourceHeap&, std::uint32_t, const PipelineBindPoint).
+        \note Only supported with: Vulkan, Direct3D 12.
+        \see BindingFlags::DynamicOffset
+        */
+        virtual void SetResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           descriptorSet,
+            std::uint32_t           numDynamicOffsets,
+            const std::uint32_t*    dynamicOffsets,
+            const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined
+        ) = 0;
+
         /**
         \brief Sets the specified resource to a binding slot.
         \param[in] resource Specifies the resource to set.
@@ -381,8 +552,10 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         myCmdBuffer->SetResource(*myTexture,        2, LLGL::BindFlags::Sampled,        LLGL::StageFlags::FragmentStage);
         \endcode
         \remarks If direct resource binding is not supported by the render system, this function has no effect.
-        \note Only supported with: OpenGL, Direct3D 11, Metal.
+        \remarks For Direct3D 12, only buffers can be set to binding slots that have been declared with the BindingFlags::DynamicBinding flag in the pipeline layout of the current pipeline state.
+        \note Only supported with: OpenGL, Direct3D 11, Direct3D 12, Metal.
         \see RenderingFeatures::hasDirectResourceBinding
+        \see BindingFlags::DynamicBinding
         \see SetResourceHeap
         */
         virtual void SetResource(
@@ -455,7 +628,7 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         \endcode
         \remarks
         The following commands \b must only be used \b inside a render pass section:
-        - Drawing commands (i.e. \c Draw, \c DrawInstanced, \c DrawIndexed, \c DrawIndexedInstanced, \c DrawIndirect and \c DrawIndexedIndirect).
+        - Drawing commands (i.e. \c Draw, \c DrawInstanced, \c DrawIndexed, \c DrawIndexedInstanced, \c DrawIndirect, \c DrawIndexedIndirect, \c DrawMeshTasks and \c DrawMeshTasksIndirect).
         - Clear attachment commands (i.e. \c Clear and \c ClearAttachments).
         - Query block (i.e. \c BeginQuery and \c EndQuery).
         - Conditional render block (i.e. \c BeginRenderCondition and \c EndRenderCondition).
@@ -487,6 +660,20 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         */
         virtual void EndRenderPass() = 0;
 
+        /**
+        \brief Advances the current render pass to its next subpass.
+        \remarks This must only be called between \c BeginRenderPass and \c EndRenderPass
+        and the active render pass must have been created with more than one subpass (see RenderPassDescriptor::numSubpasses).
+        The number of calls to this function within one render pass must be less than the number of subpasses.
+        \remarks Color attachments that are read as input attachments by the next subpass can be read in the fragment shader
+        at the same pixel location without leaving the render pass if RenderingFeatures::hasFramebufferFetch is supported.
+        Otherwise, the backend splits the render pass and the input attachments must be bound as regular textures.
+        \remarks Graphics PSOs used in each subpass must specify the respective subpass index (see GraphicsPipelineDescriptor::subpass).
+        \see RenderPassDescriptor::subpasses
+        \see RenderingFeatures::hasFramebufferFetch
+        */
+        virtual void NextSubpass();
+
         /**
         \brief Clears the specified group of attachments of the active render target.
         \param[in] flags Specifies the clear buffer flags.
@@ -570,6 +757,17 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         */
         virtual void SetStencilReference(std::uint32_t reference, const StencilFace stencilFace = StencilFace::FrontAndBack) = 0;
 
+        /**
+        \brief Sets the dynamic fragment shading rate for subsequent draw commands.
+        \param[in] rate Specifies the size of the pixel blocks that are shaded by a single fragment shader invocation. The default value is ShadingRate::Rate1x1.
+        \remarks If the current render target has a shading-rate image, the coarser of this rate and the rate of the respective screen tile is used.
+        \remarks The shading rate is reset to ShadingRate::Rate1x1 at the beginning of each command buffer encoding.
+        \note Only supported with: Direct3D 12, Vulkan.
+        \see RenderingFeatures::hasVariableRateShading
+        \see RenderTargetDescriptor::shadingRateImage
+        */
+        virtual void SetShadingRate(const ShadingRate rate);
+
         /**
         \brief Sets the value of a single uniform (a.k.a. shader constant) in the shader program that is currently bound.
         \param[in] location Specifies the location of the uniform.
@@ -596,6 +794,10 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         \param[in] dataSize Specifies the size (in bytes) of the input buffer \c data. This must be a multiple of 4.
         \remarks This function must only be called after a graphics or compute pipeline has been set.
         The order of uniforms that come after the first one can be determined by the ShaderReflection::uniform container returned by Shader::Reflect.
+        \remarks For Direct3D 12, Vulkan, and OpenGL, the uniforms are set to the bindings that have been declared with the BindingFlags::InlineUniforms flag in the pipeline layout of the current pipeline state.
+        For Vulkan, these are recorded as push constants and the location of a push constant block member is its offset divided by 4 (see ShaderReflection::uniforms).
+        For OpenGL, the shader program uniforms are set instead if the pipeline layout does not declare any inline uniform bindings.
+        The location specifies the first 32-bit value, see BindingFlags::InlineUniforms.
         \note Only supported with: OpenGL, Vulkan, Direct3D 12.
         \see Shader::FindUniformLocation
         \see Shader::Reflect
@@ -631,6 +833,21 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         */
         virtual void EndQuery(QueryHeap& queryHeap, std::uint32_t query = 0) = 0;
 
+        /**
+        \brief Resolves the results of the specified queries asynchronously into the readback ring of the query heap.
+        \param[in] queryHeap Specifies the query heap. This must not have been created with QueryHeapDescriptor::renderCondition enabled.
+        \param[in] firstQuery Specifies the zero-based index of the first query within the heap.
+        This must be in the half-open range [0, QueryHeapDescriptor::numQueries).
+        \param[in] numQueries Specifies the number of queries to resolve.
+        This must be less than or equal to (QueryHeapDescriptor::numQueries - firstQuery) and it must not be zero.
+        \remarks All queries within the specified range must have been ended before this command, e.g. earlier in the same command buffer.
+        The results become available once the GPU has executed this command and can then be retrieved with CommandQueue::TryGetQueryResults without blocking.
+        Each query heap holds a ring of readback slots that grows as needed, so the results of several frames can be in flight at the same time.
+        \note Only supported with: Vulkan, Direct3D 12.
+        \see CommandQueue::TryGetQueryResults
+        */
+        virtual void ResolveQueries(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries);
+
         /**
         \brief Begins conditional rendering with the specified query object.
         \param[in] queryHeap Specifies the query heap.
@@ -807,6 +1024,129 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         */
         virtual void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) = 0;
 
+        /**
+        \brief Draws primitives whose draw command arguments and number of draw commands are taken from buffer objects.
+        \param[in] buffer Specifies the buffer from which the draw command arguments are taken. This buffer must have been created with the BindFlags::IndirectBuffer flag.
+        \param[in] offset Specifies an offset within the argument buffer from which the arguments are to be taken. This offset must be a multiple of 4.
+        \param[in] countBuffer Specifies the buffer from which the number of draw commands is taken as 32-bit unsigned integer.
+        This buffer must have been created with the BindFlags::IndirectBuffer flag.
+        \param[in] countOffset Specifies an offset within the count buffer from which the number of draw commands is to be taken. This offset must be a multiple of 4.
+        \param[in] maxNumCommands Specifies the maximum number of draw commands. The number taken from the count buffer is clamped to this value.
+        \param[in] stride Specifies the stride (in bytes) betweeen consecutive sets of arguments,
+        which is commonly greater than or euqal to <code>sizeof(DrawIndirectArguments)</code>. This stride must be a multiple of 4.
+        \remarks This allows a GPU culling pass to write the number of surviving draw commands into a buffer without reading it back to the CPU.
+        If RenderingFeatures::hasIndirectCountDrawing is false, the number of draw commands is read back from the count buffer by the CPU instead.
+        This synchronizes with the GPU and only takes values into account that have been written by previously submitted command buffers.
+        The Vulkan renderer does not provide this fallback.
+        \see DrawIndirectArguments
+        \see RenderingFeatures::hasIndirectCountDrawing
+        */
+        virtual void DrawIndirectCount(
+            Buffer&         buffer,
+            std::uint64_t   offset,
+            Buffer&         countBuffer,
+            std::uint64_t   countOffset,
+            std::uint32_t   maxNumCommands,
+            std::uint32_t   stride
+        ) = 0;
+
+        /**
+        \brief Draws indexed primitives whose draw command arguments and number of draw commands are taken from buffer objects.
+        \param[in] buffer Specifies the buffer from which the draw command arguments are taken. This buffer must have been created with the BindFlags::IndirectBuffer flag.
+        \param[in] offset Specifies an offset within the argument buffer from which the arguments are to be taken. This offset must be a multiple of 4.
+        \param[in] countBuffer Specifies the buffer from which the number of draw commands is taken as 32-bit unsigned integer.
+        This buffer must have been created with the BindFlags::IndirectBuffer flag.
+        \param[in] countOffset Specifies an offset within the count buffer from which the number of draw commands is to be taken. This offset must be a multiple of 4.
+        \param[in] maxNumCommands Specifies the maximum number of draw commands. The number taken from the count buffer is clamped to this value.
+        \param[in] stride Specifies the stride (in bytes) betweeen consecutive sets of arguments,
+        which is commonly greater than or euqal to <code>sizeof(DrawIndexedIndirectArguments)</code>. This stride must be a multiple of 4.
+        \remarks See DrawIndirectCount for the fallback if RenderingFeatures::hasIndirectCountDrawing is false.
+        \see DrawIndexedIndirectArguments
+        \see RenderingFeatures::hasIndirectCountDrawing
+        */
+        virtual void DrawIndexedIndirectCount(
+            Buffer&         buffer,
+            std::uint64_t   offset,
+            Buffer&         countBuffer,
+            std::uint64_t   countOffset,
+            std::uint32_t   maxNumCommands,
+            std::uint32_t   stride
+        ) = 0;
+
+        /**
+        \brief Draws instances of primitives from the currently set vertex buffer and returns a patch slot for the draw command arguments.
+        \param[in] args Specifies the initial draw command arguments.
+        \return Patch slot that can be passed to PatchDraw to modify the arguments of this draw command after the command buffer has been encoded,
+        or Constants::invalidPatchSlot if the backend does not support patchable draw commands.
+        \remarks Patchable draw commands allow multi-submit command buffers to be re-submitted with different vertex counts, instance counts, or vertex offsets
+        without encoding the command buffer again. Base offsets into the vertex buffers can be patched via DrawIndirectArguments::firstVertex.
+        Patch slots are only valid until the next call to Begin.
+        \remarks If this function returns Constants::invalidPatchSlot, the draw command has been encoded like DrawInstanced with the same arguments,
+        i.e. the command buffer must be encoded again to change them. This is the case for the Direct3D 11 and Metal backends.
+        \see PatchDraw
+        \see CommandBufferFlags::MultiSubmit
+        */
+        virtual std::uint32_t DrawPatchable(const DrawIndirectArguments& args);
+
+        /**
+        \brief Draws instances of primitives from the currently set vertex- and index buffers and returns a patch slot for the draw command arguments.
+        \param[in] args Specifies the initial indexed draw command arguments.
+        \return Patch slot that can be passed to PatchDrawIndexed, or Constants::invalidPatchSlot if the backend does not support patchable draw commands.
+        \remarks If this function returns Constants::invalidPatchSlot, the draw command has been encoded like DrawIndexedInstanced with the same arguments.
+        \see DrawPatchable
+        \see PatchDrawIndexed
+        */
+        virtual std::uint32_t DrawIndexedPatchable(const DrawIndexedIndirectArguments& args);
+
+        /**
+        \brief Modifies the arguments of a draw command that has been encoded with DrawPatchable.
+        \param[in] slot Specifies the patch slot that has been returned by DrawPatchable.
+        \param[in] args Specifies the new draw command arguments.
+        \return True if the arguments have been patched. False if the slot is invalid or the backend does not support patchable draw commands.
+        \remarks The command buffer must be outside of Begin and End, and the GPU must have finished any previous submission of this command buffer,
+        e.g. by waiting on a fence that has been submitted after it. The new arguments are used by the next submission.
+        */
+        virtual bool PatchDraw(std::uint32_t slot, const DrawIndirectArguments& args);
+
+        /**
+        \brief Modifies the arguments of an indexed draw command that has been encoded with DrawIndexedPatchable.
+        \param[in] slot Specifies the patch slot that has been returned by DrawIndexedPatchable.
+        \param[in] args Specifies the new indexed draw command arguments.
+        \return True if the arguments have been patched. False if the slot is invalid or the backend does not support patchable draw commands.
+        \remarks The same synchronization rules as for PatchDraw apply.
+        \see PatchDraw
+        */
+        virtual bool PatchDrawIndexed(std::uint32_t slot, const DrawIndexedIndirectArguments& args);
+
+        /**
+        \brief Draws mesh tasks with the currently bound mesh shader pipeline.
+        \param[in] numWorkGroupsX Specifies the number of task workgroups in the X-dimension. If the pipeline has no task shader, this is the number of mesh workgroups.
+        \param[in] numWorkGroupsY Specifies the number of task workgroups in the Y-dimension.
+        \param[in] numWorkGroupsZ Specifies the number of task workgroups in the Z-dimension.
+        \remarks The currently bound graphics pipeline must have been created with a mesh shader, i.e. GraphicsPipelineDescriptor::meshShader.
+        No vertex or index buffers are read by mesh shader pipelines.
+        \remarks If RenderingFeatures::hasMeshShaders is false, this command has no effect.
+        \see GraphicsPipelineDescriptor::taskShader
+        \see GraphicsPipelineDescriptor::meshShader
+        \see RenderingLimits::maxMeshShaderWorkGroups
+        */
+        virtual void DrawMeshTasks(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ);
+
+        /**
+        \brief Draws mesh tasks whose workgroup counts are taken from a buffer object.
+        \param[in] buffer Specifies the buffer from which the draw command arguments are taken. This buffer must have been created with the BindFlags::IndirectBuffer flag.
+        \param[in] offset Specifies an offset within the argument buffer from which the arguments are to be taken. This offset must be a multiple of 4.
+        \param[in] numCommands Specifies the number of draw commands that are to be taken from the argument buffer.
+        \param[in] stride Specifies the stride (in bytes) betweeen consecutive sets of arguments,
+        which is commonly greater than or euqal to <code>sizeof(DrawMeshTasksIndirectArguments)</code>. This stride must be a multiple of 4.
+        \remarks This allows a GPU culling pass to write the number of surviving meshlet groups into a buffer without reading it back to the CPU.
+        \remarks The Metal backend only supports a single indirect command per call via MTLRenderCommandEncoder::drawMeshThreadgroupsWithIndirectBuffer,
+        so multiple commands are encoded as consecutive indirect draw calls.
+        \remarks If RenderingFeatures::hasMeshShaders is false, this command has no effect.
+        \see DrawMeshTasksIndirectArguments
+        */
+        virtual void DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands = 1, std::uint32_t stride = sizeof(DrawMeshTasksIndirectArguments));
+
         /* ----- Compute ----- */
 
         /**
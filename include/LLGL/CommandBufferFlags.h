@@ -16,11 +16,16 @@ namespace LLGL
 {
 
 
+class RenderTarget;
+
+
 /* ----- Enumerations ----- */
 
 /**
 \brief Render condition mode enumeration.
 \remarks The condition is determined by the type of the QueryHeap object.
+\remarks On OpenGL, the inverted modes require GL 4.5 or the \c GL_ARB_conditional_render_inverted extension.
+Otherwise, the render condition is ignored and no commands are skipped.
 \see CommandBuffer::BeginRenderCondition
 */
 enum class RenderConditionMode
@@ -69,6 +74,25 @@ enum class PipelineBindPoint
     Compute,    //!< Compute pipeline binding point.
 };
 
+/**
+\brief Fragment shading rate enumeration.
+\remarks Each enumeration entry specifies the size (width by height) of a pixel block that is shaded by a single fragment shader invocation.
+\remarks The shading rate can also be specified per screen tile with a shading-rate image.
+Each texel of that image contains the shading rate encoded as <code>(log2(width) << 2) | log2(height)</code>, e.g. \c 0x5 for 2x2.
+\see CommandBuffer::SetShadingRate
+\see RenderTargetDescriptor::shadingRateImage
+*/
+enum class ShadingRate
+{
+    Rate1x1,    //!< Full shading rate, i.e. one fragment shader invocation per pixel. This is the default.
+    Rate1x2,    //!< One fragment shader invocation per 1x2 pixel block.
+    Rate2x1,    //!< One fragment shader invocation per 2x1 pixel block.
+    Rate2x2,    //!< One fragment shader invocation per 2x2 pixel block.
+    Rate2x4,    //!< One fragment shader invocation per 2x4 pixel block.
+    Rate4x2,    //!< One fragment shader invocation per 4x2 pixel block.
+    Rate4x4,    //!< One fragment shader invocation per 4x4 pixel block.
+};
+
 
 /* ----- Flags ----- */
 
@@ -85,8 +109,10 @@ struct CommandBufferFlags
         /**
         \brief Specifies that the encoded command buffer will be submitted as a secondary command buffer.
         \remarks If this is specified, the command buffer must be submitted using the \c Execute function of a primary command buffer.
+        Secondary command buffers can be encoded on multiple threads simultaneously, as long as each command buffer is only encoded by one thread at a time.
         \remakrs This cannot be used in combination with the \c ImmediateSubmit flag.
         \see CommandBuffer::Execute
+        \see CommandBufferDescriptor::renderTarget
         */
         Secondary       = (1 << 0),
 
@@ -106,6 +132,15 @@ struct CommandBufferFlags
         \see CommandBuffer::End
         */
         ImmediateSubmit = (1 << 2),
+
+        /**
+        \brief Specifies that the command buffer is encoded for the asynchronous compute queue.
+        \remarks If this is specified, the command buffer must only be submitted to the command queue returned by RenderSystem::GetComputeQueue
+        and it must only encode compute, copy, barrier, and query commands, i.e. no render passes and no draw commands.
+        \remarks This is ignored if the render system has no asynchronous compute queue.
+        \see RenderSystemFlags::AsyncComputeQueue
+        */
+        ComputeQueue    = (1 << 3),
     };
 };
 
@@ -295,6 +330,29 @@ struct CommandBufferDescriptor
     \see CommandBuffer::Begin
     */
     std::uint32_t   numNativeBuffers    = 2;
+
+    /**
+    \brief Specifies the maximum number of internal native command buffers. By default 4.
+    \remarks If all native command buffers are still in flight when encoding begins, the command buffer allocates another one
+    instead of waiting for the GPU until this limit is reached. Values less than \c numNativeBuffers are treated as \c numNativeBuffers.
+    \remarks This is only a hint to the framework and currently only used by the Vulkan backend.
+    \see numNativeBuffers
+    \see CommandBuffer::QueryBeginStalls
+    */
+    std::uint32_t   maxNativeBuffers    = 4;
+
+    /**
+    \brief Specifies the render target the secondary command buffer is executed with. By default null.
+    \remarks This is only used for secondary command buffers (i.e. with the CommandBufferFlags::Secondary flag) that are executed inside a render pass,
+    i.e. between CommandBuffer::BeginRenderPass and CommandBuffer::EndRenderPass of the primary command buffer.
+    This can be either a SwapChain or RenderTarget object and it must be the same one the render pass of the primary command buffer is started with.
+    Such a secondary command buffer inherits the render target, so it must not call BeginRenderPass or any blitting commands itself.
+    \remarks For Vulkan, this provides the render pass inheritance information. For Direct3D 11, the render target is bound to the deferred context.
+    Direct3D 12 bundles, Metal, and OpenGL command buffers inherit the render target implicitly, though.
+    \see CommandBufferFlags::Secondary
+    \see CommandBuffer::Execute
+    */
+    RenderTarget*   renderTarget        = nullptr;
 };
 
 
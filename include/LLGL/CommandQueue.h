@@ -51,13 +51,17 @@ class LLGL_EXPORT CommandQueue : public RenderSystemChild
         */
         virtual void Submit(CommandBuffer& commandBuffer) = 0;
 
-        #if 0
         /**
         \brief Submits all command buffers in the specified array to the command queue at once.
+        \param[in] numCommandBuffers Specifies the number of command buffers in the array \c commandBuffers.
+        \param[in] commandBuffers Pointer to an array of command buffers that are to be submitted in the specified order.
+        Command buffers that were created with the CommandBufferFlags::ImmediateSubmit flag are ignored.
+        \remarks The default implementation calls Submit(CommandBuffer&) for each command buffer.
+        Backends with native batch submission (i.e. Vulkan and Direct3D 12) override this function to submit all command buffers with a single submission,
+        which is considerably faster than submitting each command buffer individually when many command buffers are recorded per frame.
         \see Submit(CommandBuffer&)
         */
         virtual void Submit(std::uint32_t numCommandBuffers, CommandBuffer* const * commandBuffers);
-        #endif
 
         /* ----- Queries ----- */
 
@@ -96,6 +100,61 @@ class LLGL_EXPORT CommandQueue : public RenderSystemChild
             std::size_t     dataSize
         ) = 0;
 
+        /**
+        \brief Retrieves the results of all query ranges that have been resolved with CommandBuffer::ResolveQueries and completed by the GPU, without waiting.
+        \param[in] queryHeap Specifies the query heap whose resolved results are to be retrieved.
+        \param[out] data Specifies the pointer to the output data. This must be a valid pointer to an array of QueryHeapDescriptor::numQueries entries,
+        i.e. the array covers the entire query heap and each result is written to the entry at its query index. Entries of queries that are not part of any returned range are left unchanged.
+        The array entries must have one of the types that are described for QueryResult.
+        \param[in] dataSize Specifies the size (in bytes) of the output data.
+        This must be equal to <code>QueryHeapDescriptor::numQueries * sizeof(T)</code> where \c T is the type of the query entries.
+        \param[out] outRanges Specifies the pointer to the output array of query ranges that have been written to \c data.
+        This must be a valid pointer to an array of at least \c maxRanges entries.
+        \param[in] maxRanges Specifies the maximum number of ranges that can be written to \c outRanges.
+        \return Number of ranges that have been written to \c outRanges. This is zero if no resolved results have been completed yet or if the backend does not support asynchronous query resolves.
+        \remarks The completed ranges are returned in the order they have been resolved, so if a query is part of multiple returned ranges, its entry in \c data holds the most recent result.
+        Each resolved range is returned only once. Completed ranges that do not fit into \c outRanges remain pending and are returned by the next call.
+        Here is an example for occlusion culling, where the visibility of the previous frames is used without a CPU/GPU synchronization:
+        \code
+        // Record occlusion queries and resolve them at the end of the frame
+        for (std::uint32_t i = 0; i < numObjects; ++i)
+        {
+            myCmdBuffer->BeginQuery(*myOcclusionQueries, i);
+            // draw bounding box of object i ...
+            myCmdBuffer->EndQuery(*myOcclusionQueries, i);
+        }
+        myCmdBuffer->ResolveQueries(*myOcclusionQueries, 0, numObjects);
+
+        // Fetch whatever results have been completed in the meantime
+        LLGL::QueryRange ranges[8];
+        std::uint32_t numRanges = myCmdQueue->TryGetQueryResults(*myOcclusionQueries, myVisibility.data(), myVisibility.size() * sizeof(std::uint64_t), ranges, 8);
+        \endcode
+        \note Only supported with: Vulkan, Direct3D 12.
+        \see CommandBuffer::ResolveQueries
+        \see QueryResult
+        */
+        virtual std::uint32_t TryGetQueryResults(
+            QueryHeap&      queryHeap,
+            void*           data,
+            std::size_t     dataSize,
+            QueryRange*     outRanges,
+            std::uint32_t   maxRanges
+        );
+
+        /**
+        \brief Samples a pair of CPU and GPU timestamps at the same point in time to correlate the GPU timeline of this command queue with the CPU timeline.
+        \param[out] outTimestamps Specifies the output structure for the calibrated timestamps.
+        The CPU timestamp is in the same time domain as Timer::Tick.
+        \return True on success, or false if the backend does not support timestamp calibration. In the latter case, \c outTimestamps is left unchanged.
+        \remarks Vulkan requires the \c VK_EXT_calibrated_timestamps extension with a time domain that matches Timer::Tick
+        (i.e. \c CLOCK_MONOTONIC on Linux and Android and the performance counter on Windows).
+        OpenGL requires \c GL_ARB_timer_query and samples both timestamps in sequence, so the reported deviation includes the latency of the \c GL_TIMESTAMP query.
+        \note Only supported with: OpenGL, Vulkan, Direct3D 12.
+        \see CalibratedTimestamps
+        \see Timer::Tick
+        */
+        virtual bool QueryCalibratedTimestamps(CalibratedTimestamps& outTimestamps);
+
         /* ----- Fences ----- */
 
         //! Submits the specified fence to the command queue for CPU/GPU synchronization.
@@ -111,6 +170,33 @@ class LLGL_EXPORT CommandQueue : public RenderSystemChild
         */
         virtual bool WaitFence(Fence& fence, std::uint64_t timeout) = 0;
 
+        /**
+        \brief Blocks the CPU execution until the specified fence has reached the specified value.
+        \param[in] fence Specifies the fence for which the CPU needs to wait.
+        \param[in] value Specifies the fence value to wait for. This must not be greater than the value returned by Fence::GetValue.
+        \param[in] timeout Specifies the waiting timeout (in nanoseconds).
+        \return True on success, or false if the fence has a timeout (in nanoseconds) or the device is lost.
+        \remarks In contrast to WaitFence, this only waits until the specified submission of the fence has been signaled,
+        so the CPU does not need to wait for the most recent submission. The default implementation returns immediately
+        if the completed value of the fence has reached \c value and otherwise waits for the most recent submission via WaitFence.
+        If the backend does not track fence values (i.e. Fence::GetValue returns 0), it always waits via WaitFence.
+        \see Fence::GetValue
+        \see Fence::GetCompletedValue
+        */
+        virtual bool WaitFenceValue(Fence& fence, std::uint64_t value, std::uint64_t timeout);
+
+        /**
+        \brief Submits a GPU-side wait to this command queue, so all subsequently submitted work waits until the specified fence has reached the specified value.
+        \param[in] fence Specifies the fence to wait for. This is usually submitted to another command queue, e.g. the asynchronous compute queue.
+        \param[in] value Specifies the fence value to wait for. This must not be greater than the value returned by Fence::GetValue.
+        \remarks In contrast to WaitFenceValue, this does not block the CPU execution on backends that support cross-queue synchronization.
+        The default implementation blocks the CPU via WaitFenceValue instead.
+        \remarks For Vulkan, the fence is only waited on by the GPU if it is backed by a timeline semaphore (VK_KHR_timeline_semaphore).
+        \see RenderSystem::GetComputeQueue
+        \see Submit(Fence&)
+        */
+        virtual void SubmitWait(Fence& fence, std::uint64_t value);
+
         /**
         \brief Blocks the CPU execution until the entire GPU command queue has been completed.
         \remarks To wait for a specific point in the command queue, use fences.
@@ -62,6 +62,31 @@ constexpr std::uint64_t wholeSize       = -1;
 */
 constexpr std::uint32_t invalidTimerID  = 0u;
 
+/**
+\brief Specifies an invalid render graph resource.
+\see RenderGraphAttachment::resource
+*/
+constexpr std::uint32_t invalidRenderGraphResource = -1;
+
+/**
+\brief Specifies an invalid patch slot for draw commands.
+\see CommandBuffer::DrawPatchable
+*/
+constexpr std::uint32_t invalidPatchSlot = -1;
+
+/**
+\brief Specifies an invalid readback ticket.
+\see CommandBuffer::CopyBufferToReadback
+\see CommandBuffer::CopyTextureToReadback
+*/
+constexpr std::uint64_t invalidReadbackTicket = 0;
+
+/**
+\brief Specifies an invalid geometry pool handle.
+\see GeometryPool::Allocate
+*/
+constexpr std::uint32_t invalidGeometryPoolHandle = -1;
+
 
 } // /namespace Constants
 
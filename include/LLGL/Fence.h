@@ -10,6 +10,7 @@
 
 
 #include <LLGL/RenderSystemChild.h>
+#include <cstdint>
 
 
 namespace LLGL
@@ -18,13 +19,45 @@ namespace LLGL
 
 /**
 \brief Fence interface for CPU/GPU synchronization.
+\remarks A fence has a monotonically increasing 64-bit value that is incremented by one with each submission of the fence.
+This allows a single fence to track the progress of many frames, e.g. to only wait for the frame before the previous one:
+\code
+// Submit fence at the end of each frame and store its value
+myCmdQueue->Submit(*myFence);
+myFrameFenceValues[myFrameIndex] = myFence->GetValue();
+
+// Wait until the GPU has finished the frame that used the same resources as the next frame
+myCmdQueue->WaitFenceValue(*myFence, myFrameFenceValues[(myFrameIndex + 1) % 2], ~0ull);
+\endcode
 \see RenderSystem::CreateFence
 \see CommandQueue::Submit(Fence&)
 \see CommandQueue::WaitFence
+\see CommandQueue::WaitFenceValue
 */
 class LLGL_EXPORT Fence : public RenderSystemChild
 {
-    LLGL_DECLARE_INTERFACE( InterfaceID::Fence );
+
+        LLGL_DECLARE_INTERFACE( InterfaceID::Fence );
+
+    public:
+
+        /**
+        \brief Returns the value that is signaled by the most recent submission of this fence.
+        \remarks This is 0 if the fence has not been submitted yet and is incremented by one with each call to CommandQueue::Submit(Fence&).
+        The default implementation returns 0, i.e. the backend does not track fence values and CommandQueue::WaitFenceValue falls back to CommandQueue::WaitFence.
+        \see CommandQueue::Submit(Fence&)
+        */
+        virtual std::uint64_t GetValue() const;
+
+        /**
+        \brief Returns the highest value that has already been signaled by the GPU.
+        \remarks This is less than or equal to the value returned by GetValue. Memory that was used by submissions
+        up to a certain fence value can be recycled as soon as the completed value has reached that value.
+        The default implementation returns 0, i.e. the backend does not track fence values.
+        \see GetValue
+        */
+        virtual std::uint64_t GetCompletedValue() const;
+
 };
 
 
@@ -61,7 +61,10 @@ struct MetalDependentStateDescriptor;
 struct PipelineLayoutDescriptor;
 struct QueryHeapDescriptor;
 struct QueryPipelineStatistics;
+struct QueryRange;
+struct CalibratedTimestamps;
 struct RasterizerDescriptor;
+struct ReadbackLayout;
 struct RendererConfigurationOpenGL;
 struct RendererConfigurationVulkan;
 struct RendererInfo;
@@ -83,6 +86,7 @@ struct SrcImageDescriptor;
 struct StencilDescriptor;
 struct StencilFaceDescriptor;
 struct SwapChainDescriptor;
+struct TextureCopyRegion;
 struct TextureDescriptor;
 struct TextureRegion;
 struct TextureViewDescriptor;
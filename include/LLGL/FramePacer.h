@@ -0,0 +1,135 @@
+/*
+ * FramePacer.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_FRAME_PACER_H
+#define LLGL_FRAME_PACER_H
+
+
+#include <LLGL/Export.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class SwapChain;
+class RenderingProfiler;
+
+/**
+\brief Frame pacer descriptor structure.
+\see FramePacer
+*/
+struct FramePacerDescriptor
+{
+    /**
+    \brief Nominal refresh rate (in Hz) of the display. By default 0.
+    \remarks If this is 0, the refresh rate of the primary display is used (see Display::GetDisplayMode), or 60 Hz if there is no display.
+    Since displays only report an integral refresh rate, the actual refresh period is calibrated with the presentation statistics of \c swapChain (if specified).
+    */
+    double              refreshRate = 0.0;
+
+    /**
+    \brief Number of refresh cycles per frame. By default 1.
+    \remarks For example, an interval of 2 on a 60 Hz display paces the frames at 30 Hz.
+    */
+    std::uint32_t       interval    = 1;
+
+    /**
+    \brief Optional swap-chain whose presentation statistics are used to calibrate the refresh period and to detect missed vertical blanks. By default null.
+    \remarks If the swap-chain does not provide presentation statistics (see SwapChain::QueryPresentStatistics),
+    the frame pacer only relies on the CPU timer and counts each frame interval the CPU missed.
+    The swap-chain is not owned by the frame pacer, i.e. it must remain valid for the lifetime of the frame pacer.
+    */
+    SwapChain*          swapChain   = nullptr;
+
+    /**
+    \brief Optional profiler to report the missed vertical blanks to. By default null.
+    \remarks The missed vertical blanks are added to FrameProfile::missedVSyncs of the current frame profile.
+    \see FrameProfile::missedVSyncs
+    */
+    RenderingProfiler*  profiler    = nullptr;
+
+    /**
+    \brief Time (in microseconds) before each frame deadline that is spent in a busy-wait loop instead of a blocking wait. By default 1000.
+    \remarks OS timers may wake up the thread too late, so the last part of each wait is spent spinning on Timer::Tick.
+    Higher values improve the precision at the cost of CPU time.
+    */
+    std::uint32_t       spinTime    = 1000;
+};
+
+/**
+\brief Frame pacing utility to present frames at stable intervals.
+\remarks The frame pacer blocks the calling thread until the next frame interval begins, using a high resolution OS timer (see Timer::WaitUntil)
+followed by a short busy-wait. The deadlines are accumulated rather than measured from the previous wake up, so oversleeping never adds up to drift.
+Here is an example of a 60 Hz frame loop:
+\code
+LLGL::FramePacerDescriptor pacerDesc;
+pacerDesc.refreshRate   = 60.0;
+pacerDesc.swapChain     = mySwapChain;
+pacerDesc.profiler      = &myProfiler;
+LLGL::FramePacer myPacer{ pacerDesc };
+
+while (myWindow.ProcessEvents())
+{
+    myPacer.Wait();
+    // Sample input, encode and submit command buffers ...
+    mySwapChain->Present();
+}
+\endcode
+\note This class is not thread-safe.
+\see Timer::WaitUntil
+\see SwapChain::QueryPresentStatistics
+*/
+class LLGL_EXPORT FramePacer
+{
+
+    public:
+
+        FramePacer(const FramePacer&) = delete;
+        FramePacer& operator = (const FramePacer&) = delete;
+
+        //! Initializes the frame pacer with the specified descriptor.
+        FramePacer(const FramePacerDescriptor& desc);
+
+        ~FramePacer();
+
+        /**
+        \brief Blocks until the next frame interval begins. Call this once per frame, e.g. before the input is sampled.
+        \remarks If the previous frame took longer than a frame interval, this function returns immediately,
+        the missed intervals are counted, and the next deadline is aligned to the interval grid again.
+        */
+        void Wait();
+
+        //! Resets the frame deadline and the missed vertical blank counter, e.g. after the application was paused.
+        void Reset();
+
+        /**
+        \brief Returns the current frame interval (in seconds).
+        \remarks This is the calibrated refresh period multiplied by FramePacerDescriptor::interval.
+        */
+        double GetFrameInterval() const;
+
+        //! Returns the total number of missed vertical blanks since the frame pacer was created or reset.
+        std::uint64_t GetMissedVSyncs() const;
+
+    private:
+
+        struct Pimpl;
+        Pimpl* pimpl_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,234 @@
+/*
+ * GeometryPool.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GEOMETRY_POOL_H
+#define LLGL_GEOMETRY_POOL_H
+
+
+#include <LLGL/NonCopyable.h>
+#include <LLGL/Format.h>
+#include <LLGL/VertexAttribute.h>
+#include <LLGL/IndirectArguments.h>
+#include <LLGL/Constants.h>
+#include <LLGL/Container/ArrayView.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class RenderSystem;
+class Buffer;
+
+/* ----- Types ----- */
+
+/**
+\brief Handle of a geometry pool allocation.
+\remarks Handles remain valid across GeometryPool::Defragment, only the vertex and index ranges they refer to may change.
+\see GeometryPool::Allocate
+*/
+using GeometryPoolHandle = std::uint32_t;
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Geometry pool descriptor structure.
+\see GeometryPool::GeometryPool
+*/
+struct GeometryPoolDescriptor
+{
+    /**
+    \brief Vertex attributes of all meshes in the pool.
+    \remarks The vertex stride is taken from the first attribute, i.e. all attributes must refer to the same interleaved vertex buffer.
+    The attributes are copied into the pool, so this array view only needs to be valid during construction.
+    \see BufferDescriptor::vertexAttribs
+    */
+    ArrayView<VertexAttribute>  vertexAttribs;
+
+    //! Format of the index buffers. This must be either Format::R16UInt or Format::R32UInt. By default Format::R32UInt.
+    Format                      indexFormat         = Format::R32UInt;
+
+    /**
+    \brief Number of vertices each page can hold. By default 1048576.
+    \remarks Each page consists of one vertex and one index buffer. Allocations that exceed this capacity get a page of their own size.
+    */
+    std::uint32_t               verticesPerPage     = 1024u * 1024u;
+
+    //! Number of indices each page can hold. By default 4194304.
+    std::uint32_t               indicesPerPage      = 4u * 1024u * 1024u;
+
+    /**
+    \brief Additional binding flags for the vertex and index buffers of each page. By default 0.
+    \remarks BindFlags::VertexBuffer, BindFlags::IndexBuffer, BindFlags::CopySrc, and BindFlags::CopyDst are always included.
+    Add BindFlags::Storage for instance, to read the geometry from a compute shader that generates indirect draw commands.
+    \see BindFlags
+    */
+    long                        bindFlags           = 0;
+};
+
+/**
+\brief Geometry pool allocation structure.
+\remarks The vertex data of an allocation occupies the vertices <code>[firstVertex, firstVertex + numVertices)</code> of the vertex buffer,
+and the indices of an allocation are relative to the first vertex, so they don't have to be rewritten when the vertices are moved.
+Add the allocation to a draw command with <code>DrawIndexed(numIndices, firstIndex, static_cast<std::int32_t>(firstVertex))</code>.
+\see GeometryPool::GetAllocation
+*/
+struct GeometryPoolAllocation
+{
+    //! Vertex buffer of the page this allocation has been sub-allocated from. This is null if the handle is invalid.
+    Buffer*         vertexBuffer    = nullptr;
+
+    //! Index buffer of the page this allocation has been sub-allocated from. This is null if the handle is invalid.
+    Buffer*         indexBuffer     = nullptr;
+
+    //! Zero-based index of the page this allocation has been sub-allocated from.
+    std::uint32_t   page            = 0;
+
+    //! Index of the first vertex within the vertex buffer.
+    std::uint32_t   firstVertex     = 0;
+
+    //! Number of vertices of this allocation.
+    std::uint32_t   numVertices     = 0;
+
+    //! Index of the first index within the index buffer.
+    std::uint32_t   firstIndex      = 0;
+
+    //! Number of indices of this allocation.
+    std::uint32_t   numIndices      = 0;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Sub-allocator for vertex and index ranges of a few large buffers.
+\remarks This pool replaces one vertex and index buffer per mesh with ranges of shared buffer pages,
+so all meshes of a page can be drawn with a single vertex and index buffer binding, e.g. by a single multi-draw indirect command.
+\remarks Here is an example how to draw all meshes of the first page with a single indirect draw command:
+\code
+LLGL::GeometryPoolDescriptor myPoolDesc;
+myPoolDesc.vertexAttribs = myVertexFormat.attributes;
+LLGL::GeometryPool myPool{ *myRenderer, myPoolDesc };
+
+// Sub-allocate and upload meshes
+for (auto& myMesh : myMeshes)
+    myMesh.handle = myPool.Allocate(myMesh.numVertices, myMesh.numIndices, myMesh.vertices.data(), myMesh.indices.data());
+
+// Generate indirect draw arguments
+std::vector<LLGL::DrawIndexedIndirectArguments> myDrawArgs(myMeshes.size());
+for (std::size_t i = 0; i < myMeshes.size(); ++i)
+    myPool.GetDrawArguments(myMeshes[i].handle, myDrawArgs[i]);
+myRenderer->WriteBuffer(*myIndirectBuffer, 0, myDrawArgs.data(), myDrawArgs.size() * sizeof(LLGL::DrawIndexedIndirectArguments));
+
+// Bind page once and draw all meshes
+myCmdBuffer->SetVertexBuffer(*myPool.GetVertexBuffer(0));
+myCmdBuffer->SetIndexBuffer(*myPool.GetIndexBuffer(0));
+myCmdBuffer->DrawIndexedIndirect(*myIndirectBuffer, 0, static_cast<std::uint32_t>(myDrawArgs.size()), sizeof(LLGL::DrawIndexedIndirectArguments));
+\endcode
+\note This class is not thread-safe.
+\see CommandBuffer::DrawIndexed(std::uint32_t, std::uint32_t, std::int32_t)
+\see CommandBuffer::DrawIndexedIndirect(Buffer&, std::uint64_t, std::uint32_t, std::uint32_t)
+*/
+class LLGL_EXPORT GeometryPool : public NonCopyable
+{
+
+    public:
+
+        /**
+        \brief Initializes the geometry pool for the specified render system. No pages are allocated until the first call to Allocate.
+        \remarks The render system must outlive this pool. All buffer pages are released with its destruction.
+        */
+        GeometryPool(RenderSystem& renderSystem, const GeometryPoolDescriptor& poolDesc);
+
+        //! Releases all buffer pages.
+        ~GeometryPool();
+
+        /**
+        \brief Sub-allocates the specified number of vertices and indices from the same page.
+        \param[in] numVertices Specifies the number of vertices. This must not be zero.
+        \param[in] numIndices Specifies the number of indices. This can be zero for non-indexed geometry.
+        \param[in] vertices Optional pointer to the initial vertex data. If this is not null, it must point to <code>numVertices * stride</code> bytes.
+        \param[in] indices Optional pointer to the initial index data. If this is not null, it must point to <code>numIndices</code> elements of the index format.
+        The indices must be relative to the first vertex of this allocation.
+        \return Handle of the new allocation or Constants::invalidGeometryPoolHandle if the allocation failed.
+        \remarks If no page has enough contiguous space left, a new page is created.
+        \see GeometryPoolDescriptor::verticesPerPage
+        */
+        GeometryPoolHandle Allocate(
+            std::uint32_t   numVertices,
+            std::uint32_t   numIndices,
+            const void*     vertices    = nullptr,
+            const void*     indices     = nullptr
+        );
+
+        /**
+        \brief Releases the specified allocation. Its vertex and index ranges can be reused by subsequent allocations.
+        \remarks The GPU must not read from these ranges anymore, i.e. the command buffers that use this allocation must have been completed.
+        */
+        void Free(GeometryPoolHandle handle);
+
+        /**
+        \brief Returns the current vertex and index ranges of the specified allocation.
+        \return True if the handle is valid. Otherwise, \c outAllocation is reset to its default values and the return value is false.
+        */
+        bool GetAllocation(GeometryPoolHandle handle, GeometryPoolAllocation& outAllocation) const;
+
+        /**
+        \brief Fills the indirect draw arguments for the specified allocation.
+        \remarks The arguments are only valid until the next call to Defragment.
+        \return True if the handle is valid. Otherwise, \c outArgs is left unchanged and the return value is false.
+        */
+        bool GetDrawArguments(
+            GeometryPoolHandle              handle,
+            DrawIndexedIndirectArguments&   outArgs,
+            std::uint32_t                   numInstances    = 1,
+            std::uint32_t                   firstInstance   = 0
+        ) const;
+
+        /**
+        \brief Compacts all allocations into as few pages as possible and releases the pages that are no longer needed.
+        \remarks This creates new buffer pages, copies all live ranges into them with a single immediate command buffer,
+        and waits until the GPU has finished the copy before the old pages are released. Hence, this function blocks the calling thread
+        and temporarily requires additional memory for the copies. The GPU must not read from any page while this function is called,
+        and all ranges that have been queried before (e.g. with GetDrawArguments) must be queried again afterwards.
+        \return True if any allocation has been moved. Otherwise, the pool was already compact and nothing has been changed.
+        */
+        bool Defragment();
+
+        //! Returns the number of buffer pages that are currently held by this pool.
+        std::uint32_t GetNumPages() const;
+
+        //! Returns the vertex buffer of the specified page or null if the page index is out of bounds.
+        Buffer* GetVertexBuffer(std::uint32_t page) const;
+
+        //! Returns the index buffer of the specified page or null if the page index is out of bounds.
+        Buffer* GetIndexBuffer(std::uint32_t page) const;
+
+        //! Returns the total number of vertices of all live allocations.
+        std::uint64_t GetNumAllocatedVertices() const;
+
+        //! Returns the total number of indices of all live allocations.
+        std::uint64_t GetNumAllocatedIndices() const;
+
+    private:
+
+        struct Pimpl;
+        Pimpl* pimpl_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
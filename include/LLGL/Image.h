@@ -13,6 +13,7 @@
 #include <LLGL/Types.h>
 #include <LLGL/ImageFlags.h>
 #include <LLGL/SamplerFlags.h>
+#include <vector>
 
 
 namespace LLGL
@@ -77,6 +78,11 @@ class LLGL_EXPORT Image
 
         /**
         \brief Converts the image format and data type.
+        \remarks If the converted image fits into the current image buffer, e.g. for RGBA to BGRA, RGBA to RGB, or Float32 to Float16,
+        the image is converted in place without allocating a new image buffer. The image buffer keeps its capacity after such a conversion,
+        so converting the image back to a larger format afterwards can be done in place as well.
+        Otherwise, a new image buffer is allocated for the converted image.
+        \see ConvertImageBufferInPlace
         \see ConvertImageBuffer
         */
         void Convert(const ImageFormat format, const DataType dataType, unsigned threadCount = 0);
@@ -108,12 +114,47 @@ class LLGL_EXPORT Image
         /**
         \brief Resizes the image and resamples the pixels from the previous image buffer.
         \param[in] extent Specifies the new image size.
-        \param[in] filter Specifies the sampling filter.
-        \brief GenerateImageBuffer
-        \todo Not implemented yet.
+        \param[in] filter Specifies the sampling filter. SamplerFilter::Nearest and SamplerFilter::Linear
+        are equivalent to ImageFilter::Nearest and ImageFilter::Triangle respectively.
+        \see Resize(const Extent3D&, const ImageFilter, bool)
         */
         void Resize(const Extent3D& extent, const SamplerFilter filter);
 
+        /**
+        \brief Resizes the image and resamples the pixels from the previous image buffer with the specified filter.
+        \param[in] extent Specifies the new image size.
+        \param[in] filter Specifies the resampling filter.
+        \param[in] sRGB Specifies whether the color components are stored in sRGB space.
+        If true, they are filtered in linear space. The alpha component is never transformed. By default false.
+        \remarks The image is resampled in 32-bit floating-point precision on the threads of the job system.
+        \throw std::invalid_argument If the image has a compressed or depth-stencil format.
+        \see ImageFilter
+        \see JobSystem
+        */
+        void Resize(const Extent3D& extent, const ImageFilter filter, bool sRGB = false);
+
+        /**
+        \brief Generates a MIP-map chain of this image and returns all MIP-maps in one contiguous buffer.
+        \param[in] filter Specifies the resampling filter. By default ImageFilter::Box.
+        \param[in] sRGB Specifies whether the color components are stored in sRGB space.
+        If true, they are filtered in linear space. The alpha component is never transformed. By default false.
+        \param[in] numMipLevels Specifies the number of MIP-maps to generate, including this image as the first MIP-map.
+        If this is 0, the full MIP-map chain is generated. By default 0.
+        \param[out] outMipImageDescs Optional pointer to a container that receives one source image descriptor for each MIP-map. By default null.
+        These refer to the returned buffer and can be passed to RenderSystem::WriteTexture or RenderSystem::CreateTexture for each MIP-map.
+        \return The new allocated byte buffer with all MIP-maps in ascending order, tightly packed. Each MIP-map has half the extent of the previous one, but at least 1.
+        \remarks Each MIP-map is resampled from the previous one in 32-bit floating-point precision on the threads of the job system.
+        This image is not modified. The depth of this image is treated as the third dimension of a 3D texture, i.e. it is halved for each MIP-map as well.
+        \throw std::invalid_argument If the image has a compressed or depth-stencil format.
+        \see NumMipLevels
+        */
+        ByteBuffer GenerateMips(
+            const ImageFilter                   filter              = ImageFilter::Box,
+            bool                                sRGB                = false,
+            std::uint32_t                       numMipLevels        = 0,
+            std::vector<SrcImageDescriptor>*    outMipImageDescs    = nullptr
+        ) const;
+
         //! Swaps all attributes with the specified image.
         void Swap(Image& rhs);
 
@@ -296,6 +337,7 @@ class LLGL_EXPORT Image
         ImageFormat format_     = ImageFormat::RGBA;
         DataType    dataType_   = DataType::UInt8;
         ByteBuffer  data_;
+        std::size_t capacity_   = 0;    // Size of the image buffer if it is larger than GetDataSize(), e.g. after an in-place conversion to a smaller format.
 
 };
 
@@ -35,6 +35,35 @@ Therefore, the byte buffer type is an std::unique_ptr<char[]>.
 using ByteBuffer = std::unique_ptr<char[]>;
 
 
+/* ----- Enumerations ----- */
+
+/**
+\brief Image resampling filter enumeration.
+\remarks The filters are separable, i.e. they are applied along each dimension of an image individually.
+When an image is reduced, each filter is widened by the reduction factor, so all source pixels contribute to the result.
+Pixels outside the image boundary are clamped to the edge.
+\see Image::Resize(const Extent3D&, const ImageFilter, bool)
+\see Image::GenerateMips
+*/
+enum class ImageFilter
+{
+    //! Take the nearest source pixel. This is the fastest filter, but produces aliasing when an image is reduced.
+    Nearest,
+
+    //! Box filter with a radius of half a pixel. When an image is halved, this averages each block of 2x2 pixels.
+    Box,
+
+    //! Triangle (tent) filter with a radius of one pixel. When an image is enlarged, this is equivalent to linear interpolation.
+    Triangle,
+
+    //! Kaiser-windowed sinc filter with a radius of three pixels. This is a good trade-off between sharpness and ringing for MIP-maps.
+    Kaiser,
+
+    //! Lanczos filter with a radius of three pixels. This produces the sharpest results, but can cause ringing at hard edges.
+    Lanczos,
+};
+
+
 /* ----- Structures ----- */
 
 /**
@@ -52,25 +81,46 @@ struct SrcImageDescriptor
     SrcImageDescriptor(const SrcImageDescriptor&) = default;
 
     //! Constructor to initialize all attributes.
-    inline SrcImageDescriptor(ImageFormat format, DataType dataType, const void* data, std::size_t dataSize) :
-        format   { format   },
-        dataType { dataType },
-        data     { data     },
-        dataSize { dataSize }
+    inline SrcImageDescriptor(ImageFormat format, DataType dataType, const void* data, std::size_t dataSize, std::uint32_t rowStride = 0, std::uint32_t layerStride = 0) :
+        format      { format      },
+        dataType    { dataType    },
+        data        { data        },
+        dataSize    { dataSize    },
+        rowStride   { rowStride   },
+        layerStride { layerStride }
     {
     }
 
     //! Specifies the image format. By default ImageFormat::RGBA.
-    ImageFormat format      = ImageFormat::RGBA;
+    ImageFormat     format      = ImageFormat::RGBA;
 
     //! Specifies the image data type. This must be DataType::UInt8 for compressed images. By default DataType::UInt8.
-    DataType    dataType    = DataType::UInt8;
+    DataType        dataType    = DataType::UInt8;
 
     //! Pointer to the read-only image data.
-    const void* data        = nullptr;
+    const void*     data        = nullptr;
 
     //! Specifies the size (in bytes) of the image data. This is primarily used for compressed images and serves for robustness.
-    std::size_t dataSize    = 0;
+    std::size_t     dataSize    = 0;
+
+    /**
+    \brief Specifies an optional stride (in bytes) per row in the image data. By default 0.
+    \remarks If this is 0, the rows are considered to be tightly packed.
+    Otherwise, this \b must be greater than or equal to the size (in bytes) of each row in the texture region, for instance to upload a sub-rectangle of a larger texture atlas without repacking it first.
+    For compressed formats, a row refers to a row of blocks.
+    \note With OpenGL, the row stride must be a multiple of the pixel size and strides are not supported for compressed formats.
+    \see CommandBuffer::CopyTextureFromBuffer
+    */
+    std::uint32_t   rowStride   = 0;
+
+    /**
+    \brief Specifies an optional stride (in bytes) per depth slice or array layer in the image data. By default 0.
+    \remarks If this is 0, the layers are considered to be tightly packed with respect to \c rowStride.
+    Otherwise, this \b must be a multiple of \c rowStride. If \c rowStride is 0, this must also be 0.
+    \remarks The value of \c dataSize must cover all strided rows and layers, except for the padding after the last row.
+    \note Row and layer strides are only used by RenderSystem::WriteTexture and are ignored by the image conversion functions such as ConvertImageBuffer.
+    */
+    std::uint32_t   layerStride = 0;
 };
 
 /**
@@ -86,25 +136,43 @@ struct DstImageDescriptor
     DstImageDescriptor(const DstImageDescriptor&) = default;
 
     //! Constructor to initialize all attributes.
-    inline DstImageDescriptor(ImageFormat format, DataType dataType, void* data, std::size_t dataSize) :
-        format   { format   },
-        dataType { dataType },
-        data     { data     },
-        dataSize { dataSize }
+    inline DstImageDescriptor(ImageFormat format, DataType dataType, void* data, std::size_t dataSize, std::uint32_t rowStride = 0, std::uint32_t layerStride = 0) :
+        format      { format      },
+        dataType    { dataType    },
+        data        { data        },
+        dataSize    { dataSize    },
+        rowStride   { rowStride   },
+        layerStride { layerStride }
     {
     }
 
     //! Specifies the image format. By default ImageFormat::RGBA.
-    ImageFormat format      = ImageFormat::RGBA;
+    ImageFormat     format      = ImageFormat::RGBA;
 
     //! Specifies the image data type. This must be DataType::UInt8 for compressed images. By default DataType::UInt8.
-    DataType    dataType    = DataType::UInt8;
+    DataType        dataType    = DataType::UInt8;
 
     //! Pointer to the read/write image data.
-    void*       data        = nullptr;
+    void*           data        = nullptr;
 
     //! Specifies the size (in bytes) of the image data. This is primarily used for compressed images and serves for robustness.
-    std::size_t dataSize    = 0;
+    std::size_t     dataSize    = 0;
+
+    /**
+    \brief Specifies an optional stride (in bytes) per row in the image data. By default 0.
+    \remarks If this is 0, the rows are considered to be tightly packed.
+    Otherwise, this \b must be greater than or equal to the size (in bytes) of each row in the texture region,
+    for instance to read a texture region directly into a sub-rectangle of a larger CPU image. The padding between rows is not modified.
+    \see SrcImageDescriptor::rowStride
+    */
+    std::uint32_t   rowStride   = 0;
+
+    /**
+    \brief Specifies an optional stride (in bytes) per depth slice or array layer in the image data. By default 0.
+    \note Row and layer strides are only used by RenderSystem::ReadTexture and are ignored by the image conversion functions such as ConvertImageBuffer.
+    \see SrcImageDescriptor::layerStride
+    */
+    std::uint32_t   layerStride = 0;
 };
 
 
@@ -168,6 +236,94 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
     unsigned                    threadCount = 0
 );
 
+/**
+\brief Converts the image format and data type of the specified image buffer in place, i.e. without allocating a second image buffer.
+\param[in,out] imageDesc Specifies the descriptor of the image buffer that is to be converted.
+Its \c dataSize member specifies the size (in bytes) of the source image data at the beginning of the buffer.
+\param[in] bufferCapacity Specifies the size (in bytes) of the entire image buffer. This must be greater than or equal to the size of both the source and the converted image data.
+\param[in] dstFormat Specifies the destination image format.
+\param[in] dstDataType Specifies the destination image data type.
+\param[in] threadCount Specifies the number of threads to use for conversion.
+If this is less than 2, no multi-threading is used. If this is 'Constants::maxThreadCount',
+the maximal count of threads the system supports will be used (e.g. 4 on a quad-core processor). By default 0.
+\return True if any conversion was necessary. Otherwise, no conversion was necessary and the image buffer is not modified!
+\remarks If the converted pixels are not larger than the source pixels (e.g. RGBA to BGRA, RGBA to RGB, or Float32 to Float16), the buffer is converted from front to back.
+Otherwise, it is converted from back to front, which requires the buffer capacity to fit the converted image data.
+In both cases, the pixels are converted in blocks through a small scratch buffer per thread,
+and the blocks that cannot overlap each other are converted in parallel.
+\note Compressed images and depth-stencil images cannot be converted.
+\throw std::invalid_argument If a compressed image format is specified either as source or destination.
+\throw std::invalid_argument If a depth-stencil format is specified either as source or destination.
+\throw std::invalid_argument If the source data size is not a multiple of the source data type size times the image format size.
+\throw std::invalid_argument If the image buffer is a null pointer.
+\throw std::invalid_argument If the buffer capacity is smaller than the source or converted image data.
+\see ConvertImageBuffer
+\see Image::Convert
+*/
+LLGL_EXPORT bool ConvertImageBufferInPlace(
+    const DstImageDescriptor&   imageDesc,
+    std::size_t                 bufferCapacity,
+    ImageFormat                 dstFormat,
+    DataType                    dstDataType,
+    unsigned                    threadCount = 0
+);
+
+/**
+\brief Decompresses the block-compressed source image and returns the new generated image buffer.
+\param[in] srcImageDesc Specifies the source image descriptor. Its format must be one of the block compression formats ImageFormat::BC1 to ImageFormat::BC5.
+For the signed formats Format::BC4SNorm and Format::BC5SNorm, the data type must be DataType::Int8. Otherwise, it must be DataType::UInt8.
+\param[in] extent Specifies the extent (in texels) of the source image. Each slice along the depth is a separately compressed 2D image.
+\param[in] threadCount Specifies the number of threads to use for decompression.
+If this is less than 2, no multi-threading is used. If this is 'Constants::maxThreadCount',
+the maximal count of threads the system supports will be used (e.g. 4 on a quad-core processor). By default 0.
+\return Byte buffer with the decompressed image data in the same data type as the source image,
+and in the image format ImageFormat::RGBA for BC1 to BC3, ImageFormat::R for BC4, and ImageFormat::RG for BC5.
+\remarks This can be used as fallback when a block compression format is not supported by the hardware.
+Color components are not converted between sRGB and linear color space.
+\throw std::invalid_argument If the source image format is not a block compression format.
+\throw std::invalid_argument If the source buffer is a null pointer.
+\throw std::invalid_argument If the source buffer size is smaller than required for the image extent.
+\see Constants::maxThreadCount
+\see IsCompressedFormat(const ImageFormat)
+*/
+LLGL_EXPORT ByteBuffer DecompressImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             extent,
+    unsigned                    threadCount = 0
+);
+
+/**
+\brief Compresses the uncompressed source image into a block compression format and returns the new generated image buffer.
+\param[in] srcImageDesc Specifies the source image descriptor. Its format must neither be compressed nor a depth-stencil format.
+If the source image is not in the image format and data type that is decompressed from the destination format (see DecompressImageBuffer),
+it is converted into that format first (see ConvertImageBuffer).
+\param[in] extent Specifies the extent (in texels) of the source image. Each slice along the depth is compressed into a separate 2D image.
+\param[in] dstFormat Specifies the destination image format. This must be one of the block compression formats ImageFormat::BC1 to ImageFormat::BC5.
+\param[in] dstDataType Specifies the destination data type. For the signed formats Format::BC4SNorm and Format::BC5SNorm, this must be DataType::Int8. Otherwise, it must be DataType::UInt8.
+\param[in] threadCount Specifies the number of threads to use for compression.
+If this is less than 2, no multi-threading is used. If this is 'Constants::maxThreadCount',
+the maximal count of threads the system supports will be used (e.g. 4 on a quad-core processor). By default 0.
+\return Byte buffer with the compressed image data, which can be passed to RenderSystem::CreateTexture or RenderSystem::WriteTexture.
+\remarks This is intended for textures that are generated at runtime, such as lightmaps or splat maps, and favors encoding speed over quality:
+Color endpoints are fitted along the principal axis of each block and refined with least squares, and single components use the 8-value mode of their minimum and maximum.
+BC1 images encode texels with an alpha component less than 128 as transparent black.
+Blocks at the right and bottom edges that exceed the image extent are padded by repeating the texels at the edges.
+Color components are not converted between sRGB and linear color space.
+\throw std::invalid_argument If the destination image format is not a block compression format or the destination data type is invalid for it.
+\throw std::invalid_argument If the source image format is compressed or a depth-stencil format.
+\throw std::invalid_argument If the source buffer is a null pointer.
+\throw std::invalid_argument If the source buffer size is smaller than required for the image extent.
+\see DecompressImageBuffer
+\see Constants::maxThreadCount
+*/
+LLGL_EXPORT ByteBuffer CompressImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             extent,
+    ImageFormat                 dstFormat,
+    DataType                    dstDataType,
+    unsigned                    threadCount = 0
+);
+
 /**
 \brief Copies an image buffer region from the source buffer to the destination buffer.
 \param[out] dstImageDesc Specifies the destination image descriptor.
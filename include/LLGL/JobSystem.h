@@ -0,0 +1,113 @@
+/*
+ * JobSystem.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_JOB_SYSTEM_H
+#define LLGL_JOB_SYSTEM_H
+
+
+#include <LLGL/Export.h>
+#include <functional>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+/**
+\brief Namespace with functions to configure the job system that LLGL uses for its CPU-side parallel work.
+\remarks By default, LLGL uses a built-in pool of persistent worker threads with work-stealing queues,
+which is shared by all parallel operations of LLGL, such as ConvertImageBuffer, CopyImageBufferRegion, and Image::Resize.
+The threads of this pool are only created when parallel work is scheduled for the first time.
+Host applications that already have their own job system can inject it with SetScheduler.
+*/
+namespace JobSystem
+{
+
+
+/* ----- Types ----- */
+
+/**
+\brief Scheduler function signature for host applications that run the parallel work of LLGL on their own threads.
+\param[in] numJobs Specifies the number of independent jobs. This is always greater than 1.
+\param[in] job Specifies the function that must be invoked once for each job index in the half-open range <code>[0, numJobs)</code>.
+This function can be invoked concurrently from any thread, including the calling thread.
+\remarks The scheduler must not return before all jobs have finished.
+\see SetScheduler
+*/
+using Scheduler = std::function<void(std::size_t numJobs, const std::function<void(std::size_t jobIndex)>& job)>;
+
+/**
+\brief Task function signature for a range of work items.
+\param[in] begin Specifies the first work item of this range.
+\param[in] end Specifies the end of this range, i.e. the last work item plus one.
+\see ParallelFor
+*/
+using RangeTask = std::function<void(std::size_t begin, std::size_t end)>;
+
+/**
+\brief Task function signature for a single asynchronous task.
+\see Async
+*/
+using AsyncTask = std::function<void()>;
+
+
+/* ----- Functions ----- */
+
+/**
+\brief Sets the scheduler that runs the parallel work of LLGL.
+\param[in] scheduler Specifies the new scheduler. If this is null, the built-in thread pool is used. By default null.
+\remarks This must not be called while LLGL is executing parallel work on another thread.
+\see Scheduler
+*/
+LLGL_EXPORT void SetScheduler(const Scheduler& scheduler);
+
+/**
+\brief Sets the number of worker threads of the built-in thread pool.
+\param[in] threadCount Specifies the number of worker threads. The calling thread of each parallel operation participates in its work as well.
+If this is 0, the number of hardware threads minus one is used. By default 0.
+\remarks If the thread pool has already been created, it is destroyed and re-created with the new number of threads on its next use.
+This must not be called while LLGL is executing parallel work on another thread.
+*/
+LLGL_EXPORT void SetThreadCount(unsigned threadCount);
+
+/**
+\brief Returns the number of threads that can work on a single parallel operation, i.e. the number of worker threads of the built-in thread pool plus the calling thread.
+\remarks If a custom scheduler is set, this is still the number of threads the built-in thread pool would use.
+*/
+LLGL_EXPORT unsigned GetThreadCount();
+
+/**
+\brief Runs the specified task over the half-open range <code>[0, count)</code>, split into ranges of at least \c grainSize work items.
+\param[in] count Specifies the number of work items.
+\param[in] grainSize Specifies the minimal number of work items per range. If this is 0, it is treated as 1.
+\param[in] maxThreads Specifies the maximal number of ranges the work items are split into.
+If this is less than 2, the task is invoked once on the calling thread. If this is Constants::maxThreadCount, the number of threads of the job system is used.
+\param[in] task Specifies the task that is invoked for each range. This can be invoked concurrently from multiple threads.
+\remarks This function returns when all ranges have been processed.
+*/
+LLGL_EXPORT void ParallelFor(std::size_t count, std::size_t grainSize, unsigned maxThreads, const RangeTask& task);
+
+/**
+\brief Schedules the specified task on the built-in thread pool and returns immediately.
+\param[in] task Specifies the task that is invoked once on any worker thread. This must not throw any exceptions.
+\remarks If the built-in thread pool has no worker threads (see SetThreadCount), the task is invoked on the calling thread before this function returns.
+\remarks Asynchronous tasks are never passed to a custom scheduler, since a scheduler must not return before its jobs have finished (see SetScheduler).
+\remarks All pending asynchronous tasks are finished before the thread pool is destroyed.
+*/
+LLGL_EXPORT void Async(const AsyncTask& task);
+
+
+} // /namespace JobSystem
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -15,11 +15,21 @@
 #include <LLGL/Display.h>
 #include <LLGL/Input.h>
 #include <LLGL/Timer.h>
+#include <LLGL/FramePacer.h>
 #include <LLGL/TypeInfo.h>
 #include <LLGL/ColorRGB.h>
 #include <LLGL/ColorRGBA.h>
 #include <LLGL/RenderSystem.h>
+#include <LLGL/PipelineCache.h>
+#include <LLGL/RenderGraph.h>
+#include <LLGL/RenderTargetPool.h>
+#include <LLGL/TransientBufferAllocator.h>
+#include <LLGL/TextureBrickStreamer.h>
+#include <LLGL/TextureCompression.h>
+#include <LLGL/CaptureReplay.h>
 #include <LLGL/Log.h>
+#include <LLGL/JobSystem.h>
+#include <LLGL/Allocator.h>
 #include <LLGL/IndirectArguments.h>
 #include <LLGL/ImageFlags.h>
 
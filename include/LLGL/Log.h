@@ -13,6 +13,7 @@
 #include <LLGL/Container/StringView.h>
 #include <functional>
 #include <ostream>
+#include <cstddef>
 
 
 namespace LLGL
@@ -69,6 +70,26 @@ enum class ReportType
 */
 using ReportCallback = std::function<void(ReportType type, const StringView& message, const StringView& contextInfo, void* userData)>;
 
+/**
+\brief Report statistics.
+\remarks All counters are monotonic since the start of the application.
+\see GetReportStatistics
+*/
+struct ReportStatistics
+{
+    //! Number of reports that have been posted so far, including the ones that have been ignored.
+    std::size_t numPosted       = 0;
+
+    //! Number of reports that have been passed to the report callback.
+    std::size_t numDelivered    = 0;
+
+    //! Number of reports that have been ignored because the report limit was exceeded or the asynchronous report queue was full.
+    std::size_t numDropped      = 0;
+
+    //! Number of reports that have been suppressed because an identical report was already delivered.
+    std::size_t numDuplicates   = 0;
+};
+
 
 /* ----- Functions ----- */
 
@@ -103,6 +124,40 @@ LLGL_EXPORT void SetReportCallbackStd(std::ostream* stream);
 */
 LLGL_EXPORT void SetReportLimit(std::size_t maxCount);
 
+/**
+\brief Enables or disables the deduplication of reports.
+\param[in] enable Specifies whether identical reports, i.e. with the same type, message, and context information, are only delivered once. By default false.
+\remarks The number of suppressed reports is counted in ReportStatistics::numDuplicates.
+\see GetReportStatistics
+*/
+LLGL_EXPORT void SetReportDeduplication(bool enable);
+
+/**
+\brief Enables or disables asynchronous delivery of reports.
+\param[in] queueSize Specifies the maximum number of reports that can be queued up. This is rounded up to the next power of two.
+If this is 0, asynchronous delivery is disabled and reports are passed to the report callback on the thread that posts them. By default 0.
+\param[in] backgroundThread Specifies whether a background thread delivers the queued reports. Otherwise, the reports are only delivered by FlushReports.
+\remarks In asynchronous mode, PostReport only copies the report into a lock-free queue and never blocks.
+Reports that are posted while the queue is full are dropped and counted in ReportStatistics::numDropped.
+This is useful if many reports are generated from several threads simultaneously, e.g. by the debug layer during multi-threaded command recording.
+\remarks This function must not be called while other threads post reports. All pending reports are delivered before the mode is changed.
+\see FlushReports
+*/
+LLGL_EXPORT void SetReportAsync(std::size_t queueSize, bool backgroundThread = true);
+
+/**
+\brief Delivers all reports that are currently queued up to the report callback.
+\remarks This has no effect if asynchronous delivery is disabled.
+\see SetReportAsync
+*/
+LLGL_EXPORT void FlushReports();
+
+/**
+\brief Returns the current report statistics.
+\see ReportStatistics
+*/
+LLGL_EXPORT ReportStatistics GetReportStatistics();
+
 
 } // /namespace Log
 
@@ -162,6 +162,8 @@ LLGL_EXPORT PipelineLayoutDescriptor PipelineLayoutDesc(const ShaderReflection&
     - <code>geom</code> for the geometry shader stage (i.e. StageFlags::GeometryStage).
     - <code>frag</code> for the fragment shader stage (i.e. StageFlags::FragmentStage).
     - <code>comp</code> for the compute shader stage (i.e. StageFlags::ComputeStage).
+    - <code>task</code> for the task shader stage (i.e. StageFlags::TaskStage).
+    - <code>mesh</code> for the mesh shader stage (i.e. StageFlags::MeshStage).
 - If no stage flag is specified, all shader stages will be used.
 - Whitespaces are ignored (e.g. blanks <code>' '</code>, tabulators <code>'\\t'</code>, new-line characters <code>'\\n'</code> and <code>'\\r'</code> etc.), see C++ STL function <code>std::isspace</code>.
 \remarks Here is a usage example:
@@ -12,8 +12,10 @@
 #include <LLGL/Export.h>
 #include <LLGL/Constants.h>
 #include <LLGL/VertexAttribute.h>
+#include <LLGL/Container/ArrayView.h>
 #include <vector>
 #include <cstdint>
+#include <cstddef>
 #include <algorithm>
 
 
@@ -130,6 +132,94 @@ struct VertexFormat
 };
 
 
+/* ----- Enumerations ----- */
+
+/**
+rief Vertex attribute packing enumeration for 32-bit floating-point source attributes.
+emarks The packed encodings reduce the vertex size, and with it the vertex fetch bandwidth, at the cost of precision.
+Values are rounded to the nearest representable value and clamped to the range of the packed format.
+\see PackVertexFormat
+\see PackVertices
+*/
+enum class VertexPacking
+{
+    //! Keeps the attribute in its original format.
+    None,
+
+    /**
+    rief Packs a unit vector (e.g. a normal or tangent) with 3 or 4 components into Format::RGB10A2UNorm.
+    emarks Each component is remapped from [-1, 1] to [0, 1], i.e. the vertex shader must decode the vector with <code>v * 2 - 1</code>.
+    The fourth component (e.g. the handedness of a tangent) is quantized to 2 bits and defaults to 1.
+    */
+    NormalRGB10A2UNorm,
+
+    /**
+    rief Packs a unit vector with 3 components into Format::RG16SNorm with an octahedral encoding.
+    emarks The vertex shader must decode the vector as follows (GLSL):
+    \code
+    vec3 DecodeOctahedral(vec2 e)
+    {
+        vec3 v = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+        float t = max(-v.z, 0.0);
+        v.xy += vec2(v.x >= 0.0 ? -t : t, v.y >= 0.0 ? -t : t);
+        return normalize(v);
+    }
+    \endcode
+    */
+    NormalOctahedralRG16SNorm,
+
+    /**
+    rief Packs each component into a 16-bit float, e.g. texture coordinates into Format::RG16Float.
+    emarks Attributes with 1, 2, or 4 components are packed into Format::R16Float, Format::RG16Float, and Format::RGBA16Float respectively.
+    Attributes with 3 components are packed into Format::RGBA16Float with a fourth component of 1, since 48-bit vertex formats are not widely supported.
+    */
+    HalfFloat,
+
+    /**
+    rief Packs a color with 3 or 4 components in the range [0, 1] into Format::RGBA8UNorm.
+    emarks The alpha component defaults to 1.
+    */
+    ColorRGBA8UNorm,
+};
+
+
+/* ----- Functions ----- */
+
+/**
+rief Returns a copy of the specified vertex format with the specified packing applied to each attribute.
+\param[in] srcFormat Specifies the source vertex format.
+\param[in] packings Specifies the packing for each attribute of \c srcFormat in the same order.
+Attributes without an entry in this array, attributes whose format is not a 32-bit floating-point format,
+and attributes whose number of components is not supported by the respective packing keep their original format.
+eturn New vertex format with the packed attribute formats. The offsets and strides are recomputed for each buffer binding slot,
+while the names, locations, slots, and instance divisors are preserved.
+\see PackVertices
+*/
+LLGL_EXPORT VertexFormat PackVertexFormat(const VertexFormat& srcFormat, const ArrayView<VertexPacking>& packings);
+
+/**
+rief Converts the vertices of the specified buffer binding slot from the source vertex format into a packed vertex format.
+\param[in] srcFormat Specifies the vertex format of the source vertices.
+\param[in] srcVertices Pointer to the source vertices of the buffer binding slot \c slot.
+\param[in] dstFormat Specifies the packed vertex format of the destination vertices. This must have been generated by PackVertexFormat from \c srcFormat.
+\param[out] dstVertices Pointer to the destination vertices. This must point to <code>dstFormat.GetStride(slot) * numVertices</code> bytes.
+\param[in] numVertices Specifies the number of vertices to convert.
+\param[in] slot Specifies the buffer binding slot whose attributes are to be converted. By default 0.
+eturn True if all attributes could be converted. Otherwise, the formats do not match and the content of \c dstVertices is undefined.
+emarks Each attribute is converted for all vertices at once, using SSE2 on x86-64 and NEON on ARM64 where available.
+Attributes whose format has not changed are copied as is.
+\see PackVertexFormat
+*/
+LLGL_EXPORT bool PackVertices(
+    const VertexFormat& srcFormat,
+    const void*         srcVertices,
+    const VertexFormat& dstFormat,
+    void*               dstVertices,
+    std::size_t         numVertices,
+    std::uint32_t       slot        = 0
+);
+
+
 } // /namespace LLGL
 
 
@@ -0,0 +1,166 @@
+/*
+ * PipelineCache.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_PIPELINE_CACHE_H
+#define LLGL_PIPELINE_CACHE_H
+
+
+#include <LLGL/NonCopyable.h>
+#include <LLGL/Blob.h>
+#include <LLGL/PipelineStateFlags.h>
+#include <LLGL/PipelineLayoutFlags.h>
+#include <LLGL/RenderPassFlags.h>
+#include <LLGL/ShaderFlags.h>
+#include <cstdint>
+#include <memory>
+
+
+namespace LLGL
+{
+
+
+class RenderSystem;
+class PipelineState;
+class PipelineLayout;
+class RenderPass;
+class Shader;
+
+/* ----- Flags ----- */
+
+/**
+\brief Pipeline cache save flags enumeration.
+\see PipelineCache::Save
+*/
+struct PipelineCacheSaveFlags
+{
+    enum
+    {
+        /**
+        \brief Compresses the cache data of each PSO and the device-wide cache individually.
+        \remarks The compression is optimized for decoding speed, so loading a compressed archive takes hardly longer than an uncompressed one.
+        Cache data that does not become smaller is stored uncompressed.
+        */
+        Compressed = (1 << 0),
+    };
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Archive of serialized pipeline state caches for many PSOs, which can be saved and loaded in a single call.
+\remarks Each PSO is identified by a stable 64-bit hash of its descriptor, which includes the descriptors of its shaders, pipeline layout, and render pass.
+Since these objects cannot be hashed from their interfaces, each of them must be registered with its descriptor before it is used for a PSO from this cache.
+PSOs whose shaders, pipeline layout, or render pass have not been registered are created without the cache.
+The archive consists of a header and an index of all PSO hashes, so each PSO is found in constant time after the archive has been loaded.
+\remarks All cache data in the archive is checksummed. Cache data is only verified (and decompressed) when it is used for the first time,
+so loading an archive does not read the cache data of PSOs that are not created. Corrupted cache data is ignored and the respective PSO is created without cache.
+\remarks How the cached data is used depends on the backend:
+- For Vulkan and Metal, the archive stores the device-wide pipeline cache (i.e. \c VkPipelineCache or \c MTLBinaryArchive), which is merged once into the device.
+- For OpenGL, the archive stores one program binary for each PSO.
+- For Direct3D 12, the archive stores one cached PSO blob for each PSO. If RendererConfigurationD3D12::pipelineLibraryEnabled is true, use the pipeline library instead.
+- For all other backends, PSOs are created without cached data, but the archive remains valid.
+\remarks Here is an example how to use a pipeline cache:
+\code
+LLGL::PipelineCache myPipelineCache{ *myRenderer };
+
+// Load cache from previous application run; this fails if the archive was created with a different renderer or driver
+if (auto myArchive = LLGL::Blob::CreateFromFileMapping("MyPipelineCache.bin"))
+    myPipelineCache.Load(std::move(myArchive));
+
+// Register objects that are used for PSOs
+myPipelineCache.RegisterShader(*myVertexShader, myVertexShaderDesc);
+myPipelineCache.RegisterShader(*myFragmentShader, myFragmentShaderDesc);
+myPipelineCache.RegisterPipelineLayout(*myPipelineLayout, myPipelineLayoutDesc);
+
+// Create PSOs from cache
+auto myPipelineState = myPipelineCache.CreatePipelineState(myPipelineDesc);
+
+// Store cache for next application run
+auto myArchive = myPipelineCache.Save(LLGL::PipelineCacheSaveFlags::Compressed);
+\endcode
+\note This class is not thread-safe.
+\see RenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor&, std::unique_ptr<Blob>*)
+*/
+class LLGL_EXPORT PipelineCache : public NonCopyable
+{
+
+    public:
+
+        /**
+        \brief Initializes an empty pipeline cache for the specified render system.
+        \remarks The render system must outlive this pipeline cache. PSOs that are created with this cache are owned by the render system.
+        */
+        PipelineCache(RenderSystem& renderSystem);
+
+        ~PipelineCache();
+
+        /**
+        \brief Loads the specified archive and replaces all previous content of this cache.
+        \param[in] archive Specifies the archive that was created with Save. The cache takes ownership of this Blob and refers to its data without copying it,
+        so it can be a memory-mapped file (see Blob::CreateFromFileMapping).
+        \return True if the archive has been loaded successfully. Otherwise, the archive is invalid or was created with a different renderer or driver, and the cache is empty.
+        */
+        bool Load(std::unique_ptr<Blob>&& archive);
+
+        /**
+        \brief Returns a new Blob with the archive of all cached PSOs.
+        \param[in] flags Specifies optional flags for the archive. This can be a bitwise OR combination of the PipelineCacheSaveFlags entries. By default 0.
+        \remarks This archive can be stored to file and passed to Load on the next application run.
+        \see PipelineCacheSaveFlags
+        */
+        std::unique_ptr<Blob> Save(long flags = 0) const;
+
+        //! Removes all cached PSOs and registered objects.
+        void Clear();
+
+        //! Registers the specified shader with the descriptor it was created with, so PSOs that use this shader can be cached.
+        void RegisterShader(const Shader& shader, const ShaderDescriptor& shaderDesc);
+
+        //! Registers the specified pipeline layout with the descriptor it was created with, so PSOs that use this pipeline layout can be cached.
+        void RegisterPipelineLayout(const PipelineLayout& pipelineLayout, const PipelineLayoutDescriptor& pipelineLayoutDesc);
+
+        //! Registers the specified render pass with the descriptor it was created with, so PSOs that use this render pass can be cached.
+        void RegisterRenderPass(const RenderPass& renderPass, const RenderPassDescriptor& renderPassDesc);
+
+        /**
+        \brief Unregisters the specified shader, pipeline layout, or render pass.
+        \remarks This should be called before such an object is released, since another object can be allocated at the same address afterwards.
+        */
+        void Unregister(const void* object);
+
+        /**
+        \brief Creates a new graphics PSO with the cached data of this archive and stores the new cache data for that PSO.
+        \see RenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor&, std::unique_ptr<Blob>*)
+        */
+        PipelineState* CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc);
+
+        /**
+        \brief Creates a new compute PSO with the cached data of this archive and stores the new cache data for that PSO.
+        \see RenderSystem::CreatePipelineState(const ComputePipelineDescriptor&, std::unique_ptr<Blob>*)
+        */
+        PipelineState* CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc);
+
+        //! Returns the number of PSOs in this cache.
+        std::size_t GetNumEntries() const;
+
+    private:
+
+        struct Pimpl;
+        Pimpl* pimpl_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
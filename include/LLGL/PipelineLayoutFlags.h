@@ -20,6 +20,77 @@ namespace LLGL
 {
 
 
+/* ----- Flags ----- */
+
+/**
+\brief Binding descriptor flags enumeration.
+\see BindingDescriptor::flags
+*/
+struct BindingFlags
+{
+    enum
+    {
+        /**
+        \brief Specifies that the buffer of this binding is set directly with CommandBuffer::SetResource instead of a resource heap.
+        \remarks This can only be used for Buffer resources. Such a binding is not part of the resource heaps that are created with this pipeline layout,
+        i.e. ResourceHeapDescriptor::resourceViews must not contain any entries for it.
+        For Direct3D 12, this binding is mapped to a root descriptor (CBV, SRV, or UAV), so no descriptors need to be copied when the buffer changes between draw calls.
+        \note Only supported with: Direct3D 12.
+        \see CommandBuffer::SetResource
+        */
+        DynamicBinding  = (1 << 0),
+
+        /**
+        \brief Specifies that the constant buffer of this binding is replaced by inline uniforms that are set with CommandBuffer::SetUniforms.
+        \remarks This can only be used for Buffer resources with the BindFlags::ConstantBuffer flag. The member BindingDescriptor::arraySize specifies the number of 32-bit values.
+        The uniform location of the first value of an inline binding is the sum of 32-bit values of all previous inline bindings in the pipeline layout.
+        Such a binding is not part of the resource heaps that are created with this pipeline layout.
+        For Direct3D 12, this binding is mapped to a contiguous block of 32-bit root constants.
+        For Vulkan, this binding is mapped to a push constant range with offset <code>4 * location</code>, i.e. all inline bindings share the single \c push_constant block of the shaders.
+        The total size of all inline bindings must not exceed the \c maxPushConstantsSize limit of the device, which is at least 128 bytes.
+        For OpenGL, this binding is mapped to the uniform block with the name BindingDescriptor::name.
+        All values of that block are streamed into an internal uniform ring buffer whenever they are set, and that range is bound with a single \c glBindBufferRange call.
+        \note Only supported with: OpenGL, Vulkan, Direct3D 12.
+        \see CommandBuffer::SetUniforms
+        */
+        InlineUniforms  = (1 << 1),
+
+        /**
+        \brief Specifies that the buffer view of this binding is moved by a dynamic offset whenever its resource heap is bound.
+        \remarks This can only be used for a single Buffer resource, i.e. BindingDescriptor::arraySize must be 1.
+        Such a binding is part of the resource heaps that are created with this pipeline layout, but its offset is specified with the \c dynamicOffsets parameter of CommandBuffer::SetResourceHeap.
+        This allows thousands of objects to share a single resource heap and a single large constant buffer,
+        where the buffer view of the resource heap specifies the size of the constant data of a single object (see BufferViewDescriptor::size).
+        The dynamic offsets are ordered by the binding slots of all bindings with this flag, i.e. in ascending order of BindingDescriptor::slot.
+        For Vulkan, this binding is mapped to a descriptor of type \c VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC or \c VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC.
+        For Direct3D 12, this binding is mapped to a root descriptor (CBV, SRV, or UAV) instead of a range in the descriptor tables of the resource heap.
+        \note Only supported with: Vulkan, Direct3D 12.
+        \see CommandBuffer::SetResourceHeap(ResourceHeap&, std::uint32_t, std::uint32_t, const std::uint32_t*, const PipelineBindPoint)
+        \see RenderingLimits::minConstantBufferAlignment
+        */
+        DynamicOffset   = (1 << 2),
+
+        /**
+        \brief Specifies that this binding is an unbounded array of descriptors that shaders address by index, i.e. a bindless binding.
+        \remarks This can only be used for the last entry in PipelineLayoutDescriptor::bindings and only once per pipeline layout.
+        The member BindingDescriptor::arraySize specifies the maximum number of descriptors of this binding.
+        A resource heap that is created with such a pipeline layout has a single descriptor set:
+        it contains one descriptor for each of the other bindings, followed by a variable number of descriptors for this binding.
+        That number is ResourceHeapDescriptor::numResourceViews minus the number of other bindings, or BindingDescriptor::arraySize if no resource views are specified.
+        Descriptors of this binding can be updated with RenderSystem::WriteResourceHeap while the resource heap is in use by a command buffer,
+        as long as the updated descriptors are not accessed by any command buffer that is currently executed. Unused descriptors can be left unwritten.
+        This allows a renderer to bind a single resource heap per frame for all materials instead of one resource heap per material.
+        For Vulkan, this binding is mapped to a descriptor with the flags \c UPDATE_AFTER_BIND, \c PARTIALLY_BOUND, and \c VARIABLE_DESCRIPTOR_COUNT of the \c VK_EXT_descriptor_indexing extension.
+        For Direct3D 12, this binding is mapped to its own descriptor table with an unbounded descriptor range.
+        This flag cannot be combined with DynamicBinding, InlineUniforms, or DynamicOffset, and it cannot be used in the same pipeline layout as bindings with BindingFlags::DynamicOffset.
+        \note Only supported with: Vulkan, Direct3D 12.
+        \see RenderingFeatures::hasDescriptorIndexing
+        */
+        Bindless        = (1 << 3),
+    };
+};
+
+
 /* ----- Structures ----- */
 
 /**
@@ -107,6 +178,13 @@ struct BindingDescriptor
     \note For Vulkan, this number specifies the size of an array of resources (e.g. an array of uniform buffers).
     */
     std::uint32_t   arraySize   = 1;
+
+    /**
+    \brief Specifies optional binding flags. By default 0.
+    \remarks This can be a bitwise OR combination of the BindingFlags entries.
+    \see BindingFlags
+    */
+    long            flags       = 0;
 };
 
 /**
@@ -36,6 +36,26 @@ class LLGL_EXPORT PipelineState : public RenderSystemChild
         */
         virtual const Report* GetReport() const = 0;
 
+        /**
+        \brief Returns true if this pipeline state has finished compiling and can be used without blocking.
+        \remarks Some renderers compile and link shaders asynchronously (e.g. OpenGL with \c GL_KHR_parallel_shader_compile),
+        and pipeline states that are created with RenderSystem::CreatePipelineStateAsync are compiled on the job system.
+        This function can be polled to defer the use of pipeline states until they are ready, e.g. while a loading screen is rendered.
+        Using a pipeline state or querying its report before it is ready is valid, but blocks until the compilation has finished.
+        By default, this always returns true.
+        \see GetReport
+        */
+        virtual bool IsReady() const;
+
+        /**
+        \brief Blocks the calling thread until this pipeline state has finished compiling.
+        \remarks If the asynchronous compilation failed, this function throws the exception of the compilation process.
+        By default, this function does nothing.
+        \see IsReady
+        \see RenderSystem::CreatePipelineStateAsync
+        */
+        virtual void Wait();
+
 };
 
 
@@ -16,6 +16,7 @@
 #include <LLGL/StaticLimits.h>
 #include <vector>
 #include <cstdint>
+#include <string.h>
 
 
 namespace LLGL
@@ -269,9 +270,46 @@ enum class TessellationPartition
     FractionalEven,
 };
 
+/**
+\brief Specialization constant type enumeration.
+\see SpecializationConstant::type
+*/
+enum class SpecializationConstantType
+{
+    // Not named "Bool", since that identifier is defined as a macro by Xlib on GNU/Linux.
+    //! Boolean constant. Equivalent of <code>layout(constant_id = N) const bool</code> in GLSL and <code>constant bool [[function_constant(N)]]</code> in Metal.
+    Boolean,
+
+    //! 32-bit signed integer constant.
+    Int,
+
+    //! 32-bit unsigned integer constant.
+    UInt,
+
+    //! 32-bit floating-point constant.
+    Float,
+};
+
 
 /* ----- Flags ----- */
 
+/**
+\brief Flags for asynchronous pipeline state creation.
+\see RenderSystem::CreatePipelineStateAsync
+*/
+struct AsyncPipelineFlags
+{
+    enum
+    {
+        /**
+        \brief Specifies that all draw or dispatch commands are skipped while the pending PSO is bound.
+        \remarks If this flag is not specified, binding a pending PSO with CommandBuffer::SetPipelineState blocks until it is ready.
+        \remarks For OpenGL, shaders are compiled by the driver and this flag is ignored.
+        */
+        SkipDrawsWhilePending = (1 << 0),
+    };
+};
+
 /**
 \brief Blend target color mask flags.
 \see BlendTargetDescriptor::colorMask
@@ -746,6 +784,66 @@ struct TessellationDescriptor
     bool                    outputWindingCCW    = false;
 };
 
+/**
+\brief Specialization constant structure to specialize a shader module when a PSO is created.
+\remarks With specialization constants, a single shader module can serve multiple pipeline permutations
+without compiling a separate module for each permutation.
+\remarks The value is always stored as a 32-bit word, i.e. a boolean constant is either 0 or 1.
+\see GraphicsPipelineDescriptor::specializationConstants
+\see ComputePipelineDescriptor::specializationConstants
+*/
+struct SpecializationConstant
+{
+    SpecializationConstant() = default;
+    SpecializationConstant(const SpecializationConstant&) = default;
+    SpecializationConstant& operator = (const SpecializationConstant&) = default;
+
+    //! Constructor to initialize a boolean specialization constant.
+    inline SpecializationConstant(std::uint32_t id, bool value) :
+        id    { id                                  },
+        type  { SpecializationConstantType::Boolean },
+        value { (value ? 1u : 0u)                   }
+    {
+    }
+
+    //! Constructor to initialize a signed integer specialization constant.
+    inline SpecializationConstant(std::uint32_t id, std::int32_t value) :
+        id    { id                                },
+        type  { SpecializationConstantType::Int   },
+        value { static_cast<std::uint32_t>(value) }
+    {
+    }
+
+    //! Constructor to initialize an unsigned integer specialization constant.
+    inline SpecializationConstant(std::uint32_t id, std::uint32_t value) :
+        id    { id                               },
+        type  { SpecializationConstantType::UInt },
+        value { value                            }
+    {
+    }
+
+    //! Constructor to initialize a floating-point specialization constant.
+    inline SpecializationConstant(std::uint32_t id, float value) :
+        id   { id                                },
+        type { SpecializationConstantType::Float }
+    {
+        static_assert(sizeof(float) == sizeof(std::uint32_t), "float must have the same size as std::uint32_t");
+        ::memcpy(&(this->value), &value, sizeof(value));
+    }
+
+    /**
+    \brief Specifies the constant identifier. By default 0.
+    \remarks Equivalent of <code>layout(constant_id = N)</code> in GLSL, <code>[[vk::constant_id(N)]]</code> in HLSL, and <code>[[function_constant(N)]]</code> in Metal.
+    */
+    std::uint32_t               id      = 0;
+
+    //! Specifies the type of the constant. By default SpecializationConstantType::UInt.
+    SpecializationConstantType  type    = SpecializationConstantType::UInt;
+
+    //! Specifies the value as 32-bit word. For SpecializationConstantType::Float, this is the bit pattern of the floating-point value. By default 0.
+    std::uint32_t               value   = 0;
+};
+
 /**
 \brief Graphics pipeline state descriptor structure.
 \remarks This structure describes the entire graphics pipeline:
@@ -771,10 +869,19 @@ struct GraphicsPipelineDescriptor
     */
     const RenderPass*       renderPass              = nullptr;
 
+    /**
+    \brief Specifies the index of the subpass within the render pass the graphics pipeline is used in. By default 0.
+    \remarks This must be less than RenderPassDescriptor::numSubpasses of the render pass, unless that render pass has no explicit subpasses, in which case this must be 0.
+    \note Only supported with: Vulkan. All other backends ignore this value.
+    \see RenderPassDescriptor::subpasses
+    */
+    std::uint32_t           subpass                 = 0;
+
     /**
     \brief Specifies the vertex shader.
-    \remarks Each graphics pipeline must have at least a vertex shader. Therefore, this must never be null when a graphics PSO is created.
+    \remarks Each graphics pipeline must have at least a vertex shader or a mesh shader. Therefore, either this or \c meshShader must not be null when a graphics PSO is created.
     With OpenGL, this shader may also have a stream output.
+    \see meshShader
     */
     Shader*                 vertexShader            = nullptr;
 
@@ -798,6 +905,23 @@ struct GraphicsPipelineDescriptor
     */
     Shader*                 geometryShader          = nullptr;
 
+    /**
+    \brief Specifies an optional task shader (also referred to as "Amplification Shader" or "Object Shader").
+    \remarks This can only be used together with a mesh shader. The task shader determines how many mesh shader workgroups are launched per task workgroup.
+    \see meshShader
+    */
+    Shader*                 taskShader              = nullptr;
+
+    /**
+    \brief Specifies the mesh shader.
+    \remarks If this is used, the pipeline is a mesh shader pipeline that must be drawn with CommandBuffer::DrawMeshTasks or CommandBuffer::DrawMeshTasksIndirect,
+    and \c vertexShader, \c tessControlShader, \c tessEvaluationShader, and \c geometryShader must be null.
+    The input assembler is bypassed for mesh shader pipelines, i.e. \c primitiveTopology is ignored and no vertex buffers are read.
+    \note Only supported with: Direct3D 12, Vulkan, Metal.
+    \see RenderingFeatures::hasMeshShaders
+    */
+    Shader*                 meshShader              = nullptr;
+
     /**
     \brief Specifies an optional fragment shader (also referred to as "Pixel Shader").
     \remarks If no fragment shader is specified, generated fragments are discarded by the output merger
@@ -846,6 +970,14 @@ struct GraphicsPipelineDescriptor
     \note Only supported with: Metal.
     */
     TessellationDescriptor  tessellation;
+
+    /**
+    \brief Specifies the specialization constants for all shader stages of this PSO.
+    \remarks Each constant is applied to every shader stage that declares a constant with the same identifier.
+    \note Only supported with: Vulkan, Metal.
+    \see SpecializationConstant
+    */
+    std::vector<SpecializationConstant> specializationConstants;
 };
 
 /**
@@ -867,6 +999,13 @@ struct ComputePipelineDescriptor
     \remarks This must never be null when a compute PSO is created.
     */
     Shader*                 computeShader   = nullptr;
+
+    /**
+    \brief Specifies the specialization constants for the compute shader.
+    \note Only supported with: Vulkan, Metal.
+    \see SpecializationConstant
+    */
+    std::vector<SpecializationConstant> specializationConstants;
 };
 
 
@@ -0,0 +1,160 @@
+/*
+ * ProfileFrameHistory.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_PROFILE_FRAME_HISTORY_H
+#define LLGL_PROFILE_FRAME_HISTORY_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/RenderingProfiler.h>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Statistics of a time value (in nanoseconds) over all frames of a ProfileFrameHistory.
+\see ProfileFrameStatistics
+*/
+struct ProfileTimeStatistics
+{
+    //! Minimum time.
+    std::uint64_t   min     = 0;
+
+    //! Median time, i.e. the 50th percentile.
+    std::uint64_t   p50     = 0;
+
+    //! 95th percentile time.
+    std::uint64_t   p95     = 0;
+
+    //! 99th percentile time.
+    std::uint64_t   p99     = 0;
+
+    //! Maximum time.
+    std::uint64_t   max     = 0;
+
+    //! Average time.
+    std::uint64_t   average = 0;
+};
+
+/**
+\brief Statistics of a single timer scope over all frames of a ProfileFrameHistory.
+\see ProfileFrameStatistics::scopes
+*/
+struct ProfileScopeStatistics
+{
+    //! Annotation of the scope, e.g. the name of a debug group. This pointer remains valid for the lifetime of the frame history.
+    const char*     annotation      = "";
+
+    //! Average GPU time (in nanoseconds) of this scope per frame in which it has been recorded.
+    std::uint64_t   averageTime     = 0;
+
+    //! Maximum GPU time (in nanoseconds) of this scope within a single frame.
+    std::uint64_t   maxTime         = 0;
+
+    //! Number of frames in which this scope has been recorded.
+    std::uint32_t   numFrames       = 0;
+};
+
+/**
+\brief Statistics over all frames of a ProfileFrameHistory.
+\see ProfileFrameHistory::GetStatistics
+*/
+struct ProfileFrameStatistics
+{
+    //! Number of frames these statistics are computed from.
+    std::uint32_t                       numFrames           = 0;
+
+    /**
+    \brief Statistics of the GPU time per frame, i.e. the sum of the elapsed time of all top-level time records of each frame.
+    \remarks This is only available if RenderingProfiler::timeRecordingEnabled is true. Frames without time records are not included.
+    \see FrameProfile::timeRecords
+    */
+    ProfileTimeStatistics               gpuTime;
+
+    //! Statistics of the CPU time per frame, i.e. the time between two successive calls to ProfileFrameHistory::Append.
+    ProfileTimeStatistics               cpuTime;
+
+    /**
+    \brief Minimum value of each counter over all frames, e.g. <code>minCounters.drawCommands</code>.
+    \remarks Only the counter values of this profile are used, i.e. FrameProfile::timeRecords and FrameProfile::stateChangeRecords are empty.
+    */
+    FrameProfile                        minCounters;
+
+    //! Maximum value of each counter over all frames, e.g. <code>maxCounters.drawCommands</code>.
+    FrameProfile                        maxCounters;
+
+    //! Statistics of all timer scopes, i.e. of all time records with the same annotation, in the order they have first been recorded.
+    std::vector<ProfileScopeStatistics> scopes;
+};
+
+/**
+\brief Ring buffer of the most recent frame profiles with statistics for in-game overlays.
+\remarks Only the values that are required for the statistics are stored for each frame, so frame profiles are not copied entirely.
+The statistics are only computed when they are queried and the history has changed since the last query.
+\note This class is not thread-safe.
+\see RenderingProfiler::NextProfile
+*/
+class LLGL_EXPORT ProfileFrameHistory
+{
+
+    public:
+
+        ProfileFrameHistory(const ProfileFrameHistory&) = delete;
+        ProfileFrameHistory& operator = (const ProfileFrameHistory&) = delete;
+
+        /**
+        \brief Initializes the frame history with the specified number of frames.
+        \param[in] numFrames Specifies the maximum number of frames this history holds. This must be greater than zero.
+        */
+        ProfileFrameHistory(std::size_t numFrames);
+
+        //! Releases the internal data.
+        ~ProfileFrameHistory();
+
+        /**
+        \brief Appends the specified frame profile to this history and overrides the oldest frame if the history is full.
+        \remarks This should be called once per frame before the profile is reset, for example:
+        \code
+        myFrameHistory.Append(myProfiler.frameProfile);
+        myProfiler.NextProfile();
+        \endcode
+        */
+        void Append(const FrameProfile& frameProfile);
+
+        //! Removes all frames from this history.
+        void Clear();
+
+        //! Returns the number of frames in this history.
+        std::size_t GetNumFrames() const;
+
+        /**
+        \brief Returns the statistics of all frames in this history.
+        \remarks The returned reference remains valid until the frame history is destroyed, but its content is updated by the next call to this function.
+        */
+        const ProfileFrameStatistics& GetStatistics();
+
+    private:
+
+        struct Pimpl;
+        Pimpl* pimpl_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,87 @@
+/*
+ * ProfileTraceWriter.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_PROFILE_TRACE_WRITER_H
+#define LLGL_PROFILE_TRACE_WRITER_H
+
+
+#include <LLGL/Export.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+struct FrameProfile;
+
+/**
+\brief Trace writer that streams rendering profiler frames into a file with the Chrome trace-event format.
+\remarks The output file can be opened with \c chrome://tracing or the Perfetto UI (https://ui.perfetto.dev).
+Events are written as soon as they are reported, so the file can be inspected even if the application terminates unexpectedly.
+CPU events (e.g. CommandQueue::Submit and SwapChain::Present of the debug layer) are written with their actual timestamps on the "CPU" track.
+The GPU time records of each frame are laid out back-to-back on the "GPU" track, starting at the time the frame has been written;
+since the timer queries are resolved with a latency of one or more frames, these timestamps only reflect durations and nesting, not absolute GPU time.
+The counters of each frame are written as counter tracks.
+\note This class is not thread-safe.
+\see RenderingProfiler::traceWriter
+*/
+class LLGL_EXPORT ProfileTraceWriter
+{
+
+    public:
+
+        ProfileTraceWriter(const ProfileTraceWriter&) = delete;
+        ProfileTraceWriter& operator = (const ProfileTraceWriter&) = delete;
+
+        /**
+        \brief Opens the specified file for writing. The time origin of all events is the time this constructor is called.
+        \param[in] filename Specifies the output filename, e.g. "trace.json". If the file already exists, it is overwritten.
+        \see IsOpen
+        */
+        ProfileTraceWriter(const char* filename);
+
+        //! Terminates the trace and closes the output file.
+        ~ProfileTraceWriter();
+
+        //! Returns true if the output file has been opened successfully.
+        bool IsOpen() const;
+
+        /**
+        \brief Writes a CPU event with the specified name and time interval.
+        \param[in] name Pointer to a null terminated string that specifies the event name. This must not be null.
+        \param[in] startTick Specifies the tick when the event started. This must be a value returned by Timer::Tick.
+        \param[in] endTick Specifies the tick when the event ended. This must be a value returned by Timer::Tick.
+        */
+        void WriteCPUEvent(const char* name, std::uint64_t startTick, std::uint64_t endTick);
+
+        /**
+        \brief Writes the specified frame profile, i.e. a frame marker, its counters, and its GPU time records.
+        \remarks This is called by RenderingProfiler::NextProfile whenever a trace writer is set.
+        \see FrameProfile::timeRecords
+        */
+        void WriteFrame(const FrameProfile& frameProfile);
+
+        //! Flushes all events that have been written so far to the output file.
+        void Flush();
+
+    private:
+
+        struct Pimpl;
+        Pimpl* pimpl_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
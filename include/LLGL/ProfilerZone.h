@@ -0,0 +1,74 @@
+/*
+ * ProfilerZone.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_PROFILER_ZONE_H
+#define LLGL_PROFILER_ZONE_H
+
+
+#include <LLGL/Export.h>
+
+
+namespace LLGL
+{
+
+namespace ProfilerZone
+{
+
+
+/* ----- Types ----- */
+
+/**
+\brief Callback interface to begin a named profiler zone.
+\param[in] name Specifies the null-terminated name of the zone, e.g. "VKCommandQueue::Submit". This string has static storage duration.
+\param[in] userData Specifies the user data that was passed to SetCallbacks.
+\remarks Zones are always properly nested per thread, i.e. each call to this callback is followed by a call to the ZoneEndCallback with the same name on the same thread.
+\see SetCallbacks
+*/
+using ZoneBeginCallback = void (*)(const char* name, void* userData);
+
+/**
+\brief Callback interface to end the named profiler zone that was most recently begun on the calling thread.
+\param[in] name Specifies the same name that was passed to the matching ZoneBeginCallback.
+\param[in] userData Specifies the user data that was passed to SetCallbacks.
+\see SetCallbacks
+*/
+using ZoneEndCallback = void (*)(const char* name, void* userData);
+
+
+/* ----- Functions ----- */
+
+/**
+\brief Returns true if LLGL was built with profiler zones, i.e. with the CMake option \c LLGL_ENABLE_PROFILER_ZONES.
+\remarks If this returns false, the callbacks passed to SetCallbacks are never invoked
+and the zones in LLGL's hot paths are compiled out entirely.
+*/
+LLGL_EXPORT bool IsSupported();
+
+/**
+\brief Sets the callbacks that are invoked when LLGL enters and leaves a named zone in one of its hot paths.
+\param[in] beginCallback Specifies the callback that is invoked when a zone begins. If this is null, profiler zones are disabled.
+\param[in] endCallback Specifies the callback that is invoked when a zone ends. If this is null, profiler zones are disabled.
+\param[in] userData Optional raw pointer that is passed to both callbacks.
+\remarks The zones cover the command replay of the OpenGL backend, command queue submission, resource barrier flushing,
+staging buffer allocations, pipeline state creation, and image conversion. These callbacks can be used to forward the zones to an external profiler such as Tracy or VTune.
+The callbacks are invoked from whichever thread executes the respective zone and must therefore be thread safe.
+The callbacks should be set before any render system is loaded and must not be changed while a zone is active.
+\see IsSupported
+*/
+LLGL_EXPORT void SetCallbacks(ZoneBeginCallback beginCallback, ZoneEndCallback endCallback, void* userData = nullptr);
+
+
+} // /namespace ProfilerZone
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -121,13 +121,57 @@ struct QueryHeapDescriptor
     - QueryType::StreamOutOverflow
     \remarks Render conditions can be used to render complex geometry under the condition that
     a previous (commonly significantly smaller) geometry has passed the depth and stencil tests.
+    \remarks The predicates of such a query heap are resolved on the GPU, i.e. conditional rendering never reads back query results to the CPU.
     \see CommandBuffer::BeginRenderCondition
     \see CommandBuffer::EndRenderCondition
-    \note Only supported with: OpenGL, Direct3D 11, Direct3D 12.
+    \see RenderingFeatures::hasRenderCondition
+    \note Only supported with: OpenGL, Vulkan, Direct3D 11, Direct3D 12.
     */
     bool            renderCondition = false;
 };
 
+/**
+\brief Range of queries whose results have been retrieved asynchronously.
+\see CommandQueue::TryGetQueryResults
+*/
+struct QueryRange
+{
+    //! Zero-based index of the first query within the heap.
+    std::uint32_t   firstQuery  = 0;
+
+    //! Number of queries in the range.
+    std::uint32_t   numQueries  = 0;
+};
+
+/**
+\brief Pair of CPU and GPU timestamps that have been sampled at the same point in time.
+\remarks This can be used to correlate GPU timings with CPU timings from the Timer interface, e.g. to place GPU scopes on the same timeline
+as CPU scopes of the job system in a trace export. A GPU timestamp \c t can be converted into the CPU time domain as follows:
+\code
+const double gpuSeconds = static_cast<double>(t - calibration.gpuTimestamp) / calibration.gpuFrequency;
+const std::uint64_t cpuTick = calibration.cpuTimestamp + static_cast<std::uint64_t>(gpuSeconds * LLGL::Timer::Frequency());
+\endcode
+Since the CPU and GPU clocks drift apart over time, the calibration should be queried periodically, e.g. once per frame.
+\see CommandQueue::QueryCalibratedTimestamps
+*/
+struct CalibratedTimestamps
+{
+    //! CPU timestamp in the same time domain as Timer::Tick, i.e. in units of Timer::Frequency.
+    std::uint64_t   cpuTimestamp    = 0;
+
+    //! GPU timestamp of the command queue in units of \c gpuFrequency.
+    std::uint64_t   gpuTimestamp    = 0;
+
+    //! Frequency (in ticks per second) of the GPU timestamps.
+    std::uint64_t   gpuFrequency    = 0;
+
+    /**
+    \brief Maximum deviation (in nanoseconds) between the points in time at which the CPU and GPU timestamps have been sampled.
+    \remarks This is zero if the backend does not report the deviation.
+    */
+    std::uint64_t   maxDeviation    = 0;
+};
+
 
 } // /namespace LLGL
 
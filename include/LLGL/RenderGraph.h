@@ -0,0 +1,253 @@
+/*
+ * RenderGraph.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_RENDER_GRAPH_H
+#define LLGL_RENDER_GRAPH_H
+
+
+#include <LLGL/NonCopyable.h>
+#include <LLGL/Constants.h>
+#include <LLGL/TextureFlags.h>
+#include <LLGL/BufferFlags.h>
+#include <LLGL/CommandBufferFlags.h>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class RenderSystem;
+class RenderGraph;
+class CommandBuffer;
+class Texture;
+class Buffer;
+
+/* ----- Types ----- */
+
+/**
+\brief Handle of a texture or buffer within a render graph.
+\see Constants::invalidRenderGraphResource
+*/
+using RenderGraphResource = std::uint32_t;
+
+/**
+\brief Render graph pass execution callback.
+\remarks For passes with attachments, this is called between CommandBuffer::BeginRenderPass and CommandBuffer::EndRenderPass.
+\see RenderGraphPassDescriptor::execute
+*/
+using RenderGraphPassCallback = std::function<void(CommandBuffer& commandBuffer, const RenderGraph& renderGraph)>;
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Render graph attachment structure.
+\see RenderGraphPassDescriptor::colorAttachments
+\see RenderGraphPassDescriptor::depthStencilAttachment
+*/
+struct RenderGraphAttachment
+{
+    //! Texture resource that is attached. By default Constants::invalidRenderGraphResource, i.e. the attachment is disabled.
+    RenderGraphResource resource    = Constants::invalidRenderGraphResource;
+
+    //! MIP-map level of the texture that is attached. By default 0.
+    std::uint32_t       mipLevel    = 0;
+
+    //! Array layer of the texture that is attached. By default 0.
+    std::uint32_t       arrayLayer  = 0;
+
+    /**
+    \brief Specifies whether the attachment is cleared at the beginning of the pass. By default false.
+    \remarks If this is false, the previous content of the attachment is loaded, unless no previous pass has written to it.
+    */
+    bool                clear       = false;
+
+    //! Clear value for the attachment if \c clear is true.
+    ClearValue          clearValue;
+};
+
+/**
+\brief Render graph pass descriptor structure.
+\remarks Each pass declares the textures and buffers it reads and writes,
+so the render graph can determine which passes contribute to its outputs and how long each transient resource must be kept.
+\see RenderGraph::AddPass
+*/
+struct RenderGraphPassDescriptor
+{
+    //! Optional name of the pass, which is used for debug groups (see CommandBuffer::PushDebugGroup). By default null.
+    const char*                         name                    = nullptr;
+
+    //! Resources that are read by this pass, e.g. sampled textures, vertex buffers, or indirect argument buffers.
+    std::vector<RenderGraphResource>    reads;
+
+    //! Resources that are written by this pass outside of the attachments, e.g. storage textures and buffers in a compute pass.
+    std::vector<RenderGraphResource>    writes;
+
+    /**
+    \brief Color attachments of this pass.
+    \remarks If this pass has any color or depth-stencil attachment, it is a render pass and all of its attachments must have the same resolution.
+    Otherwise, it is executed outside of a render pass, e.g. for compute dispatches and copy commands.
+    */
+    std::vector<RenderGraphAttachment>  colorAttachments;
+
+    //! Depth-stencil attachment of this pass. This is disabled by default.
+    RenderGraphAttachment               depthStencilAttachment;
+
+    //! Specifies whether this pass must never be culled, e.g. because it writes to a resource that is not managed by the render graph. By default false.
+    bool                                hasSideEffects          = false;
+
+    //! Callback that records the commands of this pass.
+    RenderGraphPassCallback             execute;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Optional render graph that schedules passes by their declared resource reads and writes.
+\remarks A render graph is typically declared anew each frame: Reset it, declare all resources and passes, then Compile and Execute it.
+Compiling the graph performs the following steps:
+- Passes that do not contribute to an imported resource and have no side effects are culled.
+- Transient resources (see CreateTexture and CreateBuffer) are only allocated for passes that are not culled,
+  and resources whose lifetimes do not overlap share the same physical texture or buffer if their descriptors are equal.
+  The physical resources are kept between frames and only released when they are no longer needed after a compilation.
+- Load and store operations of all attachments are derived from the passes that read those attachments afterwards,
+  i.e. content that is never read again is not stored and content that has not been written before is not loaded.
+\remarks Resource state transitions and barriers are still recorded by the backends,
+but since the render graph determines the order of all passes upfront, they are recorded in the order of execution.
+\remarks Here is an example how to use a render graph:
+\code
+LLGL::RenderGraph myRenderGraph{ *myRenderer };
+
+// Declare resources and passes each frame
+myRenderGraph.Reset();
+
+auto mySceneColor = myRenderGraph.CreateTexture(mySceneColorDesc);
+auto mySceneDepth = myRenderGraph.CreateTexture(mySceneDepthDesc);
+auto myOutput     = myRenderGraph.ImportTexture(*myOutputTexture);
+
+LLGL::RenderGraphPassDescriptor myScenePass;
+{
+    myScenePass.colorAttachments.resize(1);
+    myScenePass.colorAttachments[0].resource        = mySceneColor;
+    myScenePass.colorAttachments[0].clear           = true;
+    myScenePass.depthStencilAttachment.resource     = mySceneDepth;
+    myScenePass.depthStencilAttachment.clear        = true;
+    myScenePass.execute = [&](LLGL::CommandBuffer& cmdBuffer, const LLGL::RenderGraph&)
+    {
+        DrawScene(cmdBuffer);
+    };
+}
+myRenderGraph.AddPass(myScenePass);
+
+LLGL::RenderGraphPassDescriptor myPostProcessPass;
+{
+    myPostProcessPass.reads.push_back(mySceneColor);
+    myPostProcessPass.colorAttachments.resize(1);
+    myPostProcessPass.colorAttachments[0].resource  = myOutput;
+    myPostProcessPass.execute = [&](LLGL::CommandBuffer& cmdBuffer, const LLGL::RenderGraph& graph)
+    {
+        cmdBuffer.SetResource(*graph.GetTexture(mySceneColor), 0, LLGL::BindFlags::Sampled, LLGL::StageFlags::FragmentStage);
+        DrawFullscreenQuad(cmdBuffer);
+    };
+}
+myRenderGraph.AddPass(myPostProcessPass);
+
+// Compile and record render graph into command buffer
+myRenderGraph.Compile();
+myCmdBuffer->Begin();
+myRenderGraph.Execute(*myCmdBuffer);
+myCmdBuffer->End();
+\endcode
+\note This class is not thread-safe.
+*/
+class LLGL_EXPORT RenderGraph : public NonCopyable
+{
+
+    public:
+
+        /**
+        \brief Initializes an empty render graph for the specified render system.
+        \remarks The render system must outlive this render graph. All physical resources of the graph are released with its destruction.
+        */
+        RenderGraph(RenderSystem& renderSystem);
+
+        ~RenderGraph();
+
+        /**
+        \brief Removes all passes and resources from this graph.
+        \remarks The physical resources, render passes, and render targets are kept, so they can be reused by the next compilation.
+        */
+        void Reset();
+
+        /**
+        \brief Declares a new transient texture that is only allocated during the execution of the passes that use it.
+        \remarks The content of a transient texture is undefined before the first pass writes to it.
+        */
+        RenderGraphResource CreateTexture(const TextureDescriptor& textureDesc);
+
+        /**
+        \brief Declares a new transient buffer that is only allocated during the execution of the passes that use it.
+        \remarks The content of a transient buffer is undefined before the first pass writes to it.
+        */
+        RenderGraphResource CreateBuffer(const BufferDescriptor& bufferDesc);
+
+        /**
+        \brief Imports the specified texture into this graph.
+        \remarks Imported resources are the outputs of a render graph, i.e. their content is loaded and stored by all passes, and passes that write to them are never culled.
+        */
+        RenderGraphResource ImportTexture(Texture& texture);
+
+        //! Imports the specified buffer into this graph.
+        RenderGraphResource ImportBuffer(Buffer& buffer);
+
+        /**
+        \brief Adds a new pass to this graph and returns its index.
+        \remarks Passes are executed in the order they are added. Each pass must only refer to resources that have been declared in this graph.
+        */
+        std::uint32_t AddPass(const RenderGraphPassDescriptor& passDesc);
+
+        /**
+        \brief Compiles this graph, i.e. culls unused passes, allocates physical resources, and derives the load and store operations of all attachments.
+        \throws std::invalid_argument If a pass refers to an invalid resource or an attachment refers to a buffer.
+        */
+        void Compile();
+
+        /**
+        \brief Records all passes of this graph that have not been culled into the specified command buffer.
+        \remarks If the graph has been modified since the last compilation, it is compiled implicitly. The command buffer must be between CommandBuffer::Begin and CommandBuffer::End.
+        */
+        void Execute(CommandBuffer& commandBuffer);
+
+        //! Returns the physical texture of the specified resource, or null if the resource is not a texture or has not been allocated.
+        Texture* GetTexture(RenderGraphResource resource) const;
+
+        //! Returns the physical buffer of the specified resource, or null if the resource is not a buffer or has not been allocated.
+        Buffer* GetBuffer(RenderGraphResource resource) const;
+
+        //! Returns true if the specified pass has been culled by the last compilation.
+        bool IsPassCulled(std::uint32_t pass) const;
+
+    private:
+
+        struct Pimpl;
+        Pimpl* pimpl_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
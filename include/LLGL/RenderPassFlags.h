@@ -105,6 +105,35 @@ struct AttachmentFormatDescriptor
     AttachmentStoreOp       storeOp = AttachmentStoreOp::Undefined;
 };
 
+/**
+\brief Render pass subpass descriptor structure.
+\remarks A subpass specifies which attachments of the render pass are written and which color attachments are read as input attachments,
+i.e. the content of the current pixel that was written by a previous subpass.
+\see RenderPassDescriptor::subpasses
+\see CommandBuffer::NextSubpass
+*/
+struct SubpassDescriptor
+{
+    /**
+    \brief Specifies the bitmask of color attachments that are written in this subpass. By default 0.
+    \remarks The least significant bit refers to the first color attachment, i.e. RenderPassDescriptor::colorAttachments[0].
+    The fragment shader output locations always refer to the color attachment indices of the render pass.
+    */
+    std::uint32_t   colorAttachments        = 0;
+
+    /**
+    \brief Specifies the bitmask of color attachments that are read as input attachments in this subpass. By default 0.
+    \remarks The least significant bit refers to the first color attachment.
+    For SPIR-V shaders, the input attachment index (i.e. \c input_attachment_index in GLSL) refers to the color attachment index of the render pass.
+    An input attachment should not be written in the same subpass, i.e. \c colorAttachments and \c inputAttachments should be disjoint.
+    \see RenderingFeatures::hasFramebufferFetch
+    */
+    std::uint32_t   inputAttachments        = 0;
+
+    //! Specifies whether this subpass uses the depth-stencil attachment of the render pass. By default true.
+    bool            depthStencilAttachment  = true;
+};
+
 /**
 \brief Render pass descriptor structure.
 \remarks A render pass object can be used across multiple render targets.
@@ -148,6 +177,23 @@ struct RenderPassDescriptor
     \see TextureDescriptor::samples
     */
     std::uint32_t               samples             = 1;
+
+    /**
+    \brief Specifies the number of subpasses. By default 0.
+    \remarks If this is 0, the render pass has a single implicit subpass that writes all attachments.
+    Otherwise, this must be less than or equal to \c LLGL_MAX_NUM_SUBPASSES and the render pass starts with the first entry in \c subpasses.
+    Switching to the next subpass is done with CommandBuffer::NextSubpass.
+    \remarks A render pass with multiple subpasses must be used with a render target that was created with that render pass (see RenderTargetDescriptor::renderPass).
+    Commands that interrupt a render pass (e.g. CommandBuffer::UpdateBuffer) must not be used inside a render pass with multiple subpasses.
+    \see SubpassDescriptor
+    */
+    std::uint32_t               numSubpasses        = 0;
+
+    /**
+    \brief Specifies the subpasses of the render pass. Only the first \c numSubpasses entries are used.
+    \see numSubpasses
+    */
+    SubpassDescriptor           subpasses[LLGL_MAX_NUM_SUBPASSES];
 };
 
 
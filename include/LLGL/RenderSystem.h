@@ -14,6 +14,7 @@
 #include <LLGL/CommandQueue.h>
 #include <LLGL/CommandBuffer.h>
 #include <LLGL/RenderSystemFlags.h>
+#include <LLGL/VideoAdapter.h>
 #include <LLGL/RenderingProfiler.h>
 #include <LLGL/RenderingDebugger.h>
 #include <LLGL/Blob.h>
@@ -120,6 +121,12 @@ renderSystem->WriteBuffer(*buffer, modificationData, ...);
 // Release object
 renderSystem->Release(*buffer);
 \endcode
+\remarks Thread safety depends on the backend:
+- For Vulkan, Direct3D 12, and Metal, all "Create...", "Write...", "Read...", and "Release" functions can be called from any thread, e.g. to load assets from multiple worker threads.
+Each of these functions is internally synchronized, but uploads of initial data are serialized across all threads, since they share the same upload command context.
+The same object must not be modified or released by one thread while it is used by another thread.
+- For OpenGL, Direct3D 11, and the Null renderer, all functions of the render system must be called from the same thread.
+- For all backends, the command queue and swap-chain functions must be called from a single thread, and each command buffer must only be encoded by one thread at a time.
 */
 class LLGL_EXPORT RenderSystem : public Interface
 {
@@ -139,11 +146,38 @@ class LLGL_EXPORT RenderSystem : public Interface
         */
         static std::vector<std::string> FindModules();
 
+        /**
+        \brief Returns the list of all video adapters the specified render system module can be created on.
+        \param[in] renderSystemDesc Specifies the render system descriptor. Only the members \c moduleName, \c flags, and \c rendererConfig are used.
+        \return List of video adapter descriptors in the order that is used by RenderSystemDescriptor::adapterIndex.
+        The list is empty if the module does not support adapter enumeration.
+        \remarks This loads the module temporarily but does not create a render system, so it can be used to decide how many render systems to create:
+        \code
+        // Create one render system per discrete GPU
+        LLGL::RenderSystemDescriptor rendererDesc = "Vulkan";
+        auto adapters = LLGL::RenderSystem::QueryVideoAdapters(rendererDesc);
+        for (int i = 0; i < static_cast<int>(adapters.size()); ++i)
+        {
+            if ((adapters[i].flags & LLGL::VideoAdapterFlags::Discrete) != 0)
+            {
+                rendererDesc.adapterIndex = i;
+                myRenderSystems.push_back(LLGL::RenderSystem::Load(rendererDesc));
+            }
+        }
+        \endcode
+        \throws std::runtime_error If loading the specified module failed.
+        \see RenderSystemDescriptor::adapterIndex
+        */
+        static std::vector<VideoAdapterDescriptor> QueryVideoAdapters(const RenderSystemDescriptor& renderSystemDesc);
+
         /**
         \brief Loads a new render system from the specified module.
         \param[in] renderSystemDesc Specifies the render system descriptor structure. The 'moduleName' member of this strucutre must not be empty.
         \param[in] profiler Optional pointer to a rendering profiler. This is only supported if LLGL was compiled with the \c LLGL_ENABLE_DEBUG_LAYER flag.
         If this is used, the counters of the profiler must be reset manually.
+        If only a profiler but no debugger is specified, the debug layer runs as a lightweight profiler layer,
+        i.e. it only increments the counters and issues the timer queries (see RenderingProfiler::timeRecordingEnabled),
+        but it skips all validation and binding state tracking, so it can also be used in release builds.
         \param[in] debugger Optional pointer to a rendering debugger. This is only supported if LLGL was compiled with the \c LLGL_ENABLE_DEBUG_LAYER flag.
         If the default debugger is used (i.e. no sub class of RenderingDebugger), then all reports will be send to the Log.
         In order to see any reports from the Log, use either Log::SetReportCallback or Log::SetReportCallbackStd.
@@ -206,6 +240,14 @@ class LLGL_EXPORT RenderSystem : public Interface
         */
         const RenderingCapabilities& GetRenderingCaps() const;
 
+        /**
+        \brief Returns the report of the render system initialization or null if there is none.
+        \remarks The Vulkan backend reports the time spent in each start-up phase, e.g. instance creation and physical device selection.
+        \note Only supported with: Vulkan.
+        \see RendererConfigurationVulkan::adapterProfileFilename
+        */
+        const Report* GetReport() const;
+
     public:
 
         /* ----- Swap-chain ----- */
@@ -232,6 +274,15 @@ class LLGL_EXPORT RenderSystem : public Interface
         //! Returns the single instance of the command queue.
         virtual CommandQueue* GetCommandQueue() = 0;
 
+        /**
+        \brief Returns the asynchronous compute queue or null if there is none.
+        \remarks This is only available if the render system was created with the RenderSystemFlags::AsyncComputeQueue flag
+        and the hardware provides a queue that can execute compute work simultaneously to the graphics queue.
+        \see RenderSystemFlags::AsyncComputeQueue
+        \see CommandBufferFlags::ComputeQueue
+        */
+        virtual CommandQueue* GetComputeQueue();
+
         /* ----- Command buffers ----- */
 
         /**
@@ -264,6 +315,9 @@ class LLGL_EXPORT RenderSystem : public Interface
         \brief Creates a new buffer array.
         \param[in] numBuffers Specifies the number of buffers in the array. This must be greater than 0.
         \param[in] bufferArray Pointer to an array of Buffer object pointers. This must not be null.
+        \param[in] offsets Optional pointer to an array of byte offsets, one for each buffer in \c bufferArray.
+        Each offset specifies where the data of its buffer begins, which allows to bind vertex streams that are sub-allocated from a larger buffer.
+        If this is null, all offsets are zero. By default null.
         \remarks All buffers within this array must have the same binding flags.
         The buffers inside this array must persist as long as this buffer array is used,
         and the individual buffers are still required to read and write its data from and to the GPU.
@@ -273,7 +327,7 @@ class LLGL_EXPORT RenderSystem : public Interface
         \throws std::invalid_argument If not all buffers have the same binding flags.
         \see BufferDescriptor::bindFlags
         */
-        virtual BufferArray* CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray) = 0;
+        virtual BufferArray* CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets = nullptr) = 0;
 
         //! Releases the specified buffer object. After this call, the specified object must no longer be used.
         virtual void Release(Buffer& buffer) = 0;
@@ -294,6 +348,20 @@ class LLGL_EXPORT RenderSystem : public Interface
         */
         virtual void WriteBuffer(Buffer& buffer, std::uint64_t offset, const void* data, std::uint64_t dataSize) = 0;
 
+        /**
+        \brief Updates multiple disjoint regions of the specified buffer at once.
+        \param[in] buffer Specifies the destination buffer whose data is to be updated.
+        \param[in] numRegions Specifies the number of entries in the \c regions array.
+        \param[in] regions Pointer to an array of buffer write regions. Each region must fit into the buffer, and the regions should not overlap.
+        \remarks This is equivalent to calling WriteBuffer(Buffer&, std::uint64_t, const void*, std::uint64_t) for each region,
+        but backends with staging buffers (i.e. Vulkan and Direct3D 12) gather all regions into a single staging allocation
+        and copy them with a single copy command, so the overhead of staging, barriers, and synchronization is paid only once per batch.
+        This is useful to update many small ranges of streaming data, e.g. particle or instance data, every frame.
+        The default implementation calls WriteBuffer for each region.
+        \see BufferWriteRegion
+        */
+        virtual void WriteBuffer(Buffer& buffer, std::uint32_t numRegions, const BufferWriteRegion* regions);
+
         /**
         \brief Reads the data from the specified buffer.
         \param[in] buffer Specifies the buffer which is to be read.
@@ -402,6 +470,122 @@ class LLGL_EXPORT RenderSystem : public Interface
         */
         virtual void ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc) = 0;
 
+        /**
+        \brief Queries the tiling properties of the specified sparse texture.
+        \param[in] texture Specifies the texture whose tiling is to be queried. This must have been created with the MiscFlags::Sparse flag.
+        \param[out] outTiling Specifies the output tiling properties.
+        \return True if the texture is a sparse texture and the tiling properties were queried successfully, otherwise false.
+        \see MiscFlags::Sparse
+        */
+        virtual bool QueryTextureTiling(const Texture& texture, TextureTiling& outTiling);
+
+        /**
+        \brief Commits GPU memory to all tiles of a sparse texture within the specified region.
+        \param[in] texture Specifies the sparse texture whose tiles are to be committed. This must have been created with the MiscFlags::Sparse flag.
+        \param[in] textureRegion Specifies the region of tiles for a single MIP-map level and a range of array layers.
+        The offset and extent must be aligned to the tile extent (see TextureTiling::tileExtent).
+        If the MIP-map level is packed into the MIP-map tail, the entire MIP-map tail of the selected array layers is committed and the offset and extent are ignored.
+        \remarks Tiles that are already committed are left unchanged. The content of newly committed tiles is undefined until they are written.
+        \remarks The Vulkan and Direct3D 12 backends update the tile mappings on the graphics queue, i.e. in order with all command buffers that have been submitted before.
+        The Metal backend maps all tiles from a single sparse heap that is shared between all sparse textures of the render system.
+        \remarks This function does nothing if sparse textures are not supported.
+        \see RenderingFeatures::hasSparseTextures
+        \see DecommitTextureTiles
+        */
+        virtual void CommitTextureTiles(Texture& texture, const TextureRegion& textureRegion);
+
+        /**
+        \brief Releases the GPU memory of all committed tiles of a sparse texture within the specified region.
+        \remarks The tiles must not be accessed by any command buffer that is still in flight. Reading a decommitted tile afterwards is undefined.
+        \see CommitTextureTiles
+        */
+        virtual void DecommitTextureTiles(Texture& texture, const TextureRegion& textureRegion);
+
+        /* ----- Native resources ----- */
+
+        /**
+        \brief Queries the native object of the specified buffer or texture.
+        \param[in] resource Specifies the buffer or texture whose native object is to be queried.
+        \param[out] outHandle Specifies the output native handle, e.g. of type NativeHandleType::VkImage for a texture of the Vulkan backend.
+        \return True if the native object was queried successfully, otherwise false.
+        \remarks The native object is owned by the resource, i.e. it must not be released by the application and is only valid as long as the resource is alive.
+        \see NativeHandleType
+        */
+        virtual bool QueryNativeHandle(const Resource& resource, NativeResourceHandle& outHandle);
+
+        /**
+        \brief Exports a shared handle of the memory of the specified buffer or texture.
+        \param[in] resource Specifies the buffer or texture whose memory is to be exported. This must have been created with the MiscFlags::Shared flag.
+        \param[in] handleType Specifies the type of shared handle, i.e. NativeHandleType::OpaqueFD, NativeHandleType::OpaqueWin32, or NativeHandleType::D3D12SharedHandle.
+        \param[out] outHandle Specifies the output shared handle. Its memory size denotes the size of the exported memory block.
+        \return True if the shared handle was exported successfully, otherwise false.
+        \remarks Each call creates a new handle that is owned by the application, i.e. it must be closed (or imported) by the application.
+        The other API or process that imports the handle must synchronize its accesses with the command buffers of this render system.
+        \see MiscFlags::Shared
+        \see RenderingFeatures::hasExternalMemory
+        */
+        virtual bool ExportResource(Resource& resource, NativeHandleType handleType, NativeResourceHandle& outHandle);
+
+        /**
+        \brief Creates a new buffer that wraps a native buffer object or that is bound to the shared memory of another API or process.
+        \param[in] bufferDesc Specifies the buffer descriptor. This must match the properties of the native buffer, e.g. its size and binding flags.
+        \param[in] nativeHandle Specifies the native buffer object or a shared memory handle that has been exported by ExportResource for instance.
+        \return Pointer to the new Buffer object, or null if the type of native handle is not supported.
+        \remarks If the native handle denotes a native object (e.g. NativeHandleType::VkBuffer), no memory is allocated and the application keeps the ownership of the native object,
+        i.e. it must not be released before the new buffer is released. Such a buffer cannot be read, written, or mapped by the CPU with this render system.
+        \remarks If the native handle denotes a shared handle (e.g. NativeHandleType::OpaqueFD), a new native buffer is created and bound to the imported memory.
+        \see NativeHandleType
+        */
+        virtual Buffer* ImportBuffer(const BufferDescriptor& bufferDesc, const NativeResourceHandle& nativeHandle);
+
+        /**
+        \brief Creates a new texture that wraps a native texture object or that is bound to the shared memory of another API or process.
+        \param[in] textureDesc Specifies the texture descriptor. This must match the properties of the native texture, e.g. its type, format, and extent.
+        \param[in] nativeHandle Specifies the native texture object or a shared memory handle that has been exported by ExportResource for instance.
+        \return Pointer to the new Texture object, or null if the type of native handle is not supported.
+        \remarks If the native handle denotes a native object (e.g. NativeHandleType::MTLTexture), the application keeps the ownership of the native object,
+        i.e. it must not be released before the new texture is released. A native Vulkan image must be in the \c VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL layout, and a native Direct3D 12 resource must be in the \c D3D12_RESOURCE_STATE_COMMON state.
+        \remarks If the native handle denotes a shared handle (e.g. NativeHandleType::D3D12SharedHandle), a new native texture is created and bound to the imported memory.
+        The texture content is defined by the API or process that writes into the shared memory.
+        \see NativeHandleType
+        */
+        virtual Texture* ImportTexture(const TextureDescriptor& textureDesc, const NativeResourceHandle& nativeHandle);
+
+        /* ----- Readbacks ----- */
+
+        /**
+        \brief Maps the data of the specified readback into CPU memory space if the GPU has completed the copy.
+        \param[in] ticket Specifies the ticket that was returned by CommandBuffer::CopyBufferToReadback or CommandBuffer::CopyTextureToReadback.
+        \param[out] outLayout Optional pointer to the memory layout of the readback data. By default null.
+        \return Pointer to the readback data, or null if the GPU has not completed the copy yet or the ticket is invalid.
+        \remarks This function never waits for the GPU, so it can be polled for the same ticket each frame until it succeeds.
+        Once it succeeds, the data remains valid until UnmapReadback is called for this ticket.
+        Here is an example for GPU picking:
+        \code
+        // Record copy of the pixel under the cursor
+        myPickingTicket = myCmdBuffer->CopyTextureToReadback(*myObjectIDTexture, LLGL::TextureRegion{ { cursorX, cursorY, 0 }, { 1, 1, 1 } });
+
+        // Check for the result in subsequent frames
+        if (auto data = myRenderer->MapReadback(myPickingTicket))
+        {
+            myPickedObjectID = *reinterpret_cast<const std::uint32_t*>(data);
+            myRenderer->UnmapReadback(myPickingTicket);
+        }
+        \endcode
+        \see UnmapReadback
+        \see CommandBuffer::CopyBufferToReadback
+        \see CommandBuffer::CopyTextureToReadback
+        */
+        virtual const void* MapReadback(std::uint64_t ticket, ReadbackLayout* outLayout = nullptr);
+
+        /**
+        \brief Releases the readback memory of the specified ticket. The ticket must no longer be used afterwards.
+        \remarks This can also be called for readbacks that have not been completed yet, e.g. to discard them.
+        Their memory is released once the GPU has completed the copy.
+        \see MapReadback
+        */
+        virtual void UnmapReadback(std::uint64_t ticket);
+
         /* ----- Samplers ---- */
 
         /**
@@ -489,6 +673,19 @@ class LLGL_EXPORT RenderSystem : public Interface
         */
         virtual Shader* CreateShader(const ShaderDescriptor& shaderDesc) = 0;
 
+        /**
+        \brief Creates multiple Shader objects at once.
+        \param[in] numShaders Specifies the number of shaders to create.
+        \param[in] shaderDescs Pointer to an array of \c numShaders shader descriptors.
+        \param[out] outShaders Pointer to an array of \c numShaders shader pointers that receive the new Shader objects in the same order as their descriptors.
+        \remarks This is equivalent to calling CreateShader for each descriptor, but the Direct3D backends compile the high-level shader sources
+        in parallel on the job system (see JobSystem::ParallelFor), which reduces the loading time for large sets of shaders.
+        All other backends create the shaders one after another.
+        \see CreateShader
+        \see RenderSystemDescriptor::shaderCacheDirectory
+        */
+        virtual void CreateShaders(std::uint32_t numShaders, const ShaderDescriptor* shaderDescs, Shader** outShaders);
+
         //! Releases the specified Shader object. After this call, the specified object must no longer be used.
         virtual void Release(Shader& shader) = 0;
 
@@ -544,6 +741,7 @@ class LLGL_EXPORT RenderSystem : public Interface
         \endcode
         \see CreatePipelineState(const GraphicsPipelineDescriptor&, std::unique_ptr<Blob>*)
         \see CreatePipelineState(const ComputePipelineDescriptor&, std::unique_ptr<Blob>*)
+        \see PipelineCache
         */
         virtual PipelineState* CreatePipelineState(const Blob& serializedCache) = 0;
 
@@ -555,6 +753,13 @@ class LLGL_EXPORT RenderSystem : public Interface
         \param[out] serializedCache Optional pointer to a unique Blob instance. If this is not null, the renderer returns the pipeline state as serialized cache.
         This cache may be unique to the respective hardware and driver the application is running on. The behavior is undefined if this cache is used in a different software environment.
         It can be used to faster restore a pipeline state on next application run.
+        \remarks For the Vulkan backend, \c serializedCache is also an input parameter:
+        if it refers to a non-null Blob from a previous call, its content is merged into the device-wide pipeline cache before the PSO is created.
+        The output Blob always contains the entire device-wide pipeline cache, i.e. the Blob of the last PSO creation can be used to accelerate all PSOs on the next application run.
+        \remarks For the Direct3D 12 backend with RendererConfigurationD3D12::pipelineLibraryEnabled, the output Blob contains the entire pipeline library
+        and must be passed to RendererConfigurationD3D12::pipelineLibrary on the next application run.
+        \remarks For the Metal backend on macOS 11.0 and iOS 14.0 or later, \c serializedCache is handled just like for the Vulkan backend,
+        but the device-wide cache is an \c MTLBinaryArchive. Shaders can additionally be precompiled offline into a \c metallib via ShaderSourceType::BinaryFile or ShaderSourceType::BinaryBuffer.
         \see GraphicsPipelineDescriptor
         \see CreatePipelineState(const Blob&)
         */
@@ -567,11 +772,41 @@ class LLGL_EXPORT RenderSystem : public Interface
         \param[out] serializedCache Optional pointer to a unique Blob instance. If this is not null, the renderer returns the pipeline state as serialized cache.
         This cache may be unique to the respective hardware and driver the application is running on. The behavior is undefined if this cache is used in a different software environment.
         It can be used to faster restore a pipeline state on next application run.
+        \remarks For the Vulkan backend, \c serializedCache is also an input parameter:
+        if it refers to a non-null Blob from a previous call, its content is merged into the device-wide pipeline cache before the PSO is created.
+        The output Blob always contains the entire device-wide pipeline cache, i.e. the Blob of the last PSO creation can be used to accelerate all PSOs on the next application run.
+        \remarks For the Direct3D 12 backend with RendererConfigurationD3D12::pipelineLibraryEnabled, the output Blob contains the entire pipeline library
+        and must be passed to RendererConfigurationD3D12::pipelineLibrary on the next application run.
+        \remarks For the Metal backend on macOS 11.0 and iOS 14.0 or later, \c serializedCache is handled just like for the Vulkan backend,
+        but the device-wide cache is an \c MTLBinaryArchive. Shaders can additionally be precompiled offline into a \c metallib via ShaderSourceType::BinaryFile or ShaderSourceType::BinaryBuffer.
         \see ComputePipelineDescriptor
         \see CreatePipelineState(const Blob&)
         */
         virtual PipelineState* CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache = nullptr) = 0;
 
+        /**
+        \brief Creates a new graphics pipeline state object (PSO) without blocking the calling thread while the PSO is compiled.
+        \param[in] pipelineStateDesc Specifies the graphics PSO descriptor. The descriptor itself is copied, but all objects it refers to must remain valid until the PSO is ready.
+        \param[in] flags Specifies optional creation flags. This can be a bitwise OR combination of the AsyncPipelineFlags entries. By default 0.
+        \return Pointer to the new PSO, which remains in a pending state until PipelineState::IsReady returns true.
+        \remarks The Vulkan, Direct3D 12, and Metal backends compile the PSO on the job system (see JobSystem::Async).
+        The OpenGL backend relies on \c GL_KHR_parallel_shader_compile if available. All other backends create the PSO synchronously, i.e. the PSO is ready immediately.
+        \remarks Binding a pending PSO either blocks until it is ready or skips all draw commands until another PSO is bound, depending on AsyncPipelineFlags::SkipDrawsWhilePending.
+        If the compilation fails, the exception is thrown by PipelineState::Wait or when the PSO is bound.
+        \see CreatePipelineState(const GraphicsPipelineDescriptor&, std::unique_ptr<Blob>*)
+        \see PipelineState::IsReady
+        \see PipelineState::Wait
+        */
+        virtual PipelineState* CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc, long flags = 0);
+
+        /**
+        \brief Creates a new compute pipeline state object (PSO) without blocking the calling thread while the PSO is compiled.
+        \remarks Binding a pending compute PSO either blocks until it is ready or skips all dispatch commands until another PSO is bound,
+        depending on AsyncPipelineFlags::SkipDrawsWhilePending.
+        \see CreatePipelineStateAsync(const GraphicsPipelineDescriptor&, long)
+        */
+        virtual PipelineState* CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc, long flags = 0);
+
         //! Releases the specified PipelineState object. After this call, the specified object must no longer be used.
         virtual void Release(PipelineState& pipelineState) = 0;
 
@@ -595,6 +830,83 @@ class LLGL_EXPORT RenderSystem : public Interface
         //! Releases the specified Fence object. After this call, the specified object must no longer be used.
         virtual void Release(Fence& fence) = 0;
 
+        /* ----- Memory ----- */
+
+        /**
+        \brief Queries the current GPU memory statistics of this render system.
+        \param[out] outStats Specifies the output statistics. The list of heaps is cleared if no statistics are available.
+        \return True if the render system provides memory statistics, otherwise false. By default false.
+        \remarks This is currently only supported by the Vulkan, Direct3D 12, and Metal backends. The Metal backend only reports the heaps it sub-allocates buffers and textures from.
+        Memory budgets are only reported if the \c VK_EXT_memory_budget extension (Vulkan) or \c IDXGIAdapter3 interface (Direct3D 12) is available.
+        \see RenderingProfiler::memoryStatistics
+        */
+        virtual bool QueryMemoryStatistics(MemoryStatistics& outStats);
+
+        /* ----- Residency ----- */
+
+        /**
+        \brief Sets the residency priority of the specified buffers and textures.
+        \param[in] resources Specifies the list of resources whose priority is to be set. Only buffers and textures are allowed.
+        \param[in] priority Specifies the new residency priority. All resources have priority ResidencyPriority::Normal by default.
+        \return True if the priorities have been set, otherwise false. By default false.
+        \remarks This is only supported if RenderingFeatures::hasResidencyPriorities is true, i.e. by the Direct3D 12 backend and the Vulkan backend with the \c VK_EXT_pageable_device_local_memory extension.
+        Resources that are sub-allocated from the same memory block (e.g. a \c VkDeviceMemory object or \c ID3D12Heap) share the highest priority of all their resources.
+        \remarks This can be used by a streaming system to keep the resources of the current view resident when the video memory is oversubscribed (see MemoryHeapStatistics::budget).
+        \see RenderingFeatures::hasResidencyPriorities
+        */
+        virtual bool SetResidencyPriority(const ArrayView<Resource*>& resources, ResidencyPriority priority);
+
+        /**
+        \brief Makes the specified buffers and textures resident in video memory again after they have been evicted.
+        \param[in] resources Specifies the list of resources that are to be made resident. Only buffers and textures are allowed.
+        \return True if the resources are resident, otherwise false. By default false.
+        \remarks This function blocks until the memory of the resources has been paged in. The content of the resources is preserved.
+        Resources that are not evicted are ignored.
+        \see RenderingFeatures::hasExplicitResidency
+        \see Evict
+        */
+        virtual bool MakeResident(const ArrayView<Resource*>& resources);
+
+        /**
+        \brief Evicts the specified buffers and textures from video memory.
+        \param[in] resources Specifies the list of resources that are to be evicted. Only buffers and textures are allowed.
+        \return True if the resources have been evicted, otherwise false. By default false.
+        \remarks Evicted resources must not be used by any command buffer that is submitted before they are made resident again with MakeResident.
+        The content of the resources is preserved. Resources that are sub-allocated from the same memory block are only evicted once all of them have been evicted.
+        \remarks This is only supported if RenderingFeatures::hasExplicitResidency is true.
+        \see RenderingFeatures::hasExplicitResidency
+        \see MemoryHeapStatistics::evictedSize
+        \see MakeResident
+        */
+        virtual bool Evict(const ArrayView<Resource*>& resources);
+
+        /* ----- Commands ----- */
+
+        /**
+        \brief Queries the CPU time statistics of all commands that have been executed since the previous query.
+        \param[out] outStats Specifies the output statistics. The list of histograms is cleared if no statistics are available.
+        \return True if the render system provides command statistics, otherwise false. By default false.
+        \remarks This is currently only supported by the Null backend if RendererConfigurationNull::benchmarkMode is enabled.
+        Since the Null backend does not submit any work to a driver, this can be used as a baseline to separate the CPU overhead of LLGL from the overhead of a graphics driver.
+        \see RendererConfigurationNull
+        */
+        virtual bool QueryCommandStatistics(CommandStatistics& outStats);
+
+        /* ----- Start-up ----- */
+
+        /**
+        \brief Queries the time that was spent in each start-up phase of this render system.
+        \param[out] outStats Specifies the output statistics. The list of phases is cleared if no statistics are available.
+        \return True if the render system was loaded with the RenderSystemFlags::StartupTiming flag, otherwise false.
+        \remarks The backends record the following phases in addition to module loading and render system allocation of the core library:
+        - Vulkan: Instance creation, physical device selection, logical device creation with extensions, default resources, and swap-chain creation.
+        - Direct3D 12: Factory creation, adapter enumeration, device creation, command queues and default resources, and swap-chain creation.
+        - Direct3D 11: Factory and device creation, and swap-chain creation.
+        - OpenGL: GL context creation, extension loading, and swap-chain creation. The first context is created with the first swap-chain.
+        \see RenderSystemFlags::StartupTiming
+        */
+        virtual bool QueryStartupStatistics(StartupStatistics& outStats);
+
     protected:
 
         //! Allocates the internal data.
@@ -606,6 +918,16 @@ class LLGL_EXPORT RenderSystem : public Interface
         //! Sets the rendering capabilities.
         void SetRenderingCaps(const RenderingCapabilities& caps);
 
+        //! Sets the report of the render system initialization.
+        void SetReport(const char* text, bool hasErrors = false);
+
+        /**
+        \brief Records a start-up phase of the backend between the two specified ticks (see Timer::Tick).
+        \param[in] name Specifies the name of the phase. This must be a string literal, since the name is not copied.
+        \remarks This is ignored if the render system was not loaded with RenderSystemFlags::StartupTiming.
+        */
+        void RecordStartupPhase(const char* name, std::uint64_t startTick, std::uint64_t endTick);
+
         //! Validates the specified buffer descriptor to be used for buffer creation.
         void AssertCreateBuffer(const BufferDescriptor& bufferDesc, std::uint64_t maxSize);
 
@@ -634,6 +956,11 @@ class LLGL_EXPORT RenderSystem : public Interface
             std::size_t                 rowStride   = 0
         );
 
+    private:
+
+        // Stores the start-up phases of the core library in this backend, or discards all phases if start-up timing is disabled.
+        void FinishStartupTiming(long flags, std::uint64_t loadStartTick, std::uint64_t moduleTick, std::uint64_t allocTick);
+
     private:
 
         struct Pimpl;
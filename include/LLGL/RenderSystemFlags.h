@@ -184,6 +184,115 @@ enum class CPUAccess
     the respective buffer must have been created with both the BufferFlags::MapReadAccess and the BufferFlags::MapWriteAccess flag.
     */
     ReadWrite,
+
+    /**
+    \brief CPU write access to a mapped resource without implicit synchronization with the GPU, where the previous content of the mapped range is discarded.
+    \remarks If this is used for RenderSystem::MapBuffer,
+    the respective buffer must have been created with the BufferFlags::MapWriteAccess flag.
+    This is meant for ring buffers, whose mapped ranges are not in use by the GPU when they are written by the CPU.
+    \note For OpenGL, the mapped range is guarded by a fence that is submitted with the next command buffer submission or swap-chain presentation,
+    so mapping the range again only waits if it overlaps with a range that is still in flight.
+    For Direct3D 11, this maps to \c D3D11_MAP_WRITE_NO_OVERWRITE. All other rendering APIs treat this like CPUAccess::WriteOnly.
+    */
+    WriteUnsynchronized,
+};
+
+/**
+\brief Residency priorities of GPU resources.
+\remarks When the video memory is oversubscribed, the driver pages out resources with lower priority first.
+\see RenderSystem::SetResidencyPriority
+*/
+enum class ResidencyPriority
+{
+    Minimum,    //!< Lowest priority, e.g. for resources that are only used occasionally.
+    Low,        //!< Low priority, e.g. for streamed resources that are not visible.
+    Normal,     //!< Default priority of all resources.
+    High,       //!< High priority, e.g. for render targets and resources that are used every frame.
+    Maximum,    //!< Highest priority, i.e. the resource is paged out last.
+};
+
+/**
+\brief Validation tiers of the debug layer.
+\remarks Each tier includes all validations of the previous tiers.
+Lower tiers skip the more expensive validations in the hot paths of the debug layer, e.g. for QA builds that keep the debug layer enabled.
+\see RenderSystemDescriptor::debugValidation
+*/
+enum class DebugValidation
+{
+    /**
+    \brief Only validates the structure of each call.
+    \remarks This includes invalid arguments, command buffer states (e.g. recording and render passes), limits, and unsupported features.
+    */
+    Structural,
+
+    /**
+    \brief Also validates the resource bindings.
+    \remarks This includes the binding flags of buffers and textures, the bound vertex and index buffers against the vertex layout of the pipeline state,
+    vertex and index buffer limits for draw commands, and dynamic offsets of resource heaps.
+    */
+    Bindings,
+
+    /**
+    \brief Also tracks the resources of each command buffer for hazards. This is the default tier.
+    \remarks This includes buffers that are still mapped to CPU memory when a command buffer that uses them is submitted.
+    */
+    Hazards,
+};
+
+
+/* ----- Flags ----- */
+
+/**
+\brief Render system creation flags.
+\see RenderSystemDescriptor::flags
+*/
+struct RenderSystemFlags
+{
+    enum
+    {
+        /**
+        \brief Buffer and texture uploads are executed on a dedicated transfer queue if the hardware provides one.
+        \remarks With this flag, RenderSystem::CreateBuffer, RenderSystem::CreateTexture, RenderSystem::WriteBuffer, and RenderSystem::WriteTexture
+        record their copy commands for a copy engine that runs asynchronously to the graphics queue, so content streaming can overlap with rendering.
+        Synchronization and resource ownership between the two queues are handled internally,
+        i.e. uploaded resources can be used by any command buffer that is submitted afterwards.
+        \note Only supported with: Vulkan (transfer-only queue family), Direct3D 12 (copy command queue).
+        */
+        DedicatedTransferQueue = (1 << 0),
+
+        /**
+        \brief The render system is initialized without any window system, e.g. for server-side rendering on display-less nodes.
+        \remarks With this flag, no swap-chain can be created and all rendering must go into render targets (see RenderSystem::CreateRenderTarget).
+        The results can be read back with RenderSystem::ReadTexture or CommandBuffer::CopyBufferFromTexture.
+        Vulkan does not enable any surface extensions (such as \c VK_KHR_surface) and OpenGL creates its contexts with EGL
+        on the device platform (\c EGL_EXT_platform_device) or the surfaceless platform (\c EGL_MESA_platform_surfaceless).
+        \note Only supported with: Vulkan, OpenGL (on GNU/Linux when LLGL is built with \c LLGL_GL_ENABLE_EGL).
+        \see RendererConfigurationVulkan::deviceIndex
+        \see RendererConfigurationOpenGL::deviceIndex
+        */
+        Headless = (1 << 1),
+
+        /**
+        \brief An additional command queue is created for compute work that runs asynchronously to the graphics queue if the hardware provides one.
+        \remarks With this flag, RenderSystem::GetComputeQueue returns a command queue that only accepts command buffers
+        that were created with the CommandBufferFlags::ComputeQueue flag. Work between the two queues must be synchronized with fences,
+        i.e. with CommandQueue::Submit(Fence&) on one queue and CommandQueue::SubmitWait on the other queue.
+        Resources can be accessed by both queues without any explicit ownership transfer.
+        \remarks For Vulkan, this takes precedence over DedicatedTransferQueue, since resources that are shared between the graphics and compute queue families
+        are uploaded on the graphics queue.
+        \note Only supported with: Vulkan (compute-only queue family), Direct3D 12 (compute command queue).
+        \see RenderSystem::GetComputeQueue
+        */
+        AsyncComputeQueue = (1 << 2),
+
+        /**
+        \brief The render system records the time spent in each start-up phase, e.g. module loading, device creation, and swap-chain creation.
+        \remarks The phases can be queried with RenderSystem::QueryStartupStatistics. Each phase is attributed to either the core library or the backend,
+        so the start-up of different backends can be compared. Recording a phase only queries the high resolution timer twice (see Timer::Tick).
+        \see RenderSystem::QueryStartupStatistics
+        */
+        StartupTiming = (1 << 3),
+    };
 };
 
 
@@ -294,6 +403,7 @@ struct RenderSystemDescriptor
     \endcode
     \see rendererConfigSize
     \see RendererConfigurationVulkan
+    \see RendererConfigurationD3D12
     \see RendererConfigurationOpenGL
     \see RendererConfigurationOpenGLES3
     */
@@ -306,6 +416,53 @@ struct RenderSystemDescriptor
     */
     std::size_t     rendererConfigSize  = 0;
 
+    /**
+    \brief Render system creation flags. This can be a bitwise OR combination of the entries of the RenderSystemFlags enumeration. By default 0.
+    \see RenderSystemFlags
+    */
+    long            flags               = 0;
+
+    /**
+    \brief Specifies the validation tier of the debug layer. By default DebugValidation::Hazards, i.e. full validation.
+    \remarks This is only used if a RenderingDebugger is passed to RenderSystem::Load.
+    \see DebugValidation
+    */
+    DebugValidation debugValidation     = DebugValidation::Hazards;
+
+    /**
+    \brief Optional filename of a capture file. By default null.
+    \remarks If this is not null, all calls to the render system, its command queue, command buffers, and swap-chains
+    are written into this file, including the content of all buffers, textures, and shaders.
+    The capture can then be replayed with the CaptureReplay class, e.g. to compare the CPU time of two builds or two renderers for the same command stream.
+    \remarks The capture layer is the innermost layer, i.e. when a profiler or debugger is passed to RenderSystem::Load as well, the debug layer wraps the capture layer.
+    \note Capturing adds a significant overhead to each call and is meant for offline performance testing only.
+    \see CaptureReplay
+    */
+    const char*     captureFilename     = nullptr;
+
+    /**
+    \brief Specifies the zero-based index of the video adapter the render system is created on. By default -1.
+    \remarks The index refers to the list returned by RenderSystem::QueryVideoAdapters for the same module.
+    If this is negative, the render system selects the adapter by itself (usually the primary or most capable GPU).
+    Loading one render system per adapter index allows to pin each render system to a separate GPU.
+    \remarks For OpenGL, the adapter can only be selected for headless render systems (see RenderSystemFlags::Headless), since all other contexts are bound to the display.
+    \throws std::runtime_error If the index is out of range, RenderSystem::Load throws an exception.
+    \see RenderSystem::QueryVideoAdapters
+    */
+    int             adapterIndex        = -1;
+
+    /**
+    \brief Optional directory for the on-disk cache of compiled shader bytecode. By default null.
+    \remarks If this is not null, the bytecode of all shaders that are compiled from high-level source code is stored in this directory
+    under a hash of the source code, macro definitions, entry point, profile, and compile flags, and it is reused when the same shader is created again,
+    e.g. when the application is launched the next time. The directory is created if it does not exist, but its parent directory must exist.
+    \remarks The shader reflection (see Shader::Reflect) is restored from the cached bytecode, and the compiler warnings of the first compilation are cached alongside.
+    Shaders that fail to compile are never cached. The cache is never cleared by LLGL, so outdated entries must be deleted by the application.
+    \note Only supported with: Direct3D 11, Direct3D 12.
+    \see RenderSystem::CreateShaders
+    */
+    const char*     shaderCacheDirectory = nullptr;
+
     #ifdef LLGL_OS_ANDROID
 
     /**
@@ -479,6 +636,16 @@ struct RenderingFeatures
     */
     bool hasComputeShaders              = false;
 
+    /**
+    \brief Specifies whether mesh and task shaders are supported.
+    \note Only supported with: Direct3D 12 (mesh shader tier 1), Vulkan (VK_EXT_mesh_shader), Metal (Apple GPU family 7 or Mac family 2).
+    \see ShaderType::Task
+    \see ShaderType::Mesh
+    \see CommandBuffer::DrawMeshTasks
+    \see CommandBuffer::DrawMeshTasksIndirect
+    */
+    bool hasMeshShaders                 = false;
+
     /**
     \brief Specifies whether hardware instancing is supported.
     \see CommandBuffer::DrawInstanced(std::uint32_t, std::uint32_t, std::uint32_t)
@@ -501,6 +668,20 @@ struct RenderingFeatures
     */
     bool hasIndirectDrawing             = false;
 
+    /**
+    \brief Specifies whether indirect draw commands can take the number of draw commands from a GPU buffer natively.
+    \remarks If this is false, the number of draw commands is read back from the count buffer by the CPU (except for Vulkan).
+    \see CommandBuffer::DrawIndirectCount
+    \see CommandBuffer::DrawIndexedIndirectCount
+    */
+    bool hasIndirectCountDrawing        = false;
+
+    /**
+    \brief Specifies whether indirect draw commands can be encoded on the GPU into a buffer with the MiscFlags::IndirectCommands flag.
+    \see MiscFlags::IndirectCommands
+    */
+    bool hasIndirectCommandBuffers      = false;
+
     /**
     \brief Specifies whether multiple viewports, depth-ranges, and scissors at once are supported.
     \see RenderingLimits::maxViewports
@@ -513,6 +694,14 @@ struct RenderingFeatures
     */
     bool hasConservativeRasterization   = false;
 
+    /**
+    \brief Specifies whether variable rate shading per draw command is supported.
+    \remarks Shading-rate images are only supported if RenderingLimits::shadingRateImageTileSize is non-zero.
+    \note Only supported with: Direct3D 12 (variable shading rate tier 1), Vulkan (VK_KHR_fragment_shading_rate).
+    \see CommandBuffer::SetShadingRate
+    */
+    bool hasVariableRateShading         = false;
+
     /**
     \brief Specifies whether stream-output is supported.
     \see VertexShaderAttributes::outputAttribs
@@ -541,6 +730,64 @@ struct RenderingFeatures
     \see CommandBuffer:BeginRenderCondition
     */
     bool hasRenderCondition             = false;
+
+    /**
+    \brief Specifies whether deferred command buffers are recorded into native command lists by the driver.
+    \remarks If this is false, command buffers can still be encoded on multiple threads, but the runtime emulates the command lists,
+    which is less efficient (Direct3D 11 only). This is always false for OpenGL, where all command buffers are encoded on the immediate context.
+    \see CommandBufferFlags::ImmediateSubmit
+    */
+    bool hasNativeCommandLists          = false;
+
+    /**
+    \brief Specifies whether sparse textures are supported, i.e. textures whose memory is committed in tiles.
+    \see MiscFlags::Sparse
+    \see RenderSystem::CommitTextureTiles
+    */
+    bool hasSparseTextures              = false;
+
+    /**
+    \brief Specifies whether bindless resource heaps are supported, i.e. pipeline layouts with a binding of type BindingFlags::Bindless.
+    \remarks For Vulkan, this requires the \c VK_EXT_descriptor_indexing extension.
+    \see BindingFlags::Bindless
+    */
+    bool hasDescriptorIndexing          = false;
+
+    /**
+    \brief Specifies whether fragment shaders can read the content of the current pixel from the color attachments of previous subpasses without leaving the render pass.
+    \remarks For Vulkan, this is always supported with subpass input attachments.
+    For Metal, this requires programmable blending (i.e. fragment shader inputs with the \c [[color(n)]] attribute) which is only available on Apple GPUs.
+    For OpenGL, this requires the \c GL_EXT_shader_framebuffer_fetch extension (i.e. \c inout fragment shader outputs).
+    If this is false, CommandBuffer::NextSubpass falls back to split passes, i.e. the input attachments of the next subpass are unbound from the output merger
+    and must be bound as textures to be read by the fragment shader.
+    \see SubpassDescriptor::inputAttachments
+    \see CommandBuffer::NextSubpass
+    */
+    bool hasFramebufferFetch            = false;
+
+    /**
+    \brief Specifies whether the memory of buffers and textures can be shared with other rendering APIs or processes.
+    \remarks For Vulkan, this requires the \c VK_KHR_external_memory_fd extension (or \c VK_KHR_external_memory_win32 on Windows).
+    \see MiscFlags::Shared
+    \see RenderSystem::ExportResource
+    */
+    bool hasExternalMemory              = false;
+
+    /**
+    \brief Specifies whether residency priorities of buffers and textures are supported.
+    \remarks For Vulkan, this requires the \c VK_EXT_pageable_device_local_memory extension.
+    For Direct3D 12, this requires the \c ID3D12Device1 interface.
+    \see RenderSystem::SetResidencyPriority
+    */
+    bool hasResidencyPriorities         = false;
+
+    /**
+    \brief Specifies whether buffers and textures can be explicitly made resident and evicted from video memory.
+    \remarks This is only supported by the Direct3D 12 backend.
+    \see RenderSystem::MakeResident
+    \see RenderSystem::Evict
+    */
+    bool hasExplicitResidency           = false;
 };
 
 /**
@@ -617,6 +864,13 @@ struct RenderingLimits
     //! Specifies the maximum work group size in a compute shader.
     std::uint32_t   maxComputeShaderWorkGroupSize[3]    = { 0, 0, 0 };
 
+    /**
+    \brief Specifies the maximum number of task (or mesh) workgroups that can be launched with a single draw command.
+    \see CommandBuffer::DrawMeshTasks
+    \see RenderingFeatures::hasMeshShaders
+    */
+    std::uint32_t   maxMeshShaderWorkGroups[3]          = { 0, 0, 0 };
+
     /**
     \brief Specifies the maximum number of viewports and scissor rectangles the render system supports. Upper limit is specified by \c LLGL_MAX_NUM_VIEWPORTS_AND_SCISSORS.
     \see CommandBuffer::SetViewports
@@ -636,6 +890,14 @@ struct RenderingLimits
     */
     std::uint32_t   maxViewportSize[2]                  = { 0, 0 };
 
+    /**
+    \brief Specifies the width and height (in pixels) of the screen tiles that are covered by a single texel of a shading-rate image.
+    \remarks If this is 0, shading-rate images are not supported.
+    \see RenderTargetDescriptor::shadingRateImage
+    \see RenderingFeatures::hasVariableRateShading
+    */
+    std::uint32_t   shadingRateImageTileSize            = 0;
+
     /**
     \brief Specifies the maximum size (in bytes) that is supported for hardware buffers (vertex, index, storage buffers).
     \remarks Constant buffers are a special case for which \c maxConstantBufferSize can be used.
@@ -731,6 +993,176 @@ struct RenderingCapabilities
     RenderingLimits                 limits;
 };
 
+/**
+\brief Memory statistics of a single GPU memory heap.
+\see MemoryStatistics::heaps
+*/
+struct MemoryHeapStatistics
+{
+    //! Specifies whether this heap is local to the GPU device (i.e. video memory) or resides in system memory.
+    bool            deviceLocal         = false;
+
+    //! Number of bytes the render system has allocated from this heap.
+    std::uint64_t   allocatedSize       = 0;
+
+    //! Number of bytes of the allocated memory that are currently occupied by resources. This is less than or equal to \c allocatedSize.
+    std::uint64_t   usedSize            = 0;
+
+    //! Number of individual allocations (e.g. \c VkDeviceMemory objects) the render system has made from this heap.
+    std::uint32_t   numAllocations      = 0;
+
+    //! Number of resource blocks that are sub-allocated within the allocations of this heap.
+    std::uint32_t   numBlocks           = 0;
+
+    /**
+    \brief Ratio (in the range [0, 1]) of unused allocated memory that is scattered in between occupied blocks.
+    \remarks A value of 0 means that all unused memory is contiguous, a value close to 1 means that the unused memory is highly fragmented.
+    */
+    float           fragmentation       = 0.0f;
+
+    /**
+    \brief Estimated number of bytes the application can use from this heap without degrading performance.
+    \remarks This is only available with the \c VK_EXT_memory_budget extension (Vulkan) or \c IDXGIAdapter3 (Direct3D 12). Otherwise zero.
+    */
+    std::uint64_t   budget              = 0;
+
+    /**
+    \brief Number of bytes the current process uses from this heap, as reported by the operating system or driver.
+    \remarks This is only available with the \c VK_EXT_memory_budget extension (Vulkan) or \c IDXGIAdapter3 (Direct3D 12). Otherwise zero.
+    */
+    std::uint64_t   usage               = 0;
+
+    /**
+    \brief Number of bytes of the allocated memory that have been evicted with RenderSystem::Evict and not made resident again.
+    \remarks Evicted memory still counts to \c allocatedSize but not to the \c usage reported by the operating system.
+    This is only available with the Direct3D 12 backend. Otherwise zero.
+    */
+    std::uint64_t   evictedSize         = 0;
+};
+
+/**
+\brief GPU memory statistics of the render system.
+\see RenderSystem::QueryMemoryStatistics
+*/
+struct MemoryStatistics
+{
+    //! List of all memory heaps of the GPU device, e.g. video memory and shared system memory.
+    std::vector<MemoryHeapStatistics>   heaps;
+
+    /**
+    \brief Highest number of bytes that have been in flight at the same time within the staging ring of a single command buffer.
+    \remarks This can be used to size the chunks of the staging rings for CommandBuffer::UpdateBuffer.
+    This is only available with the Direct3D 12 and Metal backends. Otherwise zero.
+    */
+    std::uint64_t                       stagingHighWaterMark    = 0;
+};
+
+/**
+\brief Histogram of the CPU time that was spent to execute a single type of command.
+\see CommandStatistics::commands
+*/
+struct CommandTimeHistogram
+{
+    //! Number of histogram buckets.
+    static constexpr std::uint32_t numBuckets = 16;
+
+    //! Upper bound (in nanoseconds) of the first histogram bucket. The upper bound of each following bucket is twice as large as the previous one.
+    static constexpr std::uint64_t firstBucketTime = 32;
+
+    //! Name of the command, e.g. "Draw" or "SetPipelineState".
+    const char*     command                 = "";
+
+    //! Number of commands that have been executed.
+    std::uint64_t   numCommands             = 0;
+
+    //! Total time (in nanoseconds) to execute all commands.
+    std::uint64_t   totalTime               = 0;
+
+    //! Shortest time (in nanoseconds) to execute a single command.
+    std::uint64_t   minTime                 = 0;
+
+    //! Longest time (in nanoseconds) to execute a single command.
+    std::uint64_t   maxTime                 = 0;
+
+    /**
+    \brief Number of commands per time range.
+    \remarks The first bucket counts all commands that took less than \c firstBucketTime nanoseconds,
+    the bucket at index \c i counts all commands that took less than <code>firstBucketTime * 2^i</code> but at least <code>firstBucketTime * 2^(i-1)</code> nanoseconds,
+    and the last bucket also counts all commands that took even longer.
+    */
+    std::uint64_t   buckets[numBuckets]     = {};
+};
+
+/**
+\brief CPU statistics of the commands that have been executed by the render system.
+\see RenderSystem::QueryCommandStatistics
+*/
+struct CommandStatistics
+{
+    //! List of time histograms for each type of command that has been executed at least once.
+    std::vector<CommandTimeHistogram> commands;
+};
+
+/**
+\brief Time that was spent in a single start-up phase of a render system.
+\see StartupStatistics::phases
+*/
+struct StartupPhase
+{
+    //! Name of the start-up phase, e.g. "module loading" or "device creation".
+    const char*     name        = "";
+
+    /**
+    \brief Name of the module that recorded this phase.
+    \remarks This is "LLGL" for the phases of the core library, such as loading the render system module,
+    and the name of the render system for the phases of the backend (see RenderSystem::GetName).
+    */
+    const char*     source      = "";
+
+    //! Start time (in nanoseconds) relative to the beginning of RenderSystem::Load.
+    std::uint64_t   startTime   = 0;
+
+    //! Time (in nanoseconds) that was spent in this phase.
+    std::uint64_t   duration    = 0;
+};
+
+/**
+\brief Time statistics of the start-up of a render system.
+\see RenderSystem::QueryStartupStatistics
+\see RenderSystemFlags::StartupTiming
+*/
+struct StartupStatistics
+{
+    /**
+    \brief List of all start-up phases ordered by their start time.
+    \remarks The backend phases of the render system creation are nested in the "render system allocation" phase of the core library.
+    Phases that are recorded after RenderSystem::Load, such as swap-chain creation, are appended when they occur.
+    */
+    std::vector<StartupPhase>   phases;
+
+    //! Total time (in nanoseconds) that was spent in RenderSystem::Load.
+    std::uint64_t               totalTime   = 0;
+};
+
+/**
+\brief Memory layout of the data of a completed readback.
+\see RenderSystem::MapReadback
+*/
+struct ReadbackLayout
+{
+    //! Size (in bytes) of the mapped readback data.
+    std::uint64_t   size        = 0;
+
+    /**
+    \brief Size (in bytes) of each row of texels, or 0 for buffer readbacks.
+    \remarks This can be larger than the size of the texels in a row, since some backends require an aligned row pitch, e.g. 256 bytes with Direct3D 12.
+    */
+    std::uint32_t   rowStride   = 0;
+
+    //! Size (in bytes) of each array layer or depth slice, or 0 for buffer readbacks.
+    std::uint32_t   layerStride = 0;
+};
+
 
 /* ----- Functions ----- */
 
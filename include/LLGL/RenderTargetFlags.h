@@ -127,6 +127,21 @@ struct AttachmentDescriptor
     \see TextureDescriptor::arrayLayers
     */
     std::uint32_t   arrayLayer  = 0;
+
+    /**
+    \brief Specifies whether the internal buffer of this attachment is transient. By default false.
+    \remarks A transient attachment only holds its content during a single render pass, i.e. its content is neither loaded at the beginning nor stored at the end of a render pass.
+    This allows tile-based GPUs to keep the attachment entirely in on-chip memory, so it consumes neither video memory nor memory bandwidth.
+    \remarks This only applies to the buffers that are created internally by the render target, i.e. the depth-stencil buffer if \c texture is null
+    and the multi-sampled color buffer of a color attachment if multi-sampling is enabled without RenderTargetDescriptor::customMultiSampling.
+    In the latter case, the multi-sampled content is still resolved into the color attachment texture. Attachments with a texture that is written to directly are not affected.
+    \remarks Depending on the backend, a transient attachment is mapped as follows:
+    - Vulkan: Image with \c VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT usage that is bound to lazily allocated memory if available.
+    - Metal: Texture with \c MTLStorageModeMemoryless on Apple GPUs.
+    - OpenGL: Renderbuffer whose content is invalidated at the end of each render pass (if \c GL_ARB_invalidate_subdata or OpenGLES 3.0 is available).
+    - For all other backends, this attribute is ignored.
+    */
+    bool            transient   = false;
 };
 
 /**
@@ -224,6 +239,20 @@ struct RenderTargetDescriptor
     AttachmentDescriptor                depthStencilAttachment;
 
     #endif
+
+    /**
+    \brief Optional shading-rate image that specifies the fragment shading rate per screen tile. By default null.
+    \remarks If this is specified, the texture must be a 2D texture with format Format::R8UInt and it must have been created with the binding flag BindFlags::Sampled.
+    Each texel covers a screen tile of RenderingLimits::shadingRateImageTileSize by RenderingLimits::shadingRateImageTileSize pixels,
+    and contains the shading rate encoded in the same way as the ShadingRate enumeration describes, i.e. <code>(log2(width) << 2) | log2(height)</code>.
+    The resolution of the texture must therefore be at least <code>ceil(resolution / shadingRateImageTileSize)</code>.
+    \remarks The texture must not be bound as another resource while the render target is used in a render pass.
+    If the dynamic shading rate is also set with CommandBuffer::SetShadingRate, the coarser of both rates is used.
+    \note Only supported with: Direct3D 12 (variable shading rate tier 2).
+    \see RenderingLimits::shadingRateImageTileSize
+    \see CommandBuffer::SetShadingRate
+    */
+    Texture*                            shadingRateImage    = nullptr;
 };
 
 
@@ -0,0 +1,207 @@
+/*
+ * RenderTargetPool.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_RENDER_TARGET_POOL_H
+#define LLGL_RENDER_TARGET_POOL_H
+
+
+#include <LLGL/NonCopyable.h>
+#include <LLGL/Format.h>
+#include <LLGL/Types.h>
+#include <LLGL/ResourceFlags.h>
+#include <LLGL/PipelineStateFlags.h>
+#include <LLGL/StaticLimits.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class RenderSystem;
+class RenderTarget;
+class RenderPass;
+class Texture;
+
+/* ----- Structures ----- */
+
+/**
+\brief Render target pool descriptor structure.
+\see RenderTargetPool::RenderTargetPool
+*/
+struct RenderTargetPoolDescriptor
+{
+    /**
+    \brief Maximum resolution of the pooled render targets. By default (0, 0).
+    \remarks If this is non-zero, all render targets whose requested resolution fits into this extent are allocated with this maximum resolution,
+    and the content is rendered into a sub-viewport of the requested size (see PooledRenderTarget::viewport).
+    Changing the internal resolution, e.g. by a dynamic resolution controller, then reuses the same render target and attachments
+    without any allocation or object creation at all.
+    \remarks If this is zero, the attachments are allocated with the exact requested resolution
+    and recycled for subsequent requests with the same formats, resolution, and number of samples.
+    */
+    Extent2D        maxResolution;
+
+    /**
+    \brief Maximum number of unused render targets that are kept alive for reuse. By default 8.
+    \remarks If this limit is exceeded, the least recently released render targets are destroyed together with their attachments.
+    */
+    std::uint32_t   maxUnusedRenderTargets  = 8;
+};
+
+/**
+\brief Descriptor structure for a render target that is acquired from a render target pool.
+\remarks All members of this structure except \c resolution form the key by which the pooled render targets are recycled.
+\see RenderTargetPool::Acquire
+*/
+struct PooledRenderTargetDescriptor
+{
+    //! Requested resolution of the render target. This must not be zero.
+    Extent2D            resolution;
+
+    //! Number of samples of all attachments. If this is greater than 1, the attachments are created as multi-sampled textures. By default 1.
+    std::uint32_t       samples                 = 1;
+
+    //! Formats of the color attachments. The first color attachment with Format::Undefined terminates the list. By default all undefined.
+    Format              colorFormats[LLGL_MAX_NUM_COLOR_ATTACHMENTS]   = {};
+
+    //! Format of the depth-stencil attachment or Format::Undefined to disable it. By default Format::Undefined.
+    Format              depthStencilFormat      = Format::Undefined;
+
+    /**
+    \brief Additional binding flags for the attachment textures. By default BindFlags::Sampled.
+    \remarks BindFlags::ColorAttachment and BindFlags::DepthStencilAttachment are always included for the respective attachments.
+    */
+    long                bindFlags               = BindFlags::Sampled;
+
+    //! Optional render pass that is passed to the render target. By default null.
+    const RenderPass*   renderPass              = nullptr;
+};
+
+/**
+\brief Render target with its attachments that has been acquired from a render target pool.
+\see RenderTargetPool::Acquire
+*/
+struct PooledRenderTarget
+{
+    //! Render target object. This is never null for an acquired render target.
+    RenderTarget*   renderTarget                                    = nullptr;
+
+    //! Color attachment textures. Unused entries are null.
+    Texture*        colorTextures[LLGL_MAX_NUM_COLOR_ATTACHMENTS]   = {};
+
+    //! Depth-stencil attachment texture or null if no depth-stencil attachment has been requested.
+    Texture*        depthStencilTexture                             = nullptr;
+
+    //! Resolution that has been requested with PooledRenderTargetDescriptor::resolution.
+    Extent2D        resolution;
+
+    /**
+    \brief Resolution the attachments have actually been allocated with.
+    \remarks This is greater than \c resolution if the render target has been allocated with RenderTargetPoolDescriptor::maxResolution.
+    In that case, texture coordinates to sample the attachments must be scaled by <code>resolution / allocatedResolution</code>.
+    */
+    Extent2D        allocatedResolution;
+
+    //! Viewport that covers the requested resolution in the upper-left corner of the attachments.
+    Viewport        viewport;
+
+    //! Scissor rectangle that covers the requested resolution in the upper-left corner of the attachments.
+    Scissor         scissor;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Pool of render targets and their attachment textures that are recycled across resolution changes.
+\remarks Releasing and re-creating render targets for every resolution change causes allocation spikes
+and, on some backends, the re-creation of framebuffers and render passes.
+This pool keeps released render targets alive and hands them out again for matching requests.
+\remarks Here is an example how to render a scene with dynamic resolution scaling:
+\code
+LLGL::RenderTargetPoolDescriptor myPoolDesc;
+myPoolDesc.maxResolution = mySwapChain->GetResolution();
+LLGL::RenderTargetPool myPool{ *myRenderer, myPoolDesc };
+
+// Per frame: acquire scene render target with the current internal resolution
+LLGL::PooledRenderTargetDescriptor mySceneDesc;
+mySceneDesc.resolution          = myInternalResolution;
+mySceneDesc.colorFormats[0]     = LLGL::Format::RGBA16Float;
+mySceneDesc.depthStencilFormat  = LLGL::Format::D32Float;
+
+const LLGL::PooledRenderTarget* myScene = myPool.Acquire(mySceneDesc);
+myCmdBuffer->BeginRenderPass(*myScene->renderTarget);
+myCmdBuffer->SetViewport(myScene->viewport);
+DrawScene(*myCmdBuffer);
+myCmdBuffer->EndRenderPass();
+UpscaleToSwapChain(*myCmdBuffer, *myScene->colorTextures[0], myScene->resolution, myScene->allocatedResolution);
+myPool.Release(myScene);
+\endcode
+\note This class is not thread-safe.
+*/
+class LLGL_EXPORT RenderTargetPool : public NonCopyable
+{
+
+    public:
+
+        /**
+        \brief Initializes the render target pool for the specified render system. No render targets are allocated until the first call to Acquire.
+        \remarks The render system must outlive this pool. All render targets and attachments are released with its destruction.
+        */
+        RenderTargetPool(RenderSystem& renderSystem, const RenderTargetPoolDescriptor& poolDesc = {});
+
+        //! Releases all render targets and their attachments.
+        ~RenderTargetPool();
+
+        /**
+        \brief Acquires a render target for the specified descriptor.
+        \remarks This returns the most recently released render target with the same key if there is one.
+        Otherwise, a new render target and its attachments are created.
+        The content of the attachments is undefined after this call.
+        \return Pointer to the acquired render target. This remains valid until it is passed to Release.
+        Returns null if the descriptor has a zero resolution or no attachments at all.
+        */
+        const PooledRenderTarget* Acquire(const PooledRenderTargetDescriptor& renderTargetDesc);
+
+        /**
+        \brief Returns the specified render target to the pool, so it can be acquired again.
+        \remarks The render target can be released right after the commands that use it have been encoded,
+        since a subsequent user of the same render target encodes its commands afterwards.
+        If this exceeds RenderTargetPoolDescriptor::maxUnusedRenderTargets, the least recently released render target is destroyed.
+        In that case, the command buffers that use the destroyed render target must have been completed.
+        */
+        void Release(const PooledRenderTarget* renderTarget);
+
+        /**
+        \brief Destroys all unused render targets and their attachments.
+        \remarks The command buffers that use any of these render targets must have been completed.
+        */
+        void Clear();
+
+        //! Returns the number of render targets that are currently held by this pool, including the unused ones.
+        std::uint32_t GetNumRenderTargets() const;
+
+        //! Returns the number of render targets that have been created by this pool so far, i.e. the number of pool misses.
+        std::uint64_t GetNumCreatedRenderTargets() const;
+
+    private:
+
+        struct Pimpl;
+        Pimpl* pimpl_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -17,6 +17,9 @@ namespace LLGL
 {
 
 
+class Blob;
+
+
 /* ----- Enumerations ----- */
 
 /**
@@ -91,12 +94,83 @@ struct RendererConfigurationVulkan
 
     /**
     \brief Specifies whether fragmentation of the device memory blocks shall be kept low. By default false.
-    \remarks If this is true, each buffer and image allocation first tries to find a reusable device memory block
-    within a single VkDeviceMemory chunk (which might be potentially slower).
-    Whenever a VkDeviceMemory chunk is full, the memory manager tries to reduce fragmentation anyways.
-    \todo Remove this as soon as Vulkan memory manage has been improved.
+    \remarks If this is true, each buffer and image allocation first tries to find a free device memory block of approximately the same size
+    within a single VkDeviceMemory chunk (which might be potentially slower), and host-visible staging buffers of CPU accessible buffers
+    are incrementally relocated into other chunks after each swap-chain presentation, so that sparsely used chunks can be released.
+    Otherwise, device memory blocks are sub-allocated in constant time by a two-level segregated fit allocator.
     */
     bool                        reduceDeviceMemoryFragmentation = false;
+
+    /**
+    \brief Index of the physical device to use, in the order returned by \c vkEnumeratePhysicalDevices. By default -1.
+    \remarks If this is -1, the first suitable physical device is used.
+    This can be used to distribute multiple render systems over multiple GPUs, e.g. with RenderSystemFlags::Headless.
+    \remarks RenderSystemDescriptor::adapterIndex takes precedence over this member if it is non-negative.
+    \see RenderSystemFlags::Headless
+    \see RenderSystemDescriptor::adapterIndex
+    */
+    int                         deviceIndex                     = -1;
+
+    /**
+    \brief Specifies whether render targets shall be rendered with the \c VK_KHR_dynamic_rendering extension if it is supported. By default false.
+    \remarks If this is true, render targets that are created without a render pass (see RenderTargetDescriptor::renderPass)
+    have no native render pass and framebuffer objects, so creating and recreating render targets (e.g. on resize) is cheaper.
+    Graphics pipelines that are used with such render targets must be created with their render pass (see RenderTarget::GetRenderPass),
+    since pipelines for native render passes are not compatible with dynamic rendering.
+    Swap-chains and render targets that are created with a render pass always use native render pass objects.
+    */
+    bool                        dynamicRendering                = false;
+
+    /**
+    \brief Optional filename of an adapter profile that is used to skip the enumeration of layers and extensions at start-up. By default null.
+    \remarks The adapter profile stores the instance layers and extensions, and the device extensions of the physical device that was selected in a previous run.
+    If the file exists and the physical device still matches (same vendor, device, driver version, and pipeline cache UUID), these enumerations are skipped.
+    Otherwise, they are enumerated as usual and the file is rewritten after the physical device has been selected.
+    If the instance cannot be created with the cached layers and extensions, e.g. because a layer has been uninstalled, they are enumerated again.
+    \see RenderSystem::GetReport
+    */
+    const char*                 adapterProfileFilename          = nullptr;
+};
+
+/**
+\brief Structure for a Direct3D 12 renderer specific configuration.
+\remarks Example to persist and restore a pipeline library:
+\code
+// Restore pipeline library from a previous run
+auto myLibrary = LLGL::Blob::CreateFromFile("MyPSOLibrary.bin");
+
+LLGL::RendererConfigurationD3D12 config;
+config.pipelineLibraryEnabled   = true;
+config.pipelineLibrary          = myLibrary.get();
+
+// Create all PSOs during warm-up and keep the Blob of the last one
+std::unique_ptr<LLGL::Blob> myCache;
+for (const auto& myPipelineDesc : myPipelineDescs)
+    myRenderer->CreatePipelineState(myPipelineDesc, &myCache);
+
+// Store entire pipeline library to file
+std::ofstream myFile{ "MyPSOLibrary.bin", std::ios::out | std::ios::binary };
+myFile.write(reinterpret_cast<const char*>(myCache->GetData()), static_cast<std::streamsize>(myCache->GetSize()));
+\endcode
+*/
+struct RendererConfigurationD3D12
+{
+    /**
+    \brief Specifies whether all graphics and compute PSOs are stored in a device-wide pipeline library (\c ID3D12PipelineLibrary). By default false.
+    \remarks If enabled, PSOs are looked up in the library by a hash of their pipeline state before they are compiled,
+    and the \c serializedCache output of RenderSystem::CreatePipelineState contains the entire pipeline library instead of a single PSO.
+    Such a Blob can only be restored via the \c pipelineLibrary member and not with RenderSystem::CreatePipelineState(const Blob&).
+    This is ignored if the device does not support pipeline libraries (requires \c ID3D12Device1).
+    */
+    bool        pipelineLibraryEnabled  = false;
+
+    /**
+    \brief Optional serialized pipeline library from a previous run. By default null.
+    \remarks This Blob is copied by the render system and must only remain valid during its creation.
+    If the library was created on a different adapter or driver version, it is silently replaced by an empty library.
+    This is ignored if \c pipelineLibraryEnabled is false.
+    */
+    const Blob* pipelineLibrary         = nullptr;
 };
 
 /**
@@ -121,6 +195,38 @@ struct RendererConfigurationOpenGL
     \remarks This member is ignored if \c contextProfile is OpenGLContextProfile::CompatibilityProfile.
     */
     int                     minorVersion    = 0;
+
+    /**
+    \brief Index of the EGL device to use for headless rendering, in the order returned by \c eglQueryDevicesEXT. By default -1.
+    \remarks If this is -1, the default device (or the surfaceless platform if \c EGL_EXT_platform_device is unavailable) is used.
+    This member is ignored if the render system is not initialized with RenderSystemFlags::Headless.
+    \remarks RenderSystemDescriptor::adapterIndex takes precedence over this member if it is non-negative.
+    \see RenderSystemFlags::Headless
+    \see RenderSystemDescriptor::adapterIndex
+    */
+    int                     deviceIndex     = -1;
+
+    /**
+    \brief Specifies the maximum number of unused texture views that are kept alive for reuse. By default 64.
+    \remarks Texture views are created for resource heaps with subresource views (requires \c GL_ARB_texture_view).
+    When a texture view is no longer referenced, it is kept in a cache, so recreating the same view is cheap.
+    If this limit is exceeded, the least recently used views are evicted and deleted at the end of the frame, i.e. on SwapChain::Present.
+    */
+    std::uint32_t           maxUnusedTextureViews = 64;
+
+    /**
+    \brief Specifies whether all swap-chains with a compatible pixel format are rendered with a single GL context. By default false.
+    \remarks By default, swap-chains share a GL context only if they request exactly the same pixel format.
+    Otherwise, each pixel format gets its own GL context and switching between the swap-chains is a full context switch,
+    which is expensive on most platforms and requires the render states to be tracked for each GL context separately.
+    \remarks If this is true, a new swap-chain reuses the first GL context with the same number of color bits and samples,
+    and at least as many depth and stencil bits as requested by the SwapChainDescriptor.
+    Switching between these swap-chains only switches the drawable of the GL context (e.g. \c wglMakeCurrent with a different \c HDC but the same \c HGLRC),
+    and all render states are kept across the swap-chains.
+    \remarks A swap-chain that reuses a GL context this way may have a depth-stencil buffer although none was requested.
+    \see SwapChain::GetDepthStencilFormat
+    */
+    bool                    singleContext   = false;
 };
 
 /**
@@ -136,6 +242,37 @@ struct RendererConfigurationOpenGLES3
     int minorVersion = 0;
 };
 
+/**
+\brief Null renderer configuration structure.
+\remarks Here is an example how to load the Null renderer as a baseline for CPU benchmarks:
+\code
+LLGL::RendererConfigurationNull config;
+config.benchmarkMode = true;
+
+LLGL::RenderSystemDescriptor rendererDesc = "Null";
+rendererDesc.rendererConfig     = &config;
+rendererDesc.rendererConfigSize = sizeof(config);
+
+auto myRenderer = LLGL::RenderSystem::Load(rendererDesc);
+
+// Record and submit command buffers ...
+
+LLGL::CommandStatistics myStats;
+myRenderer->QueryCommandStatistics(myStats);
+\endcode
+\see RenderSystem::QueryCommandStatistics
+*/
+struct RendererConfigurationNull
+{
+    /**
+    \brief Specifies whether the CPU time to execute each command is measured when a command buffer is submitted. By default false.
+    \remarks The Null renderer always executes the recorded commands with the same state tracking a hardware backend would do,
+    but the time measurement is only enabled with this flag, since it adds the overhead of two timer queries to each command.
+    The overhead of the timer queries is estimated at creation time and subtracted from each measurement.
+    */
+    bool benchmarkMode = false;
+};
+
 
 } // /namespace LLGL
 
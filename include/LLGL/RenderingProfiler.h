@@ -11,7 +11,13 @@
 
 #include <LLGL/SwapChainFlags.h>
 #include <LLGL/PipelineStateFlags.h>
+#include <LLGL/RenderSystemFlags.h>
+#include <LLGL/ResourceFlags.h>
+#include <LLGL/QueryHeapFlags.h>
+#include <LLGL/ProfileTraceWriter.h>
 #include <cstdint>
+#include <string>
+#include <vector>
 #include <string.h>
 
 
@@ -21,15 +27,75 @@ namespace LLGL
 
 /**
 \brief Structure with annotation and elapsed time for a timer profile.
+\remarks Time records form a tree of scopes that are opened and closed with CommandBuffer::PushDebugGroup and CommandBuffer::PopDebugGroup.
+All records are stored in depth-first order, i.e. a scope record always precedes the records of its children.
 \see FrameProfile::timeRecords
 */
 struct ProfileTimeRecord
 {
-    //! Time record annotation, e.g. function name that was recorded from the CommandBuffer.
+    //! Index value for the \c parent member of top-level records.
+    static constexpr std::uint32_t invalidIndex = 0xFFFFFFFF;
+
+    //! Time record annotation, e.g. function name that was recorded from the CommandBuffer or the name of a debug group.
     const char*     annotation  = "";
 
-    //! Elapsed time (in nanoseconds) to execute the respective command.
+    /**
+    \brief Elapsed time (in nanoseconds) to execute the respective command on the GPU.
+    \remarks For a debug group scope, this is the execution time of all commands and nested scopes of that debug group.
+    */
     std::uint64_t   elapsedTime = 0;
+
+    /**
+    \brief Elapsed time (in nanoseconds) to record the respective command on the CPU.
+    \remarks For a debug group scope, this is the time between the calls to CommandBuffer::PushDebugGroup and CommandBuffer::PopDebugGroup.
+    */
+    std::uint64_t   cpuTime     = 0;
+
+    /**
+    \brief Zero-based index of the parent scope within FrameProfile::timeRecords or ProfileTimeRecord::invalidIndex for top-level records.
+    \remarks The parent of a record is the innermost debug group that was pushed while the record was recorded.
+    \see CommandBuffer::PushDebugGroup
+    */
+    std::uint32_t   parent      = invalidIndex;
+
+    //! Number of parent scopes, i.e. zero for top-level records.
+    std::uint32_t   depth       = 0;
+};
+
+/**
+\brief Structure with the number of calls to a single state-change command within a debug group.
+\remarks This can be used to tune the sorting of render queues: if \c numDistinctStates is considerably smaller than the number of non-redundant calls,
+the number of state switches could drop to \c numDistinctStates if the draw calls within that debug group were sorted by \c sortKey.
+\see FrameProfile::stateChangeRecords
+\see RenderingProfiler::stateChangeAnalysisEnabled
+*/
+struct ProfileStateChangeRecord
+{
+    //! Name of the innermost debug group the commands were recorded in, or an empty string for commands outside of any debug group.
+    const char*     annotation          = "";
+
+    //! Name of the state-change command, e.g. "SetPipelineState".
+    const char*     command             = "";
+
+    //! Name of the state that is changed by the command and that can be used as sort key, e.g. "PSO".
+    const char*     sortKey             = "";
+
+    //! Number of calls to this command.
+    std::uint32_t   numCalls            = 0;
+
+    /**
+    \brief Number of redundant calls to this command, i.e. calls that set the same state that was already set.
+    \see FrameProfile::commandsEliminated
+    */
+    std::uint32_t   numRedundantCalls   = 0;
+
+    /**
+    \brief Number of distinct states that were set by this command.
+    \remarks This is the minimum number of state switches if all calls were sorted by the sort key.
+    If the records of multiple command buffers are accumulated, their distinct states are summed up, i.e. this is an upper bound.
+    This is zero for commands whose states are not tracked individually (i.e. \c SetViewport and \c SetViewports).
+    */
+    std::uint32_t   numDistinctStates   = 0;
 };
 
 /**
@@ -49,6 +115,8 @@ struct FrameProfile
     {
         ::memset(values, 0, sizeof(values));
         timeRecords.clear();
+        stateChangeRecords.clear();
+        pipelineStatistics = QueryPipelineStatistics{};
     }
 
     //! Accumulates the specified profile with this profile.
@@ -58,8 +126,46 @@ struct FrameProfile
         for (std::size_t i = 0; i < (sizeof(values) / sizeof(values[0])); ++i)
             values[i] += rhs.values[i];
 
-        /* Append time records */
+        /* Append time records and move their parent indices to the appended range */
+        const auto firstRecord = static_cast<std::uint32_t>(timeRecords.size());
         timeRecords.insert(timeRecords.end(), rhs.timeRecords.begin(), rhs.timeRecords.end());
+        for (std::size_t i = firstRecord; i < timeRecords.size(); ++i)
+        {
+            if (timeRecords[i].parent != ProfileTimeRecord::invalidIndex)
+                timeRecords[i].parent += firstRecord;
+        }
+
+        /* Merge state change records of the same command and debug group */
+        for (const auto& rec : rhs.stateChangeRecords)
+        {
+            auto it = stateChangeRecords.begin();
+            for (; it != stateChangeRecords.end(); ++it)
+            {
+                if (::strcmp(it->command, rec.command) == 0 && ::strcmp(it->annotation, rec.annotation) == 0)
+                    break;
+            }
+            if (it != stateChangeRecords.end())
+            {
+                it->numCalls            += rec.numCalls;
+                it->numRedundantCalls   += rec.numRedundantCalls;
+                it->numDistinctStates   += rec.numDistinctStates;
+            }
+            else
+                stateChangeRecords.push_back(rec);
+        }
+
+        /* Accumulate pipeline statistics */
+        pipelineStatistics.inputAssemblyVertices            += rhs.pipelineStatistics.inputAssemblyVertices;
+        pipelineStatistics.inputAssemblyPrimitives          += rhs.pipelineStatistics.inputAssemblyPrimitives;
+        pipelineStatistics.vertexShaderInvocations          += rhs.pipelineStatistics.vertexShaderInvocations;
+        pipelineStatistics.geometryShaderInvocations        += rhs.pipelineStatistics.geometryShaderInvocations;
+        pipelineStatistics.geometryShaderPrimitives         += rhs.pipelineStatistics.geometryShaderPrimitives;
+        pipelineStatistics.clippingInvocations              += rhs.pipelineStatistics.clippingInvocations;
+        pipelineStatistics.clippingPrimitives               += rhs.pipelineStatistics.clippingPrimitives;
+        pipelineStatistics.fragmentShaderInvocations        += rhs.pipelineStatistics.fragmentShaderInvocations;
+        pipelineStatistics.tessControlShaderInvocations     += rhs.pipelineStatistics.tessControlShaderInvocations;
+        pipelineStatistics.tessEvaluationShaderInvocations  += rhs.pipelineStatistics.tessEvaluationShaderInvocations;
+        pipelineStatistics.computeShaderInvocations         += rhs.pipelineStatistics.computeShaderInvocations;
     }
 
     union
@@ -263,10 +369,37 @@ struct FrameProfile
             \see CommandQueue::Submit(Fence&)
             */
             std::uint32_t fenceSubmissions;
+
+            /**
+            \brief Counter for all redundant state commands, i.e. commands that set the same state that is already set in the same command buffer.
+            \remarks This includes calls to \c SetPipelineState, \c SetResourceHeap, \c SetResource, \c SetVertexBuffer(Array), \c SetIndexBuffer, and \c SetViewport(s) with the same arguments as the previous call,
+            unless an intermediate command might have changed that state (e.g. a new render pass or a secondary command buffer).
+            \remarks The OpenGL backend eliminates such commands while recording deferred command buffers.
+            \see CommandBuffer::SetPipelineState
+            \see CommandBuffer::SetResourceHeap
+            \see CommandBuffer::SetResource
+            \see CommandBuffer::SetViewport
+            */
+            std::uint32_t commandsEliminated;
+
+            /**
+            \brief Counter for all vertical blanks that passed without a new frame being displayed.
+            \remarks This is only counted by a FramePacer that has this profiler assigned.
+            \see FramePacerDescriptor::profiler
+            */
+            std::uint32_t missedVSyncs;
+
+            /**
+            \brief Counter for all command buffer encodings that had to wait for the GPU before they could begin.
+            \remarks This happens when all native command buffers are still in flight and none can be added anymore.
+            \see CommandBufferDescriptor::maxNativeBuffers
+            \see CommandBuffer::QueryBeginStalls
+            */
+            std::uint32_t commandBufferStalls;
         };
 
         //! All proflile values as linear array.
-        std::uint32_t values[33];
+        std::uint32_t values[36];
     };
 
     /**
@@ -274,6 +407,100 @@ struct FrameProfile
     \see RenderingProfiler::timeRecordingEnabled
     */
     std::vector<ProfileTimeRecord> timeRecords;
+
+    /**
+    \brief List of all state change records for this frame profile.
+    \see RenderingProfiler::stateChangeAnalysisEnabled
+    */
+    std::vector<ProfileStateChangeRecord> stateChangeRecords;
+
+    /**
+    \brief Pipeline statistics of all command buffers that were encoded for this frame profile.
+    \remarks The statistics of a command buffer are resolved once the GPU has finished it, so they are reported with a latency of one or more frames.
+    \see RenderingProfiler::pipelineStatisticsEnabled
+    */
+    QueryPipelineStatistics pipelineStatistics;
+};
+
+/**
+\brief Memory accounting record of all live resources within a single category.
+\see ResourceMemoryStatistics
+*/
+struct ProfileMemoryRecord
+{
+    //! Name of this category, e.g. "VertexBuffer", "RGBA8UNorm", or the debug name of a resource.
+    std::string     name;
+
+    //! Number of bytes of all live resources in this category.
+    std::uint64_t   size        = 0;
+
+    //! Number of live resources in this category.
+    std::uint32_t   count       = 0;
+
+    /**
+    \brief Highest number of bytes of all live resources in this category.
+    \remarks This is the peak of all samples of this category, i.e. the peak is only updated each time the statistics are sampled.
+    */
+    std::uint64_t   peakSize    = 0;
+};
+
+/**
+\brief Record of a live resource that has not been used for a while.
+\see ResourceMemoryStatistics::unusedResources
+*/
+struct ProfileUnusedResourceRecord
+{
+    //! Debug name of the resource, or an empty string if the resource has no name.
+    std::string     name;
+
+    //! Resource type. This is either ResourceType::Buffer or ResourceType::Texture.
+    ResourceType    type            = ResourceType::Undefined;
+
+    //! Number of bytes of the resource.
+    std::uint64_t   size            = 0;
+
+    //! Number of presented frames since the resource has been used or created.
+    std::uint64_t   unusedFrames    = 0;
+};
+
+/**
+\brief Memory accounting of all live buffers and textures of a render system.
+\remarks The sizes are derived from the resource descriptors (i.e. BufferDescriptor::size and Texture::GetMemoryFootprint),
+so they do not include the alignment and padding of the respective backend. Texture views are not included, since they share the memory of another texture.
+\see RenderingProfiler::resourceAccountingEnabled
+*/
+struct ResourceMemoryStatistics
+{
+    //! Number of bytes of all live buffers and textures.
+    std::uint64_t                               totalSize       = 0;
+
+    /**
+    \brief Highest number of bytes of all live buffers and textures since the render system has been loaded.
+    \remarks In contrast to the peaks of the individual categories, this is updated each time a resource is created.
+    */
+    std::uint64_t                               peakTotalSize   = 0;
+
+    //! Number of live buffers and textures.
+    std::uint32_t                               numResources    = 0;
+
+    /**
+    \brief Memory records per binding flag, i.e. one record for each BindFlags entry that is used by any live resource.
+    \remarks Resources with multiple binding flags are accounted in each of their categories.
+    */
+    std::vector<ProfileMemoryRecord>            bindFlagsRecords;
+
+    //! Memory records per format, i.e. BufferDescriptor::format and TextureDescriptor::format.
+    std::vector<ProfileMemoryRecord>            formatRecords;
+
+    //! Memory records per debug name. Unnamed resources are accounted with an empty name.
+    std::vector<ProfileMemoryRecord>            nameRecords;
+
+    /**
+    \brief List of all live resources that have not been used for at least RenderingProfiler::unusedResourceFrames frames.
+    \remarks A resource is used when it is bound to a command buffer (including the resources of a bound resource heap and the attachments of a render target).
+    \see RenderingProfiler::unusedResourceFrames
+    */
+    std::vector<ProfileUnusedResourceRecord>    unusedResources;
 };
 
 /**
@@ -289,9 +516,17 @@ class RenderingProfiler
         /**
         \brief Returns the current frame profile and resets the counters for the next frame.
         \param[out] outputProfile Optional pointer to an output profile to retrieve the current values. By default null.
+        \remarks If a trace writer is set, the current frame profile is also written to that trace writer.
+        \remarks To compute statistics over multiple frames, append the current frame profile to a ProfileFrameHistory before calling this function.
+        \see traceWriter
+        \see ProfileFrameHistory::Append
         */
         inline void NextProfile(FrameProfile* outputProfile = nullptr)
         {
+            /* Write current frame to the trace (if set) */
+            if (traceWriter)
+                traceWriter->WriteFrame(frameProfile);
+
             /* Copy current counters to the output profile (if set) */
             if (outputProfile)
                 *outputProfile = frameProfile;
@@ -313,13 +548,78 @@ class RenderingProfiler
     public:
 
         //! Current frame profile with all counter values.
-        FrameProfile    frameProfile;
+        FrameProfile        frameProfile;
 
         /**
         \brief Specifis whether the command buffer time recording is enabled or disabled. By default disabled.
+        \remarks If enabled, each debug group of a command buffer opens a timing scope,
+        so the GPU time of entire passes can be attributed with CommandBuffer::PushDebugGroup and CommandBuffer::PopDebugGroup.
         \see FrameProfile::timeRecords
+        \see ProfileTimeRecord::parent
+        */
+        bool                timeRecordingEnabled        = false;
+
+        /**
+        \brief Specifies whether the state-change analysis is enabled or disabled. By default disabled.
+        \remarks If enabled, the debug layer tracks the states that are set by \c SetPipelineState, \c SetResourceHeap, \c SetResource,
+        \c SetVertexBuffer(Array), \c SetIndexBuffer, and \c SetViewport(s), and counts the redundant calls and distinct states
+        of each of these commands per debug group.
+        \see FrameProfile::stateChangeRecords
+        */
+        bool                stateChangeAnalysisEnabled  = false;
+
+        /**
+        \brief Specifies whether the GPU pipeline statistics are queried. By default disabled.
+        \remarks If enabled, the debug layer brackets each primary command buffer with a pipeline statistics query,
+        so the number of vertices, primitives, and shader invocations of each frame can be read from FrameProfile::pipelineStatistics.
+        This has no effect if the renderer does not support pipeline statistics queries.
+        \see FrameProfile::pipelineStatistics
+        \see RenderingFeatures::hasPipelineStatistics
+        */
+        bool                pipelineStatisticsEnabled   = false;
+
+        /**
+        \brief Specifies whether the GPU memory statistics are sampled each frame. By default disabled.
+        \remarks If enabled, the debug layer queries the memory statistics each time a swap-chain is presented.
+        \see memoryStatistics
+        */
+        bool                memoryStatisticsEnabled     = false;
+
+        /**
+        \brief GPU memory statistics that were sampled with the last presented frame.
+        \see memoryStatisticsEnabled
+        \see RenderSystem::QueryMemoryStatistics
+        */
+        MemoryStatistics    memoryStatistics;
+
+        /**
+        \brief Specifies whether the memory of all buffers and textures is accounted each frame. By default disabled.
+        \remarks If enabled, the debug layer updates the resource memory statistics each time a swap-chain is presented.
+        If a debugger is used as well, all resources that have not been released when the render system is unloaded are reported as leaks.
+        \see resourceMemory
+        */
+        bool                resourceAccountingEnabled   = false;
+
+        /**
+        \brief Number of presented frames after which a live resource, that has not been used, is reported as unused. By default 60.
+        \see ResourceMemoryStatistics::unusedResources
+        */
+        std::uint32_t       unusedResourceFrames        = 60;
+
+        /**
+        \brief Resource memory statistics that were accounted with the last presented frame.
+        \see resourceAccountingEnabled
+        */
+        ResourceMemoryStatistics resourceMemory;
+
+        /**
+        \brief Optional trace writer that records each frame profile in the Chrome trace-event format. By default null.
+        \remarks Frames are only recorded while this is set, so a range of frames can be selected by setting and resetting this pointer.
+        While this is set, the debug layer also writes the CPU time of each call to CommandQueue::Submit and SwapChain::Present to the trace.
+        The trace writer is not owned by the profiler, i.e. it must remain valid until this pointer is reset.
+        \see NextProfile
         */
-        bool            timeRecordingEnabled    = false;
+        ProfileTraceWriter* traceWriter                 = nullptr;
 
 };
 
@@ -9,6 +9,9 @@
 #define LLGL_RESOURCE_FLAGS_H
 
 
+#include <cstdint>
+
+
 namespace LLGL
 {
 
@@ -49,6 +52,79 @@ enum class ResourceType
     Sampler,
 };
 
+/**
+\brief Native resource handle type enumeration.
+\remarks The first group of types denotes native objects of a rendering API, which are queried with RenderSystem::QueryNativeHandle.
+The second group denotes shared memory handles, which are exported with RenderSystem::ExportResource and can be imported by another API or process.
+\see NativeResourceHandle::type
+*/
+enum class NativeHandleType
+{
+    //! Undefined native handle type.
+    Undefined,
+
+    /**
+    \brief Vulkan \c VkImage object. NativeResourceHandle::memory specifies the bound \c VkDeviceMemory object.
+    \note Only supported with: Vulkan.
+    */
+    VkImage,
+
+    /**
+    \brief Vulkan \c VkBuffer object. NativeResourceHandle::memory specifies the bound \c VkDeviceMemory object.
+    \note Only supported with: Vulkan.
+    */
+    VkBuffer,
+
+    /**
+    \brief Direct3D 12 \c ID3D12Resource object.
+    \note Only supported with: Direct3D 12.
+    */
+    D3D12Resource,
+
+    /**
+    \brief OpenGL texture name.
+    \note Only supported with: OpenGL.
+    */
+    GLTexture,
+
+    /**
+    \brief OpenGL buffer name.
+    \note Only supported with: OpenGL.
+    */
+    GLBuffer,
+
+    /**
+    \brief Metal \c MTLTexture object.
+    \note Only supported with: Metal.
+    */
+    MTLTexture,
+
+    /**
+    \brief Metal \c MTLBuffer object.
+    \note Only supported with: Metal.
+    */
+    MTLBuffer,
+
+    /**
+    \brief POSIX file descriptor of device memory (\c VK_KHR_external_memory_fd).
+    \remarks A file descriptor that is imported into a resource is owned by the render system afterwards, i.e. it must not be closed by the application.
+    \note Only supported with: Vulkan.
+    */
+    OpaqueFD,
+
+    /**
+    \brief Win32 \c HANDLE of device memory (\c VK_KHR_external_memory_win32). The handle must be closed with \c CloseHandle by the application.
+    \note Only supported with: Vulkan, Direct3D 12.
+    */
+    OpaqueWin32,
+
+    /**
+    \brief Win32 \c HANDLE created by \c ID3D12Device::CreateSharedHandle. The handle must be closed with \c CloseHandle by the application.
+    \note Only supported with: Direct3D 12, Vulkan.
+    */
+    D3D12SharedHandle,
+};
+
 /**
 \brief Flags for Buffer and Texture resources that describe for which purposes they will be used.
 \remarks Resources can be created with both input and output binding flags, but they cannot be used together when the resource is bound. See the following table for compatibility:
@@ -183,6 +259,7 @@ struct CPUAccessFlags
         \see CPUAccess::WriteOnly
         \see CPUAccess::WriteDiscard
         \see CPUAccess::ReadWrite
+        \see CPUAccess::WriteUnsynchronized
         */
         Write       = (1 << 1),
 
@@ -256,10 +333,121 @@ struct MiscFlags
         \see https://docs.microsoft.com/en-us/windows/win32/api/d3d11/ne-d3d11-d3d11_buffer_uav_flag
         */
         Counter         = (1 << 5),
+
+        /**
+        \brief Specifies a buffer for high-frequency CPU updates, e.g. dynamic geometry that is rewritten every frame.
+        \remarks For the OpenGL backend, such a buffer is allocated with immutable storage that is persistently and coherently mapped for its entire lifetime.
+        RenderSystem::WriteBuffer, CommandBuffer::UpdateBuffer, and RenderSystem::MapBuffer then write directly into that storage instead of letting the driver orphan it.
+        Each range that has been written is guarded by a fence when the next command buffer is submitted,
+        and a later write into that range waits until the GPU has finished all commands that were submitted before the fence.
+        To avoid stalls, the application should sub-allocate a separate region of the buffer for each frame in flight.
+        Within a single submission, a range that is read by previously encoded commands must not be overwritten.
+        \remarks This can only be used with buffers. If the backend does not support persistent mapping, this flag is ignored.
+        \note Only supported with: OpenGL 4.4 or \c GL_ARB_buffer_storage.
+        \see RenderSystem::WriteBuffer
+        \see RenderSystem::MapBuffer
+        */
+        Streaming       = (1 << 6),
+
+        /**
+        \brief Hint to the renderer that the initial data of a resource and subsequent texture writes can be uploaded asynchronously.
+        \remarks For the OpenGL backend, RenderSystem::CreateBuffer, RenderSystem::CreateTexture, and RenderSystem::WriteTexture
+        copy the source data and upload it on a worker thread with a GL context that shares its objects with the primary GL context.
+        The upload is made visible to the render thread, without blocking the CPU, by the next command buffer that is begun or submitted after the upload has finished.
+        Until then, the resource must not be used in any command buffer. CommandQueue::WaitIdle blocks until all asynchronous uploads have finished.
+        Reading or mapping such a resource, using it in a resource heap or render target, or releasing it waits for its pending uploads first.
+        \remarks This is ignored for buffers with the MiscFlags::Streaming flag and if the backend cannot create a shared GL context on a worker thread (e.g. on macOS).
+        \note Only supported with: OpenGL.
+        \see RenderSystem::WriteTexture
+        */
+        AsyncUpload     = (1 << 7),
+
+        /**
+        \brief Specifies an indirect buffer whose draw commands are encoded on the GPU, e.g. by a compute shader that performs GPU culling.
+        \remarks For the Metal backend, such a buffer is backed by an \c MTLIndirectCommandBuffer that can hold up to <code>size / sizeof(DrawIndexedIndirectArguments)</code> draw commands.
+        When the buffer is bound to a compute shader (with BindFlags::Storage), the shader receives an argument buffer with the indirect command buffer at argument index 0,
+        i.e. <code>struct ICBContainer { command_buffer commands [[id(0)]]; };</code> in MSL.
+        The encoded draw commands inherit the graphics pipeline and all buffers that are bound when they are executed with CommandBuffer::DrawIndirect or CommandBuffer::DrawIndexedIndirect,
+        which then interpret the offset as <code>firstCommand * sizeof(DrawIndexedIndirectArguments)</code> and ignore the stride.
+        \remarks This can only be used with buffers that have the BindFlags::IndirectBuffer flag. Such buffers cannot be read, written, or mapped by the CPU.
+        \note Only supported with: Metal (macOS 10.14, iOS 13).
+        \see RenderingFeatures::hasIndirectCommandBuffers
+        */
+        IndirectCommands = (1 << 8),
+
+        /**
+        \brief Specifies a transient texture whose memory can be shared with other aliasable textures whose lifetimes do not overlap, e.g. intermediate post-processing targets.
+        \remarks For the Metal backend, such a texture is sub-allocated from a private heap and made aliasable when it is released with RenderSystem::Release,
+        so the next texture that is created within the same frame can reuse its memory, even if command buffers that use the released texture are still in flight.
+        The heaps track hazards, so the GPU accesses of aliased textures are still executed in order.
+        \remarks The content of an aliasable texture is undefined after creation, i.e. it must be written (e.g. as render target attachment) before it is read.
+        Such a texture cannot be initialized with image data, nor can it be read or written by the CPU.
+        \note Only supported with: Metal (macOS 10.15, iOS 13). Ignored otherwise.
+        */
+        Aliasable       = (1 << 9),
+
+        /**
+        \brief Specifies a sparse (or partially resident) texture whose memory is committed in tiles, e.g. for virtual texturing.
+        \remarks A sparse texture is created without any memory. Its tiles must be committed with RenderSystem::CommitTextureTiles before they are written or sampled,
+        and they can be decommitted with RenderSystem::DecommitTextureTiles to return their memory. Texels of tiles that are not committed read as zero where the hardware supports it and are undefined otherwise.
+        \remarks The content of a sparse texture is undefined after creation, i.e. it cannot be initialized with image data.
+        Such a texture cannot be used as render target attachment, nor can it generate MIP-maps.
+        \remarks This can only be used with textures of type TextureType::Texture2D or TextureType::Texture2DArray.
+        \note Only supported with: Vulkan, Direct3D 12, Metal (macOS 11, iOS 13 on Apple GPUs).
+        \see RenderingFeatures::hasSparseTextures
+        \see RenderSystem::QueryTextureTiling
+        */
+        Sparse          = (1 << 10),
+
+        /**
+        \brief Specifies a resource whose memory can be shared with other rendering APIs or processes, e.g. for video decoding or compositor integration.
+        \remarks Such a resource is allocated in its own dedicated memory block that can be exported with RenderSystem::ExportResource.
+        \remarks This cannot be used together with the MiscFlags::Sparse or MiscFlags::Aliasable bits.
+        \note Only supported with: Vulkan (\c VK_KHR_external_memory_fd or \c VK_KHR_external_memory_win32), Direct3D 12.
+        \see RenderingFeatures::hasExternalMemory
+        \see RenderSystem::ExportResource
+        */
+        Shared          = (1 << 11),
     };
 };
 
 
+/* ----- Structures ----- */
+
+/**
+\brief Native resource handle structure.
+\remarks This is used to wrap native objects of a rendering API into LLGL resources and to share resource memory with other APIs or processes.
+Pointers (e.g. \c ID3D12Resource* or \c id<MTLTexture>) and handles (e.g. \c VkImage, \c HANDLE, or file descriptors) are stored as 64-bit integers.
+\see RenderSystem::QueryNativeHandle
+\see RenderSystem::ExportResource
+\see RenderSystem::ImportBuffer
+\see RenderSystem::ImportTexture
+*/
+struct NativeResourceHandle
+{
+    //! Specifies the type of the native object or shared handle. By default NativeHandleType::Undefined.
+    NativeHandleType    type            = NativeHandleType::Undefined;
+
+    //! Specifies the native object or shared handle. By default 0.
+    std::uint64_t       object          = 0;
+
+    /**
+    \brief Specifies the native device memory object the resource is bound to. By default 0.
+    \remarks This is only used for the native handle types NativeHandleType::VkImage and NativeHandleType::VkBuffer, i.e. it is a \c VkDeviceMemory object.
+    */
+    std::uint64_t       memory          = 0;
+
+    //! Specifies the offset (in bytes) of the resource within its device memory. By default 0.
+    std::uint64_t       memoryOffset    = 0;
+
+    /**
+    \brief Specifies the size (in bytes) of the device memory of the resource. By default 0.
+    \remarks For shared handles that are imported, this must be the size of the exported memory block, or 0 to use the memory requirements of the new resource.
+    */
+    std::uint64_t       memorySize      = 0;
+};
+
+
 } // /namespace LLGL
 
 
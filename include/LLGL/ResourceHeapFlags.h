@@ -173,6 +173,31 @@ struct ResourceHeapDescriptor
     \see BarrierFlags
     */
     long            barrierFlags        = 0;
+
+    /**
+    \brief Specifies the shader storage buffer slot for bindless texture handles. By default Constants::invalidSlot.
+    \remarks If this is not Constants::invalidSlot, all sampled textures of this resource heap are made resident as bindless texture handles
+    and their 64-bit handles are stored in a single shader storage buffer that is bound to this slot, instead of binding each texture and sampler separately.
+    The handles are stored in ascending order of the texture binding slots. A sampler at the same binding slot as a texture is combined with that texture into a single handle;
+    samplers without a corresponding texture are ignored. Each texture must not change its sampling parameters once its handle has been created.
+    \remarks The shader must declare a buffer block with an array of sampler types at this slot, e.g. <code>layout(std430, binding = 2) readonly buffer Textures { sampler2D textures[]; };</code>.
+    \remarks If bindless textures are not supported (i.e. the extension \c GL_ARB_bindless_texture is not available), this attribute is ignored and textures are bound as usual.
+    \remarks For Metal, this specifies the buffer slot of an argument buffer instead. All resources of each descriptor set are encoded into that argument buffer,
+    which is bound with a single \c setBuffer call per shader stage. Each resource referenced by the argument buffer is made resident with \c useResource.
+    The argument index of each resource (i.e. <code>[[id(n)]]</code> in MSL) is the index of its binding in PipelineLayoutDescriptor::bindings,
+    e.g. <code>struct Resources { texture2d<float> tex [[id(0)]]; sampler smpl [[id(1)]]; }; fragment float4 PS(constant Resources& res [[buffer(2)]])</code>.
+    If Tier-2 argument buffers are not supported, this attribute is ignored and resources are bound as usual.
+    \note Only supported with: OpenGL, Metal.
+    */
+    std::uint32_t   bindlessSlot        = Constants::invalidSlot;
+
+    /**
+    \brief Specifies whether the resource heap is short-lived, e.g. only used for a single frame. By default false.
+    \remarks Transient resource heaps allocate their descriptors from shared pools that are reset in bulk once all transient resource heaps have been released,
+    instead of recycling the descriptors of each resource heap individually. Use this for resource heaps that are created and released every frame.
+    \note Only supported with: Vulkan.
+    */
+    bool            transient           = false;
 };
 
 
@@ -36,6 +36,8 @@ enum class ShaderType
     Geometry,       //!< Geometry shader type.
     Fragment,       //!< Fragment shader type (also "Pixel Shader").
     Compute,        //!< Compute shader type.
+    Task,           //!< Task shader type (also "Amplification Shader" or "Object Shader").
+    Mesh,           //!< Mesh shader type.
 };
 
 /**
@@ -175,11 +177,20 @@ struct StageFlags
         //! Specifies the compute shader stage.
         ComputeStage        = (1 << 5),
 
+        //! Specifies the task shader stage (also referred to as "Amplification Shader" or "Object Shader").
+        TaskStage           = (1 << 6),
+
+        //! Specifies the mesh shader stage.
+        MeshStage           = (1 << 7),
+
         //! Specifies all tessellation stages, i.e. tessellation-control-, tessellation-evaluation shader stages.
         AllTessStages       = (TessControlStage | TessEvaluationStage),
 
-        //! Specifies all graphics pipeline shader stages, i.e. vertex-, tessellation-, geometry-, and fragment shader stages.
-        AllGraphicsStages   = (VertexStage | AllTessStages | GeometryStage | FragmentStage),
+        //! Specifies all mesh pipeline stages, i.e. task- and mesh shader stages.
+        AllMeshStages       = (TaskStage | MeshStage),
+
+        //! Specifies all graphics pipeline shader stages, i.e. vertex-, tessellation-, geometry-, task-, mesh-, and fragment shader stages.
+        AllGraphicsStages   = (VertexStage | AllTessStages | GeometryStage | AllMeshStages | FragmentStage),
 
         //! Specifies all shader stages.
         AllStages           = (AllGraphicsStages | ComputeStage),
@@ -264,6 +275,9 @@ struct ComputeShaderAttributes
     If not used for shader reflection, all other renderers need to specified the workgroup size within the shader code:
     - For GLSL: <code>layout(local_size_x = X, local_size_y = Y, local_size_z = Z)</code>
     - For HLSL: <code>[numthreads(X, Y, Z)]</code>
+    \remarks This is also used for task and mesh shaders, whose threadgroup size must be specified for the Metal backend as well.
+    \see ShaderType::Task
+    \see ShaderType::Mesh
     */
     Extent3D workGroupSize = { 1, 1, 1 };
 };
@@ -212,6 +212,7 @@ struct ShaderReflection
 
     /**
     \brief List of all uniforms (a.k.a. shader constants).
+    \remarks For Vulkan, these are the members of the push constant block and their location is the byte offset divided by 4.
     \note Only supported with: OpenGL, Vulkan.
     */
     std::vector<ShaderUniform>  uniforms;
@@ -0,0 +1,255 @@
+/*
+ * StaticCommandBuffer.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_STATIC_COMMAND_BUFFER_H
+#define LLGL_STATIC_COMMAND_BUFFER_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/CommandBuffer.h>
+
+
+namespace LLGL
+{
+
+
+#ifdef LLGL_ENABLE_STATIC_DISPATCH
+
+/**
+\brief Non-virtual entry points of the most frequent command buffer functions.
+\remarks These functions are implemented by the only backend of a static library that was built with the \c LLGL_ENABLE_STATIC_DISPATCH option.
+Use StaticCommandBuffer instead of calling these functions directly.
+*/
+namespace StaticDispatch
+{
+
+LLGL_EXPORT void SetViewport(CommandBuffer& commandBuffer, const Viewport& viewport);
+LLGL_EXPORT void SetScissor(CommandBuffer& commandBuffer, const Scissor& scissor);
+
+LLGL_EXPORT void SetVertexBuffer(CommandBuffer& commandBuffer, Buffer& buffer);
+LLGL_EXPORT void SetIndexBuffer(CommandBuffer& commandBuffer, Buffer& buffer);
+LLGL_EXPORT void SetIndexBuffer(CommandBuffer& commandBuffer, Buffer& buffer, const Format format, std::uint64_t offset);
+
+LLGL_EXPORT void SetResourceHeap(CommandBuffer& commandBuffer, ResourceHeap& resourceHeap, std::uint32_t descriptorSet, const PipelineBindPoint bindPoint);
+LLGL_EXPORT void SetResourceHeap(CommandBuffer& commandBuffer, ResourceHeap& resourceHeap, std::uint32_t descriptorSet, std::uint32_t numDynamicOffsets, const std::uint32_t* dynamicOffsets, const PipelineBindPoint bindPoint);
+LLGL_EXPORT void SetResource(CommandBuffer& commandBuffer, Resource& resource, std::uint32_t slot, long bindFlags, long stageFlags);
+
+LLGL_EXPORT void SetPipelineState(CommandBuffer& commandBuffer, PipelineState& pipelineState);
+LLGL_EXPORT void SetUniforms(CommandBuffer& commandBuffer, UniformLocation location, std::uint32_t count, const void* data, std::uint32_t dataSize);
+
+LLGL_EXPORT void Draw(CommandBuffer& commandBuffer, std::uint32_t numVertices, std::uint32_t firstVertex);
+LLGL_EXPORT void DrawIndexed(CommandBuffer& commandBuffer, std::uint32_t numIndices, std::uint32_t firstIndex);
+LLGL_EXPORT void DrawIndexed(CommandBuffer& commandBuffer, std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset);
+LLGL_EXPORT void DrawInstanced(CommandBuffer& commandBuffer, std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances);
+LLGL_EXPORT void DrawInstanced(CommandBuffer& commandBuffer, std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance);
+LLGL_EXPORT void DrawIndexedInstanced(CommandBuffer& commandBuffer, std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex);
+LLGL_EXPORT void DrawIndexedInstanced(CommandBuffer& commandBuffer, std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset);
+LLGL_EXPORT void DrawIndexedInstanced(CommandBuffer& commandBuffer, std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance);
+
+LLGL_EXPORT void Dispatch(CommandBuffer& commandBuffer, std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ);
+
+} // /namespace StaticDispatch
+
+#define LLGL_STATIC_DISPATCH_CALL(FUNC, ...) StaticDispatch::FUNC(commandBuffer_, __VA_ARGS__)
+
+#else
+
+#define LLGL_STATIC_DISPATCH_CALL(FUNC, ...) commandBuffer_.FUNC(__VA_ARGS__)
+
+#endif // /LLGL_ENABLE_STATIC_DISPATCH
+
+
+/**
+\brief Lightweight wrapper that forwards the most frequent command buffer functions without virtual calls.
+\remarks If LLGL was built as static library with the \c LLGL_ENABLE_STATIC_DISPATCH option, there is only a single backend and its command buffer class is \c final.
+In this case, each function of this wrapper is an inline call to a non-virtual entry point of that backend,
+which can be inlined into the application when link-time optimization is enabled for both the application and the static libraries.
+Otherwise, each function forwards to the respective virtual function of CommandBuffer, so the same client code can be used for all builds.
+The application \b must define \c LLGL_ENABLE_STATIC_DISPATCH if the static library was built with this option, just like \c LLGL_BUILD_STATIC_LIB.
+\remarks Example of a draw submission loop:
+\code
+LLGL::StaticCommandBuffer cmd{ *myCmdBuffer };
+for (const auto& obj : myObjects) {
+    cmd.SetResourceHeap(*obj.resourceHeap);
+    cmd.DrawIndexed(obj.numIndices, obj.firstIndex);
+}
+\endcode
+\note With \c LLGL_ENABLE_STATIC_DISPATCH, the command buffer \b must not be wrapped by the debug or capture layer,
+which is why RenderSystem::Load throws an exception if a profiler, debugger, or capture file is specified in that configuration.
+\see CommandBuffer
+*/
+class StaticCommandBuffer
+{
+
+    public:
+
+        inline explicit StaticCommandBuffer(CommandBuffer& commandBuffer) :
+            commandBuffer_ { commandBuffer }
+        {
+        }
+
+        //! Returns the wrapped command buffer for all functions that are not forwarded by this wrapper.
+        inline CommandBuffer& Get() const
+        {
+            return commandBuffer_;
+        }
+
+        /* ----- Viewport and Scissor ----- */
+
+        //! \see CommandBuffer::SetViewport
+        inline void SetViewport(const Viewport& viewport)
+        {
+            LLGL_STATIC_DISPATCH_CALL(SetViewport, viewport);
+        }
+
+        //! \see CommandBuffer::SetScissor
+        inline void SetScissor(const Scissor& scissor)
+        {
+            LLGL_STATIC_DISPATCH_CALL(SetScissor, scissor);
+        }
+
+        /* ----- Buffers ----- */
+
+        //! \see CommandBuffer::SetVertexBuffer
+        inline void SetVertexBuffer(Buffer& buffer)
+        {
+            LLGL_STATIC_DISPATCH_CALL(SetVertexBuffer, buffer);
+        }
+
+        //! \see CommandBuffer::SetIndexBuffer(Buffer&)
+        inline void SetIndexBuffer(Buffer& buffer)
+        {
+            LLGL_STATIC_DISPATCH_CALL(SetIndexBuffer, buffer);
+        }
+
+        //! \see CommandBuffer::SetIndexBuffer(Buffer&, const Format, std::uint64_t)
+        inline void SetIndexBuffer(Buffer& buffer, const Format format, std::uint64_t offset = 0)
+        {
+            LLGL_STATIC_DISPATCH_CALL(SetIndexBuffer, buffer, format, offset);
+        }
+
+        /* ----- Resources ----- */
+
+        //! \see CommandBuffer::SetResourceHeap(ResourceHeap&, std::uint32_t, const PipelineBindPoint)
+        inline void SetResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           descriptorSet   = 0,
+            const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined)
+        {
+            LLGL_STATIC_DISPATCH_CALL(SetResourceHeap, resourceHeap, descriptorSet, bindPoint);
+        }
+
+        //! \see CommandBuffer::SetResourceHeap(ResourceHeap&, std::uint32_t, std::uint32_t, const std::uint32_t*, const PipelineBindPoint)
+        inline void SetResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           descriptorSet,
+            std::uint32_t           numDynamicOffsets,
+            const std::uint32_t*    dynamicOffsets,
+            const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined)
+        {
+            LLGL_STATIC_DISPATCH_CALL(SetResourceHeap, resourceHeap, descriptorSet, numDynamicOffsets, dynamicOffsets, bindPoint);
+        }
+
+        //! \see CommandBuffer::SetResource
+        inline void SetResource(
+            Resource&       resource,
+            std::uint32_t   slot,
+            long            bindFlags,
+            long            stageFlags = StageFlags::AllStages)
+        {
+            LLGL_STATIC_DISPATCH_CALL(SetResource, resource, slot, bindFlags, stageFlags);
+        }
+
+        /* ----- Pipeline States ----- */
+
+        //! \see CommandBuffer::SetPipelineState
+        inline void SetPipelineState(PipelineState& pipelineState)
+        {
+            LLGL_STATIC_DISPATCH_CALL(SetPipelineState, pipelineState);
+        }
+
+        //! \see CommandBuffer::SetUniforms
+        inline void SetUniforms(UniformLocation location, std::uint32_t count, const void* data, std::uint32_t dataSize)
+        {
+            LLGL_STATIC_DISPATCH_CALL(SetUniforms, location, count, data, dataSize);
+        }
+
+        /* ----- Drawing ----- */
+
+        //! \see CommandBuffer::Draw
+        inline void Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
+        {
+            LLGL_STATIC_DISPATCH_CALL(Draw, numVertices, firstVertex);
+        }
+
+        //! \see CommandBuffer::DrawIndexed(std::uint32_t, std::uint32_t)
+        inline void DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
+        {
+            LLGL_STATIC_DISPATCH_CALL(DrawIndexed, numIndices, firstIndex);
+        }
+
+        //! \see CommandBuffer::DrawIndexed(std::uint32_t, std::uint32_t, std::int32_t)
+        inline void DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
+        {
+            LLGL_STATIC_DISPATCH_CALL(DrawIndexed, numIndices, firstIndex, vertexOffset);
+        }
+
+        //! \see CommandBuffer::DrawInstanced(std::uint32_t, std::uint32_t, std::uint32_t)
+        inline void DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
+        {
+            LLGL_STATIC_DISPATCH_CALL(DrawInstanced, numVertices, firstVertex, numInstances);
+        }
+
+        //! \see CommandBuffer::DrawInstanced(std::uint32_t, std::uint32_t, std::uint32_t, std::uint32_t)
+        inline void DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
+        {
+            LLGL_STATIC_DISPATCH_CALL(DrawInstanced, numVertices, firstVertex, numInstances, firstInstance);
+        }
+
+        //! \see CommandBuffer::DrawIndexedInstanced(std::uint32_t, std::uint32_t, std::uint32_t)
+        inline void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
+        {
+            LLGL_STATIC_DISPATCH_CALL(DrawIndexedInstanced, numIndices, numInstances, firstIndex);
+        }
+
+        //! \see CommandBuffer::DrawIndexedInstanced(std::uint32_t, std::uint32_t, std::uint32_t, std::int32_t)
+        inline void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
+        {
+            LLGL_STATIC_DISPATCH_CALL(DrawIndexedInstanced, numIndices, numInstances, firstIndex, vertexOffset);
+        }
+
+        //! \see CommandBuffer::DrawIndexedInstanced(std::uint32_t, std::uint32_t, std::uint32_t, std::int32_t, std::uint32_t)
+        inline void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
+        {
+            LLGL_STATIC_DISPATCH_CALL(DrawIndexedInstanced, numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
+        }
+
+        /* ----- Compute ----- */
+
+        //! \see CommandBuffer::Dispatch
+        inline void Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
+        {
+            LLGL_STATIC_DISPATCH_CALL(Dispatch, numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+        }
+
+    private:
+
+        CommandBuffer& commandBuffer_;
+
+};
+
+#undef LLGL_STATIC_DISPATCH_CALL
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -15,6 +15,9 @@
 //! Maximum number of attachments allowed for render targets (color attachments and depth-stencil attachment).
 #define LLGL_MAX_NUM_ATTACHMENTS            ((LLGL_MAX_NUM_COLOR_ATTACHMENTS) + 1u)
 
+//! Maximum number of subpasses allowed for render passes.
+#define LLGL_MAX_NUM_SUBPASSES              (8u)
+
 //! Maximum number of viewports and scissors.
 #define LLGL_MAX_NUM_VIEWPORTS_AND_SCISSORS (16u)
 
@@ -79,6 +79,54 @@ class LLGL_EXPORT SwapChain : public RenderTarget
         //! Swaps the back buffer with the front buffer to present it on the screen (or rather on this swap-chain).
         virtual void Present() = 0;
 
+        /**
+        \brief Blocks until the swap-chain is ready to accept the next frame.
+        \remarks Call this at the beginning of each frame, before input is sampled, to keep the input latency low.
+        Otherwise, the CPU blocks at the end of the frame (inside the Present function) when the presentation queue is full,
+        and the input that has been sampled for the frame is outdated by the time it is displayed.
+        This function only blocks if SwapChainDescriptor::maxFrameLatency is greater than 0. The default implementation does nothing.
+        \see SwapChainDescriptor::maxFrameLatency
+        */
+        virtual void WaitForNextFrame();
+
+        /**
+        \brief Queries the presentation statistics of this swap-chain.
+        \param[out] outStats Specifies the output statistics. This is only modified if the function succeeds.
+        \return True if the statistics could be queried. The default implementation returns false.
+        \remarks The statistics may lag behind by a few frames, since they can only be determined once a frame has been displayed.
+        \note Only supported with: Direct3D 12, Direct3D 11 (flip model or fullscreen), Vulkan (with \c VK_GOOGLE_display_timing).
+        \see FramePacer
+        */
+        virtual bool QueryPresentStatistics(PresentStatistics& outStats);
+
+        /**
+        \brief Specifies the regions of the back buffer that are updated in the current frame, so only these regions are presented with the next call to Present.
+        \param[in] numRegions Specifies the number of damage regions. If this is zero, the entire back buffer is presented, which is the default.
+        \param[in] regions Pointer to an array of \c numRegions damage regions. The regions are in window coordinates, i.e. the origin is in the upper-left corner.
+        This must not be null if \c numRegions is greater than zero.
+        \return True if the backend supports partial presentation for this swap-chain, otherwise the entire back buffer is presented as usual.
+        The default implementation returns false.
+        \remarks The damage regions only apply to the next call to Present and are reset afterwards.
+        To take advantage of partial presentation, this should be called at the beginning of each frame before anything is rendered into the back buffer,
+        because some backends (i.e. \c EGL_KHR_partial_update) allow the driver to skip rendering outside of the damage regions.
+        The content outside of the damage regions must be the same as in the previous frame, which can be determined with QueryBufferAge.
+        This can significantly reduce the GPU work and power consumption for mostly static screens, e.g. UI heavy applications on mobile devices.
+        \note Only supported with: OpenGLES on Android (with \c EGL_KHR_partial_update or \c EGL_KHR_swap_buffers_with_damage), Vulkan (with \c VK_KHR_incremental_present),
+        Direct3D 12, Direct3D 11 (flip model).
+        \see QueryBufferAge
+        */
+        virtual bool SetDamageRegions(std::uint32_t numRegions, const Scissor* regions);
+
+        /**
+        \brief Returns the age of the current back buffer, i.e. the number of frames ago its content has been presented.
+        \return Age of the current back buffer or zero if its content is undefined. The default implementation returns zero.
+        \remarks A value of 1 means the back buffer holds the content of the previous frame, a value of 2 means it holds the content from two frames ago, and so on.
+        If an application knows the damage regions of the last frames, it only needs to redraw the union of the damage regions of the last \c age frames.
+        \note Only supported with: OpenGLES on Android (with \c EGL_EXT_buffer_age), Direct3D 11 (flip-sequential model or multi-sampled swap-chain).
+        \see SetDamageRegions
+        */
+        virtual std::uint32_t QueryBufferAge();
+
         /**
         \brief Returns the color format of this swap-chain.
         \remarks This may depend on the settings specified for the video mode.
@@ -161,7 +209,7 @@ class LLGL_EXPORT SwapChain : public RenderTarget
 
         /**
         \brief Shares the surface and resolution with another swap-chain.
-        \note This is only used by the renderer debug layer.
+        \note This is only used by the renderer debug and capture layers.
         */
         void ShareSurfaceAndConfig(SwapChain& other);
 
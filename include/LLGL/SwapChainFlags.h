@@ -17,6 +17,43 @@ namespace LLGL
 {
 
 
+/* ----- Enumerations ----- */
+
+/**
+\brief Swap-chain presentation mode enumeration.
+\remarks This determines how presented images are queued up for the display.
+\see SwapChainDescriptor::presentMode
+*/
+enum class PresentMode
+{
+    /**
+    \brief Presentation mode is determined by the V-sync interval. This is the default value.
+    \remarks A V-sync interval of 0 selects the lowest latency mode that is available and any other value selects the Fifo mode.
+    \see SwapChain::SetVsyncInterval
+    */
+    Undefined,
+
+    /**
+    \brief Presented images are queued up and displayed in order on each vertical blank. This mode never tears and is always supported.
+    \remarks The V-sync interval is at least 1 for this mode.
+    */
+    Fifo,
+
+    /**
+    \brief Presented images replace the most recent queued image and are displayed on the next vertical blank.
+    \remarks This mode never tears and does not block on Present, but the GPU may render frames that are never displayed.
+    If this mode is unsupported, the renderer falls back to Immediate and then to Fifo.
+    */
+    Mailbox,
+
+    /**
+    \brief Presented images are displayed immediately. This mode has the lowest latency but may tear.
+    \remarks If this mode is unsupported, the renderer falls back to Mailbox and then to Fifo.
+    */
+    Immediate,
+};
+
+
 /* ----- Flags ----- */
 
 /**
@@ -106,10 +143,47 @@ struct SwapChainDescriptor
     */
     std::uint32_t   swapBuffers     = 2;
 
+    /**
+    \brief Presentation mode of the swap-chain. By default PresentMode::Undefined.
+    \remarks If this is PresentMode::Undefined, the presentation mode is determined by the V-sync interval.
+    \see PresentMode
+    */
+    PresentMode     presentMode     = PresentMode::Undefined;
+
+    /**
+    \brief Maximum number of frames the CPU may queue up ahead of the display. By default 0.
+    \remarks If this is 0, the renderer's default frame latency is used and SwapChain::WaitForNextFrame does not block.
+    Otherwise, SwapChain::WaitForNextFrame blocks until the number of queued frames falls below this value.
+    A value of 1 provides the lowest input latency at the cost of less parallelism between CPU and GPU.
+    \note Only supported with: Direct3D 12, Direct3D 11 (on Windows 8.1 and later), Vulkan, Metal.
+    \see SwapChain::WaitForNextFrame
+    */
+    std::uint32_t   maxFrameLatency = 0;
+
     //! Specifies whether to enable fullscreen mode or windowed mode. By default windowed mode.
     bool            fullscreen      = false;
 };
 
+/**
+\brief Presentation statistics of a swap-chain as reported by the display.
+\remarks All counters are monotonic, so the number of missed vertical blanks between two queries can be determined by comparing the deltas of \c presentCount and \c refreshCount.
+\see SwapChain::QueryPresentStatistics
+*/
+struct PresentStatistics
+{
+    //! Number of frames that have been displayed so far. The other members refer to the last of these frames.
+    std::uint64_t   presentCount    = 0;
+
+    //! Vertical blank counter of the display at the time the last frame was displayed.
+    std::uint64_t   refreshCount    = 0;
+
+    //! Time stamp of that vertical blank in the time domain of Timer::Tick, or 0 if unknown.
+    std::uint64_t   syncTime        = 0;
+
+    //! Duration of a single display refresh cycle in the time domain of Timer::Tick, or 0 if unknown.
+    std::uint64_t   refreshPeriod   = 0;
+};
+
 
 } // /namespace LLGL
 
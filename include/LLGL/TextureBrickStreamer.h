@@ -0,0 +1,204 @@
+/*
+ * TextureBrickStreamer.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_TEXTURE_BRICK_STREAMER_H
+#define LLGL_TEXTURE_BRICK_STREAMER_H
+
+
+#include <LLGL/NonCopyable.h>
+#include <LLGL/Constants.h>
+#include <LLGL/Types.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class RenderSystem;
+class CommandBuffer;
+class Texture;
+
+/* ----- Structures ----- */
+
+/**
+\brief Texture brick streamer descriptor structure.
+\see TextureBrickStreamer::TextureBrickStreamer
+*/
+struct TextureBrickStreamerDescriptor
+{
+    /**
+    \brief Extent (in texels) of each brick. By default (64, 64, 64).
+    \remarks For sparse textures, this is rounded up to a multiple of the tile extent, so each brick commits whole tiles (see TextureTiling::tileExtent).
+    Bricks at the border of the texture are clamped to the texture extent.
+    */
+    Extent3D        brickExtent         = { 64, 64, 64 };
+
+    /**
+    \brief Size (in bytes) of each staging buffer. By default 32 MB.
+    \remarks Each call to TextureBrickStreamer::Encode writes as many pending bricks as fit into a single staging buffer.
+    If a single brick is larger than this size, the staging buffer is enlarged to fit exactly one brick.
+    */
+    std::uint64_t   stagingBufferSize   = 32u * 1024u * 1024u;
+
+    /**
+    \brief Number of batches that can be in flight on the GPU at the same time. By default 2.
+    \remarks Each batch has its own staging buffer. If all staging buffers are still in flight, TextureBrickStreamer::Encode does not encode any bricks instead of blocking.
+    */
+    std::uint32_t   maxBatchesInFlight  = 2;
+
+    /**
+    \brief Maximum number of threads that extract the bricks from the source volume. By default Constants::maxThreadCount.
+    \see JobSystem::ParallelFor
+    */
+    unsigned        maxThreads          = Constants::maxThreadCount;
+};
+
+/**
+\brief Source volume of a texture brick streamer.
+\remarks The source volume must remain valid and unchanged as long as the streamer can still extract bricks from it.
+It can be a memory-mapped file (see Blob::CreateFromFileMapping), since only the rows of the bricks that are streamed are read.
+\see TextureBrickStreamer::TextureBrickStreamer
+*/
+struct TextureBrickSourceDescriptor
+{
+    /**
+    \brief Pointer to the first texel of the source volume.
+    \remarks The texels must be stored in the format of the destination texture (see Texture::GetFormat), i.e. no conversion is performed.
+    */
+    const void*     data        = nullptr;
+
+    /**
+    \brief Extent (in texels) of the source volume. This must not be larger than the first MIP-map level of the destination texture.
+    \remarks For textures of type TextureType::Texture2DArray, the depth specifies the number of array layers.
+    */
+    Extent3D        extent;
+
+    //! Stride (in bytes) of each row in the source volume. If this is 0, the rows are tightly packed. By default 0.
+    std::uint64_t   rowStride   = 0;
+
+    //! Stride (in bytes) of each slice in the source volume. If this is 0, the slices are tightly packed. By default 0.
+    std::uint64_t   layerStride = 0;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Streams a large volume into a 3D texture or 2D-array texture progressively in bricks, i.e. box-shaped sub-regions.
+\remarks Uploading an entire volume with RenderSystem::WriteTexture blocks the calling thread and allocates a staging copy of the entire volume.
+This streamer instead batches the pending bricks into a single staging buffer per batch and encodes one CopyTextureFromBuffer command per brick into the command buffer that is passed to Encode.
+The bricks are extracted from the source volume directly into the mapped staging buffer on the threads of the job system (see JobSystem::ParallelFor),
+so no intermediate image of the volume or of any brick is allocated.
+\remarks If the destination texture was created with MiscFlags::Sparse, the tiles of each brick are committed right before its upload, and evicted bricks are decommitted again.
+Otherwise, the texture is fully resident and bricks that have not been streamed yet keep their initial content.
+\remarks The destination texture must have been created with BindFlags::CopyDst and an uncompressed format.
+\remarks Here is an example how to stream a volume progressively:
+\code
+LLGL::TextureBrickSourceDescriptor myVolumeSource;
+myVolumeSource.data     = myVolumeFile->GetData();
+myVolumeSource.extent   = myVolumeExtent;
+
+LLGL::TextureBrickStreamer myStreamer{ *myRenderer, *myVolumeTexture, myVolumeSource };
+myStreamer.RequestAll();
+
+// Per frame: encode next batch of bricks before the render passes, then submit the command buffer and retire the batch
+myCmdBuffer->Begin();
+myStreamer.Encode(*myCmdBuffer);
+RenderVolume(*myCmdBuffer);
+myCmdBuffer->End();
+myCmdQueue->Submit(*myCmdBuffer);
+myStreamer.NextBatch();
+\endcode
+\note This class is not thread-safe.
+\see CommandBuffer::CopyTextureFromBuffer
+*/
+class LLGL_EXPORT TextureBrickStreamer : public NonCopyable
+{
+
+    public:
+
+        /**
+        \brief Initializes the streamer for the specified destination texture and source volume. No staging buffers are allocated until the first call to Encode.
+        \remarks The render system and the texture must outlive this streamer.
+        \throw std::invalid_argument If the texture is neither a 3D texture nor a 2D-array texture, has a compressed format,
+        or if the source volume is null or larger than the first MIP-map level of the texture.
+        */
+        TextureBrickStreamer(
+            RenderSystem&                       renderSystem,
+            Texture&                            texture,
+            const TextureBrickSourceDescriptor& sourceDesc,
+            const TextureBrickStreamerDescriptor& streamerDesc = {}
+        );
+
+        //! Waits until the GPU has finished all batches in flight and releases all staging buffers. Committed tiles of sparse textures remain committed.
+        ~TextureBrickStreamer();
+
+        /**
+        \brief Requests the specified brick to be streamed. Requests are served in the order they were made.
+        \param[in] brick Specifies the brick coordinate, i.e. the texel offset divided by the brick extent. This must be less than GetNumBricks.
+        \remarks Bricks that are already resident or pending are ignored.
+        */
+        void Request(const Offset3D& brick);
+
+        //! Requests all bricks that are neither resident nor pending in ascending order of their Z, Y, and X coordinates.
+        void RequestAll();
+
+        /**
+        \brief Evicts the specified brick. If the texture is sparse, the tiles of this brick are decommitted.
+        \remarks If this brick is pending, its request is cancelled. If the batch of this brick is still in flight, it is evicted as soon as that batch has finished.
+        The tiles of an evicted brick must not be accessed by any command buffer that is still in flight.
+        \see RenderSystem::DecommitTextureTiles
+        */
+        void Evict(const Offset3D& brick);
+
+        /**
+        \brief Encodes the next batch of pending bricks into the specified command buffer.
+        \param[in] commandBuffer Specifies the command buffer that the copy commands are encoded into. This must be in recording state and outside of a render pass.
+        \return Number of bricks that have been encoded. This is 0 if no bricks are pending or if all staging buffers are still in flight.
+        \remarks This never waits for the GPU. The encoded bricks become resident once the GPU has finished the batch, which is tracked with a fence that is submitted by NextBatch.
+        */
+        std::uint32_t Encode(CommandBuffer& commandBuffer);
+
+        /**
+        \brief Retires the batch that has been encoded since the previous call, if any.
+        \remarks This submits a fence to the command queue of the render system, so it must be called after the command buffer that was passed to Encode has been submitted.
+        It also updates the residency of all previous batches without blocking.
+        */
+        void NextBatch();
+
+        //! Returns the number of bricks along each dimension of the texture.
+        const Extent3D& GetNumBricks() const;
+
+        //! Returns the brick extent after it has been aligned to the tile extent of sparse textures.
+        const Extent3D& GetBrickExtent() const;
+
+        //! Returns true if the specified brick has been uploaded and the GPU has finished the batch it was uploaded with.
+        bool IsResident(const Offset3D& brick) const;
+
+        //! Returns the number of resident bricks.
+        std::uint32_t GetNumResidentBricks() const;
+
+        //! Returns the number of bricks that have been requested but not encoded yet.
+        std::uint32_t GetNumPendingBricks() const;
+
+    private:
+
+        struct Pimpl;
+        Pimpl* pimpl_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,84 @@
+/*
+ * TextureCompression.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_TEXTURE_COMPRESSION_H
+#define LLGL_TEXTURE_COMPRESSION_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/Constants.h>
+#include <LLGL/ImageFlags.h>
+#include <LLGL/TextureFlags.h>
+
+
+namespace LLGL
+{
+
+
+class CommandBuffer;
+class Texture;
+class TransientBufferAllocator;
+
+/* ----- Functions ----- */
+
+/**
+\brief Block-compresses the specified uncompressed image and encodes a copy command into the command buffer that writes the compressed blocks into a region of the destination texture.
+\param[in] commandBuffer Specifies the command buffer that the copy command is encoded into. This must be in recording state and outside of a render pass.
+\param[in] stagingAllocator Specifies the allocator the staging memory for the compressed blocks is sub-allocated from.
+Its buffer pages must have been created with the binding flag BindFlags::CopySrc (see TransientBufferAllocatorDescriptor::bindFlags).
+\param[in,out] dstTexture Specifies the destination texture. Its format must be one of the block compression formats Format::BC1UNorm to Format::BC5SNorm,
+and it must have been created with the binding flag BindFlags::CopyDst.
+\param[in] dstRegion Specifies the destination region. The \c numMipLevels attribute of this parameter \b must be 1.
+\param[in] srcImageDesc Specifies the uncompressed source image, which must have the extent of the destination region.
+For array textures, each array layer of the region is a separate slice of the source image.
+\param[in] threadCount Specifies the number of threads to use for compression. By default Constants::maxThreadCount.
+\return True if the copy command has been encoded. Otherwise, the destination region is empty or the staging memory could not be allocated.
+\remarks The blocks are compressed on the threads of the job system directly into the mapped staging memory (see CompressImageBuffer),
+so no compressed copy of the image needs to be allocated. Only a source image that is not in the uncompressed format of the destination texture is converted into an intermediate buffer first.
+\remarks As for all transient allocations, TransientBufferAllocator::Flush must be called before the command buffer is submitted.
+\remarks Copies from buffers into block-compressed textures are currently only supported by the Vulkan and OpenGL backends (see CommandBuffer::CopyTextureFromBuffer).
+For all other backends, compress the image with CompressImageBuffer and write it with RenderSystem::WriteTexture instead.
+\remarks Here is an example how to compress a lightmap that has been generated on the CPU:
+\code
+LLGL::TransientBufferAllocatorDescriptor myStagingDesc;
+myStagingDesc.bindFlags = LLGL::BindFlags::CopySrc;
+LLGL::TransientBufferAllocator myStagingAllocator{ *myRenderer, myStagingDesc };
+
+const LLGL::SrcImageDescriptor myLightmapImage{ LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, myLightmap.data(), myLightmap.size() };
+const LLGL::TextureRegion myLightmapRegion{ LLGL::Offset3D{}, myLightmapTexture->GetMipExtent(0) };
+
+myCmdBuffer->Begin();
+LLGL::CompressTexture(*myCmdBuffer, myStagingAllocator, *myLightmapTexture, myLightmapRegion, myLightmapImage);
+myCmdBuffer->End();
+
+myStagingAllocator.Flush();
+myCmdQueue->Submit(*myCmdBuffer);
+myStagingAllocator.NextFrame();
+\endcode
+\throw std::invalid_argument If the destination texture format is not a block compression format or the destination region does not specify exactly one MIP-map level.
+\throw std::invalid_argument If the source image format is compressed or a depth-stencil format, or the source buffer is too small for the destination region.
+\see CompressImageBuffer
+\see CommandBuffer::CopyTextureFromBuffer
+*/
+LLGL_EXPORT bool CompressTexture(
+    CommandBuffer&              commandBuffer,
+    TransientBufferAllocator&   stagingAllocator,
+    Texture&                    dstTexture,
+    const TextureRegion&        dstRegion,
+    const SrcImageDescriptor&   srcImageDesc,
+    unsigned                    threadCount = Constants::maxThreadCount
+);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
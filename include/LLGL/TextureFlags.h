@@ -256,6 +256,38 @@ struct TextureRegion
     Extent3D            extent;
 };
 
+/**
+\brief Texture copy region structure: Destination and source location and the extent of the region to copy.
+\remarks This is used to copy many sub-regions between two textures with a single command, e.g. to build texture atlases.
+\see CommandBuffer::CopyTexture(Texture&, Texture&, std::uint32_t, const TextureCopyRegion*)
+\see TextureLocation
+*/
+struct TextureCopyRegion
+{
+    TextureCopyRegion() = default;
+    TextureCopyRegion(const TextureCopyRegion&) = default;
+
+    //! Constructor to initialize all members.
+    inline TextureCopyRegion(const TextureLocation& dstLocation, const TextureLocation& srcLocation, const Extent3D& extent) :
+        dstLocation { dstLocation },
+        srcLocation { srcLocation },
+        extent      { extent      }
+    {
+    }
+
+    //! Destination location, including MIP-map level and offset.
+    TextureLocation dstLocation;
+
+    //! Source location, including MIP-map level and offset.
+    TextureLocation srcLocation;
+
+    /**
+    \brief Extent of the texture region to copy.
+    \remarks The same rules as for the \c extent parameter of CommandBuffer::CopyTexture apply, i.e. this also includes the array layers.
+    */
+    Extent3D        extent;
+};
+
 /**
 \brief Texture descriptor structure.
 \remarks Contains all information about type, format, and dimension to create a texture resource.
@@ -400,6 +432,34 @@ struct TextureViewDescriptor
     TextureSwizzleRGBA  swizzle;
 };
 
+/**
+\brief Tiling properties of a sparse texture.
+\see RenderSystem::QueryTextureTiling
+\see MiscFlags::Sparse
+*/
+struct TextureTiling
+{
+    /**
+    \brief Extent (in texels) of each tile.
+    \remarks The offset of each region that is committed or decommitted must be a multiple of this extent,
+    and so must be its extent unless the region ends at the border of the MIP-map level.
+    */
+    Extent3D        tileExtent;
+
+    //! Size (in bytes) of each tile in GPU memory.
+    std::uint64_t   tileSize            = 0;
+
+    /**
+    \brief Index of the first MIP-map level that is packed into the MIP-map tail.
+    \remarks All MIP-map levels from this index on share the same memory, so they are always committed and decommitted together for each array layer.
+    If this is equal to the number of MIP-map levels, the texture has no MIP-map tail.
+    */
+    std::uint32_t   firstPackedMipLevel = 0;
+
+    //! Number of MIP-map levels of the texture.
+    std::uint32_t   numMipLevels        = 0;
+};
+
 
 /* ----- Functions ----- */
 
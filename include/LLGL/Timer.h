@@ -40,6 +40,16 @@ std::cout << "Elapsed time: " << elapsedSeconds * 1000.0 << "ms" << std::endl;
 */
 LLGL_EXPORT std::uint64_t Tick();
 
+/**
+\brief Blocks the calling thread until the specified tick has been reached.
+\param[in] tick Specifies the absolute tick to wait for. This must be a value in the same time domain as Tick. If this tick has already passed, the function returns immediately.
+\remarks This uses the most precise blocking timer of the OS (e.g. high resolution waitable timers on Win32 and \c clock_nanosleep on GNU/Linux),
+but the thread may still be woken up slightly after the specified tick, depending on the scheduler.
+For sub-millisecond precision, wait until shortly before the target tick and spin on Tick for the remainder (see FramePacer).
+\see FramePacer
+*/
+LLGL_EXPORT void WaitUntil(std::uint64_t tick);
+
 
 } // /namespace Timer
 
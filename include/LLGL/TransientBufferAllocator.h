@@ -0,0 +1,165 @@
+/*
+ * TransientBufferAllocator.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_TRANSIENT_BUFFER_ALLOCATOR_H
+#define LLGL_TRANSIENT_BUFFER_ALLOCATOR_H
+
+
+#include <LLGL/NonCopyable.h>
+#include <LLGL/ResourceFlags.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class RenderSystem;
+class Buffer;
+
+/* ----- Structures ----- */
+
+/**
+\brief Transient buffer allocator descriptor structure.
+\see TransientBufferAllocator::TransientBufferAllocator
+*/
+struct TransientBufferAllocatorDescriptor
+{
+    /**
+    \brief Size (in bytes) of each buffer page the allocations are sub-allocated from. By default 4 MB.
+    \remarks Allocations that are larger than the page size get a dedicated page, which is released as soon as the GPU has finished the frame it was used in.
+    */
+    std::uint64_t   pageSize            = 4u * 1024u * 1024u;
+
+    /**
+    \brief Binding flags of the buffer pages. By default BindFlags::ConstantBuffer.
+    \remarks Combine this with BindFlags::VertexBuffer, BindFlags::IndexBuffer, or BindFlags::Sampled to sub-allocate dynamic geometry or structured data from the same pages.
+    \see BindFlags
+    */
+    long            bindFlags           = BindFlags::ConstantBuffer;
+
+    /**
+    \brief Number of frames the CPU can record ahead of the GPU. By default 2.
+    \remarks TransientBufferAllocator::NextFrame blocks until the GPU has finished the frame that was recorded this many frames earlier,
+    so its pages can be recycled for the next frame.
+    */
+    std::uint32_t   maxFramesInFlight   = 2;
+};
+
+/**
+\brief Transient buffer allocation structure.
+\remarks The allocation is only valid for the current frame, i.e. until the next call to TransientBufferAllocator::NextFrame.
+\see TransientBufferAllocator::Allocate
+*/
+struct TransientBufferAllocation
+{
+    //! CPU pointer to the mapped memory of this allocation. This is null if the allocation failed.
+    void*           data    = nullptr;
+
+    //! Buffer page this allocation has been sub-allocated from. This is null if the allocation failed.
+    Buffer*         buffer  = nullptr;
+
+    //! Offset (in bytes) of this allocation within the buffer page.
+    std::uint64_t   offset  = 0;
+
+    //! Size (in bytes) of this allocation.
+    std::uint64_t   size    = 0;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Per-frame allocator for CPU-writable and GPU-readable sub-ranges of shared buffers.
+\remarks This allocator replaces per-draw buffer updates with a single copy into mapped memory:
+Each allocation is a sub-range of a buffer page that is mapped into CPU memory space,
+and all pages of a frame are recycled when the GPU has finished that frame, which is tracked by a fence per frame in flight.
+\remarks The memory written to an allocation only becomes visible for the GPU after the pages have been unmapped,
+i.e. Flush must be called before the command buffer that uses the allocations is submitted.
+For command buffers with the CommandBufferFlags::ImmediateSubmit flag, Flush must be called before the commands that use the allocations are encoded.
+\remarks Here is an example how to update per-object constants for each draw call:
+\code
+LLGL::TransientBufferAllocator myAllocator{ *myRenderer };
+
+// Sub-allocate per-object constants for the current frame
+for (auto& myObject : myScene)
+{
+    LLGL::TransientBufferAllocation myAlloc = myAllocator.Allocate(sizeof(MyObjectConstants));
+    ::memcpy(myAlloc.data, &myObject.constants, sizeof(MyObjectConstants));
+    myObject.constantsBuffer = myAlloc.buffer;
+    myObject.constantsOffset = myAlloc.offset;
+}
+myAllocator.Flush();
+
+// Record draw calls with dynamic offsets and submit command buffer ...
+
+// Retire the current frame and recycle pages of older frames
+myAllocator.NextFrame();
+\endcode
+\note This class is not thread-safe.
+\see BindingFlags::DynamicOffset
+*/
+class LLGL_EXPORT TransientBufferAllocator : public NonCopyable
+{
+
+    public:
+
+        /**
+        \brief Initializes the allocator for the specified render system.
+        \remarks The render system must outlive this allocator. All buffer pages are released with its destruction.
+        */
+        TransientBufferAllocator(RenderSystem& renderSystem, const TransientBufferAllocatorDescriptor& allocatorDesc = {});
+
+        //! Waits until the GPU has finished all frames in flight and releases all buffer pages.
+        ~TransientBufferAllocator();
+
+        /**
+        \brief Sub-allocates the specified number of bytes for the current frame.
+        \param[in] size Specifies the size (in bytes) of the allocation. This must not be zero.
+        \param[in] alignment Specifies the alignment (in bytes) of the allocation offset. This must be a power of two.
+        If this is zero, the largest minimum buffer alignment of the rendering limits that applies to the binding flags of the buffer pages is used.
+        \return Allocation with the CPU pointer, buffer page, and offset. If the buffer page could not be mapped, the members \c data and \c buffer are null.
+        \see RenderingLimits::minConstantBufferAlignment
+        */
+        TransientBufferAllocation Allocate(std::uint64_t size, std::uint64_t alignment = 0);
+
+        /**
+        \brief Unmaps all buffer pages that have been written in the current frame, so their content becomes visible for the GPU.
+        \remarks Subsequent allocations in the same frame map the pages again. This does not change the offsets of previous allocations.
+        */
+        void Flush();
+
+        /**
+        \brief Retires the current frame and begins a new one.
+        \remarks This flushes all pending allocations and submits a fence to the command queue of the render system, so this should be called after the command buffers of the frame have been submitted.
+        If the frame that was recorded TransientBufferAllocatorDescriptor::maxFramesInFlight frames earlier has not been finished by the GPU yet, this function blocks until it has.
+        The buffer pages of that frame are then recycled for the new frame.
+        */
+        void NextFrame();
+
+        //! Returns the number of bytes that have been allocated in the current frame, including alignment padding.
+        std::uint64_t GetFrameAllocatedSize() const;
+
+        //! Returns the total size (in bytes) of all buffer pages that are currently held by this allocator.
+        std::uint64_t GetTotalPageSize() const;
+
+    private:
+
+        struct Pimpl;
+        Pimpl* pimpl_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -20,7 +20,27 @@ namespace LLGL
 {
 
 
-//TODO: this header is currently only included by internal classes
+/* ----- Flags ----- */
+
+/**
+\brief Video adapter flags enumeration.
+\see VideoAdapterDescriptor::flags
+*/
+struct VideoAdapterFlags
+{
+    enum
+    {
+        //! Adapter is a discrete GPU with its own dedicated video memory.
+        Discrete    = (1 << 0),
+
+        //! Adapter is an integrated GPU that shares its memory with the CPU.
+        Integrated  = (1 << 1),
+
+        //! Adapter is a software rasterizer (e.g. WARP or llvmpipe).
+        Software    = (1 << 2),
+    };
+};
+
 
 /* ----- Structures ----- */
 
@@ -38,7 +58,9 @@ struct VideoOutputDescriptor
 /**
 \brief Video adapter descriptor structure.
 \remarks A video adapter determines the output capabilities of a GPU.
-\todo Currently unused in the interface.
+The adapters of a render system module can be enumerated with RenderSystem::QueryVideoAdapters.
+\see RenderSystem::QueryVideoAdapters
+\see RenderSystemDescriptor::adapterIndex
 */
 struct VideoAdapterDescriptor
 {
@@ -48,8 +70,23 @@ struct VideoAdapterDescriptor
     //! Vendor name (e.g. "NVIDIA Corporation", "Advanced Micro Devices, Inc." etc.).
     std::string                         vendor;
 
-    //! Video memory size (in bytes).
-    std::uint64_t                       videoMemory = 0;
+    //! PCI vendor ID of the adapter (e.g. 0x10DE for NVIDIA). Zero if the vendor ID is unknown.
+    std::uint32_t                       vendorID        = 0;
+
+    //! PCI device ID of the adapter. Zero if the device ID is unknown.
+    std::uint32_t                       deviceID        = 0;
+
+    //! Dedicated video memory size (in bytes).
+    std::uint64_t                       videoMemory     = 0;
+
+    //! System memory size (in bytes) that can be shared with the adapter.
+    std::uint64_t                       sharedMemory    = 0;
+
+    /**
+    \brief Specifies the adapter flags. This can be a bitwise OR combination of the VideoAdapterFlags entries. By default 0.
+    \see VideoAdapterFlags
+    */
+    long                                flags           = 0;
 
     //! List of all adapter output descriptors.
     std::vector<VideoOutputDescriptor>  outputs;
@@ -248,6 +248,26 @@ class LLGL_EXPORT Window : public Surface
         */
         void PostTimer(std::uint32_t timerID);
 
+        /**
+        \brief Stores the specified raw mouse event in the internal input ring buffer.
+        \remarks The ring buffer has a fixed capacity. If it is full, the oldest event is overwritten.
+        \see ReadRawMouseEvents
+        */
+        void PostRawMouseEvent(const RawMouseEvent& event);
+
+        /**
+        \brief Reads all buffered raw mouse events in chronological order.
+        \param[out] outEvents Pointer to an array of at least \c maxEvents entries. This can be null to only query the number of pending events.
+        \param[in] maxEvents Specifies the maximum number of events that can be written to \c outEvents.
+        \return Number of events that have been written to \c outEvents, or the number of pending events if \c outEvents is null.
+        \remarks This first polls the platform for pending raw input without dispatching any other window messages,
+        so it can be called right before the simulation step to sample the latest input with minimal latency.
+        All events that have been read are removed from the buffer.
+        \note Only supported on: MS/Windows. On all other platforms, the buffer is only filled by manual calls to \c PostRawMouseEvent.
+        \see PostRawMouseEvent
+        */
+        std::size_t ReadRawMouseEvents(RawMouseEvent* outEvents, std::size_t maxEvents);
+
     protected:
 
         //! Allocates the internal data.
@@ -260,6 +280,13 @@ class LLGL_EXPORT Window : public Surface
         */
         virtual void OnProcessEvents() = 0;
 
+        /**
+        \brief Called inside the "ReadRawMouseEvents" function to poll all pending raw input from the platform.
+        \remarks The default implementation does nothing. Implementations must pass the input to \c PostRawMouseEvent.
+        \see ReadRawMouseEvents
+        */
+        virtual void OnPollRawInput();
+
     private:
 
         struct Pimpl;
@@ -71,6 +71,15 @@ struct WindowDescriptor
     //! Specifies whether the window is centered within the desktop screen. By default false.
     bool            centered            = false;
 
+    /**
+    \brief Specifies whether the input events of the window are pumped on a dedicated thread. By default false.
+    \remarks If enabled, a dedicated thread receives all input events as soon as they arrive and stores them in a lock-free queue.
+    Window::ProcessEvents then only dispatches the queued events to the event listeners and never waits for the connection to the window server.
+    The event listeners are still invoked on the thread that calls Window::ProcessEvents.
+    \note Only supported on: Linux.
+    */
+    bool            threadedEvents      = false;
+
     /**
     \brief Window context handle.
     \remarks If used, this must be casted from a platform specific structure:
@@ -110,6 +119,24 @@ struct WindowBehavior
     std::uint32_t   moveAndResizeTimerID    = Constants::invalidTimerID;
 };
 
+/**
+\brief Raw mouse input event with a high-resolution timestamp.
+\remarks Raw mouse events are buffered by the window as they arrive and can be read in a batch with Window::ReadRawMouseEvents,
+e.g. to sample all input right before the simulation step instead of relying on the event listener callbacks.
+\see Window::ReadRawMouseEvents
+*/
+struct RawMouseEvent
+{
+    //! Timestamp when the input was received. This is in the same domain as Timer::Tick and can be converted with Timer::Frequency.
+    std::uint64_t   timestamp   = 0;
+
+    //! Relative mouse motion, independent of the cursor position and acceleration.
+    Offset2D        motion;
+
+    //! Mouse wheel motion. Positive values denote forward motion, negative values denote backward motion.
+    int             wheelMotion = 0;
+};
+
 
 } // /namespace LLGL
 
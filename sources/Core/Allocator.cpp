@@ -0,0 +1,126 @@
+/*
+ * Allocator.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/Allocator.h>
+#include <atomic>
+#include <new>
+
+
+namespace LLGL
+{
+
+namespace Allocator
+{
+
+
+struct AllocatorState
+{
+    Callbacks                   callbacks;
+    std::atomic<std::uint64_t>  numAllocations;
+    std::atomic<std::uint64_t>  numFrees;
+    std::atomic<std::uint64_t>  numBytesAllocated;
+};
+
+static AllocatorState g_allocatorState;
+
+/*
+The global operator new only guarantees the alignment of std::max_align_t in C++11,
+so blocks with a larger alignment are over-allocated and store the original pointer in front of the aligned block.
+*/
+static void* DefaultAllocate(std::size_t size, std::size_t alignment)
+{
+    if (alignment <= alignof(std::max_align_t))
+        return ::operator new(size);
+
+    void* block = ::operator new(size + alignment + sizeof(void*));
+    auto alignedAddr = (reinterpret_cast<std::uintptr_t>(block) + sizeof(void*) + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    void* alignedBlock = reinterpret_cast<void*>(alignedAddr);
+    reinterpret_cast<void**>(alignedBlock)[-1] = block;
+    return alignedBlock;
+}
+
+static void DefaultFree(void* block, std::size_t alignment)
+{
+    if (alignment <= alignof(std::max_align_t))
+        ::operator delete(block);
+    else
+        ::operator delete(reinterpret_cast<void**>(block)[-1]);
+}
+
+LLGL_EXPORT void SetCallbacks(const Callbacks& callbacks)
+{
+    if (callbacks.allocate != nullptr && callbacks.free != nullptr)
+        g_allocatorState.callbacks = callbacks;
+    else
+        g_allocatorState.callbacks = Callbacks{};
+}
+
+LLGL_EXPORT Callbacks GetCallbacks()
+{
+    return g_allocatorState.callbacks;
+}
+
+LLGL_EXPORT void* Allocate(std::size_t size, std::size_t alignment)
+{
+    /* Allocate at least one byte, so each allocation returns a unique block */
+    if (size == 0)
+        size = 1;
+
+    void* block = nullptr;
+
+    const auto& callbacks = g_allocatorState.callbacks;
+    if (callbacks.allocate != nullptr)
+    {
+        block = callbacks.allocate(size, alignment, callbacks.userData);
+        if (block == nullptr)
+            throw std::bad_alloc();
+    }
+    else
+        block = DefaultAllocate(size, alignment);
+
+    g_allocatorState.numAllocations.fetch_add(1, std::memory_order_relaxed);
+    g_allocatorState.numBytesAllocated.fetch_add(size, std::memory_order_relaxed);
+
+    return block;
+}
+
+LLGL_EXPORT void Free(void* block, std::size_t size, std::size_t alignment)
+{
+    if (block == nullptr)
+        return;
+
+    if (size == 0)
+        size = 1;
+
+    const auto& callbacks = g_allocatorState.callbacks;
+    if (callbacks.free != nullptr)
+        callbacks.free(block, size, alignment, callbacks.userData);
+    else
+        DefaultFree(block, alignment);
+
+    g_allocatorState.numFrees.fetch_add(1, std::memory_order_relaxed);
+}
+
+LLGL_EXPORT Statistics GetStatistics()
+{
+    Statistics stats;
+    {
+        stats.numAllocations    = g_allocatorState.numAllocations.load(std::memory_order_relaxed);
+        stats.numFrees          = g_allocatorState.numFrees.load(std::memory_order_relaxed);
+        stats.numBytesAllocated = g_allocatorState.numBytesAllocated.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+
+} // /namespace Allocator
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
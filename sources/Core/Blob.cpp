@@ -7,9 +7,20 @@
 
 #include <LLGL/Blob.h>
 #include <LLGL/ImageFlags.h>
+#include <LLGL/Platform/Platform.h>
 #include <fstream>
 #include "Helper.h"
 
+#ifdef LLGL_OS_WIN32
+#   include "../Platform/Win32/Win32LeanAndMean.h"
+#   include <Windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
 
 namespace LLGL
 {
@@ -151,6 +162,134 @@ using BlobStdVectorInt8 = BlobContainer<std::vector<std::int8_t>>;
 using BlobStdString     = BlobContainer<std::string>;
 
 
+/*
+ * BlobFileMapping class
+ */
+
+// Read-only memory-mapped file implementation of <Blob> interface.
+class BlobFileMapping final : public Blob
+{
+
+    public:
+
+        BlobFileMapping(const void* data, std::size_t size);
+        ~BlobFileMapping();
+
+    public:
+
+        const void* GetData() const override;
+        std::size_t GetSize() const override;
+
+    public:
+
+        // Maps the specified file into memory and returns null on failure.
+        static std::unique_ptr<Blob> MapFile(const char* filename);
+
+    private:
+
+        const void* data_ = nullptr;
+        std::size_t size_ = 0;
+
+};
+
+BlobFileMapping::BlobFileMapping(const void* data, std::size_t size) :
+    data_ { data },
+    size_ { size }
+{
+}
+
+BlobFileMapping::~BlobFileMapping()
+{
+    #ifdef LLGL_OS_WIN32
+    ::UnmapViewOfFile(data_);
+    #else
+    ::munmap(const_cast<void*>(data_), size_);
+    #endif
+}
+
+const void* BlobFileMapping::GetData() const
+{
+    return data_;
+}
+
+std::size_t BlobFileMapping::GetSize() const
+{
+    return size_;
+}
+
+#ifdef LLGL_OS_WIN32
+
+std::unique_ptr<Blob> BlobFileMapping::MapFile(const char* filename)
+{
+    /* Open file for read access */
+    HANDLE file = ::CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return nullptr;
+
+    LARGE_INTEGER fileSize;
+    if (!::GetFileSizeEx(file, &fileSize))
+    {
+        ::CloseHandle(file);
+        return nullptr;
+    }
+
+    /* Empty files cannot be mapped into memory */
+    if (fileSize.QuadPart == 0)
+    {
+        ::CloseHandle(file);
+        return MakeUnique<BlobUnmanaged>(nullptr, 0);
+    }
+
+    /* Map entire file into memory; the mapped view keeps the file mapping alive after its handles are closed */
+    HANDLE fileMapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    ::CloseHandle(file);
+    if (fileMapping == nullptr)
+        return nullptr;
+
+    const void* data = ::MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+    ::CloseHandle(fileMapping);
+    if (data == nullptr)
+        return nullptr;
+
+    return MakeUnique<BlobFileMapping>(data, static_cast<std::size_t>(fileSize.QuadPart));
+}
+
+#else
+
+std::unique_ptr<Blob> BlobFileMapping::MapFile(const char* filename)
+{
+    /* Open file for read access */
+    int fd = ::open(filename, O_RDONLY);
+    if (fd == -1)
+        return nullptr;
+
+    struct stat fileStat;
+    if (::fstat(fd, &fileStat) != 0)
+    {
+        ::close(fd);
+        return nullptr;
+    }
+
+    /* Empty files cannot be mapped into memory */
+    const auto fileSize = static_cast<std::size_t>(fileStat.st_size);
+    if (fileSize == 0)
+    {
+        ::close(fd);
+        return MakeUnique<BlobUnmanaged>(nullptr, 0);
+    }
+
+    /* Map entire file into memory; the mapping remains valid after the file descriptor is closed */
+    void* data = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+        return nullptr;
+
+    return MakeUnique<BlobFileMapping>(data, fileSize);
+}
+
+#endif
+
+
 /*
  * Blob class
  */
@@ -203,6 +342,18 @@ std::unique_ptr<Blob> Blob::CreateFromFile(const std::string& filename)
     return CreateFromFile(filename.c_str());
 }
 
+std::unique_ptr<Blob> Blob::CreateFromFileMapping(const char* filename)
+{
+    if (filename == nullptr || *filename == '\0')
+        return nullptr;
+    return BlobFileMapping::MapFile(filename);
+}
+
+std::unique_ptr<Blob> Blob::CreateFromFileMapping(const std::string& filename)
+{
+    return CreateFromFileMapping(filename.c_str());
+}
+
 
 } // /namespace LLGL
 
@@ -0,0 +1,295 @@
+/*
+ * BlockCompressor.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "BlockCompressor.h"
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+/*
+Each sequence of the LZ4 block format consists of:
+- Token:            High 4 bits specify the literal length, low 4 bits specify the match length minus 4. A value of 15 is continued with extra bytes.
+- Literal length:   Extra bytes of 255 terminated by a byte less than 255, which are added to the literal length.
+- Literals:         Uncompressed bytes.
+- Offset:           16-bit little endian distance to the begin of the match, which is copied from the decompressed output.
+- Match length:     Extra bytes as for the literal length.
+The last sequence only consists of the token and literals. The last 5 bytes are always literals
+and the last match must begin at least 12 bytes before the end of the block, so decoders can copy in larger steps.
+*/
+
+static const std::size_t    g_minMatch          = 4;
+static const std::size_t    g_lastLiterals      = 5;
+static const std::size_t    g_matchFindLimit    = 12;
+static const std::size_t    g_maxOffset         = 65535;
+static const unsigned       g_hashBits          = 12;
+static const std::uint32_t  g_runMask           = 15;
+
+static std::uint32_t ReadUInt32(const std::uint8_t* ptr)
+{
+    std::uint32_t value;
+    ::memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+static std::uint32_t HashSequence(std::uint32_t sequence)
+{
+    return ((sequence * 2654435761u) >> (32u - g_hashBits));
+}
+
+// Returns the number of bytes to encode the specified length with its extra bytes (excluding the token).
+static std::size_t GetLengthExtraSize(std::size_t length)
+{
+    return (length >= g_runMask ? (length - g_runMask) / 255 + 1 : 0);
+}
+
+static std::uint8_t* WriteLengthExtra(std::uint8_t* dst, std::size_t length)
+{
+    if (length >= g_runMask)
+    {
+        length -= g_runMask;
+        for (; length >= 255; length -= 255)
+            *dst++ = 255;
+        *dst++ = static_cast<std::uint8_t>(length);
+    }
+    return dst;
+}
+
+static bool ReadLengthExtra(const std::uint8_t*& src, const std::uint8_t* srcEnd, std::size_t& length)
+{
+    if (length == g_runMask)
+    {
+        std::uint8_t byte;
+        do
+        {
+            if (src >= srcEnd)
+                return false;
+            byte = *src++;
+            length += byte;
+        }
+        while (byte == 255);
+    }
+    return true;
+}
+
+LLGL_EXPORT std::size_t GetMaxCompressedBlockSize(std::size_t srcSize)
+{
+    return (srcSize + srcSize / 255 + 16);
+}
+
+// Writes a sequence of literals and an optional match; returns null if the sequence does not fit into the destination buffer.
+static std::uint8_t* WriteSequence(
+    std::uint8_t*       dst,
+    std::uint8_t*       dstEnd,
+    const std::uint8_t* literals,
+    std::size_t         numLiterals,
+    std::size_t         offset,
+    std::size_t         matchLength)
+{
+    const std::size_t matchCode = (matchLength > 0 ? matchLength - g_minMatch : 0);
+    const std::size_t sequenceSize =
+    (
+        1 + GetLengthExtraSize(numLiterals) + numLiterals +
+        (matchLength > 0 ? 2 + GetLengthExtraSize(matchCode) : 0)
+    );
+
+    if (sequenceSize > static_cast<std::size_t>(dstEnd - dst))
+        return nullptr;
+
+    /* Write token and literals */
+    *dst++ = static_cast<std::uint8_t>(
+        (numLiterals < g_runMask ? numLiterals : g_runMask) << 4 |
+        (matchCode   < g_runMask ? matchCode   : g_runMask)
+    );
+    dst = WriteLengthExtra(dst, numLiterals);
+    ::memcpy(dst, literals, numLiterals);
+    dst += numLiterals;
+
+    /* Write offset and match length */
+    if (matchLength > 0)
+    {
+        *dst++ = static_cast<std::uint8_t>(offset & 0xFF);
+        *dst++ = static_cast<std::uint8_t>(offset >> 8);
+        dst = WriteLengthExtra(dst, matchCode);
+    }
+
+    return dst;
+}
+
+LLGL_EXPORT std::size_t CompressBlock(const void* src, std::size_t srcSize, void* dst, std::size_t dstCapacity)
+{
+    const std::uint8_t* srcBegin    = reinterpret_cast<const std::uint8_t*>(src);
+    const std::uint8_t* srcEnd      = srcBegin + srcSize;
+    const std::uint8_t* ip          = srcBegin;
+    const std::uint8_t* anchor      = srcBegin;
+    std::uint8_t*       op          = reinterpret_cast<std::uint8_t*>(dst);
+    std::uint8_t*       dstEnd      = op + dstCapacity;
+
+    /* Empty input is encoded as a single token without literals; return early, since the source may be null */
+    if (srcSize == 0)
+    {
+        if (dstCapacity == 0)
+            return 0;
+        *op = 0;
+        return 1;
+    }
+
+    if (srcSize > g_matchFindLimit)
+    {
+        /* Greedy match finder with a single candidate per hash entry; zero initialized entries are rejected by comparing the sequences */
+        std::uint32_t hashTable[1u << g_hashBits] = {};
+
+        const std::uint8_t* matchFindEnd    = srcEnd - g_matchFindLimit;
+        const std::uint8_t* matchEnd        = srcEnd - g_lastLiterals;
+
+        while (ip < matchFindEnd)
+        {
+            const std::uint32_t sequence    = ReadUInt32(ip);
+            const std::uint32_t hash        = HashSequence(sequence);
+            const std::uint8_t* ref         = srcBegin + hashTable[hash];
+
+            hashTable[hash] = static_cast<std::uint32_t>(ip - srcBegin);
+
+            if (ref >= ip || static_cast<std::size_t>(ip - ref) > g_maxOffset || ReadUInt32(ref) != sequence)
+            {
+                ++ip;
+                continue;
+            }
+
+            /* Extend match forwards, but keep the last literals */
+            const std::uint8_t* matchBegin = ip;
+            ip  += g_minMatch;
+            ref += g_minMatch;
+            while (ip < matchEnd && *ip == *ref)
+            {
+                ++ip;
+                ++ref;
+            }
+
+            op = WriteSequence(
+                op,
+                dstEnd,
+                anchor,
+                static_cast<std::size_t>(matchBegin - anchor),
+                static_cast<std::size_t>(ip - ref),
+                static_cast<std::size_t>(ip - matchBegin)
+            );
+            if (op == nullptr)
+                return 0;
+
+            anchor = ip;
+        }
+    }
+
+    /* Write last literals */
+    op = WriteSequence(op, dstEnd, anchor, static_cast<std::size_t>(srcEnd - anchor), 0, 0);
+    if (op == nullptr)
+        return 0;
+
+    return static_cast<std::size_t>(op - reinterpret_cast<std::uint8_t*>(dst));
+}
+
+LLGL_EXPORT bool DecompressBlock(const void* src, std::size_t srcSize, void* dst, std::size_t dstSize)
+{
+    const std::uint8_t* ip          = reinterpret_cast<const std::uint8_t*>(src);
+    const std::uint8_t* srcEnd      = ip + srcSize;
+    std::uint8_t*       dstBegin    = reinterpret_cast<std::uint8_t*>(dst);
+    std::uint8_t*       op          = dstBegin;
+    std::uint8_t*       dstEnd      = dstBegin + dstSize;
+
+    /* Empty output can only be decoded from an empty block or a single token without literals; return early, since the destination may be null */
+    if (dstSize == 0)
+        return (srcSize == 0 || (srcSize == 1 && ip[0] == 0));
+
+    while (ip < srcEnd)
+    {
+        const std::uint8_t token = *ip++;
+
+        /* Copy literals */
+        std::size_t numLiterals = (token >> 4);
+        if (!ReadLengthExtra(ip, srcEnd, numLiterals))
+            return false;
+        if (numLiterals > static_cast<std::size_t>(srcEnd - ip) || numLiterals > static_cast<std::size_t>(dstEnd - op))
+            return false;
+
+        ::memcpy(op, ip, numLiterals);
+        ip += numLiterals;
+        op += numLiterals;
+
+        /* Last sequence only consists of literals */
+        if (ip == srcEnd)
+            break;
+
+        /* Copy match from decompressed output */
+        if (srcEnd - ip < 2)
+            return false;
+
+        const std::size_t offset = (static_cast<std::size_t>(ip[0]) | static_cast<std::size_t>(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<std::size_t>(op - dstBegin))
+            return false;
+
+        std::size_t matchLength = (token & g_runMask);
+        if (!ReadLengthExtra(ip, srcEnd, matchLength))
+            return false;
+        matchLength += g_minMatch;
+        if (matchLength > static_cast<std::size_t>(dstEnd - op))
+            return false;
+
+        const std::uint8_t* match = op - offset;
+        if (offset >= matchLength)
+            ::memcpy(op, match, matchLength);
+        else
+        {
+            /* Overlapping match repeats the last 'offset' bytes */
+            for (std::size_t i = 0; i < matchLength; ++i)
+                op[i] = match[i];
+        }
+        op += matchLength;
+    }
+
+    return (op == dstEnd);
+}
+
+static void GenerateCRC32Table(std::uint32_t (&table)[256])
+{
+    for (std::uint32_t i = 0; i < 256; ++i)
+    {
+        std::uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit)
+            crc = ((crc & 1) != 0 ? (crc >> 1) ^ 0xEDB88320u : (crc >> 1));
+        table[i] = crc;
+    }
+}
+
+LLGL_EXPORT std::uint32_t ComputeCRC32(const void* data, std::size_t size, std::uint32_t crc)
+{
+    struct CRC32Table
+    {
+        CRC32Table()
+        {
+            GenerateCRC32Table(entries);
+        }
+        std::uint32_t entries[256];
+    };
+    static const CRC32Table table;
+
+    auto bytes = reinterpret_cast<const std::uint8_t*>(data);
+    crc = ~crc;
+    for (std::size_t i = 0; i < size; ++i)
+        crc = table.entries[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
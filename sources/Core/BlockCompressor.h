@@ -0,0 +1,47 @@
+/*
+ * BlockCompressor.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_BLOCK_COMPRESSOR_H
+#define LLGL_BLOCK_COMPRESSOR_H
+
+
+#include <LLGL/Export.h>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+// Returns the maximum size (in bytes) of a compressed block for the specified uncompressed size.
+LLGL_EXPORT std::size_t GetMaxCompressedBlockSize(std::size_t srcSize);
+
+/*
+Compresses the specified data into a single block of the LZ4 block format, which is optimized for decoding speed rather than ratio.
+Returns the size (in bytes) of the compressed block or zero if the compressed block does not fit into the destination buffer.
+*/
+LLGL_EXPORT std::size_t CompressBlock(const void* src, std::size_t srcSize, void* dst, std::size_t dstCapacity);
+
+/*
+Decompresses the specified block that was compressed with CompressBlock.
+Returns false if the block is malformed or does not decompress into exactly 'dstSize' bytes. No data is read or written out of bounds in either case.
+*/
+LLGL_EXPORT bool DecompressBlock(const void* src, std::size_t srcSize, void* dst, std::size_t dstSize);
+
+// Returns the CRC-32 checksum (IEEE 802.3 polynomial) of the specified data. Pass a previous checksum to continue it over multiple ranges.
+LLGL_EXPORT std::uint32_t ComputeCRC32(const void* data, std::size_t size, std::uint32_t crc = 0);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
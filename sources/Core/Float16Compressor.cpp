@@ -6,6 +6,27 @@
  */
 
 #include "Float16Compressor.h"
+#include <LLGL/Platform/Platform.h>
+#include <cstring>
+
+#if defined LLGL_ARCH_AMD64
+#   include <emmintrin.h>
+#   include <immintrin.h>
+#   ifdef _MSC_VER
+#       include <intrin.h>
+#   else
+#       include <cpuid.h>
+#   endif
+#elif defined LLGL_ARCH_ARM64
+#   include <arm_neon.h>
+#endif
+
+// GCC and Clang only allow AVX and F16C intrinsics in functions that are compiled for these instruction sets
+#if defined LLGL_ARCH_AMD64 && (defined __GNUC__ || defined __clang__)
+#   define LLGL_TARGET_F16C __attribute__((target("avx,f16c")))
+#else
+#   define LLGL_TARGET_F16C
+#endif
 
 
 namespace LLGL
@@ -58,6 +79,74 @@ class Float16Compressor
             return v.f;
         }
 
+        #ifdef LLGL_ARCH_AMD64
+
+        // SSE2 version of Compress for four values at once. Returns the 16-bit floats in the lower half of each 32-bit lane.
+        static __m128i Compress4(__m128 value)
+        {
+            __m128i v = _mm_castps_si128(value);
+            __m128i sign = _mm_and_si128(v, _mm_set1_epi32(signN));
+            v = _mm_xor_si128(v, sign);
+            sign = _mm_srli_epi32(sign, shiftSign);
+            __m128i s = _mm_cvttps_epi32(_mm_mul_ps(_mm_castsi128_ps(_mm_set1_epi32(mulN)), _mm_castsi128_ps(v)));
+            v = Select(v, s, _mm_cmpgt_epi32(_mm_set1_epi32(minN), v));
+            v = Select(v, _mm_set1_epi32(infN), _mm_and_si128(_mm_cmpgt_epi32(_mm_set1_epi32(infN), v), _mm_cmpgt_epi32(v, _mm_set1_epi32(maxN))));
+            v = Select(v, _mm_set1_epi32(nanN), _mm_and_si128(_mm_cmpgt_epi32(_mm_set1_epi32(nanN), v), _mm_cmpgt_epi32(v, _mm_set1_epi32(infN))));
+            v = _mm_srli_epi32(v, shift);
+            v = Select(v, _mm_sub_epi32(v, _mm_set1_epi32(maxD)), _mm_cmpgt_epi32(v, _mm_set1_epi32(maxC)));
+            v = Select(v, _mm_sub_epi32(v, _mm_set1_epi32(minD)), _mm_cmpgt_epi32(v, _mm_set1_epi32(subC)));
+            return _mm_or_si128(v, sign);
+        }
+
+        // SSE2 version of Decompress for four values at once, given in the lower half of each 32-bit lane.
+        static __m128 Decompress4(__m128i value)
+        {
+            __m128i v = value;
+            __m128i sign = _mm_and_si128(v, _mm_set1_epi32(signC & 0xFFFF));
+            v = _mm_xor_si128(v, sign);
+            sign = _mm_slli_epi32(sign, shiftSign);
+            v = Select(v, _mm_add_epi32(v, _mm_set1_epi32(minD)), _mm_cmpgt_epi32(v, _mm_set1_epi32(subC)));
+            v = Select(v, _mm_add_epi32(v, _mm_set1_epi32(maxD)), _mm_cmpgt_epi32(v, _mm_set1_epi32(maxC)));
+            __m128i s = _mm_castps_si128(_mm_mul_ps(_mm_castsi128_ps(_mm_set1_epi32(mulC)), _mm_cvtepi32_ps(v)));
+            __m128i mask = _mm_cmpgt_epi32(_mm_set1_epi32(norC), v);
+            v = _mm_slli_epi32(v, shift);
+            v = Select(v, s, mask);
+            return _mm_castsi128_ps(_mm_or_si128(v, sign));
+        }
+
+        #elif defined LLGL_ARCH_ARM64
+
+        // NEON version of Compress for four values at once. Returns the 16-bit floats in the lower half of each 32-bit lane.
+        static uint32x4_t Compress4(float32x4_t value)
+        {
+            int32x4_t v = vreinterpretq_s32_f32(value);
+            int32x4_t sign = vandq_s32(v, vdupq_n_s32(signN));
+            v = veorq_s32(v, sign);
+            sign = vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(sign), shiftSign));
+            int32x4_t s = vcvtq_s32_f32(vmulq_f32(vreinterpretq_f32_s32(vdupq_n_s32(mulN)), vreinterpretq_f32_s32(v)));
+            v = vbslq_s32(vcgtq_s32(vdupq_n_s32(minN), v), s, v);
+            v = vbslq_s32(vandq_u32(vcgtq_s32(vdupq_n_s32(infN), v), vcgtq_s32(v, vdupq_n_s32(maxN))), vdupq_n_s32(infN), v);
+            v = vbslq_s32(vandq_u32(vcgtq_s32(vdupq_n_s32(nanN), v), vcgtq_s32(v, vdupq_n_s32(infN))), vdupq_n_s32(nanN), v);
+            v = vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(v), shift));
+            v = vbslq_s32(vcgtq_s32(v, vdupq_n_s32(maxC)), vsubq_s32(v, vdupq_n_s32(maxD)), v);
+            v = vbslq_s32(vcgtq_s32(v, vdupq_n_s32(subC)), vsubq_s32(v, vdupq_n_s32(minD)), v);
+            return vreinterpretq_u32_s32(vorrq_s32(v, sign));
+        }
+
+        #endif // /LLGL_ARCH_AMD64
+
+    private:
+
+        #ifdef LLGL_ARCH_AMD64
+
+        // Returns 'b' for each lane whose mask is set and 'a' otherwise, equivalent to "a ^= (b ^ a) & mask" of the scalar versions.
+        static __m128i Select(__m128i a, __m128i b, __m128i mask)
+        {
+            return _mm_xor_si128(a, _mm_and_si128(_mm_xor_si128(b, a), mask));
+        }
+
+        #endif // /LLGL_ARCH_AMD64
+
     private:
 
         union Bits
@@ -93,6 +182,286 @@ class Float16Compressor
 };
 
 
+/*
+Lookup tables for the scalar array conversions, see "Fast Half Float Conversions" by Jeroen van der Zijp.
+Both conversions truncate the mantissa, so they produce the same results as the Float16Compressor class,
+except for 32-bit floats beyond the largest 16-bit float normal, which must be compressed with Float16Compressor::Compress.
+*/
+struct Float16Tables
+{
+    Float16Tables();
+
+    std::uint16_t compressBase[512];
+    std::uint8_t  compressShift[512];
+    std::uint32_t decompressMantissa[2048];
+    std::uint32_t decompressExponent[64];
+    std::uint16_t decompressOffset[64];
+};
+
+Float16Tables::Float16Tables()
+{
+    /* Generate tables to compress 32-bit floats, indexed by sign and exponent */
+    for (int i = 0; i < 256; ++i)
+    {
+        const int e = i - 127;
+        std::uint16_t base;
+        std::uint8_t shift;
+
+        if (e < -24)
+        {
+            /* Very small numbers map to zero */
+            base    = 0x0000;
+            shift   = 24;
+        }
+        else if (e < -14)
+        {
+            /* Small numbers map to subnormals */
+            base    = static_cast<std::uint16_t>(0x0400 >> (-e - 14));
+            shift   = static_cast<std::uint8_t>(-e - 1);
+        }
+        else if (e <= 15)
+        {
+            /* Normal numbers only lose precision */
+            base    = static_cast<std::uint16_t>((e + 15) << 10);
+            shift   = 13;
+        }
+        else
+        {
+            /* Large numbers, infinity, and NaN are handled by Float16Compressor::Compress */
+            base    = 0x7C00;
+            shift   = 24;
+        }
+
+        compressBase[i        ] = base;
+        compressBase[i | 0x100] = static_cast<std::uint16_t>(base | 0x8000);
+        compressShift[i        ] = shift;
+        compressShift[i | 0x100] = shift;
+    }
+
+    /* Generate tables to decompress 16-bit floats */
+    decompressMantissa[0] = 0;
+    for (std::uint32_t i = 1; i < 1024; ++i)
+    {
+        /* Normalize subnormal mantissa */
+        std::uint32_t m = (i << 13);
+        std::uint32_t e = 0;
+        while ((m & 0x00800000) == 0)
+        {
+            e -= 0x00800000;
+            m <<= 1;
+        }
+        m &= ~0x00800000u;
+        e += 0x38800000;
+        decompressMantissa[i] = (m | e);
+    }
+    for (std::uint32_t i = 1024; i < 2048; ++i)
+        decompressMantissa[i] = 0x38000000 + ((i - 1024) << 13);
+
+    for (std::uint32_t i = 0; i < 32; ++i)
+    {
+        const std::uint32_t e = (i == 31 ? 0x47800000 : (i << 23));
+        decompressExponent[i     ] = e;
+        decompressExponent[i + 32] = (e | 0x80000000);
+        decompressOffset[i     ] = (i == 0 ? 0 : 1024);
+        decompressOffset[i + 32] = (i == 0 ? 0 : 1024);
+    }
+}
+
+static const Float16Tables& GetFloat16Tables()
+{
+    static const Float16Tables tables;
+    return tables;
+}
+
+static void CompressFloat16ArrayWithTables(const float* src, std::uint16_t* dst, std::size_t count)
+{
+    const auto& tables = GetFloat16Tables();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::uint32_t bits;
+        ::memcpy(&bits, &src[i], sizeof(bits));
+        if ((bits & 0x7FFFFFFF) <= 0x477FE000)
+        {
+            const std::uint32_t idx = (bits >> 23);
+            dst[i] = static_cast<std::uint16_t>(tables.compressBase[idx] + ((bits & 0x007FFFFF) >> tables.compressShift[idx]));
+        }
+        else
+            dst[i] = Float16Compressor::Compress(src[i]);
+    }
+}
+
+static void DecompressFloat16ArrayWithTables(const std::uint16_t* src, float* dst, std::size_t count)
+{
+    const auto& tables = GetFloat16Tables();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const std::uint32_t idx     = (src[i] >> 10);
+        const std::uint32_t bits    = tables.decompressMantissa[tables.decompressOffset[idx] + (src[i] & 0x03FF)] + tables.decompressExponent[idx];
+        ::memcpy(&dst[i], &bits, sizeof(bits));
+    }
+}
+
+#ifdef LLGL_ARCH_AMD64
+
+// Returns true if the CPU supports F16C and the OS saves the AVX registers.
+static bool IsF16CSupported()
+{
+    const unsigned requiredBits = ((1u << 27) | (1u << 28) | (1u << 29)); // OSXSAVE, AVX, F16C
+
+    #ifdef _MSC_VER
+
+    int info[4];
+    __cpuid(info, 1);
+    if ((static_cast<unsigned>(info[2]) & requiredBits) != requiredBits)
+        return false;
+    return ((_xgetbv(0) & 0x6) == 0x6);
+
+    #else
+
+    unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0 || (ecx & requiredBits) != requiredBits)
+        return false;
+    unsigned xcr0Lo = 0, xcr0Hi = 0;
+    __asm__ volatile ("xgetbv" : "=a"(xcr0Lo), "=d"(xcr0Hi) : "c"(0));
+    return ((xcr0Lo & 0x6) == 0x6);
+
+    #endif
+}
+
+/*
+Compresses blocks of eight values with F16C and returns the number of compressed values.
+The hardware conversion truncates just like Float16Compressor, but rounds values beyond the largest normal to that normal instead of infinity
+and preserves NaN payloads differently, so blocks with such values are compressed with Float16Compressor::Compress instead.
+*/
+LLGL_TARGET_F16C
+static std::size_t CompressFloat16ArrayF16C(const float* src, std::uint16_t* dst, std::size_t count)
+{
+    const __m256 absMask    = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    const __m256 maxNormal  = _mm256_set1_ps(65504.0f);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 v = _mm256_loadu_ps(src + i);
+        if (_mm256_movemask_ps(_mm256_cmp_ps(_mm256_and_ps(v, absMask), maxNormal, _CMP_NLE_UQ)) != 0)
+        {
+            for (std::size_t j = i; j < i + 8; ++j)
+                dst[j] = Float16Compressor::Compress(src[j]);
+        }
+        else
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm256_cvtps_ph(v, _MM_FROUND_TO_ZERO));
+    }
+
+    return i;
+}
+
+/*
+Decompresses blocks of eight values with F16C and returns the number of decompressed values.
+The hardware conversion is exact, but sets the quiet bit of signaling NaN, so blocks with NaN are decompressed with Float16Compressor::Decompress instead.
+*/
+LLGL_TARGET_F16C
+static std::size_t DecompressFloat16ArrayF16C(const std::uint16_t* src, float* dst, std::size_t count)
+{
+    const __m128i absMask   = _mm_set1_epi16(0x7FFF);
+    const __m128i infinity  = _mm_set1_epi16(0x7C00);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        if (_mm_movemask_epi8(_mm_cmpgt_epi16(_mm_and_si128(v, absMask), infinity)) != 0)
+        {
+            for (std::size_t j = i; j < i + 8; ++j)
+                dst[j] = Float16Compressor::Decompress(src[j]);
+        }
+        else
+            _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(v));
+    }
+
+    return i;
+}
+
+// Compresses blocks of eight values with SSE2 and returns the number of compressed values.
+static std::size_t CompressFloat16ArraySSE2(const float* src, std::uint16_t* dst, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        /* Sign-extend the 16-bit results, so the signed saturation of the pack instruction leaves them unchanged */
+        __m128i lo = Float16Compressor::Compress4(_mm_loadu_ps(src + i));
+        __m128i hi = Float16Compressor::Compress4(_mm_loadu_ps(src + i + 4));
+        lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+        hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(lo, hi));
+    }
+    return i;
+}
+
+// Decompresses blocks of eight values with SSE2 and returns the number of decompressed values.
+static std::size_t DecompressFloat16ArraySSE2(const std::uint16_t* src, float* dst, std::size_t count)
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_ps(dst + i,     Float16Compressor::Decompress4(_mm_unpacklo_epi16(v, zero)));
+        _mm_storeu_ps(dst + i + 4, Float16Compressor::Decompress4(_mm_unpackhi_epi16(v, zero)));
+    }
+    return i;
+}
+
+#elif defined LLGL_ARCH_ARM64
+
+/*
+Compresses blocks of eight values with NEON and returns the number of compressed values.
+The hardware conversion (FCVTN) rounds to nearest, so the integer version of Float16Compressor::Compress is used to keep the results identical.
+*/
+static std::size_t CompressFloat16ArrayNEON(const float* src, std::uint16_t* dst, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const uint16x4_t lo = vmovn_u32(Float16Compressor::Compress4(vld1q_f32(src + i)));
+        const uint16x4_t hi = vmovn_u32(Float16Compressor::Compress4(vld1q_f32(src + i + 4)));
+        vst1q_u16(dst + i, vcombine_u16(lo, hi));
+    }
+    return i;
+}
+
+/*
+Decompresses blocks of eight values with NEON (FCVTL) and returns the number of decompressed values.
+The hardware conversion is exact, but sets the quiet bit of signaling NaN, so blocks with NaN are decompressed with Float16Compressor::Decompress instead.
+*/
+static std::size_t DecompressFloat16ArrayNEON(const std::uint16_t* src, float* dst, std::size_t count)
+{
+    const uint16x8_t absMask  = vdupq_n_u16(0x7FFF);
+    const uint16x8_t infinity = vdupq_n_u16(0x7C00);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const uint16x8_t v = vld1q_u16(src + i);
+        if (vmaxvq_u16(vcgtq_u16(vandq_u16(v, absMask), infinity)) != 0)
+        {
+            for (std::size_t j = i; j < i + 8; ++j)
+                dst[j] = Float16Compressor::Decompress(src[j]);
+        }
+        else
+        {
+            vst1q_f32(dst + i,     vcvt_f32_f16(vreinterpret_f16_u16(vget_low_u16(v))));
+            vst1q_f32(dst + i + 4, vcvt_f32_f16(vreinterpret_f16_u16(vget_high_u16(v))));
+        }
+    }
+    return i;
+}
+
+#endif // /LLGL_ARCH_AMD64
+
+
+/* ----- Functions ----- */
+
 LLGL_EXPORT std::uint16_t CompressFloat16(float value)
 {
     return Float16Compressor::Compress(value);
@@ -103,6 +472,49 @@ LLGL_EXPORT float DecompressFloat16(std::uint16_t value)
     return Float16Compressor::Decompress(value);
 }
 
+LLGL_EXPORT void CompressFloat16Array(const float* src, std::uint16_t* dst, std::size_t count)
+{
+    std::size_t numCompressed = 0;
+
+    #if defined LLGL_ARCH_AMD64
+
+    static const bool isF16CSupported = IsF16CSupported();
+    if (isF16CSupported)
+        numCompressed = CompressFloat16ArrayF16C(src, dst, count);
+    else
+        numCompressed = CompressFloat16ArraySSE2(src, dst, count);
+
+    #elif defined LLGL_ARCH_ARM64
+
+    numCompressed = CompressFloat16ArrayNEON(src, dst, count);
+
+    #endif // /LLGL_ARCH_AMD64
+
+    /* Compress remaining values */
+    CompressFloat16ArrayWithTables(src + numCompressed, dst + numCompressed, count - numCompressed);
+}
+
+LLGL_EXPORT void DecompressFloat16Array(const std::uint16_t* src, float* dst, std::size_t count)
+{
+    std::size_t numDecompressed = 0;
+
+    #if defined LLGL_ARCH_AMD64
+
+    static const bool isF16CSupported = IsF16CSupported();
+    if (isF16CSupported)
+        numDecompressed = DecompressFloat16ArrayF16C(src, dst, count);
+    else
+        numDecompressed = DecompressFloat16ArraySSE2(src, dst, count);
+
+    #elif defined LLGL_ARCH_ARM64
+
+    numDecompressed = DecompressFloat16ArrayNEON(src, dst, count);
+
+    #endif // /LLGL_ARCH_AMD64
+
+    /* Decompress remaining values */
+    DecompressFloat16ArrayWithTables(src + numDecompressed, dst + numDecompressed, count - numDecompressed);
+}
 
 } // /namespace LLGL
 
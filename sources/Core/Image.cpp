@@ -7,6 +7,7 @@
 
 #include <LLGL/Image.h>
 #include "ImageUtils.h"
+#include "ImageResampler.h"
 #include <algorithm>
 #include <string.h>
 
@@ -51,7 +52,8 @@ Image::Image(Image&& rhs) :
     extent_   { rhs.extent_          },
     format_   { rhs.format_          },
     dataType_ { rhs.dataType_        },
-    data_     { std::move(rhs.data_) }
+    data_     { std::move(rhs.data_) },
+    capacity_ { rhs.capacity_        }
 {
     rhs.ResetAttributes();
 }
@@ -64,6 +66,7 @@ Image& Image::operator = (const Image& rhs)
     format_     = rhs.GetFormat();
     dataType_   = rhs.GetDataType();
     data_       = AllocateByteBuffer(GetDataSize(), UninitializeTag{});
+    capacity_   = 0;
     ::memcpy(data_.get(), rhs.data_.get(), rhs.GetDataSize());
     return *this;
 }
@@ -71,6 +74,7 @@ Image& Image::operator = (const Image& rhs)
 Image& Image::operator = (Image&& rhs)
 {
     Reset(rhs.GetExtent(), rhs.GetFormat(), rhs.GetDataType(), std::move(rhs.data_));
+    capacity_ = rhs.capacity_;
     rhs.ResetAttributes();
     return *this;
 }
@@ -82,8 +86,18 @@ void Image::Convert(const ImageFormat format, const DataType dataType, unsigned
     /* Convert image buffer (if necessary) */
     if (data_)
     {
-        if (auto convertedData = ConvertImageBuffer(GetSrcDesc(), format, dataType, threadCount))
-            data_ = std::move(convertedData);
+        const std::size_t capacity = std::max<std::size_t>(capacity_, GetDataSize());
+        if (GetMemoryFootprint(format, dataType, GetNumPixels()) <= capacity)
+        {
+            /* Convert in place if the converted image fits into the current image buffer, so the peak memory does not double */
+            if (ConvertImageBufferInPlace(GetDstDesc(), capacity, format, dataType, threadCount))
+                capacity_ = capacity;
+        }
+        else if (auto convertedData = ConvertImageBuffer(GetSrcDesc(), format, dataType, threadCount))
+        {
+            data_       = std::move(convertedData);
+            capacity_   = 0;
+        }
     }
 
     /* Store new attributes */
@@ -94,7 +108,8 @@ void Image::Convert(const ImageFormat format, const DataType dataType, unsigned
 void Image::Resize(const Extent3D& extent)
 {
     /* Allocate new image buffer or release it if the extent is zero */
-    extent_ = extent;
+    extent_     = extent;
+    capacity_   = 0;
     if (extent.width > 0 && extent.height > 0 && extent.depth > 0)
         data_ = AllocateByteBuffer(GetDataSize(), UninitializeTag{});
     else
@@ -106,8 +121,9 @@ void Image::Resize(const Extent3D& extent, const ColorRGBAd& fillColor)
     if (extent_ != extent)
     {
         /* Generate new image buffer with fill color */
-        extent_ = extent;
-        data_   = GenerateImageBuffer(GetFormat(), GetDataType(), GetNumPixels(), fillColor);
+        extent_     = extent;
+        data_       = GenerateImageBuffer(GetFormat(), GetDataType(), GetNumPixels(), fillColor);
+        capacity_   = 0;
     }
     else
     {
@@ -127,6 +143,7 @@ void Image::Resize(const Extent3D& extent, const ColorRGBAd& fillColor, const Of
         prevImage.format_   = GetFormat();
         prevImage.dataType_ = GetDataType();
         prevImage.data_     = std::move(data_);
+        capacity_           = 0;
 
         if ( extent.width  > GetExtent().width  ||
              extent.height > GetExtent().height ||
@@ -150,7 +167,27 @@ void Image::Resize(const Extent3D& extent, const ColorRGBAd& fillColor, const Of
 
 void Image::Resize(const Extent3D& extent, const SamplerFilter filter)
 {
-    //todo
+    Resize(extent, (filter == SamplerFilter::Nearest ? ImageFilter::Nearest : ImageFilter::Triangle));
+}
+
+void Image::Resize(const Extent3D& extent, const ImageFilter filter, bool sRGB)
+{
+    if (extent != GetExtent())
+    {
+        /* Resample image into new image buffer */
+        Image dstImage{ extent, GetFormat(), GetDataType() };
+        ResampleImageBuffer(GetSrcDesc(), GetExtent(), dstImage.GetDstDesc(), extent, filter, sRGB);
+        Swap(dstImage);
+    }
+}
+
+ByteBuffer Image::GenerateMips(
+    const ImageFilter                   filter,
+    bool                                sRGB,
+    std::uint32_t                       numMipLevels,
+    std::vector<SrcImageDescriptor>*    outMipImageDescs) const
+{
+    return GenerateMipChain(GetSrcDesc(), GetExtent(), numMipLevels, filter, sRGB, outMipImageDescs);
 }
 
 void Image::Swap(Image& rhs)
@@ -159,6 +196,7 @@ void Image::Swap(Image& rhs)
     std::swap(format_,   rhs.format_  );
     std::swap(dataType_, rhs.dataType_);
     std::swap(data_,     rhs.data_    );
+    std::swap(capacity_, rhs.capacity_);
 }
 
 void Image::Reset()
@@ -173,6 +211,7 @@ void Image::Reset(const Extent3D& extent, const ImageFormat format, const DataTy
     format_     = format;
     dataType_   = dataType;
     data_       = std::move(data);
+    capacity_   = 0;
 }
 
 ByteBuffer Image::Release()
@@ -259,9 +298,21 @@ void Image::Blit(Offset3D dstRegionOffset, const Image& srcImage, Offset3D srcRe
 
             if (srcImageRef == this && Overlap3DRegion(dstRegionOffset, srcRegionOffset, srcRegionExtent))
             {
-                /* Copy source image */
-                srcImageTemp = *this;
-                srcImageRef = &srcImageTemp;
+                /* Copy only the source region instead of the entire image */
+                srcImageTemp = Image{ srcRegionExtent, GetFormat(), GetDataType() };
+                CopyImageBufferRegion(
+                    srcImageTemp.GetDstDesc(),
+                    Offset3D{},
+                    srcRegionExtent.width,
+                    srcRegionExtent.width * srcRegionExtent.height,
+                    GetSrcDesc(),
+                    srcRegionOffset,
+                    GetExtent().width,
+                    GetExtent().width * GetExtent().height,
+                    srcRegionExtent
+                );
+                srcImageRef     = &srcImageTemp;
+                srcRegionOffset = Offset3D{};
             }
 
             /* Copy image buffer region */
@@ -503,6 +554,7 @@ void Image::ResetAttributes()
     format_     = ImageFormat::RGBA;
     dataType_   = DataType::UInt8;
     extent_     = { 0, 0, 0 };
+    capacity_   = 0;
 }
 
 std::size_t Image::GetDataPtrOffset(const Offset3D& offset) const
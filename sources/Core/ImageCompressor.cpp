@@ -0,0 +1,554 @@
+/*
+ * ImageCompressor.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ImageCompressor.h"
+#include "ImageDecompressor.h"
+#include <LLGL/JobSystem.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal functions ----- */
+
+// Number of texels along each dimension of a compressed block
+static const std::uint32_t g_blockDim = 4;
+
+// Minimal number of blocks each thread shall compress
+static const std::size_t g_compressMinWorkSize = 1024;
+
+// Number of least-squares refinements of the endpoints of each color block
+static const int g_numColorRefinements = 2;
+
+static std::uint32_t GetNumBlocks(std::uint32_t size)
+{
+    return (size + g_blockDim - 1) / g_blockDim;
+}
+
+static std::size_t GetBlockSize(const ImageFormat format)
+{
+    switch (format)
+    {
+        case ImageFormat::BC1:  return 8;
+        case ImageFormat::BC2:  return 16;
+        case ImageFormat::BC3:  return 16;
+        case ImageFormat::BC4:  return 8;
+        case ImageFormat::BC5:  return 16;
+        default:                return 0;
+    }
+}
+
+static void WriteUInt16(std::uint8_t* data, std::uint16_t value)
+{
+    data[0] = static_cast<std::uint8_t>(value & 0xFF);
+    data[1] = static_cast<std::uint8_t>(value >> 8);
+}
+
+static void WriteUInt32(std::uint8_t* data, std::uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+        data[i] = static_cast<std::uint8_t>((value >> (i*8)) & 0xFF);
+}
+
+// Writes the 48 bits of 3-bit indices of a BC4 block.
+static void WriteUInt48(std::uint8_t* data, std::uint64_t value)
+{
+    for (int i = 0; i < 6; ++i)
+        data[i] = static_cast<std::uint8_t>((value >> (i*8)) & 0xFF);
+}
+
+static int ClampColorComponent(float value)
+{
+    return std::max(0, std::min(static_cast<int>(value + 0.5f), 255));
+}
+
+// Quantizes the specified 8-bit color to 5-6-5 bits with rounding to the nearest value.
+static std::uint16_t EncodeColor565(const int (&rgb)[3])
+{
+    const int r = (rgb[0] * 31 + 127) / 255;
+    const int g = (rgb[1] * 63 + 127) / 255;
+    const int b = (rgb[2] * 31 + 127) / 255;
+    return static_cast<std::uint16_t>((r << 11) | (g << 5) | b);
+}
+
+// Expands the specified 5-6-5 color to 8 bits per component the same way as the decoder.
+static void DecodeColor565(std::uint16_t color, int (&rgb)[3])
+{
+    const int r = (color >> 11) & 0x1F;
+    const int g = (color >>  5) & 0x3F;
+    const int b = (color      ) & 0x1F;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+// Palette of a color block with either 4 colors, or 3 colors in the BC1 mode with transparent black.
+struct ColorPalette
+{
+    int colors[4][3];
+    int numColors;
+};
+
+static void BuildColorPalette(std::uint16_t c0, std::uint16_t c1, int numColors, ColorPalette& palette)
+{
+    DecodeColor565(c0, palette.colors[0]);
+    DecodeColor565(c1, palette.colors[1]);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        const int a = palette.colors[0][i];
+        const int b = palette.colors[1][i];
+        if (numColors == 4)
+        {
+            palette.colors[2][i] = (2 * a + b + 1) / 3;
+            palette.colors[3][i] = (a + 2 * b + 1) / 3;
+        }
+        else
+            palette.colors[2][i] = (a + b + 1) / 2;
+    }
+
+    palette.numColors = numColors;
+}
+
+static int GetColorDistance(const int (&lhs)[3], const std::uint8_t* rhs)
+{
+    const int dr = lhs[0] - rhs[0];
+    const int dg = lhs[1] - rhs[1];
+    const int db = lhs[2] - rhs[2];
+    return (dr*dr + dg*dg + db*db);
+}
+
+/*
+Selects the nearest palette color for each opaque texel and returns the sum of squared errors.
+Ties select the lower index, so a palette with equal endpoints never selects transparent black.
+Texels that are not in the opaque mask select index 3, i.e. transparent black in the 3-color mode.
+*/
+static int SelectColorIndices(const std::uint8_t* texels, std::uint32_t opaqueMask, const ColorPalette& palette, std::uint32_t& outIndices)
+{
+    int error = 0;
+    outIndices = 0;
+
+    for (int i = 0; i < 16; ++i)
+    {
+        if ((opaqueMask & (1u << i)) == 0)
+        {
+            outIndices |= (3u << (i*2));
+            continue;
+        }
+
+        int bestIndex = 0, bestDistance = std::numeric_limits<int>::max();
+        for (int j = 0; j < palette.numColors; ++j)
+        {
+            const int distance = GetColorDistance(palette.colors[j], texels + i*4);
+            if (distance < bestDistance)
+            {
+                bestIndex       = j;
+                bestDistance    = distance;
+            }
+        }
+
+        outIndices |= (static_cast<std::uint32_t>(bestIndex) << (i*2));
+        error += bestDistance;
+    }
+
+    return error;
+}
+
+// Computes the initial endpoints of a color block, which are the extremes of the opaque texels projected onto their principal axis.
+static void ComputePrincipalEndpoints(const std::uint8_t* texels, std::uint32_t opaqueMask, int (&outEndpoint0)[3], int (&outEndpoint1)[3])
+{
+    /* Compute mean and covariance matrix of opaque texels */
+    float mean[3] = {};
+    int numTexels = 0;
+
+    for (int i = 0; i < 16; ++i)
+    {
+        if ((opaqueMask & (1u << i)) != 0)
+        {
+            for (int j = 0; j < 3; ++j)
+                mean[j] += texels[i*4 + j];
+            ++numTexels;
+        }
+    }
+
+    for (int j = 0; j < 3; ++j)
+        mean[j] /= static_cast<float>(numTexels);
+
+    float covariance[3][3] = {};
+
+    for (int i = 0; i < 16; ++i)
+    {
+        if ((opaqueMask & (1u << i)) != 0)
+        {
+            const float d[3] = { texels[i*4] - mean[0], texels[i*4 + 1] - mean[1], texels[i*4 + 2] - mean[2] };
+            for (int r = 0; r < 3; ++r)
+            {
+                for (int c = 0; c < 3; ++c)
+                    covariance[r][c] += d[r] * d[c];
+            }
+        }
+    }
+
+    /* Find principal axis by power iteration, starting with the column of largest variance */
+    int startColumn = 0;
+    for (int j = 1; j < 3; ++j)
+    {
+        if (covariance[j][j] > covariance[startColumn][startColumn])
+            startColumn = j;
+    }
+
+    float axis[3] = { covariance[0][startColumn], covariance[1][startColumn], covariance[2][startColumn] };
+
+    for (int iteration = 0; iteration < 8; ++iteration)
+    {
+        float nextAxis[3];
+        for (int r = 0; r < 3; ++r)
+            nextAxis[r] = covariance[r][0] * axis[0] + covariance[r][1] * axis[1] + covariance[r][2] * axis[2];
+
+        const float maxComponent = std::max({ std::abs(nextAxis[0]), std::abs(nextAxis[1]), std::abs(nextAxis[2]) });
+        if (maxComponent < 1.0e-6f)
+            break;
+
+        for (int r = 0; r < 3; ++r)
+            axis[r] = nextAxis[r] / maxComponent;
+    }
+
+    const float axisLengthSq = axis[0]*axis[0] + axis[1]*axis[1] + axis[2]*axis[2];
+
+    /* Project texels onto principal axis; uniform blocks have no axis and use the mean for both endpoints */
+    float minProj = 0.0f, maxProj = 0.0f;
+
+    if (axisLengthSq > 1.0e-6f)
+    {
+        minProj = std::numeric_limits<float>::max();
+        maxProj = -std::numeric_limits<float>::max();
+
+        for (int i = 0; i < 16; ++i)
+        {
+            if ((opaqueMask & (1u << i)) != 0)
+            {
+                const float proj =
+                (
+                    (texels[i*4    ] - mean[0]) * axis[0] +
+                    (texels[i*4 + 1] - mean[1]) * axis[1] +
+                    (texels[i*4 + 2] - mean[2]) * axis[2]
+                ) / axisLengthSq;
+                minProj = std::min(minProj, proj);
+                maxProj = std::max(maxProj, proj);
+            }
+        }
+    }
+
+    for (int j = 0; j < 3; ++j)
+    {
+        outEndpoint0[j] = ClampColorComponent(mean[j] + axis[j] * maxProj);
+        outEndpoint1[j] = ClampColorComponent(mean[j] + axis[j] * minProj);
+    }
+}
+
+/*
+Refines the endpoints of a color block with a least-squares fit of the opaque texels for their selected palette indices.
+Returns false if the fit is degenerate, e.g. if all texels selected the same index.
+*/
+static bool RefineColorEndpoints(
+    const std::uint8_t* texels,
+    std::uint32_t       opaqueMask,
+    std::uint32_t       indices,
+    int                 numColors,
+    int                 (&outEndpoint0)[3],
+    int                 (&outEndpoint1)[3])
+{
+    /* Weights of the first endpoint for each palette index */
+    static const float weights4[4] = { 1.0f, 0.0f, 2.0f/3.0f, 1.0f/3.0f };
+    static const float weights3[4] = { 1.0f, 0.0f, 0.5f,      0.0f      };
+
+    const float* weights = (numColors == 4 ? weights4 : weights3);
+
+    float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+    float ax[3] = {}, bx[3] = {};
+
+    for (int i = 0; i < 16; ++i)
+    {
+        if ((opaqueMask & (1u << i)) != 0)
+        {
+            const float a = weights[(indices >> (i*2)) & 0x3];
+            const float b = 1.0f - a;
+            aa += a*a;
+            bb += b*b;
+            ab += a*b;
+            for (int j = 0; j < 3; ++j)
+            {
+                ax[j] += a * texels[i*4 + j];
+                bx[j] += b * texels[i*4 + j];
+            }
+        }
+    }
+
+    const float det = aa*bb - ab*ab;
+    if (std::abs(det) < 1.0e-6f)
+        return false;
+
+    for (int j = 0; j < 3; ++j)
+    {
+        outEndpoint0[j] = ClampColorComponent((ax[j]*bb - bx[j]*ab) / det);
+        outEndpoint1[j] = ClampColorComponent((bx[j]*aa - ax[j]*ab) / det);
+    }
+
+    return true;
+}
+
+/*
+Encodes 16 RGBA texels into the color part of a BC1, BC2, or BC3 block.
+Only BC1 blocks encode texels with an alpha component less than 128 as transparent black, which requires the 3-color mode.
+*/
+static void EncodeColorBlock(const std::uint8_t* texels, std::uint8_t* block, bool allowTransparency)
+{
+    std::uint32_t opaqueMask = 0;
+    for (int i = 0; i < 16; ++i)
+    {
+        if (!allowTransparency || texels[i*4 + 3] >= 128)
+            opaqueMask |= (1u << i);
+    }
+
+    if (opaqueMask == 0)
+    {
+        /* Encode fully transparent block in 3-color mode */
+        WriteUInt16(block, 0);
+        WriteUInt16(block + 2, 0);
+        WriteUInt32(block + 4, 0xFFFFFFFFu);
+        return;
+    }
+
+    const int numColors = (opaqueMask != 0xFFFFu ? 3 : 4);
+
+    int endpoint0[3], endpoint1[3];
+    ComputePrincipalEndpoints(texels, opaqueMask, endpoint0, endpoint1);
+
+    std::uint16_t   bestColor0  = 0;
+    std::uint16_t   bestColor1  = 0;
+    std::uint32_t   bestIndices = 0;
+    int             bestError   = std::numeric_limits<int>::max();
+
+    for (int iteration = 0; iteration <= g_numColorRefinements; ++iteration)
+    {
+        /* The first color must be greater than the second one for the 4-color mode, and not greater for the 3-color mode */
+        std::uint16_t c0 = EncodeColor565(endpoint0);
+        std::uint16_t c1 = EncodeColor565(endpoint1);
+        if ((numColors == 4 && c0 < c1) || (numColors == 3 && c0 > c1))
+            std::swap(c0, c1);
+
+        ColorPalette palette;
+        BuildColorPalette(c0, c1, numColors, palette);
+
+        std::uint32_t indices = 0;
+        const int error = SelectColorIndices(texels, opaqueMask, palette, indices);
+
+        if (error < bestError)
+        {
+            bestColor0  = c0;
+            bestColor1  = c1;
+            bestIndices = indices;
+            bestError   = error;
+        }
+
+        if (error == 0 || !RefineColorEndpoints(texels, opaqueMask, indices, numColors, endpoint0, endpoint1))
+            break;
+    }
+
+    WriteUInt16(block, bestColor0);
+    WriteUInt16(block + 2, bestColor1);
+    WriteUInt32(block + 4, bestIndices);
+}
+
+// Encodes the alpha component of 16 RGBA texels into the explicit 4-bit alpha values of a BC2 block.
+static void EncodeExplicitAlphaBlock(const std::uint8_t* texels, std::uint8_t* block)
+{
+    ::memset(block, 0, 8);
+    for (int i = 0; i < 16; ++i)
+    {
+        const auto alpha = static_cast<std::uint8_t>((texels[i*4 + 3] * 15 + 127) / 255);
+        block[i/2] |= static_cast<std::uint8_t>(alpha << ((i % 2) * 4));
+    }
+}
+
+// Divides the specified integer by the divisor and rounds to the nearest integer, away from zero on ties.
+static int DivRound(int x, int divisor)
+{
+    return (x >= 0 ? (x + divisor/2) / divisor : (x - divisor/2) / divisor);
+}
+
+/*
+Encodes 16 components with the specified stride into a BC4 block (also used for the alpha component of BC3 and each component of BC5).
+The minimum and maximum components are used as endpoints of the 8-value mode. Signed components of -128 are encoded as -127 like the decoder treats them.
+*/
+template <typename T>
+void EncodeComponentBlock(const T* texels, std::size_t stride, std::uint8_t* block)
+{
+    const int minValue = (std::numeric_limits<T>::is_signed ? -127 : 0);
+
+    int values[16];
+    int v0 = minValue, v1 = std::numeric_limits<T>::max();
+
+    for (int i = 0; i < 16; ++i)
+    {
+        values[i] = std::max(minValue, static_cast<int>(texels[i*stride]));
+        v0 = std::max(v0, values[i]);
+        v1 = std::min(v1, values[i]);
+    }
+
+    block[0] = static_cast<std::uint8_t>(static_cast<T>(v0));
+    block[1] = static_cast<std::uint8_t>(static_cast<T>(v1));
+
+    /* Select nearest of the 8 interpolated values; blocks with a single value keep all indices at zero */
+    std::uint64_t indices = 0;
+
+    if (v0 > v1)
+    {
+        int palette[8];
+        palette[0] = v0;
+        palette[1] = v1;
+        for (int i = 1; i < 7; ++i)
+            palette[i + 1] = DivRound((7 - i) * v0 + i * v1, 7);
+
+        for (int i = 0; i < 16; ++i)
+        {
+            int bestIndex = 0, bestDistance = std::numeric_limits<int>::max();
+            for (int j = 0; j < 8; ++j)
+            {
+                const int distance = std::abs(palette[j] - values[i]);
+                if (distance < bestDistance)
+                {
+                    bestIndex       = j;
+                    bestDistance    = distance;
+                }
+            }
+            indices |= (static_cast<std::uint64_t>(bestIndex) << (i*3));
+        }
+    }
+
+    WriteUInt48(block + 2, indices);
+}
+
+// Encodes a tightly packed array of 4x4 texels into a single block of the specified format.
+static void EncodeBlock(const ImageFormat format, const DataType dataType, const std::uint8_t* texels, std::uint8_t* block)
+{
+    switch (format)
+    {
+        case ImageFormat::BC1:
+            EncodeColorBlock(texels, block, true);
+            break;
+
+        case ImageFormat::BC2:
+            EncodeExplicitAlphaBlock(texels, block);
+            EncodeColorBlock(texels, block + 8, false);
+            break;
+
+        case ImageFormat::BC3:
+            EncodeComponentBlock<std::uint8_t>(texels + 3, 4, block);
+            EncodeColorBlock(texels, block + 8, false);
+            break;
+
+        case ImageFormat::BC4:
+            if (dataType == DataType::Int8)
+                EncodeComponentBlock<std::int8_t>(reinterpret_cast<const std::int8_t*>(texels), 1, block);
+            else
+                EncodeComponentBlock<std::uint8_t>(texels, 1, block);
+            break;
+
+        case ImageFormat::BC5:
+            if (dataType == DataType::Int8)
+            {
+                EncodeComponentBlock<std::int8_t>(reinterpret_cast<const std::int8_t*>(texels),     2, block);
+                EncodeComponentBlock<std::int8_t>(reinterpret_cast<const std::int8_t*>(texels) + 1, 2, block + 8);
+            }
+            else
+            {
+                EncodeComponentBlock<std::uint8_t>(texels,     2, block);
+                EncodeComponentBlock<std::uint8_t>(texels + 1, 2, block + 8);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+/* ----- Functions ----- */
+
+void CompressBlockImage(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             extent,
+    const ImageFormat           dstFormat,
+    void*                       dstData,
+    unsigned                    threadCount)
+{
+    const auto blockSize        = GetBlockSize(dstFormat);
+    const auto texelSize        = ImageFormatSize(GetDecompressedImageFormat(dstFormat));
+    const auto numBlocksX       = GetNumBlocks(extent.width);
+    const auto numBlocksY       = GetNumBlocks(extent.height);
+    const auto numBlockRows     = static_cast<std::size_t>(numBlocksY) * extent.depth;
+    const auto srcRowStride     = static_cast<std::size_t>(extent.width) * texelSize;
+    const auto srcDepthStride   = srcRowStride * extent.height;
+
+    if (blockSize == 0 || numBlocksX == 0 || numBlockRows == 0)
+        return;
+
+    auto src = reinterpret_cast<const std::uint8_t*>(srcImageDesc.data);
+    auto dst = reinterpret_cast<std::uint8_t*>(dstData);
+
+    /* Compress rows of blocks in parallel, each block row is addressed by its linearized index over all slices */
+    JobSystem::ParallelFor(
+        numBlockRows,
+        std::max<std::size_t>(1, g_compressMinWorkSize / numBlocksX),
+        threadCount,
+        [&](std::size_t begin, std::size_t end)
+        {
+            std::uint8_t texels[g_blockDim * g_blockDim * 4];
+
+            for (auto blockRow = begin; blockRow < end; ++blockRow)
+            {
+                const auto by       = static_cast<std::uint32_t>(blockRow % numBlocksY);
+                const auto z        = blockRow / numBlocksY;
+                const auto srcSlice = src + z * srcDepthStride;
+
+                auto block = dst + blockRow * numBlocksX * blockSize;
+
+                for (std::uint32_t bx = 0; bx < numBlocksX; ++bx, block += blockSize)
+                {
+                    /* Gather texels of this block and repeat the texels at the image boundary */
+                    for (std::uint32_t y = 0; y < g_blockDim; ++y)
+                    {
+                        const auto srcY = std::min(by * g_blockDim + y, extent.height - 1);
+                        for (std::uint32_t x = 0; x < g_blockDim; ++x)
+                        {
+                            const auto srcX = std::min(bx * g_blockDim + x, extent.width - 1);
+                            ::memcpy(texels + (y * g_blockDim + x) * texelSize, srcSlice + srcY * srcRowStride + srcX * texelSize, texelSize);
+                        }
+                    }
+
+                    EncodeBlock(dstFormat, srcImageDesc.dataType, texels, block);
+                }
+            }
+        }
+    );
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
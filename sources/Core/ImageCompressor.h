@@ -0,0 +1,45 @@
+/*
+ * ImageCompressor.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_IMAGE_COMPRESSOR_H
+#define LLGL_IMAGE_COMPRESSOR_H
+
+
+#include <LLGL/ImageFlags.h>
+#include <LLGL/Types.h>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/* ----- Functions ----- */
+
+/*
+Compresses the specified uncompressed source image into the destination buffer, which must have the size returned by GetCompressedImageSize.
+The source image must be tightly packed in the format returned by GetDecompressedImageFormat for the destination format,
+and in the data type DataType::UInt8, or DataType::Int8 for signed BC4 and BC5 images. Blocks at the right and bottom edges are padded by repeating the edge texels.
+Each slice of the extent is compressed separately.
+*/
+void CompressBlockImage(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             extent,
+    const ImageFormat           dstFormat,
+    void*                       dstData,
+    unsigned                    threadCount
+);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
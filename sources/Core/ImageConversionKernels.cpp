@@ -0,0 +1,504 @@
+/*
+ * ImageConversionKernels.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ImageConversionKernels.h"
+#include "Float16Compressor.h"
+#include <LLGL/Platform/Platform.h>
+#include <algorithm>
+#include <cstdint>
+
+#if defined LLGL_ARCH_AMD64
+#   include <emmintrin.h>
+#   include <tmmintrin.h>
+#   ifdef _MSC_VER
+#       include <intrin.h>
+#   else
+#       include <cpuid.h>
+#   endif
+#elif defined LLGL_ARCH_ARM64
+#   include <arm_neon.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+/*
+The kernels in this file must produce the same results as the generic conversion in ImageFlags.cpp,
+i.e. missing color components are filled with 0 and a missing alpha component is filled with 255.
+SSE2 is always available on AMD64 and NEON is always available on ARM64, so these kernels are selected at compile time.
+The SSSE3 byte shuffle is selected at runtime, since it is not part of the AMD64 baseline.
+*/
+
+#if defined LLGL_ARCH_AMD64 && (defined __GNUC__ || defined __clang__)
+#   define LLGL_TARGET_SSSE3 __attribute__((target("ssse3")))
+#else
+#   define LLGL_TARGET_SSSE3
+#endif
+
+
+/* ----- Internal structures ----- */
+
+// Byte mapping from a source pixel to a destination pixel with up to 4 components.
+struct ShuffleMap
+{
+    int             srcSize;
+    int             dstSize;
+    int             src[4];     // Source byte for each destination byte, or -1 to use the fill value
+    std::uint8_t    fill[4];    // Fill value for each destination byte without source byte
+};
+
+/* ----- Internal functions ----- */
+
+// Returns the byte index of each RGBA component in the specified format (or -1 if the component is missing), and the number of components.
+static bool GetComponentIndices(ImageFormat format, int& outSize, int (&outIndices)[4])
+{
+    switch (format)
+    {
+        case ImageFormat::R:
+            outSize = 1;
+            outIndices[0] = 0; outIndices[1] = -1; outIndices[2] = -1; outIndices[3] = -1;
+            return true;
+        case ImageFormat::RGB:
+            outSize = 3;
+            outIndices[0] = 0; outIndices[1] = 1; outIndices[2] = 2; outIndices[3] = -1;
+            return true;
+        case ImageFormat::BGR:
+            outSize = 3;
+            outIndices[0] = 2; outIndices[1] = 1; outIndices[2] = 0; outIndices[3] = -1;
+            return true;
+        case ImageFormat::RGBA:
+            outSize = 4;
+            outIndices[0] = 0; outIndices[1] = 1; outIndices[2] = 2; outIndices[3] = 3;
+            return true;
+        case ImageFormat::BGRA:
+            outSize = 4;
+            outIndices[0] = 2; outIndices[1] = 1; outIndices[2] = 0; outIndices[3] = 3;
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool GetShuffleMap(ImageFormat srcFormat, ImageFormat dstFormat, ShuffleMap& outMap)
+{
+    int srcIndices[4], dstIndices[4];
+    if (!GetComponentIndices(srcFormat, outMap.srcSize, srcIndices) ||
+        !GetComponentIndices(dstFormat, outMap.dstSize, dstIndices) ||
+        outMap.dstSize < 3)
+    {
+        return false;
+    }
+
+    for (int component = 0; component < 4; ++component)
+    {
+        const int dstIndex = dstIndices[component];
+        if (dstIndex >= 0)
+        {
+            outMap.src[dstIndex]    = srcIndices[component];
+            outMap.fill[dstIndex]   = (srcIndices[component] >= 0 ? 0 : (component == 3 ? 0xFF : 0x00));
+        }
+    }
+
+    return true;
+}
+
+static void ShufflePixels(const ShuffleMap& map, const std::uint8_t* src, std::uint8_t* dst, std::size_t numPixels)
+{
+    for (std::size_t i = 0; i < numPixels; ++i, src += map.srcSize, dst += map.dstSize)
+    {
+        for (int c = 0; c < map.dstSize; ++c)
+            dst[c] = (map.src[c] >= 0 ? src[map.src[c]] : map.fill[c]);
+    }
+}
+
+#if defined LLGL_ARCH_AMD64
+
+static bool IsSSSE3Supported()
+{
+    #ifdef _MSC_VER
+    int info[4] = {};
+    __cpuid(info, 1);
+    return ((info[2] & (1 << 9)) != 0);
+    #else
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    return (__get_cpuid(1, &eax, &ebx, &ecx, &edx) != 0 && (ecx & bit_SSSE3) != 0);
+    #endif
+}
+
+// Shuffles 4 pixels per iteration with a single byte shuffle. Returns the number of converted pixels.
+LLGL_TARGET_SSSE3
+static std::size_t ShufflePixelsSSSE3(const ShuffleMap& map, const std::uint8_t* src, std::uint8_t* dst, std::size_t numPixels)
+{
+    alignas(16) std::uint8_t maskBytes[16];
+    alignas(16) std::uint8_t fillBytes[16];
+
+    for (int i = 0; i < 16; ++i)
+    {
+        const int pixel = i / map.dstSize, component = i % map.dstSize;
+        if (pixel < 4 && map.src[component] >= 0)
+        {
+            maskBytes[i] = static_cast<std::uint8_t>(pixel * map.srcSize + map.src[component]);
+            fillBytes[i] = 0x00;
+        }
+        else
+        {
+            maskBytes[i] = 0x80;
+            fillBytes[i] = (pixel < 4 ? map.fill[component] : 0x00);
+        }
+    }
+
+    const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(maskBytes));
+    const __m128i fill = _mm_load_si128(reinterpret_cast<const __m128i*>(fillBytes));
+
+    /* Each iteration reads and writes 16 bytes, so stop before either of them would exceed the range of this call */
+    const std::size_t srcEnd = numPixels * map.srcSize, dstEnd = numPixels * map.dstSize;
+
+    std::size_t i = 0;
+    for (; i * map.srcSize + 16 <= srcEnd && i * map.dstSize + 16 <= dstEnd; i += 4)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * map.srcSize));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * map.dstSize), _mm_or_si128(_mm_shuffle_epi8(v, mask), fill));
+    }
+
+    return i;
+}
+
+// Swaps the first and third component of 4 pixels per iteration, i.e. RGBA <-> BGRA. Returns the number of converted pixels.
+static std::size_t SwizzleRGBAtoBGRASSE2(const std::uint8_t* src, std::uint8_t* dst, std::size_t numPixels)
+{
+    const __m128i maskGA = _mm_set1_epi32(static_cast<int>(0xFF00FF00));
+    const __m128i maskR  = _mm_set1_epi32(0x000000FF);
+
+    std::size_t i = 0;
+    for (; i + 4 <= numPixels; i += 4)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        const __m128i r = _mm_slli_epi32(_mm_and_si128(v, maskR), 16);
+        const __m128i b = _mm_and_si128(_mm_srli_epi32(v, 16), maskR);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_or_si128(_mm_and_si128(v, maskGA), _mm_or_si128(r, b)));
+    }
+
+    return i;
+}
+
+// Expands 16 single-component pixels per iteration into 4-component pixels. Returns the number of converted pixels.
+static std::size_t ExpandRtoRGBASSE2(const ShuffleMap& map, const std::uint8_t* src, std::uint8_t* dst, std::size_t numPixels)
+{
+    int shift = 0;
+    for (int c = 0; c < 4; ++c)
+    {
+        if (map.src[c] == 0)
+            shift = c * 8;
+    }
+
+    const __m128i fill = _mm_set1_epi32(
+        static_cast<int>(
+            (static_cast<std::uint32_t>(map.fill[0])      ) |
+            (static_cast<std::uint32_t>(map.fill[1]) <<  8) |
+            (static_cast<std::uint32_t>(map.fill[2]) << 16) |
+            (static_cast<std::uint32_t>(map.fill[3]) << 24)
+        )
+    );
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i count = _mm_cvtsi32_si128(shift);
+
+    std::size_t i = 0;
+    for (; i + 16 <= numPixels; i += 16)
+    {
+        const __m128i v     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i lo    = _mm_unpacklo_epi8(v, zero);
+        const __m128i hi    = _mm_unpackhi_epi8(v, zero);
+        auto dstPtr = reinterpret_cast<__m128i*>(dst + i * 4);
+        _mm_storeu_si128(dstPtr + 0, _mm_or_si128(_mm_sll_epi32(_mm_unpacklo_epi16(lo, zero), count), fill));
+        _mm_storeu_si128(dstPtr + 1, _mm_or_si128(_mm_sll_epi32(_mm_unpackhi_epi16(lo, zero), count), fill));
+        _mm_storeu_si128(dstPtr + 2, _mm_or_si128(_mm_sll_epi32(_mm_unpacklo_epi16(hi, zero), count), fill));
+        _mm_storeu_si128(dstPtr + 3, _mm_or_si128(_mm_sll_epi32(_mm_unpackhi_epi16(hi, zero), count), fill));
+    }
+
+    return i;
+}
+
+#elif defined LLGL_ARCH_ARM64
+
+// Shuffles 16 pixels per iteration with de-interleaving loads and interleaving stores. Returns the number of converted pixels.
+static std::size_t ShufflePixelsNEON(const ShuffleMap& map, const std::uint8_t* src, std::uint8_t* dst, std::size_t numPixels)
+{
+    uint8x16_t fill[4];
+    for (int c = 0; c < map.dstSize; ++c)
+        fill[c] = vdupq_n_u8(map.fill[c]);
+
+    std::size_t i = 0;
+    for (; i + 16 <= numPixels; i += 16)
+    {
+        /* Load 16 de-interleaved source pixels */
+        uint8x16_t in[4];
+        const std::uint8_t* srcPtr = src + i * map.srcSize;
+        switch (map.srcSize)
+        {
+            case 1:
+            {
+                in[0] = vld1q_u8(srcPtr);
+            }
+            break;
+            case 3:
+            {
+                const uint8x16x3_t v = vld3q_u8(srcPtr);
+                in[0] = v.val[0]; in[1] = v.val[1]; in[2] = v.val[2];
+            }
+            break;
+            case 4:
+            {
+                const uint8x16x4_t v = vld4q_u8(srcPtr);
+                in[0] = v.val[0]; in[1] = v.val[1]; in[2] = v.val[2]; in[3] = v.val[3];
+            }
+            break;
+        }
+
+        /* Store 16 interleaved destination pixels */
+        std::uint8_t* dstPtr = dst + i * map.dstSize;
+        if (map.dstSize == 3)
+        {
+            uint8x16x3_t v;
+            for (int c = 0; c < 3; ++c)
+                v.val[c] = (map.src[c] >= 0 ? in[map.src[c]] : fill[c]);
+            vst3q_u8(dstPtr, v);
+        }
+        else
+        {
+            uint8x16x4_t v;
+            for (int c = 0; c < 4; ++c)
+                v.val[c] = (map.src[c] >= 0 ? in[map.src[c]] : fill[c]);
+            vst4q_u8(dstPtr, v);
+        }
+    }
+
+    return i;
+}
+
+#endif // /LLGL_ARCH_AMD64
+
+static void ConvertUInt8ToFloat32(const std::uint8_t* src, float* dst, std::size_t count)
+{
+    std::size_t i = 0;
+
+    #if defined LLGL_ARCH_AMD64
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 scale = _mm_set1_ps(255.0f);
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i v     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i lo    = _mm_unpacklo_epi8(v, zero);
+        const __m128i hi    = _mm_unpackhi_epi8(v, zero);
+        _mm_storeu_ps(dst + i +  0, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale));
+        _mm_storeu_ps(dst + i +  4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale));
+        _mm_storeu_ps(dst + i +  8, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale));
+        _mm_storeu_ps(dst + i + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale));
+    }
+
+    #elif defined LLGL_ARCH_ARM64
+
+    const float32x4_t scale = vdupq_n_f32(255.0f);
+    for (; i + 16 <= count; i += 16)
+    {
+        const uint8x16_t    v   = vld1q_u8(src + i);
+        const uint16x8_t    lo  = vmovl_u8(vget_low_u8(v));
+        const uint16x8_t    hi  = vmovl_u8(vget_high_u8(v));
+        vst1q_f32(dst + i +  0, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo))), scale));
+        vst1q_f32(dst + i +  4, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo))), scale));
+        vst1q_f32(dst + i +  8, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi))), scale));
+        vst1q_f32(dst + i + 12, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi))), scale));
+    }
+
+    #endif // /LLGL_ARCH_AMD64
+
+    /* A single division by 255 is correctly rounded, just like the normalization in double precision of the generic conversion */
+    for (; i < count; ++i)
+        dst[i] = static_cast<float>(src[i]) / 255.0f;
+}
+
+static void ConvertFloat32ToUInt8(const float* src, std::uint8_t* dst, std::size_t count)
+{
+    std::size_t i = 0;
+
+    #if defined LLGL_ARCH_AMD64
+
+    /*
+    Scale in double precision, since the product of a 32-bit float and 255 is exact in double precision,
+    so truncating it yields the same result as the generic conversion. Out-of-range values and NaN are clamped to [0, 255].
+    */
+    const __m128d scale = _mm_set1_pd(255.0);
+    const __m128d zero  = _mm_setzero_pd();
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i v[4];
+        for (int j = 0; j < 4; ++j)
+        {
+            const __m128  f = _mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i + j*2)));
+            const __m128d x = _mm_mul_pd(_mm_cvtps_pd(f), scale);
+            v[j] = _mm_cvttpd_epi32(_mm_min_pd(_mm_max_pd(x, zero), scale));
+        }
+        const __m128i lo = _mm_unpacklo_epi64(v[0], v[1]);
+        const __m128i hi = _mm_unpacklo_epi64(v[2], v[3]);
+        const __m128i v8 = _mm_packus_epi16(_mm_packs_epi32(lo, hi), _mm_setzero_si128());
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), v8);
+    }
+
+    #endif // /LLGL_ARCH_AMD64
+
+    for (; i < count; ++i)
+    {
+        const double x = static_cast<double>(src[i]) * 255.0;
+        dst[i] = static_cast<std::uint8_t>(x > 0.0 ? std::min(x, 255.0) : 0.0);
+    }
+}
+
+
+// Number of components that are converted at once through an intermediate 32-bit float buffer on the stack
+static const std::size_t g_float16ChunkSize = 256;
+
+// Converts 16-bit floats into another data type that has a conversion from 32-bit floats, i.e. UInt8 and Float64.
+template <typename T, typename TConvertFunc>
+static void ConvertFloat16Chunked(const std::uint16_t* src, T* dst, std::size_t count, TConvertFunc convertFunc)
+{
+    float chunk[g_float16ChunkSize];
+    for (std::size_t i = 0; i < count; i += g_float16ChunkSize)
+    {
+        const auto n = std::min(g_float16ChunkSize, count - i);
+        DecompressFloat16Array(src + i, chunk, n);
+        convertFunc(chunk, dst + i, n);
+    }
+}
+
+// Converts another data type that has a conversion into 32-bit floats, i.e. UInt8 and Float64, into 16-bit floats.
+template <typename T, typename TConvertFunc>
+static void ConvertToFloat16Chunked(const T* src, std::uint16_t* dst, std::size_t count, TConvertFunc convertFunc)
+{
+    float chunk[g_float16ChunkSize];
+    for (std::size_t i = 0; i < count; i += g_float16ChunkSize)
+    {
+        const auto n = std::min(g_float16ChunkSize, count - i);
+        convertFunc(src + i, chunk, n);
+        CompressFloat16Array(chunk, dst + i, n);
+    }
+}
+
+static void ConvertFloat32ToFloat64(const float* src, double* dst, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        dst[i] = static_cast<double>(src[i]);
+}
+
+static void ConvertFloat64ToFloat32(const double* src, float* dst, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        dst[i] = static_cast<float>(src[i]);
+}
+
+/* ----- Functions ----- */
+
+bool ConvertImageFormatWithKernel(
+    ImageFormat srcFormat,
+    ImageFormat dstFormat,
+    DataType    dataType,
+    const void* srcBuffer,
+    void*       dstBuffer,
+    std::size_t numPixels)
+{
+    if (dataType != DataType::UInt8)
+        return false;
+
+    ShuffleMap map;
+    if (!GetShuffleMap(srcFormat, dstFormat, map))
+        return false;
+
+    auto src = reinterpret_cast<const std::uint8_t*>(srcBuffer);
+    auto dst = reinterpret_cast<std::uint8_t*>(dstBuffer);
+
+    std::size_t numConverted = 0;
+
+    #if defined LLGL_ARCH_AMD64
+
+    static const bool isSSSE3Supported = IsSSSE3Supported();
+
+    if (isSSSE3Supported)
+        numConverted = ShufflePixelsSSSE3(map, src, dst, numPixels);
+    else if (map.srcSize == 4 && map.dstSize == 4 && map.src[0] == 2 && map.src[1] == 1 && map.src[2] == 0 && map.src[3] == 3)
+        numConverted = SwizzleRGBAtoBGRASSE2(src, dst, numPixels);
+    else if (map.srcSize == 1 && map.dstSize == 4)
+        numConverted = ExpandRtoRGBASSE2(map, src, dst, numPixels);
+
+    #elif defined LLGL_ARCH_ARM64
+
+    numConverted = ShufflePixelsNEON(map, src, dst, numPixels);
+
+    #endif // /LLGL_ARCH_AMD64
+
+    /* Convert remaining pixels */
+    ShufflePixels(map, src + numConverted * map.srcSize, dst + numConverted * map.dstSize, numPixels - numConverted);
+
+    return true;
+}
+
+bool ConvertImageDataTypeWithKernel(
+    DataType    srcDataType,
+    DataType    dstDataType,
+    const void* srcBuffer,
+    void*       dstBuffer,
+    std::size_t numComponents)
+{
+    if (srcDataType == DataType::UInt8 && dstDataType == DataType::Float32)
+    {
+        ConvertUInt8ToFloat32(reinterpret_cast<const std::uint8_t*>(srcBuffer), reinterpret_cast<float*>(dstBuffer), numComponents);
+        return true;
+    }
+    if (srcDataType == DataType::Float32 && dstDataType == DataType::UInt8)
+    {
+        ConvertFloat32ToUInt8(reinterpret_cast<const float*>(srcBuffer), reinterpret_cast<std::uint8_t*>(dstBuffer), numComponents);
+        return true;
+    }
+    if (srcDataType == DataType::Float32 && dstDataType == DataType::Float16)
+    {
+        CompressFloat16Array(reinterpret_cast<const float*>(srcBuffer), reinterpret_cast<std::uint16_t*>(dstBuffer), numComponents);
+        return true;
+    }
+    if (srcDataType == DataType::Float16 && dstDataType == DataType::Float32)
+    {
+        DecompressFloat16Array(reinterpret_cast<const std::uint16_t*>(srcBuffer), reinterpret_cast<float*>(dstBuffer), numComponents);
+        return true;
+    }
+    if (srcDataType == DataType::UInt8 && dstDataType == DataType::Float16)
+    {
+        ConvertToFloat16Chunked(reinterpret_cast<const std::uint8_t*>(srcBuffer), reinterpret_cast<std::uint16_t*>(dstBuffer), numComponents, ConvertUInt8ToFloat32);
+        return true;
+    }
+    if (srcDataType == DataType::Float16 && dstDataType == DataType::UInt8)
+    {
+        ConvertFloat16Chunked(reinterpret_cast<const std::uint16_t*>(srcBuffer), reinterpret_cast<std::uint8_t*>(dstBuffer), numComponents, ConvertFloat32ToUInt8);
+        return true;
+    }
+    if (srcDataType == DataType::Float64 && dstDataType == DataType::Float16)
+    {
+        ConvertToFloat16Chunked(reinterpret_cast<const double*>(srcBuffer), reinterpret_cast<std::uint16_t*>(dstBuffer), numComponents, ConvertFloat64ToFloat32);
+        return true;
+    }
+    if (srcDataType == DataType::Float16 && dstDataType == DataType::Float64)
+    {
+        ConvertFloat16Chunked(reinterpret_cast<const std::uint16_t*>(srcBuffer), reinterpret_cast<double*>(dstBuffer), numComponents, ConvertFloat32ToFloat64);
+        return true;
+    }
+    return false;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
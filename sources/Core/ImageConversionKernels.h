@@ -0,0 +1,55 @@
+/*
+ * ImageConversionKernels.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_IMAGE_CONVERSION_KERNELS_H
+#define LLGL_IMAGE_CONVERSION_KERNELS_H
+
+
+#include <LLGL/ImageFlags.h>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/*
+Converts the specified number of pixels between two image formats with a specialized kernel.
+Kernels are only available for 8-bit unsigned components and the formats R, RGB, BGR, RGBA, and BGRA as source and RGB, BGR, RGBA, and BGRA as destination.
+Returns false if there is no kernel for the specified parameters, in which case the generic conversion must be used.
+*/
+bool ConvertImageFormatWithKernel(
+    ImageFormat srcFormat,
+    ImageFormat dstFormat,
+    DataType    dataType,
+    const void* srcBuffer,
+    void*       dstBuffer,
+    std::size_t numPixels
+);
+
+/*
+Converts the specified number of components between two data types with a specialized kernel.
+Kernels are only available between UInt8 and Float32, and between Float16 and UInt8, Float32, or Float64.
+Returns false if there is no kernel for the specified parameters, in which case the generic conversion must be used.
+*/
+bool ConvertImageDataTypeWithKernel(
+    DataType    srcDataType,
+    DataType    dstDataType,
+    const void* srcBuffer,
+    void*       dstBuffer,
+    std::size_t numComponents
+);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
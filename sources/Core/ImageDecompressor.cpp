@@ -0,0 +1,320 @@
+/*
+ * ImageDecompressor.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ImageDecompressor.h"
+#include <LLGL/JobSystem.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal functions ----- */
+
+// Number of texels along each dimension of a compressed block
+static const std::uint32_t g_blockDim = 4;
+
+// Minimal number of blocks each thread shall decompress
+static const std::size_t g_decompressMinWorkSize = 4096;
+
+static std::uint32_t GetNumBlocks(std::uint32_t size)
+{
+    return (size + g_blockDim - 1) / g_blockDim;
+}
+
+static std::size_t GetBlockSize(const ImageFormat format)
+{
+    switch (format)
+    {
+        case ImageFormat::BC1:  return 8;
+        case ImageFormat::BC2:  return 16;
+        case ImageFormat::BC3:  return 16;
+        case ImageFormat::BC4:  return 8;
+        case ImageFormat::BC5:  return 16;
+        default:                return 0;
+    }
+}
+
+static std::uint16_t ReadUInt16(const std::uint8_t* data)
+{
+    return static_cast<std::uint16_t>(data[0] | (data[1] << 8));
+}
+
+static std::uint32_t ReadUInt32(const std::uint8_t* data)
+{
+    return
+    (
+        (static_cast<std::uint32_t>(data[0])      ) |
+        (static_cast<std::uint32_t>(data[1]) <<  8) |
+        (static_cast<std::uint32_t>(data[2]) << 16) |
+        (static_cast<std::uint32_t>(data[3]) << 24)
+    );
+}
+
+// Reads the 48 bits of 3-bit indices of a BC4 block.
+static std::uint64_t ReadUInt48(const std::uint8_t* data)
+{
+    return
+    (
+        (static_cast<std::uint64_t>(ReadUInt16(data))) |
+        (static_cast<std::uint64_t>(ReadUInt32(data + 2)) << 16)
+    );
+}
+
+// Expands the specified 5-6-5 color to 8 bits per component.
+static void DecodeColor565(std::uint16_t color, std::uint8_t (&rgba)[4])
+{
+    const auto r = static_cast<std::uint8_t>((color >> 11) & 0x1F);
+    const auto g = static_cast<std::uint8_t>((color >>  5) & 0x3F);
+    const auto b = static_cast<std::uint8_t>((color      ) & 0x1F);
+    rgba[0] = static_cast<std::uint8_t>((r << 3) | (r >> 2));
+    rgba[1] = static_cast<std::uint8_t>((g << 2) | (g >> 4));
+    rgba[2] = static_cast<std::uint8_t>((b << 3) | (b >> 2));
+    rgba[3] = 0xFF;
+}
+
+/*
+Decodes the color part of a BC1, BC2, or BC3 block into 16 RGBA texels.
+Only BC1 blocks use the 3-color mode with transparent black when the first endpoint is not greater than the second one.
+*/
+static void DecodeColorBlock(const std::uint8_t* block, std::uint8_t* texels, bool allowTransparency)
+{
+    const auto c0 = ReadUInt16(block);
+    const auto c1 = ReadUInt16(block + 2);
+
+    std::uint8_t palette[4][4];
+    DecodeColor565(c0, palette[0]);
+    DecodeColor565(c1, palette[1]);
+
+    if (c0 > c1 || !allowTransparency)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            palette[2][i] = static_cast<std::uint8_t>((2 * palette[0][i] + palette[1][i] + 1) / 3);
+            palette[3][i] = static_cast<std::uint8_t>((palette[0][i] + 2 * palette[1][i] + 1) / 3);
+        }
+        palette[2][3] = 0xFF;
+        palette[3][3] = 0xFF;
+    }
+    else
+    {
+        for (int i = 0; i < 3; ++i)
+            palette[2][i] = static_cast<std::uint8_t>((palette[0][i] + palette[1][i] + 1) / 2);
+        palette[2][3] = 0xFF;
+        ::memset(palette[3], 0, sizeof(palette[3]));
+    }
+
+    const auto indices = ReadUInt32(block + 4);
+    for (int i = 0; i < 16; ++i)
+        ::memcpy(texels + i*4, palette[(indices >> (i*2)) & 0x3], 4);
+}
+
+// Decodes the explicit 4-bit alpha values of a BC2 block into the alpha component of 16 RGBA texels.
+static void DecodeExplicitAlphaBlock(const std::uint8_t* block, std::uint8_t* texels)
+{
+    for (int i = 0; i < 16; ++i)
+    {
+        const auto alpha = static_cast<std::uint8_t>((block[i/2] >> ((i % 2) * 4)) & 0x0F);
+        texels[i*4 + 3] = static_cast<std::uint8_t>(alpha * 17);
+    }
+}
+
+// Divides the specified integer by the divisor and rounds to the nearest integer, away from zero on ties.
+static int DivRound(int x, int divisor)
+{
+    return (x >= 0 ? (x + divisor/2) / divisor : (x - divisor/2) / divisor);
+}
+
+/*
+Decodes a BC4 block (also used for the alpha component of BC3 and each component of BC5) into 16 components with the specified stride.
+Signed blocks map the value -128 to -127, so the range is symmetric around zero.
+*/
+template <typename T>
+void DecodeComponentBlock(const std::uint8_t* block, T* texels, std::size_t stride)
+{
+    const int minValue = (std::numeric_limits<T>::is_signed ? -127 : 0);
+    const int maxValue = std::numeric_limits<T>::max();
+
+    const int v0 = std::max(minValue, static_cast<int>(static_cast<T>(block[0])));
+    const int v1 = std::max(minValue, static_cast<int>(static_cast<T>(block[1])));
+
+    T palette[8];
+    palette[0] = static_cast<T>(v0);
+    palette[1] = static_cast<T>(v1);
+
+    if (v0 > v1)
+    {
+        for (int i = 1; i < 7; ++i)
+            palette[i + 1] = static_cast<T>(DivRound((7 - i) * v0 + i * v1, 7));
+    }
+    else
+    {
+        for (int i = 1; i < 5; ++i)
+            palette[i + 1] = static_cast<T>(DivRound((5 - i) * v0 + i * v1, 5));
+        palette[6] = static_cast<T>(minValue);
+        palette[7] = static_cast<T>(maxValue);
+    }
+
+    const auto indices = ReadUInt48(block + 2);
+    for (int i = 0; i < 16; ++i)
+        texels[i*stride] = palette[(indices >> (i*3)) & 0x7];
+}
+
+// Decodes a single block of the specified format into a tightly packed array of 4x4 texels.
+static void DecodeBlock(const ImageFormat format, const DataType dataType, const std::uint8_t* block, std::uint8_t* texels)
+{
+    switch (format)
+    {
+        case ImageFormat::BC1:
+            DecodeColorBlock(block, texels, true);
+            break;
+
+        case ImageFormat::BC2:
+            DecodeColorBlock(block + 8, texels, false);
+            DecodeExplicitAlphaBlock(block, texels);
+            break;
+
+        case ImageFormat::BC3:
+            DecodeColorBlock(block + 8, texels, false);
+            DecodeComponentBlock<std::uint8_t>(block, texels + 3, 4);
+            break;
+
+        case ImageFormat::BC4:
+            if (dataType == DataType::Int8)
+                DecodeComponentBlock<std::int8_t>(block, reinterpret_cast<std::int8_t*>(texels), 1);
+            else
+                DecodeComponentBlock<std::uint8_t>(block, texels, 1);
+            break;
+
+        case ImageFormat::BC5:
+            if (dataType == DataType::Int8)
+            {
+                DecodeComponentBlock<std::int8_t>(block,     reinterpret_cast<std::int8_t*>(texels),     2);
+                DecodeComponentBlock<std::int8_t>(block + 8, reinterpret_cast<std::int8_t*>(texels) + 1, 2);
+            }
+            else
+            {
+                DecodeComponentBlock<std::uint8_t>(block,     texels,     2);
+                DecodeComponentBlock<std::uint8_t>(block + 8, texels + 1, 2);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+/* ----- Functions ----- */
+
+ImageFormat GetDecompressedImageFormat(const ImageFormat format)
+{
+    switch (format)
+    {
+        case ImageFormat::BC1:  return ImageFormat::RGBA;
+        case ImageFormat::BC2:  return ImageFormat::RGBA;
+        case ImageFormat::BC3:  return ImageFormat::RGBA;
+        case ImageFormat::BC4:  return ImageFormat::R;
+        case ImageFormat::BC5:  return ImageFormat::RG;
+        default:                return format;
+    }
+}
+
+Format GetDecompressedFormat(const Format format)
+{
+    switch (format)
+    {
+        case Format::BC1UNorm:      return Format::RGBA8UNorm;
+        case Format::BC1UNorm_sRGB: return Format::RGBA8UNorm_sRGB;
+        case Format::BC2UNorm:      return Format::RGBA8UNorm;
+        case Format::BC2UNorm_sRGB: return Format::RGBA8UNorm_sRGB;
+        case Format::BC3UNorm:      return Format::RGBA8UNorm;
+        case Format::BC3UNorm_sRGB: return Format::RGBA8UNorm_sRGB;
+        case Format::BC4UNorm:      return Format::R8UNorm;
+        case Format::BC4SNorm:      return Format::R8SNorm;
+        case Format::BC5UNorm:      return Format::RG8UNorm;
+        case Format::BC5SNorm:      return Format::RG8SNorm;
+        default:                    return Format::Undefined;
+    }
+}
+
+std::size_t GetCompressedImageSize(const ImageFormat format, const Extent3D& extent)
+{
+    return
+    (
+        GetBlockSize(format) *
+        GetNumBlocks(extent.width) *
+        GetNumBlocks(extent.height) *
+        extent.depth
+    );
+}
+
+void DecompressBlockImage(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             extent,
+    void*                       dstData,
+    unsigned                    threadCount)
+{
+    const auto blockSize        = GetBlockSize(srcImageDesc.format);
+    const auto texelSize        = ImageFormatSize(GetDecompressedImageFormat(srcImageDesc.format));
+    const auto numBlocksX       = GetNumBlocks(extent.width);
+    const auto numBlocksY       = GetNumBlocks(extent.height);
+    const auto numBlockRows     = static_cast<std::size_t>(numBlocksY) * extent.depth;
+    const auto dstRowStride     = static_cast<std::size_t>(extent.width) * texelSize;
+    const auto dstDepthStride   = dstRowStride * extent.height;
+
+    if (blockSize == 0 || numBlocksX == 0 || numBlockRows == 0)
+        return;
+
+    auto src = reinterpret_cast<const std::uint8_t*>(srcImageDesc.data);
+    auto dst = reinterpret_cast<std::uint8_t*>(dstData);
+
+    /* Decompress rows of blocks in parallel, each block row is addressed by its linearized index over all slices */
+    JobSystem::ParallelFor(
+        numBlockRows,
+        std::max<std::size_t>(1, g_decompressMinWorkSize / numBlocksX),
+        threadCount,
+        [&](std::size_t begin, std::size_t end)
+        {
+            std::uint8_t texels[g_blockDim * g_blockDim * 4];
+
+            for (auto blockRow = begin; blockRow < end; ++blockRow)
+            {
+                const auto by           = static_cast<std::uint32_t>(blockRow % numBlocksY);
+                const auto z            = blockRow / numBlocksY;
+                const auto numTexelsY   = std::min(g_blockDim, extent.height - by * g_blockDim);
+
+                auto block = src + blockRow * numBlocksX * blockSize;
+
+                for (std::uint32_t bx = 0; bx < numBlocksX; ++bx, block += blockSize)
+                {
+                    DecodeBlock(srcImageDesc.format, srcImageDesc.dataType, block, texels);
+
+                    /* Copy decoded texels into destination image and clip them at the image boundary */
+                    const auto numTexelsX   = std::min(g_blockDim, extent.width - bx * g_blockDim);
+                    const auto rowSize      = numTexelsX * texelSize;
+
+                    auto dstBlock = dst + z * dstDepthStride + (by * g_blockDim) * dstRowStride + (bx * g_blockDim) * texelSize;
+
+                    for (std::uint32_t y = 0; y < numTexelsY; ++y)
+                        ::memcpy(dstBlock + y * dstRowStride, texels + y * g_blockDim * texelSize, rowSize);
+                }
+            }
+        }
+    );
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,61 @@
+/*
+ * ImageDecompressor.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_IMAGE_DECOMPRESSOR_H
+#define LLGL_IMAGE_DECOMPRESSOR_H
+
+
+#include <LLGL/ImageFlags.h>
+#include <LLGL/Format.h>
+#include <LLGL/Types.h>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/* ----- Functions ----- */
+
+/*
+Returns the uncompressed image format the specified block-compressed image format is decompressed to,
+i.e. ImageFormat::RGBA for BC1-BC3, ImageFormat::R for BC4, and ImageFormat::RG for BC5.
+The data type is not changed by the decompression. Returns the input format if it is not block-compressed.
+*/
+ImageFormat GetDecompressedImageFormat(const ImageFormat format);
+
+/*
+Returns the uncompressed hardware format the specified block-compressed hardware format is decompressed to,
+e.g. Format::RGBA8UNorm_sRGB for Format::BC1UNorm_sRGB and Format::RG8SNorm for Format::BC5SNorm.
+Returns Format::Undefined if the format is not block-compressed.
+*/
+Format GetDecompressedFormat(const Format format);
+
+// Returns the size (in bytes) of a block-compressed image with the specified extent. Each slice of the extent is compressed separately.
+std::size_t GetCompressedImageSize(const ImageFormat format, const Extent3D& extent);
+
+/*
+Decompresses the specified block-compressed source image into the destination buffer, which must have the size of the image extent
+in the format returned by GetDecompressedImageFormat. Blocks at the right and bottom edges are clipped to the image extent.
+The source data must have at least the size returned by GetCompressedImageSize.
+*/
+void DecompressBlockImage(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             extent,
+    void*                       dstData,
+    unsigned                    threadCount
+);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
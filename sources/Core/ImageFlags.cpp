@@ -7,15 +7,19 @@
 
 #include <LLGL/ImageFlags.h>
 #include <LLGL/ColorRGBA.h>
+#include <LLGL/JobSystem.h>
 #include <limits>
 #include <algorithm>
 #include <cstdint>
-#include <thread>
 #include <cstring>
 #include "ImageUtils.h"
 #include "../Core/Helper.h"
 #include "../Core/Assertion.h"
 #include "Float16Compressor.h"
+#include "ImageConversionKernels.h"
+#include "ImageCompressor.h"
+#include "ImageDecompressor.h"
+#include "ProfilerZone.h"
 
 
 namespace LLGL
@@ -24,172 +28,339 @@ namespace LLGL
 
 /* ----- Internal structures ----- */
 
+// Tag type for 16-bit floats, which are stored as 16-bit unsigned integers.
+struct Float16Tag {};
+
 /*
-The Variant structures are used to unify the data type conversion.
+The data type traits unify the conversion between each data type and the normalized range [0, 1].
+Integral types are normalized over their entire range, floating-point types are passed through.
 */
+template <typename T>
+struct DataTypeTraits
+{
+    using StorageType = T;
 
-union Variant
+    // Reads the specified source value and returns it to the normalized range [0, 1].
+    static double Read(T src)
+    {
+        const auto min = static_cast<double>(std::numeric_limits<T>::min());
+        const auto max = static_cast<double>(std::numeric_limits<T>::max());
+        return (static_cast<double>(src) - min) / (max - min);
+    }
+
+    // Returns the specified value from the range [0, 1] in the destination type.
+    static T Write(double value)
+    {
+        const auto min = static_cast<double>(std::numeric_limits<T>::min());
+        const auto max = static_cast<double>(std::numeric_limits<T>::max());
+        return static_cast<T>(value * (max - min) + min);
+    }
+};
+
+template <>
+struct DataTypeTraits<Float16Tag>
 {
-    Variant()
+    using StorageType = std::uint16_t;
+
+    static double Read(std::uint16_t src)
     {
-        // do nothing
+        return static_cast<double>(DecompressFloat16(src));
     }
 
-    std::int8_t      int8;
-    std::uint8_t     uint8;
-    std::int16_t     int16;
-    std::uint16_t    uint16;
-    std::int32_t     int32;
-    std::uint32_t    uint32;
-    float            real32;
-    double           real64;
+    static std::uint16_t Write(double value)
+    {
+        return CompressFloat16(static_cast<float>(value));
+    }
 };
 
-union VariantBuffer
+template <>
+struct DataTypeTraits<float>
 {
-    VariantBuffer(void* raw) :
-        raw { raw }
+    using StorageType = float;
+
+    static double Read(float src)
     {
+        return static_cast<double>(src);
     }
 
-    void*           raw;
-    std::int8_t*    int8;
-    std::uint8_t*   uint8;
-    std::int16_t*   int16;
-    std::uint16_t*  uint16;
-    std::int32_t*   int32;
-    std::uint32_t*  uint32;
-    float*          real32;
-    double*         real64;
+    static float Write(double value)
+    {
+        return static_cast<float>(value);
+    }
 };
 
-union VariantConstBuffer
+template <>
+struct DataTypeTraits<double>
 {
-    VariantConstBuffer(const void* raw) :
-        raw { raw }
+    using StorageType = double;
+
+    static double Read(double src)
     {
+        return src;
     }
 
-    const void*             raw;
-    const std::int8_t*      int8;
-    const std::uint8_t*     uint8;
-    const std::int16_t*     int16;
-    const std::uint16_t*    uint16;
-    const std::int32_t*     int32;
-    const std::uint32_t*    uint32;
-    const float*            real32;
-    const double*           real64;
+    static double Write(double value)
+    {
+        return value;
+    }
 };
 
-using VariantColor = ColorRGBAT<Variant>;
+/*
+The image format traits specify the index of each color component within a pixel, or -1 if the format has no such component.
+*/
+template <ImageFormat Format>
+struct ImageFormatTraits;
+
+#define LLGL_DECL_IMAGE_FORMAT_TRAITS(FORMAT, SIZE, R, G, B, A) \
+    template <>                                                 \
+    struct ImageFormatTraits<ImageFormat::FORMAT>               \
+    {                                                           \
+        static const int size   = SIZE;                         \
+        static const int r      = R;                            \
+        static const int g      = G;                            \
+        static const int b      = B;                            \
+        static const int a      = A;                            \
+    }
 
+LLGL_DECL_IMAGE_FORMAT_TRAITS( Alpha, 1, -1, -1, -1,  0 );
+LLGL_DECL_IMAGE_FORMAT_TRAITS( R,     1,  0, -1, -1, -1 );
+LLGL_DECL_IMAGE_FORMAT_TRAITS( RG,    2,  0,  1, -1, -1 );
+LLGL_DECL_IMAGE_FORMAT_TRAITS( RGB,   3,  0,  1,  2, -1 );
+LLGL_DECL_IMAGE_FORMAT_TRAITS( BGR,   3,  2,  1,  0, -1 );
+LLGL_DECL_IMAGE_FORMAT_TRAITS( RGBA,  4,  0,  1,  2,  3 );
+LLGL_DECL_IMAGE_FORMAT_TRAITS( BGRA,  4,  2,  1,  0,  3 );
+LLGL_DECL_IMAGE_FORMAT_TRAITS( ARGB,  4,  1,  2,  3,  0 );
+LLGL_DECL_IMAGE_FORMAT_TRAITS( ABGR,  4,  3,  2,  1,  0 );
+
+#undef LLGL_DECL_IMAGE_FORMAT_TRAITS
+
+// Copies a single color component from source to destination pixel, or the default value if the source format has no such component.
+template <typename T, int SrcIndex, int DstIndex>
+struct ComponentCopy
+{
+    static void Copy(const T* src, T* dst, T /*defaultValue*/)
+    {
+        dst[DstIndex] = src[SrcIndex];
+    }
+};
 
-/* ----- Internal functions ----- */
+template <typename T, int DstIndex>
+struct ComponentCopy<T, -1, DstIndex>
+{
+    static void Copy(const T* /*src*/, T* dst, T defaultValue)
+    {
+        dst[DstIndex] = defaultValue;
+    }
+};
 
-// Reads the specified source variant and returns it to the normalized range [0, 1].
-template <typename T>
-double ReadNormalizedVariant(const T& src)
+template <typename T, int SrcIndex>
+struct ComponentCopy<T, SrcIndex, -1>
 {
-    auto min = static_cast<double>(std::numeric_limits<T>::min());
-    auto max = static_cast<double>(std::numeric_limits<T>::max());
-    return (static_cast<double>(src) - min) / (max - min);
-}
+    static void Copy(const T* /*src*/, T* /*dst*/, T /*defaultValue*/)
+    {
+        // do nothing
+    }
+};
 
-// Writes the specified value from the range [0, 1] to the destination variant.
 template <typename T>
-void WriteNormalizedVariant(T& dst, double value)
+struct ComponentCopy<T, -1, -1>
 {
-    auto min = static_cast<double>(std::numeric_limits<T>::min());
-    auto max = static_cast<double>(std::numeric_limits<T>::max());
-    dst = static_cast<T>(value * (max - min) + min);
+    static void Copy(const T* /*src*/, T* /*dst*/, T /*defaultValue*/)
+    {
+        // do nothing
+    }
+};
+
+// Converts the data type of the components in the range [idxBegin, idxEnd).
+using DataTypeConverter = void (*)(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd);
+
+// Converts the image format of the pixels in the range [idxBegin, idxEnd). The default color provides the components that are missing in the source format.
+using ImageFormatConverter = void (*)(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd, const void* defaultColor);
+
+
+/* ----- Internal functions ----- */
+
+template <typename TSrc, typename TDst>
+void ConvertDataTypeRange(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    using SrcTraits = DataTypeTraits<TSrc>;
+    using DstTraits = DataTypeTraits<TDst>;
+
+    auto src = reinterpret_cast<const typename SrcTraits::StorageType*>(srcBuffer);
+    auto dst = reinterpret_cast<typename DstTraits::StorageType*>(dstBuffer);
+
+    for (auto i = idxBegin; i < idxEnd; ++i)
+        dst[i] = DstTraits::Write(SrcTraits::Read(src[i]));
 }
 
-static double ReadNormalizedTypedVariant(DataType srcDataType, const VariantConstBuffer& srcBuffer, std::size_t idx)
-{
-    switch (srcDataType)
-    {
-        case DataType::Undefined:
-            break;
-        case DataType::Int8:
-            return ReadNormalizedVariant(srcBuffer.int8[idx]);
-        case DataType::UInt8:
-            return ReadNormalizedVariant(srcBuffer.uint8[idx]);
-        case DataType::Int16:
-            return ReadNormalizedVariant(srcBuffer.int16[idx]);
-        case DataType::UInt16:
-            return ReadNormalizedVariant(srcBuffer.uint16[idx]);
-        case DataType::Int32:
-            return ReadNormalizedVariant(srcBuffer.int32[idx]);
-        case DataType::UInt32:
-            return ReadNormalizedVariant(srcBuffer.uint32[idx]);
-        case DataType::Float16:
-            return static_cast<double>(DecompressFloat16(srcBuffer.uint16[idx]));
-        case DataType::Float32:
-            return static_cast<double>(srcBuffer.real32[idx]);
-        case DataType::Float64:
-            return srcBuffer.real64[idx];
+/*
+Converts the image format with the raw storage type of the data type, since the components are only rearranged.
+The component indices are known at compile time, so the loop body is free of branches.
+*/
+template <typename T, ImageFormat SrcFormat, ImageFormat DstFormat>
+void ConvertImageFormatRange(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd, const void* defaultColor)
+{
+    using Src = ImageFormatTraits<SrcFormat>;
+    using Dst = ImageFormatTraits<DstFormat>;
+
+    auto src        = reinterpret_cast<const T*>(srcBuffer);
+    auto dst        = reinterpret_cast<T*>(dstBuffer);
+    auto defaults   = reinterpret_cast<const T*>(defaultColor);
+
+    const T defaultR = defaults[0];
+    const T defaultG = defaults[1];
+    const T defaultB = defaults[2];
+    const T defaultA = defaults[3];
+
+    for (auto i = idxBegin; i < idxEnd; ++i)
+    {
+        const T*    srcPixel = src + i * Src::size;
+        T*          dstPixel = dst + i * Dst::size;
+        ComponentCopy<T, Src::r, Dst::r>::Copy(srcPixel, dstPixel, defaultR);
+        ComponentCopy<T, Src::g, Dst::g>::Copy(srcPixel, dstPixel, defaultG);
+        ComponentCopy<T, Src::b, Dst::b>::Copy(srcPixel, dstPixel, defaultB);
+        ComponentCopy<T, Src::a, Dst::a>::Copy(srcPixel, dstPixel, defaultA);
     }
-    return 0.0;
 }
 
-static void WriteNormalizedTypedVariant(DataType dstDataType, VariantBuffer& dstBuffer, std::size_t idx, double value)
-{
-    switch (dstDataType)
-    {
-        case DataType::Undefined:
-            break;
-        case DataType::Int8:
-            WriteNormalizedVariant(dstBuffer.int8[idx], value);
-            break;
-        case DataType::UInt8:
-            WriteNormalizedVariant(dstBuffer.uint8[idx], value);
-            break;
-        case DataType::Int16:
-            WriteNormalizedVariant(dstBuffer.int16[idx], value);
-            break;
-        case DataType::UInt16:
-            WriteNormalizedVariant(dstBuffer.uint16[idx], value);
-            break;
-        case DataType::Int32:
-            WriteNormalizedVariant(dstBuffer.int32[idx], value);
-            break;
-        case DataType::UInt32:
-            WriteNormalizedVariant(dstBuffer.uint32[idx], value);
-            break;
-        case DataType::Float16:
-            dstBuffer.uint16[idx] = CompressFloat16(static_cast<float>(value));
-            break;
-        case DataType::Float32:
-            dstBuffer.real32[idx] = static_cast<float>(value);
-            break;
-        case DataType::Float64:
-            dstBuffer.real64[idx] = value;
-            break;
+// Returns the converter between the specified data types, or null if either of them is undefined.
+static DataTypeConverter GetDataTypeConverter(DataType srcDataType, DataType dstDataType)
+{
+    #define LLGL_DATA_TYPE_CONVERTERS(TSRC)             \
+        {                                               \
+            ConvertDataTypeRange< TSRC, std::int8_t   >,  \
+            ConvertDataTypeRange< TSRC, std::uint8_t  >,  \
+            ConvertDataTypeRange< TSRC, std::int16_t  >,  \
+            ConvertDataTypeRange< TSRC, std::uint16_t >,  \
+            ConvertDataTypeRange< TSRC, std::int32_t  >,  \
+            ConvertDataTypeRange< TSRC, std::uint32_t >,  \
+            ConvertDataTypeRange< TSRC, Float16Tag    >,  \
+            ConvertDataTypeRange< TSRC, float         >,  \
+            ConvertDataTypeRange< TSRC, double        >,  \
+        }
+
+    /* Lookup table in the order of the DataType enumeration, without DataType::Undefined */
+    static const DataTypeConverter g_converters[9][9] =
+    {
+        LLGL_DATA_TYPE_CONVERTERS( std::int8_t   ),
+        LLGL_DATA_TYPE_CONVERTERS( std::uint8_t  ),
+        LLGL_DATA_TYPE_CONVERTERS( std::int16_t  ),
+        LLGL_DATA_TYPE_CONVERTERS( std::uint16_t ),
+        LLGL_DATA_TYPE_CONVERTERS( std::int32_t  ),
+        LLGL_DATA_TYPE_CONVERTERS( std::uint32_t ),
+        LLGL_DATA_TYPE_CONVERTERS( Float16Tag    ),
+        LLGL_DATA_TYPE_CONVERTERS( float         ),
+        LLGL_DATA_TYPE_CONVERTERS( double        ),
+    };
+
+    #undef LLGL_DATA_TYPE_CONVERTERS
+
+    const auto srcIdx = static_cast<std::size_t>(srcDataType) - static_cast<std::size_t>(DataType::Int8);
+    const auto dstIdx = static_cast<std::size_t>(dstDataType) - static_cast<std::size_t>(DataType::Int8);
+
+    if (srcIdx < 9 && dstIdx < 9)
+        return g_converters[srcIdx][dstIdx];
+    else
+        return nullptr;
+}
+
+// Returns the converter between the specified color formats for components of the specified size, or null if there is none.
+static ImageFormatConverter GetImageFormatConverter(ImageFormat srcFormat, ImageFormat dstFormat, std::size_t dataTypeSize)
+{
+    #define LLGL_IMAGE_FORMAT_CONVERTERS_DST(T, SRC)                                    \
+        {                                                                               \
+            ConvertImageFormatRange< T, ImageFormat::SRC, ImageFormat::Alpha >,          \
+            ConvertImageFormatRange< T, ImageFormat::SRC, ImageFormat::R     >,          \
+            ConvertImageFormatRange< T, ImageFormat::SRC, ImageFormat::RG    >,          \
+            ConvertImageFormatRange< T, ImageFormat::SRC, ImageFormat::RGB   >,          \
+            ConvertImageFormatRange< T, ImageFormat::SRC, ImageFormat::BGR   >,          \
+            ConvertImageFormatRange< T, ImageFormat::SRC, ImageFormat::RGBA  >,          \
+            ConvertImageFormatRange< T, ImageFormat::SRC, ImageFormat::BGRA  >,          \
+            ConvertImageFormatRange< T, ImageFormat::SRC, ImageFormat::ARGB  >,          \
+            ConvertImageFormatRange< T, ImageFormat::SRC, ImageFormat::ABGR  >,          \
+        }
+
+    #define LLGL_IMAGE_FORMAT_CONVERTERS(T)                 \
+        {                                                   \
+            LLGL_IMAGE_FORMAT_CONVERTERS_DST( T, Alpha ),  \
+            LLGL_IMAGE_FORMAT_CONVERTERS_DST( T, R     ),  \
+            LLGL_IMAGE_FORMAT_CONVERTERS_DST( T, RG    ),  \
+            LLGL_IMAGE_FORMAT_CONVERTERS_DST( T, RGB   ),  \
+            LLGL_IMAGE_FORMAT_CONVERTERS_DST( T, BGR   ),  \
+            LLGL_IMAGE_FORMAT_CONVERTERS_DST( T, RGBA  ),  \
+            LLGL_IMAGE_FORMAT_CONVERTERS_DST( T, BGRA  ),  \
+            LLGL_IMAGE_FORMAT_CONVERTERS_DST( T, ARGB  ),  \
+            LLGL_IMAGE_FORMAT_CONVERTERS_DST( T, ABGR  ),  \
+        }
+
+    /* Lookup table for components of 1, 2, 4, and 8 bytes, and the color formats in the order of the ImageFormat enumeration */
+    static const ImageFormatConverter g_converters[4][9][9] =
+    {
+        LLGL_IMAGE_FORMAT_CONVERTERS( std::uint8_t  ),
+        LLGL_IMAGE_FORMAT_CONVERTERS( std::uint16_t ),
+        LLGL_IMAGE_FORMAT_CONVERTERS( std::uint32_t ),
+        LLGL_IMAGE_FORMAT_CONVERTERS( std::uint64_t ),
+    };
+
+    #undef LLGL_IMAGE_FORMAT_CONVERTERS
+    #undef LLGL_IMAGE_FORMAT_CONVERTERS_DST
+
+    const auto srcIdx = static_cast<std::size_t>(srcFormat) - static_cast<std::size_t>(ImageFormat::Alpha);
+    const auto dstIdx = static_cast<std::size_t>(dstFormat) - static_cast<std::size_t>(ImageFormat::Alpha);
+
+    if (srcIdx >= 9 || dstIdx >= 9)
+        return nullptr;
+
+    switch (dataTypeSize)
+    {
+        case 1: return g_converters[0][srcIdx][dstIdx];
+        case 2: return g_converters[1][srcIdx][dstIdx];
+        case 4: return g_converters[2][srcIdx][dstIdx];
+        case 8: return g_converters[3][srcIdx][dstIdx];
     }
+
+    return nullptr;
+}
+
+// Writes the RGBA color (0, 0, 0, 1) in the specified data type into the output buffer, which must have room for four components of 8 bytes.
+static void GetDefaultImageColor(DataType dataType, void* outColor)
+{
+    static const double defaultColor[4] = { 0.0, 0.0, 0.0, 1.0 };
+    if (auto converter = GetDataTypeConverter(DataType::Float64, dataType))
+        converter(defaultColor, outColor, 0, 4);
 }
 
 // Worker thread procedure for the "ConvertImageBufferDataType" function
 static void ConvertImageBufferDataTypeWorker(
-    DataType                    srcDataType,
-    const VariantConstBuffer&   srcBuffer,
-    DataType                    dstDataType,
-    VariantBuffer&              dstBuffer,
-    std::size_t                 idxBegin,
-    std::size_t                 idxEnd)
+    DataType    srcDataType,
+    const void* srcBuffer,
+    DataType    dstDataType,
+    void*       dstBuffer,
+    std::size_t idxBegin,
+    std::size_t idxEnd)
 {
-    for (auto i = idxBegin; i < idxEnd; ++i)
+    /* Convert with specialized kernel if available */
+    if (ConvertImageDataTypeWithKernel(
+            srcDataType,
+            dstDataType,
+            reinterpret_cast<const char*>(srcBuffer) + idxBegin * DataTypeSize(srcDataType),
+            reinterpret_cast<char*>(dstBuffer) + idxBegin * DataTypeSize(dstDataType),
+            idxEnd - idxBegin))
     {
-        /* Read normalized variant from source buffer */
-        double value = ReadNormalizedTypedVariant(srcDataType, srcBuffer, i);
-
-        /* Write normalized variant to destination buffer */
-        WriteNormalizedTypedVariant(dstDataType, dstBuffer, i, value);
+        return;
     }
+
+    /* Convert with converter that is specialized for the source and destination data types */
+    if (auto converter = GetDataTypeConverter(srcDataType, dstDataType))
+        converter(srcBuffer, dstBuffer, idxBegin, idxEnd);
 }
 
 // Minimal number of entries each worker thread shall process
 static const std::size_t g_threadMinWorkSize = 64;
 
+// Minimal number of pixels each thread shall fill in the "GenerateImageBuffer" function
+static const std::size_t g_fillMinWorkSize = 65536;
+
 static void ConvertImageBufferDataType(
     DataType    srcDataType,
     const void* srcBuffer,
@@ -206,254 +377,52 @@ static void ConvertImageBufferDataType(
     if (dstBufferSize != requiredDstBufferSize)
         throw std::invalid_argument("cannot convert image data type with destination buffer size mismatch");
 
-    /* Get variant buffer for source and destination images */
-    VariantConstBuffer src { srcBuffer };
-    VariantBuffer dst { dstBuffer };
-
-    threadCount = std::min(threadCount, static_cast<unsigned>(imageSize / g_threadMinWorkSize));
-
-    if (threadCount > 1)
-    {
-        /* Create worker threads */
-        std::vector<std::thread> workers(threadCount);
-
-        auto workSize       = imageSize / threadCount;
-        auto workSizeRemain = imageSize % threadCount;
-
-        std::size_t offset = 0;
-
-        for (unsigned i = 0; i < threadCount; ++i)
+    /* Execute conversion on the threads of the job system */
+    JobSystem::ParallelFor(
+        imageSize,
+        g_threadMinWorkSize,
+        threadCount,
+        [&](std::size_t idxBegin, std::size_t idxEnd)
         {
-            workers[i] = std::thread(
-                ConvertImageBufferDataTypeWorker,
-                srcDataType,
-                std::ref(src),
-                dstDataType,
-                std::ref(dst),
-                offset,
-                offset + workSize
-            );
-            offset += workSize;
+            ConvertImageBufferDataTypeWorker(srcDataType, srcBuffer, dstDataType, dstBuffer, idxBegin, idxEnd);
         }
-
-        /* Execute conversion of remaining work on main thread */
-        if (workSizeRemain > 0)
-            ConvertImageBufferDataTypeWorker(srcDataType, src, dstDataType, dst, offset, offset + workSizeRemain);
-
-        /* Join worker threads */
-        for (auto& w : workers)
-            w.join();
-    }
-    else
-    {
-        /* Execute conversion only on main thread */
-        ConvertImageBufferDataTypeWorker(srcDataType, src, dstDataType, dst, 0, imageSize);
-    }
-}
-
-static void SetVariantMinMax(DataType dataType, Variant& var, bool setMin)
-{
-    switch (dataType)
-    {
-        case DataType::Undefined:
-            break;
-        case DataType::Int8:
-            var.int8 = (setMin ? std::numeric_limits<std::int8_t>::min() : std::numeric_limits<std::int8_t>::max());
-            break;
-        case DataType::UInt8:
-            var.uint8 = (setMin ? std::numeric_limits<std::uint8_t>::min() : std::numeric_limits<std::uint8_t>::max());
-            break;
-        case DataType::Int16:
-            var.int16 = (setMin ? std::numeric_limits<std::int16_t>::min() : std::numeric_limits<std::int16_t>::max());
-            break;
-        case DataType::UInt16:
-            var.uint16 = (setMin ? std::numeric_limits<std::uint16_t>::min() : std::numeric_limits<std::uint16_t>::max());
-            break;
-        case DataType::Int32:
-            var.int32 = (setMin ? std::numeric_limits<std::int32_t>::min() : std::numeric_limits<std::int32_t>::max());
-            break;
-        case DataType::UInt32:
-            var.uint32 = (setMin ? std::numeric_limits<std::uint32_t>::min() : std::numeric_limits<std::uint32_t>::max());
-            break;
-        case DataType::Float16:
-            var.uint16 = CompressFloat16(setMin ? 0.0f : 1.0f);
-            break;
-        case DataType::Float32:
-            var.real32 = (setMin ? 0.0f : 1.0f);
-            break;
-        case DataType::Float64:
-            var.real64 = (setMin ? 0.0 : 1.0);
-            break;
-    }
-}
-
-static void CopyTypedVariant(DataType dataType, const VariantConstBuffer& srcBuffer, std::size_t idx, Variant& dst)
-{
-    switch (dataType)
-    {
-        case DataType::Undefined:
-            break;
-        case DataType::Int8:
-            dst.int8 = srcBuffer.int8[idx];
-            break;
-        case DataType::UInt8:
-            dst.uint8 = srcBuffer.uint8[idx];
-            break;
-        case DataType::Int16:
-            dst.int16 = srcBuffer.int16[idx];
-            break;
-        case DataType::UInt16:
-            dst.uint16 = srcBuffer.uint16[idx];
-            break;
-        case DataType::Int32:
-            dst.int32 = srcBuffer.int32[idx];
-            break;
-        case DataType::UInt32:
-            dst.uint32 = srcBuffer.uint32[idx];
-            break;
-        case DataType::Float16:
-            dst.uint16 = srcBuffer.uint16[idx];
-            break;
-        case DataType::Float32:
-            dst.real32 = srcBuffer.real32[idx];
-            break;
-        case DataType::Float64:
-            dst.real64 = srcBuffer.real64[idx];
-            break;
-    }
-}
-
-static void CopyTypedVariant(DataType dataType, VariantBuffer& dstBuffer, std::size_t idx, const Variant& src)
-{
-    switch (dataType)
-    {
-        case DataType::Undefined:
-            break;
-        case DataType::Int8:
-            dstBuffer.int8[idx] = src.int8;
-            break;
-        case DataType::UInt8:
-            dstBuffer.uint8[idx] = src.uint8;
-            break;
-        case DataType::Int16:
-            dstBuffer.int16[idx] = src.int16;
-            break;
-        case DataType::UInt16:
-            dstBuffer.uint16[idx] = src.uint16;
-            break;
-        case DataType::Int32:
-            dstBuffer.int32[idx] = src.int32;
-            break;
-        case DataType::UInt32:
-            dstBuffer.uint32[idx] = src.uint32;
-            break;
-        case DataType::Float16:
-            dstBuffer.uint16[idx] = src.uint16;
-            break;
-        case DataType::Float32:
-            dstBuffer.real32[idx] = src.real32;
-            break;
-        case DataType::Float64:
-            dstBuffer.real64[idx] = src.real64;
-            break;
-    }
-}
-
-template <typename TBuf, typename TVar>
-void TransferRGBAFormattedVariantColor(ImageFormat format, DataType dataType, TBuf& buffer, std::size_t idx, TVar& value)
-{
-    switch (format)
-    {
-        case ImageFormat::Alpha:
-            CopyTypedVariant(dataType, buffer, idx    , value.a);
-            break;
-        case ImageFormat::R:
-            CopyTypedVariant(dataType, buffer, idx    , value.r);
-            break;
-        case ImageFormat::RG:
-            CopyTypedVariant(dataType, buffer, idx    , value.r);
-            CopyTypedVariant(dataType, buffer, idx + 1, value.g);
-            break;
-        case ImageFormat::RGB:
-            CopyTypedVariant(dataType, buffer, idx    , value.r);
-            CopyTypedVariant(dataType, buffer, idx + 1, value.g);
-            CopyTypedVariant(dataType, buffer, idx + 2, value.b);
-            break;
-        case ImageFormat::BGR:
-            CopyTypedVariant(dataType, buffer, idx    , value.b);
-            CopyTypedVariant(dataType, buffer, idx + 1, value.g);
-            CopyTypedVariant(dataType, buffer, idx + 2, value.r);
-            break;
-        case ImageFormat::RGBA:
-            CopyTypedVariant(dataType, buffer, idx    , value.r);
-            CopyTypedVariant(dataType, buffer, idx + 1, value.g);
-            CopyTypedVariant(dataType, buffer, idx + 2, value.b);
-            CopyTypedVariant(dataType, buffer, idx + 3, value.a);
-            break;
-        case ImageFormat::BGRA:
-            CopyTypedVariant(dataType, buffer, idx    , value.b);
-            CopyTypedVariant(dataType, buffer, idx + 1, value.g);
-            CopyTypedVariant(dataType, buffer, idx + 2, value.r);
-            CopyTypedVariant(dataType, buffer, idx + 3, value.a);
-            break;
-        case ImageFormat::ARGB:
-            CopyTypedVariant(dataType, buffer, idx    , value.a);
-            CopyTypedVariant(dataType, buffer, idx + 1, value.r);
-            CopyTypedVariant(dataType, buffer, idx + 2, value.g);
-            CopyTypedVariant(dataType, buffer, idx + 3, value.b);
-            break;
-        case ImageFormat::ABGR:
-            CopyTypedVariant(dataType, buffer, idx    , value.a);
-            CopyTypedVariant(dataType, buffer, idx + 1, value.b);
-            CopyTypedVariant(dataType, buffer, idx + 2, value.g);
-            CopyTypedVariant(dataType, buffer, idx + 3, value.r);
-            break;
-        default:
-            break;
-    }
-}
-
-static void ReadRGBAFormattedVariant(
-    ImageFormat srcFormat, DataType dataType, const VariantConstBuffer& srcBuffer, std::size_t idx, VariantColor& value)
-{
-    TransferRGBAFormattedVariantColor(srcFormat, dataType, srcBuffer, idx, value);
-}
-
-static void WriteRGBAFormattedVariant(
-    ImageFormat dstFormat, DataType dataType, VariantBuffer& dstBuffer, std::size_t idx, const VariantColor& value)
-{
-    TransferRGBAFormattedVariantColor(dstFormat, dataType, dstBuffer, idx, value);
+    );
 }
 
 // Worker thread procedure for the "ConvertImageBufferFormat" function
 static void ConvertImageBufferFormatWorker(
-    ImageFormat                 srcFormat,
-    DataType                    srcDataType,
-    const VariantConstBuffer&   srcBuffer,
-    ImageFormat                 dstFormat,
-    VariantBuffer&              dstBuffer,
-    std::size_t                 idxBegin,
-    std::size_t                 idxEnd)
+    ImageFormat srcFormat,
+    DataType    srcDataType,
+    const void* srcBuffer,
+    ImageFormat dstFormat,
+    void*       dstBuffer,
+    std::size_t idxBegin,
+    std::size_t idxEnd)
 {
     /* Get size for source and destination formats */
     auto srcFormatSize  = ImageFormatSize(srcFormat);
     auto dstFormatSize  = ImageFormatSize(dstFormat);
 
-    /* Initialize default variant color (0, 0, 0, 1) */
-    VariantColor value { UninitializeTag{} };
-
-    SetVariantMinMax(srcDataType, value.r, true);
-    SetVariantMinMax(srcDataType, value.g, true);
-    SetVariantMinMax(srcDataType, value.b, true);
-    SetVariantMinMax(srcDataType, value.a, false);
-
-    for (auto i = idxBegin; i < idxEnd; ++i)
+    /* Convert with specialized kernel if available */
+    const auto dataTypeSize = DataTypeSize(srcDataType);
+    if (ConvertImageFormatWithKernel(
+            srcFormat,
+            dstFormat,
+            srcDataType,
+            reinterpret_cast<const char*>(srcBuffer) + idxBegin * srcFormatSize * dataTypeSize,
+            reinterpret_cast<char*>(dstBuffer) + idxBegin * dstFormatSize * dataTypeSize,
+            idxEnd - idxBegin))
     {
-        /* Read RGBA variant from source buffer */
-        ReadRGBAFormattedVariant(srcFormat, srcDataType, srcBuffer, i*srcFormatSize, value);
+        return;
+    }
 
-        /* Write RGBA variant to destination buffer */
-        WriteRGBAFormattedVariant(dstFormat, srcDataType, dstBuffer, i*dstFormatSize, value);
+    /* Convert with converter that is specialized for the source and destination formats, and the component size */
+    if (auto converter = GetImageFormatConverter(srcFormat, dstFormat, dataTypeSize))
+    {
+        /* Components that are missing in the source format are initialized with the color (0, 0, 0, 1) */
+        std::uint64_t defaultColor[4];
+        GetDefaultImageColor(srcDataType, defaultColor);
+        converter(srcBuffer, dstBuffer, idxBegin, idxEnd, defaultColor);
     }
 }
 
@@ -477,68 +446,24 @@ static void ConvertImageBufferFormat(
     /* Allocate destination buffer */
     imageSize /= dataTypeSize;
 
-    /* Get variant buffer for source and destination images */
-    VariantConstBuffer src { srcImageDesc.data };
-    VariantBuffer dst { dstImageDesc.data };
-
-    threadCount = std::min(threadCount, static_cast<unsigned>(imageSize / g_threadMinWorkSize));
-
-    if (threadCount > 1)
-    {
-        /* Create worker threads */
-        std::vector<std::thread> workers(threadCount);
-
-        auto workSize       = imageSize / threadCount;
-        auto workSizeRemain = imageSize % threadCount;
-
-        std::size_t offset = 0;
-
-        for (unsigned i = 0; i < threadCount; ++i)
-        {
-            workers[i] = std::thread(
-                ConvertImageBufferFormatWorker,
-                srcImageDesc.format,
-                srcImageDesc.dataType,
-                std::ref(src),
-                dstImageDesc.format,
-                std::ref(dst),
-                offset,
-                offset + workSize
-            );
-            offset += workSize;
-        }
-
-        /* Execute conversion of remaining work on main thread */
-        if (workSizeRemain > 0)
+    /* Execute conversion on the threads of the job system */
+    JobSystem::ParallelFor(
+        imageSize,
+        g_threadMinWorkSize,
+        threadCount,
+        [&](std::size_t idxBegin, std::size_t idxEnd)
         {
             ConvertImageBufferFormatWorker(
                 srcImageDesc.format,
                 srcImageDesc.dataType,
-                src,
+                srcImageDesc.data,
                 dstImageDesc.format,
-                dst,
-                offset,
-                offset + workSizeRemain
+                dstImageDesc.data,
+                idxBegin,
+                idxEnd
             );
         }
-
-        /* Join worker threads */
-        for (auto& w : workers)
-            w.join();
-    }
-    else
-    {
-        /* Execute conversion only on main thread */
-        ConvertImageBufferFormatWorker(
-            srcImageDesc.format,
-            srcImageDesc.dataType,
-            src,
-            dstImageDesc.format,
-            dst,
-            0,
-            imageSize
-        );
-    }
+    );
 }
 
 static void ValidateSourceImageDesc(const SrcImageDescriptor& imageDesc)
@@ -567,6 +492,72 @@ static void ValidateImageConversionParams(
 }
 
 
+// Number of pixels each worker converts at once through its scratch buffer in the "ConvertImageBufferInPlace" function
+static const std::size_t g_inPlaceBlockSize = 1024;
+
+struct InPlaceImageConversion
+{
+    ImageFormat srcFormat;
+    DataType    srcDataType;
+    ImageFormat dstFormat;
+    DataType    dstDataType;
+    std::size_t srcPixelSize;
+    std::size_t dstPixelSize;
+    std::size_t intermediatePixelSize;  // Pixel size with the source format and destination data type
+};
+
+/*
+Converts the pixels in the range [idxBegin, idxEnd) through the scratch buffer and copies them back into the image buffer.
+This allows the destination range to overlap its own source range, but not the source range of any other pixels that have not been converted yet.
+*/
+static void ConvertImageBlockInPlace(const InPlaceImageConversion& conv, char* buffer, std::size_t idxBegin, std::size_t idxEnd, char* scratch)
+{
+    const std::size_t   count   = idxEnd - idxBegin;
+    const char*         src     = buffer + idxBegin * conv.srcPixelSize;
+
+    if (conv.srcDataType != conv.dstDataType)
+    {
+        /* Convert data type into first half of scratch buffer */
+        char* intermediate = scratch;
+        ConvertImageBufferDataTypeWorker(
+            conv.srcDataType,
+            src,
+            conv.dstDataType,
+            intermediate,
+            0,
+            count * ImageFormatSize(conv.srcFormat)
+        );
+        src = intermediate;
+    }
+
+    if (conv.srcFormat != conv.dstFormat)
+    {
+        /* Convert image format into second half of scratch buffer */
+        char* dst = scratch + g_inPlaceBlockSize * conv.intermediatePixelSize;
+        ConvertImageBufferFormatWorker(conv.srcFormat, conv.dstDataType, src, conv.dstFormat, dst, 0, count);
+        src = dst;
+    }
+
+    ::memcpy(buffer + idxBegin * conv.dstPixelSize, src, count * conv.dstPixelSize);
+}
+
+// Converts the pixels in the range [idxBegin, idxEnd) in parallel. None of the destination blocks must overlap the source range of any pixels within this range.
+static void ConvertImageRangeInPlace(const InPlaceImageConversion& conv, char* buffer, std::size_t idxBegin, std::size_t idxEnd, unsigned threadCount)
+{
+    JobSystem::ParallelFor(
+        idxEnd - idxBegin,
+        g_inPlaceBlockSize,
+        threadCount,
+        [&](std::size_t begin, std::size_t end)
+        {
+            auto scratch = MakeUniqueArray<char>(g_inPlaceBlockSize * (conv.intermediatePixelSize + conv.dstPixelSize));
+            for (std::size_t i = idxBegin + begin; i < idxBegin + end; i += g_inPlaceBlockSize)
+                ConvertImageBlockInPlace(conv, buffer, i, std::min(i + g_inPlaceBlockSize, idxBegin + end), scratch.get());
+        }
+    );
+}
+
+
 /* ----- Public functions ----- */
 
 LLGL_EXPORT bool ConvertImageBuffer(
@@ -574,13 +565,15 @@ LLGL_EXPORT bool ConvertImageBuffer(
     const DstImageDescriptor&   dstImageDesc,
     unsigned                    threadCount)
 {
+    LLGL_PROFILER_ZONE("ConvertImageBuffer");
+
     /* Validate input parameters */
     ValidateSourceImageDesc(srcImageDesc);
     ValidateDestinationImageDesc(dstImageDesc);
     ValidateImageConversionParams(srcImageDesc, dstImageDesc.format, dstImageDesc.dataType);
 
     if (threadCount >= Constants::maxThreadCount)
-        threadCount = std::thread::hardware_concurrency();
+        threadCount = JobSystem::GetThreadCount();
 
     if (srcImageDesc.dataType != dstImageDesc.dataType && srcImageDesc.format != dstImageDesc.format)
     {
@@ -642,12 +635,14 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
     DataType                    dstDataType,
     unsigned                    threadCount)
 {
+    LLGL_PROFILER_ZONE("ConvertImageBuffer");
+
     /* Validate input parameters */
     ValidateSourceImageDesc(srcImageDesc);
     ValidateImageConversionParams(srcImageDesc, dstFormat, dstDataType);
 
     if (threadCount >= Constants::maxThreadCount)
-        threadCount = std::thread::hardware_concurrency();
+        threadCount = JobSystem::GetThreadCount();
 
     /* Initialize destination image descriptor */
     auto srcNumPixels = srcImageDesc.dataSize / (DataTypeSize(srcImageDesc.dataType) * ImageFormatSize(srcImageDesc.format));
@@ -725,6 +720,91 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
     return nullptr;
 }
 
+LLGL_EXPORT bool ConvertImageBufferInPlace(
+    const DstImageDescriptor&   imageDesc,
+    std::size_t                 bufferCapacity,
+    ImageFormat                 dstFormat,
+    DataType                    dstDataType,
+    unsigned                    threadCount)
+{
+    LLGL_PROFILER_ZONE("ConvertImageBufferInPlace");
+
+    /* Validate input parameters */
+    ValidateDestinationImageDesc(imageDesc);
+
+    const SrcImageDescriptor srcImageDesc{ imageDesc.format, imageDesc.dataType, imageDesc.data, imageDesc.dataSize };
+    ValidateImageConversionParams(srcImageDesc, dstFormat, dstDataType);
+
+    if (imageDesc.format == dstFormat && imageDesc.dataType == dstDataType)
+        return false;
+
+    if (threadCount >= Constants::maxThreadCount)
+        threadCount = JobSystem::GetThreadCount();
+
+    InPlaceImageConversion conv;
+    {
+        conv.srcFormat              = imageDesc.format;
+        conv.srcDataType            = imageDesc.dataType;
+        conv.dstFormat              = dstFormat;
+        conv.dstDataType            = dstDataType;
+        conv.srcPixelSize           = ImageFormatSize(imageDesc.format) * DataTypeSize(imageDesc.dataType);
+        conv.dstPixelSize           = ImageFormatSize(dstFormat) * DataTypeSize(dstDataType);
+        conv.intermediatePixelSize  = ImageFormatSize(imageDesc.format) * DataTypeSize(dstDataType);
+    }
+
+    const std::size_t numPixels = imageDesc.dataSize / conv.srcPixelSize;
+    if (bufferCapacity < imageDesc.dataSize || bufferCapacity < numPixels * conv.dstPixelSize)
+        throw std::invalid_argument("cannot convert image buffer in place with insufficient buffer capacity");
+
+    auto buffer     = reinterpret_cast<char*>(imageDesc.data);
+    auto scratch    = MakeUniqueArray<char>(g_inPlaceBlockSize * (conv.intermediatePixelSize + conv.dstPixelSize));
+
+    if (conv.dstPixelSize == conv.srcPixelSize)
+    {
+        /* Each pixel is only written to its own source range, so all blocks are independent */
+        ConvertImageRangeInPlace(conv, buffer, 0, numPixels, threadCount);
+    }
+    else if (conv.dstPixelSize < conv.srcPixelSize)
+    {
+        /*
+        Convert from front to back: Once the pixels [0, begin) have been converted, the pixels [begin, begin * srcPixelSize / dstPixelSize)
+        are only written to the source range of the converted pixels, so each of these waves is converted in parallel.
+        The first block is converted on its own, since it overlaps its own source range.
+        */
+        std::size_t begin = std::min(numPixels, g_inPlaceBlockSize);
+        ConvertImageBlockInPlace(conv, buffer, 0, begin, scratch.get());
+
+        while (begin < numPixels)
+        {
+            const std::size_t end = std::min(numPixels, begin * conv.srcPixelSize / conv.dstPixelSize);
+            ConvertImageRangeInPlace(conv, buffer, begin, end, threadCount);
+            begin = end;
+        }
+    }
+    else
+    {
+        /*
+        Convert from back to front: Once the pixels [end, numPixels) have been converted, the pixels [ceil(end * srcPixelSize / dstPixelSize), end)
+        are only written to the source range of the converted pixels, so each of these waves is converted in parallel.
+        The last block and the remaining pixels at the front are converted on their own, since they overlap their own source range.
+        */
+        std::size_t end = numPixels - std::min(numPixels, g_inPlaceBlockSize);
+        ConvertImageBlockInPlace(conv, buffer, end, numPixels, scratch.get());
+
+        while (end > g_inPlaceBlockSize)
+        {
+            const std::size_t begin = (end * conv.srcPixelSize + conv.dstPixelSize - 1) / conv.dstPixelSize;
+            ConvertImageRangeInPlace(conv, buffer, begin, end, threadCount);
+            end = begin;
+        }
+
+        if (end > 0)
+            ConvertImageBlockInPlace(conv, buffer, 0, end, scratch.get());
+    }
+
+    return true;
+}
+
 // Returns the 1D flattened buffer position for a 3D image coordinate ('bpp' denotes the bytes per pixel)
 static std::size_t GetFlattenedImageBufferPos(
     std::uint32_t x,
@@ -755,6 +835,82 @@ static std::size_t GetFlattenedImageBufferPosEnd(
     ) + bpp;
 }
 
+LLGL_EXPORT ByteBuffer DecompressImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             extent,
+    unsigned                    threadCount)
+{
+    /* Validate input parameters */
+    LLGL_ASSERT_PTR(srcImageDesc.data);
+
+    if (!IsCompressedFormat(srcImageDesc.format))
+        throw std::invalid_argument("cannot decompress image with uncompressed image format");
+    if (srcImageDesc.dataSize < GetCompressedImageSize(srcImageDesc.format, extent))
+        throw std::invalid_argument("source image data size is too small for compressed image extent");
+
+    if (threadCount >= Constants::maxThreadCount)
+        threadCount = JobSystem::GetThreadCount();
+
+    /* Decompress image into new buffer */
+    const auto dstImageSize = GetMemoryFootprint(
+        GetDecompressedImageFormat(srcImageDesc.format),
+        srcImageDesc.dataType,
+        static_cast<std::size_t>(extent.width) * extent.height * extent.depth
+    );
+
+    auto dstImage = AllocateByteBuffer(dstImageSize, UninitializeTag{});
+    DecompressBlockImage(srcImageDesc, extent, dstImage.get(), threadCount);
+
+    return dstImage;
+}
+
+LLGL_EXPORT ByteBuffer CompressImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             extent,
+    ImageFormat                 dstFormat,
+    DataType                    dstDataType,
+    unsigned                    threadCount)
+{
+    LLGL_PROFILER_ZONE("CompressImageBuffer");
+
+    /* Validate input parameters */
+    LLGL_ASSERT_PTR(srcImageDesc.data);
+
+    if (!IsCompressedFormat(dstFormat))
+        throw std::invalid_argument("cannot compress image into uncompressed image format");
+    if (!(dstDataType == DataType::UInt8 || (dstDataType == DataType::Int8 && (dstFormat == ImageFormat::BC4 || dstFormat == ImageFormat::BC5))))
+        throw std::invalid_argument("invalid data type for compressed image format");
+    if (IsCompressedFormat(srcImageDesc.format) || IsDepthStencilFormat(srcImageDesc.format))
+        throw std::invalid_argument("cannot compress image with compressed or depth-stencil image format");
+
+    const auto numTexels    = static_cast<std::size_t>(extent.width) * extent.height * extent.depth;
+    const auto srcImageSize = GetMemoryFootprint(srcImageDesc.format, srcImageDesc.dataType, numTexels);
+
+    if (srcImageDesc.dataSize < srcImageSize)
+        throw std::invalid_argument("source image data size is too small for image extent");
+
+    if (threadCount >= Constants::maxThreadCount)
+        threadCount = JobSystem::GetThreadCount();
+
+    /* Convert source image into the format the destination format is decompressed to */
+    const auto uncompressedFormat = GetDecompressedImageFormat(dstFormat);
+
+    SrcImageDescriptor uncompressedImageDesc{ srcImageDesc.format, srcImageDesc.dataType, srcImageDesc.data, srcImageSize };
+    ByteBuffer intermediateImage;
+
+    if (srcImageDesc.format != uncompressedFormat || srcImageDesc.dataType != dstDataType)
+    {
+        intermediateImage = ConvertImageBuffer(uncompressedImageDesc, uncompressedFormat, dstDataType, threadCount);
+        uncompressedImageDesc = SrcImageDescriptor{ uncompressedFormat, dstDataType, intermediateImage.get(), GetMemoryFootprint(uncompressedFormat, dstDataType, numTexels) };
+    }
+
+    /* Compress image into new buffer */
+    auto dstImage = AllocateByteBuffer(GetCompressedImageSize(dstFormat, extent), UninitializeTag{});
+    CompressBlockImage(uncompressedImageDesc, extent, dstFormat, dstImage.get(), threadCount);
+
+    return dstImage;
+}
+
 LLGL_EXPORT void CopyImageBufferRegion(
     const DstImageDescriptor&   dstImageDesc,
     const Offset3D&             dstOffset,
@@ -809,29 +965,33 @@ LLGL_EXPORT ByteBuffer GenerateImageBuffer(
     const ColorRGBAd&   fillColor)
 {
     /* Convert fill color data type */
-    VariantColor fillColor0 { UninitializeTag{} };
-    VariantBuffer fillBuffer0 { &fillColor0 };
+    const double fillColorRGBA[4] = { fillColor.r, fillColor.g, fillColor.b, fillColor.a };
+    std::uint64_t fillColor0[4] = {};
 
-    WriteNormalizedTypedVariant(dataType, fillBuffer0, 0, fillColor.r);
-    WriteNormalizedTypedVariant(dataType, fillBuffer0, 1, fillColor.g);
-    WriteNormalizedTypedVariant(dataType, fillBuffer0, 2, fillColor.b);
-    WriteNormalizedTypedVariant(dataType, fillBuffer0, 3, fillColor.a);
+    if (auto converter = GetDataTypeConverter(DataType::Float64, dataType))
+        converter(fillColorRGBA, fillColor0, 0, 4);
 
     /* Convert fill color format */
-    VariantColor fillColor1 { UninitializeTag{} };
-    VariantBuffer fillBuffer1 { &fillColor1 };
-    VariantConstBuffer fillBuffer2 { fillBuffer0.raw };
+    std::uint64_t fillColor1[4] = {};
 
-    ReadRGBAFormattedVariant(ImageFormat::RGBA, dataType, fillBuffer2, 0, fillColor1);
-    WriteRGBAFormattedVariant(format, dataType, fillBuffer1, 0, fillColor1);
+    if (auto converter = GetImageFormatConverter(ImageFormat::RGBA, format, DataTypeSize(dataType)))
+        converter(fillColor0, fillColor1, 0, 1, fillColor0);
 
     /* Allocate image buffer */
     const auto bytesPerPixel = DataTypeSize(dataType) * ImageFormatSize(format);
     auto imageBuffer = MakeUniqueArray<char>(bytesPerPixel * imageSize);
 
     /* Initialize image buffer with fill color */
-    for (std::size_t i = 0; i < imageSize; ++i)
-        ::memcpy(imageBuffer.get() + bytesPerPixel * i, fillBuffer1.raw, bytesPerPixel);
+    JobSystem::ParallelFor(
+        imageSize,
+        g_fillMinWorkSize,
+        Constants::maxThreadCount,
+        [&](std::size_t idxBegin, std::size_t idxEnd)
+        {
+            for (auto i = idxBegin; i < idxEnd; ++i)
+                ::memcpy(imageBuffer.get() + bytesPerPixel * i, fillColor1, bytesPerPixel);
+        }
+    );
 
     return imageBuffer;
 }
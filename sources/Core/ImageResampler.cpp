@@ -0,0 +1,694 @@
+/*
+ * ImageResampler.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ImageResampler.h"
+#include "Float16Compressor.h"
+#include <LLGL/JobSystem.h>
+#include <LLGL/Constants.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal structures ----- */
+
+// Image with 32-bit floating-point components, which is the working format of the resampler.
+struct FloatImage
+{
+    Extent3D            extent;
+    std::uint32_t       components  = 0;
+    std::vector<float>  data;
+};
+
+// Range of source pixels and their weights that contribute to a single destination pixel along one dimension.
+struct Contribution
+{
+    std::uint32_t   first       = 0;
+    std::uint32_t   count       = 0;
+    std::size_t     weights     = 0;
+};
+
+struct Contributions
+{
+    std::vector<Contribution>   pixels;
+    std::vector<float>          weights;
+};
+
+
+/* ----- Internal functions ----- */
+
+static const double g_pi = 3.14159265358979323846;
+
+// Minimal number of floats each thread shall process in a single resampling pass
+static const std::size_t g_resampleMinWorkSize = 16384;
+
+static double Sinc(double x)
+{
+    if (std::abs(x) < 1.0e-8)
+        return 1.0;
+    x *= g_pi;
+    return std::sin(x) / x;
+}
+
+// Modified Bessel function of the first kind and order zero.
+static double BesselI0(double x)
+{
+    double sum  = 1.0;
+    double term = 1.0;
+    const double halfX = x * 0.5;
+    for (int k = 1; k < 64 && term > sum * 1.0e-12; ++k)
+    {
+        term *= (halfX / k) * (halfX / k);
+        sum  += term;
+    }
+    return sum;
+}
+
+// Returns the radius of the specified filter (in pixels) at a scale of 1.
+static double GetFilterRadius(ImageFilter filter)
+{
+    switch (filter)
+    {
+        case ImageFilter::Nearest:  return 0.0;
+        case ImageFilter::Box:      return 0.5;
+        case ImageFilter::Triangle: return 1.0;
+        case ImageFilter::Kaiser:   return 3.0;
+        case ImageFilter::Lanczos:  return 3.0;
+    }
+    return 0.0;
+}
+
+static double EvalFilter(ImageFilter filter, double x)
+{
+    switch (filter)
+    {
+        case ImageFilter::Nearest:
+            return 1.0;
+
+        case ImageFilter::Box:
+            /* Half-open interval, so a source pixel on the boundary of two destination pixels only contributes to one of them */
+            return (x >= -0.5 && x < 0.5 ? 1.0 : 0.0);
+
+        case ImageFilter::Triangle:
+            x = std::abs(x);
+            return (x < 1.0 ? 1.0 - x : 0.0);
+
+        case ImageFilter::Kaiser:
+        {
+            const double radius = 3.0, alpha = 4.0;
+            const double t = x / radius;
+            if (t <= -1.0 || t >= 1.0)
+                return 0.0;
+            return Sinc(x) * BesselI0(alpha * std::sqrt(1.0 - t*t)) / BesselI0(alpha);
+        }
+
+        case ImageFilter::Lanczos:
+        {
+            const double radius = 3.0;
+            if (x <= -radius || x >= radius)
+                return 0.0;
+            return Sinc(x) * Sinc(x / radius);
+        }
+    }
+    return 0.0;
+}
+
+// Returns the contributions of the source pixels for each destination pixel along one dimension.
+static Contributions ComputeContributions(std::uint32_t srcSize, std::uint32_t dstSize, ImageFilter filter)
+{
+    Contributions contribs;
+    contribs.pixels.resize(dstSize);
+
+    const double scale = static_cast<double>(srcSize) / static_cast<double>(dstSize);
+
+    if (filter == ImageFilter::Nearest)
+    {
+        /* Take the source pixel whose area contains the center of the destination pixel */
+        contribs.weights.resize(dstSize, 1.0f);
+        for (std::uint32_t i = 0; i < dstSize; ++i)
+        {
+            const auto center = static_cast<std::uint32_t>((i + 0.5) * scale);
+            contribs.pixels[i].first    = std::min(center, srcSize - 1);
+            contribs.pixels[i].count    = 1;
+            contribs.pixels[i].weights  = i;
+        }
+        return contribs;
+    }
+
+    /* Widen filter when the image is reduced, so all source pixels contribute to the result */
+    const double filterScale    = std::max(1.0, scale);
+    const double radius         = GetFilterRadius(filter) * filterScale;
+
+    std::vector<double> weights;
+
+    for (std::uint32_t i = 0; i < dstSize; ++i)
+    {
+        /* Determine range of source pixels within the filter radius around the destination pixel center */
+        const double center = (i + 0.5) * scale;
+        const auto   begin  = static_cast<std::int64_t>(std::floor(center - radius));
+        const auto   end    = static_cast<std::int64_t>(std::ceil(center + radius));
+
+        /* Accumulate weights, and clamp source pixels outside the image to its edges */
+        const auto first = static_cast<std::int64_t>(std::max<std::int64_t>(0, begin));
+        const auto last  = static_cast<std::int64_t>(std::min<std::int64_t>(srcSize - 1, end));
+
+        weights.assign(static_cast<std::size_t>(last - first + 1), 0.0);
+        double weightSum = 0.0;
+
+        for (auto j = begin; j <= end; ++j)
+        {
+            const double w = EvalFilter(filter, (j + 0.5 - center) / filterScale);
+            if (w != 0.0)
+            {
+                const auto k = std::min(std::max(j, first), last) - first;
+                weights[static_cast<std::size_t>(k)] += w;
+                weightSum += w;
+            }
+        }
+
+        /* Trim zero weights at both ends of the range */
+        std::size_t trimBegin = 0, trimEnd = weights.size();
+        while (trimBegin + 1 < trimEnd && weights[trimBegin] == 0.0)
+            ++trimBegin;
+        while (trimEnd > trimBegin + 1 && weights[trimEnd - 1] == 0.0)
+            --trimEnd;
+
+        /* Store normalized weights */
+        auto& pixel = contribs.pixels[i];
+        pixel.first     = static_cast<std::uint32_t>(first + static_cast<std::int64_t>(trimBegin));
+        pixel.count     = static_cast<std::uint32_t>(trimEnd - trimBegin);
+        pixel.weights   = contribs.weights.size();
+
+        for (auto k = trimBegin; k < trimEnd; ++k)
+            contribs.weights.push_back(static_cast<float>(weightSum != 0.0 ? weights[k] / weightSum : 1.0 / (trimEnd - trimBegin)));
+    }
+
+    return contribs;
+}
+
+/*
+Resamples the lines of an image along one dimension. The source has the layout [outer][srcSize][inner] and the destination [outer][dstSize][inner],
+i.e. 'inner' is 1 for the X-axis, the row length for the Y-axis, and the slice size for the Z-axis (each times the number of components).
+*/
+static void ResampleDimension(
+    const float*            src,
+    float*                  dst,
+    std::size_t             outer,
+    std::uint32_t           srcSize,
+    std::uint32_t           dstSize,
+    std::size_t             inner,
+    const Contributions&    contribs)
+{
+    JobSystem::ParallelFor(
+        outer * dstSize,
+        std::max<std::size_t>(1, g_resampleMinWorkSize / inner),
+        Constants::maxThreadCount,
+        [&](std::size_t lineBegin, std::size_t lineEnd)
+        {
+            for (auto line = lineBegin; line < lineEnd; ++line)
+            {
+                const auto  o       = line / dstSize;
+                const auto& pixel   = contribs.pixels[line % dstSize];
+                const auto  weights = &(contribs.weights[pixel.weights]);
+
+                float*          dstLine = dst + line * inner;
+                const float*    srcLine = src + (o * srcSize + pixel.first) * inner;
+
+                /* Accumulate weighted source lines; the inner loop is contiguous, so it can be vectorized by the compiler */
+                for (std::size_t j = 0; j < inner; ++j)
+                    dstLine[j] = srcLine[j] * weights[0];
+
+                for (std::uint32_t k = 1; k < pixel.count; ++k)
+                {
+                    srcLine += inner;
+                    const float w = weights[k];
+                    for (std::size_t j = 0; j < inner; ++j)
+                        dstLine[j] += srcLine[j] * w;
+                }
+            }
+        }
+    );
+}
+
+/*
+Resamples the rows of an image along the X-axis. This is a specialization of ResampleDimension where the number of components is known at compile time,
+since the generic inner loop would only have a few iterations per source pixel.
+*/
+template <std::uint32_t Components>
+void ResampleRows(
+    const float*            src,
+    float*                  dst,
+    std::size_t             numRows,
+    std::uint32_t           srcSize,
+    std::uint32_t           dstSize,
+    const Contributions&    contribs)
+{
+    JobSystem::ParallelFor(
+        numRows,
+        std::max<std::size_t>(1, g_resampleMinWorkSize / (dstSize * Components)),
+        Constants::maxThreadCount,
+        [&](std::size_t rowBegin, std::size_t rowEnd)
+        {
+            for (auto row = rowBegin; row < rowEnd; ++row)
+            {
+                const float*    srcRow = src + row * srcSize * Components;
+                float*          dstRow = dst + row * dstSize * Components;
+
+                for (std::uint32_t x = 0; x < dstSize; ++x)
+                {
+                    const auto& pixel   = contribs.pixels[x];
+                    const auto  weights = &(contribs.weights[pixel.weights]);
+                    const auto  srcPtr  = srcRow + pixel.first * Components;
+
+                    float sum[Components] = {};
+                    for (std::uint32_t k = 0; k < pixel.count; ++k)
+                    {
+                        for (std::uint32_t c = 0; c < Components; ++c)
+                            sum[c] += srcPtr[k * Components + c] * weights[k];
+                    }
+
+                    for (std::uint32_t c = 0; c < Components; ++c)
+                        dstRow[x * Components + c] = sum[c];
+                }
+            }
+        }
+    );
+}
+
+static FloatImage ResampleFloatImage(const FloatImage& srcImage, const Extent3D& dstExtent, ImageFilter filter)
+{
+    FloatImage image;
+    image.extent        = dstExtent;
+    image.components    = srcImage.components;
+
+    const std::uint32_t dstSize[3] = { dstExtent.width, dstExtent.height, dstExtent.depth };
+
+    /* Resample each dimension separately */
+    std::uint32_t       extent[3]   = { srcImage.extent.width, srcImage.extent.height, srcImage.extent.depth };
+    const float*        src         = srcImage.data.data();
+    std::vector<float>  data;
+
+    for (int dim = 0; dim < 3; ++dim)
+    {
+        if (extent[dim] == dstSize[dim])
+            continue;
+
+        std::size_t inner = image.components, outer = 1;
+        for (int i = 0; i < dim; ++i)
+            inner *= extent[i];
+        for (int i = dim + 1; i < 3; ++i)
+            outer *= extent[i];
+
+        const auto contribs = ComputeContributions(extent[dim], dstSize[dim], filter);
+
+        std::vector<float> dst(outer * dstSize[dim] * inner);
+
+        switch (dim == 0 ? inner : 0)
+        {
+            case 1:  ResampleRows<1>(src, dst.data(), outer, extent[dim], dstSize[dim], contribs); break;
+            case 2:  ResampleRows<2>(src, dst.data(), outer, extent[dim], dstSize[dim], contribs); break;
+            case 3:  ResampleRows<3>(src, dst.data(), outer, extent[dim], dstSize[dim], contribs); break;
+            case 4:  ResampleRows<4>(src, dst.data(), outer, extent[dim], dstSize[dim], contribs); break;
+            default: ResampleDimension(src, dst.data(), outer, extent[dim], dstSize[dim], inner, contribs); break;
+        }
+
+        data        = std::move(dst);
+        src         = data.data();
+        extent[dim] = dstSize[dim];
+    }
+
+    /* Copy source image if no dimension has been resampled */
+    if (data.empty())
+        data = srcImage.data;
+
+    image.data = std::move(data);
+
+    return image;
+}
+
+// Returns the index of the alpha component of the specified format, or -1 if there is none.
+static int GetAlphaComponentIndex(ImageFormat format)
+{
+    switch (format)
+    {
+        case ImageFormat::Alpha:    return 0;
+        case ImageFormat::RGBA:     return 3;
+        case ImageFormat::BGRA:     return 3;
+        case ImageFormat::ARGB:     return 0;
+        case ImageFormat::ABGR:     return 0;
+        default:                    return -1;
+    }
+}
+
+static float SRGBToLinear(float value)
+{
+    return (value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f));
+}
+
+static float LinearToSRGB(float value)
+{
+    return (value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f);
+}
+
+/*
+Lookup tables for 8-bit sRGB images, which avoid the power functions for each component.
+The encoding table contains the linear value at the midpoint between each pair of adjacent 8-bit sRGB values,
+so the upper bound of a linear value within this table is the correctly rounded 8-bit sRGB value.
+*/
+struct SRGBTables
+{
+    SRGBTables()
+    {
+        for (int i = 0; i < 256; ++i)
+        {
+            decode[i]   = SRGBToLinear(static_cast<float>(i) / 255.0f);
+            normalize[i] = static_cast<float>(i) / 255.0f;
+        }
+        for (int i = 0; i < 255; ++i)
+            encodeThresholds[i] = SRGBToLinear((static_cast<float>(i) + 0.5f) / 255.0f);
+        for (int i = 0; i < 4096; ++i)
+        {
+            const float value = static_cast<float>(i) / 4095.0f;
+            encodeStart[i] = static_cast<std::uint8_t>(std::upper_bound(encodeThresholds, encodeThresholds + 255, value) - encodeThresholds);
+        }
+    }
+
+    // Returns the correctly rounded 8-bit sRGB value of the specified linear value.
+    std::uint8_t Encode(float value) const
+    {
+        /* Start at the sRGB value of the bucket's lower bound, and step over the few remaining thresholds within this bucket */
+        value = (value > 0.0f ? std::min(value, 1.0f) : 0.0f);
+        std::uint32_t idx = encodeStart[static_cast<std::size_t>(value * 4095.0f)];
+        while (idx < 255 && encodeThresholds[idx] <= value)
+            ++idx;
+        return static_cast<std::uint8_t>(idx);
+    }
+
+    float           decode[256];
+    float           normalize[256];
+    float           encodeThresholds[255];
+    std::uint8_t    encodeStart[4096];
+};
+
+static const SRGBTables& GetSRGBTables()
+{
+    static const SRGBTables tables;
+    return tables;
+}
+
+// Converts the color components (i.e. all except alpha) of the specified pixels between sRGB and linear space.
+static void TransformColorSpace(float* pixels, std::size_t numPixels, std::uint32_t components, int alphaIndex, float (*transform)(float))
+{
+    for (std::size_t i = 0; i < numPixels; ++i)
+    {
+        float* pixel = pixels + i * components;
+        for (std::uint32_t c = 0; c < components; ++c)
+        {
+            if (static_cast<int>(c) != alphaIndex)
+                pixel[c] = transform(std::max(0.0f, pixel[c]));
+        }
+    }
+}
+
+static void ValidateResampleImageDesc(ImageFormat format, std::size_t dataSize, DataType dataType, const Extent3D& extent)
+{
+    if (IsCompressedFormat(format) || IsDepthStencilFormat(format))
+        throw std::invalid_argument("cannot resample compressed or depth-stencil image formats");
+    if (dataSize < GetMemoryFootprint(format, dataType, extent.width * extent.height * extent.depth))
+        throw std::invalid_argument("cannot resample image with insufficient data size");
+}
+
+// Reads the specified image into a floating-point image and converts it into linear space if 'sRGB' is true.
+static FloatImage ReadFloatImage(const SrcImageDescriptor& imageDesc, const Extent3D& extent, bool sRGB)
+{
+    FloatImage image;
+    image.extent        = extent;
+    image.components    = ImageFormatSize(imageDesc.format);
+    image.data.resize(static_cast<std::size_t>(extent.width) * extent.height * extent.depth * image.components);
+
+    const auto dataSize     = image.data.size() * sizeof(float);
+    const auto alphaIndex   = GetAlphaComponentIndex(imageDesc.format);
+
+    if (sRGB && imageDesc.dataType == DataType::UInt8)
+    {
+        /* Decode 8-bit sRGB image with lookup table for each component, where alpha is only normalized */
+        const auto& tables      = GetSRGBTables();
+        const auto  src         = reinterpret_cast<const std::uint8_t*>(imageDesc.data);
+        const auto  components  = image.components;
+
+        const float* luts[4];
+        for (std::uint32_t c = 0; c < components; ++c)
+            luts[c] = (static_cast<int>(c) == alphaIndex ? tables.normalize : tables.decode);
+
+        JobSystem::ParallelFor(
+            image.data.size() / components,
+            g_resampleMinWorkSize / components,
+            Constants::maxThreadCount,
+            [&](std::size_t begin, std::size_t end)
+            {
+                for (auto i = begin; i < end; ++i)
+                {
+                    for (std::uint32_t c = 0; c < components; ++c)
+                        image.data[i * components + c] = luts[c][src[i * components + c]];
+                }
+            }
+        );
+
+        return image;
+    }
+
+    if (imageDesc.dataType == DataType::Float32)
+        ::memcpy(image.data.data(), imageDesc.data, dataSize);
+    else
+    {
+        const SrcImageDescriptor srcImageDesc{ imageDesc.format, imageDesc.dataType, imageDesc.data, GetMemoryFootprint(imageDesc.format, imageDesc.dataType, static_cast<std::uint32_t>(image.data.size() / image.components)) };
+        const DstImageDescriptor dstImageDesc{ imageDesc.format, DataType::Float32, image.data.data(), dataSize };
+        ConvertImageBuffer(srcImageDesc, dstImageDesc, Constants::maxThreadCount);
+    }
+
+    if (sRGB)
+    {
+        JobSystem::ParallelFor(
+            image.data.size() / image.components,
+            g_resampleMinWorkSize / image.components,
+            Constants::maxThreadCount,
+            [&](std::size_t begin, std::size_t end)
+            {
+                TransformColorSpace(&(image.data[begin * image.components]), end - begin, image.components, alphaIndex, SRGBToLinear);
+            }
+        );
+    }
+
+    return image;
+}
+
+// Quantizes normalized floats into integers with rounding, to avoid that MIP-maps get darker with each level.
+template <typename T>
+void QuantizeFloats(const float* src, T* dst, std::size_t count)
+{
+    const auto min      = static_cast<std::int64_t>(std::numeric_limits<T>::min());
+    const auto range    = static_cast<double>(std::numeric_limits<T>::max()) - static_cast<double>(min);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        /* Value is clamped to [0, 1] first, so truncation rounds to the nearest integer */
+        const double value = std::min(std::max(static_cast<double>(src[i]), 0.0), 1.0);
+        dst[i] = static_cast<T>(static_cast<std::int64_t>(value * range + 0.5) + min);
+    }
+}
+
+static void WriteFloats(const float* src, DataType dataType, void* dst, std::size_t count)
+{
+    switch (dataType)
+    {
+        case DataType::Undefined:
+            break;
+        case DataType::Int8:
+            QuantizeFloats(src, reinterpret_cast<std::int8_t*>(dst), count);
+            break;
+        case DataType::UInt8:
+            QuantizeFloats(src, reinterpret_cast<std::uint8_t*>(dst), count);
+            break;
+        case DataType::Int16:
+            QuantizeFloats(src, reinterpret_cast<std::int16_t*>(dst), count);
+            break;
+        case DataType::UInt16:
+            QuantizeFloats(src, reinterpret_cast<std::uint16_t*>(dst), count);
+            break;
+        case DataType::Int32:
+            QuantizeFloats(src, reinterpret_cast<std::int32_t*>(dst), count);
+            break;
+        case DataType::UInt32:
+            QuantizeFloats(src, reinterpret_cast<std::uint32_t*>(dst), count);
+            break;
+        case DataType::Float16:
+            CompressFloat16Array(src, reinterpret_cast<std::uint16_t*>(dst), count);
+            break;
+        case DataType::Float32:
+            ::memcpy(dst, src, count * sizeof(float));
+            break;
+        case DataType::Float64:
+            for (std::size_t i = 0; i < count; ++i)
+                reinterpret_cast<double*>(dst)[i] = static_cast<double>(src[i]);
+            break;
+    }
+}
+
+// Writes the specified floating-point image into the destination buffer and converts it back into sRGB space if 'sRGB' is true.
+static void WriteFloatImage(const FloatImage& image, ImageFormat format, DataType dataType, void* dst, bool sRGB)
+{
+    const auto components   = image.components;
+    const auto alphaIndex   = GetAlphaComponentIndex(format);
+    const auto pixelSize    = DataTypeSize(dataType) * components;
+
+    JobSystem::ParallelFor(
+        image.data.size() / components,
+        g_resampleMinWorkSize / components,
+        Constants::maxThreadCount,
+        [&](std::size_t begin, std::size_t end)
+        {
+            const float*    src     = &(image.data[begin * components]);
+            char*           dstPtr  = reinterpret_cast<char*>(dst) + begin * pixelSize;
+
+            if (sRGB && dataType == DataType::UInt8)
+            {
+                /* Encode 8-bit sRGB image with lookup table */
+                const auto& tables  = GetSRGBTables();
+                auto        dst8    = reinterpret_cast<std::uint8_t*>(dstPtr);
+
+                for (std::size_t i = 0; i < end - begin; ++i)
+                {
+                    for (std::uint32_t c = 0; c < components; ++c)
+                    {
+                        const auto idx = i * components + c;
+                        if (static_cast<int>(c) == alphaIndex)
+                            QuantizeFloats(src + idx, dst8 + idx, 1);
+                        else
+                            dst8[idx] = tables.Encode(src[idx]);
+                    }
+                }
+            }
+            else if (sRGB)
+            {
+                /* Transform color space in a temporary copy, since the linear image is kept for the next MIP-map */
+                std::vector<float> pixels(src, src + (end - begin) * components);
+                TransformColorSpace(pixels.data(), end - begin, components, alphaIndex, LinearToSRGB);
+                WriteFloats(pixels.data(), dataType, dstPtr, pixels.size());
+            }
+            else
+                WriteFloats(src, dataType, dstPtr, (end - begin) * components);
+        }
+    );
+}
+
+static Extent3D GetMipExtent(const Extent3D& extent, std::uint32_t mipLevel)
+{
+    return Extent3D
+    {
+        std::max(1u, extent.width  >> mipLevel),
+        std::max(1u, extent.height >> mipLevel),
+        std::max(1u, extent.depth  >> mipLevel)
+    };
+}
+
+static std::uint32_t GetNumPixels(const Extent3D& extent)
+{
+    return (extent.width * extent.height * extent.depth);
+}
+
+
+/* ----- Functions ----- */
+
+void ResampleImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             srcExtent,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             dstExtent,
+    ImageFilter                 filter,
+    bool                        sRGB)
+{
+    /* Validate input parameters */
+    if (srcImageDesc.format != dstImageDesc.format || srcImageDesc.dataType != dstImageDesc.dataType)
+        throw std::invalid_argument("cannot resample image with source and destination images having different format or data type");
+
+    ValidateResampleImageDesc(srcImageDesc.format, srcImageDesc.dataSize, srcImageDesc.dataType, srcExtent);
+    ValidateResampleImageDesc(dstImageDesc.format, dstImageDesc.dataSize, dstImageDesc.dataType, dstExtent);
+
+    if (GetNumPixels(srcExtent) == 0 || GetNumPixels(dstExtent) == 0)
+        return;
+
+    /* Resample image in floating-point precision */
+    const auto srcImage = ReadFloatImage(srcImageDesc, srcExtent, sRGB);
+    const auto dstImage = ResampleFloatImage(srcImage, dstExtent, filter);
+    WriteFloatImage(dstImage, dstImageDesc.format, dstImageDesc.dataType, dstImageDesc.data, sRGB);
+}
+
+ByteBuffer GenerateMipChain(
+    const SrcImageDescriptor&           srcImageDesc,
+    const Extent3D&                     extent,
+    std::uint32_t                       numMipLevels,
+    ImageFilter                         filter,
+    bool                                sRGB,
+    std::vector<SrcImageDescriptor>*    outMipImageDescs)
+{
+    /* Validate input parameters */
+    ValidateResampleImageDesc(srcImageDesc.format, srcImageDesc.dataSize, srcImageDesc.dataType, extent);
+
+    const auto maxNumMipLevels = NumMipLevels(extent.width, extent.height, extent.depth);
+    numMipLevels = (numMipLevels == 0 ? maxNumMipLevels : std::min(numMipLevels, maxNumMipLevels));
+
+    /* Determine offsets of all MIP-maps within the output buffer */
+    std::vector<std::size_t> mipOffsets(numMipLevels + 1, 0);
+    for (std::uint32_t mip = 0; mip < numMipLevels; ++mip)
+        mipOffsets[mip + 1] = mipOffsets[mip] + GetMemoryFootprint(srcImageDesc.format, srcImageDesc.dataType, GetNumPixels(GetMipExtent(extent, mip)));
+
+    auto buffer = AllocateByteBuffer(mipOffsets.back(), UninitializeTag{});
+
+    if (outMipImageDescs)
+    {
+        outMipImageDescs->clear();
+        outMipImageDescs->reserve(numMipLevels);
+        for (std::uint32_t mip = 0; mip < numMipLevels; ++mip)
+        {
+            outMipImageDescs->push_back(
+                SrcImageDescriptor{ srcImageDesc.format, srcImageDesc.dataType, buffer.get() + mipOffsets[mip], mipOffsets[mip + 1] - mipOffsets[mip] }
+            );
+        }
+    }
+
+    if (numMipLevels == 0)
+        return buffer;
+
+    /* Copy first MIP-map from source image */
+    ::memcpy(buffer.get(), srcImageDesc.data, mipOffsets[1]);
+
+    /* Resample each MIP-map from the previous one */
+    if (numMipLevels > 1)
+    {
+        auto image = ReadFloatImage(srcImageDesc, extent, sRGB);
+
+        for (std::uint32_t mip = 1; mip < numMipLevels; ++mip)
+        {
+            image = ResampleFloatImage(image, GetMipExtent(extent, mip), filter);
+            WriteFloatImage(image, srcImageDesc.format, srcImageDesc.dataType, buffer.get() + mipOffsets[mip], sRGB);
+        }
+    }
+
+    return buffer;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
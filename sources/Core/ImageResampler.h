@@ -0,0 +1,61 @@
+/*
+ * ImageResampler.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_IMAGE_RESAMPLER_H
+#define LLGL_IMAGE_RESAMPLER_H
+
+
+#include <LLGL/ImageFlags.h>
+#include <LLGL/Types.h>
+#include <cstdint>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/* ----- Functions ----- */
+
+/*
+Resamples the source image into the destination image with the specified filter.
+Both images must have the same uncompressed color format and data type.
+If 'sRGB' is true, the color components are filtered in linear space, but the alpha component is always filtered as is.
+*/
+void ResampleImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             srcExtent,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             dstExtent,
+    ImageFilter                 filter,
+    bool                        sRGB
+);
+
+/*
+Generates a MIP-map chain of the source image with the specified filter and returns all MIP-maps in one contiguous buffer, starting with a copy of the source image.
+Each MIP-map is resampled from the previous one in 32-bit floating-point precision, so rounding errors do not accumulate across the MIP-map chain.
+If 'numMipLevels' is 0, the full MIP-map chain is generated.
+If 'outMipImageDescs' is non-null, it receives one source image descriptor for each MIP-map, which refer to the returned buffer.
+*/
+ByteBuffer GenerateMipChain(
+    const SrcImageDescriptor&           srcImageDesc,
+    const Extent3D&                     extent,
+    std::uint32_t                       numMipLevels,
+    ImageFilter                         filter,
+    bool                                sRGB,
+    std::vector<SrcImageDescriptor>*    outMipImageDescs
+);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
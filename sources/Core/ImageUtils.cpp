@@ -7,6 +7,9 @@
 
 #include "ImageUtils.h"
 #include <LLGL/Types.h>
+#include <LLGL/Constants.h>
+#include <LLGL/JobSystem.h>
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 
@@ -15,6 +18,41 @@ namespace LLGL
 {
 
 
+// Minimal number of bytes a copy must have to be distributed across the threads of the job system
+static const std::size_t g_parallelCopyMinSize = 4u * 1024u * 1024u;
+
+// Minimal number of bytes each thread shall copy
+static const std::size_t g_parallelCopyGrainSize = 1024u * 1024u;
+
+static unsigned GetMaxCopyThreads(std::size_t size)
+{
+    return (size >= g_parallelCopyMinSize ? Constants::maxThreadCount : 1u);
+}
+
+// Copies the linearized byte range [begin, end) of a region whose slices are contiguous, but whose slices may have different strides in source and destination.
+static void CopySliceRange(
+    std::size_t     begin,
+    std::size_t     end,
+    std::size_t     sliceSize,
+    char*           dst,
+    std::size_t     dstDepthStride,
+    const char*     src,
+    std::size_t     srcDepthStride)
+{
+    while (begin < end)
+    {
+        const std::size_t z         = begin / sliceSize;
+        const std::size_t offset    = begin % sliceSize;
+        const std::size_t size      = std::min(sliceSize - offset, end - begin);
+        ::memcpy(
+            dst + z * dstDepthStride + offset,
+            src + z * srcDepthStride + offset,
+            size
+        );
+        begin += size;
+    }
+}
+
 void BitBlit(
     const Extent3D& extent,
     std::uint32_t   bpp,
@@ -25,56 +63,76 @@ void BitBlit(
     std::uint32_t   srcRowStride,
     std::uint32_t   srcDepthStride)
 {
-    const auto rowStride    = bpp * extent.width;
-    const auto depthStride  = rowStride * extent.height;
+    const std::size_t rowStride     = bpp * extent.width;
+    const std::size_t depthStride   = rowStride * extent.height;
+    const std::size_t imageSize     = depthStride * extent.depth;
+
+    if (imageSize == 0)
+        return;
 
-    if (srcRowStride == dstRowStride && rowStride == dstRowStride)
+    /* Rows are contiguous if the region covers the full width of both images, or if it consists of a single row */
+    const bool contiguousRows =
+    (
+        extent.height == 1 ||
+        (srcRowStride == rowStride && dstRowStride == rowStride)
+    );
+
+    if (contiguousRows && (extent.depth == 1 || (srcDepthStride == depthStride && dstDepthStride == depthStride)))
     {
-        if (srcDepthStride == dstDepthStride && depthStride == dstDepthStride)
-        {
-            /* Copy region directly into output data */
-            ::memcpy(dst, src, depthStride * extent.depth);
-        }
-        else
-        {
-            /* Copy region directly into output data */
-            for (std::uint32_t z = 0; z < extent.depth; ++z)
+        /* Copy region directly into output data */
+        JobSystem::ParallelFor(
+            imageSize,
+            g_parallelCopyGrainSize,
+            GetMaxCopyThreads(imageSize),
+            [dst, src](std::size_t begin, std::size_t end)
             {
-                /* Copy current slice */
-                ::memcpy(dst, src, depthStride);
-
-                /* Move pointers to next slice */
-                dst += dstDepthStride;
-                src += srcDepthStride;
+                ::memcpy(dst + begin, src + begin, end - begin);
+            }
+        );
+    }
+    else if (contiguousRows)
+    {
+        /* Copy region slice by slice into output data, large slices are split into several ranges */
+        JobSystem::ParallelFor(
+            imageSize,
+            g_parallelCopyGrainSize,
+            GetMaxCopyThreads(imageSize),
+            [&](std::size_t begin, std::size_t end)
+            {
+                CopySliceRange(begin, end, depthStride, dst, dstDepthStride, src, srcDepthStride);
             }
-        }
+        );
     }
     else
     {
-        /* Adjust depth stride */
-        srcDepthStride -= srcRowStride * extent.height;
-
-        /* Copy region directly into output data */
-        for (std::uint32_t z = 0; z < extent.depth; ++z)
-        {
-            /* Copy current slice */
-            for (std::uint32_t y = 0; y < extent.height; ++y)
+        /* Copy region row by row into output data, each row is addressed by its linearized index over all slices */
+        const std::size_t numRows = static_cast<std::size_t>(extent.height) * extent.depth;
+        JobSystem::ParallelFor(
+            numRows,
+            std::max<std::size_t>(1, g_parallelCopyGrainSize / rowStride),
+            GetMaxCopyThreads(imageSize),
+            [&](std::size_t begin, std::size_t end)
             {
-                /* Copy current row */
-                ::memcpy(dst, src, rowStride);
-
-                /* Move pointers to next row */
-                dst += dstRowStride;
-                src += srcRowStride;
+                std::size_t y = begin % extent.height;
+                std::size_t z = begin / extent.height;
+                for (auto row = begin; row < end; ++row)
+                {
+                    ::memcpy(
+                        dst + z * dstDepthStride + y * dstRowStride,
+                        src + z * srcDepthStride + y * srcRowStride,
+                        rowStride
+                    );
+                    if (++y == extent.height)
+                    {
+                        y = 0;
+                        ++z;
+                    }
+                }
             }
-
-            /* Move pointers to next slice */
-            src += srcDepthStride;
-        }
+        );
     }
 }
 
-
 } // /namespace LLGL
 
 
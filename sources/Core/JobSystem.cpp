@@ -0,0 +1,349 @@
+/*
+ * JobSystem.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/JobSystem.h>
+#include <LLGL/Constants.h>
+#include "Helper.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace LLGL
+{
+
+namespace JobSystem
+{
+
+
+/*
+Thread pool with one task queue per worker thread.
+Each worker takes tasks from the front of its own queue and steals tasks from the back of the other queues once its own queue is empty.
+The thread that runs a batch of jobs does not block, but executes pending tasks of any queue until its batch has finished,
+so nested parallel operations cannot deadlock the pool.
+Asynchronous tasks are detached batches with a single job, which are deleted after they have been executed.
+*/
+class ThreadPool
+{
+
+    public:
+
+        ThreadPool(unsigned numThreads) :
+            queues_ { numThreads }
+        {
+            for (auto& queue : queues_)
+                queue = MakeUnique<TaskQueue>();
+
+            workers_.reserve(numThreads);
+            for (unsigned i = 0; i < numThreads; ++i)
+                workers_.push_back(std::thread(&ThreadPool::WorkerMain, this, i));
+        }
+
+        // Waits for all pending tasks, including asynchronous ones, before the worker threads are joined.
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> guard{ wakeMutex_ };
+                quit_ = true;
+            }
+            wakeSignal_.notify_all();
+
+            for (auto& worker : workers_)
+                worker.join();
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator = (const ThreadPool&) = delete;
+
+        // Runs the specified job for each index in [0, numJobs) and returns when all of them have finished.
+        void Run(std::size_t numJobs, const std::function<void(std::size_t)>& job)
+        {
+            Batch batch;
+            {
+                batch.job = &job;
+                batch.numRemainingJobs = numJobs;
+            }
+
+            /* Distribute tasks across all queues */
+            for (std::size_t i = 0; i < numJobs; ++i)
+            {
+                auto& queue = *queues_[(nextQueue_++) % queues_.size()];
+                std::lock_guard<std::mutex> guard{ queue.mutex };
+                queue.tasks.push_back(Task{ &batch, i });
+            }
+
+            {
+                std::lock_guard<std::mutex> guard{ wakeMutex_ };
+                numPendingTasks_ += numJobs;
+            }
+            wakeSignal_.notify_all();
+
+            /* Help executing tasks until this batch has finished */
+            while (batch.numRemainingJobs.load() > 0)
+            {
+                Task task = {};
+                if (TakeTask(0, task))
+                    ExecuteTask(task);
+                else
+                    std::this_thread::yield();
+            }
+        }
+
+        // Schedules the specified task without waiting for it.
+        void RunAsync(const AsyncTask& task)
+        {
+            /* Detached batch owns its job and is deleted by the worker that executes it */
+            auto batch = new Batch{};
+            {
+                batch->asyncTask        = task;
+                batch->numRemainingJobs = 1;
+            }
+
+            {
+                auto& queue = *queues_[(nextQueue_++) % queues_.size()];
+                std::lock_guard<std::mutex> guard{ queue.mutex };
+                queue.tasks.push_back(Task{ batch, 0 });
+            }
+
+            {
+                std::lock_guard<std::mutex> guard{ wakeMutex_ };
+                ++numPendingTasks_;
+            }
+            wakeSignal_.notify_one();
+        }
+
+        // Returns the number of worker threads.
+        unsigned GetNumThreads() const
+        {
+            return static_cast<unsigned>(workers_.size());
+        }
+
+    private:
+
+        struct Batch
+        {
+            const std::function<void(std::size_t)>* job                 = nullptr;
+            AsyncTask                               asyncTask;                      // Only used for detached batches, in which case 'job' is null.
+            std::atomic<std::size_t>                numRemainingJobs;
+        };
+
+        struct Task
+        {
+            Batch*      batch;
+            std::size_t index;
+        };
+
+        struct TaskQueue
+        {
+            std::mutex          mutex;
+            std::deque<Task>    tasks;
+        };
+
+    private:
+
+        // Takes a task from the front of the specified queue or steals one from the back of any other queue.
+        bool TakeTask(std::size_t ownQueue, Task& outTask)
+        {
+            for (std::size_t i = 0; i < queues_.size(); ++i)
+            {
+                auto& queue = *queues_[(ownQueue + i) % queues_.size()];
+                std::lock_guard<std::mutex> guard{ queue.mutex };
+                if (!queue.tasks.empty())
+                {
+                    if (i == 0)
+                    {
+                        outTask = queue.tasks.front();
+                        queue.tasks.pop_front();
+                    }
+                    else
+                    {
+                        outTask = queue.tasks.back();
+                        queue.tasks.pop_back();
+                    }
+                    --numPendingTasks_;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void ExecuteTask(const Task& task)
+        {
+            if (task.batch->job == nullptr)
+            {
+                task.batch->asyncTask();
+                delete task.batch;
+            }
+            else
+            {
+                (*task.batch->job)(task.index);
+                --task.batch->numRemainingJobs;
+            }
+        }
+
+        void WorkerMain(std::size_t ownQueue)
+        {
+            while (true)
+            {
+                Task task = {};
+                if (TakeTask(ownQueue, task))
+                    ExecuteTask(task);
+                else
+                {
+                    /* Wait until new tasks are scheduled or the pool is destroyed; pending tasks are finished first */
+                    std::unique_lock<std::mutex> lock{ wakeMutex_ };
+                    wakeSignal_.wait(lock, [this]() { return (quit_ || numPendingTasks_.load() > 0); });
+                    if (quit_ && numPendingTasks_.load() == 0)
+                        return;
+                }
+            }
+        }
+
+    private:
+
+        std::vector<std::unique_ptr<TaskQueue>> queues_;
+        std::vector<std::thread>                workers_;
+        std::atomic<std::size_t>                nextQueue_          { 0 };
+
+        std::mutex                              wakeMutex_;
+        std::condition_variable                 wakeSignal_;
+        std::atomic<std::size_t>                numPendingTasks_    { 0 };
+        bool                                    quit_               = false;
+
+};
+
+struct JobSystemState
+{
+    std::mutex                  mutex;
+    Scheduler                   scheduler;
+    unsigned                    threadCount = 0;
+    std::unique_ptr<ThreadPool> threadPool;
+};
+
+static JobSystemState g_jobSystemState;
+
+
+/* ----- Internal functions ----- */
+
+static unsigned GetDefaultThreadCount()
+{
+    const unsigned hardwareThreads = std::thread::hardware_concurrency();
+    return (hardwareThreads > 1 ? hardwareThreads - 1 : 0);
+}
+
+static unsigned GetConfiguredThreadCount()
+{
+    return (g_jobSystemState.threadCount > 0 ? g_jobSystemState.threadCount : GetDefaultThreadCount());
+}
+
+// Returns the built-in thread pool and creates it on first use.
+static ThreadPool* GetThreadPool()
+{
+    std::lock_guard<std::mutex> guard{ g_jobSystemState.mutex };
+    if (!g_jobSystemState.threadPool)
+    {
+        const auto numThreads = GetConfiguredThreadCount();
+        if (numThreads == 0)
+            return nullptr;
+        g_jobSystemState.threadPool = MakeUnique<ThreadPool>(numThreads);
+    }
+    return g_jobSystemState.threadPool.get();
+}
+
+
+/* ----- Functions ----- */
+
+LLGL_EXPORT void SetScheduler(const Scheduler& scheduler)
+{
+    std::lock_guard<std::mutex> guard{ g_jobSystemState.mutex };
+    g_jobSystemState.scheduler = scheduler;
+}
+
+LLGL_EXPORT void SetThreadCount(unsigned threadCount)
+{
+    std::unique_ptr<ThreadPool> prevThreadPool;
+    {
+        std::lock_guard<std::mutex> guard{ g_jobSystemState.mutex };
+        g_jobSystemState.threadCount = threadCount;
+        prevThreadPool = std::move(g_jobSystemState.threadPool);
+    }
+}
+
+LLGL_EXPORT unsigned GetThreadCount()
+{
+    std::lock_guard<std::mutex> guard{ g_jobSystemState.mutex };
+    return GetConfiguredThreadCount() + 1;
+}
+
+LLGL_EXPORT void ParallelFor(std::size_t count, std::size_t grainSize, unsigned maxThreads, const RangeTask& task)
+{
+    if (count == 0)
+        return;
+
+    if (maxThreads == Constants::maxThreadCount)
+        maxThreads = GetThreadCount();
+
+    /* Determine number of ranges */
+    grainSize = std::max<std::size_t>(1, grainSize);
+    const auto numJobs = std::min<std::size_t>(maxThreads, count / grainSize);
+
+    if (numJobs < 2)
+    {
+        task(0, count);
+        return;
+    }
+
+    /* Split work items evenly, and distribute the remainder across the first ranges */
+    const auto workSize         = count / numJobs;
+    const auto workSizeRemain   = count % numJobs;
+
+    const std::function<void(std::size_t)> job = [&task, workSize, workSizeRemain](std::size_t jobIndex)
+    {
+        const auto begin = jobIndex * workSize + std::min(jobIndex, workSizeRemain);
+        const auto end   = begin + workSize + (jobIndex < workSizeRemain ? 1 : 0);
+        task(begin, end);
+    };
+
+    /* Run jobs with custom scheduler or built-in thread pool */
+    Scheduler scheduler;
+    {
+        std::lock_guard<std::mutex> guard{ g_jobSystemState.mutex };
+        scheduler = g_jobSystemState.scheduler;
+    }
+
+    if (scheduler)
+        scheduler(numJobs, job);
+    else if (auto threadPool = GetThreadPool())
+        threadPool->Run(numJobs, job);
+    else
+        task(0, count);
+}
+
+LLGL_EXPORT void Async(const AsyncTask& task)
+{
+    if (!task)
+        return;
+
+    if (auto threadPool = GetThreadPool())
+        threadPool->RunAsync(task);
+    else
+        task();
+}
+
+
+} // /namespace JobSystem
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -6,8 +6,15 @@
  */
 
 #include <LLGL/Log.h>
+#include "Helper.h"
 #include <mutex>
 #include <string>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <condition_variable>
+#include <unordered_set>
 
 
 namespace LLGL
@@ -17,44 +24,236 @@ namespace Log
 {
 
 
+/*
+Bounded multi-producer/single-consumer ring buffer for asynchronous reports.
+Each entry carries a sequence number, so producers only synchronize via atomic operations (after Dmitry Vyukov's bounded MPMC queue).
+*/
+class ReportQueue
+{
+
+    public:
+
+        ReportQueue(std::size_t size);
+
+        // Copies the specified report into the queue. Returns false if the queue is full.
+        bool Push(ReportType type, const StringView& message, const StringView& contextInfo);
+
+        // Takes the next report out of the queue. Returns false if the queue is empty. Must only be called by one thread at a time.
+        bool Pop(ReportType& outType, std::string& outMessage, std::string& outContextInfo);
+
+    private:
+
+        struct Entry
+        {
+            std::atomic<std::size_t>    sequence    { 0 };
+            ReportType                  type        = ReportType::Information;
+            std::string                 message;
+            std::string                 contextInfo;
+        };
+
+    private:
+
+        std::unique_ptr<Entry[]>    entries_;
+        std::size_t                 mask_       = 0;
+        std::atomic<std::size_t>    enqueuePos_ { 0 };
+        std::size_t                 dequeuePos_ = 0;
+
+};
+
+static std::size_t RoundUpToPowerOfTwo(std::size_t x)
+{
+    std::size_t n = 1;
+    while (n < x)
+        n <<= 1;
+    return n;
+}
+
+ReportQueue::ReportQueue(std::size_t size) :
+    entries_ { MakeUniqueArray<Entry>(RoundUpToPowerOfTwo(size)) },
+    mask_    { RoundUpToPowerOfTwo(size) - 1        }
+{
+    for (std::size_t i = 0; i <= mask_; ++i)
+        entries_[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+bool ReportQueue::Push(ReportType type, const StringView& message, const StringView& contextInfo)
+{
+    /* Reserve next free entry */
+    Entry* entry = nullptr;
+    std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        entry = &entries_[pos & mask_];
+        const std::size_t seq = entry->sequence.load(std::memory_order_acquire);
+        if (seq == pos)
+        {
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (seq < pos)
+        {
+            /* Entry still holds a report from the previous round -> queue is full */
+            return false;
+        }
+        else
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+    }
+
+    /* Copy report into entry and publish it to the consumer */
+    entry->type = type;
+    entry->message.assign(message.begin(), message.end());
+    entry->contextInfo.assign(contextInfo.begin(), contextInfo.end());
+    entry->sequence.store(pos + 1, std::memory_order_release);
+
+    return true;
+}
+
+bool ReportQueue::Pop(ReportType& outType, std::string& outMessage, std::string& outContextInfo)
+{
+    Entry& entry = entries_[dequeuePos_ & mask_];
+    if (entry.sequence.load(std::memory_order_acquire) != dequeuePos_ + 1)
+        return false;
+
+    /* Swap strings, so the entry keeps the capacity of the previous report for the next producer */
+    outType = entry.type;
+    outMessage.swap(entry.message);
+    outContextInfo.swap(entry.contextInfo);
+
+    /* Release entry for the next round of the ring buffer */
+    entry.sequence.store(dequeuePos_ + mask_ + 1, std::memory_order_release);
+    ++dequeuePos_;
+
+    return true;
+}
+
 struct LogState
 {
-    std::mutex      reportMutex;
-    ReportCallback  reportCallback  = nullptr;
-    std::ostream*   outputStream    = nullptr;
-    void*           userData        = nullptr;
-    std::size_t     limit           = 0;
-    std::size_t     counter         = 0;
+    ~LogState();
+
+    std::mutex                      reportMutex;
+    ReportCallback                  reportCallback  = nullptr;
+    std::ostream*                   outputStream    = nullptr;
+    void*                           userData        = nullptr;
+    std::atomic<std::size_t>        limit           { 0 };
+    std::atomic<std::size_t>        counter         { 0 };
+    std::atomic<std::size_t>        numDelivered    { 0 };
+    std::atomic<std::size_t>        numDropped      { 0 };
+    std::atomic<std::size_t>        numDuplicates   { 0 };
+
+    /* Deduplication (guarded by reportMutex) */
+    bool                            deduplicate     = false;
+    std::unordered_set<std::string> reportKeys;
+
+    /* Asynchronous delivery */
+    std::unique_ptr<ReportQueue>    queue;
+    std::atomic<ReportQueue*>       asyncQueue      { nullptr };
+    std::mutex                      flushMutex;
+    std::thread                     worker;
+    std::mutex                      workerMutex;
+    std::condition_variable         workerSignal;
+    bool                            workerQuit      = false;
 };
 
 static LogState g_logState;
 
 
-/* ----- Functions ----- */
+/* ----- Internal functions ----- */
 
-LLGL_EXPORT void PostReport(ReportType type, const StringView& message, const StringView& contextInfo)
+static bool IsDuplicateReport(ReportType type, const StringView& message, const StringView& contextInfo)
+{
+    std::string key;
+    key.reserve(1 + contextInfo.size() + 1 + message.size());
+    key.push_back(static_cast<char>(type));
+    key.append(contextInfo.begin(), contextInfo.end());
+    key.push_back('\0');
+    key.append(message.begin(), message.end());
+    return !g_logState.reportKeys.insert(std::move(key)).second;
+}
+
+static void DeliverReport(ReportType type, const StringView& message, const StringView& contextInfo)
 {
     ReportCallback  callback;
     void*           userData    = nullptr;
-    bool            ignore      = false;
 
     /* Get callback and user data with a lock guard */
     {
         std::lock_guard<std::mutex> guard{ g_logState.reportMutex };
 
+        /* Suppress reports that have already been delivered */
+        if (g_logState.deduplicate && IsDuplicateReport(type, message, contextInfo))
+        {
+            g_logState.numDuplicates++;
+            return;
+        }
+
         /* Get callback and user data */
         callback = g_logState.reportCallback;
         userData = g_logState.userData;
-
-        /* Increase report counter and check if the report must be ignored */
-        g_logState.counter++;
-        if (g_logState.limit > 0 && g_logState.counter > g_logState.limit)
-            ignore = true;
     }
 
     /* Post report to callback */
-    if (!ignore && callback != nullptr)
+    if (callback != nullptr)
+    {
         callback(type, message, contextInfo, userData);
+        g_logState.numDelivered++;
+    }
+}
+
+static void ReportWorkerMain()
+{
+    /* Deliver queued reports periodically; producers never signal this thread, so posting a report never blocks */
+    std::unique_lock<std::mutex> lock{ g_logState.workerMutex };
+    while (!g_logState.workerQuit)
+    {
+        g_logState.workerSignal.wait_for(lock, std::chrono::milliseconds(10));
+        lock.unlock();
+        FlushReports();
+        lock.lock();
+    }
+}
+
+static void StopReportWorker()
+{
+    if (g_logState.worker.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> guard{ g_logState.workerMutex };
+            g_logState.workerQuit = true;
+        }
+        g_logState.workerSignal.notify_one();
+        g_logState.worker.join();
+        g_logState.workerQuit = false;
+    }
+}
+
+LogState::~LogState()
+{
+    StopReportWorker();
+}
+
+
+/* ----- Functions ----- */
+
+LLGL_EXPORT void PostReport(ReportType type, const StringView& message, const StringView& contextInfo)
+{
+    /* Increase report counter and check if the report must be ignored */
+    const std::size_t count = ++g_logState.counter;
+    const std::size_t limit = g_logState.limit.load();
+    if (limit > 0 && count > limit)
+    {
+        g_logState.numDropped++;
+        return;
+    }
+
+    /* Only queue up report in asynchronous mode */
+    if (ReportQueue* queue = g_logState.asyncQueue.load(std::memory_order_acquire))
+    {
+        if (!queue->Push(type, message, contextInfo))
+            g_logState.numDropped++;
+        return;
+    }
+
+    DeliverReport(type, message, contextInfo);
 }
 
 LLGL_EXPORT void SetReportCallback(const ReportCallback& callback, void* userData)
@@ -87,10 +286,63 @@ LLGL_EXPORT void SetReportCallbackStd(std::ostream* stream)
 
 LLGL_EXPORT void SetReportLimit(std::size_t maxCount)
 {
-    std::lock_guard<std::mutex> guard{ g_logState.reportMutex };
     g_logState.limit = maxCount;
 }
 
+LLGL_EXPORT void SetReportDeduplication(bool enable)
+{
+    std::lock_guard<std::mutex> guard{ g_logState.reportMutex };
+    g_logState.deduplicate = enable;
+    if (!enable)
+        g_logState.reportKeys.clear();
+}
+
+LLGL_EXPORT void SetReportAsync(std::size_t queueSize, bool backgroundThread)
+{
+    /* Deliver all pending reports before the queue is replaced */
+    StopReportWorker();
+    FlushReports();
+
+    g_logState.asyncQueue.store(nullptr, std::memory_order_release);
+    g_logState.queue.reset();
+
+    if (queueSize > 0)
+    {
+        g_logState.queue = MakeUnique<ReportQueue>(queueSize);
+        g_logState.asyncQueue.store(g_logState.queue.get(), std::memory_order_release);
+        if (backgroundThread)
+            g_logState.worker = std::thread{ ReportWorkerMain };
+    }
+}
+
+LLGL_EXPORT void FlushReports()
+{
+    if (ReportQueue* queue = g_logState.asyncQueue.load(std::memory_order_acquire))
+    {
+        /* Only one thread at a time can take reports out of the queue */
+        std::lock_guard<std::mutex> guard{ g_logState.flushMutex };
+
+        ReportType  type = ReportType::Information;
+        std::string message;
+        std::string contextInfo;
+
+        while (queue->Pop(type, message, contextInfo))
+            DeliverReport(type, message, contextInfo);
+    }
+}
+
+LLGL_EXPORT ReportStatistics GetReportStatistics()
+{
+    ReportStatistics stats;
+    {
+        stats.numPosted     = g_logState.counter.load();
+        stats.numDelivered  = g_logState.numDelivered.load();
+        stats.numDropped    = g_logState.numDropped.load();
+        stats.numDuplicates = g_logState.numDuplicates.load();
+    }
+    return stats;
+}
+
 
 } // /namespace Log
 
@@ -0,0 +1,95 @@
+/*
+ * ProfilerZone.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ProfilerZone.h"
+#include <atomic>
+
+
+namespace LLGL
+{
+
+namespace ProfilerZone
+{
+
+
+#ifdef LLGL_ENABLE_PROFILER_ZONES
+
+struct ProfilerZoneCallbacks
+{
+    std::atomic<ZoneBeginCallback>  beginCallback   { nullptr };
+    ZoneEndCallback                 endCallback     = nullptr;
+    void*                           userData        = nullptr;
+};
+
+static ProfilerZoneCallbacks g_profilerZoneCallbacks;
+
+#endif // /LLGL_ENABLE_PROFILER_ZONES
+
+LLGL_EXPORT bool IsSupported()
+{
+    #ifdef LLGL_ENABLE_PROFILER_ZONES
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+#ifdef LLGL_ENABLE_PROFILER_ZONES
+
+LLGL_EXPORT void SetCallbacks(ZoneBeginCallback beginCallback, ZoneEndCallback endCallback, void* userData)
+{
+    if (beginCallback != nullptr && endCallback != nullptr)
+    {
+        /* Publish end callback and user data before the begin callback, which enables the zones */
+        g_profilerZoneCallbacks.endCallback = endCallback;
+        g_profilerZoneCallbacks.userData    = userData;
+        g_profilerZoneCallbacks.beginCallback.store(beginCallback, std::memory_order_release);
+    }
+    else
+        g_profilerZoneCallbacks.beginCallback.store(nullptr, std::memory_order_release);
+}
+
+#else
+
+LLGL_EXPORT void SetCallbacks(ZoneBeginCallback /*beginCallback*/, ZoneEndCallback /*endCallback*/, void* /*userData*/)
+{
+    // dummy
+}
+
+#endif // /LLGL_ENABLE_PROFILER_ZONES
+
+
+} // /namespace ProfilerZone
+
+
+#ifdef LLGL_ENABLE_PROFILER_ZONES
+
+LLGL_EXPORT bool BeginProfilerZone(const char* name)
+{
+    auto& callbacks = ProfilerZone::g_profilerZoneCallbacks;
+    if (auto beginCallback = callbacks.beginCallback.load(std::memory_order_acquire))
+    {
+        beginCallback(name, callbacks.userData);
+        return true;
+    }
+    return false;
+}
+
+LLGL_EXPORT void EndProfilerZone(const char* name)
+{
+    auto& callbacks = ProfilerZone::g_profilerZoneCallbacks;
+    callbacks.endCallback(name, callbacks.userData);
+}
+
+#endif // /LLGL_ENABLE_PROFILER_ZONES
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
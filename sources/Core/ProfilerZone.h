@@ -0,0 +1,74 @@
+/*
+ * ProfilerZone.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CORE_PROFILER_ZONE_H
+#define LLGL_CORE_PROFILER_ZONE_H
+
+
+#include <LLGL/ProfilerZone.h>
+
+
+#ifdef LLGL_ENABLE_PROFILER_ZONES
+
+namespace LLGL
+{
+
+
+// Invokes the zone begin callback and returns true if profiler zones are currently enabled.
+LLGL_EXPORT bool BeginProfilerZone(const char* name);
+
+// Invokes the zone end callback.
+LLGL_EXPORT void EndProfilerZone(const char* name);
+
+// Scoped profiler zone: begins the zone on construction and ends it on destruction.
+class ProfilerZoneScope
+{
+
+    public:
+
+        explicit ProfilerZoneScope(const char* name) :
+            name_   { name                    },
+            active_ { BeginProfilerZone(name) }
+        {
+        }
+
+        ~ProfilerZoneScope()
+        {
+            if (active_)
+                EndProfilerZone(name_);
+        }
+
+        ProfilerZoneScope(const ProfilerZoneScope&) = delete;
+        ProfilerZoneScope& operator = (const ProfilerZoneScope&) = delete;
+
+    private:
+
+        const char* name_   = nullptr;
+        bool        active_ = false;
+
+};
+
+
+} // /namespace LLGL
+
+// Declares a named profiler zone that spans until the end of the current scope.
+#define LLGL_PROFILER_ZONE(NAME) \
+    ::LLGL::ProfilerZoneScope profilerZoneScope_{ NAME }
+
+#else
+
+// Profiler zones are compiled out entirely.
+#define LLGL_PROFILER_ZONE(NAME)
+
+#endif // /LLGL_ENABLE_PROFILER_ZONES
+
+
+#endif
+
+
+
+// ================================================================================
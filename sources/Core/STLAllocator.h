@@ -0,0 +1,99 @@
+/*
+ * STLAllocator.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_STL_ALLOCATOR_H
+#define LLGL_STL_ALLOCATOR_H
+
+
+#include <LLGL/Allocator.h>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+
+namespace LLGL
+{
+
+
+/*
+Allocator class that is compatible with std::allocator and forwards all allocations to LLGL::Allocator.
+This is used for internal containers on hot paths, so their allocations can be tracked by the host application.
+*/
+template <typename T>
+class STLAllocator
+{
+
+    public:
+
+        using value_type        = T;
+        using pointer           = T*;
+        using const_pointer     = const T*;
+        using reference         = T&;
+        using const_reference   = const T&;
+        using size_type         = std::size_t;
+        using difference_type   = std::ptrdiff_t;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = STLAllocator<U>;
+        };
+
+    public:
+
+        STLAllocator() = default;
+
+        template <typename U>
+        STLAllocator(const STLAllocator<U>&)
+        {
+        }
+
+        pointer allocate(size_type n)
+        {
+            return static_cast<pointer>(Allocator::Allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(pointer p, size_type n)
+        {
+            Allocator::Free(p, n * sizeof(T), alignof(T));
+        }
+
+        template <typename U, typename... TArgs>
+        void construct(U* p, TArgs&&... args)
+        {
+            ::new (static_cast<void*>(p)) U(std::forward<TArgs>(args)...);
+        }
+
+        template <typename U>
+        void destroy(U* p)
+        {
+            p->~U();
+        }
+
+};
+
+template <typename T, typename U>
+bool operator == (const STLAllocator<T>&, const STLAllocator<U>&)
+{
+    return true;
+}
+
+template <typename T, typename U>
+bool operator != (const STLAllocator<T>&, const STLAllocator<U>&)
+{
+    return false;
+}
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
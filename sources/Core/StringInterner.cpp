@@ -0,0 +1,115 @@
+/*
+ * StringInterner.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "StringInterner.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+/*
+Interned strings are stored in a fixed-size hash table where each bucket is a singly linked list of nodes.
+New nodes are only ever prepended to a bucket with an atomic compare-and-swap operation and are never removed,
+so readers can traverse the lists without any lock and all returned pointers remain stable.
+*/
+struct InternedStringNode
+{
+    InternedStringNode* next;
+    std::size_t         hash;
+    std::size_t         length;
+    char*               str;
+};
+
+static constexpr std::size_t g_numInternedStringBuckets = 4096;
+
+static std::atomic<InternedStringNode*> g_internedStringBuckets[g_numInternedStringBuckets];
+
+// Computes the FNV-1a hash of the specified string.
+static std::size_t HashInternedString(const StringView& str)
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    for (char c : str)
+    {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= 1099511628211ull;
+    }
+    return static_cast<std::size_t>(hash);
+}
+
+// Searches the specified string in the range of nodes [first, last).
+static const InternedStringNode* FindInternedString(const InternedStringNode* first, const InternedStringNode* last, std::size_t hash, const StringView& str)
+{
+    for (auto node = first; node != last; node = node->next)
+    {
+        if (node->hash == hash && node->length == str.size() && std::memcmp(node->str, str.data(), str.size()) == 0)
+            return node;
+    }
+    return nullptr;
+}
+
+static InternedStringNode* NewInternedString(std::size_t hash, const StringView& str)
+{
+    auto node = new InternedStringNode;
+    {
+        node->next      = nullptr;
+        node->hash      = hash;
+        node->length    = str.size();
+        node->str       = new char[str.size() + 1];
+        ::memcpy(node->str, str.data(), str.size());
+        node->str[str.size()] = '\0';
+    }
+    return node;
+}
+
+static void DeleteInternedString(InternedStringNode* node)
+{
+    delete [] node->str;
+    delete node;
+}
+
+static StringView GetInternedStringView(const InternedStringNode* node)
+{
+    return StringView{ node->str, node->length };
+}
+
+LLGL_EXPORT StringView InternString(const StringView& str)
+{
+    const auto hash = HashInternedString(str);
+    auto& bucket = g_internedStringBuckets[hash % g_numInternedStringBuckets];
+
+    /* Search string in all nodes of the bucket */
+    auto head = bucket.load(std::memory_order_acquire);
+    if (auto node = FindInternedString(head, nullptr, hash, str))
+        return GetInternedStringView(node);
+
+    /* Try to prepend new node; if another thread has modified the bucket meanwhile, only the new nodes in front of the previous head must be searched */
+    auto newNode = NewInternedString(hash, str);
+    newNode->next = head;
+
+    while (!bucket.compare_exchange_weak(newNode->next, newNode, std::memory_order_release, std::memory_order_acquire))
+    {
+        if (auto node = FindInternedString(newNode->next, head, hash, str))
+        {
+            DeleteInternedString(newNode);
+            return GetInternedStringView(node);
+        }
+        head = newNode->next;
+    }
+
+    return GetInternedStringView(newNode);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
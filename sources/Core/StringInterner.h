@@ -0,0 +1,43 @@
+/*
+ * StringInterner.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_STRING_INTERNER_H
+#define LLGL_STRING_INTERNER_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/Container/StringView.h>
+
+
+namespace LLGL
+{
+
+
+/*
+Returns a view of the interned copy of the specified string.
+The interned string is null-terminated and remains valid until the process terminates,
+so the data pointer of the returned view can be passed to any function that expects a C-string.
+Interning the same string twice always returns the same data pointer, which allows to compare interned strings by pointer equality.
+This function is lock-free and can be called from multiple threads simultaneously.
+*/
+LLGL_EXPORT StringView InternString(const StringView& str);
+
+// Returns true if the two interned strings are equal. Both strings must have been returned by InternString.
+inline bool IsSameInternedString(const StringView& lhs, const StringView& rhs)
+{
+    return (lhs.data() == rhs.data());
+}
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
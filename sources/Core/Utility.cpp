@@ -390,6 +390,8 @@ static long ParseLayoutSignatureStageFlag(const char*& s)
         { StageFlags::GeometryStage,        "geom" },
         { StageFlags::FragmentStage,        "frag" },
         { StageFlags::ComputeStage,         "comp" },
+        { StageFlags::TaskStage,            "task" },
+        { StageFlags::MeshStage,            "mesh" },
     };
 
     /* Parse identifier (find end of alphabetic characters) */
@@ -0,0 +1,508 @@
+/*
+ * VertexFormat.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/Misc/VertexFormat.h>
+#include <LLGL/Platform/Platform.h>
+#include "Float16Compressor.h"
+#include <cmath>
+#include <cstring>
+
+#if defined LLGL_ARCH_AMD64
+#   include <emmintrin.h>
+#elif defined LLGL_ARCH_ARM64
+#   include <arm_neon.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal functions ----- */
+
+static bool IsFloat32Format(Format format)
+{
+    switch (format)
+    {
+        case Format::R32Float:
+        case Format::RG32Float:
+        case Format::RGB32Float:
+        case Format::RGBA32Float:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Returns the packed format for the specified packing, or Format::Undefined if the packing does not apply to the number of components.
+static Format GetPackedFormat(VertexPacking packing, std::uint32_t components)
+{
+    switch (packing)
+    {
+        case VertexPacking::NormalRGB10A2UNorm:
+            return (components >= 3 ? Format::RGB10A2UNorm : Format::Undefined);
+        case VertexPacking::NormalOctahedralRG16SNorm:
+            return (components == 3 ? Format::RG16SNorm : Format::Undefined);
+        case VertexPacking::HalfFloat:
+            switch (components)
+            {
+                case 1:     return Format::R16Float;
+                case 2:     return Format::RG16Float;
+                default:    return Format::RGBA16Float;
+            }
+        case VertexPacking::ColorRGBA8UNorm:
+            return (components >= 3 ? Format::RGBA8UNorm : Format::Undefined);
+        default:
+            return Format::Undefined;
+    }
+}
+
+static float ReadFloat(const char* src)
+{
+    float value;
+    std::memcpy(&value, src, sizeof(value));
+    return value;
+}
+
+static void WriteUInt32(char* dst, std::uint32_t value)
+{
+    std::memcpy(dst, &value, sizeof(value));
+}
+
+// Clamps the value to [0, 1]; NaN is mapped to 0 like the SIMD versions do.
+static float SaturateFloat(float value)
+{
+    value = (value > 0.0f ? value : 0.0f);
+    return (value < 1.0f ? value : 1.0f);
+}
+
+// Rounds to the nearest integer with ties to even, which is the default rounding mode of the SIMD conversions.
+static std::uint32_t QuantizeUNorm(float value, float maxValue)
+{
+    return static_cast<std::uint32_t>(std::nearbyint(SaturateFloat(value) * maxValue));
+}
+
+static std::uint32_t QuantizeSNorm16(float value)
+{
+    value = (value > -1.0f ? value : -1.0f);
+    value = (value <  1.0f ? value :  1.0f);
+    return (static_cast<std::uint32_t>(static_cast<std::int32_t>(std::nearbyint(value * 32767.0f))) & 0xFFFFu);
+}
+
+static float SignNotZero(float value)
+{
+    return (value >= 0.0f ? 1.0f : -1.0f);
+}
+
+static std::uint32_t PackNormalRGB10A2UNorm(float x, float y, float z, float w)
+{
+    return
+    (
+        (QuantizeUNorm(x * 0.5f + 0.5f, 1023.0f)      ) |
+        (QuantizeUNorm(y * 0.5f + 0.5f, 1023.0f) << 10) |
+        (QuantizeUNorm(z * 0.5f + 0.5f, 1023.0f) << 20) |
+        (QuantizeUNorm(w * 0.5f + 0.5f,    3.0f) << 30)
+    );
+}
+
+static std::uint32_t PackNormalOctahedral(float x, float y, float z)
+{
+    /* Project onto octahedron and fold the lower hemisphere over the diagonals */
+    const float l1 = std::abs(x) + std::abs(y) + std::abs(z);
+    const float invL1 = (l1 > 0.0f ? 1.0f / l1 : 0.0f);
+
+    float px = x * invL1;
+    float py = y * invL1;
+
+    if (z < 0.0f)
+    {
+        const float fx = (1.0f - std::abs(py)) * SignNotZero(px);
+        const float fy = (1.0f - std::abs(px)) * SignNotZero(py);
+        px = fx;
+        py = fy;
+    }
+
+    return (QuantizeSNorm16(px) | (QuantizeSNorm16(py) << 16));
+}
+
+static std::uint32_t PackColorRGBA8UNorm(float r, float g, float b, float a)
+{
+    return
+    (
+        (QuantizeUNorm(r, 255.0f)      ) |
+        (QuantizeUNorm(g, 255.0f) <<  8) |
+        (QuantizeUNorm(b, 255.0f) << 16) |
+        (QuantizeUNorm(a, 255.0f) << 24)
+    );
+}
+
+#if defined LLGL_ARCH_AMD64
+
+// Loads the specified component of four consecutive strided vertices.
+static __m128 Load4Strided(const char* src, std::size_t stride, std::size_t component)
+{
+    const char* p = src + component * sizeof(float);
+    return _mm_set_ps(ReadFloat(p + stride*3), ReadFloat(p + stride*2), ReadFloat(p + stride), ReadFloat(p));
+}
+
+static void Store4Strided(char* dst, std::size_t stride, __m128i value)
+{
+    alignas(16) std::uint32_t values[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(values), value);
+    for (int i = 0; i < 4; ++i)
+        WriteUInt32(dst + stride*i, values[i]);
+}
+
+// Returns round(saturate(value) * maxValue) for each lane.
+static __m128i QuantizeUNorm4(__m128 value, float maxValue)
+{
+    value = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    return _mm_cvtps_epi32(_mm_mul_ps(value, _mm_set1_ps(maxValue)));
+}
+
+// Returns round(clamp(value, -1, 1) * 32767) in the lower 16 bits of each lane.
+static __m128i QuantizeSNorm16x4(__m128 value)
+{
+    value = _mm_min_ps(_mm_max_ps(value, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f));
+    return _mm_and_si128(_mm_cvtps_epi32(_mm_mul_ps(value, _mm_set1_ps(32767.0f))), _mm_set1_epi32(0xFFFF));
+}
+
+static __m128 Abs4(__m128 value)
+{
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), value);
+}
+
+static __m128 SignNotZero4(__m128 value)
+{
+    const __m128 negative = _mm_cmplt_ps(value, _mm_setzero_ps());
+    return _mm_or_ps(_mm_and_ps(negative, _mm_set1_ps(-1.0f)), _mm_andnot_ps(negative, _mm_set1_ps(1.0f)));
+}
+
+#elif defined LLGL_ARCH_ARM64
+
+static float32x4_t Load4Strided(const char* src, std::size_t stride, std::size_t component)
+{
+    const char* p = src + component * sizeof(float);
+    const float values[4] = { ReadFloat(p), ReadFloat(p + stride), ReadFloat(p + stride*2), ReadFloat(p + stride*3) };
+    return vld1q_f32(values);
+}
+
+static void Store4Strided(char* dst, std::size_t stride, uint32x4_t value)
+{
+    std::uint32_t values[4];
+    vst1q_u32(values, value);
+    for (int i = 0; i < 4; ++i)
+        WriteUInt32(dst + stride*i, values[i]);
+}
+
+// Returns round(saturate(value) * maxValue) for each lane. vmaxnmq_f32 maps NaN to 0 like the scalar version does.
+static uint32x4_t QuantizeUNorm4(float32x4_t value, float maxValue)
+{
+    value = vminq_f32(vmaxnmq_f32(value, vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f));
+    return vreinterpretq_u32_s32(vcvtnq_s32_f32(vmulq_n_f32(value, maxValue)));
+}
+
+static uint32x4_t QuantizeSNorm16x4(float32x4_t value)
+{
+    value = vminq_f32(vmaxnmq_f32(value, vdupq_n_f32(-1.0f)), vdupq_n_f32(1.0f));
+    return vandq_u32(vreinterpretq_u32_s32(vcvtnq_s32_f32(vmulq_n_f32(value, 32767.0f))), vdupq_n_u32(0xFFFF));
+}
+
+static float32x4_t SignNotZero4(float32x4_t value)
+{
+    return vbslq_f32(vcltq_f32(value, vdupq_n_f32(0.0f)), vdupq_n_f32(-1.0f), vdupq_n_f32(1.0f));
+}
+
+#endif // /LLGL_ARCH_AMD64
+
+static void PackNormalsRGB10A2UNorm(const char* src, std::size_t srcStride, std::size_t components, char* dst, std::size_t dstStride, std::size_t count)
+{
+    std::size_t i = 0;
+
+    #if defined LLGL_ARCH_AMD64
+
+    for (; i + 4 <= count; i += 4, src += srcStride*4, dst += dstStride*4)
+    {
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 w = (components > 3 ? Load4Strided(src, srcStride, 3) : _mm_set1_ps(1.0f));
+        __m128i v = QuantizeUNorm4(_mm_add_ps(_mm_mul_ps(Load4Strided(src, srcStride, 0), half), half), 1023.0f);
+        v = _mm_or_si128(v, _mm_slli_epi32(QuantizeUNorm4(_mm_add_ps(_mm_mul_ps(Load4Strided(src, srcStride, 1), half), half), 1023.0f), 10));
+        v = _mm_or_si128(v, _mm_slli_epi32(QuantizeUNorm4(_mm_add_ps(_mm_mul_ps(Load4Strided(src, srcStride, 2), half), half), 1023.0f), 20));
+        v = _mm_or_si128(v, _mm_slli_epi32(QuantizeUNorm4(_mm_add_ps(_mm_mul_ps(w, half), half), 3.0f), 30));
+        Store4Strided(dst, dstStride, v);
+    }
+
+    #elif defined LLGL_ARCH_ARM64
+
+    for (; i + 4 <= count; i += 4, src += srcStride*4, dst += dstStride*4)
+    {
+        const float32x4_t half = vdupq_n_f32(0.5f);
+        const float32x4_t w = (components > 3 ? Load4Strided(src, srcStride, 3) : vdupq_n_f32(1.0f));
+        uint32x4_t v = QuantizeUNorm4(vmlaq_f32(half, Load4Strided(src, srcStride, 0), half), 1023.0f);
+        v = vorrq_u32(v, vshlq_n_u32(QuantizeUNorm4(vmlaq_f32(half, Load4Strided(src, srcStride, 1), half), 1023.0f), 10));
+        v = vorrq_u32(v, vshlq_n_u32(QuantizeUNorm4(vmlaq_f32(half, Load4Strided(src, srcStride, 2), half), 1023.0f), 20));
+        v = vorrq_u32(v, vshlq_n_u32(QuantizeUNorm4(vmlaq_f32(half, w, half), 3.0f), 30));
+        Store4Strided(dst, dstStride, v);
+    }
+
+    #endif // /LLGL_ARCH_AMD64
+
+    for (; i < count; ++i, src += srcStride, dst += dstStride)
+    {
+        const float w = (components > 3 ? ReadFloat(src + sizeof(float)*3) : 1.0f);
+        WriteUInt32(dst, PackNormalRGB10A2UNorm(ReadFloat(src), ReadFloat(src + sizeof(float)), ReadFloat(src + sizeof(float)*2), w));
+    }
+}
+
+static void PackNormalsOctahedral(const char* src, std::size_t srcStride, char* dst, std::size_t dstStride, std::size_t count)
+{
+    std::size_t i = 0;
+
+    #if defined LLGL_ARCH_AMD64
+
+    for (; i + 4 <= count; i += 4, src += srcStride*4, dst += dstStride*4)
+    {
+        const __m128 x = Load4Strided(src, srcStride, 0);
+        const __m128 y = Load4Strided(src, srcStride, 1);
+        const __m128 z = Load4Strided(src, srcStride, 2);
+
+        /* Project onto octahedron; vectors of zero length are mapped to (0, 0) */
+        const __m128 l1     = _mm_add_ps(_mm_add_ps(Abs4(x), Abs4(y)), Abs4(z));
+        const __m128 invL1  = _mm_and_ps(_mm_div_ps(_mm_set1_ps(1.0f), l1), _mm_cmpgt_ps(l1, _mm_setzero_ps()));
+        const __m128 px     = _mm_mul_ps(x, invL1);
+        const __m128 py     = _mm_mul_ps(y, invL1);
+
+        /* Fold lower hemisphere */
+        const __m128 fx     = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(1.0f), Abs4(py)), SignNotZero4(px));
+        const __m128 fy     = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(1.0f), Abs4(px)), SignNotZero4(py));
+        const __m128 lower  = _mm_cmplt_ps(z, _mm_setzero_ps());
+        const __m128 ox     = _mm_or_ps(_mm_and_ps(lower, fx), _mm_andnot_ps(lower, px));
+        const __m128 oy     = _mm_or_ps(_mm_and_ps(lower, fy), _mm_andnot_ps(lower, py));
+
+        Store4Strided(dst, dstStride, _mm_or_si128(QuantizeSNorm16x4(ox), _mm_slli_epi32(QuantizeSNorm16x4(oy), 16)));
+    }
+
+    #elif defined LLGL_ARCH_ARM64
+
+    for (; i + 4 <= count; i += 4, src += srcStride*4, dst += dstStride*4)
+    {
+        const float32x4_t x = Load4Strided(src, srcStride, 0);
+        const float32x4_t y = Load4Strided(src, srcStride, 1);
+        const float32x4_t z = Load4Strided(src, srcStride, 2);
+
+        /* Project onto octahedron; vectors of zero length are mapped to (0, 0) */
+        const float32x4_t l1    = vaddq_f32(vaddq_f32(vabsq_f32(x), vabsq_f32(y)), vabsq_f32(z));
+        const float32x4_t invL1 = vbslq_f32(vcgtq_f32(l1, vdupq_n_f32(0.0f)), vdivq_f32(vdupq_n_f32(1.0f), l1), vdupq_n_f32(0.0f));
+        const float32x4_t px    = vmulq_f32(x, invL1);
+        const float32x4_t py    = vmulq_f32(y, invL1);
+
+        /* Fold lower hemisphere */
+        const float32x4_t fx    = vmulq_f32(vsubq_f32(vdupq_n_f32(1.0f), vabsq_f32(py)), SignNotZero4(px));
+        const float32x4_t fy    = vmulq_f32(vsubq_f32(vdupq_n_f32(1.0f), vabsq_f32(px)), SignNotZero4(py));
+        const uint32x4_t  lower = vcltq_f32(z, vdupq_n_f32(0.0f));
+        const float32x4_t ox    = vbslq_f32(lower, fx, px);
+        const float32x4_t oy    = vbslq_f32(lower, fy, py);
+
+        Store4Strided(dst, dstStride, vorrq_u32(QuantizeSNorm16x4(ox), vshlq_n_u32(QuantizeSNorm16x4(oy), 16)));
+    }
+
+    #endif // /LLGL_ARCH_AMD64
+
+    for (; i < count; ++i, src += srcStride, dst += dstStride)
+        WriteUInt32(dst, PackNormalOctahedral(ReadFloat(src), ReadFloat(src + sizeof(float)), ReadFloat(src + sizeof(float)*2)));
+}
+
+static void PackColorsRGBA8UNorm(const char* src, std::size_t srcStride, std::size_t components, char* dst, std::size_t dstStride, std::size_t count)
+{
+    std::size_t i = 0;
+
+    #if defined LLGL_ARCH_AMD64
+
+    for (; i + 4 <= count; i += 4, src += srcStride*4, dst += dstStride*4)
+    {
+        const __m128 a = (components > 3 ? Load4Strided(src, srcStride, 3) : _mm_set1_ps(1.0f));
+        __m128i v = QuantizeUNorm4(Load4Strided(src, srcStride, 0), 255.0f);
+        v = _mm_or_si128(v, _mm_slli_epi32(QuantizeUNorm4(Load4Strided(src, srcStride, 1), 255.0f),  8));
+        v = _mm_or_si128(v, _mm_slli_epi32(QuantizeUNorm4(Load4Strided(src, srcStride, 2), 255.0f), 16));
+        v = _mm_or_si128(v, _mm_slli_epi32(QuantizeUNorm4(a, 255.0f), 24));
+        Store4Strided(dst, dstStride, v);
+    }
+
+    #elif defined LLGL_ARCH_ARM64
+
+    for (; i + 4 <= count; i += 4, src += srcStride*4, dst += dstStride*4)
+    {
+        const float32x4_t a = (components > 3 ? Load4Strided(src, srcStride, 3) : vdupq_n_f32(1.0f));
+        uint32x4_t v = QuantizeUNorm4(Load4Strided(src, srcStride, 0), 255.0f);
+        v = vorrq_u32(v, vshlq_n_u32(QuantizeUNorm4(Load4Strided(src, srcStride, 1), 255.0f),  8));
+        v = vorrq_u32(v, vshlq_n_u32(QuantizeUNorm4(Load4Strided(src, srcStride, 2), 255.0f), 16));
+        v = vorrq_u32(v, vshlq_n_u32(QuantizeUNorm4(a, 255.0f), 24));
+        Store4Strided(dst, dstStride, v);
+    }
+
+    #endif // /LLGL_ARCH_AMD64
+
+    for (; i < count; ++i, src += srcStride, dst += dstStride)
+    {
+        const float a = (components > 3 ? ReadFloat(src + sizeof(float)*3) : 1.0f);
+        WriteUInt32(dst, PackColorRGBA8UNorm(ReadFloat(src), ReadFloat(src + sizeof(float)), ReadFloat(src + sizeof(float)*2), a));
+    }
+}
+
+// Gathers the strided components into a contiguous batch, so the SIMD version of CompressFloat16Array can be used.
+static void PackHalfFloats(const char* src, std::size_t srcStride, std::size_t srcComponents, char* dst, std::size_t dstStride, std::size_t dstComponents, std::size_t count)
+{
+    constexpr std::size_t batchSize = 256;
+
+    float           srcBatch[batchSize * 4];
+    std::uint16_t   dstBatch[batchSize * 4];
+
+    while (count > 0)
+    {
+        const std::size_t n = (count < batchSize ? count : batchSize);
+
+        for (std::size_t i = 0; i < n; ++i, src += srcStride)
+        {
+            std::memcpy(&srcBatch[i * dstComponents], src, srcComponents * sizeof(float));
+            for (std::size_t c = srcComponents; c < dstComponents; ++c)
+                srcBatch[i * dstComponents + c] = 1.0f;
+        }
+
+        CompressFloat16Array(srcBatch, dstBatch, n * dstComponents);
+
+        for (std::size_t i = 0; i < n; ++i, dst += dstStride)
+            std::memcpy(dst, &dstBatch[i * dstComponents], dstComponents * sizeof(std::uint16_t));
+
+        count -= n;
+    }
+}
+
+static void CopyAttribute(const char* src, std::size_t srcStride, char* dst, std::size_t dstStride, std::size_t size, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i, src += srcStride, dst += dstStride)
+        std::memcpy(dst, src, size);
+}
+
+
+/* ----- Global functions ----- */
+
+LLGL_EXPORT VertexFormat PackVertexFormat(const VertexFormat& srcFormat, const ArrayView<VertexPacking>& packings)
+{
+    VertexFormat dstFormat;
+    dstFormat.attributes = srcFormat.attributes;
+
+    /* Replace formats of all packable attributes */
+    for (std::size_t i = 0; i < dstFormat.attributes.size() && i < packings.size(); ++i)
+    {
+        auto& attrib = dstFormat.attributes[i];
+        if (IsFloat32Format(attrib.format))
+        {
+            const Format packedFormat = GetPackedFormat(packings[i], GetFormatAttribs(attrib.format).components);
+            if (packedFormat != Format::Undefined)
+                attrib.format = packedFormat;
+        }
+    }
+
+    /* Recompute offsets and strides for each buffer binding slot, preserving the order of attributes */
+    std::vector<std::uint32_t> slotStrides;
+    for (auto& attrib : dstFormat.attributes)
+    {
+        if (attrib.slot >= slotStrides.size())
+            slotStrides.resize(attrib.slot + 1, 0);
+        attrib.offset = slotStrides[attrib.slot];
+        slotStrides[attrib.slot] += attrib.GetSize();
+    }
+
+    for (std::size_t slot = 0; slot < slotStrides.size(); ++slot)
+        dstFormat.SetStride(slotStrides[slot], static_cast<std::uint32_t>(slot));
+
+    return dstFormat;
+}
+
+LLGL_EXPORT bool PackVertices(
+    const VertexFormat& srcFormat,
+    const void*         srcVertices,
+    const VertexFormat& dstFormat,
+    void*               dstVertices,
+    std::size_t         numVertices,
+    std::uint32_t       slot)
+{
+    if (srcFormat.attributes.size() != dstFormat.attributes.size())
+        return false;
+
+    const std::size_t srcStride = srcFormat.GetStride(slot);
+    const std::size_t dstStride = dstFormat.GetStride(slot);
+
+    for (std::size_t i = 0; i < srcFormat.attributes.size(); ++i)
+    {
+        const auto& srcAttrib = srcFormat.attributes[i];
+        const auto& dstAttrib = dstFormat.attributes[i];
+
+        if (srcAttrib.slot != dstAttrib.slot)
+            return false;
+        if (srcAttrib.slot != slot)
+            continue;
+
+        const char* src = static_cast<const char*>(srcVertices) + srcAttrib.offset;
+        char*       dst = static_cast<char*>(dstVertices) + dstAttrib.offset;
+
+        if (srcAttrib.format == dstAttrib.format)
+        {
+            CopyAttribute(src, srcStride, dst, dstStride, srcAttrib.GetSize(), numVertices);
+            continue;
+        }
+
+        if (!IsFloat32Format(srcAttrib.format))
+            return false;
+
+        const std::size_t srcComponents = GetFormatAttribs(srcAttrib.format).components;
+
+        switch (dstAttrib.format)
+        {
+            case Format::RGB10A2UNorm:
+                if (srcComponents < 3)
+                    return false;
+                PackNormalsRGB10A2UNorm(src, srcStride, srcComponents, dst, dstStride, numVertices);
+                break;
+
+            case Format::RG16SNorm:
+                if (srcComponents != 3)
+                    return false;
+                PackNormalsOctahedral(src, srcStride, dst, dstStride, numVertices);
+                break;
+
+            case Format::R16Float:
+            case Format::RG16Float:
+            case Format::RGBA16Float:
+            {
+                const std::size_t dstComponents = GetFormatAttribs(dstAttrib.format).components;
+                if (srcComponents > dstComponents)
+                    return false;
+                PackHalfFloats(src, srcStride, srcComponents, dst, dstStride, dstComponents, numVertices);
+            }
+            break;
+
+            case Format::RGBA8UNorm:
+                if (srcComponents < 3)
+                    return false;
+                PackColorsRGBA8UNorm(src, srcStride, srcComponents, dst, dstStride, numVertices);
+                break;
+
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -7,7 +7,8 @@
 
 #include "AMD64Assembler.h"
 #include "AMD64Opcode.h"
-#include <limits.h>
+#include <stdexcept>
+#include <string.h>
 
 #include <fstream>//!!!
 #include <iomanip>
@@ -33,39 +34,77 @@ see https://en.wikipedia.org/wiki/X86_calling_conventions#List_of_x86_calling_co
 
 /*
 Microsoft x64 calling convention (Windows)
-Preserved for caller: ???
+Preserved for caller: RBX, RBP, RDI, RSI, RSP, R12-R15, XMM6-XMM15
+The argument position selects the register for both integral and floating-point arguments,
+and the caller must reserve 32 bytes of shadow space for the register arguments.
 */
-static const Reg g_amd64IntParams[] = { Reg::RCX, Reg::RDX, Reg::R8, Reg::R9 };
-static const Reg g_amd64FltParams[] = { Reg::XMM0, Reg::XMM1, Reg::XMM2, Reg::XMM3 };
-static const Reg g_amd64TempReg     = Reg::RAX;
+static const Reg            g_amd64IntParams[]  = { Reg::RCX, Reg::RDX, Reg::R8, Reg::R9 };
+static const Reg            g_amd64FltParams[]  = { Reg::XMM0, Reg::XMM1, Reg::XMM2, Reg::XMM3 };
+static const Reg            g_amd64TempReg      = Reg::RAX;
+static const std::uint32_t  g_amd64ShadowSpace  = 32;
 
 #else
 
 /*
 System V AMD64 ABI (Solaris, Linux, BSD, macOS)
 Preserved for caller: RBP, RBX, R12-R15
+Integral and floating-point arguments are assigned to their registers independently of each other.
 */
-static const Reg g_amd64IntParams[] = { Reg::RDI, Reg::RSI, Reg::RDX, Reg::RCX, Reg::R8, Reg::R9 };
-static const Reg g_amd64FltParams[] = { Reg::XMM0, Reg::XMM1, Reg::XMM2, Reg::XMM3, Reg::XMM4, Reg::XMM5, Reg::XMM6, Reg::XMM7 };
-static const Reg g_amd64TempReg     = Reg::RAX;
+static const Reg            g_amd64IntParams[]  = { Reg::RDI, Reg::RSI, Reg::RDX, Reg::RCX, Reg::R8, Reg::R9 };
+static const Reg            g_amd64FltParams[]  = { Reg::XMM0, Reg::XMM1, Reg::XMM2, Reg::XMM3, Reg::XMM4, Reg::XMM5, Reg::XMM6, Reg::XMM7 };
+static const Reg            g_amd64TempReg      = Reg::RAX;
+static const std::uint32_t  g_amd64ShadowSpace  = 0;
 
 #endif
 
 static const std::size_t g_amd64IntParamsCount = sizeof(g_amd64IntParams)/sizeof(g_amd64IntParams[0]);
 static const std::size_t g_amd64FltParamsCount = sizeof(g_amd64FltParams)/sizeof(g_amd64FltParams[0]);
 
+// Size of the outgoing argument area at the bottom of the stack frame (including the shadow space). This is enough for 16 arguments.
+static const std::uint32_t g_amd64ArgStackSize = 128;
+
+// Stack alignment at the time of a function call.
+static const std::uint32_t g_amd64StackAlignment = 16;
+
 
 /*
  * Internal functions
  */
 
-// Size of byte (1), word (2), dword (4), qword (8), ptr (8), stack-ptr (8), float (4), double (8)
+// Size of byte (1), word (2), dword (4), qword (8), ptr (8), stack-ptr (8), var-arg-ptr (8), float (4), double (8)
 static std::uint8_t GetArgSize(const ArgType t)
 {
-    static const std::uint8_t sizes[] = { 1, 2, 4, 8, 8, 8, 4, 8 };
+    static const std::uint8_t sizes[] = { 1, 2, 4, 8, 8, 8, 8, 4, 8 };
     return sizes[static_cast<std::uint8_t>(t)];
 }
 
+// Helper structure to assign function arguments to their parameter registers.
+struct AMD64ParamAllocator
+{
+    // Returns the register for the next argument, or RSP if the argument must be passed on the stack.
+    Reg Next(bool isFloat)
+    {
+        #ifdef _WIN32
+        const std::size_t idx = numArgs++;
+        if (idx < g_amd64IntParamsCount)
+            return (isFloat ? g_amd64FltParams[idx] : g_amd64IntParams[idx]);
+        #else
+        if (isFloat)
+        {
+            if (numFltRegs < g_amd64FltParamsCount)
+                return g_amd64FltParams[numFltRegs++];
+        }
+        else if (numIntRegs < g_amd64IntParamsCount)
+            return g_amd64IntParams[numIntRegs++];
+        #endif
+        return Reg::RSP;
+    }
+
+    std::size_t numArgs     = 0;
+    std::size_t numIntRegs  = 0;
+    std::size_t numFltRegs  = 0;
+};
+
 
 /*
  * AMD64Assembler class
@@ -82,8 +121,10 @@ void AMD64Assembler::Begin()
     #endif
 
     /* Reset data about local stack */
-    localStackSize_ = 128;//0;
-    paramStackSize_ = 0;
+    localStackSize_ = 0;
+    supplements_.clear();
+    varArgDisp_.clear();
+    stackChunkOffsets_.clear();
 
     /* Write entry point prologue */
     WritePrologue();
@@ -110,132 +151,33 @@ void AMD64Assembler::End()
     #endif // /TEST
 }
 
-void AMD64Assembler::WriteFuncCall(const void* addr, JITCallConv conv, bool farCall)
+/*
+AMD64 has a single calling convention per platform ABI (System V or Win64) and 'this' pointers are passed as first argument,
+so the calling convention is ignored. The absolute 64-bit address is always called through a register, so no far call is required either.
+*/
+void AMD64Assembler::WriteFuncCall(const void* addr, JITCallConv /*conv*/, bool /*farCall*/)
 {
-    const auto& args = GetArgs();
-
-    /* Move first couple of arguments into registers */
-    std::size_t numIntRegs = 0, numFltRegs = 0;
-    std::size_t lastInt, lastFlt;
-    std::size_t num = args.size();
+    AMD64ParamAllocator paramAlloc;
 
-    lastInt = lastFlt = std::numeric_limits<std::size_t>::max();
+    /* Stack arguments are stored in order at the bottom of the stack frame, right after the shadow space */
+    std::uint32_t argStackOffset = g_amd64ShadowSpace;
 
-    for (std::size_t i = 0; i < num; ++i)
+    for (const auto& arg : GetArgs())
     {
-        const auto& arg = args[i];
-
-        /* Determine destination register for argument */
-        Reg dstReg = g_amd64TempReg;
-        bool isFloat = IsFloat(arg.type);
-
-        if (isFloat && numFltRegs < g_amd64FltParamsCount)
-        {
-            dstReg  = g_amd64FltParams[numFltRegs++];
-            lastFlt = i;
-        }
-        else if (!isFloat && numIntRegs < g_amd64IntParamsCount)
-        {
-            dstReg  = g_amd64IntParams[numIntRegs++];
-            lastInt = i;
-        }
-        else
-            break;
-
-        if (arg.param < 0xF)
-        {
-            if (arg.param < varArgDisp_.size())
-            {
-                /* Move parameter from local stack into destination register */
-                if (IsFltReg(dstReg))
-                    MovDQURegMem(dstReg, Reg::RBP, varArgDisp_[arg.param]);
-                else
-                    MovRegMem(dstReg, Reg::RBP, varArgDisp_[arg.param]);
-            }
-        }
-        else if (dstReg >= Reg::R8 && dstReg <= Reg::R15)
-        {
-            /* R8-R15 registers are only supported for 64-bit operand size */
-            MovRegImm64(dstReg, arg.value.i64);
-        }
+        /* Move argument into its parameter register or onto the stack */
+        const Reg dstReg = paramAlloc.Next(IsFloat(arg.type));
+        if (dstReg != Reg::RSP)
+            WriteArgToReg(dstReg, arg);
         else
         {
-            /* Move value into destination register */
-            switch (arg.type)
-            {
-                case ArgType::Byte:
-                    MovRegImm32(dstReg, arg.value.i8);
-                    break;
-                case ArgType::Word:
-                    MovRegImm32(dstReg, arg.value.i16);
-                    break;
-                case ArgType::DWord:
-                    MovRegImm32(dstReg, arg.value.i32);
-                    break;
-                case ArgType::QWord:
-                    MovRegImm64(dstReg, arg.value.i64);
-                    break;
-                case ArgType::Ptr:
-                    MovRegImm64(dstReg, arg.value.i64);
-                    break;
-                case ArgType::StackPtr:
-                    MovReg(dstReg, Reg::RBP);
-                    SubImm32(dstReg, stackChunkOffsets_[arg.value.i8]);
-                    break;
-                case ArgType::Float:
-                    MovSSRegImm32(dstReg, arg.value.f32);
-                    break;
-                case ArgType::Double:
-                    MovSDRegImm64(dstReg, arg.value.f64);
-                    break;
-            }
+            if (argStackOffset + 8 > g_amd64ArgStackSize)
+                throw std::runtime_error("too many arguments for JIT function call on AMD64");
+            WriteArgToStack(Displacement{ static_cast<std::int32_t>(argStackOffset) }, arg);
+            argStackOffset += 8;
         }
     }
 
-    /* Push remaining arguments onto stack */
-    Displacement stackDisp;
-
-    for (std::size_t i = 0; i < num; ++i)
-    {
-        auto iRev = num - i - 1u;
-        const auto& arg = args[iRev];
-
-        /* Check if argument has already been moved into a register */
-        bool isFloat = IsFloat(arg.type);
-
-        if ( (  isFloat && iRev == lastFlt ) ||
-             ( !isFloat && iRev == lastInt ) )
-        {
-            break;
-        }
-
-        /* Push argument onto stack */
-        switch (arg.type)
-        {
-            case ArgType::Byte:
-            case ArgType::Word:
-            case ArgType::DWord:
-            case ArgType::Float:
-                MovMemImm32(Reg::RSP, arg.value.i32, stackDisp);
-                stackDisp.disp8 += 8;
-                break;
-            case ArgType::QWord:
-            case ArgType::Ptr:
-            case ArgType::Double:
-                MovRegImm64(g_amd64TempReg, arg.value.i64);
-                MovMemReg(Reg::RSP, g_amd64TempReg, stackDisp);
-                stackDisp.disp8 += 8;
-                break;
-            case ArgType::StackPtr:
-                MovReg(g_amd64TempReg, Reg::RBP);
-                SubImm32(g_amd64TempReg, stackChunkOffsets_[arg.value.i8]);
-                MovMemReg(Reg::RSP, g_amd64TempReg, stackDisp);
-                stackDisp.disp8 += 8;
-                break;
-        }
-    }
-
-    /* Write 'call' instruction */
+    /* Write 'call' instruction; the temporary register is not used for any arguments */
     MovRegImm64(g_amd64TempReg, reinterpret_cast<std::uint64_t>(addr));
     CallNear(g_amd64TempReg);
 }
@@ -262,44 +204,36 @@ std::uint8_t AMD64Assembler::DispMod(const Displacement& disp) const
     return 0;
 }
 
-std::uint8_t AMD64Assembler::ModRM(std::uint8_t mode, Reg r0, Reg r1) const
-{
-    std::uint8_t modRM = (mode | (RegByte(r0) << 3));
-
-    if (r1 == Reg::RSP)
-        modRM |= Operand_SIB;
-    else
-        modRM |= RegByte(r1);
-
-    return modRM;
-}
-
 void AMD64Assembler::WritePrologue()
 {
     /* Store base stack pointer (RBP) */
     PushReg(Reg::RBP);
     MovReg(Reg::RBP, Reg::RSP);
 
-    #if 1
-    /* Store general purpose registers */
-    //TODO: determine which registers must be stored
+    /* Store general purpose registers; RBX is preserved for the caller in both calling conventions */
     PushReg(Reg::RBX);
-    #endif
 }
 
 void AMD64Assembler::WriteEpilogue()
 {
-    #if 1
     /* Restore general purpose registers */
-    //TODO: determine which registers must be restored
     PopReg(Reg::RBX);
-    #endif
 
-    /* Restore base stack pointer (RBP) */
+    /* Restore base stack pointer (RBP); the caller cleans up its stack arguments on x64 */
     PopReg(Reg::RBP);
-    RetNear(paramStackSize_);
+    RetNear();
 }
 
+/*
+Stack frame layout:
+[RBP + 16 + shadow space]   Entry point parameters that are passed on the stack
+[RBP + 8]                   Return address
+[RBP]                       Preserved RBP
+[RBP - 8]                   Preserved RBX
+[RBP - 8 - varArgSize]      Entry point parameters (8 bytes for integral, 16 bytes for floating-point parameters)
+[...]                       Stack allocations
+[RSP]                       Outgoing argument area for subsequent function calls (including the shadow space)
+*/
 void AMD64Assembler::WriteStackFrame(
     const std::vector<JIT::ArgType>&    varArgTypes,
     const std::vector<std::uint32_t>&   stackChunks)
@@ -312,107 +246,184 @@ void AMD64Assembler::WriteStackFrame(
     /* Determine required stack size for allocations */
     std::uint32_t stackChunksSize = 0;
     for (auto chunk : stackChunks)
-        stackChunksSize += chunk;
-
-    /* Allocate local stack */
-    localStackSize_ += varArgSize;
+        stackChunksSize += GetAlignedSize(chunk, g_amd64StackAlignment);
 
-    std::uint32_t chunkStackOffset = localStackSize_ + 8;
+    /*
+    Allocate local stack and keep RSP 16-byte aligned for subsequent calls:
+    RSP is 8 bytes off the alignment at entry (return address), and RBP and RBX are pushed in the prologue.
+    */
+    localStackSize_ = varArgSize + stackChunksSize + g_amd64ArgStackSize;
+    localStackSize_ = GetAlignedSize(localStackSize_ + 8, g_amd64StackAlignment) - 8;
 
-    localStackSize_ += stackChunksSize;
-
-    if (localStackSize_ > 0)
-        SubImm32(Reg::RSP, localStackSize_);
+    SubImm32(Reg::RSP, localStackSize_);
 
     /* Store parameters in local stack */
-    std::size_t numIntRegs = 0, numFltRegs = 0;
-    std::int8_t paramStackOffset = 16; // first parameter at [EBP+16]
-    std::int8_t localStackOffset = -16; // local variables after preserved EBX
+    AMD64ParamAllocator paramAlloc;
+    std::int32_t paramStackOffset = 16 + static_cast<std::int32_t>(g_amd64ShadowSpace); // first stack parameter after return address and shadow space
+    std::int32_t localStackOffset = -8; // local variables after preserved RBX
+
+    varArgDisp_.reserve(varArgTypes.size());
 
     for (auto type : varArgTypes)
     {
-        bool isFloat = IsFloat(type);
-        Reg srcReg = g_amd64TempReg;
+        const bool isFloat = IsFloat(type);
+        Reg srcReg = paramAlloc.Next(isFloat);
 
-        if (isFloat && numFltRegs < g_amd64FltParamsCount)
-        {
-            /* Get parameter from floating-point register */
-            srcReg = g_amd64FltParams[numFltRegs++];
-        }
-        else if (!isFloat && numIntRegs < g_amd64IntParamsCount)
-        {
-            /* Get parameter from integer register */
-            srcReg = g_amd64IntParams[numIntRegs++];
-        }
-        else
+        if (srcReg == Reg::RSP)
         {
             /* Load parameter from stack */
-            MovRegMem(srcReg, Reg::RBP, Disp8{ paramStackOffset });
+            srcReg = g_amd64TempReg;
+            MovRegMem(srcReg, Reg::RBP, Displacement{ paramStackOffset });
             paramStackOffset += 8;
-            paramStackSize_ += 8;
         }
 
-        /* Store parameter in local stack */
+        /* Store parameter in local stack; floating-point parameters reserve 16 bytes in either case */
+        localStackOffset -= (isFloat ? 16 : 8);
+
         if (IsFltReg(srcReg))
-        {
-            localStackOffset -= 16; // SSE2 register size of 128 bits
-            MovDQUMemReg(Reg::RBP, srcReg, Disp8{ localStackOffset });
-        }
+            MovDQUMemReg(Reg::RBP, srcReg, Displacement{ localStackOffset }); // SSE2 register size of 128 bits
         else
-        {
-            localStackOffset -= 8; // x64 register size of 64 bits
-            MovMemReg(Reg::RBP, srcReg, Disp8{ localStackOffset });
-        }
+            MovMemReg(Reg::RBP, srcReg, Displacement{ localStackOffset }); // x64 register size of 64 bits
 
         /* Store parameter offset within stack frame */
-        varArgDisp_.push_back(Disp8{ localStackOffset });
+        varArgDisp_.push_back(Displacement{ localStackOffset });
     }
 
-    /* Determine stack base for arguments of subsequent calls */
-    argStackBase_.disp8 = localStackOffset;
+    /* Determine base pointer offsets for allocated stack chunks (below the variadic arguments) */
+    std::uint32_t chunkStackOffset = 8 + varArgSize;
 
-    /* Determine stack base for allocated stack chunks */
     stackChunkOffsets_.reserve(stackChunks.size());
     for (auto chunk : stackChunks)
     {
-        chunkStackOffset += static_cast<std::int32_t>(chunk);
+        chunkStackOffset += GetAlignedSize(chunk, g_amd64StackAlignment);
         stackChunkOffsets_.push_back(chunkStackOffset);
     }
 }
 
-void AMD64Assembler::WriteOptREX(Reg reg, bool defaultsTo64Bit)
+void AMD64Assembler::WriteArgToReg(Reg dstReg, const Arg& arg)
 {
-    std::uint8_t prefix = 0;
-
-    if (Is64Reg(reg))
+    if (arg.type == ArgType::VarArgPtr)
     {
-        if (!defaultsTo64Bit || reg >= Reg::R8)
+        /* Load address of parameter within local stack */
+        LeaRegMem(dstReg, Reg::RBP, varArgDisp_[arg.param]);
+    }
+    else if (arg.param < 0xF)
+    {
+        /* Move parameter from local stack into destination register */
+        if (IsFltReg(dstReg))
+            MovDQURegMem(dstReg, Reg::RBP, varArgDisp_[arg.param]);
+        else
+            MovRegMem(dstReg, Reg::RBP, varArgDisp_[arg.param]);
+    }
+    else
+    {
+        /* Move value into destination register */
+        switch (arg.type)
         {
-            prefix |= REX_W;
-            if (reg >= Reg::R8)
-                prefix |= REX_B;
+            case ArgType::Byte:
+                MovRegImm32(dstReg, arg.value.i8);
+                break;
+            case ArgType::Word:
+                MovRegImm32(dstReg, arg.value.i16);
+                break;
+            case ArgType::DWord:
+                MovRegImm32(dstReg, arg.value.i32);
+                break;
+            case ArgType::QWord:
+            case ArgType::Ptr:
+                MovRegImm64(dstReg, arg.value.i64);
+                break;
+            case ArgType::StackPtr:
+                LeaRegMem(dstReg, Reg::RBP, Displacement{ -static_cast<std::int32_t>(stackChunkOffsets_[arg.value.i8]) });
+                break;
+            case ArgType::VarArgPtr:
+                break;
+            case ArgType::Float:
+                MovSSRegImm32(dstReg, arg.value.f32);
+                break;
+            case ArgType::Double:
+                MovSDRegImm64(dstReg, arg.value.f64);
+                break;
         }
     }
-
-    if (prefix != 0)
-        WriteByte(REX_Prefix | prefix);
 }
 
-void AMD64Assembler::WriteOptDisp(const Displacement& disp)
+void AMD64Assembler::WriteArgToStack(const Displacement& disp, const Arg& arg)
 {
-    if (disp.disp32 != 0)
+    if (arg.type == ArgType::VarArgPtr)
     {
-        if (disp.has32Bits)
-            WriteDWord(static_cast<std::uint32_t>(disp.disp32));
-        else
-            WriteByte(static_cast<std::uint8_t>(disp.disp8));
+        /* Store address of parameter within local stack */
+        LeaRegMem(g_amd64TempReg, Reg::RBP, varArgDisp_[arg.param]);
+        MovMemReg(Reg::RSP, g_amd64TempReg, disp);
+    }
+    else if (arg.param < 0xF)
+    {
+        /* Copy parameter from local stack; the lower 64 bits are sufficient for floating-point parameters */
+        MovRegMem(g_amd64TempReg, Reg::RBP, varArgDisp_[arg.param]);
+        MovMemReg(Reg::RSP, g_amd64TempReg, disp);
+    }
+    else
+    {
+        /* Store value in outgoing argument area */
+        switch (arg.type)
+        {
+            case ArgType::Byte:
+            case ArgType::Word:
+            case ArgType::DWord:
+            case ArgType::Float:
+                MovMemImm32(Reg::RSP, arg.value.i32, disp);
+                break;
+            case ArgType::QWord:
+            case ArgType::Ptr:
+            case ArgType::Double:
+                MovRegImm64(g_amd64TempReg, arg.value.i64);
+                MovMemReg(Reg::RSP, g_amd64TempReg, disp);
+                break;
+            case ArgType::StackPtr:
+                LeaRegMem(g_amd64TempReg, Reg::RBP, Displacement{ -static_cast<std::int32_t>(stackChunkOffsets_[arg.value.i8]) });
+                MovMemReg(Reg::RSP, g_amd64TempReg, disp);
+                break;
+            case ArgType::VarArgPtr:
+                break;
+        }
     }
 }
 
-void AMD64Assembler::WriteOptSIB(Reg reg)
+// Writes the REX prefix if a 64-bit operand size is specified or any of the registers in the reg or r/m field is an extended register.
+void AMD64Assembler::WriteOptREX(bool rexW, Reg reg, Reg rm)
 {
-    if (reg == Reg::RSP)
-        WriteByte((RegByte(reg) << 3) | RegByte(reg));
+    std::uint8_t prefix = 0;
+
+    if (rexW)
+        prefix |= REX_W;
+    if (IsExtReg(reg))
+        prefix |= REX_R;
+    if (IsExtReg(rm))
+        prefix |= REX_B;
+
+    if (prefix != 0)
+        WriteByte(REX_Prefix | prefix);
+}
+
+// Writes the ModR/M byte, optional SIB byte, and optional displacement for the memory operand [baseReg + disp].
+void AMD64Assembler::WriteModRMMem(Reg reg, Reg baseReg, const Displacement& disp)
+{
+    std::uint8_t mod = DispMod(disp);
+
+    /* [RBP] and [R13] require a displacement, since mod=00 with r/m=101 denotes RIP-relative addressing */
+    if (mod == 0 && RegByte(baseReg) == RegByte(Reg::RBP))
+        mod = Operand_Mod01;
+
+    WriteByte(mod | (RegByte(reg) << 3) | RegByte(baseReg));
+
+    /* [RSP] and [R12] require a SIB byte without index */
+    if (RegByte(baseReg) == RegByte(Reg::RSP))
+        WriteByte((RegByte(Reg::RSP) << 3) | RegByte(Reg::RSP));
+
+    if (mod == Operand_Mod10)
+        WriteDWord(static_cast<std::uint32_t>(disp.disp32));
+    else if (mod == Operand_Mod01)
+        WriteByte(static_cast<std::uint8_t>(disp.disp8));
 }
 
 void AMD64Assembler::BeginSupplement(const Arg& arg)
@@ -449,18 +460,11 @@ void AMD64Assembler::ApplySupplements()
     }
 }
 
-void AMD64Assembler::ErrInvalidUseOfRSP()
-{
-    #ifdef LLGL_DEBUG
-    //Error("invalid use of %RSP register in MOV instruction");
-    #endif
-}
-
 /* ----- PUSH ----- */
 
 void AMD64Assembler::PushReg(Reg srcReg)
 {
-    WriteOptREX(srcReg, true);
+    WriteOptREX(false, Reg::RAX, srcReg);
     WriteByte(Opcode_PushReg | RegByte(srcReg));
 }
 
@@ -496,7 +500,7 @@ void AMD64Assembler::Push(Reg srcReg)
 
 void AMD64Assembler::PopReg(Reg dstReg)
 {
-    WriteOptREX(dstReg, true);
+    WriteOptREX(false, Reg::RAX, dstReg);
     WriteByte(Opcode_PopReg | RegByte(dstReg));
 }
 
@@ -516,15 +520,17 @@ void AMD64Assembler::Pop(Reg dstReg)
 // Opcode: 89 /r
 void AMD64Assembler::MovReg(Reg dstReg, Reg srcReg)
 {
-    WriteOptREX(dstReg);
+    WriteOptREX(Is64Reg(dstReg), srcReg, dstReg);
     WriteByte(Opcode_MovMemReg);
     WriteByte(Operand_Mod11 | RegByte(srcReg) << 3 | RegByte(dstReg));
 }
 
+// Opcode: B8 +rd id (zero extends to 64 bits)
 void AMD64Assembler::MovRegImm32(Reg dstReg, std::uint32_t dword)
 {
     if (dword != 0)
     {
+        WriteOptREX(false, Reg::RAX, dstReg);
         WriteByte(Opcode_MovRegImm | RegByte(dstReg));
         WriteDWord(dword);
     }
@@ -532,11 +538,12 @@ void AMD64Assembler::MovRegImm32(Reg dstReg, std::uint32_t dword)
         XOrReg(dstReg, dstReg);
 }
 
+// Opcode: REX.W B8 +rd io
 void AMD64Assembler::MovRegImm64(Reg dstReg, std::uint64_t qword)
 {
     if (qword != 0)
     {
-        WriteOptREX(dstReg);
+        WriteOptREX(true, Reg::RAX, dstReg);
         WriteByte(Opcode_MovRegImm | RegByte(dstReg));
         WriteQWord(qword);
     }
@@ -544,55 +551,67 @@ void AMD64Assembler::MovRegImm64(Reg dstReg, std::uint64_t qword)
         XOrReg(dstReg, dstReg);
 }
 
+// Opcode: REX.W C7 /0 id (sign extends to 64 bits)
 void AMD64Assembler::MovMemImm32(Reg dstMemReg, std::uint32_t dword, const Displacement& disp)
 {
-    WriteOptREX(dstMemReg); // prefix
+    WriteOptREX(true, Reg::RAX, dstMemReg);
     WriteByte(Opcode_MovMemImm);
-    WriteByte(DispMod(disp) | RegByte(dstMemReg));
-    WriteOptSIB(dstMemReg);
-    WriteOptDisp(disp); // displacement
+    WriteModRMMem(Reg::RAX, dstMemReg, disp);
     WriteDWord(dword); // immediate
 }
 
+// Opcode: 89 /r
 void AMD64Assembler::MovMemReg(Reg dstMemReg, Reg srcReg, const Displacement& disp)
 {
-    WriteOptREX(srcReg); // prefix
+    WriteOptREX(Is64Reg(srcReg), srcReg, dstMemReg);
     WriteByte(Opcode_MovMemReg);
-    WriteByte(ModRM(DispMod(disp), srcReg, dstMemReg));
-    WriteOptSIB(dstMemReg);
-    WriteOptDisp(disp); // displacement
+    WriteModRMMem(srcReg, dstMemReg, disp);
 }
 
+// Opcode: 8B /r
 void AMD64Assembler::MovRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp)
 {
-    WriteOptREX(dstReg);
+    WriteOptREX(Is64Reg(dstReg), dstReg, srcMemReg);
     WriteByte(Opcode_MovRegMem);
-    WriteByte(ModRM(DispMod(disp), dstReg, srcMemReg));
-    WriteOptSIB(srcMemReg);
-    WriteOptDisp(disp);
+    WriteModRMMem(dstReg, srcMemReg, disp);
 }
 
 #if 0 // UNUSED
-// dstReg: XMM0-XMM7, srcMemReg: RAX-RDI
 void AMD64Assembler::MovSSRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp)
 {
-    Write(OpcodeSSE2_MovSSRegMem, 3);
-    WriteByte(DispMod(disp) | (RegByte(dstReg) << 3) | RegByte(srcMemReg));
-    WriteOptDisp(disp); // displacement
+    WriteByte(OpcodeSSE2_MovSSRegMem[0]);
+    WriteOptREX(false, dstReg, srcMemReg);
+    Write(&OpcodeSSE2_MovSSRegMem[1], 2);
+    WriteModRMMem(dstReg, srcMemReg, disp);
 }
 
-// dstReg: XMM0-XMM7, srcMemReg: RAX-RDI
 void AMD64Assembler::MovSDRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp)
 {
-    Write(OpcodeSSE2_MovSDRegMem, 3);
-    WriteByte(DispMod(disp) | (RegByte(dstReg) << 3) | RegByte(srcMemReg));
-    WriteOptDisp(disp); // displacement
+    WriteByte(OpcodeSSE2_MovSDRegMem[0]);
+    WriteOptREX(false, dstReg, srcMemReg);
+    Write(&OpcodeSSE2_MovSDRegMem[1], 2);
+    WriteModRMMem(dstReg, srcMemReg, disp);
 }
 #endif // /UNUSED
 
+/* ----- LEA ----- */
+
+// Opcode: REX.W 8D /r
+void AMD64Assembler::LeaRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp)
+{
+    WriteOptREX(true, dstReg, srcMemReg);
+    WriteByte(Opcode_LeaRegMem);
+    WriteModRMMem(dstReg, srcMemReg, disp);
+}
+
+/* ----- MOVSS/MOVSD/MOVDQU ----- */
+
+// The REX prefix must be placed between the mandatory prefix and the opcode
 void AMD64Assembler::MovSSRegImm32(Reg dstReg, float f32)
 {
-    Write(OpcodeSSE2_MovSSRegMem, 3);
+    WriteByte(OpcodeSSE2_MovSSRegMem[0]);
+    WriteOptREX(false, dstReg, Reg::RAX);
+    Write(&OpcodeSSE2_MovSSRegMem[1], 2);
     WriteByte((RegByte(dstReg) << 3) | Operand_RIP);
 
     Arg arg;
@@ -607,7 +626,9 @@ void AMD64Assembler::MovSSRegImm32(Reg dstReg, float f32)
 
 void AMD64Assembler::MovSDRegImm64(Reg dstReg, double f64)
 {
-    Write(OpcodeSSE2_MovSDRegMem, 3);
+    WriteByte(OpcodeSSE2_MovSDRegMem[0]);
+    WriteOptREX(false, dstReg, Reg::RAX);
+    Write(&OpcodeSSE2_MovSDRegMem[1], 2);
     WriteByte((RegByte(dstReg) << 3) | Operand_RIP);
 
     Arg arg;
@@ -620,29 +641,27 @@ void AMD64Assembler::MovSDRegImm64(Reg dstReg, double f64)
     EndSupplement();
 }
 
-// dstReg: XMM0-XMM7, srcMemReg: RAX-RDI
 void AMD64Assembler::MovDQURegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp)
 {
-    Write(OpcodeSSE2_MovDQURegMem, 3);
-    WriteByte(ModRM(DispMod(disp), dstReg, srcMemReg));
-    WriteOptSIB(srcMemReg);
-    WriteOptDisp(disp);
+    WriteByte(OpcodeSSE2_MovDQURegMem[0]);
+    WriteOptREX(false, dstReg, srcMemReg);
+    Write(&OpcodeSSE2_MovDQURegMem[1], 2);
+    WriteModRMMem(dstReg, srcMemReg, disp);
 }
 
-// dstMemReg: RAX-RDI, srcReg: XMM0-XMM7
 void AMD64Assembler::MovDQUMemReg(Reg dstMemReg, Reg srcReg, const Displacement& disp)
 {
-    Write(OpcodeSSE2_MovDQUMemReg, 3);
-    WriteByte(ModRM(DispMod(disp), srcReg, dstMemReg));
-    WriteOptSIB(dstMemReg);
-    WriteOptDisp(disp);
+    WriteByte(OpcodeSSE2_MovDQUMemReg[0]);
+    WriteOptREX(false, srcReg, dstMemReg);
+    Write(&OpcodeSSE2_MovDQUMemReg[1], 2);
+    WriteModRMMem(srcReg, dstMemReg, disp);
 }
 
 /* ----- ADD ----- */
 
 void AMD64Assembler::AddImm32(Reg dst, std::uint32_t dword)
 {
-    WriteOptREX(dst);
+    WriteOptREX(Is64Reg(dst), Reg::RAX, dst);
     WriteByte(Opcode_AddImm);
     WriteByte(Operand_Mod11 | RegByte(dst));
     WriteDWord(dword);
@@ -653,7 +672,7 @@ void AMD64Assembler::AddImm32(Reg dst, std::uint32_t dword)
 // Opcode: 81 /5 id
 void AMD64Assembler::SubImm32(Reg dstReg, std::uint32_t dword)
 {
-    WriteOptREX(dstReg);
+    WriteOptREX(Is64Reg(dstReg), Reg::RAX, dstReg);
     WriteByte(Opcode_SubImm);
     WriteByte(Operand_Mod11 | (5u << 3) | RegByte(dstReg));
     WriteDWord(dword);
@@ -665,7 +684,7 @@ void AMD64Assembler::SubImm32(Reg dstReg, std::uint32_t dword)
 // Divide RDX:RAX -> Quotient: RAX, Remainder: RDX
 void AMD64Assembler::DivReg(Reg srcReg)
 {
-    WriteOptREX(srcReg);
+    WriteOptREX(Is64Reg(srcReg), Reg::RAX, srcReg);
     WriteByte(Opcode_DivReg);
     WriteByte(Operand_Mod11 | (6u << 3) | RegByte(srcReg));
 }
@@ -675,7 +694,7 @@ void AMD64Assembler::DivReg(Reg srcReg)
 // Opcode: 31 /r
 void AMD64Assembler::XOrReg(Reg dstReg, Reg srcReg)
 {
-    WriteOptREX(dstReg);
+    WriteOptREX(Is64Reg(dstReg), srcReg, dstReg);
     WriteByte(Opcode_XOrMemReg);
     WriteByte(Operand_Mod11 | RegByte(srcReg) << 3 | RegByte(dstReg));
 }
@@ -684,7 +703,7 @@ void AMD64Assembler::XOrReg(Reg dstReg, Reg srcReg)
 
 void AMD64Assembler::CallNear(Reg reg)
 {
-    WriteOptREX(reg, true);
+    WriteOptREX(false, Reg::RAX, reg);
     WriteByte(0xFF);
     WriteByte(Opcode_CallNear | Operand_Mod11 | RegByte(reg));
 }
@@ -742,6 +761,12 @@ AMD64Assembler::Displacement::Displacement() :
 {
 }
 
+AMD64Assembler::Displacement::Displacement(std::int32_t disp) :
+    has32Bits { disp < -128 || disp > 127 },
+    disp32    { disp                      }
+{
+}
+
 AMD64Assembler::Disp8::Disp8(std::int8_t disp)
 {
     has32Bits   = false;
@@ -41,7 +41,6 @@ class AMD64Assembler final : public JITCompiler
         struct Displacement;
 
         std::uint8_t DispMod(const Displacement& disp) const;
-        std::uint8_t ModRM(std::uint8_t mode, Reg r0, Reg r1) const;
 
         void WritePrologue();
         void WriteEpilogue();
@@ -51,16 +50,19 @@ class AMD64Assembler final : public JITCompiler
             const std::vector<std::uint32_t>&   stackChunks
         );
 
-        void WriteOptREX(Reg reg, bool defaultsTo64Bit = false);
-        void WriteOptDisp(const Displacement& disp);
-        void WriteOptSIB(Reg reg);
+        // Moves the specified function argument into the destination register.
+        void WriteArgToReg(Reg dstReg, const Arg& arg);
+
+        // Moves the specified function argument into the outgoing argument area at [RSP + disp].
+        void WriteArgToStack(const Displacement& disp, const Arg& arg);
+
+        void WriteOptREX(bool rexW, Reg reg, Reg rm);
+        void WriteModRMMem(Reg reg, Reg baseReg, const Displacement& disp);
 
         void BeginSupplement(const Arg& arg);
         void EndSupplement();
         void ApplySupplements();
 
-        void ErrInvalidUseOfRSP();
-
     private:
 
         void PushReg(Reg srcReg);
@@ -79,6 +81,8 @@ class AMD64Assembler final : public JITCompiler
         void MovMemReg(Reg dstMemReg, Reg srcReg, const Displacement& disp);
         void MovRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp);
 
+        void LeaRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp);
+
         #if 0 // UNUSED
         void MovSSRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp);
         void MovSDRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp);
@@ -119,6 +123,7 @@ class AMD64Assembler final : public JITCompiler
         struct Displacement
         {
             Displacement();
+            Displacement(std::int32_t disp); // Uses 8 bits if the displacement is within [-128, 127]
             Displacement(const Displacement&) = default;
             Displacement& operator = (const Displacement&) = default;
 
@@ -142,9 +147,7 @@ class AMD64Assembler final : public JITCompiler
 
     private:
 
-        std::uint32_t           	localStackSize_ = 0;
-        std::uint16_t               paramStackSize_ = 0;
-        Displacement                argStackBase_;
+        std::uint32_t               localStackSize_ = 0;
 
         // Supplement data that must be updated after encoding
         std::vector<Supplement>     supplements_;
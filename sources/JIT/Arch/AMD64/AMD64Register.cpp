@@ -78,6 +78,11 @@ bool IsFltReg(const Reg reg)
     return (reg >= Reg::XMM0 && reg <= Reg::XMM15);
 }
 
+bool IsExtReg(const Reg reg)
+{
+    return ((reg >= Reg::R8 && reg <= Reg::R15) || (reg >= Reg::XMM8 && reg <= Reg::XMM15));
+}
+
 
 } // /namespace JIT
 
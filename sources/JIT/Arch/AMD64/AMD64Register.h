@@ -77,6 +77,9 @@ bool Is64Reg(const Reg reg);
 // Returns true, if 'reg' denotes a floating-point register (i.e. XMM0-XMM15).
 bool IsFltReg(const Reg reg);
 
+// Returns true, if 'reg' denotes an extended register that requires a REX prefix (i.e. R8-R15 and XMM8-XMM15).
+bool IsExtReg(const Reg reg);
+
 
 } // /namespace JIT
 
@@ -0,0 +1,456 @@
+/*
+ * ARM64Assembler.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ARM64Assembler.h"
+#include "ARM64Opcode.h"
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+namespace JIT
+{
+
+
+/*
+ * Internal members
+ */
+
+/*
+Procedure Call Standard for the ARM 64-bit Architecture (AAPCS64)
+Preserved for caller: X19-X29, SP, lower 64 bits of V8-V15
+Integral and floating-point arguments are assigned to their registers independently of each other.
+see https://github.com/ARM-software/abi-aa/blob/main/aapcs64/aapcs64.rst
+*/
+static const Reg g_arm64IntParams[] = { Reg::X0, Reg::X1, Reg::X2, Reg::X3, Reg::X4, Reg::X5, Reg::X6, Reg::X7 };
+static const Reg g_arm64FltParams[] = { Reg::V0, Reg::V1, Reg::V2, Reg::V3, Reg::V4, Reg::V5, Reg::V6, Reg::V7 };
+
+// Intra-procedure-call scratch registers (IP0 and IP1) are never used for arguments
+static const Reg g_arm64TempReg     = Reg::X16;
+static const Reg g_arm64CallReg     = Reg::X17;
+
+static const std::size_t g_arm64IntParamsCount = sizeof(g_arm64IntParams)/sizeof(g_arm64IntParams[0]);
+static const std::size_t g_arm64FltParamsCount = sizeof(g_arm64FltParams)/sizeof(g_arm64FltParams[0]);
+
+// Size of the outgoing argument area at the bottom of the stack frame. This is enough for 16 arguments.
+static const std::uint32_t g_arm64ArgStackSize = 128;
+
+// SP must always be 16-byte aligned when it is used as base register.
+static const std::uint32_t g_arm64StackAlignment = 16;
+
+// Offset of the first stack parameter of the entry point from the frame pointer (after preserved X29 and X30).
+static const std::uint32_t g_arm64ParamStackOffset = 16;
+
+
+/*
+ * Internal functions
+ */
+
+// Size of byte (1), word (2), dword (4), qword (8), ptr (8), stack-ptr (8), var-arg-ptr (8), float (4), double (8)
+static std::uint8_t GetArgSize(const ArgType t)
+{
+    static const std::uint8_t sizes[] = { 1, 2, 4, 8, 8, 8, 8, 4, 8 };
+    return sizes[static_cast<std::uint8_t>(t)];
+}
+
+// Returns the binary logarithm of the specified access size, i.e. 1 -> 0, 2 -> 1, 4 -> 2, and 8 -> 3.
+static std::uint32_t GetSizeLog2(std::uint8_t size)
+{
+    std::uint32_t log2 = 0;
+    while ((1u << log2) < size)
+        ++log2;
+    return log2;
+}
+
+// Helper structure to assign function arguments to their parameter registers.
+struct ARM64ParamAllocator
+{
+    // Returns the register for the next argument, or SP if the argument must be passed on the stack.
+    Reg Next(bool isFloat)
+    {
+        if (isFloat)
+        {
+            if (numFltRegs < g_arm64FltParamsCount)
+                return g_arm64FltParams[numFltRegs++];
+        }
+        else if (numIntRegs < g_arm64IntParamsCount)
+            return g_arm64IntParams[numIntRegs++];
+        return Reg::SP;
+    }
+
+    std::size_t numIntRegs = 0;
+    std::size_t numFltRegs = 0;
+};
+
+
+/*
+ * ARM64Assembler class
+ */
+
+void ARM64Assembler::Begin()
+{
+    /* Reset data about local stack */
+    localStackSize_ = 0;
+    varArgOffsets_.clear();
+    stackChunkOffsets_.clear();
+
+    /* Write entry point prologue */
+    WritePrologue();
+    WriteStackFrame(GetEntryVarArgs(), GetStackAllocs());
+}
+
+void ARM64Assembler::End()
+{
+    /* Write entry point epilogue; the local stack is popped by restoring SP from the frame pointer */
+    WriteEpilogue();
+}
+
+void ARM64Assembler::WriteFuncCall(const void* addr, JITCallConv conv, bool farCall)
+{
+    ARM64ParamAllocator paramAlloc;
+    std::uint32_t argStackOffset = 0;
+
+    for (const auto& arg : GetArgs())
+    {
+        /* Move argument into its parameter register or onto the stack */
+        const Reg dstReg = paramAlloc.Next(IsFloat(arg.type));
+        if (dstReg != Reg::SP)
+            WriteArgToReg(dstReg, arg);
+        else
+        {
+            #ifdef __APPLE__
+            /* Apple's ARM64 ABI packs stack arguments with their natural size and alignment */
+            const std::uint8_t argSize = GetArgSize(arg.type);
+            argStackOffset = GetAlignedSize<std::uint32_t>(argStackOffset, argSize);
+            #else
+            /* AAPCS64 rounds up each stack argument to 8 bytes */
+            const std::uint8_t argSize = 8;
+            #endif
+
+            if (argStackOffset + argSize > g_arm64ArgStackSize)
+                throw std::runtime_error("too many arguments for JIT function call on ARM64");
+
+            WriteArgToStack(argStackOffset, argSize, arg);
+            argStackOffset += argSize;
+        }
+    }
+
+    /* Write 'blr' instruction */
+    MovImm64(g_arm64CallReg, reinterpret_cast<std::uint64_t>(addr));
+    Blr(g_arm64CallReg);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool ARM64Assembler::IsLittleEndian() const
+{
+    return true;
+}
+
+void ARM64Assembler::WritePrologue()
+{
+    /* Store frame pointer (X29) and link register (X30), and set up new frame pointer */
+    StpPre(Reg::X29, Reg::X30, Reg::SP, -16);
+    AddImm(Reg::X29, Reg::SP, 0);
+}
+
+void ARM64Assembler::WriteEpilogue()
+{
+    /* Restore stack pointer, frame pointer (X29), and link register (X30) */
+    AddImm(Reg::SP, Reg::X29, 0);
+    LdpPost(Reg::X29, Reg::X30, Reg::SP, 16);
+    Ret();
+}
+
+/*
+Stack frame layout:
+[X29 + 16]  Entry point parameters that are passed on the stack
+[X29 + 8]   Preserved X30 (link register)
+[X29]       Preserved X29 (frame pointer)
+[...]       Entry point parameters (8 bytes each)
+[...]       Stack allocations
+[SP]        Outgoing argument area for subsequent function calls
+*/
+void ARM64Assembler::WriteStackFrame(
+    const std::vector<JIT::ArgType>&    varArgTypes,
+    const std::vector<std::uint32_t>&   stackChunks)
+{
+    /* Determine base stack offsets of allocated stack chunks (right after the outgoing argument area) */
+    std::uint32_t localStackOffset = g_arm64ArgStackSize;
+
+    stackChunkOffsets_.reserve(stackChunks.size());
+    for (auto chunk : stackChunks)
+    {
+        stackChunkOffsets_.push_back(localStackOffset);
+        localStackOffset += GetAlignedSize(chunk, g_arm64StackAlignment);
+    }
+
+    /* Determine stack offsets for variadic arguments; the lower 64 bits of SIMD registers are sufficient */
+    varArgOffsets_.reserve(varArgTypes.size());
+    for (std::size_t i = 0; i < varArgTypes.size(); ++i)
+    {
+        varArgOffsets_.push_back(localStackOffset);
+        localStackOffset += 8;
+    }
+
+    /* Allocate local stack */
+    localStackSize_ = GetAlignedSize(localStackOffset, g_arm64StackAlignment);
+    SubImm(Reg::SP, Reg::SP, localStackSize_);
+
+    /* Store parameters in local stack */
+    ARM64ParamAllocator paramAlloc;
+    std::uint32_t paramStackOffset = g_arm64ParamStackOffset;
+
+    for (std::size_t i = 0; i < varArgTypes.size(); ++i)
+    {
+        #ifdef __APPLE__
+        /* Apple's ARM64 ABI passes all variadic arguments on the stack in 8-byte slots */
+        Reg srcReg = Reg::SP;
+        #else
+        Reg srcReg = paramAlloc.Next(IsFloat(varArgTypes[i]));
+        #endif
+
+        if (srcReg == Reg::SP)
+        {
+            /* Load parameter from stack */
+            srcReg = g_arm64TempReg;
+            LdrMem(srcReg, Reg::X29, paramStackOffset, 8);
+            paramStackOffset += 8;
+        }
+
+        StrMem(Reg::SP, srcReg, varArgOffsets_[i], 8);
+    }
+}
+
+void ARM64Assembler::WriteArgToReg(Reg dstReg, const Arg& arg)
+{
+    if (arg.type == ArgType::VarArgPtr)
+    {
+        /* Load address of parameter within local stack */
+        AddImm(dstReg, Reg::SP, varArgOffsets_[arg.param]);
+    }
+    else if (arg.param < 0xF)
+    {
+        /* Load parameter from local stack into destination register */
+        if (IsFltReg(dstReg))
+            LdrMem(dstReg, Reg::SP, varArgOffsets_[arg.param], GetArgSize(arg.type));
+        else
+            LdrMem(dstReg, Reg::SP, varArgOffsets_[arg.param], 8);
+    }
+    else
+    {
+        /* Move value into destination register */
+        switch (arg.type)
+        {
+            case ArgType::Byte:
+                MovImm64(dstReg, arg.value.i8);
+                break;
+            case ArgType::Word:
+                MovImm64(dstReg, arg.value.i16);
+                break;
+            case ArgType::DWord:
+                MovImm64(dstReg, arg.value.i32);
+                break;
+            case ArgType::QWord:
+            case ArgType::Ptr:
+                MovImm64(dstReg, arg.value.i64);
+                break;
+            case ArgType::StackPtr:
+                AddImm(dstReg, Reg::SP, stackChunkOffsets_[arg.value.i8]);
+                break;
+            case ArgType::VarArgPtr:
+                break;
+            case ArgType::Float:
+                MovImm64(g_arm64TempReg, arg.value.i32);
+                FMovFromGPR(dstReg, g_arm64TempReg, false);
+                break;
+            case ArgType::Double:
+                MovImm64(g_arm64TempReg, arg.value.i64);
+                FMovFromGPR(dstReg, g_arm64TempReg, true);
+                break;
+        }
+    }
+}
+
+void ARM64Assembler::WriteArgToStack(std::uint32_t offset, std::uint8_t size, const Arg& arg)
+{
+    if (arg.type == ArgType::VarArgPtr)
+    {
+        /* Compute address of parameter within local stack */
+        AddImm(g_arm64TempReg, Reg::SP, varArgOffsets_[arg.param]);
+    }
+    else if (arg.param < 0xF)
+    {
+        /* Copy parameter from local stack */
+        LdrMem(g_arm64TempReg, Reg::SP, varArgOffsets_[arg.param], 8);
+    }
+    else if (arg.type == ArgType::StackPtr)
+    {
+        /* Compute address of stack allocation */
+        AddImm(g_arm64TempReg, Reg::SP, stackChunkOffsets_[arg.value.i8]);
+    }
+    else
+    {
+        /* Move value (or bit pattern of floating-point value) into temporary register */
+        const std::uint8_t argSize = GetArgSize(arg.type);
+        if (argSize < 8)
+            MovImm64(g_arm64TempReg, arg.value.i64 & ((1ull << (argSize * 8)) - 1ull));
+        else
+            MovImm64(g_arm64TempReg, arg.value.i64);
+    }
+
+    /* Store argument in outgoing argument area */
+    StrMem(Reg::SP, g_arm64TempReg, offset, size);
+}
+
+void ARM64Assembler::WriteInstr(std::uint32_t instr)
+{
+    WriteDWord(instr);
+}
+
+/* ----- STP/LDP ----- */
+
+// Opcode: STP Xt1, Xt2, [Xn, #imm]!
+void ARM64Assembler::StpPre(Reg srcReg1, Reg srcReg2, Reg memReg, std::int32_t offset)
+{
+    const std::uint32_t imm7 = static_cast<std::uint32_t>(offset / 8) & 0x7F;
+    WriteInstr(Opcode_StpPre64 | (imm7 << 15) | (RegByte(srcReg2) << 10) | (RegByte(memReg) << 5) | RegByte(srcReg1));
+}
+
+// Opcode: LDP Xt1, Xt2, [Xn], #imm
+void ARM64Assembler::LdpPost(Reg dstReg1, Reg dstReg2, Reg memReg, std::int32_t offset)
+{
+    const std::uint32_t imm7 = static_cast<std::uint32_t>(offset / 8) & 0x7F;
+    WriteInstr(Opcode_LdpPost64 | (imm7 << 15) | (RegByte(dstReg2) << 10) | (RegByte(memReg) << 5) | RegByte(dstReg1));
+}
+
+/* ----- ADD/SUB ----- */
+
+// Opcode: ADD Xd, Xn, #imm (24-bit immediates are split into two instructions)
+void ARM64Assembler::AddImm(Reg dstReg, Reg srcReg, std::uint32_t imm)
+{
+    if (imm > 0xFFFFFF)
+        throw std::runtime_error("immediate value out of range for ARM64 ADD instruction");
+
+    const std::uint32_t immHi = (imm >> 12);
+    const std::uint32_t immLo = (imm & 0xFFF);
+
+    if (immHi != 0)
+    {
+        WriteInstr(Opcode_AddImm64 | Opcode_ShiftImm12 | (immHi << 10) | (RegByte(srcReg) << 5) | RegByte(dstReg));
+        if (immLo != 0)
+            WriteInstr(Opcode_AddImm64 | (immLo << 10) | (RegByte(dstReg) << 5) | RegByte(dstReg));
+    }
+    else
+        WriteInstr(Opcode_AddImm64 | (immLo << 10) | (RegByte(srcReg) << 5) | RegByte(dstReg));
+}
+
+// Opcode: SUB Xd, Xn, #imm (24-bit immediates are split into two instructions)
+void ARM64Assembler::SubImm(Reg dstReg, Reg srcReg, std::uint32_t imm)
+{
+    if (imm > 0xFFFFFF)
+        throw std::runtime_error("immediate value out of range for ARM64 SUB instruction");
+
+    const std::uint32_t immHi = (imm >> 12);
+    const std::uint32_t immLo = (imm & 0xFFF);
+
+    if (immHi != 0)
+    {
+        WriteInstr(Opcode_SubImm64 | Opcode_ShiftImm12 | (immHi << 10) | (RegByte(srcReg) << 5) | RegByte(dstReg));
+        if (immLo != 0)
+            WriteInstr(Opcode_SubImm64 | (immLo << 10) | (RegByte(dstReg) << 5) | RegByte(dstReg));
+    }
+    else
+        WriteInstr(Opcode_SubImm64 | (immLo << 10) | (RegByte(srcReg) << 5) | RegByte(dstReg));
+}
+
+/* ----- MOV ----- */
+
+// Opcode: MOVZ Xd, #imm16 followed by MOVK Xd, #imm16, LSL #(16*hw) for each non-zero 16-bit chunk
+void ARM64Assembler::MovImm64(Reg dstReg, std::uint64_t qword)
+{
+    bool isFirst = true;
+
+    for (std::uint32_t hw = 0; hw < 4; ++hw)
+    {
+        const std::uint32_t imm16 = static_cast<std::uint32_t>((qword >> (hw * 16)) & 0xFFFF);
+        if (imm16 != 0)
+        {
+            WriteInstr((isFirst ? Opcode_MovZ64 : Opcode_MovK64) | (hw << 21) | (imm16 << 5) | RegByte(dstReg));
+            isFirst = false;
+        }
+    }
+
+    if (isFirst)
+        WriteInstr(Opcode_MovZ64 | RegByte(dstReg));
+}
+
+// Opcode: FMOV St, Wn or FMOV Dt, Xn
+void ARM64Assembler::FMovFromGPR(Reg dstReg, Reg srcReg, bool doublePrecision)
+{
+    WriteInstr((doublePrecision ? Opcode_FMovDX : Opcode_FMovSW) | (RegByte(srcReg) << 5) | RegByte(dstReg));
+}
+
+/* ----- LDR/STR ----- */
+
+// Returns the encoding of LDR/STR with unsigned immediate offset. The offset must be a multiple of the access size.
+static std::uint32_t EncodeLoadStore(bool load, Reg reg, Reg memReg, std::uint32_t offset, std::uint8_t size)
+{
+    const std::uint32_t sizeLog2 = GetSizeLog2(size);
+    const std::uint32_t imm12    = (offset >> sizeLog2);
+
+    if ((offset & (size - 1u)) != 0 || imm12 > 0xFFF)
+        throw std::runtime_error("memory offset out of range for ARM64 LDR/STR instruction");
+
+    std::uint32_t instr = Opcode_StrImm8 | (sizeLog2 << 30) | (imm12 << 10) | (RegByte(memReg) << 5) | RegByte(reg);
+
+    if (IsFltReg(reg))
+        instr |= LoadStore_SIMD;
+    if (load)
+        instr |= LoadStore_Load;
+
+    return instr;
+}
+
+// Opcode: LDR Xt, [Xn, #imm] (or LDR St/Dt for SIMD registers)
+void ARM64Assembler::LdrMem(Reg dstReg, Reg srcMemReg, std::uint32_t offset, std::uint8_t size)
+{
+    WriteInstr(EncodeLoadStore(true, dstReg, srcMemReg, offset, size));
+}
+
+// Opcode: STR Xt, [Xn, #imm] (or STRB/STRH/STR Wt for smaller sizes and STR St/Dt for SIMD registers)
+void ARM64Assembler::StrMem(Reg dstMemReg, Reg srcReg, std::uint32_t offset, std::uint8_t size)
+{
+    WriteInstr(EncodeLoadStore(false, srcReg, dstMemReg, offset, size));
+}
+
+/* ----- BLR ----- */
+
+void ARM64Assembler::Blr(Reg reg)
+{
+    WriteInstr(Opcode_Blr | (RegByte(reg) << 5));
+}
+
+/* ----- RET ----- */
+
+void ARM64Assembler::Ret()
+{
+    WriteInstr(Opcode_Ret);
+}
+
+
+} // /namespace JIT
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
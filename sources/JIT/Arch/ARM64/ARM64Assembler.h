@@ -0,0 +1,96 @@
+/*
+ * ARM64Assembler.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_ARM64_ASSEMBLER_H
+#define LLGL_ARM64_ASSEMBLER_H
+
+
+#include "ARM64Register.h"
+#include "../../JITCompiler.h"
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+namespace JIT
+{
+
+
+// ARM64 (a.k.a. AArch64) assembly code generator for the AAPCS64 calling convention.
+class ARM64Assembler final : public JITCompiler
+{
+
+    public:
+
+        void Begin() override;
+        void End() override;
+
+    private:
+
+        bool IsLittleEndian() const override;
+        void WriteFuncCall(const void* addr, JITCallConv conv, bool farCall) override;
+
+    private:
+
+        void WritePrologue();
+        void WriteEpilogue();
+
+        void WriteStackFrame(
+            const std::vector<JIT::ArgType>&    varArgTypes,
+            const std::vector<std::uint32_t>&   stackChunks
+        );
+
+        // Moves the specified function argument into the destination register.
+        void WriteArgToReg(Reg dstReg, const Arg& arg);
+
+        // Stores the specified function argument with the specified size in the outgoing argument area at [SP + offset].
+        void WriteArgToStack(std::uint32_t offset, std::uint8_t size, const Arg& arg);
+
+        void WriteInstr(std::uint32_t instr);
+
+    private:
+
+        void StpPre(Reg srcReg1, Reg srcReg2, Reg memReg, std::int32_t offset);
+        void LdpPost(Reg dstReg1, Reg dstReg2, Reg memReg, std::int32_t offset);
+
+        void AddImm(Reg dstReg, Reg srcReg, std::uint32_t imm);
+        void SubImm(Reg dstReg, Reg srcReg, std::uint32_t imm);
+
+        void MovImm64(Reg dstReg, std::uint64_t qword);
+        void FMovFromGPR(Reg dstReg, Reg srcReg, bool doublePrecision);
+
+        void LdrMem(Reg dstReg, Reg srcMemReg, std::uint32_t offset, std::uint8_t size);
+        void StrMem(Reg dstMemReg, Reg srcReg, std::uint32_t offset, std::uint8_t size);
+
+        void Blr(Reg reg);
+        void Ret();
+
+    private:
+
+        std::uint32_t               localStackSize_ = 0;
+
+        // SP offsets of parameters within stack frame
+        std::vector<std::uint32_t>  varArgOffsets_;
+
+        // SP offsets of stack allocations
+        std::vector<std::uint32_t>  stackChunkOffsets_;
+
+};
+
+
+} // /namespace JIT
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,73 @@
+/*
+ * ARM64Opcode.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_ARM64_OPCODE_H
+#define LLGL_ARM64_OPCODE_H
+
+
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+namespace JIT
+{
+
+
+/*
+All ARM64 instructions are encoded as 32-bit words in little-endian byte order.
+Rd/Rt => destination/transfer register (bits 0-4)
+Rn    => base/source register (bits 5-9)
+Register number 31 denotes SP in load/store and ADD/SUB (immediate) instructions.
+
+-------------------------------------------------------------------------------
+| Instruction:          | Encoding                                            |
+|-----------------------|-----------------------------------------------------|
+| LDR/STR (unsigned)    | size:2 111 V:1 01 opc:2 imm12:12 Rn:5 Rt:5           |
+| ADD/SUB (immediate)   | 1 op:1 0 100010 sh:1 imm12:12 Rn:5 Rd:5              |
+| MOVZ/MOVK             | 1 opc:2 100101 hw:2 imm16:16 Rd:5                    |
+| STP/LDP (pre/post)    | 10 101 0 0 idx:2 L:1 imm7:7 Rt2:5 Rn:5 Rt:5          |
+-------------------------------------------------------------------------------
+*/
+
+enum LoadStoreBits : std::uint32_t
+{
+    LoadStore_Size32    = 0x80000000, // size = 10
+    LoadStore_Size64    = 0xC0000000, // size = 11
+    LoadStore_SIMD      = 0x04000000, // V = 1
+    LoadStore_Load      = 0x00400000, // opc = 01
+};
+
+enum Opcode : std::uint32_t
+{
+    Opcode_StpPre64     = 0xA9800000, // STP Xt1, Xt2, [Xn, #imm7*8]!
+    Opcode_LdpPost64    = 0xA8C00000, // LDP Xt1, Xt2, [Xn], #imm7*8
+    Opcode_AddImm64     = 0x91000000, // ADD Xd, Xn, #imm12 {, LSL #12}
+    Opcode_SubImm64     = 0xD1000000, // SUB Xd, Xn, #imm12 {, LSL #12}
+    Opcode_ShiftImm12   = 0x00400000, // LSL #12 for ADD/SUB (immediate)
+    Opcode_MovZ64       = 0xD2800000, // MOVZ Xd, #imm16, LSL #hw*16
+    Opcode_MovK64       = 0xF2800000, // MOVK Xd, #imm16, LSL #hw*16
+    Opcode_StrImm8      = 0x39000000, // STRB Wt, [Xn, #imm12]
+    Opcode_FMovSW       = 0x1E270000, // FMOV St, Wn
+    Opcode_FMovDX       = 0x9E670000, // FMOV Dt, Xn
+    Opcode_Blr          = 0xD63F0000, // BLR Xn
+    Opcode_Ret          = 0xD65F03C0, // RET (X30)
+    Opcode_Brk          = 0xD4200000, // BRK #imm16
+};
+
+
+} // /namespace JIT
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
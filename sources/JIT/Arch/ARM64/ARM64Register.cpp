@@ -0,0 +1,37 @@
+/*
+ * ARM64Register.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ARM64Register.h"
+
+
+namespace LLGL
+{
+
+namespace JIT
+{
+
+
+std::uint8_t RegByte(const Reg reg)
+{
+    if (reg >= Reg::V0)
+        return static_cast<std::uint8_t>(static_cast<int>(reg) - static_cast<int>(Reg::V0));
+    else
+        return static_cast<std::uint8_t>(static_cast<int>(reg) - static_cast<int>(Reg::X0));
+}
+
+bool IsFltReg(const Reg reg)
+{
+    return (reg >= Reg::V0 && reg <= Reg::V31);
+}
+
+
+} // /namespace JIT
+
+} // /namespace LLGL
+
+
+// ================================================================================
@@ -19,8 +19,8 @@ namespace JIT
 {
 
 
-// Argument type enumeration.
-enum class ArgType
+// Argument type enumeration. Floating-point types must be the last entries (see IsFloat).
+enum class ArgType : std::uint8_t
 {
     Byte,
     Word,
@@ -28,6 +28,7 @@ enum class ArgType
     QWord,
     Ptr,
     StackPtr,
+    VarArgPtr,
     Float,
     Double,
 };
@@ -9,6 +9,8 @@
 #include "AssemblyTypes.h"
 #include "../Core/Helper.h"
 #include <iomanip>
+#include <sstream>
+#include <string>
 
 #include <LLGL/Platform/Platform.h>
 #if defined LLGL_OS_WIN32
@@ -17,7 +19,9 @@
 #   include "Platform/POSIX/POSIXJITProgram.h"
 #endif
 
-#if defined LLGL_ARCH_ARM
+#if defined LLGL_ARCH_ARM64
+#   include "Arch/ARM64/ARM64Assembler.h"
+#elif defined LLGL_ARCH_ARM
 //#   include "Arch/ARM/ARMAssembler.h"
 #elif defined LLGL_ARCH_AMD64
 #   include "Arch/AMD64/AMD64Assembler.h"
@@ -37,7 +41,9 @@ std::unique_ptr<JITCompiler> JITCompiler::Create()
     std::unique_ptr<JITCompiler> compiler;
 
     /* Create JIT compiler for current CPU architecture */
-    #if defined LLGL_ARCH_ARM
+    #if defined LLGL_ARCH_ARM64
+    compiler = MakeUnique<ARM64Assembler>();
+    #elif defined LLGL_ARCH_ARM
     //TODO
     #elif defined LLGL_ARCH_AMD64
     compiler = MakeUnique<AMD64Assembler>();
@@ -120,6 +126,20 @@ void JITCompiler::PushVarArg(std::uint8_t idx)
     }
 }
 
+void JITCompiler::PushVarArgPtr(std::uint8_t idx)
+{
+    if (idx < entryVarArgs_.size() && idx < 0xF)
+    {
+        Arg arg;
+        {
+            arg.type        = ArgType::VarArgPtr;
+            arg.param       = idx;
+            arg.value.i64   = 0;
+        }
+        args_.push_back(arg);
+    }
+}
+
 void JITCompiler::PushStackPtr(std::uint8_t idx)
 {
     if (idx < stackAllocs_.size())
@@ -368,6 +388,162 @@ LLGL_EXPORT void TestJIT1()
     prog->GetEntryPoint()(28, 2.3f, 4.5);
 }
 
+/*
+Call trace test: The same sequence of calls is executed natively and through the JIT compiler and both call traces are compared.
+The calls cover all argument types in register and stack positions of the System V and Microsoft x64 calling conventions.
+Floating-point entry point parameters are passed as double, since the entry point is a variadic function.
+*/
+
+static std::string g_callTrace;
+
+template <typename... Args>
+static void TraceCall(const char* name, Args... args)
+{
+    std::ostringstream s;
+    s << std::setprecision(17) << name << '(';
+    int unpack[] = { 0, ((s << args << ','), 0)... };
+    (void)unpack;
+    s << ")\n";
+    g_callTrace += s.str();
+}
+
+static void TraceInts(int a0, int a1, int a2, int a3, int a4, int a5, int a6, int a7)
+{
+    TraceCall(__FUNCTION__, a0, a1, a2, a3, a4, a5, a6, a7);
+}
+
+static void TraceMixed(float f0, std::uint8_t b, double d0, std::uint16_t w, const void* p, float f1, std::uint64_t q, double d1)
+{
+    TraceCall(__FUNCTION__, f0, static_cast<unsigned>(b), d0, w, p, f1, q, d1);
+}
+
+static void TraceFloats(float f0, float f1, float f2, float f3, float f4, float f5, float f6, float f7, float f8, double d9)
+{
+    TraceCall(__FUNCTION__, f0, f1, f2, f3, f4, f5, f6, f7, f8, d9);
+}
+
+static void TraceVarArgs(const void* p, std::uint32_t i, double d)
+{
+    TraceCall(__FUNCTION__, p, i, d);
+}
+
+static void TraceWriteChunk(int a0, int a1, int a2, int a3, int a4, int a5, int* chunk, int value)
+{
+    TraceCall(__FUNCTION__, a0, a1, a2, a3, a4, a5, value);
+    for (int i = 0; i < 4; ++i)
+        chunk[i] = value + i;
+}
+
+static void TraceReadChunk(const int* chunk)
+{
+    TraceCall(__FUNCTION__, chunk[0], chunk[1], chunk[2], chunk[3]);
+}
+
+// Replaces the pointer in the specified slot like GLStateManager::BindRenderTarget does with the active state manager.
+static void TraceSwapPtr(const void** slot, const void* next)
+{
+    TraceCall(__FUNCTION__, *slot, next);
+    *slot = next;
+}
+
+static void TraceSwapPtrOnStack(int a0, int a1, int a2, int a3, int a4, int a5, const void** slot, const void* next)
+{
+    TraceCall(__FUNCTION__, a0, a1, a2, a3, a4, a5, *slot, next);
+    *slot = next;
+}
+
+struct TraceObject
+{
+    void Call(int a0, int a1, int a2, int a3, int a4, const void* p, std::uint32_t i, double d)
+    {
+        TraceCall(__FUNCTION__, id, a0, a1, a2, a3, a4, p, i, d);
+    }
+    int id;
+};
+
+static const int    g_traceObjectA  = 1;
+static const int    g_traceObjectB  = 2;
+static TraceObject  g_traceObject   = { 42 };
+
+static void ExecuteCallTraceNatively(const void* p, std::uint32_t i, double d)
+{
+    int chunk[4] = {};
+    TraceInts(1, -2, 3, -4, 5, -6, 7, -8);
+    TraceMixed(1.5f, 200, -2.25, 0xBEEF, &g_traceObjectA, 3.75f, 0x123456789ABCDEFull, 1e-3);
+    TraceFloats(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f, 8.5f, 9.5);
+    TraceVarArgs(p, i, d);
+    TraceWriteChunk(1, 2, 3, 4, 5, 6, chunk, 100);
+    TraceInts(-1, -1, -1, -1, -1, -1, -1, -1);
+    TraceReadChunk(chunk);
+    TraceSwapPtr(&p, &g_traceObjectB);
+    TraceVarArgs(p, i, d);
+    TraceSwapPtrOnStack(6, 5, 4, 3, 2, 1, &p, &g_traceObjectA);
+    g_traceObject.Call(1, 2, 3, 4, 5, p, i, d);
+}
+
+static std::unique_ptr<JITProgram> AssembleCallTrace()
+{
+    auto comp = JITCompiler::Create();
+    if (!comp)
+        return nullptr;
+
+    const JITVarArg     p   { 0 };
+    const JITVarArg     i   { 1 };
+    const JITVarArg     d   { 2 };
+    const JITVarArgPtr  pp  { 0 };
+
+    comp->EntryPointVarArgs({ JIT::ArgType::Ptr, JIT::ArgType::DWord, JIT::ArgType::Double });
+    const JITStackPtr chunk{ comp->StackAlloc(sizeof(int)*4) };
+
+    comp->Begin();
+    {
+        comp->Call(TraceInts, 1, -2, 3, -4, 5, -6, 7, -8);
+        comp->Call(TraceMixed, 1.5f, std::uint8_t(200), -2.25, std::uint16_t(0xBEEF), &g_traceObjectA, 3.75f, 0x123456789ABCDEFull, 1e-3);
+        comp->Call(TraceFloats, 0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f, 8.5f, 9.5);
+        comp->Call(TraceVarArgs, p, i, d);
+        comp->Call(TraceWriteChunk, 1, 2, 3, 4, 5, 6, chunk, 100);
+        comp->Call(TraceInts, -1, -1, -1, -1, -1, -1, -1, -1);
+        comp->Call(TraceReadChunk, chunk);
+        comp->Call(TraceSwapPtr, pp, &g_traceObjectB);
+        comp->Call(TraceVarArgs, p, i, d);
+        comp->Call(TraceSwapPtrOnStack, 6, 5, 4, 3, 2, 1, pp, &g_traceObjectA);
+        comp->CallMember(&TraceObject::Call, &g_traceObject, 1, 2, 3, 4, 5, p, i, d);
+    }
+    comp->End();
+
+    return comp->FlushProgram();
+}
+
+LLGL_EXPORT bool TestJIT2()
+{
+    auto prog = AssembleCallTrace();
+    if (!prog)
+    {
+        std::cout << __FUNCTION__ << ": JIT compiler not supported on this architecture" << std::endl;
+        return true;
+    }
+
+    /* Record call trace of native and JIT-compiled execution */
+    g_callTrace.clear();
+    ExecuteCallTraceNatively(&g_traceObjectA, 28, 4.5);
+    const std::string nativeTrace = g_callTrace;
+
+    g_callTrace.clear();
+    prog->GetEntryPoint()(static_cast<const void*>(&g_traceObjectA), std::uint32_t(28), 4.5);
+    const std::string jitTrace = g_callTrace;
+
+    if (nativeTrace != jitTrace)
+    {
+        std::cout << __FUNCTION__ << ": call traces mismatch" << std::endl;
+        std::cout << "native:" << std::endl << nativeTrace;
+        std::cout << "JIT:" << std::endl << jitTrace;
+        return false;
+    }
+
+    std::cout << __FUNCTION__ << ": call traces match" << std::endl;
+    return true;
+}
+
 #endif // /LLGL_DEBUG
 
 
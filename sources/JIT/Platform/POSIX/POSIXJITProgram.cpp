@@ -9,6 +9,7 @@
 #include "../../../Core/Helper.h"
 #include <cstdlib>
 #include <stdexcept>
+#include <string.h>
 #include <unistd.h> // sysconf
 #include <sys/mman.h> // mmap
 
@@ -25,29 +26,39 @@ std::unique_ptr<JITProgram> JITProgram::Create(const void* code, std::size_t siz
 POSIXJITProgram::POSIXJITProgram(const void* code, std::size_t size) :
     size_ { GetAlignedSize(size, std::size_t(sysconf(_SC_PAGE_SIZE))) }
 {
-    /* Map executable memory space */
+    /* Map writable memory space; the memory is never writable and executable at the same time */
     addr_ = ::mmap(
         nullptr,
         size_,
-        (PROT_READ | PROT_WRITE | PROT_EXEC),
+        (PROT_READ | PROT_WRITE),
         (MAP_PRIVATE | MAP_ANONYMOUS),
         -1, // must be -1 if MAP_ANONYMOUS is used
         0
     );
-    
+
     if (addr_ == MAP_FAILED)
-        throw std::runtime_error("failed to map executable virtual memory with read/write protection mode");
-    
-    /* Copy code into executable memory space */
+        throw std::runtime_error("failed to map virtual memory with read/write protection mode");
+
+    /* Copy code into memory space */
     ::memcpy(addr_, code, size);
 
+    /* Synchronize instruction cache with the new code on architectures with incoherent caches (e.g. ARM) */
+    __builtin___clear_cache(reinterpret_cast<char*>(addr_), reinterpret_cast<char*>(addr_) + size);
+
+    /* Make memory space executable */
+    if (::mprotect(addr_, size_, (PROT_READ | PROT_EXEC)) != 0)
+    {
+        ::munmap(addr_, size_);
+        throw std::runtime_error("failed to change virtual memory protection to read/execute mode");
+    }
+
     /* Set function pointer to executable memory address */
     SetEntryPoint(addr_);
 }
 
-POSIXJITProgram::POSIXJITProgram()
+POSIXJITProgram::~POSIXJITProgram()
 {
-    munmap(addr_, size_);
+    ::munmap(addr_, size_);
 }
 
 
@@ -40,6 +40,9 @@ Win32JITProgram::Win32JITProgram(const void* code, std::size_t size) :
     if (VirtualProtect(addr_, size, PAGE_EXECUTE_READ, &oldProtect) == 0)
         throw std::runtime_error("failed to change virtual memory protection");
 
+    /* Ensure the instruction cache does not contain stale data for the new code */
+    FlushInstructionCache(GetCurrentProcess(), addr_, size);
+
     /* Set function pointer to executable memory address */
     SetEntryPoint(addr_);
 }
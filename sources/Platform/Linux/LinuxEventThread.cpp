@@ -0,0 +1,219 @@
+/*
+ * LinuxEventThread.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "LinuxEventThread.h"
+#include "MapKey.h"
+#include <stdexcept>
+#include <chrono>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+
+
+namespace LLGL
+{
+
+
+/*
+ * LinuxEventQueue class
+ */
+
+bool LinuxEventQueue::Push(const LinuxWindowEvent& event)
+{
+    const auto writePos = writePos_.load(std::memory_order_relaxed);
+    if (writePos - readPos_.load(std::memory_order_acquire) == capacity)
+        return false;
+    events_[writePos & (capacity - 1)] = event;
+    writePos_.store(writePos + 1, std::memory_order_release);
+    return true;
+}
+
+bool LinuxEventQueue::Pop(LinuxWindowEvent& outEvent)
+{
+    const auto readPos = readPos_.load(std::memory_order_relaxed);
+    if (readPos == writePos_.load(std::memory_order_acquire))
+        return false;
+    outEvent = events_[readPos & (capacity - 1)];
+    readPos_.store(readPos + 1, std::memory_order_release);
+    return true;
+}
+
+
+/*
+ * LinuxEventThread class
+ */
+
+LinuxEventThread::LinuxEventThread(::Display* display, ::Window wnd, long eventMask, bool grabInput) :
+    wnd_ { wnd }
+{
+    /* Open separate connection to the same X server, because Xlib connections must not be shared between threads without XInitThreads */
+    display_ = XOpenDisplay(DisplayString(display));
+    if (!display_)
+        throw std::runtime_error("failed to open X11 display for event thread");
+
+    if (::pipe(wakeFds_) != 0)
+    {
+        XCloseDisplay(display_);
+        throw std::runtime_error("failed to create pipe for X11 event thread");
+    }
+
+    /* Select input events on this connection; the window must already be mapped to grab the input */
+    XSelectInput(display_, wnd_, eventMask);
+
+    if (grabInput)
+    {
+        XGrabKeyboard(display_, wnd_, True, GrabModeAsync, GrabModeAsync, CurrentTime);
+        XGrabPointer(display_, wnd_, True, ButtonPressMask, GrabModeAsync, GrabModeAsync, wnd_, None, CurrentTime);
+    }
+
+    XFlush(display_);
+
+    thread_ = std::thread{ &LinuxEventThread::Run, this };
+}
+
+LinuxEventThread::~LinuxEventThread()
+{
+    /* Wake up and join event thread */
+    running_ = false;
+    const char signal = 0;
+    const auto result = ::write(wakeFds_[1], &signal, 1);
+    (void)result;
+    thread_.join();
+
+    ::close(wakeFds_[0]);
+    ::close(wakeFds_[1]);
+    XCloseDisplay(display_);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void LinuxEventThread::Run()
+{
+    pollfd fds[2];
+    {
+        fds[0].fd       = ConnectionNumber(display_);
+        fds[0].events   = POLLIN;
+        fds[1].fd       = wakeFds_[0];
+        fds[1].events   = POLLIN;
+    }
+
+    XEvent event;
+
+    while (running_)
+    {
+        /* Translate all events in batches; QueuedAfterReading reads pending events from the connection without blocking */
+        for (int numEvents = XEventsQueued(display_, QueuedAfterReading); numEvents > 0 && running_; numEvents = XEventsQueued(display_, QueuedAfterReading))
+        {
+            while (numEvents-- > 0)
+            {
+                XNextEvent(display_, &event);
+                TranslateEvent(event);
+            }
+        }
+
+        /* Block until new events arrive or the thread is stopped */
+        fds[0].revents = 0;
+        fds[1].revents = 0;
+        if (::poll(fds, 2, -1) < 0 && errno != EINTR)
+            break;
+        if (fds[1].revents != 0 || (fds[0].revents & (POLLERR | POLLHUP)) != 0)
+            break;
+    }
+}
+
+void LinuxEventThread::TranslateEvent(XEvent& event)
+{
+    LinuxWindowEvent windowEvent;
+
+    switch (event.type)
+    {
+        case KeyPress:
+            PostKeyEvent(LinuxWindowEvent::Type::KeyDown, MapKey(event.xkey));
+            break;
+
+        case KeyRelease:
+            PostKeyEvent(LinuxWindowEvent::Type::KeyUp, MapKey(event.xkey));
+            break;
+
+        case ButtonPress:
+        case ButtonRelease:
+        {
+            const auto keyType = (event.type == ButtonPress ? LinuxWindowEvent::Type::KeyDown : LinuxWindowEvent::Type::KeyUp);
+            switch (event.xbutton.button)
+            {
+                case Button1:
+                    PostKeyEvent(keyType, Key::LButton);
+                    break;
+                case Button2:
+                    PostKeyEvent(keyType, Key::MButton);
+                    break;
+                case Button3:
+                    PostKeyEvent(keyType, Key::RButton);
+                    break;
+                case Button4:
+                case Button5:
+                {
+                    if (event.type == ButtonPress)
+                    {
+                        windowEvent.type    = LinuxWindowEvent::Type::WheelMotion;
+                        windowEvent.motion  = { 0, (event.xbutton.button == Button4 ? 1 : -1) };
+                        PostEvent(windowEvent);
+                    }
+                }
+                break;
+            }
+        }
+        break;
+
+        case Expose:
+        {
+            XWindowAttributes attribs;
+            XGetWindowAttributes(display_, wnd_, &attribs);
+            windowEvent.type    = LinuxWindowEvent::Type::Resize;
+            windowEvent.size    = { static_cast<std::uint32_t>(attribs.width), static_cast<std::uint32_t>(attribs.height) };
+            PostEvent(windowEvent);
+        }
+        break;
+
+        case MotionNotify:
+        {
+            windowEvent.type    = LinuxWindowEvent::Type::LocalMotion;
+            windowEvent.motion  = { event.xmotion.x, event.xmotion.y };
+            PostEvent(windowEvent);
+        }
+        break;
+    }
+}
+
+void LinuxEventThread::PostEvent(const LinuxWindowEvent& event)
+{
+    /* Wait until the window thread has consumed enough events; this only blocks the event thread, never the window thread */
+    while (!queue_.Push(event))
+    {
+        if (!running_)
+            return;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void LinuxEventThread::PostKeyEvent(LinuxWindowEvent::Type type, Key key)
+{
+    LinuxWindowEvent windowEvent;
+    windowEvent.type    = type;
+    windowEvent.key     = key;
+    PostEvent(windowEvent);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,118 @@
+/*
+ * LinuxEventThread.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_LINUX_EVENT_THREAD_H
+#define LLGL_LINUX_EVENT_THREAD_H
+
+
+#include <LLGL/Key.h>
+#include <LLGL/Types.h>
+#include <X11/Xlib.h>
+#include <atomic>
+#include <thread>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+// Compact window event that is recorded by the event thread and dispatched to the window event listeners on the thread that owns the window.
+struct LinuxWindowEvent
+{
+    enum class Type : std::uint8_t
+    {
+        KeyDown,
+        KeyUp,
+        WheelMotion,    // Wheel motion in 'motion.y'
+        LocalMotion,    // Local mouse position in 'motion'
+        Resize,         // Content size in 'size'
+    };
+
+    Type        type    = Type::KeyDown;
+    Key         key     = Key::Any;
+    Offset2D    motion;
+    Extent2D    size;
+};
+
+/*
+Single-producer/single-consumer lock-free ring buffer for window events.
+The event thread is the only producer and the thread that owns the window is the only consumer.
+*/
+class LinuxEventQueue
+{
+
+    public:
+
+        // Pushes the specified event into the queue. Returns false if the queue is full.
+        bool Push(const LinuxWindowEvent& event);
+
+        // Pops the next event from the queue. Returns false if the queue is empty.
+        bool Pop(LinuxWindowEvent& outEvent);
+
+    private:
+
+        static constexpr std::size_t capacity = 1024; // Must be a power of two
+
+        LinuxWindowEvent            events_[capacity];
+        std::atomic<std::size_t>    readPos_    { 0 };
+        std::atomic<std::size_t>    writePos_   { 0 };
+
+};
+
+/*
+Dedicated thread to pump the input events of an X11 window.
+The thread uses its own connection to the X server, so it never shares the Xlib display with the render thread,
+and blocks on that connection until new events arrive. All events are translated into LinuxWindowEvent entries.
+*/
+class LinuxEventThread
+{
+
+    public:
+
+        LinuxEventThread(const LinuxEventThread&) = delete;
+        LinuxEventThread& operator = (const LinuxEventThread&) = delete;
+
+        // Opens a new connection to the X server of the specified display and selects the input events of the specified window.
+        LinuxEventThread(::Display* display, ::Window wnd, long eventMask, bool grabInput);
+        ~LinuxEventThread();
+
+        // Pops the next event that has been recorded by the event thread. Returns false if there are no more events.
+        inline bool PollEvent(LinuxWindowEvent& outEvent)
+        {
+            return queue_.Pop(outEvent);
+        }
+
+    private:
+
+        void Run();
+
+        void TranslateEvent(XEvent& event);
+        void PostEvent(const LinuxWindowEvent& event);
+        void PostKeyEvent(LinuxWindowEvent::Type type, Key key);
+
+    private:
+
+        ::Display*          display_        = nullptr;
+        ::Window            wnd_;
+        int                 wakeFds_[2]     = { -1, -1 }; // Pipe to wake up the event thread when it's stopped
+        std::atomic<bool>   running_        { true };
+        LinuxEventQueue     queue_;
+        std::thread         thread_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
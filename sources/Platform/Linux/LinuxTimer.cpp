@@ -7,6 +7,7 @@
 
 #include <LLGL/Timer.h>
 #include <time.h>
+#include <errno.h>
 
 
 namespace LLGL
@@ -35,6 +36,19 @@ LLGL_EXPORT std::uint64_t Tick()
     return MonotonicTimeToUInt64(t);
 }
 
+LLGL_EXPORT void WaitUntil(std::uint64_t tick)
+{
+    timespec t;
+    t.tv_sec    = static_cast<time_t>(tick / g_nsecFrequency);
+    t.tv_nsec   = static_cast<long>(tick % g_nsecFrequency);
+
+    /* Sleep on absolute time, so interruptions by signals don't accumulate any drift */
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &t, nullptr) == EINTR)
+    {
+        // continue sleeping
+    }
+}
+
 
 } // /namespace Timer
 
@@ -44,6 +44,7 @@ LinuxWindow::LinuxWindow(const WindowDescriptor& desc) :
 
 LinuxWindow::~LinuxWindow()
 {
+    eventThread_.reset();
     XDestroyWindow(display_, wnd_);
     XCloseDisplay(display_);
 }
@@ -146,11 +147,21 @@ WindowDescriptor LinuxWindow::GetDesc() const
 
 void LinuxWindow::OnProcessEvents()
 {
-    XEvent event;
+    /* Dispatch all input events that have been recorded by the event thread */
+    if (eventThread_)
+    {
+        LinuxWindowEvent queuedEvent;
+        while (eventThread_->PollEvent(queuedEvent))
+            PostQueuedEvent(queuedEvent);
+    }
 
-    XPending(display_);
+    /*
+    Process a single batch of events: QueuedAfterReading reads the pending events from the connection without flushing its output buffer,
+    and events that arrive while this batch is processed are deferred to the next call, so this never waits for the X server
+    */
+    XEvent event;
 
-    while (XQLength(display_))
+    for (int numEvents = XEventsQueued(display_, QueuedAfterReading); numEvents > 0; --numEvents)
     {
         XNextEvent(display_, &event);
 
@@ -229,7 +240,10 @@ void LinuxWindow::OpenWindow()
     XSetWindowAttributes attribs;
     attribs.background_pixel    = WhitePixel(display_, screen);
     attribs.border_pixel        = 0;
-    attribs.event_mask          = (ExposureMask | KeyPressMask | KeyReleaseMask | ButtonPressMask | ButtonReleaseMask | PointerMotionMask);
+    const long inputEventMask   = (ExposureMask | KeyPressMask | KeyReleaseMask | ButtonPressMask | ButtonReleaseMask | PointerMotionMask);
+
+    /* Input events are only selected by the connection of the event thread, if enabled */
+    attribs.event_mask          = (desc_.threadedEvents ? NoEventMask : inputEventMask);
 
     unsigned long valueMask     = CWEventMask | CWBorderPixel;//(CWColormap | CWEventMask | CWOverrideRedirect)
 
@@ -274,9 +288,14 @@ void LinuxWindow::OpenWindow()
     if (desc_.visible)
         Show();
 
-    /* Prepare borderless window */
-    if (desc_.borderless)
+    if (desc_.threadedEvents)
     {
+        /* Start event thread; borderless windows grab the input on the connection of the event thread */
+        eventThread_ = MakeUnique<LinuxEventThread>(display_, wnd_, inputEventMask, desc_.borderless);
+    }
+    else if (desc_.borderless)
+    {
+        /* Prepare borderless window */
         XGrabKeyboard(display_, wnd_, True, GrabModeAsync, GrabModeAsync, CurrentTime);
         XGrabPointer(display_, wnd_, True, ButtonPressMask, GrabModeAsync, GrabModeAsync, wnd_, None, CurrentTime);
     }
@@ -354,6 +373,36 @@ void LinuxWindow::PostMouseKeyEvent(Key key, bool down)
         PostKeyUp(key);
 }
 
+void LinuxWindow::PostQueuedEvent(const LinuxWindowEvent& event)
+{
+    switch (event.type)
+    {
+        case LinuxWindowEvent::Type::KeyDown:
+            PostKeyDown(event.key);
+            break;
+
+        case LinuxWindowEvent::Type::KeyUp:
+            PostKeyUp(event.key);
+            break;
+
+        case LinuxWindowEvent::Type::WheelMotion:
+            PostWheelMotion(event.motion.y);
+            break;
+
+        case LinuxWindowEvent::Type::LocalMotion:
+        {
+            PostLocalMotion(event.motion);
+            PostGlobalMotion({ event.motion.x - prevMousePos_.x, event.motion.y - prevMousePos_.y });
+            prevMousePos_ = event.motion;
+        }
+        break;
+
+        case LinuxWindowEvent::Type::Resize:
+            PostResize(event.size);
+            break;
+    }
+}
+
 
 } // /namespace LLGL
 
@@ -11,6 +11,8 @@
 
 #include <LLGL/Window.h>
 #include <X11/Xlib.h>
+#include <memory>
+#include "LinuxEventThread.h"
 
 
 namespace LLGL
@@ -59,7 +61,8 @@ class LinuxWindow : public Window
         void ProcessMotionEvent(XMotionEvent& event);
 
         void PostMouseKeyEvent(Key key, bool down);
-        
+        void PostQueuedEvent(const LinuxWindowEvent& event);
+
     private:
     
         WindowDescriptor    desc_;
@@ -74,6 +77,8 @@ class LinuxWindow : public Window
         
         Offset2D            prevMousePos_;
 
+        std::unique_ptr<LinuxEventThread> eventThread_; // Optional event thread if WindowDescriptor::threadedEvents is enabled
+
 };
 
 
@@ -81,6 +81,48 @@ LLGL_EXPORT std::uint64_t Tick()
     return highResTick.QuadPart;
 }
 
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+// Waitable timer of the calling thread; high resolution timers require Windows 10 1803, otherwise a regular waitable timer is used.
+struct Win32WaitableTimer
+{
+    Win32WaitableTimer()
+    {
+        handle = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+        if (handle == nullptr)
+            handle = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+    }
+
+    ~Win32WaitableTimer()
+    {
+        if (handle != nullptr)
+            CloseHandle(handle);
+    }
+
+    HANDLE handle = nullptr;
+};
+
+LLGL_EXPORT void WaitUntil(std::uint64_t tick)
+{
+    const std::uint64_t currentTick = Tick();
+    if (tick <= currentTick)
+        return;
+
+    /* Convert remaining ticks into relative 100-nanosecond intervals (negative values denote relative time) */
+    const std::uint64_t frequency = Frequency();
+    const std::uint64_t remainingTicks = tick - currentTick;
+    LARGE_INTEGER dueTime;
+    dueTime.QuadPart = -static_cast<LONGLONG>((remainingTicks / frequency) * 10000000ull + (remainingTicks % frequency) * 10000000ull / frequency);
+
+    static thread_local Win32WaitableTimer timer;
+    if (timer.handle != nullptr && SetWaitableTimer(timer.handle, &dueTime, 0, nullptr, nullptr, FALSE) != FALSE)
+        WaitForSingleObject(timer.handle, INFINITE);
+    else
+        Sleep(static_cast<DWORD>(remainingTicks * 1000ull / frequency));
+}
+
 
 } // /namespace Timer
 
@@ -7,9 +7,11 @@
 
 #include "Win32Window.h"
 #include "Win32WindowClass.h"
+#include "Win32WindowCallback.h"
 #include "../../Core/Helper.h"
 #include <LLGL/Platform/NativeHandle.h>
 #include <LLGL/Platform/Platform.h>
+#include <LLGL/Timer.h>
 
 
 namespace LLGL
@@ -351,6 +353,57 @@ void Win32Window::OnProcessEvents()
     }
 }
 
+#ifndef _WIN64
+
+static bool IsWow64()
+{
+    static const bool isWow64 = []() -> bool
+    {
+        BOOL result = FALSE;
+        return (IsWow64Process(GetCurrentProcess(), &result) != FALSE && result != FALSE);
+    }();
+    return isWow64;
+}
+
+#endif // /_WIN64
+
+void Win32Window::OnPollRawInput()
+{
+    /* All events of one batch share the same timestamp, since GetRawInputBuffer does not provide the arrival time */
+    const auto timestamp = Timer::Tick();
+
+    /* Read raw input in batches; the buffer must be aligned to 8 bytes for the RAWINPUT blocks */
+    static constexpr UINT maxBatchSize = 16;
+    alignas(8) RAWINPUT batch[maxBatchSize];
+
+    for (;;)
+    {
+        UINT batchSize = sizeof(batch);
+        UINT numInputs = GetRawInputBuffer(batch, &batchSize, sizeof(RAWINPUTHEADER));
+        if (numInputs == 0 || numInputs == static_cast<UINT>(-1))
+            break;
+
+        const RAWINPUT* raw = batch;
+        for (UINT i = 0; i < numInputs; ++i)
+        {
+            if (raw->header.dwType == RIM_TYPEMOUSE)
+            {
+                #ifndef _WIN64
+                /* 32-bit processes on a 64-bit OS (WOW64) receive the data with a 64-bit aligned header */
+                if (IsWow64())
+                {
+                    const auto* mouse = reinterpret_cast<const RAWMOUSE*>(reinterpret_cast<const BYTE*>(&raw->data.mouse) + 8);
+                    Win32PostRawMouseInput(*this, *mouse, timestamp);
+                }
+                else
+                #endif
+                Win32PostRawMouseInput(*this, raw->data.mouse, timestamp);
+            }
+            raw = NEXTRAWINPUTBLOCK(raw);
+        }
+    }
+}
+
 
 /*
  * ======= Private: =======
@@ -50,6 +50,7 @@ class Win32Window final : public Window
     private:
 
         void OnProcessEvents() override;
+        void OnPollRawInput() override;
 
         HWND CreateWindowHandle(const WindowDescriptor& desc);
 
@@ -8,6 +8,7 @@
 #include "Win32WindowCallback.h"
 #include "Win32Window.h"
 #include "MapKey.h"
+#include <LLGL/Timer.h>
 
 #include <windowsx.h>
 
@@ -150,28 +151,46 @@ static void PostGlobalMouseMotion(HWND wnd, LPARAM lParam)
     /* Get window object from window handle */
     if (auto window = GetWindowFromUserData(wnd))
     {
+        /* Take timestamp as early as possible to keep it close to the time the input arrived */
+        const auto timestamp = Timer::Tick();
+
         RAWINPUT raw;
         UINT rawSize = sizeof(raw);
 
-        GetRawInputData(
+        auto result = GetRawInputData(
             reinterpret_cast<HRAWINPUT>(lParam), RID_INPUT,
             &raw, &rawSize, sizeof(RAWINPUTHEADER)
         );
 
-        if (raw.header.dwType == RIM_TYPEMOUSE)
-        {
-            const auto& mouse = raw.data.mouse;
+        if (result != static_cast<UINT>(-1) && raw.header.dwType == RIM_TYPEMOUSE)
+            Win32PostRawMouseInput(*window, raw.data.mouse, timestamp);
+    }
+}
 
-            if (mouse.usFlags == MOUSE_MOVE_RELATIVE)
-            {
-                /* Post global mouse motion event */
-                int dx = mouse.lLastX;
-                int dy = mouse.lLastY;
 
-                window->PostGlobalMotion({ dx, dy });
-            }
-        }
+/* --- Global functions --- */
+
+void Win32PostRawMouseInput(Window& window, const RAWMOUSE& mouse, std::uint64_t timestamp)
+{
+    RawMouseEvent event;
+    event.timestamp = timestamp;
+
+    if (mouse.usFlags == MOUSE_MOVE_RELATIVE)
+    {
+        event.motion.x = mouse.lLastX;
+        event.motion.y = mouse.lLastY;
     }
+
+    if ((mouse.usButtonFlags & RI_MOUSE_WHEEL) != 0)
+        event.wheelMotion = static_cast<SHORT>(mouse.usButtonData) / WHEEL_DELTA;
+
+    /* Store event in raw input buffer */
+    if (event.motion.x != 0 || event.motion.y != 0 || event.wheelMotion != 0)
+        window.PostRawMouseEvent(event);
+
+    /* Post global mouse motion event (wheel motion is already posted by WM_MOUSEWHEEL) */
+    if (event.motion.x != 0 || event.motion.y != 0)
+        window.PostGlobalMotion(event.motion);
 }
 
 
@@ -10,6 +10,7 @@
 
 
 #include <Windows.h>
+#include <cstdint>
 
 
 namespace LLGL
@@ -19,6 +20,11 @@ namespace LLGL
 // Primary callback for Win32 window events.
 LRESULT CALLBACK Win32WindowCallback(HWND wnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
+class Window;
+
+// Posts the specified raw mouse input to the window's raw input buffer and its global motion event listeners.
+void Win32PostRawMouseInput(Window& window, const RAWMOUSE& mouse, std::uint64_t timestamp);
+
 
 } // /namespace LLGL
 
@@ -7,6 +7,7 @@
 
 #include <LLGL/Window.h>
 #include "../Core/Helper.h"
+#include <algorithm>
 
 
 namespace LLGL
@@ -93,6 +94,12 @@ struct Window::Pimpl
     WindowBehavior                              behavior;
     bool                                        quit            = false;
     bool                                        focus           = false;
+
+    /* Fixed-capacity ring buffer for raw mouse input; oldest entries are overwritten when full */
+    static constexpr std::size_t                maxRawEvents    = 256;
+    RawMouseEvent                               rawEvents[maxRawEvents];
+    std::size_t                                 rawEventsFirst  = 0;
+    std::size_t                                 rawEventsCount  = 0;
 };
 
 
@@ -304,6 +311,48 @@ void Window::PostTimer(std::uint32_t timerID)
     FOREACH_LISTENER_CALL( OnTimer(*this, timerID) );
 }
 
+void Window::PostRawMouseEvent(const RawMouseEvent& event)
+{
+    auto& pimpl = *pimpl_;
+    const auto index = (pimpl.rawEventsFirst + pimpl.rawEventsCount) % Pimpl::maxRawEvents;
+    pimpl.rawEvents[index] = event;
+    if (pimpl.rawEventsCount < Pimpl::maxRawEvents)
+        ++pimpl.rawEventsCount;
+    else
+        pimpl.rawEventsFirst = (pimpl.rawEventsFirst + 1) % Pimpl::maxRawEvents;
+}
+
+std::size_t Window::ReadRawMouseEvents(RawMouseEvent* outEvents, std::size_t maxEvents)
+{
+    /* Poll pending raw input from the platform first */
+    OnPollRawInput();
+
+    auto& pimpl = *pimpl_;
+    if (outEvents == nullptr)
+        return pimpl.rawEventsCount;
+
+    /* Copy events in chronological order and remove them from the ring buffer */
+    const auto numEvents = std::min(maxEvents, pimpl.rawEventsCount);
+    for (std::size_t i = 0; i < numEvents; ++i)
+    {
+        outEvents[i] = pimpl.rawEvents[pimpl.rawEventsFirst];
+        pimpl.rawEventsFirst = (pimpl.rawEventsFirst + 1) % Pimpl::maxRawEvents;
+    }
+    pimpl.rawEventsCount -= numEvents;
+
+    return numEvents;
+}
+
+
+/*
+ * ======= Protected: =======
+ */
+
+void Window::OnPollRawInput()
+{
+    // dummy
+}
+
 #undef FOREACH_LISTENER_CALL
 
 
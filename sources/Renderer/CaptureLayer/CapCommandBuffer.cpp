@@ -0,0 +1,820 @@
+/*
+ * CapCommandBuffer.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "CapCommandBuffer.h"
+#include "CapSwapChain.h"
+#include "CapSerialization.h"
+#include "../CheckedCast.h"
+
+
+namespace LLGL
+{
+
+
+/*
+~~~~~~ INFO ~~~~~~
+This is the capture layer command buffer.
+Each command is written into the capture file as a single segment that starts with the capture ID of this command buffer,
+so commands of command buffers that are encoded on different threads can be interleaved in the capture file.
+All commands are then forwarded to the actual command buffer, which is stored in the member named "instance".
+*/
+
+CapCommandBuffer::CapCommandBuffer(CommandBuffer& instance, CapWriter& writer) :
+    instance { instance },
+    writer_  { writer   }
+{
+}
+
+void CapCommandBuffer::SetName(const char* name)
+{
+    instance.SetName(name);
+}
+
+/* ----- Encoding ----- */
+
+void CapCommandBuffer::Begin()
+{
+    {
+        CapCall call{ writer_, CapIdent_Begin, this };
+    }
+    instance.Begin();
+}
+
+void CapCommandBuffer::End()
+{
+    {
+        CapCall call{ writer_, CapIdent_End, this };
+    }
+    instance.End();
+}
+
+std::uint32_t CapCommandBuffer::QueryBeginStalls()
+{
+    return instance.QueryBeginStalls();
+}
+
+void CapCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
+{
+    {
+        CapCall call{ writer_, CapIdent_Execute, this };
+        call.WriteObject(&deferredCommandBuffer);
+    }
+    instance.Execute(LLGL_CAST(CapCommandBuffer&, deferredCommandBuffer).instance);
+}
+
+/* ----- Blitting ----- */
+
+void CapCommandBuffer::UpdateBuffer(
+    Buffer&         dstBuffer,
+    std::uint64_t   dstOffset,
+    const void*     data,
+    std::uint16_t   dataSize)
+{
+    {
+        CapCall call{ writer_, CapIdent_UpdateBuffer, this };
+        call.WriteObject(&dstBuffer);
+        call.Write(dstOffset);
+        call.WriteData(data, dataSize);
+    }
+    instance.UpdateBuffer(dstBuffer, dstOffset, data, dataSize);
+}
+
+void CapCommandBuffer::UpdateBuffer(
+    Buffer&                     dstBuffer,
+    std::uint32_t               numRegions,
+    const BufferWriteRegion*    regions)
+{
+    {
+        CapCall call{ writer_, CapIdent_UpdateBufferRegions, this };
+        call.WriteObject(&dstBuffer);
+        call.Write(numRegions);
+        for (std::uint32_t i = 0; i < numRegions; ++i)
+        {
+            call.Write(regions[i].dstOffset);
+            call.WriteData(regions[i].data, static_cast<std::size_t>(regions[i].dataSize));
+        }
+    }
+    instance.UpdateBuffer(dstBuffer, numRegions, regions);
+}
+
+void CapCommandBuffer::CopyBuffer(
+    Buffer&         dstBuffer,
+    std::uint64_t   dstOffset,
+    Buffer&         srcBuffer,
+    std::uint64_t   srcOffset,
+    std::uint64_t   size)
+{
+    {
+        CapCall call{ writer_, CapIdent_CopyBuffer, this };
+        call.WriteObject(&dstBuffer);
+        call.Write(dstOffset);
+        call.WriteObject(&srcBuffer);
+        call.Write(srcOffset, size);
+    }
+    instance.CopyBuffer(dstBuffer, dstOffset, srcBuffer, srcOffset, size);
+}
+
+void CapCommandBuffer::CopyBuffer(
+    Buffer&                     dstBuffer,
+    Buffer&                     srcBuffer,
+    std::uint32_t               numRegions,
+    const BufferCopyRegion*     regions)
+{
+    {
+        CapCall call{ writer_, CapIdent_CopyBufferRegions, this };
+        call.WriteObject(&dstBuffer);
+        call.WriteObject(&srcBuffer);
+        call.WriteArray(regions, numRegions);
+    }
+    instance.CopyBuffer(dstBuffer, srcBuffer, numRegions, regions);
+}
+
+void CapCommandBuffer::CopyBufferFromTexture(
+    Buffer&                 dstBuffer,
+    std::uint64_t           dstOffset,
+    Texture&                srcTexture,
+    const TextureRegion&    srcRegion,
+    std::uint32_t           rowStride,
+    std::uint32_t           layerStride)
+{
+    {
+        CapCall call{ writer_, CapIdent_CopyBufferFromTexture, this };
+        call.WriteObject(&dstBuffer);
+        call.Write(dstOffset);
+        call.WriteObject(&srcTexture);
+        call.Write(srcRegion, rowStride, layerStride);
+    }
+    instance.CopyBufferFromTexture(dstBuffer, dstOffset, srcTexture, srcRegion, rowStride, layerStride);
+}
+
+std::uint64_t CapCommandBuffer::CopyBufferToReadback(Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size)
+{
+    /* Same as ReadBuffer: readbacks only produce data for the client, so they are not captured */
+    return instance.CopyBufferToReadback(srcBuffer, srcOffset, size);
+}
+
+std::uint64_t CapCommandBuffer::CopyTextureToReadback(Texture& srcTexture, const TextureRegion& srcRegion)
+{
+    /* Same as ReadTexture: readbacks only produce data for the client, so they are not captured */
+    return instance.CopyTextureToReadback(srcTexture, srcRegion);
+}
+
+void CapCommandBuffer::FillBuffer(
+    Buffer&         dstBuffer,
+    std::uint64_t   dstOffset,
+    std::uint32_t   value,
+    std::uint64_t   fillSize)
+{
+    {
+        CapCall call{ writer_, CapIdent_FillBuffer, this };
+        call.WriteObject(&dstBuffer);
+        call.Write(dstOffset, value, fillSize);
+    }
+    instance.FillBuffer(dstBuffer, dstOffset, value, fillSize);
+}
+
+void CapCommandBuffer::CopyTexture(
+    Texture&                dstTexture,
+    const TextureLocation&  dstLocation,
+    Texture&                srcTexture,
+    const TextureLocation&  srcLocation,
+    const Extent3D&         extent)
+{
+    {
+        CapCall call{ writer_, CapIdent_CopyTexture, this };
+        call.WriteObject(&dstTexture);
+        call.Write(dstLocation);
+        call.WriteObject(&srcTexture);
+        call.Write(srcLocation, extent);
+    }
+    instance.CopyTexture(dstTexture, dstLocation, srcTexture, srcLocation, extent);
+}
+
+void CapCommandBuffer::CopyTexture(
+    Texture&                    dstTexture,
+    Texture&                    srcTexture,
+    std::uint32_t               numRegions,
+    const TextureCopyRegion*    regions)
+{
+    {
+        CapCall call{ writer_, CapIdent_CopyTextureRegions, this };
+        call.WriteObject(&dstTexture);
+        call.WriteObject(&srcTexture);
+        call.WriteArray(regions, numRegions);
+    }
+    instance.CopyTexture(dstTexture, srcTexture, numRegions, regions);
+}
+
+void CapCommandBuffer::CopyTextureFromBuffer(
+    Texture&                dstTexture,
+    const TextureRegion&    dstRegion,
+    Buffer&                 srcBuffer,
+    std::uint64_t           srcOffset,
+    std::uint32_t           rowStride,
+    std::uint32_t           layerStride)
+{
+    {
+        CapCall call{ writer_, CapIdent_CopyTextureFromBuffer, this };
+        call.WriteObject(&dstTexture);
+        call.Write(dstRegion);
+        call.WriteObject(&srcBuffer);
+        call.Write(srcOffset, rowStride, layerStride);
+    }
+    instance.CopyTextureFromBuffer(dstTexture, dstRegion, srcBuffer, srcOffset, rowStride, layerStride);
+}
+
+void CapCommandBuffer::GenerateMips(Texture& texture)
+{
+    {
+        CapCall call{ writer_, CapIdent_GenerateMips, this };
+        call.WriteObject(&texture);
+    }
+    instance.GenerateMips(texture);
+}
+
+void CapCommandBuffer::GenerateMips(Texture& texture, const TextureSubresource& subresource)
+{
+    {
+        CapCall call{ writer_, CapIdent_GenerateMipsRange, this };
+        call.WriteObject(&texture);
+        call.Write(subresource);
+    }
+    instance.GenerateMips(texture, subresource);
+}
+
+/* ----- Viewport and Scissor ----- */
+
+void CapCommandBuffer::SetViewport(const Viewport& viewport)
+{
+    {
+        CapCall call{ writer_, CapIdent_SetViewports, this };
+        call.WriteArray(&viewport, 1);
+    }
+    instance.SetViewport(viewport);
+}
+
+void CapCommandBuffer::SetViewports(std::uint32_t numViewports, const Viewport* viewports)
+{
+    {
+        CapCall call{ writer_, CapIdent_SetViewports, this };
+        call.WriteArray(viewports, numViewports);
+    }
+    instance.SetViewports(numViewports, viewports);
+}
+
+void CapCommandBuffer::SetScissor(const Scissor& scissor)
+{
+    {
+        CapCall call{ writer_, CapIdent_SetScissors, this };
+        call.WriteArray(&scissor, 1);
+    }
+    instance.SetScissor(scissor);
+}
+
+void CapCommandBuffer::SetScissors(std::uint32_t numScissors, const Scissor* scissors)
+{
+    {
+        CapCall call{ writer_, CapIdent_SetScissors, this };
+        call.WriteArray(scissors, numScissors);
+    }
+    instance.SetScissors(numScissors, scissors);
+}
+
+/* ----- Input Assembly ------ */
+
+void CapCommandBuffer::SetVertexBuffer(Buffer& buffer)
+{
+    {
+        CapCall call{ writer_, CapIdent_SetVertexBuffer, this };
+        call.WriteObject(&buffer);
+    }
+    instance.SetVertexBuffer(buffer);
+}
+
+void CapCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
+{
+    {
+        CapCall call{ writer_, CapIdent_SetVertexBufferArray, this };
+        call.WriteObject(&bufferArray);
+    }
+    instance.SetVertexBufferArray(bufferArray);
+}
+
+void CapCommandBuffer::SetIndexBuffer(Buffer& buffer)
+{
+    {
+        CapCall call{ writer_, CapIdent_SetIndexBuffer, this };
+        call.WriteObject(&buffer);
+    }
+    instance.SetIndexBuffer(buffer);
+}
+
+void CapCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::uint64_t offset)
+{
+    {
+        CapCall call{ writer_, CapIdent_SetIndexBufferFormat, this };
+        call.WriteObject(&buffer);
+        call.Write(format, offset);
+    }
+    instance.SetIndexBuffer(buffer, format, offset);
+}
+
+/* ----- Resources ----- */
+
+void CapCommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap, std::uint32_t descriptorSet, const PipelineBindPoint bindPoint)
+{
+    {
+        CapCall call{ writer_, CapIdent_SetResourceHeap, this };
+        call.WriteObject(&resourceHeap);
+        call.Write(descriptorSet, bindPoint);
+        call.WriteArray(static_cast<const std::uint32_t*>(nullptr), 0);
+    }
+    instance.SetResourceHeap(resourceHeap, descriptorSet, bindPoint);
+}
+
+void CapCommandBuffer::SetResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           descriptorSet,
+    std::uint32_t           numDynamicOffsets,
+    const std::uint32_t*    dynamicOffsets,
+    const PipelineBindPoint bindPoint)
+{
+    {
+        CapCall call{ writer_, CapIdent_SetResourceHeap, this };
+        call.WriteObject(&resourceHeap);
+        call.Write(descriptorSet, bindPoint);
+        call.WriteArray(dynamicOffsets, numDynamicOffsets);
+    }
+    instance.SetResourceHeap(resourceHeap, descriptorSet, numDynamicOffsets, dynamicOffsets, bindPoint);
+}
+
+void CapCommandBuffer::SetResource(Resource& resource, std::uint32_t slot, long bindFlags, long stageFlags)
+{
+    {
+        CapCall call{ writer_, CapIdent_SetResource, this };
+        call.WriteObject(&resource);
+        call.Write(slot, bindFlags, stageFlags);
+    }
+    instance.SetResource(resource, slot, bindFlags, stageFlags);
+}
+
+void CapCommandBuffer::ResetResourceSlots(
+    const ResourceType  resourceType,
+    std::uint32_t       firstSlot,
+    std::uint32_t       numSlots,
+    long                bindFlags,
+    long                stageFlags)
+{
+    {
+        CapCall call{ writer_, CapIdent_ResetResourceSlots, this };
+        call.Write(resourceType, firstSlot, numSlots, bindFlags, stageFlags);
+    }
+    instance.ResetResourceSlots(resourceType, firstSlot, numSlots, bindFlags, stageFlags);
+}
+
+/* ----- Render Passes ----- */
+
+void CapCommandBuffer::BeginRenderPass(
+    RenderTarget&       renderTarget,
+    const RenderPass*   renderPass,
+    std::uint32_t       numClearValues,
+    const ClearValue*   clearValues)
+{
+    {
+        CapCall call{ writer_, CapIdent_BeginRenderPass, this };
+        call.WriteObject(&renderTarget);
+        call.WriteObject(renderPass);
+        call.WriteArray(clearValues, numClearValues);
+    }
+    instance.BeginRenderPass(*GetCapRenderTargetInstance(&renderTarget), renderPass, numClearValues, clearValues);
+}
+
+void CapCommandBuffer::EndRenderPass()
+{
+    {
+        CapCall call{ writer_, CapIdent_EndRenderPass, this };
+    }
+    instance.EndRenderPass();
+}
+
+void CapCommandBuffer::NextSubpass()
+{
+    {
+        CapCall call{ writer_, CapIdent_NextSubpass, this };
+    }
+    instance.NextSubpass();
+}
+
+void CapCommandBuffer::Clear(long flags, const ClearValue& clearValue)
+{
+    {
+        CapCall call{ writer_, CapIdent_Clear, this };
+        call.Write(flags, clearValue);
+    }
+    instance.Clear(flags, clearValue);
+}
+
+void CapCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
+{
+    {
+        CapCall call{ writer_, CapIdent_ClearAttachments, this };
+        call.WriteArray(attachments, numAttachments);
+    }
+    instance.ClearAttachments(numAttachments, attachments);
+}
+
+/* ----- Pipeline States ----- */
+
+void CapCommandBuffer::SetPipelineState(PipelineState& pipelineState)
+{
+    {
+        CapCall call{ writer_, CapIdent_SetPipelineState, this };
+        call.WriteObject(&pipelineState);
+    }
+    instance.SetPipelineState(pipelineState);
+}
+
+void CapCommandBuffer::SetBlendFactor(const ColorRGBAf& color)
+{
+    {
+        CapCall call{ writer_, CapIdent_SetBlendFactor, this };
+        call.Write(color);
+    }
+    instance.SetBlendFactor(color);
+}
+
+void CapCommandBuffer::SetStencilReference(std::uint32_t reference, const StencilFace stencilFace)
+{
+    {
+        CapCall call{ writer_, CapIdent_SetStencilReference, this };
+        call.Write(reference, stencilFace);
+    }
+    instance.SetStencilReference(reference, stencilFace);
+}
+
+void CapCommandBuffer::SetShadingRate(const ShadingRate rate)
+{
+    {
+        CapCall call{ writer_, CapIdent_SetShadingRate, this };
+        call.Write(rate);
+    }
+    instance.SetShadingRate(rate);
+}
+
+void CapCommandBuffer::SetUniform(
+    UniformLocation location,
+    const void*     data,
+    std::uint32_t   dataSize)
+{
+    {
+        CapCall call{ writer_, CapIdent_SetUniforms, this };
+        call.Write(location, std::uint32_t(1));
+        call.WriteData(data, dataSize);
+    }
+    instance.SetUniform(location, data, dataSize);
+}
+
+void CapCommandBuffer::SetUniforms(
+    UniformLocation location,
+    std::uint32_t   count,
+    const void*     data,
+    std::uint32_t   dataSize)
+{
+    {
+        CapCall call{ writer_, CapIdent_SetUniforms, this };
+        call.Write(location, count);
+        call.WriteData(data, dataSize);
+    }
+    instance.SetUniforms(location, count, data, dataSize);
+}
+
+/* ----- Queries ----- */
+
+void CapCommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
+{
+    {
+        CapCall call{ writer_, CapIdent_BeginQuery, this };
+        call.WriteObject(&queryHeap);
+        call.Write(query);
+    }
+    instance.BeginQuery(queryHeap, query);
+}
+
+void CapCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
+{
+    {
+        CapCall call{ writer_, CapIdent_EndQuery, this };
+        call.WriteObject(&queryHeap);
+        call.Write(query);
+    }
+    instance.EndQuery(queryHeap, query);
+}
+
+void CapCommandBuffer::ResolveQueries(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries)
+{
+    {
+        CapCall call{ writer_, CapIdent_ResolveQueries, this };
+        call.WriteObject(&queryHeap);
+        call.Write(firstQuery, numQueries);
+    }
+    instance.ResolveQueries(queryHeap, firstQuery, numQueries);
+}
+
+void CapCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
+{
+    {
+        CapCall call{ writer_, CapIdent_BeginRenderCondition, this };
+        call.WriteObject(&queryHeap);
+        call.Write(query, mode);
+    }
+    instance.BeginRenderCondition(queryHeap, query, mode);
+}
+
+void CapCommandBuffer::EndRenderCondition()
+{
+    {
+        CapCall call{ writer_, CapIdent_EndRenderCondition, this };
+    }
+    instance.EndRenderCondition();
+}
+
+/* ----- Stream Output ------ */
+
+void CapCommandBuffer::BeginStreamOutput(std::uint32_t numBuffers, Buffer* const * buffers)
+{
+    {
+        CapCall call{ writer_, CapIdent_BeginStreamOutput, this };
+        call.Write(numBuffers);
+        for (std::uint32_t i = 0; i < numBuffers; ++i)
+            call.WriteObject(buffers[i]);
+    }
+    instance.BeginStreamOutput(numBuffers, buffers);
+}
+
+void CapCommandBuffer::EndStreamOutput()
+{
+    {
+        CapCall call{ writer_, CapIdent_EndStreamOutput, this };
+    }
+    instance.EndStreamOutput();
+}
+
+/* ----- Drawing ----- */
+
+/*
+Draw commands with default arguments are written with the number of arguments,
+so the replay calls the same overload, which may result in a different native command (e.g. without base instance).
+*/
+
+void CapCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
+{
+    {
+        CapCall call{ writer_, CapIdent_Draw, this };
+        call.Write(numVertices, firstVertex);
+    }
+    instance.Draw(numVertices, firstVertex);
+}
+
+void CapCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
+{
+    {
+        CapCall call{ writer_, CapIdent_DrawIndexed, this };
+        call.Write(std::uint8_t(2), numIndices, firstIndex, std::int32_t(0));
+    }
+    instance.DrawIndexed(numIndices, firstIndex);
+}
+
+void CapCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
+{
+    {
+        CapCall call{ writer_, CapIdent_DrawIndexed, this };
+        call.Write(std::uint8_t(3), numIndices, firstIndex, vertexOffset);
+    }
+    instance.DrawIndexed(numIndices, firstIndex, vertexOffset);
+}
+
+void CapCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
+{
+    {
+        CapCall call{ writer_, CapIdent_DrawInstanced, this };
+        call.Write(std::uint8_t(3), numVertices, firstVertex, numInstances, std::uint32_t(0));
+    }
+    instance.DrawInstanced(numVertices, firstVertex, numInstances);
+}
+
+void CapCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
+{
+    {
+        CapCall call{ writer_, CapIdent_DrawInstanced, this };
+        call.Write(std::uint8_t(4), numVertices, firstVertex, numInstances, firstInstance);
+    }
+    instance.DrawInstanced(numVertices, firstVertex, numInstances, firstInstance);
+}
+
+void CapCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
+{
+    {
+        CapCall call{ writer_, CapIdent_DrawIndexedInstanced, this };
+        call.Write(std::uint8_t(3), numIndices, numInstances, firstIndex, std::int32_t(0), std::uint32_t(0));
+    }
+    instance.DrawIndexedInstanced(numIndices, numInstances, firstIndex);
+}
+
+void CapCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
+{
+    {
+        CapCall call{ writer_, CapIdent_DrawIndexedInstanced, this };
+        call.Write(std::uint8_t(4), numIndices, numInstances, firstIndex, vertexOffset, std::uint32_t(0));
+    }
+    instance.DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset);
+}
+
+void CapCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
+{
+    {
+        CapCall call{ writer_, CapIdent_DrawIndexedInstanced, this };
+        call.Write(std::uint8_t(5), numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
+    }
+    instance.DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
+}
+
+void CapCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    {
+        CapCall call{ writer_, CapIdent_DrawIndirect, this };
+        call.WriteObject(&buffer);
+        call.Write(std::uint8_t(2), offset, std::uint32_t(0), std::uint32_t(0));
+    }
+    instance.DrawIndirect(buffer, offset);
+}
+
+void CapCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    {
+        CapCall call{ writer_, CapIdent_DrawIndirect, this };
+        call.WriteObject(&buffer);
+        call.Write(std::uint8_t(4), offset, numCommands, stride);
+    }
+    instance.DrawIndirect(buffer, offset, numCommands, stride);
+}
+
+void CapCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    {
+        CapCall call{ writer_, CapIdent_DrawIndexedIndirect, this };
+        call.WriteObject(&buffer);
+        call.Write(std::uint8_t(2), offset, std::uint32_t(0), std::uint32_t(0));
+    }
+    instance.DrawIndexedIndirect(buffer, offset);
+}
+
+void CapCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    {
+        CapCall call{ writer_, CapIdent_DrawIndexedIndirect, this };
+        call.WriteObject(&buffer);
+        call.Write(std::uint8_t(4), offset, numCommands, stride);
+    }
+    instance.DrawIndexedIndirect(buffer, offset, numCommands, stride);
+}
+
+void CapCommandBuffer::DrawIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride)
+{
+    {
+        CapCall call{ writer_, CapIdent_DrawIndirectCount, this };
+        call.WriteObject(&buffer);
+        call.Write(offset);
+        call.WriteObject(&countBuffer);
+        call.Write(countOffset, maxNumCommands, stride);
+    }
+    instance.DrawIndirectCount(buffer, offset, countBuffer, countOffset, maxNumCommands, stride);
+}
+
+void CapCommandBuffer::DrawIndexedIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride)
+{
+    {
+        CapCall call{ writer_, CapIdent_DrawIndexedIndirectCount, this };
+        call.WriteObject(&buffer);
+        call.Write(offset);
+        call.WriteObject(&countBuffer);
+        call.Write(countOffset, maxNumCommands, stride);
+    }
+    instance.DrawIndexedIndirectCount(buffer, offset, countBuffer, countOffset, maxNumCommands, stride);
+}
+
+std::uint32_t CapCommandBuffer::DrawPatchable(const DrawIndirectArguments& args)
+{
+    /* Write returned slot as well, so the replay can map it to the slot of the replayed command buffer */
+    const auto slot = instance.DrawPatchable(args);
+    {
+        CapCall call{ writer_, CapIdent_DrawPatchable, this };
+        call.Write(args, slot);
+    }
+    return slot;
+}
+
+std::uint32_t CapCommandBuffer::DrawIndexedPatchable(const DrawIndexedIndirectArguments& args)
+{
+    const auto slot = instance.DrawIndexedPatchable(args);
+    {
+        CapCall call{ writer_, CapIdent_DrawIndexedPatchable, this };
+        call.Write(args, slot);
+    }
+    return slot;
+}
+
+bool CapCommandBuffer::PatchDraw(std::uint32_t slot, const DrawIndirectArguments& args)
+{
+    {
+        CapCall call{ writer_, CapIdent_PatchDraw, this };
+        call.Write(slot, args);
+    }
+    return instance.PatchDraw(slot, args);
+}
+
+bool CapCommandBuffer::PatchDrawIndexed(std::uint32_t slot, const DrawIndexedIndirectArguments& args)
+{
+    {
+        CapCall call{ writer_, CapIdent_PatchDrawIndexed, this };
+        call.Write(slot, args);
+    }
+    return instance.PatchDrawIndexed(slot, args);
+}
+
+void CapCommandBuffer::DrawMeshTasks(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
+{
+    {
+        CapCall call{ writer_, CapIdent_DrawMeshTasks, this };
+        call.Write(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+    }
+    instance.DrawMeshTasks(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+}
+
+void CapCommandBuffer::DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    {
+        CapCall call{ writer_, CapIdent_DrawMeshTasksIndirect, this };
+        call.WriteObject(&buffer);
+        call.Write(offset, numCommands, stride);
+    }
+    instance.DrawMeshTasksIndirect(buffer, offset, numCommands, stride);
+}
+
+/* ----- Compute ----- */
+
+void CapCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
+{
+    {
+        CapCall call{ writer_, CapIdent_Dispatch, this };
+        call.Write(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+    }
+    instance.Dispatch(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+}
+
+void CapCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    {
+        CapCall call{ writer_, CapIdent_DispatchIndirect, this };
+        call.WriteObject(&buffer);
+        call.Write(offset);
+    }
+    instance.DispatchIndirect(buffer, offset);
+}
+
+/* ----- Debugging ----- */
+
+void CapCommandBuffer::PushDebugGroup(const char* name)
+{
+    {
+        CapCall call{ writer_, CapIdent_PushDebugGroup, this };
+        call.WriteString(name);
+    }
+    instance.PushDebugGroup(name);
+}
+
+void CapCommandBuffer::PopDebugGroup()
+{
+    {
+        CapCall call{ writer_, CapIdent_PopDebugGroup, this };
+    }
+    instance.PopDebugGroup();
+}
+
+/* ----- Extensions ----- */
+
+void CapCommandBuffer::SetGraphicsAPIDependentState(const void* stateDesc, std::size_t stateDescSize)
+{
+    /* Backend specific states are not portable between renderers, so they are not part of the capture */
+    instance.SetGraphicsAPIDependentState(stateDesc, stateDescSize);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
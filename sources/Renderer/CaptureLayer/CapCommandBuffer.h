@@ -0,0 +1,278 @@
+/*
+ * CapCommandBuffer.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CAP_COMMAND_BUFFER_H
+#define LLGL_CAP_COMMAND_BUFFER_H
+
+
+#include <LLGL/CommandBuffer.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class CapWriter;
+
+class CapCommandBuffer final : public CommandBuffer
+{
+
+    public:
+
+        /* ----- Common ----- */
+
+        CapCommandBuffer(CommandBuffer& instance, CapWriter& writer);
+
+        void SetName(const char* name) override;
+
+        /* ----- Encoding ----- */
+
+        void Begin() override;
+        void End() override;
+
+        std::uint32_t QueryBeginStalls() override;
+
+        void Execute(CommandBuffer& deferredCommandBuffer) override;
+
+        /* ----- Blitting ----- */
+
+        void UpdateBuffer(
+            Buffer&         dstBuffer,
+            std::uint64_t   dstOffset,
+            const void*     data,
+            std::uint16_t   dataSize
+        ) override;
+
+        void UpdateBuffer(
+            Buffer&                     dstBuffer,
+            std::uint32_t               numRegions,
+            const BufferWriteRegion*    regions
+        ) override;
+
+        void CopyBuffer(
+            Buffer&         dstBuffer,
+            std::uint64_t   dstOffset,
+            Buffer&         srcBuffer,
+            std::uint64_t   srcOffset,
+            std::uint64_t   size
+        ) override;
+
+        void CopyBuffer(
+            Buffer&                     dstBuffer,
+            Buffer&                     srcBuffer,
+            std::uint32_t               numRegions,
+            const BufferCopyRegion*     regions
+        ) override;
+
+        void CopyBufferFromTexture(
+            Buffer&                 dstBuffer,
+            std::uint64_t           dstOffset,
+            Texture&                srcTexture,
+            const TextureRegion&    srcRegion,
+            std::uint32_t           rowStride   = 0,
+            std::uint32_t           layerStride = 0
+        ) override;
+
+        std::uint64_t CopyBufferToReadback(Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size) override;
+        std::uint64_t CopyTextureToReadback(Texture& srcTexture, const TextureRegion& srcRegion) override;
+
+        void FillBuffer(
+            Buffer&         dstBuffer,
+            std::uint64_t   dstOffset,
+            std::uint32_t   value,
+            std::uint64_t   fillSize    = Constants::wholeSize
+        ) override;
+
+        void CopyTexture(
+            Texture&                dstTexture,
+            const TextureLocation&  dstLocation,
+            Texture&                srcTexture,
+            const TextureLocation&  srcLocation,
+            const Extent3D&         extent
+        ) override;
+
+        void CopyTexture(
+            Texture&                    dstTexture,
+            Texture&                    srcTexture,
+            std::uint32_t               numRegions,
+            const TextureCopyRegion*    regions
+        ) override;
+
+        void CopyTextureFromBuffer(
+            Texture&                dstTexture,
+            const TextureRegion&    dstRegion,
+            Buffer&                 srcBuffer,
+            std::uint64_t           srcOffset,
+            std::uint32_t           rowStride   = 0,
+            std::uint32_t           layerStride = 0
+        ) override;
+
+        void GenerateMips(Texture& texture) override;
+        void GenerateMips(Texture& texture, const TextureSubresource& subresource) override;
+
+        /* ----- Viewport and Scissor ----- */
+
+        void SetViewport(const Viewport& viewport) override;
+        void SetViewports(std::uint32_t numViewports, const Viewport* viewports) override;
+
+        void SetScissor(const Scissor& scissor) override;
+        void SetScissors(std::uint32_t numScissors, const Scissor* scissors) override;
+
+        /* ----- Input Assembly ------ */
+
+        void SetVertexBuffer(Buffer& buffer) override;
+        void SetVertexBufferArray(BufferArray& bufferArray) override;
+
+        void SetIndexBuffer(Buffer& buffer) override;
+        void SetIndexBuffer(Buffer& buffer, const Format format, std::uint64_t offset = 0) override;
+
+        /* ----- Resources ----- */
+
+        void SetResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           descriptorSet   = 0,
+            const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined
+        ) override;
+
+        void SetResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           descriptorSet,
+            std::uint32_t           numDynamicOffsets,
+            const std::uint32_t*    dynamicOffsets,
+            const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined
+        ) override;
+
+        void SetResource(
+            Resource&       resource,
+            std::uint32_t   slot,
+            long            bindFlags,
+            long            stageFlags = StageFlags::AllStages
+        ) override;
+
+        void ResetResourceSlots(
+            const ResourceType  resourceType,
+            std::uint32_t       firstSlot,
+            std::uint32_t       numSlots,
+            long                bindFlags,
+            long                stageFlags      = StageFlags::AllStages
+        ) override;
+
+        /* ----- Render Passes ----- */
+
+        void BeginRenderPass(
+            RenderTarget&       renderTarget,
+            const RenderPass*   renderPass      = nullptr,
+            std::uint32_t       numClearValues  = 0,
+            const ClearValue*   clearValues     = nullptr
+        ) override;
+
+        void EndRenderPass() override;
+        void NextSubpass() override;
+
+        void Clear(long flags, const ClearValue& clearValue) override;
+        void ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments) override;
+
+        /* ----- Pipeline States ----- */
+
+        void SetPipelineState(PipelineState& pipelineState) override;
+        void SetBlendFactor(const ColorRGBAf& color) override;
+        void SetStencilReference(std::uint32_t reference, const StencilFace stencilFace = StencilFace::FrontAndBack) override;
+        void SetShadingRate(const ShadingRate rate) override;
+
+        void SetUniform(
+            UniformLocation location,
+            const void*     data,
+            std::uint32_t   dataSize
+        ) override;
+
+        void SetUniforms(
+            UniformLocation location,
+            std::uint32_t   count,
+            const void*     data,
+            std::uint32_t   dataSize
+        ) override;
+
+        /* ----- Queries ----- */
+
+        void BeginQuery(QueryHeap& queryHeap, std::uint32_t query = 0) override;
+        void EndQuery(QueryHeap& queryHeap, std::uint32_t query = 0) override;
+        void ResolveQueries(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries) override;
+
+        void BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query = 0, const RenderConditionMode mode = RenderConditionMode::Wait) override;
+        void EndRenderCondition() override;
+
+        /* ----- Stream Output ------ */
+
+        void BeginStreamOutput(std::uint32_t numBuffers, Buffer* const * buffers) override;
+        void EndStreamOutput() override;
+
+        /* ----- Drawing ----- */
+
+        void Draw(std::uint32_t numVertices, std::uint32_t firstVertex) override;
+
+        void DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex) override;
+        void DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset) override;
+
+        void DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances) override;
+        void DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance) override;
+
+        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex) override;
+        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset) override;
+        void DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance) override;
+
+        void DrawIndirect(Buffer& buffer, std::uint64_t offset) override;
+        void DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
+
+        void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset) override;
+        void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
+
+        void DrawIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride) override;
+        void DrawIndexedIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride) override;
+
+        std::uint32_t DrawPatchable(const DrawIndirectArguments& args) override;
+        std::uint32_t DrawIndexedPatchable(const DrawIndexedIndirectArguments& args) override;
+
+        bool PatchDraw(std::uint32_t slot, const DrawIndirectArguments& args) override;
+        bool PatchDrawIndexed(std::uint32_t slot, const DrawIndexedIndirectArguments& args) override;
+
+        void DrawMeshTasks(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ) override;
+        void DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
+
+        /* ----- Compute ----- */
+
+        void Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ) override;
+        void DispatchIndirect(Buffer& buffer, std::uint64_t offset) override;
+
+        /* ----- Debugging ----- */
+
+        void PushDebugGroup(const char* name) override;
+        void PopDebugGroup() override;
+
+        /* ----- Extensions ----- */
+
+        void SetGraphicsAPIDependentState(const void* stateDesc, std::size_t stateDescSize) override;
+
+    public:
+
+        CommandBuffer& instance;
+
+    private:
+
+        CapWriter& writer_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,121 @@
+/*
+ * CapCommandQueue.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "CapCommandQueue.h"
+#include "CapCommandBuffer.h"
+#include "CapSerialization.h"
+#include "../CheckedCast.h"
+#include <LLGL/Container/SmallVector.h>
+
+
+namespace LLGL
+{
+
+
+CapCommandQueue::CapCommandQueue(CommandQueue& instance, CapWriter& writer) :
+    instance { instance },
+    writer_  { writer   }
+{
+}
+
+/* ----- Command Buffers ----- */
+
+void CapCommandQueue::Submit(CommandBuffer& commandBuffer)
+{
+    auto& commandBufferCap = LLGL_CAST(CapCommandBuffer&, commandBuffer);
+    {
+        CapCall call{ writer_, CapIdent_Submit };
+        call.Write(std::uint32_t(1));
+        call.WriteObject(&commandBuffer);
+    }
+    instance.Submit(commandBufferCap.instance);
+}
+
+void CapCommandQueue::Submit(std::uint32_t numCommandBuffers, CommandBuffer* const * commandBuffers)
+{
+    /* Forward instances of all command buffers to the wrapped queue, so they can be submitted at once */
+    SmallVector<CommandBuffer*, 8> instances;
+    instances.reserve(numCommandBuffers);
+
+    {
+        CapCall call{ writer_, CapIdent_Submit };
+        call.Write(numCommandBuffers);
+        for (std::uint32_t i = 0; i < numCommandBuffers; ++i)
+        {
+            call.WriteObject(commandBuffers[i]);
+            instances.push_back(&(LLGL_CAST(CapCommandBuffer*, commandBuffers[i])->instance));
+        }
+    }
+
+    instance.Submit(numCommandBuffers, instances.data());
+}
+
+/* ----- Queries ----- */
+
+bool CapCommandQueue::QueryResult(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, void* data, std::size_t dataSize)
+{
+    /* Query results are read back by the application only, so they are not part of the capture */
+    return instance.QueryResult(queryHeap, firstQuery, numQueries, data, dataSize);
+}
+
+std::uint32_t CapCommandQueue::TryGetQueryResults(QueryHeap& queryHeap, void* data, std::size_t dataSize, QueryRange* outRanges, std::uint32_t maxRanges)
+{
+    /* Same as QueryResult: only the resolve command is captured */
+    return instance.TryGetQueryResults(queryHeap, data, dataSize, outRanges, maxRanges);
+}
+
+bool CapCommandQueue::QueryCalibratedTimestamps(CalibratedTimestamps& outTimestamps)
+{
+    /* Timestamp calibration is not captured, since it only depends on the current device timeline */
+    return instance.QueryCalibratedTimestamps(outTimestamps);
+}
+
+/* ----- Fences ----- */
+
+void CapCommandQueue::Submit(Fence& fence)
+{
+    {
+        CapCall call{ writer_, CapIdent_SubmitFence };
+        call.WriteObject(&fence);
+    }
+    instance.Submit(fence);
+}
+
+bool CapCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
+{
+    {
+        CapCall call{ writer_, CapIdent_WaitFence };
+        call.WriteObject(&fence);
+        call.Write(timeout);
+    }
+    return instance.WaitFence(fence, timeout);
+}
+
+bool CapCommandQueue::WaitFenceValue(Fence& fence, std::uint64_t value, std::uint64_t timeout)
+{
+    {
+        CapCall call{ writer_, CapIdent_WaitFenceValue };
+        call.WriteObject(&fence);
+        call.Write(value, timeout);
+    }
+    return instance.WaitFenceValue(fence, value, timeout);
+}
+
+void CapCommandQueue::WaitIdle()
+{
+    {
+        CapCall call{ writer_, CapIdent_WaitIdle };
+    }
+    instance.WaitIdle();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,81 @@
+/*
+ * CapCommandQueue.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CAP_COMMAND_QUEUE_H
+#define LLGL_CAP_COMMAND_QUEUE_H
+
+
+#include <LLGL/CommandQueue.h>
+
+
+namespace LLGL
+{
+
+
+class CapWriter;
+
+class CapCommandQueue final : public CommandQueue
+{
+
+    public:
+
+        /* ----- Common ----- */
+
+        CapCommandQueue(CommandQueue& instance, CapWriter& writer);
+
+        /* ----- Command Buffers ----- */
+
+        void Submit(CommandBuffer& commandBuffer) override;
+        void Submit(std::uint32_t numCommandBuffers, CommandBuffer* const * commandBuffers) override;
+
+        /* ----- Queries ----- */
+
+        bool QueryResult(
+            QueryHeap&      queryHeap,
+            std::uint32_t   firstQuery,
+            std::uint32_t   numQueries,
+            void*           data,
+            std::size_t     dataSize
+        ) override;
+
+        std::uint32_t TryGetQueryResults(
+            QueryHeap&      queryHeap,
+            void*           data,
+            std::size_t     dataSize,
+            QueryRange*     outRanges,
+            std::uint32_t   maxRanges
+        ) override;
+
+        bool QueryCalibratedTimestamps(CalibratedTimestamps& outTimestamps) override;
+
+        /* ----- Fences ----- */
+
+        void Submit(Fence& fence) override;
+
+        bool WaitFence(Fence& fence, std::uint64_t timeout) override;
+        bool WaitFenceValue(Fence& fence, std::uint64_t value, std::uint64_t timeout) override;
+        void WaitIdle() override;
+
+    public:
+
+        CommandQueue& instance;
+
+    private:
+
+        CapWriter& writer_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,660 @@
+/*
+ * CapRenderSystem.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "CapRenderSystem.h"
+#include "../CheckedCast.h"
+#include "../../Core/Helper.h"
+#include <LLGL/Log.h>
+
+
+namespace LLGL
+{
+
+
+/*
+~~~~~~ INFO ~~~~~~
+This is the capture layer render system.
+It is a wrapper for the actual render system to write all API calls into a capture file, which can be replayed with the CaptureReplay class.
+Each call is written into the capture file before it is forwarded to the actual render system, except for the "Create..." functions,
+which need the new object to assign its capture ID. This ID refers to the wrapper objects (swap-chains and command buffers) or the native objects (all others).
+*/
+
+CapRenderSystem::CapRenderSystem(RenderSystemPtr&& instance, const char* filename, const char* moduleName) :
+    instance_ { std::forward<RenderSystemPtr&&>(instance) },
+    writer_   { filename, moduleName                      }
+{
+    UpdateRendererInfo();
+
+    /* Forward report of the render system initialization */
+    if (auto report = instance_->GetReport())
+        SetReport(report->GetText(), report->HasErrors());
+}
+
+/* ----- Swap-chain ----- */
+
+SwapChain* CapRenderSystem::CreateSwapChain(const SwapChainDescriptor& swapChainDesc, const std::shared_ptr<Surface>& surface)
+{
+    auto swapChainInstance = instance_->CreateSwapChain(swapChainDesc, surface);
+
+    /* Store meta data about render system, since some renderers initialize their device with the first swap-chain */
+    UpdateRendererInfo();
+
+    auto swapChainCap = TakeOwnership(swapChains_, MakeUnique<CapSwapChain>(*swapChainInstance, writer_));
+    {
+        CapCall call{ writer_, CapIdent_CreateSwapChain };
+        call.Write(writer_.RegisterObject(swapChainCap), swapChainDesc);
+    }
+    RegisterOwnedRenderPass(swapChainInstance->GetRenderPass(), swapChainCap);
+
+    return swapChainCap;
+}
+
+void CapRenderSystem::Release(SwapChain& swapChain)
+{
+    auto& swapChainCap = LLGL_CAST(CapSwapChain&, swapChain);
+    UnregisterOwnedRenderPass(swapChainCap.GetRenderPass());
+    WriteRelease(swapChain);
+    instance_->Release(swapChainCap.instance);
+    RemoveFromUniqueSet(swapChains_, &swapChain);
+}
+
+/* ----- Command queues ----- */
+
+CommandQueue* CapRenderSystem::GetCommandQueue()
+{
+    if (!commandQueue_)
+    {
+        if (auto commandQueueInstance = instance_->GetCommandQueue())
+            commandQueue_ = MakeUnique<CapCommandQueue>(*commandQueueInstance, writer_);
+    }
+    return commandQueue_.get();
+}
+
+/* ----- Command buffers ----- */
+
+CommandBuffer* CapRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& commandBufferDesc)
+{
+    /* Replace inherited render target by its instance; the capture layer does not expose the asynchronous compute queue */
+    auto instanceDesc = commandBufferDesc;
+    instanceDesc.renderTarget = GetCapRenderTargetInstance(commandBufferDesc.renderTarget);
+    instanceDesc.flags &= ~CommandBufferFlags::ComputeQueue;
+
+    auto commandBufferCap = TakeOwnership(
+        commandBuffers_,
+        MakeUnique<CapCommandBuffer>(*instance_->CreateCommandBuffer(instanceDesc), writer_)
+    );
+    {
+        CapCall call{ writer_, CapIdent_CreateCommandBuffer };
+        call.Write(writer_.RegisterObject(commandBufferCap), commandBufferDesc.flags, commandBufferDesc.numNativeBuffers);
+        call.WriteObject(commandBufferDesc.renderTarget);
+    }
+    return commandBufferCap;
+}
+
+void CapRenderSystem::Release(CommandBuffer& commandBuffer)
+{
+    auto& commandBufferCap = LLGL_CAST(CapCommandBuffer&, commandBuffer);
+    WriteRelease(commandBuffer);
+    instance_->Release(commandBufferCap.instance);
+    RemoveFromUniqueSet(commandBuffers_, &commandBuffer);
+}
+
+/* ----- Buffers ------ */
+
+Buffer* CapRenderSystem::CreateBuffer(const BufferDescriptor& bufferDesc, const void* initialData)
+{
+    auto buffer = instance_->CreateBuffer(bufferDesc, initialData);
+    {
+        CapCall call{ writer_, CapIdent_CreateBuffer };
+        call.Write(writer_.RegisterObject(buffer));
+        CapWriteBufferDesc(call, bufferDesc);
+        call.WriteData(initialData, static_cast<std::size_t>(bufferDesc.size));
+    }
+    return buffer;
+}
+
+BufferArray* CapRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets)
+{
+    auto bufferArrayInstance = instance_->CreateBufferArray(numBuffers, bufferArray, offsets);
+    {
+        CapCall call{ writer_, CapIdent_CreateBufferArray };
+        call.Write(writer_.RegisterObject(bufferArrayInstance), numBuffers);
+        for (std::uint32_t i = 0; i < numBuffers; ++i)
+            call.WriteObject(bufferArray[i]);
+        call.Write(offsets != nullptr);
+        if (offsets != nullptr)
+        {
+            for (std::uint32_t i = 0; i < numBuffers; ++i)
+                call.Write(offsets[i]);
+        }
+    }
+    return bufferArrayInstance;
+}
+
+void CapRenderSystem::Release(Buffer& buffer)
+{
+    WriteRelease(buffer);
+    instance_->Release(buffer);
+}
+
+void CapRenderSystem::Release(BufferArray& bufferArray)
+{
+    WriteRelease(bufferArray);
+    instance_->Release(bufferArray);
+}
+
+void CapRenderSystem::WriteBuffer(Buffer& buffer, std::uint64_t offset, const void* data, std::uint64_t dataSize)
+{
+    {
+        CapCall call{ writer_, CapIdent_WriteBuffer };
+        call.WriteObject(&buffer);
+        call.Write(offset);
+        call.WriteData(data, static_cast<std::size_t>(dataSize));
+    }
+    instance_->WriteBuffer(buffer, offset, data, dataSize);
+}
+
+void CapRenderSystem::WriteBuffer(Buffer& buffer, std::uint32_t numRegions, const BufferWriteRegion* regions)
+{
+    {
+        CapCall call{ writer_, CapIdent_WriteBufferRegions };
+        call.WriteObject(&buffer);
+        call.Write(numRegions);
+        for (std::uint32_t i = 0; i < numRegions; ++i)
+        {
+            call.Write(regions[i].dstOffset);
+            call.WriteData(regions[i].data, static_cast<std::size_t>(regions[i].dataSize));
+        }
+    }
+    instance_->WriteBuffer(buffer, numRegions, regions);
+}
+
+void CapRenderSystem::ReadBuffer(Buffer& buffer, std::uint64_t offset, void* data, std::uint64_t dataSize)
+{
+    instance_->ReadBuffer(buffer, offset, data, dataSize);
+}
+
+void* CapRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
+{
+    auto data = instance_->MapBuffer(buffer, access);
+    if (data != nullptr && access != CPUAccess::ReadOnly)
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        mappedBuffers_[&buffer] = MappedBuffer{ data, 0, buffer.GetDesc().size };
+    }
+    return data;
+}
+
+void* CapRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t length)
+{
+    auto data = instance_->MapBuffer(buffer, access, offset, length);
+    if (data != nullptr && access != CPUAccess::ReadOnly)
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        mappedBuffers_[&buffer] = MappedBuffer{ data, offset, length };
+    }
+    return data;
+}
+
+void CapRenderSystem::UnmapBuffer(Buffer& buffer)
+{
+    /* Write content of mapped range as buffer update, since the capture cannot observe the individual writes into mapped memory */
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        auto it = mappedBuffers_.find(&buffer);
+        if (it != mappedBuffers_.end())
+        {
+            CapCall call{ writer_, CapIdent_WriteBuffer };
+            call.WriteObject(&buffer);
+            call.Write(it->second.offset);
+            call.WriteData(it->second.data, static_cast<std::size_t>(it->second.length));
+            mappedBuffers_.erase(it);
+        }
+    }
+    instance_->UnmapBuffer(buffer);
+}
+
+/* ----- Textures ----- */
+
+Texture* CapRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc)
+{
+    auto texture = instance_->CreateTexture(textureDesc, imageDesc);
+    {
+        CapCall call{ writer_, CapIdent_CreateTexture };
+        call.Write(writer_.RegisterObject(texture), textureDesc);
+        if (imageDesc != nullptr)
+        {
+            call.Write(imageDesc->format, imageDesc->dataType);
+            call.WriteData(imageDesc->data, imageDesc->dataSize);
+        }
+        else
+        {
+            call.Write(ImageFormat::RGBA, DataType::UInt8);
+            call.WriteData(nullptr, 0);
+        }
+    }
+    return texture;
+}
+
+void CapRenderSystem::Release(Texture& texture)
+{
+    WriteRelease(texture);
+    instance_->Release(texture);
+}
+
+void CapRenderSystem::WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
+{
+    {
+        CapCall call{ writer_, CapIdent_WriteTexture };
+        call.WriteObject(&texture);
+        call.Write(textureRegion, imageDesc.format, imageDesc.dataType, imageDesc.rowStride, imageDesc.layerStride);
+        call.WriteData(imageDesc.data, imageDesc.dataSize);
+    }
+    instance_->WriteTexture(texture, textureRegion, imageDesc);
+}
+
+void CapRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc)
+{
+    instance_->ReadTexture(texture, textureRegion, imageDesc);
+}
+
+bool CapRenderSystem::QueryTextureTiling(const Texture& texture, TextureTiling& outTiling)
+{
+    return instance_->QueryTextureTiling(texture, outTiling);
+}
+
+void CapRenderSystem::CommitTextureTiles(Texture& texture, const TextureRegion& textureRegion)
+{
+    {
+        CapCall call{ writer_, CapIdent_CommitTextureTiles };
+        call.WriteObject(&texture);
+        call.Write(textureRegion);
+    }
+    instance_->CommitTextureTiles(texture, textureRegion);
+}
+
+void CapRenderSystem::DecommitTextureTiles(Texture& texture, const TextureRegion& textureRegion)
+{
+    {
+        CapCall call{ writer_, CapIdent_DecommitTextureTiles };
+        call.WriteObject(&texture);
+        call.Write(textureRegion);
+    }
+    instance_->DecommitTextureTiles(texture, textureRegion);
+}
+
+/* ----- Native resources ----- */
+
+bool CapRenderSystem::QueryNativeHandle(const Resource& resource, NativeResourceHandle& outHandle)
+{
+    return instance_->QueryNativeHandle(resource, outHandle);
+}
+
+bool CapRenderSystem::ExportResource(Resource& resource, NativeHandleType handleType, NativeResourceHandle& outHandle)
+{
+    return instance_->ExportResource(resource, handleType, outHandle);
+}
+
+/*
+Imported resources are recorded as regular resource creations without initial data,
+since the native objects and shared memory of another API or process cannot be replayed.
+*/
+
+Buffer* CapRenderSystem::ImportBuffer(const BufferDescriptor& bufferDesc, const NativeResourceHandle& nativeHandle)
+{
+    auto buffer = instance_->ImportBuffer(bufferDesc, nativeHandle);
+    if (buffer != nullptr)
+    {
+        CapCall call{ writer_, CapIdent_CreateBuffer };
+        call.Write(writer_.RegisterObject(buffer));
+        CapWriteBufferDesc(call, bufferDesc);
+        call.WriteData(nullptr, 0);
+    }
+    return buffer;
+}
+
+Texture* CapRenderSystem::ImportTexture(const TextureDescriptor& textureDesc, const NativeResourceHandle& nativeHandle)
+{
+    auto texture = instance_->ImportTexture(textureDesc, nativeHandle);
+    if (texture != nullptr)
+    {
+        CapCall call{ writer_, CapIdent_CreateTexture };
+        call.Write(writer_.RegisterObject(texture), textureDesc);
+        call.Write(ImageFormat::RGBA, DataType::UInt8);
+        call.WriteData(nullptr, 0);
+    }
+    return texture;
+}
+
+/* ----- Readbacks ----- */
+
+const void* CapRenderSystem::MapReadback(std::uint64_t ticket, ReadbackLayout* outLayout)
+{
+    return instance_->MapReadback(ticket, outLayout);
+}
+
+void CapRenderSystem::UnmapReadback(std::uint64_t ticket)
+{
+    instance_->UnmapReadback(ticket);
+}
+
+/* ----- Sampler States ---- */
+
+Sampler* CapRenderSystem::CreateSampler(const SamplerDescriptor& samplerDesc)
+{
+    auto sampler = instance_->CreateSampler(samplerDesc);
+    {
+        CapCall call{ writer_, CapIdent_CreateSampler };
+        call.Write(writer_.RegisterObject(sampler), samplerDesc);
+    }
+    return sampler;
+}
+
+void CapRenderSystem::Release(Sampler& sampler)
+{
+    WriteRelease(sampler);
+    instance_->Release(sampler);
+}
+
+/* ----- Resource Views ----- */
+
+ResourceHeap* CapRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor& resourceHeapDesc, const ArrayView<ResourceViewDescriptor>& initialResourceViews)
+{
+    auto resourceHeap = instance_->CreateResourceHeap(resourceHeapDesc, initialResourceViews);
+    {
+        CapCall call{ writer_, CapIdent_CreateResourceHeap };
+        call.Write(writer_.RegisterObject(resourceHeap));
+        call.WriteObject(resourceHeapDesc.pipelineLayout);
+        call.Write(resourceHeapDesc.numResourceViews, resourceHeapDesc.barrierFlags, resourceHeapDesc.bindlessSlot, resourceHeapDesc.transient);
+        CapWriteResourceViews(call, initialResourceViews);
+    }
+    return resourceHeap;
+}
+
+void CapRenderSystem::Release(ResourceHeap& resourceHeap)
+{
+    WriteRelease(resourceHeap);
+    instance_->Release(resourceHeap);
+}
+
+std::uint32_t CapRenderSystem::WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews)
+{
+    {
+        CapCall call{ writer_, CapIdent_WriteResourceHeap };
+        call.WriteObject(&resourceHeap);
+        call.Write(firstDescriptor);
+        CapWriteResourceViews(call, resourceViews);
+    }
+    return instance_->WriteResourceHeap(resourceHeap, firstDescriptor, resourceViews);
+}
+
+/* ----- Render Passes ----- */
+
+RenderPass* CapRenderSystem::CreateRenderPass(const RenderPassDescriptor& renderPassDesc)
+{
+    auto renderPass = instance_->CreateRenderPass(renderPassDesc);
+    {
+        CapCall call{ writer_, CapIdent_CreateRenderPass };
+        call.Write(writer_.RegisterObject(renderPass), renderPassDesc);
+    }
+    return renderPass;
+}
+
+void CapRenderSystem::Release(RenderPass& renderPass)
+{
+    WriteRelease(renderPass);
+    instance_->Release(renderPass);
+}
+
+/* ----- Render Targets ----- */
+
+RenderTarget* CapRenderSystem::CreateRenderTarget(const RenderTargetDescriptor& renderTargetDesc)
+{
+    auto renderTarget = instance_->CreateRenderTarget(renderTargetDesc);
+    {
+        CapCall call{ writer_, CapIdent_CreateRenderTarget };
+        call.Write(writer_.RegisterObject(renderTarget));
+        CapWriteRenderTargetDesc(call, renderTargetDesc);
+    }
+    RegisterOwnedRenderPass(renderTarget->GetRenderPass(), renderTarget);
+    return renderTarget;
+}
+
+void CapRenderSystem::Release(RenderTarget& renderTarget)
+{
+    UnregisterOwnedRenderPass(renderTarget.GetRenderPass());
+    WriteRelease(renderTarget);
+    instance_->Release(renderTarget);
+}
+
+/* ----- Shader ----- */
+
+Shader* CapRenderSystem::CreateShader(const ShaderDescriptor& shaderDesc)
+{
+    auto shader = instance_->CreateShader(shaderDesc);
+    {
+        CapCall call{ writer_, CapIdent_CreateShader };
+        call.Write(writer_.RegisterObject(shader));
+        CapWriteShaderDesc(call, shaderDesc);
+    }
+    return shader;
+}
+
+void CapRenderSystem::CreateShaders(std::uint32_t numShaders, const ShaderDescriptor* shaderDescs, Shader** outShaders)
+{
+    /* Record each shader as individual call, so the capture can be replayed with CreateShader */
+    instance_->CreateShaders(numShaders, shaderDescs, outShaders);
+    for (std::uint32_t i = 0; i < numShaders; ++i)
+    {
+        CapCall call{ writer_, CapIdent_CreateShader };
+        call.Write(writer_.RegisterObject(outShaders[i]));
+        CapWriteShaderDesc(call, shaderDescs[i]);
+    }
+}
+
+void CapRenderSystem::Release(Shader& shader)
+{
+    WriteRelease(shader);
+    instance_->Release(shader);
+}
+
+/* ----- Pipeline Layouts ----- */
+
+PipelineLayout* CapRenderSystem::CreatePipelineLayout(const PipelineLayoutDescriptor& pipelineLayoutDesc)
+{
+    auto pipelineLayout = instance_->CreatePipelineLayout(pipelineLayoutDesc);
+    {
+        CapCall call{ writer_, CapIdent_CreatePipelineLayout };
+        call.Write(writer_.RegisterObject(pipelineLayout));
+        CapWritePipelineLayoutDesc(call, pipelineLayoutDesc);
+    }
+    return pipelineLayout;
+}
+
+void CapRenderSystem::Release(PipelineLayout& pipelineLayout)
+{
+    WriteRelease(pipelineLayout);
+    instance_->Release(pipelineLayout);
+}
+
+/* ----- Pipeline States ----- */
+
+PipelineState* CapRenderSystem::CreatePipelineState(const Blob& serializedCache)
+{
+    /* Serialized caches are renderer specific and don't contain the pipeline descriptor, so they cannot be replayed */
+    Log::PostReport(Log::ReportType::Warning, "pipeline states created from a serialized cache are not captured and will be missing in the replay");
+    return instance_->CreatePipelineState(serializedCache);
+}
+
+PipelineState* CapRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache)
+{
+    auto pipelineState = instance_->CreatePipelineState(pipelineStateDesc, serializedCache);
+    {
+        CapCall call{ writer_, CapIdent_CreateGraphicsPipeline };
+        call.Write(writer_.RegisterObject(pipelineState));
+        CapWriteGraphicsPipelineDesc(call, pipelineStateDesc);
+    }
+    return pipelineState;
+}
+
+PipelineState* CapRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache)
+{
+    auto pipelineState = instance_->CreatePipelineState(pipelineStateDesc, serializedCache);
+    {
+        CapCall call{ writer_, CapIdent_CreateComputePipeline };
+        call.Write(writer_.RegisterObject(pipelineState));
+        CapWriteComputePipelineDesc(call, pipelineStateDesc);
+    }
+    return pipelineState;
+}
+
+PipelineState* CapRenderSystem::CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc, long flags)
+{
+    /* Asynchronous pipeline states are replayed synchronously, so the replay does not depend on compilation timing */
+    auto pipelineState = instance_->CreatePipelineStateAsync(pipelineStateDesc, flags);
+    {
+        CapCall call{ writer_, CapIdent_CreateGraphicsPipeline };
+        call.Write(writer_.RegisterObject(pipelineState));
+        CapWriteGraphicsPipelineDesc(call, pipelineStateDesc);
+    }
+    return pipelineState;
+}
+
+PipelineState* CapRenderSystem::CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc, long flags)
+{
+    auto pipelineState = instance_->CreatePipelineStateAsync(pipelineStateDesc, flags);
+    {
+        CapCall call{ writer_, CapIdent_CreateComputePipeline };
+        call.Write(writer_.RegisterObject(pipelineState));
+        CapWriteComputePipelineDesc(call, pipelineStateDesc);
+    }
+    return pipelineState;
+}
+
+void CapRenderSystem::Release(PipelineState& pipelineState)
+{
+    WriteRelease(pipelineState);
+    instance_->Release(pipelineState);
+}
+
+/* ----- Queries ----- */
+
+QueryHeap* CapRenderSystem::CreateQueryHeap(const QueryHeapDescriptor& queryHeapDesc)
+{
+    auto queryHeap = instance_->CreateQueryHeap(queryHeapDesc);
+    {
+        CapCall call{ writer_, CapIdent_CreateQueryHeap };
+        call.Write(writer_.RegisterObject(queryHeap), queryHeapDesc);
+    }
+    return queryHeap;
+}
+
+void CapRenderSystem::Release(QueryHeap& queryHeap)
+{
+    WriteRelease(queryHeap);
+    instance_->Release(queryHeap);
+}
+
+/* ----- Fences ----- */
+
+Fence* CapRenderSystem::CreateFence()
+{
+    auto fence = instance_->CreateFence();
+    {
+        CapCall call{ writer_, CapIdent_CreateFence };
+        call.Write(writer_.RegisterObject(fence));
+    }
+    return fence;
+}
+
+void CapRenderSystem::Release(Fence& fence)
+{
+    WriteRelease(fence);
+    instance_->Release(fence);
+}
+
+/* ----- Memory ----- */
+
+bool CapRenderSystem::QueryMemoryStatistics(MemoryStatistics& outStats)
+{
+    return instance_->QueryMemoryStatistics(outStats);
+}
+
+/* ----- Residency ----- */
+
+bool CapRenderSystem::SetResidencyPriority(const ArrayView<Resource*>& resources, ResidencyPriority priority)
+{
+    return instance_->SetResidencyPriority(resources, priority);
+}
+
+bool CapRenderSystem::MakeResident(const ArrayView<Resource*>& resources)
+{
+    return instance_->MakeResident(resources);
+}
+
+bool CapRenderSystem::Evict(const ArrayView<Resource*>& resources)
+{
+    return instance_->Evict(resources);
+}
+
+/* ----- Commands ----- */
+
+bool CapRenderSystem::QueryCommandStatistics(CommandStatistics& outStats)
+{
+    return instance_->QueryCommandStatistics(outStats);
+}
+
+/* ----- Start-up ----- */
+
+bool CapRenderSystem::QueryStartupStatistics(StartupStatistics& outStats)
+{
+    return instance_->QueryStartupStatistics(outStats);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void CapRenderSystem::RegisterOwnedRenderPass(const RenderPass* renderPass, const RenderSystemChild* owner)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    if (renderPass != nullptr && writer_.GetObjectID(renderPass) == 0)
+    {
+        CapCall call{ writer_, CapIdent_GetRenderPass };
+        call.Write(writer_.RegisterObject(renderPass));
+        call.WriteObject(owner);
+        ownedRenderPasses_.insert(renderPass);
+    }
+}
+
+void CapRenderSystem::UnregisterOwnedRenderPass(const RenderPass* renderPass)
+{
+    /* Owned render passes are released with their owner, so they are only removed from the ID map */
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    if (ownedRenderPasses_.erase(renderPass) > 0)
+        writer_.UnregisterObject(renderPass);
+}
+
+void CapRenderSystem::WriteRelease(const RenderSystemChild& object)
+{
+    CapCall call{ writer_, CapIdent_Release };
+    call.Write(writer_.UnregisterObject(&object));
+}
+
+void CapRenderSystem::UpdateRendererInfo()
+{
+    SetRendererInfo(instance_->GetRendererInfo());
+    SetRenderingCaps(instance_->GetRenderingCaps());
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,229 @@
+/*
+ * CapRenderSystem.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CAP_RENDER_SYSTEM_H
+#define LLGL_CAP_RENDER_SYSTEM_H
+
+
+#include <LLGL/RenderSystem.h>
+#include "CapSwapChain.h"
+#include "CapCommandBuffer.h"
+#include "CapCommandQueue.h"
+#include "CapSerialization.h"
+
+#include "../ContainerTypes.h"
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+
+namespace LLGL
+{
+
+
+/*
+Capture layer render system. This writes all calls to the render system, command queue, command buffers, and swap-chains into a capture file,
+which can be replayed with the CaptureReplay class. Only these four interfaces are wrapped; all other objects are passed through
+and are referred to by their capture ID in the capture file.
+*/
+class CapRenderSystem final : public RenderSystem
+{
+
+    public:
+
+        /* ----- Common ----- */
+
+        CapRenderSystem(RenderSystemPtr&& instance, const char* filename, const char* moduleName);
+
+        /* ----- Swap-chain ------ */
+
+        SwapChain* CreateSwapChain(const SwapChainDescriptor& swapChainDesc, const std::shared_ptr<Surface>& surface = nullptr) override;
+
+        void Release(SwapChain& swapChain) override;
+
+        /* ----- Command queues ----- */
+
+        CommandQueue* GetCommandQueue() override;
+
+        /* ----- Command buffers ----- */
+
+        CommandBuffer* CreateCommandBuffer(const CommandBufferDescriptor& commandBufferDesc = {}) override;
+
+        void Release(CommandBuffer& commandBuffer) override;
+
+        /* ----- Buffers ------ */
+
+        Buffer* CreateBuffer(const BufferDescriptor& bufferDesc, const void* initialData = nullptr) override;
+        BufferArray* CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets = nullptr) override;
+
+        void Release(Buffer& buffer) override;
+        void Release(BufferArray& bufferArray) override;
+
+        void WriteBuffer(Buffer& buffer, std::uint64_t offset, const void* data, std::uint64_t dataSize) override;
+        void WriteBuffer(Buffer& buffer, std::uint32_t numRegions, const BufferWriteRegion* regions) override;
+        void ReadBuffer(Buffer& buffer, std::uint64_t offset, void* data, std::uint64_t dataSize) override;
+
+        void* MapBuffer(Buffer& buffer, const CPUAccess access) override;
+        void* MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t length) override;
+        void UnmapBuffer(Buffer& buffer) override;
+
+        /* ----- Textures ----- */
+
+        Texture* CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc = nullptr) override;
+
+        void Release(Texture& texture) override;
+
+        void WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc) override;
+        void ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc) override;
+
+        bool QueryTextureTiling(const Texture& texture, TextureTiling& outTiling) override;
+        void CommitTextureTiles(Texture& texture, const TextureRegion& textureRegion) override;
+        void DecommitTextureTiles(Texture& texture, const TextureRegion& textureRegion) override;
+
+        /* ----- Native resources ----- */
+
+        bool QueryNativeHandle(const Resource& resource, NativeResourceHandle& outHandle) override;
+        bool ExportResource(Resource& resource, NativeHandleType handleType, NativeResourceHandle& outHandle) override;
+
+        Buffer* ImportBuffer(const BufferDescriptor& bufferDesc, const NativeResourceHandle& nativeHandle) override;
+        Texture* ImportTexture(const TextureDescriptor& textureDesc, const NativeResourceHandle& nativeHandle) override;
+
+        /* ----- Readbacks ----- */
+
+        const void* MapReadback(std::uint64_t ticket, ReadbackLayout* outLayout = nullptr) override;
+        void UnmapReadback(std::uint64_t ticket) override;
+
+        /* ----- Sampler States ---- */
+
+        Sampler* CreateSampler(const SamplerDescriptor& samplerDesc) override;
+
+        void Release(Sampler& sampler) override;
+
+        /* ----- Resource Views ----- */
+
+        ResourceHeap* CreateResourceHeap(const ResourceHeapDescriptor& resourceHeapDesc, const ArrayView<ResourceViewDescriptor>& initialResourceViews = {}) override;
+
+        void Release(ResourceHeap& resourceHeap) override;
+
+        std::uint32_t WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews) override;
+
+        /* ----- Render Passes ----- */
+
+        RenderPass* CreateRenderPass(const RenderPassDescriptor& renderPassDesc) override;
+
+        void Release(RenderPass& renderPass) override;
+
+        /* ----- Render Targets ----- */
+
+        RenderTarget* CreateRenderTarget(const RenderTargetDescriptor& renderTargetDesc) override;
+
+        void Release(RenderTarget& renderTarget) override;
+
+        /* ----- Shader ----- */
+
+        Shader* CreateShader(const ShaderDescriptor& shaderDesc) override;
+        void CreateShaders(std::uint32_t numShaders, const ShaderDescriptor* shaderDescs, Shader** outShaders) override;
+
+        void Release(Shader& shader) override;
+
+        /* ----- Pipeline Layouts ----- */
+
+        PipelineLayout* CreatePipelineLayout(const PipelineLayoutDescriptor& pipelineLayoutDesc) override;
+
+        void Release(PipelineLayout& pipelineLayout) override;
+
+        /* ----- Pipeline States ----- */
+
+        PipelineState* CreatePipelineState(const Blob& serializedCache) override;
+        PipelineState* CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache = nullptr) override;
+        PipelineState* CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache = nullptr) override;
+        PipelineState* CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc, long flags = 0) override;
+        PipelineState* CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc, long flags = 0) override;
+
+        void Release(PipelineState& pipelineState) override;
+
+        /* ----- Queries ----- */
+
+        QueryHeap* CreateQueryHeap(const QueryHeapDescriptor& queryHeapDesc) override;
+
+        void Release(QueryHeap& queryHeap) override;
+
+        /* ----- Fences ----- */
+
+        Fence* CreateFence() override;
+
+        void Release(Fence& fence) override;
+
+        /* ----- Memory ----- */
+
+        bool QueryMemoryStatistics(MemoryStatistics& outStats) override;
+
+        /* ----- Residency ----- */
+
+        bool SetResidencyPriority(const ArrayView<Resource*>& resources, ResidencyPriority priority) override;
+        bool MakeResident(const ArrayView<Resource*>& resources) override;
+        bool Evict(const ArrayView<Resource*>& resources) override;
+
+        /* ----- Commands ----- */
+
+        bool QueryCommandStatistics(CommandStatistics& outStats) override;
+
+        /* ----- Start-up ----- */
+
+        bool QueryStartupStatistics(StartupStatistics& outStats) override;
+
+    private:
+
+        // Registers the specified render pass, which is owned by a swap-chain or render target, unless it is already known to the capture file.
+        void RegisterOwnedRenderPass(const RenderPass* renderPass, const RenderSystemChild* owner);
+
+        // Removes the specified render pass from the capture IDs if it has been registered by RegisterOwnedRenderPass.
+        void UnregisterOwnedRenderPass(const RenderPass* renderPass);
+
+        // Writes the release of the specified object into the capture file.
+        void WriteRelease(const RenderSystemChild& object);
+
+        // Copies caps and renderer info from the actual render system.
+        void UpdateRendererInfo();
+
+    private:
+
+        struct MappedBuffer
+        {
+            void*           data;
+            std::uint64_t   offset;
+            std::uint64_t   length;
+        };
+
+    private:
+
+        RenderSystemPtr                                 instance_;
+        CapWriter                                       writer_;
+
+        HWObjectContainer<CapSwapChain>                 swapChains_;
+        HWObjectInstance<CapCommandQueue>               commandQueue_;
+        HWObjectContainer<CapCommandBuffer>             commandBuffers_;
+
+        // Buffers that are currently mapped for write access. Their content is written into the capture file when they are unmapped.
+        std::unordered_map<const Buffer*, MappedBuffer> mappedBuffers_;
+
+        // Render passes that are owned by a swap-chain or render target.
+        std::unordered_set<const RenderPass*>           ownedRenderPasses_;
+
+        std::mutex                                      mutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
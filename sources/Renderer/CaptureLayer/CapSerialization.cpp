@@ -0,0 +1,472 @@
+/*
+ * CapSerialization.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "CapSerialization.h"
+#include "../../Core/Helper.h"
+#include <LLGL/Version.h>
+#include <stdexcept>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+/*
+ * CapWriter class
+ */
+
+CapWriter::CapWriter(const char* filename, const char* moduleName) :
+    file_       { filename, std::ios_base::binary | std::ios_base::out | std::ios_base::trunc },
+    serializer_ { file_                                                                        }
+{
+    if (!file_.good())
+        throw std::runtime_error("failed to create capture file: " + std::string(filename));
+
+    /* Write header segment with format and library version */
+    CapCall call{ *this, CapIdent_Header };
+    call.Write(g_capMagic, g_capFormatVersion, static_cast<std::uint32_t>(Version::GetID()));
+    call.WriteString(moduleName);
+}
+
+CapWriter::~CapWriter()
+{
+    serializer_.Finalize();
+}
+
+void CapWriter::Flush()
+{
+    std::lock_guard<std::recursive_mutex> guard{ mutex_ };
+    serializer_.Flush();
+}
+
+std::uint32_t CapWriter::RegisterObject(const RenderSystemChild* object)
+{
+    if (object == nullptr)
+        return 0;
+    std::lock_guard<std::recursive_mutex> guard{ mutex_ };
+    const auto id = nextObjectID_++;
+    objectIDs_[object] = id;
+    return id;
+}
+
+std::uint32_t CapWriter::UnregisterObject(const RenderSystemChild* object)
+{
+    std::lock_guard<std::recursive_mutex> guard{ mutex_ };
+    auto it = objectIDs_.find(object);
+    if (it != objectIDs_.end())
+    {
+        const auto id = it->second;
+        objectIDs_.erase(it);
+        return id;
+    }
+    return 0;
+}
+
+std::uint32_t CapWriter::GetObjectID(const RenderSystemChild* object) const
+{
+    if (object != nullptr)
+    {
+        auto it = objectIDs_.find(object);
+        if (it != objectIDs_.end())
+            return it->second;
+    }
+    return 0;
+}
+
+
+/*
+ * CapCall class
+ */
+
+CapCall::CapCall(CapWriter& writer, CapIdent ident) :
+    writer_ { writer         },
+    guard_  { writer.mutex_  }
+{
+    writer_.serializer_.Begin(ident);
+}
+
+CapCall::CapCall(CapWriter& writer, CapIdent ident, const RenderSystemChild* owner) :
+    CapCall { writer, ident }
+{
+    WriteObject(owner);
+}
+
+CapCall::~CapCall()
+{
+    writer_.serializer_.End();
+}
+
+void CapCall::WriteData(const void* data, std::size_t size)
+{
+    if (data == nullptr)
+        size = 0;
+    Write(static_cast<std::uint64_t>(size));
+    if (size > 0)
+        writer_.serializer_.Write(data, size);
+}
+
+void CapCall::WriteString(const char* str)
+{
+    Write(static_cast<std::uint8_t>(str != nullptr ? 1 : 0));
+    if (str != nullptr)
+        writer_.serializer_.WriteCString(str);
+}
+
+void CapCall::WriteObject(const RenderSystemChild* object)
+{
+    Write(writer_.GetObjectID(object));
+}
+
+
+/*
+ * CapReader class
+ */
+
+CapReader::CapReader(Serialization::Deserializer& reader, const std::vector<RenderSystemChild*>& objects) :
+    reader_  { reader  },
+    objects_ { objects }
+{
+}
+
+const void* CapReader::ReadData(std::size_t& outSize)
+{
+    outSize = static_cast<std::size_t>(Read<std::uint64_t>());
+    return (outSize > 0 ? reader_.ReadView(outSize) : nullptr);
+}
+
+const char* CapReader::ReadString()
+{
+    if (Read<std::uint8_t>() != 0)
+        return reader_.ReadCString();
+    return nullptr;
+}
+
+RenderSystemChild* CapReader::ReadObjectBase()
+{
+    const auto id = Read<std::uint32_t>();
+    return (id < objects_.size() ? objects_[id] : nullptr);
+}
+
+
+/*
+ * Internal functions
+ */
+
+static void CapWriteVertexAttribs(CapCall& call, const VertexAttribute* attribs, std::size_t numAttribs)
+{
+    call.Write(static_cast<std::uint32_t>(numAttribs));
+    for (std::size_t i = 0; i < numAttribs; ++i)
+    {
+        const auto& attrib = attribs[i];
+        call.WriteString(attrib.name.c_str());
+        call.Write(attrib.format, attrib.location, attrib.semanticIndex, attrib.systemValue);
+        call.Write(attrib.slot, attrib.offset, attrib.stride, attrib.instanceDivisor);
+    }
+}
+
+static void CapReadVertexAttribs(CapReader& reader, std::vector<VertexAttribute>& outAttribs)
+{
+    outAttribs.resize(reader.Read<std::uint32_t>());
+    for (auto& attrib : outAttribs)
+    {
+        if (auto name = reader.ReadString())
+            attrib.name = name;
+        attrib.format           = reader.Read<Format>();
+        attrib.location         = reader.Read<std::uint32_t>();
+        attrib.semanticIndex    = reader.Read<std::uint32_t>();
+        attrib.systemValue      = reader.Read<SystemValue>();
+        attrib.slot             = reader.Read<std::uint32_t>();
+        attrib.offset           = reader.Read<std::uint32_t>();
+        attrib.stride           = reader.Read<std::uint32_t>();
+        attrib.instanceDivisor  = reader.Read<std::uint32_t>();
+    }
+}
+
+static void CapWriteShaderSource(CapCall& call, const ShaderDescriptor& desc)
+{
+    /* Store shader files in place, so the replay does not depend on the working directory of the captured application */
+    switch (desc.sourceType)
+    {
+        case ShaderSourceType::CodeString:
+        {
+            const auto len = (desc.sourceSize > 0 ? desc.sourceSize : std::strlen(desc.source));
+            const std::string code{ desc.source, len };
+            call.Write(ShaderSourceType::CodeString);
+            call.WriteData(code.c_str(), code.size() + 1);
+        }
+        break;
+
+        case ShaderSourceType::CodeFile:
+        {
+            const auto code = ReadFileString(desc.source);
+            call.Write(ShaderSourceType::CodeString);
+            call.WriteData(code.c_str(), code.size() + 1);
+        }
+        break;
+
+        case ShaderSourceType::BinaryBuffer:
+        {
+            call.Write(ShaderSourceType::BinaryBuffer);
+            call.WriteData(desc.source, desc.sourceSize);
+        }
+        break;
+
+        case ShaderSourceType::BinaryFile:
+        {
+            const auto code = ReadFileBuffer(desc.source);
+            call.Write(ShaderSourceType::BinaryBuffer);
+            call.WriteData(code.data(), code.size());
+        }
+        break;
+    }
+}
+
+
+/*
+ * Global functions
+ */
+
+void CapWriteBufferDesc(CapCall& call, const BufferDescriptor& desc)
+{
+    call.Write(desc.size, desc.stride, desc.format, desc.bindFlags, desc.cpuAccessFlags, desc.miscFlags);
+    CapWriteVertexAttribs(call, desc.vertexAttribs.data(), desc.vertexAttribs.size());
+}
+
+void CapWriteShaderDesc(CapCall& call, const ShaderDescriptor& desc)
+{
+    call.Write(desc.type);
+    CapWriteShaderSource(call, desc);
+    call.WriteString(desc.entryPoint);
+    call.WriteString(desc.profile);
+
+    /* Write macro definitions until the first null terminated entry */
+    std::uint32_t numDefines = 0;
+    for (auto define = desc.defines; define != nullptr && define->name != nullptr; ++define)
+        ++numDefines;
+
+    call.Write(numDefines);
+    for (std::uint32_t i = 0; i < numDefines; ++i)
+    {
+        call.WriteString(desc.defines[i].name);
+        call.WriteString(desc.defines[i].definition);
+    }
+
+    call.Write(desc.flags);
+
+    /* Write shader reflection attributes */
+    CapWriteVertexAttribs(call, desc.vertex.inputAttribs.data(), desc.vertex.inputAttribs.size());
+    CapWriteVertexAttribs(call, desc.vertex.outputAttribs.data(), desc.vertex.outputAttribs.size());
+
+    call.Write(static_cast<std::uint32_t>(desc.fragment.outputAttribs.size()));
+    for (const auto& attrib : desc.fragment.outputAttribs)
+    {
+        call.WriteString(attrib.name.c_str());
+        call.Write(attrib.format, attrib.location, attrib.systemValue);
+    }
+
+    call.Write(desc.compute.workGroupSize);
+}
+
+void CapWriteResourceViews(CapCall& call, const ArrayView<ResourceViewDescriptor>& resourceViews)
+{
+    call.Write(static_cast<std::uint32_t>(resourceViews.size()));
+    for (const auto& rvDesc : resourceViews)
+    {
+        call.WriteObject(rvDesc.resource);
+        call.Write(rvDesc.textureView, rvDesc.bufferView, rvDesc.initialCount);
+    }
+}
+
+void CapWriteRenderTargetDesc(CapCall& call, const RenderTargetDescriptor& desc)
+{
+    call.WriteObject(desc.renderPass);
+    call.Write(desc.resolution, desc.samples, desc.customMultiSampling);
+    call.Write(static_cast<std::uint32_t>(desc.attachments.size()));
+    for (const auto& attachment : desc.attachments)
+    {
+        call.Write(attachment.type);
+        call.WriteObject(attachment.texture);
+        call.Write(attachment.mipLevel, attachment.arrayLayer, attachment.transient);
+    }
+    call.WriteObject(desc.shadingRateImage);
+}
+
+void CapWritePipelineLayoutDesc(CapCall& call, const PipelineLayoutDescriptor& desc)
+{
+    call.Write(static_cast<std::uint32_t>(desc.bindings.size()));
+    for (const auto& binding : desc.bindings)
+    {
+        call.WriteString(binding.name.c_str());
+        call.Write(binding.type, binding.bindFlags, binding.stageFlags, binding.slot, binding.arraySize, binding.flags);
+    }
+}
+
+void CapWriteGraphicsPipelineDesc(CapCall& call, const GraphicsPipelineDescriptor& desc)
+{
+    call.WriteObject(desc.pipelineLayout);
+    call.WriteObject(desc.renderPass);
+    call.Write(desc.subpass);
+    call.WriteObject(desc.vertexShader);
+    call.WriteObject(desc.tessControlShader);
+    call.WriteObject(desc.tessEvaluationShader);
+    call.WriteObject(desc.geometryShader);
+    call.WriteObject(desc.taskShader);
+    call.WriteObject(desc.meshShader);
+    call.WriteObject(desc.fragmentShader);
+    call.Write(desc.primitiveTopology);
+    call.WriteArray(desc.viewports.data(), desc.viewports.size());
+    call.WriteArray(desc.scissors.data(), desc.scissors.size());
+    call.Write(desc.depth, desc.stencil, desc.rasterizer, desc.blend, desc.tessellation);
+    call.WriteArray(desc.specializationConstants.data(), desc.specializationConstants.size());
+}
+
+void CapWriteComputePipelineDesc(CapCall& call, const ComputePipelineDescriptor& desc)
+{
+    call.WriteObject(desc.pipelineLayout);
+    call.WriteObject(desc.computeShader);
+    call.WriteArray(desc.specializationConstants.data(), desc.specializationConstants.size());
+}
+
+void CapReadBufferDesc(CapReader& reader, BufferDescriptor& outDesc, CapDescStorage& storage)
+{
+    outDesc.size            = reader.Read<std::uint64_t>();
+    outDesc.stride          = reader.Read<std::uint32_t>();
+    outDesc.format          = reader.Read<Format>();
+    outDesc.bindFlags       = reader.Read<long>();
+    outDesc.cpuAccessFlags  = reader.Read<long>();
+    outDesc.miscFlags       = reader.Read<long>();
+    CapReadVertexAttribs(reader, storage.vertexAttribs[0]);
+    outDesc.vertexAttribs   = storage.vertexAttribs[0];
+}
+
+void CapReadShaderDesc(CapReader& reader, ShaderDescriptor& outDesc, CapDescStorage& storage)
+{
+    outDesc.type        = reader.Read<ShaderType>();
+    outDesc.sourceType  = reader.Read<ShaderSourceType>();
+
+    std::size_t sourceSize = 0;
+    outDesc.source      = static_cast<const char*>(reader.ReadData(sourceSize));
+    outDesc.sourceSize  = (outDesc.sourceType == ShaderSourceType::CodeString && sourceSize > 0 ? sourceSize - 1 : sourceSize);
+
+    outDesc.entryPoint  = reader.ReadString();
+    outDesc.profile     = reader.ReadString();
+
+    /* Read macro definitions and terminate list with a null entry */
+    storage.defines.resize(reader.Read<std::uint32_t>());
+    for (auto& define : storage.defines)
+    {
+        define.name         = reader.ReadString();
+        define.definition   = reader.ReadString();
+    }
+    if (!storage.defines.empty())
+    {
+        storage.defines.push_back({});
+        outDesc.defines = storage.defines.data();
+    }
+
+    outDesc.flags = reader.Read<long>();
+
+    /* Read shader reflection attributes */
+    CapReadVertexAttribs(reader, outDesc.vertex.inputAttribs);
+    CapReadVertexAttribs(reader, outDesc.vertex.outputAttribs);
+
+    outDesc.fragment.outputAttribs.resize(reader.Read<std::uint32_t>());
+    for (auto& attrib : outDesc.fragment.outputAttribs)
+    {
+        if (auto name = reader.ReadString())
+            attrib.name = name;
+        attrib.format       = reader.Read<Format>();
+        attrib.location     = reader.Read<std::uint32_t>();
+        attrib.systemValue  = reader.Read<SystemValue>();
+    }
+
+    outDesc.compute.workGroupSize = reader.Read<Extent3D>();
+}
+
+void CapReadResourceViews(CapReader& reader, CapDescStorage& storage)
+{
+    storage.resourceViews.resize(reader.Read<std::uint32_t>());
+    for (auto& rvDesc : storage.resourceViews)
+    {
+        rvDesc.resource     = reader.ReadObject<Resource>();
+        rvDesc.textureView  = reader.Read<TextureViewDescriptor>();
+        rvDesc.bufferView   = reader.Read<BufferViewDescriptor>();
+        rvDesc.initialCount = reader.Read<std::uint32_t>();
+    }
+}
+
+void CapReadRenderTargetDesc(CapReader& reader, RenderTargetDescriptor& outDesc)
+{
+    outDesc.renderPass          = reader.ReadObject<RenderPass>();
+    outDesc.resolution          = reader.Read<Extent2D>();
+    outDesc.samples             = reader.Read<std::uint32_t>();
+    outDesc.customMultiSampling = reader.Read<bool>();
+    outDesc.attachments.resize(reader.Read<std::uint32_t>());
+    for (auto& attachment : outDesc.attachments)
+    {
+        attachment.type         = reader.Read<AttachmentType>();
+        attachment.texture      = reader.ReadObject<Texture>();
+        attachment.mipLevel     = reader.Read<std::uint32_t>();
+        attachment.arrayLayer   = reader.Read<std::uint32_t>();
+        attachment.transient    = reader.Read<bool>();
+    }
+    outDesc.shadingRateImage    = reader.ReadObject<Texture>();
+}
+
+void CapReadPipelineLayoutDesc(CapReader& reader, PipelineLayoutDescriptor& outDesc)
+{
+    outDesc.bindings.resize(reader.Read<std::uint32_t>());
+    for (auto& binding : outDesc.bindings)
+    {
+        if (auto name = reader.ReadString())
+            binding.name = name;
+        binding.type        = reader.Read<ResourceType>();
+        binding.bindFlags   = reader.Read<long>();
+        binding.stageFlags  = reader.Read<long>();
+        binding.slot        = reader.Read<std::uint32_t>();
+        binding.arraySize   = reader.Read<std::uint32_t>();
+        binding.flags       = reader.Read<long>();
+    }
+}
+
+void CapReadGraphicsPipelineDesc(CapReader& reader, GraphicsPipelineDescriptor& outDesc)
+{
+    outDesc.pipelineLayout          = reader.ReadObject<PipelineLayout>();
+    outDesc.renderPass              = reader.ReadObject<RenderPass>();
+    outDesc.subpass                 = reader.Read<std::uint32_t>();
+    outDesc.vertexShader            = reader.ReadObject<Shader>();
+    outDesc.tessControlShader       = reader.ReadObject<Shader>();
+    outDesc.tessEvaluationShader    = reader.ReadObject<Shader>();
+    outDesc.geometryShader          = reader.ReadObject<Shader>();
+    outDesc.taskShader              = reader.ReadObject<Shader>();
+    outDesc.meshShader              = reader.ReadObject<Shader>();
+    outDesc.fragmentShader          = reader.ReadObject<Shader>();
+    outDesc.primitiveTopology       = reader.Read<PrimitiveTopology>();
+    reader.ReadArray(outDesc.viewports);
+    reader.ReadArray(outDesc.scissors);
+    outDesc.depth                   = reader.Read<DepthDescriptor>();
+    outDesc.stencil                 = reader.Read<StencilDescriptor>();
+    outDesc.rasterizer              = reader.Read<RasterizerDescriptor>();
+    outDesc.blend                   = reader.Read<BlendDescriptor>();
+    outDesc.tessellation            = reader.Read<TessellationDescriptor>();
+    reader.ReadArray(outDesc.specializationConstants);
+}
+
+void CapReadComputePipelineDesc(CapReader& reader, ComputePipelineDescriptor& outDesc)
+{
+    outDesc.pipelineLayout  = reader.ReadObject<PipelineLayout>();
+    outDesc.computeShader   = reader.ReadObject<Shader>();
+    reader.ReadArray(outDesc.specializationConstants);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,344 @@
+/*
+ * CapSerialization.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CAP_SERIALIZATION_H
+#define LLGL_CAP_SERIALIZATION_H
+
+
+#include "../Serialization.h"
+#include <LLGL/RenderSystem.h>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/* ----- Enumerations ----- */
+
+// Segment identifiers of a capture file. Each segment is a single API call; objects are referred to by their capture ID.
+enum CapIdent : Serialization::IdentType
+{
+    CapIdent_Header = 1,
+
+    /* RenderSystem */
+    CapIdent_CreateSwapChain,
+    CapIdent_CreateCommandBuffer,
+    CapIdent_CreateBuffer,
+    CapIdent_CreateBufferArray,
+    CapIdent_WriteBuffer,
+    CapIdent_WriteBufferRegions,
+    CapIdent_CreateTexture,
+    CapIdent_WriteTexture,
+    CapIdent_CommitTextureTiles,
+    CapIdent_DecommitTextureTiles,
+    CapIdent_CreateSampler,
+    CapIdent_CreateResourceHeap,
+    CapIdent_WriteResourceHeap,
+    CapIdent_CreateRenderPass,
+    CapIdent_CreateRenderTarget,
+    CapIdent_CreateShader,
+    CapIdent_CreatePipelineLayout,
+    CapIdent_CreateGraphicsPipeline,
+    CapIdent_CreateComputePipeline,
+    CapIdent_CreateQueryHeap,
+    CapIdent_CreateFence,
+    CapIdent_GetRenderPass,
+    CapIdent_Release,
+
+    /* SwapChain */
+    CapIdent_Present,
+    CapIdent_ResizeBuffers,
+    CapIdent_SetVsyncInterval,
+    CapIdent_WaitForNextFrame,
+
+    /* CommandQueue */
+    CapIdent_Submit,
+    CapIdent_SubmitFence,
+    CapIdent_WaitFence,
+    CapIdent_WaitFenceValue,
+    CapIdent_WaitIdle,
+
+    /* CommandBuffer */
+    CapIdent_Begin,
+    CapIdent_End,
+    CapIdent_Execute,
+    CapIdent_UpdateBuffer,
+    CapIdent_UpdateBufferRegions,
+    CapIdent_CopyBuffer,
+    CapIdent_CopyBufferRegions,
+    CapIdent_CopyBufferFromTexture,
+    CapIdent_FillBuffer,
+    CapIdent_CopyTexture,
+    CapIdent_CopyTextureRegions,
+    CapIdent_CopyTextureFromBuffer,
+    CapIdent_GenerateMips,
+    CapIdent_GenerateMipsRange,
+    CapIdent_SetViewports,
+    CapIdent_SetScissors,
+    CapIdent_SetVertexBuffer,
+    CapIdent_SetVertexBufferArray,
+    CapIdent_SetIndexBuffer,
+    CapIdent_SetIndexBufferFormat,
+    CapIdent_SetResourceHeap,
+    CapIdent_SetResource,
+    CapIdent_ResetResourceSlots,
+    CapIdent_BeginRenderPass,
+    CapIdent_EndRenderPass,
+    CapIdent_NextSubpass,
+    CapIdent_Clear,
+    CapIdent_ClearAttachments,
+    CapIdent_SetPipelineState,
+    CapIdent_SetBlendFactor,
+    CapIdent_SetStencilReference,
+    CapIdent_SetShadingRate,
+    CapIdent_SetUniforms,
+    CapIdent_BeginQuery,
+    CapIdent_EndQuery,
+    CapIdent_ResolveQueries,
+    CapIdent_BeginRenderCondition,
+    CapIdent_EndRenderCondition,
+    CapIdent_BeginStreamOutput,
+    CapIdent_EndStreamOutput,
+    CapIdent_Draw,
+    CapIdent_DrawIndexed,
+    CapIdent_DrawInstanced,
+    CapIdent_DrawIndexedInstanced,
+    CapIdent_DrawIndirect,
+    CapIdent_DrawIndexedIndirect,
+    CapIdent_DrawIndirectCount,
+    CapIdent_DrawIndexedIndirectCount,
+    CapIdent_DrawPatchable,
+    CapIdent_DrawIndexedPatchable,
+    CapIdent_PatchDraw,
+    CapIdent_PatchDrawIndexed,
+    CapIdent_DrawMeshTasks,
+    CapIdent_DrawMeshTasksIndirect,
+    CapIdent_Dispatch,
+    CapIdent_DispatchIndirect,
+    CapIdent_PushDebugGroup,
+    CapIdent_PopDebugGroup,
+};
+
+// Object types of a capture file. This determines which RenderSystem::Release function is called during replay.
+enum class CapObjectType : std::uint8_t
+{
+    Undefined = 0,
+    SwapChain,
+    CommandBuffer,
+    Buffer,
+    BufferArray,
+    Texture,
+    Sampler,
+    ResourceHeap,
+    RenderPass,
+    RenderTarget,
+    Shader,
+    PipelineLayout,
+    PipelineState,
+    QueryHeap,
+    Fence,
+};
+
+
+/* ----- Constants ----- */
+
+// Magic number at the beginning of each capture file ("LLGLCAP" with a null terminator).
+static const char           g_capMagic[8]       = { 'L', 'L', 'G', 'L', 'C', 'A', 'P', '\0' };
+
+// Version of the capture file format. Files with a different version are rejected by the replay.
+static const std::uint32_t  g_capFormatVersion  = 10;
+
+
+/* ----- Classes ----- */
+
+// Writes API calls into a capture file. All calls are serialized in the order they are made, even across threads.
+class CapWriter
+{
+
+    public:
+
+        // Opens the capture file and writes the header segment. Throws std::runtime_error if the file cannot be created.
+        CapWriter(const char* filename, const char* moduleName);
+        ~CapWriter();
+
+        CapWriter(const CapWriter&) = delete;
+        CapWriter& operator = (const CapWriter&) = delete;
+
+        // Writes all pending segments into the capture file. This is called once per frame, so a capture remains readable up to its last presented frame.
+        void Flush();
+
+        // Assigns a new capture ID to the specified object and returns it.
+        std::uint32_t RegisterObject(const RenderSystemChild* object);
+
+        // Removes the specified object from the ID map and returns its previous ID, or 0 if the object was not registered.
+        std::uint32_t UnregisterObject(const RenderSystemChild* object);
+
+        // Returns the capture ID of the specified object or 0 if the object is null or unknown.
+        std::uint32_t GetObjectID(const RenderSystemChild* object) const;
+
+    private:
+
+        friend class CapCall;
+
+    private:
+
+        std::ofstream                                               file_;
+        Serialization::Serializer                                   serializer_;
+        std::recursive_mutex                                        mutex_;
+        std::unordered_map<const RenderSystemChild*, std::uint32_t> objectIDs_;
+        std::uint32_t                                               nextObjectID_   = 1;
+
+};
+
+// Scope for a single API call within a capture file. The capture writer is locked until the end of this scope.
+class CapCall
+{
+
+    public:
+
+        CapCall(CapWriter& writer, CapIdent ident);
+
+        // Begins a call that is made on the specified object, e.g. a command buffer or swap-chain. The capture ID of that object is written first.
+        CapCall(CapWriter& writer, CapIdent ident, const RenderSystemChild* owner);
+        ~CapCall();
+
+        CapCall(const CapCall&) = delete;
+        CapCall& operator = (const CapCall&) = delete;
+
+        // Writes a standard layout value.
+        template <typename T>
+        void Write(const T& value)
+        {
+            writer_.serializer_.WriteTyped(value);
+        }
+
+        // Writes all standard layout values in the specified order.
+        template <typename T0, typename T1, typename... TRest>
+        void Write(const T0& value0, const T1& value1, const TRest&... rest)
+        {
+            Write(value0);
+            Write(value1, rest...);
+        }
+
+        // Writes a data block with its size.
+        void WriteData(const void* data, std::size_t size);
+
+        // Writes an optional null terminated string.
+        void WriteString(const char* str);
+
+        // Writes the capture ID of the specified object.
+        void WriteObject(const RenderSystemChild* object);
+
+        // Writes the array size followed by all standard layout elements.
+        template <typename T>
+        void WriteArray(const T* data, std::size_t count)
+        {
+            Write(static_cast<std::uint32_t>(count));
+            for (std::size_t i = 0; i < count; ++i)
+                Write(data[i]);
+        }
+
+    private:
+
+        CapWriter&                              writer_;
+        std::lock_guard<std::recursive_mutex>   guard_;
+
+};
+
+// Reads API calls from a capture file and resolves capture IDs to the objects that have been created during the replay.
+class CapReader
+{
+
+    public:
+
+        CapReader(Serialization::Deserializer& reader, const std::vector<RenderSystemChild*>& objects);
+
+        template <typename T>
+        T Read()
+        {
+            T value;
+            reader_.ReadTyped(value);
+            return value;
+        }
+
+        // Reads a data block and returns a pointer into the capture file.
+        const void* ReadData(std::size_t& outSize);
+
+        // Reads an optional null terminated string. Returns null if the string was not present.
+        const char* ReadString();
+
+        // Reads a capture ID and returns the respective replayed object, or null if the ID could not be resolved.
+        template <typename T>
+        T* ReadObject()
+        {
+            return static_cast<T*>(ReadObjectBase());
+        }
+
+        // Reads an array size followed by all standard layout elements.
+        template <typename T>
+        void ReadArray(std::vector<T>& outArray)
+        {
+            outArray.resize(Read<std::uint32_t>());
+            for (auto& element : outArray)
+                element = Read<T>();
+        }
+
+    private:
+
+        RenderSystemChild* ReadObjectBase();
+
+    private:
+
+        Serialization::Deserializer&            reader_;
+        const std::vector<RenderSystemChild*>&  objects_;
+
+};
+
+// Storage for the strings and arrays that the descriptors read from a capture file refer to.
+struct CapDescStorage
+{
+    std::vector<VertexAttribute>        vertexAttribs[2];
+    std::vector<FragmentAttribute>      fragmentAttribs;
+    std::vector<ShaderMacro>            defines;
+    std::vector<ResourceViewDescriptor> resourceViews;
+    std::vector<Buffer*>                buffers;
+};
+
+
+/* ----- Functions ----- */
+
+void CapWriteBufferDesc(CapCall& call, const BufferDescriptor& desc);
+void CapWriteShaderDesc(CapCall& call, const ShaderDescriptor& desc);
+void CapWriteResourceViews(CapCall& call, const ArrayView<ResourceViewDescriptor>& resourceViews);
+void CapWriteRenderTargetDesc(CapCall& call, const RenderTargetDescriptor& desc);
+void CapWritePipelineLayoutDesc(CapCall& call, const PipelineLayoutDescriptor& desc);
+void CapWriteGraphicsPipelineDesc(CapCall& call, const GraphicsPipelineDescriptor& desc);
+void CapWriteComputePipelineDesc(CapCall& call, const ComputePipelineDescriptor& desc);
+
+void CapReadBufferDesc(CapReader& reader, BufferDescriptor& outDesc, CapDescStorage& storage);
+void CapReadShaderDesc(CapReader& reader, ShaderDescriptor& outDesc, CapDescStorage& storage);
+void CapReadResourceViews(CapReader& reader, CapDescStorage& storage);
+void CapReadRenderTargetDesc(CapReader& reader, RenderTargetDescriptor& outDesc);
+void CapReadPipelineLayoutDesc(CapReader& reader, PipelineLayoutDescriptor& outDesc);
+void CapReadGraphicsPipelineDesc(CapReader& reader, GraphicsPipelineDescriptor& outDesc);
+void CapReadComputePipelineDesc(CapReader& reader, ComputePipelineDescriptor& outDesc);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
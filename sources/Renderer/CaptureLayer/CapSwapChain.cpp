@@ -0,0 +1,121 @@
+/*
+ * CapSwapChain.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "CapSwapChain.h"
+#include "CapSerialization.h"
+#include "../CheckedCast.h"
+#include <LLGL/TypeInfo.h>
+
+
+namespace LLGL
+{
+
+
+CapSwapChain::CapSwapChain(SwapChain& instance, CapWriter& writer) :
+    instance { instance },
+    writer_  { writer   }
+{
+    ShareSurfaceAndConfig(instance);
+}
+
+void CapSwapChain::SetName(const char* name)
+{
+    instance.SetName(name);
+}
+
+void CapSwapChain::Present()
+{
+    {
+        CapCall call{ writer_, CapIdent_Present, this };
+    }
+    instance.Present();
+
+    /* Flush capture file once per frame, so it remains readable if the application terminates unexpectedly */
+    writer_.Flush();
+}
+
+void CapSwapChain::WaitForNextFrame()
+{
+    {
+        CapCall call{ writer_, CapIdent_WaitForNextFrame, this };
+    }
+    instance.WaitForNextFrame();
+}
+
+bool CapSwapChain::QueryPresentStatistics(PresentStatistics& outStats)
+{
+    return instance.QueryPresentStatistics(outStats);
+}
+
+bool CapSwapChain::SetDamageRegions(std::uint32_t numRegions, const Scissor* regions)
+{
+    return instance.SetDamageRegions(numRegions, regions);
+}
+
+std::uint32_t CapSwapChain::QueryBufferAge()
+{
+    return instance.QueryBufferAge();
+}
+
+std::uint32_t CapSwapChain::GetSamples() const
+{
+    return instance.GetSamples();
+}
+
+Format CapSwapChain::GetColorFormat() const
+{
+    return instance.GetColorFormat();
+}
+
+Format CapSwapChain::GetDepthStencilFormat() const
+{
+    return instance.GetDepthStencilFormat();
+}
+
+bool CapSwapChain::SetVsyncInterval(std::uint32_t vsyncInterval)
+{
+    {
+        CapCall call{ writer_, CapIdent_SetVsyncInterval, this };
+        call.Write(vsyncInterval);
+    }
+    return instance.SetVsyncInterval(vsyncInterval);
+}
+
+const RenderPass* CapSwapChain::GetRenderPass() const
+{
+    return instance.GetRenderPass();
+}
+
+bool CapSwapChain::ResizeBuffersPrimary(const Extent2D& resolution)
+{
+    {
+        CapCall call{ writer_, CapIdent_ResizeBuffers, this };
+        call.Write(resolution);
+    }
+    return instance.ResizeBuffers(resolution);
+}
+
+
+/*
+ * Global functions
+ */
+
+RenderTarget* GetCapRenderTargetInstance(RenderTarget* renderTarget)
+{
+    /* Only swap-chains are wrapped by the capture layer; all other render targets are native objects */
+    if (renderTarget != nullptr && IsInstanceOf<SwapChain>(*renderTarget))
+        return &(LLGL_CAST(CapSwapChain*, renderTarget)->instance);
+    else
+        return renderTarget;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
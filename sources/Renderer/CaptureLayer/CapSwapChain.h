@@ -0,0 +1,73 @@
+/*
+ * CapSwapChain.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CAP_SWAP_CHAIN_H
+#define LLGL_CAP_SWAP_CHAIN_H
+
+
+#include <LLGL/SwapChain.h>
+
+
+namespace LLGL
+{
+
+
+class CapWriter;
+
+class CapSwapChain final : public SwapChain
+{
+
+    public:
+
+        void SetName(const char* name) override;
+
+        void Present() override;
+        void WaitForNextFrame() override;
+        bool QueryPresentStatistics(PresentStatistics& outStats) override;
+        bool SetDamageRegions(std::uint32_t numRegions, const Scissor* regions) override;
+        std::uint32_t QueryBufferAge() override;
+
+        std::uint32_t GetSamples() const override;
+
+        Format GetColorFormat() const override;
+        Format GetDepthStencilFormat() const override;
+
+        bool SetVsyncInterval(std::uint32_t vsyncInterval) override;
+
+        const RenderPass* GetRenderPass() const override;
+
+    public:
+
+        CapSwapChain(SwapChain& instance, CapWriter& writer);
+
+    public:
+
+        SwapChain& instance;
+
+    private:
+
+        bool ResizeBuffersPrimary(const Extent2D& resolution) override;
+
+    private:
+
+        CapWriter& writer_;
+
+};
+
+
+// Returns the instance of the specified render target if it is a capture layer swap-chain, or the render target itself otherwise.
+RenderTarget* GetCapRenderTargetInstance(RenderTarget* renderTarget);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
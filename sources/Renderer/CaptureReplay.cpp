@@ -0,0 +1,1146 @@
+/*
+ * CaptureReplay.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/CaptureReplay.h>
+#include <LLGL/RenderSystem.h>
+#include <LLGL/Version.h>
+#include <LLGL/Timer.h>
+#include "CaptureLayer/CapSerialization.h"
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Pimpl structure
+ */
+
+struct CaptureReplay::Pimpl
+{
+    Pimpl(RenderSystem& renderSystem, const char* filename);
+    ~Pimpl();
+
+    // Reads the header segment and throws an exception if the capture is incompatible with this version of LLGL.
+    void ReadHeader();
+
+    // Replays the next segment. Returns false if the end of the capture has been reached.
+    bool ReplayNextCall(bool& outPresented);
+
+    void ReplayCommand(CapIdent ident, CapReader& reader, CommandBuffer& cmdBuffer);
+
+    template <typename T>
+    T* Store(std::uint32_t id, CapObjectType type, T* object);
+
+    void Release(std::uint32_t id);
+    void ReleaseAll();
+
+    RenderSystem&                                               renderSystem;
+    CommandQueue*                                               commandQueue    = nullptr;
+    std::unique_ptr<Blob>                                       blob;
+    Serialization::Deserializer                                 reader;
+    std::string                                                 moduleName;
+
+    std::vector<RenderSystemChild*>                             objects;
+    std::vector<CapObjectType>                                  objectTypes;
+
+    // Maps the patch slots of the capture to the patch slots of the replayed command buffers.
+    std::map<std::pair<CommandBuffer*, std::uint32_t>, std::uint32_t> patchSlots;
+
+    std::uint32_t                                               frameIndex      = 0;
+    std::uint64_t                                               lastFrameTicks  = 0;
+    bool                                                        endOfCapture    = false;
+};
+
+CaptureReplay::Pimpl::Pimpl(RenderSystem& renderSystem, const char* filename) :
+    renderSystem { renderSystem                             },
+    commandQueue { renderSystem.GetCommandQueue()           },
+    blob         { Blob::CreateFromFileMapping(filename)    }
+{
+    if (!blob)
+        throw std::runtime_error("failed to read capture file: " + std::string(filename));
+    reader = Serialization::Deserializer{ *blob };
+    ReadHeader();
+}
+
+CaptureReplay::Pimpl::~Pimpl()
+{
+    ReleaseAll();
+}
+
+void CaptureReplay::Pimpl::ReadHeader()
+{
+    reader.Begin(CapIdent_Header);
+    CapReader header{ reader, objects };
+
+    char magic[sizeof(g_capMagic)];
+    reader.Read(magic, sizeof(magic));
+    if (std::memcmp(magic, g_capMagic, sizeof(magic)) != 0)
+        throw std::runtime_error("invalid capture file: magic number mismatch");
+
+    const auto formatVersion = header.Read<std::uint32_t>();
+    if (formatVersion != g_capFormatVersion)
+        throw std::runtime_error("capture file format version mismatch: " + std::to_string(formatVersion));
+
+    /* Descriptors are stored with their memory layout, so the capture must have been written with the same version of LLGL */
+    const auto versionID = header.Read<std::uint32_t>();
+    if (versionID != static_cast<std::uint32_t>(Version::GetID()))
+        throw std::runtime_error("capture file has been written with a different version of LLGL: " + std::to_string(versionID));
+
+    if (auto name = header.ReadString())
+        moduleName = name;
+
+    reader.End();
+}
+
+template <typename T>
+T* CaptureReplay::Pimpl::Store(std::uint32_t id, CapObjectType type, T* object)
+{
+    if (id >= objects.size())
+    {
+        objects.resize(id + 1, nullptr);
+        objectTypes.resize(id + 1, CapObjectType::Undefined);
+    }
+    objects[id]     = object;
+    objectTypes[id] = type;
+    return object;
+}
+
+void CaptureReplay::Pimpl::Release(std::uint32_t id)
+{
+    if (id >= objects.size() || objects[id] == nullptr)
+        return;
+
+    auto object = objects[id];
+    switch (objectTypes[id])
+    {
+        case CapObjectType::Undefined:      break; // Owned by another object
+        case CapObjectType::SwapChain:      renderSystem.Release(*static_cast<SwapChain*>(object));         break;
+        case CapObjectType::CommandBuffer:  renderSystem.Release(*static_cast<CommandBuffer*>(object));     break;
+        case CapObjectType::Buffer:         renderSystem.Release(*static_cast<Buffer*>(object));            break;
+        case CapObjectType::BufferArray:    renderSystem.Release(*static_cast<BufferArray*>(object));       break;
+        case CapObjectType::Texture:        renderSystem.Release(*static_cast<Texture*>(object));           break;
+        case CapObjectType::Sampler:        renderSystem.Release(*static_cast<Sampler*>(object));           break;
+        case CapObjectType::ResourceHeap:   renderSystem.Release(*static_cast<ResourceHeap*>(object));      break;
+        case CapObjectType::RenderPass:     renderSystem.Release(*static_cast<RenderPass*>(object));        break;
+        case CapObjectType::RenderTarget:   renderSystem.Release(*static_cast<RenderTarget*>(object));      break;
+        case CapObjectType::Shader:         renderSystem.Release(*static_cast<Shader*>(object));            break;
+        case CapObjectType::PipelineLayout: renderSystem.Release(*static_cast<PipelineLayout*>(object));    break;
+        case CapObjectType::PipelineState:  renderSystem.Release(*static_cast<PipelineState*>(object));     break;
+        case CapObjectType::QueryHeap:      renderSystem.Release(*static_cast<QueryHeap*>(object));         break;
+        case CapObjectType::Fence:          renderSystem.Release(*static_cast<Fence*>(object));             break;
+    }
+
+    objects[id]     = nullptr;
+    objectTypes[id] = CapObjectType::Undefined;
+}
+
+void CaptureReplay::Pimpl::ReleaseAll()
+{
+    /* Release objects in reverse order of their creation, so dependent objects are released first */
+    if (commandQueue != nullptr)
+        commandQueue->WaitIdle();
+    for (auto id = objects.size(); id > 0; --id)
+        Release(static_cast<std::uint32_t>(id - 1));
+    objects.clear();
+    objectTypes.clear();
+    patchSlots.clear();
+}
+
+bool CaptureReplay::Pimpl::ReplayNextCall(bool& outPresented)
+{
+    const auto seg = reader.Begin();
+    if (seg.ident == 0)
+        return false;
+
+    CapReader call{ reader, objects };
+    CapDescStorage storage;
+
+    switch (static_cast<CapIdent>(seg.ident))
+    {
+        /* ----- RenderSystem ----- */
+
+        case CapIdent_CreateSwapChain:
+        {
+            const auto id = call.Read<std::uint32_t>();
+            Store(id, CapObjectType::SwapChain, renderSystem.CreateSwapChain(call.Read<SwapChainDescriptor>()));
+            if (commandQueue == nullptr)
+                commandQueue = renderSystem.GetCommandQueue();
+        }
+        break;
+
+        case CapIdent_CreateCommandBuffer:
+        {
+            const auto id = call.Read<std::uint32_t>();
+            CommandBufferDescriptor desc;
+            {
+                desc.flags              = call.Read<long>();
+                desc.numNativeBuffers   = call.Read<std::uint32_t>();
+                desc.renderTarget       = call.ReadObject<RenderTarget>();
+            }
+            Store(id, CapObjectType::CommandBuffer, renderSystem.CreateCommandBuffer(desc));
+        }
+        break;
+
+        case CapIdent_CreateBuffer:
+        {
+            const auto id = call.Read<std::uint32_t>();
+            BufferDescriptor desc;
+            CapReadBufferDesc(call, desc, storage);
+            std::size_t dataSize = 0;
+            auto initialData = call.ReadData(dataSize);
+            Store(id, CapObjectType::Buffer, renderSystem.CreateBuffer(desc, initialData));
+        }
+        break;
+
+        case CapIdent_CreateBufferArray:
+        {
+            const auto id = call.Read<std::uint32_t>();
+            storage.buffers.resize(call.Read<std::uint32_t>());
+            for (auto& buffer : storage.buffers)
+                buffer = call.ReadObject<Buffer>();
+            std::vector<std::uint64_t> offsets;
+            if (call.Read<bool>())
+            {
+                offsets.resize(storage.buffers.size());
+                for (auto& offset : offsets)
+                    offset = call.Read<std::uint64_t>();
+            }
+            Store(
+                id,
+                CapObjectType::BufferArray,
+                renderSystem.CreateBufferArray(
+                    static_cast<std::uint32_t>(storage.buffers.size()),
+                    storage.buffers.data(),
+                    (offsets.empty() ? nullptr : offsets.data())
+                )
+            );
+        }
+        break;
+
+        case CapIdent_WriteBuffer:
+        {
+            auto buffer = call.ReadObject<Buffer>();
+            const auto offset = call.Read<std::uint64_t>();
+            std::size_t dataSize = 0;
+            auto data = call.ReadData(dataSize);
+            if (buffer != nullptr && data != nullptr)
+                renderSystem.WriteBuffer(*buffer, offset, data, dataSize);
+        }
+        break;
+
+        case CapIdent_WriteBufferRegions:
+        {
+            auto buffer = call.ReadObject<Buffer>();
+            std::vector<BufferWriteRegion> regions(call.Read<std::uint32_t>());
+            for (auto& region : regions)
+            {
+                std::size_t dataSize = 0;
+                region.dstOffset    = call.Read<std::uint64_t>();
+                region.data         = call.ReadData(dataSize);
+                region.dataSize     = dataSize;
+            }
+            if (buffer != nullptr)
+                renderSystem.WriteBuffer(*buffer, static_cast<std::uint32_t>(regions.size()), regions.data());
+        }
+        break;
+
+        case CapIdent_CreateTexture:
+        {
+            const auto id = call.Read<std::uint32_t>();
+            const auto desc = call.Read<TextureDescriptor>();
+            SrcImageDescriptor imageDesc;
+            {
+                imageDesc.format    = call.Read<ImageFormat>();
+                imageDesc.dataType  = call.Read<DataType>();
+                imageDesc.data      = call.ReadData(imageDesc.dataSize);
+            }
+            Store(id, CapObjectType::Texture, renderSystem.CreateTexture(desc, (imageDesc.data != nullptr ? &imageDesc : nullptr)));
+        }
+        break;
+
+        case CapIdent_WriteTexture:
+        {
+            auto texture = call.ReadObject<Texture>();
+            const auto region = call.Read<TextureRegion>();
+            SrcImageDescriptor imageDesc;
+            {
+                imageDesc.format        = call.Read<ImageFormat>();
+                imageDesc.dataType      = call.Read<DataType>();
+                imageDesc.rowStride     = call.Read<std::uint32_t>();
+                imageDesc.layerStride   = call.Read<std::uint32_t>();
+                imageDesc.data          = call.ReadData(imageDesc.dataSize);
+            }
+            if (texture != nullptr)
+                renderSystem.WriteTexture(*texture, region, imageDesc);
+        }
+        break;
+
+        case CapIdent_CommitTextureTiles:
+        {
+            auto texture = call.ReadObject<Texture>();
+            const auto region = call.Read<TextureRegion>();
+            if (texture != nullptr)
+                renderSystem.CommitTextureTiles(*texture, region);
+        }
+        break;
+
+        case CapIdent_DecommitTextureTiles:
+        {
+            auto texture = call.ReadObject<Texture>();
+            const auto region = call.Read<TextureRegion>();
+            if (texture != nullptr)
+                renderSystem.DecommitTextureTiles(*texture, region);
+        }
+        break;
+
+        case CapIdent_CreateSampler:
+        {
+            const auto id = call.Read<std::uint32_t>();
+            Store(id, CapObjectType::Sampler, renderSystem.CreateSampler(call.Read<SamplerDescriptor>()));
+        }
+        break;
+
+        case CapIdent_CreateResourceHeap:
+        {
+            const auto id = call.Read<std::uint32_t>();
+            ResourceHeapDescriptor desc;
+            {
+                desc.pipelineLayout     = call.ReadObject<PipelineLayout>();
+                desc.numResourceViews   = call.Read<std::uint32_t>();
+                desc.barrierFlags       = call.Read<long>();
+                desc.bindlessSlot       = call.Read<std::uint32_t>();
+                desc.transient          = call.Read<bool>();
+            }
+            CapReadResourceViews(call, storage);
+            Store(id, CapObjectType::ResourceHeap, renderSystem.CreateResourceHeap(desc, storage.resourceViews));
+        }
+        break;
+
+        case CapIdent_WriteResourceHeap:
+        {
+            auto resourceHeap = call.ReadObject<ResourceHeap>();
+            const auto firstDescriptor = call.Read<std::uint32_t>();
+            CapReadResourceViews(call, storage);
+            if (resourceHeap != nullptr)
+                renderSystem.WriteResourceHeap(*resourceHeap, firstDescriptor, storage.resourceViews);
+        }
+        break;
+
+        case CapIdent_CreateRenderPass:
+        {
+            const auto id = call.Read<std::uint32_t>();
+            Store(id, CapObjectType::RenderPass, renderSystem.CreateRenderPass(call.Read<RenderPassDescriptor>()));
+        }
+        break;
+
+        case CapIdent_CreateRenderTarget:
+        {
+            const auto id = call.Read<std::uint32_t>();
+            RenderTargetDescriptor desc;
+            CapReadRenderTargetDesc(call, desc);
+            Store(id, CapObjectType::RenderTarget, renderSystem.CreateRenderTarget(desc));
+        }
+        break;
+
+        case CapIdent_CreateShader:
+        {
+            const auto id = call.Read<std::uint32_t>();
+            ShaderDescriptor desc;
+            CapReadShaderDesc(call, desc, storage);
+            Store(id, CapObjectType::Shader, renderSystem.CreateShader(desc));
+        }
+        break;
+
+        case CapIdent_CreatePipelineLayout:
+        {
+            const auto id = call.Read<std::uint32_t>();
+            PipelineLayoutDescriptor desc;
+            CapReadPipelineLayoutDesc(call, desc);
+            Store(id, CapObjectType::PipelineLayout, renderSystem.CreatePipelineLayout(desc));
+        }
+        break;
+
+        case CapIdent_CreateGraphicsPipeline:
+        {
+            const auto id = call.Read<std::uint32_t>();
+            GraphicsPipelineDescriptor desc;
+            CapReadGraphicsPipelineDesc(call, desc);
+            Store(id, CapObjectType::PipelineState, renderSystem.CreatePipelineState(desc));
+        }
+        break;
+
+        case CapIdent_CreateComputePipeline:
+        {
+            const auto id = call.Read<std::uint32_t>();
+            ComputePipelineDescriptor desc;
+            CapReadComputePipelineDesc(call, desc);
+            Store(id, CapObjectType::PipelineState, renderSystem.CreatePipelineState(desc));
+        }
+        break;
+
+        case CapIdent_CreateQueryHeap:
+        {
+            const auto id = call.Read<std::uint32_t>();
+            Store(id, CapObjectType::QueryHeap, renderSystem.CreateQueryHeap(call.Read<QueryHeapDescriptor>()));
+        }
+        break;
+
+        case CapIdent_CreateFence:
+        {
+            const auto id = call.Read<std::uint32_t>();
+            Store(id, CapObjectType::Fence, renderSystem.CreateFence());
+        }
+        break;
+
+        case CapIdent_GetRenderPass:
+        {
+            /* Render passes of swap-chains and render targets are owned by those objects, so they are stored with an undefined type */
+            const auto id = call.Read<std::uint32_t>();
+            if (auto owner = call.ReadObject<RenderTarget>())
+                Store(id, CapObjectType::Undefined, const_cast<RenderPass*>(owner->GetRenderPass()));
+        }
+        break;
+
+        case CapIdent_Release:
+        {
+            Release(call.Read<std::uint32_t>());
+        }
+        break;
+
+        /* ----- SwapChain ----- */
+
+        case CapIdent_Present:
+        {
+            if (auto swapChain = call.ReadObject<SwapChain>())
+                swapChain->Present();
+            outPresented = true;
+        }
+        break;
+
+        case CapIdent_ResizeBuffers:
+        {
+            auto swapChain = call.ReadObject<SwapChain>();
+            const auto resolution = call.Read<Extent2D>();
+            if (swapChain != nullptr)
+                swapChain->ResizeBuffers(resolution);
+        }
+        break;
+
+        case CapIdent_SetVsyncInterval:
+        {
+            auto swapChain = call.ReadObject<SwapChain>();
+            const auto vsyncInterval = call.Read<std::uint32_t>();
+            if (swapChain != nullptr)
+                swapChain->SetVsyncInterval(vsyncInterval);
+        }
+        break;
+
+        case CapIdent_WaitForNextFrame:
+        {
+            if (auto swapChain = call.ReadObject<SwapChain>())
+                swapChain->WaitForNextFrame();
+        }
+        break;
+
+        /* ----- CommandQueue ----- */
+
+        case CapIdent_Submit:
+        {
+            std::vector<CommandBuffer*> cmdBuffers(call.Read<std::uint32_t>());
+            for (auto& cmdBuffer : cmdBuffers)
+                cmdBuffer = call.ReadObject<CommandBuffer>();
+            if (cmdBuffers.size() == 1 && cmdBuffers[0] != nullptr)
+                commandQueue->Submit(*cmdBuffers[0]);
+            else if (!cmdBuffers.empty())
+                commandQueue->Submit(static_cast<std::uint32_t>(cmdBuffers.size()), cmdBuffers.data());
+        }
+        break;
+
+        case CapIdent_SubmitFence:
+        {
+            if (auto fence = call.ReadObject<Fence>())
+                commandQueue->Submit(*fence);
+        }
+        break;
+
+        case CapIdent_WaitFence:
+        {
+            auto fence = call.ReadObject<Fence>();
+            const auto timeout = call.Read<std::uint64_t>();
+            if (fence != nullptr)
+                commandQueue->WaitFence(*fence, timeout);
+        }
+        break;
+
+        case CapIdent_WaitFenceValue:
+        {
+            auto fence = call.ReadObject<Fence>();
+            const auto value = call.Read<std::uint64_t>();
+            const auto timeout = call.Read<std::uint64_t>();
+            if (fence != nullptr)
+                commandQueue->WaitFenceValue(*fence, value, timeout);
+        }
+        break;
+
+        case CapIdent_WaitIdle:
+        {
+            commandQueue->WaitIdle();
+        }
+        break;
+
+        /* ----- CommandBuffer ----- */
+
+        default:
+        {
+            if (auto cmdBuffer = call.ReadObject<CommandBuffer>())
+                ReplayCommand(static_cast<CapIdent>(seg.ident), call, *cmdBuffer);
+        }
+        break;
+    }
+
+    reader.End();
+    return true;
+}
+
+void CaptureReplay::Pimpl::ReplayCommand(CapIdent ident, CapReader& call, CommandBuffer& cmdBuffer)
+{
+    switch (ident)
+    {
+        case CapIdent_Begin:
+            cmdBuffer.Begin();
+            break;
+
+        case CapIdent_End:
+            cmdBuffer.End();
+            break;
+
+        case CapIdent_Execute:
+        {
+            if (auto deferredCmdBuffer = call.ReadObject<CommandBuffer>())
+                cmdBuffer.Execute(*deferredCmdBuffer);
+        }
+        break;
+
+        case CapIdent_UpdateBuffer:
+        {
+            auto buffer = call.ReadObject<Buffer>();
+            const auto offset = call.Read<std::uint64_t>();
+            std::size_t dataSize = 0;
+            auto data = call.ReadData(dataSize);
+            if (buffer != nullptr)
+                cmdBuffer.UpdateBuffer(*buffer, offset, data, static_cast<std::uint16_t>(dataSize));
+        }
+        break;
+
+        case CapIdent_UpdateBufferRegions:
+        {
+            auto buffer = call.ReadObject<Buffer>();
+            std::vector<BufferWriteRegion> regions(call.Read<std::uint32_t>());
+            for (auto& region : regions)
+            {
+                std::size_t dataSize = 0;
+                region.dstOffset    = call.Read<std::uint64_t>();
+                region.data         = call.ReadData(dataSize);
+                region.dataSize     = dataSize;
+            }
+            if (buffer != nullptr)
+                cmdBuffer.UpdateBuffer(*buffer, static_cast<std::uint32_t>(regions.size()), regions.data());
+        }
+        break;
+
+        case CapIdent_CopyBuffer:
+        {
+            auto dstBuffer = call.ReadObject<Buffer>();
+            const auto dstOffset = call.Read<std::uint64_t>();
+            auto srcBuffer = call.ReadObject<Buffer>();
+            const auto srcOffset = call.Read<std::uint64_t>();
+            const auto size = call.Read<std::uint64_t>();
+            if (dstBuffer != nullptr && srcBuffer != nullptr)
+                cmdBuffer.CopyBuffer(*dstBuffer, dstOffset, *srcBuffer, srcOffset, size);
+        }
+        break;
+
+        case CapIdent_CopyBufferRegions:
+        {
+            auto dstBuffer = call.ReadObject<Buffer>();
+            auto srcBuffer = call.ReadObject<Buffer>();
+            std::vector<BufferCopyRegion> regions;
+            call.ReadArray(regions);
+            if (dstBuffer != nullptr && srcBuffer != nullptr)
+                cmdBuffer.CopyBuffer(*dstBuffer, *srcBuffer, static_cast<std::uint32_t>(regions.size()), regions.data());
+        }
+        break;
+
+        case CapIdent_CopyBufferFromTexture:
+        {
+            auto dstBuffer = call.ReadObject<Buffer>();
+            const auto dstOffset = call.Read<std::uint64_t>();
+            auto srcTexture = call.ReadObject<Texture>();
+            const auto srcRegion = call.Read<TextureRegion>();
+            const auto rowStride = call.Read<std::uint32_t>();
+            const auto layerStride = call.Read<std::uint32_t>();
+            if (dstBuffer != nullptr && srcTexture != nullptr)
+                cmdBuffer.CopyBufferFromTexture(*dstBuffer, dstOffset, *srcTexture, srcRegion, rowStride, layerStride);
+        }
+        break;
+
+        case CapIdent_FillBuffer:
+        {
+            auto dstBuffer = call.ReadObject<Buffer>();
+            const auto dstOffset = call.Read<std::uint64_t>();
+            const auto value = call.Read<std::uint32_t>();
+            const auto fillSize = call.Read<std::uint64_t>();
+            if (dstBuffer != nullptr)
+                cmdBuffer.FillBuffer(*dstBuffer, dstOffset, value, fillSize);
+        }
+        break;
+
+        case CapIdent_CopyTexture:
+        {
+            auto dstTexture = call.ReadObject<Texture>();
+            const auto dstLocation = call.Read<TextureLocation>();
+            auto srcTexture = call.ReadObject<Texture>();
+            const auto srcLocation = call.Read<TextureLocation>();
+            const auto extent = call.Read<Extent3D>();
+            if (dstTexture != nullptr && srcTexture != nullptr)
+                cmdBuffer.CopyTexture(*dstTexture, dstLocation, *srcTexture, srcLocation, extent);
+        }
+        break;
+
+        case CapIdent_CopyTextureRegions:
+        {
+            auto dstTexture = call.ReadObject<Texture>();
+            auto srcTexture = call.ReadObject<Texture>();
+            std::vector<TextureCopyRegion> regions;
+            call.ReadArray(regions);
+            if (dstTexture != nullptr && srcTexture != nullptr)
+                cmdBuffer.CopyTexture(*dstTexture, *srcTexture, static_cast<std::uint32_t>(regions.size()), regions.data());
+        }
+        break;
+
+        case CapIdent_CopyTextureFromBuffer:
+        {
+            auto dstTexture = call.ReadObject<Texture>();
+            const auto dstRegion = call.Read<TextureRegion>();
+            auto srcBuffer = call.ReadObject<Buffer>();
+            const auto srcOffset = call.Read<std::uint64_t>();
+            const auto rowStride = call.Read<std::uint32_t>();
+            const auto layerStride = call.Read<std::uint32_t>();
+            if (dstTexture != nullptr && srcBuffer != nullptr)
+                cmdBuffer.CopyTextureFromBuffer(*dstTexture, dstRegion, *srcBuffer, srcOffset, rowStride, layerStride);
+        }
+        break;
+
+        case CapIdent_GenerateMips:
+        {
+            if (auto texture = call.ReadObject<Texture>())
+                cmdBuffer.GenerateMips(*texture);
+        }
+        break;
+
+        case CapIdent_GenerateMipsRange:
+        {
+            auto texture = call.ReadObject<Texture>();
+            const auto subresource = call.Read<TextureSubresource>();
+            if (texture != nullptr)
+                cmdBuffer.GenerateMips(*texture, subresource);
+        }
+        break;
+
+        case CapIdent_SetViewports:
+        {
+            std::vector<Viewport> viewports;
+            call.ReadArray(viewports);
+            if (viewports.size() == 1)
+                cmdBuffer.SetViewport(viewports[0]);
+            else
+                cmdBuffer.SetViewports(static_cast<std::uint32_t>(viewports.size()), viewports.data());
+        }
+        break;
+
+        case CapIdent_SetScissors:
+        {
+            std::vector<Scissor> scissors;
+            call.ReadArray(scissors);
+            if (scissors.size() == 1)
+                cmdBuffer.SetScissor(scissors[0]);
+            else
+                cmdBuffer.SetScissors(static_cast<std::uint32_t>(scissors.size()), scissors.data());
+        }
+        break;
+
+        case CapIdent_SetVertexBuffer:
+        {
+            if (auto buffer = call.ReadObject<Buffer>())
+                cmdBuffer.SetVertexBuffer(*buffer);
+        }
+        break;
+
+        case CapIdent_SetVertexBufferArray:
+        {
+            if (auto bufferArray = call.ReadObject<BufferArray>())
+                cmdBuffer.SetVertexBufferArray(*bufferArray);
+        }
+        break;
+
+        case CapIdent_SetIndexBuffer:
+        {
+            if (auto buffer = call.ReadObject<Buffer>())
+                cmdBuffer.SetIndexBuffer(*buffer);
+        }
+        break;
+
+        case CapIdent_SetIndexBufferFormat:
+        {
+            auto buffer = call.ReadObject<Buffer>();
+            const auto format = call.Read<Format>();
+            const auto offset = call.Read<std::uint64_t>();
+            if (buffer != nullptr)
+                cmdBuffer.SetIndexBuffer(*buffer, format, offset);
+        }
+        break;
+
+        case CapIdent_SetResourceHeap:
+        {
+            auto resourceHeap = call.ReadObject<ResourceHeap>();
+            const auto descriptorSet = call.Read<std::uint32_t>();
+            const auto bindPoint = call.Read<PipelineBindPoint>();
+            std::vector<std::uint32_t> dynamicOffsets;
+            call.ReadArray(dynamicOffsets);
+            if (resourceHeap != nullptr)
+            {
+                if (dynamicOffsets.empty())
+                    cmdBuffer.SetResourceHeap(*resourceHeap, descriptorSet, bindPoint);
+                else
+                    cmdBuffer.SetResourceHeap(*resourceHeap, descriptorSet, static_cast<std::uint32_t>(dynamicOffsets.size()), dynamicOffsets.data(), bindPoint);
+            }
+        }
+        break;
+
+        case CapIdent_SetResource:
+        {
+            auto resource = call.ReadObject<Resource>();
+            const auto slot = call.Read<std::uint32_t>();
+            const auto bindFlags = call.Read<long>();
+            const auto stageFlags = call.Read<long>();
+            if (resource != nullptr)
+                cmdBuffer.SetResource(*resource, slot, bindFlags, stageFlags);
+        }
+        break;
+
+        case CapIdent_ResetResourceSlots:
+        {
+            const auto resourceType = call.Read<ResourceType>();
+            const auto firstSlot = call.Read<std::uint32_t>();
+            const auto numSlots = call.Read<std::uint32_t>();
+            const auto bindFlags = call.Read<long>();
+            const auto stageFlags = call.Read<long>();
+            cmdBuffer.ResetResourceSlots(resourceType, firstSlot, numSlots, bindFlags, stageFlags);
+        }
+        break;
+
+        case CapIdent_BeginRenderPass:
+        {
+            auto renderTarget = call.ReadObject<RenderTarget>();
+            auto renderPass = call.ReadObject<RenderPass>();
+            std::vector<ClearValue> clearValues;
+            call.ReadArray(clearValues);
+            if (renderTarget != nullptr)
+                cmdBuffer.BeginRenderPass(*renderTarget, renderPass, static_cast<std::uint32_t>(clearValues.size()), clearValues.data());
+        }
+        break;
+
+        case CapIdent_EndRenderPass:
+            cmdBuffer.EndRenderPass();
+            break;
+
+        case CapIdent_NextSubpass:
+            cmdBuffer.NextSubpass();
+            break;
+
+        case CapIdent_Clear:
+        {
+            const auto flags = call.Read<long>();
+            const auto clearValue = call.Read<ClearValue>();
+            cmdBuffer.Clear(flags, clearValue);
+        }
+        break;
+
+        case CapIdent_ClearAttachments:
+        {
+            std::vector<AttachmentClear> attachments;
+            call.ReadArray(attachments);
+            cmdBuffer.ClearAttachments(static_cast<std::uint32_t>(attachments.size()), attachments.data());
+        }
+        break;
+
+        case CapIdent_SetPipelineState:
+        {
+            if (auto pipelineState = call.ReadObject<PipelineState>())
+                cmdBuffer.SetPipelineState(*pipelineState);
+        }
+        break;
+
+        case CapIdent_SetBlendFactor:
+            cmdBuffer.SetBlendFactor(call.Read<ColorRGBAf>());
+            break;
+
+        case CapIdent_SetStencilReference:
+        {
+            const auto reference = call.Read<std::uint32_t>();
+            const auto stencilFace = call.Read<StencilFace>();
+            cmdBuffer.SetStencilReference(reference, stencilFace);
+        }
+        break;
+
+        case CapIdent_SetShadingRate:
+        {
+            cmdBuffer.SetShadingRate(call.Read<ShadingRate>());
+        }
+        break;
+
+        case CapIdent_SetUniforms:
+        {
+            const auto location = call.Read<UniformLocation>();
+            const auto count = call.Read<std::uint32_t>();
+            std::size_t dataSize = 0;
+            auto data = call.ReadData(dataSize);
+            if (count == 1)
+                cmdBuffer.SetUniform(location, data, static_cast<std::uint32_t>(dataSize));
+            else
+                cmdBuffer.SetUniforms(location, count, data, static_cast<std::uint32_t>(dataSize));
+        }
+        break;
+
+        case CapIdent_BeginQuery:
+        {
+            auto queryHeap = call.ReadObject<QueryHeap>();
+            const auto query = call.Read<std::uint32_t>();
+            if (queryHeap != nullptr)
+                cmdBuffer.BeginQuery(*queryHeap, query);
+        }
+        break;
+
+        case CapIdent_EndQuery:
+        {
+            auto queryHeap = call.ReadObject<QueryHeap>();
+            const auto query = call.Read<std::uint32_t>();
+            if (queryHeap != nullptr)
+                cmdBuffer.EndQuery(*queryHeap, query);
+        }
+        break;
+
+        case CapIdent_ResolveQueries:
+        {
+            auto queryHeap = call.ReadObject<QueryHeap>();
+            const auto firstQuery = call.Read<std::uint32_t>();
+            const auto numQueries = call.Read<std::uint32_t>();
+            if (queryHeap != nullptr)
+                cmdBuffer.ResolveQueries(*queryHeap, firstQuery, numQueries);
+        }
+        break;
+
+        case CapIdent_BeginRenderCondition:
+        {
+            auto queryHeap = call.ReadObject<QueryHeap>();
+            const auto query = call.Read<std::uint32_t>();
+            const auto mode = call.Read<RenderConditionMode>();
+            if (queryHeap != nullptr)
+                cmdBuffer.BeginRenderCondition(*queryHeap, query, mode);
+        }
+        break;
+
+        case CapIdent_EndRenderCondition:
+            cmdBuffer.EndRenderCondition();
+            break;
+
+        case CapIdent_BeginStreamOutput:
+        {
+            std::vector<Buffer*> buffers(call.Read<std::uint32_t>());
+            for (auto& buffer : buffers)
+                buffer = call.ReadObject<Buffer>();
+            cmdBuffer.BeginStreamOutput(static_cast<std::uint32_t>(buffers.size()), buffers.data());
+        }
+        break;
+
+        case CapIdent_EndStreamOutput:
+            cmdBuffer.EndStreamOutput();
+            break;
+
+        case CapIdent_Draw:
+        {
+            const auto numVertices = call.Read<std::uint32_t>();
+            const auto firstVertex = call.Read<std::uint32_t>();
+            cmdBuffer.Draw(numVertices, firstVertex);
+        }
+        break;
+
+        case CapIdent_DrawIndexed:
+        {
+            const auto numArgs = call.Read<std::uint8_t>();
+            const auto numIndices = call.Read<std::uint32_t>();
+            const auto firstIndex = call.Read<std::uint32_t>();
+            const auto vertexOffset = call.Read<std::int32_t>();
+            if (numArgs == 2)
+                cmdBuffer.DrawIndexed(numIndices, firstIndex);
+            else
+                cmdBuffer.DrawIndexed(numIndices, firstIndex, vertexOffset);
+        }
+        break;
+
+        case CapIdent_DrawInstanced:
+        {
+            const auto numArgs = call.Read<std::uint8_t>();
+            const auto numVertices = call.Read<std::uint32_t>();
+            const auto firstVertex = call.Read<std::uint32_t>();
+            const auto numInstances = call.Read<std::uint32_t>();
+            const auto firstInstance = call.Read<std::uint32_t>();
+            if (numArgs == 3)
+                cmdBuffer.DrawInstanced(numVertices, firstVertex, numInstances);
+            else
+                cmdBuffer.DrawInstanced(numVertices, firstVertex, numInstances, firstInstance);
+        }
+        break;
+
+        case CapIdent_DrawIndexedInstanced:
+        {
+            const auto numArgs = call.Read<std::uint8_t>();
+            const auto numIndices = call.Read<std::uint32_t>();
+            const auto numInstances = call.Read<std::uint32_t>();
+            const auto firstIndex = call.Read<std::uint32_t>();
+            const auto vertexOffset = call.Read<std::int32_t>();
+            const auto firstInstance = call.Read<std::uint32_t>();
+            if (numArgs == 3)
+                cmdBuffer.DrawIndexedInstanced(numIndices, numInstances, firstIndex);
+            else if (numArgs == 4)
+                cmdBuffer.DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset);
+            else
+                cmdBuffer.DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
+        }
+        break;
+
+        case CapIdent_DrawIndirect:
+        case CapIdent_DrawIndexedIndirect:
+        {
+            auto buffer = call.ReadObject<Buffer>();
+            const auto numArgs = call.Read<std::uint8_t>();
+            const auto offset = call.Read<std::uint64_t>();
+            const auto numCommands = call.Read<std::uint32_t>();
+            const auto stride = call.Read<std::uint32_t>();
+            if (buffer != nullptr)
+            {
+                if (ident == CapIdent_DrawIndirect)
+                {
+                    if (numArgs == 2)
+                        cmdBuffer.DrawIndirect(*buffer, offset);
+                    else
+                        cmdBuffer.DrawIndirect(*buffer, offset, numCommands, stride);
+                }
+                else
+                {
+                    if (numArgs == 2)
+                        cmdBuffer.DrawIndexedIndirect(*buffer, offset);
+                    else
+                        cmdBuffer.DrawIndexedIndirect(*buffer, offset, numCommands, stride);
+                }
+            }
+        }
+        break;
+
+        case CapIdent_DrawIndirectCount:
+        case CapIdent_DrawIndexedIndirectCount:
+        {
+            auto buffer = call.ReadObject<Buffer>();
+            const auto offset = call.Read<std::uint64_t>();
+            auto countBuffer = call.ReadObject<Buffer>();
+            const auto countOffset = call.Read<std::uint64_t>();
+            const auto maxNumCommands = call.Read<std::uint32_t>();
+            const auto stride = call.Read<std::uint32_t>();
+            if (buffer != nullptr && countBuffer != nullptr)
+            {
+                if (ident == CapIdent_DrawIndirectCount)
+                    cmdBuffer.DrawIndirectCount(*buffer, offset, *countBuffer, countOffset, maxNumCommands, stride);
+                else
+                    cmdBuffer.DrawIndexedIndirectCount(*buffer, offset, *countBuffer, countOffset, maxNumCommands, stride);
+            }
+        }
+        break;
+
+        case CapIdent_DrawPatchable:
+        {
+            const auto args = call.Read<DrawIndirectArguments>();
+            const auto slot = call.Read<std::uint32_t>();
+            patchSlots[{ &cmdBuffer, slot }] = cmdBuffer.DrawPatchable(args);
+        }
+        break;
+
+        case CapIdent_DrawIndexedPatchable:
+        {
+            const auto args = call.Read<DrawIndexedIndirectArguments>();
+            const auto slot = call.Read<std::uint32_t>();
+            patchSlots[{ &cmdBuffer, slot }] = cmdBuffer.DrawIndexedPatchable(args);
+        }
+        break;
+
+        case CapIdent_PatchDraw:
+        {
+            const auto slot = call.Read<std::uint32_t>();
+            const auto args = call.Read<DrawIndirectArguments>();
+            auto it = patchSlots.find({ &cmdBuffer, slot });
+            if (it != patchSlots.end())
+                cmdBuffer.PatchDraw(it->second, args);
+        }
+        break;
+
+        case CapIdent_PatchDrawIndexed:
+        {
+            const auto slot = call.Read<std::uint32_t>();
+            const auto args = call.Read<DrawIndexedIndirectArguments>();
+            auto it = patchSlots.find({ &cmdBuffer, slot });
+            if (it != patchSlots.end())
+                cmdBuffer.PatchDrawIndexed(it->second, args);
+        }
+        break;
+
+        case CapIdent_DrawMeshTasks:
+        {
+            const auto numWorkGroupsX = call.Read<std::uint32_t>();
+            const auto numWorkGroupsY = call.Read<std::uint32_t>();
+            const auto numWorkGroupsZ = call.Read<std::uint32_t>();
+            cmdBuffer.DrawMeshTasks(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+        }
+        break;
+
+        case CapIdent_DrawMeshTasksIndirect:
+        {
+            auto buffer = call.ReadObject<Buffer>();
+            const auto offset = call.Read<std::uint64_t>();
+            const auto numCommands = call.Read<std::uint32_t>();
+            const auto stride = call.Read<std::uint32_t>();
+            if (buffer != nullptr)
+                cmdBuffer.DrawMeshTasksIndirect(*buffer, offset, numCommands, stride);
+        }
+        break;
+
+        case CapIdent_Dispatch:
+        {
+            const auto numWorkGroupsX = call.Read<std::uint32_t>();
+            const auto numWorkGroupsY = call.Read<std::uint32_t>();
+            const auto numWorkGroupsZ = call.Read<std::uint32_t>();
+            cmdBuffer.Dispatch(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+        }
+        break;
+
+        case CapIdent_DispatchIndirect:
+        {
+            auto buffer = call.ReadObject<Buffer>();
+            const auto offset = call.Read<std::uint64_t>();
+            if (buffer != nullptr)
+                cmdBuffer.DispatchIndirect(*buffer, offset);
+        }
+        break;
+
+        case CapIdent_PushDebugGroup:
+        {
+            if (auto name = call.ReadString())
+                cmdBuffer.PushDebugGroup(name);
+        }
+        break;
+
+        case CapIdent_PopDebugGroup:
+            cmdBuffer.PopDebugGroup();
+            break;
+
+        default:
+            throw std::runtime_error("invalid segment in capture file: " + std::to_string(static_cast<int>(ident)));
+    }
+}
+
+
+/*
+ * CaptureReplay class
+ */
+
+CaptureReplay::CaptureReplay(RenderSystem& renderSystem, const char* filename) :
+    pimpl_ { new Pimpl{ renderSystem, filename } }
+{
+}
+
+CaptureReplay::~CaptureReplay()
+{
+    delete pimpl_;
+}
+
+bool CaptureReplay::ReplayFrame()
+{
+    const auto startTick = Timer::Tick();
+
+    /* Replay all calls until the next swap-chain presentation */
+    bool presented = false, replayed = false;
+    try
+    {
+        while (!pimpl_->endOfCapture && !presented)
+        {
+            if (pimpl_->ReplayNextCall(presented))
+                replayed = true;
+            else
+                pimpl_->endOfCapture = true;
+        }
+    }
+    catch (const std::out_of_range&)
+    {
+        /* Capture has been truncated, e.g. because the captured application has been terminated before the capture layer was released */
+        pimpl_->endOfCapture = true;
+    }
+
+    if (replayed)
+    {
+        pimpl_->lastFrameTicks = Timer::Tick() - startTick;
+        pimpl_->frameIndex++;
+    }
+
+    return replayed;
+}
+
+void CaptureReplay::Reset()
+{
+    pimpl_->ReleaseAll();
+    pimpl_->reader.Reset();
+    pimpl_->ReadHeader();
+    pimpl_->frameIndex      = 0;
+    pimpl_->lastFrameTicks  = 0;
+    pimpl_->endOfCapture    = false;
+}
+
+std::uint32_t CaptureReplay::GetFrameIndex() const
+{
+    return pimpl_->frameIndex;
+}
+
+std::uint64_t CaptureReplay::GetLastFrameTicks() const
+{
+    return pimpl_->lastFrameTicks;
+}
+
+const char* CaptureReplay::GetCapturedModuleName() const
+{
+    return pimpl_->moduleName.c_str();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
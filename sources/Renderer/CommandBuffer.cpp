@@ -0,0 +1,107 @@
+/*
+ * CommandBuffer.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/CommandBuffer.h>
+
+
+namespace LLGL
+{
+
+
+std::uint32_t CommandBuffer::QueryBeginStalls()
+{
+    return 0; // dummy
+}
+
+void CommandBuffer::UpdateBuffer(Buffer& dstBuffer, std::uint32_t numRegions, const BufferWriteRegion* regions)
+{
+    for (std::uint32_t i = 0; i < numRegions; ++i)
+        UpdateBuffer(dstBuffer, regions[i].dstOffset, regions[i].data, static_cast<std::uint16_t>(regions[i].dataSize));
+}
+
+void CommandBuffer::CopyBuffer(Buffer& dstBuffer, Buffer& srcBuffer, std::uint32_t numRegions, const BufferCopyRegion* regions)
+{
+    for (std::uint32_t i = 0; i < numRegions; ++i)
+        CopyBuffer(dstBuffer, regions[i].dstOffset, srcBuffer, regions[i].srcOffset, regions[i].size);
+}
+
+void CommandBuffer::CopyTexture(Texture& dstTexture, Texture& srcTexture, std::uint32_t numRegions, const TextureCopyRegion* regions)
+{
+    for (std::uint32_t i = 0; i < numRegions; ++i)
+        CopyTexture(dstTexture, regions[i].dstLocation, srcTexture, regions[i].srcLocation, regions[i].extent);
+}
+
+void CommandBuffer::NextSubpass()
+{
+    // dummy
+}
+
+std::uint32_t CommandBuffer::DrawPatchable(const DrawIndirectArguments& args)
+{
+    /* Encode regular draw command; its arguments can only be changed by encoding the command buffer again */
+    if (args.firstInstance != 0)
+        DrawInstanced(args.numVertices, args.firstVertex, args.numInstances, args.firstInstance);
+    else
+        DrawInstanced(args.numVertices, args.firstVertex, args.numInstances);
+    return Constants::invalidPatchSlot;
+}
+
+std::uint32_t CommandBuffer::DrawIndexedPatchable(const DrawIndexedIndirectArguments& args)
+{
+    if (args.firstInstance != 0)
+        DrawIndexedInstanced(args.numIndices, args.numInstances, args.firstIndex, args.vertexOffset, args.firstInstance);
+    else
+        DrawIndexedInstanced(args.numIndices, args.numInstances, args.firstIndex, args.vertexOffset);
+    return Constants::invalidPatchSlot;
+}
+
+bool CommandBuffer::PatchDraw(std::uint32_t /*slot*/, const DrawIndirectArguments& /*args*/)
+{
+    return false; // dummy
+}
+
+bool CommandBuffer::PatchDrawIndexed(std::uint32_t /*slot*/, const DrawIndexedIndirectArguments& /*args*/)
+{
+    return false; // dummy
+}
+
+void CommandBuffer::SetShadingRate(const ShadingRate /*rate*/)
+{
+    // dummy
+}
+
+void CommandBuffer::DrawMeshTasks(std::uint32_t /*numWorkGroupsX*/, std::uint32_t /*numWorkGroupsY*/, std::uint32_t /*numWorkGroupsZ*/)
+{
+    // dummy
+}
+
+void CommandBuffer::DrawMeshTasksIndirect(Buffer& /*buffer*/, std::uint64_t /*offset*/, std::uint32_t /*numCommands*/, std::uint32_t /*stride*/)
+{
+    // dummy
+}
+
+std::uint64_t CommandBuffer::CopyBufferToReadback(Buffer& /*srcBuffer*/, std::uint64_t /*srcOffset*/, std::uint64_t /*size*/)
+{
+    return Constants::invalidReadbackTicket; // dummy
+}
+
+std::uint64_t CommandBuffer::CopyTextureToReadback(Texture& /*srcTexture*/, const TextureRegion& /*srcRegion*/)
+{
+    return Constants::invalidReadbackTicket; // dummy
+}
+
+void CommandBuffer::ResolveQueries(QueryHeap& /*queryHeap*/, std::uint32_t /*firstQuery*/, std::uint32_t /*numQueries*/)
+{
+    // dummy
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,55 @@
+/*
+ * CommandQueue.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/CommandQueue.h>
+#include <LLGL/Fence.h>
+
+
+namespace LLGL
+{
+
+
+void CommandQueue::Submit(std::uint32_t numCommandBuffers, CommandBuffer* const * commandBuffers)
+{
+    for (std::uint32_t i = 0; i < numCommandBuffers; ++i)
+        Submit(*commandBuffers[i]);
+}
+
+bool CommandQueue::WaitFenceValue(Fence& fence, std::uint64_t value, std::uint64_t timeout)
+{
+    /* Only take the shortcut if the backend tracks fence values, otherwise the completed value is always 0 */
+    if (fence.GetValue() > 0 && fence.GetCompletedValue() >= value)
+        return true;
+    return WaitFence(fence, timeout);
+}
+
+void CommandQueue::SubmitWait(Fence& fence, std::uint64_t value)
+{
+    WaitFenceValue(fence, value, ~0ull);
+}
+
+std::uint32_t CommandQueue::TryGetQueryResults(
+    QueryHeap&      /*queryHeap*/,
+    void*           /*data*/,
+    std::size_t     /*dataSize*/,
+    QueryRange*     /*outRanges*/,
+    std::uint32_t   /*maxRanges*/)
+{
+    return 0; // dummy
+}
+
+bool CommandQueue::QueryCalibratedTimestamps(CalibratedTimestamps& /*outTimestamps*/)
+{
+    return false; // dummy
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -11,6 +11,8 @@
 
 #include <set>
 #include <memory>
+#include <mutex>
+#include <utility>
 
 
 namespace LLGL
@@ -20,8 +22,64 @@ namespace LLGL
 template <typename T>
 using HWObjectInstance = std::unique_ptr<T>;
 
+/*
+Container of hardware objects that are owned by a render system.
+Insertion and removal with TakeOwnership and RemoveFromUniqueSet are guarded by a mutex,
+so objects can be created and released from multiple threads (see RenderSystem thread-safety remarks).
+Iterating over the container is not guarded and must only be done by the thread that owns the render system.
+*/
 template <typename T>
-using HWObjectContainer = std::set<HWObjectInstance<T>>;
+class HWObjectContainer : public std::set<HWObjectInstance<T>>
+{
+
+    public:
+
+        HWObjectContainer() = default;
+        HWObjectContainer(const HWObjectContainer&) = delete;
+        HWObjectContainer& operator = (const HWObjectContainer&) = delete;
+
+        // Returns the mutex that guards insertion and removal.
+        inline std::mutex& GetMutex()
+        {
+            return mutex_;
+        }
+
+    private:
+
+        std::mutex mutex_;
+
+};
+
+
+/* ----- Functions ----- */
+
+// Inserts the specified object into the container and returns its raw pointer. This is thread-safe.
+template <typename BaseType, typename SubType>
+SubType* TakeOwnership(HWObjectContainer<BaseType>& objectSet, std::unique_ptr<SubType>&& object)
+{
+    auto ref = object.get();
+    std::lock_guard<std::mutex> guard{ objectSet.GetMutex() };
+    objectSet.emplace(std::forward<std::unique_ptr<SubType>>(object));
+    return ref;
+}
+
+// Removes and destroys the specified object from the container. This is thread-safe.
+template <typename T, typename TBase>
+void RemoveFromUniqueSet(HWObjectContainer<T>& objectSet, const TBase* entry)
+{
+    if (entry)
+    {
+        std::lock_guard<std::mutex> guard{ objectSet.GetMutex() };
+        for (auto it = objectSet.begin(); it != objectSet.end(); ++it)
+        {
+            if (it->get() == entry)
+            {
+                objectSet.erase(it);
+                break;
+            }
+        }
+    }
+}
 
 
 } // /namespace LLGL
@@ -494,7 +494,23 @@ VideoAdapterDescriptor DXGetVideoAdapterDesc(IDXGIAdapter* adapter)
 
     videoAdapterDesc.name           = std::wstring(desc.Description);
     videoAdapterDesc.vendor         = GetVendorByID(desc.VendorId);
+    videoAdapterDesc.vendorID       = desc.VendorId;
+    videoAdapterDesc.deviceID       = desc.DeviceId;
     videoAdapterDesc.videoMemory    = static_cast<uint64_t>(desc.DedicatedVideoMemory);
+    videoAdapterDesc.sharedMemory   = static_cast<uint64_t>(desc.SharedSystemMemory);
+
+    /*
+    DXGI does not report the adapter type directly: software adapters have a special flag
+    and integrated GPUs are distinguished by their small reserved dedicated memory pool
+    */
+    ComPtr<IDXGIAdapter1> adapter1;
+    DXGI_ADAPTER_DESC1 desc1;
+    if (SUCCEEDED(adapter->QueryInterface(IID_PPV_ARGS(&adapter1))) && SUCCEEDED(adapter1->GetDesc1(&desc1)) && (desc1.Flags & DXGI_ADAPTER_FLAG_SOFTWARE) != 0)
+        videoAdapterDesc.flags = VideoAdapterFlags::Software;
+    else if (desc.DedicatedVideoMemory >= (512ull << 20))
+        videoAdapterDesc.flags = VideoAdapterFlags::Discrete;
+    else
+        videoAdapterDesc.flags = VideoAdapterFlags::Integrated;
 
     /* Enumerate over all adapter outputs */
     for (UINT j = 0; adapter->EnumOutputs(j, &output) != DXGI_ERROR_NOT_FOUND; ++j)
@@ -544,6 +560,40 @@ VideoAdapterDescriptor DXGetVideoAdapterDesc(IDXGIAdapter* adapter)
     return videoAdapterDesc;
 }
 
+void DXQueryVideoAdapters(IDXGIFactory* factory, std::vector<VideoAdapterDescriptor>& outAdapters)
+{
+    /* Enumerate over all video adapters */
+    ComPtr<IDXGIAdapter> adapter;
+    for (UINT i = 0; factory->EnumAdapters(i, adapter.ReleaseAndGetAddressOf()) != DXGI_ERROR_NOT_FOUND; ++i)
+        outAdapters.push_back(DXGetVideoAdapterDesc(adapter.Get()));
+}
+
+ComPtr<IDXGIAdapter> DXGetAdapterByIndex(IDXGIFactory* factory, int adapterIndex)
+{
+    ComPtr<IDXGIAdapter> adapter;
+    if (adapterIndex >= 0)
+    {
+        if (factory->EnumAdapters(static_cast<UINT>(adapterIndex), adapter.ReleaseAndGetAddressOf()) == DXGI_ERROR_NOT_FOUND)
+            throw std::runtime_error("video adapter index out of range: " + std::to_string(adapterIndex));
+    }
+    return adapter;
+}
+
+bool DXGetPresentStatistics(IDXGISwapChain* swapChain, PresentStatistics& outStats)
+{
+    DXGI_FRAME_STATISTICS frameStats;
+    if (FAILED(swapChain->GetFrameStatistics(&frameStats)))
+        return false;
+
+    /* SyncQPCTime is in the time domain of QueryPerformanceCounter, which is the same as Timer::Tick on Win32 */
+    outStats.presentCount   = frameStats.PresentCount;
+    outStats.refreshCount   = frameStats.SyncRefreshCount;
+    outStats.syncTime       = static_cast<std::uint64_t>(frameStats.SyncQPCTime.QuadPart);
+    outStats.refreshPeriod  = 0;
+
+    return true;
+}
+
 Format DXGetSignatureParameterType(D3D_REGISTER_COMPONENT_TYPE componentType, BYTE componentMask)
 {
     switch (componentType)
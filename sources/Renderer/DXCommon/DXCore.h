@@ -12,6 +12,7 @@
 #include <LLGL/ColorRGBA.h>
 #include <LLGL/RenderSystemFlags.h>
 #include <LLGL/VideoAdapter.h>
+#include <LLGL/SwapChainFlags.h>
 #include <LLGL/ImageFlags.h>
 #include "ComPtr.h"
 #include <dxgi.h>
@@ -85,6 +86,15 @@ UINT DXGetCompilerFlags(int flags);
 // Returns the video adapter descriptor from the specified DXGI adapter.
 VideoAdapterDescriptor DXGetVideoAdapterDesc(IDXGIAdapter* adapter);
 
+// Appends the video adapter descriptors of all adapters the specified DXGI factory enumerates.
+void DXQueryVideoAdapters(IDXGIFactory* factory, std::vector<VideoAdapterDescriptor>& outAdapters);
+
+// Returns the DXGI adapter with the specified index, or null if the index is negative. Throws if the index is out of range.
+ComPtr<IDXGIAdapter> DXGetAdapterByIndex(IDXGIFactory* factory, int adapterIndex);
+
+// Queries the frame statistics of the specified DXGI swap-chain. Returns false if the statistics are unavailable (e.g. for windowed bitblt swap-chains).
+bool DXGetPresentStatistics(IDXGISwapChain* swapChain, PresentStatistics& outStats);
+
 // Returns the format for the specified signature parameter type (by its component type and mask).
 Format DXGetSignatureParameterType(D3D_REGISTER_COMPONENT_TYPE componentType, BYTE componentMask);
 
@@ -0,0 +1,331 @@
+/*
+ * DXShaderCache.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "DXShaderCache.h"
+#include "DXCore.h"
+#include "../../Core/Helper.h"
+#include <LLGL/JobSystem.h>
+#include <LLGL/Constants.h>
+#include <d3dcompiler.h>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <thread>
+#include <functional>
+
+
+namespace LLGL
+{
+
+
+/* ----- Hashing ----- */
+
+// FNV-1a hash over all inputs of D3DCompile, so the keys remain stable between application runs.
+class ShaderSourceHasher
+{
+
+    public:
+
+        void Write(const void* data, std::size_t size)
+        {
+            auto bytes = reinterpret_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                hash_ ^= bytes[i];
+                hash_ *= 0x100000001b3ull;
+            }
+        }
+
+        template <typename T>
+        void WriteValue(const T& value)
+        {
+            Write(&value, sizeof(value));
+        }
+
+        void WriteString(const char* s)
+        {
+            if (s != nullptr)
+                Write(s, std::strlen(s) + 1);
+            else
+                WriteValue('\0');
+        }
+
+        inline std::uint64_t GetHash() const
+        {
+            return hash_;
+        }
+
+    private:
+
+        std::uint64_t hash_ = 0xcbf29ce484222325ull;
+
+};
+
+
+/* ----- Cache file format ----- */
+
+static const char           g_cacheFileMagic[8]     = { 'L', 'L', 'G', 'L', 'D', 'X', 'S', 'C' };
+static const std::uint32_t  g_cacheFileVersion      = 1;
+
+struct CacheFileHeader
+{
+    char            magic[8];
+    std::uint32_t   version;
+    std::uint32_t   compilerVersion;
+    std::uint64_t   key;
+    std::uint64_t   byteCodeSize;
+    std::uint64_t   warningsSize;
+};
+
+
+/*
+ * DXShaderCache class
+ */
+
+DXShaderCache::DXShaderCache(const char* directory)
+{
+    if (directory != nullptr && *directory != '\0')
+    {
+        directory_ = directory;
+
+        /* Create directory if it does not exist yet; the parent directory must exist */
+        if (!::CreateDirectoryA(directory_.c_str(), nullptr) && ::GetLastError() != ERROR_ALREADY_EXISTS)
+        {
+            directory_.clear();
+            return;
+        }
+
+        if (directory_.back() != '/' && directory_.back() != '\\')
+            directory_ += '/';
+    }
+}
+
+bool DXShaderCache::Load(std::uint64_t key, ComPtr<ID3DBlob>& outByteCode, ComPtr<ID3DBlob>& outWarnings) const
+{
+    if (!IsEnabled())
+        return false;
+
+    std::ifstream file{ GetFilename(key), std::ios::binary };
+    if (!file.good())
+        return false;
+
+    /* Validate header; entries of other compiler versions or from hash collisions are rejected */
+    CacheFileHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        return false;
+
+    if (std::memcmp(header.magic, g_cacheFileMagic, sizeof(g_cacheFileMagic)) != 0 ||
+        header.version          != g_cacheFileVersion                                ||
+        header.compilerVersion  != D3D_COMPILER_VERSION                              ||
+        header.key              != key                                               ||
+        header.byteCodeSize     == 0)
+    {
+        return false;
+    }
+
+    /* Read bytecode and warnings */
+    ComPtr<ID3DBlob> byteCode, warnings;
+
+    if (FAILED(D3DCreateBlob(static_cast<SIZE_T>(header.byteCodeSize), byteCode.ReleaseAndGetAddressOf())))
+        return false;
+    if (!file.read(reinterpret_cast<char*>(byteCode->GetBufferPointer()), static_cast<std::streamsize>(header.byteCodeSize)))
+        return false;
+
+    if (header.warningsSize > 0)
+    {
+        if (FAILED(D3DCreateBlob(static_cast<SIZE_T>(header.warningsSize), warnings.ReleaseAndGetAddressOf())))
+            return false;
+        if (!file.read(reinterpret_cast<char*>(warnings->GetBufferPointer()), static_cast<std::streamsize>(header.warningsSize)))
+            return false;
+    }
+
+    outByteCode = std::move(byteCode);
+    outWarnings = std::move(warnings);
+
+    return true;
+}
+
+void DXShaderCache::Store(std::uint64_t key, ID3DBlob* byteCode, ID3DBlob* warnings) const
+{
+    if (!IsEnabled() || byteCode == nullptr || byteCode->GetBufferSize() == 0)
+        return;
+
+    CacheFileHeader header;
+    {
+        std::memcpy(header.magic, g_cacheFileMagic, sizeof(g_cacheFileMagic));
+        header.version          = g_cacheFileVersion;
+        header.compilerVersion  = D3D_COMPILER_VERSION;
+        header.key              = key;
+        header.byteCodeSize     = byteCode->GetBufferSize();
+        header.warningsSize     = (warnings != nullptr ? warnings->GetBufferSize() : 0);
+    }
+
+    /* Write entry into a temporary file that is unique for this thread */
+    const auto filename     = GetFilename(key);
+    const auto tempFilename = filename + ".tmp" + std::to_string(::GetCurrentProcessId()) + "_" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+    {
+        std::ofstream file{ tempFilename, std::ios::binary | std::ios::trunc };
+        if (!file.good())
+            return;
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(byteCode->GetBufferPointer()), static_cast<std::streamsize>(header.byteCodeSize));
+        if (header.warningsSize > 0)
+            file.write(reinterpret_cast<const char*>(warnings->GetBufferPointer()), static_cast<std::streamsize>(header.warningsSize));
+
+        if (!file.good())
+        {
+            file.close();
+            std::remove(tempFilename.c_str());
+            return;
+        }
+    }
+
+    /* Replace entry atomically */
+    if (!::MoveFileExA(tempFilename.c_str(), filename.c_str(), MOVEFILE_REPLACE_EXISTING))
+        std::remove(tempFilename.c_str());
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+std::string DXShaderCache::GetFilename(std::uint64_t key) const
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llX.dxbc", static_cast<unsigned long long>(key));
+    return directory_ + name;
+}
+
+
+/*
+ * Global functions
+ */
+
+static std::uint64_t HashShaderSource(
+    const char*             sourceCode,
+    SIZE_T                  sourceLength,
+    const D3D_SHADER_MACRO* defines,
+    const char*             entry,
+    const char*             target,
+    UINT                    compilerFlags)
+{
+    ShaderSourceHasher hasher;
+
+    hasher.WriteValue(static_cast<std::uint64_t>(sourceLength));
+    hasher.Write(sourceCode, sourceLength);
+
+    if (defines != nullptr)
+    {
+        for (; defines->Name != nullptr; ++defines)
+        {
+            hasher.WriteString(defines->Name);
+            hasher.WriteString(defines->Definition);
+        }
+    }
+    hasher.WriteValue('\0');
+
+    hasher.WriteString(entry);
+    hasher.WriteString(target);
+    hasher.WriteValue(compilerFlags);
+
+    return hasher.GetHash();
+}
+
+void DXCompileShader(const ShaderDescriptor& shaderDesc, DXShaderCompileResult& outResult, const DXShaderCache* cache)
+{
+    /* Get source code */
+    std::string fileContent;
+    const char* sourceCode      = nullptr;
+    SIZE_T      sourceLength    = 0;
+
+    if (shaderDesc.sourceType == ShaderSourceType::CodeFile)
+    {
+        fileContent     = ReadFileString(shaderDesc.source);
+        sourceCode      = fileContent.c_str();
+        sourceLength    = fileContent.size();
+    }
+    else
+    {
+        sourceCode      = shaderDesc.source;
+        sourceLength    = shaderDesc.sourceSize;
+    }
+
+    /* Get parameter from union */
+    const char* entry           = shaderDesc.entryPoint;
+    const char* target          = (shaderDesc.profile != nullptr ? shaderDesc.profile : "");
+    auto        defines         = reinterpret_cast<const D3D_SHADER_MACRO*>(shaderDesc.defines);
+    const UINT  compilerFlags   = DXGetCompilerFlags(shaderDesc.flags);
+
+    /* Look up bytecode in the cache first */
+    std::uint64_t key = 0;
+    if (cache != nullptr && cache->IsEnabled())
+    {
+        key = HashShaderSource(sourceCode, sourceLength, defines, entry, target, compilerFlags);
+        if (cache->Load(key, outResult.byteCode, outResult.errors))
+        {
+            outResult.hr        = S_OK;
+            outResult.compiled  = true;
+            return;
+        }
+    }
+
+    /* Compile shader code */
+    outResult.hr = D3DCompile(
+        sourceCode,
+        sourceLength,
+        nullptr,                                        // LPCSTR               pSourceName
+        defines,                                        // D3D_SHADER_MACRO*    pDefines
+        nullptr,                                        // ID3DInclude*         pInclude
+        entry,                                          // LPCSTR               pEntrypoint
+        target,                                         // LPCSTR               pTarget
+        compilerFlags,                                  // UINT                 Flags1
+        0,                                              // UINT                 Flags2 (recommended to always be 0)
+        outResult.byteCode.ReleaseAndGetAddressOf(),    // ID3DBlob**           ppCode
+        outResult.errors.ReleaseAndGetAddressOf()       // ID3DBlob**           ppErrorMsgs
+    );
+    outResult.compiled = true;
+
+    /* Store successfully compiled bytecode in the cache */
+    if (cache != nullptr && cache->IsEnabled() && SUCCEEDED(outResult.hr))
+        cache->Store(key, outResult.byteCode.Get(), outResult.errors.Get());
+}
+
+void DXCompileShaders(std::size_t numShaders, const ShaderDescriptor* shaderDescs, DXShaderCompileResult* outResults, const DXShaderCache* cache)
+{
+    JobSystem::ParallelFor(
+        numShaders,
+        1,
+        Constants::maxThreadCount,
+        [shaderDescs, outResults, cache](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                if (!IsShaderSourceCode(shaderDescs[i].sourceType) || shaderDescs[i].source == nullptr)
+                    continue;
+                try
+                {
+                    DXCompileShader(shaderDescs[i], outResults[i], cache);
+                }
+                catch (const std::exception&)
+                {
+                    /* Leave result uncompiled, so the shader reports the error when it's created */
+                    outResults[i] = DXShaderCompileResult{};
+                }
+            }
+        }
+    );
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,83 @@
+/*
+ * DXShaderCache.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_DX_SHADER_CACHE_H
+#define LLGL_DX_SHADER_CACHE_H
+
+
+#include <LLGL/ShaderFlags.h>
+#include <d3dcommon.h>
+#include "ComPtr.h"
+#include <string>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+// Result of a HLSL compilation with D3DCompile.
+struct DXShaderCompileResult
+{
+    bool                compiled    = false;    // False if the source has not been compiled yet, e.g. because the source file could not be read.
+    HRESULT             hr          = E_FAIL;
+    ComPtr<ID3DBlob>    byteCode;
+    ComPtr<ID3DBlob>    errors;                 // Error or warning messages
+};
+
+/*
+On-disk cache of compiled DXBC bytecode (see RenderSystemDescriptor::shaderCacheDirectory).
+Each entry is stored in its own file, named after a 64-bit FNV-1a hash of all inputs to D3DCompile,
+so multiple threads and processes can share the same directory. Entries are written to a temporary file first
+and then renamed, so a concurrent reader never sees a partially written entry.
+*/
+class DXShaderCache
+{
+
+    public:
+
+        // Initializes the cache with the specified directory. If the directory is null or empty, the cache is disabled.
+        DXShaderCache(const char* directory = nullptr);
+
+        // Returns true if this cache has a directory.
+        inline bool IsEnabled() const
+        {
+            return !directory_.empty();
+        }
+
+        // Loads the bytecode and the optional compiler warnings for the specified key. Returns false if there is no valid entry.
+        bool Load(std::uint64_t key, ComPtr<ID3DBlob>& outByteCode, ComPtr<ID3DBlob>& outWarnings) const;
+
+        // Stores the bytecode and the optional compiler warnings for the specified key. Failures are silently ignored.
+        void Store(std::uint64_t key, ID3DBlob* byteCode, ID3DBlob* warnings) const;
+
+    private:
+
+        std::string GetFilename(std::uint64_t key) const;
+
+    private:
+
+        std::string directory_;
+
+};
+
+
+// Compiles the HLSL source of the specified shader descriptor and looks up the bytecode in the cache first if the cache is not null.
+void DXCompileShader(const ShaderDescriptor& shaderDesc, DXShaderCompileResult& outResult, const DXShaderCache* cache = nullptr);
+
+// Compiles the HLSL sources of all shader descriptors in parallel on the job system; binary shaders are skipped. Exceptions are not propagated.
+void DXCompileShaders(std::size_t numShaders, const ShaderDescriptor* shaderDescs, DXShaderCompileResult* outResults, const DXShaderCache* cache = nullptr);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
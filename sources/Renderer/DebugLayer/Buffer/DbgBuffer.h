@@ -11,7 +11,7 @@
 
 #include <LLGL/Buffer.h>
 #include <LLGL/Container/SmallVector.h>
-#include <string>
+#include <LLGL/Container/StringView.h>
 
 
 namespace LLGL
@@ -37,10 +37,12 @@ class DbgBuffer final : public Buffer
 
         Buffer&                 instance;
         const BufferDescriptor  desc;
-        std::string             label;
+        StringView              label;
         std::uint64_t           elements    = 0;
         bool                    initialized = false;
         bool                    mapped      = false;
+        bool                    used        = false;    // Specifies whether this buffer has been bound since the last resource accounting.
+        std::uint64_t           lastUsed    = 0;        // Frame index when this buffer has been used or created.
 
 };
 
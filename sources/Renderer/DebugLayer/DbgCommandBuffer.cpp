@@ -16,6 +16,7 @@
 #include "Buffer/DbgBufferArray.h"
 #include "RenderState/DbgQueryHeap.h"
 #include "RenderState/DbgPipelineState.h"
+#include "RenderState/DbgPipelineLayout.h"
 #include "RenderState/DbgResourceHeap.h"
 #include "Shader/DbgShader.h"
 #include "Texture/DbgTexture.h"
@@ -32,6 +33,22 @@ namespace LLGL
 {
 
 
+/*
+Command buffers may be recorded on multiple threads, so the source function and debug group are stored per command buffer
+and only forwarded to the shared RenderingDebugger when a message is actually posted.
+*/
+#undef LLGL_DBG_SOURCE
+#define LLGL_DBG_SOURCE \
+    source_ = __FUNCTION__
+
+#undef LLGL_DBG_ERROR
+#define LLGL_DBG_ERROR(TYPE, MESSAGE) \
+    PostDebugError((TYPE), (MESSAGE))
+
+#undef LLGL_DBG_WARN
+#define LLGL_DBG_WARN(TYPE, MESSAGE) \
+    PostDebugWarning((TYPE), (MESSAGE))
+
 #define LLGL_DBG_COMMAND(NAME, CMD) \
     if (perfProfilerEnabled_)       \
     {                               \
@@ -44,12 +61,12 @@ namespace LLGL
         CMD;                        \
     }
 
-static const char* GetLabelOrDefault(const std::string& label, const char* defaultLabel)
+static const char* GetLabelOrDefault(const StringView& label, const char* defaultLabel)
 {
     if (label.empty())
         return defaultLabel;
     else
-        return label.c_str();
+        return label.data();
 }
 
 DbgCommandBuffer::DbgCommandBuffer(
@@ -58,16 +75,19 @@ DbgCommandBuffer::DbgCommandBuffer(
     CommandBuffer&                  commandBufferInstance,
     RenderingDebugger*              debugger,
     RenderingProfiler*              profiler,
+    std::uint32_t                   validationMask,
     const CommandBufferDescriptor&  desc,
     const RenderingCapabilities&    caps)
 :
-    instance   { commandBufferInstance                                             },
-    desc       { desc                                                              },
-    debugger_  { debugger                                                          },
-    profiler_  { profiler                                                          },
-    features_  { caps.features                                                     },
-    limits_    { caps.limits                                                       },
-    timerMngr_ { renderSystemInstance, commandQueueInstance, commandBufferInstance }
+    instance        { commandBufferInstance                                             },
+    desc            { desc                                                              },
+    debugger_       { debugger                                                          },
+    profiler_       { profiler                                                          },
+    validationMask_ { validationMask                                                    },
+    features_       { caps.features                                                     },
+    limits_         { caps.limits                                                       },
+    timerMngr_      { renderSystemInstance, commandQueueInstance, commandBufferInstance },
+    statsMngr_      { renderSystemInstance, commandQueueInstance, commandBufferInstance }
 {
 }
 
@@ -79,19 +99,44 @@ void DbgCommandBuffer::Begin()
     ResetFrameProfile();
     ResetBindings();
     ResetStates();
+    InvalidateRecordedStates();
+    hazardBuffers_.clear();
+    usedResources_.clear();
+    usedResourceHeaps_.clear();
 
     /* Enable performance profiler if it was scheduled */
     perfProfilerEnabled_ = (profiler_ != nullptr && profiler_->timeRecordingEnabled);
     if (perfProfilerEnabled_)
         timerMngr_.Reset();
 
+    /* Enable state-change analysis if it was scheduled */
+    stateChangeAnalysisEnabled_ = (profiler_ != nullptr && profiler_->stateChangeAnalysisEnabled);
+    if (stateChangeAnalysisEnabled_)
+        stateChangeAnalyzer_.Reset();
+
+    /* Enable resource accounting if it was scheduled; used resources are only recorded locally until this command buffer is submitted */
+    resourceAccountingEnabled_ = (profiler_ != nullptr && profiler_->resourceAccountingEnabled);
+
+    /* Enable pipeline statistics if they were scheduled; secondary command buffers are covered by the query of their primary command buffer */
+    pipelineStatisticsEnabled_ =
+    (
+        profiler_ != nullptr                    &&
+        profiler_->pipelineStatisticsEnabled    &&
+        features_.hasPipelineStatistics         &&
+        (desc.flags & CommandBufferFlags::Secondary) == 0
+    );
+
     /* Begin with command recording  */
     if (debugger_)
         EnableRecording(true);
 
     instance.Begin();
 
+    if (pipelineStatisticsEnabled_)
+        statsMngr_.Begin();
+
     profile_.commandBufferEncodings++;
+    profile_.commandBufferStalls += instance.QueryBeginStalls();
 }
 
 void DbgCommandBuffer::End()
@@ -99,11 +144,35 @@ void DbgCommandBuffer::End()
     /* End with command recording */
     if (debugger_)
         EnableRecording(false);
+
+    /* Close timer scopes of debug groups that are still open, since timer queries cannot span multiple command buffers */
+    if (perfProfilerEnabled_)
+        timerMngr_.PopAllScopes();
+
+    if (pipelineStatisticsEnabled_)
+        statsMngr_.End();
+
+    /* Immediate command buffers are submitted implicitly at the end of encoding */
+    if (debugger_ && (desc.flags & CommandBufferFlags::ImmediateSubmit) != 0)
+        ValidateSubmitHazards();
+
     instance.End();
 
     /* Resolve timer query results for performance profiler */
     if (perfProfilerEnabled_)
         timerMngr_.TakeRecords(profile_.timeRecords);
+
+    if (stateChangeAnalysisEnabled_)
+        stateChangeAnalyzer_.TakeRecords(profile_.stateChangeRecords);
+
+    /* Resolve pipeline statistics of previous encodings that are available */
+    if (pipelineStatisticsEnabled_)
+        statsMngr_.TakeResults(profile_.pipelineStatistics);
+}
+
+std::uint32_t DbgCommandBuffer::QueryBeginStalls()
+{
+    return instance.QueryBeginStalls();
 }
 
 void DbgCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
@@ -123,9 +192,22 @@ void DbgCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
             CommandBufferFlags::Secondary,
             "LLGL::CommandBuffer"
         );
+
+        /* Buffers of the secondary command buffer are used when this command buffer is submitted */
+        for (DbgBuffer* bufferDbg : commandBufferDbg.hazardBuffers_)
+            TrackBufferHazard(*bufferDbg);
     }
 
     LLGL_DBG_COMMAND( "Execute", instance.Execute(commandBufferDbg.instance) );
+
+    /* Resources of the secondary command buffer are marked as used when this command buffer is submitted */
+    if (resourceAccountingEnabled_)
+    {
+        usedResources_.insert(usedResources_.end(), commandBufferDbg.usedResources_.begin(), commandBufferDbg.usedResources_.end());
+        usedResourceHeaps_.insert(usedResourceHeaps_.end(), commandBufferDbg.usedResourceHeaps_.begin(), commandBufferDbg.usedResourceHeaps_.end());
+    }
+
+    InvalidateRecordedStates();
 }
 
 /* ----- Blitting ----- */
@@ -143,6 +225,7 @@ void DbgCommandBuffer::UpdateBuffer(
         LLGL_DBG_SOURCE;
         AssertRecording();
         ValidateBufferRange(dstBufferDbg, dstOffset, dataSize, "destination range");
+        TrackBufferHazard(dstBufferDbg);
     }
 
     LLGL_DBG_COMMAND( "UpdateBuffer", instance.UpdateBuffer(dstBufferDbg.instance, dstOffset, data, dataSize) );
@@ -150,6 +233,38 @@ void DbgCommandBuffer::UpdateBuffer(
     profile_.bufferUpdates++;
 }
 
+void DbgCommandBuffer::UpdateBuffer(
+    Buffer&                     dstBuffer,
+    std::uint32_t               numRegions,
+    const BufferWriteRegion*    regions)
+{
+    auto& dstBufferDbg = LLGL_CAST(DbgBuffer&, dstBuffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertRecording();
+        TrackBufferHazard(dstBufferDbg);
+        if (numRegions > 0 && regions == nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "illegal null pointer argument for 'regions' parameter");
+        else
+        {
+            for (std::uint32_t i = 0; i < numRegions; ++i)
+            {
+                if (regions[i].dataSize > 65536u)
+                    LLGL_DBG_ERROR(ErrorType::InvalidArgument, "data size of buffer write region exceeds 65536 bytes: " + std::to_string(regions[i].dataSize));
+                if (regions[i].data == nullptr)
+                    LLGL_DBG_ERROR(ErrorType::InvalidArgument, "illegal null pointer for data of buffer write region");
+                ValidateBufferRange(dstBufferDbg, regions[i].dstOffset, regions[i].dataSize, "destination range");
+            }
+        }
+    }
+
+    LLGL_DBG_COMMAND( "UpdateBuffer", instance.UpdateBuffer(dstBufferDbg.instance, numRegions, regions) );
+
+    profile_.bufferUpdates += numRegions;
+}
+
 void DbgCommandBuffer::CopyBuffer(
     Buffer&         dstBuffer,
     std::uint64_t   dstOffset,
@@ -167,7 +282,9 @@ void DbgCommandBuffer::CopyBuffer(
         ValidateBufferRange(dstBufferDbg, dstOffset, size, "destination range");
         ValidateBufferRange(srcBufferDbg, srcOffset, size, "source range");
         ValidateBindBufferFlags(dstBufferDbg, BindFlags::CopyDst);
+        TrackBufferHazard(dstBufferDbg);
         ValidateBindBufferFlags(srcBufferDbg, BindFlags::CopySrc);
+        TrackBufferHazard(srcBufferDbg);
     }
 
     LLGL_DBG_COMMAND( "CopyBuffer", instance.CopyBuffer(dstBufferDbg.instance, dstOffset, srcBufferDbg.instance, srcOffset, size) );
@@ -175,6 +292,40 @@ void DbgCommandBuffer::CopyBuffer(
     profile_.bufferCopies++;
 }
 
+void DbgCommandBuffer::CopyBuffer(
+    Buffer&                     dstBuffer,
+    Buffer&                     srcBuffer,
+    std::uint32_t               numRegions,
+    const BufferCopyRegion*     regions)
+{
+    auto& dstBufferDbg = LLGL_CAST(DbgBuffer&, dstBuffer);
+    auto& srcBufferDbg = LLGL_CAST(DbgBuffer&, srcBuffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertRecording();
+        if (numRegions > 0 && regions == nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "illegal null pointer argument for 'regions' parameter");
+        else
+        {
+            for (std::uint32_t i = 0; i < numRegions; ++i)
+            {
+                ValidateBufferRange(dstBufferDbg, regions[i].dstOffset, regions[i].size, "destination range");
+                ValidateBufferRange(srcBufferDbg, regions[i].srcOffset, regions[i].size, "source range");
+            }
+        }
+        ValidateBindBufferFlags(dstBufferDbg, BindFlags::CopyDst);
+        TrackBufferHazard(dstBufferDbg);
+        ValidateBindBufferFlags(srcBufferDbg, BindFlags::CopySrc);
+        TrackBufferHazard(srcBufferDbg);
+    }
+
+    LLGL_DBG_COMMAND( "CopyBuffer", instance.CopyBuffer(dstBufferDbg.instance, srcBufferDbg.instance, numRegions, regions) );
+
+    profile_.bufferCopies += numRegions;
+}
+
 //TODO: add remaining validation
 void DbgCommandBuffer::CopyBufferFromTexture(
     Buffer&                 dstBuffer,
@@ -192,6 +343,7 @@ void DbgCommandBuffer::CopyBufferFromTexture(
         LLGL_DBG_SOURCE;
         AssertRecording();
         ValidateBindBufferFlags(dstBufferDbg, BindFlags::CopyDst);
+        TrackBufferHazard(dstBufferDbg);
         //ValidateBufferRange(dstBufferDbg, dstOffset, srcSize);
         ValidateBindTextureFlags(srcTextureDbg, BindFlags::CopySrc);
         //ValidateTextureRegion(srcTextureDbg, TextureRegion{ dstLocation.offset, dstExtent }, srcSize);
@@ -200,9 +352,59 @@ void DbgCommandBuffer::CopyBufferFromTexture(
 
     LLGL_DBG_COMMAND( "CopyBufferFromTexture", instance.CopyBufferFromTexture(dstBufferDbg.instance, dstOffset, srcTextureDbg.instance, srcRegion, rowStride, layerStride) );
 
+    InvalidateRecordedResources();
+
     profile_.bufferCopies++;
 }
 
+std::uint64_t DbgCommandBuffer::CopyBufferToReadback(Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size)
+{
+    auto& srcBufferDbg = LLGL_CAST(DbgBuffer&, srcBuffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertRecording();
+        ValidateBindBufferFlags(srcBufferDbg, BindFlags::CopySrc);
+        TrackBufferHazard(srcBufferDbg);
+        ValidateBufferRange(srcBufferDbg, srcOffset, size, "source range");
+        if (size == 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot copy buffer to readback with zero size");
+    }
+
+    std::uint64_t ticket = Constants::invalidReadbackTicket;
+
+    LLGL_DBG_COMMAND( "CopyBufferToReadback", ticket = instance.CopyBufferToReadback(srcBufferDbg.instance, srcOffset, size) );
+
+    profile_.bufferCopies++;
+
+    return ticket;
+}
+
+std::uint64_t DbgCommandBuffer::CopyTextureToReadback(Texture& srcTexture, const TextureRegion& srcRegion)
+{
+    auto& srcTextureDbg = LLGL_CAST(DbgTexture&, srcTexture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertRecording();
+        ValidateBindTextureFlags(srcTextureDbg, BindFlags::CopySrc);
+        if (srcRegion.subresource.numMipLevels != 1)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot copy texture to readback with more or less than one MIP-map level");
+        if (IsCompressedFormat(srcTextureDbg.GetFormat()))
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot copy compressed texture to readback");
+    }
+
+    std::uint64_t ticket = Constants::invalidReadbackTicket;
+
+    LLGL_DBG_COMMAND( "CopyTextureToReadback", ticket = instance.CopyTextureToReadback(srcTextureDbg.instance, srcRegion) );
+
+    profile_.textureCopies++;
+
+    return ticket;
+}
+
 void DbgCommandBuffer::FillBuffer(
     Buffer&         dstBuffer,
     std::uint64_t   dstOffset,
@@ -216,6 +418,7 @@ void DbgCommandBuffer::FillBuffer(
         LLGL_DBG_SOURCE;
         AssertRecording();
         ValidateBindBufferFlags(dstBufferDbg, BindFlags::CopyDst);
+        TrackBufferHazard(dstBufferDbg);
 
         if (fillSize == Constants::wholeSize)
         {
@@ -255,9 +458,37 @@ void DbgCommandBuffer::CopyTexture(
 
     LLGL_DBG_COMMAND( "CopyTexture", instance.CopyTexture(dstTextureDbg.instance, dstLocation, srcTextureDbg.instance, srcLocation, extent) );
 
+    InvalidateRecordedResources();
+
     profile_.textureCopies++;
 }
 
+void DbgCommandBuffer::CopyTexture(
+    Texture&                    dstTexture,
+    Texture&                    srcTexture,
+    std::uint32_t               numRegions,
+    const TextureCopyRegion*    regions)
+{
+    auto& dstTextureDbg = LLGL_CAST(DbgTexture&, dstTexture);
+    auto& srcTextureDbg = LLGL_CAST(DbgTexture&, srcTexture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertRecording();
+        ValidateBindTextureFlags(dstTextureDbg, BindFlags::CopyDst);
+        ValidateBindTextureFlags(srcTextureDbg, BindFlags::CopySrc);
+        if (numRegions > 0 && regions == nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "illegal null pointer argument for 'regions' parameter");
+    }
+
+    LLGL_DBG_COMMAND( "CopyTexture", instance.CopyTexture(dstTextureDbg.instance, srcTextureDbg.instance, numRegions, regions) );
+
+    InvalidateRecordedResources();
+
+    profile_.textureCopies += numRegions;
+}
+
 //TODO: add remaining validation
 void DbgCommandBuffer::CopyTextureFromBuffer(
     Texture&                dstTexture,
@@ -277,12 +508,15 @@ void DbgCommandBuffer::CopyTextureFromBuffer(
         ValidateBindTextureFlags(dstTextureDbg, BindFlags::CopyDst);
         //ValidateTextureRegion(dstTextureDbg, TextureRegion{ dstLocation.offset, dstExtent }, srcSize);
         ValidateBindBufferFlags(srcBufferDbg, BindFlags::CopySrc);
+        TrackBufferHazard(srcBufferDbg);
         //ValidateBufferRange(srcBufferDbg, srcOffset, srcSize);
         ValidateTextureBufferCopyStrides(dstTextureDbg, rowStride, layerStride, dstRegion.extent);
     }
 
     LLGL_DBG_COMMAND( "CopyTextureFromBuffer", instance.CopyTextureFromBuffer(dstTextureDbg.instance, dstRegion, srcBufferDbg.instance, srcOffset, rowStride, layerStride) );
 
+    InvalidateRecordedResources();
+
     profile_.textureCopies++;
 }
 
@@ -299,6 +533,8 @@ void DbgCommandBuffer::GenerateMips(Texture& texture)
 
     LLGL_DBG_COMMAND( "GenerateMips", instance.GenerateMips(textureDbg.instance) );
 
+    InvalidateRecordedResources();
+
     profile_.mipMapsGenerations++;
 }
 
@@ -315,6 +551,8 @@ void DbgCommandBuffer::GenerateMips(Texture& texture, const TextureSubresource&
 
     LLGL_DBG_COMMAND( "GenerateMips", instance.GenerateMips(textureDbg.instance, subresource) );
 
+    InvalidateRecordedResources();
+
     profile_.mipMapsGenerations++;
 }
 
@@ -330,6 +568,12 @@ void DbgCommandBuffer::SetViewport(const Viewport& viewport)
     }
 
     LLGL_DBG_COMMAND( "SetViewport", instance.SetViewport(viewport) );
+
+    const bool redundant = (!recorded_.viewports.empty() && ::memcmp(&recorded_.viewports[0], &viewport, sizeof(Viewport)) == 0);
+    if (!redundant)
+        recorded_.viewports = { viewport };
+
+    RecordStateChange(DbgStateChangeAnalyzer::Command_SetViewport, nullptr, redundant);
 }
 
 void DbgCommandBuffer::SetViewports(std::uint32_t numViewports, const Viewport* viewports)
@@ -362,6 +606,19 @@ void DbgCommandBuffer::SetViewports(std::uint32_t numViewports, const Viewport*
     }
 
     LLGL_DBG_COMMAND( "SetViewports", instance.SetViewports(numViewports, viewports) );
+
+    if (viewports != nullptr)
+    {
+        const bool redundant = (numViewports <= recorded_.viewports.size() && ::memcmp(recorded_.viewports.data(), viewports, sizeof(Viewport)*numViewports) == 0);
+        if (!redundant)
+        {
+            if (recorded_.viewports.size() < numViewports)
+                recorded_.viewports.resize(numViewports);
+            std::copy(viewports, viewports + numViewports, recorded_.viewports.begin());
+        }
+
+        RecordStateChange(DbgStateChangeAnalyzer::Command_SetViewport, nullptr, redundant);
+    }
 }
 
 void DbgCommandBuffer::SetScissor(const Scissor& scissor)
@@ -396,6 +653,7 @@ void DbgCommandBuffer::SetVertexBuffer(Buffer& buffer)
         LLGL_DBG_SOURCE;
         AssertRecording();
         ValidateBindBufferFlags(bufferDbg, BindFlags::VertexBuffer);
+        TrackBufferHazard(bufferDbg);
 
         bindings_.vertexBufferStore[0]      = (&bufferDbg);
         bindings_.vertexBuffers             = bindings_.vertexBufferStore;
@@ -406,6 +664,11 @@ void DbgCommandBuffer::SetVertexBuffer(Buffer& buffer)
     LLGL_DBG_COMMAND( "SetVertexBuffer", instance.SetVertexBuffer(bufferDbg.instance) );
 
     profile_.vertexBufferBindings++;
+    MarkResourceUsed(bufferDbg);
+
+    const bool redundant = (recorded_.vertexBuffers == &bufferDbg);
+    recorded_.vertexBuffers = &bufferDbg;
+    RecordStateChange(DbgStateChangeAnalyzer::Command_SetVertexBuffer, &bufferDbg, redundant);
 }
 
 void DbgCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
@@ -416,7 +679,14 @@ void DbgCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
     {
         LLGL_DBG_SOURCE;
         AssertRecording();
-        ValidateBindFlags(bufferArrayDbg.GetBindFlags(), BindFlags::VertexBuffer, BindFlags::VertexBuffer, "LLGL::BufferArray");
+        if (IsValidationEnabled(DbgValidation_Bindings))
+            ValidateBindFlags(bufferArrayDbg.GetBindFlags(), BindFlags::VertexBuffer, BindFlags::VertexBuffer, "LLGL::BufferArray");
+
+        if (IsValidationEnabled(DbgValidation_Hazards))
+        {
+            for (auto bufferDbg : bufferArrayDbg.buffers)
+                TrackBufferHazard(*bufferDbg);
+        }
 
         bindings_.vertexBuffers         = bufferArrayDbg.buffers.data();
         bindings_.numVertexBuffers      = static_cast<std::uint32_t>(bufferArrayDbg.buffers.size());
@@ -436,6 +706,12 @@ void DbgCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
     LLGL_DBG_COMMAND( "SetVertexBufferArray", instance.SetVertexBufferArray(bufferArrayDbg.instance) );
 
     profile_.vertexBufferBindings++;
+    for (auto bufferDbg : bufferArrayDbg.buffers)
+        MarkResourceUsed(*bufferDbg);
+
+    const bool redundant = (recorded_.vertexBuffers == &bufferArrayDbg);
+    recorded_.vertexBuffers = &bufferArrayDbg;
+    RecordStateChange(DbgStateChangeAnalyzer::Command_SetVertexBuffer, &bufferArrayDbg, redundant);
 }
 
 void DbgCommandBuffer::SetIndexBuffer(Buffer& buffer)
@@ -448,6 +724,7 @@ void DbgCommandBuffer::SetIndexBuffer(Buffer& buffer)
         AssertRecording();
 
         ValidateBindBufferFlags(bufferDbg, BindFlags::IndexBuffer);
+        TrackBufferHazard(bufferDbg);
         ValidateIndexType(bufferDbg.desc.format);
 
         bindings_.indexBuffer           = (&bufferDbg);
@@ -458,6 +735,18 @@ void DbgCommandBuffer::SetIndexBuffer(Buffer& buffer)
     LLGL_DBG_COMMAND( "SetIndexBuffer", instance.SetIndexBuffer(bufferDbg.instance) );
 
     profile_.indexBufferBindings++;
+    MarkResourceUsed(bufferDbg);
+
+    const bool redundant =
+    (
+        recorded_.indexBuffer       == &bufferDbg               &&
+        recorded_.indexFormat       == bufferDbg.desc.format    &&
+        recorded_.indexBufferOffset == 0
+    );
+    recorded_.indexBuffer       = &bufferDbg;
+    recorded_.indexFormat       = bufferDbg.desc.format;
+    recorded_.indexBufferOffset = 0;
+    RecordStateChange(DbgStateChangeAnalyzer::Command_SetIndexBuffer, &bufferDbg, redundant);
 }
 
 //TODO: validation of <offset> param
@@ -471,6 +760,7 @@ void DbgCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::
         AssertRecording();
 
         ValidateBindBufferFlags(bufferDbg, BindFlags::IndexBuffer);
+        TrackBufferHazard(bufferDbg);
         ValidateIndexType(format);
 
         bindings_.indexBuffer           = (&bufferDbg);
@@ -490,6 +780,18 @@ void DbgCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::
     LLGL_DBG_COMMAND( "SetIndexBuffer", instance.SetIndexBuffer(bufferDbg.instance, format, offset) );
 
     profile_.indexBufferBindings++;
+    MarkResourceUsed(bufferDbg);
+
+    const bool redundant =
+    (
+        recorded_.indexBuffer       == &bufferDbg   &&
+        recorded_.indexFormat       == format       &&
+        recorded_.indexBufferOffset == offset
+    );
+    recorded_.indexBuffer       = &bufferDbg;
+    recorded_.indexFormat       = format;
+    recorded_.indexBufferOffset = offset;
+    RecordStateChange(DbgStateChangeAnalyzer::Command_SetIndexBuffer, &bufferDbg, redundant);
 }
 
 /* ----- Resources ----- */
@@ -499,6 +801,16 @@ void DbgCommandBuffer::SetResourceHeap(
     ResourceHeap&           resourceHeap,
     std::uint32_t           descriptorSet,
     const PipelineBindPoint bindPoint)
+{
+    SetResourceHeap(resourceHeap, descriptorSet, 0, nullptr, bindPoint);
+}
+
+void DbgCommandBuffer::SetResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           descriptorSet,
+    std::uint32_t           numDynamicOffsets,
+    const std::uint32_t*    dynamicOffsets,
+    const PipelineBindPoint bindPoint)
 {
     auto& resourceHeapDbg = LLGL_CAST(DbgResourceHeap&, resourceHeap);
 
@@ -506,12 +818,34 @@ void DbgCommandBuffer::SetResourceHeap(
     {
         LLGL_DBG_SOURCE;
         AssertRecording();
-        ValidateDescriptorSetIndex(descriptorSet, resourceHeapDbg.GetNumDescriptorSets(), resourceHeapDbg.label.c_str());
+        ValidateDescriptorSetIndex(descriptorSet, resourceHeapDbg.GetNumDescriptorSets(), DbgGetObjectName(resourceHeapDbg));
+        ValidateDynamicOffsets(resourceHeapDbg, numDynamicOffsets, dynamicOffsets);
+        TrackResourceHazards(resourceHeapDbg.resources);
     }
 
-    LLGL_DBG_COMMAND( "SetResourceHeap", instance.SetResourceHeap(resourceHeapDbg.instance, descriptorSet, bindPoint) );
+    LLGL_DBG_COMMAND( "SetResourceHeap", instance.SetResourceHeap(resourceHeapDbg.instance, descriptorSet, numDynamicOffsets, dynamicOffsets, bindPoint) );
 
     profile_.resourceHeapBindings++;
+
+    /* Mark all resources of the resource heap as used for the resource accounting */
+    MarkResourcesUsed(resourceHeapDbg);
+
+    /* Binding the same descriptor set again cannot be eliminated if its dynamic offsets may have changed */
+    const bool redundant =
+    (
+        recorded_.resourceHeap              == &resourceHeapDbg &&
+        recorded_.descriptorSet             == descriptorSet    &&
+        resourceHeapDbg.desc.barrierFlags   == 0                &&
+        numDynamicOffsets                   == 0
+    );
+    if (!redundant)
+    {
+        recorded_.resources.clear();
+        recorded_.resourceHeap  = &resourceHeapDbg;
+        recorded_.descriptorSet = descriptorSet;
+    }
+
+    RecordStateChange(DbgStateChangeAnalyzer::Command_SetResourceHeap, &resourceHeapDbg, redundant);
 }
 
 void DbgCommandBuffer::SetResource(
@@ -525,7 +859,7 @@ void DbgCommandBuffer::SetResource(
         LLGL_DBG_SOURCE;
         AssertRecording();
 
-        if (!features_.hasDirectResourceBinding)
+        if (!features_.hasDirectResourceBinding && !IsDynamicBinding(slot, bindFlags))
             LLGL_DBG_ERROR(ErrorType::UnsupportedFeature, "direct resource binding not supported");
 
         ValidateStageFlags(stageFlags, StageFlags::AllStages);
@@ -544,14 +878,22 @@ void DbgCommandBuffer::SetResource(
             /* Forward buffer resource to wrapped instance */
             auto& bufferDbg = LLGL_CAST(DbgBuffer&, resource);
 
-            ValidateBindFlags(
-                bufferDbg.desc.bindFlags,
-                bindFlags,
-                (BindFlags::ConstantBuffer | BindFlags::Sampled | BindFlags::Storage),
-                GetLabelOrDefault(bufferDbg.label, "LLGL::Buffer")
-            );
+            if (debugger_)
+            {
+                if (IsValidationEnabled(DbgValidation_Bindings))
+                {
+                    ValidateBindFlags(
+                        bufferDbg.desc.bindFlags,
+                        bindFlags,
+                        (BindFlags::ConstantBuffer | BindFlags::Sampled | BindFlags::Storage),
+                        GetLabelOrDefault(bufferDbg.label, "LLGL::Buffer")
+                    );
+                }
+                TrackBufferHazard(bufferDbg);
+            }
 
             instance.SetResource(bufferDbg.instance, slot, bindFlags, stageFlags);
+            MarkResourceUsed(bufferDbg);
 
             /* Record binding for profiling */
             if ((bindFlags & BindFlags::ConstantBuffer) != 0)
@@ -568,14 +910,18 @@ void DbgCommandBuffer::SetResource(
             /* Forward texture resource to wrapped instance */
             auto& textureDbg = LLGL_CAST(DbgTexture&, resource);
 
-            ValidateBindFlags(
-                textureDbg.desc.bindFlags,
-                bindFlags,
-                (BindFlags::Sampled | BindFlags::Storage | BindFlags::CombinedSampler),
-                GetLabelOrDefault(textureDbg.label, "LLGL::Buffer")
-            );
+            if (debugger_ && IsValidationEnabled(DbgValidation_Bindings))
+            {
+                ValidateBindFlags(
+                    textureDbg.desc.bindFlags,
+                    bindFlags,
+                    (BindFlags::Sampled | BindFlags::Storage | BindFlags::CombinedSampler),
+                    GetLabelOrDefault(textureDbg.label, "LLGL::Buffer")
+                );
+            }
 
             instance.SetResource(textureDbg.instance, slot, bindFlags, stageFlags);
+            MarkResourceUsed(textureDbg);
 
             /* Record binding for profiling */
             if ((bindFlags & BindFlags::Sampled) != 0)
@@ -589,7 +935,8 @@ void DbgCommandBuffer::SetResource(
         {
             /* No bind flags allowed for samplers */
             //TODO: use DbgSampler
-            ValidateBindFlags(0, bindFlags, 0, "LLGL::Sampler");
+            if (debugger_ && IsValidationEnabled(DbgValidation_Bindings))
+                ValidateBindFlags(0, bindFlags, 0, "LLGL::Sampler");
 
             /* Forward sampler resource to wrapped instance */
             instance.SetResource(resource, slot, bindFlags, stageFlags);
@@ -602,6 +949,8 @@ void DbgCommandBuffer::SetResource(
 
     if (perfProfilerEnabled_)
         EndTimer();
+
+    RecordStateChange(DbgStateChangeAnalyzer::Command_SetResource, &resource, IsRedundantResource(resource, slot, bindFlags));
 }
 
 void DbgCommandBuffer::ResetResourceSlots(
@@ -620,6 +969,8 @@ void DbgCommandBuffer::ResetResourceSlots(
     }
 
     LLGL_DBG_COMMAND( "ResetResourceSlots", instance.ResetResourceSlots(resourceType, firstSlot, numSlots, bindFlags, stageFlags) );
+
+    InvalidateRecordedResources();
 }
 
 /* ----- Render Passes ----- */
@@ -637,15 +988,22 @@ void DbgCommandBuffer::BeginRenderPass(
 
         if (states_.insideRenderPass)
             LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot begin new render pass while previous render pass is still active");
-        states_.insideRenderPass = true;
+        states_.insideRenderPass        = true;
+        states_.explicitRenderPass      = (renderPass != nullptr);
+        states_.subpass                 = 0;
     }
 
+    InvalidateRecordedStates();
+
     if (LLGL::IsInstanceOf<SwapChain>(renderTarget))
     {
         auto& swapChainDbg = LLGL_CAST(DbgSwapChain&, renderTarget);
 
-        bindings_.swapChain     = &swapChainDbg;
-        bindings_.renderTarget  = nullptr;
+        if (debugger_)
+        {
+            bindings_.swapChain     = &swapChainDbg;
+            bindings_.renderTarget  = nullptr;
+        }
 
         instance.BeginRenderPass(swapChainDbg.instance, renderPass, numClearValues, clearValues);
     }
@@ -653,8 +1011,21 @@ void DbgCommandBuffer::BeginRenderPass(
     {
         auto& renderTargetDbg = LLGL_CAST(DbgRenderTarget&, renderTarget);
 
-        bindings_.swapChain     = nullptr;
-        bindings_.renderTarget  = &renderTargetDbg;
+        /* Mark all attachments of the render target as used for the resource accounting */
+        if (resourceAccountingEnabled_)
+        {
+            for (const auto& attachment : renderTargetDbg.desc.attachments)
+            {
+                if (auto textureDbg = LLGL_CAST(DbgTexture*, attachment.texture))
+                    MarkResourceUsed(*textureDbg);
+            }
+        }
+
+        if (debugger_)
+        {
+            bindings_.swapChain     = nullptr;
+            bindings_.renderTarget  = &renderTargetDbg;
+        }
 
         instance.BeginRenderPass(renderTargetDbg.instance, renderPass, numClearValues, clearValues);
     }
@@ -676,6 +1047,22 @@ void DbgCommandBuffer::EndRenderPass()
     instance.EndRenderPass();
 }
 
+void DbgCommandBuffer::NextSubpass()
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertRecording();
+        AssertInsideRenderPass();
+        if (!states_.explicitRenderPass)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot advance to next sub-pass in render pass that was begun without render pass object");
+        else if (++states_.subpass >= LLGL_MAX_NUM_SUBPASSES)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot advance to next sub-pass beyond limit of " + std::to_string(LLGL_MAX_NUM_SUBPASSES) + " sub-passes");
+    }
+
+    instance.NextSubpass();
+}
+
 void DbgCommandBuffer::Clear(long flags, const ClearValue& clearValue)
 {
     if (debugger_)
@@ -723,6 +1110,9 @@ void DbgCommandBuffer::SetPipelineState(PipelineState& pipelineState)
 
         if (pipelineStateDbg.isGraphicsPSO)
         {
+            /* Store primitive topology used in graphics pipeline */
+            topology_ = pipelineStateDbg.graphicsDesc.primitiveTopology;
+
             if (auto vertexShader = pipelineStateDbg.graphicsDesc.vertexShader)
             {
                 auto vertexShaderDbg = LLGL_CAST(const DbgShader*, vertexShader);
@@ -739,10 +1129,6 @@ void DbgCommandBuffer::SetPipelineState(PipelineState& pipelineState)
         }
     }
 
-    /* Store primitive topology used in graphics pipeline */
-    if (pipelineStateDbg.isGraphicsPSO)
-        topology_ = pipelineStateDbg.graphicsDesc.primitiveTopology;
-
     /* Call wrapped function */
     LLGL_DBG_COMMAND( "SetPipelineState", instance.SetPipelineState(pipelineStateDbg.instance) );
 
@@ -750,6 +1136,16 @@ void DbgCommandBuffer::SetPipelineState(PipelineState& pipelineState)
         profile_.graphicsPipelineBindings++;
     else
         profile_.computePipelineBindings++;
+
+    const bool redundant = (recorded_.pipelineState == &pipelineStateDbg);
+    if (!redundant)
+    {
+        /* Pipeline state might override the viewports with its static viewports */
+        recorded_.pipelineState = &pipelineStateDbg;
+        recorded_.viewports.clear();
+    }
+
+    RecordStateChange(DbgStateChangeAnalyzer::Command_SetPipelineState, &pipelineStateDbg, redundant);
 }
 
 //TODO: add check of opposite state to Draw* commands
@@ -766,6 +1162,8 @@ void DbgCommandBuffer::SetBlendFactor(const ColorRGBAf& color)
     }
 
     LLGL_DBG_COMMAND( "SetBlendFactor", instance.SetBlendFactor(color) );
+
+    recorded_.pipelineState = nullptr;
 }
 
 //TODO: add check of opposite state to Draw* commands
@@ -782,6 +1180,22 @@ void DbgCommandBuffer::SetStencilReference(std::uint32_t reference, const Stenci
     }
 
     LLGL_DBG_COMMAND( "SetStencilReference", instance.SetStencilReference(reference, stencilFace) );
+
+    recorded_.pipelineState = nullptr;
+}
+
+void DbgCommandBuffer::SetShadingRate(const ShadingRate rate)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (!features_.hasVariableRateShading)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("variable rate shading");
+        if (rate > ShadingRate::Rate4x4)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "invalid shading rate: " + std::to_string(static_cast<int>(rate)));
+    }
+
+    LLGL_DBG_COMMAND( "SetShadingRate", instance.SetShadingRate(rate) );
 }
 
 void DbgCommandBuffer::SetUniform(
@@ -843,6 +1257,20 @@ void DbgCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
     instance.EndQuery(queryHeapDbg.instance, query);
 }
 
+void DbgCommandBuffer::ResolveQueries(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries)
+{
+    auto& queryHeapDbg = LLGL_CAST(DbgQueryHeap&, queryHeap);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertRecording();
+        ValidateResolveQueries(queryHeapDbg, firstQuery, numQueries);
+    }
+
+    instance.ResolveQueries(queryHeapDbg.instance, firstQuery, numQueries);
+}
+
 void DbgCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
 {
     auto& queryHeapDbg = LLGL_CAST(DbgQueryHeap&, queryHeap);
@@ -891,6 +1319,7 @@ void DbgCommandBuffer::BeginStreamOutput(std::uint32_t numBuffers, Buffer* const
             if (bufferDbg != nullptr)
             {
                 ValidateBindBufferFlags(*bufferDbg, BindFlags::StreamOutputBuffer);
+                TrackBufferHazard(*bufferDbg);
                 bindings_.streamOutputs[i] = bufferDbg;
                 bufferInstances[i] = &(bufferDbg->instance);
             }
@@ -1071,6 +1500,7 @@ void DbgCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
         LLGL_DBG_SOURCE;
         AssertIndirectDrawingSupported();
         ValidateBindBufferFlags(bufferDbg, BindFlags::IndirectBuffer);
+        TrackBufferHazard(bufferDbg);
         ValidateBufferRange(bufferDbg, offset, sizeof(DrawIndirectArguments));
         ValidateAddressAlignment(offset, 4, "<offset> parameter");
     }
@@ -1078,6 +1508,8 @@ void DbgCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
     LLGL_DBG_COMMAND( "DrawIndirect", instance.DrawIndirect(bufferDbg.instance, offset) );
 
     profile_.drawCommands++;
+
+    MarkResourceUsed(bufferDbg);
 }
 
 void DbgCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
@@ -1089,6 +1521,7 @@ void DbgCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::u
         LLGL_DBG_SOURCE;
         AssertIndirectDrawingSupported();
         ValidateBindBufferFlags(bufferDbg, BindFlags::IndirectBuffer);
+        TrackBufferHazard(bufferDbg);
         ValidateBufferRange(bufferDbg, offset, stride*numCommands);
         ValidateAddressAlignment(offset, 4, "<offset> parameter");
         ValidateAddressAlignment(stride, 4, "<stride> parameter");
@@ -1097,6 +1530,8 @@ void DbgCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::u
     LLGL_DBG_COMMAND( "DrawIndirect", instance.DrawIndirect(bufferDbg.instance, offset, numCommands, stride) );
 
     profile_.drawCommands += numCommands;
+
+    MarkResourceUsed(bufferDbg);
 }
 
 void DbgCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
@@ -1108,6 +1543,7 @@ void DbgCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
         LLGL_DBG_SOURCE;
         AssertIndirectDrawingSupported();
         ValidateBindBufferFlags(bufferDbg, BindFlags::IndirectBuffer);
+        TrackBufferHazard(bufferDbg);
         ValidateBufferRange(bufferDbg, offset, sizeof(DrawIndexedIndirectArguments));
         ValidateAddressAlignment(offset, 4, "<offset> parameter");
     }
@@ -1115,6 +1551,8 @@ void DbgCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
     LLGL_DBG_COMMAND( "DrawIndexedIndirect", instance.DrawIndexedIndirect(bufferDbg.instance, offset) );
 
     profile_.drawCommands++;
+
+    MarkResourceUsed(bufferDbg);
 }
 
 void DbgCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
@@ -1126,6 +1564,7 @@ void DbgCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset,
         LLGL_DBG_SOURCE;
         AssertIndirectDrawingSupported();
         ValidateBindBufferFlags(bufferDbg, BindFlags::IndirectBuffer);
+        TrackBufferHazard(bufferDbg);
         ValidateBufferRange(bufferDbg, offset, stride*numCommands);
         ValidateAddressAlignment(offset, 4, "<offset> parameter");
         ValidateAddressAlignment(stride, 4, "<stride> parameter");
@@ -1134,6 +1573,164 @@ void DbgCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset,
     LLGL_DBG_COMMAND( "DrawIndexedIndirect", instance.DrawIndexedIndirect(bufferDbg.instance, offset, numCommands, stride) );
 
     profile_.drawCommands += numCommands;
+
+    MarkResourceUsed(bufferDbg);
+}
+
+void DbgCommandBuffer::DrawIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride)
+{
+    auto& bufferDbg         = LLGL_CAST(DbgBuffer&, buffer);
+    auto& countBufferDbg    = LLGL_CAST(DbgBuffer&, countBuffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertIndirectDrawingSupported();
+        ValidateBindBufferFlags(bufferDbg, BindFlags::IndirectBuffer);
+        TrackBufferHazard(bufferDbg);
+        ValidateBufferRange(bufferDbg, offset, stride*maxNumCommands);
+        ValidateAddressAlignment(offset, 4, "<offset> parameter");
+        ValidateAddressAlignment(stride, 4, "<stride> parameter");
+        ValidateBindBufferFlags(countBufferDbg, BindFlags::IndirectBuffer);
+        TrackBufferHazard(countBufferDbg);
+        ValidateBufferRange(countBufferDbg, countOffset, sizeof(std::uint32_t));
+        ValidateAddressAlignment(countOffset, 4, "<countOffset> parameter");
+    }
+
+    LLGL_DBG_COMMAND( "DrawIndirectCount", instance.DrawIndirectCount(bufferDbg.instance, offset, countBufferDbg.instance, countOffset, maxNumCommands, stride) );
+
+    profile_.drawCommands++;
+
+    MarkResourceUsed(bufferDbg);
+    MarkResourceUsed(countBufferDbg);
+}
+
+void DbgCommandBuffer::DrawIndexedIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride)
+{
+    auto& bufferDbg         = LLGL_CAST(DbgBuffer&, buffer);
+    auto& countBufferDbg    = LLGL_CAST(DbgBuffer&, countBuffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertIndirectDrawingSupported();
+        ValidateBindBufferFlags(bufferDbg, BindFlags::IndirectBuffer);
+        TrackBufferHazard(bufferDbg);
+        ValidateBufferRange(bufferDbg, offset, stride*maxNumCommands);
+        ValidateAddressAlignment(offset, 4, "<offset> parameter");
+        ValidateAddressAlignment(stride, 4, "<stride> parameter");
+        ValidateBindBufferFlags(countBufferDbg, BindFlags::IndirectBuffer);
+        TrackBufferHazard(countBufferDbg);
+        ValidateBufferRange(countBufferDbg, countOffset, sizeof(std::uint32_t));
+        ValidateAddressAlignment(countOffset, 4, "<countOffset> parameter");
+    }
+
+    LLGL_DBG_COMMAND( "DrawIndexedIndirectCount", instance.DrawIndexedIndirectCount(bufferDbg.instance, offset, countBufferDbg.instance, countOffset, maxNumCommands, stride) );
+
+    profile_.drawCommands++;
+
+    MarkResourceUsed(bufferDbg);
+    MarkResourceUsed(countBufferDbg);
+}
+
+std::uint32_t DbgCommandBuffer::DrawPatchable(const DrawIndirectArguments& args)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertInstancingSupported();
+        if (args.firstInstance != 0)
+            AssertOffsetInstancingSupported();
+        ValidateDrawCmd(args.numVertices, args.firstVertex, args.numInstances, args.firstInstance);
+    }
+
+    std::uint32_t slot = Constants::invalidPatchSlot;
+    LLGL_DBG_COMMAND( "DrawPatchable", slot = instance.DrawPatchable(args) );
+
+    profile_.drawCommands++;
+
+    return slot;
+}
+
+std::uint32_t DbgCommandBuffer::DrawIndexedPatchable(const DrawIndexedIndirectArguments& args)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertInstancingSupported();
+        if (args.firstInstance != 0)
+            AssertOffsetInstancingSupported();
+        ValidateDrawIndexedCmd(args.numIndices, args.numInstances, args.firstIndex, args.vertexOffset, args.firstInstance);
+    }
+
+    std::uint32_t slot = Constants::invalidPatchSlot;
+    LLGL_DBG_COMMAND( "DrawIndexedPatchable", slot = instance.DrawIndexedPatchable(args) );
+
+    profile_.drawCommands++;
+
+    return slot;
+}
+
+bool DbgCommandBuffer::PatchDraw(std::uint32_t slot, const DrawIndirectArguments& args)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidatePatchSlot(slot);
+    }
+    return instance.PatchDraw(slot, args);
+}
+
+bool DbgCommandBuffer::PatchDrawIndexed(std::uint32_t slot, const DrawIndexedIndirectArguments& args)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidatePatchSlot(slot);
+    }
+    return instance.PatchDrawIndexed(slot, args);
+}
+
+void DbgCommandBuffer::DrawMeshTasks(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateDrawMeshTasksCmd();
+
+        if (numWorkGroupsX * numWorkGroupsY * numWorkGroupsZ == 0)
+            LLGL_DBG_WARN(WarningType::PointlessOperation, "mesh tasks have volume of 0 units");
+
+        ValidateThreadGroupLimit(numWorkGroupsX, limits_.maxMeshShaderWorkGroups[0]);
+        ValidateThreadGroupLimit(numWorkGroupsY, limits_.maxMeshShaderWorkGroups[1]);
+        ValidateThreadGroupLimit(numWorkGroupsZ, limits_.maxMeshShaderWorkGroups[2]);
+    }
+
+    LLGL_DBG_COMMAND( "DrawMeshTasks", instance.DrawMeshTasks(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ) );
+
+    profile_.drawCommands++;
+}
+
+void DbgCommandBuffer::DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateDrawMeshTasksCmd();
+        ValidateBindBufferFlags(bufferDbg, BindFlags::IndirectBuffer);
+        TrackBufferHazard(bufferDbg);
+        ValidateBufferRange(bufferDbg, offset, stride*numCommands);
+        ValidateAddressAlignment(offset, 4, "<offset> parameter");
+        ValidateAddressAlignment(stride, 4, "<stride> parameter");
+    }
+
+    LLGL_DBG_COMMAND( "DrawMeshTasksIndirect", instance.DrawMeshTasksIndirect(bufferDbg.instance, offset, numCommands, stride) );
+
+    profile_.drawCommands += numCommands;
+
+    MarkResourceUsed(bufferDbg);
 }
 
 /* ----- Compute ----- */
@@ -1166,6 +1763,7 @@ void DbgCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
     {
         LLGL_DBG_SOURCE;
         ValidateBindBufferFlags(bufferDbg, BindFlags::IndirectBuffer);
+        TrackBufferHazard(bufferDbg);
         ValidateBufferRange(bufferDbg, offset, sizeof(DispatchIndirectArguments));
         ValidateAddressAlignment(offset, 4, "<offset> parameter");
     }
@@ -1173,6 +1771,8 @@ void DbgCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
     LLGL_DBG_COMMAND( "DispatchIndirect", instance.DispatchIndirect(bufferDbg.instance, offset) );
 
     profile_.dispatchCommands++;
+
+    MarkResourceUsed(bufferDbg);
 }
 
 /* ----- Debugging ----- */
@@ -1183,27 +1783,39 @@ void DbgCommandBuffer::PushDebugGroup(const char* name)
     {
         LLGL_DBG_SOURCE;
         AssertNullPointer(name, "name");
-        debugger_->SetDebugGroup(name);
     }
 
     if (!name)
         name = "<null pointer>";
 
-    debugGroups_.push(name);
+    /* Debug group names are only stored for the debugger, so the profiler-only layer doesn't allocate a string for each group */
+    if (debugger_)
+        debugGroups_.push(name);
+
     instance.PushDebugGroup(name);
+
+    /* Open timer scope for all subsequently profiled commands */
+    if (perfProfilerEnabled_)
+        timerMngr_.PushScope(name);
+
+    if (stateChangeAnalysisEnabled_)
+        stateChangeAnalyzer_.PushScope(name);
 }
 
 void DbgCommandBuffer::PopDebugGroup()
 {
+    if (perfProfilerEnabled_)
+        timerMngr_.PopScope();
+
+    if (stateChangeAnalysisEnabled_)
+        stateChangeAnalyzer_.PopScope();
+
     instance.PopDebugGroup();
-    debugGroups_.pop();
 
     if (debugger_)
     {
-        if (debugGroups_.empty())
-            debugger_->SetDebugGroup(nullptr);
-        else
-            debugger_->SetDebugGroup(debugGroups_.top().c_str());
+        if (!debugGroups_.empty())
+            debugGroups_.pop();
     }
 }
 
@@ -1216,11 +1828,64 @@ void DbgCommandBuffer::SetGraphicsAPIDependentState(const void* stateDesc, std::
 
 /* ----- Internal ----- */
 
+void DbgCommandBuffer::ValidateSubmitHazards()
+{
+    if (hazardBuffers_.empty())
+        return;
+
+    LLGL_DBG_SOURCE;
+
+    /* Remove duplicates, so each buffer is only reported once per submission */
+    std::sort(hazardBuffers_.begin(), hazardBuffers_.end());
+    hazardBuffers_.erase(std::unique(hazardBuffers_.begin(), hazardBuffers_.end()), hazardBuffers_.end());
+
+    for (auto bufferDbg : hazardBuffers_)
+    {
+        if (bufferDbg->mapped)
+        {
+            LLGL_DBG_ERROR(
+                ErrorType::UndefinedBehavior,
+                "command buffer submitted while '" + std::string(GetLabelOrDefault(bufferDbg->label, "LLGL::Buffer")) +
+                "' is still mapped to CPU local memory"
+            );
+        }
+    }
+}
+
+void DbgCommandBuffer::MarkUsedResourcesOnSubmit()
+{
+    for (auto resource : usedResources_)
+    {
+        if (resource->GetResourceType() == ResourceType::Buffer)
+            LLGL_CAST(DbgBuffer*, resource)->used = true;
+        else if (resource->GetResourceType() == ResourceType::Texture)
+            LLGL_CAST(DbgTexture*, resource)->used = true;
+    }
+
+    for (auto resourceHeapDbg : usedResourceHeaps_)
+    {
+        for (auto resource : resourceHeapDbg->resources)
+        {
+            if (resource != nullptr)
+            {
+                if (resource->GetResourceType() == ResourceType::Buffer)
+                    LLGL_CAST(DbgBuffer*, resource)->used = true;
+                else if (resource->GetResourceType() == ResourceType::Texture)
+                    LLGL_CAST(DbgTexture*, resource)->used = true;
+            }
+        }
+    }
+}
+
 void DbgCommandBuffer::NextProfile(FrameProfile& outputProfile)
 {
-    /* Copy frame profile values to output profile */
+    /* Copy frame profile values to output profile; records are copied and cleared instead of moved, so both profiles keep their capacity */
     ::memcpy(outputProfile.values, profile_.values, sizeof(profile_.values));
-    outputProfile.timeRecords = std::move(profile_.timeRecords);
+    outputProfile.timeRecords = profile_.timeRecords;
+    outputProfile.stateChangeRecords = profile_.stateChangeRecords;
+    outputProfile.pipelineStatistics = profile_.pipelineStatistics;
+    profile_.timeRecords.clear();
+    profile_.stateChangeRecords.clear();
 }
 
 #undef LLGL_DBG_COMMAND
@@ -1513,15 +2178,18 @@ void DbgCommandBuffer::ValidateDrawCmd(
     AssertRecording();
     AssertInsideRenderPass();
     AssertGraphicsPipelineBound();
-    AssertVertexBufferBound();
-    ValidateVertexLayout();
     ValidateNumVertices(numVertices);
     ValidateNumInstances(numInstances);
     ValidateVertexID(firstVertex);
     ValidateInstanceID(firstInstance);
 
-    if (bindings_.numVertexBuffers > 0 && bindings_.anyShaderAttributes)
-        ValidateVertexLimit(numVertices + firstVertex, static_cast<std::uint32_t>(bindings_.vertexBuffers[0]->elements));
+    if (IsValidationEnabled(DbgValidation_Bindings))
+    {
+        AssertVertexBufferBound();
+        ValidateVertexLayout();
+        if (bindings_.numVertexBuffers > 0 && bindings_.anyShaderAttributes)
+            ValidateVertexLimit(numVertices + firstVertex, static_cast<std::uint32_t>(bindings_.vertexBuffers[0]->elements));
+    }
 }
 
 void DbgCommandBuffer::ValidateDrawIndexedCmd(
@@ -1530,13 +2198,17 @@ void DbgCommandBuffer::ValidateDrawIndexedCmd(
     AssertRecording();
     AssertInsideRenderPass();
     AssertGraphicsPipelineBound();
-    AssertVertexBufferBound();
-    AssertIndexBufferBound();
-    ValidateVertexLayout();
     ValidateNumVertices(numVertices);
     ValidateNumInstances(numInstances);
     ValidateInstanceID(firstInstance);
 
+    if (!IsValidationEnabled(DbgValidation_Bindings))
+        return;
+
+    AssertVertexBufferBound();
+    AssertIndexBufferBound();
+    ValidateVertexLayout();
+
     if (bindings_.indexBuffer)
     {
         if (bindings_.indexBufferFormatSize > 0)
@@ -1556,6 +2228,19 @@ void DbgCommandBuffer::ValidateDrawIndexedCmd(
     }
 }
 
+void DbgCommandBuffer::ValidateDrawMeshTasksCmd()
+{
+    AssertRecording();
+    AssertInsideRenderPass();
+    AssertMeshShadersSupported();
+
+    if (auto pipelineStateDbg = AssertAndGetGraphicsPSO())
+    {
+        if (pipelineStateDbg->graphicsDesc.meshShader == nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "graphics pipeline without mesh shader is bound but mesh shader pipeline is required for mesh tasks");
+    }
+}
+
 void DbgCommandBuffer::ValidateVertexLimit(std::uint32_t vertexCount, std::uint32_t vertexLimit)
 {
     if (vertexCount > vertexLimit)
@@ -1609,6 +2294,41 @@ void DbgCommandBuffer::ValidateDescriptorSetIndex(std::uint32_t setIndex, std::u
     }
 }
 
+void DbgCommandBuffer::ValidateDynamicOffsets(DbgResourceHeap& resourceHeapDbg, std::uint32_t numDynamicOffsets, const std::uint32_t* dynamicOffsets)
+{
+    if (numDynamicOffsets == 0)
+        return;
+
+    if (dynamicOffsets == nullptr)
+    {
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "dynamic offsets must not be null if the number of dynamic offsets is non-zero");
+        return;
+    }
+
+    if (auto pipelineLayoutDbg = LLGL_CAST(const DbgPipelineLayout*, resourceHeapDbg.desc.pipelineLayout))
+    {
+        const auto& bindings = pipelineLayoutDbg->dynamicOffsetBindings;
+        if (numDynamicOffsets > bindings.size())
+        {
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                "too many dynamic offsets: " + std::to_string(numDynamicOffsets) +
+                " specified but pipeline layout has only " + std::to_string(bindings.size()) + " dynamic-offset binding(s)"
+            );
+            numDynamicOffsets = static_cast<std::uint32_t>(bindings.size());
+        }
+
+        /* Dynamic offsets must satisfy the same alignment as buffer views */
+        for (std::uint32_t i = 0; i < numDynamicOffsets; ++i)
+        {
+            if ((bindings[i].bindFlags & BindFlags::ConstantBuffer) != 0)
+                ValidateAddressAlignment(dynamicOffsets[i], limits_.minConstantBufferAlignment, "dynamic offset for constant buffer");
+            else
+                ValidateAddressAlignment(dynamicOffsets[i], limits_.minStorageBufferAlignment, "dynamic offset for storage buffer");
+        }
+    }
+}
+
 static const char* BindFlagToString(long bindFlag)
 {
     switch (bindFlag)
@@ -1695,12 +2415,14 @@ void DbgCommandBuffer::ValidateBindFlags(long resourceFlags, long bindFlags, lon
 
 void DbgCommandBuffer::ValidateBindBufferFlags(DbgBuffer& bufferDbg, long bindFlags)
 {
-    ValidateBindFlags(bufferDbg.desc.bindFlags, bindFlags, bindFlags, GetLabelOrDefault(bufferDbg.label, "LLGL::Buffer"));
+    if (IsValidationEnabled(DbgValidation_Bindings))
+        ValidateBindFlags(bufferDbg.desc.bindFlags, bindFlags, bindFlags, GetLabelOrDefault(bufferDbg.label, "LLGL::Buffer"));
 }
 
 void DbgCommandBuffer::ValidateBindTextureFlags(DbgTexture& textureDbg, long bindFlags)
 {
-    ValidateBindFlags(textureDbg.desc.bindFlags, bindFlags, bindFlags, GetLabelOrDefault(textureDbg.label, "LLGL::Texture"));
+    if (IsValidationEnabled(DbgValidation_Bindings))
+        ValidateBindFlags(textureDbg.desc.bindFlags, bindFlags, bindFlags, GetLabelOrDefault(textureDbg.label, "LLGL::Texture"));
 }
 
 void DbgCommandBuffer::ValidateIndexType(const Format format)
@@ -1764,7 +2486,7 @@ void DbgCommandBuffer::ValidateBufferRange(DbgBuffer& bufferDbg, std::uint64_t o
         LLGL_DBG_ERROR(
             ErrorType::InvalidArgument,
             std::string(rangeName != nullptr ? rangeName : "range") + " out of bounds" +
-            std::string(bufferDbg.label.empty() ? "" : " for \"" + bufferDbg.label + "\"") + ": " +
+            std::string(bufferDbg.label.empty() ? "" : " for \"" + std::string(DbgGetObjectName(bufferDbg)) + "\"") + ": " +
             std::to_string(offset + size) + " specified but limit is " + std::to_string(bufferDbg.desc.size)
         );
     }
@@ -1816,6 +2538,31 @@ void DbgCommandBuffer::ValidateRenderCondition(DbgQueryHeap& queryHeapDbg, std::
         LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot use query heap for conditional rendering that was not created with 'renderCondition' enabled");
 }
 
+void DbgCommandBuffer::ValidateResolveQueries(DbgQueryHeap& queryHeapDbg, std::uint32_t firstQuery, std::uint32_t numQueries)
+{
+    if (queryHeapDbg.desc.renderCondition)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot resolve queries of query heap that was created with 'renderCondition' enabled");
+
+    if (numQueries == 0)
+        LLGL_DBG_WARN(WarningType::ImproperArgument, "resolving queries has no effect: <numQueries> is zero");
+
+    if (firstQuery + numQueries > queryHeapDbg.states.size())
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "query index range out of bounds: [" + std::to_string(firstQuery) + ".." + std::to_string(firstQuery + numQueries) + ")" +
+            " specified, but valid range is [0.." + std::to_string(queryHeapDbg.states.size()) + ")"
+        );
+        return;
+    }
+
+    for (std::uint32_t i = firstQuery; i < firstQuery + numQueries; ++i)
+    {
+        if (queryHeapDbg.states[i] == DbgQueryHeap::State::Busy)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot resolve query with index " + std::to_string(i) + " before it has ended");
+    }
+}
+
 void DbgCommandBuffer::ValidateStreamOutputs(std::uint32_t numBuffers)
 {
     if (numBuffers > limits_.maxStreamOutputs)
@@ -1828,6 +2575,24 @@ void DbgCommandBuffer::ValidateStreamOutputs(std::uint32_t numBuffers)
     }
 }
 
+bool DbgCommandBuffer::IsDynamicBinding(std::uint32_t slot, long bindFlags) const
+{
+    if (auto pipelineStateDbg = bindings_.pipelineState)
+    {
+        auto pipelineLayout = (pipelineStateDbg->isGraphicsPSO ? pipelineStateDbg->graphicsDesc.pipelineLayout : pipelineStateDbg->computeDesc.pipelineLayout);
+        if (pipelineLayout != nullptr)
+        {
+            auto pipelineLayoutDbg = LLGL_CAST(const DbgPipelineLayout*, pipelineLayout);
+            for (const auto& binding : pipelineLayoutDbg->desc.bindings)
+            {
+                if ((binding.flags & BindingFlags::DynamicBinding) != 0 && binding.slot == slot && (binding.bindFlags & bindFlags) != 0)
+                    return true;
+            }
+        }
+    }
+    return false;
+}
+
 DbgPipelineState* DbgCommandBuffer::AssertAndGetGraphicsPSO()
 {
     if (bindings_.pipelineState == nullptr)
@@ -1864,6 +2629,14 @@ void DbgCommandBuffer::AssertRecording()
         LLGL_DBG_ERROR(ErrorType::InvalidArgument, "command buffer must be in record mode: missing call to <LLGL::CommandQueue::Begin>");
 }
 
+void DbgCommandBuffer::ValidatePatchSlot(std::uint32_t slot)
+{
+    if (slot == Constants::invalidPatchSlot)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot patch draw command with invalid patch slot");
+    if (states_.recording)
+        LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot patch draw command while command buffer is in record mode");
+}
+
 void DbgCommandBuffer::AssertInsideRenderPass()
 {
     if (!states_.insideRenderPass)
@@ -1929,6 +2702,12 @@ void DbgCommandBuffer::AssertIndirectDrawingSupported()
         LLGL_DBG_ERROR_NOT_SUPPORTED("indirect drawing");
 }
 
+void DbgCommandBuffer::AssertMeshShadersSupported()
+{
+    if (!features_.hasMeshShaders)
+        LLGL_DBG_ERROR_NOT_SUPPORTED("mesh shaders");
+}
+
 void DbgCommandBuffer::AssertNullPointer(const void* ptr, const char* name)
 {
     if (ptr == nullptr)
@@ -1940,6 +2719,28 @@ void DbgCommandBuffer::AssertNullPointer(const void* ptr, const char* name)
     }
 }
 
+void DbgCommandBuffer::TrackBufferHazard(DbgBuffer& bufferDbg)
+{
+    /* Skip consecutive duplicates, since the same buffer is often used by several commands in a row */
+    if (IsValidationEnabled(DbgValidation_Hazards))
+    {
+        if (hazardBuffers_.empty() || hazardBuffers_.back() != &bufferDbg)
+            hazardBuffers_.push_back(&bufferDbg);
+    }
+}
+
+void DbgCommandBuffer::TrackResourceHazards(const std::vector<Resource*>& resources)
+{
+    if (IsValidationEnabled(DbgValidation_Hazards))
+    {
+        for (auto resource : resources)
+        {
+            if (resource != nullptr && resource->GetResourceType() == ResourceType::Buffer)
+                TrackBufferHazard(*LLGL_CAST(DbgBuffer*, resource));
+        }
+    }
+}
+
 void DbgCommandBuffer::WarnImproperVertices(const std::string& topologyName, std::uint32_t unusedVertices)
 {
     LLGL_DBG_WARN(
@@ -1953,6 +2754,7 @@ void DbgCommandBuffer::ResetFrameProfile()
 {
     /* Reset all counters of frame profile */
     ::memset(profile_.values, 0, sizeof(profile_.values));
+    profile_.pipelineStatistics = QueryPipelineStatistics{};
 }
 
 void DbgCommandBuffer::ResetBindings()
@@ -1965,6 +2767,92 @@ void DbgCommandBuffer::ResetStates()
     ::memset(&states_, 0, sizeof(states_));
 }
 
+bool DbgCommandBuffer::IsRedundantResource(Resource& resource, std::uint32_t slot, long bindFlags)
+{
+    /* Individual binding overrides the bindings of the recorded resource heap */
+    recorded_.resourceHeap = nullptr;
+
+    for (auto& binding : recorded_.resources)
+    {
+        if (binding.slot == slot && binding.bindFlags == bindFlags)
+        {
+            if (binding.resource == &resource)
+                return true;
+            binding.resource = &resource;
+            return false;
+        }
+    }
+
+    recorded_.resources.push_back({ &resource, slot, bindFlags });
+    return false;
+}
+
+void DbgCommandBuffer::InvalidateRecordedStates()
+{
+    recorded_.pipelineState     = nullptr;
+    recorded_.vertexBuffers     = nullptr;
+    recorded_.indexBuffer       = nullptr;
+    recorded_.viewports.clear();
+    InvalidateRecordedResources();
+}
+
+void DbgCommandBuffer::InvalidateRecordedResources()
+{
+    recorded_.resourceHeap = nullptr;
+    recorded_.resources.clear();
+}
+
+void DbgCommandBuffer::MarkResourceUsed(Resource& resource)
+{
+    /* Skip consecutive duplicates, since the same resource is often used by several commands in a row */
+    if (resourceAccountingEnabled_)
+    {
+        if (usedResources_.empty() || usedResources_.back() != &resource)
+            usedResources_.push_back(&resource);
+    }
+}
+
+void DbgCommandBuffer::MarkResourcesUsed(const DbgResourceHeap& resourceHeapDbg)
+{
+    if (resourceAccountingEnabled_)
+    {
+        if (usedResourceHeaps_.empty() || usedResourceHeaps_.back() != &resourceHeapDbg)
+            usedResourceHeaps_.push_back(&resourceHeapDbg);
+    }
+}
+
+void DbgCommandBuffer::PostDebugError(const ErrorType type, const StringView& message)
+{
+    if (debugger_)
+    {
+        std::lock_guard<std::mutex> guard{ DbgGetDebuggerMutex() };
+        debugger_->SetSource(source_);
+        debugger_->SetDebugGroup(debugGroups_.empty() ? nullptr : debugGroups_.top().c_str());
+        debugger_->PostError(type, message);
+        debugger_->SetDebugGroup(nullptr);
+    }
+}
+
+void DbgCommandBuffer::PostDebugWarning(const WarningType type, const StringView& message)
+{
+    if (debugger_)
+    {
+        std::lock_guard<std::mutex> guard{ DbgGetDebuggerMutex() };
+        debugger_->SetSource(source_);
+        debugger_->SetDebugGroup(debugGroups_.empty() ? nullptr : debugGroups_.top().c_str());
+        debugger_->PostWarning(type, message);
+        debugger_->SetDebugGroup(nullptr);
+    }
+}
+
+void DbgCommandBuffer::RecordStateChange(DbgStateChangeAnalyzer::Command command, const void* state, bool redundant)
+{
+    if (redundant)
+        profile_.commandsEliminated++;
+    if (stateChangeAnalysisEnabled_)
+        stateChangeAnalyzer_.Record(command, state, redundant);
+}
+
 void DbgCommandBuffer::StartTimer(const char* annotation)
 {
     timerMngr_.Start(annotation);
@@ -11,13 +11,17 @@
 
 #include <LLGL/CommandBuffer.h>
 #include <LLGL/RenderingProfiler.h>
+#include <LLGL/RenderingDebugger.h>
 #include <LLGL/StaticLimits.h>
 #include <LLGL/Container/ArrayView.h>
 #include "RenderState/DbgQueryHeap.h"
 #include "DbgQueryTimerManager.h"
+#include "DbgStateChangeAnalyzer.h"
+#include "DbgQueryStatisticsManager.h"
 #include <cstdint>
 #include <string>
 #include <stack>
+#include <vector>
 
 
 namespace LLGL
@@ -29,6 +33,7 @@ class DbgTexture;
 class DbgSwapChain;
 class DbgRenderTarget;
 class DbgPipelineState;
+class DbgResourceHeap;
 class DbgShader;
 class RenderingDebugger;
 class RenderingProfiler;
@@ -46,6 +51,7 @@ class DbgCommandBuffer final : public CommandBuffer
             CommandBuffer&                  commandBufferInstance,
             RenderingDebugger*              debugger,
             RenderingProfiler*              profiler,
+            std::uint32_t                   validationMask,
             const CommandBufferDescriptor&  desc,
             const RenderingCapabilities&    caps
         );
@@ -55,6 +61,8 @@ class DbgCommandBuffer final : public CommandBuffer
         void Begin() override;
         void End() override;
 
+        std::uint32_t QueryBeginStalls() override;
+
         void Execute(CommandBuffer& deferredCommandBuffer) override;
 
         /* ----- Blitting ----- */
@@ -66,6 +74,12 @@ class DbgCommandBuffer final : public CommandBuffer
             std::uint16_t   dataSize
         ) override;
 
+        void UpdateBuffer(
+            Buffer&                     dstBuffer,
+            std::uint32_t               numRegions,
+            const BufferWriteRegion*    regions
+        ) override;
+
         void CopyBuffer(
             Buffer&         dstBuffer,
             std::uint64_t   dstOffset,
@@ -74,6 +88,13 @@ class DbgCommandBuffer final : public CommandBuffer
             std::uint64_t   size
         ) override;
 
+        void CopyBuffer(
+            Buffer&                     dstBuffer,
+            Buffer&                     srcBuffer,
+            std::uint32_t               numRegions,
+            const BufferCopyRegion*     regions
+        ) override;
+
         void CopyBufferFromTexture(
             Buffer&                 dstBuffer,
             std::uint64_t           dstOffset,
@@ -83,6 +104,9 @@ class DbgCommandBuffer final : public CommandBuffer
             std::uint32_t           layerStride = 0
         ) override;
 
+        std::uint64_t CopyBufferToReadback(Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size) override;
+        std::uint64_t CopyTextureToReadback(Texture& srcTexture, const TextureRegion& srcRegion) override;
+
         void FillBuffer(
             Buffer&         dstBuffer,
             std::uint64_t   dstOffset,
@@ -98,6 +122,13 @@ class DbgCommandBuffer final : public CommandBuffer
             const Extent3D&         extent
         ) override;
 
+        void CopyTexture(
+            Texture&                    dstTexture,
+            Texture&                    srcTexture,
+            std::uint32_t               numRegions,
+            const TextureCopyRegion*    regions
+        ) override;
+
         void CopyTextureFromBuffer(
             Texture&                dstTexture,
             const TextureRegion&    dstRegion,
@@ -134,6 +165,14 @@ class DbgCommandBuffer final : public CommandBuffer
             const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined
         ) override;
 
+        void SetResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           descriptorSet,
+            std::uint32_t           numDynamicOffsets,
+            const std::uint32_t*    dynamicOffsets,
+            const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined
+        ) override;
+
         void SetResource(
             Resource&       resource,
             std::uint32_t   slot,
@@ -159,6 +198,7 @@ class DbgCommandBuffer final : public CommandBuffer
         ) override;
 
         void EndRenderPass() override;
+        void NextSubpass() override;
 
         void Clear(long flags, const ClearValue& clearValue) override;
         void ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments) override;
@@ -168,6 +208,7 @@ class DbgCommandBuffer final : public CommandBuffer
         void SetPipelineState(PipelineState& pipelineState) override;
         void SetBlendFactor(const ColorRGBAf& color) override;
         void SetStencilReference(std::uint32_t reference, const StencilFace stencilFace = StencilFace::FrontAndBack) override;
+        void SetShadingRate(const ShadingRate rate) override;
 
         void SetUniform(
             UniformLocation location,
@@ -186,6 +227,7 @@ class DbgCommandBuffer final : public CommandBuffer
 
         void BeginQuery(QueryHeap& queryHeap, std::uint32_t query = 0) override;
         void EndQuery(QueryHeap& queryHeap, std::uint32_t query = 0) override;
+        void ResolveQueries(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries) override;
 
         void BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query = 0, const RenderConditionMode mode = RenderConditionMode::Wait) override;
         void EndRenderCondition() override;
@@ -215,6 +257,18 @@ class DbgCommandBuffer final : public CommandBuffer
         void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset) override;
         void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
 
+        void DrawIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride) override;
+        void DrawIndexedIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride) override;
+
+        std::uint32_t DrawPatchable(const DrawIndirectArguments& args) override;
+        std::uint32_t DrawIndexedPatchable(const DrawIndexedIndirectArguments& args) override;
+
+        bool PatchDraw(std::uint32_t slot, const DrawIndirectArguments& args) override;
+        bool PatchDrawIndexed(std::uint32_t slot, const DrawIndexedIndirectArguments& args) override;
+
+        void DrawMeshTasks(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ) override;
+        void DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
+
         /* ----- Compute ----- */
 
         void Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ) override;
@@ -235,6 +289,12 @@ class DbgCommandBuffer final : public CommandBuffer
 
         void NextProfile(FrameProfile& outputProfile);
 
+        // Validates the buffers this command buffer uses for hazards at the time of submission (see DebugValidation::Hazards).
+        void ValidateSubmitHazards();
+
+        // Marks all resources this command buffer uses for the resource accounting at the time of submission (see RenderingProfiler::resourceAccountingEnabled).
+        void MarkUsedResourcesOnSubmit();
+
     public:
 
         /* ----- Debugging members ----- */
@@ -260,11 +320,13 @@ class DbgCommandBuffer final : public CommandBuffer
 
         void ValidateDrawCmd(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance);
         void ValidateDrawIndexedCmd(std::uint32_t numVertices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance);
+        void ValidateDrawMeshTasksCmd();
 
         void ValidateVertexLimit(std::uint32_t vertexCount, std::uint32_t vertexLimit);
         void ValidateThreadGroupLimit(std::uint32_t size, std::uint32_t limit);
         void ValidateAttachmentLimit(std::uint32_t attachmentIndex, std::uint32_t attachmentUpperBound);
         void ValidateDescriptorSetIndex(std::uint32_t setIndex, std::uint32_t setUpperBound, const char* resourceHeapName = nullptr);
+        void ValidateDynamicOffsets(DbgResourceHeap& resourceHeapDbg, std::uint32_t numDynamicOffsets, const std::uint32_t* dynamicOffsets);
 
         void ValidateBindFlags(long resourceFlags, long bindFlags, long validFlags, const char* resourceName = nullptr);
         void ValidateBindBufferFlags(DbgBuffer& bufferDbg, long bindFlags);
@@ -279,13 +341,18 @@ class DbgCommandBuffer final : public CommandBuffer
         bool ValidateQueryIndex(DbgQueryHeap& queryHeapDbg, std::uint32_t query);
         DbgQueryHeap::State* GetAndValidateQueryState(DbgQueryHeap& queryHeapDbg, std::uint32_t query);
         void ValidateRenderCondition(DbgQueryHeap& queryHeapDbg, std::uint32_t query);
+        void ValidateResolveQueries(DbgQueryHeap& queryHeapDbg, std::uint32_t firstQuery, std::uint32_t numQueries);
 
         void ValidateStreamOutputs(std::uint32_t numBuffers);
 
+        // Returns true if the pipeline layout of the bound PSO has a dynamic binding at the specified slot.
+        bool IsDynamicBinding(std::uint32_t slot, long bindFlags) const;
+
         DbgPipelineState* AssertAndGetGraphicsPSO();
         DbgPipelineState* AssertAndGetComputePSO();
 
         void AssertRecording();
+        void ValidatePatchSlot(std::uint32_t slot);
         void AssertInsideRenderPass();
         void AssertGraphicsPipelineBound();
         void AssertComputePipelineBound();
@@ -295,15 +362,46 @@ class DbgCommandBuffer final : public CommandBuffer
         void AssertInstancingSupported();
         void AssertOffsetInstancingSupported();
         void AssertIndirectDrawingSupported();
+        void AssertMeshShadersSupported();
 
         void AssertNullPointer(const void* ptr, const char* name);
 
+        // Returns true if the specified validation bits are enabled in addition to the structural validation (see DbgValidationBits).
+        inline bool IsValidationEnabled(std::uint32_t bits) const
+        {
+            return ((validationMask_ & bits) != 0);
+        }
+
+        // Stores a reference to the specified buffer to validate hazards when this command buffer is submitted.
+        void TrackBufferHazard(DbgBuffer& bufferDbg);
+        void TrackResourceHazards(const std::vector<Resource*>& resources);
+
         void WarnImproperVertices(const std::string& topologyName, std::uint32_t unusedVertices);
 
         void ResetFrameProfile();
         void ResetBindings();
         void ResetStates();
 
+        // Returns true if the specified resource is already bound with the same slot and binding flags, and otherwise stores the binding.
+        bool IsRedundantResource(Resource& resource, std::uint32_t slot, long bindFlags);
+
+        // Invalidates all recorded states that are used to detect redundant commands.
+        void InvalidateRecordedStates();
+
+        // Invalidates the recorded resource heap and resource bindings.
+        void InvalidateRecordedResources();
+
+        // Records the specified resource(s) as used; they are only marked in the shared resource objects on submission (see MarkUsedResourcesOnSubmit).
+        void MarkResourceUsed(Resource& resource);
+        void MarkResourcesUsed(const DbgResourceHeap& resourceHeapDbg);
+
+        // Posts a message to the shared debugger with the source and debug group of this command buffer.
+        void PostDebugError(const ErrorType type, const StringView& message);
+        void PostDebugWarning(const WarningType type, const StringView& message);
+
+        // Counts a redundant state-change command and records the call for the state-change analysis (if enabled).
+        void RecordStateChange(DbgStateChangeAnalyzer::Command command, const void* state, bool redundant);
+
         void StartTimer(const char* annotation);
         void EndTimer();
 
@@ -313,21 +411,36 @@ class DbgCommandBuffer final : public CommandBuffer
 
         RenderingDebugger*          debugger_                               = nullptr;
         RenderingProfiler*          profiler_                               = nullptr;
+        std::uint32_t               validationMask_                         = ~0u;      // Bitmask of DbgValidationBits.
 
         const RenderingFeatures&    features_;
         const RenderingLimits&      limits_;
 
         std::stack<std::string>     debugGroups_;
+        const char*                 source_                                 = "";       // Source function for debug messages; kept per command buffer, so recording threads don't write to the shared debugger.
 
         DbgQueryTimerManager        timerMngr_;
         bool                        perfProfilerEnabled_                    = false;
 
+        DbgStateChangeAnalyzer      stateChangeAnalyzer_;
+        bool                        stateChangeAnalysisEnabled_             = false;
+
+        DbgQueryStatisticsManager   statsMngr_;
+        bool                        pipelineStatisticsEnabled_              = false;
+
+        bool                        resourceAccountingEnabled_              = false;
+
         /* ----- Render states ----- */
 
         FrameProfile                profile_;
 
         PrimitiveTopology           topology_                               = PrimitiveTopology::TriangleList;
 
+        std::vector<DbgBuffer*>     hazardBuffers_;                                     // Buffers that are used by this command buffer; only if DbgValidation_Hazards is enabled.
+
+        std::vector<Resource*>              usedResources_;                             // Buffers and textures that are used by this command buffer; only if resourceAccountingEnabled_ is true.
+        std::vector<const DbgResourceHeap*> usedResourceHeaps_;                         // Resource heaps that are used by this command buffer; only if resourceAccountingEnabled_ is true.
+
         struct Bindings
         {
             DbgSwapChain*           swapChain                               = nullptr;
@@ -347,10 +460,34 @@ class DbgCommandBuffer final : public CommandBuffer
         }
         bindings_;
 
+        struct RecordedResource
+        {
+            Resource*               resource;
+            std::uint32_t           slot;
+            long                    bindFlags;
+        };
+
+        // Recorded states to detect redundant commands (see FrameProfile::commandsEliminated).
+        struct RecordedStates
+        {
+            DbgPipelineState*               pipelineState                   = nullptr;
+            DbgResourceHeap*                resourceHeap                    = nullptr;
+            std::uint32_t                   descriptorSet                   = 0;
+            const void*                     vertexBuffers                   = nullptr; // Either DbgBuffer or DbgBufferArray
+            DbgBuffer*                      indexBuffer                     = nullptr;
+            Format                          indexFormat                     = Format::Undefined;
+            std::uint64_t                   indexBufferOffset               = 0;
+            std::vector<Viewport>           viewports;
+            std::vector<RecordedResource>   resources;
+        }
+        recorded_;
+
         struct States
         {
             bool                    recording                               = false;
             bool                    insideRenderPass                        = false;
+            bool                    explicitRenderPass                      = false;
+            std::uint32_t           subpass                                 = 0;
             bool                    streamOutputBusy                        = false;
         }
         states_;
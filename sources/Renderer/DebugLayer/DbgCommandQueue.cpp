@@ -9,8 +9,11 @@
 #include "DbgCommandBuffer.h"
 #include "DbgCore.h"
 #include "../CheckedCast.h"
+#include <LLGL/Fence.h>
 #include <LLGL/RenderingProfiler.h>
 #include <LLGL/RenderingDebugger.h>
+#include <LLGL/Timer.h>
+#include <LLGL/Container/SmallVector.h>
 
 
 namespace LLGL
@@ -30,17 +33,43 @@ void DbgCommandQueue::Submit(CommandBuffer& commandBuffer)
 {
     auto& commandBufferDbg = LLGL_CAST(DbgCommandBuffer&, commandBuffer);
 
+    if (debugger_)
+        commandBufferDbg.ValidateSubmitHazards();
+
+    const auto startTick = Timer::Tick();
     instance.Submit(commandBufferDbg.instance);
+    WriteTraceEvent("Submit", startTick);
 
-    if (profiler_)
+    AccumulateProfile(commandBufferDbg);
+}
+
+void DbgCommandQueue::Submit(std::uint32_t numCommandBuffers, CommandBuffer* const * commandBuffers)
+{
+    if (debugger_)
     {
-        /* Merge frame profile values into rendering profiler */
-        FrameProfile profile;
-        commandBufferDbg.NextProfile(profile);
-        profile.commandBufferSubmittions++;
+        LLGL_DBG_SOURCE;
+        if (numCommandBuffers > 0 && commandBuffers == nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot submit command buffers with <commandBuffers> parameter being a null pointer");
+    }
 
-        profiler_->Accumulate(profile);
+    /* Forward instances of all command buffers to the wrapped queue, so they can be submitted at once */
+    SmallVector<CommandBuffer*, 8> instances;
+    instances.reserve(numCommandBuffers);
+
+    for (std::uint32_t i = 0; i < numCommandBuffers; ++i)
+    {
+        auto commandBufferDbg = LLGL_CAST(DbgCommandBuffer*, commandBuffers[i]);
+        if (debugger_)
+            commandBufferDbg->ValidateSubmitHazards();
+        instances.push_back(&(commandBufferDbg->instance));
     }
+
+    const auto startTick = Timer::Tick();
+    instance.Submit(numCommandBuffers, instances.data());
+    WriteTraceEvent("Submit", startTick);
+
+    for (std::uint32_t i = 0; i < numCommandBuffers; ++i)
+        AccumulateProfile(*LLGL_CAST(DbgCommandBuffer*, commandBuffers[i]));
 }
 
 /* ----- Queries ----- */
@@ -58,6 +87,24 @@ bool DbgCommandQueue::QueryResult(QueryHeap& queryHeap, std::uint32_t firstQuery
     return instance.QueryResult(queryHeapDbg.instance, firstQuery, numQueries, data, dataSize);
 }
 
+std::uint32_t DbgCommandQueue::TryGetQueryResults(QueryHeap& queryHeap, void* data, std::size_t dataSize, QueryRange* outRanges, std::uint32_t maxRanges)
+{
+    auto& queryHeapDbg = LLGL_CAST(DbgQueryHeap&, queryHeap);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateTryGetQueryResults(queryHeapDbg, data, dataSize, outRanges, maxRanges);
+    }
+
+    return instance.TryGetQueryResults(queryHeapDbg.instance, data, dataSize, outRanges, maxRanges);
+}
+
+bool DbgCommandQueue::QueryCalibratedTimestamps(CalibratedTimestamps& outTimestamps)
+{
+    return instance.QueryCalibratedTimestamps(outTimestamps);
+}
+
 /* ----- Fences ----- */
 
 void DbgCommandQueue::Submit(Fence& fence)
@@ -72,6 +119,22 @@ bool DbgCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
     return instance.WaitFence(fence, timeout);
 }
 
+bool DbgCommandQueue::WaitFenceValue(Fence& fence, std::uint64_t value, std::uint64_t timeout)
+{
+    return instance.WaitFenceValue(fence, value, timeout);
+}
+
+void DbgCommandQueue::SubmitWait(Fence& fence, std::uint64_t value)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (value > fence.GetValue())
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot wait for fence value that has not been submitted yet");
+    }
+    instance.SubmitWait(fence, value);
+}
+
 void DbgCommandQueue::WaitIdle()
 {
     instance.WaitIdle();
@@ -82,6 +145,27 @@ void DbgCommandQueue::WaitIdle()
  * ======= Private: =======
  */
 
+void DbgCommandQueue::AccumulateProfile(DbgCommandBuffer& commandBufferDbg)
+{
+    if (profiler_)
+    {
+        /* Merge frame profile values and resource usage into rendering profiler; recording threads only write to their own command buffer */
+        commandBufferDbg.MarkUsedResourcesOnSubmit();
+
+        submitProfile_.Clear();
+        commandBufferDbg.NextProfile(submitProfile_);
+        submitProfile_.commandBufferSubmittions++;
+
+        profiler_->Accumulate(submitProfile_);
+    }
+}
+
+void DbgCommandQueue::WriteTraceEvent(const char* name, std::uint64_t startTick)
+{
+    if (profiler_ != nullptr && profiler_->traceWriter != nullptr)
+        profiler_->traceWriter->WriteCPUEvent(name, startTick, Timer::Tick());
+}
+
 void DbgCommandQueue::ValidateQueryResult(
     DbgQueryHeap&   queryHeap,
     std::uint32_t   firstQuery,
@@ -124,6 +208,35 @@ void DbgCommandQueue::ValidateQueryResult(
 }
 
 
+void DbgCommandQueue::ValidateTryGetQueryResults(
+    DbgQueryHeap&   queryHeap,
+    void*           data,
+    std::size_t     dataSize,
+    QueryRange*     outRanges,
+    std::uint32_t   maxRanges)
+{
+    if (queryHeap.desc.renderCondition)
+        LLGL_DBG_ERROR(ErrorType::UndefinedBehavior, "cannot retrieve result from query that was created as render condition");
+
+    if (data == nullptr)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot retrieve query results with <data> parameter being a null pointer");
+
+    if (outRanges == nullptr && maxRanges > 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot retrieve query results with <outRanges> parameter being a null pointer");
+
+    if (maxRanges == 0)
+        LLGL_DBG_WARN(WarningType::ImproperArgument, "retrieving query results has no effect: <maxRanges> is zero");
+
+    const auto numQueries = queryHeap.desc.numQueries;
+    if ( dataSize != numQueries * sizeof(std::uint32_t          ) &&
+         dataSize != numQueries * sizeof(std::uint64_t          ) &&
+         dataSize != numQueries * sizeof(QueryPipelineStatistics) )
+    {
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "mismatch between required size for query results of the entire heap and <dataSize> parameter");
+    }
+}
+
+
 } // /namespace LLGL
 
 
@@ -10,6 +10,7 @@
 
 
 #include <LLGL/CommandQueue.h>
+#include <LLGL/RenderingProfiler.h>
 
 
 namespace LLGL
@@ -19,6 +20,7 @@ namespace LLGL
 class RenderingProfiler;
 class RenderingDebugger;
 class DbgQueryHeap;
+class DbgCommandBuffer;
 
 class DbgCommandQueue final : public CommandQueue
 {
@@ -36,6 +38,7 @@ class DbgCommandQueue final : public CommandQueue
         /* ----- Command Buffers ----- */
 
         void Submit(CommandBuffer& commandBuffer) override;
+        void Submit(std::uint32_t numCommandBuffers, CommandBuffer* const * commandBuffers) override;
 
         /* ----- Queries ----- */
 
@@ -47,11 +50,23 @@ class DbgCommandQueue final : public CommandQueue
             std::size_t     dataSize
         ) override;
 
+        std::uint32_t TryGetQueryResults(
+            QueryHeap&      queryHeap,
+            void*           data,
+            std::size_t     dataSize,
+            QueryRange*     outRanges,
+            std::uint32_t   maxRanges
+        ) override;
+
+        bool QueryCalibratedTimestamps(CalibratedTimestamps& outTimestamps) override;
+
         /* ----- Fences ----- */
 
         void Submit(Fence& fence) override;
 
         bool WaitFence(Fence& fence, std::uint64_t timeout) override;
+        bool WaitFenceValue(Fence& fence, std::uint64_t value, std::uint64_t timeout) override;
+        void SubmitWait(Fence& fence, std::uint64_t value) override;
         void WaitIdle() override;
 
     public:
@@ -70,11 +85,26 @@ class DbgCommandQueue final : public CommandQueue
             std::size_t     dataSize
         );
 
+        void ValidateTryGetQueryResults(
+            DbgQueryHeap&   queryHeap,
+            void*           data,
+            std::size_t     dataSize,
+            QueryRange*     outRanges,
+            std::uint32_t   maxRanges
+        );
+
+        void AccumulateProfile(DbgCommandBuffer& commandBufferDbg);
+
+        // Writes a CPU event from the specified start tick until now to the trace writer of the profiler (if set).
+        void WriteTraceEvent(const char* name, std::uint64_t startTick);
+
     private:
 
         RenderingProfiler* profiler_ = nullptr;
         RenderingDebugger* debugger_ = nullptr;
 
+        FrameProfile       submitProfile_;     // Intermediate profile of each submission; kept as member, so its records keep their capacity
+
 };
 
 
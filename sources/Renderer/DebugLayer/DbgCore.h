@@ -11,7 +11,10 @@
 
 #include <LLGL/RenderingProfiler.h>
 #include <LLGL/RenderingDebugger.h>
+#include <LLGL/RenderSystemFlags.h>
 #include <LLGL/Container/Strings.h>
+#include <mutex>
+#include "../../Core/StringInterner.h"
 
 
 namespace LLGL
@@ -31,6 +34,32 @@ namespace LLGL
     LLGL_DBG_ERROR(ErrorType::UnsupportedFeature, UTF8String(FEATURE) + " not supported")
 
 
+// Bits of the validations the debug layer performs in addition to the structural validation.
+enum DbgValidationBits : std::uint32_t
+{
+    DbgValidation_Bindings  = (1u << 0),
+    DbgValidation_Hazards   = (1u << 1),
+};
+
+// Returns the bitmask of DbgValidationBits for the specified validation tier, so hot paths only need to test a single bit.
+inline std::uint32_t DbgGetValidationMask(const DebugValidation tier)
+{
+    switch (tier)
+    {
+        case DebugValidation::Structural:   return 0;
+        case DebugValidation::Bindings:     return DbgValidation_Bindings;
+        case DebugValidation::Hazards:      return (DbgValidation_Bindings | DbgValidation_Hazards);
+    }
+    return ~0u;
+}
+
+// Returns the mutex that serializes posting messages to the RenderingDebugger, since command buffers may be recorded on multiple threads.
+inline std::mutex& DbgGetDebuggerMutex()
+{
+    static std::mutex debuggerMutex;
+    return debuggerMutex;
+}
+
 inline void DbgSetSource(RenderingDebugger* debugger, const char* source)
 {
     if (debugger)
@@ -40,29 +69,39 @@ inline void DbgSetSource(RenderingDebugger* debugger, const char* source)
 inline void DbgPostError(RenderingDebugger* debugger, ErrorType type, const StringView& message)
 {
     if (debugger)
+    {
+        std::lock_guard<std::mutex> guard{ DbgGetDebuggerMutex() };
         debugger->PostError(type, message);
+    }
 }
 
 inline void DbgPostWarning(RenderingDebugger* debugger, WarningType type, const StringView& message)
 {
     if (debugger)
+    {
+        std::lock_guard<std::mutex> guard{ DbgGetDebuggerMutex() };
         debugger->PostWarning(type, message);
+    }
 }
 
 // Sets the name of the specified debug layer object.
 template <typename T>
 inline void DbgSetObjectName(T& obj, const char* name)
 {
-    /* Set or clear label */
-    if (name != nullptr)
-        obj.label = name;
-    else
-        obj.label.clear();
+    /* Set or clear label; labels are interned so that naming objects every frame does not allocate memory */
+    obj.label = InternString(name != nullptr ? name : "");
 
     /* Forward call to instance */
     obj.instance.SetName(name);
 }
 
+// Returns the null-terminated name of the specified debug layer object or an empty string if the object has no name.
+template <typename T>
+inline const char* DbgGetObjectName(const T& obj)
+{
+    return (obj.label.empty() ? "" : obj.label.data());
+}
+
 
 } // /namespace LLGL
 
@@ -0,0 +1,146 @@
+/*
+ * DbgQueryStatisticsManager.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "DbgQueryStatisticsManager.h"
+#include <LLGL/RenderSystem.h>
+#include <LLGL/CommandQueue.h>
+#include <LLGL/CommandBuffer.h>
+#include <LLGL/QueryHeap.h>
+#include <LLGL/Misc/ForRange.h>
+#include <thread>
+
+
+namespace LLGL
+{
+
+
+static void AccumulatePipelineStatistics(QueryPipelineStatistics& dst, const QueryPipelineStatistics& src)
+{
+    dst.inputAssemblyVertices           += src.inputAssemblyVertices;
+    dst.inputAssemblyPrimitives         += src.inputAssemblyPrimitives;
+    dst.vertexShaderInvocations         += src.vertexShaderInvocations;
+    dst.geometryShaderInvocations       += src.geometryShaderInvocations;
+    dst.geometryShaderPrimitives        += src.geometryShaderPrimitives;
+    dst.clippingInvocations             += src.clippingInvocations;
+    dst.clippingPrimitives              += src.clippingPrimitives;
+    dst.fragmentShaderInvocations       += src.fragmentShaderInvocations;
+    dst.tessControlShaderInvocations    += src.tessControlShaderInvocations;
+    dst.tessEvaluationShaderInvocations += src.tessEvaluationShaderInvocations;
+    dst.computeShaderInvocations        += src.computeShaderInvocations;
+}
+
+DbgQueryStatisticsManager::DbgQueryStatisticsManager(
+    RenderSystem&   renderSystemInstance,
+    CommandQueue&   commandQueueInstance,
+    CommandBuffer&  commandBufferInstance)
+:
+    renderSystem_  { renderSystemInstance  },
+    commandQueue_  { commandQueueInstance  },
+    commandBuffer_ { commandBufferInstance },
+    queries_       ( 1                     )
+{
+}
+
+void DbgQueryStatisticsManager::Begin()
+{
+    /* Move on to the next query, which is the oldest one in the ring */
+    auto nextQuery = (currentQuery_ + 1) % queries_.size();
+
+    if (queries_[nextQuery].inFlight)
+    {
+        if (queries_.size() < g_maxNumQueriesInFlight)
+        {
+            /* Insert a new query into the ring right after the current one instead of waiting for the oldest query */
+            nextQuery = currentQuery_ + 1;
+            queries_.insert(queries_.begin() + nextQuery, Query{});
+        }
+        else
+        {
+            /* Only wait for the result if the ring has reached its maximum size, and keep the result for the next call to TakeResults */
+            ResolveQuery(queries_[nextQuery], pendingStats_, true);
+            queries_[nextQuery].inFlight = false;
+        }
+    }
+
+    currentQuery_ = nextQuery;
+
+    /* Create query heap on first use */
+    auto& query = queries_[currentQuery_];
+    if (query.queryHeap == nullptr)
+    {
+        QueryHeapDescriptor queryDesc;
+        {
+            queryDesc.type          = QueryType::PipelineStatistics;
+            queryDesc.numQueries    = 1;
+        }
+        query.queryHeap = renderSystem_.CreateQueryHeap(queryDesc);
+    }
+
+    commandBuffer_.BeginQuery(*query.queryHeap, 0);
+    isQueryActive_ = true;
+}
+
+void DbgQueryStatisticsManager::End()
+{
+    if (isQueryActive_)
+    {
+        auto& query = queries_[currentQuery_];
+        commandBuffer_.EndQuery(*query.queryHeap, 0);
+        query.inFlight = true;
+        isQueryActive_ = false;
+    }
+}
+
+void DbgQueryStatisticsManager::TakeResults(QueryPipelineStatistics& outStats)
+{
+    outStats = pendingStats_;
+    pendingStats_ = QueryPipelineStatistics{};
+
+    /* Resolve queries in flight from the oldest to the current one, and stop at the first query whose result is not yet available */
+    for_range(i, queries_.size())
+    {
+        auto& query = queries_[(currentQuery_ + 1 + i) % queries_.size()];
+        if (query.inFlight)
+        {
+            if (!ResolveQuery(query, outStats, false))
+                break;
+            query.inFlight = false;
+        }
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool DbgQueryStatisticsManager::ResolveQuery(Query& query, QueryPipelineStatistics& outStats, bool wait)
+{
+    constexpr int maxAttempts = 100;
+
+    QueryPipelineStatistics result;
+
+    for_range(attempt, (wait ? maxAttempts : 1))
+    {
+        if (commandQueue_.QueryResult(*query.queryHeap, 0, 1, &result, sizeof(result)))
+        {
+            AccumulatePipelineStatistics(outStats, result);
+            return true;
+        }
+        if (wait)
+            std::this_thread::yield();
+    }
+
+    return false;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,85 @@
+/*
+ * DbgQueryStatisticsManager.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_DBG_QUERY_STATISTICS_MANAGER_H
+#define LLGL_DBG_QUERY_STATISTICS_MANAGER_H
+
+
+#include <LLGL/ForwardDecls.h>
+#include <LLGL/QueryHeapFlags.h>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+Pipeline statistics query manager for the performance profiler of the debug layer.
+Each command buffer encoding is bracketed by a single pipeline statistics query. The queries are kept in a ring and
+their results are only resolved once they are available, i.e. the statistics are reported with a latency of one or more encodings.
+If the oldest query is still in flight when a new encoding begins, another query is inserted into the ring instead of waiting for it,
+until the ring has reached 'g_maxNumQueriesInFlight' queries. Only then the result of the oldest query is awaited.
+*/
+class DbgQueryStatisticsManager
+{
+
+    public:
+
+        DbgQueryStatisticsManager(
+            RenderSystem&   renderSystemInstance,
+            CommandQueue&   commandQueueInstance,
+            CommandBuffer&  commandBufferInstance
+        );
+
+        // Begins the pipeline statistics query for the current command buffer encoding.
+        void Begin();
+
+        // Ends the pipeline statistics query of the current command buffer encoding.
+        void End();
+
+        // Accumulates the results of all previous encodings that are available into the output statistics and resets them otherwise.
+        void TakeResults(QueryPipelineStatistics& outStats);
+
+    private:
+
+        static constexpr std::size_t g_maxNumQueriesInFlight = 8;
+
+        struct Query
+        {
+            QueryHeap*  queryHeap   = nullptr;
+            bool        inFlight    = false;
+        };
+
+    private:
+
+        // Adds the result of the specified query to the output statistics and returns true if it was available. If 'wait' is true, the result is awaited.
+        bool ResolveQuery(Query& query, QueryPipelineStatistics& outStats, bool wait);
+
+    private:
+
+        RenderSystem&           renderSystem_;
+        CommandQueue&           commandQueue_;
+        CommandBuffer&          commandBuffer_;
+
+        std::vector<Query>      queries_;
+        std::size_t             currentQuery_   = 0;
+        bool                    isQueryActive_  = false;
+
+        QueryPipelineStatistics pendingStats_;          // Results of queries that had to be awaited before they were taken
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -11,6 +11,7 @@
 #include <LLGL/CommandQueue.h>
 #include <LLGL/QueryHeap.h>
 #include <LLGL/Misc/ForRange.h>
+#include <algorithm>
 #include <thread>
 
 
@@ -27,86 +28,257 @@ DbgQueryTimerManager::DbgQueryTimerManager(
 :
     renderSystem_  { renderSystemInstance  },
     commandQueue_  { commandQueueInstance  },
-    commandBuffer_ { commandBufferInstance }
+    commandBuffer_ { commandBufferInstance },
+    frames_        ( 1                     )
 {
 }
 
 void DbgQueryTimerManager::Reset()
 {
-    records_.clear();
-    currentQuery_       = 0;
-    currentQueryHeap_   = 0;
+    /* Move on to the next frame, which is the oldest one in the ring */
+    auto nextFrame = (currentFrame_ + 1) % frames_.size();
+
+    if (frames_[nextFrame].inFlight)
+    {
+        if (ResolveQueryResults(frames_[nextFrame], false))
+        {
+            /* Drop records of the oldest frame; they have not been taken yet, because a newer frame was still pending */
+            frames_[nextFrame].inFlight = false;
+        }
+        else if (frames_.size() < g_maxNumFramesInFlight)
+        {
+            /* Insert a new frame into the ring right after the current one instead of waiting for the oldest frame */
+            nextFrame = currentFrame_ + 1;
+            frames_.insert(frames_.begin() + nextFrame, Frame{});
+        }
+        else
+        {
+            /* Only wait for the results if the ring has reached its maximum size; their records are dropped, since newer frames are available once these are resolved */
+            ResolveQueryResults(frames_[nextFrame], true);
+            frames_[nextFrame].inFlight = false;
+        }
+    }
+
+    currentFrame_ = nextFrame;
+
+    auto& frame = frames_[currentFrame_];
+    frame.records.clear();
+    frame.queryRecords.clear();
+    frame.numResolvedQueries = 0;
+
+    /* Scopes cannot span multiple frames */
+    scopeStack_.clear();
+    isQueryActive_ = false;
 }
 
 void DbgQueryTimerManager::Start(const char* annotation)
 {
-    /* Store annotation only first */
+    /* Interrupt the segment of the innermost scope, since timer queries must not overlap */
+    EndTimerQuery();
+
+    /* Begin timer query for new record */
+    BeginTimerQuery(AppendRecord(annotation));
+    commandStartTime_ = Clock::now();
+}
+
+void DbgQueryTimerManager::Stop()
+{
+    auto& frame = frames_[currentFrame_];
+    if (!isQueryActive_ || frame.queryRecords.empty())
+        return;
+
+    /* Store CPU time of current record */
+    const auto cpuTime = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - commandStartTime_);
+    frame.records[frame.queryRecords.back()].cpuTime = static_cast<std::uint64_t>(cpuTime.count());
+
+    /* Stop timer query and resume the segment of the innermost scope */
+    EndTimerQuery();
+    BeginScopeSegment();
+}
+
+void DbgQueryTimerManager::PushScope(const char* name)
+{
+    EndTimerQuery();
+
+    /* Store scope name persistently, since debug group names are only valid until the function returns */
+    const auto annotation = scopeNames_.insert(name).first->c_str();
+
+    scopeStack_.push_back({ AppendRecord(annotation), Clock::now() });
+
+    BeginScopeSegment();
+}
+
+void DbgQueryTimerManager::PopScope()
+{
+    if (scopeStack_.empty())
+        return;
+
+    EndTimerQuery();
+
+    /* Store CPU time of innermost scope, i.e. the time between push and pop */
+    const auto& scope = scopeStack_.back();
+    const auto cpuTime = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - scope.startTime);
+    frames_[currentFrame_].records[scope.record].cpuTime = static_cast<std::uint64_t>(cpuTime.count());
+
+    scopeStack_.pop_back();
+
+    /* Resume the segment of the parent scope */
+    BeginScopeSegment();
+}
+
+void DbgQueryTimerManager::PopAllScopes()
+{
+    while (!scopeStack_.empty())
+        PopScope();
+}
+
+void DbgQueryTimerManager::TakeRecords(std::vector<ProfileTimeRecord>& outRecords)
+{
+    frames_[currentFrame_].inFlight = true;
+
+    /* Resolve frames in flight from the oldest to the current one, and stop at the first frame whose results are not yet available */
+    Frame* latestFrame = nullptr;
+
+    for_range(i, frames_.size())
+    {
+        auto& frame = frames_[(currentFrame_ + 1 + i) % frames_.size()];
+        if (frame.inFlight)
+        {
+            if (!ResolveQueryResults(frame, false))
+                break;
+            frame.inFlight = false;
+            latestFrame = &frame;
+        }
+    }
+
+    /* Output records of the most recent resolved frame */
+    if (latestFrame != nullptr)
+    {
+        AccumulateScopeTimes(*latestFrame);
+        /* Copy records instead of moving them, so both containers keep their capacity and steady-state frames do not allocate memory */
+        outRecords.assign(latestFrame->records.begin(), latestFrame->records.end());
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+std::uint32_t DbgQueryTimerManager::AppendRecord(const char* annotation)
+{
+    auto& frame = frames_[currentFrame_];
+
+    /* Store annotation and hierarchy only first */
     ProfileTimeRecord record;
     {
         record.annotation   = annotation;
         record.elapsedTime  = 0;
+        record.cpuTime      = 0;
+        record.depth        = static_cast<std::uint32_t>(scopeStack_.size());
+        if (!scopeStack_.empty())
+            record.parent   = scopeStack_.back().record;
     }
-    records_.push_back(record);
+    frame.records.push_back(record);
 
-    /* Check if end of query heap has been reached */
-    if (currentQuery_ == g_queryTimerHeapSize)
-    {
-        currentQuery_ = 0;
-        ++currentQueryHeap_;
-    }
+    return static_cast<std::uint32_t>(frame.records.size() - 1);
+}
+
+void DbgQueryTimerManager::BeginTimerQuery(std::uint32_t record)
+{
+    auto& frame = frames_[currentFrame_];
+
+    /* Each query heap holds a fixed number of consecutive queries */
+    const auto query        = static_cast<std::uint32_t>(frame.queryRecords.size() % g_queryTimerHeapSize);
+    const auto queryHeap    = frame.queryRecords.size() / g_queryTimerHeapSize;
 
     /* Check if new query heap must be created */
-    if (currentQueryHeap_ == queryHeaps_.size())
+    if (queryHeap == frame.queryHeaps.size())
     {
         QueryHeapDescriptor queryDesc;
         {
             queryDesc.type          = QueryType::TimeElapsed;
             queryDesc.numQueries    = g_queryTimerHeapSize;
         }
-        queryHeaps_.push_back(renderSystem_.CreateQueryHeap(queryDesc));
+        frame.queryHeaps.push_back(renderSystem_.CreateQueryHeap(queryDesc));
     }
 
     /* Begin timer query */
-    commandBuffer_.BeginQuery(*queryHeaps_[currentQueryHeap_], currentQuery_);
+    frame.queryRecords.push_back(record);
+    commandBuffer_.BeginQuery(*frame.queryHeaps[queryHeap], query);
+    isQueryActive_ = true;
 }
 
-void DbgQueryTimerManager::Stop()
+void DbgQueryTimerManager::EndTimerQuery()
 {
-    /* Stop timer query */
-    commandBuffer_.EndQuery(*queryHeaps_[currentQueryHeap_], currentQuery_);
-
-    /* Increase query index */
-    ++currentQuery_;
+    if (isQueryActive_)
+    {
+        /* End the most recent timer query */
+        auto& frame = frames_[currentFrame_];
+        const auto lastQuery = frame.queryRecords.size() - 1;
+        commandBuffer_.EndQuery(*frame.queryHeaps[lastQuery / g_queryTimerHeapSize], static_cast<std::uint32_t>(lastQuery % g_queryTimerHeapSize));
+        isQueryActive_ = false;
+    }
 }
 
-void DbgQueryTimerManager::TakeRecords(std::vector<ProfileTimeRecord>& outRecords)
+void DbgQueryTimerManager::BeginScopeSegment()
 {
-    ResolveQueryResults();
-    outRecords = std::move(records_);
+    if (!scopeStack_.empty())
+        BeginTimerQuery(scopeStack_.back().record);
 }
 
-
-/*
- * ======= Private: =======
- */
-
-void DbgQueryTimerManager::ResolveQueryResults()
+bool DbgQueryTimerManager::ResolveQueryResults(Frame& frame, bool wait)
 {
     constexpr int maxAttempts = 100;
 
-    for_range(i, records_.size())
+    while (frame.numResolvedQueries < frame.queryRecords.size())
     {
-        auto&   rec         = records_[i];
-        auto    query       = static_cast<std::uint32_t>(i % g_queryTimerHeapSize);
-        auto    queryHeap   = static_cast<std::uint32_t>(i / g_queryTimerHeapSize);
-
-        for_range(i, maxAttempts)
+        if (wait)
         {
-            if (!commandQueue_.QueryResult(*queryHeaps_[queryHeap], query, 1, &(rec.elapsedTime), sizeof(rec.elapsedTime)))
-                std::this_thread::yield();
-            else
-                break;
+            for_range(attempt, maxAttempts)
+            {
+                if (ResolveQueryHeapResults(frame) == 0)
+                    std::this_thread::yield();
+                else
+                    break;
+            }
         }
+        else if (ResolveQueryHeapResults(frame) == 0)
+            return false;
+    }
+
+    return true;
+}
+
+std::size_t DbgQueryTimerManager::ResolveQueryHeapResults(Frame& frame)
+{
+    /* Determine range of unresolved queries within the next query heap */
+    const auto firstQuery   = frame.numResolvedQueries;
+    const auto query        = static_cast<std::uint32_t>(firstQuery % g_queryTimerHeapSize);
+    const auto queryHeap    = static_cast<std::uint32_t>(firstQuery / g_queryTimerHeapSize);
+    const auto numQueries   = static_cast<std::uint32_t>(std::min<std::size_t>(g_queryTimerHeapSize - query, frame.queryRecords.size() - firstQuery));
+
+    /* Query all results of this range at once; this fails if any of them is not available yet */
+    std::uint64_t elapsedTimes[g_queryTimerHeapSize];
+    if (!commandQueue_.QueryResult(*frame.queryHeaps[queryHeap], query, numQueries, elapsedTimes, sizeof(std::uint64_t) * numQueries))
+        return 0;
+
+    /* Add elapsed times to their records, since scopes are measured in multiple segments */
+    for_range(i, numQueries)
+        frame.records[frame.queryRecords[firstQuery + i]].elapsedTime += elapsedTimes[i];
+
+    frame.numResolvedQueries += numQueries;
+    return numQueries;
+}
+
+void DbgQueryTimerManager::AccumulateScopeTimes(Frame& frame)
+{
+    /* Records are stored in depth-first order, so iterating backwards adds each child to its parent before the parent is added to its own parent */
+    for (auto i = frame.records.size(); i > 0; --i)
+    {
+        const auto& record = frame.records[i - 1];
+        if (record.parent != ProfileTimeRecord::invalidIndex)
+            frame.records[record.parent].elapsedTime += record.elapsedTime;
     }
 }
 
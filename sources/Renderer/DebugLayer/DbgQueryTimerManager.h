@@ -1,6 +1,6 @@
 /*
  * DbgQueryTimerManager.h
- * 
+ *
  * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
  * See "LICENSE.txt" for license information.
  */
@@ -12,12 +12,25 @@
 #include <LLGL/ForwardDecls.h>
 #include <LLGL/RenderingProfiler.h>
 #include <vector>
+#include <string>
+#include <unordered_set>
+#include <chrono>
 
 
 namespace LLGL
 {
 
 
+/*
+Timer query manager for the performance profiler of the debug layer.
+The query heaps of each frame are kept in a ring and reused, and the results of a frame are only resolved
+once they are available, so the profiler doesn't stall the GPU timeline it is measuring.
+If the oldest frame is still in flight when a new frame begins, another frame is inserted into the ring instead of waiting for it,
+until the ring has reached 'g_maxNumFramesInFlight' frames. Only then the results of the oldest frame are awaited.
+Consequently, the time records of a frame are reported with a latency of one or more frames.
+Records are nested into scopes (see PushScope/PopScope). Since timer queries must not overlap, the GPU time of a scope is measured
+in segments between the commands of that scope, and the time of all nested records is added once the results have been resolved.
+*/
 //TODO: rename to DbgQueryTimerPool
 class DbgQueryTimerManager
 {
@@ -30,7 +43,7 @@ class DbgQueryTimerManager
             CommandBuffer&  commandBufferInstance
         );
 
-        // Resets all records in this timer manager.
+        // Starts a new frame of records in this timer manager.
         void Reset();
 
         // Starts measuring the time with the specified annotation.
@@ -39,13 +52,70 @@ class DbgQueryTimerManager
         // Stops measing the time and stores the current record.
         void Stop();
 
-        // Moves the internal records to the specified output container.
+        // Opens a new scope with the specified name. All subsequent records are children of this scope until it is closed.
+        void PushScope(const char* name);
+
+        // Closes the innermost scope.
+        void PopScope();
+
+        // Closes all scopes that are still open; this must be called before the command buffer ends encoding.
+        void PopAllScopes();
+
+        /*
+        Submits the records of the current frame and moves the records of the most recent frame,
+        whose results are available, to the specified output container. The output is left unchanged if no frame is available yet.
+        */
         void TakeRecords(std::vector<ProfileTimeRecord>& outRecords);
 
     private:
 
-        // Resolves all timer values into the output records.
-        void ResolveQueryResults();
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr std::size_t g_maxNumFramesInFlight = 8;
+
+        struct Frame
+        {
+            std::vector<QueryHeap*>         queryHeaps;
+            std::vector<ProfileTimeRecord>  records;
+            std::vector<std::uint32_t>      queryRecords;               // Record index for each timer query
+            std::size_t                     numResolvedQueries  = 0;
+            bool                            inFlight            = false;
+        };
+
+        struct Scope
+        {
+            std::uint32_t       record;
+            Clock::time_point   startTime;
+        };
+
+    private:
+
+        // Appends a new record to the current frame as child of the innermost scope and returns its index.
+        std::uint32_t AppendRecord(const char* annotation);
+
+        // Begins a new timer query whose result is added to the specified record.
+        void BeginTimerQuery(std::uint32_t record);
+
+        // Ends the active timer query, if there is one.
+        void EndTimerQuery();
+
+        // Begins a new timer query segment for the innermost scope, if there is one.
+        void BeginScopeSegment();
+
+        /*
+        Resolves the timer values of the specified frame into its records.
+        Returns true if all results have been resolved. If 'wait' is false, pending results are not awaited.
+        */
+        bool ResolveQueryResults(Frame& frame, bool wait);
+
+        /*
+        Resolves the timer values of up to one query heap of the specified frame with a single query result.
+        Returns the number of resolved queries, or 0 if the results are not available yet.
+        */
+        std::size_t ResolveQueryHeapResults(Frame& frame);
+
+        // Adds the elapsed time of each record to its parent scope, so each scope covers all of its nested records.
+        void AccumulateScopeTimes(Frame& frame);
 
     private:
 
@@ -53,11 +123,13 @@ class DbgQueryTimerManager
         CommandQueue&                   commandQueue_;
         CommandBuffer&                  commandBuffer_;
 
-        std::vector<QueryHeap*>         queryHeaps_;
-        std::uint32_t                   currentQuery_       = 0;
-        std::uint32_t                   currentQueryHeap_   = 0;
+        std::vector<Frame>              frames_;
+        std::size_t                     currentFrame_       = 0;
 
-        std::vector<ProfileTimeRecord>  records_;
+        std::vector<Scope>              scopeStack_;
+        std::unordered_set<std::string> scopeNames_;                    // Persistent storage for the annotations of scope records
+        Clock::time_point               commandStartTime_;
+        bool                            isQueryActive_      = false;
 
 };
 
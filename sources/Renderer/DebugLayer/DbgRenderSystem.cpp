@@ -12,9 +12,11 @@
 #include "../CheckedCast.h"
 #include "../../Core/Helper.h"
 #include <LLGL/ImageFlags.h>
+#include <LLGL/TypeInfo.h>
 #include <LLGL/StaticLimits.h>
 #include <LLGL/Misc/TypeNames.h>
 #include <LLGL/Misc/ForRange.h>
+#include <algorithm>
 
 
 namespace LLGL
@@ -30,14 +32,24 @@ into a single braces block to highlight this function call, wher the input param
 All the actual render system objects are stored in the members named "instance", since they are the actual object instances.
 */
 
-DbgRenderSystem::DbgRenderSystem(RenderSystemPtr&& instance, RenderingProfiler* profiler, RenderingDebugger* debugger) :
-    instance_ { std::forward<RenderSystemPtr&&>(instance) },
-    profiler_ { profiler                                  },
-    debugger_ { debugger                                  },
-    caps_     { GetRenderingCaps()                        },
-    features_ { caps_.features                            },
-    limits_   { caps_.limits                              }
+DbgRenderSystem::DbgRenderSystem(RenderSystemPtr&& instance, RenderingProfiler* profiler, RenderingDebugger* debugger, const DebugValidation validation) :
+    instance_       { std::forward<RenderSystemPtr&&>(instance) },
+    profiler_       { profiler                                  },
+    debugger_       { debugger                                  },
+    validationMask_ { DbgGetValidationMask(validation)          },
+    caps_           { GetRenderingCaps()                        },
+    features_       { caps_.features                            },
+    limits_         { caps_.limits                              }
 {
+    /* Forward report of the render system initialization */
+    if (auto report = instance_->GetReport())
+        SetReport(report->GetText(), report->HasErrors());
+}
+
+DbgRenderSystem::~DbgRenderSystem()
+{
+    if (debugger_ != nullptr && profiler_ != nullptr && profiler_->resourceAccountingEnabled)
+        ReportResourceLeaks();
 }
 
 /* ----- Swap-chain ----- */
@@ -57,7 +69,7 @@ SwapChain* DbgRenderSystem::CreateSwapChain(const SwapChainDescriptor& swapChain
         commandQueue_ = MakeUnique<DbgCommandQueue>(*(instance_->GetCommandQueue()), profiler_, debugger_);
     }
 
-    return TakeOwnership(swapChains_, MakeUnique<DbgSwapChain>(*swapChainInstance));
+    return TakeOwnership(swapChains_, MakeUnique<DbgSwapChain>(*swapChainInstance, *this, profiler_));
 }
 
 void DbgRenderSystem::Release(SwapChain& swapChain)
@@ -72,19 +84,50 @@ CommandQueue* DbgRenderSystem::GetCommandQueue()
     return commandQueue_.get();
 }
 
+CommandQueue* DbgRenderSystem::GetComputeQueue()
+{
+    if (!computeQueue_)
+    {
+        if (auto computeQueueInstance = instance_->GetComputeQueue())
+            computeQueue_ = MakeUnique<DbgCommandQueue>(*computeQueueInstance, profiler_, debugger_);
+    }
+    return computeQueue_.get();
+}
+
 /* ----- Command buffers ----- */
 
+// Returns the instance of the specified debug layer render target or swap-chain.
+static RenderTarget* GetRenderTargetInstance(RenderTarget* renderTarget)
+{
+    if (renderTarget == nullptr)
+        return nullptr;
+    else if (LLGL::IsInstanceOf<SwapChain>(*renderTarget))
+        return &(LLGL_CAST(DbgSwapChain*, renderTarget)->instance);
+    else
+        return &(LLGL_CAST(DbgRenderTarget*, renderTarget)->instance);
+}
+
 CommandBuffer* DbgRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& commandBufferDesc)
 {
-    ValidateCommandBufferDesc(commandBufferDesc);
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateCommandBufferDesc(commandBufferDesc);
+    }
+
+    /* Replace inherited render target by its instance */
+    auto instanceDesc = commandBufferDesc;
+    instanceDesc.renderTarget = GetRenderTargetInstance(commandBufferDesc.renderTarget);
+
     return TakeOwnership(
         commandBuffers_,
         MakeUnique<DbgCommandBuffer>(
             *instance_,
             commandQueue_->instance,
-            *instance_->CreateCommandBuffer(commandBufferDesc),
+            *instance_->CreateCommandBuffer(instanceDesc),
             debugger_,
             profiler_,
+            validationMask_,
             commandBufferDesc,
             GetRenderingCaps()
         )
@@ -115,11 +158,14 @@ Buffer* DbgRenderSystem::CreateBuffer(const BufferDescriptor& bufferDesc, const
     /* Store settings */
     bufferDbg->elements     = (formatSize > 0 ? bufferDesc.size / formatSize : 0);
     bufferDbg->initialized  = (initialData != nullptr);
+    bufferDbg->lastUsed     = resourceFrame_;
+
+    AddLiveResourceSize(bufferDesc.size);
 
     return TakeOwnership(buffers_, std::move(bufferDbg));
 }
 
-BufferArray* DbgRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray)
+BufferArray* DbgRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets)
 {
     AssertCreateBufferArray(numBuffers, bufferArray);
 
@@ -134,8 +180,24 @@ BufferArray* DbgRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer
         bufferDbgArray[i]       = bufferDbg;
     }
 
+    if (debugger_ && offsets != nullptr)
+    {
+        LLGL_DBG_SOURCE;
+        for_range(i, numBuffers)
+        {
+            if (offsets[i] > bufferDbgArray[i]->desc.size)
+            {
+                LLGL_DBG_ERROR(
+                    ErrorType::InvalidArgument,
+                    "offset (" + std::to_string(offsets[i]) + ") of buffer [" + std::to_string(i) + "] in buffer array exceeds buffer size (" +
+                    std::to_string(bufferDbgArray[i]->desc.size) + ")"
+                );
+            }
+        }
+    }
+
     /* Create native buffer and debug buffer */
-    auto bufferArrayInstance    = instance_->CreateBufferArray(numBuffers, bufferInstanceArray.data());
+    auto bufferArrayInstance    = instance_->CreateBufferArray(numBuffers, bufferInstanceArray.data(), offsets);
     auto bufferArrayDbg         = MakeUnique<DbgBufferArray>(*bufferArrayInstance, GetCombinedBindFlags(numBuffers, bufferArray), std::move(bufferDbgArray));
 
     return TakeOwnership(bufferArrays_, std::move(bufferArrayDbg));
@@ -143,6 +205,7 @@ BufferArray* DbgRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer
 
 void DbgRenderSystem::Release(Buffer& buffer)
 {
+    liveResourceSize_ -= LLGL_CAST(DbgBuffer&, buffer).desc.size;
     ReleaseDbg(buffers_, buffer);
 }
 
@@ -177,6 +240,37 @@ void DbgRenderSystem::WriteBuffer(Buffer& buffer, std::uint64_t offset, const vo
         profiler_->frameProfile.bufferWrites++;
 }
 
+void DbgRenderSystem::WriteBuffer(Buffer& buffer, std::uint32_t numRegions, const BufferWriteRegion* regions)
+{
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+
+        if (numRegions > 0 && regions == nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "illegal null pointer argument for 'regions' parameter");
+        else
+        {
+            for (std::uint32_t i = 0; i < numRegions; ++i)
+            {
+                if (regions[i].dataSize > 0)
+                    bufferDbg.initialized = true;
+
+                ValidateBufferBoundary(bufferDbg.desc.size, regions[i].dstOffset, regions[i].dataSize);
+
+                if (!regions[i].data)
+                    LLGL_DBG_ERROR(ErrorType::InvalidArgument, "illegal null pointer for data of buffer write region");
+            }
+        }
+    }
+
+    instance_->WriteBuffer(bufferDbg.instance, numRegions, regions);
+
+    if (profiler_)
+        profiler_->frameProfile.bufferWrites += numRegions;
+}
+
 void DbgRenderSystem::ReadBuffer(Buffer& buffer, std::uint64_t offset, void* data, std::uint64_t dataSize)
 {
     auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
@@ -268,11 +362,18 @@ Texture* DbgRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, co
         LLGL_DBG_SOURCE;
         ValidateTextureDesc(textureDesc, imageDesc);
     }
-    return TakeOwnership(textures_, MakeUnique<DbgTexture>(*instance_->CreateTexture(textureDesc, imageDesc), textureDesc));
+
+    auto textureDbg = MakeUnique<DbgTexture>(*instance_->CreateTexture(textureDesc, imageDesc), textureDesc);
+    textureDbg->lastUsed = resourceFrame_;
+
+    AddLiveResourceSize(textureDbg->GetMemoryFootprint());
+
+    return TakeOwnership(textures_, std::move(textureDbg));
 }
 
 void DbgRenderSystem::Release(Texture& texture)
 {
+    liveResourceSize_ -= LLGL_CAST(DbgTexture&, texture).GetMemoryFootprint();
     ReleaseDbg(textures_, texture);
 }
 
@@ -284,7 +385,7 @@ void DbgRenderSystem::WriteTexture(Texture& texture, const TextureRegion& textur
     {
         LLGL_DBG_SOURCE;
         ValidateTextureRegion(textureDbg, textureRegion);
-        ValidateImageDataSize(textureDbg, textureRegion, imageDesc.format, imageDesc.dataType, imageDesc.dataSize);
+        ValidateImageDataSize(textureDbg, textureRegion, imageDesc.format, imageDesc.dataType, imageDesc.dataSize, imageDesc.rowStride, imageDesc.layerStride);
     }
 
     instance_->WriteTexture(textureDbg.instance, textureRegion, imageDesc);
@@ -301,7 +402,7 @@ void DbgRenderSystem::ReadTexture(Texture& texture, const TextureRegion& texture
     {
         LLGL_DBG_SOURCE;
         ValidateTextureRegion(textureDbg, textureRegion);
-        ValidateImageDataSize(textureDbg, textureRegion, imageDesc.format, imageDesc.dataType, imageDesc.dataSize);
+        ValidateImageDataSize(textureDbg, textureRegion, imageDesc.format, imageDesc.dataType, imageDesc.dataSize, imageDesc.rowStride, imageDesc.layerStride);
     }
 
     instance_->ReadTexture(textureDbg.instance, textureRegion, imageDesc);
@@ -310,6 +411,162 @@ void DbgRenderSystem::ReadTexture(Texture& texture, const TextureRegion& texture
         profiler_->frameProfile.textureReads++;
 }
 
+bool DbgRenderSystem::QueryTextureTiling(const Texture& texture, TextureTiling& outTiling)
+{
+    auto& textureDbg = LLGL_CAST(const DbgTexture&, texture);
+    return instance_->QueryTextureTiling(textureDbg.instance, outTiling);
+}
+
+void DbgRenderSystem::CommitTextureTiles(Texture& texture, const TextureRegion& textureRegion)
+{
+    auto& textureDbg = LLGL_CAST(DbgTexture&, texture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateTextureTileRegion(textureDbg, textureRegion);
+    }
+
+    instance_->CommitTextureTiles(textureDbg.instance, textureRegion);
+}
+
+void DbgRenderSystem::DecommitTextureTiles(Texture& texture, const TextureRegion& textureRegion)
+{
+    auto& textureDbg = LLGL_CAST(DbgTexture&, texture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateTextureTileRegion(textureDbg, textureRegion);
+    }
+
+    instance_->DecommitTextureTiles(textureDbg.instance, textureRegion);
+}
+
+/* ----- Native resources ----- */
+
+// Returns the miscellaneous flags of the specified debug buffer or texture.
+static long GetDbgResourceMiscFlags(const Resource& resource)
+{
+    switch (resource.GetResourceType())
+    {
+        case ResourceType::Buffer:
+            return LLGL_CAST(const DbgBuffer&, resource).desc.miscFlags;
+        case ResourceType::Texture:
+            return LLGL_CAST(const DbgTexture&, resource).desc.miscFlags;
+        default:
+            return 0;
+    }
+}
+
+// Returns the wrapped instance of the specified debug buffer or texture, or null if the resource is neither a buffer nor a texture.
+static Resource* GetDbgResourceInstance(Resource& resource)
+{
+    switch (resource.GetResourceType())
+    {
+        case ResourceType::Buffer:
+            return &(LLGL_CAST(DbgBuffer&, resource).instance);
+        case ResourceType::Texture:
+            return &(LLGL_CAST(DbgTexture&, resource).instance);
+        default:
+            return nullptr;
+    }
+}
+
+bool DbgRenderSystem::QueryNativeHandle(const Resource& resource, NativeResourceHandle& outHandle)
+{
+    if (auto instance = GetDbgResourceInstance(const_cast<Resource&>(resource)))
+        return instance_->QueryNativeHandle(*instance, outHandle);
+    return false;
+}
+
+bool DbgRenderSystem::ExportResource(Resource& resource, NativeHandleType handleType, NativeResourceHandle& outHandle)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if ((GetDbgResourceMiscFlags(resource) & MiscFlags::Shared) == 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot export resource that was not created with 'LLGL::MiscFlags::Shared'");
+        if (handleType != NativeHandleType::OpaqueFD && handleType != NativeHandleType::OpaqueWin32 && handleType != NativeHandleType::D3D12SharedHandle)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot export resource with native handle type that does not denote a shared handle");
+    }
+
+    if (auto instance = GetDbgResourceInstance(resource))
+        return instance_->ExportResource(*instance, handleType, outHandle);
+
+    return false;
+}
+
+Buffer* DbgRenderSystem::ImportBuffer(const BufferDescriptor& bufferDesc, const NativeResourceHandle& nativeHandle)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateBufferDesc(bufferDesc);
+        ValidateNativeHandle(nativeHandle);
+    }
+
+    auto bufferInstance = instance_->ImportBuffer(bufferDesc, nativeHandle);
+    if (bufferInstance == nullptr)
+        return nullptr;
+
+    /* Imported buffers are initialized by the owner of the native buffer or shared memory */
+    auto bufferDbg = MakeUnique<DbgBuffer>(*bufferInstance, bufferDesc);
+    {
+        bufferDbg->initialized  = true;
+        bufferDbg->lastUsed     = resourceFrame_;
+    }
+
+    AddLiveResourceSize(bufferDesc.size);
+
+    return TakeOwnership(buffers_, std::move(bufferDbg));
+}
+
+Texture* DbgRenderSystem::ImportTexture(const TextureDescriptor& textureDesc, const NativeResourceHandle& nativeHandle)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateTextureDesc(textureDesc);
+        ValidateNativeHandle(nativeHandle);
+    }
+
+    auto textureInstance = instance_->ImportTexture(textureDesc, nativeHandle);
+    if (textureInstance == nullptr)
+        return nullptr;
+
+    auto textureDbg = MakeUnique<DbgTexture>(*textureInstance, textureDesc);
+    textureDbg->lastUsed = resourceFrame_;
+
+    AddLiveResourceSize(textureDbg->GetMemoryFootprint());
+
+    return TakeOwnership(textures_, std::move(textureDbg));
+}
+
+/* ----- Readbacks ----- */
+
+const void* DbgRenderSystem::MapReadback(std::uint64_t ticket, ReadbackLayout* outLayout)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (ticket == Constants::invalidReadbackTicket)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot map readback with invalid ticket");
+    }
+    return instance_->MapReadback(ticket, outLayout);
+}
+
+void DbgRenderSystem::UnmapReadback(std::uint64_t ticket)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (ticket == Constants::invalidReadbackTicket)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot unmap readback with invalid ticket");
+    }
+    instance_->UnmapReadback(ticket);
+}
+
 /* ----- Sampler States ---- */
 
 Sampler* DbgRenderSystem::CreateSampler(const SamplerDescriptor& samplerDesc)
@@ -326,6 +583,29 @@ void DbgRenderSystem::Release(Sampler& sampler)
 
 /* ----- Resource Views ----- */
 
+// private
+std::vector<Resource*> DbgRenderSystem::GetResidencyResourceInstances(const ArrayView<Resource*>& resources)
+{
+    std::vector<Resource*> instances;
+    instances.reserve(resources.size());
+
+    for_range(i, resources.size())
+    {
+        Resource* instance = (resources[i] != nullptr ? GetDbgResourceInstance(*resources[i]) : nullptr);
+        if (instance != nullptr)
+            instances.push_back(instance);
+        else if (debugger_)
+        {
+            if (resources[i] == nullptr)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "null pointer passed to resource list at index " + std::to_string(i));
+            else
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot change residency of resource at index " + std::to_string(i) + " that is neither a buffer nor a texture");
+        }
+    }
+
+    return instances;
+}
+
 // private
 std::vector<ResourceViewDescriptor> DbgRenderSystem::GetResourceViewInstanceCopy(const ArrayView<ResourceViewDescriptor>& resourceViews)
 {
@@ -393,13 +673,31 @@ ResourceHeap* DbgRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor&
         auto pipelineLayoutDbg = LLGL_CAST(DbgPipelineLayout*, resourceHeapDesc.pipelineLayout);
         instanceDesc.pipelineLayout = &(pipelineLayoutDbg->instance);
     }
-    return TakeOwnership(
-        resourceHeaps_,
-        MakeUnique<DbgResourceHeap>(
-            *instance_->CreateResourceHeap(instanceDesc, instanceResourceViews),
-            resourceHeapDesc
-        )
+    /* Bindless resource heaps allocate all descriptors of their bindless binding if the number of resource views is unspecified */
+    auto resourceHeapDbgDesc = resourceHeapDesc;
+    {
+        auto pipelineLayoutDbg = LLGL_CAST(DbgPipelineLayout*, resourceHeapDesc.pipelineLayout);
+        if (pipelineLayoutDbg->hasBindlessBinding && resourceHeapDesc.numResourceViews == 0)
+        {
+            if (initialResourceViews.empty())
+            {
+                const auto& bindings = pipelineLayoutDbg->heapBindings;
+                resourceHeapDbgDesc.numResourceViews = static_cast<std::uint32_t>(bindings.size() - 1) + bindings.back().arraySize;
+            }
+            else
+                resourceHeapDbgDesc.numResourceViews = static_cast<std::uint32_t>(initialResourceViews.size());
+        }
+    }
+
+    auto resourceHeapDbg = MakeUnique<DbgResourceHeap>(
+        *instance_->CreateResourceHeap(instanceDesc, instanceResourceViews),
+        resourceHeapDbgDesc
     );
+
+    resourceHeapDbg->resources.resize(std::max<std::size_t>(resourceHeapDbgDesc.numResourceViews, initialResourceViews.size()), nullptr);
+    StoreResourceHeapResources(*resourceHeapDbg, 0, initialResourceViews);
+
+    return TakeOwnership(resourceHeaps_, std::move(resourceHeapDbg));
 }
 
 void DbgRenderSystem::Release(ResourceHeap& resourceHeap)
@@ -417,6 +715,8 @@ std::uint32_t DbgRenderSystem::WriteResourceHeap(ResourceHeap& resourceHeap, std
         ValidateResourceHeapRange(resourceHeapDbg, firstDescriptor, resourceViews);
     }
 
+    StoreResourceHeapResources(resourceHeapDbg, firstDescriptor, resourceViews);
+
     auto instanceResourceViews = GetResourceViewInstanceCopy(resourceViews);
     return instance_->WriteResourceHeap(resourceHeapDbg.instance, firstDescriptor, instanceResourceViews);
 }
@@ -425,6 +725,11 @@ std::uint32_t DbgRenderSystem::WriteResourceHeap(ResourceHeap& resourceHeap, std
 
 RenderPass* DbgRenderSystem::CreateRenderPass(const RenderPassDescriptor& renderPassDesc)
 {
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateRenderPassDesc(renderPassDesc);
+    }
     return instance_->CreateRenderPass(renderPassDesc);
 }
 
@@ -441,10 +746,22 @@ RenderTarget* DbgRenderSystem::CreateRenderTarget(const RenderTargetDescriptor&
 
     auto instanceDesc = renderTargetDesc;
 
+    /* Transient attachments only affect internal buffers, i.e. multi-sampled color buffers and depth-stencil buffers without texture */
+    const bool hasInternalColorBuffers = (renderTargetDesc.samples > 1 && !renderTargetDesc.customMultiSampling);
+
     for (auto& attachment : instanceDesc.attachments)
     {
         if (debugger_)
+        {
             ValidateAttachmentDesc(attachment);
+            if (attachment.transient && attachment.texture != nullptr && !hasInternalColorBuffers)
+            {
+                LLGL_DBG_WARN(
+                    WarningType::ImproperArgument,
+                    "transient render-target attachment has no effect on a texture that is rendered into directly"
+                );
+            }
+        }
         if (auto texture = attachment.texture)
         {
             auto textureDbg = LLGL_CAST(DbgTexture*, texture);
@@ -452,6 +769,14 @@ RenderTarget* DbgRenderSystem::CreateRenderTarget(const RenderTargetDescriptor&
         }
     }
 
+    if (auto texture = renderTargetDesc.shadingRateImage)
+    {
+        auto textureDbg = LLGL_CAST(DbgTexture*, texture);
+        if (debugger_)
+            ValidateShadingRateImage(*textureDbg, renderTargetDesc.resolution);
+        instanceDesc.shadingRateImage = &(textureDbg->instance);
+    }
+
     return TakeOwnership(
         renderTargets_,
         MakeUnique<DbgRenderTarget>(*instance_->CreateRenderTarget(instanceDesc), debugger_, renderTargetDesc)
@@ -473,6 +798,14 @@ Shader* DbgRenderSystem::CreateShader(const ShaderDescriptor& shaderDesc)
     );
 }
 
+void DbgRenderSystem::CreateShaders(std::uint32_t numShaders, const ShaderDescriptor* shaderDescs, Shader** outShaders)
+{
+    /* Create all shader instances at once to keep the parallel compilation of the backend */
+    instance_->CreateShaders(numShaders, shaderDescs, outShaders);
+    for (std::uint32_t i = 0; i < numShaders; ++i)
+        outShaders[i] = TakeOwnership(shaders_, MakeUnique<DbgShader>(*outShaders[i], shaderDescs[i]));
+}
+
 static Shader* GetInstanceShader(Shader* shader)
 {
     if (shader)
@@ -492,6 +825,12 @@ void DbgRenderSystem::Release(Shader& shader)
 
 PipelineLayout* DbgRenderSystem::CreatePipelineLayout(const PipelineLayoutDescriptor& pipelineLayoutDesc)
 {
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidatePipelineLayoutDesc(pipelineLayoutDesc);
+    }
+
     return TakeOwnership(
         pipelineLayouts_,
         MakeUnique<DbgPipelineLayout>(*instance_->CreatePipelineLayout(pipelineLayoutDesc), pipelineLayoutDesc)
@@ -510,13 +849,8 @@ PipelineState* DbgRenderSystem::CreatePipelineState(const Blob& serializedCache)
     return nullptr;//TODO
 }
 
-PipelineState* DbgRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache)
+static GraphicsPipelineDescriptor GetInstancePipelineDesc(const GraphicsPipelineDescriptor& pipelineStateDesc)
 {
-    LLGL_DBG_SOURCE;
-
-    if (debugger_)
-        ValidateGraphicsPipelineDesc(pipelineStateDesc);
-
     auto instanceDesc = pipelineStateDesc;
     {
         if (pipelineStateDesc.pipelineLayout != nullptr)
@@ -526,11 +860,35 @@ PipelineState* DbgRenderSystem::CreatePipelineState(const GraphicsPipelineDescri
         instanceDesc.tessControlShader      = GetInstanceShader(pipelineStateDesc.tessControlShader);
         instanceDesc.tessEvaluationShader   = GetInstanceShader(pipelineStateDesc.tessEvaluationShader);
         instanceDesc.geometryShader         = GetInstanceShader(pipelineStateDesc.geometryShader);
+        instanceDesc.taskShader             = GetInstanceShader(pipelineStateDesc.taskShader);
+        instanceDesc.meshShader             = GetInstanceShader(pipelineStateDesc.meshShader);
         instanceDesc.fragmentShader         = GetInstanceShader(pipelineStateDesc.fragmentShader);
     }
+    return instanceDesc;
+}
+
+static ComputePipelineDescriptor GetInstancePipelineDesc(const ComputePipelineDescriptor& pipelineStateDesc)
+{
+    auto instanceDesc = pipelineStateDesc;
+    {
+        if (pipelineStateDesc.pipelineLayout != nullptr)
+            instanceDesc.pipelineLayout = &(LLGL_CAST(const DbgPipelineLayout*, pipelineStateDesc.pipelineLayout)->instance);
+
+        instanceDesc.computeShader = GetInstanceShader(pipelineStateDesc.computeShader);
+    }
+    return instanceDesc;
+}
+
+PipelineState* DbgRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache)
+{
+    LLGL_DBG_SOURCE;
+
+    if (debugger_)
+        ValidateGraphicsPipelineDesc(pipelineStateDesc);
+
     return TakeOwnership(
         pipelineStates_,
-        MakeUnique<DbgPipelineState>(*instance_->CreatePipelineState(instanceDesc, serializedCache), pipelineStateDesc)
+        MakeUnique<DbgPipelineState>(*instance_->CreatePipelineState(GetInstancePipelineDesc(pipelineStateDesc), serializedCache), pipelineStateDesc)
     );
 }
 
@@ -541,16 +899,35 @@ PipelineState* DbgRenderSystem::CreatePipelineState(const ComputePipelineDescrip
     if (debugger_)
         ValidateComputePipelineDesc(pipelineStateDesc);
 
-    auto instanceDesc = pipelineStateDesc;
-    {
-        if (pipelineStateDesc.pipelineLayout != nullptr)
-            instanceDesc.pipelineLayout = &(LLGL_CAST(const DbgPipelineLayout*, pipelineStateDesc.pipelineLayout)->instance);
+    return TakeOwnership(
+        pipelineStates_,
+        MakeUnique<DbgPipelineState>(*instance_->CreatePipelineState(GetInstancePipelineDesc(pipelineStateDesc), serializedCache), pipelineStateDesc)
+    );
+}
+
+PipelineState* DbgRenderSystem::CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc, long flags)
+{
+    LLGL_DBG_SOURCE;
+
+    if (debugger_)
+        ValidateGraphicsPipelineDesc(pipelineStateDesc);
 
-        instanceDesc.computeShader = GetInstanceShader(pipelineStateDesc.computeShader);
-    }
     return TakeOwnership(
         pipelineStates_,
-        MakeUnique<DbgPipelineState>(*instance_->CreatePipelineState(instanceDesc, serializedCache), pipelineStateDesc)
+        MakeUnique<DbgPipelineState>(*instance_->CreatePipelineStateAsync(GetInstancePipelineDesc(pipelineStateDesc), flags), pipelineStateDesc)
+    );
+}
+
+PipelineState* DbgRenderSystem::CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc, long flags)
+{
+    LLGL_DBG_SOURCE;
+
+    if (debugger_)
+        ValidateComputePipelineDesc(pipelineStateDesc);
+
+    return TakeOwnership(
+        pipelineStates_,
+        MakeUnique<DbgPipelineState>(*instance_->CreatePipelineStateAsync(GetInstancePipelineDesc(pipelineStateDesc), flags), pipelineStateDesc)
     );
 }
 
@@ -586,6 +963,125 @@ void DbgRenderSystem::Release(Fence& fence)
     return instance_->Release(fence);
 }
 
+/* ----- Memory ----- */
+
+bool DbgRenderSystem::QueryMemoryStatistics(MemoryStatistics& outStats)
+{
+    return instance_->QueryMemoryStatistics(outStats);
+}
+
+/* ----- Residency ----- */
+
+bool DbgRenderSystem::SetResidencyPriority(const ArrayView<Resource*>& resources, ResidencyPriority priority)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (!GetRenderingCaps().features.hasResidencyPriorities)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("residency priorities");
+        if (priority < ResidencyPriority::Minimum || priority > ResidencyPriority::Maximum)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "invalid residency priority: " + std::to_string(static_cast<int>(priority)));
+    }
+    return instance_->SetResidencyPriority(GetResidencyResourceInstances(resources), priority);
+}
+
+bool DbgRenderSystem::MakeResident(const ArrayView<Resource*>& resources)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (!GetRenderingCaps().features.hasExplicitResidency)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("explicit residency");
+    }
+    return instance_->MakeResident(GetResidencyResourceInstances(resources));
+}
+
+bool DbgRenderSystem::Evict(const ArrayView<Resource*>& resources)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (!GetRenderingCaps().features.hasExplicitResidency)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("explicit residency");
+    }
+    return instance_->Evict(GetResidencyResourceInstances(resources));
+}
+
+bool DbgRenderSystem::QueryCommandStatistics(CommandStatistics& outStats)
+{
+    return instance_->QueryCommandStatistics(outStats);
+}
+
+/* ----- Start-up ----- */
+
+bool DbgRenderSystem::QueryStartupStatistics(StartupStatistics& outStats)
+{
+    return instance_->QueryStartupStatistics(outStats);
+}
+
+void DbgRenderSystem::AccountResourceMemory(ResourceMemoryStatistics& outStats, std::uint32_t unusedResourceFrames)
+{
+    ++resourceFrame_;
+
+    /* Reset current sizes of all categories, but keep their peak sizes */
+    for (auto* records : { &bindFlagsRecords_, &formatRecords_, &nameRecords_ })
+    {
+        for (auto& entry : *records)
+        {
+            entry.second.size   = 0;
+            entry.second.count  = 0;
+        }
+    }
+
+    outStats.totalSize      = liveResourceSize_;
+    outStats.peakTotalSize  = peakResourceSize_;
+    outStats.numResources   = 0;
+    outStats.unusedResources.clear();
+
+    /* Account all live buffers and textures */
+    for (const auto& bufferDbg : buffers_)
+    {
+        AccountResource(
+            outStats, ResourceType::Buffer, DbgGetObjectName(*bufferDbg), bufferDbg->desc.bindFlags, bufferDbg->desc.format,
+            bufferDbg->desc.size, bufferDbg->used, bufferDbg->lastUsed, unusedResourceFrames
+        );
+    }
+
+    for (const auto& textureDbg : textures_)
+    {
+        /* Texture views share the memory of another texture */
+        if (textureDbg->isTextureView)
+            continue;
+
+        AccountResource(
+            outStats, ResourceType::Texture, DbgGetObjectName(*textureDbg), textureDbg->desc.bindFlags, textureDbg->desc.format,
+            textureDbg->GetMemoryFootprint(), textureDbg->used, textureDbg->lastUsed, unusedResourceFrames
+        );
+    }
+
+    /* Copy all categories with live resources to the output, ordered by their size */
+    auto CopyRecords = [](const std::map<std::string, ProfileMemoryRecord>& records, std::vector<ProfileMemoryRecord>& outRecords)
+    {
+        outRecords.clear();
+        for (const auto& entry : records)
+        {
+            if (entry.second.count > 0)
+                outRecords.push_back(entry.second);
+        }
+        std::sort(
+            outRecords.begin(), outRecords.end(),
+            [](const ProfileMemoryRecord& lhs, const ProfileMemoryRecord& rhs)
+            {
+                return (lhs.size > rhs.size);
+            }
+        );
+    };
+
+    CopyRecords(bindFlagsRecords_, outStats.bindFlagsRecords);
+    CopyRecords(formatRecords_, outStats.formatRecords);
+    CopyRecords(nameRecords_, outStats.nameRecords);
+}
+
 
 /*
  * ======= Private: =======
@@ -663,7 +1159,7 @@ void DbgRenderSystem::ValidateResourceCPUAccess(long cpuAccessFlags, const CPUAc
             );
         }
     }
-    if (access == CPUAccess::WriteOnly || access == CPUAccess::ReadWrite)
+    if (access == CPUAccess::WriteOnly || access == CPUAccess::ReadWrite || access == CPUAccess::WriteUnsynchronized)
     {
         if ((cpuAccessFlags & CPUAccessFlags::Write) == 0)
         {
@@ -683,10 +1179,16 @@ void DbgRenderSystem::ValidateCommandBufferDesc(const CommandBufferDescriptor& c
         if ((commandBufferDesc.flags & (CommandBufferFlags::Secondary | CommandBufferFlags::MultiSubmit)) != 0)
             LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot create immediate command buffer with Secondary or MultiSubmit flags");
     }
+    if ((commandBufferDesc.flags & CommandBufferFlags::ComputeQueue) != 0 && (commandBufferDesc.flags & CommandBufferFlags::Secondary) != 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot create secondary command buffer for asynchronous compute queue");
 
     /* Validate number of native buffers */
     if (commandBufferDesc.numNativeBuffers == 0)
         LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot create command buffer with zero native buffers");
+
+    /* Validate inherited render target */
+    if (commandBufferDesc.renderTarget != nullptr && (commandBufferDesc.flags & CommandBufferFlags::Secondary) == 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot create primary command buffer with inherited render target");
 }
 
 void DbgRenderSystem::ValidateBufferDesc(const BufferDescriptor& bufferDesc, std::uint32_t* formatSizeOut)
@@ -694,7 +1196,8 @@ void DbgRenderSystem::ValidateBufferDesc(const BufferDescriptor& bufferDesc, std
     /* Validate flags */
     ValidateBindFlags(bufferDesc.bindFlags);
     ValidateCPUAccessFlags(bufferDesc.cpuAccessFlags, CPUAccessFlags::ReadWrite, "buffer");
-    ValidateMiscFlags(bufferDesc.miscFlags, (MiscFlags::DynamicUsage | MiscFlags::NoInitialData), "buffer");
+    ValidateMiscFlags(bufferDesc.miscFlags, (MiscFlags::DynamicUsage | MiscFlags::NoInitialData | MiscFlags::Shared), "buffer");
+    ValidateSharedMiscFlags(bufferDesc.miscFlags);
 
     /* Validate (constant-) buffer size */
     if ((bufferDesc.bindFlags & BindFlags::ConstantBuffer) != 0)
@@ -926,7 +1429,27 @@ void DbgRenderSystem::ValidateTextureDesc(const TextureDescriptor& textureDesc,
     ValidateTextureDescMipLevels(textureDesc);
     ValidateArrayTextureLayers(textureDesc.type, textureDesc.arrayLayers);
     ValidateBindFlags(textureDesc.bindFlags);
-    ValidateMiscFlags(textureDesc.miscFlags, (MiscFlags::DynamicUsage | MiscFlags::FixedSamples | MiscFlags::GenerateMips | MiscFlags::NoInitialData), "texture");
+    ValidateMiscFlags(
+        textureDesc.miscFlags,
+        (MiscFlags::DynamicUsage | MiscFlags::FixedSamples | MiscFlags::GenerateMips | MiscFlags::NoInitialData | MiscFlags::Aliasable | MiscFlags::Sparse | MiscFlags::Shared),
+        "texture"
+    );
+    ValidateSharedMiscFlags(textureDesc.miscFlags);
+
+    /* Check if sparse texture is supported and not initialized */
+    if ((textureDesc.miscFlags & MiscFlags::Sparse) != 0)
+    {
+        if (!GetRenderingCaps().features.hasSparseTextures)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("sparse textures");
+        if (textureDesc.type != TextureType::Texture2D && textureDesc.type != TextureType::Texture2DArray)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "sparse textures must be of type 'LLGL::TextureType::Texture2D' or 'LLGL::TextureType::Texture2DArray'");
+        if (imageDesc != nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot initialize sparse texture with image data");
+        if ((textureDesc.bindFlags & (BindFlags::ColorAttachment | BindFlags::DepthStencilAttachment)) != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "sparse textures cannot be used as render target attachments");
+        if ((textureDesc.miscFlags & MiscFlags::GenerateMips) != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "sparse textures cannot generate MIP-maps: 'LLGL::MiscFlags::GenerateMips' specified together with 'LLGL::MiscFlags::Sparse'");
+    }
 
     /* Check if MIP-map generation is requested  */
     if ((textureDesc.miscFlags & MiscFlags::GenerateMips) != 0)
@@ -1108,33 +1631,75 @@ void DbgRenderSystem::ValidateMipLevelLimit(std::uint32_t baseMipLevel, std::uin
 }
 
 //TODO: also support compressed formats in validation
-void DbgRenderSystem::ValidateImageDataSize(const DbgTexture& textureDbg, const TextureRegion& textureRegion, ImageFormat imageFormat, DataType dataType, std::size_t dataSize)
+void DbgRenderSystem::ValidateImageDataSize(
+    const DbgTexture&       textureDbg,
+    const TextureRegion&    textureRegion,
+    ImageFormat             imageFormat,
+    DataType                dataType,
+    std::size_t             dataSize,
+    std::uint32_t           rowStride,
+    std::uint32_t           layerStride)
 {
     /* Validate output data size */
     const auto& subresource         = textureRegion.subresource;
     const auto  baseSubresource     = TextureSubresource{ 0, subresource.numArrayLayers, 0, subresource.numMipLevels };
     const auto  numTexels           = NumMipTexels(textureDbg.desc.type, textureRegion.extent, baseSubresource);
-    const auto  requiredDataSize    = GetMemoryFootprint(imageFormat, dataType, numTexels);
+    auto        requiredDataSize    = static_cast<std::size_t>(GetMemoryFootprint(imageFormat, dataType, numTexels));
 
     /* Ignore compressed formats */
-    if (requiredDataSize != 0)
+    if (requiredDataSize == 0)
+        return;
+
+    const bool isStrided = (rowStride != 0 || layerStride != 0);
+    if (isStrided)
     {
-        if (dataSize < requiredDataSize)
+        /* Validate row and layer strides cover the rows and layers of the texture region */
+        const auto& extent            = textureRegion.extent;
+        const auto  rowSize           = static_cast<std::size_t>(GetMemoryFootprint(imageFormat, dataType, extent.width));
+        const auto  numRows           = static_cast<std::size_t>(extent.height);
+        const auto  numSlices         = (rowSize * numRows > 0 ? requiredDataSize / (rowSize * numRows) : 0);
+        const auto  actualRowStride   = (rowStride != 0 ? static_cast<std::size_t>(rowStride) : rowSize);
+        const auto  actualLayerStride = (layerStride != 0 ? static_cast<std::size_t>(layerStride) : actualRowStride * numRows);
+
+        if (actualRowStride < rowSize)
         {
             LLGL_DBG_ERROR(
                 ErrorType::InvalidArgument,
-                "image data size too small for texture: " + std::to_string(dataSize) +
-                " byte(s) specified but required is " + std::to_string(requiredDataSize) + " byte(s)"
+                "image row stride too small for texture region: " + std::to_string(actualRowStride) +
+                " byte(s) specified but required is " + std::to_string(rowSize) + " byte(s)"
             );
+            return;
         }
-        else if (dataSize > requiredDataSize)
+        if (actualLayerStride < actualRowStride * numRows)
         {
-            LLGL_DBG_WARN(
-                WarningType::ImproperArgument,
-                "image data size larger than expected for texture: " + std::to_string(dataSize) +
-                " byte(s) specified but required is " + std::to_string(requiredDataSize) + " byte(s)"
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                "image layer stride too small for texture region: " + std::to_string(actualLayerStride) +
+                " byte(s) specified but required is " + std::to_string(actualRowStride * numRows) + " byte(s)"
             );
+            return;
         }
+
+        /* Padding after the last row is not required */
+        if (numSlices > 0)
+            requiredDataSize = (numSlices - 1) * actualLayerStride + (numRows - 1) * actualRowStride + rowSize;
+    }
+
+    if (dataSize < requiredDataSize)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "image data size too small for texture: " + std::to_string(dataSize) +
+            " byte(s) specified but required is " + std::to_string(requiredDataSize) + " byte(s)"
+        );
+    }
+    else if (dataSize > requiredDataSize && !isStrided)
+    {
+        LLGL_DBG_WARN(
+            WarningType::ImproperArgument,
+            "image data size larger than expected for texture: " + std::to_string(dataSize) +
+            " byte(s) specified but required is " + std::to_string(requiredDataSize) + " byte(s)"
+        );
     }
 }
 
@@ -1201,6 +1766,64 @@ void DbgRenderSystem::ValidateTextureRegion(const DbgTexture& textureDbg, const
     }
 }
 
+void DbgRenderSystem::ValidateTextureTileRegion(const DbgTexture& textureDbg, const TextureRegion& textureRegion)
+{
+    if ((textureDbg.desc.miscFlags & MiscFlags::Sparse) == 0)
+    {
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot commit or decommit tiles of texture that was not created with 'LLGL::MiscFlags::Sparse'");
+        return;
+    }
+
+    ValidateTextureRegion(textureDbg, textureRegion);
+
+    /* Validate region is aligned to tile extent (unless it is located in the MIP-map tail) */
+    TextureTiling tiling;
+    if (!instance_->QueryTextureTiling(textureDbg.instance, tiling))
+        return;
+
+    if (textureRegion.subresource.baseMipLevel >= tiling.firstPackedMipLevel)
+        return;
+
+    const auto mipExtent = textureDbg.instance.GetMipExtent(textureRegion.subresource.baseMipLevel);
+
+    auto IsUnaligned = [](std::int32_t offset, std::uint32_t extent, std::uint32_t tileExtent, std::uint32_t limit)
+    {
+        if (tileExtent == 0 || offset < 0)
+            return false;
+        const auto end = static_cast<std::uint32_t>(offset) + extent;
+        return (static_cast<std::uint32_t>(offset) % tileExtent != 0 || (end % tileExtent != 0 && end != limit));
+    };
+
+    if (IsUnaligned(textureRegion.offset.x, textureRegion.extent.width,  tiling.tileExtent.width,  mipExtent.width ) ||
+        IsUnaligned(textureRegion.offset.y, textureRegion.extent.height, tiling.tileExtent.height, mipExtent.height))
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "texture tile region must be aligned to tile extent (" +
+            std::to_string(tiling.tileExtent.width) + " x " + std::to_string(tiling.tileExtent.height) + ")"
+        );
+    }
+}
+
+void DbgRenderSystem::ValidateSharedMiscFlags(long miscFlags)
+{
+    if ((miscFlags & MiscFlags::Shared) != 0)
+    {
+        if (!GetRenderingCaps().features.hasExternalMemory)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("shared resources");
+        if ((miscFlags & (MiscFlags::Sparse | MiscFlags::Aliasable)) != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "'LLGL::MiscFlags::Shared' cannot be specified together with 'LLGL::MiscFlags::Sparse' or 'LLGL::MiscFlags::Aliasable'");
+    }
+}
+
+void DbgRenderSystem::ValidateNativeHandle(const NativeResourceHandle& nativeHandle)
+{
+    if (nativeHandle.type == NativeHandleType::Undefined)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot import resource with undefined native handle type");
+    else if (nativeHandle.object == 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot import resource with null native handle");
+}
+
 void DbgRenderSystem::ValidateTextureView(const DbgTexture& sharedTextureDbg, const TextureViewDescriptor& textureViewDesc)
 {
     /* Validate texture-view features are supported */
@@ -1333,17 +1956,119 @@ void DbgRenderSystem::ValidateAttachmentDesc(const AttachmentDescriptor& attachm
     }
 }
 
+void DbgRenderSystem::ValidateShadingRateImage(const DbgTexture& textureDbg, const Extent2D& resolution)
+{
+    const std::uint32_t tileSize = limits_.shadingRateImageTileSize;
+    if (tileSize == 0)
+    {
+        LLGL_DBG_ERROR_NOT_SUPPORTED("shading-rate images");
+        return;
+    }
+
+    if (textureDbg.desc.type != TextureType::Texture2D || textureDbg.desc.format != Format::R8UInt)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "shading-rate image must be a 2D texture with format 'LLGL::Format::R8UInt'"
+        );
+    }
+
+    if ((textureDbg.desc.bindFlags & BindFlags::Sampled) == 0)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidState,
+            "cannot have shading-rate image with a texture that was not created with the 'LLGL::BindFlags::Sampled' flag"
+        );
+    }
+
+    /* Each texel of the shading-rate image covers one screen tile */
+    const Extent2D minExtent
+    {
+        (resolution.width  + tileSize - 1) / tileSize,
+        (resolution.height + tileSize - 1) / tileSize
+    };
+    if (textureDbg.desc.extent.width < minExtent.width || textureDbg.desc.extent.height < minExtent.height)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "shading-rate image of size " + std::to_string(textureDbg.desc.extent.width) + "x" + std::to_string(textureDbg.desc.extent.height) +
+            " does not cover render-target resolution (at least " + std::to_string(minExtent.width) + "x" + std::to_string(minExtent.height) +
+            " texels required for tile size of " + std::to_string(tileSize) + ")"
+        );
+    }
+}
+
+void DbgRenderSystem::ValidateRenderPassDesc(const RenderPassDescriptor& renderPassDesc)
+{
+    if (renderPassDesc.numSubpasses > LLGL_MAX_NUM_SUBPASSES)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "too many sub-passes in render pass descriptor: " + std::to_string(renderPassDesc.numSubpasses) +
+            " specified, but limit is " + std::to_string(LLGL_MAX_NUM_SUBPASSES)
+        );
+        return;
+    }
+
+    /* Sub-passes can only refer to color attachments that are enabled in the render pass */
+    std::uint32_t numColorAttachments = 0;
+    while (numColorAttachments < LLGL_MAX_NUM_COLOR_ATTACHMENTS && renderPassDesc.colorAttachments[numColorAttachments].format != Format::Undefined)
+        ++numColorAttachments;
+
+    const std::uint32_t validAttachmentsMask = ((1u << numColorAttachments) - 1u);
+
+    for (std::uint32_t i = 0; i < renderPassDesc.numSubpasses; ++i)
+    {
+        const SubpassDescriptor& subpassDesc = renderPassDesc.subpasses[i];
+        if ((subpassDesc.colorAttachments & ~validAttachmentsMask) != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "sub-pass [" + std::to_string(i) + "] writes to color attachments that are not enabled in render pass descriptor");
+        if ((subpassDesc.inputAttachments & ~validAttachmentsMask) != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "sub-pass [" + std::to_string(i) + "] reads input attachments that are not enabled in render pass descriptor");
+        if (i == 0 && subpassDesc.inputAttachments != 0)
+            LLGL_DBG_WARN(WarningType::PointlessOperation, "first sub-pass reads input attachments that have not been written by a previous sub-pass");
+    }
+}
+
+void DbgRenderSystem::ValidatePipelineLayoutDesc(const PipelineLayoutDescriptor& pipelineLayoutDesc)
+{
+    for_range(i, pipelineLayoutDesc.bindings.size())
+    {
+        const auto& binding = pipelineLayoutDesc.bindings[i];
+        if ((binding.flags & BindingFlags::Bindless) != 0)
+        {
+            if (!GetRenderingCaps().features.hasDescriptorIndexing)
+                LLGL_DBG_ERROR_NOT_SUPPORTED("bindless bindings");
+            if (i + 1 < pipelineLayoutDesc.bindings.size())
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "bindless binding must be the last binding in pipeline layout: 'LLGL::BindingFlags::Bindless' specified for binding " + std::to_string(i));
+            if ((binding.flags & (BindingFlags::DynamicBinding | BindingFlags::InlineUniforms | BindingFlags::DynamicOffset)) != 0)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "'LLGL::BindingFlags::Bindless' cannot be combined with dynamic, inline uniform, or dynamic-offset binding flags");
+            if (binding.arraySize == 0)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "bindless binding must specify the maximum number of descriptors in 'arraySize'");
+            for (const auto& other : pipelineLayoutDesc.bindings)
+            {
+                if ((other.flags & BindingFlags::DynamicOffset) != 0)
+                {
+                    LLGL_DBG_ERROR(ErrorType::InvalidArgument, "bindless pipeline layout cannot contain bindings with 'LLGL::BindingFlags::DynamicOffset'");
+                    break;
+                }
+            }
+        }
+    }
+}
+
 void DbgRenderSystem::ValidateResourceHeapDesc(const ResourceHeapDescriptor& resourceHeapDesc, const ArrayView<ResourceViewDescriptor>& initialResourceViews)
 {
     if (resourceHeapDesc.pipelineLayout != nullptr)
     {
         auto pipelineLayoutDbg = LLGL_CAST(DbgPipelineLayout*, resourceHeapDesc.pipelineLayout);
-        const auto& bindings = pipelineLayoutDbg->desc.bindings;
+        const auto& bindings = pipelineLayoutDbg->heapBindings;
 
         const auto numResourceViews = (resourceHeapDesc.numResourceViews > 0 ? resourceHeapDesc.numResourceViews : static_cast<std::uint32_t>(initialResourceViews.size()));
         const auto numBindings      = bindings.size();
 
-        if (numBindings == 0)
+        if (pipelineLayoutDbg->hasBindlessBinding)
+            ValidateBindlessResourceHeapDesc(resourceHeapDesc, initialResourceViews, bindings);
+        else if (numBindings == 0)
         {
             LLGL_DBG_ERROR(
                 ErrorType::InvalidArgument,
@@ -1396,6 +2121,44 @@ void DbgRenderSystem::ValidateResourceHeapDesc(const ResourceHeapDescriptor& res
         LLGL_DBG_ERROR(ErrorType::InvalidArgument, "pipeline layout must not be null");
 }
 
+void DbgRenderSystem::ValidateBindlessResourceHeapDesc(
+    const ResourceHeapDescriptor&               resourceHeapDesc,
+    const ArrayView<ResourceViewDescriptor>&    initialResourceViews,
+    const std::vector<BindingDescriptor>&       bindings)
+{
+    const auto numResourceViews         = (resourceHeapDesc.numResourceViews > 0 ? resourceHeapDesc.numResourceViews : static_cast<std::uint32_t>(initialResourceViews.size()));
+    const auto numStaticBindings        = static_cast<std::uint32_t>(bindings.size() - 1);
+    const auto maxBindlessDescriptors   = bindings.back().arraySize;
+
+    /* Bindless resource heaps have a single descriptor set with one descriptor per static binding, followed by the bindless descriptors */
+    if (numResourceViews > 0 && (numResourceViews < numStaticBindings || numResourceViews - numStaticBindings > maxBindlessDescriptors))
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "cannot create bindless resource heap with number of resource views (" + std::to_string(numResourceViews) +
+            ") not being in the range [" + std::to_string(numStaticBindings) + ", " + std::to_string(numStaticBindings + maxBindlessDescriptors) + "]"
+        );
+    }
+    else if (!initialResourceViews.empty())
+    {
+        if (initialResourceViews.size() <= numResourceViews)
+        {
+            /* Validate all resource view descriptors against their respective binding descriptor */
+            for_range(i, initialResourceViews.size())
+                ValidateResourceViewForBinding(initialResourceViews[i], bindings[std::min<std::size_t>(i, numStaticBindings)]);
+        }
+        else
+        {
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                "mismatch between number of initial resource views and resource heap descriptor (" +
+                std::to_string(initialResourceViews.size()) + " specified but expected at most " +
+                std::to_string(numResourceViews) + ")"
+            );
+        }
+    }
+}
+
 void DbgRenderSystem::ValidateResourceHeapRange(const DbgResourceHeap& resourceHeapDbg, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews)
 {
     if (firstDescriptor >= resourceHeapDbg.desc.numResourceViews)
@@ -1551,13 +2314,32 @@ void DbgRenderSystem::ValidateGraphicsPipelineDesc(const GraphicsPipelineDescrip
 
     /* Validate shader pipeline stages */
     bool hasSeparableShaders = false;
-    if (auto vertexShader = pipelineStateDesc.vertexShader)
+    if (auto meshShader = pipelineStateDesc.meshShader)
+    {
+        if (!features_.hasMeshShaders)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("mesh shaders");
+
+        auto meshShaderDbg = LLGL_CAST(DbgShader*, meshShader);
+        hasSeparableShaders = ((meshShaderDbg->desc.flags & ShaderCompileFlags::SeparateShader) != 0);
+
+        if (pipelineStateDesc.vertexShader         != nullptr ||
+            pipelineStateDesc.tessControlShader    != nullptr ||
+            pipelineStateDesc.tessEvaluationShader != nullptr ||
+            pipelineStateDesc.geometryShader       != nullptr)
+        {
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot create graphics PSO with mesh shader and any vertex, tessellation, or geometry shader");
+        }
+    }
+    else if (auto vertexShader = pipelineStateDesc.vertexShader)
     {
         auto vertexShaderDbg = LLGL_CAST(DbgShader*, vertexShader);
         hasSeparableShaders = ((vertexShaderDbg->desc.flags & ShaderCompileFlags::SeparateShader) != 0);
     }
     else
-        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot create graphics PSO without vertex shader");
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot create graphics PSO without vertex shader or mesh shader");
+
+    if (pipelineStateDesc.taskShader != nullptr && pipelineStateDesc.meshShader == nullptr)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot create graphics PSO with task shader but without mesh shader");
 
     const bool hasFragmentShader = (pipelineStateDesc.fragmentShader != nullptr);
 
@@ -1574,6 +2356,8 @@ void DbgRenderSystem::ValidateGraphicsPipelineDesc(const GraphicsPipelineDescrip
                        ExpectedShaderTypePair{ pipelineStateDesc.tessControlShader,    ShaderType::TessControl    },
                        ExpectedShaderTypePair{ pipelineStateDesc.tessEvaluationShader, ShaderType::TessEvaluation },
                        ExpectedShaderTypePair{ pipelineStateDesc.geometryShader,       ShaderType::Geometry       },
+                       ExpectedShaderTypePair{ pipelineStateDesc.taskShader,           ShaderType::Task           },
+                       ExpectedShaderTypePair{ pipelineStateDesc.meshShader,           ShaderType::Mesh           },
                        ExpectedShaderTypePair{ pipelineStateDesc.fragmentShader,       ShaderType::Fragment       } })
     {
         if (auto shader = pair.shader)
@@ -1608,6 +2392,18 @@ void DbgRenderSystem::ValidateGraphicsPipelineDesc(const GraphicsPipelineDescrip
     }
 
     ValidateBlendDescriptor(pipelineStateDesc.blend, hasFragmentShader);
+
+    /* Validate sub-pass index */
+    if (pipelineStateDesc.subpass >= LLGL_MAX_NUM_SUBPASSES)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "sub-pass index " + std::to_string(pipelineStateDesc.subpass) + " in graphics PSO exceeds limit of " +
+            std::to_string(LLGL_MAX_NUM_SUBPASSES) + " sub-passes"
+        );
+    }
+    else if (pipelineStateDesc.subpass > 0 && pipelineStateDesc.renderPass == nullptr)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot create graphics PSO for sub-pass " + std::to_string(pipelineStateDesc.subpass) + " without render pass");
 }
 
 void DbgRenderSystem::ValidateComputePipelineDesc(const ComputePipelineDescriptor& pipelineStateDesc)
@@ -1658,8 +2454,127 @@ void DbgRenderSystem::AssertMultiSampleTextures()
         LLGL_DBG_ERROR_NOT_SUPPORTED("multi-sample textures");
 }
 
+void DbgRenderSystem::StoreResourceHeapResources(DbgResourceHeap& resourceHeapDbg, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews)
+{
+    auto& resources = resourceHeapDbg.resources;
+    if (resources.size() < firstDescriptor + resourceViews.size())
+        resources.resize(firstDescriptor + resourceViews.size(), nullptr);
+
+    for_range(i, resourceViews.size())
+    {
+        /* Only buffers and textures are wrapped by the debug layer */
+        auto resource = resourceViews[i].resource;
+        if (resource != nullptr && resource->GetResourceType() != ResourceType::Buffer && resource->GetResourceType() != ResourceType::Texture)
+            resource = nullptr;
+        resources[firstDescriptor + i] = resource;
+    }
+}
+
+void DbgRenderSystem::AddLiveResourceSize(std::uint64_t size)
+{
+    liveResourceSize_ += size;
+    peakResourceSize_ = std::max(peakResourceSize_, liveResourceSize_);
+}
+
+static void AccountMemoryRecord(std::map<std::string, ProfileMemoryRecord>& records, const std::string& name, std::uint64_t size)
+{
+    auto& record = records[name];
+    record.name     = name;
+    record.size     += size;
+    record.count    += 1;
+    record.peakSize = std::max(record.peakSize, record.size);
+}
+
+struct DbgBindFlagsName
+{
+    long        flag;
+    const char* name;
+};
+
+static const DbgBindFlagsName g_bindFlagsNames[] =
+{
+    { BindFlags::VertexBuffer,           "VertexBuffer"           },
+    { BindFlags::IndexBuffer,            "IndexBuffer"            },
+    { BindFlags::ConstantBuffer,         "ConstantBuffer"         },
+    { BindFlags::StreamOutputBuffer,     "StreamOutputBuffer"     },
+    { BindFlags::IndirectBuffer,         "IndirectBuffer"         },
+    { BindFlags::Sampled,                "Sampled"                },
+    { BindFlags::Storage,                "Storage"                },
+    { BindFlags::ColorAttachment,        "ColorAttachment"        },
+    { BindFlags::DepthStencilAttachment, "DepthStencilAttachment" },
+    { BindFlags::CombinedSampler,        "CombinedSampler"        },
+    { BindFlags::CopySrc,                "CopySrc"                },
+    { BindFlags::CopyDst,                "CopyDst"                },
+};
+
+void DbgRenderSystem::AccountResource(
+    ResourceMemoryStatistics&   outStats,
+    const ResourceType          type,
+    const char*                 name,
+    long                        bindFlags,
+    const Format                format,
+    std::uint64_t               size,
+    bool&                       used,
+    std::uint64_t&              lastUsed,
+    std::uint32_t               unusedResourceFrames)
+{
+    /* Account resource into all of its categories */
+    for (const auto& entry : g_bindFlagsNames)
+    {
+        if ((bindFlags & entry.flag) != 0)
+            AccountMemoryRecord(bindFlagsRecords_, entry.name, size);
+    }
+
+    const char* formatName = ToString(format);
+    AccountMemoryRecord(formatRecords_, (formatName != nullptr ? formatName : "<invalid>"), size);
+    AccountMemoryRecord(nameRecords_, name, size);
+
+    outStats.numResources++;
+
+    /* Update frame index of last usage */
+    if (used)
+    {
+        lastUsed    = resourceFrame_;
+        used        = false;
+    }
+
+    const auto unusedFrames = resourceFrame_ - lastUsed;
+    if (unusedFrames >= unusedResourceFrames)
+    {
+        ProfileUnusedResourceRecord record;
+        {
+            record.name         = name;
+            record.type         = type;
+            record.size         = size;
+            record.unusedFrames = unusedFrames;
+        }
+        outStats.unusedResources.push_back(std::move(record));
+    }
+}
+
+void DbgRenderSystem::ReportResourceLeaks()
+{
+    LLGL_DBG_SOURCE;
+
+    for (const auto& bufferDbg : buffers_)
+    {
+        LLGL_DBG_WARN(
+            WarningType::ImproperState,
+            "resource leak: buffer \"" + std::string(DbgGetObjectName(*bufferDbg)) + "\" (" + std::to_string(bufferDbg->desc.size) + " bytes) has not been released"
+        );
+    }
+
+    for (const auto& textureDbg : textures_)
+    {
+        LLGL_DBG_WARN(
+            WarningType::ImproperState,
+            "resource leak: texture \"" + std::string(DbgGetObjectName(*textureDbg)) + "\" (" + std::to_string(textureDbg->GetMemoryFootprint()) + " bytes) has not been released"
+        );
+    }
+}
+
 template <typename T, typename TBase>
-void DbgRenderSystem::ReleaseDbg(std::set<std::unique_ptr<T>>& cont, TBase& entry)
+void DbgRenderSystem::ReleaseDbg(HWObjectContainer<T>& cont, TBase& entry)
 {
     auto& entryDbg = LLGL_CAST(T&, entry);
     instance_->Release(entryDbg.instance);
@@ -25,6 +25,7 @@
 #include "Texture/DbgRenderTarget.h"
 
 #include "../ContainerTypes.h"
+#include <map>
 
 
 namespace LLGL
@@ -39,7 +40,8 @@ class DbgRenderSystem final : public RenderSystem
 
         /* ----- Common ----- */
 
-        DbgRenderSystem(RenderSystemPtr&& instance, RenderingProfiler* profiler, RenderingDebugger* debugger);
+        DbgRenderSystem(RenderSystemPtr&& instance, RenderingProfiler* profiler, RenderingDebugger* debugger, const DebugValidation validation = DebugValidation::Hazards);
+        ~DbgRenderSystem();
 
         /* ----- Swap-chain ------ */
 
@@ -50,6 +52,7 @@ class DbgRenderSystem final : public RenderSystem
         /* ----- Command queues ----- */
 
         CommandQueue* GetCommandQueue() override;
+        CommandQueue* GetComputeQueue() override;
 
         /* ----- Command buffers ----- */
 
@@ -60,12 +63,13 @@ class DbgRenderSystem final : public RenderSystem
         /* ----- Buffers ------ */
 
         Buffer* CreateBuffer(const BufferDescriptor& bufferDesc, const void* initialData = nullptr) override;
-        BufferArray* CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray) override;
+        BufferArray* CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets = nullptr) override;
 
         void Release(Buffer& buffer) override;
         void Release(BufferArray& bufferArray) override;
 
         void WriteBuffer(Buffer& buffer, std::uint64_t offset, const void* data, std::uint64_t dataSize) override;
+        void WriteBuffer(Buffer& buffer, std::uint32_t numRegions, const BufferWriteRegion* regions) override;
         void ReadBuffer(Buffer& buffer, std::uint64_t offset, void* data, std::uint64_t dataSize) override;
 
         void* MapBuffer(Buffer& buffer, const CPUAccess access) override;
@@ -81,6 +85,23 @@ class DbgRenderSystem final : public RenderSystem
         void WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc) override;
         void ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc) override;
 
+        bool QueryTextureTiling(const Texture& texture, TextureTiling& outTiling) override;
+        void CommitTextureTiles(Texture& texture, const TextureRegion& textureRegion) override;
+        void DecommitTextureTiles(Texture& texture, const TextureRegion& textureRegion) override;
+
+        /* ----- Native resources ----- */
+
+        bool QueryNativeHandle(const Resource& resource, NativeResourceHandle& outHandle) override;
+        bool ExportResource(Resource& resource, NativeHandleType handleType, NativeResourceHandle& outHandle) override;
+
+        Buffer* ImportBuffer(const BufferDescriptor& bufferDesc, const NativeResourceHandle& nativeHandle) override;
+        Texture* ImportTexture(const TextureDescriptor& textureDesc, const NativeResourceHandle& nativeHandle) override;
+
+        /* ----- Readbacks ----- */
+
+        const void* MapReadback(std::uint64_t ticket, ReadbackLayout* outLayout = nullptr) override;
+        void UnmapReadback(std::uint64_t ticket) override;
+
         /* ----- Sampler States ---- */
 
         Sampler* CreateSampler(const SamplerDescriptor& samplerDesc) override;
@@ -110,6 +131,7 @@ class DbgRenderSystem final : public RenderSystem
         /* ----- Shader ----- */
 
         Shader* CreateShader(const ShaderDescriptor& shaderDesc) override;
+        void CreateShaders(std::uint32_t numShaders, const ShaderDescriptor* shaderDescs, Shader** outShaders) override;
 
         void Release(Shader& shader) override;
 
@@ -124,6 +146,8 @@ class DbgRenderSystem final : public RenderSystem
         PipelineState* CreatePipelineState(const Blob& serializedCache) override;
         PipelineState* CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache = nullptr) override;
         PipelineState* CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache = nullptr) override;
+        PipelineState* CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc, long flags = 0) override;
+        PipelineState* CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc, long flags = 0) override;
 
         void Release(PipelineState& pipelineState) override;
 
@@ -139,6 +163,32 @@ class DbgRenderSystem final : public RenderSystem
 
         void Release(Fence& fence) override;
 
+        /* ----- Memory ----- */
+
+        bool QueryMemoryStatistics(MemoryStatistics& outStats) override;
+
+        /* ----- Residency ----- */
+
+        bool SetResidencyPriority(const ArrayView<Resource*>& resources, ResidencyPriority priority) override;
+        bool MakeResident(const ArrayView<Resource*>& resources) override;
+        bool Evict(const ArrayView<Resource*>& resources) override;
+
+        /* ----- Commands ----- */
+
+        bool QueryCommandStatistics(CommandStatistics& outStats) override;
+
+        /* ----- Start-up ----- */
+
+        bool QueryStartupStatistics(StartupStatistics& outStats) override;
+
+    public:
+
+        /*
+        Advances the frame index of the resource accounting and accounts the memory of all live buffers and textures into the output statistics.
+        This is called by DbgSwapChain::Present if RenderingProfiler::resourceAccountingEnabled is true.
+        */
+        void AccountResourceMemory(ResourceMemoryStatistics& outStats, std::uint32_t unusedResourceFrames);
+
     private:
 
         void ValidateBindFlags(long flags);
@@ -170,13 +220,26 @@ class DbgRenderSystem final : public RenderSystem
         void ValidateTextureArrayRange(const DbgTexture& textureDbg, std::uint32_t baseArrayLayer, std::uint32_t numArrayLayers);
         void ValidateTextureArrayRangeWithEnd(std::uint32_t baseArrayLayer, std::uint32_t numArrayLayers, std::uint32_t arrayLayerLimit);
         void ValidateTextureRegion(const DbgTexture& textureDbg, const TextureRegion& textureRegion);
+        void ValidateTextureTileRegion(const DbgTexture& textureDbg, const TextureRegion& textureRegion);
+        void ValidateSharedMiscFlags(long miscFlags);
+        void ValidateNativeHandle(const NativeResourceHandle& nativeHandle);
         void ValidateTextureView(const DbgTexture& sharedTextureDbg, const TextureViewDescriptor& textureViewDesc);
         void ValidateTextureViewType(const TextureType sharedTextureType, const TextureType textureViewType, const std::initializer_list<TextureType>& validTypes);
-        void ValidateImageDataSize(const DbgTexture& textureDbg, const TextureRegion& textureRegion, ImageFormat imageFormat, DataType dataType, std::size_t dataSize);
+        void ValidateImageDataSize(const DbgTexture& textureDbg, const TextureRegion& textureRegion, ImageFormat imageFormat, DataType dataType, std::size_t dataSize, std::uint32_t rowStride, std::uint32_t layerStride);
 
         void ValidateAttachmentDesc(const AttachmentDescriptor& attachmentDesc);
+        void ValidateShadingRateImage(const DbgTexture& textureDbg, const Extent2D& resolution);
+
+        void ValidateRenderPassDesc(const RenderPassDescriptor& renderPassDesc);
+
+        void ValidatePipelineLayoutDesc(const PipelineLayoutDescriptor& pipelineLayoutDesc);
 
         void ValidateResourceHeapDesc(const ResourceHeapDescriptor& resourceHeapDesc, const ArrayView<ResourceViewDescriptor>& initialResourceViews);
+        void ValidateBindlessResourceHeapDesc(
+            const ResourceHeapDescriptor&               resourceHeapDesc,
+            const ArrayView<ResourceViewDescriptor>&    initialResourceViews,
+            const std::vector<BindingDescriptor>&       bindings
+        );
         void ValidateResourceHeapRange(const DbgResourceHeap& resourceHeapDbg, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews);
         void ValidateResourceViewForBinding(const ResourceViewDescriptor& rvDesc, const BindingDescriptor& bindingDesc);
         void ValidateBufferForBinding(const DbgBuffer& bufferDbg, const BindingDescriptor& bindingDesc);
@@ -194,18 +257,44 @@ class DbgRenderSystem final : public RenderSystem
         void AssertMultiSampleTextures();
 
         template <typename T, typename TBase>
-        void ReleaseDbg(std::set<std::unique_ptr<T>>& cont, TBase& entry);
+        void ReleaseDbg(HWObjectContainer<T>& cont, TBase& entry);
 
         std::vector<ResourceViewDescriptor> GetResourceViewInstanceCopy(const ArrayView<ResourceViewDescriptor>& resourceViews);
 
+        // Returns the wrapped instances of the specified buffers and textures. The debug source must have been set by the caller.
+        std::vector<Resource*> GetResidencyResourceInstances(const ArrayView<Resource*>& resources);
+
+        // Stores the debug layer resources of the specified resource views in the resource heap to track their usage.
+        void StoreResourceHeapResources(DbgResourceHeap& resourceHeapDbg, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews);
+
+        // Adds the specified size to the total size of all live resources and updates the peak size.
+        void AddLiveResourceSize(std::uint64_t size);
+
+        // Accounts the specified resource into the memory records and the list of unused resources.
+        void AccountResource(
+            ResourceMemoryStatistics&   outStats,
+            const ResourceType          type,
+            const char*                 name,
+            long                        bindFlags,
+            const Format                format,
+            std::uint64_t               size,
+            bool&                       used,
+            std::uint64_t&              lastUsed,
+            std::uint32_t               unusedResourceFrames
+        );
+
+        // Reports all buffers and textures that have not been released as leaks.
+        void ReportResourceLeaks();
+
     private:
 
         /* ----- Common objects ----- */
 
         RenderSystemPtr                         instance_;
 
-        RenderingProfiler*                      profiler_   = nullptr;
-        RenderingDebugger*                      debugger_   = nullptr;
+        RenderingProfiler*                      profiler_       = nullptr;
+        RenderingDebugger*                      debugger_       = nullptr;
+        std::uint32_t                           validationMask_ = ~0u;      // Bitmask of DbgValidationBits.
 
         const RenderingCapabilities&            caps_;
         const RenderingFeatures&                features_;
@@ -215,6 +304,7 @@ class DbgRenderSystem final : public RenderSystem
 
         HWObjectContainer<DbgSwapChain>         swapChains_;
         HWObjectInstance<DbgCommandQueue>       commandQueue_;
+        HWObjectInstance<DbgCommandQueue>       computeQueue_;
         HWObjectContainer<DbgCommandBuffer>     commandBuffers_;
         HWObjectContainer<DbgBuffer>            buffers_;
         HWObjectContainer<DbgBufferArray>       bufferArrays_;
@@ -228,6 +318,17 @@ class DbgRenderSystem final : public RenderSystem
         //HWObjectContainer<DbgSampler>           samplers_;
         HWObjectContainer<DbgQueryHeap>         queryHeaps_;
 
+        /* ----- Resource accounting ----- */
+
+        std::uint64_t                           resourceFrame_              = 0;
+        std::uint64_t                           liveResourceSize_           = 0;
+        std::uint64_t                           peakResourceSize_           = 0;
+
+        // Memory records per BindFlags, format, and debug name. These are kept across frames to track the peak of each category.
+        std::map<std::string, ProfileMemoryRecord>  bindFlagsRecords_;
+        std::map<std::string, ProfileMemoryRecord>  formatRecords_;
+        std::map<std::string, ProfileMemoryRecord>  nameRecords_;
+
 };
 
 
@@ -0,0 +1,104 @@
+/*
+ * DbgStateChangeAnalyzer.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "DbgStateChangeAnalyzer.h"
+
+
+namespace LLGL
+{
+
+
+struct DbgStateChangeCommandInfo
+{
+    const char* command;
+    const char* sortKey;
+};
+
+static const DbgStateChangeCommandInfo g_stateChangeCommandInfos[DbgStateChangeAnalyzer::Command_Num] =
+{
+    { "SetPipelineState", "PSO"           },
+    { "SetResourceHeap",  "resource heap" },
+    { "SetResource",      "resource"      },
+    { "SetVertexBuffer",  "vertex buffer" },
+    { "SetIndexBuffer",   "index buffer"  },
+    { "SetViewport",      "viewport"      },
+};
+
+void DbgStateChangeAnalyzer::Reset()
+{
+    entries_.clear();
+    scopeStack_.clear();
+}
+
+void DbgStateChangeAnalyzer::PushScope(const char* name)
+{
+    scopeStack_.push_back(scopeNames_.insert(name).first->c_str());
+}
+
+void DbgStateChangeAnalyzer::PopScope()
+{
+    if (!scopeStack_.empty())
+        scopeStack_.pop_back();
+}
+
+void DbgStateChangeAnalyzer::Record(Command command, const void* state, bool redundant)
+{
+    auto& entry = GetOrCreateEntry(command);
+
+    entry.record.numCalls++;
+    if (redundant)
+        entry.record.numRedundantCalls++;
+
+    if (state != nullptr)
+    {
+        entry.states.insert(state);
+        entry.record.numDistinctStates = static_cast<std::uint32_t>(entry.states.size());
+    }
+}
+
+void DbgStateChangeAnalyzer::TakeRecords(std::vector<ProfileStateChangeRecord>& outRecords)
+{
+    outRecords.clear();
+    outRecords.reserve(entries_.size());
+    for (const auto& entry : entries_)
+        outRecords.push_back(entry.record);
+    entries_.clear();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+DbgStateChangeAnalyzer::Entry& DbgStateChangeAnalyzer::GetOrCreateEntry(Command command)
+{
+    const char* annotation = (scopeStack_.empty() ? "" : scopeStack_.back());
+    const char* commandName = g_stateChangeCommandInfos[command].command;
+
+    /* Annotations are unique pointers into the persistent scope names, so they can be compared by their address */
+    for (auto& entry : entries_)
+    {
+        if (entry.record.command == commandName && entry.record.annotation == annotation)
+            return entry;
+    }
+
+    entries_.emplace_back();
+    auto& entry = entries_.back();
+    {
+        entry.record.annotation = annotation;
+        entry.record.command    = commandName;
+        entry.record.sortKey    = g_stateChangeCommandInfos[command].sortKey;
+    }
+    return entry;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,92 @@
+/*
+ * DbgStateChangeAnalyzer.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_DBG_STATE_CHANGE_ANALYZER_H
+#define LLGL_DBG_STATE_CHANGE_ANALYZER_H
+
+
+#include <LLGL/RenderingProfiler.h>
+#include <vector>
+#include <string>
+#include <unordered_set>
+
+
+namespace LLGL
+{
+
+
+/*
+State-change analyzer for the performance profiler of the debug layer.
+Counts the calls, redundant calls, and distinct states of each state-change command per debug group,
+so the output records tell how many state switches could be avoided by sorting the draw calls of a debug group.
+*/
+class DbgStateChangeAnalyzer
+{
+
+    public:
+
+        enum Command
+        {
+            Command_SetPipelineState = 0,
+            Command_SetResourceHeap,
+            Command_SetResource,
+            Command_SetVertexBuffer,
+            Command_SetIndexBuffer,
+            Command_SetViewport,
+            Command_Num,
+        };
+
+    public:
+
+        // Discards all records and scopes of the previous command buffer encoding.
+        void Reset();
+
+        // Opens a new scope with the specified name, i.e. the annotation for all subsequent records.
+        void PushScope(const char* name);
+
+        // Closes the innermost scope.
+        void PopScope();
+
+        /*
+        Records a call of the specified command. The 'state' pointer identifies the state that is set by this command,
+        or null if distinct states are not tracked for this command.
+        */
+        void Record(Command command, const void* state, bool redundant);
+
+        // Moves all records to the specified output container.
+        void TakeRecords(std::vector<ProfileStateChangeRecord>& outRecords);
+
+    private:
+
+        struct Entry
+        {
+            ProfileStateChangeRecord            record;
+            std::unordered_set<const void*>     states;
+        };
+
+    private:
+
+        // Returns the entry of the specified command within the innermost scope and creates it if necessary.
+        Entry& GetOrCreateEntry(Command command);
+
+    private:
+
+        std::vector<Entry>              entries_;
+        std::vector<const char*>        scopeStack_;
+        std::unordered_set<std::string> scopeNames_;    // Persistent storage for the annotations of all records
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -6,15 +6,19 @@
  */
 
 #include "DbgSwapChain.h"
+#include "DbgRenderSystem.h"
 #include "DbgCore.h"
+#include <LLGL/Timer.h>
 
 
 namespace LLGL
 {
 
 
-DbgSwapChain::DbgSwapChain(SwapChain& instance) :
-    instance { instance }
+DbgSwapChain::DbgSwapChain(SwapChain& instance, DbgRenderSystem& renderSystem, RenderingProfiler* profiler) :
+    instance      { instance     },
+    renderSystem_ { renderSystem },
+    profiler_     { profiler     }
 {
     ShareSurfaceAndConfig(instance);
 }
@@ -26,7 +30,40 @@ void DbgSwapChain::SetName(const char* name)
 
 void DbgSwapChain::Present()
 {
+    const auto startTick = Timer::Tick();
     instance.Present();
+
+    /* Write CPU time of the present call to the trace (if set) */
+    if (profiler_ != nullptr && profiler_->traceWriter != nullptr)
+        profiler_->traceWriter->WriteCPUEvent("Present", startTick, Timer::Tick());
+
+    /* Sample memory statistics of the presented frame */
+    if (profiler_ != nullptr && profiler_->memoryStatisticsEnabled)
+        renderSystem_.QueryMemoryStatistics(profiler_->memoryStatistics);
+
+    /* Account memory of all live resources with the presented frame */
+    if (profiler_ != nullptr && profiler_->resourceAccountingEnabled)
+        renderSystem_.AccountResourceMemory(profiler_->resourceMemory, profiler_->unusedResourceFrames);
+}
+
+void DbgSwapChain::WaitForNextFrame()
+{
+    instance.WaitForNextFrame();
+}
+
+bool DbgSwapChain::QueryPresentStatistics(PresentStatistics& outStats)
+{
+    return instance.QueryPresentStatistics(outStats);
+}
+
+bool DbgSwapChain::SetDamageRegions(std::uint32_t numRegions, const Scissor* regions)
+{
+    return instance.SetDamageRegions(numRegions, regions);
+}
+
+std::uint32_t DbgSwapChain::QueryBufferAge()
+{
+    return instance.QueryBufferAge();
 }
 
 std::uint32_t DbgSwapChain::GetSamples() const
@@ -10,6 +10,8 @@
 
 
 #include <LLGL/SwapChain.h>
+#include <LLGL/RenderingProfiler.h>
+#include <LLGL/Container/StringView.h>
 
 
 namespace LLGL
@@ -17,6 +19,7 @@ namespace LLGL
 
 
 class DbgBuffer;
+class DbgRenderSystem;
 
 class DbgSwapChain final : public SwapChain
 {
@@ -26,6 +29,10 @@ class DbgSwapChain final : public SwapChain
         void SetName(const char* name) override;
 
         void Present() override;
+        void WaitForNextFrame() override;
+        bool QueryPresentStatistics(PresentStatistics& outStats) override;
+        bool SetDamageRegions(std::uint32_t numRegions, const Scissor* regions) override;
+        std::uint32_t QueryBufferAge() override;
 
         std::uint32_t GetSamples() const override;
 
@@ -38,17 +45,22 @@ class DbgSwapChain final : public SwapChain
 
     public:
 
-        DbgSwapChain(SwapChain& instance);
+        DbgSwapChain(SwapChain& instance, DbgRenderSystem& renderSystem, RenderingProfiler* profiler);
 
     public:
 
         SwapChain&  instance;
-        std::string label;
+        StringView  label;
 
     private:
 
         bool ResizeBuffersPrimary(const Extent2D& resolution) override;
 
+    private:
+
+        DbgRenderSystem&    renderSystem_;
+        RenderingProfiler*  profiler_       = nullptr;
+
 };
 
 
@@ -7,6 +7,7 @@
 
 #include "DbgPipelineLayout.h"
 #include "../DbgCore.h"
+#include <algorithm>
 
 
 namespace LLGL
@@ -17,6 +18,26 @@ DbgPipelineLayout::DbgPipelineLayout(PipelineLayout& instance, const PipelineLay
     instance { instance },
     desc     { desc     }
 {
+    for (const auto& binding : desc.bindings)
+    {
+        if ((binding.flags & (BindingFlags::DynamicBinding | BindingFlags::InlineUniforms)) == 0)
+            heapBindings.push_back(binding);
+        if ((binding.flags & BindingFlags::DynamicOffset) != 0)
+            dynamicOffsetBindings.push_back(binding);
+    }
+
+    if (!heapBindings.empty() && (heapBindings.back().flags & BindingFlags::Bindless) != 0)
+        hasBindlessBinding = true;
+
+    /* Dynamic offsets are ordered by the binding slots */
+    std::stable_sort(
+        dynamicOffsetBindings.begin(),
+        dynamicOffsetBindings.end(),
+        [](const BindingDescriptor& lhs, const BindingDescriptor& rhs)
+        {
+            return (lhs.slot < rhs.slot);
+        }
+    );
 }
 
 void DbgPipelineLayout::SetName(const char* name)
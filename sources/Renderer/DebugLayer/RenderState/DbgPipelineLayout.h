@@ -11,7 +11,7 @@
 
 #include <LLGL/PipelineLayout.h>
 #include <LLGL/PipelineLayoutFlags.h>
-#include <string>
+#include <LLGL/Container/StringView.h>
 
 
 namespace LLGL
@@ -35,7 +35,10 @@ class DbgPipelineLayout final : public PipelineLayout
 
         PipelineLayout&                 instance;
         const PipelineLayoutDescriptor  desc;
-        std::string                     label;
+        std::vector<BindingDescriptor>  heapBindings;           // Bindings that are part of resource heaps, i.e. without dynamic bindings and inline uniforms
+        std::vector<BindingDescriptor>  dynamicOffsetBindings;  // Bindings with BindingFlags::DynamicOffset in the order of their dynamic offsets
+        bool                            hasBindlessBinding = false; // Last entry in 'heapBindings' has BindingFlags::Bindless
+        StringView                      label;
 
 };
 
@@ -11,7 +11,7 @@
 
 #include <LLGL/PipelineState.h>
 #include <LLGL/PipelineStateFlags.h>
-#include <string>
+#include <LLGL/Container/StringView.h>
 
 
 namespace LLGL
@@ -25,6 +25,8 @@ class DbgPipelineState final : public PipelineState
 
         void SetName(const char* name) override;
         const Report* GetReport() const override;
+        bool IsReady() const override;
+        void Wait() override;
 
     public:
 
@@ -35,7 +37,7 @@ class DbgPipelineState final : public PipelineState
     public:
 
         PipelineState&  instance;
-        std::string     label;
+        StringView      label;
         const bool      isGraphicsPSO   = false;
 
         union
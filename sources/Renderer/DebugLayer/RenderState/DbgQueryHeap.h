@@ -11,7 +11,7 @@
 
 #include <LLGL/QueryHeap.h>
 #include <vector>
-#include <string>
+#include <LLGL/Container/StringView.h>
 
 
 namespace LLGL
@@ -42,7 +42,7 @@ class DbgQueryHeap final : public QueryHeap
 
         QueryHeap&                  instance;
         const QueryHeapDescriptor   desc;
-        std::string                 label;
+        StringView                  label;
         std::vector<State>          states;
 
 };
@@ -18,7 +18,7 @@ namespace LLGL
 static std::uint32_t GetNumPipelineLayoutBindings(const PipelineLayout* pipelineLayout)
 {
     auto pipelineLayoutDbg = LLGL_CAST(const DbgPipelineLayout*, pipelineLayout);
-    return std::max(1u, static_cast<std::uint32_t>(pipelineLayoutDbg->desc.bindings.size()));
+    return std::max(1u, static_cast<std::uint32_t>(pipelineLayoutDbg->heapBindings.size()));
 }
 
 DbgResourceHeap::DbgResourceHeap(ResourceHeap& instance, const ResourceHeapDescriptor& desc) :
@@ -40,6 +40,10 @@ std::uint32_t DbgResourceHeap::GetNumDescriptorSets() const
 
 std::uint32_t DbgResourceHeap::GetNumDescriptorSetsSafe() const
 {
+    /* Bindless resource heaps always have a single descriptor set */
+    auto pipelineLayoutDbg = LLGL_CAST(const DbgPipelineLayout*, desc.pipelineLayout);
+    if (pipelineLayoutDbg->hasBindlessBinding)
+        return 1;
     return static_cast<std::uint32_t>(desc.numResourceViews / numBindings);
 }
 
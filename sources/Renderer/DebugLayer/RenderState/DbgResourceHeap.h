@@ -11,7 +11,8 @@
 
 #include <LLGL/ResourceHeap.h>
 #include <LLGL/ResourceHeapFlags.h>
-#include <string>
+#include <LLGL/Container/StringView.h>
+#include <vector>
 
 
 namespace LLGL
@@ -38,8 +39,9 @@ class DbgResourceHeap final : public ResourceHeap
 
         ResourceHeap&                   instance;
         const ResourceHeapDescriptor    desc;
-        std::string                     label;
+        StringView                      label;
         const std::uint32_t             numBindings = 1;
+        std::vector<Resource*>          resources;          // Debug layer resources of all descriptors
 
 };
 
@@ -11,6 +11,7 @@
 
 #include <LLGL/Shader.h>
 #include <LLGL/RenderingDebugger.h>
+#include <LLGL/Container/StringView.h>
 #include <string>
 
 
@@ -46,7 +47,7 @@ class DbgShader final : public Shader
 
         Shader&                 instance;
         const ShaderDescriptor  desc;
-        std::string             label;
+        StringView              label;
 
     private:
 
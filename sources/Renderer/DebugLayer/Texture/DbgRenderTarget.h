@@ -10,7 +10,7 @@
 
 
 #include <LLGL/RenderTarget.h>
-#include <string>
+#include <LLGL/Container/StringView.h>
 
 
 namespace LLGL
@@ -43,7 +43,7 @@ class DbgRenderTarget final : public RenderTarget
 
         RenderTarget&                   instance;
         const RenderTargetDescriptor    desc;
-        std::string                     label;
+        StringView                      label;
 
 };
 
@@ -10,7 +10,7 @@
 
 
 #include <LLGL/Texture.h>
-#include <string>
+#include <LLGL/Container/StringView.h>
 #include <set>
 
 
@@ -40,8 +40,10 @@ class DbgTexture final : public Texture
         const TextureDescriptor desc;
         TextureViewDescriptor   viewDesc;
         std::uint32_t           mipLevels           = 1;        // Actual number of MIP-map levels.
-        std::string             label;
+        StringView              label;
         const bool              isTextureView       = false;
+        bool                    used                = false;    // Specifies whether this texture has been bound since the last resource accounting.
+        std::uint64_t           lastUsed            = 0;        // Frame index when this texture has been used or created.
 
     private:
 
@@ -167,8 +167,8 @@ void D3D11Buffer::ReadSubresource(ID3D11DeviceContext* context, void* data, UINT
 // private
 D3D11_MAP D3D11Buffer::GetCPUAccessTypeForUsage(const CPUAccess access) const
 {
-    /* D3D11_MAP_WRITE_DISCARD can only be used for buffers with dynamic usage */
-    if (access == CPUAccess::WriteDiscard && usage_ != D3D11_USAGE_DYNAMIC)
+    /* D3D11_MAP_WRITE_DISCARD and D3D11_MAP_WRITE_NO_OVERWRITE can only be used for buffers with dynamic usage */
+    if ((access == CPUAccess::WriteDiscard || access == CPUAccess::WriteUnsynchronized) && usage_ != D3D11_USAGE_DYNAMIC)
         return D3D11_MAP_WRITE;
     else
         return D3D11Types::Map(access);
@@ -16,7 +16,7 @@ namespace LLGL
 {
 
 
-D3D11BufferArray::D3D11BufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray) :
+D3D11BufferArray::D3D11BufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets) :
     BufferArray { GetCombinedBindFlags(numBuffers, bufferArray) }
 {
     /* Store the pointer of each ID3D11Buffer, strides, and offests inside the arrays */
@@ -29,7 +29,7 @@ D3D11BufferArray::D3D11BufferArray(std::uint32_t numBuffers, Buffer* const * buf
     {
         buffers_[i]                             = next->GetNative();
         stridesAndOffsets_[i]                   = next->GetStride();
-        stridesAndOffsets_[i + offsetStart_]    = 0;//next->GetOffset());
+        stridesAndOffsets_[i + offsetStart_]    = (offsets != nullptr ? static_cast<UINT>(offsets[i]) : 0);
     }
 }
 
@@ -25,7 +25,7 @@ class D3D11BufferArray final : public BufferArray
 
     public:
 
-        D3D11BufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray);
+        D3D11BufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets = nullptr);
 
         // Returns the number fo buffers in this array.
         UINT GetCount() const;
@@ -0,0 +1,83 @@
+/*
+ * D3D11DynamicRingBuffer.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D11DynamicRingBuffer.h"
+#include "../../DXCommon/DXCore.h"
+#include "../../../Core/Helper.h"
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+D3D11DynamicRingBuffer::D3D11DynamicRingBuffer(
+    ID3D11Device*   device,
+    UINT            size,
+    UINT            bindFlags,
+    UINT            alignment)
+:
+    size_      { size      },
+    alignment_ { alignment }
+{
+    /* Create dynamic D3D11 hardware buffer for CPU write access */
+    D3D11_BUFFER_DESC descD3D;
+    {
+        descD3D.ByteWidth           = size;
+        descD3D.Usage               = D3D11_USAGE_DYNAMIC;
+        descD3D.BindFlags           = bindFlags;
+        descD3D.CPUAccessFlags      = D3D11_CPU_ACCESS_WRITE;
+        descD3D.MiscFlags           = 0;
+        descD3D.StructureByteStride = 0;
+    }
+    auto hr = device->CreateBuffer(&descD3D, nullptr, native_.GetAddressOf());
+    DXThrowIfCreateFailed(hr, "ID3D11Buffer", "for dynamic ring buffer");
+}
+
+void D3D11DynamicRingBuffer::Reset()
+{
+    discard_ = true;
+}
+
+bool D3D11DynamicRingBuffer::Capacity(UINT dataSize) const
+{
+    return (GetAlignedSize(dataSize, alignment_) <= size_);
+}
+
+D3D11BufferRange D3D11DynamicRingBuffer::Write(ID3D11DeviceContext* context, const void* data, UINT dataSize)
+{
+    const UINT alignedSize = GetAlignedSize(dataSize, alignment_);
+
+    /* Discard previous content when the ring buffer wraps around, otherwise append data without synchronization */
+    if (discard_ || offset_ + alignedSize > size_)
+    {
+        offset_     = 0;
+        discard_    = true;
+    }
+
+    D3D11_MAPPED_SUBRESOURCE mappedSubresource;
+    auto hr = context->Map(GetNative(), 0, (discard_ ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE), 0, &mappedSubresource);
+    DXThrowIfFailed(hr, "failed to map D3D11 dynamic ring buffer");
+    {
+        ::memcpy(reinterpret_cast<char*>(mappedSubresource.pData) + offset_, data, dataSize);
+    }
+    context->Unmap(GetNative(), 0);
+
+    D3D11BufferRange range = { GetNative(), offset_, alignedSize };
+    {
+        offset_     += alignedSize;
+        discard_    = false;
+    }
+    return range;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
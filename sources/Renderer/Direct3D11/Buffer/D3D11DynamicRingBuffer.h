@@ -0,0 +1,77 @@
+/*
+ * D3D11DynamicRingBuffer.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D11_DYNAMIC_RING_BUFFER_H
+#define LLGL_D3D11_DYNAMIC_RING_BUFFER_H
+
+
+#include "D3D11IntermediateBufferPool.h"
+#include "../../DXCommon/ComPtr.h"
+#include <d3d11.h>
+
+
+namespace LLGL
+{
+
+
+/*
+Dynamic buffer that is written from front to back with D3D11_MAP_WRITE_NO_OVERWRITE.
+The buffer is only mapped with D3D11_MAP_WRITE_DISCARD when the write offset wraps around,
+so the driver only has to rename the buffer once per cycle instead of once per write.
+*/
+class D3D11DynamicRingBuffer
+{
+
+    public:
+
+        D3D11DynamicRingBuffer(
+            ID3D11Device*   device,
+            UINT            size,
+            UINT            bindFlags,
+            UINT            alignment   = 1
+        );
+
+        D3D11DynamicRingBuffer(const D3D11DynamicRingBuffer&) = delete;
+        D3D11DynamicRingBuffer& operator = (const D3D11DynamicRingBuffer&) = delete;
+
+        // Discards the buffer with the next write. Must be called at the beginning of each command list for deferred contexts.
+        void Reset();
+
+        // Returns true if the specified amount of data can be written into the ring buffer at once.
+        bool Capacity(UINT dataSize) const;
+
+        /*
+        Writes the specified data into the ring buffer and returns the range that has been written to.
+        The offset and size of the range are multiples of the alignment, so the range can be bound with VSSetConstantBuffers1 etc.
+        */
+        D3D11BufferRange Write(ID3D11DeviceContext* context, const void* data, UINT dataSize);
+
+        // Returns the native ID3D11Buffer object.
+        inline ID3D11Buffer* GetNative() const
+        {
+            return native_.Get();
+        }
+
+    private:
+
+        ComPtr<ID3D11Buffer>    native_;
+        UINT                    size_       = 0;
+        UINT                    alignment_  = 1;
+        UINT                    offset_     = 0;
+        bool                    discard_    = true;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
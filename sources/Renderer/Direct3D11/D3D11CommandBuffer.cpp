@@ -61,7 +61,10 @@ D3D11CommandBuffer::D3D11CommandBuffer(
     {
         hasDeferredContext_ = true;
         if ((desc.flags & CommandBufferFlags::Secondary) != 0)
-            isSecondaryCmdBuffer_ = true;
+        {
+            isSecondaryCmdBuffer_   = true;
+            inheritedRenderTarget_  = desc.renderTarget;
+        }
     }
 
     #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
@@ -74,15 +77,37 @@ D3D11CommandBuffer::D3D11CommandBuffer(
 
 void D3D11CommandBuffer::Begin()
 {
-    // dummy
+    /* Deferred contexts are reset to their default state after each command list, so the state cache is out of date */
+    if (hasDeferredContext_)
+        stateMngr_->ResetStateCache();
+
+    /* Start new cycle for intermediate constant buffers and ring buffers */
+    stateMngr_->ResetIntermediateBufferPools();
+
+    /* Deferred contexts do not inherit any states, so bind the render target of secondary command buffers explicitly */
+    if (inheritedRenderTarget_ != nullptr)
+    {
+        if (LLGL::IsInstanceOf<SwapChain>(*inheritedRenderTarget_))
+            BindSwapChain(LLGL_CAST(D3D11SwapChain&, *inheritedRenderTarget_));
+        else
+            BindRenderTarget(LLGL_CAST(D3D11RenderTarget&, *inheritedRenderTarget_));
+
+        /* Multi-sampled render targets are resolved by the primary command buffer */
+        boundRenderTarget_ = nullptr;
+    }
 }
 
 void D3D11CommandBuffer::End()
 {
+    /* End all disjoint queries that have been begun by timer queries during this recording */
+    for (auto queryHeapD3D : activeTimerQueryHeaps_)
+        queryHeapD3D->EndDisjointQuery(context_.Get());
+    activeTimerQueryHeaps_.clear();
+
     if (hasDeferredContext_)
     {
-        /* Encode commands from deferred context into command list */
-        context_->FinishCommandList(TRUE, commandList_.ReleaseAndGetAddressOf());
+        /* Encode commands from deferred context into command list; don't restore the deferred context state, since each command list starts with the default state */
+        context_->FinishCommandList(FALSE, commandList_.ReleaseAndGetAddressOf());
     }
 }
 
@@ -108,6 +133,15 @@ void D3D11CommandBuffer::UpdateBuffer(
     std::uint16_t   dataSize)
 {
     auto& dstBufferD3D = LLGL_CAST(D3D11Buffer&, dstBuffer);
+
+    /* Copy small updates for buffers with default usage from the upload ring buffer, which also allows partial updates of constant buffers */
+    if (dstBufferD3D.GetDXUsage() == D3D11_USAGE_DEFAULT)
+    {
+        LLGL_ASSERT_RANGE(dstOffset + dataSize, dstBufferD3D.GetSize());
+        if (stateMngr_->WriteBufferStaged(dstBufferD3D.GetNative(), static_cast<UINT>(dstOffset), data, static_cast<UINT>(dataSize)))
+            return;
+    }
+
     dstBufferD3D.UpdateSubresource(context_.Get(), data, static_cast<UINT>(dataSize), static_cast<UINT>(dstOffset));
 }
 
@@ -155,6 +189,24 @@ void D3D11CommandBuffer::ClearWithIntermediateUAV(ID3D11Buffer* buffer, UINT off
     context_->ClearUnorderedAccessViewUint(intermediateUAV.Get(), valuesVec4);
 }
 
+// private
+std::uint32_t D3D11CommandBuffer::ReadIndirectCount(Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands)
+{
+    /* Deferred contexts cannot read back data, so use the immediate context of the device instead */
+    ComPtr<ID3D11DeviceContext> immediateContext;
+    if (hasDeferredContext_)
+        device_->GetImmediateContext(&immediateContext);
+    else
+        immediateContext = context_;
+
+    /* Read number of draw commands from count buffer */
+    auto& countBufferD3D = LLGL_CAST(D3D11Buffer&, countBuffer);
+    std::uint32_t numCommands = 0;
+    countBufferD3D.ReadSubresource(immediateContext.Get(), &numCommands, sizeof(numCommands), static_cast<UINT>(countOffset));
+
+    return std::min(numCommands, maxNumCommands);
+}
+
 // Internal use only (see D3D11CommandBuffer::CopyTextureFromBuffer)
 struct CopyTextureBufferCbuffer
 {
@@ -362,25 +414,29 @@ void D3D11CommandBuffer::CopyBufferFromTexture(
     context_->CSSetUnorderedAccessViews(0, 1, intermediateUAVs, nullptr);
     context_->CSSetShaderResources(0, 1, intermediateSRVs);
 
-    /* Dispatch compute kernels with builtin shader */
-    switch (textureArrayType)
+    /* Dispatch compute kernels with format-specialized or generic builtin shader */
+    if (!DispatchPackedCopyShader(false, textureArrayType, formatAttribs, srcExtent, rowStride, layerStride))
     {
-        case TextureType::Texture1DArray:
-            stateMngr_->DispatchBuiltin(D3D11BuiltinShader::CopyBufferFromTexture1DCS, srcExtent.width, srcExtent.height, 1u);
-            break;
-        case TextureType::Texture2DArray:
-            stateMngr_->DispatchBuiltin(D3D11BuiltinShader::CopyBufferFromTexture2DCS, srcExtent.width, srcExtent.height, srcExtent.depth);
-            break;
-        case TextureType::Texture3D:
-            stateMngr_->DispatchBuiltin(D3D11BuiltinShader::CopyBufferFromTexture3DCS, srcExtent.width, srcExtent.height, srcExtent.depth);
-            break;
-        default:
-            break;
+        switch (textureArrayType)
+        {
+            case TextureType::Texture1DArray:
+                stateMngr_->DispatchBuiltin(D3D11BuiltinShader::CopyBufferFromTexture1DCS, srcExtent.width, srcExtent.height, 1u);
+                break;
+            case TextureType::Texture2DArray:
+                stateMngr_->DispatchBuiltin(D3D11BuiltinShader::CopyBufferFromTexture2DCS, srcExtent.width, srcExtent.height, srcExtent.depth);
+                break;
+            case TextureType::Texture3D:
+                stateMngr_->DispatchBuiltin(D3D11BuiltinShader::CopyBufferFromTexture3DCS, srcExtent.width, srcExtent.height, srcExtent.depth);
+                break;
+            default:
+                break;
+        }
     }
 
     /* Restore previous resource views */
     context_->CSSetUnorderedAccessViews(0, 1, prevUAVs, nullptr);
     context_->CSSetShaderResources(0, 1, prevSRVs);
+    stateMngr_->InvalidateBindings();
 
     /* Copy UAV content into destination buffer, if an intermediate texture was used */
     //if (useIntermediateBuffer)
@@ -629,25 +685,29 @@ void D3D11CommandBuffer::CopyTextureFromBuffer(
     context_->CSSetUnorderedAccessViews(0, 1, intermediateUAVs, nullptr);
     context_->CSSetShaderResources(0, 1, intermediateSRVs);
 
-    /* Dispatch compute kernels with builtin shader */
-    switch (textureArrayType)
+    /* Dispatch compute kernels with format-specialized or generic builtin shader */
+    if (!DispatchPackedCopyShader(true, textureArrayType, formatAttribs, dstExtent, rowStride, layerStride))
     {
-        case TextureType::Texture1DArray:
-            stateMngr_->DispatchBuiltin(D3D11BuiltinShader::CopyTexture1DFromBufferCS, dstExtent.width, dstExtent.height, 1u);
-            break;
-        case TextureType::Texture2DArray:
-            stateMngr_->DispatchBuiltin(D3D11BuiltinShader::CopyTexture2DFromBufferCS, dstExtent.width, dstExtent.height, dstExtent.depth);
-            break;
-        case TextureType::Texture3D:
-            stateMngr_->DispatchBuiltin(D3D11BuiltinShader::CopyTexture3DFromBufferCS, dstExtent.width, dstExtent.height, dstExtent.depth);
-            break;
-        default:
-            break;
+        switch (textureArrayType)
+        {
+            case TextureType::Texture1DArray:
+                stateMngr_->DispatchBuiltin(D3D11BuiltinShader::CopyTexture1DFromBufferCS, dstExtent.width, dstExtent.height, 1u);
+                break;
+            case TextureType::Texture2DArray:
+                stateMngr_->DispatchBuiltin(D3D11BuiltinShader::CopyTexture2DFromBufferCS, dstExtent.width, dstExtent.height, dstExtent.depth);
+                break;
+            case TextureType::Texture3D:
+                stateMngr_->DispatchBuiltin(D3D11BuiltinShader::CopyTexture3DFromBufferCS, dstExtent.width, dstExtent.height, dstExtent.depth);
+                break;
+            default:
+                break;
+        }
     }
 
     /* Restore previous resource views */
     context_->CSSetUnorderedAccessViews(0, 1, prevUAVs, nullptr);
     context_->CSSetShaderResources(0, 1, prevSRVs);
+    stateMngr_->InvalidateBindings();
 
     /* Copy UAV content into destination texture, if an intermediate texture was used */
     if (useIntermediateTexture)
@@ -759,6 +819,9 @@ void D3D11CommandBuffer::SetResourceHeap(
 {
     auto& resourceHeapD3D = LLGL_CAST(D3D11ResourceHeap&, resourceHeap);
 
+    /* Submit pending bindings first, since the resource heap binds its resources directly */
+    stateMngr_->FlushBindings();
+
     #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
     if (context1_.Get() != nullptr)
     {
@@ -775,6 +838,19 @@ void D3D11CommandBuffer::SetResourceHeap(
         if (bindPoint != PipelineBindPoint::Graphics)
             resourceHeapD3D.BindForComputePipeline(context_.Get(), descriptorSet);
     }
+
+    stateMngr_->InvalidateBindings();
+}
+
+void D3D11CommandBuffer::SetResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           descriptorSet,
+    std::uint32_t           /*numDynamicOffsets*/,
+    const std::uint32_t*    /*dynamicOffsets*/,
+    const PipelineBindPoint bindPoint)
+{
+    /* Dynamic offsets are not supported by this renderer (see BindingFlags::DynamicOffset) */
+    SetResourceHeap(resourceHeap, descriptorSet, bindPoint);
 }
 
 void D3D11CommandBuffer::SetResource(Resource& resource, std::uint32_t slot, long bindFlags, long stageFlags)
@@ -841,12 +917,26 @@ void D3D11CommandBuffer::BeginRenderPass(
     {
         auto renderPassD3D = LLGL_CAST(const D3D11RenderPass*, renderPass);
         ClearAttachmentsWithRenderPass(*renderPassD3D, numClearValues, clearValues);
+
+        /* Bind attachments of first sub-pass */
+        subpass_ = 0;
+        if (renderPassD3D->GetNumSubpasses() > 0)
+        {
+            renderPass_ = renderPassD3D;
+            BindSubpassFramebufferView(*renderPass_, subpass_);
+        }
     }
 }
 
 void D3D11CommandBuffer::EndRenderPass()
 {
-    // dummy
+    renderPass_ = nullptr;
+}
+
+void D3D11CommandBuffer::NextSubpass()
+{
+    if (renderPass_ != nullptr && subpass_ + 1 < renderPass_->GetNumSubpasses())
+        BindSubpassFramebufferView(*renderPass_, ++subpass_);
 }
 
 static UINT GetClearFlagsDSV(long flags)
@@ -954,13 +1044,12 @@ void D3D11CommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
     auto& queryHeapD3D = LLGL_CAST(D3D11QueryHeap&, queryHeap);
 
-    query *= queryHeapD3D.GetGroupSize();
-
     if (queryHeapD3D.GetNativeType() == D3D11_QUERY_TIMESTAMP_DISJOINT)
     {
-        /* Begin disjoint query first, and insert the beginning timestamp query */
-        context_->Begin(queryHeapD3D.GetNative(query));
-        context_->End(queryHeapD3D.GetNative(query + 1));
+        /* Begin shared disjoint query of this heap first (only once per recording), and insert the beginning timestamp query */
+        if (queryHeapD3D.BeginDisjointQuery(context_.Get(), query))
+            activeTimerQueryHeaps_.push_back(&queryHeapD3D);
+        context_->End(queryHeapD3D.GetNative(query * queryHeapD3D.GetGroupSize()));
     }
     else
     {
@@ -977,9 +1066,8 @@ void D3D11CommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
 
     if (queryHeapD3D.GetNativeType() == D3D11_QUERY_TIMESTAMP_DISJOINT)
     {
-        /* Insert the ending timestamp query, and end the disjoint query */
-        context_->End(queryHeapD3D.GetNative(query + 2));
-        context_->End(queryHeapD3D.GetNative(query));
+        /* Insert the ending timestamp query; the disjoint query is ended with the command buffer */
+        context_->End(queryHeapD3D.GetNative(query + 1));
     }
     else
     {
@@ -1019,6 +1107,9 @@ void D3D11CommandBuffer::BeginStreamOutput(std::uint32_t numBuffers, Buffer* con
     }
 
     context_->SOSetTargets(numBuffers, soTargets, offsets);
+
+    /* Binding stream-output targets implicitly unbinds all SRVs of the same resources */
+    stateMngr_->InvalidateBindings();
 }
 
 void D3D11CommandBuffer::EndStreamOutput()
@@ -1030,53 +1121,63 @@ void D3D11CommandBuffer::EndStreamOutput()
 
 void D3D11CommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
 {
+    stateMngr_->FlushBindings();
     context_->Draw(numVertices, firstVertex);
 }
 
 void D3D11CommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
 {
+    stateMngr_->FlushBindings();
     context_->DrawIndexed(numIndices, firstIndex, 0);
 }
 
 void D3D11CommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    stateMngr_->FlushBindings();
     context_->DrawIndexed(numIndices, firstIndex, vertexOffset);
 }
 
 void D3D11CommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
 {
+    stateMngr_->FlushBindings();
     context_->DrawInstanced(numVertices, numInstances, firstVertex, 0);
 }
 
 void D3D11CommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
 {
+    stateMngr_->FlushBindings();
     context_->DrawInstanced(numVertices, numInstances, firstVertex, firstInstance);
 }
 
 void D3D11CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
 {
+    stateMngr_->FlushBindings();
     context_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, 0, 0);
 }
 
 void D3D11CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    stateMngr_->FlushBindings();
     context_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, 0);
 }
 
 void D3D11CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
+    stateMngr_->FlushBindings();
     context_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
 }
 
 void D3D11CommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 {
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
+    stateMngr_->FlushBindings();
     context_->DrawInstancedIndirect(bufferD3D.GetNative(), static_cast<UINT>(offset));
 }
 
 void D3D11CommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
+    stateMngr_->FlushBindings();
     while (numCommands-- > 0)
     {
         context_->DrawInstancedIndirect(bufferD3D.GetNative(), static_cast<UINT>(offset));
@@ -1087,12 +1188,14 @@ void D3D11CommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std:
 void D3D11CommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 {
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
+    stateMngr_->FlushBindings();
     context_->DrawIndexedInstancedIndirect(bufferD3D.GetNative(), static_cast<UINT>(offset));
 }
 
 void D3D11CommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
+    stateMngr_->FlushBindings();
     while (numCommands-- > 0)
     {
         context_->DrawIndexedInstancedIndirect(bufferD3D.GetNative(), static_cast<UINT>(offset));
@@ -1100,16 +1203,30 @@ void D3D11CommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offse
     }
 }
 
+void D3D11CommandBuffer::DrawIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride)
+{
+    /* D3D11 has no native support for a GPU draw count, so read it back to the CPU */
+    DrawIndirect(buffer, offset, ReadIndirectCount(countBuffer, countOffset, maxNumCommands), stride);
+}
+
+void D3D11CommandBuffer::DrawIndexedIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride)
+{
+    /* D3D11 has no native support for a GPU draw count, so read it back to the CPU */
+    DrawIndexedIndirect(buffer, offset, ReadIndirectCount(countBuffer, countOffset, maxNumCommands), stride);
+}
+
 /* ----- Compute ----- */
 
 void D3D11CommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
 {
+    stateMngr_->FlushBindings();
     context_->Dispatch(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
 }
 
 void D3D11CommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
 {
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
+    stateMngr_->FlushBindings();
     context_->DispatchIndirect(bufferD3D.GetNative(), static_cast<UINT>(offset));
 }
 
@@ -1155,15 +1272,13 @@ void D3D11CommandBuffer::SetBuffer(Buffer& buffer, std::uint32_t slot, long bind
         /* Set constant buffer resource to all shader stages */
         if ((bindFlags & BindFlags::ConstantBuffer) != 0)
         {
-            ID3D11Buffer* cbv[] = { bufferD3D.GetNative() };
-            stateMngr_->SetConstantBuffers(slot, 1, cbv, stageFlags);
+            stateMngr_->SetConstantBufferDeferred(slot, bufferD3D.GetNative(), stageFlags);
         }
 
         /* Set SRVs to specified shader stages */
         if ((bindFlags & BindFlags::Sampled) != 0)
         {
-            ID3D11ShaderResourceView* srv[] = { bufferD3D.GetSRV() };
-            stateMngr_->SetShaderResources(slot, 1, srv, stageFlags);
+            stateMngr_->SetShaderResourceDeferred(slot, bufferD3D.GetSRV(), stageFlags);
         }
 
         /* Set UAVs to specified shader stages */
@@ -1181,8 +1296,7 @@ void D3D11CommandBuffer::SetBuffer(Buffer& buffer, std::uint32_t slot, long bind
         /* Set constant buffer resource to all shader stages */
         if ((bindFlags & BindFlags::ConstantBuffer) != 0)
         {
-            ID3D11Buffer* cbv[] = { bufferD3D.GetNative() };
-            stateMngr_->SetConstantBuffers(slot, 1, cbv, stageFlags);
+            stateMngr_->SetConstantBufferDeferred(slot, bufferD3D.GetNative(), stageFlags);
         }
     }
 }
@@ -1194,8 +1308,7 @@ void D3D11CommandBuffer::SetTexture(Texture& texture, std::uint32_t slot, long b
     /* Set texture SRV to all shader stages */
     if ((bindFlags & BindFlags::Sampled) != 0)
     {
-        ID3D11ShaderResourceView* srv[] = { textureD3D.GetSRV() };
-        stateMngr_->SetShaderResources(slot, 1, srv, stageFlags);
+        stateMngr_->SetShaderResourceDeferred(slot, textureD3D.GetSRV(), stageFlags);
     }
 
     /* Set texture UAV to all shader stages */
@@ -1212,8 +1325,7 @@ void D3D11CommandBuffer::SetSampler(Sampler& sampler, std::uint32_t slot, long s
     /* Set sampler state object to all shader stages */
     auto& samplerD3D = LLGL_CAST(D3D11Sampler&, sampler);
 
-    ID3D11SamplerState* samplerStates[] = { samplerD3D.GetNative() };
-    stateMngr_->SetSamplers(slot, 1, samplerStates, stageFlags);
+    stateMngr_->SetSamplerDeferred(slot, samplerD3D.GetNative(), stageFlags);
 }
 
 void D3D11CommandBuffer::ResetBufferResourceSlots(std::uint32_t firstSlot, std::uint32_t numSlots, long bindFlags, long stageFlags)
@@ -1363,12 +1475,42 @@ void D3D11CommandBuffer::BindFramebufferView(
         depthStencilView
     );
 
+    /* Binding render targets implicitly unbinds all SRVs of the same resources */
+    stateMngr_->InvalidateBindings();
+
     /* Store new render-target configuration */
     framebufferView_.numRenderTargetViews   = numRenderTargetViews;
     framebufferView_.renderTargetViews      = renderTargetViews;
     framebufferView_.depthStencilView       = depthStencilView;
 }
 
+void D3D11CommandBuffer::BindSubpassFramebufferView(const D3D11RenderPass& renderPassD3D, std::uint32_t subpass)
+{
+    /*
+    Only bind the RTVs the sub-pass writes to, so the input attachments of this sub-pass can be bound as SRVs.
+    The stored framebuffer view is not modified to keep all attachments available for clear commands.
+    */
+    ID3D11RenderTargetView* renderTargetViews[LLGL_MAX_NUM_COLOR_ATTACHMENTS] = {};
+
+    const UINT numRenderTargetViews = std::min<UINT>(framebufferView_.numRenderTargetViews, LLGL_MAX_NUM_COLOR_ATTACHMENTS);
+    const std::uint32_t colorAttachments = renderPassD3D.GetSubpassColorAttachments(subpass);
+
+    for (UINT i = 0; i < numRenderTargetViews; ++i)
+    {
+        if ((colorAttachments & (1u << i)) != 0)
+            renderTargetViews[i] = framebufferView_.renderTargetViews[i];
+    }
+
+    context_->OMSetRenderTargets(
+        numRenderTargetViews,
+        renderTargetViews,
+        (renderPassD3D.HasSubpassDepthStencil(subpass) ? framebufferView_.depthStencilView : nullptr)
+    );
+
+    /* Binding render targets implicitly unbinds all SRVs of the same resources */
+    stateMngr_->InvalidateBindings();
+}
+
 void D3D11CommandBuffer::ResetDeferredCommandList()
 {
     if (commandList_)
@@ -1477,6 +1619,35 @@ void D3D11CommandBuffer::ClearColorBuffers(
 Creates a buffer copy for the HLSL type ByteAddressBuffer.
 The format must be DXGI_FORMAT_R32_TYPELESS for raw-views.
 */
+bool D3D11CommandBuffer::DispatchPackedCopyShader(
+    bool                    copyTextureFromBuffer,
+    const TextureType       textureArrayType,
+    const FormatAttributes& formatAttribs,
+    const Extent3D&         extent,
+    std::uint32_t           rowStride,
+    std::uint32_t           layerStride)
+{
+    /* Specialized shaders access the buffer in DWORDs, so each row and layer must be 4-byte aligned */
+    if (rowStride % 4 != 0 || layerStride % 4 != 0)
+        return false;
+
+    D3D11BuiltinShader builtin;
+    if (!D3D11BuiltinShaderFactory::SelectPackedCopyShader(copyTextureFromBuffer, textureArrayType, formatAttribs, builtin))
+        return false;
+
+    if (!D3D11BuiltinShaderFactory::Get().HasBuiltinShader(builtin))
+        return false;
+
+    /* Each thread copies multiple consecutive texels of a row */
+    const std::uint32_t numThreadsX     = (extent.width + g_packedCopyTexelsPerThread - 1) / g_packedCopyTexelsPerThread;
+    const std::uint32_t numWorkGroupsX  = (numThreadsX + g_packedCopyNumThreads - 1) / g_packedCopyNumThreads;
+    const std::uint32_t numWorkGroupsZ  = (textureArrayType == TextureType::Texture1DArray ? 1u : extent.depth);
+
+    stateMngr_->DispatchBuiltin(builtin, numWorkGroupsX, extent.height, numWorkGroupsZ);
+
+    return true;
+}
+
 void D3D11CommandBuffer::CreateByteAddressBufferR32Typeless(
     ID3D11Device*               device,
     ID3D11DeviceContext*        context,
@@ -26,6 +26,8 @@ class D3D11Buffer;
 class D3D11StateManager;
 class D3D11RenderTarget;
 class D3D11SwapChain;
+class D3D11QueryHeap;
+struct FormatAttributes;
 class D3D11RenderPass;
 
 class D3D11CommandBuffer final : public CommandBuffer
@@ -126,6 +128,14 @@ class D3D11CommandBuffer final : public CommandBuffer
             const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined
         ) override;
 
+        void SetResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           descriptorSet,
+            std::uint32_t           numDynamicOffsets,
+            const std::uint32_t*    dynamicOffsets,
+            const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined
+        ) override;
+
         void SetResource(Resource& resource, std::uint32_t slot, long bindFlags, long stageFlags = StageFlags::AllStages) override;
 
         void ResetResourceSlots(
@@ -146,6 +156,7 @@ class D3D11CommandBuffer final : public CommandBuffer
         ) override;
 
         void EndRenderPass() override;
+        void NextSubpass() override;
 
         void Clear(long flags, const ClearValue& clearValue = {}) override;
         void ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments) override;
@@ -202,6 +213,9 @@ class D3D11CommandBuffer final : public CommandBuffer
         void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset) override;
         void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
 
+        void DrawIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride) override;
+        void DrawIndexedIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride) override;
+
         /* ----- Compute ----- */
 
         void Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ) override;
@@ -255,6 +269,9 @@ class D3D11CommandBuffer final : public CommandBuffer
         void ResetResourceSlotsUAV(std::uint32_t firstSlot, std::uint32_t numSlots, long stageFlags);
 
         void ResolveBoundRenderTarget();
+        // Calls OMSetRenderTargets with the subset of the current framebuffer view that is used by the specified sub-pass.
+        void BindSubpassFramebufferView(const D3D11RenderPass& renderPassD3D, std::uint32_t subpass);
+
         void BindRenderTarget(D3D11RenderTarget& renderTargetD3D);
         void BindSwapChain(D3D11SwapChain& swapChainD3D);
 
@@ -275,6 +292,22 @@ class D3D11CommandBuffer final : public CommandBuffer
 
         void ClearWithIntermediateUAV(ID3D11Buffer* buffer, UINT offset, UINT size, const UINT (&valuesVec4)[4]);
 
+        // Reads the number of draw commands back from the specified count buffer with the immediate context and clamps it to the specified maximum.
+        std::uint32_t ReadIndirectCount(Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands);
+
+        /*
+        Dispatches the format-specialized builtin copy shader between a texture and a ByteAddressBuffer if there is one for the specified format.
+        Returns false if the generic copy shader must be used instead.
+        */
+        bool DispatchPackedCopyShader(
+            bool                    copyTextureFromBuffer,
+            const TextureType       textureArrayType,
+            const FormatAttributes& formatAttribs,
+            const Extent3D&         extent,
+            std::uint32_t           rowStride,
+            std::uint32_t           layerStride
+        );
+
         // Creates a copy of this buffer as ByteAddressBuffer; 'size' must be a multiple of 4.
         void CreateByteAddressBufferR32Typeless(
             ID3D11Device*               device,
@@ -313,6 +346,7 @@ class D3D11CommandBuffer final : public CommandBuffer
 
         bool                                hasDeferredContext_     = false;
         bool                                isSecondaryCmdBuffer_   = false;
+        RenderTarget*                       inheritedRenderTarget_  = nullptr;
 
         #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
         ComPtr<ID3DUserDefinedAnnotation>   annotation_;
@@ -322,6 +356,11 @@ class D3D11CommandBuffer final : public CommandBuffer
 
         D3D11FramebufferView                framebufferView_;
         D3D11RenderTarget*                  boundRenderTarget_      = nullptr;
+        const D3D11RenderPass*              renderPass_             = nullptr; // Only set for render passes with explicit sub-passes
+        std::uint32_t                       subpass_                = 0;
+
+        // Timer query heaps whose disjoint query has been begun during the current recording
+        std::vector<D3D11QueryHeap*>        activeTimerQueryHeaps_;
 
 };
 
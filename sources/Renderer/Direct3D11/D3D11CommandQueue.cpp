@@ -9,6 +9,7 @@
 #include "D3D11CommandBuffer.h"
 #include "RenderState/D3D11Fence.h"
 #include "RenderState/D3D11QueryHeap.h"
+#include "RenderState/D3D11StateManager.h"
 #include "../CheckedCast.h"
 #include <LLGL/Misc/ForRange.h>
 
@@ -17,8 +18,9 @@ namespace LLGL
 {
 
 
-D3D11CommandQueue::D3D11CommandQueue(ID3D11Device* device, ComPtr<ID3D11DeviceContext>& context) :
-    context_           { context },
+D3D11CommandQueue::D3D11CommandQueue(ID3D11Device* device, ComPtr<ID3D11DeviceContext>& context, D3D11StateManager& stateMngr) :
+    context_           { context   },
+    stateMngr_         { stateMngr },
     intermediateFence_ { device  }
 {
 }
@@ -34,6 +36,9 @@ void D3D11CommandQueue::Submit(CommandBuffer& commandBuffer)
         {
             /* Execute encoded command list with immediate context but don't restore previous state */
             context_->ExecuteCommandList(commandList, FALSE);
+
+            /* Immediate context has been reset to its default state, so the state cache is out of date */
+            stateMngr_.ResetStateCache();
         }
     }
 }
@@ -101,16 +106,18 @@ bool D3D11CommandQueue::QueryResultSingleUInt64(
         /* Query result from special case query type: TimeElapsed */
         case D3D11_QUERY_TIMESTAMP_DISJOINT:
         {
+            /* Timer queries share the disjoint query that was active when they were begun */
+            const auto disjointQuery = queryHeapD3D.GetDisjointQuery(query);
             query *= queryHeapD3D.GetGroupSize();
 
             UINT64 startTime = 0;
-            if (context_->GetData(queryHeapD3D.GetNative(query + 1), &startTime, sizeof(startTime), 0) == S_OK)
+            if (context_->GetData(queryHeapD3D.GetNative(query), &startTime, sizeof(startTime), 0) == S_OK)
             {
                 UINT64 endTime = 0;
-                if (context_->GetData(queryHeapD3D.GetNative(query + 2), &endTime, sizeof(endTime), 0) == S_OK)
+                if (context_->GetData(queryHeapD3D.GetNative(query + 1), &endTime, sizeof(endTime), 0) == S_OK)
                 {
                     D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjointData;
-                    if (context_->GetData(queryHeapD3D.GetNative(query), &disjointData, sizeof(disjointData), 0) == S_OK)
+                    if (context_->GetData(disjointQuery, &disjointData, sizeof(disjointData), 0) == S_OK)
                     {
                         if (disjointData.Disjoint == FALSE)
                         {
@@ -21,13 +21,14 @@ namespace LLGL
 
 
 class D3D11QueryHeap;
+class D3D11StateManager;
 
 class D3D11CommandQueue final : public CommandQueue
 {
 
     public:
 
-        D3D11CommandQueue(ID3D11Device* device, ComPtr<ID3D11DeviceContext>& context);
+        D3D11CommandQueue(ID3D11Device* device, ComPtr<ID3D11DeviceContext>& context, D3D11StateManager& stateMngr);
 
         /* ----- Command Buffers ----- */
 
@@ -82,6 +83,7 @@ class D3D11CommandQueue final : public CommandQueue
     private:
 
         ComPtr<ID3D11DeviceContext> context_;
+        D3D11StateManager&          stateMngr_;
         D3D11Fence                  intermediateFence_;
 
 };
@@ -7,6 +7,7 @@
 
 #include "../ModuleInterface.h"
 #include "D3D11RenderSystem.h"
+#include "../DXCommon/DXCore.h"
 
 
 namespace LLGL
@@ -30,9 +31,16 @@ namespace ModuleDirect3D11
         return "Direct3D 11";
     }
 
-    RenderSystem* AllocRenderSystem(const LLGL::RenderSystemDescriptor* /*renderSystemDesc*/)
+    RenderSystem* AllocRenderSystem(const LLGL::RenderSystemDescriptor* renderSystemDesc)
     {
-        return new D3D11RenderSystem();
+        return new D3D11RenderSystem(*renderSystemDesc);
+    }
+
+    void QueryVideoAdapters(const LLGL::RenderSystemDescriptor* /*renderSystemDesc*/, std::vector<LLGL::VideoAdapterDescriptor>& outAdapters)
+    {
+        ComPtr<IDXGIFactory> factory;
+        if (SUCCEEDED(CreateDXGIFactory(IID_PPV_ARGS(&factory))))
+            DXQueryVideoAdapters(factory.Get(), outAdapters);
     }
 } // /namespace ModuleDirect3D11
 
@@ -69,6 +77,19 @@ LLGL_EXPORT void* LLGL_RenderSystem_Alloc(const void* renderSystemDesc, int rend
     return nullptr;
 }
 
+LLGL_EXPORT int LLGL_RenderSystem_QueryVideoAdapters(const void* renderSystemDesc, int renderSystemDescSize, void* outAdapters)
+{
+    if (renderSystemDesc != nullptr && static_cast<std::size_t>(renderSystemDescSize) == sizeof(LLGL::RenderSystemDescriptor) && outAdapters != nullptr)
+    {
+        auto desc       = reinterpret_cast<const LLGL::RenderSystemDescriptor*>(renderSystemDesc);
+        auto adapters   = reinterpret_cast<std::vector<LLGL::VideoAdapterDescriptor>*>(outAdapters);
+        const auto numAdapters = adapters->size();
+        LLGL::ModuleDirect3D11::QueryVideoAdapters(desc, *adapters);
+        return static_cast<int>(adapters->size() - numAdapters);
+    }
+    return 0;
+}
+
 } // /extern "C"
 
 #endif // /LLGL_BUILD_STATIC_LIB
@@ -16,6 +16,7 @@
 #include "../../Core/Vendor.h"
 #include "../../Core/Helper.h"
 #include "../../Core/Assertion.h"
+#include <LLGL/Timer.h>
 #include <sstream>
 #include <iomanip>
 #include <limits.h>
@@ -27,33 +28,42 @@
 #include "RenderState/D3D11GraphicsPSO.h"
 #include "RenderState/D3D11GraphicsPSO1.h"
 #include "RenderState/D3D11GraphicsPSO3.h"
+#include "RenderState/D3D11StatePool.h"
 #include "RenderState/D3D11ComputePSO.h"
+#include "../../Core/ProfilerZone.h"
 
 
 namespace LLGL
 {
 
 
-#if 0 //WIP
 /*
 Returns true if the D3D runtime supports command lists natively.
 Otherwise, they will be emulated by the D3D runtime.
 See https://docs.microsoft.com/en-us/windows/win32/api/d3d11_1/nf-d3d11_1-id3d11devicecontext1-vssetconstantbuffers1#remarks
 */
-static bool D3DSupportsDriverCommandLists(ID3D11Device* device, ID3D11DeviceContext* context)
+static bool D3DSupportsDriverCommandLists(ID3D11Device* device)
 {
     D3D11_FEATURE_DATA_THREADING threadingCaps = { FALSE, FALSE };
     HRESULT hr = device->CheckFeatureSupport(D3D11_FEATURE_THREADING, &threadingCaps, sizeof(threadingCaps));
     return (SUCCEEDED(hr) && threadingCaps.DriverCommandLists != FALSE);
 }
-#endif
 
-D3D11RenderSystem::D3D11RenderSystem()
+D3D11RenderSystem::D3D11RenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
+    shaderCache_ { renderSystemDesc.shaderCacheDirectory }
 {
     /* Create DXGU factory, query video adapters, and create D3D11 device */
+    const std::uint64_t startTick = Timer::Tick();
     CreateFactory();
     QueryVideoAdapters();
-    CreateDevice(nullptr);
+    const std::uint64_t factoryTick = Timer::Tick();
+
+    auto adapter = DXGetAdapterByIndex(factory_.Get(), renderSystemDesc.adapterIndex);
+    if (renderSystemDesc.adapterIndex >= 0)
+        videoAdapterIndex_ = static_cast<std::size_t>(renderSystemDesc.adapterIndex);
+
+    CreateDevice(adapter.Get());
+    const std::uint64_t deviceTick = Timer::Tick();
 
     /* Initialize states and renderer information */
     CreateStateManagerAndCommandQueue();
@@ -64,7 +74,9 @@ D3D11RenderSystem::D3D11RenderSystem()
     D3D11MipGenerator::Get().InitializeDevice(device_);
     D3D11BuiltinShaderFactory::Get().CreateBuiltinShaders(device_.Get());
 
-    //D3DSupportsDriverCommandLists(device_.Get(), context_.Get());
+    RecordStartupPhase("factory creation and adapter enumeration",  startTick,      factoryTick     );
+    RecordStartupPhase("device creation",                           factoryTick,    deviceTick      );
+    RecordStartupPhase("state manager and default resources",       deviceTick,     Timer::Tick()   );
 }
 
 D3D11RenderSystem::~D3D11RenderSystem()
@@ -72,16 +84,18 @@ D3D11RenderSystem::~D3D11RenderSystem()
     /* Release resource of singletons first */
     D3D11MipGenerator::Get().Clear();
     D3D11BuiltinShaderFactory::Get().Clear();
+    D3D11StatePool::Get().Clear();
 }
 
 /* ----- Swap-chain ----- */
 
 SwapChain* D3D11RenderSystem::CreateSwapChain(const SwapChainDescriptor& swapChainDesc, const std::shared_ptr<Surface>& surface)
 {
-    return TakeOwnership(
-        swapChains_,
-        MakeUnique<D3D11SwapChain>(factory_.Get(), device_, swapChainDesc, surface)
-    );
+    const std::uint64_t startTick = Timer::Tick();
+    auto swapChain = MakeUnique<D3D11SwapChain>(factory_.Get(), device_, swapChainDesc, surface);
+    RecordStartupPhase("swap-chain creation", startTick, Timer::Tick());
+
+    return TakeOwnership(swapChains_, std::move(swapChain));
 }
 
 void D3D11RenderSystem::Release(SwapChain& swapChain)
@@ -148,10 +162,10 @@ Buffer* D3D11RenderSystem::CreateBuffer(const BufferDescriptor& bufferDesc, cons
     return TakeOwnership(buffers_, MakeD3D11Buffer(device_.Get(), bufferDesc, initialData));
 }
 
-BufferArray* D3D11RenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray)
+BufferArray* D3D11RenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets)
 {
     AssertCreateBufferArray(numBuffers, bufferArray);
-    return TakeOwnership(bufferArrays_, MakeUnique<D3D11BufferArray>(numBuffers, bufferArray));
+    return TakeOwnership(bufferArrays_, MakeUnique<D3D11BufferArray>(numBuffers, bufferArray, offsets));
 }
 
 void D3D11RenderSystem::Release(Buffer& buffer)
@@ -223,8 +237,8 @@ void D3D11RenderSystem::WriteTexture(Texture& texture, const TextureRegion& text
     {
         case TextureType::Texture1D:
         case TextureType::Texture1DArray:
-            textureD3D.UpdateSubresource(
-                context_.Get(),
+            UpdateTextureSubresource(
+                textureD3D,
                 textureRegion.subresource.baseMipLevel,
                 textureRegion.subresource.baseArrayLayer,
                 CD3D11_BOX(
@@ -243,8 +257,8 @@ void D3D11RenderSystem::WriteTexture(Texture& texture, const TextureRegion& text
         case TextureType::TextureCube:
         case TextureType::Texture2DArray:
         case TextureType::TextureCubeArray:
-            textureD3D.UpdateSubresource(
-                context_.Get(),
+            UpdateTextureSubresource(
+                textureD3D,
                 textureRegion.subresource.baseMipLevel,
                 textureRegion.subresource.baseArrayLayer,
                 CD3D11_BOX(
@@ -264,8 +278,8 @@ void D3D11RenderSystem::WriteTexture(Texture& texture, const TextureRegion& text
             break;
 
         case TextureType::Texture3D:
-            textureD3D.UpdateSubresource(
-                context_.Get(),
+            UpdateTextureSubresource(
+                textureD3D,
                 textureRegion.subresource.baseMipLevel,
                 0,
                 CD3D11_BOX(
@@ -310,7 +324,7 @@ void D3D11RenderSystem::ReadTexture(Texture& texture, const TextureRegion& textu
 
 Sampler* D3D11RenderSystem::CreateSampler(const SamplerDescriptor& samplerDesc)
 {
-    return TakeOwnership(samplers_, MakeUnique<D3D11Sampler>(device_.Get(), samplerDesc));
+    return TakeOwnership(samplers_, MakeUnique<D3D11Sampler>(device_.Get(), samplerCache_, samplerDesc));
 }
 
 void D3D11RenderSystem::Release(Sampler& sampler)
@@ -365,7 +379,20 @@ void D3D11RenderSystem::Release(RenderTarget& renderTarget)
 Shader* D3D11RenderSystem::CreateShader(const ShaderDescriptor& shaderDesc)
 {
     AssertCreateShader(shaderDesc);
-    return TakeOwnership(shaders_, MakeUnique<D3D11Shader>(device_.Get(), shaderDesc));
+    return TakeOwnership(shaders_, MakeUnique<D3D11Shader>(device_.Get(), shaderDesc, &shaderCache_));
+}
+
+void D3D11RenderSystem::CreateShaders(std::uint32_t numShaders, const ShaderDescriptor* shaderDescs, Shader** outShaders)
+{
+    for (std::uint32_t i = 0; i < numShaders; ++i)
+        AssertCreateShader(shaderDescs[i]);
+
+    /* Compile all HLSL sources in parallel, then create the shader objects on this thread */
+    std::vector<DXShaderCompileResult> compileResults(numShaders);
+    DXCompileShaders(numShaders, shaderDescs, compileResults.data(), &shaderCache_);
+
+    for (std::uint32_t i = 0; i < numShaders; ++i)
+        outShaders[i] = TakeOwnership(shaders_, MakeUnique<D3D11Shader>(device_.Get(), shaderDescs[i], &shaderCache_, &compileResults[i]));
 }
 
 void D3D11RenderSystem::Release(Shader& shader)
@@ -394,6 +421,8 @@ PipelineState* D3D11RenderSystem::CreatePipelineState(const Blob& /*serializedCa
 
 PipelineState* D3D11RenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* /*serializedCache*/)
 {
+    LLGL_PROFILER_ZONE("D3D11RenderSystem::CreateGraphicsPipelineState");
+
     #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 3
     if (device3_)
     {
@@ -424,6 +453,8 @@ PipelineState* D3D11RenderSystem::CreatePipelineState(const GraphicsPipelineDesc
 
 PipelineState* D3D11RenderSystem::CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* /*serializedCache*/)
 {
+    LLGL_PROFILER_ZONE("D3D11RenderSystem::CreateComputePipelineState");
+
     return TakeOwnership(pipelineStates_, MakeUnique<D3D11ComputePSO>(pipelineStateDesc));
 }
 
@@ -499,15 +530,7 @@ void D3D11RenderSystem::CreateFactory()
 
 void D3D11RenderSystem::QueryVideoAdapters()
 {
-    /* Enumerate over all video adapters */
-    ComPtr<IDXGIAdapter> adapter;
-
-    for (UINT i = 0; factory_->EnumAdapters(i, &adapter) != DXGI_ERROR_NOT_FOUND; ++i)
-    {
-        /* Add adapter to the list and release handle */
-        videoAdatperDescs_.push_back(DXGetVideoAdapterDesc(adapter.Get()));
-        adapter.Reset();
-    }
+    DXQueryVideoAdapters(factory_.Get(), videoAdatperDescs_);
 }
 
 void D3D11RenderSystem::CreateDevice(IDXGIAdapter* adapter)
@@ -558,8 +581,13 @@ void D3D11RenderSystem::CreateDevice(IDXGIAdapter* adapter)
 
 bool D3D11RenderSystem::CreateDeviceWithFlags(IDXGIAdapter* adapter, const std::vector<D3D_FEATURE_LEVEL>& featureLevels, UINT flags, HRESULT& hr)
 {
-    for (D3D_DRIVER_TYPE driver : { D3D_DRIVER_TYPE_HARDWARE, D3D_DRIVER_TYPE_WARP, D3D_DRIVER_TYPE_SOFTWARE })
+    /* An explicit adapter requires the unknown driver type, otherwise try hardware before falling back to software drivers */
+    const D3D_DRIVER_TYPE driverTypes[] = { D3D_DRIVER_TYPE_HARDWARE, D3D_DRIVER_TYPE_WARP, D3D_DRIVER_TYPE_SOFTWARE };
+    const std::size_t numDriverTypes = (adapter != nullptr ? 1 : sizeof(driverTypes)/sizeof(driverTypes[0]));
+
+    for (std::size_t i = 0; i < numDriverTypes; ++i)
     {
+        const D3D_DRIVER_TYPE driver = (adapter != nullptr ? D3D_DRIVER_TYPE_UNKNOWN : driverTypes[i]);
         hr = D3D11CreateDevice(
             adapter,                                    // Video adapter
             driver,                                     // Driver type
@@ -581,7 +609,7 @@ bool D3D11RenderSystem::CreateDeviceWithFlags(IDXGIAdapter* adapter, const std::
 void D3D11RenderSystem::CreateStateManagerAndCommandQueue()
 {
     stateMngr_ = std::make_shared<D3D11StateManager>(device_.Get(), context_);
-    commandQueue_ = MakeUnique<D3D11CommandQueue>(device_.Get(), context_);
+    commandQueue_ = MakeUnique<D3D11CommandQueue>(device_.Get(), context_, *stateMngr_);
 }
 
 void D3D11RenderSystem::QueryRendererInfo()
@@ -610,9 +638,9 @@ void D3D11RenderSystem::QueryRendererInfo()
     info.shadingLanguageName = "HLSL " + std::string(DXFeatureLevelToShaderModel(GetFeatureLevel()));
 
     /* Initialize video adapter strings */
-    if (!videoAdatperDescs_.empty())
+    if (videoAdapterIndex_ < videoAdatperDescs_.size())
     {
-        const auto& videoAdapterDesc = videoAdatperDescs_.front();
+        const auto& videoAdapterDesc = videoAdatperDescs_[videoAdapterIndex_];
         info.deviceName = ToUTF8String(videoAdapterDesc.name);
         info.vendorName = videoAdapterDesc.vendor;
     }
@@ -634,6 +662,7 @@ void D3D11RenderSystem::QueryRenderingCaps()
 
         caps.features.hasDirectResourceBinding      = true;
         caps.features.hasConservativeRasterization  = (minorVersion >= 3);
+        caps.features.hasNativeCommandLists         = D3DSupportsDriverCommandLists(device_.Get());
 
         caps.limits.maxViewports                    = D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE;
         caps.limits.maxViewportSize[0]              = D3D11_VIEWPORT_BOUNDS_MAX;
@@ -713,8 +742,8 @@ void D3D11RenderSystem::InitializeGpuTextureWithImage(
     for_range(layer, arrayLayers)
     {
         /* Update subresource of current array layer */
-        textureD3D.UpdateSubresource(
-            context_.Get(),
+        UpdateTextureSubresource(
+            textureD3D,
             0, // mipLevel
             layer,
             CD3D11_BOX(0, 0, 0, extent.width, extent.height, extent.depth),
@@ -773,6 +802,237 @@ void D3D11RenderSystem::InitializeGpuTextureWithClearValue(
     }
 }
 
+// Minimum number of texels to convert source images on the GPU; smaller images are converted faster on the CPU than it takes to create the intermediate resources.
+static const std::uint32_t g_minConvertShaderTexels = 256 * 256;
+
+// Constant buffer layout of ConvertTextureFromBuffer.hlsl
+struct ConvertTextureBufferCbuffer
+{
+    std::uint32_t texOffset[3];
+    std::uint32_t bufOffset;        // Source buffer offset: multiple of 4
+    std::uint32_t texExtent[3];
+    std::uint32_t rowStride;        // Source row stride: multiple of 4
+    std::uint32_t layerStride;      // Source layer stride: multiple of 4
+    std::uint32_t pad0[3];          // Padding to fill up current 16-byte register
+    std::uint32_t pad1[13 * 4];     // Padding to fill up constant buffer range of 256 bytes
+};
+
+void D3D11RenderSystem::UpdateTextureSubresource(
+    D3D11Texture&               textureD3D,
+    UINT                        mipLevel,
+    UINT                        arrayLayer,
+    const D3D11_BOX&            region,
+    const SrcImageDescriptor&   imageDesc)
+{
+    /* Expand source image with a builtin compute shader if possible, otherwise convert image on the CPU via D3D11Texture::UpdateSubresource */
+    if (!UpdateTextureSubresourceWithConvertShader(textureD3D, mipLevel, arrayLayer, region, imageDesc))
+        textureD3D.UpdateSubresource(context_.Get(), mipLevel, arrayLayer, region, imageDesc);
+}
+
+/*
+Uploads the source image as is into an intermediate ByteAddressBuffer and expands it into the destination texture with a builtin compute shader.
+This is only supported for 8-bit RGB, BGR, and BGRA images, which have no native RGBA8 texture format in D3D11,
+so large texture uploads are no longer bound by the CPU conversion in ConvertImageBuffer.
+*/
+bool D3D11RenderSystem::UpdateTextureSubresourceWithConvertShader(
+    D3D11Texture&               textureD3D,
+    UINT                        mipLevel,
+    UINT                        arrayLayer,
+    const D3D11_BOX&            region,
+    const SrcImageDescriptor&   imageDesc)
+{
+    const Extent3D extent
+    {
+        region.right - region.left,
+        region.bottom - region.top,
+        region.back - region.front
+    };
+
+    if (imageDesc.data == nullptr || extent.width * extent.height * extent.depth < g_minConvertShaderTexels)
+        return false;
+
+    /* Conversion shaders write a single subresource of a 2D or 3D texture; cube textures are excluded, since their intermediate textures would require 6 layers */
+    TextureType textureArrayType;
+    switch (textureD3D.GetType())
+    {
+        case TextureType::Texture2D:
+        case TextureType::Texture2DArray:
+            if (extent.depth != 1)
+                return false;
+            textureArrayType = TextureType::Texture2DArray;
+            break;
+        case TextureType::Texture3D:
+            textureArrayType = TextureType::Texture3D;
+            break;
+        default:
+            return false;
+    }
+
+    /* Select conversion shader for the source image and destination texture format */
+    const auto& formatAttribs = GetFormatAttribs(textureD3D.GetBaseFormat());
+
+    D3D11BuiltinShader builtin;
+    if (!D3D11BuiltinShaderFactory::SelectConvertShader(textureArrayType, imageDesc.format, imageDesc.dataType, formatAttribs, builtin))
+        return false;
+
+    /* Conversion shaders access the source buffer in DWORDs, so each row and layer must be 4-byte aligned */
+    const std::uint32_t rowStride   = (imageDesc.rowStride   > 0 ? imageDesc.rowStride   : extent.width * static_cast<std::uint32_t>(ImageFormatSize(imageDesc.format)));
+    const std::uint32_t layerStride = (imageDesc.layerStride > 0 ? imageDesc.layerStride : extent.height * rowStride);
+    const std::uint32_t dataSize    = layerStride * extent.depth;
+
+    if (rowStride % 4 != 0 || layerStride % 4 != 0 || imageDesc.dataSize < dataSize)
+        return false;
+
+    if (!D3D11BuiltinShaderFactory::Get().HasBuiltinShader(builtin))
+        return false;
+
+    /* Upload source image into intermediate byte-addressable buffer with SRV (ByteAddressBuffer) */
+    ComPtr<ID3D11Buffer> intermediateBuffer;
+    ComPtr<ID3D11ShaderResourceView> intermediateSRV;
+
+    D3D11_BUFFER_DESC bufferDesc;
+    {
+        bufferDesc.ByteWidth            = dataSize;
+        bufferDesc.Usage                = D3D11_USAGE_IMMUTABLE;
+        bufferDesc.BindFlags            = D3D11_BIND_SHADER_RESOURCE;
+        bufferDesc.CPUAccessFlags       = 0;
+        bufferDesc.MiscFlags            = D3D11_RESOURCE_MISC_BUFFER_ALLOW_RAW_VIEWS;
+        bufferDesc.StructureByteStride  = 0;
+    }
+    D3D11_SUBRESOURCE_DATA initialData;
+    {
+        initialData.pSysMem             = imageDesc.data;
+        initialData.SysMemPitch         = 0;
+        initialData.SysMemSlicePitch    = 0;
+    }
+    auto hr = device_->CreateBuffer(&bufferDesc, &initialData, intermediateBuffer.GetAddressOf());
+    DXThrowIfCreateFailed(hr, "ID3D11Buffer", "for texture format conversion");
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc;
+    {
+        srvDesc.Format                  = DXGI_FORMAT_R32_TYPELESS;
+        srvDesc.ViewDimension           = D3D11_SRV_DIMENSION_BUFFEREX;
+        srvDesc.BufferEx.FirstElement   = 0;
+        srvDesc.BufferEx.NumElements    = dataSize / 4;
+        srvDesc.BufferEx.Flags          = D3D11_BUFFEREX_SRV_FLAG_RAW;
+    }
+    hr = device_->CreateShaderResourceView(intermediateBuffer.Get(), &srvDesc, intermediateSRV.GetAddressOf());
+    DXThrowIfCreateFailed(hr, "ID3D11ShaderResourceView", "for texture format conversion");
+
+    /* An intermediate texture copy is required if the destination texture's format is not unsigned integer or it is normalized */
+    const bool useIntermediateTexture =
+    (
+        (formatAttribs.flags & FormatFlags::IsUnsignedInteger) != FormatFlags::IsUnsignedInteger ||
+        (formatAttribs.flags & FormatFlags::IsNormalized) != 0
+    );
+
+    D3D11NativeTexture intermediateTexture;
+    ComPtr<ID3D11UnorderedAccessView> intermediateUAV;
+
+    if (useIntermediateTexture)
+    {
+        /* Create an intermediate copy of the destination subresource with unsigned integer format */
+        TextureRegion intermediateRegion;
+        {
+            intermediateRegion.subresource  = TextureSubresource{ arrayLayer, 1, mipLevel, 1 };
+            intermediateRegion.extent       = extent;
+        }
+        textureD3D.CreateSubresourceCopyWithUIntFormat(
+            device_.Get(),
+            intermediateTexture,
+            nullptr,
+            intermediateUAV.GetAddressOf(),
+            intermediateRegion,
+            textureArrayType
+        );
+    }
+    else
+    {
+        /* Create intermediate UAV directly from destination texture if the texture already has an unsigned integer format */
+        textureD3D.CreateSubresourceUAV(
+            device_.Get(),
+            intermediateUAV.GetAddressOf(),
+            textureArrayType,
+            textureD3D.GetBaseDXFormat(),
+            mipLevel,
+            arrayLayer,
+            1
+        );
+    }
+
+    /* Set shader parameters with intermediate constant buffer */
+    ConvertTextureBufferCbuffer cbufferData;
+    {
+        if (useIntermediateTexture)
+        {
+            cbufferData.texOffset[0]    = 0;
+            cbufferData.texOffset[1]    = 0;
+            cbufferData.texOffset[2]    = 0;
+        }
+        else
+        {
+            cbufferData.texOffset[0]    = region.left;
+            cbufferData.texOffset[1]    = region.top;
+            cbufferData.texOffset[2]    = (textureArrayType == TextureType::Texture3D ? region.front : 0);
+        }
+        cbufferData.bufOffset           = 0;
+        cbufferData.texExtent[0]        = extent.width;
+        cbufferData.texExtent[1]        = extent.height;
+        cbufferData.texExtent[2]        = extent.depth;
+        cbufferData.rowStride           = rowStride;
+        cbufferData.layerStride         = layerStride;
+    }
+    stateMngr_->SetConstants(0, &cbufferData, sizeof(cbufferData), StageFlags::ComputeStage);
+
+    /* Store currently bound resource views */
+    ID3D11UnorderedAccessView* prevUAVs[1];
+    ID3D11ShaderResourceView* prevSRVs[1];
+
+    context_->CSGetUnorderedAccessViews(0, 1, prevUAVs);
+    context_->CSGetShaderResources(0, 1, prevSRVs);
+
+    /* Bind destination texture and source buffer resources */
+    ID3D11UnorderedAccessView* intermediateUAVs[1] = { intermediateUAV.Get() };
+    ID3D11ShaderResourceView* intermediateSRVs[1] = { intermediateSRV.Get() };
+
+    context_->CSSetUnorderedAccessViews(0, 1, intermediateUAVs, nullptr);
+    context_->CSSetShaderResources(0, 1, intermediateSRVs);
+
+    /* Dispatch compute kernels; conversion shaders have the same thread layout as the format-specialized copy shaders */
+    const std::uint32_t numThreadsX     = (extent.width + g_packedCopyTexelsPerThread - 1) / g_packedCopyTexelsPerThread;
+    const std::uint32_t numWorkGroupsX  = (numThreadsX + g_packedCopyNumThreads - 1) / g_packedCopyNumThreads;
+
+    stateMngr_->DispatchBuiltin(builtin, numWorkGroupsX, extent.height, extent.depth);
+
+    /* Restore previous resource views; CSGet* functions have added a reference to each view */
+    context_->CSSetUnorderedAccessViews(0, 1, prevUAVs, nullptr);
+    context_->CSSetShaderResources(0, 1, prevSRVs);
+    stateMngr_->InvalidateBindings();
+
+    if (prevUAVs[0] != nullptr)
+        prevUAVs[0]->Release();
+    if (prevSRVs[0] != nullptr)
+        prevSRVs[0]->Release();
+
+    /* Copy UAV content into destination texture, if an intermediate texture was used */
+    if (useIntermediateTexture)
+    {
+        const D3D11_BOX srcBox = { 0, 0, 0, extent.width, extent.height, extent.depth };
+        context_->CopySubresourceRegion(
+            textureD3D.GetNative().resource.Get(),                           // pDstResource
+            textureD3D.CalcSubresource(mipLevel, arrayLayer),                // DstSubresource
+            region.left,                                                     // DstX
+            region.top,                                                      // DstY
+            (textureArrayType == TextureType::Texture3D ? region.front : 0), // DstZ
+            intermediateTexture.resource.Get(),                              // pSrcResource
+            0,                                                               // SrcSubresource
+            &srcBox                                                          // pSrcBox
+        );
+    }
+
+    return true;
+}
+
 
 } // /namespace LLGL
 
@@ -35,6 +35,7 @@
 
 #include "../ContainerTypes.h"
 #include "../DXCommon/ComPtr.h"
+#include "../DXCommon/DXShaderCache.h"
 
 #include <dxgi.h>
 #include "Direct3D11.h"
@@ -51,7 +52,7 @@ class D3D11RenderSystem final : public RenderSystem
 
         /* ----- Common ----- */
 
-        D3D11RenderSystem();
+        D3D11RenderSystem(const RenderSystemDescriptor& renderSystemDesc);
         ~D3D11RenderSystem();
 
         /* ----- Swap-chain ------ */
@@ -73,7 +74,7 @@ class D3D11RenderSystem final : public RenderSystem
         /* ----- Buffers ------ */
 
         Buffer* CreateBuffer(const BufferDescriptor& bufferDesc, const void* initialData = nullptr) override;
-        BufferArray* CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray) override;
+        BufferArray* CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets = nullptr) override;
 
         void Release(Buffer& buffer) override;
         void Release(BufferArray& bufferArray) override;
@@ -123,6 +124,7 @@ class D3D11RenderSystem final : public RenderSystem
         /* ----- Shader ----- */
 
         Shader* CreateShader(const ShaderDescriptor& shaderDesc) override;
+        void CreateShaders(std::uint32_t numShaders, const ShaderDescriptor* shaderDescs, Shader** outShaders) override;
 
         void Release(Shader& shader) override;
 
@@ -210,6 +212,24 @@ class D3D11RenderSystem final : public RenderSystem
             const ClearValue&   clearValue
         );
 
+        // Updates the specified texture subresource and converts the source image with a builtin compute shader if possible, or on the CPU otherwise.
+        void UpdateTextureSubresource(
+            D3D11Texture&               textureD3D,
+            UINT                        mipLevel,
+            UINT                        arrayLayer,
+            const D3D11_BOX&            region,
+            const SrcImageDescriptor&   imageDesc
+        );
+
+        // Converts the source image into the specified texture subresource with a builtin compute shader. Returns false if the image must be converted on the CPU.
+        bool UpdateTextureSubresourceWithConvertShader(
+            D3D11Texture&               textureD3D,
+            UINT                        mipLevel,
+            UINT                        arrayLayer,
+            const D3D11_BOX&            region,
+            const SrcImageDescriptor&   imageDesc
+        );
+
     private:
 
         /* ----- Common objects ----- */
@@ -236,6 +256,9 @@ class D3D11RenderSystem final : public RenderSystem
 
         std::shared_ptr<D3D11StateManager>      stateMngr_;
 
+        D3D11SamplerCache                       samplerCache_;                          // Must be declared before the samplers, since they release their native objects here
+        DXShaderCache                           shaderCache_;                           // Optional on-disk cache of compiled HLSL bytecode
+
         /* ----- Hardware object containers ----- */
 
         HWObjectContainer<D3D11SwapChain>       swapChains_;
@@ -257,6 +280,7 @@ class D3D11RenderSystem final : public RenderSystem
         /* ----- Other members ----- */
 
         std::vector<VideoAdapterDescriptor>     videoAdatperDescs_;
+        std::size_t                             videoAdapterIndex_  = 0; // Index into 'videoAdatperDescs_' of the adapter the device was created on
 
 };
 
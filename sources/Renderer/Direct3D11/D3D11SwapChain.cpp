@@ -8,10 +8,13 @@
 #include "D3D11SwapChain.h"
 #include "D3D11RenderSystem.h"
 #include "D3D11ObjectUtils.h"
+#include "../DXCommon/DXCore.h"
 #include "../DXCommon/DXTypes.h"
 #include "../../Core/Helper.h"
 #include <LLGL/Platform/NativeHandle.h>
 #include <LLGL/Log.h>
+#include <LLGL/PipelineStateFlags.h>
+#include <algorithm>
 
 
 namespace LLGL
@@ -26,16 +29,26 @@ D3D11SwapChain::D3D11SwapChain(
 :
     SwapChain           { desc                                                       },
     device_             { device                                                     },
-    depthStencilFormat_ { DXPickDepthStencilFormat(desc.depthBits, desc.stencilBits) }
+    depthStencilFormat_ { DXPickDepthStencilFormat(desc.depthBits, desc.stencilBits) },
+    presentMode_        { desc.presentMode                                           }
 {
+    /* Get immediate context to resolve multi-sampled back buffers */
+    device_->GetImmediateContext(context_.GetAddressOf());
+
     /* Setup surface for the swap-chain */
     SetOrCreateSurface(surface, desc.resolution, desc.fullscreen, nullptr);
 
     /* Create D3D objects */
-    CreateSwapChain(factory, desc.resolution, desc.samples, desc.swapBuffers);
+    CreateSwapChain(factory, desc);
     CreateBackBuffer();
 }
 
+D3D11SwapChain::~D3D11SwapChain()
+{
+    if (frameLatencyObject_ != nullptr)
+        CloseHandle(frameLatencyObject_);
+}
+
 void D3D11SwapChain::SetName(const char* name)
 {
     if (name != nullptr)
@@ -43,6 +56,8 @@ void D3D11SwapChain::SetName(const char* name)
         /* Set label for each back-buffer object */
         D3D11SetObjectName(colorBuffer_.Get(), name);
         D3D11SetObjectNameSubscript(renderTargetView_.Get(), name, ".RTV");
+        if (colorBufferMS_)
+            D3D11SetObjectNameSubscript(colorBufferMS_.Get(), name, ".MS");
         if (depthBuffer_)
         {
             D3D11SetObjectNameSubscript(depthBuffer_.Get(), name, ".DS");
@@ -54,6 +69,8 @@ void D3D11SwapChain::SetName(const char* name)
         /* Reset all back-buffer labels */
         D3D11SetObjectName(colorBuffer_.Get(), nullptr);
         D3D11SetObjectName(renderTargetView_.Get(), nullptr);
+        if (colorBufferMS_)
+            D3D11SetObjectName(colorBufferMS_.Get(), nullptr);
         if (depthBuffer_)
         {
             D3D11SetObjectName(depthBuffer_.Get(), nullptr);
@@ -64,7 +81,88 @@ void D3D11SwapChain::SetName(const char* name)
 
 void D3D11SwapChain::Present()
 {
-    swapChain_->Present(swapChainInterval_, 0);
+    /* Resolve multi-sampled color buffer into back buffer of flip-model swap-chain */
+    if (colorBufferMS_)
+        context_->ResolveSubresource(colorBuffer_.Get(), 0, colorBufferMS_.Get(), 0, colorFormat_);
+
+    UINT syncInterval = 0, flags = 0;
+    GetPresentParameters(syncInterval, flags);
+
+    #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+    if (swapChain1_ && !dirtyRects_.empty())
+    {
+        /* Only present the damage regions if they have been set for this frame (see SetDamageRegions) */
+        DXGI_PRESENT_PARAMETERS presentParams;
+        {
+            presentParams.DirtyRectsCount   = static_cast<UINT>(dirtyRects_.size());
+            presentParams.pDirtyRects       = dirtyRects_.data();
+            presentParams.pScrollRect       = nullptr;
+            presentParams.pScrollOffset     = nullptr;
+        }
+        swapChain1_->Present1(syncInterval, flags, &presentParams);
+    }
+    else
+    #endif // /LLGL_D3D11_ENABLE_FEATURELEVEL
+    {
+        swapChain_->Present(syncInterval, flags);
+    }
+
+    dirtyRects_.clear();
+    presentCount_ = std::min(presentCount_ + 1, swapChainBufferCount_);
+}
+
+bool D3D11SwapChain::SetDamageRegions(std::uint32_t numRegions, const Scissor* regions)
+{
+    #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+    if (!swapChain1_)
+        return false;
+
+    /* Clamp damage regions to the back buffer, since IDXGISwapChain1::Present1 fails for dirty rectangles outside of it */
+    const Extent2D resolution = GetResolution();
+    dirtyRects_.clear();
+    dirtyRects_.reserve(numRegions);
+    for (std::uint32_t i = 0; i < numRegions; ++i)
+    {
+        RECT rect;
+        {
+            rect.left   = Clamp<LONG>(regions[i].x, 0, static_cast<LONG>(resolution.width));
+            rect.top    = Clamp<LONG>(regions[i].y, 0, static_cast<LONG>(resolution.height));
+            rect.right  = Clamp<LONG>(regions[i].x + regions[i].width, rect.left, static_cast<LONG>(resolution.width));
+            rect.bottom = Clamp<LONG>(regions[i].y + regions[i].height, rect.top, static_cast<LONG>(resolution.height));
+        }
+        if (rect.right > rect.left && rect.bottom > rect.top)
+            dirtyRects_.push_back(rect);
+    }
+
+    return true;
+    #else
+    return false;
+    #endif // /LLGL_D3D11_ENABLE_FEATURELEVEL
+}
+
+std::uint32_t D3D11SwapChain::QueryBufferAge()
+{
+    /* The multi-sampled color buffer is never swapped, so it always holds the content of the previous frame */
+    if (colorBufferMS_)
+        return (presentCount_ > 0 ? 1 : 0);
+
+    /* With the flip-sequential model, the current back buffer holds the frame that was presented 'BufferCount' frames ago */
+    if (isFlipSequential_ && presentCount_ >= swapChainBufferCount_)
+        return swapChainBufferCount_;
+
+    return 0;
+}
+
+void D3D11SwapChain::WaitForNextFrame()
+{
+    /* Block until the swap-chain has less than the maximum number of frames queued up (with a timeout of 1 second) */
+    if (frameLatencyObject_ != nullptr)
+        WaitForSingleObjectEx(frameLatencyObject_, 1000, TRUE);
+}
+
+bool D3D11SwapChain::QueryPresentStatistics(PresentStatistics& outStats)
+{
+    return DXGetPresentStatistics(swapChain_.Get(), outStats);
 }
 
 std::uint32_t D3D11SwapChain::GetSamples() const
@@ -124,6 +222,34 @@ bool D3D11SwapChain::SetPresentSyncInterval(UINT syncInterval)
     return false;
 }
 
+void D3D11SwapChain::GetPresentParameters(UINT& outSyncInterval, UINT& outFlags) const
+{
+    switch (presentMode_)
+    {
+        case PresentMode::Fifo:
+            outSyncInterval = std::max(1u, swapChainInterval_);
+            outFlags        = 0;
+            break;
+        case PresentMode::Mailbox:
+            /* Flip-model swap-chains replace the queued frame when presented with a sync interval of 0 and without tearing */
+            outSyncInterval = 0;
+            outFlags        = 0;
+            break;
+        case PresentMode::Immediate:
+            outSyncInterval = 0;
+            #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 3
+            outFlags        = ((swapChainFlags_ & DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING) != 0 ? DXGI_PRESENT_ALLOW_TEARING : 0);
+            #else
+            outFlags        = 0;
+            #endif
+            break;
+        default:
+            outSyncInterval = swapChainInterval_;
+            outFlags        = 0;
+            break;
+    }
+}
+
 static UINT GetPrimaryDisplayRefreshRate()
 {
     if (auto display = Display::GetPrimary())
@@ -132,7 +258,7 @@ static UINT GetPrimaryDisplayRefreshRate()
         return 60; // Assume most common refresh rate
 }
 
-void D3D11SwapChain::CreateSwapChain(IDXGIFactory* factory, const Extent2D& resolution, std::uint32_t samples, std::uint32_t swapBuffers)
+void D3D11SwapChain::CreateSwapChain(IDXGIFactory* factory, const SwapChainDescriptor& desc)
 {
     /* Get current settings */
     const DXGI_RATIONAL refreshRate{ GetPrimaryDisplayRefreshRate(), 1 };
@@ -141,7 +267,7 @@ void D3D11SwapChain::CreateSwapChain(IDXGIFactory* factory, const Extent2D& reso
     colorFormat_ = DXGI_FORMAT_R8G8B8A8_UNORM;//DXGI_FORMAT_B8G8R8A8_UNORM
 
     /* Find suitable multi-samples for color format */
-    swapChainSampleDesc_ = D3D11RenderSystem::FindSuitableSampleDesc(device_.Get(), colorFormat_, samples);
+    swapChainSampleDesc_ = D3D11RenderSystem::FindSuitableSampleDesc(device_.Get(), colorFormat_, desc.samples);
 
     /* Create swap chain for window handle */
     NativeHandle wndHandle = {};
@@ -150,19 +276,114 @@ void D3D11SwapChain::CreateSwapChain(IDXGIFactory* factory, const Extent2D& reso
     DXGI_SWAP_CHAIN_DESC swapChainDesc;
     InitMemory(swapChainDesc);
     {
-        swapChainDesc.BufferDesc.Width          = resolution.width;
-        swapChainDesc.BufferDesc.Height         = resolution.height;
+        swapChainDesc.BufferDesc.Width          = desc.resolution.width;
+        swapChainDesc.BufferDesc.Height         = desc.resolution.height;
         swapChainDesc.BufferDesc.Format         = colorFormat_;
         swapChainDesc.BufferDesc.RefreshRate    = refreshRate;
         swapChainDesc.SampleDesc                = swapChainSampleDesc_;
         swapChainDesc.BufferUsage               = DXGI_USAGE_RENDER_TARGET_OUTPUT;
-        swapChainDesc.BufferCount               = (swapBuffers >= 3 ? 2 : 1);
+        swapChainDesc.BufferCount               = (desc.swapBuffers >= 3 ? 2 : 1);
         swapChainDesc.OutputWindow              = wndHandle.window;
         swapChainDesc.Windowed                  = TRUE;//(fullscreen ? FALSE : TRUE);
         swapChainDesc.SwapEffect                = DXGI_SWAP_EFFECT_DISCARD;
     }
+
+    /* Prefer flip-model swap-chain, which avoids the extra copy through the desktop window manager */
+    if (CreateFlipModelSwapChain(factory, swapChainDesc, desc))
+        return;
+
+    /* Fall back to bit-block transfer swap-chain (required prior to Windows 8) */
     auto hr = factory->CreateSwapChain(device_.Get(), &swapChainDesc, swapChain_.ReleaseAndGetAddressOf());
     DXThrowIfFailed(hr, "failed to create DXGI swap chain");
+
+    /* Without a waitable object, the frame latency can only be limited for the entire device, which blocks inside IDXGISwapChain::Present */
+    if (desc.maxFrameLatency > 0)
+        SetMaximumFrameLatency(desc.maxFrameLatency);
+}
+
+#if LLGL_D3D11_ENABLE_FEATURELEVEL >= 3
+
+static bool IsTearingSupported(IDXGIFactory* factory)
+{
+    /* Tearing support requires DXGI 1.5 */
+    ComPtr<IDXGIFactory5> factory5;
+    if (SUCCEEDED(factory->QueryInterface(IID_PPV_ARGS(&factory5))))
+    {
+        BOOL allowTearing = FALSE;
+        auto hr = factory5->CheckFeatureSupport(DXGI_FEATURE_PRESENT_ALLOW_TEARING, &allowTearing, sizeof(allowTearing));
+        return (SUCCEEDED(hr) && allowTearing != FALSE);
+    }
+    return false;
+}
+
+#endif // /LLGL_D3D11_ENABLE_FEATURELEVEL
+
+bool D3D11SwapChain::CreateFlipModelSwapChain(IDXGIFactory* factory, DXGI_SWAP_CHAIN_DESC swapChainDesc, const SwapChainDescriptor& desc)
+{
+    /* Select swap-chain flags for frame latency and presentation mode; these flags must be the same for IDXGISwapChain::ResizeBuffers */
+    UINT flags = 0;
+
+    #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 2
+    if (desc.maxFrameLatency > 0)
+        flags |= DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+    #endif
+
+    #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 3
+    if (desc.presentMode == PresentMode::Immediate && IsTearingSupported(factory))
+        flags |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
+    #endif
+
+    /* Flip-model swap-chains cannot be multi-sampled, so they are resolved from a separate color buffer (see CreateBackBuffer) */
+    swapChainDesc.SampleDesc    = { 1, 0 };
+    swapChainDesc.BufferCount   = std::max(2u, std::min(desc.swapBuffers, 3u));
+    swapChainDesc.Flags         = flags;
+
+    /* Try flip-discard model first (requires Windows 10), then flip-sequential model (requires Windows 8) */
+    const DXGI_SWAP_EFFECT swapEffects[] = { DXGI_SWAP_EFFECT_FLIP_DISCARD, DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL };
+    for (DXGI_SWAP_EFFECT swapEffect : swapEffects)
+    {
+        swapChainDesc.SwapEffect = swapEffect;
+        auto hr = factory->CreateSwapChain(device_.Get(), &swapChainDesc, swapChain_.ReleaseAndGetAddressOf());
+        if (SUCCEEDED(hr))
+        {
+            swapChainFlags_         = flags;
+            isFlipModel_            = true;
+            isFlipSequential_       = (swapEffect == DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL);
+            swapChainBufferCount_   = swapChainDesc.BufferCount;
+
+            #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+            swapChain_.As(&swapChain1_);
+            #endif
+
+            #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 2
+            /* Limit the number of queued frames and get waitable object for SwapChain::WaitForNextFrame */
+            if ((flags & DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT) != 0)
+            {
+                ComPtr<IDXGISwapChain2> swapChain2;
+                if (SUCCEEDED(swapChain_.As(&swapChain2)))
+                {
+                    swapChain2->SetMaximumFrameLatency(desc.maxFrameLatency);
+                    frameLatencyObject_ = swapChain2->GetFrameLatencyWaitableObject();
+                    return true;
+                }
+            }
+            #endif // /LLGL_D3D11_ENABLE_FEATURELEVEL
+
+            if (desc.maxFrameLatency > 0)
+                SetMaximumFrameLatency(desc.maxFrameLatency);
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void D3D11SwapChain::SetMaximumFrameLatency(UINT maxFrameLatency)
+{
+    ComPtr<IDXGIDevice1> deviceDXGI;
+    if (SUCCEEDED(device_.As(&deviceDXGI)))
+        deviceDXGI->SetMaximumFrameLatency(maxFrameLatency);
 }
 
 void D3D11SwapChain::CreateBackBuffer()
@@ -173,14 +394,35 @@ void D3D11SwapChain::CreateBackBuffer()
     hr = swapChain_->GetBuffer(0, IID_PPV_ARGS(colorBuffer_.ReleaseAndGetAddressOf()));
     DXThrowIfFailed(hr, "failed to get D3D11 back buffer from swap chain");
 
-    /* Create back buffer RTV */
-    hr = device_->CreateRenderTargetView(colorBuffer_.Get(), nullptr, renderTargetView_.ReleaseAndGetAddressOf());
-    DXThrowIfFailed(hr, "failed to create D3D11 render-target-view (RTV) for back buffer");
-
     /* Retrieve back-buffer dimension */
     D3D11_TEXTURE2D_DESC colorBufferDesc;
     colorBuffer_->GetDesc(&colorBufferDesc);
 
+    if (isFlipModel_ && swapChainSampleDesc_.Count > 1)
+    {
+        /* Create multi-sampled color buffer, since flip-model swap-chains cannot be multi-sampled */
+        D3D11_TEXTURE2D_DESC texDesc = colorBufferDesc;
+        {
+            texDesc.SampleDesc      = swapChainSampleDesc_;
+            texDesc.Usage           = D3D11_USAGE_DEFAULT;
+            texDesc.BindFlags       = D3D11_BIND_RENDER_TARGET;
+            texDesc.CPUAccessFlags  = 0;
+            texDesc.MiscFlags       = 0;
+        }
+        hr = device_->CreateTexture2D(&texDesc, nullptr, colorBufferMS_.ReleaseAndGetAddressOf());
+        DXThrowIfFailed(hr, "failed to create D3D11 multi-sampled color buffer for swap-chain");
+
+        /* Create RTV for multi-sampled color buffer */
+        hr = device_->CreateRenderTargetView(colorBufferMS_.Get(), nullptr, renderTargetView_.ReleaseAndGetAddressOf());
+        DXThrowIfFailed(hr, "failed to create D3D11 render-target-view (RTV) for multi-sampled color buffer");
+    }
+    else
+    {
+        /* Create back buffer RTV */
+        hr = device_->CreateRenderTargetView(colorBuffer_.Get(), nullptr, renderTargetView_.ReleaseAndGetAddressOf());
+        DXThrowIfFailed(hr, "failed to create D3D11 render-target-view (RTV) for back buffer");
+    }
+
     if (depthStencilFormat_ != DXGI_FORMAT_UNKNOWN)
     {
         /* Create depth stencil texture */
@@ -214,6 +456,7 @@ void D3D11SwapChain::ResizeBackBuffer(const Extent2D& resolution)
 
     /* Release buffers */
     colorBuffer_.Reset();
+    colorBufferMS_.Reset();
     renderTargetView_.Reset();
     depthBuffer_.Reset();
     depthStencilView_.Reset();
@@ -223,11 +466,14 @@ void D3D11SwapChain::ResizeBackBuffer(const Extent2D& resolution)
         bindingCommandBuffer_->ResetDeferredCommandList();
 
     /* Resize swap-chain buffers, let DXGI find out the client area, and preserve buffer count and format */
-    auto hr = swapChain_->ResizeBuffers(0, resolution.width, resolution.height, DXGI_FORMAT_UNKNOWN, 0);
+    auto hr = swapChain_->ResizeBuffers(0, resolution.width, resolution.height, DXGI_FORMAT_UNKNOWN, swapChainFlags_);
     DXThrowIfFailed(hr, "failed to resize DXGI swap-chain buffers");
 
     /* Recreate back buffer and reset default render target */
     CreateBackBuffer();
+
+    /* Resized buffers have undefined content */
+    presentCount_ = 0;
 }
 
 
@@ -14,6 +14,15 @@
 #include <d3d11.h>
 #include <dxgi.h>
 
+#if LLGL_D3D11_ENABLE_FEATURELEVEL >= 3
+#   include <dxgi1_5.h>
+#elif LLGL_D3D11_ENABLE_FEATURELEVEL >= 2
+#   include <dxgi1_3.h>
+#elif LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+#   include <dxgi1_2.h>
+#endif
+#include <vector>
+
 
 namespace LLGL
 {
@@ -33,9 +42,15 @@ class D3D11SwapChain final : public SwapChain
             const std::shared_ptr<Surface>& surface
         );
 
+        ~D3D11SwapChain();
+
         void SetName(const char* name) override;
 
         void Present() override;
+        void WaitForNextFrame() override;
+        bool QueryPresentStatistics(PresentStatistics& outStats) override;
+        bool SetDamageRegions(std::uint32_t numRegions, const Scissor* regions) override;
+        std::uint32_t QueryBufferAge() override;
 
         std::uint32_t GetSamples() const override;
 
@@ -56,20 +71,36 @@ class D3D11SwapChain final : public SwapChain
         bool ResizeBuffersPrimary(const Extent2D& resolution) override;
 
         bool SetPresentSyncInterval(UINT syncInterval);
+        void GetPresentParameters(UINT& outSyncInterval, UINT& outFlags) const;
 
-        void CreateSwapChain(IDXGIFactory* factory, const Extent2D& resolution, std::uint32_t samples, std::uint32_t swapBuffers);
+        void CreateSwapChain(IDXGIFactory* factory, const SwapChainDescriptor& desc);
+        bool CreateFlipModelSwapChain(IDXGIFactory* factory, DXGI_SWAP_CHAIN_DESC swapChainDesc, const SwapChainDescriptor& desc);
+        void SetMaximumFrameLatency(UINT maxFrameLatency);
         void CreateBackBuffer();
         void ResizeBackBuffer(const Extent2D& resolution);
 
     private:
 
         ComPtr<ID3D11Device>            device_;
+        ComPtr<ID3D11DeviceContext>     context_;
 
         ComPtr<IDXGISwapChain>          swapChain_;
+        #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+        ComPtr<IDXGISwapChain1>         swapChain1_;                        // Only used for IDXGISwapChain1::Present1 with flip-model swap-chains.
+        #endif
         UINT                            swapChainInterval_      = 0;
+        UINT                            swapChainFlags_         = 0;
+        bool                            isFlipModel_            = false;
+        bool                            isFlipSequential_       = false;    // True if the back buffer content is preserved (DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL)
+        UINT                            swapChainBufferCount_   = 0;
+        UINT                            presentCount_           = 0;        // Number of presents since the back buffer was (re-)created; saturated at the buffer count
+        std::vector<RECT>               dirtyRects_;                        // Damage regions for the next present
+        PresentMode                     presentMode_            = PresentMode::Undefined;
+        HANDLE                          frameLatencyObject_     = nullptr;
         DXGI_SAMPLE_DESC                swapChainSampleDesc_    = { 1, 0 };
 
         ComPtr<ID3D11Texture2D>         colorBuffer_;
+        ComPtr<ID3D11Texture2D>         colorBufferMS_;                     // Multi-sampled color buffer for flip-model swap-chains; resolved into the back buffer on present.
         ComPtr<ID3D11RenderTargetView>  renderTargetView_;
         ComPtr<ID3D11Texture2D>         depthBuffer_;
         ComPtr<ID3D11DepthStencilView>  depthStencilView_;
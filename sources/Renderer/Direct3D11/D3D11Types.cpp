@@ -212,10 +212,11 @@ D3D11_MAP Map(const CPUAccess cpuAccess)
 {
     switch (cpuAccess)
     {
-        case CPUAccess::ReadOnly:       return D3D11_MAP_READ;
-        case CPUAccess::WriteOnly:      return D3D11_MAP_WRITE;
-        case CPUAccess::WriteDiscard:   return D3D11_MAP_WRITE_DISCARD;
-        case CPUAccess::ReadWrite:      return D3D11_MAP_READ_WRITE;
+        case CPUAccess::ReadOnly:               return D3D11_MAP_READ;
+        case CPUAccess::WriteOnly:              return D3D11_MAP_WRITE;
+        case CPUAccess::WriteDiscard:           return D3D11_MAP_WRITE_DISCARD;
+        case CPUAccess::ReadWrite:              return D3D11_MAP_READ_WRITE;
+        case CPUAccess::WriteUnsynchronized:    return D3D11_MAP_WRITE_NO_OVERWRITE;
     }
     DXTypes::MapFailed("CPUAccess", "D3D11_MAP");
 }
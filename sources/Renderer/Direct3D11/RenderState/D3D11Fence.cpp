@@ -25,14 +25,31 @@ D3D11Fence::D3D11Fence(ID3D11Device* device)
     DXThrowIfFailed(hr, "failed to create D3D11 query");
 }
 
+std::uint64_t D3D11Fence::GetValue() const
+{
+    return value_;
+}
+
+std::uint64_t D3D11Fence::GetCompletedValue() const
+{
+    /* Query objects can only be polled with a device context, so the completed value is only updated when the fence is waited on */
+    return completedValue_;
+}
+
 void D3D11Fence::Submit(ID3D11DeviceContext* context)
 {
     context->End(query_.Get());
+    ++value_;
 }
 
 void D3D11Fence::Wait(ID3D11DeviceContext* context)
 {
-    while (context->GetData(query_.Get(), nullptr, 0, 0) == S_FALSE) { /* dummy */ }
+    /* Query must not be polled before it has been issued at least once */
+    if (completedValue_ < value_)
+    {
+        while (context->GetData(query_.Get(), nullptr, 0, 0) == S_FALSE) { /* dummy */ }
+        completedValue_ = value_;
+    }
 }
 
 
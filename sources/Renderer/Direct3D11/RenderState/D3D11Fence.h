@@ -22,6 +22,11 @@ namespace LLGL
 class D3D11Fence final : public Fence
 {
 
+    public:
+
+        std::uint64_t GetValue() const override;
+        std::uint64_t GetCompletedValue() const override;
+
     public:
 
         D3D11Fence(ID3D11Device* device);
@@ -32,6 +37,8 @@ class D3D11Fence final : public Fence
     private:
 
         ComPtr<ID3D11Query> query_;
+        std::uint64_t       value_          = 0;
+        std::uint64_t       completedValue_ = 0;
 
 };
 
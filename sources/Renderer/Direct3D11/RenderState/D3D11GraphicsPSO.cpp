@@ -7,6 +7,7 @@
 
 #include "D3D11GraphicsPSO.h"
 #include "D3D11StateManager.h"
+#include "D3D11StatePool.h"
 #include "../D3D11Types.h"
 #include "../../DXCommon/DXCore.h"
 #include <LLGL/PipelineStateFlags.h>
@@ -25,6 +26,15 @@ D3D11GraphicsPSO::D3D11GraphicsPSO(ID3D11Device* device, const GraphicsPipelineD
     CreateBlendState(device, desc.blend);
 }
 
+D3D11GraphicsPSO::~D3D11GraphicsPSO()
+{
+    /* Release shared render state objects */
+    auto& statePool = D3D11StatePool::Get();
+    statePool.ReleaseDepthStencilState(depthStencilState_.Get());
+    statePool.ReleaseRasterizerState(rasterizerState_.Get());
+    statePool.ReleaseBlendState(blendState_.Get());
+}
+
 void D3D11GraphicsPSO::Bind(D3D11StateManager& stateMngr)
 {
     /* Bind base pipeline states */
@@ -53,26 +63,17 @@ void D3D11GraphicsPSO::Bind(D3D11StateManager& stateMngr)
 
 void D3D11GraphicsPSO::CreateDepthStencilState(ID3D11Device* device, const DepthDescriptor& depthDesc, const StencilDescriptor& stencilDesc)
 {
-    D3D11_DEPTH_STENCIL_DESC descDX;
-    D3D11Types::Convert(descDX, depthDesc, stencilDesc);
-    auto hr = device->CreateDepthStencilState(&descDX, depthStencilState_.ReleaseAndGetAddressOf());
-    DXThrowIfFailed(hr, "failed to create D3D11 depth-stencil state");
+    depthStencilState_ = D3D11StatePool::Get().AcquireDepthStencilState(device, depthDesc, stencilDesc);
 }
 
 void D3D11GraphicsPSO::CreateRasterizerState(ID3D11Device* device, const RasterizerDescriptor& desc)
 {
-    D3D11_RASTERIZER_DESC descDX;
-    D3D11Types::Convert(descDX, desc);
-    auto hr = device->CreateRasterizerState(&descDX, rasterizerState_.ReleaseAndGetAddressOf());
-    DXThrowIfFailed(hr, "failed to create D3D11 rasterizer state");
+    rasterizerState_ = D3D11StatePool::Get().AcquireRasterizerState(device, desc);
 }
 
 void D3D11GraphicsPSO::CreateBlendState(ID3D11Device* device, const BlendDescriptor& desc)
 {
-    D3D11_BLEND_DESC descDX;
-    D3D11Types::Convert(descDX, desc);
-    auto hr = device->CreateBlendState(&descDX, blendState_.ReleaseAndGetAddressOf());
-    DXThrowIfFailed(hr, "failed to create D3D11 blend state");
+    blendState_ = D3D11StatePool::Get().AcquireBlendState(device, desc);
 }
 
 
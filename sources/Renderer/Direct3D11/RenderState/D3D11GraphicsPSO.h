@@ -23,6 +23,7 @@ class D3D11GraphicsPSO final : public D3D11GraphicsPSOBase
     public:
 
         D3D11GraphicsPSO(ID3D11Device* device, const GraphicsPipelineDescriptor& desc);
+        ~D3D11GraphicsPSO();
 
         void Bind(D3D11StateManager& stateMngr) override;
 
@@ -10,6 +10,7 @@
 
 #include "D3D11GraphicsPSO1.h"
 #include "D3D11StateManager.h"
+#include "D3D11StatePool.h"
 #include "../D3D11Types.h"
 #include "../../DXCommon/DXCore.h"
 #include <LLGL/PipelineStateFlags.h>
@@ -28,6 +29,15 @@ D3D11GraphicsPSO1::D3D11GraphicsPSO1(ID3D11Device1* device, const GraphicsPipeli
     CreateBlendState(device, desc.blend);
 }
 
+D3D11GraphicsPSO1::~D3D11GraphicsPSO1()
+{
+    /* Release shared render state objects */
+    auto& statePool = D3D11StatePool::Get();
+    statePool.ReleaseDepthStencilState(depthStencilState_.Get());
+    statePool.ReleaseRasterizerState(rasterizerState_.Get());
+    statePool.ReleaseBlendState(blendState_.Get());
+}
+
 void D3D11GraphicsPSO1::Bind(D3D11StateManager& stateMngr)
 {
     /* Bind base pipeline states */
@@ -56,26 +66,17 @@ void D3D11GraphicsPSO1::Bind(D3D11StateManager& stateMngr)
 
 void D3D11GraphicsPSO1::CreateDepthStencilState(ID3D11Device1* device, const DepthDescriptor& depthDesc, const StencilDescriptor& stencilDesc)
 {
-    D3D11_DEPTH_STENCIL_DESC descDX;
-    D3D11Types::Convert(descDX, depthDesc, stencilDesc);
-    auto hr = device->CreateDepthStencilState(&descDX, depthStencilState_.ReleaseAndGetAddressOf());
-    DXThrowIfFailed(hr, "failed to create D3D11 depth-stencil state");
+    depthStencilState_ = D3D11StatePool::Get().AcquireDepthStencilState(device, depthDesc, stencilDesc);
 }
 
 void D3D11GraphicsPSO1::CreateRasterizerState(ID3D11Device1* device, const RasterizerDescriptor& desc)
 {
-    D3D11_RASTERIZER_DESC descDX;
-    D3D11Types::Convert(descDX, desc);
-    auto hr = device->CreateRasterizerState(&descDX, rasterizerState_.ReleaseAndGetAddressOf());
-    DXThrowIfFailed(hr, "failed to create D3D11 rasterizer state");
+    rasterizerState_ = D3D11StatePool::Get().AcquireRasterizerState(device, desc);
 }
 
 void D3D11GraphicsPSO1::CreateBlendState(ID3D11Device1* device, const BlendDescriptor& desc)
 {
-    D3D11_BLEND_DESC1 descDX;
-    D3D11Types::Convert(descDX, desc);
-    auto hr = device->CreateBlendState1(&descDX, blendState_.ReleaseAndGetAddressOf());
-    DXThrowIfFailed(hr, "failed to create D3D11 blend state");
+    blendState_ = D3D11StatePool::Get().AcquireBlendState1(device, desc);
 }
 
 
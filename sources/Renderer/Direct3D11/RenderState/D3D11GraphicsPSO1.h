@@ -26,6 +26,7 @@ class D3D11GraphicsPSO1 final : public D3D11GraphicsPSOBase
     public:
 
         D3D11GraphicsPSO1(ID3D11Device1* device, const GraphicsPipelineDescriptor& desc);
+        ~D3D11GraphicsPSO1();
 
         void Bind(D3D11StateManager& stateMngr) override;
 
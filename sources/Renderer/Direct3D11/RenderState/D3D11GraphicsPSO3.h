@@ -26,6 +26,7 @@ class D3D11GraphicsPSO3 final : public D3D11GraphicsPSOBase
     public:
 
         D3D11GraphicsPSO3(ID3D11Device3* device, const GraphicsPipelineDescriptor& desc);
+        ~D3D11GraphicsPSO3();
 
         void Bind(D3D11StateManager& stateMngr) override;
 
@@ -9,6 +9,7 @@
 #include "../D3D11Types.h"
 #include "../D3D11ObjectUtils.h"
 #include "../../DXCommon/DXCore.h"
+#include <string>
 
 
 namespace LLGL
@@ -37,9 +38,9 @@ static ComPtr<ID3D11Predicate> DXCreatePredicate(ID3D11Device* device, const D3D
 
 static std::uint32_t GetDXQueryGroupSize(D3D11_QUERY queryType)
 {
-    /* For timestamp, use group size of 3: one primary and two secondary <ID3D11Query> objects */
+    /* For timestamp, use group size of 2: one <ID3D11Query> object for the beginning and one for the ending timestamp */
     if (queryType == D3D11_QUERY_TIMESTAMP_DISJOINT)
-        return 3u;
+        return 2u;
     else
         return 1u;
 }
@@ -73,15 +74,16 @@ D3D11QueryHeap::D3D11QueryHeap(ID3D11Device* device, const QueryHeapDescriptor&
             timerQueryDesc.MiscFlags    = 0;
         }
 
-        for (std::uint32_t i = 0; i < numNativeQueries; i += groupSize_)
-        {
-            /* Create primary query object */
-            nativeQueries_.push_back(DXCreateQuery(device, queryDesc));
-
-            /* Create secondary query objects */
-            nativeQueries_.push_back(DXCreateQuery(device, timerQueryDesc));
+        /* Create timestamp query objects */
+        for (std::uint32_t i = 0; i < numNativeQueries; ++i)
             nativeQueries_.push_back(DXCreateQuery(device, timerQueryDesc));
-        }
+
+        /* Create ring of disjoint query objects that are shared by all timer queries */
+        disjointQueries_.reserve(g_numDisjointQueries);
+        for (std::uint32_t i = 0; i < g_numDisjointQueries; ++i)
+            disjointQueries_.push_back(DXCreateQuery(device, queryDesc));
+
+        queryDisjointIndices_.resize(desc.numQueries, 0);
     }
     else
     {
@@ -90,6 +92,28 @@ D3D11QueryHeap::D3D11QueryHeap(ID3D11Device* device, const QueryHeapDescriptor&
     }
 }
 
+bool D3D11QueryHeap::BeginDisjointQuery(ID3D11DeviceContext* context, std::uint32_t query)
+{
+    queryDisjointIndices_[query] = currentDisjointQuery_;
+    if (!isDisjointQueryActive_)
+    {
+        context->Begin(disjointQueries_[currentDisjointQuery_].Get());
+        isDisjointQueryActive_ = true;
+        return true;
+    }
+    return false;
+}
+
+void D3D11QueryHeap::EndDisjointQuery(ID3D11DeviceContext* context)
+{
+    if (isDisjointQueryActive_)
+    {
+        context->End(disjointQueries_[currentDisjointQuery_].Get());
+        currentDisjointQuery_   = (currentDisjointQuery_ + 1) % g_numDisjointQueries;
+        isDisjointQueryActive_  = false;
+    }
+}
+
 void D3D11QueryHeap::SetName(const char* name)
 {
     if (nativeQueries_.size() == 1)
@@ -103,6 +127,13 @@ void D3D11QueryHeap::SetName(const char* name)
         for (std::uint32_t i = 0, n = static_cast<std::uint32_t>(nativeQueries_.size()); i < n; ++i)
             D3D11SetObjectNameIndexed(GetNative(i), name, i);
     }
+
+    /* Set label for each disjoint query object */
+    for (std::uint32_t i = 0, n = static_cast<std::uint32_t>(disjointQueries_.size()); i < n; ++i)
+    {
+        const std::string subscript = ".Disjoint" + std::to_string(i);
+        D3D11SetObjectNameSubscript(disjointQueries_[i].Get(), name, subscript.c_str());
+    }
 }
 
 
@@ -46,6 +46,13 @@ union D3D11NativeQuery
     ComPtr<ID3D11Predicate> predicate;
 };
 
+/*
+QueryHeap implementation for Direct3D 11.
+Timer queries (QueryType::TimeElapsed) only consist of two timestamp queries each. All timer queries of the same heap
+that are begun within a single command buffer recording share one disjoint query, which is ended with the command buffer.
+The heap cycles through a small ring of disjoint queries, so the timestamps of several frames can be in flight
+while the results of previous frames are still pending.
+*/
 class D3D11QueryHeap final : public QueryHeap
 {
 
@@ -81,12 +88,38 @@ class D3D11QueryHeap final : public QueryHeap
             return groupSize_;
         }
 
+        /*
+        Assigns the current disjoint query to the specified timer query and begins the disjoint query if it is not active yet.
+        Returns true if the disjoint query has been begun, in which case the command buffer must end it via EndDisjointQuery.
+        */
+        bool BeginDisjointQuery(ID3D11DeviceContext* context, std::uint32_t query);
+
+        // Ends the active disjoint query and advances to the next one in the ring.
+        void EndDisjointQuery(ID3D11DeviceContext* context);
+
+        // Returns the native disjoint query that was active when the specified timer query was begun.
+        inline ID3D11Query* GetDisjointQuery(std::uint32_t query) const
+        {
+            return disjointQueries_[queryDisjointIndices_[query]].Get();
+        }
+
+    private:
+
+        // Number of disjoint queries per timer query heap, i.e. the number of frames that can be in flight.
+        static const std::uint32_t g_numDisjointQueries = 4;
+
     private:
 
         D3D11_QUERY                     nativeType_     = D3D11_QUERY_EVENT;
         std::uint32_t                   groupSize_      = 1;
         std::vector<D3D11NativeQuery>   nativeQueries_;
 
+        /* Disjoint queries for timer queries */
+        std::vector<ComPtr<ID3D11Query>>    disjointQueries_;
+        std::vector<std::uint32_t>          queryDisjointIndices_;
+        std::uint32_t                       currentDisjointQuery_   = 0;
+        bool                                isDisjointQueryActive_  = false;
+
 };
 
 
@@ -7,6 +7,7 @@
 
 #include "D3D11RenderPass.h"
 #include "../../RenderPassUtils.h"
+#include <algorithm>
 
 
 namespace LLGL
@@ -25,6 +26,15 @@ D3D11RenderPass::D3D11RenderPass(const RenderPassDescriptor& desc)
     /* Check if stencil attachment must be cleared */
     if (desc.stencilAttachment.loadOp == AttachmentLoadOp::Clear)
         clearFlagsDSV_ |= D3D11_CLEAR_STENCIL;
+
+    /* Store attachment masks of sub-passes; D3D11 can only rebind the output-merger between sub-passes */
+    numSubpasses_ = std::min<std::uint32_t>(desc.numSubpasses, LLGL_MAX_NUM_SUBPASSES);
+    for (std::uint32_t i = 0; i < numSubpasses_; ++i)
+    {
+        subpassColorAttachments_[i] = static_cast<std::uint8_t>(desc.subpasses[i].colorAttachments);
+        if (desc.subpasses[i].depthStencilAttachment)
+            subpassDepthStencilMask_ |= static_cast<std::uint8_t>(1u << i);
+    }
 }
 
 
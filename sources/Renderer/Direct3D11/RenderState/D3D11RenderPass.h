@@ -39,11 +39,33 @@ class D3D11RenderPass final : public RenderPass
             return clearColorAttachments_;
         }
 
+        // Returns the number of explicit sub-passes of this render pass or 0 if the render pass has a single implicit sub-pass.
+        inline std::uint32_t GetNumSubpasses() const
+        {
+            return numSubpasses_;
+        }
+
+        // Returns the bitmask of color attachments the specified sub-pass writes to.
+        inline std::uint32_t GetSubpassColorAttachments(std::uint32_t subpass) const
+        {
+            return subpassColorAttachments_[subpass];
+        }
+
+        // Returns true if the specified sub-pass uses the depth-stencil attachment.
+        inline bool HasSubpassDepthStencil(std::uint32_t subpass) const
+        {
+            return ((subpassDepthStencilMask_ & (1u << subpass)) != 0);
+        }
+
     private:
 
         UINT            clearFlagsDSV_                                          = 0;
         std::uint8_t    clearColorAttachments_[LLGL_MAX_NUM_COLOR_ATTACHMENTS]  = {};
 
+        std::uint32_t   numSubpasses_                                           = 0;
+        std::uint8_t    subpassColorAttachments_[LLGL_MAX_NUM_SUBPASSES]        = {};
+        std::uint8_t    subpassDepthStencilMask_                                = 0;
+
 };
 
 
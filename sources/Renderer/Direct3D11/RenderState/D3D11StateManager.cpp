@@ -7,6 +7,7 @@
 
 #include "D3D11StateManager.h"
 #include "../../../Core/HelperMacros.h"
+#include "../../../Core/Helper.h"
 #include <algorithm>
 #include <cstddef>
 
@@ -15,7 +16,12 @@ namespace LLGL
 {
 
 
-static const UINT g_cbufferChunkSize = 4096u;
+static const UINT g_cbufferChunkSize      = 4096u;
+static const UINT g_cbufferRingSize       = (1u << 20);
+static const UINT g_uploadRingSize        = (1u << 20);
+
+// Constant buffer ranges must start at multiples of 16 constants, i.e. 256 bytes
+static const UINT g_cbufferRingAlignment  = 256u;
 
 D3D11StateManager::D3D11StateManager(
     ID3D11Device*                       device,
@@ -33,6 +39,8 @@ D3D11StateManager::D3D11StateManager(
 {
     #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
     context_->QueryInterface(IID_PPV_ARGS(&context1_));
+    if (context1_ != nullptr)
+        CreateRingBuffers(device);
     #endif
 }
 
@@ -265,6 +273,7 @@ void D3D11StateManager::SetConstantBuffers(
     ID3D11Buffer* const*    buffers,
     long                    stageFlags)
 {
+    StoreKnownBindings(startSlot, count, buffers, stageFlags);
     if (LLGL_VS_STAGE(stageFlags)) { context_->VSSetConstantBuffers(startSlot, count, buffers); }
     if (LLGL_HS_STAGE(stageFlags)) { context_->HSSetConstantBuffers(startSlot, count, buffers); }
     if (LLGL_DS_STAGE(stageFlags)) { context_->DSSetConstantBuffers(startSlot, count, buffers); }
@@ -281,6 +290,9 @@ void D3D11StateManager::SetConstantBuffersRange(
     const UINT*             numConstants,
     long                    stageFlags)
 {
+    /* Buffer ranges are not tracked by the binding cache */
+    ForgetConstantBufferBindings(startSlot, count, stageFlags);
+
     #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
     if (context1_ != nullptr)
     {
@@ -318,6 +330,7 @@ void D3D11StateManager::SetShaderResources(
     ID3D11ShaderResourceView* const*    views,
     long                                stageFlags)
 {
+    StoreKnownBindings(startSlot, count, views, stageFlags);
     if (LLGL_VS_STAGE(stageFlags)) { context_->VSSetShaderResources(startSlot, count, views); }
     if (LLGL_HS_STAGE(stageFlags)) { context_->HSSetShaderResources(startSlot, count, views); }
     if (LLGL_DS_STAGE(stageFlags)) { context_->DSSetShaderResources(startSlot, count, views); }
@@ -332,6 +345,7 @@ void D3D11StateManager::SetSamplers(
     ID3D11SamplerState* const*  samplers,
     long                        stageFlags)
 {
+    StoreKnownBindings(startSlot, count, samplers, stageFlags);
     if (LLGL_VS_STAGE(stageFlags)) { context_->VSSetSamplers(startSlot, count, samplers); }
     if (LLGL_HS_STAGE(stageFlags)) { context_->HSSetSamplers(startSlot, count, samplers); }
     if (LLGL_DS_STAGE(stageFlags)) { context_->DSSetSamplers(startSlot, count, samplers); }
@@ -366,12 +380,150 @@ void D3D11StateManager::SetUnorderedAccessViews(
         /* Set UAVs for compute shader stage */
         context_->CSSetUnorderedAccessViews(startSlot, count, views, initialCounts);
     }
+
+    /* Binding UAVs implicitly unbinds all SRVs of the same resources */
+    InvalidateBindings();
+}
+
+/*
+Marks the specified slot as dirty unless its value is already known to be bound.
+Returns true if the slot has been marked as dirty.
+*/
+template <typename TTable, typename T>
+static bool SetBindingSlot(TTable& table, UINT slot, T* value)
+{
+    if (slot >= table.dirty.size())
+        return false;
+
+    if (table.slots[slot] == value && (table.known[slot] || table.dirty[slot]))
+        return false;
+
+    table.slots[slot] = value;
+    table.dirty.set(slot);
+    table.dirtyBegin    = std::min(table.dirtyBegin, slot);
+    table.dirtyEnd      = std::max(table.dirtyEnd, slot + 1);
+
+    return true;
+}
+
+/*
+Calls the specified function for each contiguous range of dirty slots and marks those slots as known.
+The function's signature must be compatible to: void (UINT startSlot, UINT count, T* const* values).
+*/
+template <typename TTable, typename TFunc>
+static void FlushBindingSlots(TTable& table, TFunc bindFunc)
+{
+    for (UINT i = table.dirtyBegin; i < table.dirtyEnd;)
+    {
+        if (table.dirty[i])
+        {
+            /* Find end of contiguous range of dirty slots */
+            UINT end = i + 1;
+            while (end < table.dirtyEnd && table.dirty[end])
+                ++end;
+
+            bindFunc(i, end - i, &(table.slots[i]));
+
+            for (; i < end; ++i)
+            {
+                table.dirty.reset(i);
+                table.known.set(i);
+            }
+        }
+        else
+            ++i;
+    }
+
+    table.dirtyBegin    = static_cast<UINT>(table.dirty.size());
+    table.dirtyEnd      = 0;
+}
+
+// Writes the specified bindings into the slot table and marks them as known, i.e. they have already been bound to the device context.
+template <typename TTable, typename T>
+static void StoreBindingSlots(TTable& table, UINT startSlot, UINT count, T* const* values)
+{
+    const UINT numSlots = static_cast<UINT>(table.dirty.size());
+    for (UINT i = 0; i < count && startSlot + i < numSlots; ++i)
+    {
+        table.slots[startSlot + i] = (values != nullptr ? values[i] : nullptr);
+        table.dirty.reset(startSlot + i);
+        table.known.set(startSlot + i);
+    }
+}
+
+// Returns the bitmask of binding stages (VS, HS, DS, GS, PS, CS) for the specified shader stage flags.
+static std::uint32_t GetBindingStageMask(long stageFlags)
+{
+    std::uint32_t mask = 0;
+    if (LLGL_VS_STAGE(stageFlags)) { mask |= (1u << 0); }
+    if (LLGL_HS_STAGE(stageFlags)) { mask |= (1u << 1); }
+    if (LLGL_DS_STAGE(stageFlags)) { mask |= (1u << 2); }
+    if (LLGL_GS_STAGE(stageFlags)) { mask |= (1u << 3); }
+    if (LLGL_PS_STAGE(stageFlags)) { mask |= (1u << 4); }
+    if (LLGL_CS_STAGE(stageFlags)) { mask |= (1u << 5); }
+    return mask;
+}
+
+void D3D11StateManager::SetConstantBufferDeferred(UINT slot, ID3D11Buffer* buffer, long stageFlags)
+{
+    const std::uint32_t stageMask = GetBindingStageMask(stageFlags);
+    for (UINT stage = 0; stage < g_numBindingStages; ++stage)
+    {
+        if ((stageMask & (1u << stage)) != 0)
+        {
+            auto& table = stageBindings_[stage].cbvs;
+            if (SetBindingSlot(table, slot, buffer))
+                dirtyBindingStages_ |= (1u << stage);
+        }
+    }
+}
+
+void D3D11StateManager::SetShaderResourceDeferred(UINT slot, ID3D11ShaderResourceView* view, long stageFlags)
+{
+    const std::uint32_t stageMask = GetBindingStageMask(stageFlags);
+    for (UINT stage = 0; stage < g_numBindingStages; ++stage)
+    {
+        if ((stageMask & (1u << stage)) != 0)
+        {
+            auto& table = stageBindings_[stage].srvs;
+            if (SetBindingSlot(table, slot, view))
+                dirtyBindingStages_ |= (1u << stage);
+        }
+    }
+}
+
+void D3D11StateManager::SetSamplerDeferred(UINT slot, ID3D11SamplerState* sampler, long stageFlags)
+{
+    const std::uint32_t stageMask = GetBindingStageMask(stageFlags);
+    for (UINT stage = 0; stage < g_numBindingStages; ++stage)
+    {
+        if ((stageMask & (1u << stage)) != 0)
+        {
+            auto& table = stageBindings_[stage].samplers;
+            if (SetBindingSlot(table, slot, sampler))
+                dirtyBindingStages_ |= (1u << stage);
+        }
+    }
+}
+
+void D3D11StateManager::InvalidateBindings()
+{
+    for (auto& stage : stageBindings_)
+    {
+        stage.cbvs.known.reset();
+        stage.srvs.known.reset();
+        stage.samplers.known.reset();
+    }
 }
 
 void D3D11StateManager::SetConstants(std::uint32_t slot, const void* data, std::uint16_t dataSize, long stageFlags)
 {
-    /* Write data to intermediate constant buffer */
-    auto bufferRange = intermediateCbufferPool_.Write(data, dataSize);
+    /* Write data to constant ring buffer if available, so all constants share a single buffer, otherwise use intermediate constant buffer */
+    D3D11BufferRange bufferRange;
+    if (cbufferRing_ && cbufferRing_->Capacity(dataSize))
+        bufferRange = cbufferRing_->Write(context_.Get(), data, dataSize);
+    else
+        bufferRange = intermediateCbufferPool_.Write(data, dataSize);
 
     /* Bind intermediate buffer to buffer range */
     const UINT firstConstants[] = { bufferRange.offset / 16 };
@@ -387,11 +539,178 @@ void D3D11StateManager::DispatchBuiltin(const D3D11BuiltinShader builtinShader,
     context_->Dispatch(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
 }
 
+bool D3D11StateManager::WriteBufferStaged(ID3D11Buffer* dstBuffer, UINT dstOffset, const void* data, UINT dataSize)
+{
+    if (!uploadRing_ || !uploadRing_->Capacity(dataSize))
+        return false;
+
+    /* Write data to upload ring buffer and copy range into destination buffer */
+    auto srcRange = uploadRing_->Write(context_.Get(), data, dataSize);
+    const D3D11_BOX srcBox{ srcRange.offset, 0, 0, srcRange.offset + dataSize, 1, 1 };
+    context_->CopySubresourceRegion(dstBuffer, 0, dstOffset, 0, 0, srcRange.native, 0, &srcBox);
+
+    return true;
+}
+
 void D3D11StateManager::ResetIntermediateBufferPools()
 {
     intermediateCbufferPool_.Reset();
+
+    /* Deferred contexts must discard dynamic buffers with the first write of each command list */
+    if (cbufferRing_)
+        cbufferRing_->Reset();
+    if (uploadRing_)
+        uploadRing_->Reset();
+}
+
+void D3D11StateManager::ResetStateCache()
+{
+    inputAssemblyState_ = D3DInputAssemblyState{};
+    shaderState_        = D3DShaderState{};
+    renderState_        = D3DRenderState{};
+    InvalidateBindings();
+}
+
+
+
+/*
+ * ======= Private: =======
+ */
+
+void D3D11StateManager::FlushDirtyBindings()
+{
+    using BindBuffersFunc   = void (STDMETHODCALLTYPE ID3D11DeviceContext::*)(UINT, UINT, ID3D11Buffer* const*);
+    using BindViewsFunc     = void (STDMETHODCALLTYPE ID3D11DeviceContext::*)(UINT, UINT, ID3D11ShaderResourceView* const*);
+    using BindSamplersFunc  = void (STDMETHODCALLTYPE ID3D11DeviceContext::*)(UINT, UINT, ID3D11SamplerState* const*);
+
+    static const BindBuffersFunc bindBuffersFuncs[g_numBindingStages] =
+    {
+        &ID3D11DeviceContext::VSSetConstantBuffers,
+        &ID3D11DeviceContext::HSSetConstantBuffers,
+        &ID3D11DeviceContext::DSSetConstantBuffers,
+        &ID3D11DeviceContext::GSSetConstantBuffers,
+        &ID3D11DeviceContext::PSSetConstantBuffers,
+        &ID3D11DeviceContext::CSSetConstantBuffers,
+    };
+
+    static const BindViewsFunc bindViewsFuncs[g_numBindingStages] =
+    {
+        &ID3D11DeviceContext::VSSetShaderResources,
+        &ID3D11DeviceContext::HSSetShaderResources,
+        &ID3D11DeviceContext::DSSetShaderResources,
+        &ID3D11DeviceContext::GSSetShaderResources,
+        &ID3D11DeviceContext::PSSetShaderResources,
+        &ID3D11DeviceContext::CSSetShaderResources,
+    };
+
+    static const BindSamplersFunc bindSamplersFuncs[g_numBindingStages] =
+    {
+        &ID3D11DeviceContext::VSSetSamplers,
+        &ID3D11DeviceContext::HSSetSamplers,
+        &ID3D11DeviceContext::DSSetSamplers,
+        &ID3D11DeviceContext::GSSetSamplers,
+        &ID3D11DeviceContext::PSSetSamplers,
+        &ID3D11DeviceContext::CSSetSamplers,
+    };
+
+    auto context = context_.Get();
+
+    for (UINT stage = 0; stage < g_numBindingStages; ++stage)
+    {
+        if ((dirtyBindingStages_ & (1u << stage)) == 0)
+            continue;
+
+        /* Submit one call per contiguous range of dirty slots */
+        auto& bindings = stageBindings_[stage];
+
+        FlushBindingSlots(
+            bindings.cbvs,
+            [context, stage](UINT startSlot, UINT count, ID3D11Buffer* const* buffers)
+            {
+                (context->*bindBuffersFuncs[stage])(startSlot, count, buffers);
+            }
+        );
+        FlushBindingSlots(
+            bindings.srvs,
+            [context, stage](UINT startSlot, UINT count, ID3D11ShaderResourceView* const* views)
+            {
+                (context->*bindViewsFuncs[stage])(startSlot, count, views);
+            }
+        );
+        FlushBindingSlots(
+            bindings.samplers,
+            [context, stage](UINT startSlot, UINT count, ID3D11SamplerState* const* samplers)
+            {
+                (context->*bindSamplersFuncs[stage])(startSlot, count, samplers);
+            }
+        );
+    }
+
+    dirtyBindingStages_ = 0;
 }
 
+void D3D11StateManager::StoreKnownBindings(UINT startSlot, UINT count, ID3D11Buffer* const* buffers, long stageFlags)
+{
+    const std::uint32_t stageMask = GetBindingStageMask(stageFlags);
+    for (UINT stage = 0; stage < g_numBindingStages; ++stage)
+    {
+        if ((stageMask & (1u << stage)) != 0)
+            StoreBindingSlots(stageBindings_[stage].cbvs, startSlot, count, buffers);
+    }
+}
+
+void D3D11StateManager::StoreKnownBindings(UINT startSlot, UINT count, ID3D11ShaderResourceView* const* views, long stageFlags)
+{
+    const std::uint32_t stageMask = GetBindingStageMask(stageFlags);
+    for (UINT stage = 0; stage < g_numBindingStages; ++stage)
+    {
+        if ((stageMask & (1u << stage)) != 0)
+            StoreBindingSlots(stageBindings_[stage].srvs, startSlot, count, views);
+    }
+}
+
+void D3D11StateManager::StoreKnownBindings(UINT startSlot, UINT count, ID3D11SamplerState* const* samplers, long stageFlags)
+{
+    const std::uint32_t stageMask = GetBindingStageMask(stageFlags);
+    for (UINT stage = 0; stage < g_numBindingStages; ++stage)
+    {
+        if ((stageMask & (1u << stage)) != 0)
+            StoreBindingSlots(stageBindings_[stage].samplers, startSlot, count, samplers);
+    }
+}
+
+void D3D11StateManager::ForgetConstantBufferBindings(UINT startSlot, UINT count, long stageFlags)
+{
+    const std::uint32_t stageMask = GetBindingStageMask(stageFlags);
+    for (UINT stage = 0; stage < g_numBindingStages; ++stage)
+    {
+        if ((stageMask & (1u << stage)) != 0)
+        {
+            auto& table = stageBindings_[stage].cbvs;
+            for (UINT i = startSlot; i < startSlot + count && i < table.dirty.size(); ++i)
+            {
+                table.dirty.reset(i);
+                table.known.reset(i);
+            }
+        }
+    }
+}
+
+void D3D11StateManager::CreateRingBuffers(ID3D11Device* device)
+{
+    #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+
+    /* Constant buffers can only be mapped with D3D11_MAP_WRITE_NO_OVERWRITE if the driver supports it */
+    D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+    HRESULT hr = device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options));
+    if (SUCCEEDED(hr) && options.MapNoOverwriteOnDynamicConstantBuffer != FALSE)
+        cbufferRing_ = MakeUnique<D3D11DynamicRingBuffer>(device, g_cbufferRingSize, D3D11_BIND_CONSTANT_BUFFER, g_cbufferRingAlignment);
+
+    /* Upload ring buffer for small buffer updates, which are copied into the destination buffers */
+    uploadRing_ = MakeUnique<D3D11DynamicRingBuffer>(device, g_uploadRingSize, D3D11_BIND_VERTEX_BUFFER, 16u);
+
+    #endif // /LLGL_D3D11_ENABLE_FEATURELEVEL
+}
 
 } // /namespace LLGL
 
@@ -12,8 +12,11 @@
 #include "../../DXCommon/ComPtr.h"
 #include "../Shader/D3D11BuiltinShaderFactory.h"
 #include "../Buffer/D3D11IntermediateBufferPool.h"
+#include "../Buffer/D3D11DynamicRingBuffer.h"
 #include <LLGL/PipelineStateFlags.h>
 #include <vector>
+#include <bitset>
+#include <memory>
 #include <cstdint>
 #include "../Direct3D11.h"
 
@@ -94,21 +97,67 @@ class D3D11StateManager
             long                                stageFlags
         );
 
+        /*
+        Deferred variants of SetConstantBuffers, SetShaderResources, and SetSamplers for a single slot.
+        Bindings are only recorded and submitted with FlushBindings, which must be called before each draw or dispatch command.
+        Slots that have not changed are dropped and contiguous ranges of dirty slots are bound with a single call per shader stage.
+        */
+        void SetConstantBufferDeferred(UINT slot, ID3D11Buffer* buffer, long stageFlags);
+        void SetShaderResourceDeferred(UINT slot, ID3D11ShaderResourceView* view, long stageFlags);
+        void SetSamplerDeferred(UINT slot, ID3D11SamplerState* sampler, long stageFlags);
+
+        // Submits all pending deferred bindings to the device context.
+        inline void FlushBindings()
+        {
+            if (dirtyBindingStages_ != 0)
+                FlushDirtyBindings();
+        }
+
+        /*
+        Invalidates the cache of deferred bindings but keeps all pending bindings.
+        Must be called whenever resources have been bound to the device context without this state manager,
+        or whenever the runtime might have unbound shader resources implicitly (e.g. to resolve read/write hazards).
+        */
+        void InvalidateBindings();
+
         // Binds an intermediate constant buffer and updates its content with the specified data.
         void SetConstants(std::uint32_t slot, const void* data, std::uint16_t dataSize, long stageFlags);
 
         // Executes the specified builtin compute shader.
         void DispatchBuiltin(const D3D11BuiltinShader builtinShader, UINT numWorkGroupsX, UINT numWorkGroupsY, UINT numWorkGroupsZ);
 
+        /*
+        Copies the specified data into the destination buffer range via the upload ring buffer.
+        Returns false if there is no upload ring buffer or the data doesn't fit into it, in which case the caller must update the buffer by other means.
+        */
+        bool WriteBufferStaged(ID3D11Buffer* dstBuffer, UINT dstOffset, const void* data, UINT dataSize);
+
         // Must be called in D3D11CommandBuffer::Begin
         void ResetIntermediateBufferPools();
 
+        // Invalidates all cached states. Must be called whenever the device context has been reset to its default state, e.g. after ExecuteCommandList.
+        void ResetStateCache();
+
         // Returns the ID3D11DeviceContext that this state manager is associated with.
         inline ID3D11DeviceContext* GetContext() const
         {
             return context_.Get();
         }
 
+    private:
+
+        void CreateRingBuffers(ID3D11Device* device);
+
+        void FlushDirtyBindings();
+
+        // Stores the specified bindings as known state of the device context and discards the pending bindings of those slots.
+        void StoreKnownBindings(UINT startSlot, UINT count, ID3D11Buffer* const* buffers, long stageFlags);
+        void StoreKnownBindings(UINT startSlot, UINT count, ID3D11ShaderResourceView* const* views, long stageFlags);
+        void StoreKnownBindings(UINT startSlot, UINT count, ID3D11SamplerState* const* samplers, long stageFlags);
+
+        // Discards the known state and pending bindings of the specified constant buffer slots.
+        void ForgetConstantBufferBindings(UINT startSlot, UINT count, long stageFlags);
+
     private:
 
         struct D3DInputAssemblyState
@@ -137,6 +186,27 @@ class D3D11StateManager
             UINT                        sampleMask          = 0xffffffff;
         };
 
+        // Slot table of one resource type for a single shader stage.
+        template <typename T, std::size_t N>
+        struct D3DBindingSlots
+        {
+            T                   slots[N]    = {};
+            std::bitset<N>      dirty;              // Slots that must be submitted with the next flush
+            std::bitset<N>      known;              // Slots whose value is known to be bound to the device context
+            UINT                dirtyBegin  = N;
+            UINT                dirtyEnd    = 0;
+        };
+
+        struct D3DStageBindings
+        {
+            D3DBindingSlots<ID3D11Buffer*, D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT>              cbvs;
+            D3DBindingSlots<ID3D11ShaderResourceView*, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT>      srvs;
+            D3DBindingSlots<ID3D11SamplerState*, D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT>                    samplers;
+        };
+
+        // Number of shader stages with resource bindings: VS, HS, DS, GS, PS, CS.
+        static const UINT g_numBindingStages = 6;
+
     private:
 
         ComPtr<ID3D11DeviceContext>     context_;
@@ -147,10 +217,17 @@ class D3D11StateManager
 
         D3D11IntermediateBufferPool     intermediateCbufferPool_;
 
+        /* Ring buffers with D3D11_MAP_WRITE_NO_OVERWRITE; only available with Direct3D 11.1 */
+        std::unique_ptr<D3D11DynamicRingBuffer> cbufferRing_;
+        std::unique_ptr<D3D11DynamicRingBuffer> uploadRing_;
+
         D3DInputAssemblyState           inputAssemblyState_;
         D3DShaderState                  shaderState_;
         D3DRenderState                  renderState_;
 
+        D3DStageBindings                stageBindings_[g_numBindingStages];
+        std::uint32_t                   dirtyBindingStages_     = 0;        // Bitmask of stages with pending bindings
+
 };
 
 
@@ -0,0 +1,216 @@
+/*
+ * D3D11StatePool.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D11StatePool.h"
+#include "../D3D11Types.h"
+#include "../../DXCommon/DXCore.h"
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+D3D11StatePool& D3D11StatePool::Get()
+{
+    static D3D11StatePool g_instance;
+    return g_instance;
+}
+
+void D3D11StatePool::Clear()
+{
+    depthStencilStates_.clear();
+    rasterizerStates_.clear();
+    blendStates_.clear();
+}
+
+/* ----- Depth-stencil states ----- */
+
+ComPtr<ID3D11DepthStencilState> D3D11StatePool::AcquireDepthStencilState(ID3D11Device* device, const DepthDescriptor& depthDesc, const StencilDescriptor& stencilDesc)
+{
+    D3D11_DEPTH_STENCIL_DESC descDX;
+    ::memset(&descDX, 0, sizeof(descDX));
+    D3D11Types::Convert(descDX, depthDesc, stencilDesc);
+
+    return AcquireEntry<ID3D11DepthStencilState>(
+        depthStencilStates_,
+        descDX,
+        [device](const D3D11_DEPTH_STENCIL_DESC& desc, ID3D11DepthStencilState** state)
+        {
+            auto hr = device->CreateDepthStencilState(&desc, state);
+            DXThrowIfFailed(hr, "failed to create D3D11 depth-stencil state");
+        }
+    );
+}
+
+void D3D11StatePool::ReleaseDepthStencilState(ID3D11DepthStencilState* depthStencilState)
+{
+    ReleaseEntry(depthStencilStates_, depthStencilState);
+}
+
+/* ----- Rasterizer states ----- */
+
+ComPtr<ID3D11RasterizerState> D3D11StatePool::AcquireRasterizerState(ID3D11Device* device, const RasterizerDescriptor& rasterizerDesc)
+{
+    D3D11_RASTERIZER_DESC descDX;
+    ::memset(&descDX, 0, sizeof(descDX));
+    D3D11Types::Convert(descDX, rasterizerDesc);
+
+    return AcquireEntry<ID3D11RasterizerState>(
+        rasterizerStates_,
+        descDX,
+        [device](const D3D11_RASTERIZER_DESC& desc, ID3D11RasterizerState** state)
+        {
+            auto hr = device->CreateRasterizerState(&desc, state);
+            DXThrowIfFailed(hr, "failed to create D3D11 rasterizer state");
+        }
+    );
+}
+
+#if LLGL_D3D11_ENABLE_FEATURELEVEL >= 3
+
+ComPtr<ID3D11RasterizerState2> D3D11StatePool::AcquireRasterizerState2(ID3D11Device3* device, const RasterizerDescriptor& rasterizerDesc)
+{
+    D3D11_RASTERIZER_DESC2 descDX;
+    ::memset(&descDX, 0, sizeof(descDX));
+    D3D11Types::Convert(descDX, rasterizerDesc);
+
+    return AcquireEntry<ID3D11RasterizerState2>(
+        rasterizerStates_,
+        descDX,
+        [device](const D3D11_RASTERIZER_DESC2& desc, ID3D11RasterizerState2** state)
+        {
+            auto hr = device->CreateRasterizerState2(&desc, state);
+            DXThrowIfFailed(hr, "failed to create D3D11 rasterizer state");
+        }
+    );
+}
+
+#endif // /LLGL_D3D11_ENABLE_FEATURELEVEL
+
+void D3D11StatePool::ReleaseRasterizerState(ID3D11RasterizerState* rasterizerState)
+{
+    ReleaseEntry(rasterizerStates_, rasterizerState);
+}
+
+/* ----- Blend states ----- */
+
+ComPtr<ID3D11BlendState> D3D11StatePool::AcquireBlendState(ID3D11Device* device, const BlendDescriptor& blendDesc)
+{
+    D3D11_BLEND_DESC descDX;
+    ::memset(&descDX, 0, sizeof(descDX));
+    D3D11Types::Convert(descDX, blendDesc);
+
+    return AcquireEntry<ID3D11BlendState>(
+        blendStates_,
+        descDX,
+        [device](const D3D11_BLEND_DESC& desc, ID3D11BlendState** state)
+        {
+            auto hr = device->CreateBlendState(&desc, state);
+            DXThrowIfFailed(hr, "failed to create D3D11 blend state");
+        }
+    );
+}
+
+#if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+
+ComPtr<ID3D11BlendState1> D3D11StatePool::AcquireBlendState1(ID3D11Device1* device, const BlendDescriptor& blendDesc)
+{
+    D3D11_BLEND_DESC1 descDX;
+    ::memset(&descDX, 0, sizeof(descDX));
+    D3D11Types::Convert(descDX, blendDesc);
+
+    return AcquireEntry<ID3D11BlendState1>(
+        blendStates_,
+        descDX,
+        [device](const D3D11_BLEND_DESC1& desc, ID3D11BlendState1** state)
+        {
+            auto hr = device->CreateBlendState1(&desc, state);
+            DXThrowIfFailed(hr, "failed to create D3D11 blend state");
+        }
+    );
+}
+
+#endif // /LLGL_D3D11_ENABLE_FEATURELEVEL
+
+void D3D11StatePool::ReleaseBlendState(ID3D11BlendState* blendState)
+{
+    ReleaseEntry(blendStates_, blendState);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+// Returns the FNV-1a hash of the specified native descriptor. The descriptor must be zero-initialized before it is filled, so padding bytes are deterministic.
+static std::size_t HashNativeDesc(const void* nativeDesc, std::size_t size)
+{
+    auto data = reinterpret_cast<const std::uint8_t*>(nativeDesc);
+
+    std::uint64_t hash = 14695981039346656037ull;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+
+    return static_cast<std::size_t>(hash);
+}
+
+template <typename TState, typename TNativeDesc, typename TCreateFunc>
+ComPtr<TState> D3D11StatePool::AcquireEntry(std::vector<Entry>& entries, const TNativeDesc& nativeDesc, TCreateFunc createFunc)
+{
+    const auto hash = HashNativeDesc(&nativeDesc, sizeof(nativeDesc));
+
+    ComPtr<TState> stateObject;
+
+    /* Find identical state object */
+    for (auto& entry : entries)
+    {
+        if (entry.hash == hash &&
+            entry.nativeDesc.size() == sizeof(nativeDesc) &&
+            ::memcmp(entry.nativeDesc.data(), &nativeDesc, sizeof(nativeDesc)) == 0)
+        {
+            auto hr = entry.stateObject.As(&stateObject);
+            DXThrowIfFailed(hr, "failed to query interface of pooled D3D11 state object");
+            ++entry.refCount;
+            return stateObject;
+        }
+    }
+
+    /* Create new state object */
+    createFunc(nativeDesc, stateObject.ReleaseAndGetAddressOf());
+
+    const auto nativeDescBytes = reinterpret_cast<const char*>(&nativeDesc);
+    entries.push_back({ hash, std::vector<char>(nativeDescBytes, nativeDescBytes + sizeof(nativeDesc)), stateObject, 1 });
+
+    return stateObject;
+}
+
+void D3D11StatePool::ReleaseEntry(std::vector<Entry>& entries, ID3D11DeviceChild* stateObject)
+{
+    if (stateObject == nullptr)
+        return;
+
+    for (auto it = entries.begin(); it != entries.end(); ++it)
+    {
+        if (it->stateObject.Get() == stateObject)
+        {
+            if (--it->refCount == 0)
+                entries.erase(it);
+            return;
+        }
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
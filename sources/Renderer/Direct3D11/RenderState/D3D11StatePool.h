@@ -0,0 +1,108 @@
+/*
+ * D3D11StatePool.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D11_STATE_POOL_H
+#define LLGL_D3D11_STATE_POOL_H
+
+
+#include <LLGL/PipelineStateFlags.h>
+#include "../../DXCommon/ComPtr.h"
+#include "../Direct3D11.h"
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Singleton pool of reference counted depth-stencil-, rasterizer-, and blend states that are shared between all graphics PSOs.
+State objects are identified by a hash of their native descriptor, so PSOs with identical sub-states share the same objects
+and the D3D11StateManager can skip redundant OM/RS set calls when switching between such PSOs.
+*/
+class D3D11StatePool
+{
+
+    public:
+
+        D3D11StatePool(const D3D11StatePool&) = delete;
+        D3D11StatePool& operator = (const D3D11StatePool&) = delete;
+
+        // Returns the instance of this singleton.
+        static D3D11StatePool& Get();
+
+        // Clears all pooled state objects (used by D3D11RenderSystem).
+        void Clear();
+
+        /* ----- Depth-stencil states ----- */
+
+        ComPtr<ID3D11DepthStencilState> AcquireDepthStencilState(ID3D11Device* device, const DepthDescriptor& depthDesc, const StencilDescriptor& stencilDesc);
+        void ReleaseDepthStencilState(ID3D11DepthStencilState* depthStencilState);
+
+        /* ----- Rasterizer states ----- */
+
+        ComPtr<ID3D11RasterizerState> AcquireRasterizerState(ID3D11Device* device, const RasterizerDescriptor& rasterizerDesc);
+
+        #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 3
+        ComPtr<ID3D11RasterizerState2> AcquireRasterizerState2(ID3D11Device3* device, const RasterizerDescriptor& rasterizerDesc);
+        #endif
+
+        void ReleaseRasterizerState(ID3D11RasterizerState* rasterizerState);
+
+        /* ----- Blend states ----- */
+
+        ComPtr<ID3D11BlendState> AcquireBlendState(ID3D11Device* device, const BlendDescriptor& blendDesc);
+
+        #if LLGL_D3D11_ENABLE_FEATURELEVEL >= 1
+        ComPtr<ID3D11BlendState1> AcquireBlendState1(ID3D11Device1* device, const BlendDescriptor& blendDesc);
+        #endif
+
+        void ReleaseBlendState(ID3D11BlendState* blendState);
+
+    private:
+
+        struct Entry
+        {
+            std::size_t                 hash;
+            std::vector<char>           nativeDesc;
+            ComPtr<ID3D11DeviceChild>   stateObject;
+            std::uint32_t               refCount;
+        };
+
+    private:
+
+        D3D11StatePool() = default;
+
+        /*
+        Returns the state object with the specified native descriptor and increments its reference counter.
+        A new state object is created with the specified function if there is no identical one yet.
+        */
+        template <typename TState, typename TNativeDesc, typename TCreateFunc>
+        static ComPtr<TState> AcquireEntry(std::vector<Entry>& entries, const TNativeDesc& nativeDesc, TCreateFunc createFunc);
+
+        // Decrements the reference counter of the specified state object and removes it from the pool if it is no longer referenced.
+        static void ReleaseEntry(std::vector<Entry>& entries, ID3D11DeviceChild* stateObject);
+
+    private:
+
+        /* Descriptors of different size (e.g. D3D11_BLEND_DESC and D3D11_BLEND_DESC1) never compare equal, so they share the same container */
+        std::vector<Entry> depthStencilStates_;
+        std::vector<Entry> rasterizerStates_;
+        std::vector<Entry> blendStates_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
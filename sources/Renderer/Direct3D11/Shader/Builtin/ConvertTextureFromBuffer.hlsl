@@ -0,0 +1,103 @@
+/*
+ * ConvertTextureFromBuffer.hlsl
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+/*
+Expands 8-bit RGB, BGR, and BGRA source images from a raw buffer into RGBA8 textures.
+This replaces the CPU conversion with ConvertImageBuffer for image formats that have no native texture format.
+Each thread converts 4 consecutive texels of a row with a single 12- or 16-byte raw buffer load.
+This file is self-contained, since it is embedded as source and compiled at runtime by the D3D11BuiltinShaderFactory.
+
+Macros:
+  TEXTURE_DIM = 2, 3
+  SRC_FORMAT  = 1 (RGB8), 2 (BGR8), 3 (BGRA8)
+*/
+
+
+#define NUM_THREADS         (64)
+#define TEXELS_PER_THREAD   (4)
+
+#if SRC_FORMAT == 3
+#   define SRC_TEXEL_SIZE   (4)
+#else
+#   define SRC_TEXEL_SIZE   (3)
+#endif
+
+
+/* Conversion descriptor constant buffer */
+cbuffer ConvertDescriptor : register(b0)
+{
+    uint3   texOffset;
+    uint    bufOffset;      // Source buffer offset: multiple of 4
+    uint3   texExtent;
+    uint    rowStride;      // Source row stride: multiple of 4
+    uint    layerStride;    // Source layer stride: multiple of 4
+};
+
+
+/* Texture must have an unsigned integer format, i.e. DXGI_FORMAT_R8G8B8A8_UINT */
+ByteAddressBuffer srcBuffer : register(t0);
+
+#if TEXTURE_DIM == 2
+RWTexture2DArray<uint4> dstTexture : register(u0);
+#elif TEXTURE_DIM == 3
+RWTexture3D<uint4> dstTexture : register(u0);
+#endif
+
+
+/* Returns the byte at the specified index of the 4 source words */
+uint GetByte(uint words[4], uint index)
+{
+    return ((words[index / 4] >> ((index % 4) * 8)) & 0xFF);
+}
+
+/* Expands the texel that starts at the specified byte index to RGBA */
+uint4 ConvertTexel(uint words[4], uint index)
+{
+    #if SRC_FORMAT == 3
+    uint alpha = GetByte(words, index + 3);
+    #else
+    uint alpha = 0xFF;
+    #endif
+
+    #if SRC_FORMAT == 1
+    return uint4(GetByte(words, index), GetByte(words, index + 1), GetByte(words, index + 2), alpha);
+    #else
+    return uint4(GetByte(words, index + 2), GetByte(words, index + 1), GetByte(words, index), alpha);
+    #endif
+}
+
+
+/* Primary compute kernel to convert 4 consecutive source texels */
+[numthreads(NUM_THREADS, 1, 1)]
+void ConvertTextureFromBuffer(uint3 threadID : SV_DispatchThreadID)
+{
+    uint3 coord = uint3(threadID.x * TEXELS_PER_THREAD, threadID.yz);
+    if (coord.x >= texExtent.x)
+        return;
+
+    /* Read 4 texels from source buffer; out of bounds reads of raw buffers return zero */
+    uint addr = bufOffset + coord.y * rowStride + coord.z * layerStride + coord.x * SRC_TEXEL_SIZE;
+
+    #if SRC_FORMAT == 3
+    uint4 chunk = srcBuffer.Load4(addr);
+    #else
+    uint4 chunk = uint4(srcBuffer.Load3(addr), 0);
+    #endif
+
+    uint words[4] = { chunk.x, chunk.y, chunk.z, chunk.w };
+
+    /* Write expanded texels to destination texture */
+    uint3 pos = texOffset + coord;
+
+    [unroll]
+    for (uint i = 0; i < TEXELS_PER_THREAD; ++i)
+    {
+        if (coord.x + i < texExtent.x)
+            dstTexture[pos + uint3(i, 0, 0)] = ConvertTexel(words, i * SRC_TEXEL_SIZE);
+    }
+}
+
@@ -0,0 +1,271 @@
+/*
+ * CopyTextureBufferPacked.hlsl
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+/*
+Format-specialized variants of CopyTextureFromBuffer.hlsl and CopyBufferFromTexture.hlsl.
+Each thread copies 4 consecutive texels of a row with 16-byte raw buffer loads or stores,
+so consecutive threads access consecutive memory. This file is self-contained,
+since it is embedded as source and compiled at runtime by the D3D11BuiltinShaderFactory.
+
+Macros:
+  TEXTURE_DIM   = 1, 2, 3
+  PACKED_FORMAT = 1 (RGBA8), 2 (R32), 3 (RGBA16), 4 (RGBA32)
+  COPY_TEXTURE_FROM_BUFFER is defined for the CopyTextureFromBuffer kernel
+*/
+
+
+#define NUM_THREADS         (64)
+#define TEXELS_PER_THREAD   (4)
+
+#if PACKED_FORMAT == 3
+#   define TEXEL_SIZE       (8)
+#elif PACKED_FORMAT == 4
+#   define TEXEL_SIZE       (16)
+#else
+#   define TEXEL_SIZE       (4)
+#endif
+
+
+/* Copy descriptor constant buffer; must be equal to the one in CopyTextureBuffer.hlsli */
+cbuffer CopyDescriptor : register(b0)
+{
+    uint3   texOffset;
+    uint    bufOffset;      // Source buffer offset: multiple of 4
+    uint3   texExtent;
+    uint    bufIndexStride; // Source index stride: 4, 8, 16, 32
+    uint    formatSize;     // Bytes per pixel: 1, 2, 4, 8, 12, 16
+    uint    components;     // Destination color components: 1, 2, 3, 4
+    uint    componentBits;  // Bits per component: 8, 16, 32
+    uint    rowStride;
+    uint    layerStride;
+};
+
+
+/* Textures must have an unsigned integer format, e.g. DXGI_FORMAT_R8G8B8A8_UINT */
+#ifdef COPY_TEXTURE_FROM_BUFFER
+
+ByteAddressBuffer srcBuffer : register(t0);
+
+#if TEXTURE_DIM == 1
+RWTexture1DArray<uint4> dstTexture : register(u0);
+#elif TEXTURE_DIM == 2
+RWTexture2DArray<uint4> dstTexture : register(u0);
+#elif TEXTURE_DIM == 3
+RWTexture3D<uint4> dstTexture : register(u0);
+#endif
+
+#else
+
+RWByteAddressBuffer dstBuffer : register(u0);
+
+#if TEXTURE_DIM == 1
+Texture1DArray<uint4> srcTexture : register(t0);
+#elif TEXTURE_DIM == 2
+Texture2DArray<uint4> srcTexture : register(t0);
+#elif TEXTURE_DIM == 3
+Texture3D<uint4> srcTexture : register(t0);
+#endif
+
+#endif // /COPY_TEXTURE_FROM_BUFFER
+
+
+/* Returns the buffer address of the first texel in the specified row */
+uint GetRowAddress(uint3 coord)
+{
+    uint rowSize    = texExtent.x * TEXEL_SIZE;
+    uint rowPitch   = max(rowStride, rowSize);
+    uint layerPitch = max(layerStride, rowPitch * texExtent.y);
+    return bufOffset + coord.y * rowPitch + coord.z * layerPitch;
+}
+
+/* Converts a single texel between its memory layout and the UINT texture components */
+#if PACKED_FORMAT == 1
+
+#define TEXEL_TYPE uint
+
+uint4 UnpackTexel(uint value)
+{
+    return uint4(value & 0xFF, (value >> 8) & 0xFF, (value >> 16) & 0xFF, value >> 24);
+}
+
+uint PackTexel(uint4 value)
+{
+    return ((value.r & 0xFF) | ((value.g & 0xFF) << 8) | ((value.b & 0xFF) << 16) | ((value.a & 0xFF) << 24));
+}
+
+#elif PACKED_FORMAT == 2
+
+#define TEXEL_TYPE uint
+
+uint4 UnpackTexel(uint value)
+{
+    return uint4(value, 0, 0, 0);
+}
+
+uint PackTexel(uint4 value)
+{
+    return value.r;
+}
+
+#elif PACKED_FORMAT == 3
+
+#define TEXEL_TYPE uint2
+
+uint4 UnpackTexel(uint2 value)
+{
+    return uint4(value.x & 0xFFFF, value.x >> 16, value.y & 0xFFFF, value.y >> 16);
+}
+
+uint2 PackTexel(uint4 value)
+{
+    return uint2((value.r & 0xFFFF) | ((value.g & 0xFFFF) << 16), (value.b & 0xFFFF) | ((value.a & 0xFFFF) << 16));
+}
+
+#elif PACKED_FORMAT == 4
+
+#define TEXEL_TYPE uint4
+
+uint4 UnpackTexel(uint4 value)
+{
+    return value;
+}
+
+uint4 PackTexel(uint4 value)
+{
+    return value;
+}
+
+#endif
+
+/* Loads or stores 4 consecutive texels with 16-byte raw buffer accesses */
+#ifdef COPY_TEXTURE_FROM_BUFFER
+
+void LoadTexels(uint addr, out TEXEL_TYPE texels[TEXELS_PER_THREAD])
+{
+    #if PACKED_FORMAT == 1 || PACKED_FORMAT == 2
+    uint4 chunk = srcBuffer.Load4(addr);
+    texels[0] = chunk.x;
+    texels[1] = chunk.y;
+    texels[2] = chunk.z;
+    texels[3] = chunk.w;
+    #elif PACKED_FORMAT == 3
+    uint4 chunk0 = srcBuffer.Load4(addr);
+    uint4 chunk1 = srcBuffer.Load4(addr + 16);
+    texels[0] = chunk0.xy;
+    texels[1] = chunk0.zw;
+    texels[2] = chunk1.xy;
+    texels[3] = chunk1.zw;
+    #else
+    [unroll]
+    for (uint i = 0; i < TEXELS_PER_THREAD; ++i)
+        texels[i] = srcBuffer.Load4(addr + i * 16);
+    #endif
+}
+
+#else
+
+void StoreTexels(uint addr, TEXEL_TYPE texels[TEXELS_PER_THREAD])
+{
+    #if PACKED_FORMAT == 1 || PACKED_FORMAT == 2
+    dstBuffer.Store4(addr, uint4(texels[0], texels[1], texels[2], texels[3]));
+    #elif PACKED_FORMAT == 3
+    dstBuffer.Store4(addr, uint4(texels[0], texels[1]));
+    dstBuffer.Store4(addr + 16, uint4(texels[2], texels[3]));
+    #else
+    [unroll]
+    for (uint i = 0; i < TEXELS_PER_THREAD; ++i)
+        dstBuffer.Store4(addr + i * 16, texels[i]);
+    #endif
+}
+
+void StoreTexel(uint addr, TEXEL_TYPE texel)
+{
+    #if PACKED_FORMAT == 1 || PACKED_FORMAT == 2
+    dstBuffer.Store(addr, texel);
+    #elif PACKED_FORMAT == 3
+    dstBuffer.Store2(addr, texel);
+    #else
+    dstBuffer.Store4(addr, texel);
+    #endif
+}
+
+#endif // /COPY_TEXTURE_FROM_BUFFER
+
+uint3 GetTexturePosition(uint3 coord)
+{
+    return texOffset + coord;
+}
+
+#if TEXTURE_DIM == 1
+#   define TEXTURE_INDEX(POS) (POS).xy
+#else
+#   define TEXTURE_INDEX(POS) (POS)
+#endif
+
+
+#ifdef COPY_TEXTURE_FROM_BUFFER
+
+/* Primary compute kernel to copy 4 buffer values into consecutive texels */
+[numthreads(NUM_THREADS, 1, 1)]
+void CopyTextureFromBuffer(uint3 threadID : SV_DispatchThreadID)
+{
+    uint3 coord = uint3(threadID.x * TEXELS_PER_THREAD, threadID.yz);
+    if (coord.x >= texExtent.x)
+        return;
+
+    /* Read 4 texels from source buffer; out of bounds reads of raw buffers return zero */
+    TEXEL_TYPE texels[TEXELS_PER_THREAD];
+    LoadTexels(GetRowAddress(coord) + coord.x * TEXEL_SIZE, texels);
+
+    /* Write texels to destination texture */
+    uint3 pos = GetTexturePosition(coord);
+
+    [unroll]
+    for (uint i = 0; i < TEXELS_PER_THREAD; ++i)
+    {
+        if (coord.x + i < texExtent.x)
+            dstTexture[TEXTURE_INDEX(pos + uint3(i, 0, 0))] = UnpackTexel(texels[i]);
+    }
+}
+
+#else
+
+/* Primary compute kernel to copy 4 consecutive texels into buffer values */
+[numthreads(NUM_THREADS, 1, 1)]
+void CopyBufferFromTexture(uint3 threadID : SV_DispatchThreadID)
+{
+    uint3 coord = uint3(threadID.x * TEXELS_PER_THREAD, threadID.yz);
+    if (coord.x >= texExtent.x)
+        return;
+
+    /* Read texels from source texture */
+    uint3 pos = GetTexturePosition(coord);
+
+    TEXEL_TYPE texels[TEXELS_PER_THREAD];
+
+    [unroll]
+    for (uint i = 0; i < TEXELS_PER_THREAD; ++i)
+        texels[i] = PackTexel(srcTexture[TEXTURE_INDEX(pos + uint3(i, 0, 0))]);
+
+    /* Write texels to destination buffer; only write texels within the extent at the end of a row */
+    uint addr = GetRowAddress(coord) + coord.x * TEXEL_SIZE;
+
+    if (coord.x + TEXELS_PER_THREAD <= texExtent.x)
+        StoreTexels(addr, texels);
+    else
+    {
+        [unroll]
+        for (uint i = 0; i < TEXELS_PER_THREAD; ++i)
+        {
+            if (coord.x + i < texExtent.x)
+                StoreTexel(addr + i * TEXEL_SIZE, texels[i]);
+        }
+    }
+}
+
+#endif // /COPY_TEXTURE_FROM_BUFFER
+
@@ -17,6 +17,9 @@
 #define LLGL_IDR_D3D11_COPYBUFFERFROMTEXTURE2D_CS 1105
 #define LLGL_IDR_D3D11_COPYBUFFERFROMTEXTURE3D_CS 1106
 
+#define LLGL_IDR_D3D11_COPYTEXTUREBUFFERPACKED_HLSL 1107
+#define LLGL_IDR_D3D11_CONVERTTEXTUREFROMBUFFER_HLSL 1108
+
 
 #endif
 
@@ -9,6 +9,7 @@
 #include "Builtin/D3D11Builtin.h"
 #include "../../DXCommon/DXCore.h"
 #include "../../DXCommon/DXTypes.h"
+#include <d3dcompiler.h>
 #include <stdexcept>
 
 
@@ -24,6 +25,9 @@ D3D11BuiltinShaderFactory& D3D11BuiltinShaderFactory::Get()
 
 void D3D11BuiltinShaderFactory::CreateBuiltinShaders(ID3D11Device* device)
 {
+    /* Store device to compile format-specialized shaders on demand */
+    device_ = device;
+
     LoadBuiltinShader(device, D3D11BuiltinShader::CopyTexture1DFromBufferCS, LLGL_IDR_D3D11_COPYTEXTURE1DFROMBUFFER_CS);
     LoadBuiltinShader(device, D3D11BuiltinShader::CopyTexture2DFromBufferCS, LLGL_IDR_D3D11_COPYTEXTURE2DFROMBUFFER_CS);
     LoadBuiltinShader(device, D3D11BuiltinShader::CopyTexture3DFromBufferCS, LLGL_IDR_D3D11_COPYTEXTURE3DFROMBUFFER_CS);
@@ -36,6 +40,9 @@ void D3D11BuiltinShaderFactory::Clear()
 {
     for (auto& native : builtinShaders_)
         native.vs = nullptr;
+    for (auto& compiled : compiledBuiltinShaders_)
+        compiled = false;
+    device_.Reset();
 }
 
 const D3D11NativeShader& D3D11BuiltinShaderFactory::GetBulitinShader(const D3D11BuiltinShader builtin) const
@@ -47,6 +54,116 @@ const D3D11NativeShader& D3D11BuiltinShaderFactory::GetBulitinShader(const D3D11
         return builtinShaders_[0];
 }
 
+static bool IsPackedCopyShader(const D3D11BuiltinShader builtin)
+{
+    return (builtin >= D3D11BuiltinShader::CopyTexture1DFromBufferRGBA8CS && builtin < D3D11BuiltinShader::ConvertTexture2DFromBufferRGB8CS);
+}
+
+static bool IsConvertShader(const D3D11BuiltinShader builtin)
+{
+    return (builtin >= D3D11BuiltinShader::ConvertTexture2DFromBufferRGB8CS && builtin < D3D11BuiltinShader::Num);
+}
+
+bool D3D11BuiltinShaderFactory::HasBuiltinShader(const D3D11BuiltinShader builtin)
+{
+    const auto idx = static_cast<std::size_t>(builtin);
+    if (idx >= D3D11BuiltinShaderFactory::g_numBuiltinShaders)
+        return false;
+
+    /* Compile format-specialized shader on first use */
+    if ((IsPackedCopyShader(builtin) || IsConvertShader(builtin)) && !compiledBuiltinShaders_[idx] && device_)
+    {
+        compiledBuiltinShaders_[idx] = true;
+        CompileBuiltinShader(device_.Get(), builtin);
+    }
+
+    return (builtinShaders_[idx].cs != nullptr);
+}
+
+// Returns the index of the packed format: 0 (RGBA8), 1 (R32), 2 (RGBA16), 3 (RGBA32), or -1 if there is no specialized shader for this format.
+static int GetPackedCopyFormatIndex(const FormatAttributes& formatAttribs)
+{
+    if (formatAttribs.blockWidth != 1 || formatAttribs.blockHeight != 1)
+        return -1;
+    if (formatAttribs.components == 4 && formatAttribs.bitSize ==  32) { return 0; }
+    if (formatAttribs.components == 1 && formatAttribs.bitSize ==  32) { return 1; }
+    if (formatAttribs.components == 4 && formatAttribs.bitSize ==  64) { return 2; }
+    if (formatAttribs.components == 4 && formatAttribs.bitSize == 128) { return 3; }
+    return -1;
+}
+
+static int GetPackedCopyDimensionIndex(const TextureType textureArrayType)
+{
+    switch (textureArrayType)
+    {
+        case TextureType::Texture1DArray:   return 0;
+        case TextureType::Texture2DArray:   return 1;
+        case TextureType::Texture3D:        return 2;
+        default:                            return -1;
+    }
+}
+
+bool D3D11BuiltinShaderFactory::SelectPackedCopyShader(
+    bool                    copyTextureFromBuffer,
+    const TextureType       textureArrayType,
+    const FormatAttributes& formatAttribs,
+    D3D11BuiltinShader&     outBuiltin)
+{
+    const int formatIndex       = GetPackedCopyFormatIndex(formatAttribs);
+    const int dimensionIndex    = GetPackedCopyDimensionIndex(textureArrayType);
+    if (formatIndex < 0 || dimensionIndex < 0)
+        return false;
+
+    /* Packed copy shaders are ordered by direction, dimension, and format */
+    const auto first = (copyTextureFromBuffer ? D3D11BuiltinShader::CopyTexture1DFromBufferRGBA8CS : D3D11BuiltinShader::CopyBufferFromTexture1DRGBA8CS);
+    outBuiltin = static_cast<D3D11BuiltinShader>(static_cast<int>(first) + dimensionIndex * 4 + formatIndex);
+
+    return true;
+}
+
+// Returns the index of the source format: 0 (RGB8), 1 (BGR8), 2 (BGRA8), or -1 if there is no conversion shader for this format.
+static int GetConvertFormatIndex(const ImageFormat srcFormat)
+{
+    switch (srcFormat)
+    {
+        case ImageFormat::RGB:  return 0;
+        case ImageFormat::BGR:  return 1;
+        case ImageFormat::BGRA: return 2;
+        default:                return -1;
+    }
+}
+
+bool D3D11BuiltinShaderFactory::SelectConvertShader(
+    const TextureType       textureArrayType,
+    const ImageFormat       srcFormat,
+    const DataType          srcDataType,
+    const FormatAttributes& dstFormatAttribs,
+    D3D11BuiltinShader&     outBuiltin)
+{
+    /* Conversion shaders only expand 8-bit unsigned source images into RGBA8 textures */
+    if (srcDataType != DataType::UInt8 || dstFormatAttribs.dataType != DataType::UInt8 || dstFormatAttribs.format != ImageFormat::RGBA)
+        return false;
+    if ((dstFormatAttribs.flags & FormatFlags::IsCompressed) != 0 || dstFormatAttribs.bitSize != 32)
+        return false;
+
+    const int formatIndex = GetConvertFormatIndex(srcFormat);
+    if (formatIndex < 0)
+        return false;
+
+    /* Conversion shaders are ordered by dimension and source format */
+    int dimensionIndex = 0;
+    switch (textureArrayType)
+    {
+        case TextureType::Texture2DArray:   dimensionIndex = 0; break;
+        case TextureType::Texture3D:        dimensionIndex = 1; break;
+        default:                            return false;
+    }
+
+    outBuiltin = static_cast<D3D11BuiltinShader>(static_cast<int>(D3D11BuiltinShader::ConvertTexture2DFromBufferRGB8CS) + dimensionIndex * 3 + formatIndex);
+
+    return true;
+}
+
 static ShaderType GetBuiltinShaderType(const D3D11BuiltinShader builtin)
 {
     switch (builtin)
@@ -58,6 +175,10 @@ static ShaderType GetBuiltinShaderType(const D3D11BuiltinShader builtin)
         case D3D11BuiltinShader::CopyBufferFromTexture2DCS:
         case D3D11BuiltinShader::CopyBufferFromTexture3DCS:
             return ShaderType::Compute;
+        default:
+            if (IsPackedCopyShader(builtin) || IsConvertShader(builtin))
+                return ShaderType::Compute;
+            break;
     }
     return ShaderType::Undefined;
 }
@@ -73,6 +194,86 @@ void D3D11BuiltinShaderFactory::LoadBuiltinShader(ID3D11Device* device, const D3
         throw std::runtime_error("failed to load builtin D3D11 shader resource");
 }
 
+void D3D11BuiltinShaderFactory::CompileBuiltinShader(ID3D11Device* device, const D3D11BuiltinShader builtin)
+{
+    const char* textureDims[] = { "1", "2", "3" };
+
+    if (IsConvertShader(builtin))
+    {
+        /* Derive macros from the order of the conversion shaders: dimension, source format */
+        const int   convertIndex    = static_cast<int>(builtin) - static_cast<int>(D3D11BuiltinShader::ConvertTexture2DFromBufferRGB8CS);
+        const char* srcFormats[]    = { "1", "2", "3" };
+
+        const D3D_SHADER_MACRO defines[] =
+        {
+            { "TEXTURE_DIM",    textureDims[1 + convertIndex / 3]   },
+            { "SRC_FORMAT",     srcFormats[convertIndex % 3]        },
+            { nullptr,          nullptr                             },
+        };
+
+        CompileBuiltinShaderFromResource(device, builtin, LLGL_IDR_D3D11_CONVERTTEXTUREFROMBUFFER_HLSL, defines, "ConvertTextureFromBuffer");
+    }
+    else
+    {
+        /* Derive macros from the order of the packed copy shaders: direction, dimension, format */
+        const int   packedIndex             = static_cast<int>(builtin) - static_cast<int>(D3D11BuiltinShader::CopyTexture1DFromBufferRGBA8CS);
+        const bool  copyTextureFromBuffer   = (packedIndex < 12);
+        const char* packedFormats[]         = { "1", "2", "3", "4" };
+
+        D3D_SHADER_MACRO defines[] =
+        {
+            { "TEXTURE_DIM",    textureDims[(packedIndex % 12) / 4] },
+            { "PACKED_FORMAT",  packedFormats[packedIndex % 4]      },
+            { nullptr,          nullptr                             },
+            { nullptr,          nullptr                             },
+        };
+
+        if (copyTextureFromBuffer)
+            defines[2] = { "COPY_TEXTURE_FROM_BUFFER", "1" };
+
+        CompileBuiltinShaderFromResource(
+            device,
+            builtin,
+            LLGL_IDR_D3D11_COPYTEXTUREBUFFERPACKED_HLSL,
+            defines,
+            (copyTextureFromBuffer ? "CopyTextureFromBuffer" : "CopyBufferFromTexture")
+        );
+    }
+}
+
+void D3D11BuiltinShaderFactory::CompileBuiltinShaderFromResource(
+    ID3D11Device*               device,
+    const D3D11BuiltinShader    builtin,
+    int                         resourceID,
+    const D3D_SHADER_MACRO*     defines,
+    const char*                 entryPoint)
+{
+    if (auto source = DXCreateBlobFromResource(resourceID))
+    {
+        /* Compile shader source; the specialized shaders are optional, so errors are not reported */
+        ComPtr<ID3DBlob> byteCode;
+        ComPtr<ID3DBlob> errors;
+        auto hr = D3DCompile(
+            source->GetBufferPointer(),
+            source->GetBufferSize(),
+            nullptr,
+            defines,
+            nullptr,
+            entryPoint,
+            "cs_5_0",
+            D3DCOMPILE_OPTIMIZATION_LEVEL3,
+            0,
+            byteCode.ReleaseAndGetAddressOf(),
+            errors.ReleaseAndGetAddressOf()
+        );
+        if (SUCCEEDED(hr))
+        {
+            const auto idx = static_cast<std::size_t>(builtin);
+            builtinShaders_[idx] = D3D11Shader::CreateNativeShaderFromBlob(device, ShaderType::Compute, byteCode.Get());
+        }
+    }
+}
+
 
 } // /namespace LLGL
 
@@ -10,6 +10,9 @@
 
 
 #include "D3D11Shader.h"
+#include <LLGL/Format.h>
+#include <LLGL/TextureFlags.h>
+#include <cstdint>
 
 
 namespace LLGL
@@ -25,9 +28,50 @@ enum class D3D11BuiltinShader
     CopyBufferFromTexture1DCS,
     CopyBufferFromTexture2DCS,
     CopyBufferFromTexture3DCS,
+
+    /* Format-specialized copy shaders with 4 texels per thread, see CopyTextureBufferPacked.hlsl */
+    CopyTexture1DFromBufferRGBA8CS,
+    CopyTexture1DFromBufferR32CS,
+    CopyTexture1DFromBufferRGBA16CS,
+    CopyTexture1DFromBufferRGBA32CS,
+    CopyTexture2DFromBufferRGBA8CS,
+    CopyTexture2DFromBufferR32CS,
+    CopyTexture2DFromBufferRGBA16CS,
+    CopyTexture2DFromBufferRGBA32CS,
+    CopyTexture3DFromBufferRGBA8CS,
+    CopyTexture3DFromBufferR32CS,
+    CopyTexture3DFromBufferRGBA16CS,
+    CopyTexture3DFromBufferRGBA32CS,
+    CopyBufferFromTexture1DRGBA8CS,
+    CopyBufferFromTexture1DR32CS,
+    CopyBufferFromTexture1DRGBA16CS,
+    CopyBufferFromTexture1DRGBA32CS,
+    CopyBufferFromTexture2DRGBA8CS,
+    CopyBufferFromTexture2DR32CS,
+    CopyBufferFromTexture2DRGBA16CS,
+    CopyBufferFromTexture2DRGBA32CS,
+    CopyBufferFromTexture3DRGBA8CS,
+    CopyBufferFromTexture3DR32CS,
+    CopyBufferFromTexture3DRGBA16CS,
+    CopyBufferFromTexture3DRGBA32CS,
+
+    /* Conversion shaders that expand 8-bit RGB, BGR, and BGRA images into RGBA8 textures, see ConvertTextureFromBuffer.hlsl */
+    ConvertTexture2DFromBufferRGB8CS,
+    ConvertTexture2DFromBufferBGR8CS,
+    ConvertTexture2DFromBufferBGRA8CS,
+    ConvertTexture3DFromBufferRGB8CS,
+    ConvertTexture3DFromBufferBGR8CS,
+    ConvertTexture3DFromBufferBGRA8CS,
+
     Num
 };
 
+// Number of texels each thread of the format-specialized copy shaders processes along the X-axis.
+static const std::uint32_t g_packedCopyTexelsPerThread  = 4;
+
+// Number of threads per work group of the format-specialized copy shaders.
+static const std::uint32_t g_packedCopyNumThreads       = 64;
+
 // Builtin D3D11 shader factory singleton.
 class D3D11BuiltinShaderFactory
 {
@@ -49,17 +93,61 @@ class D3D11BuiltinShaderFactory
         // Returns the specified native builtin shader.
         const D3D11NativeShader& GetBulitinShader(const D3D11BuiltinShader builtin) const;
 
+        /*
+        Returns true if the specified builtin shader is available.
+        Format-specialized copy shaders and conversion shaders are compiled on first use, so this might fail if no shader compiler is available.
+        */
+        bool HasBuiltinShader(const D3D11BuiltinShader builtin);
+
+        /*
+        Selects the format-specialized copy shader for the specified texture type and format attributes.
+        Returns false if there is no specialized shader for this format, in which case the generic copy shader must be used.
+        */
+        static bool SelectPackedCopyShader(
+            bool                    copyTextureFromBuffer,
+            const TextureType       textureArrayType,
+            const FormatAttributes& formatAttribs,
+            D3D11BuiltinShader&     outBuiltin
+        );
+
+        /*
+        Selects the conversion shader to expand source images of the specified format into a texture with the specified format attributes.
+        Returns false if there is no conversion shader for this combination, in which case the image must be converted on the CPU.
+        */
+        static bool SelectConvertShader(
+            const TextureType       textureArrayType,
+            const ImageFormat       srcFormat,
+            const DataType          srcDataType,
+            const FormatAttributes& dstFormatAttribs,
+            D3D11BuiltinShader&     outBuiltin
+        );
+
     private:
 
         D3D11BuiltinShaderFactory() = default;
 
         void LoadBuiltinShader(ID3D11Device* device, const D3D11BuiltinShader builtin, int resourceID);
 
+        // Compiles the specified builtin shader from its embedded source.
+        void CompileBuiltinShader(ID3D11Device* device, const D3D11BuiltinShader builtin);
+
+        // Compiles the specified embedded shader source with the specified macros and stores the result for the builtin shader.
+        void CompileBuiltinShaderFromResource(
+            ID3D11Device*               device,
+            const D3D11BuiltinShader    builtin,
+            int                         resourceID,
+            const D3D_SHADER_MACRO*     defines,
+            const char*                 entryPoint
+        );
+
     private:
 
         static const std::size_t g_numBuiltinShaders = static_cast<std::size_t>(D3D11BuiltinShader::Num);
 
-        D3D11NativeShader builtinShaders_[D3D11BuiltinShaderFactory::g_numBuiltinShaders];
+        D3D11NativeShader   builtinShaders_[D3D11BuiltinShaderFactory::g_numBuiltinShaders];
+        bool                compiledBuiltinShaders_[D3D11BuiltinShaderFactory::g_numBuiltinShaders] = {};
+
+        ComPtr<ID3D11Device> device_;
 
 };
 
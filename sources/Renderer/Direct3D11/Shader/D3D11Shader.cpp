@@ -22,10 +22,15 @@ namespace LLGL
 {
 
 
-D3D11Shader::D3D11Shader(ID3D11Device* device, const ShaderDescriptor& desc) :
+D3D11Shader::D3D11Shader(
+    ID3D11Device*           device,
+    const ShaderDescriptor& desc,
+    const DXShaderCache*    cache,
+    DXShaderCompileResult*  compileResult)
+:
     Shader { desc.type }
 {
-    if (BuildShader(device, desc))
+    if (BuildShader(device, desc, cache, compileResult))
     {
         if (GetType() == ShaderType::Vertex)
         {
@@ -59,10 +64,10 @@ bool D3D11Shader::Reflect(ShaderReflection& reflection) const
  * ======= Private: =======
  */
 
-bool D3D11Shader::BuildShader(ID3D11Device* device, const ShaderDescriptor& shaderDesc)
+bool D3D11Shader::BuildShader(ID3D11Device* device, const ShaderDescriptor& shaderDesc, const DXShaderCache* cache, DXShaderCompileResult* compileResult)
 {
     if (IsShaderSourceCode(shaderDesc.sourceType))
-        return CompileSource(device, shaderDesc);
+        return CompileSource(device, shaderDesc, cache, compileResult);
     else
         return LoadBinary(device, shaderDesc);
 }
@@ -130,54 +135,24 @@ void D3D11Shader::BuildInputLayout(ID3D11Device* device, UINT numVertexAttribs,
 }
 
 // see https://msdn.microsoft.com/en-us/library/windows/desktop/dd607324(v=vs.85).aspx
-bool D3D11Shader::CompileSource(ID3D11Device* device, const ShaderDescriptor& shaderDesc)
+bool D3D11Shader::CompileSource(ID3D11Device* device, const ShaderDescriptor& shaderDesc, const DXShaderCache* cache, DXShaderCompileResult* compileResult)
 {
-    /* Get source code */
-    std::string fileContent;
-    const char* sourceCode      = nullptr;
-    SIZE_T      sourceLength    = 0;
-
-    if (shaderDesc.sourceType == ShaderSourceType::CodeFile)
-    {
-        fileContent     = ReadFileString(shaderDesc.source);
-        sourceCode      = fileContent.c_str();
-        sourceLength    = fileContent.size();
-    }
+    /* Compile shader code or take result from precompilation */
+    DXShaderCompileResult result;
+    if (compileResult != nullptr && compileResult->compiled)
+        result = std::move(*compileResult);
     else
-    {
-        sourceCode      = shaderDesc.source;
-        sourceLength    = shaderDesc.sourceSize;
-    }
+        DXCompileShader(shaderDesc, result, cache);
 
-    /* Get parameter from union */
-    const char* entry   = shaderDesc.entryPoint;
-    const char* target  = (shaderDesc.profile != nullptr ? shaderDesc.profile : "");
-    auto        defines = reinterpret_cast<const D3D_SHADER_MACRO*>(shaderDesc.defines);
-    auto        flags   = shaderDesc.flags;
-
-    /* Compile shader code */
-    ComPtr<ID3DBlob> errors;
-    auto hr = D3DCompile(
-        sourceCode,
-        sourceLength,
-        nullptr,                            // LPCSTR               pSourceName
-        defines,                            // D3D_SHADER_MACRO*    pDefines
-        nullptr,                            // ID3DInclude*         pInclude
-        entry,                              // LPCSTR               pEntrypoint
-        target,                             // LPCSTR               pTarget
-        DXGetCompilerFlags(flags),          // UINT                 Flags1
-        0,                                  // UINT                 Flags2 (recommended to always be 0)
-        byteCode_.ReleaseAndGetAddressOf(), // ID3DBlob**           ppCode
-        errors.ReleaseAndGetAddressOf()     // ID3DBlob**           ppErrorMsgs
-    );
+    byteCode_ = std::move(result.byteCode);
 
     /* Get byte code from blob */
     if (byteCode_)
         CreateNativeShader(device, shaderDesc.vertex.outputAttribs.size(), shaderDesc.vertex.outputAttribs.data());
 
     /* Store if compilation was successful */
-    const bool hasErrors = FAILED(hr);
-    report_.Reset(errors.Get(), hasErrors);
+    const bool hasErrors = FAILED(result.hr);
+    report_.Reset(result.errors.Get(), hasErrors);
     return !hasErrors;
 }
 
@@ -286,6 +261,12 @@ D3D11NativeShader D3D11Shader::CreateNativeShaderFromBlob(
             DXThrowIfCreateFailed(hr, "ID3D11ComputeShader");
         }
         break;
+
+        default:
+        {
+            throw std::invalid_argument("cannot create D3D11 shader of type: " + std::string(ToString(type)));
+        }
+        break;
     }
 
     return native;
@@ -15,6 +15,7 @@
 #include <LLGL/BufferFlags.h>
 #include "../../DXCommon/ComPtr.h"
 #include "../../DXCommon/DXReport.h"
+#include "../../DXCommon/DXShaderCache.h"
 #include <vector>
 #include <string>
 #include <d3d11.h>
@@ -67,7 +68,13 @@ class D3D11Shader final : public Shader
 
     public:
 
-        D3D11Shader(ID3D11Device* device, const ShaderDescriptor& desc);
+        // Creates the shader with an optional bytecode cache and an optional result of a previous compilation of the same descriptor (see DXCompileShaders).
+        D3D11Shader(
+            ID3D11Device*           device,
+            const ShaderDescriptor& desc,
+            const DXShaderCache*    cache           = nullptr,
+            DXShaderCompileResult*  compileResult   = nullptr
+        );
 
         // Returns the native D3D shader object.
         inline const D3D11NativeShader& GetNative() const
@@ -101,10 +108,10 @@ class D3D11Shader final : public Shader
 
     private:
 
-        bool BuildShader(ID3D11Device* device, const ShaderDescriptor& shaderDesc);
+        bool BuildShader(ID3D11Device* device, const ShaderDescriptor& shaderDesc, const DXShaderCache* cache, DXShaderCompileResult* compileResult);
         void BuildInputLayout(ID3D11Device* device, UINT numVertexAttribs, const VertexAttribute* vertexAttribs);
 
-        bool CompileSource(ID3D11Device* device, const ShaderDescriptor& shaderDesc);
+        bool CompileSource(ID3D11Device* device, const ShaderDescriptor& shaderDesc, const DXShaderCache* cache, DXShaderCompileResult* compileResult);
         bool LoadBinary(ID3D11Device* device, const ShaderDescriptor& shaderDesc);
 
         void CreateNativeShader(
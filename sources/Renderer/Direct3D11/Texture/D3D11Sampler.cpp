@@ -15,7 +15,7 @@ namespace LLGL
 {
 
 
-D3D11Sampler::D3D11Sampler(ID3D11Device* device, const SamplerDescriptor& desc)
+static std::shared_ptr<ComPtr<ID3D11SamplerState>> DXCreateSamplerState(ID3D11Device* device, const SamplerDescriptor& desc)
 {
     /* Setup sampler state descriptor and create sampler state object */
     D3D11_SAMPLER_DESC samplerDesc;
@@ -43,13 +43,35 @@ D3D11Sampler::D3D11Sampler(ID3D11Device* device, const SamplerDescriptor& desc)
             samplerDesc.MaxLOD = 0.0f;
         }
     }
-    auto hr = device->CreateSamplerState(&samplerDesc, native_.ReleaseAndGetAddressOf());
+    auto samplerState = std::make_shared<ComPtr<ID3D11SamplerState>>();
+    auto hr = device->CreateSamplerState(&samplerDesc, samplerState->ReleaseAndGetAddressOf());
     DXThrowIfFailed(hr, "failed to create D3D11 sampler state");
+
+    return samplerState;
+}
+
+D3D11Sampler::D3D11Sampler(ID3D11Device* device, D3D11SamplerCache& samplerCache, const SamplerDescriptor& desc) :
+    samplerCache_ { samplerCache },
+    desc_         { desc         }
+{
+    native_ = samplerCache.GetOrCreate(
+        desc,
+        [device, &desc]()
+        {
+            return DXCreateSamplerState(device, desc);
+        }
+    );
+}
+
+D3D11Sampler::~D3D11Sampler()
+{
+    samplerCache_.Release(desc_, std::move(native_));
 }
 
 void D3D11Sampler::SetName(const char* name)
 {
-    D3D11SetObjectName(native_.Get(), name);
+    /* Sampler state is shared between all samplers with the same descriptor, so they share the same name */
+    D3D11SetObjectName(GetNative(), name);
 }
 
 
@@ -12,12 +12,15 @@
 #include <LLGL/Sampler.h>
 #include <d3d11.h>
 #include "../../DXCommon/ComPtr.h"
+#include "../../SamplerCache.h"
 
 
 namespace LLGL
 {
 
 
+using D3D11SamplerCache = SamplerCache<ComPtr<ID3D11SamplerState>>;
+
 class D3D11Sampler final : public Sampler
 {
 
@@ -27,17 +30,21 @@ class D3D11Sampler final : public Sampler
 
     public:
 
-        D3D11Sampler(ID3D11Device* device, const SamplerDescriptor& desc);
+        // Shares the native sampler state with all other samplers of the same descriptor in the specified cache.
+        D3D11Sampler(ID3D11Device* device, D3D11SamplerCache& samplerCache, const SamplerDescriptor& desc);
+        ~D3D11Sampler();
 
         // Returns the native ID3D11SamplerState object.
         inline ID3D11SamplerState* GetNative() const
         {
-            return native_.Get();
+            return native_->Get();
         }
 
     private:
 
-        ComPtr<ID3D11SamplerState> native_;
+        D3D11SamplerCache&                          samplerCache_;
+        SamplerDescriptor                           desc_;
+        std::shared_ptr<ComPtr<ID3D11SamplerState>> native_;
 
 };
 
@@ -230,15 +230,13 @@ void D3D11Texture::UpdateSubresource(
 
     /* Get destination subresource index */
     auto dstSubresource = CalcSubresource(mipLevel, arrayLayer);
-    auto dataLayout     = CalcSubresourceLayout(
-        format,
-        Extent3D
-        {
-            region.right - region.left,
-            region.bottom - region.top,
-            region.back - region.front
-        }
-    );
+    const Extent3D extent
+    {
+        region.right - region.left,
+        region.bottom - region.top,
+        region.back - region.front
+    };
+    auto dataLayout     = CalcSubresourceLayout(format, extent);
 
     ByteBuffer intermediateData;
     const void* initialData = imageDesc.data;
@@ -246,12 +244,17 @@ void D3D11Texture::UpdateSubresource(
     if ((formatAttribs.flags & FormatFlags::IsCompressed) == 0 &&
         (formatAttribs.format != imageDesc.format || formatAttribs.dataType != imageDesc.dataType))
     {
-        /* Convert image data (e.g. from RGB to RGBA), and redirect initial data to new buffer */
-        intermediateData    = ConvertImageBuffer(imageDesc, formatAttribs.format, formatAttribs.dataType, Constants::maxThreadCount);
+        /* Repack strided image data, then convert image data (e.g. from RGB to RGBA), and redirect initial data to new buffer */
+        SrcImageDescriptor packedImageDesc;
+        ByteBuffer packedData = PackStridedImage(imageDesc, extent, packedImageDesc);
+        intermediateData    = ConvertImageBuffer(packedImageDesc, formatAttribs.format, formatAttribs.dataType, Constants::maxThreadCount);
         initialData         = intermediateData.get();
     }
     else
     {
+        /* Pass row and layer strides of the source image as pitches to the subresource update */
+        dataLayout = CalcSubresourceLayout(format, extent, imageDesc.rowStride, imageDesc.layerStride);
+
         /* Validate input data is large enough */
         if (imageDesc.dataSize < dataLayout.dataSize)
         {
@@ -32,7 +32,7 @@ static DXGI_FORMAT GetDXFormatForBuffer(const BufferDescriptor& desc)
     return (IsStructuredBuffer(desc) ? DXGI_FORMAT_UNKNOWN : DXTypes::ToDXGIFormat(desc.format));
 }
 
-D3D12Buffer::D3D12Buffer(ID3D12Device* device, const BufferDescriptor& desc) :
+D3D12Buffer::D3D12Buffer(ID3D12Device* device, D3D12MemoryManager& memoryMngr, const BufferDescriptor& desc) :
     Buffer  { desc.bindFlags             },
     format_ { GetDXFormatForBuffer(desc) }
 {
@@ -41,19 +41,28 @@ D3D12Buffer::D3D12Buffer(ID3D12Device* device, const BufferDescriptor& desc) :
         alignment_ = g_cBufferAlignment;
 
     /* Create native buffer resource */
-    CreateGpuBuffer(device, desc);
+    CreateGpuBuffer(device, memoryMngr, desc);
 
     /* Create CPU access buffer */
     if (desc.cpuAccessFlags != 0)
-        CreateCpuAccessBuffer(device, desc.cpuAccessFlags);
+        CreateCpuAccessBuffer(memoryMngr, desc.cpuAccessFlags);
 
-    /* Create sub-resource views */
-    if ((desc.bindFlags & BindFlags::VertexBuffer) != 0)
-        CreateVertexBufferView(desc);
-    if ((desc.bindFlags & BindFlags::IndexBuffer) != 0)
-        CreateIndexBufferView(desc);
-    if ((desc.bindFlags & BindFlags::StreamOutputBuffer) != 0)
-        CreateStreamOutputBufferView(desc);
+    CreateSubresourceViews(device, desc);
+}
+
+D3D12Buffer::D3D12Buffer(ID3D12Device* device, const BufferDescriptor& desc, const NativeResourceHandle& nativeHandle) :
+    Buffer  { desc.bindFlags             },
+    format_ { GetDXFormatForBuffer(desc) }
+{
+    /* Constant buffers must be aligned to 256 bytes */
+    if ((desc.bindFlags & BindFlags::ConstantBuffer) != 0)
+        alignment_ = g_cBufferAlignment;
+
+    /* Import native buffer resource; imported buffers have no CPU access buffer */
+    InitBufferAttributes(desc);
+    ImportGpuBuffer(device, nativeHandle);
+
+    CreateSubresourceViews(device, desc);
 }
 
 void D3D12Buffer::SetName(const char* name)
@@ -78,6 +87,12 @@ BufferDescriptor D3D12Buffer::GetDesc() const
     return bufferDesc;
 }
 
+void D3D12Buffer::ReleaseMemoryRegions(D3D12MemoryManager& memoryMngr)
+{
+    memoryMngr.Release(memoryRegion_);
+    memoryMngr.Release(cpuAccessMemoryRegion_);
+}
+
 void D3D12Buffer::CreateConstantBufferView(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle)
 {
     CreateConstantBufferViewPrimary(
@@ -186,6 +201,14 @@ void D3D12Buffer::CreateUnorderedAccessViewPrimary(
     device->CreateUnorderedAccessView(GetNative(), nullptr, &uavDesc, cpuDescHandle);
 }
 
+D3D12_CPU_DESCRIPTOR_HANDLE D3D12Buffer::GetDefaultViewDescHandle(D3D12_DESCRIPTOR_RANGE_TYPE type) const
+{
+    if (type >= D3D12_DESCRIPTOR_RANGE_TYPE_SRV && type <= D3D12_DESCRIPTOR_RANGE_TYPE_CBV)
+        return defaultViewDescHandles_[type];
+    else
+        return D3D12_CPU_DESCRIPTOR_HANDLE{};
+}
+
 static bool HasReadAccess(const CPUAccess access)
 {
     return (access == CPUAccess::ReadOnly || access == CPUAccess::ReadWrite);
@@ -193,7 +216,7 @@ static bool HasReadAccess(const CPUAccess access)
 
 static bool HasWriteAccess(const CPUAccess access)
 {
-    return (access >= CPUAccess::WriteOnly && access <= CPUAccess::ReadWrite);
+    return (access >= CPUAccess::WriteOnly && access <= CPUAccess::WriteUnsynchronized);
 }
 
 void D3D12Buffer::ClearSubresourceUInt(
@@ -218,7 +241,7 @@ void D3D12Buffer::ClearSubresourceUInt(
     }
 
     /* Create intermediate descritpor heap if not already done or format changed */
-    if (!uavIntermediateDescHeap_ || format_ != format)
+    if (!uavIntermediateDescHeap_ || uavIntermediateFormat_ != format)
         CreateIntermediateUAVDescriptorHeap(resource, format, formatStride);
 
     /* Get GPU and CPU descriptor handles for intermediate descriptor heap */
@@ -346,6 +369,25 @@ void D3D12Buffer::Unmap(D3D12CommandContext& commandContext)
     }
 }
 
+bool D3D12Buffer::CreateSharedHandle(ID3D12Device* device, NativeResourceHandle& outHandle) const
+{
+    if (!shared_)
+        return false;
+
+    HANDLE handle = nullptr;
+    auto hr = device->CreateSharedHandle(GetNative(), nullptr, GENERIC_ALL, nullptr, &handle);
+    if (FAILED(hr))
+        return false;
+
+    outHandle.type          = NativeHandleType::D3D12SharedHandle;
+    outHandle.object        = reinterpret_cast<std::uintptr_t>(handle);
+    outHandle.memory        = 0;
+    outHandle.memoryOffset  = 0;
+    outHandle.memorySize    = GetInternalBufferSize();
+
+    return true;
+}
+
 
 /*
  * ======= Protected: =======
@@ -383,8 +425,8 @@ static D3D12_RESOURCE_STATES GetD3DUsageState(long bindFlags)
     return flagsD3D;
 }
 
-// see https://docs.microsoft.com/en-us/windows/desktop/api/d3d12/nf-d3d12-id3d12device-createcommittedresource
-void D3D12Buffer::CreateGpuBuffer(ID3D12Device* device, const BufferDescriptor& desc)
+// see https://docs.microsoft.com/en-us/windows/desktop/api/d3d12/nf-d3d12-id3d12device-createplacedresource
+void D3D12Buffer::InitBufferAttributes(const BufferDescriptor& desc)
 {
     /* Store buffer attributes */
     bufferSize_ = GetAlignedSize<UINT64>(desc.size, alignment_);
@@ -398,20 +440,84 @@ void D3D12Buffer::CreateGpuBuffer(ID3D12Device* device, const BufferDescriptor&
     /* Determine initial resource state */
     resource_.usageState        = GetD3DUsageState(desc.bindFlags);
     resource_.transitionState   = D3D12_RESOURCE_STATE_COPY_DEST;
+}
 
-    /* Create generic buffer resource */
-    auto hr = device->CreateCommittedResource(
-        &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
-        D3D12_HEAP_FLAG_NONE,
-        &CD3DX12_RESOURCE_DESC::Buffer(GetInternalBufferSize(), GetD3DResourceFlags(desc)),
-        resource_.transitionState,
-        nullptr,
-        IID_PPV_ARGS(resource_.native.ReleaseAndGetAddressOf())
-    );
-    DXThrowIfCreateFailed(hr, "ID3D12Resource", "for D3D12 hardware buffer");
+void D3D12Buffer::CreateGpuBuffer(ID3D12Device* device, D3D12MemoryManager& memoryMngr, const BufferDescriptor& desc)
+{
+    InitBufferAttributes(desc);
+
+    const auto resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(GetInternalBufferSize(), GetD3DResourceFlags(desc));
+
+    shared_ = ((desc.miscFlags & MiscFlags::Shared) != 0);
+    if (shared_)
+    {
+        /* Create committed resource in its own shared heap, so it can be opened by other devices or processes */
+        auto hr = device->CreateCommittedResource(
+            &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
+            D3D12_HEAP_FLAG_SHARED,
+            &resourceDesc,
+            resource_.transitionState,
+            nullptr,
+            IID_PPV_ARGS(resource_.native.ReleaseAndGetAddressOf())
+        );
+        DXThrowIfCreateFailed(hr, "ID3D12Resource", "for shared buffer");
+    }
+    else
+    {
+        /* Create generic buffer resource within a placed resource heap */
+        memoryMngr.CreateResource(
+            D3D12_HEAP_TYPE_DEFAULT,
+            resourceDesc,
+            resource_.transitionState,
+            nullptr,
+            resource_.native,
+            memoryRegion_
+        );
+    }
+}
+
+void D3D12Buffer::ImportGpuBuffer(ID3D12Device* device, const NativeResourceHandle& nativeHandle)
+{
+    switch (nativeHandle.type)
+    {
+        case NativeHandleType::D3D12Resource:
+            /* Take reference of native resource */
+            resource_.native = reinterpret_cast<ID3D12Resource*>(static_cast<std::uintptr_t>(nativeHandle.object));
+            break;
+
+        case NativeHandleType::OpaqueWin32:
+        case NativeHandleType::D3D12SharedHandle:
+        {
+            /* Open shared handle as new resource that refers to the same memory */
+            auto handle = reinterpret_cast<HANDLE>(static_cast<std::uintptr_t>(nativeHandle.object));
+            auto hr = device->OpenSharedHandle(handle, IID_PPV_ARGS(resource_.native.ReleaseAndGetAddressOf()));
+            DXThrowIfFailed(hr, "failed to open shared handle for D3D12 buffer");
+        }
+        break;
+
+        default:
+            throw std::invalid_argument("cannot import D3D12 buffer from unsupported native handle type");
+    }
+
+    /* Imported resources are expected to be in the common state */
+    resource_.transitionState = D3D12_RESOURCE_STATE_COMMON;
+}
+
+void D3D12Buffer::CreateSubresourceViews(ID3D12Device* device, const BufferDescriptor& desc)
+{
+    /* Create sub-resource views */
+    if ((desc.bindFlags & BindFlags::VertexBuffer) != 0)
+        CreateVertexBufferView(desc);
+    if ((desc.bindFlags & BindFlags::IndexBuffer) != 0)
+        CreateIndexBufferView(desc);
+    if ((desc.bindFlags & BindFlags::StreamOutputBuffer) != 0)
+        CreateStreamOutputBufferView(desc);
+
+    /* Create default descriptors once, so resource heaps can copy them instead of creating new views */
+    CreateDefaultViewDescHeap(device, desc.bindFlags);
 }
 
-void D3D12Buffer::CreateCpuAccessBuffer(ID3D12Device* device, long cpuAccessFlags)
+void D3D12Buffer::CreateCpuAccessBuffer(D3D12MemoryManager& memoryMngr, long cpuAccessFlags)
 {
     /* Determine heap type and resource state */
     D3D12_HEAP_TYPE heapType = D3D12_HEAP_TYPE_UPLOAD;
@@ -430,15 +536,58 @@ void D3D12Buffer::CreateCpuAccessBuffer(ID3D12Device* device, long cpuAccessFlag
     }
 
     /* Create CPU access buffer */
-    auto hr = device->CreateCommittedResource(
-        &CD3DX12_HEAP_PROPERTIES(heapType),
-        D3D12_HEAP_FLAG_NONE,
-        &CD3DX12_RESOURCE_DESC::Buffer(GetInternalBufferSize()),
+    memoryMngr.CreateResource(
+        heapType,
+        CD3DX12_RESOURCE_DESC::Buffer(GetInternalBufferSize()),
         cpuAccessBuffer_.usageState,
         nullptr,
-        IID_PPV_ARGS(cpuAccessBuffer_.native.ReleaseAndGetAddressOf())
+        cpuAccessBuffer_.native,
+        cpuAccessMemoryRegion_
     );
-    DXThrowIfCreateFailed(hr, "ID3D12Resource", "for D3D12 CPU access buffer");
+}
+
+void D3D12Buffer::CreateDefaultViewDescHeap(ID3D12Device* device, long bindFlags)
+{
+    const bool hasSRV = ((bindFlags & BindFlags::Sampled       ) != 0);
+    const bool hasUAV = ((bindFlags & BindFlags::Storage       ) != 0);
+    const bool hasCBV = ((bindFlags & BindFlags::ConstantBuffer) != 0);
+
+    const UINT numDescriptors = static_cast<UINT>(hasSRV) + static_cast<UINT>(hasUAV) + static_cast<UINT>(hasCBV);
+    if (numDescriptors == 0)
+        return;
+
+    /* Create CPU-only descriptor heap for the default views; shader-visible heaps must not be used as copy source */
+    D3D12_DESCRIPTOR_HEAP_DESC heapDesc;
+    {
+        heapDesc.Type               = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+        heapDesc.NumDescriptors     = numDescriptors;
+        heapDesc.Flags              = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+        heapDesc.NodeMask           = 0;
+    }
+    HRESULT hr = device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(defaultViewDescHeap_.ReleaseAndGetAddressOf()));
+    DXThrowIfCreateFailed(hr, "ID3D12DescriptorHeap", "for buffer default views");
+
+    /* Create default views in consecutive descriptors */
+    const UINT                  descSize        = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle   = defaultViewDescHeap_->GetCPUDescriptorHandleForHeapStart();
+
+    if (hasSRV)
+    {
+        CreateShaderResourceView(device, cpuDescHandle);
+        defaultViewDescHandles_[D3D12_DESCRIPTOR_RANGE_TYPE_SRV] = cpuDescHandle;
+        cpuDescHandle.ptr += descSize;
+    }
+    if (hasUAV)
+    {
+        CreateUnorderedAccessView(device, cpuDescHandle);
+        defaultViewDescHandles_[D3D12_DESCRIPTOR_RANGE_TYPE_UAV] = cpuDescHandle;
+        cpuDescHandle.ptr += descSize;
+    }
+    if (hasCBV)
+    {
+        CreateConstantBufferView(device, cpuDescHandle);
+        defaultViewDescHandles_[D3D12_DESCRIPTOR_RANGE_TYPE_CBV] = cpuDescHandle;
+    }
 }
 
 void D3D12Buffer::CreateIntermediateUAVDescriptorHeap(ID3D12Resource* resource, DXGI_FORMAT format, UINT formatStride)
@@ -471,8 +620,8 @@ void D3D12Buffer::CreateIntermediateUAVDescriptorHeap(ID3D12Resource* resource,
     }
     device->CreateUnorderedAccessView(resource, nullptr, &uavDesc, uavIntermediateDescHeap_->GetCPUDescriptorHandleForHeapStart());
 
-    /* Store new format */
-    format_ = format;
+    /* Store new format; the primary format of this buffer remains unchanged for its default views */
+    uavIntermediateFormat_ = format;
 }
 
 void D3D12Buffer::CreateIntermediateUAVBuffer()
@@ -12,6 +12,7 @@
 #include <LLGL/Buffer.h>
 #include <LLGL/RenderSystemFlags.h>
 #include "../D3D12Resource.h"
+#include "../Memory/D3D12MemoryManager.h"
 #include "../../DXCommon/ComPtr.h"
 #include <d3d12.h>
 
@@ -34,7 +35,13 @@ class D3D12Buffer : public Buffer
 
     public:
 
-        D3D12Buffer(ID3D12Device* device, const BufferDescriptor& desc);
+        D3D12Buffer(ID3D12Device* device, D3D12MemoryManager& memoryMngr, const BufferDescriptor& desc);
+
+        // Imports a native ID3D12Resource or opens a shared handle. Such resources are expected to be in the D3D12_RESOURCE_STATE_COMMON state.
+        D3D12Buffer(ID3D12Device* device, const BufferDescriptor& desc, const NativeResourceHandle& nativeHandle);
+
+        // Releases the memory regions of the native buffer and CPU access buffer. The buffer must no longer be used by the GPU.
+        void ReleaseMemoryRegions(D3D12MemoryManager& memoryMngr);
 
         // Creates a resource views within the native buffer object:
         void CreateConstantBufferView(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle);
@@ -46,6 +53,13 @@ class D3D12Buffer : public Buffer
         void CreateUnorderedAccessView(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle);
         void CreateUnorderedAccessView(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle, const BufferViewDescriptor& bufferViewDesc);
 
+        /*
+        Returns the CPU descriptor handle of the default view for the specified descriptor range type (SRV, UAV, or CBV).
+        These views are created once in a CPU-only descriptor heap together with this buffer and can be copied into other descriptor heaps.
+        The handle is null if this buffer was not created with the respective binding flag.
+        */
+        D3D12_CPU_DESCRIPTOR_HANDLE GetDefaultViewDescHandle(D3D12_DESCRIPTOR_RANGE_TYPE type) const;
+
         /*
         Clears the buffer subresource with an intermediate UAV descriptor heap.
         Also an intermediate buffer is used if this buffer was not created with BindFlags::Storage.
@@ -70,6 +84,9 @@ class D3D12Buffer : public Buffer
         // Unmaps the buffer content from CPU memory space.
         void Unmap(D3D12CommandContext& commandContext);
 
+        // Creates a new shared handle of this buffer. Returns false if this buffer was not created with the MiscFlags::Shared flag.
+        bool CreateSharedHandle(ID3D12Device* device, NativeResourceHandle& outHandle) const;
+
         // Returns the resource wrapper.
         inline D3D12Resource& GetResource()
         {
@@ -100,6 +117,12 @@ class D3D12Buffer : public Buffer
             return internalSize_;
         }
 
+        // Returns the memory region of the native buffer resource. The heap is null for committed resources.
+        inline D3D12MemoryRegion& GetMemoryRegion()
+        {
+            return memoryRegion_;
+        }
+
         // Returns the vertex buffer view.
         inline const D3D12_VERTEX_BUFFER_VIEW& GetVertexBufferView() const
         {
@@ -132,8 +155,14 @@ class D3D12Buffer : public Buffer
 
     private:
 
-        void CreateGpuBuffer(ID3D12Device* device, const BufferDescriptor& desc);
-        void CreateCpuAccessBuffer(ID3D12Device* device, long cpuAccessFlags);
+        void InitBufferAttributes(const BufferDescriptor& desc);
+        void CreateGpuBuffer(ID3D12Device* device, D3D12MemoryManager& memoryMngr, const BufferDescriptor& desc);
+        void ImportGpuBuffer(ID3D12Device* device, const NativeResourceHandle& nativeHandle);
+
+        void CreateSubresourceViews(ID3D12Device* device, const BufferDescriptor& desc);
+        void CreateCpuAccessBuffer(D3D12MemoryManager& memoryMngr, long cpuAccessFlags);
+
+        void CreateDefaultViewDescHeap(ID3D12Device* device, long bindFlags);
 
         void CreateIntermediateUAVDescriptorHeap(ID3D12Resource* resource, DXGI_FORMAT format, UINT formatStride);
         void CreateIntermediateUAVBuffer();
@@ -190,7 +219,14 @@ class D3D12Buffer : public Buffer
         D3D12Resource                   resource_;
         D3D12Resource                   cpuAccessBuffer_; // D3D12_HEAP_TYPE_UPLOAD or D3D12_HEAP_TYPE_READBACK
 
+        D3D12MemoryRegion               memoryRegion_;
+        D3D12MemoryRegion               cpuAccessMemoryRegion_;
+
+        ComPtr<ID3D12DescriptorHeap>    defaultViewDescHeap_;
+        D3D12_CPU_DESCRIPTOR_HANDLE     defaultViewDescHandles_[3]  = {};   // Indexed by D3D12_DESCRIPTOR_RANGE_TYPE (SRV, UAV, CBV)
+
         ComPtr<ID3D12DescriptorHeap>    uavIntermediateDescHeap_;
+        DXGI_FORMAT                     uavIntermediateFormat_      = DXGI_FORMAT_UNKNOWN;
         D3D12Resource                   uavIntermediateBuffer_;
 
         UINT64                          bufferSize_                 = 0;
@@ -198,6 +234,7 @@ class D3D12Buffer : public Buffer
         UINT                            alignment_                  = 1;
         UINT                            stride_                     = 1;
         DXGI_FORMAT                     format_                     = DXGI_FORMAT_UNKNOWN;
+        bool                            shared_                     = false;    // True if this buffer was created with the MiscFlags::Shared flag.
 
         D3D12_VERTEX_BUFFER_VIEW        vertexBufferView_           = {};
         D3D12_INDEX_BUFFER_VIEW         indexBufferView_            = {};
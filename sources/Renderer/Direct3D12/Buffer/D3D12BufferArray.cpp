@@ -10,19 +10,30 @@
 #include "../../CheckedCast.h"
 #include "../../BufferUtils.h"
 #include "../../../Core/Helper.h"
+#include <algorithm>
 
 
 namespace LLGL
 {
 
 
-D3D12BufferArray::D3D12BufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray) :
+D3D12BufferArray::D3D12BufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets) :
     BufferArray { GetCombinedBindFlags(numBuffers, bufferArray) }
 {
     /* Store the strides and offests of each D3D12VertexBuffer inside the arrays */
     vertexBufferViews_.reserve(numBuffers);
-    while (auto next = NextArrayResource<D3D12Buffer>(numBuffers, bufferArray))
-        vertexBufferViews_.push_back(next->GetVertexBufferView());
+    for (std::size_t i = 0; auto next = NextArrayResource<D3D12Buffer>(numBuffers, bufferArray); ++i)
+    {
+        auto vertexBufferView = next->GetVertexBufferView();
+        if (offsets != nullptr)
+        {
+            /* Move start of vertex buffer view to the sub-allocated vertex stream */
+            const auto offset = std::min(static_cast<UINT>(offsets[i]), vertexBufferView.SizeInBytes);
+            vertexBufferView.BufferLocation += offset;
+            vertexBufferView.SizeInBytes    -= offset;
+        }
+        vertexBufferViews_.push_back(vertexBufferView);
+    }
 }
 
 
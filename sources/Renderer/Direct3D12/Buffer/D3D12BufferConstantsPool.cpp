@@ -13,45 +13,94 @@
 #include "../../DXCommon/DXCore.h"
 #include "../../../Core/Helper.h"
 #include <algorithm>
+#include <string.h>
 
 
 namespace LLGL
 {
 
 
-D3D12BufferConstantsPool& D3D12BufferConstantsPool::Get()
-{
-    static D3D12BufferConstantsPool g_instance;
-    return g_instance;
-}
-
 void D3D12BufferConstantsPool::InitializeDevice(
     ID3D12Device*           device,
     D3D12CommandContext&    commandContext,
-    D3D12StagingBufferPool& stagingBufferPool)
+    D3D12StagingBufferPool& stagingBufferPool,
+    UINT64                  chunkSize)
 {
-    /* Register constants */
-    std::vector<std::uint64_t> data;
-    {
-        RegisterConstants(D3D12BufferConstants::ZeroUInt64, 0, 1, data);
-    }
-    CreateImmutableBuffer(device, commandContext, stagingBufferPool, data);
+    device_     = device;
+    chunkSize_  = chunkSize;
+
+    /* Register built-in constants and upload them all at once */
+    RegisterConstants(D3D12BufferConstants::ZeroUInt64, 0, 1);
+
+    if (Flush(commandContext, stagingBufferPool))
+        commandContext.Finish(true);
 }
 
 void D3D12BufferConstantsPool::Clear()
 {
-    resource_.native.Reset();
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    chunks_.clear();
+    pendingData_.clear();
+    registers_.clear();
 }
 
-D3D12BufferConstantsView D3D12BufferConstantsPool::FetchConstants(const D3D12BufferConstants id)
+D3D12BufferConstantsView D3D12BufferConstantsPool::FetchConstants(const D3D12BufferConstants id) const
 {
     const auto idx = static_cast<std::size_t>(id);
     if (idx < registers_.size())
+        return registers_[idx];
+    return {};
+}
+
+D3D12BufferConstantsView D3D12BufferConstantsPool::AllocConstants(const void* data, UINT64 dataSize, UINT64 alignment)
+{
+    if (data == nullptr || dataSize == 0)
+        return {};
+
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    /* Sub-allocate range from a chunk with enough free space */
+    auto& chunk = FindOrCreateChunk(dataSize, alignment);
+    const UINT64 dstOffset = GetAlignedSize(chunk.offset, alignment);
+    chunk.offset = dstOffset + dataSize;
+
+    /* Keep CPU copy of the data until the next flush */
+    const std::size_t srcOffset = pendingData_.size();
+    pendingData_.resize(srcOffset + static_cast<std::size_t>(dataSize));
+    ::memcpy(&pendingData_[srcOffset], data, static_cast<std::size_t>(dataSize));
+
+    chunk.pendingRegions.push_back(PendingRegion{ dstOffset, srcOffset, dataSize });
+
+    return { chunk.resource.Get(), dstOffset, dataSize };
+}
+
+bool D3D12BufferConstantsPool::Flush(D3D12CommandContext& commandContext, D3D12StagingBufferPool& stagingBufferPool)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    if (pendingData_.empty())
+        return false;
+
+    /* Upload all pending regions of each chunk with a single copy from the upload buffer */
+    std::vector<BufferWriteRegion> regions;
+
+    for (auto& chunk : chunks_)
     {
-        const auto& reg = registers_[idx];
-        return { resource_.Get(), reg.offset, reg.size };
+        if (chunk.pendingRegions.empty())
+            continue;
+
+        regions.clear();
+        regions.reserve(chunk.pendingRegions.size());
+        for (const auto& pending : chunk.pendingRegions)
+            regions.push_back(BufferWriteRegion{ pending.dstOffset, &pendingData_[pending.srcOffset], pending.size });
+
+        stagingBufferPool.WriteImmediateRegions(commandContext, chunk.resource, static_cast<std::uint32_t>(regions.size()), regions.data());
+        chunk.pendingRegions.clear();
     }
-    return {};
+
+    pendingData_.clear();
+
+    return true;
 }
 
 
@@ -59,56 +108,51 @@ D3D12BufferConstantsView D3D12BufferConstantsPool::FetchConstants(const D3D12Buf
  * ======= Private: =======
  */
 
-void D3D12BufferConstantsPool::RegisterConstants(
-    const D3D12BufferConstants  id,
-    UINT64                      value,
-    UINT64                      count,
-    std::vector<std::uint64_t>& data)
+void D3D12BufferConstantsPool::RegisterConstants(const D3D12BufferConstants id, UINT64 value, UINT64 count)
 {
     /* Allocate new register */
     const auto idx = static_cast<std::size_t>(id);
     if (idx >= registers_.size())
         registers_.resize(idx + 1);
 
-    /* Write current offset */
-    auto& reg = registers_[idx];
+    /* Sub-allocate constants with their initial value */
+    std::vector<UINT64> data(static_cast<std::size_t>(count), value);
+    registers_[idx] = AllocConstants(data.data(), sizeof(UINT64) * count, sizeof(UINT64));
+}
+
+D3D12BufferConstantsPool::Chunk& D3D12BufferConstantsPool::FindOrCreateChunk(UINT64 dataSize, UINT64 alignment)
+{
+    /* Find chunk with enough free space */
+    for (auto& chunk : chunks_)
     {
-        reg.offset  = sizeof(UINT64) * data.size();
-        reg.size    = sizeof(UINT64) * count;
+        if (GetAlignedSize(chunk.offset, alignment) + dataSize <= chunk.size)
+            return chunk;
     }
 
-    /* Write data to container */
-    const auto first = data.size();
-    data.resize(first + static_cast<std::size_t>(count));
-    std::fill(data.begin() + first, data.end(), value);
+    /* Create new chunk that is large enough for the allocation */
+    CreateChunk(std::max(chunkSize_, GetAlignedSize(dataSize, static_cast<UINT64>(D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT))));
+    return chunks_.back();
 }
 
-void D3D12BufferConstantsPool::CreateImmutableBuffer(
-    ID3D12Device*               device,
-    D3D12CommandContext&        commandContext,
-    D3D12StagingBufferPool&     stagingBufferPool,
-    std::vector<std::uint64_t>& data)
+void D3D12BufferConstantsPool::CreateChunk(UINT64 size)
 {
-    /* Create native buffer resource */
-    resource_.usageState        = D3D12_RESOURCE_STATE_COPY_SOURCE;
-    resource_.transitionState   = D3D12_RESOURCE_STATE_COPY_DEST;
+    chunks_.emplace_back();
+    auto& chunk = chunks_.back();
 
-    /* Create generic buffer resource */
-    const UINT64 bufferSize = data.size() * sizeof(UINT64);
+    /* Constants are used as copy source and as CBV or SRV; new buffers start in the copy destination state for their first upload */
+    chunk.resource.usageState       = D3D12_RESOURCE_STATE_GENERIC_READ;
+    chunk.resource.transitionState  = D3D12_RESOURCE_STATE_COPY_DEST;
+    chunk.size                      = size;
 
-    auto hr = device->CreateCommittedResource(
+    auto hr = device_->CreateCommittedResource(
         &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
         D3D12_HEAP_FLAG_NONE,
-        &CD3DX12_RESOURCE_DESC::Buffer(bufferSize),
-        resource_.transitionState,
+        &CD3DX12_RESOURCE_DESC::Buffer(size),
+        chunk.resource.transitionState,
         nullptr,
-        IID_PPV_ARGS(resource_.native.ReleaseAndGetAddressOf())
+        IID_PPV_ARGS(chunk.resource.native.ReleaseAndGetAddressOf())
     );
     DXThrowIfCreateFailed(hr, "ID3D12Resource", "for D3D12 buffer constants pool");
-
-    /* Initialize buffer with registered constants */
-    stagingBufferPool.WriteImmediate(commandContext, resource_, 0, data.data(), bufferSize);
-    commandContext.Finish(true);
 }
 
 
@@ -9,9 +9,11 @@
 #define LLGL_D3D12_BUFFER_CONSTNATS_POOL_H
 
 
+#include <LLGL/BufferFlags.h>
 #include "../D3D12Resource.h"
 #include <d3d12.h>
 #include <vector>
+#include <mutex>
 
 
 namespace LLGL
@@ -33,61 +35,78 @@ struct D3D12BufferConstantsView
 class D3D12CommandContext;
 class D3D12StagingBufferPool;
 
-// Pool manager for special buffer constants, e.g. zero initialized buffer ange.
+/*
+Pool of immutable constant data for a single D3D12 device, e.g. zero initialized buffer ranges or constant blocks of built-in shaders.
+Constants are sub-allocated from shared GPU buffers in the GENERIC_READ state, so they can be used as copy source and as CBV or SRV.
+All data that is allocated between two calls to Flush() is uploaded with a single copy per buffer.
+*/
 class D3D12BufferConstantsPool
 {
 
     public:
 
+        D3D12BufferConstantsPool() = default;
+
         D3D12BufferConstantsPool(const D3D12BufferConstantsPool&) = delete;
         D3D12BufferConstantsPool& operator = (const D3D12BufferConstantsPool&) = delete;
 
-        // Returns the instance of this singleton.
-        static D3D12BufferConstantsPool& Get();
-
-        // Initializes the device object and creates the internal immutable buffer.
+        // Initializes the device object, registers the built-in constants, and uploads them to the first immutable buffer.
         void InitializeDevice(
             ID3D12Device*           device,
             D3D12CommandContext&    commandContext,
-            D3D12StagingBufferPool& stagingBufferPool
+            D3D12StagingBufferPool& stagingBufferPool,
+            UINT64                  chunkSize           = 65536u
         );
 
         // Clears all internal resources of this buffer pool.
         void Clear();
 
-        // Returns the buffer view for the specified constants.
-        D3D12BufferConstantsView FetchConstants(const D3D12BufferConstants id);
+        // Returns the buffer view for the specified built-in constants.
+        D3D12BufferConstantsView FetchConstants(const D3D12BufferConstants id) const;
+
+        /*
+        Sub-allocates an immutable range for the specified data and returns its buffer view.
+        The data is copied into this pool immediately, but the GPU buffer must not be accessed before the next call to Flush() has been executed.
+        */
+        D3D12BufferConstantsView AllocConstants(const void* data, UINT64 dataSize, UINT64 alignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+
+        // Records the upload of all pending constant data into the specified command context. Returns false if there was no pending data.
+        bool Flush(D3D12CommandContext& commandContext, D3D12StagingBufferPool& stagingBufferPool);
 
     private:
 
-        struct ConstantRegister
+        struct PendingRegion
         {
-            UINT64 offset;
-            UINT64 size;
+            UINT64      dstOffset;
+            std::size_t srcOffset;  // Offset into 'pendingData_'
+            UINT64      size;
+        };
+
+        struct Chunk
+        {
+            D3D12Resource               resource;
+            UINT64                      size        = 0;
+            UINT64                      offset      = 0;    // Offset of the next allocation
+            std::vector<PendingRegion>  pendingRegions;     // Regions that have not been uploaded yet
         };
 
     private:
 
-        D3D12BufferConstantsPool() = default;
+        void RegisterConstants(const D3D12BufferConstants id, UINT64 value, UINT64 count);
 
-        void RegisterConstants(
-            const D3D12BufferConstants  id,
-            UINT64                      value,
-            UINT64                      count,
-            std::vector<std::uint64_t>& data
-        );
+        // Returns a chunk with enough free space for the specified allocation, or creates a new chunk.
+        Chunk& FindOrCreateChunk(UINT64 dataSize, UINT64 alignment);
 
-        void CreateImmutableBuffer(
-            ID3D12Device*               device,
-            D3D12CommandContext&        commandContext,
-            D3D12StagingBufferPool&     stagingBufferPool,
-            std::vector<std::uint64_t>& data
-        );
+        void CreateChunk(UINT64 size);
 
     private:
 
-        D3D12Resource                   resource_;
-        std::vector<ConstantRegister>   registers_;
+        ID3D12Device*                           device_         = nullptr;
+        UINT64                                  chunkSize_      = 0;
+        std::vector<Chunk>                      chunks_;
+        std::vector<char>                       pendingData_;           // CPU copy of all constant data that has not been uploaded yet
+        std::vector<D3D12BufferConstantsView>   registers_;             // Views of the built-in constants indexed by D3D12BufferConstants
+        mutable std::mutex                      mutex_;                 // Guards allocations, so constants can be allocated from multiple threads
 
 };
 
@@ -0,0 +1,138 @@
+/*
+ * D3D12ReadbackPool.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12ReadbackPool.h"
+#include "../../DXCommon/DXCore.h"
+#include "../D3DX12/d3dx12.h"
+
+
+namespace LLGL
+{
+
+
+ComPtr<ID3D12Resource> D3D12ReadbackPool::CreateReadbackBuffer(ID3D12Device* device, UINT64 size)
+{
+    ComPtr<ID3D12Resource> resource;
+
+    auto hr = device->CreateCommittedResource(
+        &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_READBACK),
+        D3D12_HEAP_FLAG_NONE,
+        &CD3DX12_RESOURCE_DESC::Buffer(size),
+        D3D12_RESOURCE_STATE_COPY_DEST,
+        nullptr,
+        IID_PPV_ARGS(resource.ReleaseAndGetAddressOf())
+    );
+    DXThrowIfCreateFailed(hr, "ID3D12Resource", "for asynchronous readback buffer");
+
+    return resource;
+}
+
+std::uint64_t D3D12ReadbackPool::Register(
+    ComPtr<ID3D12Resource>&&    resource,
+    ID3D12Fence*                fence,
+    UINT64                      fenceValue,
+    const ReadbackLayout&       layout)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    ReleaseDiscardedEntries();
+
+    const auto ticket = nextTicket_++;
+    auto& entry = entries_[ticket];
+    {
+        entry.resource      = std::move(resource);
+        entry.fence         = fence;
+        entry.fenceValue    = fenceValue;
+        entry.layout        = layout;
+    }
+    return ticket;
+}
+
+const void* D3D12ReadbackPool::Map(std::uint64_t ticket, ReadbackLayout* outLayout)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    auto it = entries_.find(ticket);
+    if (it == entries_.end() || it->second.discarded)
+        return nullptr;
+
+    auto& entry = it->second;
+    if (entry.mappedData == nullptr)
+    {
+        /* Never wait for the GPU; the client polls this function until the copy has been completed */
+        if (!IsCompleted(entry))
+            return nullptr;
+
+        const D3D12_RANGE readRange{ 0, static_cast<SIZE_T>(entry.layout.size) };
+        auto hr = entry.resource->Map(0, &readRange, &(entry.mappedData));
+        DXThrowIfFailed(hr, "failed to map D3D12 readback buffer");
+    }
+
+    if (outLayout != nullptr)
+        *outLayout = entry.layout;
+
+    return entry.mappedData;
+}
+
+void D3D12ReadbackPool::Unmap(std::uint64_t ticket)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    auto it = entries_.find(ticket);
+    if (it == entries_.end() || it->second.discarded)
+        return;
+
+    auto& entry = it->second;
+    if (entry.mappedData != nullptr)
+    {
+        const D3D12_RANGE writtenRange{ 0, 0 };
+        entry.resource->Unmap(0, &writtenRange);
+        entries_.erase(it);
+    }
+    else if (IsCompleted(entry))
+        entries_.erase(it);
+    else
+    {
+        /* Keep resource alive until the GPU has completed the copy */
+        entry.discarded = true;
+        ++numDiscarded_;
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void D3D12ReadbackPool::ReleaseDiscardedEntries()
+{
+    if (numDiscarded_ == 0)
+        return;
+
+    for (auto it = entries_.begin(); it != entries_.end();)
+    {
+        if (it->second.discarded && IsCompleted(it->second))
+        {
+            it = entries_.erase(it);
+            --numDiscarded_;
+        }
+        else
+            ++it;
+    }
+}
+
+bool D3D12ReadbackPool::IsCompleted(const ReadbackEntry& entry)
+{
+    return (entry.fence->GetCompletedValue() >= entry.fenceValue);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,93 @@
+/*
+ * D3D12ReadbackPool.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_READBACK_POOL_H
+#define LLGL_D3D12_READBACK_POOL_H
+
+
+#include <LLGL/RenderSystemFlags.h>
+#include "../../DXCommon/ComPtr.h"
+#include <d3d12.h>
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+/*
+Device-wide container of the readback resources of asynchronous buffer and texture copies (see CommandBuffer::CopyBufferToReadback).
+Each readback is identified by a ticket and tagged with the allocator fence value of the command list that encoded the copy,
+so it can be mapped without waiting for the GPU once that fence value has been passed.
+Command buffers of multiple threads register their readbacks, so all functions are guarded by a mutex.
+*/
+class D3D12ReadbackPool
+{
+
+    public:
+
+        D3D12ReadbackPool() = default;
+
+        D3D12ReadbackPool(const D3D12ReadbackPool&) = delete;
+        D3D12ReadbackPool& operator = (const D3D12ReadbackPool&) = delete;
+
+        // Creates a new readback buffer of the specified size in the COPY_DEST state.
+        ComPtr<ID3D12Resource> CreateReadbackBuffer(ID3D12Device* device, UINT64 size);
+
+        // Registers the specified readback resource and returns its ticket. The readback is completed when the fence has reached the specified value.
+        std::uint64_t Register(
+            ComPtr<ID3D12Resource>&&    resource,
+            ID3D12Fence*                fence,
+            UINT64                      fenceValue,
+            const ReadbackLayout&       layout
+        );
+
+        // Maps the specified readback if it has been completed, or returns null otherwise.
+        const void* Map(std::uint64_t ticket, ReadbackLayout* outLayout);
+
+        // Releases the specified readback. Readbacks that are still in flight are released once they have been completed.
+        void Unmap(std::uint64_t ticket);
+
+    private:
+
+        struct ReadbackEntry
+        {
+            ComPtr<ID3D12Resource>  resource;
+            ComPtr<ID3D12Fence>     fence;
+            UINT64                  fenceValue  = 0;
+            ReadbackLayout          layout;
+            void*                   mappedData  = nullptr;
+            bool                    discarded   = false;
+        };
+
+    private:
+
+        // Releases all discarded entries that have been completed by the GPU.
+        void ReleaseDiscardedEntries();
+
+        static bool IsCompleted(const ReadbackEntry& entry);
+
+    private:
+
+        std::map<std::uint64_t, ReadbackEntry>  entries_;
+        std::uint64_t                           nextTicket_     = 1;
+        std::size_t                             numDiscarded_   = 0;
+        std::mutex                              mutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
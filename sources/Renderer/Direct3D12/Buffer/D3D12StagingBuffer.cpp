@@ -114,6 +114,57 @@ void D3D12StagingBuffer::WriteAndIncrementOffset(
     offset_ += dataSize;
 }
 
+void D3D12StagingBuffer::WriteRegions(
+    ID3D12GraphicsCommandList*  commandList,
+    ID3D12Resource*             dstBuffer,
+    std::uint32_t               numRegions,
+    const BufferWriteRegion*    regions)
+{
+    /* Map GPU host memory to CPU memory space once for all regions */
+    char* mappedData = nullptr;
+    const D3D12_RANGE readRange{ 0, 0 };
+
+    HRESULT hr = native_->Map(0, &readRange, reinterpret_cast<void**>(&mappedData));
+    if (FAILED(hr))
+        return;
+
+    /* Copy input data of all regions consecutively to staging buffer */
+    UINT64 srcOffset = offset_;
+    for (std::uint32_t i = 0; i < numRegions; ++i)
+    {
+        ::memcpy(mappedData + srcOffset, regions[i].data, static_cast<std::size_t>(regions[i].dataSize));
+        srcOffset += regions[i].dataSize;
+    }
+
+    /* Unmap buffer with range of written data */
+    const D3D12_RANGE writtenRange
+    {
+        static_cast<SIZE_T>(offset_),
+        static_cast<SIZE_T>(srcOffset)
+    };
+    native_->Unmap(0, &writtenRange);
+
+    /* Encode copy buffer command for each region */
+    srcOffset = offset_;
+    for (std::uint32_t i = 0; i < numRegions; ++i)
+    {
+        if (regions[i].dataSize > 0)
+            commandList->CopyBufferRegion(dstBuffer, regions[i].dstOffset, native_.Get(), srcOffset, regions[i].dataSize);
+        srcOffset += regions[i].dataSize;
+    }
+}
+
+void D3D12StagingBuffer::WriteRegionsAndIncrementOffset(
+    ID3D12GraphicsCommandList*  commandList,
+    ID3D12Resource*             dstBuffer,
+    std::uint32_t               numRegions,
+    const BufferWriteRegion*    regions)
+{
+    WriteRegions(commandList, dstBuffer, numRegions, regions);
+    for (std::uint32_t i = 0; i < numRegions; ++i)
+        offset_ += regions[i].dataSize;
+}
+
 
 } // /namespace LLGL
 
@@ -9,8 +9,10 @@
 #define LLGL_D3D12_STAGING_BUFFER_H
 
 
+#include <LLGL/BufferFlags.h>
 #include "../../DXCommon/ComPtr.h"
 #include <d3d12.h>
+#include <cstdint>
 
 
 namespace LLGL
@@ -69,6 +71,22 @@ class D3D12StagingBuffer
             UINT64                      dataSize
         );
 
+        // Writes the data of all specified regions consecutively to the native D3D upload buffer and encodes a copy command for each region.
+        void WriteRegions(
+            ID3D12GraphicsCommandList*  commandList,
+            ID3D12Resource*             dstBuffer,
+            std::uint32_t               numRegions,
+            const BufferWriteRegion*    regions
+        );
+
+        // Writes the data of all specified regions to the native D3D upload buffer and increments the write offset by their total size.
+        void WriteRegionsAndIncrementOffset(
+            ID3D12GraphicsCommandList*  commandList,
+            ID3D12Resource*             dstBuffer,
+            std::uint32_t               numRegions,
+            const BufferWriteRegion*    regions
+        );
+
         // Returns the native D3D resource.
         inline ID3D12Resource* GetNative() const
         {
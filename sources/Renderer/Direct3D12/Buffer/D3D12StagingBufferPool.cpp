@@ -9,6 +9,7 @@
 #include "../Command/D3D12CommandContext.h"
 #include "../D3D12Resource.h"
 #include "../../../Core/Helper.h"
+#include "../../../Core/ProfilerZone.h"
 #include <algorithm>
 
 
@@ -28,13 +29,6 @@ void D3D12StagingBufferPool::InitializeDevice(ID3D12Device* device, UINT64 chunk
     chunkSize_ = chunkSize;
 }
 
-void D3D12StagingBufferPool::Reset()
-{
-    for (auto& chunk : chunks_)
-        chunk.Reset();
-    chunkIdx_ = 0;
-}
-
 void D3D12StagingBufferPool::WriteStaged(
     D3D12CommandContext&    commandContext,
     D3D12Resource&          dstBuffer,
@@ -42,22 +36,41 @@ void D3D12StagingBufferPool::WriteStaged(
     const void*             data,
     UINT64                  dataSize)
 {
-    /* Find a chunk that fits the requested data size or allocate a new chunk */
-    while (chunkIdx_ < chunks_.size() && !chunks_[chunkIdx_].Capacity(dataSize))
-        ++chunkIdx_;
-
-    if (chunkIdx_ == chunks_.size())
-        AllocChunk(dataSize);
+    /* Find a chunk in the ring that fits the requested data size */
+    auto& chunk = GetChunkForWriting(commandContext, dataSize);
 
     /* Write data to current chunk */
     commandContext.TransitionResource(dstBuffer, D3D12_RESOURCE_STATE_COPY_DEST, true);
     {
-        auto& chunk = chunks_[chunkIdx_];
         chunk.WriteAndIncrementOffset(commandContext.GetCommandList(), dstBuffer.Get(), dstOffset, data, dataSize);
     }
     commandContext.TransitionResource(dstBuffer, dstBuffer.usageState, true);
 }
 
+void D3D12StagingBufferPool::WriteStagedRegions(
+    D3D12CommandContext&        commandContext,
+    D3D12Resource&              dstBuffer,
+    std::uint32_t               numRegions,
+    const BufferWriteRegion*    regions)
+{
+    UINT64 totalSize = 0;
+    for (std::uint32_t i = 0; i < numRegions; ++i)
+        totalSize += regions[i].dataSize;
+
+    if (totalSize == 0)
+        return;
+
+    /* Find a chunk in the ring that fits all regions */
+    auto& chunk = GetChunkForWriting(commandContext, totalSize);
+
+    /* Write data of all regions to current chunk */
+    commandContext.TransitionResource(dstBuffer, D3D12_RESOURCE_STATE_COPY_DEST, true);
+    {
+        chunk.WriteRegionsAndIncrementOffset(commandContext.GetCommandList(), dstBuffer.Get(), numRegions, regions);
+    }
+    commandContext.TransitionResource(dstBuffer, dstBuffer.usageState, true);
+}
+
 void D3D12StagingBufferPool::WriteImmediate(
     D3D12CommandContext&    commandContext,
     D3D12Resource&          dstBuffer,
@@ -65,12 +78,45 @@ void D3D12StagingBufferPool::WriteImmediate(
     const void*             data,
     UINT64                  dataSize,
     UINT64                  alignment)
+{
+    WriteImmediate(commandContext, dstBuffer, dstOffset, data, dataSize, alignment, dstBuffer.usageState);
+}
+
+void D3D12StagingBufferPool::WriteImmediate(
+    D3D12CommandContext&    commandContext,
+    D3D12Resource&          dstBuffer,
+    UINT64                  dstOffset,
+    const void*             data,
+    UINT64                  dataSize,
+    UINT64                  alignment,
+    D3D12_RESOURCE_STATES   stateAfter)
 {
     /* Write data to global upload buffer and copy region to destination buffer */
     commandContext.TransitionResource(dstBuffer, D3D12_RESOURCE_STATE_COPY_DEST, true);
     {
         GetUploadBufferAndGrow(dataSize, alignment).Write(commandContext.GetCommandList(), dstBuffer.Get(), dstOffset, data, dataSize);
     }
+    commandContext.TransitionResource(dstBuffer, stateAfter, true);
+}
+
+void D3D12StagingBufferPool::WriteImmediateRegions(
+    D3D12CommandContext&        commandContext,
+    D3D12Resource&              dstBuffer,
+    std::uint32_t               numRegions,
+    const BufferWriteRegion*    regions)
+{
+    UINT64 totalSize = 0;
+    for (std::uint32_t i = 0; i < numRegions; ++i)
+        totalSize += regions[i].dataSize;
+
+    if (totalSize == 0)
+        return;
+
+    /* Write data of all regions to global upload buffer and copy each region to destination buffer */
+    commandContext.TransitionResource(dstBuffer, D3D12_RESOURCE_STATE_COPY_DEST, true);
+    {
+        GetUploadBufferAndGrow(totalSize, 256u).WriteRegions(commandContext.GetCommandList(), dstBuffer.Get(), numRegions, regions);
+    }
     commandContext.TransitionResource(dstBuffer, dstBuffer.usageState, true);
 }
 
@@ -112,10 +158,55 @@ void D3D12StagingBufferPool::ReadSubresourceRegion(
  * ======= Private: =======
  */
 
+D3D12StagingBuffer& D3D12StagingBufferPool::GetChunkForWriting(D3D12CommandContext& commandContext, UINT64 dataSize)
+{
+    const UINT64 fenceValue = commandContext.GetCurrentFenceValue();
+
+    if (chunks_.empty())
+        AllocChunk(dataSize);
+    else if (!chunks_[chunkIdx_].buffer.Capacity(dataSize))
+    {
+        const UINT64 completedFenceValue = commandContext.GetCompletedFenceValue();
+        UpdateHighWaterMark(completedFenceValue);
+
+        /* The next chunk in the ring is the oldest one; rewind it only if the GPU is done with it */
+        auto& nextChunk = chunks_[(chunkIdx_ + 1) % chunks_.size()];
+        if (nextChunk.fenceValue <= completedFenceValue && nextChunk.buffer.GetSize() >= dataSize)
+        {
+            nextChunk.buffer.Reset();
+            chunkIdx_ = (chunkIdx_ + 1) % chunks_.size();
+        }
+        else
+            AllocChunk(dataSize);
+    }
+
+    /* Tag current chunk with fence value of the command list that is being recorded */
+    auto& chunk = chunks_[chunkIdx_];
+    chunk.fenceValue = fenceValue;
+    return chunk.buffer;
+}
+
 void D3D12StagingBufferPool::AllocChunk(UINT64 minChunkSize)
 {
-    chunks_.emplace_back(device_, std::max(chunkSize_, minChunkSize));
-    chunkIdx_ = chunks_.size() - 1;
+    LLGL_PROFILER_ZONE("D3D12StagingBufferPool::AllocChunk");
+
+    /* Insert new chunk after the current one, so the ring order from oldest to newest remains */
+    const std::size_t idx = (chunks_.empty() ? 0 : chunkIdx_ + 1);
+    Chunk chunk;
+    chunk.buffer.Create(device_, std::max(chunkSize_, minChunkSize));
+    chunks_.insert(chunks_.begin() + idx, std::move(chunk));
+    chunkIdx_ = idx;
+}
+
+void D3D12StagingBufferPool::UpdateHighWaterMark(UINT64 completedFenceValue)
+{
+    UINT64 bytesInFlight = 0;
+    for (const auto& chunk : chunks_)
+    {
+        if (chunk.fenceValue > completedFenceValue)
+            bytesInFlight += chunk.buffer.GetOffset();
+    }
+    highWaterMark_ = std::max(highWaterMark_, bytesInFlight);
 }
 
 void D3D12StagingBufferPool::ResizeBuffer(
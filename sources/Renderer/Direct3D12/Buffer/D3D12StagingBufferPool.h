@@ -21,6 +21,12 @@ namespace LLGL
 struct D3D12Resource;
 class D3D12CommandContext;
 
+/*
+Ring of upload chunks for dynamic buffer updates during command buffer recording.
+Each chunk is tagged with the allocator fence value of the command list that wrote into it last,
+and it is only rewound once the GPU has passed that fence value. If the next chunk in the ring is still in flight,
+a new chunk is inserted into the ring instead of waiting for the GPU, so multiple frames can be in flight without stalls.
+*/
 class D3D12StagingBufferPool
 {
 
@@ -32,10 +38,7 @@ class D3D12StagingBufferPool
         // Initializes the device object and chunk size.
         void InitializeDevice(ID3D12Device* device, UINT64 chunkSize);
 
-        // Resets all chunks in the pool.
-        void Reset();
-
-        // Writes the specified data to the destination buffer using the staging pool.
+        // Writes the specified data to the destination buffer using the staging ring. The command context must have been reset at least once.
         void WriteStaged(
             D3D12CommandContext&    commandContext,
             D3D12Resource&          dstBuffer,
@@ -44,6 +47,14 @@ class D3D12StagingBufferPool
             UINT64                  dataSize
         );
 
+        // Writes the data of all specified regions to the destination buffer using a single range of the staging ring and a single pair of resource transitions.
+        void WriteStagedRegions(
+            D3D12CommandContext&        commandContext,
+            D3D12Resource&              dstBuffer,
+            std::uint32_t               numRegions,
+            const BufferWriteRegion*    regions
+        );
+
         // Writes the specified data to the destination buffer using the global upload buffer.
         void WriteImmediate(
             D3D12CommandContext&    commandContext,
@@ -54,6 +65,25 @@ class D3D12StagingBufferPool
             UINT64                  alignment   = 256u
         );
 
+        // Writes the specified data to the destination buffer using the global upload buffer and transitions the buffer into the specified state afterwards.
+        void WriteImmediate(
+            D3D12CommandContext&    commandContext,
+            D3D12Resource&          dstBuffer,
+            UINT64                  dstOffset,
+            const void*             data,
+            UINT64                  dataSize,
+            UINT64                  alignment,
+            D3D12_RESOURCE_STATES   stateAfter
+        );
+
+        // Writes the data of all specified regions to the destination buffer using the global upload buffer and a single pair of resource transitions.
+        void WriteImmediateRegions(
+            D3D12CommandContext&        commandContext,
+            D3D12Resource&              dstBuffer,
+            std::uint32_t               numRegions,
+            const BufferWriteRegion*    regions
+        );
+
         // Copies the specified subresource region into the global readback buffer and writes it into the output data.
         void ReadSubresourceRegion(
             D3D12CommandContext&    commandContext,
@@ -64,11 +94,31 @@ class D3D12StagingBufferPool
             UINT64                  alignment   = 256u
         );
 
+        // Returns the highest number of bytes that have been in flight within the staging ring at the same time.
+        inline UINT64 GetHighWaterMark() const
+        {
+            return highWaterMark_;
+        }
+
     private:
 
-        // Allocates a new chunk with the specified minimal size.
+        struct Chunk
+        {
+            D3D12StagingBuffer  buffer;
+            UINT64              fenceValue  = 0; // Allocator fence value of the last command list that wrote into this chunk
+        };
+
+    private:
+
+        // Returns the chunk that can fit the specified data size. Rewinds the next chunk in the ring if the GPU is done with it, or inserts a new chunk.
+        D3D12StagingBuffer& GetChunkForWriting(D3D12CommandContext& commandContext, UINT64 dataSize);
+
+        // Inserts a new chunk with the specified minimal size after the current chunk.
         void AllocChunk(UINT64 minChunkSize);
 
+        // Updates the high-water mark with the number of bytes of all chunks that are still in flight.
+        void UpdateHighWaterMark(UINT64 completedFenceValue);
+
         // Resizes the specified staging buffer, but only grows its size.
         void ResizeBuffer(
             D3D12StagingBuffer& stagingBuffer,
@@ -84,9 +134,10 @@ class D3D12StagingBufferPool
 
         ID3D12Device*                   device_             = nullptr;
 
-        std::vector<D3D12StagingBuffer> chunks_;
+        std::vector<Chunk>              chunks_;
         std::size_t                     chunkIdx_           = 0;
         UINT64                          chunkSize_          = 0;
+        UINT64                          highWaterMark_      = 0;
 
         D3D12StagingBuffer              globalUploadBuffer_;
         D3D12StagingBuffer              globalReadbackBuffer_;
@@ -7,6 +7,7 @@
 
 #include "D3D12CommandBuffer.h"
 #include "D3D12SignatureFactory.h"
+#include "D3D12DescriptorHeapPool.h"
 #include "../D3D12ObjectUtils.h"
 #include "../D3D12SwapChain.h"
 #include "../D3D12RenderSystem.h"
@@ -29,6 +30,7 @@
 #include "../RenderState/D3D12QueryHeap.h"
 #include "../RenderState/D3D12GraphicsPSO.h"
 #include "../RenderState/D3D12ComputePSO.h"
+#include "../RenderState/D3D12PipelineLayout.h"
 
 #include <LLGL/TypeInfo.h>
 #include <LLGL/Misc/ForRange.h>
@@ -38,6 +40,7 @@
 
 #include <algorithm>
 #include <codecvt>
+#include <cstring>
 #include <limits.h>
 
 
@@ -45,10 +48,17 @@ namespace LLGL
 {
 
 
+// Size (in bytes) of each upload buffer with indirect arguments for patchable draw commands
+static const UINT64 g_patchBlockSize = 4096;
+
+
 D3D12CommandBuffer::D3D12CommandBuffer(D3D12RenderSystem& renderSystem, const CommandBufferDescriptor& desc) :
     cmdSignatureFactory_ { &(renderSystem.GetSignatureFactory())                     },
     stagingBufferPool_   { renderSystem.GetDevice().GetNative(), USHRT_MAX           },
-    immediateSubmit_     { ((desc.flags & CommandBufferFlags::ImmediateSubmit) != 0) }
+    readbackPool_        { &(renderSystem.GetReadbackPool())                         },
+    constantsPool_       { &(renderSystem.GetConstantsPool())                        },
+    immediateSubmit_     { ((desc.flags & CommandBufferFlags::ImmediateSubmit) != 0) },
+    device_              { renderSystem.GetDevice().GetNative()                      }
 {
     CreateCommandContext(renderSystem, desc);
 }
@@ -64,7 +74,19 @@ void D3D12CommandBuffer::Begin()
 {
     /* Reset command list using the next command allocator */
     commandContext_.Reset();
-    stagingBufferPool_.Reset();
+    executedBundles_.clear();
+    boundPipelineLayout_    = nullptr;
+    skipDraws_              = false;
+    skipDispatches_         = false;
+
+    /* Resetting the command list also resets the shading rate and shading-rate image */
+    shadingRate_                = D3D12_SHADING_RATE_1X1;
+    isShadingRateImageBound_    = false;
+
+    /* Reset patch slots; the patch blocks of the current command allocator are no longer in use by the GPU */
+    numPatchBlocks_         = 0;
+    patchBlockOffset_       = 0;
+    patchSlots_.clear();
 }
 
 void D3D12CommandBuffer::End()
@@ -81,7 +103,26 @@ void D3D12CommandBuffer::End()
 void D3D12CommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
 {
     auto& cmdBufferD3D = LLGL_CAST(D3D12CommandBuffer&, deferredCommandBuffer);
+
+    /* Bundles can only be executed by direct command lists */
+    if (isBundle_ || !cmdBufferD3D.IsBundle())
+        return;
+
+    /* Bundles must be executed with the same descriptor heaps they have been recorded with */
+    commandContext_.SetDescriptorHeaps(D3D12DescriptorHeapPool::g_numHeaps, D3D12DescriptorHeapPool::Get().GetDescriptorHeaps());
     commandList_->ExecuteBundle(cmdBufferD3D.GetNative());
+
+    /* States that are set by the bundle are inherited back to this command list, so the state cache is out of date */
+    commandContext_.ClearCache();
+
+    if (cmdBufferD3D.boundPipelineLayout_ != nullptr)
+    {
+        boundPipelineLayout_    = cmdBufferD3D.boundPipelineLayout_;
+        isGraphicsPSOBound_     = cmdBufferD3D.isGraphicsPSOBound_;
+    }
+
+    /* Keep track of bundle to signal its allocator fence together with this command buffer */
+    executedBundles_.push_back(&cmdBufferD3D);
 }
 
 /* ----- Blitting ----- */
@@ -92,10 +133,27 @@ void D3D12CommandBuffer::UpdateBuffer(
     const void*     data,
     std::uint16_t   dataSize)
 {
+    /* Copy commands and resource barriers are not allowed in bundles */
+    if (isBundle_)
+        return;
+
     auto& dstBufferD3D = LLGL_CAST(D3D12Buffer&, dstBuffer);
     stagingBufferPool_.WriteStaged(commandContext_, dstBufferD3D.GetResource(), dstOffset, data, dataSize);
 }
 
+void D3D12CommandBuffer::UpdateBuffer(
+    Buffer&                     dstBuffer,
+    std::uint32_t               numRegions,
+    const BufferWriteRegion*    regions)
+{
+    /* Copy commands and resource barriers are not allowed in bundles */
+    if (isBundle_)
+        return;
+
+    auto& dstBufferD3D = LLGL_CAST(D3D12Buffer&, dstBuffer);
+    stagingBufferPool_.WriteStagedRegions(commandContext_, dstBufferD3D.GetResource(), numRegions, regions);
+}
+
 void D3D12CommandBuffer::CopyBuffer(
     Buffer&         dstBuffer,
     std::uint64_t   dstOffset,
@@ -103,6 +161,10 @@ void D3D12CommandBuffer::CopyBuffer(
     std::uint64_t   srcOffset,
     std::uint64_t   size)
 {
+    /* Copy commands and resource barriers are not allowed in bundles */
+    if (isBundle_)
+        return;
+
     auto& dstBufferD3D = LLGL_CAST(D3D12Buffer&, dstBuffer);
     auto& srcBufferD3D = LLGL_CAST(D3D12Buffer&, srcBuffer);
 
@@ -115,6 +177,33 @@ void D3D12CommandBuffer::CopyBuffer(
     commandContext_.TransitionResource(srcBufferD3D.GetResource(), srcBufferD3D.GetResource().usageState, true);
 }
 
+void D3D12CommandBuffer::CopyBuffer(
+    Buffer&                     dstBuffer,
+    Buffer&                     srcBuffer,
+    std::uint32_t               numRegions,
+    const BufferCopyRegion*     regions)
+{
+    /* Copy commands and resource barriers are not allowed in bundles */
+    if (isBundle_ || numRegions == 0)
+        return;
+
+    auto& dstBufferD3D = LLGL_CAST(D3D12Buffer&, dstBuffer);
+    auto& srcBufferD3D = LLGL_CAST(D3D12Buffer&, srcBuffer);
+
+    /* Transition both resources only once for all regions */
+    commandContext_.TransitionResource(dstBufferD3D.GetResource(), D3D12_RESOURCE_STATE_COPY_DEST);
+    commandContext_.TransitionResource(srcBufferD3D.GetResource(), D3D12_RESOURCE_STATE_COPY_SOURCE, true);
+    {
+        for (std::uint32_t i = 0; i < numRegions; ++i)
+        {
+            if (regions[i].size > 0)
+                commandList_->CopyBufferRegion(dstBufferD3D.GetNative(), regions[i].dstOffset, srcBufferD3D.GetNative(), regions[i].srcOffset, regions[i].size);
+        }
+    }
+    commandContext_.TransitionResource(dstBufferD3D.GetResource(), dstBufferD3D.GetResource().usageState);
+    commandContext_.TransitionResource(srcBufferD3D.GetResource(), srcBufferD3D.GetResource().usageState, true);
+}
+
 //TODO: incomplete for unaligned row strides
 void D3D12CommandBuffer::CopyBufferFromTexture(
     Buffer&                 dstBuffer,
@@ -124,6 +213,10 @@ void D3D12CommandBuffer::CopyBufferFromTexture(
     std::uint32_t           rowStride,
     std::uint32_t           layerStride)
 {
+    /* Copy commands and resource barriers are not allowed in bundles */
+    if (isBundle_)
+        return;
+
     auto& dstBufferD3D = LLGL_CAST(D3D12Buffer&, dstBuffer);
     auto& srcTextureD3D = LLGL_CAST(D3D12Texture&, srcTexture);
 
@@ -183,12 +276,74 @@ void D3D12CommandBuffer::CopyBufferFromTexture(
     commandContext_.TransitionResource(srcTextureD3D.GetResource(), srcTextureD3D.GetResource().usageState, true);
 }
 
+std::uint64_t D3D12CommandBuffer::CopyBufferToReadback(Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size)
+{
+    /* Copy commands and resource barriers are not allowed in bundles */
+    if (isBundle_)
+        return Constants::invalidReadbackTicket;
+
+    auto& srcBufferD3D = LLGL_CAST(D3D12Buffer&, srcBuffer);
+
+    auto readbackBuffer = readbackPool_->CreateReadbackBuffer(device_, size);
+
+    commandContext_.TransitionResource(srcBufferD3D.GetResource(), D3D12_RESOURCE_STATE_COPY_SOURCE, true);
+    {
+        commandList_->CopyBufferRegion(readbackBuffer.Get(), 0, srcBufferD3D.GetNative(), srcOffset, size);
+    }
+    commandContext_.TransitionResource(srcBufferD3D.GetResource(), srcBufferD3D.GetResource().usageState, true);
+
+    /* Readback is completed once the allocator fence of this command list has been signaled */
+    ReadbackLayout layout;
+    {
+        layout.size = size;
+    }
+    return readbackPool_->Register(
+        std::move(readbackBuffer),
+        commandContext_.GetAllocatorFence(),
+        commandContext_.GetCurrentFenceValue(),
+        layout
+    );
+}
+
+std::uint64_t D3D12CommandBuffer::CopyTextureToReadback(Texture& srcTexture, const TextureRegion& srcRegion)
+{
+    /* Copy commands and resource barriers are not allowed in bundles */
+    if (isBundle_)
+        return Constants::invalidReadbackTicket;
+
+    auto& srcTextureD3D = LLGL_CAST(D3D12Texture&, srcTexture);
+
+    ComPtr<ID3D12Resource> readbackBuffer;
+    UINT rowStride = 0;
+    srcTextureD3D.CreateSubresourceCopyAsReadbackBuffer(device_, commandContext_, srcRegion, readbackBuffer, rowStride);
+
+    /* Array layers are stored as depth slices in the readback buffer */
+    const auto extent = CalcTextureExtent(srcTextureD3D.GetType(), srcRegion.extent, srcRegion.subresource.numArrayLayers);
+
+    ReadbackLayout layout;
+    {
+        layout.rowStride    = rowStride;
+        layout.layerStride  = rowStride * extent.height;
+        layout.size         = static_cast<std::uint64_t>(layout.layerStride) * extent.depth;
+    }
+    return readbackPool_->Register(
+        std::move(readbackBuffer),
+        commandContext_.GetAllocatorFence(),
+        commandContext_.GetCurrentFenceValue(),
+        layout
+    );
+}
+
 void D3D12CommandBuffer::FillBuffer(
     Buffer&         dstBuffer,
     std::uint64_t   dstOffset,
     std::uint32_t   value,
     std::uint64_t   fillSize)
 {
+    /* Copy commands and resource barriers are not allowed in bundles */
+    if (isBundle_)
+        return;
+
     auto& dstBufferD3D = LLGL_CAST(D3D12Buffer&, dstBuffer);
 
     /* Copy value to 4D vector to be used with native D3D12 clear functions */
@@ -212,25 +367,46 @@ void D3D12CommandBuffer::CopyTexture(
     const TextureLocation&  srcLocation,
     const Extent3D&         extent)
 {
-    auto& dstTextureD3D = LLGL_CAST(D3D12Texture&, dstTexture);
-    auto& srcTextureD3D = LLGL_CAST(D3D12Texture&, srcTexture);
+    const TextureCopyRegion region{ dstLocation, srcLocation, extent };
+    CopyTexture(dstTexture, srcTexture, 1, &region);
+}
 
-    const D3D12_TEXTURE_COPY_LOCATION dstLocationD3D = dstTextureD3D.CalcCopyLocation(dstLocation);
-    const D3D12_TEXTURE_COPY_LOCATION srcLocationD3D = srcTextureD3D.CalcCopyLocation(dstLocation);
+void D3D12CommandBuffer::CopyTexture(
+    Texture&                    dstTexture,
+    Texture&                    srcTexture,
+    std::uint32_t               numRegions,
+    const TextureCopyRegion*    regions)
+{
+    /* Copy commands and resource barriers are not allowed in bundles */
+    if (isBundle_ || numRegions == 0)
+        return;
 
-    const D3D12_BOX srcBox = srcTextureD3D.CalcRegion(srcLocation.offset, extent);
+    auto& dstTextureD3D = LLGL_CAST(D3D12Texture&, dstTexture);
+    auto& srcTextureD3D = LLGL_CAST(D3D12Texture&, srcTexture);
 
+    /* Transition both resources only once for all regions */
     commandContext_.TransitionResource(dstTextureD3D.GetResource(), D3D12_RESOURCE_STATE_COPY_DEST);
     commandContext_.TransitionResource(srcTextureD3D.GetResource(), D3D12_RESOURCE_STATE_COPY_SOURCE, true);
     {
-        commandList_->CopyTextureRegion(
-            &dstLocationD3D,                            // pDst
-            static_cast<UINT>(dstLocation.offset.x),    // DstX
-            static_cast<UINT>(dstLocation.offset.y),    // DstY
-            static_cast<UINT>(dstLocation.offset.z),    // DstZ
-            &srcLocationD3D,                            // pSrc
-            &srcBox                                     // pSrcBox
-        );
+        for (std::uint32_t i = 0; i < numRegions; ++i)
+        {
+            const auto& dstLocation = regions[i].dstLocation;
+            const auto& srcLocation = regions[i].srcLocation;
+
+            const D3D12_TEXTURE_COPY_LOCATION dstLocationD3D = dstTextureD3D.CalcCopyLocation(dstLocation);
+            const D3D12_TEXTURE_COPY_LOCATION srcLocationD3D = srcTextureD3D.CalcCopyLocation(srcLocation);
+
+            const D3D12_BOX srcBox = srcTextureD3D.CalcRegion(srcLocation.offset, regions[i].extent);
+
+            commandList_->CopyTextureRegion(
+                &dstLocationD3D,                            // pDst
+                static_cast<UINT>(dstLocation.offset.x),    // DstX
+                static_cast<UINT>(dstLocation.offset.y),    // DstY
+                static_cast<UINT>(dstLocation.offset.z),    // DstZ
+                &srcLocationD3D,                            // pSrc
+                &srcBox                                     // pSrcBox
+            );
+        }
     }
     commandContext_.TransitionResource(dstTextureD3D.GetResource(), dstTextureD3D.GetResource().usageState);
     commandContext_.TransitionResource(srcTextureD3D.GetResource(), srcTextureD3D.GetResource().usageState, true);
@@ -245,6 +421,10 @@ void D3D12CommandBuffer::CopyTextureFromBuffer(
     std::uint32_t           rowStride,
     std::uint32_t           layerStride)
 {
+    /* Copy commands and resource barriers are not allowed in bundles */
+    if (isBundle_)
+        return;
+
     auto& dstTextureD3D = LLGL_CAST(D3D12Texture&, dstTexture);
     auto& srcBufferD3D = LLGL_CAST(D3D12Buffer&, srcBuffer);
 
@@ -306,12 +486,20 @@ void D3D12CommandBuffer::CopyTextureFromBuffer(
 
 void D3D12CommandBuffer::GenerateMips(Texture& texture)
 {
+    /* Copy commands and resource barriers are not allowed in bundles */
+    if (isBundle_)
+        return;
+
     auto& textureD3D = LLGL_CAST(D3D12Texture&, texture);
     D3D12MipGenerator::Get().GenerateMips(commandContext_, textureD3D, textureD3D.GetWholeSubresource());
 }
 
 void D3D12CommandBuffer::GenerateMips(Texture& texture, const TextureSubresource& subresource)
 {
+    /* Copy commands and resource barriers are not allowed in bundles */
+    if (isBundle_)
+        return;
+
     auto& textureD3D = LLGL_CAST(D3D12Texture&, texture);
     D3D12MipGenerator::Get().GenerateMips(commandContext_, textureD3D, subresource);
 }
@@ -340,6 +528,10 @@ void D3D12CommandBuffer::SetViewport(const Viewport& viewport)
 
 void D3D12CommandBuffer::SetViewports(std::uint32_t numViewports, const Viewport* viewports)
 {
+    /* Bundles inherit viewports from the command list they are executed with */
+    if (isBundle_)
+        return;
+
     numViewports = std::min(numViewports, std::uint32_t(D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE));
 
     /* Check if D3D12_VIEWPORT and Viewport structures can be safely reinterpret-casted */
@@ -381,6 +573,10 @@ void D3D12CommandBuffer::SetScissor(const Scissor& scissor)
 
 void D3D12CommandBuffer::SetScissors(std::uint32_t numScissors, const Scissor* scissors)
 {
+    /* Bundles inherit scissor rectangles from the command list they are executed with */
+    if (isBundle_)
+        return;
+
     numScissors = std::min(numScissors, std::uint32_t(D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE));
 
     D3D12_RECT scissorsD3D[D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE];
@@ -415,6 +611,10 @@ static D3D12_CLEAR_FLAGS GetClearFlagsDSV(long flags)
 
 void D3D12CommandBuffer::Clear(long flags, const ClearValue& clearValue)
 {
+    /* Clear commands are not allowed in bundles */
+    if (isBundle_)
+        return;
+
     if (rtvDescHandle_.ptr != 0)
     {
         /* Clear color buffers */
@@ -448,6 +648,10 @@ void D3D12CommandBuffer::Clear(long flags, const ClearValue& clearValue)
 
 void D3D12CommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
 {
+    /* Clear commands are not allowed in bundles */
+    if (isBundle_)
+        return;
+
     for (std::uint32_t i = 0; i < numAttachments; ++i)
     {
         const auto& clearOp = attachments[i];
@@ -525,6 +729,16 @@ void D3D12CommandBuffer::SetResourceHeap(
     ResourceHeap&           resourceHeap,
     std::uint32_t           descriptorSet,
     const PipelineBindPoint bindPoint)
+{
+    SetResourceHeap(resourceHeap, descriptorSet, 0, nullptr, bindPoint);
+}
+
+void D3D12CommandBuffer::SetResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           descriptorSet,
+    std::uint32_t           numDynamicOffsets,
+    const std::uint32_t*    dynamicOffsets,
+    const PipelineBindPoint bindPoint)
 {
     auto& resourceHeapD3D = LLGL_CAST(D3D12ResourceHeap&, resourceHeap);
 
@@ -532,23 +746,72 @@ void D3D12CommandBuffer::SetResourceHeap(
     auto heapCount = resourceHeapD3D.GetNumDescriptorHeaps();
     if (heapCount > 0)
     {
-        /* Bind descriptor heaps and root descriptor tables */
-        auto descHeaps = resourceHeapD3D.GetDescriptorHeaps();
-        commandContext_.SetDescriptorHeaps(heapCount, descHeaps);
+        /* Bind shader-visible descriptor heaps (only once per command list since they are shared by all resource heaps) */
+        commandContext_.SetDescriptorHeaps(D3D12DescriptorHeapPool::g_numHeaps, D3D12DescriptorHeapPool::Get().GetDescriptorHeaps());
+
+        /* Copy descriptor set into shader-visible descriptor heaps and bind root descriptor tables */
+        D3D12_GPU_DESCRIPTOR_HANDLE gpuDescHandles[2];
+        resourceHeapD3D.CopyDescriptorSet(commandContext_, descriptorSet, gpuDescHandles);
 
         if (bindPoint != PipelineBindPoint::Compute)
-            resourceHeapD3D.SetGraphicsRootDescriptorTables(commandList_, descriptorSet);
+            resourceHeapD3D.SetGraphicsRootDescriptorTables(commandList_, gpuDescHandles);
         if (bindPoint != PipelineBindPoint::Graphics)
-            resourceHeapD3D.SetComputeRootDescriptorTables(commandList_, descriptorSet);
+            resourceHeapD3D.SetComputeRootDescriptorTables(commandList_, gpuDescHandles);
+
+        /* Insert resource barriers for the specified descriptor set (not allowed in bundles) */
+        if (!isBundle_)
+            resourceHeapD3D.InsertResourceBarriers(commandList_, descriptorSet);
+    }
 
-        /* Insert resource barriers for the specified descriptor set */
-        resourceHeapD3D.InsertResourceBarriers(commandList_, descriptorSet);
+    /* Bind root descriptors of dynamic-offset bindings without copying any descriptors */
+    if (resourceHeapD3D.HasRootDescriptors())
+    {
+        if (bindPoint != PipelineBindPoint::Compute)
+            resourceHeapD3D.SetGraphicsRootDescriptors(commandList_, descriptorSet, numDynamicOffsets, dynamicOffsets);
+        if (bindPoint != PipelineBindPoint::Graphics)
+            resourceHeapD3D.SetComputeRootDescriptors(commandList_, descriptorSet, numDynamicOffsets, dynamicOffsets);
     }
 }
 
-void D3D12CommandBuffer::SetResource(Resource& resource, std::uint32_t slot, long bindFlags, long stageFlags)
+void D3D12CommandBuffer::SetResource(Resource& resource, std::uint32_t slot, long bindFlags, long /*stageFlags*/)
 {
-    //TODOL: use "SetGraphicsRootShaderResourceView" etc.
+    /* Only buffers can be set directly, if they have been declared as dynamic bindings in the pipeline layout */
+    if (boundPipelineLayout_ == nullptr || resource.GetResourceType() != ResourceType::Buffer)
+        return;
+
+    if (auto binding = boundPipelineLayout_->FindDynamicBinding(bindFlags, slot))
+    {
+        auto& bufferD3D = LLGL_CAST(D3D12Buffer&, resource);
+        const auto gpuVirtualAddress = bufferD3D.GetNative()->GetGPUVirtualAddress();
+
+        /* Set buffer as root descriptor without copying any descriptors */
+        switch (binding->type)
+        {
+            case D3D12_ROOT_PARAMETER_TYPE_CBV:
+                if (isGraphicsPSOBound_)
+                    commandList_->SetGraphicsRootConstantBufferView(binding->rootParameter, gpuVirtualAddress);
+                else
+                    commandList_->SetComputeRootConstantBufferView(binding->rootParameter, gpuVirtualAddress);
+                break;
+
+            case D3D12_ROOT_PARAMETER_TYPE_SRV:
+                if (isGraphicsPSOBound_)
+                    commandList_->SetGraphicsRootShaderResourceView(binding->rootParameter, gpuVirtualAddress);
+                else
+                    commandList_->SetComputeRootShaderResourceView(binding->rootParameter, gpuVirtualAddress);
+                break;
+
+            case D3D12_ROOT_PARAMETER_TYPE_UAV:
+                if (isGraphicsPSOBound_)
+                    commandList_->SetGraphicsRootUnorderedAccessView(binding->rootParameter, gpuVirtualAddress);
+                else
+                    commandList_->SetComputeRootUnorderedAccessView(binding->rootParameter, gpuVirtualAddress);
+                break;
+
+            default:
+                break;
+        }
+    }
 }
 
 void D3D12CommandBuffer::ResetResourceSlots(
@@ -558,6 +821,10 @@ void D3D12CommandBuffer::ResetResourceSlots(
     long                bindFlags,
     long                stageFlags)
 {
+    /* Stream-output targets are not allowed in bundles */
+    if (isBundle_)
+        return;
+
 
     const D3D12_STREAM_OUTPUT_BUFFER_VIEW nullViews[1] = {};
     commandList_->SOSetTargets(0, 1, nullViews);
@@ -573,8 +840,15 @@ void D3D12CommandBuffer::BeginRenderPass(
     std::uint32_t       numClearValues,
     const ClearValue*   clearValues)
 {
+    /* Bundles inherit render targets from the command list they are executed with */
+    if (isBundle_)
+        return;
+
     boundRenderTarget_ = &(renderTarget);
 
+    /* Complete split transitions of previous render passes, since their attachments might be read in this render pass */
+    commandContext_.EndSplitTransitions();
+
     /* Bind render target/context */
     if (LLGL::IsInstanceOf<SwapChain>(renderTarget))
         BindSwapChain(LLGL_CAST(D3D12SwapChain&, renderTarget));
@@ -586,11 +860,23 @@ void D3D12CommandBuffer::BeginRenderPass(
     {
         auto renderPassD3D = LLGL_CAST(const D3D12RenderPass*, renderPass);
         ClearAttachmentsWithRenderPass(*renderPassD3D, numClearValues, clearValues);
+
+        /* Bind attachments of first sub-pass */
+        subpass_ = 0;
+        if (renderPassD3D->GetNumSubpasses() > 0)
+        {
+            renderPass_ = renderPassD3D;
+            BindSubpass(*renderPass_, subpass_);
+        }
     }
 }
 
 void D3D12CommandBuffer::EndRenderPass()
 {
+    /* Bundles inherit render targets from the command list they are executed with */
+    if (isBundle_)
+        return;
+
     if (boundRenderTarget_)
     {
         if (LLGL::IsInstanceOf<SwapChain>(*boundRenderTarget_))
@@ -605,14 +891,46 @@ void D3D12CommandBuffer::EndRenderPass()
         }
         boundRenderTarget_ = nullptr;
     }
+    renderPass_ = nullptr;
+
+    /* Unbind shading-rate image, so it can be transitioned back and is not applied to other render targets */
+    if (isShadingRateImageBound_)
+    {
+        vrsCommandList_->RSSetShadingRateImage(nullptr);
+        isShadingRateImageBound_ = false;
+    }
+}
+
+void D3D12CommandBuffer::NextSubpass()
+{
+    if (renderPass_ != nullptr && subpass_ + 1 < renderPass_->GetNumSubpasses())
+        BindSubpass(*renderPass_, ++subpass_);
 }
 
 /* ----- Pipeline States ----- */
 
 void D3D12CommandBuffer::SetPipelineState(PipelineState& pipelineState)
 {
-    /* Bind pipeline state to command context */
     auto& pipelineStateD3D = LLGL_CAST(D3D12PipelineState&, pipelineState);
+
+    /* Skip draw or dispatch commands while an asynchronously created PSO is pending, otherwise wait until it is ready */
+    const bool skipCommands = pipelineStateD3D.SkipDraws();
+    if (pipelineStateD3D.IsGraphicsPSO())
+        skipDraws_ = skipCommands;
+    else
+        skipDispatches_ = skipCommands;
+
+    if (skipCommands)
+        return;
+
+    pipelineStateD3D.Wait();
+
+    /* Bind pipeline state to command context */
+
+    /* Store pipeline layout for dynamic bindings and inline uniforms */
+    boundPipelineLayout_    = pipelineStateD3D.GetPipelineLayout();
+    isGraphicsPSOBound_     = pipelineStateD3D.IsGraphicsPSO();
+
     if (pipelineStateD3D.IsGraphicsPSO())
     {
         /* Bind graphics PSO */
@@ -621,7 +939,7 @@ void D3D12CommandBuffer::SetPipelineState(PipelineState& pipelineState)
 
         /* Scissor rectangle must be updated (if scissor test is disabled) */
         scissorEnabled_ = graphicsPSO.IsScissorEnabled();
-        if (!scissorEnabled_ && commandList_->GetType() == D3D12_COMMAND_LIST_TYPE_DIRECT)
+        if (!scissorEnabled_ && !isBundle_)
             SetScissorRectsToDefault(graphicsPSO.NumDefaultScissorRects());
     }
     else
@@ -642,6 +960,15 @@ void D3D12CommandBuffer::SetStencilReference(std::uint32_t reference, const Sten
     commandList_->OMSetStencilRef(reference);
 }
 
+void D3D12CommandBuffer::SetShadingRate(const ShadingRate rate)
+{
+    if (!vrsCommandList_)
+        return;
+
+    shadingRate_ = D3D12Types::Map(rate);
+    FlushShadingRate();
+}
+
 void D3D12CommandBuffer::SetUniform(
     UniformLocation location,
     const void*     data,
@@ -652,27 +979,80 @@ void D3D12CommandBuffer::SetUniform(
 
 void D3D12CommandBuffer::SetUniforms(
     UniformLocation location,
-    std::uint32_t   count,
+    std::uint32_t   /*count*/,
     const void*     data,
     std::uint32_t   dataSize)
 {
-    //TODO
+    if (boundPipelineLayout_ == nullptr || location < 0)
+        return;
+
+    auto first      = static_cast<UINT>(location);
+    auto num        = static_cast<UINT>(dataSize / 4);
+    auto values     = reinterpret_cast<const UINT*>(data);
+
+    /* Set 32-bit root constants of all inline uniform bindings that overlap with the specified range */
+    for (const auto& uniforms : boundPipelineLayout_->GetInlineUniforms())
+    {
+        if (num == 0)
+            break;
+
+        const auto end = uniforms.first32BitValue + uniforms.num32BitValues;
+        if (first >= uniforms.first32BitValue && first < end)
+        {
+            const auto offset       = first - uniforms.first32BitValue;
+            const auto numValues    = std::min(num, end - first);
+
+            if (isGraphicsPSOBound_)
+                commandList_->SetGraphicsRoot32BitConstants(uniforms.rootParameter, numValues, values, offset);
+            else
+                commandList_->SetComputeRoot32BitConstants(uniforms.rootParameter, numValues, values, offset);
+
+            first   += numValues;
+            num     -= numValues;
+            values  += numValues;
+        }
+    }
 }
 
 /* ----- Queries ----- */
 
 void D3D12CommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
+    /* Queries are not allowed in bundles */
+    if (isBundle_)
+        return;
+
     auto& queryHeapD3D = LLGL_CAST(D3D12QueryHeap&, queryHeap);
     queryHeapD3D.Begin(commandList_, query);
 }
 
 void D3D12CommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
+    /* Queries are not allowed in bundles */
+    if (isBundle_)
+        return;
+
     auto& queryHeapD3D = LLGL_CAST(D3D12QueryHeap&, queryHeap);
     queryHeapD3D.End(commandList_, query);
 }
 
+void D3D12CommandBuffer::ResolveQueries(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries)
+{
+    /* Queries are not allowed in bundles */
+    if (isBundle_)
+        return;
+
+    /* Readback slot is completed once the allocator fence of this command list has been signaled */
+    auto& queryHeapD3D = LLGL_CAST(D3D12QueryHeap&, queryHeap);
+    queryHeapD3D.ResolveToReadbackRing(
+        commandList_,
+        commandContext_.GetAllocatorFence(),
+        commandContext_.GetCurrentFenceValue(),
+        firstQuery,
+        numQueries
+    );
+}
+
 static D3D12_PREDICATION_OP GetDXPredicateOp(const RenderConditionMode mode)
 {
     if (mode >= RenderConditionMode::WaitInverted)
@@ -683,6 +1063,10 @@ static D3D12_PREDICATION_OP GetDXPredicateOp(const RenderConditionMode mode)
 
 void D3D12CommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
 {
+    /* Predication is not allowed in bundles */
+    if (isBundle_)
+        return;
+
     auto& queryHeapD3D = LLGL_CAST(D3D12QueryHeap&, queryHeap);
 
     /* Flush query result data if it was marked as dirty */
@@ -699,6 +1083,10 @@ void D3D12CommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_
 
 void D3D12CommandBuffer::EndRenderCondition()
 {
+    /* Predication is not allowed in bundles */
+    if (isBundle_)
+        return;
+
     commandList_->SetPredication(nullptr, 0, D3D12_PREDICATION_OP_EQUAL_ZERO);
 }
 
@@ -706,6 +1094,10 @@ void D3D12CommandBuffer::EndRenderCondition()
 
 void D3D12CommandBuffer::BeginStreamOutput(std::uint32_t numBuffers, Buffer* const * buffers)
 {
+    /* Stream-output targets are not allowed in bundles */
+    if (isBundle_)
+        return;
+
     D3D12_STREAM_OUTPUT_BUFFER_VIEW soBufferViews[LLGL_MAX_NUM_SO_BUFFERS];
     D3D12Buffer* buffersD3D[LLGL_MAX_NUM_SO_BUFFERS];
 
@@ -722,7 +1114,7 @@ void D3D12CommandBuffer::BeginStreamOutput(std::uint32_t numBuffers, Buffer* con
     commandContext_.FlushResourceBarrieres();
 
     /* Reset counter values in buffers by copying from a static zero-initialized buffer to the stream-output targets */
-    const auto srcBufferView = D3D12BufferConstantsPool::Get().FetchConstants(D3D12BufferConstants::ZeroUInt64);
+    const auto srcBufferView = constantsPool_->FetchConstants(D3D12BufferConstants::ZeroUInt64);
 
     for (std::uint32_t i = 0; i < numBuffers; ++i)
     {
@@ -746,6 +1138,10 @@ void D3D12CommandBuffer::BeginStreamOutput(std::uint32_t numBuffers, Buffer* con
 
 void D3D12CommandBuffer::EndStreamOutput()
 {
+    /* Stream-output targets are not allowed in bundles */
+    if (isBundle_)
+        return;
+
     const D3D12_STREAM_OUTPUT_BUFFER_VIEW soBufferViewsNull[LLGL_MAX_NUM_SO_BUFFERS] = {};
     commandList_->SOSetTargets(0, LLGL_MAX_NUM_SO_BUFFERS, soBufferViewsNull);
 }
@@ -754,46 +1150,73 @@ void D3D12CommandBuffer::EndStreamOutput()
 
 void D3D12CommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
 {
+    if (skipDraws_)
+        return;
+
     commandList_->DrawInstanced(numVertices, 1, firstVertex, 0);
 }
 
 void D3D12CommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
 {
+    if (skipDraws_)
+        return;
+
     commandList_->DrawIndexedInstanced(numIndices, 1, firstIndex, 0, 0);
 }
 
 void D3D12CommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    if (skipDraws_)
+        return;
+
     commandList_->DrawIndexedInstanced(numIndices, 1, firstIndex, vertexOffset, 0);
 }
 
 void D3D12CommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
 {
+    if (skipDraws_)
+        return;
+
     commandList_->DrawInstanced(numVertices, numInstances, firstVertex, 0);
 }
 
 void D3D12CommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
 {
+    if (skipDraws_)
+        return;
+
     commandList_->DrawInstanced(numVertices, numInstances, firstVertex, firstInstance);
 }
 
 void D3D12CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
 {
+    if (skipDraws_)
+        return;
+
     commandList_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, 0, 0);
 }
 
 void D3D12CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    if (skipDraws_)
+        return;
+
     commandList_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, 0);
 }
 
 void D3D12CommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
+    if (skipDraws_)
+        return;
+
     commandList_->DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
 }
 
 void D3D12CommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    if (skipDraws_)
+        return;
+
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
     commandList_->ExecuteIndirect(
         cmdSignatureFactory_->GetSignatureDrawIndirect(), 1, bufferD3D.GetNative(), offset, nullptr, 0
@@ -802,6 +1225,9 @@ void D3D12CommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 
 void D3D12CommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    if (skipDraws_)
+        return;
+
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
     while (numCommands-- > 0)
     {
@@ -814,6 +1240,9 @@ void D3D12CommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std:
 
 void D3D12CommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    if (skipDraws_)
+        return;
+
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
     commandList_->ExecuteIndirect(
         cmdSignatureFactory_->GetSignatureDrawIndexedIndirect(), 1, bufferD3D.GetNative(), offset, nullptr, 0
@@ -822,6 +1251,9 @@ void D3D12CommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offse
 
 void D3D12CommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    if (skipDraws_)
+        return;
+
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
     while (numCommands-- > 0)
     {
@@ -832,16 +1264,133 @@ void D3D12CommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offse
     }
 }
 
+void D3D12CommandBuffer::DrawIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride)
+{
+    if (skipDraws_)
+        return;
+
+    auto& bufferD3D         = LLGL_CAST(D3D12Buffer&, buffer);
+    auto& countBufferD3D    = LLGL_CAST(D3D12Buffer&, countBuffer);
+    commandList_->ExecuteIndirect(
+        cmdSignatureFactory_->GetSignatureDrawIndirect(stride),
+        maxNumCommands,
+        bufferD3D.GetNative(),
+        offset,
+        countBufferD3D.GetNative(),
+        countOffset
+    );
+}
+
+void D3D12CommandBuffer::DrawIndexedIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride)
+{
+    if (skipDraws_)
+        return;
+
+    auto& bufferD3D         = LLGL_CAST(D3D12Buffer&, buffer);
+    auto& countBufferD3D    = LLGL_CAST(D3D12Buffer&, countBuffer);
+    commandList_->ExecuteIndirect(
+        cmdSignatureFactory_->GetSignatureDrawIndexedIndirect(stride),
+        maxNumCommands,
+        bufferD3D.GetNative(),
+        offset,
+        countBufferD3D.GetNative(),
+        countOffset
+    );
+}
+
+std::uint32_t D3D12CommandBuffer::DrawPatchable(const DrawIndirectArguments& args)
+{
+    if (skipDraws_)
+        return Constants::invalidPatchSlot;
+
+    /* Record indirect draw command whose arguments are read from a persistently mapped upload buffer */
+    ID3D12Resource* buffer = nullptr;
+    UINT64 offset = 0;
+    auto mappedData = AllocPatchArguments(sizeof(DrawIndirectArguments), buffer, offset);
+    ::memcpy(mappedData, &args, sizeof(args));
+
+    commandList_->ExecuteIndirect(cmdSignatureFactory_->GetSignatureDrawIndirect(), 1, buffer, offset, nullptr, 0);
+
+    const auto slot = static_cast<std::uint32_t>(patchSlots_.size());
+    patchSlots_.push_back({ mappedData, false });
+    return slot;
+}
+
+std::uint32_t D3D12CommandBuffer::DrawIndexedPatchable(const DrawIndexedIndirectArguments& args)
+{
+    if (skipDraws_)
+        return Constants::invalidPatchSlot;
+
+    /* Record indirect indexed draw command whose arguments are read from a persistently mapped upload buffer */
+    ID3D12Resource* buffer = nullptr;
+    UINT64 offset = 0;
+    auto mappedData = AllocPatchArguments(sizeof(DrawIndexedIndirectArguments), buffer, offset);
+    ::memcpy(mappedData, &args, sizeof(args));
+
+    commandList_->ExecuteIndirect(cmdSignatureFactory_->GetSignatureDrawIndexedIndirect(), 1, buffer, offset, nullptr, 0);
+
+    const auto slot = static_cast<std::uint32_t>(patchSlots_.size());
+    patchSlots_.push_back({ mappedData, true });
+    return slot;
+}
+
+bool D3D12CommandBuffer::PatchDraw(std::uint32_t slot, const DrawIndirectArguments& args)
+{
+    if (slot < patchSlots_.size() && !patchSlots_[slot].indexed)
+    {
+        ::memcpy(patchSlots_[slot].mappedData, &args, sizeof(args));
+        return true;
+    }
+    return false;
+}
+
+bool D3D12CommandBuffer::PatchDrawIndexed(std::uint32_t slot, const DrawIndexedIndirectArguments& args)
+{
+    if (slot < patchSlots_.size() && patchSlots_[slot].indexed)
+    {
+        ::memcpy(patchSlots_[slot].mappedData, &args, sizeof(args));
+        return true;
+    }
+    return false;
+}
+
+void D3D12CommandBuffer::DrawMeshTasks(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
+{
+    if (skipDraws_ || !meshCommandList_)
+        return;
+
+    meshCommandList_->DispatchMesh(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+}
+
+void D3D12CommandBuffer::DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    if (skipDraws_ || !meshCommandList_)
+        return;
+
+    auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+    commandList_->ExecuteIndirect(
+        cmdSignatureFactory_->GetSignatureDispatchMeshIndirect(stride), numCommands, bufferD3D.GetNative(), offset, nullptr, 0
+    );
+}
+
 /* ----- Compute ----- */
 
 void D3D12CommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
 {
+    if (skipDispatches_)
+        return;
+
+    commandContext_.EndSplitTransitions(true);
     commandList_->Dispatch(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
 }
 
 void D3D12CommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    if (skipDispatches_)
+        return;
+
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+    commandContext_.EndSplitTransitions(true);
     commandList_->ExecuteIndirect(
         cmdSignatureFactory_->GetSignatureDispatchIndirect(), 1, bufferD3D.GetNative(), offset, nullptr, 0
     );
@@ -872,6 +1421,17 @@ void D3D12CommandBuffer::SetGraphicsAPIDependentState(const void* stateDesc, std
 void D3D12CommandBuffer::Execute()
 {
     commandContext_.Execute();
+
+    for (auto bundle : executedBundles_)
+        bundle->GetCommandContext().SignalAllocatorFence();
+}
+
+void D3D12CommandBuffer::SignalAllocatorFences()
+{
+    commandContext_.SignalAllocatorFence();
+
+    for (auto bundle : executedBundles_)
+        bundle->GetCommandContext().SignalAllocatorFence();
 }
 
 
@@ -879,10 +1439,12 @@ void D3D12CommandBuffer::Execute()
  * ======= Private: =======
  */
 
-static D3D12_COMMAND_LIST_TYPE GetD3DCommandListType(const CommandBufferDescriptor& desc)
+static D3D12_COMMAND_LIST_TYPE GetD3DCommandListType(const CommandBufferDescriptor& desc, bool hasComputeQueue)
 {
     if ((desc.flags & CommandBufferFlags::Secondary) != 0)
         return D3D12_COMMAND_LIST_TYPE_BUNDLE;
+    else if ((desc.flags & CommandBufferFlags::ComputeQueue) != 0 && hasComputeQueue)
+        return D3D12_COMMAND_LIST_TYPE_COMPUTE;
     else
         return D3D12_COMMAND_LIST_TYPE_DIRECT;
 }
@@ -891,10 +1453,25 @@ void D3D12CommandBuffer::CreateCommandContext(D3D12RenderSystem& renderSystem, c
 {
     auto& device = renderSystem.GetDevice();
 
-    /* Create command context and store reference to command list */
-    auto commandQueueD3D = LLGL_CAST(D3D12CommandQueue*, renderSystem.GetCommandQueue());
-    commandContext_.Create(device, *commandQueueD3D, GetD3DCommandListType(desc), desc.numNativeBuffers, true);
+    /* Create command context for the queue this command buffer is submitted to and store reference to command list */
+    const D3D12_COMMAND_LIST_TYPE listType = GetD3DCommandListType(desc, renderSystem.GetComputeQueue() != nullptr);
+    auto commandQueue = (listType == D3D12_COMMAND_LIST_TYPE_COMPUTE ? renderSystem.GetComputeQueue() : renderSystem.GetCommandQueue());
+    auto commandQueueD3D = LLGL_CAST(D3D12CommandQueue*, commandQueue);
+    commandContext_.Create(device, *commandQueueD3D, listType, desc.numNativeBuffers, true);
     commandList_ = commandContext_.GetCommandList();
+    isBundle_    = (listType == D3D12_COMMAND_LIST_TYPE_BUNDLE);
+
+    /* Query command list interface for mesh shader dispatches; this fails on older runtimes, in which case mesh shaders are not supported */
+    commandList_->QueryInterface(IID_PPV_ARGS(meshCommandList_.ReleaseAndGetAddressOf()));
+
+    /* Query command list interface for variable rate shading and whether shading-rate images are supported (tier 2) */
+    D3D12_FEATURE_DATA_D3D12_OPTIONS6 options6 = {};
+    if (SUCCEEDED(device.GetNative()->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS6, &options6, sizeof(options6))) &&
+        options6.VariableShadingRateTier != D3D12_VARIABLE_SHADING_RATE_TIER_NOT_SUPPORTED)
+    {
+        commandList_->QueryInterface(IID_PPV_ARGS(vrsCommandList_.ReleaseAndGetAddressOf()));
+        hasShadingRateImages_ = (options6.VariableShadingRateTier >= D3D12_VARIABLE_SHADING_RATE_TIER_2);
+    }
 
     /* Store increment size for descriptor heaps */
     rtvDescSize_ = device.GetNative()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
@@ -940,6 +1517,50 @@ void D3D12CommandBuffer::BindRenderTarget(D3D12RenderTarget& renderTargetD3D)
         commandList_->OMSetRenderTargets(numColorBuffers_, &rtvDescHandle_, TRUE, &dsvDescHandle_);
     else
         commandList_->OMSetRenderTargets(numColorBuffers_, &rtvDescHandle_, TRUE, nullptr);
+
+    /* Bind optional shading-rate image; the combiners must be set as well, since the default combiners ignore the image */
+    if (auto shadingRateImage = renderTargetD3D.GetShadingRateImage())
+    {
+        if (vrsCommandList_ && hasShadingRateImages_)
+        {
+            FlushShadingRate();
+            vrsCommandList_->RSSetShadingRateImage(shadingRateImage);
+            isShadingRateImageBound_ = true;
+        }
+    }
+}
+
+void D3D12CommandBuffer::BindSubpass(const D3D12RenderPass& renderPassD3D, std::uint32_t subpass)
+{
+    /* Sub-passes are only emulated for render targets, since swap-chains only have a single color buffer */
+    if (boundRenderTarget_ == nullptr || LLGL::IsInstanceOf<SwapChain>(*boundRenderTarget_))
+        return;
+
+    auto renderTargetD3D = LLGL_CAST(D3D12RenderTarget*, boundRenderTarget_);
+    const std::uint32_t colorAttachments = renderPassD3D.GetSubpassColorAttachments(subpass);
+
+    /* Transition input attachments to shader resources */
+    renderTargetD3D->TransitionToSubpass(commandContext_, colorAttachments, renderPassD3D.GetSubpassInputAttachments(subpass));
+
+    /* Bind RTVs of all color attachments that are written by this sub-pass and replace all others by a null RTV */
+    D3D12_CPU_DESCRIPTOR_HANDLE rtvDescHandles[LLGL_MAX_NUM_COLOR_ATTACHMENTS];
+    const UINT numRenderTargetViews = std::min<UINT>(numColorBuffers_, LLGL_MAX_NUM_COLOR_ATTACHMENTS);
+
+    for (UINT i = 0; i < numRenderTargetViews; ++i)
+    {
+        if ((colorAttachments & (1u << i)) != 0)
+        {
+            rtvDescHandles[i] = rtvDescHandle_;
+            rtvDescHandles[i].ptr += rtvDescSize_ * i;
+        }
+        else
+            rtvDescHandles[i] = renderTargetD3D->GetCPUDescriptorHandleForNullRTV();
+    }
+
+    if (dsvDescHandle_.ptr != 0 && renderPassD3D.HasSubpassDepthStencil(subpass))
+        commandList_->OMSetRenderTargets(numRenderTargetViews, rtvDescHandles, FALSE, &dsvDescHandle_);
+    else
+        commandList_->OMSetRenderTargets(numRenderTargetViews, rtvDescHandles, FALSE, nullptr);
 }
 
 void D3D12CommandBuffer::BindSwapChain(D3D12SwapChain& swapChainD3D)
@@ -1074,6 +1695,61 @@ void D3D12CommandBuffer::ClearDepthStencilView(
     commandList_->ClearDepthStencilView(dsvDescHandle_, clearFlags, depth, stencil, numRects, rects);
 }
 
+void D3D12CommandBuffer::FlushShadingRate()
+{
+    if (hasShadingRateImages_)
+    {
+        /* Ignore per-primitive shading rate and use the coarser rate of the dynamic shading rate and the shading-rate image */
+        const D3D12_SHADING_RATE_COMBINER combiners[D3D12_RS_SET_SHADING_RATE_COMBINER_COUNT] =
+        {
+            D3D12_SHADING_RATE_COMBINER_PASSTHROUGH,
+            D3D12_SHADING_RATE_COMBINER_MAX,
+        };
+        vrsCommandList_->RSSetShadingRate(shadingRate_, combiners);
+    }
+    else
+    {
+        /* Combiners are not supported by variable shading rate tier 1 */
+        vrsCommandList_->RSSetShadingRate(shadingRate_, nullptr);
+    }
+}
+
+char* D3D12CommandBuffer::AllocPatchArguments(UINT64 size, ID3D12Resource*& outBuffer, UINT64& outOffset)
+{
+    const UINT allocatorIndex = commandContext_.GetCurrentAllocatorIndex();
+    if (patchBlockLists_.size() <= allocatorIndex)
+        patchBlockLists_.resize(allocatorIndex + 1);
+
+    /* Continue with next patch block if the current one is full; blocks are kept for subsequent recordings with the same allocator */
+    auto& patchBlocks = patchBlockLists_[allocatorIndex];
+    if (numPatchBlocks_ == 0 || patchBlockOffset_ + size > patchBlocks[numPatchBlocks_ - 1].buffer.GetSize())
+    {
+        if (numPatchBlocks_ == patchBlocks.size())
+        {
+            D3D12PatchBlock patchBlock;
+            patchBlock.buffer.Create(device_, g_patchBlockSize);
+
+            /* Map upload buffer persistently; the CPU never reads from it */
+            const D3D12_RANGE readRange = { 0, 0 };
+            void* mappedData = nullptr;
+            auto hr = patchBlock.buffer.GetNative()->Map(0, &readRange, &mappedData);
+            DXThrowIfFailed(hr, "failed to map D3D12 upload buffer for patchable draw commands");
+            patchBlock.mappedData = reinterpret_cast<char*>(mappedData);
+
+            patchBlocks.push_back(std::move(patchBlock));
+        }
+        ++numPatchBlocks_;
+        patchBlockOffset_ = 0;
+    }
+
+    auto& patchBlock = patchBlocks[numPatchBlocks_ - 1];
+    outBuffer           = patchBlock.buffer.GetNative();
+    outOffset           = patchBlockOffset_;
+    patchBlockOffset_   += size;
+
+    return patchBlock.mappedData + outOffset;
+}
+
 
 } // /namespace LLGL
 
@@ -18,6 +18,7 @@
 
 #include <d3d12.h>
 #include <dxgi1_4.h>
+#include <vector>
 
 
 namespace LLGL
@@ -29,6 +30,9 @@ class D3D12SwapChain;
 class D3D12RenderTarget;
 class D3D12RenderPass;
 class D3D12SignatureFactory;
+class D3D12PipelineLayout;
+class D3D12ReadbackPool;
+class D3D12BufferConstantsPool;
 struct D3D12Resource;
 
 class D3D12CommandBuffer final : public CommandBuffer
@@ -58,6 +62,12 @@ class D3D12CommandBuffer final : public CommandBuffer
             std::uint16_t   dataSize
         ) override;
 
+        void UpdateBuffer(
+            Buffer&                     dstBuffer,
+            std::uint32_t               numRegions,
+            const BufferWriteRegion*    regions
+        ) override;
+
         void CopyBuffer(
             Buffer&         dstBuffer,
             std::uint64_t   dstOffset,
@@ -66,6 +76,13 @@ class D3D12CommandBuffer final : public CommandBuffer
             std::uint64_t   size
         ) override;
 
+        void CopyBuffer(
+            Buffer&                     dstBuffer,
+            Buffer&                     srcBuffer,
+            std::uint32_t               numRegions,
+            const BufferCopyRegion*     regions
+        ) override;
+
         void CopyBufferFromTexture(
             Buffer&                 dstBuffer,
             std::uint64_t           dstOffset,
@@ -75,6 +92,9 @@ class D3D12CommandBuffer final : public CommandBuffer
             std::uint32_t           layerStride = 0
         ) override;
 
+        std::uint64_t CopyBufferToReadback(Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size) override;
+        std::uint64_t CopyTextureToReadback(Texture& srcTexture, const TextureRegion& srcRegion) override;
+
         void FillBuffer(
             Buffer&         dstBuffer,
             std::uint64_t   dstOffset,
@@ -90,6 +110,13 @@ class D3D12CommandBuffer final : public CommandBuffer
             const Extent3D&         extent
         ) override;
 
+        void CopyTexture(
+            Texture&                    dstTexture,
+            Texture&                    srcTexture,
+            std::uint32_t               numRegions,
+            const TextureCopyRegion*    regions
+        ) override;
+
         void CopyTextureFromBuffer(
             Texture&                dstTexture,
             const TextureRegion&    dstRegion,
@@ -126,6 +153,14 @@ class D3D12CommandBuffer final : public CommandBuffer
             const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined
         ) override;
 
+        void SetResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           descriptorSet,
+            std::uint32_t           numDynamicOffsets,
+            const std::uint32_t*    dynamicOffsets,
+            const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined
+        ) override;
+
         void SetResource(Resource& resource, std::uint32_t slot, long bindFlags, long stageFlags = StageFlags::AllStages) override;
 
         void ResetResourceSlots(
@@ -146,6 +181,7 @@ class D3D12CommandBuffer final : public CommandBuffer
         ) override;
 
         void EndRenderPass() override;
+        void NextSubpass() override;
 
         void Clear(long flags, const ClearValue& clearValue = {}) override;
         void ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments) override;
@@ -155,6 +191,7 @@ class D3D12CommandBuffer final : public CommandBuffer
         void SetPipelineState(PipelineState& pipelineState) override;
         void SetBlendFactor(const ColorRGBAf& color) override;
         void SetStencilReference(std::uint32_t reference, const StencilFace stencilFace = StencilFace::FrontAndBack) override;
+        void SetShadingRate(const ShadingRate rate) override;
 
         void SetUniform(
             UniformLocation location,
@@ -173,6 +210,7 @@ class D3D12CommandBuffer final : public CommandBuffer
 
         void BeginQuery(QueryHeap& queryHeap, std::uint32_t query = 0) override;
         void EndQuery(QueryHeap& queryHeap, std::uint32_t query = 0) override;
+        void ResolveQueries(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries) override;
 
         void BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query = 0, const RenderConditionMode mode = RenderConditionMode::Wait) override;
         void EndRenderCondition() override;
@@ -202,6 +240,18 @@ class D3D12CommandBuffer final : public CommandBuffer
         void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset) override;
         void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
 
+        void DrawIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride) override;
+        void DrawIndexedIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride) override;
+
+        std::uint32_t DrawPatchable(const DrawIndirectArguments& args) override;
+        std::uint32_t DrawIndexedPatchable(const DrawIndexedIndirectArguments& args) override;
+
+        bool PatchDraw(std::uint32_t slot, const DrawIndirectArguments& args) override;
+        bool PatchDrawIndexed(std::uint32_t slot, const DrawIndexedIndirectArguments& args) override;
+
+        void DrawMeshTasks(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ) override;
+        void DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
+
         /* ----- Compute ----- */
 
         void Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ) override;
@@ -223,18 +273,55 @@ class D3D12CommandBuffer final : public CommandBuffer
         // Executes this command buffer.
         void Execute();
 
+        // Signals the allocator fences of this command buffer and all bundles it executes. Must be called after the command list has been submitted.
+        void SignalAllocatorFences();
+
         // Returns the native ID3D12GraphicsCommandList object.
         inline ID3D12GraphicsCommandList* GetNative() const
         {
             return commandList_;
         }
 
+        // Returns the command context of this command buffer.
+        inline D3D12CommandContext& GetCommandContext()
+        {
+            return commandContext_;
+        }
+
+        // Returns the staging ring for dynamic buffer updates of this command buffer.
+        inline const D3D12StagingBufferPool& GetStagingBufferPool() const
+        {
+            return stagingBufferPool_;
+        }
+
         // Returns true if this is an immediate command buffer.
         inline bool IsImmediateCmdBuffer() const
         {
             return immediateSubmit_;
         }
 
+        // Returns true if this is a secondary command buffer that records a D3D12 bundle.
+        inline bool IsBundle() const
+        {
+            return isBundle_;
+        }
+
+    private:
+
+        // Persistently mapped upload buffer with indirect arguments for patchable draw commands.
+        struct D3D12PatchBlock
+        {
+            D3D12StagingBuffer  buffer;
+            char*               mappedData = nullptr;
+        };
+
+        // Indirect arguments of a patchable draw command.
+        struct D3D12PatchSlot
+        {
+            char*   mappedData;
+            bool    indexed;
+        };
+
     private:
 
         void CreateCommandContext(D3D12RenderSystem& renderSystem, const CommandBufferDescriptor& desc);
@@ -242,6 +329,9 @@ class D3D12CommandBuffer final : public CommandBuffer
         void SetScissorRectsToDefault(UINT numScissorRects);
 
         void BindRenderTarget(D3D12RenderTarget& renderTargetD3D);
+
+        // Rebinds the subset of the bound render target's attachments that is used by the specified sub-pass.
+        void BindSubpass(const D3D12RenderPass& renderPassD3D, std::uint32_t subpass);
         void BindSwapChain(D3D12SwapChain& swapChainD3D);
 
         void ClearAttachmentsWithRenderPass(
@@ -270,15 +360,29 @@ class D3D12CommandBuffer final : public CommandBuffer
             const D3D12_RECT*   rects
         );
 
+        // Sets the current shading rate with combiners for the shading-rate image if supported.
+        void FlushShadingRate();
+
+        // Allocates indirect arguments for a patchable draw command within the patch blocks of the current command allocator.
+        char* AllocPatchArguments(UINT64 size, ID3D12Resource*& outBuffer, UINT64& outOffset);
+
     private:
 
         D3D12CommandContext             commandContext_;
         ID3D12GraphicsCommandList*      commandList_            = nullptr;
+        ComPtr<ID3D12GraphicsCommandList6> meshCommandList_;    // Only available on devices with mesh shader support
+        ComPtr<ID3D12GraphicsCommandList5> vrsCommandList_;     // Only available on devices with variable rate shading support
         const D3D12SignatureFactory*    cmdSignatureFactory_    = nullptr;
 
         D3D12StagingBufferPool          stagingBufferPool_;
+        D3D12ReadbackPool*              readbackPool_           = nullptr;
+        const D3D12BufferConstantsPool* constantsPool_          = nullptr;
 
         bool                            immediateSubmit_        = false;
+        bool                            isBundle_               = false;
+
+        /* Bundles executed by this command buffer; their allocators must not be reset before this command list has been completed */
+        std::vector<D3D12CommandBuffer*> executedBundles_;
 
         D3D12_CPU_DESCRIPTOR_HANDLE     rtvDescHandle_          = {};
         UINT                            rtvDescSize_            = 0;
@@ -286,10 +390,30 @@ class D3D12CommandBuffer final : public CommandBuffer
         UINT                            dsvDescSize_            = 0;
 
         bool                            scissorEnabled_         = false;
+        bool                            skipDraws_              = false;
+        bool                            skipDispatches_         = false;
         UINT                            numBoundScissorRects_   = 0;
         UINT                            numColorBuffers_        = 0;
 
+        /* Variable rate shading; shading-rate images (tier 2) are combined with the dynamic shading rate */
+        D3D12_SHADING_RATE              shadingRate_            = D3D12_SHADING_RATE_1X1;
+        bool                            hasShadingRateImages_   = false;
+        bool                            isShadingRateImageBound_ = false;
+
         RenderTarget*                   boundRenderTarget_      = nullptr;
+        const D3D12RenderPass*          renderPass_             = nullptr; // Only set for render passes with explicit sub-passes
+        std::uint32_t                   subpass_                = 0;
+
+        /* Pipeline layout of the last bound PSO for dynamic bindings and inline uniforms */
+        const D3D12PipelineLayout*      boundPipelineLayout_    = nullptr;
+        bool                            isGraphicsPSOBound_     = true;
+
+        /* Patch blocks per command allocator; they can be reused once the command context has cycled back to the same allocator */
+        ID3D12Device*                               device_             = nullptr;
+        std::vector<std::vector<D3D12PatchBlock>>   patchBlockLists_;
+        std::size_t                                 numPatchBlocks_     = 0;    // Number of patch blocks used by the current recording
+        UINT64                                      patchBlockOffset_   = 0;    // Offset within the last used patch block
+        std::vector<D3D12PatchSlot>                 patchSlots_;
 
 };
 
@@ -7,11 +7,15 @@
 
 #include "D3D12CommandContext.h"
 #include "D3D12CommandQueue.h"
+#include "D3D12DescriptorHeapPool.h"
 #include "../D3D12Device.h"
 #include "../D3D12Resource.h"
 #include "../RenderState/D3D12Fence.h"
 #include "../../DXCommon/DXCore.h"
+#include "../../../Core/ProfilerZone.h"
+#include <LLGL/Misc/ForRange.h>
 #include <algorithm>
+#include <stdexcept>
 
 
 namespace LLGL
@@ -34,6 +38,12 @@ D3D12CommandContext::D3D12CommandContext(
     Create(device, commandQueue);
 }
 
+D3D12CommandContext::~D3D12CommandContext()
+{
+    for_range(i, numAllocators_)
+        FreeDescriptorPages(i);
+}
+
 void D3D12CommandContext::Create(
     D3D12Device&            device,
     D3D12CommandQueue&      commandQueue,
@@ -41,8 +51,9 @@ void D3D12CommandContext::Create(
     UINT                    numAllocators,
     bool                    initialClose)
 {
-    /* Store reference to command queue */
-    commandQueue_ = &commandQueue;
+    /* Store reference to device and command queue */
+    device_         = device.GetNative();
+    commandQueue_   = &commandQueue;
 
     /* Create fence for command allocators */
     allocatorFence_.Create(device.GetNative());
@@ -66,7 +77,8 @@ void D3D12CommandContext::Create(
 
 void D3D12CommandContext::Close()
 {
-    /* Flush pending resource barriers */
+    /* Complete split transitions since they must not span multiple command lists, then flush pending resource barriers */
+    EndSplitTransitions();
     FlushResourceBarrieres();
 
     /* Close native command list */
@@ -81,9 +93,19 @@ void D3D12CommandContext::Execute()
     commandQueue_->GetNative()->ExecuteCommandLists(1, cmdLists);
 
     /* Signal current allocator fence value */
+    SignalAllocatorFence();
+}
+
+void D3D12CommandContext::SignalAllocatorFence()
+{
     commandQueue_->SignalFence(allocatorFence_, allocatorFenceValues_[currentAllocatorIndex_]);
 }
 
+UINT64 D3D12CommandContext::GetCompletedFenceValue() const
+{
+    return allocatorFence_.GetNative()->GetCompletedValue();
+}
+
 void D3D12CommandContext::Reset()
 {
     /* Switch to next command allocator */
@@ -112,18 +134,14 @@ void D3D12CommandContext::Finish(bool waitIdle)
 
 void D3D12CommandContext::TransitionResource(D3D12Resource& resource, D3D12_RESOURCE_STATES newState, bool flushImmediate)
 {
+    /* Complete split transition of this resource first */
+    EndSplitTransition(resource);
+
     auto oldState = resource.transitionState;
     if (oldState != newState)
     {
-        auto& barrier = NextResourceBarrier();
-
-        /* Initialize resource barrier for resource transition */
-        barrier.Type                    = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        barrier.Flags                   = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-        barrier.Transition.pResource    = resource.native.Get();
-        barrier.Transition.Subresource  = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        barrier.Transition.StateBefore  = oldState;
-        barrier.Transition.StateAfter   = newState;
+        /* Queue or merge transition barrier for all subresources */
+        QueueTransitionBarrier(resource.native.Get(), D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, oldState, newState);
 
         /* Store new state in resource */
         resource.transitionState = newState;
@@ -134,7 +152,6 @@ void D3D12CommandContext::TransitionResource(D3D12Resource& resource, D3D12_RESO
         FlushResourceBarrieres();
 }
 
-#if 0 //TODO: not used yey
 void D3D12CommandContext::TransitionSubresource(
     D3D12Resource&          resource,
     UINT                    subresource,
@@ -142,21 +159,55 @@ void D3D12CommandContext::TransitionSubresource(
     D3D12_RESOURCE_STATES   newState,
     bool                    flushImmediate)
 {
-    auto& barrier = NextResourceBarrier();
+    if (oldState != newState)
+        QueueTransitionBarrier(resource.native.Get(), subresource, oldState, newState);
 
-    /* Initialize resource barrier for resource transition */
-    barrier.Type                    = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barrier.Flags                   = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-    barrier.Transition.pResource    = resource.native.Get();
-    barrier.Transition.Subresource  = subresource;
-    barrier.Transition.StateBefore  = oldState;
-    barrier.Transition.StateAfter   = newState;
+    /* Flush resource barrieres if required */
+    if (flushImmediate)
+        FlushResourceBarrieres();
+}
+
+void D3D12CommandContext::BeginTransitionResource(D3D12Resource& resource, D3D12_RESOURCE_STATES newState)
+{
+    /* Complete previous split transition of this resource first */
+    EndSplitTransition(resource);
+
+    auto oldState = resource.transitionState;
+    if (oldState != newState)
+    {
+        /* Queue begin-only transition barrier; it must not be merged with regular transition barriers */
+        QueueTransitionBarrier(
+            resource.native.Get(),
+            D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES,
+            oldState,
+            newState,
+            D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY
+        );
+
+        /* Store new state in resource to keep track of the transition, which is completed with EndSplitTransition */
+        splitTransitions_.push_back({ &resource, oldState, newState });
+        resource.transitionState = newState;
+    }
+}
+
+void D3D12CommandContext::EndSplitTransitions(bool flushImmediate)
+{
+    for (const auto& split : splitTransitions_)
+    {
+        QueueTransitionBarrier(
+            split.resource->native.Get(),
+            D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES,
+            split.stateBefore,
+            split.stateAfter,
+            D3D12_RESOURCE_BARRIER_FLAG_END_ONLY
+        );
+    }
+    splitTransitions_.clear();
 
     /* Flush resource barrieres if required */
     if (flushImmediate)
         FlushResourceBarrieres();
 }
-#endif
 
 void D3D12CommandContext::InsertUAVBarrier(D3D12Resource& resource, bool flushImmediate)
 {
@@ -174,6 +225,7 @@ void D3D12CommandContext::FlushResourceBarrieres()
 {
     if (numResourceBarriers_ > 0)
     {
+        LLGL_PROFILER_ZONE("D3D12CommandContext::FlushResourceBarrieres");
         commandList_->ResourceBarrier(numResourceBarriers_, resourceBarriers_);
         numResourceBarriers_ = 0;
     }
@@ -270,6 +322,41 @@ void D3D12CommandContext::SetDescriptorHeaps(UINT numDescriptorHeaps, ID3D12Desc
     }
 }
 
+D3D12_GPU_DESCRIPTOR_HANDLE D3D12CommandContext::CopyDescriptorsShaderVisible(
+    UINT                        heapIndex,
+    D3D12_CPU_DESCRIPTOR_HANDLE srcDescHandle,
+    UINT                        numDescriptors)
+{
+    auto& pool = D3D12DescriptorHeapPool::Get();
+    auto& ring = descriptorRings_[heapIndex];
+
+    /* Allocate new page if the current one has not enough space left */
+    if (ring.currentDescriptor + numDescriptors > ring.endDescriptor)
+    {
+        const auto pageSize = pool.GetPageSize(heapIndex);
+        if (numDescriptors > pageSize)
+            throw std::invalid_argument("descriptor set exceeds page size of shader-visible D3D12 descriptor heap");
+
+        const auto page = pool.AllocPage(heapIndex);
+        ring.usedPages[currentAllocatorIndex_].push_back(page);
+        ring.currentDescriptor  = page;
+        ring.endDescriptor      = page + pageSize;
+    }
+
+    /* Copy descriptors into shader-visible heap */
+    const auto firstDescriptor = ring.currentDescriptor;
+    ring.currentDescriptor += numDescriptors;
+
+    device_->CopyDescriptorsSimple(
+        numDescriptors,
+        pool.GetCPUDescriptorHandle(heapIndex, firstDescriptor),
+        srcDescHandle,
+        (heapIndex == D3D12DescriptorHeapPool::g_heapSamplers ? D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER : D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV)
+    );
+
+    return pool.GetGPUDescriptorHandle(heapIndex, firstDescriptor);
+}
+
 void D3D12CommandContext::SetGraphicsConstant(UINT parameterIndex, D3D12Constant value, UINT offset)
 {
     commandList_->SetGraphicsRoot32BitConstant(parameterIndex, value.u32, offset);
@@ -292,6 +379,87 @@ D3D12_RESOURCE_BARRIER& D3D12CommandContext::NextResourceBarrier()
     return resourceBarriers_[numResourceBarriers_++];
 }
 
+void D3D12CommandContext::QueueTransitionBarrier(
+    ID3D12Resource*                 resource,
+    UINT                            subresource,
+    D3D12_RESOURCE_STATES           oldState,
+    D3D12_RESOURCE_STATES           newState,
+    D3D12_RESOURCE_BARRIER_FLAGS    flags)
+{
+    /* Try to merge regular transitions with a pending barrier for the same subresource first */
+    if (flags == D3D12_RESOURCE_BARRIER_FLAG_NONE && MergeTransitionBarrier(resource, subresource, newState))
+        return;
+
+    auto& barrier = NextResourceBarrier();
+
+    /* Initialize resource barrier for resource transition */
+    barrier.Type                    = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    barrier.Flags                   = flags;
+    barrier.Transition.pResource    = resource;
+    barrier.Transition.Subresource  = subresource;
+    barrier.Transition.StateBefore  = oldState;
+    barrier.Transition.StateAfter   = newState;
+}
+
+bool D3D12CommandContext::MergeTransitionBarrier(ID3D12Resource* resource, UINT subresource, D3D12_RESOURCE_STATES newState)
+{
+    /* Find the latest pending barrier that refers to the same resource */
+    for (auto i = numResourceBarriers_; i > 0; --i)
+    {
+        auto& barrier = resourceBarriers_[i - 1];
+        if (barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION)
+        {
+            if (barrier.Transition.pResource != resource)
+                continue;
+
+            /* Only merge regular transitions of the same subresource */
+            if (barrier.Flags != D3D12_RESOURCE_BARRIER_FLAG_NONE || barrier.Transition.Subresource != subresource)
+                return false;
+
+            if (barrier.Transition.StateBefore == newState)
+            {
+                /* Drop redundant transition (A->B->A) and keep the order of the remaining barriers */
+                std::move(&resourceBarriers_[i], &resourceBarriers_[numResourceBarriers_], &resourceBarriers_[i - 1]);
+                --numResourceBarriers_;
+            }
+            else
+            {
+                /* Collapse transitions (A->B->C into A->C) */
+                barrier.Transition.StateAfter = newState;
+            }
+            return true;
+        }
+        else if (barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_UAV)
+        {
+            /* Don't merge transitions across UAV barriers of the same resource */
+            if (barrier.UAV.pResource == resource || barrier.UAV.pResource == nullptr)
+                return false;
+        }
+        else
+            return false;
+    }
+    return false;
+}
+
+void D3D12CommandContext::EndSplitTransition(D3D12Resource& resource)
+{
+    for (auto it = splitTransitions_.begin(); it != splitTransitions_.end(); ++it)
+    {
+        if (it->resource == &resource)
+        {
+            QueueTransitionBarrier(
+                resource.native.Get(),
+                D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES,
+                it->stateBefore,
+                it->stateAfter,
+                D3D12_RESOURCE_BARRIER_FLAG_END_ONLY
+            );
+            splitTransitions_.erase(it);
+            return;
+        }
+    }
+}
+
 void D3D12CommandContext::NextCommandAllocator()
 {
     /* Get next command allocator */
@@ -303,6 +471,21 @@ void D3D12CommandContext::NextCommandAllocator()
     /* Reclaim memory allocated by command allocator using <ID3D12CommandAllocator::Reset> */
     auto hr = GetCommandAllocator()->Reset();
     DXThrowIfFailed(hr, "failed to reset D3D12 command allocator");
+
+    /* Reclaim descriptor pages of next allocator; the current pages are still referenced by the previous command list */
+    FreeDescriptorPages(currentAllocatorIndex_);
+    for (auto& ring : descriptorRings_)
+        ring.currentDescriptor = ring.endDescriptor = 0;
+}
+
+void D3D12CommandContext::FreeDescriptorPages(UINT allocatorIndex)
+{
+    for_range(i, g_maxNumDescriptorHeaps)
+    {
+        auto& usedPages = descriptorRings_[i].usedPages[allocatorIndex];
+        D3D12DescriptorHeapPool::Get().FreePages(i, usedPages.data(), usedPages.size());
+        usedPages.clear();
+    }
 }
 
 void D3D12CommandContext::ClearCache()
@@ -14,6 +14,7 @@
 #include <d3d12.h>
 #include <cstddef>
 #include <cstdint>
+#include <vector>
 
 
 namespace LLGL
@@ -51,6 +52,9 @@ class D3D12CommandContext
             D3D12CommandQueue&  commandQueue
         );
 
+        // Returns all descriptor pages of this context back to the D3D12DescriptorHeapPool.
+        ~D3D12CommandContext();
+
         // Creats the command list and internal command allocators.
         void Create(
             D3D12Device&            device,
@@ -64,20 +68,47 @@ class D3D12CommandContext
         void Execute();
         void Reset();
 
+        // Signals the fence of the current command allocator. Must be called after the command list has been submitted to the queue.
+        void SignalAllocatorFence();
+
         // Calls Close, Execute, and Reset with the internal command queue and allocator.
         void Finish(bool waitIdle = false);
 
+        // Returns the allocator fence value that will be signaled once the command list of the current allocator has been completed.
+        inline UINT64 GetCurrentFenceValue() const
+        {
+            return allocatorFenceValues_[currentAllocatorIndex_];
+        }
+
+        // Returns the last allocator fence value that has been completed by the GPU.
+        UINT64 GetCompletedFenceValue() const;
+
+        // Returns the native fence object that is signaled with the allocator fence values.
+        inline ID3D12Fence* GetAllocatorFence() const
+        {
+            return allocatorFence_.GetNative();
+        }
+
+        // Returns the index of the current command allocator. Resources that are bound to this index can be reused once the context has cycled back to it.
+        inline UINT GetCurrentAllocatorIndex() const
+        {
+            return currentAllocatorIndex_;
+        }
+
         // Returns the command list of this context.
         inline ID3D12GraphicsCommandList* GetCommandList() const
         {
             return commandList_.Get();
         }
 
-        // Transition all subresources to the specified new state.
+        /*
+        Transition all subresources to the specified new state.
+        Pending transitions of the same resource are merged, i.e. A->B followed by B->C becomes A->C and A->B followed by B->A is dropped.
+        If a split transition has been started for this resource with BeginTransitionResource, it is completed first.
+        */
         void TransitionResource(D3D12Resource& resource, D3D12_RESOURCE_STATES newState, bool flushImmediate = false);
 
-        #if 0 //TODO: not used yet
-        // Transition the specified subresource to the specified new state.
+        // Transition the specified subresource to the specified new state. Pending transitions of the same subresource are merged.
         void TransitionSubresource(
             D3D12Resource&          resource,
             UINT                    subresource,
@@ -85,7 +116,16 @@ class D3D12CommandContext
             D3D12_RESOURCE_STATES   newState,
             bool                    flushImmediate = false
         );
-        #endif
+
+        /*
+        Begins a split transition of all subresources to the specified new state (D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY).
+        The transition is completed with the next call to TransitionResource for this resource, or with EndSplitTransitions at the latest.
+        This allows the GPU to perform the transition while other commands are executed, e.g. right after a render pass has ended.
+        */
+        void BeginTransitionResource(D3D12Resource& resource, D3D12_RESOURCE_STATES newState);
+
+        // Completes all split transitions that have been started with BeginTransitionResource (D3D12_RESOURCE_BARRIER_FLAG_END_ONLY).
+        void EndSplitTransitions(bool flushImmediate = false);
 
         // Insert a resource barrier for an unordered access view (UAV).
         void InsertUAVBarrier(D3D12Resource& resource, bool flushImmediate = false);
@@ -106,9 +146,19 @@ class D3D12CommandContext
         void SetPipelineState(ID3D12PipelineState* pipelineState);
         void SetDescriptorHeaps(UINT numDescriptorHeaps, ID3D12DescriptorHeap* const* descriptorHeaps);
 
+        /*
+        Copies the specified CPU descriptors into the shader-visible descriptor heap of the D3D12DescriptorHeapPool and returns the GPU descriptor handle of the copy.
+        The copy remains valid until the command list of the current command allocator has been completed by the GPU.
+        The heap index must be either D3D12DescriptorHeapPool::g_heapResourceViews or D3D12DescriptorHeapPool::g_heapSamplers.
+        */
+        D3D12_GPU_DESCRIPTOR_HANDLE CopyDescriptorsShaderVisible(UINT heapIndex, D3D12_CPU_DESCRIPTOR_HANDLE srcDescHandle, UINT numDescriptors);
+
         void SetGraphicsConstant(UINT parameterIndex, D3D12Constant value, UINT offset);
         void SetComputeConstant(UINT parameterIndex, D3D12Constant value, UINT offset);
 
+        // Clears the internal cached states.
+        void ClearCache();
+
     private:
 
         static const UINT g_maxNumAllocators        = 3;
@@ -139,17 +189,48 @@ class D3D12CommandContext
             ID3D12DescriptorHeap*   descriptorHeaps[g_maxNumDescriptorHeaps]    = {};
         };
 
-    private:
+        // Ring of descriptor pages allocated from the D3D12DescriptorHeapPool.
+        struct DescriptorRing
+        {
+            UINT                currentDescriptor                   = 0;
+            UINT                endDescriptor                       = 0;
+            std::vector<UINT>   usedPages[g_maxNumAllocators];
+        };
 
-        // Clears the internal cached states.
-        void ClearCache();
+        // Split transition that has been started with BeginTransitionResource but not completed yet.
+        struct SplitTransition
+        {
+            D3D12Resource*          resource;
+            D3D12_RESOURCE_STATES   stateBefore;
+            D3D12_RESOURCE_STATES   stateAfter;
+        };
+
+    private:
 
         // Returns the next resource barrier and flushes previous barriers if the cache is full.
         D3D12_RESOURCE_BARRIER& NextResourceBarrier();
 
+        // Queues a transition barrier for the specified subresource or merges it with a pending transition barrier of the same subresource.
+        void QueueTransitionBarrier(
+            ID3D12Resource*                 resource,
+            UINT                            subresource,
+            D3D12_RESOURCE_STATES           oldState,
+            D3D12_RESOURCE_STATES           newState,
+            D3D12_RESOURCE_BARRIER_FLAGS    flags       = D3D12_RESOURCE_BARRIER_FLAG_NONE
+        );
+
+        // Tries to merge the specified transition into a pending transition barrier. Returns false if there is no such barrier.
+        bool MergeTransitionBarrier(ID3D12Resource* resource, UINT subresource, D3D12_RESOURCE_STATES newState);
+
+        // Completes the split transition of the specified resource if there is one.
+        void EndSplitTransition(D3D12Resource& resource);
+
         // Switches to the next command allocator and resets it.
         void NextCommandAllocator();
 
+        // Returns the descriptor pages that were used with the specified command allocator back to the pool.
+        void FreeDescriptorPages(UINT allocatorIndex);
+
         // Returns the current command allocator.
         inline ID3D12CommandAllocator* GetCommandAllocator() const
         {
@@ -158,6 +239,7 @@ class D3D12CommandContext
 
     private:
 
+        ID3D12Device*                       device_                                         = nullptr;
         D3D12CommandQueue*                  commandQueue_                                   = nullptr;
 
         ComPtr<ID3D12CommandAllocator>      commandAllocators_[g_maxNumAllocators];
@@ -171,9 +253,12 @@ class D3D12CommandContext
 
         D3D12_RESOURCE_BARRIER              resourceBarriers_[g_maxNumResourceBarrieres];
         UINT                                numResourceBarriers_                            = 0;
+        std::vector<SplitTransition>        splitTransitions_;
 
         StateCache                          stateCache_;
 
+        DescriptorRing                      descriptorRings_[g_maxNumDescriptorHeaps];
+
 };
 
 
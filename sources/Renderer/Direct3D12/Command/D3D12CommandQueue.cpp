@@ -12,7 +12,9 @@
 #include "../RenderState/D3D12Fence.h"
 #include "../RenderState/D3D12QueryHeap.h"
 #include "../../CheckedCast.h"
+#include "../../QueryUtils.h"
 #include "../../DXCommon/DXCore.h"
+#include <LLGL/Container/SmallVector.h>
 
 
 namespace LLGL
@@ -26,8 +28,11 @@ D3D12CommandQueue::D3D12CommandQueue(
     native_      { device.CreateDXCommandQueue(type) },
     globalFence_ { device.GetNative()                }
 {
-    commandContext_.Create(device, *this);
-    DetermineTimestampFrequency();
+    commandContext_.Create(device, *this, type);
+
+    /* Timestamp queries are not guaranteed to be supported on copy queues */
+    if (type != D3D12_COMMAND_LIST_TYPE_COPY)
+        DetermineTimestampFrequency();
 }
 
 void D3D12CommandQueue::SetName(const char* name)
@@ -39,12 +44,42 @@ void D3D12CommandQueue::SetName(const char* name)
 
 void D3D12CommandQueue::Submit(CommandBuffer& commandBuffer)
 {
-    /* Execute command list */
+    /* Execute command list; bundles can only be executed by other command buffers */
     auto& commandBufferD3D = LLGL_CAST(D3D12CommandBuffer&, commandBuffer);
-    if (!commandBufferD3D.IsImmediateCmdBuffer())
+    if (!commandBufferD3D.IsImmediateCmdBuffer() && !commandBufferD3D.IsBundle())
         commandBufferD3D.Execute();
 }
 
+void D3D12CommandQueue::Submit(std::uint32_t numCommandBuffers, CommandBuffer* const * commandBuffers)
+{
+    /* Gather native command lists of all deferred command buffers */
+    SmallVector<D3D12CommandBuffer*, 16> commandBuffersD3D;
+    SmallVector<ID3D12CommandList*, 16> commandLists;
+
+    for (std::uint32_t i = 0; i < numCommandBuffers; ++i)
+    {
+        auto commandBufferD3D = LLGL_CAST(D3D12CommandBuffer*, commandBuffers[i]);
+        if (!commandBufferD3D->IsImmediateCmdBuffer() && !commandBufferD3D->IsBundle())
+        {
+            commandBuffersD3D.push_back(commandBufferD3D);
+            commandLists.push_back(commandBufferD3D->GetNative());
+        }
+    }
+
+    if (commandLists.empty())
+        return;
+
+    /* Execute all command lists at once */
+    native_->ExecuteCommandLists(static_cast<UINT>(commandLists.size()), commandLists.data());
+
+    /*
+    Signal allocator fences after the entire batch has been scheduled.
+    Each command context owns its allocator fence, but all signals are placed behind the single execution.
+    */
+    for (auto commandBufferD3D : commandBuffersD3D)
+        commandBufferD3D->SignalAllocatorFences();
+}
+
 /* ----- Queries ----- */
 
 bool D3D12CommandQueue::QueryResult(
@@ -68,30 +103,74 @@ bool D3D12CommandQueue::QueryResult(
     if (mappedData == nullptr)
         return false;
 
-    const auto queryType = queryHeapD3D.GetNativeType();
-    bool result = false;
+    const auto result = QueryResultEntries(
+        queryHeapD3D.GetNativeType(),
+        mappedData,
+        firstQuery,
+        numQueries,
+        data,
+        GetQueryResultStride(dataSize, numQueries)
+    );
 
-    if (dataSize == numQueries * sizeof(std::uint32_t))
-    {
-        /* Query 64-bit values and convert them to 32-bit values */
-        QueryResultUInt32(queryType, mappedData, firstQuery, numQueries, reinterpret_cast<std::uint32_t*>(data));
-        result = true;
-    }
-    else if (dataSize == numQueries * sizeof(std::uint64_t))
-    {
-        /* Query 64-bit values and copy them directly to output */
-        QueryResultUInt64(queryType, mappedData, firstQuery, numQueries, reinterpret_cast<std::uint64_t*>(data));
-        result = true;
-    }
-    else if (dataSize == numQueries * sizeof(QueryPipelineStatistics))
+    queryHeapD3D.Unmap();
+
+    return result;
+}
+
+std::uint32_t D3D12CommandQueue::TryGetQueryResults(
+    QueryHeap&      queryHeap,
+    void*           data,
+    std::size_t     dataSize,
+    QueryRange*     outRanges,
+    std::uint32_t   maxRanges)
+{
+    auto& queryHeapD3D = LLGL_CAST(D3D12QueryHeap&, queryHeap);
+
+    const auto stride = GetQueryResultStride(dataSize, queryHeapD3D.GetNumQueries());
+    if (stride == 0)
+        return 0;
+
+    std::uint32_t numRanges = 0;
+
+    /* Read back all completed slots in the order they have been resolved; the heap is never flushed here, so this function does not block */
+    while (auto ranges = queryHeapD3D.GetCompletedReadbackRanges())
     {
-        /* Query pipeline statistics and copy them directly to output (if structs are compatible) */
-        result = QueryResultPipelineStatistics(queryType, mappedData, firstQuery, numQueries, reinterpret_cast<QueryPipelineStatistics*>(data));
+        if (numRanges + ranges->size() > maxRanges)
+            break;
+
+        auto mappedData = queryHeapD3D.MapCompletedReadback();
+
+        for (const auto& range : *ranges)
+        {
+            QueryResultEntries(
+                queryHeapD3D.GetNativeType(),
+                mappedData,
+                range.firstQuery,
+                range.numQueries,
+                reinterpret_cast<char*>(data) + range.firstQuery * stride,
+                stride
+            );
+            outRanges[numRanges++] = range;
+        }
+
+        queryHeapD3D.ReleaseCompletedReadback();
     }
 
-    queryHeapD3D.Unmap();
+    return numRanges;
+}
 
-    return result;
+bool D3D12CommandQueue::QueryCalibratedTimestamps(CalibratedTimestamps& outTimestamps)
+{
+    /* Sample both timestamps atomically; the CPU timestamp is the QueryPerformanceCounter value, which is the domain of Timer::Tick */
+    UINT64 gpuTimestamp = 0, cpuTimestamp = 0;
+    if (FAILED(native_->GetClockCalibration(&gpuTimestamp, &cpuTimestamp)))
+        return false;
+
+    outTimestamps.cpuTimestamp  = cpuTimestamp;
+    outTimestamps.gpuTimestamp  = gpuTimestamp;
+    outTimestamps.gpuFrequency  = timestampFrequency_;
+    outTimestamps.maxDeviation  = 0;
+    return true;
 }
 
 /* ----- Fences ----- */
@@ -100,18 +179,27 @@ void D3D12CommandQueue::Submit(Fence& fence)
 {
     /* Schedule signal command into the queue */
     auto& fenceD3D = LLGL_CAST(D3D12Fence&, fence);
-    SignalFence(fenceD3D, fenceD3D.GetNextValue());
+    SignalFence(fenceD3D, fenceD3D.SubmitNextValue());
 }
 
 bool D3D12CommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
 {
     auto& fenceD3D = LLGL_CAST(D3D12Fence&, fence);
-    return fenceD3D.Wait(timeout);
+    return fenceD3D.WaitForSubmittedValue(timeout);
+}
+
+void D3D12CommandQueue::SubmitWait(Fence& fence, std::uint64_t value)
+{
+    /* Schedule GPU-side wait command into the queue */
+    auto& fenceD3D = LLGL_CAST(D3D12Fence&, fence);
+    auto hr = native_->Wait(fenceD3D.GetNative(), value);
+    DXThrowIfFailed(hr, "failed to wait for D3D12 fence with command queue");
 }
 
 void D3D12CommandQueue::WaitIdle()
 {
     /* Submit intermediate fence and wait for it to be signaled */
+    std::lock_guard<std::mutex> guard{ globalFenceMutex_ };
     SignalFence(globalFence_, globalFence_.GetNextValue());
     globalFence_.Wait(~0ull);
 }
@@ -135,6 +223,7 @@ void D3D12CommandQueue::DetermineTimestampFrequency()
     UINT64 timestampFrequency = 0;
     auto hr = native_->GetTimestampFrequency(&timestampFrequency);
     DXThrowIfInvocationFailed(hr, "ID3D12CommandQueue::GetTimestampFrequency");
+    timestampFrequency_ = timestampFrequency;
 
     /* Determine if a conversion from timestamps to nanoseconds is necessary */
     static const UINT64 nanosecondFrequency = 1000000000;
@@ -145,6 +234,35 @@ void D3D12CommandQueue::DetermineTimestampFrequency()
     }
 }
 
+bool D3D12CommandQueue::QueryResultEntries(
+    D3D12_QUERY_TYPE    queryType,
+    const void*         mappedData,
+    std::uint32_t       firstQuery,
+    std::uint32_t       numQueries,
+    void*               data,
+    std::size_t         stride)
+{
+    switch (stride)
+    {
+        case sizeof(std::uint32_t):
+            /* Query 64-bit values and convert them to 32-bit values */
+            QueryResultUInt32(queryType, mappedData, firstQuery, numQueries, reinterpret_cast<std::uint32_t*>(data));
+            return true;
+
+        case sizeof(std::uint64_t):
+            /* Query 64-bit values and copy them directly to output */
+            QueryResultUInt64(queryType, mappedData, firstQuery, numQueries, reinterpret_cast<std::uint64_t*>(data));
+            return true;
+
+        case sizeof(QueryPipelineStatistics):
+            /* Query pipeline statistics and copy them directly to output (if structs are compatible) */
+            return QueryResultPipelineStatistics(queryType, mappedData, firstQuery, numQueries, reinterpret_cast<QueryPipelineStatistics*>(data));
+
+        default:
+            return false;
+    }
+}
+
 void D3D12CommandQueue::QueryResultSingleUInt64(
     D3D12_QUERY_TYPE    queryType,
     const void*         mappedData,
@@ -16,6 +16,7 @@
 #include "../../DXCommon/ComPtr.h"
 #include <d3d12.h>
 #include <cstddef>
+#include <mutex>
 
 
 namespace LLGL
@@ -39,6 +40,7 @@ class D3D12CommandQueue final : public CommandQueue
         /* ----- Command Buffers ----- */
 
         void Submit(CommandBuffer& commandBuffer) override;
+        void Submit(std::uint32_t numCommandBuffers, CommandBuffer* const * commandBuffers) override;
 
         /* ----- Queries ----- */
 
@@ -50,11 +52,22 @@ class D3D12CommandQueue final : public CommandQueue
             std::size_t     dataSize
         ) override;
 
+        std::uint32_t TryGetQueryResults(
+            QueryHeap&      queryHeap,
+            void*           data,
+            std::size_t     dataSize,
+            QueryRange*     outRanges,
+            std::uint32_t   maxRanges
+        ) override;
+
+        bool QueryCalibratedTimestamps(CalibratedTimestamps& outTimestamps) override;
+
         /* ----- Fences ----- */
 
         void Submit(Fence& fence) override;
 
         bool WaitFence(Fence& fence, std::uint64_t timeout) override;
+        void SubmitWait(Fence& fence, std::uint64_t value) override;
         void WaitIdle() override;
 
     public:
@@ -90,6 +103,16 @@ class D3D12CommandQueue final : public CommandQueue
 
         void DetermineTimestampFrequency();
 
+        // Copies the specified query results from the mapped data into the output array with the specified entry size.
+        bool QueryResultEntries(
+            D3D12_QUERY_TYPE    queryType,
+            const void*         mappedData,
+            std::uint32_t       firstQuery,
+            std::uint32_t       numQueries,
+            void*               data,
+            std::size_t         stride
+        );
+
         void QueryResultSingleUInt64(
             D3D12_QUERY_TYPE    queryType,
             const void*         mappedData,
@@ -126,6 +149,8 @@ class D3D12CommandQueue final : public CommandQueue
         ComPtr<ID3D12CommandQueue>  native_;
         D3D12CommandContext         commandContext_;
         D3D12Fence                  globalFence_;
+        std::mutex                  globalFenceMutex_;  // Guards the global fence, since WaitIdle can be called from any thread during resource creation.
+        UINT64                      timestampFrequency_     = 0;    // Timestamp frequency of the command queue (in ticks per second)
         double                      timestampScale_         = 1.0;  // Frequency to nanoseconds scale
         bool                        isTimestampNanosecs_    = true; // True, if timestamps are in nanoseconds unit
 
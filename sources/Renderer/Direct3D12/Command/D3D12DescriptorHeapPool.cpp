@@ -0,0 +1,140 @@
+/*
+ * D3D12DescriptorHeapPool.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12DescriptorHeapPool.h"
+#include "../../DXCommon/DXCore.h"
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+const UINT D3D12DescriptorHeapPool::g_heapResourceViews;
+const UINT D3D12DescriptorHeapPool::g_heapSamplers;
+const UINT D3D12DescriptorHeapPool::g_numHeaps;
+
+/*
+Sizes of the shader-visible heaps: 256 pages of 1024 CBV/SRV/UAV descriptors (within the 1,000,000 descriptors of resource binding tier 1),
+and 64 pages of 32 samplers (D3D12_MAX_SHADER_VISIBLE_SAMPLER_HEAP_SIZE is 2048).
+*/
+static const UINT g_numResourceViewPages    = 256;
+static const UINT g_resourceViewPageSize    = 1024;
+static const UINT g_numSamplerPages         = 64;
+static const UINT g_samplerPageSize         = (D3D12_MAX_SHADER_VISIBLE_SAMPLER_HEAP_SIZE / g_numSamplerPages);
+
+D3D12DescriptorHeapPool& D3D12DescriptorHeapPool::Get()
+{
+    static D3D12DescriptorHeapPool instance;
+    return instance;
+}
+
+void D3D12DescriptorHeapPool::InitializeDevice(ID3D12Device* device)
+{
+    CreatePagedHeap(device, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, g_numResourceViewPages, g_resourceViewPageSize, heaps_[g_heapResourceViews]);
+    CreatePagedHeap(device, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER, g_numSamplerPages, g_samplerPageSize, heaps_[g_heapSamplers]);
+}
+
+void D3D12DescriptorHeapPool::Clear()
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    for (UINT i = 0; i < g_numHeaps; ++i)
+    {
+        heaps_[i].native.Reset();
+        heaps_[i].freePages.clear();
+        descriptorHeaps_[i] = nullptr;
+    }
+}
+
+UINT D3D12DescriptorHeapPool::AllocPage(UINT heapIndex)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    auto& heap = heaps_[heapIndex];
+    if (heap.freePages.empty())
+    {
+        throw std::runtime_error(
+            heapIndex == g_heapSamplers
+                ? "out of shader-visible D3D12 descriptors for samplers"
+                : "out of shader-visible D3D12 descriptors for resource views"
+        );
+    }
+
+    auto page = heap.freePages.back();
+    heap.freePages.pop_back();
+    return page;
+}
+
+void D3D12DescriptorHeapPool::FreePages(UINT heapIndex, const UINT* pages, std::size_t numPages)
+{
+    if (numPages > 0)
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        auto& heap = heaps_[heapIndex];
+        heap.freePages.insert(heap.freePages.end(), pages, pages + numPages);
+    }
+}
+
+D3D12_CPU_DESCRIPTOR_HANDLE D3D12DescriptorHeapPool::GetCPUDescriptorHandle(UINT heapIndex, UINT descriptor) const
+{
+    const auto& heap = heaps_[heapIndex];
+    D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle = heap.cpuHandleStart;
+    cpuDescHandle.ptr += static_cast<SIZE_T>(heap.handleSize) * descriptor;
+    return cpuDescHandle;
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE D3D12DescriptorHeapPool::GetGPUDescriptorHandle(UINT heapIndex, UINT descriptor) const
+{
+    const auto& heap = heaps_[heapIndex];
+    D3D12_GPU_DESCRIPTOR_HANDLE gpuDescHandle = heap.gpuHandleStart;
+    gpuDescHandle.ptr += static_cast<UINT64>(heap.handleSize) * descriptor;
+    return gpuDescHandle;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void D3D12DescriptorHeapPool::CreatePagedHeap(
+    ID3D12Device*               device,
+    D3D12_DESCRIPTOR_HEAP_TYPE  heapType,
+    UINT                        numPages,
+    UINT                        pageSize,
+    PagedHeap&                  outHeap)
+{
+    /* Create shader-visible descriptor heap for all pages */
+    D3D12_DESCRIPTOR_HEAP_DESC heapDesc;
+    {
+        heapDesc.Type           = heapType;
+        heapDesc.NumDescriptors = numPages * pageSize;
+        heapDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+        heapDesc.NodeMask       = 0;
+    }
+    auto hr = device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(outHeap.native.ReleaseAndGetAddressOf()));
+    DXThrowIfCreateFailed(hr, "ID3D12DescriptorHeap", "for shader-visible descriptor heap pool");
+
+    outHeap.cpuHandleStart  = outHeap.native->GetCPUDescriptorHandleForHeapStart();
+    outHeap.gpuHandleStart  = outHeap.native->GetGPUDescriptorHandleForHeapStart();
+    outHeap.handleSize      = device->GetDescriptorHandleIncrementSize(heapType);
+    outHeap.pageSize        = pageSize;
+
+    /* Initialize list of free pages in reverse order, so pages are allocated from the start of the heap first */
+    outHeap.freePages.resize(numPages);
+    for (UINT i = 0; i < numPages; ++i)
+        outHeap.freePages[i] = (numPages - i - 1) * pageSize;
+
+    /* Store in array for quick access */
+    descriptorHeaps_[heapType == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER ? g_heapSamplers : g_heapResourceViews] = outHeap.native.Get();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,114 @@
+/*
+ * D3D12DescriptorHeapPool.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_DESCRIPTOR_HEAP_POOL_H
+#define LLGL_D3D12_DESCRIPTOR_HEAP_POOL_H
+
+
+#include "../../DXCommon/ComPtr.h"
+#include <d3d12.h>
+#include <vector>
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+/*
+Global shader-visible descriptor heaps (one for CBV/SRV/UAV and one for samplers) that are partitioned into pages.
+Each command context allocates pages from this pool for its descriptor ring, so all command lists and bundles
+bind the same descriptor heaps and SetDescriptorHeaps only needs to be called once per command list.
+Pages can be allocated and released from multiple threads.
+*/
+class D3D12DescriptorHeapPool
+{
+
+    public:
+
+        // Index of the CBV/SRV/UAV and sampler heaps; this is also the order within the array of GetDescriptorHeaps().
+        static const UINT g_heapResourceViews   = 0;
+        static const UINT g_heapSamplers        = 1;
+        static const UINT g_numHeaps            = 2;
+
+    public:
+
+        // Returns the instance of this pool.
+        static D3D12DescriptorHeapPool& Get();
+
+    public:
+
+        D3D12DescriptorHeapPool(const D3D12DescriptorHeapPool&) = delete;
+        D3D12DescriptorHeapPool& operator = (const D3D12DescriptorHeapPool&) = delete;
+
+        // Creates the shader-visible descriptor heaps.
+        void InitializeDevice(ID3D12Device* device);
+
+        // Releases the descriptor heaps.
+        void Clear();
+
+        // Allocates a free page from the specified heap and returns the index of its first descriptor. Throws if the heap is exhausted.
+        UINT AllocPage(UINT heapIndex);
+
+        // Returns the specified pages back to the pool. The GPU must no longer reference their descriptors.
+        void FreePages(UINT heapIndex, const UINT* pages, std::size_t numPages);
+
+        // Returns the CPU descriptor handle of the specified descriptor within the specified heap.
+        D3D12_CPU_DESCRIPTOR_HANDLE GetCPUDescriptorHandle(UINT heapIndex, UINT descriptor) const;
+
+        // Returns the GPU descriptor handle of the specified descriptor within the specified heap.
+        D3D12_GPU_DESCRIPTOR_HANDLE GetGPUDescriptorHandle(UINT heapIndex, UINT descriptor) const;
+
+        // Returns the number of descriptors per page of the specified heap.
+        inline UINT GetPageSize(UINT heapIndex) const
+        {
+            return heaps_[heapIndex].pageSize;
+        }
+
+        // Returns the array of both shader-visible descriptor heaps.
+        inline ID3D12DescriptorHeap* const* GetDescriptorHeaps() const
+        {
+            return descriptorHeaps_;
+        }
+
+    private:
+
+        D3D12DescriptorHeapPool() = default;
+
+    private:
+
+        struct PagedHeap
+        {
+            ComPtr<ID3D12DescriptorHeap>    native;
+            D3D12_CPU_DESCRIPTOR_HANDLE     cpuHandleStart  = {};
+            D3D12_GPU_DESCRIPTOR_HANDLE     gpuHandleStart  = {};
+            UINT                            handleSize      = 0;
+            UINT                            pageSize        = 0;
+            std::vector<UINT>               freePages;          // Indices of the first descriptor of each free page
+        };
+
+    private:
+
+        void CreatePagedHeap(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE heapType, UINT numPages, UINT pageSize, PagedHeap& outHeap);
+
+    private:
+
+        PagedHeap               heaps_[g_numHeaps];
+        ID3D12DescriptorHeap*   descriptorHeaps_[g_numHeaps]    = {};   // References to the ComPtr objects
+        std::mutex              mutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
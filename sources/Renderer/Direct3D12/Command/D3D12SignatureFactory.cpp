@@ -33,11 +33,53 @@ static void DXCreateCommandSignature(ID3D12Device* device, ComPtr<ID3D12CommandS
 
 void D3D12SignatureFactory::CreateDefaultSignatures(ID3D12Device* device)
 {
+    device_ = device;
     DXCreateCommandSignature(device, signatureDrawIndirect_,        D3D12_INDIRECT_ARGUMENT_TYPE_DRAW,         sizeof(D3D12_DRAW_ARGUMENTS        ));
     DXCreateCommandSignature(device, signatureDrawIndexedIndirect_, D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED, sizeof(D3D12_DRAW_INDEXED_ARGUMENTS));
     DXCreateCommandSignature(device, signatureDispatchIndirect_,    D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH,     sizeof(D3D12_DISPATCH_ARGUMENTS    ));
 }
 
+ID3D12CommandSignature* D3D12SignatureFactory::GetSignatureDrawIndirect(UINT stride) const
+{
+    if (stride == sizeof(D3D12_DRAW_ARGUMENTS))
+        return GetSignatureDrawIndirect();
+    else
+        return GetOrCreateSignature(D3D12_INDIRECT_ARGUMENT_TYPE_DRAW, stride);
+}
+
+ID3D12CommandSignature* D3D12SignatureFactory::GetSignatureDrawIndexedIndirect(UINT stride) const
+{
+    if (stride == sizeof(D3D12_DRAW_INDEXED_ARGUMENTS))
+        return GetSignatureDrawIndexedIndirect();
+    else
+        return GetOrCreateSignature(D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED, stride);
+}
+
+ID3D12CommandSignature* D3D12SignatureFactory::GetSignatureDispatchMeshIndirect(UINT stride) const
+{
+    return GetOrCreateSignature(D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH_MESH, stride);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+ID3D12CommandSignature* D3D12SignatureFactory::GetOrCreateSignature(D3D12_INDIRECT_ARGUMENT_TYPE argumentType, UINT stride) const
+{
+    std::lock_guard<std::mutex> guard{ customSignaturesMutex_ };
+
+    /* Find signature by argument type and stride */
+    const UINT64 key = ((static_cast<UINT64>(argumentType) << 32) | stride);
+    auto& signature = customSignatures_[key];
+
+    /* Create new signature on first use */
+    if (!signature)
+        DXCreateCommandSignature(device_, signature, argumentType, stride);
+
+    return signature.Get();
+}
+
 
 } // /namespace LLGL
 
@@ -11,6 +11,8 @@
 
 #include "../../DXCommon/ComPtr.h"
 #include <d3d12.h>
+#include <map>
+#include <mutex>
 
 
 namespace LLGL
@@ -39,11 +41,31 @@ class D3D12SignatureFactory
             return signatureDispatchIndirect_.Get();
         }
 
+        // Returns the command signature for indirect draw commands with the specified stride between consecutive arguments.
+        ID3D12CommandSignature* GetSignatureDrawIndirect(UINT stride) const;
+
+        // Returns the command signature for indexed indirect draw commands with the specified stride between consecutive arguments.
+        ID3D12CommandSignature* GetSignatureDrawIndexedIndirect(UINT stride) const;
+
+        // Returns the command signature for indirect mesh dispatch commands. This is created on first use, since it's only valid on devices with mesh shader support.
+        ID3D12CommandSignature* GetSignatureDispatchMeshIndirect(UINT stride) const;
+
+    private:
+
+        // Returns the command signature with a non-default stride from the cache or creates a new one.
+        ID3D12CommandSignature* GetOrCreateSignature(D3D12_INDIRECT_ARGUMENT_TYPE argumentType, UINT stride) const;
+
     private:
 
-        ComPtr<ID3D12CommandSignature> signatureDrawIndirect_;
-        ComPtr<ID3D12CommandSignature> signatureDrawIndexedIndirect_;
-        ComPtr<ID3D12CommandSignature> signatureDispatchIndirect_;
+        ID3D12Device*                                               device_                         = nullptr;
+
+        ComPtr<ID3D12CommandSignature>                              signatureDrawIndirect_;
+        ComPtr<ID3D12CommandSignature>                              signatureDrawIndexedIndirect_;
+        ComPtr<ID3D12CommandSignature>                              signatureDispatchIndirect_;
+
+        /* Signatures with non-default strides are shared by all command buffers, which might be recorded on different threads */
+        mutable std::mutex                                          customSignaturesMutex_;
+        mutable std::map<UINT64, ComPtr<ID3D12CommandSignature>>    customSignatures_;
 
 };
 
@@ -92,6 +92,71 @@ ComPtr<ID3D12PipelineState> D3D12Device::CreateDXComputePipelineState(const D3D1
     return pipelineState;
 }
 
+// Pipeline state stream subobject; each subobject in the stream must be aligned to the size of a pointer
+template <D3D12_PIPELINE_STATE_SUBOBJECT_TYPE TType, typename T>
+struct alignas(void*) D3D12PipelineStateSubobject
+{
+    D3D12_PIPELINE_STATE_SUBOBJECT_TYPE type    = TType;
+    T                                   value;
+};
+
+// Pipeline state stream for a graphics pipeline with amplification (task) and mesh shaders.
+struct D3D12MeshPipelineStateStream
+{
+    D3D12PipelineStateSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_ROOT_SIGNATURE,        ID3D12RootSignature*>           rootSignature;
+    D3D12PipelineStateSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_AS,                    D3D12_SHADER_BYTECODE>          AS;
+    D3D12PipelineStateSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_MS,                    D3D12_SHADER_BYTECODE>          MS;
+    D3D12PipelineStateSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PS,                    D3D12_SHADER_BYTECODE>          PS;
+    D3D12PipelineStateSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_BLEND,                 D3D12_BLEND_DESC>               blendState;
+    D3D12PipelineStateSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_MASK,           UINT>                           sampleMask;
+    D3D12PipelineStateSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RASTERIZER,            D3D12_RASTERIZER_DESC>          rasterizerState;
+    D3D12PipelineStateSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL,         D3D12_DEPTH_STENCIL_DESC>       depthStencilState;
+    D3D12PipelineStateSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PRIMITIVE_TOPOLOGY,    D3D12_PRIMITIVE_TOPOLOGY_TYPE>  primitiveTopologyType;
+    D3D12PipelineStateSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RENDER_TARGET_FORMATS, D3D12_RT_FORMAT_ARRAY>          rtvFormats;
+    D3D12PipelineStateSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL_FORMAT,  DXGI_FORMAT>                    dsvFormat;
+    D3D12PipelineStateSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_DESC,           DXGI_SAMPLE_DESC>               sampleDesc;
+};
+
+ComPtr<ID3D12PipelineState> D3D12Device::CreateDXMeshPipelineState(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, const D3D12_SHADER_BYTECODE& AS, const D3D12_SHADER_BYTECODE& MS)
+{
+    /* Mesh shader pipelines can only be created from a pipeline state stream, which requires ID3D12Device2 */
+    ComPtr<ID3D12Device2> device2;
+    auto hr = device_->QueryInterface(IID_PPV_ARGS(device2.ReleaseAndGetAddressOf()));
+    DXThrowIfFailed(hr, "failed to query ID3D12Device2 interface for mesh shader pipeline");
+
+    /* Convert graphics pipeline descriptor into pipeline state stream; input layout and stream-output are not part of mesh shader pipelines */
+    D3D12MeshPipelineStateStream stream;
+    {
+        stream.rootSignature.value          = desc.pRootSignature;
+        stream.AS.value                     = AS;
+        stream.MS.value                     = MS;
+        stream.PS.value                     = desc.PS;
+        stream.blendState.value             = desc.BlendState;
+        stream.sampleMask.value             = desc.SampleMask;
+        stream.rasterizerState.value        = desc.RasterizerState;
+        stream.depthStencilState.value      = desc.DepthStencilState;
+        stream.primitiveTopologyType.value  = desc.PrimitiveTopologyType;
+        stream.rtvFormats.value.NumRenderTargets = desc.NumRenderTargets;
+        for (UINT i = 0; i < D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT; ++i)
+            stream.rtvFormats.value.RTFormats[i] = desc.RTVFormats[i];
+        stream.dsvFormat.value              = desc.DSVFormat;
+        stream.sampleDesc.value             = desc.SampleDesc;
+    }
+
+    D3D12_PIPELINE_STATE_STREAM_DESC streamDesc;
+    {
+        streamDesc.SizeInBytes                      = sizeof(stream);
+        streamDesc.pPipelineStateSubobjectStream    = &stream;
+    }
+
+    ComPtr<ID3D12PipelineState> pipelineState;
+
+    hr = device2->CreatePipelineState(&streamDesc, IID_PPV_ARGS(pipelineState.ReleaseAndGetAddressOf()));
+    DXThrowIfCreateFailed(hr, "ID3D12PipelineState");
+
+    return pipelineState;
+}
+
 ComPtr<ID3D12DescriptorHeap> D3D12Device::CreateDXDescriptorHeap(const D3D12_DESCRIPTOR_HEAP_DESC& desc)
 {
     ComPtr<ID3D12DescriptorHeap> descHeap;
@@ -10,11 +10,13 @@
 #include "D3D12Serialization.h"
 #include "../DXCommon/DXCore.h"
 #include "../TextureUtils.h"
+#include "../RenderSystemUtils.h"
 #include "../CheckedCast.h"
 #include "../../Core/Vendor.h"
 #include "../../Core/Helper.h"
 #include "../../Core/Assertion.h"
 #include "D3DX12/d3dx12.h"
+#include <LLGL/Timer.h>
 #include <limits.h>
 #include <codecvt>
 
@@ -22,42 +24,74 @@
 #include "Buffer/D3D12BufferArray.h"
 #include "Buffer/D3D12BufferConstantsPool.h"
 
+#include "Command/D3D12DescriptorHeapPool.h"
+
 #include "Texture/D3D12MipGenerator.h"
 
+#include "Shader/D3D12RootSignatureCache.h"
+
 #include "RenderState/D3D12GraphicsPSO.h"
 #include "RenderState/D3D12ComputePSO.h"
+#include "../../Core/ProfilerZone.h"
 
 
 namespace LLGL
 {
 
 
-D3D12RenderSystem::D3D12RenderSystem()
+D3D12RenderSystem::D3D12RenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
+    shaderCache_ { renderSystemDesc.shaderCacheDirectory }
 {
     #ifdef LLGL_DEBUG
     EnableDebugLayer();
     #endif
 
     /* Create DXGU factory 1.4, query video adapters, and create D3D12 device */
+    const std::uint64_t startTick = Timer::Tick();
     CreateFactory();
+    const std::uint64_t factoryTick = Timer::Tick();
     QueryVideoAdapters();
-    CreateDevice();
+    const std::uint64_t adaptersTick = Timer::Tick();
+    CreateDevice(renderSystemDesc.adapterIndex);
+    const std::uint64_t deviceTick = Timer::Tick();
+
+    /* Initialize memory manager for placed resources */
+    memoryMngr_.InitializeDevice(device_.GetNative());
 
     /* Create command queue interface */
     commandQueue_   = MakeUnique<D3D12CommandQueue>(device_);
     commandContext_ = &(commandQueue_->GetContext());
 
+    /* Create optional copy command queue for resource uploads */
+    if ((renderSystemDesc.flags & RenderSystemFlags::DedicatedTransferQueue) != 0)
+        transferQueue_ = MakeUnique<D3D12CommandQueue>(device_, D3D12_COMMAND_LIST_TYPE_COPY);
+
+    /* Create optional compute command queue for asynchronous compute */
+    if ((renderSystemDesc.flags & RenderSystemFlags::AsyncComputeQueue) != 0)
+        computeQueue_ = MakeUnique<D3D12CommandQueue>(device_, D3D12_COMMAND_LIST_TYPE_COMPUTE);
+
     /* Create default pipeline layout and command signature pool */
     defaultPipelineLayout_.CreateRootSignature(device_.GetNative(), {});
     cmdSignatureFactory_.CreateDefaultSignatures(device_.GetNative());
 
+    /* Create optional pipeline library */
+    auto rendererConfigD3D = GetRendererConfiguration<RendererConfigurationD3D12>(renderSystemDesc);
+    if (rendererConfigD3D != nullptr && rendererConfigD3D->pipelineLibraryEnabled)
+        CreatePipelineLibrary(rendererConfigD3D->pipelineLibrary);
+
     stagingBufferPool_.InitializeDevice(device_.GetNative(), 0);
     D3D12MipGenerator::Get().InitializeDevice(device_.GetNative());
-    D3D12BufferConstantsPool::Get().InitializeDevice(device_.GetNative(), *commandContext_, stagingBufferPool_);
+    D3D12DescriptorHeapPool::Get().InitializeDevice(device_.GetNative());
+    constantsPool_.InitializeDevice(device_.GetNative(), *commandContext_, stagingBufferPool_);
 
     /* Initialize renderer information */
     QueryRendererInfo();
     QueryRenderingCaps();
+
+    RecordStartupPhase("factory creation",                      startTick,      factoryTick     );
+    RecordStartupPhase("adapter enumeration",                   factoryTick,    adaptersTick    );
+    RecordStartupPhase("device creation",                       adaptersTick,   deviceTick      );
+    RecordStartupPhase("command queues and default resources",  deviceTick,     Timer::Tick()   );
 }
 
 D3D12RenderSystem::~D3D12RenderSystem()
@@ -75,14 +109,19 @@ D3D12RenderSystem::~D3D12RenderSystem()
 
     /* Clear resources of singletons */
     D3D12MipGenerator::Get().Clear();
-    D3D12BufferConstantsPool::Get().Clear();
+    D3D12DescriptorHeapPool::Get().Clear();
+    D3D12RootSignatureCache::Get().Clear();
 }
 
 /* ----- Swap-chain ----- */
 
 SwapChain* D3D12RenderSystem::CreateSwapChain(const SwapChainDescriptor& swapChainDesc, const std::shared_ptr<Surface>& surface)
 {
-    return TakeOwnership(swapChains_, MakeUnique<D3D12SwapChain>(*this, swapChainDesc, surface));
+    const std::uint64_t startTick = Timer::Tick();
+    auto swapChain = MakeUnique<D3D12SwapChain>(*this, swapChainDesc, surface);
+    RecordStartupPhase("swap-chain creation", startTick, Timer::Tick());
+
+    return TakeOwnership(swapChains_, std::move(swapChain));
 }
 
 void D3D12RenderSystem::Release(SwapChain& swapChain)
@@ -97,6 +136,11 @@ CommandQueue* D3D12RenderSystem::GetCommandQueue()
     return commandQueue_.get();
 }
 
+CommandQueue* D3D12RenderSystem::GetComputeQueue()
+{
+    return computeQueue_.get();
+}
+
 /* ----- Command buffers ----- */
 
 CommandBuffer* D3D12RenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& commandBufferDesc)
@@ -115,22 +159,43 @@ void D3D12RenderSystem::Release(CommandBuffer& commandBuffer)
 // private
 std::unique_ptr<D3D12Buffer> D3D12RenderSystem::CreateGpuBuffer(const BufferDescriptor& bufferDesc, const void* initialData)
 {
-    auto bufferD3D = MakeUnique<D3D12Buffer>(device_.GetNative(), bufferDesc);
+    auto bufferD3D = MakeUnique<D3D12Buffer>(device_.GetNative(), memoryMngr_, bufferDesc);
 
     if (initialData)
     {
-        /* Write initial data to GPU buffer */
-        stagingBufferPool_.WriteImmediate(
-            *commandContext_,
-            bufferD3D->GetResource(),
-            0,
-            initialData,
-            bufferDesc.size,
-            bufferD3D->GetAlignment()
-        );
+        std::lock_guard<std::mutex> guard{ uploadMutex_ };
 
-        /* Execute upload commands and wait for GPU to finish execution */
-        ExecuteCommandListAndSync();
+        if (transferQueue_)
+        {
+            /* Write initial data to GPU buffer on the copy queue; new buffers are created in the COPY_DEST state */
+            stagingBufferPool_.WriteImmediate(
+                transferQueue_->GetContext(),
+                bufferD3D->GetResource(),
+                0,
+                initialData,
+                bufferDesc.size,
+                bufferD3D->GetAlignment(),
+                D3D12_RESOURCE_STATE_COMMON
+            );
+
+            /* Execute upload commands on the copy queue without stalling the direct queue */
+            ExecuteTransferCommandListAndSync(bufferD3D->GetResource());
+        }
+        else
+        {
+            /* Write initial data to GPU buffer */
+            stagingBufferPool_.WriteImmediate(
+                *commandContext_,
+                bufferD3D->GetResource(),
+                0,
+                initialData,
+                bufferDesc.size,
+                bufferD3D->GetAlignment()
+            );
+
+            /* Execute upload commands and wait for GPU to finish execution */
+            ExecuteCommandListAndSync();
+        }
     }
 
     return bufferD3D;
@@ -142,15 +207,18 @@ Buffer* D3D12RenderSystem::CreateBuffer(const BufferDescriptor& bufferDesc, cons
     return TakeOwnership(buffers_, CreateGpuBuffer(bufferDesc, initialData));
 }
 
-BufferArray* D3D12RenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray)
+BufferArray* D3D12RenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets)
 {
     AssertCreateBufferArray(numBuffers, bufferArray);
-    return TakeOwnership(bufferArrays_, MakeUnique<D3D12BufferArray>(numBuffers, bufferArray));
+    return TakeOwnership(bufferArrays_, MakeUnique<D3D12BufferArray>(numBuffers, bufferArray, offsets));
 }
 
 void D3D12RenderSystem::Release(Buffer& buffer)
 {
+    /* Release memory regions of placed resources, then release buffer object */
+    auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
     SyncGPU();
+    bufferD3D.ReleaseMemoryRegions(memoryMngr_);
     RemoveFromUniqueSet(buffers_, &buffer);
 }
 
@@ -163,13 +231,23 @@ void D3D12RenderSystem::Release(BufferArray& bufferArray)
 void D3D12RenderSystem::WriteBuffer(Buffer& buffer, std::uint64_t offset, const void* data, std::uint64_t dataSize)
 {
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+    std::lock_guard<std::mutex> guard{ uploadMutex_ };
     stagingBufferPool_.WriteImmediate(*commandContext_, bufferD3D.GetResource(), offset, data, dataSize);
     ExecuteCommandListAndSync();
 }
 
+void D3D12RenderSystem::WriteBuffer(Buffer& buffer, std::uint32_t numRegions, const BufferWriteRegion* regions)
+{
+    auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+    std::lock_guard<std::mutex> guard{ uploadMutex_ };
+    stagingBufferPool_.WriteImmediateRegions(*commandContext_, bufferD3D.GetResource(), numRegions, regions);
+    ExecuteCommandListAndSync();
+}
+
 void D3D12RenderSystem::ReadBuffer(Buffer& buffer, std::uint64_t offset, void* data, std::uint64_t dataSize)
 {
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+    std::lock_guard<std::mutex> guard{ uploadMutex_ };
     stagingBufferPool_.ReadSubresourceRegion(*commandContext_, bufferD3D.GetResource(), offset, data, dataSize);
     /* No ExecuteCommandListAndSync() here as it has already been flushed by the staging buffer pool */
 }
@@ -180,6 +258,7 @@ void* D3D12RenderSystem::MapBufferRange(D3D12Buffer& bufferD3D, const CPUAccess
     void* mappedData = nullptr;
     const D3D12_RANGE range{ static_cast<SIZE_T>(offset), static_cast<SIZE_T>(size) };
 
+    std::lock_guard<std::mutex> guard{ uploadMutex_ };
     if (SUCCEEDED(bufferD3D.Map(*commandContext_, range, &mappedData, access)))
         return mappedData;
 
@@ -201,6 +280,7 @@ void* D3D12RenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access, std::
 void D3D12RenderSystem::UnmapBuffer(Buffer& buffer)
 {
     auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+    std::lock_guard<std::mutex> guard{ uploadMutex_ };
     bufferD3D.Unmap(*commandContext_);
 }
 
@@ -208,10 +288,12 @@ void D3D12RenderSystem::UnmapBuffer(Buffer& buffer)
 
 //private
 void D3D12RenderSystem::UpdateGpuTexture(
+    D3D12CommandContext&        commandContext,
     D3D12Texture&               textureD3D,
     const TextureRegion&        region,
     const SrcImageDescriptor&   imageDesc,
-    ComPtr<ID3D12Resource>&     uploadBuffer)
+    ComPtr<ID3D12Resource>&     uploadBuffer,
+    D3D12_RESOURCE_STATES       stateAfter)
 {
     /* Validate subresource range */
     const auto& subresource = region.subresource;
@@ -232,12 +314,17 @@ void D3D12RenderSystem::UpdateGpuTexture(
     if ((formatAttribs.flags & FormatFlags::IsCompressed) == 0 &&
         (formatAttribs.format != imageDesc.format || formatAttribs.dataType != imageDesc.dataType))
     {
-        /* Convert image data (e.g. from RGB to RGBA), and redirect initial data to new buffer */
-        intermediateData    = ConvertImageBuffer(imageDesc, formatAttribs.format, formatAttribs.dataType, Constants::maxThreadCount);
+        /* Repack strided image data, then convert image data (e.g. from RGB to RGBA), and redirect initial data to new buffer */
+        SrcImageDescriptor packedImageDesc;
+        ByteBuffer packedData = PackStridedImage(imageDesc, region.extent, packedImageDesc);
+        intermediateData    = ConvertImageBuffer(packedImageDesc, formatAttribs.format, formatAttribs.dataType, Constants::maxThreadCount);
         initialData         = intermediateData.get();
     }
     else
     {
+        /* Pass row and layer strides of the source image as pitches of the subresource data */
+        dataLayout = CalcSubresourceLayout(format, region.extent, imageDesc.rowStride, imageDesc.layerStride);
+
         /* Validate input data is large enough */
         if (imageDesc.dataSize < dataLayout.dataSize)
         {
@@ -255,39 +342,55 @@ void D3D12RenderSystem::UpdateGpuTexture(
         subresourceData.RowPitch    = dataLayout.rowStride;
         subresourceData.SlicePitch  = dataLayout.layerStride;
     }
-    textureD3D.UpdateSubresource(
-        device_.GetNative(),
-        commandContext_->GetCommandList(),
-        uploadBuffer,
-        subresourceData,
-        region.subresource.baseMipLevel,
-        region.subresource.baseArrayLayer,
-        region.subresource.numArrayLayers
-    );
+    commandContext.TransitionResource(textureD3D.GetResource(), D3D12_RESOURCE_STATE_COPY_DEST, true);
+    {
+        textureD3D.UpdateSubresource(
+            device_.GetNative(),
+            commandContext.GetCommandList(),
+            uploadBuffer,
+            subresourceData,
+            region.subresource.baseMipLevel,
+            region.subresource.baseArrayLayer,
+            region.subresource.numArrayLayers
+        );
+    }
+    commandContext.TransitionResource(textureD3D.GetResource(), stateAfter, true);
 }
 
 Texture* D3D12RenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc)
 {
-    auto textureD3D = MakeUnique<D3D12Texture>(device_.GetNative(), textureDesc);
+    auto textureD3D = MakeUnique<D3D12Texture>(device_.GetNative(), memoryMngr_, textureDesc);
 
-    if (imageDesc != nullptr)
+    /* Sparse textures have no memory until their tiles are committed, so they cannot be initialized */
+    if (imageDesc != nullptr && !textureD3D->IsSparse())
     {
         ComPtr<ID3D12Resource> uploadBuffer;
 
+        std::lock_guard<std::mutex> guard{ uploadMutex_ };
+
         /* Update first MIP-map */
         TextureRegion region;
         {
             region.subresource.numArrayLayers   = textureDesc.arrayLayers;
             region.extent                       = textureDesc.extent;
         }
-        UpdateGpuTexture(*textureD3D, region, *imageDesc, uploadBuffer);
+        if (transferQueue_ && !MustGenerateMipsOnCreate(textureDesc))
+        {
+            /* Upload image data on the copy queue; MIP-map generation requires the direct queue */
+            UpdateGpuTexture(transferQueue_->GetContext(), *textureD3D, region, *imageDesc, uploadBuffer, D3D12_RESOURCE_STATE_COMMON);
+            ExecuteTransferCommandListAndSync(textureD3D->GetResource());
+        }
+        else
+        {
+            UpdateGpuTexture(*commandContext_, *textureD3D, region, *imageDesc, uploadBuffer, textureD3D->GetResource().usageState);
 
-        /* Generate MIP-maps if enabled */
-        if (MustGenerateMipsOnCreate(textureDesc))
-            D3D12MipGenerator::Get().GenerateMips(*commandContext_, *textureD3D, textureD3D->GetWholeSubresource());
+            /* Generate MIP-maps if enabled */
+            if (MustGenerateMipsOnCreate(textureDesc))
+                D3D12MipGenerator::Get().GenerateMips(*commandContext_, *textureD3D, textureD3D->GetWholeSubresource());
 
-        /* Execute upload commands and wait for GPU to finish execution */
-        ExecuteCommandListAndSync();
+            /* Execute upload commands and wait for GPU to finish execution */
+            ExecuteCommandListAndSync();
+        }
     }
 
     return TakeOwnership(textures_, std::move(textureD3D));
@@ -295,7 +398,13 @@ Texture* D3D12RenderSystem::CreateTexture(const TextureDescriptor& textureDesc,
 
 void D3D12RenderSystem::Release(Texture& texture)
 {
+    /* Release memory region of placed resource, then release texture object */
+    auto& textureD3D = LLGL_CAST(D3D12Texture&, texture);
     SyncGPU();
+    if (textureD3D.IsSparse())
+        textureD3D.ReleaseTiles(memoryMngr_);
+    else
+        memoryMngr_.Release(textureD3D.GetMemoryRegion());
     RemoveFromUniqueSet(textures_, &texture);
 }
 
@@ -305,7 +414,8 @@ void D3D12RenderSystem::WriteTexture(Texture& texture, const TextureRegion& text
 
     /* Execute upload commands and wait for GPU to finish execution */
     ComPtr<ID3D12Resource> uploadBuffer;
-    UpdateGpuTexture(textureD3D, textureRegion, imageDesc, uploadBuffer);
+    std::lock_guard<std::mutex> guard{ uploadMutex_ };
+    UpdateGpuTexture(*commandContext_, textureD3D, textureRegion, imageDesc, uploadBuffer, textureD3D.GetResource().usageState);
 
     /* Execute upload commands and wait for GPU to finish execution */
     ExecuteCommandListAndSync();
@@ -319,8 +429,11 @@ void D3D12RenderSystem::ReadTexture(Texture& texture, const TextureRegion& textu
     ComPtr<ID3D12Resource> readbackBuffer;
     UINT rowStride = 0;
 
-    textureD3D.CreateSubresourceCopyAsReadbackBuffer(device_.GetNative(), *commandContext_, textureRegion, readbackBuffer, rowStride);
-    ExecuteCommandListAndSync();
+    {
+        std::lock_guard<std::mutex> guard{ uploadMutex_ };
+        textureD3D.CreateSubresourceCopyAsReadbackBuffer(device_.GetNative(), *commandContext_, textureRegion, readbackBuffer, rowStride);
+        ExecuteCommandListAndSync();
+    }
 
     /* Map readback buffer to CPU memory space */
     void* mappedData = nullptr;
@@ -339,11 +452,107 @@ void D3D12RenderSystem::ReadTexture(Texture& texture, const TextureRegion& textu
     readbackBuffer->Unmap(0, &writtenRange);
 }
 
+bool D3D12RenderSystem::QueryTextureTiling(const Texture& texture, TextureTiling& outTiling)
+{
+    auto& textureD3D = LLGL_CAST(const D3D12Texture&, texture);
+    return textureD3D.GetTiling(outTiling);
+}
+
+void D3D12RenderSystem::CommitTextureTiles(Texture& texture, const TextureRegion& textureRegion)
+{
+    auto& textureD3D = LLGL_CAST(D3D12Texture&, texture);
+    textureD3D.CommitTiles(*commandQueue_, memoryMngr_, textureRegion, true);
+}
+
+void D3D12RenderSystem::DecommitTextureTiles(Texture& texture, const TextureRegion& textureRegion)
+{
+    auto& textureD3D = LLGL_CAST(D3D12Texture&, texture);
+    textureD3D.CommitTiles(*commandQueue_, memoryMngr_, textureRegion, false);
+}
+
+/* ----- Native resources ----- */
+
+static bool IsD3D12ImportHandleType(NativeHandleType handleType)
+{
+    return (handleType == NativeHandleType::D3D12Resource || handleType == NativeHandleType::OpaqueWin32 || handleType == NativeHandleType::D3D12SharedHandle);
+}
+
+bool D3D12RenderSystem::QueryNativeHandle(const Resource& resource, NativeResourceHandle& outHandle)
+{
+    ID3D12Resource* native = nullptr;
+
+    switch (resource.GetResourceType())
+    {
+        case ResourceType::Buffer:
+            native = LLGL_CAST(const D3D12Buffer&, resource).GetNative();
+            break;
+        case ResourceType::Texture:
+            native = LLGL_CAST(const D3D12Texture&, resource).GetNative();
+            break;
+        default:
+            return false;
+    }
+
+    /* Return native resource without adding a reference */
+    outHandle.type          = NativeHandleType::D3D12Resource;
+    outHandle.object        = reinterpret_cast<std::uintptr_t>(native);
+    outHandle.memory        = 0;
+    outHandle.memoryOffset  = 0;
+    outHandle.memorySize    = 0;
+
+    return true;
+}
+
+bool D3D12RenderSystem::ExportResource(Resource& resource, NativeHandleType handleType, NativeResourceHandle& outHandle)
+{
+    if (handleType != NativeHandleType::D3D12SharedHandle)
+        return false;
+
+    switch (resource.GetResourceType())
+    {
+        case ResourceType::Buffer:
+            return LLGL_CAST(const D3D12Buffer&, resource).CreateSharedHandle(device_.GetNative(), outHandle);
+        case ResourceType::Texture:
+            return LLGL_CAST(const D3D12Texture&, resource).CreateSharedHandle(device_.GetNative(), outHandle);
+        default:
+            return false;
+    }
+}
+
+Buffer* D3D12RenderSystem::ImportBuffer(const BufferDescriptor& bufferDesc, const NativeResourceHandle& nativeHandle)
+{
+    if (!IsD3D12ImportHandleType(nativeHandle.type))
+        return nullptr;
+
+    AssertCreateBuffer(bufferDesc, ULLONG_MAX);
+    return TakeOwnership(buffers_, MakeUnique<D3D12Buffer>(device_.GetNative(), bufferDesc, nativeHandle));
+}
+
+Texture* D3D12RenderSystem::ImportTexture(const TextureDescriptor& textureDesc, const NativeResourceHandle& nativeHandle)
+{
+    if (!IsD3D12ImportHandleType(nativeHandle.type))
+        return nullptr;
+
+    return TakeOwnership(textures_, MakeUnique<D3D12Texture>(device_.GetNative(), textureDesc, nativeHandle));
+}
+
+/* ----- Readbacks ----- */
+
+const void* D3D12RenderSystem::MapReadback(std::uint64_t ticket, ReadbackLayout* outLayout)
+{
+    return readbackPool_.Map(ticket, outLayout);
+}
+
+void D3D12RenderSystem::UnmapReadback(std::uint64_t ticket)
+{
+    readbackPool_.Unmap(ticket);
+}
+
 /* ----- Sampler States ---- */
 
 Sampler* D3D12RenderSystem::CreateSampler(const SamplerDescriptor& samplerDesc)
 {
-    return TakeOwnership(samplers_, MakeUnique<D3D12Sampler>(samplerDesc));
+    return TakeOwnership(samplers_, MakeUnique<D3D12Sampler>(device_.GetNative(), samplerDesc));
 }
 
 void D3D12RenderSystem::Release(Sampler& sampler)
@@ -405,7 +614,20 @@ void D3D12RenderSystem::Release(RenderTarget& renderTarget)
 Shader* D3D12RenderSystem::CreateShader(const ShaderDescriptor& shaderDesc)
 {
     AssertCreateShader(shaderDesc);
-    return TakeOwnership(shaders_, MakeUnique<D3D12Shader>(shaderDesc));
+    return TakeOwnership(shaders_, MakeUnique<D3D12Shader>(shaderDesc, &shaderCache_));
+}
+
+void D3D12RenderSystem::CreateShaders(std::uint32_t numShaders, const ShaderDescriptor* shaderDescs, Shader** outShaders)
+{
+    for (std::uint32_t i = 0; i < numShaders; ++i)
+        AssertCreateShader(shaderDescs[i]);
+
+    /* Compile all HLSL sources in parallel, then create the shader objects on this thread */
+    std::vector<DXShaderCompileResult> compileResults(numShaders);
+    DXCompileShaders(numShaders, shaderDescs, compileResults.data(), &shaderCache_);
+
+    for (std::uint32_t i = 0; i < numShaders; ++i)
+        outShaders[i] = TakeOwnership(shaders_, MakeUnique<D3D12Shader>(shaderDescs[i], &shaderCache_, &compileResults[i]));
 }
 
 void D3D12RenderSystem::Release(Shader& shader)
@@ -434,6 +656,11 @@ PipelineState* D3D12RenderSystem::CreatePipelineState(const Blob& serializedCach
 
     /* Read type of PSO */
     auto seg = reader.ReadSegment();
+    if (seg.ident == Serialization::D3D12Ident_PipelineLibrary)
+    {
+        /* Pipeline libraries can only be restored at creation time of the render system */
+        throw std::invalid_argument("serialized pipeline library must be passed to RendererConfigurationD3D12::pipelineLibrary");
+    }
     if (seg.ident == Serialization::D3D12Ident_GraphicsPSOIdent)
     {
         /* Create graphics PSO from cache */
@@ -452,8 +679,13 @@ PipelineState* D3D12RenderSystem::CreatePipelineState(const Blob& serializedCach
 
 PipelineState* D3D12RenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache)
 {
+    LLGL_PROFILER_ZONE("D3D12RenderSystem::CreateGraphicsPipelineState");
+
     Serialization::Serializer writer;
 
+    /* With a pipeline library, the serialized cache contains the entire library instead of a single PSO */
+    const bool serializePSO = (serializedCache != nullptr && !pipelineLibrary_);
+
     auto pipelineState = TakeOwnership(
         pipelineStates_,
         MakeUnique<D3D12GraphicsPSO>(
@@ -461,21 +693,55 @@ PipelineState* D3D12RenderSystem::CreatePipelineState(const GraphicsPipelineDesc
             defaultPipelineLayout_,
             pipelineStateDesc,
             GetDefaultRenderPass(),
-            (serializedCache != nullptr ? &writer : nullptr)
+            (serializePSO ? &writer : nullptr),
+            pipelineLibrary_.get()
         )
     );
 
     if (serializedCache != nullptr)
-        *serializedCache = writer.Finalize();
+        *serializedCache = (serializePSO ? writer.Finalize() : pipelineLibrary_->Serialize());
+
+    return pipelineState;
+}
+
+PipelineState* D3D12RenderSystem::CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache)
+{
+    LLGL_PROFILER_ZONE("D3D12RenderSystem::CreateComputePipelineState");
+
+    auto pipelineState = TakeOwnership(
+        pipelineStates_,
+        MakeUnique<D3D12ComputePSO>(device_, defaultPipelineLayout_, pipelineStateDesc, pipelineLibrary_.get())
+    );
+
+    /* Compute PSOs can only be serialized as part of a pipeline library */
+    if (serializedCache != nullptr && pipelineLibrary_)
+        *serializedCache = pipelineLibrary_->Serialize();
 
     return pipelineState;
 }
 
-PipelineState* D3D12RenderSystem::CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* /*serializedCache*/)
+PipelineState* D3D12RenderSystem::CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc, long flags)
 {
     return TakeOwnership(
         pipelineStates_,
-        MakeUnique<D3D12ComputePSO>(device_, defaultPipelineLayout_, pipelineStateDesc)
+        MakeUnique<D3D12GraphicsPSO>(
+            device_,
+            defaultPipelineLayout_,
+            pipelineStateDesc,
+            GetDefaultRenderPass(),
+            nullptr,
+            pipelineLibrary_.get(),
+            true,
+            flags
+        )
+    );
+}
+
+PipelineState* D3D12RenderSystem::CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc, long flags)
+{
+    return TakeOwnership(
+        pipelineStates_,
+        MakeUnique<D3D12ComputePSO>(device_, defaultPipelineLayout_, pipelineStateDesc, pipelineLibrary_.get(), true, flags)
     );
 }
 
@@ -511,6 +777,155 @@ void D3D12RenderSystem::Release(Fence& fence)
     RemoveFromUniqueSet(fences_, &fence);
 }
 
+/* ----- Memory ----- */
+
+bool D3D12RenderSystem::QueryMemoryStatistics(MemoryStatistics& outStats)
+{
+    /* Query adapter the device was created with */
+    ComPtr<IDXGIAdapter3> adapter;
+    if (FAILED(factory_->EnumAdapterByLuid(device_.GetNative()->GetAdapterLuid(), IID_PPV_ARGS(adapter.ReleaseAndGetAddressOf()))))
+    {
+        outStats.heaps.clear();
+        return false;
+    }
+
+    /*
+    Report the budget and usage for the local (video memory) and non-local (shared system memory) segment groups.
+    The allocation statistics only cover the placed resource heaps; committed resources are not included
+    */
+    const DXGI_MEMORY_SEGMENT_GROUP segmentGroups[] = { DXGI_MEMORY_SEGMENT_GROUP_LOCAL, DXGI_MEMORY_SEGMENT_GROUP_NON_LOCAL };
+
+    MemoryHeapStatistics localHeapStats, nonLocalHeapStats;
+    memoryMngr_.AccumStatistics(localHeapStats, nonLocalHeapStats);
+
+    outStats.heaps.clear();
+    outStats.heaps.reserve(sizeof(segmentGroups) / sizeof(segmentGroups[0]));
+
+    for (auto segmentGroup : segmentGroups)
+    {
+        DXGI_QUERY_VIDEO_MEMORY_INFO memoryInfo;
+        if (SUCCEEDED(adapter->QueryVideoMemoryInfo(0, segmentGroup, &memoryInfo)))
+        {
+            MemoryHeapStatistics heapStats = (segmentGroup == DXGI_MEMORY_SEGMENT_GROUP_LOCAL ? localHeapStats : nonLocalHeapStats);
+            {
+                heapStats.deviceLocal   = (segmentGroup == DXGI_MEMORY_SEGMENT_GROUP_LOCAL);
+                heapStats.budget        = memoryInfo.Budget;
+                heapStats.usage         = memoryInfo.CurrentUsage;
+            }
+            outStats.heaps.push_back(heapStats);
+        }
+    }
+
+    /* Report the largest high-water mark of all staging rings */
+    outStats.stagingHighWaterMark = 0;
+    for (const auto& commandBuffer : commandBuffers_)
+        outStats.stagingHighWaterMark = std::max(outStats.stagingHighWaterMark, commandBuffer->GetStagingBufferPool().GetHighWaterMark());
+
+    return true;
+}
+
+/* ----- Residency ----- */
+
+// Returns the native resource of the specified buffer or texture and its memory region, or null if its residency cannot be changed (e.g. reserved textures).
+static ID3D12Resource* GetResidencyMemoryRegion(Resource* resource, D3D12MemoryRegion*& outRegion)
+{
+    if (resource == nullptr)
+        return nullptr;
+
+    switch (resource->GetResourceType())
+    {
+        case ResourceType::Buffer:
+        {
+            auto bufferD3D = LLGL_CAST(D3D12Buffer*, resource);
+            outRegion = &(bufferD3D->GetMemoryRegion());
+            return bufferD3D->GetNative();
+        }
+        case ResourceType::Texture:
+        {
+            /* Residency of reserved textures is determined by the heaps their tiles are mapped to */
+            auto textureD3D = LLGL_CAST(D3D12Texture*, resource);
+            if (textureD3D->IsSparse())
+                return nullptr;
+            outRegion = &(textureD3D->GetMemoryRegion());
+            return textureD3D->GetNative();
+        }
+        default:
+            return nullptr;
+    }
+}
+
+bool D3D12RenderSystem::SetResidencyPriority(const ArrayView<Resource*>& resources, ResidencyPriority priority)
+{
+    /* Residency priorities require ID3D12Device1 */
+    ComPtr<ID3D12Device1> device1;
+    if (FAILED(device_.GetNative()->QueryInterface(IID_PPV_ARGS(&device1))))
+        return false;
+
+    D3D12PageableList pageables;
+    for (Resource* resource : resources)
+    {
+        D3D12MemoryRegion* region = nullptr;
+        if (ID3D12Resource* native = GetResidencyMemoryRegion(resource, region))
+            memoryMngr_.SetResidencyPriority(*region, native, priority, pageables);
+    }
+
+    if (!pageables.objects.empty())
+    {
+        std::vector<D3D12_RESIDENCY_PRIORITY> prioritiesD3D;
+        prioritiesD3D.reserve(pageables.priorities.size());
+        for (ResidencyPriority pageablePriority : pageables.priorities)
+            prioritiesD3D.push_back(D3D12Types::Map(pageablePriority));
+
+        auto hr = device1->SetResidencyPriority(static_cast<UINT>(pageables.objects.size()), pageables.objects.data(), prioritiesD3D.data());
+        if (FAILED(hr))
+            return false;
+    }
+
+    return true;
+}
+
+bool D3D12RenderSystem::MakeResident(const ArrayView<Resource*>& resources)
+{
+    D3D12PageableList pageables;
+    for (Resource* resource : resources)
+    {
+        D3D12MemoryRegion* region = nullptr;
+        if (ID3D12Resource* native = GetResidencyMemoryRegion(resource, region))
+            memoryMngr_.MakeResident(*region, native, pageables);
+    }
+
+    /* ID3D12Device::MakeResident blocks until all objects are resident */
+    if (!pageables.objects.empty())
+    {
+        auto hr = device_.GetNative()->MakeResident(static_cast<UINT>(pageables.objects.size()), pageables.objects.data());
+        if (FAILED(hr))
+            return false;
+    }
+
+    return true;
+}
+
+bool D3D12RenderSystem::Evict(const ArrayView<Resource*>& resources)
+{
+    D3D12PageableList pageables;
+    for (Resource* resource : resources)
+    {
+        D3D12MemoryRegion* region = nullptr;
+        if (ID3D12Resource* native = GetResidencyMemoryRegion(resource, region))
+            memoryMngr_.Evict(*region, native, pageables);
+    }
+
+    /* Eviction is deferred by the runtime until the GPU no longer uses the objects, so no synchronization is required here */
+    if (!pageables.objects.empty())
+    {
+        auto hr = device_.GetNative()->Evict(static_cast<UINT>(pageables.objects.size()), pageables.objects.data());
+        if (FAILED(hr))
+            return false;
+    }
+
+    return true;
+}
+
 /* ----- Extended internal functions ----- */
 
 ComPtr<IDXGISwapChain1> D3D12RenderSystem::CreateDXSwapChain(const DXGI_SWAP_CHAIN_DESC1& swapChainDescDXGI, HWND wnd)
@@ -523,6 +938,19 @@ ComPtr<IDXGISwapChain1> D3D12RenderSystem::CreateDXSwapChain(const DXGI_SWAP_CHA
     return swapChain;
 }
 
+bool D3D12RenderSystem::IsTearingSupported() const
+{
+    /* Tearing support requires DXGI 1.5 */
+    ComPtr<IDXGIFactory5> factory5;
+    if (SUCCEEDED(factory_.As(&factory5)))
+    {
+        BOOL allowTearing = FALSE;
+        auto hr = factory5->CheckFeatureSupport(DXGI_FEATURE_PRESENT_ALLOW_TEARING, &allowTearing, sizeof(allowTearing));
+        return (SUCCEEDED(hr) && allowTearing != FALSE);
+    }
+    return false;
+}
+
 void D3D12RenderSystem::SignalFenceValue(UINT64& fenceValue)
 {
     auto& fence = commandQueue_->GetGlobalFence();
@@ -543,6 +971,8 @@ void D3D12RenderSystem::SyncGPU(UINT64& fenceValue)
 
 void D3D12RenderSystem::SyncGPU()
 {
+    if (computeQueue_)
+        computeQueue_->WaitIdle();
     commandQueue_->WaitIdle();
 }
 
@@ -581,26 +1011,26 @@ void D3D12RenderSystem::CreateFactory()
 
 void D3D12RenderSystem::QueryVideoAdapters()
 {
-    /* Enumerate over all video adapters */
-    ComPtr<IDXGIAdapter> adapter;
-    for (UINT i = 0; factory_->EnumAdapters(i, adapter.ReleaseAndGetAddressOf()) != DXGI_ERROR_NOT_FOUND; ++i)
-    {
-        /* Add adapter to the list and release handle */
-        videoAdatperDescs_.push_back(DXGetVideoAdapterDesc(adapter.Get()));
-        adapter.Reset();
-    }
+    DXQueryVideoAdapters(factory_.Get(), videoAdatperDescs_);
 }
 
-void D3D12RenderSystem::CreateDevice()
+void D3D12RenderSystem::CreateDevice(int adapterIndex)
 {
-    /* Use default adapter (null) and try all feature levels */
-    ComPtr<IDXGIAdapter> adapter;
-    auto featureLevels = DXGetFeatureLevels(D3D_FEATURE_LEVEL_12_1);
+    /* Use default adapter (null) unless a specific adapter is selected, and try all feature levels */
+    auto adapter        = DXGetAdapterByIndex(factory_.Get(), adapterIndex);
+    auto featureLevels  = DXGetFeatureLevels(D3D_FEATURE_LEVEL_12_1);
+
+    if (adapterIndex >= 0)
+        videoAdapterIndex_ = static_cast<std::size_t>(adapterIndex);
 
     /* Try to create a feature level with an hardware adapter */
     HRESULT hr = 0;
     if (!device_.CreateDXDevice(hr, adapter.Get(), featureLevels))
     {
+        /* Don't silently fall back to another adapter if a specific one was selected */
+        if (adapterIndex >= 0)
+            DXThrowIfFailed(hr, "failed to create D3D12 device on selected video adapter");
+
         /* Use software adapter as fallback */
         factory_->EnumWarpAdapter(IID_PPV_ARGS(adapter.ReleaseAndGetAddressOf()));
         if (!device_.CreateDXDevice(hr, adapter.Get(), featureLevels))
@@ -608,6 +1038,19 @@ void D3D12RenderSystem::CreateDevice()
     }
 }
 
+void D3D12RenderSystem::CreatePipelineLibrary(const Blob* serializedLibrary)
+{
+    if (serializedLibrary != nullptr)
+    {
+        /* Extract native pipeline library data from serialized blob */
+        Serialization::Deserializer reader{ *serializedLibrary };
+        auto seg = reader.ReadSegment(Serialization::D3D12Ident_PipelineLibrary);
+        pipelineLibrary_ = MakeUnique<D3D12PipelineLibrary>(device_, seg.data, seg.size);
+    }
+    else
+        pipelineLibrary_ = MakeUnique<D3D12PipelineLibrary>(device_);
+}
+
 static bool FindHighestShaderModel(ID3D12Device* device, D3D_SHADER_MODEL& shaderModel)
 {
     D3D12_FEATURE_DATA_SHADER_MODEL feature;
@@ -626,6 +1069,47 @@ static bool FindHighestShaderModel(ID3D12Device* device, D3D_SHADER_MODEL& shade
     return false;
 }
 
+// Reserved resources are supported for 2D textures from tiled resources tier 1 on
+static bool SupportsTiledResources(ID3D12Device* device)
+{
+    D3D12_FEATURE_DATA_D3D12_OPTIONS feature = {};
+    auto hr = device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &feature, sizeof(feature));
+    return (SUCCEEDED(hr) && feature.TiledResourcesTier != D3D12_TILED_RESOURCES_TIER_NOT_SUPPORTED);
+}
+
+// Returns true if the device supports unbounded descriptor ranges for all descriptor types, which requires resource binding tier 2 or higher.
+static bool SupportsUnboundedDescriptorRanges(ID3D12Device* device)
+{
+    D3D12_FEATURE_DATA_D3D12_OPTIONS feature = {};
+    auto hr = device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &feature, sizeof(feature));
+    return (SUCCEEDED(hr) && feature.ResourceBindingTier >= D3D12_RESOURCE_BINDING_TIER_2);
+}
+
+// Returns true if the device supports amplification and mesh shaders, which requires mesh shader tier 1.
+static bool SupportsMeshShaders(ID3D12Device* device)
+{
+    D3D12_FEATURE_DATA_D3D12_OPTIONS7 feature = {};
+    auto hr = device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS7, &feature, sizeof(feature));
+    return (SUCCEEDED(hr) && feature.MeshShaderTier != D3D12_MESH_SHADER_TIER_NOT_SUPPORTED);
+}
+
+// Returns true if the device supports residency priorities, which requires ID3D12Device1.
+static bool SupportsResidencyPriorities(ID3D12Device* device)
+{
+    ComPtr<ID3D12Device1> device1;
+    return SUCCEEDED(device->QueryInterface(IID_PPV_ARGS(&device1)));
+}
+
+static D3D12_VARIABLE_SHADING_RATE_TIER GetVariableShadingRateTier(ID3D12Device* device, UINT& outTileSize)
+{
+    D3D12_FEATURE_DATA_D3D12_OPTIONS6 feature = {};
+    auto hr = device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS6, &feature, sizeof(feature));
+    if (FAILED(hr))
+        return D3D12_VARIABLE_SHADING_RATE_TIER_NOT_SUPPORTED;
+    outTileSize = feature.ShadingRateImageTileSize;
+    return feature.VariableShadingRateTier;
+}
+
 static const char* DXShaderModelToString(D3D_SHADER_MODEL shaderModel)
 {
     switch (shaderModel)
@@ -653,9 +1137,9 @@ void D3D12RenderSystem::QueryRendererInfo()
         info.shadingLanguageName += DXFeatureLevelToShaderModel(GetFeatureLevel());
 
     /* Get device and vendor name from adapter */
-    if (!videoAdatperDescs_.empty())
+    if (videoAdapterIndex_ < videoAdatperDescs_.size())
     {
-        const auto& videoAdapterDesc = videoAdatperDescs_.front();
+        const auto& videoAdapterDesc = videoAdatperDescs_[videoAdapterIndex_];
         info.deviceName = ToUTF8String(videoAdapterDesc.name);
         info.vendorName = videoAdapterDesc.vendor;
     }
@@ -675,12 +1159,36 @@ void D3D12RenderSystem::QueryRenderingCaps()
         /* Set extended attributes */
         caps.features.hasConservativeRasterization  = (GetFeatureLevel() >= D3D_FEATURE_LEVEL_12_0);
         caps.features.hasTextureViewSwizzle         = true;
+        caps.features.hasIndirectCountDrawing       = true;
+        caps.features.hasNativeCommandLists         = true;
+        caps.features.hasSparseTextures             = SupportsTiledResources(device_.GetNative());
+        caps.features.hasDescriptorIndexing         = SupportsUnboundedDescriptorRanges(device_.GetNative());
+        caps.features.hasExternalMemory             = true;
+        caps.features.hasMeshShaders                = SupportsMeshShaders(device_.GetNative());
+        caps.features.hasResidencyPriorities        = SupportsResidencyPriorities(device_.GetNative());
+        caps.features.hasExplicitResidency          = true;
+
+        UINT shadingRateImageTileSize = 0;
+        const auto shadingRateTier = GetVariableShadingRateTier(device_.GetNative(), shadingRateImageTileSize);
+        caps.features.hasVariableRateShading        = (shadingRateTier != D3D12_VARIABLE_SHADING_RATE_TIER_NOT_SUPPORTED);
 
         caps.limits.maxViewports                    = D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE;
         caps.limits.maxViewportSize[0]              = D3D12_VIEWPORT_BOUNDS_MAX;
         caps.limits.maxViewportSize[1]              = D3D12_VIEWPORT_BOUNDS_MAX;
         caps.limits.maxBufferSize                   = ULLONG_MAX;
         caps.limits.maxConstantBufferSize           = D3D12_REQ_CONSTANT_BUFFER_ELEMENT_COUNT * 16;
+
+        if (caps.features.hasMeshShaders)
+        {
+            /* DispatchMesh is limited to 64K thread groups per dimension */
+            caps.limits.maxMeshShaderWorkGroups[0]  = 65535;
+            caps.limits.maxMeshShaderWorkGroups[1]  = 65535;
+            caps.limits.maxMeshShaderWorkGroups[2]  = 65535;
+        }
+
+        /* Shading-rate images are only supported with tier 2 */
+        if (shadingRateTier >= D3D12_VARIABLE_SHADING_RATE_TIER_2)
+            caps.limits.shadingRateImageTileSize    = shadingRateImageTileSize;
     }
     SetRenderingCaps(caps);
 }
@@ -695,6 +1203,17 @@ void D3D12RenderSystem::ExecuteCommandListAndSync()
     commandContext_->Finish(true);
 }
 
+void D3D12RenderSystem::ExecuteTransferCommandListAndSync(D3D12Resource& resource)
+{
+    /* Wait for the copy queue only, since the global upload buffer is reused for the next upload */
+    transferQueue_->GetContext().Finish(true);
+
+    /* Resources decay into the common state after they have been accessed on a copy queue */
+    resource.transitionState = D3D12_RESOURCE_STATE_COMMON;
+    commandContext_->TransitionResource(resource, resource.usageState, true);
+    ExecuteCommandList();
+}
+
 const D3D12RenderPass* D3D12RenderSystem::GetDefaultRenderPass() const
 {
     if (!swapChains_.empty())
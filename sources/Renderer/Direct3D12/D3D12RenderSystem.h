@@ -21,6 +21,8 @@
 
 #include "Buffer/D3D12Buffer.h"
 #include "Buffer/D3D12StagingBufferPool.h"
+#include "Buffer/D3D12ReadbackPool.h"
+#include "Buffer/D3D12BufferConstantsPool.h"
 
 #include "Texture/D3D12Texture.h"
 #include "Texture/D3D12Sampler.h"
@@ -32,13 +34,16 @@
 #include "RenderState/D3D12ResourceHeap.h"
 #include "RenderState/D3D12RenderPass.h"
 #include "RenderState/D3D12QueryHeap.h"
+#include "RenderState/D3D12PipelineLibrary.h"
 
 #include "Shader/D3D12Shader.h"
 
 #include "../ContainerTypes.h"
 #include "../DXCommon/ComPtr.h"
+#include "../DXCommon/DXShaderCache.h"
 #include <d3d12.h>
-#include <dxgi1_4.h>
+#include <dxgi1_5.h>
+#include <mutex>
 
 
 namespace LLGL
@@ -52,7 +57,7 @@ class D3D12RenderSystem final : public RenderSystem
 
         /* ----- Common ----- */
 
-        D3D12RenderSystem();
+        D3D12RenderSystem(const RenderSystemDescriptor& renderSystemDesc);
         ~D3D12RenderSystem();
 
         /* ----- Swap-chain ------ */
@@ -64,6 +69,7 @@ class D3D12RenderSystem final : public RenderSystem
         /* ----- Command queues ----- */
 
         CommandQueue* GetCommandQueue() override;
+        CommandQueue* GetComputeQueue() override;
 
         /* ----- Command buffers ----- */
 
@@ -74,12 +80,13 @@ class D3D12RenderSystem final : public RenderSystem
         /* ----- Buffers ------ */
 
         Buffer* CreateBuffer(const BufferDescriptor& bufferDesc, const void* initialData = nullptr) override;
-        BufferArray* CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray) override;
+        BufferArray* CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets = nullptr) override;
 
         void Release(Buffer& buffer) override;
         void Release(BufferArray& bufferArray) override;
 
         void WriteBuffer(Buffer& buffer, std::uint64_t offset, const void* data, std::uint64_t dataSize) override;
+        void WriteBuffer(Buffer& buffer, std::uint32_t numRegions, const BufferWriteRegion* regions) override;
         void ReadBuffer(Buffer& buffer, std::uint64_t offset, void* data, std::uint64_t dataSize) override;
 
         void* MapBuffer(Buffer& buffer, const CPUAccess access) override;
@@ -95,6 +102,22 @@ class D3D12RenderSystem final : public RenderSystem
         void WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc) override;
         void ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc) override;
 
+        bool QueryTextureTiling(const Texture& texture, TextureTiling& outTiling) override;
+        void CommitTextureTiles(Texture& texture, const TextureRegion& textureRegion) override;
+        void DecommitTextureTiles(Texture& texture, const TextureRegion& textureRegion) override;
+
+        /* ----- Native resources ----- */
+
+        bool QueryNativeHandle(const Resource& resource, NativeResourceHandle& outHandle) override;
+        bool ExportResource(Resource& resource, NativeHandleType handleType, NativeResourceHandle& outHandle) override;
+        Buffer* ImportBuffer(const BufferDescriptor& bufferDesc, const NativeResourceHandle& nativeHandle) override;
+        Texture* ImportTexture(const TextureDescriptor& textureDesc, const NativeResourceHandle& nativeHandle) override;
+
+        /* ----- Readbacks ----- */
+
+        const void* MapReadback(std::uint64_t ticket, ReadbackLayout* outLayout = nullptr) override;
+        void UnmapReadback(std::uint64_t ticket) override;
+
         /* ----- Sampler States ---- */
 
         Sampler* CreateSampler(const SamplerDescriptor& samplerDesc) override;
@@ -124,6 +147,7 @@ class D3D12RenderSystem final : public RenderSystem
         /* ----- Shader ----- */
 
         Shader* CreateShader(const ShaderDescriptor& shaderDesc) override;
+        void CreateShaders(std::uint32_t numShaders, const ShaderDescriptor* shaderDescs, Shader** outShaders) override;
 
         void Release(Shader& shader) override;
 
@@ -138,6 +162,8 @@ class D3D12RenderSystem final : public RenderSystem
         PipelineState* CreatePipelineState(const Blob& serializedCache) override;
         PipelineState* CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache = nullptr) override;
         PipelineState* CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache = nullptr) override;
+        PipelineState* CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc, long flags = 0) override;
+        PipelineState* CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc, long flags = 0) override;
 
         void Release(PipelineState& pipelineState) override;
 
@@ -153,12 +179,25 @@ class D3D12RenderSystem final : public RenderSystem
 
         void Release(Fence& fence) override;
 
+        /* ----- Memory ----- */
+
+        bool QueryMemoryStatistics(MemoryStatistics& outStats) override;
+
+        /* ----- Residency ----- */
+
+        bool SetResidencyPriority(const ArrayView<Resource*>& resources, ResidencyPriority priority) override;
+        bool MakeResident(const ArrayView<Resource*>& resources) override;
+        bool Evict(const ArrayView<Resource*>& resources) override;
+
     public:
 
         /* ----- Extended internal functions ----- */
 
         ComPtr<IDXGISwapChain1> CreateDXSwapChain(const DXGI_SWAP_CHAIN_DESC1& swapChainDescDXGI, HWND wnd);
 
+        // Returns true if the DXGI factory supports presentation with tearing (DXGI_FEATURE_PRESENT_ALLOW_TEARING).
+        bool IsTearingSupported() const;
+
         // Internal fence
         void SignalFenceValue(UINT64& fenceValue);
         void WaitForFenceValue(UINT64 fenceValue);
@@ -167,12 +206,14 @@ class D3D12RenderSystem final : public RenderSystem
         void SyncGPU(UINT64& fenceValue);
         void SyncGPU();
 
-        // Updates the image data of the specified texture region.
+        // Updates the image data of the specified texture region and transitions the texture into the specified state afterwards.
         void UpdateGpuTexture(
+            D3D12CommandContext&        commandContext,
             D3D12Texture&               textureD3D,
             const TextureRegion&        region,
             const SrcImageDescriptor&   imageDesc,
-            ComPtr<ID3D12Resource>&     uploadBuffer
+            ComPtr<ID3D12Resource>&     uploadBuffer,
+            D3D12_RESOURCE_STATES       stateAfter
         );
 
         // Maps the range of the specified D3D buffer between GPU and CPU memory space.
@@ -202,6 +243,18 @@ class D3D12RenderSystem final : public RenderSystem
             return device_;
         }
 
+        // Returns the device-wide pool of asynchronous readbacks.
+        inline D3D12ReadbackPool& GetReadbackPool()
+        {
+            return readbackPool_;
+        }
+
+        // Returns the device-wide pool of immutable buffer constants.
+        inline const D3D12BufferConstantsPool& GetConstantsPool() const
+        {
+            return constantsPool_;
+        }
+
         // Returns the command signmature factory.
         inline const D3D12SignatureFactory& GetSignatureFactory() const
         {
@@ -216,7 +269,10 @@ class D3D12RenderSystem final : public RenderSystem
 
         void CreateFactory();
         void QueryVideoAdapters();
-        void CreateDevice();
+        void CreateDevice(int adapterIndex);
+
+        // Creates the device-wide pipeline library with the optional serialized library from a previous run.
+        void CreatePipelineLibrary(const Blob* serializedLibrary);
 
         void QueryRendererInfo();
         void QueryRenderingCaps();
@@ -227,6 +283,12 @@ class D3D12RenderSystem final : public RenderSystem
 
         std::unique_ptr<D3D12Buffer> CreateGpuBuffer(const BufferDescriptor& bufferDesc, const void* initialData);
 
+        /*
+        Executes the pending copy commands of the transfer queue and waits for their completion.
+        The specified resource is left in the common state by the copy queue and transitioned back into its usage state on the direct queue.
+        */
+        void ExecuteTransferCommandListAndSync(D3D12Resource& resource);
+
         const D3D12RenderPass* GetDefaultRenderPass() const;
 
     private:
@@ -235,15 +297,23 @@ class D3D12RenderSystem final : public RenderSystem
 
         ComPtr<IDXGIFactory4>                   factory_;
         D3D12Device                             device_;
+        D3D12MemoryManager                      memoryMngr_;                            // Must be declared before any buffers and textures are declared
         D3D12CommandContext*                    commandContext_         = nullptr;
         D3D12PipelineLayout                     defaultPipelineLayout_;
         D3D12SignatureFactory                   cmdSignatureFactory_;
         D3D12StagingBufferPool                  stagingBufferPool_;
+        D3D12ReadbackPool                       readbackPool_;                          // Must be declared before the command buffers, since they register their readbacks here
+        D3D12BufferConstantsPool                constantsPool_;                         // Device-wide immutable constants, e.g. zero-initialized ranges for stream-output counters
+        std::unique_ptr<D3D12PipelineLibrary>   pipelineLibrary_;                       // Optional device-wide pipeline library
+        std::mutex                              uploadMutex_;                           // Guards the shared command contexts and the staging buffer pool for uploads from multiple threads
+        DXShaderCache                           shaderCache_;                           // Optional on-disk cache of compiled HLSL bytecode
 
         /* ----- Hardware object containers ----- */
 
         HWObjectContainer<D3D12SwapChain>       swapChains_;
         HWObjectInstance<D3D12CommandQueue>     commandQueue_;
+        std::unique_ptr<D3D12CommandQueue>      transferQueue_;
+        std::unique_ptr<D3D12CommandQueue>      computeQueue_;
         HWObjectContainer<D3D12CommandBuffer>   commandBuffers_;
         HWObjectContainer<D3D12Buffer>          buffers_;
         HWObjectContainer<BufferArray>          bufferArrays_;
@@ -261,6 +331,7 @@ class D3D12RenderSystem final : public RenderSystem
         /* ----- Other members ----- */
 
         std::vector<VideoAdapterDescriptor>     videoAdatperDescs_;
+        std::size_t                             videoAdapterIndex_  = 0; // Index into 'videoAdatperDescs_' of the adapter the device was created on
 
 };
 
@@ -46,6 +46,7 @@ enum D3D12Ident : IdentType
     D3D12Ident_HS,                  // D3D12_SHADER_BYTECODE
     D3D12Ident_GS,                  // D3D12_SHADER_BYTECODE
     D3D12Ident_CS,                  // D3D12_SHADER_BYTECODE
+    D3D12Ident_PipelineLibrary,     // Data from ID3D12PipelineLibrary::Serialize
 };
 
 
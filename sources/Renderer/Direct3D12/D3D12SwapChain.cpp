@@ -18,6 +18,7 @@
 
 #include <LLGL/Platform/NativeHandle.h>
 #include <LLGL/Log.h>
+#include <LLGL/PipelineStateFlags.h>
 #include <LLGL/Misc/ForRange.h>
 #include "D3DX12/d3dx12.h"
 #include <algorithm>
@@ -36,11 +37,19 @@ D3D12SwapChain::D3D12SwapChain(
     renderSystem_       { renderSystem                                               },
     frameFence_         { renderSystem.GetDXDevice()                                 },
     depthStencilFormat_ { DXPickDepthStencilFormat(desc.depthBits, desc.stencilBits) },
-    numFrames_          { std::max(1u, std::min(desc.swapBuffers, maxSwapBuffers))   }
+    numFrames_          { std::max(1u, std::min(desc.swapBuffers, maxSwapBuffers))   },
+    presentMode_        { desc.presentMode                                           },
+    maxFrameLatency_    { desc.maxFrameLatency                                       }
 {
     /* Store reference to command queue */
     commandQueue_ = LLGL_CAST(D3D12CommandQueue*, renderSystem_.GetCommandQueue());
 
+    /* Select swap-chain flags for frame latency and presentation mode; these flags must be the same for IDXGISwapChain::ResizeBuffers */
+    if (maxFrameLatency_ > 0)
+        swapChainFlags_ |= DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+    if (presentMode_ == PresentMode::Immediate && renderSystem.IsTearingSupported())
+        swapChainFlags_ |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
+
     /* Setup surface for the swap-chain */
     SetOrCreateSurface(surface, desc.resolution, desc.fullscreen, nullptr);
 
@@ -56,6 +65,9 @@ D3D12SwapChain::~D3D12SwapChain()
 {
     /* Ensure the GPU is no longer referencing resources that are about to be released */
     MoveToNextFrame();
+
+    if (frameLatencyWaitableObject_ != nullptr)
+        CloseHandle(frameLatencyWaitableObject_);
 }
 
 void D3D12SwapChain::SetName(const char* name)
@@ -79,13 +91,58 @@ void D3D12SwapChain::SetName(const char* name)
 void D3D12SwapChain::Present()
 {
     /* Present swap-chain with vsync interval */
-    auto hr = swapChainDXGI_->Present(syncInterval_, 0);
+    UINT syncInterval = 0, presentFlags = 0;
+    GetPresentParameters(syncInterval, presentFlags);
+
+    /* Only present the damage regions if they have been set for this frame (see SetDamageRegions) */
+    DXGI_PRESENT_PARAMETERS presentParams;
+    {
+        presentParams.DirtyRectsCount   = static_cast<UINT>(dirtyRects_.size());
+        presentParams.pDirtyRects       = (dirtyRects_.empty() ? nullptr : dirtyRects_.data());
+        presentParams.pScrollRect       = nullptr;
+        presentParams.pScrollOffset     = nullptr;
+    }
+    auto hr = swapChainDXGI_->Present1(syncInterval, presentFlags, &presentParams);
     DXThrowIfFailed(hr, "failed to present DXGI swap chain");
+    dirtyRects_.clear();
 
     /* Advance frame counter */
     MoveToNextFrame();
 }
 
+void D3D12SwapChain::WaitForNextFrame()
+{
+    /* Block until the swap-chain has less than the maximum number of frames queued up (with a timeout of 1 second) */
+    if (frameLatencyWaitableObject_ != nullptr)
+        WaitForSingleObjectEx(frameLatencyWaitableObject_, 1000, TRUE);
+}
+
+bool D3D12SwapChain::SetDamageRegions(std::uint32_t numRegions, const Scissor* regions)
+{
+    /* Clamp damage regions to the back buffer, since IDXGISwapChain1::Present1 fails for dirty rectangles outside of it */
+    const Extent2D resolution = GetResolution();
+    dirtyRects_.clear();
+    dirtyRects_.reserve(numRegions);
+    for (std::uint32_t i = 0; i < numRegions; ++i)
+    {
+        RECT rect;
+        {
+            rect.left   = Clamp<LONG>(regions[i].x, 0, static_cast<LONG>(resolution.width));
+            rect.top    = Clamp<LONG>(regions[i].y, 0, static_cast<LONG>(resolution.height));
+            rect.right  = Clamp<LONG>(regions[i].x + regions[i].width, rect.left, static_cast<LONG>(resolution.width));
+            rect.bottom = Clamp<LONG>(regions[i].y + regions[i].height, rect.top, static_cast<LONG>(resolution.height));
+        }
+        if (rect.right > rect.left && rect.bottom > rect.top)
+            dirtyRects_.push_back(rect);
+    }
+    return true;
+}
+
+bool D3D12SwapChain::QueryPresentStatistics(PresentStatistics& outStats)
+{
+    return DXGetPresentStatistics(swapChainDXGI_.Get(), outStats);
+}
+
 std::uint32_t D3D12SwapChain::GetSamples() const
 {
     return sampleDesc_.Count;
@@ -199,6 +256,30 @@ bool D3D12SwapChain::SetPresentSyncInterval(UINT syncInterval)
     return false;
 }
 
+void D3D12SwapChain::GetPresentParameters(UINT& outSyncInterval, UINT& outFlags) const
+{
+    switch (presentMode_)
+    {
+        case PresentMode::Fifo:
+            outSyncInterval = std::max(1u, syncInterval_);
+            outFlags        = 0;
+            break;
+        case PresentMode::Mailbox:
+            /* Flip-model swap-chains replace the queued frame when presented with a sync interval of 0 and without tearing */
+            outSyncInterval = 0;
+            outFlags        = 0;
+            break;
+        case PresentMode::Immediate:
+            outSyncInterval = 0;
+            outFlags        = ((swapChainFlags_ & DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING) != 0 ? DXGI_PRESENT_ALLOW_TEARING : 0);
+            break;
+        default:
+            outSyncInterval = syncInterval_;
+            outFlags        = 0;
+            break;
+    }
+}
+
 void D3D12SwapChain::QueryDeviceParameters(const D3D12Device& device, std::uint32_t samples)
 {
     /* Find suitable sample descriptor */
@@ -235,7 +316,7 @@ void D3D12SwapChain::CreateResolutionDependentResources(const Extent2D& resoluti
             resolution.width,
             resolution.height,
             colorFormat_,
-            0
+            swapChainFlags_
         );
 
         if (hr == DXGI_ERROR_DEVICE_REMOVED || hr == DXGI_ERROR_DEVICE_RESET)
@@ -265,11 +346,18 @@ void D3D12SwapChain::CreateResolutionDependentResources(const Extent2D& resoluti
             swapChainDesc.Scaling               = DXGI_SCALING_NONE;
             swapChainDesc.SwapEffect            = DXGI_SWAP_EFFECT_FLIP_DISCARD;
             swapChainDesc.AlphaMode             = DXGI_ALPHA_MODE_IGNORE;
-            swapChainDesc.Flags                 = 0;
+            swapChainDesc.Flags                 = swapChainFlags_;
         }
         auto swapChain = renderSystem_.CreateDXSwapChain(swapChainDesc, wndHandle.window);
 
         swapChain.As(&swapChainDXGI_);
+
+        /* Limit the number of queued frames and get waitable object for SwapChain::WaitForNextFrame */
+        if ((swapChainFlags_ & DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT) != 0)
+        {
+            swapChainDXGI_->SetMaximumFrameLatency(std::min(maxFrameLatency_, static_cast<UINT>(DXGI_MAX_SWAP_CHAIN_BUFFERS)));
+            frameLatencyWaitableObject_ = swapChainDXGI_->GetFrameLatencyWaitableObject();
+        }
     }
 
     /* Create color buffer render target views (RTV) */
@@ -12,6 +12,7 @@
 #include <LLGL/Window.h>
 #include <LLGL/SwapChain.h>
 #include <cstddef>
+#include <vector>
 #include "D3D12Resource.h"
 #include "RenderState/D3D12Fence.h"
 #include "RenderState/D3D12RenderPass.h"
@@ -19,7 +20,7 @@
 #include "../DXCommon/DXCore.h"
 
 #include <d3d12.h>
-#include <dxgi1_4.h>
+#include <dxgi1_5.h>
 
 
 namespace LLGL
@@ -39,6 +40,9 @@ class D3D12SwapChain final : public SwapChain
         void SetName(const char* name) override;
 
         void Present() override;
+        void WaitForNextFrame() override;
+        bool QueryPresentStatistics(PresentStatistics& outStats) override;
+        bool SetDamageRegions(std::uint32_t numRegions, const Scissor* regions) override;
 
         std::uint32_t GetSamples() const override;
 
@@ -78,6 +82,9 @@ class D3D12SwapChain final : public SwapChain
 
         bool SetPresentSyncInterval(UINT syncInterval);
 
+        // Returns the sync interval and flags for IDXGISwapChain::Present depending on the presentation mode.
+        void GetPresentParameters(UINT& outSyncInterval, UINT& outFlags) const;
+
         void QueryDeviceParameters(const D3D12Device& device, std::uint32_t samples);
 
         void CreateResolutionDependentResources(const Extent2D& resolution);
@@ -97,6 +104,10 @@ class D3D12SwapChain final : public SwapChain
         ComPtr<IDXGISwapChain3>         swapChainDXGI_;
         DXGI_SAMPLE_DESC                sampleDesc_                         = { 1, 0 };
         UINT                            syncInterval_                       = 0;
+        PresentMode                     presentMode_                        = PresentMode::Undefined;
+        UINT                            swapChainFlags_                     = 0;
+        UINT                            maxFrameLatency_                    = 0;
+        HANDLE                          frameLatencyWaitableObject_         = nullptr;
 
         ComPtr<ID3D12DescriptorHeap>    rtvDescHeap_;
         UINT                            rtvDescSize_                        = 0;
@@ -115,6 +126,8 @@ class D3D12SwapChain final : public SwapChain
         UINT                            numFrames_                          = 0;
         UINT                            currentFrame_                       = 0;
 
+        std::vector<RECT>               dirtyRects_;                                // Damage regions for the next present
+
 };
 
 
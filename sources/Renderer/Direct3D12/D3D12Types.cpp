@@ -239,6 +239,34 @@ UINT Map(const TextureSwizzleRGBA& textureSwizzle)
     );
 }
 
+D3D12_SHADING_RATE Map(const ShadingRate shadingRate)
+{
+    switch (shadingRate)
+    {
+        case ShadingRate::Rate1x1:  return D3D12_SHADING_RATE_1X1;
+        case ShadingRate::Rate1x2:  return D3D12_SHADING_RATE_1X2;
+        case ShadingRate::Rate2x1:  return D3D12_SHADING_RATE_2X1;
+        case ShadingRate::Rate2x2:  return D3D12_SHADING_RATE_2X2;
+        case ShadingRate::Rate2x4:  return D3D12_SHADING_RATE_2X4;
+        case ShadingRate::Rate4x2:  return D3D12_SHADING_RATE_4X2;
+        case ShadingRate::Rate4x4:  return D3D12_SHADING_RATE_4X4;
+    }
+    DXTypes::MapFailed("ShadingRate", "D3D12_SHADING_RATE");
+}
+
+D3D12_RESIDENCY_PRIORITY Map(const ResidencyPriority priority)
+{
+    switch (priority)
+    {
+        case ResidencyPriority::Minimum:    return D3D12_RESIDENCY_PRIORITY_MINIMUM;
+        case ResidencyPriority::Low:        return D3D12_RESIDENCY_PRIORITY_LOW;
+        case ResidencyPriority::Normal:     return D3D12_RESIDENCY_PRIORITY_NORMAL;
+        case ResidencyPriority::High:       return D3D12_RESIDENCY_PRIORITY_HIGH;
+        case ResidencyPriority::Maximum:    return D3D12_RESIDENCY_PRIORITY_MAXIMUM;
+    }
+    DXTypes::MapFailed("ResidencyPriority", "D3D12_RESIDENCY_PRIORITY");
+}
+
 D3D12_SRV_DIMENSION MapSrvDimension(const TextureType textureType)
 {
     switch (textureType)
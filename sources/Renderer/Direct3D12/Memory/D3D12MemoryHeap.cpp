@@ -0,0 +1,150 @@
+/*
+ * D3D12MemoryHeap.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12MemoryHeap.h"
+#include "../../DXCommon/DXCore.h"
+#include "../../../Core/Helper.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+const int D3D12MemoryHeap::g_numPriorities;
+
+D3D12MemoryHeap::D3D12MemoryHeap(ID3D12Device* device, D3D12_HEAP_TYPE heapType, D3D12_HEAP_FLAGS heapFlags, UINT64 size) :
+    size_ { size }
+{
+    /* Create native heap with default placement alignment of 64 KB */
+    D3D12_HEAP_DESC heapDesc;
+    {
+        heapDesc.SizeInBytes                        = size;
+        heapDesc.Properties.Type                    = heapType;
+        heapDesc.Properties.CPUPageProperty         = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+        heapDesc.Properties.MemoryPoolPreference    = D3D12_MEMORY_POOL_UNKNOWN;
+        heapDesc.Properties.CreationNodeMask        = 0;
+        heapDesc.Properties.VisibleNodeMask         = 0;
+        heapDesc.Alignment                          = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+        heapDesc.Flags                              = heapFlags;
+    }
+    auto hr = device->CreateHeap(&heapDesc, IID_PPV_ARGS(native_.ReleaseAndGetAddressOf()));
+    DXThrowIfCreateFailed(hr, "ID3D12Heap");
+
+    /* Start with a single free range over the entire heap */
+    freeRanges_.push_back({ 0, size });
+}
+
+bool D3D12MemoryHeap::Allocate(UINT64 size, UINT64 alignment, UINT64& outOffset)
+{
+    for (auto it = freeRanges_.begin(); it != freeRanges_.end(); ++it)
+    {
+        /* Check if the aligned block fits into this free range */
+        const UINT64 alignedOffset  = GetAlignedSize(it->offset, alignment);
+        const UINT64 padding        = alignedOffset - it->offset;
+        if (padding + size > it->size)
+            continue;
+
+        const UINT64 rangeEnd = it->offset + it->size;
+
+        /* Split free range into the padding in front and remainder behind the block */
+        if (padding > 0)
+        {
+            it->size = padding;
+            if (alignedOffset + size < rangeEnd)
+                freeRanges_.insert(it + 1, { alignedOffset + size, rangeEnd - (alignedOffset + size) });
+        }
+        else if (alignedOffset + size < rangeEnd)
+        {
+            it->offset  = alignedOffset + size;
+            it->size    = rangeEnd - it->offset;
+        }
+        else
+            freeRanges_.erase(it);
+
+        usedSize_ += size;
+        ++numBlocks_;
+        ++numBlocksPerPriority_[static_cast<int>(ResidencyPriority::Normal)];
+        outOffset = alignedOffset;
+        return true;
+    }
+    return false;
+}
+
+void D3D12MemoryHeap::Release(UINT64 offset, UINT64 size)
+{
+    /* Find insertion position so the free ranges remain sorted by offset */
+    auto it = std::upper_bound(
+        freeRanges_.begin(), freeRanges_.end(), offset,
+        [](UINT64 lhs, const FreeRange& rhs)
+        {
+            return (lhs < rhs.offset);
+        }
+    );
+
+    /* Merge with previous and next free range if they are adjacent */
+    const bool mergePrev = (it != freeRanges_.begin() && (it - 1)->offset + (it - 1)->size == offset);
+    const bool mergeNext = (it != freeRanges_.end() && offset + size == it->offset);
+
+    if (mergePrev && mergeNext)
+    {
+        (it - 1)->size += size + it->size;
+        freeRanges_.erase(it);
+    }
+    else if (mergePrev)
+        (it - 1)->size += size;
+    else if (mergeNext)
+    {
+        it->offset  = offset;
+        it->size   += size;
+    }
+    else
+        freeRanges_.insert(it, { offset, size });
+
+    usedSize_ -= size;
+    --numBlocks_;
+    --numBlocksPerPriority_[static_cast<int>(ResidencyPriority::Normal)];
+}
+
+UINT64 D3D12MemoryHeap::GetMaxFreeRangeSize() const
+{
+    UINT64 maxSize = 0;
+    for (const auto& range : freeRanges_)
+        maxSize = std::max(maxSize, range.size);
+    return maxSize;
+}
+
+void D3D12MemoryHeap::ChangeBlockPriority(ResidencyPriority oldPriority, ResidencyPriority newPriority)
+{
+    --numBlocksPerPriority_[static_cast<int>(oldPriority)];
+    ++numBlocksPerPriority_[static_cast<int>(newPriority)];
+}
+
+ResidencyPriority D3D12MemoryHeap::GetMaxBlockPriority() const
+{
+    for (int i = g_numPriorities - 1; i > 0; --i)
+    {
+        if (numBlocksPerPriority_[i] > 0)
+            return static_cast<ResidencyPriority>(i);
+    }
+    return ResidencyPriority::Minimum;
+}
+
+void D3D12MemoryHeap::ChangeBlockEviction(bool evicted)
+{
+    if (evicted)
+        ++numEvictedBlocks_;
+    else
+        --numEvictedBlocks_;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,150 @@
+/*
+ * D3D12MemoryHeap.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_MEMORY_HEAP_H
+#define LLGL_D3D12_MEMORY_HEAP_H
+
+
+#include "../../DXCommon/ComPtr.h"
+#include <LLGL/RenderSystemFlags.h>
+#include <d3d12.h>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+An instance of this class holds a single ID3D12Heap into which resources are placed with ID3D12Device::CreatePlacedResource.
+Free ranges are kept in a list sorted by offset, so released blocks can be merged with their neighbours (first-fit allocation).
+Residency can only be controlled for the entire heap, so the heap keeps track of the residency priorities and eviction of its blocks.
+*/
+class D3D12MemoryHeap
+{
+
+    public:
+
+        D3D12MemoryHeap(ID3D12Device* device, D3D12_HEAP_TYPE heapType, D3D12_HEAP_FLAGS heapFlags, UINT64 size);
+
+        D3D12MemoryHeap(const D3D12MemoryHeap&) = delete;
+        D3D12MemoryHeap& operator = (const D3D12MemoryHeap&) = delete;
+
+        // Tries to allocate a block of the specified size and alignment, and returns false on failure.
+        bool Allocate(UINT64 size, UINT64 alignment, UINT64& outOffset);
+
+        // Releases the block at the specified offset. The block must have priority ResidencyPriority::Normal and must not be evicted.
+        void Release(UINT64 offset, UINT64 size);
+
+        // Returns true if this heap has no more blocks.
+        inline bool IsEmpty() const
+        {
+            return (numBlocks_ == 0);
+        }
+
+        // Returns the native ID3D12Heap object.
+        inline ID3D12Heap* GetNative() const
+        {
+            return native_.Get();
+        }
+
+        // Returns the size of the entire heap.
+        inline UINT64 GetSize() const
+        {
+            return size_;
+        }
+
+        // Returns the number of bytes that are currently allocated by blocks within this heap.
+        inline UINT64 GetUsedSize() const
+        {
+            return usedSize_;
+        }
+
+        // Returns the number of blocks that are currently allocated within this heap.
+        inline UINT GetNumBlocks() const
+        {
+            return numBlocks_;
+        }
+
+        // Returns the size of the largest free range.
+        UINT64 GetMaxFreeRangeSize() const;
+
+    public:
+
+        // Moves a block from one residency priority to another. New blocks have priority ResidencyPriority::Normal.
+        void ChangeBlockPriority(ResidencyPriority oldPriority, ResidencyPriority newPriority);
+
+        // Returns the highest residency priority of all blocks within this heap.
+        ResidencyPriority GetMaxBlockPriority() const;
+
+        // Increments or decrements the number of evicted blocks.
+        void ChangeBlockEviction(bool evicted);
+
+        // Returns true if this heap has blocks and all of them have been evicted.
+        inline bool AreAllBlocksEvicted() const
+        {
+            return (numBlocks_ > 0 && numEvictedBlocks_ == numBlocks_);
+        }
+
+        // Stores the residency priority that was last set for the native heap.
+        inline void SetResidencyPriority(ResidencyPriority priority)
+        {
+            priority_ = priority;
+        }
+
+        // Returns the residency priority that was last set for the native heap.
+        inline ResidencyPriority GetResidencyPriority() const
+        {
+            return priority_;
+        }
+
+        // Stores whether the native heap has been evicted. Evicted heaps are not used for new allocations.
+        inline void SetEvicted(bool evicted)
+        {
+            evicted_ = evicted;
+        }
+
+        // Returns true if the native heap has been evicted.
+        inline bool IsEvicted() const
+        {
+            return evicted_;
+        }
+
+    private:
+
+        struct FreeRange
+        {
+            UINT64 offset;
+            UINT64 size;
+        };
+
+        static const int g_numPriorities = static_cast<int>(ResidencyPriority::Maximum) + 1;
+
+    private:
+
+        ComPtr<ID3D12Heap>      native_;
+        UINT64                  size_                                   = 0;
+        UINT64                  usedSize_                               = 0;
+        UINT                    numBlocks_                              = 0;
+        std::vector<FreeRange>  freeRanges_;
+
+        UINT                    numBlocksPerPriority_[g_numPriorities]  = {};
+        UINT                    numEvictedBlocks_                       = 0;
+        ResidencyPriority       priority_                               = ResidencyPriority::Normal;
+        bool                    evicted_                                = false;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
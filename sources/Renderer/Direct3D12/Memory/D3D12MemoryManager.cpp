@@ -0,0 +1,361 @@
+/*
+ * D3D12MemoryManager.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12MemoryManager.h"
+#include "../D3DX12/d3dx12.h"
+#include "../../DXCommon/DXCore.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+void D3D12PageableList::Append(ID3D12Pageable* object, ResidencyPriority priority)
+{
+    for (std::size_t i = 0; i < objects.size(); ++i)
+    {
+        if (objects[i] == object)
+        {
+            priorities[i] = priority;
+            return;
+        }
+    }
+    objects.push_back(object);
+    priorities.push_back(priority);
+}
+
+
+/*
+ * D3D12MemoryManager class
+ */
+
+const UINT D3D12MemoryManager::g_numHeapTypes;
+
+void D3D12MemoryManager::InitializeDevice(ID3D12Device* device, UINT64 heapSize)
+{
+    device_     = device;
+    heapSize_   = heapSize;
+}
+
+static D3D12_HEAP_FLAGS GetHeapFlagsForCategory(int category)
+{
+    switch (category)
+    {
+        case 0:  return D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+        case 1:  return D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;
+        default: return D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;
+    }
+}
+
+void D3D12MemoryManager::CreateResource(
+    D3D12_HEAP_TYPE             heapType,
+    const D3D12_RESOURCE_DESC&  desc,
+    D3D12_RESOURCE_STATES       initialState,
+    const D3D12_CLEAR_VALUE*    optimizedClearValue,
+    ComPtr<ID3D12Resource>&     outResource,
+    D3D12MemoryRegion&          outRegion)
+{
+    outRegion = D3D12MemoryRegion{};
+    outRegion.heapType = heapType;
+
+    /* Determine resource category */
+    ResourceCategory category = ResourceCategory_Buffers;
+    if (desc.Dimension != D3D12_RESOURCE_DIMENSION_BUFFER)
+    {
+        if ((desc.Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL)) != 0)
+            category = ResourceCategory_RenderTargets;
+        else
+            category = ResourceCategory_Textures;
+    }
+
+    /* Multi-sampled textures require a 4 MB placement alignment; those are always committed resources */
+    const bool isPlaceable = (device_ != nullptr && heapSize_ > 0 && desc.SampleDesc.Count <= 1);
+
+    if (isPlaceable)
+    {
+        /* Try small placement alignment (4 KB) for small textures first */
+        D3D12_RESOURCE_DESC placedDesc = desc;
+        D3D12_RESOURCE_ALLOCATION_INFO allocInfo = {};
+
+        if (category == ResourceCategory_Textures)
+        {
+            placedDesc.Alignment = D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT;
+            allocInfo = device_->GetResourceAllocationInfo(0, 1, &placedDesc);
+            if (allocInfo.Alignment != D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT)
+                placedDesc.Alignment = 0;
+        }
+
+        if (placedDesc.Alignment == 0)
+            allocInfo = device_->GetResourceAllocationInfo(0, 1, &placedDesc);
+
+        /* Place resource into a heap unless it takes up more than a quarter of a heap */
+        if (allocInfo.SizeInBytes != UINT64_MAX && allocInfo.SizeInBytes <= heapSize_ / 4)
+        {
+            std::lock_guard<std::mutex> guard{ mutex_ };
+
+            UINT64 offset = 0;
+            if (auto heap = Allocate(heapType, category, allocInfo.SizeInBytes, allocInfo.Alignment, offset))
+            {
+                auto hr = device_->CreatePlacedResource(
+                    heap->GetNative(),
+                    offset,
+                    &placedDesc,
+                    initialState,
+                    optimizedClearValue,
+                    IID_PPV_ARGS(outResource.ReleaseAndGetAddressOf())
+                );
+
+                if (FAILED(hr))
+                {
+                    heap->Release(offset, allocInfo.SizeInBytes);
+                    DXThrowIfCreateFailed(hr, "ID3D12Resource", "for placed resource");
+                }
+
+                outRegion.heap      = heap;
+                outRegion.offset    = offset;
+                outRegion.size      = allocInfo.SizeInBytes;
+                return;
+            }
+        }
+    }
+
+    /* Create committed resource as fallback */
+    auto hr = device_->CreateCommittedResource(
+        &CD3DX12_HEAP_PROPERTIES(heapType),
+        D3D12_HEAP_FLAG_NONE,
+        &desc,
+        initialState,
+        optimizedClearValue,
+        IID_PPV_ARGS(outResource.ReleaseAndGetAddressOf())
+    );
+    DXThrowIfCreateFailed(hr, "ID3D12Resource", "for committed resource");
+
+    /* Store size of committed resource for the eviction statistics */
+    outRegion.size = device_->GetResourceAllocationInfo(0, 1, &desc).SizeInBytes;
+}
+
+void D3D12MemoryManager::AllocateTiles(UINT numTiles, D3D12MemoryRegion& outRegion)
+{
+    const UINT64 size = static_cast<UINT64>(numTiles) * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+
+    outRegion = D3D12MemoryRegion{};
+
+    if (device_ == nullptr || size > heapSize_)
+        throw std::runtime_error("failed to allocate memory for D3D12 tiles: size exceeds heap size (" + std::to_string(size) + " bytes)");
+
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    /* Tiles of reserved textures are mapped into the same heaps as non-RT/DS textures */
+    UINT64 offset = 0;
+    if (auto heap = Allocate(D3D12_HEAP_TYPE_DEFAULT, ResourceCategory_Textures, size, D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES, offset))
+    {
+        outRegion.heap      = heap;
+        outRegion.offset    = offset;
+        outRegion.size      = size;
+    }
+    else
+        throw std::runtime_error("failed to allocate memory for D3D12 tiles");
+}
+
+void D3D12MemoryManager::Release(D3D12MemoryRegion& region)
+{
+    if (region.heap != nullptr)
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+
+        /* Reset residency state of the block; the residency of the heap itself is only changed by SetResidencyPriority, Evict, and MakeResident */
+        region.heap->ChangeBlockPriority(region.priority, ResidencyPriority::Normal);
+        if (region.evicted)
+            region.heap->ChangeBlockEviction(false);
+
+        region.heap->Release(region.offset, region.size);
+
+        /* Release heap if it no longer has any blocks, but keep at least one resident heap per list */
+        if (region.heap->IsEmpty())
+        {
+            const bool isHeapEvicted = region.heap->IsEvicted();
+            for (auto& heapListsPerType : heaps_)
+            {
+                for (auto& heapList : heapListsPerType)
+                {
+                    if (heapList.size() > 1 || isHeapEvicted)
+                    {
+                        auto it = std::find_if(
+                            heapList.begin(), heapList.end(),
+                            [&region](const std::unique_ptr<D3D12MemoryHeap>& heap)
+                            {
+                                return (heap.get() == region.heap);
+                            }
+                        );
+                        if (it != heapList.end())
+                            heapList.erase(it);
+                    }
+                }
+            }
+        }
+
+        region = D3D12MemoryRegion{};
+    }
+    else if (region.evicted)
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        evictedCommittedSize_[GetHeapTypeIndex(region.heapType)] -= region.size;
+        region = D3D12MemoryRegion{};
+    }
+}
+
+void D3D12MemoryManager::SetResidencyPriority(D3D12MemoryRegion& region, ID3D12Resource* resource, ResidencyPriority priority, D3D12PageableList& outPageables)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    if (region.heap != nullptr)
+    {
+        /* Set priority of the heap only if the highest priority of all its blocks has changed */
+        region.heap->ChangeBlockPriority(region.priority, priority);
+        region.priority = priority;
+
+        const ResidencyPriority heapPriority = region.heap->GetMaxBlockPriority();
+        if (heapPriority != region.heap->GetResidencyPriority())
+        {
+            region.heap->SetResidencyPriority(heapPriority);
+            outPageables.Append(region.heap->GetNative(), heapPriority);
+        }
+    }
+    else
+    {
+        region.priority = priority;
+        outPageables.Append(resource, priority);
+    }
+}
+
+void D3D12MemoryManager::Evict(D3D12MemoryRegion& region, ID3D12Resource* resource, D3D12PageableList& outPageables)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    if (region.evicted)
+        return;
+
+    region.evicted = true;
+
+    if (region.heap != nullptr)
+    {
+        /* Evict heap once all of its blocks have been evicted */
+        region.heap->ChangeBlockEviction(true);
+        if (region.heap->AreAllBlocksEvicted() && !region.heap->IsEvicted())
+        {
+            region.heap->SetEvicted(true);
+            outPageables.Append(region.heap->GetNative());
+        }
+    }
+    else
+    {
+        evictedCommittedSize_[GetHeapTypeIndex(region.heapType)] += region.size;
+        outPageables.Append(resource);
+    }
+}
+
+void D3D12MemoryManager::MakeResident(D3D12MemoryRegion& region, ID3D12Resource* resource, D3D12PageableList& outPageables)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    if (!region.evicted)
+        return;
+
+    region.evicted = false;
+
+    if (region.heap != nullptr)
+    {
+        /* Make heap resident again as soon as any of its blocks is needed */
+        region.heap->ChangeBlockEviction(false);
+        if (region.heap->IsEvicted())
+        {
+            region.heap->SetEvicted(false);
+            outPageables.Append(region.heap->GetNative());
+        }
+    }
+    else
+    {
+        evictedCommittedSize_[GetHeapTypeIndex(region.heapType)] -= region.size;
+        outPageables.Append(resource);
+    }
+}
+
+void D3D12MemoryManager::AccumStatistics(MemoryHeapStatistics& outLocalStats, MemoryHeapStatistics& outNonLocalStats) const
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    for (UINT i = 0; i < g_numHeapTypes; ++i)
+    {
+        /* Default heaps reside in video memory, upload and readback heaps reside in system memory */
+        auto& stats = (i == 0 ? outLocalStats : outNonLocalStats);
+
+        for (const auto& heapList : heaps_[i])
+        {
+            for (const auto& heap : heapList)
+            {
+                stats.allocatedSize += heap->GetSize();
+                stats.usedSize      += heap->GetUsedSize();
+                stats.numBlocks     += heap->GetNumBlocks();
+                stats.numAllocations++;
+                if (heap->IsEvicted())
+                    stats.evictedSize += heap->GetSize();
+            }
+        }
+
+        /* Committed resources are not included in the allocation statistics, but evicting them still frees memory */
+        stats.evictedSize += evictedCommittedSize_[i];
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+UINT D3D12MemoryManager::GetHeapTypeIndex(D3D12_HEAP_TYPE heapType)
+{
+    switch (heapType)
+    {
+        case D3D12_HEAP_TYPE_UPLOAD:    return 1;
+        case D3D12_HEAP_TYPE_READBACK:  return 2;
+        default:                        return 0;
+    }
+}
+
+D3D12MemoryManager::D3D12MemoryHeapList& D3D12MemoryManager::GetHeapList(D3D12_HEAP_TYPE heapType, ResourceCategory category)
+{
+    return heaps_[GetHeapTypeIndex(heapType)][category];
+}
+
+D3D12MemoryHeap* D3D12MemoryManager::Allocate(D3D12_HEAP_TYPE heapType, ResourceCategory category, UINT64 size, UINT64 alignment, UINT64& outOffset)
+{
+    auto& heapList = GetHeapList(heapType, category);
+
+    /* Try to allocate the region in one of the existing heaps that have not been evicted */
+    for (const auto& heap : heapList)
+    {
+        if (!heap->IsEvicted() && heap->Allocate(size, alignment, outOffset))
+            return heap.get();
+    }
+
+    /* Create a new heap */
+    heapList.emplace_back(new D3D12MemoryHeap(device_, heapType, GetHeapFlagsForCategory(category), heapSize_));
+    if (heapList.back()->Allocate(size, alignment, outOffset))
+        return heapList.back().get();
+
+    return nullptr;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
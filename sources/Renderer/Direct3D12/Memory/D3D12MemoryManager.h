@@ -0,0 +1,138 @@
+/*
+ * D3D12MemoryManager.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_MEMORY_MANAGER_H
+#define LLGL_D3D12_MEMORY_MANAGER_H
+
+
+#include "D3D12MemoryHeap.h"
+#include <LLGL/RenderSystemFlags.h>
+#include <vector>
+#include <memory>
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+// Memory region of a placed resource. If 'heap' is null, the resource is a committed resource.
+struct D3D12MemoryRegion
+{
+    D3D12MemoryHeap*    heap        = nullptr;
+    D3D12_HEAP_TYPE     heapType    = D3D12_HEAP_TYPE_DEFAULT;
+    UINT64              offset      = 0;
+    UINT64              size        = 0;
+    ResidencyPriority   priority    = ResidencyPriority::Normal;
+    bool                evicted     = false;
+};
+
+// List of pageable objects whose residency is changed with a single call to ID3D12Device::MakeResident, ID3D12Device::Evict, or ID3D12Device1::SetResidencyPriority.
+struct D3D12PageableList
+{
+    // Appends the specified object or updates its priority if it is already in the list.
+    void Append(ID3D12Pageable* object, ResidencyPriority priority = ResidencyPriority::Normal);
+
+    std::vector<ID3D12Pageable*>    objects;
+    std::vector<ResidencyPriority>  priorities;
+};
+
+/*
+D3D12 memory manager that places buffers and textures into large ID3D12Heap objects instead of creating a committed resource for each of them.
+Heaps are kept in separate lists for each heap type (default, upload, readback) and resource category (buffers, textures, render targets),
+since resource heap tier 1 does not allow different categories within the same heap.
+Resources that are too large for a heap or multi-sampled textures are still created as committed resources.
+*/
+class D3D12MemoryManager
+{
+
+    public:
+
+        D3D12MemoryManager() = default;
+
+        D3D12MemoryManager(const D3D12MemoryManager&) = delete;
+        D3D12MemoryManager& operator = (const D3D12MemoryManager&) = delete;
+
+        // Initializes the device object and the size of each heap.
+        void InitializeDevice(ID3D12Device* device, UINT64 heapSize = 64ull*1024ull*1024ull);
+
+        // Creates a placed resource (or a committed resource as fallback) and returns the memory region it occupies.
+        void CreateResource(
+            D3D12_HEAP_TYPE             heapType,
+            const D3D12_RESOURCE_DESC&  desc,
+            D3D12_RESOURCE_STATES       initialState,
+            const D3D12_CLEAR_VALUE*    optimizedClearValue,
+            ComPtr<ID3D12Resource>&     outResource,
+            D3D12MemoryRegion&          outRegion
+        );
+
+        // Allocates a memory region for the specified number of tiles of a reserved texture (see ID3D12CommandQueue::UpdateTileMappings).
+        void AllocateTiles(UINT numTiles, D3D12MemoryRegion& outRegion);
+
+        // Releases the specified memory region. The resource that was placed in this region must have been released or must no longer be used.
+        void Release(D3D12MemoryRegion& region);
+
+        /*
+        Changes the residency priority of the specified region and appends the objects whose priority must be set to the output list.
+        Placed resources take the highest priority of all blocks in their heap. The committed or placed resource is specified by 'resource'.
+        */
+        void SetResidencyPriority(D3D12MemoryRegion& region, ID3D12Resource* resource, ResidencyPriority priority, D3D12PageableList& outPageables);
+
+        // Marks the specified region as evicted and appends the objects that must be evicted to the output list. Heaps are only evicted once all their blocks are evicted.
+        void Evict(D3D12MemoryRegion& region, ID3D12Resource* resource, D3D12PageableList& outPageables);
+
+        // Marks the specified region as resident and appends the objects that must be made resident to the output list.
+        void MakeResident(D3D12MemoryRegion& region, ID3D12Resource* resource, D3D12PageableList& outPageables);
+
+        // Accumulates the statistics of all heaps into the output heap statistics for video memory (default heaps) and system memory (upload and readback heaps).
+        void AccumStatistics(MemoryHeapStatistics& outLocalStats, MemoryHeapStatistics& outNonLocalStats) const;
+
+    private:
+
+        enum ResourceCategory
+        {
+            ResourceCategory_Buffers = 0,
+            ResourceCategory_Textures,
+            ResourceCategory_RenderTargets,
+
+            ResourceCategory_Num,
+        };
+
+        static const UINT g_numHeapTypes = 3; // D3D12_HEAP_TYPE_DEFAULT, D3D12_HEAP_TYPE_UPLOAD, D3D12_HEAP_TYPE_READBACK
+
+        using D3D12MemoryHeapList = std::vector<std::unique_ptr<D3D12MemoryHeap>>;
+
+    private:
+
+        // Returns the index of the specified heap type into the heap lists.
+        static UINT GetHeapTypeIndex(D3D12_HEAP_TYPE heapType);
+
+        // Returns the list of heaps for the specified heap type and resource category.
+        D3D12MemoryHeapList& GetHeapList(D3D12_HEAP_TYPE heapType, ResourceCategory category);
+
+        // Allocates a region from the heaps of the specified list or creates a new heap.
+        D3D12MemoryHeap* Allocate(D3D12_HEAP_TYPE heapType, ResourceCategory category, UINT64 size, UINT64 alignment, UINT64& outOffset);
+
+    private:
+
+        ID3D12Device*       device_                                     = nullptr;
+        UINT64              heapSize_                                   = 0;
+        D3D12MemoryHeapList heaps_[g_numHeapTypes][ResourceCategory_Num];
+        UINT64              evictedCommittedSize_[g_numHeapTypes]       = {};
+        mutable std::mutex  mutex_;                                     // Guards the heap lists and residency states, so resources can be created from multiple threads.
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -9,6 +9,7 @@
 #include "../D3D12Device.h"
 #include "../Shader/D3D12Shader.h"
 #include "D3D12PipelineLayout.h"
+#include "D3D12PipelineLibrary.h"
 #include "../Command/D3D12CommandContext.h"
 #include "../../CheckedCast.h"
 #include "../../../Core/Assertion.h"
@@ -22,14 +23,39 @@ namespace LLGL
 D3D12ComputePSO::D3D12ComputePSO(
     D3D12Device&                        device,
     D3D12PipelineLayout&                defaultPipelineLayout,
-    const ComputePipelineDescriptor&    desc)
+    const ComputePipelineDescriptor&    desc,
+    D3D12PipelineLibrary*               pipelineLibrary,
+    bool                                isAsync,
+    long                                asyncFlags)
 :
     D3D12PipelineState { /*isGraphicsPSO:*/ false, desc.pipelineLayout, defaultPipelineLayout }
 {
-    if (auto computeShaderD3D = LLGL_CAST(const D3D12Shader*, desc.computeShader))
-        CreateNativePSO(device, computeShaderD3D->GetByteCode());
+    /* Get D3D pipeline layout */
+    const D3D12PipelineLayout* pipelineLayoutD3D = nullptr;
+    if (desc.pipelineLayout != nullptr)
+        pipelineLayoutD3D = LLGL_CAST(const D3D12PipelineLayout*, desc.pipelineLayout);
     else
+        pipelineLayoutD3D = &defaultPipelineLayout;
+
+    auto computeShaderD3D = LLGL_CAST(const D3D12Shader*, desc.computeShader);
+    if (!computeShaderD3D)
         throw std::runtime_error("cannot create D3D compute pipeline without compute shader");
+
+    if (isAsync)
+    {
+        /* Compile PSO on the job system; the shader byte code is owned by the shader, which must outlive the pending PSO */
+        D3D12Device* deviceD3D = &device;
+        const D3D12_SHADER_BYTECODE csBytecode = computeShaderD3D->GetByteCode();
+        StartCompileTask(
+            [this, deviceD3D, csBytecode, pipelineLayoutD3D, pipelineLibrary]()
+            {
+                CreateNativePSO(*deviceD3D, csBytecode, *pipelineLayoutD3D, pipelineLibrary);
+            },
+            asyncFlags
+        );
+    }
+    else
+        CreateNativePSO(device, computeShaderD3D->GetByteCode(), *pipelineLayoutD3D, pipelineLibrary);
 }
 
 void D3D12ComputePSO::Bind(D3D12CommandContext& commandContext)
@@ -39,7 +65,11 @@ void D3D12ComputePSO::Bind(D3D12CommandContext& commandContext)
     commandContext.SetPipelineState(GetNative());
 }
 
-void D3D12ComputePSO::CreateNativePSO(D3D12Device& device, const D3D12_SHADER_BYTECODE& csBytecode)
+void D3D12ComputePSO::CreateNativePSO(
+    D3D12Device&                    device,
+    const D3D12_SHADER_BYTECODE&    csBytecode,
+    const D3D12PipelineLayout&      pipelineLayout,
+    D3D12PipelineLibrary*           pipelineLibrary)
 {
     /* Create graphics pipeline state and graphics command list */
     D3D12_COMPUTE_PIPELINE_STATE_DESC stateDesc = {};
@@ -47,7 +77,10 @@ void D3D12ComputePSO::CreateNativePSO(D3D12Device& device, const D3D12_SHADER_BY
         stateDesc.pRootSignature    = GetRootSignature();
         stateDesc.CS                = csBytecode;
     }
-    SetNative(device.CreateDXComputePipelineState(stateDesc));
+    if (pipelineLibrary != nullptr)
+        SetNative(pipelineLibrary->CreateComputePipelineState(stateDesc, pipelineLayout.GetSerializedBlob()));
+    else
+        SetNative(device.CreateDXComputePipelineState(stateDesc));
 }
 
 
@@ -31,6 +31,16 @@ void D3D12Fence::SetName(const char* name)
     D3D12SetObjectName(native_.Get(), name);
 }
 
+std::uint64_t D3D12Fence::GetValue() const
+{
+    return submittedValue_;
+}
+
+std::uint64_t D3D12Fence::GetCompletedValue() const
+{
+    return native_->GetCompletedValue();
+}
+
 void D3D12Fence::Create(ID3D12Device* device)
 {
     /* Create D3D12 fence */
@@ -88,6 +98,23 @@ bool D3D12Fence::WaitForValueAndUpdate(UINT64& value, DWORD timeoutMillisecs)
     return false;
 }
 
+UINT64 D3D12Fence::SubmitNextValue()
+{
+    submittedValue_ = value_++;
+    return submittedValue_;
+}
+
+bool D3D12Fence::WaitForSubmittedValue(UINT64 timeoutNanosecs)
+{
+    if (native_->GetCompletedValue() < submittedValue_)
+    {
+        auto hr = native_->SetEventOnCompletion(submittedValue_, event_);
+        DXThrowIfFailed(hr, "failed to set 'on completion'-event for D3D12 fence");
+        return (WaitForSingleObjectEx(event_, NanosecsToMillisecs(timeoutNanosecs), FALSE) == WAIT_OBJECT_0);
+    }
+    return true;
+}
+
 
 } // /namespace LLGL
 
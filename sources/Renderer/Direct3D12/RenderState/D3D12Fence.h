@@ -25,6 +25,9 @@ class D3D12Fence final : public Fence
 
         void SetName(const char* name) override;
 
+        std::uint64_t GetValue() const override;
+        std::uint64_t GetCompletedValue() const override;
+
     public:
 
         D3D12Fence() = default;
@@ -43,6 +46,12 @@ class D3D12Fence final : public Fence
         // Waits until the specified value gets signaled and stores the next value.
         bool WaitForValueAndUpdate(UINT64& value, DWORD timeoutMillisecs = INFINITE);
 
+        // Returns the value for the next submission with CommandQueue::Submit(Fence&) and advances the next value.
+        UINT64 SubmitNextValue();
+
+        // Waits until the value of the most recent submission gets signaled. This does not modify the next value.
+        bool WaitForSubmittedValue(UINT64 timeoutNanosecs);
+
         // Returns the native ID3D12Fence object.
         inline ID3D12Fence* GetNative() const
         {
@@ -58,8 +67,9 @@ class D3D12Fence final : public Fence
     private:
 
         ComPtr<ID3D12Fence> native_;
-        HANDLE              event_  = 0;
-        UINT64              value_  = 0;
+        HANDLE              event_          = 0;
+        UINT64              value_          = 0;
+        UINT64              submittedValue_ = 0;
 
 };
 
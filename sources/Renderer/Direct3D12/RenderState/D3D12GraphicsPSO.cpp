@@ -12,6 +12,7 @@
 #include "../Shader/D3D12Shader.h"
 #include "D3D12RenderPass.h"
 #include "D3D12PipelineLayout.h"
+#include "D3D12PipelineLibrary.h"
 #include "../Command/D3D12CommandContext.h"
 #include "../D3DX12/d3dx12.h"
 #include "../D3D12Serialization.h"
@@ -36,13 +37,16 @@ D3D12GraphicsPSO::D3D12GraphicsPSO(
     D3D12PipelineLayout&                defaultPipelineLayout,
     const GraphicsPipelineDescriptor&   desc,
     const D3D12RenderPass*              defaultRenderPass,
-    Serialization::Serializer*          writer)
+    Serialization::Serializer*          writer,
+    D3D12PipelineLibrary*               pipelineLibrary,
+    bool                                isAsync,
+    long                                asyncFlags)
 :
     D3D12PipelineState { /*isGraphicsPSO:*/ true, desc.pipelineLayout, defaultPipelineLayout }
 {
     /* Validate pointers and get D3D shader program */
-    if (desc.vertexShader == nullptr)
-        throw std::invalid_argument("cannot create D3D graphics pipeline without vertex shader");
+    if (desc.vertexShader == nullptr && desc.meshShader == nullptr)
+        throw std::invalid_argument("cannot create D3D graphics pipeline without vertex shader or mesh shader");
 
     /* Use either default render pass or from descriptor */
     const D3D12RenderPass* renderPassD3D = nullptr;
@@ -76,7 +80,20 @@ D3D12GraphicsPSO::D3D12GraphicsPSO(
         pipelineLayoutD3D = &defaultPipelineLayout;
 
     /* Create native graphics PSO */
-    CreateNativePSOFromDesc(device, *pipelineLayoutD3D, renderPassD3D, desc, writer);
+    if (isAsync)
+    {
+        /* Compile PSO on the job system with a copy of the descriptor, since the input descriptor might not outlive this call */
+        D3D12Device* deviceD3D = &device;
+        StartCompileTask(
+            [this, deviceD3D, pipelineLayoutD3D, renderPassD3D, desc, writer, pipelineLibrary]()
+            {
+                CreateNativePSOFromDesc(*deviceD3D, *pipelineLayoutD3D, renderPassD3D, desc, writer, pipelineLibrary);
+            },
+            asyncFlags
+        );
+    }
+    else
+        CreateNativePSOFromDesc(device, *pipelineLayoutD3D, renderPassD3D, desc, writer, pipelineLibrary);
 }
 
 D3D12GraphicsPSO::D3D12GraphicsPSO(D3D12Device& device, Serialization::Deserializer& reader) :
@@ -358,7 +375,8 @@ void D3D12GraphicsPSO::CreateNativePSOFromDesc(
     const D3D12PipelineLayout&          pipelineLayout,
     const D3D12RenderPass*              renderPass,
     const GraphicsPipelineDescriptor&   desc,
-    Serialization::Serializer*          writer)
+    Serialization::Serializer*          writer,
+    D3D12PipelineLibrary*               pipelineLibrary)
 {
     /* Get number of render-target attachments */
     const UINT numAttachments = (renderPass != nullptr ? renderPass->GetNumColorAttachments() : 1);
@@ -393,8 +411,11 @@ void D3D12GraphicsPSO::CreateNativePSOFromDesc(
     Convert(stateDesc.DepthStencilState, desc.depth, desc.stencil);
 
     /* Convert other states */
-    stateDesc.InputLayout           = GetD3DInputLayoutDesc(desc.vertexShader);
-    stateDesc.StreamOutput          = GetD3DStreamOutputDesc(desc.vertexShader, desc.geometryShader);
+    if (desc.vertexShader != nullptr)
+    {
+        stateDesc.InputLayout       = GetD3DInputLayoutDesc(desc.vertexShader);
+        stateDesc.StreamOutput      = GetD3DStreamOutputDesc(desc.vertexShader, desc.geometryShader);
+    }
     stateDesc.IBStripCutValue       = (IsPrimitiveTopologyStrip(desc.primitiveTopology) ? D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_0xFFFFFFFF : D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_DISABLED);
     stateDesc.PrimitiveTopologyType = GetPrimitiveToplogyType(desc.primitiveTopology);
     stateDesc.SampleMask            = desc.blend.sampleMask;
@@ -402,8 +423,18 @@ void D3D12GraphicsPSO::CreateNativePSOFromDesc(
     stateDesc.SampleDesc.Count      = (renderPass != nullptr ? renderPass->GetSampleDesc().Count : 1);
     stateDesc.SampleDesc.Quality    = 0;
 
-    /* Create native PSO */
-    SetNative(device.CreateDXGraphicsPipelineState(stateDesc));
+    /* Mesh shader pipelines are neither stored in the pipeline library nor serialized, since both only support the legacy graphics PSO descriptor */
+    if (desc.meshShader != nullptr)
+    {
+        SetNative(device.CreateDXMeshPipelineState(stateDesc, GetD3DShaderByteCode(desc.taskShader), GetD3DShaderByteCode(desc.meshShader)));
+        return;
+    }
+
+    /* Create native PSO or load it from pipeline library */
+    if (pipelineLibrary != nullptr)
+        SetNative(pipelineLibrary->CreateGraphicsPipelineState(stateDesc, pipelineLayout.GetSerializedBlob()));
+    else
+        SetNative(device.CreateDXGraphicsPipelineState(stateDesc));
 
     /* Serialize graphics PSO */
     if (writer != nullptr)
@@ -20,6 +20,7 @@ namespace LLGL
 class D3D12Device;
 class D3D12RenderPass;
 class D3D12PipelineLayout;
+class D3D12PipelineLibrary;
 class D3D12CommandContext;
 class ByteBufferIterator;
 
@@ -34,7 +35,10 @@ class D3D12GraphicsPSO final : public D3D12PipelineState
             D3D12PipelineLayout&                defaultPipelineLayout,
             const GraphicsPipelineDescriptor&   desc,
             const D3D12RenderPass*              defaultRenderPass,
-            Serialization::Serializer*          writer                  = nullptr
+            Serialization::Serializer*          writer                  = nullptr,
+            D3D12PipelineLibrary*               pipelineLibrary         = nullptr,
+            bool                                isAsync                 = false,
+            long                                asyncFlags              = 0
         );
 
         // Constructs the graphics PSO with a deserializer of a cached PSO.
@@ -59,7 +63,8 @@ class D3D12GraphicsPSO final : public D3D12PipelineState
             const D3D12PipelineLayout&          pipelineLayout,
             const D3D12RenderPass*              renderPass,
             const GraphicsPipelineDescriptor&   desc,
-            Serialization::Serializer*          writer
+            Serialization::Serializer*          writer,
+            D3D12PipelineLibrary*               pipelineLibrary
         );
 
         void CreateNativePSOFromCache(
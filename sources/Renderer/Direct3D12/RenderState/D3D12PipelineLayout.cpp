@@ -7,27 +7,47 @@
 
 #include "D3D12PipelineLayout.h"
 #include "../Shader/D3D12RootSignature.h"
+#include "../Shader/D3D12RootSignatureCache.h"
 #include "../D3DX12/d3dx12.h"
 #include "../D3D12ObjectUtils.h"
 #include "../../DXCommon/DXCore.h"
+#include "../../ResourceUtils.h"
 #include <LLGL/Misc/ForRange.h>
+#include <stdexcept>
+#include <climits>
 
 
 namespace LLGL
 {
 
 
+// Returns true if the specified binding is part of the resource heaps, i.e. it's neither a dynamic binding nor an inline uniform binding.
+static bool IsHeapBinding(const BindingDescriptor& binding)
+{
+    return ((binding.flags & (BindingFlags::DynamicBinding | BindingFlags::InlineUniforms)) == 0);
+}
+
 D3D12PipelineLayout::D3D12PipelineLayout(ID3D12Device* device, const PipelineLayoutDescriptor& desc)
 {
-    /* Convolute all stage flags */
+    /* Convolute all stage flags and count all bindings that are part of the resource heaps */
+    std::size_t numHeapBindings = 0;
     for (const auto& binding : desc.bindings)
+    {
         convolutedStageFlags_ |= binding.stageFlags;
+        if (IsHeapBinding(binding))
+            ++numHeapBindings;
+    }
 
     /* Create root signature */
-    descriptorHandleMap_.resize(desc.bindings.size());
+    descriptorHandleMap_.resize(numHeapBindings);
     CreateRootSignature(device, desc);
 }
 
+D3D12PipelineLayout::~D3D12PipelineLayout()
+{
+    ReleaseRootSignature();
+}
+
 void D3D12PipelineLayout::SetName(const char* name)
 {
     D3D12SetObjectName(rootSignature_.Get(), name);
@@ -57,6 +77,10 @@ static D3D12_ROOT_SIGNATURE_FLAGS GetD3DRootSignatureFlags(long convolutedStageF
         signatureFlags |= D3D12_ROOT_SIGNATURE_FLAG_DENY_GEOMETRY_SHADER_ROOT_ACCESS;
     if ((convolutedStageFlags & StageFlags::FragmentStage) == 0)
         signatureFlags |= D3D12_ROOT_SIGNATURE_FLAG_DENY_PIXEL_SHADER_ROOT_ACCESS;
+    if ((convolutedStageFlags & StageFlags::TaskStage) == 0)
+        signatureFlags |= D3D12_ROOT_SIGNATURE_FLAG_DENY_AMPLIFICATION_SHADER_ROOT_ACCESS;
+    if ((convolutedStageFlags & StageFlags::MeshStage) == 0)
+        signatureFlags |= D3D12_ROOT_SIGNATURE_FLAG_DENY_MESH_SHADER_ROOT_ACCESS;
 
     return signatureFlags;
 }
@@ -72,15 +96,58 @@ void D3D12PipelineLayout::CreateRootSignature(ID3D12Device* device, const Pipeli
     BuildRootParameter(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_SRV,     desc, ResourceType::Texture, BindFlags::Sampled,        descriptorHeapLayout_.numTextureSRV);
     BuildRootParameter(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_UAV,     desc, ResourceType::Buffer,  BindFlags::Storage,        descriptorHeapLayout_.numBufferUAV );
     BuildRootParameter(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_UAV,     desc, ResourceType::Texture, BindFlags::Storage,        descriptorHeapLayout_.numTextureUAV);
+
+    /*
+    Build unbounded descriptor range for bindless binding at the end of its descriptor table,
+    but keep the table of resource views in front of the table of samplers, since that's the order the resource heaps bind their tables in
+    */
+    const bool hasBindlessBinding = HasBindlessBindingOrThrow(desc);
+    const bool isBindlessSampler = (hasBindlessBinding && desc.bindings.back().type == ResourceType::Sampler);
+
+    if (hasBindlessBinding && !isBindlessSampler)
+        BuildRootParameterForBindlessBinding(rootSignature, desc);
+
     BuildRootParameter(rootSignature, D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER, desc, ResourceType::Sampler, 0,                         descriptorHeapLayout_.numSamplers  );
 
-    /* Build final root signature descriptor */
-    rootSignature_ = rootSignature.Finalize(device, GetD3DRootSignatureFlags(GetConvolutedStageFlags()), &serializedBlob_);
+    if (isBindlessSampler)
+        BuildRootParameterForBindlessBinding(rootSignature, desc);
+
+    /* Build root descriptors and root constants after the descriptor tables, so the resource heaps can bind their tables to the first root parameters */
+    BuildRootParametersForDynamicBindings(rootSignature, desc);
+
+    /* Build final root signature descriptor and share native root signature with all identical pipeline layouts */
+    ReleaseRootSignature();
+    serializedBlob_ = rootSignature.Serialize(GetD3DRootSignatureFlags(GetConvolutedStageFlags()));
+    rootSignature_  = D3D12RootSignatureCache::Get().AcquireRootSignature(device, serializedBlob_.Get());
 }
 
 void D3D12PipelineLayout::ReleaseRootSignature()
 {
-    rootSignature_.Reset();
+    if (rootSignature_)
+    {
+        D3D12RootSignatureCache::Get().ReleaseRootSignature(rootSignature_.Get());
+        rootSignature_.Reset();
+    }
+}
+
+static D3D12_ROOT_PARAMETER_TYPE GetD3DRootDescriptorType(long bindFlags)
+{
+    if ((bindFlags & BindFlags::ConstantBuffer) != 0)
+        return D3D12_ROOT_PARAMETER_TYPE_CBV;
+    if ((bindFlags & BindFlags::Storage) != 0)
+        return D3D12_ROOT_PARAMETER_TYPE_UAV;
+    return D3D12_ROOT_PARAMETER_TYPE_SRV;
+}
+
+const D3D12RootParameterBinding* D3D12PipelineLayout::FindDynamicBinding(long bindFlags, UINT slot) const
+{
+    const auto type = GetD3DRootDescriptorType(bindFlags);
+    for (const auto& binding : dynamicBindings_)
+    {
+        if (binding.type == type && binding.slot == slot)
+            return &binding;
+    }
+    return nullptr;
 }
 
 
@@ -96,9 +163,17 @@ void D3D12PipelineLayout::BuildRootParameter(
     long                            bindFlags,
     UINT&                           numResourceViews)
 {
-    for_range(i, layoutDesc.bindings.size())
+    for (std::size_t i = 0, heapBindingIndex = 0; i < layoutDesc.bindings.size(); ++i)
     {
         const auto& binding = layoutDesc.bindings[i];
+        if (!IsHeapBinding(binding))
+            continue;
+
+        /* Dynamic-offset bindings are mapped to root descriptors (see BuildRootParametersForDynamicBindings) and bindless bindings are built last */
+        const auto bindingIndex = heapBindingIndex++;
+        if ((binding.flags & (BindingFlags::DynamicOffset | BindingFlags::Bindless)) != 0)
+            continue;
+
         if (binding.type == resourceType && (bindFlags == 0 || (binding.bindFlags & bindFlags) != 0))
         {
             if (auto rootParam = rootSignature.FindCompatibleRootParameter(descRangeType))
@@ -115,7 +190,7 @@ void D3D12PipelineLayout::BuildRootParameter(
             }
 
             /* Cache binding flags in the same order root parameters are build */
-            auto& mapping = descriptorHandleMap_[i];
+            auto& mapping = descriptorHandleMap_[bindingIndex];
             {
                 if (descRangeType == D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER)
                 {
@@ -127,6 +202,7 @@ void D3D12PipelineLayout::BuildRootParameter(
                     mapping.heap    = 0;
                     mapping.index   = descriptorHeapLayout_.SumResourceViews();
                 }
+                mapping.root = 0;
                 mapping.type = descRangeType;
             }
 
@@ -136,6 +212,205 @@ void D3D12PipelineLayout::BuildRootParameter(
     }
 }
 
+// Returns the descriptor range type for the specified binding with the same mapping as the root parameters in CreateRootSignature.
+static D3D12_DESCRIPTOR_RANGE_TYPE GetD3DDescriptorRangeType(const BindingDescriptor& binding)
+{
+    switch (binding.type)
+    {
+        case ResourceType::Buffer:
+            if ((binding.bindFlags & BindFlags::ConstantBuffer) != 0)
+                return D3D12_DESCRIPTOR_RANGE_TYPE_CBV;
+            if ((binding.bindFlags & BindFlags::Sampled) != 0)
+                return D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+            if ((binding.bindFlags & BindFlags::Storage) != 0)
+                return D3D12_DESCRIPTOR_RANGE_TYPE_UAV;
+            break;
+        case ResourceType::Texture:
+            if ((binding.bindFlags & BindFlags::Sampled) != 0)
+                return D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+            if ((binding.bindFlags & BindFlags::Storage) != 0)
+                return D3D12_DESCRIPTOR_RANGE_TYPE_UAV;
+            break;
+        case ResourceType::Sampler:
+            return D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER;
+        default:
+            break;
+    }
+    throw std::invalid_argument("cannot create D3D12 descriptor range for bindless binding with invalid resource type or binding flags");
+}
+
+void D3D12PipelineLayout::BuildRootParameterForBindlessBinding(D3D12RootSignatureBuilder& rootSignature, const PipelineLayoutDescriptor& layoutDesc)
+{
+    const auto& binding = layoutDesc.bindings.back();
+    const auto descRangeType = GetD3DDescriptorRangeType(binding);
+
+    /* Unbounded descriptor range must be the last range in its descriptor table, so it's appended after all other ranges of the same heap type */
+    auto rootParam = rootSignature.FindCompatibleRootParameter(descRangeType);
+    if (!rootParam)
+    {
+        rootParam = rootSignature.AppendRootParameter();
+        rootParam->InitAsDescriptorTable(1);
+    }
+    rootParam->AppendDescriptorTableRange(descRangeType, binding.slot, UINT_MAX);
+
+    /* Map bindless binding to the first descriptor after all other descriptors of the same heap type; it's always the last heap binding */
+    auto& mapping = descriptorHandleMap_.back();
+    {
+        if (descRangeType == D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER)
+        {
+            mapping.heap    = 1;
+            mapping.index   = descriptorHeapLayout_.SumSamplers();
+        }
+        else
+        {
+            mapping.heap    = 0;
+            mapping.index   = descriptorHeapLayout_.SumResourceViews();
+        }
+        mapping.root = 0;
+        mapping.type = descRangeType;
+    }
+
+    hasBindlessBinding_     = true;
+    maxBindlessDescriptors_ = binding.arraySize;
+}
+
+// Returns the shader visibility for a root parameter. Only a single shader stage can be selected, so all other combinations are visible to all stages.
+static D3D12_SHADER_VISIBILITY GetD3DShaderVisibility(long stageFlags)
+{
+    switch (stageFlags)
+    {
+        case StageFlags::VertexStage:           return D3D12_SHADER_VISIBILITY_VERTEX;
+        case StageFlags::TessControlStage:      return D3D12_SHADER_VISIBILITY_HULL;
+        case StageFlags::TessEvaluationStage:   return D3D12_SHADER_VISIBILITY_DOMAIN;
+        case StageFlags::GeometryStage:         return D3D12_SHADER_VISIBILITY_GEOMETRY;
+        case StageFlags::FragmentStage:         return D3D12_SHADER_VISIBILITY_PIXEL;
+        case StageFlags::TaskStage:             return D3D12_SHADER_VISIBILITY_AMPLIFICATION;
+        case StageFlags::MeshStage:             return D3D12_SHADER_VISIBILITY_MESH;
+        default:                                return D3D12_SHADER_VISIBILITY_ALL;
+    }
+}
+
+static D3D12_DESCRIPTOR_RANGE_TYPE GetD3DDescriptorRangeType(D3D12_ROOT_PARAMETER_TYPE paramType)
+{
+    switch (paramType)
+    {
+        case D3D12_ROOT_PARAMETER_TYPE_CBV: return D3D12_DESCRIPTOR_RANGE_TYPE_CBV;
+        case D3D12_ROOT_PARAMETER_TYPE_UAV: return D3D12_DESCRIPTOR_RANGE_TYPE_UAV;
+        default:                            return D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+    }
+}
+
+// Returns the index of the dynamic offset for the specified binding, i.e. the dynamic offsets are ordered by the binding slots.
+static UINT GetDynamicOffsetIndex(const PipelineLayoutDescriptor& layoutDesc, std::size_t bindingIndex)
+{
+    const auto& binding = layoutDesc.bindings[bindingIndex];
+    UINT index = 0;
+
+    for_range(i, layoutDesc.bindings.size())
+    {
+        const auto& other = layoutDesc.bindings[i];
+        if ((other.flags & BindingFlags::DynamicOffset) != 0)
+        {
+            if (other.slot < binding.slot || (other.slot == binding.slot && i < bindingIndex))
+                ++index;
+        }
+    }
+
+    return index;
+}
+
+void D3D12PipelineLayout::BuildRootParametersForDynamicBindings(D3D12RootSignatureBuilder& rootSignature, const PipelineLayoutDescriptor& layoutDesc)
+{
+    UINT num32BitValues = 0;
+    std::size_t heapBindingIndex = 0;
+
+    for_range(i, layoutDesc.bindings.size())
+    {
+        const auto& binding = layoutDesc.bindings[i];
+        if (IsHeapBinding(binding))
+        {
+            const auto bindingIndex = heapBindingIndex++;
+            if ((binding.flags & BindingFlags::DynamicOffset) != 0)
+            {
+                if (binding.type != ResourceType::Buffer || binding.arraySize != 1)
+                    throw std::invalid_argument("cannot create D3D12 root descriptor for dynamic-offset binding that is not a single buffer");
+
+                /* Create root parameter as root descriptor, whose GPU virtual address is taken from the resource heap */
+                const auto paramType = GetD3DRootDescriptorType(binding.bindFlags);
+
+                auto rootParam = rootSignature.AppendRootParameter();
+                rootParam->InitAsDescriptor(paramType, binding.slot, GetD3DShaderVisibility(binding.stageFlags));
+
+                const auto dynamicOffsetIndex = GetDynamicOffsetIndex(layoutDesc, i);
+                if (dynamicOffsetBindings_.size() <= dynamicOffsetIndex)
+                    dynamicOffsetBindings_.resize(dynamicOffsetIndex + 1);
+
+                auto& mapping = dynamicOffsetBindings_[dynamicOffsetIndex];
+                {
+                    mapping.type            = paramType;
+                    mapping.slot            = binding.slot;
+                    mapping.rootParameter   = rootSignature.GetNumRootParameters() - 1;
+                    mapping.first32BitValue = 0;
+                    mapping.num32BitValues  = 0;
+                }
+
+                /* Map heap binding onto the root descriptor */
+                auto& location = descriptorHandleMap_[bindingIndex];
+                {
+                    location.heap   = 0;
+                    location.root   = 1;
+                    location.index  = dynamicOffsetIndex;
+                    location.type   = GetD3DDescriptorRangeType(paramType);
+                }
+            }
+            continue;
+        }
+
+        if ((binding.flags & BindingFlags::InlineUniforms) != 0)
+        {
+            if (binding.type != ResourceType::Buffer || (binding.bindFlags & BindFlags::ConstantBuffer) == 0)
+                throw std::invalid_argument("cannot create D3D12 root constants for inline uniform binding that is not a constant buffer");
+
+            /* Create root parameter with 32-bit constants; the array size specifies the number of values */
+            auto rootParam = rootSignature.AppendRootParameter();
+            rootParam->InitAsConstants(binding.slot, binding.arraySize, GetD3DShaderVisibility(binding.stageFlags));
+
+            D3D12RootParameterBinding mapping;
+            {
+                mapping.type            = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+                mapping.slot            = binding.slot;
+                mapping.rootParameter   = rootSignature.GetNumRootParameters() - 1;
+                mapping.first32BitValue = num32BitValues;
+                mapping.num32BitValues  = binding.arraySize;
+            }
+            inlineUniforms_.push_back(mapping);
+
+            num32BitValues += binding.arraySize;
+        }
+        else if ((binding.flags & BindingFlags::DynamicBinding) != 0)
+        {
+            if (binding.type != ResourceType::Buffer || binding.arraySize != 1)
+                throw std::invalid_argument("cannot create D3D12 root descriptor for dynamic binding that is not a single buffer");
+
+            /* Create root parameter as root descriptor */
+            const auto paramType = GetD3DRootDescriptorType(binding.bindFlags);
+
+            auto rootParam = rootSignature.AppendRootParameter();
+            rootParam->InitAsDescriptor(paramType, binding.slot, GetD3DShaderVisibility(binding.stageFlags));
+
+            D3D12RootParameterBinding mapping;
+            {
+                mapping.type            = paramType;
+                mapping.slot            = binding.slot;
+                mapping.rootParameter   = rootSignature.GetNumRootParameters() - 1;
+                mapping.first32BitValue = 0;
+                mapping.num32BitValues  = 0;
+            }
+            dynamicBindings_.push_back(mapping);
+        }
+    }
+}
+
 
 } // /namespace LLGL
 
@@ -61,10 +61,21 @@ struct D3D12DescriptorHeapLayout
 struct D3D12DescriptorHandleLocation
 {
     UINT                        heap  :  1; // Descriptor heap index (0 = SBC/SRV/UAV, 1 = Sampler)
-    UINT                        index : 31; // Descriptor index within its descriptor heap
+    UINT                        root  :  1; // Non-zero if this binding is mapped to a root descriptor instead of a descriptor table (see BindingFlags::DynamicOffset)
+    UINT                        index : 30; // Descriptor index within its descriptor heap, or index into the dynamic-offset bindings if 'root' is non-zero
     D3D12_DESCRIPTOR_RANGE_TYPE type;
 };
 
+// Binding to root parameter mapping structure for bindings that are not part of a resource heap, i.e. root descriptors and root constants.
+struct D3D12RootParameterBinding
+{
+    D3D12_ROOT_PARAMETER_TYPE   type;
+    UINT                        slot;               // Shader register
+    UINT                        rootParameter;      // Root parameter index within the root signature
+    UINT                        first32BitValue;    // Uniform location of the first value (only for root constants)
+    UINT                        num32BitValues;     // Number of 32-bit values (only for root constants)
+};
+
 class D3D12PipelineLayout final : public PipelineLayout
 {
 
@@ -78,11 +89,12 @@ class D3D12PipelineLayout final : public PipelineLayout
 
         D3D12PipelineLayout() = default;
         D3D12PipelineLayout(ID3D12Device* device, const PipelineLayoutDescriptor& desc);
+        ~D3D12PipelineLayout();
 
         void CreateRootSignature(ID3D12Device* device, const PipelineLayoutDescriptor& desc);
         void ReleaseRootSignature();
 
-        // Returns the native ID3D12RootSignature object.
+        // Returns the native ID3D12RootSignature object. This object is shared by all pipeline layouts with an identical root signature.
         inline ID3D12RootSignature* GetRootSignature() const
         {
             return rootSignature_.Get();
@@ -118,6 +130,33 @@ class D3D12PipelineLayout final : public PipelineLayout
             return descriptorHandleMap_;
         }
 
+        // Returns the root descriptor for the dynamic binding with the specified binding flags and slot, or null if there is no such binding.
+        const D3D12RootParameterBinding* FindDynamicBinding(long bindFlags, UINT slot) const;
+
+        // Returns the list of root descriptors for all dynamic-offset bindings in the order of their dynamic offsets.
+        inline const SmallVector<D3D12RootParameterBinding>& GetDynamicOffsetBindings() const
+        {
+            return dynamicOffsetBindings_;
+        }
+
+        // Returns true if the last entry in the descriptor handle map is a bindless binding (see BindingFlags::Bindless).
+        inline bool HasBindlessBinding() const
+        {
+            return hasBindlessBinding_;
+        }
+
+        // Returns the maximum number of descriptors of the bindless binding or 0 if there is no bindless binding.
+        inline UINT GetMaxBindlessDescriptors() const
+        {
+            return maxBindlessDescriptors_;
+        }
+
+        // Returns the list of root constants for all inline uniform bindings.
+        inline const SmallVector<D3D12RootParameterBinding>& GetInlineUniforms() const
+        {
+            return inlineUniforms_;
+        }
+
     private:
 
         void BuildRootParameter(
@@ -129,13 +168,22 @@ class D3D12PipelineLayout final : public PipelineLayout
             UINT&                           numResourceViews
         );
 
+        void BuildRootParameterForBindlessBinding(D3D12RootSignatureBuilder& rootSignature, const PipelineLayoutDescriptor& layoutDesc);
+
+        void BuildRootParametersForDynamicBindings(D3D12RootSignatureBuilder& rootSignature, const PipelineLayoutDescriptor& layoutDesc);
+
     private:
 
         ComPtr<ID3D12RootSignature>                 rootSignature_;
         ComPtr<ID3DBlob>                            serializedBlob_;
         D3D12DescriptorHeapLayout                   descriptorHeapLayout_;
         SmallVector<D3D12DescriptorHandleLocation>  descriptorHandleMap_;
+        SmallVector<D3D12RootParameterBinding>      dynamicBindings_;
+        SmallVector<D3D12RootParameterBinding>      dynamicOffsetBindings_;
+        SmallVector<D3D12RootParameterBinding>      inlineUniforms_;
         long                                        convolutedStageFlags_   = 0;
+        bool                                        hasBindlessBinding_     = false;
+        UINT                                        maxBindlessDescriptors_ = 0;
 
 };
 
@@ -0,0 +1,269 @@
+/*
+ * D3D12PipelineLibrary.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12PipelineLibrary.h"
+#include "../D3D12Device.h"
+#include "../D3D12Serialization.h"
+#include "../../DXCommon/DXCore.h"
+#include <cstring>
+#include <cwchar>
+
+
+namespace LLGL
+{
+
+
+/* ----- Hashing ----- */
+
+// FNV-1a hash over sequences of bytes, so the keys remain stable between application runs.
+class PipelineStateHasher
+{
+
+    public:
+
+        void Write(const void* data, std::size_t size)
+        {
+            auto bytes = reinterpret_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                hash_ ^= bytes[i];
+                hash_ *= 0x100000001b3ull;
+            }
+        }
+
+        template <typename T>
+        void WriteValue(const T& value)
+        {
+            Write(&value, sizeof(value));
+        }
+
+        void WriteString(const char* s)
+        {
+            if (s != nullptr)
+                Write(s, std::strlen(s) + 1);
+            else
+                WriteValue('\0');
+        }
+
+        void WriteBytecode(const D3D12_SHADER_BYTECODE& bytecode)
+        {
+            WriteValue(bytecode.BytecodeLength);
+            Write(bytecode.pShaderBytecode, bytecode.BytecodeLength);
+        }
+
+        void WriteBlob(ID3DBlob* blob)
+        {
+            if (blob != nullptr)
+                Write(blob->GetBufferPointer(), blob->GetBufferSize());
+        }
+
+        // Returns the pipeline name for the hash value.
+        void GetName(wchar_t (&name)[32]) const
+        {
+            std::swprintf(name, 32, L"LLGL.PSO.%016llX", static_cast<unsigned long long>(hash_));
+        }
+
+    private:
+
+        std::uint64_t hash_ = 0xcbf29ce484222325ull;
+
+};
+
+static void HashStreamOutput(PipelineStateHasher& hasher, const D3D12_STREAM_OUTPUT_DESC& desc)
+{
+    hasher.WriteValue(desc.NumEntries);
+    for (UINT i = 0; i < desc.NumEntries; ++i)
+    {
+        const auto& entry = desc.pSODeclaration[i];
+        hasher.WriteValue(entry.Stream);
+        hasher.WriteString(entry.SemanticName);
+        hasher.WriteValue(entry.SemanticIndex);
+        hasher.WriteValue(entry.StartComponent);
+        hasher.WriteValue(entry.ComponentCount);
+        hasher.WriteValue(entry.OutputSlot);
+    }
+    hasher.WriteValue(desc.NumStrides);
+    hasher.Write(desc.pBufferStrides, sizeof(UINT) * desc.NumStrides);
+    hasher.WriteValue(desc.RasterizedStream);
+}
+
+static void HashInputLayout(PipelineStateHasher& hasher, const D3D12_INPUT_LAYOUT_DESC& desc)
+{
+    hasher.WriteValue(desc.NumElements);
+    for (UINT i = 0; i < desc.NumElements; ++i)
+    {
+        const auto& element = desc.pInputElementDescs[i];
+        hasher.WriteString(element.SemanticName);
+        hasher.WriteValue(element.SemanticIndex);
+        hasher.WriteValue(element.Format);
+        hasher.WriteValue(element.InputSlot);
+        hasher.WriteValue(element.AlignedByteOffset);
+        hasher.WriteValue(element.InputSlotClass);
+        hasher.WriteValue(element.InstanceDataStepRate);
+    }
+}
+
+static void HashGraphicsPipelineStateDesc(PipelineStateHasher& hasher, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc)
+{
+    hasher.WriteBytecode(desc.VS);
+    hasher.WriteBytecode(desc.PS);
+    hasher.WriteBytecode(desc.DS);
+    hasher.WriteBytecode(desc.HS);
+    hasher.WriteBytecode(desc.GS);
+    HashStreamOutput(hasher, desc.StreamOutput);
+    hasher.WriteValue(desc.BlendState);
+    hasher.WriteValue(desc.SampleMask);
+    hasher.WriteValue(desc.RasterizerState);
+    hasher.WriteValue(desc.DepthStencilState);
+    HashInputLayout(hasher, desc.InputLayout);
+    hasher.WriteValue(desc.IBStripCutValue);
+    hasher.WriteValue(desc.PrimitiveTopologyType);
+    hasher.WriteValue(desc.NumRenderTargets);
+    hasher.WriteValue(desc.RTVFormats);
+    hasher.WriteValue(desc.DSVFormat);
+    hasher.WriteValue(desc.SampleDesc);
+    hasher.WriteValue(desc.NodeMask);
+    hasher.WriteValue(desc.Flags);
+}
+
+
+/* ----- D3D12PipelineLibrary class ----- */
+
+static bool IsPipelineLibraryIncompatible(HRESULT hr)
+{
+    return (hr == D3D12_ERROR_ADAPTER_NOT_FOUND || hr == D3D12_ERROR_DRIVER_VERSION_MISMATCH || hr == E_INVALIDARG);
+}
+
+D3D12PipelineLibrary::D3D12PipelineLibrary(D3D12Device& device, const void* data, std::size_t size) :
+    device_ { device }
+{
+    /* Pipeline libraries require ID3D12Device1 */
+    ComPtr<ID3D12Device1> device1;
+    if (FAILED(device.GetNative()->QueryInterface(IID_PPV_ARGS(&device1))))
+        return;
+
+    /* Keep copy of serialized data, since the library references this memory */
+    if (data != nullptr && size > 0)
+    {
+        auto bytes = reinterpret_cast<const char*>(data);
+        data_.assign(bytes, bytes + size);
+
+        auto hr = device1->CreatePipelineLibrary(data_.data(), data_.size(), IID_PPV_ARGS(native_.ReleaseAndGetAddressOf()));
+        if (SUCCEEDED(hr))
+            return;
+
+        /* Discard libraries from a different adapter or driver version and start with an empty library */
+        if (!IsPipelineLibraryIncompatible(hr))
+            DXThrowIfCreateFailed(hr, "ID3D12PipelineLibrary");
+
+        data_.clear();
+    }
+
+    auto hr = device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(native_.ReleaseAndGetAddressOf()));
+    if (hr == DXGI_ERROR_UNSUPPORTED)
+        native_.Reset();
+    else
+        DXThrowIfCreateFailed(hr, "ID3D12PipelineLibrary");
+}
+
+ComPtr<ID3D12PipelineState> D3D12PipelineLibrary::CreateGraphicsPipelineState(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, ID3DBlob* rootSignatureBlob)
+{
+    if (!native_)
+        return device_.CreateDXGraphicsPipelineState(desc);
+
+    /* Generate pipeline name from pipeline state */
+    PipelineStateHasher hasher;
+    hasher.WriteBlob(rootSignatureBlob);
+    HashGraphicsPipelineStateDesc(hasher, desc);
+
+    wchar_t name[32];
+    hasher.GetName(name);
+
+    /* Try to load PSO from library first */
+    ComPtr<ID3D12PipelineState> pipelineState;
+    auto hr = native_->LoadGraphicsPipeline(name, &desc, IID_PPV_ARGS(pipelineState.ReleaseAndGetAddressOf()));
+    if (SUCCEEDED(hr))
+        return pipelineState;
+
+    /* Create new PSO and store it in library */
+    pipelineState = device_.CreateDXGraphicsPipelineState(desc);
+    if (hr == E_INVALIDARG)
+        StorePipeline(name, pipelineState.Get());
+
+    return pipelineState;
+}
+
+ComPtr<ID3D12PipelineState> D3D12PipelineLibrary::CreateComputePipelineState(const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc, ID3DBlob* rootSignatureBlob)
+{
+    if (!native_)
+        return device_.CreateDXComputePipelineState(desc);
+
+    /* Generate pipeline name from pipeline state */
+    PipelineStateHasher hasher;
+    hasher.WriteBlob(rootSignatureBlob);
+    hasher.WriteBytecode(desc.CS);
+    hasher.WriteValue(desc.NodeMask);
+    hasher.WriteValue(desc.Flags);
+
+    wchar_t name[32];
+    hasher.GetName(name);
+
+    /* Try to load PSO from library first */
+    ComPtr<ID3D12PipelineState> pipelineState;
+    auto hr = native_->LoadComputePipeline(name, &desc, IID_PPV_ARGS(pipelineState.ReleaseAndGetAddressOf()));
+    if (SUCCEEDED(hr))
+        return pipelineState;
+
+    /* Create new PSO and store it in library */
+    pipelineState = device_.CreateDXComputePipelineState(desc);
+    if (hr == E_INVALIDARG)
+        StorePipeline(name, pipelineState.Get());
+
+    return pipelineState;
+}
+
+std::unique_ptr<Blob> D3D12PipelineLibrary::Serialize()
+{
+    if (!native_)
+        return nullptr;
+
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    /* Serialize entire pipeline library */
+    std::vector<char> data(native_->GetSerializedSize());
+    auto hr = native_->Serialize(data.data(), data.size());
+    DXThrowIfFailed(hr, "failed to serialize ID3D12PipelineLibrary");
+
+    Serialization::Serializer writer;
+    writer.WriteSegment(Serialization::D3D12Ident_PipelineLibrary, data.data(), data.size());
+    return writer.Finalize();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void D3D12PipelineLibrary::StorePipeline(const wchar_t* name, ID3D12PipelineState* pipelineState)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    /*
+    LoadGraphicsPipeline/LoadComputePipeline return E_INVALIDARG if the name was not found, but also if the stored PSO has a different descriptor.
+    In the latter case, StorePipeline fails with E_INVALIDARG, too, and the new PSO is only kept outside of the library.
+    */
+    auto hr = native_->StorePipeline(name, pipelineState);
+    if (FAILED(hr) && hr != E_INVALIDARG)
+        DXThrowIfFailed(hr, "failed to store PSO in ID3D12PipelineLibrary");
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,73 @@
+/*
+ * D3D12PipelineLibrary.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_PIPELINE_LIBRARY_H
+#define LLGL_D3D12_PIPELINE_LIBRARY_H
+
+
+#include <LLGL/Blob.h>
+#include "../../DXCommon/ComPtr.h"
+#include <d3d12.h>
+#include <vector>
+#include <memory>
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+class D3D12Device;
+
+/*
+Device-wide wrapper for a native ID3D12PipelineLibrary that is shared between all graphics and compute PSOs.
+PSOs are stored by a name that is generated from a hash of their native pipeline state descriptor and root signature.
+If the device does not support pipeline libraries, all PSOs are created directly with the device.
+*/
+class D3D12PipelineLibrary
+{
+
+    public:
+
+        // Creates the pipeline library with the optional serialized data (without the LLGL serialization header) from a previous run.
+        D3D12PipelineLibrary(D3D12Device& device, const void* data = nullptr, std::size_t size = 0);
+
+        D3D12PipelineLibrary(const D3D12PipelineLibrary&) = delete;
+        D3D12PipelineLibrary& operator = (const D3D12PipelineLibrary&) = delete;
+
+        // Loads the graphics PSO from the library or creates a new one and stores it in the library.
+        ComPtr<ID3D12PipelineState> CreateGraphicsPipelineState(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, ID3DBlob* rootSignatureBlob);
+
+        // Loads the compute PSO from the library or creates a new one and stores it in the library.
+        ComPtr<ID3D12PipelineState> CreateComputePipelineState(const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc, ID3DBlob* rootSignatureBlob);
+
+        // Returns the entire pipeline library as serialized blob (with the D3D12Ident_PipelineLibrary segment), or null if pipeline libraries are not supported.
+        std::unique_ptr<Blob> Serialize();
+
+    private:
+
+        // Stores the specified PSO in the library. PSOs that failed to be loaded due to a mismatching descriptor are not stored again.
+        void StorePipeline(const wchar_t* name, ID3D12PipelineState* pipelineState);
+
+    private:
+
+        D3D12Device&                    device_;
+        ComPtr<ID3D12PipelineLibrary>   native_;
+        std::vector<char>               data_;      // Serialized data must remain valid for the lifetime of the library
+        std::mutex                      mutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
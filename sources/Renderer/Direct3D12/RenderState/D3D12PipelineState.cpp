@@ -29,12 +29,14 @@ D3D12PipelineState::D3D12PipelineState(
     {
         /* Create pipeline state with root signature from pipeline layout */
         auto pipelineLayoutD3D = LLGL_CAST(const D3D12PipelineLayout*, pipelineLayout);
-        rootSignature_ = pipelineLayoutD3D->GetSharedRootSignature();
+        rootSignature_  = pipelineLayoutD3D->GetSharedRootSignature();
+        pipelineLayout_ = pipelineLayoutD3D;
     }
     else
     {
         /* Create pipeline state with default root signature */
-        rootSignature_ = defaultPipelineLayout.GetSharedRootSignature();
+        rootSignature_  = defaultPipelineLayout.GetSharedRootSignature();
+        pipelineLayout_ = &defaultPipelineLayout;
     }
 }
 
@@ -61,6 +63,21 @@ const Report* D3D12PipelineState::GetReport() const
     return (*report_.GetText() != '\0' || report_.HasErrors() ? &report_ : nullptr);
 }
 
+bool D3D12PipelineState::IsReady() const
+{
+    return compileTask_.IsReady();
+}
+
+void D3D12PipelineState::Wait()
+{
+    compileTask_.Wait();
+}
+
+void D3D12PipelineState::StartCompileTask(const std::function<void()>& task, long flags)
+{
+    compileTask_.Start(task, flags);
+}
+
 void D3D12PipelineState::SetNative(ComPtr<ID3D12PipelineState>&& native)
 {
     native_ = std::move(native);
@@ -13,6 +13,7 @@
 #include <LLGL/ForwardDecls.h>
 #include "../../DXCommon/ComPtr.h"
 #include "../../Serialization.h"
+#include "../../PipelineCompileTask.h"
 #include "../../../Core/BasicReport.h"
 #include <d3d12.h>
 #include <memory>
@@ -32,6 +33,8 @@ class D3D12PipelineState : public PipelineState
 
         void SetName(const char* name) override final;
         const Report* GetReport() const override final;
+        bool IsReady() const override final;
+        void Wait() override final;
 
     public:
 
@@ -44,6 +47,18 @@ class D3D12PipelineState : public PipelineState
             return isGraphicsPSO_;
         }
 
+        // Returns the pipeline layout this PSO was created with, or null if it was created from a serialized pipeline cache.
+        inline const D3D12PipelineLayout* GetPipelineLayout() const
+        {
+            return pipelineLayout_;
+        }
+
+        // Returns true if draw or dispatch commands must be skipped while this PSO is still being compiled.
+        inline bool SkipDraws() const
+        {
+            return compileTask_.SkipDraws();
+        }
+
     protected:
 
         D3D12PipelineState(
@@ -61,6 +76,9 @@ class D3D12PipelineState : public PipelineState
         // Stores the native PSO.
         void SetNative(ComPtr<ID3D12PipelineState>&& native);
 
+        // Runs the specified function to create the native PSO on the job system.
+        void StartCompileTask(const std::function<void()>& task, long flags);
+
         // Writes the report with the specified message and error bit.
         void ResetReport(std::string&& text, bool hasErrors = false);
 
@@ -81,7 +99,9 @@ class D3D12PipelineState : public PipelineState
         const bool                  isGraphicsPSO_  = false;
         ComPtr<ID3D12PipelineState> native_;
         ComPtr<ID3D12RootSignature> rootSignature_;
+        const D3D12PipelineLayout*  pipelineLayout_ = nullptr;
         BasicReport                 report_;
+        PipelineCompileTask         compileTask_;   // Must be declared after 'native_' to wait for a pending task before the PSO is destroyed.
 
 };
 
@@ -11,6 +11,7 @@
 #include "../../DXCommon/DXCore.h"
 #include "../D3D12Device.h"
 #include "../D3DX12/d3dx12.h"
+#include "../../QueryUtils.h"
 #include <algorithm>
 #include <cstdint>
 
@@ -40,7 +41,9 @@ ComPtr<ID3D12Resource> DXCreateResultResource(
 D3D12QueryHeap::D3D12QueryHeap(D3D12Device& device, const QueryHeapDescriptor& desc) :
     QueryHeap    { desc.type                           },
     nativeType_  { D3D12Types::MapQueryType(desc.type) },
-    isPredicate_ { desc.renderCondition                }
+    isPredicate_ { desc.renderCondition                },
+    device_      { device.GetNative()                  },
+    numQueries_  { desc.numQueries                     }
 {
     /* Determine buffer stride for each group of queries */
     if (nativeType_ == D3D12_QUERY_TYPE_PIPELINE_STATISTICS)
@@ -165,6 +168,54 @@ UINT64 D3D12QueryHeap::GetAlignedBufferOffest(UINT query) const
     return (alignedStride_ * query);
 }
 
+void D3D12QueryHeap::ResolveToReadbackRing(
+    ID3D12GraphicsCommandList*  commandList,
+    ID3D12Fence*                fence,
+    UINT64                      fenceValue,
+    UINT                        firstQuery,
+    UINT                        numQueries)
+{
+    auto& slot = AcquireReadbackSlot(fence, fenceValue, firstQuery, numQueries);
+    AppendQueryRange(slot.ranges, firstQuery, numQueries);
+    CopyResultsToResource(commandList, firstQuery * queryPerType_, numQueries * queryPerType_, slot.resource.Get());
+}
+
+const std::vector<QueryRange>* D3D12QueryHeap::GetCompletedReadbackRanges() const
+{
+    if (!pendingReadbacks_.empty())
+    {
+        /* Slots are completed in the order they have been resolved, so only the oldest one must be checked */
+        const auto& slot = readbackSlots_[pendingReadbacks_.front()];
+        if (slot.fence->GetCompletedValue() >= slot.fenceValue)
+            return &(slot.ranges);
+    }
+    return nullptr;
+}
+
+void* D3D12QueryHeap::MapCompletedReadback()
+{
+    void* mappedData = nullptr;
+
+    auto& slot = readbackSlots_[pendingReadbacks_.front()];
+    auto hr = slot.resource->Map(0, nullptr, &mappedData);
+    DXThrowIfFailed(hr, "failed to map readback resource of D3D12 query heap");
+
+    return mappedData;
+}
+
+void D3D12QueryHeap::ReleaseCompletedReadback()
+{
+    auto& slot = readbackSlots_[pendingReadbacks_.front()];
+
+    const D3D12_RANGE writtenRange{ 0, 0 };
+    slot.resource->Unmap(0, &writtenRange);
+
+    /* Mark slot as free and remove it from the pending list */
+    slot.fence.Reset();
+    slot.ranges.clear();
+    pendingReadbacks_.erase(pendingReadbacks_.begin());
+}
+
 
 /*
  * ======= Private: =======
@@ -190,11 +241,11 @@ void D3D12QueryHeap::ResolveData(ID3D12GraphicsCommandList* commandList, UINT fi
     if (IsPredicate())
     {
         TransitionResource(commandList, D3D12_RESOURCE_STATE_GENERIC_READ, D3D12_RESOURCE_STATE_COPY_DEST);
-        CopyResultsToResource(commandList, firstQuery, numQueries);
+        CopyResultsToResource(commandList, firstQuery, numQueries, resultResource_.Get());
         TransitionResource(commandList, D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_GENERIC_READ);
     }
     else
-        CopyResultsToResource(commandList, firstQuery, numQueries);
+        CopyResultsToResource(commandList, firstQuery, numQueries, resultResource_.Get());
 }
 
 void D3D12QueryHeap::TransitionResource(
@@ -208,18 +259,57 @@ void D3D12QueryHeap::TransitionResource(
 void D3D12QueryHeap::CopyResultsToResource(
     ID3D12GraphicsCommandList*  commandList,
     UINT                        firstQuery,
-    UINT                        numQueries)
+    UINT                        numQueries,
+    ID3D12Resource*             dstResource)
 {
     commandList->ResolveQueryData(
         native_.Get(),
         nativeType_,
         firstQuery,
         numQueries,
-        resultResource_.Get(),
+        dstResource,
         GetAlignedBufferOffest(firstQuery)
     );
 }
 
+D3D12QueryHeap::ReadbackSlot& D3D12QueryHeap::AcquireReadbackSlot(ID3D12Fence* fence, UINT64 fenceValue, UINT firstQuery, UINT numQueries)
+{
+    if (!pendingReadbacks_.empty())
+    {
+        /* Resolve into the most recent slot if it belongs to the same command list and the range has not been resolved into it yet */
+        auto& lastSlot = readbackSlots_[pendingReadbacks_.back()];
+        if (lastSlot.fence.Get() == fence && lastSlot.fenceValue == fenceValue && !IsQueryRangeOverlapping(lastSlot.ranges, firstQuery, numQueries))
+            return lastSlot;
+    }
+
+    /* Find free slot or create a new one; each slot is large enough to hold the results of the entire heap */
+    std::size_t slotIndex = 0;
+    while (slotIndex < readbackSlots_.size() && !readbackSlots_[slotIndex].ranges.empty())
+        ++slotIndex;
+
+    if (slotIndex == readbackSlots_.size())
+    {
+        ReadbackSlot newSlot;
+        newSlot.resource = DXCreateResultResource(
+            device_,
+            D3D12_HEAP_TYPE_READBACK,
+            numQueries_ * queryPerType_ * alignedStride_,
+            D3D12_RESOURCE_STATE_COPY_DEST
+        );
+        newSlot.resource->SetName(L"LLGL::D3D12QueryHeap::ReadbackResource");
+        readbackSlots_.push_back(std::move(newSlot));
+    }
+
+    auto& slot = readbackSlots_[slotIndex];
+    {
+        slot.fence      = fence;
+        slot.fenceValue = fenceValue;
+    }
+    pendingReadbacks_.push_back(slotIndex);
+
+    return slot;
+}
+
 
 } // /namespace LLGL
 
@@ -12,6 +12,7 @@
 #include <LLGL/QueryHeap.h>
 #include "../../DXCommon/ComPtr.h"
 #include <d3d12.h>
+#include <vector>
 
 
 namespace LLGL
@@ -50,6 +51,33 @@ class D3D12QueryHeap final : public QueryHeap
         // Returns the aligend buffer offset within the result resource for the specified query.
         UINT64 GetAlignedBufferOffest(UINT query) const;
 
+        /*
+        Records a resolve of the specified queries into the readback ring.
+        The readback slot is completed once the specified fence has reached the specified value, i.e. the allocator fence of the recording command context.
+        */
+        void ResolveToReadbackRing(
+            ID3D12GraphicsCommandList*  commandList,
+            ID3D12Fence*                fence,
+            UINT64                      fenceValue,
+            UINT                        firstQuery,
+            UINT                        numQueries
+        );
+
+        // Returns the resolved ranges of the oldest readback slot if it has been completed by the GPU, or null if there is no completed slot.
+        const std::vector<QueryRange>* GetCompletedReadbackRanges() const;
+
+        // Maps the oldest completed readback slot to CPU local memory. Must only be called after GetCompletedReadbackRanges returned a valid pointer.
+        void* MapCompletedReadback();
+
+        // Unmaps the oldest completed readback slot and releases it for subsequent resolves.
+        void ReleaseCompletedReadback();
+
+        // Returns the number of queries in this heap.
+        inline UINT GetNumQueries() const
+        {
+            return numQueries_;
+        }
+
         // Returns the native D3D12_QUERY_TYPE type.
         inline D3D12_QUERY_TYPE GetNativeType() const
         {
@@ -74,6 +102,17 @@ class D3D12QueryHeap final : public QueryHeap
             return isPredicate_;
         }
 
+    private:
+
+        // Readback slot that holds the results of all queries that have been resolved within the same command list.
+        struct ReadbackSlot
+        {
+            ComPtr<ID3D12Resource>  resource;
+            ComPtr<ID3D12Fence>     fence;
+            UINT64                  fenceValue  = 0;
+            std::vector<QueryRange> ranges;             // Resolved ranges; empty if the slot is free
+        };
+
     private:
 
         void InvalidateDirtyRange();
@@ -90,9 +129,13 @@ class D3D12QueryHeap final : public QueryHeap
         void CopyResultsToResource(
             ID3D12GraphicsCommandList*  commandList,
             UINT                        firstQuery,
-            UINT                        numQueries
+            UINT                        numQueries,
+            ID3D12Resource*             dstResource
         );
 
+        // Returns the readback slot the specified range can be resolved into. Creates a new slot if no slot is free.
+        ReadbackSlot& AcquireReadbackSlot(ID3D12Fence* fence, UINT64 fenceValue, UINT firstQuery, UINT numQueries);
+
     private:
 
         D3D12_QUERY_TYPE        nativeType_     = D3D12_QUERY_TYPE_OCCLUSION;
@@ -103,6 +146,11 @@ class D3D12QueryHeap final : public QueryHeap
         bool                    isPredicate_    = false;
         UINT                    dirtyRange_[2]  = {};       // Begin/end range of queries that need to be resolved
 
+        ID3D12Device*               device_             = nullptr;
+        UINT                        numQueries_         = 0;
+        std::vector<ReadbackSlot>   readbackSlots_;
+        std::vector<std::size_t>    pendingReadbacks_;          // Indices of readback slots in the order they have been resolved (oldest first)
+
 };
 
 
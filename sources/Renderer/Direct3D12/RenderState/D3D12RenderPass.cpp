@@ -71,6 +71,17 @@ void D3D12RenderPass::BuildAttachments(
 
     /* Store sample descriptor */
     sampleDesc_ = device.FindSuitableSampleDesc(numColorAttachments_, rtvFormats_, GetClampedSamples(desc.samples));
+
+    /* Store attachment masks of sub-passes; D3D12 can only rebind the output-merger between sub-passes */
+    subpassDepthStencilMask_ = 0;
+    numSubpasses_ = std::min<std::uint32_t>(desc.numSubpasses, LLGL_MAX_NUM_SUBPASSES);
+    for (std::uint32_t i = 0; i < numSubpasses_; ++i)
+    {
+        subpassColorAttachments_[i] = static_cast<std::uint8_t>(desc.subpasses[i].colorAttachments);
+        subpassInputAttachments_[i] = static_cast<std::uint8_t>(desc.subpasses[i].inputAttachments);
+        if (desc.subpasses[i].depthStencilAttachment)
+            subpassDepthStencilMask_ |= static_cast<std::uint8_t>(1u << i);
+    }
 }
 
 void D3D12RenderPass::BuildAttachments(
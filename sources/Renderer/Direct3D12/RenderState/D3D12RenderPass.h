@@ -94,6 +94,30 @@ class D3D12RenderPass final : public RenderPass
             return sampleDesc_;
         }
 
+        // Returns the number of explicit sub-passes of this render pass or 0 if the render pass has a single implicit sub-pass.
+        inline std::uint32_t GetNumSubpasses() const
+        {
+            return numSubpasses_;
+        }
+
+        // Returns the bitmask of color attachments the specified sub-pass writes to.
+        inline std::uint32_t GetSubpassColorAttachments(std::uint32_t subpass) const
+        {
+            return subpassColorAttachments_[subpass];
+        }
+
+        // Returns the bitmask of color attachments the specified sub-pass reads as input attachments.
+        inline std::uint32_t GetSubpassInputAttachments(std::uint32_t subpass) const
+        {
+            return subpassInputAttachments_[subpass];
+        }
+
+        // Returns true if the specified sub-pass uses the depth-stencil attachment.
+        inline bool HasSubpassDepthStencil(std::uint32_t subpass) const
+        {
+            return ((subpassDepthStencilMask_ & (1u << subpass)) != 0);
+        }
+
     private:
 
         void SetDSVFormat(DXGI_FORMAT format);
@@ -111,6 +135,11 @@ class D3D12RenderPass final : public RenderPass
 
         DXGI_SAMPLE_DESC    sampleDesc_                                             = { 1, 0 };
 
+        std::uint32_t       numSubpasses_                                           = 0;
+        std::uint8_t        subpassColorAttachments_[LLGL_MAX_NUM_SUBPASSES]        = {};
+        std::uint8_t        subpassInputAttachments_[LLGL_MAX_NUM_SUBPASSES]        = {};
+        std::uint8_t        subpassDepthStencilMask_                                = 0;
+
 };
 
 
@@ -8,6 +8,8 @@
 #include "D3D12ResourceHeap.h"
 #include "D3D12PipelineLayout.h"
 #include "../D3D12ObjectUtils.h"
+#include "../Command/D3D12CommandContext.h"
+#include "../Command/D3D12DescriptorHeapPool.h"
 #include "../Buffer/D3D12Buffer.h"
 #include "../Texture/D3D12Sampler.h"
 #include "../Texture/D3D12Texture.h"
@@ -21,6 +23,7 @@
 #include <LLGL/Resource.h>
 #include <LLGL/ResourceHeapFlags.h>
 #include <LLGL/Misc/ForRange.h>
+#include <LLGL/Container/SmallVector.h>
 #include <functional>
 #include <algorithm>
 
@@ -40,10 +43,20 @@ D3D12ResourceHeap::D3D12ResourceHeap(
         throw std::invalid_argument("failed to create resource heap due to missing pipeline layout");
 
     /* Get and validate number of bindings and resource views */
-    const auto numBindings      = pipelineLayoutD3D->GetNumBindings();
-    const auto numResourceViews = GetNumResourceViewsOrThrow(numBindings, desc, initialResourceViews);
+    const auto numBindings = pipelineLayoutD3D->GetNumBindings();
 
-    numDescriptorSets_ = numResourceViews / numBindings;
+    if (pipelineLayoutD3D->HasBindlessBinding())
+    {
+        /* Bindless resource heaps have a single descriptor set with a variable number of descriptors for the last binding */
+        hasBindlessBinding_     = true;
+        numBindlessDescriptors_ = GetNumBindlessDescriptorsOrThrow(numBindings - 1, pipelineLayoutD3D->GetMaxBindlessDescriptors(), desc, initialResourceViews);
+        numDescriptorSets_      = 1;
+    }
+    else
+    {
+        const auto numResourceViews = GetNumResourceViewsOrThrow(numBindings, desc, initialResourceViews);
+        numDescriptorSets_ = numResourceViews / numBindings;
+    }
 
     /* Store meta data which pipelines will be used by this resource heap */
     auto convolutedStageFlags = pipelineLayoutD3D->GetConvolutedStageFlags();
@@ -55,15 +68,36 @@ D3D12ResourceHeap::D3D12ResourceHeap(
     const auto descHandleStrideCbvSrvUav = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
     const auto descHandleStrideSampler = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
 
-    const auto& descHeapLayout          = pipelineLayoutD3D->GetDescriptorHeapLayout();
-    const auto numResourceViewHandles   = descHeapLayout.SumResourceViews();
-    const auto numSamplerHandles        = descHeapLayout.SumSamplers();
+    /* Keep copy of root parameter map */
+    descriptorHandleMap_ = pipelineLayoutD3D->GetDescriptorHandleMap();
+
+    /* Bindless descriptors follow all other descriptors of the same heap type */
+    const auto& descHeapLayout  = pipelineLayoutD3D->GetDescriptorHeapLayout();
+    const bool  isBindlessUAV   = (hasBindlessBinding_ && descriptorHandleMap_.back().type == D3D12_DESCRIPTOR_RANGE_TYPE_UAV);
+
+    UINT numResourceViewHandles = descHeapLayout.SumResourceViews();
+    UINT numSamplerHandles      = descHeapLayout.SumSamplers();
+
+    if (hasBindlessBinding_)
+    {
+        if (descriptorHandleMap_.back().heap == 1)
+            numSamplerHandles += numBindlessDescriptors_;
+        else
+            numResourceViewHandles += numBindlessDescriptors_;
+    }
+
+    descriptorHandleStrides_[0] = descHandleStrideCbvSrvUav;
+    descriptorHandleStrides_[1] = descHandleStrideSampler;
 
     descriptorSetStrides_[0] = descHandleStrideCbvSrvUav * numResourceViewHandles;
     descriptorSetStrides_[1] = descHandleStrideSampler * numSamplerHandles;
 
-    /* Keep copy of root parameter map */
-    descriptorHandleMap_ = pipelineLayoutD3D->GetDescriptorHandleMap();
+    numDescriptorsPerSet_[0] = numResourceViewHandles;
+    numDescriptorsPerSet_[1] = numSamplerHandles;
+
+    /* Keep copy of root descriptors for dynamic-offset bindings and allocate their GPU virtual addresses for each descriptor set */
+    rootDescriptorBindings_ = pipelineLayoutD3D->GetDynamicOffsetBindings();
+    rootDescriptorAddresses_.resize(rootDescriptorBindings_.size() * numDescriptorSets_, 0);
 
     /* Create descriptor heaps */
     if (numResourceViewHandles > 0)
@@ -75,7 +109,7 @@ D3D12ResourceHeap::D3D12ResourceHeap(
     if ((desc.barrierFlags & BarrierFlags::Storage) != 0)
     {
         /* Allocate empty heap for ID3D12Resource object that require a UAV barrier */
-        uavResourceSetStride_   = descHeapLayout.SumUAVs();
+        uavResourceSetStride_   = descHeapLayout.SumUAVs() + (isBindlessUAV ? numBindlessDescriptors_ : 0);
         uavResourceIndexOffset_ = descHeapLayout.SumNonUAVs();
         uavResourceHeap_.resize(uavResourceSetStride_ * numDescriptorSets_);
 
@@ -89,6 +123,88 @@ D3D12ResourceHeap::D3D12ResourceHeap(
         CreateResourceViewHandles(device, 0, initialResourceViews);
 }
 
+/*
+Batch of descriptor copies from the CPU-only default views of resources into the descriptor heap of a resource heap.
+Contiguous destination descriptors are merged into a single range, so all copies of one heap type are submitted with a single call to ID3D12Device::CopyDescriptors.
+*/
+struct D3D12DescriptorCopyBatch
+{
+    SmallVector<D3D12_CPU_DESCRIPTOR_HANDLE>    dstRangeStarts;
+    SmallVector<UINT>                           dstRangeSizes;
+    SmallVector<D3D12_CPU_DESCRIPTOR_HANDLE>    srcRangeStarts;
+    SmallVector<UINT>                           srcRangeSizes;
+    UINT                                        numDescriptors  = 0;
+
+    void Append(D3D12_CPU_DESCRIPTOR_HANDLE dstDescHandle, D3D12_CPU_DESCRIPTOR_HANDLE srcDescHandle, UINT descHandleStride);
+    void Submit(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE heapType);
+};
+
+void D3D12DescriptorCopyBatch::Append(D3D12_CPU_DESCRIPTOR_HANDLE dstDescHandle, D3D12_CPU_DESCRIPTOR_HANDLE srcDescHandle, UINT descHandleStride)
+{
+    /* Extend previous destination range if the new descriptor directly follows it */
+    if (!dstRangeStarts.empty() && dstRangeStarts.back().ptr + dstRangeSizes.back() * descHandleStride == dstDescHandle.ptr)
+        ++dstRangeSizes.back();
+    else
+    {
+        dstRangeStarts.push_back(dstDescHandle);
+        dstRangeSizes.push_back(1);
+    }
+
+    /* Extend previous source range if the new descriptor directly follows it */
+    if (!srcRangeStarts.empty() && srcRangeStarts.back().ptr + srcRangeSizes.back() * descHandleStride == srcDescHandle.ptr)
+        ++srcRangeSizes.back();
+    else
+    {
+        srcRangeStarts.push_back(srcDescHandle);
+        srcRangeSizes.push_back(1);
+    }
+
+    ++numDescriptors;
+}
+
+void D3D12DescriptorCopyBatch::Submit(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE heapType)
+{
+    if (numDescriptors > 0)
+    {
+        device->CopyDescriptors(
+            static_cast<UINT>(dstRangeStarts.size()),
+            dstRangeStarts.data(),
+            dstRangeSizes.data(),
+            static_cast<UINT>(srcRangeStarts.size()),
+            srcRangeStarts.data(),
+            srcRangeSizes.data(),
+            heapType
+        );
+    }
+}
+
+// Returns the CPU descriptor handle of the pre-created default view for the specified resource view, or a null handle if a new view must be created.
+static D3D12_CPU_DESCRIPTOR_HANDLE GetDefaultViewDescHandle(D3D12_DESCRIPTOR_RANGE_TYPE type, const ResourceViewDescriptor& desc)
+{
+    auto& resource = *(desc.resource);
+    switch (resource.GetResourceType())
+    {
+        case ResourceType::Buffer:
+            if (!IsBufferViewEnabled(desc.bufferView))
+                return LLGL_CAST(const D3D12Buffer&, resource).GetDefaultViewDescHandle(type);
+            break;
+
+        case ResourceType::Texture:
+            if (!IsTextureViewEnabled(desc.textureView))
+                return LLGL_CAST(const D3D12Texture&, resource).GetDefaultViewDescHandle(type);
+            break;
+
+        case ResourceType::Sampler:
+            if (type == D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER)
+                return LLGL_CAST(const D3D12Sampler&, resource).GetDescHandle();
+            break;
+
+        default:
+            break;
+    }
+    return D3D12_CPU_DESCRIPTOR_HANDLE{};
+}
+
 std::uint32_t D3D12ResourceHeap::CreateResourceViewHandles(
     ID3D12Device*                               device,
     std::uint32_t                               firstDescriptor,
@@ -99,7 +215,7 @@ std::uint32_t D3D12ResourceHeap::CreateResourceViewHandles(
         return 0;
 
     const auto numBindings      = static_cast<std::uint32_t>(descriptorHandleMap_.size());
-    const auto numDescriptors   = numDescriptorSets_ * numBindings;
+    const auto numDescriptors   = (hasBindlessBinding_ ? numBindings - 1 + numBindlessDescriptors_ : numDescriptorSets_ * numBindings);
 
     /* Silently quit on out of bounds; debug layer must report these errors */
     if (firstDescriptor >= numDescriptors)
@@ -111,14 +227,15 @@ std::uint32_t D3D12ResourceHeap::CreateResourceViewHandles(
     D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle = {};
     D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandles[2] = {};
 
-    if (descriptorHeaps_[0] != 0)
-        cpuDescHandles[0] = descriptorHeaps_[0]->GetCPUDescriptorHandleForHeapStart();
-    if (descriptorHeaps_[1] != 0)
-        cpuDescHandles[1] = descriptorHeaps_[1]->GetCPUDescriptorHandleForHeapStart();
+    if (descriptorHeapResourceViews_)
+        cpuDescHandles[0] = descriptorHeapResourceViews_->GetCPUDescriptorHandleForHeapStart();
+    if (descriptorHeapSamplers_)
+        cpuDescHandles[1] = descriptorHeapSamplers_->GetCPUDescriptorHandleForHeapStart();
 
     /* Write each resource view into respective descriptor heap */
     std::uint32_t numWritten = 0;
     std::uint32_t uavChangeSetRange[2] = {};
+    D3D12DescriptorCopyBatch copyBatches[2];
 
     for (const auto& desc : resourceViews)
     {
@@ -127,13 +244,34 @@ std::uint32_t D3D12ResourceHeap::CreateResourceViewHandles(
             continue;
 
         /* Get CPU descriptor handle address for current root parameter */
-        const auto  descriptorSet       = firstDescriptor / numBindings;
-        const auto& descriptorHandle    = descriptorHandleMap_[firstDescriptor % numBindings];
+        std::uint32_t descriptorSet = 0;
+        const auto  descriptorHandle    = GetDescriptorHandleLocation(firstDescriptor, descriptorSet);
         const auto  handleOffset        = descriptorHandleStrides_[descriptorHandle.heap] * descriptorHandle.index;
-        const auto  setOffset           = descriptorSetStrides_[descriptorHandle.heap] * (firstDescriptor / numBindings);
+        const auto  setOffset           = descriptorSetStrides_[descriptorHandle.heap] * descriptorSet;
+
+        /* Store GPU virtual address for root descriptors instead of writing a descriptor into the descriptor heap */
+        if (descriptorHandle.root != 0)
+        {
+            if (StoreRootDescriptorAddress(descriptorSet, descriptorHandle.index, desc))
+                ++numWritten;
+            ++firstDescriptor;
+            continue;
+        }
 
         cpuDescHandle.ptr = cpuDescHandles[descriptorHandle.heap].ptr + handleOffset + setOffset;
 
+        /* Copy default view of the resource in a batch if it doesn't require a new view */
+        const auto defaultDescHandle = GetDefaultViewDescHandle(descriptorHandle.type, desc);
+        if (defaultDescHandle.ptr != 0)
+        {
+            copyBatches[descriptorHandle.heap].Append(cpuDescHandle, defaultDescHandle, descriptorHandleStrides_[descriptorHandle.heap]);
+            ++numWritten;
+            if (descriptorHandle.type != D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER)
+                ExchangeUAVResource(descriptorHandle, descriptorSet, *(desc.resource), uavChangeSetRange);
+            ++firstDescriptor;
+            continue;
+        }
+
         /* Write current resource view to descriptor heap */
         switch (descriptorHandle.type)
         {
@@ -171,6 +309,10 @@ std::uint32_t D3D12ResourceHeap::CreateResourceViewHandles(
         ++firstDescriptor;
     }
 
+    /* Copy all batched default views with a single call per descriptor heap type */
+    copyBatches[0].Submit(device, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    copyBatches[1].Submit(device, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
+
     /* Update resource barriers for all affected descriptor sets if any of the UAV resource entries have changed */
     for_subrange(i, uavChangeSetRange[0], uavChangeSetRange[1])
         UpdateBarriers(i);
@@ -178,30 +320,101 @@ std::uint32_t D3D12ResourceHeap::CreateResourceViewHandles(
     return numWritten;
 }
 
-void D3D12ResourceHeap::SetGraphicsRootDescriptorTables(ID3D12GraphicsCommandList* commandList, std::uint32_t descriptorSet)
+void D3D12ResourceHeap::CopyDescriptorSet(
+    D3D12CommandContext&        commandContext,
+    std::uint32_t               descriptorSet,
+    D3D12_GPU_DESCRIPTOR_HANDLE (&outGpuDescHandles)[2])
+{
+    for_range(i, numDescriptorHeaps_)
+    {
+        /* Copy descriptors of the specified set from the CPU-only heap into the shader-visible heap of the same type */
+        const auto heapType = descriptorHeapTypes_[i];
+
+        D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle = descriptorHeaps_[i]->GetCPUDescriptorHandleForHeapStart();
+        cpuDescHandle.ptr += descriptorSetStrides_[heapType] * descriptorSet;
+
+        outGpuDescHandles[i] = commandContext.CopyDescriptorsShaderVisible(heapType, cpuDescHandle, numDescriptorsPerSet_[heapType]);
+    }
+}
+
+void D3D12ResourceHeap::SetGraphicsRootDescriptorTables(ID3D12GraphicsCommandList* commandList, const D3D12_GPU_DESCRIPTOR_HANDLE (&gpuDescHandles)[2])
 {
     if (hasGraphicsDescriptors_)
     {
         /* Bind root descriptor tables to graphics pipeline */
         for_range(i, numDescriptorHeaps_)
-        {
-            D3D12_GPU_DESCRIPTOR_HANDLE gpuDescHandle = descriptorHeaps_[i]->GetGPUDescriptorHandleForHeapStart();
-            gpuDescHandle.ptr += descriptorSetStrides_[i] * descriptorSet;
-            commandList->SetGraphicsRootDescriptorTable(i, gpuDescHandle);
-        }
+            commandList->SetGraphicsRootDescriptorTable(i, gpuDescHandles[i]);
     }
 }
 
-void D3D12ResourceHeap::SetComputeRootDescriptorTables(ID3D12GraphicsCommandList* commandList, std::uint32_t descriptorSet)
+void D3D12ResourceHeap::SetComputeRootDescriptorTables(ID3D12GraphicsCommandList* commandList, const D3D12_GPU_DESCRIPTOR_HANDLE (&gpuDescHandles)[2])
 {
     if (hasComputeDescriptors_)
     {
         /* Bind root descriptor tables to compute pipeline */
         for_range(i, numDescriptorHeaps_)
+            commandList->SetComputeRootDescriptorTable(i, gpuDescHandles[i]);
+    }
+}
+
+void D3D12ResourceHeap::SetGraphicsRootDescriptors(
+    ID3D12GraphicsCommandList*  commandList,
+    std::uint32_t               descriptorSet,
+    std::uint32_t               numDynamicOffsets,
+    const std::uint32_t*        dynamicOffsets)
+{
+    if (hasGraphicsDescriptors_ && descriptorSet < numDescriptorSets_)
+    {
+        /* Bind root descriptors to graphics pipeline */
+        for_range(i, rootDescriptorBindings_.size())
+        {
+            const auto& binding = rootDescriptorBindings_[i];
+            const auto gpuVirtualAddress = GetRootDescriptorAddress(descriptorSet, i, numDynamicOffsets, dynamicOffsets);
+            switch (binding.type)
+            {
+                case D3D12_ROOT_PARAMETER_TYPE_CBV:
+                    commandList->SetGraphicsRootConstantBufferView(binding.rootParameter, gpuVirtualAddress);
+                    break;
+                case D3D12_ROOT_PARAMETER_TYPE_SRV:
+                    commandList->SetGraphicsRootShaderResourceView(binding.rootParameter, gpuVirtualAddress);
+                    break;
+                case D3D12_ROOT_PARAMETER_TYPE_UAV:
+                    commandList->SetGraphicsRootUnorderedAccessView(binding.rootParameter, gpuVirtualAddress);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+}
+
+void D3D12ResourceHeap::SetComputeRootDescriptors(
+    ID3D12GraphicsCommandList*  commandList,
+    std::uint32_t               descriptorSet,
+    std::uint32_t               numDynamicOffsets,
+    const std::uint32_t*        dynamicOffsets)
+{
+    if (hasComputeDescriptors_ && descriptorSet < numDescriptorSets_)
+    {
+        /* Bind root descriptors to compute pipeline */
+        for_range(i, rootDescriptorBindings_.size())
         {
-            D3D12_GPU_DESCRIPTOR_HANDLE gpuDescHandle = descriptorHeaps_[i]->GetGPUDescriptorHandleForHeapStart();
-            gpuDescHandle.ptr += descriptorSetStrides_[i] * descriptorSet;
-            commandList->SetComputeRootDescriptorTable(i, gpuDescHandle);
+            const auto& binding = rootDescriptorBindings_[i];
+            const auto gpuVirtualAddress = GetRootDescriptorAddress(descriptorSet, i, numDynamicOffsets, dynamicOffsets);
+            switch (binding.type)
+            {
+                case D3D12_ROOT_PARAMETER_TYPE_CBV:
+                    commandList->SetComputeRootConstantBufferView(binding.rootParameter, gpuVirtualAddress);
+                    break;
+                case D3D12_ROOT_PARAMETER_TYPE_SRV:
+                    commandList->SetComputeRootShaderResourceView(binding.rootParameter, gpuVirtualAddress);
+                    break;
+                case D3D12_ROOT_PARAMETER_TYPE_UAV:
+                    commandList->SetComputeRootUnorderedAccessView(binding.rootParameter, gpuVirtualAddress);
+                    break;
+                default:
+                    break;
+            }
         }
     }
 }
@@ -236,6 +449,24 @@ std::uint32_t D3D12ResourceHeap::GetNumDescriptorSets() const
  * ======= Private: =======
  */
 
+D3D12DescriptorHandleLocation D3D12ResourceHeap::GetDescriptorHandleLocation(std::uint32_t descriptor, std::uint32_t& outDescriptorSet) const
+{
+    const auto numBindings = static_cast<std::uint32_t>(descriptorHandleMap_.size());
+    if (hasBindlessBinding_ && descriptor + 1 >= numBindings)
+    {
+        /* Bindless descriptors are stored consecutively in the only descriptor set */
+        auto location = descriptorHandleMap_.back();
+        location.index += descriptor - (numBindings - 1);
+        outDescriptorSet = 0;
+        return location;
+    }
+    else
+    {
+        outDescriptorSet = descriptor / numBindings;
+        return descriptorHandleMap_[descriptor % numBindings];
+    }
+}
+
 static void ErrNullPointerInResource()
 {
     throw std::invalid_argument("cannot create resource heap with null pointer in resource view");
@@ -257,32 +488,30 @@ void D3D12ResourceHeap::CreateDescriptorHeap(
     UINT                            numDescriptors,
     ComPtr<ID3D12DescriptorHeap>&   outDescritporHeap)
 {
-    /* Create descriptor heap for resource views or samplers */
+    /* Create CPU-only descriptor heap for resource views or samplers; they are copied into a shader-visible heap when bound */
     D3D12_DESCRIPTOR_HEAP_DESC heapDesc;
     {
         heapDesc.Type           = heapType;
         heapDesc.NumDescriptors = numDescriptors;
-        heapDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+        heapDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
         heapDesc.NodeMask       = 0;
     }
     auto hr = device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(outDescritporHeap.ReleaseAndGetAddressOf()));
     DXThrowIfCreateFailed(hr, GetContextInfoForFailedDescriptorHeap(heapType));
 
     /* Store in array for quick access */
-    AppendDescriptorHeapToArray(outDescritporHeap.Get());
+    AppendDescriptorHeapToArray(
+        outDescritporHeap.Get(),
+        (heapType == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER ? D3D12DescriptorHeapPool::g_heapSamplers : D3D12DescriptorHeapPool::g_heapResourceViews)
+    );
 }
 
-void D3D12ResourceHeap::AppendDescriptorHeapToArray(ID3D12DescriptorHeap* descriptorHeap)
+void D3D12ResourceHeap::AppendDescriptorHeapToArray(ID3D12DescriptorHeap* descriptorHeap, UINT heapType)
 {
-    /* Get device and type from descriptor heap */
-    ComPtr<ID3D12Device> device;
-    descriptorHeap->GetDevice(IID_PPV_ARGS(&device));
-    D3D12_DESCRIPTOR_HEAP_TYPE heapType = descriptorHeap->GetDesc().Type;
-
-    /* Append descriptor heap and handle stride to arrays */
+    /* Append descriptor heap and its type to arrays */
     LLGL_ASSERT(numDescriptorHeaps_ < 2);
     descriptorHeaps_[numDescriptorHeaps_] = descriptorHeap;
-    descriptorHandleStrides_[numDescriptorHeaps_] = device->GetDescriptorHandleIncrementSize(heapType);
+    descriptorHeapTypes_[numDescriptorHeaps_] = heapType;
     ++numDescriptorHeaps_;
 }
 
@@ -386,6 +615,37 @@ bool D3D12ResourceHeap::CreateSampler(ID3D12Device* device, D3D12_CPU_DESCRIPTOR
     return false;
 }
 
+bool D3D12ResourceHeap::StoreRootDescriptorAddress(std::uint32_t descriptorSet, UINT rootDescriptorIndex, const ResourceViewDescriptor& desc)
+{
+    /* Get GPU virtual address of D3D buffer resource */
+    auto& resource = *(desc.resource);
+    if (resource.GetResourceType() == ResourceType::Buffer)
+    {
+        auto& bufferD3D = LLGL_CAST(D3D12Buffer&, resource);
+        auto gpuVirtualAddress = bufferD3D.GetNative()->GetGPUVirtualAddress();
+
+        /* Offset of buffer view is ignored for the whole buffer size; the dynamic offset is added when the resource heap is bound */
+        if (desc.bufferView.size != Constants::wholeSize)
+            gpuVirtualAddress += desc.bufferView.offset;
+
+        rootDescriptorAddresses_[descriptorSet * rootDescriptorBindings_.size() + rootDescriptorIndex] = gpuVirtualAddress;
+        return true;
+    }
+    return false;
+}
+
+D3D12_GPU_VIRTUAL_ADDRESS D3D12ResourceHeap::GetRootDescriptorAddress(
+    std::uint32_t           descriptorSet,
+    std::size_t             rootDescriptorIndex,
+    std::uint32_t           numDynamicOffsets,
+    const std::uint32_t*    dynamicOffsets) const
+{
+    auto gpuVirtualAddress = rootDescriptorAddresses_[descriptorSet * rootDescriptorBindings_.size() + rootDescriptorIndex];
+    if (rootDescriptorIndex < numDynamicOffsets && dynamicOffsets != nullptr)
+        gpuVirtualAddress += dynamicOffsets[rootDescriptorIndex];
+    return gpuVirtualAddress;
+}
+
 static bool IsUAVResourceBarrierRequired(long bindFlags)
 {
     return ((bindFlags & BindFlags::Storage) != 0);
@@ -430,7 +690,7 @@ void D3D12ResourceHeap::EmplaceD3DUAVResource(
     ID3D12Resource*                         resource,
     std::uint32_t                           (&setRange)[2])
 {
-    if (descriptorHandle.index >= uavResourceIndexOffset_)
+    if (descriptorHandle.type == D3D12_DESCRIPTOR_RANGE_TYPE_UAV && descriptorHandle.index >= uavResourceIndexOffset_)
     {
         auto& cached = uavResourceHeap_[descriptorSet * uavResourceSetStride_ + descriptorHandle.index - uavResourceIndexOffset_];
         if (cached != resource)
@@ -24,7 +24,12 @@ namespace LLGL
 
 
 struct ResourceHeapDescriptor;
+class D3D12CommandContext;
 
+/*
+Resource heap with CPU-only descriptor heaps. The descriptors of a descriptor set are copied into the
+shader-visible descriptor heaps of the command context when the resource heap is bound (see D3D12DescriptorHeapPool).
+*/
 class D3D12ResourceHeap final : public ResourceHeap
 {
 
@@ -42,31 +47,42 @@ class D3D12ResourceHeap final : public ResourceHeap
             const ArrayView<ResourceViewDescriptor>&    initialResourceViews = {}
         );
 
-        // Creates resource view handles (SRV/UAV/CBV/Sampler) for the specified resource views in the D3D12 descriptor heaps.
+        /*
+        Creates resource view handles (SRV/UAV/CBV/Sampler) for the specified resource views in the D3D12 descriptor heaps.
+        Default views are copied from the pre-created descriptors of their resources with a single CopyDescriptors call per heap type;
+        only resource views with a custom buffer or texture view create new descriptors.
+        */
         std::uint32_t CreateResourceViewHandles(
             ID3D12Device*                               device,
             std::uint32_t                               firstDescriptor,
             const ArrayView<ResourceViewDescriptor>&    resourceViews
         );
 
-        void SetGraphicsRootDescriptorTables(ID3D12GraphicsCommandList* commandList, std::uint32_t descriptorSet);
-        void SetComputeRootDescriptorTables(ID3D12GraphicsCommandList* commandList, std::uint32_t descriptorSet);
+        // Copies the descriptors of the specified descriptor set into the shader-visible descriptor heaps of the command context and returns their GPU descriptor handles.
+        void CopyDescriptorSet(D3D12CommandContext& commandContext, std::uint32_t descriptorSet, D3D12_GPU_DESCRIPTOR_HANDLE (&outGpuDescHandles)[2]);
+
+        void SetGraphicsRootDescriptorTables(ID3D12GraphicsCommandList* commandList, const D3D12_GPU_DESCRIPTOR_HANDLE (&gpuDescHandles)[2]);
+        void SetComputeRootDescriptorTables(ID3D12GraphicsCommandList* commandList, const D3D12_GPU_DESCRIPTOR_HANDLE (&gpuDescHandles)[2]);
+
+        // Sets the root descriptors of all dynamic-offset bindings and adds the specified dynamic offsets to their GPU virtual addresses.
+        void SetGraphicsRootDescriptors(ID3D12GraphicsCommandList* commandList, std::uint32_t descriptorSet, std::uint32_t numDynamicOffsets, const std::uint32_t* dynamicOffsets);
+        void SetComputeRootDescriptors(ID3D12GraphicsCommandList* commandList, std::uint32_t descriptorSet, std::uint32_t numDynamicOffsets, const std::uint32_t* dynamicOffsets);
 
         // Inserts the resource barriers for the specified descritpor set into the command list.
         void InsertResourceBarriers(ID3D12GraphicsCommandList* commandList, std::uint32_t descriptorSet);
 
-        // Returns the array of D3D descriptor heaps.
-        inline ID3D12DescriptorHeap* const* GetDescriptorHeaps() const
-        {
-            return descriptorHeaps_;
-        }
-
         // Returns the number of D3D descriptor heap (either 1 or 2).
         inline UINT GetNumDescriptorHeaps() const
         {
             return numDescriptorHeaps_;
         }
 
+        // Returns true if this resource heap has any dynamic-offset bindings, which are bound as root descriptors.
+        inline bool HasRootDescriptors() const
+        {
+            return !rootDescriptorBindings_.empty();
+        }
+
     private:
 
         struct BindingHandleLocation
@@ -77,6 +93,9 @@ class D3D12ResourceHeap final : public ResourceHeap
 
     private:
 
+        // Returns the descriptor handle location of the specified descriptor and its descriptor set.
+        D3D12DescriptorHandleLocation GetDescriptorHandleLocation(std::uint32_t descriptor, std::uint32_t& outDescriptorSet) const;
+
         void CreateDescriptorHeap(
             ID3D12Device*                   device,
             D3D12_DESCRIPTOR_HEAP_TYPE      heapType,
@@ -84,13 +103,24 @@ class D3D12ResourceHeap final : public ResourceHeap
             ComPtr<ID3D12DescriptorHeap>&   outDescritporHeap
         );
 
-        void AppendDescriptorHeapToArray(ID3D12DescriptorHeap* descriptorHeap);
+        void AppendDescriptorHeapToArray(ID3D12DescriptorHeap* descriptorHeap, UINT heapType);
 
         bool CreateShaderResourceView(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle, const ResourceViewDescriptor& desc);
         bool CreateUnorderedAccessView(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle, const ResourceViewDescriptor& desc);
         bool CreateConstantBufferView(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle, const ResourceViewDescriptor& desc);
         bool CreateSampler(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle, const ResourceViewDescriptor& desc);
 
+        // Stores the GPU virtual address of the specified buffer view for the root descriptor of a dynamic-offset binding.
+        bool StoreRootDescriptorAddress(std::uint32_t descriptorSet, UINT rootDescriptorIndex, const ResourceViewDescriptor& desc);
+
+        // Returns the GPU virtual address of the specified root descriptor with its dynamic offset.
+        D3D12_GPU_VIRTUAL_ADDRESS GetRootDescriptorAddress(
+            std::uint32_t           descriptorSet,
+            std::size_t             rootDescriptorIndex,
+            std::uint32_t           numDynamicOffsets,
+            const std::uint32_t*    dynamicOffsets
+        ) const;
+
         void ExchangeUAVResource(
             const D3D12DescriptorHandleLocation&    descriptorHandle,
             std::uint32_t                           descriptorSet,
@@ -117,14 +147,19 @@ class D3D12ResourceHeap final : public ResourceHeap
         ComPtr<ID3D12DescriptorHeap>                descriptorHeapResourceViews_;
         ComPtr<ID3D12DescriptorHeap>                descriptorHeapSamplers_;
 
-        ID3D12DescriptorHeap*                       descriptorHeaps_[2]         = {};   // References to the ComPtr objects
-        UINT                                        descriptorHandleStrides_[2] = {};
-        UINT                                        descriptorSetStrides_[2]    = {};
+        ID3D12DescriptorHeap*                       descriptorHeaps_[2]         = {};   // References to the ComPtr objects in the order of root parameters
+        UINT                                        descriptorHeapTypes_[2]     = {};   // Heap type of each entry in 'descriptorHeaps_' (0 = CBV/SRV/UAV, 1 = Sampler)
+        UINT                                        descriptorHandleStrides_[2] = {};   // Indexed by heap type
+        UINT                                        descriptorSetStrides_[2]    = {};   // Indexed by heap type
+        UINT                                        numDescriptorsPerSet_[2]    = {};   // Indexed by heap type
         UINT                                        numDescriptorHeaps_         = 0;    // Sizes of descriptor heaps array
         UINT                                        numDescriptorSets_          = 0;    // Only used for 'GetNumDescriptorSets'
 
         SmallVector<D3D12DescriptorHandleLocation>  descriptorHandleMap_;
 
+        SmallVector<D3D12RootParameterBinding>      rootDescriptorBindings_;            // Root descriptors for all dynamic-offset bindings
+        std::vector<D3D12_GPU_VIRTUAL_ADDRESS>      rootDescriptorAddresses_;           // GPU virtual addresses of all root descriptors for each descriptor set
+
         std::vector<ID3D12Resource*>                uavResourceHeap_;                   // Heap of UAV resources that require a barrier
         UINT                                        uavResourceSetStride_       = 0;    // Number of (potential) UAV resources per descriptor set
         UINT                                        uavResourceIndexOffset_     = 0;    // Subtracted offset for 'D3D12DescriptorHandleLocation::index'
@@ -134,6 +169,9 @@ class D3D12ResourceHeap final : public ResourceHeap
         bool                                        hasGraphicsDescriptors_     = false;
         bool                                        hasComputeDescriptors_      = false;
 
+        bool                                        hasBindlessBinding_         = false;
+        UINT                                        numBindlessDescriptors_     = 0;    // Number of descriptors of the bindless binding after all other descriptors of its heap type
+
 };
 
 
@@ -40,6 +40,8 @@
 #define LLGL_IDR_GENERATEMIPS3D_CS_SRGB_ODDYZ   1227
 #define LLGL_IDR_GENERATEMIPS3D_CS_SRGB_ODDXYZ  1228
 
+#define LLGL_IDR_GENERATEMIPSSPD_HLSL           1229
+
 
 #endif
 
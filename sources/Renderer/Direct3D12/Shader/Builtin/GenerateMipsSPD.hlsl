@@ -0,0 +1,249 @@
+/*
+ * GenerateMipsSPD.hlsl
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+/*
+Single-pass downsampler (SPD) for power-of-two 2D textures in the style of AMD FidelityFX SPD.
+Each work group downsamples a 64x64 tile of the source MIP-map level into the next 6 MIP-map levels.
+The last work group of each array layer, determined by a global atomic counter,
+downsamples the 6th MIP-map level (at most 64x64 texels) into the next 6 MIP-map levels.
+This shader requires shader model 5.1 and typed UAV loads for the 6th MIP-map level.
+It is embedded as source and compiled at runtime by the D3D12MipGenerator.
+*/
+
+
+#define SPD_NUM_THREADS     (256)
+#define SPD_SHARED_PITCH    (32)
+
+
+/* Current MIP-map level configuration */
+cbuffer SPDDescriptor : register(b0)
+{
+    float2  texelSize;      // 1.0 / srcMipLevel.extent
+    uint    baseMipLevel;   // Base MIP-map level of srcMipLevel
+    uint    numMipLevels;   // Number of MIP-map levels to write: [1..12]
+    uint    baseArrayLayer; // Base array layer of srcMipLevel
+    uint    numWorkGroups;  // Number of work groups per array layer
+};
+
+
+/* Next 12 output MIP-map levels, atomic counters per array layer, and source MIP-map level */
+RWTexture2DArray<float4>                    dstMipLevel1        : register(u0);
+RWTexture2DArray<float4>                    dstMipLevel2        : register(u1);
+RWTexture2DArray<float4>                    dstMipLevel3        : register(u2);
+RWTexture2DArray<float4>                    dstMipLevel4        : register(u3);
+RWTexture2DArray<float4>                    dstMipLevel5        : register(u4);
+globallycoherent RWTexture2DArray<float4>   dstMipLevel6        : register(u5);
+RWTexture2DArray<float4>                    dstMipLevel7        : register(u6);
+RWTexture2DArray<float4>                    dstMipLevel8        : register(u7);
+RWTexture2DArray<float4>                    dstMipLevel9        : register(u8);
+RWTexture2DArray<float4>                    dstMipLevel10       : register(u9);
+RWTexture2DArray<float4>                    dstMipLevel11       : register(u10);
+RWTexture2DArray<float4>                    dstMipLevel12       : register(u11);
+globallycoherent RWStructuredBuffer<uint>   atomicCounters      : register(u12);
+Texture2DArray<float4>                      srcMipLevel         : register(t0);
+SamplerState                                linearClampSampler  : register(s0);
+
+
+/* Separate color channels into different groupshared arrays for better cache utilization */
+groupshared float   sharedColorR[SPD_SHARED_PITCH * SPD_SHARED_PITCH];
+groupshared float   sharedColorG[SPD_SHARED_PITCH * SPD_SHARED_PITCH];
+groupshared float   sharedColorB[SPD_SHARED_PITCH * SPD_SHARED_PITCH];
+groupshared float   sharedColorA[SPD_SHARED_PITCH * SPD_SHARED_PITCH];
+groupshared uint    sharedCounter;
+
+
+/* Utility functions */
+uint SharedIndex(uint2 pos)
+{
+    return (pos.y * SPD_SHARED_PITCH + pos.x);
+}
+
+void StoreColor(uint2 pos, float4 color)
+{
+    uint idx = SharedIndex(pos);
+    sharedColorR[idx] = color.r;
+    sharedColorG[idx] = color.g;
+    sharedColorB[idx] = color.b;
+    sharedColorA[idx] = color.a;
+}
+
+float4 LoadColor(uint2 pos)
+{
+    uint idx = SharedIndex(pos);
+    return float4(
+        sharedColorR[idx],
+        sharedColorG[idx],
+        sharedColorB[idx],
+        sharedColorA[idx]
+    );
+}
+
+// Returns the average of the 2x2 texels in shared memory that are reduced into the specified position.
+float4 ReduceColor(uint2 pos)
+{
+    return 0.25 * (
+        LoadColor(pos * 2 + uint2(0, 0)) +
+        LoadColor(pos * 2 + uint2(1, 0)) +
+        LoadColor(pos * 2 + uint2(0, 1)) +
+        LoadColor(pos * 2 + uint2(1, 1))
+    );
+}
+
+#ifdef LINEAR_TO_SRGB
+
+float3 LinearToSRGB(float3 linearColor)
+{
+    /* Use approximation for sRGB curve */
+    return (linearColor < 0.0031308 ? 12.92 * linearColor : 1.13005 * sqrt(abs(linearColor - 0.00228)) - 0.13448 * linearColor + 0.005719);
+}
+
+float3 SRGBToLinear(float3 srgbColor)
+{
+    return (srgbColor <= 0.04045 ? srgbColor / 12.92 : pow(abs((srgbColor + 0.055) / 1.055), 2.4));
+}
+
+#endif // /LINEAR_TO_SRGB
+
+float4 PackLinearColor(float4 linearColor)
+{
+    #ifdef LINEAR_TO_SRGB
+    return float4(LinearToSRGB(linearColor.rgb), linearColor.a);
+    #else
+    return linearColor;
+    #endif // /LINEAR_TO_SRGB
+}
+
+float4 UnpackLinearColor(float4 packedColor)
+{
+    #ifdef LINEAR_TO_SRGB
+    return float4(SRGBToLinear(packedColor.rgb), packedColor.a);
+    #else
+    return packedColor;
+    #endif // /LINEAR_TO_SRGB
+}
+
+/*
+Reduces the texels in shared memory into the next MIP-map level of size SIZE x SIZE within the tile TILE.
+The barriers are within uniform control flow, since the early return only depends on constant buffer values.
+*/
+#define SPD_REDUCE_MIP_LEVEL(LEVEL, DST_MIP_LEVEL, SIZE, TILE)                      \
+    if (numMipLevels < LEVEL)                                                       \
+        return;                                                                     \
+    GroupMemoryBarrierWithGroupSync();                                              \
+    {                                                                               \
+        uint2   pos     = uint2(groupIndex % SIZE, groupIndex / SIZE);              \
+        bool    active  = (groupIndex < SIZE * SIZE);                               \
+        float4  color   = (float4)0;                                                \
+        if (active)                                                                 \
+            color = ReduceColor(pos);                                               \
+        GroupMemoryBarrierWithGroupSync();                                          \
+        if (active)                                                                 \
+        {                                                                           \
+            StoreColor(pos, color);                                                 \
+            DST_MIP_LEVEL[uint3(TILE * SIZE + pos, arrayLayer)] = PackLinearColor(color); \
+        }                                                                           \
+    }
+
+
+/* Primary compute kernel to generate up to 12 MIP-map levels at a time */
+[RootSignature(
+    "RootFlags(0),"
+    "RootConstants(b0, num32BitConstants = 6),"
+    "DescriptorTable(SRV(t0, numDescriptors = 1)),"
+    "DescriptorTable(UAV(u0, numDescriptors = 12)),"
+    "UAV(u12),"
+    "StaticSampler("
+        "s0,"
+        "addressU = TEXTURE_ADDRESS_CLAMP,"
+        "addressV = TEXTURE_ADDRESS_CLAMP,"
+        "addressW = TEXTURE_ADDRESS_CLAMP,"
+        "filter = FILTER_MIN_MAG_LINEAR_MIP_POINT"
+    ")"
+)]
+[numthreads(SPD_NUM_THREADS, 1, 1)]
+void GenerateMipsSPDCS(uint groupIndex : SV_GroupIndex, uint3 groupID : SV_GroupID)
+{
+    uint    arrayLayer  = baseArrayLayer + groupID.z;
+    uint2   tile        = groupID.xy;
+
+    /* Downsample 64x64 texels of the source MIP-map level into 32x32 texels of the 1st output MIP-map level; 4 texels per thread */
+    [unroll]
+    for (uint i = 0; i < 4; ++i)
+    {
+        uint    idx     = groupIndex + i * SPD_NUM_THREADS;
+        uint2   pos     = uint2(idx % SPD_SHARED_PITCH, idx / SPD_SHARED_PITCH);
+        uint2   dstPos  = tile * SPD_SHARED_PITCH + pos;
+
+        /* Bilinear sample between the 2x2 source texels */
+        float3 uv = float3(texelSize * (dstPos * 2 + 1), (float)arrayLayer);
+        float4 color = srcMipLevel.SampleLevel(linearClampSampler, uv, baseMipLevel);
+
+        dstMipLevel1[uint3(dstPos, arrayLayer)] = PackLinearColor(color);
+        StoreColor(pos, color);
+    }
+
+    /* Reduce 2nd to 6th output MIP-map level within this work group */
+    SPD_REDUCE_MIP_LEVEL( 2, dstMipLevel2,  16, tile)
+    SPD_REDUCE_MIP_LEVEL( 3, dstMipLevel3,   8, tile)
+    SPD_REDUCE_MIP_LEVEL( 4, dstMipLevel4,   4, tile)
+    SPD_REDUCE_MIP_LEVEL( 5, dstMipLevel5,   2, tile)
+    SPD_REDUCE_MIP_LEVEL( 6, dstMipLevel6,   1, tile)
+
+    if (numMipLevels < 7)
+        return;
+
+    /* Make 6th output MIP-map level visible to all work groups and only continue with the last work group of this array layer */
+    DeviceMemoryBarrierWithGroupSync();
+
+    if (groupIndex == 0)
+    {
+        uint counter = 0;
+        InterlockedAdd(atomicCounters[arrayLayer], 1, counter);
+        sharedCounter = counter;
+    }
+
+    GroupMemoryBarrierWithGroupSync();
+
+    if (sharedCounter != numWorkGroups - 1)
+        return;
+
+    /* Reset counter for the next dispatch */
+    if (groupIndex == 0)
+        atomicCounters[arrayLayer] = 0;
+
+    /* Downsample at most 64x64 texels of the 6th into 32x32 texels of the 7th output MIP-map level; clamp loads to the extent of the 6th level */
+    uint mip6Width = 0, mip6Height = 0, mip6Layers = 0;
+    dstMipLevel6.GetDimensions(mip6Width, mip6Height, mip6Layers);
+
+    uint2 maxPos = uint2(mip6Width - 1, mip6Height - 1);
+
+    [unroll]
+    for (uint j = 0; j < 4; ++j)
+    {
+        uint    idx     = groupIndex + j * SPD_NUM_THREADS;
+        uint2   pos     = uint2(idx % SPD_SHARED_PITCH, idx / SPD_SHARED_PITCH);
+        uint2   srcPos  = pos * 2;
+
+        float4 color = 0.25 * (
+            UnpackLinearColor(dstMipLevel6[uint3(min(srcPos + uint2(0, 0), maxPos), arrayLayer)]) +
+            UnpackLinearColor(dstMipLevel6[uint3(min(srcPos + uint2(1, 0), maxPos), arrayLayer)]) +
+            UnpackLinearColor(dstMipLevel6[uint3(min(srcPos + uint2(0, 1), maxPos), arrayLayer)]) +
+            UnpackLinearColor(dstMipLevel6[uint3(min(srcPos + uint2(1, 1), maxPos), arrayLayer)])
+        );
+
+        dstMipLevel7[uint3(pos, arrayLayer)] = PackLinearColor(color);
+        StoreColor(pos, color);
+    }
+
+    /* Reduce 8th to 12th output MIP-map level within this work group */
+    SPD_REDUCE_MIP_LEVEL( 8, dstMipLevel8,  16, uint2(0, 0))
+    SPD_REDUCE_MIP_LEVEL( 9, dstMipLevel9,   8, uint2(0, 0))
+    SPD_REDUCE_MIP_LEVEL(10, dstMipLevel10,  4, uint2(0, 0))
+    SPD_REDUCE_MIP_LEVEL(11, dstMipLevel11,  2, uint2(0, 0))
+    SPD_REDUCE_MIP_LEVEL(12, dstMipLevel12,  1, uint2(0, 0))
+}
+
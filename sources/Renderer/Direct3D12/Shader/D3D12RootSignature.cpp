@@ -96,16 +96,10 @@ static ComPtr<ID3DBlob> DXSerializeRootSignature(
     return signature;
 }
 
-static ComPtr<ID3D12RootSignature> DXCreateRootSignature(
-    ID3D12Device*                       device,
-    const D3D12_ROOT_SIGNATURE_DESC&    signatureDesc,
-    ComPtr<ID3DBlob>*                   serializedBlob)
+static ComPtr<ID3D12RootSignature> DXCreateRootSignature(ID3D12Device* device, ID3DBlob* signature)
 {
     ComPtr<ID3D12RootSignature> rootSignature;
 
-    /* Create serialized root signature */
-    auto signature = DXSerializeRootSignature(signatureDesc, D3D_ROOT_SIGNATURE_VERSION_1);
-
     /* Create actual root signature */
     auto hr = device->CreateRootSignature(
         0,
@@ -115,10 +109,6 @@ static ComPtr<ID3D12RootSignature> DXCreateRootSignature(
     );
     DXThrowIfFailed(hr, "failed to create D3D12 root signature");
 
-    /* Return serialized signature blob */
-    if (serializedBlob != nullptr)
-        *serializedBlob = std::move(signature);
-
     return rootSignature;
 }
 
@@ -126,6 +116,21 @@ ComPtr<ID3D12RootSignature> D3D12RootSignatureBuilder::Finalize(
     ID3D12Device*               device,
     D3D12_ROOT_SIGNATURE_FLAGS  flags,
     ComPtr<ID3DBlob>*           serializedBlob)
+{
+    /* Create serialized root signature */
+    auto signature = Serialize(flags);
+
+    /* Create actual root signature */
+    auto rootSignature = DXCreateRootSignature(device, signature.Get());
+
+    /* Return serialized signature blob */
+    if (serializedBlob != nullptr)
+        *serializedBlob = std::move(signature);
+
+    return rootSignature;
+}
+
+ComPtr<ID3DBlob> D3D12RootSignatureBuilder::Serialize(D3D12_ROOT_SIGNATURE_FLAGS flags)
 {
     D3D12_ROOT_SIGNATURE_DESC signatureDesc;
     {
@@ -153,7 +158,7 @@ ComPtr<ID3D12RootSignature> D3D12RootSignatureBuilder::Finalize(
 
         signatureDesc.Flags                 = flags;
     }
-    return DXCreateRootSignature(device, signatureDesc, serializedBlob);
+    return DXSerializeRootSignature(signatureDesc, D3D_ROOT_SIGNATURE_VERSION_1);
 }
 
 
@@ -39,6 +39,15 @@ class D3D12RootSignatureBuilder
             ComPtr<ID3DBlob>*           serializedBlob  = nullptr
         );
 
+        // Serializes the root signature without creating the native D3D root signature.
+        ComPtr<ID3DBlob> Serialize(D3D12_ROOT_SIGNATURE_FLAGS flags = D3D12_ROOT_SIGNATURE_FLAG_NONE);
+
+        // Returns the number of root parameters that have been appended so far.
+        inline UINT GetNumRootParameters() const
+        {
+            return static_cast<UINT>(rootParams_.size());
+        }
+
         // Returns a constant reference to the root parameter at the specified index.
         inline const D3D12RootParameter& operator [] (std::size_t idx) const
         {
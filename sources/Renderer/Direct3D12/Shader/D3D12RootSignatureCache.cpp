@@ -0,0 +1,106 @@
+/*
+ * D3D12RootSignatureCache.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12RootSignatureCache.h"
+#include "../../DXCommon/DXCore.h"
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+D3D12RootSignatureCache& D3D12RootSignatureCache::Get()
+{
+    static D3D12RootSignatureCache g_instance;
+    return g_instance;
+}
+
+void D3D12RootSignatureCache::Clear()
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    entries_.clear();
+}
+
+// Returns the FNV-1a hash of the specified serialized blob.
+static std::size_t HashSerializedBlob(ID3DBlob* blob)
+{
+    auto data = reinterpret_cast<const std::uint8_t*>(blob->GetBufferPointer());
+    auto size = blob->GetBufferSize();
+
+    std::uint64_t hash = 14695981039346656037ull;
+    for (SIZE_T i = 0; i < size; ++i)
+    {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+
+    return static_cast<std::size_t>(hash);
+}
+
+static bool AreSerializedBlobsEqual(ID3DBlob* lhs, ID3DBlob* rhs)
+{
+    return
+    (
+        lhs->GetBufferSize() == rhs->GetBufferSize() &&
+        ::memcmp(lhs->GetBufferPointer(), rhs->GetBufferPointer(), lhs->GetBufferSize()) == 0
+    );
+}
+
+ComPtr<ID3D12RootSignature> D3D12RootSignatureCache::AcquireRootSignature(ID3D12Device* device, ID3DBlob* serializedBlob)
+{
+    const auto hash = HashSerializedBlob(serializedBlob);
+
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    /* Find identical root signature */
+    for (auto& entry : entries_)
+    {
+        if (entry.hash == hash && AreSerializedBlobsEqual(entry.serializedBlob.Get(), serializedBlob))
+        {
+            ++entry.refCount;
+            return entry.rootSignature;
+        }
+    }
+
+    /* Create new root signature */
+    ComPtr<ID3D12RootSignature> rootSignature;
+
+    auto hr = device->CreateRootSignature(
+        0,
+        serializedBlob->GetBufferPointer(),
+        serializedBlob->GetBufferSize(),
+        IID_PPV_ARGS(rootSignature.ReleaseAndGetAddressOf())
+    );
+    DXThrowIfFailed(hr, "failed to create D3D12 root signature");
+
+    entries_.push_back({ hash, serializedBlob, rootSignature, 1 });
+
+    return rootSignature;
+}
+
+void D3D12RootSignatureCache::ReleaseRootSignature(ID3D12RootSignature* rootSignature)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    for (auto it = entries_.begin(); it != entries_.end(); ++it)
+    {
+        if (it->rootSignature.Get() == rootSignature)
+        {
+            if (--it->refCount == 0)
+                entries_.erase(it);
+            return;
+        }
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,78 @@
+/*
+ * D3D12RootSignatureCache.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_ROOT_SIGNATURE_CACHE_H
+#define LLGL_D3D12_ROOT_SIGNATURE_CACHE_H
+
+
+#include "../../DXCommon/ComPtr.h"
+#include <d3d12.h>
+#include <vector>
+#include <cstdint>
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+/*
+Singleton cache of reference counted root signatures that are shared between all pipeline layouts.
+Root signatures are identified by their serialized blob, so pipeline layouts that only differ
+in properties that don't affect the root signature (e.g. binding names) share the same ID3D12RootSignature object.
+All functions are guarded by a mutex, since pipeline layouts can be created from multiple threads.
+*/
+class D3D12RootSignatureCache
+{
+
+    public:
+
+        D3D12RootSignatureCache(const D3D12RootSignatureCache&) = delete;
+        D3D12RootSignatureCache& operator = (const D3D12RootSignatureCache&) = delete;
+
+        // Returns the instance of this singleton.
+        static D3D12RootSignatureCache& Get();
+
+        // Clears all cached root signatures.
+        void Clear();
+
+        // Returns the root signature for the specified serialized blob and increments its reference counter. A new root signature is created if there is no identical one yet.
+        ComPtr<ID3D12RootSignature> AcquireRootSignature(ID3D12Device* device, ID3DBlob* serializedBlob);
+
+        // Decrements the reference counter of the specified root signature and removes it from the cache if it is no longer referenced.
+        void ReleaseRootSignature(ID3D12RootSignature* rootSignature);
+
+    private:
+
+        struct Entry
+        {
+            std::size_t                 hash;
+            ComPtr<ID3DBlob>            serializedBlob;
+            ComPtr<ID3D12RootSignature> rootSignature;
+            std::uint32_t               refCount;
+        };
+
+    private:
+
+        D3D12RootSignatureCache() = default;
+
+    private:
+
+        std::vector<Entry> entries_;
+        std::mutex         mutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
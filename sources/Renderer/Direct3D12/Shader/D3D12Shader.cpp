@@ -19,10 +19,14 @@ namespace LLGL
 {
 
 
-D3D12Shader::D3D12Shader(const ShaderDescriptor& desc) :
+D3D12Shader::D3D12Shader(
+    const ShaderDescriptor& desc,
+    const DXShaderCache*    cache,
+    DXShaderCompileResult*  compileResult)
+:
     Shader { desc.type }
 {
-    if (BuildShader(desc))
+    if (BuildShader(desc, cache, compileResult))
     {
         if (GetType() == ShaderType::Vertex || GetType() == ShaderType::Geometry)
         {
@@ -91,10 +95,10 @@ bool D3D12Shader::GetStreamOutputDesc(D3D12_STREAM_OUTPUT_DESC& layoutDesc) cons
  * ======= Private: =======
  */
 
-bool D3D12Shader::BuildShader(const ShaderDescriptor& shaderDesc)
+bool D3D12Shader::BuildShader(const ShaderDescriptor& shaderDesc, const DXShaderCache* cache, DXShaderCompileResult* compileResult)
 {
     if (IsShaderSourceCode(shaderDesc.sourceType))
-        return CompileSource(shaderDesc);
+        return CompileSource(shaderDesc, cache, compileResult);
     else
         return LoadBinary(shaderDesc);
 }
@@ -213,50 +217,20 @@ void D3D12Shader::BuildStreamOutput(UINT numVertexAttribs, const VertexAttribute
 }
 
 // see https://msdn.microsoft.com/en-us/library/windows/desktop/dd607324(v=vs.85).aspx
-bool D3D12Shader::CompileSource(const ShaderDescriptor& shaderDesc)
+bool D3D12Shader::CompileSource(const ShaderDescriptor& shaderDesc, const DXShaderCache* cache, DXShaderCompileResult* compileResult)
 {
-    /* Get source code */
-    std::string fileContent;
-    const char* sourceCode      = nullptr;
-    SIZE_T      sourceLength    = 0;
-
-    if (shaderDesc.sourceType == ShaderSourceType::CodeFile)
-    {
-        fileContent     = ReadFileString(shaderDesc.source);
-        sourceCode      = fileContent.c_str();
-        sourceLength    = fileContent.size();
-    }
+    /* Compile shader code or take result from precompilation */
+    DXShaderCompileResult result;
+    if (compileResult != nullptr && compileResult->compiled)
+        result = std::move(*compileResult);
     else
-    {
-        sourceCode      = shaderDesc.source;
-        sourceLength    = shaderDesc.sourceSize;
-    }
+        DXCompileShader(shaderDesc, result, cache);
 
-    /* Get parameter from union */
-    const char* entry   = shaderDesc.entryPoint;
-    const char* target  = (shaderDesc.profile != nullptr ? shaderDesc.profile : "");
-    auto        defines = reinterpret_cast<const D3D_SHADER_MACRO*>(shaderDesc.defines);
-    auto        flags   = shaderDesc.flags;
-
-    /* Compile shader code */
-    ComPtr<ID3DBlob> errors;
-    auto hr = D3DCompile(
-        sourceCode,
-        sourceLength,
-        nullptr,                            // LPCSTR               pSourceName
-        defines,                            // D3D_SHADER_MACRO*    pDefines
-        nullptr,                            // ID3DInclude*         pInclude
-        entry,                              // LPCSTR               pEntrypoint
-        target,                             // LPCSTR               pTarget
-        DXGetCompilerFlags(flags),          // UINT                 Flags1
-        0,                                  // UINT                 Flags2 (recommended to always be 0)
-        byteCode_.ReleaseAndGetAddressOf(), // ID3DBlob**           ppCode
-        errors.ReleaseAndGetAddressOf()     // ID3DBlob**           ppErrorMsgs
-    );
+    byteCode_ = std::move(result.byteCode);
 
     /* Return true if compilation was successful */
-    const bool hasErrors = FAILED(hr);
-    report_.Reset(errors.Get(), hasErrors);
+    const bool hasErrors = FAILED(result.hr);
+    report_.Reset(result.errors.Get(), hasErrors);
     return !hasErrors;
 }
 
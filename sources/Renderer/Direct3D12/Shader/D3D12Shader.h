@@ -14,6 +14,7 @@
 #include <LLGL/VertexAttribute.h>
 #include <LLGL/BufferFlags.h>
 #include "../../DXCommon/DXReport.h"
+#include "../../DXCommon/DXShaderCache.h"
 #include "../../../Core/LinearStringContainer.h"
 #include <vector>
 #include <d3d12.h>
@@ -28,7 +29,12 @@ class D3D12Shader final : public Shader
 
     public:
 
-        D3D12Shader(const ShaderDescriptor& desc);
+        // Creates the shader with an optional bytecode cache and an optional result of a previous compilation of the same descriptor (see DXCompileShaders).
+        D3D12Shader(
+            const ShaderDescriptor& desc,
+            const DXShaderCache*    cache           = nullptr,
+            DXShaderCompileResult*  compileResult   = nullptr
+        );
 
         const Report* GetReport() const override;
 
@@ -43,12 +49,12 @@ class D3D12Shader final : public Shader
 
     private:
 
-        bool BuildShader(const ShaderDescriptor& shaderDesc);
+        bool BuildShader(const ShaderDescriptor& shaderDesc, const DXShaderCache* cache, DXShaderCompileResult* compileResult);
         void ReserveVertexAttribs(const ShaderDescriptor& shaderDesc);
         void BuildInputLayout(UINT numVertexAttribs, const VertexAttribute* vertexAttribs);
         void BuildStreamOutput(UINT numVertexAttribs, const VertexAttribute* vertexAttribs);
 
-        bool CompileSource(const ShaderDescriptor& shaderDesc);
+        bool CompileSource(const ShaderDescriptor& shaderDesc, const DXShaderCache* cache, DXShaderCompileResult* compileResult);
         bool LoadBinary(const ShaderDescriptor& shaderDesc);
 
         HRESULT ReflectShaderByteCode(ShaderReflection& reflection) const;
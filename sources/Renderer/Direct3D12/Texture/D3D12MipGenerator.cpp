@@ -13,6 +13,7 @@
 #include "../D3DX12/d3dx12.h"
 #include "../../DXCommon/DXCore.h"
 #include "../../DXCommon/DXTypes.h"
+#include <d3dcompiler.h>
 
 
 namespace LLGL
@@ -35,6 +36,11 @@ void D3D12MipGenerator::InitializeDevice(ID3D12Device* device)
     CreateResourcesFor1DMips(device);
     CreateResourcesFor2DMips(device);
     CreateResourcesFor3DMips(device);
+
+    /* Single-pass downsampler requires typed UAV loads and 13 UAV slots (resource binding tier 2) */
+    D3D12_FEATURE_DATA_D3D12_OPTIONS options = {};
+    if (SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &options, sizeof(options))))
+        hasSPDSupport_ = (options.TypedUAVLoadAdditionalFormats != FALSE && options.ResourceBindingTier >= D3D12_RESOURCE_BINDING_TIER_2);
 }
 
 template <std::size_t N>
@@ -52,6 +58,10 @@ void D3D12MipGenerator::Clear()
     ReleasePipelinesAndRootSignature(rootSignature1D_, pipelines1D_);
     ReleasePipelinesAndRootSignature(rootSignature2D_, pipelines2D_);
     ReleasePipelinesAndRootSignature(rootSignature3D_, pipelines3D_);
+    ReleasePipelinesAndRootSignature(rootSignatureSPD_, pipelinesSPD_);
+    atomicCountersSPD_.native.Reset();
+    hasSPDResources_    = false;
+    triedSPDResources_  = false;
 }
 
 HRESULT D3D12MipGenerator::GenerateMips(
@@ -122,21 +132,56 @@ ComPtr<ID3D12PipelineState> D3D12MipGenerator::CreateComputePSO(
     ID3D12Device*           device,
     ID3D12RootSignature*    rootSignature,
     int                     resourceID)
+{
+    if (auto blob = DXCreateBlobFromResource(resourceID))
+        return CreateComputePSOFromBytecode(rootSignature, blob.Get());
+    return nullptr;
+}
+
+ComPtr<ID3D12PipelineState> D3D12MipGenerator::CreateComputePSOFromSource(
+    ID3D12RootSignature*    rootSignature,
+    int                     resourceID,
+    const char*             entryPoint,
+    const char*             profile,
+    const D3D_SHADER_MACRO* defines)
+{
+    if (auto source = DXCreateBlobFromResource(resourceID))
+    {
+        /* Compile shader source; the compute PSO is optional, so errors are not reported */
+        ComPtr<ID3DBlob> byteCode;
+        ComPtr<ID3DBlob> errors;
+        auto hr = D3DCompile(
+            source->GetBufferPointer(),
+            source->GetBufferSize(),
+            nullptr,
+            defines,
+            nullptr,
+            entryPoint,
+            profile,
+            D3DCOMPILE_OPTIMIZATION_LEVEL3,
+            0,
+            byteCode.ReleaseAndGetAddressOf(),
+            errors.ReleaseAndGetAddressOf()
+        );
+        if (SUCCEEDED(hr))
+            return CreateComputePSOFromBytecode(rootSignature, byteCode.Get());
+    }
+    return nullptr;
+}
+
+ComPtr<ID3D12PipelineState> D3D12MipGenerator::CreateComputePSOFromBytecode(ID3D12RootSignature* rootSignature, ID3DBlob* blob)
 {
     ComPtr<ID3D12PipelineState> pipelineState;
 
-    if (auto blob = DXCreateBlobFromResource(resourceID))
+    /* Create graphics pipeline state and graphics command list */
+    D3D12_COMPUTE_PIPELINE_STATE_DESC psoDesc = {};
     {
-        /* Create graphics pipeline state and graphics command list */
-        D3D12_COMPUTE_PIPELINE_STATE_DESC psoDesc = {};
-        {
-            psoDesc.pRootSignature      = rootSignature;
-            psoDesc.CS.pShaderBytecode  = blob->GetBufferPointer();
-            psoDesc.CS.BytecodeLength   = blob->GetBufferSize();
-        }
-        auto hr = device_->CreateComputePipelineState(&psoDesc, IID_PPV_ARGS(pipelineState.ReleaseAndGetAddressOf()));
-        DXThrowIfCreateFailed(hr, "ID3D12PipelineState");
+        psoDesc.pRootSignature      = rootSignature;
+        psoDesc.CS.pShaderBytecode  = blob->GetBufferPointer();
+        psoDesc.CS.BytecodeLength   = blob->GetBufferSize();
     }
+    auto hr = device_->CreateComputePipelineState(&psoDesc, IID_PPV_ARGS(pipelineState.ReleaseAndGetAddressOf()));
+    DXThrowIfCreateFailed(hr, "ID3D12PipelineState");
 
     return pipelineState;
 }
@@ -223,6 +268,90 @@ void D3D12MipGenerator::CreateResourcesFor3DMips(ID3D12Device* device)
     pipelines3D_[0xF] = CreateComputePSO( device, rootSignature3D_.Get(), LLGL_IDR_GENERATEMIPS3D_CS_SRGB_ODDXYZ );
 }
 
+bool D3D12MipGenerator::CreateResourcesForSPD(ID3D12Device* device)
+{
+    if (triedSPDResources_)
+        return hasSPDResources_;
+
+    triedSPDResources_ = true;
+
+    /* Initialize root signature */
+    D3D12RootSignatureBuilder rootSignature;
+    {
+        rootSignature.ResetAndAlloc(4, 1);
+        rootSignature[0].InitAsConstants(0, 6);
+        rootSignature[1].InitAsDescriptorRange(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 0, 1);
+        rootSignature[2].InitAsDescriptorRange(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, 0, 12);
+        rootSignature[3].InitAsDescriptorUAV(12);
+        auto samplerDesc = rootSignature.AppendStaticSampler();
+        {
+            samplerDesc->Filter = D3D12_FILTER_MIN_MAG_LINEAR_MIP_POINT;
+        }
+    }
+    rootSignatureSPD_ = rootSignature.Finalize(device);
+
+    /* Compile PSOs at runtime for linear and sRGB formats */
+    const D3D_SHADER_MACRO definesSRGB[] = { { "LINEAR_TO_SRGB", "1" }, { nullptr, nullptr } };
+
+    pipelinesSPD_[0] = CreateComputePSOFromSource(rootSignatureSPD_.Get(), LLGL_IDR_GENERATEMIPSSPD_HLSL, "GenerateMipsSPDCS", "cs_5_1", nullptr    );
+    pipelinesSPD_[1] = CreateComputePSOFromSource(rootSignatureSPD_.Get(), LLGL_IDR_GENERATEMIPSSPD_HLSL, "GenerateMipsSPDCS", "cs_5_1", definesSRGB);
+
+    if (!pipelinesSPD_[0] || !pipelinesSPD_[1])
+        return false;
+
+    /* Create buffer for one atomic counter per array layer; committed resources are zero initialized and the shader resets the counters */
+    const auto heapProperties   = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+    const auto bufferDesc       = CD3DX12_RESOURCE_DESC::Buffer(
+        D3D12_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION * sizeof(UINT),
+        D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS
+    );
+
+    auto hr = device->CreateCommittedResource(
+        &heapProperties,
+        D3D12_HEAP_FLAG_NONE,
+        &bufferDesc,
+        D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+        nullptr,
+        IID_PPV_ARGS(atomicCountersSPD_.native.ReleaseAndGetAddressOf())
+    );
+    DXThrowIfCreateFailed(hr, "ID3D12Resource", "for atomic counters of single-pass MIP-map generation");
+
+    atomicCountersSPD_.SetInitialState(D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+    hasSPDResources_ = true;
+    return true;
+}
+
+static bool IsPowerOfTwo(UINT64 x)
+{
+    return (x > 0 && (x & (x - 1)) == 0);
+}
+
+bool D3D12MipGenerator::SupportsSinglePassDownsampling(
+    const D3D12_RESOURCE_DESC&  resourceDesc,
+    DXGI_FORMAT                 format,
+    const TextureSubresource&   subresource)
+{
+    if (!hasSPDSupport_)
+        return false;
+
+    /* Single-pass downsampler only averages 2x2 texels, so it's limited to power-of-two textures */
+    const auto srcWidth     = (resourceDesc.Width  >> subresource.baseMipLevel);
+    const auto srcHeight    = (resourceDesc.Height >> subresource.baseMipLevel);
+    if (!IsPowerOfTwo(srcWidth) || !IsPowerOfTwo(srcHeight))
+        return false;
+
+    /* The 6th MIP-map level is read back by the shader, so the UAV format must support typed loads */
+    D3D12_FEATURE_DATA_FORMAT_SUPPORT formatSupport = {};
+    formatSupport.Format = DXTypes::ToDXGIFormatUAV(format);
+    if (FAILED(device_->CheckFeatureSupport(D3D12_FEATURE_FORMAT_SUPPORT, &formatSupport, sizeof(formatSupport))))
+        return false;
+    if ((formatSupport.Support2 & D3D12_FORMAT_SUPPORT2_UAV_TYPED_LOAD) == 0)
+        return false;
+
+    return CreateResourcesForSPD(device_);
+}
+
 void D3D12MipGenerator::GenerateMips1D(
     D3D12CommandContext&        commandContext,
     D3D12Resource&              resource,
@@ -300,6 +429,13 @@ void D3D12MipGenerator::GenerateMips2D(
     DXGI_FORMAT                 format,
     const TextureSubresource&   subresource)
 {
+    /* Use single-pass downsampler if possible, otherwise fall back to one dispatch per four MIP-map levels */
+    if (SupportsSinglePassDownsampling(resource.native->GetDesc(), format, subresource))
+    {
+        GenerateMips2DSinglePass(commandContext, resource, mipDescHeap, format, subresource);
+        return;
+    }
+
     const bool isFormatSRGB = DXTypes::IsDXGIFormatSRGB(format);
 
     ID3D12GraphicsCommandList* commandList = commandContext.GetCommandList();
@@ -366,6 +502,74 @@ void D3D12MipGenerator::GenerateMips2D(
     commandContext.TransitionResource(resource, resource.usageState, true);
 }
 
+void D3D12MipGenerator::GenerateMips2DSinglePass(
+    D3D12CommandContext&        commandContext,
+    D3D12Resource&              resource,
+    ID3D12DescriptorHeap*       mipDescHeap,
+    DXGI_FORMAT                 format,
+    const TextureSubresource&   subresource)
+{
+    const bool isFormatSRGB = DXTypes::IsDXGIFormatSRGB(format);
+
+    ID3D12GraphicsCommandList* commandList = commandContext.GetCommandList();
+
+    commandContext.TransitionResource(resource, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, true);
+
+    /* Set root signature, PSO, and descriptor heap */
+    commandContext.SetComputeRootSignature(rootSignatureSPD_.Get());
+    commandContext.SetPipelineState(pipelinesSPD_[isFormatSRGB ? 1 : 0].Get());
+
+    ID3D12DescriptorHeap* descHeaps[] = { mipDescHeap };
+    commandContext.SetDescriptorHeaps(1, descHeaps);
+
+    const auto gpuDescHandleStart = mipDescHeap->GetGPUDescriptorHandleForHeapStart();
+
+    /* Set SRV to read from entire MIP-map chain and atomic counters */
+    commandList->SetComputeRootDescriptorTable(1, gpuDescHandleStart);
+    commandList->SetComputeRootUnorderedAccessView(3, atomicCountersSPD_.native->GetGPUVirtualAddress());
+
+    D3D12_RESOURCE_DESC resourceDesc = resource.native->GetDesc();
+
+    const auto mipLevelEnd = subresource.baseMipLevel + subresource.numMipLevels;
+
+    for (std::uint32_t mipLevel = subresource.baseMipLevel; mipLevel + 1 < mipLevelEnd;)
+    {
+        /* Determine source extent and number of work groups for 64x64 tiles */
+        UINT srcWidth       = std::max(1u, static_cast<UINT>(resourceDesc.Width)  >> mipLevel);
+        UINT srcHeight      = std::max(1u, static_cast<UINT>(resourceDesc.Height) >> mipLevel);
+
+        UINT numGroupsX     = (srcWidth  + 63u) / 64u;
+        UINT numGroupsY     = (srcHeight + 63u) / 64u;
+
+        /* The last work group continues with the 6th MIP-map level, which must fit into a single 64x64 tile; must be in [1, 12] */
+        UINT maxNumMips     = (std::max(srcWidth, srcHeight) > 4096u ? 6u : 12u);
+        UINT numMips        = std::min(mipLevelEnd - mipLevel - 1, maxNumMips);
+
+        /* Run compute shader to generate next MIP-maps */
+        commandContext.SetComputeConstant(0, 1.0f / static_cast<float>(srcWidth), 0);
+        commandContext.SetComputeConstant(0, 1.0f / static_cast<float>(srcHeight), 1);
+        commandContext.SetComputeConstant(0, mipLevel, 2);
+        commandContext.SetComputeConstant(0, numMips, 3);
+        commandContext.SetComputeConstant(0, subresource.baseArrayLayer, 4);
+        commandContext.SetComputeConstant(0, numGroupsX * numGroupsY, 5);
+
+        /* UAV of MIP-map level N is located at descriptor N in the MIP-map descriptor heap */
+        auto gpuDescHandle = gpuDescHandleStart;
+        gpuDescHandle.ptr += descHandleSize_ * (mipLevel + 1);
+        commandList->SetComputeRootDescriptorTable(2, gpuDescHandle);
+
+        commandList->Dispatch(numGroupsX, numGroupsY, subresource.numArrayLayers);
+
+        /* Insert UAV barriers for the texture and the atomic counters, which are shared between all dispatches */
+        commandContext.InsertUAVBarrier(resource);
+        commandContext.InsertUAVBarrier(atomicCountersSPD_, true);
+
+        mipLevel += numMips;
+    }
+
+    commandContext.TransitionResource(resource, resource.usageState, true);
+}
+
 void D3D12MipGenerator::GenerateMips3D(
     D3D12CommandContext&        commandContext,
     D3D12Resource&              resource,
@@ -15,6 +15,7 @@
 #include "../Shader/D3D12RootSignature.h"
 #include "D3D12SamplerDesc.h"
 #include "../Shader/D3D12Shader.h"
+#include "../D3D12Resource.h"
 #include "../../DXCommon/ComPtr.h"
 
 
@@ -24,7 +25,6 @@ namespace LLGL
 
 class D3D12Texture;
 class D3D12CommandContext;
-struct D3D12Resource;
 struct TextureSubresource;
 
 // Direct3D 12 MIP-map generator singleton.
@@ -63,10 +63,27 @@ class D3D12MipGenerator
             int                     resourceID
         );
 
+        // Compiles the shader source from the specified resource and creates a compute PSO. Returns null if the compilation failed.
+        ComPtr<ID3D12PipelineState> CreateComputePSOFromSource(
+            ID3D12RootSignature*    rootSignature,
+            int                     resourceID,
+            const char*             entryPoint,
+            const char*             profile,
+            const D3D_SHADER_MACRO* defines
+        );
+
+        ComPtr<ID3D12PipelineState> CreateComputePSOFromBytecode(ID3D12RootSignature* rootSignature, ID3DBlob* blob);
+
         void CreateResourcesFor1DMips(ID3D12Device* device);
         void CreateResourcesFor2DMips(ID3D12Device* device);
         void CreateResourcesFor3DMips(ID3D12Device* device);
 
+        // Creates the resources for the single-pass downsampler on first use. Returns false if they are not available.
+        bool CreateResourcesForSPD(ID3D12Device* device);
+
+        // Returns true if the single-pass downsampler can be used for the specified 2D texture resource and subresource range.
+        bool SupportsSinglePassDownsampling(const D3D12_RESOURCE_DESC& resourceDesc, DXGI_FORMAT format, const TextureSubresource& subresource);
+
         void GenerateMips1D(
             D3D12CommandContext&        commandContext,
             D3D12Resource&              resource,
@@ -83,6 +100,15 @@ class D3D12MipGenerator
             const TextureSubresource&   subresource
         );
 
+        // Generates up to 12 MIP-map levels with a single dispatch, see GenerateMipsSPD.hlsl.
+        void GenerateMips2DSinglePass(
+            D3D12CommandContext&        commandContext,
+            D3D12Resource&              resource,
+            ID3D12DescriptorHeap*       mipDescHeap,
+            DXGI_FORMAT                 format,
+            const TextureSubresource&   subresource
+        );
+
         void GenerateMips3D(
             D3D12CommandContext&        commandContext,
             D3D12Resource&              resource,
@@ -104,6 +130,15 @@ class D3D12MipGenerator
         ComPtr<ID3D12RootSignature> rootSignature3D_;
         ComPtr<ID3D12PipelineState> pipelines3D_[16];
 
+        /* ----- Single-pass downsampler ----- */
+
+        ComPtr<ID3D12RootSignature> rootSignatureSPD_;
+        ComPtr<ID3D12PipelineState> pipelinesSPD_[2];
+        D3D12Resource               atomicCountersSPD_;                 // One atomic counter per array layer
+        bool                        hasSPDSupport_      = false;        // Device supports typed UAV loads and enough UAV slots
+        bool                        hasSPDResources_    = false;
+        bool                        triedSPDResources_  = false;
+
         UINT                        descHandleSize_     = 0;
 
 
@@ -32,6 +32,11 @@ D3D12RenderTarget::D3D12RenderTarget(D3D12Device& device, const RenderTargetDesc
         depthStencilFormat_,
         sampleDesc_
     );
+    if (auto shadingRateImage = desc.shadingRateImage)
+    {
+        auto shadingRateImageD3D = LLGL_CAST(D3D12Texture*, shadingRateImage);
+        shadingRateImage_ = &(shadingRateImageD3D->GetResource());
+    }
 }
 
 void D3D12RenderTarget::SetName(const char* name)
@@ -78,6 +83,27 @@ void D3D12RenderTarget::TransitionToOutputMerger(D3D12CommandContext& commandCon
     if (depthStencil_ != nullptr)
         commandContext.TransitionResource(*depthStencil_, D3D12_RESOURCE_STATE_DEPTH_WRITE);
 
+    if (shadingRateImage_ != nullptr)
+        commandContext.TransitionResource(*shadingRateImage_, D3D12_RESOURCE_STATE_SHADING_RATE_SOURCE);
+
+    commandContext.FlushResourceBarrieres();
+}
+
+void D3D12RenderTarget::TransitionToSubpass(D3D12CommandContext& commandContext, std::uint32_t colorAttachments, std::uint32_t inputAttachments)
+{
+    /* Multi-sampled attachments are only resolved at the end of the render pass, so they cannot be read by subsequent sub-passes */
+    if (HasMultiSampling())
+        return;
+
+    for (std::size_t i = 0; i < colorBuffers_.size(); ++i)
+    {
+        const std::uint32_t attachmentBit = (1u << i);
+        if ((inputAttachments & attachmentBit) != 0 && (colorAttachments & attachmentBit) == 0)
+            commandContext.TransitionResource(*colorBuffers_[i], D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+        else
+            commandContext.TransitionResource(*colorBuffers_[i], D3D12_RESOURCE_STATE_RENDER_TARGET);
+    }
+
     commandContext.FlushResourceBarrieres();
 }
 
@@ -99,12 +125,16 @@ void D3D12RenderTarget::ResolveRenderTarget(D3D12CommandContext& commandContext)
     }
     else
     {
+        /* Begin split transitions, so they can be completed when the attachments are used next */
         for (auto& resource : colorBuffers_)
-            commandContext.TransitionResource(*resource, resource->usageState);
+            commandContext.BeginTransitionResource(*resource, resource->usageState);
     }
 
     if (depthStencil_ != nullptr)
-        commandContext.TransitionResource(*depthStencil_, depthStencil_->usageState);
+        commandContext.BeginTransitionResource(*depthStencil_, depthStencil_->usageState);
+
+    if (shadingRateImage_ != nullptr)
+        commandContext.BeginTransitionResource(*shadingRateImage_, shadingRateImage_->usageState);
 
     commandContext.FlushResourceBarrieres();
 }
@@ -125,11 +155,30 @@ D3D12_CPU_DESCRIPTOR_HANDLE D3D12RenderTarget::GetCPUDescriptorHandleForDSV() co
         return {};
 }
 
+D3D12_CPU_DESCRIPTOR_HANDLE D3D12RenderTarget::GetCPUDescriptorHandleForNullRTV() const
+{
+    if (rtvDescHeap_)
+    {
+        /* Null RTV is stored after all regular and multi-sampled RTVs */
+        const auto numRenderTargets = static_cast<UINT>(colorFormats_.size());
+        D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle = rtvDescHeap_->GetCPUDescriptorHandleForHeapStart();
+        cpuDescHandle.ptr += rtvDescSize_ * (HasMultiSampling() ? numRenderTargets * 2 : numRenderTargets);
+        return cpuDescHandle;
+    }
+    else
+        return {};
+}
+
 bool D3D12RenderTarget::HasMultiSampling() const
 {
     return (sampleDesc_.Count > 1);
 }
 
+ID3D12Resource* D3D12RenderTarget::GetShadingRateImage() const
+{
+    return (shadingRateImage_ != nullptr ? shadingRateImage_->Get() : nullptr);
+}
+
 
 /*
  * ======= Private: =======
@@ -184,7 +233,7 @@ void D3D12RenderTarget::CreateDescriptorHeaps(D3D12Device& device, const RenderT
         D3D12_DESCRIPTOR_HEAP_DESC heapDesc;
         {
             heapDesc.Type           = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
-            heapDesc.NumDescriptors = (HasMultiSampling() ? numRenderTargets * 2 : numRenderTargets);
+            heapDesc.NumDescriptors = (HasMultiSampling() ? numRenderTargets * 2 : numRenderTargets) + 1; // +1 for null RTV
             heapDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
             heapDesc.NodeMask       = 0;
         }
@@ -244,6 +293,17 @@ void D3D12RenderTarget::CreateAttachments(ID3D12Device* device, const RenderTarg
             depthStencil_ = &depthStencilBuffer_;
         }
     }
+
+    /* Create null RTV to unbind color attachments between sub-passes */
+    if (rtvDescHeap_)
+    {
+        D3D12_RENDER_TARGET_VIEW_DESC nullRTVDesc = {};
+        {
+            nullRTVDesc.Format          = colorFormats_.front();
+            nullRTVDesc.ViewDimension   = D3D12_RTV_DIMENSION_TEXTURE2D;
+        }
+        device->CreateRenderTargetView(nullptr, &nullRTVDesc, GetCPUDescriptorHandleForNullRTV());
+    }
 }
 
 void D3D12RenderTarget::CreateColorBuffersMS(ID3D12Device* device, const RenderTargetDescriptor& desc, D3D12_CPU_DESCRIPTOR_HANDLE& cpuDescHandle)
@@ -45,13 +45,25 @@ class D3D12RenderTarget final : public RenderTarget
         D3D12RenderTarget(D3D12Device& device, const RenderTargetDescriptor& desc);
 
         void TransitionToOutputMerger(D3D12CommandContext& commandContext);
+
+        /*
+        Transitions the color attachments for a sub-pass: attachments that are only read as input attachments
+        are transitioned to shader resources and all others are transitioned back to render targets.
+        */
+        void TransitionToSubpass(D3D12CommandContext& commandContext, std::uint32_t colorAttachments, std::uint32_t inputAttachments);
         void ResolveRenderTarget(D3D12CommandContext& commandContext);
 
         D3D12_CPU_DESCRIPTOR_HANDLE GetCPUDescriptorHandleForRTV() const;
         D3D12_CPU_DESCRIPTOR_HANDLE GetCPUDescriptorHandleForDSV() const;
 
+        // Returns the CPU descriptor handle of a null RTV to unbind color attachments that are not used by a sub-pass.
+        D3D12_CPU_DESCRIPTOR_HANDLE GetCPUDescriptorHandleForNullRTV() const;
+
         bool HasMultiSampling() const;
 
+        // Returns the native shading-rate image of this render target or null if there is none.
+        ID3D12Resource* GetShadingRateImage() const;
+
     private:
 
         void CreateDescriptorHeaps(D3D12Device& device, const RenderTargetDescriptor& desc);
@@ -116,6 +128,7 @@ class D3D12RenderTarget final : public RenderTarget
         std::vector<D3D12Resource*>     colorBuffers_;
         std::vector<ColorBufferMS>      colorBuffersMS_;
         D3D12Resource*                  depthStencil_       = nullptr;
+        D3D12Resource*                  shadingRateImage_   = nullptr;
 
 };
 
@@ -7,13 +7,14 @@
 
 #include "D3D12Sampler.h"
 #include "../D3D12Types.h"
+#include "../../DXCommon/DXCore.h"
 
 
 namespace LLGL
 {
 
 
-D3D12Sampler::D3D12Sampler(const SamplerDescriptor& desc)
+D3D12Sampler::D3D12Sampler(ID3D12Device* device, const SamplerDescriptor& desc)
 {
     /* Translate and store to native sampler desctiptor */
     nativeDesc_.Filter          = D3D12Types::Map(desc);
@@ -38,6 +39,19 @@ D3D12Sampler::D3D12Sampler(const SamplerDescriptor& desc)
         nativeDesc_.MinLOD = 0.0f;
         nativeDesc_.MaxLOD = 0.0f;
     }
+
+    /* Create sampler descriptor once in a CPU-only descriptor heap, so resource heaps can copy it */
+    D3D12_DESCRIPTOR_HEAP_DESC heapDesc;
+    {
+        heapDesc.Type           = D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER;
+        heapDesc.NumDescriptors = 1;
+        heapDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+        heapDesc.NodeMask       = 0;
+    }
+    auto hr = device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(descHeap_.ReleaseAndGetAddressOf()));
+    DXThrowIfCreateFailed(hr, "ID3D12DescriptorHeap", "for sampler");
+
+    CreateResourceView(device, descHeap_->GetCPUDescriptorHandleForHeapStart());
 }
 
 void D3D12Sampler::CreateResourceView(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescriptorHandle)
@@ -10,6 +10,7 @@
 
 
 #include <LLGL/Sampler.h>
+#include "../../DXCommon/ComPtr.h"
 #include <d3d12.h>
 
 
@@ -22,13 +23,20 @@ class D3D12Sampler final : public Sampler
 
     public:
 
-        D3D12Sampler(const SamplerDescriptor& desc);
+        D3D12Sampler(ID3D12Device* device, const SamplerDescriptor& desc);
 
         void CreateResourceView(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescriptorHandle);
 
+        // Returns the CPU descriptor handle of this sampler in its CPU-only descriptor heap. This descriptor can be copied into other descriptor heaps.
+        inline D3D12_CPU_DESCRIPTOR_HANDLE GetDescHandle() const
+        {
+            return descHeap_->GetCPUDescriptorHandleForHeapStart();
+        }
+
     private:
 
-        D3D12_SAMPLER_DESC nativeDesc_;
+        D3D12_SAMPLER_DESC              nativeDesc_;
+        ComPtr<ID3D12DescriptorHeap>    descHeap_;
 
 };
 
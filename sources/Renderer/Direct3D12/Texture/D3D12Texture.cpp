@@ -7,6 +7,7 @@
 
 #include "D3D12Texture.h"
 #include "../Command/D3D12CommandContext.h"
+#include "../Command/D3D12CommandQueue.h"
 #include "../D3D12ObjectUtils.h"
 #include "../D3DX12/d3dx12.h"
 #include "../D3D12Types.h"
@@ -14,6 +15,7 @@
 #include "../../DXCommon/DXCore.h"
 #include "../../TextureUtils.h"
 #include "../../../Core/Helper.h"
+#include <LLGL/ResourceFlags.h>
 #include <algorithm>
 
 
@@ -21,15 +23,26 @@ namespace LLGL
 {
 
 
-D3D12Texture::D3D12Texture(ID3D12Device* device, const TextureDescriptor& desc) :
+D3D12Texture::D3D12Texture(ID3D12Device* device, D3D12MemoryManager& memoryMngr, const TextureDescriptor& desc) :
     Texture         { desc.type, desc.bindFlags          },
     format_         { DXTypes::ToDXGIFormat(desc.format) },
     numMipLevels_   { NumMipLevels(desc)                 },
     numArrayLayers_ { std::max(1u, desc.arrayLayers)     }
 {
-    CreateNativeTexture(device, desc);
-    if (SupportsGenerateMips())
-        CreateMipDescHeap(device);
+    CreateNativeTexture(device, memoryMngr, desc);
+    if (sparse_)
+        InitSparseTiles(device);
+    CreateDescHeaps(device);
+}
+
+D3D12Texture::D3D12Texture(ID3D12Device* device, const TextureDescriptor& desc, const NativeResourceHandle& nativeHandle) :
+    Texture         { desc.type, desc.bindFlags          },
+    format_         { DXTypes::ToDXGIFormat(desc.format) },
+    numMipLevels_   { NumMipLevels(desc)                 },
+    numArrayLayers_ { std::max(1u, desc.arrayLayers)     }
+{
+    ImportNativeTexture(device, desc, nativeHandle);
+    CreateDescHeaps(device);
 }
 
 void D3D12Texture::SetName(const char* name)
@@ -153,8 +166,9 @@ void D3D12Texture::UpdateSubresource(
     firstArrayLayer = std::min(firstArrayLayer, numArrayLayers_ - 1u);
     numArrayLayers  = std::min(numArrayLayers, numArrayLayers_ - firstArrayLayer);
 
-    /* Create the GPU upload buffer */
-    UINT64 uploadBufferSize     = GetRequiredIntermediateSize(resource_.native.Get(), 0, 1) * numArrayLayers;
+    /* Create the GPU upload buffer; each array layer occupies an aligned range, independent of the source slice pitch */
+    UINT64 uploadLayerSize      = GetAlignedSize<UINT64>(GetRequiredIntermediateSize(resource_.native.Get(), 0, 1), D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+    UINT64 uploadBufferSize     = uploadLayerSize * numArrayLayers;
     UINT64 uploadBufferOffset   = 0;
 
     auto hr = device->CreateCommittedResource(
@@ -185,17 +199,8 @@ void D3D12Texture::UpdateSubresource(
 
         /* Move to next buffer region */
         subresourceData.pData = (reinterpret_cast<const std::int8_t*>(subresourceData.pData) + subresourceData.SlicePitch);
-        uploadBufferOffset += subresourceData.SlicePitch;
+        uploadBufferOffset += uploadLayerSize;
     }
-
-    /* Transition texture resource for shader access */
-    auto resourceBarrier = CD3DX12_RESOURCE_BARRIER::Transition(
-        resource_.native.Get(),
-        D3D12_RESOURCE_STATE_COPY_DEST,
-        resource_.usageState
-    );
-
-    commandList->ResourceBarrier(1, &resourceBarrier);
 }
 
 // Returns the memory footprint of a texture with row alignment
@@ -436,6 +441,14 @@ void D3D12Texture::CreateUnorderedAccessViewPrimary(
     device->CreateUnorderedAccessView(resource_.native.Get(), nullptr, &uavDesc, cpuDescHandle);
 }
 
+D3D12_CPU_DESCRIPTOR_HANDLE D3D12Texture::GetDefaultViewDescHandle(D3D12_DESCRIPTOR_RANGE_TYPE type) const
+{
+    if (type == D3D12_DESCRIPTOR_RANGE_TYPE_SRV || type == D3D12_DESCRIPTOR_RANGE_TYPE_UAV)
+        return defaultViewDescHandles_[type];
+    else
+        return D3D12_CPU_DESCRIPTOR_HANDLE{};
+}
+
 UINT D3D12Texture::CalcSubresource(UINT mipLevel, UINT arrayLayer) const
 {
     return D3D12CalcSubresource(mipLevel, arrayLayer, /*planeSlice: */0, numMipLevels_, numArrayLayers_);
@@ -516,6 +529,195 @@ static bool DXTextureSupportsGenerateMips(long bindFlags, UINT numMipLevels)
     return ((bindFlags & BindFlags::ColorAttachment) != 0 && numMipLevels > 1);
 }
 
+bool D3D12Texture::GetTiling(TextureTiling& outTiling) const
+{
+    if (!sparse_)
+        return false;
+
+    outTiling.tileExtent            = { tileShape_.WidthInTexels, tileShape_.HeightInTexels, tileShape_.DepthInTexels };
+    outTiling.tileSize              = D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+    outTiling.firstPackedMipLevel   = std::min<UINT>(packedMipInfo_.NumStandardMips, numMipLevels_);
+    outTiling.numMipLevels          = numMipLevels_;
+
+    return true;
+}
+
+void D3D12Texture::CommitTiles(
+    D3D12CommandQueue&      commandQueue,
+    D3D12MemoryManager&     memoryMngr,
+    const TextureRegion&    region,
+    bool                    commit)
+{
+    if (!sparse_)
+        return;
+
+    const UINT mipLevel     = region.subresource.baseMipLevel;
+    const UINT layerBegin   = std::min(region.subresource.baseArrayLayer, numArrayLayers_);
+    const UINT layerEnd     = std::min(region.subresource.baseArrayLayer + region.subresource.numArrayLayers, numArrayLayers_);
+
+    if (mipLevel >= numMipLevels_)
+        return;
+
+    auto queue = commandQueue.GetNative();
+
+    std::vector<D3D12_TILED_RESOURCE_COORDINATE>    unmappedCoords;
+    std::vector<D3D12_TILE_REGION_SIZE>             unmappedSizes;
+    std::vector<D3D12MemoryRegion>                  regionsToRelease;
+
+    auto UpdateTileMapping = [&](const D3D12_TILED_RESOURCE_COORDINATE& coord, const D3D12_TILE_REGION_SIZE& size, D3D12MemoryRegion& tileRegion)
+    {
+        if (commit)
+        {
+            /* Map tile region to newly allocated heap memory */
+            memoryMngr.AllocateTiles(size.NumTiles, tileRegion);
+
+            const D3D12_TILE_RANGE_FLAGS    rangeFlags      = D3D12_TILE_RANGE_FLAG_NONE;
+            const UINT                      heapRangeStart  = static_cast<UINT>(tileRegion.offset / D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES);
+            const UINT                      rangeTileCount  = size.NumTiles;
+
+            queue->UpdateTileMappings(
+                GetNative(),
+                1,
+                &coord,
+                &size,
+                tileRegion.heap->GetNative(),
+                1,
+                &rangeFlags,
+                &heapRangeStart,
+                &rangeTileCount,
+                D3D12_TILE_MAPPING_FLAG_NONE
+            );
+        }
+        else
+        {
+            /* Unmap tile region with a single NULL range after all regions have been gathered */
+            unmappedCoords.push_back(coord);
+            unmappedSizes.push_back(size);
+            regionsToRelease.push_back(tileRegion);
+            tileRegion = D3D12MemoryRegion{};
+        }
+    };
+
+    if (mipLevel >= packedMipInfo_.NumStandardMips)
+    {
+        /* Map or unmap packed MIP-maps of the selected array layers as a whole */
+        for (auto layer = layerBegin; layer < layerEnd; ++layer)
+        {
+            auto& packedMips = packedMips_[layer];
+            if ((packedMips.heap != nullptr) == commit)
+                continue;
+
+            D3D12_TILED_RESOURCE_COORDINATE coord = {};
+            coord.Subresource = CalcSubresource(packedMipInfo_.NumStandardMips, layer);
+
+            D3D12_TILE_REGION_SIZE size = {};
+            size.NumTiles = packedMipInfo_.NumTilesForPackedMips;
+            size.UseBox   = FALSE;
+
+            UpdateTileMapping(coord, size, packedMips);
+        }
+    }
+    else
+    {
+        /* Map or unmap each tile within the region */
+        const auto& tiling = mipTilings_[mipLevel];
+
+        auto GetTileRange = [](std::int32_t offset, std::uint32_t extent, UINT tileExtent, UINT numTiles, UINT& outBegin, UINT& outEnd)
+        {
+            const auto begin = static_cast<UINT>(std::max(0, offset));
+            outBegin    = std::min(begin / tileExtent, numTiles);
+            outEnd      = std::min((begin + extent + tileExtent - 1) / tileExtent, numTiles);
+        };
+
+        UINT tileBeginX, tileEndX, tileBeginY, tileEndY;
+        GetTileRange(region.offset.x, region.extent.width,  tileShape_.WidthInTexels,  tiling.WidthInTiles,  tileBeginX, tileEndX);
+        GetTileRange(region.offset.y, region.extent.height, tileShape_.HeightInTexels, tiling.HeightInTiles, tileBeginY, tileEndY);
+
+        for (auto layer = layerBegin; layer < layerEnd; ++layer)
+        {
+            const auto firstTile = GetTileIndex(layer, mipLevel);
+
+            for (auto y = tileBeginY; y < tileEndY; ++y)
+            {
+                for (auto x = tileBeginX; x < tileEndX; ++x)
+                {
+                    auto& tile = tiles_[firstTile + y * tiling.WidthInTiles + x];
+                    if ((tile.heap != nullptr) == commit)
+                        continue;
+
+                    D3D12_TILED_RESOURCE_COORDINATE coord;
+                    {
+                        coord.X             = x;
+                        coord.Y             = y;
+                        coord.Z             = 0;
+                        coord.Subresource   = CalcSubresource(mipLevel, layer);
+                    }
+
+                    D3D12_TILE_REGION_SIZE size = {};
+                    size.NumTiles = 1;
+                    size.UseBox   = FALSE;
+
+                    UpdateTileMapping(coord, size, tile);
+                }
+            }
+        }
+    }
+
+    if (!unmappedCoords.empty())
+    {
+        /* Unmap all gathered tile regions with a single NULL range */
+        const D3D12_TILE_RANGE_FLAGS rangeFlags = D3D12_TILE_RANGE_FLAG_NULL;
+
+        queue->UpdateTileMappings(
+            GetNative(),
+            static_cast<UINT>(unmappedCoords.size()),
+            unmappedCoords.data(),
+            unmappedSizes.data(),
+            nullptr,
+            1,
+            &rangeFlags,
+            nullptr,
+            nullptr,
+            D3D12_TILE_MAPPING_FLAG_NONE
+        );
+
+        /* Wait until the tiles have been unmapped before their heap memory can be reused or released */
+        commandQueue.WaitIdle();
+
+        for (auto& tileRegion : regionsToRelease)
+            memoryMngr.Release(tileRegion);
+    }
+}
+
+void D3D12Texture::ReleaseTiles(D3D12MemoryManager& memoryMngr)
+{
+    for (auto& tile : tiles_)
+        memoryMngr.Release(tile);
+    for (auto& packedMips : packedMips_)
+        memoryMngr.Release(packedMips);
+}
+
+bool D3D12Texture::CreateSharedHandle(ID3D12Device* device, NativeResourceHandle& outHandle) const
+{
+    if (!shared_)
+        return false;
+
+    HANDLE handle = nullptr;
+    auto hr = device->CreateSharedHandle(GetNative(), nullptr, GENERIC_ALL, nullptr, &handle);
+    if (FAILED(hr))
+        return false;
+
+    const auto resourceDesc = GetNative()->GetDesc();
+
+    outHandle.type          = NativeHandleType::D3D12SharedHandle;
+    outHandle.object        = reinterpret_cast<std::uintptr_t>(handle);
+    outHandle.memory        = 0;
+    outHandle.memoryOffset  = 0;
+    outHandle.memorySize    = device->GetResourceAllocationInfo(0, 1, &resourceDesc).SizeInBytes;
+
+    return true;
+}
+
 bool D3D12Texture::SupportsGenerateMips() const
 {
     return DXTextureSupportsGenerateMips(GetBindFlags(), GetNumMipLevels());
@@ -613,12 +815,31 @@ static D3D12_RESOURCE_STATES GetInitialDXResourceState(const TextureDescriptor&
     return flags;
 }
 
-void D3D12Texture::CreateNativeTexture(ID3D12Device* device, const TextureDescriptor& desc)
+void D3D12Texture::CreateNativeTexture(ID3D12Device* device, D3D12MemoryManager& memoryMngr, const TextureDescriptor& desc)
 {
     /* Setup resource descriptor by texture descriptor and create hardware resource */
     D3D12_RESOURCE_DESC descD3D;
     Convert(descD3D, desc);
 
+    /* Create reserved resource without any memory for sparse textures; its tiles are mapped later */
+    sparse_ = ((desc.miscFlags & MiscFlags::Sparse) != 0);
+    if (sparse_)
+    {
+        descD3D.Layout = D3D12_TEXTURE_LAYOUT_64KB_UNDEFINED_SWIZZLE;
+
+        auto hr = device->CreateReservedResource(
+            &descD3D,
+            D3D12_RESOURCE_STATE_COPY_DEST,
+            nullptr,
+            IID_PPV_ARGS(resource_.native.ReleaseAndGetAddressOf())
+        );
+        DXThrowIfCreateFailed(hr, "ID3D12Resource", "for reserved texture");
+
+        resource_.transitionState   = D3D12_RESOURCE_STATE_COPY_DEST;
+        resource_.usageState        = GetInitialDXResourceState(desc);
+        return;
+    }
+
     /* Get optimal clear value (if specified) */
     bool useClearValue = ((desc.bindFlags & (BindFlags::ColorAttachment | BindFlags::DepthStencilAttachment)) != 0);
 
@@ -638,22 +859,107 @@ void D3D12Texture::CreateNativeTexture(ID3D12Device* device, const TextureDescri
         optClearValue.DepthStencil.Stencil  = static_cast<UINT8>(desc.clearValue.stencil);
     }
 
-    /* Create hardware resource for the texture */
-    auto hr = device->CreateCommittedResource(
-        &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
-        D3D12_HEAP_FLAG_NONE,
-        &descD3D,
-        D3D12_RESOURCE_STATE_COPY_DEST,
-        (useClearValue ? &optClearValue : nullptr),
-        IID_PPV_ARGS(resource_.native.ReleaseAndGetAddressOf())
-    );
-    DXThrowIfCreateFailed(hr, "ID3D12Resource", "for D3D12 hardware texture");
+    shared_ = ((desc.miscFlags & MiscFlags::Shared) != 0);
+    if (shared_)
+    {
+        /* Create committed resource in its own shared heap, so it can be opened by other devices or processes */
+        auto hr = device->CreateCommittedResource(
+            &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
+            D3D12_HEAP_FLAG_SHARED,
+            &descD3D,
+            D3D12_RESOURCE_STATE_COPY_DEST,
+            (useClearValue ? &optClearValue : nullptr),
+            IID_PPV_ARGS(resource_.native.ReleaseAndGetAddressOf())
+        );
+        DXThrowIfCreateFailed(hr, "ID3D12Resource", "for shared texture");
+    }
+    else
+    {
+        /* Create hardware resource for the texture within a placed resource heap */
+        memoryMngr.CreateResource(
+            D3D12_HEAP_TYPE_DEFAULT,
+            descD3D,
+            D3D12_RESOURCE_STATE_COPY_DEST,
+            (useClearValue ? &optClearValue : nullptr),
+            resource_.native,
+            memoryRegion_
+        );
+    }
 
     /* Determine resource usage */
     resource_.transitionState   = D3D12_RESOURCE_STATE_COPY_DEST;
     resource_.usageState        = GetInitialDXResourceState(desc);
 }
 
+void D3D12Texture::ImportNativeTexture(ID3D12Device* device, const TextureDescriptor& desc, const NativeResourceHandle& nativeHandle)
+{
+    switch (nativeHandle.type)
+    {
+        case NativeHandleType::D3D12Resource:
+            /* Take reference of native resource */
+            resource_.native = reinterpret_cast<ID3D12Resource*>(static_cast<std::uintptr_t>(nativeHandle.object));
+            break;
+
+        case NativeHandleType::OpaqueWin32:
+        case NativeHandleType::D3D12SharedHandle:
+        {
+            /* Open shared handle as new resource that refers to the same memory */
+            auto handle = reinterpret_cast<HANDLE>(static_cast<std::uintptr_t>(nativeHandle.object));
+            auto hr = device->OpenSharedHandle(handle, IID_PPV_ARGS(resource_.native.ReleaseAndGetAddressOf()));
+            DXThrowIfFailed(hr, "failed to open shared handle for D3D12 texture");
+        }
+        break;
+
+        default:
+            throw std::invalid_argument("cannot import D3D12 texture from unsupported native handle type");
+    }
+
+    /* Imported resources are expected to be in the common state */
+    resource_.transitionState   = D3D12_RESOURCE_STATE_COMMON;
+    resource_.usageState        = GetInitialDXResourceState(desc);
+}
+
+void D3D12Texture::InitSparseTiles(ID3D12Device* device)
+{
+    /* Query tiling of all standard MIP-map levels of the first array layer; all other layers have the same tiling */
+    UINT numTiles           = 0;
+    UINT numSubresources    = numMipLevels_;
+    mipTilings_.resize(numMipLevels_);
+
+    device->GetResourceTiling(
+        GetNative(),
+        &numTiles,
+        &packedMipInfo_,
+        &tileShape_,
+        &numSubresources,
+        0,
+        mipTilings_.data()
+    );
+
+    /* Initialize tile lists for all standard MIP-map levels */
+    const auto numStandardMips = std::min<UINT>(packedMipInfo_.NumStandardMips, numMipLevels_);
+
+    mipTilings_.resize(numStandardMips);
+    mipTileOffsets_.resize(numStandardMips);
+    numTilesPerLayer_ = 0;
+
+    for (UINT mip = 0; mip < numStandardMips; ++mip)
+    {
+        mipTileOffsets_[mip] = numTilesPerLayer_;
+        numTilesPerLayer_ += mipTilings_[mip].WidthInTiles * mipTilings_[mip].HeightInTiles * mipTilings_[mip].DepthInTiles;
+    }
+
+    tiles_.resize(numTilesPerLayer_ * numArrayLayers_);
+
+    if (packedMipInfo_.NumPackedMips > 0)
+        packedMips_.resize(numArrayLayers_);
+}
+
+std::size_t D3D12Texture::GetTileIndex(UINT arrayLayer, UINT mipLevel) const
+{
+    return (arrayLayer * numTilesPerLayer_ + mipTileOffsets_[mipLevel]);
+}
+
 // Determine SRV dimension for descriptor heaps used in D3D12MipGenerator: either 1D array, 2D array, or 3D
 static D3D12_SRV_DIMENSION GetMipChainSRVDimension(const TextureType type)
 {
@@ -698,6 +1004,50 @@ static D3D12_UAV_DIMENSION GetMipChainUAVDimension(const TextureType type)
     return D3D12_UAV_DIMENSION_UNKNOWN;
 }
 
+void D3D12Texture::CreateDescHeaps(ID3D12Device* device)
+{
+    CreateDefaultViewDescHeap(device);
+    if (SupportsGenerateMips())
+        CreateMipDescHeap(device);
+}
+
+void D3D12Texture::CreateDefaultViewDescHeap(ID3D12Device* device)
+{
+    const bool hasSRV = ((GetBindFlags() & BindFlags::Sampled) != 0);
+    const bool hasUAV = ((GetBindFlags() & BindFlags::Storage) != 0 && !IsMultiSampleTexture(GetType()));
+
+    const UINT numDescriptors = static_cast<UINT>(hasSRV) + static_cast<UINT>(hasUAV);
+    if (numDescriptors == 0)
+        return;
+
+    /* Create CPU-only descriptor heap for the default views; shader-visible heaps must not be used as copy source */
+    D3D12_DESCRIPTOR_HEAP_DESC heapDesc;
+    {
+        heapDesc.Type           = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+        heapDesc.NumDescriptors = numDescriptors;
+        heapDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+        heapDesc.NodeMask       = 0;
+    }
+    auto hr = device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(defaultViewDescHeap_.ReleaseAndGetAddressOf()));
+    DXThrowIfFailed(hr, "failed to create D3D12 descriptor heap for texture default views");
+
+    /* Create default views in consecutive descriptors */
+    auto descSize       = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    auto cpuDescHandle  = defaultViewDescHeap_->GetCPUDescriptorHandleForHeapStart();
+
+    if (hasSRV)
+    {
+        CreateShaderResourceView(device, cpuDescHandle);
+        defaultViewDescHandles_[D3D12_DESCRIPTOR_RANGE_TYPE_SRV] = cpuDescHandle;
+        cpuDescHandle.ptr += descSize;
+    }
+    if (hasUAV)
+    {
+        CreateUnorderedAccessView(device, cpuDescHandle);
+        defaultViewDescHandles_[D3D12_DESCRIPTOR_RANGE_TYPE_UAV] = cpuDescHandle;
+    }
+}
+
 void D3D12Texture::CreateMipDescHeap(ID3D12Device* device)
 {
     /* Create descriptor heap for all MIP-map levels */
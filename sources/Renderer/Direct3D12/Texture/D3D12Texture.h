@@ -11,6 +11,7 @@
 
 #include <LLGL/Texture.h>
 #include "../D3D12Resource.h"
+#include "../Memory/D3D12MemoryManager.h"
 #include <vector>
 
 
@@ -20,6 +21,7 @@ namespace LLGL
 
 class D3D12Buffer;
 class D3D12CommandContext;
+class D3D12CommandQueue;
 
 class D3D12Texture final : public Texture
 {
@@ -36,8 +38,12 @@ class D3D12Texture final : public Texture
 
     public:
 
-        D3D12Texture(ID3D12Device* device, const TextureDescriptor& desc);
+        D3D12Texture(ID3D12Device* device, D3D12MemoryManager& memoryMngr, const TextureDescriptor& desc);
 
+        // Imports a native ID3D12Resource or opens a shared handle. Such resources are expected to be in the D3D12_RESOURCE_STATE_COMMON state.
+        D3D12Texture(ID3D12Device* device, const TextureDescriptor& desc, const NativeResourceHandle& nativeHandle);
+
+        // Records the copy commands to upload the specified subresource data. The texture must already be in the D3D12_RESOURCE_STATE_COPY_DEST state.
         void UpdateSubresource(
             ID3D12Device*               device,
             ID3D12GraphicsCommandList*  commandList,
@@ -65,6 +71,13 @@ class D3D12Texture final : public Texture
         void CreateUnorderedAccessView(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle);
         void CreateUnorderedAccessView(ID3D12Device* device, D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle, const TextureViewDescriptor& desc);
 
+        /*
+        Returns the CPU descriptor handle of the default view for the specified descriptor range type (SRV or UAV).
+        These views are created once in a CPU-only descriptor heap together with this texture and can be copied into other descriptor heaps.
+        The handle is null if this texture was not created with the respective binding flag.
+        */
+        D3D12_CPU_DESCRIPTOR_HANDLE GetDefaultViewDescHandle(D3D12_DESCRIPTOR_RANGE_TYPE type) const;
+
         // Returns the subresource index for the specified MIP-map level and array layer.
         UINT CalcSubresource(UINT mipLevel, UINT arrayLayer) const;
 
@@ -80,6 +93,23 @@ class D3D12Texture final : public Texture
         // Returns the texture region for the specified offset and extent with respect to the type of this texture (i.e. whether or not array layers are handled by the subresource index).
         D3D12_BOX CalcRegion(const Offset3D& offset, const Extent3D& extent) const;
 
+        // Queries the tiling properties of this texture. Returns false if this is not a sparse texture.
+        bool GetTiling(TextureTiling& outTiling) const;
+
+        // Maps or unmaps heap memory for all tiles of this reserved texture within the specified region.
+        void CommitTiles(
+            D3D12CommandQueue&      commandQueue,
+            D3D12MemoryManager&     memoryMngr,
+            const TextureRegion&    region,
+            bool                    commit
+        );
+
+        // Releases the heap memory of all committed tiles of this reserved texture.
+        void ReleaseTiles(D3D12MemoryManager& memoryMngr);
+
+        // Creates a new shared handle of this texture. Returns false if this texture was not created with the MiscFlags::Shared flag.
+        bool CreateSharedHandle(ID3D12Device* device, NativeResourceHandle& outHandle) const;
+
         // Returns true if MIP-maps can be generated for this texture .
         bool SupportsGenerateMips() const;
 
@@ -131,9 +161,33 @@ class D3D12Texture final : public Texture
             return mipDescHeap_.Get();
         }
 
+        // Returns the memory region of the native texture resource. The heap is null for committed resources.
+        inline D3D12MemoryRegion& GetMemoryRegion()
+        {
+            return memoryRegion_;
+        }
+
+        // Returns true if this texture is a reserved resource, i.e. it was created with MiscFlags::Sparse.
+        inline bool IsSparse() const
+        {
+            return sparse_;
+        }
+
     private:
 
-        void CreateNativeTexture(ID3D12Device* device, const TextureDescriptor& desc);
+        void CreateNativeTexture(ID3D12Device* device, D3D12MemoryManager& memoryMngr, const TextureDescriptor& desc);
+
+        // Opens the native resource of the specified native handle.
+        void ImportNativeTexture(ID3D12Device* device, const TextureDescriptor& desc, const NativeResourceHandle& nativeHandle);
+
+        // Creates the descriptor heaps for the default views and MIP-map generation.
+        void CreateDescHeaps(ID3D12Device* device);
+
+        // Queries the resource tiling and initializes the tile lists.
+        void InitSparseTiles(ID3D12Device* device);
+
+        // Returns the index of the first tile of the specified array layer and MIP-map level within the 'tiles_' list.
+        std::size_t GetTileIndex(UINT arrayLayer, UINT mipLevel) const;
 
         void CreateShaderResourceViewPrimary(
             ID3D12Device*               device,
@@ -152,18 +206,35 @@ class D3D12Texture final : public Texture
             D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle
         );
 
+        void CreateDefaultViewDescHeap(ID3D12Device* device);
         void CreateMipDescHeap(ID3D12Device* device);
 
     private:
 
         D3D12Resource                   resource_;
+        D3D12MemoryRegion               memoryRegion_;
 
         DXGI_FORMAT                     format_         = DXGI_FORMAT_UNKNOWN;
         UINT                            numMipLevels_   = 0;
         UINT                            numArrayLayers_ = 0;
 
+        ComPtr<ID3D12DescriptorHeap>    defaultViewDescHeap_;
+        D3D12_CPU_DESCRIPTOR_HANDLE     defaultViewDescHandles_[2]  = {};   // Indexed by D3D12_DESCRIPTOR_RANGE_TYPE (SRV, UAV)
+
         ComPtr<ID3D12DescriptorHeap>    mipDescHeap_;
 
+        bool                            shared_             = false;    // True if this texture was created with the MiscFlags::Shared flag.
+
+        /* Reserved resource tiling (only used if this texture was created with MiscFlags::Sparse) */
+        bool                            sparse_             = false;
+        D3D12_PACKED_MIP_INFO           packedMipInfo_      = {};
+        D3D12_TILE_SHAPE                tileShape_          = {};
+        std::vector<D3D12_SUBRESOURCE_TILING> mipTilings_;                  // Tiling of each standard MIP-map level.
+        std::vector<std::size_t>        mipTileOffsets_;                    // Offset of the first tile of each standard MIP-map level within a single array layer.
+        std::size_t                     numTilesPerLayer_   = 0;
+        std::vector<D3D12MemoryRegion>  tiles_;                             // Mapped tiles of all standard MIP-map levels. The heap is null for unmapped tiles.
+        std::vector<D3D12MemoryRegion>  packedMips_;                        // Mapped packed MIP-maps of each array layer.
+
 };
 
 
@@ -41,6 +41,15 @@ LLGL_EXPORT void* LLGL_RenderSystem_Alloc(const void* renderSystemDesc, int rend
 */
 LLGL_EXPORT void LLGL_RenderSystem_Free(void* renderSystem);
 
+/**
+\brief Enumerates all video adapters this render system module can be created on.
+\param[in] renderSystemDesc Raw pointer to the LLGL::RenderSystemDescriptor structure.
+\param[out] outAdapters Raw pointer to the output container of type std::vector<LLGL::VideoAdapterDescriptor>.
+\return Number of video adapters that have been appended to the output container.
+\remarks This function is optional and RenderSystem::QueryVideoAdapters returns an empty list if it is not present in a render system module.
+*/
+LLGL_EXPORT int LLGL_RenderSystem_QueryVideoAdapters(const void* renderSystemDesc, int renderSystemDescSize, void* outAdapters);
+
 #ifdef __cplusplus
 } // /extern "C"
 #endif
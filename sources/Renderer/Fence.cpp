@@ -0,0 +1,30 @@
+/*
+ * Fence.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/Fence.h>
+
+
+namespace LLGL
+{
+
+
+std::uint64_t Fence::GetValue() const
+{
+    return 0;
+}
+
+std::uint64_t Fence::GetCompletedValue() const
+{
+    return 0;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
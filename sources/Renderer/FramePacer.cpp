@@ -0,0 +1,192 @@
+/*
+ * FramePacer.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/FramePacer.h>
+#include <LLGL/SwapChain.h>
+#include <LLGL/RenderingProfiler.h>
+#include <LLGL/Display.h>
+#include <LLGL/Timer.h>
+#include <algorithm>
+#include <thread>
+
+
+namespace LLGL
+{
+
+
+static constexpr double g_defaultRefreshRate = 60.0;
+
+struct FramePacer::Pimpl
+{
+    FramePacerDescriptor    desc;
+
+    double                  nominalPeriod   = 0.0;  // Nominal refresh period (in ticks)
+    double                  refreshPeriod   = 0.0;  // Calibrated refresh period (in ticks)
+    double                  spinTicks       = 0.0;
+
+    double                  nextDeadline    = 0.0;  // Deadline of the next frame (in ticks); accumulated as double to avoid rounding drift
+    bool                    hasDeadline     = false;
+
+    PresentStatistics       lastStats;
+    bool                    hasLastStats    = false;
+
+    std::uint64_t           missedVSyncs    = 0;
+
+    // Returns the frame interval (in ticks).
+    double GetFrameTicks() const
+    {
+        return refreshPeriod * static_cast<double>(desc.interval);
+    }
+
+    // Updates the refresh period and returns the number of missed vertical blanks from the presentation statistics, or -1 if they are unavailable.
+    long long UpdatePresentStatistics();
+
+    // Reports the specified number of missed vertical blanks.
+    void ReportMissedVSyncs(std::uint64_t count);
+};
+
+long long FramePacer::Pimpl::UpdatePresentStatistics()
+{
+    PresentStatistics stats;
+    if (desc.swapChain == nullptr || !desc.swapChain->QueryPresentStatistics(stats))
+        return -1;
+
+    long long missed = 0;
+
+    if (hasLastStats && stats.presentCount > lastStats.presentCount && stats.refreshCount >= lastStats.refreshCount)
+    {
+        const auto presentDelta = stats.presentCount - lastStats.presentCount;
+        const auto refreshDelta = stats.refreshCount - lastStats.refreshCount;
+
+        /* Each displayed frame should occupy exactly 'interval' refresh cycles; every additional cycle is a missed vertical blank */
+        const auto expectedDelta = presentDelta * desc.interval;
+        if (refreshDelta > expectedDelta)
+            missed = static_cast<long long>(refreshDelta - expectedDelta);
+
+        /* Calibrate refresh period from the time between two vertical blanks, unless the swap-chain reports the period directly */
+        if (stats.refreshPeriod == 0 && refreshDelta > 0 && stats.syncTime > lastStats.syncTime && lastStats.syncTime != 0)
+        {
+            const double measuredPeriod = static_cast<double>(stats.syncTime - lastStats.syncTime) / static_cast<double>(refreshDelta);
+
+            /* Reject outliers, e.g. after a display mode change, and smooth out the jitter of the time stamps */
+            if (measuredPeriod > nominalPeriod * 0.9 && measuredPeriod < nominalPeriod * 1.1)
+                refreshPeriod += (measuredPeriod - refreshPeriod) * 0.1;
+        }
+    }
+
+    if (stats.refreshPeriod != 0)
+        refreshPeriod = static_cast<double>(stats.refreshPeriod);
+
+    lastStats       = stats;
+    hasLastStats    = true;
+
+    return missed;
+}
+
+void FramePacer::Pimpl::ReportMissedVSyncs(std::uint64_t count)
+{
+    missedVSyncs += count;
+    if (desc.profiler != nullptr)
+        desc.profiler->frameProfile.missedVSyncs += static_cast<std::uint32_t>(count);
+}
+
+// Returns the refresh rate of the primary display or the default refresh rate if it is unknown.
+static double GetPrimaryDisplayRefreshRate()
+{
+    if (auto display = Display::GetPrimary())
+    {
+        const auto refreshRate = display->GetDisplayMode().refreshRate;
+        if (refreshRate > 0)
+            return static_cast<double>(refreshRate);
+    }
+    return g_defaultRefreshRate;
+}
+
+FramePacer::FramePacer(const FramePacerDescriptor& desc) :
+    pimpl_ { new Pimpl{} }
+{
+    pimpl_->desc            = desc;
+    pimpl_->desc.interval   = std::max(1u, desc.interval);
+
+    const double refreshRate    = (desc.refreshRate > 0.0 ? desc.refreshRate : GetPrimaryDisplayRefreshRate());
+    const double frequency      = static_cast<double>(Timer::Frequency());
+
+    pimpl_->nominalPeriod   = frequency / refreshRate;
+    pimpl_->refreshPeriod   = pimpl_->nominalPeriod;
+    pimpl_->spinTicks       = frequency * static_cast<double>(desc.spinTime) / 1.0e6;
+}
+
+FramePacer::~FramePacer()
+{
+    delete pimpl_;
+}
+
+void FramePacer::Wait()
+{
+    /* Missed vertical blanks are taken from the display if possible, otherwise from the CPU timer below */
+    const long long displayMissed = pimpl_->UpdatePresentStatistics();
+    if (displayMissed > 0)
+        pimpl_->ReportMissedVSyncs(static_cast<std::uint64_t>(displayMissed));
+
+    const double frameTicks = pimpl_->GetFrameTicks();
+    auto now = static_cast<double>(Timer::Tick());
+
+    if (!pimpl_->hasDeadline)
+    {
+        /* First frame only establishes the deadline grid */
+        pimpl_->nextDeadline    = now + frameTicks;
+        pimpl_->hasDeadline     = true;
+        return;
+    }
+
+    const double deadline = pimpl_->nextDeadline;
+
+    if (now < deadline)
+    {
+        /* Block until shortly before the deadline, then spin for the remainder to compensate for the scheduler's wake up latency */
+        if (now < deadline - pimpl_->spinTicks)
+            Timer::WaitUntil(static_cast<std::uint64_t>(deadline - pimpl_->spinTicks));
+
+        while (static_cast<double>(Timer::Tick()) < deadline)
+            std::this_thread::yield();
+
+        pimpl_->nextDeadline = deadline + frameTicks;
+    }
+    else
+    {
+        /* Frame was late: skip all intervals that have passed and stay on the same grid, so the next frames are not rushed */
+        const auto missedIntervals = static_cast<std::uint64_t>((now - deadline) / frameTicks);
+        pimpl_->nextDeadline = deadline + static_cast<double>(missedIntervals + 1) * frameTicks;
+
+        if (displayMissed < 0 && missedIntervals > 0)
+            pimpl_->ReportMissedVSyncs(missedIntervals * pimpl_->desc.interval);
+    }
+}
+
+void FramePacer::Reset()
+{
+    pimpl_->hasDeadline     = false;
+    pimpl_->hasLastStats    = false;
+    pimpl_->missedVSyncs    = 0;
+}
+
+double FramePacer::GetFrameInterval() const
+{
+    return pimpl_->GetFrameTicks() / static_cast<double>(Timer::Frequency());
+}
+
+std::uint64_t FramePacer::GetMissedVSyncs() const
+{
+    return pimpl_->missedVSyncs;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
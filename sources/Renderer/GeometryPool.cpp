@@ -0,0 +1,616 @@
+/*
+ * GeometryPool.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/GeometryPool.h>
+#include <LLGL/RenderSystem.h>
+#include "../Core/Helper.h"
+#include <algorithm>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+static constexpr std::uint32_t g_invalidPageIndex = ~0u;
+
+
+/* ----- Internal structures ----- */
+
+struct GeometryPoolRange
+{
+    std::uint32_t offset;
+    std::uint32_t count;
+};
+
+// First-fit allocator for ranges of vertices or indices within a single page.
+class GeometryPoolRangeAllocator
+{
+
+    public:
+
+        void Reset(std::uint32_t capacity, std::uint32_t used = 0)
+        {
+            freeRanges_.clear();
+            if (used < capacity)
+                freeRanges_.push_back(GeometryPoolRange{ used, capacity - used });
+        }
+
+        bool Allocate(std::uint32_t count, std::uint32_t& outOffset)
+        {
+            for (auto it = freeRanges_.begin(); it != freeRanges_.end(); ++it)
+            {
+                if (it->count >= count)
+                {
+                    outOffset = it->offset;
+                    it->offset += count;
+                    it->count  -= count;
+                    if (it->count == 0)
+                        freeRanges_.erase(it);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool CanAllocate(std::uint32_t count) const
+        {
+            for (const auto& range : freeRanges_)
+            {
+                if (range.count >= count)
+                    return true;
+            }
+            return false;
+        }
+
+        // Returns the range to the free list and merges it with its adjacent free ranges.
+        void Free(std::uint32_t offset, std::uint32_t count)
+        {
+            auto it = std::lower_bound(
+                freeRanges_.begin(), freeRanges_.end(), offset,
+                [](const GeometryPoolRange& lhs, std::uint32_t rhs)
+                {
+                    return (lhs.offset < rhs);
+                }
+            );
+
+            it = freeRanges_.insert(it, GeometryPoolRange{ offset, count });
+
+            auto next = it + 1;
+            if (next != freeRanges_.end() && it->offset + it->count == next->offset)
+            {
+                it->count += next->count;
+                freeRanges_.erase(next);
+            }
+
+            if (it != freeRanges_.begin())
+            {
+                auto prev = it - 1;
+                if (prev->offset + prev->count == it->offset)
+                {
+                    prev->count += it->count;
+                    freeRanges_.erase(it);
+                }
+            }
+        }
+
+    private:
+
+        std::vector<GeometryPoolRange> freeRanges_; // Sorted by offset; adjacent ranges are always merged.
+
+};
+
+struct GeometryPoolPage
+{
+    Buffer*                     vertexBuffer    = nullptr;
+    Buffer*                     indexBuffer     = nullptr;
+    std::uint32_t               vertexCapacity  = 0;
+    std::uint32_t               indexCapacity   = 0;
+    GeometryPoolRangeAllocator  vertices;
+    GeometryPoolRangeAllocator  indices;
+};
+
+// Range of vertices or indices that is copied from an old page into a new page during defragmentation.
+struct GeometryPoolCopy
+{
+    std::uint32_t srcPage;
+    std::uint32_t srcOffset;
+    std::uint32_t dstPage;
+    std::uint32_t dstOffset;
+    std::uint32_t count;
+};
+
+struct GeometryPoolEntry
+{
+    bool            alive               = false;
+    std::uint32_t   page                = 0;
+    std::uint32_t   firstVertex         = 0;
+    std::uint32_t   numVertices         = 0;
+    std::uint32_t   firstIndex          = 0;
+    std::uint32_t   numIndices          = 0;
+    std::uint32_t   numIndicesReserved  = 0; // Number of indices rounded up to the index granularity
+};
+
+
+/*
+ * Pimpl structure
+ */
+
+struct GeometryPool::Pimpl
+{
+    Pimpl(RenderSystem& renderSystem, const GeometryPoolDescriptor& poolDesc);
+    ~Pimpl();
+
+    bool CreatePageBuffers(GeometryPoolPage& page);
+    void ReleasePageBuffers(GeometryPoolPage& page);
+
+    std::uint32_t FindOrCreatePage(std::uint32_t numVertices, std::uint32_t numIndices);
+
+    const GeometryPoolEntry* FindEntry(GeometryPoolHandle handle) const;
+
+    RenderSystem&                   renderSystem;
+    GeometryPoolDescriptor          desc;
+    std::vector<VertexAttribute>    vertexAttribs;
+    std::uint32_t                   vertexStride        = 0;
+    std::uint32_t                   indexSize           = 4;
+    std::uint32_t                   indexGranularity    = 1; // 16-bit indices are reserved in pairs to keep byte offsets 4-byte aligned for copy commands
+
+    std::vector<GeometryPoolPage>   pages;
+    std::vector<GeometryPoolEntry>  entries;
+    std::vector<GeometryPoolHandle> freeHandles;
+
+    std::uint64_t                   numAllocatedVertices    = 0;
+    std::uint64_t                   numAllocatedIndices     = 0;
+};
+
+GeometryPool::Pimpl::Pimpl(RenderSystem& renderSystem, const GeometryPoolDescriptor& poolDesc) :
+    renderSystem  { renderSystem                                                   },
+    desc          { poolDesc                                                       },
+    vertexAttribs { poolDesc.vertexAttribs.begin(), poolDesc.vertexAttribs.end() }
+{
+    desc.vertexAttribs = vertexAttribs;
+
+    if (!vertexAttribs.empty())
+        vertexStride = vertexAttribs.front().stride;
+
+    if (desc.indexFormat == Format::R16UInt)
+    {
+        indexSize           = 2;
+        indexGranularity    = 2;
+    }
+    else
+        desc.indexFormat = Format::R32UInt;
+}
+
+GeometryPool::Pimpl::~Pimpl()
+{
+    for (auto& page : pages)
+        ReleasePageBuffers(page);
+}
+
+bool GeometryPool::Pimpl::CreatePageBuffers(GeometryPoolPage& page)
+{
+    const long bindFlags = (desc.bindFlags | BindFlags::CopySrc | BindFlags::CopyDst);
+
+    BufferDescriptor vertexBufferDesc;
+    {
+        vertexBufferDesc.size           = static_cast<std::uint64_t>(page.vertexCapacity) * vertexStride;
+        vertexBufferDesc.bindFlags      = (bindFlags | BindFlags::VertexBuffer);
+        vertexBufferDesc.miscFlags      = MiscFlags::NoInitialData;
+        vertexBufferDesc.vertexAttribs  = vertexAttribs;
+    }
+    page.vertexBuffer = renderSystem.CreateBuffer(vertexBufferDesc);
+
+    BufferDescriptor indexBufferDesc;
+    {
+        indexBufferDesc.size            = static_cast<std::uint64_t>(std::max(page.indexCapacity, indexGranularity)) * indexSize;
+        indexBufferDesc.format          = desc.indexFormat;
+        indexBufferDesc.bindFlags       = (bindFlags | BindFlags::IndexBuffer);
+        indexBufferDesc.miscFlags       = MiscFlags::NoInitialData;
+    }
+    page.indexBuffer = renderSystem.CreateBuffer(indexBufferDesc);
+
+    if (page.vertexBuffer == nullptr || page.indexBuffer == nullptr)
+    {
+        ReleasePageBuffers(page);
+        return false;
+    }
+
+    return true;
+}
+
+void GeometryPool::Pimpl::ReleasePageBuffers(GeometryPoolPage& page)
+{
+    if (page.vertexBuffer != nullptr)
+    {
+        renderSystem.Release(*page.vertexBuffer);
+        page.vertexBuffer = nullptr;
+    }
+    if (page.indexBuffer != nullptr)
+    {
+        renderSystem.Release(*page.indexBuffer);
+        page.indexBuffer = nullptr;
+    }
+}
+
+std::uint32_t GeometryPool::Pimpl::FindOrCreatePage(std::uint32_t numVertices, std::uint32_t numIndices)
+{
+    /* Find first page where both vertices and indices fit into */
+    for (std::size_t i = 0; i < pages.size(); ++i)
+    {
+        const auto& page = pages[i];
+        if (page.vertices.CanAllocate(numVertices) && (numIndices == 0 || page.indices.CanAllocate(numIndices)))
+            return static_cast<std::uint32_t>(i);
+    }
+
+    /* Create new page; allocations that are larger than the page capacity get a dedicated page */
+    GeometryPoolPage page;
+    {
+        page.vertexCapacity = std::max(numVertices, desc.verticesPerPage);
+        page.indexCapacity  = GetAlignedSize(std::max(numIndices, desc.indicesPerPage), indexGranularity);
+    }
+    if (!CreatePageBuffers(page))
+        return g_invalidPageIndex;
+
+    page.vertices.Reset(page.vertexCapacity);
+    page.indices.Reset(page.indexCapacity);
+    pages.push_back(page);
+
+    return static_cast<std::uint32_t>(pages.size() - 1);
+}
+
+const GeometryPoolEntry* GeometryPool::Pimpl::FindEntry(GeometryPoolHandle handle) const
+{
+    if (handle < entries.size() && entries[handle].alive)
+        return &(entries[handle]);
+    return nullptr;
+}
+
+
+/*
+ * GeometryPool class
+ */
+
+GeometryPool::GeometryPool(RenderSystem& renderSystem, const GeometryPoolDescriptor& poolDesc) :
+    pimpl_ { new Pimpl{ renderSystem, poolDesc } }
+{
+}
+
+GeometryPool::~GeometryPool()
+{
+    delete pimpl_;
+}
+
+GeometryPoolHandle GeometryPool::Allocate(std::uint32_t numVertices, std::uint32_t numIndices, const void* vertices, const void* indices)
+{
+    if (numVertices == 0 || pimpl_->vertexStride == 0)
+        return Constants::invalidGeometryPoolHandle;
+
+    const std::uint32_t numIndicesReserved = GetAlignedSize(numIndices, pimpl_->indexGranularity);
+
+    /* Sub-allocate vertex and index ranges from the same page */
+    const std::uint32_t pageIndex = pimpl_->FindOrCreatePage(numVertices, numIndicesReserved);
+    if (pageIndex == g_invalidPageIndex)
+        return Constants::invalidGeometryPoolHandle;
+
+    auto& page = pimpl_->pages[pageIndex];
+
+    GeometryPoolEntry entry;
+    {
+        entry.alive                 = true;
+        entry.page                  = pageIndex;
+        entry.numVertices           = numVertices;
+        entry.numIndices            = numIndices;
+        entry.numIndicesReserved    = numIndicesReserved;
+    }
+    page.vertices.Allocate(numVertices, entry.firstVertex);
+    if (numIndicesReserved > 0)
+        page.indices.Allocate(numIndicesReserved, entry.firstIndex);
+
+    /* Upload initial data */
+    if (vertices != nullptr)
+    {
+        pimpl_->renderSystem.WriteBuffer(
+            *page.vertexBuffer,
+            static_cast<std::uint64_t>(entry.firstVertex) * pimpl_->vertexStride,
+            vertices,
+            static_cast<std::uint64_t>(numVertices) * pimpl_->vertexStride
+        );
+    }
+    if (indices != nullptr && numIndices > 0)
+    {
+        pimpl_->renderSystem.WriteBuffer(
+            *page.indexBuffer,
+            static_cast<std::uint64_t>(entry.firstIndex) * pimpl_->indexSize,
+            indices,
+            static_cast<std::uint64_t>(numIndices) * pimpl_->indexSize
+        );
+    }
+
+    pimpl_->numAllocatedVertices    += numVertices;
+    pimpl_->numAllocatedIndices     += numIndices;
+
+    /* Store entry in a recycled or new handle */
+    GeometryPoolHandle handle;
+    if (!pimpl_->freeHandles.empty())
+    {
+        handle = pimpl_->freeHandles.back();
+        pimpl_->freeHandles.pop_back();
+        pimpl_->entries[handle] = entry;
+    }
+    else
+    {
+        handle = static_cast<GeometryPoolHandle>(pimpl_->entries.size());
+        pimpl_->entries.push_back(entry);
+    }
+
+    return handle;
+}
+
+void GeometryPool::Free(GeometryPoolHandle handle)
+{
+    if (pimpl_->FindEntry(handle) == nullptr)
+        return;
+
+    auto& entry = pimpl_->entries[handle];
+    auto& page  = pimpl_->pages[entry.page];
+
+    page.vertices.Free(entry.firstVertex, entry.numVertices);
+    if (entry.numIndicesReserved > 0)
+        page.indices.Free(entry.firstIndex, entry.numIndicesReserved);
+
+    pimpl_->numAllocatedVertices    -= entry.numVertices;
+    pimpl_->numAllocatedIndices     -= entry.numIndices;
+
+    entry.alive = false;
+    pimpl_->freeHandles.push_back(handle);
+}
+
+bool GeometryPool::GetAllocation(GeometryPoolHandle handle, GeometryPoolAllocation& outAllocation) const
+{
+    if (auto entry = pimpl_->FindEntry(handle))
+    {
+        const auto& page = pimpl_->pages[entry->page];
+        outAllocation.vertexBuffer  = page.vertexBuffer;
+        outAllocation.indexBuffer   = page.indexBuffer;
+        outAllocation.page          = entry->page;
+        outAllocation.firstVertex   = entry->firstVertex;
+        outAllocation.numVertices   = entry->numVertices;
+        outAllocation.firstIndex    = entry->firstIndex;
+        outAllocation.numIndices    = entry->numIndices;
+        return true;
+    }
+    outAllocation = GeometryPoolAllocation{};
+    return false;
+}
+
+bool GeometryPool::GetDrawArguments(
+    GeometryPoolHandle              handle,
+    DrawIndexedIndirectArguments&   outArgs,
+    std::uint32_t                   numInstances,
+    std::uint32_t                   firstInstance) const
+{
+    if (auto entry = pimpl_->FindEntry(handle))
+    {
+        outArgs.numIndices      = entry->numIndices;
+        outArgs.numInstances    = numInstances;
+        outArgs.firstIndex      = entry->firstIndex;
+        outArgs.vertexOffset    = static_cast<std::int32_t>(entry->firstVertex);
+        outArgs.firstInstance   = firstInstance;
+        return true;
+    }
+    return false;
+}
+
+// Appends a copy range or extends the previous one if both its source and destination ranges are contiguous.
+static void AppendCopyRange(std::vector<GeometryPoolCopy>& copies, const GeometryPoolCopy& copy)
+{
+    if (!copies.empty())
+    {
+        auto& prev = copies.back();
+        if (prev.srcPage == copy.srcPage && prev.dstPage == copy.dstPage &&
+            prev.srcOffset + prev.count == copy.srcOffset &&
+            prev.dstOffset + prev.count == copy.dstOffset)
+        {
+            prev.count += copy.count;
+            return;
+        }
+    }
+    copies.push_back(copy);
+}
+
+bool GeometryPool::Defragment()
+{
+    /* Gather live entries in their current order, so the relative placement of the geometry is preserved */
+    std::vector<GeometryPoolEntry*> liveEntries;
+    liveEntries.reserve(pimpl_->entries.size() - pimpl_->freeHandles.size());
+    for (auto& entry : pimpl_->entries)
+    {
+        if (entry.alive)
+            liveEntries.push_back(&entry);
+    }
+
+    std::sort(
+        liveEntries.begin(), liveEntries.end(),
+        [](const GeometryPoolEntry* lhs, const GeometryPoolEntry* rhs)
+        {
+            if (lhs->page != rhs->page)
+                return (lhs->page < rhs->page);
+            return (lhs->firstVertex < rhs->firstVertex);
+        }
+    );
+
+    /* Pack all entries into a compact layout of new pages */
+    struct PackedEntry
+    {
+        std::uint32_t page;
+        std::uint32_t firstVertex;
+        std::uint32_t firstIndex;
+    };
+
+    std::vector<PackedEntry>        packedEntries(liveEntries.size());
+    std::vector<GeometryPoolPage>   newPages;
+    std::vector<std::uint32_t>      usedVertices, usedIndices;
+
+    for (std::size_t i = 0; i < liveEntries.size(); ++i)
+    {
+        const auto* entry = liveEntries[i];
+
+        if (newPages.empty() ||
+            usedVertices.back() + entry->numVertices        > newPages.back().vertexCapacity ||
+            usedIndices.back()  + entry->numIndicesReserved > newPages.back().indexCapacity)
+        {
+            GeometryPoolPage page;
+            {
+                page.vertexCapacity = std::max(entry->numVertices, pimpl_->desc.verticesPerPage);
+                page.indexCapacity  = GetAlignedSize(std::max(entry->numIndicesReserved, pimpl_->desc.indicesPerPage), pimpl_->indexGranularity);
+            }
+            newPages.push_back(page);
+            usedVertices.push_back(0);
+            usedIndices.push_back(0);
+        }
+
+        auto& packed = packedEntries[i];
+        {
+            packed.page         = static_cast<std::uint32_t>(newPages.size() - 1);
+            packed.firstVertex  = usedVertices.back();
+            packed.firstIndex   = (entry->numIndicesReserved > 0 ? usedIndices.back() : 0);
+        }
+        usedVertices.back() += entry->numVertices;
+        usedIndices.back()  += entry->numIndicesReserved;
+    }
+
+    /* Nothing to do if the layout has not changed */
+    bool moved = (newPages.size() != pimpl_->pages.size());
+    for (std::size_t i = 0; !moved && i < liveEntries.size(); ++i)
+    {
+        const auto* entry = liveEntries[i];
+        const auto& packed = packedEntries[i];
+        moved = (packed.page != entry->page || packed.firstVertex != entry->firstVertex || packed.firstIndex != entry->firstIndex);
+    }
+
+    if (!moved)
+        return false;
+
+    /* Create buffers for the new pages */
+    for (auto& page : newPages)
+    {
+        if (!pimpl_->CreatePageBuffers(page))
+        {
+            for (auto& createdPage : newPages)
+                pimpl_->ReleasePageBuffers(createdPage);
+            return false;
+        }
+    }
+
+    /* Merge contiguous ranges into as few copy commands as possible */
+    std::vector<GeometryPoolCopy> vertexCopies, indexCopies;
+    for (std::size_t i = 0; i < liveEntries.size(); ++i)
+    {
+        const auto* entry = liveEntries[i];
+        const auto& packed = packedEntries[i];
+        AppendCopyRange(vertexCopies, GeometryPoolCopy{ entry->page, entry->firstVertex, packed.page, packed.firstVertex, entry->numVertices });
+        if (entry->numIndicesReserved > 0)
+            AppendCopyRange(indexCopies, GeometryPoolCopy{ entry->page, entry->firstIndex, packed.page, packed.firstIndex, entry->numIndicesReserved });
+    }
+
+    /* Encode all copy commands into a single immediate command buffer and wait for the GPU to finish them */
+    auto& renderSystem = pimpl_->renderSystem;
+    if (auto cmdBuffer = renderSystem.CreateCommandBuffer(CommandBufferFlags::ImmediateSubmit))
+    {
+        cmdBuffer->Begin();
+        {
+            const std::uint64_t vertexStride = pimpl_->vertexStride;
+            for (const auto& copy : vertexCopies)
+            {
+                cmdBuffer->CopyBuffer(
+                    *newPages[copy.dstPage].vertexBuffer,
+                    copy.dstOffset * vertexStride,
+                    *pimpl_->pages[copy.srcPage].vertexBuffer,
+                    copy.srcOffset * vertexStride,
+                    copy.count * vertexStride
+                );
+            }
+
+            const std::uint64_t indexSize = pimpl_->indexSize;
+            for (const auto& copy : indexCopies)
+            {
+                cmdBuffer->CopyBuffer(
+                    *newPages[copy.dstPage].indexBuffer,
+                    copy.dstOffset * indexSize,
+                    *pimpl_->pages[copy.srcPage].indexBuffer,
+                    copy.srcOffset * indexSize,
+                    copy.count * indexSize
+                );
+            }
+        }
+        cmdBuffer->End();
+
+        renderSystem.GetCommandQueue()->WaitIdle();
+        renderSystem.Release(*cmdBuffer);
+    }
+    else
+    {
+        for (auto& page : newPages)
+            pimpl_->ReleasePageBuffers(page);
+        return false;
+    }
+
+    /* Replace old pages and update entries and free lists */
+    for (auto& page : pimpl_->pages)
+        pimpl_->ReleasePageBuffers(page);
+
+    for (std::size_t i = 0; i < newPages.size(); ++i)
+    {
+        newPages[i].vertices.Reset(newPages[i].vertexCapacity, usedVertices[i]);
+        newPages[i].indices.Reset(newPages[i].indexCapacity, usedIndices[i]);
+    }
+    pimpl_->pages = std::move(newPages);
+
+    for (std::size_t i = 0; i < liveEntries.size(); ++i)
+    {
+        auto* entry = liveEntries[i];
+        const auto& packed = packedEntries[i];
+        entry->page         = packed.page;
+        entry->firstVertex  = packed.firstVertex;
+        entry->firstIndex   = packed.firstIndex;
+    }
+
+    return true;
+}
+
+std::uint32_t GeometryPool::GetNumPages() const
+{
+    return static_cast<std::uint32_t>(pimpl_->pages.size());
+}
+
+Buffer* GeometryPool::GetVertexBuffer(std::uint32_t page) const
+{
+    return (page < pimpl_->pages.size() ? pimpl_->pages[page].vertexBuffer : nullptr);
+}
+
+Buffer* GeometryPool::GetIndexBuffer(std::uint32_t page) const
+{
+    return (page < pimpl_->pages.size() ? pimpl_->pages[page].indexBuffer : nullptr);
+}
+
+std::uint64_t GeometryPool::GetNumAllocatedVertices() const
+{
+    return pimpl_->numAllocatedVertices;
+}
+
+std::uint64_t GeometryPool::GetNumAllocatedIndices() const
+{
+    return pimpl_->numAllocatedIndices;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -13,12 +13,28 @@
 
 #include <LLGL/Platform/Platform.h>
 #include <LLGL/Buffer.h>
+#include <atomic>
+#include <memory>
 
 
 namespace LLGL
 {
 
 
+class MTMemoryManager;
+
+/*
+Tracks the command buffers that reference a buffer in shared memory, so it can be written by the CPU directly when no GPU work is pending on it.
+This object is shared with the command buffers, so it outlives its buffer while any of them is still in flight.
+*/
+struct MTBufferUsage
+{
+    std::atomic<std::uint32_t>  numCmdBuffers   { 0 };  // Number of command buffers that are being encoded or in flight and reference the buffer.
+    std::atomic<std::uint64_t>  lastRecording   { 0 };  // ID of the last command buffer recording that references the buffer (see MTCommandBuffer::TrackBufferUsage).
+};
+
+using MTBufferUsagePtr = std::shared_ptr<MTBufferUsage>;
+
 class MTBuffer final : public Buffer
 {
 
@@ -28,7 +44,11 @@ class MTBuffer final : public Buffer
 
     public:
 
-        MTBuffer(id<MTLDevice> device, const BufferDescriptor& desc, const void* initialData);
+        MTBuffer(MTMemoryManager& memoryMngr, const BufferDescriptor& desc, const void* initialData);
+
+        // Imports the specified native buffer and retains it.
+        MTBuffer(const BufferDescriptor& desc, id<MTLBuffer> native);
+
         ~MTBuffer();
 
         void Write(NSUInteger offset, const void* data, NSUInteger dataSize);
@@ -50,14 +70,44 @@ class MTBuffer final : public Buffer
             return indexType16Bits_;
         }
 
+        // Returns the usage tracker of this buffer or null if this buffer does not reside in shared memory.
+        inline const MTBufferUsagePtr& GetUsage() const
+        {
+            return usage_;
+        }
+
+        // Returns true if this buffer resides in shared memory and is not referenced by any command buffer that is being encoded or in flight.
+        inline bool IsIdleInSharedMemory() const
+        {
+            return (usage_ && usage_->numCmdBuffers.load() == 0);
+        }
+
+        // Returns the native MTLIndirectCommandBuffer object or nil if this buffer was not created with MiscFlags::IndirectCommands.
+        inline id<MTLIndirectCommandBuffer> GetIndirectCommandBuffer() const
+        {
+            return indirectCommandBuffer_;
+        }
+
+    public:
+
+        // Number of bytes each indirect command occupies within the range of a buffer with MiscFlags::IndirectCommands.
+        static const NSUInteger indirectCommandStride;
+
+    private:
+
+        // Creates the indirect command buffer and encodes it into the native buffer, which serves as argument buffer for compute shaders.
+        void CreateIndirectCommandBuffer(id<MTLDevice> device, const BufferDescriptor& desc);
+
     private:
 
-        id<MTLBuffer>   native_             = nil;
-        bool            indexType16Bits_    = false;
+        id<MTLBuffer>                   native_                 = nil;
+        id<MTLIndirectCommandBuffer>    indirectCommandBuffer_  = nil;
+        bool                            indexType16Bits_        = false;
         #ifndef LLGL_OS_IOS
-        bool            isManaged_          = false;
+        bool                            isManaged_              = false;
         #endif
-        NSRange         mappedWriteRange_   = { 0, 0 };
+        NSRange                         mappedWriteRange_       = { 0, 0 };
+        MTBufferUsagePtr                usage_;                             // Only for buffers with MTLStorageModeShared.
 
 };
 
@@ -6,19 +6,29 @@
  */
 
 #include "MTBuffer.h"
+#include "../MTMemoryManager.h"
 #include "../../ResourceUtils.h"
+#include <LLGL/IndirectArguments.h>
 #include <string.h>
+#include <algorithm>
+#include <stdexcept>
 
 
 namespace LLGL
 {
 
 
-static MTLResourceOptions GetMTLResourceOptions(const BufferDescriptor& desc)
+static MTLResourceOptions GetMTLResourceOptions(id<MTLDevice> device, const BufferDescriptor& desc)
 {
     #ifdef LLGL_OS_IOS
     return MTLResourceStorageModeShared;
     #else
+    /* GPUs with unified memory (e.g. Apple silicon) have no separate video memory, so managed storage would only add synchronization overhead */
+    if (@available(macOS 10.15, *))
+    {
+        if ([device hasUnifiedMemory])
+            return MTLResourceStorageModeShared;
+    }
     if ((desc.miscFlags & MiscFlags::DynamicUsage) != 0)
         return MTLResourceStorageModeShared;
     //else if ((desc.bindFlags & BindFlags::Storage) != 0)
@@ -28,32 +38,74 @@ static MTLResourceOptions GetMTLResourceOptions(const BufferDescriptor& desc)
     #endif
 }
 
-MTBuffer::MTBuffer(id<MTLDevice> device, const BufferDescriptor& desc, const void* initialData) :
+const NSUInteger MTBuffer::indirectCommandStride = sizeof(DrawIndexedIndirectArguments);
+
+MTBuffer::MTBuffer(MTMemoryManager& memoryMngr, const BufferDescriptor& desc, const void* initialData) :
     Buffer           { desc.bindFlags                   },
     indexType16Bits_ { (desc.format == Format::R16UInt) }
 {
-    auto opt = GetMTLResourceOptions(desc);
+    /* Indirect command buffers are encoded by the GPU, so they neither have a storage mode nor initial data */
+    if ((desc.miscFlags & MiscFlags::IndirectCommands) != 0)
+    {
+        CreateIndirectCommandBuffer(memoryMngr.GetDevice(), desc);
+        return;
+    }
+
+    auto opt = GetMTLResourceOptions(memoryMngr.GetDevice(), desc);
 
     #ifndef LLGL_OS_IOS
     isManaged_ = ((opt & MTLResourceStorageModeManaged) != 0);
     #endif
 
+    /* Buffer may be sub-allocated from a heap, so initial data is copied into its contents afterwards */
+    native_ = memoryMngr.NewBuffer(static_cast<NSUInteger>(desc.size), opt);
+    if (native_ == nil)
+        throw std::runtime_error("failed to create Metal buffer");
+
+    /* Track command buffers that reference shared buffers, so they can be updated without a blit command when the GPU is not using them */
+    if ((opt & MTLResourceStorageModeMask) == MTLResourceStorageModeShared)
+        usage_ = std::make_shared<MTBufferUsage>();
+
     if (initialData)
-        native_ = [device newBufferWithBytes:initialData length:(NSUInteger)desc.size options:opt];
-    else
-        native_ = [device newBufferWithLength:(NSUInteger)desc.size options:opt];
+    {
+        ::memcpy([native_ contents], initialData, static_cast<std::size_t>(desc.size));
+        #ifndef LLGL_OS_IOS
+        if (isManaged_)
+            [native_ didModifyRange:NSMakeRange(0, static_cast<NSUInteger>(desc.size))];
+        #endif
+    }
+}
+
+MTBuffer::MTBuffer(const BufferDescriptor& desc, id<MTLBuffer> native) :
+    Buffer           { desc.bindFlags                   },
+    native_          { [native retain]                  },
+    indexType16Bits_ { (desc.format == Format::R16UInt) }
+{
+    #ifndef LLGL_OS_IOS
+    isManaged_ = ([native_ storageMode] == MTLStorageModeManaged);
+    #endif
+
+    if ([native_ storageMode] == MTLStorageModeShared)
+        usage_ = std::make_shared<MTBufferUsage>();
 }
 
 MTBuffer::~MTBuffer()
 {
     [native_ release];
+    [indirectCommandBuffer_ release];
 }
 
 BufferDescriptor MTBuffer::GetDesc() const
 {
     BufferDescriptor bufferDesc;
 
-    bufferDesc.size             = [native_ length];
+    if (indirectCommandBuffer_ != nil)
+    {
+        if (@available(macOS 10.14, iOS 12.0, *))
+            bufferDesc.size     = [indirectCommandBuffer_ size] * MTBuffer::indirectCommandStride;
+    }
+    else
+        bufferDesc.size         = [native_ length];
     bufferDesc.bindFlags        = GetBindFlags();
     #if 0//TODO
     bufferDesc.cpuAccessFlags   = 0;
@@ -108,6 +160,50 @@ void MTBuffer::Unmap()
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+void MTBuffer::CreateIndirectCommandBuffer(id<MTLDevice> device, const BufferDescriptor& desc)
+{
+    if ((desc.bindFlags & BindFlags::IndirectBuffer) == 0)
+        throw std::invalid_argument("cannot create Metal indirect command buffer without 'LLGL::BindFlags::IndirectBuffer' flag");
+
+    if (@available(macOS 10.14, iOS 13.0, *))
+    {
+        /* Draw commands inherit the graphics PSO and all buffers (i.e. vertex buffers and resource heaps) from the render command encoder */
+        MTLIndirectCommandBufferDescriptor* icbDesc = [[MTLIndirectCommandBufferDescriptor alloc] init];
+        {
+            icbDesc.commandTypes            = (MTLIndirectCommandTypeDraw | MTLIndirectCommandTypeDrawIndexed);
+            icbDesc.inheritPipelineState    = YES;
+            icbDesc.inheritBuffers          = YES;
+        }
+        const NSUInteger maxCommandCount = std::max<NSUInteger>(1, static_cast<NSUInteger>(desc.size) / MTBuffer::indirectCommandStride);
+        indirectCommandBuffer_ = [device newIndirectCommandBufferWithDescriptor:icbDesc maxCommandCount:maxCommandCount options:0];
+        [icbDesc release];
+
+        if (indirectCommandBuffer_ == nil)
+            throw std::runtime_error("failed to create Metal indirect command buffer");
+
+        /* Encode indirect command buffer at argument index 0, so compute shaders can encode draw commands into it */
+        MTLArgumentDescriptor* argumentDesc = [[MTLArgumentDescriptor alloc] init];
+        {
+            argumentDesc.dataType   = MTLDataTypeIndirectCommandBuffer;
+            argumentDesc.index      = 0;
+        }
+        id<MTLArgumentEncoder> argumentEncoder = [device newArgumentEncoderWithArguments:@[argumentDesc]];
+        [argumentDesc release];
+
+        native_ = [device newBufferWithLength:[argumentEncoder encodedLength] options:MTLResourceStorageModeShared];
+        [argumentEncoder setArgumentBuffer:native_ offset:0];
+        [argumentEncoder setIndirectCommandBuffer:indirectCommandBuffer_ atIndex:0];
+        [argumentEncoder release];
+    }
+    else
+        throw std::runtime_error("cannot create Metal indirect command buffer for this version of the Metal API");
+}
+
+
 } // /namespace LLGL
 
 
@@ -12,6 +12,7 @@
 #import <Metal/Metal.h>
 
 #include <LLGL/BufferArray.h>
+#include "MTBuffer.h"
 #include <vector>
 
 
@@ -28,7 +29,7 @@ class MTBufferArray final : public BufferArray
 
         using NativeType = id<MTLBuffer>;
 
-        MTBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray);
+        MTBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets = nullptr);
 
         // Returns the array of buffer IDs.
         inline const std::vector<NativeType>& GetIDArray() const
@@ -42,10 +43,17 @@ class MTBufferArray final : public BufferArray
             return offsets_;
         }
 
+        // Returns the usage trackers of all buffers in this array that reside in shared memory.
+        inline const std::vector<MTBufferUsagePtr>& GetBufferUsages() const
+        {
+            return bufferUsages_;
+        }
+
     private:
 
-        std::vector<NativeType> idArray_;
-        std::vector<NSUInteger> offsets_;
+        std::vector<NativeType>         idArray_;
+        std::vector<NSUInteger>         offsets_;
+        std::vector<MTBufferUsagePtr>   bufferUsages_;
 
 };
 
@@ -16,16 +16,18 @@ namespace LLGL
 {
 
 
-MTBufferArray::MTBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray) :
+MTBufferArray::MTBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets) :
     BufferArray { GetCombinedBindFlags(numBuffers, bufferArray) }
 {
     /* Store id<MTLBuffer> of each buffer object inside the array */
     idArray_.reserve(numBuffers);
     offsets_.reserve(numBuffers);
-    while (auto next = NextArrayResource<MTBuffer>(numBuffers, bufferArray))
+    for (std::size_t i = 0; auto next = NextArrayResource<MTBuffer>(numBuffers, bufferArray); ++i)
     {
         idArray_.push_back(next->GetNative());
-        offsets_.push_back(0);
+        offsets_.push_back(offsets != nullptr ? static_cast<NSUInteger>(offsets[i]) : 0);
+        if (const MTBufferUsagePtr& usage = next->GetUsage())
+            bufferUsages_.push_back(usage);
     }
 }
 
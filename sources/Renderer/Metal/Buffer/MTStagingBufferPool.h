@@ -13,21 +13,30 @@
 
 #include "MTStagingBuffer.h"
 #include <vector>
+#include <memory>
+#include <atomic>
+#include <cstdint>
 
 
 namespace LLGL
 {
 
 
+/*
+Staging buffer pool with one set of chunks per frame in flight.
+Each chunk set is released through the completed handler of the command buffer that consumed it,
+so the CPU never has to wait until a command buffer is completed before it can write into the pool again.
+*/
 class MTStagingBufferPool
 {
 
     public:
 
         MTStagingBufferPool(id<MTLDevice> device, NSUInteger chunkSize);
-    
-        void Reset();
-    
+
+        // Switches to a chunk set that is no longer in flight and releases it with the completed handler of the specified command buffer.
+        void Reset(id<MTLCommandBuffer> cmdBuffer);
+
         void Write(
             const void*     data,
             NSUInteger      dataSize,
@@ -35,16 +44,40 @@ class MTStagingBufferPool
             NSUInteger&     srcOffset
         );
 
+        // Returns the highest number of bytes that have been in flight within all chunk sets at the same time.
+        inline std::uint64_t GetHighWaterMark() const
+        {
+            return highWaterMark_;
+        }
+
+    private:
+
+        struct ChunkSet
+        {
+            std::vector<MTStagingBuffer>    chunks;
+            std::size_t                     chunkIdx    = 0;
+            std::atomic<bool>               inFlight    { false };
+        };
+
+        using ChunkSetPtr = std::shared_ptr<ChunkSet>;
+
     private:
-    
-        void AllocChunk(NSUInteger minChunkSize);
-    
+
+        // Returns the next chunk set that is no longer in flight, or inserts a new chunk set.
+        ChunkSet& NextChunkSet();
+
+        void AllocChunk(ChunkSet& chunkSet, NSUInteger minChunkSize);
+
+        // Updates the high-water mark with the number of bytes of all chunk sets that are still in flight.
+        void UpdateHighWaterMark();
+
     private:
 
-        id<MTLDevice>                   device_     = nil;
-        std::vector<MTStagingBuffer>    chunks_;
-        std::size_t                     chunkIdx_   = 0;
-        NSUInteger                      chunkSize_  = 0;
+        id<MTLDevice>               device_         = nil;
+        std::vector<ChunkSetPtr>    chunkSets_;
+        std::size_t                 chunkSetIdx_    = 0;
+        NSUInteger                  chunkSize_      = 0;
+        std::uint64_t               highWaterMark_  = 0;
 
 };
 
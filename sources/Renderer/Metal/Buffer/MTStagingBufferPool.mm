@@ -6,6 +6,7 @@
  */
 
 #include "MTStagingBufferPool.h"
+#include "../../../Core/ProfilerZone.h"
 #include <algorithm>
 
 
@@ -19,11 +20,25 @@ MTStagingBufferPool::MTStagingBufferPool(id<MTLDevice> device, NSUInteger chunkS
 {
 }
 
-void MTStagingBufferPool::Reset()
+void MTStagingBufferPool::Reset(id<MTLCommandBuffer> cmdBuffer)
 {
-    for (auto& chunk : chunks_)
+    UpdateHighWaterMark();
+
+    /* Rewind all chunks of the next available chunk set */
+    auto& chunkSet = NextChunkSet();
+    for (auto& chunk : chunkSet.chunks)
         chunk.Reset();
-    chunkIdx_ = 0;
+    chunkSet.chunkIdx = 0;
+
+    /* Keep chunk set in flight until the GPU is done with the command buffer that consumes it */
+    chunkSet.inFlight = true;
+    ChunkSetPtr blockChunkSet = chunkSets_[chunkSetIdx_];
+    [cmdBuffer
+        addCompletedHandler:^(id<MTLCommandBuffer> cmdBuffer)
+        {
+            blockChunkSet->inFlight = false;
+        }
+    ];
 }
 
 void MTStagingBufferPool::Write(
@@ -32,18 +47,20 @@ void MTStagingBufferPool::Write(
     id<MTLBuffer>&  srcBuffer,
     NSUInteger&     srcOffset)
 {
+    auto& chunkSet = *chunkSets_[chunkSetIdx_];
+
     /* Check if a new chunk must be allocated */
-    if (chunkIdx_ == chunks_.size())
-        AllocChunk(dataSize);
-    else if (!chunks_[chunkIdx_].Capacity(dataSize))
+    if (chunkSet.chunkIdx == chunkSet.chunks.size())
+        AllocChunk(chunkSet, dataSize);
+    else if (!chunkSet.chunks[chunkSet.chunkIdx].Capacity(dataSize))
     {
-        ++chunkIdx_;
-        if (chunkIdx_ == chunks_.size())
-            AllocChunk(dataSize);
+        ++chunkSet.chunkIdx;
+        if (chunkSet.chunkIdx == chunkSet.chunks.size())
+            AllocChunk(chunkSet, dataSize);
     }
 
     /* Write data to current chunk */
-    auto& chunk = chunks_[chunkIdx_];
+    auto& chunk = chunkSet.chunks[chunkSet.chunkIdx];
     srcOffset = chunk.GetOffset();
     srcBuffer = chunk.GetNative();
     chunk.Write(data, dataSize);
@@ -54,10 +71,46 @@ void MTStagingBufferPool::Write(
  * ======= Private: =======
  */
 
-void MTStagingBufferPool::AllocChunk(NSUInteger minChunkSize)
+MTStagingBufferPool::ChunkSet& MTStagingBufferPool::NextChunkSet()
+{
+    /* Find next chunk set in round-robin order that the GPU is done with */
+    for (std::size_t i = 1; i <= chunkSets_.size(); ++i)
+    {
+        const std::size_t idx = (chunkSetIdx_ + i) % chunkSets_.size();
+        if (!chunkSets_[idx]->inFlight)
+        {
+            chunkSetIdx_ = idx;
+            return *chunkSets_[idx];
+        }
+    }
+
+    /* All chunk sets are in flight, so insert a new one after the current one to keep the oldest-to-newest order */
+    const std::size_t idx = (chunkSets_.empty() ? 0 : chunkSetIdx_ + 1);
+    chunkSets_.insert(chunkSets_.begin() + idx, std::make_shared<ChunkSet>());
+    chunkSetIdx_ = idx;
+    return *chunkSets_[idx];
+}
+
+void MTStagingBufferPool::AllocChunk(ChunkSet& chunkSet, NSUInteger minChunkSize)
 {
-    chunks_.emplace_back(device_, std::max(chunkSize_, minChunkSize));
-    chunkIdx_ = chunks_.size() - 1;
+    LLGL_PROFILER_ZONE("MTStagingBufferPool::AllocChunk");
+
+    chunkSet.chunks.emplace_back(device_, std::max(chunkSize_, minChunkSize));
+    chunkSet.chunkIdx = chunkSet.chunks.size() - 1;
+}
+
+void MTStagingBufferPool::UpdateHighWaterMark()
+{
+    std::uint64_t bytesInFlight = 0;
+    for (const auto& chunkSet : chunkSets_)
+    {
+        if (chunkSet->inFlight)
+        {
+            for (const auto& chunk : chunkSet->chunks)
+                bytesInFlight += chunk.GetOffset();
+        }
+    }
+    highWaterMark_ = std::max(highWaterMark_, bytesInFlight);
 }
 
 
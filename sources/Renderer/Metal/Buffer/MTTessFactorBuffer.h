@@ -11,33 +11,67 @@
 
 #import <Metal/Metal.h>
 
+#include <vector>
+#include <memory>
+#include <atomic>
+
 
 namespace LLGL
 {
 
 
-// Helper class to manage an internal <MTLBuffer> for tessellation factors.
+/*
+Helper class to manage internal <MTLBuffer> objects for tessellation factors.
+All tessellated draws of a command buffer allocate disjoint ranges from the same buffer, and there is one buffer per frame in flight.
+Each buffer only grows: if a frame requires more tessellation factors than fit into its buffer, that buffer is replaced by a larger one,
+and all buffers of the ring are grown to the highest demand of previous frames when they are reused.
+*/
 class MTTessFactorBuffer
 {
 
     public:
 
         MTTessFactorBuffer(id<MTLDevice> device, NSUInteger initialSize = 0);
-        ~MTTessFactorBuffer();
 
-        // Allocates a new buffer if the specified size is larger than the previous one.
-        void Grow(NSUInteger size);
+        // Switches to the next buffer that is no longer in flight and releases it with the completed handler of the specified command buffer.
+        void Reset(id<MTLCommandBuffer> cmdBuffer);
 
-        // Returns the native MTLBuffer object.
+        // Allocates a range of the specified size within the current buffer and returns its offset. This may replace the current buffer.
+        NSUInteger Allocate(NSUInteger size);
+
+        // Returns the native MTLBuffer object of the current frame.
         inline id<MTLBuffer> GetNative() const
         {
-            return native_;
+            return (frames_.empty() ? nil : frames_[frameIdx_]->native);
         }
 
     private:
 
-        id<MTLDevice> device_ = nil;
-        id<MTLBuffer> native_ = nil;
+        struct Frame
+        {
+            ~Frame();
+
+            id<MTLBuffer>       native      = nil;
+            NSUInteger          offset      = 0;
+            std::atomic<bool>   inFlight    { false };
+        };
+
+        using FramePtr = std::shared_ptr<Frame>;
+
+    private:
+
+        // Returns the next frame that is no longer in flight, or inserts a new frame.
+        Frame& NextFrame();
+
+        // Replaces the native buffer of the specified frame by a new buffer of at least the specified size.
+        void GrowFrame(Frame& frame, NSUInteger size);
+
+    private:
+
+        id<MTLDevice>           device_         = nil;
+        std::vector<FramePtr>   frames_;
+        std::size_t             frameIdx_       = 0;
+        NSUInteger              maxFrameSize_   = 0;
 
 };
 
@@ -7,36 +7,107 @@
 
 #include "MTTessFactorBuffer.h"
 #include "../../../Core/Helper.h"
+#include <algorithm>
 
 
 namespace LLGL
 {
 
 
+// Alignment of each allocated range; this satisfies the offset requirements of both compute and render command encoders.
+static const NSUInteger g_tessFactorRangeAlignment = 256;
+
 MTTessFactorBuffer::MTTessFactorBuffer(id<MTLDevice> device, NSUInteger initialSize) :
-    device_ { device }
+    device_       { device                                                      },
+    maxFrameSize_ { GetAlignedSize(initialSize, g_tessFactorRangeAlignment)     }
+{
+}
+
+MTTessFactorBuffer::Frame::~Frame()
 {
+    [native release];
 }
 
-MTTessFactorBuffer::~MTTessFactorBuffer()
+void MTTessFactorBuffer::Reset(id<MTLCommandBuffer> cmdBuffer)
 {
-    [native_ release];
+    /* Track highest demand of the previous frame, so the next buffers are large enough right away */
+    if (!frames_.empty())
+        maxFrameSize_ = std::max(maxFrameSize_, frames_[frameIdx_]->offset);
+
+    /* Rewind next available frame and grow its buffer to the highest demand */
+    auto& frame = NextFrame();
+    frame.offset = 0;
+    if (maxFrameSize_ > 0 && (frame.native == nil || [frame.native length] < maxFrameSize_))
+        GrowFrame(frame, maxFrameSize_);
+
+    /* Keep frame in flight until the GPU is done with the command buffer that consumes it */
+    frame.inFlight = true;
+    FramePtr blockFrame = frames_[frameIdx_];
+    [cmdBuffer
+        addCompletedHandler:^(id<MTLCommandBuffer> cmdBuffer)
+        {
+            blockFrame->inFlight = false;
+        }
+    ];
 }
 
-void MTTessFactorBuffer::Grow(NSUInteger size)
+NSUInteger MTTessFactorBuffer::Allocate(NSUInteger size)
 {
-    if (size > 0 && (native_ == nil || size > [native_ length]))
+    if (frames_.empty())
+        NextFrame();
+
+    auto& frame = *frames_[frameIdx_];
+    if (size == 0)
+        return frame.offset;
+
+    size = GetAlignedSize(size, g_tessFactorRangeAlignment);
+
+    /*
+    Replace buffer by a larger one if the range does not fit anymore.
+    Previous draw commands of this frame still refer to the old buffer, which is retained by the command buffer.
+    */
+    if (frame.native == nil || frame.offset + size > [frame.native length])
     {
-        /* Release previous native buffer */
-        if (native_ != nil)
-            [native_ release];
+        maxFrameSize_ = std::max(maxFrameSize_, frame.offset + size);
+        GrowFrame(frame, std::max(maxFrameSize_, (frame.native != nil ? [frame.native length] * 2 : 0)));
+        frame.offset = 0;
+    }
 
-        /* Allocate new native buffer */
-        const NSUInteger alignment = sizeof(MTLQuadTessellationFactorsHalf) * 256;
-        size = GetAlignedSize(size*2, alignment);
+    const NSUInteger offset = frame.offset;
+    frame.offset += size;
+    return offset;
+}
 
-        native_ = [device_ newBufferWithLength:size options:MTLResourceStorageModePrivate];
+
+/*
+ * ======= Private: =======
+ */
+
+MTTessFactorBuffer::Frame& MTTessFactorBuffer::NextFrame()
+{
+    /* Find next frame in round-robin order that the GPU is done with */
+    for (std::size_t i = 1; i <= frames_.size(); ++i)
+    {
+        const std::size_t idx = (frameIdx_ + i) % frames_.size();
+        if (!frames_[idx]->inFlight)
+        {
+            frameIdx_ = idx;
+            return *frames_[idx];
+        }
     }
+
+    /* All frames are in flight, so insert a new one after the current one to keep the oldest-to-newest order */
+    const std::size_t idx = (frames_.empty() ? 0 : frameIdx_ + 1);
+    frames_.insert(frames_.begin() + idx, std::make_shared<Frame>());
+    frameIdx_ = idx;
+    return *frames_[idx];
+}
+
+void MTTessFactorBuffer::GrowFrame(Frame& frame, NSUInteger size)
+{
+    /* Release previous native buffer and allocate new native buffer */
+    [frame.native release];
+    frame.native = [device_ newBufferWithLength:GetAlignedSize(size, g_tessFactorRangeAlignment) options:MTLResourceStorageModePrivate];
 }
 
 
@@ -13,20 +13,24 @@
 
 #include <LLGL/CommandBuffer.h>
 #include <LLGL/StaticLimits.h>
+#include "Buffer/MTBuffer.h"
 #include "Buffer/MTStagingBufferPool.h"
 #include "Buffer/MTTessFactorBuffer.h"
 #include "MTEncoderScheduler.h"
 #include <vector>
+#include <string>
+#include <functional>
+#include <memory>
 
 
 namespace LLGL
 {
 
 
-class MTBuffer;
 class MTTexture;
 class MTSampler;
 class MTRenderTarget;
+class MTSwapChain;
 
 class MTCommandBuffer final : public CommandBuffer
 {
@@ -62,6 +66,13 @@ class MTCommandBuffer final : public CommandBuffer
             std::uint64_t   size
         ) override;
 
+        void CopyBuffer(
+            Buffer&                     dstBuffer,
+            Buffer&                     srcBuffer,
+            std::uint32_t               numRegions,
+            const BufferCopyRegion*     regions
+        ) override;
+
         void CopyBufferFromTexture(
             Buffer&                 dstBuffer,
             std::uint64_t           dstOffset,
@@ -86,6 +97,13 @@ class MTCommandBuffer final : public CommandBuffer
             const Extent3D&         extent
         ) override;
 
+        void CopyTexture(
+            Texture&                    dstTexture,
+            Texture&                    srcTexture,
+            std::uint32_t               numRegions,
+            const TextureCopyRegion*    regions
+        ) override;
+
         void CopyTextureFromBuffer(
             Texture&                dstTexture,
             const TextureRegion&    dstRegion,
@@ -122,6 +140,14 @@ class MTCommandBuffer final : public CommandBuffer
             const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined
         ) override;
 
+        void SetResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           descriptorSet,
+            std::uint32_t           numDynamicOffsets,
+            const std::uint32_t*    dynamicOffsets,
+            const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined
+        ) override;
+
         void SetResource(Resource& resource, std::uint32_t slot, long bindFlags, long stageFlags = StageFlags::AllStages) override;
 
         void ResetResourceSlots(
@@ -142,6 +168,7 @@ class MTCommandBuffer final : public CommandBuffer
         ) override;
 
         void EndRenderPass() override;
+        void NextSubpass() override;
 
         void Clear(long flags, const ClearValue& clearValue = {}) override;
         void ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments) override;
@@ -198,6 +225,12 @@ class MTCommandBuffer final : public CommandBuffer
         void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset) override;
         void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
 
+        void DrawIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride) override;
+        void DrawIndexedIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride) override;
+
+        void DrawMeshTasks(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ) override;
+        void DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
+
         /* ----- Compute ----- */
 
         void Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ) override;
@@ -226,11 +259,55 @@ class MTCommandBuffer final : public CommandBuffer
             return immediateSubmit_;
         }
 
+        // Returns true if this is a secondary command buffer, which only records its commands until it is executed by a primary command buffer.
+        inline bool IsSecondaryCmdBuffer() const
+        {
+            return secondary_;
+        }
+
+        // Returns the staging buffer pool for dynamic buffer updates of this command buffer.
+        inline const MTStagingBufferPool& GetStagingBufferPool() const
+        {
+            return stagingBufferPool_;
+        }
+
+    private:
+
+        using MTRecordedCommand = std::function<void(MTCommandBuffer& cmdBuffer)>;
+        using MTBufferUsageList = std::vector<MTBufferUsagePtr>;
+
     private:
 
+        // Records the specified command if this secondary command buffer is currently being encoded, and returns true in that case.
+        template <typename TCommand>
+        bool RecordCommand(TCommand&& command)
+        {
+            if (!isRecording_)
+                return false;
+            recordedCommands_.emplace_back(std::forward<TCommand>(command));
+            return true;
+        }
+
+        /*
+        Marks the specified buffer as referenced by this command buffer until the GPU has completed it (see MTBuffer::IsIdleInSharedMemory).
+        Secondary command buffers only collect the buffers while recording; they are tracked by the primary command buffer that executes them.
+        */
+        void TrackBufferUsage(const MTBufferUsagePtr& usage);
+
+        inline void TrackBufferUsage(const MTBuffer& bufferMT)
+        {
+            TrackBufferUsage(bufferMT.GetUsage());
+        }
+
+        // Encodes the recorded commands of this secondary command buffer into the specified sub-encoder of a parallel render command encoder.
+        void EncodeParallelRenderPass(id<MTLRenderCommandEncoder> renderEncoder);
+
+        // Resets the references to pipeline states every command buffer starts with.
+        void ResetStateReferences();
+
         void SetIndexType(bool indexType16Bits);
-        void QueueDrawable(id<MTLDrawable> drawable);
-        void PresentDrawables();
+        void QueueSwapChain(MTSwapChain* swapChainMT);
+        void PresentSwapChains();
 
         void SetBuffer(MTBuffer& bufferMT, std::uint32_t slot, long stageFlags);
         void SetTexture(MTTexture& textureMT, std::uint32_t slot, long stageFlags);
@@ -244,6 +321,9 @@ class MTCommandBuffer final : public CommandBuffer
         void DispatchTessellatorStage(NSUInteger numPatchesAndInstances);
         id<MTLRenderCommandEncoder> GetRenderEncoderForPatches(NSUInteger numPatches);
 
+        // Executes the specified range of GPU encoded draw commands of a buffer with MiscFlags::IndirectCommands.
+        void ExecuteIndirectCommands(MTBuffer& bufferMT, std::uint64_t offset, std::uint32_t numCommands);
+
         // Dispatches the specified amount of local threads in as large threadgroups as possible.
         void DispatchThreads1D(
             id<MTLComputeCommandEncoder>    computeEncoder,
@@ -259,7 +339,7 @@ class MTCommandBuffer final : public CommandBuffer
         dispatch_semaphore_t            cmdBufferSemaphore_     = nil;
 
         MTEncoderScheduler              encoderScheduler_;
-        std::vector<id<MTLDrawable>>    drawables_;
+        std::vector<MTSwapChain*>       swapChains_;            // Swap chains rendered into by this command buffer; presented at the end of encoding.
 
         MTLPrimitiveType                primitiveType_          = MTLPrimitiveTypeTriangle;
         id<MTLBuffer>                   indexBuffer_            = nil;
@@ -268,15 +348,29 @@ class MTCommandBuffer final : public CommandBuffer
         NSUInteger                      indexTypeSize_          = 4;
         NSUInteger                      numPatchControlPoints_  = 0;
         const MTLSize*                  numThreadsPerGroup_     = nullptr;
+        const MTGraphicsPSO*            meshGraphicsPSO_        = nullptr; // Bound graphics PSO if it's a mesh render pipeline
+        bool                            skipDraws_              = false;
+        bool                            skipDispatches_         = false;
 
         MTStagingBufferPool             stagingBufferPool_;
 
+        // Hazard tracking of buffers in shared memory
+        std::uint64_t                       recordingID_        = 0;    // Unique ID of the current recording; incremented with each call to Begin().
+        std::shared_ptr<MTBufferUsageList>  trackedBufferUsages_;       // Buffers referenced by the current recording; released by its completed handler.
+
         bool                            immediateSubmit_        = false;
 
+        // Secondary command buffer objects
+        bool                            secondary_              = false;
+        bool                            isRecording_            = false;
+        std::vector<MTRecordedCommand>  recordedCommands_;
+        MTBufferUsageList               recordedBufferUsages_;
+
         // Tessellator stage objects
         MTTessFactorBuffer              tessFactorBuffer_;
         NSUInteger                      tessFactorBufferSlot_   = 30;
         NSUInteger                      tessFactorSize_         = 0;
+        NSUInteger                      tessFactorOffset_       = 0;
         id<MTLComputePipelineState>     tessPipelineState_      = nil;
 
 };
@@ -21,6 +21,7 @@
 #include "../CheckedCast.h"
 #include <LLGL/TypeInfo.h>
 #include <algorithm>
+#include <atomic>
 #include <limits.h>
 
 
@@ -37,12 +38,16 @@ static const NSUInteger g_minFillBufferForKernel = 64;
 // Default value when no compute PSO is bound.
 static const MTLSize g_defaultNumThreadsPerGroup { 1, 1, 1 };
 
+// Source of unique IDs for command buffer recordings across all command buffers (see MTBufferUsage::lastRecording).
+static std::atomic<std::uint64_t> g_nextRecordingID { 1 };
+
 MTCommandBuffer::MTCommandBuffer(id<MTLDevice> device, id<MTLCommandQueue> cmdQueue, const CommandBufferDescriptor& desc) :
     device_            { device                                                    },
     cmdQueue_          { cmdQueue                                                  },
     stagingBufferPool_ { device, USHRT_MAX                                         },
     immediateSubmit_   { ((desc.flags & CommandBufferFlags::ImmediateSubmit) != 0) },
-    tessFactorBuffer_  { device                                                    }
+    tessFactorBuffer_  { device                                                    },
+    secondary_         { ((desc.flags & CommandBufferFlags::Secondary) != 0)       }
 {
     const NSUInteger maxCmdBuffers = 3;
     cmdBufferSemaphore_ = dispatch_semaphore_create(maxCmdBuffers);
@@ -57,35 +62,56 @@ MTCommandBuffer::~MTCommandBuffer()
 
 void MTCommandBuffer::Begin()
 {
+    /* Secondary command buffers only record their commands, since Metal can only encode them once the primary command buffer executes them */
+    if (IsSecondaryCmdBuffer())
+    {
+        recordedCommands_.clear();
+        recordedBufferUsages_.clear();
+        isRecording_ = true;
+        return;
+    }
+
     /* Wait until next command buffer becomes available */
     dispatch_semaphore_wait(cmdBufferSemaphore_, DISPATCH_TIME_FOREVER);
 
     /* Allocate new command buffer from command queue */
     cmdBuffer_ = [cmdQueue_ commandBuffer];
 
-    /* Append complete handler to signal semaphore */
+    /* Switch to the next staging chunk set; it is released by a completed handler before the semaphore is signaled */
+    stagingBufferPool_.Reset(cmdBuffer_);
+    tessFactorBuffer_.Reset(cmdBuffer_);
+
+    /* Start new list of referenced buffers; they are released from this recording once the GPU has completed it */
+    recordingID_            = g_nextRecordingID++;
+    trackedBufferUsages_    = std::make_shared<MTBufferUsageList>();
+
+    /* Append complete handler to release referenced buffers and signal semaphore */
     __block dispatch_semaphore_t blockSemaphore = cmdBufferSemaphore_;
+    std::shared_ptr<MTBufferUsageList> blockBufferUsages = trackedBufferUsages_;
     [cmdBuffer_
         addCompletedHandler:^(id<MTLCommandBuffer> cmdBuffer)
         {
+            for (const auto& usage : *blockBufferUsages)
+                usage->numCmdBuffers.fetch_sub(1);
             dispatch_semaphore_signal(blockSemaphore);
         }
     ];
 
-    /* Reset schedulers and pools */
+    /* Reset schedulers */
     encoderScheduler_.Reset(cmdBuffer_);
-    stagingBufferPool_.Reset();
-
-    /* Reset references */
-    numThreadsPerGroup_     = &g_defaultNumThreadsPerGroup;
-    numPatchControlPoints_  = 0;
-    tessPipelineState_      = nil;
+    ResetStateReferences();
 }
 
 void MTCommandBuffer::End()
 {
+    if (IsSecondaryCmdBuffer())
+    {
+        isRecording_ = false;
+        return;
+    }
+
     encoderScheduler_.Flush();
-    PresentDrawables();
+    PresentSwapChains();
 
     /* Commit native buffer right after encoding for immediate command buffers */
     if (IsImmediateCmdBuffer())
@@ -94,7 +120,29 @@ void MTCommandBuffer::End()
 
 void MTCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
 {
-    //TODO
+    auto& secondaryCmdBufferMT = LLGL_CAST(MTCommandBuffer&, deferredCommandBuffer);
+
+    /* Track all buffers the secondary command buffer references, since its commands might be encoded on worker threads */
+    for (const auto& usage : secondaryCmdBufferMT.recordedBufferUsages_)
+        TrackBufferUsage(usage);
+
+    if (encoderScheduler_.IsInsideRenderPass())
+    {
+        /* Encode secondary command buffer on a worker thread into its own sub-encoder of a parallel render command encoder */
+        MTCommandBuffer* secondaryCmdBuffer = &secondaryCmdBufferMT;
+        encoderScheduler_.DispatchParallelRenderEncoder(
+            ^(id<MTLRenderCommandEncoder> renderEncoder)
+            {
+                secondaryCmdBuffer->EncodeParallelRenderPass(renderEncoder);
+            }
+        );
+    }
+    else
+    {
+        /* Encode recorded commands directly into this command buffer outside of a render pass */
+        for (const auto& command : secondaryCmdBufferMT.recordedCommands_)
+            command(*this);
+    }
 }
 
 /* ----- Blitting ----- */
@@ -105,8 +153,30 @@ void MTCommandBuffer::UpdateBuffer(
     const void*     data,
     std::uint16_t   dataSize)
 {
+    if (isRecording_)
+    {
+        /* Copy data now, since the caller may modify it before this secondary command buffer is executed */
+        std::vector<char> dataCopy(static_cast<const char*>(data), static_cast<const char*>(data) + dataSize);
+        auto recordedCommand = [&dstBuffer, dstOffset, dataCopy, dataSize](MTCommandBuffer& self)
+        {
+            self.UpdateBuffer(dstBuffer, dstOffset, dataCopy.data(), dataSize);
+        };
+        RecordCommand(recordedCommand);
+        TrackBufferUsage(LLGL_CAST(MTBuffer&, dstBuffer));
+        return;
+    }
+
     auto& dstBufferMT = LLGL_CAST(MTBuffer&, dstBuffer);
 
+    /* Write data into shared memory directly if no command buffer references the destination buffer; this avoids switching to a blit encoder */
+    if (dstBufferMT.IsIdleInSharedMemory())
+    {
+        dstBufferMT.Write(static_cast<NSUInteger>(dstOffset), data, static_cast<NSUInteger>(dataSize));
+        return;
+    }
+
+    TrackBufferUsage(dstBufferMT);
+
     /* Copy data to staging buffer */
     id<MTLBuffer> srcBuffer = nil;
     NSUInteger srcOffset = 0;
@@ -135,6 +205,16 @@ void MTCommandBuffer::CopyBuffer(
     std::uint64_t   srcOffset,
     std::uint64_t   size)
 {
+    TrackBufferUsage(LLGL_CAST(MTBuffer&, dstBuffer));
+    TrackBufferUsage(LLGL_CAST(MTBuffer&, srcBuffer));
+
+    auto recordedCommand = [&dstBuffer, dstOffset, &srcBuffer, srcOffset, size](MTCommandBuffer& self)
+    {
+        self.CopyBuffer(dstBuffer, dstOffset, srcBuffer, srcOffset, size);
+    };
+    if (RecordCommand(recordedCommand))
+        return;
+
     auto& dstBufferMT = LLGL_CAST(MTBuffer&, dstBuffer);
     auto& srcBufferMT = LLGL_CAST(MTBuffer&, srcBuffer);
 
@@ -152,6 +232,51 @@ void MTCommandBuffer::CopyBuffer(
     encoderScheduler_.ResumeRenderEncoder();
 }
 
+void MTCommandBuffer::CopyBuffer(
+    Buffer&                     dstBuffer,
+    Buffer&                     srcBuffer,
+    std::uint32_t               numRegions,
+    const BufferCopyRegion*     regions)
+{
+    if (numRegions == 0)
+        return;
+
+    TrackBufferUsage(LLGL_CAST(MTBuffer&, dstBuffer));
+    TrackBufferUsage(LLGL_CAST(MTBuffer&, srcBuffer));
+
+    if (isRecording_)
+    {
+        /* Copy regions now, since the caller may modify them before this secondary command buffer is executed */
+        std::vector<BufferCopyRegion> regionsCopy(regions, regions + numRegions);
+        auto recordedCommand = [&dstBuffer, &srcBuffer, regionsCopy](MTCommandBuffer& self)
+        {
+            self.CopyBuffer(dstBuffer, srcBuffer, static_cast<std::uint32_t>(regionsCopy.size()), regionsCopy.data());
+        };
+        RecordCommand(recordedCommand);
+        return;
+    }
+
+    auto& dstBufferMT = LLGL_CAST(MTBuffer&, dstBuffer);
+    auto& srcBufferMT = LLGL_CAST(MTBuffer&, srcBuffer);
+
+    /* Encode all regions into the same blit command encoder */
+    encoderScheduler_.PauseRenderEncoder();
+    {
+        auto blitEncoder = encoderScheduler_.BindBlitEncoder();
+        for (std::uint32_t i = 0; i < numRegions; ++i)
+        {
+            [blitEncoder
+                copyFromBuffer:     srcBufferMT.GetNative()
+                sourceOffset:       static_cast<NSUInteger>(regions[i].srcOffset)
+                toBuffer:           dstBufferMT.GetNative()
+                destinationOffset:  static_cast<NSUInteger>(regions[i].dstOffset)
+                size:               static_cast<NSUInteger>(regions[i].size)
+            ];
+        }
+    }
+    encoderScheduler_.ResumeRenderEncoder();
+}
+
 void MTCommandBuffer::CopyBufferFromTexture(
     Buffer&                 dstBuffer,
     std::uint64_t           dstOffset,
@@ -160,6 +285,15 @@ void MTCommandBuffer::CopyBufferFromTexture(
     std::uint32_t           rowStride,
     std::uint32_t           layerStride)
 {
+    TrackBufferUsage(LLGL_CAST(MTBuffer&, dstBuffer));
+
+    auto recordedCommand = [&dstBuffer, dstOffset, &srcTexture, srcRegion, rowStride, layerStride](MTCommandBuffer& self)
+    {
+        self.CopyBufferFromTexture(dstBuffer, dstOffset, srcTexture, srcRegion, rowStride, layerStride);
+    };
+    if (RecordCommand(recordedCommand))
+        return;
+
     auto& dstBufferMT = LLGL_CAST(MTBuffer&, dstBuffer);
     auto& srcTextureMT = LLGL_CAST(MTTexture&, srcTexture);
 
@@ -180,7 +314,7 @@ void MTCommandBuffer::CopyBufferFromTexture(
     MTTypes::Convert(srcSize, srcRegion.extent);
 
     /* Encode blit commands to copy texture form buffer */
-    encoderScheduler_.PauseRenderEncoder();
+    encoderScheduler_.PauseRenderEncoder(srcTextureMT.GetNative());
     {
         auto blitEncoder = encoderScheduler_.BindBlitEncoder();
         for (std::uint32_t arrayLayer = 0; arrayLayer < srcRegion.subresource.numArrayLayers; ++arrayLayer)
@@ -208,6 +342,15 @@ void MTCommandBuffer::FillBuffer(
     std::uint32_t   value,
     std::uint64_t   fillSize)
 {
+    TrackBufferUsage(LLGL_CAST(MTBuffer&, dstBuffer));
+
+    auto recordedCommand = [&dstBuffer, dstOffset, value, fillSize](MTCommandBuffer& self)
+    {
+        self.FillBuffer(dstBuffer, dstOffset, value, fillSize);
+    };
+    if (RecordCommand(recordedCommand))
+        return;
+
     if (fillSize == 0)
         return;
 
@@ -250,6 +393,13 @@ void MTCommandBuffer::CopyTexture(
     const TextureLocation&  srcLocation,
     const Extent3D&         extent)
 {
+    auto recordedCommand = [&dstTexture, dstLocation, &srcTexture, srcLocation, extent](MTCommandBuffer& self)
+    {
+        self.CopyTexture(dstTexture, dstLocation, srcTexture, srcLocation, extent);
+    };
+    if (RecordCommand(recordedCommand))
+        return;
+
     auto& dstTextureMT = LLGL_CAST(MTTexture&, dstTexture);
     auto& srcTextureMT = LLGL_CAST(MTTexture&, srcTexture);
 
@@ -260,7 +410,7 @@ void MTCommandBuffer::CopyTexture(
     MTLSize srcSize;
     MTTypes::Convert(srcSize, extent);
 
-    encoderScheduler_.PauseRenderEncoder();
+    encoderScheduler_.PauseRenderEncoder(dstTextureMT.GetNative(), srcTextureMT.GetNative());
     {
         auto blitEncoder = encoderScheduler_.BindBlitEncoder();
         [blitEncoder
@@ -278,6 +428,62 @@ void MTCommandBuffer::CopyTexture(
     encoderScheduler_.ResumeRenderEncoder();
 }
 
+void MTCommandBuffer::CopyTexture(
+    Texture&                    dstTexture,
+    Texture&                    srcTexture,
+    std::uint32_t               numRegions,
+    const TextureCopyRegion*    regions)
+{
+    if (numRegions == 0)
+        return;
+
+    if (isRecording_)
+    {
+        /* Copy regions now, since the caller may modify them before this secondary command buffer is executed */
+        std::vector<TextureCopyRegion> regionsCopy(regions, regions + numRegions);
+        auto recordedCommand = [&dstTexture, &srcTexture, regionsCopy](MTCommandBuffer& self)
+        {
+            self.CopyTexture(dstTexture, srcTexture, static_cast<std::uint32_t>(regionsCopy.size()), regionsCopy.data());
+        };
+        RecordCommand(recordedCommand);
+        return;
+    }
+
+    auto& dstTextureMT = LLGL_CAST(MTTexture&, dstTexture);
+    auto& srcTextureMT = LLGL_CAST(MTTexture&, srcTexture);
+
+    /* Encode all regions into the same blit command encoder to avoid encoder switches */
+    encoderScheduler_.PauseRenderEncoder(dstTextureMT.GetNative(), srcTextureMT.GetNative());
+    {
+        auto blitEncoder = encoderScheduler_.BindBlitEncoder();
+        for (std::uint32_t i = 0; i < numRegions; ++i)
+        {
+            const auto& srcLocation = regions[i].srcLocation;
+            const auto& dstLocation = regions[i].dstLocation;
+
+            MTLOrigin srcOrigin, dstOrigin;
+            MTTypes::Convert(srcOrigin, srcLocation.offset);
+            MTTypes::Convert(dstOrigin, dstLocation.offset);
+
+            MTLSize srcSize;
+            MTTypes::Convert(srcSize, regions[i].extent);
+
+            [blitEncoder
+                copyFromTexture:    srcTextureMT.GetNative()
+                sourceSlice:        srcLocation.arrayLayer
+                sourceLevel:        srcLocation.mipLevel
+                sourceOrigin:       srcOrigin
+                sourceSize:         srcSize
+                toTexture:          dstTextureMT.GetNative()
+                destinationSlice:   dstLocation.arrayLayer
+                destinationLevel:   dstLocation.mipLevel
+                destinationOrigin:  dstOrigin
+            ];
+        }
+    }
+    encoderScheduler_.ResumeRenderEncoder();
+}
+
 void MTCommandBuffer::CopyTextureFromBuffer(
     Texture&                dstTexture,
     const TextureRegion&    dstRegion,
@@ -286,6 +492,15 @@ void MTCommandBuffer::CopyTextureFromBuffer(
     std::uint32_t           rowStride,
     std::uint32_t           layerStride)
 {
+    TrackBufferUsage(LLGL_CAST(MTBuffer&, srcBuffer));
+
+    auto recordedCommand = [&dstTexture, dstRegion, &srcBuffer, srcOffset, rowStride, layerStride](MTCommandBuffer& self)
+    {
+        self.CopyTextureFromBuffer(dstTexture, dstRegion, srcBuffer, srcOffset, rowStride, layerStride);
+    };
+    if (RecordCommand(recordedCommand))
+        return;
+
     auto& dstTextureMT = LLGL_CAST(MTTexture&, dstTexture);
     auto& srcBufferMT = LLGL_CAST(MTBuffer&, srcBuffer);
 
@@ -306,7 +521,7 @@ void MTCommandBuffer::CopyTextureFromBuffer(
     MTTypes::Convert(srcSize, dstRegion.extent);
 
     /* Encode blit commands to copy texture form buffer */
-    encoderScheduler_.PauseRenderEncoder();
+    encoderScheduler_.PauseRenderEncoder(dstTextureMT.GetNative());
     {
         auto blitEncoder = encoderScheduler_.BindBlitEncoder();
         for (std::uint32_t arrayLayer = 0; arrayLayer < dstRegion.subresource.numArrayLayers; ++arrayLayer)
@@ -330,10 +545,13 @@ void MTCommandBuffer::CopyTextureFromBuffer(
 
 void MTCommandBuffer::GenerateMips(Texture& texture)
 {
+    if (RecordCommand([&texture](MTCommandBuffer& self) { self.GenerateMips(texture); }))
+        return;
+
     auto& textureMT = LLGL_CAST(MTTexture&, texture);
     if ([textureMT.GetNative() mipmapLevelCount] > 1)
     {
-        encoderScheduler_.PauseRenderEncoder();
+        encoderScheduler_.PauseRenderEncoder(textureMT.GetNative());
         {
             auto blitEncoder = encoderScheduler_.BindBlitEncoder();
             [blitEncoder generateMipmapsForTexture:textureMT.GetNative()];
@@ -344,6 +562,9 @@ void MTCommandBuffer::GenerateMips(Texture& texture)
 
 void MTCommandBuffer::GenerateMips(Texture& texture, const TextureSubresource& subresource)
 {
+    if (RecordCommand([&texture, subresource](MTCommandBuffer& self) { self.GenerateMips(texture, subresource); }))
+        return;
+
     if (subresource.numMipLevels > 1)
     {
         auto& textureMT = LLGL_CAST(MTTexture&, texture);
@@ -351,7 +572,7 @@ void MTCommandBuffer::GenerateMips(Texture& texture, const TextureSubresource& s
         // Create temporary subresource texture to generate MIP-maps only on that range
         id<MTLTexture> intermediateTexture = textureMT.CreateSubresourceView(subresource);
 
-        encoderScheduler_.PauseRenderEncoder();
+        encoderScheduler_.PauseRenderEncoder(intermediateTexture);
         {
             auto blitEncoder = encoderScheduler_.BindBlitEncoder();
             [blitEncoder generateMipmapsForTexture:intermediateTexture];
@@ -366,21 +587,49 @@ void MTCommandBuffer::GenerateMips(Texture& texture, const TextureSubresource& s
 
 void MTCommandBuffer::SetViewport(const Viewport& viewport)
 {
+    if (RecordCommand([viewport](MTCommandBuffer& self) { self.SetViewport(viewport); }))
+        return;
+
     encoderScheduler_.SetViewports(&viewport, 1u);
 }
 
 void MTCommandBuffer::SetViewports(std::uint32_t numViewports, const Viewport* viewports)
 {
+    if (isRecording_)
+    {
+        std::vector<Viewport> viewportsCopy(viewports, viewports + numViewports);
+        auto recordedCommand = [viewportsCopy](MTCommandBuffer& self)
+        {
+            self.SetViewports(static_cast<std::uint32_t>(viewportsCopy.size()), viewportsCopy.data());
+        };
+        RecordCommand(recordedCommand);
+        return;
+    }
+
     encoderScheduler_.SetViewports(viewports, numViewports);
 }
 
 void MTCommandBuffer::SetScissor(const Scissor& scissor)
 {
+    if (RecordCommand([scissor](MTCommandBuffer& self) { self.SetScissor(scissor); }))
+        return;
+
     encoderScheduler_.SetScissorRects(&scissor, 1u);
 }
 
 void MTCommandBuffer::SetScissors(std::uint32_t numScissors, const Scissor* scissors)
 {
+    if (isRecording_)
+    {
+        std::vector<Scissor> scissorsCopy(scissors, scissors + numScissors);
+        auto recordedCommand = [scissorsCopy](MTCommandBuffer& self)
+        {
+            self.SetScissors(static_cast<std::uint32_t>(scissorsCopy.size()), scissorsCopy.data());
+        };
+        RecordCommand(recordedCommand);
+        return;
+    }
+
     encoderScheduler_.SetScissorRects(scissors, numScissors);
 }
 
@@ -388,6 +637,11 @@ void MTCommandBuffer::SetScissors(std::uint32_t numScissors, const Scissor* scis
 
 void MTCommandBuffer::SetVertexBuffer(Buffer& buffer)
 {
+    TrackBufferUsage(LLGL_CAST(MTBuffer&, buffer));
+
+    if (RecordCommand([&buffer](MTCommandBuffer& self) { self.SetVertexBuffer(buffer); }))
+        return;
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     encoderScheduler_.SetVertexBuffer(bufferMT.GetNative(), 0);
 }
@@ -395,6 +649,12 @@ void MTCommandBuffer::SetVertexBuffer(Buffer& buffer)
 void MTCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
     auto& bufferArrayMT = LLGL_CAST(MTBufferArray&, bufferArray);
+    for (const auto& usage : bufferArrayMT.GetBufferUsages())
+        TrackBufferUsage(usage);
+
+    if (RecordCommand([&bufferArray](MTCommandBuffer& self) { self.SetVertexBufferArray(bufferArray); }))
+        return;
+
     encoderScheduler_.SetVertexBuffers(
         bufferArrayMT.GetIDArray().data(),
         bufferArrayMT.GetOffsets().data(),
@@ -404,6 +664,11 @@ void MTCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 
 void MTCommandBuffer::SetIndexBuffer(Buffer& buffer)
 {
+    TrackBufferUsage(LLGL_CAST(MTBuffer&, buffer));
+
+    if (RecordCommand([&buffer](MTCommandBuffer& self) { self.SetIndexBuffer(buffer); }))
+        return;
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     indexBuffer_        = bufferMT.GetNative();
     indexBufferOffset_  = 0;
@@ -412,6 +677,11 @@ void MTCommandBuffer::SetIndexBuffer(Buffer& buffer)
 
 void MTCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::uint64_t offset)
 {
+    TrackBufferUsage(LLGL_CAST(MTBuffer&, buffer));
+
+    if (RecordCommand([&buffer, format, offset](MTCommandBuffer& self) { self.SetIndexBuffer(buffer, format, offset); }))
+        return;
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     indexBuffer_        = bufferMT.GetNative();
     indexBufferOffset_  = static_cast<NSUInteger>(offset);
@@ -426,12 +696,32 @@ void MTCommandBuffer::SetResourceHeap(
     const PipelineBindPoint bindPoint)
 {
     auto& resourceHeapMT = LLGL_CAST(MTResourceHeap&, resourceHeap);
+    for (const auto& usage : resourceHeapMT.GetBufferUsages(firstSet))
+        TrackBufferUsage(usage);
+
+    auto recordedCommand = [&resourceHeap, firstSet, bindPoint](MTCommandBuffer& self)
+    {
+        self.SetResourceHeap(resourceHeap, firstSet, bindPoint);
+    };
+    if (RecordCommand(recordedCommand))
+        return;
     if (resourceHeapMT.HasGraphicsResources() && bindPoint != PipelineBindPoint::Compute)
         encoderScheduler_.SetGraphicsResourceHeap(&resourceHeapMT, firstSet);
     if (resourceHeapMT.HasComputeResources() && bindPoint != PipelineBindPoint::Graphics)
         encoderScheduler_.SetComputeResourceHeap(&resourceHeapMT, firstSet);
 }
 
+void MTCommandBuffer::SetResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           firstSet,
+    std::uint32_t           /*numDynamicOffsets*/,
+    const std::uint32_t*    /*dynamicOffsets*/,
+    const PipelineBindPoint bindPoint)
+{
+    /* Dynamic offsets are not supported by this renderer (see BindingFlags::DynamicOffset) */
+    SetResourceHeap(resourceHeap, firstSet, bindPoint);
+}
+
 void MTCommandBuffer::SetResource(Resource& resource, std::uint32_t slot, long /*bindFlags*/, long stageFlags)
 {
     #if 0//TODO: store direct binding in <MTEncoderScheduler>
@@ -471,15 +761,25 @@ void MTCommandBuffer::BeginRenderPass(
     std::uint32_t       numClearValues,
     const ClearValue*   clearValues)
 {
+    if (isRecording_)
+    {
+        std::vector<ClearValue> clearValuesCopy(clearValues, clearValues + (clearValues != nullptr ? numClearValues : 0));
+        auto recordedCommand = [&renderTarget, renderPass, clearValuesCopy](MTCommandBuffer& self)
+        {
+            self.BeginRenderPass(renderTarget, renderPass, static_cast<std::uint32_t>(clearValuesCopy.size()), clearValuesCopy.data());
+        };
+        RecordCommand(recordedCommand);
+        return;
+    }
+
     if (LLGL::IsInstanceOf<SwapChain>(renderTarget))
     {
-        /* Put current drawable into queue */
+        /* Put swap chain into queue; its drawable is not acquired until the end of this command buffer */
         auto& swapChainMT = LLGL_CAST(MTSwapChain&, renderTarget);
-        QueueDrawable(swapChainMT.GetMTKView().currentDrawable);
+        QueueSwapChain(&swapChainMT);
 
-        /* Get next render pass descriptor from MetalKit view */
-        MTKView* view = swapChainMT.GetMTKView();
-        encoderScheduler_.BindRenderEncoder(view.currentRenderPassDescriptor, true);
+        /* Render into intermediate target of the swap chain */
+        encoderScheduler_.BindRenderEncoder(swapChainMT.GetNativeRenderPass(), true);
     }
     else
     {
@@ -491,9 +791,41 @@ void MTCommandBuffer::BeginRenderPass(
 
 void MTCommandBuffer::EndRenderPass()
 {
+    if (RecordCommand([](MTCommandBuffer& self) { self.EndRenderPass(); }))
+        return;
+
     encoderScheduler_.Flush();
 }
 
+void MTCommandBuffer::NextSubpass()
+{
+    if (RecordCommand([](MTCommandBuffer& self) { self.NextSubpass(); }))
+        return;
+
+    /*
+    Apple GPUs read color attachments in place via programmable blending, so sub-passes don't need any commands.
+    Otherwise, make render target writes of the previous sub-pass visible to texture reads in the next sub-pass.
+    */
+    #ifndef LLGL_OS_IOS
+    if (@available(macOS 11.0, *))
+    {
+        if ([device_ supportsFamily:MTLGPUFamilyApple1])
+            return;
+    }
+    if (@available(macOS 10.14, *))
+    {
+        if (auto renderEncoder = encoderScheduler_.GetRenderEncoder())
+        {
+            [renderEncoder
+                memoryBarrierWithScope: MTLBarrierScopeRenderTargets
+                afterStages:            MTLRenderStageFragment
+                beforeStages:           MTLRenderStageFragment
+            ];
+        }
+    }
+    #endif // /LLGL_OS_IOS
+}
+
 static MTLClearColor ToMTLClearColor(const ColorRGBAf& color)
 {
     return MTLClearColorMake(
@@ -504,30 +836,46 @@ static MTLClearColor ToMTLClearColor(const ColorRGBAf& color)
     );
 }
 
-void MTCommandBuffer::Clear(long flags, const ClearValue& clearValue)
+// Fills the MTLRenderPassDescriptor object according to the secified clear command
+static void FillMTRenderPassDesc(MTLRenderPassDescriptor* renderPassDesc, long flags, const ClearValue& clearValue)
 {
-    if (encoderScheduler_.GetRenderEncoder() != nil && flags != 0)
+    if ((flags & ClearFlags::Color) != 0)
     {
-        /* Make new render pass descriptor with current clear values */
-        auto renderPassDesc = encoderScheduler_.CopyRenderPassDesc();
+        renderPassDesc.colorAttachments[0].loadAction   = MTLLoadActionClear;
+        renderPassDesc.colorAttachments[0].clearColor   = ToMTLClearColor(clearValue.color);
+    }
 
-        if ((flags & ClearFlags::Color) != 0)
-        {
-            renderPassDesc.colorAttachments[0].loadAction   = MTLLoadActionClear;
-            renderPassDesc.colorAttachments[0].clearColor   = ToMTLClearColor(clearValue.color);
-        }
+    if ((flags & ClearFlags::Depth) != 0)
+    {
+        renderPassDesc.depthAttachment.loadAction       = MTLLoadActionClear;
+        renderPassDesc.depthAttachment.clearDepth       = static_cast<double>(clearValue.depth);
+    }
 
-        if ((flags & ClearFlags::Depth) != 0)
-        {
-            renderPassDesc.depthAttachment.loadAction       = MTLLoadActionClear;
-            renderPassDesc.depthAttachment.clearDepth       = static_cast<double>(clearValue.depth);
-        }
+    if ((flags & ClearFlags::Stencil) != 0)
+    {
+        renderPassDesc.stencilAttachment.loadAction     = MTLLoadActionClear;
+        renderPassDesc.stencilAttachment.clearStencil   = clearValue.stencil;
+    }
+}
 
-        if ((flags & ClearFlags::Stencil) != 0)
-        {
-            renderPassDesc.stencilAttachment.loadAction     = MTLLoadActionClear;
-            renderPassDesc.stencilAttachment.clearStencil   = clearValue.stencil;
-        }
+void MTCommandBuffer::Clear(long flags, const ClearValue& clearValue)
+{
+    if (RecordCommand([flags, clearValue](MTCommandBuffer& self) { self.Clear(flags, clearValue); }))
+        return;
+
+    if (flags == 0)
+        return;
+
+    if (auto renderPassDesc = encoderScheduler_.ModifyPendingRenderPassDesc())
+    {
+        /* Merge clear values into the render pass that has not been encoded yet */
+        FillMTRenderPassDesc(renderPassDesc, flags, clearValue);
+    }
+    else if (encoderScheduler_.GetRenderEncoder() != nil)
+    {
+        /* Make new render pass descriptor with current clear values */
+        auto renderPassDesc = encoderScheduler_.CopyRenderPassDesc();
+        FillMTRenderPassDesc(renderPassDesc, flags, clearValue);
 
         /* Begin with new render pass to clear buffers */
         encoderScheduler_.BindRenderEncoder(renderPassDesc);
@@ -561,7 +909,27 @@ static void FillMTRenderPassDesc(MTLRenderPassDescriptor* renderPassDesc, const
 
 void MTCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
 {
-    if (encoderScheduler_.GetRenderEncoder() != nil && numAttachments > 0)
+    if (isRecording_)
+    {
+        std::vector<AttachmentClear> attachmentsCopy(attachments, attachments + numAttachments);
+        auto recordedCommand = [attachmentsCopy](MTCommandBuffer& self)
+        {
+            self.ClearAttachments(static_cast<std::uint32_t>(attachmentsCopy.size()), attachmentsCopy.data());
+        };
+        RecordCommand(recordedCommand);
+        return;
+    }
+
+    if (numAttachments == 0)
+        return;
+
+    if (auto renderPassDesc = encoderScheduler_.ModifyPendingRenderPassDesc())
+    {
+        /* Merge clear values into the render pass that has not been encoded yet */
+        for (std::uint32_t i = 0; i < numAttachments; ++i)
+            FillMTRenderPassDesc(renderPassDesc, attachments[i]);
+    }
+    else if (encoderScheduler_.GetRenderEncoder() != nil)
     {
         /* Make new render pass descriptor with current clear values */
         auto renderPassDesc = encoderScheduler_.CopyRenderPassDesc();
@@ -590,8 +958,24 @@ static NSUInteger GetTessFactorSize(const MTLPatchType patchType)
 
 void MTCommandBuffer::SetPipelineState(PipelineState& pipelineState)
 {
-    /* Set graphics pipeline with encoder scheduler */
+    if (RecordCommand([&pipelineState](MTCommandBuffer& self) { self.SetPipelineState(pipelineState); }))
+        return;
+
     auto& pipelineStateMT = LLGL_CAST(MTPipelineState&, pipelineState);
+
+    /* Skip draw or dispatch commands while an asynchronously created PSO is pending, otherwise wait until it is ready */
+    const bool skipCommands = pipelineStateMT.SkipDraws();
+    if (pipelineStateMT.IsGraphicsPSO())
+        skipDraws_ = skipCommands;
+    else
+        skipDispatches_ = skipCommands;
+
+    if (skipCommands)
+        return;
+
+    pipelineStateMT.Wait();
+
+    /* Set graphics pipeline with encoder scheduler */
     if (pipelineStateMT.IsGraphicsPSO())
     {
         /* Schedule graphics pipeline and store primitive type for draw commands */
@@ -603,6 +987,7 @@ void MTCommandBuffer::SetPipelineState(PipelineState& pipelineState)
         numPatchControlPoints_  = graphicsPSO.GetNumPatchControlPoints();
         tessPipelineState_      = graphicsPSO.GetTessPipelineState();
         tessFactorSize_         = GetTessFactorSize(graphicsPSO.GetPatchType());
+        meshGraphicsPSO_        = (graphicsPSO.IsMeshPipeline() ? &graphicsPSO : nullptr);
     }
     else
     {
@@ -620,11 +1005,17 @@ void MTCommandBuffer::SetPipelineState(PipelineState& pipelineState)
 
 void MTCommandBuffer::SetBlendFactor(const ColorRGBAf& color)
 {
+    if (RecordCommand([color](MTCommandBuffer& self) { self.SetBlendFactor(color); }))
+        return;
+
     encoderScheduler_.SetBlendColor(color.Ptr());
 }
 
 void MTCommandBuffer::SetStencilReference(std::uint32_t reference, const StencilFace stencilFace)
 {
+    if (RecordCommand([reference, stencilFace](MTCommandBuffer& self) { self.SetStencilReference(reference, stencilFace); }))
+        return;
+
     encoderScheduler_.SetStencilRef(reference, stencilFace);
 }
 
@@ -683,6 +1074,12 @@ void MTCommandBuffer::EndStreamOutput()
 
 void MTCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
 {
+    if (RecordCommand([numVertices, firstVertex](MTCommandBuffer& self) { self.Draw(numVertices, firstVertex); }))
+        return;
+
+    if (skipDraws_)
+        return;
+
     if (numPatchControlPoints_ > 0)
     {
         const NSUInteger firstPatch = (static_cast<NSUInteger>(firstVertex) / numPatchControlPoints_);
@@ -714,6 +1111,12 @@ void MTCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
 
 void MTCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
 {
+    if (RecordCommand([numIndices, firstIndex](MTCommandBuffer& self) { self.DrawIndexed(numIndices, firstIndex); }))
+        return;
+
+    if (skipDraws_)
+        return;
+
     if (numPatchControlPoints_ > 0)
     {
         const NSUInteger firstPatch = (static_cast<NSUInteger>(firstIndex) / numPatchControlPoints_);
@@ -759,6 +1162,16 @@ void MTCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t fir
 
 void MTCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
 {
+    auto recordedCommand = [numVertices, firstVertex, numInstances, firstInstance](MTCommandBuffer& self)
+    {
+        self.DrawInstanced(numVertices, firstVertex, numInstances, firstInstance);
+    };
+    if (RecordCommand(recordedCommand))
+        return;
+
+    if (skipDraws_)
+        return;
+
     if (numPatchControlPoints_ > 0)
     {
         const NSUInteger firstPatch = (static_cast<NSUInteger>(firstVertex) / numPatchControlPoints_);
@@ -802,6 +1215,16 @@ void MTCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32
 
 void MTCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
+    auto recordedCommand = [numIndices, numInstances, firstIndex, vertexOffset, firstInstance](MTCommandBuffer& self)
+    {
+        self.DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
+    };
+    if (RecordCommand(recordedCommand))
+        return;
+
+    if (skipDraws_)
+        return;
+
     if (numPatchControlPoints_ > 0)
     {
         const NSUInteger firstPatch = (static_cast<NSUInteger>(firstIndex) / numPatchControlPoints_);
@@ -847,8 +1270,18 @@ static void ThrowIndirectPatchesNotSupported()
 //TODO: support patches with indirect arguments
 void MTCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    TrackBufferUsage(LLGL_CAST(MTBuffer&, buffer));
+
+    if (RecordCommand([&buffer, offset](MTCommandBuffer& self) { self.DrawIndirect(buffer, offset); }))
+        return;
+
+    if (skipDraws_)
+        return;
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
-    if (numPatchControlPoints_ > 0)
+    if (bufferMT.GetIndirectCommandBuffer() != nil)
+        ExecuteIndirectCommands(bufferMT, offset, 1);
+    else if (numPatchControlPoints_ > 0)
     {
         #if 0 //TODO
         [renderEncoder
@@ -876,8 +1309,22 @@ void MTCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 //TODO: support patches with indirect arguments
 void MTCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    TrackBufferUsage(LLGL_CAST(MTBuffer&, buffer));
+
+    auto recordedCommand = [&buffer, offset, numCommands, stride](MTCommandBuffer& self)
+    {
+        self.DrawIndirect(buffer, offset, numCommands, stride);
+    };
+    if (RecordCommand(recordedCommand))
+        return;
+
+    if (skipDraws_)
+        return;
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
-    if (numPatchControlPoints_ > 0)
+    if (bufferMT.GetIndirectCommandBuffer() != nil)
+        ExecuteIndirectCommands(bufferMT, offset, numCommands);
+    else if (numPatchControlPoints_ > 0)
     {
         #if 0 //TODO
         while (numCommands-- > 0)
@@ -913,8 +1360,18 @@ void MTCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::ui
 //TODO: support patches with indirect arguments
 void MTCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    TrackBufferUsage(LLGL_CAST(MTBuffer&, buffer));
+
+    if (RecordCommand([&buffer, offset](MTCommandBuffer& self) { self.DrawIndexedIndirect(buffer, offset); }))
+        return;
+
+    if (skipDraws_)
+        return;
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
-    if (numPatchControlPoints_ > 0)
+    if (bufferMT.GetIndirectCommandBuffer() != nil)
+        ExecuteIndirectCommands(bufferMT, offset, 1);
+    else if (numPatchControlPoints_ > 0)
     {
         #if 0 //TODO
         [renderEncoder
@@ -947,8 +1404,22 @@ void MTCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 //TODO: support patches with indirect arguments
 void MTCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    TrackBufferUsage(LLGL_CAST(MTBuffer&, buffer));
+
+    auto recordedCommand = [&buffer, offset, numCommands, stride](MTCommandBuffer& self)
+    {
+        self.DrawIndexedIndirect(buffer, offset, numCommands, stride);
+    };
+    if (RecordCommand(recordedCommand))
+        return;
+
+    if (skipDraws_)
+        return;
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
-    if (numPatchControlPoints_ > 0)
+    if (bufferMT.GetIndirectCommandBuffer() != nil)
+        ExecuteIndirectCommands(bufferMT, offset, numCommands);
+    else if (numPatchControlPoints_ > 0)
     {
         #if 0 //TODO
         while (numCommands-- > 0)
@@ -986,10 +1457,133 @@ void MTCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset,
     }
 }
 
+void MTCommandBuffer::ExecuteIndirectCommands(MTBuffer& bufferMT, std::uint64_t offset, std::uint32_t numCommands)
+{
+    if (@available(macOS 10.14, iOS 12.0, *))
+    {
+        /* Execute range of draw commands that have been encoded on the GPU; the offset is a multiple of the indirect command stride */
+        auto renderEncoder = encoderScheduler_.GetRenderEncoderAndFlushState();
+        const NSUInteger firstCommand = static_cast<NSUInteger>(offset) / MTBuffer::indirectCommandStride;
+        [renderEncoder
+            executeCommandsInBuffer:    bufferMT.GetIndirectCommandBuffer()
+            withRange:                  NSMakeRange(firstCommand, static_cast<NSUInteger>(numCommands))
+        ];
+    }
+}
+
+// Reads the number of draw commands from the shared memory of the specified count buffer and clamps it to the specified maximum.
+static std::uint32_t ReadIndirectCount(Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands)
+{
+    auto& countBufferMT = LLGL_CAST(MTBuffer&, countBuffer);
+    std::uint32_t numCommands = 0;
+    countBufferMT.Read(static_cast<NSUInteger>(countOffset), &numCommands, sizeof(numCommands));
+    return std::min(numCommands, maxNumCommands);
+}
+
+void MTCommandBuffer::DrawIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride)
+{
+    TrackBufferUsage(LLGL_CAST(MTBuffer&, buffer));
+
+    auto recordedCommand = [&buffer, offset, &countBuffer, countOffset, maxNumCommands, stride](MTCommandBuffer& self)
+    {
+        self.DrawIndirectCount(buffer, offset, countBuffer, countOffset, maxNumCommands, stride);
+    };
+    if (RecordCommand(recordedCommand))
+        return;
+
+    if (skipDraws_)
+        return;
+
+    /* Metal has no native support for a GPU draw count, so read it from the buffer when the command is encoded */
+    DrawIndirect(buffer, offset, ReadIndirectCount(countBuffer, countOffset, maxNumCommands), stride);
+}
+
+void MTCommandBuffer::DrawIndexedIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride)
+{
+    TrackBufferUsage(LLGL_CAST(MTBuffer&, buffer));
+
+    auto recordedCommand = [&buffer, offset, &countBuffer, countOffset, maxNumCommands, stride](MTCommandBuffer& self)
+    {
+        self.DrawIndexedIndirectCount(buffer, offset, countBuffer, countOffset, maxNumCommands, stride);
+    };
+    if (RecordCommand(recordedCommand))
+        return;
+
+    if (skipDraws_)
+        return;
+
+    /* Metal has no native support for a GPU draw count, so read it from the buffer when the command is encoded */
+    DrawIndexedIndirect(buffer, offset, ReadIndirectCount(countBuffer, countOffset, maxNumCommands), stride);
+}
+
+void MTCommandBuffer::DrawMeshTasks(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
+{
+    auto recordedCommand = [numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ](MTCommandBuffer& self)
+    {
+        self.DrawMeshTasks(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+    };
+    if (RecordCommand(recordedCommand))
+        return;
+
+    if (skipDraws_ || meshGraphicsPSO_ == nullptr)
+        return;
+
+    if (@available(macOS 13.0, iOS 16.0, *))
+    {
+        auto renderEncoder = encoderScheduler_.GetRenderEncoderAndFlushState();
+        [renderEncoder
+            drawMeshThreadgroups:           MTLSizeMake(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ)
+            threadsPerObjectThreadgroup:    meshGraphicsPSO_->GetThreadsPerObjectThreadgroup()
+            threadsPerMeshThreadgroup:      meshGraphicsPSO_->GetThreadsPerMeshThreadgroup()
+        ];
+    }
+}
+
+void MTCommandBuffer::DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    TrackBufferUsage(LLGL_CAST(MTBuffer&, buffer));
+
+    auto recordedCommand = [&buffer, offset, numCommands, stride](MTCommandBuffer& self)
+    {
+        self.DrawMeshTasksIndirect(buffer, offset, numCommands, stride);
+    };
+    if (RecordCommand(recordedCommand))
+        return;
+
+    if (skipDraws_ || meshGraphicsPSO_ == nullptr)
+        return;
+
+    if (@available(macOS 13.0, iOS 16.0, *))
+    {
+        auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
+        auto renderEncoder = encoderScheduler_.GetRenderEncoderAndFlushState();
+        while (numCommands-- > 0)
+        {
+            [renderEncoder
+                drawMeshThreadgroupsWithIndirectBuffer: bufferMT.GetNative()
+                indirectBufferOffset:                   static_cast<NSUInteger>(offset)
+                threadsPerObjectThreadgroup:            meshGraphicsPSO_->GetThreadsPerObjectThreadgroup()
+                threadsPerMeshThreadgroup:              meshGraphicsPSO_->GetThreadsPerMeshThreadgroup()
+            ];
+            offset += stride;
+        }
+    }
+}
+
 /* ----- Compute ----- */
 
 void MTCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
 {
+    auto recordedCommand = [numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ](MTCommandBuffer& self)
+    {
+        self.Dispatch(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+    };
+    if (RecordCommand(recordedCommand))
+        return;
+
+    if (skipDispatches_)
+        return;
+
     auto computeEncoder = encoderScheduler_.GetComputeEncoderAndFlushState();
     [computeEncoder
         dispatchThreadgroups:   MTLSizeMake(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ)
@@ -999,6 +1593,14 @@ void MTCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWo
 
 void MTCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    TrackBufferUsage(LLGL_CAST(MTBuffer&, buffer));
+
+    if (RecordCommand([&buffer, offset](MTCommandBuffer& self) { self.DispatchIndirect(buffer, offset); }))
+        return;
+
+    if (skipDispatches_)
+        return;
+
     auto& bufferMT = LLGL_CAST(MTBuffer&, buffer);
     auto computeEncoder = encoderScheduler_.GetComputeEncoderAndFlushState();
     [computeEncoder
@@ -1012,6 +1614,13 @@ void MTCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
 
 void MTCommandBuffer::PushDebugGroup(const char* name)
 {
+    if (isRecording_)
+    {
+        std::string nameCopy = name;
+        RecordCommand([nameCopy](MTCommandBuffer& self) { self.PushDebugGroup(nameCopy.c_str()); });
+        return;
+    }
+
     #ifdef LLGL_DEBUG
     [cmdBuffer_ pushDebugGroup:[NSString stringWithUTF8String:name]];
     #endif // /LLGL_DEBUG
@@ -1019,6 +1628,9 @@ void MTCommandBuffer::PushDebugGroup(const char* name)
 
 void MTCommandBuffer::PopDebugGroup()
 {
+    if (RecordCommand([](MTCommandBuffer& self) { self.PopDebugGroup(); }))
+        return;
+
     #ifdef LLGL_DEBUG
     [cmdBuffer_ popDebugGroup];
     #endif // /LLGL_DEBUG
@@ -1028,6 +1640,17 @@ void MTCommandBuffer::PopDebugGroup()
 
 void MTCommandBuffer::SetGraphicsAPIDependentState(const void* stateDesc, std::size_t stateDescSize)
 {
+    if (isRecording_)
+    {
+        std::vector<char> stateDescCopy(static_cast<const char*>(stateDesc), static_cast<const char*>(stateDesc) + (stateDesc != nullptr ? stateDescSize : 0));
+        auto recordedCommand = [stateDescCopy, stateDescSize](MTCommandBuffer& self)
+        {
+            self.SetGraphicsAPIDependentState(stateDescCopy.empty() ? nullptr : stateDescCopy.data(), stateDescSize);
+        };
+        RecordCommand(recordedCommand);
+        return;
+    }
+
     if (stateDesc != nullptr && stateDescSize == sizeof(MetalDependentStateDescriptor))
     {
         const auto stateDescMT = reinterpret_cast<const MetalDependentStateDescriptor*>(stateDesc);
@@ -1040,6 +1663,49 @@ void MTCommandBuffer::SetGraphicsAPIDependentState(const void* stateDesc, std::s
  * ======= Private: =======
  */
 
+void MTCommandBuffer::TrackBufferUsage(const MTBufferUsagePtr& usage)
+{
+    if (!usage)
+        return;
+
+    if (IsSecondaryCmdBuffer())
+    {
+        /* Secondary command buffers are tracked by the primary command buffer that executes them */
+        if (isRecording_)
+            recordedBufferUsages_.push_back(usage);
+    }
+    else if (usage->lastRecording.exchange(recordingID_) != recordingID_)
+    {
+        /* Reference buffer once per recording until the completed handler of this command buffer releases it */
+        usage->numCmdBuffers.fetch_add(1);
+        trackedBufferUsages_->push_back(usage);
+    }
+}
+
+void MTCommandBuffer::EncodeParallelRenderPass(id<MTLRenderCommandEncoder> renderEncoder)
+{
+    /* Use the encoder scheduler of this secondary command buffer exclusively for the sub-encoder of the calling worker thread */
+    encoderScheduler_.Reset(nil);
+    encoderScheduler_.BindRenderSubEncoder(renderEncoder);
+    ResetStateReferences();
+
+    for (const auto& command : recordedCommands_)
+        command(*this);
+
+    /* End sub-encoder; the parallel render command encoder is ended by the primary command buffer */
+    encoderScheduler_.Flush();
+}
+
+void MTCommandBuffer::ResetStateReferences()
+{
+    numThreadsPerGroup_     = &g_defaultNumThreadsPerGroup;
+    numPatchControlPoints_  = 0;
+    tessPipelineState_      = nil;
+    meshGraphicsPSO_        = nullptr;
+    skipDraws_              = false;
+    skipDispatches_         = false;
+}
+
 void MTCommandBuffer::SetIndexType(bool indexType16Bits)
 {
     if (indexType16Bits)
@@ -1054,21 +1720,31 @@ void MTCommandBuffer::SetIndexType(bool indexType16Bits)
     }
 }
 
-void MTCommandBuffer::QueueDrawable(id<MTLDrawable> drawable)
+void MTCommandBuffer::QueueSwapChain(MTSwapChain* swapChainMT)
 {
-    for (auto d : drawables_)
+    for (auto s : swapChains_)
     {
-        if (d == drawable)
+        if (s == swapChainMT)
             return;
     }
-    drawables_.push_back(drawable);
+    swapChains_.push_back(swapChainMT);
 }
 
-void MTCommandBuffer::PresentDrawables()
+void MTCommandBuffer::PresentSwapChains()
 {
-    for (auto d : drawables_)
-        [cmdBuffer_ presentDrawable:d];
-    drawables_.clear();
+    if (swapChains_.empty())
+        return;
+
+    /* Acquire drawables as late as possible, i.e. after all render passes of this command buffer have been encoded */
+    id<MTLBlitCommandEncoder> blitEncoder = encoderScheduler_.BindBlitEncoder();
+    for (auto s : swapChains_)
+    {
+        if (id<MTLDrawable> drawable = s->CopyToNextDrawable(blitEncoder))
+            [cmdBuffer_ presentDrawable:drawable];
+        s->NotifyFramePresented(cmdBuffer_);
+    }
+    encoderScheduler_.Flush();
+    swapChains_.clear();
 }
 
 #if 0//TODO: store direct binding in <MTEncoderScheduler>
@@ -1224,8 +1900,8 @@ void MTCommandBuffer::DispatchTessellatorStage(NSUInteger numPatchesAndInstances
 {
     if (tessPipelineState_ != nil)
     {
-        /* Ensure internal tessellation factor buffer is large enough */
-        tessFactorBuffer_.Grow(tessFactorSize_ * numPatchesAndInstances);
+        /* Allocate a range of the shared tessellation factor buffer that is disjoint from the ranges of previous draws */
+        tessFactorOffset_ = tessFactorBuffer_.Allocate(tessFactorSize_ * numPatchesAndInstances);
 
         /* Encode kernel dispatch to generate tessellation factors for each patch */
         encoderScheduler_.PauseRenderEncoder();
@@ -1237,7 +1913,7 @@ void MTCommandBuffer::DispatchTessellatorStage(NSUInteger numPatchesAndInstances
 
             /* Disaptch kernel to generate patch tessellation factors */
             [computeEncoder setComputePipelineState: tessPipelineState_];
-            [computeEncoder setBuffer:tessFactorBuffer_.GetNative() offset:0 atIndex:tessFactorBufferSlot_];
+            [computeEncoder setBuffer:tessFactorBuffer_.GetNative() offset:tessFactorOffset_ atIndex:tessFactorBufferSlot_];
 
             DispatchThreads1D(computeEncoder, tessPipelineState_, numPatchesAndInstances);
         }
@@ -1251,8 +1927,8 @@ id<MTLRenderCommandEncoder> MTCommandBuffer::GetRenderEncoderForPatches(NSUInteg
 
     [renderEncoder
         setTessellationFactorBuffer:    tessFactorBuffer_.GetNative()
-        offset:                         0
-        instanceStride:                 numPatches * sizeof(MTLQuadTessellationFactorsHalf)
+        offset:                         tessFactorOffset_
+        instanceStride:                 numPatches * tessFactorSize_
     ];
 
     return renderEncoder;
@@ -34,21 +34,53 @@ class MTEncoderScheduler
         // Resets the encoder scheduler with the new command buffer.
         void Reset(id<MTLCommandBuffer> cmdBuffer);
 
-        // Ends the currently bound command encoder.
+        // Ends the currently bound command encoder and encodes the pending render pass if it has any effect without draw commands.
         void Flush();
 
-        // Binds the respective command encoder with the specified descriptor.
-        id<MTLRenderCommandEncoder> BindRenderEncoder(MTLRenderPassDescriptor* renderPassDesc, bool primaryRenderPass = false);
+        /*
+        Schedules a render command encoder with the specified descriptor.
+        The encoder is only created once the first draw command requires it, so blit and compute work can be hoisted ahead of the render pass.
+        */
+        void BindRenderEncoder(MTLRenderPassDescriptor* renderPassDesc, bool primaryRenderPass = false);
+
+        // Binds the respective command encoder.
         id<MTLComputeCommandEncoder> BindComputeEncoder();
         id<MTLBlitCommandEncoder> BindBlitEncoder();
 
-        // Interrupts the render command encoder (if active).
-        void PauseRenderEncoder();
+        /*
+        Interrupts the render command encoder (if active) for blit or compute work. The specified textures are accessed by that work (optional).
+        If the render pass has not been encoded yet and none of its attachments alias those textures, the work is hoisted ahead of the render pass.
+        */
+        void PauseRenderEncoder(id<MTLTexture> texture = nil, id<MTLTexture> otherTexture = nil);
+
+        /*
+        Resumes the render command encoder after it has been paused.
+        The new encoder is only created on the next draw command, so consecutive blit and compute work is merged and sunk after the render pass if no draw command follows.
+        */
         void ResumeRenderEncoder();
 
+        /*
+        Creates a new sub-encoder of the parallel render command encoder for the current render pass and encodes it with the specified block on a worker thread.
+        The parallel render command encoder is created by the first call within a render pass and ended (after all worker threads are done) when the render pass ends.
+        Sub-encoders are executed by the GPU in the order of these calls.
+        */
+        void DispatchParallelRenderEncoder(void (^encodeBlock)(id<MTLRenderCommandEncoder> renderEncoder));
+
+        // Binds the specified sub-encoder of a parallel render command encoder that is exclusively used by this encoder scheduler.
+        void BindRenderSubEncoder(id<MTLRenderCommandEncoder> renderEncoder);
+
+        // Returns true if a render pass has been scheduled and not yet ended with Flush.
+        inline bool IsInsideRenderPass() const
+        {
+            return isInsideRenderPass_;
+        }
+
         // Retunrs a copy of the current render pass descriptor or null if there is none.
         MTLRenderPassDescriptor* CopyRenderPassDesc();
 
+        // Returns the descriptor of the render pass that has not been encoded yet, so its clear values can be merged into it; otherwise nil.
+        MTLRenderPassDescriptor* ModifyPendingRenderPassDesc();
+
     public:
 
         // Converts, binds, and stores the respective state in the internal render encoder state.
@@ -96,9 +128,27 @@ class MTEncoderScheduler
 
     private:
 
+        // Ends the currently active command encoder.
+        void EndEncoding();
+
+        // Creates the render command encoder for the pending render pass.
+        void CreateRenderEncoder();
+
+        // Releases the descriptor of the pending render pass.
+        void ReleasePendingRenderPass();
+
+        // Returns a copy of the current render pass descriptor with load actions for all attachments to continue an interrupted render pass.
+        MTLRenderPassDescriptor* CopyRenderPassDescWithLoadActions();
+
         void SubmitRenderEncoderState();
         void ResetRenderEncoderState();
 
+        // Binds the vertex buffers of the render encoder state, but only those slots whose buffer or offset has changed.
+        void SubmitVertexBuffers();
+
+        // Resets the cache of bindings of the current render command encoder and marks all render states as dirty.
+        void InvalidateRenderEncoderBindings();
+
         void SubmitComputeEncoderState();
         void ResetComputeEncoderState();
 
@@ -128,6 +178,13 @@ class MTEncoderScheduler
             bool            stencilRefDynamic                                   = false;
         };
 
+        // Vertex buffer bindings that have been submitted to the current render command encoder.
+        struct MTRenderEncoderBindings
+        {
+            id<MTLBuffer>   vertexBuffers[g_maxNumVertexBuffers]        = {};
+            NSUInteger      vertexBufferOffsets[g_maxNumVertexBuffers]  = {};
+        };
+
         struct MTComputeEncoderState
         {
             MTComputePSO*   computePSO          = nullptr;
@@ -144,10 +201,17 @@ class MTEncoderScheduler
         id<MTLBlitCommandEncoder>       blitEncoder_            = nil;
 
         MTLRenderPassDescriptor*        renderPassDesc_         = nullptr;
+        MTLRenderPassDescriptor*        pendingRenderPassDesc_  = nil;
+        bool                            isRenderPassRequired_   = false;
         MTRenderEncoderState            renderEncoderState_;
+        MTRenderEncoderBindings         renderEncoderBindings_;
         MTComputeEncoderState           computeEncoderState_;
 
         bool                            isRenderEncoderPaused_  = false;
+        bool                            isInsideRenderPass_     = false;
+
+        id<MTLParallelRenderCommandEncoder> parallelRenderEncoder_  = nil;
+        dispatch_group_t                    parallelEncodingGroup_  = nullptr;
 
         union
         {
@@ -12,6 +12,8 @@
 #include <LLGL/PipelineStateFlags.h>
 #include <LLGL/Platform/Platform.h>
 #include <algorithm>
+#include <iterator>
+#include <string.h>
 
 
 namespace LLGL
@@ -22,49 +24,42 @@ void MTEncoderScheduler::Reset(id<MTLCommandBuffer> cmdBuffer)
 {
     cmdBuffer_ = cmdBuffer;
     isRenderEncoderPaused_ = false;
+    isInsideRenderPass_ = false;
+    ReleasePendingRenderPass();
     ResetRenderEncoderState();
     ResetComputeEncoderState();
 }
 
 void MTEncoderScheduler::Flush()
 {
-    if (renderEncoder_ != nil)
-    {
-        [renderEncoder_ endEncoding];
-        renderEncoder_ = nil;
-    }
-    else if (computeEncoder_ != nil)
-    {
-        [computeEncoder_ endEncoding];
-        computeEncoder_ = nil;
-    }
-    else if (blitEncoder_ != nil)
-    {
-        [blitEncoder_ endEncoding];
-        blitEncoder_ = nil;
-    }
+    /* Encode pending render pass only if it has an effect without draw commands, e.g. to clear its attachments */
+    if (pendingRenderPassDesc_ != nil && isRenderPassRequired_)
+        CreateRenderEncoder();
+    ReleasePendingRenderPass();
+    EndEncoding();
+    isRenderEncoderPaused_ = false;
+    isInsideRenderPass_ = false;
 }
 
-id<MTLRenderCommandEncoder> MTEncoderScheduler::BindRenderEncoder(MTLRenderPassDescriptor* renderPassDesc, bool primaryRenderPass)
+void MTEncoderScheduler::BindRenderEncoder(MTLRenderPassDescriptor* renderPassDesc, bool primaryRenderPass)
 {
     Flush();
-    renderEncoder_ = [cmdBuffer_ renderCommandEncoderWithDescriptor:renderPassDesc];
+
+    /* Defer creation of render command encoder until the first draw command; copy descriptor so clear values can be merged into it */
+    pendingRenderPassDesc_  = (MTLRenderPassDescriptor*)[renderPassDesc copy];
+    isRenderPassRequired_   = true;
+    isInsideRenderPass_     = true;
 
     /* Store descriptor for primary render pass */
     if (primaryRenderPass)
         renderPassDesc_ = renderPassDesc;
-
-    /* A new render command encoder forces all pipeline states to be reset */
-    renderDirtyBits_.bits = ~0;
-
-    return renderEncoder_;
 }
 
 id<MTLComputeCommandEncoder> MTEncoderScheduler::BindComputeEncoder()
 {
     if (computeEncoder_ == nil)
     {
-        Flush();
+        EndEncoding();
         computeEncoder_ = [cmdBuffer_ computeCommandEncoder];
 
         /* A new compute command encoder forces all pipeline states to be reset */
@@ -77,33 +72,109 @@ id<MTLBlitCommandEncoder> MTEncoderScheduler::BindBlitEncoder()
 {
     if (blitEncoder_ == nil)
     {
-        Flush();
+        EndEncoding();
         blitEncoder_ = [cmdBuffer_ blitCommandEncoder];
     }
     return blitEncoder_;
 }
 
-void MTEncoderScheduler::PauseRenderEncoder()
+// Returns true if the two textures refer to the same texture object, directly or via a texture view.
+static bool IsSameTexture(id<MTLTexture> lhs, id<MTLTexture> rhs)
+{
+    if (lhs == nil || rhs == nil)
+        return false;
+    return (lhs == rhs || [lhs parentTexture] == rhs || [rhs parentTexture] == lhs);
+}
+
+// Returns true if the specified texture is an attachment or resolve target of the specified render pass.
+static bool IsRenderPassAttachment(MTLRenderPassDescriptor* renderPassDesc, id<MTLTexture> texture)
 {
+    if (texture == nil)
+        return false;
+
+    for (NSUInteger i = 0; i < 8; ++i)
+    {
+        MTLRenderPassColorAttachmentDescriptor* colorAttachment = renderPassDesc.colorAttachments[i];
+        if (IsSameTexture(colorAttachment.texture, texture) || IsSameTexture(colorAttachment.resolveTexture, texture))
+            return true;
+    }
+
+    return
+    (
+        IsSameTexture(renderPassDesc.depthAttachment.texture,           texture) ||
+        IsSameTexture(renderPassDesc.depthAttachment.resolveTexture,    texture) ||
+        IsSameTexture(renderPassDesc.stencilAttachment.texture,         texture) ||
+        IsSameTexture(renderPassDesc.stencilAttachment.resolveTexture,  texture)
+    );
+}
+
+void MTEncoderScheduler::PauseRenderEncoder(id<MTLTexture> texture, id<MTLTexture> otherTexture)
+{
+    if (renderEncoder_ == nil && pendingRenderPassDesc_ != nil && isRenderPassRequired_)
+    {
+        /* Work can only be hoisted ahead of the pending render pass if it does not access any of its attachments */
+        if (IsRenderPassAttachment(pendingRenderPassDesc_, texture) || IsRenderPassAttachment(pendingRenderPassDesc_, otherTexture))
+            CreateRenderEncoder();
+    }
     if (renderEncoder_ != nil && !isRenderEncoderPaused_)
         isRenderEncoderPaused_ = true;
 }
 
 void MTEncoderScheduler::ResumeRenderEncoder()
 {
-    if (isRenderEncoderPaused_)
+    if (isRenderEncoderPaused_ && renderEncoder_ != nil)
     {
-        auto renderPassDesc = CopyRenderPassDesc();
-        {
-            for (NSUInteger i = 0; i < 8; ++i)
-                renderPassDesc.colorAttachments[i].loadAction = MTLLoadActionLoad;
-            renderPassDesc.depthAttachment.loadAction = MTLLoadActionLoad;
-            renderPassDesc.stencilAttachment.loadAction = MTLLoadActionLoad;
-        }
-        BindRenderEncoder(renderPassDesc);
-        [renderPassDesc release];
+        /* Render command encoder has not been interrupted by any other encoder */
         isRenderEncoderPaused_ = false;
     }
+    else if (isRenderEncoderPaused_)
+    {
+        auto renderPassDesc = CopyRenderPassDescWithLoadActions();
+
+        /* Keep the interrupting blit or compute encoder active, so subsequent work of the same kind is merged into it */
+        ReleasePendingRenderPass();
+        pendingRenderPassDesc_  = renderPassDesc;
+        isRenderPassRequired_   = false;
+        isRenderEncoderPaused_  = false;
+    }
+}
+
+void MTEncoderScheduler::DispatchParallelRenderEncoder(void (^encodeBlock)(id<MTLRenderCommandEncoder> renderEncoder))
+{
+    if (parallelRenderEncoder_ == nil)
+    {
+        /* Start parallel encoder with the pending render pass, or continue the render pass if it has already been encoded */
+        MTLRenderPassDescriptor* renderPassDesc = nil;
+        if (pendingRenderPassDesc_ != nil)
+            renderPassDesc = [pendingRenderPassDesc_ retain];
+        else
+            renderPassDesc = CopyRenderPassDescWithLoadActions();
+
+        EndEncoding();
+        parallelRenderEncoder_ = [[cmdBuffer_ parallelRenderCommandEncoderWithDescriptor:renderPassDesc] retain];
+        parallelEncodingGroup_ = dispatch_group_create();
+
+        ReleasePendingRenderPass();
+        [renderPassDesc release];
+    }
+
+    /* Sub-encoders must be created in submission order, but they can be encoded on any thread */
+    id<MTLRenderCommandEncoder> renderEncoder = [parallelRenderEncoder_ renderCommandEncoder];
+    dispatch_group_async(
+        parallelEncodingGroup_,
+        dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0),
+        ^{
+            encodeBlock(renderEncoder);
+        }
+    );
+}
+
+void MTEncoderScheduler::BindRenderSubEncoder(id<MTLRenderCommandEncoder> renderEncoder)
+{
+    renderEncoder_ = renderEncoder;
+
+    /* A new render command encoder forces all pipeline states to be reset */
+    InvalidateRenderEncoderBindings();
 }
 
 MTLRenderPassDescriptor* MTEncoderScheduler::CopyRenderPassDesc()
@@ -111,6 +182,17 @@ MTLRenderPassDescriptor* MTEncoderScheduler::CopyRenderPassDesc()
     return (MTLRenderPassDescriptor*)[renderPassDesc_ copy];
 }
 
+MTLRenderPassDescriptor* MTEncoderScheduler::ModifyPendingRenderPassDesc()
+{
+    if (renderEncoder_ == nil && pendingRenderPassDesc_ != nil)
+    {
+        /* Modified render pass must be encoded even if no draw command follows */
+        isRenderPassRequired_ = true;
+        return pendingRenderPassDesc_;
+    }
+    return nil;
+}
+
 static void Convert(MTLViewport& dst, const Viewport& src)
 {
     const double scaling = 1.0;//2.0 for retina display
@@ -124,10 +206,20 @@ static void Convert(MTLViewport& dst, const Viewport& src)
 
 void MTEncoderScheduler::SetViewports(const Viewport* viewports, NSUInteger viewportCount)
 {
-    renderEncoderState_.viewportCount = std::min(viewportCount, NSUInteger(LLGL_MAX_NUM_VIEWPORTS_AND_SCISSORS));
-    for (std::uint32_t i = 0; i < renderEncoderState_.viewportCount; ++i)
-        Convert(renderEncoderState_.viewports[i], viewports[i]);
-    renderDirtyBits_.viewports = 1;
+    viewportCount = std::min(viewportCount, NSUInteger(LLGL_MAX_NUM_VIEWPORTS_AND_SCISSORS));
+
+    MTLViewport newViewports[LLGL_MAX_NUM_VIEWPORTS_AND_SCISSORS];
+    for (NSUInteger i = 0; i < viewportCount; ++i)
+        Convert(newViewports[i], viewports[i]);
+
+    /* Only mark viewports as dirty if they differ from the current ones */
+    if (viewportCount != renderEncoderState_.viewportCount ||
+        ::memcmp(newViewports, renderEncoderState_.viewports, sizeof(MTLViewport) * viewportCount) != 0)
+    {
+        renderEncoderState_.viewportCount = viewportCount;
+        std::copy(newViewports, newViewports + viewportCount, renderEncoderState_.viewports);
+        renderDirtyBits_.viewports = 1;
+    }
 }
 
 static void Convert(MTLScissorRect& dst, const Scissor& scissor)
@@ -140,10 +232,20 @@ static void Convert(MTLScissorRect& dst, const Scissor& scissor)
 
 void MTEncoderScheduler::SetScissorRects(const Scissor* scissors, NSUInteger scissorCount)
 {
-    renderEncoderState_.scissorRectCount = std::min(scissorCount, NSUInteger(LLGL_MAX_NUM_VIEWPORTS_AND_SCISSORS));
-    for (std::uint32_t i = 0; i < renderEncoderState_.scissorRectCount; ++i)
-        Convert(renderEncoderState_.scissorRects[i], scissors[i]);
-    renderDirtyBits_.scissors = 1;
+    scissorCount = std::min(scissorCount, NSUInteger(LLGL_MAX_NUM_VIEWPORTS_AND_SCISSORS));
+
+    MTLScissorRect newScissorRects[LLGL_MAX_NUM_VIEWPORTS_AND_SCISSORS];
+    for (NSUInteger i = 0; i < scissorCount; ++i)
+        Convert(newScissorRects[i], scissors[i]);
+
+    /* Only mark scissor rectangles as dirty if they differ from the current ones */
+    if (scissorCount != renderEncoderState_.scissorRectCount ||
+        ::memcmp(newScissorRects, renderEncoderState_.scissorRects, sizeof(MTLScissorRect) * scissorCount) != 0)
+    {
+        renderEncoderState_.scissorRectCount = scissorCount;
+        std::copy(newScissorRects, newScissorRects + scissorCount, renderEncoderState_.scissorRects);
+        renderDirtyBits_.scissors = 1;
+    }
 }
 
 void MTEncoderScheduler::SetVertexBuffer(id<MTLBuffer> buffer, NSUInteger offset)
@@ -168,33 +270,46 @@ void MTEncoderScheduler::SetVertexBuffers(const id<MTLBuffer>* buffers, const NS
 
 void MTEncoderScheduler::SetGraphicsPSO(MTGraphicsPSO* pipelineState)
 {
-    if (pipelineState != nullptr)
+    if (pipelineState != nullptr && pipelineState != renderEncoderState_.graphicsPSO)
     {
         renderEncoderState_.graphicsPSO         = pipelineState;
         renderEncoderState_.blendColorDynamic   = pipelineState->IsBlendColorDynamic();
         renderEncoderState_.stencilRefDynamic   = pipelineState->IsStencilRefDynamic();
         renderDirtyBits_.graphicsPSO = 1;
+
+        /* Static blend color and stencil reference of the PSO overwrite the dynamic ones, so they must be submitted again */
+        renderDirtyBits_.blendColor = 1;
+        renderDirtyBits_.stencilRef = 1;
     }
 }
 
 void MTEncoderScheduler::SetGraphicsResourceHeap(MTResourceHeap* resourceHeap, std::uint32_t firstSet)
 {
-    renderEncoderState_.graphicsResourceHeap    = resourceHeap;
-    renderEncoderState_.graphicsResourceSet     = firstSet;
-    renderDirtyBits_.graphicsResourceHeap       = 1;
+    if (resourceHeap != renderEncoderState_.graphicsResourceHeap || firstSet != renderEncoderState_.graphicsResourceSet)
+    {
+        renderEncoderState_.graphicsResourceHeap    = resourceHeap;
+        renderEncoderState_.graphicsResourceSet     = firstSet;
+        renderDirtyBits_.graphicsResourceHeap       = 1;
+    }
 }
 
 void MTEncoderScheduler::SetBlendColor(const float* blendColor)
 {
-    renderEncoderState_.blendColor[0] = blendColor[0];
-    renderEncoderState_.blendColor[1] = blendColor[1];
-    renderEncoderState_.blendColor[2] = blendColor[2];
-    renderEncoderState_.blendColor[3] = blendColor[3];
-    renderDirtyBits_.blendColor = 1;
+    if (::memcmp(renderEncoderState_.blendColor, blendColor, sizeof(renderEncoderState_.blendColor)) != 0)
+    {
+        renderEncoderState_.blendColor[0] = blendColor[0];
+        renderEncoderState_.blendColor[1] = blendColor[1];
+        renderEncoderState_.blendColor[2] = blendColor[2];
+        renderEncoderState_.blendColor[3] = blendColor[3];
+        renderDirtyBits_.blendColor = 1;
+    }
 }
 
 void MTEncoderScheduler::SetStencilRef(std::uint32_t ref, const StencilFace face)
 {
+    const std::uint32_t prevFrontRef   = renderEncoderState_.stencilFrontRef;
+    const std::uint32_t prevBackRef    = renderEncoderState_.stencilBackRef;
+
     switch (face)
     {
         case StencilFace::FrontAndBack:
@@ -208,20 +323,28 @@ void MTEncoderScheduler::SetStencilRef(std::uint32_t ref, const StencilFace face
             renderEncoderState_.stencilBackRef    = ref;
             break;
     }
-    renderDirtyBits_.stencilRef = 1;
+
+    if (renderEncoderState_.stencilFrontRef != prevFrontRef || renderEncoderState_.stencilBackRef != prevBackRef)
+        renderDirtyBits_.stencilRef = 1;
 }
 
 void MTEncoderScheduler::SetComputePSO(MTComputePSO* pipelineState)
 {
-    computeEncoderState_.computePSO = pipelineState;
-    computeDirtyBits_.computePSO = 1;
+    if (pipelineState != computeEncoderState_.computePSO)
+    {
+        computeEncoderState_.computePSO = pipelineState;
+        computeDirtyBits_.computePSO = 1;
+    }
 }
 
 void MTEncoderScheduler::SetComputeResourceHeap(MTResourceHeap* resourceHeap, std::uint32_t firstSet)
 {
-    computeEncoderState_.computeResourceHeap    = resourceHeap;
-    computeEncoderState_.computeResourceSet     = firstSet;
-    computeDirtyBits_.computeResourceHeap       = 1;
+    if (resourceHeap != computeEncoderState_.computeResourceHeap || firstSet != computeEncoderState_.computeResourceSet)
+    {
+        computeEncoderState_.computeResourceHeap    = resourceHeap;
+        computeEncoderState_.computeResourceSet     = firstSet;
+        computeDirtyBits_.computeResourceHeap       = 1;
+    }
 }
 
 void MTEncoderScheduler::RebindResourceHeap(id<MTLComputeCommandEncoder> computeEncoder)
@@ -237,6 +360,8 @@ void MTEncoderScheduler::RebindResourceHeap(id<MTLComputeCommandEncoder> compute
 
 id<MTLRenderCommandEncoder> MTEncoderScheduler::GetRenderEncoderAndFlushState()
 {
+    if (renderEncoder_ == nil && pendingRenderPassDesc_ != nil)
+        CreateRenderEncoder();
     if (renderDirtyBits_.bits != 0)
         SubmitRenderEncoderState();
     return GetRenderEncoder();
@@ -256,6 +381,76 @@ id<MTLComputeCommandEncoder> MTEncoderScheduler::GetComputeEncoderAndFlushState(
  * ======= Private: =======
  */
 
+void MTEncoderScheduler::EndEncoding()
+{
+    if (parallelRenderEncoder_ != nil)
+    {
+        /* Wait until all worker threads have encoded their sub-encoders before the parallel render command encoder can end */
+        dispatch_group_wait(parallelEncodingGroup_, DISPATCH_TIME_FOREVER);
+        dispatch_release(parallelEncodingGroup_);
+        parallelEncodingGroup_ = nullptr;
+
+        [parallelRenderEncoder_ endEncoding];
+        [parallelRenderEncoder_ release];
+        parallelRenderEncoder_ = nil;
+    }
+    else if (renderEncoder_ != nil)
+    {
+        [renderEncoder_ endEncoding];
+        renderEncoder_ = nil;
+    }
+    else if (computeEncoder_ != nil)
+    {
+        [computeEncoder_ endEncoding];
+        computeEncoder_ = nil;
+    }
+    else if (blitEncoder_ != nil)
+    {
+        [blitEncoder_ endEncoding];
+        blitEncoder_ = nil;
+    }
+}
+
+void MTEncoderScheduler::CreateRenderEncoder()
+{
+    EndEncoding();
+    renderEncoder_ = [cmdBuffer_ renderCommandEncoderWithDescriptor:pendingRenderPassDesc_];
+    ReleasePendingRenderPass();
+
+    /* A new render command encoder forces all pipeline states to be reset */
+    InvalidateRenderEncoderBindings();
+}
+
+// Sets the load action of the specified attachment to 'Load', unless its texture is memoryless, whose content cannot be loaded.
+static void SetLoadActionLoad(MTLRenderPassAttachmentDescriptor* attachment)
+{
+    if (@available(macOS 11.0, iOS 10.0, *))
+    {
+        if (attachment.texture != nil && attachment.texture.storageMode == MTLStorageModeMemoryless)
+            return;
+    }
+    attachment.loadAction = MTLLoadActionLoad;
+}
+
+MTLRenderPassDescriptor* MTEncoderScheduler::CopyRenderPassDescWithLoadActions()
+{
+    auto renderPassDesc = CopyRenderPassDesc();
+    {
+        for (NSUInteger i = 0; i < 8; ++i)
+            SetLoadActionLoad(renderPassDesc.colorAttachments[i]);
+        SetLoadActionLoad(renderPassDesc.depthAttachment);
+        SetLoadActionLoad(renderPassDesc.stencilAttachment);
+    }
+    return renderPassDesc;
+}
+
+void MTEncoderScheduler::ReleasePendingRenderPass()
+{
+    [pendingRenderPassDesc_ release];
+    pendingRenderPassDesc_  = nil;
+    isRenderPassRequired_   = false;
+}
+
 void MTEncoderScheduler::SubmitRenderEncoderState()
 {
     if (renderEncoder_ == nil)
@@ -289,12 +484,8 @@ void MTEncoderScheduler::SubmitRenderEncoderState()
     }
     if (renderEncoderState_.vertexBufferRange.length > 0 && renderDirtyBits_.vertexBuffers != 0)
     {
-        /* Bind vertex buffers */
-        [renderEncoder_
-            setVertexBuffers:   renderEncoderState_.vertexBuffers
-            offsets:            renderEncoderState_.vertexBufferOffsets
-            withRange:          renderEncoderState_.vertexBufferRange
-        ];
+        /* Bind only those vertex buffers that differ from the ones that are already bound to the encoder */
+        SubmitVertexBuffers();
     }
     if (renderEncoderState_.graphicsPSO != nullptr && renderDirtyBits_.graphicsPSO != 0)
     {
@@ -337,6 +528,55 @@ void MTEncoderScheduler::SubmitRenderEncoderState()
     renderDirtyBits_.bits = 0;
 }
 
+void MTEncoderScheduler::SubmitVertexBuffers()
+{
+    const NSUInteger first  = renderEncoderState_.vertexBufferRange.location;
+    const NSUInteger last   = first + renderEncoderState_.vertexBufferRange.length;
+
+    const id<MTLBuffer>*    buffers         = renderEncoderState_.vertexBuffers;
+    const NSUInteger*       offsets         = renderEncoderState_.vertexBufferOffsets;
+    id<MTLBuffer>*          boundBuffers    = renderEncoderBindings_.vertexBuffers;
+    NSUInteger*             boundOffsets    = renderEncoderBindings_.vertexBufferOffsets;
+
+    for (NSUInteger i = first; i < last;)
+    {
+        if (buffers[i] == boundBuffers[i])
+        {
+            /* Only update offset if the same buffer is already bound to this slot */
+            if (buffers[i] != nil && offsets[i] != boundOffsets[i])
+            {
+                [renderEncoder_ setVertexBufferOffset:offsets[i] atIndex:i];
+                boundOffsets[i] = offsets[i];
+            }
+            ++i;
+        }
+        else
+        {
+            /* Bind consecutive range of slots with different buffers at once */
+            NSUInteger end = i + 1;
+            while (end < last && buffers[end] != boundBuffers[end])
+                ++end;
+
+            [renderEncoder_
+                setVertexBuffers:   &buffers[i]
+                offsets:            &offsets[i]
+                withRange:          NSMakeRange(i, end - i)
+            ];
+
+            std::copy(buffers + i, buffers + end, boundBuffers + i);
+            std::copy(offsets + i, offsets + end, boundOffsets + i);
+            i = end;
+        }
+    }
+}
+
+void MTEncoderScheduler::InvalidateRenderEncoderBindings()
+{
+    std::fill(std::begin(renderEncoderBindings_.vertexBuffers), std::end(renderEncoderBindings_.vertexBuffers), nil);
+    std::fill(std::begin(renderEncoderBindings_.vertexBufferOffsets), std::end(renderEncoderBindings_.vertexBufferOffsets), 0);
+    renderDirtyBits_.bits = ~0;
+}
+
 void MTEncoderScheduler::ResetRenderEncoderState()
 {
     renderEncoderState_.viewportCount             = 0;
@@ -351,12 +591,12 @@ void MTEncoderScheduler::SubmitComputeEncoderState()
     if (computeEncoder_ == nil)
         return;
 
-    if (computeEncoderState_.computePSO != nullptr && computeEncoderState_.computePSO != 0)
+    if (computeEncoderState_.computePSO != nullptr && computeDirtyBits_.computePSO != 0)
     {
         /* Bind compute pipeline */
         computeEncoderState_.computePSO->Bind(computeEncoder_);
     }
-    if (computeEncoderState_.computeResourceHeap != nullptr && computeEncoderState_.computeResourceHeap != 0)
+    if (computeEncoderState_.computeResourceHeap != nullptr && computeDirtyBits_.computeResourceHeap != 0)
     {
         /* Bind resource heap */
         computeEncoderState_.computeResourceHeap->BindComputeResources(
@@ -39,6 +39,47 @@ static int FeatureSetToVersion(MTLFeatureSet fset)
     return 100; // 1.0
 }
 
+// Returns true if the specified device can encode draw commands on the GPU into an MTLIndirectCommandBuffer.
+static bool SupportsIndirectCommandBuffers(id<MTLDevice> device)
+{
+    #ifdef LLGL_OS_IOS
+    if (@available(iOS 13.0, *))
+        return [device supportsFeatureSet:MTLFeatureSet_iOS_GPUFamily3_v4];
+    #else
+    if (@available(macOS 10.14, *))
+        return [device supportsFeatureSet:MTLFeatureSet_macOS_GPUFamily2_v1];
+    #endif
+    return false;
+}
+
+// Returns true if the specified device can allocate sparse textures from an MTLHeapTypeSparse heap.
+static bool SupportsSparseTextures(id<MTLDevice> device)
+{
+    if (@available(macOS 11.0, iOS 13.0, *))
+        return [device supportsFamily:MTLGPUFamilyApple6];
+    return false;
+}
+
+// Returns true if the specified device supports programmable blending, i.e. fragment shaders can read color attachments in place.
+static bool SupportsProgrammableBlending(id<MTLDevice> device)
+{
+    #ifdef LLGL_OS_IOS
+    return true;
+    #else
+    if (@available(macOS 11.0, *))
+        return [device supportsFamily:MTLGPUFamilyApple1];
+    return false;
+    #endif
+}
+
+// Returns true if the specified device supports mesh render pipelines with object and mesh functions.
+static bool SupportsMeshShaders(id<MTLDevice> device)
+{
+    if (@available(macOS 13.0, iOS 16.0, *))
+        return ([device supportsFamily:MTLGPUFamilyApple7] || [device supportsFamily:MTLGPUFamilyMac2]);
+    return false;
+}
+
 static std::vector<Format> GetDefaultSupportedMTTextureFormats()
 {
     return
@@ -110,13 +151,18 @@ void LoadFeatureSetCaps(id<MTLDevice> device, MTLFeatureSet fset, RenderingCapab
     features.hasTessellationShaders         = false;
     features.hasTessellatorStage            = true;
     features.hasComputeShaders              = true;
+    features.hasMeshShaders                 = SupportsMeshShaders(device);
     features.hasInstancing                  = true;
     features.hasOffsetInstancing            = true;
     features.hasIndirectDrawing             = true;
+    features.hasIndirectCommandBuffers      = SupportsIndirectCommandBuffers(device);
     features.hasViewportArrays              = (version >= 103);
     features.hasConservativeRasterization   = false;
     features.hasStreamOutputs               = false;
     features.hasLogicOp                     = false;
+    features.hasNativeCommandLists          = true;
+    features.hasSparseTextures              = SupportsSparseTextures(device);
+    features.hasFramebufferFetch            = SupportsProgrammableBlending(device);
 
     /* Specify limits */
     auto& limits = caps.limits;
@@ -142,6 +188,13 @@ void LoadFeatureSetCaps(id<MTLDevice> device, MTLFeatureSet fset, RenderingCapab
     limits.maxComputeShaderWorkGroupSize[1] = static_cast<std::uint32_t>(workGroupSize.height);
     limits.maxComputeShaderWorkGroupSize[2] = static_cast<std::uint32_t>(workGroupSize.depth);
 
+    if (features.hasMeshShaders)
+    {
+        limits.maxMeshShaderWorkGroups[0]   = 1024u; //???
+        limits.maxMeshShaderWorkGroups[1]   = 1024u; //???
+        limits.maxMeshShaderWorkGroups[2]   = 1024u; //???
+    }
+
     #ifdef LLGL_OS_IOS
     limits.maxTessFactor                    = 16u;
     #else
@@ -0,0 +1,101 @@
+/*
+ * MTMemoryManager.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MT_MEMORY_MANAGER_H
+#define LLGL_MT_MEMORY_MANAGER_H
+
+
+#import <Metal/Metal.h>
+
+#include <LLGL/RenderSystemFlags.h>
+#include <vector>
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+/*
+Metal memory manager that sub-allocates buffers and textures from large MTLHeap objects instead of allocating each of them from the MTLDevice.
+Heaps are kept in separate lists for each storage mode. Only private storage (and shared storage on iOS) can be allocated from heaps,
+so managed resources and resources that take up more than a quarter of a heap are still allocated from the device.
+Heaps use tracked hazards, so resources of the same heap can alias each other once they have been made aliasable (see MiscFlags::Aliasable).
+This requires macOS 10.15 or iOS 13.0; otherwise, all resources are allocated from the device.
+All public functions are guarded by a mutex, so resources can be created from multiple threads.
+*/
+class MTMemoryManager
+{
+
+    public:
+
+        MTMemoryManager(id<MTLDevice> device, NSUInteger heapSize = 64u*1024u*1024u, NSUInteger sparseHeapSize = 256u*1024u*1024u);
+        ~MTMemoryManager();
+
+        MTMemoryManager(const MTMemoryManager&) = delete;
+        MTMemoryManager& operator = (const MTMemoryManager&) = delete;
+
+        // Creates a new buffer of the specified length and resource options. The buffer is sub-allocated from a heap if possible.
+        id<MTLBuffer> NewBuffer(NSUInteger length, MTLResourceOptions options);
+
+        // Creates a new texture with the specified descriptor. The texture is sub-allocated from a heap if possible.
+        id<MTLTexture> NewTexture(MTLTextureDescriptor* desc);
+
+        /*
+        Creates a new sparse texture with the specified descriptor. All sparse textures are allocated from a single sparse heap of fixed size,
+        which provides the memory for all tiles that are mapped with an MTLResourceStateCommandEncoder. Returns nil if sparse heaps are not supported.
+        */
+        id<MTLTexture> NewSparseTexture(MTLTextureDescriptor* desc);
+
+        // Accumulates the statistics of all heaps into the output heap statistics for video memory (private heaps) and system memory (shared heaps).
+        void AccumStatistics(MemoryHeapStatistics& outLocalStats, MemoryHeapStatistics& outNonLocalStats) const;
+
+        // Returns the device this memory manager allocates its heaps from.
+        inline id<MTLDevice> GetDevice() const
+        {
+            return device_;
+        }
+
+    private:
+
+        enum HeapCategory
+        {
+            HeapCategory_Private = 0,
+            HeapCategory_Shared,
+            HeapCategory_Num,
+        };
+
+    private:
+
+        // Returns true if resources with the specified options can be allocated from a heap and stores the heap category in 'outCategory'.
+        bool GetHeapCategory(MTLResourceOptions options, HeapCategory& outCategory) const;
+
+        // Creates a new heap of the specified category that can hold at least the specified size.
+        id<MTLHeap> CreateHeap(HeapCategory category, MTLResourceOptions options, NSUInteger minSize);
+
+    private:
+
+        id<MTLDevice>               device_                     = nil;
+        NSUInteger                  heapSize_                   = 0;
+        bool                        isHeapSupported_            = false;
+
+        std::vector<id<MTLHeap>>    heaps_[HeapCategory_Num];
+        NSUInteger                  sparseHeapSize_             = 0;
+        id<MTLHeap>                 sparseHeap_                 = nil;
+        mutable std::mutex          mutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,224 @@
+/*
+ * MTMemoryManager.mm
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MTMemoryManager.h"
+#include <LLGL/Platform/Platform.h>
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+MTMemoryManager::MTMemoryManager(id<MTLDevice> device, NSUInteger heapSize, NSUInteger sparseHeapSize) :
+    device_         { device         },
+    heapSize_       { heapSize       },
+    sparseHeapSize_ { sparseHeapSize }
+{
+    /* Heaps are only used with tracked hazards, because resources from untracked heaps would require explicit fences */
+    if (@available(macOS 10.15, iOS 13.0, *))
+        isHeapSupported_ = true;
+}
+
+MTMemoryManager::~MTMemoryManager()
+{
+    for (auto& heapList : heaps_)
+    {
+        for (id<MTLHeap> heap : heapList)
+            [heap release];
+    }
+    [sparseHeap_ release];
+}
+
+id<MTLBuffer> MTMemoryManager::NewBuffer(NSUInteger length, MTLResourceOptions options)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    HeapCategory category;
+    if (GetHeapCategory(options, category))
+    {
+        if (@available(macOS 10.15, iOS 13.0, *))
+        {
+            /* Allocate buffer from a heap unless it takes up more than a quarter of a heap */
+            MTLSizeAndAlign sizeAndAlign = [device_ heapBufferSizeAndAlignWithLength:length options:options];
+            if (sizeAndAlign.size <= heapSize_ / 4)
+            {
+                for (id<MTLHeap> heap : heaps_[category])
+                {
+                    if ([heap maxAvailableSizeWithAlignment:sizeAndAlign.align] >= sizeAndAlign.size)
+                    {
+                        if (id<MTLBuffer> buffer = [heap newBufferWithLength:length options:options])
+                            return buffer;
+                    }
+                }
+                if (id<MTLHeap> heap = CreateHeap(category, options, sizeAndAlign.size))
+                {
+                    if (id<MTLBuffer> buffer = [heap newBufferWithLength:length options:options])
+                        return buffer;
+                }
+            }
+        }
+    }
+
+    /* Allocate buffer from device as fallback */
+    return [device_ newBufferWithLength:length options:options];
+}
+
+id<MTLTexture> MTMemoryManager::NewTexture(MTLTextureDescriptor* desc)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    HeapCategory category;
+    if (GetHeapCategory(desc.resourceOptions, category))
+    {
+        if (@available(macOS 10.15, iOS 13.0, *))
+        {
+            /* Allocate texture from a heap unless it takes up more than a quarter of a heap */
+            MTLSizeAndAlign sizeAndAlign = [device_ heapTextureSizeAndAlignWithDescriptor:desc];
+            if (sizeAndAlign.size <= heapSize_ / 4)
+            {
+                for (id<MTLHeap> heap : heaps_[category])
+                {
+                    if ([heap maxAvailableSizeWithAlignment:sizeAndAlign.align] >= sizeAndAlign.size)
+                    {
+                        if (id<MTLTexture> texture = [heap newTextureWithDescriptor:desc])
+                            return texture;
+                    }
+                }
+                if (id<MTLHeap> heap = CreateHeap(category, desc.resourceOptions, sizeAndAlign.size))
+                {
+                    if (id<MTLTexture> texture = [heap newTextureWithDescriptor:desc])
+                        return texture;
+                }
+            }
+        }
+    }
+
+    /* Allocate texture from device as fallback */
+    return [device_ newTextureWithDescriptor:desc];
+}
+
+id<MTLTexture> MTMemoryManager::NewSparseTexture(MTLTextureDescriptor* desc)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    if (@available(macOS 11.0, iOS 13.0, *))
+    {
+        if (sparseHeap_ == nil)
+        {
+            /* Create sparse heap on first use; its size must be a multiple of the sparse tile size */
+            const NSUInteger tileSize = [device_ sparseTileSizeInBytes];
+            MTLHeapDescriptor* heapDesc = [[MTLHeapDescriptor alloc] init];
+            {
+                heapDesc.type               = MTLHeapTypeSparse;
+                heapDesc.size               = (sparseHeapSize_ + tileSize - 1) / tileSize * tileSize;
+                heapDesc.storageMode        = MTLStorageModePrivate;
+                heapDesc.hazardTrackingMode = MTLHazardTrackingModeTracked;
+            }
+            sparseHeap_ = [device_ newHeapWithDescriptor:heapDesc];
+            [heapDesc release];
+        }
+        if (sparseHeap_ != nil)
+            return [sparseHeap_ newTextureWithDescriptor:desc];
+    }
+
+    return nil;
+}
+
+void MTMemoryManager::AccumStatistics(MemoryHeapStatistics& outLocalStats, MemoryHeapStatistics& outNonLocalStats) const
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    for (int i = 0; i < HeapCategory_Num; ++i)
+    {
+        /* Private heaps reside in video memory, shared heaps reside in system memory */
+        auto& stats = (i == HeapCategory_Private ? outLocalStats : outNonLocalStats);
+
+        for (id<MTLHeap> heap : heaps_[i])
+        {
+            stats.allocatedSize += [heap size];
+            stats.usedSize      += [heap usedSize];
+            stats.numAllocations++;
+        }
+    }
+
+    /* Sparse heap resides in video memory */
+    if (sparseHeap_ != nil)
+    {
+        outLocalStats.allocatedSize += [sparseHeap_ size];
+        outLocalStats.usedSize      += [sparseHeap_ usedSize];
+        outLocalStats.numAllocations++;
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool MTMemoryManager::GetHeapCategory(MTLResourceOptions options, HeapCategory& outCategory) const
+{
+    if (!isHeapSupported_)
+        return false;
+
+    /* Heaps are created with default CPU cache mode and tracked hazards, so resources must not deviate from those */
+    if ((options & MTLResourceCPUCacheModeMask) != MTLResourceCPUCacheModeDefaultCache)
+        return false;
+
+    if (@available(macOS 10.15, iOS 13.0, *))
+    {
+        if ((options & MTLResourceHazardTrackingModeMask) == MTLResourceHazardTrackingModeUntracked)
+            return false;
+    }
+
+    switch (options & MTLResourceStorageModeMask)
+    {
+        case MTLResourceStorageModePrivate:
+            outCategory = HeapCategory_Private;
+            return true;
+
+        #ifdef LLGL_OS_IOS
+        case MTLResourceStorageModeShared:
+            outCategory = HeapCategory_Shared;
+            return true;
+        #endif // /LLGL_OS_IOS
+
+        default:
+            return false;
+    }
+}
+
+id<MTLHeap> MTMemoryManager::CreateHeap(HeapCategory category, MTLResourceOptions options, NSUInteger minSize)
+{
+    id<MTLHeap> heap = nil;
+
+    if (@available(macOS 10.15, iOS 13.0, *))
+    {
+        MTLHeapDescriptor* heapDesc = [[MTLHeapDescriptor alloc] init];
+        {
+            heapDesc.type               = MTLHeapTypeAutomatic;
+            heapDesc.size               = std::max(heapSize_, minSize);
+            heapDesc.storageMode        = static_cast<MTLStorageMode>((options & MTLResourceStorageModeMask) >> MTLResourceStorageModeShift);
+            heapDesc.cpuCacheMode       = MTLCPUCacheModeDefaultCache;
+            heapDesc.hazardTrackingMode = MTLHazardTrackingModeTracked;
+        }
+        heap = [device_ newHeapWithDescriptor:heapDesc];
+        [heapDesc release];
+
+        if (heap != nil)
+            heaps_[category].push_back(heap);
+    }
+
+    return heap;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
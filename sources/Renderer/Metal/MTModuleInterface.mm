@@ -30,9 +30,14 @@ namespace ModuleMetal
         return "Metal";
     }
 
-    RenderSystem* AllocRenderSystem(const LLGL::RenderSystemDescriptor* /*renderSystemDesc*/)
+    RenderSystem* AllocRenderSystem(const LLGL::RenderSystemDescriptor* renderSystemDesc)
     {
-        return new MTRenderSystem();
+        return new MTRenderSystem(*renderSystemDesc);
+    }
+
+    void QueryVideoAdapters(const LLGL::RenderSystemDescriptor* /*renderSystemDesc*/, std::vector<LLGL::VideoAdapterDescriptor>& outAdapters)
+    {
+        MTRenderSystem::QueryVideoAdapters(outAdapters);
     }
 } // /namespace ModuleMetal
 
@@ -69,6 +74,19 @@ LLGL_EXPORT void* LLGL_RenderSystem_Alloc(const void* renderSystemDesc, int rend
     return nullptr;
 }
 
+LLGL_EXPORT int LLGL_RenderSystem_QueryVideoAdapters(const void* renderSystemDesc, int renderSystemDescSize, void* outAdapters)
+{
+    if (renderSystemDesc != nullptr && static_cast<std::size_t>(renderSystemDescSize) == sizeof(LLGL::RenderSystemDescriptor) && outAdapters != nullptr)
+    {
+        auto desc       = reinterpret_cast<const LLGL::RenderSystemDescriptor*>(renderSystemDesc);
+        auto adapters   = reinterpret_cast<std::vector<LLGL::VideoAdapterDescriptor>*>(outAdapters);
+        const auto numAdapters = adapters->size();
+        LLGL::ModuleMetal::QueryVideoAdapters(desc, *adapters);
+        return static_cast<int>(adapters->size() - numAdapters);
+    }
+    return 0;
+}
+
 } // /extern "C"
 
 #endif
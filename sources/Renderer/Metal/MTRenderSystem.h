@@ -13,10 +13,12 @@
 
 #include <LLGL/RenderSystem.h>
 #include "../ContainerTypes.h"
+#include "../Serialization.h"
 
 #include "MTCommandQueue.h"
 #include "MTCommandBuffer.h"
 #include "MTSwapChain.h"
+#include "MTMemoryManager.h"
 
 #include "Buffer/MTBuffer.h"
 #include "Buffer/MTBufferArray.h"
@@ -26,6 +28,7 @@
 #include "RenderState/MTResourceHeap.h"
 #include "RenderState/MTRenderPass.h"
 #include "RenderState/MTFence.h"
+#include "RenderState/MTPipelineCache.h"
 
 #include "Shader/MTShader.h"
 
@@ -45,9 +48,12 @@ class MTRenderSystem final : public RenderSystem
 
         /* ----- Common ----- */
 
-        MTRenderSystem();
+        MTRenderSystem(const RenderSystemDescriptor& renderSystemDesc);
         ~MTRenderSystem();
 
+        // Appends a video adapter descriptor for each Metal device, in the order that is used by RenderSystemDescriptor::adapterIndex.
+        static void QueryVideoAdapters(std::vector<VideoAdapterDescriptor>& outAdapters);
+
         /* ----- Swap-chain ----- */
 
         SwapChain* CreateSwapChain(const SwapChainDescriptor& swapChainDesc, const std::shared_ptr<Surface>& surface = nullptr) override;
@@ -67,7 +73,7 @@ class MTRenderSystem final : public RenderSystem
         /* ----- Buffers ------ */
 
         Buffer* CreateBuffer(const BufferDescriptor& bufferDesc, const void* initialData = nullptr) override;
-        BufferArray* CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray) override;
+        BufferArray* CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets = nullptr) override;
 
         void Release(Buffer& buffer) override;
         void Release(BufferArray& bufferArray) override;
@@ -88,6 +94,16 @@ class MTRenderSystem final : public RenderSystem
         void WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc) override;
         void ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc) override;
 
+        bool QueryTextureTiling(const Texture& texture, TextureTiling& outTiling) override;
+        void CommitTextureTiles(Texture& texture, const TextureRegion& textureRegion) override;
+        void DecommitTextureTiles(Texture& texture, const TextureRegion& textureRegion) override;
+
+        /* ----- Native resources ----- */
+
+        bool QueryNativeHandle(const Resource& resource, NativeResourceHandle& outHandle) override;
+        Buffer* ImportBuffer(const BufferDescriptor& bufferDesc, const NativeResourceHandle& nativeHandle) override;
+        Texture* ImportTexture(const TextureDescriptor& textureDesc, const NativeResourceHandle& nativeHandle) override;
+
         /* ----- Sampler States ---- */
 
         Sampler* CreateSampler(const SamplerDescriptor& samplerDesc) override;
@@ -131,6 +147,8 @@ class MTRenderSystem final : public RenderSystem
         PipelineState* CreatePipelineState(const Blob& serializedCache) override;
         PipelineState* CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache = nullptr) override;
         PipelineState* CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache = nullptr) override;
+        PipelineState* CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc, long flags = 0) override;
+        PipelineState* CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc, long flags = 0) override;
 
         void Release(PipelineState& pipelineState) override;
 
@@ -146,9 +164,13 @@ class MTRenderSystem final : public RenderSystem
 
         void Release(Fence& fence) override;
 
+        /* ----- Memory ----- */
+
+        bool QueryMemoryStatistics(MemoryStatistics& outStats) override;
+
     private:
 
-        void CreateDeviceResources();
+        void CreateDeviceResources(int adapterIndex);
         void QueryRenderingCaps();
 
         const char* QueryMetalVersion() const;
@@ -157,11 +179,19 @@ class MTRenderSystem final : public RenderSystem
 
         const MTRenderPass* GetDefaultRenderPass() const;
 
+        void ReadPipelineCache(const Blob& serializedCache);
+        std::unique_ptr<Blob> WritePipelineCache(Serialization::IdentType psoIdent);
+
     private:
 
         /* ----- Common objects ----- */
 
         id<MTLDevice>                       device_             = nil;
+        std::unique_ptr<MTMemoryManager>    memoryMngr_;
+        std::unique_ptr<MTPipelineCache>    pipelineCache_;
+
+        MTSamplerCache                      samplerCache_;      // Must be declared before the samplers, since they release their native objects here
+        MTShaderLibraryCache                shaderLibraryCache_; // Must be declared before the shaders, since they release their libraries here
 
         /* ----- Hardware object containers ----- */
 
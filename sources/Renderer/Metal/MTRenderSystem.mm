@@ -12,12 +12,15 @@
 #include "../../Core/Vendor.h"
 #include "MTFeatureSet.h"
 #include "MTTypes.h"
+#include "MTSerialization.h"
 #include "RenderState/MTGraphicsPSO.h"
 #include "RenderState/MTComputePSO.h"
 #include "RenderState/MTBuiltinPSOFactory.h"
+#include "../../Core/ProfilerZone.h"
 #include <LLGL/ImageFlags.h>
 #include <LLGL/Platform/Platform.h>
 #include <AvailabilityMacros.h>
+#include <algorithm>
 
 
 namespace LLGL
@@ -26,9 +29,9 @@ namespace LLGL
 
 /* ----- Common ----- */
 
-MTRenderSystem::MTRenderSystem()
+MTRenderSystem::MTRenderSystem(const RenderSystemDescriptor& renderSystemDesc)
 {
-    CreateDeviceResources();
+    CreateDeviceResources(renderSystemDesc.adapterIndex);
     QueryRenderingCaps();
 }
 
@@ -37,6 +40,67 @@ MTRenderSystem::~MTRenderSystem()
     [device_ release];
 }
 
+// Returns a new retained array of all Metal devices; on iOS, this only contains the system default device.
+static NSArray<id<MTLDevice>>* CopyAllMetalDevices()
+{
+    #ifdef LLGL_OS_MACOS
+    return MTLCopyAllDevices();
+    #else
+    id<MTLDevice> device = MTLCreateSystemDefaultDevice();
+    NSArray<id<MTLDevice>>* devices = (device != nil ? [[NSArray alloc] initWithObjects:device, nil] : [[NSArray alloc] init]);
+    [device release];
+    return devices;
+    #endif
+}
+
+// Metal does not expose PCI vendor IDs, so the vendor is derived from the device name.
+static std::uint32_t GetVendorIDByDeviceName(NSString* name)
+{
+    if ([name hasPrefix:@"AMD"])
+        return 0x1002;
+    if ([name hasPrefix:@"Intel"])
+        return 0x8086;
+    if ([name hasPrefix:@"NVIDIA"])
+        return 0x10de;
+    return 0;
+}
+
+static VideoAdapterDescriptor GetMetalVideoAdapterDesc(id<MTLDevice> device)
+{
+    const std::string deviceName = [[device name] cStringUsingEncoding:NSUTF8StringEncoding];
+    const std::uint32_t vendorID = GetVendorIDByDeviceName([device name]);
+
+    VideoAdapterDescriptor adapterDesc;
+    {
+        adapterDesc.name        = std::wstring(deviceName.begin(), deviceName.end());
+        adapterDesc.vendorID    = vendorID;
+        adapterDesc.vendor      = (vendorID != 0 ? GetVendorByID(static_cast<unsigned short>(vendorID)) : "Apple");
+    }
+
+    #ifdef LLGL_OS_MACOS
+    /* Low-power devices are integrated GPUs, removable devices are external GPUs */
+    const bool isIntegrated = ([device isLowPower] != NO);
+    adapterDesc.flags = (isIntegrated ? VideoAdapterFlags::Integrated : VideoAdapterFlags::Discrete);
+    if (isIntegrated)
+        adapterDesc.sharedMemory = [device recommendedMaxWorkingSetSize];
+    else
+        adapterDesc.videoMemory = [device recommendedMaxWorkingSetSize];
+    #else
+    /* All iOS devices have a unified memory architecture */
+    adapterDesc.flags = VideoAdapterFlags::Integrated;
+    #endif
+
+    return adapterDesc;
+}
+
+void MTRenderSystem::QueryVideoAdapters(std::vector<VideoAdapterDescriptor>& outAdapters)
+{
+    NSArray<id<MTLDevice>>* devices = CopyAllMetalDevices();
+    for (id<MTLDevice> device in devices)
+        outAdapters.push_back(GetMetalVideoAdapterDesc(device));
+    [devices release];
+}
+
 /* ----- Swap-chain ----- */
 
 SwapChain* MTRenderSystem::CreateSwapChain(const SwapChainDescriptor& swapChainDesc, const std::shared_ptr<Surface>& surface)
@@ -72,13 +136,13 @@ void MTRenderSystem::Release(CommandBuffer& commandBuffer)
 
 Buffer* MTRenderSystem::CreateBuffer(const BufferDescriptor& bufferDesc, const void* initialData)
 {
-    return TakeOwnership(buffers_, MakeUnique<MTBuffer>(device_, bufferDesc, initialData));
+    return TakeOwnership(buffers_, MakeUnique<MTBuffer>(*memoryMngr_, bufferDesc, initialData));
 }
 
-BufferArray* MTRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray)
+BufferArray* MTRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets)
 {
     AssertCreateBufferArray(numBuffers, bufferArray);
-    return TakeOwnership(bufferArrays_, MakeUnique<MTBufferArray>(numBuffers, bufferArray));
+    return TakeOwnership(bufferArrays_, MakeUnique<MTBufferArray>(numBuffers, bufferArray, offsets));
 }
 
 void MTRenderSystem::Release(Buffer& buffer)
@@ -125,9 +189,10 @@ void MTRenderSystem::UnmapBuffer(Buffer& buffer)
 
 Texture* MTRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc)
 {
-    auto textureMT = MakeUnique<MTTexture>(device_, textureDesc);
+    auto textureMT = MakeUnique<MTTexture>(*memoryMngr_, textureDesc);
 
-    if (imageDesc)
+    /* Aliasable and sparse textures reside in private memory and have undefined content, so they cannot be initialized by the CPU */
+    if (imageDesc != nullptr && !textureMT->IsAliasable() && !textureMT->IsSparse())
     {
         textureMT->WriteRegion(
             //TextureRegion{ Offset3D{ 0, 0, 0 }, textureMT->GetMipExtent(0) },
@@ -164,7 +229,7 @@ void MTRenderSystem::Release(Texture& texture)
 void MTRenderSystem::WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
 {
     auto& textureMT = LLGL_CAST(MTTexture&, texture);
-    textureMT.WriteRegion(textureRegion, imageDesc);
+    textureMT.WriteRegion(textureRegion, imageDesc, commandQueue_->GetNative());
 }
 
 void MTRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc)
@@ -173,11 +238,83 @@ void MTRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureR
     textureMT.ReadRegion(textureRegion, imageDesc);
 }
 
+bool MTRenderSystem::QueryTextureTiling(const Texture& texture, TextureTiling& outTiling)
+{
+    auto& textureMT = LLGL_CAST(const MTTexture&, texture);
+    return textureMT.GetTiling(outTiling);
+}
+
+void MTRenderSystem::CommitTextureTiles(Texture& texture, const TextureRegion& textureRegion)
+{
+    auto& textureMT = LLGL_CAST(MTTexture&, texture);
+    textureMT.CommitTiles(commandQueue_->GetNative(), textureRegion, true);
+}
+
+void MTRenderSystem::DecommitTextureTiles(Texture& texture, const TextureRegion& textureRegion)
+{
+    auto& textureMT = LLGL_CAST(MTTexture&, texture);
+    textureMT.CommitTiles(commandQueue_->GetNative(), textureRegion, false);
+}
+
+/* ----- Native resources ----- */
+
+bool MTRenderSystem::QueryNativeHandle(const Resource& resource, NativeResourceHandle& outHandle)
+{
+    switch (resource.GetResourceType())
+    {
+        case ResourceType::Buffer:
+        {
+            /* Indirect command buffers have no native MTLBuffer */
+            auto& bufferMT = LLGL_CAST(const MTBuffer&, resource);
+            if (bufferMT.GetNative() == nil)
+                return false;
+            outHandle.type      = NativeHandleType::MTLBuffer;
+            outHandle.object    = reinterpret_cast<std::uintptr_t>(bufferMT.GetNative());
+        }
+        break;
+
+        case ResourceType::Texture:
+        {
+            auto& textureMT = LLGL_CAST(const MTTexture&, resource);
+            outHandle.type      = NativeHandleType::MTLTexture;
+            outHandle.object    = reinterpret_cast<std::uintptr_t>(textureMT.GetNative());
+        }
+        break;
+
+        default:
+            return false;
+    }
+
+    outHandle.memory        = 0;
+    outHandle.memoryOffset  = 0;
+    outHandle.memorySize    = 0;
+
+    return true;
+}
+
+Buffer* MTRenderSystem::ImportBuffer(const BufferDescriptor& bufferDesc, const NativeResourceHandle& nativeHandle)
+{
+    if (nativeHandle.type != NativeHandleType::MTLBuffer || nativeHandle.object == 0)
+        return nullptr;
+
+    auto native = (id<MTLBuffer>)reinterpret_cast<void*>(static_cast<std::uintptr_t>(nativeHandle.object));
+    return TakeOwnership(buffers_, MakeUnique<MTBuffer>(bufferDesc, native));
+}
+
+Texture* MTRenderSystem::ImportTexture(const TextureDescriptor& textureDesc, const NativeResourceHandle& nativeHandle)
+{
+    if (nativeHandle.type != NativeHandleType::MTLTexture || nativeHandle.object == 0)
+        return nullptr;
+
+    auto native = (id<MTLTexture>)reinterpret_cast<void*>(static_cast<std::uintptr_t>(nativeHandle.object));
+    return TakeOwnership(textures_, MakeUnique<MTTexture>(textureDesc, native));
+}
+
 /* ----- Sampler States ---- */
 
 Sampler* MTRenderSystem::CreateSampler(const SamplerDescriptor& samplerDesc)
 {
-    return TakeOwnership(samplers_, MakeUnique<MTSampler>(device_, samplerDesc));
+    return TakeOwnership(samplers_, MakeUnique<MTSampler>(device_, samplerCache_, samplerDesc));
 }
 
 void MTRenderSystem::Release(Sampler& sampler)
@@ -189,7 +326,7 @@ void MTRenderSystem::Release(Sampler& sampler)
 
 ResourceHeap* MTRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor& resourceHeapDesc, const ArrayView<ResourceViewDescriptor>& initialResourceViews)
 {
-    return TakeOwnership(resourceHeaps_, MakeUnique<MTResourceHeap>(resourceHeapDesc, initialResourceViews));
+    return TakeOwnership(resourceHeaps_, MakeUnique<MTResourceHeap>(device_, resourceHeapDesc, initialResourceViews));
 }
 
 void MTRenderSystem::Release(ResourceHeap& resourceHeap)
@@ -232,7 +369,7 @@ void MTRenderSystem::Release(RenderTarget& renderTarget)
 Shader* MTRenderSystem::CreateShader(const ShaderDescriptor& shaderDesc)
 {
     AssertCreateShader(shaderDesc);
-    return TakeOwnership(shaders_, MakeUnique<MTShader>(device_, shaderDesc));
+    return TakeOwnership(shaders_, MakeUnique<MTShader>(device_, shaderDesc, &shaderLibraryCache_));
 }
 
 void MTRenderSystem::Release(Shader& shader)
@@ -259,14 +396,59 @@ PipelineState* MTRenderSystem::CreatePipelineState(const Blob& /*serializedCache
     return nullptr;//TODO
 }
 
-PipelineState* MTRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* /*serializedCache*/)
+PipelineState* MTRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache)
 {
-    return TakeOwnership(pipelineStates_, MakeUnique<MTGraphicsPSO>(device_, pipelineStateDesc, GetDefaultRenderPass()));
+    LLGL_PROFILER_ZONE("MTRenderSystem::CreateGraphicsPipelineState");
+
+    /* Seed device-wide binary archive with the serialized cache from a previous run */
+    if (serializedCache != nullptr && *serializedCache != nullptr)
+        ReadPipelineCache(**serializedCache);
+
+    auto pipelineState = TakeOwnership(
+        pipelineStates_,
+        MakeUnique<MTGraphicsPSO>(device_, pipelineStateDesc, GetDefaultRenderPass(), pipelineCache_.get(), (serializedCache != nullptr))
+    );
+
+    if (serializedCache != nullptr)
+        *serializedCache = WritePipelineCache(Serialization::MTIdent_GraphicsPSOIdent);
+
+    return pipelineState;
 }
 
-PipelineState* MTRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* /*serializedCache*/)
+PipelineState* MTRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache)
 {
-    return TakeOwnership(pipelineStates_, MakeUnique<MTComputePSO>(device_, pipelineStateDesc));
+    LLGL_PROFILER_ZONE("MTRenderSystem::CreateComputePipelineState");
+
+    /* Seed device-wide binary archive with the serialized cache from a previous run */
+    if (serializedCache != nullptr && *serializedCache != nullptr)
+        ReadPipelineCache(**serializedCache);
+
+    auto pipelineState = TakeOwnership(
+        pipelineStates_,
+        MakeUnique<MTComputePSO>(device_, pipelineStateDesc, pipelineCache_.get(), (serializedCache != nullptr))
+    );
+
+    if (serializedCache != nullptr)
+        *serializedCache = WritePipelineCache(Serialization::MTIdent_ComputePSOIdent);
+
+    return pipelineState;
+}
+
+/* Asynchronous PSOs only look up the binary archive, but never record into it, since the archive is not guarded against concurrent access */
+PipelineState* MTRenderSystem::CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc, long flags)
+{
+    return TakeOwnership(
+        pipelineStates_,
+        MakeUnique<MTGraphicsPSO>(device_, pipelineStateDesc, GetDefaultRenderPass(), pipelineCache_.get(), false, true, flags)
+    );
+}
+
+PipelineState* MTRenderSystem::CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc, long flags)
+{
+    return TakeOwnership(
+        pipelineStates_,
+        MakeUnique<MTComputePSO>(device_, pipelineStateDesc, pipelineCache_.get(), false, true, flags)
+    );
 }
 
 void MTRenderSystem::Release(PipelineState& pipelineState)
@@ -299,15 +481,47 @@ void MTRenderSystem::Release(Fence& fence)
     RemoveFromUniqueSet(fences_, &fence);
 }
 
+/* ----- Memory ----- */
+
+bool MTRenderSystem::QueryMemoryStatistics(MemoryStatistics& outStats)
+{
+    /* Report the heaps of the memory manager in two categories, i.e. video memory (private heaps) and system memory (shared heaps) */
+    MemoryHeapStatistics localStats, nonLocalStats;
+    {
+        localStats.deviceLocal      = true;
+        nonLocalStats.deviceLocal   = false;
+    }
+    memoryMngr_->AccumStatistics(localStats, nonLocalStats);
+    outStats.heaps = { localStats, nonLocalStats };
+
+    /* Report the largest high-water mark of all staging buffer pools */
+    outStats.stagingHighWaterMark = 0;
+    for (const auto& commandBuffer : commandBuffers_)
+        outStats.stagingHighWaterMark = std::max(outStats.stagingHighWaterMark, commandBuffer->GetStagingBufferPool().GetHighWaterMark());
+
+    return true;
+}
+
 
 /*
  * ======= Private: =======
  */
 
-void MTRenderSystem::CreateDeviceResources()
+void MTRenderSystem::CreateDeviceResources(int adapterIndex)
 {
-    /* Create Metal device */
-    device_ = MTLCreateSystemDefaultDevice();
+    /* Create Metal device, either the system default device or the explicitly selected one */
+    if (adapterIndex >= 0)
+    {
+        NSArray<id<MTLDevice>>* devices = CopyAllMetalDevices();
+        if (static_cast<NSUInteger>(adapterIndex) < [devices count])
+            device_ = [[devices objectAtIndex:static_cast<NSUInteger>(adapterIndex)] retain];
+        [devices release];
+        if (device_ == nil)
+            throw std::runtime_error("video adapter index out of range: " + std::to_string(adapterIndex));
+    }
+    else
+        device_ = MTLCreateSystemDefaultDevice();
+
     if (device_ == nil)
         throw std::runtime_error("failed to create Metal device");
 
@@ -326,6 +540,12 @@ void MTRenderSystem::CreateDeviceResources()
 
     /* Initialize builtin PSOs */
     MTBuiltinPSOFactory::Get().CreateBuiltinPSOs(device_);
+
+    /* Create memory manager to sub-allocate buffers and textures from heaps */
+    memoryMngr_ = MakeUnique<MTMemoryManager>(device_);
+
+    /* Create device-wide binary archive for all PSOs */
+    pipelineCache_ = MakeUnique<MTPipelineCache>(device_);
 }
 
 void MTRenderSystem::QueryRenderingCaps()
@@ -485,6 +705,36 @@ const MTRenderPass* MTRenderSystem::GetDefaultRenderPass() const
     return nullptr;
 }
 
+void MTRenderSystem::ReadPipelineCache(const Blob& serializedCache)
+{
+    Serialization::Deserializer reader{ serializedCache };
+
+    /* Read type of PSO */
+    auto seg = reader.ReadSegment();
+    if (seg.ident != Serialization::MTIdent_GraphicsPSOIdent && seg.ident != Serialization::MTIdent_ComputePSOIdent)
+        throw std::runtime_error("serialized cache does not denote a Metal graphics or compute PSO");
+
+    /* Load optional binary archive into device-wide cache */
+    seg = reader.ReadSegmentOnMatch(Serialization::MTIdent_BinaryArchive);
+    if (seg.ident == Serialization::MTIdent_BinaryArchive)
+        pipelineCache_->Merge(device_, seg.data, seg.size);
+}
+
+std::unique_ptr<Blob> MTRenderSystem::WritePipelineCache(Serialization::IdentType psoIdent)
+{
+    Serialization::Serializer writer;
+
+    /* Write type of PSO */
+    writer.Begin(psoIdent);
+    writer.End();
+
+    /* Write entire content of device-wide binary archive, so it can be reused for all PSOs on the next run */
+    if (auto archiveData = pipelineCache_->GetData())
+        writer.WriteSegment(Serialization::MTIdent_BinaryArchive, archiveData->GetData(), archiveData->GetSize());
+
+    return writer.Finalize();
+}
+
 
 } // /namespace LLGL
 
@@ -0,0 +1,44 @@
+/*
+ * MTSerialization.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MT_SERIALIZATION_H
+#define LLGL_MT_SERIALIZATION_H
+
+
+#include "../Serialization.h"
+#include <LLGL/RenderSystemFlags.h>
+
+
+namespace LLGL
+{
+
+namespace Serialization
+{
+
+
+/* ----- Enumerations ----- */
+
+// Segment identifiers for Metal serialization.
+enum MTIdent : IdentType
+{
+    MTIdent_ReservedMT = (RendererID::Metal << 8),
+    MTIdent_GraphicsPSOIdent,
+    MTIdent_ComputePSOIdent,
+    MTIdent_BinaryArchive,          // Data from [MTLBinaryArchive serializeToURL:error:]
+};
+
+
+} // /namespace Serialization
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
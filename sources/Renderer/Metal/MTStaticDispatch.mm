@@ -0,0 +1,20 @@
+/*
+ * MTStaticDispatch.mm
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifdef LLGL_STATIC_DISPATCH_BACKEND
+
+#include "MTCommandBuffer.h"
+
+#define LLGL_STATIC_DISPATCH_COMMAND_BUFFER MTCommandBuffer
+#include "../StaticDispatch.inl"
+#undef LLGL_STATIC_DISPATCH_COMMAND_BUFFER
+
+#endif // /LLGL_STATIC_DISPATCH_BACKEND
+
+
+
+// ================================================================================
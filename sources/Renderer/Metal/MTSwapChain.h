@@ -34,7 +34,10 @@ class MTSwapChain final : public SwapChain
             const std::shared_ptr<Surface>& surface
         );
 
+        ~MTSwapChain();
+
         void Present() override;
+        void WaitForNextFrame() override;
 
         std::uint32_t GetSamples() const override;
 
@@ -53,17 +56,52 @@ class MTSwapChain final : public SwapChain
             return view_;
         }
 
+        /*
+        Returns the native render pass descriptor for the intermediate targets of this swap chain.
+        This does not acquire a drawable; see CopyToNextDrawable.
+        */
+        MTLRenderPassDescriptor* GetNativeRenderPass();
+
+        /*
+        Acquires the next drawable and encodes a copy of the intermediate color target into it.
+        This is done at the end of each command buffer that renders into this swap chain,
+        so the drawable is held for the shortest possible time. Returns nil if there is no drawable available.
+        */
+        id<MTLDrawable> CopyToNextDrawable(id<MTLBlitCommandEncoder> blitEncoder);
+
+        // Stores the command buffer that presents the current frame, so WaitForNextFrame can limit the number of frames in flight.
+        void NotifyFramePresented(id<MTLCommandBuffer> cmdBuffer);
+
+    private:
+
+        static constexpr std::uint32_t maxNumFramesInFlight = 3;
+
     private:
 
         bool ResizeBuffersPrimary(const Extent2D& resolution) override;
 
+        void SetupMetalLayer(CAMetalLayer* layer, const SwapChainDescriptor& desc);
+
+        // Creates the intermediate targets if they do not exist yet or if the drawable size has changed.
+        void UpdateIntermediateTargets();
+        void ReleaseIntermediateTargets();
+
     private:
 
-        MTKView*        view_       = nullptr;
+        MTKView*                    view_                                       = nullptr;
         #ifdef LLGL_OS_IOS
-        CAMetalLayer*   metalLayer_ = nullptr;
+        CAMetalLayer*               metalLayer_                                 = nullptr;
         #endif
-        MTRenderPass    renderPass_;
+        MTRenderPass                renderPass_;
+
+        MTLRenderPassDescriptor*    nativeRenderPass_                           = nullptr;
+        id<MTLTexture>              colorBuffer_                                = nil;  // Intermediate color target; copied into the drawable.
+        id<MTLTexture>              colorBufferMS_                              = nil;  // Multi-sampled color target; resolved into the intermediate color target.
+        id<MTLTexture>              depthStencilBuffer_                         = nil;
+
+        std::uint32_t               maxFrameLatency_                            = 0;
+        std::uint32_t               currentFrameInFlight_                       = 0;
+        id<MTLCommandBuffer>        presentCmdBuffers_[maxNumFramesInFlight]    = {};   // Command buffers of the last presented frames; only used if maxFrameLatency > 0.
 
 };
 
@@ -9,6 +9,8 @@
 #include "MTTypes.h"
 #include "../TextureUtils.h"
 #include <LLGL/Platform/NativeHandle.h>
+#include <LLGL/Format.h>
+#include <algorithm>
 
 #import <QuartzCore/CAMetalLayer.h>
 
@@ -59,12 +61,29 @@ MTSwapChain::MTSwapChain(
 
     #endif // /LLGL_OS_IOS
 
-    /* Initialize color and depth buffer */
-    //MTLPixelFormat colorFmt = metalLayer_.pixelFormat;
-
+    /*
+    Initialize color buffer format of the drawables. Depth-stencil and multi-sampled buffers are owned by this swap chain,
+    since rendering goes into intermediate targets that are only copied into the drawable at the end of a command buffer.
+    */
     view_.colorPixelFormat          = renderPass_.GetColorAttachments()[0].pixelFormat;
-    view_.depthStencilPixelFormat   = renderPass_.GetDepthStencilFormat();
-    view_.sampleCount               = renderPass_.GetSampleCount();
+    view_.depthStencilPixelFormat   = MTLPixelFormatInvalid;
+    view_.sampleCount               = 1;
+    view_.framebufferOnly           = NO;
+
+    /* Configure frame latency and presentation mode */
+    if ([view_.layer isKindOfClass:[CAMetalLayer class]])
+        SetupMetalLayer(reinterpret_cast<CAMetalLayer*>(view_.layer), desc);
+}
+
+MTSwapChain::~MTSwapChain()
+{
+    ReleaseIntermediateTargets();
+    for (id<MTLCommandBuffer>& cmdBuffer : presentCmdBuffers_)
+    {
+        [cmdBuffer release];
+        cmdBuffer = nil;
+    }
+    [nativeRenderPass_ release];
 }
 
 void MTSwapChain::Present()
@@ -72,6 +91,16 @@ void MTSwapChain::Present()
     [view_ draw];
 }
 
+void MTSwapChain::WaitForNextFrame()
+{
+    /* Wait until the GPU has completed the frame that was presented 'maxFrameLatency' frames ago */
+    if (maxFrameLatency_ > 0)
+    {
+        if (id<MTLCommandBuffer> cmdBuffer = presentCmdBuffers_[currentFrameInFlight_])
+            [cmdBuffer waitUntilCompleted];
+    }
+}
+
 std::uint32_t MTSwapChain::GetSamples() const
 {
     return static_cast<std::uint32_t>(renderPass_.GetSampleCount());
@@ -84,7 +113,7 @@ Format MTSwapChain::GetColorFormat() const
 
 Format MTSwapChain::GetDepthStencilFormat() const
 {
-    return MTTypes::ToFormat(view_.depthStencilPixelFormat);
+    return MTTypes::ToFormat(renderPass_.GetDepthStencilFormat());
 }
 
 const RenderPass* MTSwapChain::GetRenderPass() const
@@ -111,6 +140,55 @@ bool MTSwapChain::SetVsyncInterval(std::uint32_t vsyncInterval)
     return true;
 }
 
+MTLRenderPassDescriptor* MTSwapChain::GetNativeRenderPass()
+{
+    UpdateIntermediateTargets();
+    return nativeRenderPass_;
+}
+
+id<MTLDrawable> MTSwapChain::CopyToNextDrawable(id<MTLBlitCommandEncoder> blitEncoder)
+{
+    if (colorBuffer_ == nil)
+        return nil;
+
+    /* Acquire next drawable; this blocks until one of the layer's drawables is available */
+    id<CAMetalDrawable> drawable = view_.currentDrawable;
+    if (drawable == nil)
+        return nil;
+
+    /* Copy intermediate color target into drawable; their sizes only differ for the frame in which the view has been resized */
+    id<MTLTexture> drawableTexture = drawable.texture;
+    const MTLSize size
+    {
+        std::min(colorBuffer_.width,  drawableTexture.width ),
+        std::min(colorBuffer_.height, drawableTexture.height),
+        1
+    };
+    [blitEncoder
+        copyFromTexture:    colorBuffer_
+        sourceSlice:        0
+        sourceLevel:        0
+        sourceOrigin:       MTLOriginMake(0, 0, 0)
+        sourceSize:         size
+        toTexture:          drawableTexture
+        destinationSlice:   0
+        destinationLevel:   0
+        destinationOrigin:  MTLOriginMake(0, 0, 0)
+    ];
+
+    return drawable;
+}
+
+void MTSwapChain::NotifyFramePresented(id<MTLCommandBuffer> cmdBuffer)
+{
+    if (maxFrameLatency_ > 0)
+    {
+        [presentCmdBuffers_[currentFrameInFlight_] release];
+        presentCmdBuffers_[currentFrameInFlight_] = [cmdBuffer retain];
+        currentFrameInFlight_ = (currentFrameInFlight_ + 1) % maxFrameLatency_;
+    }
+}
+
 
 /*
  * ======= Private: =======
@@ -121,6 +199,121 @@ bool MTSwapChain::ResizeBuffersPrimary(const Extent2D& /*resolution*/)
     return true; // do nothing
 }
 
+void MTSwapChain::SetupMetalLayer(CAMetalLayer* layer, const SwapChainDescriptor& desc)
+{
+    /* CAMetalLayer only supports 2 or 3 drawables; one drawable more than frames in flight is required */
+    if (desc.maxFrameLatency > 0)
+    {
+        maxFrameLatency_ = (desc.maxFrameLatency < maxNumFramesInFlight ? desc.maxFrameLatency : maxNumFramesInFlight);
+        if (@available(macOS 10.13.2, iOS 11.2, *))
+            layer.maximumDrawableCount = std::max(2u, std::min(desc.maxFrameLatency + 1u, 3u));
+    }
+
+    #ifndef LLGL_OS_IOS
+
+    /* Disable display synchronization for immediate presentation; Metal does not distinguish between mailbox and FIFO presentation */
+    if (desc.presentMode == PresentMode::Immediate)
+    {
+        if (@available(macOS 10.13, *))
+            layer.displaySyncEnabled = NO;
+    }
+
+    #endif // /LLGL_OS_IOS
+}
+
+static id<MTLTexture> CreateIntermediateTexture(
+    id<MTLDevice>   device,
+    MTLPixelFormat  format,
+    NSUInteger      width,
+    NSUInteger      height,
+    NSUInteger      sampleCount,
+    MTLTextureUsage usage)
+{
+    MTLTextureDescriptor* texDesc = [[MTLTextureDescriptor alloc] init];
+    {
+        texDesc.textureType     = (sampleCount > 1 ? MTLTextureType2DMultisample : MTLTextureType2D);
+        texDesc.pixelFormat     = format;
+        texDesc.width           = width;
+        texDesc.height          = height;
+        texDesc.sampleCount     = sampleCount;
+        texDesc.usage           = usage;
+        texDesc.storageMode     = MTLStorageModePrivate;
+    }
+    id<MTLTexture> texture = [device newTextureWithDescriptor:texDesc];
+    [texDesc release];
+    return texture;
+}
+
+void MTSwapChain::UpdateIntermediateTargets()
+{
+    const CGSize drawableSize = view_.drawableSize;
+    const NSUInteger width  = std::max<NSUInteger>(1, static_cast<NSUInteger>(drawableSize.width));
+    const NSUInteger height = std::max<NSUInteger>(1, static_cast<NSUInteger>(drawableSize.height));
+
+    if (colorBuffer_ != nil && colorBuffer_.width == width && colorBuffer_.height == height)
+        return;
+
+    ReleaseIntermediateTargets();
+
+    id<MTLDevice>       device          = view_.device;
+    const NSUInteger    sampleCount     = renderPass_.GetSampleCount();
+    const MTLPixelFormat colorFormat    = renderPass_.GetColorAttachments()[0].pixelFormat;
+    const MTLPixelFormat depthFormat    = renderPass_.GetDepthStencilFormat();
+
+    /* Create intermediate color target and optional multi-sampled and depth-stencil targets */
+    colorBuffer_ = CreateIntermediateTexture(device, colorFormat, width, height, 1, MTLTextureUsageRenderTarget | MTLTextureUsageShaderRead);
+    if (sampleCount > 1)
+        colorBufferMS_ = CreateIntermediateTexture(device, colorFormat, width, height, sampleCount, MTLTextureUsageRenderTarget);
+    if (depthFormat != MTLPixelFormatInvalid)
+        depthStencilBuffer_ = CreateIntermediateTexture(device, depthFormat, width, height, sampleCount, MTLTextureUsageRenderTarget);
+
+    /* Initialize render pass descriptor with the same default actions as MTKView::currentRenderPassDescriptor */
+    if (nativeRenderPass_ == nullptr)
+        nativeRenderPass_ = [[MTLRenderPassDescriptor alloc] init];
+
+    MTLRenderPassColorAttachmentDescriptor* colorAttachment = nativeRenderPass_.colorAttachments[0];
+    colorAttachment.clearColor  = view_.clearColor;
+    colorAttachment.loadAction  = MTLLoadActionClear;
+    if (colorBufferMS_ != nil)
+    {
+        colorAttachment.texture         = colorBufferMS_;
+        colorAttachment.resolveTexture  = colorBuffer_;
+        colorAttachment.storeAction     = MTLStoreActionMultisampleResolve;
+    }
+    else
+    {
+        colorAttachment.texture         = colorBuffer_;
+        colorAttachment.resolveTexture  = nil;
+        colorAttachment.storeAction     = MTLStoreActionStore;
+    }
+
+    if (depthStencilBuffer_ != nil)
+    {
+        nativeRenderPass_.depthAttachment.texture       = depthStencilBuffer_;
+        nativeRenderPass_.depthAttachment.clearDepth    = view_.clearDepth;
+        nativeRenderPass_.depthAttachment.loadAction    = MTLLoadActionClear;
+        nativeRenderPass_.depthAttachment.storeAction   = MTLStoreActionDontCare;
+
+        if (IsStencilFormat(MTTypes::ToFormat(depthFormat)))
+        {
+            nativeRenderPass_.stencilAttachment.texture         = depthStencilBuffer_;
+            nativeRenderPass_.stencilAttachment.clearStencil    = view_.clearStencil;
+            nativeRenderPass_.stencilAttachment.loadAction      = MTLLoadActionClear;
+            nativeRenderPass_.stencilAttachment.storeAction     = MTLStoreActionDontCare;
+        }
+    }
+}
+
+void MTSwapChain::ReleaseIntermediateTargets()
+{
+    [colorBuffer_ release];
+    [colorBufferMS_ release];
+    [depthStencilBuffer_ release];
+    colorBuffer_        = nil;
+    colorBufferMS_      = nil;
+    depthStencilBuffer_ = nil;
+}
+
 
 } // /namespace LLGL
 
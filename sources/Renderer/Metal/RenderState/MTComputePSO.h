@@ -18,13 +18,22 @@ namespace LLGL
 
 struct ComputePipelineDescriptor;
 class MTShader;
+class MTPipelineCache;
 
 class MTComputePSO final : public MTPipelineState
 {
 
     public:
 
-        MTComputePSO(id<MTLDevice> device, const ComputePipelineDescriptor& desc);
+        // Looks up the pipeline function in the optional pipeline cache and records it into it if 'recordToCache' is true.
+        MTComputePSO(
+            id<MTLDevice>                       device,
+            const ComputePipelineDescriptor&    desc,
+            MTPipelineCache*                    pipelineCache   = nullptr,
+            bool                                recordToCache   = false,
+            bool                                isAsync         = false,
+            long                                asyncFlags      = 0
+        );
 
         // Binds the compute pipeline state with the specified command encoder.
         void Bind(id<MTLComputeCommandEncoder> computeEncoder);
@@ -35,6 +44,15 @@ class MTComputePSO final : public MTPipelineState
             return computeShader_;
         }
 
+    private:
+
+        void CreateComputePipelineState(
+            id<MTLDevice>                       device,
+            const ComputePipelineDescriptor&    desc,
+            MTPipelineCache*                    pipelineCache,
+            bool                                recordToCache
+        );
+
     private:
 
         id<MTLComputePipelineState> computePipelineState_   = nil;
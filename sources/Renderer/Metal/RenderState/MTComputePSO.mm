@@ -6,6 +6,7 @@
  */
 
 #include "MTComputePSO.h"
+#include "MTPipelineCache.h"
 #include "../MTCore.h"
 #include "../Shader/MTShader.h"
 #include "../../CheckedCast.h"
@@ -18,7 +19,14 @@ namespace LLGL
 {
 
 
-MTComputePSO::MTComputePSO(id<MTLDevice> device, const ComputePipelineDescriptor& desc) :
+MTComputePSO::MTComputePSO(
+    id<MTLDevice>                       device,
+    const ComputePipelineDescriptor&    desc,
+    MTPipelineCache*                    pipelineCache,
+    bool                                recordToCache,
+    bool                                isAsync,
+    long                                asyncFlags)
+:
     MTPipelineState { /*isGraphicsPSO:*/ false }
 {
     /* Get native shader functions */
@@ -26,22 +34,81 @@ MTComputePSO::MTComputePSO(id<MTLDevice> device, const ComputePipelineDescriptor
     if (!computeShader_)
         throw std::invalid_argument("cannot create Metal compute pipeline without compute shader");
 
-    id<MTLFunction> kernelFunc = computeShader_->GetNative();
+    /* Create native compute pipeline state */
+    if (isAsync)
+    {
+        /* Compile compute pipeline on the job system with a copy of the descriptor, since the input descriptor might not outlive this call */
+        StartCompileTask(
+            [this, device, desc, pipelineCache, recordToCache]()
+            {
+                @autoreleasepool
+                {
+                    CreateComputePipelineState(device, desc, pipelineCache, recordToCache);
+                }
+            },
+            asyncFlags
+        );
+    }
+    else
+        CreateComputePipelineState(device, desc, pipelineCache, recordToCache);
+}
+
+void MTComputePSO::Bind(id<MTLComputeCommandEncoder> computeEncoder)
+{
+    [computeEncoder setComputePipelineState:computePipelineState_];
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void MTComputePSO::CreateComputePipelineState(
+    id<MTLDevice>                       device,
+    const ComputePipelineDescriptor&    desc,
+    MTPipelineCache*                    pipelineCache,
+    bool                                recordToCache)
+{
+    id<MTLFunction> kernelFunc = computeShader_->NewFunctionWithConstants(desc.specializationConstants);
     if (!kernelFunc)
         throw std::invalid_argument("cannot create Metal compute pipeline without valid compute kernel function");
 
     /* Create native compute pipeline state */
     NSError* error = nullptr;
-    computePipelineState_ = [device newComputePipelineStateWithFunction:kernelFunc error:&error];
+
+    if (pipelineCache != nullptr)
+    {
+        if (@available(macOS 11.0, iOS 14.0, *))
+        {
+            /* Look up precompiled pipeline function in the binary archive, which requires a compute pipeline descriptor */
+            MTLComputePipelineDescriptor* psoDesc = [[MTLComputePipelineDescriptor alloc] init];
+            {
+                psoDesc.computeFunction = kernelFunc;
+                psoDesc.binaryArchives  = pipelineCache->GetBinaryArchives();
+            }
+            computePipelineState_ = [device
+                newComputePipelineStateWithDescriptor:  psoDesc
+                options:                                MTLPipelineOptionNone
+                reflection:                             nil
+                error:                                  &error
+            ];
+
+            if (computePipelineState_ && recordToCache)
+                pipelineCache->AddComputePipeline(psoDesc);
+
+            [psoDesc release];
+        }
+    }
+
+    if (!computePipelineState_ && error == nullptr)
+        computePipelineState_ = [device newComputePipelineStateWithFunction:kernelFunc error:&error];
+
+    [kernelFunc release];
+
     if (!computePipelineState_)
         MTThrowIfCreateFailed(error, "MTLComputePipelineState");
 }
 
-void MTComputePSO::Bind(id<MTLComputeCommandEncoder> computeEncoder)
-{
-    [computeEncoder setComputePipelineState:computePipelineState_];
-}
-
 
 } // /namespace LLGL
 
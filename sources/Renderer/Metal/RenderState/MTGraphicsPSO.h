@@ -18,6 +18,7 @@ namespace LLGL
 
 
 class MTRenderPass;
+class MTPipelineCache;
 struct GraphicsPipelineDescriptor;
 
 class MTGraphicsPSO final : public MTPipelineState
@@ -25,10 +26,15 @@ class MTGraphicsPSO final : public MTPipelineState
 
     public:
 
+        // Looks up the pipeline functions in the optional pipeline cache and records them into it if 'recordToCache' is true.
         MTGraphicsPSO(
             id<MTLDevice>                       device,
             const GraphicsPipelineDescriptor&   desc,
-            const MTRenderPass*                 defaultRenderPass
+            const MTRenderPass*                 defaultRenderPass,
+            MTPipelineCache*                    pipelineCache   = nullptr,
+            bool                                recordToCache   = false,
+            bool                                isAsync         = false,
+            long                                asyncFlags      = 0
         );
 
         // Binds the render pipeline state, depth-stencil states, and sets the remaining parameters with the specified command encoder.
@@ -61,6 +67,24 @@ class MTGraphicsPSO final : public MTPipelineState
             return tessPipelineState_;
         }
 
+        // Returns true if this is a mesh render pipeline with an optional object function and a mesh function.
+        inline bool IsMeshPipeline() const
+        {
+            return isMeshPipeline_;
+        }
+
+        // Returns the number of threads per object thread-group for mesh render pipelines.
+        inline const MTLSize& GetThreadsPerObjectThreadgroup() const
+        {
+            return threadsPerObjectThreadgroup_;
+        }
+
+        // Returns the number of threads per mesh thread-group for mesh render pipelines.
+        inline const MTLSize& GetThreadsPerMeshThreadgroup() const
+        {
+            return threadsPerMeshThreadgroup_;
+        }
+
         // Returns true if the blend color must be set independently of the PSO.
         inline bool IsBlendColorDynamic() const
         {
@@ -78,7 +102,15 @@ class MTGraphicsPSO final : public MTPipelineState
         void CreateRenderPipelineState(
             id<MTLDevice>                       device,
             const GraphicsPipelineDescriptor&   desc,
-            const MTRenderPass*                 defaultRenderPass
+            const MTRenderPass*                 defaultRenderPass,
+            MTPipelineCache*                    pipelineCache,
+            bool                                recordToCache
+        );
+
+        void CreateMeshRenderPipelineState(
+            id<MTLDevice>                       device,
+            const GraphicsPipelineDescriptor&   desc,
+            const MTRenderPass*                 renderPass
         );
 
         void CreateDepthStencilState(
@@ -100,6 +132,10 @@ class MTGraphicsPSO final : public MTPipelineState
         NSUInteger                  numPatchControlPoints_  = 0;
         MTLPatchType                patchType_              = MTLPatchTypeNone;
 
+        bool                        isMeshPipeline_                 = false;
+        MTLSize                     threadsPerObjectThreadgroup_    = {};
+        MTLSize                     threadsPerMeshThreadgroup_      = {};
+
         float                       depthBias_              = 0.0f;
         float                       depthSlope_             = 0.0f;
         float                       depthClamp_             = 0.0f;
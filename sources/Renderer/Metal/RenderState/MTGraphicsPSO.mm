@@ -7,6 +7,7 @@
 
 #include "MTGraphicsPSO.h"
 #include "MTRenderPass.h"
+#include "MTPipelineCache.h"
 #include "../Shader/MTShader.h"
 #include "../MTEncoderScheduler.h"
 #include "../MTTypes.h"
@@ -45,7 +46,11 @@ static void FillDefaultMTStencilDesc(MTLStencilDescriptor* dst)
 MTGraphicsPSO::MTGraphicsPSO(
     id<MTLDevice>                       device,
     const GraphicsPipelineDescriptor&   desc,
-    const MTRenderPass*                 defaultRenderPass)
+    const MTRenderPass*                 defaultRenderPass,
+    MTPipelineCache*                    pipelineCache,
+    bool                                recordToCache,
+    bool                                isAsync,
+    long                                asyncFlags)
 :
     MTPipelineState { /*isGraphicsPSO:*/ true }
 {
@@ -68,7 +73,23 @@ MTGraphicsPSO::MTGraphicsPSO(
     blendColor_[3]      = desc.blend.blendFactor[3];
 
     /* Create render pipeline and depth-stencil states */
-    CreateRenderPipelineState(device, desc, defaultRenderPass);
+    if (isAsync)
+    {
+        /* Compile render pipeline on the job system with a copy of the descriptor, since the input descriptor might not outlive this call */
+        StartCompileTask(
+            [this, device, desc, defaultRenderPass, pipelineCache, recordToCache]()
+            {
+                @autoreleasepool
+                {
+                    CreateRenderPipelineState(device, desc, defaultRenderPass, pipelineCache, recordToCache);
+                }
+            },
+            asyncFlags
+        );
+    }
+    else
+        CreateRenderPipelineState(device, desc, defaultRenderPass, pipelineCache, recordToCache);
+
     CreateDepthStencilState(device, desc);
 }
 
@@ -145,9 +166,10 @@ static void FillColorAttachmentDesc(
     dst.sourceRGBBlendFactor        = MTTypes::ToMTLBlendFactor(targetDesc.srcColor);
 }
 
-static id<MTLFunction> GetNativeMTShader(const Shader* shader)
+// Returns a new shader function that is specialized for the PSO; the caller must release it
+static id<MTLFunction> NewNativeMTShaderFunction(const Shader* shader, const GraphicsPipelineDescriptor& desc)
 {
-    return (shader != nullptr ? LLGL_CAST(const MTShader*, shader)->GetNative() : nil);
+    return (shader != nullptr ? LLGL_CAST(const MTShader*, shader)->NewFunctionWithConstants(desc.specializationConstants) : nil);
 }
 
 static const MTShader* GetVertexOrPostTessVertexShader(const GraphicsPipelineDescriptor& desc)
@@ -173,8 +195,26 @@ static const MTShader* GetVertexOrPostTessVertexShader(const GraphicsPipelineDes
 void MTGraphicsPSO::CreateRenderPipelineState(
     id<MTLDevice>                       device,
     const GraphicsPipelineDescriptor&   desc,
-    const MTRenderPass*                 defaultRenderPass)
+    const MTRenderPass*                 defaultRenderPass,
+    MTPipelineCache*                    pipelineCache,
+    bool                                recordToCache)
 {
+    /* Get render pass object */
+    const MTRenderPass* renderPassMT = nullptr;
+    if (auto renderPass = desc.renderPass)
+        renderPassMT = LLGL_CAST(const MTRenderPass*, renderPass);
+    else if (defaultRenderPass != nullptr)
+        renderPassMT = defaultRenderPass;
+    else
+        throw std::invalid_argument("cannot create graphics pipeline without render pass");
+
+    /* Mesh render pipelines have their own descriptor and are not recorded into binary archives */
+    if (desc.meshShader != nullptr)
+    {
+        CreateMeshRenderPipelineState(device, desc, renderPassMT);
+        return;
+    }
+
     /* Get native shader functions */
     auto vertexShaderMT = GetVertexOrPostTessVertexShader(desc);
 
@@ -184,14 +224,9 @@ void MTGraphicsPSO::CreateRenderPipelineState(
     if (id<MTLFunction> vertexFunc = vertexShaderMT->GetNative())
         patchType_ = [vertexFunc patchType];
 
-    /* Get render pass object */
-    const MTRenderPass* renderPassMT = nullptr;
-    if (auto renderPass = desc.renderPass)
-        renderPassMT = LLGL_CAST(const MTRenderPass*, renderPass);
-    else if (defaultRenderPass != nullptr)
-        renderPassMT = defaultRenderPass;
-    else
-        throw std::invalid_argument("cannot create graphics pipeline without render pass");
+    /* Specialize shader functions */
+    id<MTLFunction> vertexFunc      = NewNativeMTShaderFunction(vertexShaderMT, desc);
+    id<MTLFunction> fragmentFunc    = NewNativeMTShaderFunction(desc.fragmentShader, desc);
 
     /* Create render pipeline state */
     MTLRenderPipelineDescriptor* psoDesc = [[MTLRenderPipelineDescriptor alloc] init];
@@ -199,12 +234,16 @@ void MTGraphicsPSO::CreateRenderPipelineState(
         psoDesc.vertexDescriptor        = vertexShaderMT->GetMTLVertexDesc();
         psoDesc.alphaToCoverageEnabled  = MTBoolean(desc.blend.alphaToCoverageEnabled);
         psoDesc.alphaToOneEnabled       = NO;
-        psoDesc.fragmentFunction        = GetNativeMTShader(desc.fragmentShader);
-        psoDesc.vertexFunction          = vertexShaderMT->GetNative();
+        psoDesc.fragmentFunction        = fragmentFunc;
+        psoDesc.vertexFunction          = vertexFunc;
 
         if (@available(iOS 12.0, *))
             psoDesc.inputPrimitiveTopology = MTTypes::ToMTLPrimitiveTopologyClass(desc.primitiveTopology);
 
+        /* Allow this PSO to be inherited by draw commands that are encoded on the GPU (see MiscFlags::IndirectCommands) */
+        if (@available(macOS 10.14, iOS 12.0, *))
+            psoDesc.supportIndirectCommandBuffers = YES;
+
         /* Initialize pixel formats from render pass */
         const auto& colorAttachments = renderPassMT->GetColorAttachments();
         for_range(i, std::min(colorAttachments.size(), std::size_t(8u)))
@@ -238,9 +277,23 @@ void MTGraphicsPSO::CreateRenderPipelineState(
             psoDesc.tessellationPartitionMode           = MTTypes::ToMTLPartitionMode(desc.tessellation.partition);
         }
     }
+
+    /* Look up precompiled pipeline functions in the binary archive */
+    if (pipelineCache != nullptr)
+    {
+        if (@available(macOS 11.0, iOS 14.0, *))
+            psoDesc.binaryArchives = pipelineCache->GetBinaryArchives();
+    }
+
     NSError* error = nullptr;
     renderPipelineState_ = [device newRenderPipelineStateWithDescriptor:psoDesc error:&error];
+
+    if (renderPipelineState_ && pipelineCache != nullptr && recordToCache)
+        pipelineCache->AddRenderPipeline(psoDesc);
+
     [psoDesc release];
+    [vertexFunc release];
+    [fragmentFunc release];
 
     if (!renderPipelineState_)
         MTThrowIfCreateFailed(error, "MTLRenderPipelineState");
@@ -250,7 +303,9 @@ void MTGraphicsPSO::CreateRenderPipelineState(
     {
         if (auto tessComputeShaderMT = LLGL_CAST(const MTShader*, desc.tessControlShader))
         {
-            tessPipelineState_ = [device newComputePipelineStateWithFunction:tessComputeShaderMT->GetNative() error:&error];
+            id<MTLFunction> tessComputeFunc = tessComputeShaderMT->NewFunctionWithConstants(desc.specializationConstants);
+            tessPipelineState_ = [device newComputePipelineStateWithFunction:tessComputeFunc error:&error];
+            [tessComputeFunc release];
             if (!tessPipelineState_)
                 MTThrowIfCreateFailed(error, "MTLComputePipelineState");
         }
@@ -259,6 +314,69 @@ void MTGraphicsPSO::CreateRenderPipelineState(
     }
 }
 
+void MTGraphicsPSO::CreateMeshRenderPipelineState(
+    id<MTLDevice>                       device,
+    const GraphicsPipelineDescriptor&   desc,
+    const MTRenderPass*                 renderPass)
+{
+    if (@available(macOS 13.0, iOS 16.0, *))
+    {
+        /* Store thread-group sizes for the draw commands */
+        isMeshPipeline_ = true;
+
+        if (auto objectShaderMT = LLGL_CAST(const MTShader*, desc.taskShader))
+            threadsPerObjectThreadgroup_ = objectShaderMT->GetNumThreadsPerGroup();
+
+        auto meshShaderMT = LLGL_CAST(const MTShader*, desc.meshShader);
+        threadsPerMeshThreadgroup_ = meshShaderMT->GetNumThreadsPerGroup();
+
+        /* Specialize shader functions */
+        id<MTLFunction> objectFunc      = NewNativeMTShaderFunction(desc.taskShader, desc);
+        id<MTLFunction> meshFunc        = NewNativeMTShaderFunction(desc.meshShader, desc);
+        id<MTLFunction> fragmentFunc    = NewNativeMTShaderFunction(desc.fragmentShader, desc);
+
+        /* Create mesh render pipeline state */
+        MTLMeshRenderPipelineDescriptor* psoDesc = [[MTLMeshRenderPipelineDescriptor alloc] init];
+        {
+            psoDesc.objectFunction          = objectFunc;
+            psoDesc.meshFunction            = meshFunc;
+            psoDesc.fragmentFunction        = fragmentFunc;
+            psoDesc.alphaToCoverageEnabled  = MTBoolean(desc.blend.alphaToCoverageEnabled);
+            psoDesc.alphaToOneEnabled       = NO;
+
+            /* Initialize pixel formats from render pass */
+            const auto& colorAttachments = renderPass->GetColorAttachments();
+            for_range(i, std::min(colorAttachments.size(), std::size_t(8u)))
+            {
+                FillColorAttachmentDesc(
+                    psoDesc.colorAttachments[i],
+                    colorAttachments[i].pixelFormat,
+                    desc.blend,
+                    desc.blend.targets[desc.blend.independentBlendEnabled ? i : 0]
+                );
+            };
+
+            psoDesc.depthAttachmentPixelFormat      = renderPass->GetDepthAttachment().pixelFormat;
+            psoDesc.stencilAttachmentPixelFormat    = renderPass->GetStencilAttachment().pixelFormat;
+            psoDesc.rasterizationEnabled            = (desc.rasterizer.discardEnabled ? NO : YES);
+            psoDesc.rasterSampleCount               = (desc.rasterizer.multiSampleEnabled ? renderPass->GetSampleCount() : 1u);
+        }
+
+        NSError* error = nullptr;
+        renderPipelineState_ = [device newRenderPipelineStateWithMeshDescriptor:psoDesc options:MTLPipelineOptionNone reflection:nil error:&error];
+
+        [psoDesc release];
+        [objectFunc release];
+        [meshFunc release];
+        [fragmentFunc release];
+
+        if (!renderPipelineState_)
+            MTThrowIfCreateFailed(error, "MTLRenderPipelineState");
+    }
+    else
+        throw std::runtime_error("Metal mesh render pipelines require macOS 13.0 or iOS 16.0");
+}
+
 void MTGraphicsPSO::CreateDepthStencilState(
     id<MTLDevice>                       device,
     const GraphicsPipelineDescriptor&   desc)
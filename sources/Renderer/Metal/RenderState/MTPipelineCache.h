@@ -0,0 +1,74 @@
+/*
+ * MTPipelineCache.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MT_PIPELINE_CACHE_H
+#define LLGL_MT_PIPELINE_CACHE_H
+
+
+#import <Metal/Metal.h>
+
+#include <LLGL/Blob.h>
+#include <memory>
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+/*
+Device-wide wrapper for a native MTLBinaryArchive that is shared between all graphics and compute PSOs.
+Requires macOS 11.0 or iOS 14.0; otherwise, all functions of this class have no effect.
+All public functions are guarded by a mutex, since PSOs can be created from multiple threads.
+*/
+class MTPipelineCache
+{
+
+    public:
+
+        MTPipelineCache(id<MTLDevice> device);
+        ~MTPipelineCache();
+
+        /*
+        Loads the specified serialized binary archive into this cache, unless pipelines have already been loaded or recorded.
+        MTLBinaryArchive can only be loaded from a file, so the data is written to a temporary file that is kept for the lifetime of this cache.
+        */
+        void Merge(id<MTLDevice> device, const void* data, std::size_t size);
+
+        // Records the compiled functions of the specified pipeline descriptor into the binary archive.
+        void AddRenderPipeline(MTLRenderPipelineDescriptor* pipelineDesc);
+        void AddComputePipeline(MTLComputePipelineDescriptor* pipelineDesc);
+
+        // Returns the entire content of the binary archive as blob, or null if the archive is empty.
+        std::unique_ptr<Blob> GetData() const;
+
+        // Returns the array of binary archives for the 'binaryArchives' property of pipeline descriptors, or nil if the archive is empty.
+        NSArray* GetBinaryArchives() const;
+
+    private:
+
+        // (Re-)creates the native binary archive with the optional URL to a serialized archive.
+        bool CreateBinaryArchive(id<MTLDevice> device, NSURL* url);
+
+    private:
+
+        id<MTLBinaryArchive>    binaryArchive_  = nil;
+        NSURL*                  archiveURL_     = nil;  // Temporary file the archive has been loaded from.
+        bool                    hasContent_     = false;
+        mutable std::mutex      mutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
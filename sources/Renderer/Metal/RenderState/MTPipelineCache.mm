@@ -0,0 +1,146 @@
+/*
+ * MTPipelineCache.mm
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MTPipelineCache.h"
+
+
+namespace LLGL
+{
+
+
+// Returns a new URL for a temporary file to (de-)serialize the binary archive.
+static NSURL* MakeTemporaryArchiveURL()
+{
+    NSString* filename = [[[NSUUID UUID] UUIDString] stringByAppendingPathExtension:@"metallib"];
+    return [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:filename]];
+}
+
+MTPipelineCache::MTPipelineCache(id<MTLDevice> device)
+{
+    CreateBinaryArchive(device, nil);
+}
+
+MTPipelineCache::~MTPipelineCache()
+{
+    [binaryArchive_ release];
+
+    /* Remove temporary file of the loaded archive after the archive has been released */
+    if (archiveURL_ != nil)
+    {
+        [[NSFileManager defaultManager] removeItemAtURL:archiveURL_ error:nil];
+        [archiveURL_ release];
+    }
+}
+
+void MTPipelineCache::Merge(id<MTLDevice> device, const void* data, std::size_t size)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    /* Subsequent archives are ignored, since all pipelines of this run are recorded into the first one */
+    if (hasContent_ || data == nullptr || size == 0)
+        return;
+
+    NSURL* url = MakeTemporaryArchiveURL();
+    NSData* archiveData = [NSData dataWithBytesNoCopy:const_cast<void*>(data) length:size freeWhenDone:NO];
+    if ([archiveData writeToURL:url atomically:NO])
+    {
+        /* Archive of a different device or OS version is rejected by Metal, so keep the empty archive in that case */
+        if (CreateBinaryArchive(device, url))
+        {
+            /* Keep the file until the archive is released, since Metal may load its content lazily */
+            archiveURL_ = [url retain];
+            hasContent_ = true;
+        }
+        else
+            [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+    }
+}
+
+void MTPipelineCache::AddRenderPipeline(MTLRenderPipelineDescriptor* pipelineDesc)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    if (@available(macOS 11.0, iOS 14.0, *))
+    {
+        if (binaryArchive_ != nil && [binaryArchive_ addRenderPipelineFunctionsWithDescriptor:pipelineDesc error:nil])
+            hasContent_ = true;
+    }
+}
+
+void MTPipelineCache::AddComputePipeline(MTLComputePipelineDescriptor* pipelineDesc)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    if (@available(macOS 11.0, iOS 14.0, *))
+    {
+        if (binaryArchive_ != nil && [binaryArchive_ addComputePipelineFunctionsWithDescriptor:pipelineDesc error:nil])
+            hasContent_ = true;
+    }
+}
+
+std::unique_ptr<Blob> MTPipelineCache::GetData() const
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    if (@available(macOS 11.0, iOS 14.0, *))
+    {
+        if (binaryArchive_ == nil || !hasContent_)
+            return nullptr;
+
+        /* Serialize binary archive into temporary file and read it back into a blob */
+        std::unique_ptr<Blob> blob;
+        NSURL* url = MakeTemporaryArchiveURL();
+        if ([binaryArchive_ serializeToURL:url error:nil])
+        {
+            if (NSData* archiveData = [NSData dataWithContentsOfURL:url])
+                blob = Blob::CreateCopy([archiveData bytes], static_cast<std::size_t>([archiveData length]));
+            [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+        }
+        return blob;
+    }
+    return nullptr;
+}
+
+NSArray* MTPipelineCache::GetBinaryArchives() const
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    if (binaryArchive_ != nil && hasContent_)
+        return @[binaryArchive_];
+    return nil;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool MTPipelineCache::CreateBinaryArchive(id<MTLDevice> device, NSURL* url)
+{
+    if (@available(macOS 11.0, iOS 14.0, *))
+    {
+        MTLBinaryArchiveDescriptor* archiveDesc = [[MTLBinaryArchiveDescriptor alloc] init];
+        archiveDesc.url = url;
+        id<MTLBinaryArchive> binaryArchive = [device newBinaryArchiveWithDescriptor:archiveDesc error:nil];
+        [archiveDesc release];
+
+        if (binaryArchive != nil)
+        {
+            [binaryArchive_ release];
+            binaryArchive_ = binaryArchive;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
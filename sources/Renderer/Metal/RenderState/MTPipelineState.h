@@ -13,6 +13,7 @@
 
 #include <LLGL/PipelineState.h>
 #include "../../../Core/BasicReport.h"
+#include "../../PipelineCompileTask.h"
 
 
 namespace LLGL
@@ -27,6 +28,8 @@ class MTPipelineState : public PipelineState
         MTPipelineState(bool isGraphicsPSO);
 
         const Report* GetReport() const override final;
+        bool IsReady() const override final;
+        void Wait() override final;
 
         // Returns true if this is a graphics PSO.
         inline bool IsGraphicsPSO() const
@@ -34,15 +37,25 @@ class MTPipelineState : public PipelineState
             return isGraphicsPSO_;
         }
 
+        // Returns true if draw or dispatch commands must be skipped while this PSO is still being compiled.
+        inline bool SkipDraws() const
+        {
+            return compileTask_.SkipDraws();
+        }
+
     protected:
 
+        // Runs the specified function to create the native PSO on the job system.
+        void StartCompileTask(const std::function<void()>& task, long flags);
+
         // Writes the report with the specified message and error bit.
         void ResetReport(std::string&& text, bool hasErrors = false);
         
     private:
 
-        const bool  isGraphicsPSO_ = false;
-        BasicReport report_;
+        const bool          isGraphicsPSO_ = false;
+        BasicReport         report_;
+        PipelineCompileTask compileTask_;
 
 };
 
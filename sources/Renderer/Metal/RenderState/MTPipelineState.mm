@@ -22,6 +22,21 @@ const Report* MTPipelineState::GetReport() const
     return (report_ ? &report_ : nullptr);
 }
 
+bool MTPipelineState::IsReady() const
+{
+    return compileTask_.IsReady();
+}
+
+void MTPipelineState::Wait()
+{
+    compileTask_.Wait();
+}
+
+void MTPipelineState::StartCompileTask(const std::function<void()>& task, long flags)
+{
+    compileTask_.Start(task, flags);
+}
+
 void MTPipelineState::ResetReport(std::string&& text, bool hasErrors)
 {
     report_.Reset(std::forward<std::string&&>(text), hasErrors);
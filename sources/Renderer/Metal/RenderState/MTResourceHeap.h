@@ -17,6 +17,7 @@
 #include <LLGL/Container/ArrayView.h>
 #include <LLGL/Container/SmallVector.h>
 #include "../../SegmentedBuffer.h"
+#include "../Buffer/MTBuffer.h"
 #include <vector>
 #include <functional>
 
@@ -29,12 +30,15 @@ enum MTResourceType : std::uint32_t;
 class MTTexture;
 class BindingDescriptorIterator;
 struct MTResourceBinding;
+struct BindingDescriptor;
 struct ResourceHeapDescriptor;
 struct TextureViewDescriptor;
 
 /*
 This class emulates the behavior of a descriptor set like in Vulkan,
 by binding all shader resources within one bind call in the command buffer.
+If an argument buffer slot is specified (see ResourceHeapDescriptor::bindlessSlot) and the device supports Tier-2 argument buffers,
+all resources are encoded into an argument buffer instead, which is bound with a single 'setBuffer' call per shader stage.
 */
 class MTResourceHeap final : public ResourceHeap
 {
@@ -46,6 +50,7 @@ class MTResourceHeap final : public ResourceHeap
     public:
 
         MTResourceHeap(
+            id<MTLDevice>                               device,
             const ResourceHeapDescriptor&               desc,
             const ArrayView<ResourceViewDescriptor>&    initialResourceViews = {}
         );
@@ -60,6 +65,9 @@ class MTResourceHeap final : public ResourceHeap
         bool HasGraphicsResources() const;
         bool HasComputeResources() const;
 
+        // Returns the usage trackers of the buffers in the specified descriptor set that reside in shared memory. Entries may be null.
+        ArrayView<MTBufferUsagePtr> GetBufferUsages(std::uint32_t descriptorSet) const;
+
     private:
 
         struct MTResourceBinding;
@@ -159,19 +167,39 @@ class MTResourceHeap final : public ResourceHeap
         void WriteResourceViewTexture(const ResourceViewDescriptor& desc, char* heapPtr, const BindingSegmentLocation::Stage& binding, std::uint32_t descriptorSet);
         void WriteResourceViewSamplerState(const ResourceViewDescriptor& desc, char* heapPtr, const BindingSegmentLocation::Stage& binding);
 
-        void ExchangeTextureView(
-            std::uint32_t                           descriptorSet,
-            const BindingSegmentLocation::Stage&    binding,
-            id<MTLTexture>                          textureView
-        );
+        // Creates the argument encoder and argument buffer for all descriptor sets. Returns false if Tier-2 argument buffers are not supported.
+        bool CreateArgumentBuffer(id<MTLDevice> device, const std::vector<BindingDescriptor>& bindings, std::uint32_t numDescriptorSets);
+
+        // Encodes the specified resource view into the argument buffer and stores the resource for its residency.
+        void WriteResourceViewArgument(const ResourceViewDescriptor& desc, std::uint32_t descriptor);
+
+        // Makes all resources of the specified descriptor set resident for the indirect access through the argument buffer.
+        void UseArgumentResources(id<MTLRenderCommandEncoder> renderEncoder, std::uint32_t descriptorSet);
+        void UseArgumentResources(id<MTLComputeCommandEncoder> computeEncoder, std::uint32_t descriptorSet);
+
+        // Stores the indirect command buffer of the specified resource view (if any) for its residency in compute passes.
+        void WriteIndirectCommandBuffer(const ResourceViewDescriptor& desc, std::uint32_t descriptor, std::uint32_t numDescriptors);
+
+        // Makes all indirect command buffers of the specified descriptor set resident, so compute kernels can encode draw commands into them.
+        void UseIndirectCommandBuffers(id<MTLComputeCommandEncoder> computeEncoder, std::uint32_t descriptorSet);
+
+        // Stores the usage tracker of the specified resource view (if any) for hazard tracking of buffers in shared memory.
+        void WriteBufferUsage(const ResourceViewDescriptor& desc, std::uint32_t descriptor, std::uint32_t numDescriptors);
+
+        void ExchangeTextureView(id<MTLTexture>& texViewEntry, id<MTLTexture> textureView);
 
         id<MTLTexture> GetOrCreateTexture(
-            std::uint32_t                           descriptorSet,
-            const BindingSegmentLocation::Stage&    binding,
+            id<MTLTexture>&                         texViewEntry,
             MTTexture&                              textureMT,
             const TextureViewDescriptor&            textureViewDesc
         );
 
+        // Returns true if this resource heap encodes its resources into an argument buffer.
+        inline bool HasArgumentBuffer() const
+        {
+            return (argumentBuffer_ != nil);
+        }
+
     private:
 
         static std::vector<MTResourceBinding> FilterAndSortMTBindingSlots(
@@ -198,6 +226,19 @@ class MTResourceHeap final : public ResourceHeap
         std::vector<id<MTLTexture>>         textureViews_;
         std::uint32_t                       numTextureViewsPerSet_  = 0;
 
+        std::vector<id<MTLResource>>        indirectCommandBuffers_;        // Indirect command buffers of each descriptor; empty if there are none.
+        std::vector<MTBufferUsagePtr>       bufferUsages_;                  // Usage trackers of shared buffers of each descriptor; empty if there are none.
+
+        /* ----- Argument buffer ----- */
+
+        id<MTLArgumentEncoder>              argumentEncoder_        = nil;
+        id<MTLBuffer>                       argumentBuffer_         = nil;
+        NSUInteger                          argumentBufferSlot_     = 0;
+        NSUInteger                          argumentBufferStride_   = 0;    // Aligned size (in bytes) of the encoded arguments per descriptor set.
+        std::uint32_t                       numArgumentSets_        = 0;
+        std::vector<id<MTLResource>>        argumentResources_;             // Resources of each descriptor; referenced indirectly, so they must be made resident with 'useResource'.
+        std::vector<MTLResourceUsage>       argumentResourceUsages_;
+
 };
 
 
@@ -85,6 +85,7 @@ struct MTResourceHeapSegment
  */
 
 MTResourceHeap::MTResourceHeap(
+    id<MTLDevice>                               device,
     const ResourceHeapDescriptor&               desc,
     const ArrayView<ResourceViewDescriptor>&    initialResourceViews)
 {
@@ -101,11 +102,39 @@ MTResourceHeap::MTResourceHeap(
     /* Allocate array to map binding index to descriptor index */
     bindingMap_.resize(numBindings);
 
-    /* Build buffer segments */
     constexpr long vertexStages     = (StageFlags::VertexStage | StageFlags::TessEvaluationStage);
     constexpr long fragmentStages   = (StageFlags::FragmentStage);
     constexpr long kernelStages     = (StageFlags::ComputeStage | StageFlags::TessControlStage);
 
+    const auto numSegmentSets = (numResourceViews / numBindings);
+
+    /* Encode all resources into a single argument buffer if an argument buffer slot is specified */
+    if (desc.bindlessSlot != Constants::invalidSlot && CreateArgumentBuffer(device, bindings, numSegmentSets))
+    {
+        argumentBufferSlot_ = static_cast<NSUInteger>(desc.bindlessSlot);
+
+        /* Store which shader stages the argument buffer must be bound to */
+        InitMemory(segmentation_);
+        for (const auto& binding : bindings)
+        {
+            if ((binding.stageFlags & vertexStages) != 0)
+                segmentation_.hasVertexResources = 1;
+            if ((binding.stageFlags & fragmentStages) != 0)
+                segmentation_.hasFragmentResources = 1;
+            if ((binding.stageFlags & kernelStages) != 0)
+                segmentation_.hasKernelResources = 1;
+        }
+
+        /* Allocate one texture view entry per descriptor */
+        numTextureViewsPerSet_ = numBindings;
+        textureViews_.resize(numTextureViewsPerSet_ * numSegmentSets);
+
+        if (!initialResourceViews.empty())
+            WriteResourceViews(0, initialResourceViews);
+        return;
+    }
+
+    /* Build buffer segments */
     BindingDescriptorIterator bindingIter{ bindings };
     InitMemory(segmentation_);
 
@@ -130,7 +159,6 @@ MTResourceHeap::MTResourceHeap(
     CacheResourceUsage();
 
     /* Finalize segments in buffer */
-    const auto numSegmentSets = (numResourceViews / numBindings);
     heap_.FinalizeSegments(numSegmentSets);
 
     /* Allocate texture view array */
@@ -148,10 +176,16 @@ MTResourceHeap::~MTResourceHeap()
         if (tex != nil)
             [tex release];
     }
+    if (argumentBuffer_ != nil)
+        [argumentBuffer_ release];
+    if (argumentEncoder_ != nil)
+        [argumentEncoder_ release];
 }
 
 std::uint32_t MTResourceHeap::GetNumDescriptorSets() const
 {
+    if (HasArgumentBuffer())
+        return numArgumentSets_;
     return static_cast<std::uint32_t>(heap_.NumSets());
 }
 
@@ -171,9 +205,26 @@ std::uint32_t MTResourceHeap::WriteResourceViews(std::uint32_t firstDescriptor,
     if (firstDescriptor + resourceViews.size() > numDescriptors)
         return 0;
 
-    /* Write each resource view into respective segment */
     std::uint32_t numWritten = 0;
 
+    if (HasArgumentBuffer())
+    {
+        /* Encode each resource view into the argument buffer */
+        for (const auto& desc : resourceViews)
+        {
+            if (desc.resource != nullptr)
+            {
+                WriteResourceViewArgument(desc, firstDescriptor);
+                WriteIndirectCommandBuffer(desc, firstDescriptor, numDescriptors);
+                WriteBufferUsage(desc, firstDescriptor, numDescriptors);
+                ++numWritten;
+            }
+            ++firstDescriptor;
+        }
+        return numWritten;
+    }
+
+    /* Write each resource view into respective segment */
     for (const auto& desc : resourceViews)
     {
         /* Skip over empty resource descriptors */
@@ -210,6 +261,9 @@ std::uint32_t MTResourceHeap::WriteResourceViews(std::uint32_t firstDescriptor,
             }
         }
 
+        WriteIndirectCommandBuffer(desc, firstDescriptor, numDescriptors);
+        WriteBufferUsage(desc, firstDescriptor, numDescriptors);
+
         ++numWritten;
         ++firstDescriptor;
     }
@@ -219,9 +273,21 @@ std::uint32_t MTResourceHeap::WriteResourceViews(std::uint32_t firstDescriptor,
 
 void MTResourceHeap::BindGraphicsResources(id<MTLRenderCommandEncoder> renderEncoder, std::uint32_t descriptorSet)
 {
-    if (descriptorSet >= heap_.NumSets())
+    if (descriptorSet >= GetNumDescriptorSets())
         return;
 
+    if (HasArgumentBuffer())
+    {
+        /* Bind argument buffer with a single call per shader stage */
+        UseArgumentResources(renderEncoder, descriptorSet);
+        const NSUInteger offset = argumentBufferStride_ * descriptorSet;
+        if (segmentation_.hasVertexResources)
+            [renderEncoder setVertexBuffer:argumentBuffer_ offset:offset atIndex:argumentBufferSlot_];
+        if (segmentation_.hasFragmentResources)
+            [renderEncoder setFragmentBuffer:argumentBuffer_ offset:offset atIndex:argumentBufferSlot_];
+        return;
+    }
+
     const char* heapPtr = heap_.SegmentData(descriptorSet);
     if (segmentation_.hasVertexResources)
         heapPtr = BindVertexResources(renderEncoder, heapPtr);
@@ -231,7 +297,19 @@ void MTResourceHeap::BindGraphicsResources(id<MTLRenderCommandEncoder> renderEnc
 
 void MTResourceHeap::BindComputeResources(id<MTLComputeCommandEncoder> computeEncoder, std::uint32_t descriptorSet)
 {
-    if (segmentation_.hasKernelResources)
+    /* Indirect command buffers are only referenced by their argument buffers, so they must be made resident explicitly */
+    if (!indirectCommandBuffers_.empty() && descriptorSet < GetNumDescriptorSets())
+        UseIndirectCommandBuffers(computeEncoder, descriptorSet);
+
+    if (HasArgumentBuffer())
+    {
+        if (segmentation_.hasKernelResources && descriptorSet < numArgumentSets_)
+        {
+            UseArgumentResources(computeEncoder, descriptorSet);
+            [computeEncoder setBuffer:argumentBuffer_ offset:(argumentBufferStride_ * descriptorSet) atIndex:argumentBufferSlot_];
+        }
+    }
+    else if (segmentation_.hasKernelResources)
     {
         auto heapPtr = heap_.SegmentData(descriptorSet) + heapOffsetKernel_;
         BindKernelResources(computeEncoder, heapPtr);
@@ -248,6 +326,14 @@ bool MTResourceHeap::HasComputeResources() const
     return (segmentation_.hasKernelResources != 0);
 }
 
+ArrayView<MTBufferUsagePtr> MTResourceHeap::GetBufferUsages(std::uint32_t descriptorSet) const
+{
+    if (bufferUsages_.empty() || descriptorSet >= GetNumDescriptorSets())
+        return {};
+    const auto numBindings = bindingMap_.size();
+    return ArrayView<MTBufferUsagePtr>{ &bufferUsages_[descriptorSet * numBindings], numBindings };
+}
+
 
 /*
  * ======= Private: =======
@@ -557,7 +643,9 @@ void MTResourceHeap::WriteResourceViewTexture(const ResourceViewDescriptor& desc
 {
     /* Get texture resource and Write MTLTexture ID */
     auto textureMT = LLGL_CAST(MTTexture*, GetAsExpectedTexture(desc.resource));
-    MTRESOURCEHEAP_DATA0_MTLTEXTURE(heapPtr)[binding.descriptorIndex] = GetOrCreateTexture(descriptorSet, binding, *textureMT, desc.textureView);
+    LLGL_ASSERT(binding.textureViewIndex < numTextureViewsPerSet_);
+    auto& texViewEntry = textureViews_[descriptorSet * numTextureViewsPerSet_ + binding.textureViewIndex];
+    MTRESOURCEHEAP_DATA0_MTLTEXTURE(heapPtr)[binding.descriptorIndex] = GetOrCreateTexture(texViewEntry, *textureMT, desc.textureView);
 }
 
 void MTResourceHeap::WriteResourceViewSamplerState(const ResourceViewDescriptor& desc, char* heapPtr, const BindingSegmentLocation::Stage& binding)
@@ -567,6 +655,187 @@ void MTResourceHeap::WriteResourceViewSamplerState(const ResourceViewDescriptor&
     MTRESOURCEHEAP_DATA0_MTLSAMPLERSTATE(heapPtr)[binding.descriptorIndex] = samplerMT->GetNative();
 }
 
+// Returns the Metal argument data type for the specified resource type.
+static MTLDataType ToMTLArgumentDataType(const ResourceType type)
+{
+    switch (type)
+    {
+        case ResourceType::Buffer:  return MTLDataTypePointer;
+        case ResourceType::Texture: return MTLDataTypeTexture;
+        case ResourceType::Sampler: return MTLDataTypeSampler;
+        default:                    break;
+    }
+    throw std::invalid_argument("cannot encode argument buffer for binding of undefined resource type");
+}
+
+bool MTResourceHeap::CreateArgumentBuffer(id<MTLDevice> device, const std::vector<BindingDescriptor>& bindings, std::uint32_t numDescriptorSets)
+{
+    if (@available(macOS 10.13, iOS 11.0, *))
+    {
+        /* Only Tier-2 argument buffers can hold writable textures and arbitrary numbers of resources */
+        if ([device argumentBuffersSupport] != MTLArgumentBuffersTier2)
+            return false;
+
+        /* Declare one argument per binding; the argument index ([[id(n)]] in MSL) is the index of the binding in the pipeline layout */
+        const auto numBindings = bindings.size();
+
+        NSMutableArray<MTLArgumentDescriptor*>* arguments = [[NSMutableArray alloc] initWithCapacity:numBindings];
+        argumentResourceUsages_.resize(numBindings, MTLResourceUsageRead);
+
+        for_range(i, numBindings)
+        {
+            const auto& binding     = bindings[i];
+            const bool  isWritable  = ((binding.bindFlags & BindFlags::Storage) != 0);
+
+            MTLArgumentDescriptor* argumentDesc = [[MTLArgumentDescriptor alloc] init];
+            {
+                argumentDesc.dataType   = ToMTLArgumentDataType(binding.type);
+                argumentDesc.index      = static_cast<NSUInteger>(i);
+                argumentDesc.access     = (isWritable ? MTLArgumentAccessReadWrite : MTLArgumentAccessReadOnly);
+            }
+            [arguments addObject:argumentDesc];
+            [argumentDesc release];
+
+            if (isWritable)
+                argumentResourceUsages_[i] = (MTLResourceUsageRead | MTLResourceUsageWrite);
+        }
+
+        argumentEncoder_ = [device newArgumentEncoderWithArguments:arguments];
+        [arguments release];
+
+        /* Allocate argument buffer with one aligned range of encoded arguments per descriptor set */
+        argumentBufferStride_   = GetAlignedSize<NSUInteger>([argumentEncoder_ encodedLength], [argumentEncoder_ alignment]);
+        argumentBuffer_         = [device
+            newBufferWithLength:    argumentBufferStride_ * numDescriptorSets
+            options:                (MTLResourceStorageModeShared | MTLResourceCPUCacheModeWriteCombined)
+        ];
+        numArgumentSets_        = numDescriptorSets;
+
+        argumentResources_.resize(numBindings * numDescriptorSets, nil);
+
+        return true;
+    }
+    return false;
+}
+
+void MTResourceHeap::WriteResourceViewArgument(const ResourceViewDescriptor& desc, std::uint32_t descriptor)
+{
+    const auto      numBindings     = static_cast<std::uint32_t>(bindingMap_.size());
+    const auto      descriptorSet   = descriptor / numBindings;
+    const NSUInteger index          = descriptor % numBindings;
+
+    if (@available(macOS 10.13, iOS 11.0, *))
+    {
+        [argumentEncoder_ setArgumentBuffer:argumentBuffer_ offset:(argumentBufferStride_ * descriptorSet)];
+
+        switch (desc.resource->GetResourceType())
+        {
+            case ResourceType::Buffer:
+            {
+                auto bufferMT = LLGL_CAST(MTBuffer*, GetAsExpectedBuffer(desc.resource));
+                [argumentEncoder_ setBuffer:bufferMT->GetNative() offset:static_cast<NSUInteger>(desc.bufferView.offset) atIndex:index];
+                argumentResources_[descriptor] = bufferMT->GetNative();
+            }
+            break;
+
+            case ResourceType::Texture:
+            {
+                auto textureMT = LLGL_CAST(MTTexture*, GetAsExpectedTexture(desc.resource));
+                id<MTLTexture> texture = GetOrCreateTexture(textureViews_[descriptor], *textureMT, desc.textureView);
+                [argumentEncoder_ setTexture:texture atIndex:index];
+                argumentResources_[descriptor] = texture;
+            }
+            break;
+
+            case ResourceType::Sampler:
+            {
+                /* Sampler states are not resources, so they don't need to be made resident */
+                auto samplerMT = LLGL_CAST(MTSampler*, GetAsExpectedSampler(desc.resource));
+                [argumentEncoder_ setSamplerState:samplerMT->GetNative() atIndex:index];
+                argumentResources_[descriptor] = nil;
+            }
+            break;
+
+            default:
+            break;
+        }
+    }
+}
+
+void MTResourceHeap::UseArgumentResources(id<MTLRenderCommandEncoder> renderEncoder, std::uint32_t descriptorSet)
+{
+    if (@available(macOS 10.13, iOS 11.0, *))
+    {
+        const auto numBindings  = bindingMap_.size();
+        const auto resources    = &argumentResources_[descriptorSet * numBindings];
+        for_range(i, numBindings)
+        {
+            if (resources[i] != nil)
+                [renderEncoder useResource:resources[i] usage:argumentResourceUsages_[i]];
+        }
+    }
+}
+
+void MTResourceHeap::UseArgumentResources(id<MTLComputeCommandEncoder> computeEncoder, std::uint32_t descriptorSet)
+{
+    if (@available(macOS 10.13, iOS 11.0, *))
+    {
+        const auto numBindings  = bindingMap_.size();
+        const auto resources    = &argumentResources_[descriptorSet * numBindings];
+        for_range(i, numBindings)
+        {
+            if (resources[i] != nil)
+                [computeEncoder useResource:resources[i] usage:argumentResourceUsages_[i]];
+        }
+    }
+}
+
+void MTResourceHeap::WriteIndirectCommandBuffer(const ResourceViewDescriptor& desc, std::uint32_t descriptor, std::uint32_t numDescriptors)
+{
+    id<MTLResource> indirectCommandBuffer = nil;
+    if (desc.resource->GetResourceType() == ResourceType::Buffer)
+    {
+        auto bufferMT = LLGL_CAST(MTBuffer*, desc.resource);
+        indirectCommandBuffer = bufferMT->GetIndirectCommandBuffer();
+    }
+
+    /* Only allocate the list of indirect command buffers once the first one is written to this heap */
+    if (indirectCommandBuffer != nil && indirectCommandBuffers_.empty())
+        indirectCommandBuffers_.resize(numDescriptors, nil);
+    if (!indirectCommandBuffers_.empty())
+        indirectCommandBuffers_[descriptor] = indirectCommandBuffer;
+}
+
+void MTResourceHeap::UseIndirectCommandBuffers(id<MTLComputeCommandEncoder> computeEncoder, std::uint32_t descriptorSet)
+{
+    if (@available(macOS 10.13, iOS 11.0, *))
+    {
+        const auto numBindings  = bindingMap_.size();
+        const auto resources    = &indirectCommandBuffers_[descriptorSet * numBindings];
+        for_range(i, numBindings)
+        {
+            if (resources[i] != nil)
+                [computeEncoder useResource:resources[i] usage:MTLResourceUsageWrite];
+        }
+    }
+}
+
+void MTResourceHeap::WriteBufferUsage(const ResourceViewDescriptor& desc, std::uint32_t descriptor, std::uint32_t numDescriptors)
+{
+    MTBufferUsagePtr usage;
+    if (desc.resource->GetResourceType() == ResourceType::Buffer)
+    {
+        auto bufferMT = LLGL_CAST(MTBuffer*, desc.resource);
+        usage = bufferMT->GetUsage();
+    }
+
+    /* Only allocate the list of usage trackers once the first shared buffer is written to this heap */
+    if (usage && bufferUsages_.empty())
+        bufferUsages_.resize(numDescriptors);
+    if (!bufferUsages_.empty())
+        bufferUsages_[descriptor] = std::move(usage);
+}
+
 static void ValidateTexViewNoSwizzle(MTTexture& /*textureMT*/, const TextureViewDescriptor& desc)
 {
     if (!IsTextureSwizzleIdentity(desc.swizzle))
@@ -584,13 +853,8 @@ static void ValidateTexViewNoTypeAndRange(MTTexture& textureMT, const TextureVie
         throw std::runtime_error("cannot create texture-view of different array-layer range for this version of the Metal API");
 }
 
-void MTResourceHeap::ExchangeTextureView(
-    std::uint32_t                           descriptorSet,
-    const BindingSegmentLocation::Stage&    binding,
-    id<MTLTexture>                          textureView)
+void MTResourceHeap::ExchangeTextureView(id<MTLTexture>& texViewEntry, id<MTLTexture> textureView)
 {
-    LLGL_ASSERT(binding.textureViewIndex < numTextureViewsPerSet_);
-    auto& texViewEntry = textureViews_[descriptorSet * numTextureViewsPerSet_ + binding.textureViewIndex];
     if (texViewEntry != textureView)
     {
         if (texViewEntry != nil)
@@ -600,8 +864,7 @@ void MTResourceHeap::ExchangeTextureView(
 }
 
 id<MTLTexture> MTResourceHeap::GetOrCreateTexture(
-    std::uint32_t                           descriptorSet,
-    const BindingSegmentLocation::Stage&    binding,
+    id<MTLTexture>&                         texViewEntry,
     MTTexture&                              textureMT,
     const TextureViewDescriptor&            textureViewDesc)
 {
@@ -643,13 +906,13 @@ id<MTLTexture> MTResourceHeap::GetOrCreateTexture(
         }
 
         /* Store texture view reference */
-        ExchangeTextureView(descriptorSet, binding, textureView);
+        ExchangeTextureView(texViewEntry, textureView);
         return textureView;
     }
     else
     {
         /* Release previously stored texture view reference */
-        ExchangeTextureView(descriptorSet, binding, nil);
+        ExchangeTextureView(texViewEntry, nil);
         return textureMT.GetNative();
     }
 }
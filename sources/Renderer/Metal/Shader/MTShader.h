@@ -12,7 +12,13 @@
 #import <Metal/Metal.h>
 
 #include <LLGL/Shader.h>
+#include <LLGL/PipelineStateFlags.h>
 #include "../../../Core/BasicReport.h"
+#include "MTShaderLibrary.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 
 namespace LLGL
@@ -24,7 +30,11 @@ class MTShader final : public Shader
 
     public:
 
-        MTShader(id<MTLDevice> device, const ShaderDescriptor& desc);
+        /*
+        Starts compiling the shader source asynchronously if the descriptor refers to MSL source code.
+        Libraries with equal source are shared via the specified cache if it is not null.
+        */
+        MTShader(id<MTLDevice> device, const ShaderDescriptor& desc, MTShaderLibraryCache* libraryCache = nullptr);
         ~MTShader();
 
         const Report* GetReport() const override;
@@ -38,19 +48,19 @@ class MTShader final : public Shader
         // Returns the number of patch control points for a post-tessellation vertex shader or 0 if this is not a vertex shader.
         NSUInteger GetNumPatchControlPoints() const;
 
-        // Returns the native MTLFunction object.
-        inline id<MTLFunction> GetNative() const
-        {
-            return native_;
-        }
+        // Returns the native MTLFunction object. Blocks until the asynchronous compilation has completed.
+        id<MTLFunction> GetNative() const;
 
-        // Returns the MTLVertexDescriptor object for this shader program.
-        inline MTLVertexDescriptor* GetMTLVertexDesc() const
-        {
-            return vertexDesc_;
-        }
+        /*
+        Returns a new MTLFunction object that is specialized with the specified function constants, or the retained native function if there are no constants.
+        The caller is responsible to release the returned object.
+        */
+        id<MTLFunction> NewFunctionWithConstants(const std::vector<SpecializationConstant>& constants) const;
 
-        // Returns the number of threads per thread-group for compute kernels.
+        // Returns the MTLVertexDescriptor object for this shader program. Blocks until the asynchronous compilation has completed.
+        MTLVertexDescriptor* GetMTLVertexDesc() const;
+
+        // Returns the number of threads per thread-group for compute kernels, object functions, and mesh functions.
         inline const MTLSize& GetNumThreadsPerGroup() const
         {
             return numThreadsPerGroup_;
@@ -58,10 +68,13 @@ class MTShader final : public Shader
 
     private:
 
-        bool Compile(id<MTLDevice> device, const ShaderDescriptor& shaderDesc);
         bool CompileSource(id<MTLDevice> device, const ShaderDescriptor& shaderDesc);
         bool CompileBinary(id<MTLDevice> device, const ShaderDescriptor& shaderDesc);
 
+        // Waits for the asynchronous library compilation, then loads the function and builds the input layout once.
+        void FinishCompilation() const;
+        void FinishCompilationOnce();
+
         void BuildInputLayout(std::size_t numVertexAttribs, const VertexAttribute* vertexAttribs);
 
         bool LoadFunction(const char* entryPoint);
@@ -70,14 +83,22 @@ class MTShader final : public Shader
 
     private:
 
-        id<MTLDevice>           device_             = nil;
-        id<MTLLibrary>          library_            = nil;
-        id<MTLFunction>         native_             = nil;
+        id<MTLDevice>                       device_             = nil;
+        id<MTLLibrary>                      library_            = nil;
+        id<MTLFunction>                     native_             = nil;
+
+        BasicReport                         report_;
+        MTLSize                             numThreadsPerGroup_ = {};
+
+        MTLVertexDescriptor*                vertexDesc_         = nullptr;
 
-        BasicReport             report_;
-        MTLSize                 numThreadsPerGroup_ = {};
+        /* ----- Pending asynchronous compilation ----- */
 
-        MTLVertexDescriptor*    vertexDesc_         = nullptr;
+        MTShaderLibraryCache*               libraryCache_       = nullptr;
+        std::shared_ptr<MTShaderLibrary>    pendingLibrary_;
+        std::string                         entryPoint_;
+        std::vector<VertexAttribute>        inputAttribs_;
+        mutable std::once_flag              compileOnceFlag_;
 
 };
 
@@ -7,6 +7,7 @@
 
 #include "MTShader.h"
 #include "../MTTypes.h"
+#include "../MTCore.h"
 #include <LLGL/Platform/Platform.h>
 #include <cstring>
 #include <set>
@@ -16,26 +17,36 @@ namespace LLGL
 {
 
 
-MTShader::MTShader(id<MTLDevice> device, const ShaderDescriptor& desc) :
-    Shader  { desc.type },
-    device_ { device    }
+MTShader::MTShader(id<MTLDevice> device, const ShaderDescriptor& desc, MTShaderLibraryCache* libraryCache) :
+    Shader        { desc.type    },
+    device_       { device       },
+    libraryCache_ { libraryCache }
 {
-    if (Compile(device, desc))
+    /* Store work group size for compute, object (task), and mesh shaders */
+    if (desc.type == ShaderType::Compute || desc.type == ShaderType::Task || desc.type == ShaderType::Mesh)
+    {
+        const auto& workGroupSize = desc.compute.workGroupSize;
+        numThreadsPerGroup_ = MTLSizeMake(workGroupSize.width, workGroupSize.height, workGroupSize.depth);
+    }
+
+    if (IsShaderSourceCode(desc.sourceType))
+    {
+        /* Start compiling asynchronously; function and vertex input layout are resolved once the shader is used */
+        CompileSource(device, desc);
+        entryPoint_     = (desc.entryPoint != nullptr ? desc.entryPoint : "");
+        inputAttribs_   = desc.vertex.inputAttribs;
+    }
+    else if (CompileBinary(device, desc))
     {
         /* Build vertex input layout */
         BuildInputLayout(desc.vertex.inputAttribs.size(), desc.vertex.inputAttribs.data());
-
-        /* Store work group size for compute shaders */
-        if (desc.type == ShaderType::Compute)
-        {
-            const auto& workGroupSize = desc.compute.workGroupSize;
-            numThreadsPerGroup_ = MTLSizeMake(workGroupSize.width, workGroupSize.height, workGroupSize.depth);
-        }
     }
 }
 
 MTShader::~MTShader()
 {
+    if (pendingLibrary_ && libraryCache_ != nullptr)
+        libraryCache_->Release(std::move(pendingLibrary_));
     if (vertexDesc_)
         [vertexDesc_ release];
     if (native_)
@@ -66,6 +77,7 @@ static MTLLanguageVersion GetMTLLanguageVersion(const ShaderDescriptor& desc)
 
 const Report* MTShader::GetReport() const
 {
+    FinishCompilation();
     return (report_ ? &report_ : nullptr);
 }
 
@@ -79,30 +91,36 @@ bool MTShader::Reflect(ShaderReflection& reflection) const
 
 bool MTShader::IsPostTessellationVertex() const
 {
+    FinishCompilation();
     return (GetType() == ShaderType::Vertex && native_ != nil && [native_ patchType] != MTLPatchTypeNone);
 }
 
 NSUInteger MTShader::GetNumPatchControlPoints() const
 {
+    FinishCompilation();
     if (IsPostTessellationVertex())
         return [native_ patchControlPointCount];
     else
         return 0;
 }
 
+id<MTLFunction> MTShader::GetNative() const
+{
+    FinishCompilation();
+    return native_;
+}
+
+MTLVertexDescriptor* MTShader::GetMTLVertexDesc() const
+{
+    FinishCompilation();
+    return vertexDesc_;
+}
+
 
 /*
  * ======= Private: =======
  */
 
-bool MTShader::Compile(id<MTLDevice> device, const ShaderDescriptor& shaderDesc)
-{
-    if (IsShaderSourceCode(shaderDesc.sourceType))
-        return CompileSource(device, shaderDesc);
-    else
-        return CompileBinary(device, shaderDesc);
-}
-
 static NSString* ToNSString(const char* s)
 {
     return [[NSString alloc] initWithUTF8String:(s != nullptr ? s : "")];
@@ -136,29 +154,46 @@ bool MTShader::CompileSource(id<MTLDevice> device, const ShaderDescriptor& shade
     if (sourceString == nil)
         throw std::runtime_error("cannot compile Metal shader without source");
 
-    /* Convert entry point to NSString, and initialize shader compile options */
+    /* Initialize shader compile options */
     MTLCompileOptions* opt = ToMTLCompileOptions(shaderDesc);
 
-    /* Load shader library */
-    NSError* error = [NSError alloc];
-
-    library_ = [device
-        newLibraryWithSource:   sourceString
-        options:                opt
-        error:                  &error
-    ];
+    /* Start compiling shader library or share the one that is already compiled for the same source */
+    if (libraryCache_ != nullptr)
+        pendingLibrary_ = libraryCache_->GetOrCreate(device, sourceString, opt);
+    else
+        pendingLibrary_ = std::make_shared<MTShaderLibrary>(device, sourceString, opt);
 
     [sourceString release];
     [opt release];
 
+    return true;
+}
+
+void MTShader::FinishCompilation() const
+{
+    /* Shaders are never created as const objects, so the lazy completion is allowed to modify this shader */
+    std::call_once(compileOnceFlag_, [this]() { const_cast<MTShader*>(this)->FinishCompilationOnce(); });
+}
+
+void MTShader::FinishCompilationOnce()
+{
+    if (!pendingLibrary_)
+        return;
+
+    /* Wait for asynchronous compilation */
+    if (id<MTLLibrary> library = pendingLibrary_->Wait())
+        library_ = [library retain];
+
     /* Load shader function with entry point */
-    const bool success = LoadFunction(shaderDesc.entryPoint);
+    const bool success = LoadFunction(entryPoint_.c_str());
+    if (success)
+        BuildInputLayout(inputAttribs_.size(), inputAttribs_.data());
 
-    const StringView errorText = [[error localizedDescription] cStringUsingEncoding:NSUTF8StringEncoding];
+    NSError* error = pendingLibrary_->GetError();
+    const StringView errorText = (error != nullptr ? [[error localizedDescription] cStringUsingEncoding:NSUTF8StringEncoding] : nullptr);
     report_.Reset(errorText, !success);
-    [error release];
 
-    return success;
+    inputAttribs_.clear();
 }
 
 //TODO: this is untested!!!
@@ -278,6 +313,51 @@ bool MTShader::LoadFunction(const char* entryPoint)
     return result;
 }
 
+static MTLDataType ToMTLDataType(const SpecializationConstantType type)
+{
+    switch (type)
+    {
+        case SpecializationConstantType::Boolean:   return MTLDataTypeBool;
+        case SpecializationConstantType::Int:       return MTLDataTypeInt;
+        case SpecializationConstantType::UInt:      return MTLDataTypeUInt;
+        case SpecializationConstantType::Float:     return MTLDataTypeFloat;
+        default:                                    return MTLDataTypeNone;
+    }
+}
+
+id<MTLFunction> MTShader::NewFunctionWithConstants(const std::vector<SpecializationConstant>& constants) const
+{
+    FinishCompilation();
+
+    if (constants.empty() || !native_)
+        return [native_ retain];
+
+    /* Convert specialization constants to function constant values */
+    MTLFunctionConstantValues* constantValues = [[MTLFunctionConstantValues alloc] init];
+    for (const auto& constant : constants)
+    {
+        /* Booleans are read as a single byte, which is the least significant byte of the 32-bit value on all Apple platforms */
+        [constantValues
+            setConstantValue:   &(constant.value)
+            type:               ToMTLDataType(constant.type)
+            atIndex:            static_cast<NSUInteger>(constant.id)
+        ];
+    }
+
+    /* Create specialized function with the same name as the native function */
+    NSError* error = nullptr;
+    id<MTLFunction> function = [library_ newFunctionWithName:[native_ name] constantValues:constantValues error:&error];
+    [constantValues release];
+
+    if (!function)
+    {
+        MTThrowIfCreateFailed(error, "MTLFunction");
+        throw std::runtime_error("failed to create specialized Metal shader function");
+    }
+
+    return function;
+}
+
 static ResourceType ToResourceType(MTLArgumentType type)
 {
     switch (type)
@@ -0,0 +1,109 @@
+/*
+ * MTShaderLibrary.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MT_SHADER_LIBRARY_H
+#define LLGL_MT_SHADER_LIBRARY_H
+
+
+#import <Metal/Metal.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <map>
+
+
+namespace LLGL
+{
+
+
+// Native MTLLibrary object that is compiled asynchronously and shared between all shaders with equal source and compile options.
+class MTShaderLibrary
+{
+
+    public:
+
+        // Starts compiling the specified MSL source with the completion-handler variant of newLibraryWithSource and returns immediately.
+        MTShaderLibrary(id<MTLDevice> device, NSString* source, MTLCompileOptions* options, std::uint64_t key = 0);
+        ~MTShaderLibrary();
+
+        MTShaderLibrary(const MTShaderLibrary&) = delete;
+        MTShaderLibrary& operator = (const MTShaderLibrary&) = delete;
+
+        // Blocks until the compilation has completed and returns the native MTLLibrary object, or nil if the compilation failed.
+        id<MTLLibrary> Wait();
+
+        // Returns the compilation error or warnings. Only valid after Wait() has returned.
+        inline NSError* GetError() const
+        {
+            return error_;
+        }
+
+        // Returns the key of this library within the MTShaderLibraryCache.
+        inline std::uint64_t GetKey() const
+        {
+            return key_;
+        }
+
+    private:
+
+        dispatch_group_t    group_      = nullptr;
+        id<MTLLibrary>      library_    = nil;
+        NSError*            error_      = nullptr;
+        std::uint64_t       key_        = 0;
+
+};
+
+/*
+Cache of shader libraries that are shared between all shaders with equal MSL source and compile options,
+so identical sources that are shared between pipelines are only compiled once. Entries are keyed by a FNV-1a hash of the source
+and are removed once the last shader that refers to it has been released (see SamplerCache for the same pattern).
+All functions are guarded by a mutex, so shaders can be created and released from multiple threads.
+*/
+class MTShaderLibraryCache
+{
+
+    public:
+
+        MTShaderLibraryCache() = default;
+
+        MTShaderLibraryCache(const MTShaderLibraryCache&) = delete;
+        MTShaderLibraryCache& operator = (const MTShaderLibraryCache&) = delete;
+
+        // Returns the shader library for the specified source and compile options, or starts compiling a new one.
+        std::shared_ptr<MTShaderLibrary> GetOrCreate(id<MTLDevice> device, NSString* source, MTLCompileOptions* options);
+
+        // Releases the specified reference to a shader library and removes it from the cache if no other shader refers to it.
+        void Release(std::shared_ptr<MTShaderLibrary>&& library);
+
+    private:
+
+        struct Entry
+        {
+            std::string                         source;
+            MTLLanguageVersion                  languageVersion;
+            BOOL                                fastMathEnabled;
+            std::shared_ptr<MTShaderLibrary>    library;
+        };
+
+    private:
+
+        std::map<std::uint64_t, Entry>  entries_;
+        std::mutex                      mutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
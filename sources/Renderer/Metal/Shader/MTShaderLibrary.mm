@@ -0,0 +1,143 @@
+/*
+ * MTShaderLibrary.mm
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MTShaderLibrary.h"
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+/*
+ * MTShaderLibrary class
+ */
+
+MTShaderLibrary::MTShaderLibrary(id<MTLDevice> device, NSString* source, MTLCompileOptions* options, std::uint64_t key) :
+    group_ { dispatch_group_create() },
+    key_   { key                     }
+{
+    /* Compile library on a background thread of the Metal framework; the group is left in the completion handler */
+    dispatch_group_enter(group_);
+
+    [device
+        newLibraryWithSource:   source
+        options:                options
+        completionHandler:      ^(id<MTLLibrary> library, NSError* error)
+        {
+            library_    = [library retain];
+            error_      = [error retain];
+            dispatch_group_leave(group_);
+        }
+    ];
+}
+
+MTShaderLibrary::~MTShaderLibrary()
+{
+    /* Completion handler must not outlive this object */
+    dispatch_group_wait(group_, DISPATCH_TIME_FOREVER);
+    dispatch_release(group_);
+
+    if (library_)
+        [library_ release];
+    if (error_)
+        [error_ release];
+}
+
+id<MTLLibrary> MTShaderLibrary::Wait()
+{
+    dispatch_group_wait(group_, DISPATCH_TIME_FOREVER);
+    return library_;
+}
+
+
+/*
+ * MTShaderLibraryCache class
+ */
+
+// FNV-1a hash over the MSL source and the compile options.
+static std::uint64_t HashShaderLibrarySource(const char* source, std::size_t length, MTLLanguageVersion languageVersion, BOOL fastMathEnabled)
+{
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+
+    auto HashBytes = [&hash](const void* data, std::size_t size)
+    {
+        auto bytes = reinterpret_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 0x100000001b3ull;
+        }
+    };
+
+    HashBytes(source, length);
+    HashBytes(&languageVersion, sizeof(languageVersion));
+    HashBytes(&fastMathEnabled, sizeof(fastMathEnabled));
+
+    return hash;
+}
+
+std::shared_ptr<MTShaderLibrary> MTShaderLibraryCache::GetOrCreate(id<MTLDevice> device, NSString* source, MTLCompileOptions* options)
+{
+    const char*         sourceUTF8      = [source UTF8String];
+    const std::size_t   sourceLength    = std::strlen(sourceUTF8);
+    const auto          languageVersion = [options languageVersion];
+    const BOOL          fastMathEnabled = [options fastMathEnabled];
+    const std::uint64_t key             = HashShaderLibrarySource(sourceUTF8, sourceLength, languageVersion, fastMathEnabled);
+
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    auto it = entries_.find(key);
+    if (it != entries_.end())
+    {
+        const Entry& entry = it->second;
+        if (entry.languageVersion == languageVersion &&
+            entry.fastMathEnabled == fastMathEnabled &&
+            entry.source.size()   == sourceLength    &&
+            std::memcmp(entry.source.data(), sourceUTF8, sourceLength) == 0)
+        {
+            return entry.library;
+        }
+
+        /* Don't share library on hash collision */
+        return std::make_shared<MTShaderLibrary>(device, source, options);
+    }
+
+    /* Start compiling new library */
+    Entry newEntry;
+    {
+        newEntry.source             = std::string(sourceUTF8, sourceLength);
+        newEntry.languageVersion    = languageVersion;
+        newEntry.fastMathEnabled    = fastMathEnabled;
+        newEntry.library            = std::make_shared<MTShaderLibrary>(device, source, options, key);
+    }
+    auto library = newEntry.library;
+    entries_.emplace(key, std::move(newEntry));
+
+    return library;
+}
+
+void MTShaderLibraryCache::Release(std::shared_ptr<MTShaderLibrary>&& library)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    if (library && library.use_count() == 2)
+    {
+        auto it = entries_.find(library->GetKey());
+        if (it != entries_.end() && it->second.library == library)
+            entries_.erase(it);
+    }
+
+    library.reset();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
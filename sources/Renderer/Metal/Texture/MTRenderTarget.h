@@ -59,13 +59,15 @@ class MTRenderTarget final : public RenderTarget
         MTLTextureDescriptor* CreateTextureDesc(
             id<MTLDevice>   device,
             MTLPixelFormat  pixelFormat,
-            NSUInteger      sampleCount = 1u
+            NSUInteger      sampleCount = 1u,
+            bool            transient   = false
         );
 
         id<MTLTexture> CreateRenderTargetTexture(
             id<MTLDevice>                   device,
             const AttachmentType            type,
-            id<MTLTexture>                  resolveTexture      = nil
+            id<MTLTexture>                  resolveTexture      = nil,
+            bool                            transient           = false
         );
 
     private:
@@ -153,7 +153,7 @@ void MTRenderTarget::CreateAttachment(
         if (renderPass_.GetSampleCount() > 1)
         {
             /* Create resolve texture if multi-sampling is enabled */
-            attachment.texture          = CreateRenderTargetTexture(device, desc.type, tex);
+            attachment.texture          = CreateRenderTargetTexture(device, desc.type, tex, desc.transient);
             attachment.resolveTexture   = tex;
         }
         else
@@ -165,7 +165,7 @@ void MTRenderTarget::CreateAttachment(
     else if (desc.type != AttachmentType::Color)
     {
         /* Create native texture for depth-stencil attachments */
-        attachment.texture = CreateRenderTargetTexture(device, desc.type);
+        attachment.texture = CreateRenderTargetTexture(device, desc.type, nil, desc.transient);
     }
     else
     {
@@ -184,6 +184,17 @@ void MTRenderTarget::CreateAttachment(
 
     if (attachment.storeAction == MTLStoreActionStore && attachment.resolveTexture != nil)
         attachment.storeAction = MTLStoreActionStoreAndMultisampleResolve;
+
+    /* Internal transient textures are never loaded or stored; only the multi-sampled content is resolved */
+    if (desc.transient && (desc.texture == nullptr || attachment.resolveTexture != nil))
+    {
+        if (attachment.loadAction == MTLLoadActionLoad)
+            attachment.loadAction = MTLLoadActionDontCare;
+        if (attachment.storeAction == MTLStoreActionStoreAndMultisampleResolve)
+            attachment.storeAction = MTLStoreActionMultisampleResolve;
+        else if (attachment.storeAction == MTLStoreActionStore)
+            attachment.storeAction = MTLStoreActionDontCare;
+    }
 }
 
 static MTLPixelFormat SelectPixelFormat(const AttachmentType type)
@@ -198,10 +209,19 @@ static MTLPixelFormat SelectPixelFormat(const AttachmentType type)
     return MTLPixelFormatInvalid;
 }
 
+// Returns true if the specified device supports memoryless textures, which is only the case for Apple GPUs.
+static bool SupportsMemorylessTextures(id<MTLDevice> device)
+{
+    if (@available(macOS 11.0, iOS 13.0, *))
+        return [device supportsFamily:MTLGPUFamilyApple1];
+    return false;
+}
+
 MTLTextureDescriptor* MTRenderTarget::CreateTextureDesc(
     id<MTLDevice>   device,
     MTLPixelFormat  pixelFormat,
-    NSUInteger      sampleCount)
+    NSUInteger      sampleCount,
+    bool            transient)
 {
     MTLTextureDescriptor* texDesc = [[MTLTextureDescriptor alloc] init];
     {
@@ -213,18 +233,28 @@ MTLTextureDescriptor* MTRenderTarget::CreateTextureDesc(
         texDesc.usage           = MTLTextureUsageRenderTarget;
         texDesc.resourceOptions = MTLResourceStorageModePrivate;
     }
+
+    /* Transient attachments only reside in tile memory */
+    if (transient && SupportsMemorylessTextures(device))
+    {
+        if (@available(macOS 11.0, iOS 10.0, *))
+            texDesc.resourceOptions = MTLResourceStorageModeMemoryless;
+    }
+
     return texDesc;
 }
 
 id<MTLTexture> MTRenderTarget::CreateRenderTargetTexture(
     id<MTLDevice>                   device,
     const AttachmentType            type,
-    id<MTLTexture>                  resolveTexture)
+    id<MTLTexture>                  resolveTexture,
+    bool                            transient)
 {
     auto texDesc = CreateTextureDesc(
         device,
         (resolveTexture != nil ? [resolveTexture pixelFormat] : SelectPixelFormat(type)),
-        renderPass_.GetSampleCount()
+        renderPass_.GetSampleCount(),
+        transient
     );
 
     id<MTLTexture> texture = [device newTextureWithDescriptor:texDesc];
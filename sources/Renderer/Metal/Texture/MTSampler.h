@@ -12,20 +12,25 @@
 #import <Metal/Metal.h>
 
 #include <LLGL/Sampler.h>
+#include "../../SamplerCache.h"
 
 
 namespace LLGL
 {
 
 
-class MTSampler final : public Sampler
+// Native MTLSamplerState object that is shared between all MTSampler instances with equal descriptors.
+class MTNativeSampler
 {
 
     public:
 
-        MTSampler(id<MTLDevice> device, const SamplerDescriptor& desc);
-        ~MTSampler();
-    
+        MTNativeSampler(id<MTLDevice> device, const SamplerDescriptor& desc);
+        ~MTNativeSampler();
+
+        MTNativeSampler(const MTNativeSampler&) = delete;
+        MTNativeSampler& operator = (const MTNativeSampler&) = delete;
+
         // Returns the native MTLSamplerState object.
         inline id<MTLSamplerState> GetNative() const
         {
@@ -38,6 +43,31 @@ class MTSampler final : public Sampler
 
 };
 
+using MTSamplerCache = SamplerCache<MTNativeSampler>;
+
+class MTSampler final : public Sampler
+{
+
+    public:
+
+        // Shares the native sampler state with all other samplers of the same descriptor in the specified cache.
+        MTSampler(id<MTLDevice> device, MTSamplerCache& samplerCache, const SamplerDescriptor& desc);
+        ~MTSampler();
+
+        // Returns the native MTLSamplerState object.
+        inline id<MTLSamplerState> GetNative() const
+        {
+            return native_->GetNative();
+        }
+
+    private:
+
+        MTSamplerCache&                     samplerCache_;
+        SamplerDescriptor                   desc_;
+        std::shared_ptr<MTNativeSampler>    native_;
+
+};
+
 
 } // /namespace LLGL
 
@@ -47,9 +47,18 @@ static void Convert(MTLSamplerDescriptor* dst, const SamplerDescriptor& src)
     #ifndef LLGL_OS_IOS
     dst.borderColor     = GetBorderColor(src.borderColor);
     #endif // /LLGL_OS_IOS
+    if (@available(macOS 10.13, iOS 11.0, *))
+    {
+        /* Allow sampler to be encoded into argument buffers of resource heaps */
+        dst.supportArgumentBuffers = YES;
+    }
 }
 
-MTSampler::MTSampler(id<MTLDevice> device, const SamplerDescriptor& desc)
+/*
+ * MTNativeSampler class
+ */
+
+MTNativeSampler::MTNativeSampler(id<MTLDevice> device, const SamplerDescriptor& desc)
 {
     MTLSamplerDescriptor* samplerDesc = [[MTLSamplerDescriptor alloc] init];
     Convert(samplerDesc, desc);
@@ -57,12 +66,35 @@ MTSampler::MTSampler(id<MTLDevice> device, const SamplerDescriptor& desc)
     [samplerDesc release];
 }
 
-MTSampler::~MTSampler()
+MTNativeSampler::~MTNativeSampler()
 {
     [native_ release];
 }
 
 
+/*
+ * MTSampler class
+ */
+
+MTSampler::MTSampler(id<MTLDevice> device, MTSamplerCache& samplerCache, const SamplerDescriptor& desc) :
+    samplerCache_ { samplerCache },
+    desc_         { desc         }
+{
+    native_ = samplerCache.GetOrCreate(
+        desc,
+        [device, &desc]()
+        {
+            return std::make_shared<MTNativeSampler>(device, desc);
+        }
+    );
+}
+
+MTSampler::~MTSampler()
+{
+    samplerCache_.Release(desc_, std::move(native_));
+}
+
+
 } // /namespace LLGL
 
 
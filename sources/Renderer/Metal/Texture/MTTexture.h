@@ -21,6 +21,8 @@ namespace LLGL
 struct SrcImageDescriptor;
 struct DstImageDescriptor;
 
+class MTMemoryManager;
+
 class MTTexture final : public Texture
 {
 
@@ -34,18 +36,31 @@ class MTTexture final : public Texture
 
     public:
 
-        MTTexture(id<MTLDevice> device, const TextureDescriptor& desc);
+        MTTexture(MTMemoryManager& memoryMngr, const TextureDescriptor& desc);
+
+        // Imports the specified native texture and retains it.
+        MTTexture(const TextureDescriptor& desc, id<MTLTexture> native);
+
         ~MTTexture();
 
         // Returns the region for the specified subresource.
         MTLRegion GetSubresourceRegion(NSUInteger mipLevel) const;
 
-        // Copies the source image data to the specified texture region; 'numMipLevel' must be 1.
-        void WriteRegion(const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc);
+        /*
+        Copies the source image data to the specified texture region; 'numMipLevel' must be 1.
+        Textures in private storage (e.g. sparse textures) are written with a blit command on the specified command queue.
+        */
+        void WriteRegion(const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc, id<MTLCommandQueue> cmdQueue = nil);
 
         // Copies the specified texture region to the destination image data; 'numMipLevel' must be 1.
         void ReadRegion(const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc);
 
+        // Queries the tiling properties of this texture. Returns false if this is not a sparse texture.
+        bool GetTiling(TextureTiling& outTiling) const;
+
+        // Maps or unmaps all tiles of this sparse texture within the specified region and blocks until the mappings have been updated.
+        void CommitTiles(id<MTLCommandQueue> cmdQueue, const TextureRegion& textureRegion, bool commit);
+
         // Creats a new MTLTexture object as subresource view from this texture.
         id<MTLTexture> CreateSubresourceView(const TextureSubresource& subresource);
 
@@ -55,9 +70,28 @@ class MTTexture final : public Texture
             return native_;
         }
 
+        // Returns true if this texture was created with MiscFlags::Aliasable.
+        inline bool IsAliasable() const
+        {
+            return isAliasable_;
+        }
+
+        // Returns true if this texture was created with MiscFlags::Sparse.
+        inline bool IsSparse() const
+        {
+            return isSparse_;
+        }
+
+    private:
+
+        // Returns the extent (in texels) of each sparse tile.
+        MTLSize GetSparseTileSize() const;
+
     private:
 
-        id<MTLTexture> native_ = nil;
+        id<MTLTexture>  native_         = nil;
+        bool            isAliasable_    = false;
+        bool            isSparse_       = false;
 
 };
 
@@ -7,10 +7,12 @@
 
 #include "MTTexture.h"
 #include "../MTTypes.h"
+#include "../MTMemoryManager.h"
 #include "../../TextureUtils.h"
 #include <LLGL/TextureFlags.h>
 #include <LLGL/ImageFlags.h>
 #include <algorithm>
+#include <stdexcept>
 
 
 namespace LLGL
@@ -43,7 +45,8 @@ static MTLResourceOptions GetResourceOptions(const TextureDescriptor& desc)
 {
     MTLResourceOptions opt = 0;
 
-    if (IsDepthStencilFormat(desc.format))
+    /* Aliasable and sparse textures are never accessed by the CPU directly, so they can always be allocated from private heaps */
+    if (IsDepthStencilFormat(desc.format) || (desc.miscFlags & (MiscFlags::Aliasable | MiscFlags::Sparse)) != 0)
         opt |= MTLResourceStorageModePrivate;
     #ifndef LLGL_OS_IOS
     else
@@ -67,17 +70,65 @@ static void Convert(MTLTextureDescriptor* dst, const TextureDescriptor& src)
     dst.resourceOptions     = GetResourceOptions(src);
 }
 
-MTTexture::MTTexture(id<MTLDevice> device, const TextureDescriptor& desc) :
-    Texture { desc.type, desc.bindFlags }
+// Copies the tightly packed source image into the destination image with its row and layer strides.
+static void CopyToStridedImage(const DstImageDescriptor& dstImageDesc, const Extent3D& extent, std::uint32_t numLayers, const void* srcData)
+{
+    const std::size_t rowSize           = GetMemoryFootprint(dstImageDesc.format, dstImageDesc.dataType, extent.width);
+    const std::size_t dstRowStride      = (dstImageDesc.rowStride != 0 ? dstImageDesc.rowStride : rowSize);
+    const std::size_t dstLayerStride    = (dstImageDesc.layerStride != 0 ? dstImageDesc.layerStride : dstRowStride * extent.height);
+    const std::size_t numSlices         = static_cast<std::size_t>(extent.depth) * numLayers;
+
+    auto src = reinterpret_cast<const std::int8_t*>(srcData);
+    auto dst = reinterpret_cast<std::int8_t*>(dstImageDesc.data);
+
+    for (std::size_t slice = 0; slice < numSlices; ++slice)
+    {
+        for (std::uint32_t row = 0; row < extent.height; ++row)
+        {
+            const std::size_t dstOffset = slice * dstLayerStride + row * dstRowStride;
+            if (dstOffset + rowSize > dstImageDesc.dataSize)
+                return;
+            ::memcpy(dst + dstOffset, src, rowSize);
+            src += rowSize;
+        }
+    }
+}
+
+MTTexture::MTTexture(MTMemoryManager& memoryMngr, const TextureDescriptor& desc) :
+    Texture      { desc.type, desc.bindFlags                        },
+    isAliasable_ { ((desc.miscFlags & MiscFlags::Aliasable) != 0)   },
+    isSparse_    { ((desc.miscFlags & MiscFlags::Sparse) != 0)      }
 {
     MTLTextureDescriptor* texDesc = [[MTLTextureDescriptor alloc] init];
     Convert(texDesc, desc);
-    native_ = [device newTextureWithDescriptor:texDesc];
+    if (isSparse_)
+    {
+        native_ = memoryMngr.NewSparseTexture(texDesc);
+        if (native_ == nil)
+        {
+            [texDesc release];
+            throw std::runtime_error("failed to create Metal sparse texture");
+        }
+    }
+    else
+        native_ = memoryMngr.NewTexture(texDesc);
     [texDesc release];
 }
 
+MTTexture::MTTexture(const TextureDescriptor& desc, id<MTLTexture> native) :
+    Texture { desc.type, desc.bindFlags },
+    native_ { [native retain]           }
+{
+}
+
 MTTexture::~MTTexture()
 {
+    /*
+    Command buffers that are still in flight retain this texture, so its memory would only be reused after they have completed.
+    Making it aliasable allows the heap to hand out its memory to the next texture right away.
+    */
+    if (isAliasable_ && [native_ heap] != nil)
+        [native_ makeAliasable];
     [native_ release];
 }
 
@@ -150,7 +201,7 @@ Format MTTexture::GetFormat() const
     return MTTypes::ToFormat([native_ pixelFormat]);
 }
 
-void MTTexture::WriteRegion(const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
+void MTTexture::WriteRegion(const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc, id<MTLCommandQueue> cmdQueue)
 {
     /* Convert region to MTLRegion */
     MTLRegion region;
@@ -160,22 +211,66 @@ void MTTexture::WriteRegion(const TextureRegion& textureRegion, const SrcImageDe
     /* Get dimensions */
     auto        format          = MTTypes::ToFormat([native_ pixelFormat]);
     const auto& formatAttribs   = GetFormatAttribs(format);
-    const auto  layout          = CalcSubresourceLayout(format, textureRegion.extent);
+    auto        layout          = CalcSubresourceLayout(format, textureRegion.extent);
     auto        imageData       = imageDesc.data;
 
     /* Check if image data must be converted */
     ByteBuffer intermediateData;
 
-    if (formatAttribs.bitSize > 0 && (formatAttribs.flags & FormatFlags::IsCompressed) == 0)
+    if (formatAttribs.bitSize > 0 && (formatAttribs.flags & FormatFlags::IsCompressed) == 0 &&
+        (formatAttribs.format != imageDesc.format || formatAttribs.dataType != imageDesc.dataType))
     {
-        /* Convert image format (will be null if no conversion is necessary) */
-        intermediateData = ConvertImageBuffer(imageDesc, formatAttribs.format, formatAttribs.dataType, /*cfg.threadCount*/0);
+        /* Repack strided image data, then convert image format */
+        SrcImageDescriptor packedImageDesc;
+        ByteBuffer packedData = PackStridedImage(imageDesc, textureRegion.extent, packedImageDesc);
+        intermediateData = ConvertImageBuffer(packedImageDesc, formatAttribs.format, formatAttribs.dataType, /*cfg.threadCount*/0);
         if (intermediateData)
         {
             /* User converted tempoary buffer as image source */
             imageData = intermediateData.get();
         }
     }
+    else
+    {
+        /* Pass row and layer strides of the source image as bytes per row and image */
+        layout = CalcSubresourceLayout(format, textureRegion.extent, imageDesc.rowStride, imageDesc.layerStride);
+    }
+
+    /* Textures in private storage cannot be written by the CPU, so copy the image data into a temporary buffer and blit it into the texture */
+    if ([native_ storageMode] == MTLStorageModePrivate && cmdQueue != nil)
+    {
+        const auto numArrayLayers = static_cast<NSUInteger>(textureRegion.subresource.numArrayLayers);
+        id<MTLBuffer> srcBuffer = [[native_ device]
+            newBufferWithBytes: imageData
+            length:             static_cast<NSUInteger>(layout.layerStride) * (numArrayLayers - 1) + static_cast<NSUInteger>(layout.dataSize)
+            options:            MTLResourceStorageModeShared
+        ];
+
+        id<MTLCommandBuffer> cmdBuffer = [cmdQueue commandBuffer];
+        {
+            id<MTLBlitCommandEncoder> blitCmdEncoder = [cmdBuffer blitCommandEncoder];
+            for (NSUInteger arrayLayer = 0; arrayLayer < numArrayLayers; ++arrayLayer)
+            {
+                [blitCmdEncoder
+                    copyFromBuffer:         srcBuffer
+                    sourceOffset:           static_cast<NSUInteger>(layout.layerStride) * arrayLayer
+                    sourceBytesPerRow:      static_cast<NSUInteger>(layout.rowStride)
+                    sourceBytesPerImage:    static_cast<NSUInteger>(layout.layerStride)
+                    sourceSize:             region.size
+                    toTexture:              native_
+                    destinationSlice:       (textureRegion.subresource.baseArrayLayer + arrayLayer)
+                    destinationLevel:       static_cast<NSUInteger>(textureRegion.subresource.baseMipLevel)
+                    destinationOrigin:      region.origin
+                ];
+            }
+            [blitCmdEncoder endEncoding];
+        }
+        [cmdBuffer commit];
+        [cmdBuffer waitUntilCompleted];
+
+        [srcBuffer release];
+        return;
+    }
 
     /* Replace region of native texture with source image data */
     auto byteAlignedData = reinterpret_cast<const std::int8_t*>(imageData);
@@ -194,6 +289,87 @@ void MTTexture::WriteRegion(const TextureRegion& textureRegion, const SrcImageDe
     }
 }
 
+bool MTTexture::GetTiling(TextureTiling& outTiling) const
+{
+    if (!isSparse_)
+        return false;
+
+    if (@available(macOS 11.0, iOS 13.0, *))
+    {
+        const auto tileSize         = GetSparseTileSize();
+        const auto numMipLevels     = static_cast<std::uint32_t>([native_ mipmapLevelCount]);
+
+        outTiling.tileExtent            = Extent3D{ static_cast<std::uint32_t>(tileSize.width), static_cast<std::uint32_t>(tileSize.height), static_cast<std::uint32_t>(tileSize.depth) };
+        outTiling.tileSize              = static_cast<std::uint64_t>([[native_ device] sparseTileSizeInBytes]);
+        outTiling.firstPackedMipLevel   = std::min(static_cast<std::uint32_t>([native_ firstMipmapInTail]), numMipLevels);
+        outTiling.numMipLevels          = numMipLevels;
+
+        return true;
+    }
+
+    return false;
+}
+
+void MTTexture::CommitTiles(id<MTLCommandQueue> cmdQueue, const TextureRegion& textureRegion, bool commit)
+{
+    if (!isSparse_)
+        return;
+
+    if (@available(macOS 11.0, iOS 13.0, *))
+    {
+        const auto mipLevel         = static_cast<NSUInteger>(textureRegion.subresource.baseMipLevel);
+        const auto numArrayLayers   = static_cast<NSUInteger>(textureRegion.subresource.numArrayLayers);
+        const auto mode             = (commit ? MTLSparseTextureMappingModeMap : MTLSparseTextureMappingModeUnmap);
+
+        if (mipLevel >= [native_ mipmapLevelCount])
+            return;
+
+        /* Convert texel region into tile region; the MIP-map tail is always mapped by the first tile of its first MIP-map level */
+        MTLRegion tileRegion = MTLRegionMake2D(0, 0, 1, 1);
+        NSUInteger tileMipLevel = mipLevel;
+
+        if (mipLevel >= [native_ firstMipmapInTail])
+            tileMipLevel = [native_ firstMipmapInTail];
+        else
+        {
+            const auto tileSize     = GetSparseTileSize();
+            const auto mipExtent    = GetMipExtent(textureRegion.subresource.baseMipLevel);
+
+            const auto beginX       = static_cast<NSUInteger>(std::max(0, textureRegion.offset.x));
+            const auto beginY       = static_cast<NSUInteger>(std::max(0, textureRegion.offset.y));
+            const auto endX         = std::min(beginX + textureRegion.extent.width,  static_cast<NSUInteger>(mipExtent.width));
+            const auto endY         = std::min(beginY + textureRegion.extent.height, static_cast<NSUInteger>(mipExtent.height));
+
+            if (endX <= beginX || endY <= beginY)
+                return;
+
+            tileRegion.origin.x     = beginX / tileSize.width;
+            tileRegion.origin.y     = beginY / tileSize.height;
+            tileRegion.size.width   = (endX + tileSize.width  - 1) / tileSize.width  - tileRegion.origin.x;
+            tileRegion.size.height  = (endY + tileSize.height - 1) / tileSize.height - tileRegion.origin.y;
+        }
+
+        /* Update tile mappings with a resource state encoder and wait until they have been updated */
+        id<MTLCommandBuffer> cmdBuffer = [cmdQueue commandBuffer];
+        {
+            id<MTLResourceStateCommandEncoder> resourceStateEncoder = [cmdBuffer resourceStateCommandEncoder];
+            for (NSUInteger arrayLayer = 0; arrayLayer < numArrayLayers; ++arrayLayer)
+            {
+                [resourceStateEncoder
+                    updateTextureMapping:   native_
+                    mode:                   mode
+                    region:                 tileRegion
+                    mipLevel:               tileMipLevel
+                    slice:                  (textureRegion.subresource.baseArrayLayer + arrayLayer)
+                ];
+            }
+            [resourceStateEncoder endEncoding];
+        }
+        [cmdBuffer commit];
+        [cmdBuffer waitUntilCompleted];
+    }
+}
+
 void MTTexture::ReadRegion(const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc)
 {
     /* Convert region to MTLRegion */
@@ -231,26 +407,30 @@ void MTTexture::ReadRegion(const TextureRegion& textureRegion, const DstImageDes
             );
 
             /* Copy temporary data into output buffer */
-            ::memcpy(imageDesc.data, tempData.get(), imageDesc.dataSize);
+            if (imageDesc.rowStride != 0 || imageDesc.layerStride != 0)
+                CopyToStridedImage(imageDesc, textureRegion.extent, 1, tempData.get());
+            else
+                ::memcpy(imageDesc.data, tempData.get(), imageDesc.dataSize);
         }
     }
     else
     {
-        /* Copy texture data directly into outut buffer */
-        auto dstImageData = reinterpret_cast<std::int8_t*>(imageDesc.data);
+        /* Copy texture data directly into outut buffer with the row and layer strides of the destination image */
+        const auto  dstLayout       = CalcSubresourceLayout(format, textureRegion.extent, imageDesc.rowStride, imageDesc.layerStride);
+        auto        dstImageData    = reinterpret_cast<std::int8_t*>(imageDesc.data);
 
         for (std::uint32_t arrayLayer = 0; arrayLayer < textureRegion.subresource.numArrayLayers; ++arrayLayer)
         {
             /* Copy bytes into intermediate data, then convert its format */
             [native_
                 getBytes:       dstImageData
-                bytesPerRow:    static_cast<NSUInteger>(layout.rowStride)
-                bytesPerImage:  static_cast<NSUInteger>(layout.layerStride)
+                bytesPerRow:    static_cast<NSUInteger>(dstLayout.rowStride)
+                bytesPerImage:  static_cast<NSUInteger>(dstLayout.layerStride)
                 fromRegion:     region
                 mipmapLevel:    static_cast<NSUInteger>(textureRegion.subresource.baseMipLevel)
                 slice:          static_cast<NSUInteger>(textureRegion.subresource.baseArrayLayer + arrayLayer)
             ];
-            dstImageData += layout.layerStride;
+            dstImageData += dstLayout.layerStride;
         }
     }
 }
@@ -271,6 +451,24 @@ id<MTLTexture> MTTexture::CreateSubresourceView(const TextureSubresource& subres
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+MTLSize MTTexture::GetSparseTileSize() const
+{
+    if (@available(macOS 11.0, iOS 13.0, *))
+    {
+        return [[native_ device]
+            sparseTileSizeWithTextureType:  [native_ textureType]
+            pixelFormat:                    [native_ pixelFormat]
+            sampleCount:                    [native_ sampleCount]
+        ];
+    }
+    return MTLSizeMake(1, 1, 1);
+}
+
+
 } // /namespace LLGL
 
 
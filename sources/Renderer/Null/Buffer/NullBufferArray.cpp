@@ -10,6 +10,8 @@
 #include "../../CheckedCast.h"
 #include "../../BufferUtils.h"
 #include <LLGL/Misc/ForRange.h>
+#include <stdexcept>
+#include <string>
 
 
 namespace LLGL
@@ -25,9 +27,31 @@ static std::vector<NullBuffer*> GetNullBuffers(std::uint32_t numBuffers, Buffer*
     return buffers;
 }
 
-NullBufferArray::NullBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray) :
-    BufferArray { GetCombinedBindFlags(numBuffers, bufferArray) },
-    buffers     { GetNullBuffers(numBuffers, bufferArray)       }
+static std::vector<std::uint64_t> GetNullBufferOffsets(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets)
+{
+    std::vector<std::uint64_t> bufferOffsets(numBuffers, 0);
+    if (offsets != nullptr)
+    {
+        for_range(i, numBuffers)
+        {
+            const std::uint64_t bufferSize = LLGL_CAST(NullBuffer*, bufferArray[i])->desc.size;
+            if (offsets[i] > bufferSize)
+            {
+                throw std::invalid_argument(
+                    "offset (" + std::to_string(offsets[i]) + ") of buffer [" + std::to_string(i) +
+                    "] in buffer array exceeds buffer size (" + std::to_string(bufferSize) + ")"
+                );
+            }
+            bufferOffsets[i] = offsets[i];
+        }
+    }
+    return bufferOffsets;
+}
+
+NullBufferArray::NullBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets) :
+    BufferArray { GetCombinedBindFlags(numBuffers, bufferArray)             },
+    buffers     { GetNullBuffers(numBuffers, bufferArray)                   },
+    offsets     { GetNullBufferOffsets(numBuffers, bufferArray, offsets)    }
 {
 }
 
@@ -25,11 +25,12 @@ class NullBufferArray final : public BufferArray
 
     public:
 
-        NullBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray);
+        NullBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets = nullptr);
 
     public:
 
-        const std::vector<NullBuffer*> buffers;
+        const std::vector<NullBuffer*>      buffers;
+        const std::vector<std::uint64_t>    offsets; // Byte offsets of each buffer in the array.
 
 };
 
@@ -20,6 +20,10 @@ namespace LLGL
 
 class NullBuffer;
 class NullTexture;
+class NullResourceHeap;
+class NullRenderPass;
+class NullPipelineState;
+class RenderTarget;
 
 
 struct NullCmdBufferWrite
@@ -58,6 +62,34 @@ struct NullCmdGenerateMips
     std::uint32_t   numMipLevels;
 };
 
+struct NullCmdSetResourceHeap
+{
+    const NullResourceHeap* resourceHeap;
+    std::uint32_t           descriptorSet;
+};
+
+struct NullCmdSetResource
+{
+    const Resource* resource;
+    std::uint32_t   slot;
+    long            bindFlags;
+    long            stageFlags;
+};
+
+struct NullCmdBeginRenderPass
+{
+    const RenderTarget*     renderTarget;
+    const NullRenderPass*   renderPass;
+    std::uint32_t           numClearValues;
+};
+
+//struct NullCmdEndRenderPass {};
+
+struct NullCmdSetPipelineState
+{
+    const NullPipelineState* pipelineState;
+};
+
 //TODO...
 
 struct NullCmdDraw
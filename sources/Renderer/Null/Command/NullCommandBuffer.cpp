@@ -18,19 +18,22 @@
 #include "../RenderState/NullQueryHeap.h"
 #include "../RenderState/NullPipelineState.h"
 #include "../RenderState/NullResourceHeap.h"
+#include "../RenderState/NullRenderPass.h"
 #include "../Texture/NullTexture.h"
 #include "../Texture/NullRenderTarget.h"
 
 #include <LLGL/RenderingDebugger.h>
 #include <LLGL/IndirectArguments.h>
+#include <algorithm>
 
 
 namespace LLGL
 {
 
 
-NullCommandBuffer::NullCommandBuffer(const CommandBufferDescriptor& desc) :
-    desc { desc }
+NullCommandBuffer::NullCommandBuffer(const CommandBufferDescriptor& desc, NullCommandProfiler* profiler) :
+    desc      { desc     },
+    profiler_ { profiler }
 {
 }
 
@@ -38,7 +41,10 @@ NullCommandBuffer::NullCommandBuffer(const CommandBufferDescriptor& desc) :
 
 void NullCommandBuffer::Begin()
 {
+    /* Rewind virtual command buffer and reserve a single chunk for the largest recording so far */
     buffer_.Clear();
+    buffer_.Reserve(buffer_.HighWaterMark());
+    patchSlots_.clear();
 }
 
 void NullCommandBuffer::End()
@@ -298,8 +304,23 @@ void NullCommandBuffer::SetResourceHeap(
     std::uint32_t           descriptorSet,
     const PipelineBindPoint bindPoint)
 {
-    //auto& resourceHeapNull = LLGL_CAST(NullResourceHeap&, resourceHeap);
-    //todo
+    auto& resourceHeapNull = LLGL_CAST(NullResourceHeap&, resourceHeap);
+    auto cmd = AllocCommand<NullCmdSetResourceHeap>(NullOpcodeSetResourceHeap);
+    {
+        cmd->resourceHeap   = &resourceHeapNull;
+        cmd->descriptorSet  = descriptorSet;
+    }
+}
+
+void NullCommandBuffer::SetResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           descriptorSet,
+    std::uint32_t           /*numDynamicOffsets*/,
+    const std::uint32_t*    /*dynamicOffsets*/,
+    const PipelineBindPoint bindPoint)
+{
+    /* Dynamic offsets are not supported by this renderer (see BindingFlags::DynamicOffset) */
+    SetResourceHeap(resourceHeap, descriptorSet, bindPoint);
 }
 
 void NullCommandBuffer::SetResource(
@@ -308,7 +329,13 @@ void NullCommandBuffer::SetResource(
     long            bindFlags,
     long            stageFlags)
 {
-    //todo
+    auto cmd = AllocCommand<NullCmdSetResource>(NullOpcodeSetResource);
+    {
+        cmd->resource   = &resource;
+        cmd->slot       = slot;
+        cmd->bindFlags  = bindFlags;
+        cmd->stageFlags = stageFlags;
+    }
 }
 
 void NullCommandBuffer::ResetResourceSlots(
@@ -329,21 +356,17 @@ void NullCommandBuffer::BeginRenderPass(
     std::uint32_t       numClearValues,
     const ClearValue*   clearValues)
 {
-    if (LLGL::IsInstanceOf<SwapChain>(renderTarget))
+    auto cmd = AllocCommand<NullCmdBeginRenderPass>(NullOpcodeBeginRenderPass);
     {
-        //auto& swapChainNull = LLGL_CAST(NullSwapChain&, renderTarget);
-        //todo
-    }
-    else
-    {
-        //auto& renderTargetNull = LLGL_CAST(NullRenderTarget&, renderTarget);
-        //todo
+        cmd->renderTarget   = &renderTarget;
+        cmd->renderPass     = LLGL_CAST(const NullRenderPass*, renderPass);
+        cmd->numClearValues = numClearValues;
     }
 }
 
 void NullCommandBuffer::EndRenderPass()
 {
-    //todo
+    AllocOpcode(NullOpcodeEndRenderPass);
 }
 
 void NullCommandBuffer::Clear(long flags, const ClearValue& clearValue)
@@ -360,8 +383,11 @@ void NullCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const Att
 
 void NullCommandBuffer::SetPipelineState(PipelineState& pipelineState)
 {
-    //auto& pipelineStateNull = LLGL_CAST(NullPipelineState&, pipelineState);
-    //todo
+    auto& pipelineStateNull = LLGL_CAST(NullPipelineState&, pipelineState);
+    auto cmd = AllocCommand<NullCmdSetPipelineState>(NullOpcodeSetPipelineState);
+    {
+        cmd->pipelineState = &pipelineStateNull;
+    }
 }
 
 void NullCommandBuffer::SetBlendFactor(const ColorRGBAf& color)
@@ -571,6 +597,61 @@ void NullCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset
     }
 }
 
+// Returns the number of draw commands from the specified count buffer, clamped to the specified maximum.
+static std::uint32_t ReadIndirectCount(Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands)
+{
+    auto& countBufferNull = LLGL_CAST(NullBuffer&, countBuffer);
+    std::uint32_t numCommands = 0;
+    countBufferNull.Read(countOffset, &numCommands, sizeof(numCommands));
+    return std::min(numCommands, maxNumCommands);
+}
+
+void NullCommandBuffer::DrawIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride)
+{
+    DrawIndirect(buffer, offset, ReadIndirectCount(countBuffer, countOffset, maxNumCommands), stride);
+}
+
+void NullCommandBuffer::DrawIndexedIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride)
+{
+    DrawIndexedIndirect(buffer, offset, ReadIndirectCount(countBuffer, countOffset, maxNumCommands), stride);
+}
+
+std::uint32_t NullCommandBuffer::DrawPatchable(const DrawIndirectArguments& args)
+{
+    const auto slot = static_cast<std::uint32_t>(patchSlots_.size());
+    patchSlots_.push_back(buffer_.Size());
+    AllocDrawCommand(args);
+    return slot;
+}
+
+std::uint32_t NullCommandBuffer::DrawIndexedPatchable(const DrawIndexedIndirectArguments& args)
+{
+    const auto slot = static_cast<std::uint32_t>(patchSlots_.size());
+    patchSlots_.push_back(buffer_.Size());
+    AllocDrawIndexedCommand(args);
+    return slot;
+}
+
+bool NullCommandBuffer::PatchDraw(std::uint32_t slot, const DrawIndirectArguments& args)
+{
+    if (auto cmd = GetPatchCommand<NullCmdDraw>(slot, NullOpcodeDraw))
+    {
+        cmd->args = args;
+        return true;
+    }
+    return false;
+}
+
+bool NullCommandBuffer::PatchDrawIndexed(std::uint32_t slot, const DrawIndexedIndirectArguments& args)
+{
+    if (auto cmd = GetPatchCommand<NullCmdDrawIndexed>(slot, NullOpcodeDrawIndexed))
+    {
+        cmd->args = args;
+        return true;
+    }
+    return false;
+}
+
 /* ----- Compute ----- */
 
 void NullCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
@@ -613,7 +694,7 @@ void NullCommandBuffer::SetGraphicsAPIDependentState(const void* stateDesc, std:
 
 void NullCommandBuffer::ExecuteVirtualCommands()
 {
-    ExecuteNullVirtualCommandBuffer(buffer_);
+    ExecuteNullVirtualCommandBuffer(buffer_, profiler_);
     if ((desc.flags & CommandBufferFlags::MultiSubmit) == 0)
         buffer_.Clear();
 }
@@ -657,6 +738,20 @@ void NullCommandBuffer::AllocDrawIndexedCommand(const DrawIndexedIndirectArgumen
     }
 }
 
+template <typename TCommand>
+TCommand* NullCommandBuffer::GetPatchCommand(std::uint32_t slot, const NullOpcode opcode)
+{
+    if (slot < patchSlots_.size())
+    {
+        if (auto data = buffer_.DataAt(patchSlots_[slot]))
+        {
+            if (*reinterpret_cast<const NullOpcode*>(data) == opcode)
+                return reinterpret_cast<TCommand*>(data + sizeof(NullOpcode));
+        }
+    }
+    return nullptr;
+}
+
 
 } // /namespace LLGL
 
@@ -13,6 +13,7 @@
 #include <LLGL/Container/SmallVector.h>
 #include "NullCommandOpcode.h"
 #include "../../VirtualCommandBuffer.h"
+#include <vector>
 
 
 namespace LLGL
@@ -20,8 +21,9 @@ namespace LLGL
 
 
 class NullBuffer;
+class NullCommandProfiler;
 
-using NullVirtualCommandBuffer = VirtualCommandBuffer<NullOpcode>;
+using NullVirtualCommandBuffer = VirtualCommandBuffer<NullOpcode, DefaultBufferGrowPolicy, PooledChunkAllocPolicy>;
 
 class NullCommandBuffer final : public CommandBuffer
 {
@@ -30,7 +32,7 @@ class NullCommandBuffer final : public CommandBuffer
 
         /* ----- Common ----- */
 
-        NullCommandBuffer(const CommandBufferDescriptor& desc);
+        NullCommandBuffer(const CommandBufferDescriptor& desc, NullCommandProfiler* profiler = nullptr);
 
         /* ----- Encoding ----- */
 
@@ -116,6 +118,14 @@ class NullCommandBuffer final : public CommandBuffer
             const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined
         ) override;
 
+        void SetResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           descriptorSet,
+            std::uint32_t           numDynamicOffsets,
+            const std::uint32_t*    dynamicOffsets,
+            const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined
+        ) override;
+
         void SetResource(
             Resource&       resource,
             std::uint32_t   slot,
@@ -197,6 +207,15 @@ class NullCommandBuffer final : public CommandBuffer
         void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset) override;
         void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
 
+        void DrawIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride) override;
+        void DrawIndexedIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride) override;
+
+        std::uint32_t DrawPatchable(const DrawIndirectArguments& args) override;
+        std::uint32_t DrawIndexedPatchable(const DrawIndexedIndirectArguments& args) override;
+
+        bool PatchDraw(std::uint32_t slot, const DrawIndirectArguments& args) override;
+        bool PatchDrawIndexed(std::uint32_t slot, const DrawIndexedIndirectArguments& args) override;
+
         /* ----- Compute ----- */
 
         void Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ) override;
@@ -244,10 +263,16 @@ class NullCommandBuffer final : public CommandBuffer
         void AllocDrawCommand(const DrawIndirectArguments& args);
         void AllocDrawIndexedCommand(const DrawIndexedIndirectArguments& args);
 
+        // Returns the command of the specified patch slot if it has been recorded with the specified opcode, or null otherwise.
+        template <typename TCommand>
+        TCommand* GetPatchCommand(std::uint32_t slot, const NullOpcode opcode);
+
     private:
 
         NullVirtualCommandBuffer    buffer_;
         RenderState                 renderState_;
+        std::vector<std::size_t>    patchSlots_;                // Offsets of patchable draw commands within the virtual command buffer
+        NullCommandProfiler*        profiler_       = nullptr;  // Profiler for the benchmark mode, or null if disabled
 
 };
 
@@ -6,6 +6,7 @@
  */
 
 #include "NullCommandExecutor.h"
+#include "NullCommandProfiler.h"
 #include "NullCommand.h"
 
 #include "../Texture/NullTexture.h"
@@ -19,12 +20,78 @@
 #include "../RenderState/NullRenderPass.h"
 #include "../RenderState/NullQueryHeap.h"
 
+#include <LLGL/Container/SmallVector.h>
+#include <algorithm>
+
 
 namespace LLGL
 {
 
 
-static std::size_t ExecuteNullCommand(const NullOpcode opcode, const void* pc)
+// Flags for the states that must be flushed before the next draw command.
+enum NullDirtyBits
+{
+    NullDirtyPipelineState  = (1 << 0),
+    NullDirtyResources      = (1 << 1),
+    NullDirtyVertexBuffers  = (1 << 2),
+    NullDirtyIndexBuffer    = (1 << 3),
+};
+
+// Execution state that is tracked across all commands of a virtual command buffer, the way a hardware backend tracks its bindings.
+struct NullExecutionState
+{
+    const RenderTarget*             renderTarget        = nullptr;
+    const NullPipelineState*        pipelineState       = nullptr;
+    const NullResourceHeap*         resourceHeap        = nullptr;
+    std::uint32_t                   descriptorSet       = 0;
+    SmallVector<const Resource*>    resources;                          // Bound resources per slot
+    SmallVector<const NullBuffer*>  vertexBuffers;
+    const NullBuffer*               indexBuffer         = nullptr;
+    Format                          indexBufferFormat   = Format::Undefined;
+    std::uint64_t                   indexBufferOffset   = 0;
+    int                             dirtyBits           = 0;
+    std::uint32_t                   debugGroupDepth     = 0;
+};
+
+static void BindVertexBuffers(NullExecutionState& state, const NullBuffer* const * vertexBuffers, std::size_t numVertexBuffers)
+{
+    if (state.vertexBuffers.size() != numVertexBuffers || !std::equal(vertexBuffers, vertexBuffers + numVertexBuffers, state.vertexBuffers.begin()))
+    {
+        state.vertexBuffers = SmallVector<const NullBuffer*>(vertexBuffers, vertexBuffers + numVertexBuffers);
+        state.dirtyBits |= NullDirtyVertexBuffers;
+    }
+}
+
+static void BindIndexBuffer(NullExecutionState& state, const NullBuffer* indexBuffer, Format format, std::uint64_t offset)
+{
+    if (state.indexBuffer != indexBuffer || state.indexBufferFormat != format || state.indexBufferOffset != offset)
+    {
+        state.indexBuffer       = indexBuffer;
+        state.indexBufferFormat = format;
+        state.indexBufferOffset = offset;
+        state.dirtyBits |= NullDirtyIndexBuffer;
+    }
+}
+
+// Returns true if the current state is complete for a draw command and flushes all dirty states.
+static bool FlushDrawState(NullExecutionState& state)
+{
+    if (state.renderTarget == nullptr || state.pipelineState == nullptr)
+        return false;
+    state.dirtyBits = 0;
+    return true;
+}
+
+static bool IsIndexRangeValid(const NullExecutionState& state, const DrawIndexedIndirectArguments& args)
+{
+    if (state.indexBuffer == nullptr)
+        return false;
+    const std::uint64_t indexSize   = GetFormatAttribs(state.indexBufferFormat).bitSize / 8;
+    const std::uint64_t indexEnd    = state.indexBufferOffset + (static_cast<std::uint64_t>(args.firstIndex) + args.numIndices) * indexSize;
+    return (indexSize > 0 && indexEnd <= state.indexBuffer->desc.size);
+}
+
+static std::size_t ExecuteNullCommand(const NullOpcode opcode, const void* pc, NullExecutionState& state)
 {
     switch (opcode)
     {
@@ -47,28 +114,77 @@ static std::size_t ExecuteNullCommand(const NullOpcode opcode, const void* pc)
             cmd->texture->GenerateMips(&subresource);
             return sizeof(*cmd);
         }
+        case NullOpcodeSetResourceHeap:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetResourceHeap*>(pc);
+            if (state.resourceHeap != cmd->resourceHeap || state.descriptorSet != cmd->descriptorSet)
+            {
+                state.resourceHeap  = cmd->resourceHeap;
+                state.descriptorSet = cmd->descriptorSet;
+                state.dirtyBits |= NullDirtyResources;
+            }
+            return sizeof(*cmd);
+        }
+        case NullOpcodeSetResource:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetResource*>(pc);
+            if (cmd->slot >= state.resources.size())
+                state.resources.resize(cmd->slot + 1, nullptr);
+            if (state.resources[cmd->slot] != cmd->resource)
+            {
+                state.resources[cmd->slot] = cmd->resource;
+                state.dirtyBits |= NullDirtyResources;
+            }
+            return sizeof(*cmd);
+        }
+        case NullOpcodeBeginRenderPass:
+        {
+            auto cmd = reinterpret_cast<const NullCmdBeginRenderPass*>(pc);
+            state.renderTarget = cmd->renderTarget;
+            return sizeof(*cmd);
+        }
+        case NullOpcodeEndRenderPass:
+        {
+            state.renderTarget = nullptr;
+            return 0;
+        }
+        case NullOpcodeSetPipelineState:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetPipelineState*>(pc);
+            if (state.pipelineState != cmd->pipelineState)
+            {
+                state.pipelineState = cmd->pipelineState;
+                state.dirtyBits |= NullDirtyPipelineState;
+            }
+            return sizeof(*cmd);
+        }
         //TODO...
         case NullOpcodeDraw:
         {
             auto cmd = reinterpret_cast<const NullCmdDraw*>(pc);
-            //TODO
+            BindVertexBuffers(state, reinterpret_cast<const NullBuffer* const *>(cmd + 1), cmd->numVertexBuffers);
+            FlushDrawState(state);
             return (sizeof(*cmd) + cmd->numVertexBuffers * sizeof(const NullBuffer*));
         }
         case NullOpcodeDrawIndexed:
         {
             auto cmd = reinterpret_cast<const NullCmdDrawIndexed*>(pc);
-            //TODO
+            BindVertexBuffers(state, reinterpret_cast<const NullBuffer* const *>(cmd + 1), cmd->numVertexBuffers);
+            BindIndexBuffer(state, cmd->indexBuffer, cmd->indexBufferFormat, cmd->indexBufferOffset);
+            if (IsIndexRangeValid(state, cmd->args))
+                FlushDrawState(state);
             return (sizeof(*cmd) + cmd->numVertexBuffers * sizeof(const NullBuffer*));
         }
         case NullOpcodePushDebugGroup:
         {
             auto cmd = reinterpret_cast<const NullCmdPushDebugGroup*>(pc);
-            //TODO
+            state.debugGroupDepth++;
             return (sizeof(*cmd) + cmd->length + 1);
         }
         case NullOpcodePopDebugGroup:
         {
-            //TODO
+            if (state.debugGroupDepth > 0)
+                state.debugGroupDepth--;
             return 0;
         }
         default:
@@ -76,8 +192,42 @@ static std::size_t ExecuteNullCommand(const NullOpcode opcode, const void* pc)
     }
 }
 
-void ExecuteNullVirtualCommandBuffer(const NullVirtualCommandBuffer& virtualCmdBuffer)
+static void ExecuteNullCommandsProfiled(const NullVirtualCommandBuffer& virtualCmdBuffer, NullCommandProfiler& profiler)
+{
+    NullExecutionState state;
+    NullCommandTimeRecords records;
+
+    for (const auto& chunk : virtualCmdBuffer)
+    {
+        auto pc     = chunk.data;
+        auto pcEnd  = chunk.data + chunk.size;
+
+        while (pc < pcEnd)
+        {
+            /* Read opcode */
+            const NullOpcode opcode = *reinterpret_cast<const NullOpcode*>(pc);
+            pc += sizeof(NullOpcode);
+
+            /* Execute command between two time stamps and increment program counter */
+            const auto startTime = profiler.Now();
+            pc += ExecuteNullCommand(opcode, pc, state);
+            profiler.Record(records, opcode, startTime, profiler.Now());
+        }
+    }
+
+    profiler.Merge(records);
+}
+
+void ExecuteNullVirtualCommandBuffer(const NullVirtualCommandBuffer& virtualCmdBuffer, NullCommandProfiler* profiler)
 {
+    if (profiler != nullptr)
+    {
+        ExecuteNullCommandsProfiled(virtualCmdBuffer, *profiler);
+        return;
+    }
+
+    NullExecutionState state;
+
     /* Initialize program counter to execute virtual GL commands */
     for (const auto& chunk : virtualCmdBuffer)
     {
@@ -91,7 +241,7 @@ void ExecuteNullVirtualCommandBuffer(const NullVirtualCommandBuffer& virtualCmdB
             pc += sizeof(NullOpcode);
 
             /* Execute command and increment program counter */
-            pc += ExecuteNullCommand(opcode, pc);
+            pc += ExecuteNullCommand(opcode, pc, state);
         }
     }
 }
@@ -16,8 +16,10 @@ namespace LLGL
 {
 
 
-// Executes all virtual commands from the specified command buffer.
-void ExecuteNullVirtualCommandBuffer(const NullVirtualCommandBuffer& virtualCmdBuffer);
+class NullCommandProfiler;
+
+// Executes all virtual commands from the specified command buffer. If a profiler is specified, the CPU time of each command is recorded.
+void ExecuteNullVirtualCommandBuffer(const NullVirtualCommandBuffer& virtualCmdBuffer, NullCommandProfiler* profiler = nullptr);
 
 
 } // /namespace LLGL
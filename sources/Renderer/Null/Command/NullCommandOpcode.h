@@ -21,6 +21,11 @@ enum NullOpcode : std::uint8_t
     NullOpcodeBufferWrite = 1,
     NullOpcodeCopySubresource,
     NullOpcodeGenerateMips,
+    NullOpcodeSetResourceHeap,
+    NullOpcodeSetResource,
+    NullOpcodeBeginRenderPass,
+    NullOpcodeEndRenderPass,
+    NullOpcodeSetPipelineState,
     //TODO
     NullOpcodeDraw,
     NullOpcodeDrawIndexed,
@@ -0,0 +1,124 @@
+/*
+ * NullCommandProfiler.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullCommandProfiler.h"
+#include <LLGL/Timer.h>
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+static const char* NullOpcodeToString(const NullOpcode opcode)
+{
+    switch (opcode)
+    {
+        case NullOpcodeBufferWrite:         return "UpdateBuffer";
+        case NullOpcodeCopySubresource:     return "CopySubresource";
+        case NullOpcodeGenerateMips:        return "GenerateMips";
+        case NullOpcodeSetResourceHeap:     return "SetResourceHeap";
+        case NullOpcodeSetResource:         return "SetResource";
+        case NullOpcodeBeginRenderPass:     return "BeginRenderPass";
+        case NullOpcodeEndRenderPass:       return "EndRenderPass";
+        case NullOpcodeSetPipelineState:    return "SetPipelineState";
+        case NullOpcodeDraw:                return "Draw";
+        case NullOpcodeDrawIndexed:         return "DrawIndexed";
+        case NullOpcodePushDebugGroup:      return "PushDebugGroup";
+        case NullOpcodePopDebugGroup:       return "PopDebugGroup";
+    }
+    return "";
+}
+
+static std::uint32_t GetHistogramBucket(std::uint64_t elapsedTime)
+{
+    std::uint32_t bucket = 0;
+    for (auto bucketTime = CommandTimeHistogram::firstBucketTime; elapsedTime >= bucketTime && bucket + 1 < CommandTimeHistogram::numBuckets; bucketTime *= 2)
+        ++bucket;
+    return bucket;
+}
+
+NullCommandProfiler::NullCommandProfiler() :
+    frequency_ { std::max(std::uint64_t(1), Timer::Frequency()) }
+{
+    /* Take the shortest interval between two subsequent time stamps as timer overhead */
+    constexpr int numSamples = 64;
+    timerOverhead_ = ~0ull;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto startTime = Now();
+        timerOverhead_ = std::min(timerOverhead_, Now() - startTime);
+    }
+}
+
+std::uint64_t NullCommandProfiler::Now() const
+{
+    const auto tick = Timer::Tick();
+    return ((tick / frequency_) * 1000000000ull + ((tick % frequency_) * 1000000000ull) / frequency_);
+}
+
+void NullCommandProfiler::Record(NullCommandTimeRecords& records, const NullOpcode opcode, std::uint64_t startTime, std::uint64_t endTime) const
+{
+    if (opcode >= g_numNullOpcodes)
+        return;
+
+    const std::uint64_t elapsedTime = (endTime - startTime > timerOverhead_ ? endTime - startTime - timerOverhead_ : 0);
+
+    auto& histogram = records.histograms[opcode];
+    {
+        histogram.minTime = (histogram.numCommands > 0 ? std::min(histogram.minTime, elapsedTime) : elapsedTime);
+        histogram.maxTime = std::max(histogram.maxTime, elapsedTime);
+        histogram.numCommands++;
+        histogram.totalTime += elapsedTime;
+        histogram.buckets[GetHistogramBucket(elapsedTime)]++;
+    }
+}
+
+void NullCommandProfiler::Merge(const NullCommandTimeRecords& records)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    for (std::size_t i = 0; i < g_numNullOpcodes; ++i)
+    {
+        const auto& src = records.histograms[i];
+        if (src.numCommands == 0)
+            continue;
+
+        auto& dst = records_.histograms[i];
+        {
+            dst.minTime = (dst.numCommands > 0 ? std::min(dst.minTime, src.minTime) : src.minTime);
+            dst.maxTime = std::max(dst.maxTime, src.maxTime);
+            dst.numCommands += src.numCommands;
+            dst.totalTime   += src.totalTime;
+            for (std::uint32_t bucket = 0; bucket < CommandTimeHistogram::numBuckets; ++bucket)
+                dst.buckets[bucket] += src.buckets[bucket];
+        }
+    }
+}
+
+void NullCommandProfiler::Flush(CommandStatistics& outStats)
+{
+    outStats.commands.clear();
+
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    for (std::size_t i = 0; i < g_numNullOpcodes; ++i)
+    {
+        auto& histogram = records_.histograms[i];
+        if (histogram.numCommands > 0)
+        {
+            histogram.command = NullOpcodeToString(static_cast<NullOpcode>(i));
+            outStats.commands.push_back(histogram);
+            histogram = CommandTimeHistogram{};
+        }
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,70 @@
+/*
+ * NullCommandProfiler.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_COMMAND_PROFILER_H
+#define LLGL_NULL_COMMAND_PROFILER_H
+
+
+#include <LLGL/RenderSystemFlags.h>
+#include "NullCommandOpcode.h"
+#include <cstdint>
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+// Number of opcode values that can be recorded in the command time histograms.
+static constexpr std::size_t g_numNullOpcodes = static_cast<std::size_t>(NullOpcodePopDebugGroup) + 1;
+
+// Time histograms of all opcodes that are accumulated during the execution of a single virtual command buffer.
+struct NullCommandTimeRecords
+{
+    CommandTimeHistogram histograms[g_numNullOpcodes];
+};
+
+// Accumulates the CPU time histograms of all executed commands for the benchmark mode (see RendererConfigurationNull::benchmarkMode).
+class NullCommandProfiler
+{
+
+    public:
+
+        // Estimates the overhead of the timer queries.
+        NullCommandProfiler();
+
+        // Returns the current time stamp in nanoseconds.
+        std::uint64_t Now() const;
+
+        // Adds the elapsed time between the two time stamps to the histogram of the specified opcode, excluding the timer overhead.
+        void Record(NullCommandTimeRecords& records, const NullOpcode opcode, std::uint64_t startTime, std::uint64_t endTime) const;
+
+        // Merges the specified time records into the accumulated histograms. This is thread-safe.
+        void Merge(const NullCommandTimeRecords& records);
+
+        // Returns the accumulated histograms of all opcodes that have been executed at least once and resets them. This is thread-safe.
+        void Flush(CommandStatistics& outStats);
+
+    private:
+
+        std::uint64_t           frequency_      = 1;
+        std::uint64_t           timerOverhead_  = 0;    // Shortest time (in nanoseconds) between two subsequent time stamps
+
+        std::mutex              mutex_;
+        NullCommandTimeRecords  records_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
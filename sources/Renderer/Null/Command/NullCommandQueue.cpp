@@ -9,6 +9,7 @@
 #include "NullCommandBuffer.h"
 #include "NullCommandExecutor.h"
 #include "../RenderState/NullQueryHeap.h"
+#include "../RenderState/NullFence.h"
 #include "../../CheckedCast.h"
 
 
@@ -38,12 +39,15 @@ bool NullCommandQueue::QueryResult(QueryHeap& queryHeap, std::uint32_t firstQuer
 
 void NullCommandQueue::Submit(Fence& fence)
 {
-    //todo
+    auto& fenceNull = LLGL_CAST(NullFence&, fence);
+    fenceNull.Signal(fenceNull.GetValue() + 1);
 }
 
-bool NullCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
+bool NullCommandQueue::WaitFence(Fence& fence, std::uint64_t /*timeout*/)
 {
-    return false; //todo
+    auto& fenceNull = LLGL_CAST(NullFence&, fence);
+    fenceNull.WaitForSignal(fenceNull.GetValue());
+    return true;
 }
 
 void NullCommandQueue::WaitIdle()
@@ -0,0 +1,20 @@
+/*
+ * NullStaticDispatch.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifdef LLGL_STATIC_DISPATCH_BACKEND
+
+#include "NullCommandBuffer.h"
+
+#define LLGL_STATIC_DISPATCH_COMMAND_BUFFER NullCommandBuffer
+#include "../../StaticDispatch.inl"
+#undef LLGL_STATIC_DISPATCH_COMMAND_BUFFER
+
+#endif // /LLGL_STATIC_DISPATCH_BACKEND
+
+
+
+// ================================================================================
@@ -34,6 +34,17 @@ namespace ModuleNull
     {
         return new NullRenderSystem(*renderSystemDesc);
     }
+
+    void QueryVideoAdapters(const LLGL::RenderSystemDescriptor* /*renderSystemDesc*/, std::vector<LLGL::VideoAdapterDescriptor>& outAdapters)
+    {
+        VideoAdapterDescriptor adapterDesc;
+        {
+            adapterDesc.name    = L"Null";
+            adapterDesc.vendor  = "LLGL";
+            adapterDesc.flags   = VideoAdapterFlags::Software;
+        }
+        outAdapters.push_back(adapterDesc);
+    }
 } // /namespace ModuleOpenGL
 
 
@@ -69,6 +80,19 @@ LLGL_EXPORT void* LLGL_RenderSystem_Alloc(const void* renderSystemDesc, int rend
     return nullptr;
 }
 
+LLGL_EXPORT int LLGL_RenderSystem_QueryVideoAdapters(const void* renderSystemDesc, int renderSystemDescSize, void* outAdapters)
+{
+    if (renderSystemDesc != nullptr && static_cast<std::size_t>(renderSystemDescSize) == sizeof(LLGL::RenderSystemDescriptor) && outAdapters != nullptr)
+    {
+        auto desc       = reinterpret_cast<const LLGL::RenderSystemDescriptor*>(renderSystemDesc);
+        auto adapters   = reinterpret_cast<std::vector<LLGL::VideoAdapterDescriptor>*>(outAdapters);
+        const auto numAdapters = adapters->size();
+        LLGL::ModuleNull::QueryVideoAdapters(desc, *adapters);
+        return static_cast<int>(adapters->size() - numAdapters);
+    }
+    return 0;
+}
+
 } // /extern "C"
 
 #endif // /LLGL_BUILD_STATIC_LIB
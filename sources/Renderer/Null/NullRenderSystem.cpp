@@ -6,9 +6,12 @@
  */
 
 #include "NullRenderSystem.h"
+#include "../RenderSystemUtils.h"
 #include "../../Core/Helper.h"
 #include <LLGL/Misc/ForRange.h>
 #include <limits.h>
+#include <stdexcept>
+#include <string>
 
 
 namespace LLGL
@@ -60,12 +63,14 @@ static void InitNullRendererFeatures(RenderingFeatures& features)
     features.hasInstancing                  = true;
     features.hasOffsetInstancing            = true;
     features.hasIndirectDrawing             = true;
+    features.hasIndirectCountDrawing        = true;
     features.hasViewportArrays              = true;
     features.hasConservativeRasterization   = false;
     features.hasStreamOutputs               = false;
     features.hasLogicOp                     = true;
     features.hasPipelineStatistics          = true;
     features.hasRenderCondition             = true;
+    features.hasNativeCommandLists          = true;
 }
 
 static void InitNullRendererLimits(RenderingLimits& limits)
@@ -120,6 +125,15 @@ NullRenderSystem::NullRenderSystem(const RenderSystemDescriptor& renderSystemDes
     desc_         { renderSystemDesc               },
     commandQueue_ { MakeUnique<NullCommandQueue>() }
 {
+    /* Null renderer only has a single software adapter */
+    if (renderSystemDesc.adapterIndex > 0)
+        throw std::runtime_error("video adapter index out of range: " + std::to_string(renderSystemDesc.adapterIndex));
+
+    if (auto rendererConfigNull = GetRendererConfiguration<RendererConfigurationNull>(renderSystemDesc))
+    {
+        if (rendererConfigNull->benchmarkMode)
+            commandProfiler_ = MakeUnique<NullCommandProfiler>();
+    }
     SetRendererInfo(GetNullRenderInfo());
     SetRenderingCaps(GetNullRenderingCaps());
 }
@@ -147,7 +161,7 @@ CommandQueue* NullRenderSystem::GetCommandQueue()
 
 CommandBuffer* NullRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& commandBufferDesc)
 {
-    return TakeOwnership(commandBuffers_, MakeUnique<NullCommandBuffer>(commandBufferDesc));
+    return TakeOwnership(commandBuffers_, MakeUnique<NullCommandBuffer>(commandBufferDesc, commandProfiler_.get()));
 }
 
 void NullRenderSystem::Release(CommandBuffer& commandBuffer)
@@ -164,10 +178,10 @@ Buffer* NullRenderSystem::CreateBuffer(const BufferDescriptor& bufferDesc, const
     return TakeOwnership(buffers_, MakeUnique<NullBuffer>(bufferDesc, initialData));
 }
 
-BufferArray* NullRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray)
+BufferArray* NullRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets)
 {
     AssertCreateBufferArray(numBuffers, bufferArray);
-    return TakeOwnership(bufferArrays_, MakeUnique<NullBufferArray>(numBuffers, bufferArray));
+    return TakeOwnership(bufferArrays_, MakeUnique<NullBufferArray>(numBuffers, bufferArray, offsets));
 }
 
 void NullRenderSystem::Release(Buffer& buffer)
@@ -358,6 +372,19 @@ void NullRenderSystem::Release(Fence& fence)
     RemoveFromUniqueSet(fences_, &fence);
 }
 
+/* ----- Commands ----- */
+
+bool NullRenderSystem::QueryCommandStatistics(CommandStatistics& outStats)
+{
+    if (commandProfiler_)
+    {
+        commandProfiler_->Flush(outStats);
+        return true;
+    }
+    outStats.commands.clear();
+    return false;
+}
+
 
 } // /namespace LLGL
 
@@ -13,6 +13,7 @@
 #include "NullSwapChain.h"
 #include "Command/NullCommandBuffer.h"
 #include "Command/NullCommandQueue.h"
+#include "Command/NullCommandProfiler.h"
 #include "Buffer/NullBuffer.h"
 #include "Buffer/NullBufferArray.h"
 #include "RenderState/NullFence.h"
@@ -59,7 +60,7 @@ class NullRenderSystem final : public RenderSystem
         /* ----- Buffers ------ */
 
         Buffer* CreateBuffer(const BufferDescriptor& bufferDesc, const void* initialData = nullptr) override;
-        BufferArray* CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray) override;
+        BufferArray* CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets = nullptr) override;
 
         void Release(Buffer& buffer) override;
         void Release(BufferArray& bufferArray) override;
@@ -138,11 +139,16 @@ class NullRenderSystem final : public RenderSystem
 
         void Release(Fence& fence) override;
 
+        /* ----- Commands ----- */
+
+        bool QueryCommandStatistics(CommandStatistics& outStats) override;
+
     private:
 
         /* ----- Common objects ----- */
 
         const RenderSystemDescriptor            desc_;
+        std::unique_ptr<NullCommandProfiler>    commandProfiler_;   // Only allocated in benchmark mode
 
         /* ----- Hardware object containers ----- */
 
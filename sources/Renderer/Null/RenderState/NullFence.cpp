@@ -22,6 +22,17 @@ void NullFence::SetName(const char* name)
         label_.clear();
 }
 
+std::uint64_t NullFence::GetValue() const
+{
+    return signal_;
+}
+
+std::uint64_t NullFence::GetCompletedValue() const
+{
+    /* Null device has no GPU timeline, so every submitted value is signaled immediately */
+    return signal_;
+}
+
 void NullFence::Signal(std::uint64_t signal)
 {
     signal_ = signal;
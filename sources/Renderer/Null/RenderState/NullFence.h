@@ -25,6 +25,9 @@ class NullFence final : public Fence
 
         void SetName(const char* name) override;
 
+        std::uint64_t GetValue() const override;
+        std::uint64_t GetCompletedValue() const override;
+
     public:
     
         NullFence(std::uint64_t initialSignal = 0);
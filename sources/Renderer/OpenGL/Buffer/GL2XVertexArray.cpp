@@ -36,7 +36,7 @@ void GL2XVertexArray::BuildVertexAttribute(GLuint bufferID, const VertexAttribut
         ThrowNotSupportedExcept(__FUNCTION__, "specified vertex attribute");
 
     /* Convert offset to pointer sized type (for 32- and 64 bit builds) */
-    auto dataType       = GLTypes::Map(formatAttribs.dataType);
+    auto dataType       = GLTypes::ToVertexAttribType(attribute.format);
     auto components     = static_cast<GLint>(formatAttribs.components);
     auto attribIndex    = static_cast<GLuint>(attribute.location);
     auto stride         = static_cast<GLsizei>(attribute.stride);
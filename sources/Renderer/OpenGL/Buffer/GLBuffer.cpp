@@ -13,12 +13,18 @@
 #include "../Ext/GLExtensionRegistry.h"
 #include "../../../Core/Helper.h"
 #include <memory>
+#include <limits>
+#include <algorithm>
+#include <string.h>
 
 
 namespace LLGL
 {
 
 
+// Streaming buffers and buffers with unsynchronized mapped ranges that have been written since the last submission
+static std::vector<GLBuffer*> g_dirtyFencedBuffers;
+
 // Finds the primary buffer target used for a buffer with the specified binding flags
 static GLBufferTarget FindPrimaryBufferTarget(long bindFlags)
 {
@@ -37,10 +43,17 @@ static GLBufferTarget FindPrimaryBufferTarget(long bindFlags)
     return GLBufferTarget::ARRAY_BUFFER;
 }
 
-GLBuffer::GLBuffer(long bindFlags) :
+GLBuffer::GLBuffer(long bindFlags, GLuint nativeID) :
     Buffer  { bindFlags                          },
     target_ { FindPrimaryBufferTarget(bindFlags) }
 {
+    if (nativeID != 0)
+    {
+        /* Take native GL buffer object without ownership */
+        id_     = nativeID;
+        ownsID_ = false;
+    }
+    else
     #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
     if (HasExtension(GLExt::ARB_direct_state_access))
     {
@@ -57,7 +70,10 @@ GLBuffer::GLBuffer(long bindFlags) :
 
 GLBuffer::~GLBuffer()
 {
-    glDeleteBuffers(1, &id_);
+    if (dirtyBegin_ < dirtyEnd_)
+        RemoveFromList(g_dirtyFencedBuffers, this);
+    if (ownsID_)
+        glDeleteBuffers(1, &id_);
     GLStateManager::Get().NotifyBufferRelease(*this);
 }
 
@@ -95,6 +111,8 @@ BufferDescriptor GLBuffer::GetDesc() const
 
     if (usage == GL_DYNAMIC_DRAW)
         bufferDesc.miscFlags |= MiscFlags::DynamicUsage;
+    if (IsStreaming())
+        bufferDesc.miscFlags |= MiscFlags::Streaming;
 
     return bufferDesc;
 }
@@ -125,8 +143,34 @@ void GLBuffer::BufferStorage(GLsizeiptr size, const void* data, GLbitfield flags
     }
 }
 
+void GLBuffer::BufferStorageStreaming(GLsizeiptr size, const void* data, GLbitfield flags)
+{
+    #ifdef GL_ARB_buffer_storage
+
+    /* Allocate immutable storage with persistent and coherent mapping (GL 4.4+) */
+    const GLbitfield mapFlags = (flags & GL_MAP_READ_BIT) | GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    BufferStorage(size, data, flags | mapFlags, GL_DYNAMIC_DRAW);
+
+    /* Keep buffer mapped for its entire lifetime */
+    mappedData_ = reinterpret_cast<char*>(MapBufferRange(0, size, mapFlags));
+    mappedSize_ = (mappedData_ != nullptr ? size : 0);
+
+    #else
+
+    BufferStorage(size, data, flags, GL_DYNAMIC_DRAW);
+
+    #endif // /GL_ARB_buffer_storage
+}
+
 void GLBuffer::BufferSubData(GLintptr offset, GLsizeiptr size, const void* data)
 {
+    if (IsStreaming())
+    {
+        /* Write directly into persistently mapped storage */
+        ::memcpy(AcquireStreamingRange(offset, size, true), data, static_cast<std::size_t>(size));
+        return;
+    }
+
     #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
     if (HasExtension(GLExt::ARB_direct_state_access))
     {
@@ -257,6 +301,9 @@ void GLBuffer::CopyBufferSubData(const GLBuffer& readBuffer, GLintptr readOffset
 
 void* GLBuffer::MapBuffer(GLenum access)
 {
+    if (IsStreaming())
+        return AcquireStreamingRange(0, mappedSize_, (access != GL_READ_ONLY));
+
     #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
     if (HasExtension(GLExt::ARB_direct_state_access))
     {
@@ -272,6 +319,13 @@ void* GLBuffer::MapBuffer(GLenum access)
 
 void* GLBuffer::MapBufferRange(GLintptr offset, GLsizeiptr length, GLbitfield access)
 {
+    if (IsStreaming())
+        return AcquireStreamingRange(offset, length, ((access & GL_MAP_WRITE_BIT) != 0));
+
+    /* Unsynchronized writes are guarded by fences, so only ranges that are still in flight must be waited on */
+    if ((access & GL_MAP_UNSYNCHRONIZED_BIT) != 0)
+        SyncFencedRange(offset, length, ((access & GL_MAP_WRITE_BIT) != 0));
+
     #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
     if (HasExtension(GLExt::ARB_direct_state_access))
     {
@@ -295,6 +349,10 @@ void* GLBuffer::MapBufferRange(GLintptr offset, GLsizeiptr length, GLbitfield ac
 
 void GLBuffer::UnmapBuffer()
 {
+    /* Streaming buffers remain mapped for their entire lifetime */
+    if (IsStreaming())
+        return;
+
     #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
     if (HasExtension(GLExt::ARB_direct_state_access))
     {
@@ -364,6 +422,82 @@ void GLBuffer::SetIndexType(const Format format)
     indexType16Bits_ = (format == Format::R16UInt);
 }
 
+void GLBuffer::SubmitStreamingFences()
+{
+    for (auto buffer : g_dirtyFencedBuffers)
+        buffer->SubmitStreamingFence();
+    g_dirtyFencedBuffers.clear();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void* GLBuffer::AcquireStreamingRange(GLintptr offset, GLsizeiptr length, bool write)
+{
+    SyncFencedRange(offset, length, write);
+    return (mappedData_ + offset);
+}
+
+void GLBuffer::SyncFencedRange(GLintptr offset, GLsizeiptr length, bool write)
+{
+    const GLintptr end = offset + length;
+
+    /* Wait for the newest fence that overlaps with the range; all older fences are signaled before that one */
+    for (auto it = pendingFences_.rbegin(); it != pendingFences_.rend(); ++it)
+    {
+        if (it->begin < end && offset < it->end)
+        {
+            it->fence->Wait(std::numeric_limits<GLuint64>::max());
+
+            /* Recycle all fences up to and including the one that has been waited on */
+            auto last = it.base();
+            for (auto fenceIt = pendingFences_.begin(); fenceIt != last; ++fenceIt)
+                unusedFences_.push_back(std::move(fenceIt->fence));
+            pendingFences_.erase(pendingFences_.begin(), last);
+            break;
+        }
+    }
+
+    /* Extend range that will be guarded by the next fence */
+    if (write && length > 0)
+    {
+        if (dirtyBegin_ < dirtyEnd_)
+        {
+            dirtyBegin_ = std::min(dirtyBegin_, offset);
+            dirtyEnd_   = std::max(dirtyEnd_, end);
+        }
+        else
+        {
+            dirtyBegin_ = offset;
+            dirtyEnd_   = end;
+            g_dirtyFencedBuffers.push_back(this);
+        }
+    }
+}
+
+void GLBuffer::SubmitStreamingFence()
+{
+    StreamingFence entry;
+    {
+        if (unusedFences_.empty())
+            entry.fence = MakeUnique<GLFence>();
+        else
+        {
+            entry.fence = std::move(unusedFences_.back());
+            unusedFences_.pop_back();
+        }
+        entry.fence->Submit();
+        entry.begin = dirtyBegin_;
+        entry.end   = dirtyEnd_;
+    }
+    pendingFences_.push_back(std::move(entry));
+
+    dirtyBegin_ = 0;
+    dirtyEnd_   = 0;
+}
+
 
 } // /namespace LLGL
 
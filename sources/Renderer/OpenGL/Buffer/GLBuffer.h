@@ -13,7 +13,10 @@
 #include <LLGL/Format.h>
 #include "../OpenGL.h"
 #include "../RenderState/GLStateManager.h"
+#include "../RenderState/GLFence.h"
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 
 namespace LLGL
@@ -31,10 +34,18 @@ class GLBuffer : public Buffer
 
     public:
 
-        GLBuffer(long bindFlags);
+        // Creates a new GL buffer object, or takes the specified native buffer name without ownership if 'nativeID' is non-zero.
+        GLBuffer(long bindFlags, GLuint nativeID = 0);
         ~GLBuffer();
 
         void BufferStorage(GLsizeiptr size, const void* data, GLbitfield flags, GLenum usage);
+
+        /*
+        Allocates immutable storage that is persistently and coherently mapped for the lifetime of this buffer (requires GL_ARB_buffer_storage).
+        Subsequent writes are copied directly into the mapped storage and are guarded by fences (see MiscFlags::Streaming).
+        */
+        void BufferStorageStreaming(GLsizeiptr size, const void* data, GLbitfield flags);
+
         void BufferSubData(GLintptr offset, GLsizeiptr size, const void* data);
 
         void GetBufferSubData(GLintptr offset, GLsizeiptr size, void* data);
@@ -48,6 +59,9 @@ class GLBuffer : public Buffer
         void* MapBufferRange(GLintptr offset, GLsizeiptr length, GLbitfield access);
         void UnmapBuffer();
 
+        // Inserts a fence for each streaming buffer or unsynchronized mapped range that has been written since the last submission. Called on command buffer submission and swap-chain presentation.
+        static void SubmitStreamingFences();
+
         // Returns the specified buffer parameters; null pointers are ignored.
         void GetBufferParams(GLint* size, GLint* usage, GLint* storageFlags) const;
 
@@ -78,11 +92,51 @@ class GLBuffer : public Buffer
             return indexType16Bits_;
         }
 
+        // Returns true if this buffer has persistently mapped storage for streaming.
+        inline bool IsStreaming() const
+        {
+            return (mappedData_ != nullptr);
+        }
+
+    private:
+
+        // Fence that guards the range of a streaming buffer or an unsynchronized mapped range which has been written before the fence was submitted.
+        struct StreamingFence
+        {
+            std::unique_ptr<GLFence>    fence;
+            GLintptr                    begin;
+            GLintptr                    end;
+        };
+
     private:
 
-        GLuint          id_                 = 0;
-        GLBufferTarget  target_             = GLBufferTarget::ARRAY_BUFFER;
-        bool            indexType16Bits_    = false;
+        // Waits until the GPU no longer reads the specified range of the streaming buffer and marks it as written.
+        void* AcquireStreamingRange(GLintptr offset, GLsizeiptr length, bool write);
+
+        // Waits until the GPU no longer reads the specified range and marks it as written; used for streaming and unsynchronized mapped ranges.
+        void SyncFencedRange(GLintptr offset, GLsizeiptr length, bool write);
+
+        // Submits a fence for the range that has been written since the last submission.
+        void SubmitStreamingFence();
+
+    private:
+
+        GLuint                                  id_                 = 0;
+        GLBufferTarget                          target_             = GLBufferTarget::ARRAY_BUFFER;
+        bool                                    indexType16Bits_    = false;
+        bool                                    ownsID_             = true;     // False if a native buffer was imported.
+
+        /* ----- Streaming ----- */
+
+        char*                                   mappedData_         = nullptr;
+        GLsizeiptr                              mappedSize_         = 0;
+
+        /* ----- Fenced ranges of streaming buffers and unsynchronized mappings ----- */
+
+        GLintptr                                dirtyBegin_         = 0;
+        GLintptr                                dirtyEnd_           = 0;
+        std::vector<StreamingFence>             pendingFences_;                 // Ordered from oldest to newest
+        std::vector<std::unique_ptr<GLFence>>   unusedFences_;
 
 };
 
@@ -18,30 +18,34 @@ namespace LLGL
 {
 
 
-GLBufferArrayWithVAO::GLBufferArrayWithVAO(std::uint32_t numBuffers, Buffer* const * bufferArray) :
+GLBufferArrayWithVAO::GLBufferArrayWithVAO(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets) :
     GLBufferArray { numBuffers, bufferArray }
 {
     #ifdef LLGL_GL_ENABLE_OPENGL2X
     if (!HasNativeVAO())
     {
         /* Build vertex array with emulator (for GL 2.x compatibility) */
-        BuildVertexArrayWithEmulator(numBuffers, bufferArray);
+        BuildVertexArrayWithEmulator(numBuffers, bufferArray, offsets);
     }
     else
     #endif // /LLGL_GL_ENABLE_OPENGL2X
+    if (HasExtension(GLExt::ARB_vertex_attrib_binding))
+    {
+        /* Build vertex buffer bindings for a VAO that is shared between all buffer arrays with the same vertex format */
+        BuildVertexArrayWithSharedVAO(numBuffers, bufferArray, offsets);
+    }
+    else
     {
         /* Build vertex array with native VAO */
-        BuildVertexArrayWithVAO(numBuffers, bufferArray);
+        BuildVertexArrayWithVAO(numBuffers, bufferArray, offsets);
     }
 }
 
 void GLBufferArrayWithVAO::SetName(const char* name)
 {
-    #ifdef LLGL_GL_ENABLE_OPENGL2X
-    if (HasNativeVAO())
-    #endif
+    if (vao_.GetID() != 0)
     {
-        /* Set label for VAO */
+        /* Set label for VAO; shared VAOs are not labeled, since they belong to multiple buffer arrays */
         GLSetObjectLabel(GL_VERTEX_ARRAY, vao_.GetID(), name);
     }
 }
@@ -59,12 +63,22 @@ static void ThrowNoVertexBufferErr()
     );
 }
 
-void GLBufferArrayWithVAO::BuildVertexArrayWithVAO(std::uint32_t numBuffers, Buffer* const * bufferArray)
+// Returns the specified vertex attribute with its offset moved by the offset of the sub-allocated vertex stream.
+static VertexAttribute GetVertexAttribWithOffset(const VertexAttribute& attrib, const std::uint64_t* offsets, std::size_t index)
+{
+    auto attribWithOffset = attrib;
+    if (offsets != nullptr)
+        attribWithOffset.offset += static_cast<std::uint32_t>(offsets[index]);
+    return attribWithOffset;
+}
+
+void GLBufferArrayWithVAO::BuildVertexArrayWithVAO(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets)
 {
     /* Bind VAO */
+    vao_.Create();
     GLStateManager::Get().BindVertexArray(GetVaoID());
     {
-        while (auto bufferGL = NextArrayResource<GLBuffer>(numBuffers, bufferArray))
+        for (std::size_t i = 0; auto bufferGL = NextArrayResource<GLBuffer>(numBuffers, bufferArray); ++i)
         {
             if ((bufferGL->GetBindFlags() & BindFlags::VertexBuffer) != 0)
             {
@@ -75,7 +89,7 @@ void GLBufferArrayWithVAO::BuildVertexArrayWithVAO(std::uint32_t numBuffers, Buf
                 /* Build each vertex attribute */
                 const auto& vertexAttribs = vertexBufferGL->GetVertexAttribs();
                 for (const auto& attrib : vertexAttribs)
-                    vao_.BuildVertexAttribute(attrib);
+                    vao_.BuildVertexAttribute(GetVertexAttribWithOffset(attrib, offsets, i));
             }
             else
                 ThrowNoVertexBufferErr();
@@ -84,11 +98,28 @@ void GLBufferArrayWithVAO::BuildVertexArrayWithVAO(std::uint32_t numBuffers, Buf
     GLStateManager::Get().BindVertexArray(0);
 }
 
+void GLBufferArrayWithVAO::BuildVertexArrayWithSharedVAO(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets)
+{
+    for (std::size_t i = 0; auto bufferGL = NextArrayResource<GLBuffer>(numBuffers, bufferArray); ++i)
+    {
+        if ((bufferGL->GetBindFlags() & BindFlags::VertexBuffer) != 0)
+        {
+            /* Build vertex buffer binding for each vertex attribute */
+            auto vertexBufferGL = LLGL_CAST(GLBufferWithVAO*, bufferGL);
+            for (const auto& attrib : vertexBufferGL->GetVertexAttribs())
+                sharedVertexArray_.BuildVertexAttribute(vertexBufferGL->GetID(), GetVertexAttribWithOffset(attrib, offsets, i));
+        }
+        else
+            ThrowNoVertexBufferErr();
+    }
+    sharedVertexArray_.Finalize();
+}
+
 #ifdef LLGL_GL_ENABLE_OPENGL2X
 
-void GLBufferArrayWithVAO::BuildVertexArrayWithEmulator(std::uint32_t numBuffers, Buffer* const * bufferArray)
+void GLBufferArrayWithVAO::BuildVertexArrayWithEmulator(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets)
 {
-    while (numBuffers-- > 0)
+    for (std::uint32_t i = 0; i < numBuffers; ++i)
     {
         if (((*bufferArray)->GetBindFlags() & BindFlags::VertexBuffer) != 0)
         {
@@ -97,7 +128,7 @@ void GLBufferArrayWithVAO::BuildVertexArrayWithEmulator(std::uint32_t numBuffers
             /* Build each vertex attribute */
             const auto& vertexAttribs = vertexBufferGL->GetVertexAttribs();
             for (const auto& attrib : vertexAttribs)
-                vertexArrayGL2X_.BuildVertexAttribute(vertexBufferGL->GetID(), attrib);
+                vertexArrayGL2X_.BuildVertexAttribute(vertexBufferGL->GetID(), GetVertexAttribWithOffset(attrib, offsets, i));
         }
         else
             ThrowNoVertexBufferErr();
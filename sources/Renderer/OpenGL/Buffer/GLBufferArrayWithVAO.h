@@ -11,6 +11,7 @@
 
 #include "GLBufferArray.h"
 #include "GLVertexArrayObject.h"
+#include "GLSharedVertexArray.h"
 #ifdef LLGL_GL_ENABLE_OPENGL2X
 #   include "GL2XVertexArray.h"
 #endif
@@ -29,7 +30,7 @@ class GLBufferArrayWithVAO final : public GLBufferArray
 
     public:
 
-        GLBufferArrayWithVAO(std::uint32_t numBuffers, Buffer* const * bufferArray);
+        GLBufferArrayWithVAO(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets = nullptr);
 
         // Returns the ID of the vertex-array-object (VAO)
         inline GLuint GetVaoID() const
@@ -37,6 +38,12 @@ class GLBufferArrayWithVAO final : public GLBufferArray
             return vao_.GetID();
         }
 
+        // Returns the vertex array with a VAO that is shared between all vertex arrays of the same vertex format (for GL_ARB_vertex_attrib_binding).
+        inline const GLSharedVertexArray& GetSharedVertexArray() const
+        {
+            return sharedVertexArray_;
+        }
+
         #ifdef LLGL_GL_ENABLE_OPENGL2X
         // Returns the GL 2.x compatible vertex-array emulator.
         inline const GL2XVertexArray& GetVertexArrayGL2X() const
@@ -47,14 +54,16 @@ class GLBufferArrayWithVAO final : public GLBufferArray
 
     private:
 
-        void BuildVertexArrayWithVAO(std::uint32_t numBuffers, Buffer* const * bufferArray);
+        void BuildVertexArrayWithVAO(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets);
+        void BuildVertexArrayWithSharedVAO(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets);
         #ifdef LLGL_GL_ENABLE_OPENGL2X
-        void BuildVertexArrayWithEmulator(std::uint32_t numBuffers, Buffer* const * bufferArray);
+        void BuildVertexArrayWithEmulator(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets);
         #endif
 
     private:
 
         GLVertexArrayObject vao_;
+        GLSharedVertexArray sharedVertexArray_;
 
         #ifdef LLGL_GL_ENABLE_OPENGL2X
         GL2XVertexArray     vertexArrayGL2X_;
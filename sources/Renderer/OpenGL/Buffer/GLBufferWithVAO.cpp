@@ -14,8 +14,8 @@ namespace LLGL
 {
 
 
-GLBufferWithVAO::GLBufferWithVAO(long bindFlags) :
-    GLBuffer { bindFlags }
+GLBufferWithVAO::GLBufferWithVAO(long bindFlags, GLuint nativeID) :
+    GLBuffer { bindFlags, nativeID }
 {
 }
 
@@ -35,6 +35,12 @@ void GLBufferWithVAO::BuildVertexArray(std::size_t numVertexAttribs, const Verte
     }
     else
     #endif // /LLGL_GL_ENABLE_OPENGL2X
+    if (HasExtension(GLExt::ARB_vertex_attrib_binding))
+    {
+        /* Build vertex buffer bindings for a VAO that is shared between all buffers with the same vertex format */
+        BuildVertexArrayWithSharedVAO();
+    }
+    else
     {
         /* Build vertex array with native VAO */
         BuildVertexArrayWithVAO();
@@ -49,6 +55,7 @@ void GLBufferWithVAO::BuildVertexArray(std::size_t numVertexAttribs, const Verte
 void GLBufferWithVAO::BuildVertexArrayWithVAO()
 {
     /* Bind VAO */
+    vao_.Create();
     GLStateManager::Get().BindVertexArray(GetVaoID());
     {
         /* Bind VBO */
@@ -61,6 +68,13 @@ void GLBufferWithVAO::BuildVertexArrayWithVAO()
     GLStateManager::Get().BindVertexArray(0);
 }
 
+void GLBufferWithVAO::BuildVertexArrayWithSharedVAO()
+{
+    for (const auto& attrib : vertexAttribs_)
+        sharedVertexArray_.BuildVertexAttribute(GetID(), attrib);
+    sharedVertexArray_.Finalize();
+}
+
 #ifdef LLGL_GL_ENABLE_OPENGL2X
 
 void GLBufferWithVAO::BuildVertexArrayWithEmulator()
@@ -11,6 +11,7 @@
 
 #include "GLBuffer.h"
 #include "GLVertexArrayObject.h"
+#include "GLSharedVertexArray.h"
 #ifdef LLGL_GL_ENABLE_OPENGL2X
 #   include "GL2XVertexArray.h"
 #endif
@@ -25,7 +26,7 @@ class GLBufferWithVAO final : public GLBuffer
 
     public:
 
-        GLBufferWithVAO(long bindFlags);
+        GLBufferWithVAO(long bindFlags, GLuint nativeID = 0);
 
         void BuildVertexArray(std::size_t numVertexAttribs, const VertexAttribute* vertexAttribs);
 
@@ -35,6 +36,12 @@ class GLBufferWithVAO final : public GLBuffer
             return vao_.GetID();
         }
 
+        // Returns the vertex array with a VAO that is shared between all vertex arrays of the same vertex format (for GL_ARB_vertex_attrib_binding).
+        inline const GLSharedVertexArray& GetSharedVertexArray() const
+        {
+            return sharedVertexArray_;
+        }
+
         // Returns the list of vertex attributes.
         inline const std::vector<VertexAttribute>& GetVertexAttribs() const
         {
@@ -52,6 +59,7 @@ class GLBufferWithVAO final : public GLBuffer
     private:
 
         void BuildVertexArrayWithVAO();
+        void BuildVertexArrayWithSharedVAO();
         #ifdef LLGL_GL_ENABLE_OPENGL2X
         void BuildVertexArrayWithEmulator();
         #endif
@@ -59,6 +67,7 @@ class GLBufferWithVAO final : public GLBuffer
     private:
 
         GLVertexArrayObject             vao_;
+        GLSharedVertexArray             sharedVertexArray_;
         std::vector<VertexAttribute>    vertexAttribs_;
 
         #ifdef LLGL_GL_ENABLE_OPENGL2X
@@ -0,0 +1,121 @@
+/*
+ * GLSharedVertexArray.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLSharedVertexArray.h"
+#include "../Ext/GLExtensions.h"
+#include "../Ext/GLExtensionRegistry.h"
+#include "../RenderState/GLStateManager.h"
+#include "../RenderState/GLStatePool.h"
+#include <LLGL/Misc/ForRange.h>
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+GLSharedVertexArray::~GLSharedVertexArray()
+{
+    GLStatePool::Get().ReleaseVertexArrayFormat(std::move(format_));
+}
+
+void GLSharedVertexArray::BuildVertexAttribute(GLuint bufferID, const VertexAttribute& attribute)
+{
+    pendingBindings_.push_back({ bufferID, attribute });
+}
+
+void GLSharedVertexArray::Finalize()
+{
+    if (pendingBindings_.empty())
+        return;
+
+    /* Sort bindings by attribute location in ascending order */
+    std::sort(
+        pendingBindings_.begin(),
+        pendingBindings_.end(),
+        [](const GLVertexBinding& lhs, const GLVertexBinding& rhs)
+        {
+            return (lhs.attribute.location < rhs.attribute.location);
+        }
+    );
+
+    /* Allocate binding range; each attribute uses the binding index of its location */
+    firstBinding_ = pendingBindings_.front().attribute.location;
+    const std::size_t numBindings = pendingBindings_.back().attribute.location - firstBinding_ + 1;
+
+    buffers_.assign(numBindings, 0);
+    offsets_.assign(numBindings, 0);
+    strides_.assign(numBindings, 0);
+
+    GLVertexArrayFormat::AttributeList attribs;
+    attribs.reserve(pendingBindings_.size());
+
+    for (const auto& binding : pendingBindings_)
+    {
+        const auto& attrib = binding.attribute;
+        if (!attribs.empty() && attribs.back().location == attrib.location)
+            throw std::invalid_argument("vertex attribute locations must be unique");
+
+        /* Interpret zero stride as tightly packed, just like 'glVertexAttribPointer' does */
+        const auto index = attrib.location - firstBinding_;
+        buffers_[index] = binding.buffer;
+        offsets_[index] = static_cast<GLintptr>(attrib.offset);
+        strides_[index] = static_cast<GLsizei>(attrib.stride > 0 ? attrib.stride : attrib.GetSize());
+
+        attribs.push_back({ attrib.location, attrib.format, attrib.instanceDivisor });
+    }
+
+    pendingBindings_.clear();
+
+    /* Acquire VAO that is shared between all vertex arrays with this vertex format */
+    GLStatePool::Get().ReleaseVertexArrayFormat(std::move(format_));
+    format_ = GLStatePool::Get().CreateVertexArrayFormat(attribs);
+}
+
+void GLSharedVertexArray::Bind(GLStateManager& stateMngr) const
+{
+    stateMngr.BindVertexArray(GetID());
+
+    #ifdef LLGL_GLEXT_VERTEX_ATTRIB_BINDING
+
+    if (buffers_.empty())
+        return;
+
+    #ifdef GL_ARB_multi_bind
+    if (HasExtension(GLExt::ARB_multi_bind))
+    {
+        /* Bind all vertex buffers with a single GL call */
+        glBindVertexBuffers(
+            firstBinding_,
+            static_cast<GLsizei>(buffers_.size()),
+            buffers_.data(),
+            offsets_.data(),
+            strides_.data()
+        );
+    }
+    else
+    #endif // /GL_ARB_multi_bind
+    {
+        for_range(i, buffers_.size())
+            glBindVertexBuffer(firstBinding_ + static_cast<GLuint>(i), buffers_[i], offsets_[i], strides_[i]);
+    }
+
+    #endif // /LLGL_GLEXT_VERTEX_ATTRIB_BINDING
+}
+
+GLuint GLSharedVertexArray::GetID() const
+{
+    return (format_ ? format_->GetID() : 0);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
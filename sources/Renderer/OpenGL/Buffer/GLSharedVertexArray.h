@@ -0,0 +1,81 @@
+/*
+ * GLSharedVertexArray.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_SHARED_VERTEX_ARRAY_H
+#define LLGL_GL_SHARED_VERTEX_ARRAY_H
+
+
+#include <LLGL/VertexAttribute.h>
+#include "GLVertexArrayFormat.h"
+#include "../OpenGL.h"
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class GLStateManager;
+
+/*
+Vertex array that shares its VAO with all other vertex arrays of the same vertex format (for GL_ARB_vertex_attrib_binding).
+Only the vertex buffer bindings are stored per vertex array and bound with 'glBindVertexBuffer(s)' after the shared VAO has been bound.
+*/
+class GLSharedVertexArray
+{
+
+    public:
+
+        GLSharedVertexArray() = default;
+        ~GLSharedVertexArray();
+
+        GLSharedVertexArray(const GLSharedVertexArray&) = delete;
+        GLSharedVertexArray& operator = (const GLSharedVertexArray&) = delete;
+
+        // Stores the vertex buffer binding and format of the specified attribute.
+        void BuildVertexAttribute(GLuint bufferID, const VertexAttribute& attribute);
+
+        // Finalizes building vertex attributes and acquires the shared VAO for this vertex format.
+        void Finalize();
+
+        // Binds the shared VAO and the vertex buffers of this vertex array.
+        void Bind(GLStateManager& stateMngr) const;
+
+        // Returns the ID of the shared vertex-array-object (VAO) or 0 if it has not been finalized yet.
+        GLuint GetID() const;
+
+    private:
+
+        struct GLVertexBinding
+        {
+            GLuint                      buffer;
+            VertexAttribute             attribute;
+        };
+
+    private:
+
+        std::vector<GLVertexBinding>    pendingBindings_;   // Bindings that are consumed by 'Finalize'
+
+        // Vertex buffer bindings for the range [firstBinding_, firstBinding_ + buffers_.size()); unused binding indices refer to buffer 0.
+        GLuint                          firstBinding_       = 0;
+        std::vector<GLuint>             buffers_;
+        std::vector<GLintptr>           offsets_;
+        std::vector<GLsizei>            strides_;
+
+        GLVertexArrayFormatSPtr         format_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,99 @@
+/*
+ * GLUniformRingBuffer.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLUniformRingBuffer.h"
+#include "GLBuffer.h"
+#include "../RenderState/GLStateManager.h"
+#include "../Ext/GLExtensions.h"
+#include "../Ext/GLExtensionRegistry.h"
+#include "../../../Core/Helper.h"
+#include <LLGL/ResourceFlags.h>
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+static const GLsizeiptr g_uniformRingBufferSize = (1024 * 1024);
+
+GLUniformRingBuffer::GLUniformRingBuffer() = default;
+
+GLUniformRingBuffer::~GLUniformRingBuffer()
+{
+    Clear();
+}
+
+GLUniformRingBuffer& GLUniformRingBuffer::Get()
+{
+    static GLUniformRingBuffer instance;
+    return instance;
+}
+
+void GLUniformRingBuffer::Clear()
+{
+    buffer_.reset();
+    offset_ = 0;
+}
+
+void GLUniformRingBuffer::BindUniformBlock(GLStateManager& stateMngr, GLuint index, const void* data, GLsizeiptr size)
+{
+    if (size <= 0 || size > g_uniformRingBufferSize)
+        return;
+
+    if (!buffer_)
+        CreateBuffer();
+
+    /* Wrap around if the range exceeds the end of the ring buffer */
+    if (offset_ + size > g_uniformRingBufferSize)
+    {
+        /* Guard all ranges of this submission with a fence, so the next writes wait until the GPU no longer reads them */
+        if (buffer_->IsStreaming())
+            GLBuffer::SubmitStreamingFences();
+        offset_ = 0;
+    }
+
+    /* Stream data into the next range and bind it to the uniform-block binding index */
+    buffer_->BufferSubData(offset_, size, data);
+    stateMngr.BindBufferRange(GLBufferTarget::UNIFORM_BUFFER, index, buffer_->GetID(), offset_, size);
+
+    offset_ = GetAlignedSize<GLintptr>(offset_ + size, alignment_);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GLUniformRingBuffer::CreateBuffer()
+{
+    /* Bind offsets must be a multiple of the uniform buffer offset alignment */
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    alignment_ = std::max<GLintptr>(1, static_cast<GLintptr>(alignment));
+
+    buffer_ = MakeUnique<GLBuffer>(BindFlags::ConstantBuffer);
+
+    #ifdef GL_ARB_buffer_storage
+    if (HasExtension(GLExt::ARB_buffer_storage))
+    {
+        /* Allocate persistently mapped storage, so each write goes directly into the buffer */
+        buffer_->BufferStorageStreaming(g_uniformRingBufferSize, nullptr, 0);
+    }
+    else
+    #endif // /GL_ARB_buffer_storage
+    {
+        buffer_->BufferStorage(g_uniformRingBufferSize, nullptr, 0, GL_STREAM_DRAW);
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
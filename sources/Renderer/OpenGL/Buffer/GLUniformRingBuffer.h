@@ -0,0 +1,75 @@
+/*
+ * GLUniformRingBuffer.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_UNIFORM_RING_BUFFER_H
+#define LLGL_GL_UNIFORM_RING_BUFFER_H
+
+
+#include "../OpenGL.h"
+#include <memory>
+
+
+namespace LLGL
+{
+
+
+class GLBuffer;
+class GLStateManager;
+
+/*
+Singleton ring buffer for inline uniforms (see BindingFlags::InlineUniforms); used by <GLCommandBuffer::SetUniforms>.
+The values of each uniform block are streamed into a new range of this buffer, which is then bound with a single 'glBindBufferRange' call.
+With GL_ARB_buffer_storage, the buffer is persistently mapped and its ranges are guarded by the fences of streaming buffers (see MiscFlags::Streaming).
+*/
+class GLUniformRingBuffer
+{
+
+    public:
+
+        // Returns the instance of this singleton.
+        static GLUniformRingBuffer& Get();
+
+    public:
+
+        GLUniformRingBuffer(const GLUniformRingBuffer&) = delete;
+        GLUniformRingBuffer& operator = (const GLUniformRingBuffer&) = delete;
+
+        GLUniformRingBuffer(GLUniformRingBuffer&&) = delete;
+        GLUniformRingBuffer& operator = (GLUniformRingBuffer&&) = delete;
+
+        ~GLUniformRingBuffer();
+
+        // Releases the resource for this singleton class.
+        void Clear();
+
+        // Copies the specified data into the next range of the ring buffer and binds that range to the specified uniform-block binding index.
+        void BindUniformBlock(GLStateManager& stateMngr, GLuint index, const void* data, GLsizeiptr size);
+
+    private:
+
+        GLUniformRingBuffer();
+
+        // Creates the ring buffer and queries the uniform buffer offset alignment.
+        void CreateBuffer();
+
+    private:
+
+        std::unique_ptr<GLBuffer>   buffer_;
+        GLintptr                    offset_     = 0;
+        GLintptr                    alignment_  = 1;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,61 @@
+/*
+ * GLVertexArrayFormat.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLVertexArrayFormat.h"
+#include "../RenderState/GLStateManager.h"
+#include "../../../Core/HelperMacros.h"
+#include <LLGL/VertexAttribute.h>
+
+
+namespace LLGL
+{
+
+
+GLVertexArrayFormat::GLVertexArrayFormat(const AttributeList& attribs) :
+    attribs_ { attribs }
+{
+    /* Build attribute formats inside the new VAO */
+    vao_.Create();
+    GLStateManager::Get().BindVertexArray(vao_.GetID());
+    {
+        for (const auto& attrib : attribs_)
+        {
+            VertexAttribute vertexAttrib;
+            {
+                vertexAttrib.location           = attrib.location;
+                vertexAttrib.format             = attrib.format;
+                vertexAttrib.instanceDivisor    = attrib.divisor;
+            }
+            vao_.BuildVertexAttributeFormat(vertexAttrib);
+        }
+    }
+    GLStateManager::Get().BindVertexArray(0);
+}
+
+int GLVertexArrayFormat::CompareSWO(const GLVertexArrayFormat& lhs, const GLVertexArrayFormat& rhs)
+{
+    return GLVertexArrayFormat::CompareSWO(lhs, rhs.attribs_);
+}
+
+int GLVertexArrayFormat::CompareSWO(const GLVertexArrayFormat& lhs, const AttributeList& rhs)
+{
+    LLGL_COMPARE_SEPARATE_MEMBERS_SWO(lhs.attribs_.size(), rhs.size());
+    for (std::size_t i = 0, n = rhs.size(); i < n; ++i)
+    {
+        LLGL_COMPARE_SEPARATE_MEMBERS_SWO(lhs.attribs_[i].location, rhs[i].location);
+        LLGL_COMPARE_SEPARATE_MEMBERS_SWO(lhs.attribs_[i].format,   rhs[i].format  );
+        LLGL_COMPARE_SEPARATE_MEMBERS_SWO(lhs.attribs_[i].divisor,  rhs[i].divisor );
+    }
+    return 0;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,75 @@
+/*
+ * GLVertexArrayFormat.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_VERTEX_ARRAY_FORMAT_H
+#define LLGL_GL_VERTEX_ARRAY_FORMAT_H
+
+
+#include "GLVertexArrayObject.h"
+#include <LLGL/Format.h>
+#include <memory>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+Vertex-Array-Object (VAO) that only stores the formats of its vertex attributes but no vertex buffers (for GL_ARB_vertex_attrib_binding).
+All vertex arrays with the same vertex format share the same VAO, which is managed by the GLStatePool.
+*/
+class GLVertexArrayFormat
+{
+
+    public:
+
+        // Vertex attribute properties that are stored in the VAO. Offsets and strides are specified with the vertex buffer bindings.
+        struct Attribute
+        {
+            GLuint  location;
+            Format  format;
+            GLuint  divisor;
+        };
+
+        // List of vertex attributes in ascending order of their locations.
+        using AttributeList = std::vector<Attribute>;
+
+    public:
+
+        GLVertexArrayFormat(const AttributeList& attribs);
+
+        // Returns the ID of the hardware vertex-array-object (VAO).
+        inline GLuint GetID() const
+        {
+            return vao_.GetID();
+        }
+
+    public:
+
+        // Returns a signed integer of the strict-weak-order (SWO) comparison, and 0 on equality.
+        static int CompareSWO(const GLVertexArrayFormat& lhs, const GLVertexArrayFormat& rhs);
+        static int CompareSWO(const GLVertexArrayFormat& lhs, const AttributeList& rhs);
+
+    private:
+
+        AttributeList       attribs_;
+        GLVertexArrayObject vao_;
+
+};
+
+using GLVertexArrayFormatSPtr = std::shared_ptr<GLVertexArrayFormat>;
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -19,21 +19,21 @@ namespace LLGL
 {
 
 
-GLVertexArrayObject::GLVertexArrayObject()
-{
-    if (HasNativeVAO())
-        glGenVertexArrays(1, &id_);
-}
-
 GLVertexArrayObject::~GLVertexArrayObject()
 {
-    if (HasNativeVAO())
+    if (id_ != 0)
     {
         glDeleteVertexArrays(1, &id_);
         GLStateManager::Get().NotifyVertexArrayRelease(id_);
     }
 }
 
+void GLVertexArrayObject::Create()
+{
+    if (id_ == 0 && HasNativeVAO())
+        glGenVertexArrays(1, &id_);
+}
+
 void GLVertexArrayObject::BuildVertexAttribute(const VertexAttribute& attribute)
 {
     if (!HasNativeVAO())
@@ -45,7 +45,7 @@ void GLVertexArrayObject::BuildVertexAttribute(const VertexAttribute& attribute)
         ThrowNotSupportedExcept(__FUNCTION__, "specified vertex attribute");
 
     /* Convert offset to pointer sized type (for 32- and 64 bit builds) */
-    auto dataType       = GLTypes::Map(formatAttribs.dataType);
+    auto dataType       = GLTypes::ToVertexAttribType(attribute.format);
     auto components     = static_cast<GLint>(formatAttribs.components);
     auto attribIndex    = static_cast<GLuint>(attribute.location);
     auto stride         = static_cast<GLsizei>(attribute.stride);
@@ -88,6 +88,42 @@ void GLVertexArrayObject::BuildVertexAttribute(const VertexAttribute& attribute)
 }
 
 
+void GLVertexArrayObject::BuildVertexAttributeFormat(const VertexAttribute& attribute)
+{
+    #ifdef LLGL_GLEXT_VERTEX_ATTRIB_BINDING
+
+    if (!HasExtension(GLExt::ARB_vertex_attrib_binding))
+        ThrowNotSupportedExcept(__FUNCTION__, "OpenGL extension 'GL_ARB_vertex_attrib_binding'");
+
+    /* Get data type and components of vector type */
+    const auto& formatAttribs = GetFormatAttribs(attribute.format);
+    if ((formatAttribs.flags & FormatFlags::SupportsVertex) == 0)
+        ThrowNotSupportedExcept(__FUNCTION__, "specified vertex attribute");
+
+    auto dataType       = GLTypes::ToVertexAttribType(attribute.format);
+    auto components     = static_cast<GLint>(formatAttribs.components);
+    auto attribIndex    = static_cast<GLuint>(attribute.location);
+
+    /* Enable array index in currently bound VAO */
+    glEnableVertexAttribArray(attribIndex);
+
+    /* Specify attribute format with zero relative offset; the attribute offset is specified by the vertex buffer binding */
+    if ((formatAttribs.flags & FormatFlags::IsNormalized) == 0 && !IsFloatFormat(attribute.format))
+        glVertexAttribIFormat(attribIndex, components, dataType, 0);
+    else
+        glVertexAttribFormat(attribIndex, components, dataType, GLBoolean((formatAttribs.flags & FormatFlags::IsNormalized) != 0), 0);
+
+    /* Use the attribute location as binding index and set instance divisor */
+    glVertexAttribBinding(attribIndex, attribIndex);
+    glVertexBindingDivisor(attribIndex, attribute.instanceDivisor);
+
+    #else
+
+    ThrowNotSupportedExcept(__FUNCTION__, "OpenGL extension 'GL_ARB_vertex_attrib_binding'");
+
+    #endif // /LLGL_GLEXT_VERTEX_ATTRIB_BINDING
+}
+
 } // /namespace LLGL
 
 
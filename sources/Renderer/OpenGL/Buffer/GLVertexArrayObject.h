@@ -24,12 +24,24 @@ class GLVertexArrayObject
 
     public:
 
-        GLVertexArrayObject();
+        GLVertexArrayObject() = default;
         ~GLVertexArrayObject();
 
+        GLVertexArrayObject(const GLVertexArrayObject&) = delete;
+        GLVertexArrayObject& operator = (const GLVertexArrayObject&) = delete;
+
+        // Generates the hardware VAO if it has not been generated yet. VAOs are only generated when they are actually needed.
+        void Create();
+
         // Builds the specified attribute using a 'glVertexAttrib*Pointer' function.
         void BuildVertexAttribute(const VertexAttribute& attribute);
 
+        /*
+        Builds only the format of the specified attribute using a 'glVertexAttrib*Format' function (for GL_ARB_vertex_attrib_binding).
+        The attribute uses the binding index of its location, so the vertex buffer, offset, and stride can be specified per attribute with 'glBindVertexBuffer'.
+        */
+        void BuildVertexAttributeFormat(const VertexAttribute& attribute);
+
         // Returns the ID of the hardware vertex-array-object (VAO)
         inline GLuint GetID() const
         {
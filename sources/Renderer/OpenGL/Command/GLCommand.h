@@ -31,6 +31,7 @@ class GLSwapChain;
 class GLRenderTarget;
 class GLRenderPass;
 class GLDeferredCommandBuffer;
+class GLSharedVertexArray;
 #ifdef LLGL_GL_ENABLE_OPENGL2X
 class GL2XVertexArray;
 class GL2XSampler;
@@ -163,6 +164,17 @@ struct GLCmdClearAttachmentsWithRenderPass
 //  const ClearValue*   clearValues[numClearValues];
 };
 
+struct GLCmdInvalidateAttachmentsWithRenderPass
+{
+    const GLRenderPass* renderPass;
+};
+
+struct GLCmdBindSubpass
+{
+    const GLRenderPass* renderPass;
+    std::uint32_t       subpass;
+};
+
 struct GLCmdClearBuffers
 {
     std::uint32_t   numAttachments;
@@ -174,6 +186,11 @@ struct GLCmdBindVertexArray
     GLuint vao;
 };
 
+struct GLCmdBindSharedVertexArray
+{
+    const GLSharedVertexArray* sharedVertexArray;
+};
+
 #ifdef LLGL_GL_ENABLE_OPENGL2X
 struct GLCmdBindGL2XVertexArray
 {
@@ -252,6 +269,13 @@ struct GLCmdSetUniforms
 //  GLuint      buffer[size];
 };
 
+struct GLCmdBindInlineUniformBlock
+{
+    GLuint      index;
+    GLsizeiptr  size;
+//  GLuint      buffer[size];
+};
+
 struct GLCmdBeginQuery
 {
     GLQueryHeap*    queryHeap;
@@ -272,16 +296,29 @@ struct GLCmdBeginConditionalRender
 
 //struct GLCmdEndConditionalRender {};
 
+/*
+Draw mode and index type of all subsequent direct draw commands.
+They only change with the pipeline state and index buffer, so they are not repeated in every draw command.
+*/
+struct GLCmdSetDrawMode
+{
+    GLenum mode;
+    GLenum type;
+};
+
+/*
+The direct draw commands below only store their arguments; the mode and index type are taken from the last GLCmdSetDrawMode command.
+The index offset is stored first to avoid padding between the 32-bit arguments.
+*/
+
 struct GLCmdDrawArrays
 {
-    GLenum  mode;
     GLint   first;
     GLsizei count;
 };
 
 struct GLCmdDrawArraysInstanced
 {
-    GLenum  mode;
     GLint   first;
     GLsizei count;
     GLsizei instancecount;
@@ -289,7 +326,6 @@ struct GLCmdDrawArraysInstanced
 
 struct GLCmdDrawArraysInstancedBaseInstance
 {
-    GLenum  mode;
     GLint   first;
     GLsizei count;
     GLsizei instancecount;
@@ -307,46 +343,36 @@ struct GLCmdDrawArraysIndirect
 
 struct GLCmdDrawElements
 {
-    GLenum          mode;
-    GLsizei         count;
-    GLenum          type;
     const GLvoid*   indices;
+    GLsizei         count;
 };
 
 struct GLCmdDrawElementsBaseVertex
 {
-    GLenum          mode;
-    GLsizei         count;
-    GLenum          type;
     const GLvoid*   indices;
+    GLsizei         count;
     GLint           basevertex;
 };
 
 struct GLCmdDrawElementsInstanced
 {
-    GLenum          mode;
-    GLsizei         count;
-    GLenum          type;
     const GLvoid*   indices;
+    GLsizei         count;
     GLsizei         instancecount;
 };
 
 struct GLCmdDrawElementsInstancedBaseVertex
 {
-    GLenum          mode;
-    GLsizei         count;
-    GLenum          type;
     const GLvoid*   indices;
+    GLsizei         count;
     GLsizei         instancecount;
     GLint           basevertex;
 };
 
 struct GLCmdDrawElementsInstancedBaseVertexBaseInstance
 {
-    GLenum          mode;
-    GLsizei         count;
-    GLenum          type;
     const GLvoid*   indices;
+    GLsizei         count;
     GLsizei         instancecount;
     GLint           basevertex;
     GLuint          baseinstance;
@@ -381,6 +407,29 @@ struct GLCmdMultiDrawElementsIndirect
     GLsizei         stride;
 };
 
+struct GLCmdMultiDrawArraysIndirectCount
+{
+    GLuint          id;
+    GLuint          countId;
+    GLenum          mode;
+    GLintptr        indirect;
+    GLintptr        drawcount;
+    GLsizei         maxdrawcount;
+    GLsizei         stride;
+};
+
+struct GLCmdMultiDrawElementsIndirectCount
+{
+    GLuint          id;
+    GLuint          countId;
+    GLenum          mode;
+    GLenum          type;
+    GLintptr        indirect;
+    GLintptr        drawcount;
+    GLsizei         maxdrawcount;
+    GLsizei         stride;
+};
+
 struct GLCmdDispatchCompute
 {
     GLuint numgroups[3];
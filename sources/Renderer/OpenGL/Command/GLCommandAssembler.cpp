@@ -32,6 +32,7 @@
 
 #include "../Buffer/GLBufferWithVAO.h"
 #include "../Buffer/GLBufferArrayWithVAO.h"
+#include "../Buffer/GLUniformRingBuffer.h"
 
 #include "../RenderState/GLStateManager.h"
 #include "../RenderState/GLGraphicsPSO.h"
@@ -47,10 +48,26 @@ namespace LLGL
 {
 
 
-static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITCompiler& compiler)
+// Command size to denote that a GL command cannot be assembled
+static const std::size_t g_invalidGLCommandSize = ~0u;
+
+/*
+Trampolines for virtual member functions.
+Pointers to virtual member functions cannot be converted into raw function pointers (see GetMemberFuncPtr).
+*/
+
+static void BindGLPipelineState(GLPipelineState& pipelineState, GLStateManager& stateMngr)
+{
+    /* Apply pending states right away, since the generated draw commands don't flush them */
+    pipelineState.Bind(stateMngr);
+    stateMngr.FlushPendingStates();
+}
+
+static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITCompiler& compiler, GLCmdSetDrawMode& drawMode)
 {
-    /* Declare index of variadic argument of entry point */
-    static const JITVarArg g_stateMngrArg{ 0 };
+    /* Declare index of variadic argument of entry point; its address is passed to commands that can switch the state manager */
+    static const JITVarArg      g_stateMngrArg{ 0 };
+    static const JITVarArgPtr   g_stateMngrArgPtr{ 0 };
 
     /* Generate native CPU opcodes for emulated GLOpcode */
     switch (opcode)
@@ -178,14 +195,27 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
         case GLOpcodeClearAttachmentsWithRenderPass:
         {
             auto cmd = reinterpret_cast<const GLCmdClearAttachmentsWithRenderPass*>(pc);
-            compiler.CallMember(&GLStateManager::ClearAttachmentsWithRenderPass, g_stateMngrArg, cmd->renderPass, cmd->numClearValues, (cmd + 1));
+            if (cmd->renderPass != nullptr)
+                compiler.CallMember(&GLStateManager::ClearAttachmentsWithRenderPass, g_stateMngrArg, cmd->renderPass, cmd->numClearValues, (cmd + 1));
             return (sizeof(*cmd) + sizeof(ClearValue)*cmd->numClearValues);
         }
+        case GLOpcodeInvalidateAttachmentsWithRenderPass:
+        {
+            auto cmd = reinterpret_cast<const GLCmdInvalidateAttachmentsWithRenderPass*>(pc);
+            compiler.CallMember(&GLStateManager::InvalidateAttachmentsWithRenderPass, g_stateMngrArg, cmd->renderPass);
+            return sizeof(*cmd);
+        }
+        case GLOpcodeBindSubpass:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindSubpass*>(pc);
+            compiler.CallMember(&GLStateManager::BindSubpass, g_stateMngrArg, cmd->renderPass, cmd->subpass);
+            return sizeof(*cmd);
+        }
         case GLOpcodeClearBuffers:
         {
             auto cmd = reinterpret_cast<const GLCmdClearBuffers*>(pc);
             compiler.CallMember(&GLStateManager::ClearBuffers, g_stateMngrArg, cmd->numAttachments, (cmd + 1));
-            return sizeof(*cmd);
+            return (sizeof(*cmd) + sizeof(AttachmentClear)*cmd->numAttachments);
         }
         case GLOpcodeBindVertexArray:
         {
@@ -193,6 +223,12 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
             compiler.CallMember(&GLStateManager::BindVertexArray, g_stateMngrArg, cmd->vao);
             return sizeof(*cmd);
         }
+        case GLOpcodeBindSharedVertexArray:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindSharedVertexArray*>(pc);
+            compiler.CallMember(&GLSharedVertexArray::Bind, cmd->sharedVertexArray, g_stateMngrArg);
+            return sizeof(*cmd);
+        }
         #ifdef LLGL_GL_ENABLE_OPENGL2X
         case GLOpcodeBindGL2XVertexArray:
         {
@@ -225,26 +261,26 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
             compiler.Call(glBeginTransformFeedback, cmd->primitiveMove);
             return sizeof(*cmd);
         }
-        #ifdef GL_NV_transform_feedback
         case GLOpcodeBeginTransformFeedbackNV:
         {
             auto cmd = reinterpret_cast<const GLCmdBeginTransformFeedbackNV*>(pc);
+            #ifdef GL_NV_transform_feedback
             compiler.Call(glBeginTransformFeedbackNV, cmd->primitiveMove);
+            #endif
             return sizeof(*cmd);
         }
-        #endif // /GL_NV_transform_feedback
         case GLOpcodeEndTransformFeedback:
         {
             compiler.Call(glEndTransformFeedback);
             return 0;
         }
-        #ifdef GL_NV_transform_feedback
         case GLOpcodeEndTransformFeedbackNV:
         {
+            #ifdef GL_NV_transform_feedback
             compiler.Call(glEndTransformFeedbackNV);
+            #endif
             return 0;
         }
-        #endif // /GL_NV_transform_feedback
         case GLOpcodeBindResourceHeap:
         {
             auto cmd = reinterpret_cast<const GLCmdBindResourceHeap*>(pc);
@@ -253,18 +289,15 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
         }
         case GLOpcodeBindRenderTarget:
         {
-            //TODO: update reference to GLStateManager
+            /* Binding a swap-chain switches the state manager, so pass the address of the state manager argument for all subsequent commands */
             auto cmd = reinterpret_cast<const GLCmdBindRenderTarget*>(pc);
-            compiler.CallMember(&GLStateManager::BindRenderTarget, g_stateMngrArg, cmd->renderTarget);
+            compiler.CallMember(&GLStateManager::BindRenderTarget, g_stateMngrArg, cmd->renderTarget, g_stateMngrArgPtr);
             return sizeof(*cmd);
         }
         case GLOpcodeBindPipelineState:
         {
             auto cmd = reinterpret_cast<const GLCmdBindPipelineState*>(pc);
-            if (cmd->pipelineState->IsGraphicsPSO())
-                compiler.CallMember(&GLGraphicsPSO::Bind, cmd->pipelineState, g_stateMngrArg);
-            else
-                compiler.CallMember(&GLPipelineState::Bind, cmd->pipelineState, g_stateMngrArg);
+            compiler.Call(BindGLPipelineState, cmd->pipelineState, g_stateMngrArg);
             return sizeof(*cmd);
         }
         case GLOpcodeSetBlendColor:
@@ -285,6 +318,12 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
             compiler.Call(GLSetUniformsByLocation, cmd->program, cmd->location, cmd->count, (cmd + 1));
             return (sizeof(*cmd) + cmd->size);
         }
+        case GLOpcodeBindInlineUniformBlock:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindInlineUniformBlock*>(pc);
+            compiler.CallMember(&GLUniformRingBuffer::BindUniformBlock, &(GLUniformRingBuffer::Get()), g_stateMngrArg, cmd->index, (cmd + 1), cmd->size);
+            return (sizeof(*cmd) + cmd->size);
+        }
         case GLOpcodeBeginQuery:
         {
             auto cmd = reinterpret_cast<const GLCmdBeginQuery*>(pc);
@@ -300,38 +339,50 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
         case GLOpcodeBeginConditionalRender:
         {
             auto cmd = reinterpret_cast<const GLCmdBeginConditionalRender*>(pc);
+            #ifdef LLGL_GLEXT_CONDITIONAL_RENDER
             compiler.Call(glBeginConditionalRender, cmd->id, cmd->mode);
+            #endif
             return sizeof(*cmd);
         }
         case GLOpcodeEndConditionalRender:
         {
+            #ifdef LLGL_GLEXT_CONDITIONAL_RENDER
             compiler.Call(glEndConditionalRender);
+            #endif
             return 0;
         }
+        case GLOpcodeSetDrawMode:
+        {
+            /* Draw mode is only tracked while assembling; subsequent draw commands pass it as immediate argument */
+            auto cmd = reinterpret_cast<const GLCmdSetDrawMode*>(pc);
+            drawMode = *cmd;
+            return sizeof(*cmd);
+        }
         case GLOpcodeDrawArrays:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawArrays*>(pc);
-            compiler.Call(glDrawArrays, cmd->mode, cmd->first, cmd->count);
+            compiler.Call(glDrawArrays, drawMode.mode, cmd->first, cmd->count);
             return sizeof(*cmd);
         }
         case GLOpcodeDrawArraysInstanced:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawArraysInstanced*>(pc);
-            compiler.Call(glDrawArraysInstanced, cmd->mode, cmd->first, cmd->count, cmd->instancecount);
+            compiler.Call(glDrawArraysInstanced, drawMode.mode, cmd->first, cmd->count, cmd->instancecount);
             return sizeof(*cmd);
         }
-        #ifdef GL_ARB_base_instance
         case GLOpcodeDrawArraysInstancedBaseInstance:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawArraysInstancedBaseInstance*>(pc);
-            compiler.Call(glDrawArraysInstancedBaseInstance, cmd->mode, cmd->first, cmd->count, cmd->instancecount, cmd->baseinstance);
+            #ifdef LLGL_GLEXT_BASE_INSTANCE
+            compiler.Call(glDrawArraysInstancedBaseInstance, drawMode.mode, cmd->first, cmd->count, cmd->instancecount, cmd->baseinstance);
+            #endif
             return sizeof(*cmd);
         }
-        #endif // /GL_ARB_base_instance
         case GLOpcodeDrawArraysIndirect:
         {
             //TODO: generate loop in ASM
             auto cmd = reinterpret_cast<const GLCmdDrawArraysIndirect*>(pc);
+            #ifdef LLGL_GLEXT_DRAW_INDIRECT
             compiler.CallMember(&GLStateManager::BindBuffer, g_stateMngrArg, GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
             GLintptr offset = cmd->indirect;
             for (std::uint32_t i = 0; i < cmd->numCommands; ++i)
@@ -339,43 +390,49 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
                 compiler.Call(glDrawArraysIndirect, cmd->mode, reinterpret_cast<const GLvoid*>(offset));
                 offset += cmd->stride;
             }
+            #endif
             return sizeof(*cmd);
         }
         case GLOpcodeDrawElements:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElements*>(pc);
-            compiler.Call(glDrawElements, cmd->mode, cmd->count, cmd->type, cmd->indices);
+            compiler.Call(glDrawElements, drawMode.mode, cmd->count, drawMode.type, cmd->indices);
             return sizeof(*cmd);
         }
         case GLOpcodeDrawElementsBaseVertex:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElementsBaseVertex*>(pc);
-            compiler.Call(glDrawElementsBaseVertex, cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->basevertex);
+            #ifdef LLGL_GLEXT_DRAW_ELEMENTS_BASE_VERTEX
+            compiler.Call(glDrawElementsBaseVertex, drawMode.mode, cmd->count, drawMode.type, cmd->indices, cmd->basevertex);
+            #endif
             return sizeof(*cmd);
         }
         case GLOpcodeDrawElementsInstanced:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElementsInstanced*>(pc);
-            compiler.Call(glDrawElementsInstanced, cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount);
+            compiler.Call(glDrawElementsInstanced, drawMode.mode, cmd->count, drawMode.type, cmd->indices, cmd->instancecount);
             return sizeof(*cmd);
         }
         case GLOpcodeDrawElementsInstancedBaseVertex:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElementsInstancedBaseVertex*>(pc);
-            compiler.Call(glDrawElementsInstancedBaseVertex, cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount, cmd->basevertex);
+            #ifdef LLGL_GLEXT_DRAW_ELEMENTS_BASE_VERTEX
+            compiler.Call(glDrawElementsInstancedBaseVertex, drawMode.mode, cmd->count, drawMode.type, cmd->indices, cmd->instancecount, cmd->basevertex);
+            #endif
             return sizeof(*cmd);
         }
-        #ifdef GL_ARB_base_instance
         case GLOpcodeDrawElementsInstancedBaseVertexBaseInstance:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElementsInstancedBaseVertexBaseInstance*>(pc);
-            compiler.Call(glDrawElementsInstancedBaseVertexBaseInstance, cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount, cmd->basevertex, cmd->baseinstance);
+            #ifdef LLGL_GLEXT_BASE_INSTANCE
+            compiler.Call(glDrawElementsInstancedBaseVertexBaseInstance, drawMode.mode, cmd->count, drawMode.type, cmd->indices, cmd->instancecount, cmd->basevertex, cmd->baseinstance);
+            #endif
             return sizeof(*cmd);
         }
-        #endif // /GL_ARB_base_instance
         case GLOpcodeDrawElementsIndirect:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElementsIndirect*>(pc);
+            #ifdef LLGL_GLEXT_DRAW_INDIRECT
             {
                 //TODO: generate loop in ASM
                 compiler.CallMember(&GLStateManager::BindBuffer, g_stateMngrArg, GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
@@ -386,39 +443,56 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
                     offset += cmd->stride;
                 }
             }
+            #endif
             return sizeof(*cmd);
         }
-        #ifdef GL_ARB_multi_draw_indirect
         case GLOpcodeMultiDrawArraysIndirect:
         {
             auto cmd = reinterpret_cast<const GLCmdMultiDrawArraysIndirect*>(pc);
+            #ifdef LLGL_GLEXT_MULTI_DRAW_INDIRECT
             compiler.CallMember(&GLStateManager::BindBuffer, g_stateMngrArg, GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
             compiler.Call(glMultiDrawArraysIndirect, cmd->mode, cmd->indirect, cmd->drawcount, cmd->stride);
+            #endif
             return sizeof(*cmd);
         }
         case GLOpcodeMultiDrawElementsIndirect:
         {
             auto cmd = reinterpret_cast<const GLCmdMultiDrawElementsIndirect*>(pc);
+            #ifdef LLGL_GLEXT_MULTI_DRAW_INDIRECT
             compiler.CallMember(&GLStateManager::BindBuffer, g_stateMngrArg, GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
             compiler.Call(glMultiDrawElementsIndirect, cmd->mode, cmd->type, cmd->indirect, cmd->drawcount, cmd->stride);
+            #endif
+            return sizeof(*cmd);
+        }
+        case GLOpcodeMultiDrawArraysIndirectCount:
+        {
+            auto cmd = reinterpret_cast<const GLCmdMultiDrawArraysIndirectCount*>(pc);
+            compiler.Call(ExecuteGLMultiDrawArraysIndirectCount, cmd, g_stateMngrArg);
+            return sizeof(*cmd);
+        }
+        case GLOpcodeMultiDrawElementsIndirectCount:
+        {
+            auto cmd = reinterpret_cast<const GLCmdMultiDrawElementsIndirectCount*>(pc);
+            compiler.Call(ExecuteGLMultiDrawElementsIndirectCount, cmd, g_stateMngrArg);
             return sizeof(*cmd);
         }
-        #endif // /GL_ARB_multi_draw_indirect
-        #ifdef GL_ARB_compute_shader
         case GLOpcodeDispatchCompute:
         {
             auto cmd = reinterpret_cast<const GLCmdDispatchCompute*>(pc);
+            #ifdef LLGL_GLEXT_COMPUTE_SHADER
             compiler.Call(glDispatchCompute, cmd->numgroups[0], cmd->numgroups[1], cmd->numgroups[2]);
+            #endif
             return sizeof(*cmd);
         }
         case GLOpcodeDispatchComputeIndirect:
         {
             auto cmd = reinterpret_cast<const GLCmdDispatchComputeIndirect*>(pc);
+            #ifdef LLGL_GLEXT_COMPUTE_SHADER
             compiler.CallMember(&GLStateManager::BindBuffer, g_stateMngrArg, GLBufferTarget::DISPATCH_INDIRECT_BUFFER, cmd->id);
             compiler.Call(glDispatchComputeIndirect, cmd->indirect);
+            #endif
             return sizeof(*cmd);
         }
-        #endif // /GL_ARB_compute_shader
         case GLOpcodeBindTexture:
         {
             auto cmd = reinterpret_cast<const GLCmdBindTexture*>(pc);
@@ -463,21 +537,23 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
                 compiler.CallMember(&GLStateManager::UnbindSamplers, g_stateMngrArg, cmd->first, cmd->count);
             return sizeof(*cmd);
         }
-        #ifdef GL_KHR_debug
         case GLOpcodePushDebugGroup:
         {
             auto cmd = reinterpret_cast<const GLCmdPushDebugGroup*>(pc);
+            #ifdef LLGL_GLEXT_DEBUG
             compiler.Call(glPushDebugGroup, cmd->source, cmd->id, cmd->length, reinterpret_cast<const GLchar*>(cmd + 1));
+            #endif
             return (sizeof(*cmd) + cmd->length + 1);
         }
         case GLOpcodePopDebugGroup:
         {
+            #ifdef LLGL_GLEXT_DEBUG
             compiler.Call(glPopDebugGroup);
+            #endif
             return 0;
         }
-        #endif // /GL_KHR_debug
         default:
-            return 0;
+            return g_invalidGLCommandSize;
     }
 }
 
@@ -511,6 +587,7 @@ std::unique_ptr<JITProgram> AssembleGLDeferredCommandBuffer(const GLDeferredComm
 
         /* Initialize program counter to execute virtual GL commands */
         const auto& virtualCmdBuffer = cmdBuffer.GetVirtualCommandBuffer();
+        GLCmdSetDrawMode drawMode = { GL_TRIANGLES, GL_UNSIGNED_INT };
 
         for (const auto& chunk : virtualCmdBuffer)
         {
@@ -523,8 +600,12 @@ std::unique_ptr<JITProgram> AssembleGLDeferredCommandBuffer(const GLDeferredComm
                 const GLOpcode opcode = *reinterpret_cast<const GLOpcode*>(pc);
                 pc += sizeof(GLOpcode);
 
-                /* Execute command and increment program counter */
-                pc += AssembleGLCommand(opcode, pc, *compiler);
+                /* Assemble command and increment program counter; fall back to emulated execution for unknown commands */
+                const auto cmdSize = AssembleGLCommand(opcode, pc, *compiler, drawMode);
+                if (cmdSize == g_invalidGLCommandSize)
+                    return nullptr;
+
+                pc += cmdSize;
             }
         }
 
@@ -7,6 +7,10 @@
 
 #include "GLCommandBuffer.h"
 #include "../RenderState/GLState.h"
+#include "../RenderState/GLPipelineLayout.h"
+#include "../Ext/GLExtensionRegistry.h"
+#include <algorithm>
+#include <string.h>
 
 
 namespace LLGL
@@ -29,6 +33,33 @@ void GLCommandBuffer::SetIndexFormat(GLRenderState& renderState, bool indexType1
     renderState.indexBufferOffset = static_cast<GLsizeiptr>(offset);
 }
 
+void GLCommandBuffer::SetInlineUniforms(const GLPipelineLayout& pipelineLayout, std::uint32_t first, const void* data, std::uint32_t dataSize)
+{
+    const auto numValues = pipelineLayout.GetNumInlineUniformValues();
+    if (first >= numValues)
+        return;
+
+    /* Copy values into shadow storage, so values that are not specified keep their previous values */
+    if (inlineUniformValues_.size() < numValues)
+        inlineUniformValues_.resize(numValues, 0u);
+
+    const auto last = std::min(first + dataSize / 4, numValues);
+    ::memcpy(&inlineUniformValues_[first], data, (last - first) * 4);
+
+    /* Bind all values of each uniform block that overlaps with the specified range */
+    for (const auto& uniforms : pipelineLayout.GetInlineUniforms())
+    {
+        if (uniforms.count > 0 && uniforms.first < last && first < uniforms.first + uniforms.count)
+        {
+            BindInlineUniformBlock(
+                uniforms.slot,
+                &inlineUniformValues_[uniforms.first],
+                static_cast<GLsizeiptr>(uniforms.count * 4)
+            );
+        }
+    }
+}
+
 /* ----- Extensions ----- */
 
 void GLCommandBuffer::SetGraphicsAPIDependentState(const void* stateDesc, std::size_t stateDescSize)
@@ -37,6 +68,19 @@ void GLCommandBuffer::SetGraphicsAPIDependentState(const void* stateDesc, std::s
 }
 
 
+bool GLCommandBuffer::BeginRenderConditionMode(const RenderConditionMode mode)
+{
+    renderConditionActive_ = (mode < RenderConditionMode::WaitInverted || HasExtension(GLExt::ARB_conditional_render_inverted));
+    return renderConditionActive_;
+}
+
+bool GLCommandBuffer::EndRenderConditionMode()
+{
+    const bool wasActive = renderConditionActive_;
+    renderConditionActive_ = false;
+    return wasActive;
+}
+
 } // /namespace LLGL
 
 
@@ -10,6 +10,9 @@
 
 
 #include <LLGL/CommandBuffer.h>
+#include "../OpenGL.h"
+#include <cstdint>
+#include <vector>
 
 
 namespace LLGL
@@ -18,6 +21,7 @@ namespace LLGL
 
 struct GLRenderState;
 struct GLClearValue;
+class GLPipelineLayout;
 
 class GLCommandBuffer : public CommandBuffer
 {
@@ -38,6 +42,29 @@ class GLCommandBuffer : public CommandBuffer
         // Configures the attributes of 'renderState' for the type of index buffers.
         void SetIndexFormat(GLRenderState& renderState, bool indexType16Bits, std::uint64_t offset);
 
+        /*
+        Writes the specified 32-bit values into the inline uniforms of the pipeline layout, starting at the 32-bit value 'first' (see BindingFlags::InlineUniforms).
+        For each uniform block these values overlap with, 'BindInlineUniformBlock' is called with all values of that block.
+        */
+        void SetInlineUniforms(const GLPipelineLayout& pipelineLayout, std::uint32_t first, const void* data, std::uint32_t dataSize);
+
+        // Streams the values of an inline uniform block into the uniform ring buffer and binds that range to the specified uniform-block binding index.
+        virtual void BindInlineUniformBlock(GLuint index, const void* data, GLsizeiptr size) = 0;
+
+        /*
+        Returns true if a conditional render block must be started for the specified mode.
+        Inverted modes require GL 4.5 or GL_ARB_conditional_render_inverted; otherwise the condition is ignored and no draw commands are skipped.
+        */
+        bool BeginRenderConditionMode(const RenderConditionMode mode);
+
+        // Returns true if a conditional render block has been started with the previous call to 'BeginRenderConditionMode' that must be ended.
+        bool EndRenderConditionMode();
+
+    private:
+
+        std::vector<std::uint32_t>  inlineUniformValues_;                  // Values of all inline uniforms that have been set in this command buffer
+        bool                        renderConditionActive_  = false;
+
 };
 
 
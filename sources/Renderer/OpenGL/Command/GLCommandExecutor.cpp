@@ -27,12 +27,14 @@
 
 #include "../Buffer/GLBufferWithVAO.h"
 #include "../Buffer/GLBufferArrayWithVAO.h"
+#include "../Buffer/GLUniformRingBuffer.h"
 
 #include "../RenderState/GLStateManager.h"
 #include "../RenderState/GLPipelineState.h"
 #include "../RenderState/GLResourceHeap.h"
 #include "../RenderState/GLRenderPass.h"
 #include "../RenderState/GLQueryHeap.h"
+#include "../../../Core/ProfilerZone.h"
 
 #include <LLGL/StaticLimits.h>
 #include <algorithm>
@@ -47,8 +49,12 @@ namespace LLGL
 {
 
 
-static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLStateManager*& stateMngr)
+static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLStateManager*& stateMngr, GLCmdSetDrawMode& drawMode)
 {
+    /* Apply pending fixed-function states before any draw command */
+    if (opcode >= GLOpcodeDrawArrays && opcode <= GLOpcodeMultiDrawElementsIndirectCount)
+        stateMngr->FlushPendingStates();
+
     switch (opcode)
     {
         case GLOpcodeBufferSubData:
@@ -178,6 +184,18 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
                 stateMngr->ClearAttachmentsWithRenderPass(*(cmd->renderPass), cmd->numClearValues, reinterpret_cast<const ClearValue*>(cmd + 1));
             return (sizeof(*cmd) + sizeof(ClearValue)*cmd->numClearValues);
         }
+        case GLOpcodeInvalidateAttachmentsWithRenderPass:
+        {
+            auto cmd = reinterpret_cast<const GLCmdInvalidateAttachmentsWithRenderPass*>(pc);
+            stateMngr->InvalidateAttachmentsWithRenderPass(*(cmd->renderPass));
+            return sizeof(*cmd);
+        }
+        case GLOpcodeBindSubpass:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindSubpass*>(pc);
+            stateMngr->BindSubpass(cmd->renderPass, cmd->subpass);
+            return sizeof(*cmd);
+        }
         case GLOpcodeClearBuffers:
         {
             auto cmd = reinterpret_cast<const GLCmdClearBuffers*>(pc);
@@ -190,6 +208,12 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             stateMngr->BindVertexArray(cmd->vao);
             return sizeof(*cmd);
         }
+        case GLOpcodeBindSharedVertexArray:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindSharedVertexArray*>(pc);
+            cmd->sharedVertexArray->Bind(*stateMngr);
+            return sizeof(*cmd);
+        }
         #ifdef LLGL_GL_ENABLE_OPENGL2X
         case GLOpcodeBindGL2XVertexArray:
         {
@@ -280,6 +304,12 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             GLSetUniformsByLocation(cmd->program, cmd->location, cmd->count, (cmd + 1));
             return (sizeof(*cmd) + cmd->size);
         }
+        case GLOpcodeBindInlineUniformBlock:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindInlineUniformBlock*>(pc);
+            GLUniformRingBuffer::Get().BindUniformBlock(*stateMngr, cmd->index, (cmd + 1), cmd->size);
+            return (sizeof(*cmd) + cmd->size);
+        }
         case GLOpcodeBeginQuery:
         {
             auto cmd = reinterpret_cast<const GLCmdBeginQuery*>(pc);
@@ -307,23 +337,29 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             #endif
             return 0;
         }
+        case GLOpcodeSetDrawMode:
+        {
+            auto cmd = reinterpret_cast<const GLCmdSetDrawMode*>(pc);
+            drawMode = *cmd;
+            return sizeof(*cmd);
+        }
         case GLOpcodeDrawArrays:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawArrays*>(pc);
-            glDrawArrays(cmd->mode, cmd->first, cmd->count);
+            glDrawArrays(drawMode.mode, cmd->first, cmd->count);
             return sizeof(*cmd);
         }
         case GLOpcodeDrawArraysInstanced:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawArraysInstanced*>(pc);
-            glDrawArraysInstanced(cmd->mode, cmd->first, cmd->count, cmd->instancecount);
+            glDrawArraysInstanced(drawMode.mode, cmd->first, cmd->count, cmd->instancecount);
             return sizeof(*cmd);
         }
         case GLOpcodeDrawArraysInstancedBaseInstance:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawArraysInstancedBaseInstance*>(pc);
             #ifdef LLGL_GLEXT_BASE_INSTANCE
-            glDrawArraysInstancedBaseInstance(cmd->mode, cmd->first, cmd->count, cmd->instancecount, cmd->baseinstance);
+            glDrawArraysInstancedBaseInstance(drawMode.mode, cmd->first, cmd->count, cmd->instancecount, cmd->baseinstance);
             #endif
             return sizeof(*cmd);
         }
@@ -344,28 +380,28 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
         case GLOpcodeDrawElements:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElements*>(pc);
-            glDrawElements(cmd->mode, cmd->count, cmd->type, cmd->indices);
+            glDrawElements(drawMode.mode, cmd->count, drawMode.type, cmd->indices);
             return sizeof(*cmd);
         }
         case GLOpcodeDrawElementsBaseVertex:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElementsBaseVertex*>(pc);
             #ifdef LLGL_GLEXT_DRAW_ELEMENTS_BASE_VERTEX
-            glDrawElementsBaseVertex(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->basevertex);
+            glDrawElementsBaseVertex(drawMode.mode, cmd->count, drawMode.type, cmd->indices, cmd->basevertex);
             #endif
             return sizeof(*cmd);
         }
         case GLOpcodeDrawElementsInstanced:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElementsInstanced*>(pc);
-            glDrawElementsInstanced(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount);
+            glDrawElementsInstanced(drawMode.mode, cmd->count, drawMode.type, cmd->indices, cmd->instancecount);
             return sizeof(*cmd);
         }
         case GLOpcodeDrawElementsInstancedBaseVertex:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElementsInstancedBaseVertex*>(pc);
             #ifdef LLGL_GLEXT_DRAW_ELEMENTS_BASE_VERTEX
-            glDrawElementsInstancedBaseVertex(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount, cmd->basevertex);
+            glDrawElementsInstancedBaseVertex(drawMode.mode, cmd->count, drawMode.type, cmd->indices, cmd->instancecount, cmd->basevertex);
             #endif
             return sizeof(*cmd);
         }
@@ -373,7 +409,7 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElementsInstancedBaseVertexBaseInstance*>(pc);
             #ifdef LLGL_GLEXT_BASE_INSTANCE
-            glDrawElementsInstancedBaseVertexBaseInstance(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount, cmd->basevertex, cmd->baseinstance);
+            glDrawElementsInstancedBaseVertexBaseInstance(drawMode.mode, cmd->count, drawMode.type, cmd->indices, cmd->instancecount, cmd->basevertex, cmd->baseinstance);
             #endif
             return sizeof(*cmd);
         }
@@ -409,6 +445,18 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             #endif
             return sizeof(*cmd);
         }
+        case GLOpcodeMultiDrawArraysIndirectCount:
+        {
+            auto cmd = reinterpret_cast<const GLCmdMultiDrawArraysIndirectCount*>(pc);
+            ExecuteGLMultiDrawArraysIndirectCount(*cmd, *stateMngr);
+            return sizeof(*cmd);
+        }
+        case GLOpcodeMultiDrawElementsIndirectCount:
+        {
+            auto cmd = reinterpret_cast<const GLCmdMultiDrawElementsIndirectCount*>(pc);
+            ExecuteGLMultiDrawElementsIndirectCount(*cmd, *stateMngr);
+            return sizeof(*cmd);
+        }
         case GLOpcodeDispatchCompute:
         {
             auto cmd = reinterpret_cast<const GLCmdDispatchCompute*>(pc);
@@ -492,6 +540,9 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
 
 static void ExecuteGLCommandsEmulated(const GLVirtualCommandBuffer& virtualCmdBuffer, GLStateManager* stateMngr)
 {
+    /* Draw mode and index type of direct draw commands are recorded separately, see GLCmdSetDrawMode */
+    GLCmdSetDrawMode drawMode = { GL_TRIANGLES, GL_UNSIGNED_INT };
+
     /* Initialize program counter to execute virtual GL commands */
     for (const auto& chunk : virtualCmdBuffer)
     {
@@ -505,7 +556,7 @@ static void ExecuteGLCommandsEmulated(const GLVirtualCommandBuffer& virtualCmdBu
             pc += sizeof(GLOpcode);
 
             /* Execute command and increment program counter */
-            pc += ExecuteGLCommand(opcode, pc, stateMngr);
+            pc += ExecuteGLCommand(opcode, pc, stateMngr, drawMode);
         }
     }
 }
@@ -522,6 +573,8 @@ static void ExecuteGLCommandsNatively(const JITProgram& exec, GLStateManager& st
 
 void ExecuteGLDeferredCommandBuffer(const GLDeferredCommandBuffer& cmdBuffer, GLStateManager& stateMngr)
 {
+    LLGL_PROFILER_ZONE("GLCommandExecutor::ExecuteDeferredCommandBuffer");
+
     #ifdef LLGL_ENABLE_JIT_COMPILER
     if (auto exec = cmdBuffer.GetExecutable().get())
     {
@@ -536,6 +589,77 @@ void ExecuteGLDeferredCommandBuffer(const GLDeferredCommandBuffer& cmdBuffer, GL
     }
 }
 
+#ifdef LLGL_GLEXT_DRAW_INDIRECT
+
+// Reads the draw count back from the specified buffer and clamps it to the specified maximum.
+static GLsizei ReadIndirectDrawCount(GLStateManager& stateMngr, GLuint countId, GLintptr drawcount, GLsizei maxdrawcount)
+{
+    GLuint count = 0;
+    stateMngr.BindBuffer(GLBufferTarget::COPY_READ_BUFFER, countId);
+    GLProfile::GetBufferSubData(GL_COPY_READ_BUFFER, drawcount, sizeof(count), &count);
+    return std::min(static_cast<GLsizei>(count), maxdrawcount);
+}
+
+#endif // /LLGL_GLEXT_DRAW_INDIRECT
+
+void ExecuteGLMultiDrawArraysIndirectCount(const GLCmdMultiDrawArraysIndirectCount& cmd, GLStateManager& stateMngr)
+{
+    stateMngr.FlushPendingStates();
+
+    #ifdef LLGL_GLEXT_DRAW_INDIRECT
+    #ifdef LLGL_GLEXT_INDIRECT_PARAMETERS
+    if (HasExtension(GLExt::ARB_indirect_parameters))
+    {
+        /* Use native multi draw command with draw count from parameter buffer */
+        stateMngr.BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd.id);
+        stateMngr.BindBuffer(GLBufferTarget::PARAMETER_BUFFER, cmd.countId);
+        glMultiDrawArraysIndirectCountARB(cmd.mode, reinterpret_cast<const GLvoid*>(cmd.indirect), cmd.drawcount, cmd.maxdrawcount, cmd.stride);
+    }
+    else
+    #endif // /LLGL_GLEXT_INDIRECT_PARAMETERS
+    {
+        /* Read draw count back to CPU and emulate multi draw command */
+        auto count = ReadIndirectDrawCount(stateMngr, cmd.countId, cmd.drawcount, cmd.maxdrawcount);
+        stateMngr.BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd.id);
+        GLintptr offset = cmd.indirect;
+        while (count-- > 0)
+        {
+            glDrawArraysIndirect(cmd.mode, reinterpret_cast<const GLvoid*>(offset));
+            offset += cmd.stride;
+        }
+    }
+    #endif // /LLGL_GLEXT_DRAW_INDIRECT
+}
+
+void ExecuteGLMultiDrawElementsIndirectCount(const GLCmdMultiDrawElementsIndirectCount& cmd, GLStateManager& stateMngr)
+{
+    stateMngr.FlushPendingStates();
+
+    #ifdef LLGL_GLEXT_DRAW_INDIRECT
+    #ifdef LLGL_GLEXT_INDIRECT_PARAMETERS
+    if (HasExtension(GLExt::ARB_indirect_parameters))
+    {
+        /* Use native multi draw command with draw count from parameter buffer */
+        stateMngr.BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd.id);
+        stateMngr.BindBuffer(GLBufferTarget::PARAMETER_BUFFER, cmd.countId);
+        glMultiDrawElementsIndirectCountARB(cmd.mode, cmd.type, reinterpret_cast<const GLvoid*>(cmd.indirect), cmd.drawcount, cmd.maxdrawcount, cmd.stride);
+    }
+    else
+    #endif // /LLGL_GLEXT_INDIRECT_PARAMETERS
+    {
+        /* Read draw count back to CPU and emulate multi draw command */
+        auto count = ReadIndirectDrawCount(stateMngr, cmd.countId, cmd.drawcount, cmd.maxdrawcount);
+        stateMngr.BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd.id);
+        GLintptr offset = cmd.indirect;
+        while (count-- > 0)
+        {
+            glDrawElementsIndirect(cmd.mode, cmd.type, reinterpret_cast<const GLvoid*>(offset));
+            offset += cmd.stride;
+        }
+    }
+    #endif // /LLGL_GLEXT_DRAW_INDIRECT
+}
+
 void ExecuteGLCommandBuffer(const GLCommandBuffer& cmdBuffer, GLStateManager& stateMngr)
 {
     /* Is this a secondary command buffer? */
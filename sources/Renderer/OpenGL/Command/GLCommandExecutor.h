@@ -16,6 +16,8 @@ namespace LLGL
 class GLStateManager;
 class GLCommandBuffer;
 class GLDeferredCommandBuffer;
+struct GLCmdMultiDrawArraysIndirectCount;
+struct GLCmdMultiDrawElementsIndirectCount;
 
 /*
 Executes all GL commands that have been recorded in the specified command buffer.
@@ -24,6 +26,13 @@ GL render states are tracked with the specified state manager.
 void ExecuteGLDeferredCommandBuffer(const GLDeferredCommandBuffer& cmdbuffer, GLStateManager& stateMngr);
 void ExecuteGLCommandBuffer(const GLCommandBuffer& cmdbuffer, GLStateManager& stateMngr);
 
+/*
+Executes the specified multi draw command whose draw count is taken from a buffer.
+If GL_ARB_indirect_parameters is not supported, the draw count is read back from the buffer and the draw commands are emulated.
+*/
+void ExecuteGLMultiDrawArraysIndirectCount(const GLCmdMultiDrawArraysIndirectCount& cmd, GLStateManager& stateMngr);
+void ExecuteGLMultiDrawElementsIndirectCount(const GLCmdMultiDrawElementsIndirectCount& cmd, GLStateManager& stateMngr);
+
 
 } // /namespace LLGL
 
@@ -37,8 +37,11 @@ enum GLOpcode : std::uint8_t
     GLOpcodeClearStencil,
     GLOpcodeClear,
     GLOpcodeClearAttachmentsWithRenderPass,
+    GLOpcodeInvalidateAttachmentsWithRenderPass,
+    GLOpcodeBindSubpass,
     GLOpcodeClearBuffers,
     GLOpcodeBindVertexArray,
+    GLOpcodeBindSharedVertexArray,
     GLOpcodeBindGL2XVertexArray,
     GLOpcodeBindElementArrayBufferToVAO,
     GLOpcodeBindBufferBase,
@@ -53,10 +56,12 @@ enum GLOpcode : std::uint8_t
     GLOpcodeSetBlendColor,
     GLOpcodeSetStencilRef,
     GLOpcodeSetUniforms,
+    GLOpcodeBindInlineUniformBlock,
     GLOpcodeBeginQuery,
     GLOpcodeEndQuery,
     GLOpcodeBeginConditionalRender,
     GLOpcodeEndConditionalRender,
+    GLOpcodeSetDrawMode,
     GLOpcodeDrawArrays,
     GLOpcodeDrawArraysInstanced,
     GLOpcodeDrawArraysInstancedBaseInstance,
@@ -69,6 +74,8 @@ enum GLOpcode : std::uint8_t
     GLOpcodeDrawElementsIndirect,
     GLOpcodeMultiDrawArraysIndirect,
     GLOpcodeMultiDrawElementsIndirect,
+    GLOpcodeMultiDrawArraysIndirectCount,
+    GLOpcodeMultiDrawElementsIndirectCount,
     GLOpcodeDispatchCompute,
     GLOpcodeDispatchComputeIndirect,
     GLOpcodeBindTexture,
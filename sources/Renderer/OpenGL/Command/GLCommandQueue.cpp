@@ -12,8 +12,12 @@
 #include "../RenderState/GLFence.h"
 #include "../RenderState/GLQueryHeap.h"
 #include "../RenderState/GLStateManager.h"
+#include "../Buffer/GLBuffer.h"
+#include "../Platform/GLUploadContext.h"
 #include "../../CheckedCast.h"
 #include "../Ext/GLExtensionRegistry.h"
+#include <LLGL/QueryHeapFlags.h>
+#include <LLGL/Timer.h>
 #include <algorithm>
 
 
@@ -35,11 +39,19 @@ void GLCommandQueue::Submit(CommandBuffer& commandBuffer)
     otherwise the commands must be submitted immediately (via GLImmediateCommandBuffer).
     */
     auto& cmdBufferGL = LLGL_CAST(const GLCommandBuffer&, commandBuffer);
+
+    /* Make all finished asynchronous uploads visible before the commands are executed */
+    if (auto uploadContext = GLUploadContext::Get())
+        uploadContext->Synchronize();
+
     if (!cmdBufferGL.IsImmediateCmdBuffer())
     {
         auto& deferredCmdBufferGL = LLGL_CAST(const GLDeferredCommandBuffer&, cmdBufferGL);
         ExecuteGLDeferredCommandBuffer(deferredCmdBufferGL, stateMngr_);
     }
+
+    /* Guard all ranges of streaming buffers that have been written before this submission */
+    GLBuffer::SubmitStreamingFences();
 }
 
 /* ----- Queries ----- */
@@ -180,6 +192,29 @@ bool GLCommandQueue::QueryResult(
     return false;
 }
 
+bool GLCommandQueue::QueryCalibratedTimestamps(CalibratedTimestamps& outTimestamps)
+{
+    #ifdef GL_ARB_timer_query
+    if (HasExtension(GLExt::ARB_timer_query) && HasExtension(GLExt::ARB_sync))
+    {
+        /* Sample the GPU timestamp in between two CPU timestamps, since GL has no atomic calibration */
+        GLint64 gpuTimestamp = 0;
+        const std::uint64_t cpuTickBefore = Timer::Tick();
+        glGetInteger64v(GL_TIMESTAMP, &gpuTimestamp);
+        const std::uint64_t cpuTickAfter = Timer::Tick();
+
+        /* Use the midpoint of both CPU timestamps, so the deviation is half of the sampling interval */
+        const std::uint64_t cpuTickHalfInterval = (cpuTickAfter - cpuTickBefore) / 2;
+        outTimestamps.cpuTimestamp  = cpuTickBefore + cpuTickHalfInterval;
+        outTimestamps.gpuTimestamp  = static_cast<std::uint64_t>(gpuTimestamp);
+        outTimestamps.gpuFrequency  = 1000000000ull; // GL_TIMESTAMP is in nanoseconds
+        outTimestamps.maxDeviation  = static_cast<std::uint64_t>(static_cast<double>(cpuTickHalfInterval) * 1.0e9 / static_cast<double>(Timer::Frequency()));
+        return true;
+    }
+    #endif // /GL_ARB_timer_query
+    return false;
+}
+
 /* ----- Fences ----- */
 
 void GLCommandQueue::Submit(Fence& fence)
@@ -196,6 +231,8 @@ bool GLCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
 
 void GLCommandQueue::WaitIdle()
 {
+    if (auto uploadContext = GLUploadContext::Get())
+        uploadContext->WaitIdle();
     glFinish();
 }
 
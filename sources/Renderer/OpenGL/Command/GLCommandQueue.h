@@ -40,6 +40,8 @@ class GLCommandQueue final : public CommandQueue
             std::size_t     dataSize
         ) override;
 
+        bool QueryCalibratedTimestamps(CalibratedTimestamps& outTimestamps) override;
+
         /* ----- Fences ----- */
 
         void Submit(Fence& fence) override;
@@ -17,6 +17,7 @@
 #include "../Ext/GLExtensionLoader.h"
 #include "../../CheckedCast.h"
 #include "../../../Core/Assertion.h"
+#include "../../../Core/Helper.h"
 
 #include "../Shader/GLShaderPipeline.h"
 
@@ -32,6 +33,7 @@
 
 #include "../RenderState/GLStateManager.h"
 #include "../RenderState/GLGraphicsPSO.h"
+#include "../RenderState/GLPipelineLayout.h"
 #include "../RenderState/GLResourceHeap.h"
 #include "../RenderState/GLRenderPass.h"
 #include "../RenderState/GLQueryHeap.h"
@@ -53,15 +55,35 @@ GLDeferredCommandBuffer::GLDeferredCommandBuffer(long flags, std::size_t initial
     flags_  { flags             },
     buffer_ { initialBufferSize }
 {
+    recordedBindings_.resize(GLRecordedBinding_Num * GLStateManager::g_maxNumResourceSlots, nullptr);
+}
+
+GLDeferredCommandBuffer::~GLDeferredCommandBuffer()
+{
+    // dummy; required to destroy the indirect buffer with its complete type
 }
 
 /* ----- Encoding ----- */
 
 void GLDeferredCommandBuffer::Begin()
 {
-    /* Reset internal command buffer */
+    /* Reset internal command buffer and reserve a single chunk for the largest recording so far, so steady-state recording does not allocate */
     buffer_.Clear();
+    buffer_.Reserve(buffer_.HighWaterMark());
     boundShaderPipeline_ = nullptr;
+    boundPipelineLayout_ = nullptr;
+    renderPass_          = nullptr;
+
+    /* Reset coalesced draw calls */
+    coalescedDrawArgs_.clear();
+    coalescedDrawCmds_.clear();
+    pendingDrawArgsBegin_ = 0;
+
+    /* Reset patch slots; they refer to the previous content of the virtual command buffer */
+    patchSlots_.clear();
+
+    /* Reset redundant state filter; the states at the beginning of the command buffer are unknown */
+    InvalidateRecordedStates();
 
     #ifdef LLGL_ENABLE_JIT_COMPILER
 
@@ -75,11 +97,20 @@ void GLDeferredCommandBuffer::Begin()
 
 void GLDeferredCommandBuffer::End()
 {
+    /* Record remaining coalesced draw calls and upload their arguments before the command buffer is packed */
+    FlushCoalescedDraws();
+    UploadCoalescedDrawArgs();
+
     #ifdef LLGL_ENABLE_JIT_COMPILER
 
-    /* Generate native assembly only if command buffer will be submitted multiple times */
+    /* Generate native assembly only if command buffer will be submitted multiple times; patchable draw calls must remain in the virtual command buffer */
     if ((GetFlags() & CommandBufferFlags::MultiSubmit) != 0)
-        executable_ = AssembleGLDeferredCommandBuffer(*this);
+    {
+        if (patchSlots_.empty())
+            executable_ = AssembleGLDeferredCommandBuffer(*this);
+        else
+            buffer_.Pack();
+    }
 
     #else
 
@@ -104,6 +135,9 @@ void GLDeferredCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
                 /* Encode GL command */
                 auto cmd = AllocCommand<GLCmdExecute>(GLOpcodeExecute);
                 cmd->commandBuffer = &deferredCmdBufferGL;
+
+                /* Secondary command buffer can change any state */
+                InvalidateRecordedStates();
             }
         }
     }
@@ -151,6 +185,9 @@ void GLDeferredCommandBuffer::CopyBufferFromTexture(
     std::uint32_t           rowStride,
     std::uint32_t           layerStride)
 {
+    /* Texture operations bind textures at the active texture unit */
+    InvalidateRecordedResources();
+
     auto cmd = AllocCommand<GLCmdCopyImageBuffer>(GLOpcodeCopyImageToBuffer);
     {
         cmd->texture        = LLGL_CAST(GLTexture*, &srcTexture);
@@ -196,6 +233,9 @@ void GLDeferredCommandBuffer::CopyTexture(
     const TextureLocation&  srcLocation,
     const Extent3D&         extent)
 {
+    /* Texture operations bind textures at the active texture unit */
+    InvalidateRecordedResources();
+
     auto cmd = AllocCommand<GLCmdCopyImageSubData>(GLOpcodeCopyImageSubData);
     {
         cmd->dstTexture = LLGL_CAST(GLTexture*, &dstTexture);
@@ -216,6 +256,9 @@ void GLDeferredCommandBuffer::CopyTextureFromBuffer(
     std::uint32_t           rowStride,
     std::uint32_t           layerStride)
 {
+    /* Texture operations bind textures at the active texture unit */
+    InvalidateRecordedResources();
+
     auto cmd = AllocCommand<GLCmdCopyImageBuffer>(GLOpcodeCopyImageFromBuffer);
     {
         cmd->texture        = LLGL_CAST(GLTexture*, &dstTexture);
@@ -230,6 +273,9 @@ void GLDeferredCommandBuffer::CopyTextureFromBuffer(
 
 void GLDeferredCommandBuffer::GenerateMips(Texture& texture)
 {
+    /* Texture operations bind textures at the active texture unit */
+    InvalidateRecordedResources();
+
     auto cmd = AllocCommand<GLCmdGenerateMipmap>(GLOpcodeGenerateMipmap);
     {
         cmd->texture = LLGL_CAST(GLTexture*, &texture);
@@ -238,6 +284,9 @@ void GLDeferredCommandBuffer::GenerateMips(Texture& texture)
 
 void GLDeferredCommandBuffer::GenerateMips(Texture& texture, const TextureSubresource& subresource)
 {
+    /* Texture operations bind textures at the active texture unit */
+    InvalidateRecordedResources();
+
     auto cmd = AllocCommand<GLCmdGenerateMipmapSubresource>(GLOpcodeGenerateMipmapSubresource);
     {
         cmd->texture        = LLGL_CAST(GLTexture*, &texture);
@@ -256,11 +305,27 @@ void GLDeferredCommandBuffer::SetViewport(const Viewport& viewport)
     maxNumViewports_ = std::max(maxNumViewports_, 1u);
     #endif // /LLGL_ENABLE_JIT_COMPILER
 
+    const GLViewport    viewportGL  { viewport.x, viewport.y, viewport.width, viewport.height };
+    const GLDepthRange  depthRangeGL{ viewport.minDepth, viewport.maxDepth };
+
+    /* Skip command if the first viewport is already set */
+    if (numRecordedViewports_ >= 1 &&
+        ::memcmp(&recordedViewports_[0], &viewportGL, sizeof(viewportGL)) == 0 &&
+        ::memcmp(&recordedDepthRanges_[0], &depthRangeGL, sizeof(depthRangeGL)) == 0)
+    {
+        return;
+    }
+
     auto cmd = AllocCommand<GLCmdViewport>(GLOpcodeViewport);
     {
-        cmd->viewport   = GLViewport{ viewport.x, viewport.y, viewport.width, viewport.height };
-        cmd->depthRange = GLDepthRange{ viewport.minDepth, viewport.maxDepth };
+        cmd->viewport   = viewportGL;
+        cmd->depthRange = depthRangeGL;
     }
+
+    /* Only the first viewport is known afterwards, since glViewport might also reset all other viewports */
+    recordedViewports_[0]   = viewportGL;
+    recordedDepthRanges_[0] = depthRangeGL;
+    numRecordedViewports_   = 1;
 }
 
 void GLDeferredCommandBuffer::SetViewports(std::uint32_t numViewports, const Viewport* viewports)
@@ -272,6 +337,24 @@ void GLDeferredCommandBuffer::SetViewports(std::uint32_t numViewports, const Vie
     maxNumViewports_ = std::max(maxNumViewports_, numViewports);
     #endif // /LLGL_ENABLE_JIT_COMPILER
 
+    /* Skip command if all viewports are already set */
+    if (numViewports <= numRecordedViewports_)
+    {
+        bool redundant = true;
+        for (std::uint32_t i = 0; i < numViewports && redundant; ++i)
+        {
+            const GLViewport    viewportGL  { viewports[i].x, viewports[i].y, viewports[i].width, viewports[i].height };
+            const GLDepthRange  depthRangeGL{ static_cast<GLclamp_t>(viewports[i].minDepth), static_cast<GLclamp_t>(viewports[i].maxDepth) };
+            redundant =
+            (
+                ::memcmp(&recordedViewports_[i], &viewportGL, sizeof(viewportGL)) == 0 &&
+                ::memcmp(&recordedDepthRanges_[i], &depthRangeGL, sizeof(depthRangeGL)) == 0
+            );
+        }
+        if (redundant)
+            return;
+    }
+
     /* Encode GL command */
     auto cmd = AllocCommand<GLCmdViewportArray>(GLOpcodeViewportArray, (sizeof(GLViewport) + sizeof(GLDepthRange))*numViewports);
     {
@@ -293,6 +376,11 @@ void GLDeferredCommandBuffer::SetViewports(std::uint32_t numViewports, const Vie
             depthRangesGL[i].minDepth = static_cast<GLclamp_t>(viewports[i].minDepth);
             depthRangesGL[i].maxDepth = static_cast<GLclamp_t>(viewports[i].maxDepth);
         }
+
+        /* Store recorded viewports; the remaining viewports keep their previous values */
+        ::memcpy(recordedViewports_, viewportsGL, sizeof(GLViewport)*numViewports);
+        ::memcpy(recordedDepthRanges_, depthRangesGL, sizeof(GLDepthRange)*numViewports);
+        numRecordedViewports_ = std::max(numRecordedViewports_, numViewports);
     }
 }
 
@@ -347,6 +435,12 @@ void GLDeferredCommandBuffer::SetVertexBuffer(Buffer& buffer)
         }
         else
         #endif // /LLGL_GL_ENABLE_OPENGL2X
+        if (HasExtension(GLExt::ARB_vertex_attrib_binding))
+        {
+            auto cmd = AllocCommand<GLCmdBindSharedVertexArray>(GLOpcodeBindSharedVertexArray);
+            cmd->sharedVertexArray = &(bufferWithVAO.GetSharedVertexArray());
+        }
+        else
         {
             auto cmd = AllocCommand<GLCmdBindVertexArray>(GLOpcodeBindVertexArray);
             cmd->vao = bufferWithVAO.GetVaoID();
@@ -367,6 +461,12 @@ void GLDeferredCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
         }
         else
         #endif
+        if (HasExtension(GLExt::ARB_vertex_attrib_binding))
+        {
+            auto cmd = AllocCommand<GLCmdBindSharedVertexArray>(GLOpcodeBindSharedVertexArray);
+            cmd->sharedVertexArray = &(bufferArrayWithVAO.GetSharedVertexArray());
+        }
+        else
         {
             auto cmd = AllocCommand<GLCmdBindVertexArray>(GLOpcodeBindVertexArray);
             cmd->vao = bufferArrayWithVAO.GetVaoID();
@@ -400,9 +500,31 @@ void GLDeferredCommandBuffer::SetResourceHeap(
     std::uint32_t           descriptorSet,
     const PipelineBindPoint /*bindPoint*/)
 {
+    auto resourceHeapGL = LLGL_CAST(GLResourceHeap*, &resourceHeap);
+
+    /* Skip command if the same descriptor set is still bound; resource heaps with memory barriers must always be bound */
+    if (recordedResourceHeap_ == resourceHeapGL && recordedDescriptorSet_ == descriptorSet && resourceHeapGL->GetBarriers() == 0)
+        return;
+
     auto cmd = AllocCommand<GLCmdBindResourceHeap>(GLOpcodeBindResourceHeap);
-    cmd->resourceHeap   = LLGL_CAST(GLResourceHeap*, &resourceHeap);
+    cmd->resourceHeap   = resourceHeapGL;
     cmd->descriptorSet  = descriptorSet;
+
+    /* Resource heap overrides an unknown range of individual resource bindings */
+    std::fill(recordedBindings_.begin(), recordedBindings_.end(), nullptr);
+    recordedResourceHeap_   = resourceHeapGL;
+    recordedDescriptorSet_  = descriptorSet;
+}
+
+void GLDeferredCommandBuffer::SetResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           descriptorSet,
+    std::uint32_t           /*numDynamicOffsets*/,
+    const std::uint32_t*    /*dynamicOffsets*/,
+    const PipelineBindPoint bindPoint)
+{
+    /* Dynamic offsets are not supported by this renderer (see BindingFlags::DynamicOffset) */
+    SetResourceHeap(resourceHeap, descriptorSet, bindPoint);
 }
 
 void GLDeferredCommandBuffer::SetResource(Resource& resource, std::uint32_t slot, long bindFlags, long stageFlags)
@@ -417,9 +539,9 @@ void GLDeferredCommandBuffer::SetResource(Resource& resource, std::uint32_t slot
             auto& bufferGL = LLGL_CAST(GLBuffer&, resource);
 
             /* Bind uniform buffer (UBO) or shader storage buffer (SSBO) */
-            if ((bindFlags & BindFlags::ConstantBuffer) != 0)
+            if ((bindFlags & BindFlags::ConstantBuffer) != 0 && !IsRecordedBinding(GLRecordedBinding_UniformBuffer, slot, &bufferGL))
                 BindBufferBase(GLBufferTarget::UNIFORM_BUFFER, bufferGL, slot);
-            if ((bindFlags & (BindFlags::Sampled | BindFlags::Storage)) != 0)
+            if ((bindFlags & (BindFlags::Sampled | BindFlags::Storage)) != 0 && !IsRecordedBinding(GLRecordedBinding_StorageBuffer, slot, &bufferGL))
                 BindBufferBase(GLBufferTarget::SHADER_STORAGE_BUFFER, bufferGL, slot);
         }
         break;
@@ -429,11 +551,11 @@ void GLDeferredCommandBuffer::SetResource(Resource& resource, std::uint32_t slot
             auto& textureGL = LLGL_CAST(GLTexture&, resource);
 
             /* Bind sampled texture resource */
-            if ((bindFlags & BindFlags::Sampled) != 0)
+            if ((bindFlags & BindFlags::Sampled) != 0 && !IsRecordedBinding(GLRecordedBinding_Texture, slot, &textureGL))
                 BindTexture(textureGL, slot);
 
             /* Bind storage texture resource */
-            if ((bindFlags & BindFlags::Storage) != 0)
+            if ((bindFlags & BindFlags::Storage) != 0 && !IsRecordedBinding(GLRecordedBinding_ImageTexture, slot, &textureGL))
                 BindImageTexture(textureGL, slot);
         }
         break;
@@ -444,14 +566,17 @@ void GLDeferredCommandBuffer::SetResource(Resource& resource, std::uint32_t slot
             /* If GL_ARB_sampler_objects is not supported, use emulated sampler states */
             if (!HasNativeSamplers())
             {
+                /* Emulated sampler states are applied to the bound texture, so they are never filtered */
                 auto& samplerGL2X = LLGL_CAST(GL2XSampler&, resource);
                 BindGL2XSampler(samplerGL2X, slot);
+                IsRecordedBinding(GLRecordedBinding_Sampler, slot, nullptr);
             }
             else
             #endif
             {
                 auto& samplerGL = LLGL_CAST(GLSampler&, resource);
-                BindSampler(samplerGL, slot);
+                if (!IsRecordedBinding(GLRecordedBinding_Sampler, slot, &samplerGL))
+                    BindSampler(samplerGL, slot);
             }
         }
         break;
@@ -506,7 +631,10 @@ void GLDeferredCommandBuffer::ResetResourceSlots(
         }
 
         if (cmd.resetFlags != 0)
+        {
             *AllocCommand<GLCmdUnbindResources>(GLOpcodeUnbindResources) = cmd;
+            InvalidateRecordedResources();
+        }
     }
 }
 
@@ -518,24 +646,63 @@ void GLDeferredCommandBuffer::BeginRenderPass(
     std::uint32_t       numClearValues,
     const ClearValue*   clearValues)
 {
+    /* Binding a render target might switch the GL context and thus the active state manager */
+    InvalidateRecordedStates();
+
     auto cmd = AllocCommand<GLCmdBindRenderTarget>(GLOpcodeBindRenderTarget);
     {
         cmd->renderTarget = &renderTarget;
     }
     if (renderPass != nullptr)
     {
+        renderPass_ = LLGL_CAST(const GLRenderPass*, renderPass);
         auto cmd = AllocCommand<GLCmdClearAttachmentsWithRenderPass>(GLOpcodeClearAttachmentsWithRenderPass, sizeof(ClearValue)*numClearValues);
         {
-            cmd->renderPass     = LLGL_CAST(const GLRenderPass*, renderPass);
+            cmd->renderPass     = renderPass_;
             cmd->numClearValues = numClearValues;
             ::memcpy(cmd + 1, clearValues, sizeof(ClearValue)*numClearValues);
         }
+
+        /* Select draw buffers of first sub-pass */
+        subpass_ = 0;
+        if (renderPass_->GetNumSubpasses() > 0)
+        {
+            auto cmd = AllocCommand<GLCmdBindSubpass>(GLOpcodeBindSubpass);
+            cmd->renderPass = renderPass_;
+            cmd->subpass    = subpass_;
+        }
     }
 }
 
 void GLDeferredCommandBuffer::EndRenderPass()
 {
-    // dummy
+    /* Invalidate render target attachments that are not stored by the render pass */
+    if (renderPass_ != nullptr)
+    {
+        if (renderPass_->GetInvalidateMask() != 0)
+        {
+            auto cmd = AllocCommand<GLCmdInvalidateAttachmentsWithRenderPass>(GLOpcodeInvalidateAttachmentsWithRenderPass);
+            cmd->renderPass = renderPass_;
+        }
+        if (renderPass_->GetNumSubpasses() > 0)
+        {
+            /* Restore all draw buffers of the render target */
+            auto cmd = AllocCommand<GLCmdBindSubpass>(GLOpcodeBindSubpass);
+            cmd->renderPass = nullptr;
+            cmd->subpass    = 0;
+        }
+        renderPass_ = nullptr;
+    }
+}
+
+void GLDeferredCommandBuffer::NextSubpass()
+{
+    if (renderPass_ != nullptr && subpass_ + 1 < renderPass_->GetNumSubpasses())
+    {
+        auto cmd = AllocCommand<GLCmdBindSubpass>(GLOpcodeBindSubpass);
+        cmd->renderPass = renderPass_;
+        cmd->subpass    = ++subpass_;
+    }
 }
 
 void GLDeferredCommandBuffer::Clear(long flags, const ClearValue& clearValue)
@@ -584,11 +751,21 @@ void GLDeferredCommandBuffer::ClearAttachments(std::uint32_t numAttachments, con
 
 void GLDeferredCommandBuffer::SetPipelineState(PipelineState& pipelineState)
 {
+    /* Skip command if the same pipeline state is still bound; draw mode and shader program are unchanged */
+    auto pipelineStateGL = LLGL_CAST(GLPipelineState*, &pipelineState);
+    if (recordedPipelineState_ == pipelineStateGL)
+        return;
+
     auto cmd = AllocCommand<GLCmdBindPipelineState>(GLOpcodeBindPipelineState);
-    cmd->pipelineState = LLGL_CAST(GLPipelineState*, &pipelineState);
+    cmd->pipelineState = pipelineStateGL;
+
+    /* Pipeline state might override the viewports with its static viewports */
+    recordedPipelineState_  = pipelineStateGL;
+    numRecordedViewports_   = 0;
 
     /* Store draw mode, primitive mode, and shader program */
     boundShaderPipeline_ = cmd->pipelineState->GetShaderPipeline();
+    boundPipelineLayout_ = cmd->pipelineState->GetPipelineLayout();
 
     if (cmd->pipelineState->IsGraphicsPSO())
     {
@@ -600,6 +777,9 @@ void GLDeferredCommandBuffer::SetPipelineState(PipelineState& pipelineState)
 
 void GLDeferredCommandBuffer::SetBlendFactor(const ColorRGBAf& color)
 {
+    /* Rebinding the pipeline state must not be skipped after its blend color has been overridden */
+    recordedPipelineState_ = nullptr;
+
     auto cmd = AllocCommand<GLCmdSetBlendColor>(GLOpcodeSetBlendColor);
     {
         cmd->color[0] = color.r;
@@ -611,6 +791,9 @@ void GLDeferredCommandBuffer::SetBlendFactor(const ColorRGBAf& color)
 
 void GLDeferredCommandBuffer::SetStencilReference(std::uint32_t reference, const StencilFace stencilFace)
 {
+    /* Rebinding the pipeline state must not be skipped after its stencil reference has been overridden */
+    recordedPipelineState_ = nullptr;
+
     auto cmd = AllocCommand<GLCmdSetStencilRef>(GLOpcodeSetStencilRef);
     {
         cmd->ref    = static_cast<GLint>(reference);
@@ -636,6 +819,13 @@ void GLDeferredCommandBuffer::SetUniforms(
     if (dataSize == 0 || dataSize % 4 != 0)
         return;
 
+    /* Stream inline uniforms into uniform blocks if the pipeline layout declares any, otherwise set uniforms of the shader program */
+    if (boundPipelineLayout_ != nullptr && boundPipelineLayout_->GetNumInlineUniformValues() > 0)
+    {
+        SetInlineUniforms(*boundPipelineLayout_, static_cast<std::uint32_t>(location), data, dataSize);
+        return;
+    }
+
     /* Allocate GL command and copy data buffer */
     auto cmd = AllocCommand<GLCmdSetUniforms>(GLOpcodeSetUniforms, dataSize);
     {
@@ -669,6 +859,9 @@ void GLDeferredCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query
 
 void GLDeferredCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
 {
+    if (!BeginRenderConditionMode(mode))
+        return;
+
     auto cmd = AllocCommand<GLCmdBeginConditionalRender>(GLOpcodeBeginConditionalRender);
     {
         cmd->id     = LLGL_CAST(const GLQueryHeap&, queryHeap).GetID(query);
@@ -678,7 +871,8 @@ void GLDeferredCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::ui
 
 void GLDeferredCommandBuffer::EndRenderCondition()
 {
-    AllocOpcode(GLOpcodeEndConditionalRender);
+    if (EndRenderConditionMode())
+        AllocOpcode(GLOpcodeEndConditionalRender);
 }
 
 /* ----- Stream Output ------ */
@@ -743,9 +937,8 @@ The indices actually store the index start offset, but must be passed to GL as a
 
 void GLDeferredCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
 {
-    auto cmd = AllocCommand<GLCmdDrawArrays>(GLOpcodeDrawArrays);
+    auto cmd = AllocDrawCommand<GLCmdDrawArrays>(GLOpcodeDrawArrays);
     {
-        cmd->mode   = renderState_.drawMode;
         cmd->first  = static_cast<GLint>(firstVertex);
         cmd->count  = static_cast<GLsizei>(numVertices);
     }
@@ -753,24 +946,26 @@ void GLDeferredCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firs
 
 void GLDeferredCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
 {
+    if (CoalesceDrawElements({ numIndices, 1, firstIndex, 0, 0 }))
+        return;
+
     const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
-    auto cmd = AllocCommand<GLCmdDrawElements>(GLOpcodeDrawElements);
+    auto cmd = AllocDrawCommand<GLCmdDrawElements>(GLOpcodeDrawElements);
     {
-        cmd->mode       = renderState_.drawMode;
         cmd->count      = static_cast<GLsizei>(numIndices);
-        cmd->type       = renderState_.indexBufferDataType;
         cmd->indices    = reinterpret_cast<const GLvoid*>(indices);
     }
 }
 
 void GLDeferredCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    if (CoalesceDrawElements({ numIndices, 1, firstIndex, vertexOffset, 0 }))
+        return;
+
     const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
-    auto cmd = AllocCommand<GLCmdDrawElementsBaseVertex>(GLOpcodeDrawElementsBaseVertex);
+    auto cmd = AllocDrawCommand<GLCmdDrawElementsBaseVertex>(GLOpcodeDrawElementsBaseVertex);
     {
-        cmd->mode       = renderState_.drawMode;
         cmd->count      = static_cast<GLsizei>(numIndices);
-        cmd->type       = renderState_.indexBufferDataType;
         cmd->indices    = reinterpret_cast<const GLvoid*>(indices);
         cmd->basevertex = vertexOffset;
     }
@@ -778,9 +973,8 @@ void GLDeferredCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_
 
 void GLDeferredCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
 {
-    auto cmd = AllocCommand<GLCmdDrawArraysInstanced>(GLOpcodeDrawArraysInstanced);
+    auto cmd = AllocDrawCommand<GLCmdDrawArraysInstanced>(GLOpcodeDrawArraysInstanced);
     {
-        cmd->mode           = renderState_.drawMode;
         cmd->first          = static_cast<GLint>(firstVertex);
         cmd->count          = static_cast<GLsizei>(numVertices);
         cmd->instancecount  = static_cast<GLsizei>(numInstances);
@@ -790,9 +984,8 @@ void GLDeferredCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint
 void GLDeferredCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
 {
     #ifndef __APPLE__
-    auto cmd = AllocCommand<GLCmdDrawArraysInstancedBaseInstance>(GLOpcodeDrawArraysInstancedBaseInstance);
+    auto cmd = AllocDrawCommand<GLCmdDrawArraysInstancedBaseInstance>(GLOpcodeDrawArraysInstancedBaseInstance);
     {
-        cmd->mode           = renderState_.drawMode;
         cmd->first          = static_cast<GLint>(firstVertex);
         cmd->count          = static_cast<GLsizei>(numVertices);
         cmd->instancecount  = static_cast<GLsizei>(numInstances);
@@ -805,12 +998,13 @@ void GLDeferredCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint
 
 void GLDeferredCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
 {
+    if (CoalesceDrawElements({ numIndices, numInstances, firstIndex, 0, 0 }))
+        return;
+
     const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
-    auto cmd = AllocCommand<GLCmdDrawElementsInstanced>(GLOpcodeDrawElementsInstanced);
+    auto cmd = AllocDrawCommand<GLCmdDrawElementsInstanced>(GLOpcodeDrawElementsInstanced);
     {
-        cmd->mode           = renderState_.drawMode;
         cmd->count          = static_cast<GLsizei>(numIndices);
-        cmd->type           = renderState_.indexBufferDataType;
         cmd->indices        = reinterpret_cast<const GLvoid*>(indices);
         cmd->instancecount  = static_cast<GLsizei>(numInstances);
     }
@@ -818,12 +1012,13 @@ void GLDeferredCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std
 
 void GLDeferredCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    if (CoalesceDrawElements({ numIndices, numInstances, firstIndex, vertexOffset, 0 }))
+        return;
+
     const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
-    auto cmd = AllocCommand<GLCmdDrawElementsInstancedBaseVertex>(GLOpcodeDrawElementsInstancedBaseVertex);
+    auto cmd = AllocDrawCommand<GLCmdDrawElementsInstancedBaseVertex>(GLOpcodeDrawElementsInstancedBaseVertex);
     {
-        cmd->mode           = renderState_.drawMode;
         cmd->count          = static_cast<GLsizei>(numIndices);
-        cmd->type           = renderState_.indexBufferDataType;
         cmd->indices        = reinterpret_cast<const GLvoid*>(indices);
         cmd->instancecount  = static_cast<GLsizei>(numInstances);
         cmd->basevertex     = vertexOffset;
@@ -833,12 +1028,13 @@ void GLDeferredCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std
 void GLDeferredCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
     #ifndef __APPLE__
+    if (CoalesceDrawElements({ numIndices, numInstances, firstIndex, vertexOffset, firstInstance }))
+        return;
+
     const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
-    auto cmd = AllocCommand<GLCmdDrawElementsInstancedBaseVertexBaseInstance>(GLOpcodeDrawElementsInstancedBaseVertexBaseInstance);
+    auto cmd = AllocDrawCommand<GLCmdDrawElementsInstancedBaseVertexBaseInstance>(GLOpcodeDrawElementsInstancedBaseVertexBaseInstance);
     {
-        cmd->mode           = renderState_.drawMode;
         cmd->count          = static_cast<GLsizei>(numIndices);
-        cmd->type           = renderState_.indexBufferDataType;
         cmd->indices        = reinterpret_cast<const GLvoid*>(indices);
         cmd->instancecount  = static_cast<GLsizei>(numInstances);
         cmd->basevertex     = vertexOffset;
@@ -934,6 +1130,120 @@ void GLDeferredCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t
     }
 }
 
+void GLDeferredCommandBuffer::DrawIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride)
+{
+    auto cmd = AllocCommand<GLCmdMultiDrawArraysIndirectCount>(GLOpcodeMultiDrawArraysIndirectCount);
+    {
+        cmd->id             = LLGL_CAST(GLBuffer&, buffer).GetID();
+        cmd->countId        = LLGL_CAST(GLBuffer&, countBuffer).GetID();
+        cmd->mode           = renderState_.drawMode;
+        cmd->indirect       = static_cast<GLintptr>(offset);
+        cmd->drawcount      = static_cast<GLintptr>(countOffset);
+        cmd->maxdrawcount   = static_cast<GLsizei>(maxNumCommands);
+        cmd->stride         = static_cast<GLsizei>(stride);
+    }
+}
+
+void GLDeferredCommandBuffer::DrawIndexedIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride)
+{
+    auto cmd = AllocCommand<GLCmdMultiDrawElementsIndirectCount>(GLOpcodeMultiDrawElementsIndirectCount);
+    {
+        cmd->id             = LLGL_CAST(GLBuffer&, buffer).GetID();
+        cmd->countId        = LLGL_CAST(GLBuffer&, countBuffer).GetID();
+        cmd->mode           = renderState_.drawMode;
+        cmd->type           = renderState_.indexBufferDataType;
+        cmd->indirect       = static_cast<GLintptr>(offset);
+        cmd->drawcount      = static_cast<GLintptr>(countOffset);
+        cmd->maxdrawcount   = static_cast<GLsizei>(maxNumCommands);
+        cmd->stride         = static_cast<GLsizei>(stride);
+    }
+}
+
+/*
+Patchable draw calls are never coalesced and always recorded with the most general GL command,
+so all arguments can be patched in place. Their offsets within the virtual command buffer remain valid after it has been packed.
+*/
+
+std::uint32_t GLDeferredCommandBuffer::DrawPatchable(const DrawIndirectArguments& args)
+{
+    FlushCoalescedDraws();
+    RecordDrawMode(renderState_.drawMode, renderState_.indexBufferDataType);
+
+    const auto slot = static_cast<std::uint32_t>(patchSlots_.size());
+    patchSlots_.push_back({ buffer_.Size(), 0, 0 });
+
+    #ifndef __APPLE__
+    buffer_.AllocCommand<GLCmdDrawArraysInstancedBaseInstance>(GLOpcodeDrawArraysInstancedBaseInstance);
+    #else
+    buffer_.AllocCommand<GLCmdDrawArraysInstanced>(GLOpcodeDrawArraysInstanced);
+    #endif
+
+    PatchDraw(slot, args);
+    return slot;
+}
+
+std::uint32_t GLDeferredCommandBuffer::DrawIndexedPatchable(const DrawIndexedIndirectArguments& args)
+{
+    FlushCoalescedDraws();
+    RecordDrawMode(renderState_.drawMode, renderState_.indexBufferDataType);
+
+    const auto slot = static_cast<std::uint32_t>(patchSlots_.size());
+    patchSlots_.push_back({ buffer_.Size(), renderState_.indexBufferOffset, renderState_.indexBufferStride });
+
+    #ifndef __APPLE__
+    buffer_.AllocCommand<GLCmdDrawElementsInstancedBaseVertexBaseInstance>(GLOpcodeDrawElementsInstancedBaseVertexBaseInstance);
+    #else
+    buffer_.AllocCommand<GLCmdDrawElementsInstancedBaseVertex>(GLOpcodeDrawElementsInstancedBaseVertex);
+    #endif
+
+    PatchDrawIndexed(slot, args);
+    return slot;
+}
+
+bool GLDeferredCommandBuffer::PatchDraw(std::uint32_t slot, const DrawIndirectArguments& args)
+{
+    #ifndef __APPLE__
+    auto cmd = GetPatchCommand<GLCmdDrawArraysInstancedBaseInstance>(slot, GLOpcodeDrawArraysInstancedBaseInstance);
+    #else
+    auto cmd = GetPatchCommand<GLCmdDrawArraysInstanced>(slot, GLOpcodeDrawArraysInstanced);
+    #endif
+    if (cmd == nullptr)
+        return false;
+
+    cmd->first          = static_cast<GLint>(args.firstVertex);
+    cmd->count          = static_cast<GLsizei>(args.numVertices);
+    cmd->instancecount  = static_cast<GLsizei>(args.numInstances);
+    #ifndef __APPLE__
+    cmd->baseinstance   = args.firstInstance;
+    #endif
+
+    return true;
+}
+
+bool GLDeferredCommandBuffer::PatchDrawIndexed(std::uint32_t slot, const DrawIndexedIndirectArguments& args)
+{
+    #ifndef __APPLE__
+    auto cmd = GetPatchCommand<GLCmdDrawElementsInstancedBaseVertexBaseInstance>(slot, GLOpcodeDrawElementsInstancedBaseVertexBaseInstance);
+    #else
+    auto cmd = GetPatchCommand<GLCmdDrawElementsInstancedBaseVertex>(slot, GLOpcodeDrawElementsInstancedBaseVertex);
+    #endif
+    if (cmd == nullptr)
+        return false;
+
+    const auto& patchSlot = patchSlots_[slot];
+    const GLintptr indices = (patchSlot.indexBufferOffset + args.firstIndex * patchSlot.indexBufferStride);
+
+    cmd->count          = static_cast<GLsizei>(args.numIndices);
+    cmd->indices        = reinterpret_cast<const GLvoid*>(indices);
+    cmd->instancecount  = static_cast<GLsizei>(args.numInstances);
+    cmd->basevertex     = args.vertexOffset;
+    #ifndef __APPLE__
+    cmd->baseinstance   = args.firstInstance;
+    #endif
+
+    return true;
+}
+
 /* ----- Compute ----- */
 
 void GLDeferredCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
@@ -1012,6 +1322,20 @@ bool GLDeferredCommandBuffer::IsPrimary() const
  * ======= Private: =======
  */
 
+void GLDeferredCommandBuffer::BindInlineUniformBlock(GLuint index, const void* data, GLsizeiptr size)
+{
+    /* Uniform buffer at this slot is replaced by the ring buffer, so the next buffer binding must not be filtered */
+    IsRecordedBinding(GLRecordedBinding_UniformBuffer, index, nullptr);
+
+    /* Allocate GL command and copy all values of the uniform block; they are streamed into the ring buffer on execution */
+    auto cmd = AllocCommand<GLCmdBindInlineUniformBlock>(GLOpcodeBindInlineUniformBlock, static_cast<std::size_t>(size));
+    {
+        cmd->index  = index;
+        cmd->size   = size;
+        ::memcpy(cmd + 1, data, static_cast<std::size_t>(size));
+    }
+}
+
 void GLDeferredCommandBuffer::BindBufferBase(const GLBufferTarget bufferTarget, const GLBuffer& bufferGL, std::uint32_t slot)
 {
     auto cmd = AllocCommand<GLCmdBindBufferBase>(GLOpcodeBindBufferBase);
@@ -1088,14 +1412,200 @@ void GLDeferredCommandBuffer::BindGL2XSampler(const GL2XSampler& samplerGL2X, st
 }
 #endif
 
+bool GLDeferredCommandBuffer::CoalesceDrawElements(const DrawIndexedIndirectArguments& args)
+{
+    #ifdef LLGL_GLEXT_MULTI_DRAW_INDIRECT
+
+    if (!HasExtension(GLExt::ARB_multi_draw_indirect))
+        return false;
+
+    /* Indirect draw arguments have no byte offset, so the index buffer offset must be a multiple of the index size */
+    if (renderState_.indexBufferOffset % renderState_.indexBufferStride != 0)
+        return false;
+
+    /* Start a new batch if the draw mode or index format has changed */
+    if (pendingDrawArgsBegin_ < coalescedDrawArgs_.size())
+    {
+        if (pendingDrawMode_ != renderState_.drawMode || pendingDrawType_ != renderState_.indexBufferDataType)
+            FlushCoalescedDraws();
+    }
+
+    pendingDrawMode_    = renderState_.drawMode;
+    pendingDrawType_    = renderState_.indexBufferDataType;
+    pendingDrawStride_  = renderState_.indexBufferStride;
+
+    /* Append draw arguments with first index relative to the start of the index buffer */
+    DrawIndexedIndirectArguments drawArgs = args;
+    drawArgs.firstIndex += static_cast<std::uint32_t>(renderState_.indexBufferOffset / renderState_.indexBufferStride);
+    coalescedDrawArgs_.push_back(drawArgs);
+
+    return true;
+
+    #else
+
+    return false;
+
+    #endif // /LLGL_GLEXT_MULTI_DRAW_INDIRECT
+}
+
+void GLDeferredCommandBuffer::FlushCoalescedDraws()
+{
+    const std::size_t numDraws = coalescedDrawArgs_.size() - pendingDrawArgsBegin_;
+    if (numDraws == 1)
+    {
+        /* Record single draw call directly */
+        const auto drawArgs = coalescedDrawArgs_.back();
+        coalescedDrawArgs_.pop_back();
+
+        const GLintptr indices = static_cast<GLintptr>(drawArgs.firstIndex) * pendingDrawStride_;
+        RecordDrawMode(pendingDrawMode_, pendingDrawType_);
+        if (drawArgs.numInstances == 1 && drawArgs.vertexOffset == 0 && drawArgs.firstInstance == 0)
+        {
+            auto cmd = buffer_.AllocCommand<GLCmdDrawElements>(GLOpcodeDrawElements);
+            {
+                cmd->count      = static_cast<GLsizei>(drawArgs.numIndices);
+                cmd->indices    = reinterpret_cast<const GLvoid*>(indices);
+            }
+        }
+        else
+        {
+            auto cmd = buffer_.AllocCommand<GLCmdDrawElementsInstancedBaseVertexBaseInstance>(GLOpcodeDrawElementsInstancedBaseVertexBaseInstance);
+            {
+                cmd->count          = static_cast<GLsizei>(drawArgs.numIndices);
+                cmd->indices        = reinterpret_cast<const GLvoid*>(indices);
+                cmd->instancecount  = static_cast<GLsizei>(drawArgs.numInstances);
+                cmd->basevertex     = drawArgs.vertexOffset;
+                cmd->baseinstance   = drawArgs.firstInstance;
+            }
+        }
+    }
+    else if (numDraws > 1)
+    {
+        /* Record all draw calls of the batch as one multi-draw-indirect call; the indirect buffer is assigned in End() */
+        const GLintptr indirect = static_cast<GLintptr>(pendingDrawArgsBegin_ * sizeof(DrawIndexedIndirectArguments));
+        auto cmd = buffer_.AllocCommand<GLCmdMultiDrawElementsIndirect>(GLOpcodeMultiDrawElementsIndirect);
+        {
+            cmd->id         = 0;
+            cmd->mode       = pendingDrawMode_;
+            cmd->type       = pendingDrawType_;
+            cmd->indirect   = reinterpret_cast<const GLvoid*>(indirect);
+            cmd->drawcount  = static_cast<GLsizei>(numDraws);
+            cmd->stride     = 0;
+        }
+        coalescedDrawCmds_.push_back(cmd);
+    }
+    pendingDrawArgsBegin_ = coalescedDrawArgs_.size();
+}
+
+void GLDeferredCommandBuffer::UploadCoalescedDrawArgs()
+{
+    if (coalescedDrawCmds_.empty())
+        return;
+
+    const auto dataSize = coalescedDrawArgs_.size() * sizeof(DrawIndexedIndirectArguments);
+    if (!indirectBuffer_ || indirectBufferSize_ < dataSize)
+    {
+        /* Allocate new indirect buffer with enough capacity */
+        #ifdef GL_ARB_buffer_storage
+        const GLbitfield storageFlags = GL_DYNAMIC_STORAGE_BIT;
+        #else
+        const GLbitfield storageFlags = 0;
+        #endif
+        indirectBuffer_ = MakeUnique<GLBuffer>(BindFlags::IndirectBuffer);
+        indirectBuffer_->BufferStorage(static_cast<GLsizeiptr>(dataSize), coalescedDrawArgs_.data(), storageFlags, GL_STATIC_DRAW);
+        indirectBufferSize_ = dataSize;
+    }
+    else
+        indirectBuffer_->BufferSubData(0, static_cast<GLsizeiptr>(dataSize), coalescedDrawArgs_.data());
+
+    /* Assign indirect buffer to all multi-draw-indirect commands */
+    for (auto cmd : coalescedDrawCmds_)
+        cmd->id = indirectBuffer_->GetID();
+
+    /* Commands must not be referenced after the virtual command buffer has been packed */
+    coalescedDrawCmds_.clear();
+}
+
+bool GLDeferredCommandBuffer::IsRecordedBinding(const GLRecordedBinding binding, std::uint32_t slot, const void* resource)
+{
+    /* Individual binding overrides the bindings of the recorded resource heap */
+    recordedResourceHeap_ = nullptr;
+
+    /* Resources beyond the tracked slots are always bound */
+    if (slot >= GLStateManager::g_maxNumResourceSlots)
+        return false;
+
+    auto& recordedResource = recordedBindings_[binding * GLStateManager::g_maxNumResourceSlots + slot];
+    if (resource != nullptr && recordedResource == resource)
+        return true;
+
+    recordedResource = resource;
+    return false;
+}
+
+void GLDeferredCommandBuffer::InvalidateRecordedStates()
+{
+    recordedPipelineState_  = nullptr;
+    numRecordedViewports_   = 0;
+    recordedDrawMode_       = 0;
+    recordedDrawType_       = 0;
+    InvalidateRecordedResources();
+}
+
+void GLDeferredCommandBuffer::RecordDrawMode(GLenum mode, GLenum type)
+{
+    if (recordedDrawMode_ != mode || recordedDrawType_ != type)
+    {
+        auto cmd = buffer_.AllocCommand<GLCmdSetDrawMode>(GLOpcodeSetDrawMode);
+        {
+            cmd->mode = mode;
+            cmd->type = type;
+        }
+        recordedDrawMode_ = mode;
+        recordedDrawType_ = type;
+    }
+}
+
+void GLDeferredCommandBuffer::InvalidateRecordedResources()
+{
+    recordedResourceHeap_ = nullptr;
+    std::fill(recordedBindings_.begin(), recordedBindings_.end(), nullptr);
+}
+
 void GLDeferredCommandBuffer::AllocOpcode(const GLOpcode opcode)
 {
+    FlushCoalescedDraws();
     buffer_.AllocOpcode(opcode);
 }
 
+template <typename TCommand>
+TCommand* GLDeferredCommandBuffer::GetPatchCommand(std::uint32_t slot, const GLOpcode opcode)
+{
+    if (slot < patchSlots_.size())
+    {
+        if (auto data = buffer_.DataAt(patchSlots_[slot].offset))
+        {
+            if (*reinterpret_cast<const GLOpcode*>(data) == opcode)
+                return reinterpret_cast<TCommand*>(data + sizeof(GLOpcode));
+        }
+    }
+    return nullptr;
+}
+
+template <typename TCommand>
+TCommand* GLDeferredCommandBuffer::AllocDrawCommand(const GLOpcode opcode)
+{
+    /* Record draw mode of the current render state before the draw command, but after the current batch of coalesced draw calls */
+    FlushCoalescedDraws();
+    RecordDrawMode(renderState_.drawMode, renderState_.indexBufferDataType);
+    return buffer_.AllocCommand<TCommand>(opcode);
+}
+
 template <typename TCommand>
 TCommand* GLDeferredCommandBuffer::AllocCommand(const GLOpcode opcode, std::size_t payloadSize)
 {
+    /* Any other command ends the current batch of coalesced draw calls */
+    FlushCoalescedDraws();
     return buffer_.AllocCommand<TCommand>(opcode, payloadSize);
 }
 
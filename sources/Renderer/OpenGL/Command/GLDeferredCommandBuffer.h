@@ -14,6 +14,8 @@
 #include "../RenderState/GLState.h"
 #include "../OpenGL.h"
 #include "../../VirtualCommandBuffer.h"
+#include <LLGL/IndirectArguments.h>
+#include <LLGL/StaticLimits.h>
 #include <memory>
 #include <vector>
 
@@ -35,11 +37,26 @@ class GLSwapChain;
 class GLStateManager;
 class GLRenderPass;
 class GLShaderPipeline;
+class GLPipelineState;
+class GLResourceHeap;
+struct GLCmdMultiDrawElementsIndirect;
 #ifdef LLGL_GL_ENABLE_OPENGL2X
 class GL2XSampler;
 #endif
 
-using GLVirtualCommandBuffer = VirtualCommandBuffer<GLOpcode>;
+using GLVirtualCommandBuffer = VirtualCommandBuffer<GLOpcode, DefaultBufferGrowPolicy, PooledChunkAllocPolicy>;
+
+// Binding types of individual resources that are tracked by the redundant state filter.
+enum GLRecordedBinding
+{
+    GLRecordedBinding_UniformBuffer = 0,
+    GLRecordedBinding_StorageBuffer,
+    GLRecordedBinding_Texture,
+    GLRecordedBinding_ImageTexture,
+    GLRecordedBinding_Sampler,
+
+    GLRecordedBinding_Num,
+};
 
 class GLDeferredCommandBuffer final : public GLCommandBuffer
 {
@@ -47,6 +64,7 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
     public:
 
         GLDeferredCommandBuffer(long flags, std::size_t initialBufferSize = 1024);
+        ~GLDeferredCommandBuffer();
 
         /* ----- Encoding ----- */
 
@@ -132,6 +150,14 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
             const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined
         ) override;
 
+        void SetResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           descriptorSet,
+            std::uint32_t           numDynamicOffsets,
+            const std::uint32_t*    dynamicOffsets,
+            const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined
+        ) override;
+
         void SetResource(Resource& resource, std::uint32_t slot, long bindFlags, long stageFlags = StageFlags::AllStages) override;
 
         void ResetResourceSlots(
@@ -152,6 +178,7 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
         ) override;
 
         void EndRenderPass() override;
+        void NextSubpass() override;
 
         void Clear(long flags, const ClearValue& clearValue = {}) override;
         void ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments) override;
@@ -208,6 +235,15 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
         void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset) override;
         void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
 
+        void DrawIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride) override;
+        void DrawIndexedIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride) override;
+
+        std::uint32_t DrawPatchable(const DrawIndirectArguments& args) override;
+        std::uint32_t DrawIndexedPatchable(const DrawIndexedIndirectArguments& args) override;
+
+        bool PatchDraw(std::uint32_t slot, const DrawIndirectArguments& args) override;
+        bool PatchDrawIndexed(std::uint32_t slot, const DrawIndexedIndirectArguments& args) override;
+
         /* ----- Compute ----- */
 
         void Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ) override;
@@ -264,6 +300,18 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
 
     private:
 
+        // Patchable draw command within the virtual command buffer.
+        struct GLPatchSlot
+        {
+            std::size_t offset;             // Offset of the command opcode within the virtual command buffer
+            GLsizeiptr  indexBufferOffset;  // Index buffer offset at the time the command was recorded
+            GLsizeiptr  indexBufferStride;  // Index buffer stride at the time the command was recorded
+        };
+
+    private:
+
+        void BindInlineUniformBlock(GLuint index, const void* data, GLsizeiptr size) override;
+
         void BindBufferBase(const GLBufferTarget bufferTarget, const GLBuffer& bufferGL, std::uint32_t slot);
         void BindBuffersBase(const GLBufferTarget bufferTarget, std::uint32_t first, std::uint32_t count, const Buffer *const *const buffers);
         void BindTexture(GLTexture& textureGL, std::uint32_t slot);
@@ -273,6 +321,34 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
         void BindGL2XSampler(const GL2XSampler& samplerGL2X, std::uint32_t slot);
         #endif
 
+        /*
+        Appends the specified indexed draw call to the pending batch of coalesced draw calls.
+        Returns false if draw calls cannot be coalesced, e.g. if GL_ARB_multi_draw_indirect is not supported.
+        */
+        bool CoalesceDrawElements(const DrawIndexedIndirectArguments& args);
+
+        // Records the pending batch of coalesced draw calls, either as single draw call or as one multi-draw-indirect call.
+        void FlushCoalescedDraws();
+
+        // Uploads the arguments of all coalesced draw calls into the internal indirect buffer and assigns it to the recorded commands.
+        void UploadCoalescedDrawArgs();
+
+        // Returns true if the specified resource is already bound at the specified slot in the recorded command stream and otherwise stores it as bound.
+        bool IsRecordedBinding(const GLRecordedBinding binding, std::uint32_t slot, const void* resource);
+
+        // Invalidates all recorded states of the redundancy filter, e.g. when the GL context might change.
+        void InvalidateRecordedStates();
+
+        // Invalidates the recorded resource heap and all recorded resource bindings.
+        void InvalidateRecordedResources();
+
+        // Records a GLCmdSetDrawMode command if the specified draw mode or index type differs from the recorded one.
+        void RecordDrawMode(GLenum mode, GLenum type);
+
+        // Returns the command of the specified patch slot if it has been recorded with the specified opcode, or null otherwise.
+        template <typename TCommand>
+        TCommand* GetPatchCommand(std::uint32_t slot, const GLOpcode opcode);
+
         /* Allocates only an opcode for empty commands */
         void AllocOpcode(const GLOpcode opcode);
 
@@ -280,13 +356,47 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
         template <typename TCommand>
         TCommand* AllocCommand(const GLOpcode opcode, std::size_t payloadSize = 0);
 
+        /* Allocates a new direct draw command and records the draw mode of the current render state if it has changed */
+        template <typename TCommand>
+        TCommand* AllocDrawCommand(const GLOpcode opcode);
+
     private:
 
         GLRenderState               renderState_;
         const GLShaderPipeline*     boundShaderPipeline_    = 0;
+        const GLPipelineLayout*     boundPipelineLayout_    = nullptr;
 
         long                        flags_                  = 0;
         GLVirtualCommandBuffer      buffer_;
+        const GLRenderPass*         renderPass_             = nullptr; // Render pass of the current BeginRenderPass/EndRenderPass section
+        std::uint32_t               subpass_                = 0;       // Sub-pass index of the current render pass
+
+        /* ----- Draw call coalescing ----- */
+
+        std::vector<DrawIndexedIndirectArguments>       coalescedDrawArgs_;
+        std::size_t                                     pendingDrawArgsBegin_   = 0;   // Index of the first draw call in the pending batch
+        GLenum                                          pendingDrawMode_        = 0;
+        GLenum                                          pendingDrawType_        = 0;
+        GLsizeiptr                                      pendingDrawStride_      = 0;
+        std::vector<GLCmdMultiDrawElementsIndirect*>    coalescedDrawCmds_;             // Commands that refer to the indirect buffer
+        std::unique_ptr<GLBuffer>                       indirectBuffer_;
+        std::size_t                                     indirectBufferSize_     = 0;
+
+        /* ----- Patchable draw calls ----- */
+
+        std::vector<GLPatchSlot>                        patchSlots_;
+
+        /* ----- Redundant state filter ----- */
+
+        const GLPipelineState*                          recordedPipelineState_  = nullptr;
+        const GLResourceHeap*                           recordedResourceHeap_   = nullptr;
+        std::uint32_t                                   recordedDescriptorSet_  = 0;
+        std::uint32_t                                   numRecordedViewports_   = 0;    // Number of viewports in the recorded stream with known values
+        GLViewport                                      recordedViewports_[LLGL_MAX_NUM_VIEWPORTS_AND_SCISSORS];
+        GLDepthRange                                    recordedDepthRanges_[LLGL_MAX_NUM_VIEWPORTS_AND_SCISSORS];
+        std::vector<const void*>                        recordedBindings_;              // Bound resources per binding type and slot
+        GLenum                                          recordedDrawMode_       = 0;    // Draw mode of direct draw commands in the recorded stream, or 0 if unknown
+        GLenum                                          recordedDrawType_       = 0;    // Index type of direct draw commands in the recorded stream, or 0 if unknown
 
         #ifdef LLGL_ENABLE_JIT_COMPILER
         std::unique_ptr<JITProgram> executable_;
@@ -8,6 +8,7 @@
 #include "GLImmediateCommandBuffer.h"
 #include "GLDeferredCommandBuffer.h"
 #include "GLCommandExecutor.h"
+#include "GLCommand.h"
 #include <LLGL/StaticLimits.h>
 #include <LLGL/TypeInfo.h>
 
@@ -33,12 +34,15 @@
 
 #include "../Buffer/GLBufferWithVAO.h"
 #include "../Buffer/GLBufferArrayWithVAO.h"
+#include "../Buffer/GLUniformRingBuffer.h"
 
 #include "../RenderState/GLStateManager.h"
 #include "../RenderState/GLGraphicsPSO.h"
+#include "../RenderState/GLPipelineLayout.h"
 #include "../RenderState/GLResourceHeap.h"
 #include "../RenderState/GLRenderPass.h"
 #include "../RenderState/GLQueryHeap.h"
+#include "../Platform/GLUploadContext.h"
 
 #include <cstring> // std::strlen
 
@@ -56,7 +60,9 @@ GLImmediateCommandBuffer::GLImmediateCommandBuffer(GLStateManager& stateManager)
 
 void GLImmediateCommandBuffer::Begin()
 {
-    // dummy
+    /* Make all finished asynchronous uploads visible before any commands are recorded */
+    if (auto uploadContext = GLUploadContext::Get())
+        uploadContext->Synchronize();
 }
 
 void GLImmediateCommandBuffer::End()
@@ -273,6 +279,12 @@ void GLImmediateCommandBuffer::SetVertexBuffer(Buffer& buffer)
         }
         else
         #endif // /LLGL_GL_ENABLE_OPENGL2X
+        if (HasExtension(GLExt::ARB_vertex_attrib_binding))
+        {
+            /* Bind shared VAO and vertex buffer bindings */
+            vertexBufferGL.GetSharedVertexArray().Bind(*stateMngr_);
+        }
+        else
         {
             /* Bind vertex array with native VAO */
             stateMngr_->BindVertexArray(vertexBufferGL.GetVaoID());
@@ -295,6 +307,12 @@ void GLImmediateCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
         }
         else
         #endif // /LLGL_GL_ENABLE_OPENGL2X
+        if (HasExtension(GLExt::ARB_vertex_attrib_binding))
+        {
+            /* Bind shared VAO and vertex buffer bindings */
+            vertexBufferArrayGL.GetSharedVertexArray().Bind(*stateMngr_);
+        }
+        else
         {
             /* Bind vertex array with native VAO */
             stateMngr_->BindVertexArray(vertexBufferArrayGL.GetVaoID());
@@ -330,6 +348,17 @@ void GLImmediateCommandBuffer::SetResourceHeap(
     resourceHeapGL.Bind(*stateMngr_, descriptorSet);
 }
 
+void GLImmediateCommandBuffer::SetResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           descriptorSet,
+    std::uint32_t           /*numDynamicOffsets*/,
+    const std::uint32_t*    /*dynamicOffsets*/,
+    const PipelineBindPoint bindPoint)
+{
+    /* Dynamic offsets are not supported by this renderer (see BindingFlags::DynamicOffset) */
+    SetResourceHeap(resourceHeap, descriptorSet, bindPoint);
+}
+
 void GLImmediateCommandBuffer::SetResource(Resource& resource, std::uint32_t slot, long bindFlags, long /*stageFlags*/)
 {
     switch (resource.GetResourceType())
@@ -448,14 +477,32 @@ void GLImmediateCommandBuffer::BeginRenderPass(
     /* Clear render target attachments with render pass */
     if (renderPass != nullptr)
     {
-        auto renderPassGL = LLGL_CAST(const GLRenderPass*, renderPass);
-        stateMngr_->ClearAttachmentsWithRenderPass(*renderPassGL, numClearValues, clearValues);
+        renderPass_ = LLGL_CAST(const GLRenderPass*, renderPass);
+        stateMngr_->ClearAttachmentsWithRenderPass(*renderPass_, numClearValues, clearValues);
+
+        /* Select draw buffers of first sub-pass */
+        subpass_ = 0;
+        if (renderPass_->GetNumSubpasses() > 0)
+            stateMngr_->BindSubpass(renderPass_, subpass_);
     }
 }
 
 void GLImmediateCommandBuffer::EndRenderPass()
 {
-    // dummy
+    /* Invalidate render target attachments that are not stored by the render pass */
+    if (renderPass_ != nullptr)
+    {
+        stateMngr_->InvalidateAttachmentsWithRenderPass(*renderPass_);
+        if (renderPass_->GetNumSubpasses() > 0)
+            stateMngr_->BindSubpass(nullptr, 0);
+        renderPass_ = nullptr;
+    }
+}
+
+void GLImmediateCommandBuffer::NextSubpass()
+{
+    if (renderPass_ != nullptr && subpass_ + 1 < renderPass_->GetNumSubpasses())
+        stateMngr_->BindSubpass(renderPass_, ++subpass_);
 }
 
 void GLImmediateCommandBuffer::Clear(long flags, const ClearValue& clearValue)
@@ -491,6 +538,7 @@ void GLImmediateCommandBuffer::SetPipelineState(PipelineState& pipelineState)
     /* Bind graphics pipeline render states */
     auto& pipelineStateGL = LLGL_CAST(GLPipelineState&, pipelineState);
     pipelineStateGL.Bind(*stateMngr_);
+    boundPipelineLayout_ = pipelineStateGL.GetPipelineLayout();
 
     /* Store draw and primitive mode */
     if (pipelineStateGL.IsGraphicsPSO())
@@ -529,6 +577,13 @@ void GLImmediateCommandBuffer::SetUniforms(
     if (dataSize == 0 || dataSize % 4 != 0)
         return;
 
+    /* Stream inline uniforms into uniform blocks if the pipeline layout declares any, otherwise set uniforms of the shader program */
+    if (boundPipelineLayout_ != nullptr && boundPipelineLayout_->GetNumInlineUniformValues() > 0)
+    {
+        SetInlineUniforms(*boundPipelineLayout_, static_cast<std::uint32_t>(location), data, dataSize);
+        return;
+    }
+
     GLSetUniformsByLocation(
         stateMngr_->GetBoundShaderProgram(),
         static_cast<GLint>(location),
@@ -556,15 +611,19 @@ void GLImmediateCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t quer
 void GLImmediateCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
 {
     #ifdef LLGL_GLEXT_CONDITIONAL_RENDER
-    auto& queryHeapGL = LLGL_CAST(GLQueryHeap&, queryHeap);
-    glBeginConditionalRender(queryHeapGL.GetID(query), GLTypes::Map(mode));
+    if (BeginRenderConditionMode(mode))
+    {
+        auto& queryHeapGL = LLGL_CAST(GLQueryHeap&, queryHeap);
+        glBeginConditionalRender(queryHeapGL.GetID(query), GLTypes::Map(mode));
+    }
     #endif
 }
 
 void GLImmediateCommandBuffer::EndRenderCondition()
 {
     #ifdef LLGL_GLEXT_CONDITIONAL_RENDER
-    glEndConditionalRender();
+    if (EndRenderConditionMode())
+        glEndConditionalRender();
     #endif
 }
 
@@ -618,6 +677,7 @@ The indices actually store the index start offset, but must be passed to GL as a
 
 void GLImmediateCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
 {
+    stateMngr_->FlushPendingStates();
     glDrawArrays(
         renderState_.drawMode,
         static_cast<GLint>(firstVertex),
@@ -627,6 +687,7 @@ void GLImmediateCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t fir
 
 void GLImmediateCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
 {
+    stateMngr_->FlushPendingStates();
     const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
     glDrawElements(
         renderState_.drawMode,
@@ -638,6 +699,7 @@ void GLImmediateCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32
 
 void GLImmediateCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    stateMngr_->FlushPendingStates();
     #ifdef LLGL_GLEXT_DRAW_ELEMENTS_BASE_VERTEX
     const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
     glDrawElementsBaseVertex(
@@ -652,6 +714,7 @@ void GLImmediateCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32
 
 void GLImmediateCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
 {
+    stateMngr_->FlushPendingStates();
     glDrawArraysInstanced(
         renderState_.drawMode,
         static_cast<GLint>(firstVertex),
@@ -662,6 +725,7 @@ void GLImmediateCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uin
 
 void GLImmediateCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
 {
+    stateMngr_->FlushPendingStates();
     #ifdef LLGL_GLEXT_BASE_INSTANCE
     glDrawArraysInstancedBaseInstance(
         renderState_.drawMode,
@@ -675,6 +739,7 @@ void GLImmediateCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uin
 
 void GLImmediateCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
 {
+    stateMngr_->FlushPendingStates();
     const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
     glDrawElementsInstanced(
         renderState_.drawMode,
@@ -687,6 +752,7 @@ void GLImmediateCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, st
 
 void GLImmediateCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    stateMngr_->FlushPendingStates();
     #ifdef LLGL_GLEXT_DRAW_ELEMENTS_BASE_VERTEX
     const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
     glDrawElementsInstancedBaseVertex(
@@ -702,6 +768,7 @@ void GLImmediateCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, st
 
 void GLImmediateCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
+    stateMngr_->FlushPendingStates();
     #ifdef LLGL_GLEXT_BASE_INSTANCE
     const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
     glDrawElementsInstancedBaseVertexBaseInstance(
@@ -718,6 +785,7 @@ void GLImmediateCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, st
 
 void GLImmediateCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    stateMngr_->FlushPendingStates();
     #ifdef LLGL_GLEXT_DRAW_INDIRECT
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     stateMngr_->BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, bufferGL.GetID());
@@ -732,6 +800,7 @@ void GLImmediateCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset
 
 void GLImmediateCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    stateMngr_->FlushPendingStates();
     #ifdef LLGL_GLEXT_DRAW_INDIRECT
     /* Bind indirect argument buffer */
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
@@ -767,6 +836,7 @@ void GLImmediateCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset
 
 void GLImmediateCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    stateMngr_->FlushPendingStates();
     #ifdef LLGL_GLEXT_DRAW_INDIRECT
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     stateMngr_->BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, bufferGL.GetID());
@@ -782,6 +852,7 @@ void GLImmediateCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t
 
 void GLImmediateCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    stateMngr_->FlushPendingStates();
     #ifdef LLGL_GLEXT_DRAW_INDIRECT
     /* Bind indirect argument buffer */
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
@@ -817,6 +888,37 @@ void GLImmediateCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t
     #endif
 }
 
+void GLImmediateCommandBuffer::DrawIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride)
+{
+    GLCmdMultiDrawArraysIndirectCount cmd;
+    {
+        cmd.id              = LLGL_CAST(GLBuffer&, buffer).GetID();
+        cmd.countId         = LLGL_CAST(GLBuffer&, countBuffer).GetID();
+        cmd.mode            = renderState_.drawMode;
+        cmd.indirect        = static_cast<GLintptr>(offset);
+        cmd.drawcount       = static_cast<GLintptr>(countOffset);
+        cmd.maxdrawcount    = static_cast<GLsizei>(maxNumCommands);
+        cmd.stride          = static_cast<GLsizei>(stride);
+    }
+    ExecuteGLMultiDrawArraysIndirectCount(cmd, *stateMngr_);
+}
+
+void GLImmediateCommandBuffer::DrawIndexedIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride)
+{
+    GLCmdMultiDrawElementsIndirectCount cmd;
+    {
+        cmd.id              = LLGL_CAST(GLBuffer&, buffer).GetID();
+        cmd.countId         = LLGL_CAST(GLBuffer&, countBuffer).GetID();
+        cmd.mode            = renderState_.drawMode;
+        cmd.type            = renderState_.indexBufferDataType;
+        cmd.indirect        = static_cast<GLintptr>(offset);
+        cmd.drawcount       = static_cast<GLintptr>(countOffset);
+        cmd.maxdrawcount    = static_cast<GLsizei>(maxNumCommands);
+        cmd.stride          = static_cast<GLsizei>(stride);
+    }
+    ExecuteGLMultiDrawElementsIndirectCount(cmd, *stateMngr_);
+}
+
 /* ----- Compute ----- */
 
 void GLImmediateCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
@@ -869,6 +971,16 @@ bool GLImmediateCommandBuffer::IsImmediateCmdBuffer() const
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+void GLImmediateCommandBuffer::BindInlineUniformBlock(GLuint index, const void* data, GLsizeiptr size)
+{
+    GLUniformRingBuffer::Get().BindUniformBlock(*stateMngr_, index, data, size);
+}
+
+
 } // /namespace LLGL
 
 
@@ -15,14 +15,41 @@ namespace LLGL
 
 static std::array<bool, static_cast<std::size_t>(GLExt::Count)> g_registeredExtensions { { false } };
 
+#ifdef LLGL_GL_ENABLE_LAZY_EXT_LOADING
+
+// Verification callbacks of extensions whose procedures have not been resolved yet.
+static std::array<bool (*)(), static_cast<std::size_t>(GLExt::Count)> g_pendingExtensions { { nullptr } };
+
+#endif // /LLGL_GL_ENABLE_LAZY_EXT_LOADING
+
 void RegisterExtension(GLExt extension)
 {
     g_registeredExtensions[static_cast<std::size_t>(extension)] = true;
 }
 
+#ifdef LLGL_GL_ENABLE_LAZY_EXT_LOADING
+
+void RegisterLazyExtension(GLExt extension, bool (*verifyProc)())
+{
+    g_pendingExtensions[static_cast<std::size_t>(extension)] = verifyProc;
+}
+
+#endif // /LLGL_GL_ENABLE_LAZY_EXT_LOADING
+
 bool HasExtension(const GLExt extension)
 {
-    return g_registeredExtensions[static_cast<std::size_t>(extension)];
+    const auto idx = static_cast<std::size_t>(extension);
+
+    #ifdef LLGL_GL_ENABLE_LAZY_EXT_LOADING
+    /* Only report a lazily loaded extension as supported once all of its procedures have been resolved */
+    if (auto verifyProc = g_pendingExtensions[idx])
+    {
+        g_pendingExtensions[idx] = nullptr;
+        g_registeredExtensions[idx] = verifyProc();
+    }
+    #endif
+
+    return g_registeredExtensions[idx];
 }
 
 bool HasNativeSamplers()
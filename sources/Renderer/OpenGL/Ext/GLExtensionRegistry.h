@@ -18,11 +18,13 @@ enum class GLExt
 {
     /* OpenGL core extensions (ARB) */
     ARB_base_instance = 0,              // GL 4.1
+    ARB_bindless_texture,
     ARB_clear_buffer_object,
     ARB_clear_texture,
     ARB_clip_control,
     ARB_buffer_storage,
     ARB_compute_shader,                 // GL 4.2
+    ARB_conditional_render_inverted,    // GL 4.5, no procedures
     ARB_copy_buffer,                    // GL 3.1
     ARB_copy_image,                     // GL 4.3
     ARB_direct_state_access,            // GL 4.5
@@ -37,9 +39,11 @@ enum class GLExt
     ARB_get_texture_sub_image,          // GL 4.5
     ARB_geometry_shader4,               // no procedures
     ARB_gl_spirv,                       // GL 4.6
+    ARB_indirect_parameters,            // GL 4.6
     ARB_instanced_arrays,               // GL 2.1
     ARB_internalformat_query,
     ARB_internalformat_query2,
+    ARB_invalidate_subdata,             // GL 4.3
     ARB_multitexture,
     ARB_multi_bind,                     // GL 4.3
     ARB_multi_draw_indirect,
@@ -62,11 +66,13 @@ enum class GLExt
     ARB_texture_multisample,
     ARB_texture_storage,
     ARB_texture_storage_multisample,
+    ARB_texture_barrier,                // GL 4.5
     ARB_texture_view,                   // GL 4.3
     ARB_timer_query,
     ARB_transform_feedback3,
     ARB_uniform_buffer_object,
     ARB_vertex_array_object,
+    ARB_vertex_attrib_binding,          // GL 4.3
     ARB_vertex_buffer_object,
     ARB_vertex_shader,
     ARB_viewport_array,
@@ -77,6 +83,7 @@ enum class GLExt
 
     /* Khronos group extensions (KHR) */
     KHR_debug,
+    KHR_parallel_shader_compile,
 
     /* Multi-vendor extensions (EXT) */
     EXT_blend_color,
@@ -85,6 +92,7 @@ enum class GLExt
     EXT_blend_minmax,
     EXT_copy_texture,                   // GL 1.2
     EXT_draw_buffers2,
+    EXT_shader_framebuffer_fetch,       // no procedures
     EXT_gpu_shader4,
     EXT_stencil_two_side,               //ATI_separate_stencil,
     EXT_texture3D,                      // GL 1.2
@@ -95,7 +103,7 @@ enum class GLExt
     OES_tessellation_shader,            // GLES 3.2
 
     /* NVIDIA specific extensions (NV) */
-    NV_conditional_render,              //TODO: part of GL 3.0 core profile
+    NV_conditional_render,              // GL 3.0
     NV_conservative_raster,             // no procedures
     NV_transform_feedback,
 
@@ -110,6 +118,13 @@ enum class GLExt
 // Registers the specified OpenGL extension support.
 void RegisterExtension(GLExt extension);
 
+#ifdef LLGL_GL_ENABLE_LAZY_EXT_LOADING
+
+// Registers the specified OpenGL extension with a callback that resolves and verifies its procedures with the first query via HasExtension.
+void RegisterLazyExtension(GLExt extension, bool (*verifyProc)());
+
+#endif // /LLGL_GL_ENABLE_LAZY_EXT_LOADING
+
 // Returns true if the specified OpenGL extension is supported.
 bool HasExtension(const GLExt extension);
 
@@ -8,9 +8,14 @@
 #include "../Ext/GLExtensionLoader.h"
 #include "GLCoreExtensions.h"
 #include "GLCoreExtensionsProxy.h"
+#include "../GLCore.h"
 #include <LLGL/Log.h>
 #include <functional>
 
+#if defined(__linux__) && defined(LLGL_GL_ENABLE_EGL)
+#   include <EGL/egl.h>
+#endif
+
 
 namespace LLGL
 {
@@ -27,6 +32,12 @@ bool LoadGLProc(T& procAddr, const char* procName)
     */
     #if defined(_WIN32)
     procAddr = reinterpret_cast<T>(wglGetProcAddress(procName));
+    #elif defined(__linux__) && defined(LLGL_GL_ENABLE_EGL)
+    /* Headless contexts are created with EGL and don't have a GLX context */
+    if (eglGetCurrentContext() != EGL_NO_CONTEXT)
+        procAddr = reinterpret_cast<T>(eglGetProcAddress(procName));
+    else
+        procAddr = reinterpret_cast<T>(glXGetProcAddress(reinterpret_cast<const GLubyte*>(procName)));
     #elif defined(__linux__)
     procAddr = reinterpret_cast<T>(glXGetProcAddress(reinterpret_cast<const GLubyte*>(procName)));
     #else
@@ -44,6 +55,50 @@ bool LoadGLProc(T& procAddr, const char* procName)
     return true;
 }
 
+#ifdef LLGL_GL_ENABLE_LAZY_EXT_LOADING
+
+/*
+Trampoline that stands in for a GL procedure until it is called for the first time.
+It then resolves the real procedure address, stores it in the global function pointer, and forwards the call,
+so only procedures that are actually used cost a GetProcAddress call. 'TName::Get()' must return the procedure name.
+Concurrent first calls resolve the same address, so the function pointer is only overwritten with an equal value.
+*/
+template <typename TProc, TProc* ProcAddr, typename TName>
+struct GLLazyProc;
+
+template <typename TRet, typename... TArgs, TRet (APIENTRY **ProcAddr)(TArgs...), typename TName>
+struct GLLazyProc<TRet (APIENTRY *)(TArgs...), ProcAddr, TName>
+{
+    static TRet APIENTRY Invoke(TArgs... args)
+    {
+        if (!LoadGLProc(*ProcAddr, TName::Get()))
+        {
+            /* Keep trampoline for subsequent calls, so they report the error again instead of calling a null pointer */
+            *ProcAddr = Invoke;
+            ErrUnsupportedGLProc(TName::Get());
+        }
+        return (*ProcAddr)(args...);
+    }
+};
+
+// Specifies whether RESOLVE_GLPROC resolves procedures immediately, which is only the case during VerifyGLExtension.
+static bool g_verifyGLProcs = false;
+
+/*
+Resolves all procedures of the specified extension and returns true if they are all available.
+This is called with the first query of the extension via HasExtension, so unavailable procedures are not reported as supported.
+*/
+template <bool (*LoadProc)(bool)>
+bool VerifyGLExtension()
+{
+    g_verifyGLProcs = true;
+    const bool result = LoadProc(false);
+    g_verifyGLProcs = false;
+    return result;
+}
+
+#endif // /LLGL_GL_ENABLE_LAZY_EXT_LOADING
+
 static void ExtractExtensionsFromString(GLExtensionList& extensions, const std::string& extString)
 {
     size_t first = 0, last = 0;
@@ -64,20 +119,42 @@ static void ExtractExtensionsFromString(GLExtensionList& extensions, const std::
 #define LOAD_GLPROC_SIMPLE(NAME) \
     LoadGLProc(NAME, #NAME)
 
-#ifdef LLGL_GL_ENABLE_EXT_PLACEHOLDERS
-
-#define LOAD_GLPROC(NAME)               \
-    if (usePlaceholder)                 \
-        NAME = Proxy_##NAME;            \
-    else if (!LoadGLProc(NAME, #NAME))  \
-        return false
+#ifdef LLGL_GL_ENABLE_LAZY_EXT_LOADING
+
+// Installs the lazy trampoline; the procedure is resolved on its first call or when the extension is verified (see VerifyGLExtension)
+#define RESOLVE_GLPROC(NAME)                                                    \
+    if (g_verifyGLProcs)                                                        \
+    {                                                                           \
+        if (!LoadGLProc(NAME, #NAME))                                           \
+            return false;                                                       \
+    }                                                                           \
+    else                                                                        \
+    {                                                                           \
+        struct GLProcName { static const char* Get() { return #NAME; } };       \
+        NAME = GLLazyProc<decltype(NAME), &NAME, GLProcName>::Invoke;           \
+    }
 
 #else
 
-#define LOAD_GLPROC(NAME)           \
+#define RESOLVE_GLPROC(NAME)        \
     if (!LoadGLProc(NAME, #NAME))   \
         return false
 
+#endif // /LLGL_GL_ENABLE_LAZY_EXT_LOADING
+
+#ifdef LLGL_GL_ENABLE_EXT_PLACEHOLDERS
+
+#define LOAD_GLPROC(NAME)       \
+    if (usePlaceholder)         \
+        NAME = Proxy_##NAME;    \
+    else                        \
+        RESOLVE_GLPROC(NAME)
+
+#else
+
+#define LOAD_GLPROC(NAME) \
+    RESOLVE_GLPROC(NAME)
+
 #endif // /LLGL_GL_ENABLE_EXT_PLACEHOLDERS
 
 /* --- Common GL extensions --- */
@@ -157,6 +234,17 @@ static bool Load_GL_ARB_vertex_array_object(bool usePlaceholder)
     return true;
 }
 
+static bool Load_GL_ARB_vertex_attrib_binding(bool usePlaceholder)
+{
+    LOAD_GLPROC( glBindVertexBuffer     );
+    LOAD_GLPROC( glVertexAttribFormat   );
+    LOAD_GLPROC( glVertexAttribIFormat  );
+    LOAD_GLPROC( glVertexAttribLFormat  );
+    LOAD_GLPROC( glVertexAttribBinding  );
+    LOAD_GLPROC( glVertexBindingDivisor );
+    return true;
+}
+
 static bool Load_GL_ARB_vertex_shader(bool usePlaceholder)
 {
     LOAD_GLPROC( glEnableVertexAttribArray  );
@@ -581,6 +669,13 @@ static bool Load_GL_ARB_multi_bind(bool usePlaceholder)
     return true;
 }
 
+static bool Load_GL_ARB_invalidate_subdata(bool usePlaceholder)
+{
+    LOAD_GLPROC( glInvalidateFramebuffer    );
+    LOAD_GLPROC( glInvalidateSubFramebuffer );
+    return true;
+}
+
 static bool Load_GL_EXT_stencil_two_side(bool usePlaceholder)
 {
     //correct extension ??? maybe "GL_ATI_separate_stencil"
@@ -606,12 +701,24 @@ static bool Load_GL_KHR_debug(bool usePlaceholder)
     return true;
 }
 
+static bool Load_GL_KHR_parallel_shader_compile(bool usePlaceholder)
+{
+    LOAD_GLPROC( glMaxShaderCompilerThreadsKHR );
+    return true;
+}
+
 static bool Load_GL_ARB_clip_control(bool usePlaceholder)
 {
     LOAD_GLPROC( glClipControl );
     return true;
 }
 
+static bool Load_GL_ARB_texture_barrier(bool usePlaceholder)
+{
+    LOAD_GLPROC( glTextureBarrier );
+    return true;
+}
+
 static bool Load_GL_ARB_draw_buffers(bool usePlaceholder)
 {
     LOAD_GLPROC( glDrawBuffers );
@@ -764,6 +871,22 @@ static bool Load_GL_ARB_multi_draw_indirect(bool usePlaceholder)
     return true;
 }
 
+static bool Load_GL_ARB_indirect_parameters(bool usePlaceholder)
+{
+    LOAD_GLPROC( glMultiDrawArraysIndirectCountARB   );
+    LOAD_GLPROC( glMultiDrawElementsIndirectCountARB );
+    return true;
+}
+
+static bool Load_GL_ARB_bindless_texture(bool usePlaceholder)
+{
+    LOAD_GLPROC( glGetTextureHandleARB             );
+    LOAD_GLPROC( glGetTextureSamplerHandleARB      );
+    LOAD_GLPROC( glMakeTextureHandleResidentARB    );
+    LOAD_GLPROC( glMakeTextureHandleNonResidentARB );
+    return true;
+}
+
 static bool Load_GL_ARB_get_texture_sub_image(bool usePlaceholder)
 {
     LOAD_GLPROC( glGetTextureSubImage           );
@@ -951,6 +1074,7 @@ static void IncludeDefaultCoreProfileExtensions(GLExtensionList& extensions)
         "GL_EXT_copy_texture",
         "GL_EXT_blend_func_separate",   // GL 2.0
         "GL_EXT_stencil_two_side",      // GL 2.0
+        "GL_NV_conditional_render",     // GL 3.0
     };
     for (const auto& ext : coreProfileDefaultExtenions)
         extensions[ext] = false;
@@ -1053,7 +1177,11 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
 
     #else // __APPLE__
 
+    #ifdef LLGL_GL_ENABLE_LAZY_EXT_LOADING
+    auto LoadExtension = [&](const std::string& extName, const std::function<bool(bool)>& extLoadingProc, GLExt extensionID, bool (*extVerifyProc)()) -> void
+    #else
     auto LoadExtension = [&](const std::string& extName, const std::function<bool(bool)>& extLoadingProc, GLExt extensionID) -> void
+    #endif
     {
         /* Try to load OpenGL extension */
         auto it = extensions.find(extName);
@@ -1062,7 +1190,11 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
             if (extLoadingProc(false))
             {
                 /* Enable extension in registry */
+                #ifdef LLGL_GL_ENABLE_LAZY_EXT_LOADING
+                RegisterLazyExtension(extensionID, extVerifyProc);
+                #else
                 RegisterExtension(extensionID);
+                #endif
                 it->second = true;
             }
             else
@@ -1087,8 +1219,13 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
             RegisterExtension(extensionID);
     };
 
+    #ifdef LLGL_GL_ENABLE_LAZY_EXT_LOADING
+    #define LOAD_GLEXT(NAME) \
+        LoadExtension("GL_" + std::string(#NAME), Load_GL_##NAME, GLExt::NAME, VerifyGLExtension<Load_GL_##NAME>)
+    #else
     #define LOAD_GLEXT(NAME) \
         LoadExtension("GL_" + std::string(#NAME), Load_GL_##NAME, GLExt::NAME)
+    #endif
 
     #define ENABLE_GLEXT(NAME) \
         EnableExtension("GL_" + std::string(#NAME), GLExt::NAME)
@@ -1106,6 +1243,7 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
     /* Load hardware buffer extensions */
     LOAD_GLEXT( ARB_vertex_buffer_object         );
     LOAD_GLEXT( ARB_vertex_array_object          );
+    LOAD_GLEXT( ARB_vertex_attrib_binding        );
     LOAD_GLEXT( ARB_vertex_shader                );
     LOAD_GLEXT( ARB_framebuffer_object           );
     LOAD_GLEXT( ARB_uniform_buffer_object        );
@@ -1138,6 +1276,7 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
     LOAD_GLEXT( ARB_texture_compression          );
     LOAD_GLEXT( ARB_texture_multisample          );
     LOAD_GLEXT( ARB_texture_view                 );
+    LOAD_GLEXT( ARB_texture_barrier              );
     LOAD_GLEXT( ARB_sampler_objects              );
 
     /* Load blending extensions */
@@ -1153,8 +1292,10 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
     LOAD_GLEXT( NV_conditional_render            );
     LOAD_GLEXT( ARB_timer_query                  );
     LOAD_GLEXT( ARB_multi_bind                   );
+    LOAD_GLEXT( ARB_invalidate_subdata           );
     LOAD_GLEXT( EXT_stencil_two_side             );
     LOAD_GLEXT( KHR_debug                        );
+    LOAD_GLEXT( KHR_parallel_shader_compile      );
     LOAD_GLEXT( ARB_clip_control                 );
     LOAD_GLEXT( ARB_draw_buffers                 );
     LOAD_GLEXT( EXT_draw_buffers2                );
@@ -1176,7 +1317,9 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
     LOAD_GLEXT( ARB_clear_buffer_object          );
     LOAD_GLEXT( ARB_draw_indirect                );
     LOAD_GLEXT( ARB_multi_draw_indirect          );
+    LOAD_GLEXT( ARB_indirect_parameters          );
     LOAD_GLEXT( ARB_get_texture_sub_image        );
+    LOAD_GLEXT( ARB_bindless_texture             );
     #ifdef LLGL_GL_ENABLE_DSA_EXT
     LOAD_GLEXT( ARB_direct_state_access          );
     #endif
@@ -1192,6 +1335,8 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
     ENABLE_GLEXT( NV_conservative_raster           );
     ENABLE_GLEXT( INTEL_conservative_rasterization );
     ENABLE_GLEXT( ARB_pipeline_statistics_query    );
+    ENABLE_GLEXT( ARB_conditional_render_inverted  );
+    ENABLE_GLEXT( EXT_shader_framebuffer_fetch     );
 
     #undef LOAD_GLEXT
     #undef ENABLE_GLEXT
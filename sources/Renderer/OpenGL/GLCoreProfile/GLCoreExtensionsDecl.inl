@@ -131,6 +131,11 @@ DECL_GLPROC(PFNGLCOPYTEXSUBIMAGE3DPROC,                             glCopyTexSub
 DECL_GLPROC(PFNGLCLEARTEXIMAGEPROC,                                 glClearTexImage,                                void,           (GLuint, GLint, GLenum, GLenum, const void*));
 DECL_GLPROC(PFNGLCLEARTEXSUBIMAGEPROC,                              glClearTexSubImage,                             void,           (GLuint, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLenum, const void*));
 
+/* GL_ARB_invalidate_subdata */
+
+DECL_GLPROC(PFNGLINVALIDATEFRAMEBUFFERPROC,                         glInvalidateFramebuffer,                        void,           (GLenum, GLsizei, const GLenum*));
+DECL_GLPROC(PFNGLINVALIDATESUBFRAMEBUFFERPROC,                      glInvalidateSubFramebuffer,                     void,           (GLenum, GLsizei, const GLenum*, GLint, GLint, GLsizei, GLsizei));
+
 /* GL_ARB_texture_compression */
 
 DECL_GLPROC(PFNGLCOMPRESSEDTEXIMAGE1DPROC,                          glCompressedTexImage1D,                         void,           (GLenum, GLint, GLenum, GLsizei, GLint, GLsizei, const void*));
@@ -214,6 +219,15 @@ DECL_GLPROC(PFNGLDELETEVERTEXARRAYSPROC,                            glDeleteVert
 DECL_GLPROC(PFNGLBINDVERTEXARRAYPROC,                               glBindVertexArray,                              void,           (GLuint));
 DECL_GLPROC(PFNGLISVERTEXARRAYPROC,                                 glIsVertexArray,                                GLboolean,      (GLuint));
 
+/* GL_ARB_vertex_attrib_binding */
+
+DECL_GLPROC(PFNGLBINDVERTEXBUFFERPROC,                              glBindVertexBuffer,                             void,           (GLuint, GLuint, GLintptr, GLsizei));
+DECL_GLPROC(PFNGLVERTEXATTRIBFORMATPROC,                            glVertexAttribFormat,                           void,           (GLuint, GLint, GLenum, GLboolean, GLuint));
+DECL_GLPROC(PFNGLVERTEXATTRIBIFORMATPROC,                           glVertexAttribIFormat,                          void,           (GLuint, GLint, GLenum, GLuint));
+DECL_GLPROC(PFNGLVERTEXATTRIBLFORMATPROC,                           glVertexAttribLFormat,                          void,           (GLuint, GLint, GLenum, GLuint));
+DECL_GLPROC(PFNGLVERTEXATTRIBBINDINGPROC,                           glVertexAttribBinding,                          void,           (GLuint, GLuint));
+DECL_GLPROC(PFNGLVERTEXBINDINGDIVISORPROC,                          glVertexBindingDivisor,                         void,           (GLuint, GLuint));
+
 /* GL_ARB_framebuffer_object */
 
 DECL_GLPROC(PFNGLGENRENDERBUFFERSPROC,                              glGenRenderbuffers,                             void,           (GLsizei n, GLuint *));
@@ -483,10 +497,18 @@ DECL_GLPROC(PFNGLGETOBJECTLABELPROC,                                glGetObjectL
 DECL_GLPROC(PFNGLOBJECTPTRLABELPROC,                                glObjectPtrLabel,                               void,           (const void*, GLsizei, const GLchar*));
 DECL_GLPROC(PFNGLGETOBJECTPTRLABELPROC,                             glGetObjectPtrLabel,                            void,           (const void*, GLsizei, GLsizei*, GLchar*));
 
+/* GL_KHR_parallel_shader_compile */
+
+DECL_GLPROC(PFNGLMAXSHADERCOMPILERTHREADSKHRPROC,                   glMaxShaderCompilerThreadsKHR,                  void,           (GLuint));
+
 /* GL_ARB_clip_control */
 
 DECL_GLPROC(PFNGLCLIPCONTROLPROC,                                   glClipControl,                                  void,           (GLenum, GLenum));
 
+/* GL_ARB_texture_barrier */
+
+DECL_GLPROC(PFNGLTEXTUREBARRIERPROC,                                glTextureBarrier,                               void,           (void));
+
 /* GL_EXT_transform_feedback */
 
 DECL_GLPROC(PFNGLBINDBUFFERRANGEPROC,                               glBindBufferRange,                              void,           (GLenum, GLuint, GLuint, GLintptr, GLsizeiptr));
@@ -586,11 +608,23 @@ DECL_GLPROC(PFNGLDRAWELEMENTSINDIRECTPROC,                          glDrawElemen
 DECL_GLPROC(PFNGLMULTIDRAWARRAYSINDIRECTPROC,                       glMultiDrawArraysIndirect,                      void,           (GLenum, const void*, GLsizei, GLsizei));
 DECL_GLPROC(PFNGLMULTIDRAWELEMENTSINDIRECTPROC,                     glMultiDrawElementsIndirect,                    void,           (GLenum, GLenum, const void*, GLsizei, GLsizei));
 
+/* GL_ARB_indirect_parameters */
+
+DECL_GLPROC(PFNGLMULTIDRAWARRAYSINDIRECTCOUNTARBPROC,               glMultiDrawArraysIndirectCountARB,              void,           (GLenum, const void*, GLintptr, GLsizei, GLsizei));
+DECL_GLPROC(PFNGLMULTIDRAWELEMENTSINDIRECTCOUNTARBPROC,             glMultiDrawElementsIndirectCountARB,            void,           (GLenum, GLenum, const void*, GLintptr, GLsizei, GLsizei));
+
 /* GL_ARB_get_texture_sub_image */
 
 DECL_GLPROC(PFNGLGETTEXTURESUBIMAGEPROC,                            glGetTextureSubImage,                           void,           (GLuint, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLenum, GLsizei, void*));
 DECL_GLPROC(PFNGLGETCOMPRESSEDTEXTURESUBIMAGEPROC,                  glGetCompressedTextureSubImage,                 void,           (GLuint, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLsizei, void*));
 
+/* GL_ARB_bindless_texture */
+
+DECL_GLPROC(PFNGLGETTEXTUREHANDLEARBPROC,                           glGetTextureHandleARB,                          GLuint64,       (GLuint));
+DECL_GLPROC(PFNGLGETTEXTURESAMPLERHANDLEARBPROC,                    glGetTextureSamplerHandleARB,                   GLuint64,       (GLuint, GLuint));
+DECL_GLPROC(PFNGLMAKETEXTUREHANDLERESIDENTARBPROC,                  glMakeTextureHandleResidentARB,                 void,           (GLuint64));
+DECL_GLPROC(PFNGLMAKETEXTUREHANDLENONRESIDENTARBPROC,               glMakeTextureHandleNonResidentARB,              void,           (GLuint64));
+
 /* GL_ARB_direct_state_access */
 
 DECL_GLPROC(PFNGLCREATETRANSFORMFEEDBACKSPROC,                      glCreateTransformFeedbacks,                     void,           (GLsizei, GLuint*));
@@ -144,6 +144,27 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
 
     #undef LOAD_GLEXT
 
+    /* Framebuffer fetch has no procedures and only extends the shading language */
+    if (extensions.find("GL_EXT_shader_framebuffer_fetch") != extensions.end())
+        RegisterExtension(GLExt::EXT_shader_framebuffer_fetch);
+
+    /* Program binaries and framebuffer invalidation are core functionality since OpenGL ES 3.0 */
+    #ifdef GL_ES_VERSION_3_0
+    RegisterExtension(GLExt::ARB_get_program_binary);
+    RegisterExtension(GLExt::ARB_invalidate_subdata);
+    #endif
+
+    /* Separate vertex attribute formats and vertex buffer bindings are core functionality since OpenGL ES 3.1 */
+    #ifdef GL_ES_VERSION_3_1
+    RegisterExtension(GLExt::ARB_vertex_attrib_binding);
+    #endif
+
+    /* Compute shaders and image load/store are core functionality since OpenGL ES 3.1 */
+    #ifdef GL_ES_VERSION_3_1
+    RegisterExtension(GLExt::ARB_compute_shader);
+    RegisterExtension(GLExt::ARB_shader_image_load_store);
+    #endif
+
     g_extAlreadyLoaded = true;
 }
 
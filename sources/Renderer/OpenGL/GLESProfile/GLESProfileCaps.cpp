@@ -155,12 +155,15 @@ static void GLGetSupportedFeatures(RenderingFeatures& features, GLint version)
     features.hasInstancing                  = (version >= 300); // GLES 3.0
     features.hasOffsetInstancing            = false;
     features.hasIndirectDrawing             = (version >= 310); // GLES 3.1
+    features.hasIndirectCountDrawing        = false;
     features.hasViewportArrays              = false;
     features.hasConservativeRasterization   = false;
     features.hasStreamOutputs               = (version >= 300); // GLES 3.0
     features.hasLogicOp                     = false;
     features.hasPipelineStatistics          = false;
     features.hasRenderCondition             = false;
+    features.hasNativeCommandLists          = false;
+    features.hasFramebufferFetch            = HasExtension(GLExt::EXT_shader_framebuffer_fetch);
 }
 
 static void GLGetFeatureLimits(RenderingLimits& limits, GLint version)
@@ -8,6 +8,7 @@
 #include "../ModuleInterface.h"
 #include "GLRenderSystem.h"
 #include "GLProfile.h"
+#include "Platform/GLContext.h"
 
 
 namespace LLGL
@@ -39,6 +40,13 @@ namespace ModuleOpenGL
     {
         return new GLRenderSystem(*renderSystemDesc);
     }
+
+    void QueryVideoAdapters(const LLGL::RenderSystemDescriptor* renderSystemDesc, std::vector<LLGL::VideoAdapterDescriptor>& outAdapters)
+    {
+        /* Only headless contexts can be created on a specific device, all others are bound to the display */
+        if ((renderSystemDesc->flags & RenderSystemFlags::Headless) != 0)
+            GLContext::QueryHeadlessVideoAdapters(outAdapters);
+    }
 } // /namespace ModuleOpenGL
 
 
@@ -74,6 +82,19 @@ LLGL_EXPORT void* LLGL_RenderSystem_Alloc(const void* renderSystemDesc, int rend
     return nullptr;
 }
 
+LLGL_EXPORT int LLGL_RenderSystem_QueryVideoAdapters(const void* renderSystemDesc, int renderSystemDescSize, void* outAdapters)
+{
+    if (renderSystemDesc != nullptr && static_cast<std::size_t>(renderSystemDescSize) == sizeof(LLGL::RenderSystemDescriptor) && outAdapters != nullptr)
+    {
+        auto desc       = reinterpret_cast<const LLGL::RenderSystemDescriptor*>(renderSystemDesc);
+        auto adapters   = reinterpret_cast<std::vector<LLGL::VideoAdapterDescriptor>*>(outAdapters);
+        const auto numAdapters = adapters->size();
+        LLGL::ModuleOpenGL::QueryVideoAdapters(desc, *adapters);
+        return static_cast<int>(adapters->size() - numAdapters);
+    }
+    return 0;
+}
+
 } // /extern "C"
 
 #endif // /LLGL_BUILD_STATIC_LIB
@@ -9,25 +9,32 @@
 #include "GLProfile.h"
 #include "Texture/GLMipGenerator.h"
 #include "Texture/GLTextureViewPool.h"
+#include "Texture/GLPixelBufferPool.h"
 #include "Ext/GLExtensions.h"
 #include "Ext/GLExtensionRegistry.h"
 #include "RenderState/GLStatePool.h"
 #include "../RenderSystemUtils.h"
 #include "GLTypes.h"
 #include "GLCore.h"
+#include "GLSerialization.h"
 #include "Shader/GLLegacyShader.h"
 #include "Buffer/GLBufferWithVAO.h"
 #include "Buffer/GLBufferArrayWithVAO.h"
+#include "Buffer/GLUniformRingBuffer.h"
 #include "../CheckedCast.h"
 #include "../BufferUtils.h"
 #include "../TextureUtils.h"
 #include "../../Core/Helper.h"
 #include "../../Core/Assertion.h"
+#include <LLGL/Timer.h>
 #include "GLRenderingCaps.h"
 #include "Command/GLImmediateCommandBuffer.h"
 #include "Command/GLDeferredCommandBuffer.h"
 #include "RenderState/GLGraphicsPSO.h"
 #include "RenderState/GLComputePSO.h"
+#include "Platform/GLUploadContext.h"
+#include "../../Core/ProfilerZone.h"
+#include <string.h>
 
 #ifdef LLGL_OPENGL
 #   include "Shader/GLSeparableShader.h"
@@ -47,30 +54,68 @@ namespace LLGL
 
 static RendererConfigurationOpenGL GetGLProfileFromDesc(const RenderSystemDescriptor& renderSystemDesc)
 {
+    RendererConfigurationOpenGL profile;
     if (auto rendererConfigGL = GetRendererConfiguration<RendererConfigurationOpenGL>(renderSystemDesc))
-        return *rendererConfigGL;
-    else
-        return RendererConfigurationOpenGL{};
+        profile = *rendererConfigGL;
+
+    /* Explicit adapter selection takes precedence over the EGL device index */
+    if (renderSystemDesc.adapterIndex >= 0)
+        profile.deviceIndex = renderSystemDesc.adapterIndex;
+
+    return profile;
 }
 
 GLRenderSystem::GLRenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
-    contextMngr_ { GetGLProfileFromDesc(renderSystemDesc) }
+    contextMngr_
+    {
+        GetGLProfileFromDesc(renderSystemDesc),
+        ((renderSystemDesc.flags & RenderSystemFlags::Headless) != 0),
+        [this](const char* name, std::uint64_t startTick, std::uint64_t endTick)
+        {
+            RecordStartupPhase(name, startTick, endTick);
+        }
+    }
 {
+    if (auto rendererConfigGL = GetRendererConfiguration<RendererConfigurationOpenGL>(renderSystemDesc))
+        GLTextureViewPool::Get().SetMaxUnusedTextureViews(rendererConfigGL->maxUnusedTextureViews);
 }
 
 GLRenderSystem::~GLRenderSystem()
 {
+    /* Finish all asynchronous uploads while their resources are still alive */
+    if (auto uploadContext = GLUploadContext::Get())
+        uploadContext->WaitIdle();
+
     /* Clear all render state containers first, the rest will be deleted automatically */
     GLTextureViewPool::Get().Clear();
+    GLPixelBufferPool::Get().Clear();
+    GLUniformRingBuffer::Get().Clear();
     GLMipGenerator::Get().Clear();
     GLStatePool::Get().Clear();
 }
 
+// Waits for all pending asynchronous uploads of the specified resource.
+static void WaitForAsyncUpload(const Resource* resource)
+{
+    if (resource != nullptr)
+    {
+        if (auto uploadContext = GLUploadContext::Get())
+            uploadContext->Wait(resource);
+    }
+}
+
 /* ----- Swap-chain ----- */
 
 SwapChain* GLRenderSystem::CreateSwapChain(const SwapChainDescriptor& swapChainDesc, const std::shared_ptr<Surface>& surface)
 {
-    return AddSwapChain(MakeUnique<GLSwapChain>(swapChainDesc, surface, contextMngr_));
+    if (contextMngr_.IsHeadless())
+        throw std::runtime_error("cannot create swap-chain for headless OpenGL render system");
+
+    const std::uint64_t startTick = Timer::Tick();
+    auto swapChain = MakeUnique<GLSwapChain>(swapChainDesc, surface, contextMngr_);
+    RecordStartupPhase("swap-chain creation", startTick, Timer::Tick());
+
+    return AddSwapChain(std::move(swapChain));
 }
 
 void GLRenderSystem::Release(SwapChain& swapChain)
@@ -150,6 +195,19 @@ static GLenum GetGLBufferUsage(long miscFlags)
 
 static void GLBufferStorage(GLBuffer& bufferGL, const BufferDescriptor& bufferDesc, const void* initialData)
 {
+    #ifdef GL_ARB_buffer_storage
+    if ((bufferDesc.miscFlags & MiscFlags::Streaming) != 0 && HasExtension(GLExt::ARB_buffer_storage))
+    {
+        /* Allocate persistently mapped storage for streaming buffers */
+        bufferGL.BufferStorageStreaming(
+            static_cast<GLsizeiptr>(bufferDesc.size),
+            initialData,
+            GetGLBufferStorageFlags(bufferDesc.cpuAccessFlags)
+        );
+        return;
+    }
+    #endif // /GL_ARB_buffer_storage
+
     bufferGL.BufferStorage(
         static_cast<GLsizeiptr>(bufferDesc.size),
         initialData,
@@ -158,6 +216,31 @@ static void GLBufferStorage(GLBuffer& bufferGL, const BufferDescriptor& bufferDe
     );
 }
 
+// Enqueues the allocation of the buffer storage with a copy of the initial data on the upload context.
+static void EnqueueGLBufferStorage(
+    GLUploadContext&            uploadContext,
+    GLBuffer&                   bufferGL,
+    const BufferDescriptor&     bufferDesc,
+    const void*                 initialData,
+    GLUploadContext::TaskFunc&& finishTask = nullptr)
+{
+    auto bufferPtr  = &bufferGL;
+    auto dataBytes  = reinterpret_cast<const char*>(initialData);
+    auto dataCopy   = std::make_shared<std::vector<char>>(dataBytes, dataBytes + bufferDesc.size);
+
+    uploadContext.Enqueue(
+        bufferPtr,
+        [bufferPtr, bufferDesc, dataCopy]()
+        {
+            GLBufferStorage(*bufferPtr, bufferDesc, dataCopy->data());
+
+            /* Reset binding, since the state manager of the upload context is not notified about released buffers */
+            GLStateManager::Get().BindBuffer(bufferPtr->GetTarget(), 0);
+        },
+        std::move(finishTask)
+    );
+}
+
 Buffer* GLRenderSystem::CreateBuffer(const BufferDescriptor& bufferDesc, const void* initialData)
 {
     AssertCreateBuffer(bufferDesc, static_cast<std::uint64_t>(std::numeric_limits<GLsizeiptr>::max()));
@@ -174,11 +257,29 @@ Buffer* GLRenderSystem::CreateBuffer(const BufferDescriptor& bufferDesc, const v
 // private
 GLBuffer* GLRenderSystem::CreateGLBuffer(const BufferDescriptor& bufferDesc, const void* initialData)
 {
+    /* Upload initial data asynchronously if enabled; streaming buffers are always mapped on the render thread */
+    GLUploadContext* uploadContext = nullptr;
+    if (initialData != nullptr && (bufferDesc.miscFlags & MiscFlags::Streaming) == 0)
+        uploadContext = GetUploadContextForMiscFlags(bufferDesc.miscFlags);
+
     /* Create either base of sub-class GLBuffer object */
     if ((bufferDesc.bindFlags & BindFlags::VertexBuffer) != 0)
     {
         /* Create buffer with VAO and build vertex array */
         auto bufferGL = MakeUnique<GLBufferWithVAO>(bufferDesc.bindFlags);
+        if (uploadContext != nullptr)
+        {
+            /* VAOs are not shared between GL contexts, so build the vertex array on the render thread once the storage has been uploaded */
+            auto bufferPtr = bufferGL.get();
+            EnqueueGLBufferStorage(
+                *uploadContext, *bufferGL, bufferDesc, initialData,
+                [bufferPtr, bufferDesc]()
+                {
+                    bufferPtr->BuildVertexArray(bufferDesc.vertexAttribs.size(), bufferDesc.vertexAttribs.data());
+                }
+            );
+        }
+        else
         {
             GLBufferStorage(*bufferGL, bufferDesc, initialData);
             bufferGL->BuildVertexArray(bufferDesc.vertexAttribs.size(), bufferDesc.vertexAttribs.data());
@@ -189,9 +290,10 @@ GLBuffer* GLRenderSystem::CreateGLBuffer(const BufferDescriptor& bufferDesc, con
     {
         /* Create generic buffer */
         auto bufferGL = MakeUnique<GLBuffer>(bufferDesc.bindFlags);
-        {
+        if (uploadContext != nullptr)
+            EnqueueGLBufferStorage(*uploadContext, *bufferGL, bufferDesc, initialData);
+        else
             GLBufferStorage(*bufferGL, bufferDesc, initialData);
-        }
         return TakeOwnership(buffers_, std::move(bufferGL));
     }
 }
@@ -207,14 +309,18 @@ static bool IsBufferArrayWithVertexBufferBinding(std::uint32_t numBuffers, Buffe
     return false;
 }
 
-BufferArray* GLRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray)
+BufferArray* GLRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets)
 {
     AssertCreateBufferArray(numBuffers, bufferArray);
 
+    /* Vertex buffers must be complete before they can be referenced by another VAO */
+    for_range(i, numBuffers)
+        WaitForAsyncUpload(bufferArray[i]);
+
     if (IsBufferArrayWithVertexBufferBinding(numBuffers, bufferArray))
     {
         /* Create vertex buffer array and build VAO */
-        auto vertexBufferArray = MakeUnique<GLBufferArrayWithVAO>(numBuffers, bufferArray);
+        auto vertexBufferArray = MakeUnique<GLBufferArrayWithVAO>(numBuffers, bufferArray, offsets);
         return TakeOwnership(bufferArrays_, std::move(vertexBufferArray));
     }
 
@@ -223,6 +329,8 @@ BufferArray* GLRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer*
 
 void GLRenderSystem::Release(Buffer& buffer)
 {
+    if (auto uploadContext = GLUploadContext::Get())
+        uploadContext->Release(&buffer);
     RemoveFromUniqueSet(buffers_, &buffer);
 }
 
@@ -233,36 +341,50 @@ void GLRenderSystem::Release(BufferArray& bufferArray)
 
 void GLRenderSystem::WriteBuffer(Buffer& buffer, std::uint64_t offset, const void* data, std::uint64_t dataSize)
 {
+    WaitForAsyncUpload(&buffer);
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     bufferGL.BufferSubData(static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(dataSize), data);
 }
 
 void GLRenderSystem::ReadBuffer(Buffer& buffer, std::uint64_t offset, void* data, std::uint64_t dataSize)
 {
+    WaitForAsyncUpload(&buffer);
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     bufferGL.GetBufferSubData(static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(dataSize), data);
 }
 
-void* GLRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
+static GLbitfield ToGLMapBufferAccess(CPUAccess access)
 {
-    auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
-    return bufferGL.MapBuffer(GLTypes::Map(access));
+    switch (access)
+    {
+        case CPUAccess::ReadOnly:               return GL_MAP_READ_BIT;
+        case CPUAccess::WriteOnly:              return GL_MAP_WRITE_BIT;
+        case CPUAccess::WriteDiscard:           return GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+        case CPUAccess::ReadWrite:              return GL_MAP_READ_BIT | GL_MAP_WRITE_BIT;
+        case CPUAccess::WriteUnsynchronized:    return GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+        default:                                return 0;
+    }
 }
 
-static GLbitfield ToGLMapBufferAccess(CPUAccess access)
+void* GLRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
 {
-    switch (access)
+    WaitForAsyncUpload(&buffer);
+    auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+
+    /* Unsynchronized access can only be expressed with a mapped range */
+    if (access == CPUAccess::WriteUnsynchronized)
     {
-        case CPUAccess::ReadOnly:       return GL_MAP_READ_BIT;
-        case CPUAccess::WriteOnly:      return GL_MAP_WRITE_BIT;
-        case CPUAccess::WriteDiscard:   return GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
-        case CPUAccess::ReadWrite:      return GL_MAP_READ_BIT | GL_MAP_WRITE_BIT;
-        default:                        return 0;
+        GLint size = 0;
+        bufferGL.GetBufferParams(&size, nullptr, nullptr);
+        return bufferGL.MapBufferRange(0, static_cast<GLsizeiptr>(size), ToGLMapBufferAccess(access));
     }
+
+    return bufferGL.MapBuffer(GLTypes::Map(access));
 }
 
 void* GLRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t length)
 {
+    WaitForAsyncUpload(&buffer);
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     return bufferGL.MapBufferRange(static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(length), ToGLMapBufferAccess(access));
 }
@@ -313,6 +435,32 @@ void GLRenderSystem::ValidateGLTextureType(const TextureType type)
     }
 }
 
+// Copy of source image data for asynchronous uploads, since the client memory is only valid during the respective function call.
+struct GLAsyncImageData
+{
+    SrcImageDescriptor  imageDesc;
+    std::vector<char>   data;
+};
+
+static std::shared_ptr<GLAsyncImageData> CopyAsyncImageData(const SrcImageDescriptor& imageDesc)
+{
+    auto imageCopy = std::make_shared<GLAsyncImageData>();
+    {
+        auto dataBytes = reinterpret_cast<const char*>(imageDesc.data);
+        imageCopy->data.assign(dataBytes, dataBytes + imageDesc.dataSize);
+        imageCopy->imageDesc        = imageDesc;
+        imageCopy->imageDesc.data   = imageCopy->data.data();
+    }
+    return imageCopy;
+}
+
+// Resets the texture binding of the upload context, since its state manager is not notified about released textures.
+static void UnbindTextureOnUploadContext(GLTexture& textureGL)
+{
+    if (!textureGL.IsRenderbuffer())
+        GLStateManager::Get().BindTexture(GLStateManager::GetTextureTarget(textureGL.GetType()), 0);
+}
+
 Texture* GLRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc)
 {
     ValidateGLTextureType(textureDesc.type);
@@ -321,31 +469,140 @@ Texture* GLRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
     auto texture = MakeUnique<GLTexture>(textureDesc);
 
     /* Initialize either renderbuffer or texture image storage */
-    texture->BindAndAllocStorage(textureDesc, imageDesc);
+    if (auto uploadContext = GetUploadContextForMiscFlags(textureDesc.miscFlags))
+    {
+        /* Allocate storage and upload a copy of the initial image data on the upload context */
+        auto textureGL = texture.get();
+        auto imageCopy = (imageDesc != nullptr ? CopyAsyncImageData(*imageDesc) : nullptr);
+        uploadContext->Enqueue(
+            textureGL,
+            [textureGL, textureDesc, imageCopy]()
+            {
+                textureGL->BindAndAllocStorage(textureDesc, (imageCopy ? &(imageCopy->imageDesc) : nullptr));
+                UnbindTextureOnUploadContext(*textureGL);
+            }
+        );
+    }
+    else
+        texture->BindAndAllocStorage(textureDesc, imageDesc);
 
     return TakeOwnership(textures_, std::move(texture));
 }
 
 void GLRenderSystem::Release(Texture& texture)
 {
+    if (auto uploadContext = GLUploadContext::Get())
+        uploadContext->Release(&texture);
     RemoveFromUniqueSet(textures_, &texture);
 }
 
 void GLRenderSystem::WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
 {
-    /* Bind texture and write texture sub data */
     auto& textureGL = LLGL_CAST(GLTexture&, texture);
-    textureGL.TextureSubImage(textureRegion, imageDesc, false);
+
+    /* Write a copy of the image data on the upload context if the texture was created with MiscFlags::AsyncUpload */
+    auto uploadContext = GLUploadContext::Get();
+    if (uploadContext != nullptr && uploadContext->HasResource(&textureGL))
+    {
+        auto textureGLPtr   = &textureGL;
+        auto imageCopy      = CopyAsyncImageData(imageDesc);
+        uploadContext->Enqueue(
+            textureGLPtr,
+            [textureGLPtr, textureRegion, imageCopy]()
+            {
+                textureGLPtr->TextureSubImage(textureRegion, imageCopy->imageDesc, false);
+                UnbindTextureOnUploadContext(*textureGLPtr);
+            }
+        );
+    }
+    else
+    {
+        /* Upload image data through a pixel buffer object first, otherwise bind texture and write texture sub data from client memory */
+        if (!GLPixelBufferPool::Get().WriteTexture(textureGL, textureRegion, imageDesc))
+            textureGL.TextureSubImage(textureRegion, imageDesc, false);
+    }
 }
 
 void GLRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc)
 {
     /* Bind texture and write texture sub data */
     LLGL_ASSERT_PTR(imageDesc.data);
+    WaitForAsyncUpload(&texture);
     auto& textureGL = LLGL_CAST(GLTexture&, texture);
     textureGL.GetTextureSubImage(textureRegion, imageDesc, false);
 }
 
+/* ----- Native resources ----- */
+
+bool GLRenderSystem::QueryNativeHandle(const Resource& resource, NativeResourceHandle& outHandle)
+{
+    switch (resource.GetResourceType())
+    {
+        case ResourceType::Buffer:
+        {
+            auto& bufferGL = LLGL_CAST(const GLBuffer&, resource);
+            outHandle.type      = NativeHandleType::GLBuffer;
+            outHandle.object    = bufferGL.GetID();
+        }
+        break;
+
+        case ResourceType::Texture:
+        {
+            /* Renderbuffers cannot be shared as GL texture names */
+            auto& textureGL = LLGL_CAST(const GLTexture&, resource);
+            if (textureGL.IsRenderbuffer())
+                return false;
+            outHandle.type      = NativeHandleType::GLTexture;
+            outHandle.object    = textureGL.GetID();
+        }
+        break;
+
+        default:
+            return false;
+    }
+
+    outHandle.memory        = 0;
+    outHandle.memoryOffset  = 0;
+    outHandle.memorySize    = 0;
+
+    return true;
+}
+
+Buffer* GLRenderSystem::ImportBuffer(const BufferDescriptor& bufferDesc, const NativeResourceHandle& nativeHandle)
+{
+    if (nativeHandle.type != NativeHandleType::GLBuffer || nativeHandle.object == 0)
+        return nullptr;
+
+    AssertCreateBuffer(bufferDesc, static_cast<std::uint64_t>(std::numeric_limits<GLsizeiptr>::max()));
+
+    /* Wrap native buffer name; its storage has already been allocated by the client */
+    const auto nativeID = static_cast<GLuint>(nativeHandle.object);
+
+    GLBuffer* bufferGL = nullptr;
+    if ((bufferDesc.bindFlags & BindFlags::VertexBuffer) != 0)
+    {
+        auto bufferWithVAO = MakeUnique<GLBufferWithVAO>(bufferDesc.bindFlags, nativeID);
+        bufferWithVAO->BuildVertexArray(bufferDesc.vertexAttribs.size(), bufferDesc.vertexAttribs.data());
+        bufferGL = TakeOwnership(buffers_, std::move(bufferWithVAO));
+    }
+    else
+        bufferGL = TakeOwnership(buffers_, MakeUnique<GLBuffer>(bufferDesc.bindFlags, nativeID));
+
+    if ((bufferDesc.bindFlags & BindFlags::IndexBuffer) != 0 && bufferDesc.format != Format::Undefined)
+        bufferGL->SetIndexType(bufferDesc.format);
+
+    return bufferGL;
+}
+
+Texture* GLRenderSystem::ImportTexture(const TextureDescriptor& textureDesc, const NativeResourceHandle& nativeHandle)
+{
+    if (nativeHandle.type != NativeHandleType::GLTexture || nativeHandle.object == 0)
+        return nullptr;
+
+    ValidateGLTextureType(textureDesc.type);
+    return TakeOwnership(textures_, MakeUnique<GLTexture>(textureDesc, static_cast<GLuint>(nativeHandle.object)));
+}
+
 /* ----- Sampler States ---- */
 
 Sampler* GLRenderSystem::CreateSampler(const SamplerDescriptor& samplerDesc)
@@ -362,9 +619,7 @@ Sampler* GLRenderSystem::CreateSampler(const SamplerDescriptor& samplerDesc)
 
     /* Create native GL sampler state */
     LLGL_ASSERT_FEATURE_SUPPORT(hasSamplers);
-    auto sampler = MakeUnique<GLSampler>();
-    sampler->SetDesc(samplerDesc);
-    return TakeOwnership(samplers_, std::move(sampler));
+    return TakeOwnership(samplers_, MakeUnique<GLSampler>(samplerCache_, samplerDesc));
 }
 
 void GLRenderSystem::Release(Sampler& sampler)
@@ -382,8 +637,19 @@ void GLRenderSystem::Release(Sampler& sampler)
 
 /* ----- Resource Heaps ----- */
 
+// Waits for all pending asynchronous uploads of the specified resource views, since texture views require complete storage.
+static void WaitForAsyncUploads(const ArrayView<ResourceViewDescriptor>& resourceViews)
+{
+    if (GLUploadContext::Get() != nullptr)
+    {
+        for (const auto& resourceView : resourceViews)
+            WaitForAsyncUpload(resourceView.resource);
+    }
+}
+
 ResourceHeap* GLRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor& resourceHeapDesc, const ArrayView<ResourceViewDescriptor>& initialResourceViews)
 {
+    WaitForAsyncUploads(initialResourceViews);
     return TakeOwnership(resourceHeaps_, MakeUnique<GLResourceHeap>(resourceHeapDesc, initialResourceViews));
 }
 
@@ -394,6 +660,7 @@ void GLRenderSystem::Release(ResourceHeap& resourceHeap)
 
 std::uint32_t GLRenderSystem::WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews)
 {
+    WaitForAsyncUploads(resourceViews);
     auto& resourceHeapGL = LLGL_CAST(GLResourceHeap&, resourceHeap);
     return resourceHeapGL.WriteResourceViews(firstDescriptor, resourceViews);
 }
@@ -416,6 +683,8 @@ RenderTarget* GLRenderSystem::CreateRenderTarget(const RenderTargetDescriptor& r
 {
     LLGL_ASSERT_FEATURE_SUPPORT(hasRenderTargets);
     AssertCreateRenderTarget(renderTargetDesc);
+    for (const auto& attachment : renderTargetDesc.attachments)
+        WaitForAsyncUpload(attachment.texture);
     return TakeOwnership(renderTargets_, MakeUnique<GLRenderTarget>(renderTargetDesc));
 }
 
@@ -443,6 +712,10 @@ Shader* GLRenderSystem::CreateShader(const ShaderDescriptor& shaderDesc)
         case ShaderType::Compute:
             LLGL_ASSERT_FEATURE_SUPPORT(hasComputeShaders);
             break;
+        case ShaderType::Task:
+        case ShaderType::Mesh:
+            LLGL_ASSERT_FEATURE_SUPPORT(hasMeshShaders);
+            break;
         default:
             break;
     }
@@ -483,17 +756,48 @@ void GLRenderSystem::Release(PipelineLayout& pipelineLayout)
 
 PipelineState* GLRenderSystem::CreatePipelineState(const Blob& /*serializedCache*/)
 {
-    return nullptr;//TODO
+    /* Program binaries don't contain any render states, so they can only be restored together with a pipeline descriptor */
+    throw std::invalid_argument("serialized OpenGL PSO must be passed to CreatePipelineState together with its pipeline descriptor");
 }
 
-PipelineState* GLRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* /*serializedCache*/)
+PipelineState* GLRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache)
 {
-    return TakeOwnership(pipelineStates_, MakeUnique<GLGraphicsPSO>(pipelineStateDesc, GetRenderingCaps().limits));
+    LLGL_PROFILER_ZONE("GLRenderSystem::CreateGraphicsPipelineState");
+
+    /* Load program binary from the serialized cache of a previous run */
+    GLProgramBinary cachedBinary;
+    if (serializedCache != nullptr && *serializedCache != nullptr)
+        ReadProgramBinary(**serializedCache, cachedBinary);
+
+    auto pipelineState = TakeOwnership(
+        pipelineStates_,
+        MakeUnique<GLGraphicsPSO>(pipelineStateDesc, GetRenderingCaps().limits, (serializedCache != nullptr ? &cachedBinary : nullptr))
+    );
+
+    if (serializedCache != nullptr)
+        *serializedCache = WriteProgramBinary(Serialization::GLIdent_GraphicsPSOIdent, *pipelineState);
+
+    return pipelineState;
 }
 
-PipelineState* GLRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* /*serializedCache*/)
+PipelineState* GLRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache)
 {
-    return TakeOwnership(pipelineStates_, MakeUnique<GLComputePSO>(pipelineStateDesc));
+    LLGL_PROFILER_ZONE("GLRenderSystem::CreateComputePipelineState");
+
+    /* Load program binary from the serialized cache of a previous run */
+    GLProgramBinary cachedBinary;
+    if (serializedCache != nullptr && *serializedCache != nullptr)
+        ReadProgramBinary(**serializedCache, cachedBinary);
+
+    auto pipelineState = TakeOwnership(
+        pipelineStates_,
+        MakeUnique<GLComputePSO>(pipelineStateDesc, (serializedCache != nullptr ? &cachedBinary : nullptr))
+    );
+
+    if (serializedCache != nullptr)
+        *serializedCache = WriteProgramBinary(Serialization::GLIdent_ComputePSOIdent, *pipelineState);
+
+    return pipelineState;
 }
 
 void GLRenderSystem::Release(PipelineState& pipelineState)
@@ -554,6 +858,12 @@ void GLRenderSystem::CreateGLContextDependentDevices(GLStateManager& stateManage
     /* Create command queue instance */
     commandQueue_ = MakeUnique<GLCommandQueue>(stateManager);
 
+    #ifdef LLGL_GLEXT_PARALLEL_SHADER_COMPILE
+    /* Let the driver choose the maximum number of compiler threads to compile shaders in parallel */
+    if (HasExtension(GLExt::KHR_parallel_shader_compile))
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+    #endif
+
     /* Query renderer information and limits */
     QueryRendererInfo();
     QueryRenderingCaps();
@@ -602,12 +912,84 @@ void GLRenderSystem::SetDebugCallback(const DebugCallback& debugCallback)
     #endif // /GL_KHR_debug
 }
 
+GLUploadContext* GLRenderSystem::GetUploadContextForMiscFlags(long miscFlags)
+{
+    if ((miscFlags & MiscFlags::AsyncUpload) != 0)
+        return contextMngr_.GetUploadContext();
+    return nullptr;
+}
+
 static std::string GLGetString(GLenum name)
 {
     auto bytes = glGetString(name);
     return (bytes != nullptr ? std::string(reinterpret_cast<const char*>(bytes)) : "");
 }
 
+void GLRenderSystem::ReadProgramBinary(const Blob& serializedCache, GLProgramBinary& outBinary)
+{
+    Serialization::Deserializer reader{ serializedCache };
+
+    /* Read type of PSO */
+    auto seg = reader.ReadSegment();
+    if (seg.ident != Serialization::GLIdent_GraphicsPSOIdent && seg.ident != Serialization::GLIdent_ComputePSOIdent)
+        throw std::runtime_error("serialized cache does not denote an OpenGL graphics or compute PSO");
+
+    /* Ignore program binary if it was generated by a different driver; the program will be linked from source instead */
+    seg = reader.BeginOnMatch(Serialization::GLIdent_DriverInfo);
+    if (seg.ident != Serialization::GLIdent_DriverInfo)
+        return;
+
+    const std::string vendor    = reader.ReadCString();
+    const std::string renderer  = reader.ReadCString();
+    const std::string version   = reader.ReadCString();
+    reader.End();
+
+    if (vendor != GLGetString(GL_VENDOR) || renderer != GLGetString(GL_RENDERER) || version != GLGetString(GL_VERSION))
+        return;
+
+    /* Read program binary with its driver-specific format */
+    seg = reader.ReadSegmentOnMatch(Serialization::GLIdent_ProgramBinary);
+    if (seg.ident == Serialization::GLIdent_ProgramBinary && seg.size > sizeof(GLenum))
+    {
+        ::memcpy(&(outBinary.format), seg.data, sizeof(GLenum));
+        outBinary.data.assign(
+            reinterpret_cast<const char*>(seg.data) + sizeof(GLenum),
+            reinterpret_cast<const char*>(seg.data) + seg.size
+        );
+    }
+}
+
+std::unique_ptr<Blob> GLRenderSystem::WriteProgramBinary(Serialization::IdentType psoIdent, const GLPipelineState& pipelineState)
+{
+    Serialization::Serializer writer;
+
+    /* Write type of PSO */
+    writer.Begin(psoIdent);
+    writer.End();
+
+    /* Write program binary with the driver it was generated by; separable shader pipelines don't provide a program binary */
+    GLProgramBinary binary;
+    if (pipelineState.GetShaderPipeline()->GetProgramBinary(binary))
+    {
+        writer.Begin(Serialization::GLIdent_DriverInfo);
+        {
+            writer.WriteCString(GLGetString(GL_VENDOR).c_str());
+            writer.WriteCString(GLGetString(GL_RENDERER).c_str());
+            writer.WriteCString(GLGetString(GL_VERSION).c_str());
+        }
+        writer.End();
+
+        writer.Begin(Serialization::GLIdent_ProgramBinary, sizeof(GLenum) + binary.data.size());
+        {
+            writer.WriteTyped(binary.format);
+            writer.Write(binary.data.data(), binary.data.size());
+        }
+        writer.End();
+    }
+
+    return writer.Finalize();
+}
+
 void GLRenderSystem::QueryRendererInfo()
 {
     RendererInfo info;
@@ -12,6 +12,7 @@
 #include <LLGL/RenderSystem.h>
 #include "Ext/GLExtensionLoader.h"
 #include "../ContainerTypes.h"
+#include "../Serialization.h"
 
 #include "Command/GLCommandQueue.h"
 #include "Command/GLCommandBuffer.h"
@@ -77,7 +78,7 @@ class GLRenderSystem final : public RenderSystem
         /* ----- Buffers ------ */
 
         Buffer* CreateBuffer(const BufferDescriptor& bufferDesc, const void* initialData = nullptr) override;
-        BufferArray* CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray) override;
+        BufferArray* CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets = nullptr) override;
 
         void Release(Buffer& buffer) override;
         void Release(BufferArray& bufferArray) override;
@@ -98,6 +99,12 @@ class GLRenderSystem final : public RenderSystem
         void WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc) override;
         void ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc) override;
 
+        /* ----- Native resources ----- */
+
+        bool QueryNativeHandle(const Resource& resource, NativeResourceHandle& outHandle) override;
+        Buffer* ImportBuffer(const BufferDescriptor& bufferDesc, const NativeResourceHandle& nativeHandle) override;
+        Texture* ImportTexture(const TextureDescriptor& textureDesc, const NativeResourceHandle& nativeHandle) override;
+
         /* ----- Sampler States ---- */
 
         Sampler* CreateSampler(const SamplerDescriptor& samplerDesc) override;
@@ -171,6 +178,12 @@ class GLRenderSystem final : public RenderSystem
 
         GLBuffer* CreateGLBuffer(const BufferDescriptor& desc, const void* initialData);
 
+        // Returns the upload context if the resource was requested with MiscFlags::AsyncUpload and asynchronous uploads are supported.
+        GLUploadContext* GetUploadContextForMiscFlags(long miscFlags);
+
+        void ReadProgramBinary(const Blob& serializedCache, GLProgramBinary& outBinary);
+        std::unique_ptr<Blob> WriteProgramBinary(Serialization::IdentType psoIdent, const GLPipelineState& pipelineState);
+
         void ValidateGLTextureType(const TextureType type);
 
     private:
@@ -179,6 +192,8 @@ class GLRenderSystem final : public RenderSystem
 
         GLContextManager                        contextMngr_;
 
+        GLSamplerCache                          samplerCache_;                          // Must be declared before the samplers, since they release their native objects here
+
         HWObjectContainer<GLSwapChain>          swapChains_;
         HWObjectInstance<GLCommandQueue>        commandQueue_;
         HWObjectContainer<GLCommandBuffer>      commandBuffers_;
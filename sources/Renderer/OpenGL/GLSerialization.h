@@ -0,0 +1,45 @@
+/*
+ * GLSerialization.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_SERIALIZATION_H
+#define LLGL_GL_SERIALIZATION_H
+
+
+#include "../Serialization.h"
+#include <LLGL/RenderSystemFlags.h>
+
+
+namespace LLGL
+{
+
+namespace Serialization
+{
+
+
+/* ----- Enumerations ----- */
+
+// Segment identifiers for OpenGL serialization.
+enum GLIdent : IdentType
+{
+    GLIdent_ReservedGL = (RendererID::OpenGL << 8),
+    GLIdent_GraphicsPSOIdent,
+    GLIdent_ComputePSOIdent,
+    GLIdent_DriverInfo,             // GL_VENDOR, GL_RENDERER, and GL_VERSION as null-terminated strings
+    GLIdent_ProgramBinary,          // GLenum format; Data from glGetProgramBinary
+};
+
+
+} // /namespace Serialization
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
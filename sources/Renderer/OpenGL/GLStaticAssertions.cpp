@@ -42,8 +42,10 @@ LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdClearDepth );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdClearStencil );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdClear );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdClearAttachmentsWithRenderPass );
+LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdInvalidateAttachmentsWithRenderPass );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdClearBuffers );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdBindVertexArray );
+LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdBindSharedVertexArray );
 #ifdef LLGL_GL_ENABLE_OPENGL2X
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdBindGL2XVertexArray );
 #endif
@@ -60,10 +62,12 @@ LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdBindPipelineState );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdSetBlendColor );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdSetStencilRef );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdSetUniforms );
+LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdBindInlineUniformBlock );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdBeginQuery );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdEndQuery );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdBeginConditionalRender );
 //LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdEndConditionalRender ); // Unused
+LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdSetDrawMode );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdDrawArrays );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdDrawArraysInstanced );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdDrawArraysInstancedBaseInstance );
@@ -76,6 +80,8 @@ LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdDrawElementsInstancedBaseVertexBaseInstance )
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdDrawElementsIndirect );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdMultiDrawArraysIndirect );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdMultiDrawElementsIndirect );
+LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdMultiDrawArraysIndirectCount );
+LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdMultiDrawElementsIndirectCount );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdDispatchCompute );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdDispatchComputeIndirect );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdBindTexture );
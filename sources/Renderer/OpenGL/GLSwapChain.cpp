@@ -8,6 +8,11 @@
 #include "GLSwapChain.h"
 #include "../TextureUtils.h"
 #include "Platform/GLContextManager.h"
+#include "Buffer/GLBuffer.h"
+#include "Texture/GLTextureViewPool.h"
+#include <LLGL/PipelineStateFlags.h>
+#include <LLGL/Container/SmallVector.h>
+#include <algorithm>
 
 
 namespace LLGL
@@ -20,7 +25,8 @@ GLSwapChain::GLSwapChain(
     GLContextManager&               contextMngr)
 :
     SwapChain      { desc                                       },
-    contextHeight_ { static_cast<GLint>(desc.resolution.height) }
+    contextHeight_ { static_cast<GLint>(desc.resolution.height) },
+    presentMode_   { desc.presentMode                           }
 {
     /* Set up pixel format for GL context */
     GLPixelFormat pixelFormat;
@@ -29,6 +35,9 @@ GLSwapChain::GLSwapChain(
     pixelFormat.stencilBits = desc.stencilBits;
     pixelFormat.samples     = static_cast<int>(GetClampedSamples(desc.samples));
 
+    /* Render into this swap-chain with an existing GL context if possible, so switching swap-chains only switches their drawables */
+    contextMngr.SelectCompatiblePixelFormat(pixelFormat);
+
     #ifdef LLGL_OS_LINUX
 
     /* Set up surface for the swap-chain and pass native context handle */
@@ -50,11 +59,43 @@ GLSwapChain::GLSwapChain(
 
     /* Get state manager and notify about the current render context */
     GetStateManager().NotifyRenderTargetHeight(contextHeight_);
+
+    /* Apply explicit presentation mode */
+    if (presentMode_ != PresentMode::Undefined)
+        SetVsyncInterval(1);
 }
 
 void GLSwapChain::Present()
 {
+    /* Guard all ranges of streaming buffers that are read by the commands of this frame */
+    GLBuffer::SubmitStreamingFences();
     swapChainContext_->SwapBuffers();
+
+    /* Delete texture views that have been evicted during this frame */
+    GLTextureViewPool::Get().FlushEvictedTextureViews();
+}
+
+bool GLSwapChain::SetDamageRegions(std::uint32_t numRegions, const Scissor* regions)
+{
+    /* Convert damage regions from upper-left origin into lower-left origin of GL window coordinates */
+    SmallVector<GLint, 16> rects;
+    rects.resize(numRegions * 4);
+
+    const GLint height = static_cast<GLint>(GetResolution().height);
+    for (std::uint32_t i = 0; i < numRegions; ++i)
+    {
+        rects[i*4 + 0] = static_cast<GLint>(regions[i].x);
+        rects[i*4 + 1] = height - static_cast<GLint>(regions[i].y + regions[i].height);
+        rects[i*4 + 2] = static_cast<GLint>(regions[i].width);
+        rects[i*4 + 3] = static_cast<GLint>(regions[i].height);
+    }
+
+    return swapChainContext_->SetDamageRegions(numRegions, rects.data());
+}
+
+std::uint32_t GLSwapChain::QueryBufferAge()
+{
+    return swapChainContext_->QueryBufferAge();
 }
 
 std::uint32_t GLSwapChain::GetSamples() const
@@ -79,7 +120,17 @@ const RenderPass* GLSwapChain::GetRenderPass() const
 
 bool GLSwapChain::SetVsyncInterval(std::uint32_t vsyncInterval)
 {
-    return SetSwapInterval(static_cast<int>(vsyncInterval));
+    /* OpenGL has no mailbox presentation, so both Mailbox and Immediate disable V-sync */
+    switch (presentMode_)
+    {
+        case PresentMode::Fifo:
+            return SetSwapInterval(static_cast<int>(std::max(1u, vsyncInterval)));
+        case PresentMode::Mailbox:
+        case PresentMode::Immediate:
+            return SetSwapInterval(0);
+        default:
+            return SetSwapInterval(static_cast<int>(vsyncInterval));
+    }
 }
 
 bool GLSwapChain::MakeCurrent(GLSwapChain* swapChain)
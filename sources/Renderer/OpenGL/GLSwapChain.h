@@ -44,6 +44,8 @@ class GLSwapChain final : public SwapChain
         );
 
         void Present() override;
+        bool SetDamageRegions(std::uint32_t numRegions, const Scissor* regions) override;
+        std::uint32_t QueryBufferAge() override;
 
         std::uint32_t GetSamples() const override;
 
@@ -82,6 +84,7 @@ class GLSwapChain final : public SwapChain
         std::shared_ptr<GLContext>          context_;
         std::unique_ptr<GLSwapChainContext> swapChainContext_;
         GLint                               contextHeight_      = 0;
+        PresentMode                         presentMode_        = PresentMode::Undefined;
 
 };
 
@@ -182,10 +182,11 @@ GLenum Map(const CPUAccess cpuAccess)
     #ifdef LLGL_OPENGL
     switch (cpuAccess)
     {
-        case CPUAccess::ReadOnly:       return GL_READ_ONLY;
-        case CPUAccess::WriteOnly:      return GL_WRITE_ONLY;
-        case CPUAccess::WriteDiscard:   return GL_WRITE_ONLY; // discard is optional
-        case CPUAccess::ReadWrite:      return GL_READ_WRITE;
+        case CPUAccess::ReadOnly:               return GL_READ_ONLY;
+        case CPUAccess::WriteOnly:              return GL_WRITE_ONLY;
+        case CPUAccess::WriteDiscard:           return GL_WRITE_ONLY; // discard is optional
+        case CPUAccess::ReadWrite:              return GL_READ_WRITE;
+        case CPUAccess::WriteUnsynchronized:    return GL_WRITE_ONLY; // unsynchronized mapping requires glMapBufferRange
     }
     #endif
     MapFailed("CPUAccess");
@@ -611,6 +612,15 @@ GLenum ToPrimitiveMode(const PrimitiveTopology primitiveTopology)
     MapFailed("PrimitiveTopology");
 }
 
+GLenum ToVertexAttribType(const Format format)
+{
+    #ifdef GL_UNSIGNED_INT_2_10_10_10_REV
+    if (format == Format::RGB10A2UNorm)
+        return GL_UNSIGNED_INT_2_10_10_10_REV;
+    #endif
+    return Map(GetFormatAttribs(format).dataType);
+}
+
 
 /* ----- Unmap functions ----- */
 
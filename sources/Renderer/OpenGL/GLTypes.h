@@ -63,6 +63,9 @@ GLenum ToDrawMode(const PrimitiveTopology primitiveTopology);
 // Returns the <primitiveMode> enum for glBeginTransformFeedback* commands.
 GLenum ToPrimitiveMode(const PrimitiveTopology primitiveTopology);
 
+// Returns the <type> enum for glVertexAttrib*Pointer and glVertexAttrib*Format commands, including packed formats such as GL_UNSIGNED_INT_2_10_10_10_REV.
+GLenum ToVertexAttribType(const Format format);
+
 UniformType UnmapUniformType( const GLenum uniformType    );
 Format      UnmapFormat     ( const GLenum internalFormat );
 DataType    UnmapDataType   ( const GLenum type           );
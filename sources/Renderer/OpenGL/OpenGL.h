@@ -32,6 +32,10 @@
 #   define LLGL_GLEXT_MULTI_DRAW_INDIRECT
 #endif
 
+#if defined GL_ARB_indirect_parameters
+#   define LLGL_GLEXT_INDIRECT_PARAMETERS
+#endif
+
 #if defined GL_ARB_compute_shader || defined GL_ES_VERSION_3_1
 #   define LLGL_GLEXT_COMPUTE_SHADER
 #endif
@@ -73,6 +77,26 @@
 #   define LLGL_GLEXT_CLIP_CONTROL
 #endif
 
+#if defined GL_ARB_texture_barrier
+#   define LLGL_GLEXT_TEXTURE_BARRIER
+#endif
+
+#if defined GL_ARB_get_program_binary || defined GL_ES_VERSION_3_0
+#   define LLGL_GLEXT_GET_PROGRAM_BINARY
+#endif
+
+#if defined GL_ARB_vertex_attrib_binding || defined GL_ES_VERSION_3_1
+#   define LLGL_GLEXT_VERTEX_ATTRIB_BINDING
+#endif
+
+#if defined GL_ARB_invalidate_subdata || defined GL_ES_VERSION_3_0
+#   define LLGL_GLEXT_INVALIDATE_SUBDATA
+#endif
+
+#if defined GL_KHR_parallel_shader_compile
+#   define LLGL_GLEXT_PARALLEL_SHADER_COMPILE
+#endif
+
 #ifdef GL_TEXTURE_BORDER_COLOR
 #   define LLGL_SAMPLER_BORDER_COLOR
 #endif
@@ -9,12 +9,29 @@
 #include "AndroidGLContext.h"
 #include "../../../../Core/Helper.h"
 #include <LLGL/Platform/NativeHandle.h>
+#include <cstring>
 
 
 namespace LLGL
 {
 
 
+// Returns true if the specified extension is contained in the space separated list of extension names.
+static bool HasEGLExtension(const char* extensions, const char* name)
+{
+    if (extensions != nullptr)
+    {
+        const auto nameLen = std::strlen(name);
+        for (const char* s = std::strstr(extensions, name); s != nullptr; s = std::strstr(s + nameLen, name))
+        {
+            if ((s == extensions || s[-1] == ' ') && (s[nameLen] == ' ' || s[nameLen] == '\0'))
+                return true;
+        }
+    }
+    return false;
+}
+
+
 /*
  * GLSwapChainContext class
  */
@@ -40,26 +57,68 @@ AndroidGLSwapChainContext::AndroidGLSwapChainContext(AndroidGLContext& context,
     context_           { context.GetEGLContext() }
 {
     /* Get native surface handle */
-    NativeHandle nativeHandle;
+    NativeHandle nativeHandle = {};
     surface.GetNativeHandle(&nativeHandle, sizeof(nativeHandle));
 
-    /* Create drawable surface */
-    surface_ = eglCreateWindowSurface(display_, context.GetEGLConfig(), nativeHandle.window, nullptr);
-    if (!surface_)
-        throw std::runtime_error("eglCreateWindowSurface failed");
+    /* Create drawable surface; a surface without native window (e.g. for the upload context) uses EGL_KHR_surfaceless_context instead */
+    if (nativeHandle.window != nullptr)
+    {
+        surface_ = eglCreateWindowSurface(display_, context.GetEGLConfig(), nativeHandle.window, nullptr);
+        if (!surface_)
+            throw std::runtime_error("eglCreateWindowSurface failed");
+    }
+    else
+        surface_ = EGL_NO_SURFACE;
+
+    if (surface_ != EGL_NO_SURFACE)
+        LoadPartialPresentExtensions();
 }
 
 AndroidGLSwapChainContext::~AndroidGLSwapChainContext()
 {
-    eglDestroySurface(display_, surface_);
+    if (surface_ != EGL_NO_SURFACE)
+        eglDestroySurface(display_, surface_);
 }
 
 bool AndroidGLSwapChainContext::SwapBuffers()
 {
-    eglSwapBuffers(display_, surface_);
+    if (surface_ != EGL_NO_SURFACE)
+    {
+        /* Only present the damage regions if they have been set for this frame */
+        if (swapBuffersWithDamage_ != nullptr && !damageRects_.empty())
+            swapBuffersWithDamage_(display_, surface_, damageRects_.data(), static_cast<EGLint>(damageRects_.size() / 4));
+        else
+            eglSwapBuffers(display_, surface_);
+    }
+    damageRects_.clear();
+    return true;
+}
+
+bool AndroidGLSwapChainContext::SetDamageRegions(std::uint32_t numRegions, const GLint* rects)
+{
+    if (setDamageRegion_ == nullptr && swapBuffersWithDamage_ == nullptr)
+        return false;
+
+    damageRects_.assign(rects, rects + numRegions * 4);
+
+    /*
+    Restrict rendering to the damage regions with EGL_KHR_partial_update.
+    This must be called before anything is rendered into the back buffer of the current frame and after the buffer age has been queried.
+    */
+    if (setDamageRegion_ != nullptr && numRegions > 0)
+        setDamageRegion_(display_, surface_, damageRects_.data(), static_cast<EGLint>(numRegions));
+
     return true;
 }
 
+std::uint32_t AndroidGLSwapChainContext::QueryBufferAge()
+{
+    EGLint age = 0;
+    if (hasBufferAge_ && eglQuerySurface(display_, surface_, EGL_BUFFER_AGE_EXT, &age) == EGL_TRUE)
+        return static_cast<std::uint32_t>(age);
+    return 0;
+}
+
 bool AndroidGLSwapChainContext::MakeCurrentEGLContext(AndroidGLSwapChainContext* context)
 {
     if (context)
@@ -69,6 +128,28 @@ bool AndroidGLSwapChainContext::MakeCurrentEGLContext(AndroidGLSwapChainContext*
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+void AndroidGLSwapChainContext::LoadPartialPresentExtensions()
+{
+    const char* extensions = eglQueryString(display_, EGL_EXTENSIONS);
+
+    if (HasEGLExtension(extensions, "EGL_KHR_partial_update"))
+    {
+        setDamageRegion_    = reinterpret_cast<PFNEGLSETDAMAGEREGIONKHRPROC>(eglGetProcAddress("eglSetDamageRegionKHR"));
+        hasBufferAge_       = true;
+    }
+
+    if (HasEGLExtension(extensions, "EGL_KHR_swap_buffers_with_damage"))
+        swapBuffersWithDamage_ = reinterpret_cast<PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC>(eglGetProcAddress("eglSwapBuffersWithDamageKHR"));
+
+    if (HasEGLExtension(extensions, "EGL_EXT_buffer_age"))
+        hasBufferAge_ = true;
+}
+
+
 } // /namespace LLGL
 
 
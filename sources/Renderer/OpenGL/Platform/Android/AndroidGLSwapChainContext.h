@@ -12,6 +12,8 @@
 #include "../GLSwapChainContext.h"
 #include "../../OpenGL.h"
 #include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <vector>
 
 
 namespace LLGL
@@ -30,6 +32,8 @@ class AndroidGLSwapChainContext final : public GLSwapChainContext
         ~AndroidGLSwapChainContext();
 
         bool SwapBuffers() override;
+        bool SetDamageRegions(std::uint32_t numRegions, const GLint* rects) override;
+        std::uint32_t QueryBufferAge() override;
 
     public:
 
@@ -37,9 +41,19 @@ class AndroidGLSwapChainContext final : public GLSwapChainContext
 
     private:
 
-        ::EGLDisplay display_ = nullptr;
-        ::EGLContext context_ = nullptr;
-        ::EGLSurface surface_ = nullptr;
+        // Loads the EGL extensions for partial presentation.
+        void LoadPartialPresentExtensions();
+
+    private:
+
+        ::EGLDisplay                        display_                = nullptr;
+        ::EGLContext                        context_                = nullptr;
+        ::EGLSurface                        surface_                = nullptr;
+
+        PFNEGLSETDAMAGEREGIONKHRPROC        setDamageRegion_        = nullptr;  // EGL_KHR_partial_update
+        PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC  swapBuffersWithDamage_  = nullptr;  // EGL_KHR_swap_buffers_with_damage
+        bool                                hasBufferAge_           = false;    // EGL_EXT_buffer_age or EGL_KHR_partial_update
+        std::vector<EGLint>                 damageRects_;                       // Damage regions for the next call to SwapBuffers
 
 };
 
@@ -6,6 +6,8 @@
  */
 
 #include "GLContext.h"
+#include <LLGL/Platform/Platform.h>
+#include <stdexcept>
 
 
 namespace LLGL
@@ -33,9 +35,10 @@ bool operator != (const GLPixelFormat& lhs, const GLPixelFormat& rhs)
  * GLContext class
  */
 
-static GLContext*   g_currentContext;
-static unsigned     g_currentGlobalIndex;
-static unsigned     g_globalIndexCounter;
+// Current GL context per thread, since a GL context can be current on a worker thread (see GLUploadContext)
+static thread_local GLContext*  g_currentContext;
+static thread_local unsigned    g_currentGlobalIndex;
+static unsigned                 g_globalIndexCounter;
 
 bool GLContext::SetCurrentSwapInterval(int interval)
 {
@@ -63,6 +66,23 @@ void GLContext::SetCurrent(GLContext* context)
     }
 }
 
+#if !(defined LLGL_OS_LINUX && defined LLGL_GL_ENABLE_EGL)
+
+std::unique_ptr<GLContext> GLContext::CreateHeadless(
+    const GLPixelFormat&                /*pixelFormat*/,
+    const RendererConfigurationOpenGL&  /*profile*/,
+    GLContext*                          /*sharedContext*/)
+{
+    throw std::runtime_error("headless OpenGL contexts are only supported on GNU/Linux with EGL (LLGL_GL_ENABLE_EGL)");
+}
+
+void GLContext::QueryHeadlessVideoAdapters(std::vector<VideoAdapterDescriptor>& /*outAdapters*/)
+{
+    // dummy
+}
+
+#endif // /LLGL_OS_LINUX && LLGL_GL_ENABLE_EGL
+
 GLContext* GLContext::GetCurrent()
 {
     return g_currentContext;
@@ -11,7 +11,9 @@
 
 #include <LLGL/Surface.h>
 #include <LLGL/RendererConfiguration.h>
+#include <LLGL/VideoAdapter.h>
 #include <memory>
+#include <vector>
 #include "../RenderState/GLStateManager.h"
 
 
@@ -82,6 +84,16 @@ class GLContext
             GLContext*                          sharedContext
         );
 
+        // Creates a platform specific GLContext instance without any surface and makes it current. Throws if headless contexts are not supported.
+        static std::unique_ptr<GLContext> CreateHeadless(
+            const GLPixelFormat&                pixelFormat,
+            const RendererConfigurationOpenGL&  profile,
+            GLContext*                          sharedContext
+        );
+
+        // Appends a video adapter descriptor for each device a headless context can be created on, in the order of RendererConfigurationOpenGL::deviceIndex.
+        static void QueryHeadlessVideoAdapters(std::vector<VideoAdapterDescriptor>& outAdapters);
+
         // Sets the current GL context. This only stores a reference to this context (GetCurrent) and its global index (GetGlobalIndex).
         static void SetCurrent(GLContext* context);
 
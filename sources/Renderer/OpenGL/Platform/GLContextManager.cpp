@@ -8,19 +8,28 @@
 #include "GLContextManager.h"
 #include "../RenderState/GLStateManager.h"
 #include "../Ext/GLExtensionLoader.h"
+#include "../Ext/GLExtensionRegistry.h"
+#include "../../../Core/Helper.h"
+#include <LLGL/Platform/Platform.h>
 #include <LLGL/Window.h>
 #include <LLGL/Canvas.h>
+#include <LLGL/Log.h>
+#include <LLGL/Timer.h>
 
 
 namespace LLGL
 {
 
 
-GLContextManager::GLContextManager(const RendererConfigurationOpenGL& profile)
+GLContextManager::GLContextManager(const RendererConfigurationOpenGL& profile, bool headless, const StartupPhaseCallback& startupPhaseCallback) :
+    headless_               { headless             },
+    startupPhaseCallback_   { startupPhaseCallback }
 {
     profile_.contextProfile = profile.contextProfile;
     profile_.majorVersion   = profile.majorVersion;
     profile_.minorVersion   = profile.minorVersion;
+    profile_.deviceIndex    = profile.deviceIndex;
+    profile_.singleContext  = profile.singleContext;
 }
 
 std::shared_ptr<GLContext> GLContextManager::AllocContext(const GLPixelFormat* pixelFormat, Surface* surface)
@@ -31,6 +40,59 @@ std::shared_ptr<GLContext> GLContextManager::AllocContext(const GLPixelFormat* p
         return FindOrMakeAnyContext();
 }
 
+// Returns true if a GL context with the 'available' pixel format can be used for a surface with the 'requested' pixel format.
+static bool IsPixelFormatCompatible(const GLPixelFormat& available, const GLPixelFormat& requested)
+{
+    return
+    (
+        available.colorBits     == requested.colorBits      &&
+        available.depthBits     >= requested.depthBits      &&
+        available.stencilBits   >= requested.stencilBits    &&
+        available.samples       == requested.samples
+    );
+}
+
+void GLContextManager::SelectCompatiblePixelFormat(GLPixelFormat& pixelFormat) const
+{
+    if (!profile_.singleContext)
+        return;
+
+    for (const auto& formatWithContext : pixelFormats_)
+    {
+        if (IsPixelFormatCompatible(formatWithContext.pixelFormat, pixelFormat))
+        {
+            pixelFormat = formatWithContext.pixelFormat;
+            return;
+        }
+    }
+}
+
+GLUploadContext* GLContextManager::GetUploadContext()
+{
+    /*
+    The upload context requires fences to publish its resources to the primary GL context.
+    On macOS, the NSOpenGLContext has to be linked to its view on the main thread, so resources are always created synchronously.
+    Headless contexts have no placeholder surface for the upload context, so they also create resources synchronously.
+    */
+    #ifndef LLGL_OS_MACOS
+    if (!uploadContext_ && !isUploadContextFailed_ && !headless_ && !pixelFormats_.empty() && HasExtension(GLExt::ARB_sync))
+    {
+        try
+        {
+            const auto& primaryFormat = pixelFormats_.front();
+            uploadContext_ = MakeUnique<GLUploadContext>(primaryFormat.pixelFormat, profile_, *primaryFormat.context, CreatePlaceholderSurface());
+        }
+        catch (const std::exception& e)
+        {
+            /* Fall back to synchronous resource creation */
+            Log::PostReport(Log::ReportType::Error, e.what(), "GLContextManager::GetUploadContext");
+            isUploadContextFailed_ = true;
+        }
+    }
+    #endif // /LLGL_OS_MACOS
+    return uploadContext_.get();
+}
+
 
 /*
  * ======= Private: =======
@@ -57,9 +119,9 @@ std::unique_ptr<Surface> GLContextManager::CreatePlaceholderSurface()
 
 std::shared_ptr<GLContext> GLContextManager::MakeContextWithPixelFormat(const GLPixelFormat& pixelFormat, Surface* surface)
 {
-    /* Create placeholder surface is none was specified */
+    /* Create placeholder surface is none was specified; headless contexts don't need any surface */
     std::unique_ptr<Surface> placeholderSurface;
-    if (surface == nullptr)
+    if (surface == nullptr && !headless_)
     {
         placeholderSurface = CreatePlaceholderSurface();
         surface = placeholderSurface.get();
@@ -69,16 +131,28 @@ std::shared_ptr<GLContext> GLContextManager::MakeContextWithPixelFormat(const GL
     GLContext* sharedContext = (pixelFormats_.empty() ? nullptr : pixelFormats_.front().context.get());
 
     /* Create new GL context and append to pixel format list */
+    const std::uint64_t startTick = Timer::Tick();
+
     GLPixelFormatWithContext formatWithContext;
     {
         formatWithContext.pixelFormat   = pixelFormat;
         formatWithContext.surface       = std::move(placeholderSurface);
-        formatWithContext.context       = GLContext::Create(pixelFormat, profile_, *surface, sharedContext);
+        if (headless_)
+            formatWithContext.context   = GLContext::CreateHeadless(pixelFormat, profile_, sharedContext);
+        else
+            formatWithContext.context   = GLContext::Create(pixelFormat, profile_, *surface, sharedContext);
     }
     pixelFormats_.emplace_back(std::move(formatWithContext));
 
+    if (startupPhaseCallback_)
+        startupPhaseCallback_("GL context creation", startTick, Timer::Tick());
+
     auto context = pixelFormats_.back().context;
 
+    /* Headless contexts are never made current by a swap-chain, so make it the current context here */
+    if (headless_)
+        GLContext::SetCurrent(context.get());
+
     /* Load GL extensions for the very first context */
     const bool hasGLCoreProfile = (profile_.contextProfile == OpenGLContextProfile::CoreProfile);
     LoadGLExtensions(hasGLCoreProfile);
@@ -144,8 +218,13 @@ void GLContextManager::LoadGLExtensions(bool hasGLCoreProfile)
     if (!AreExtensionsLoaded())
     {
         /* Query extensions and load all of them */
+        const std::uint64_t startTick = Timer::Tick();
+
         auto extensions = QueryExtensions(hasGLCoreProfile);
         LoadAllExtensions(extensions, hasGLCoreProfile);
+
+        if (startupPhaseCallback_)
+            startupPhaseCallback_("extension loading", startTick, Timer::Tick());
     }
 }
 
@@ -10,7 +10,10 @@
 
 
 #include "GLContext.h"
+#include "GLUploadContext.h"
 #include <LLGL/RendererConfiguration.h>
+#include <cstdint>
+#include <functional>
 #include <vector>
 
 
@@ -29,14 +32,30 @@ class GLContextManager
         GLContextManager(const GLContextManager&) = delete;
         GLContextManager& operator = (const GLContextManager&) = delete;
 
-        // Initializes the context manager and creates the primary GL context.
-        GLContextManager(const RendererConfigurationOpenGL& profile);
+        // Callback to record a start-up phase between two timer ticks (see RenderSystem::RecordStartupPhase).
+        using StartupPhaseCallback = std::function<void(const char* name, std::uint64_t startTick, std::uint64_t endTick)>;
+
+        // Initializes the context manager. If 'headless' is true, all GL contexts are created without a surface.
+        GLContextManager(const RendererConfigurationOpenGL& profile, bool headless = false, const StartupPhaseCallback& startupPhaseCallback = nullptr);
 
     public:
 
         // Returns a GL context with the specified pixel format or any context if 'pixelFormat' is null.
         std::shared_ptr<GLContext> AllocContext(const GLPixelFormat* pixelFormat = nullptr, Surface* surface = nullptr);
 
+        /*
+        Replaces the specified pixel format by the one of an existing GL context that can render into a surface with the requested format.
+        This only has an effect if RendererConfigurationOpenGL::singleContext is enabled.
+        It must be called before the surface of a new swap-chain is created, since the surface (e.g. the X11 visual) depends on the pixel format.
+        */
+        void SelectCompatiblePixelFormat(GLPixelFormat& pixelFormat) const;
+
+        // Returns the upload context for asynchronous resource creation, or null if it is not supported. The upload context is created on first use.
+        GLUploadContext* GetUploadContext();
+
+        // Initializes the default render states for the specified GL state manager.
+        static void InitRenderStates(GLStateManager& stateMngr);
+
     public:
 
         // Returns the OpenGL profile configuration.
@@ -45,6 +64,12 @@ class GLContextManager
             return profile_;
         }
 
+        // Returns true if all GL contexts are created without a surface, in which case no swap-chain can be created.
+        inline bool IsHeadless() const
+        {
+            return headless_;
+        }
+
     private:
 
         struct GLPixelFormatWithContext
@@ -68,9 +93,6 @@ class GLContextManager
         // Returns any GL context or creates a new one if none has been created yet.
         std::shared_ptr<GLContext> FindOrMakeAnyContext();
 
-        // Initializes the default render states for the specified GL state manager.
-        void InitRenderStates(GLStateManager& stateMngr);
-
         // Loads all GL extensions.
         void LoadGLExtensions(bool hasGLCoreProfile);
 
@@ -78,6 +100,10 @@ class GLContextManager
 
         RendererConfigurationOpenGL             profile_;
         std::vector<GLPixelFormatWithContext>   pixelFormats_;
+        std::unique_ptr<GLUploadContext>        uploadContext_;
+        bool                                    isUploadContextFailed_  = false;
+        bool                                    headless_               = false;
+        StartupPhaseCallback                    startupPhaseCallback_;
 
 };
 
@@ -13,13 +13,23 @@ namespace LLGL
 {
 
 
-static GLSwapChainContext* g_currentSwapChainContext;
+static thread_local GLSwapChainContext* g_currentSwapChainContext;
 
 GLSwapChainContext::GLSwapChainContext(GLContext& context) :
     context_ { context }
 {
 }
 
+bool GLSwapChainContext::SetDamageRegions(std::uint32_t /*numRegions*/, const GLint* /*rects*/)
+{
+    return false; // dummy
+}
+
+std::uint32_t GLSwapChainContext::QueryBufferAge()
+{
+    return 0; // dummy
+}
+
 bool GLSwapChainContext::MakeCurrent(GLSwapChainContext* context)
 {
     bool result = true;
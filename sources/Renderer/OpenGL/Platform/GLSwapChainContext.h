@@ -9,8 +9,10 @@
 #define LLGL_GL_SWAP_CHAIN_CONTEXT_H
 
 
+#include "../OpenGL.h"
 #include <LLGL/Surface.h>
 #include <memory>
+#include <cstdint>
 
 
 namespace LLGL
@@ -34,6 +36,15 @@ class GLSwapChainContext
         // Swaps the back buffer with the front buffer (Win32: ::SwapBuffers, X11: glXSwapBuffers).
         virtual bool SwapBuffers() = 0;
 
+        /*
+        Sets the damage regions for the next call to SwapBuffers. Each region is specified by four integers (x, y, width, height) with a lower-left origin.
+        Returns false if partial presentation is not supported, which is the default.
+        */
+        virtual bool SetDamageRegions(std::uint32_t numRegions, const GLint* rects);
+
+        // Returns the age of the current back buffer or zero if its content is undefined, which is the default.
+        virtual std::uint32_t QueryBufferAge();
+
     public:
 
         inline GLContext& GetGLContext() const
@@ -0,0 +1,238 @@
+/*
+ * GLUploadContext.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLUploadContext.h"
+#include "GLContextManager.h"
+#include "../Ext/GLExtensions.h"
+#include <LLGL/Log.h>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+static GLUploadContext* g_uploadContext;
+
+GLUploadContext::GLUploadContext(
+    const GLPixelFormat&                pixelFormat,
+    const RendererConfigurationOpenGL&  profile,
+    GLContext&                          sharedContext,
+    std::unique_ptr<Surface>&&          surface)
+:
+    surface_ { std::move(surface) }
+{
+    /* Start worker thread and wait until its GL context has been created */
+    thread_ = std::thread(&GLUploadContext::Run, this, pixelFormat, profile, &sharedContext);
+
+    std::unique_lock<std::mutex> lock{ mutex_ };
+    finishSignal_.wait(lock, [this]() { return isReady_; });
+
+    if (!errorMessage_.empty())
+    {
+        lock.unlock();
+        thread_.join();
+        throw std::runtime_error("failed to create GL upload context: " + errorMessage_);
+    }
+
+    g_uploadContext = this;
+}
+
+GLUploadContext::~GLUploadContext()
+{
+    /* Finish all pending tasks, then stop worker thread */
+    WaitIdle();
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        quit_ = true;
+    }
+    taskSignal_.notify_one();
+    thread_.join();
+
+    if (g_uploadContext == this)
+        g_uploadContext = nullptr;
+}
+
+void GLUploadContext::Enqueue(const void* resource, TaskFunc&& task, TaskFunc&& finishTask)
+{
+    /* Store latest task ID for the specified resource */
+    const std::uint64_t id = ++lastEnqueuedID_;
+    resourceTasks_[resource] = id;
+
+    /* Flush render thread, so the GL objects it has created are visible to the worker thread */
+    glFlush();
+
+    /* Pass task to worker thread */
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        tasks_.push_back({ id, std::move(task), std::move(finishTask) });
+    }
+    taskSignal_.notify_one();
+}
+
+void GLUploadContext::Synchronize()
+{
+    /* Take all finished tasks from the worker thread */
+    std::vector<FinishedTask> finishedTasks;
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        finishedTasks.swap(finishedTasks_);
+    }
+
+    /* Let the GPU wait for the upload commands in the current GL context; this does not block the CPU */
+    for (auto& finishedTask : finishedTasks)
+    {
+        glWaitSync(finishedTask.sync, 0, GL_TIMEOUT_IGNORED);
+        glDeleteSync(finishedTask.sync);
+        if (finishedTask.finishTask)
+            finishedTask.finishTask();
+        lastSynchronizedID_ = finishedTask.id;
+    }
+}
+
+void GLUploadContext::Wait(const void* resource)
+{
+    auto it = resourceTasks_.find(resource);
+    if (it != resourceTasks_.end())
+        WaitForTask(it->second);
+}
+
+void GLUploadContext::WaitIdle()
+{
+    WaitForTask(lastEnqueuedID_);
+}
+
+void GLUploadContext::Release(const void* resource)
+{
+    auto it = resourceTasks_.find(resource);
+    if (it != resourceTasks_.end())
+    {
+        WaitForTask(it->second);
+        resourceTasks_.erase(it);
+    }
+}
+
+bool GLUploadContext::HasResource(const void* resource) const
+{
+    return (resourceTasks_.find(resource) != resourceTasks_.end());
+}
+
+GLUploadContext* GLUploadContext::Get()
+{
+    return g_uploadContext;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GLUploadContext::Run(GLPixelFormat pixelFormat, RendererConfigurationOpenGL profile, GLContext* sharedContext)
+{
+    /* Create GL context and signal the render thread whether it succeeded */
+    try
+    {
+        CreateContextOnWorker(pixelFormat, profile, sharedContext);
+    }
+    catch (const std::exception& e)
+    {
+        swapChainContext_.reset();
+        context_.reset();
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        errorMessage_ = e.what();
+    }
+
+    bool isFailed = false;
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        isReady_ = true;
+        isFailed = !errorMessage_.empty();
+    }
+    finishSignal_.notify_all();
+
+    if (isFailed)
+        return;
+
+    /* Execute tasks until the upload context is destroyed */
+    for (;;)
+    {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock{ mutex_ };
+            taskSignal_.wait(lock, [this]() { return (quit_ || !tasks_.empty()); });
+            if (tasks_.empty())
+                break;
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        ExecuteTask(task);
+    }
+
+    /* Release GL context on the same thread it is current on */
+    GLSwapChainContext::MakeCurrent(nullptr);
+    swapChainContext_.reset();
+    context_.reset();
+}
+
+void GLUploadContext::CreateContextOnWorker(const GLPixelFormat& pixelFormat, const RendererConfigurationOpenGL& profile, GLContext* sharedContext)
+{
+    /* Create GL context that shares its objects with the primary GL context and link it to the placeholder surface */
+    context_            = GLContext::Create(pixelFormat, profile, *surface_, sharedContext);
+    swapChainContext_   = GLSwapChainContext::Create(*context_, *surface_);
+
+    /* Make context current on this thread; this also makes its state manager the current one of this thread */
+    if (!GLSwapChainContext::MakeCurrent(swapChainContext_.get()))
+        throw std::runtime_error("failed to make GL context current on worker thread");
+
+    /* Initialize state manager for this GL context */
+    auto& stateMngr = context_->GetStateManager();
+    stateMngr.DetermineExtensionsAndLimits();
+    GLContextManager::InitRenderStates(stateMngr);
+}
+
+void GLUploadContext::WaitForTask(std::uint64_t id)
+{
+    if (id > lastSynchronizedID_)
+    {
+        /* Wait until the worker thread has finished the task, then make its result visible */
+        {
+            std::unique_lock<std::mutex> lock{ mutex_ };
+            finishSignal_.wait(lock, [this, id]() { return (lastFinishedID_ >= id); });
+        }
+        Synchronize();
+    }
+}
+
+void GLUploadContext::ExecuteTask(Task& task)
+{
+    try
+    {
+        task.task();
+    }
+    catch (const std::exception& e)
+    {
+        Log::PostReport(Log::ReportType::Error, e.what(), "GLUploadContext");
+    }
+
+    /* Publish task with a fence; flush so the render thread never waits for a fence that has not been submitted */
+    GLsync sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        finishedTasks_.push_back({ task.id, sync, std::move(task.finishTask) });
+        lastFinishedID_ = task.id;
+    }
+    finishSignal_.notify_all();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
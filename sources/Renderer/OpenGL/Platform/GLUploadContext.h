@@ -0,0 +1,154 @@
+/*
+ * GLUploadContext.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_UPLOAD_CONTEXT_H
+#define LLGL_GL_UPLOAD_CONTEXT_H
+
+
+#include "GLContext.h"
+#include "GLSwapChainContext.h"
+#include "../OpenGL.h"
+#include <LLGL/Surface.h>
+#include <LLGL/RendererConfiguration.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <unordered_map>
+
+
+namespace LLGL
+{
+
+
+/*
+Helper class to upload resources on a worker thread with its own GL context and GLStateManager.
+The GL context shares its objects with the primary GL context.
+Each task is published with a fence (glFenceSync) that the render thread waits for on the GPU (glWaitSync) once the task has finished.
+All functions except the worker thread itself must only be called on the render thread.
+*/
+class GLUploadContext
+{
+
+    public:
+
+        // Task function that is executed on the worker thread.
+        using TaskFunc = std::function<void()>;
+
+    public:
+
+        GLUploadContext(const GLUploadContext&) = delete;
+        GLUploadContext& operator = (const GLUploadContext&) = delete;
+
+        // Starts the worker thread and creates a GL context that shares its objects with 'sharedContext'. Throws if the GL context could not be created.
+        GLUploadContext(
+            const GLPixelFormat&                pixelFormat,
+            const RendererConfigurationOpenGL&  profile,
+            GLContext&                          sharedContext,
+            std::unique_ptr<Surface>&&          surface
+        );
+
+        // Finishes all pending tasks and stops the worker thread.
+        ~GLUploadContext();
+
+    public:
+
+        /*
+        Enqueues a task for the specified resource that is executed on the worker thread.
+        The optional 'finishTask' function is executed on the render thread once the task has finished and its fence has been waited for,
+        e.g. to build container objects such as VAOs that are not shared between GL contexts.
+        */
+        void Enqueue(const void* resource, TaskFunc&& task, TaskFunc&& finishTask = nullptr);
+
+        // Makes the results of all finished tasks visible to the render thread. Tasks that are still in flight are not waited for.
+        void Synchronize();
+
+        // Blocks until all tasks of the specified resource have finished. This does nothing if there is no task for this resource.
+        void Wait(const void* resource);
+
+        // Blocks until all tasks have finished.
+        void WaitIdle();
+
+        // Waits for all tasks of the specified resource and removes it from this upload context. Must be called before the resource is released.
+        void Release(const void* resource);
+
+        // Returns true if the specified resource was created with this upload context and has not been released yet.
+        bool HasResource(const void* resource) const;
+
+    public:
+
+        // Returns the upload context that is currently active or null if there is none.
+        static GLUploadContext* Get();
+
+    private:
+
+        struct Task
+        {
+            std::uint64_t   id;
+            TaskFunc        task;
+            TaskFunc        finishTask;
+        };
+
+        struct FinishedTask
+        {
+            std::uint64_t   id;
+            GLsync          sync;
+            TaskFunc        finishTask;
+        };
+
+    private:
+
+        // Main function of the worker thread.
+        void Run(GLPixelFormat pixelFormat, RendererConfigurationOpenGL profile, GLContext* sharedContext);
+
+        // Creates the GL context on the worker thread and makes it current.
+        void CreateContextOnWorker(const GLPixelFormat& pixelFormat, const RendererConfigurationOpenGL& profile, GLContext* sharedContext);
+
+        // Blocks until the task with the specified ID and all previous ones have finished.
+        void WaitForTask(std::uint64_t id);
+
+        // Executes the specified task on the worker thread and publishes its result with a new fence.
+        void ExecuteTask(Task& task);
+
+    private:
+
+        std::unique_ptr<Surface>                        surface_;
+        std::unique_ptr<GLContext>                      context_;
+        std::unique_ptr<GLSwapChainContext>             swapChainContext_;
+
+        std::thread                                     thread_;
+        std::mutex                                      mutex_;
+        std::condition_variable                         taskSignal_;
+        std::condition_variable                         finishSignal_;
+        std::deque<Task>                                tasks_;
+        std::vector<FinishedTask>                       finishedTasks_;
+        std::uint64_t                                   lastFinishedID_     = 0;
+        bool                                            isReady_            = false;
+        bool                                            quit_               = false;
+        std::string                                     errorMessage_;
+
+        // Render thread only
+        std::unordered_map<const void*, std::uint64_t>  resourceTasks_;
+        std::uint64_t                                   lastEnqueuedID_     = 0;
+        std::uint64_t                                   lastSynchronizedID_ = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,308 @@
+/*
+ * LinuxGLHeadlessContext.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifdef LLGL_GL_ENABLE_EGL
+
+#include "LinuxGLHeadlessContext.h"
+#include "../../../CheckedCast.h"
+#include "../../../../Core/Helper.h"
+#include <LLGL/Log.h>
+#include <EGL/eglext.h>
+#include <stdexcept>
+#include <cstring>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+#ifndef EGL_RENDERER_EXT
+#define EGL_RENDERER_EXT 0x335F
+#endif
+
+
+// Returns true if the specified extension is contained in the space separated list of extension names.
+static bool HasEGLExtension(const char* extensions, const char* name)
+{
+    if (extensions != nullptr)
+    {
+        const auto nameLen = std::strlen(name);
+        for (const char* s = std::strstr(extensions, name); s != nullptr; s = std::strstr(s + nameLen, name))
+        {
+            if ((s == extensions || s[-1] == ' ') && (s[nameLen] == ' ' || s[nameLen] == '\0'))
+                return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * GLContext class
+ */
+
+std::unique_ptr<GLContext> GLContext::CreateHeadless(
+    const GLPixelFormat&                pixelFormat,
+    const RendererConfigurationOpenGL&  profile,
+    GLContext*                          sharedContext)
+{
+    LinuxGLHeadlessContext* sharedContextEGL = (sharedContext != nullptr ? LLGL_CAST(LinuxGLHeadlessContext*, sharedContext) : nullptr);
+    return MakeUnique<LinuxGLHeadlessContext>(pixelFormat, profile, sharedContextEGL);
+}
+
+// Returns the specified string of an EGL device, or an empty string if the string cannot be queried.
+static std::string GetEGLDeviceString(PFNEGLQUERYDEVICESTRINGEXTPROC QueryDeviceStringEXT, EGLDeviceEXT device, EGLint name)
+{
+    if (QueryDeviceStringEXT != nullptr)
+    {
+        if (const char* str = QueryDeviceStringEXT(device, name))
+            return str;
+    }
+    return "";
+}
+
+void GLContext::QueryHeadlessVideoAdapters(std::vector<VideoAdapterDescriptor>& outAdapters)
+{
+    const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+    auto QueryDevicesEXT = reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(eglGetProcAddress("eglQueryDevicesEXT"));
+    if (QueryDevicesEXT != nullptr && HasEGLExtension(clientExtensions, "EGL_EXT_platform_device"))
+    {
+        auto QueryDeviceStringEXT = reinterpret_cast<PFNEGLQUERYDEVICESTRINGEXTPROC>(eglGetProcAddress("eglQueryDeviceStringEXT"));
+
+        EGLDeviceEXT devices[16];
+        EGLint numDevices = 0;
+        if (QueryDevicesEXT(16, devices, &numDevices) == EGL_TRUE)
+        {
+            for (EGLint i = 0; i < numDevices; ++i)
+            {
+                /* EGL does not expose the memory size or the adapter type, except for Mesa's software device */
+                const auto deviceExtensions = GetEGLDeviceString(QueryDeviceStringEXT, devices[i], EGL_EXTENSIONS);
+                auto deviceName = GetEGLDeviceString(QueryDeviceStringEXT, devices[i], EGL_RENDERER_EXT);
+                if (deviceName.empty())
+                    deviceName = GetEGLDeviceString(QueryDeviceStringEXT, devices[i], EGL_DRM_DEVICE_FILE_EXT);
+
+                VideoAdapterDescriptor adapterDesc;
+                {
+                    adapterDesc.name    = std::wstring(deviceName.begin(), deviceName.end());
+                    adapterDesc.vendor  = GetEGLDeviceString(QueryDeviceStringEXT, devices[i], EGL_VENDOR);
+                    if (HasEGLExtension(deviceExtensions.c_str(), "EGL_MESA_device_software"))
+                        adapterDesc.flags = VideoAdapterFlags::Software;
+                }
+                outAdapters.push_back(std::move(adapterDesc));
+            }
+            return;
+        }
+    }
+
+    /* Surfaceless platform only provides the default device */
+    if (HasEGLExtension(clientExtensions, "EGL_MESA_platform_surfaceless"))
+    {
+        VideoAdapterDescriptor adapterDesc;
+        adapterDesc.name = L"EGL surfaceless";
+        outAdapters.push_back(std::move(adapterDesc));
+    }
+}
+
+
+/*
+ * LinuxGLHeadlessContext class
+ */
+
+// Returns the EGL display for the specified device, or the surfaceless platform if the device platform is unavailable.
+static EGLDisplay GetHeadlessEGLDisplay(int deviceIndex)
+{
+    const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+    auto GetPlatformDisplayEXT = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (GetPlatformDisplayEXT == nullptr || !HasEGLExtension(clientExtensions, "EGL_EXT_platform_base"))
+        throw std::runtime_error("cannot create headless OpenGL context: EGL_EXT_platform_base is not supported");
+
+    /* Prefer the device platform, since it can select between multiple GPUs */
+    if (HasEGLExtension(clientExtensions, "EGL_EXT_platform_device"))
+    {
+        auto QueryDevicesEXT = reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(eglGetProcAddress("eglQueryDevicesEXT"));
+        if (QueryDevicesEXT != nullptr)
+        {
+            EGLDeviceEXT devices[16];
+            EGLint numDevices = 0;
+            if (QueryDevicesEXT(16, devices, &numDevices) == EGL_TRUE && numDevices > 0)
+            {
+                const EGLint index = (deviceIndex >= 0 ? static_cast<EGLint>(deviceIndex) : 0);
+                if (index >= numDevices)
+                {
+                    throw std::runtime_error(
+                        "cannot create headless OpenGL context: EGL device index " + std::to_string(index) +
+                        " is out of range [0, " + std::to_string(numDevices) + ")"
+                    );
+                }
+                auto display = GetPlatformDisplayEXT(EGL_PLATFORM_DEVICE_EXT, devices[index], nullptr);
+                if (display != EGL_NO_DISPLAY)
+                    return display;
+            }
+        }
+    }
+
+    /* Surfaceless platform has no notion of devices */
+    if (deviceIndex > 0)
+        throw std::runtime_error("cannot create headless OpenGL context: EGL_EXT_platform_device is required to select an EGL device");
+
+    if (!HasEGLExtension(clientExtensions, "EGL_MESA_platform_surfaceless"))
+        throw std::runtime_error("cannot create headless OpenGL context: neither EGL_EXT_platform_device nor EGL_MESA_platform_surfaceless is supported");
+
+    return GetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+}
+
+LinuxGLHeadlessContext::LinuxGLHeadlessContext(
+    const GLPixelFormat&                pixelFormat,
+    const RendererConfigurationOpenGL&  profile,
+    LinuxGLHeadlessContext*             sharedContext)
+{
+    /* Shared contexts must be created on the same EGL display */
+    if (sharedContext != nullptr)
+        display_ = sharedContext->display_;
+    else
+        display_ = GetHeadlessEGLDisplay(profile.deviceIndex);
+
+    if (display_ == EGL_NO_DISPLAY)
+        throw std::runtime_error("failed to get EGL display for headless OpenGL context");
+
+    if (eglInitialize(display_, nullptr, nullptr) != EGL_TRUE)
+        throw std::runtime_error("failed to initialize EGL display for headless OpenGL context");
+
+    if (eglBindAPI(EGL_OPENGL_API) != EGL_TRUE)
+        throw std::runtime_error("failed to bind OpenGL API for EGL");
+
+    CreateContext(profile, (sharedContext != nullptr ? sharedContext->context_ : EGL_NO_CONTEXT));
+
+    /* Make new context current; without EGL_KHR_surfaceless_context a small placeholder pbuffer is required */
+    if (!HasEGLExtension(eglQueryString(display_, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context"))
+    {
+        const EGLint pbufferAttribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+        pbuffer_ = eglCreatePbufferSurface(display_, config_, pbufferAttribs);
+        if (pbuffer_ == EGL_NO_SURFACE)
+            throw std::runtime_error("failed to create EGL pbuffer for headless OpenGL context");
+    }
+
+    if (!MakeCurrent())
+        Log::PostReport(Log::ReportType::Error, "eglMakeCurrent failed on headless OpenGL context");
+
+    /* Headless contexts have no default framebuffer, so these formats only serve as defaults */
+    SetDefaultColorFormat();
+    DeduceDepthStencilFormat(pixelFormat.depthBits, pixelFormat.stencilBits);
+}
+
+LinuxGLHeadlessContext::~LinuxGLHeadlessContext()
+{
+    /* Don't terminate the EGL display, because it is shared between all headless contexts */
+    eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (pbuffer_ != EGL_NO_SURFACE)
+        eglDestroySurface(display_, pbuffer_);
+    eglDestroyContext(display_, context_);
+}
+
+void LinuxGLHeadlessContext::Resize(const Extent2D& /*resolution*/)
+{
+    // dummy
+}
+
+int LinuxGLHeadlessContext::GetSamples() const
+{
+    return 1;
+}
+
+bool LinuxGLHeadlessContext::MakeCurrent()
+{
+    return (eglMakeCurrent(display_, pbuffer_, pbuffer_, context_) == EGL_TRUE);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool LinuxGLHeadlessContext::SetSwapInterval(int /*interval*/)
+{
+    return false; // no swap-chain for headless contexts
+}
+
+void LinuxGLHeadlessContext::CreateContext(const RendererConfigurationOpenGL& profile, EGLContext sharedContext)
+{
+    /* Choose any RGBA8 configuration;
+       rendering only goes into framebuffer objects, so the configuration does not need depth or stencil bits */
+    const EGLint configAttribs[] =
+    {
+        EGL_SURFACE_TYPE,       EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE,    EGL_OPENGL_BIT,
+        EGL_RED_SIZE,           8,
+        EGL_GREEN_SIZE,         8,
+        EGL_BLUE_SIZE,          8,
+        EGL_ALPHA_SIZE,         8,
+        EGL_NONE
+    };
+
+    EGLint numConfigs = 0;
+    if (eglChooseConfig(display_, configAttribs, &config_, 1, &numConfigs) != EGL_TRUE || numConfigs == 0)
+        throw std::runtime_error("failed to choose EGL configuration for headless OpenGL context");
+
+    if (profile.contextProfile == OpenGLContextProfile::CoreProfile)
+    {
+        if (profile.majorVersion == 0 && profile.minorVersion == 0)
+        {
+            /* Try highest GL core profile version first, since EGL cannot query it before a context exists */
+            static const int versions[][2] = { { 4, 6 }, { 4, 5 }, { 4, 4 }, { 4, 3 }, { 4, 2 }, { 4, 1 }, { 4, 0 }, { 3, 3 }, { 3, 2 } };
+            for (const auto& version : versions)
+            {
+                context_ = CreateContextCoreProfile(sharedContext, version[0], version[1]);
+                if (context_ != EGL_NO_CONTEXT)
+                    break;
+            }
+        }
+        else
+            context_ = CreateContextCoreProfile(sharedContext, profile.majorVersion, profile.minorVersion);
+
+        if (context_ == EGL_NO_CONTEXT)
+            Log::PostReport(Log::ReportType::Error, "failed to create OpenGL core profile with EGL");
+    }
+
+    /* Fall back to compatibility profile */
+    if (context_ == EGL_NO_CONTEXT)
+        context_ = CreateContextCompatibilityProfile(sharedContext);
+
+    if (context_ == EGL_NO_CONTEXT)
+        throw std::runtime_error("failed to create headless OpenGL context with EGL");
+}
+
+EGLContext LinuxGLHeadlessContext::CreateContextCoreProfile(EGLContext sharedContext, int major, int minor)
+{
+    const EGLint contextAttribs[] =
+    {
+        EGL_CONTEXT_MAJOR_VERSION_KHR,          major,
+        EGL_CONTEXT_MINOR_VERSION_KHR,          minor,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR,    EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR,
+        EGL_NONE
+    };
+    return eglCreateContext(display_, config_, sharedContext, contextAttribs);
+}
+
+EGLContext LinuxGLHeadlessContext::CreateContextCompatibilityProfile(EGLContext sharedContext)
+{
+    return eglCreateContext(display_, config_, sharedContext, nullptr);
+}
+
+
+} // /namespace LLGL
+
+#endif // /LLGL_GL_ENABLE_EGL
+
+
+
+// ================================================================================
@@ -0,0 +1,72 @@
+/*
+ * LinuxGLHeadlessContext.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_LINUX_GL_HEADLESS_CONTEXT_H
+#define LLGL_LINUX_GL_HEADLESS_CONTEXT_H
+
+
+#include "../GLContext.h"
+#include <LLGL/RendererConfiguration.h>
+#include <EGL/egl.h>
+
+
+namespace LLGL
+{
+
+
+/*
+Implementation of the <GLContext> interface for headless rendering on GNU/Linux with EGL.
+The context is created on the EGL device platform or the Mesa surfaceless platform, so no X11 display is required.
+*/
+class LinuxGLHeadlessContext : public GLContext
+{
+
+    public:
+
+        LinuxGLHeadlessContext(
+            const GLPixelFormat&                pixelFormat,
+            const RendererConfigurationOpenGL&  profile,
+            LinuxGLHeadlessContext*             sharedContext
+        );
+        ~LinuxGLHeadlessContext();
+
+        void Resize(const Extent2D& resolution) override;
+        int GetSamples() const override;
+
+    public:
+
+        // Makes this EGL context current on the calling thread.
+        bool MakeCurrent();
+
+    private:
+
+        bool SetSwapInterval(int interval) override;
+
+    private:
+
+        void CreateContext(const RendererConfigurationOpenGL& profile, EGLContext sharedContext);
+        EGLContext CreateContextCoreProfile(EGLContext sharedContext, int major, int minor);
+        EGLContext CreateContextCompatibilityProfile(EGLContext sharedContext);
+
+    private:
+
+        EGLDisplay  display_    = EGL_NO_DISPLAY;
+        EGLConfig   config_     = nullptr;
+        EGLContext  context_    = EGL_NO_CONTEXT;
+        EGLSurface  pbuffer_    = EGL_NO_SURFACE; // Only used if EGL_KHR_surfaceless_context is unavailable
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -13,8 +13,8 @@ namespace LLGL
 {
 
 
-GLComputePSO::GLComputePSO(const ComputePipelineDescriptor& desc) :
-    GLPipelineState { /*isGraphicsPSO:*/ false, desc.pipelineLayout, { desc.computeShader } }
+GLComputePSO::GLComputePSO(const ComputePipelineDescriptor& desc, const GLProgramBinary* cachedBinary) :
+    GLPipelineState { /*isGraphicsPSO:*/ false, desc.pipelineLayout, { desc.computeShader }, cachedBinary }
 {
 }
 
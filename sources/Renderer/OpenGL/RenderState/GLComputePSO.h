@@ -25,7 +25,7 @@ class GLComputePSO final : public GLPipelineState
 
     public:
 
-        GLComputePSO(const ComputePipelineDescriptor& desc);
+        GLComputePSO(const ComputePipelineDescriptor& desc, const GLProgramBinary* cachedBinary = nullptr);
 
 };
 
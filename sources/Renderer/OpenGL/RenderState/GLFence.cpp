@@ -29,8 +29,28 @@ void GLFence::SetName(const char* name)
     #endif
 }
 
+std::uint64_t GLFence::GetValue() const
+{
+    return value_;
+}
+
+std::uint64_t GLFence::GetCompletedValue() const
+{
+    if (completedValue_ < value_ && sync_ != 0)
+    {
+        /* Poll sync object without blocking */
+        GLint status = GL_UNSIGNALED;
+        glGetSynciv(sync_, GL_SYNC_STATUS, 1, nullptr, &status);
+        if (status == GL_SIGNALED)
+            completedValue_ = value_;
+    }
+    return completedValue_;
+}
+
 void GLFence::Submit()
 {
+    ++value_;
+
     if (HasExtension(GLExt::ARB_sync))
     {
         #ifdef LLGL_DEBUG
@@ -53,16 +73,20 @@ void GLFence::Submit()
 
 bool GLFence::Wait(GLuint64 timeout)
 {
+    if (completedValue_ == value_)
+        return true;
+
     if (HasExtension(GLExt::ARB_sync))
     {
         GLenum result = glClientWaitSync(sync_, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
-        return (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED);
+        if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+            return false;
     }
     else
-    {
         glFinish();
-        return true;
-    }
+
+    completedValue_ = value_;
+    return true;
 }
 
 
@@ -25,6 +25,9 @@ class GLFence final : public Fence
 
         void SetName(const char* name) override;
 
+        std::uint64_t GetValue() const override;
+        std::uint64_t GetCompletedValue() const override;
+
     public:
 
         ~GLFence();
@@ -34,7 +37,9 @@ class GLFence final : public Fence
 
     private:
 
-        GLsync      sync_ = 0;
+        GLsync                  sync_           = 0;
+        std::uint64_t           value_          = 0;
+        mutable std::uint64_t   completedValue_ = 0;
 
         #ifdef LLGL_DEBUG
         // Only provide name in debug mode, to keep fence objects as lightweight as possible
@@ -0,0 +1,46 @@
+/*
+ * GLPipelineLayout.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLPipelineLayout.h"
+#include <LLGL/ResourceFlags.h>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+GLPipelineLayout::GLPipelineLayout(const PipelineLayoutDescriptor& desc) :
+    BasicPipelineLayout { desc }
+{
+    for (const auto& binding : desc.bindings)
+    {
+        if ((binding.flags & BindingFlags::InlineUniforms) != 0)
+        {
+            if (binding.type != ResourceType::Buffer || (binding.bindFlags & BindFlags::ConstantBuffer) == 0)
+                throw std::invalid_argument("cannot create GL uniform block for inline uniform binding that is not a constant buffer");
+
+            /* Map inline uniforms onto a uniform block; the array size specifies the number of 32-bit values */
+            inlineUniforms_.push_back({ binding.slot, numInlineUniformValues_, binding.arraySize });
+            numInlineUniformValues_ += binding.arraySize;
+        }
+        else
+            heapBindings_.push_back(binding);
+    }
+}
+
+std::uint32_t GLPipelineLayout::GetNumBindings() const
+{
+    return static_cast<std::uint32_t>(heapBindings_.size());
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
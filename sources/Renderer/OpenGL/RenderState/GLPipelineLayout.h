@@ -1,6 +1,6 @@
 /*
  * GLPipelineLayout.h
- * 
+ *
  * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
  * See "LICENSE.txt" for license information.
  */
@@ -10,13 +10,58 @@
 
 
 #include "../../BasicPipelineLayout.h"
+#include "../OpenGL.h"
+#include <vector>
 
 
 namespace LLGL
 {
 
 
-using GLPipelineLayout = BasicPipelineLayout;
+// Range of 32-bit values of an inline uniform binding (see BindingFlags::InlineUniforms) that is mapped to a uniform block.
+struct GLInlineUniformBinding
+{
+    GLuint          slot;       // Uniform-block binding index
+    std::uint32_t   first;      // Uniform location of the first 32-bit value (sum of values of all previous inline bindings)
+    std::uint32_t   count;      // Number of 32-bit values
+};
+
+class GLPipelineLayout final : public BasicPipelineLayout
+{
+
+    public:
+
+        std::uint32_t GetNumBindings() const override;
+
+    public:
+
+        GLPipelineLayout(const PipelineLayoutDescriptor& desc);
+
+        // Returns the list of binding descriptors that are part of the resource heaps, i.e. all bindings except inline uniforms.
+        inline const std::vector<BindingDescriptor>& GetHeapBindings() const
+        {
+            return heapBindings_;
+        }
+
+        // Returns the list of inline uniform bindings.
+        inline const std::vector<GLInlineUniformBinding>& GetInlineUniforms() const
+        {
+            return inlineUniforms_;
+        }
+
+        // Returns the total number of 32-bit values of all inline uniform bindings.
+        inline std::uint32_t GetNumInlineUniformValues() const
+        {
+            return numInlineUniformValues_;
+        }
+
+    private:
+
+        std::vector<BindingDescriptor>      heapBindings_;
+        std::vector<GLInlineUniformBinding> inlineUniforms_;
+        std::uint32_t                       numInlineUniformValues_ = 0;
+
+};
 
 
 } // /namespace LLGL
@@ -9,6 +9,7 @@
 #include "GLStatePool.h"
 #include "GLStateManager.h"
 #include "../Shader/GLShaderProgram.h"
+#include "../Shader/GLShader.h"
 #include "../../CheckedCast.h"
 
 
@@ -30,22 +31,28 @@ static bool AnyNamesInPipelineLayout(const GLPipelineLayout& pipelineLayout)
 GLPipelineState::GLPipelineState(
     bool                        isGraphicsPSO,
     const PipelineLayout*       pipelineLayout,
-    const ArrayView<Shader*>&   shaders)
+    const ArrayView<Shader*>&   shaders,
+    const GLProgramBinary*      cachedBinary)
 :
-    isGraphicsPSO_ { isGraphicsPSO }
+    isGraphicsPSO_  { isGraphicsPSO                                        },
+    pipelineLayout_ { LLGL_CAST(const GLPipelineLayout*, pipelineLayout) }
 {
     /* Create shader pipeline */
-    shaderPipeline_ = GLStatePool::Get().CreateShaderPipeline(shaders.size(), shaders.data());
-    shaderPipeline_->QueryInfoLogs(report_);
+    shaderPipeline_ = GLStatePool::Get().CreateShaderPipeline(shaders.size(), shaders.data(), cachedBinary);
+
+    /* Don't wait for the driver to link the shader pipeline if shaders are compiled in parallel */
+    if (GLShader::HasParallelCompile())
+        isReportDeferred_ = true;
+    else
+        shaderPipeline_->QueryInfoLogs(report_);
 
     /* Create shader binding layout by binding descriptor */
     if (pipelineLayout != nullptr)
     {
         /* Ignore pipeline layout if there are no names specified, because no valid binding layout can be created then */
-        auto pipelineLayoutGL = LLGL_CAST(const GLPipelineLayout*, pipelineLayout);
-        if (AnyNamesInPipelineLayout(*pipelineLayoutGL))
+        if (AnyNamesInPipelineLayout(*pipelineLayout_))
         {
-            shaderBindingLayout_ = GLStatePool::Get().CreateShaderBindingLayout(*pipelineLayoutGL);
+            shaderBindingLayout_ = GLStatePool::Get().CreateShaderBindingLayout(*pipelineLayout_);
             if (!shaderBindingLayout_->HasBindings())
                 GLStatePool::Get().ReleaseShaderBindingLayout(std::move(shaderBindingLayout_));
         }
@@ -60,9 +67,26 @@ GLPipelineState::~GLPipelineState()
 
 const Report* GLPipelineState::GetReport() const
 {
+    if (isReportDeferred_)
+    {
+        /* Query deferred info logs on first access; this blocks until the shader pipeline has been linked */
+        shaderPipeline_->QueryInfoLogs(report_);
+        isReportDeferred_ = false;
+    }
     return (report_ ? &report_ : nullptr);
 }
 
+bool GLPipelineState::IsReady() const
+{
+    return shaderPipeline_->IsLinkCompleted();
+}
+
+void GLPipelineState::Wait()
+{
+    /* Querying the info logs blocks until the shader pipeline has been linked */
+    GetReport();
+}
+
 void GLPipelineState::Bind(GLStateManager& stateMngr)
 {
     /* Bind shader program and discard rasterizer if there is no fragment shader */
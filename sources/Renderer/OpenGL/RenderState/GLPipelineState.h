@@ -24,6 +24,7 @@ namespace LLGL
 
 
 class PipelineLayout;
+class GLPipelineLayout;
 class GLStateManager;
 class GLShaderProgram;
 
@@ -32,14 +33,18 @@ class GLPipelineState : public PipelineState
 
     public:
 
+        // Creates the pipeline state. If 'cachedBinary' is non-null, the shader program is loaded from that binary if possible.
         GLPipelineState(
             bool                        isGraphicsPSO,
             const PipelineLayout*       pipelineLayout,
-            const ArrayView<Shader*>&   shaders
+            const ArrayView<Shader*>&   shaders,
+            const GLProgramBinary*      cachedBinary    = nullptr
         );
         ~GLPipelineState();
 
         const Report* GetReport() const override;
+        bool IsReady() const override;
+        void Wait() override;
 
         // Binds this pipeline state with the specified GL state manager.
         virtual void Bind(GLStateManager& stateMngr);
@@ -56,12 +61,20 @@ class GLPipelineState : public PipelineState
             return shaderPipeline_.get();
         }
 
+        // Returns the pipeline layout used for this PSO or null if there is none.
+        inline const GLPipelineLayout* GetPipelineLayout() const
+        {
+            return pipelineLayout_;
+        }
+
     private:
 
         const bool                  isGraphicsPSO_          = false;
+        const GLPipelineLayout*     pipelineLayout_         = nullptr;
         GLShaderPipelineSPtr        shaderPipeline_         = nullptr;
         GLShaderBindingLayoutSPtr   shaderBindingLayout_;
-        BasicReport                 report_;
+        mutable BasicReport         report_;
+        mutable bool                isReportDeferred_       = false;
 
 };
 
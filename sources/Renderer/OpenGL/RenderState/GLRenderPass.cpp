@@ -8,6 +8,8 @@
 #include "GLRenderPass.h"
 #include "../../RenderPassUtils.h"
 #include <LLGL/CommandBufferFlags.h>
+#include <LLGL/Misc/ForRange.h>
+#include <algorithm>
 
 
 namespace LLGL
@@ -28,6 +30,35 @@ GLRenderPass::GLRenderPass(const RenderPassDescriptor& desc)
     /* Check if stencil attachment must be cleared */
     if (desc.stencilAttachment.loadOp == AttachmentLoadOp::Clear)
         clearMask_ |= GL_STENCIL_BUFFER_BIT;
+
+    /* Check which color attachments can be invalidated */
+    std::uint32_t numInvalidateColorAttachments = 0;
+    for_range(i, NumEnabledColorAttachments(desc))
+    {
+        if (desc.colorAttachments[i].storeOp == AttachmentStoreOp::Undefined)
+            invalidateColorAttachments_[numInvalidateColorAttachments++] = static_cast<std::uint8_t>(i);
+    }
+    for_subrange(i, numInvalidateColorAttachments, LLGL_MAX_NUM_COLOR_ATTACHMENTS)
+        invalidateColorAttachments_[i] = 0xFF;
+
+    if (numInvalidateColorAttachments > 0)
+        invalidateMask_ |= GL_COLOR_BUFFER_BIT;
+
+    /* Check if depth attachment can be invalidated */
+    if (desc.depthAttachment.format != Format::Undefined && desc.depthAttachment.storeOp == AttachmentStoreOp::Undefined)
+        invalidateMask_ |= GL_DEPTH_BUFFER_BIT;
+
+    /* Check if stencil attachment can be invalidated */
+    if (desc.stencilAttachment.format != Format::Undefined && desc.stencilAttachment.storeOp == AttachmentStoreOp::Undefined)
+        invalidateMask_ |= GL_STENCIL_BUFFER_BIT;
+
+    /* Store color attachment masks of sub-passes; GL can only toggle draw buffers between sub-passes */
+    numSubpasses_ = std::min<std::uint32_t>(desc.numSubpasses, LLGL_MAX_NUM_SUBPASSES);
+    for_range(i, numSubpasses_)
+    {
+        subpassColorAttachments_[i] = static_cast<std::uint8_t>(desc.subpasses[i].colorAttachments);
+        subpassInputAttachments_[i] = static_cast<std::uint8_t>(desc.subpasses[i].inputAttachments);
+    }
 }
 
 
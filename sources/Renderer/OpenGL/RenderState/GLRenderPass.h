@@ -45,11 +45,48 @@ class GLRenderPass final : public RenderPass
             return clearColorAttachments_;
         }
 
+        // Specifies which buffer groups are meant to be invalidated when a render pass ends, i.e. attachments with AttachmentStoreOp::Undefined.
+        inline GLbitfield GetInvalidateMask() const
+        {
+            return invalidateMask_;
+        }
+
+        // Returns the array of color attachment indices that are meant to be invalidated when a render pass ends (value of 0xFF ends the list).
+        inline const std::uint8_t* GetInvalidateColorAttachments() const
+        {
+            return invalidateColorAttachments_;
+        }
+
+        // Returns the number of explicit sub-passes of this render pass or 0 if the render pass has a single implicit sub-pass.
+        inline std::uint32_t GetNumSubpasses() const
+        {
+            return numSubpasses_;
+        }
+
+        // Returns the bitmask of color attachments the specified sub-pass writes to.
+        inline std::uint32_t GetSubpassColorAttachments(std::uint32_t subpass) const
+        {
+            return subpassColorAttachments_[subpass];
+        }
+
+        // Returns the bitmask of color attachments the specified sub-pass reads as input attachments.
+        inline std::uint32_t GetSubpassInputAttachments(std::uint32_t subpass) const
+        {
+            return subpassInputAttachments_[subpass];
+        }
+
     private:
 
-        GLbitfield      clearMask_                                              = 0;
-        std::uint8_t    clearColorAttachments_[LLGL_MAX_NUM_COLOR_ATTACHMENTS]  = {};
-        std::uint8_t    numColorAttachments_                                    = 0;
+        GLbitfield      clearMask_                                                  = 0;
+        std::uint8_t    clearColorAttachments_[LLGL_MAX_NUM_COLOR_ATTACHMENTS]      = {};
+        std::uint8_t    numColorAttachments_                                        = 0;
+
+        GLbitfield      invalidateMask_                                             = 0;
+        std::uint8_t    invalidateColorAttachments_[LLGL_MAX_NUM_COLOR_ATTACHMENTS] = {};
+
+        std::uint32_t   numSubpasses_                                               = 0;
+        std::uint8_t    subpassColorAttachments_[LLGL_MAX_NUM_SUBPASSES]            = {};
+        std::uint8_t    subpassInputAttachments_[LLGL_MAX_NUM_SUBPASSES]            = {};
 
 };
 
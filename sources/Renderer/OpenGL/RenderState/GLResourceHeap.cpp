@@ -25,11 +25,13 @@
 #include "../../ResourceUtils.h"
 #include "../../../Core/Assertion.h"
 #include "../../../Core/ContainerUtils.h"
+#include "../../../Core/Helper.h"
 #include <LLGL/ResourceHeapFlags.h>
 #include <LLGL/Container/ArrayView.h>
 #include <LLGL/Misc/ForRange.h>
 #include <string.h>
 #include <limits.h>
+#include <unordered_map>
 
 
 namespace LLGL
@@ -131,6 +133,46 @@ static GLbitfield ToMemoryBarrierBitfield(long barrierFlags)
     return barriers;
 }
 
+// Invalid index for bindings that are not mapped to a bindless texture handle
+static const std::uint32_t g_invalidBindlessIndex = ~0u;
+
+// Returns true if bindless textures are supported and can be stored in a shader storage buffer
+static bool IsBindlessTextureSupported()
+{
+    #ifdef GL_ARB_bindless_texture
+    return (HasExtension(GLExt::ARB_bindless_texture) && HasExtension(GLExt::ARB_shader_storage_buffer_object));
+    #else
+    return false;
+    #endif
+}
+
+#ifdef GL_ARB_bindless_texture
+
+/*
+Reference counters for resident bindless texture handles.
+The same texture and sampler combination always returns the same handle,
+but a handle must not be made resident or non-resident twice.
+*/
+static std::unordered_map<GLuint64, std::uint32_t> g_residentTextureHandles;
+
+static void AcquireResidentTextureHandle(GLuint64 handle)
+{
+    if (g_residentTextureHandles[handle]++ == 0)
+        glMakeTextureHandleResidentARB(handle);
+}
+
+static void ReleaseResidentTextureHandle(GLuint64 handle)
+{
+    auto it = g_residentTextureHandles.find(handle);
+    if (it != g_residentTextureHandles.end() && --(it->second) == 0)
+    {
+        glMakeTextureHandleNonResidentARB(handle);
+        g_residentTextureHandles.erase(it);
+    }
+}
+
+#endif // /GL_ARB_bindless_texture
+
 
 /*
  * GLResourceHeap class
@@ -148,7 +190,7 @@ GLResourceHeap::GLResourceHeap(
         throw std::invalid_argument("failed to create resource heap due to missing pipeline layout");
 
     /* Get and validate number of bindings and resource views */
-    const auto& bindings            = pipelineLayoutGL->GetBindings();
+    const auto& bindings            = pipelineLayoutGL->GetHeapBindings();
     const auto  numBindings         = static_cast<std::uint32_t>(bindings.size());
     const auto  numResourceViews    = GetNumResourceViewsOrThrow(numBindings, desc, initialResourceViews);
 
@@ -158,19 +200,34 @@ GLResourceHeap::GLResourceHeap(
     /* Allocate templates for all resource view segments */
     BindingDescriptorIterator bindingIter{ bindings };
 
+    const bool isBindless = (desc.bindlessSlot != Constants::invalidSlot && IsBindlessTextureSupported());
+
     AllocSegmentsUBO(bindingIter);
     AllocSegmentsSSBO(bindingIter);
-    AllocSegmentsTexture(bindingIter);
-    AllocSegmentsImage(bindingIter);
-    AllocSegmentsSampler(bindingIter);
-    #ifdef LLGL_GL_ENABLE_OPENGL2X
-    AllocSegmentsGL2XSampler(bindingIter);
-    #endif
+    if (isBindless)
+    {
+        /* Store sampled textures as bindless handles; samplers are combined with their textures */
+        bindlessSlot_ = static_cast<GLuint>(desc.bindlessSlot);
+        AllocBindlessTextures(bindingIter);
+        AllocSegmentsImage(bindingIter);
+    }
+    else
+    {
+        AllocSegmentsTexture(bindingIter);
+        AllocSegmentsImage(bindingIter);
+        AllocSegmentsSampler(bindingIter);
+        #ifdef LLGL_GL_ENABLE_OPENGL2X
+        AllocSegmentsGL2XSampler(bindingIter);
+        #endif
+    }
 
     /* Finalize segments in buffer */
     const auto numSegmentSets = (numResourceViews / numBindings);
     heap_.FinalizeSegments(numSegmentSets);
 
+    if (numBindless_ > 0)
+        CreateBindlessBuffer(numSegmentSets);
+
     /* Write initial resource views */
     if (!initialResourceViews.empty())
         WriteResourceViews(0, initialResourceViews);
@@ -178,8 +235,9 @@ GLResourceHeap::GLResourceHeap(
 
 GLResourceHeap::~GLResourceHeap()
 {
-    /* Release all texture views for this resource heap */
+    /* Release all texture views and bindless texture handles for this resource heap */
     FreeAllSegmentsTextureViews();
+    ReleaseBindlessHandles();
 }
 
 std::uint32_t GLResourceHeap::WriteResourceViews(std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews)
@@ -199,7 +257,9 @@ std::uint32_t GLResourceHeap::WriteResourceViews(std::uint32_t firstDescriptor,
         return 0;
 
     /* Write each resource view into respective segment */
-    std::uint32_t numWritten = 0;
+    std::uint32_t numWritten        = 0;
+    std::uint32_t bindlessSetBegin  = numSets;
+    std::uint32_t bindlessSetEnd    = 0;
 
     for (const auto& desc : resourceViews)
     {
@@ -208,9 +268,22 @@ std::uint32_t GLResourceHeap::WriteResourceViews(std::uint32_t firstDescriptor,
             continue;
 
         /* Get binding information and heap start for descriptor set */
-        const auto& binding = bindingMap_[firstDescriptor % numBindings];
+        const auto  bindingIndex    = firstDescriptor % numBindings;
+        const auto& binding         = bindingMap_[bindingIndex];
 
         auto descriptorSet  = firstDescriptor / numBindings;
+
+        /* Write bindless texture handles separately from the heap segments */
+        if (!bindlessMap_.empty() && bindlessMap_[bindingIndex] != g_invalidBindlessIndex)
+        {
+            WriteResourceViewBindless(desc, descriptorSet, bindlessMap_[bindingIndex]);
+            bindlessSetBegin    = std::min(bindlessSetBegin, descriptorSet);
+            bindlessSetEnd      = std::max(bindlessSetEnd, descriptorSet + 1);
+            ++numWritten;
+            ++firstDescriptor;
+            continue;
+        }
+
         auto heapStartPtr   = heap_.SegmentData(descriptorSet);
         auto heapPtr        = heapStartPtr + binding.segmentOffset;
         auto segment        = GLRESOURCEHEAP_CONST_SEGMENT(heapPtr);
@@ -244,6 +317,17 @@ std::uint32_t GLResourceHeap::WriteResourceViews(std::uint32_t firstDescriptor,
         ++firstDescriptor;
     }
 
+    /* Upload modified bindless texture handles of all affected descriptor sets at once */
+    if (bindlessSetBegin < bindlessSetEnd)
+    {
+        const auto handlesPerSet = static_cast<std::size_t>(bindlessStride_) / sizeof(GLuint64);
+        bindlessBuffer_->BufferSubData(
+            static_cast<GLintptr>(bindlessStride_ * bindlessSetBegin),
+            static_cast<GLsizeiptr>(bindlessStride_ * (bindlessSetEnd - bindlessSetBegin)),
+            &bindlessHandles_[handlesPerSet * bindlessSetBegin]
+        );
+    }
+
     return numWritten;
 }
 
@@ -356,6 +440,18 @@ void GLResourceHeap::Bind(GLStateManager& stateMngr, std::uint32_t descriptorSet
 
     #endif // /GL_ARB_shader_image_load_store
 
+    /* Bind all bindless texture handles with a single shader storage buffer range */
+    if (bindlessBuffer_)
+    {
+        stateMngr.BindBufferRange(
+            GLBufferTarget::SHADER_STORAGE_BUFFER,
+            bindlessSlot_,
+            bindlessBuffer_->GetID(),
+            static_cast<GLintptr>(bindlessStride_ * descriptorSet),
+            static_cast<GLsizeiptr>(sizeof(GLuint64) * numBindless_)
+        );
+    }
+
     /* Bind all constant buffers */
     for_range(i, segmentation_.numUniformBufferSegments)
         heapPtr += BindBuffersSegment(stateMngr, heapPtr, GLBufferTarget::UNIFORM_BUFFER);
@@ -456,6 +552,73 @@ void GLResourceHeap::FreeAllSegmentsTextureViews()
         FreeAllSegmentSetTextureViews(heapPtr);
 }
 
+void GLResourceHeap::AllocBindlessTextures(BindingDescriptorIterator& bindingIter)
+{
+    /* Collect all textures with sampled binding and all samplers */
+    auto textureBindingSlots = FilterAndSortGLBindingSlots(bindingIter, ResourceType::Texture, BindFlags::Sampled);
+    auto samplerBindingSlots = FilterAndSortGLBindingSlots(bindingIter, ResourceType::Sampler, 0);
+
+    /* Map texture bindings to bindless handles in ascending order of their binding slots */
+    bindlessMap_.resize(bindingMap_.size(), g_invalidBindlessIndex);
+    numBindless_ = static_cast<std::uint32_t>(textureBindingSlots.size());
+
+    for_range(i, numBindless_)
+        bindlessMap_[textureBindingSlots[i].index] = i;
+
+    /* Map samplers onto the handles of the textures with the same binding slots */
+    for (auto& samplerBinding : samplerBindingSlots)
+    {
+        const auto* textureBinding = Utils::FindInSortedArray<GLResourceBinding>(
+            textureBindingSlots.data(),
+            textureBindingSlots.size(),
+            [&samplerBinding](const GLResourceBinding& entry) -> int
+            {
+                return (static_cast<int>(samplerBinding.slot) - static_cast<int>(entry.slot));
+            }
+        );
+        if (textureBinding != nullptr)
+            bindlessMap_[samplerBinding.index] = bindlessMap_[textureBinding->index];
+    }
+}
+
+void GLResourceHeap::CreateBindlessBuffer(std::uint32_t numSets)
+{
+    /* Each descriptor set is bound as buffer range, so its stride must satisfy the SSBO offset alignment */
+    GLint alignment = 0;
+    #ifdef GL_ARB_shader_storage_buffer_object
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    #endif
+    alignment = std::max(alignment, static_cast<GLint>(sizeof(GLuint64)));
+
+    bindlessStride_ = GetAlignedSize<GLsizeiptr>(sizeof(GLuint64) * numBindless_, alignment);
+
+    /* Allocate CPU copy of all handles and entries with null handles */
+    bindlessHandles_.resize(static_cast<std::size_t>(bindlessStride_) / sizeof(GLuint64) * numSets, 0);
+    bindlessEntries_.resize(numBindless_ * numSets);
+
+    /* Allocate shader storage buffer for the handles */
+    #ifdef GL_ARB_buffer_storage
+    const GLbitfield storageFlags = GL_DYNAMIC_STORAGE_BIT;
+    #else
+    const GLbitfield storageFlags = 0;
+    #endif
+    bindlessBuffer_ = MakeUnique<GLBuffer>(BindFlags::Storage);
+    bindlessBuffer_->BufferStorage(bindlessStride_ * numSets, bindlessHandles_.data(), storageFlags, GL_DYNAMIC_DRAW);
+}
+
+void GLResourceHeap::ReleaseBindlessHandles()
+{
+    for (auto& entry : bindlessEntries_)
+    {
+        #ifdef GL_ARB_bindless_texture
+        if (entry.handle != 0)
+            ReleaseResidentTextureHandle(entry.handle);
+        #endif
+        FreeTextureView(entry.texView);
+    }
+    bindlessEntries_.clear();
+}
+
 void GLResourceHeap::AllocSegmentsUBO(BindingDescriptorIterator& bindingIter)
 {
     /* Collect all uniform buffers */
@@ -824,6 +987,54 @@ void GLResourceHeap::WriteResourceViewSampler(const ResourceViewDescriptor& desc
     GLRESOURCEHEAP_DATA0(heapPtr, GLuint)[index] = samplerGL->GetID();
 }
 
+void GLResourceHeap::WriteResourceViewBindless(const ResourceViewDescriptor& desc, std::uint32_t descriptorSet, std::uint32_t index)
+{
+    #ifdef GL_ARB_bindless_texture
+
+    auto& entry = bindlessEntries_[numBindless_ * descriptorSet + index];
+
+    /* Release previous handle before its texture view can be released */
+    if (entry.handle != 0)
+    {
+        ReleaseResidentTextureHandle(entry.handle);
+        entry.handle = 0;
+    }
+
+    /* Combine texture and sampler into same handle entry */
+    if (desc.resource->GetResourceType() == ResourceType::Sampler)
+    {
+        auto samplerGL = LLGL_CAST(GLSampler*, GetAsExpectedSampler(desc.resource));
+        entry.sampler = samplerGL->GetID();
+    }
+    else
+    {
+        auto textureGL = LLGL_CAST(GLTexture*, GetAsExpectedTexture(desc.resource, BindFlags::Sampled));
+        if (IsTextureViewEnabled(desc.textureView))
+        {
+            AllocTextureView(entry.texView, textureGL->GetID(), desc.textureView);
+            entry.texture = entry.texView;
+        }
+        else
+        {
+            FreeTextureView(entry.texView);
+            entry.texture = textureGL->GetID();
+        }
+    }
+
+    /* Make new handle resident; this makes the texture and sampler parameters immutable */
+    if (entry.texture != 0)
+    {
+        entry.handle = (entry.sampler != 0 ? glGetTextureSamplerHandleARB(entry.texture, entry.sampler) : glGetTextureHandleARB(entry.texture));
+        if (entry.handle != 0)
+            AcquireResidentTextureHandle(entry.handle);
+    }
+
+    const auto handlesPerSet = static_cast<std::size_t>(bindlessStride_) / sizeof(GLuint64);
+    bindlessHandles_[handlesPerSet * descriptorSet + index] = entry.handle;
+
+    #endif // /GL_ARB_bindless_texture
+}
+
 #ifdef LLGL_GL_ENABLE_OPENGL2X
 
 void GLResourceHeap::WriteResourceViewGL2XSampler(const ResourceViewDescriptor& desc, char* heapPtr, std::uint32_t index)
@@ -17,6 +17,8 @@
 #include "../../SegmentedBuffer.h"
 #include "../OpenGL.h"
 #include <functional>
+#include <memory>
+#include <vector>
 
 
 namespace LLGL
@@ -25,12 +27,15 @@ namespace LLGL
 
 enum GLResourceType : std::uint32_t;
 class GLStateManager;
+class GLBuffer;
 class BindingDescriptorIterator;
 struct ResourceHeapDescriptor;
 
 /*
 This class emulates the behavior of a descriptor set like in Vulkan,
 by binding all shader resources within one bind call in the command buffer.
+If bindless textures are enabled, all sampled textures are stored as resident handles in a shader storage buffer
+and are bound with a single buffer binding instead of separate texture and sampler segments.
 */
 class GLResourceHeap final : public ResourceHeap
 {
@@ -53,6 +58,12 @@ class GLResourceHeap final : public ResourceHeap
         // Binds this resource heap with the specified GL state manager.
         void Bind(GLStateManager& stateMngr, std::uint32_t descriptorSet);
 
+        // Returns the bitmask of memory barriers that are inserted each time this resource heap is bound.
+        inline GLbitfield GetBarriers() const
+        {
+            return barriers_;
+        }
+
     private:
 
         struct GLResourceBinding;
@@ -84,6 +95,15 @@ class GLResourceHeap final : public ResourceHeap
             std::size_t index;  // Index to the input bindings list
         };
 
+        // Texture and sampler combination of a bindless texture handle.
+        struct GLBindlessEntry
+        {
+            GLuint      texture = 0;    // Texture ID or texture view ID
+            GLuint      texView = 0;    // Texture view ID (if used) that must be released
+            GLuint      sampler = 0;    // Sampler ID or 0 to use the texture's own sampling parameters
+            GLuint64    handle  = 0;    // Resident bindless texture handle
+        };
+
     private:
 
         void AllocTextureView(GLuint& texViewID, GLuint sourceTexID, const TextureViewDescriptor& textureViewDesc);
@@ -91,6 +111,10 @@ class GLResourceHeap final : public ResourceHeap
         void FreeAllSegmentSetTextureViews(const char* heapPtr);
         void FreeAllSegmentsTextureViews();
 
+        void AllocBindlessTextures(BindingDescriptorIterator& bindingIter);
+        void CreateBindlessBuffer(std::uint32_t numSets);
+        void ReleaseBindlessHandles();
+
         void AllocSegmentsUBO(BindingDescriptorIterator& bindingIter);
         void AllocSegmentsSSBO(BindingDescriptorIterator& bindingIter);
         void AllocSegmentsTexture(BindingDescriptorIterator& bindingIter);
@@ -133,6 +157,7 @@ class GLResourceHeap final : public ResourceHeap
         void WriteResourceViewTexture(const ResourceViewDescriptor& desc, char* heapPtr, std::uint32_t index);
         void WriteResourceViewImage(const ResourceViewDescriptor& desc, char* heapPtr, std::uint32_t index);
         void WriteResourceViewSampler(const ResourceViewDescriptor& desc, char* heapPtr, std::uint32_t index);
+        void WriteResourceViewBindless(const ResourceViewDescriptor& desc, std::uint32_t descriptorSet, std::uint32_t index);
         #ifdef LLGL_GL_ENABLE_OPENGL2X
         void WriteResourceViewGL2XSampler(const ResourceViewDescriptor& desc, char* heapPtr, std::uint32_t index);
         #endif
@@ -157,6 +182,16 @@ class GLResourceHeap final : public ResourceHeap
         SegmentedBuffer                     heap_;                  // Buffer with resource binding information and stride (in bytes) per descriptor set
         GLbitfield                          barriers_       = 0;    // Bitmask for glMemoryBarrier
 
+        /* ----- Bindless textures ----- */
+
+        GLuint                              bindlessSlot_   = 0;
+        std::uint32_t                       numBindless_    = 0;    // Number of bindless texture handles per descriptor set
+        GLsizeiptr                          bindlessStride_ = 0;    // Aligned stride (in bytes) of bindless texture handles per descriptor set
+        SmallVector<std::uint32_t>          bindlessMap_;           // Maps a binding index to a bindless handle index.
+        std::vector<GLBindlessEntry>        bindlessEntries_;
+        std::vector<GLuint64>               bindlessHandles_;       // Handles as they are stored in the bindless buffer
+        std::unique_ptr<GLBuffer>           bindlessBuffer_;
+
 };
 
 
@@ -75,6 +75,7 @@ enum class GLBufferTarget
     DISPATCH_INDIRECT_BUFFER,
     DRAW_INDIRECT_BUFFER,
     ELEMENT_ARRAY_BUFFER,
+    PARAMETER_BUFFER,
     PIXEL_PACK_BUFFER,
     PIXEL_UNPACK_BUFFER,
     QUERY_BUFFER,
@@ -84,6 +84,7 @@ static const GLenum g_bufferTargetsEnum[] =
     GL_DISPATCH_INDIRECT_BUFFER,
     GL_DRAW_INDIRECT_BUFFER,
     GL_ELEMENT_ARRAY_BUFFER,
+    GL_PARAMETER_BUFFER,
     GL_PIXEL_PACK_BUFFER,
     GL_PIXEL_UNPACK_BUFFER,
     GL_QUERY_BUFFER,
@@ -150,7 +151,7 @@ static void InvalidateBoundGLObject(GLuint& boundId, const GLuint releasedObject
  * GLStateManager static members
  */
 
-GLStateManager*             GLStateManager::current_;
+thread_local GLStateManager* GLStateManager::current_;
 GLStateManager::GLLimits    GLStateManager::commonLimits_;
 
 struct GLStateManager::GLIntermediateBufferWriteMasks
@@ -643,18 +644,41 @@ void GLStateManager::SetPixelStoreUnpack(GLint rowLength, GLint imageHeight, GLi
 
 /* ----- Depth-stencil states ----- */
 
+// Bitmasks for the states that are pending until the next draw command
+enum GLPendingStateBits : std::uint32_t
+{
+    GLPendingDepthStencilState  = (1 << 0),
+    GLPendingRasterizerState    = (1 << 1),
+    GLPendingBlendState         = (1 << 2),
+};
+
 void GLStateManager::NotifyDepthStencilStateRelease(GLDepthStencilState* depthStencilState)
 {
     if (boundDepthStencilState_ == depthStencilState)
         boundDepthStencilState_ = nullptr;
+    if (pendingDepthStencilState_ == depthStencilState)
+    {
+        pendingDepthStencilState_ = nullptr;
+        pendingStates_ &= ~GLPendingDepthStencilState;
+    }
 }
 
 void GLStateManager::BindDepthStencilState(GLDepthStencilState* depthStencilState)
 {
-    if (depthStencilState != nullptr && depthStencilState != boundDepthStencilState_)
+    if (depthStencilState != nullptr)
     {
-        depthStencilState->Bind(*this);
-        boundDepthStencilState_ = depthStencilState;
+        if (depthStencilState != boundDepthStencilState_)
+        {
+            /* Defer binding until next draw command */
+            pendingDepthStencilState_ = depthStencilState;
+            pendingStates_ |= GLPendingDepthStencilState;
+        }
+        else
+        {
+            /* Discard previously pending state */
+            pendingDepthStencilState_ = nullptr;
+            pendingStates_ &= ~GLPendingDepthStencilState;
+        }
     }
 }
 
@@ -678,6 +702,7 @@ void GLStateManager::SetDepthMask(GLboolean flag)
 
 void GLStateManager::SetStencilRef(GLint ref, GLenum face)
 {
+    FlushPendingStates();
     if (boundDepthStencilState_ != nullptr)
         boundDepthStencilState_->BindStencilRefOnly(ref, face);
 }
@@ -691,22 +716,28 @@ void GLStateManager::NotifyRasterizerStateRelease(GLRasterizerState* rasterizerS
         boundRasterizerState_ = nullptr;
         frontFacingDirtyBit_ = false;
     }
+    if (pendingRasterizerState_ == rasterizerState)
+    {
+        pendingRasterizerState_ = nullptr;
+        pendingStates_ &= ~GLPendingRasterizerState;
+    }
 }
 
 void GLStateManager::BindRasterizerState(GLRasterizerState* rasterizerState)
 {
     if (rasterizerState != nullptr)
     {
-        if (rasterizerState != boundRasterizerState_)
+        if (rasterizerState != boundRasterizerState_ || frontFacingDirtyBit_)
         {
-            rasterizerState->Bind(*this);
-            boundRasterizerState_ = rasterizerState;
-            frontFacingDirtyBit_ = false;
+            /* Defer binding until next draw command */
+            pendingRasterizerState_ = rasterizerState;
+            pendingStates_ |= GLPendingRasterizerState;
         }
-        else if (frontFacingDirtyBit_)
+        else
         {
-            rasterizerState->BindFrontFaceOnly(*this);
-            frontFacingDirtyBit_ = false;
+            /* Discard previously pending state */
+            pendingRasterizerState_ = nullptr;
+            pendingStates_ &= ~GLPendingRasterizerState;
         }
     }
 }
@@ -717,19 +748,35 @@ void GLStateManager::NotifyBlendStateRelease(GLBlendState* blendState)
 {
     if (boundBlendState_ == blendState)
         boundBlendState_ = nullptr;
+    if (pendingBlendState_ == blendState)
+    {
+        pendingBlendState_ = nullptr;
+        pendingStates_ &= ~GLPendingBlendState;
+    }
 }
 
 void GLStateManager::BindBlendState(GLBlendState* blendState)
 {
-    if (blendState != nullptr && blendState != boundBlendState_)
+    if (blendState != nullptr)
     {
-        blendState->Bind(*this);
-        boundBlendState_ = blendState;
+        if (blendState != boundBlendState_)
+        {
+            /* Defer binding until next draw command */
+            pendingBlendState_ = blendState;
+            pendingStates_ |= GLPendingBlendState;
+        }
+        else
+        {
+            /* Discard previously pending state */
+            pendingBlendState_ = nullptr;
+            pendingStates_ &= ~GLPendingBlendState;
+        }
     }
 }
 
 void GLStateManager::SetBlendColor(const GLfloat* color)
 {
+    FlushPendingStates();
     if ( color[0] != contextState_.blendColor[0] ||
          color[1] != contextState_.blendColor[1] ||
          color[2] != contextState_.blendColor[2] ||
@@ -754,6 +801,51 @@ void GLStateManager::SetLogicOp(GLenum opcode)
     #endif
 }
 
+/* ----- Pending states ----- */
+
+void GLStateManager::FlushPendingStatesInternal()
+{
+    /* Reset pending bits first, since the states call back into this state manager */
+    const std::uint32_t pendingStates = pendingStates_;
+    pendingStates_ = 0;
+
+    if ((pendingStates & GLPendingDepthStencilState) != 0)
+    {
+        if (pendingDepthStencilState_ != boundDepthStencilState_)
+        {
+            pendingDepthStencilState_->Bind(*this);
+            boundDepthStencilState_ = pendingDepthStencilState_;
+        }
+        pendingDepthStencilState_ = nullptr;
+    }
+
+    if ((pendingStates & GLPendingRasterizerState) != 0)
+    {
+        if (pendingRasterizerState_ != boundRasterizerState_)
+        {
+            pendingRasterizerState_->Bind(*this);
+            boundRasterizerState_ = pendingRasterizerState_;
+            frontFacingDirtyBit_ = false;
+        }
+        else if (frontFacingDirtyBit_)
+        {
+            pendingRasterizerState_->BindFrontFaceOnly(*this);
+            frontFacingDirtyBit_ = false;
+        }
+        pendingRasterizerState_ = nullptr;
+    }
+
+    if ((pendingStates & GLPendingBlendState) != 0)
+    {
+        if (pendingBlendState_ != boundBlendState_)
+        {
+            pendingBlendState_->Bind(*this);
+            boundBlendState_ = pendingBlendState_;
+        }
+        pendingBlendState_ = nullptr;
+    }
+}
+
 /* ----- Buffer ----- */
 
 GLenum GLStateManager::ToGLBufferTarget(GLBufferTarget target)
@@ -855,7 +947,7 @@ void GLStateManager::BindBuffersRange(GLBufferTarget target, GLuint first, GLsiz
 
 void GLStateManager::UnbindBuffersBase(GLBufferTarget target, GLuint first, GLsizei count)
 {
-    BindBuffersBase(GLBufferTarget::UNIFORM_BUFFER, first, count, g_nullResources);
+    BindBuffersBase(target, first, count, g_nullResources);
 }
 
 // Returns the maximum index value for the specified index data type.
@@ -1013,6 +1105,7 @@ void GLStateManager::NotifyBufferRelease(const GLBuffer& buffer)
     {
         NotifyBufferRelease(id, GLBufferTarget::DRAW_INDIRECT_BUFFER);
         NotifyBufferRelease(id, GLBufferTarget::DISPATCH_INDIRECT_BUFFER);
+        NotifyBufferRelease(id, GLBufferTarget::PARAMETER_BUFFER);
     }
 
     NotifyBufferRelease(id, GLBufferTarget::COPY_READ_BUFFER);
@@ -1178,11 +1271,27 @@ void GLStateManager::BindTextures(GLuint first, GLsizei count, const GLTextureTa
     #ifdef GL_ARB_multi_bind
     if (HasExtension(GLExt::ARB_multi_bind))
     {
-        /* Store bound textures */
+        /* Store bound textures and skip the GL call if all textures are already bound */
+        bool isRedundant = true;
+
         for_range(i, count)
         {
-            auto targetIdx = static_cast<std::size_t>(targets[i]);
-            contextState_.textureLayers[i + first].boundTextures[targetIdx] = textures[i];
+            auto& boundTextures = contextState_.textureLayers[i + first].boundTextures;
+            if (textures[i] == 0)
+            {
+                /* A null texture resets all targets of this texture layer */
+                ::memset(boundTextures, 0, sizeof(boundTextures));
+                isRedundant = false;
+            }
+            else
+            {
+                auto& boundTexture = boundTextures[static_cast<std::size_t>(targets[i])];
+                if (boundTexture != textures[i])
+                {
+                    boundTexture = textures[i];
+                    isRedundant = false;
+                }
+            }
         }
 
         /*
@@ -1190,7 +1299,8 @@ void GLStateManager::BindTextures(GLuint first, GLsizei count, const GLTextureTa
         The spec. of GL_ARB_multi_bind states that the active texture slot is not modified by this function.
         see https://www.khronos.org/registry/OpenGL/extensions/ARB/ARB_multi_bind.txt
         */
-        glBindTextures(first, count, textures);
+        if (!isRedundant)
+            glBindTextures(first, count, textures);
     }
     else
     #endif
@@ -1212,7 +1322,7 @@ void GLStateManager::UnbindTextures(GLuint first, GLsizei count)
         /* Reset bound textures */
         for_range(i, count)
         {
-            auto& boundTextures = contextState_.textureLayers[i].boundTextures;
+            auto& boundTextures = contextState_.textureLayers[i + first].boundTextures;
             ::memset(boundTextures, 0, sizeof(boundTextures));
         }
 
@@ -1367,12 +1477,22 @@ void GLStateManager::BindSamplers(GLuint first, GLsizei count, const GLuint* sam
     #ifdef GL_ARB_multi_bind
     if (count >= 2 && HasExtension(GLExt::ARB_multi_bind))
     {
-        /* Store bound samplers */
+        /* Store bound samplers and skip the GL call if all samplers are already bound */
+        bool isRedundant = true;
+
         for_range(i, count)
-            contextState_.boundSamplers[i + first] = samplers[i];
+        {
+            auto& boundSampler = contextState_.boundSamplers[i + first];
+            if (boundSampler != samplers[i])
+            {
+                boundSampler = samplers[i];
+                isRedundant = false;
+            }
+        }
 
         /* Bind all samplers at once */
-        glBindSamplers(first, count, samplers);
+        if (!isRedundant)
+            glBindSamplers(first, count, samplers);
     }
     else
     #endif
@@ -1489,6 +1609,9 @@ void GLStateManager::BindRenderTarget(RenderTarget& renderTarget, GLStateManager
 
 void GLStateManager::Clear(long flags)
 {
+    /* Write masks are restored from the bound states, so apply pending states first */
+    FlushPendingStates();
+
     /* Setup GL clear mask and clear respective buffer */
     GLbitfield mask = 0;
     GLIntermediateBufferWriteMasks intermediateMasks;
@@ -1520,6 +1643,8 @@ void GLStateManager::Clear(long flags)
 
 void GLStateManager::ClearBuffers(std::uint32_t numAttachments, const AttachmentClear* attachments)
 {
+    FlushPendingStates();
+
     GLIntermediateBufferWriteMasks intermediateMasks;
 
     for (; numAttachments-- > 0; ++attachments)
@@ -1775,6 +1900,7 @@ void GLStateManager::RestoreWriteMasks(GLIntermediateBufferWriteMasks& intermedi
 
 void GLStateManager::BlitBoundRenderTarget()
 {
+    FlushPendingStates();
     if (auto renderTarget = GetBoundRenderTarget())
         renderTarget->BlitOntoFramebuffer();
 }
@@ -1800,6 +1926,8 @@ void GLStateManager::ClearAttachmentsWithRenderPass(
     std::uint32_t       numClearValues,
     const ClearValue*   clearValues)
 {
+    FlushPendingStates();
+
     const GLClearValue defaultClearValue;
     auto mask = renderPassGL.GetClearMask();
 
@@ -1861,6 +1989,72 @@ void GLStateManager::ClearAttachmentsWithRenderPass(
     RestoreWriteMasks(intermediateMasks);
 }
 
+void GLStateManager::InvalidateAttachmentsWithRenderPass(const GLRenderPass& renderPassGL)
+{
+    #ifdef LLGL_GLEXT_INVALIDATE_SUBDATA
+    const auto mask = renderPassGL.GetInvalidateMask();
+    if (mask == 0 || !HasExtension(GLExt::ARB_invalidate_subdata))
+        return;
+
+    GLenum attachments[LLGL_MAX_NUM_COLOR_ATTACHMENTS + 2];
+    GLsizei numAttachments = 0;
+
+    /* The default framebuffer has a different set of attachment names than FBOs */
+    const bool isDefaultFramebuffer = (GetBoundRenderTarget() == nullptr);
+
+    /* Append color attachments; the default framebuffer only has a single color buffer */
+    if ((mask & GL_COLOR_BUFFER_BIT) != 0)
+    {
+        const auto* colorAttachments = renderPassGL.GetInvalidateColorAttachments();
+        for (std::uint32_t i = 0; i < LLGL_MAX_NUM_COLOR_ATTACHMENTS && colorAttachments[i] != 0xFF; ++i)
+        {
+            if (!isDefaultFramebuffer)
+                attachments[numAttachments++] = (GL_COLOR_ATTACHMENT0 + colorAttachments[i]);
+            else if (colorAttachments[i] == 0)
+                attachments[numAttachments++] = GL_COLOR;
+        }
+    }
+
+    /* Append depth and stencil attachments */
+    if ((mask & GL_DEPTH_BUFFER_BIT) != 0)
+        attachments[numAttachments++] = (isDefaultFramebuffer ? GL_DEPTH : GL_DEPTH_ATTACHMENT);
+    if ((mask & GL_STENCIL_BUFFER_BIT) != 0)
+        attachments[numAttachments++] = (isDefaultFramebuffer ? GL_STENCIL : GL_STENCIL_ATTACHMENT);
+
+    /* Let the driver discard the attachment contents instead of writing them back to memory, which is expensive on tile-based GPUs */
+    if (numAttachments > 0)
+        glInvalidateFramebuffer(GL_DRAW_FRAMEBUFFER, numAttachments, attachments);
+    #endif // /LLGL_GLEXT_INVALIDATE_SUBDATA
+}
+
+void GLStateManager::BindSubpass(const GLRenderPass* renderPassGL, std::uint32_t subpass)
+{
+    /* Sub-passes can only select draw buffers of FBOs; the default framebuffer only has a single color buffer */
+    if (boundRenderTarget_ == nullptr)
+        return;
+
+    if (renderPassGL != nullptr)
+    {
+        std::uint32_t drawBufferMask = renderPassGL->GetSubpassColorAttachments(subpass);
+        if (HasExtension(GLExt::EXT_shader_framebuffer_fetch))
+        {
+            /* Input attachments remain draw buffers, so they can be read in place via framebuffer fetch */
+            drawBufferMask |= renderPassGL->GetSubpassInputAttachments(subpass);
+        }
+        else
+        {
+            #ifdef LLGL_GLEXT_TEXTURE_BARRIER
+            /* Make attachment writes of the previous sub-pass visible to texture fetches of the next sub-pass */
+            if (subpass > 0 && HasExtension(GLExt::ARB_texture_barrier))
+                glTextureBarrier();
+            #endif // /LLGL_GLEXT_TEXTURE_BARRIER
+        }
+        boundRenderTarget_->SetDrawBuffers(drawBufferMask);
+    }
+    else
+        boundRenderTarget_->SetDrawBuffers();
+}
+
 std::uint32_t GLStateManager::ClearColorBuffers(
     const std::uint8_t*             colorBuffers,
     std::uint32_t                   numClearValues,
@@ -161,6 +161,15 @@ class GLStateManager
         void SetBlendColor(const GLfloat* color);
         void SetLogicOp(GLenum opcode);
 
+        /* ----- Pending states ----- */
+
+        // Applies the depth-stencil, rasterizer, and blend states that have been bound since the last draw command.
+        inline void FlushPendingStates()
+        {
+            if (pendingStates_ != 0)
+                FlushPendingStatesInternal();
+        }
+
         /* ----- Buffer ----- */
 
         static GLenum ToGLBufferTarget(GLBufferTarget target);
@@ -237,6 +246,9 @@ class GLStateManager
 
         void DeleteTexture(GLuint texture, GLTextureTarget target, bool activeLayerOnly = false);
 
+        // Invalidates the bindings of the specified texture without deleting it, e.g. for textures that are owned by the client.
+        void NotifyTextureRelease(GLuint texture, GLTextureTarget target, bool activeLayerOnly = false);
+
         /* ----- Sampler ----- */
 
         void BindSampler(GLuint layer, GLuint sampler);
@@ -278,6 +290,15 @@ class GLStateManager
             const ClearValue*   clearValues
         );
 
+        // Invalidates all attachments of the bound framebuffer whose store operation is AttachmentStoreOp::Undefined in the specified render pass.
+        void InvalidateAttachmentsWithRenderPass(const GLRenderPass& renderPassGL);
+
+        /*
+        Binds the draw buffers of the specified sub-pass for the bound render target.
+        If 'renderPassGL' is null, all draw buffers of the bound render target are restored.
+        */
+        void BindSubpass(const GLRenderPass* renderPassGL, std::uint32_t subpass);
+
         void Clear(long flags);
         void ClearBuffers(std::uint32_t numAttachments, const AttachmentClear* attachments);
 
@@ -301,6 +322,8 @@ class GLStateManager
 
     private:
 
+        void FlushPendingStatesInternal();
+
         bool NeedsAdjustedViewport() const;
 
         void AdjustViewport(GLViewport& outViewport, const GLViewport& inViewport);
@@ -310,7 +333,6 @@ class GLStateManager
         void AssertExtViewportArray();
 
         GLContextState::TextureLayer* GetActiveTextureLayer();
-        void NotifyTextureRelease(GLuint texture, GLTextureTarget target, bool activeLayerOnly);
 
         void SetFrontFaceInternal(GLenum mode);
         void FlipFrontFacing(bool isFlipped);
@@ -384,8 +406,8 @@ class GLStateManager
 
     private:
 
-        static GLStateManager*  current_;
-        static GLLimits         commonLimits_;          // Common denominator of limitations for all GL contexts
+        static thread_local GLStateManager* current_;          // Current state manager of the calling thread (see GLUploadContext)
+        static GLLimits                     commonLimits_;      // Common denominator of limitations for all GL contexts
 
     private:
 
@@ -415,6 +437,11 @@ class GLStateManager
         GLRasterizerState*                  boundRasterizerState_       = nullptr;
         GLBlendState*                       boundBlendState_            = nullptr;
 
+        GLDepthStencilState*                pendingDepthStencilState_   = nullptr;
+        GLRasterizerState*                  pendingRasterizerState_     = nullptr;
+        GLBlendState*                       pendingBlendState_          = nullptr;
+        std::uint32_t                       pendingStates_              = 0;
+
         bool                                frontFacingDirtyBit_        = false;
 
         std::stack<CapabilityStackEntry>    capabilitiesStack_;
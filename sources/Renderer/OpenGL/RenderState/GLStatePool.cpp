@@ -9,6 +9,7 @@
 #include "GLStateManager.h"
 #include "../Ext/GLExtensionRegistry.h"
 #include "../../../Core/ContainerUtils.h"
+#include "../../CheckedCast.h"
 #include <functional>
 
 #include "../Shader/GLLegacyShader.h"
@@ -48,11 +49,9 @@ std::shared_ptr<T> FindCompatibleStateObject(
 }
 
 template <typename T, typename TCompare, typename TBase, typename... Args>
-std::shared_ptr<T> CreateRenderStateObjectExt(std::vector<std::shared_ptr<TBase>>& container, Args&&... args)
+std::shared_ptr<T> CreateRenderStateObjectWithCompare(std::vector<std::shared_ptr<TBase>>& container, const TCompare& stateToCompare, Args&&... args)
 {
     /* Try to find render state object with same parameter */
-    const TCompare stateToCompare{ std::forward<Args>(args)... };
-
     std::size_t insertionIndex = 0;
     if (auto sharedState = FindCompatibleStateObject<T, TCompare, TBase>(container, stateToCompare, insertionIndex))
         return sharedState;
@@ -64,6 +63,13 @@ std::shared_ptr<T> CreateRenderStateObjectExt(std::vector<std::shared_ptr<TBase>
     return newState;
 }
 
+template <typename T, typename TCompare, typename TBase, typename... Args>
+std::shared_ptr<T> CreateRenderStateObjectExt(std::vector<std::shared_ptr<TBase>>& container, Args&&... args)
+{
+    const TCompare stateToCompare{ args... };
+    return CreateRenderStateObjectWithCompare<T, TCompare, TBase>(container, stateToCompare, std::forward<Args>(args)...);
+}
+
 template <typename T, typename... Args>
 std::shared_ptr<T> CreateRenderStateObject(std::vector<std::shared_ptr<T>>& container, Args&&... args)
 {
@@ -122,6 +128,7 @@ void GLStatePool::Clear()
     rasterizerStates_.clear();
     blendStates_.clear();
     shaderBindingLayouts_.clear();
+    vertexArrayFormats_.clear();
 }
 
 /* ----- Depth-stencil states ----- */
@@ -207,7 +214,7 @@ static bool HasGLSeparableShaders(std::size_t numShaders, Shader* const* shaders
     return (numShaders > 0 && IsGLSeparableShader(shaders[0]));
 }
 
-GLShaderPipelineSPtr GLStatePool::CreateShaderPipeline(std::size_t numShaders, Shader* const* shaders)
+GLShaderPipelineSPtr GLStatePool::CreateShaderPipeline(std::size_t numShaders, Shader* const* shaders, const GLProgramBinary* cachedBinary)
 {
     #ifdef LLGL_OPENGL
     if (HasExtension(GLExt::ARB_separate_shader_objects) && HasGLSeparableShaders(numShaders, shaders))
@@ -219,8 +226,10 @@ GLShaderPipelineSPtr GLStatePool::CreateShaderPipeline(std::size_t numShaders, S
     else
     #endif
     {
+        /* Program binaries only apply to newly linked programs; compatible programs are shared regardless */
+        const GLPipelineSignature signature{ numShaders, shaders };
         return std::static_pointer_cast<GLShaderPipeline>(
-            CreateRenderStateObjectExt<GLShaderProgram, GLPipelineSignature>(shaderPipelines_, numShaders, shaders)
+            CreateRenderStateObjectWithCompare<GLShaderProgram, GLPipelineSignature>(shaderPipelines_, signature, numShaders, shaders, cachedBinary)
         );
     }
 }
@@ -234,6 +243,22 @@ void GLStatePool::ReleaseShaderPipeline(GLShaderPipelineSPtr&& shaderPipeline)
     );
 }
 
+/* ----- Vertex array formats ----- */
+
+GLVertexArrayFormatSPtr GLStatePool::CreateVertexArrayFormat(const GLVertexArrayFormat::AttributeList& attribs)
+{
+    return CreateRenderStateObjectWithCompare<GLVertexArrayFormat, GLVertexArrayFormat::AttributeList, GLVertexArrayFormat>(vertexArrayFormats_, attribs, attribs);
+}
+
+void GLStatePool::ReleaseVertexArrayFormat(GLVertexArrayFormatSPtr&& vertexArrayFormat)
+{
+    ReleaseRenderStateObject<GLVertexArrayFormat>(
+        vertexArrayFormats_,
+        nullptr,
+        std::forward<GLVertexArrayFormatSPtr>(vertexArrayFormat)
+    );
+}
+
 
 } // /namespace LLGL
 
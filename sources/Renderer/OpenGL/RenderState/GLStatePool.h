@@ -16,6 +16,7 @@
 #include "GLPipelineLayout.h"
 #include "../Shader/GLShaderBindingLayout.h"
 #include "../Shader/GLShaderPipeline.h"
+#include "../Buffer/GLVertexArrayFormat.h"
 #include <vector>
 
 
@@ -66,9 +67,16 @@ class GLStatePool
 
         /* ----- Shader pipelines ----- */
 
-        GLShaderPipelineSPtr CreateShaderPipeline(std::size_t numShaders, Shader* const* shaders);
+        // Creates a shader pipeline or returns a compatible one. If 'cachedBinary' is non-null, a new shader program is loaded from that binary if possible.
+        GLShaderPipelineSPtr CreateShaderPipeline(std::size_t numShaders, Shader* const* shaders, const GLProgramBinary* cachedBinary = nullptr);
         void ReleaseShaderPipeline(GLShaderPipelineSPtr&& shaderPipeline);
 
+        /* ----- Vertex array formats ----- */
+
+        // Creates a VAO for the specified vertex attribute formats or returns a compatible one (for GL_ARB_vertex_attrib_binding).
+        GLVertexArrayFormatSPtr CreateVertexArrayFormat(const GLVertexArrayFormat::AttributeList& attribs);
+        void ReleaseVertexArrayFormat(GLVertexArrayFormatSPtr&& vertexArrayFormat);
+
     private:
 
         GLStatePool() = default;
@@ -80,6 +88,7 @@ class GLStatePool
         std::vector<GLBlendStateSPtr>           blendStates_;
         std::vector<GLShaderBindingLayoutSPtr>  shaderBindingLayouts_;
         std::vector<GLShaderPipelineSPtr>       shaderPipelines_;
+        std::vector<GLVertexArrayFormatSPtr>    vertexArrayFormats_;
 
 };
 
@@ -12,6 +12,7 @@
 #include "../GLTypes.h"
 #include "../GLObjectUtils.h"
 #include "../../../Core/Exception.h"
+#include "../../../Core/Helper.h"
 
 
 namespace LLGL
@@ -26,10 +27,7 @@ GLLegacyShader::GLLegacyShader(const ShaderDescriptor& desc) :
     BuildShader(desc);
 
     /* Query compile status and log */
-    ReportStatusAndLog(
-        GLLegacyShader::GetCompileStatus(GetID()),
-        GLLegacyShader::GetGLShaderLog(GetID())
-    );
+    ReportStatusAndLog();
 }
 
 GLLegacyShader::~GLLegacyShader()
@@ -64,6 +62,19 @@ bool GLLegacyShader::GetCompileStatus(GLuint shader)
     return (status != GL_FALSE);
 }
 
+bool GLLegacyShader::GetCompletionStatus(GLuint shader)
+{
+    #ifdef LLGL_GLEXT_PARALLEL_SHADER_COMPILE
+    if (GLShader::HasParallelCompile())
+    {
+        GLint status = 0;
+        glGetShaderiv(shader, GL_COMPLETION_STATUS_KHR, &status);
+        return (status != GL_FALSE);
+    }
+    #endif // /LLGL_GLEXT_PARALLEL_SHADER_COMPILE
+    return true;
+}
+
 std::string GLLegacyShader::GetGLShaderLog(GLuint shader)
 {
     /* Query info log length */
@@ -88,6 +99,17 @@ std::string GLLegacyShader::GetGLShaderLog(GLuint shader)
 }
 
 
+/*
+ * ======= Protected: =======
+ */
+
+void GLLegacyShader::QueryStatusAndLog(bool& status, std::string& log) const
+{
+    status  = GLLegacyShader::GetCompileStatus(GetID());
+    log     = GLLegacyShader::GetGLShaderLog(GetID());
+}
+
+
 /*
  * ======= Private: =======
  */
@@ -30,6 +30,10 @@ class GLLegacyShader final : public GLShader
         GLLegacyShader(const ShaderDescriptor& desc);
         ~GLLegacyShader();
 
+    protected:
+
+        void QueryStatusAndLog(bool& status, std::string& log) const override;
+
     public:
 
         // Compiles a native GL shader from source.
@@ -38,6 +42,9 @@ class GLLegacyShader final : public GLShader
         // Returns true if the native GL shader was compiled successfully.
         static bool GetCompileStatus(GLuint shader);
 
+        // Returns true if the native GL shader has finished compiling. This never blocks and always returns true without parallel shader compilation.
+        static bool GetCompletionStatus(GLuint shader);
+
         // Returns the native GL shader log.
         static std::string GetGLShaderLog(GLuint shader);
 
@@ -8,6 +8,7 @@
 #include "GLPipelineSignature.h"
 #include "GLShader.h"
 #include "../../../Core/HelperMacros.h"
+#include "../../CheckedCast.h"
 #include <LLGL/Misc/ForRange.h>
 #include <LLGL/Misc/TypeNames.h>
 #include <stdexcept>
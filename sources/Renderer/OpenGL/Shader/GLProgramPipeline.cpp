@@ -8,6 +8,7 @@
 #include "GLProgramPipeline.h"
 #include "GLShaderBindingLayout.h"
 #include "GLSeparableShader.h"
+#include "GLShaderProgram.h"
 #include "../Ext/GLExtensions.h"
 #include "../Ext/GLExtensionRegistry.h"
 #include "../RenderState/GLStateManager.h"
@@ -92,6 +93,17 @@ void GLProgramPipeline::QueryInfoLogs(BasicReport& report)
     report.Reset(std::move(log), hasErrors);
 }
 
+bool GLProgramPipeline::IsLinkCompleted() const
+{
+    /* Separable shaders are linked individually, so the pipeline is complete once all of its programs are */
+    for_range(i, GetSignature().GetNumShaders())
+    {
+        if (separableShaders_[i] != nullptr && !GLShaderProgram::GetCompletionStatus(separableShaders_[i]->GetID()))
+            return false;
+    }
+    return true;
+}
+
 
 /*
  * ======= Private: =======
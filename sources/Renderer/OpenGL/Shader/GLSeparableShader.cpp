@@ -65,10 +65,7 @@ GLSeparableShader::GLSeparableShader(const ShaderDescriptor& desc) :
     glDetachShader(GetID(), intermediateShader.GetID());
 
     /* Query link status and log */
-    ReportStatusAndLog(
-        GLShaderProgram::GetLinkStatus(GetID()),
-        GLShaderProgram::GetGLProgramLog(GetID())
-    );
+    ReportStatusAndLog();
 }
 
 GLSeparableShader::~GLSeparableShader()
@@ -104,6 +101,17 @@ void GLSeparableShader::QueryInfoLog(std::string& text, bool& hasErrors)
 }
 
 
+/*
+ * ======= Protected: =======
+ */
+
+void GLSeparableShader::QueryStatusAndLog(bool& status, std::string& log) const
+{
+    status  = GLShaderProgram::GetLinkStatus(GetID());
+    log     = GLShaderProgram::GetGLProgramLog(GetID());
+}
+
+
 } // /namespace LLGL
 
 
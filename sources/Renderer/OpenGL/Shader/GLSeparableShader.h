@@ -39,6 +39,10 @@ class GLSeparableShader final : public GLShader
         // Queries the program info log and appends it to the output text.
         void QueryInfoLog(std::string& text, bool& hasErrors);
 
+    protected:
+
+        void QueryStatusAndLog(bool& status, std::string& log) const override;
+
     private:
 
         const GLShaderBindingLayout* bindingLayout_ = nullptr;
@@ -35,6 +35,15 @@ GLShader::GLShader(const bool isSeparable, const ShaderDescriptor& desc) :
 
 const Report* GLShader::GetReport() const
 {
+    if (isReportDeferred_)
+    {
+        /* Query deferred status and log on first access */
+        bool status = false;
+        std::string log;
+        QueryStatusAndLog(status, log);
+        report_.Reset(log, !status);
+        isReportDeferred_ = false;
+    }
     return (report_ ? &report_ : nullptr);
 }
 
@@ -118,9 +127,21 @@ void GLShader::PatchShaderSourceWithOptions(
     }
 }
 
-void GLShader::ReportStatusAndLog(bool status, const std::string& log)
+bool GLShader::HasParallelCompile()
+{
+    #ifdef LLGL_GLEXT_PARALLEL_SHADER_COMPILE
+    return HasExtension(GLExt::KHR_parallel_shader_compile);
+    #else
+    return false;
+    #endif
+}
+
+void GLShader::ReportStatusAndLog()
 {
-    report_.Reset(log, !status);
+    /* Don't query the status now as that would wait for the driver's compiler threads */
+    isReportDeferred_ = true;
+    if (!GLShader::HasParallelCompile())
+        GetReport();
 }
 
 
@@ -130,28 +151,16 @@ void GLShader::ReportStatusAndLog(bool status, const std::string& log)
 
 void GLShader::ReserveAttribs(const ShaderDescriptor& desc)
 {
-    /* Reset attributes and their name storage */
+    /* Reset attributes; their names are interned, so they don't need any storage in this shader */
     shaderAttribs_.clear();
-    shaderAttribNames_.Clear();
 
-    /* Reserve names for vertex attributs */
+    /* Count vertex attributes (matrices only use the 1st column) */
     for (const auto& attr : desc.vertex.inputAttribs)
     {
         if (attr.semanticIndex == 0)
-        {
-            shaderAttribNames_.Reserve(attr.name.size());
             ++numVertexAttribs_;
-        }
     }
 
-    /* Reserve names for transform feedback varyings */
-    for (const auto& attr : desc.vertex.outputAttribs)
-        shaderAttribNames_.Reserve(attr.name.size());
-
-    /* Reserve names for fragment output attributes */
-    for (const auto& attr : desc.fragment.outputAttribs)
-        shaderAttribNames_.Reserve(attr.name.size());
-
     /* Reserve memory for vertex input and fragment output attributes */
     shaderAttribs_.reserve(numVertexAttribs_ + desc.fragment.outputAttribs.size());
 }
@@ -188,7 +197,7 @@ void GLShader::BuildVertexInputLayout(std::size_t numVertexAttribs, const Vertex
         /* Store attribute meta data (matrices only use the 1st column) */
         const auto& attr = vertexAttribs[i];
         if (attr.semanticIndex == 0)
-            shaderAttribs_.push_back({ attr.location, shaderAttribNames_.CopyString(attr.name) });
+            shaderAttribs_.push_back({ attr.location, InternString(attr.name).data() });
     }
 }
 
@@ -202,7 +211,7 @@ void GLShader::BuildFragmentOutputLayout(std::size_t numFragmentAttribs, const F
     {
         /* Store attribute meta data (matrices only use the 1st column) */
         const auto& attr = fragmentAttribs[i];
-        shaderAttribs_.push_back({ attr.location, shaderAttribNames_.CopyString(attr.name) });
+        shaderAttribs_.push_back({ attr.location, InternString(attr.name).data() });
     }
 }
 
@@ -212,7 +221,7 @@ void GLShader::BuildTransformFeedbackVaryings(std::size_t numVaryings, const Ver
     {
         transformFeedbackVaryings_.reserve(numVaryings);
         for_range(i, numVaryings)
-            transformFeedbackVaryings_.push_back(shaderAttribNames_.CopyString(varyings[i].name));
+            transformFeedbackVaryings_.push_back(InternString(varyings[i].name).data());
     }
 }
 
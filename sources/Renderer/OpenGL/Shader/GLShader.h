@@ -12,7 +12,7 @@
 #include <LLGL/Shader.h>
 #include "../OpenGL.h"
 #include "../../../Core/BasicReport.h"
-#include "../../../Core/LinearStringContainer.h"
+#include "../../../Core/StringInterner.h"
 #include <functional>
 
 
@@ -81,12 +81,21 @@ class GLShader : public Shader
             const char*                 vertexTransformStmt = nullptr
         );
 
+        // Returns true if the driver compiles and links shaders in parallel (GL_KHR_parallel_shader_compile), so status queries should be deferred.
+        static bool HasParallelCompile();
+
     protected:
 
         GLShader(const bool isSeparable, const ShaderDescriptor& desc);
 
-        // Resets the report with the specified compile/link status and log.
-        void ReportStatusAndLog(bool status, const std::string& log);
+        /*
+        Resets the report with the compile/link status and log of the native object.
+        With parallel shader compilation, the query is deferred until the report is accessed for the first time.
+        */
+        void ReportStatusAndLog();
+
+        // Queries the compile/link status and log of the native object. This blocks until the driver has finished compiling.
+        virtual void QueryStatusAndLog(bool& status, std::string& log) const = 0;
 
         // Stores the native shader ID.
         inline void SetID(GLuint id)
@@ -105,11 +114,11 @@ class GLShader : public Shader
 
         const bool                      isSeparable_;
         GLuint                          id_                         = 0; // ID from either glCreateShader or glCreateShaderProgramv
-        LinearStringContainer           shaderAttribNames_;
         std::vector<GLShaderAttribute>  shaderAttribs_;
         std::size_t                     numVertexAttribs_           = 0;
         std::vector<const char*>        transformFeedbackVaryings_;
-        BasicReport                     report_;
+        mutable BasicReport             report_;
+        mutable bool                    isReportDeferred_           = false;
 
 };
 
@@ -10,6 +10,7 @@
 #include "../Ext/GLExtensions.h"
 #include "../RenderState/GLStateManager.h"
 #include "../../../Core/HelperMacros.h"
+#include "../../../Core/StringInterner.h"
 #include <LLGL/Misc/ForRange.h>
 
 
@@ -26,7 +27,7 @@ GLShaderBindingLayout::GLShaderBindingLayout(const GLPipelineLayout& pipelineLay
         {
             if (binding.type == ResourceType::Sampler || binding.type == ResourceType::Texture)
             {
-                bindings_.push_back({ binding.name, binding.slot });
+                bindings_.push_back({ InternString(binding.name).data(), binding.slot });
                 ++numUniformBindings_;
             }
         }
@@ -39,7 +40,7 @@ GLShaderBindingLayout::GLShaderBindingLayout(const GLPipelineLayout& pipelineLay
         {
             if (binding.type == ResourceType::Buffer && (binding.bindFlags & BindFlags::ConstantBuffer) != 0)
             {
-                bindings_.push_back({ binding.name, binding.slot });
+                bindings_.push_back({ InternString(binding.name).data(), binding.slot });
                 ++numUniformBlockBindings_;
             }
         }
@@ -52,7 +53,7 @@ GLShaderBindingLayout::GLShaderBindingLayout(const GLPipelineLayout& pipelineLay
         {
             if (binding.type == ResourceType::Buffer && (binding.bindFlags & (BindFlags::Storage | BindFlags::Sampled)) != 0)
             {
-                bindings_.push_back({ binding.name, binding.slot });
+                bindings_.push_back({ InternString(binding.name).data(), binding.slot });
                 ++numShaderStorageBindings_;
             }
         }
@@ -70,7 +71,7 @@ void GLShaderBindingLayout::UniformAndBlockBinding(GLuint program, GLStateManage
         for_range(i, numUniformBindings_)
         {
             const auto& resource = bindings_[resourceIndex++];
-            auto blockIndex = glGetUniformLocation(program, resource.name.c_str());
+            auto blockIndex = glGetUniformLocation(program, resource.name);
             if (blockIndex != GL_INVALID_INDEX)
                 glProgramUniform1i(program, blockIndex, static_cast<GLint>(resource.slot));
         }
@@ -85,7 +86,7 @@ void GLShaderBindingLayout::UniformAndBlockBinding(GLuint program, GLStateManage
             for_range(i, numUniformBindings_)
             {
                 const auto& resource = bindings_[resourceIndex++];
-                auto blockIndex = glGetUniformLocation(program, resource.name.c_str());
+                auto blockIndex = glGetUniformLocation(program, resource.name);
                 if (blockIndex != GL_INVALID_INDEX)
                     glUniform1i(blockIndex, static_cast<GLint>(resource.slot));
             }
@@ -97,7 +98,7 @@ void GLShaderBindingLayout::UniformAndBlockBinding(GLuint program, GLStateManage
         for_range(i, numUniformBindings_)
         {
             const auto& resource = bindings_[resourceIndex++];
-            auto blockIndex = glGetUniformLocation(program, resource.name.c_str());
+            auto blockIndex = glGetUniformLocation(program, resource.name);
             if (blockIndex != GL_INVALID_INDEX)
                 glUniform1i(blockIndex, static_cast<GLint>(resource.slot));
         }
@@ -107,7 +108,7 @@ void GLShaderBindingLayout::UniformAndBlockBinding(GLuint program, GLStateManage
     for_range(i, numUniformBlockBindings_)
     {
         const auto& resource = bindings_[resourceIndex++];
-        auto blockIndex = glGetUniformBlockIndex(program, resource.name.c_str());
+        auto blockIndex = glGetUniformBlockIndex(program, resource.name);
         if (blockIndex != GL_INVALID_INDEX)
             glUniformBlockBinding(program, blockIndex, resource.slot);
     }
@@ -117,7 +118,7 @@ void GLShaderBindingLayout::UniformAndBlockBinding(GLuint program, GLStateManage
     for_range(i, numShaderStorageBindings_)
     {
         const auto& resource = bindings_[resourceIndex++];
-        auto blockIndex = glGetProgramResourceIndex(program, GL_SHADER_STORAGE_BLOCK, resource.name.c_str());
+        auto blockIndex = glGetProgramResourceIndex(program, GL_SHADER_STORAGE_BLOCK, resource.name);
         if (blockIndex != GL_INVALID_INDEX)
             glShaderStorageBlockBinding(program, blockIndex, resource.slot);
     }
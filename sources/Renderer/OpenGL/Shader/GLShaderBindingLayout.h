@@ -53,7 +53,7 @@ class GLShaderBindingLayout
 
         struct ResourceBinding
         {
-            std::string     name;
+            const char*     name; // Interned string, so bindings can be compared by their name pointers
             std::uint32_t   slot;
         };
 
@@ -20,6 +20,11 @@ GLShaderPipeline::GLShaderPipeline(GLuint id) :
 {
 }
 
+bool GLShaderPipeline::GetProgramBinary(GLProgramBinary& /*outBinary*/) const
+{
+    return false;
+}
+
 void GLShaderPipeline::BuildSignature(std::size_t numShaders, const Shader* const* shaders)
 {
     signature_.Build(numShaders, shaders);
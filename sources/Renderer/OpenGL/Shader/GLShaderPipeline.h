@@ -11,6 +11,7 @@
 
 #include "GLPipelineSignature.h"
 #include <memory>
+#include <vector>
 
 
 namespace LLGL
@@ -24,6 +25,13 @@ class BasicReport;
 
 using GLShaderPipelineSPtr = std::shared_ptr<GLShaderPipeline>;
 
+// Native program binary as retrieved by glGetProgramBinary.
+struct GLProgramBinary
+{
+    GLenum              format  = 0;
+    std::vector<char>   data;
+};
+
 // Base class of GLShaderProgram (for legacy shaders) and GLProgramPipeline (for separable shaders).
 class GLShaderPipeline
 {
@@ -41,6 +49,12 @@ class GLShaderPipeline
         // Adds the shader info logs to the output report.
         virtual void QueryInfoLogs(BasicReport& report) = 0;
 
+        // Returns true if the driver has finished linking this pipeline. This never blocks.
+        virtual bool IsLinkCompleted() const = 0;
+
+        // Retrieves the native program binary. Returns false if this shader pipeline does not support program binaries.
+        virtual bool GetProgramBinary(GLProgramBinary& outBinary) const;
+
         // Returns the native pipeline ID. Can be either from glCreateProgramPipelines or glCreateProgram.
         inline GLuint GetID() const
         {
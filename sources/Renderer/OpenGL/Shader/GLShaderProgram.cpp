@@ -21,6 +21,7 @@
 #include <LLGL/Misc/ForRange.h>
 #include <vector>
 #include <stdexcept>
+#include <algorithm>
 
 
 namespace LLGL
@@ -114,9 +115,24 @@ static void AttachGLLegacyShader(GLuint program, const Shader* shader, GLOrdered
     }
 }
 
-GLShaderProgram::GLShaderProgram(std::size_t numShaders, const Shader* const* shaders) :
+GLShaderProgram::GLShaderProgram(std::size_t numShaders, const Shader* const* shaders, const GLProgramBinary* cachedBinary) :
     GLShaderPipeline { glCreateProgram() }
 {
+    /* Build pipeline signature */
+    BuildSignature(numShaders, shaders);
+
+    #ifdef LLGL_GLEXT_GET_PROGRAM_BINARY
+    if (cachedBinary != nullptr && HasExtension(GLExt::ARB_get_program_binary))
+    {
+        /* Skip linking if the cached program binary is accepted by the driver */
+        if (GLShaderProgram::LoadProgramBinary(GetID(), *cachedBinary))
+            return;
+
+        /* Allow program binary to be retrieved after linking */
+        glProgramParameteri(GetID(), GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    #endif // /LLGL_GLEXT_GET_PROGRAM_BINARY
+
     /* Attach all specified shaders to this shader program */
     GLOrderedShaders orderedShaders;
     for_range(i, numShaders)
@@ -169,9 +185,6 @@ GLShaderProgram::GLShaderProgram(std::size_t numShaders, const Shader* const* sh
     }
     else
         GLShaderProgram::LinkProgram(GetID());
-
-    /* Build pipeline signature */
-    BuildSignature(numShaders, shaders);
 }
 
 GLShaderProgram::~GLShaderProgram()
@@ -205,6 +218,34 @@ void GLShaderProgram::QueryInfoLogs(BasicReport& report)
     report.Reset(std::move(log), hasErrors);
 }
 
+bool GLShaderProgram::IsLinkCompleted() const
+{
+    return GLShaderProgram::GetCompletionStatus(GetID());
+}
+
+bool GLShaderProgram::GetProgramBinary(GLProgramBinary& outBinary) const
+{
+    #ifdef LLGL_GLEXT_GET_PROGRAM_BINARY
+    if (HasExtension(GLExt::ARB_get_program_binary) && GLShaderProgram::GetLinkStatus(GetID()))
+    {
+        /* Query program binary length */
+        GLint binaryLength = 0;
+        glGetProgramiv(GetID(), GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+
+        if (binaryLength > 0)
+        {
+            /* Retrieve program binary and its driver-specific format */
+            GLsizei bytesWritten = 0;
+            outBinary.data.resize(static_cast<std::size_t>(binaryLength));
+            glGetProgramBinary(GetID(), binaryLength, &bytesWritten, &(outBinary.format), outBinary.data.data());
+            outBinary.data.resize(static_cast<std::size_t>(bytesWritten));
+            return (bytesWritten > 0);
+        }
+    }
+    #endif // /LLGL_GLEXT_GET_PROGRAM_BINARY
+    return false;
+}
+
 bool GLShaderProgram::GetLinkStatus(GLuint program)
 {
     GLint status = 0;
@@ -212,6 +253,19 @@ bool GLShaderProgram::GetLinkStatus(GLuint program)
     return (status != GL_FALSE);
 }
 
+bool GLShaderProgram::GetCompletionStatus(GLuint program)
+{
+    #ifdef LLGL_GLEXT_PARALLEL_SHADER_COMPILE
+    if (GLShader::HasParallelCompile())
+    {
+        GLint status = 0;
+        glGetProgramiv(program, GL_COMPLETION_STATUS_KHR, &status);
+        return (status != GL_FALSE);
+    }
+    #endif // /LLGL_GLEXT_PARALLEL_SHADER_COMPILE
+    return true;
+}
+
 std::string GLShaderProgram::GetGLProgramLog(GLuint program)
 {
     /* Query info log length */
@@ -305,6 +359,32 @@ static void BuildTransformFeedbackVaryingsNV(GLuint program, std::size_t numVary
 
 #endif
 
+bool GLShaderProgram::LoadProgramBinary(GLuint program, const GLProgramBinary& binary)
+{
+    #ifdef LLGL_GLEXT_GET_PROGRAM_BINARY
+    if (!binary.data.empty())
+    {
+        /* Only load binary in a format the driver supports, otherwise glProgramBinary generates GL_INVALID_ENUM */
+        GLint numFormats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+
+        if (numFormats > 0)
+        {
+            std::vector<GLint> formats(static_cast<std::size_t>(numFormats));
+            glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, formats.data());
+
+            if (std::find(formats.begin(), formats.end(), static_cast<GLint>(binary.format)) != formats.end())
+            {
+                /* Driver might still reject the binary, e.g. after a driver update, in which case the link status is GL_FALSE */
+                glProgramBinary(program, binary.format, binary.data.data(), static_cast<GLsizei>(binary.data.size()));
+                return GLShaderProgram::GetLinkStatus(program);
+            }
+        }
+    }
+    #endif // /LLGL_GLEXT_GET_PROGRAM_BINARY
+    return false;
+}
+
 void GLShaderProgram::LinkProgramWithTransformFeedbackVaryings(GLuint program, std::size_t numVaryings, const char* const* varyings)
 {
     /* Check if transform-feedback varyings must be specified (before or after shader linking) */
@@ -29,10 +29,16 @@ class GLShaderProgram final : public GLShaderPipeline
         void Bind(GLStateManager& stateMngr) override;
         void BindResourceSlots(const GLShaderBindingLayout& bindingLayout) override;
         void QueryInfoLogs(BasicReport& report) override;
+        bool IsLinkCompleted() const override;
+        bool GetProgramBinary(GLProgramBinary& outBinary) const override;
 
     public:
 
-        GLShaderProgram(std::size_t numShaders, const Shader* const* shaders);
+        /*
+        Links the specified shaders into a new program. If 'cachedBinary' is non-null, the program is first loaded from that binary
+        and only linked from the shaders if the binary was rejected by the driver; the program binary will also be retrievable.
+        */
+        GLShaderProgram(std::size_t numShaders, const Shader* const* shaders, const GLProgramBinary* cachedBinary = nullptr);
         ~GLShaderProgram();
 
     public:
@@ -40,6 +46,9 @@ class GLShaderProgram final : public GLShaderPipeline
         // Returns true if the native GL shader program was linked successfully.
         static bool GetLinkStatus(GLuint program);
 
+        // Returns true if the native GL shader program has finished linking. This never blocks and always returns true without parallel shader compilation.
+        static bool GetCompletionStatus(GLuint program);
+
         // Returns the native GL shader program log.
         static std::string GetGLProgramLog(GLuint program);
 
@@ -55,6 +64,9 @@ class GLShaderProgram final : public GLShaderPipeline
         // Simply links the GL program.
         static void LinkProgram(GLuint program);
 
+        // Loads the specified program binary into the GL program. Returns false if the driver rejected the binary.
+        static bool LoadProgramBinary(GLuint program, const GLProgramBinary& binary);
+
         // Returns the location of the specified program uniform.
         static UniformLocation FindUniformLocation(GLuint program, const char* name);
 
@@ -8,6 +8,9 @@
 #include "GLShaderSourcePatcher.h"
 #include <LLGL/ShaderFlags.h>
 #include <string.h>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
 
 
 namespace LLGL
@@ -125,239 +128,284 @@ static std::size_t FindEndOfVersionDirective(const char* source)
     return std::string::npos;
 }
 
-GLShaderSourcePatcher::GLShaderSourcePatcher(const char* source) :
-    source_ { source }
+static std::size_t FindEntryPointSourceLocation(const char* source, std::size_t start)
 {
-    const auto posAfterVersion = FindEndOfVersionDirective(source);
-    if (posAfterVersion != std::string::npos)
-        statementInsertPos_ = posAfterVersion;
+    const char* s = source + start;
+    while (*s != '\0')
+    {
+        if (ScanToken(s, "//"))
+        {
+            /* Ignore single line comment */
+            SkipUntilToken(s, '\n');
+        }
+        else if (ScanToken(s, "/*"))
+        {
+            /* Ignore multi line comment */
+            SkipUntilToken(s, '*', '/');
+        }
+        else if (ScanToken(s, "void"))
+        {
+            /* Store position at start of current token */
+            const auto startPos = static_cast<std::size_t>(s - source - 4);
+
+            /* Ignore whitespaces after 'void' token */
+            SkipWhitespaces(s);
+
+            /* Scan for "main" identifier */
+            if (ScanToken(s, "main"))
+            {
+                SkipWhitespaces(s);
+                if (ScanToken(s, '('))
+                {
+                    SkipWhitespaces(s);
+                    if (ScanToken(s, ')'))
+                    {
+                        /* Entry point found => return start position of main function */
+                        return startPos;
+                    }
+                }
+            }
+        }
+        else
+        {
+            /* Move to next character */
+            ++s;
+        }
+    }
+    return std::string::npos;
 }
 
-void GLShaderSourcePatcher::AddDefines(const ShaderMacro* defines)
+// Scans the entry point for all source positions where the final vertex transform statements are inserted, i.e. before each return statement and the end of the entry point.
+static void ScanVertexTransformPatches(const char* source, std::size_t entryPointStartPos, std::vector<GLShaderSourceLayout::VertexTransformPatch>& outPatches)
 {
-    if (defines != nullptr)
+    std::size_t codeBlockDepth          = 0;
+    const char* head                    = source + entryPointStartPos;
+    const char* lastToken               = nullptr;
+    const char* lastIndentRange[2]      = {};
+    const char* currentIndentRange[2]   = { head, nullptr };
+
+    auto AddPatch = [&](bool currentIndent)
     {
-        /* Generate macro definition code */
-        std::string defineCode;
+        /* Insert statement at the beginning of the current line, or right before the last token if it does not start the current line */
+        const char* pos = (lastToken != currentIndentRange[1] ? lastToken : currentIndentRange[0]);
 
-        for (; defines->name != nullptr; ++defines)
+        /* Use indentation from previous or current line */
+        const char* const* indentRange = (currentIndent ? currentIndentRange : lastIndentRange);
+
+        GLShaderSourceLayout::VertexTransformPatch patch;
         {
-            defineCode += "#define ";
-            defineCode += defines->name;
-            if (defines->definition != nullptr)
+            patch.pos           = static_cast<std::size_t>(pos - source);
+            patch.indentBegin   = (indentRange[0] != nullptr ? static_cast<std::size_t>(indentRange[0] - source) : 0);
+            patch.indentEnd     = (indentRange[1] != nullptr ? static_cast<std::size_t>(indentRange[1] - source) : patch.indentBegin);
+        }
+        outPatches.push_back(patch);
+    };
+
+    for (auto& s = head; *s != '\0'; lastToken = head)
+    {
+        if (SkipComment(s))
+        {
+            /* Ignore comments */
+            continue;
+        }
+        else if (currentIndentRange[0] > currentIndentRange[1])
+        {
+            /* Record end of current indentation */
+            if (IsWhitespace(*s))
             {
-                defineCode += ' ';
-                defineCode += defines->definition;
+                SkipWhitespaces(s);
+                currentIndentRange[1] = head;
             }
-            defineCode += '\n';
+            else
+                currentIndentRange[1] = currentIndentRange[0];
         }
+        else if (ScanToken(s, '\n'))
+        {
+            /* Record previous indentation range */
+            lastIndentRange[0] = currentIndentRange[0];
+            lastIndentRange[1] = currentIndentRange[1];
 
-        /* Insert macro definitions into source */
-        InsertAfterVersionDirective(defineCode);
+            /* Record new indentation range */
+            currentIndentRange[0] = head;
+        }
+        else if (ScanToken(s, '{'))
+        {
+            /* Record stepping into a code block */
+            codeBlockDepth++;
+        }
+        else if (ScanToken(s, '}'))
+        {
+            /* Record stepping out of a code block and add last statement as we left the main entry point */
+            codeBlockDepth--;
+            if (codeBlockDepth == 0)
+            {
+                AddPatch(false);
+                break;
+            }
+        }
+        else if (ScanToken(s, "return"))
+        {
+            /* Add vertex transform statement before return statement */
+            AddPatch(true);
+        }
+        else
+        {
+            /* Move to next character */
+            ++s;
+        }
     }
 }
 
-void GLShaderSourcePatcher::AddPragmaDirective(const char* statement)
+static void ScanShaderSourceLayout(const char* source, GLShaderSourceLayout& outLayout)
 {
-    if (statement != nullptr && *statement != '\0')
+    const auto posAfterVersion = FindEndOfVersionDirective(source);
+    if (posAfterVersion != std::string::npos)
+        outLayout.versionEndPos = posAfterVersion;
+
+    const auto entryPointStartPos = FindEntryPointSourceLocation(source, outLayout.versionEndPos);
+    if (entryPointStartPos != std::string::npos)
+        ScanVertexTransformPatches(source, entryPointStartPos, outLayout.vertexTransformPatches);
+}
+
+// Returns the 64-bit FNV-1a hash of the specified shader source.
+static std::uint64_t HashShaderSource(const char* source, std::size_t length)
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    for (std::size_t i = 0; i < length; ++i)
     {
-        /* Generate '#pragma'-directive code and insert into source */
-        std::string pragmaCode = "#pragma ";
-        pragmaCode += statement;
-        pragmaCode += '\n';
-        InsertAfterVersionDirective(pragmaCode);
+        hash ^= static_cast<std::uint8_t>(source[i]);
+        hash *= 1099511628211ull;
     }
+    return hash;
 }
 
-struct SourceScanState
+/*
+Returns the layout of the specified shader source and caches it by its hash and length for all subsequent variants of the same source.
+The cache is shared between all GL contexts, since the layout does not depend on any GL state, and each entry only holds a few source positions.
+*/
+static void GetShaderSourceLayout(const char* source, GLShaderSourceLayout& outLayout)
 {
-    std::string patched;
-    std::size_t codeBlockDepth          = 0;
-    const char* head                    = nullptr;
-    const char* lastPatched             = nullptr;
-    const char* lastToken               = nullptr;
-    const char* lastIndentRange[2]      = {};
-    const char* currentIndentRange[2]   = {};
+    static std::mutex                                               cacheMutex;
+    static std::unordered_map<std::uint64_t, GLShaderSourceLayout>  cache;
 
-    SourceScanState(const char* source, std::size_t entryPointStartPos) :
-        head               { source + entryPointStartPos },
-        lastPatched        { source                      },
-        currentIndentRange { head, nullptr               }
-    {
-    }
+    const std::size_t   length  = ::strlen(source);
+    const std::uint64_t hash    = HashShaderSource(source, length);
 
-    void Append(const char* to)
     {
-        patched.append(lastPatched, to);
-        lastPatched = to;
+        std::lock_guard<std::mutex> guard{ cacheMutex };
+        auto it = cache.find(hash);
+        if (it != cache.end() && it->second.length == length)
+        {
+            outLayout = it->second;
+            return;
+        }
     }
 
-    void AppendStatement(const char* statement, bool currentIndent = false)
-    {
-        /* Append input source from last patched position to end of previous line (before current indentation start) */
-        Append(currentIndentRange[0]);
+    /* Scan source outside of the lock; sources whose hash collides with a different source are not cached */
+    outLayout.length = length;
+    ScanShaderSourceLayout(source, outLayout);
 
-        /* If last token was not the end of the current indentation range, also add everything to that last token */
-        if (lastToken != currentIndentRange[1])
-            Append(lastToken);
+    std::lock_guard<std::mutex> guard{ cacheMutex };
+    cache.emplace(hash, outLayout);
+}
 
-        /* Append indentation from previous or current line */
-        if (currentIndent)
-            patched.append(currentIndentRange[0], currentIndentRange[1] - currentIndentRange[0]);
-        else
-            patched.append(lastIndentRange[0], lastIndentRange[1] - lastIndentRange[0]);
+GLShaderSourcePatcher::GLShaderSourcePatcher(const char* source) :
+    source_ { source }
+{
+    GetShaderSourceLayout(source, layout_);
+}
 
-        /* Append statement with newline */
-        patched += statement;
-        patched += '\n';
+void GLShaderSourcePatcher::AddDefines(const ShaderMacro* defines)
+{
+    if (defines != nullptr)
+    {
+        /* Append macro definition code to statements after '#version'-directive */
+        for (; defines->name != nullptr; ++defines)
+        {
+            statements_ += "#define ";
+            statements_ += defines->name;
+            if (defines->definition != nullptr)
+            {
+                statements_ += ' ';
+                statements_ += defines->definition;
+            }
+            statements_ += '\n';
+            isDirty_ = true;
+        }
     }
+}
 
-    void AppendRemainder()
+void GLShaderSourcePatcher::AddPragmaDirective(const char* statement)
+{
+    if (statement != nullptr && *statement != '\0')
     {
-        /* Append remaining source until current head position */
-        patched.append(lastPatched, head);
-        lastPatched = head;
+        /* Append '#pragma'-directive code to statements after '#version'-directive */
+        statements_ += "#pragma ";
+        statements_ += statement;
+        statements_ += '\n';
+        isDirty_ = true;
     }
-};
+}
 
 void GLShaderSourcePatcher::AddFinalVertexTransformStatements(const char* statement)
 {
-    if (statement != nullptr && *statement != '\0')
+    if (statement != nullptr && *statement != '\0' && !layout_.vertexTransformPatches.empty())
     {
-        CacheEntryPointSourceLocation();
-
-        /* Scan source from entry point start location */
-        SourceScanState scan{ GetSource(), entryPointStartPos_ };
-
-        for (auto& s = scan.head; *s != '\0'; scan.lastToken = scan.head)
-        {
-            if (SkipComment(s))
-            {
-                /* Ignore comments */
-                continue;
-            }
-            else if (scan.currentIndentRange[0] > scan.currentIndentRange[1])
-            {
-                /* Record end of current indentation */
-                if (IsWhitespace(*s))
-                {
-                    SkipWhitespaces(s);
-                    scan.currentIndentRange[1] = scan.head;
-                }
-                else
-                    scan.currentIndentRange[1] = scan.currentIndentRange[0];
-            }
-            else if (ScanToken(s, '\n'))
-            {
-                /* Record previous indentation range */
-                scan.lastIndentRange[0] = scan.currentIndentRange[0];
-                scan.lastIndentRange[1] = scan.currentIndentRange[1];
-
-                /* Record new indentation range */
-                scan.currentIndentRange[0] = scan.head;
-            }
-            else if (ScanToken(s, '{'))
-            {
-                /* Record stepping into a code block */
-                scan.codeBlockDepth++;
-            }
-            else if (ScanToken(s, '}'))
-            {
-                /* Record stepping out of a code block and write last statement as we left the main entry point */
-                scan.codeBlockDepth--;
-                if (scan.codeBlockDepth == 0)
-                {
-                    scan.AppendStatement(statement);
-                    break;
-                }
-            }
-            else if (ScanToken(s, "return"))
-            {
-                /* Append vertex transform statement before return statement */
-                scan.AppendStatement(statement, true);
-            }
-            else
-            {
-                /* Move to next character */
-                ++s;
-            }
-        }
-
-        /* Replace source with finalized patched source */
-        scan.AppendRemainder();
-        source_ = std::move(scan.patched);
+        vertexTransformStmt_ = statement;
+        isDirty_ = true;
     }
 }
 
+const char* GLShaderSourcePatcher::GetSource()
+{
+    if (!isDirty_)
+        return (patched_.empty() ? source_ : patched_.c_str());
+    BuildPatchedSource();
+    return patched_.c_str();
+}
+
 
 /*
  * ======= Private: =======
  */
 
-void GLShaderSourcePatcher::InsertAfterVersionDirective(const std::string& statement)
+void GLShaderSourcePatcher::BuildPatchedSource()
 {
-    /* Insert statement into source after version */
-    source_.insert(statementInsertPos_, statement);
+    const auto& patches = layout_.vertexTransformPatches;
 
-    /* Move source location for next insertion at the end of newly added code */
-    statementInsertPos_ += statement.size();
-
-    /* Move source loation of previously cached entry point by the length of newly added code */
-    if (entryPointStartPos_ != std::string::npos)
-        entryPointStartPos_ += statement.size();
-}
+    /* Determine size of patched source */
+    const std::size_t stmtLength = (vertexTransformStmt_ != nullptr ? ::strlen(vertexTransformStmt_) : 0);
+    std::size_t patchedLength = layout_.length + statements_.size();
 
-static std::size_t FindEntryPointSourceLocation(const char* source, std::size_t start)
-{
-    const char* s = source + start;
-    while (*s != '\0')
+    if (vertexTransformStmt_ != nullptr)
     {
-        if (ScanToken(s, "//"))
-        {
-            /* Ignore single line comment */
-            SkipUntilToken(s, '\n');
-        }
-        else if (ScanToken(s, "/*"))
-        {
-            /* Ignore multi line comment */
-            SkipUntilToken(s, '*', '/');
-        }
-        else if (ScanToken(s, "void"))
-        {
-            /* Store position at start of current token */
-            const auto startPos = static_cast<std::size_t>(s - source - 4);
+        for (const auto& patch : patches)
+            patchedLength += (patch.indentEnd - patch.indentBegin) + stmtLength + 1;
+    }
 
-            /* Ignore whitespaces after 'void' token */
-            SkipWhitespaces(s);
+    /* Concatenate original source with statements after '#version'-directive and vertex transform statements */
+    patched_.clear();
+    patched_.reserve(patchedLength);
+    patched_.append(source_, layout_.versionEndPos);
+    patched_.append(statements_);
 
-            /* Scan for "main" identifier */
-            if (ScanToken(s, "main"))
-            {
-                SkipWhitespaces(s);
-                if (ScanToken(s, '('))
-                {
-                    SkipWhitespaces(s);
-                    if (ScanToken(s, ')'))
-                    {
-                        /* Entry point found => return start position of main function */
-                        return startPos;
-                    }
-                }
-            }
-        }
-        else
+    std::size_t pos = layout_.versionEndPos;
+
+    if (vertexTransformStmt_ != nullptr)
+    {
+        for (const auto& patch : patches)
         {
-            /* Move to next character */
-            ++s;
+            patched_.append(source_ + pos, patch.pos - pos);
+            patched_.append(source_ + patch.indentBegin, patch.indentEnd - patch.indentBegin);
+            patched_.append(vertexTransformStmt_, stmtLength);
+            patched_ += '\n';
+            pos = patch.pos;
         }
     }
-    return std::string::npos;
-}
 
-void GLShaderSourcePatcher::CacheEntryPointSourceLocation()
-{
-    if (entryPointStartPos_ == std::string::npos)
-        entryPointStartPos_ = FindEntryPointSourceLocation(GetSource(), statementInsertPos_);
+    patched_.append(source_ + pos, layout_.length - pos);
+
+    isDirty_ = false;
 }
 
 
@@ -10,6 +10,8 @@
 
 
 #include <string>
+#include <vector>
+#include <cstddef>
 
 
 namespace LLGL
@@ -18,13 +20,33 @@ namespace LLGL
 
 struct ShaderMacro;
 
-// Allows to insert source code into a given GLSL shader.
+// Source positions of a GLSL shader where the patcher inserts code. These only depend on the original source, so they are shared between all its variants.
+struct GLShaderSourceLayout
+{
+    // Position of a final vertex transform statement and the source range of the indentation that is put in front of it.
+    struct VertexTransformPatch
+    {
+        std::size_t pos;
+        std::size_t indentBegin;
+        std::size_t indentEnd;
+    };
+
+    std::size_t                         length              = 0;
+    std::size_t                         versionEndPos       = 0;    // Position after the '#version'-directive or 0 if there is none.
+    std::vector<VertexTransformPatch>   vertexTransformPatches;     // Empty if the entry point was not found.
+};
+
+/*
+Allows to insert source code into a given GLSL shader.
+The insertion points of each source are scanned only once and cached by the hash of the source, since many shaders are created as variants of the same source.
+The patched source is then built with a single concatenation of the original source and all insertions.
+*/
 class GLShaderSourcePatcher
 {
 
     public:
 
-        // Initialies the patcher with the specified shader source.
+        // Initialies the patcher with the specified shader source. The source must remain valid during the lifetime of this patcher.
         GLShaderSourcePatcher(const char* source);
 
         // Adds the specifies macro definitions to the shader source.
@@ -40,25 +62,22 @@ class GLShaderSourcePatcher
 
     public:
 
-        // Returns the current shader source as null terminated string.
-        inline const char* GetSource() const
-        {
-            return source_.c_str();
-        }
+        // Returns the patched shader source as null terminated string. This is the original source if nothing has been added.
+        const char* GetSource();
 
     private:
 
-        // Inserts the specified statement after the '#version'-directive and any previously inserted statement.
-        void InsertAfterVersionDirective(const std::string& statement);
-
-        // Finds and stores the source location of the entry point, i.e. points to the first character after of the entry point declaration "void main()".
-        void CacheEntryPointSourceLocation();
+        // Builds the patched source from the original source and all added statements.
+        void BuildPatchedSource();
 
     private:
 
-        std::string source_;
-        std::size_t statementInsertPos_ = 0;
-        std::size_t entryPointStartPos_ = std::string::npos;
+        const char*             source_                 = nullptr;
+        GLShaderSourceLayout    layout_;
+        std::string             statements_;                        // Statements inserted after the '#version'-directive.
+        const char*             vertexTransformStmt_    = nullptr;
+        std::string             patched_;
+        bool                    isDirty_                = false;
 
 };
 
@@ -43,7 +43,17 @@ GLFramebuffer& GLFramebuffer::operator = (GLFramebuffer&& rhs)
 void GLFramebuffer::GenFramebuffer()
 {
     DeleteFramebuffer();
-    glGenFramebuffers(1, &id_);
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        /* Create framebuffer object immediately, so it can be modified by the named functions without binding it first */
+        glCreateFramebuffers(1, &id_);
+    }
+    else
+    #endif // /GL_ARB_direct_state_access
+    {
+        glGenFramebuffers(1, &id_);
+    }
 }
 
 void GLFramebuffer::DeleteFramebuffer()
@@ -76,6 +86,17 @@ bool GLFramebuffer::FramebufferParameters(
     #ifdef GL_ARB_framebuffer_no_attachments
     if (HasExtension(GLExt::ARB_framebuffer_no_attachments))
     {
+        #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+        if (HasExtension(GLExt::ARB_direct_state_access))
+        {
+            glNamedFramebufferParameteri(GetID(), GL_FRAMEBUFFER_DEFAULT_WIDTH, width);
+            glNamedFramebufferParameteri(GetID(), GL_FRAMEBUFFER_DEFAULT_HEIGHT, height);
+            glNamedFramebufferParameteri(GetID(), GL_FRAMEBUFFER_DEFAULT_LAYERS, layers);
+            glNamedFramebufferParameteri(GetID(), GL_FRAMEBUFFER_DEFAULT_SAMPLES, samples);
+            glNamedFramebufferParameteri(GetID(), GL_FRAMEBUFFER_DEFAULT_FIXED_SAMPLE_LOCATIONS, fixedSampleLocations);
+            return true;
+        }
+        #endif // /GL_ARB_direct_state_access
         GLStateManager::Get().BindFramebuffer(GLFramebufferTarget::FRAMEBUFFER, GetID());
         glFramebufferParameteri(GL_FRAMEBUFFER, GL_FRAMEBUFFER_DEFAULT_WIDTH, width);
         glFramebufferParameteri(GL_FRAMEBUFFER, GL_FRAMEBUFFER_DEFAULT_HEIGHT, height);
@@ -88,6 +109,64 @@ bool GLFramebuffer::FramebufferParameters(
     return false;
 }
 
+void GLFramebuffer::AttachNamedTexture(
+    const GLTexture&    texture,
+    GLenum              attachment,
+    GLint               mipLevel,
+    GLint               arrayLayer,
+    GLenum              target) const
+{
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        GLuint texID = texture.GetID();
+        if (texture.IsRenderbuffer())
+        {
+            /* Attach renderbuffer to named FBO */
+            glNamedFramebufferRenderbuffer(GetID(), attachment, GL_RENDERBUFFER, texID);
+        }
+        else
+        {
+            /* Attach texture to named FBO; cube faces are addressed like array layers with DSA */
+            switch (texture.GetType())
+            {
+                case TextureType::Texture1D:
+                case TextureType::Texture2D:
+                    glNamedFramebufferTexture(GetID(), attachment, texID, mipLevel);
+                    break;
+                case TextureType::Texture3D:
+                case TextureType::TextureCube:
+                case TextureType::Texture1DArray:
+                case TextureType::Texture2DArray:
+                case TextureType::TextureCubeArray:
+                    glNamedFramebufferTextureLayer(GetID(), attachment, texID, mipLevel, arrayLayer);
+                    break;
+                case TextureType::Texture2DMS:
+                    glNamedFramebufferTexture(GetID(), attachment, texID, 0);
+                    break;
+                case TextureType::Texture2DMSArray:
+                    glNamedFramebufferTextureLayer(GetID(), attachment, texID, 0, arrayLayer);
+                    break;
+            }
+        }
+    }
+    else
+    #endif // /GL_ARB_direct_state_access
+    {
+        GLFramebuffer::AttachTexture(texture, attachment, mipLevel, arrayLayer, target);
+    }
+}
+
+void GLFramebuffer::AttachNamedRenderbuffer(GLenum attachment, GLuint renderbufferID) const
+{
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+        glNamedFramebufferRenderbuffer(GetID(), attachment, GL_RENDERBUFFER, renderbufferID);
+    else
+    #endif // /GL_ARB_direct_state_access
+        GLFramebuffer::AttachRenderbuffer(attachment, renderbufferID);
+}
+
 void GLFramebuffer::AttachTexture(
     const GLTexture&    texture,
     GLenum              attachment,
@@ -49,6 +49,21 @@ class GLFramebuffer
             GLint fixedSampleLocations
         );
 
+        /*
+        Attaches the specified texture to this framebuffer object.
+        Without extension "GL_ARB_direct_state_access", this framebuffer must be bound to the specified target.
+        */
+        void AttachNamedTexture(
+            const GLTexture&    texture,
+            GLenum              attachment,
+            GLint               mipLevel,
+            GLint               arrayLayer,
+            GLenum              target = GL_FRAMEBUFFER
+        ) const;
+
+        // Attaches the specified renderbuffer to this framebuffer object; see AttachNamedTexture.
+        void AttachNamedRenderbuffer(GLenum attachment, GLuint renderbufferID) const;
+
         // Returns the hardware buffer ID.
         inline GLuint GetID() const
         {
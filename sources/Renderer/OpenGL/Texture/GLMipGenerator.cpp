@@ -13,6 +13,7 @@
 #include "../Ext/GLExtensions.h"
 #include "../Ext/GLExtensionRegistry.h"
 #include "../../CheckedCast.h"
+#include <string>
 
 
 namespace LLGL
@@ -30,6 +31,7 @@ void GLMipGenerator::Clear()
     #ifdef LLGL_ENABLE_CUSTOM_SUB_MIPGEN
     mipGenerationFBOPair_.ReleaseFBOs();
     #endif
+    ReleaseComputeMipPrograms();
 }
 
 void GLMipGenerator::GenerateMips(const TextureType type)
@@ -53,6 +55,20 @@ void GLMipGenerator::GenerateMipsRangeForTexture(
 {
     if (numMipLevels > 0 && numArrayLayers > 0)
     {
+        #ifdef LLGL_GLEXT_COMPUTE_SHADER
+        /* Generate MIP-maps with compute shader, which avoids a framebuffer rebind per MIP-map level */
+        if (GenerateMipsRangeWithCompute(
+                stateMngr,
+                textureGL,
+                static_cast<GLuint>(baseMipLevel),
+                static_cast<GLuint>(numMipLevels),
+                static_cast<GLuint>(baseArrayLayer),
+                static_cast<GLuint>(numArrayLayers)))
+        {
+            return;
+        }
+        #endif // /LLGL_GLEXT_COMPUTE_SHADER
+
         #ifdef GL_ARB_texture_view
         if (HasExtension(GLExt::ARB_texture_view))
         {
@@ -314,6 +330,411 @@ void GLMipGenerator::GenerateMipsRangeWithTextureView(
 #endif // /GL_ARB_texture_view
 
 
+#ifdef LLGL_GLEXT_COMPUTE_SHADER
+
+// Image formats that can be downsampled with the compute shader; sRGB formats are written via a texture view with a linear format.
+struct GLComputeMipFormat
+{
+    GLenum      internalFormat;
+    GLenum      imageFormat;
+    const char* imageFormatQualifier;
+    bool        isSRGB;
+};
+
+static const GLComputeMipFormat g_computeMipFormats[] =
+{
+    { GL_RGBA8,             GL_RGBA8,               "rgba8",            false },
+    { GL_SRGB8_ALPHA8,      GL_RGBA8,               "rgba8",            true  },
+    { GL_RGBA16F,           GL_RGBA16F,             "rgba16f",          false },
+    { GL_RGBA32F,           GL_RGBA32F,             "rgba32f",          false },
+    { GL_R32F,              GL_R32F,                "r32f",             false },
+    #ifdef LLGL_OPENGL
+    { GL_R8,                GL_R8,                  "r8",               false },
+    { GL_RG8,               GL_RG8,                 "rg8",              false },
+    { GL_R16,               GL_R16,                 "r16",              false },
+    { GL_RG16,              GL_RG16,                "rg16",             false },
+    { GL_RGBA16,            GL_RGBA16,              "rgba16",           false },
+    { GL_R16F,              GL_R16F,                "r16f",             false },
+    { GL_RG16F,             GL_RG16F,               "rg16f",            false },
+    { GL_RG32F,             GL_RG32F,               "rg32f",            false },
+    { GL_RGB10_A2,          GL_RGB10_A2,            "rgb10_a2",         false },
+    { GL_R11F_G11F_B10F,    GL_R11F_G11F_B10F,      "r11f_g11f_b10f",   false },
+    #endif // /LLGL_OPENGL
+};
+
+static const GLComputeMipFormat* FindComputeMipFormat(GLenum internalFormat)
+{
+    for (const auto& format : g_computeMipFormats)
+    {
+        if (format.internalFormat == internalFormat)
+            return &format;
+    }
+    return nullptr;
+}
+
+/*
+Compute shader to downsample up to four MIP-map levels per dispatch, similar to the D3D12 builtin shader "GenerateMips2D.hlsl".
+The first output level is filtered from the source level with texelFetch, so sRGB formats are decoded to linear colors.
+Odd source dimensions use a 3-tap filter, so no source texel is discarded.
+The remaining output levels are averaged in shared memory; the caller only chains them as long as all dimensions are even.
+According to GLSL 4.30 and ESSL 3.10, barrier() must neither appear in control flow nor after a return statement.
+*/
+static const char* g_computeMipShaderBody =
+    "layout(local_size_x = 8, local_size_y = 8, local_size_z = 1) in;\n"
+    "#ifdef ARRAY_TEXTURE\n"
+    "#   define SAMPLER_TYPE    sampler2DArray\n"
+    "#   define IMAGE_TYPE      image2DArray\n"
+    "#   define TEX_COORD(XY)   ivec3(XY, arrayLayer)\n"
+    "#else\n"
+    "#   define SAMPLER_TYPE    sampler2D\n"
+    "#   define IMAGE_TYPE      image2D\n"
+    "#   define TEX_COORD(XY)   (XY)\n"
+    "#endif\n"
+    "layout(binding = 0) uniform SAMPLER_TYPE srcMipLevels;\n"
+    "layout(binding = DST_UNIT0, IMAGE_FORMAT) writeonly uniform IMAGE_TYPE dstMipLevel1;\n"
+    "layout(binding = DST_UNIT1, IMAGE_FORMAT) writeonly uniform IMAGE_TYPE dstMipLevel2;\n"
+    "layout(binding = DST_UNIT2, IMAGE_FORMAT) writeonly uniform IMAGE_TYPE dstMipLevel3;\n"
+    "layout(binding = DST_UNIT3, IMAGE_FORMAT) writeonly uniform IMAGE_TYPE dstMipLevel4;\n"
+    "uniform ivec2 srcExtent;\n"
+    "uniform int srcMipLevel;\n"
+    "uniform int numMipLevels;\n"
+    "uniform int baseArrayLayer;\n"
+    "shared vec4 sharedColors[64];\n"
+    "vec4 FetchSource(ivec2 coord, int arrayLayer)\n"
+    "{\n"
+    "    return texelFetch(srcMipLevels, TEX_COORD(min(coord, srcExtent - 1)), srcMipLevel);\n"
+    "}\n"
+    "vec4 DownsampleSource(ivec2 dstCoord, int arrayLayer)\n"
+    "{\n"
+    "    ivec2 srcCoord = dstCoord * 2;\n"
+    "    ivec2 isOdd = (srcExtent & 1);\n"
+    "    if (isOdd.x != 0 || isOdd.y != 0)\n"
+    "    {\n"
+    "        vec3 wx = (isOdd.x != 0 ? vec3(0.25, 0.5, 0.25) : vec3(0.5, 0.5, 0.0));\n"
+    "        vec3 wy = (isOdd.y != 0 ? vec3(0.25, 0.5, 0.25) : vec3(0.5, 0.5, 0.0));\n"
+    "        vec4 color = vec4(0.0);\n"
+    "        for (int y = 0; y < 3; ++y)\n"
+    "        {\n"
+    "            for (int x = 0; x < 3; ++x)\n"
+    "                color += (wx[x] * wy[y]) * FetchSource(srcCoord + ivec2(x, y), arrayLayer);\n"
+    "        }\n"
+    "        return color;\n"
+    "    }\n"
+    "    return 0.25 * (\n"
+    "        FetchSource(srcCoord,               arrayLayer) +\n"
+    "        FetchSource(srcCoord + ivec2(1, 0), arrayLayer) +\n"
+    "        FetchSource(srcCoord + ivec2(0, 1), arrayLayer) +\n"
+    "        FetchSource(srcCoord + ivec2(1, 1), arrayLayer)\n"
+    "    );\n"
+    "}\n"
+    "vec4 PackLinearColor(vec4 color)\n"
+    "{\n"
+    "#ifdef LINEAR_TO_SRGB\n"
+    "    vec3 c = max(color.rgb, vec3(0.0));\n"
+    "    return vec4(mix(c * 12.92, 1.055 * pow(c, vec3(1.0/2.4)) - 0.055, step(vec3(0.0031308), c)), color.a);\n"
+    "#else\n"
+    "    return color;\n"
+    "#endif\n"
+    "}\n"
+    "void main()\n"
+    "{\n"
+    "    ivec2 dstCoord = ivec2(gl_GlobalInvocationID.xy);\n"
+    "    int arrayLayer = baseArrayLayer + int(gl_GlobalInvocationID.z);\n"
+    "    uint groupIndex = gl_LocalInvocationIndex;\n"
+    "    vec4 color = DownsampleSource(dstCoord, arrayLayer);\n"
+    "    imageStore(dstMipLevel1, TEX_COORD(dstCoord), PackLinearColor(color));\n"
+    "    sharedColors[groupIndex] = color;\n"
+    "    memoryBarrierShared();\n"
+    "    barrier();\n"
+    "    if (numMipLevels > 1 && (groupIndex & 0x09u) == 0u)\n"
+    "    {\n"
+    "        color = 0.25 * (color + sharedColors[groupIndex + 0x01u] + sharedColors[groupIndex + 0x08u] + sharedColors[groupIndex + 0x09u]);\n"
+    "        imageStore(dstMipLevel2, TEX_COORD(dstCoord / 2), PackLinearColor(color));\n"
+    "        sharedColors[groupIndex] = color;\n"
+    "    }\n"
+    "    memoryBarrierShared();\n"
+    "    barrier();\n"
+    "    if (numMipLevels > 2 && (groupIndex & 0x1Bu) == 0u)\n"
+    "    {\n"
+    "        color = 0.25 * (color + sharedColors[groupIndex + 0x02u] + sharedColors[groupIndex + 0x10u] + sharedColors[groupIndex + 0x12u]);\n"
+    "        imageStore(dstMipLevel3, TEX_COORD(dstCoord / 4), PackLinearColor(color));\n"
+    "        sharedColors[groupIndex] = color;\n"
+    "    }\n"
+    "    memoryBarrierShared();\n"
+    "    barrier();\n"
+    "    if (numMipLevels > 3 && groupIndex == 0u)\n"
+    "    {\n"
+    "        color = 0.25 * (color + sharedColors[groupIndex + 0x04u] + sharedColors[groupIndex + 0x20u] + sharedColors[groupIndex + 0x24u]);\n"
+    "        imageStore(dstMipLevel4, TEX_COORD(dstCoord / 8), PackLinearColor(color));\n"
+    "    }\n"
+    "}\n"
+;
+
+static GLuint CompileComputeMipProgram(const std::string& source)
+{
+    /* Compile compute shader */
+    GLuint shader = glCreateShader(GL_COMPUTE_SHADER);
+    const GLchar* sourceStr = source.c_str();
+    glShaderSource(shader, 1, &sourceStr, nullptr);
+    glCompileShader(shader);
+
+    GLint status = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (status == GL_FALSE)
+    {
+        glDeleteShader(shader);
+        return 0;
+    }
+
+    /* Link shader program; the shader object is no longer needed afterwards */
+    GLuint program = glCreateProgram();
+    glAttachShader(program, shader);
+    glLinkProgram(program);
+    glDetachShader(program, shader);
+    glDeleteShader(shader);
+
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (status == GL_FALSE)
+    {
+        glDeleteProgram(program);
+        return 0;
+    }
+
+    return program;
+}
+
+const GLMipGenerator::ComputeMipProgram* GLMipGenerator::GetOrCreateComputeMipProgram(GLenum imageFormat, const char* imageFormatQualifier, bool isArray, bool isSRGB)
+{
+    /* Find previously compiled program; a program ID of 0 denotes a failed compilation */
+    for (const auto& entry : computeMipPrograms_)
+    {
+        if (entry.imageFormat == imageFormat && entry.isArray == isArray && entry.isSRGB == isSRGB)
+            return (entry.program != 0 ? &entry : nullptr);
+    }
+
+    /* Use the last four image units, since they are the least likely to be used by client resource heaps */
+    if (computeMipPrograms_.empty())
+    {
+        GLint maxImageUnits = 0;
+        glGetIntegerv(GL_MAX_IMAGE_UNITS, &maxImageUnits);
+        computeMipImageUnit_ = static_cast<GLuint>(std::max(0, maxImageUnits - 4));
+    }
+
+    /* Generate shader source for this configuration */
+    std::string source;
+    {
+        #ifdef LLGL_OPENGLES3
+        source += "#version 310 es\n";
+        source += "precision highp float;\n";
+        source += "precision highp int;\n";
+        source += "precision highp sampler2D;\n";
+        source += "precision highp sampler2DArray;\n";
+        source += "precision highp image2D;\n";
+        source += "precision highp image2DArray;\n";
+        #else
+        source += "#version 430 core\n";
+        #endif
+
+        source += "#define IMAGE_FORMAT ";
+        source += imageFormatQualifier;
+        source += '\n';
+
+        for (GLuint i = 0; i < 4; ++i)
+        {
+            source += "#define DST_UNIT" + std::to_string(i) + ' ' + std::to_string(computeMipImageUnit_ + i) + '\n';
+        }
+
+        if (isArray)
+            source += "#define ARRAY_TEXTURE\n";
+        if (isSRGB)
+            source += "#define LINEAR_TO_SRGB\n";
+
+        source += g_computeMipShaderBody;
+    }
+
+    ComputeMipProgram entry;
+    {
+        entry.imageFormat   = imageFormat;
+        entry.isArray       = isArray;
+        entry.isSRGB        = isSRGB;
+        entry.program       = CompileComputeMipProgram(source);
+        if (entry.program != 0)
+        {
+            entry.srcExtentLoc      = glGetUniformLocation(entry.program, "srcExtent");
+            entry.srcMipLevelLoc    = glGetUniformLocation(entry.program, "srcMipLevel");
+            entry.numMipLevelsLoc   = glGetUniformLocation(entry.program, "numMipLevels");
+            entry.baseArrayLayerLoc = glGetUniformLocation(entry.program, "baseArrayLayer");
+        }
+    }
+    computeMipPrograms_.push_back(entry);
+
+    return (entry.program != 0 ? &(computeMipPrograms_.back()) : nullptr);
+}
+
+bool GLMipGenerator::GenerateMipsRangeWithCompute(
+    GLStateManager& stateMngr,
+    GLTexture&      textureGL,
+    GLuint          baseMipLevel,
+    GLuint          numMipLevels,
+    GLuint          baseArrayLayer,
+    GLuint          numArrayLayers)
+{
+    if (!HasExtension(GLExt::ARB_compute_shader) || !HasExtension(GLExt::ARB_shader_image_load_store) || textureGL.IsRenderbuffer())
+        return false;
+
+    /* Only formats that are supported for image load/store can be downsampled with compute shaders */
+    const auto* format = FindComputeMipFormat(textureGL.GetGLInternalFormat());
+    if (format == nullptr)
+        return false;
+
+    /*
+    With GL_ARB_texture_view, all 2D and cube textures are viewed as 2D array textures and sRGB formats are written via a linear format.
+    Otherwise, only 2D and 2D-array textures with linear formats are supported.
+    */
+    #ifdef GL_ARB_texture_view
+    const bool useTextureViews = HasExtension(GLExt::ARB_texture_view);
+    #else
+    const bool useTextureViews = false;
+    #endif
+
+    bool isArray = false;
+    switch (textureGL.GetType())
+    {
+        case TextureType::Texture2D:
+            isArray = useTextureViews;
+            break;
+        case TextureType::Texture2DArray:
+            isArray = true;
+            break;
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+            if (!useTextureViews)
+                return false;
+            isArray = true;
+            break;
+        default:
+            return false;
+    }
+
+    if (format->isSRGB && !useTextureViews)
+        return false;
+
+    const auto* program = GetOrCreateComputeMipProgram(format->imageFormat, format->imageFormatQualifier, isArray, format->isSRGB);
+    if (program == nullptr)
+        return false;
+
+    /* Determine source and destination textures */
+    GLuint          srcTexID        = textureGL.GetID();
+    GLuint          dstTexID        = srcTexID;
+    GLTextureTarget srcTexTarget    = GLStateManager::GetTextureTarget(textureGL.GetType());
+    GLint           firstArrayLayer = static_cast<GLint>(baseArrayLayer);
+    GLuint          texViewIDs[2]   = { 0, 0 };
+
+    #ifdef GL_ARB_texture_view
+    if (useTextureViews)
+    {
+        /* Create temporary texture views for the specified array layers; the views share the entire MIP-map chain */
+        const auto numTexMipLevels = static_cast<GLuint>(textureGL.GetNumMipLevels());
+        glGenTextures(2, texViewIDs);
+        glTextureView(texViewIDs[0], GL_TEXTURE_2D_ARRAY, textureGL.GetID(), textureGL.GetGLInternalFormat(), 0, numTexMipLevels, baseArrayLayer, numArrayLayers);
+        srcTexID        = texViewIDs[0];
+        srcTexTarget    = GLTextureTarget::TEXTURE_2D_ARRAY;
+        firstArrayLayer = 0;
+
+        if (format->isSRGB)
+        {
+            glTextureView(texViewIDs[1], GL_TEXTURE_2D_ARRAY, textureGL.GetID(), format->imageFormat, 0, numTexMipLevels, baseArrayLayer, numArrayLayers);
+            dstTexID = texViewIDs[1];
+        }
+        else
+            dstTexID = srcTexID;
+    }
+    #endif // /GL_ARB_texture_view
+
+    stateMngr.PushBoundShaderProgram();
+    stateMngr.PushBoundTexture(0, srcTexTarget);
+    {
+        stateMngr.BindShaderProgram(program->program);
+        stateMngr.ActiveTexture(0);
+        stateMngr.BindTexture(srcTexTarget, srcTexID);
+
+        glUniform1i(program->baseArrayLayerLoc, firstArrayLayer);
+
+        const GLuint mipLevelEnd = baseMipLevel + numMipLevels;
+
+        for (GLuint mipLevel = baseMipLevel; mipLevel + 1 < mipLevelEnd;)
+        {
+            /* Determine source and destination extents */
+            const auto srcExtent    = textureGL.GetMipExtent(mipLevel);
+            const auto dstWidth     = std::max(1u, srcExtent.width  / 2u);
+            const auto dstHeight    = std::max(1u, srcExtent.height / 2u);
+
+            /* Chain further MIP-map levels within the same dispatch as long as the previous level has even dimensions */
+            GLuint numMips = 1;
+            for (auto width = dstWidth, height = dstHeight; numMips < 4 && mipLevel + numMips + 1 < mipLevelEnd; ++numMips)
+            {
+                if (width % 2 != 0 || height % 2 != 0)
+                    break;
+                width   /= 2;
+                height  /= 2;
+            }
+
+            /* Bind destination MIP-map levels as layered images */
+            for (GLuint i = 0; i < numMips; ++i)
+            {
+                glBindImageTexture(
+                    computeMipImageUnit_ + i,
+                    dstTexID,
+                    static_cast<GLint>(mipLevel + 1 + i),
+                    GL_TRUE,
+                    0,
+                    GL_WRITE_ONLY,
+                    format->imageFormat
+                );
+            }
+
+            glUniform2i(program->srcExtentLoc, static_cast<GLint>(srcExtent.width), static_cast<GLint>(srcExtent.height));
+            glUniform1i(program->srcMipLevelLoc, static_cast<GLint>(mipLevel));
+            glUniform1i(program->numMipLevelsLoc, static_cast<GLint>(numMips));
+
+            glDispatchCompute((dstWidth + 7u) / 8u, (dstHeight + 7u) / 8u, numArrayLayers);
+
+            /* Make written MIP-map levels visible to the texel fetches of the next dispatch */
+            glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+            mipLevel += numMips;
+        }
+
+        /* Make written MIP-map levels visible to all subsequent commands */
+        glMemoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT | GL_PIXEL_BUFFER_BARRIER_BIT);
+
+        /* Unbind images, since the temporary texture views are deleted below */
+        for (GLuint i = 0; i < 4; ++i)
+            glBindImageTexture(computeMipImageUnit_ + i, 0, 0, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+    }
+    stateMngr.PopBoundTexture();
+    stateMngr.PopBoundShaderProgram();
+
+    /* Release temporary texture views */
+    if (texViewIDs[0] != 0)
+        glDeleteTextures(2, texViewIDs);
+
+    return true;
+}
+
+#endif // /LLGL_GLEXT_COMPUTE_SHADER
+
+void GLMipGenerator::ReleaseComputeMipPrograms()
+{
+    for (const auto& entry : computeMipPrograms_)
+    {
+        if (entry.program != 0)
+            glDeleteProgram(entry.program);
+    }
+    computeMipPrograms_.clear();
+}
+
+
 /*
  * MipGenerationFBOPair structure
  */
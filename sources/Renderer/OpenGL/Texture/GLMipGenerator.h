@@ -11,6 +11,7 @@
 
 #include <LLGL/TextureFlags.h>
 #include <cstdint>
+#include <vector>
 #include "../OpenGL.h"
 
 
@@ -83,6 +84,38 @@ class GLMipGenerator
         );
         #endif // /GL_ARB_texture_view
 
+        #ifdef LLGL_GLEXT_COMPUTE_SHADER
+        // Generates the MIP-maps with a compute shader that downsamples up to four MIP-map levels per dispatch. Returns false if the texture is not supported.
+        bool GenerateMipsRangeWithCompute(
+            GLStateManager& stateMngr,
+            GLTexture&      textureGL,
+            GLuint          baseMipLevel,
+            GLuint          numMipLevels,
+            GLuint          baseArrayLayer,
+            GLuint          numArrayLayers
+        );
+        #endif // /LLGL_GLEXT_COMPUTE_SHADER
+
+    private:
+
+        // Compute shader program to downsample MIP-maps of a specific image format.
+        struct ComputeMipProgram
+        {
+            GLenum  imageFormat         = 0;
+            bool    isArray             = false;
+            bool    isSRGB              = false;
+            GLuint  program             = 0;
+            GLint   srcExtentLoc        = -1;
+            GLint   srcMipLevelLoc      = -1;
+            GLint   numMipLevelsLoc     = -1;
+            GLint   baseArrayLayerLoc   = -1;
+        };
+
+        // Returns the compute shader program for the specified configuration or null if it could not be compiled.
+        const ComputeMipProgram* GetOrCreateComputeMipProgram(GLenum imageFormat, const char* imageFormatQualifier, bool isArray, bool isSRGB);
+
+        void ReleaseComputeMipPrograms();
+
     private:
 
         struct MipGenerationFBOPair
@@ -97,7 +130,10 @@ class GLMipGenerator
 
     private:
 
-        MipGenerationFBOPair mipGenerationFBOPair_;
+        MipGenerationFBOPair            mipGenerationFBOPair_;
+
+        std::vector<ComputeMipProgram>  computeMipPrograms_;
+        GLuint                          computeMipImageUnit_    = 0;    // First of four image units used by the compute shaders.
 
 };
 
@@ -0,0 +1,165 @@
+/*
+ * GLPixelBufferPool.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLPixelBufferPool.h"
+#include "GLTexture.h"
+#include "../RenderState/GLStateManager.h"
+#include "../Ext/GLExtensions.h"
+#include "../Ext/GLExtensionRegistry.h"
+#include "../../../Core/Helper.h"
+#include <limits>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+static const GLsizeiptr     g_pixelBufferChunkSize      = (4 * 1024 * 1024);
+static const std::size_t    g_maxNumPixelBufferChunks   = 4;
+static const GLintptr       g_pixelBufferAlignment      = 16;
+
+GLPixelBufferPool::~GLPixelBufferPool()
+{
+    Clear();
+}
+
+GLPixelBufferPool& GLPixelBufferPool::Get()
+{
+    static GLPixelBufferPool instance;
+    return instance;
+}
+
+void GLPixelBufferPool::Clear()
+{
+    /* Delete all pixel buffer objects and clear container */
+    for (const auto& chunk : chunks_)
+    {
+        if (chunk.id != 0)
+            glDeleteBuffers(1, &(chunk.id));
+    }
+    chunks_.clear();
+    currentChunk_ = 0;
+}
+
+bool GLPixelBufferPool::WriteTexture(GLTexture& texture, const TextureRegion& region, const SrcImageDescriptor& imageDesc)
+{
+    #ifdef GL_ARB_map_buffer_range
+
+    /* Unsynchronized mapping and fences are required to keep uploads asynchronous */
+    if (!HasExtension(GLExt::ARB_map_buffer_range) || !HasExtension(GLExt::ARB_sync))
+        return false;
+
+    const auto size = static_cast<GLsizeiptr>(imageDesc.dataSize);
+    if (imageDesc.data == nullptr || size == 0 || size > g_pixelBufferChunkSize || texture.IsRenderbuffer())
+        return false;
+
+    auto& chunk = AllocChunk(size);
+
+    /* Copy image data into the unused range of the chunk; the range is guarded by the chunk's fence */
+    GLStateManager::Get().BindBuffer(GLBufferTarget::PIXEL_UNPACK_BUFFER, chunk.id);
+
+    void* dst = glMapBufferRange(
+        GL_PIXEL_UNPACK_BUFFER,
+        chunk.offset,
+        size,
+        (GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT)
+    );
+
+    if (dst == nullptr)
+    {
+        GLStateManager::Get().BindBuffer(GLBufferTarget::PIXEL_UNPACK_BUFFER, 0);
+        return false;
+    }
+
+    ::memcpy(dst, imageDesc.data, static_cast<std::size_t>(size));
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+    /* Write image sub data from currently bound unpack buffer with byte offset */
+    const SrcImageDescriptor bufferImageDesc
+    {
+        imageDesc.format,
+        imageDesc.dataType,
+        reinterpret_cast<const void*>(chunk.offset),
+        imageDesc.dataSize,
+        imageDesc.rowStride,
+        imageDesc.layerStride
+    };
+    texture.TextureSubImage(region, bufferImageDesc, false);
+
+    GLStateManager::Get().BindBuffer(GLBufferTarget::PIXEL_UNPACK_BUFFER, 0);
+
+    /* The new fence also covers all previous transfers from this chunk */
+    chunk.fence->Submit();
+    chunk.pending   = true;
+    chunk.offset    = GetAlignedSize<GLintptr>(chunk.offset + size, g_pixelBufferAlignment);
+
+    return true;
+
+    #else
+
+    return false;
+
+    #endif // /GL_ARB_map_buffer_range
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+GLPixelBufferPool::Chunk& GLPixelBufferPool::AllocChunk(GLsizeiptr size)
+{
+    if (chunks_.empty())
+        CreateChunk();
+
+    /* Move on to the next chunk if the current one is full */
+    if (chunks_[currentChunk_].offset + size > g_pixelBufferChunkSize)
+    {
+        if (chunks_.size() < g_maxNumPixelBufferChunks)
+        {
+            CreateChunk();
+            currentChunk_ = chunks_.size() - 1;
+        }
+        else
+        {
+            /* Wrap around and wait until the GPU has finished all transfers from the oldest chunk */
+            currentChunk_ = (currentChunk_ + 1) % chunks_.size();
+            auto& chunk = chunks_[currentChunk_];
+            if (chunk.pending)
+            {
+                chunk.fence->Wait(std::numeric_limits<GLuint64>::max());
+                chunk.pending = false;
+            }
+            chunk.offset = 0;
+        }
+    }
+
+    return chunks_[currentChunk_];
+}
+
+void GLPixelBufferPool::CreateChunk()
+{
+    Chunk chunk;
+    {
+        chunk.fence = MakeUnique<GLFence>();
+
+        /* Allocate pixel buffer object with mutable storage that is only ever written by the CPU */
+        glGenBuffers(1, &(chunk.id));
+        GLStateManager::Get().BindBuffer(GLBufferTarget::PIXEL_UNPACK_BUFFER, chunk.id);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, g_pixelBufferChunkSize, nullptr, GL_STREAM_DRAW);
+        GLStateManager::Get().BindBuffer(GLBufferTarget::PIXEL_UNPACK_BUFFER, 0);
+    }
+    chunks_.push_back(std::move(chunk));
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
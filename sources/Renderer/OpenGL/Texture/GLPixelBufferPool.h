@@ -0,0 +1,96 @@
+/*
+ * GLPixelBufferPool.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_PIXEL_BUFFER_POOL_H
+#define LLGL_GL_PIXEL_BUFFER_POOL_H
+
+
+#include <LLGL/TextureFlags.h>
+#include <LLGL/ImageFlags.h>
+#include "../OpenGL.h"
+#include "../RenderState/GLFence.h"
+#include <vector>
+#include <memory>
+
+
+namespace LLGL
+{
+
+
+class GLTexture;
+
+/*
+Singleton pool of pixel buffer objects (PBOs) for asynchronous texture uploads; used by <GLRenderSystem::WriteTexture>.
+Image data is copied into a mapped chunk of a PBO and transferred to the texture via GL_PIXEL_UNPACK_BUFFER,
+so the CPU returns immediately instead of waiting for the driver to consume the client memory.
+Each chunk is guarded by a fence and only waited on when the pool wraps around.
+*/
+class GLPixelBufferPool
+{
+
+    public:
+
+        // Returns the instance of this singleton.
+        static GLPixelBufferPool& Get();
+
+    public:
+
+        GLPixelBufferPool(const GLPixelBufferPool&) = delete;
+        GLPixelBufferPool& operator = (const GLPixelBufferPool&) = delete;
+
+        GLPixelBufferPool(GLPixelBufferPool&&) = delete;
+        GLPixelBufferPool& operator = (GLPixelBufferPool&&) = delete;
+
+        ~GLPixelBufferPool();
+
+        // Releases all resources for this singleton class.
+        void Clear();
+
+        /*
+        Writes the specified image data to a subregion of the texture through a pixel unpack buffer.
+        Returns false if the image data cannot be transferred by this pool, e.g. if it exceeds the chunk size.
+        */
+        bool WriteTexture(GLTexture& texture, const TextureRegion& region, const SrcImageDescriptor& imageDesc);
+
+    private:
+
+        GLPixelBufferPool() = default;
+
+    private:
+
+        struct Chunk
+        {
+            GLuint                      id          = 0;
+            GLintptr                    offset      = 0;
+            std::unique_ptr<GLFence>    fence;
+            bool                        pending     = false;
+        };
+
+    private:
+
+        // Returns the chunk that can hold the specified amount of data and waits for the GPU if that chunk is still in use.
+        Chunk& AllocChunk(GLsizeiptr size);
+
+        // Creates a new chunk with its own pixel buffer object.
+        void CreateChunk();
+
+    private:
+
+        std::vector<Chunk>  chunks_;
+        std::size_t         currentChunk_   = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -46,7 +46,7 @@ static GLint TextureOffsetToArrayLayer(const TextureType type, const Offset3D& o
 
 void GLReadTextureFBO::Attach(GLTexture& texture, GLint mipLevel, const Offset3D& offset)
 {
-    GLFramebuffer::AttachTexture(
+    fbo_.AttachNamedTexture(
         texture,
         GL_COLOR_ATTACHMENT0,
         static_cast<GLint>(mipLevel),
@@ -153,6 +153,9 @@ void GLRenderTarget::BlitOntoFramebuffer()
         framebufferMS_.Unbind(GLFramebufferTarget::READ_FRAMEBUFFER);
         framebuffer_.Unbind(GLFramebufferTarget::DRAW_FRAMEBUFFER);
     }
+
+    /* Discard content of transient renderbuffers, which is no longer needed once the render target is unbound */
+    InvalidateTransientAttachments();
 }
 
 /*
@@ -193,6 +196,23 @@ void GLRenderTarget::SetDrawBuffers()
         glDrawBuffers(static_cast<GLsizei>(colorAttachments_.size()), colorAttachments_.data());
 }
 
+void GLRenderTarget::SetDrawBuffers(std::uint32_t colorAttachmentMask)
+{
+    /* Replace draw buffers of all color attachments that are not included in the bitmask by GL_NONE */
+    GLenum drawBuffers[LLGL_MAX_NUM_COLOR_ATTACHMENTS];
+    const auto numDrawBuffers = std::min<std::size_t>(colorAttachments_.size(), LLGL_MAX_NUM_COLOR_ATTACHMENTS);
+
+    for (std::size_t i = 0; i < numDrawBuffers; ++i)
+        drawBuffers[i] = ((colorAttachmentMask & (1u << i)) != 0 ? colorAttachments_[i] : GL_NONE);
+
+    if (numDrawBuffers == 0)
+        GLProfile::DrawBuffer(GL_NONE);
+    else if (numDrawBuffers == 1)
+        GLProfile::DrawBuffer(drawBuffers[0]);
+    else
+        glDrawBuffers(static_cast<GLsizei>(numDrawBuffers), drawBuffers);
+}
+
 
 /*
  * ======= Private: =======
@@ -243,6 +263,18 @@ void GLRenderTarget::CreateFramebufferWithAttachments(const RenderTargetDescript
             /* Create all renderbuffers as storage source for multi-sampled render target */
             CreateRenderbuffersMS(internalFormats);
         }
+
+        /* Store multi-sampled renderbuffers of transient color attachments */
+        std::size_t colorAttachmentIndex = 0;
+        for (const auto& attachmentDesc : desc.attachments)
+        {
+            if (attachmentDesc.type == AttachmentType::Color)
+            {
+                if (attachmentDesc.transient && colorAttachmentIndex < colorAttachments_.size())
+                    transientAttachments_.push_back(colorAttachments_[colorAttachmentIndex]);
+                ++colorAttachmentIndex;
+            }
+        }
     }
 }
 
@@ -276,7 +308,7 @@ void GLRenderTarget::CreateFramebufferWithNoAttachments(const RenderTargetDescri
         );
 
         /* Attach dummy renderbuffer to first color attachment slot */
-        framebuffer_.AttachRenderbuffer(GL_COLOR_ATTACHMENT0, renderbuffer_.GetID());
+        framebuffer_.AttachNamedRenderbuffer(GL_COLOR_ATTACHMENT0, renderbuffer_.GetID());
     }
 
     /* Validate framebuffer status */
@@ -311,12 +343,18 @@ void GLRenderTarget::AttachAllDepthStencilBuffers(const std::vector<AttachmentDe
                     break;
                 case AttachmentType::Depth:
                     AttachDepthBuffer();
+                    if (attachmentDesc.transient)
+                        transientAttachments_.push_back(GL_DEPTH_ATTACHMENT);
                     break;
                 case AttachmentType::DepthStencil:
                     AttachDepthStencilBuffer();
+                    if (attachmentDesc.transient)
+                        transientAttachments_.push_back(GL_DEPTH_STENCIL_ATTACHMENT);
                     break;
                 case AttachmentType::Stencil:
                     AttachStencilBuffer();
+                    if (attachmentDesc.transient)
+                        transientAttachments_.push_back(GL_STENCIL_ATTACHMENT);
                     break;
             }
         }
@@ -357,7 +395,7 @@ void GLRenderTarget::AttachTexture(Texture& texture, const AttachmentDescriptor&
     auto attachment = MakeFramebufferAttachment(attachmentDesc.type);
 
     /* Attach texture to framebuffer */
-    GLFramebuffer::AttachTexture(textureGL, attachment, static_cast<GLint>(mipLevel), static_cast<GLint>(attachmentDesc.arrayLayer));
+    framebuffer_.AttachNamedTexture(textureGL, attachment, static_cast<GLint>(mipLevel), static_cast<GLint>(attachmentDesc.arrayLayer));
 }
 
 void GLRenderTarget::CreateRenderbuffersMS(const GLenum* internalFormats)
@@ -385,11 +423,22 @@ void GLRenderTarget::CreateRenderbufferMS(GLenum attachment, GLenum internalForm
         InitRenderbufferStorage(renderbuffer, internalFormat);
 
         /* Attach renderbuffer to multi-sample framebuffer */
-        GLFramebuffer::AttachRenderbuffer(attachment, renderbuffer.GetID());
+        framebufferMS_.AttachNamedRenderbuffer(attachment, renderbuffer.GetID());
     }
     renderbuffersMS_.emplace_back(std::move(renderbuffer));
 }
 
+void GLRenderTarget::InvalidateTransientAttachments()
+{
+    #ifdef LLGL_GLEXT_INVALIDATE_SUBDATA
+    if (!transientAttachments_.empty() && HasExtension(GLExt::ARB_invalidate_subdata))
+    {
+        GetFramebuffer().Bind(GLFramebufferTarget::DRAW_FRAMEBUFFER);
+        glInvalidateFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLsizei>(transientAttachments_.size()), transientAttachments_.data());
+    }
+    #endif // /LLGL_GLEXT_INVALIDATE_SUBDATA
+}
+
 void GLRenderTarget::InitRenderbufferStorage(GLRenderbuffer& renderbuffer, GLenum internalFormat)
 {
     renderbuffer.BindAndAllocStorage(
@@ -411,7 +460,7 @@ void GLRenderTarget::CreateAndAttachRenderbuffer(GLenum internalFormat, GLenum a
         InitRenderbufferStorage(renderbuffer_, internalFormat);
 
         /* Attach renderbuffer to framebuffer (or multi-sample framebuffer if multi-sampling is used) */
-        GLFramebuffer::AttachRenderbuffer(attachment, renderbuffer_.GetID());
+        GetFramebuffer().AttachNamedRenderbuffer(attachment, renderbuffer_.GetID());
     }
     else
         ErrDepthAttachmentFailed();
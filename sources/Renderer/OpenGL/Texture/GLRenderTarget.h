@@ -55,6 +55,9 @@ class GLRenderTarget final : public RenderTarget
         // Sets the draw buffers for the currently bound FBO.
         void SetDrawBuffers();
 
+        // Sets the draw buffers for the currently bound FBO but only enables the color attachments in the specified bitmask, e.g. for a sub-pass.
+        void SetDrawBuffers(std::uint32_t colorAttachmentMask);
+
     private:
 
         void CreateFramebufferWithAttachments(const RenderTargetDescriptor& desc);
@@ -79,6 +82,9 @@ class GLRenderTarget final : public RenderTarget
         void CreateRenderbuffersMS(const GLenum* internalFormats);
         void CreateRenderbufferMS(GLenum attachment, GLenum internalFormat);
 
+        // Invalidates the content of all transient attachments of the active framebuffer.
+        void InvalidateTransientAttachments();
+
         bool HasMultiSampling() const;
         bool HasCustomMultiSampling() const;
         bool HasDepthStencilAttachment() const;
@@ -102,6 +108,7 @@ class GLRenderTarget final : public RenderTarget
         std::vector<GLRenderbuffer> renderbuffersMS_;
 
         std::vector<GLenum>         colorAttachments_;
+        std::vector<GLenum>         transientAttachments_;  // Renderbuffer attachments of the active framebuffer that are invalidated when this render target is unbound
 
         GLsizei                     samples_            = 1;
         GLbitfield                  blitMask_           = 0;
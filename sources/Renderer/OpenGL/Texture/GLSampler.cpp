@@ -16,21 +16,9 @@ namespace LLGL
 {
 
 
-GLSampler::GLSampler()
-{
-    glGenSamplers(1, &id_);
-}
-
-GLSampler::~GLSampler()
-{
-    glDeleteSamplers(1, &id_);
-    GLStateManager::Get().NotifySamplerRelease(id_);
-}
-
-void GLSampler::SetName(const char* name)
-{
-    GLSetObjectLabel(GL_SAMPLER, GetID(), name);
-}
+/*
+ * GLNativeSampler class
+ */
 
 static GLenum GetGLSamplerMinFilter(const SamplerDescriptor& desc)
 {
@@ -40,8 +28,10 @@ static GLenum GetGLSamplerMinFilter(const SamplerDescriptor& desc)
         return GLTypes::Map(desc.minFilter);
 }
 
-void GLSampler::SetDesc(const SamplerDescriptor& desc)
+GLNativeSampler::GLNativeSampler(const SamplerDescriptor& desc)
 {
+    glGenSamplers(1, &id_);
+
     /* Set texture coordinate wrap modes */
     glSamplerParameteri(id_, GL_TEXTURE_WRAP_S, GLTypes::Map(desc.addressModeU));
     glSamplerParameteri(id_, GL_TEXTURE_WRAP_T, GLTypes::Map(desc.addressModeV));
@@ -76,6 +66,40 @@ void GLSampler::SetDesc(const SamplerDescriptor& desc)
     #endif
 }
 
+GLNativeSampler::~GLNativeSampler()
+{
+    glDeleteSamplers(1, &id_);
+    GLStateManager::Get().NotifySamplerRelease(id_);
+}
+
+
+/*
+ * GLSampler class
+ */
+
+GLSampler::GLSampler(GLSamplerCache& samplerCache, const SamplerDescriptor& desc) :
+    samplerCache_ { samplerCache },
+    desc_         { desc         }
+{
+    native_ = samplerCache.GetOrCreate(
+        desc,
+        [&desc]()
+        {
+            return std::make_shared<GLNativeSampler>(desc);
+        }
+    );
+}
+
+GLSampler::~GLSampler()
+{
+    samplerCache_.Release(desc_, std::move(native_));
+}
+
+void GLSampler::SetName(const char* name)
+{
+    GLSetObjectLabel(GL_SAMPLER, GetID(), name);
+}
+
 
 } // /namespace LLGL
 
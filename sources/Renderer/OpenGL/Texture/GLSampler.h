@@ -9,37 +9,67 @@
 #define LLGL_GL_SAMPLER_H
 
 
-#include "../OpenGL.h"
 #include <LLGL/Sampler.h>
+#include "../../SamplerCache.h"
+#include "../OpenGL.h"
+#include <memory>
 
 
 namespace LLGL
 {
 
 
+// Native GL sampler object that is shared between all GLSampler instances with equal descriptors.
+class GLNativeSampler
+{
+
+    public:
+
+        GLNativeSampler(const SamplerDescriptor& desc);
+        ~GLNativeSampler();
+
+        GLNativeSampler(const GLNativeSampler&) = delete;
+        GLNativeSampler& operator = (const GLNativeSampler&) = delete;
+
+        //! Returns the hardware sampler ID.
+        inline GLuint GetID() const
+        {
+            return id_;
+        }
+
+    private:
+
+        GLuint id_ = 0;
+
+};
+
+using GLSamplerCache = SamplerCache<GLNativeSampler>;
+
 class GLSampler final : public Sampler
 {
 
     public:
 
+        // Sets the label of the shared native sampler, i.e. all samplers with the same descriptor share the same label.
         void SetName(const char* name) override;
 
     public:
 
-        GLSampler();
+        // Shares the native sampler with all other samplers of the same descriptor in the specified cache.
+        GLSampler(GLSamplerCache& samplerCache, const SamplerDescriptor& desc);
         ~GLSampler();
 
-        void SetDesc(const SamplerDescriptor& desc);
-
         //! Returns the hardware sampler ID.
         inline GLuint GetID() const
         {
-            return id_;
+            return native_->GetID();
         }
 
     private:
 
-        GLuint id_ = 0;
+        GLSamplerCache&                     samplerCache_;
+        SamplerDescriptor                   desc_;
+        std::shared_ptr<GLNativeSampler>    native_;
 
 };
 
@@ -6,10 +6,13 @@
  */
 
 #include "GLTexImage.h"
+#include "GLTextureSubImage.h"
 #include "../GLTypes.h"
 #include "../GLProfile.h"
 #include "../Ext/GLExtensions.h"
 #include "../Ext/GLExtensionRegistry.h"
+#include "../../../Core/ImageDecompressor.h"
+#include <LLGL/Constants.h>
 #include <array>
 #include <algorithm>
 
@@ -1070,12 +1073,50 @@ static void GLTexImage2DMSArray(const TextureDescriptor& desc)
 
 #endif
 
+// Allocates an uncompressed texture for the specified compressed format and decompresses the initial image data on the CPU.
+static bool GLTexImageDecompressed(const TextureDescriptor& desc, const SrcImageDescriptor* imageDesc)
+{
+    TextureDescriptor decompressedDesc = desc;
+    decompressedDesc.format = GetDecompressedFormat(desc.format);
+
+    if (decompressedDesc.format == Format::Undefined)
+        return false;
+
+    if (imageDesc != nullptr && IsCompressedFormat(imageDesc->format))
+    {
+        /* Each array layer and cube face is a separately compressed image slice */
+        const Extent3D compressedExtent
+        {
+            desc.extent.width,
+            desc.extent.height,
+            desc.extent.depth * desc.arrayLayers
+        };
+
+        auto decompressedData = DecompressImageBuffer(*imageDesc, compressedExtent, Constants::maxThreadCount);
+
+        const SrcImageDescriptor decompressedImageDesc
+        {
+            GetDecompressedImageFormat(imageDesc->format),
+            imageDesc->dataType,
+            decompressedData.get(),
+            GetMemoryFootprint(
+                GetDecompressedImageFormat(imageDesc->format),
+                imageDesc->dataType,
+                static_cast<std::size_t>(compressedExtent.width) * compressedExtent.height * compressedExtent.depth
+            )
+        };
+
+        return GLTexImage(decompressedDesc, &decompressedImageDesc);
+    }
+
+    return GLTexImage(decompressedDesc, imageDesc);
+}
+
 bool GLTexImage(const TextureDescriptor& desc, const SrcImageDescriptor* imageDesc)
 {
-    //TODO: on-the-fly decompression would be awesome (if GL_ARB_texture_compression is unsupported), but a lot of work :-/
-    /* If compressed format is requested, GL_ARB_texture_compression must be supported */
+    /* If GL_ARB_texture_compression is unsupported, fall back to an uncompressed texture and decompress the image data on the CPU */
     if (IsCompressedFormat(desc.format) && !HasExtension(GLExt::ARB_texture_compression))
-        return false;
+        return GLTexImageDecompressed(desc, imageDesc);
 
     switch (desc.type)
     {
@@ -1128,6 +1169,127 @@ bool GLTexImage(const TextureDescriptor& desc, const SrcImageDescriptor* imageDe
     return true;
 }
 
+#if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+
+// Returns true if the clear value of the specified descriptor can be applied after the named texture storage has been allocated.
+static bool CanClearNamedTexture(const TextureDescriptor& desc)
+{
+    if (!IsClearValueEnabled(desc) || IsCompressedFormat(desc.format) || IsMultiSampleTexture(desc.type))
+        return true;
+    #ifdef GL_ARB_clear_texture
+    return HasExtension(GLExt::ARB_clear_texture);
+    #else
+    return false;
+    #endif
+}
+
+static void GLTextureStorageBase(GLuint texID, const TextureDescriptor& desc, GLenum internalFormat)
+{
+    const auto mipLevels    = static_cast<GLsizei>(NumMipLevels(desc));
+    const auto sx           = static_cast<GLsizei>(desc.extent.width);
+    const auto sy           = static_cast<GLsizei>(desc.extent.height);
+    const auto sz           = static_cast<GLsizei>(desc.extent.depth);
+    const auto layers       = static_cast<GLsizei>(desc.arrayLayers);
+    const auto samples      = static_cast<GLsizei>(desc.samples);
+    const auto fixedSamples = static_cast<GLboolean>((desc.miscFlags & MiscFlags::FixedSamples) != 0 ? GL_TRUE : GL_FALSE);
+
+    switch (desc.type)
+    {
+        case TextureType::Texture1D:
+            glTextureStorage1D(texID, mipLevels, internalFormat, sx);
+            break;
+
+        case TextureType::Texture2D:
+        case TextureType::TextureCube:
+            glTextureStorage2D(texID, mipLevels, internalFormat, sx, sy);
+            break;
+
+        case TextureType::Texture3D:
+            glTextureStorage3D(texID, mipLevels, internalFormat, sx, sy, sz);
+            break;
+
+        case TextureType::Texture1DArray:
+            glTextureStorage2D(texID, mipLevels, internalFormat, sx, layers);
+            break;
+
+        case TextureType::Texture2DArray:
+        case TextureType::TextureCubeArray:
+            glTextureStorage3D(texID, mipLevels, internalFormat, sx, sy, layers);
+            break;
+
+        case TextureType::Texture2DMS:
+            glTextureStorage2DMultisample(texID, samples, internalFormat, sx, sy, fixedSamples);
+            break;
+
+        case TextureType::Texture2DMSArray:
+            glTextureStorage3DMultisample(texID, samples, internalFormat, sx, sy, layers, fixedSamples);
+            break;
+    }
+}
+
+static void GLTextureInitialImage(GLuint texID, const TextureDescriptor& desc, const SrcImageDescriptor& imageDesc, GLenum internalFormat)
+{
+    /* Upload the highest MIP level of all array layers at once; cube faces are addressed like array layers with DSA */
+    TextureRegion region;
+    {
+        region.subresource.numArrayLayers   = desc.arrayLayers;
+        region.extent                       = desc.extent;
+    }
+    const auto type = (desc.type == TextureType::TextureCube ? TextureType::Texture2DArray : desc.type);
+    GLTextureSubImage(texID, type, region, imageDesc, internalFormat);
+}
+
+#ifdef GL_ARB_clear_texture
+
+static void GLClearNamedTexture(GLuint texID, const TextureDescriptor& desc, const Format internalFormat)
+{
+    /* Only the highest MIP level is initialized with the clear value, same as with GLTexImage */
+    if (IsStencilFormat(desc.format))
+    {
+        const GLDepthStencilPair value{ desc.clearValue.depth, static_cast<std::uint8_t>(desc.clearValue.stencil) };
+        glClearTexImage(texID, 0, GL_DEPTH_STENCIL, GL_FLOAT_32_UNSIGNED_INT_24_8_REV, &value);
+    }
+    else if (IsDepthFormat(desc.format))
+    {
+        /* Depth formats that were converted to color formats are cleared via the red component */
+        const GLenum format = (IsDepthFormat(internalFormat) ? GL_DEPTH_COMPONENT : GL_RED);
+        glClearTexImage(texID, 0, format, GL_FLOAT, &(desc.clearValue.depth));
+    }
+    else if (CanInitializeTexWithRGBAf(desc))
+        glClearTexImage(texID, 0, GL_RGBA, GL_FLOAT, desc.clearValue.color.Ptr());
+}
+
+#endif // /GL_ARB_clear_texture
+
+bool GLTextureStorage(GLuint texID, const TextureDescriptor& desc, const SrcImageDescriptor* imageDesc)
+{
+    /* Textures that must be decompressed on the CPU or cleared without GL_ARB_clear_texture take the bind-to-edit path */
+    if (IsCompressedFormat(desc.format) && !HasExtension(GLExt::ARB_texture_compression))
+        return false;
+    if (imageDesc == nullptr && !CanClearNamedTexture(desc))
+        return false;
+
+    /* Allocate immutable texture storage */
+    const auto internalFormat   = FindSuitableDepthFormat(desc);
+    const auto internalFormatGL = GLTypes::Map(internalFormat);
+    GLTextureStorageBase(texID, desc, internalFormatGL);
+
+    /* Initialize highest MIP level with image data or clear value */
+    if (IsMultiSampleTexture(desc.type))
+        return true;
+
+    if (imageDesc != nullptr)
+        GLTextureInitialImage(texID, desc, *imageDesc, internalFormatGL);
+    #ifdef GL_ARB_clear_texture
+    else if (IsClearValueEnabled(desc) && !IsCompressedFormat(desc.format))
+        GLClearNamedTexture(texID, desc, internalFormat);
+    #endif
+
+    return true;
+}
+
+#endif // /GL_ARB_direct_state_access && LLGL_GL_ENABLE_DSA_EXT
+
 
 } // /namespace LLGL
 
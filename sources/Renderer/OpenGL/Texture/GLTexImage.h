@@ -11,6 +11,7 @@
 
 #include <LLGL/ImageFlags.h>
 #include <LLGL/TextureFlags.h>
+#include "../OpenGL.h"
 
 
 namespace LLGL
@@ -20,6 +21,16 @@ namespace LLGL
 // Allocates the texture storage with optional initial image data for the currently bound GL texture.
 bool GLTexImage(const TextureDescriptor& desc, const SrcImageDescriptor* imageDesc);
 
+#if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+
+/*
+Allocates the immutable texture storage with optional initial image data for the specified GL texture without binding it; requires extension "GL_ARB_direct_state_access".
+Returns false if the texture must be allocated with GLTexImage instead, e.g. when compressed image data must be decompressed on the CPU.
+*/
+bool GLTextureStorage(GLuint texID, const TextureDescriptor& desc, const SrcImageDescriptor* imageDesc);
+
+#endif
+
 
 } // /namespace LLGL
 
@@ -10,6 +10,8 @@
 #include "../GLTypes.h"
 #include "../Ext/GLExtensions.h"
 #include "../Ext/GLExtensionRegistry.h"
+#include "../../../Core/ImageDecompressor.h"
+#include <LLGL/Constants.h>
 #include <array>
 #include <algorithm>
 
@@ -427,16 +429,47 @@ static void GLTexSubImageCubeArray(const TextureRegion& region, const SrcImageDe
 
 #endif
 
+// Decompresses the specified image data on the CPU and writes it into the uncompressed texture region.
+static bool GLTexSubImageDecompressed(
+    const TextureType           type,
+    const TextureRegion&        region,
+    const SrcImageDescriptor&   imageDesc,
+    GLenum                      internalFormat)
+{
+    /* Each array layer and cube face is a separately compressed image slice */
+    const Extent3D compressedExtent
+    {
+        region.extent.width,
+        region.extent.height,
+        region.extent.depth * region.subresource.numArrayLayers
+    };
+
+    auto decompressedData = DecompressImageBuffer(imageDesc, compressedExtent, Constants::maxThreadCount);
+
+    const SrcImageDescriptor decompressedImageDesc
+    {
+        GetDecompressedImageFormat(imageDesc.format),
+        imageDesc.dataType,
+        decompressedData.get(),
+        GetMemoryFootprint(
+            GetDecompressedImageFormat(imageDesc.format),
+            imageDesc.dataType,
+            static_cast<std::size_t>(compressedExtent.width) * compressedExtent.height * compressedExtent.depth
+        )
+    };
+
+    return GLTexSubImage(type, region, decompressedImageDesc, internalFormat);
+}
+
 bool GLTexSubImage(
     const TextureType           type,
     const TextureRegion&        region,
     const SrcImageDescriptor&   imageDesc,
     GLenum                      internalFormat)
 {
-    //TODO: on-the-fly decompression would be awesome (if GL_ARB_texture_compression is unsupported), but a lot of work :-/
-    /* If compressed format is requested, GL_ARB_texture_compression must be supported */
+    /* If GL_ARB_texture_compression is unsupported, the texture was allocated with an uncompressed format, so decompress the image data on the CPU */
     if (IsCompressedFormat(imageDesc.format) && !HasExtension(GLExt::ARB_texture_compression))
-        return false;
+        return GLTexSubImageDecompressed(type, region, imageDesc, internalFormat);
 
     switch (type)
     {
@@ -78,13 +78,21 @@ static GLSwizzleFormat MapSwizzleFormat(const Format format)
         return GLSwizzleFormat::RGBA;
 }
 
-GLTexture::GLTexture(const TextureDescriptor& desc) :
-    Texture         { desc.type, desc.bindFlags                },
-    numMipLevels_   { static_cast<GLsizei>(NumMipLevels(desc)) },
-    isRenderbuffer_ { IsRenderbufferSufficient(desc)           },
-    swizzleFormat_  { MapSwizzleFormat(desc.format)            }
+GLTexture::GLTexture(const TextureDescriptor& desc, GLuint nativeID) :
+    Texture         { desc.type, desc.bindFlags                         },
+    numMipLevels_   { static_cast<GLsizei>(NumMipLevels(desc))          },
+    isRenderbuffer_ { (nativeID == 0 && IsRenderbufferSufficient(desc)) },
+    swizzleFormat_  { MapSwizzleFormat(desc.format)                     }
 {
-    if (IsRenderbuffer())
+    if (nativeID != 0)
+    {
+        /* Take native GL texture object without ownership and query its internal format */
+        id_     = nativeID;
+        ownsID_ = false;
+        GLStateManager::Get().BindTexture(GLStateManager::GetTextureTarget(GetType()), id_);
+        QueryInternalFormat();
+    }
+    else if (IsRenderbuffer())
     {
         #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
         if (HasExtension(GLExt::ARB_direct_state_access))
@@ -134,7 +142,10 @@ GLTexture::~GLTexture()
     else
     {
         /* Delete texture and notify state manager as well as texture-view pool since this could be the source for a texture-view */
-        GLStateManager::Get().DeleteTexture(id_, GLStateManager::GetTextureTarget(GetType()));
+        if (ownsID_)
+            GLStateManager::Get().DeleteTexture(id_, GLStateManager::GetTextureTarget(GetType()));
+        else
+            GLStateManager::Get().NotifyTextureRelease(id_, GLStateManager::GetTextureTarget(GetType()));
         GLTextureViewPool::Get().NotifyTextureRelease(id_);
     }
 }
@@ -339,6 +350,30 @@ static void InitializeGLTextureSwizzle(GLenum target, const TextureSwizzleRGBA&
     glTexParameteri(target, GL_TEXTURE_SWIZZLE_A, GLTypes::Map(swizzle.a));
 }
 
+#if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+
+static void InitializeGLNamedTextureSwizzle(GLuint texID, const TextureSwizzleRGBA& swizzle)
+{
+    glTextureParameteri(texID, GL_TEXTURE_SWIZZLE_R, GLTypes::Map(swizzle.r));
+    glTextureParameteri(texID, GL_TEXTURE_SWIZZLE_G, GLTypes::Map(swizzle.g));
+    glTextureParameteri(texID, GL_TEXTURE_SWIZZLE_B, GLTypes::Map(swizzle.b));
+    glTextureParameteri(texID, GL_TEXTURE_SWIZZLE_A, GLTypes::Map(swizzle.a));
+}
+
+#endif // /GL_ARB_direct_state_access
+
+// Maps swizzle parameters according to the permutation format
+static TextureSwizzleRGBA GetTextureSwizzlePermutation(const GLSwizzleFormat swizzleFormat, const TextureSwizzleRGBA& swizzle)
+{
+    switch (swizzleFormat)
+    {
+        case GLSwizzleFormat::RGBA:     return swizzle;
+        case GLSwizzleFormat::BGRA:     return GetTextureSwizzlePermutationBGRA(swizzle);
+        case GLSwizzleFormat::Alpha:    return GetTextureSwizzlePermutationAlpha(swizzle);
+    }
+    return swizzle;
+}
+
 static void InitializeGLTextureSwizzleWithFormat(
     const TextureType           type,
     const GLSwizzleFormat       swizzleFormat,
@@ -349,22 +384,7 @@ static void InitializeGLTextureSwizzleWithFormat(
     if (swizzleFormat == GLSwizzleFormat::RGBA && ignoreIdentitySwizzle)
         return;
 
-    /* Map swizzle parameters according for permutation format */
-    const auto target = GLTypes::Map(type);
-    switch (swizzleFormat)
-    {
-        case GLSwizzleFormat::RGBA:
-            InitializeGLTextureSwizzle(target, swizzle);
-            break;
-
-        case GLSwizzleFormat::BGRA:
-            InitializeGLTextureSwizzle(target, GetTextureSwizzlePermutationBGRA(swizzle));
-            break;
-
-        case GLSwizzleFormat::Alpha:
-            InitializeGLTextureSwizzle(target, GetTextureSwizzlePermutationAlpha(swizzle));
-            break;
-    }
+    InitializeGLTextureSwizzle(GLTypes::Map(type), GetTextureSwizzlePermutation(swizzleFormat, swizzle));
 }
 
 void GLTexture::TexParameterSwizzle(
@@ -615,10 +635,38 @@ void GLTexture::CopyImageFromBuffer(
     GLStateManager::Get().BindBuffer(GLBufferTarget::PIXEL_UNPACK_BUFFER, 0);
 }
 
+// Converts the row and layer strides (in bytes) of an image descriptor into pixel store row length and image height (in pixels).
+static bool GetPixelStoreStrides(
+    const ImageFormat   format,
+    const DataType      dataType,
+    std::uint32_t       rowStride,
+    std::uint32_t       layerStride,
+    GLint&              outRowLength,
+    GLint&              outImageHeight)
+{
+    /* Compressed images can only be transferred tightly packed */
+    if (rowStride == 0 || IsCompressedFormat(format))
+        return false;
+
+    const std::uint32_t bytesPerPixel = GetMemoryFootprint(format, dataType, 1);
+    if (bytesPerPixel == 0)
+        return false;
+
+    outRowLength    = static_cast<GLint>(rowStride / bytesPerPixel);
+    outImageHeight  = static_cast<GLint>(layerStride / rowStride);
+    return true;
+}
+
 void GLTexture::TextureSubImage(const TextureRegion& region, const SrcImageDescriptor& imageDesc, bool restoreBoundTexture)
 {
     if (!IsRenderbuffer())
     {
+        /* Configure unpack row length and image height for strided image data */
+        GLint rowLength = 0, imageHeight = 0;
+        const bool isStrided = GetPixelStoreStrides(imageDesc.format, imageDesc.dataType, imageDesc.rowStride, imageDesc.layerStride, rowLength, imageHeight);
+        if (isStrided)
+            GLStateManager::Get().SetPixelStoreUnpack(rowLength, imageHeight, 1);
+
         #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
         if (HasExtension(GLExt::ARB_direct_state_access))
         {
@@ -646,6 +694,9 @@ void GLTexture::TextureSubImage(const TextureRegion& region, const SrcImageDescr
                 GLTexSubImage(GetType(), region, imageDesc, GetGLInternalFormat());
             }
         }
+
+        if (isStrided)
+            GLStateManager::Get().SetPixelStoreUnpack(0, 0, 1);
     }
 }
 
@@ -783,6 +834,12 @@ void GLTexture::GetTextureSubImage(const TextureRegion& region, const DstImageDe
     {
         #ifdef LLGL_OPENGL
 
+        /* Configure pack row length and image height for strided image data */
+        GLint rowLength = 0, imageHeight = 0;
+        const bool isStrided = GetPixelStoreStrides(imageDesc.format, imageDesc.dataType, imageDesc.rowStride, imageDesc.layerStride, rowLength, imageHeight);
+        if (isStrided)
+            GLStateManager::Get().SetPixelStorePack(rowLength, imageHeight, 1);
+
         #ifdef GL_ARB_get_texture_sub_image
         if (HasExtension(GLExt::ARB_get_texture_sub_image))
         {
@@ -807,6 +864,9 @@ void GLTexture::GetTextureSubImage(const TextureRegion& region, const DstImageDe
                 GLGetTextureImage(*this, region, imageDesc);
         }
 
+        if (isStrided)
+            GLStateManager::Get().SetPixelStorePack(0, 0, 1);
+
         #else
 
         //TODO: copy texture to unpack buffer, then map buffer range to CPU memory
@@ -839,8 +899,52 @@ void GLTexture::BindTexParameters(const GL2XSampler& sampler)
  * ======= Private: =======
  */
 
+// Returns the initial image descriptor for the specified swizzle format, i.e. BGRA image data is converted for the RGBA texture storage.
+static const SrcImageDescriptor* GetSwizzledInitialImage(
+    const GLSwizzleFormat       swizzleFormat,
+    const SrcImageDescriptor*   imageDesc,
+    SrcImageDescriptor&         intermediateImageDesc)
+{
+    if (imageDesc != nullptr && swizzleFormat == GLSwizzleFormat::BGRA)
+    {
+        intermediateImageDesc = *imageDesc;
+        intermediateImageDesc.format = MapSwizzleImageFormat(imageDesc->format);
+        return &intermediateImageDesc;
+    }
+    return imageDesc;
+}
+
 void GLTexture::AllocTextureStorage(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc)
 {
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        /* Allocate texture storage without binding it, unless it must fall back to GLTexImage */
+        SrcImageDescriptor intermediateImageDesc;
+        const auto* initialImageDesc = GetSwizzledInitialImage(GetSwizzleFormat(), imageDesc, intermediateImageDesc);
+
+        if (GLTextureStorage(GetID(), textureDesc, initialImageDesc))
+        {
+            /* Initialize texture parameters for the first time (multi-sampled textures have no sampler state) */
+            if (!IsMultiSampleTexture(textureDesc.type))
+            {
+                glTextureParameteri(GetID(), GL_TEXTURE_MIN_FILTER, GetGlTextureMinFilter(textureDesc));
+                glTextureParameteri(GetID(), GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            }
+
+            /* Configure texture swizzling if format is not supported */
+            if (swizzleFormat_ != GLSwizzleFormat::RGBA)
+                InitializeGLNamedTextureSwizzle(GetID(), GetTextureSwizzlePermutation(swizzleFormat_, {}));
+
+            /* Generate MIP-maps if enabled */
+            if (imageDesc != nullptr && MustGenerateMipsOnCreate(textureDesc))
+                glGenerateTextureMipmap(GetID());
+
+            return;
+        }
+    }
+    #endif // /GL_ARB_direct_state_access
+
     /* Bind texture */
     GLStateManager::Get().BindGLTexture(*this);
 
@@ -855,13 +959,7 @@ void GLTexture::AllocTextureStorage(const TextureDescriptor& textureDesc, const
 
     /* Convert initial image data for texture swizzle formats */
     SrcImageDescriptor intermediateImageDesc;
-
-    if (imageDesc != nullptr && GetSwizzleFormat() == GLSwizzleFormat::BGRA)
-    {
-        intermediateImageDesc = *imageDesc;
-        intermediateImageDesc.format = MapSwizzleImageFormat(imageDesc->format);
-        imageDesc = &intermediateImageDesc;
-    }
+    imageDesc = GetSwizzledInitialImage(GetSwizzleFormat(), imageDesc, intermediateImageDesc);
 
     /* Build texture storage and upload image dataa */
     //GLStateManager::Get().BindBuffer(GLBufferTarget::PIXEL_UNPACK_BUFFER, 0);
@@ -888,10 +986,22 @@ void GLTexture::QueryInternalFormat()
 {
     GLint format = 0;
     {
-        if (IsRenderbuffer())
-            glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_INTERNAL_FORMAT, &format);
+        #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+        if (HasExtension(GLExt::ARB_direct_state_access))
+        {
+            if (IsRenderbuffer())
+                glGetNamedRenderbufferParameteriv(GetID(), GL_RENDERBUFFER_INTERNAL_FORMAT, &format);
+            else
+                glGetTextureLevelParameteriv(GetID(), 0, GL_TEXTURE_INTERNAL_FORMAT, &format);
+        }
         else
-            GLProfile::GetTexParameterInternalFormat(GetGLTexTarget(), &format);
+        #endif // /GL_ARB_direct_state_access
+        {
+            if (IsRenderbuffer())
+                glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_INTERNAL_FORMAT, &format);
+            else
+                GLProfile::GetTexParameterInternalFormat(GetGLTexTarget(), &format);
+        }
     }
     internalFormat_ = static_cast<GLenum>(format);
 }
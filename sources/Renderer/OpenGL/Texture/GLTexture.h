@@ -46,7 +46,8 @@ class GLTexture final : public Texture
 
     public:
 
-        GLTexture(const TextureDescriptor& desc);
+        // Creates a new GL texture or renderbuffer, or takes the specified native texture name without ownership if 'nativeID' is non-zero.
+        GLTexture(const TextureDescriptor& desc, GLuint nativeID = 0);
         ~GLTexture();
 
         // Initializes the texture storage with an optional image data; the texture will be bound to the current active texture unit.
@@ -155,6 +156,7 @@ class GLTexture final : public Texture
         GLenum              internalFormat_ = 0;
         GLsizei             numMipLevels_   = 1;
         bool                isRenderbuffer_ = false;
+        bool                ownsID_         = true;                     // False if a native texture was imported.
         GLSwizzleFormat     swizzleFormat_  = GLSwizzleFormat::RGBA;    // Identity texture swizzle by default
 
         #ifdef LLGL_OPENGLES3
@@ -13,18 +13,13 @@
 #include "../Ext/GLExtensions.h"
 #include "../Ext/GLExtensionRegistry.h"
 #include "../../CheckedCast.h"
-#include "../../../Core/ContainerUtils.h"
 #include "../../../Core/Helper.h"
-#include "../../../Core/HelperMacros.h"
-#include <algorithm>
 
 
 namespace LLGL
 {
 
 
-static const std::size_t g_maxNumReusableTextureViews = 16;
-
 GLTextureViewPool::~GLTextureViewPool()
 {
     Clear();
@@ -38,16 +33,68 @@ GLTextureViewPool& GLTextureViewPool::Get()
 
 void GLTextureViewPool::Clear()
 {
-    /* Delete all texture view GL objects and clear container */
-    for (const auto& texView : textureViews_)
+    /* Delete all texture view GL objects and clear containers */
+    for (const auto& entry : textureViews_)
     {
-        if (texView.texID != 0)
-            glDeleteTextures(1, &(texView.texID));
+        if (entry.second.texID != 0)
+            glDeleteTextures(1, &(entry.second.texID));
     }
+    for (const auto& evictedTexView : evictedTextureViews_)
+        glDeleteTextures(1, &(evictedTexView.texID));
+
     textureViews_.clear();
-    numReusableEntries_ = 0;
+    textureViewKeys_.clear();
+    unusedTextureViews_.clear();
+    evictedTextureViews_.clear();
+}
+
+#ifdef GL_ARB_texture_view
+
+static void InitializeTextureViewSwizzle(GLuint texID, const GLTextureTarget target, const TextureViewDescriptor& textureViewDesc)
+{
+    GLStateManager::Get().BindTexture(target, texID);
+    GLTexture::TexParameterSwizzle(textureViewDesc.type, textureViewDesc.format, textureViewDesc.swizzle);
 }
 
+static GLuint GenGLTextureView(GLuint sourceTexID, const TextureViewDescriptor& textureViewDesc, bool restoreBoundTexture)
+{
+    GLuint texID = 0;
+
+    /* Generate and initialize texture with texture-view description */
+    glGenTextures(1, &texID);
+    glTextureView(
+        texID,
+        GLTypes::Map(textureViewDesc.type),
+        sourceTexID,
+        GLTypes::Map(textureViewDesc.format),
+        textureViewDesc.subresource.baseMipLevel,
+        textureViewDesc.subresource.numMipLevels,
+        textureViewDesc.subresource.baseArrayLayer,
+        textureViewDesc.subresource.numArrayLayers
+    );
+
+    /* Initialize texture swizzle */
+    const auto target = GLStateManager::GetTextureTarget(textureViewDesc.type);
+    if (restoreBoundTexture)
+    {
+        /* Initialize texture view with swizzle parameters and store/restore bound texture slot */
+        GLStateManager::Get().PushBoundTexture(target);
+        {
+            InitializeTextureViewSwizzle(texID, target, textureViewDesc);
+        }
+        GLStateManager::Get().PopBoundTexture();
+    }
+    else
+    {
+        /* Initialize texture view with swizzle parameters */
+        InitializeTextureViewSwizzle(texID, target, textureViewDesc);
+    }
+
+    return texID;
+}
+
+#endif // /GL_ARB_texture_view
+
 GLuint GLTextureViewPool::CreateTextureView(GLuint sourceTexID, const TextureViewDescriptor& textureViewDesc, bool restoreBoundTexture)
 {
     #ifdef GL_ARB_texture_view
@@ -55,37 +102,37 @@ GLuint GLTextureViewPool::CreateTextureView(GLuint sourceTexID, const TextureVie
     if (!HasExtension(GLExt::ARB_texture_view))
         return 0;
 
-    /* Compress texture view descriptor for faster comparison and sorting */
-    GLTextureView texView;
+    /* Compress texture view descriptor for faster comparison and hashing */
+    GLTextureViewKey key;
     {
-        texView.sourceTexID = sourceTexID;
+        key.sourceTexID = sourceTexID;
+        CompressTextureViewDesc(key.view, textureViewDesc);
     }
-    CompressTextureViewDesc(texView.view, textureViewDesc);
 
     /* Try to find texture view with same parameters */
-    std::size_t insertionIndex = 0;
-    auto* sharedTexView = Utils::FindInSortedArray<GLTextureView>(
-        textureViews_.data(),
-        textureViews_.size(),
-        [&texView](const GLTextureView& rhs)
-        {
-            return GLTextureViewPool::CompareTextureViewSWO(texView, rhs);
-        },
-        &insertionIndex
-    );
-
-    if (sharedTexView != nullptr)
+    auto it = textureViews_.find(key);
+    if (it != textureViews_.end())
     {
-        /* Create a shared GL texture view from the descriptor */
-        return CreateGLTextureView(*sharedTexView, textureViewDesc, true, restoreBoundTexture);
+        /* Share existing GL texture view and reclaim it from the unused texture views */
+        auto& texView = it->second;
+        if (texView.refCount == 0)
+            RetainUnusedGLTextureView(texView);
+        texView.refCount++;
+        return texView.texID;
     }
-    else
+
+    /* Create new GL texture view */
+    GLuint texID = GenGLTextureView(sourceTexID, textureViewDesc, restoreBoundTexture);
+    if (texID != 0)
     {
-        /* Create new GL texture view and store it with insertion sort */
-        GLuint texID = CreateGLTextureView(texView, textureViewDesc, false, restoreBoundTexture);
-        textureViews_.insert(textureViews_.begin() + insertionIndex, texView);
-        return texID;
+        auto& texView = textureViews_[key];
+        {
+            texView.texID       = texID;
+            texView.refCount    = 1;
+        }
+        textureViewKeys_[texID] = key;
     }
+    return texID;
 
     #else
 
@@ -96,51 +143,46 @@ GLuint GLTextureViewPool::CreateTextureView(GLuint sourceTexID, const TextureVie
 
 void GLTextureViewPool::ReleaseTextureView(GLuint texID)
 {
-    /* Try to find texture by GL texture ID only */
-    std::size_t insertionIndex = 0;
-    auto* sharedTexView = Utils::FindInSortedArray<GLTextureView>(
-        textureViews_.data(),
-        textureViews_.size(),
-        [texID](const GLTextureView& rhs)
-        {
-            LLGL_COMPARE_SEPARATE_MEMBERS_SWO(texID, rhs.texID);
-            return 0;
-        },
-        &insertionIndex
-    );
-
-    if (sharedTexView != nullptr)
+    /* Find texture view by GL texture ID */
+    auto keyIt = textureViewKeys_.find(texID);
+    if (keyIt != textureViewKeys_.end())
     {
-        /* Delete GL texture view if the reference counter reaches 0 */
-        ReleaseSharedGLTextureView(*sharedTexView);
-
-        /* Remove unused entries in the array after a given amount has been freed */
-        if (numReusableEntries_ > g_maxNumReusableTextureViews)
-            FlushReusableTextureViews();
+        auto it = textureViews_.find(keyIt->second);
+        if (it != textureViews_.end())
+            ReleaseSharedGLTextureView(it);
     }
 }
 
 void GLTextureViewPool::NotifyTextureRelease(GLuint sourceTexID)
 {
-    /* Move all objects that are about to be removed at the end of the list using 'std::remove' */
-    auto it = std::remove_if(
-        textureViews_.begin(),
-        textureViews_.end(),
-        [sourceTexID](const GLTextureView& entry)
+    /* Delete all texture views derived from the specified source texture immediately, since they keep its storage alive */
+    for (auto it = textureViews_.begin(); it != textureViews_.end();)
+    {
+        if (it->first.sourceTexID == sourceTexID)
         {
-            return (entry.texID == 0 || entry.sourceTexID == sourceTexID);
+            auto& texView = it->second;
+            if (texView.refCount == 0)
+                unusedTextureViews_.erase(texView.lruEntry);
+            DeleteGLTextureView(texView.texID, it->first.view.type);
+            textureViewKeys_.erase(texView.texID);
+            it = textureViews_.erase(it);
         }
-    );
-
-    /* Iterate over all elements to be deleted */
-    for (; it != textureViews_.end(); ++it)
-        DeleteGLTextureView(*it);
+        else
+            ++it;
+    }
+}
 
-    /* Finally remove the entries from the list */
-    textureViews_.erase(it, textureViews_.end());
+void GLTextureViewPool::SetMaxUnusedTextureViews(std::size_t maxUnusedTextureViews)
+{
+    maxUnusedTextureViews_ = maxUnusedTextureViews;
+    EvictUnusedTextureViews();
+}
 
-    /* Reset reusable entries, since we just deleted all unused entries */
-    numReusableEntries_ = 0;
+void GLTextureViewPool::FlushEvictedTextureViews()
+{
+    for (const auto& evictedTexView : evictedTextureViews_)
+        DeleteGLTextureView(evictedTexView.texID, evictedTexView.type);
+    evictedTextureViews_.clear();
 }
 
 
@@ -148,87 +190,25 @@ void GLTextureViewPool::NotifyTextureRelease(GLuint sourceTexID)
  * ======= Private: =======
  */
 
-int GLTextureViewPool::CompareTextureViewSWO(const GLTextureView& lhs, const GLTextureView& rhs)
+bool GLTextureViewPool::GLTextureViewKey::operator == (const GLTextureViewKey& rhs) const
 {
-    LLGL_COMPARE_MEMBER_SWO( sourceTexID );
-    return CompareCompressedTexViewSWO(lhs.view, rhs.view);
+    return (sourceTexID == rhs.sourceTexID && CompareCompressedTexViewSWO(view, rhs.view) == 0);
 }
 
-#ifdef GL_ARB_texture_view
-
-static void InitializeTextureViewSwizzle(GLuint texID, const GLTextureTarget target, const TextureViewDescriptor& textureViewDesc)
+static void HashCombine(std::size_t& seed, std::uint32_t value)
 {
-    GLStateManager::Get().BindTexture(target, texID);
-    GLTexture::TexParameterSwizzle(textureViewDesc.type, textureViewDesc.format, textureViewDesc.swizzle);
-}
-
-#endif // /GL_ARB_texture_view
-
-static GLuint GenGLTextureView(GLuint sourceTexID, const TextureViewDescriptor& textureViewDesc, bool restoreBoundTexture)
-{
-    GLuint texID = 0;
-
-    #ifdef GL_ARB_texture_view
-
-    if (HasExtension(GLExt::ARB_texture_view))
-    {
-        /* Generate and initialize texture with texture-view description */
-        glGenTextures(1, &texID);
-        glTextureView(
-            texID,
-            GLTypes::Map(textureViewDesc.type),
-            sourceTexID,
-            GLTypes::Map(textureViewDesc.format),
-            textureViewDesc.subresource.baseMipLevel,
-            textureViewDesc.subresource.numMipLevels,
-            textureViewDesc.subresource.baseArrayLayer,
-            textureViewDesc.subresource.numArrayLayers
-        );
-
-        /* Initialize texture swizzle */
-        const auto target = GLStateManager::GetTextureTarget(textureViewDesc.type);
-        if (restoreBoundTexture)
-        {
-            /* Initialize texture view with swizzle parameters and store/restore bound texture slot */
-            GLStateManager::Get().PushBoundTexture(target);
-            {
-                InitializeTextureViewSwizzle(texID, target, textureViewDesc);
-            }
-            GLStateManager::Get().PopBoundTexture();
-        }
-        else
-        {
-            /* Initialize texture view with swizzle parameters */
-            InitializeTextureViewSwizzle(texID, target, textureViewDesc);
-        }
-    }
-
-    #endif // /GL_ARB_texture_view
-
-    return texID;
+    seed ^= static_cast<std::size_t>(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
 }
 
-GLuint GLTextureViewPool::CreateGLTextureView(GLTextureView& texView, const TextureViewDescriptor& textureViewDesc, bool isSharedTex, bool restoreBoundTexture)
+std::size_t GLTextureViewPool::GLTextureViewKeyHash::operator () (const GLTextureViewKey& key) const
 {
-    if (isSharedTex)
-    {
-        if (texView.texID == 0)
-        {
-            /* Create new GL texture view if ID is invalid */
-            GLuint texID = GenGLTextureView(texView.sourceTexID, textureViewDesc, restoreBoundTexture);
-            RetainSharedGLTextureView(texView, texID);
-        }
-    }
-    else
-    {
-        /* Create a new GL texture view and initialize reference counter */
-        texView.texID = GenGLTextureView(texView.sourceTexID, textureViewDesc, restoreBoundTexture);
-    }
-
-    /* Increment reference counter for the shared texture view */
-    texView.refCount++;
-
-    return texView.texID;
+    std::size_t seed = 0;
+    HashCombine(seed, key.sourceTexID);
+    HashCombine(seed, key.view.base);
+    HashCombine(seed, key.view.firstMip);
+    HashCombine(seed, key.view.numLayers);
+    HashCombine(seed, key.view.firstLayer);
+    return seed;
 }
 
 // Uncompresses the specified 4-bit texture type to a 'GLTextureTarget' enum entry.
@@ -237,47 +217,50 @@ static GLTextureTarget UncompressGLTextureTarget(std::uint32_t type)
     return GLStateManager::GetTextureTarget(static_cast<TextureType>(type));
 }
 
-void GLTextureViewPool::DeleteGLTextureView(GLTextureView& texView)
+void GLTextureViewPool::DeleteGLTextureView(GLuint texID, std::uint32_t type)
 {
-    GLStateManager::Get().DeleteTexture(texView.texID, UncompressGLTextureTarget(texView.view.type));
+    GLStateManager::Get().DeleteTexture(texID, UncompressGLTextureTarget(type));
 }
 
-void GLTextureViewPool::RetainSharedGLTextureView(GLTextureView& texView, GLuint texID)
+void GLTextureViewPool::RetainUnusedGLTextureView(GLTextureView& texView)
 {
-    if (texView.texID == 0)
-    {
-        /* If this is shared texture view, reclaim one of the reusable entries */
-        texView.texID = texID;
-        if (numReusableEntries_ > 0)
-            --numReusableEntries_;
-    }
+    unusedTextureViews_.erase(texView.lruEntry);
+    texView.lruEntry = GLTextureViewLRUList::iterator{};
 }
 
-void GLTextureViewPool::ReleaseSharedGLTextureView(GLTextureView& texView)
+void GLTextureViewPool::ReleaseSharedGLTextureView(GLTextureViewMap::iterator it)
 {
+    auto& texView = it->second;
     if (texView.refCount > 0)
     {
         texView.refCount--;
         if (texView.refCount == 0)
         {
-            DeleteGLTextureView(texView);
-            ++numReusableEntries_;
+            /* Keep GL texture view alive for reuse as the most recently used entry */
+            texView.lruEntry = unusedTextureViews_.insert(unusedTextureViews_.end(), it->first);
+            EvictUnusedTextureViews();
         }
     }
 }
 
-void GLTextureViewPool::FlushReusableTextureViews()
+void GLTextureViewPool::EvictUnusedTextureViews()
 {
-    if (numReusableEntries_ > 0)
+    while (unusedTextureViews_.size() > maxUnusedTextureViews_)
     {
-        RemoveAllFromListIf(
-            textureViews_,
-            [](const GLTextureView& entry)
+        /* Remove least recently used texture view and defer its deletion until the end of the frame */
+        auto it = textureViews_.find(unusedTextureViews_.front());
+        if (it != textureViews_.end())
+        {
+            GLEvictedTextureView evictedTexView;
             {
-                return (entry.texID == 0);
+                evictedTexView.texID    = it->second.texID;
+                evictedTexView.type     = it->first.view.type;
             }
-        );
-        numReusableEntries_ = 0;
+            evictedTextureViews_.push_back(evictedTexView);
+            textureViewKeys_.erase(it->second.texID);
+            textureViews_.erase(it);
+        }
+        unusedTextureViews_.pop_front();
     }
 }
 
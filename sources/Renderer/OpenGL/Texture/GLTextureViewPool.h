@@ -12,6 +12,8 @@
 #include <LLGL/TextureFlags.h>
 #include <cstdint>
 #include <vector>
+#include <list>
+#include <unordered_map>
 #include "../OpenGL.h"
 #include "../../TextureUtils.h"
 
@@ -57,46 +59,80 @@ class GLTextureViewPool
         */
         void NotifyTextureRelease(GLuint sourceTexID);
 
+        /*
+        Sets the maximum number of unused texture views that are kept alive for reuse.
+        If this limit is exceeded, the least recently used texture views are evicted.
+        */
+        void SetMaxUnusedTextureViews(std::size_t maxUnusedTextureViews);
+
+        // Deletes all texture views that have been evicted during the last frame; called at the end of each frame.
+        void FlushEvictedTextureViews();
+
     private:
 
         GLTextureViewPool() = default;
 
     private:
 
+        // Structure that identifies a GL texture view by its source texture and compressed descriptor.
+        struct GLTextureViewKey
+        {
+            GLuint              sourceTexID = 0;
+            CompressedTexView   view;
+
+            bool operator == (const GLTextureViewKey& rhs) const;
+        };
+
+        struct GLTextureViewKeyHash
+        {
+            std::size_t operator () (const GLTextureViewKey& key) const;
+        };
+
+        using GLTextureViewLRUList = std::list<GLTextureViewKey>;
+
         // Structure that stores a GL texture that was generated with 'glTextureView'; managed by <GLTextureViewPool>
         struct GLTextureView
         {
-            GLuint              texID        = 0;
-            GLuint              sourceTexID  = 0;
-            GLuint              refCount     = 0;
-            CompressedTexView   view;
+            GLuint                          texID       = 0;
+            GLuint                          refCount    = 0;
+            GLTextureViewLRUList::iterator  lruEntry;           // Entry in the LRU list; only valid if 'refCount' is 0.
         };
 
-        // Compares the two texture views in a strict-weak-order (SWO).
-        static int CompareTextureViewSWO(const GLTextureView& lhs, const GLTextureView& rhs);
+        // Structure for a GL texture view that is waiting to be deleted at the end of the frame.
+        struct GLEvictedTextureView
+        {
+            GLuint          texID   = 0;
+            std::uint32_t   type    = 0;
+        };
 
-        // Creats a new GL texture view and stores it in the specified view entry.
-        GLuint CreateGLTextureView(GLTextureView& texView, const TextureViewDescriptor& textureViewDesc, bool isSharedTex, bool restoreBoundTexture);
+        using GLTextureViewMap = std::unordered_map<GLTextureViewKey, GLTextureView, GLTextureViewKeyHash>;
 
         // Deletes the specified GL texture view.
-        void DeleteGLTextureView(GLTextureView& texView);
+        void DeleteGLTextureView(GLuint texID, std::uint32_t type);
 
-        // Assignes the specified texture view a new GL texture ID and reclaims it as a reusable entry.
-        void RetainSharedGLTextureView(GLTextureView& texView, GLuint texID);
+        // Removes the specified entry from the LRU list of unused texture views.
+        void RetainUnusedGLTextureView(GLTextureView& texView);
 
-        // Release the specified GL texture object and marks the entry as reusable.
-        void ReleaseSharedGLTextureView(GLTextureView& texView);
+        // Decrements the reference counter of the specified texture view and moves it into the LRU list if it becomes unused.
+        void ReleaseSharedGLTextureView(GLTextureViewMap::iterator it);
 
-        // Removes all empty entries from the texture view list.
-        void FlushReusableTextureViews();
+        // Evicts the least recently used texture views until the limit of unused texture views is met.
+        void EvictUnusedTextureViews();
 
     private:
 
         // Container of all managed texture views.
-        std::vector<GLTextureView>  textureViews_;
+        GLTextureViewMap                                textureViews_;
+
+        // Reverse lookup from GL texture view ID to its key.
+        std::unordered_map<GLuint, GLTextureViewKey>    textureViewKeys_;
+
+        // Unused texture views in least-recently-used order, i.e. the front is evicted first.
+        GLTextureViewLRUList                            unusedTextureViews_;
+        std::size_t                                     maxUnusedTextureViews_  = 64;
 
-        // Number of textures that are already freed, but not removed from the texture view array yet.
-        std::size_t                 numReusableEntries_ = 0;
+        // Texture views whose deletion is deferred until the end of the frame.
+        std::vector<GLEvictedTextureView>               evictedTextureViews_;
 
 };
 
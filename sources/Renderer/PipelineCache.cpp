@@ -0,0 +1,891 @@
+/*
+ * PipelineCache.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/PipelineCache.h>
+#include <LLGL/RenderSystem.h>
+#include "../Core/Helper.h"
+#include "../Core/BlockCompressor.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/* ----- Archive layout ----- */
+
+// Magic number of pipeline cache archives, i.e. "LLPC" in little endian.
+static const std::uint32_t g_archiveMagic   = 0x43504C4C;
+
+// Version of the archive layout. Archives with a different version are rejected.
+static const std::uint32_t g_archiveVersion = 2;
+
+// Archive flag to specify that the archive stores a single device-wide cache instead of one cache for each PSO.
+static const std::uint32_t g_archiveFlagDeviceWide = 0x00000001;
+
+/*
+Archive layout:
+
+Offset      Content
+0x00000000  ArchiveHeader
+0x00000040  ArchiveIndexEntry[numEntries], sorted by key
+...         Cache data of the device-wide cache and all PSOs
+
+Each cache data range is stored either uncompressed (size == rawSize) or as a single LZ4 block (size < rawSize),
+and is checksummed with CRC-32 over its stored bytes. The index is checksummed as a whole, so it can be trusted after loading,
+whereas the cache data is only verified with its first use.
+*/
+struct ArchiveHeader
+{
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t rendererID;
+    std::uint32_t flags;
+    std::uint64_t driverHash;
+    std::uint64_t numEntries;
+    std::uint64_t deviceCacheOffset;
+    std::uint64_t deviceCacheSize;
+    std::uint64_t deviceCacheRawSize;
+    std::uint32_t deviceCacheChecksum;
+    std::uint32_t indexChecksum;
+};
+
+struct ArchiveIndexEntry
+{
+    std::uint64_t key;
+    std::uint64_t offset;
+    std::uint64_t size;
+    std::uint64_t rawSize;
+    std::uint32_t checksum;
+    std::uint32_t reserved;
+};
+
+
+/* ----- Hashing ----- */
+
+// FNV-1a hash over sequences of bytes, so the keys remain stable between application runs.
+class PipelineCacheHasher
+{
+
+    public:
+
+        void Write(const void* data, std::size_t size)
+        {
+            auto bytes = reinterpret_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                hash_ ^= bytes[i];
+                hash_ *= 0x100000001b3ull;
+            }
+        }
+
+        template <typename T>
+        void WriteValue(const T& value)
+        {
+            Write(&value, sizeof(value));
+        }
+
+        void WriteString(const char* s)
+        {
+            if (s != nullptr)
+                Write(s, std::strlen(s) + 1);
+            else
+                WriteValue('\0');
+        }
+
+        void WriteString(const std::string& s)
+        {
+            Write(s.c_str(), s.size() + 1);
+        }
+
+        // Returns the hash value, which is never zero so it can be distinguished from absent objects.
+        std::uint64_t GetHash() const
+        {
+            return (hash_ != 0 ? hash_ : 1);
+        }
+
+    private:
+
+        std::uint64_t hash_ = 0xcbf29ce484222325ull;
+
+};
+
+// Hashes the content of the specified file or only its filename if the file cannot be read.
+static void HashFile(PipelineCacheHasher& hasher, const char* filename)
+{
+    hasher.WriteString(filename);
+    std::ifstream file{ filename, std::ios::in | std::ios::binary };
+    if (file.good())
+    {
+        std::vector<char> content{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+        hasher.Write(content.data(), content.size());
+    }
+}
+
+static void HashShaderSource(PipelineCacheHasher& hasher, const ShaderDescriptor& desc)
+{
+    hasher.WriteValue(desc.sourceType);
+    if (desc.source == nullptr)
+        return;
+
+    switch (desc.sourceType)
+    {
+        case ShaderSourceType::CodeString:
+            hasher.Write(desc.source, (desc.sourceSize > 0 ? desc.sourceSize : std::strlen(desc.source)));
+            break;
+
+        case ShaderSourceType::BinaryBuffer:
+            hasher.Write(desc.source, desc.sourceSize);
+            break;
+
+        case ShaderSourceType::CodeFile:
+        case ShaderSourceType::BinaryFile:
+            HashFile(hasher, desc.source);
+            break;
+    }
+}
+
+static void HashVertexAttributes(PipelineCacheHasher& hasher, const std::vector<VertexAttribute>& attribs)
+{
+    hasher.WriteValue(attribs.size());
+    for (const auto& attrib : attribs)
+    {
+        hasher.WriteString(attrib.name.c_str());
+        hasher.WriteValue(attrib.format);
+        hasher.WriteValue(attrib.location);
+        hasher.WriteValue(attrib.semanticIndex);
+        hasher.WriteValue(attrib.systemValue);
+        hasher.WriteValue(attrib.slot);
+        hasher.WriteValue(attrib.offset);
+        hasher.WriteValue(attrib.stride);
+        hasher.WriteValue(attrib.instanceDivisor);
+    }
+}
+
+static std::uint64_t HashShaderDesc(const ShaderDescriptor& desc)
+{
+    PipelineCacheHasher hasher;
+
+    hasher.WriteValue(desc.type);
+    HashShaderSource(hasher, desc);
+    hasher.WriteString(desc.entryPoint);
+    hasher.WriteString(desc.profile);
+
+    if (desc.defines != nullptr)
+    {
+        for (auto define = desc.defines; define->name != nullptr; ++define)
+        {
+            hasher.WriteString(define->name);
+            hasher.WriteString(define->definition);
+        }
+    }
+    hasher.WriteValue('\0');
+
+    hasher.WriteValue(desc.flags);
+    HashVertexAttributes(hasher, desc.vertex.inputAttribs);
+    HashVertexAttributes(hasher, desc.vertex.outputAttribs);
+
+    hasher.WriteValue(desc.fragment.outputAttribs.size());
+    for (const auto& attrib : desc.fragment.outputAttribs)
+    {
+        hasher.WriteString(attrib.name);
+        hasher.WriteValue(attrib.format);
+        hasher.WriteValue(attrib.location);
+        hasher.WriteValue(attrib.systemValue);
+    }
+
+    hasher.WriteValue(desc.compute.workGroupSize.width);
+    hasher.WriteValue(desc.compute.workGroupSize.height);
+    hasher.WriteValue(desc.compute.workGroupSize.depth);
+
+    return hasher.GetHash();
+}
+
+static std::uint64_t HashPipelineLayoutDesc(const PipelineLayoutDescriptor& desc)
+{
+    PipelineCacheHasher hasher;
+
+    hasher.WriteValue(desc.bindings.size());
+    for (const auto& binding : desc.bindings)
+    {
+        hasher.WriteString(binding.name);
+        hasher.WriteValue(binding.type);
+        hasher.WriteValue(binding.bindFlags);
+        hasher.WriteValue(binding.stageFlags);
+        hasher.WriteValue(binding.slot);
+        hasher.WriteValue(binding.arraySize);
+        hasher.WriteValue(binding.flags);
+    }
+
+    return hasher.GetHash();
+}
+
+static void HashSpecializationConstants(PipelineCacheHasher& hasher, const std::vector<SpecializationConstant>& constants)
+{
+    hasher.WriteValue(constants.size());
+    for (const auto& constant : constants)
+    {
+        hasher.WriteValue(constant.id);
+        hasher.WriteValue(constant.type);
+        hasher.WriteValue(constant.value);
+    }
+}
+
+static void HashAttachmentFormat(PipelineCacheHasher& hasher, const AttachmentFormatDescriptor& desc)
+{
+    hasher.WriteValue(desc.format);
+    hasher.WriteValue(desc.loadOp);
+    hasher.WriteValue(desc.storeOp);
+}
+
+static std::uint64_t HashRenderPassDesc(const RenderPassDescriptor& desc)
+{
+    PipelineCacheHasher hasher;
+
+    for (const auto& attachment : desc.colorAttachments)
+        HashAttachmentFormat(hasher, attachment);
+    HashAttachmentFormat(hasher, desc.depthAttachment);
+    HashAttachmentFormat(hasher, desc.stencilAttachment);
+    hasher.WriteValue(desc.samples);
+
+    return hasher.GetHash();
+}
+
+static void HashStencilFace(PipelineCacheHasher& hasher, const StencilFaceDescriptor& desc)
+{
+    hasher.WriteValue(desc.stencilFailOp);
+    hasher.WriteValue(desc.depthFailOp);
+    hasher.WriteValue(desc.depthPassOp);
+    hasher.WriteValue(desc.compareOp);
+    hasher.WriteValue(desc.readMask);
+    hasher.WriteValue(desc.writeMask);
+    hasher.WriteValue(desc.reference);
+}
+
+static void HashGraphicsStates(PipelineCacheHasher& hasher, const GraphicsPipelineDescriptor& desc)
+{
+    hasher.WriteValue(desc.primitiveTopology);
+
+    hasher.WriteValue(desc.viewports.size());
+    for (const auto& viewport : desc.viewports)
+    {
+        hasher.WriteValue(viewport.x);
+        hasher.WriteValue(viewport.y);
+        hasher.WriteValue(viewport.width);
+        hasher.WriteValue(viewport.height);
+        hasher.WriteValue(viewport.minDepth);
+        hasher.WriteValue(viewport.maxDepth);
+    }
+
+    hasher.WriteValue(desc.scissors.size());
+    for (const auto& scissor : desc.scissors)
+    {
+        hasher.WriteValue(scissor.x);
+        hasher.WriteValue(scissor.y);
+        hasher.WriteValue(scissor.width);
+        hasher.WriteValue(scissor.height);
+    }
+
+    /* Depth and stencil states */
+    hasher.WriteValue(desc.depth.testEnabled);
+    hasher.WriteValue(desc.depth.writeEnabled);
+    hasher.WriteValue(desc.depth.compareOp);
+
+    hasher.WriteValue(desc.stencil.testEnabled);
+    hasher.WriteValue(desc.stencil.referenceDynamic);
+    HashStencilFace(hasher, desc.stencil.front);
+    HashStencilFace(hasher, desc.stencil.back);
+
+    /* Rasterizer state */
+    const auto& rasterizer = desc.rasterizer;
+    hasher.WriteValue(rasterizer.polygonMode);
+    hasher.WriteValue(rasterizer.cullMode);
+    hasher.WriteValue(rasterizer.depthBias.constantFactor);
+    hasher.WriteValue(rasterizer.depthBias.slopeFactor);
+    hasher.WriteValue(rasterizer.depthBias.clamp);
+    hasher.WriteValue(rasterizer.frontCCW);
+    hasher.WriteValue(rasterizer.discardEnabled);
+    hasher.WriteValue(rasterizer.depthClampEnabled);
+    hasher.WriteValue(rasterizer.scissorTestEnabled);
+    hasher.WriteValue(rasterizer.multiSampleEnabled);
+    hasher.WriteValue(rasterizer.antiAliasedLineEnabled);
+    hasher.WriteValue(rasterizer.conservativeRasterization);
+    hasher.WriteValue(rasterizer.lineWidth);
+
+    /* Blend state */
+    const auto& blend = desc.blend;
+    hasher.WriteValue(blend.alphaToCoverageEnabled);
+    hasher.WriteValue(blend.independentBlendEnabled);
+    hasher.WriteValue(blend.sampleMask);
+    hasher.WriteValue(blend.logicOp);
+    hasher.WriteValue(blend.blendFactor);
+    hasher.WriteValue(blend.blendFactorDynamic);
+
+    for (const auto& target : blend.targets)
+    {
+        hasher.WriteValue(target.blendEnabled);
+        hasher.WriteValue(target.srcColor);
+        hasher.WriteValue(target.dstColor);
+        hasher.WriteValue(target.colorArithmetic);
+        hasher.WriteValue(target.srcAlpha);
+        hasher.WriteValue(target.dstAlpha);
+        hasher.WriteValue(target.alphaArithmetic);
+        hasher.WriteValue(target.colorMask);
+    }
+
+    /* Tessellation state */
+    hasher.WriteValue(desc.tessellation.partition);
+    hasher.WriteValue(desc.tessellation.indexFormat);
+    hasher.WriteValue(desc.tessellation.maxTessFactor);
+    hasher.WriteValue(desc.tessellation.outputWindingCCW);
+
+    /* Specialization constants */
+    HashSpecializationConstants(hasher, desc.specializationConstants);
+}
+
+// Returns a hash of the renderer and driver, so archives from a different software environment are rejected.
+static std::uint64_t HashRendererInfo(const RendererInfo& info)
+{
+    PipelineCacheHasher hasher;
+    hasher.WriteString(info.rendererName);
+    hasher.WriteString(info.deviceName);
+    hasher.WriteString(info.vendorName);
+    hasher.WriteString(info.shadingLanguageName);
+    return hasher.GetHash();
+}
+
+
+/* ----- Internal structures ----- */
+
+// Cache data of a single PSO or the device-wide cache, which either refers to the loaded archive or owns its Blob.
+struct PipelineCacheEntry
+{
+    const void*             data        = nullptr;
+    std::size_t             size        = 0;        // Size of the cache data; less than 'rawSize' if the data is still compressed
+    std::size_t             rawSize     = 0;        // Size of the uncompressed cache data
+    std::uint32_t           checksum    = 0;        // CRC-32 of the cache data as it is stored in the archive
+    bool                    verified    = true;     // False until the cache data from the archive has been verified with its first use
+    std::unique_ptr<Blob>   blob;
+};
+
+static void AssignCacheEntry(PipelineCacheEntry& entry, std::unique_ptr<Blob>&& blob)
+{
+    if (blob)
+    {
+        entry.data      = blob->GetData();
+        entry.size      = blob->GetSize();
+        entry.rawSize   = entry.size;
+        entry.verified  = true;
+        entry.blob      = std::move(blob);
+    }
+}
+
+static bool IsCacheEntryCompressed(const PipelineCacheEntry& entry)
+{
+    return (entry.size < entry.rawSize);
+}
+
+static bool DecompressCacheEntry(const PipelineCacheEntry& entry, std::vector<std::int8_t>& outRawData)
+{
+    outRawData.resize(entry.rawSize);
+    return DecompressBlock(entry.data, entry.size, outRawData.data(), outRawData.size());
+}
+
+// Verifies and decompresses the cache data from the archive with its first use. Corrupted entries are reset, so the PSO is created without cache.
+static bool ResolveCacheEntry(PipelineCacheEntry& entry)
+{
+    if (!entry.verified)
+    {
+        bool valid = (ComputeCRC32(entry.data, entry.size) == entry.checksum);
+
+        if (valid && IsCacheEntryCompressed(entry))
+        {
+            std::vector<std::int8_t> rawData;
+            valid = DecompressCacheEntry(entry, rawData);
+            if (valid)
+                AssignCacheEntry(entry, Blob::CreateStrongRef(std::move(rawData)));
+        }
+
+        if (!valid)
+            entry = PipelineCacheEntry{};
+
+        entry.verified = true;
+    }
+    return (entry.size > 0);
+}
+
+// Range of cache data that has been written to an archive.
+struct ArchiveDataRange
+{
+    std::uint64_t size      = 0;
+    std::uint64_t rawSize   = 0;
+    std::uint32_t checksum  = 0;
+};
+
+/*
+Appends the cache data of the specified entry to the archive and compresses it if that makes it smaller.
+Entries from the loaded archive that have not been used yet are copied as they are if their compression already matches,
+otherwise they are decompressed first. Corrupted entries are stored as empty entries.
+*/
+static ArchiveDataRange AppendCacheEntry(std::vector<std::int8_t>& archive, const PipelineCacheEntry& entry, bool compress)
+{
+    ArchiveDataRange range;
+
+    const void*                 rawData = entry.data;
+    std::size_t                 rawSize = entry.size;
+    std::vector<std::int8_t>    decompressedData;
+
+    if (IsCacheEntryCompressed(entry))
+    {
+        if (compress)
+        {
+            /* Copy compressed data with its checksum unchanged, so it is still verified with its next use */
+            archive.insert(archive.end(), reinterpret_cast<const std::int8_t*>(entry.data), reinterpret_cast<const std::int8_t*>(entry.data) + entry.size);
+            range.size      = entry.size;
+            range.rawSize   = entry.rawSize;
+            range.checksum  = entry.checksum;
+            return range;
+        }
+
+        if (ComputeCRC32(entry.data, entry.size) != entry.checksum || !DecompressCacheEntry(entry, decompressedData))
+            return range;
+
+        rawData = decompressedData.data();
+        rawSize = decompressedData.size();
+    }
+    else if (!entry.verified && ComputeCRC32(entry.data, entry.size) != entry.checksum)
+        return range;
+
+    if (rawSize == 0)
+        return range;
+
+    const std::size_t offset = archive.size();
+    range.rawSize = rawSize;
+
+    if (compress)
+    {
+        /* Keep uncompressed data if compression does not make it any smaller */
+        archive.resize(offset + GetMaxCompressedBlockSize(rawSize));
+        const std::size_t compressedSize = CompressBlock(rawData, rawSize, archive.data() + offset, archive.size() - offset);
+        if (compressedSize > 0 && compressedSize < rawSize)
+        {
+            archive.resize(offset + compressedSize);
+            range.size      = compressedSize;
+            range.checksum  = ComputeCRC32(archive.data() + offset, compressedSize);
+            return range;
+        }
+        archive.resize(offset);
+    }
+
+    archive.insert(archive.end(), reinterpret_cast<const std::int8_t*>(rawData), reinterpret_cast<const std::int8_t*>(rawData) + rawSize);
+    range.size      = rawSize;
+    range.checksum  = ComputeCRC32(rawData, rawSize);
+
+    return range;
+}
+
+
+/*
+ * Pimpl structure
+ */
+
+struct PipelineCache::Pimpl
+{
+    Pimpl(RenderSystem& renderSystem);
+
+    // Returns the hash of the specified registered object, zero for null, or false if the object has not been registered.
+    bool GetObjectHash(const void* object, std::uint64_t& outHash) const;
+
+    bool HashPipelineDesc(const GraphicsPipelineDescriptor& desc, std::uint64_t& outKey) const;
+    bool HashPipelineDesc(const ComputePipelineDescriptor& desc, std::uint64_t& outKey) const;
+
+    template <typename TPipelineDescriptor>
+    PipelineState* CreatePipelineState(const TPipelineDescriptor& desc);
+
+    RenderSystem&                                           renderSystem;
+    int                                                     rendererID          = 0;
+    std::uint64_t                                           driverHash          = 0;
+    bool                                                    deviceWide          = false;
+
+    std::unique_ptr<Blob>                                   archive;
+    std::unordered_map<std::uint64_t, PipelineCacheEntry>   entries;
+    PipelineCacheEntry                                      deviceCache;
+    bool                                                    deviceCacheMerged   = false;
+
+    std::unordered_map<const void*, std::uint64_t>          objectHashes;
+};
+
+PipelineCache::Pimpl::Pimpl(RenderSystem& renderSystem) :
+    renderSystem { renderSystem                                     },
+    rendererID   { renderSystem.GetRendererID()                     },
+    driverHash   { HashRendererInfo(renderSystem.GetRendererInfo()) },
+    deviceWide   { (rendererID == RendererID::Vulkan || rendererID == RendererID::Metal) }
+{
+}
+
+bool PipelineCache::Pimpl::GetObjectHash(const void* object, std::uint64_t& outHash) const
+{
+    if (object == nullptr)
+    {
+        outHash = 0;
+        return true;
+    }
+    auto it = objectHashes.find(object);
+    if (it != objectHashes.end())
+    {
+        outHash = it->second;
+        return true;
+    }
+    return false;
+}
+
+bool PipelineCache::Pimpl::HashPipelineDesc(const GraphicsPipelineDescriptor& desc, std::uint64_t& outKey) const
+{
+    const void* objects[] =
+    {
+        desc.pipelineLayout,
+        desc.renderPass,
+        desc.vertexShader,
+        desc.tessControlShader,
+        desc.tessEvaluationShader,
+        desc.geometryShader,
+        desc.taskShader,
+        desc.meshShader,
+        desc.fragmentShader,
+    };
+
+    PipelineCacheHasher hasher;
+    hasher.WriteString("Graphics");
+
+    for (auto object : objects)
+    {
+        std::uint64_t objectHash = 0;
+        if (!GetObjectHash(object, objectHash))
+            return false;
+        hasher.WriteValue(objectHash);
+    }
+
+    HashGraphicsStates(hasher, desc);
+
+    outKey = hasher.GetHash();
+    return true;
+}
+
+bool PipelineCache::Pimpl::HashPipelineDesc(const ComputePipelineDescriptor& desc, std::uint64_t& outKey) const
+{
+    const void* objects[] =
+    {
+        desc.pipelineLayout,
+        desc.computeShader,
+    };
+
+    PipelineCacheHasher hasher;
+    hasher.WriteString("Compute");
+
+    for (auto object : objects)
+    {
+        std::uint64_t objectHash = 0;
+        if (!GetObjectHash(object, objectHash))
+            return false;
+        hasher.WriteValue(objectHash);
+    }
+
+    HashSpecializationConstants(hasher, desc.specializationConstants);
+
+    outKey = hasher.GetHash();
+    return true;
+}
+
+template <typename TPipelineDescriptor>
+PipelineState* PipelineCache::Pimpl::CreatePipelineState(const TPipelineDescriptor& desc)
+{
+    /* Create PSO without cache if any of its objects have not been registered */
+    std::uint64_t key = 0;
+    if (!HashPipelineDesc(desc, key))
+        return renderSystem.CreatePipelineState(desc);
+
+    std::unique_ptr<Blob> cache;
+
+    if (deviceWide)
+    {
+        /* Merge loaded device-wide cache into the device once, then only receive the updated cache */
+        if (!deviceCacheMerged && ResolveCacheEntry(deviceCache))
+            cache = Blob::CreateWeakRef(deviceCache.data, deviceCache.size);
+        deviceCacheMerged = true;
+
+        auto pipelineState = renderSystem.CreatePipelineState(desc, &cache);
+
+        if (cache && cache->GetData() != deviceCache.data)
+            AssignCacheEntry(deviceCache, std::move(cache));
+
+        /* Device-wide archives only store the keys of all PSOs in their index */
+        entries[key];
+
+        return pipelineState;
+    }
+
+    auto it = entries.find(key);
+    if (it != entries.end() && ResolveCacheEntry(it->second))
+    {
+        /* Direct3D 12 restores the entire PSO from its cache */
+        if (rendererID == RendererID::Direct3D12)
+        {
+            try
+            {
+                auto cacheRef = Blob::CreateWeakRef(it->second.data, it->second.size);
+                return renderSystem.CreatePipelineState(*cacheRef);
+            }
+            catch (const std::exception&)
+            {
+                /* Fall back to creating the PSO from its descriptor */
+            }
+        }
+        else
+            cache = Blob::CreateWeakRef(it->second.data, it->second.size);
+    }
+
+    auto pipelineState = renderSystem.CreatePipelineState(desc, &cache);
+
+    /* Store new cache data unless the backend has left the input cache unchanged */
+    auto& entry = entries[key];
+    if (cache && cache->GetData() != entry.data)
+        AssignCacheEntry(entry, std::move(cache));
+
+    return pipelineState;
+}
+
+
+/*
+ * PipelineCache class
+ */
+
+PipelineCache::PipelineCache(RenderSystem& renderSystem) :
+    pimpl_ { new Pimpl{ renderSystem } }
+{
+}
+
+PipelineCache::~PipelineCache()
+{
+    delete pimpl_;
+}
+
+bool PipelineCache::Load(std::unique_ptr<Blob>&& archive)
+{
+    /* Reset previous content, but keep registered objects */
+    pimpl_->entries.clear();
+    pimpl_->deviceCache         = PipelineCacheEntry{};
+    pimpl_->deviceCacheMerged   = false;
+    pimpl_->archive             = std::move(archive);
+
+    if (!pimpl_->archive)
+        return false;
+
+    auto data = reinterpret_cast<const char*>(pimpl_->archive->GetData());
+    auto size = pimpl_->archive->GetSize();
+
+    auto Reject = [this]() -> bool
+    {
+        pimpl_->entries.clear();
+        pimpl_->deviceCache = PipelineCacheEntry{};
+        pimpl_->archive.reset();
+        return false;
+    };
+
+    /* Validate archive header */
+    if (size < sizeof(ArchiveHeader))
+        return Reject();
+
+    ArchiveHeader header;
+    ::memcpy(&header, data, sizeof(header));
+
+    const std::uint32_t expectedFlags = (pimpl_->deviceWide ? g_archiveFlagDeviceWide : 0);
+
+    if (header.magic      != g_archiveMagic                                 ||
+        header.version    != g_archiveVersion                               ||
+        header.rendererID != static_cast<std::uint32_t>(pimpl_->rendererID) ||
+        header.flags      != expectedFlags                                  ||
+        header.driverHash != pimpl_->driverHash)
+    {
+        return Reject();
+    }
+
+    /* Validate index boundary and checksum */
+    if (header.numEntries > (size - sizeof(ArchiveHeader)) / sizeof(ArchiveIndexEntry))
+        return Reject();
+
+    const std::size_t indexSize = static_cast<std::size_t>(header.numEntries) * sizeof(ArchiveIndexEntry);
+    if (ComputeCRC32(data + sizeof(ArchiveHeader), indexSize) != header.indexChecksum)
+        return Reject();
+
+    /* Compressed data cannot expand by more than a factor of 255, which limits the allocation for corrupted sizes */
+    auto IsRangeValid = [size](std::uint64_t offset, std::uint64_t rangeSize, std::uint64_t rawSize)
+    {
+        return
+        (
+            offset          <= size             &&
+            rangeSize       <= size - offset    &&
+            rangeSize       <= rawSize          &&
+            rawSize / 255   <= rangeSize        &&
+            rawSize         == static_cast<std::size_t>(rawSize)
+        );
+    };
+
+    if (!IsRangeValid(header.deviceCacheOffset, header.deviceCacheSize, header.deviceCacheRawSize))
+        return Reject();
+
+    /* Cache data is only verified and decompressed with its first use */
+    pimpl_->deviceCache.data        = data + header.deviceCacheOffset;
+    pimpl_->deviceCache.size        = static_cast<std::size_t>(header.deviceCacheSize);
+    pimpl_->deviceCache.rawSize     = static_cast<std::size_t>(header.deviceCacheRawSize);
+    pimpl_->deviceCache.checksum    = header.deviceCacheChecksum;
+    pimpl_->deviceCache.verified    = false;
+
+    /* Build lookup table that refers to the cache data within the archive */
+    pimpl_->entries.reserve(static_cast<std::size_t>(header.numEntries));
+
+    for (std::uint64_t i = 0; i < header.numEntries; ++i)
+    {
+        ArchiveIndexEntry indexEntry;
+        ::memcpy(&indexEntry, data + sizeof(ArchiveHeader) + i * sizeof(ArchiveIndexEntry), sizeof(indexEntry));
+
+        if (!IsRangeValid(indexEntry.offset, indexEntry.size, indexEntry.rawSize))
+            return Reject();
+
+        auto& entry = pimpl_->entries[indexEntry.key];
+        entry.data      = data + indexEntry.offset;
+        entry.size      = static_cast<std::size_t>(indexEntry.size);
+        entry.rawSize   = static_cast<std::size_t>(indexEntry.rawSize);
+        entry.checksum  = indexEntry.checksum;
+        entry.verified  = false;
+    }
+
+    return true;
+}
+
+std::unique_ptr<Blob> PipelineCache::Save(long flags) const
+{
+    const bool compress = ((flags & PipelineCacheSaveFlags::Compressed) != 0);
+
+    /* Sort keys, so the archive is deterministic */
+    std::vector<std::uint64_t> keys;
+    keys.reserve(pimpl_->entries.size());
+    for (const auto& entry : pimpl_->entries)
+        keys.push_back(entry.first);
+    std::sort(keys.begin(), keys.end());
+
+    /* Reserve archive for the uncompressed size, since compressed data is appended incrementally */
+    const std::size_t dataOffset = sizeof(ArchiveHeader) + keys.size() * sizeof(ArchiveIndexEntry);
+    std::size_t archiveSize = dataOffset + pimpl_->deviceCache.rawSize;
+    for (const auto& entry : pimpl_->entries)
+        archiveSize += entry.second.rawSize;
+
+    std::vector<std::int8_t> archive(dataOffset);
+    archive.reserve(archiveSize);
+
+    /* Write cache data of the device-wide cache and all PSOs */
+    const ArchiveDataRange deviceCacheRange = AppendCacheEntry(archive, pimpl_->deviceCache, compress);
+
+    std::vector<ArchiveIndexEntry> index(keys.size());
+
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+        const auto& entry = pimpl_->entries.find(keys[i])->second;
+        const std::size_t offset = archive.size();
+        const ArchiveDataRange range = AppendCacheEntry(archive, entry, compress);
+
+        auto& indexEntry = index[i];
+        {
+            indexEntry.key      = keys[i];
+            indexEntry.offset   = offset;
+            indexEntry.size     = range.size;
+            indexEntry.rawSize  = range.rawSize;
+            indexEntry.checksum = range.checksum;
+            indexEntry.reserved = 0;
+        }
+    }
+
+    /* Write header and index */
+    auto data = reinterpret_cast<char*>(archive.data());
+
+    if (!index.empty())
+        ::memcpy(data + sizeof(ArchiveHeader), index.data(), index.size() * sizeof(ArchiveIndexEntry));
+
+    ArchiveHeader header;
+    {
+        header.magic                = g_archiveMagic;
+        header.version              = g_archiveVersion;
+        header.rendererID           = static_cast<std::uint32_t>(pimpl_->rendererID);
+        header.flags                = (pimpl_->deviceWide ? g_archiveFlagDeviceWide : 0);
+        header.driverHash           = pimpl_->driverHash;
+        header.numEntries           = keys.size();
+        header.deviceCacheOffset    = dataOffset;
+        header.deviceCacheSize      = deviceCacheRange.size;
+        header.deviceCacheRawSize   = deviceCacheRange.rawSize;
+        header.deviceCacheChecksum  = deviceCacheRange.checksum;
+        header.indexChecksum        = ComputeCRC32(data + sizeof(ArchiveHeader), index.size() * sizeof(ArchiveIndexEntry));
+    }
+    ::memcpy(data, &header, sizeof(header));
+
+    return Blob::CreateStrongRef(std::move(archive));
+}
+
+void PipelineCache::Clear()
+{
+    pimpl_->entries.clear();
+    pimpl_->deviceCache         = PipelineCacheEntry{};
+    pimpl_->deviceCacheMerged   = false;
+    pimpl_->archive.reset();
+    pimpl_->objectHashes.clear();
+}
+
+void PipelineCache::RegisterShader(const Shader& shader, const ShaderDescriptor& shaderDesc)
+{
+    pimpl_->objectHashes[&shader] = HashShaderDesc(shaderDesc);
+}
+
+void PipelineCache::RegisterPipelineLayout(const PipelineLayout& pipelineLayout, const PipelineLayoutDescriptor& pipelineLayoutDesc)
+{
+    pimpl_->objectHashes[&pipelineLayout] = HashPipelineLayoutDesc(pipelineLayoutDesc);
+}
+
+void PipelineCache::RegisterRenderPass(const RenderPass& renderPass, const RenderPassDescriptor& renderPassDesc)
+{
+    pimpl_->objectHashes[&renderPass] = HashRenderPassDesc(renderPassDesc);
+}
+
+void PipelineCache::Unregister(const void* object)
+{
+    pimpl_->objectHashes.erase(object);
+}
+
+PipelineState* PipelineCache::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc)
+{
+    return pimpl_->CreatePipelineState(pipelineStateDesc);
+}
+
+PipelineState* PipelineCache::CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc)
+{
+    return pimpl_->CreatePipelineState(pipelineStateDesc);
+}
+
+std::size_t PipelineCache::GetNumEntries() const
+{
+    return pimpl_->entries.size();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,54 @@
+/*
+ * PipelineCompileTask.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "PipelineCompileTask.h"
+#include <LLGL/JobSystem.h>
+#include <chrono>
+#include <memory>
+
+
+namespace LLGL
+{
+
+
+PipelineCompileTask::~PipelineCompileTask()
+{
+    if (future_.valid())
+        future_.wait();
+}
+
+void PipelineCompileTask::Start(const std::function<void()>& task, long flags)
+{
+    /* Packaged task stores any exception in the shared state, so the job system task never throws */
+    auto packagedTask = std::make_shared<std::packaged_task<void()>>(task);
+    future_ = packagedTask->get_future().share();
+    flags_  = flags;
+    JobSystem::Async([packagedTask]() { (*packagedTask)(); });
+}
+
+bool PipelineCompileTask::IsReady() const
+{
+    return (!future_.valid() || future_.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+}
+
+void PipelineCompileTask::Wait() const
+{
+    if (future_.valid())
+        future_.get();
+}
+
+bool PipelineCompileTask::SkipDraws() const
+{
+    return ((flags_ & AsyncPipelineFlags::SkipDrawsWhilePending) != 0 && !IsReady());
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,65 @@
+/*
+ * PipelineCompileTask.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_PIPELINE_COMPILE_TASK_H
+#define LLGL_PIPELINE_COMPILE_TASK_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/PipelineStateFlags.h>
+#include <functional>
+#include <future>
+
+
+namespace LLGL
+{
+
+
+/*
+Helper class to compile the native object of a PSO on the job system (see RenderSystem::CreatePipelineStateAsync).
+A default constructed task is always ready, so synchronously created PSOs do not need any special treatment.
+*/
+class LLGL_EXPORT PipelineCompileTask
+{
+
+    public:
+
+        PipelineCompileTask() = default;
+        PipelineCompileTask(const PipelineCompileTask&) = delete;
+        PipelineCompileTask& operator = (const PipelineCompileTask&) = delete;
+
+        // Waits until a pending task has finished, but ignores its exceptions.
+        ~PipelineCompileTask();
+
+        // Schedules the specified function on the job system. The flags are a bitwise OR combination of AsyncPipelineFlags entries.
+        void Start(const std::function<void()>& task, long flags);
+
+        // Returns true if no task is pending.
+        bool IsReady() const;
+
+        // Waits until the task has finished and rethrows its exception if it failed.
+        void Wait() const;
+
+        // Returns true if draw commands must be skipped, i.e. the task is still pending and AsyncPipelineFlags::SkipDrawsWhilePending was specified.
+        bool SkipDraws() const;
+
+    private:
+
+        std::shared_future<void>    future_;
+        long                        flags_  = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
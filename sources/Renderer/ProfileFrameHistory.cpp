@@ -0,0 +1,241 @@
+/*
+ * ProfileFrameHistory.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/ProfileFrameHistory.h>
+#include <LLGL/Timer.h>
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+
+namespace LLGL
+{
+
+
+static constexpr std::size_t g_numCounters = sizeof(FrameProfile::values) / sizeof(FrameProfile::values[0]);
+
+struct ProfileFrameHistory::Pimpl
+{
+    struct ScopeTime
+    {
+        std::uint32_t   scope;
+        std::uint64_t   time;
+    };
+
+    struct Frame
+    {
+        std::uint32_t           values[g_numCounters];
+        std::uint64_t           gpuTime     = 0;
+        std::uint64_t           cpuTime     = 0;
+        bool                    hasGPUTime  = false;
+        bool                    hasCPUTime  = false;
+        std::vector<ScopeTime>  scopes;
+    };
+
+    std::vector<Frame>                              frames;
+    std::size_t                                     nextFrame   = 0;
+    std::size_t                                     numFrames   = 0;
+
+    std::uint64_t                                   lastTick    = 0;
+    bool                                            hasLastTick = false;
+
+    std::unordered_map<std::string, std::uint32_t>  scopeIndices;
+    std::vector<const char*>                        scopeNames;     // Pointers to the keys of 'scopeIndices', which are stable for an unordered map
+
+    ProfileFrameStatistics                          stats;
+    bool                                            statsDirty  = true;
+    std::vector<std::uint64_t>                      scratch;
+
+    // Returns the index of the scope with the specified annotation and creates a new scope if necessary.
+    std::uint32_t GetScopeIndex(const char* annotation)
+    {
+        auto result = scopeIndices.insert({ annotation, static_cast<std::uint32_t>(scopeNames.size()) });
+        if (result.second)
+            scopeNames.push_back(result.first->first.c_str());
+        return result.first->second;
+    }
+
+    // Computes the percentile statistics of all values in the scratch container.
+    void ComputeTimeStatistics(ProfileTimeStatistics& outStats)
+    {
+        outStats = ProfileTimeStatistics{};
+        if (scratch.empty())
+            return;
+
+        std::sort(scratch.begin(), scratch.end());
+
+        /* Use nearest-rank method for percentiles */
+        const auto n = scratch.size();
+        auto Percentile = [this, n](std::size_t p) -> std::uint64_t
+        {
+            const std::size_t rank = (p*n + 99) / 100;
+            return scratch[std::max<std::size_t>(rank, 1) - 1];
+        };
+
+        std::uint64_t sum = 0;
+        for (auto value : scratch)
+            sum += value;
+
+        outStats.min        = scratch.front();
+        outStats.p50        = Percentile(50);
+        outStats.p95        = Percentile(95);
+        outStats.p99        = Percentile(99);
+        outStats.max        = scratch.back();
+        outStats.average    = sum / n;
+    }
+
+    void UpdateStatistics()
+    {
+        stats.numFrames = static_cast<std::uint32_t>(numFrames);
+
+        /* Compute GPU and CPU time statistics */
+        scratch.clear();
+        for (std::size_t i = 0; i < numFrames; ++i)
+        {
+            if (frames[i].hasGPUTime)
+                scratch.push_back(frames[i].gpuTime);
+        }
+        ComputeTimeStatistics(stats.gpuTime);
+
+        scratch.clear();
+        for (std::size_t i = 0; i < numFrames; ++i)
+        {
+            if (frames[i].hasCPUTime)
+                scratch.push_back(frames[i].cpuTime);
+        }
+        ComputeTimeStatistics(stats.cpuTime);
+
+        /* Compute counter ranges */
+        stats.minCounters.Clear();
+        stats.maxCounters.Clear();
+        for (std::size_t i = 0; i < numFrames; ++i)
+        {
+            for (std::size_t j = 0; j < g_numCounters; ++j)
+            {
+                const auto value = frames[i].values[j];
+                stats.minCounters.values[j] = (i == 0 ? value : std::min(stats.minCounters.values[j], value));
+                stats.maxCounters.values[j] = std::max(stats.maxCounters.values[j], value);
+            }
+        }
+
+        /* Compute scope statistics */
+        std::vector<std::uint64_t> scopeSums(scopeNames.size(), 0);
+        stats.scopes.resize(scopeNames.size());
+        for (std::size_t i = 0; i < scopeNames.size(); ++i)
+        {
+            stats.scopes[i]             = ProfileScopeStatistics{};
+            stats.scopes[i].annotation  = scopeNames[i];
+        }
+
+        for (std::size_t i = 0; i < numFrames; ++i)
+        {
+            for (const auto& scopeTime : frames[i].scopes)
+            {
+                auto& scope = stats.scopes[scopeTime.scope];
+                scopeSums[scopeTime.scope] += scopeTime.time;
+                scope.maxTime = std::max(scope.maxTime, scopeTime.time);
+                scope.numFrames++;
+            }
+        }
+
+        /* Remove scopes that are no longer part of any frame in this history */
+        std::size_t numScopes = 0;
+        for (std::size_t i = 0; i < stats.scopes.size(); ++i)
+        {
+            if (stats.scopes[i].numFrames > 0)
+            {
+                stats.scopes[i].averageTime = scopeSums[i] / stats.scopes[i].numFrames;
+                stats.scopes[numScopes++] = stats.scopes[i];
+            }
+        }
+        stats.scopes.resize(numScopes);
+
+        statsDirty = false;
+    }
+};
+
+ProfileFrameHistory::ProfileFrameHistory(std::size_t numFrames) :
+    pimpl_ { new Pimpl{} }
+{
+    pimpl_->frames.resize(std::max<std::size_t>(numFrames, 1));
+}
+
+ProfileFrameHistory::~ProfileFrameHistory()
+{
+    delete pimpl_;
+}
+
+void ProfileFrameHistory::Append(const FrameProfile& frameProfile)
+{
+    auto& frame = pimpl_->frames[pimpl_->nextFrame];
+
+    pimpl_->nextFrame = (pimpl_->nextFrame + 1) % pimpl_->frames.size();
+    pimpl_->numFrames = std::min(pimpl_->numFrames + 1, pimpl_->frames.size());
+    pimpl_->statsDirty = true;
+
+    /* Store counters */
+    std::copy(std::begin(frameProfile.values), std::end(frameProfile.values), frame.values);
+
+    /* Measure CPU time since previous frame */
+    const auto tick = Timer::Tick();
+    frame.hasCPUTime = pimpl_->hasLastTick;
+    frame.cpuTime = (pimpl_->hasLastTick ? static_cast<std::uint64_t>(static_cast<double>(tick - pimpl_->lastTick) * 1.0e9 / Timer::Frequency()) : 0);
+    pimpl_->lastTick = tick;
+    pimpl_->hasLastTick = true;
+
+    /* Sum up GPU time of all top-level records, and the time of each scope (a scope might be recorded multiple times per frame) */
+    frame.gpuTime = 0;
+    frame.hasGPUTime = !frameProfile.timeRecords.empty();
+    frame.scopes.clear();
+
+    for (const auto& rec : frameProfile.timeRecords)
+    {
+        if (rec.parent == ProfileTimeRecord::invalidIndex)
+            frame.gpuTime += rec.elapsedTime;
+
+        const auto scope = pimpl_->GetScopeIndex(rec.annotation);
+        auto it = std::find_if(
+            frame.scopes.begin(), frame.scopes.end(),
+            [scope](const Pimpl::ScopeTime& entry)
+            {
+                return (entry.scope == scope);
+            }
+        );
+        if (it != frame.scopes.end())
+            it->time += rec.elapsedTime;
+        else
+            frame.scopes.push_back({ scope, rec.elapsedTime });
+    }
+}
+
+void ProfileFrameHistory::Clear()
+{
+    pimpl_->nextFrame   = 0;
+    pimpl_->numFrames   = 0;
+    pimpl_->hasLastTick = false;
+    pimpl_->statsDirty  = true;
+}
+
+std::size_t ProfileFrameHistory::GetNumFrames() const
+{
+    return pimpl_->numFrames;
+}
+
+const ProfileFrameStatistics& ProfileFrameHistory::GetStatistics()
+{
+    if (pimpl_->statsDirty)
+        pimpl_->UpdateStatistics();
+    return pimpl_->stats;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
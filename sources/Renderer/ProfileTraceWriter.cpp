@@ -0,0 +1,230 @@
+/*
+ * ProfileTraceWriter.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/ProfileTraceWriter.h>
+#include <LLGL/RenderingProfiler.h>
+#include <LLGL/Timer.h>
+#include <cstdio>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/* Process and thread IDs of all trace events */
+static const int g_traceProcessId   = 1;
+static const int g_traceThreadCPU   = 1;
+static const int g_traceThreadGPU   = 2;
+
+struct ProfileTraceWriter::Pimpl
+{
+    std::FILE*      file        = nullptr;
+    std::uint64_t   originTick  = 0;
+    double          tickToUS    = 0.0;  // Conversion factor from ticks to microseconds
+    std::uint64_t   frameIndex  = 0;
+    bool            firstEvent  = true;
+
+    // Returns the timestamp (in microseconds) of the specified tick relative to the time origin.
+    double GetTimestamp(std::uint64_t tick) const
+    {
+        return static_cast<double>(tick - originTick) * tickToUS;
+    }
+
+    // Writes the separator between two events and the event prefix.
+    void BeginEvent()
+    {
+        if (firstEvent)
+        {
+            std::fputs("\n", file);
+            firstEvent = false;
+        }
+        else
+            std::fputs(",\n", file);
+    }
+
+    // Writes the specified string with JSON escape sequences (without quotation marks).
+    void WriteString(const char* s)
+    {
+        for (; *s != '\0'; ++s)
+        {
+            const char c = *s;
+            if (c == '\"' || c == '\\')
+            {
+                std::fputc('\\', file);
+                std::fputc(c, file);
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+                std::fprintf(file, "\\u%04x", static_cast<unsigned>(c));
+            else
+                std::fputc(c, file);
+        }
+    }
+
+    // Writes the metadata event to name the specified thread.
+    void WriteThreadName(int tid, const char* name)
+    {
+        BeginEvent();
+        std::fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", g_traceProcessId, tid, name);
+    }
+
+    // Writes a complete event with the specified timestamp and duration (in microseconds).
+    void WriteCompleteEvent(int tid, const char* name, double ts, double dur, const ProfileTimeRecord* record = nullptr)
+    {
+        BeginEvent();
+        std::fputs("{\"name\":\"", file);
+        WriteString(name);
+        std::fprintf(file, "\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f", g_traceProcessId, tid, ts, dur);
+        if (record != nullptr)
+            std::fprintf(file, ",\"args\":{\"cpuTime\":%.3f}", static_cast<double>(record->cpuTime) * 0.001);
+        std::fputs("}", file);
+    }
+
+    // Writes a counter event with the specified values.
+    void WriteCounterEvent(const char* name, double ts, std::size_t numValues, const char* const* valueNames, const std::uint32_t* values)
+    {
+        BeginEvent();
+        std::fprintf(file, "{\"name\":\"%s\",\"ph\":\"C\",\"pid\":%d,\"ts\":%.3f,\"args\":{", name, g_traceProcessId, ts);
+        for (std::size_t i = 0; i < numValues; ++i)
+            std::fprintf(file, "%s\"%s\":%u", (i > 0 ? "," : ""), valueNames[i], values[i]);
+        std::fputs("}}", file);
+    }
+
+    // Writes the GPU time records back-to-back from the specified timestamp and nests each record into its parent scope.
+    void WriteTimeRecords(const std::vector<ProfileTimeRecord>& records, double ts)
+    {
+        /* Records are stored in depth-first order, so each parent start is known before its children */
+        std::vector<double> cursors(records.size());
+        double topLevelCursor = ts;
+
+        for (std::size_t i = 0; i < records.size(); ++i)
+        {
+            const auto& rec = records[i];
+            const double dur = static_cast<double>(rec.elapsedTime) * 0.001;
+
+            double start;
+            if (rec.parent != ProfileTimeRecord::invalidIndex && rec.parent < i)
+            {
+                start = cursors[rec.parent];
+                cursors[rec.parent] += dur;
+            }
+            else
+            {
+                start = topLevelCursor;
+                topLevelCursor += dur;
+            }
+            cursors[i] = start;
+
+            WriteCompleteEvent(g_traceThreadGPU, rec.annotation, start, dur, &rec);
+        }
+    }
+};
+
+ProfileTraceWriter::ProfileTraceWriter(const char* filename) :
+    pimpl_ { new Pimpl{} }
+{
+    pimpl_->originTick  = Timer::Tick();
+    pimpl_->tickToUS    = 1000000.0 / static_cast<double>(Timer::Frequency());
+    pimpl_->file        = std::fopen(filename, "w");
+
+    if (pimpl_->file != nullptr)
+    {
+        /* Write the JSON array format, whose closing bracket is optional, so an incomplete trace can still be loaded */
+        std::fputs("[", pimpl_->file);
+        pimpl_->WriteThreadName(g_traceThreadCPU, "CPU");
+        pimpl_->WriteThreadName(g_traceThreadGPU, "GPU");
+    }
+}
+
+ProfileTraceWriter::~ProfileTraceWriter()
+{
+    if (pimpl_->file != nullptr)
+    {
+        std::fputs("\n]\n", pimpl_->file);
+        std::fclose(pimpl_->file);
+    }
+    delete pimpl_;
+}
+
+bool ProfileTraceWriter::IsOpen() const
+{
+    return (pimpl_->file != nullptr);
+}
+
+void ProfileTraceWriter::WriteCPUEvent(const char* name, std::uint64_t startTick, std::uint64_t endTick)
+{
+    if (pimpl_->file != nullptr)
+    {
+        const double ts = pimpl_->GetTimestamp(startTick);
+        pimpl_->WriteCompleteEvent(g_traceThreadCPU, name, ts, static_cast<double>(endTick - startTick) * pimpl_->tickToUS);
+    }
+}
+
+void ProfileTraceWriter::WriteFrame(const FrameProfile& frameProfile)
+{
+    if (pimpl_->file == nullptr)
+        return;
+
+    const double ts = pimpl_->GetTimestamp(Timer::Tick());
+
+    /* Write global frame marker */
+    pimpl_->BeginEvent();
+    std::fprintf(
+        pimpl_->file, "{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"args\":{\"index\":%llu}}",
+        g_traceProcessId, g_traceThreadCPU, ts, static_cast<unsigned long long>(pimpl_->frameIndex++)
+    );
+
+    /* Write counter tracks */
+    const char* const commandNames[] = { "drawCommands", "dispatchCommands", "commandsEliminated" };
+    const std::uint32_t commandValues[] = { frameProfile.drawCommands, frameProfile.dispatchCommands, frameProfile.commandsEliminated };
+    pimpl_->WriteCounterEvent("Commands", ts, 3, commandNames, commandValues);
+
+    const char* const bindingNames[] =
+    {
+        "graphicsPipelineBindings", "computePipelineBindings", "resourceHeapBindings", "vertexBufferBindings", "indexBufferBindings"
+    };
+    const std::uint32_t bindingValues[] =
+    {
+        frameProfile.graphicsPipelineBindings,
+        frameProfile.computePipelineBindings,
+        frameProfile.resourceHeapBindings,
+        frameProfile.vertexBufferBindings,
+        frameProfile.indexBufferBindings,
+    };
+    pimpl_->WriteCounterEvent("Bindings", ts, 5, bindingNames, bindingValues);
+
+    const char* const submissionNames[] = { "commandBufferSubmittions", "commandBufferEncodings", "renderPassSections", "fenceSubmissions", "commandBufferStalls" };
+    const std::uint32_t submissionValues[] =
+    {
+        frameProfile.commandBufferSubmittions,
+        frameProfile.commandBufferEncodings,
+        frameProfile.renderPassSections,
+        frameProfile.fenceSubmissions,
+        frameProfile.commandBufferStalls,
+    };
+    pimpl_->WriteCounterEvent("Submissions", ts, 5, submissionNames, submissionValues);
+
+    const char* const presentationNames[] = { "missedVSyncs" };
+    const std::uint32_t presentationValues[] = { frameProfile.missedVSyncs };
+    pimpl_->WriteCounterEvent("Presentation", ts, 1, presentationNames, presentationValues);
+
+    /* Write GPU time records */
+    pimpl_->WriteTimeRecords(frameProfile.timeRecords, ts);
+}
+
+void ProfileTraceWriter::Flush()
+{
+    if (pimpl_->file != nullptr)
+        std::fflush(pimpl_->file);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
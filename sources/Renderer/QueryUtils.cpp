@@ -0,0 +1,68 @@
+/*
+ * QueryUtils.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "QueryUtils.h"
+
+
+namespace LLGL
+{
+
+
+LLGL_EXPORT std::size_t GetQueryResultStride(std::size_t dataSize, std::uint32_t numQueries)
+{
+    if (dataSize == numQueries * sizeof(std::uint32_t))
+        return sizeof(std::uint32_t);
+    if (dataSize == numQueries * sizeof(std::uint64_t))
+        return sizeof(std::uint64_t);
+    if (dataSize == numQueries * sizeof(QueryPipelineStatistics))
+        return sizeof(QueryPipelineStatistics);
+    return 0;
+}
+
+LLGL_EXPORT bool IsQueryRangeOverlapping(
+    const std::vector<QueryRange>&  ranges,
+    std::uint32_t                   firstQuery,
+    std::uint32_t                   numQueries)
+{
+    for (const auto& range : ranges)
+    {
+        if (firstQuery + numQueries > range.firstQuery && firstQuery < range.firstQuery + range.numQueries)
+            return true;
+    }
+    return false;
+}
+
+LLGL_EXPORT void AppendQueryRange(
+    std::vector<QueryRange>&    ranges,
+    std::uint32_t               firstQuery,
+    std::uint32_t               numQueries)
+{
+    if (!ranges.empty())
+    {
+        /* Extend last range if the new range directly follows it */
+        auto& lastRange = ranges.back();
+        if (lastRange.firstQuery + lastRange.numQueries == firstQuery)
+        {
+            lastRange.numQueries += numQueries;
+            return;
+        }
+    }
+
+    QueryRange range;
+    {
+        range.firstQuery = firstQuery;
+        range.numQueries = numQueries;
+    }
+    ranges.push_back(range);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,53 @@
+/*
+ * QueryUtils.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_QUERY_UTILS_H
+#define LLGL_QUERY_UTILS_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/QueryHeapFlags.h>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/* ----- Functions ----- */
+
+/*
+Returns the size (in bytes) of each query result entry for the specified output data size,
+or 0 if the size does not match any of the result types std::uint32_t, std::uint64_t, or QueryPipelineStatistics.
+*/
+LLGL_EXPORT std::size_t GetQueryResultStride(std::size_t dataSize, std::uint32_t numQueries);
+
+// Returns true if the specified range of queries overlaps with any of the specified ranges.
+LLGL_EXPORT bool IsQueryRangeOverlapping(
+    const std::vector<QueryRange>&  ranges,
+    std::uint32_t                   firstQuery,
+    std::uint32_t                   numQueries
+);
+
+// Appends the specified range of queries to the list, or extends the last range if both ranges are adjacent.
+LLGL_EXPORT void AppendQueryRange(
+    std::vector<QueryRange>&    ranges,
+    std::uint32_t               firstQuery,
+    std::uint32_t               numQueries
+);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,834 @@
+/*
+ * RenderGraph.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/RenderGraph.h>
+#include <LLGL/RenderSystem.h>
+#include <LLGL/Format.h>
+#include "../Core/Helper.h"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal structures ----- */
+
+struct RenderGraphResourceEntry
+{
+    bool                isTexture   = true;
+    bool                isImported  = false;
+    TextureDescriptor   textureDesc;
+    BufferDescriptor    bufferDesc;
+    Texture*            texture     = nullptr;
+    Buffer*             buffer      = nullptr;
+    std::size_t         physical    = 0;            // Index into the physical resource pool of transient resources.
+    std::uint32_t       firstPass   = ~0u;          // First pass (that has not been culled) which uses this resource.
+    std::uint32_t       lastPass    = 0;            // Last pass (that has not been culled) which uses this resource.
+};
+
+struct RenderGraphPhysicalResource
+{
+    bool                isTexture   = true;
+    TextureDescriptor   textureDesc;
+    BufferDescriptor    bufferDesc;
+    Texture*            texture     = nullptr;
+    Buffer*             buffer      = nullptr;
+    bool                isAcquired  = false;        // Specifies whether this resource is currently assigned to a transient resource during allocation.
+    bool                isUsed      = false;        // Specifies whether this resource has been assigned by the last compilation.
+};
+
+struct RenderGraphCompiledPass
+{
+    bool                    culled          = true;
+    RenderPass*             renderPass      = nullptr;
+    RenderTarget*           renderTarget    = nullptr;
+    RenderPassDescriptor    renderPassDesc;
+    std::vector<ClearValue> clearValues;
+};
+
+struct RenderGraphTargetKey
+{
+    Texture*        texture;
+    std::uint32_t   mipLevel;
+    std::uint32_t   arrayLayer;
+};
+
+struct RenderGraphCachedTarget
+{
+    std::vector<RenderGraphTargetKey>   key;
+    RenderTarget*                       renderTarget    = nullptr;
+    bool                                isUsed          = false;
+};
+
+struct RenderGraphCachedPass
+{
+    RenderPassDescriptor    desc;
+    RenderPass*             renderPass  = nullptr;
+};
+
+
+/* ----- Internal functions ----- */
+
+// Only the properties that affect the creation of a texture are compared, i.e. the clear value is ignored.
+static bool AreTextureDescsEqual(const TextureDescriptor& lhs, const TextureDescriptor& rhs)
+{
+    return
+    (
+        lhs.type            == rhs.type             &&
+        lhs.bindFlags       == rhs.bindFlags        &&
+        lhs.miscFlags       == rhs.miscFlags        &&
+        lhs.format          == rhs.format           &&
+        lhs.extent.width    == rhs.extent.width     &&
+        lhs.extent.height   == rhs.extent.height    &&
+        lhs.extent.depth    == rhs.extent.depth     &&
+        lhs.arrayLayers     == rhs.arrayLayers      &&
+        lhs.mipLevels       == rhs.mipLevels        &&
+        lhs.samples         == rhs.samples
+    );
+}
+
+static bool AreBufferDescsEqual(const BufferDescriptor& lhs, const BufferDescriptor& rhs)
+{
+    return
+    (
+        lhs.size            == rhs.size             &&
+        lhs.stride          == rhs.stride           &&
+        lhs.format          == rhs.format           &&
+        lhs.bindFlags       == rhs.bindFlags        &&
+        lhs.cpuAccessFlags  == rhs.cpuAccessFlags   &&
+        lhs.miscFlags       == rhs.miscFlags
+    );
+}
+
+static bool AreAttachmentFormatDescsEqual(const AttachmentFormatDescriptor& lhs, const AttachmentFormatDescriptor& rhs)
+{
+    return (lhs.format == rhs.format && lhs.loadOp == rhs.loadOp && lhs.storeOp == rhs.storeOp);
+}
+
+static bool AreRenderPassDescsEqual(const RenderPassDescriptor& lhs, const RenderPassDescriptor& rhs)
+{
+    for (std::uint32_t i = 0; i < LLGL_MAX_NUM_COLOR_ATTACHMENTS; ++i)
+    {
+        if (!AreAttachmentFormatDescsEqual(lhs.colorAttachments[i], rhs.colorAttachments[i]))
+            return false;
+    }
+    return
+    (
+        AreAttachmentFormatDescsEqual(lhs.depthAttachment, rhs.depthAttachment)     &&
+        AreAttachmentFormatDescsEqual(lhs.stencilAttachment, rhs.stencilAttachment) &&
+        lhs.samples == rhs.samples
+    );
+}
+
+static bool AreTargetKeysEqual(const std::vector<RenderGraphTargetKey>& lhs, const std::vector<RenderGraphTargetKey>& rhs)
+{
+    if (lhs.size() != rhs.size())
+        return false;
+    for (std::size_t i = 0; i < lhs.size(); ++i)
+    {
+        if (lhs[i].texture != rhs[i].texture || lhs[i].mipLevel != rhs[i].mipLevel || lhs[i].arrayLayer != rhs[i].arrayLayer)
+            return false;
+    }
+    return true;
+}
+
+// Returns true if the specified texture only has a single subresource, in which case a cleared attachment overwrites its entire content.
+static bool HasSingleSubresource(const TextureDescriptor& textureDesc)
+{
+    return (textureDesc.arrayLayers == 1 && NumMipLevels(textureDesc) == 1);
+}
+
+static bool IsAttachmentEnabled(const RenderGraphAttachment& attachment)
+{
+    return (attachment.resource != Constants::invalidRenderGraphResource);
+}
+
+static bool IsRenderPass(const RenderGraphPassDescriptor& passDesc)
+{
+    return (!passDesc.colorAttachments.empty() || IsAttachmentEnabled(passDesc.depthStencilAttachment));
+}
+
+// Calls the specified function for each resource the specified pass uses, including its attachments.
+template <typename TFunc>
+void ForEachUsedResource(const RenderGraphPassDescriptor& passDesc, TFunc func)
+{
+    for (auto resource : passDesc.reads)
+        func(resource);
+    for (auto resource : passDesc.writes)
+        func(resource);
+    for (const auto& attachment : passDesc.colorAttachments)
+        func(attachment.resource);
+    if (IsAttachmentEnabled(passDesc.depthStencilAttachment))
+        func(passDesc.depthStencilAttachment.resource);
+}
+
+
+/*
+ * Pimpl structure
+ */
+
+struct RenderGraph::Pimpl
+{
+    Pimpl(RenderSystem& renderSystem);
+    ~Pimpl();
+
+    void ValidatePass(const RenderGraphPassDescriptor& passDesc) const;
+
+    void CullPasses();
+    void AllocateResources();
+    void AcquirePhysicalResource(RenderGraphResourceEntry& entry);
+    void ReleaseUnusedPhysicalResources();
+    void CreateRenderTargets();
+
+    RenderPass* GetOrCreateRenderPass(const RenderPassDescriptor& renderPassDesc);
+    RenderTarget* GetOrCreateRenderTarget(const RenderGraphPassDescriptor& passDesc, RenderPass* renderPass);
+
+    RenderSystem&                               renderSystem;
+    bool                                        isCompiled      = false;
+
+    std::vector<RenderGraphResourceEntry>       resources;
+    std::vector<RenderGraphPassDescriptor>      passes;
+    std::vector<RenderGraphCompiledPass>        compiledPasses;
+
+    std::vector<RenderGraphPhysicalResource>    physicalResources;
+    std::vector<RenderGraphCachedTarget>        cachedTargets;
+    std::vector<RenderGraphCachedPass>          cachedPasses;
+};
+
+RenderGraph::Pimpl::Pimpl(RenderSystem& renderSystem) :
+    renderSystem { renderSystem }
+{
+}
+
+RenderGraph::Pimpl::~Pimpl()
+{
+    /* Release render targets before the textures they refer to */
+    for (auto& target : cachedTargets)
+        renderSystem.Release(*target.renderTarget);
+    for (auto& pass : cachedPasses)
+        renderSystem.Release(*pass.renderPass);
+    for (auto& physical : physicalResources)
+    {
+        if (physical.texture != nullptr)
+            renderSystem.Release(*physical.texture);
+        if (physical.buffer != nullptr)
+            renderSystem.Release(*physical.buffer);
+    }
+}
+
+void RenderGraph::Pimpl::ValidatePass(const RenderGraphPassDescriptor& passDesc) const
+{
+    ForEachUsedResource(
+        passDesc,
+        [this](RenderGraphResource resource)
+        {
+            if (resource >= resources.size())
+                throw std::invalid_argument("render graph pass refers to invalid resource: " + std::to_string(resource));
+        }
+    );
+
+    auto ValidateAttachment = [this](const RenderGraphAttachment& attachment)
+    {
+        if (!resources[attachment.resource].isTexture)
+            throw std::invalid_argument("render graph attachment refers to a buffer: " + std::to_string(attachment.resource));
+    };
+
+    for (const auto& attachment : passDesc.colorAttachments)
+        ValidateAttachment(attachment);
+    if (IsAttachmentEnabled(passDesc.depthStencilAttachment))
+        ValidateAttachment(passDesc.depthStencilAttachment);
+}
+
+/*
+Culls all passes whose results are never consumed, by traversing all passes in reverse order.
+A resource is "needed" if its current content is read by a subsequent pass that has not been culled, or if it is an imported resource.
+The store operations of all attachments are derived during the same traversal.
+*/
+void RenderGraph::Pimpl::CullPasses()
+{
+    std::vector<bool> needed(resources.size());
+    for (std::size_t i = 0; i < resources.size(); ++i)
+        needed[i] = resources[i].isImported;
+
+    for (auto i = passes.size(); i-- > 0;)
+    {
+        const auto& passDesc = passes[i];
+        auto& compiledPass = compiledPasses[i];
+
+        /* Keep pass if it writes any resource that is needed afterwards */
+        bool isLive = passDesc.hasSideEffects;
+
+        for (auto resource : passDesc.writes)
+            isLive = (isLive || needed[resource]);
+        for (const auto& attachment : passDesc.colorAttachments)
+            isLive = (isLive || needed[attachment.resource]);
+        if (IsAttachmentEnabled(passDesc.depthStencilAttachment))
+            isLive = (isLive || needed[passDesc.depthStencilAttachment.resource]);
+
+        compiledPass.culled = !isLive;
+        if (!isLive)
+            continue;
+
+        /* Store attachments only if their content is needed afterwards */
+        for (std::size_t j = 0; j < passDesc.colorAttachments.size() && j < LLGL_MAX_NUM_COLOR_ATTACHMENTS; ++j)
+        {
+            const auto& attachment = passDesc.colorAttachments[j];
+            compiledPass.renderPassDesc.colorAttachments[j].storeOp = (needed[attachment.resource] ? AttachmentStoreOp::Store : AttachmentStoreOp::Undefined);
+        }
+
+        if (IsAttachmentEnabled(passDesc.depthStencilAttachment))
+        {
+            const auto storeOp = (needed[passDesc.depthStencilAttachment.resource] ? AttachmentStoreOp::Store : AttachmentStoreOp::Undefined);
+            compiledPass.renderPassDesc.depthAttachment.storeOp     = storeOp;
+            compiledPass.renderPassDesc.stencilAttachment.storeOp   = storeOp;
+        }
+
+        /* Cleared attachments overwrite the previous content, so previous passes are no longer needed for them */
+        auto OverwriteAttachment = [this, &needed](const RenderGraphAttachment& attachment)
+        {
+            if (attachment.clear && HasSingleSubresource(resources[attachment.resource].textureDesc))
+                needed[attachment.resource] = false;
+            else
+                needed[attachment.resource] = true;
+        };
+
+        for (const auto& attachment : passDesc.colorAttachments)
+            OverwriteAttachment(attachment);
+        if (IsAttachmentEnabled(passDesc.depthStencilAttachment))
+            OverwriteAttachment(passDesc.depthStencilAttachment);
+
+        /* All resources that are read by this pass are needed by previous passes */
+        for (auto resource : passDesc.reads)
+            needed[resource] = true;
+    }
+}
+
+void RenderGraph::Pimpl::AllocateResources()
+{
+    /* Determine lifetime of each resource */
+    for (std::uint32_t i = 0; i < passes.size(); ++i)
+    {
+        if (compiledPasses[i].culled)
+            continue;
+
+        ForEachUsedResource(
+            passes[i],
+            [this, i](RenderGraphResource resource)
+            {
+                auto& entry = resources[resource];
+                if (entry.firstPass == ~0u)
+                    entry.firstPass = i;
+                entry.lastPass = i;
+            }
+        );
+    }
+
+    for (auto& physical : physicalResources)
+    {
+        physical.isAcquired = false;
+        physical.isUsed     = false;
+    }
+
+    /* Assign physical resources to transient resources in order of execution, so resources with disjoint lifetimes share the same physical resource */
+    for (std::uint32_t i = 0; i < passes.size(); ++i)
+    {
+        if (compiledPasses[i].culled)
+            continue;
+
+        for (auto& entry : resources)
+        {
+            if (!entry.isImported && entry.firstPass == i)
+                AcquirePhysicalResource(entry);
+        }
+
+        for (auto& entry : resources)
+        {
+            if (!entry.isImported && entry.lastPass == i && entry.firstPass != ~0u)
+                physicalResources[entry.physical].isAcquired = false;
+        }
+    }
+
+    ReleaseUnusedPhysicalResources();
+
+    /* Resolve physical resources for all transient resources */
+    for (auto& entry : resources)
+    {
+        if (!entry.isImported && entry.firstPass != ~0u)
+        {
+            entry.texture   = physicalResources[entry.physical].texture;
+            entry.buffer    = physicalResources[entry.physical].buffer;
+        }
+    }
+}
+
+void RenderGraph::Pimpl::AcquirePhysicalResource(RenderGraphResourceEntry& entry)
+{
+    /* Find physical resource with equal descriptor that is not acquired by another transient resource */
+    for (std::size_t i = 0; i < physicalResources.size(); ++i)
+    {
+        auto& physical = physicalResources[i];
+        if (physical.isAcquired || physical.isTexture != entry.isTexture)
+            continue;
+
+        const bool isCompatible =
+        (
+            entry.isTexture
+                ? AreTextureDescsEqual(physical.textureDesc, entry.textureDesc)
+                : AreBufferDescsEqual(physical.bufferDesc, entry.bufferDesc)
+        );
+
+        if (isCompatible)
+        {
+            physical.isAcquired = true;
+            physical.isUsed     = true;
+            entry.physical      = i;
+            return;
+        }
+    }
+
+    /* Create new physical resource */
+    RenderGraphPhysicalResource physical;
+    {
+        physical.isTexture      = entry.isTexture;
+        physical.textureDesc    = entry.textureDesc;
+        physical.bufferDesc     = entry.bufferDesc;
+        physical.isAcquired     = true;
+        physical.isUsed         = true;
+        if (entry.isTexture)
+            physical.texture = renderSystem.CreateTexture(entry.textureDesc);
+        else
+            physical.buffer = renderSystem.CreateBuffer(entry.bufferDesc);
+    }
+    entry.physical = physicalResources.size();
+    physicalResources.push_back(physical);
+}
+
+void RenderGraph::Pimpl::ReleaseUnusedPhysicalResources()
+{
+    /* Release cached render targets that refer to unused textures first */
+    for (auto& target : cachedTargets)
+        target.isUsed = true;
+
+    for (const auto& physical : physicalResources)
+    {
+        if (physical.isUsed || physical.texture == nullptr)
+            continue;
+
+        for (auto& target : cachedTargets)
+        {
+            for (const auto& key : target.key)
+            {
+                if (key.texture == physical.texture)
+                    target.isUsed = false;
+            }
+        }
+    }
+
+    RemoveAllFromListIf(
+        cachedTargets,
+        [this](const RenderGraphCachedTarget& target) -> bool
+        {
+            if (!target.isUsed)
+            {
+                renderSystem.Release(*target.renderTarget);
+                return true;
+            }
+            return false;
+        }
+    );
+
+    /* Release unused physical resources and remap the indices of all transient resources */
+    std::vector<std::size_t> remap(physicalResources.size());
+    std::size_t numUsed = 0;
+
+    for (std::size_t i = 0; i < physicalResources.size(); ++i)
+    {
+        auto& physical = physicalResources[i];
+        if (physical.isUsed)
+        {
+            remap[i] = numUsed;
+            physicalResources[numUsed++] = physical;
+        }
+        else
+        {
+            if (physical.texture != nullptr)
+                renderSystem.Release(*physical.texture);
+            if (physical.buffer != nullptr)
+                renderSystem.Release(*physical.buffer);
+        }
+    }
+
+    physicalResources.resize(numUsed);
+
+    for (auto& entry : resources)
+    {
+        if (!entry.isImported && entry.firstPass != ~0u)
+            entry.physical = remap[entry.physical];
+    }
+}
+
+/*
+Derives the load operations of all attachments by traversing all passes in order of execution,
+then creates the render passes and render targets for all passes with attachments.
+*/
+void RenderGraph::Pimpl::CreateRenderTargets()
+{
+    std::vector<bool> hasContent(resources.size());
+    for (std::size_t i = 0; i < resources.size(); ++i)
+        hasContent[i] = resources[i].isImported;
+
+    for (auto& target : cachedTargets)
+        target.isUsed = false;
+
+    for (std::size_t i = 0; i < passes.size(); ++i)
+    {
+        const auto& passDesc = passes[i];
+        auto& compiledPass = compiledPasses[i];
+
+        if (compiledPass.culled || !IsRenderPass(passDesc))
+            continue;
+
+        auto& renderPassDesc = compiledPass.renderPassDesc;
+        compiledPass.clearValues.clear();
+
+        auto GetLoadOp = [&hasContent](const RenderGraphAttachment& attachment) -> AttachmentLoadOp
+        {
+            if (attachment.clear)
+                return AttachmentLoadOp::Clear;
+            if (hasContent[attachment.resource])
+                return AttachmentLoadOp::Load;
+            return AttachmentLoadOp::Undefined;
+        };
+
+        /* Derive color attachment formats and operations */
+        for (std::size_t j = 0; j < passDesc.colorAttachments.size() && j < LLGL_MAX_NUM_COLOR_ATTACHMENTS; ++j)
+        {
+            const auto& attachment = passDesc.colorAttachments[j];
+            const auto& entry = resources[attachment.resource];
+
+            renderPassDesc.colorAttachments[j].format   = entry.textureDesc.format;
+            renderPassDesc.colorAttachments[j].loadOp   = GetLoadOp(attachment);
+            renderPassDesc.samples                      = entry.textureDesc.samples;
+
+            if (attachment.clear)
+                compiledPass.clearValues.push_back(attachment.clearValue);
+        }
+
+        /* Derive depth-stencil attachment format and operations */
+        const auto& depthStencil = passDesc.depthStencilAttachment;
+        if (IsAttachmentEnabled(depthStencil))
+        {
+            const auto& entry = resources[depthStencil.resource];
+            const auto format = entry.textureDesc.format;
+            const auto loadOp = GetLoadOp(depthStencil);
+
+            if (IsDepthFormat(format))
+            {
+                renderPassDesc.depthAttachment.format = format;
+                renderPassDesc.depthAttachment.loadOp = loadOp;
+            }
+            if (IsStencilFormat(format))
+            {
+                renderPassDesc.stencilAttachment.format = format;
+                renderPassDesc.stencilAttachment.loadOp = loadOp;
+            }
+            renderPassDesc.samples = entry.textureDesc.samples;
+
+            if (depthStencil.clear)
+                compiledPass.clearValues.push_back(depthStencil.clearValue);
+        }
+
+        /* All attachments hold content for subsequent passes */
+        for (const auto& attachment : passDesc.colorAttachments)
+            hasContent[attachment.resource] = true;
+        if (IsAttachmentEnabled(depthStencil))
+            hasContent[depthStencil.resource] = true;
+
+        compiledPass.renderPass     = GetOrCreateRenderPass(renderPassDesc);
+        compiledPass.renderTarget   = GetOrCreateRenderTarget(passDesc, compiledPass.renderPass);
+    }
+
+    /* Release cached render targets that are no longer used */
+    RemoveAllFromListIf(
+        cachedTargets,
+        [this](const RenderGraphCachedTarget& target) -> bool
+        {
+            if (!target.isUsed)
+            {
+                renderSystem.Release(*target.renderTarget);
+                return true;
+            }
+            return false;
+        }
+    );
+}
+
+RenderPass* RenderGraph::Pimpl::GetOrCreateRenderPass(const RenderPassDescriptor& renderPassDesc)
+{
+    for (const auto& pass : cachedPasses)
+    {
+        if (AreRenderPassDescsEqual(pass.desc, renderPassDesc))
+            return pass.renderPass;
+    }
+
+    RenderGraphCachedPass pass;
+    {
+        pass.desc       = renderPassDesc;
+        pass.renderPass = renderSystem.CreateRenderPass(renderPassDesc);
+    }
+    cachedPasses.push_back(pass);
+
+    return pass.renderPass;
+}
+
+RenderTarget* RenderGraph::Pimpl::GetOrCreateRenderTarget(const RenderGraphPassDescriptor& passDesc, RenderPass* renderPass)
+{
+    /* Build key of all attachments */
+    std::vector<RenderGraphTargetKey> key;
+    key.reserve(passDesc.colorAttachments.size() + 1);
+
+    auto AppendKey = [this, &key](const RenderGraphAttachment& attachment)
+    {
+        key.push_back({ resources[attachment.resource].texture, attachment.mipLevel, attachment.arrayLayer });
+    };
+
+    for (const auto& attachment : passDesc.colorAttachments)
+        AppendKey(attachment);
+    if (IsAttachmentEnabled(passDesc.depthStencilAttachment))
+        AppendKey(passDesc.depthStencilAttachment);
+
+    /* Find cached render target; render passes with the same attachment formats are compatible with it */
+    for (auto& target : cachedTargets)
+    {
+        if (AreTargetKeysEqual(target.key, key))
+        {
+            target.isUsed = true;
+            return target.renderTarget;
+        }
+    }
+
+    /* Create new render target */
+    const auto& firstAttachment = (passDesc.colorAttachments.empty() ? passDesc.depthStencilAttachment : passDesc.colorAttachments.front());
+    const auto& firstTextureDesc = resources[firstAttachment.resource].textureDesc;
+    const auto resolution = GetMipExtent(firstTextureDesc, firstAttachment.mipLevel);
+
+    RenderTargetDescriptor renderTargetDesc;
+    {
+        renderTargetDesc.renderPass             = renderPass;
+        renderTargetDesc.resolution             = { resolution.width, resolution.height };
+        renderTargetDesc.samples                = firstTextureDesc.samples;
+        renderTargetDesc.customMultiSampling    = IsMultiSampleTexture(firstTextureDesc.type);
+
+        for (const auto& attachment : passDesc.colorAttachments)
+        {
+            renderTargetDesc.attachments.push_back(
+                AttachmentDescriptor{ AttachmentType::Color, resources[attachment.resource].texture, attachment.mipLevel, attachment.arrayLayer }
+            );
+        }
+
+        const auto& depthStencil = passDesc.depthStencilAttachment;
+        if (IsAttachmentEnabled(depthStencil))
+        {
+            const auto format = resources[depthStencil.resource].textureDesc.format;
+            const auto type = (IsStencilFormat(format) ? AttachmentType::DepthStencil : AttachmentType::Depth);
+            renderTargetDesc.attachments.push_back(
+                AttachmentDescriptor{ type, resources[depthStencil.resource].texture, depthStencil.mipLevel, depthStencil.arrayLayer }
+            );
+        }
+    }
+
+    RenderGraphCachedTarget target;
+    {
+        target.key          = std::move(key);
+        target.renderTarget = renderSystem.CreateRenderTarget(renderTargetDesc);
+        target.isUsed       = true;
+    }
+    cachedTargets.push_back(std::move(target));
+
+    return cachedTargets.back().renderTarget;
+}
+
+
+/*
+ * RenderGraph class
+ */
+
+RenderGraph::RenderGraph(RenderSystem& renderSystem) :
+    pimpl_ { new Pimpl{ renderSystem } }
+{
+}
+
+RenderGraph::~RenderGraph()
+{
+    delete pimpl_;
+}
+
+void RenderGraph::Reset()
+{
+    pimpl_->resources.clear();
+    pimpl_->passes.clear();
+    pimpl_->compiledPasses.clear();
+    pimpl_->isCompiled = false;
+}
+
+RenderGraphResource RenderGraph::CreateTexture(const TextureDescriptor& textureDesc)
+{
+    RenderGraphResourceEntry entry;
+    {
+        entry.isTexture     = true;
+        entry.textureDesc   = textureDesc;
+    }
+    pimpl_->resources.push_back(entry);
+    pimpl_->isCompiled = false;
+    return static_cast<RenderGraphResource>(pimpl_->resources.size() - 1);
+}
+
+RenderGraphResource RenderGraph::CreateBuffer(const BufferDescriptor& bufferDesc)
+{
+    RenderGraphResourceEntry entry;
+    {
+        entry.isTexture     = false;
+        entry.bufferDesc    = bufferDesc;
+
+        /* Vertex attributes refer to memory of the caller, which is not kept alive */
+        entry.bufferDesc.vertexAttribs = {};
+    }
+    pimpl_->resources.push_back(entry);
+    pimpl_->isCompiled = false;
+    return static_cast<RenderGraphResource>(pimpl_->resources.size() - 1);
+}
+
+RenderGraphResource RenderGraph::ImportTexture(Texture& texture)
+{
+    RenderGraphResourceEntry entry;
+    {
+        entry.isTexture     = true;
+        entry.isImported    = true;
+        entry.textureDesc   = texture.GetDesc();
+        entry.texture       = &texture;
+    }
+    pimpl_->resources.push_back(entry);
+    pimpl_->isCompiled = false;
+    return static_cast<RenderGraphResource>(pimpl_->resources.size() - 1);
+}
+
+RenderGraphResource RenderGraph::ImportBuffer(Buffer& buffer)
+{
+    RenderGraphResourceEntry entry;
+    {
+        entry.isTexture     = false;
+        entry.isImported    = true;
+        entry.buffer        = &buffer;
+    }
+    pimpl_->resources.push_back(entry);
+    pimpl_->isCompiled = false;
+    return static_cast<RenderGraphResource>(pimpl_->resources.size() - 1);
+}
+
+std::uint32_t RenderGraph::AddPass(const RenderGraphPassDescriptor& passDesc)
+{
+    if (passDesc.colorAttachments.size() > LLGL_MAX_NUM_COLOR_ATTACHMENTS)
+        throw std::invalid_argument("too many color attachments in render graph pass: " + std::to_string(passDesc.colorAttachments.size()));
+    pimpl_->passes.push_back(passDesc);
+    pimpl_->isCompiled = false;
+    return static_cast<std::uint32_t>(pimpl_->passes.size() - 1);
+}
+
+void RenderGraph::Compile()
+{
+    for (const auto& passDesc : pimpl_->passes)
+        pimpl_->ValidatePass(passDesc);
+
+    /* Reset previous compilation */
+    pimpl_->compiledPasses.clear();
+    pimpl_->compiledPasses.resize(pimpl_->passes.size());
+
+    for (auto& entry : pimpl_->resources)
+    {
+        entry.firstPass = ~0u;
+        entry.lastPass  = 0;
+        if (!entry.isImported)
+        {
+            entry.texture   = nullptr;
+            entry.buffer    = nullptr;
+        }
+    }
+
+    pimpl_->CullPasses();
+    pimpl_->AllocateResources();
+    pimpl_->CreateRenderTargets();
+    pimpl_->isCompiled = true;
+}
+
+void RenderGraph::Execute(CommandBuffer& commandBuffer)
+{
+    if (!pimpl_->isCompiled)
+        Compile();
+
+    for (std::size_t i = 0; i < pimpl_->passes.size(); ++i)
+    {
+        const auto& passDesc = pimpl_->passes[i];
+        const auto& compiledPass = pimpl_->compiledPasses[i];
+
+        if (compiledPass.culled)
+            continue;
+
+        if (passDesc.name != nullptr)
+            commandBuffer.PushDebugGroup(passDesc.name);
+
+        if (compiledPass.renderTarget != nullptr)
+        {
+            commandBuffer.BeginRenderPass(
+                *compiledPass.renderTarget,
+                compiledPass.renderPass,
+                static_cast<std::uint32_t>(compiledPass.clearValues.size()),
+                compiledPass.clearValues.data()
+            );
+            {
+                if (passDesc.execute)
+                    passDesc.execute(commandBuffer, *this);
+            }
+            commandBuffer.EndRenderPass();
+        }
+        else if (passDesc.execute)
+            passDesc.execute(commandBuffer, *this);
+
+        if (passDesc.name != nullptr)
+            commandBuffer.PopDebugGroup();
+    }
+}
+
+Texture* RenderGraph::GetTexture(RenderGraphResource resource) const
+{
+    if (resource < pimpl_->resources.size())
+        return pimpl_->resources[resource].texture;
+    return nullptr;
+}
+
+Buffer* RenderGraph::GetBuffer(RenderGraphResource resource) const
+{
+    if (resource < pimpl_->resources.size())
+        return pimpl_->resources[resource].buffer;
+    return nullptr;
+}
+
+bool RenderGraph::IsPassCulled(std::uint32_t pass) const
+{
+    if (pass < pimpl_->compiledPasses.size())
+        return pimpl_->compiledPasses[pass].culled;
+    return true;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -7,21 +7,27 @@
 
 #include "../Platform/Module.h"
 #include "../Core/Helper.h"
+#include "../Core/BasicReport.h"
+#include "../Core/ImageUtils.h"
 #include <LLGL/Platform/Platform.h>
 #include <LLGL/Format.h>
 #include <LLGL/ImageFlags.h>
 #include <LLGL/StaticLimits.h>
 #include <LLGL/Log.h>
+#include <LLGL/Timer.h>
 #include "BuildID.h"
 
 #include <LLGL/RenderSystem.h>
 #include <string>
 #include <map>
+#include <algorithm>
 
 #ifdef LLGL_ENABLE_DEBUG_LAYER
 #   include "DebugLayer/DbgRenderSystem.h"
 #endif
 
+#include "CaptureLayer/CapRenderSystem.h"
+
 #include <LLGL/Platform/Platform.h>
 #ifdef LLGL_OS_ANDROID
 #   include "../Platform/Android/AndroidApp.h"
@@ -36,12 +42,27 @@ namespace LLGL
 
 /* ----- Render system ----- */
 
+struct StartupPhaseTicks
+{
+    const char*     name;
+    const char*     source;     // Null for phases of the backend
+    std::uint64_t   startTick;
+    std::uint64_t   endTick;
+};
+
 struct RenderSystem::Pimpl
 {
-    int                     rendererID = 0;
-    std::string             name;
-    RendererInfo            info;
-    RenderingCapabilities   caps;
+    int                             rendererID              = 0;
+    std::string                     name;
+    RendererInfo                    info;
+    RenderingCapabilities           caps;
+    BasicReport                     report;
+
+    /* Phases are recorded until RenderSystem::Load knows whether start-up timing is enabled, since the backend records them in its constructor */
+    std::vector<StartupPhaseTicks>  startupPhases;
+    bool                            startupTimingEnabled    = true;
+    std::uint64_t                   loadStartTick           = 0;
+    std::uint64_t                   loadEndTick             = 0;
 };
 
 static std::map<RenderSystem*, std::unique_ptr<Module>> g_renderSystemModules;
@@ -160,8 +181,50 @@ static RenderSystemDeleter::RenderSystemDeleterFuncPtr LoadRenderSystemDeleter(M
     return reinterpret_cast<RenderSystemDeleter::RenderSystemDeleterFuncPtr>(module.LoadProcedure("LLGL_RenderSystem_Free"));
 }
 
+static void LoadRenderSystemVideoAdapters(Module& module, const RenderSystemDescriptor& renderSystemDesc, std::vector<VideoAdapterDescriptor>& outAdapters)
+{
+    /* Load optional "LLGL_RenderSystem_QueryVideoAdapters" procedure */
+    LLGL_PROC_INTERFACE(int, PFN_RENDERSYSTEM_QUERYVIDEOADAPTERS, (const void*, int, void*));
+
+    auto RenderSystem_QueryVideoAdapters = reinterpret_cast<PFN_RENDERSYSTEM_QUERYVIDEOADAPTERS>(module.LoadProcedure("LLGL_RenderSystem_QueryVideoAdapters"));
+    if (RenderSystem_QueryVideoAdapters)
+        RenderSystem_QueryVideoAdapters(&renderSystemDesc, static_cast<int>(sizeof(RenderSystemDescriptor)), &outAdapters);
+}
+
 #endif // /LLGL_BUILD_STATIC_LIB
 
+std::vector<VideoAdapterDescriptor> RenderSystem::QueryVideoAdapters(const RenderSystemDescriptor& renderSystemDesc)
+{
+    std::vector<VideoAdapterDescriptor> adapters;
+
+    #ifdef LLGL_BUILD_STATIC_LIB
+
+    StaticModule::QueryVideoAdapters(renderSystemDesc, adapters);
+
+    #else // LLGL_BUILD_STATIC_LIB
+
+    /* Load render system module temporarily; no render system is allocated */
+    auto moduleFilename = Module::GetModuleFilename(renderSystemDesc.moduleName.c_str());
+    auto module         = Module::Load(moduleFilename.c_str());
+
+    if (!LoadRenderSystemBuildID(*module, moduleFilename))
+        throw std::runtime_error("build ID mismatch in render system module");
+
+    LoadRenderSystemVideoAdapters(*module, renderSystemDesc, adapters);
+
+    #endif // /LLGL_BUILD_STATIC_LIB
+
+    return adapters;
+}
+
+// Wraps the specified render system into the capture layer if a capture file is specified.
+static RenderSystemPtr WrapCaptureLayer(RenderSystemPtr&& renderSystem, const RenderSystemDescriptor& renderSystemDesc)
+{
+    if (renderSystemDesc.captureFilename != nullptr)
+        return RenderSystemPtr{ new CapRenderSystem(std::move(renderSystem), renderSystemDesc.captureFilename, renderSystemDesc.moduleName.c_str()) };
+    return std::move(renderSystem);
+}
+
 RenderSystemPtr RenderSystem::Load(
     const RenderSystemDescriptor&   renderSystemDesc,
     RenderingProfiler*              profiler,
@@ -176,18 +239,34 @@ RenderSystemPtr RenderSystem::Load(
 
     #ifdef LLGL_BUILD_STATIC_LIB
 
+    #ifdef LLGL_ENABLE_STATIC_DISPATCH
+
+    /* Static dispatch of command buffer functions cannot go through the debug or capture layer */
+    if (profiler != nullptr || debugger != nullptr || renderSystemDesc.captureFilename != nullptr)
+        throw std::invalid_argument("cannot load render system with debug or capture layer when LLGL was built with LLGL_ENABLE_STATIC_DISPATCH");
+
+    #endif // /LLGL_ENABLE_STATIC_DISPATCH
+
     /* Allocate render system */
+    const std::uint64_t loadStartTick = Timer::Tick();
+
     auto renderSystem = RenderSystemPtr
     {
         reinterpret_cast<RenderSystem*>(StaticModule::AllocRenderSystem(renderSystemDesc))
     };
 
+    RenderSystem* backend = renderSystem.get();
+    backend->FinishStartupTiming(renderSystemDesc.flags, loadStartTick, loadStartTick, Timer::Tick());
+
+    /* Create capture layer render system (if enabled) */
+    renderSystem = WrapCaptureLayer(std::move(renderSystem), renderSystemDesc);
+
     if (profiler != nullptr || debugger != nullptr)
     {
         #ifdef LLGL_ENABLE_DEBUG_LAYER
 
         /* Create debug layer render system */
-        renderSystem = RenderSystemPtr{ new DbgRenderSystem(std::move(renderSystem), profiler, debugger) };
+        renderSystem = RenderSystemPtr{ new DbgRenderSystem(std::move(renderSystem), profiler, debugger, renderSystemDesc.debugValidation) };
 
         #else
 
@@ -199,12 +278,18 @@ RenderSystemPtr RenderSystem::Load(
     renderSystem->pimpl_->name          = StaticModule::GetRendererName(renderSystemDesc.moduleName);
     renderSystem->pimpl_->rendererID    = StaticModule::GetRendererID(renderSystemDesc.moduleName);
 
+    /* Backend phases are attributed to the name of the backend, which might be wrapped by a layer */
+    backend->pimpl_->name = renderSystem->pimpl_->name;
+    backend->pimpl_->loadEndTick = Timer::Tick();
+
     /* Return new render system and unique pointer */
     return renderSystem;
 
     #else // LLGL_BUILD_STATIC_LIB
 
     /* Load render system module */
+    const std::uint64_t loadStartTick = Timer::Tick();
+
     auto moduleFilename = Module::GetModuleFilename(renderSystemDesc.moduleName.c_str());
     auto module         = Module::Load(moduleFilename.c_str());
 
@@ -215,6 +300,8 @@ RenderSystemPtr RenderSystem::Load(
     if (!LoadRenderSystemBuildID(*module, moduleFilename))
         throw std::runtime_error("build ID mismatch in render system module");
 
+    const std::uint64_t moduleTick = Timer::Tick();
+
     try
     {
         /* Allocate render system */
@@ -224,12 +311,18 @@ RenderSystemPtr RenderSystem::Load(
             RenderSystemDeleter{ LoadRenderSystemDeleter(*module) }
         };
 
+        RenderSystem* backend = renderSystem.get();
+        backend->FinishStartupTiming(renderSystemDesc.flags, loadStartTick, moduleTick, Timer::Tick());
+
+        /* Create capture layer render system (if enabled) */
+        renderSystem = WrapCaptureLayer(std::move(renderSystem), renderSystemDesc);
+
         if (profiler != nullptr || debugger != nullptr)
         {
             #ifdef LLGL_ENABLE_DEBUG_LAYER
 
             /* Create debug layer render system */
-            renderSystem = RenderSystemPtr{ new DbgRenderSystem(std::move(renderSystem), profiler, debugger) };
+            renderSystem = RenderSystemPtr{ new DbgRenderSystem(std::move(renderSystem), profiler, debugger, renderSystemDesc.debugValidation) };
 
             #else
 
@@ -241,6 +334,10 @@ RenderSystemPtr RenderSystem::Load(
         renderSystem->pimpl_->name          = LoadRenderSystemName(*module,renderSystemDesc);
         renderSystem->pimpl_->rendererID    = LoadRenderSystemRendererID(*module,renderSystemDesc);
 
+        /* Backend phases are attributed to the name of the backend, which might be wrapped by a layer */
+        backend->pimpl_->name = renderSystem->pimpl_->name;
+        backend->pimpl_->loadEndTick = Timer::Tick();
+
         /* Store new module inside internal map */
         g_renderSystemModules[renderSystem.get()] = std::move(module);
 
@@ -287,6 +384,152 @@ const RenderingCapabilities& RenderSystem::GetRenderingCaps() const
     return pimpl_->caps;
 }
 
+const Report* RenderSystem::GetReport() const
+{
+    return (pimpl_->report ? &(pimpl_->report) : nullptr);
+}
+
+CommandQueue* RenderSystem::GetComputeQueue()
+{
+    return nullptr; // dummy
+}
+
+void RenderSystem::WriteBuffer(Buffer& buffer, std::uint32_t numRegions, const BufferWriteRegion* regions)
+{
+    for (std::uint32_t i = 0; i < numRegions; ++i)
+        WriteBuffer(buffer, regions[i].dstOffset, regions[i].data, regions[i].dataSize);
+}
+
+const void* RenderSystem::MapReadback(std::uint64_t /*ticket*/, ReadbackLayout* /*outLayout*/)
+{
+    return nullptr; // dummy
+}
+
+void RenderSystem::UnmapReadback(std::uint64_t /*ticket*/)
+{
+    // dummy
+}
+
+bool RenderSystem::QueryTextureTiling(const Texture& /*texture*/, TextureTiling& /*outTiling*/)
+{
+    return false; // dummy
+}
+
+void RenderSystem::CommitTextureTiles(Texture& /*texture*/, const TextureRegion& /*textureRegion*/)
+{
+    // dummy
+}
+
+void RenderSystem::DecommitTextureTiles(Texture& /*texture*/, const TextureRegion& /*textureRegion*/)
+{
+    // dummy
+}
+
+bool RenderSystem::QueryNativeHandle(const Resource& /*resource*/, NativeResourceHandle& /*outHandle*/)
+{
+    return false; // dummy
+}
+
+bool RenderSystem::ExportResource(Resource& /*resource*/, NativeHandleType /*handleType*/, NativeResourceHandle& /*outHandle*/)
+{
+    return false; // dummy
+}
+
+Buffer* RenderSystem::ImportBuffer(const BufferDescriptor& /*bufferDesc*/, const NativeResourceHandle& /*nativeHandle*/)
+{
+    return nullptr; // dummy
+}
+
+Texture* RenderSystem::ImportTexture(const TextureDescriptor& /*textureDesc*/, const NativeResourceHandle& /*nativeHandle*/)
+{
+    return nullptr; // dummy
+}
+
+void RenderSystem::CreateShaders(std::uint32_t numShaders, const ShaderDescriptor* shaderDescs, Shader** outShaders)
+{
+    for (std::uint32_t i = 0; i < numShaders; ++i)
+        outShaders[i] = CreateShader(shaderDescs[i]);
+}
+
+PipelineState* RenderSystem::CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc, long /*flags*/)
+{
+    return CreatePipelineState(pipelineStateDesc);
+}
+
+PipelineState* RenderSystem::CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc, long /*flags*/)
+{
+    return CreatePipelineState(pipelineStateDesc);
+}
+
+bool RenderSystem::QueryMemoryStatistics(MemoryStatistics& outStats)
+{
+    outStats.heaps.clear();
+    return false;
+}
+
+bool RenderSystem::SetResidencyPriority(const ArrayView<Resource*>& /*resources*/, ResidencyPriority /*priority*/)
+{
+    return false; // dummy
+}
+
+bool RenderSystem::MakeResident(const ArrayView<Resource*>& /*resources*/)
+{
+    return false; // dummy
+}
+
+bool RenderSystem::Evict(const ArrayView<Resource*>& /*resources*/)
+{
+    return false; // dummy
+}
+
+bool RenderSystem::QueryCommandStatistics(CommandStatistics& outStats)
+{
+    outStats.commands.clear();
+    return false;
+}
+
+// Returns the specified number of timer ticks in nanoseconds.
+static std::uint64_t TicksToNanoseconds(std::uint64_t ticks)
+{
+    return static_cast<std::uint64_t>(static_cast<double>(ticks) * 1.0e9 / static_cast<double>(Timer::Frequency()));
+}
+
+bool RenderSystem::QueryStartupStatistics(StartupStatistics& outStats)
+{
+    outStats.phases.clear();
+    outStats.totalTime = 0;
+
+    if (pimpl_->startupPhases.empty())
+        return false;
+
+    /* Phases of the core library are stored after the backend phases they enclose, so sort all phases by their start tick */
+    auto phases = pimpl_->startupPhases;
+    std::stable_sort(
+        phases.begin(), phases.end(),
+        [](const StartupPhaseTicks& lhs, const StartupPhaseTicks& rhs)
+        {
+            return (lhs.startTick < rhs.startTick);
+        }
+    );
+
+    outStats.phases.reserve(phases.size());
+    for (const auto& phaseTicks : phases)
+    {
+        StartupPhase phase;
+        {
+            phase.name      = phaseTicks.name;
+            phase.source    = (phaseTicks.source != nullptr ? phaseTicks.source : pimpl_->name.c_str());
+            phase.startTime = TicksToNanoseconds(phaseTicks.startTick - pimpl_->loadStartTick);
+            phase.duration  = TicksToNanoseconds(phaseTicks.endTick - phaseTicks.startTick);
+        }
+        outStats.phases.push_back(phase);
+    }
+
+    outStats.totalTime = TicksToNanoseconds(pimpl_->loadEndTick - pimpl_->loadStartTick);
+
+    return true;
+}
+
 
 /*
  * ======= Protected: =======
@@ -302,6 +545,17 @@ void RenderSystem::SetRenderingCaps(const RenderingCapabilities& caps)
     pimpl_->caps = caps;
 }
 
+void RenderSystem::SetReport(const char* text, bool hasErrors)
+{
+    pimpl_->report.Reset(StringView{ text }, hasErrors);
+}
+
+void RenderSystem::RecordStartupPhase(const char* name, std::uint64_t startTick, std::uint64_t endTick)
+{
+    if (pimpl_->startupTimingEnabled)
+        pimpl_->startupPhases.push_back(StartupPhaseTicks{ name, nullptr, startTick, endTick });
+}
+
 void RenderSystem::AssertCreateBuffer(const BufferDescriptor& bufferDesc, std::uint64_t maxSize)
 {
     /* Validate size */
@@ -426,6 +680,34 @@ static void CopyRowAlignedData(void* dstData, const void* srcData, std::size_t d
         ::memcpy(dst, src, dstStride);
 }
 
+// Returns the minimum size (in bytes) of the destination image with its optional row and layer strides.
+static std::size_t GetStridedImageDataSize(const DstImageDescriptor& imageDesc, const Extent3D& extent, std::size_t formatSize)
+{
+    const std::size_t rowSize       = extent.width * formatSize;
+    const std::size_t rowStride     = (imageDesc.rowStride != 0 ? imageDesc.rowStride : rowSize);
+    const std::size_t layerStride   = (imageDesc.layerStride != 0 ? imageDesc.layerStride : rowStride * extent.height);
+    if (extent.width == 0 || extent.height == 0 || extent.depth == 0)
+        return 0;
+    return (layerStride * (extent.depth - 1) + rowStride * (extent.height - 1) + rowSize);
+}
+
+// Copies the source image with the specified row stride into the destination image with its optional row and layer strides.
+static void CopyStridedImageData(const DstImageDescriptor& dstImageDesc, const Extent3D& extent, std::uint32_t formatSize, const void* srcData, std::uint32_t srcRowStride)
+{
+    const std::uint32_t rowSize         = extent.width * formatSize;
+    const std::uint32_t dstRowStride    = (dstImageDesc.rowStride != 0 ? dstImageDesc.rowStride : rowSize);
+    BitBlit(
+        extent,
+        formatSize,
+        static_cast<char*>(dstImageDesc.data),
+        dstRowStride,
+        (dstImageDesc.layerStride != 0 ? dstImageDesc.layerStride : dstRowStride * extent.height),
+        static_cast<const char*>(srcData),
+        srcRowStride,
+        srcRowStride * extent.height
+    );
+}
+
 void RenderSystem::CopyTextureImageData(
     const DstImageDescriptor&   dstImageDesc,
     const Extent3D&             extent,
@@ -439,6 +721,7 @@ void RenderSystem::CopyTextureImageData(
     auto        srcFormatSize   = DataTypeSize(srcTexFormat.dataType) * ImageFormatSize(srcTexFormat.format);
     auto        srcImageSize    = (numTexels * srcFormatSize);
     const auto  dstPitch        = (extent.width * srcFormatSize);
+    const bool  dstStrided      = (dstImageDesc.rowStride != 0 || dstImageDesc.layerStride != 0);
 
     if (srcTexFormat.format != dstImageDesc.format || srcTexFormat.dataType != dstImageDesc.dataType)
     {
@@ -456,7 +739,7 @@ void RenderSystem::CopyTextureImageData(
         auto dstImageSize   = (numTexels * dstFormatSize);
 
         /* Validate input size */
-        AssertImageDataSize(dstImageDesc.dataSize, dstImageSize);
+        AssertImageDataSize(dstImageDesc.dataSize, GetStridedImageDataSize(dstImageDesc, extent, dstFormatSize));
 
         /* Convert mapped data into requested format */
         auto tempData = ConvertImageBuffer(
@@ -473,15 +756,20 @@ void RenderSystem::CopyTextureImageData(
         );
 
         /* Copy temporary data into output buffer */
-        ::memcpy(dstImageDesc.data, tempData.get(), dstImageSize);
+        if (dstStrided)
+            CopyStridedImageData(dstImageDesc, extent, dstFormatSize, tempData.get(), extent.width * dstFormatSize);
+        else
+            ::memcpy(dstImageDesc.data, tempData.get(), dstImageSize);
     }
     else
     {
         /* Validate input size */
-        AssertImageDataSize(dstImageDesc.dataSize, srcImageSize);
+        AssertImageDataSize(dstImageDesc.dataSize, GetStridedImageDataSize(dstImageDesc, extent, srcFormatSize));
 
         /* Copy mapped data directly into the output buffer */
-        if (rowStride != 0 && dstPitch != rowStride)
+        if (dstStrided)
+            CopyStridedImageData(dstImageDesc, extent, srcFormatSize, data, static_cast<std::uint32_t>(rowStride != 0 ? rowStride : dstPitch));
+        else if (rowStride != 0 && dstPitch != rowStride)
             CopyRowAlignedData(dstImageDesc.data, data, srcImageSize, dstPitch, rowStride);
         else
             ::memcpy(dstImageDesc.data, data, srcImageSize);
@@ -489,6 +777,29 @@ void RenderSystem::CopyTextureImageData(
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+void RenderSystem::FinishStartupTiming(long flags, std::uint64_t loadStartTick, std::uint64_t moduleTick, std::uint64_t allocTick)
+{
+    if ((flags & RenderSystemFlags::StartupTiming) != 0)
+    {
+        pimpl_->loadStartTick = loadStartTick;
+        if (moduleTick > loadStartTick)
+            pimpl_->startupPhases.push_back(StartupPhaseTicks{ "module loading", "LLGL", loadStartTick, moduleTick });
+        pimpl_->startupPhases.push_back(StartupPhaseTicks{ "render system allocation", "LLGL", moduleTick, allocTick });
+    }
+    else
+    {
+        /* Discard phases the backend has recorded in its constructor and ignore all further phases */
+        pimpl_->startupTimingEnabled = false;
+        pimpl_->startupPhases.clear();
+        pimpl_->startupPhases.shrink_to_fit();
+    }
+}
+
+
 } // /namespace LLGL
 
 
@@ -92,15 +92,22 @@ LLGL_EXPORT bool ValidateRenderingCaps(
     LLGL_VALIDATE_FEATURE( hasTessellationShaders,       "tessellation shaders"       );
     LLGL_VALIDATE_FEATURE( hasTessellatorStage,          "tessellator stage"          );
     LLGL_VALIDATE_FEATURE( hasComputeShaders,            "compute shaders"            );
+    LLGL_VALIDATE_FEATURE( hasMeshShaders,               "mesh shaders"               );
     LLGL_VALIDATE_FEATURE( hasInstancing,                "hardware instancing"        );
     LLGL_VALIDATE_FEATURE( hasOffsetInstancing,          "offset instancing"          );
     LLGL_VALIDATE_FEATURE( hasIndirectDrawing,           "indirect drawing"           );
+    LLGL_VALIDATE_FEATURE( hasIndirectCountDrawing,      "indirect count drawing"     );
+    LLGL_VALIDATE_FEATURE( hasIndirectCommandBuffers,    "indirect command buffers"   );
     LLGL_VALIDATE_FEATURE( hasViewportArrays,            "viewport arrays"            );
     LLGL_VALIDATE_FEATURE( hasConservativeRasterization, "conservative rasterization" );
+    LLGL_VALIDATE_FEATURE( hasVariableRateShading,       "variable rate shading"      );
     LLGL_VALIDATE_FEATURE( hasStreamOutputs,             "stream outputs"             );
     LLGL_VALIDATE_FEATURE( hasLogicOp,                   "logic fragment operations"  );
     LLGL_VALIDATE_FEATURE( hasPipelineStatistics,        "query pipeline statistics"  );
     LLGL_VALIDATE_FEATURE( hasRenderCondition,           "conditional rendering"      );
+    LLGL_VALIDATE_FEATURE( hasNativeCommandLists,        "native command lists"       );
+    LLGL_VALIDATE_FEATURE( hasDescriptorIndexing,        "descriptor indexing"        );
+    LLGL_VALIDATE_FEATURE( hasFramebufferFetch,          "framebuffer fetch"          );
 
     #undef LLGL_VALIDATE_FEATURE
 
@@ -160,6 +167,9 @@ LLGL_EXPORT bool ValidateRenderingCaps(
     LLGL_VALIDATE_LIMIT( maxComputeShaderWorkGroupSize[0],  "compute shader work group size on X-axis"  );
     LLGL_VALIDATE_LIMIT( maxComputeShaderWorkGroupSize[1],  "compute shader work group size on Y-axis"  );
     LLGL_VALIDATE_LIMIT( maxComputeShaderWorkGroupSize[2],  "compute shader work group size on Z-axis"  );
+    LLGL_VALIDATE_LIMIT( maxMeshShaderWorkGroups[0],        "mesh shader work groups on X-axis"         );
+    LLGL_VALIDATE_LIMIT( maxMeshShaderWorkGroups[1],        "mesh shader work groups on Y-axis"         );
+    LLGL_VALIDATE_LIMIT( maxMeshShaderWorkGroups[2],        "mesh shader work groups on Z-axis"         );
     LLGL_VALIDATE_LIMIT( maxViewports,                      "viewports"                                 );
     LLGL_VALIDATE_LIMIT( maxViewportSize[0],                "viewport width"                            );
     LLGL_VALIDATE_LIMIT( maxViewportSize[1],                "viewport height"                           );
@@ -0,0 +1,310 @@
+/*
+ * RenderTargetPool.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/RenderTargetPool.h>
+#include <LLGL/RenderSystem.h>
+#include "../Core/Helper.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal structures ----- */
+
+struct RenderTargetPoolEntry
+{
+    PooledRenderTarget              target;
+    PooledRenderTargetDescriptor    key;                // Descriptor with the allocated resolution
+    bool                            isUsed      = false;
+    std::uint64_t                   lastRelease = 0;    // Release counter for LRU eviction
+};
+
+static bool AreRenderTargetKeysEqual(const PooledRenderTargetDescriptor& lhs, const PooledRenderTargetDescriptor& rhs)
+{
+    if (lhs.resolution          != rhs.resolution           ||
+        lhs.samples             != rhs.samples              ||
+        lhs.depthStencilFormat  != rhs.depthStencilFormat   ||
+        lhs.bindFlags           != rhs.bindFlags            ||
+        lhs.renderPass          != rhs.renderPass)
+    {
+        return false;
+    }
+
+    for (std::uint32_t i = 0; i < LLGL_MAX_NUM_COLOR_ATTACHMENTS; ++i)
+    {
+        if (lhs.colorFormats[i] != rhs.colorFormats[i])
+            return false;
+        if (lhs.colorFormats[i] == Format::Undefined)
+            break;
+    }
+
+    return true;
+}
+
+static std::uint32_t GetNumColorFormats(const PooledRenderTargetDescriptor& desc)
+{
+    std::uint32_t n = 0;
+    while (n < LLGL_MAX_NUM_COLOR_ATTACHMENTS && desc.colorFormats[n] != Format::Undefined)
+        ++n;
+    return n;
+}
+
+
+/*
+ * Pimpl structure
+ */
+
+struct RenderTargetPool::Pimpl
+{
+    Pimpl(RenderSystem& renderSystem, const RenderTargetPoolDescriptor& poolDesc);
+    ~Pimpl();
+
+    Extent2D GetAllocatedResolution(const Extent2D& resolution) const;
+
+    RenderTargetPoolEntry* FindUnusedEntry(const PooledRenderTargetDescriptor& key);
+    std::unique_ptr<RenderTargetPoolEntry> CreateEntry(const PooledRenderTargetDescriptor& key);
+    void ReleaseEntry(RenderTargetPoolEntry& entry);
+
+    void EvictUnusedEntries(std::uint32_t maxUnusedEntries);
+
+    RenderSystem&                                       renderSystem;
+    RenderTargetPoolDescriptor                          desc;
+    std::vector<std::unique_ptr<RenderTargetPoolEntry>> entries;
+    std::uint32_t                                       numUnusedEntries    = 0;
+    std::uint64_t                                       releaseCounter      = 0;
+    std::uint64_t                                       numCreatedEntries   = 0;
+};
+
+RenderTargetPool::Pimpl::Pimpl(RenderSystem& renderSystem, const RenderTargetPoolDescriptor& poolDesc) :
+    renderSystem { renderSystem },
+    desc         { poolDesc     }
+{
+}
+
+RenderTargetPool::Pimpl::~Pimpl()
+{
+    for (auto& entry : entries)
+        ReleaseEntry(*entry);
+}
+
+Extent2D RenderTargetPool::Pimpl::GetAllocatedResolution(const Extent2D& resolution) const
+{
+    /* Allocate at maximum size if the requested resolution fits into it, so resolution changes map to the same render target */
+    if (resolution.width  <= desc.maxResolution.width &&
+        resolution.height <= desc.maxResolution.height)
+    {
+        return desc.maxResolution;
+    }
+    return resolution;
+}
+
+RenderTargetPoolEntry* RenderTargetPool::Pimpl::FindUnusedEntry(const PooledRenderTargetDescriptor& key)
+{
+    /* Find most recently released entry with the same key, so its attachments are most likely still resident */
+    RenderTargetPoolEntry* bestEntry = nullptr;
+    for (auto& entry : entries)
+    {
+        if (!entry->isUsed && AreRenderTargetKeysEqual(entry->key, key))
+        {
+            if (bestEntry == nullptr || entry->lastRelease > bestEntry->lastRelease)
+                bestEntry = entry.get();
+        }
+    }
+    return bestEntry;
+}
+
+std::unique_ptr<RenderTargetPoolEntry> RenderTargetPool::Pimpl::CreateEntry(const PooledRenderTargetDescriptor& key)
+{
+    auto entry = MakeUnique<RenderTargetPoolEntry>();
+    entry->key = key;
+
+    auto& target = entry->target;
+    target.allocatedResolution = key.resolution;
+
+    /* Create attachment textures */
+    TextureDescriptor textureDesc;
+    {
+        textureDesc.type        = (key.samples > 1 ? TextureType::Texture2DMS : TextureType::Texture2D);
+        textureDesc.miscFlags   = (MiscFlags::FixedSamples | MiscFlags::NoInitialData);
+        textureDesc.extent      = { key.resolution.width, key.resolution.height, 1 };
+        textureDesc.mipLevels   = 1;
+        textureDesc.samples     = key.samples;
+    }
+
+    RenderTargetDescriptor renderTargetDesc;
+    {
+        renderTargetDesc.renderPass             = key.renderPass;
+        renderTargetDesc.resolution             = key.resolution;
+        renderTargetDesc.samples                = key.samples;
+        renderTargetDesc.customMultiSampling    = (key.samples > 1);
+    }
+
+    const std::uint32_t numColorFormats = GetNumColorFormats(key);
+    for (std::uint32_t i = 0; i < numColorFormats; ++i)
+    {
+        textureDesc.format      = key.colorFormats[i];
+        textureDesc.bindFlags   = (key.bindFlags | BindFlags::ColorAttachment);
+        target.colorTextures[i] = renderSystem.CreateTexture(textureDesc);
+        renderTargetDesc.attachments.push_back(AttachmentDescriptor{ AttachmentType::Color, target.colorTextures[i] });
+    }
+
+    if (key.depthStencilFormat != Format::Undefined)
+    {
+        textureDesc.format          = key.depthStencilFormat;
+        textureDesc.bindFlags       = (key.bindFlags | BindFlags::DepthStencilAttachment);
+        target.depthStencilTexture  = renderSystem.CreateTexture(textureDesc);
+        const auto type = (IsStencilFormat(key.depthStencilFormat) ? AttachmentType::DepthStencil : AttachmentType::Depth);
+        renderTargetDesc.attachments.push_back(AttachmentDescriptor{ type, target.depthStencilTexture });
+    }
+
+    /* Create render target for all attachments */
+    target.renderTarget = renderSystem.CreateRenderTarget(renderTargetDesc);
+
+    ++numCreatedEntries;
+
+    return entry;
+}
+
+void RenderTargetPool::Pimpl::ReleaseEntry(RenderTargetPoolEntry& entry)
+{
+    auto& target = entry.target;
+    if (target.renderTarget != nullptr)
+    {
+        renderSystem.Release(*target.renderTarget);
+        target.renderTarget = nullptr;
+    }
+    for (auto& texture : target.colorTextures)
+    {
+        if (texture != nullptr)
+        {
+            renderSystem.Release(*texture);
+            texture = nullptr;
+        }
+    }
+    if (target.depthStencilTexture != nullptr)
+    {
+        renderSystem.Release(*target.depthStencilTexture);
+        target.depthStencilTexture = nullptr;
+    }
+}
+
+void RenderTargetPool::Pimpl::EvictUnusedEntries(std::uint32_t maxUnusedEntries)
+{
+    while (numUnusedEntries > maxUnusedEntries)
+    {
+        /* Find least recently released entry */
+        auto lruEntry = entries.end();
+        for (auto it = entries.begin(); it != entries.end(); ++it)
+        {
+            if (!(*it)->isUsed && (lruEntry == entries.end() || (*it)->lastRelease < (*lruEntry)->lastRelease))
+                lruEntry = it;
+        }
+
+        if (lruEntry == entries.end())
+            break;
+
+        ReleaseEntry(**lruEntry);
+        entries.erase(lruEntry);
+        --numUnusedEntries;
+    }
+}
+
+
+/*
+ * RenderTargetPool class
+ */
+
+RenderTargetPool::RenderTargetPool(RenderSystem& renderSystem, const RenderTargetPoolDescriptor& poolDesc) :
+    pimpl_ { new Pimpl{ renderSystem, poolDesc } }
+{
+}
+
+RenderTargetPool::~RenderTargetPool()
+{
+    delete pimpl_;
+}
+
+const PooledRenderTarget* RenderTargetPool::Acquire(const PooledRenderTargetDescriptor& renderTargetDesc)
+{
+    if (renderTargetDesc.resolution.width == 0 || renderTargetDesc.resolution.height == 0)
+        return nullptr;
+    if (GetNumColorFormats(renderTargetDesc) == 0 && renderTargetDesc.depthStencilFormat == Format::Undefined)
+        return nullptr;
+
+    /* Build key with the resolution the attachments are allocated with */
+    PooledRenderTargetDescriptor key = renderTargetDesc;
+    key.samples     = std::max(1u, renderTargetDesc.samples);
+    key.resolution  = pimpl_->GetAllocatedResolution(renderTargetDesc.resolution);
+
+    /* Reuse unused entry or create a new one */
+    RenderTargetPoolEntry* entry = pimpl_->FindUnusedEntry(key);
+    if (entry != nullptr)
+        --pimpl_->numUnusedEntries;
+    else
+    {
+        pimpl_->entries.push_back(pimpl_->CreateEntry(key));
+        entry = pimpl_->entries.back().get();
+    }
+
+    /* Update sub-viewport of the requested resolution */
+    auto& target = entry->target;
+    {
+        target.resolution   = renderTargetDesc.resolution;
+        target.viewport     = Viewport{ target.resolution };
+        target.scissor      = Scissor{ Offset2D{ 0, 0 }, target.resolution };
+    }
+    entry->isUsed = true;
+
+    return &target;
+}
+
+void RenderTargetPool::Release(const PooledRenderTarget* renderTarget)
+{
+    if (renderTarget == nullptr)
+        return;
+
+    for (auto& entry : pimpl_->entries)
+    {
+        if (&(entry->target) == renderTarget)
+        {
+            if (entry->isUsed)
+            {
+                entry->isUsed       = false;
+                entry->lastRelease  = ++pimpl_->releaseCounter;
+                ++pimpl_->numUnusedEntries;
+                pimpl_->EvictUnusedEntries(pimpl_->desc.maxUnusedRenderTargets);
+            }
+            return;
+        }
+    }
+}
+
+void RenderTargetPool::Clear()
+{
+    pimpl_->EvictUnusedEntries(0);
+}
+
+std::uint32_t RenderTargetPool::GetNumRenderTargets() const
+{
+    return static_cast<std::uint32_t>(pimpl_->entries.size());
+}
+
+std::uint64_t RenderTargetPool::GetNumCreatedRenderTargets() const
+{
+    return pimpl_->numCreatedEntries;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -11,6 +11,7 @@
 
 #include <LLGL/ResourceFlags.h>
 #include <LLGL/ResourceHeapFlags.h>
+#include <LLGL/PipelineLayoutFlags.h>
 #include <LLGL/RenderSystemFlags.h>
 #include <LLGL/Container/ArrayView.h>
 #include <stdexcept>
@@ -43,10 +44,10 @@ inline bool HasReadAccess(const CPUAccess access)
     return (access == CPUAccess::ReadOnly || access == CPUAccess::ReadWrite);
 }
 
-// Returns true if the specified CPU access value has write access, i.e. WriteOnly, WriteDiscard, or ReadWrite.
+// Returns true if the specified CPU access value has write access, i.e. WriteOnly, WriteDiscard, ReadWrite, or WriteUnsynchronized.
 inline bool HasWriteAccess(const CPUAccess access)
 {
-    return (access >= CPUAccess::WriteOnly && access <= CPUAccess::ReadWrite);
+    return (access >= CPUAccess::WriteOnly && access <= CPUAccess::WriteUnsynchronized);
 }
 
 // Returns the number of resource views for the specified resource heap descriptor and throws an std::invalid_argument exception if validation fails.
@@ -76,6 +77,66 @@ inline std::uint32_t GetNumResourceViewsOrThrow(
     return numResourceViews;
 }
 
+/*
+Returns true if the last binding of the specified pipeline layout descriptor is a bindless binding (see BindingFlags::Bindless)
+and throws an std::invalid_argument exception if any other binding is bindless or if a bindless pipeline layout contains dynamic offsets.
+*/
+inline bool HasBindlessBindingOrThrow(const PipelineLayoutDescriptor& desc)
+{
+    bool hasBindlessBinding = false;
+
+    for (std::size_t i = 0, n = desc.bindings.size(); i < n; ++i)
+    {
+        const auto& binding = desc.bindings[i];
+        if ((binding.flags & BindingFlags::Bindless) != 0)
+        {
+            if (i + 1 < n)
+                throw std::invalid_argument("bindless binding must be the last binding in pipeline layout");
+            if ((binding.flags & (BindingFlags::DynamicBinding | BindingFlags::InlineUniforms | BindingFlags::DynamicOffset)) != 0)
+                throw std::invalid_argument("bindless binding cannot be combined with dynamic, inline, or dynamic offset binding flags");
+            hasBindlessBinding = true;
+        }
+    }
+
+    if (hasBindlessBinding)
+    {
+        for (const auto& binding : desc.bindings)
+        {
+            if ((binding.flags & BindingFlags::DynamicOffset) != 0)
+                throw std::invalid_argument("bindless pipeline layout cannot contain bindings with dynamic offsets");
+        }
+    }
+
+    return hasBindlessBinding;
+}
+
+/*
+Returns the number of descriptors of the bindless binding for the specified resource heap descriptor and throws an std::invalid_argument exception if validation fails.
+The resource views of a bindless resource heap start with one descriptor for each static binding, followed by the variable number of bindless descriptors.
+*/
+inline std::uint32_t GetNumBindlessDescriptorsOrThrow(
+    std::uint32_t                               numStaticBindings,
+    std::uint32_t                               maxBindlessDescriptors,
+    const ResourceHeapDescriptor&               desc,
+    const ArrayView<ResourceViewDescriptor>&    initialResourceViews)
+{
+    /* Allocate all bindless descriptors if the number of resource views is unspecified */
+    const std::uint32_t numResourceViews = (desc.numResourceViews > 0 ? desc.numResourceViews : static_cast<std::uint32_t>(initialResourceViews.size()));
+    if (numResourceViews == 0)
+        return maxBindlessDescriptors;
+
+    /* Number of resources must cover all static bindings and must not exceed the capacity of the bindless binding */
+    if (numResourceViews < numStaticBindings || numResourceViews - numStaticBindings > maxBindlessDescriptors)
+    {
+        throw std::invalid_argument(
+            "cannot create bindless resource heap because number of resources (" + std::to_string(numResourceViews) +
+            ") is not in the range [" + std::to_string(numStaticBindings) + ", " + std::to_string(numStaticBindings + maxBindlessDescriptors) + "]"
+        );
+    }
+
+    return numResourceViews - numStaticBindings;
+}
+
 
 } // /namespace LLGL
 
@@ -84,6 +84,8 @@ void SPIRVParser::Parse(const void* byteCode, std::size_t byteCodeSize)
     }
 
     finished_ = true;
+
+    OnParseFinish();
 }
 
 
@@ -118,6 +120,11 @@ void SPIRVParser::OnParseInstruction(const SPIRVInstruction& instr)
     // dummy
 }
 
+void SPIRVParser::OnParseFinish()
+{
+    // dummy
+}
+
 
 } // /namespace LLGL
 
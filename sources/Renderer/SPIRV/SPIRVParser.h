@@ -54,6 +54,9 @@ class SPIRVParser
         // Callback function for each instruction within the SPIR-V shader module.
         virtual void OnParseInstruction(const SPIRVInstruction& instr);
 
+        // Callback function after all instructions of the SPIR-V shader module have been parsed or the parsing process has been finished early.
+        virtual void OnParseFinish();
+
     private:
 
         bool finished_ = false;
@@ -7,6 +7,7 @@
 
 #include "SPIRVReflect.h"
 #include "../../Core/Helper.h"
+#include <algorithm>
 #include <string>
 
 
@@ -14,6 +15,8 @@ namespace LLGL
 {
 
 
+const std::uint32_t SPIRVReflect::invalidIndex;
+
 const SPIRVReflect::SpvType* SPIRVReflect::SpvType::DereferencePtr() const
 {
     auto type = this;
@@ -42,11 +45,34 @@ bool SPIRVReflect::SpvType::RefersToType(const spv::Op opcodeType) const
     return (DereferencePtr(opcodeType) != nullptr);
 }
 
+const SPIRVReflect::SpvType* SPIRVReflect::GetFieldType(const SpvType& recordType, std::uint32_t index) const
+{
+    if (index < recordType.numFields)
+        return fieldTypes_[recordType.firstField + index];
+    else
+        return nullptr;
+}
+
 void SPIRVReflect::OnParseHeader(const SPIRVHeader& header)
 {
+    SPIRVParser::OnParseHeader(header);
+
+    /* Allocate all ID-indexed arrays once, so references to their elements remain valid during parsing */
     idBound_ = header.idBound;
-    if (idBound_ > 0)
-        names_.resize(idBound_);
+
+    names_.assign(idBound_, nullptr);
+    types_.assign(idBound_, SpvType{});
+    constants_.assign(idBound_, SpvConstant{});
+    uniformIndices_.assign(idBound_, invalidIndex);
+    varyingIndices_.assign(idBound_, invalidIndex);
+    specConstIndices_.assign(idBound_, invalidIndex);
+
+    fieldTypes_.clear();
+    uniforms_.clear();
+    varyings_.clear();
+    specConstants_.clear();
+    members_.clear();
+    pushConstants_.clear();
 }
 
 void SPIRVReflect::OnParseInstruction(const SPIRVInstruction& instr)
@@ -59,6 +85,12 @@ void SPIRVReflect::OnParseInstruction(const SPIRVInstruction& instr)
         case spv::Op::OpDecorate:
             OpDecorate(instr);
             break;
+        case spv::Op::OpMemberName:
+            OpMemberName(instr);
+            break;
+        case spv::Op::OpMemberDecorate:
+            OpMemberDecorate(instr);
+            break;
         case spv::Op::OpTypeVoid:
         case spv::Op::OpTypeBool:
         case spv::Op::OpTypeInt:
@@ -82,11 +114,38 @@ void SPIRVReflect::OnParseInstruction(const SPIRVInstruction& instr)
         case spv::Op::OpConstant:
             OpConstant(instr);
             break;
+        case spv::Op::OpSpecConstantTrue:
+        case spv::Op::OpSpecConstantFalse:
+        case spv::Op::OpSpecConstant:
+            OpSpecConstant(instr);
+            break;
         default:
             break;
     }
 }
 
+template <typename T>
+static void SortByResultID(std::vector<T>& variables, std::vector<std::uint32_t>& indices)
+{
+    /* Sort variables by their result ID and update ID-indexed array */
+    std::sort(
+        variables.begin(), variables.end(),
+        [](const T& lhs, const T& rhs)
+        {
+            return (lhs.id < rhs.id);
+        }
+    );
+    for (std::size_t i = 0; i < variables.size(); ++i)
+        indices[variables[i].id] = static_cast<std::uint32_t>(i);
+}
+
+void SPIRVReflect::OnParseFinish()
+{
+    SortByResultID(uniforms_, uniformIndices_);
+    SortByResultID(varyings_, varyingIndices_);
+    SortByResultID(specConstants_, specConstIndices_);
+}
+
 void SPIRVReflect::OpName(const Instr& instr)
 {
     SetName(instr.GetUInt32(0), instr.GetASCII(1));
@@ -106,6 +165,9 @@ void SPIRVReflect::OpDecorate(const Instr& instr)
         case spv::Decoration::BuiltIn:
             OpDecorateBuiltin(instr);
             break;
+        case spv::Decoration::SpecId:
+            OpDecorateSpecId(instr);
+            break;
         default:
             break;
     }
@@ -114,7 +176,7 @@ void SPIRVReflect::OpDecorate(const Instr& instr)
 void SPIRVReflect::OpDecorateBinding(const Instr& instr)
 {
     auto id         = instr.GetUInt32(0);
-    auto& variable  = uniforms_[id];
+    auto& variable  = FetchUniform(id);
 
     variable.name       = GetName(id);
     variable.binding    = instr.GetUInt32(2);
@@ -123,7 +185,7 @@ void SPIRVReflect::OpDecorateBinding(const Instr& instr)
 void SPIRVReflect::OpDecorateLocation(const Instr& instr)
 {
     auto id         = instr.GetUInt32(0);
-    auto& variable  = varyings_[id];
+    auto& variable  = FetchVarying(id);
 
     variable.name       = GetName(id);
     variable.location   = instr.GetUInt32(2);
@@ -132,15 +194,41 @@ void SPIRVReflect::OpDecorateLocation(const Instr& instr)
 void SPIRVReflect::OpDecorateBuiltin(const Instr& instr)
 {
     auto id         = instr.GetUInt32(0);
-    auto& variable  = varyings_[id];
+    auto& variable  = FetchVarying(id);
 
     variable.name       = GetName(id);
     variable.builtin    = static_cast<spv::BuiltIn>(instr.GetUInt32(2));
 }
 
+void SPIRVReflect::OpDecorateSpecId(const Instr& instr)
+{
+    auto id         = instr.GetUInt32(0);
+    auto& constant  = FetchSpecConstant(id);
+
+    constant.name       = GetName(id);
+    constant.constantId = instr.GetUInt32(2);
+}
+
+void SPIRVReflect::OpMemberName(const Instr& instr)
+{
+    auto& member = FetchMember(instr.GetUInt32(0), instr.GetUInt32(1));
+    member.name = instr.GetASCII(2);
+}
+
+void SPIRVReflect::OpMemberDecorate(const Instr& instr)
+{
+    auto decoration = static_cast<spv::Decoration>(instr.GetUInt32(2));
+    if (decoration == spv::Decoration::Offset)
+    {
+        auto& member = FetchMember(instr.GetUInt32(0), instr.GetUInt32(1));
+        member.offset = instr.GetUInt32(3);
+    }
+}
+
 void SPIRVReflect::OpType(const Instr& instr)
 {
     /* Register type and store it as current type to operate on */
+    AssertIdBound(instr.result);
     auto& type = types_[instr.result];
     {
         type.opcode = instr.opcode;
@@ -248,11 +336,12 @@ static void AccumulateSizeInVectorBoundary(std::uint32_t& size, std::uint32_t al
 
 void SPIRVReflect::OpTypeStruct(const Instr& instr, SpvType& type)
 {
-    type.fieldTypes.reserve(instr.numOperands);
+    type.firstField = static_cast<std::uint32_t>(fieldTypes_.size());
+    type.numFields  = instr.numOperands;
     for (std::uint32_t i = 0; i < instr.numOperands; ++i)
     {
         auto fieldType = FindType(instr.GetUInt32(i));
-        type.fieldTypes.push_back(fieldType);
+        fieldTypes_.push_back(fieldType);
         AccumulateSizeInVectorBoundary(type.size, 16, fieldType->size);
     }
     type.size = GetAlignedSize(type.size, 16u);
@@ -287,11 +376,18 @@ void SPIRVReflect::OpVariable(const Instr& instr)
 
     switch (storage)
     {
+        case spv::StorageClass::PushConstant:
+        {
+            /* Push constants are not bound to a descriptor, so only their block members are reflected */
+            if (auto blockType = FindType(instr.type)->DereferencePtr(spv::Op::OpTypeStruct))
+                AppendPushConstants(*blockType);
+        }
+        break;
+
         case spv::StorageClass::Uniform:
         case spv::StorageClass::UniformConstant:
-        //case spv::StorageClass::PushConstant:
         {
-            auto& var = uniforms_[instr.result];
+            auto& var = FetchUniform(instr.result);
             {
                 var.type = FindType(instr.type);
                 if (auto structType = var.type->DereferencePtr(spv::Op::OpTypeStruct))
@@ -308,7 +404,7 @@ void SPIRVReflect::OpVariable(const Instr& instr)
 
         case spv::StorageClass::Input:
         {
-            auto& var = varyings_[instr.result];
+            auto& var = FetchVarying(instr.result);
             {
                 var.type    = FindType(instr.type);
                 var.input   = true;
@@ -318,7 +414,7 @@ void SPIRVReflect::OpVariable(const Instr& instr)
 
         case spv::StorageClass::Output:
         {
-            auto& var = varyings_[instr.result];
+            auto& var = FetchVarying(instr.result);
             {
                 var.type    = FindType(instr.type);
                 var.input   = false;
@@ -333,6 +429,7 @@ void SPIRVReflect::OpVariable(const Instr& instr)
 
 void SPIRVReflect::OpConstant(const Instr& instr)
 {
+    AssertIdBound(instr.result);
     auto& val = constants_[instr.result];
     {
         val.type = FindType(instr.type);
@@ -356,6 +453,26 @@ void SPIRVReflect::OpConstant(const Instr& instr)
     }
 }
 
+void SPIRVReflect::OpSpecConstant(const Instr& instr)
+{
+    /* Register default value as regular constant, so it can be used as array size */
+    if (instr.opcode == spv::Op::OpSpecConstant)
+        OpConstant(instr);
+
+    auto& constant = FetchSpecConstant(instr.result);
+    {
+        constant.name = GetName(instr.result);
+        constant.type = FindType(instr.type);
+
+        if (instr.opcode == spv::Op::OpSpecConstantTrue)
+            constant.value = 1;
+        else if (instr.opcode == spv::Op::OpSpecConstantFalse)
+            constant.value = 0;
+        else
+            constant.value = instr.GetUInt32(0);
+    }
+}
+
 void SPIRVReflect::SetName(spv::Id id, const char* name)
 {
     AssertIdBound(id);
@@ -381,18 +498,95 @@ void SPIRVReflect::AssertIdBound(spv::Id id) const
 
 const SPIRVReflect::SpvType* SPIRVReflect::FindType(spv::Id id) const
 {
-    auto it = types_.find(id);
-    if (it == types_.end())
+    if (id >= idBound_ || types_[id].opcode == spv::Op::Max)
         throw std::runtime_error("cannot find SPIR-V OpType* instruction with result ID %" + std::to_string(id));
-    return &(it->second);
+    return &(types_[id]);
 }
 
 const SPIRVReflect::SpvConstant* SPIRVReflect::FindConstant(spv::Id id) const
 {
-    auto it = constants_.find(id);
-    if (it == constants_.end())
+    if (id >= idBound_ || constants_[id].type == nullptr)
         throw std::runtime_error("cannot find SPIR-V OpConstant instruction with with result ID %" + std::to_string(id));
-    return &(it->second);
+    return &(constants_[id]);
+}
+
+SPIRVReflect::SpvUniform& SPIRVReflect::FetchUniform(spv::Id id)
+{
+    AssertIdBound(id);
+    auto& index = uniformIndices_[id];
+    if (index == invalidIndex)
+    {
+        index = static_cast<std::uint32_t>(uniforms_.size());
+        uniforms_.push_back(SpvUniform{});
+        uniforms_.back().id = id;
+    }
+    return uniforms_[index];
+}
+
+SPIRVReflect::SpvVarying& SPIRVReflect::FetchVarying(spv::Id id)
+{
+    AssertIdBound(id);
+    auto& index = varyingIndices_[id];
+    if (index == invalidIndex)
+    {
+        index = static_cast<std::uint32_t>(varyings_.size());
+        varyings_.push_back(SpvVarying{});
+        varyings_.back().id = id;
+    }
+    return varyings_[index];
+}
+
+SPIRVReflect::SpvSpecConstant& SPIRVReflect::FetchSpecConstant(spv::Id id)
+{
+    AssertIdBound(id);
+    auto& index = specConstIndices_[id];
+    if (index == invalidIndex)
+    {
+        index = static_cast<std::uint32_t>(specConstants_.size());
+        specConstants_.push_back(SpvSpecConstant{});
+        specConstants_.back().id = id;
+    }
+    return specConstants_[index];
+}
+
+SPIRVReflect::SpvMember& SPIRVReflect::FetchMember(spv::Id structId, std::uint32_t index)
+{
+    for (auto& member : members_)
+    {
+        if (member.structId == structId && member.index == index)
+            return member;
+    }
+    members_.push_back(SpvMember{});
+    members_.back().structId    = structId;
+    members_.back().index       = index;
+    return members_.back();
+}
+
+const SPIRVReflect::SpvMember* SPIRVReflect::FindMember(spv::Id structId, std::uint32_t index) const
+{
+    for (const auto& member : members_)
+    {
+        if (member.structId == structId && member.index == index)
+            return &member;
+    }
+    return nullptr;
+}
+
+void SPIRVReflect::AppendPushConstants(const SpvType& blockType)
+{
+    for (std::uint32_t i = 0; i < blockType.numFields; ++i)
+    {
+        SpvPushConstant pushConstant;
+        {
+            pushConstant.type = GetFieldType(blockType, i);
+            if (auto member = FindMember(blockType.result, i))
+            {
+                pushConstant.name   = member->name;
+                pushConstant.offset = member->offset;
+            }
+        }
+        pushConstants_.push_back(pushConstant);
+    }
 }
 
 
@@ -11,14 +11,17 @@
 
 #include "SPIRVParser.h"
 #include <vector>
-#include <map>
 
 
 namespace LLGL
 {
 
 
-// SPIR-V shader module parser.
+/*
+SPIR-V shader module parser.
+All types, constants, and variables are stored in flat arrays that are indexed by their result ID and sized from the ID-bound of the module header,
+so no node-based containers are allocated while the module is parsed.
+*/
 class SPIRVReflect final : public SPIRVParser
 {
 
@@ -39,7 +42,8 @@ class SPIRVReflect final : public SPIRVParser
             std::uint32_t               elements    = 0;                        // Number of elements for the base type, or 0 if there is no base type.
             std::uint32_t               size        = 0;                        // Size (in bytes) of this type, or 0 if this is an OpTypeVoid type.
             bool                        sign        = false;                    // Specifies whether or not this is a signed type (only for OpTypeInt).
-            std::vector<const SpvType*> fieldTypes;                             // List of types of each record field.
+            std::uint32_t               firstField  = 0;                        // Index of the first record field type (see SPIRVReflect::GetFieldType).
+            std::uint32_t               numFields   = 0;                        // Number of record fields (only for OpTypeStruct).
         };
 
         // SPIRV-V scalar constants.
@@ -57,17 +61,10 @@ class SPIRVReflect final : public SPIRVParser
             };
         };
 
-        // SPIR-V structures (a.k.a. records).
-        struct SpvRecord
-        {
-            const char*     name    = nullptr;
-            std::uint32_t   size    = 0;
-            std::uint32_t   padding = 0;
-        };
-
         // Global uniform objects.
         struct SpvUniform
         {
+            spv::Id         id      = 0;        // Result ID of the variable.
             const char*     name    = nullptr;
             const SpvType*  type    = nullptr;
             std::uint32_t   set     = 0;        // Descriptor set
@@ -75,9 +72,20 @@ class SPIRVReflect final : public SPIRVParser
             std::uint32_t   size    = 0;        // Size (in bytes) of the uniform.
         };
 
+        // Specialization constants (see OpSpecConstant) with their default values.
+        struct SpvSpecConstant
+        {
+            spv::Id         id          = 0;        // Result ID of the constant.
+            const char*     name        = nullptr;
+            const SpvType*  type        = nullptr;
+            std::uint32_t   constantId  = 0;        // Specialization constant ID (see Decoration::SpecId).
+            std::uint32_t   value       = 0;        // Default value as 32-bit word, i.e. 0 or 1 for boolean constants.
+        };
+
         // Module varyings, i.e. either input or output attributes.
         struct SpvVarying
         {
+            spv::Id         id          = 0;                    // Result ID of the variable.
             const char*     name        = nullptr;
             spv::BuiltIn    builtin     = spv::BuiltIn::Max;    // Optional built-in type
             const SpvType*  type        = nullptr;
@@ -85,35 +93,70 @@ class SPIRVReflect final : public SPIRVParser
             bool            input       = false;
         };
 
+        // Members of the push constant block (see spv::StorageClass::PushConstant).
+        struct SpvPushConstant
+        {
+            const char*     name    = nullptr;
+            const SpvType*  type    = nullptr;
+            std::uint32_t   offset  = 0;        // Byte offset within the push constant block (see Decoration::Offset).
+        };
+
     public:
 
-        inline const std::map<spv::Id, SpvRecord>& GetRecords() const
+        // Returns all uniforms sorted by their result ID.
+        inline const std::vector<SpvUniform>& GetUniforms() const
         {
-            return records_;
+            return uniforms_;
         }
 
-        inline const std::map<spv::Id, SpvUniform>& GetUniforms() const
+        // Returns all varyings sorted by their result ID.
+        inline const std::vector<SpvVarying>& GetVaryings() const
         {
-            return uniforms_;
+            return varyings_;
         }
 
-        inline const std::map<spv::Id, SpvVarying>& GetVaryings() const
+        // Returns all specialization constants sorted by their result ID.
+        inline const std::vector<SpvSpecConstant>& GetSpecConstants() const
         {
-            return varyings_;
+            return specConstants_;
+        }
+
+        // Returns all members of the push constant block in the order of their declaration.
+        inline const std::vector<SpvPushConstant>& GetPushConstants() const
+        {
+            return pushConstants_;
         }
 
+        // Returns the type of the specified record field.
+        const SpvType* GetFieldType(const SpvType& recordType, std::uint32_t index) const;
+
+    private:
+
+        // Name and offset of a record field (see OpMemberName and OpMemberDecorate).
+        struct SpvMember
+        {
+            spv::Id         structId    = 0;
+            std::uint32_t   index       = 0;
+            const char*     name        = nullptr;
+            std::uint32_t   offset      = 0;
+        };
+
     private:
 
         using Instr = SPIRVInstruction;
 
         void OnParseHeader(const SPIRVHeader& header) override;
         void OnParseInstruction(const SPIRVInstruction& instr) override;
+        void OnParseFinish() override;
 
         void OpName(const Instr& instr);
         void OpDecorate(const Instr& instr);
         void OpDecorateBinding(const Instr& instr);
         void OpDecorateLocation(const Instr& instr);
         void OpDecorateBuiltin(const Instr& instr);
+        void OpDecorateSpecId(const Instr& instr);
+        void OpMemberName(const Instr& instr);
+        void OpMemberDecorate(const Instr& instr);
         void OpType(const Instr& instr);
         void OpTypeVoid(const Instr& instr, SpvType& type);
         void OpTypeBool(const Instr& instr, SpvType& type);
@@ -132,6 +175,7 @@ class SPIRVReflect final : public SPIRVParser
         void OpTypeFunction(const Instr& instr, SpvType& type);
         void OpVariable(const Instr& instr);
         void OpConstant(const Instr& instr);
+        void OpSpecConstant(const Instr& instr);
 
     private:
 
@@ -143,16 +187,34 @@ class SPIRVReflect final : public SPIRVParser
         const SpvType* FindType(spv::Id id) const;
         const SpvConstant* FindConstant(spv::Id id) const;
 
+        SpvUniform& FetchUniform(spv::Id id);
+        SpvVarying& FetchVarying(spv::Id id);
+        SpvSpecConstant& FetchSpecConstant(spv::Id id);
+
+        SpvMember& FetchMember(spv::Id structId, std::uint32_t index);
+        const SpvMember* FindMember(spv::Id structId, std::uint32_t index) const;
+
+        void AppendPushConstants(const SpvType& blockType);
+
     private:
 
-        std::uint32_t                   idBound_    = 0;
-        std::vector<const char*>        names_;
+        static const std::uint32_t      invalidIndex = ~0u;
+
+        std::uint32_t                   idBound_        = 0;
+        std::vector<const char*>        names_;             // Indexed by result ID.
+
+        std::vector<SpvType>            types_;             // Indexed by result ID; opcode is spv::Op::Max for undefined types.
+        std::vector<SpvConstant>        constants_;         // Indexed by result ID; type is null for undefined constants.
+        std::vector<const SpvType*>     fieldTypes_;        // Record field types of all OpTypeStruct instructions.
 
-        std::map<spv::Id, SpvType>      types_;
-        std::map<spv::Id, SpvConstant>  constants_;
-        std::map<spv::Id, SpvRecord>    records_;
-        std::map<spv::Id, SpvUniform>   uniforms_;
-        std::map<spv::Id, SpvVarying>   varyings_;
+        std::vector<std::uint32_t>      uniformIndices_;    // Indexed by result ID; index into 'uniforms_' or invalidIndex.
+        std::vector<std::uint32_t>      varyingIndices_;    // Indexed by result ID; index into 'varyings_' or invalidIndex.
+        std::vector<std::uint32_t>      specConstIndices_;  // Indexed by result ID; index into 'specConstants_' or invalidIndex.
+        std::vector<SpvUniform>         uniforms_;
+        std::vector<SpvVarying>         varyings_;
+        std::vector<SpvSpecConstant>    specConstants_;
+        std::vector<SpvMember>          members_;           // Record field names and offsets; declared before the record types.
+        std::vector<SpvPushConstant>    pushConstants_;
 
 };
 
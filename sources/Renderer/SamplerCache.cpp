@@ -0,0 +1,43 @@
+/*
+ * SamplerCache.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "SamplerCache.h"
+#include "../Core/HelperMacros.h"
+
+
+namespace LLGL
+{
+
+
+LLGL_EXPORT int CompareSamplerDescSWO(const SamplerDescriptor& lhs, const SamplerDescriptor& rhs)
+{
+    LLGL_COMPARE_MEMBER_SWO     ( addressModeU   );
+    LLGL_COMPARE_MEMBER_SWO     ( addressModeV   );
+    LLGL_COMPARE_MEMBER_SWO     ( addressModeW   );
+    LLGL_COMPARE_MEMBER_SWO     ( minFilter      );
+    LLGL_COMPARE_MEMBER_SWO     ( magFilter      );
+    LLGL_COMPARE_MEMBER_SWO     ( mipMapFilter   );
+    LLGL_COMPARE_BOOL_MEMBER_SWO( mipMapping     );
+    LLGL_COMPARE_MEMBER_SWO     ( mipMapLODBias  );
+    LLGL_COMPARE_MEMBER_SWO     ( minLOD         );
+    LLGL_COMPARE_MEMBER_SWO     ( maxLOD         );
+    LLGL_COMPARE_MEMBER_SWO     ( maxAnisotropy  );
+    LLGL_COMPARE_BOOL_MEMBER_SWO( compareEnabled );
+    LLGL_COMPARE_MEMBER_SWO     ( compareOp      );
+    LLGL_COMPARE_MEMBER_SWO     ( borderColor.r  );
+    LLGL_COMPARE_MEMBER_SWO     ( borderColor.g  );
+    LLGL_COMPARE_MEMBER_SWO     ( borderColor.b  );
+    LLGL_COMPARE_MEMBER_SWO     ( borderColor.a  );
+    return 0;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
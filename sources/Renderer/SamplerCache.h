@@ -0,0 +1,141 @@
+/*
+ * SamplerCache.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_SAMPLER_CACHE_H
+#define LLGL_SAMPLER_CACHE_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/SamplerFlags.h>
+#include "../Core/ContainerUtils.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/* ----- Functions ----- */
+
+// Compares the two sampler descriptors in a strict-weak-order (SWO) and returns -1, 0, or +1.
+LLGL_EXPORT int CompareSamplerDescSWO(const SamplerDescriptor& lhs, const SamplerDescriptor& rhs);
+
+
+/* ----- Templates ----- */
+
+/*
+Cache of native sampler objects that are shared between all samplers with equal descriptors.
+Applications often create many samplers from only a few distinct descriptors, and some backends limit the number of native samplers
+(e.g. VkPhysicalDeviceLimits::maxSamplerAllocationCount). The entries are sorted by their descriptors, and an entry is removed
+once the last sampler that refers to it has been released (see GLStatePool for the same pattern).
+All functions are guarded by a mutex, so samplers can be created and released from multiple threads.
+*/
+template <typename T>
+class SamplerCache
+{
+
+    public:
+
+        SamplerCache() = default;
+
+        SamplerCache(const SamplerCache&) = delete;
+        SamplerCache& operator = (const SamplerCache&) = delete;
+
+        // Returns the native sampler for the specified descriptor, or creates a new one with the specified factory of type 'std::shared_ptr<T>()'.
+        template <typename TFactory>
+        std::shared_ptr<T> GetOrCreate(const SamplerDescriptor& desc, TFactory factory)
+        {
+            std::lock_guard<std::mutex> guard{ mutex_ };
+
+            std::size_t insertionIndex = 0;
+            if (auto entry = Find(desc, &insertionIndex))
+                return entry->native;
+
+            /* Create new native sampler with insertion sort */
+            Entry newEntry;
+            {
+                newEntry.desc   = desc;
+                newEntry.native = factory();
+            }
+            entries_.insert(entries_.begin() + insertionIndex, newEntry);
+
+            return newEntry.native;
+        }
+
+        // Releases the specified reference to a native sampler and removes it from the cache if no other sampler refers to it.
+        void Release(const SamplerDescriptor& desc, std::shared_ptr<T>&& native)
+        {
+            std::lock_guard<std::mutex> guard{ mutex_ };
+
+            if (native && native.use_count() == 2)
+            {
+                std::size_t entryIndex = 0;
+                if (auto entry = Find(desc, &entryIndex))
+                {
+                    if (entry->native == native)
+                        entries_.erase(entries_.begin() + entryIndex);
+                }
+            }
+
+            native.reset();
+        }
+
+        // Removes all entries from the cache. Native samplers that are still in use are destroyed once their last sampler has been released.
+        void Clear()
+        {
+            std::lock_guard<std::mutex> guard{ mutex_ };
+            entries_.clear();
+        }
+
+        // Returns the number of distinct native samplers.
+        std::size_t GetSize() const
+        {
+            std::lock_guard<std::mutex> guard{ mutex_ };
+            return entries_.size();
+        }
+
+    private:
+
+        struct Entry
+        {
+            SamplerDescriptor   desc;
+            std::shared_ptr<T>  native;
+        };
+
+    private:
+
+        Entry* Find(const SamplerDescriptor& desc, std::size_t* index)
+        {
+            return Utils::FindInSortedArray<Entry>(
+                entries_.data(),
+                entries_.size(),
+                [&desc](const Entry& entry) -> int
+                {
+                    return CompareSamplerDescSWO(entry.desc, desc);
+                },
+                index
+            );
+        }
+
+    private:
+
+        std::vector<Entry>  entries_;
+        mutable std::mutex  mutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -8,6 +8,8 @@
 #include "Serialization.h"
 #include "../Core/Assertion.h"
 #include "../Core/Helper.h"
+#include <algorithm>
+#include <stdexcept>
 
 
 namespace LLGL
@@ -23,19 +25,29 @@ static const std::size_t g_segmentHeaderSize = (sizeof(IdentType) + sizeof(SizeT
  * Serializer class
  */
 
+Serializer::Serializer(std::ostream& stream, std::size_t chunkSize) :
+    stream_     { &stream                            },
+    streamBase_ { stream.tellp()                     },
+    chunkSize_  { std::max<std::size_t>(1, chunkSize) }
+{
+}
+
 void Serializer::Reserve(std::size_t size)
 {
-    data_.reserve(size);
+    if (stream_ != nullptr)
+        data_.reserve(std::min(size, chunkSize_));
+    else
+        data_.reserve(size);
 }
 
 void Serializer::Begin(IdentType ident, std::size_t preallocatedSize)
 {
     /* Resize serialization buffer and store offset to begin of new segment */
-    begin_ = data_.size();
-    data_.resize(begin_ + g_segmentHeaderSize + preallocatedSize);
+    begin_ = flushed_ + data_.size();
+    data_.resize(begin_ - flushed_ + g_segmentHeaderSize + preallocatedSize);
 
     /* Write identifier number */
-    *reinterpret_cast<IdentType*>(&(data_[begin_])) = ident;
+    *reinterpret_cast<IdentType*>(&(data_[begin_ - flushed_])) = ident;
 
     /* Set write position to begin of data block */
     pos_ = begin_ + g_segmentHeaderSize;
@@ -44,14 +56,18 @@ void Serializer::Begin(IdentType ident, std::size_t preallocatedSize)
 void Serializer::Write(const void* data, std::size_t size)
 {
     /* Resize serialization buffer on demand */
-    if (pos_ + size > data_.size())
-        data_.resize(pos_ + size);
+    if (pos_ - flushed_ + size > data_.size())
+        data_.resize(pos_ - flushed_ + size);
 
     /* Copy data into serialization buffer */
-    ::memcpy(&(data_[pos_]), data, size);
+    ::memcpy(&(data_[pos_ - flushed_]), data, size);
 
     /* Increment write position */
     pos_ += size;
+
+    /* Stream chunk of serialization buffer into output stream */
+    if (stream_ != nullptr && pos_ - flushed_ >= chunkSize_)
+        FlushBuffer();
 }
 
 void Serializer::WriteCString(const char* str)
@@ -61,9 +77,23 @@ void Serializer::WriteCString(const char* str)
 
 void Serializer::End()
 {
+    /* Discard preallocated data that has not been written */
+    data_.resize(pos_ - flushed_);
+
     /* Store segment size */
-    const auto size = (pos_ - begin_ - g_segmentHeaderSize);
-    *reinterpret_cast<SizeType*>(&(data_[begin_ + sizeof(IdentType)])) = size;
+    const SizeType size = (pos_ - begin_ - g_segmentHeaderSize);
+    if (begin_ >= flushed_)
+        *reinterpret_cast<SizeType*>(&(data_[begin_ - flushed_ + sizeof(IdentType)])) = size;
+    else
+    {
+        /* Segment header has already been streamed, so patch its size field within the output stream */
+        stream_->seekp(streamBase_ + static_cast<std::streamoff>(begin_ + sizeof(IdentType)));
+        stream_->write(reinterpret_cast<const char*>(&size), sizeof(size));
+        stream_->seekp(streamBase_ + static_cast<std::streamoff>(flushed_));
+    }
+
+    if (stream_ != nullptr && data_.size() >= chunkSize_)
+        FlushBuffer();
 }
 
 void Serializer::WriteSegment(IdentType ident, const void* data, std::size_t size)
@@ -73,9 +103,27 @@ void Serializer::WriteSegment(IdentType ident, const void* data, std::size_t siz
     End();
 }
 
+void Serializer::Flush()
+{
+    if (stream_ != nullptr)
+    {
+        FlushBuffer();
+        stream_->flush();
+    }
+}
+
 std::unique_ptr<Blob> Serializer::Finalize()
 {
-    if (!data_.empty())
+    if (stream_ != nullptr)
+    {
+        /* Flush remaining data into output stream and start a new serialization at the current stream position */
+        Flush();
+        begin_      = 0;
+        pos_        = 0;
+        flushed_    = 0;
+        streamBase_ = stream_->tellp();
+    }
+    else if (!data_.empty())
     {
         /* Move serialization buffer to blob and reset offsets */
         begin_  = 0;
@@ -85,6 +133,18 @@ std::unique_ptr<Blob> Serializer::Finalize()
     return nullptr;
 }
 
+void Serializer::FlushBuffer()
+{
+    /* Write all data up to the current write position into the output stream; preallocated data remains in the buffer */
+    const auto size = pos_ - flushed_;
+    if (size > 0)
+    {
+        stream_->write(reinterpret_cast<const char*>(data_.data()), static_cast<std::streamsize>(size));
+        data_.erase(data_.begin(), data_.begin() + size);
+        flushed_ += size;
+    }
+}
+
 
 /*
  * Deserializer class
@@ -109,14 +169,21 @@ void Deserializer::Reset()
 
 Segment Deserializer::Begin()
 {
-    if (pos_ + g_segmentHeaderSize >= size_)
+    /* Return empty segment at the end of the serialized data only; a partial header means the data has been truncated */
+    if (pos_ >= size_)
         return {};
+    if (g_segmentHeaderSize > size_ - pos_)
+        throw std::out_of_range("serialization segment header exceeds size of serialized data");
 
     /* Read segment header */
     Segment seg;
     seg.ident   = *reinterpret_cast<const IdentType*>(data_ + pos_);
     seg.size    = *reinterpret_cast<const SizeType*>(data_ + pos_ + sizeof(IdentType));
 
+    /* Validate segment boundary, since the segment data is referenced in place */
+    if (seg.size > size_ - pos_ - g_segmentHeaderSize)
+        throw std::out_of_range("serialization segment exceeds size of serialized data");
+
     /* Set new reading position and end of segment */
     pos_ += g_segmentHeaderSize;
     segmentEnd_ = pos_ + seg.size;
@@ -168,15 +235,29 @@ void Deserializer::Read(void* data, std::size_t size)
     pos_ += size;
 }
 
+const void* Deserializer::ReadView(std::size_t size)
+{
+    /* Out of bounds check */
+    if (pos_ + size > segmentEnd_)
+        throw std::out_of_range("reading position out of bounds in serialization segment");
+
+    /* Return pointer to segment data and increase reading position */
+    auto data = (data_ + pos_);
+    pos_ += size;
+    return data;
+}
+
 const char* Deserializer::ReadCString()
 {
     /* Determine string length and validate segment boundary */
     std::size_t len = 0;
-    while (data_[pos_ + len] != '\0')
+    while (true)
     {
-        ++len;
-        if (pos_ + len > segmentEnd_)
+        if (pos_ + len >= segmentEnd_)
             throw std::out_of_range("null terminated string out of bounds in serialization segment");
+        if (data_[pos_ + len] == '\0')
+            break;
+        ++len;
     }
 
     /* Return string and increment reading position */
@@ -12,6 +12,7 @@
 #include <LLGL/Blob.h>
 #include <cstdint>
 #include <vector>
+#include <ostream>
 #include <type_traits>
 
 
@@ -87,6 +88,19 @@ else
 class LLGL_EXPORT Serializer
 {
 
+    public:
+
+        Serializer() = default;
+
+        /*
+        Initializes the serializer to stream its data into the specified output stream in chunks of at least the specified size (in bytes),
+        instead of collecting all data in memory. The stream must be seekable, because the size of each segment is written when the segment ends.
+        */
+        explicit Serializer(std::ostream& stream, std::size_t chunkSize = 65536);
+
+        Serializer(const Serializer&) = delete;
+        Serializer& operator = (const Serializer&) = delete;
+
     public:
 
         // Reserves the specified size (in bytes) for data serialization.
@@ -107,7 +121,13 @@ class LLGL_EXPORT Serializer
         // Writes the next segment at once, i.e. calls Begin, Write, and End.
         void WriteSegment(IdentType ident, const void* data, std::size_t size);
 
-        // Returns the final blob of the serialized data. A new serialization can be created after this call.
+        // Writes all buffered data into the output stream. This has no effect if the serializer was not initialized with an output stream.
+        void Flush();
+
+        /*
+        Returns the final blob of the serialized data. A new serialization can be created after this call.
+        If the serializer was initialized with an output stream, all remaining data is flushed into that stream and the return value is null.
+        */
         std::unique_ptr<Blob> Finalize();
 
     public:
@@ -121,15 +141,30 @@ class LLGL_EXPORT Serializer
             Write(&data, sizeof(data));
         }
 
+    private:
+
+        // Writes the buffered data up to the current write position into the output stream.
+        void FlushBuffer();
+
     private:
 
         std::vector<std::int8_t>    data_;
-        std::size_t                 begin_  = 0;
-        std::size_t                 pos_    = 0;
+        std::size_t                 begin_      = 0;    // Absolute offset of the current segment header.
+        std::size_t                 pos_        = 0;    // Absolute offset of the write position.
+
+        std::ostream*               stream_     = nullptr;
+        std::streampos              streamBase_ = 0;    // Position within the output stream where the serialization started.
+        std::size_t                 flushed_    = 0;    // Number of bytes that have already been written into the output stream.
+        std::size_t                 chunkSize_  = 0;
 
 };
 
-// Deserializer class for reading serialized data.
+/*
+Deserializer class for reading serialized data.
+All segments are read in place, i.e. the segment data pointers refer directly into the source buffer,
+so data can be read from a memory-mapped Blob (see Blob::CreateFromFileMapping) without copying it into heap memory.
+Each segment is validated against the boundary of the source buffer.
+*/
 class LLGL_EXPORT Deserializer
 {
 
@@ -159,6 +194,9 @@ class LLGL_EXPORT Deserializer
         // Reads the next data part of the current segment.
         void Read(void* data, std::size_t size);
 
+        // Returns a pointer to the next data part of the current segment without copying it, and advances the reading position.
+        const void* ReadView(std::size_t size);
+
         // Reads a null terminated string from the current segment.
         const char* ReadCString();
 
@@ -0,0 +1,139 @@
+/*
+ * StaticDispatch.inl
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+// THIS FILE MUST NOT HAVE A HEADER GUARD
+
+/*
+Implements the non-virtual entry points of <LLGL/StaticCommandBuffer.h> for the only backend of a static library.
+The including translation unit must define LLGL_STATIC_DISPATCH_COMMAND_BUFFER as the final command buffer class of that backend.
+Since that class is final, each call below is a direct call that the compiler can inline.
+*/
+
+#ifndef LLGL_STATIC_DISPATCH_COMMAND_BUFFER
+#error Missing definition of macro LLGL_STATIC_DISPATCH_COMMAND_BUFFER
+#endif
+
+
+#include <LLGL/StaticCommandBuffer.h>
+#include "CheckedCast.h"
+
+
+namespace LLGL
+{
+
+namespace StaticDispatch
+{
+
+
+#define LLGL_STATIC_DISPATCH_CAST(OBJ) \
+    LLGL_CAST(LLGL_STATIC_DISPATCH_COMMAND_BUFFER&, OBJ)
+
+LLGL_EXPORT void SetViewport(CommandBuffer& commandBuffer, const Viewport& viewport)
+{
+    LLGL_STATIC_DISPATCH_CAST(commandBuffer).SetViewport(viewport);
+}
+
+LLGL_EXPORT void SetScissor(CommandBuffer& commandBuffer, const Scissor& scissor)
+{
+    LLGL_STATIC_DISPATCH_CAST(commandBuffer).SetScissor(scissor);
+}
+
+LLGL_EXPORT void SetVertexBuffer(CommandBuffer& commandBuffer, Buffer& buffer)
+{
+    LLGL_STATIC_DISPATCH_CAST(commandBuffer).SetVertexBuffer(buffer);
+}
+
+LLGL_EXPORT void SetIndexBuffer(CommandBuffer& commandBuffer, Buffer& buffer)
+{
+    LLGL_STATIC_DISPATCH_CAST(commandBuffer).SetIndexBuffer(buffer);
+}
+
+LLGL_EXPORT void SetIndexBuffer(CommandBuffer& commandBuffer, Buffer& buffer, const Format format, std::uint64_t offset)
+{
+    LLGL_STATIC_DISPATCH_CAST(commandBuffer).SetIndexBuffer(buffer, format, offset);
+}
+
+LLGL_EXPORT void SetResourceHeap(CommandBuffer& commandBuffer, ResourceHeap& resourceHeap, std::uint32_t descriptorSet, const PipelineBindPoint bindPoint)
+{
+    LLGL_STATIC_DISPATCH_CAST(commandBuffer).SetResourceHeap(resourceHeap, descriptorSet, bindPoint);
+}
+
+LLGL_EXPORT void SetResourceHeap(CommandBuffer& commandBuffer, ResourceHeap& resourceHeap, std::uint32_t descriptorSet, std::uint32_t numDynamicOffsets, const std::uint32_t* dynamicOffsets, const PipelineBindPoint bindPoint)
+{
+    LLGL_STATIC_DISPATCH_CAST(commandBuffer).SetResourceHeap(resourceHeap, descriptorSet, numDynamicOffsets, dynamicOffsets, bindPoint);
+}
+
+LLGL_EXPORT void SetResource(CommandBuffer& commandBuffer, Resource& resource, std::uint32_t slot, long bindFlags, long stageFlags)
+{
+    LLGL_STATIC_DISPATCH_CAST(commandBuffer).SetResource(resource, slot, bindFlags, stageFlags);
+}
+
+LLGL_EXPORT void SetPipelineState(CommandBuffer& commandBuffer, PipelineState& pipelineState)
+{
+    LLGL_STATIC_DISPATCH_CAST(commandBuffer).SetPipelineState(pipelineState);
+}
+
+LLGL_EXPORT void SetUniforms(CommandBuffer& commandBuffer, UniformLocation location, std::uint32_t count, const void* data, std::uint32_t dataSize)
+{
+    LLGL_STATIC_DISPATCH_CAST(commandBuffer).SetUniforms(location, count, data, dataSize);
+}
+
+LLGL_EXPORT void Draw(CommandBuffer& commandBuffer, std::uint32_t numVertices, std::uint32_t firstVertex)
+{
+    LLGL_STATIC_DISPATCH_CAST(commandBuffer).Draw(numVertices, firstVertex);
+}
+
+LLGL_EXPORT void DrawIndexed(CommandBuffer& commandBuffer, std::uint32_t numIndices, std::uint32_t firstIndex)
+{
+    LLGL_STATIC_DISPATCH_CAST(commandBuffer).DrawIndexed(numIndices, firstIndex);
+}
+
+LLGL_EXPORT void DrawIndexed(CommandBuffer& commandBuffer, std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
+{
+    LLGL_STATIC_DISPATCH_CAST(commandBuffer).DrawIndexed(numIndices, firstIndex, vertexOffset);
+}
+
+LLGL_EXPORT void DrawInstanced(CommandBuffer& commandBuffer, std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
+{
+    LLGL_STATIC_DISPATCH_CAST(commandBuffer).DrawInstanced(numVertices, firstVertex, numInstances);
+}
+
+LLGL_EXPORT void DrawInstanced(CommandBuffer& commandBuffer, std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
+{
+    LLGL_STATIC_DISPATCH_CAST(commandBuffer).DrawInstanced(numVertices, firstVertex, numInstances, firstInstance);
+}
+
+LLGL_EXPORT void DrawIndexedInstanced(CommandBuffer& commandBuffer, std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
+{
+    LLGL_STATIC_DISPATCH_CAST(commandBuffer).DrawIndexedInstanced(numIndices, numInstances, firstIndex);
+}
+
+LLGL_EXPORT void DrawIndexedInstanced(CommandBuffer& commandBuffer, std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
+{
+    LLGL_STATIC_DISPATCH_CAST(commandBuffer).DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset);
+}
+
+LLGL_EXPORT void DrawIndexedInstanced(CommandBuffer& commandBuffer, std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
+{
+    LLGL_STATIC_DISPATCH_CAST(commandBuffer).DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
+}
+
+LLGL_EXPORT void Dispatch(CommandBuffer& commandBuffer, std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
+{
+    LLGL_STATIC_DISPATCH_CAST(commandBuffer).Dispatch(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+}
+
+#undef LLGL_STATIC_DISPATCH_CAST
+
+
+} // /namespace StaticDispatch
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -25,6 +25,10 @@ class RenderSystem;
         extern const char* GetModuleName();                                             \
         extern const char* GetRendererName();                                           \
         extern RenderSystem* AllocRenderSystem(const LLGL::RenderSystemDescriptor*);    \
+        extern void QueryVideoAdapters(                                                 \
+            const LLGL::RenderSystemDescriptor*,                                        \
+            std::vector<LLGL::VideoAdapterDescriptor>&                                  \
+        );                                                                              \
     }
 
 #ifdef LLGL_BUILD_RENDERER_NULL
@@ -205,6 +209,43 @@ RenderSystem* AllocRenderSystem(const RenderSystemDescriptor& renderSystemDesc)
     return nullptr;
 }
 
+void QueryVideoAdapters(const RenderSystemDescriptor& renderSystemDesc, std::vector<VideoAdapterDescriptor>& outAdapters)
+{
+    #define LLGL_QUERY_VIDEO_ADAPTERS(MODULE)                       \
+        if (renderSystemDesc.moduleName == MODULE::GetModuleName()) \
+            return MODULE::QueryVideoAdapters(&renderSystemDesc, outAdapters)
+
+    #ifdef LLGL_BUILD_RENDERER_NULL
+    LLGL_QUERY_VIDEO_ADAPTERS(ModuleNull);
+    #endif
+
+    #ifdef LLGL_BUILD_RENDERER_OPENGL
+    LLGL_QUERY_VIDEO_ADAPTERS(ModuleOpenGL);
+    #endif
+
+    #ifdef LLGL_BUILD_RENDERER_OPENGLES3
+    LLGL_QUERY_VIDEO_ADAPTERS(ModuleOpenGLES3);
+    #endif
+
+    #ifdef LLGL_BUILD_RENDERER_VULKAN
+    LLGL_QUERY_VIDEO_ADAPTERS(ModuleVulkan);
+    #endif
+
+    #ifdef LLGL_BUILD_RENDERER_METAL
+    LLGL_QUERY_VIDEO_ADAPTERS(ModuleMetal);
+    #endif
+
+    #ifdef LLGL_BUILD_RENDERER_DIRECT3D11
+    LLGL_QUERY_VIDEO_ADAPTERS(ModuleDirect3D11);
+    #endif
+
+    #ifdef LLGL_BUILD_RENDERER_DIRECT3D12
+    LLGL_QUERY_VIDEO_ADAPTERS(ModuleDirect3D12);
+    #endif
+
+    #undef LLGL_QUERY_VIDEO_ADAPTERS
+}
+
 
 } // /namespace StaticModule
 
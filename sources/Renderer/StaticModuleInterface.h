@@ -12,7 +12,9 @@
 
 
 #include <LLGL/RenderSystemFlags.h>
+#include <LLGL/VideoAdapter.h>
 #include <string>
+#include <vector>
 
 
 namespace LLGL
@@ -36,6 +38,9 @@ int GetRendererID(const std::string& moduleName);
 // Allocates a new renderer system of the specified module. This is an owning raw pointer!
 RenderSystem* AllocRenderSystem(const RenderSystemDescriptor& renderSystemDesc);
 
+// Appends all video adapters of the specified module to the output container.
+void QueryVideoAdapters(const RenderSystemDescriptor& renderSystemDesc, std::vector<VideoAdapterDescriptor>& outAdapters);
+
 
 } // /namespace StaticModule
 
@@ -114,6 +114,26 @@ bool SwapChain::ResizeBuffers(const Extent2D& resolution, long flags)
     return false;
 }
 
+void SwapChain::WaitForNextFrame()
+{
+    // dummy
+}
+
+bool SwapChain::QueryPresentStatistics(PresentStatistics& /*outStats*/)
+{
+    return false; // dummy
+}
+
+bool SwapChain::SetDamageRegions(std::uint32_t /*numRegions*/, const Scissor* /*regions*/)
+{
+    return false; // dummy
+}
+
+std::uint32_t SwapChain::QueryBufferAge()
+{
+    return 0; // dummy
+}
+
 /* ----- Configuration ----- */
 
 bool SwapChain::SwitchFullscreen(bool enable)
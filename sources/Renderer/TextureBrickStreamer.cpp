@@ -0,0 +1,631 @@
+/*
+ * TextureBrickStreamer.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/TextureBrickStreamer.h>
+#include <LLGL/RenderSystem.h>
+#include <LLGL/JobSystem.h>
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal structures ----- */
+
+enum class TextureBrickState : std::uint8_t
+{
+    Absent,
+    Pending,
+    InFlight,
+    Resident,
+};
+
+struct TextureBrick
+{
+    TextureBrickState   state           = TextureBrickState::Absent;
+    bool                evictRequested  = false;    // Evict brick as soon as its batch has finished
+};
+
+// Layout of a single brick within a staging buffer.
+struct TextureBrickUpload
+{
+    std::uint32_t   brick   = 0;
+    TextureRegion   region;                         // Region in texel space with the Z axis denoting slices or array layers
+    std::uint64_t   offset  = 0;
+};
+
+struct TextureBrickBatch
+{
+    enum class State
+    {
+        Free,
+        Encoded,
+        Submitted,
+    };
+
+    Buffer*                         buffer  = nullptr;
+    Fence*                          fence   = nullptr;
+    State                           state   = State::Free;
+    std::vector<TextureBrickUpload> uploads;
+};
+
+
+/* ----- Internal functions ----- */
+
+static std::uint64_t GreatestCommonDivisor(std::uint64_t a, std::uint64_t b)
+{
+    while (b != 0)
+    {
+        const std::uint64_t r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+// Returns the value rounded up to a multiple of the alignment, which does not need to be a power of two.
+template <typename T>
+static T AlignUp(T value, T alignment)
+{
+    return (alignment > 1 ? ((value + alignment - 1) / alignment) * alignment : value);
+}
+
+static std::uint32_t DivideRoundUp(std::uint32_t value, std::uint32_t divisor)
+{
+    return (value + divisor - 1) / divisor;
+}
+
+
+/*
+ * Pimpl structure
+ */
+
+struct TextureBrickStreamer::Pimpl
+{
+    Pimpl(
+        RenderSystem&                           renderSystem,
+        Texture&                                texture,
+        const TextureBrickSourceDescriptor&     sourceDesc,
+        const TextureBrickStreamerDescriptor&   streamerDesc
+    );
+    ~Pimpl();
+
+    std::uint32_t GetBrickIndex(const Offset3D& brick) const;
+    TextureRegion GetBrickRegion(std::uint32_t brickIndex) const;
+    TextureRegion GetTextureRegion(const TextureRegion& brickRegion) const;
+    TextureRegion GetTileRegion(const TextureRegion& brickRegion) const;
+
+    std::uint32_t GetRowStride(std::uint32_t width) const;
+
+    bool BuildBatch(TextureBrickBatch& batch);
+    void ExtractBricks(TextureBrickBatch& batch, char* dst);
+    void EncodeBatch(TextureBrickBatch& batch, CommandBuffer& commandBuffer);
+
+    void PollBatches();
+    void EvictBrick(std::uint32_t brickIndex);
+
+    RenderSystem&                   renderSystem;
+    CommandQueue*                   commandQueue        = nullptr;
+    Texture&                        texture;
+    TextureBrickSourceDescriptor    source;
+    TextureBrickStreamerDescriptor  desc;
+
+    bool                            isArray             = false;
+    bool                            isSparse            = false;
+    std::uint32_t                   texelSize           = 0;
+    std::uint64_t                   placementAlignment  = 512;  // Alignment of each brick within a staging buffer
+    std::uint64_t                   maxBrickSize        = 0;
+    Extent3D                        textureExtent;
+    Extent3D                        tileExtent;
+
+    Extent3D                        brickExtent;
+    Extent3D                        numBricks;
+    std::vector<TextureBrick>       bricks;
+    std::deque<std::uint32_t>       pendingQueue;
+    std::uint32_t                   numPendingBricks    = 0;
+    std::uint32_t                   numResidentBricks   = 0;
+
+    std::vector<TextureBrickBatch>  batches;
+};
+
+TextureBrickStreamer::Pimpl::Pimpl(
+    RenderSystem&                           renderSystem,
+    Texture&                                texture,
+    const TextureBrickSourceDescriptor&     sourceDesc,
+    const TextureBrickStreamerDescriptor&   streamerDesc)
+:
+    renderSystem { renderSystem                   },
+    commandQueue { renderSystem.GetCommandQueue() },
+    texture      { texture                        },
+    source       { sourceDesc                     },
+    desc         { streamerDesc                   }
+{
+    /* Validate texture and source volume */
+    const TextureType type = texture.GetType();
+    if (type != TextureType::Texture3D && type != TextureType::Texture2DArray)
+        throw std::invalid_argument("texture brick streamer requires a 3D texture or 2D-array texture");
+
+    const Format format = texture.GetFormat();
+    if (IsCompressedFormat(format))
+        throw std::invalid_argument("texture brick streamer cannot stream bricks of compressed texture format");
+
+    const TextureDescriptor textureDesc = texture.GetDesc();
+    isArray = (type == TextureType::Texture2DArray);
+
+    textureExtent = texture.GetMipExtent(0);
+    if (isArray)
+        textureExtent.depth = textureDesc.arrayLayers;
+
+    if (source.data == nullptr)
+        throw std::invalid_argument("texture brick streamer requires a source volume");
+    if (source.extent.width  == 0 || source.extent.width  > textureExtent.width  ||
+        source.extent.height == 0 || source.extent.height > textureExtent.height ||
+        source.extent.depth  == 0 || source.extent.depth  > textureExtent.depth)
+    {
+        throw std::invalid_argument("texture brick streamer source volume exceeds the extent of the texture");
+    }
+
+    /* Determine tightly packed strides of the source volume */
+    texelSize = GetFormatAttribs(format).bitSize / 8;
+    if (source.rowStride == 0)
+        source.rowStride = static_cast<std::uint64_t>(source.extent.width) * texelSize;
+    if (source.layerStride == 0)
+        source.layerStride = source.rowStride * source.extent.height;
+
+    /* Commit whole tiles per brick for sparse textures; this fails for texture types without sparse support */
+    brickExtent =
+    {
+        std::max(1u, desc.brickExtent.width),
+        std::max(1u, desc.brickExtent.height),
+        std::max(1u, desc.brickExtent.depth)
+    };
+
+    TextureTiling tiling;
+    if ((textureDesc.miscFlags & MiscFlags::Sparse) != 0 && renderSystem.QueryTextureTiling(texture, tiling))
+    {
+        isSparse    = true;
+        tileExtent  = tiling.tileExtent;
+        brickExtent.width   = AlignUp(brickExtent.width,  tiling.tileExtent.width);
+        brickExtent.height  = AlignUp(brickExtent.height, tiling.tileExtent.height);
+        if (!isArray)
+            brickExtent.depth = AlignUp(brickExtent.depth, tiling.tileExtent.depth);
+    }
+
+    brickExtent.width   = std::min(brickExtent.width,  source.extent.width);
+    brickExtent.height  = std::min(brickExtent.height, source.extent.height);
+    brickExtent.depth   = std::min(brickExtent.depth,  source.extent.depth);
+
+    numBricks =
+    {
+        DivideRoundUp(source.extent.width,  brickExtent.width),
+        DivideRoundUp(source.extent.height, brickExtent.height),
+        DivideRoundUp(source.extent.depth,  brickExtent.depth)
+    };
+    bricks.resize(static_cast<std::size_t>(numBricks.width) * numBricks.height * numBricks.depth);
+
+    /* Staging offsets must be a multiple of the texel size and of the placement alignment of Direct3D 12 */
+    placementAlignment = placementAlignment / GreatestCommonDivisor(placementAlignment, texelSize) * texelSize;
+
+    const std::uint64_t layerStride = static_cast<std::uint64_t>(GetRowStride(brickExtent.width)) * brickExtent.height;
+    if (layerStride > std::numeric_limits<std::uint32_t>::max())
+        throw std::invalid_argument("texture brick streamer brick extent exceeds the maximum stride of a staging buffer");
+
+    maxBrickSize = AlignUp(layerStride * brickExtent.depth, placementAlignment);
+
+    batches.resize(std::max(1u, desc.maxBatchesInFlight));
+}
+
+TextureBrickStreamer::Pimpl::~Pimpl()
+{
+    /* Wait until the GPU has finished all batches that might still read from the staging buffers */
+    commandQueue->WaitIdle();
+
+    for (auto& batch : batches)
+    {
+        if (batch.buffer != nullptr)
+            renderSystem.Release(*batch.buffer);
+        if (batch.fence != nullptr)
+            renderSystem.Release(*batch.fence);
+    }
+}
+
+std::uint32_t TextureBrickStreamer::Pimpl::GetBrickIndex(const Offset3D& brick) const
+{
+    if (brick.x < 0 || static_cast<std::uint32_t>(brick.x) >= numBricks.width  ||
+        brick.y < 0 || static_cast<std::uint32_t>(brick.y) >= numBricks.height ||
+        brick.z < 0 || static_cast<std::uint32_t>(brick.z) >= numBricks.depth)
+    {
+        return ~0u;
+    }
+    return ((static_cast<std::uint32_t>(brick.z) * numBricks.height + static_cast<std::uint32_t>(brick.y)) * numBricks.width + static_cast<std::uint32_t>(brick.x));
+}
+
+TextureRegion TextureBrickStreamer::Pimpl::GetBrickRegion(std::uint32_t brickIndex) const
+{
+    const std::uint32_t x = brickIndex % numBricks.width;
+    const std::uint32_t y = (brickIndex / numBricks.width) % numBricks.height;
+    const std::uint32_t z = brickIndex / (numBricks.width * numBricks.height);
+
+    /* Clamp bricks at the border to the extent of the source volume */
+    TextureRegion region;
+    {
+        region.offset.x         = static_cast<std::int32_t>(x * brickExtent.width);
+        region.offset.y         = static_cast<std::int32_t>(y * brickExtent.height);
+        region.offset.z         = static_cast<std::int32_t>(z * brickExtent.depth);
+        region.extent.width     = std::min(brickExtent.width,  source.extent.width  - x * brickExtent.width);
+        region.extent.height    = std::min(brickExtent.height, source.extent.height - y * brickExtent.height);
+        region.extent.depth     = std::min(brickExtent.depth,  source.extent.depth  - z * brickExtent.depth);
+    }
+    return region;
+}
+
+TextureRegion TextureBrickStreamer::Pimpl::GetTextureRegion(const TextureRegion& brickRegion) const
+{
+    if (!isArray)
+        return brickRegion;
+
+    /* Map Z axis of brick onto array layers */
+    TextureRegion region = brickRegion;
+    {
+        region.subresource.baseArrayLayer   = static_cast<std::uint32_t>(brickRegion.offset.z);
+        region.subresource.numArrayLayers   = brickRegion.extent.depth;
+        region.offset.z                     = 0;
+        region.extent.depth                 = 1;
+    }
+    return region;
+}
+
+TextureRegion TextureBrickStreamer::Pimpl::GetTileRegion(const TextureRegion& brickRegion) const
+{
+    /* Round region up to whole tiles, since bricks at the border of the source volume can end within a tile of the texture */
+    TextureRegion region = brickRegion;
+    {
+        region.extent.width     = std::min(AlignUp(region.extent.width,  tileExtent.width),  textureExtent.width  - static_cast<std::uint32_t>(region.offset.x));
+        region.extent.height    = std::min(AlignUp(region.extent.height, tileExtent.height), textureExtent.height - static_cast<std::uint32_t>(region.offset.y));
+        if (!isArray)
+            region.extent.depth = std::min(AlignUp(region.extent.depth,  tileExtent.depth),  textureExtent.depth  - static_cast<std::uint32_t>(region.offset.z));
+    }
+    return GetTextureRegion(region);
+}
+
+std::uint32_t TextureBrickStreamer::Pimpl::GetRowStride(std::uint32_t width) const
+{
+    /* Align rows to 256 bytes for Direct3D 12 unless that is not a multiple of the texel size (e.g. for RGB32 formats) */
+    const std::uint32_t rowSize = width * texelSize;
+    return (256 % texelSize == 0 ? AlignUp(rowSize, 256u) : rowSize);
+}
+
+bool TextureBrickStreamer::Pimpl::BuildBatch(TextureBrickBatch& batch)
+{
+    const std::uint64_t capacity = std::max(desc.stagingBufferSize, maxBrickSize);
+
+    batch.uploads.clear();
+    std::uint64_t offset = 0;
+
+    while (!pendingQueue.empty())
+    {
+        /* Skip requests that have been cancelled by Evict */
+        const std::uint32_t brickIndex = pendingQueue.front();
+        if (bricks[brickIndex].state != TextureBrickState::Pending)
+        {
+            pendingQueue.pop_front();
+            continue;
+        }
+
+        TextureBrickUpload upload;
+        {
+            upload.brick    = brickIndex;
+            upload.region   = GetBrickRegion(brickIndex);
+            upload.offset   = AlignUp(offset, placementAlignment);
+        }
+
+        const std::uint64_t size = static_cast<std::uint64_t>(GetRowStride(upload.region.extent.width)) * upload.region.extent.height * upload.region.extent.depth;
+        if (upload.offset + size > capacity)
+            break;
+
+        pendingQueue.pop_front();
+        bricks[brickIndex].state = TextureBrickState::InFlight;
+        --numPendingBricks;
+
+        batch.uploads.push_back(upload);
+        offset = upload.offset + size;
+    }
+
+    if (batch.uploads.empty())
+        return false;
+
+    /* Create staging buffer and fence with the first batch in this slot */
+    if (batch.buffer == nullptr)
+    {
+        BufferDescriptor bufferDesc;
+        {
+            bufferDesc.size             = capacity;
+            bufferDesc.bindFlags        = BindFlags::CopySrc;
+            bufferDesc.cpuAccessFlags   = CPUAccessFlags::Write;
+            bufferDesc.miscFlags        = MiscFlags::NoInitialData;
+        }
+        batch.buffer    = renderSystem.CreateBuffer(bufferDesc);
+        batch.fence     = renderSystem.CreateFence();
+    }
+
+    return true;
+}
+
+void TextureBrickStreamer::Pimpl::ExtractBricks(TextureBrickBatch& batch, char* dst)
+{
+    /* Split work into slices of all bricks, so small batches of large bricks are still distributed over all threads */
+    struct BrickSlice
+    {
+        const TextureBrickUpload*   upload;
+        std::uint32_t               z;
+    };
+
+    std::vector<BrickSlice> slices;
+    for (const auto& upload : batch.uploads)
+    {
+        for (std::uint32_t z = 0; z < upload.region.extent.depth; ++z)
+            slices.push_back(BrickSlice{ &upload, z });
+    }
+
+    auto src = reinterpret_cast<const char*>(source.data);
+
+    JobSystem::ParallelFor(
+        slices.size(),
+        1,
+        desc.maxThreads,
+        [this, &slices, src, dst](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                const auto& upload      = *(slices[i].upload);
+                const auto& region      = upload.region;
+                const auto  rowSize     = static_cast<std::size_t>(region.extent.width) * texelSize;
+                const auto  rowStride   = static_cast<std::uint64_t>(GetRowStride(region.extent.width));
+                const auto  z           = static_cast<std::uint64_t>(region.offset.z) + slices[i].z;
+
+                const char* srcSlice = src + z * source.layerStride + static_cast<std::uint64_t>(region.offset.x) * texelSize;
+                char*       dstSlice = dst + upload.offset + slices[i].z * rowStride * region.extent.height;
+
+                for (std::uint32_t y = 0; y < region.extent.height; ++y)
+                {
+                    ::memcpy(
+                        dstSlice + y * rowStride,
+                        srcSlice + (static_cast<std::uint64_t>(region.offset.y) + y) * source.rowStride,
+                        rowSize
+                    );
+                }
+            }
+        }
+    );
+}
+
+void TextureBrickStreamer::Pimpl::EncodeBatch(TextureBrickBatch& batch, CommandBuffer& commandBuffer)
+{
+    for (const auto& upload : batch.uploads)
+    {
+        const TextureRegion textureRegion   = GetTextureRegion(upload.region);
+        const std::uint32_t rowStride       = GetRowStride(upload.region.extent.width);
+        const std::uint32_t layerStride     = rowStride * upload.region.extent.height;
+
+        /* Tiles are committed on the command queue in order with the command buffers that have been submitted before */
+        if (isSparse)
+            renderSystem.CommitTextureTiles(texture, GetTileRegion(upload.region));
+
+        commandBuffer.CopyTextureFromBuffer(texture, textureRegion, *batch.buffer, upload.offset, rowStride, layerStride);
+    }
+    batch.state = TextureBrickBatch::State::Encoded;
+}
+
+void TextureBrickStreamer::Pimpl::PollBatches()
+{
+    for (auto& batch : batches)
+    {
+        if (batch.state != TextureBrickBatch::State::Submitted || !commandQueue->WaitFence(*batch.fence, 0))
+            continue;
+
+        for (const auto& upload : batch.uploads)
+        {
+            auto& brick = bricks[upload.brick];
+            if (brick.state != TextureBrickState::InFlight)
+                continue;
+
+            brick.state = TextureBrickState::Resident;
+            ++numResidentBricks;
+
+            if (brick.evictRequested)
+                EvictBrick(upload.brick);
+        }
+
+        batch.uploads.clear();
+        batch.state = TextureBrickBatch::State::Free;
+    }
+}
+
+void TextureBrickStreamer::Pimpl::EvictBrick(std::uint32_t brickIndex)
+{
+    auto& brick = bricks[brickIndex];
+    switch (brick.state)
+    {
+        case TextureBrickState::Absent:
+            break;
+
+        case TextureBrickState::Pending:
+            /* Cancel request; the queue entry is skipped when the next batch is built */
+            brick.state = TextureBrickState::Absent;
+            --numPendingBricks;
+            break;
+
+        case TextureBrickState::InFlight:
+            brick.evictRequested = true;
+            break;
+
+        case TextureBrickState::Resident:
+            if (isSparse)
+                renderSystem.DecommitTextureTiles(texture, GetTileRegion(GetBrickRegion(brickIndex)));
+            brick.state             = TextureBrickState::Absent;
+            brick.evictRequested    = false;
+            --numResidentBricks;
+            break;
+    }
+}
+
+
+/*
+ * TextureBrickStreamer class
+ */
+
+TextureBrickStreamer::TextureBrickStreamer(
+    RenderSystem&                           renderSystem,
+    Texture&                                texture,
+    const TextureBrickSourceDescriptor&     sourceDesc,
+    const TextureBrickStreamerDescriptor&   streamerDesc)
+:
+    pimpl_ { new Pimpl{ renderSystem, texture, sourceDesc, streamerDesc } }
+{
+}
+
+TextureBrickStreamer::~TextureBrickStreamer()
+{
+    delete pimpl_;
+}
+
+void TextureBrickStreamer::Request(const Offset3D& brick)
+{
+    const std::uint32_t brickIndex = pimpl_->GetBrickIndex(brick);
+    if (brickIndex == ~0u)
+        return;
+
+    auto& state = pimpl_->bricks[brickIndex];
+    if (state.state == TextureBrickState::Absent)
+    {
+        state.state = TextureBrickState::Pending;
+        pimpl_->pendingQueue.push_back(brickIndex);
+        ++pimpl_->numPendingBricks;
+    }
+    else if (state.state == TextureBrickState::InFlight)
+    {
+        /* Keep brick resident if it has been evicted while its batch is still in flight */
+        state.evictRequested = false;
+    }
+}
+
+void TextureBrickStreamer::RequestAll()
+{
+    for (std::uint32_t i = 0, n = static_cast<std::uint32_t>(pimpl_->bricks.size()); i < n; ++i)
+    {
+        auto& state = pimpl_->bricks[i];
+        if (state.state == TextureBrickState::Absent)
+        {
+            state.state = TextureBrickState::Pending;
+            pimpl_->pendingQueue.push_back(i);
+            ++pimpl_->numPendingBricks;
+        }
+        else if (state.state == TextureBrickState::InFlight)
+            state.evictRequested = false;
+    }
+}
+
+void TextureBrickStreamer::Evict(const Offset3D& brick)
+{
+    const std::uint32_t brickIndex = pimpl_->GetBrickIndex(brick);
+    if (brickIndex != ~0u)
+        pimpl_->EvictBrick(brickIndex);
+}
+
+std::uint32_t TextureBrickStreamer::Encode(CommandBuffer& commandBuffer)
+{
+    pimpl_->PollBatches();
+
+    if (pimpl_->numPendingBricks == 0)
+        return 0;
+
+    /* Find staging buffer that is not in flight; never wait for the GPU */
+    for (auto& batch : pimpl_->batches)
+    {
+        if (batch.state != TextureBrickBatch::State::Free)
+            continue;
+
+        if (!pimpl_->BuildBatch(batch))
+            return 0;
+
+        /* Extract bricks directly into the mapped staging buffer */
+        auto dst = reinterpret_cast<char*>(pimpl_->renderSystem.MapBuffer(*batch.buffer, CPUAccess::WriteDiscard));
+        if (dst == nullptr)
+        {
+            /* Return bricks to the front of the queue in their original order */
+            for (auto it = batch.uploads.rbegin(); it != batch.uploads.rend(); ++it)
+            {
+                pimpl_->bricks[it->brick].state = TextureBrickState::Pending;
+                pimpl_->pendingQueue.push_front(it->brick);
+                ++pimpl_->numPendingBricks;
+            }
+            batch.uploads.clear();
+            return 0;
+        }
+
+        pimpl_->ExtractBricks(batch, dst);
+        pimpl_->renderSystem.UnmapBuffer(*batch.buffer);
+
+        pimpl_->EncodeBatch(batch, commandBuffer);
+
+        return static_cast<std::uint32_t>(batch.uploads.size());
+    }
+
+    return 0;
+}
+
+void TextureBrickStreamer::NextBatch()
+{
+    for (auto& batch : pimpl_->batches)
+    {
+        if (batch.state == TextureBrickBatch::State::Encoded)
+        {
+            pimpl_->commandQueue->Submit(*batch.fence);
+            batch.state = TextureBrickBatch::State::Submitted;
+        }
+    }
+    pimpl_->PollBatches();
+}
+
+const Extent3D& TextureBrickStreamer::GetNumBricks() const
+{
+    return pimpl_->numBricks;
+}
+
+const Extent3D& TextureBrickStreamer::GetBrickExtent() const
+{
+    return pimpl_->brickExtent;
+}
+
+bool TextureBrickStreamer::IsResident(const Offset3D& brick) const
+{
+    const std::uint32_t brickIndex = pimpl_->GetBrickIndex(brick);
+    return (brickIndex != ~0u && pimpl_->bricks[brickIndex].state == TextureBrickState::Resident);
+}
+
+std::uint32_t TextureBrickStreamer::GetNumResidentBricks() const
+{
+    return pimpl_->numResidentBricks;
+}
+
+std::uint32_t TextureBrickStreamer::GetNumPendingBricks() const
+{
+    return pimpl_->numPendingBricks;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
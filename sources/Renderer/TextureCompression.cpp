@@ -0,0 +1,86 @@
+/*
+ * TextureCompression.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/TextureCompression.h>
+#include <LLGL/CommandBuffer.h>
+#include <LLGL/Texture.h>
+#include <LLGL/TransientBufferAllocator.h>
+#include <LLGL/JobSystem.h>
+#include "TextureUtils.h"
+#include "../Core/Assertion.h"
+#include "../Core/ImageCompressor.h"
+#include "../Core/ImageDecompressor.h"
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+// Alignment of the staging memory, which satisfies the placement alignment of Direct3D 12 for texture copies
+static const std::uint64_t g_stagingAlignment = 512;
+
+LLGL_EXPORT bool CompressTexture(
+    CommandBuffer&              commandBuffer,
+    TransientBufferAllocator&   stagingAllocator,
+    Texture&                    dstTexture,
+    const TextureRegion&        dstRegion,
+    const SrcImageDescriptor&   srcImageDesc,
+    unsigned                    threadCount)
+{
+    /* Validate destination texture and region */
+    const auto& formatAttribs = GetFormatAttribs(dstTexture.GetFormat());
+    if ((formatAttribs.flags & FormatFlags::IsCompressed) == 0)
+        throw std::invalid_argument("cannot compress texture with uncompressed format");
+    if (dstRegion.subresource.numMipLevels != 1)
+        throw std::invalid_argument("cannot compress texture region with more or less than one MIP-map level");
+
+    LLGL_ASSERT_PTR(srcImageDesc.data);
+
+    const Extent3D extent = CalcTextureExtent(dstTexture.GetType(), dstRegion.extent, dstRegion.subresource.numArrayLayers);
+    const std::size_t numTexels = static_cast<std::size_t>(extent.width) * extent.height * extent.depth;
+
+    if (numTexels == 0)
+        return false;
+
+    if (threadCount >= Constants::maxThreadCount)
+        threadCount = JobSystem::GetThreadCount();
+
+    if (srcImageDesc.dataSize < GetMemoryFootprint(srcImageDesc.format, srcImageDesc.dataType, numTexels))
+        throw std::invalid_argument("source image data size is too small for texture region");
+
+    /* Convert source image into the format the texture format is decompressed to, unless it already has that format */
+    const auto uncompressedFormat = GetDecompressedImageFormat(formatAttribs.format);
+
+    SrcImageDescriptor uncompressedImageDesc = srcImageDesc;
+    ByteBuffer intermediateImage;
+
+    if (srcImageDesc.format != uncompressedFormat || srcImageDesc.dataType != formatAttribs.dataType)
+    {
+        uncompressedImageDesc.dataSize = GetMemoryFootprint(srcImageDesc.format, srcImageDesc.dataType, numTexels);
+        intermediateImage = ConvertImageBuffer(uncompressedImageDesc, uncompressedFormat, formatAttribs.dataType, threadCount);
+        uncompressedImageDesc = SrcImageDescriptor{ uncompressedFormat, formatAttribs.dataType, intermediateImage.get(), GetMemoryFootprint(uncompressedFormat, formatAttribs.dataType, numTexels) };
+    }
+
+    /* Compress image directly into staging memory */
+    TransientBufferAllocation staging = stagingAllocator.Allocate(GetCompressedImageSize(formatAttribs.format, extent), g_stagingAlignment);
+    if (staging.data == nullptr || staging.buffer == nullptr)
+        return false;
+
+    CompressBlockImage(uncompressedImageDesc, extent, formatAttribs.format, staging.data, threadCount);
+
+    commandBuffer.CopyTextureFromBuffer(dstTexture, dstRegion, *staging.buffer, staging.offset);
+
+    return true;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
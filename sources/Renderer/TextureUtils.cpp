@@ -9,6 +9,9 @@
 #include <LLGL/StaticLimits.h>
 #include "../Core/Helper.h"
 #include "../Core/HelperMacros.h"
+#include "../Core/ImageUtils.h"
+#include <stdexcept>
+#include <string>
 
 
 namespace LLGL
@@ -80,6 +83,84 @@ LLGL_EXPORT SubresourceLayout CalcSubresourceLayout(const Format format, const E
     return layout;
 }
 
+LLGL_EXPORT SubresourceLayout CalcSubresourceLayout(const Format format, const Extent3D& extent, std::uint32_t rowStride, std::uint32_t layerStride)
+{
+    SubresourceLayout layout = CalcSubresourceLayout(format, extent);
+    if (rowStride != 0 || layerStride != 0)
+    {
+        /* Rows of compressed formats refer to rows of blocks */
+        const auto& formatDesc = GetFormatAttribs(format);
+        const std::uint32_t numRows = (formatDesc.blockHeight > 1 ? (extent.height + formatDesc.blockHeight - 1) / formatDesc.blockHeight : extent.height);
+        const std::uint32_t rowSize = layout.rowStride;
+
+        if (rowStride != 0)
+            layout.rowStride = rowStride;
+        layout.layerStride = (layerStride != 0 ? layerStride : numRows * layout.rowStride);
+
+        /* Padding after the last row is not required */
+        if (numRows > 0 && extent.depth > 0)
+            layout.dataSize = (extent.depth - 1) * layout.layerStride + (numRows - 1) * layout.rowStride + rowSize;
+        else
+            layout.dataSize = 0;
+    }
+    return layout;
+}
+
+LLGL_EXPORT ByteBuffer PackStridedImage(const SrcImageDescriptor& imageDesc, const Extent3D& extent, SrcImageDescriptor& outImageDesc)
+{
+    outImageDesc = imageDesc;
+    outImageDesc.rowStride      = 0;
+    outImageDesc.layerStride    = 0;
+
+    if (imageDesc.rowStride == 0 && imageDesc.layerStride == 0)
+        return nullptr;
+
+    /* Determine packed and strided layouts */
+    const std::uint32_t bpp             = GetMemoryFootprint(imageDesc.format, imageDesc.dataType, 1);
+    if (bpp == 0)
+        return nullptr;
+
+    const std::uint32_t packedRowSize   = bpp * extent.width;
+    const std::uint32_t packedLayerSize = packedRowSize * extent.height;
+    const std::uint32_t srcRowStride    = (imageDesc.rowStride != 0 ? imageDesc.rowStride : packedRowSize);
+    const std::uint32_t srcLayerStride  = (imageDesc.layerStride != 0 ? imageDesc.layerStride : srcRowStride * extent.height);
+
+    if (srcRowStride == packedRowSize && srcLayerStride == packedLayerSize)
+        return nullptr;
+
+    /* Validate the strided image covers the entire region */
+    if (extent.width == 0 || extent.height == 0 || extent.depth == 0)
+        return nullptr;
+
+    const std::size_t requiredSize = static_cast<std::size_t>(srcLayerStride) * (extent.depth - 1) + static_cast<std::size_t>(srcRowStride) * (extent.height - 1) + packedRowSize;
+    if (srcRowStride < packedRowSize || imageDesc.data == nullptr || imageDesc.dataSize < requiredSize)
+    {
+        throw std::invalid_argument(
+            "image data size is too small for strided image (" + std::to_string(requiredSize) +
+            " is required but only " + std::to_string(imageDesc.dataSize) + " was specified)"
+        );
+    }
+
+    /* Copy strided rows into tightly packed buffer */
+    const std::size_t packedSize = static_cast<std::size_t>(packedLayerSize) * extent.depth;
+    auto packedData = AllocateByteBuffer(packedSize, UninitializeTag{});
+    BitBlit(
+        extent,
+        bpp,
+        packedData.get(),
+        packedRowSize,
+        packedLayerSize,
+        static_cast<const char*>(imageDesc.data),
+        srcRowStride,
+        srcLayerStride
+    );
+
+    outImageDesc.data       = packedData.get();
+    outImageDesc.dataSize   = packedSize;
+
+    return packedData;
+}
+
 LLGL_EXPORT bool MustGenerateMipsOnCreate(const TextureDescriptor& textureDesc)
 {
     return
@@ -10,6 +10,7 @@
 
 
 #include <LLGL/TextureFlags.h>
+#include <LLGL/ImageFlags.h>
 
 
 namespace LLGL
@@ -58,6 +59,18 @@ LLGL_EXPORT Extent3D CalcTextureExtent(const TextureType type, const Extent3D& e
 // Calculates the size and strides for a subresource of the specified format and extent.
 LLGL_EXPORT SubresourceLayout CalcSubresourceLayout(const Format format, const Extent3D& extent);
 
+/*
+Calculates the size and strides for a subresource of the specified format and extent with optional row and layer strides (see SrcImageDescriptor::rowStride).
+A stride of zero denotes the tightly packed layout. The data size is the minimum number of bytes that covers all strided rows and layers.
+*/
+LLGL_EXPORT SubresourceLayout CalcSubresourceLayout(const Format format, const Extent3D& extent, std::uint32_t rowStride, std::uint32_t layerStride);
+
+/*
+Copies the specified uncompressed image into a tightly packed buffer if it has row or layer strides, e.g. before it is passed to ConvertImageBuffer.
+Returns null and copies the input into 'outImageDesc' if no repacking is necessary. Otherwise, 'outImageDesc' refers to the returned buffer.
+*/
+LLGL_EXPORT ByteBuffer PackStridedImage(const SrcImageDescriptor& imageDesc, const Extent3D& extent, SrcImageDescriptor& outImageDesc);
+
 // Returns true if the specified flags for texture creation require MIP-map generation at creation time.
 LLGL_EXPORT bool MustGenerateMipsOnCreate(const TextureDescriptor& textureDesc);
 
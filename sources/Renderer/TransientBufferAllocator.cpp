@@ -0,0 +1,278 @@
+/*
+ * TransientBufferAllocator.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/TransientBufferAllocator.h>
+#include <LLGL/RenderSystem.h>
+#include "../Core/Helper.h"
+#include <algorithm>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal structures ----- */
+
+struct TransientBufferPage
+{
+    Buffer*         buffer  = nullptr;
+    std::uint64_t   size    = 0;
+    std::uint64_t   offset  = 0;        // Offset of the next allocation within this page.
+    char*           mapped  = nullptr;  // Mapped CPU memory of this page, or null if the page is currently unmapped.
+};
+
+struct TransientBufferFrame
+{
+    Fence*                              fence       = nullptr;
+    bool                                submitted   = false;
+    std::vector<TransientBufferPage>    pages;
+};
+
+
+/* ----- Internal functions ----- */
+
+static std::uint64_t GetDefaultAlignment(const RenderingLimits& limits, long bindFlags)
+{
+    std::uint64_t alignment = 16;
+    if ((bindFlags & BindFlags::ConstantBuffer) != 0)
+        alignment = std::max(alignment, limits.minConstantBufferAlignment);
+    if ((bindFlags & BindFlags::Sampled) != 0)
+        alignment = std::max(alignment, limits.minSampledBufferAlignment);
+    if ((bindFlags & BindFlags::Storage) != 0)
+        alignment = std::max(alignment, limits.minStorageBufferAlignment);
+    return alignment;
+}
+
+
+/*
+ * Pimpl structure
+ */
+
+struct TransientBufferAllocator::Pimpl
+{
+    Pimpl(RenderSystem& renderSystem, const TransientBufferAllocatorDescriptor& allocatorDesc);
+    ~Pimpl();
+
+    TransientBufferPage AcquirePage(std::uint64_t size);
+    void RecyclePages(TransientBufferFrame& frame);
+    void UnmapPages(TransientBufferFrame& frame);
+
+    RenderSystem&                       renderSystem;
+    CommandQueue*                       commandQueue        = nullptr;
+    TransientBufferAllocatorDescriptor  desc;
+    std::uint64_t                       defaultAlignment    = 16;
+
+    std::vector<TransientBufferFrame>   frames;
+    std::size_t                         currentFrame        = 0;
+    std::size_t                         activePage          = ~0u;  // Index of the page in the current frame that new allocations are taken from.
+    std::uint64_t                       frameAllocatedSize  = 0;
+
+    std::vector<TransientBufferPage>    freePages;
+    std::uint64_t                       totalPageSize       = 0;
+};
+
+TransientBufferAllocator::Pimpl::Pimpl(RenderSystem& renderSystem, const TransientBufferAllocatorDescriptor& allocatorDesc) :
+    renderSystem     { renderSystem                                                                         },
+    commandQueue     { renderSystem.GetCommandQueue()                                                       },
+    desc             { allocatorDesc                                                                        },
+    defaultAlignment { GetDefaultAlignment(renderSystem.GetRenderingCaps().limits, allocatorDesc.bindFlags) }
+{
+    frames.resize(std::max(1u, allocatorDesc.maxFramesInFlight));
+    for (auto& frame : frames)
+        frame.fence = renderSystem.CreateFence();
+}
+
+TransientBufferAllocator::Pimpl::~Pimpl()
+{
+    /* Wait until the GPU has finished all frames that might still read from the pages */
+    for (auto& frame : frames)
+        UnmapPages(frame);
+    commandQueue->WaitIdle();
+
+    for (auto& frame : frames)
+    {
+        for (auto& page : frame.pages)
+            renderSystem.Release(*page.buffer);
+        renderSystem.Release(*frame.fence);
+    }
+    for (auto& page : freePages)
+        renderSystem.Release(*page.buffer);
+}
+
+TransientBufferPage TransientBufferAllocator::Pimpl::AcquirePage(std::uint64_t size)
+{
+    /* Recycle free page if the allocation fits into a regular page */
+    if (size <= desc.pageSize && !freePages.empty())
+    {
+        auto page = freePages.back();
+        freePages.pop_back();
+        return page;
+    }
+
+    /* Create new page; allocations that are larger than the page size get a dedicated page */
+    BufferDescriptor bufferDesc;
+    {
+        bufferDesc.size             = std::max(size, desc.pageSize);
+        bufferDesc.bindFlags        = desc.bindFlags;
+        bufferDesc.cpuAccessFlags   = CPUAccessFlags::Write;
+        bufferDesc.miscFlags        = (MiscFlags::NoInitialData | MiscFlags::Streaming);
+    }
+    TransientBufferPage page;
+    {
+        page.buffer = renderSystem.CreateBuffer(bufferDesc);
+        page.size   = bufferDesc.size;
+    }
+    totalPageSize += page.size;
+    return page;
+}
+
+void TransientBufferAllocator::Pimpl::RecyclePages(TransientBufferFrame& frame)
+{
+    for (auto& page : frame.pages)
+    {
+        if (page.size == desc.pageSize)
+        {
+            page.offset = 0;
+            freePages.push_back(page);
+        }
+        else
+        {
+            /* Release dedicated pages immediately */
+            totalPageSize -= page.size;
+            renderSystem.Release(*page.buffer);
+        }
+    }
+    frame.pages.clear();
+}
+
+void TransientBufferAllocator::Pimpl::UnmapPages(TransientBufferFrame& frame)
+{
+    for (auto& page : frame.pages)
+    {
+        if (page.mapped != nullptr)
+        {
+            renderSystem.UnmapBuffer(*page.buffer);
+            page.mapped = nullptr;
+        }
+    }
+}
+
+
+/*
+ * TransientBufferAllocator class
+ */
+
+TransientBufferAllocator::TransientBufferAllocator(RenderSystem& renderSystem, const TransientBufferAllocatorDescriptor& allocatorDesc) :
+    pimpl_ { new Pimpl{ renderSystem, allocatorDesc } }
+{
+}
+
+TransientBufferAllocator::~TransientBufferAllocator()
+{
+    delete pimpl_;
+}
+
+TransientBufferAllocation TransientBufferAllocator::Allocate(std::uint64_t size, std::uint64_t alignment)
+{
+    TransientBufferAllocation alloc;
+
+    if (size == 0)
+        return alloc;
+
+    if (alignment == 0)
+        alignment = pimpl_->defaultAlignment;
+
+    auto& frame = pimpl_->frames[pimpl_->currentFrame];
+
+    /* Find page with enough space; allocations never span multiple pages */
+    std::size_t pageIndex = pimpl_->activePage;
+    std::uint64_t offset = 0;
+
+    if (size > pimpl_->desc.pageSize)
+    {
+        /* Allocate dedicated page, but keep the active page for subsequent allocations */
+        frame.pages.push_back(pimpl_->AcquirePage(size));
+        pageIndex = frame.pages.size() - 1;
+    }
+    else
+    {
+        if (pageIndex < frame.pages.size())
+            offset = GetAlignedSize(frame.pages[pageIndex].offset, alignment);
+        if (pageIndex >= frame.pages.size() || offset + size > frame.pages[pageIndex].size)
+        {
+            frame.pages.push_back(pimpl_->AcquirePage(size));
+            pageIndex = frame.pages.size() - 1;
+            pimpl_->activePage = pageIndex;
+            offset = 0;
+        }
+    }
+
+    auto& page = frame.pages[pageIndex];
+
+    /* Map page on first allocation after it has been flushed */
+    if (page.mapped == nullptr)
+    {
+        page.mapped = reinterpret_cast<char*>(pimpl_->renderSystem.MapBuffer(*page.buffer, CPUAccess::WriteOnly));
+        if (page.mapped == nullptr)
+            return alloc;
+    }
+
+    pimpl_->frameAllocatedSize += (offset + size - page.offset);
+    page.offset = offset + size;
+
+    alloc.data      = page.mapped + offset;
+    alloc.buffer    = page.buffer;
+    alloc.offset    = offset;
+    alloc.size      = size;
+
+    return alloc;
+}
+
+void TransientBufferAllocator::Flush()
+{
+    pimpl_->UnmapPages(pimpl_->frames[pimpl_->currentFrame]);
+}
+
+void TransientBufferAllocator::NextFrame()
+{
+    /* Retire current frame with a fence */
+    auto& prevFrame = pimpl_->frames[pimpl_->currentFrame];
+    pimpl_->UnmapPages(prevFrame);
+    pimpl_->commandQueue->Submit(*prevFrame.fence);
+    prevFrame.submitted = true;
+
+    /* Wait for the oldest frame in flight and recycle its pages */
+    pimpl_->currentFrame = (pimpl_->currentFrame + 1) % pimpl_->frames.size();
+    auto& nextFrame = pimpl_->frames[pimpl_->currentFrame];
+    if (nextFrame.submitted)
+    {
+        pimpl_->commandQueue->WaitFence(*nextFrame.fence, ~0ull);
+        nextFrame.submitted = false;
+    }
+    pimpl_->RecyclePages(nextFrame);
+
+    pimpl_->activePage          = ~0u;
+    pimpl_->frameAllocatedSize  = 0;
+}
+
+std::uint64_t TransientBufferAllocator::GetFrameAllocatedSize() const
+{
+    return pimpl_->frameAllocatedSize;
+}
+
+std::uint64_t TransientBufferAllocator::GetTotalPageSize() const
+{
+    return pimpl_->totalPageSize;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
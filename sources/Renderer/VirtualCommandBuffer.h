@@ -10,7 +10,9 @@
 
 
 #include "../Core/Assertion.h"
+#include <LLGL/Allocator.h>
 #include <cstddef>
+#include <cstdint>
 #include <algorithm>
 #include <iterator>
 #include <string.h>
@@ -33,8 +35,92 @@ struct DefaultBufferGrowPolicy
     }
 };
 
+// The default policy to allocate chunks is to allocate them with the LLGL allocator, which uses the global heap unless the host application has overridden it.
+struct DefaultChunkAllocPolicy
+{
+    // Allocates a memory block of at least the specified size (in bytes). The size can be increased to the actual size of the block.
+    static inline void* Allocate(std::size_t& size)
+    {
+        return Allocator::Allocate(size);
+    }
+    static inline void Free(void* block, std::size_t size)
+    {
+        Allocator::Free(block, size);
+    }
+};
+
+// Policy to recycle chunks within a thread-local pool, so command buffers that are recorded and destroyed repeatedly on the same thread do not allocate from the global heap.
+struct PooledChunkAllocPolicy
+{
+    static inline void* Allocate(std::size_t& size)
+    {
+        auto& pool = GetPool();
+
+        /* Find smallest pooled block that fits the requested size, but do not waste more than half of a block */
+        std::size_t bestIndex = pool.numBlocks;
+        for (std::size_t i = 0; i < pool.numBlocks; ++i)
+        {
+            const std::size_t blockSize = pool.blocks[i].size;
+            if (blockSize >= size && blockSize / 2 <= size && (bestIndex == pool.numBlocks || blockSize < pool.blocks[bestIndex].size))
+                bestIndex = i;
+        }
+
+        if (bestIndex < pool.numBlocks)
+        {
+            /* Take block out of the pool and fill the gap with the last block */
+            void* block = pool.blocks[bestIndex].block;
+            size = pool.blocks[bestIndex].size;
+            pool.blocks[bestIndex] = pool.blocks[--pool.numBlocks];
+            return block;
+        }
+
+        return DefaultChunkAllocPolicy::Allocate(size);
+    }
+
+    static inline void Free(void* block, std::size_t size)
+    {
+        /* Blocks that are freed after the pool of this thread has been destroyed go back to the global heap */
+        auto& pool = GetPool();
+        if (!pool.destroyed && pool.numBlocks < Pool::maxNumBlocks)
+            pool.blocks[pool.numBlocks++] = { block, size };
+        else
+            DefaultChunkAllocPolicy::Free(block, size);
+    }
+
+    private:
+
+        struct PooledBlock
+        {
+            void*       block;
+            std::size_t size;
+        };
+
+        struct Pool
+        {
+            static const std::size_t maxNumBlocks = 32;
+
+            ~Pool()
+            {
+                for (std::size_t i = 0; i < numBlocks; ++i)
+                    DefaultChunkAllocPolicy::Free(blocks[i].block, blocks[i].size);
+                numBlocks = 0;
+                destroyed = true;
+            }
+
+            PooledBlock blocks[maxNumBlocks];
+            std::size_t numBlocks = 0;
+            bool        destroyed = false;
+        };
+
+        static inline Pool& GetPool()
+        {
+            static thread_local Pool pool;
+            return pool;
+        }
+};
+
 // Container class to manage the memory for virtual command buffers.
-template <typename TOpcode, typename TGrowPolicy = DefaultBufferGrowPolicy>
+template <typename TOpcode, typename TGrowPolicy = DefaultBufferGrowPolicy, typename TChunkAllocPolicy = DefaultChunkAllocPolicy>
 class VirtualCommandBuffer
 {
 
@@ -135,7 +221,10 @@ class VirtualCommandBuffer
         {
             std::swap(first_, rhs.first_);
             std::swap(current_, rhs.current_);
+            std::swap(biggest_, rhs.biggest_);
+            std::swap(capacity_, rhs.capacity_);
             std::swap(size_, rhs.size_);
+            std::swap(highWaterMark_, rhs.highWaterMark_);
         }
 
         // Takes the ownership of the specified virtual command buffer memory.
@@ -143,7 +232,10 @@ class VirtualCommandBuffer
         {
             std::swap(first_, rhs.first_);
             std::swap(current_, rhs.current_);
+            std::swap(biggest_, rhs.biggest_);
+            std::swap(capacity_, rhs.capacity_);
             std::swap(size_, rhs.size_);
+            std::swap(highWaterMark_, rhs.highWaterMark_);
             return *this;
         }
 
@@ -171,6 +263,12 @@ class VirtualCommandBuffer
             return size_;
         }
 
+        // Returns the maximum size (in bytes) this virtual command buffer has reached since it was created.
+        std::size_t HighWaterMark() const
+        {
+            return highWaterMark_;
+        }
+
         // Returns true if this virtual command buffer is empty, i.e. Size() returns zero.
         bool Empty() const
         {
@@ -189,6 +287,19 @@ class VirtualCommandBuffer
             }
         }
 
+        /*
+        Reserves a single memory chunk with at least the specified capacity (in bytes) if this virtual command buffer is empty.
+        This is used to pre-reserve the high-water mark, so subsequent recordings neither allocate new chunks nor have to be packed.
+        */
+        void Reserve(std::size_t capacity)
+        {
+            if (Empty() && capacity > 0 && (first_ == nullptr || first_->capacity < capacity))
+            {
+                Release();
+                AllocNextChunk(capacity);
+            }
+        }
+
         // Deletes all memory chunks.
         void Release()
         {
@@ -235,6 +346,18 @@ class VirtualCommandBuffer
             return reinterpret_cast<TCommand*>(data + sizeof(opcode));
         }
 
+        // Returns a raw pointer to the data at the specified offset (in bytes), or null if the offset is out of bounds. Offsets from Size() remain valid after Pack().
+        char* DataAt(std::size_t offset)
+        {
+            for (Chunk* c = first_; c != nullptr; c = c->next)
+            {
+                if (offset < c->size)
+                    return VirtualCommandBuffer::GetChunkData(c) + offset;
+                offset -= c->size;
+            }
+            return nullptr;
+        }
+
     public:
 
         // STL compatible function to return the constant iterator to the first memory chunk.
@@ -266,9 +389,10 @@ class VirtualCommandBuffer
         // Allocates a new memory chunk of the specified capacity plus sizeof(Chunk).
         static Chunk* AllocChunk(std::size_t capacity, Chunk* next = nullptr)
         {
-            Chunk* chunk = reinterpret_cast<Chunk*>(::new std::uint8_t[sizeof(Chunk) + capacity]);
+            std::size_t blockSize = sizeof(Chunk) + capacity;
+            Chunk* chunk = reinterpret_cast<Chunk*>(TChunkAllocPolicy::Allocate(blockSize));
             {
-                chunk->capacity = capacity;
+                chunk->capacity = blockSize - sizeof(Chunk);
                 chunk->size     = 0;
                 chunk->next     = next;
             }
@@ -279,10 +403,7 @@ class VirtualCommandBuffer
         static void FreeChunk(Chunk* chunk)
         {
             if (chunk != nullptr)
-            {
-                std::uint8_t* buf = reinterpret_cast<std::uint8_t*>(chunk);
-                delete [] buf;
-            }
+                TChunkAllocPolicy::Free(chunk, sizeof(Chunk) + chunk->capacity);
         }
 
         // Returns a raw pointer to the beginning of the chunk data.
@@ -310,8 +431,8 @@ class VirtualCommandBuffer
         {
             current_->next = VirtualCommandBuffer::AllocChunk(capacity, next);
             current_ = current_->next;
-            capacity_ += capacity;
-            if (biggest_ == nullptr || capacity > biggest_->capacity)
+            capacity_ += current_->capacity;
+            if (biggest_ == nullptr || current_->capacity > biggest_->capacity)
                 biggest_ = current_;
         }
 
@@ -335,6 +456,7 @@ class VirtualCommandBuffer
                         auto secondNext = current_->next->next;
                         if (biggest_ == current_->next)
                             biggest_ = secondNext;
+                        capacity_ -= current_->next->capacity;
                         VirtualCommandBuffer::FreeChunk(current_->next);
                         AllocNextChunkAndMakeCurrent(capacity, secondNext);
                     }
@@ -351,7 +473,7 @@ class VirtualCommandBuffer
                 first_      = VirtualCommandBuffer::AllocChunk(capacity);
                 current_    = first_;
                 biggest_    = first_;
-                capacity_   = capacity;
+                capacity_   = first_->capacity;
             }
         }
 
@@ -372,6 +494,7 @@ class VirtualCommandBuffer
             char* data = VirtualCommandBuffer::GetChunkData(current_) + current_->size;
             current_->size += size;
             size_ += size;
+            highWaterMark_ = std::max(highWaterMark_, size_);
             return data;
         }
 
@@ -429,7 +552,7 @@ class VirtualCommandBuffer
             first_      = chunk;
             current_    = chunk;
             biggest_    = chunk;
-            capacity_   = chunk->size;
+            capacity_   = chunk->capacity;
         }
 
         // Packs the entire virtual command buffer into a new single memory chunk.
@@ -454,7 +577,7 @@ class VirtualCommandBuffer
             first_      = chunk;
             current_    = chunk;
             biggest_    = chunk;
-            capacity_   = chunk->size;
+            capacity_   = chunk->capacity;
         }
 
     private:
@@ -464,6 +587,7 @@ class VirtualCommandBuffer
         Chunk*      biggest_            = nullptr; // Keep track of biggest chunk for packing
         std::size_t capacity_           = 0;
         std::size_t size_               = 0;
+        std::size_t highWaterMark_      = 0;
         std::size_t initialCapacity_    = TGrowPolicy::MinChunkCapacity();
 
 };
@@ -11,7 +11,10 @@
 #include "../VKDevice.h"
 #include "../Ext/VKExtensions.h"
 #include "../Ext/VKExtensionRegistry.h"
+#include "../Memory/VKDeviceMemoryManager.h"
+#include "../Memory/VKExternalMemory.h"
 #include "../../ResourceUtils.h"
+#include "../../../Core/Helper.h"
 
 
 namespace LLGL
@@ -53,27 +56,102 @@ static VkBufferUsageFlags GetVkBufferUsageFlags(const BufferDescriptor& desc)
     return flags;
 }
 
-VKBuffer::VKBuffer(const VKPtr<VkDevice>& device, const BufferDescriptor& desc) :
+VKBuffer::VKBuffer(const VKPtr<VkDevice>& device, const BufferDescriptor& desc, const VKSharedQueueFamilies& sharedQueueFamilies) :
     Buffer            { desc.bindFlags },
     bufferObj_        { device         },
     bufferObjStaging_ { device         },
     size_             { desc.size      }
 {
-    if ((desc.bindFlags & BindFlags::IndexBuffer) != 0)
-        indexType_ = VKTypes::ToVkIndexType(desc.format);
+    const bool shared = ((desc.miscFlags & MiscFlags::Shared) != 0);
+    CreateBuffer(device, desc, sharedQueueFamilies, (shared ? VKGetExportMemoryHandleType() : 0));
+}
 
-    VkBufferCreateInfo createInfo;
+VKBuffer::VKBuffer(
+    const VKPtr<VkDevice>&          device,
+    VKDeviceMemoryManager&          deviceMemoryMngr,
+    const BufferDescriptor&         desc,
+    const NativeResourceHandle&     nativeHandle,
+    const VKSharedQueueFamilies&    sharedQueueFamilies)
+:
+    Buffer            { desc.bindFlags },
+    bufferObj_        { device         },
+    bufferObjStaging_ { device         },
+    size_             { desc.size      }
+{
+    if (nativeHandle.type == NativeHandleType::VkBuffer)
     {
-        createInfo.sType                    = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        createInfo.pNext                    = nullptr;
-        createInfo.flags                    = 0;
-        createInfo.size                     = desc.size;
-        createInfo.usage                    = GetVkBufferUsageFlags(desc);
-        createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
-        createInfo.queueFamilyIndexCount    = 0;
-        createInfo.pQueueFamilyIndices      = nullptr;
+        /* Take native buffer without ownership; its memory is managed by the client */
+        if ((desc.bindFlags & BindFlags::IndexBuffer) != 0)
+            indexType_ = VKTypes::ToVkIndexType(desc.format);
+        bufferObj_.AttachVkBuffer(device, VKHandleFromUInt64<VkBuffer>(nativeHandle.object));
+        ownsBuffer_ = false;
     }
-    bufferObj_.CreateVkBuffer(device, createInfo);
+    else
+    {
+        const auto handleTypes = VKGetImportMemoryHandleType(nativeHandle.type);
+        if (handleTypes == 0)
+            throw std::invalid_argument("cannot import Vulkan buffer from unsupported native handle type");
+
+        /* Create Vulkan buffer that is bound to the imported device memory */
+        CreateBuffer(device, desc, sharedQueueFamilies, handleTypes);
+
+        const auto& requirements = bufferObj_.GetRequirements();
+        externalMemory_ = MakeUnique<VKExternalMemory>(device);
+        externalMemory_->ImportAndBind(
+            nativeHandle,
+            requirements,
+            deviceMemoryMngr.FindMemoryType(requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
+            VK_NULL_HANDLE,
+            GetVkBuffer()
+        );
+    }
+}
+
+VKBuffer::~VKBuffer()
+{
+    /* Don't destroy native buffer that was imported */
+    if (!ownsBuffer_)
+        bufferObj_.DetachVkBuffer();
+}
+
+void VKBuffer::AllocateExternalMemory(const VKPtr<VkDevice>& device, VKDeviceMemoryManager& deviceMemoryMngr)
+{
+    const auto& requirements = bufferObj_.GetRequirements();
+    externalMemory_ = MakeUnique<VKExternalMemory>(device);
+    externalMemory_->AllocateAndBind(
+        requirements,
+        deviceMemoryMngr.FindMemoryType(requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
+        VK_NULL_HANDLE,
+        GetVkBuffer()
+    );
+}
+
+void VKBuffer::GetNativeHandle(NativeResourceHandle& outHandle) const
+{
+    outHandle.type          = NativeHandleType::VkBuffer;
+    outHandle.object        = VKHandleToUInt64(GetVkBuffer());
+    outHandle.memory        = 0;
+    outHandle.memoryOffset  = 0;
+    outHandle.memorySize    = 0;
+
+    if (externalMemory_)
+    {
+        outHandle.memory        = VKHandleToUInt64(externalMemory_->GetVkDeviceMemory());
+        outHandle.memorySize    = externalMemory_->GetSize();
+    }
+    else if (auto region = bufferObj_.GetMemoryRegion())
+    {
+        outHandle.memory        = VKHandleToUInt64(region->GetParentChunk()->GetVkDeviceMemory());
+        outHandle.memoryOffset  = region->GetOffset();
+        outHandle.memorySize    = region->GetSize();
+    }
+}
+
+bool VKBuffer::ExportMemory(NativeHandleType handleType, NativeResourceHandle& outHandle) const
+{
+    if (ownsBuffer_ && externalMemory_)
+        return externalMemory_->Export(handleType, outHandle);
+    return false;
 }
 
 BufferDescriptor VKBuffer::GetDesc() const
@@ -90,18 +168,32 @@ BufferDescriptor VKBuffer::GetDesc() const
     return bufferDesc;
 }
 
-void VKBuffer::BindMemoryRegion(VkDevice device, VKDeviceMemoryRegion* memoryRegion)
+void VKBuffer::BindMemoryRegion(VkDevice device, VKDeviceMemoryRegion* memoryRegion, bool hostVisible)
 {
     bufferObj_.BindMemoryRegion(device, memoryRegion);
+    hostVisible_ = hostVisible;
 }
 
 void VKBuffer::TakeStagingBuffer(VKDeviceBuffer&& deviceBuffer)
 {
     bufferObjStaging_ = std::move(deviceBuffer);
+
+    /* Staging buffers are only accessed by the CPU and synchronous copy commands, so they can be relocated at any time */
+    bufferObjStaging_.EnableRelocation();
 }
 
 void* VKBuffer::Map(VKDevice& device, const CPUAccess access, VkDeviceSize offset, VkDeviceSize length)
 {
+    if (IsHostVisible())
+    {
+        /* Wait until the GPU no longer uses the buffer, unless the client guarantees that the mapped range is not in flight */
+        if (access != CPUAccess::WriteUnsynchronized)
+            device.WaitIdle();
+
+        /* Map primary buffer in host-visible device memory directly */
+        return bufferObj_.Map(device, offset, length);
+    }
+
     if (auto stagingBuffer = GetStagingVkBuffer())
     {
         /* Copy GPU local buffer into staging buffer for read accces */
@@ -122,7 +214,12 @@ void* VKBuffer::Map(VKDevice& device, const CPUAccess access, VkDeviceSize offse
 
 void VKBuffer::Unmap(VKDevice& device)
 {
-    if (auto stagingBuffer = GetStagingVkBuffer())
+    if (IsHostVisible())
+    {
+        /* Host-coherent memory does not need to be flushed */
+        bufferObj_.Unmap(device);
+    }
+    else if (auto stagingBuffer = GetStagingVkBuffer())
     {
         /* Unmap staging buffer */
         bufferObjStaging_.Unmap(device);
@@ -140,6 +237,54 @@ void VKBuffer::Unmap(VKDevice& device)
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+void VKBuffer::CreateBuffer(
+    const VKPtr<VkDevice>&          device,
+    const BufferDescriptor&         desc,
+    const VKSharedQueueFamilies&    sharedQueueFamilies,
+    VkExternalMemoryHandleTypeFlags externalHandleTypes)
+{
+    if ((desc.bindFlags & BindFlags::IndexBuffer) != 0)
+        indexType_ = VKTypes::ToVkIndexType(desc.format);
+
+    VkBufferCreateInfo createInfo;
+    {
+        createInfo.sType                    = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        createInfo.pNext                    = nullptr;
+        createInfo.flags                    = 0;
+        createInfo.size                     = desc.size;
+        createInfo.usage                    = GetVkBufferUsageFlags(desc);
+        if (sharedQueueFamilies.count > 1)
+        {
+            createInfo.sharingMode              = VK_SHARING_MODE_CONCURRENT;
+            createInfo.queueFamilyIndexCount    = sharedQueueFamilies.count;
+            createInfo.pQueueFamilyIndices      = sharedQueueFamilies.indices;
+        }
+        else
+        {
+            createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
+            createInfo.queueFamilyIndexCount    = 0;
+            createInfo.pQueueFamilyIndices      = nullptr;
+        }
+    }
+
+    /* Chain external memory info if the buffer is bound to shared memory */
+    VkExternalMemoryBufferCreateInfo externalInfo;
+    if (externalHandleTypes != 0)
+    {
+        externalInfo.sType          = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO;
+        externalInfo.pNext          = nullptr;
+        externalInfo.handleTypes    = externalHandleTypes;
+        createInfo.pNext            = &externalInfo;
+    }
+
+    bufferObj_.CreateVkBuffer(device, createInfo);
+}
+
+
 } // /namespace LLGL
 
 
@@ -12,6 +12,8 @@
 #include <LLGL/Buffer.h>
 #include "VKDeviceBuffer.h"
 #include "../Memory/VKDeviceMemory.h"
+#include "../VKCore.h"
+#include <memory>
 
 
 namespace LLGL
@@ -19,6 +21,8 @@ namespace LLGL
 
 
 class VKDevice;
+class VKDeviceMemoryManager;
+class VKExternalMemory;
 
 class VKBuffer : public Buffer
 {
@@ -29,9 +33,30 @@ class VKBuffer : public Buffer
 
     public:
 
-        VKBuffer(const VKPtr<VkDevice>& device, const BufferDescriptor& desc);
+        VKBuffer(const VKPtr<VkDevice>& device, const BufferDescriptor& desc, const VKSharedQueueFamilies& sharedQueueFamilies = {});
 
-        void BindMemoryRegion(VkDevice device, VKDeviceMemoryRegion* memoryRegion);
+        // Imports a native VkBuffer (without ownership) or the device memory of a shared handle.
+        VKBuffer(
+            const VKPtr<VkDevice>&          device,
+            VKDeviceMemoryManager&          deviceMemoryMngr,
+            const BufferDescriptor&         desc,
+            const NativeResourceHandle&     nativeHandle,
+            const VKSharedQueueFamilies&    sharedQueueFamilies = {}
+        );
+
+        ~VKBuffer();
+
+        // Allocates dedicated device memory that can be exported. Only used for buffers with the MiscFlags::Shared flag.
+        void AllocateExternalMemory(const VKPtr<VkDevice>& device, VKDeviceMemoryManager& deviceMemoryMngr);
+
+        // Returns the native VkBuffer and its device memory.
+        void GetNativeHandle(NativeResourceHandle& outHandle) const;
+
+        // Exports a shared handle of the device memory. Returns false if this buffer was not created with the MiscFlags::Shared flag.
+        bool ExportMemory(NativeHandleType handleType, NativeResourceHandle& outHandle) const;
+
+        // Binds the memory region to this buffer. If 'hostVisible' is true, the memory region is mapped directly instead of a staging buffer.
+        void BindMemoryRegion(VkDevice device, VKDeviceMemoryRegion* memoryRegion, bool hostVisible = false);
         void TakeStagingBuffer(VKDeviceBuffer&& deviceBuffer);
 
         void* Map(VKDevice& device, const CPUAccess access, VkDeviceSize offset, VkDeviceSize length);
@@ -79,12 +104,27 @@ class VKBuffer : public Buffer
             return size_;
         }
 
+        // Returns true if the primary buffer resides in host-visible device memory and can be written without a staging buffer.
+        inline bool IsHostVisible() const
+        {
+            return hostVisible_;
+        }
+
         // Returns the VkIndexType specified at creation time.
         inline VkIndexType GetIndexType() const
         {
             return indexType_;
         }
 
+    private:
+
+        void CreateBuffer(
+            const VKPtr<VkDevice>&          device,
+            const BufferDescriptor&         desc,
+            const VKSharedQueueFamilies&    sharedQueueFamilies,
+            VkExternalMemoryHandleTypeFlags externalHandleTypes
+        );
+
     private:
 
         VKDeviceBuffer  bufferObj_;
@@ -92,9 +132,14 @@ class VKBuffer : public Buffer
 
         VkDeviceSize    size_                   = 0;
         VkDeviceSize    mappedWriteRange_[2]    = { 0, 0 };
+        bool            hostVisible_            = false;
 
         VkIndexType     indexType_              = VK_INDEX_TYPE_MAX_ENUM;
 
+        /* External memory (only used if this buffer was created with MiscFlags::Shared or imported from a native handle) */
+        std::unique_ptr<VKExternalMemory>   externalMemory_;
+        bool                                ownsBuffer_     = true;     // False if a native VkBuffer was imported.
+
 };
 
 
@@ -16,17 +16,17 @@ namespace LLGL
 {
 
 
-VKBufferArray::VKBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray) :
+VKBufferArray::VKBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets) :
     BufferArray { GetCombinedBindFlags(numBuffers, bufferArray) }
 {
-    /* Store the object of each VKBuffer inside the array and  */
+    /* Store the object and offset of each VKBuffer inside the arrays */
     buffers_.reserve(numBuffers);
     offsets_.reserve(numBuffers);
 
-    while (auto next = NextArrayResource<VKBuffer>(numBuffers, bufferArray))
+    for (std::size_t i = 0; auto next = NextArrayResource<VKBuffer>(numBuffers, bufferArray); ++i)
     {
         buffers_.push_back(next->GetVkBuffer());
-        offsets_.push_back(0);//next->GetOffset()
+        offsets_.push_back(offsets != nullptr ? static_cast<VkDeviceSize>(offsets[i]) : 0);
     }
 }
 
@@ -26,7 +26,7 @@ class VKBufferArray final : public BufferArray
 
     public:
 
-        VKBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray);
+        VKBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets = nullptr);
 
         // Returns the array of buffer objects.
         inline const std::vector<VkBuffer>& GetBuffers() const
@@ -9,6 +9,7 @@
 #include "../Memory/VKDeviceMemoryManager.h"
 #include "../VKCore.h"
 #include <algorithm>
+#include <cstring>
 
 
 namespace LLGL
@@ -42,9 +43,11 @@ VKDeviceBuffer::VKDeviceBuffer(
 VKDeviceBuffer::VKDeviceBuffer(VKDeviceBuffer&& rhs) :
     buffer_       { std::move(rhs.buffer_) },
     requirements_ { rhs.requirements_      },
-    memoryRegion_ { rhs.memoryRegion_      }
+    memoryRegion_ { rhs.memoryRegion_      },
+    createInfo_   { rhs.createInfo_        }
 {
     rhs.memoryRegion_ = nullptr;
+    UpdateRelocatableOwner(rhs);
 }
 
 VKDeviceBuffer& VKDeviceBuffer::operator = (VKDeviceBuffer&& rhs)
@@ -52,7 +55,9 @@ VKDeviceBuffer& VKDeviceBuffer::operator = (VKDeviceBuffer&& rhs)
     buffer_             = std::move(rhs.buffer_);
     requirements_       = rhs.requirements_;
     memoryRegion_       = rhs.memoryRegion_;
+    createInfo_         = rhs.createInfo_;
     rhs.memoryRegion_   = nullptr;
+    UpdateRelocatableOwner(rhs);
     return *this;
 }
 
@@ -64,6 +69,12 @@ void VKDeviceBuffer::CreateVkBuffer(const VKPtr<VkDevice>& device, const VkBuffe
     auto result = vkCreateBuffer(device, &createInfo, nullptr, buffer_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan buffer");
     vkGetBufferMemoryRequirements(device, buffer_, &requirements_);
+
+    /* Store create info for relocation, but without extension and queue family chains */
+    createInfo_                         = createInfo;
+    createInfo_.pNext                   = nullptr;
+    createInfo_.queueFamilyIndexCount   = 0;
+    createInfo_.pQueueFamilyIndices     = nullptr;
 }
 
 void VKDeviceBuffer::CreateVkBufferAndMemoryRegion(
@@ -95,6 +106,17 @@ void VKDeviceBuffer::ReleaseVkBuffer()
     buffer_.Release();
 }
 
+void VKDeviceBuffer::AttachVkBuffer(VkDevice device, VkBuffer buffer)
+{
+    buffer_ = buffer;
+    vkGetBufferMemoryRequirements(device, buffer_, &requirements_);
+}
+
+VkBuffer VKDeviceBuffer::DetachVkBuffer()
+{
+    return buffer_.Detach();
+}
+
 void VKDeviceBuffer::BindMemoryRegion(VkDevice device, VKDeviceMemoryRegion* memoryRegion)
 {
     if (memoryRegion)
@@ -110,6 +132,37 @@ void VKDeviceBuffer::ReleaseMemoryRegion(VKDeviceMemoryManager& deviceMemoryMngr
     memoryRegion_ = nullptr;
 }
 
+void VKDeviceBuffer::EnableRelocation()
+{
+    if (memoryRegion_ != nullptr && createInfo_.sharingMode == VK_SHARING_MODE_EXCLUSIVE)
+        memoryRegion_->SetRelocatableOwner(this);
+}
+
+void VKDeviceBuffer::RelocateMemoryRegion(const VKPtr<VkDevice>& device, VKDeviceMemoryRegion* memoryRegion)
+{
+    /* Create new Vulkan buffer object with the same parameters and bind it to the new memory region */
+    VKPtr<VkBuffer> buffer{ device, vkDestroyBuffer };
+    auto result = vkCreateBuffer(device, &createInfo_, nullptr, buffer.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan buffer for relocation");
+    memoryRegion->BindBuffer(device, buffer);
+
+    /* Copy content from previous to new memory region */
+    const auto size = memoryRegion_->GetSize();
+
+    auto srcData = memoryRegion_->GetParentChunk()->Map(device, memoryRegion_->GetOffset(), size);
+    auto dstData = memoryRegion->GetParentChunk()->Map(device, memoryRegion->GetOffset(), size);
+    {
+        ::memcpy(dstData, srcData, static_cast<std::size_t>(size));
+    }
+    memoryRegion->GetParentChunk()->Unmap(device);
+    memoryRegion_->GetParentChunk()->Unmap(device);
+
+    /* Replace native buffer; the previous memory region is released by the device memory manager */
+    buffer_         = std::move(buffer);
+    memoryRegion_   = memoryRegion;
+    memoryRegion_->SetRelocatableOwner(this);
+}
+
 void* VKDeviceBuffer::Map(VkDevice device, VkDeviceSize offset, VkDeviceSize size)
 {
     if (memoryRegion_)
@@ -128,6 +181,18 @@ void VKDeviceBuffer::Unmap(VkDevice device)
 }
 
 
+
+/*
+ * ======= Private: =======
+ */
+
+void VKDeviceBuffer::UpdateRelocatableOwner(const VKDeviceBuffer& prevOwner)
+{
+    if (memoryRegion_ != nullptr && memoryRegion_->GetRelocatableOwner() == &prevOwner)
+        memoryRegion_->SetRelocatableOwner(this);
+}
+
+
 } // /namespace LLGL
 
 
@@ -61,11 +61,23 @@ class VKDeviceBuffer
 
         void ReleaseVkBuffer();
 
+        // Takes the specified native buffer without owning it; it must be detached before this wrapper is destroyed.
+        void AttachVkBuffer(VkDevice device, VkBuffer buffer);
+
+        // Releases the ownership of the native buffer without destroying it.
+        VkBuffer DetachVkBuffer();
+
         //TODO: remove this and bind the buffer to device memory in "CreateVkBuffer".
         void BindMemoryRegion(VkDevice device, VKDeviceMemoryRegion* memoryRegion);
 
         void ReleaseMemoryRegion(VKDeviceMemoryManager& deviceMemoryMngr);
 
+        // Allows the device memory manager to relocate this buffer into another memory region during defragmentation.
+        void EnableRelocation();
+
+        // Re-creates the native buffer within the specified memory region and copies the content of the current region. Only supported for host-coherent memory.
+        void RelocateMemoryRegion(const VKPtr<VkDevice>& device, VKDeviceMemoryRegion* memoryRegion);
+
         void* Map(VkDevice device, VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE);
         void Unmap(VkDevice device);
 
@@ -89,11 +101,17 @@ class VKDeviceBuffer
             return memoryRegion_;
         }
 
+    private:
+
+        // Updates the relocatable owner of the memory region after this buffer has been moved.
+        void UpdateRelocatableOwner(const VKDeviceBuffer& prevOwner);
+
     private:
 
         VKPtr<VkBuffer>         buffer_;
         VkMemoryRequirements    requirements_;
         VKDeviceMemoryRegion*   memoryRegion_   = nullptr;
+        VkBufferCreateInfo      createInfo_     = {};
 
 };
 
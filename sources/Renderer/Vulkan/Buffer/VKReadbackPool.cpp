@@ -0,0 +1,236 @@
+/*
+ * VKReadbackPool.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKReadbackPool.h"
+#include "../Memory/VKDeviceMemoryManager.h"
+#include "../../../Core/Helper.h"
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+// Value the GPU writes into the completion marker of a readback buffer
+static const std::uint32_t g_readbackMarkerValue = 1;
+
+VKReadbackPool::ReadbackEntry::ReadbackEntry(VKDeviceBuffer&& buffer) :
+    buffer { std::move(buffer) }
+{
+}
+
+VKReadbackPool::VKReadbackPool(const VKPtr<VkDevice>& device, VKDeviceMemoryManager& deviceMemoryMngr) :
+    device_           { device           },
+    deviceMemoryMngr_ { deviceMemoryMngr }
+{
+}
+
+VKReadbackPool::~VKReadbackPool()
+{
+    for (auto& entry : entries_)
+    {
+        if (!entry.second.completed)
+            ReleaseEntry(entry.second);
+    }
+}
+
+std::uint64_t VKReadbackPool::Allocate(const ReadbackLayout& layout, VkBuffer& outBuffer)
+{
+    /* Append completion marker to the 4-byte aligned payload, since vkCmdFillBuffer requires an aligned offset */
+    const VkDeviceSize markerOffset = GetAlignedSize<VkDeviceSize>(layout.size, sizeof(std::uint32_t));
+
+    VkBufferCreateInfo createInfo;
+    {
+        createInfo.sType                    = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        createInfo.pNext                    = nullptr;
+        createInfo.flags                    = 0;
+        createInfo.size                     = markerOffset + sizeof(std::uint32_t);
+        createInfo.usage                    = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
+        createInfo.queueFamilyIndexCount    = 0;
+        createInfo.pQueueFamilyIndices      = nullptr;
+    }
+    VKDeviceBuffer buffer
+    {
+        device_,
+        createInfo,
+        deviceMemoryMngr_,
+        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+    };
+
+    /* Clear completion marker, so the CPU can detect when the GPU has written it */
+    if (auto mappedData = buffer.Map(device_, markerOffset, sizeof(std::uint32_t)))
+    {
+        ::memset(mappedData, 0, sizeof(std::uint32_t));
+        buffer.Unmap(device_);
+    }
+
+    outBuffer = buffer.GetVkBuffer();
+
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    ReleaseDiscardedEntries();
+
+    const auto ticket = nextTicket_++;
+    auto& entry = entries_.emplace(ticket, ReadbackEntry{ std::move(buffer) }).first->second;
+    {
+        entry.markerOffset  = markerOffset;
+        entry.layout        = layout;
+    }
+    return ticket;
+}
+
+void VKReadbackPool::RecordCompletion(VkCommandBuffer commandBuffer, std::uint64_t ticket)
+{
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkDeviceSize markerOffset = 0;
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        auto it = entries_.find(ticket);
+        if (it == entries_.end())
+            return;
+        buffer          = it->second.buffer.GetVkBuffer();
+        markerOffset    = it->second.markerOffset;
+    }
+
+    /* Write completion marker after the payload has been copied */
+    VkMemoryBarrier barrier;
+    {
+        barrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.pNext           = nullptr;
+        barrier.srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+    }
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0,
+        1, &barrier,
+        0, nullptr,
+        0, nullptr
+    );
+
+    vkCmdFillBuffer(commandBuffer, buffer, markerOffset, sizeof(std::uint32_t), g_readbackMarkerValue);
+
+    /* Make payload and completion marker visible to the host */
+    {
+        barrier.dstAccessMask   = VK_ACCESS_HOST_READ_BIT;
+    }
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_HOST_BIT,
+        0,
+        1, &barrier,
+        0, nullptr,
+        0, nullptr
+    );
+}
+
+const void* VKReadbackPool::Map(std::uint64_t ticket, ReadbackLayout* outLayout)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    auto it = entries_.find(ticket);
+    if (it == entries_.end() || it->second.discarded)
+        return nullptr;
+
+    auto& entry = it->second;
+
+    /* Never wait for the GPU; the client polls this function until the copy has been completed */
+    if (!IsCompleted(entry))
+        return nullptr;
+
+    if (outLayout != nullptr)
+        *outLayout = entry.layout;
+
+    return entry.data.data();
+}
+
+void VKReadbackPool::Unmap(std::uint64_t ticket)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    auto it = entries_.find(ticket);
+    if (it == entries_.end() || it->second.discarded)
+        return;
+
+    auto& entry = it->second;
+    if (IsCompleted(entry))
+        entries_.erase(it);
+    else
+    {
+        /* Keep buffer alive until the GPU has completed the copy */
+        entry.discarded = true;
+        ++numDiscarded_;
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool VKReadbackPool::IsCompleted(ReadbackEntry& entry)
+{
+    if (entry.completed)
+        return true;
+
+    /* Map entire buffer and check whether the GPU has written the completion marker */
+    auto mappedData = reinterpret_cast<const char*>(entry.buffer.Map(device_));
+    if (mappedData == nullptr)
+        return false;
+
+    std::uint32_t marker = 0;
+    ::memcpy(&marker, mappedData + entry.markerOffset, sizeof(marker));
+
+    if (marker == g_readbackMarkerValue)
+    {
+        /* Copy payload into CPU memory, so the buffer can be released before the client unmaps the readback */
+        if (!entry.discarded)
+            entry.data.assign(mappedData, mappedData + entry.layout.size);
+        entry.completed = true;
+    }
+
+    entry.buffer.Unmap(device_);
+
+    if (entry.completed)
+        ReleaseEntry(entry);
+
+    return entry.completed;
+}
+
+void VKReadbackPool::ReleaseDiscardedEntries()
+{
+    if (numDiscarded_ == 0)
+        return;
+
+    for (auto it = entries_.begin(); it != entries_.end();)
+    {
+        if (it->second.discarded && IsCompleted(it->second))
+        {
+            it = entries_.erase(it);
+            --numDiscarded_;
+        }
+        else
+            ++it;
+    }
+}
+
+void VKReadbackPool::ReleaseEntry(ReadbackEntry& entry)
+{
+    entry.buffer.ReleaseMemoryRegion(deviceMemoryMngr_);
+    entry.buffer.ReleaseVkBuffer();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,107 @@
+/*
+ * VKReadbackPool.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_READBACK_POOL_H
+#define LLGL_VK_READBACK_POOL_H
+
+
+#include <LLGL/RenderSystemFlags.h>
+#include "../Vulkan.h"
+#include "../VKPtr.h"
+#include "VKDeviceBuffer.h"
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class VKDeviceMemoryManager;
+
+/*
+Device-wide container of the host-visible buffers of asynchronous buffer and texture copies (see CommandBuffer::CopyBufferToReadback).
+Command buffers can be submitted any number of times and in any order, so a readback cannot be tied to a single submission fence.
+Instead, each buffer ends with a completion marker that is cleared by the CPU and filled by the GPU after the copy,
+so the readback can be mapped without waiting for the GPU once the marker has been written.
+Buffers share their device memory chunks with other resources, which cannot be mapped more than once at a time,
+so the payload of a completed readback is copied into CPU memory and the buffer is released immediately.
+Command buffers of multiple threads allocate their readbacks, so all functions are guarded by a mutex.
+*/
+class VKReadbackPool
+{
+
+    public:
+
+        VKReadbackPool(const VKPtr<VkDevice>& device, VKDeviceMemoryManager& deviceMemoryMngr);
+        ~VKReadbackPool();
+
+        VKReadbackPool(const VKReadbackPool&) = delete;
+        VKReadbackPool& operator = (const VKReadbackPool&) = delete;
+
+        /*
+        Creates a new readback buffer with the specified layout and returns its ticket.
+        The copy into the returned buffer must be recorded before RecordCompletion() is called for the same ticket.
+        */
+        std::uint64_t Allocate(const ReadbackLayout& layout, VkBuffer& outBuffer);
+
+        // Records the commands that write the completion marker of the specified readback after the preceding copy commands.
+        void RecordCompletion(VkCommandBuffer commandBuffer, std::uint64_t ticket);
+
+        // Maps the specified readback if its completion marker has been written, or returns null otherwise.
+        const void* Map(std::uint64_t ticket, ReadbackLayout* outLayout);
+
+        // Releases the specified readback. Readbacks that are still in flight are released once they have been completed.
+        void Unmap(std::uint64_t ticket);
+
+    private:
+
+        struct ReadbackEntry
+        {
+            ReadbackEntry(VKDeviceBuffer&& buffer);
+
+            VKDeviceBuffer      buffer;
+            VkDeviceSize        markerOffset    = 0;
+            ReadbackLayout      layout;
+            std::vector<char>   data;                   // Payload of the completed readback
+            bool                completed       = false;
+            bool                discarded       = false;
+        };
+
+    private:
+
+        // Returns true if the GPU has written the completion marker of the specified entry and copies its payload into CPU memory.
+        bool IsCompleted(ReadbackEntry& entry);
+
+        // Releases all discarded entries that have been completed by the GPU.
+        void ReleaseDiscardedEntries();
+
+        void ReleaseEntry(ReadbackEntry& entry);
+
+    private:
+
+        const VKPtr<VkDevice>&                  device_;
+        VKDeviceMemoryManager&                  deviceMemoryMngr_;
+
+        std::map<std::uint64_t, ReadbackEntry>  entries_;
+        std::uint64_t                           nextTicket_     = 1;
+        std::size_t                             numDiscarded_   = 0;
+        std::mutex                              mutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
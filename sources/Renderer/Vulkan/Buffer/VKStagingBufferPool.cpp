@@ -0,0 +1,764 @@
+/*
+ * VKStagingBufferPool.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKStagingBufferPool.h"
+#include "../Memory/VKDeviceMemory.h"
+#include "../Texture/VKTexture.h"
+#include "../VKDevice.h"
+#include "../VKCore.h"
+#include "../../../Core/Helper.h"
+#include "../../../Core/ProfilerZone.h"
+#include <algorithm>
+#include <stdexcept>
+#include <limits.h>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+// Returns the specified offset aligned to the next multiple of 'alignment', which does not need to be a power of two.
+static VkDeviceSize AlignOffset(VkDeviceSize offset, VkDeviceSize alignment)
+{
+    if (alignment > 1)
+        return ((offset + alignment - 1) / alignment) * alignment;
+    return offset;
+}
+
+/*
+Submits the specified command buffer with an optional wait and signal semaphore.
+If 'signalValue' is non-zero, the signal semaphore is a timeline semaphore that is signaled with that value.
+*/
+static VkResult SubmitCommandBuffer(
+    VkQueue                 queue,
+    VkCommandBuffer         commandBuffer,
+    VkSemaphore             waitSemaphore,
+    VkPipelineStageFlags    waitStageMask,
+    VkSemaphore             signalSemaphore,
+    VkFence                 fence,
+    std::uint64_t           signalValue     = 0)
+{
+    VkTimelineSemaphoreSubmitInfoKHR timelineInfo;
+    {
+        timelineInfo.sType                      = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+        timelineInfo.pNext                      = nullptr;
+        timelineInfo.waitSemaphoreValueCount    = 0;
+        timelineInfo.pWaitSemaphoreValues       = nullptr;
+        timelineInfo.signalSemaphoreValueCount  = 1;
+        timelineInfo.pSignalSemaphoreValues     = &signalValue;
+    }
+    VkSubmitInfo submitInfo;
+    {
+        submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.pNext                = (signalValue != 0 ? &timelineInfo : nullptr);
+        submitInfo.waitSemaphoreCount   = (waitSemaphore != VK_NULL_HANDLE ? 1 : 0);
+        submitInfo.pWaitSemaphores      = &waitSemaphore;
+        submitInfo.pWaitDstStageMask    = &waitStageMask;
+        submitInfo.commandBufferCount   = 1;
+        submitInfo.pCommandBuffers      = &commandBuffer;
+        submitInfo.signalSemaphoreCount = (signalSemaphore != VK_NULL_HANDLE ? 1 : 0);
+        submitInfo.pSignalSemaphores    = &signalSemaphore;
+    }
+    return vkQueueSubmit(queue, 1, &submitInfo, fence);
+}
+
+static bool IsEqualSubresource(const TextureSubresource& lhs, const TextureSubresource& rhs)
+{
+    return
+    (
+        lhs.baseArrayLayer  == rhs.baseArrayLayer   &&
+        lhs.numArrayLayers  == rhs.numArrayLayers   &&
+        lhs.baseMipLevel    == rhs.baseMipLevel     &&
+        lhs.numMipLevels    == rhs.numMipLevels
+    );
+}
+
+// Initializes the handles with their deleters, because moving a VKPtr into another one does not move its deleter.
+VKStagingBufferPool::Submission::Submission(const VKPtr<VkDevice>& device) :
+    transferSemaphore { device, vkDestroySemaphore },
+    releaseSemaphore  { device, vkDestroySemaphore },
+    fence             { device, vkDestroyFence     }
+{
+}
+
+VKStagingBufferPool::VKStagingBufferPool(VKDevice& device) :
+    device_              { device                                     },
+    ringBuffer_          { device.GetVkDevice()                       },
+    transferCommandPool_ { device.GetVkDevice(), vkDestroyCommandPool }
+{
+}
+
+void VKStagingBufferPool::InitializeDevice(const VkPhysicalDeviceMemoryProperties& memoryProperties, VkDeviceSize size)
+{
+    /* Use dedicated transfer queue if the device provides one */
+    const auto& queueFamilyIndices = device_.GetQueueFamilyIndices();
+    if (device_.GetVkTransferQueue() != VK_NULL_HANDLE)
+    {
+        transferQueue_          = device_.GetVkTransferQueue();
+        transferFamily_         = queueFamilyIndices.transferFamily;
+        graphicsFamily_         = queueFamilyIndices.graphicsFamily;
+        transferCommandPool_    = device_.CreateCommandPool(transferFamily_);
+    }
+
+    /* Create ring buffer object; it is read by both the graphics and the transfer queue */
+    const std::uint32_t sharedQueueFamilies[] = { graphicsFamily_, transferFamily_ };
+
+    VkBufferCreateInfo createInfo;
+    {
+        createInfo.sType                    = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        createInfo.pNext                    = nullptr;
+        createInfo.flags                    = 0;
+        createInfo.size                     = size;
+        createInfo.usage                    = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        if (HasTransferQueue())
+        {
+            createInfo.sharingMode              = VK_SHARING_MODE_CONCURRENT;
+            createInfo.queueFamilyIndexCount    = 2;
+            createInfo.pQueueFamilyIndices      = sharedQueueFamilies;
+        }
+        else
+        {
+            createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
+            createInfo.queueFamilyIndexCount    = 0;
+            createInfo.pQueueFamilyIndices      = nullptr;
+        }
+    }
+    ringBuffer_.CreateVkBuffer(device_, createInfo);
+
+    /* Allocate dedicated device memory, so it can be mapped persistently without interfering with other buffers */
+    const auto& requirements    = ringBuffer_.GetRequirements();
+    const auto  memoryTypeIndex = VKFindMemoryType(
+        memoryProperties,
+        requirements.memoryTypeBits,
+        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+    );
+
+    deviceMemory_ = MakeUnique<VKDeviceMemory>(device_, requirements.size, memoryTypeIndex);
+    ringBuffer_.BindMemoryRegion(device_, deviceMemory_->Allocate(requirements.size, requirements.alignment));
+
+    /* Map entire ring buffer into CPU memory space */
+    mappedData_ = reinterpret_cast<char*>(ringBuffer_.Map(device_));
+    size_       = size;
+
+    /* Track all submissions with a single timeline fence if supported */
+    if (device_.HasTimelineSemaphores())
+        timelineFence_ = MakeUnique<VKFence>(device_.GetVkDevice(), true);
+}
+
+bool VKStagingBufferPool::Capacity(VkDeviceSize dataSize) const
+{
+    return (mappedData_ != nullptr && dataSize <= size_);
+}
+
+void VKStagingBufferPool::WriteStaged(VkBuffer dstBuffer, VkDeviceSize dstOffset, const void* data, VkDeviceSize dataSize, bool preserveContent)
+{
+    std::lock_guard<std::recursive_mutex> guard{ device_.GetMutex() };
+
+    /* Copy data into ring buffer, then record copy command from ring buffer into destination buffer */
+    const auto srcOffset = Write(data, dataSize, 1);
+
+    if (HasTransferQueue())
+    {
+        AcquireBufferOwnership(dstBuffer, preserveContent);
+        device_.CopyBuffer(GetTransferCommandBuffer(), GetVkBuffer(), dstBuffer, dataSize, srcOffset, dstOffset);
+    }
+    else
+        device_.CopyBuffer(GetCommandBuffer(), GetVkBuffer(), dstBuffer, dataSize, srcOffset, dstOffset);
+}
+
+void VKStagingBufferPool::WriteStagedRegions(VkBuffer dstBuffer, std::uint32_t numRegions, const BufferWriteRegion* regions)
+{
+    std::lock_guard<std::recursive_mutex> guard{ device_.GetMutex() };
+
+    /* Allocate a single range for all regions and gather their data into it */
+    VkDeviceSize totalSize = 0;
+    for (std::uint32_t i = 0; i < numRegions; ++i)
+        totalSize += regions[i].dataSize;
+
+    if (totalSize == 0)
+        return;
+
+    const auto srcOffset = Write(nullptr, totalSize, 1);
+
+    std::vector<VkBufferCopy> copyRegions;
+    copyRegions.reserve(numRegions);
+
+    VkDeviceSize offset = 0;
+    for (std::uint32_t i = 0; i < numRegions; ++i)
+    {
+        if (regions[i].dataSize == 0)
+            continue;
+
+        ::memcpy(mappedData_ + srcOffset + offset, regions[i].data, static_cast<std::size_t>(regions[i].dataSize));
+
+        VkBufferCopy copyRegion;
+        {
+            copyRegion.srcOffset    = srcOffset + offset;
+            copyRegion.dstOffset    = static_cast<VkDeviceSize>(regions[i].dstOffset);
+            copyRegion.size         = static_cast<VkDeviceSize>(regions[i].dataSize);
+        }
+        copyRegions.push_back(copyRegion);
+
+        offset += regions[i].dataSize;
+    }
+
+    /* Record a single copy command with all regions */
+    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+    if (HasTransferQueue())
+    {
+        AcquireBufferOwnership(dstBuffer, true);
+        commandBuffer = GetTransferCommandBuffer();
+    }
+    else
+        commandBuffer = GetCommandBuffer();
+
+    vkCmdCopyBuffer(commandBuffer, GetVkBuffer(), dstBuffer, static_cast<std::uint32_t>(copyRegions.size()), copyRegions.data());
+}
+
+void VKStagingBufferPool::WriteImageStaged(
+    VKTexture&                  dstTexture,
+    const VkOffset3D&           offset,
+    const VkExtent3D&           extent,
+    const TextureSubresource&   subresource,
+    const void*                 data,
+    VkDeviceSize                dataSize,
+    VkDeviceSize                alignment,
+    std::uint32_t               bufferRowLength,
+    std::uint32_t               bufferImageHeight)
+{
+    std::lock_guard<std::recursive_mutex> guard{ device_.GetMutex() };
+
+    const auto srcOffset    = Write(data, dataSize, alignment);
+    const auto image        = dstTexture.GetVkImage();
+    const auto format       = dstTexture.GetVkFormat();
+
+    if (HasTransferQueue())
+    {
+        auto commandBuffer = GetTransferCommandBuffer();
+
+        /* Transition subresource into transfer layout, unless it has already been written in the current batch */
+        auto it = std::find_if(
+            pendingImages_.begin(), pendingImages_.end(),
+            [image, &subresource](const PendingImage& entry)
+            {
+                return (entry.image == image && IsEqualSubresource(entry.subresource, subresource));
+            }
+        );
+
+        VkImageMemoryBarrier barrier;
+        {
+            barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.pNext                           = nullptr;
+            barrier.srcAccessMask                   = 0;
+            barrier.dstAccessMask                   = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.oldLayout                       = VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier.newLayout                       = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image                           = image;
+            barrier.subresourceRange.aspectMask     = dstTexture.GetAspectFlags();
+            barrier.subresourceRange.baseMipLevel   = subresource.baseMipLevel;
+            barrier.subresourceRange.levelCount     = subresource.numMipLevels;
+            barrier.subresourceRange.baseArrayLayer = subresource.baseArrayLayer;
+            barrier.subresourceRange.layerCount     = subresource.numArrayLayers;
+        }
+
+        if (it == pendingImages_.end())
+        {
+            vkCmdPipelineBarrier(
+                commandBuffer,
+                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                0,
+                0, nullptr,
+                0, nullptr,
+                1, &barrier
+            );
+
+            /* Release subresource to the graphics queue family after all copy commands of this batch */
+            barrier.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask       = 0;
+            barrier.oldLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.newLayout           = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            barrier.srcQueueFamilyIndex = transferFamily_;
+            barrier.dstQueueFamilyIndex = graphicsFamily_;
+            imageReleaseBarriers_.push_back(barrier);
+
+            pendingImages_.push_back({ image, subresource });
+        }
+
+        device_.CopyBufferToImage(commandBuffer, GetVkBuffer(), image, format, offset, extent, subresource, srcOffset, bufferRowLength, bufferImageHeight);
+    }
+    else
+    {
+        auto commandBuffer = GetCommandBuffer();
+        device_.TransitionImageLayout(commandBuffer, image, format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, subresource);
+        device_.CopyBufferToImage(commandBuffer, GetVkBuffer(), image, format, offset, extent, subresource, srcOffset, bufferRowLength, bufferImageHeight);
+        device_.TransitionImageLayout(commandBuffer, image, format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, subresource);
+    }
+}
+
+VkDeviceSize VKStagingBufferPool::Write(const void* data, VkDeviceSize dataSize, VkDeviceSize alignment)
+{
+    std::lock_guard<std::recursive_mutex> guard{ device_.GetMutex() };
+
+    const auto offset = AllocRange(dataSize, alignment);
+    if (data != nullptr)
+        ::memcpy(mappedData_ + offset, data, static_cast<std::size_t>(dataSize));
+    return offset;
+}
+
+VkCommandBuffer VKStagingBufferPool::GetCommandBuffer()
+{
+    std::lock_guard<std::recursive_mutex> guard{ device_.GetMutex() };
+
+    if (commandBuffer_ == VK_NULL_HANDLE)
+    {
+        commandBuffer_ = BeginCommandBuffer(unusedCommandBuffers_, device_.GetVkCommandPool());
+
+        /* Wait for all previously submitted commands before any staged copy command overwrites their resources */
+        VkMemoryBarrier barrier;
+        {
+            barrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            barrier.pNext           = nullptr;
+            barrier.srcAccessMask   = (VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT);
+            barrier.dstAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+        }
+        vkCmdPipelineBarrier(
+            commandBuffer_,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0,
+            1, &barrier,
+            0, nullptr,
+            0, nullptr
+        );
+    }
+    return commandBuffer_;
+}
+
+void VKStagingBufferPool::Flush()
+{
+    std::lock_guard<std::recursive_mutex> guard{ device_.GetMutex() };
+
+    if (commandBuffer_ != VK_NULL_HANDLE || transferCommandBuffer_ != VK_NULL_HANDLE)
+    {
+        Submission submission{ device_.GetVkDevice() };
+        submission.end = head_;
+
+        /* Submit copy commands to the transfer queue first, so the graphics queue can acquire the written resources */
+        if (transferCommandBuffer_ != VK_NULL_HANDLE)
+            SubmitTransferCommandBuffer(submission);
+
+        auto commandBuffer = GetCommandBuffer();
+
+        if (!bufferReleaseBarriers_.empty() || !imageReleaseBarriers_.empty())
+        {
+            /* Acquire ownership of all resources that have been released by the transfer queue */
+            for (auto& barrier : bufferReleaseBarriers_)
+            {
+                barrier.srcAccessMask = 0;
+                barrier.dstAccessMask = (VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT);
+            }
+            for (auto& barrier : imageReleaseBarriers_)
+            {
+                barrier.srcAccessMask = 0;
+                barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            }
+            vkCmdPipelineBarrier(
+                commandBuffer,
+                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                0,
+                0, nullptr,
+                static_cast<std::uint32_t>(bufferReleaseBarriers_.size()), bufferReleaseBarriers_.data(),
+                static_cast<std::uint32_t>(imageReleaseBarriers_.size()), imageReleaseBarriers_.data()
+            );
+            bufferReleaseBarriers_.clear();
+            imageReleaseBarriers_.clear();
+        }
+
+        /* Make all staged writes visible to subsequently submitted commands */
+        VkMemoryBarrier barrier;
+        {
+            barrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            barrier.pNext           = nullptr;
+            barrier.srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask   = (VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT);
+        }
+        vkCmdPipelineBarrier(
+            commandBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            0,
+            1, &barrier,
+            0, nullptr,
+            0, nullptr
+        );
+
+        auto result = vkEndCommandBuffer(commandBuffer);
+        VKThrowIfFailed(result, "failed to end recording Vulkan staging command buffer");
+
+        /* Submit pending command buffer with a fence (or timeline value) that guards the ring buffer range written so far */
+        submission.commandBuffer    = commandBuffer;
+
+        if (timelineFence_)
+        {
+            submission.timelineValue = timelineFence_->NextTimelineValue();
+            result = SubmitCommandBuffer(
+                device_.GetVkQueue(),
+                commandBuffer,
+                submission.transferSemaphore,
+                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                timelineFence_->GetVkSemaphore(),
+                VK_NULL_HANDLE,
+                submission.timelineValue
+            );
+        }
+        else
+        {
+            submission.fence = AcquireFence();
+            result = SubmitCommandBuffer(
+                device_.GetVkQueue(),
+                commandBuffer,
+                submission.transferSemaphore,
+                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                VK_NULL_HANDLE,
+                submission.fence
+            );
+        }
+        VKThrowIfFailed(result, "failed to submit Vulkan staging command buffer");
+
+        submissions_.push_back(std::move(submission));
+        commandBuffer_ = VK_NULL_HANDLE;
+    }
+
+    /* Recycle resources of completed submissions */
+    RetireSubmissions(false);
+}
+
+void VKStagingBufferPool::Wait()
+{
+    std::lock_guard<std::recursive_mutex> guard{ device_.GetMutex() };
+
+    Flush();
+    while (!submissions_.empty())
+        RetireSubmissions(true);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+VkDeviceSize VKStagingBufferPool::AllocRange(VkDeviceSize dataSize, VkDeviceSize alignment)
+{
+    LLGL_PROFILER_ZONE("VKStagingBufferPool::AllocRange");
+
+    for (;;)
+    {
+        /* Determine aligned start position; wrap around to the beginning if the range does not fit into the remaining space */
+        const auto base     = head_ - (head_ % size_);
+        auto       offset   = AlignOffset(head_ - base, alignment);
+
+        if (offset + dataSize > size_)
+            offset = size_;
+
+        const auto start    = base + offset;
+        const auto end      = start + dataSize;
+
+        /* Check if range does not overlap with ranges that are still in use */
+        if (end - tail_ <= size_)
+        {
+            head_ = end;
+            return (start % size_);
+        }
+
+        /* Submit pending commands, so their range can be retired */
+        Flush();
+
+        if (submissions_.empty())
+        {
+            /* Ring buffer is entirely unused, so start over at the beginning */
+            head_ = 0;
+            tail_ = 0;
+        }
+        else
+            RetireSubmissions(true);
+    }
+}
+
+void VKStagingBufferPool::RetireSubmissions(bool waitForOldest)
+{
+    VkDevice device = device_;
+
+    if (waitForOldest && !submissions_.empty())
+    {
+        if (timelineFence_)
+        {
+            if (!timelineFence_->WaitValue(submissions_.front().timelineValue, ULLONG_MAX))
+                throw std::runtime_error("failed to wait for Vulkan staging timeline semaphore");
+        }
+        else
+        {
+            auto result = vkWaitForFences(device, 1, &(submissions_.front().fence), VK_TRUE, ULLONG_MAX);
+            VKThrowIfFailed(result, "failed to wait for Vulkan staging fence");
+        }
+    }
+
+    /* Query the timeline value only once for all submissions */
+    const std::uint64_t completedTimelineValue = (timelineFence_ ? timelineFence_->GetCompletedValue() : 0);
+
+    /* Retire submissions in the order they were submitted */
+    std::size_t numRetired = 0;
+    while (numRetired < submissions_.size() && IsSubmissionCompleted(submissions_[numRetired], completedTimelineValue))
+    {
+        /* The fence of the graphics queue submission also covers the transfer and release submissions it waited on */
+        auto& submission = submissions_[numRetired++];
+        tail_ = submission.end;
+
+        unusedCommandBuffers_.push_back(submission.commandBuffer);
+        if (submission.releaseCommandBuffer != VK_NULL_HANDLE)
+            unusedCommandBuffers_.push_back(submission.releaseCommandBuffer);
+        if (submission.transferCommandBuffer != VK_NULL_HANDLE)
+            unusedTransferCommandBuffers_.push_back(submission.transferCommandBuffer);
+        if (submission.transferSemaphore.Get() != VK_NULL_HANDLE)
+            unusedSemaphores_.push_back(std::move(submission.transferSemaphore));
+        if (submission.releaseSemaphore.Get() != VK_NULL_HANDLE)
+            unusedSemaphores_.push_back(std::move(submission.releaseSemaphore));
+
+        if (submission.fence.Get() != VK_NULL_HANDLE)
+            unusedFences_.push_back(std::move(submission.fence));
+    }
+
+    if (numRetired > 0)
+        submissions_.erase(submissions_.begin(), submissions_.begin() + numRetired);
+}
+
+bool VKStagingBufferPool::IsSubmissionCompleted(const Submission& submission, std::uint64_t completedTimelineValue) const
+{
+    if (timelineFence_)
+        return (submission.timelineValue <= completedTimelineValue);
+    else
+        return (vkGetFenceStatus(device_, submission.fence) == VK_SUCCESS);
+}
+
+VKPtr<VkFence> VKStagingBufferPool::AcquireFence()
+{
+    if (!unusedFences_.empty())
+    {
+        /* Reset and reuse fence from retired submission */
+        auto fence = std::move(unusedFences_.back());
+        unusedFences_.pop_back();
+        vkResetFences(device_, 1, &fence);
+        return fence;
+    }
+
+    /* Create new fence */
+    VKPtr<VkFence> fence{ device_.GetVkDevice(), vkDestroyFence };
+
+    VkFenceCreateInfo createInfo;
+    {
+        createInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+    }
+    auto result = vkCreateFence(device_, &createInfo, nullptr, fence.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan staging fence");
+
+    return fence;
+}
+
+VKPtr<VkSemaphore> VKStagingBufferPool::AcquireSemaphore()
+{
+    if (!unusedSemaphores_.empty())
+    {
+        /* Reuse semaphore from retired submission; it has been unsignaled by the wait operation */
+        auto semaphore = std::move(unusedSemaphores_.back());
+        unusedSemaphores_.pop_back();
+        return semaphore;
+    }
+
+    /* Create new semaphore */
+    VKPtr<VkSemaphore> semaphore{ device_.GetVkDevice(), vkDestroySemaphore };
+
+    VkSemaphoreCreateInfo createInfo;
+    {
+        createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+    }
+    auto result = vkCreateSemaphore(device_, &createInfo, nullptr, semaphore.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan staging semaphore");
+
+    return semaphore;
+}
+
+VkCommandBuffer VKStagingBufferPool::BeginCommandBuffer(std::vector<VkCommandBuffer>& unusedCommandBuffers, VkCommandPool commandPool)
+{
+    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+
+    /* Reuse command buffer of a retired submission or allocate a new one */
+    if (unusedCommandBuffers.empty())
+    {
+        VkCommandBufferAllocateInfo allocInfo;
+        {
+            allocInfo.sType                 = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocInfo.pNext                 = nullptr;
+            allocInfo.commandPool           = commandPool;
+            allocInfo.level                 = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocInfo.commandBufferCount    = 1;
+        }
+        auto result = vkAllocateCommandBuffers(device_, &allocInfo, &commandBuffer);
+        VKThrowIfFailed(result, "failed to allocate Vulkan staging command buffer");
+    }
+    else
+    {
+        commandBuffer = unusedCommandBuffers.back();
+        unusedCommandBuffers.pop_back();
+    }
+
+    /* Begin recording (this implicitly resets a reused command buffer) */
+    VkCommandBufferBeginInfo beginInfo;
+    {
+        beginInfo.sType             = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.pNext             = nullptr;
+        beginInfo.flags             = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        beginInfo.pInheritanceInfo  = nullptr;
+    }
+    auto result = vkBeginCommandBuffer(commandBuffer, &beginInfo);
+    VKThrowIfFailed(result, "failed to begin recording Vulkan staging command buffer");
+
+    return commandBuffer;
+}
+
+VkCommandBuffer VKStagingBufferPool::GetTransferCommandBuffer()
+{
+    if (transferCommandBuffer_ == VK_NULL_HANDLE)
+        transferCommandBuffer_ = BeginCommandBuffer(unusedTransferCommandBuffers_, transferCommandPool_);
+    return transferCommandBuffer_;
+}
+
+void VKStagingBufferPool::AcquireBufferOwnership(VkBuffer buffer, bool preserveContent)
+{
+    /* Each buffer is only transferred once per batch */
+    if (std::find(pendingBuffers_.begin(), pendingBuffers_.end(), buffer) != pendingBuffers_.end())
+        return;
+
+    pendingBuffers_.push_back(buffer);
+
+    VkBufferMemoryBarrier barrier;
+    {
+        barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.pNext               = nullptr;
+        barrier.srcAccessMask       = 0;
+        barrier.dstAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.srcQueueFamilyIndex = graphicsFamily_;
+        barrier.dstQueueFamilyIndex = transferFamily_;
+        barrier.buffer              = buffer;
+        barrier.offset              = 0;
+        barrier.size                = VK_WHOLE_SIZE;
+    }
+
+    if (preserveContent)
+    {
+        /* Acquire ownership from the graphics queue family, which releases it before the transfer commands are submitted */
+        vkCmdPipelineBarrier(
+            GetTransferCommandBuffer(),
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0,
+            0, nullptr,
+            1, &barrier,
+            0, nullptr
+        );
+
+        barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+        barrier.dstAccessMask = 0;
+        preReleaseBarriers_.push_back(barrier);
+    }
+
+    /* Release ownership to the graphics queue family after all copy commands of this batch */
+    barrier.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask       = 0;
+    barrier.srcQueueFamilyIndex = transferFamily_;
+    barrier.dstQueueFamilyIndex = graphicsFamily_;
+    bufferReleaseBarriers_.push_back(barrier);
+}
+
+void VKStagingBufferPool::SubmitTransferCommandBuffer(Submission& submission)
+{
+    if (!preReleaseBarriers_.empty())
+    {
+        /* Release ownership of buffers whose content must be preserved on the graphics queue */
+        submission.releaseCommandBuffer = BeginCommandBuffer(unusedCommandBuffers_, device_.GetVkCommandPool());
+        vkCmdPipelineBarrier(
+            submission.releaseCommandBuffer,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+            0,
+            0, nullptr,
+            static_cast<std::uint32_t>(preReleaseBarriers_.size()), preReleaseBarriers_.data(),
+            0, nullptr
+        );
+        preReleaseBarriers_.clear();
+
+        auto result = vkEndCommandBuffer(submission.releaseCommandBuffer);
+        VKThrowIfFailed(result, "failed to end recording Vulkan staging command buffer");
+
+        submission.releaseSemaphore = AcquireSemaphore();
+        result = SubmitCommandBuffer(
+            device_.GetVkQueue(),
+            submission.releaseCommandBuffer,
+            VK_NULL_HANDLE,
+            0,
+            submission.releaseSemaphore,
+            VK_NULL_HANDLE
+        );
+        VKThrowIfFailed(result, "failed to submit Vulkan staging command buffer");
+    }
+
+    /* Release ownership of all written resources to the graphics queue family */
+    vkCmdPipelineBarrier(
+        transferCommandBuffer_,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+        0,
+        0, nullptr,
+        static_cast<std::uint32_t>(bufferReleaseBarriers_.size()), bufferReleaseBarriers_.data(),
+        static_cast<std::uint32_t>(imageReleaseBarriers_.size()), imageReleaseBarriers_.data()
+    );
+
+    auto result = vkEndCommandBuffer(transferCommandBuffer_);
+    VKThrowIfFailed(result, "failed to end recording Vulkan transfer command buffer");
+
+    /* Submit copy commands to the transfer queue; the graphics queue waits for their semaphore */
+    submission.transferCommandBuffer    = transferCommandBuffer_;
+    submission.transferSemaphore        = AcquireSemaphore();
+
+    result = SubmitCommandBuffer(
+        transferQueue_,
+        transferCommandBuffer_,
+        submission.releaseSemaphore,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        submission.transferSemaphore,
+        VK_NULL_HANDLE
+    );
+    VKThrowIfFailed(result, "failed to submit Vulkan transfer command buffer");
+
+    transferCommandBuffer_ = VK_NULL_HANDLE;
+    pendingBuffers_.clear();
+    pendingImages_.clear();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
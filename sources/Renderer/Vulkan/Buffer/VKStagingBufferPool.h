@@ -0,0 +1,208 @@
+/*
+ * VKStagingBufferPool.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_STAGING_BUFFER_POOL_H
+#define LLGL_VK_STAGING_BUFFER_POOL_H
+
+
+#include <LLGL/TextureFlags.h>
+#include <LLGL/BufferFlags.h>
+#include "../Vulkan.h"
+#include "../VKPtr.h"
+#include "VKDeviceBuffer.h"
+#include "../RenderState/VKFence.h"
+#include <vector>
+#include <memory>
+
+
+namespace LLGL
+{
+
+
+class VKDevice;
+class VKDeviceMemory;
+class VKTexture;
+
+/*
+Persistently mapped staging ring buffer that is shared by all upload paths of the Vulkan render system.
+Uploads are copied into the ring buffer and the respective copy commands are recorded into a pending command buffer.
+The pending command buffer is submitted without waiting for its completion, either explicitly via Flush() or before
+any other command buffer is submitted to the graphics queue. Each submission is protected by its own fence,
+so the ring buffer only waits for the GPU if it runs out of space. If the device supports timeline semaphores,
+all submissions signal a single timeline fence instead and are retired as soon as the GPU has passed their value.
+If the device provides a dedicated transfer queue, buffer and image copies are recorded into a separate command buffer
+for that queue and the ownership of the destination resources is transferred back to the graphics queue on Flush().
+*/
+class VKStagingBufferPool
+{
+
+    public:
+
+        VKStagingBufferPool(VKDevice& device);
+
+        VKStagingBufferPool(const VKStagingBufferPool&) = delete;
+        VKStagingBufferPool& operator = (const VKStagingBufferPool&) = delete;
+
+        // Creates the ring buffer with the specified size within its own host-visible device memory.
+        void InitializeDevice(const VkPhysicalDeviceMemoryProperties& memoryProperties, VkDeviceSize size);
+
+        // Returns true if the specified amount of data can be written into the ring buffer at once.
+        bool Capacity(VkDeviceSize dataSize) const;
+
+        /*
+        Writes the specified data into the ring buffer and records a copy command into the destination buffer.
+        If 'preserveContent' is false, the previous content of the destination buffer is undefined (e.g. for newly created buffers).
+        */
+        void WriteStaged(VkBuffer dstBuffer, VkDeviceSize dstOffset, const void* data, VkDeviceSize dataSize, bool preserveContent = true);
+
+        /*
+        Writes the data of all specified regions into a single range of the ring buffer and records a single copy command with all regions into the destination buffer.
+        The total size of all regions must fit into the ring buffer (see Capacity).
+        */
+        void WriteStagedRegions(VkBuffer dstBuffer, std::uint32_t numRegions, const BufferWriteRegion* regions);
+
+        /*
+        Writes the specified image data into the ring buffer and records a copy command into the destination texture.
+        The subresource is transitioned into VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL layout; its previous content is undefined.
+        The optional row length and image height (in texels) describe strided image data; zero denotes tightly packed data.
+        */
+        void WriteImageStaged(
+            VKTexture&                  dstTexture,
+            const VkOffset3D&           offset,
+            const VkExtent3D&           extent,
+            const TextureSubresource&   subresource,
+            const void*                 data,
+            VkDeviceSize                dataSize,
+            VkDeviceSize                alignment,
+            std::uint32_t               bufferRowLength     = 0,
+            std::uint32_t               bufferImageHeight   = 0
+        );
+
+        /*
+        Writes the specified data into the ring buffer and returns its offset within the ring buffer, which is a multiple of 'alignment'.
+        This must be called before GetCommandBuffer() since it might submit the pending command buffer to free up space.
+        */
+        VkDeviceSize Write(const void* data, VkDeviceSize dataSize, VkDeviceSize alignment);
+
+        // Returns the pending command buffer for staged commands on the graphics queue and begins recording if necessary.
+        VkCommandBuffer GetCommandBuffer();
+
+        // Submits the pending command buffers without waiting for their completion.
+        void Flush();
+
+        // Submits the pending command buffers and waits until all submissions have been completed.
+        void Wait();
+
+        // Returns the native VkBuffer handle of the ring buffer.
+        inline VkBuffer GetVkBuffer() const
+        {
+            return ringBuffer_.GetVkBuffer();
+        }
+
+        // Returns true if copy commands are executed on a dedicated transfer queue.
+        inline bool HasTransferQueue() const
+        {
+            return (transferQueue_ != VK_NULL_HANDLE);
+        }
+
+    private:
+
+        struct Submission
+        {
+            Submission(const VKPtr<VkDevice>& device);
+
+            VkCommandBuffer     commandBuffer           = VK_NULL_HANDLE;
+            VkCommandBuffer     transferCommandBuffer   = VK_NULL_HANDLE;
+            VkCommandBuffer     releaseCommandBuffer    = VK_NULL_HANDLE;
+            VKPtr<VkSemaphore>  transferSemaphore;
+            VKPtr<VkSemaphore>  releaseSemaphore;
+            VKPtr<VkFence>      fence;
+            std::uint64_t       timelineValue           = 0;
+            VkDeviceSize        end                     = 0;
+        };
+
+        struct PendingImage
+        {
+            VkImage             image;
+            TextureSubresource  subresource;
+        };
+
+    private:
+
+        // Allocates a range within the ring buffer and returns its physical offset. Waits for previous submissions if necessary.
+        VkDeviceSize AllocRange(VkDeviceSize dataSize, VkDeviceSize alignment);
+
+        // Retires all submissions that have been completed. If 'waitForOldest' is true, blocks until the oldest submission has been completed.
+        void RetireSubmissions(bool waitForOldest);
+
+        // Returns true if the specified submission has been completed by the GPU.
+        bool IsSubmissionCompleted(const Submission& submission, std::uint64_t completedTimelineValue) const;
+
+        // Returns an unsignaled fence from the pool or creates a new one.
+        VKPtr<VkFence> AcquireFence();
+
+        // Returns an unsignaled semaphore from the pool or creates a new one.
+        VKPtr<VkSemaphore> AcquireSemaphore();
+
+        // Returns a command buffer from the specified list of unused command buffers or allocates a new one, and begins recording.
+        VkCommandBuffer BeginCommandBuffer(std::vector<VkCommandBuffer>& unusedCommandBuffers, VkCommandPool commandPool);
+
+        // Returns the pending command buffer for the transfer queue and begins recording if necessary.
+        VkCommandBuffer GetTransferCommandBuffer();
+
+        // Records the ownership transfer of the specified buffer to the transfer queue, unless it has already been transferred in the current batch.
+        void AcquireBufferOwnership(VkBuffer buffer, bool preserveContent);
+
+        // Records the pending release barriers and submits the pending transfer command buffer. The graphics queue must wait on the transfer semaphore of the submission.
+        void SubmitTransferCommandBuffer(Submission& submission);
+
+    private:
+
+        VKDevice&                           device_;
+
+        std::unique_ptr<VKDeviceMemory>     deviceMemory_;
+        VKDeviceBuffer                      ringBuffer_;
+        char*                               mappedData_             = nullptr;
+        VkDeviceSize                        size_                   = 0;
+
+        /* Virtual positions within the ring buffer that increase monotonically; the physical offset is the position modulo the size */
+        VkDeviceSize                        head_                   = 0;
+        VkDeviceSize                        tail_                   = 0;
+
+        VkCommandBuffer                     commandBuffer_          = VK_NULL_HANDLE;
+        std::vector<Submission>             submissions_;
+        std::vector<VkCommandBuffer>        unusedCommandBuffers_;
+        std::vector<VKPtr<VkFence>>         unusedFences_;
+        std::vector<VKPtr<VkSemaphore>>     unusedSemaphores_;
+        std::unique_ptr<VKFence>            timelineFence_;                 // Replaces the per-submission fences if timeline semaphores are supported
+
+        /* ----- Dedicated transfer queue ----- */
+
+        VkQueue                             transferQueue_          = VK_NULL_HANDLE;
+        std::uint32_t                       transferFamily_         = 0;
+        std::uint32_t                       graphicsFamily_         = 0;
+        VKPtr<VkCommandPool>                transferCommandPool_;
+        VkCommandBuffer                     transferCommandBuffer_  = VK_NULL_HANDLE;
+        std::vector<VkCommandBuffer>        unusedTransferCommandBuffers_;
+
+        std::vector<VkBufferMemoryBarrier>  preReleaseBarriers_;    // Graphics to transfer queue family
+        std::vector<VkBufferMemoryBarrier>  bufferReleaseBarriers_; // Transfer to graphics queue family
+        std::vector<VkImageMemoryBarrier>   imageReleaseBarriers_;  // Transfer to graphics queue family
+        std::vector<VkBuffer>               pendingBuffers_;
+        std::vector<PendingImage>           pendingImages_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
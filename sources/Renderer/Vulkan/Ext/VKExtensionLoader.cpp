@@ -107,6 +107,86 @@ static bool Load_VK_KHR_get_physical_device_properties2(VkDevice handle)
     return true;
 }
 
+static bool Load_VK_KHR_descriptor_update_template(VkDevice handle)
+{
+    LOAD_VKPROC( vkCreateDescriptorUpdateTemplateKHR  );
+    LOAD_VKPROC( vkDestroyDescriptorUpdateTemplateKHR );
+    LOAD_VKPROC( vkUpdateDescriptorSetWithTemplateKHR );
+    return true;
+}
+
+static bool Load_VK_KHR_timeline_semaphore(VkDevice handle)
+{
+    LOAD_VKPROC( vkGetSemaphoreCounterValueKHR );
+    LOAD_VKPROC( vkWaitSemaphoresKHR           );
+    LOAD_VKPROC( vkSignalSemaphoreKHR          );
+    return true;
+}
+
+static bool Load_VK_KHR_draw_indirect_count(VkDevice handle)
+{
+    LOAD_VKPROC( vkCmdDrawIndirectCountKHR        );
+    LOAD_VKPROC( vkCmdDrawIndexedIndirectCountKHR );
+    return true;
+}
+
+static bool Load_VK_KHR_dynamic_rendering(VkDevice handle)
+{
+    LOAD_VKPROC( vkCmdBeginRenderingKHR );
+    LOAD_VKPROC( vkCmdEndRenderingKHR   );
+    return true;
+}
+
+static bool Load_VK_EXT_calibrated_timestamps(VkDevice handle)
+{
+    LOAD_VKPROC( vkGetCalibratedTimestampsEXT );
+    return true;
+}
+
+static bool Load_VK_EXT_mesh_shader(VkDevice handle)
+{
+    LOAD_VKPROC( vkCmdDrawMeshTasksEXT         );
+    LOAD_VKPROC( vkCmdDrawMeshTasksIndirectEXT );
+    return true;
+}
+
+static bool Load_VK_KHR_fragment_shading_rate(VkDevice handle)
+{
+    LOAD_VKPROC( vkCmdSetFragmentShadingRateKHR );
+    return true;
+}
+
+static bool Load_VK_EXT_pageable_device_local_memory(VkDevice handle)
+{
+    LOAD_VKPROC( vkSetDeviceMemoryPriorityEXT );
+    return true;
+}
+
+#ifdef LLGL_OS_WIN32
+
+static bool Load_VK_KHR_external_memory_win32(VkDevice handle)
+{
+    LOAD_VKPROC( vkGetMemoryWin32HandleKHR );
+    return true;
+}
+
+#else
+
+static bool Load_VK_KHR_external_memory_fd(VkDevice handle)
+{
+    LOAD_VKPROC( vkGetMemoryFdKHR );
+    return true;
+}
+
+#endif // /LLGL_OS_WIN32
+
+static bool Load_VK_GOOGLE_display_timing(VkDevice handle)
+{
+    LOAD_VKPROC( vkGetRefreshCycleDurationGOOGLE   );
+    LOAD_VKPROC( vkGetPastPresentationTimingGOOGLE );
+    return true;
+}
+
 #undef LOAD_VKPROC
 
 
@@ -176,11 +256,35 @@ bool VKLoadDeviceExtensions(VkDevice device, const std::vector<const char*>& sup
 
     /* Multi-vendor extensions */
     LOAD_VKEXT( KHR_get_physical_device_properties2 );
+    LOAD_VKEXT( KHR_descriptor_update_template      );
+    LOAD_VKEXT( KHR_timeline_semaphore              );
+    LOAD_VKEXT( KHR_draw_indirect_count             );
+    LOAD_VKEXT( KHR_dynamic_rendering               );
     LOAD_VKEXT( EXT_debug_marker                    );
     LOAD_VKEXT( EXT_conditional_rendering           );
     LOAD_VKEXT( EXT_transform_feedback              );
+    LOAD_VKEXT( EXT_calibrated_timestamps           );
+    LOAD_VKEXT( EXT_mesh_shader                     );
+    LOAD_VKEXT( KHR_fragment_shading_rate           );
+    LOAD_VKEXT( EXT_pageable_device_local_memory    );
+    LOAD_VKEXT( GOOGLE_display_timing               );
+
+    /* Platform specific extensions */
+    #ifdef LLGL_OS_WIN32
+    LOAD_VKEXT( KHR_external_memory_win32           );
+    #else
+    LOAD_VKEXT( KHR_external_memory_fd              );
+    #endif // /LLGL_OS_WIN32
 
     ENABLE_VKEXT( EXT_conservative_rasterization );
+    ENABLE_VKEXT( EXT_memory_budget              );
+    ENABLE_VKEXT( KHR_maintenance3               );
+    ENABLE_VKEXT( EXT_descriptor_indexing        );
+    ENABLE_VKEXT( KHR_incremental_present        );
+    ENABLE_VKEXT( KHR_pipeline_library           );
+    ENABLE_VKEXT( EXT_graphics_pipeline_library  );
+    ENABLE_VKEXT( KHR_external_memory            );
+    ENABLE_VKEXT( KHR_dedicated_allocation       );
 
     #undef LOAD_VKEXT
 
@@ -22,12 +22,33 @@ enum class VKExt
     /* Khronos extensions */
     KHR_maintenance1,
     KHR_get_physical_device_properties2,
+    KHR_descriptor_update_template,
+    KHR_timeline_semaphore,
+    KHR_draw_indirect_count,
+    KHR_maintenance3,
+    KHR_dynamic_rendering,
+    KHR_incremental_present,
+    KHR_pipeline_library,
+    KHR_external_memory,
+    KHR_external_memory_fd,
+    KHR_external_memory_win32,
+    KHR_dedicated_allocation,
+    KHR_fragment_shading_rate,
 
     /* Multivendor extensions */
     EXT_debug_marker,
     EXT_conditional_rendering,
     EXT_transform_feedback,
     EXT_conservative_rasterization,
+    EXT_memory_budget,
+    EXT_descriptor_indexing,
+    EXT_calibrated_timestamps,
+    EXT_graphics_pipeline_library,
+    EXT_mesh_shader,
+    EXT_pageable_device_local_memory,
+
+    /* Vendor specific extensions */
+    GOOGLE_display_timing,
 
     /* Enumeration entry counter */
     Count,
@@ -71,6 +71,61 @@ DECL_VKPROC( vkGetPhysicalDeviceQueueFamilyProperties2KHR       );
 DECL_VKPROC( vkGetPhysicalDeviceMemoryProperties2KHR            );
 DECL_VKPROC( vkGetPhysicalDeviceSparseImageFormatProperties2KHR );
 
+/* VK_KHR_descriptor_update_template */
+DECL_VKPROC( vkCreateDescriptorUpdateTemplateKHR  );
+DECL_VKPROC( vkDestroyDescriptorUpdateTemplateKHR );
+DECL_VKPROC( vkUpdateDescriptorSetWithTemplateKHR );
+
+/* VK_KHR_timeline_semaphore */
+
+DECL_VKPROC( vkGetSemaphoreCounterValueKHR );
+DECL_VKPROC( vkWaitSemaphoresKHR           );
+DECL_VKPROC( vkSignalSemaphoreKHR          );
+
+/* VK_KHR_draw_indirect_count */
+
+DECL_VKPROC( vkCmdDrawIndirectCountKHR        );
+DECL_VKPROC( vkCmdDrawIndexedIndirectCountKHR );
+
+/* VK_KHR_dynamic_rendering */
+
+DECL_VKPROC( vkCmdBeginRenderingKHR );
+DECL_VKPROC( vkCmdEndRenderingKHR   );
+
+/* VK_EXT_calibrated_timestamps */
+
+DECL_VKPROC( vkGetCalibratedTimestampsEXT );
+
+/* VK_EXT_mesh_shader */
+
+DECL_VKPROC( vkCmdDrawMeshTasksEXT         );
+DECL_VKPROC( vkCmdDrawMeshTasksIndirectEXT );
+
+/* VK_KHR_fragment_shading_rate */
+
+DECL_VKPROC( vkCmdSetFragmentShadingRateKHR );
+
+/* VK_EXT_pageable_device_local_memory */
+
+DECL_VKPROC( vkSetDeviceMemoryPriorityEXT );
+
+/* VK_KHR_external_memory_fd, VK_KHR_external_memory_win32 */
+
+#if defined(LLGL_OS_WIN32)
+
+DECL_VKPROC( vkGetMemoryWin32HandleKHR );
+
+#else
+
+DECL_VKPROC( vkGetMemoryFdKHR );
+
+#endif
+
+/* VK_GOOGLE_display_timing */
+
+DECL_VKPROC( vkGetRefreshCycleDurationGOOGLE   );
+DECL_VKPROC( vkGetPastPresentationTimingGOOGLE );
+
 #undef DECL_VKPROC
 
 
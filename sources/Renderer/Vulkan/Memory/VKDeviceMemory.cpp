@@ -9,16 +9,61 @@
 #include "../VKCore.h"
 #include "../../../Core/Helper.h"
 
+#ifdef _MSC_VER
+#   include <intrin.h>
+#endif
+
 
 namespace LLGL
 {
 
 
+const std::uint32_t VKDeviceMemory::slCountLog2;
+const std::uint32_t VKDeviceMemory::slCount;
+const std::uint32_t VKDeviceMemory::flCount;
+const std::uint32_t VKDeviceMemory::priorityCount;
+
+// Returns the index of the least significant bit that is set. Input must be non-zero.
+static std::uint32_t BitScanLSB(std::uint64_t x)
+{
+    #if defined _MSC_VER && defined _WIN64
+    unsigned long index = 0;
+    _BitScanForward64(&index, x);
+    return static_cast<std::uint32_t>(index);
+    #elif defined __GNUC__ || defined __clang__
+    return static_cast<std::uint32_t>(__builtin_ctzll(x));
+    #else
+    std::uint32_t index = 0;
+    while ((x & 1) == 0)
+    {
+        x >>= 1;
+        ++index;
+    }
+    return index;
+    #endif
+}
+
+// Returns the index of the most significant bit that is set. Input must be non-zero.
+static std::uint32_t BitScanMSB(std::uint64_t x)
+{
+    #if defined _MSC_VER && defined _WIN64
+    unsigned long index = 0;
+    _BitScanReverse64(&index, x);
+    return static_cast<std::uint32_t>(index);
+    #elif defined __GNUC__ || defined __clang__
+    return static_cast<std::uint32_t>(63 - __builtin_clzll(x));
+    #else
+    std::uint32_t index = 0;
+    while (x >>= 1)
+        ++index;
+    return index;
+    #endif
+}
+
 VKDeviceMemory::VKDeviceMemory(const VKPtr<VkDevice>& device, VkDeviceSize size, std::uint32_t memoryTypeIndex) :
     deviceMemory_    { device, vkFreeMemory },
     size_            { size                 },
-    memoryTypeIndex_ { memoryTypeIndex      },
-    maxNewBlockSize_ { size                 }
+    memoryTypeIndex_ { memoryTypeIndex      }
 {
     /* Allocate device memory */
     VkMemoryAllocateInfo allocInfo;
@@ -35,6 +80,9 @@ VKDeviceMemory::VKDeviceMemory(const VKPtr<VkDevice>& device, VkDeviceSize size,
         std::string info = "failed to allocate Vulkan device memory of " + std::to_string(size) + " bytes";
         VKThrowIfFailed(result, info.c_str());
     }
+
+    /* Start with a single free block that covers the entire chunk */
+    InsertFreeBlock(MakeRegionAfter(nullptr, size, 0));
 }
 
 void* VKDeviceMemory::Map(VkDevice device, VkDeviceSize offset, VkDeviceSize size)
@@ -44,86 +92,129 @@ void* VKDeviceMemory::Map(VkDevice device, VkDeviceSize offset, VkDeviceSize siz
     auto result = vkMapMemory(device, deviceMemory_, offset, size, 0, &data);
     VKThrowIfFailed(result, "failed to map Vulkan buffer into CPU memory space");
 
+    isMapped_ = true;
+
     return data;
 }
 
 void VKDeviceMemory::Unmap(VkDevice device)
 {
     vkUnmapMemory(device, deviceMemory_);
+    isMapped_ = false;
 }
 
 VKDeviceMemoryRegion* VKDeviceMemory::Allocate(VkDeviceSize size, VkDeviceSize alignment, bool reduceFragmentation)
 {
     if (size > 0 && alignment > 0)
     {
-        /* Adjust size and offset by alignment */
-        auto alignedSize    = GetAlignedSize(size, alignment);
-        auto alignedOffset  = GetAlignedSize(GetNextOffset(), alignment);
+        /* Adjust size by alignment */
+        const auto alignedSize = GetAlignedSize(size, alignment);
+
+        VKDeviceMemoryRegion* block = nullptr;
 
+        /* Try to find a block of approximately the same size first to keep fragmentation low */
         if (reduceFragmentation)
-        {
-            /* Reuse fragmented block */
-            if (alignedSize <= maxFragmentedBlockSize_)
-                return FindReusableBlock(alignedSize, alignment);
+            block = FindFreeBlockInSameList(alignedSize, alignment);
 
-            /* Allocate block with aligned size and offset */
-            if (alignedSize + alignedOffset <= GetSize())
-                return AllocAndAppendBlock(alignedSize, alignedOffset);
-        }
-        else
+        if (block == nullptr)
         {
-            /* Allocate block with aligned size and offset */
-            if (alignedSize + alignedOffset <= GetSize())
-                return AllocAndAppendBlock(alignedSize, alignedOffset);
+            /* Find a block from the next larger list (good fit), which is guaranteed to hold the aligned size */
+            block = FindFreeBlock(alignedSize);
 
-            /* Reuse fragmented block */
-            if (alignedSize <= maxFragmentedBlockSize_)
-                return FindReusableBlock(alignedSize, alignment);
+            /* If the block's offset is not aligned, the alignment padding might not fit into the block anymore */
+            if (block != nullptr && GetAlignedSize(block->GetOffset(), alignment) + alignedSize > block->GetOffsetWithSize())
+                block = (alignment > 1 ? FindFreeBlock(alignedSize + alignment - 1) : nullptr);
         }
+
+        if (block != nullptr)
+            return AllocFreeBlock(block, alignedSize, GetAlignedSize(block->GetOffset(), alignment));
     }
     return nullptr;
 }
 
 void VKDeviceMemory::Release(VKDeviceMemoryRegion* region)
 {
-    if (region)
+    if (region != nullptr && region->GetParentChunk() == this && !region->IsFree())
     {
-        /* Increase maximal size of fragmented blocks */
-        maxFragmentedBlockSize_ = std::max(maxFragmentedBlockSize_, region->GetSize());
+        usedSize_ -= region->GetSize();
+        --numBlocks_;
+        --numBlocksPerPriority_[static_cast<std::uint32_t>(region->priority_)];
 
-        auto it = std::find_if(
-            blocks_.begin(), blocks_.end(),
-            [region](const std::unique_ptr<VKDeviceMemoryRegion>& entry)
-            {
-                return (entry.get() == region);
-            }
-        );
+        region->isFree_             = true;
+        region->relocatableOwner_   = nullptr;
+        region->priority_           = ResidencyPriority::Normal;
+
+        /* Merge with upper neighbour: [BLOCK][UPPER] --> [+++BLOCK++++] */
+        auto upperRegion = region->nextPhysical_;
+        if (upperRegion != nullptr && upperRegion->IsFree())
+        {
+            RemoveFreeBlock(upperRegion);
+            MergeWithLowerRegion(upperRegion);
+        }
 
-        if (it != blocks_.end())
+        /* Merge with lower neighbour: [LOWER][BLOCK] --> [+++LOWER++++] */
+        auto lowerRegion = region->prevPhysical_;
+        if (lowerRegion != nullptr && lowerRegion->IsFree())
         {
-            InsertBlockToFragmentsSorted(std::move(*it));
-            blocks_.erase(it);
+            RemoveFreeBlock(lowerRegion);
+            MergeWithLowerRegion(region);
+            region = lowerRegion;
         }
+
+        InsertFreeBlock(region);
     }
 }
 
 bool VKDeviceMemory::IsEmpty() const
 {
-    return blocks_.empty();
+    return (numBlocks_ == 0);
 }
 
-VkDeviceSize VKDeviceMemory::GetMaxAllocationSize() const
+void VKDeviceMemory::SetBlockPriority(VKDeviceMemoryRegion* region, ResidencyPriority priority)
 {
-    return std::max(maxNewBlockSize_, maxFragmentedBlockSize_);
+    if (region != nullptr && region->GetParentChunk() == this && !region->IsFree())
+    {
+        --numBlocksPerPriority_[static_cast<std::uint32_t>(region->priority_)];
+        ++numBlocksPerPriority_[static_cast<std::uint32_t>(priority)];
+        region->priority_ = priority;
+    }
+}
+
+ResidencyPriority VKDeviceMemory::GetMaxBlockPriority() const
+{
+    for (std::uint32_t i = priorityCount; i > 1; --i)
+    {
+        if (numBlocksPerPriority_[i - 1] > 0)
+            return static_cast<ResidencyPriority>(i - 1);
+    }
+    return ResidencyPriority::Minimum;
 }
 
 void VKDeviceMemory::AccumDetails(VKDeviceMemoryDetails& details) const
 {
-    details.numChunks               += 1;
-    details.numBlocks               += blocks_.size();
-    details.numFragments            += fragmentedBlocks_.size();
-    details.maxNewBlockSize         = std::max(details.maxNewBlockSize, maxNewBlockSize_);
-    details.maxFragmentedBlockSize  = std::max(details.maxFragmentedBlockSize, maxFragmentedBlockSize_);
+    details.numChunks       += 1;
+    details.numBlocks       += numBlocks_;
+    details.allocatedSize   += GetSize();
+    details.usedSize        += GetUsedSize();
+
+    for (auto region = firstRegion_; region != nullptr; region = region->nextPhysical_)
+    {
+        if (region->IsFree())
+        {
+            if (region->nextPhysical_ == nullptr)
+            {
+                /* Free block at the end of the chunk that has never been split up */
+                details.maxNewBlockSize = std::max(details.maxNewBlockSize, region->GetSize());
+            }
+            else
+            {
+                /* Free block in between allocated blocks */
+                details.numFragments            += 1;
+                details.fragmentedSize          += region->GetSize();
+                details.maxFragmentedBlockSize  = std::max(details.maxFragmentedBlockSize, region->GetSize());
+            }
+        }
+    }
 }
 
 #ifdef LLGL_DEBUG
@@ -133,7 +224,7 @@ Prints a single memory region to the output stream.
 Example of 3 consecutive blocks: [0+++++][8++][13++++++]
 Example of 3 fragmented blocks: [0+++++]...[11+].[17++++++]
 */
-static void PrintDeviceMemoryRegion(std::ostream& s, VKDeviceMemoryRegion& region, VKDeviceMemoryRegion* prevRegion)
+static void PrintDeviceMemoryRegion(std::ostream& s, const VKDeviceMemoryRegion& region, const VKDeviceMemoryRegion* prevRegion)
 {
     /* Print space between previous and current region */
     if (prevRegion)
@@ -178,21 +269,27 @@ static void PrintDeviceMemoryRegion(std::ostream& s, VKDeviceMemoryRegion& regio
 
 void VKDeviceMemory::PrintBlocks(std::ostream& s) const
 {
-    VKDeviceMemoryRegion* prevBlock = nullptr;
-    for (const auto& block : blocks_)
+    const VKDeviceMemoryRegion* prevBlock = nullptr;
+    for (auto block = firstRegion_; block != nullptr; block = block->nextPhysical_)
     {
-        PrintDeviceMemoryRegion(s, *block, prevBlock);
-        prevBlock = block.get();
+        if (!block->IsFree())
+        {
+            PrintDeviceMemoryRegion(s, *block, prevBlock);
+            prevBlock = block;
+        }
     }
 }
 
 void VKDeviceMemory::PrintFragmentedBlocks(std::ostream& s) const
 {
-    VKDeviceMemoryRegion* prevBlock = nullptr;
-    for (const auto& block : fragmentedBlocks_)
+    const VKDeviceMemoryRegion* prevBlock = nullptr;
+    for (auto block = firstRegion_; block != nullptr; block = block->nextPhysical_)
     {
-        PrintDeviceMemoryRegion(s, *block, prevBlock);
-        prevBlock = block.get();
+        if (block->IsFree())
+        {
+            PrintDeviceMemoryRegion(s, *block, prevBlock);
+            prevBlock = block;
+        }
     }
 }
 
@@ -203,238 +300,196 @@ void VKDeviceMemory::PrintFragmentedBlocks(std::ostream& s) const
  * ======= Private: =======
  */
 
-VkDeviceSize VKDeviceMemory::GetNextOffset() const
+/*
+Maps the size to the first-level list index (binary logarithm) and second-level list index (linear subdivision).
+Sizes smaller than 'slCount' are all stored in the first list with a granularity of one byte.
+*/
+void VKDeviceMemory::MapSizeToIndices(VkDeviceSize size, std::uint32_t& fl, std::uint32_t& sl)
 {
-    if (blocks_.empty())
-        return 0;
+    if (size < slCount)
+    {
+        fl = 0;
+        sl = static_cast<std::uint32_t>(size);
+    }
     else
-        return blocks_.back()->GetOffsetWithSize();
+    {
+        const auto msb = BitScanMSB(size);
+        fl = msb - slCountLog2 + 1;
+        sl = static_cast<std::uint32_t>(size >> (msb - slCountLog2)) ^ slCount;
+    }
 }
 
-std::unique_ptr<VKDeviceMemoryRegion> VKDeviceMemory::MakeUniqueBlock(VkDeviceSize alignedSize, VkDeviceSize alignedOffset)
+void VKDeviceMemory::MapSizeToIndicesRoundUp(VkDeviceSize size, std::uint32_t& fl, std::uint32_t& sl)
 {
-    return MakeUnique<VKDeviceMemoryRegion>(this, alignedSize, alignedOffset, memoryTypeIndex_);
+    /* Round size up to the next list boundary, so every block in the resulting list is large enough */
+    if (size >= slCount)
+        size += (VkDeviceSize(1) << (BitScanMSB(size) - slCountLog2)) - 1;
+    MapSizeToIndices(size, fl, sl);
 }
 
-VKDeviceMemoryRegion* VKDeviceMemory::AllocAndAppendBlock(VkDeviceSize alignedSize, VkDeviceSize alignedOffset)
+VKDeviceMemoryRegion* VKDeviceMemory::FindFreeBlock(VkDeviceSize size) const
 {
-    /* Update maximal free block size */
-    maxNewBlockSize_ = GetSize() - (alignedSize + alignedOffset);
+    std::uint32_t fl = 0, sl = 0;
+    MapSizeToIndicesRoundUp(size, fl, sl);
 
-    /* Check if the aligned offset results in a new fragment */
-    const auto nextOffset = GetNextOffset();
+    if (fl >= flCount)
+        return nullptr;
 
-    if (nextOffset < alignedOffset)
-    {
-        /*
-        Check if new fragment can be immediately merged with previous fragment:
-        Before: blocks:    [++]........[++++]
-                fragments: ....[++++]
-        After:  blocks:    [++]........[++++]
-                fragments: ....[++++++]
-        */
-        if (!fragmentedBlocks_.empty() && fragmentedBlocks_.back()->GetOffset() == nextOffset)
-        {
-            /* Resize last fragmented block */
-            fragmentedBlocks_.back()->MoveAt(alignedOffset - nextOffset, nextOffset);
-        }
-        else
-        {
-            /* Append new fragmented block at the end */
-            fragmentedBlocks_.push_back(MakeUniqueBlock(alignedOffset - nextOffset, nextOffset));
-        }
-    }
-    else
+    /* Search for a non-empty second-level list within the same first-level list */
+    auto slBitmap = (slBitmaps_[fl] & (~0u << sl));
+    if (slBitmap == 0)
     {
-        /* Check if last fragmented block can be replaced by new block */
-        if (!fragmentedBlocks_.empty() && fragmentedBlocks_.back()->GetOffset() == nextOffset)
-        {
-            /* Move fragmented block into main blocks and resize it */
-            auto block = TakeOwnership(blocks_, std::move(fragmentedBlocks_.back()));
-            block->MoveAt(alignedSize, alignedOffset);
-            fragmentedBlocks_.pop_back();
-            return block;
-        }
+        /* Search for a non-empty first-level list with larger blocks */
+        if (fl + 1 >= flCount)
+            return nullptr;
+
+        const auto flBitmap = (flBitmap_ & (~std::uint64_t(0) << (fl + 1)));
+        if (flBitmap == 0)
+            return nullptr;
+
+        fl          = BitScanLSB(flBitmap);
+        slBitmap    = slBitmaps_[fl];
     }
 
-    /* Allocate new block */
-    return TakeOwnership(blocks_, MakeUniqueBlock(alignedSize, alignedOffset));
+    sl = BitScanLSB(slBitmap);
+
+    return freeLists_[fl][sl];
 }
 
-VKDeviceMemoryRegion* VKDeviceMemory::InsertBlock(std::unique_ptr<VKDeviceMemoryRegion>&& region)
+VKDeviceMemoryRegion* VKDeviceMemory::FindFreeBlockInSameList(VkDeviceSize alignedSize, VkDeviceSize alignment) const
 {
-    auto regionRef = region.get();
+    std::uint32_t fl = 0, sl = 0;
+    MapSizeToIndices(alignedSize, fl, sl);
 
-    /* Add block by insertion sort */
-    if (!blocks_.empty())
+    for (auto block = freeLists_[fl][sl]; block != nullptr; block = block->nextFree_)
     {
-        for (auto it = blocks_.rbegin(); it != blocks_.rend(); ++it)
-        {
-            if ((*it)->GetOffset() < region->GetOffset())
-            {
-                blocks_.insert(it.base(), std::move(region));
-                break;
-            }
-        }
+        if (GetAlignedSize(block->GetOffset(), alignment) + alignedSize <= block->GetOffsetWithSize())
+            return block;
     }
-    else
-        blocks_.emplace_back(std::move(region));
 
-    return regionRef;
+    return nullptr;
 }
 
-VKDeviceMemoryRegion* VKDeviceMemory::FindReusableBlock(VkDeviceSize alignedSize, VkDeviceSize alignment)
+void VKDeviceMemory::InsertFreeBlock(VKDeviceMemoryRegion* region)
 {
-    VKDeviceMemoryRegion* prevBlock = nullptr;
-    VKDeviceMemoryRegion* nextBlock = nullptr;
+    std::uint32_t fl = 0, sl = 0;
+    MapSizeToIndices(region->GetSize(), fl, sl);
 
-    /* Search for fragmented block that fits the requirement */
-    for (auto it = fragmentedBlocks_.begin(); it != fragmentedBlocks_.end(); ++it)
-    {
-        auto block = it->get();
+    /* Insert region at the front of its free list */
+    auto& head = freeLists_[fl][sl];
 
-        /* Check if required size plus the additional aligned offset fits into the current block */
-        const auto alignedOffset = GetAlignedSize(block->GetOffset(), alignment);
-        if (alignedSize + alignedOffset - block->GetOffset() <= block->GetSize())
-        {
-            /* If this block has the maximum fragmented block size, this value must be updated */
-            const bool mustUpdateMaxSize = (block->GetSize() == maxFragmentedBlockSize_);
+    region->prevFree_ = nullptr;
+    region->nextFree_ = head;
 
-            /* If block can be reused with its entire size, it can be removed from the fragmented blocks */
-            InsertBlock(std::move(*it));
+    if (head != nullptr)
+        head->prevFree_ = region;
 
-            it = fragmentedBlocks_.erase(it);
-            if (it != fragmentedBlocks_.end())
-                nextBlock = it->get();
+    head = region;
 
-            /* Check if block must be split up at the lower part */
-            if (block->GetOffset() < alignedOffset)
-            {
-                /* Allocate fragmented lower block (left to the current block) */
-                auto blockLower = MakeUniqueBlock(alignedOffset - block->GetOffset(), block->GetOffset());
-
-                if (!prevBlock || !MergeFragmentedBlockWith(*prevBlock, *blockLower))
-                {
-                    it = fragmentedBlocks_.insert(it, std::move(blockLower));
-                    ++it;
-                }
-            }
-
-            /* Check if block must be split up at the upper part */
-            auto alignedSizeWithOffset = alignedSize + alignedOffset - block->GetOffset();
-            if (alignedSizeWithOffset < block->GetSize())
-            {
-                /* Allocate fragmented upper block (right to the current block) */
-                auto blockUpperSize = block->GetSize() - alignedSizeWithOffset;
-                auto blockUpper     = MakeUniqueBlock(blockUpperSize, block->GetOffsetWithSize() - blockUpperSize);
+    flBitmap_       |= (std::uint64_t(1) << fl);
+    slBitmaps_[fl]  |= (1u << sl);
+}
 
-                if (!nextBlock || !MergeFragmentedBlockWith(*blockUpper, *nextBlock))
-                    fragmentedBlocks_.insert(it, std::move(blockUpper));
-            }
+void VKDeviceMemory::RemoveFreeBlock(VKDeviceMemoryRegion* region)
+{
+    std::uint32_t fl = 0, sl = 0;
+    MapSizeToIndices(region->GetSize(), fl, sl);
 
-            /* Move reused block to new offset and size */
-            block->MoveAt(alignedSize, alignedOffset);
+    if (region->prevFree_ != nullptr)
+        region->prevFree_->nextFree_ = region->nextFree_;
+    if (region->nextFree_ != nullptr)
+        region->nextFree_->prevFree_ = region->prevFree_;
 
-            if (mustUpdateMaxSize)
-                UpdateMaxFragmentedBlockSize();
+    auto& head = freeLists_[fl][sl];
+    if (head == region)
+    {
+        head = region->nextFree_;
 
-            /* Reuse current block */
-            return block;
+        /* Clear bits for empty lists */
+        if (head == nullptr)
+        {
+            slBitmaps_[fl] &= ~(1u << sl);
+            if (slBitmaps_[fl] == 0)
+                flBitmap_ &= ~(std::uint64_t(1) << fl);
         }
-
-        prevBlock = block;
     }
 
-    /* No reusable block found */
-    return nullptr;
+    region->prevFree_ = nullptr;
+    region->nextFree_ = nullptr;
 }
 
-void VKDeviceMemory::UpdateMaxFragmentedBlockSize()
+VKDeviceMemoryRegion* VKDeviceMemory::AllocFreeBlock(VKDeviceMemoryRegion* region, VkDeviceSize alignedSize, VkDeviceSize alignedOffset)
 {
-    maxFragmentedBlockSize_ = 0;
-    for (const auto& block : fragmentedBlocks_)
-        maxFragmentedBlockSize_ = std::max(maxFragmentedBlockSize_, block->GetSize());
-}
+    RemoveFreeBlock(region);
 
-void VKDeviceMemory::InsertBlockToFragmentsSorted(std::unique_ptr<VKDeviceMemoryRegion>&& region)
-{
-    auto offset = region->GetOffset();
-    auto count  = fragmentedBlocks_.size();
+    /*
+    Split up free block into lower and upper fragments. Neighbours of a free block are never free, so the fragments don't need to be merged.
+    Before: ...[++++++++FREE++++++++]...
+    After:  ...[LOWER][BLOCK][UPPER]...
+    */
+    const auto offsetEnd        = region->GetOffsetWithSize();
+    const auto alignedOffsetEnd = alignedOffset + alignedSize;
 
-    /* Start serach in half-open range [begin, end) */
-    decltype(count) begin = 0, end = count;
+    if (region->GetOffset() < alignedOffset)
+        InsertFreeBlock(MakeRegionAfter(region->prevPhysical_, alignedOffset - region->GetOffset(), region->GetOffset()));
 
-    while (begin + 2 < end)
-    {
-        /* Check if region's offset is before or after the middle's element */
-        auto center = (begin + end) / 2;
+    if (alignedOffsetEnd < offsetEnd)
+        InsertFreeBlock(MakeRegionAfter(region, offsetEnd - alignedOffsetEnd, alignedOffsetEnd));
 
-        if (offset < fragmentedBlocks_[center]->GetOffset())
-        {
-            /* Restrict search to lower half */
-            end = center + 1;
-        }
-        else
-        {
-            /* Restrict search to upper half */
-            begin = center;
-        }
-    }
-
-    /* Insert region by insertion-sort of the remaining half-open range [begin, begin + 2) */
-    if (begin < count && offset < fragmentedBlocks_[begin]->GetOffset())
-        InsertBlockToFragmentsAt(std::move(region), begin);
-    else if (begin + 1 < count)
-    {
-        if (offset < fragmentedBlocks_[begin + 1]->GetOffset())
-            InsertBlockToFragmentsAt(std::move(region), begin + 1);
-        else
-            InsertBlockToFragmentsAt(std::move(region), begin + 2);
-    }
-    else
-        InsertBlockToFragmentsAt(std::move(region), count);
-}
+    /* Move allocated block to new offset and size */
+    region->MoveAt(alignedSize, alignedOffset);
+    region->isFree_ = false;
 
-void VKDeviceMemory::InsertBlockToFragmentsAt(std::unique_ptr<VKDeviceMemoryRegion>&& region, std::size_t position)
-{
-    auto count = fragmentedBlocks_.size();
+    usedSize_ += alignedSize;
+    ++numBlocks_;
+    ++numBlocksPerPriority_[static_cast<std::uint32_t>(region->priority_)];
 
-    /* Try to merge region into lower part: [LOWER][BLOCK] --> [+++LOWER++++] */
-    if (position > 0 && MergeFragmentedBlockWith(*fragmentedBlocks_[position - 1], *region))
-    {
-        /* Try to merge upper part into lower part: [+++LOWER++++][UPPER] --> [+++++++LOWER+++++++] */
-        if (position < count && MergeFragmentedBlockWith(*fragmentedBlocks_[position - 1], *fragmentedBlocks_[position]))
-        {
-            /* Remove previous upper part after two-phase-merge */
-            fragmentedBlocks_.erase(fragmentedBlocks_.begin() + position);
-        }
-    }
-    /* Try to merge region into upper part: [BLOCK][UPPER] --> [+++UPPER++++] */
-    else if (position >= count || !MergeFragmentedBlockWith(*fragmentedBlocks_[position], *region))
-    {
-        /* Insert new fragmented block: [LOWER]..[BLOCK]..[UPPER] */
-        fragmentedBlocks_.insert(fragmentedBlocks_.begin() + position, std::move(region));
-    }
+    return region;
 }
 
-bool VKDeviceMemory::MergeFragmentedBlockWith(VKDeviceMemoryRegion& region, VKDeviceMemoryRegion& appendixRegion)
+VKDeviceMemoryRegion* VKDeviceMemory::MakeRegionAfter(VKDeviceMemoryRegion* prevRegion, VkDeviceSize alignedSize, VkDeviceSize alignedOffset)
 {
-    if (region.MergeWith(appendixRegion))
+    /* Reuse previously released region node or allocate a new one */
+    VKDeviceMemoryRegion* region = nullptr;
+    if (unusedRegionNodes_.empty())
+        region = TakeOwnership(regionNodes_, MakeUnique<VKDeviceMemoryRegion>(this, alignedSize, alignedOffset, memoryTypeIndex_));
+    else
     {
-        IncMaxFragmentedBlockSize(region.GetSize());
-        return true;
+        region = unusedRegionNodes_.back();
+        unusedRegionNodes_.pop_back();
+        *region = VKDeviceMemoryRegion{ this, alignedSize, alignedOffset, memoryTypeIndex_ };
     }
-    return false;
-}
 
-VkDeviceSize VKDeviceMemory::GetFragmentBlockOffsetEnd(std::size_t position) const
-{
-    return fragmentedBlocks_[position]->GetOffsetWithSize();
+    /* Link region between previous region and its successor */
+    auto nextRegion = (prevRegion != nullptr ? prevRegion->nextPhysical_ : firstRegion_);
+
+    region->prevPhysical_ = prevRegion;
+    region->nextPhysical_ = nextRegion;
+
+    if (nextRegion != nullptr)
+        nextRegion->prevPhysical_ = region;
+
+    if (prevRegion != nullptr)
+        prevRegion->nextPhysical_ = region;
+    else
+        firstRegion_ = region;
+
+    return region;
 }
 
-void VKDeviceMemory::IncMaxFragmentedBlockSize(VkDeviceSize size)
+void VKDeviceMemory::MergeWithLowerRegion(VKDeviceMemoryRegion* region)
 {
-    maxFragmentedBlockSize_ = std::max(maxFragmentedBlockSize_, size);
+    auto lowerRegion = region->prevPhysical_;
+
+    /* Extend lower region and unlink the merged region */
+    lowerRegion->size_          += region->GetSize();
+    lowerRegion->nextPhysical_  = region->nextPhysical_;
+
+    if (region->nextPhysical_ != nullptr)
+        region->nextPhysical_->prevPhysical_ = lowerRegion;
+
+    /* Recycle region node */
+    unusedRegionNodes_.push_back(region);
 }
 
 
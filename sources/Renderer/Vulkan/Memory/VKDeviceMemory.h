@@ -25,7 +25,7 @@ namespace LLGL
 {
 
 
-// Details structure of VKDeviceMemory for debugging.
+// Details structure of VKDeviceMemory for debugging and memory statistics.
 struct VKDeviceMemoryDetails
 {
     std::size_t     numChunks               = 0;
@@ -33,9 +33,16 @@ struct VKDeviceMemoryDetails
     std::size_t     numFragments            = 0;
     VkDeviceSize    maxNewBlockSize         = 0;
     VkDeviceSize    maxFragmentedBlockSize  = 0;
+    VkDeviceSize    allocatedSize           = 0;
+    VkDeviceSize    usedSize                = 0;
+    VkDeviceSize    fragmentedSize          = 0;
 };
 
-// An instance of this class holds a single VkDeviceMemory allocation chunk.
+/*
+An instance of this class holds a single VkDeviceMemory allocation chunk.
+Blocks are sub-allocated with a two-level segregated fit (TLSF) allocator, i.e. allocation and release are done in constant time.
+All blocks (allocated and free ones) are linked in the order of their offsets, so that free blocks can be merged with their neighbours.
+*/
 class VKDeviceMemory
 {
 
@@ -46,9 +53,6 @@ class VKDeviceMemory
         VKDeviceMemory(const VKDeviceMemory&) = delete;
         VKDeviceMemory& operator = (const VKDeviceMemory&) = delete;
 
-        VKDeviceMemory(VKDeviceMemory&&) = default;
-        VKDeviceMemory& operator = (VKDeviceMemory&&) = default;
-
         void* Map(VkDevice device, VkDeviceSize offset, VkDeviceSize size);
         void Unmap(VkDevice device);
 
@@ -61,8 +65,11 @@ class VKDeviceMemory
         // Returns true if this device memory has no more blocks.
         bool IsEmpty() const;
 
-        // Returns the maximal size that can be allocated for a device memory region within this device memory chunk.
-        VkDeviceSize GetMaxAllocationSize() const;
+        // Sets the residency priority of the specified block within this device memory chunk.
+        void SetBlockPriority(VKDeviceMemoryRegion* region, ResidencyPriority priority);
+
+        // Returns the highest residency priority of all blocks within this device memory chunk.
+        ResidencyPriority GetMaxBlockPriority() const;
 
         // Accumulates the memory details of this device memory into the output structure.
         void AccumDetails(VKDeviceMemoryDetails& details) const;
@@ -86,56 +93,105 @@ class VKDeviceMemory
             return size_;
         }
 
+        // Returns the number of bytes that are currently allocated by blocks within this chunk.
+        inline VkDeviceSize GetUsedSize() const
+        {
+            return usedSize_;
+        }
+
         // Returns the memory type index that was passed this device memory chunk was constructed.
         inline std::uint32_t GetMemoryTypeIndex() const
         {
             return memoryTypeIndex_;
         }
 
+        // Returns the first region of this chunk in the order of offsets. This includes both allocated and free blocks.
+        inline const VKDeviceMemoryRegion* GetFirstRegion() const
+        {
+            return firstRegion_;
+        }
+
+        // Returns true if this device memory chunk is currently mapped into CPU memory space.
+        inline bool IsMapped() const
+        {
+            return isMapped_;
+        }
+
+        // Stores the residency priority that was last set for the native device memory with vkSetDeviceMemoryPriorityEXT.
+        inline void SetResidencyPriority(ResidencyPriority priority)
+        {
+            priority_ = priority;
+        }
+
+        // Returns the residency priority that was last set for the native device memory.
+        inline ResidencyPriority GetResidencyPriority() const
+        {
+            return priority_;
+        }
+
     private:
 
-        // Returns the next offset after the last block.
-        VkDeviceSize GetNextOffset() const;
+        // Number of second-level lists per first-level list as binary logarithm.
+        static const std::uint32_t slCountLog2 = 5;
+
+        // Number of second-level lists per first-level list.
+        static const std::uint32_t slCount = (1u << slCountLog2);
 
-        // Makes a new device memory block.
-        std::unique_ptr<VKDeviceMemoryRegion> MakeUniqueBlock(VkDeviceSize alignedSize, VkDeviceSize alignedOffset);
+        // Number of first-level lists, i.e. one for each power of two of a 64-bit size.
+        static const std::uint32_t flCount = 64 - slCountLog2 + 1;
 
-        // Allocates a new block.
-        VKDeviceMemoryRegion* AllocAndAppendBlock(VkDeviceSize alignedSize, VkDeviceSize alignedOffset);
+        // Number of residency priorities.
+        static const std::uint32_t priorityCount = static_cast<std::uint32_t>(ResidencyPriority::Maximum) + 1;
 
-        // Inserts the specified region into the main block list by insertion-sort.
-        VKDeviceMemoryRegion* InsertBlock(std::unique_ptr<VKDeviceMemoryRegion>&& region);
+    private:
 
-        // Tries to find a fragmented block that can be reused.
-        VKDeviceMemoryRegion* FindReusableBlock(VkDeviceSize alignedSize, VkDeviceSize alignment);
+        // Returns the first- and second-level list indices the specified block size belongs to.
+        static void MapSizeToIndices(VkDeviceSize size, std::uint32_t& fl, std::uint32_t& sl);
 
-        // Updates the maximal size of fragmanted blocks.
-        void UpdateMaxFragmentedBlockSize();
+        // Returns the first- and second-level list indices that only contain blocks of equal or greater size than the specified one.
+        static void MapSizeToIndicesRoundUp(VkDeviceSize size, std::uint32_t& fl, std::uint32_t& sl);
 
-        // Inserts the specified region into the fragmented block list by insertion-sort.
-        void InsertBlockToFragmentsSorted(std::unique_ptr<VKDeviceMemoryRegion>&& region);
+        // Returns a free block that is at least of the specified size, or null if there is no such block.
+        VKDeviceMemoryRegion* FindFreeBlock(VkDeviceSize size) const;
 
-        // Inserts the specified region into the fragmented block list at the specified position and merges it with surrounding blocks if possible.
-        void InsertBlockToFragmentsAt(std::unique_ptr<VKDeviceMemoryRegion>&& region, std::size_t position);
+        // Returns a free block within the list of the specified size that can hold the specified size with its alignment, or null if there is no such block.
+        VKDeviceMemoryRegion* FindFreeBlockInSameList(VkDeviceSize alignedSize, VkDeviceSize alignment) const;
 
-        // Merges the two fragmented blocks and records the maximal fragmented block size.
-        bool MergeFragmentedBlockWith(VKDeviceMemoryRegion& region, VKDeviceMemoryRegion& appendixRegion);
+        // Inserts the specified block into the segregated free lists.
+        void InsertFreeBlock(VKDeviceMemoryRegion* region);
 
-        // Returns the offset after the specified fragmented block.
-        VkDeviceSize GetFragmentBlockOffsetEnd(std::size_t position) const;
+        // Removes the specified block from the segregated free lists.
+        void RemoveFreeBlock(VKDeviceMemoryRegion* region);
 
-        // Increases the maximal fragmented block size.
-        void IncMaxFragmentedBlockSize(VkDeviceSize size);
+        // Allocates the specified free block and splits off the unused lower and upper parts.
+        VKDeviceMemoryRegion* AllocFreeBlock(VKDeviceMemoryRegion* region, VkDeviceSize alignedSize, VkDeviceSize alignedOffset);
+
+        // Makes a new region node after the specified region, or at the beginning if 'prevRegion' is null.
+        VKDeviceMemoryRegion* MakeRegionAfter(VKDeviceMemoryRegion* prevRegion, VkDeviceSize alignedSize, VkDeviceSize alignedOffset);
+
+        // Merges the specified region into its lower neighbour and recycles its node.
+        void MergeWithLowerRegion(VKDeviceMemoryRegion* region);
+
+    private:
 
         VKPtr<VkDeviceMemory>                               deviceMemory_;
         VkDeviceSize                                        size_                   = 0;
+        VkDeviceSize                                        usedSize_               = 0;
         std::uint32_t                                       memoryTypeIndex_        = 0;
+        std::size_t                                         numBlocks_              = 0;
+        bool                                                isMapped_               = false;
+
+        std::uint32_t                                       numBlocksPerPriority_[priorityCount] = {};
+        ResidencyPriority                                   priority_               = ResidencyPriority::Normal;
+
+        VKDeviceMemoryRegion*                               firstRegion_            = nullptr;
 
-        VkDeviceSize                                        maxNewBlockSize_        = 0;
-        std::vector<std::unique_ptr<VKDeviceMemoryRegion>>  blocks_;
+        std::uint64_t                                       flBitmap_               = 0;
+        std::uint32_t                                       slBitmaps_[flCount]     = {};
+        VKDeviceMemoryRegion*                               freeLists_[flCount][slCount] = {};
 
-        VkDeviceSize                                        maxFragmentedBlockSize_ = 0;
-        std::vector<std::unique_ptr<VKDeviceMemoryRegion>>  fragmentedBlocks_;
+        std::vector<std::unique_ptr<VKDeviceMemoryRegion>>  regionNodes_;
+        std::vector<VKDeviceMemoryRegion*>                  unusedRegionNodes_;
 
 };
 
@@ -6,8 +6,11 @@
  */
 
 #include "VKDeviceMemoryManager.h"
+#include "../Buffer/VKDeviceBuffer.h"
 #include "../VKCore.h"
+#include "../Ext/VKExtensions.h"
 #include "../../../Core/Helper.h"
+#include <LLGL/Container/SmallVector.h>
 
 
 namespace LLGL
@@ -18,12 +21,14 @@ VKDeviceMemoryManager::VKDeviceMemoryManager(
     const VKPtr<VkDevice>&                  device,
     const VkPhysicalDeviceMemoryProperties& memoryProperties,
     VkDeviceSize                            minAllocationSize,
-    bool                                    reduceFragmentation)
+    bool                                    reduceFragmentation,
+    bool                                    pageableDeviceLocalMemory)
 :
-    device_              { device              },
-    memoryProperties_    { memoryProperties    },
-    minAllocationSize_   { minAllocationSize   },
-    reduceFragmentation_ { reduceFragmentation }
+    device_                    { device                    },
+    memoryProperties_          { memoryProperties          },
+    minAllocationSize_         { minAllocationSize         },
+    reduceFragmentation_       { reduceFragmentation       },
+    pageableDeviceLocalMemory_ { pageableDeviceLocalMemory }
 {
 }
 
@@ -35,12 +40,19 @@ VKDeviceMemoryRegion* VKDeviceMemoryManager::Allocate(
 {
     const auto alignedSize      = GetAlignedSize(size, alignment);
     const auto memoryTypeIndex  = FindMemoryType(memoryTypeBits, properties);
-    const auto allocationSize   = std::max(minAllocationSize_, alignedSize);
 
-    if (auto chunk = FindOrAllocChunk(allocationSize, memoryTypeIndex, alignedSize))
-        return chunk->Allocate(size, alignment);
-    else
-        return nullptr;
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    /* Try to allocate block in one of the chunks with the same memory type */
+    for (const auto& chunk : chunks_[memoryTypeIndex])
+    {
+        if (auto region = chunk->Allocate(size, alignment, reduceFragmentation_))
+            return region;
+    }
+
+    /* Allocate new chunk */
+    const auto allocationSize = std::max(minAllocationSize_, alignedSize);
+    return AllocChunk(allocationSize, memoryTypeIndex)->Allocate(size, alignment, reduceFragmentation_);
 }
 
 VKDeviceMemoryRegion* VKDeviceMemoryManager::Allocate(
@@ -59,59 +71,170 @@ void VKDeviceMemoryManager::Release(VKDeviceMemoryRegion* region)
 {
     if (region)
     {
+        std::lock_guard<std::mutex> guard{ mutex_ };
         if (auto chunk = region->GetParentChunk())
         {
             /* Release block in chunk */
             chunk->Release(region);
 
             /* Release chunk if it's empty */
-            if (chunk->IsEmpty())
+            ReleaseChunkIfEmpty(chunk);
+        }
+    }
+}
+
+bool VKDeviceMemoryManager::HasMemoryType(std::uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) const
+{
+    for (std::uint32_t i = 0; i < memoryProperties_.memoryTypeCount; ++i)
+    {
+        if ((memoryTypeBits & (1 << i)) != 0 && (memoryProperties_.memoryTypes[i].propertyFlags & properties) == properties)
+            return true;
+    }
+    return false;
+}
+
+// Returns the index of the memory type with the specified properties that has the largest heap, or VK_MAX_MEMORY_TYPES if there is none.
+static std::uint32_t FindMemoryTypeWithLargestHeap(
+    const VkPhysicalDeviceMemoryProperties& memoryProperties,
+    std::uint32_t                           memoryTypeBits,
+    VkMemoryPropertyFlags                   properties)
+{
+    std::uint32_t   memoryTypeIndex = VK_MAX_MEMORY_TYPES;
+    VkDeviceSize    heapSize        = 0;
+
+    for (std::uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i)
+    {
+        const auto& memoryType = memoryProperties.memoryTypes[i];
+        if ((memoryTypeBits & (1 << i)) != 0 && (memoryType.propertyFlags & properties) == properties)
+        {
+            if (memoryTypeIndex == VK_MAX_MEMORY_TYPES || memoryProperties.memoryHeaps[memoryType.heapIndex].size > heapSize)
             {
-                RemoveFromListIf(
-                    chunks_,
-                    [chunk](std::unique_ptr<VKDeviceMemory>& entry)
-                    {
-                        return (entry.get() == chunk);
-                    }
-                );
+                memoryTypeIndex = i;
+                heapSize        = memoryProperties.memoryHeaps[memoryType.heapIndex].size;
             }
         }
     }
+
+    return memoryTypeIndex;
+}
+
+bool VKDeviceMemoryManager::HasHostVisibleDeviceLocalMemory(std::uint32_t memoryTypeBits) const
+{
+    const auto memoryTypeIndex = FindMemoryTypeWithLargestHeap(
+        memoryProperties_,
+        memoryTypeBits,
+        (VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+    );
+
+    if (memoryTypeIndex == VK_MAX_MEMORY_TYPES)
+        return false;
+
+    /* Without ReBAR/SAM, host-visible device memory is only a small window (usually 256 MB) into a separate heap */
+    const auto heapSize = memoryProperties_.memoryHeaps[memoryProperties_.memoryTypes[memoryTypeIndex].heapIndex].size;
+    for (std::uint32_t i = 0; i < memoryProperties_.memoryHeapCount; ++i)
+    {
+        const auto& heap = memoryProperties_.memoryHeaps[i];
+        if ((heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0 && heap.size > heapSize)
+            return false;
+    }
+
+    return true;
 }
 
 VKDeviceMemoryDetails VKDeviceMemoryManager::QueryDetails() const
 {
+    std::lock_guard<std::mutex> guard{ mutex_ };
     VKDeviceMemoryDetails details;
     {
-        for (const auto& chunk : chunks_)
-            chunk->AccumDetails(details);
+        for (const auto& chunks : chunks_)
+        {
+            for (const auto& chunk : chunks)
+                chunk->AccumDetails(details);
+        }
+    }
+    return details;
+}
+
+VKDeviceMemoryDetails VKDeviceMemoryManager::QueryHeapDetails(std::uint32_t memoryHeapIndex) const
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    VKDeviceMemoryDetails details;
+    {
+        for (std::uint32_t i = 0; i < memoryProperties_.memoryTypeCount; ++i)
+        {
+            if (memoryProperties_.memoryTypes[i].heapIndex == memoryHeapIndex)
+            {
+                for (const auto& chunk : chunks_[i])
+                    chunk->AccumDetails(details);
+            }
+        }
     }
     return details;
 }
 
+VkDeviceSize VKDeviceMemoryManager::Defragment(VkDeviceSize maxBytesToMove)
+{
+    VkDeviceSize numBytesMoved = 0;
+
+    if (reduceFragmentation_)
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+
+        /* Only host-coherent memory can be relocated by the CPU without recording any copy commands */
+        const VkMemoryPropertyFlags requiredProperties = (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+        for (std::uint32_t i = 0; i < memoryProperties_.memoryTypeCount && numBytesMoved < maxBytesToMove; ++i)
+        {
+            if ((memoryProperties_.memoryTypes[i].propertyFlags & requiredProperties) == requiredProperties)
+                numBytesMoved += DefragmentMemoryType(i, maxBytesToMove - numBytesMoved);
+        }
+    }
+
+    return numBytesMoved;
+}
+
+bool VKDeviceMemoryManager::SetResidencyPriority(VKDeviceMemoryRegion* region, ResidencyPriority priority)
+{
+    if (!pageableDeviceLocalMemory_)
+        return false;
+
+    if (region != nullptr)
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        UpdateBlockPriority(region, priority);
+    }
+
+    return true;
+}
+
 #ifdef LLGL_DEBUG
 
 void VKDeviceMemoryManager::PrintBlocks(std::ostream& s, const std::string& title) const
 {
+    std::lock_guard<std::mutex> guard{ mutex_ };
     std::size_t i = 0;
-    for (const auto& chunk : chunks_)
+    for (const auto& chunks : chunks_)
     {
-        s << "chunk[" << (i++) << "]:";
+        for (const auto& chunk : chunks)
+        {
+            s << "chunk[" << (i++) << "]:";
 
-        if (!title.empty())
-            s << " \"" << title << '\"';
+            if (!title.empty())
+                s << " \"" << title << '\"';
 
-        s << '\n';
-        s << "  size             = " << chunk->GetSize() << '\n';
-        s << "  memoryTypeIndex  = " << chunk->GetMemoryTypeIndex() << '\n';
+            s << '\n';
+            s << "  size             = " << chunk->GetSize() << '\n';
+            s << "  usedSize         = " << chunk->GetUsedSize() << '\n';
+            s << "  memoryTypeIndex  = " << chunk->GetMemoryTypeIndex() << '\n';
 
-        s << "  blocks           = ";
-        chunk->PrintBlocks(s);
-        s << '\n';
+            s << "  blocks           = ";
+            chunk->PrintBlocks(s);
+            s << '\n';
 
-        s << "  fragmentedBlocks = ";
-        chunk->PrintFragmentedBlocks(s);
-        s << '\n';
+            s << "  fragmentedBlocks = ";
+            chunk->PrintFragmentedBlocks(s);
+            s << '\n';
+        }
     }
 }
 
@@ -124,25 +247,137 @@ void VKDeviceMemoryManager::PrintBlocks(std::ostream& s, const std::string& titl
 
 std::uint32_t VKDeviceMemoryManager::FindMemoryType(std::uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) const
 {
+    /* Prefer a full-size VRAM heap (ReBAR/SAM) over a small BAR window for host-visible device memory */
+    const VkMemoryPropertyFlags hostVisibleDeviceLocal = (VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+    if ((properties & hostVisibleDeviceLocal) == hostVisibleDeviceLocal)
+    {
+        const auto memoryTypeIndex = FindMemoryTypeWithLargestHeap(memoryProperties_, memoryTypeBits, properties);
+        if (memoryTypeIndex != VK_MAX_MEMORY_TYPES)
+            return memoryTypeIndex;
+    }
     return VKFindMemoryType(memoryProperties_, memoryTypeBits, properties);
 }
 
 VKDeviceMemory* VKDeviceMemoryManager::AllocChunk(VkDeviceSize size, std::uint32_t memoryTypeIndex)
 {
-    return TakeOwnership(chunks_, MakeUnique<VKDeviceMemory>(device_, size, memoryTypeIndex));
+    return TakeOwnership(chunks_[memoryTypeIndex], MakeUnique<VKDeviceMemory>(device_, size, memoryTypeIndex));
 }
 
-VKDeviceMemory* VKDeviceMemoryManager::FindOrAllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex, VkDeviceSize minFreeBlockSize)
+void VKDeviceMemoryManager::ReleaseChunkIfEmpty(VKDeviceMemory* chunk)
 {
-    /* Search for a suitable chunk */
-    for (const auto& chunk : chunks_)
+    if (chunk->IsEmpty())
     {
-        if (chunk->GetMaxAllocationSize() >= minFreeBlockSize && chunk->GetMemoryTypeIndex() == memoryTypeIndex)
-            return chunk.get();
+        RemoveFromListIf(
+            chunks_[chunk->GetMemoryTypeIndex()],
+            [chunk](std::unique_ptr<VKDeviceMemory>& entry)
+            {
+                return (entry.get() == chunk);
+            }
+        );
     }
+}
 
-    /* Allocate new chunk */
-    return AllocChunk(allocationSize, memoryTypeIndex);
+VkDeviceSize VKDeviceMemoryManager::DefragmentMemoryType(std::uint32_t memoryTypeIndex, VkDeviceSize maxBytesToMove)
+{
+    auto& chunks = chunks_[memoryTypeIndex];
+    if (chunks.size() < 2)
+        return 0;
+
+    /* Select the least used chunk as source, but skip chunks that are currently mapped */
+    VKDeviceMemory* srcChunk = nullptr;
+    for (const auto& chunk : chunks)
+    {
+        if (!chunk->IsMapped() && (srcChunk == nullptr || chunk->GetUsedSize() < srcChunk->GetUsedSize()))
+            srcChunk = chunk.get();
+    }
+
+    /* Only evacuate chunks that are at most half full */
+    if (srcChunk == nullptr || srcChunk->GetUsedSize() * 2 > srcChunk->GetSize())
+        return 0;
+
+    /* Gather owners of all blocks first, since relocation modifies the region list of the source chunk */
+    SmallVector<VKDeviceBuffer*, 16> owners;
+    for (auto region = srcChunk->GetFirstRegion(); region != nullptr; region = region->GetNextRegion())
+    {
+        if (!region->IsFree())
+        {
+            /* Chunk cannot be released if any of its blocks cannot be relocated */
+            if (auto owner = region->GetRelocatableOwner())
+                owners.push_back(owner);
+            else
+                return 0;
+        }
+    }
+
+    VkDeviceSize numBytesMoved = 0;
+
+    for (auto owner : owners)
+    {
+        auto srcRegion = owner->GetMemoryRegion();
+        const auto srcRegionSize = srcRegion->GetSize();
+
+        if (numBytesMoved + srcRegionSize > maxBytesToMove)
+            break;
+
+        /* Allocate destination block in any other chunk that is currently not mapped */
+        const auto& requirements = owner->GetRequirements();
+        VKDeviceMemoryRegion* dstRegion = nullptr;
+
+        for (const auto& chunk : chunks)
+        {
+            if (chunk.get() != srcChunk && !chunk->IsMapped())
+            {
+                dstRegion = chunk->Allocate(requirements.size, requirements.alignment, reduceFragmentation_);
+                if (dstRegion != nullptr)
+                    break;
+            }
+        }
+
+        if (dstRegion == nullptr)
+            break;
+
+        /* Move buffer into destination block and release the source block; the destination block keeps the residency priority of the source block */
+        owner->RelocateMemoryRegion(device_, dstRegion);
+        if (pageableDeviceLocalMemory_)
+            UpdateBlockPriority(dstRegion, srcRegion->GetResidencyPriority());
+        srcChunk->Release(srcRegion);
+        numBytesMoved += srcRegionSize;
+    }
+
+    /* Release source chunk if all blocks have been relocated */
+    ReleaseChunkIfEmpty(srcChunk);
+
+    return numBytesMoved;
+}
+
+// Returns the priority value for vkSetDeviceMemoryPriorityEXT in the range [0, 1]. The default priority of all allocations is 0.5.
+static float GetDeviceMemoryPriority(ResidencyPriority priority)
+{
+    switch (priority)
+    {
+        case ResidencyPriority::Minimum:    return 0.0f;
+        case ResidencyPriority::Low:        return 0.25f;
+        case ResidencyPriority::Normal:     return 0.5f;
+        case ResidencyPriority::High:       return 0.75f;
+        case ResidencyPriority::Maximum:    return 1.0f;
+    }
+    return 0.5f;
+}
+
+void VKDeviceMemoryManager::UpdateBlockPriority(VKDeviceMemoryRegion* region, ResidencyPriority priority)
+{
+    if (auto chunk = region->GetParentChunk())
+    {
+        chunk->SetBlockPriority(region, priority);
+
+        /* Only change priority of the device memory if the highest priority of its blocks has changed */
+        const ResidencyPriority chunkPriority = chunk->GetMaxBlockPriority();
+        if (chunkPriority != chunk->GetResidencyPriority())
+        {
+            vkSetDeviceMemoryPriorityEXT(device_, chunk->GetVkDeviceMemory(), GetDeviceMemoryPriority(chunkPriority));
+            chunk->SetResidencyPriority(chunkPriority);
+        }
+    }
 }
 
 
@@ -16,6 +16,7 @@
 #include "VKDeviceMemoryRegion.h"
 #include <vector>
 #include <memory>
+#include <mutex>
 
 
 namespace LLGL
@@ -27,6 +28,8 @@ Vulkan device memory manager. Memory allocations are stored in a small hierarchy
  - Chunk: denotes a single Vulkan memory allocation of type VkDeviceMemory
  - Block: denotes one of multiple regions inside a chunk of type VkBuffer
  - Region: denotes a sub-range inside a block and holds a reference to the VkBuffer and its offset and size (both of type VkDeviceSize).
+Chunks are kept in separate lists for each memory type, and each chunk sub-allocates its blocks in constant time (see VKDeviceMemory).
+All public functions are guarded by a mutex, so resources can be allocated and released from multiple threads.
 */
 class VKDeviceMemoryManager
 {
@@ -37,7 +40,8 @@ class VKDeviceMemoryManager
             const VKPtr<VkDevice>&                  device,
             const VkPhysicalDeviceMemoryProperties& memoryProperties,
             VkDeviceSize                            minAllocationSize,
-            bool                                    reduceFragmentation
+            bool                                    reduceFragmentation,
+            bool                                    pageableDeviceLocalMemory   = false
         );
 
         VKDeviceMemoryManager(const VKDeviceMemoryManager&) = delete;
@@ -60,9 +64,38 @@ class VKDeviceMemoryManager
         // Releases the specified device memory block.
         void Release(VKDeviceMemoryRegion* region);
 
+        // Returns true if there is a memory type with the specified memory type bits and properties.
+        bool HasMemoryType(std::uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) const;
+
+        // Finds a memory type index for the specified attributes. Host-visible device-local memory prefers the memory type with the largest heap.
+        std::uint32_t FindMemoryType(std::uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) const;
+
+        /*
+        Returns true if there is a device-local, host-visible, and host-coherent memory type with the specified memory type bits,
+        whose heap spans the entire device-local memory, i.e. resizable BAR (ReBAR) or Smart Access Memory (SAM) is enabled.
+        Such memory can be written by the CPU directly, without a staging buffer.
+        */
+        bool HasHostVisibleDeviceLocalMemory(std::uint32_t memoryTypeBits) const;
+
         // Queries the memory details of all chunks.
         VKDeviceMemoryDetails QueryDetails() const;
 
+        // Queries the memory details of all chunks whose memory type belongs to the specified memory heap.
+        VKDeviceMemoryDetails QueryHeapDetails(std::uint32_t memoryHeapIndex) const;
+
+        /*
+        Relocates memory regions of the least used chunks into other chunks of the same memory type, so that those chunks can be released.
+        Only regions with a relocatable owner within host-visible and host-coherent memory are moved and only if fragmentation reduction is enabled.
+        Returns the number of bytes that have been moved, which is limited by 'maxBytesToMove'.
+        */
+        VkDeviceSize Defragment(VkDeviceSize maxBytesToMove);
+
+        /*
+        Sets the residency priority of the specified memory region. Since priorities can only be set for entire VkDeviceMemory objects,
+        each chunk takes the highest priority of all its blocks. Returns false if the "VK_EXT_pageable_device_local_memory" extension is not enabled.
+        */
+        bool SetResidencyPriority(VKDeviceMemoryRegion* region, ResidencyPriority priority);
+
         #ifdef LLGL_DEBUG
 
         void PrintBlocks(std::ostream& s, const std::string& title = "") const;
@@ -77,24 +110,31 @@ class VKDeviceMemoryManager
 
     private:
 
-        // Finds a memory type index for the specified attributes.
-        std::uint32_t FindMemoryType(std::uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) const;
-
         // Allocates a new VkDeviceMemory chunk of the specified size and memory type.
         VKDeviceMemory* AllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex);
 
-        // Finds a suitable device memory chunk or allocates a new one.
-        VKDeviceMemory* FindOrAllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex, VkDeviceSize minFreeBlockSize);
+        // Releases the specified chunk if it no longer has any blocks.
+        void ReleaseChunkIfEmpty(VKDeviceMemory* chunk);
+
+        // Relocates the regions of the least used chunk of the specified memory type and returns the number of moved bytes.
+        VkDeviceSize DefragmentMemoryType(std::uint32_t memoryTypeIndex, VkDeviceSize maxBytesToMove);
+
+        // Sets the residency priority of the specified block and updates the priority of its chunk if the highest priority of its blocks has changed.
+        void UpdateBlockPriority(VKDeviceMemoryRegion* region, ResidencyPriority priority);
 
     private:
 
+        using VKDeviceMemoryChunkList = std::vector<std::unique_ptr<VKDeviceMemory>>;
+
         const VKPtr<VkDevice>&                          device_;
         VkPhysicalDeviceMemoryProperties                memoryProperties_;
 
-        VkDeviceSize                                    minAllocationSize_      = 1024*1024;
-        bool                                            reduceFragmentation_    = false;
+        VkDeviceSize                                    minAllocationSize_          = 1024*1024;
+        bool                                            reduceFragmentation_        = false;
+        bool                                            pageableDeviceLocalMemory_  = false;
 
-        std::vector<std::unique_ptr<VKDeviceMemory>>    chunks_;
+        VKDeviceMemoryChunkList                         chunks_[VK_MAX_MEMORY_TYPES];
+        mutable std::mutex                              mutex_;
 
 };
 
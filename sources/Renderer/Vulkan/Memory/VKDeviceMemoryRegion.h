@@ -9,6 +9,7 @@
 #define LLGL_VK_DEVICE_MEMORY_REGION_H
 
 
+#include <LLGL/RenderSystemFlags.h>
 #include <vulkan/vulkan.h>
 #include <cstdint>
 
@@ -18,6 +19,7 @@ namespace LLGL
 
 
 class VKDeviceMemory;
+class VKDeviceBuffer;
 
 // An instance of this class represents an atomic region within a VkDeviceMemory allocation.
 class VKDeviceMemoryRegion
@@ -63,22 +65,60 @@ class VKDeviceMemoryRegion
             return memoryTypeIndex_;
         }
 
+        // Returns the next region within the same chunk in the order of offsets, or null if this is the last one.
+        inline const VKDeviceMemoryRegion* GetNextRegion() const
+        {
+            return nextPhysical_;
+        }
+
+        // Returns true if this region is currently not allocated by any resource.
+        inline bool IsFree() const
+        {
+            return isFree_;
+        }
+
+        // Sets the device buffer that can be relocated with this region when device memory is defragmented. By default null.
+        inline void SetRelocatableOwner(VKDeviceBuffer* owner)
+        {
+            relocatableOwner_ = owner;
+        }
+
+        // Returns the device buffer that can be relocated with this region, or null if this region is not relocatable.
+        inline VKDeviceBuffer* GetRelocatableOwner() const
+        {
+            return relocatableOwner_;
+        }
+
+        // Returns the residency priority of this region. By default ResidencyPriority::Normal.
+        inline ResidencyPriority GetResidencyPriority() const
+        {
+            return priority_;
+        }
+
     protected:
 
         friend class VKDeviceMemory;
 
-        // Tries to merge the specified region into this region, and returns true on success.
-        bool MergeWith(VKDeviceMemoryRegion& other);
-
         // Sets the new size and offset.
         void MoveAt(VkDeviceSize alignedSize, VkDeviceSize alignedOffset);
 
     private:
 
-        VKDeviceMemory* deviceMemory_       = nullptr;
-        VkDeviceSize    size_               = 0;
-        VkDeviceSize    offset_             = 0;
-        std::uint32_t   memoryTypeIndex_    = 0;
+        VKDeviceMemory*         deviceMemory_       = nullptr;
+        VkDeviceSize            size_               = 0;
+        VkDeviceSize            offset_             = 0;
+        std::uint32_t           memoryTypeIndex_    = 0;
+        bool                    isFree_             = true;
+        VKDeviceBuffer*         relocatableOwner_   = nullptr;
+        ResidencyPriority       priority_           = ResidencyPriority::Normal;
+
+        /* Physically adjacent regions within the same chunk (sorted by offset) */
+        VKDeviceMemoryRegion*   prevPhysical_       = nullptr;
+        VKDeviceMemoryRegion*   nextPhysical_       = nullptr;
+
+        /* Neighbours within the segregated free list (only used while the region is free) */
+        VKDeviceMemoryRegion*   prevFree_           = nullptr;
+        VKDeviceMemoryRegion*   nextFree_           = nullptr;
 
 };
 
@@ -0,0 +1,207 @@
+/*
+ * VKExternalMemory.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKExternalMemory.h"
+#include "../VKCore.h"
+#include "../Ext/VKExtensions.h"
+#include "../Ext/VKExtensionRegistry.h"
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+VkExternalMemoryHandleTypeFlagBits VKGetExportMemoryHandleType()
+{
+    #ifdef LLGL_OS_WIN32
+    return VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_WIN32_BIT;
+    #else
+    return VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT;
+    #endif
+}
+
+VkExternalMemoryHandleTypeFlags VKGetImportMemoryHandleType(NativeHandleType handleType)
+{
+    switch (handleType)
+    {
+        #ifdef LLGL_OS_WIN32
+        case NativeHandleType::OpaqueWin32:         return VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_WIN32_BIT;
+        case NativeHandleType::D3D12SharedHandle:   return VK_EXTERNAL_MEMORY_HANDLE_TYPE_D3D12_RESOURCE_BIT;
+        #else
+        case NativeHandleType::OpaqueFD:            return VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT;
+        #endif
+        default:                                    return 0;
+    }
+}
+
+VKExternalMemory::VKExternalMemory(const VKPtr<VkDevice>& device) :
+    device_ { device                 },
+    memory_ { device, vkFreeMemory   }
+{
+}
+
+void VKExternalMemory::AllocateAndBind(
+    const VkMemoryRequirements& requirements,
+    std::uint32_t               memoryTypeIndex,
+    VkImage                     image,
+    VkBuffer                    buffer)
+{
+    exportTypes_ = VKGetExportMemoryHandleType();
+
+    VkExportMemoryAllocateInfo exportInfo;
+    {
+        exportInfo.sType        = VK_STRUCTURE_TYPE_EXPORT_MEMORY_ALLOCATE_INFO;
+        exportInfo.pNext        = nullptr;
+        exportInfo.handleTypes  = exportTypes_;
+    }
+    AllocateAndBindWithChain(&exportInfo, requirements.size, memoryTypeIndex, image, buffer);
+}
+
+void VKExternalMemory::ImportAndBind(
+    const NativeResourceHandle& sharedHandle,
+    const VkMemoryRequirements& requirements,
+    std::uint32_t               memoryTypeIndex,
+    VkImage                     image,
+    VkBuffer                    buffer)
+{
+    const auto handleType   = static_cast<VkExternalMemoryHandleTypeFlagBits>(VKGetImportMemoryHandleType(sharedHandle.type));
+    const auto size         = std::max(static_cast<VkDeviceSize>(sharedHandle.memorySize), requirements.size);
+
+    if (handleType == 0)
+        throw std::invalid_argument("cannot import Vulkan device memory from native handle that is not a shared handle of this platform");
+
+    #ifdef LLGL_OS_WIN32
+
+    VkImportMemoryWin32HandleInfoKHR importInfo;
+    {
+        importInfo.sType        = VK_STRUCTURE_TYPE_IMPORT_MEMORY_WIN32_HANDLE_INFO_KHR;
+        importInfo.pNext        = nullptr;
+        importInfo.handleType   = handleType;
+        importInfo.handle       = reinterpret_cast<HANDLE>(static_cast<std::uintptr_t>(sharedHandle.object));
+        importInfo.name         = nullptr;
+    }
+
+    #else
+
+    /* The file descriptor is owned by the Vulkan implementation once it has been imported successfully */
+    VkImportMemoryFdInfoKHR importInfo;
+    {
+        importInfo.sType        = VK_STRUCTURE_TYPE_IMPORT_MEMORY_FD_INFO_KHR;
+        importInfo.pNext        = nullptr;
+        importInfo.handleType   = handleType;
+        importInfo.fd           = static_cast<int>(sharedHandle.object);
+    }
+
+    #endif // /LLGL_OS_WIN32
+
+    AllocateAndBindWithChain(&importInfo, size, memoryTypeIndex, image, buffer);
+}
+
+bool VKExternalMemory::Export(NativeHandleType handleType, NativeResourceHandle& outHandle) const
+{
+    const auto exportType = VKGetExportMemoryHandleType();
+    if ((exportTypes_ & exportType) == 0)
+        return false;
+
+    #ifdef LLGL_OS_WIN32
+
+    if (handleType != NativeHandleType::OpaqueWin32 || !HasExtension(VKExt::KHR_external_memory_win32))
+        return false;
+
+    VkMemoryGetWin32HandleInfoKHR getInfo;
+    {
+        getInfo.sType       = VK_STRUCTURE_TYPE_MEMORY_GET_WIN32_HANDLE_INFO_KHR;
+        getInfo.pNext       = nullptr;
+        getInfo.memory      = memory_;
+        getInfo.handleType  = exportType;
+    }
+    HANDLE handle = nullptr;
+    if (vkGetMemoryWin32HandleKHR(device_, &getInfo, &handle) != VK_SUCCESS)
+        return false;
+
+    outHandle.object = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(handle));
+
+    #else
+
+    if (handleType != NativeHandleType::OpaqueFD || !HasExtension(VKExt::KHR_external_memory_fd))
+        return false;
+
+    VkMemoryGetFdInfoKHR getInfo;
+    {
+        getInfo.sType       = VK_STRUCTURE_TYPE_MEMORY_GET_FD_INFO_KHR;
+        getInfo.pNext       = nullptr;
+        getInfo.memory      = memory_;
+        getInfo.handleType  = exportType;
+    }
+    int fd = -1;
+    if (vkGetMemoryFdKHR(device_, &getInfo, &fd) != VK_SUCCESS)
+        return false;
+
+    outHandle.object = static_cast<std::uint64_t>(fd);
+
+    #endif // /LLGL_OS_WIN32
+
+    outHandle.type          = handleType;
+    outHandle.memory        = 0;
+    outHandle.memoryOffset  = 0;
+    outHandle.memorySize    = size_;
+
+    return true;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void VKExternalMemory::AllocateAndBindWithChain(
+    const void*                 next,
+    VkDeviceSize                size,
+    std::uint32_t               memoryTypeIndex,
+    VkImage                     image,
+    VkBuffer                    buffer)
+{
+    /* Allocate memory exclusively for this resource if "VK_KHR_dedicated_allocation" is available (required for imported Direct3D 12 resources) */
+    VkMemoryDedicatedAllocateInfo dedicatedInfo;
+    if (HasExtension(VKExt::KHR_dedicated_allocation))
+    {
+        dedicatedInfo.sType     = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO;
+        dedicatedInfo.pNext     = next;
+        dedicatedInfo.image     = image;
+        dedicatedInfo.buffer    = buffer;
+        next = &dedicatedInfo;
+    }
+
+    VkMemoryAllocateInfo allocInfo;
+    {
+        allocInfo.sType             = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.pNext             = next;
+        allocInfo.allocationSize    = size;
+        allocInfo.memoryTypeIndex   = memoryTypeIndex;
+    }
+    auto result = vkAllocateMemory(device_, &allocInfo, nullptr, memory_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to allocate external Vulkan device memory");
+
+    size_ = size;
+
+    /* Bind resource to the beginning of the dedicated memory */
+    if (image != VK_NULL_HANDLE)
+        result = vkBindImageMemory(device_, image, memory_, 0);
+    else
+        result = vkBindBufferMemory(device_, buffer, memory_, 0);
+
+    VKThrowIfFailed(result, "failed to bind external Vulkan device memory");
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
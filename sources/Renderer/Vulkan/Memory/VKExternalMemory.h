@@ -0,0 +1,117 @@
+/*
+ * VKExternalMemory.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_EXTERNAL_MEMORY_H
+#define LLGL_VK_EXTERNAL_MEMORY_H
+
+
+#include "../Vulkan.h"
+#include "../VKPtr.h"
+#include <LLGL/ResourceFlags.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+// Returns the external memory handle type that is exported on this platform, i.e. opaque Win32 handles on Windows and opaque file descriptors otherwise.
+VkExternalMemoryHandleTypeFlagBits VKGetExportMemoryHandleType();
+
+// Returns the external memory handle type for the specified shared handle type, or 0 if the type does not denote a shared handle that can be imported on this platform.
+VkExternalMemoryHandleTypeFlags VKGetImportMemoryHandleType(NativeHandleType handleType);
+
+// Converts a 64-bit integer of a NativeResourceHandle into a non-dispatchable Vulkan handle, which is either a pointer or an integer depending on the platform.
+template <typename T>
+inline T VKHandleFromUInt64(std::uint64_t value)
+{
+    return (T)(value);
+}
+
+// Converts a non-dispatchable Vulkan handle into a 64-bit integer for a NativeResourceHandle.
+template <typename T>
+inline std::uint64_t VKHandleToUInt64(T handle)
+{
+    return (std::uint64_t)(handle);
+}
+
+/*
+Dedicated device memory allocation of a single image or buffer whose memory is shared with other APIs or processes.
+The memory is either allocated to be exported ("VK_KHR_external_memory_fd" or "VK_KHR_external_memory_win32"), or it is imported from a shared handle.
+Such memory is never managed by VKDeviceMemoryManager, so it can neither be sub-allocated nor relocated.
+*/
+class VKExternalMemory
+{
+
+    public:
+
+        VKExternalMemory(const VKPtr<VkDevice>& device);
+
+        VKExternalMemory(const VKExternalMemory&) = delete;
+        VKExternalMemory& operator = (const VKExternalMemory&) = delete;
+
+        // Allocates exportable memory for the specified image or buffer (one of them must be null) and binds it to that object.
+        void AllocateAndBind(
+            const VkMemoryRequirements& requirements,
+            std::uint32_t               memoryTypeIndex,
+            VkImage                     image,
+            VkBuffer                    buffer
+        );
+
+        // Imports the memory of the specified shared handle and binds it to the specified image or buffer (one of them must be null).
+        void ImportAndBind(
+            const NativeResourceHandle& sharedHandle,
+            const VkMemoryRequirements& requirements,
+            std::uint32_t               memoryTypeIndex,
+            VkImage                     image,
+            VkBuffer                    buffer
+        );
+
+        // Exports a new shared handle of this memory. Returns false if the specified handle type cannot be exported.
+        bool Export(NativeHandleType handleType, NativeResourceHandle& outHandle) const;
+
+        // Returns the native device memory object.
+        inline VkDeviceMemory GetVkDeviceMemory() const
+        {
+            return memory_.Get();
+        }
+
+        // Returns the size (in bytes) of the device memory.
+        inline VkDeviceSize GetSize() const
+        {
+            return size_;
+        }
+
+    private:
+
+        // Allocates the device memory with the specified extension chain and binds it to the specified image or buffer.
+        void AllocateAndBindWithChain(
+            const void*                 next,
+            VkDeviceSize                size,
+            std::uint32_t               memoryTypeIndex,
+            VkImage                     image,
+            VkBuffer                    buffer
+        );
+
+    private:
+
+        const VKPtr<VkDevice>&          device_;
+        VKPtr<VkDeviceMemory>           memory_;
+        VkDeviceSize                    size_           = 0;
+        VkExternalMemoryHandleTypeFlags exportTypes_    = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
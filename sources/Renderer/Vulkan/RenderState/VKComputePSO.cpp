@@ -21,16 +21,29 @@ namespace LLGL
 VKComputePSO::VKComputePSO(
     const VKPtr<VkDevice>&              device,
     const ComputePipelineDescriptor&    desc,
-    VkPipelineLayout                    defaultPipelineLayout)
+    VkPipelineLayout                    defaultPipelineLayout,
+    VkPipelineCache                     pipelineCache,
+    bool                                isAsync,
+    long                                asyncFlags)
 :
-    VKPipelineState { device, VK_PIPELINE_BIND_POINT_COMPUTE }
+    VKPipelineState { device, VK_PIPELINE_BIND_POINT_COMPUTE, desc.pipelineLayout }
 {
     /* Create Vulkan compute pipeline object */
-    CreateVkPipeline(
-        device,
-        GetVkPipelineLayoutOrDefault(desc.pipelineLayout, defaultPipelineLayout),
-        desc
-    );
+    auto pipelineLayout = GetVkPipelineLayoutOrDefault(desc.pipelineLayout, defaultPipelineLayout);
+    if (isAsync)
+    {
+        /* Compile pipeline on the job system with a copy of the descriptor, since the input descriptor might not outlive this call */
+        VkDevice deviceVK = device;
+        StartCompileTask(
+            [this, deviceVK, pipelineLayout, desc, pipelineCache]()
+            {
+                CreateVkPipeline(deviceVK, pipelineLayout, desc, pipelineCache);
+            },
+            asyncFlags
+        );
+    }
+    else
+        CreateVkPipeline(device, pipelineLayout, desc, pipelineCache);
 }
 
 
@@ -41,7 +54,8 @@ VKComputePSO::VKComputePSO(
 void VKComputePSO::CreateVkPipeline(
     VkDevice                            device,
     VkPipelineLayout                    pipelineLayout,
-    const ComputePipelineDescriptor&    desc)
+    const ComputePipelineDescriptor&    desc,
+    VkPipelineCache                     pipelineCache)
 {
     /* Get compute shader */
     auto computeShaderVK = LLGL_CAST(const VKShader*, desc.computeShader);
@@ -52,6 +66,11 @@ void VKComputePSO::CreateVkPipeline(
     VkPipelineShaderStageCreateInfo shaderStageCreateInfo;
     computeShaderVK->FillShaderStageCreateInfo(shaderStageCreateInfo);
 
+    /* Apply specialization constants */
+    VkSpecializationInfo specializationInfo;
+    std::vector<VkSpecializationMapEntry> specializationEntries;
+    shaderStageCreateInfo.pSpecializationInfo = FillSpecializationInfo(desc.specializationConstants, specializationInfo, specializationEntries);
+
     /* Create graphics pipeline state object */
     VkComputePipelineCreateInfo createInfo;
     {
@@ -63,7 +82,7 @@ void VKComputePSO::CreateVkPipeline(
         createInfo.basePipelineHandle   = VK_NULL_HANDLE;
         createInfo.basePipelineIndex    = 0;
     }
-    auto result = vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &createInfo, nullptr, GetVkPipelineAddress());
+    auto result = vkCreateComputePipelines(device, pipelineCache, 1, &createInfo, nullptr, GetVkPipelineAddress());
     VKThrowIfFailed(result, "failed to create Vulkan compute pipeline");
 }
 
@@ -0,0 +1,252 @@
+/*
+ * VKDescriptorSetAllocator.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKDescriptorSetAllocator.h"
+#include "../VKCore.h"
+#include "../../../Core/Helper.h"
+#include <LLGL/Misc/ForRange.h>
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+// Number of descriptor sets of the first pool of each layout class, and upper limit of sets for further pools.
+static constexpr std::uint32_t g_minSetsPerLayoutClassPool  = 16;
+static constexpr std::uint32_t g_maxSetsPerLayoutClassPool  = 1024;
+
+// Number of descriptor sets of the first transient pool, and upper limit of sets for further pools.
+static constexpr std::uint32_t g_minSetsPerTransientPool    = 256;
+static constexpr std::uint32_t g_maxSetsPerTransientPool    = 4096;
+
+// Minimum number of descriptors per set and type in transient pools, so they can serve sets of different layouts.
+static constexpr std::uint32_t g_minTransientDescriptorsPerSet = 4;
+
+static constexpr std::uint32_t g_numDescriptorTypes = (static_cast<std::uint32_t>(VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT) + 1);
+
+VKDescriptorSetAllocator::VKDescriptorSetAllocator(const VKPtr<VkDevice>& device) :
+    device_ { device }
+{
+    transientPools_.poolChain.nextPoolCapacity = g_minSetsPerTransientPool;
+}
+
+VKDescriptorSetAllocator::~VKDescriptorSetAllocator()
+{
+    // dummy; required to destroy the layout classes with their complete type
+}
+
+// Serializes the bindings of a descriptor set layout into a key; set layouts with equal keys are identically defined.
+static std::vector<std::uint32_t> MakeLayoutClassKey(const ArrayView<VKLayoutBinding>& bindings)
+{
+    std::vector<std::uint32_t> key;
+    key.reserve(bindings.size() * 3);
+
+    for (const auto& binding : bindings)
+    {
+        key.push_back(binding.dstBinding);
+        key.push_back(static_cast<std::uint32_t>(binding.descriptorType));
+        key.push_back(static_cast<std::uint32_t>(binding.stageFlags));
+    }
+
+    return key;
+}
+
+// Accumulates the number of descriptors per type for a single descriptor set.
+static void AccumulateDescriptorCounts(const ArrayView<VKLayoutBinding>& bindings, std::uint32_t (&outCounts)[g_numDescriptorTypes])
+{
+    for (const auto& binding : bindings)
+    {
+        const auto index = static_cast<std::uint32_t>(binding.descriptorType);
+        if (index < g_numDescriptorTypes)
+            ++outCounts[index];
+    }
+}
+
+static void ConvertDescriptorCounts(std::vector<VkDescriptorPoolSize>& outPoolSizes, const std::uint32_t (&counts)[g_numDescriptorTypes])
+{
+    for_range(i, g_numDescriptorTypes)
+    {
+        if (counts[i] > 0)
+        {
+            VkDescriptorPoolSize poolSize;
+            {
+                poolSize.type               = static_cast<VkDescriptorType>(i);
+                poolSize.descriptorCount    = counts[i];
+            }
+            outPoolSizes.push_back(poolSize);
+        }
+    }
+}
+
+VKDescriptorSetAllocator::ClassHandle VKDescriptorSetAllocator::Allocate(
+    VkDescriptorSetLayout               setLayout,
+    const ArrayView<VKLayoutBinding>&   bindings,
+    std::uint32_t                       numSets,
+    VkDescriptorSet*                    outSets,
+    bool                                transient)
+{
+    if (numSets == 0)
+        return nullptr;
+
+    std::uint32_t descriptorCounts[g_numDescriptorTypes] = {};
+    AccumulateDescriptorCounts(bindings, descriptorCounts);
+
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    if (transient)
+    {
+        /* Allocate from transient pools that are large enough to serve sets of any layout with at least this many descriptors */
+        for (auto& count : descriptorCounts)
+            count = std::max(count, g_minTransientDescriptorsPerSet);
+
+        std::vector<VkDescriptorPoolSize> poolSizesPerSet;
+        ConvertDescriptorCounts(poolSizesPerSet, descriptorCounts);
+        AllocateFromPoolChain(transientPools_.poolChain, poolSizesPerSet, setLayout, numSets, outSets);
+        transientPools_.numLiveSets += numSets;
+        return nullptr;
+    }
+
+    /* Find or create layout class */
+    auto& layoutClass = layoutClasses_[MakeLayoutClassKey(bindings)];
+    if (!layoutClass)
+    {
+        layoutClass = MakeUnique<LayoutClass>();
+        ConvertDescriptorCounts(layoutClass->poolSizesPerSet, descriptorCounts);
+        layoutClass->poolChain.nextPoolCapacity = g_minSetsPerLayoutClassPool;
+    }
+
+    /* Reuse released descriptor sets first, then allocate the remaining sets from the pools */
+    const auto numReusedSets = std::min(numSets, static_cast<std::uint32_t>(layoutClass->freeSets.size()));
+    if (numReusedSets > 0)
+    {
+        auto first = layoutClass->freeSets.end() - numReusedSets;
+        std::copy(first, layoutClass->freeSets.end(), outSets);
+        layoutClass->freeSets.erase(first, layoutClass->freeSets.end());
+    }
+
+    if (numReusedSets < numSets)
+        AllocateFromPoolChain(layoutClass->poolChain, layoutClass->poolSizesPerSet, setLayout, numSets - numReusedSets, outSets + numReusedSets);
+
+    return layoutClass.get();
+}
+
+void VKDescriptorSetAllocator::Free(ClassHandle classHandle, std::uint32_t numSets, const VkDescriptorSet* sets, bool transient)
+{
+    if (numSets == 0)
+        return;
+
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    if (transient)
+    {
+        /*
+        Reset transient pools in bulk once the last transient descriptor set has been released.
+        Only the last pool is kept, since it is the largest one and all further allocations are taken from it.
+        */
+        transientPools_.numLiveSets -= std::min(numSets, transientPools_.numLiveSets);
+        if (transientPools_.numLiveSets == 0 && !transientPools_.poolChain.pools.empty())
+        {
+            auto& pools = transientPools_.poolChain.pools;
+            pools.erase(pools.begin(), pools.end() - 1);
+            auto result = vkResetDescriptorPool(device_, pools.back(), 0);
+            VKThrowIfFailed(result, "failed to reset Vulkan transient descriptor pool");
+        }
+    }
+    else if (classHandle != nullptr)
+    {
+        /* Return descriptor sets to the free-list of their layout class */
+        classHandle->freeSets.insert(classHandle->freeSets.end(), sets, sets + numSets);
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+static bool IsOutOfPoolMemory(VkResult result)
+{
+    return (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL);
+}
+
+void VKDescriptorSetAllocator::AllocateFromPoolChain(
+    PoolChain&                                  poolChain,
+    const std::vector<VkDescriptorPoolSize>&    poolSizesPerSet,
+    VkDescriptorSetLayout                       setLayout,
+    std::uint32_t                               numSets,
+    VkDescriptorSet*                            outSets)
+{
+    /* Use copy of descriptor set layout for each descriptor set */
+    std::vector<VkDescriptorSetLayout> setLayouts(numSets, setLayout);
+
+    VkDescriptorSetAllocateInfo allocInfo;
+    {
+        allocInfo.sType                 = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.pNext                 = nullptr;
+        allocInfo.descriptorPool        = VK_NULL_HANDLE;
+        allocInfo.descriptorSetCount    = numSets;
+        allocInfo.pSetLayouts           = setLayouts.data();
+    }
+
+    /* Try to allocate from the last pool in the chain */
+    if (!poolChain.pools.empty())
+    {
+        allocInfo.descriptorPool = poolChain.pools.back();
+        auto result = vkAllocateDescriptorSets(device_, &allocInfo, outSets);
+        if (result == VK_SUCCESS)
+            return;
+        if (!IsOutOfPoolMemory(result))
+            VKThrowIfFailed(result, "failed to allocate Vulkan descriptor sets");
+    }
+
+    /* Grow pool chain and allocate from the new pool */
+    AppendPool(poolChain, poolSizesPerSet, numSets);
+    allocInfo.descriptorPool = poolChain.pools.back();
+    auto result = vkAllocateDescriptorSets(device_, &allocInfo, outSets);
+    VKThrowIfFailed(result, "failed to allocate Vulkan descriptor sets");
+}
+
+void VKDescriptorSetAllocator::AppendPool(
+    PoolChain&                                  poolChain,
+    const std::vector<VkDescriptorPoolSize>&    poolSizesPerSet,
+    std::uint32_t                               minSets)
+{
+    /* Determine capacity of new pool and double the capacity for the next one */
+    const bool          isTransient = (&poolChain == &(transientPools_.poolChain));
+    const std::uint32_t maxSets     = std::max(poolChain.nextPoolCapacity, minSets);
+
+    poolChain.nextPoolCapacity = std::min(maxSets * 2, (isTransient ? g_maxSetsPerTransientPool : g_maxSetsPerLayoutClassPool));
+
+    /* Scale descriptor counts by number of sets */
+    std::vector<VkDescriptorPoolSize> poolSizes = poolSizesPerSet;
+    for (auto& poolSize : poolSizes)
+        poolSize.descriptorCount *= maxSets;
+
+    /* Create Vulkan descriptor pool; descriptor sets are never freed individually, since they are recycled by the free-lists */
+    VkDescriptorPoolCreateInfo poolCreateInfo;
+    {
+        poolCreateInfo.sType            = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolCreateInfo.pNext            = nullptr;
+        poolCreateInfo.flags            = 0;
+        poolCreateInfo.maxSets          = maxSets;
+        poolCreateInfo.poolSizeCount    = static_cast<std::uint32_t>(poolSizes.size());
+        poolCreateInfo.pPoolSizes       = poolSizes.data();
+    }
+    VKPtr<VkDescriptorPool> pool{ device_, vkDestroyDescriptorPool };
+    auto result = vkCreateDescriptorPool(device_, &poolCreateInfo, nullptr, pool.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan descriptor pool");
+
+    poolChain.pools.push_back(std::move(pool));
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
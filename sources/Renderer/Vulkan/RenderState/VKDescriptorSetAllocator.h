@@ -0,0 +1,130 @@
+/*
+ * VKDescriptorSetAllocator.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_DESCRIPTOR_SET_ALLOCATOR_H
+#define LLGL_VK_DESCRIPTOR_SET_ALLOCATOR_H
+
+
+#include "VKPipelineLayout.h"
+#include "../Vulkan.h"
+#include "../VKPtr.h"
+#include <LLGL/Container/ArrayView.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+Device-wide allocator of descriptor sets that are shared between all resource heaps.
+Descriptor sets are grouped into classes of identical set layouts, i.e. layouts with equal bindings.
+Each class has its own chain of descriptor pools that grows whenever a pool runs out of memory, and a free-list of released descriptor sets that are reused for the next allocation.
+Transient descriptor sets are allocated from a separate chain of pools that are reset in bulk once all transient descriptor sets have been released.
+All functions are guarded by a mutex, so resource heaps can be created and released from multiple threads.
+*/
+class VKDescriptorSetAllocator
+{
+
+    private:
+
+        struct LayoutClass;
+
+    public:
+
+        // Handle to the class of descriptor sets an allocation was taken from; must be passed back to Free().
+        using ClassHandle = LayoutClass*;
+
+    public:
+
+        VKDescriptorSetAllocator(const VKPtr<VkDevice>& device);
+        ~VKDescriptorSetAllocator();
+
+        VKDescriptorSetAllocator(const VKDescriptorSetAllocator&) = delete;
+        VKDescriptorSetAllocator& operator = (const VKDescriptorSetAllocator&) = delete;
+
+        /*
+        Allocates the specified number of descriptor sets for a set layout with the specified bindings and returns the class handle of the allocation.
+        If 'transient' is true, the descriptor sets are taken from the transient pools, which are reset in bulk instead of recycling individual sets.
+        */
+        ClassHandle Allocate(
+            VkDescriptorSetLayout                   setLayout,
+            const ArrayView<VKLayoutBinding>&       bindings,
+            std::uint32_t                           numSets,
+            VkDescriptorSet*                        outSets,
+            bool                                    transient = false
+        );
+
+        // Releases the specified descriptor sets that were allocated with the specified class handle.
+        void Free(ClassHandle classHandle, std::uint32_t numSets, const VkDescriptorSet* sets, bool transient = false);
+
+    private:
+
+        using Key = std::vector<std::uint32_t>;
+
+        // Chain of descriptor pools; only the last pool is used for new allocations.
+        struct PoolChain
+        {
+            std::vector<VKPtr<VkDescriptorPool>>    pools;
+            std::uint32_t                           nextPoolCapacity    = 0;    // Number of descriptor sets for the next pool.
+        };
+
+        struct LayoutClass
+        {
+            std::vector<VkDescriptorPoolSize>       poolSizesPerSet;
+            PoolChain                               poolChain;
+            std::vector<VkDescriptorSet>            freeSets;
+        };
+
+        struct TransientPools
+        {
+            PoolChain                               poolChain;
+            std::uint32_t                           numLiveSets         = 0;
+        };
+
+    private:
+
+        /*
+        Allocates descriptor sets from the last pool of the specified chain.
+        If that pool is out of memory, a new pool with the specified descriptor counts per set is appended and the capacity for the next pool is doubled.
+        */
+        void AllocateFromPoolChain(
+            PoolChain&                                  poolChain,
+            const std::vector<VkDescriptorPoolSize>&    poolSizesPerSet,
+            VkDescriptorSetLayout                       setLayout,
+            std::uint32_t                               numSets,
+            VkDescriptorSet*                            outSets
+        );
+
+        void AppendPool(
+            PoolChain&                                  poolChain,
+            const std::vector<VkDescriptorPoolSize>&    poolSizesPerSet,
+            std::uint32_t                               minSets
+        );
+
+    private:
+
+        const VKPtr<VkDevice>&                      device_;
+        std::map<Key, std::unique_ptr<LayoutClass>> layoutClasses_;
+        TransientPools                              transientPools_;
+        std::mutex                                  mutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -7,33 +7,151 @@
 
 #include "VKFence.h"
 #include "../VKCore.h"
+#include "../Ext/VKExtensions.h"
 
 
 namespace LLGL
 {
 
 
-VKFence::VKFence(const VKPtr<VkDevice>& device) :
-    fence_ { device, vkDestroyFence }
+VKFence::VKFence(const VKPtr<VkDevice>& device, bool timeline) :
+    device_    { device                     },
+    fence_     { device, vkDestroyFence     },
+    semaphore_ { device, vkDestroySemaphore }
 {
-    VkFenceCreateInfo createInfo;
+    if (timeline)
     {
-        createInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-        createInfo.pNext = nullptr;
-        createInfo.flags = 0;
+        /* Create timeline semaphore with initial value of zero */
+        VkSemaphoreTypeCreateInfoKHR typeCreateInfo;
+        {
+            typeCreateInfo.sType            = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+            typeCreateInfo.pNext            = nullptr;
+            typeCreateInfo.semaphoreType    = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+            typeCreateInfo.initialValue     = 0;
+        }
+        VkSemaphoreCreateInfo createInfo;
+        {
+            createInfo.sType                = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+            createInfo.pNext                = &typeCreateInfo;
+            createInfo.flags                = 0;
+        }
+        auto result = vkCreateSemaphore(device, &createInfo, nullptr, semaphore_.ReleaseAndGetAddressOf());
+        VKThrowIfFailed(result, "failed to create Vulkan timeline semaphore");
     }
-    auto result = vkCreateFence(device, &createInfo, nullptr, fence_.ReleaseAndGetAddressOf());
-    VKThrowIfFailed(result, "failed to create Vulkan fence");
+    else
+    {
+        VkFenceCreateInfo createInfo;
+        {
+            createInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+            createInfo.pNext = nullptr;
+            createInfo.flags = 0;
+        }
+        auto result = vkCreateFence(device, &createInfo, nullptr, fence_.ReleaseAndGetAddressOf());
+        VKThrowIfFailed(result, "failed to create Vulkan fence");
+    }
+}
+
+std::uint64_t VKFence::GetValue() const
+{
+    return value_;
+}
+
+std::uint64_t VKFence::GetCompletedValue() const
+{
+    if (IsTimeline())
+    {
+        std::uint64_t value = 0;
+        vkGetSemaphoreCounterValueKHR(device_, semaphore_, &value);
+        return value;
+    }
+    else
+    {
+        /* A binary fence can only tell whether its most recent submission has been signaled */
+        if (value_ > completedValue_ && vkGetFenceStatus(device_, fence_) == VK_SUCCESS)
+            completedValue_ = value_;
+        return completedValue_;
+    }
+}
+
+void VKFence::Submit(VkQueue queue)
+{
+    if (IsTimeline())
+    {
+        /* Submit signal operation for the next value without any command buffers */
+        const std::uint64_t signalValue = NextTimelineValue();
+        const VkSemaphore signalSemaphore = semaphore_;
+
+        VkTimelineSemaphoreSubmitInfoKHR timelineInfo;
+        {
+            timelineInfo.sType                      = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+            timelineInfo.pNext                      = nullptr;
+            timelineInfo.waitSemaphoreValueCount    = 0;
+            timelineInfo.pWaitSemaphoreValues       = nullptr;
+            timelineInfo.signalSemaphoreValueCount  = 1;
+            timelineInfo.pSignalSemaphoreValues     = &signalValue;
+        }
+        VkSubmitInfo submitInfo;
+        {
+            submitInfo.sType                        = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.pNext                        = &timelineInfo;
+            submitInfo.waitSemaphoreCount           = 0;
+            submitInfo.pWaitSemaphores              = nullptr;
+            submitInfo.pWaitDstStageMask            = nullptr;
+            submitInfo.commandBufferCount           = 0;
+            submitInfo.pCommandBuffers              = nullptr;
+            submitInfo.signalSemaphoreCount         = 1;
+            submitInfo.pSignalSemaphores            = &signalSemaphore;
+        }
+        auto result = vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
+        VKThrowIfFailed(result, "failed to submit Vulkan timeline semaphore signal");
+    }
+    else
+    {
+        /* Store completion of previous submission before the fence is reset */
+        GetCompletedValue();
+        vkResetFences(device_, 1, &fence_);
+        ++value_;
+        vkQueueSubmit(queue, 0, nullptr, fence_);
+    }
+}
+
+std::uint64_t VKFence::NextTimelineValue()
+{
+    return ++value_;
 }
 
-void VKFence::Reset(VkDevice device)
+bool VKFence::Wait(std::uint64_t timeout)
 {
-    vkResetFences(device, 1, &fence_);
+    return WaitValue(value_, timeout);
 }
 
-bool VKFence::Wait(VkDevice device, std::uint64_t timeout)
+bool VKFence::WaitValue(std::uint64_t value, std::uint64_t timeout)
 {
-    return (vkWaitForFences(device, 1, &fence_, VK_TRUE, timeout) == VK_SUCCESS);
+    if (IsTimeline())
+    {
+        const VkSemaphore semaphore = semaphore_;
+
+        VkSemaphoreWaitInfoKHR waitInfo;
+        {
+            waitInfo.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+            waitInfo.pNext          = nullptr;
+            waitInfo.flags          = 0;
+            waitInfo.semaphoreCount = 1;
+            waitInfo.pSemaphores    = &semaphore;
+            waitInfo.pValues        = &value;
+        }
+        return (vkWaitSemaphoresKHR(device_, &waitInfo, timeout) == VK_SUCCESS);
+    }
+    else
+    {
+        /* Binary fences can only wait for their most recent submission, which also covers all previous values */
+        if (value <= completedValue_)
+            return true;
+        if (vkWaitForFences(device_, 1, &fence_, VK_TRUE, timeout) != VK_SUCCESS)
+            return false;
+        completedValue_ = value_;
+        return true;
+    }
 }
 
 
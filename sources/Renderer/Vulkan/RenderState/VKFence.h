@@ -19,25 +19,60 @@ namespace LLGL
 {
 
 
+/*
+Fence with a monotonically increasing value. If 'timeline' is true, the fence is implemented with a timeline semaphore
+(VK_KHR_timeline_semaphore), so waits can target any previously submitted value. Otherwise, a binary VkFence is used,
+which can only be waited on for its most recent submission.
+*/
 class VKFence final : public Fence
 {
 
     public:
 
-        VKFence(const VKPtr<VkDevice>& device);
+        std::uint64_t GetValue() const override;
+        std::uint64_t GetCompletedValue() const override;
+
+    public:
+
+        VKFence(const VKPtr<VkDevice>& device, bool timeline = false);
+
+        // Submits a signal operation for the next value of this fence to the specified queue.
+        void Submit(VkQueue queue);
+
+        // Increments the value of a timeline fence and returns it. The caller must signal the timeline semaphore with this value.
+        std::uint64_t NextTimelineValue();
+
+        // Waits until the most recently submitted value has been signaled.
+        bool Wait(std::uint64_t timeout);
 
-        void Reset(VkDevice device);
-        bool Wait(VkDevice device, std::uint64_t timeout);
+        // Waits until the specified value has been signaled.
+        bool WaitValue(std::uint64_t value, std::uint64_t timeout);
 
-        // Returns the native VkFence handle.
+        // Returns true if this fence is implemented with a timeline semaphore.
+        inline bool IsTimeline() const
+        {
+            return (semaphore_.Get() != VK_NULL_HANDLE);
+        }
+
+        // Returns the native VkFence handle, or VK_NULL_HANDLE if this is a timeline fence.
         inline VkFence GetVkFence() const
         {
             return fence_;
         }
 
+        // Returns the native VkSemaphore handle of the timeline semaphore, or VK_NULL_HANDLE if this is a binary fence.
+        inline VkSemaphore GetVkSemaphore() const
+        {
+            return semaphore_;
+        }
+
     private:
 
-        VKPtr<VkFence> fence_;
+        VkDevice                device_             = VK_NULL_HANDLE;
+        VKPtr<VkFence>          fence_;
+        VKPtr<VkSemaphore>      semaphore_;
+        std::uint64_t           value_              = 0;
+        mutable std::uint64_t   completedValue_     = 0;    // Only used for binary fences
 
 };
 
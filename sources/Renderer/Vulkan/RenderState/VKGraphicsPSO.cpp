@@ -28,23 +28,35 @@ VKGraphicsPSO::VKGraphicsPSO(
     VkPipelineLayout                    defaultPipelineLayout,
     const RenderPass*                   defaultRenderPass,
     const GraphicsPipelineDescriptor&   desc,
-    const VKGraphicsPipelineLimits&     limits)
+    const VKGraphicsPipelineLimits&     limits,
+    VkPipelineCache                     pipelineCache,
+    VKPipelineLibraryCache*             libraryCache,
+    bool                                isAsync,
+    long                                asyncFlags)
 :
-    VKPipelineState    { device, VK_PIPELINE_BIND_POINT_GRAPHICS },
+    VKPipelineState    { device, VK_PIPELINE_BIND_POINT_GRAPHICS, desc.pipelineLayout },
     scissorEnabled_    { desc.rasterizer.scissorTestEnabled      },
     hasDynamicScissor_ { desc.scissors.empty()                   }
 {
     if (auto renderPass = (desc.renderPass != nullptr ? desc.renderPass : defaultRenderPass))
     {
         /* Create Vulkan graphics pipeline object */
-        auto renderPassVK = LLGL_CAST(const VKRenderPass*, renderPass);
-        CreateVkPipeline(
-            device,
-            GetVkPipelineLayoutOrDefault(desc.pipelineLayout, defaultPipelineLayout),
-            *renderPassVK,
-            limits,
-            desc
-        );
+        auto renderPassVK   = LLGL_CAST(const VKRenderPass*, renderPass);
+        auto pipelineLayout = GetVkPipelineLayoutOrDefault(desc.pipelineLayout, defaultPipelineLayout);
+        if (isAsync)
+        {
+            /* Compile pipeline on the job system with a copy of the descriptor, since the input descriptor might not outlive this call */
+            VkDevice deviceVK = device;
+            StartCompileTask(
+                [this, deviceVK, pipelineLayout, renderPassVK, limits, desc, pipelineCache, libraryCache]()
+                {
+                    CreateVkPipeline(deviceVK, pipelineLayout, *renderPassVK, limits, desc, pipelineCache, libraryCache);
+                },
+                asyncFlags
+            );
+        }
+        else
+            CreateVkPipeline(device, pipelineLayout, *renderPassVK, limits, desc, pipelineCache, libraryCache);
     }
     else
         throw std::invalid_argument("cannot create Vulkan graphics pipeline without render pass");
@@ -81,11 +93,24 @@ static void FillShaderStageCreateInfos(
         FillAndAppendShaderStageCreateInfo(desc.tessControlShader,      stageIndex, stageCount, createInfos);
         FillAndAppendShaderStageCreateInfo(desc.tessEvaluationShader,   stageIndex, stageCount, createInfos);
         FillAndAppendShaderStageCreateInfo(desc.geometryShader,         stageIndex, stageCount, createInfos);
+        FillAndAppendShaderStageCreateInfo(desc.taskShader,             stageIndex, stageCount, createInfos);
+        FillAndAppendShaderStageCreateInfo(desc.meshShader,             stageIndex, stageCount, createInfos);
         FillAndAppendShaderStageCreateInfo(desc.fragmentShader,         stageIndex, stageCount, createInfos);
     }
     stageCount = stageIndex;
 }
 
+// Writes the byte code hashes of all shaders in the same order as FillShaderStageCreateInfos().
+static void GetShaderModuleHashes(const GraphicsPipelineDescriptor& desc, std::uint64_t* outHashes)
+{
+    std::uint32_t stageIndex = 0;
+    for (const Shader* shader : { desc.vertexShader, desc.tessControlShader, desc.tessEvaluationShader, desc.geometryShader, desc.taskShader, desc.meshShader, desc.fragmentShader })
+    {
+        if (shader != nullptr)
+            outHashes[stageIndex++] = LLGL_CAST(const VKShader*, shader)->GetModuleHash();
+    }
+}
+
 static void CreateInputAssemblyState(
     const GraphicsPipelineDescriptor&       desc,
     VkPipelineInputAssemblyStateCreateInfo& createInfo)
@@ -315,6 +340,8 @@ static void CreateDynamicState(
         dynamicStatesVK.push_back(VK_DYNAMIC_STATE_BLEND_CONSTANTS);
     if (desc.stencil.referenceDynamic)
         dynamicStatesVK.push_back(VK_DYNAMIC_STATE_STENCIL_REFERENCE);
+    if (HasExtension(VKExt::KHR_fragment_shading_rate))
+        dynamicStatesVK.push_back(VK_DYNAMIC_STATE_FRAGMENT_SHADING_RATE_KHR);
 
     createInfo.sType                = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
     createInfo.pNext                = nullptr;
@@ -328,21 +355,34 @@ void VKGraphicsPSO::CreateVkPipeline(
     VkPipelineLayout                    pipelineLayout,
     const VKRenderPass&                 renderPass,
     const VKGraphicsPipelineLimits&     limits,
-    const GraphicsPipelineDescriptor&   desc)
+    const GraphicsPipelineDescriptor&   desc,
+    VkPipelineCache                     pipelineCache,
+    VKPipelineLibraryCache*             libraryCache)
 {
-    /* Get shader program object */
+    /* Get shader program object; mesh shader pipelines have neither a vertex shader nor a vertex input state */
     auto vertexShaderVK = LLGL_CAST(const VKShader*, desc.vertexShader);
-    if (!vertexShaderVK)
-        throw std::invalid_argument("cannot create Vulkan graphics pipeline without vertex shader");
+    const bool isMeshPipeline = (desc.meshShader != nullptr);
+    if (!vertexShaderVK && !isMeshPipeline)
+        throw std::invalid_argument("cannot create Vulkan graphics pipeline without vertex shader or mesh shader");
 
     /* Get shader stages */
-    VkPipelineShaderStageCreateInfo shaderStageCreateInfos[5];
+    VkPipelineShaderStageCreateInfo shaderStageCreateInfos[7];
     std::uint32_t shaderStateCount = sizeof(shaderStageCreateInfos) / sizeof(shaderStageCreateInfos[0]);
     FillShaderStageCreateInfos(desc, shaderStateCount, shaderStageCreateInfos);
 
+    /* Apply specialization constants to all shader stages */
+    VkSpecializationInfo specializationInfo;
+    std::vector<VkSpecializationMapEntry> specializationEntries;
+    if (auto specializationInfoPtr = FillSpecializationInfo(desc.specializationConstants, specializationInfo, specializationEntries))
+    {
+        for (std::uint32_t i = 0; i < shaderStateCount; ++i)
+            shaderStageCreateInfos[i].pSpecializationInfo = specializationInfoPtr;
+    }
+
     /* Initialize vertex input descriptor */
     VkPipelineVertexInputStateCreateInfo vertexInputCreateInfo;
-    vertexShaderVK->FillVertexInputStateCreateInfo(vertexInputCreateInfo);
+    if (vertexShaderVK != nullptr)
+        vertexShaderVK->FillVertexInputStateCreateInfo(vertexInputCreateInfo);
 
     /* Initialize input assembly state */
     VkPipelineInputAssemblyStateCreateInfo inputAssembly;
@@ -382,17 +422,31 @@ void VKGraphicsPSO::CreateVkPipeline(
     VkPipelineDynamicStateCreateInfo dynamicState;
     CreateDynamicState(desc, dynamicState, dynamicStatesVK);
 
+    /* Specify attachment formats instead of a render pass object for dynamic rendering */
+    VkFormat colorFormats[LLGL_MAX_NUM_COLOR_ATTACHMENTS];
+    VkPipelineRenderingCreateInfoKHR renderingCreateInfo;
+
+    if (renderPass.IsDynamicRendering())
+    {
+        renderingCreateInfo.sType                   = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
+        renderingCreateInfo.pNext                   = nullptr;
+        renderingCreateInfo.viewMask                = 0;
+        renderingCreateInfo.colorAttachmentCount    = renderPass.GetNumColorAttachments();
+        renderingCreateInfo.pColorAttachmentFormats = colorFormats;
+        renderPass.GetDynamicRenderingFormats(colorFormats, renderingCreateInfo.depthAttachmentFormat, renderingCreateInfo.stencilAttachmentFormat);
+    }
+
     /* Create graphics pipeline state object */
     VkGraphicsPipelineCreateInfo createInfo;
     {
         createInfo.sType                        = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-        createInfo.pNext                        = nullptr;
+        createInfo.pNext                        = (renderPass.IsDynamicRendering() ? &renderingCreateInfo : nullptr);
         createInfo.flags                        = 0;
         createInfo.stageCount                   = shaderStateCount;
         createInfo.pStages                      = shaderStageCreateInfos;
-        createInfo.pVertexInputState            = (&vertexInputCreateInfo);
-        createInfo.pInputAssemblyState          = (&inputAssembly);
-        createInfo.pTessellationState           = (inputAssembly.topology == VK_PRIMITIVE_TOPOLOGY_PATCH_LIST ? &tessellationState : nullptr);
+        createInfo.pVertexInputState            = (isMeshPipeline ? nullptr : &vertexInputCreateInfo);
+        createInfo.pInputAssemblyState          = (isMeshPipeline ? nullptr : &inputAssembly);
+        createInfo.pTessellationState           = (!isMeshPipeline && inputAssembly.topology == VK_PRIMITIVE_TOPOLOGY_PATCH_LIST ? &tessellationState : nullptr);
         createInfo.pViewportState               = (&viewportState);
         createInfo.pRasterizationState          = (&rasterizerState);
         createInfo.pMultisampleState            = (&multisampleState);
@@ -401,12 +455,23 @@ void VKGraphicsPSO::CreateVkPipeline(
         createInfo.pDynamicState                = (!dynamicStatesVK.empty() ? &dynamicState : nullptr);
         createInfo.layout                       = pipelineLayout;
         createInfo.renderPass                   = renderPass.GetVkRenderPass();
-        createInfo.subpass                      = 0;
+        createInfo.subpass                      = (renderPass.IsDynamicRendering() ? 0 : desc.subpass);
         createInfo.basePipelineHandle           = VK_NULL_HANDLE;
         createInfo.basePipelineIndex            = 0;
     }
-    auto result = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &createInfo, nullptr, GetVkPipelineAddress());
-    VKThrowIfFailed(result, "failed to create Vulkan graphics pipeline");
+    if (libraryCache != nullptr && !isMeshPipeline)
+    {
+        /* Link pipeline from cached libraries, which are identified by the byte code of their shader modules */
+        std::uint64_t stageModuleHashes[7];
+        GetShaderModuleHashes(desc, stageModuleHashes);
+        auto result = libraryCache->CreateLinkedPipeline(pipelineCache, createInfo, stageModuleHashes, pipelineLibraries_, GetVkPipelineAddress());
+        VKThrowIfFailed(result, "failed to link Vulkan graphics pipeline from libraries");
+    }
+    else
+    {
+        auto result = vkCreateGraphicsPipelines(device, pipelineCache, 1, &createInfo, nullptr, GetVkPipelineAddress());
+        VKThrowIfFailed(result, "failed to create Vulkan graphics pipeline");
+    }
 }
 
 
@@ -10,6 +10,8 @@
 
 
 #include "VKPipelineState.h"
+#include "VKPipelineLibraryCache.h"
+#include <vector>
 
 
 namespace LLGL
@@ -37,7 +39,11 @@ class VKGraphicsPSO final : public VKPipelineState
             VkPipelineLayout                    defaultPipelineLayout,
             const RenderPass*                   defaultRenderPass,
             const GraphicsPipelineDescriptor&   desc,
-            const VKGraphicsPipelineLimits&     limits
+            const VKGraphicsPipelineLimits&     limits,
+            VkPipelineCache                     pipelineCache   = VK_NULL_HANDLE,
+            VKPipelineLibraryCache*             libraryCache    = nullptr,
+            bool                                isAsync         = false,
+            long                                asyncFlags      = 0
         );
 
         // Returns true if scissors are enabled.
@@ -59,13 +65,16 @@ class VKGraphicsPSO final : public VKPipelineState
             VkPipelineLayout                    pipelineLayout,
             const VKRenderPass&                 renderPass,
             const VKGraphicsPipelineLimits&     limits,
-            const GraphicsPipelineDescriptor&   desc
+            const GraphicsPipelineDescriptor&   desc,
+            VkPipelineCache                     pipelineCache,
+            VKPipelineLibraryCache*             libraryCache
         );
 
     private:
 
-        bool scissorEnabled_    = false;
-        bool hasDynamicScissor_ = false;
+        bool                                scissorEnabled_     = false;
+        bool                                hasDynamicScissor_  = false;
+        std::vector<VKPipelineLibraryPtr>   pipelineLibraries_;             // Libraries this pipeline was linked from ("VK_EXT_graphics_pipeline_library")
 
 };
 
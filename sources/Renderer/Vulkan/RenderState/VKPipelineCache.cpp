@@ -0,0 +1,75 @@
+/*
+ * VKPipelineCache.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKPipelineCache.h"
+#include "../VKCore.h"
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+static void CreateVkPipelineCache(VkDevice device, const void* initialData, std::size_t initialDataSize, VkPipelineCache* pipelineCache)
+{
+    VkPipelineCacheCreateInfo createInfo;
+    {
+        createInfo.sType            = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.pNext            = nullptr;
+        createInfo.flags            = 0;
+        createInfo.initialDataSize  = initialDataSize;
+        createInfo.pInitialData     = initialData;
+    }
+    auto result = vkCreatePipelineCache(device, &createInfo, nullptr, pipelineCache);
+    VKThrowIfFailed(result, "failed to create Vulkan pipeline cache");
+}
+
+VKPipelineCache::VKPipelineCache(const VKPtr<VkDevice>& device) :
+    pipelineCache_ { device, vkDestroyPipelineCache }
+{
+    CreateVkPipelineCache(device, nullptr, 0, pipelineCache_.ReleaseAndGetAddressOf());
+}
+
+void VKPipelineCache::Merge(VkDevice device, const void* data, std::size_t size)
+{
+    if (data == nullptr || size == 0)
+        return;
+
+    /* Create temporary pipeline cache with the serialized data and merge it into the device-wide cache */
+    VKPtr<VkPipelineCache> srcPipelineCache{ [device](VkPipelineCache obj, VkAllocationCallbacks* alloc) { vkDestroyPipelineCache(device, obj, alloc); } };
+    CreateVkPipelineCache(device, data, size, srcPipelineCache.ReleaseAndGetAddressOf());
+
+    VkPipelineCache srcCaches[] = { srcPipelineCache.Get() };
+    auto result = vkMergePipelineCaches(device, pipelineCache_, 1, srcCaches);
+    VKThrowIfFailed(result, "failed to merge Vulkan pipeline caches");
+}
+
+std::unique_ptr<Blob> VKPipelineCache::GetData(VkDevice device) const
+{
+    /* Query size of pipeline cache data */
+    std::size_t dataSize = 0;
+    auto result = vkGetPipelineCacheData(device, pipelineCache_, &dataSize, nullptr);
+    VKThrowIfFailed(result, "failed to query size of Vulkan pipeline cache data");
+
+    if (dataSize == 0)
+        return nullptr;
+
+    /* Retrieve pipeline cache data */
+    std::vector<std::int8_t> data(dataSize);
+    result = vkGetPipelineCacheData(device, pipelineCache_, &dataSize, data.data());
+    VKThrowIfFailed(result, "failed to retrieve Vulkan pipeline cache data");
+
+    data.resize(dataSize);
+    return Blob::CreateStrongRef(std::move(data));
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
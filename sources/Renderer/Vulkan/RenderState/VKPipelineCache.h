@@ -0,0 +1,59 @@
+/*
+ * VKPipelineCache.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_PIPELINE_CACHE_H
+#define LLGL_VK_PIPELINE_CACHE_H
+
+
+#include "../Vulkan.h"
+#include "../VKPtr.h"
+#include <LLGL/Blob.h>
+#include <memory>
+
+
+namespace LLGL
+{
+
+
+// Device-wide wrapper for a native VkPipelineCache that is shared between all graphics and compute PSOs.
+class VKPipelineCache
+{
+
+    public:
+
+        VKPipelineCache(const VKPtr<VkDevice>& device);
+
+        /*
+        Merges the specified serialized pipeline cache data into this cache.
+        Data that was created on a different device or driver is silently ignored by the Vulkan implementation.
+        */
+        void Merge(VkDevice device, const void* data, std::size_t size);
+
+        // Returns the entire content of this pipeline cache as blob, or null if the cache is empty.
+        std::unique_ptr<Blob> GetData(VkDevice device) const;
+
+        // Returns the native VkPipelineCache handle.
+        inline VkPipelineCache GetVkPipelineCache() const
+        {
+            return pipelineCache_.Get();
+        }
+
+    private:
+
+        VKPtr<VkPipelineCache> pipelineCache_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -8,7 +8,11 @@
 #include "VKPipelineLayout.h"
 #include "../VKTypes.h"
 #include "../VKCore.h"
+#include "../Ext/VKExtensions.h"
+#include "../Ext/VKExtensionRegistry.h"
+#include "../../ResourceUtils.h"
 #include <LLGL/Misc/ForRange.h>
+#include <vector>
 
 
 namespace LLGL
@@ -32,6 +36,10 @@ static VkShaderStageFlags GetVkShaderStageFlags(long flags)
         bitmask |= VK_SHADER_STAGE_FRAGMENT_BIT;
     if ((flags & StageFlags::ComputeStage) != 0)
         bitmask |= VK_SHADER_STAGE_COMPUTE_BIT;
+    if ((flags & StageFlags::TaskStage) != 0)
+        bitmask |= VK_SHADER_STAGE_TASK_BIT_EXT;
+    if ((flags & StageFlags::MeshStage) != 0)
+        bitmask |= VK_SHADER_STAGE_MESH_BIT_EXT;
 
     return bitmask;
 }
@@ -46,10 +54,20 @@ static VkDescriptorType GetVkDescriptorType(const BindingDescriptor& desc)
         case ResourceType::Texture:
             return VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
         case ResourceType::Buffer:
-            if ((desc.bindFlags & BindFlags::ConstantBuffer) != 0)
-                return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-            if ((desc.bindFlags & (BindFlags::Sampled | BindFlags::Storage)) != 0)
-                return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            if ((desc.flags & BindingFlags::DynamicOffset) != 0)
+            {
+                if ((desc.bindFlags & BindFlags::ConstantBuffer) != 0)
+                    return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+                if ((desc.bindFlags & (BindFlags::Sampled | BindFlags::Storage)) != 0)
+                    return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+            }
+            else
+            {
+                if ((desc.bindFlags & BindFlags::ConstantBuffer) != 0)
+                    return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+                if ((desc.bindFlags & (BindFlags::Sampled | BindFlags::Storage)) != 0)
+                    return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            }
             break;
         default:
             break;
@@ -66,23 +84,87 @@ static void Convert(VkDescriptorSetLayoutBinding& dst, const BindingDescriptor&
     dst.pImmutableSamplers  = nullptr;
 }
 
+// Returns true if the specified binding is part of the descriptor set layout
+static bool IsDescriptorSetBinding(const BindingDescriptor& binding)
+{
+    return ((binding.flags & BindingFlags::InlineUniforms) == 0);
+}
+
 VKPipelineLayout::VKPipelineLayout(const VKPtr<VkDevice>& device, const PipelineLayoutDescriptor& desc) :
-    pipelineLayout_      { device, vkDestroyPipelineLayout      },
-    descriptorSetLayout_ { device, vkDestroyDescriptorSetLayout }
+    pipelineLayout_             { device, vkDestroyPipelineLayout              },
+    descriptorSetLayout_        { device, vkDestroyDescriptorSetLayout         },
+    descriptorUpdateTemplate_   { device, vkDestroyDescriptorUpdateTemplateKHR }
 {
-    /* Initialize all descriptor-set layout bindings */
-    const auto numBindings = desc.bindings.size();
-    std::vector<VkDescriptorSetLayoutBinding> layoutBindings(numBindings);
+    /* Bindless bindings require extension "VK_EXT_descriptor_indexing" */
+    if (HasBindlessBindingOrThrow(desc))
+    {
+        LLGL_ASSERT_VK_EXTENSION(VKExt::EXT_descriptor_indexing, "VK_EXT_descriptor_indexing");
+        hasBindlessBinding_     = true;
+        maxBindlessDescriptors_ = desc.bindings.back().arraySize;
+    }
+
+    /* Initialize all descriptor-set layout bindings and push constant ranges */
+    std::vector<VkDescriptorSetLayoutBinding> layoutBindings;
+    layoutBindings.reserve(desc.bindings.size());
 
-    for_range(i, numBindings)
-        Convert(layoutBindings[i], desc.bindings[i]);
+    std::uint32_t num32BitValues = 0;
+
+    for (const auto& binding : desc.bindings)
+    {
+        if (IsDescriptorSetBinding(binding))
+        {
+            VkDescriptorSetLayoutBinding layoutBinding;
+            Convert(layoutBinding, binding);
+            layoutBindings.push_back(layoutBinding);
+        }
+        else
+        {
+            /* Map inline uniforms to a push constant range; the ranges are packed in the order of their bindings */
+            VkPushConstantRange range;
+            {
+                range.stageFlags    = GetVkShaderStageFlags(binding.stageFlags);
+                range.offset        = num32BitValues * 4;
+                range.size          = binding.arraySize * 4;
+            }
+            pushConstantRanges_.push_back(range);
+            num32BitValues += binding.arraySize;
+        }
+    }
+
+    /*
+    Bindless binding is always the last one in the descriptor set layout:
+    it can be updated after the descriptor set has been bound, it does not need to be fully written, and its size is specified when the descriptor set is allocated
+    */
+    std::vector<VkDescriptorBindingFlagsEXT> layoutBindingFlags;
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsCreateInfo;
+    {
+        bindingFlagsCreateInfo.sType            = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+        bindingFlagsCreateInfo.pNext            = nullptr;
+        bindingFlagsCreateInfo.bindingCount     = 0;
+        bindingFlagsCreateInfo.pBindingFlags    = nullptr;
+    }
+
+    if (hasBindlessBinding_)
+    {
+        layoutBindingFlags.resize(layoutBindings.size(), 0);
+        layoutBindingFlags.back() =
+        (
+            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT             |
+            VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT   |
+            VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT               |
+            VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT_EXT
+        );
+        bindingFlagsCreateInfo.bindingCount     = static_cast<std::uint32_t>(layoutBindingFlags.size());
+        bindingFlagsCreateInfo.pBindingFlags    = layoutBindingFlags.data();
+    }
 
     /* Create descriptor set layout */
     VkDescriptorSetLayoutCreateInfo descSetCreateInfo;
     {
         descSetCreateInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-        descSetCreateInfo.pNext         = nullptr;
-        descSetCreateInfo.flags         = 0;
+        descSetCreateInfo.pNext         = (hasBindlessBinding_ ? &bindingFlagsCreateInfo : nullptr);
+        descSetCreateInfo.flags         = (hasBindlessBinding_ ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT : 0);
         descSetCreateInfo.bindingCount  = static_cast<std::uint32_t>(layoutBindings.size());
         descSetCreateInfo.pBindings     = layoutBindings.data();
     }
@@ -99,28 +181,39 @@ VKPipelineLayout::VKPipelineLayout(const VKPtr<VkDevice>& device, const Pipeline
         layoutCreateInfo.flags                  = 0;
         layoutCreateInfo.setLayoutCount         = 1;
         layoutCreateInfo.pSetLayouts            = setLayouts;
-        layoutCreateInfo.pushConstantRangeCount = 0;
-        layoutCreateInfo.pPushConstantRanges    = nullptr;
+        layoutCreateInfo.pushConstantRangeCount = static_cast<std::uint32_t>(pushConstantRanges_.size());
+        layoutCreateInfo.pPushConstantRanges    = pushConstantRanges_.data();
     }
     result = vkCreatePipelineLayout(device, &layoutCreateInfo, nullptr, pipelineLayout_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan pipeline layout");
 
     /* Create list of binding points (for later pass to 'VkWriteDescriptorSet::dstBinding') */
-    bindings_.reserve(numBindings);
-    for_range(i, numBindings)
+    bindings_.reserve(layoutBindings.size());
+    for (const auto& binding : desc.bindings)
     {
+        if (!IsDescriptorSetBinding(binding))
+            continue;
+
         /* Append binding with slot, stage flags, and Vulkan descriptor type */
         bindings_.push_back(
             {
-                desc.bindings[i].slot,
-                desc.bindings[i].stageFlags,
-                layoutBindings[i].descriptorType
+                binding.slot,
+                binding.stageFlags,
+                GetVkDescriptorType(binding)
             }
         );
 
         /* Consolidate all binding stage flags */
-        consolidatedStageFlags_ |= desc.bindings[i].stageFlags;
+        consolidatedStageFlags_ |= binding.stageFlags;
+
+        /* Count dynamic offsets, which must be passed to 'vkCmdBindDescriptorSets' for each array element of all dynamic descriptors */
+        if ((binding.flags & BindingFlags::DynamicOffset) != 0)
+            numDynamicOffsets_ += binding.arraySize;
     }
+
+    /* Create descriptor update template if supported; bindless descriptor sets are only updated partially and cannot use a template */
+    if (!bindings_.empty() && !hasBindlessBinding_ && HasExtension(VKExt::KHR_descriptor_update_template))
+        CreateDescriptorUpdateTemplate(device);
 }
 
 std::uint32_t VKPipelineLayout::GetNumBindings() const
@@ -129,6 +222,47 @@ std::uint32_t VKPipelineLayout::GetNumBindings() const
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+void VKPipelineLayout::CreateDescriptorUpdateTemplate(const VKPtr<VkDevice>& device)
+{
+    /* Initialize one template entry per binding, which are tightly packed in the same order as the bindings */
+    std::vector<VkDescriptorUpdateTemplateEntryKHR> templateEntries(bindings_.size());
+
+    for_range(i, bindings_.size())
+    {
+        auto& entry = templateEntries[i];
+        {
+            entry.dstBinding        = bindings_[i].dstBinding;
+            entry.dstArrayElement   = 0;
+            entry.descriptorCount   = 1;
+            entry.descriptorType    = bindings_[i].descriptorType;
+            entry.offset            = sizeof(VKDescriptorTemplateEntry) * i;
+            entry.stride            = sizeof(VKDescriptorTemplateEntry);
+        }
+    }
+
+    /* Create descriptor update template for the descriptor set layout */
+    VkDescriptorUpdateTemplateCreateInfoKHR createInfo;
+    {
+        createInfo.sType                        = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO_KHR;
+        createInfo.pNext                        = nullptr;
+        createInfo.flags                        = 0;
+        createInfo.descriptorUpdateEntryCount   = static_cast<std::uint32_t>(templateEntries.size());
+        createInfo.pDescriptorUpdateEntries     = templateEntries.data();
+        createInfo.templateType                 = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET_KHR;
+        createInfo.descriptorSetLayout          = descriptorSetLayout_.Get();
+        createInfo.pipelineBindPoint            = VK_PIPELINE_BIND_POINT_GRAPHICS; // ignored for descriptor set templates
+        createInfo.pipelineLayout               = VK_NULL_HANDLE;
+        createInfo.set                          = 0;
+    }
+    auto result = vkCreateDescriptorUpdateTemplateKHR(device, &createInfo, nullptr, descriptorUpdateTemplate_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan descriptor update template");
+}
+
+
 } // /namespace LLGL
 
 
@@ -27,6 +27,13 @@ struct VKLayoutBinding
     VkDescriptorType    descriptorType;
 };
 
+// Packed descriptor entry that is passed to 'vkUpdateDescriptorSetWithTemplateKHR' for each binding.
+union VKDescriptorTemplateEntry
+{
+    VkDescriptorImageInfo   imageInfo;
+    VkDescriptorBufferInfo  bufferInfo;
+};
+
 class VKPipelineLayout final : public PipelineLayout
 {
 
@@ -56,18 +63,63 @@ class VKPipelineLayout final : public PipelineLayout
             return bindings_;
         }
 
+        /*
+        Returns the native descriptor update template or VK_NULL_HANDLE if VK_KHR_descriptor_update_template is not supported.
+        The template expects one VKDescriptorTemplateEntry for each binding in the same order as GetBindings().
+        */
+        inline VkDescriptorUpdateTemplateKHR GetVkDescriptorUpdateTemplate() const
+        {
+            return descriptorUpdateTemplate_.Get();
+        }
+
+        /*
+        Returns the push constant ranges of all inline uniform bindings (see BindingFlags::InlineUniforms).
+        The ranges are packed in the order of their bindings, i.e. the offset of each range is the number of 32-bit values of all previous ranges times 4.
+        */
+        inline const SmallVector<VkPushConstantRange>& GetPushConstantRanges() const
+        {
+            return pushConstantRanges_;
+        }
+
+        // Returns true if the last entry in GetBindings() is a bindless binding (see BindingFlags::Bindless).
+        inline bool HasBindlessBinding() const
+        {
+            return hasBindlessBinding_;
+        }
+
+        // Returns the maximum number of descriptors of the bindless binding or 0 if there is no bindless binding.
+        inline std::uint32_t GetMaxBindlessDescriptors() const
+        {
+            return maxBindlessDescriptors_;
+        }
+
         // Returns the consolidated bitmask of all binding stage flags.
         inline long GetConsolidatedStageFlags() const
         {
             return consolidatedStageFlags_;
         }
 
+        // Returns the number of dynamic offsets that must be passed to 'vkCmdBindDescriptorSets' (see BindingFlags::DynamicOffset).
+        inline std::uint32_t GetNumDynamicOffsets() const
+        {
+            return numDynamicOffsets_;
+        }
+
+    private:
+
+        void CreateDescriptorUpdateTemplate(const VKPtr<VkDevice>& device);
+
     private:
 
-        VKPtr<VkPipelineLayout>         pipelineLayout_;
-        VKPtr<VkDescriptorSetLayout>    descriptorSetLayout_;
-        SmallVector<VKLayoutBinding>    bindings_;
-        long                            consolidatedStageFlags_;
+        VKPtr<VkPipelineLayout>                 pipelineLayout_;
+        VKPtr<VkDescriptorSetLayout>            descriptorSetLayout_;
+        VKPtr<VkDescriptorUpdateTemplateKHR>    descriptorUpdateTemplate_;
+        SmallVector<VKLayoutBinding>            bindings_;
+        SmallVector<VkPushConstantRange>        pushConstantRanges_;
+        long                                    consolidatedStageFlags_     = 0;
+        std::uint32_t                           numDynamicOffsets_          = 0;
+        bool                                    hasBindlessBinding_         = false;
+        std::uint32_t                           maxBindlessDescriptors_     = 0;
 
 };
 
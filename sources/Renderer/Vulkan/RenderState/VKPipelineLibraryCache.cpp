@@ -0,0 +1,417 @@
+/*
+ * VKPipelineLibraryCache.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKPipelineLibraryCache.h"
+#include "../VKCore.h"
+#include <LLGL/Misc/ForRange.h>
+#include <cstring>
+#include <iterator>
+
+
+namespace LLGL
+{
+
+
+VKPipelineLibraryCache::VKPipelineLibraryCache(const VKPtr<VkDevice>& device) :
+    device_ { device }
+{
+}
+
+/*
+ * Serialization of all states that are compiled into a pipeline library
+ */
+
+template <typename T>
+static void AppendRaw(std::vector<std::uint32_t>& key, const T& value)
+{
+    std::uint32_t words[(sizeof(T) + 3) / 4] = {};
+    std::memcpy(words, &value, sizeof(T));
+    key.insert(key.end(), std::begin(words), std::end(words));
+}
+
+static void AppendData(std::vector<std::uint32_t>& key, const void* data, std::size_t size)
+{
+    const std::size_t offset = key.size();
+    key.push_back(static_cast<std::uint32_t>(size));
+    key.resize(offset + 1 + (size + 3) / 4, 0u);
+    if (size > 0)
+        std::memcpy(&key[offset + 1], data, size);
+}
+
+static void AppendDynamicState(std::vector<std::uint32_t>& key, const VkPipelineDynamicStateCreateInfo* dynamicState)
+{
+    if (dynamicState != nullptr)
+        AppendData(key, dynamicState->pDynamicStates, dynamicState->dynamicStateCount * sizeof(VkDynamicState));
+    else
+        key.push_back(0u);
+}
+
+static const VkPipelineRenderingCreateInfoKHR* FindRenderingCreateInfo(const void* next)
+{
+    for (auto info = reinterpret_cast<const VkBaseInStructure*>(next); info != nullptr; info = info->pNext)
+    {
+        if (info->sType == VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR)
+            return reinterpret_cast<const VkPipelineRenderingCreateInfoKHR*>(info);
+    }
+    return nullptr;
+}
+
+// Appends the render pass compatibility, i.e. either the native render pass and sub-pass or the attachment formats for dynamic rendering.
+static void AppendRenderPass(std::vector<std::uint32_t>& key, const VkGraphicsPipelineCreateInfo& createInfo)
+{
+    AppendRaw(key, createInfo.renderPass);
+    key.push_back(createInfo.subpass);
+    if (auto renderingInfo = FindRenderingCreateInfo(createInfo.pNext))
+    {
+        key.push_back(renderingInfo->viewMask);
+        AppendData(key, renderingInfo->pColorAttachmentFormats, renderingInfo->colorAttachmentCount * sizeof(VkFormat));
+        key.push_back(static_cast<std::uint32_t>(renderingInfo->depthAttachmentFormat));
+        key.push_back(static_cast<std::uint32_t>(renderingInfo->stencilAttachmentFormat));
+    }
+}
+
+static void AppendShaderStage(std::vector<std::uint32_t>& key, const VkPipelineShaderStageCreateInfo& stage, std::uint64_t moduleHash)
+{
+    key.push_back(static_cast<std::uint32_t>(stage.stage));
+    AppendRaw(key, moduleHash);
+    AppendData(key, stage.pName, std::strlen(stage.pName));
+    if (auto specialization = stage.pSpecializationInfo)
+    {
+        AppendData(key, specialization->pMapEntries, specialization->mapEntryCount * sizeof(VkSpecializationMapEntry));
+        AppendData(key, specialization->pData, specialization->dataSize);
+    }
+    else
+        key.push_back(0u);
+}
+
+static void AppendShaderStages(
+    std::vector<std::uint32_t>&         key,
+    const VkGraphicsPipelineCreateInfo& createInfo,
+    const std::uint64_t*                stageModuleHashes,
+    bool                                fragmentStage)
+{
+    for_range(i, createInfo.stageCount)
+    {
+        const auto& stage = createInfo.pStages[i];
+        if ((stage.stage == VK_SHADER_STAGE_FRAGMENT_BIT) == fragmentStage)
+            AppendShaderStage(key, stage, stageModuleHashes[i]);
+    }
+}
+
+static void AppendMultisampleState(std::vector<std::uint32_t>& key, const VkPipelineMultisampleStateCreateInfo* state)
+{
+    if (state != nullptr)
+    {
+        key.push_back(static_cast<std::uint32_t>(state->rasterizationSamples));
+        key.push_back(state->sampleShadingEnable);
+        AppendRaw(key, state->minSampleShading);
+        key.push_back(state->pSampleMask != nullptr ? *(state->pSampleMask) : ~0u);
+        key.push_back(state->alphaToCoverageEnable);
+        key.push_back(state->alphaToOneEnable);
+    }
+}
+
+static std::vector<std::uint32_t> MakeVertexInputKey(const VkGraphicsPipelineCreateInfo& createInfo)
+{
+    std::vector<std::uint32_t> key;
+    key.push_back(VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT);
+
+    if (auto state = createInfo.pVertexInputState)
+    {
+        AppendData(key, state->pVertexBindingDescriptions, state->vertexBindingDescriptionCount * sizeof(VkVertexInputBindingDescription));
+        AppendData(key, state->pVertexAttributeDescriptions, state->vertexAttributeDescriptionCount * sizeof(VkVertexInputAttributeDescription));
+    }
+    if (auto state = createInfo.pInputAssemblyState)
+    {
+        key.push_back(static_cast<std::uint32_t>(state->topology));
+        key.push_back(state->primitiveRestartEnable);
+    }
+    AppendDynamicState(key, createInfo.pDynamicState);
+
+    return key;
+}
+
+static std::vector<std::uint32_t> MakePreRasterizationKey(const VkGraphicsPipelineCreateInfo& createInfo, const std::uint64_t* stageModuleHashes)
+{
+    std::vector<std::uint32_t> key;
+    key.push_back(VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT);
+
+    AppendShaderStages(key, createInfo, stageModuleHashes, false);
+    AppendRaw(key, createInfo.layout);
+    AppendRenderPass(key, createInfo);
+
+    if (auto state = createInfo.pTessellationState)
+        key.push_back(state->patchControlPoints);
+    else
+        key.push_back(0u);
+
+    if (auto state = createInfo.pViewportState)
+    {
+        key.push_back(state->viewportCount);
+        key.push_back(state->scissorCount);
+        if (state->pViewports != nullptr)
+            AppendData(key, state->pViewports, state->viewportCount * sizeof(VkViewport));
+        if (state->pScissors != nullptr)
+            AppendData(key, state->pScissors, state->scissorCount * sizeof(VkRect2D));
+    }
+
+    if (auto state = createInfo.pRasterizationState)
+    {
+        key.push_back(state->depthClampEnable);
+        key.push_back(state->rasterizerDiscardEnable);
+        key.push_back(static_cast<std::uint32_t>(state->polygonMode));
+        key.push_back(static_cast<std::uint32_t>(state->cullMode));
+        key.push_back(static_cast<std::uint32_t>(state->frontFace));
+        key.push_back(state->depthBiasEnable);
+        AppendRaw(key, state->depthBiasConstantFactor);
+        AppendRaw(key, state->depthBiasClamp);
+        AppendRaw(key, state->depthBiasSlopeFactor);
+        AppendRaw(key, state->lineWidth);
+        key.push_back(state->pNext != nullptr ? 1u : 0u); // Conservative rasterization
+    }
+    AppendDynamicState(key, createInfo.pDynamicState);
+
+    return key;
+}
+
+static std::vector<std::uint32_t> MakeFragmentShaderKey(const VkGraphicsPipelineCreateInfo& createInfo, const std::uint64_t* stageModuleHashes)
+{
+    std::vector<std::uint32_t> key;
+    key.push_back(VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT);
+
+    AppendShaderStages(key, createInfo, stageModuleHashes, true);
+    AppendRaw(key, createInfo.layout);
+    AppendRenderPass(key, createInfo);
+    AppendMultisampleState(key, createInfo.pMultisampleState);
+
+    if (auto state = createInfo.pDepthStencilState)
+    {
+        key.push_back(state->depthTestEnable);
+        key.push_back(state->depthWriteEnable);
+        key.push_back(static_cast<std::uint32_t>(state->depthCompareOp));
+        key.push_back(state->depthBoundsTestEnable);
+        key.push_back(state->stencilTestEnable);
+        AppendRaw(key, state->front);
+        AppendRaw(key, state->back);
+        AppendRaw(key, state->minDepthBounds);
+        AppendRaw(key, state->maxDepthBounds);
+    }
+    AppendDynamicState(key, createInfo.pDynamicState);
+
+    return key;
+}
+
+static std::vector<std::uint32_t> MakeFragmentOutputKey(const VkGraphicsPipelineCreateInfo& createInfo)
+{
+    std::vector<std::uint32_t> key;
+    key.push_back(VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT);
+
+    AppendRenderPass(key, createInfo);
+    AppendMultisampleState(key, createInfo.pMultisampleState);
+
+    if (auto state = createInfo.pColorBlendState)
+    {
+        key.push_back(state->logicOpEnable);
+        key.push_back(static_cast<std::uint32_t>(state->logicOp));
+        AppendData(key, state->pAttachments, state->attachmentCount * sizeof(VkPipelineColorBlendAttachmentState));
+        AppendRaw(key, state->blendConstants);
+    }
+    AppendDynamicState(key, createInfo.pDynamicState);
+
+    return key;
+}
+
+/*
+ * Splitting of a monolithic pipeline descriptor into its library parts
+ */
+
+static VkGraphicsPipelineCreateInfo MakeLibraryPartCreateInfo(const VkGraphicsPipelineCreateInfo& createInfo)
+{
+    VkGraphicsPipelineCreateInfo partCreateInfo = {};
+    {
+        partCreateInfo.sType                = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        partCreateInfo.pNext                = createInfo.pNext;
+        partCreateInfo.flags                = VK_PIPELINE_CREATE_LIBRARY_BIT_KHR;
+        partCreateInfo.pDynamicState        = createInfo.pDynamicState;
+        partCreateInfo.basePipelineHandle   = VK_NULL_HANDLE;
+        partCreateInfo.basePipelineIndex    = -1;
+    }
+    return partCreateInfo;
+}
+
+static void CopyRenderPassAndLayout(VkGraphicsPipelineCreateInfo& dst, const VkGraphicsPipelineCreateInfo& src, bool withLayout)
+{
+    dst.renderPass  = src.renderPass;
+    dst.subpass     = src.subpass;
+    dst.layout      = (withLayout ? src.layout : VK_NULL_HANDLE);
+}
+
+VkResult VKPipelineLibraryCache::CreateLinkedPipeline(
+    VkPipelineCache                     pipelineCache,
+    const VkGraphicsPipelineCreateInfo& createInfo,
+    const std::uint64_t*                stageModuleHashes,
+    std::vector<VKPipelineLibraryPtr>&  outLibraries,
+    VkPipeline*                         outPipeline)
+{
+    /* Separate shader stages into pre-rasterization and fragment shader stages, which are always ordered with the fragment shader last */
+    VkPipelineShaderStageCreateInfo preRasterStages[5];
+    std::uint32_t numPreRasterStages = 0;
+    const VkPipelineShaderStageCreateInfo* fragmentStage = nullptr;
+
+    for_range(i, createInfo.stageCount)
+    {
+        if (createInfo.pStages[i].stage == VK_SHADER_STAGE_FRAGMENT_BIT)
+            fragmentStage = &(createInfo.pStages[i]);
+        else if (numPreRasterStages < sizeof(preRasterStages)/sizeof(preRasterStages[0]))
+            preRasterStages[numPreRasterStages++] = createInfo.pStages[i];
+    }
+
+    /* Get or create vertex input interface library */
+    VkGraphicsPipelineCreateInfo vertexInputCreateInfo = MakeLibraryPartCreateInfo(createInfo);
+    {
+        vertexInputCreateInfo.pVertexInputState     = createInfo.pVertexInputState;
+        vertexInputCreateInfo.pInputAssemblyState   = createInfo.pInputAssemblyState;
+    }
+    auto vertexInputLibrary = GetOrCreateLibrary(
+        pipelineCache, vertexInputCreateInfo, VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT, MakeVertexInputKey(createInfo)
+    );
+
+    /* Get or create pre-rasterization shaders library */
+    VkGraphicsPipelineCreateInfo preRasterCreateInfo = MakeLibraryPartCreateInfo(createInfo);
+    {
+        preRasterCreateInfo.stageCount          = numPreRasterStages;
+        preRasterCreateInfo.pStages             = preRasterStages;
+        preRasterCreateInfo.pTessellationState  = createInfo.pTessellationState;
+        preRasterCreateInfo.pViewportState      = createInfo.pViewportState;
+        preRasterCreateInfo.pRasterizationState = createInfo.pRasterizationState;
+        CopyRenderPassAndLayout(preRasterCreateInfo, createInfo, true);
+    }
+    auto preRasterLibrary = GetOrCreateLibrary(
+        pipelineCache, preRasterCreateInfo, VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT, MakePreRasterizationKey(createInfo, stageModuleHashes)
+    );
+
+    /* Get or create fragment shader library */
+    VkGraphicsPipelineCreateInfo fragmentCreateInfo = MakeLibraryPartCreateInfo(createInfo);
+    {
+        fragmentCreateInfo.stageCount           = (fragmentStage != nullptr ? 1u : 0u);
+        fragmentCreateInfo.pStages              = fragmentStage;
+        fragmentCreateInfo.pMultisampleState    = createInfo.pMultisampleState;
+        fragmentCreateInfo.pDepthStencilState   = createInfo.pDepthStencilState;
+        CopyRenderPassAndLayout(fragmentCreateInfo, createInfo, true);
+    }
+    auto fragmentLibrary = GetOrCreateLibrary(
+        pipelineCache, fragmentCreateInfo, VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT, MakeFragmentShaderKey(createInfo, stageModuleHashes)
+    );
+
+    /* Get or create fragment output interface library */
+    VkGraphicsPipelineCreateInfo fragmentOutputCreateInfo = MakeLibraryPartCreateInfo(createInfo);
+    {
+        fragmentOutputCreateInfo.pMultisampleState  = createInfo.pMultisampleState;
+        fragmentOutputCreateInfo.pColorBlendState   = createInfo.pColorBlendState;
+        CopyRenderPassAndLayout(fragmentOutputCreateInfo, createInfo, false);
+    }
+    auto fragmentOutputLibrary = GetOrCreateLibrary(
+        pipelineCache, fragmentOutputCreateInfo, VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT, MakeFragmentOutputKey(createInfo)
+    );
+
+    /* Link final pipeline from all four libraries; omit link-time optimization for fast linking */
+    const VkPipeline libraries[] =
+    {
+        vertexInputLibrary->Get(),
+        preRasterLibrary->Get(),
+        fragmentLibrary->Get(),
+        fragmentOutputLibrary->Get(),
+    };
+
+    VkPipelineLibraryCreateInfoKHR libraryCreateInfo;
+    {
+        libraryCreateInfo.sType         = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR;
+        libraryCreateInfo.pNext         = nullptr;
+        libraryCreateInfo.libraryCount  = static_cast<std::uint32_t>(sizeof(libraries)/sizeof(libraries[0]));
+        libraryCreateInfo.pLibraries    = libraries;
+    }
+    VkGraphicsPipelineCreateInfo linkCreateInfo = {};
+    {
+        linkCreateInfo.sType                = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        linkCreateInfo.pNext                = &libraryCreateInfo;
+        linkCreateInfo.flags                = 0;
+        linkCreateInfo.layout               = createInfo.layout;
+        linkCreateInfo.basePipelineHandle   = VK_NULL_HANDLE;
+        linkCreateInfo.basePipelineIndex    = -1;
+    }
+    auto result = vkCreateGraphicsPipelines(device_, pipelineCache, 1, &linkCreateInfo, nullptr, outPipeline);
+
+    /* Keep references to all libraries, so subsequent pipelines with equal parts can be linked from the same libraries */
+    outLibraries.push_back(std::move(vertexInputLibrary));
+    outLibraries.push_back(std::move(preRasterLibrary));
+    outLibraries.push_back(std::move(fragmentLibrary));
+    outLibraries.push_back(std::move(fragmentOutputLibrary));
+
+    return result;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+VKPipelineLibraryPtr VKPipelineLibraryCache::GetOrCreateLibrary(
+    VkPipelineCache                     pipelineCache,
+    const VkGraphicsPipelineCreateInfo& partCreateInfo,
+    VkGraphicsPipelineLibraryFlagsEXT   part,
+    Key&&                               key)
+{
+    /* Find library of an identical pipeline part */
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        auto it = entries_.find(key);
+        if (it != entries_.end())
+        {
+            if (auto library = it->second.lock())
+                return library;
+        }
+    }
+
+    /* Create new library outside of the lock, so pipelines on other threads are not blocked by the compilation */
+    VkGraphicsPipelineLibraryCreateInfoEXT libraryCreateInfo;
+    {
+        libraryCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT;
+        libraryCreateInfo.pNext = partCreateInfo.pNext;
+        libraryCreateInfo.flags = part;
+    }
+    VkGraphicsPipelineCreateInfo createInfo = partCreateInfo;
+    createInfo.pNext = &libraryCreateInfo;
+
+    auto newLibrary = std::make_shared<VKPtr<VkPipeline>>(device_, vkDestroyPipeline);
+    auto result = vkCreateGraphicsPipelines(device_, pipelineCache, 1, &createInfo, nullptr, newLibrary->ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan graphics pipeline library");
+
+    /* Store library in cache unless another thread was faster; remove expired entries beforehand */
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    for (auto entry = entries_.begin(); entry != entries_.end();)
+    {
+        if (entry->second.expired())
+            entry = entries_.erase(entry);
+        else
+            ++entry;
+    }
+
+    auto& entry = entries_[std::move(key)];
+    if (auto library = entry.lock())
+        return library;
+
+    entry = newLibrary;
+    return newLibrary;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,88 @@
+/*
+ * VKPipelineLibraryCache.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_PIPELINE_LIBRARY_CACHE_H
+#define LLGL_VK_PIPELINE_LIBRARY_CACHE_H
+
+
+#include "../Vulkan.h"
+#include "../VKPtr.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+// Shared reference to a native graphics pipeline library.
+using VKPipelineLibraryPtr = std::shared_ptr<const VKPtr<VkPipeline>>;
+
+/*
+Device-wide cache of graphics pipeline libraries ("VK_EXT_graphics_pipeline_library").
+Each graphics pipeline is split into its vertex input interface, pre-rasterization shaders, fragment shader, and fragment output interface,
+and every part is created only once for all pipelines with an equal state. The final pipeline is then linked from these parts without link-time optimization.
+Entries are weak references, so each library is destroyed together with the last pipeline that was linked from it.
+All functions are guarded by a mutex, so pipelines can be created on multiple threads.
+*/
+class VKPipelineLibraryCache
+{
+
+    public:
+
+        VKPipelineLibraryCache(const VKPtr<VkDevice>& device);
+
+        VKPipelineLibraryCache(const VKPipelineLibraryCache&) = delete;
+        VKPipelineLibraryCache& operator = (const VKPipelineLibraryCache&) = delete;
+
+        /*
+        Creates a graphics pipeline with the state of the specified monolithic descriptor by linking cached pipeline libraries.
+        'stageModuleHashes' specifies the byte code hash for each entry in 'createInfo.pStages', which identifies the shader modules independently of their native handles.
+        All libraries the pipeline was linked from are appended to 'outLibraries', which keeps them in the cache as long as the pipeline is alive.
+        */
+        VkResult CreateLinkedPipeline(
+            VkPipelineCache                     pipelineCache,
+            const VkGraphicsPipelineCreateInfo& createInfo,
+            const std::uint64_t*                stageModuleHashes,
+            std::vector<VKPipelineLibraryPtr>&  outLibraries,
+            VkPipeline*                         outPipeline
+        );
+
+    private:
+
+        using Key = std::vector<std::uint32_t>;
+
+    private:
+
+        // Returns the library of the specified part from the cache, or creates a new one if no entry with the specified key is alive.
+        VKPipelineLibraryPtr GetOrCreateLibrary(
+            VkPipelineCache                     pipelineCache,
+            const VkGraphicsPipelineCreateInfo& partCreateInfo,
+            VkGraphicsPipelineLibraryFlagsEXT   part,
+            Key&&                               key
+        );
+
+    private:
+
+        const VKPtr<VkDevice>&                                  device_;
+        std::map<Key, std::weak_ptr<const VKPtr<VkPipeline>>>   entries_;
+        std::mutex                                              mutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -8,15 +8,17 @@
 #include "VKPipelineState.h"
 #include "VKPipelineLayout.h"
 #include "../../CheckedCast.h"
+#include <cstddef>
 
 
 namespace LLGL
 {
 
 
-VKPipelineState::VKPipelineState(const VKPtr<VkDevice>& device, VkPipelineBindPoint bindPoint) :
-    pipeline_  { device, vkDestroyPipeline },
-    bindPoint_ { bindPoint                 }
+VKPipelineState::VKPipelineState(const VKPtr<VkDevice>& device, VkPipelineBindPoint bindPoint, const PipelineLayout* pipelineLayout) :
+    pipeline_       { device, vkDestroyPipeline                          },
+    bindPoint_      { bindPoint                                          },
+    pipelineLayout_ { LLGL_CAST(const VKPipelineLayout*, pipelineLayout) }
 {
 }
 
@@ -25,6 +27,16 @@ const Report* VKPipelineState::GetReport() const
     return nullptr; //TODO
 }
 
+bool VKPipelineState::IsReady() const
+{
+    return compileTask_.IsReady();
+}
+
+void VKPipelineState::Wait()
+{
+    compileTask_.Wait();
+}
+
 
 /*
  * ======= Protected: =======
@@ -42,11 +54,42 @@ VkPipelineLayout VKPipelineState::GetVkPipelineLayoutOrDefault(
     return defaultPipelineLayout;
 }
 
+const VkSpecializationInfo* VKPipelineState::FillSpecializationInfo(
+    const std::vector<SpecializationConstant>&  constants,
+    VkSpecializationInfo&                       outInfo,
+    std::vector<VkSpecializationMapEntry>&      outEntries)
+{
+    if (constants.empty())
+        return nullptr;
+
+    /* Map each constant to its 32-bit value within the input array, so no data must be copied */
+    outEntries.resize(constants.size());
+    for (std::size_t i = 0; i < constants.size(); ++i)
+    {
+        auto& entry = outEntries[i];
+        entry.constantID    = constants[i].id;
+        entry.offset        = static_cast<std::uint32_t>(i * sizeof(SpecializationConstant) + offsetof(SpecializationConstant, value));
+        entry.size          = sizeof(std::uint32_t);
+    }
+
+    outInfo.mapEntryCount   = static_cast<std::uint32_t>(outEntries.size());
+    outInfo.pMapEntries     = outEntries.data();
+    outInfo.dataSize        = constants.size() * sizeof(SpecializationConstant);
+    outInfo.pData           = constants.data();
+
+    return (&outInfo);
+}
+
 VkPipeline* VKPipelineState::GetVkPipelineAddress()
 {
     return pipeline_.ReleaseAndGetAddressOf();
 }
 
+void VKPipelineState::StartCompileTask(const std::function<void()>& task, long flags)
+{
+    compileTask_.Start(task, flags);
+}
+
 
 } // /namespace LLGL
 
@@ -10,8 +10,10 @@
 
 
 #include <LLGL/PipelineState.h>
+#include <LLGL/PipelineStateFlags.h>
 #include <vulkan/vulkan.h>
 #include "../VKPtr.h"
+#include "../../PipelineCompileTask.h"
 
 
 namespace LLGL
@@ -19,15 +21,18 @@ namespace LLGL
 
 
 class PipelineLayout;
+class VKPipelineLayout;
 
 class VKPipelineState : public PipelineState
 {
 
     public:
 
-        VKPipelineState(const VKPtr<VkDevice>& device, VkPipelineBindPoint bindPoint);
+        VKPipelineState(const VKPtr<VkDevice>& device, VkPipelineBindPoint bindPoint, const PipelineLayout* pipelineLayout);
 
         const Report* GetReport() const override;
+        bool IsReady() const override;
+        void Wait() override;
 
         // Returns the native PSO.
         inline VkPipeline GetVkPipeline() const
@@ -41,6 +46,18 @@ class VKPipelineState : public PipelineState
             return bindPoint_;
         }
 
+        // Returns the pipeline layout this PSO was created with, or null if the default pipeline layout is used.
+        inline const VKPipelineLayout* GetPipelineLayout() const
+        {
+            return pipelineLayout_;
+        }
+
+        // Returns true if draw or dispatch commands must be skipped while this PSO is still being compiled.
+        inline bool SkipDraws() const
+        {
+            return compileTask_.SkipDraws();
+        }
+
     protected:
 
         static VkPipelineLayout GetVkPipelineLayoutOrDefault(
@@ -48,13 +65,28 @@ class VKPipelineState : public PipelineState
             VkPipelineLayout        defaultPipelineLayout
         );
 
+        /*
+        Fills the specialization info for the specified constants and returns a pointer to it, or null if there are no constants.
+        The output refers to the constants directly, so they must remain valid until the native PSO has been created.
+        */
+        static const VkSpecializationInfo* FillSpecializationInfo(
+            const std::vector<SpecializationConstant>&  constants,
+            VkSpecializationInfo&                       outInfo,
+            std::vector<VkSpecializationMapEntry>&      outEntries
+        );
+
         // Releases the native PSO and returns its address.
         VkPipeline* GetVkPipelineAddress();
 
+        // Runs the specified function to create the native PSO on the job system.
+        void StartCompileTask(const std::function<void()>& task, long flags);
+
     private:
 
-        VKPtr<VkPipeline>   pipeline_;
-        VkPipelineBindPoint bindPoint_  = VK_PIPELINE_BIND_POINT_MAX_ENUM;
+        VKPtr<VkPipeline>       pipeline_;
+        VkPipelineBindPoint     bindPoint_      = VK_PIPELINE_BIND_POINT_MAX_ENUM;
+        const VKPipelineLayout* pipelineLayout_ = nullptr;
+        PipelineCompileTask     compileTask_;   // Must be declared after 'pipeline_' to wait for a pending task before the PSO is destroyed.
 
 };
 
@@ -22,9 +22,9 @@ VKPredicateQueryHeap::VKPredicateQueryHeap(
     VKDeviceMemoryManager&      deviceMemoryManager,
     const QueryHeapDescriptor&  desc)
 :
-    VKQueryHeap   { device, desc        },
-    resultBuffer_ { device              },
-    memoryMngr_   { deviceMemoryManager }
+    VKQueryHeap   { device, deviceMemoryManager, desc },
+    resultBuffer_ { device                            },
+    memoryMngr_   { deviceMemoryManager               }
 {
     /* Create result buffer for occlusion predicates */
     VkBufferCreateInfo createInfo;
@@ -92,18 +92,71 @@ void VKPredicateQueryHeap::InvalidateDirtyRange()
     dirtyRange_[1] = 0;
 }
 
+static void InsertResultBufferBarrier(
+    VkCommandBuffer         commandBuffer,
+    VkBuffer                buffer,
+    VkDeviceSize            offset,
+    VkDeviceSize            size,
+    VkAccessFlags           srcAccessMask,
+    VkAccessFlags           dstAccessMask,
+    VkPipelineStageFlags    srcStageMask,
+    VkPipelineStageFlags    dstStageMask)
+{
+    VkBufferMemoryBarrier barrier;
+    {
+        barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.pNext               = nullptr;
+        barrier.srcAccessMask       = srcAccessMask;
+        barrier.dstAccessMask       = dstAccessMask;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.buffer              = buffer;
+        barrier.offset              = offset;
+        barrier.size                = size;
+    }
+    vkCmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+}
+
 void VKPredicateQueryHeap::ResolveData(VkCommandBuffer commandBuffer, std::uint32_t firstQuery, std::uint32_t numQueries)
 {
+    const VkDeviceSize offset   = firstQuery * sizeof(std::uint32_t);
+    const VkDeviceSize size     = numQueries * sizeof(std::uint32_t);
+
+    /* Wait for previous conditional rendering blocks before the predicates are overwritten */
+    InsertResultBufferBarrier(
+        commandBuffer,
+        GetResultVkBuffer(),
+        offset,
+        size,
+        VK_ACCESS_CONDITIONAL_RENDERING_READ_BIT_EXT,
+        VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_PIPELINE_STAGE_CONDITIONAL_RENDERING_BIT_EXT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT
+    );
+
+    /* Resolve predicates on the GPU; the copy waits for the query results on the device timeline, not on the CPU */
     vkCmdCopyQueryPoolResults(
         commandBuffer,
         GetVkQueryPool(),
         firstQuery,
         numQueries,
         GetResultVkBuffer(),
-        firstQuery * sizeof(std::uint32_t),
+        offset,
         sizeof(std::uint32_t),
         VK_QUERY_RESULT_WAIT_BIT
     );
+
+    /* Make predicates visible to the conditional rendering stage */
+    InsertResultBufferBarrier(
+        commandBuffer,
+        GetResultVkBuffer(),
+        offset,
+        size,
+        VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_ACCESS_CONDITIONAL_RENDERING_READ_BIT_EXT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_CONDITIONAL_RENDERING_BIT_EXT
+    );
 }
 
 
@@ -8,6 +8,9 @@
 #include "VKQueryHeap.h"
 #include "../VKCore.h"
 #include "../VKTypes.h"
+#include "../Memory/VKDeviceMemoryManager.h"
+#include "../../QueryUtils.h"
+#include <cstring>
 
 
 namespace LLGL
@@ -42,6 +45,12 @@ static VkQueryPipelineStatisticFlags GetPipelineStatisticsFlags(const QueryHeapD
     return 0;
 }
 
+// Returns the number of 64-bit values each native query writes into a readback slot, i.e. the results plus the availability word
+static std::uint32_t GetNumReadbackValues(const QueryHeapDescriptor& desc)
+{
+    return (desc.type == QueryType::PipelineStatistics ? 11 : 1) + 1;
+}
+
 static VkQueryControlFlags GetQueryControlFlags(const QueryHeapDescriptor& desc)
 {
     VkQueryControlFlags flags = 0;
@@ -52,13 +61,20 @@ static VkQueryControlFlags GetQueryControlFlags(const QueryHeapDescriptor& desc)
     return flags;
 }
 
-VKQueryHeap::VKQueryHeap(const VKPtr<VkDevice>& device, const QueryHeapDescriptor& desc) :
-    QueryHeap      { desc.type                    },
-    queryPool_     { device, vkDestroyQueryPool   },
-    controlFlags_  { GetQueryControlFlags(desc)   },
-    groupSize_     { GetQueryGroupSize(desc)      },
-    numQueries_    { desc.numQueries * groupSize_ },
-    hasPredicates_ { desc.renderCondition         }
+VKQueryHeap::VKQueryHeap(
+    const VKPtr<VkDevice>&      device,
+    VKDeviceMemoryManager&      deviceMemoryManager,
+    const QueryHeapDescriptor&  desc)
+:
+    QueryHeap       { desc.type                                          },
+    device_         { device                                             },
+    memoryMngr_     { deviceMemoryManager                                },
+    queryPool_      { device, vkDestroyQueryPool                         },
+    controlFlags_   { GetQueryControlFlags(desc)                         },
+    groupSize_      { GetQueryGroupSize(desc)                            },
+    numQueries_     { desc.numQueries * groupSize_                       },
+    hasPredicates_  { desc.renderCondition                               },
+    readbackStride_ { GetNumReadbackValues(desc) * sizeof(std::uint64_t) }
 {
     /* Create query pool object */
     VkQueryPoolCreateInfo createInfo;
@@ -74,6 +90,182 @@ VKQueryHeap::VKQueryHeap(const VKPtr<VkDevice>& device, const QueryHeapDescripto
     VKThrowIfFailed(result, "failed to create Vulkan query pool");
 }
 
+VKQueryHeap::~VKQueryHeap()
+{
+    if (mappedReadback_ != nullptr)
+        readbackSlots_[pendingReadbacks_.front()].buffer.Unmap(device_);
+    for (auto& slot : readbackSlots_)
+        slot.buffer.ReleaseMemoryRegion(memoryMngr_);
+}
+
+void VKQueryHeap::ResolveToReadbackRing(VkCommandBuffer commandBuffer, std::uint32_t firstQuery, std::uint32_t numQueries)
+{
+    auto& slot = AcquireReadbackSlot(firstQuery, numQueries);
+    AppendQueryRange(slot.ranges, firstQuery, numQueries);
+
+    const auto firstNativeQuery = firstQuery * groupSize_;
+    const auto numNativeQueries = numQueries * groupSize_;
+    const auto offset           = readbackStride_ * firstNativeQuery;
+    const auto size             = readbackStride_ * numNativeQueries;
+
+    /* Clear availability words of the range, so the CPU can detect when the GPU has written the results */
+    if (auto mappedData = slot.buffer.Map(device_, offset, size))
+    {
+        ::memset(mappedData, 0, static_cast<std::size_t>(size));
+        slot.buffer.Unmap(device_);
+    }
+
+    /* Copy results with availability words; the GPU waits for the queries, but the CPU never does */
+    vkCmdCopyQueryPoolResults(
+        commandBuffer,
+        GetVkQueryPool(),
+        firstNativeQuery,
+        numNativeQueries,
+        slot.buffer.GetVkBuffer(),
+        offset,
+        readbackStride_,
+        (VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT)
+    );
+
+    /* Make results visible to the host */
+    VkMemoryBarrier barrier;
+    {
+        barrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.pNext           = nullptr;
+        barrier.srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask   = VK_ACCESS_HOST_READ_BIT;
+    }
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_HOST_BIT,
+        0,
+        1, &barrier,
+        0, nullptr,
+        0, nullptr
+    );
+}
+
+const std::vector<QueryRange>* VKQueryHeap::GetCompletedReadbackRanges()
+{
+    if (pendingReadbacks_.empty())
+        return nullptr;
+
+    auto& slot = readbackSlots_[pendingReadbacks_.front()];
+
+    if (mappedReadback_ == nullptr)
+    {
+        /* Map oldest slot and check whether the GPU has written all of its availability words */
+        auto mappedData = reinterpret_cast<const std::uint8_t*>(slot.buffer.Map(device_));
+        if (mappedData == nullptr)
+            return nullptr;
+
+        if (!IsReadbackAvailable(slot, mappedData))
+        {
+            slot.buffer.Unmap(device_);
+            return nullptr;
+        }
+
+        mappedReadback_ = mappedData;
+    }
+
+    return &(slot.ranges);
+}
+
+const std::uint64_t* VKQueryHeap::GetCompletedReadbackValues(std::uint32_t nativeQuery) const
+{
+    return reinterpret_cast<const std::uint64_t*>(mappedReadback_ + readbackStride_ * nativeQuery);
+}
+
+void VKQueryHeap::ReleaseCompletedReadback()
+{
+    auto& slot = readbackSlots_[pendingReadbacks_.front()];
+
+    if (mappedReadback_ != nullptr)
+    {
+        slot.buffer.Unmap(device_);
+        mappedReadback_ = nullptr;
+    }
+
+    /* Mark slot as free and remove it from the pending list */
+    slot.ranges.clear();
+    pendingReadbacks_.erase(pendingReadbacks_.begin());
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+VKQueryHeap::ReadbackSlot& VKQueryHeap::AcquireReadbackSlot(std::uint32_t firstQuery, std::uint32_t numQueries)
+{
+    /*
+    Resolve into the most recent slot if the range has not been resolved into it yet.
+    The slot is only read back once all of its ranges are available, so the ranges can stem from different submissions.
+    */
+    if (!pendingReadbacks_.empty() && mappedReadback_ == nullptr)
+    {
+        auto& lastSlot = readbackSlots_[pendingReadbacks_.back()];
+        if (!IsQueryRangeOverlapping(lastSlot.ranges, firstQuery, numQueries))
+            return lastSlot;
+    }
+
+    /* Find free slot or create a new one; each slot is large enough to hold the results of the entire heap */
+    std::size_t slotIndex = 0;
+    while (slotIndex < readbackSlots_.size() && !readbackSlots_[slotIndex].ranges.empty())
+        ++slotIndex;
+
+    if (slotIndex == readbackSlots_.size())
+    {
+        VkBufferCreateInfo createInfo;
+        {
+            createInfo.sType                    = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            createInfo.pNext                    = nullptr;
+            createInfo.flags                    = 0;
+            createInfo.size                     = readbackStride_ * numQueries_;
+            createInfo.usage                    = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+            createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
+            createInfo.queueFamilyIndexCount    = 0;
+            createInfo.pQueueFamilyIndices      = nullptr;
+        }
+        readbackSlots_.push_back(
+            ReadbackSlot
+            {
+                VKDeviceBuffer
+                {
+                    device_,
+                    createInfo,
+                    memoryMngr_,
+                    (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+                },
+                {}
+            }
+        );
+    }
+
+    pendingReadbacks_.push_back(slotIndex);
+
+    return readbackSlots_[slotIndex];
+}
+
+bool VKQueryHeap::IsReadbackAvailable(const ReadbackSlot& slot, const std::uint8_t* mappedData) const
+{
+    /* The availability word follows the result values of each native query */
+    const auto availabilityOffset = readbackStride_ - sizeof(std::uint64_t);
+
+    for (const auto& range : slot.ranges)
+    {
+        for (std::uint32_t i = range.firstQuery * groupSize_, n = i + range.numQueries * groupSize_; i < n; ++i)
+        {
+            const auto availability = reinterpret_cast<const std::uint64_t*>(mappedData + readbackStride_ * i + availabilityOffset);
+            if (*availability == 0)
+                return false;
+        }
+    }
+
+    return true;
+}
+
 
 } // /namespace LLGL
 
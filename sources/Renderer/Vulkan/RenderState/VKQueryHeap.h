@@ -12,19 +12,43 @@
 #include <LLGL/QueryHeap.h>
 #include "../Vulkan.h"
 #include "../VKPtr.h"
+#include "../Buffer/VKDeviceBuffer.h"
+#include <vector>
 
 
 namespace LLGL
 {
 
 
+class VKDeviceMemoryManager;
+
 // Base class for Vulkan query heaps (sub class: VKPredicateQueryHeap).
 class VKQueryHeap : public QueryHeap
 {
 
     public:
 
-        VKQueryHeap(const VKPtr<VkDevice>& device, const QueryHeapDescriptor& desc);
+        VKQueryHeap(
+            const VKPtr<VkDevice>&      device,
+            VKDeviceMemoryManager&      deviceMemoryManager,
+            const QueryHeapDescriptor&  desc
+        );
+        ~VKQueryHeap();
+
+        // Records a copy of the specified query results into the readback ring. Must be called outside of a render pass.
+        void ResolveToReadbackRing(VkCommandBuffer commandBuffer, std::uint32_t firstQuery, std::uint32_t numQueries);
+
+        /*
+        Returns the resolved ranges of the oldest readback slot if all of them have been completed by the GPU, or null otherwise.
+        The slot is mapped to CPU local memory until ReleaseCompletedReadback is called.
+        */
+        const std::vector<QueryRange>* GetCompletedReadbackRanges();
+
+        // Returns the native result values of the specified native query within the oldest completed readback slot.
+        const std::uint64_t* GetCompletedReadbackValues(std::uint32_t nativeQuery) const;
+
+        // Unmaps the oldest completed readback slot and releases it for subsequent resolves.
+        void ReleaseCompletedReadback();
 
         // Returns the Vulkan VkQueryPool object.
         inline VkQueryPool GetVkQueryPool() const
@@ -58,11 +82,36 @@ class VKQueryHeap : public QueryHeap
 
     private:
 
-        VKPtr<VkQueryPool>  queryPool_;
-        VkQueryControlFlags controlFlags_   = 0;
-        std::uint32_t       groupSize_      = 1;
-        std::uint32_t       numQueries_     = 0;
-        bool                hasPredicates_  = false;
+        // Readback slot with the results and availability words of all native queries.
+        struct ReadbackSlot
+        {
+            VKDeviceBuffer          buffer;
+            std::vector<QueryRange> ranges;     // Resolved ranges; empty if the slot is free
+        };
+
+    private:
+
+        // Returns the readback slot the specified range can be resolved into. Creates a new slot if no slot is free.
+        ReadbackSlot& AcquireReadbackSlot(std::uint32_t firstQuery, std::uint32_t numQueries);
+
+        // Returns true if the availability words of all resolved ranges in the specified mapped slot are set.
+        bool IsReadbackAvailable(const ReadbackSlot& slot, const std::uint8_t* mappedData) const;
+
+    private:
+
+        const VKPtr<VkDevice>&      device_;
+        VKDeviceMemoryManager&      memoryMngr_;
+
+        VKPtr<VkQueryPool>          queryPool_;
+        VkQueryControlFlags         controlFlags_       = 0;
+        std::uint32_t               groupSize_          = 1;
+        std::uint32_t               numQueries_         = 0;
+        bool                        hasPredicates_      = false;
+
+        VkDeviceSize                readbackStride_     = 0;        // Size of each native query in a readback slot, including the availability word
+        std::vector<ReadbackSlot>   readbackSlots_;
+        std::vector<std::size_t>    pendingReadbacks_;              // Indices of readback slots in the order they have been resolved (oldest first)
+        const std::uint8_t*         mappedReadback_     = nullptr;  // Mapped data of the oldest completed readback slot
 
 };
 
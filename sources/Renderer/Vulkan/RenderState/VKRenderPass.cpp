@@ -131,7 +131,9 @@ void VKRenderPass::CreateVkRenderPass(VkDevice device, const RenderPassDescripto
         numAttachments,
         numColorAttachments,
         attachmentDescs.data(),
-        sampleCountBits
+        sampleCountBits,
+        desc.numSubpasses,
+        desc.subpasses
     );
 }
 
@@ -140,86 +142,117 @@ void VKRenderPass::CreateVkRenderPassWithDescriptors(
     std::uint32_t                   numAttachments,
     std::uint32_t                   numColorAttachments,
     const VkAttachmentDescription*  attachmentDescs,
-    VkSampleCountFlagBits           sampleCountBits)
+    VkSampleCountFlagBits           sampleCountBits,
+    std::uint32_t                   numSubpasses,
+    const SubpassDescriptor*        subpasses)
 {
-    /* Store sample count bits */
-    sampleCountBits_ = sampleCountBits;
+    StoreAttachmentAttributes(numAttachments, numColorAttachments, attachmentDescs, sampleCountBits);
     const bool multiSampleEnabled = (sampleCountBits > VK_SAMPLE_COUNT_1_BIT);
+    const bool hasDepthStencil = (numColorAttachments < numAttachments);
 
-    std::vector<VkAttachmentReference> rtvAttachmentsRefs(numAttachments);
-    std::vector<VkAttachmentReference> rtvMsaaAttachmentsRefs;
-    VkAttachmentReference dsvAttachmentRef = {};
-
-    /* Store index for depth-stencil attachment */
-    bool hasDepthStencil = (numColorAttachments < numAttachments);
-    if (hasDepthStencil)
-        depthStencilIndex_ = static_cast<std::uint8_t>(numColorAttachments);
+    /* Use a single implicit sub-pass that writes to all attachments if no sub-passes are specified */
+    SubpassDescriptor defaultSubpass;
+    if (numSubpasses == 0 || subpasses == nullptr)
+    {
+        defaultSubpass.colorAttachments         = (numColorAttachments < 32 ? (1u << numColorAttachments) - 1u : ~0u);
+        defaultSubpass.inputAttachments         = 0;
+        defaultSubpass.depthStencilAttachment   = true;
+        numSubpasses    = 1;
+        subpasses       = &defaultSubpass;
+    }
+    numSubpasses_ = static_cast<std::uint8_t>(numSubpasses);
 
-    /* Store number of color attachments (required for default blend states in VKGraphicsPipeline) */
-    numColorAttachments_ = static_cast<std::uint8_t>(numColorAttachments);
+    /* Each sub-pass references the color, resolve, and input attachments plus the depth-stencil attachment */
+    const std::uint32_t numRefsPerSubpass = numColorAttachments * 3 + 1;
+    const VkAttachmentReference unusedAttachmentRef = { VK_ATTACHMENT_UNUSED, VK_IMAGE_LAYOUT_UNDEFINED };
 
-    /* Build bitmask for clear values: least significant bit (LSB) is used for the first attachment */
-    clearValuesMask_ = 0;
+    std::vector<VkAttachmentReference>  attachmentRefs(numSubpasses * numRefsPerSubpass, unusedAttachmentRef);
+    std::vector<std::uint32_t>          preserveAttachments(numSubpasses * numAttachments);
+    std::vector<VkSubpassDescription>   subpassDescs(numSubpasses);
 
-    for (std::uint32_t i = 0; i < numAttachments; ++i)
+    for (std::uint32_t subpassIndex = 0; subpassIndex < numSubpasses; ++subpassIndex)
     {
-        if (attachmentDescs[multiSampleEnabled && i + 1 < numAttachments ? numAttachments + i : i].loadOp == VK_ATTACHMENT_LOAD_OP_CLEAR)
-        {
-            clearValuesMask_ |= (0x1ull << i);
-            numClearValues_ = std::max(numClearValues_, static_cast<std::uint8_t>(i + 1));
-        }
-    }
+        const SubpassDescriptor& subpass = subpasses[subpassIndex];
 
-    /* Initialize attachment reference */
-    for (std::uint32_t i = 0; i < numColorAttachments; ++i)
-    {
-        rtvAttachmentsRefs[i].attachment    = i;
-        rtvAttachmentsRefs[i].layout        = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-    }
+        VkAttachmentReference*  colorRefs       = &(attachmentRefs[subpassIndex * numRefsPerSubpass]);
+        VkAttachmentReference*  resolveRefs     = colorRefs + numColorAttachments;
+        VkAttachmentReference*  inputRefs       = resolveRefs + numColorAttachments;
+        VkAttachmentReference*  dsvRef          = inputRefs + numColorAttachments;
+        std::uint32_t*          preserveRefs    = &(preserveAttachments[subpassIndex * numAttachments]);
+        std::uint32_t           numPreserveRefs = 0;
 
-    if (hasDepthStencil)
-    {
-        dsvAttachmentRef.attachment = depthStencilIndex_;
-        dsvAttachmentRef.layout     = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-    }
+        /* Gather attachments that are referenced by any of the following sub-passes */
+        std::uint32_t   subsequentColorUsage    = 0;
+        bool            subsequentDepthUsage    = false;
 
-    if (multiSampleEnabled)
-    {
-        rtvMsaaAttachmentsRefs.resize(numColorAttachments);
+        for (std::uint32_t nextSubpassIndex = subpassIndex + 1; nextSubpassIndex < numSubpasses; ++nextSubpassIndex)
+        {
+            subsequentColorUsage |= (subpasses[nextSubpassIndex].colorAttachments | subpasses[nextSubpassIndex].inputAttachments);
+            subsequentDepthUsage |= subpasses[nextSubpassIndex].depthStencilAttachment;
+        }
+
+        /* Initialize attachment references; multi-sampled attachments are rendered into and resolved into the primary attachments */
         for (std::uint32_t i = 0; i < numColorAttachments; ++i)
         {
-            rtvMsaaAttachmentsRefs[i].attachment    = numAttachments + i;
-            rtvMsaaAttachmentsRefs[i].layout        = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            const std::uint32_t attachmentBit       = (1u << i);
+            const std::uint32_t renderAttachment    = (multiSampleEnabled ? numAttachments + i : i);
+            const bool          isColorOutput       = ((subpass.colorAttachments & attachmentBit) != 0);
+            const bool          isInput             = ((subpass.inputAttachments & attachmentBit) != 0);
+
+            if (isColorOutput)
+            {
+                /* Attachments that are read and written within the same sub-pass must use the general layout */
+                colorRefs[i].attachment = renderAttachment;
+                colorRefs[i].layout     = (isInput ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+                if (multiSampleEnabled)
+                {
+                    resolveRefs[i].attachment   = i;
+                    resolveRefs[i].layout       = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+                }
+            }
+
+            if (isInput)
+            {
+                inputRefs[i].attachment = renderAttachment;
+                inputRefs[i].layout     = (isColorOutput ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+            }
+
+            /* Preserve contents of attachments that are skipped by this sub-pass but referenced later */
+            if (!isColorOutput && !isInput && (subsequentColorUsage & attachmentBit) != 0)
+                preserveRefs[numPreserveRefs++] = renderAttachment;
         }
-    }
 
-    /* Initialize sub-pass descriptor */
-    VkSubpassDescription subpassDesc;
-    {
-        subpassDesc.flags                   = 0;
-        subpassDesc.pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
-        subpassDesc.inputAttachmentCount    = 0;
-        subpassDesc.pInputAttachments       = nullptr;
-        subpassDesc.colorAttachmentCount    = numColorAttachments;
-        if (rtvMsaaAttachmentsRefs.empty())
+        if (hasDepthStencil)
         {
-            subpassDesc.pColorAttachments   = rtvAttachmentsRefs.data();
-            subpassDesc.pResolveAttachments = nullptr;
+            if (subpass.depthStencilAttachment)
+            {
+                dsvRef->attachment  = depthStencilIndex_;
+                dsvRef->layout      = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+            }
+            else if (subsequentDepthUsage)
+                preserveRefs[numPreserveRefs++] = depthStencilIndex_;
         }
-        else
+
+        /* Initialize sub-pass descriptor */
+        VkSubpassDescription& subpassDesc = subpassDescs[subpassIndex];
         {
-            /* Swap color and resolve attachments */
-            subpassDesc.pColorAttachments   = rtvMsaaAttachmentsRefs.data();
-            subpassDesc.pResolveAttachments = rtvAttachmentsRefs.data();
+            subpassDesc.flags                   = 0;
+            subpassDesc.pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
+            subpassDesc.inputAttachmentCount    = (subpass.inputAttachments != 0 ? numColorAttachments : 0);
+            subpassDesc.pInputAttachments       = (subpass.inputAttachments != 0 ? inputRefs : nullptr);
+            subpassDesc.colorAttachmentCount    = numColorAttachments;
+            subpassDesc.pColorAttachments       = colorRefs;
+            subpassDesc.pResolveAttachments     = (multiSampleEnabled ? resolveRefs : nullptr);
+            subpassDesc.pDepthStencilAttachment = (hasDepthStencil && subpass.depthStencilAttachment ? dsvRef : nullptr);
+            subpassDesc.preserveAttachmentCount = numPreserveRefs;
+            subpassDesc.pPreserveAttachments    = (numPreserveRefs > 0 ? preserveRefs : nullptr);
         }
-        subpassDesc.pDepthStencilAttachment = (hasDepthStencil ? &dsvAttachmentRef : nullptr);
-        subpassDesc.preserveAttachmentCount = 0;
-        subpassDesc.pPreserveAttachments    = nullptr;
     }
 
-    /* Initialize sub-pass dependency */
-    VkSubpassDependency subpassDep;
+    /* Initialize sub-pass dependencies: external dependency for the first sub-pass and a chain between all consecutive sub-passes */
+    std::vector<VkSubpassDependency> subpassDeps(numSubpasses);
     {
+        VkSubpassDependency& subpassDep = subpassDeps[0];
         subpassDep.srcSubpass               = VK_SUBPASS_EXTERNAL;
         subpassDep.dstSubpass               = 0;
         subpassDep.srcStageMask             = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT; //VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT
@@ -228,6 +261,19 @@ void VKRenderPass::CreateVkRenderPassWithDescriptors(
         subpassDep.dstAccessMask            = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
         subpassDep.dependencyFlags          = 0;
     }
+    for (std::uint32_t subpassIndex = 1; subpassIndex < numSubpasses; ++subpassIndex)
+    {
+        /* Make attachment writes of the previous sub-pass visible to input attachment reads of the next sub-pass (on-tile for the same pixel) */
+        VkSubpassDependency& subpassDep = subpassDeps[subpassIndex];
+        subpassDep.srcSubpass               = subpassIndex - 1;
+        subpassDep.dstSubpass               = subpassIndex;
+        subpassDep.srcStageMask             = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        subpassDep.dstStageMask             = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+        subpassDep.srcAccessMask            = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        subpassDep.dstAccessMask            = VK_ACCESS_INPUT_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                                              VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        subpassDep.dependencyFlags          = VK_DEPENDENCY_BY_REGION_BIT;
+    }
 
     /* Create swap-chain render pass */
     VkRenderPassCreateInfo createInfo;
@@ -237,15 +283,124 @@ void VKRenderPass::CreateVkRenderPassWithDescriptors(
         createInfo.flags                    = 0;
         createInfo.attachmentCount          = (multiSampleEnabled ? numAttachments + numColorAttachments : numAttachments);
         createInfo.pAttachments             = attachmentDescs;
-        createInfo.subpassCount             = 1;
-        createInfo.pSubpasses               = (&subpassDesc);
-        createInfo.dependencyCount          = 1;
-        createInfo.pDependencies            = (&subpassDep);
+        createInfo.subpassCount             = numSubpasses;
+        createInfo.pSubpasses               = subpassDescs.data();
+        createInfo.dependencyCount          = static_cast<std::uint32_t>(subpassDeps.size());
+        createInfo.pDependencies            = subpassDeps.data();
     }
     auto result = vkCreateRenderPass(device, &createInfo, nullptr, renderPass_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan render pass");
 }
 
+void VKRenderPass::InitDynamicRenderingWithDescriptors(
+    std::uint32_t                   numAttachments,
+    std::uint32_t                   numColorAttachments,
+    const VkAttachmentDescription*  attachmentDescs,
+    VkSampleCountFlagBits           sampleCountBits)
+{
+    StoreAttachmentAttributes(numAttachments, numColorAttachments, attachmentDescs, sampleCountBits);
+    renderPass_.Release();
+    dynamicRendering_   = true;
+    numSubpasses_       = 1;
+}
+
+VkFormat VKRenderPass::GetDepthStencilFormat() const
+{
+    return (depthStencilIndex_ != 0xFFu ? attachmentDescs_[depthStencilIndex_].format : VK_FORMAT_UNDEFINED);
+}
+
+static bool HasVkFormatDepthAspect(VkFormat format)
+{
+    switch (format)
+    {
+        case VK_FORMAT_D16_UNORM:
+        case VK_FORMAT_X8_D24_UNORM_PACK32:
+        case VK_FORMAT_D32_SFLOAT:
+        case VK_FORMAT_D16_UNORM_S8_UINT:
+        case VK_FORMAT_D24_UNORM_S8_UINT:
+        case VK_FORMAT_D32_SFLOAT_S8_UINT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool HasVkFormatStencilAspect(VkFormat format)
+{
+    switch (format)
+    {
+        case VK_FORMAT_S8_UINT:
+        case VK_FORMAT_D16_UNORM_S8_UINT:
+        case VK_FORMAT_D24_UNORM_S8_UINT:
+        case VK_FORMAT_D32_SFLOAT_S8_UINT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void VKRenderPass::GetDynamicRenderingFormats(VkFormat* outColorFormats, VkFormat& outDepthFormat, VkFormat& outStencilFormat) const
+{
+    for_range(i, numColorAttachments_)
+        outColorFormats[i] = attachmentDescs_[i].format;
+
+    const VkFormat depthStencilFormat = GetDepthStencilFormat();
+    outDepthFormat      = (HasVkFormatDepthAspect(depthStencilFormat) ? depthStencilFormat : VK_FORMAT_UNDEFINED);
+    outStencilFormat    = (HasVkFormatStencilAspect(depthStencilFormat) ? depthStencilFormat : VK_FORMAT_UNDEFINED);
+}
+
+const VkAttachmentDescription& VKRenderPass::GetColorAttachmentDesc(std::uint32_t colorAttachment) const
+{
+    if (sampleCountBits_ > VK_SAMPLE_COUNT_1_BIT)
+    {
+        /* Multi-sampled attachments follow the color and depth-stencil attachments */
+        const std::uint32_t numAttachments = (depthStencilIndex_ != 0xFFu ? numColorAttachments_ + 1u : numColorAttachments_);
+        return attachmentDescs_[numAttachments + colorAttachment];
+    }
+    return attachmentDescs_[colorAttachment];
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void VKRenderPass::StoreAttachmentAttributes(
+    std::uint32_t                   numAttachments,
+    std::uint32_t                   numColorAttachments,
+    const VkAttachmentDescription*  attachmentDescs,
+    VkSampleCountFlagBits           sampleCountBits)
+{
+    /* Store sample count bits */
+    sampleCountBits_ = sampleCountBits;
+    const bool multiSampleEnabled = (sampleCountBits > VK_SAMPLE_COUNT_1_BIT);
+
+    /* Store copy of attachment descriptors (multi-sampled attachments follow the primary attachments) */
+    attachmentDescs_.assign(attachmentDescs, attachmentDescs + (multiSampleEnabled ? numAttachments + numColorAttachments : numAttachments));
+
+    /* Store index for depth-stencil attachment */
+    if (numColorAttachments < numAttachments)
+        depthStencilIndex_ = static_cast<std::uint8_t>(numColorAttachments);
+    else
+        depthStencilIndex_ = 0xFFu;
+
+    /* Store number of color attachments (required for default blend states in VKGraphicsPipeline) */
+    numColorAttachments_ = static_cast<std::uint8_t>(numColorAttachments);
+
+    /* Build bitmask for clear values: least significant bit (LSB) is used for the first attachment */
+    clearValuesMask_    = 0;
+    numClearValues_     = 0;
+
+    for (std::uint32_t i = 0; i < numAttachments; ++i)
+    {
+        if (attachmentDescs[multiSampleEnabled && i + 1 < numAttachments ? numAttachments + i : i].loadOp == VK_ATTACHMENT_LOAD_OP_CLEAR)
+        {
+            clearValuesMask_ |= (0x1ull << i);
+            numClearValues_ = std::max(numClearValues_, static_cast<std::uint8_t>(i + 1));
+        }
+    }
+}
+
 
 } // /namespace LLGL
 
@@ -13,6 +13,7 @@
 #include <vulkan/vulkan.h>
 #include "../VKPtr.h"
 #include <cstdint>
+#include <vector>
 
 
 namespace LLGL
@@ -20,6 +21,7 @@ namespace LLGL
 
 
 struct RenderPassDescriptor;
+struct SubpassDescriptor;
 
 class VKRenderPass final : public RenderPass
 {
@@ -35,14 +37,58 @@ class VKRenderPass final : public RenderPass
             const RenderPassDescriptor& desc
         );
 
+        /*
+        Creates the native render pass object with the specified attachment descriptors.
+        If no sub-passes are specified, a single sub-pass is created that writes to all attachments.
+        */
         void CreateVkRenderPassWithDescriptors(
             VkDevice                        device,
+            std::uint32_t                   numAttachments,
+            std::uint32_t                   numColorAttachments,
+            const VkAttachmentDescription*  attachmentDescs,
+            VkSampleCountFlagBits           sampleCountBits,
+            std::uint32_t                   numSubpasses        = 0,
+            const SubpassDescriptor*        subpasses           = nullptr
+        );
+
+        /*
+        Initializes this render pass for dynamic rendering ("VK_KHR_dynamic_rendering"), i.e. no native render pass object is created.
+        The attachment descriptors are only stored to begin rendering instances and to create compatible graphics pipelines.
+        */
+        void InitDynamicRenderingWithDescriptors(
             std::uint32_t                   numAttachments,
             std::uint32_t                   numColorAttachments,
             const VkAttachmentDescription*  attachmentDescs,
             VkSampleCountFlagBits           sampleCountBits
         );
 
+        // Returns the format of the depth-stencil attachment or VK_FORMAT_UNDEFINED if there is none.
+        VkFormat GetDepthStencilFormat() const;
+
+        /*
+        Returns the attachment formats for dynamic rendering, e.g. for VkPipelineRenderingCreateInfoKHR.
+        'outColorFormats' must point to an array of at least GetNumColorAttachments() elements.
+        */
+        void GetDynamicRenderingFormats(VkFormat* outColorFormats, VkFormat& outDepthFormat, VkFormat& outStencilFormat) const;
+
+        /*
+        Returns the attachment descriptor that determines the load and store operations of the specified color attachment.
+        For multi-sampled render passes, this is the descriptor of the multi-sampled attachment, which is resolved into the color attachment.
+        */
+        const VkAttachmentDescription& GetColorAttachmentDesc(std::uint32_t colorAttachment) const;
+
+        // Returns the attachment descriptor of the depth-stencil attachment. Only valid if GetDepthStencilIndex() is not 0xFF.
+        inline const VkAttachmentDescription& GetDepthStencilAttachmentDesc() const
+        {
+            return attachmentDescs_[depthStencilIndex_];
+        }
+
+        // Returns true if this render pass is used for dynamic rendering and has no native render pass object.
+        inline bool IsDynamicRendering() const
+        {
+            return dynamicRendering_;
+        }
+
         // Returns the Vulkan render pass object.
         inline VkRenderPass GetVkRenderPass() const
         {
@@ -76,6 +122,12 @@ class VKRenderPass final : public RenderPass
             return numColorAttachments_;
         }
 
+        // Returns the number of sub-passes of this render pass. This is always at least 1.
+        inline std::uint8_t GetNumSubpasses() const
+        {
+            return numSubpasses_;
+        }
+
         // Returns the sample count flag bits for this render pass.
         inline VkSampleCountFlagBits GetSampleCountBits() const
         {
@@ -84,12 +136,24 @@ class VKRenderPass final : public RenderPass
 
     private:
 
-        VKPtr<VkRenderPass>     renderPass_;
+        void StoreAttachmentAttributes(
+            std::uint32_t                   numAttachments,
+            std::uint32_t                   numColorAttachments,
+            const VkAttachmentDescription*  attachmentDescs,
+            VkSampleCountFlagBits           sampleCountBits
+        );
+
+    private:
+
+        VKPtr<VkRenderPass>                     renderPass_;
+        std::vector<VkAttachmentDescription>    attachmentDescs_;
+        bool                                    dynamicRendering_       = false;
 
         std::uint64_t           clearValuesMask_        = 0;
         std::uint8_t            depthStencilIndex_      = 0xFFu;
         std::uint8_t            numClearValues_         = 0;
         std::uint8_t            numColorAttachments_    = 0;
+        std::uint8_t            numSubpasses_           = 1;
         VkSampleCountFlagBits   sampleCountBits_        = VK_SAMPLE_COUNT_1_BIT;
 
 };
@@ -0,0 +1,160 @@
+/*
+ * VKRenderPassCache.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKRenderPassCache.h"
+#include "VKRenderPass.h"
+#include "../../../Core/ContainerUtils.h"
+#include <LLGL/Misc/ForRange.h>
+
+
+namespace LLGL
+{
+
+
+VKRenderPassCache::VKRenderPassCache(const VKPtr<VkDevice>& device) :
+    device_ { device }
+{
+}
+
+VKRenderPassCache::~VKRenderPassCache()
+{
+    // dummy; required to destroy the render passes with their complete type
+}
+
+// Serializes all attributes that determine the compatibility of a render pass into a single key.
+static std::vector<std::uint32_t> MakeRenderPassKey(
+    std::uint32_t                   numAttachments,
+    std::uint32_t                   numColorAttachments,
+    const VkAttachmentDescription*  attachmentDescs,
+    VkSampleCountFlagBits           sampleCountBits,
+    bool                            dynamicRendering)
+{
+    const std::uint32_t numAttachmentDescs = (sampleCountBits > VK_SAMPLE_COUNT_1_BIT ? numAttachments + numColorAttachments : numAttachments);
+
+    std::vector<std::uint32_t> key;
+    key.reserve(4 + numAttachmentDescs * 9);
+
+    key.push_back(dynamicRendering ? 1u : 0u);
+    key.push_back(static_cast<std::uint32_t>(sampleCountBits));
+    key.push_back(numAttachments);
+    key.push_back(numColorAttachments);
+
+    for_range(i, numAttachmentDescs)
+    {
+        const auto& desc = attachmentDescs[i];
+        key.push_back(static_cast<std::uint32_t>(desc.flags));
+        key.push_back(static_cast<std::uint32_t>(desc.format));
+        key.push_back(static_cast<std::uint32_t>(desc.samples));
+        key.push_back(static_cast<std::uint32_t>(desc.loadOp));
+        key.push_back(static_cast<std::uint32_t>(desc.storeOp));
+        key.push_back(static_cast<std::uint32_t>(desc.stencilLoadOp));
+        key.push_back(static_cast<std::uint32_t>(desc.stencilStoreOp));
+        key.push_back(static_cast<std::uint32_t>(desc.initialLayout));
+        key.push_back(static_cast<std::uint32_t>(desc.finalLayout));
+    }
+
+    return key;
+}
+
+std::shared_ptr<VKRenderPass> VKRenderPassCache::GetOrCreate(
+    std::uint32_t                   numAttachments,
+    std::uint32_t                   numColorAttachments,
+    const VkAttachmentDescription*  attachmentDescs,
+    VkSampleCountFlagBits           sampleCountBits,
+    bool                            dynamicRendering)
+{
+    auto key = MakeRenderPassKey(numAttachments, numColorAttachments, attachmentDescs, sampleCountBits, dynamicRendering);
+
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    std::size_t insertionIndex = 0;
+    if (auto entry = Find(key, &insertionIndex))
+        return entry->renderPass;
+
+    /* Create new render pass with insertion sort */
+    auto renderPass = std::make_shared<VKRenderPass>(device_);
+    {
+        if (dynamicRendering)
+            renderPass->InitDynamicRenderingWithDescriptors(numAttachments, numColorAttachments, attachmentDescs, sampleCountBits);
+        else
+            renderPass->CreateVkRenderPassWithDescriptors(device_, numAttachments, numColorAttachments, attachmentDescs, sampleCountBits);
+    }
+    Entry newEntry;
+    {
+        newEntry.key        = std::move(key);
+        newEntry.renderPass = renderPass;
+    }
+    entries_.insert(entries_.begin() + insertionIndex, std::move(newEntry));
+
+    return renderPass;
+}
+
+void VKRenderPassCache::Release(std::shared_ptr<VKRenderPass>&& renderPass)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    if (renderPass && renderPass.use_count() == 2)
+    {
+        for (auto it = entries_.begin(); it != entries_.end(); ++it)
+        {
+            if (it->renderPass == renderPass)
+            {
+                entries_.erase(it);
+                break;
+            }
+        }
+    }
+
+    renderPass.reset();
+}
+
+std::size_t VKRenderPassCache::GetSize() const
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    return entries_.size();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+static int CompareRenderPassKeySWO(const std::vector<std::uint32_t>& lhs, const std::vector<std::uint32_t>& rhs)
+{
+    if (lhs.size() < rhs.size())
+        return -1;
+    if (lhs.size() > rhs.size())
+        return +1;
+    for_range(i, lhs.size())
+    {
+        if (lhs[i] < rhs[i])
+            return -1;
+        if (lhs[i] > rhs[i])
+            return +1;
+    }
+    return 0;
+}
+
+VKRenderPassCache::Entry* VKRenderPassCache::Find(const std::vector<std::uint32_t>& key, std::size_t* index)
+{
+    return Utils::FindInSortedArray<Entry>(
+        entries_.data(),
+        entries_.size(),
+        [&key](const Entry& entry) -> int
+        {
+            return CompareRenderPassKeySWO(entry.key, key);
+        },
+        index
+    );
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,89 @@
+/*
+ * VKRenderPassCache.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_RENDER_PASS_CACHE_H
+#define LLGL_VK_RENDER_PASS_CACHE_H
+
+
+#include <vulkan/vulkan.h>
+#include "../VKPtr.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class VKRenderPass;
+
+/*
+Device-wide cache of render passes that are shared between all render targets with equal attachment formats, load/store operations, and sample counts.
+The entries are sorted by their attachment descriptors, and an entry is removed once the last render target that refers to it has been released.
+All functions are guarded by a mutex, so render targets can be created and released from multiple threads.
+*/
+class VKRenderPassCache
+{
+
+    public:
+
+        VKRenderPassCache(const VKPtr<VkDevice>& device);
+        ~VKRenderPassCache();
+
+        VKRenderPassCache(const VKRenderPassCache&) = delete;
+        VKRenderPassCache& operator = (const VKRenderPassCache&) = delete;
+
+        /*
+        Returns the render pass for the specified attachment descriptors, or creates a new one.
+        The multi-sampled attachment descriptors follow the primary attachment descriptors (see VKRenderPass::CreateVkRenderPassWithDescriptors).
+        If 'dynamicRendering' is true, the render pass has no native object and is only used with "VK_KHR_dynamic_rendering".
+        */
+        std::shared_ptr<VKRenderPass> GetOrCreate(
+            std::uint32_t                   numAttachments,
+            std::uint32_t                   numColorAttachments,
+            const VkAttachmentDescription*  attachmentDescs,
+            VkSampleCountFlagBits           sampleCountBits,
+            bool                            dynamicRendering
+        );
+
+        // Releases the specified reference to a render pass and removes it from the cache if no other render target refers to it.
+        void Release(std::shared_ptr<VKRenderPass>&& renderPass);
+
+        // Returns the number of distinct render passes.
+        std::size_t GetSize() const;
+
+    private:
+
+        struct Entry
+        {
+            std::vector<std::uint32_t>      key;
+            std::shared_ptr<VKRenderPass>   renderPass;
+        };
+
+    private:
+
+        Entry* Find(const std::vector<std::uint32_t>& key, std::size_t* index);
+
+    private:
+
+        const VKPtr<VkDevice>&  device_;
+        std::vector<Entry>      entries_;
+        mutable std::mutex      mutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
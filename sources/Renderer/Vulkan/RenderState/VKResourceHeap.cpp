@@ -13,6 +13,7 @@
 #include "../VKTypes.h"
 #include "../VKCore.h"
 #include "../VKContainers.h"
+#include "../Ext/VKExtensions.h"
 #include "../../ResourceUtils.h"
 #include "../../TextureUtils.h"
 #include "../../BufferUtils.h"
@@ -44,29 +45,69 @@ static VkPipelineBindPoint FindPipelineBindPoint(long stageFlags)
 
 VKResourceHeap::VKResourceHeap(
     const VKPtr<VkDevice>&                      device,
+    VKDescriptorSetAllocator&                   descriptorSetAllocator,
     const ResourceHeapDescriptor&               desc,
     const ArrayView<ResourceViewDescriptor>&    initialResourceViews)
 :
-    descriptorPool_ { device, vkDestroyDescriptorPool }
+    descriptorSetAllocator_ { descriptorSetAllocator            },
+    transient_              { desc.transient                    },
+    descriptorPool_         { device, vkDestroyDescriptorPool   }
 {
     /* Get pipeline layout object */
     auto pipelineLayoutVK = LLGL_CAST(VKPipelineLayout*, desc.pipelineLayout);
     if (!pipelineLayoutVK)
         throw std::invalid_argument("failed to create resource view heap due to missing pipeline layout");
 
-    pipelineLayout_ = pipelineLayoutVK->GetVkPipelineLayout();
-    bindPoint_      = FindPipelineBindPoint(pipelineLayoutVK->GetConsolidatedStageFlags());
+    pipelineLayout_     = pipelineLayoutVK->GetVkPipelineLayout();
+    bindPoint_          = FindPipelineBindPoint(pipelineLayoutVK->GetConsolidatedStageFlags());
+    numDynamicOffsets_  = pipelineLayoutVK->GetNumDynamicOffsets();
 
     /* Get and validate number of bindings and resource views */
     CopyLayoutBindings(pipelineLayoutVK->GetBindings());
 
-    const auto numBindings      = static_cast<std::uint32_t>(bindings_.size());
-    const auto numResourceViews = GetNumResourceViewsOrThrow(numBindings, desc, initialResourceViews);
+    const auto numBindings = static_cast<std::uint32_t>(bindings_.size());
+
+    std::uint32_t numDescriptorSets = 0;
 
-    /* Create descriptor pool and array of descriptor sets */
-    const auto numDescriptorSets = (numResourceViews / numBindings);
-    CreateDescriptorPool(device, numDescriptorSets);
-    CreateDescriptorSets(device, numDescriptorSets, pipelineLayoutVK->GetVkDescriptorSetLayout());
+    if (pipelineLayoutVK->HasBindlessBinding())
+    {
+        /* Bindless resource heaps have a single descriptor set with a variable number of descriptors for the last binding */
+        hasBindlessBinding_     = true;
+        numBindlessDescriptors_ = GetNumBindlessDescriptorsOrThrow(numBindings - 1, pipelineLayoutVK->GetMaxBindlessDescriptors(), desc, initialResourceViews);
+        numDescriptorSets       = 1;
+    }
+    else
+    {
+        const auto numResourceViews = GetNumResourceViewsOrThrow(numBindings, desc, initialResourceViews);
+        numDescriptorSets = (numResourceViews / numBindings);
+    }
+
+    /* Create array of descriptor sets; only bindless resource heaps require their own pool for the variable descriptor count */
+    if (hasBindlessBinding_)
+    {
+        CreateDescriptorPool(device, numDescriptorSets);
+        CreateDescriptorSets(device, numDescriptorSets, pipelineLayoutVK->GetVkDescriptorSetLayout());
+    }
+    else
+    {
+        descriptorSets_.resize(numDescriptorSets, VK_NULL_HANDLE);
+        descriptorSetClass_ = descriptorSetAllocator_.Allocate(
+            pipelineLayoutVK->GetVkDescriptorSetLayout(),
+            pipelineLayoutVK->GetBindings(),
+            numDescriptorSets,
+            descriptorSets_.data(),
+            transient_
+        );
+    }
+
+    /* Allocate packed descriptor entries for the descriptor update template of the pipeline layout */
+    updateTemplate_ = pipelineLayoutVK->GetVkDescriptorUpdateTemplate();
+    if (updateTemplate_ != VK_NULL_HANDLE)
+    {
+        numMissingTemplateEntries_ = numDescriptorSets * numBindings;
+        templateEntries_.resize(numMissingTemplateEntries_);
+        templateEntriesWritten_.resize(numMissingTemplateEntries_, false);
+    }
 
     /* Allocate array for descriptor set barriers */
     if ((desc.barrierFlags & BarrierFlags::Storage) != 0)
@@ -77,6 +118,13 @@ VKResourceHeap::VKResourceHeap(
         UpdateDescriptors(device, 0, initialResourceViews);
 }
 
+VKResourceHeap::~VKResourceHeap()
+{
+    /* Return descriptor sets to the shared allocator; descriptor sets of bindless resource heaps are released with their own pool */
+    if (!hasBindlessBinding_)
+        descriptorSetAllocator_.Free(descriptorSetClass_, static_cast<std::uint32_t>(descriptorSets_.size()), descriptorSets_.data(), transient_);
+}
+
 std::uint32_t VKResourceHeap::GetNumDescriptorSets() const
 {
     return static_cast<std::uint32_t>(descriptorSets_.size());
@@ -93,7 +141,7 @@ std::uint32_t VKResourceHeap::UpdateDescriptors(
     /* Allocate local storage for buffer and image descriptors */
     const auto numSets          = GetNumDescriptorSets();
     const auto numBindings      = static_cast<std::uint32_t>(bindings_.size());
-    const auto numDescriptors   = numSets * numBindings;
+    const auto numDescriptors   = (hasBindlessBinding_ ? numBindings - 1 + numBindlessDescriptors_ : numSets * numBindings);
 
     /* Silently quit on out of bounds; debug layer must report these errors */
     if (firstDescriptor >= numDescriptors)
@@ -102,6 +150,8 @@ std::uint32_t VKResourceHeap::UpdateDescriptors(
         return 0;
 
     VKWriteDescriptorContainer container{ resourceViews.size() };
+    std::uint32_t setRange[2] = { numSets, 0 };
+    bool waitIdle = false;
 
     for (const auto& desc : resourceViews)
     {
@@ -110,30 +160,35 @@ std::uint32_t VKResourceHeap::UpdateDescriptors(
             continue;
 
         /* Get resource view information */
-        const auto& binding = bindings_[firstDescriptor % numBindings];
+        std::uint32_t descriptorSet = 0, arrayElement = 0;
+        const auto& binding = GetDescriptorBinding(firstDescriptor, descriptorSet, arrayElement);
 
-        auto descriptorSet = firstDescriptor / numBindings;
+        /* Only bindless descriptors can be updated while the descriptor set is in use */
+        if (!IsBindlessDescriptor(firstDescriptor))
+            waitIdle = true;
 
         switch (binding.descriptorType)
         {
             case VK_DESCRIPTOR_TYPE_SAMPLER:
-                FillWriteDescriptorWithSampler(desc, descriptorSet, binding, container);
+                FillWriteDescriptorWithSampler(desc, descriptorSet, arrayElement, binding, container);
                 break;
 
             #if 0
             case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
-                FillWriteDescriptorWithCombinedImageSampler(device, desc, descriptorSet, binding, container);
+                FillWriteDescriptorWithCombinedImageSampler(device, desc, descriptorSet, arrayElement, binding, container);
                 break;
             #endif
 
             case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
             case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
-                FillWriteDescriptorWithImageView(device, desc, descriptorSet, binding, container);
+                FillWriteDescriptorWithImageView(device, desc, descriptorSet, arrayElement, binding, container);
                 break;
 
             case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
             case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
-                FillWriteDescriptorWithBufferRange(device, desc, descriptorSet, binding, container);
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+                FillWriteDescriptorWithBufferRange(device, desc, descriptorSet, arrayElement, binding, container);
                 break;
 
             default:
@@ -144,22 +199,46 @@ std::uint32_t VKResourceHeap::UpdateDescriptors(
                 break;
         }
 
+        /* Keep track of written descriptors for the descriptor update template */
+        if (updateTemplate_ != VK_NULL_HANDLE)
+        {
+            StoreTemplateEntry(firstDescriptor, container.writeDescriptors[container.numWriteDescriptors - 1]);
+            setRange[0] = std::min(setRange[0], descriptorSet);
+            setRange[1] = std::max(setRange[1], descriptorSet + 1);
+        }
+
         ++firstDescriptor;
     }
 
     if (container.numWriteDescriptors > 0)
     {
-        /* All command buffers must have finished execution before any affected descriptor set can be updated */
-        vkDeviceWaitIdle(device);
-
-        /* Update Vulkan descriptor sets */
-        vkUpdateDescriptorSets(
-            device,
-            container.numWriteDescriptors,      // Number of write descriptor
-            container.writeDescriptors.data(),  // Descriptors to be written
-            0,                                  // No copy descriptors
-            nullptr                             // No descriptors to be copied
-        );
+        /*
+        All command buffers must have finished execution before any affected descriptor set can be updated,
+        except for bindless descriptors, which are created with VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT
+        */
+        if (waitIdle)
+            vkDeviceWaitIdle(device);
+
+        if (updateTemplate_ != VK_NULL_HANDLE && numMissingTemplateEntries_ == 0)
+        {
+            /*
+            Update each affected descriptor set with a single call over its packed descriptor entries.
+            This is only possible once all descriptors have been written, since the template always updates the entire set.
+            */
+            for_subrange(i, setRange[0], setRange[1])
+                vkUpdateDescriptorSetWithTemplateKHR(device, descriptorSets_[i], updateTemplate_, &templateEntries_[i * numBindings]);
+        }
+        else
+        {
+            /* Update Vulkan descriptor sets */
+            vkUpdateDescriptorSets(
+                device,
+                container.numWriteDescriptors,      // Number of write descriptor
+                container.writeDescriptors.data(),  // Descriptors to be written
+                0,                                  // No copy descriptors
+                nullptr                             // No descriptors to be copied
+            );
+        }
     }
 
     /* Update pipeline barriers */
@@ -208,6 +287,10 @@ static VkPipelineStageFlags ToVkStageFlags(long stageFlags)
         bitmask |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
     if ((stageFlags & StageFlags::ComputeStage) != 0)
         bitmask |= VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    if ((stageFlags & StageFlags::TaskStage) != 0)
+        bitmask |= VK_PIPELINE_STAGE_TASK_SHADER_BIT_EXT;
+    if ((stageFlags & StageFlags::MeshStage) != 0)
+        bitmask |= VK_PIPELINE_STAGE_MESH_SHADER_BIT_EXT;
 
     return bitmask;
 }
@@ -250,6 +333,32 @@ void VKResourceHeap::CopyLayoutBinding(VKDescriptorBinding& dst, const VKLayoutB
     dst.bufferViewIndex = (IsDescriptorTypeBufferView(src.descriptorType) ? numBufferViewsPerSet_++ : VKResourceHeap::invalidViewIndex);
 }
 
+bool VKResourceHeap::IsBindlessDescriptor(std::uint32_t descriptor) const
+{
+    return (hasBindlessBinding_ && descriptor + 1 >= bindings_.size());
+}
+
+const VKResourceHeap::VKDescriptorBinding& VKResourceHeap::GetDescriptorBinding(
+    std::uint32_t   descriptor,
+    std::uint32_t&  outDescriptorSet,
+    std::uint32_t&  outArrayElement) const
+{
+    const auto numBindings = static_cast<std::uint32_t>(bindings_.size());
+    if (IsBindlessDescriptor(descriptor))
+    {
+        /* Bindless descriptors are the array elements of the last binding in the only descriptor set */
+        outDescriptorSet    = 0;
+        outArrayElement     = descriptor - (numBindings - 1);
+        return bindings_.back();
+    }
+    else
+    {
+        outDescriptorSet    = descriptor / numBindings;
+        outArrayElement     = 0;
+        return bindings_[descriptor % numBindings];
+    }
+}
+
 // Returns the zero-based index of a descriptor pool for the specified descriptor type
 static std::uint32_t GetDescriptorPoolIndex(VkDescriptorType type)
 {
@@ -265,11 +374,11 @@ void VKResourceHeap::CreateDescriptorPool(const VKPtr<VkDevice>& device, std::ui
     constexpr auto numDescriptorTypes = (static_cast<std::uint32_t>(VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT) + 1);
     std::uint32_t descritporPoolSizes[numDescriptorTypes] = {};
 
-    for (const auto& binding : bindings_)
+    for_range(i, bindings_.size())
     {
-        const auto descriptorType       = binding.descriptorType;
-        const auto descriptorPoolIndex  = GetDescriptorPoolIndex(binding.descriptorType);
-        descritporPoolSizes[descriptorPoolIndex] += numDescriptorSets;
+        const auto descriptorPoolIndex  = GetDescriptorPoolIndex(bindings_[i].descriptorType);
+        const bool isBindlessBinding    = (hasBindlessBinding_ && i + 1 == bindings_.size());
+        descritporPoolSizes[descriptorPoolIndex] += (isBindlessBinding ? numBindlessDescriptors_ : numDescriptorSets);
     }
 
     /* Initialize Vulkan descriptor pool sizes */
@@ -293,7 +402,7 @@ void VKResourceHeap::CreateDescriptorPool(const VKPtr<VkDevice>& device, std::ui
     {
         poolCreateInfo.sType            = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
         poolCreateInfo.pNext            = nullptr;
-        poolCreateInfo.flags            = 0;
+        poolCreateInfo.flags            = (hasBindlessBinding_ ? VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT : 0);
         poolCreateInfo.maxSets          = numDescriptorSets;
         poolCreateInfo.poolSizeCount    = static_cast<std::uint32_t>(poolSizeInfos.size());
         poolCreateInfo.pPoolSizes       = poolSizeInfos.data();
@@ -314,11 +423,20 @@ void VKResourceHeap::CreateDescriptorSets(
     /* Pre-allocate descriptor sets */
     descriptorSets_.resize(numDescriptorSets, VK_NULL_HANDLE);
 
+    /* Specify number of bindless descriptors, which is the variable size of the last binding */
+    VkDescriptorSetVariableDescriptorCountAllocateInfoEXT variableCountInfo;
+    {
+        variableCountInfo.sType                 = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO_EXT;
+        variableCountInfo.pNext                 = nullptr;
+        variableCountInfo.descriptorSetCount    = 1;
+        variableCountInfo.pDescriptorCounts     = &numBindlessDescriptors_;
+    }
+
     /* Allocate descriptor set */
     VkDescriptorSetAllocateInfo allocInfo;
     {
         allocInfo.sType                 = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        allocInfo.pNext                 = nullptr;
+        allocInfo.pNext                 = (hasBindlessBinding_ ? &variableCountInfo : nullptr);
         allocInfo.descriptorPool        = descriptorPool_;
         allocInfo.descriptorSetCount    = numDescriptorSets;
         allocInfo.pSetLayouts           = setLayouts.data();
@@ -330,6 +448,7 @@ void VKResourceHeap::CreateDescriptorSets(
 void VKResourceHeap::FillWriteDescriptorWithSampler(
     const ResourceViewDescriptor&   desc,
     std::uint32_t                   descriptorSet,
+    std::uint32_t                   arrayElement,
     const VKDescriptorBinding&      binding,
     VKWriteDescriptorContainer&     container)
 {
@@ -348,7 +467,7 @@ void VKResourceHeap::FillWriteDescriptorWithSampler(
     {
         writeDesc->dstSet           = descriptorSets_[descriptorSet];
         writeDesc->dstBinding       = binding.dstBinding;
-        writeDesc->dstArrayElement  = 0;
+        writeDesc->dstArrayElement  = arrayElement;
         writeDesc->descriptorCount  = 1;
         writeDesc->descriptorType   = binding.descriptorType;
         writeDesc->pImageInfo       = imageInfo;
@@ -361,13 +480,14 @@ void VKResourceHeap::FillWriteDescriptorWithImageView(
     const VKPtr<VkDevice>&          device,
     const ResourceViewDescriptor&   desc,
     std::uint32_t                   descriptorSet,
+    std::uint32_t                   arrayElement,
     const VKDescriptorBinding&      binding,
     VKWriteDescriptorContainer&     container)
 {
     auto textureVK = LLGL_CAST(VKTexture*, desc.resource);
 
     /* Initialize image information */
-    const std::size_t imageViewIndex = descriptorSet * numImageViewsPerSet_ + binding.imageViewIndex;
+    const std::size_t imageViewIndex = descriptorSet * numImageViewsPerSet_ + binding.imageViewIndex + arrayElement;
     auto imageInfo = container.NextImageInfo();
     {
         imageInfo->sampler       = VK_NULL_HANDLE;
@@ -380,7 +500,7 @@ void VKResourceHeap::FillWriteDescriptorWithImageView(
     {
         writeDesc->dstSet           = descriptorSets_[descriptorSet];
         writeDesc->dstBinding       = binding.dstBinding;
-        writeDesc->dstArrayElement  = 0;
+        writeDesc->dstArrayElement  = arrayElement;
         writeDesc->descriptorCount  = 1;
         writeDesc->descriptorType   = binding.descriptorType;
         writeDesc->pImageInfo       = imageInfo;
@@ -393,6 +513,7 @@ void VKResourceHeap::FillWriteDescriptorWithBufferRange(
     const VKPtr<VkDevice>&          /*device*/,
     const ResourceViewDescriptor&   desc,
     std::uint32_t                   descriptorSet,
+    std::uint32_t                   arrayElement,
     const VKDescriptorBinding&      binding,
     VKWriteDescriptorContainer&     container)
 {
@@ -419,7 +540,7 @@ void VKResourceHeap::FillWriteDescriptorWithBufferRange(
     {
         writeDesc->dstSet           = descriptorSets_[descriptorSet];
         writeDesc->dstBinding       = binding.dstBinding;
-        writeDesc->dstArrayElement  = 0;
+        writeDesc->dstArrayElement  = arrayElement;
         writeDesc->descriptorCount  = 1;
         writeDesc->descriptorType   = binding.descriptorType;
         writeDesc->pImageInfo       = nullptr;
@@ -428,21 +549,39 @@ void VKResourceHeap::FillWriteDescriptorWithBufferRange(
     }
 
     /* Emplace pipeline barrier for storage buffer */
-    if (ExchangeBufferBarrier(descriptorSet, bufferVK, binding))
+    if (ExchangeBufferBarrier(descriptorSet, arrayElement, bufferVK, binding))
     {
         container.barrierChangeRanges[0] = std::min(container.barrierChangeRanges[0], descriptorSet);
         container.barrierChangeRanges[1] = std::max(container.barrierChangeRanges[1], descriptorSet + 1);
     }
 }
 
-bool VKResourceHeap::ExchangeBufferBarrier(std::uint32_t descriptorSet, Buffer* resource, const VKDescriptorBinding& binding)
+void VKResourceHeap::StoreTemplateEntry(std::uint32_t descriptor, const VkWriteDescriptorSet& writeDesc)
+{
+    auto& entry = templateEntries_[descriptor];
+
+    if (writeDesc.pImageInfo != nullptr)
+        entry.imageInfo = *writeDesc.pImageInfo;
+    else if (writeDesc.pBufferInfo != nullptr)
+        entry.bufferInfo = *writeDesc.pBufferInfo;
+
+    if (!templateEntriesWritten_[descriptor])
+    {
+        templateEntriesWritten_[descriptor] = true;
+        --numMissingTemplateEntries_;
+    }
+}
+
+bool VKResourceHeap::ExchangeBufferBarrier(std::uint32_t descriptorSet, std::uint32_t arrayElement, Buffer* resource, const VKDescriptorBinding& binding)
 {
     if (descriptorSet < barriers_.size())
     {
+        /* Use buffer view index as unique slot, since the array elements of the bindless binding follow the last buffer view index */
+        const auto slot = binding.bufferViewIndex + arrayElement;
         if ((resource->GetBindFlags() & BindFlags::Storage) != 0)
-            return EmplaceBarrier(descriptorSet, binding.dstBinding, resource, binding.stageFlags);
+            return EmplaceBarrier(descriptorSet, slot, resource, binding.stageFlags);
         else
-            return RemoveBarrier(descriptorSet, binding.dstBinding);
+            return RemoveBarrier(descriptorSet, slot);
     }
     return false;
 }
@@ -14,6 +14,7 @@
 #include <LLGL/Container/SmallVector.h>
 #include "VKPipelineBarrier.h"
 #include "VKPipelineLayout.h"
+#include "VKDescriptorSetAllocator.h"
 #include "../Vulkan.h"
 #include "../VKPtr.h"
 #include <vector>
@@ -42,9 +43,11 @@ class VKResourceHeap final : public ResourceHeap
 
         VKResourceHeap(
             const VKPtr<VkDevice>&                      device,
+            VKDescriptorSetAllocator&                   descriptorSetAllocator,
             const ResourceHeapDescriptor&               desc,
             const ArrayView<ResourceViewDescriptor>&    initialResourceViews = {}
         );
+        ~VKResourceHeap();
 
         std::uint32_t UpdateDescriptors(
             const VKPtr<VkDevice>&                      device,
@@ -61,7 +64,7 @@ class VKResourceHeap final : public ResourceHeap
             return pipelineLayout_;
         }
 
-        // Returns the native Vulkan descritpor pool.
+        // Returns the native Vulkan descritpor pool. Only bindless resource heaps have their own pool; all others are allocated from the shared descriptor set allocator.
         inline VkDescriptorPool GetVkDescriptorPool() const
         {
             return descriptorPool_.Get();
@@ -82,6 +85,12 @@ class VKResourceHeap final : public ResourceHeap
             return bindPoint_;
         }
 
+        // Returns the number of dynamic offsets that must be passed to 'vkCmdBindDescriptorSets' for this resource heap.
+        inline std::uint32_t GetNumDynamicOffsets() const
+        {
+            return numDynamicOffsets_;
+        }
+
     private:
 
         static constexpr std::uint32_t invalidViewIndex = 0xFFFF;
@@ -100,6 +109,16 @@ class VKResourceHeap final : public ResourceHeap
         void CopyLayoutBindings(const ArrayView<VKLayoutBinding>& layoutBindings);
         void CopyLayoutBinding(VKDescriptorBinding& dst, const VKLayoutBinding& src);
 
+        // Returns true if the specified descriptor refers to an array element of the bindless binding.
+        bool IsBindlessDescriptor(std::uint32_t descriptor) const;
+
+        // Returns the binding of the specified descriptor as well as its descriptor set and array element.
+        const VKDescriptorBinding& GetDescriptorBinding(
+            std::uint32_t   descriptor,
+            std::uint32_t&  outDescriptorSet,
+            std::uint32_t&  outArrayElement
+        ) const;
+
         void CreateDescriptorPool(const VKPtr<VkDevice>& device, std::uint32_t numDescriptorSets);
 
         void CreateDescriptorSets(
@@ -111,6 +130,7 @@ class VKResourceHeap final : public ResourceHeap
         void FillWriteDescriptorWithSampler(
             const ResourceViewDescriptor&   desc,
             std::uint32_t                   descriptorSet,
+            std::uint32_t                   arrayElement,
             const VKDescriptorBinding&      binding,
             VKWriteDescriptorContainer&     container
         );
@@ -119,6 +139,7 @@ class VKResourceHeap final : public ResourceHeap
             const VKPtr<VkDevice>&          device,
             const ResourceViewDescriptor&   desc,
             std::uint32_t                   descriptorSet,
+            std::uint32_t                   arrayElement,
             const VKDescriptorBinding&      binding,
             VKWriteDescriptorContainer&     container
         );
@@ -127,11 +148,15 @@ class VKResourceHeap final : public ResourceHeap
             const VKPtr<VkDevice>&          device,
             const ResourceViewDescriptor&   desc,
             std::uint32_t                   descriptorSet,
+            std::uint32_t                   arrayElement,
             const VKDescriptorBinding&      binding,
             VKWriteDescriptorContainer&     container
         );
 
-        bool ExchangeBufferBarrier(std::uint32_t descriptorSet, Buffer* resource, const VKDescriptorBinding& binding);
+        // Stores the descriptor of the specified write descriptor in the packed array for the descriptor update template.
+        void StoreTemplateEntry(std::uint32_t descriptor, const VkWriteDescriptorSet& writeDesc);
+
+        bool ExchangeBufferBarrier(std::uint32_t descriptorSet, std::uint32_t arrayElement, Buffer* resource, const VKDescriptorBinding& binding);
         bool EmplaceBarrier(std::uint32_t descriptorSet, std::uint32_t slot, Resource* resource, VkPipelineStageFlags stageFlags);
         bool RemoveBarrier(std::uint32_t descriptorSet, std::uint32_t slot);
 
@@ -147,6 +172,14 @@ class VKResourceHeap final : public ResourceHeap
 
         VkPipelineLayout                    pipelineLayout_         = VK_NULL_HANDLE;
 
+        /* ----- Descriptor set allocation ----- */
+
+        VKDescriptorSetAllocator&               descriptorSetAllocator_;
+        VKDescriptorSetAllocator::ClassHandle   descriptorSetClass_     = nullptr;  // Class of descriptor sets in the shared allocator; null for transient and bindless heaps
+        bool                                    transient_              = false;    // Descriptor sets are taken from the transient pools (see ResourceHeapDescriptor::transient)
+
+        /* ----- Descriptor sets and bindings ----- */
+
         VKPtr<VkDescriptorPool>             descriptorPool_;
         std::vector<VkDescriptorSet>        descriptorSets_;
         SmallVector<VKDescriptorBinding>    bindings_;
@@ -158,6 +191,19 @@ class VKResourceHeap final : public ResourceHeap
 
         std::vector<VKPipelineBarrierPtr>   barriers_;
         VkPipelineBindPoint                 bindPoint_              = VK_PIPELINE_BIND_POINT_MAX_ENUM;
+        std::uint32_t                       numDynamicOffsets_      = 0;
+
+        /* ----- Bindless descriptors ----- */
+
+        bool                                hasBindlessBinding_     = false;
+        std::uint32_t                       numBindlessDescriptors_ = 0;
+
+        /* ----- Descriptor update template ----- */
+
+        VkDescriptorUpdateTemplateKHR           updateTemplate_             = VK_NULL_HANDLE;
+        std::vector<VKDescriptorTemplateEntry>  templateEntries_;
+        std::vector<bool>                       templateEntriesWritten_;
+        std::size_t                             numMissingTemplateEntries_  = 0;
 
 };
 
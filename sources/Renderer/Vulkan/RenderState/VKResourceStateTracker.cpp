@@ -0,0 +1,275 @@
+/*
+ * VKResourceStateTracker.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKResourceStateTracker.h"
+#include "../Texture/VKTexture.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+// Default layout of all textures outside of a command buffer (see VKRenderTarget and VKStagingBufferPool)
+static const VkImageLayout g_defaultImageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+static bool HasWriteAccess(VkAccessFlags accessMask)
+{
+    const VkAccessFlags writeAccessMask =
+    (
+        VK_ACCESS_SHADER_WRITE_BIT                  |
+        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT        |
+        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT|
+        VK_ACCESS_TRANSFER_WRITE_BIT                |
+        VK_ACCESS_HOST_WRITE_BIT                    |
+        VK_ACCESS_MEMORY_WRITE_BIT
+    );
+    return ((accessMask & writeAccessMask) != 0);
+}
+
+void VKResourceStateTracker::Reset()
+{
+    images_.clear();
+    numPendingImages_   = 0;
+    bufferBarriers_.clear();
+    bufferSrcStageMask_ = 0;
+    bufferDstStageMask_ = 0;
+}
+
+void VKResourceStateTracker::TransitionTexture(
+    VKTexture&              texture,
+    VkImageLayout           newLayout,
+    VkAccessFlags           dstAccessMask,
+    VkPipelineStageFlags    dstStageMask)
+{
+    auto& state = FindOrInsertImageState(texture);
+
+    if (state.pending)
+    {
+        /* Merge with pending transition, since no command has accessed the intermediate layout yet */
+        state.pendingLayout     = newLayout;
+        state.pendingAccessMask |= dstAccessMask;
+        state.pendingStageMask  |= dstStageMask;
+    }
+    else if (state.layout == newLayout && !HasWriteAccess(state.accessMask) && !HasWriteAccess(dstAccessMask))
+    {
+        /* Drop redundant transition between read-only accesses */
+        state.accessMask        |= dstAccessMask;
+        state.stageMask         |= dstStageMask;
+    }
+    else
+    {
+        state.pendingLayout     = newLayout;
+        state.pendingAccessMask = dstAccessMask;
+        state.pendingStageMask  = dstStageMask;
+        state.pending           = true;
+        ++numPendingImages_;
+    }
+}
+
+void VKResourceStateTracker::InsertBufferBarrier(
+    VkBuffer                buffer,
+    VkDeviceSize            offset,
+    VkDeviceSize            size,
+    VkAccessFlags           srcAccessMask,
+    VkAccessFlags           dstAccessMask,
+    VkPipelineStageFlags    srcStageMask,
+    VkPipelineStageFlags    dstStageMask)
+{
+    bufferSrcStageMask_ |= srcStageMask;
+    bufferDstStageMask_ |= dstStageMask;
+
+    for (auto& barrier : bufferBarriers_)
+    {
+        if (barrier.buffer == buffer)
+        {
+            /* Merge access masks and extend range of pending barrier */
+            barrier.srcAccessMask |= srcAccessMask;
+            barrier.dstAccessMask |= dstAccessMask;
+
+            const auto begin = std::min(barrier.offset, offset);
+            if (barrier.size == VK_WHOLE_SIZE || size == VK_WHOLE_SIZE)
+                barrier.size = VK_WHOLE_SIZE;
+            else
+                barrier.size = std::max(barrier.offset + barrier.size, offset + size) - begin;
+            barrier.offset = begin;
+
+            return;
+        }
+    }
+
+    VkBufferMemoryBarrier barrier;
+    {
+        barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.pNext               = nullptr;
+        barrier.srcAccessMask       = srcAccessMask;
+        barrier.dstAccessMask       = dstAccessMask;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.buffer              = buffer;
+        barrier.offset              = offset;
+        barrier.size                = size;
+    }
+    bufferBarriers_.push_back(barrier);
+}
+
+void VKResourceStateTracker::FlushBarriers(VkCommandBuffer commandBuffer)
+{
+    VkPipelineStageFlags srcStageMask = bufferSrcStageMask_;
+    VkPipelineStageFlags dstStageMask = bufferDstStageMask_;
+
+    /* Generate image barriers for all pending transitions */
+    imageBarriers_.clear();
+
+    if (numPendingImages_ > 0)
+    {
+        for (auto& state : images_)
+        {
+            if (!state.pending)
+                continue;
+
+            if (state.layout != state.pendingLayout || HasWriteAccess(state.accessMask) || HasWriteAccess(state.pendingAccessMask))
+            {
+                VkImageMemoryBarrier barrier;
+                {
+                    barrier.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                    barrier.pNext               = nullptr;
+                    barrier.srcAccessMask       = state.accessMask;
+                    barrier.dstAccessMask       = state.pendingAccessMask;
+                    barrier.oldLayout           = state.layout;
+                    barrier.newLayout           = state.pendingLayout;
+                    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                    barrier.image               = state.image;
+                    barrier.subresourceRange    = state.subresourceRange;
+                }
+                imageBarriers_.push_back(barrier);
+
+                srcStageMask            |= state.stageMask;
+                dstStageMask            |= state.pendingStageMask;
+
+                state.layout            = state.pendingLayout;
+                state.accessMask        = state.pendingAccessMask;
+                state.stageMask         = state.pendingStageMask;
+            }
+            else
+            {
+                /* Transitions have cancelled each other out */
+                state.accessMask        |= state.pendingAccessMask;
+                state.stageMask         |= state.pendingStageMask;
+            }
+
+            state.pending = false;
+        }
+        numPendingImages_ = 0;
+    }
+
+    /* Submit all barriers at once */
+    if (!imageBarriers_.empty() || !bufferBarriers_.empty())
+    {
+        vkCmdPipelineBarrier(
+            commandBuffer,
+            (srcStageMask != 0 ? srcStageMask : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT),
+            (dstStageMask != 0 ? dstStageMask : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT),
+            0, // VkDependencyFlags
+            0,
+            nullptr,
+            static_cast<std::uint32_t>(bufferBarriers_.size()),
+            bufferBarriers_.data(),
+            static_cast<std::uint32_t>(imageBarriers_.size()),
+            imageBarriers_.data()
+        );
+    }
+
+    bufferBarriers_.clear();
+    bufferSrcStageMask_ = 0;
+    bufferDstStageMask_ = 0;
+}
+
+void VKResourceStateTracker::RestoreDefaultLayouts(VkCommandBuffer commandBuffer)
+{
+    /* Transition all textures that are not in their default layout */
+    for (auto& state : images_)
+    {
+        const auto layout = (state.pending ? state.pendingLayout : state.layout);
+        if (layout != g_defaultImageLayout)
+        {
+            if (!state.pending)
+            {
+                state.pendingAccessMask = 0;
+                state.pendingStageMask  = 0;
+                state.pending           = true;
+                ++numPendingImages_;
+            }
+            state.pendingLayout     = g_defaultImageLayout;
+            state.pendingAccessMask |= VK_ACCESS_SHADER_READ_BIT;
+            state.pendingStageMask  |= (VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+        }
+    }
+
+    FlushBarriers(commandBuffer);
+
+    /* Subsequent commands may access all textures in their default layout without being tracked */
+    images_.clear();
+}
+
+bool VKResourceStateTracker::HasPendingBufferBarrier(VkBuffer buffer) const
+{
+    for (const auto& barrier : bufferBarriers_)
+    {
+        if (barrier.buffer == buffer)
+            return true;
+    }
+    return false;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+VKResourceStateTracker::ImageState& VKResourceStateTracker::FindOrInsertImageState(VKTexture& texture)
+{
+    const auto image = texture.GetVkImage();
+
+    for (auto& state : images_)
+    {
+        if (state.image == image)
+            return state;
+    }
+
+    /*
+    Insert new state for an untracked texture in its default layout.
+    Its previous access is unknown (e.g. render pass or storage write), so the first barrier must synchronize with all commands.
+    */
+    ImageState state;
+    {
+        state.image                             = image;
+        state.subresourceRange.aspectMask       = texture.GetAspectFlags();
+        state.subresourceRange.baseMipLevel     = 0;
+        state.subresourceRange.levelCount       = texture.GetNumMipLevels();
+        state.subresourceRange.baseArrayLayer   = 0;
+        state.subresourceRange.layerCount       = texture.GetNumArrayLayers();
+        state.layout                            = g_defaultImageLayout;
+        state.accessMask                        = VK_ACCESS_MEMORY_WRITE_BIT;
+        state.stageMask                         = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        state.pendingLayout                     = g_defaultImageLayout;
+        state.pendingAccessMask                 = 0;
+        state.pendingStageMask                  = 0;
+        state.pending                           = false;
+    }
+    images_.push_back(state);
+
+    return images_.back();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
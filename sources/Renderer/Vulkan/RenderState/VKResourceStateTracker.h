@@ -0,0 +1,111 @@
+/*
+ * VKResourceStateTracker.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_RESOURCE_STATE_TRACKER_H
+#define LLGL_VK_RESOURCE_STATE_TRACKER_H
+
+
+#include <LLGL/Container/SmallVector.h>
+#include <vulkan/vulkan.h>
+
+
+namespace LLGL
+{
+
+
+class VKTexture;
+
+/*
+Tracks the image layouts and access masks of resources within a single command buffer.
+Transitions are only recorded as pending and merged into a single vkCmdPipelineBarrier when they are flushed,
+which must happen right before the next command that accesses the respective resources.
+Redundant transitions, e.g. between two read-only accesses in the same layout, are dropped.
+Outside of the tracked range, all textures are expected to be in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL layout.
+*/
+class VKResourceStateTracker
+{
+
+    public:
+
+        // Removes all tracked resources and pending barriers; must be called when a new command buffer is recorded.
+        void Reset();
+
+        // Records a transition of the entire texture into the specified layout.
+        void TransitionTexture(
+            VKTexture&              texture,
+            VkImageLayout           newLayout,
+            VkAccessFlags           dstAccessMask,
+            VkPipelineStageFlags    dstStageMask
+        );
+
+        // Records a buffer memory barrier. Barriers for the same buffer are merged.
+        void InsertBufferBarrier(
+            VkBuffer                buffer,
+            VkDeviceSize            offset,
+            VkDeviceSize            size,
+            VkAccessFlags           srcAccessMask,
+            VkAccessFlags           dstAccessMask,
+            VkPipelineStageFlags    srcStageMask,
+            VkPipelineStageFlags    dstStageMask
+        );
+
+        // Submits all pending barriers with a single vkCmdPipelineBarrier command.
+        void FlushBarriers(VkCommandBuffer commandBuffer);
+
+        // Transitions all tracked textures back into their default layout, submits all pending barriers, and stops tracking these textures.
+        void RestoreDefaultLayouts(VkCommandBuffer commandBuffer);
+
+        // Returns true if the specified buffer has a pending barrier.
+        bool HasPendingBufferBarrier(VkBuffer buffer) const;
+
+        // Returns true if there are any pending barriers or textures which are not in their default layout.
+        inline bool IsDirty() const
+        {
+            return (numPendingImages_ > 0 || !bufferBarriers_.empty() || !images_.empty());
+        }
+
+    private:
+
+        struct ImageState
+        {
+            VkImage                 image;
+            VkImageSubresourceRange subresourceRange;
+            VkImageLayout           layout;
+            VkAccessFlags           accessMask;
+            VkPipelineStageFlags    stageMask;
+            VkImageLayout           pendingLayout;
+            VkAccessFlags           pendingAccessMask;
+            VkPipelineStageFlags    pendingStageMask;
+            bool                    pending;
+        };
+
+    private:
+
+        ImageState& FindOrInsertImageState(VKTexture& texture);
+
+    private:
+
+        SmallVector<ImageState, 8>              images_;
+        std::size_t                             numPendingImages_   = 0;
+
+        SmallVector<VkBufferMemoryBarrier, 4>   bufferBarriers_;
+        VkPipelineStageFlags                    bufferSrcStageMask_ = 0;
+        VkPipelineStageFlags                    bufferDstStageMask_ = 0;
+
+        SmallVector<VkImageMemoryBarrier, 8>    imageBarriers_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,20 @@
+/*
+ * VKBuiltin.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKBuiltin.h"
+
+
+const std::uint32_t g_spirvGenerateMips2D[] =
+{
+    #include "GenerateMips2D.comp.spv.h"
+};
+
+const std::size_t g_spirvGenerateMips2DLen = sizeof(g_spirvGenerateMips2D);
+
+
+
+// ================================================================================
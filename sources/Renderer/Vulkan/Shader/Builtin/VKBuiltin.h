@@ -0,0 +1,24 @@
+/*
+ * VKBuiltin.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_BUILTIN_H
+#define LLGL_VK_BUILTIN_H
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+extern const std::uint32_t  g_spirvGenerateMips2D[];
+extern const std::size_t    g_spirvGenerateMips2DLen;
+
+
+#endif
+
+
+
+// ================================================================================
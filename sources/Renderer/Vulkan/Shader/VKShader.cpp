@@ -9,11 +9,18 @@
 #include "../VKCore.h"
 #include "../VKTypes.h"
 #include "../../../Core/Helper.h"
+#include "../../../Core/StringInterner.h"
 #include <LLGL/Misc/TypeNames.h>
+#include <LLGL/ShaderReflection.h>
+#include <LLGL/Constants.h>
+#include <cstring>
+#include <map>
+#include <mutex>
 
 #ifdef LLGL_ENABLE_SPIRV_REFLECT
 #   include "../../SPIRV/SPIRVReflect.h"
 #   include "../../SPIRV/SPIRVReflectExecutionMode.h"
+#   include <algorithm>
 #endif
 
 
@@ -22,9 +29,8 @@ namespace LLGL
 
 
 VKShader::VKShader(const VKPtr<VkDevice>& device, const ShaderDescriptor& desc) :
-    Shader        { desc.type                     },
-    device_       { device                        },
-    shaderModule_ { device, vkDestroyShaderModule }
+    Shader  { desc.type },
+    device_ { device    }
 {
     BuildShader(desc);
     BuildInputLayout(desc.vertex.inputAttribs.size(), desc.vertex.inputAttribs.data());
@@ -36,14 +42,29 @@ const Report* VKShader::GetReport() const
     return (report_ ? &report_ : nullptr);
 }
 
+UniformLocation VKShader::FindUniformLocation(const char* name) const
+{
+    /* Search push constants in the shader reflection, which is cached for each shader module */
+    ShaderReflection reflection;
+    if (Reflect(reflection))
+    {
+        for (const auto& uniform : reflection.uniforms)
+        {
+            if (std::strcmp(uniform.name.c_str(), name) == 0)
+                return uniform.location;
+        }
+    }
+    return Constants::invalidLocation;
+}
+
 void VKShader::FillShaderStageCreateInfo(VkPipelineShaderStageCreateInfo& createInfo) const
 {
     createInfo.sType                = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
     createInfo.pNext                = nullptr;
     createInfo.flags                = 0;
     createInfo.stage                = VKTypes::Map(GetType());
-    createInfo.module               = shaderModule_;
-    createInfo.pName                = entryPoint_.c_str();
+    createInfo.module               = GetShaderModule();
+    createInfo.pName                = entryPoint_;
     createInfo.pSpecializationInfo  = nullptr;
 }
 
@@ -76,6 +97,49 @@ void VKShader::FillVertexInputStateCreateInfo(VkPipelineVertexInputStateCreateIn
     }
 }
 
+// Returns the 64-bit FNV-1a hash of the specified byte code.
+static std::uint64_t HashByteCode(const char* data, std::size_t size)
+{
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<std::uint8_t>(data[i]);
+        hash *= 0x00000100000001B3ull;
+    }
+    return hash;
+}
+
+// Key for the shader module cache; identical byte code on the same device can share a single VkShaderModule.
+struct VKShaderModuleKey
+{
+    VkDevice        device;
+    std::uint64_t   hash;
+    std::size_t     size;
+
+    inline bool operator < (const VKShaderModuleKey& rhs) const
+    {
+        if (device != rhs.device)
+            return (device < rhs.device);
+        if (hash != rhs.hash)
+            return (hash < rhs.hash);
+        return (size < rhs.size);
+    }
+};
+
+// Cache of native shader modules that is shared between all shaders with identical byte code.
+// Entries are weak references, so each module is destroyed together with the last shader that uses it.
+struct VKShaderModuleCache
+{
+    std::mutex                                                                  mutex;
+    std::map<VKShaderModuleKey, std::weak_ptr<const VKPtr<VkShaderModule>>>     entries;
+};
+
+static VKShaderModuleCache& GetShaderModuleCache()
+{
+    static VKShaderModuleCache cache;
+    return cache;
+}
+
 static const char* GetOptString(const char* s)
 {
     return (s != nullptr ? s : "");
@@ -91,6 +155,8 @@ static long ShaderTypeToStageFlags(const ShaderType type)
         case ShaderType::Geometry:          return StageFlags::GeometryStage;
         case ShaderType::Fragment:          return StageFlags::FragmentStage;
         case ShaderType::Compute:           return StageFlags::ComputeStage;
+        case ShaderType::Task:              return StageFlags::TaskStage;
+        case ShaderType::Mesh:              return StageFlags::MeshStage;
         default:                            return 0;
     }
 }
@@ -194,6 +260,73 @@ static Format SpvTypeToFormat(const SPIRVReflect::SpvType* type, std::uint32_t*
     return Format::Undefined;
 }
 
+// Returns the uniform type for a scalar or vector type with the specified number of components
+static UniformType SpvScalarTypeToUniformType(const SPIRVReflect::SpvType* type, std::uint32_t components)
+{
+    if (type == nullptr || components < 1 || components > 4)
+        return UniformType::Undefined;
+
+    UniformType firstType = UniformType::Undefined;
+
+    switch (type->opcode)
+    {
+        case spv::Op::OpTypeFloat:
+            firstType = (type->size == 8 ? UniformType::Double1 : UniformType::Float1);
+            break;
+        case spv::Op::OpTypeInt:
+            firstType = (type->sign ? UniformType::Int1 : UniformType::UInt1);
+            break;
+        case spv::Op::OpTypeBool:
+            firstType = UniformType::Bool1;
+            break;
+        default:
+            return UniformType::Undefined;
+    }
+
+    return static_cast<UniformType>(static_cast<int>(firstType) + static_cast<int>(components) - 1);
+}
+
+static UniformType SpvTypeToUniformType(const SPIRVReflect::SpvType* type)
+{
+    if (type != nullptr)
+    {
+        switch (type->opcode)
+        {
+            case spv::Op::OpTypeFloat:
+            case spv::Op::OpTypeInt:
+            case spv::Op::OpTypeBool:
+                return SpvScalarTypeToUniformType(type, 1);
+
+            case spv::Op::OpTypeVector:
+                return SpvScalarTypeToUniformType(type->baseType, type->elements);
+
+            case spv::Op::OpTypeMatrix:
+            {
+                /* Matrices are declared by their column vectors, e.g. mat2x3 has 2 columns with 3 rows each */
+                const auto columnType = type->baseType;
+                if (columnType != nullptr && columnType->baseType != nullptr && columnType->baseType->opcode == spv::Op::OpTypeFloat)
+                {
+                    const auto columns  = type->elements;
+                    const auto rows     = columnType->elements;
+                    if (columns >= 2 && columns <= 4 && rows >= 2 && rows <= 4)
+                    {
+                        const auto firstType = (columnType->baseType->size == 8 ? UniformType::Double2x2 : UniformType::Float2x2);
+                        return static_cast<UniformType>(static_cast<int>(firstType) + static_cast<int>((columns - 2) * 3 + (rows - 2)));
+                    }
+                }
+            }
+            break;
+
+            case spv::Op::OpTypeArray:
+                return SpvTypeToUniformType(type->baseType);
+
+            default:
+                break;
+        }
+    }
+    return UniformType::Undefined;
+}
+
 static SystemValue SpvBuiltinToSystemValue(spv::BuiltIn type)
 {
     switch (type)
@@ -262,14 +395,21 @@ static const SPIRVReflect::SpvType* ReflectSpvBinding(BindingDescriptor& binding
     return nullptr;
 }
 
-static ShaderResource* FindOrAppendShaderResource(ShaderReflection& reflection, const SPIRVReflect::SpvUniform& var)
+static ShaderResource* FindShaderResource(ShaderReflection& reflection, std::uint32_t slot)
 {
-    /* Check if there already is a resource at the specified binding slot */
     for (auto& resource : reflection.resources)
     {
-        if (resource.binding.slot == var.binding)
+        if (resource.binding.slot == slot)
             return &resource;
     }
+    return nullptr;
+}
+
+static ShaderResource* FindOrAppendShaderResource(ShaderReflection& reflection, const SPIRVReflect::SpvUniform& var)
+{
+    /* Check if there already is a resource at the specified binding slot */
+    if (auto resource = FindShaderResource(reflection, var.binding))
+        return resource;
 
     /* Append new resource entry */
     ShaderResource resource;
@@ -298,16 +438,115 @@ static ShaderResource* FindOrAppendShaderResource(ShaderReflection& reflection,
     return &(reflection.resources.back());
 }
 
+static void MergeShaderReflection(ShaderReflection& dst, const ShaderReflection& src)
+{
+    /* Append input/output attributes */
+    dst.vertex.inputAttribs.insert(dst.vertex.inputAttribs.end(), src.vertex.inputAttribs.begin(), src.vertex.inputAttribs.end());
+    dst.vertex.outputAttribs.insert(dst.vertex.outputAttribs.end(), src.vertex.outputAttribs.begin(), src.vertex.outputAttribs.end());
+    dst.fragment.outputAttribs.insert(dst.fragment.outputAttribs.end(), src.fragment.outputAttribs.begin(), src.fragment.outputAttribs.end());
+
+    /* Merge resources with the same binding slot */
+    for (const auto& resource : src.resources)
+    {
+        if (auto dstResource = FindShaderResource(dst, resource.binding.slot))
+            dstResource->binding.stageFlags |= resource.binding.stageFlags;
+        else
+            dst.resources.push_back(resource);
+    }
+
+    /* Merge uniforms with the same location, since all shader stages share the same push constant block */
+    for (const auto& uniform : src.uniforms)
+    {
+        auto it = std::find_if(
+            dst.uniforms.begin(), dst.uniforms.end(),
+            [&uniform](const ShaderUniform& entry)
+            {
+                return (entry.location == uniform.location);
+            }
+        );
+        if (it == dst.uniforms.end())
+            dst.uniforms.push_back(uniform);
+    }
+}
+
+// Key for the SPIR-V reflection cache; the reflection depends on the module byte code and the shader type.
+struct VKShaderReflectionKey
+{
+    std::uint64_t   hash;
+    std::size_t     size;
+    ShaderType      type;
+
+    inline bool operator < (const VKShaderReflectionKey& rhs) const
+    {
+        if (hash != rhs.hash)
+            return (hash < rhs.hash);
+        if (size != rhs.size)
+            return (size < rhs.size);
+        return (type < rhs.type);
+    }
+};
+
+// Cache of SPIR-V reflection results that is shared between all shaders with identical modules.
+// Entries are weak references, so each result is released together with the last shader that uses it.
+struct VKShaderReflectionCache
+{
+    std::mutex                                                              mutex;
+    std::map<VKShaderReflectionKey, std::weak_ptr<const ShaderReflection>>  entries;
+};
+
+static VKShaderReflectionCache& GetShaderReflectionCache()
+{
+    static VKShaderReflectionCache cache;
+    return cache;
+}
+
 bool VKShader::Reflect(ShaderReflection& reflection) const
+{
+    if (!reflection_)
+    {
+        const VKShaderReflectionKey key{ moduleHash_, shaderModuleData_.size(), GetType() };
+
+        auto& cache = GetShaderReflectionCache();
+        std::lock_guard<std::mutex> guard{ cache.mutex };
+
+        /* Find reflection of an identical shader module */
+        auto it = cache.entries.find(key);
+        if (it != cache.entries.end())
+            reflection_ = it->second.lock();
+
+        if (!reflection_)
+        {
+            /* Parse shader module and store result in cache; remove expired entries beforehand */
+            auto newReflection = std::make_shared<ShaderReflection>();
+            ReflectShaderModule(*newReflection);
+
+            for (auto entry = cache.entries.begin(); entry != cache.entries.end();)
+            {
+                if (entry->second.expired())
+                    entry = cache.entries.erase(entry);
+                else
+                    ++entry;
+            }
+
+            cache.entries[key] = newReflection;
+            reflection_ = std::move(newReflection);
+        }
+    }
+
+    MergeShaderReflection(reflection, *reflection_);
+
+    return true;
+}
+
+void VKShader::ReflectShaderModule(ShaderReflection& reflection) const
 {
     /* Parse shader module */
     SPIRVReflect spvReflect;
     spvReflect.Parse(shaderModuleData_.data(), shaderModuleData_.size());
 
     /* Gather input/output attributes */
-    for (const auto& it : spvReflect.GetVaryings())
+    for (const auto& var : spvReflect.GetVaryings())
     {
-        const auto& var = it.second;
         if (GetType() == ShaderType::Vertex)
         {
             std::uint32_t numVectors = 1;
@@ -346,14 +585,24 @@ bool VKShader::Reflect(ShaderReflection& reflection) const
     }
 
     /* Gather resources */
-    for (const auto& it : spvReflect.GetUniforms())
+    for (const auto& var : spvReflect.GetUniforms())
     {
-        const auto& var = it.second;
         if (auto resource = FindOrAppendShaderResource(reflection, var))
             resource->binding.stageFlags |= ShaderTypeToStageFlags(GetType());
     }
 
-    return true;
+    /* Gather push constants as uniforms; their location is the index of their first 32-bit value (see BindingFlags::InlineUniforms) */
+    for (const auto& pushConstant : spvReflect.GetPushConstants())
+    {
+        ShaderUniform uniform;
+        {
+            uniform.name        = GetOptString(pushConstant.name);
+            uniform.type        = SpvTypeToUniformType(pushConstant.type);
+            uniform.location    = static_cast<UniformLocation>(pushConstant.offset / 4);
+            uniform.size        = (pushConstant.type != nullptr && pushConstant.type->opcode == spv::Op::OpTypeArray ? pushConstant.type->elements : 1);
+        }
+        reflection.uniforms.push_back(uniform);
+    }
 }
 
 bool VKShader::ReflectLocalSize(Extent3D& localSize) const
@@ -516,25 +765,54 @@ bool VKShader::LoadBinary(const ShaderDescriptor& shaderDesc)
         return false;
     }
     else
-        shaderModuleData_ = std::vector<char>(binaryBuffer, binaryBuffer + binaryLength);
+    {
+        shaderModuleData_   = std::vector<char>(binaryBuffer, binaryBuffer + binaryLength);
+        moduleHash_         = HashByteCode(binaryBuffer, binaryLength);
+    }
 
     /* Store shader entry point (by default "main" for GLSL) */
     if (shaderDesc.entryPoint == nullptr || *shaderDesc.entryPoint == '\0')
         entryPoint_ = "main";
     else
-        entryPoint_ = shaderDesc.entryPoint;
+        entryPoint_ = InternString(shaderDesc.entryPoint).data();
+
+    /* Share shader module with all shaders that have identical byte code */
+    const VKShaderModuleKey key{ device_.Get(), moduleHash_, binaryLength };
+
+    auto& cache = GetShaderModuleCache();
+    std::lock_guard<std::mutex> guard{ cache.mutex };
+
+    auto it = cache.entries.find(key);
+    if (it != cache.entries.end())
+        shaderModule_ = it->second.lock();
 
-    /* Create shader module */
-    VkShaderModuleCreateInfo createInfo;
+    if (!shaderModule_)
     {
-        createInfo.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-        createInfo.pNext    = nullptr;
-        createInfo.flags    = 0;
-        createInfo.codeSize = binaryLength;
-        createInfo.pCode    = reinterpret_cast<const std::uint32_t*>(binaryBuffer);
+        /* Create shader module and store it in cache; remove expired entries beforehand */
+        auto newShaderModule = std::make_shared<VKPtr<VkShaderModule>>(device_, vkDestroyShaderModule);
+
+        VkShaderModuleCreateInfo createInfo;
+        {
+            createInfo.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+            createInfo.pNext    = nullptr;
+            createInfo.flags    = 0;
+            createInfo.codeSize = binaryLength;
+            createInfo.pCode    = reinterpret_cast<const std::uint32_t*>(binaryBuffer);
+        }
+        auto result = vkCreateShaderModule(device_, &createInfo, nullptr, newShaderModule->ReleaseAndGetAddressOf());
+        VKThrowIfFailed(result, "failed to create Vulkan shader module");
+
+        for (auto entry = cache.entries.begin(); entry != cache.entries.end();)
+        {
+            if (entry->second.expired())
+                entry = cache.entries.erase(entry);
+            else
+                ++entry;
+        }
+
+        cache.entries[key] = newShaderModule;
+        shaderModule_ = std::move(newShaderModule);
     }
-    auto result = vkCreateShaderModule(device_, &createInfo, nullptr, shaderModule_.ReleaseAndGetAddressOf());
-    VKThrowIfFailed(result, "failed to create Vulkan shader module");
 
     loadBinaryResult_ = LoadBinaryResult::Successful;
 
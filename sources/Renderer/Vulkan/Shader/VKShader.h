@@ -11,6 +11,7 @@
 
 #include <LLGL/Shader.h>
 #include <vector>
+#include <memory>
 #include "../Vulkan.h"
 #include "../VKPtr.h"
 #include "../../../Core/BasicReport.h"
@@ -30,6 +31,7 @@ class VKShader final : public Shader
 
         const Report* GetReport() const override;
         bool Reflect(ShaderReflection& reflection) const override;
+        UniformLocation FindUniformLocation(const char* name) const override;
 
     public:
 
@@ -40,10 +42,22 @@ class VKShader final : public Shader
         void FillShaderStageCreateInfo(VkPipelineShaderStageCreateInfo& createInfo) const;
         void FillVertexInputStateCreateInfo(VkPipelineVertexInputStateCreateInfo& createInfo) const;
 
-        // Returns the Vulkan shader module.
-        inline const VKPtr<VkShaderModule>& GetShaderModule() const
+        // Returns the Vulkan shader module. Shaders with identical byte code share the same module.
+        inline VkShaderModule GetShaderModule() const
         {
-            return shaderModule_;
+            return (shaderModule_ ? shaderModule_->Get() : VK_NULL_HANDLE);
+        }
+
+        // Returns the hash of the shader module byte code.
+        inline std::uint64_t GetModuleHash() const
+        {
+            return moduleHash_;
+        }
+
+        // Returns the entry point of this shader as interned string.
+        inline const char* GetEntryPoint() const
+        {
+            return entryPoint_;
         }
 
     private:
@@ -66,6 +80,9 @@ class VKShader final : public Shader
         bool CompileSource(const ShaderDescriptor& shaderDesc);
         bool LoadBinary(const ShaderDescriptor& shaderDesc);
 
+        // Parses the shader module and writes its reflection into the specified output.
+        void ReflectShaderModule(ShaderReflection& reflection) const;
+
     private:
 
         struct VertexInputLayout
@@ -76,14 +93,18 @@ class VKShader final : public Shader
 
     private:
 
-        VkDevice                device_             = VK_NULL_HANDLE;
-        VKPtr<VkShaderModule>   shaderModule_;
-        std::vector<char>       shaderModuleData_;
-        LoadBinaryResult        loadBinaryResult_   = LoadBinaryResult::Undefined;
-        VertexInputLayout       inputLayout_;
+        const VKPtr<VkDevice>&                          device_;
+        std::shared_ptr<const VKPtr<VkShaderModule>>    shaderModule_;      // Shared with all shaders that have identical byte code
+        std::vector<char>                               shaderModuleData_;
+        std::uint64_t                                   moduleHash_         = 0;
+        LoadBinaryResult                                loadBinaryResult_   = LoadBinaryResult::Undefined;
+        VertexInputLayout                               inputLayout_;
+
+        const char*                                     entryPoint_         = "main"; // Interned string
+        BasicReport                                     report_;
 
-        std::string             entryPoint_;
-        BasicReport             report_;
+        // Reflection of this shader module, shared with all shaders that have an identical module.
+        mutable std::shared_ptr<const ShaderReflection> reflection_;
 
 };
 
@@ -21,15 +21,21 @@ void VKColorBuffer::Create(
     VKDeviceMemoryManager&  deviceMemoryMngr,
     const Extent2D&         extent,
     VkFormat                format,
-    VkSampleCountFlagBits   sampleCountBits)
+    VkSampleCountFlagBits   sampleCountBits,
+    bool                    transient)
 {
+    /* Transient attachments are never loaded or stored, so they can reside in on-chip memory only */
+    VkImageUsageFlags usageFlags = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    if (transient)
+        usageFlags |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+
     VKRenderBuffer::Create(
         deviceMemoryMngr,
         extent,
         format,
         VK_IMAGE_ASPECT_COLOR_BIT,
         sampleCountBits,
-        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT
+        usageFlags
     );
 }
 
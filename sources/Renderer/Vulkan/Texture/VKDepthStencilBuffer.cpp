@@ -38,13 +38,19 @@ void VKDepthStencilBuffer::Create(
     VKDeviceMemoryManager&  deviceMemoryMngr,
     const Extent2D&         extent,
     VkFormat                format,
-    VkSampleCountFlagBits   sampleCountBits)
+    VkSampleCountFlagBits   sampleCountBits,
+    bool                    transient)
 {
     /* Determine image aspect */
     auto aspectFlags = GetVkImageAspectByFormat(format);
     if (!aspectFlags)
         throw std::invalid_argument("invalid format for Vulkan depth-stencil buffer");
 
+    /* Transient attachments are never loaded or stored, so they can reside in on-chip memory only */
+    VkImageUsageFlags usageFlags = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+    if (transient)
+        usageFlags |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+
     /* Create depth-stencil image */
     VKRenderBuffer::Create(
         deviceMemoryMngr,
@@ -52,7 +58,7 @@ void VKDepthStencilBuffer::Create(
         format,
         aspectFlags,
         sampleCountBits,
-        VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT
+        usageFlags
     );
 }
 
@@ -20,7 +20,7 @@ VKDeviceImage::VKDeviceImage(const VKPtr<VkDevice>& device) :
 {
 }
 
-void VKDeviceImage::AllocateMemoryRegion(VKDeviceMemoryManager& deviceMemoryMngr)
+void VKDeviceImage::AllocateMemoryRegion(VKDeviceMemoryManager& deviceMemoryMngr, VkMemoryPropertyFlags preferredProperties)
 {
     auto device = deviceMemoryMngr.GetVkDevice();
 
@@ -28,12 +28,17 @@ void VKDeviceImage::AllocateMemoryRegion(VKDeviceMemoryManager& deviceMemoryMngr
     VkMemoryRequirements requirements;
     vkGetImageMemoryRequirements(device, image_, &requirements);
 
+    /* Determine memory properties (e.g. lazily allocated memory is only available on tile-based GPUs) */
+    VkMemoryPropertyFlags properties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    if (preferredProperties != 0 && deviceMemoryMngr.HasMemoryType(requirements.memoryTypeBits, properties | preferredProperties))
+        properties |= preferredProperties;
+
     /* Allocate device memory */
     memoryRegion_ = deviceMemoryMngr.Allocate(
         requirements.size,
         requirements.alignment,
         requirements.memoryTypeBits,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+        properties
     );
 
     /* Bind image to device memory region */
@@ -59,21 +64,23 @@ void VKDeviceImage::BindMemoryRegion(VkDevice device, VKDeviceMemoryRegion* memo
 }
 
 void VKDeviceImage::CreateVkImage(
-    VkDevice                device,
-    VkImageType             imageType,
-    VkFormat                format,
-    const VkExtent3D&       extent,
-    std::uint32_t           numMipLevels,
-    std::uint32_t           numArrayLayers,
-    VkImageCreateFlags      createFlags,
-    VkSampleCountFlagBits   sampleCountBits,
-    VkImageUsageFlags       usageFlags)
+    VkDevice                        device,
+    VkImageType                     imageType,
+    VkFormat                        format,
+    const VkExtent3D&               extent,
+    std::uint32_t                   numMipLevels,
+    std::uint32_t                   numArrayLayers,
+    VkImageCreateFlags              createFlags,
+    VkSampleCountFlagBits           sampleCountBits,
+    VkImageUsageFlags               usageFlags,
+    const VKSharedQueueFamilies&    sharedQueueFamilies,
+    const void*                     next)
 {
     /* Create image object */
     VkImageCreateInfo createInfo;
     {
         createInfo.sType                    = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-        createInfo.pNext                    = nullptr;
+        createInfo.pNext                    = next;
         createInfo.flags                    = createFlags;
         createInfo.imageType                = imageType;
         createInfo.format                   = format;
@@ -83,9 +90,18 @@ void VKDeviceImage::CreateVkImage(
         createInfo.samples                  = sampleCountBits;
         createInfo.tiling                   = VK_IMAGE_TILING_OPTIMAL;
         createInfo.usage                    = usageFlags;
-        createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE; // only used by graphics queue
-        createInfo.queueFamilyIndexCount    = 0;
-        createInfo.pQueueFamilyIndices      = nullptr;
+        if (sharedQueueFamilies.count > 1)
+        {
+            createInfo.sharingMode              = VK_SHARING_MODE_CONCURRENT; // shared with asynchronous compute queue
+            createInfo.queueFamilyIndexCount    = sharedQueueFamilies.count;
+            createInfo.pQueueFamilyIndices      = sharedQueueFamilies.indices;
+        }
+        else
+        {
+            createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE; // only used by graphics queue
+            createInfo.queueFamilyIndexCount    = 0;
+            createInfo.pQueueFamilyIndices      = nullptr;
+        }
         createInfo.initialLayout            = VK_IMAGE_LAYOUT_UNDEFINED;
     }
     VkResult result = vkCreateImage(device, &createInfo, nullptr, image_.ReleaseAndGetAddressOf());
@@ -97,6 +113,16 @@ void VKDeviceImage::ReleaseVkImage()
     image_.Release();
 }
 
+void VKDeviceImage::AttachVkImage(VkImage image)
+{
+    image_ = image;
+}
+
+VkImage VKDeviceImage::DetachVkImage()
+{
+    return image_.Detach();
+}
+
 void VKDeviceImage::CreateVkImageView(
     VkDevice                        device,
     VkImageViewType                 viewType,
@@ -12,6 +12,7 @@
 #include <LLGL/Texture.h>
 #include <vulkan/vulkan.h>
 #include "../VKPtr.h"
+#include "../VKCore.h"
 #include <cstdint>
 
 
@@ -35,25 +36,34 @@ class VKDeviceImage
         VKDeviceImage(VKDeviceImage&&) = default;
         VKDeviceImage& operator = (VKDeviceImage&&) = default;
 
-        void AllocateMemoryRegion(VKDeviceMemoryManager& deviceMemoryMngr);
+        // Allocates device local memory for this image. Additional memory properties are only requested if a memory type with those properties is available.
+        void AllocateMemoryRegion(VKDeviceMemoryManager& deviceMemoryMngr, VkMemoryPropertyFlags preferredProperties = 0);
         void ReleaseMemoryRegion(VKDeviceMemoryManager& deviceMemoryMngr);
 
         void BindMemoryRegion(VkDevice device, VKDeviceMemoryRegion* memoryRegion);
 
         void CreateVkImage(
-            VkDevice                device,
-            VkImageType             imageType,
-            VkFormat                format,
-            const VkExtent3D&       extent,
-            std::uint32_t           numMipLevels,
-            std::uint32_t           numArrayLayers,
-            VkImageCreateFlags      createFlags,
-            VkSampleCountFlagBits   sampleCountBits,
-            VkImageUsageFlags       usageFlags
+            VkDevice                        device,
+            VkImageType                     imageType,
+            VkFormat                        format,
+            const VkExtent3D&               extent,
+            std::uint32_t                   numMipLevels,
+            std::uint32_t                   numArrayLayers,
+            VkImageCreateFlags              createFlags,
+            VkSampleCountFlagBits           sampleCountBits,
+            VkImageUsageFlags               usageFlags,
+            const VKSharedQueueFamilies&    sharedQueueFamilies = {},
+            const void*                     next                = nullptr
         );
 
         void ReleaseVkImage();
 
+        // Takes the specified native image without owning it; it must be detached before this wrapper is destroyed.
+        void AttachVkImage(VkImage image);
+
+        // Releases the ownership of the native image without destroying it.
+        VkImage DetachVkImage();
+
         void CreateVkImageView(
             VkDevice                        device,
             VkImageViewType                 viewType,
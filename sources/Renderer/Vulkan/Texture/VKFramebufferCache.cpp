@@ -0,0 +1,155 @@
+/*
+ * VKFramebufferCache.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKFramebufferCache.h"
+#include "../VKCore.h"
+#include "../../../Core/ContainerUtils.h"
+#include <LLGL/Misc/ForRange.h>
+
+
+namespace LLGL
+{
+
+
+VKFramebufferCache::VKFramebufferCache(const VKPtr<VkDevice>& device) :
+    device_ { device }
+{
+}
+
+// Converts the specified Vulkan handle into an integral key value (non-dispatchable handles are not pointers on 32-bit platforms).
+template <typename T>
+static std::uint64_t HandleToKey(T handle)
+{
+    return (std::uint64_t)(handle);
+}
+
+// Serializes the render pass, extent, and image views of a framebuffer into a single key.
+static std::vector<std::uint64_t> MakeFramebufferKey(
+    VkRenderPass        renderPass,
+    const VkExtent2D&   extent,
+    std::uint32_t       numImageViews,
+    const VkImageView*  imageViews)
+{
+    std::vector<std::uint64_t> key;
+    key.reserve(2 + numImageViews);
+
+    key.push_back(HandleToKey(renderPass));
+    key.push_back((static_cast<std::uint64_t>(extent.width) << 32) | static_cast<std::uint64_t>(extent.height));
+
+    for_range(i, numImageViews)
+        key.push_back(HandleToKey(imageViews[i]));
+
+    return key;
+}
+
+VKFramebufferCache::VKFramebufferPtr VKFramebufferCache::GetOrCreate(
+    VkRenderPass        renderPass,
+    const VkExtent2D&   extent,
+    std::uint32_t       numImageViews,
+    const VkImageView*  imageViews)
+{
+    auto key = MakeFramebufferKey(renderPass, extent, numImageViews, imageViews);
+
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    std::size_t insertionIndex = 0;
+    if (auto entry = Find(key, &insertionIndex))
+        return entry->framebuffer;
+
+    /* Create new framebuffer object with insertion sort */
+    auto framebuffer = std::make_shared<VKPtr<VkFramebuffer>>(device_, vkDestroyFramebuffer);
+
+    VkFramebufferCreateInfo createInfo;
+    {
+        createInfo.sType            = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        createInfo.pNext            = nullptr;
+        createInfo.flags            = 0;
+        createInfo.renderPass       = renderPass;
+        createInfo.attachmentCount  = numImageViews;
+        createInfo.pAttachments     = imageViews;
+        createInfo.width            = extent.width;
+        createInfo.height           = extent.height;
+        createInfo.layers           = 1;
+    }
+    VkResult result = vkCreateFramebuffer(device_, &createInfo, nullptr, framebuffer->ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan framebuffer");
+
+    Entry newEntry;
+    {
+        newEntry.key            = std::move(key);
+        newEntry.framebuffer    = framebuffer;
+    }
+    entries_.insert(entries_.begin() + insertionIndex, std::move(newEntry));
+
+    return framebuffer;
+}
+
+void VKFramebufferCache::Release(VKFramebufferPtr&& framebuffer)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    if (framebuffer && framebuffer.use_count() == 2)
+    {
+        for (auto it = entries_.begin(); it != entries_.end(); ++it)
+        {
+            if (it->framebuffer == framebuffer)
+            {
+                entries_.erase(it);
+                break;
+            }
+        }
+    }
+
+    framebuffer.reset();
+}
+
+std::size_t VKFramebufferCache::GetSize() const
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    return entries_.size();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+static int CompareFramebufferKeySWO(const std::vector<std::uint64_t>& lhs, const std::vector<std::uint64_t>& rhs)
+{
+    if (lhs.size() < rhs.size())
+        return -1;
+    if (lhs.size() > rhs.size())
+        return +1;
+    for_range(i, lhs.size())
+    {
+        if (lhs[i] < rhs[i])
+            return -1;
+        if (lhs[i] > rhs[i])
+            return +1;
+    }
+    return 0;
+}
+
+VKFramebufferCache::Entry* VKFramebufferCache::Find(const std::vector<std::uint64_t>& key, std::size_t* index)
+{
+    return Utils::FindInSortedArray<Entry>(
+        entries_.data(),
+        entries_.size(),
+        [&key](const Entry& entry) -> int
+        {
+            return CompareFramebufferKeySWO(entry.key, key);
+        },
+        index
+    );
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
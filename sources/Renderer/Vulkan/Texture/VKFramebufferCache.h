@@ -0,0 +1,86 @@
+/*
+ * VKFramebufferCache.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_FRAMEBUFFER_CACHE_H
+#define LLGL_VK_FRAMEBUFFER_CACHE_H
+
+
+#include <vulkan/vulkan.h>
+#include "../VKPtr.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+Device-wide cache of framebuffers that are shared between all render targets with equal image views, extent, and render pass.
+Since render passes are shared by VKRenderPassCache and attachment image views are shared by VKTexture, render targets that are recreated
+for the same textures (e.g. when they are rebuilt each frame) reuse the same framebuffer.
+An entry is removed once the last render target that refers to it has been released.
+*/
+class VKFramebufferCache
+{
+
+    public:
+
+        using VKFramebufferPtr = std::shared_ptr<VKPtr<VkFramebuffer>>;
+
+    public:
+
+        VKFramebufferCache(const VKPtr<VkDevice>& device);
+
+        VKFramebufferCache(const VKFramebufferCache&) = delete;
+        VKFramebufferCache& operator = (const VKFramebufferCache&) = delete;
+
+        // Returns the framebuffer for the specified render pass, extent, and image views, or creates a new one.
+        VKFramebufferPtr GetOrCreate(
+            VkRenderPass        renderPass,
+            const VkExtent2D&   extent,
+            std::uint32_t       numImageViews,
+            const VkImageView*  imageViews
+        );
+
+        // Releases the specified reference to a framebuffer and removes it from the cache if no other render target refers to it.
+        void Release(VKFramebufferPtr&& framebuffer);
+
+        // Returns the number of distinct framebuffers.
+        std::size_t GetSize() const;
+
+    private:
+
+        struct Entry
+        {
+            std::vector<std::uint64_t>  key;
+            VKFramebufferPtr            framebuffer;
+        };
+
+    private:
+
+        Entry* Find(const std::vector<std::uint64_t>& key, std::size_t* index);
+
+    private:
+
+        const VKPtr<VkDevice>&  device_;
+        std::vector<Entry>      entries_;
+        mutable std::mutex      mutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,452 @@
+/*
+ * VKMipGenerator.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKMipGenerator.h"
+#include "VKTexture.h"
+#include "../VKCore.h"
+#include "../Shader/Builtin/VKBuiltin.h"
+#include <LLGL/TextureFlags.h>
+#include <LLGL/ResourceFlags.h>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+// Push constants of the builtin "GenerateMips2D.comp" shader.
+struct GenerateMips2DParams
+{
+    float           texelSize[2];
+    std::uint32_t   dst1Size[2];
+    std::uint32_t   dst2Size[2];
+};
+
+static const std::uint32_t g_mipGenNumThreads = 8;
+
+VKMipGenerator& VKMipGenerator::Get()
+{
+    static VKMipGenerator instance;
+    return instance;
+}
+
+void VKMipGenerator::InitializeDevice(const VKPtr<VkDevice>& device, VkPhysicalDevice physicalDevice, const VkPhysicalDeviceFeatures& features)
+{
+    device_             = &device;
+    physicalDevice_     = physicalDevice;
+    writeWithoutFormat_ = (features.shaderStorageImageWriteWithoutFormat != VK_FALSE);
+}
+
+void VKMipGenerator::Clear()
+{
+    if (device_ != nullptr)
+    {
+        VkDevice device = *device_;
+        if (pipeline_ != VK_NULL_HANDLE)
+            vkDestroyPipeline(device, pipeline_, nullptr);
+        if (pipelineLayout_ != VK_NULL_HANDLE)
+            vkDestroyPipelineLayout(device, pipelineLayout_, nullptr);
+        if (descriptorSetLayout_ != VK_NULL_HANDLE)
+            vkDestroyDescriptorSetLayout(device, descriptorSetLayout_, nullptr);
+        if (sampler_ != VK_NULL_HANDLE)
+            vkDestroySampler(device, sampler_, nullptr);
+    }
+    pipeline_               = VK_NULL_HANDLE;
+    pipelineLayout_         = VK_NULL_HANDLE;
+    descriptorSetLayout_    = VK_NULL_HANDLE;
+    sampler_                = VK_NULL_HANDLE;
+    device_                 = nullptr;
+    physicalDevice_         = VK_NULL_HANDLE;
+}
+
+static void InsertImageMemoryBarrier(
+    VkCommandBuffer             commandBuffer,
+    VKTexture&                  texture,
+    const TextureSubresource&   subresource,
+    VkImageLayout               oldLayout,
+    VkImageLayout               newLayout,
+    VkAccessFlags               srcAccessMask,
+    VkAccessFlags               dstAccessMask,
+    VkPipelineStageFlags        srcStageMask,
+    VkPipelineStageFlags        dstStageMask)
+{
+    VkImageMemoryBarrier barrier;
+    {
+        barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.pNext                           = nullptr;
+        barrier.srcAccessMask                   = srcAccessMask;
+        barrier.dstAccessMask                   = dstAccessMask;
+        barrier.oldLayout                       = oldLayout;
+        barrier.newLayout                       = newLayout;
+        barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image                           = texture.GetVkImage();
+        barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.baseMipLevel   = subresource.baseMipLevel;
+        barrier.subresourceRange.levelCount     = subresource.numMipLevels;
+        barrier.subresourceRange.baseArrayLayer = subresource.baseArrayLayer;
+        barrier.subresourceRange.layerCount     = subresource.numArrayLayers;
+    }
+    vkCmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
+
+bool VKMipGenerator::GenerateMips(VkCommandBuffer commandBuffer, VKTexture& texture, const TextureSubresource& subresource)
+{
+    if (!IsSupported(texture, subresource))
+        return false;
+
+    /* Create pipeline and per-texture resources on first use */
+    auto& resources = texture.GetMipGenResources();
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        if (pipeline_ == VK_NULL_HANDLE)
+            CreateResources();
+        if (resources.imageViews.empty())
+            CreateTextureResources(texture);
+    }
+
+    /* Transition all MIP-map levels in range into general layout with a single barrier */
+    InsertImageMemoryBarrier(
+        commandBuffer,
+        texture,
+        subresource,
+        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        VK_IMAGE_LAYOUT_GENERAL,
+        VK_ACCESS_MEMORY_WRITE_BIT,
+        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+    );
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline_);
+
+    /* Reduce two MIP-map levels per dispatch; all array layers are processed by the Z dimension of the same dispatch */
+    const std::uint32_t lastMipLevel = subresource.baseMipLevel + subresource.numMipLevels - 1;
+
+    for (std::uint32_t srcMipLevel = subresource.baseMipLevel; srcMipLevel < lastMipLevel; srcMipLevel += 2)
+    {
+        const bool hasSecondLevel = (srcMipLevel + 2 <= lastMipLevel);
+
+        if (srcMipLevel > subresource.baseMipLevel)
+        {
+            /* Make previous pass visible with a single memory barrier for all subresources */
+            VkMemoryBarrier barrier;
+            {
+                barrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+                barrier.pNext           = nullptr;
+                barrier.srcAccessMask   = VK_ACCESS_SHADER_WRITE_BIT;
+                barrier.dstAccessMask   = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+            }
+            vkCmdPipelineBarrier(
+                commandBuffer,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+                1, &barrier,
+                0, nullptr,
+                0, nullptr
+            );
+        }
+
+        const Extent3D dst1Extent = texture.GetMipExtent(srcMipLevel + 1);
+        const Extent3D dst2Extent = (hasSecondLevel ? texture.GetMipExtent(srcMipLevel + 2) : Extent3D{ 0, 0, 0 });
+
+        GenerateMips2DParams params;
+        {
+            params.texelSize[0] = 1.0f / static_cast<float>(dst1Extent.width);
+            params.texelSize[1] = 1.0f / static_cast<float>(dst1Extent.height);
+            params.dst1Size[0]  = dst1Extent.width;
+            params.dst1Size[1]  = dst1Extent.height;
+            params.dst2Size[0]  = dst2Extent.width;
+            params.dst2Size[1]  = dst2Extent.height;
+        }
+
+        VkDescriptorSet descriptorSet = resources.descriptorSets[srcMipLevel * 2 + (hasSecondLevel ? 1 : 0)];
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout_, 0, 1, &descriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, pipelineLayout_, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(params), &params);
+
+        /* Each thread writes a 2x2 block of texels into the first destination level */
+        const std::uint32_t numThreadsX = (dst1Extent.width  + 1) / 2;
+        const std::uint32_t numThreadsY = (dst1Extent.height + 1) / 2;
+
+        vkCmdDispatch(
+            commandBuffer,
+            (numThreadsX + g_mipGenNumThreads - 1) / g_mipGenNumThreads,
+            (numThreadsY + g_mipGenNumThreads - 1) / g_mipGenNumThreads,
+            subresource.numArrayLayers
+        );
+    }
+
+    /* Transition all MIP-map levels in range back into shader-read layout with a single barrier */
+    InsertImageMemoryBarrier(
+        commandBuffer,
+        texture,
+        subresource,
+        VK_IMAGE_LAYOUT_GENERAL,
+        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        VK_ACCESS_SHADER_WRITE_BIT,
+        VK_ACCESS_SHADER_READ_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+    );
+
+    return true;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+static bool IsTexture2DType(const TextureType type)
+{
+    return
+    (
+        type == TextureType::Texture2D      ||
+        type == TextureType::Texture2DArray ||
+        type == TextureType::TextureCube    ||
+        type == TextureType::TextureCubeArray
+    );
+}
+
+bool VKMipGenerator::IsSupported(const VKTexture& texture, const TextureSubresource& subresource) const
+{
+    /*
+    The compute path requires storage image usage, which is only enabled for textures with BindFlags::Storage,
+    and writes all array layers with a single dispatch, so the subresource must include all of them.
+    */
+    const long requiredBindFlags = (BindFlags::Sampled | BindFlags::Storage);
+
+    if (device_ == nullptr || !writeWithoutFormat_)
+        return false;
+    if (!IsTexture2DType(texture.GetType()) || texture.IsSparse())
+        return false;
+    if ((texture.GetBindFlags() & requiredBindFlags) != requiredBindFlags)
+        return false;
+    if (texture.GetAspectFlags() != VK_IMAGE_ASPECT_COLOR_BIT)
+        return false;
+    if (subresource.numMipLevels < 2 || subresource.baseArrayLayer != 0 || subresource.numArrayLayers != texture.GetNumArrayLayers())
+        return false;
+
+    /* Storage images and linear filtering must be supported for this format (excludes sRGB formats on most devices) */
+    const VkFormatFeatureFlags requiredFeatures = (VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT);
+
+    VkFormatProperties formatProperties;
+    vkGetPhysicalDeviceFormatProperties(physicalDevice_, texture.GetVkFormat(), &formatProperties);
+
+    return ((formatProperties.optimalTilingFeatures & requiredFeatures) == requiredFeatures);
+}
+
+void VKMipGenerator::CreateResources()
+{
+    VkDevice device = *device_;
+
+    /* Create linear sampler with clamp-to-edge addressing */
+    VkSamplerCreateInfo samplerCreateInfo;
+    {
+        samplerCreateInfo.sType                     = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerCreateInfo.pNext                     = nullptr;
+        samplerCreateInfo.flags                     = 0;
+        samplerCreateInfo.magFilter                 = VK_FILTER_LINEAR;
+        samplerCreateInfo.minFilter                 = VK_FILTER_LINEAR;
+        samplerCreateInfo.mipmapMode                = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerCreateInfo.addressModeU              = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerCreateInfo.addressModeV              = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerCreateInfo.addressModeW              = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerCreateInfo.mipLodBias                = 0.0f;
+        samplerCreateInfo.anisotropyEnable          = VK_FALSE;
+        samplerCreateInfo.maxAnisotropy             = 1.0f;
+        samplerCreateInfo.compareEnable             = VK_FALSE;
+        samplerCreateInfo.compareOp                 = VK_COMPARE_OP_NEVER;
+        samplerCreateInfo.minLod                    = 0.0f;
+        samplerCreateInfo.maxLod                    = 0.0f;
+        samplerCreateInfo.borderColor               = VK_BORDER_COLOR_FLOAT_TRANSPARENT_BLACK;
+        samplerCreateInfo.unnormalizedCoordinates   = VK_FALSE;
+    }
+    auto result = vkCreateSampler(device, &samplerCreateInfo, nullptr, &sampler_);
+    VKThrowIfFailed(result, "failed to create Vulkan sampler for MIP-map generation");
+
+    /* Create descriptor set layout: source level as combined image-sampler, and two destination levels as storage images */
+    VkDescriptorSetLayoutBinding bindings[3];
+    for (std::uint32_t i = 0; i < 3; ++i)
+    {
+        bindings[i].binding             = i;
+        bindings[i].descriptorType      = (i == 0 ? VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER : VK_DESCRIPTOR_TYPE_STORAGE_IMAGE);
+        bindings[i].descriptorCount     = 1;
+        bindings[i].stageFlags          = VK_SHADER_STAGE_COMPUTE_BIT;
+        bindings[i].pImmutableSamplers  = (i == 0 ? &sampler_ : nullptr);
+    }
+
+    VkDescriptorSetLayoutCreateInfo setLayoutCreateInfo;
+    {
+        setLayoutCreateInfo.sType           = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        setLayoutCreateInfo.pNext           = nullptr;
+        setLayoutCreateInfo.flags           = 0;
+        setLayoutCreateInfo.bindingCount    = 3;
+        setLayoutCreateInfo.pBindings       = bindings;
+    }
+    result = vkCreateDescriptorSetLayout(device, &setLayoutCreateInfo, nullptr, &descriptorSetLayout_);
+    VKThrowIfFailed(result, "failed to create Vulkan descriptor set layout for MIP-map generation");
+
+    /* Create pipeline layout */
+    VkPushConstantRange pushConstantRange;
+    {
+        pushConstantRange.stageFlags    = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset        = 0;
+        pushConstantRange.size          = sizeof(GenerateMips2DParams);
+    }
+
+    VkPipelineLayoutCreateInfo layoutCreateInfo;
+    {
+        layoutCreateInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutCreateInfo.pNext                  = nullptr;
+        layoutCreateInfo.flags                  = 0;
+        layoutCreateInfo.setLayoutCount         = 1;
+        layoutCreateInfo.pSetLayouts            = &descriptorSetLayout_;
+        layoutCreateInfo.pushConstantRangeCount = 1;
+        layoutCreateInfo.pPushConstantRanges    = &pushConstantRange;
+    }
+    result = vkCreatePipelineLayout(device, &layoutCreateInfo, nullptr, &pipelineLayout_);
+    VKThrowIfFailed(result, "failed to create Vulkan pipeline layout for MIP-map generation");
+
+    /* Create compute pipeline from builtin SPIR-V module; the shader module is only needed during pipeline creation */
+    VkShaderModuleCreateInfo moduleCreateInfo;
+    {
+        moduleCreateInfo.sType      = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        moduleCreateInfo.pNext      = nullptr;
+        moduleCreateInfo.flags      = 0;
+        moduleCreateInfo.codeSize   = g_spirvGenerateMips2DLen;
+        moduleCreateInfo.pCode      = g_spirvGenerateMips2D;
+    }
+    VKPtr<VkShaderModule> shaderModule{ *device_, vkDestroyShaderModule };
+    result = vkCreateShaderModule(device, &moduleCreateInfo, nullptr, shaderModule.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan shader module for MIP-map generation");
+
+    VkComputePipelineCreateInfo createInfo;
+    {
+        createInfo.sType                        = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        createInfo.pNext                        = nullptr;
+        createInfo.flags                        = 0;
+        createInfo.stage.sType                  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        createInfo.stage.pNext                  = nullptr;
+        createInfo.stage.flags                  = 0;
+        createInfo.stage.stage                  = VK_SHADER_STAGE_COMPUTE_BIT;
+        createInfo.stage.module                 = shaderModule;
+        createInfo.stage.pName                  = "main";
+        createInfo.stage.pSpecializationInfo    = nullptr;
+        createInfo.layout                       = pipelineLayout_;
+        createInfo.basePipelineHandle           = VK_NULL_HANDLE;
+        createInfo.basePipelineIndex            = 0;
+    }
+    result = vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &createInfo, nullptr, &pipeline_);
+    VKThrowIfFailed(result, "failed to create Vulkan compute pipeline for MIP-map generation");
+}
+
+void VKMipGenerator::CreateTextureResources(VKTexture& texture)
+{
+    VkDevice device = *device_;
+
+    auto& resources = texture.GetMipGenResources();
+
+    const std::uint32_t numMipLevels    = texture.GetNumMipLevels();
+    const std::uint32_t numSrcMipLevels = numMipLevels - 1;
+    const std::uint32_t numSets         = numSrcMipLevels * 2;
+
+    /* Create one 2D-array image view per MIP-map level; cube textures are accessed as arrays of 2D layers */
+    resources.imageViews.reserve(numMipLevels);
+    for (std::uint32_t mipLevel = 0; mipLevel < numMipLevels; ++mipLevel)
+    {
+        TextureViewDescriptor viewDesc;
+        {
+            viewDesc.type                       = TextureType::Texture2DArray;
+            viewDesc.format                     = texture.GetFormat();
+            viewDesc.subresource.baseMipLevel   = mipLevel;
+            viewDesc.subresource.numMipLevels   = 1;
+            viewDesc.subresource.baseArrayLayer = 0;
+            viewDesc.subresource.numArrayLayers = texture.GetNumArrayLayers();
+        }
+        resources.imageViews.emplace_back(*device_, vkDestroyImageView);
+        texture.CreateImageView(device, viewDesc, resources.imageViews.back());
+    }
+
+    /* Create descriptor pool for two sets per source level: one with a single destination level and one with two */
+    VkDescriptorPoolSize poolSizes[2];
+    {
+        poolSizes[0].type               = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        poolSizes[0].descriptorCount    = numSets;
+        poolSizes[1].type               = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        poolSizes[1].descriptorCount    = numSets * 2;
+    }
+
+    VkDescriptorPoolCreateInfo poolCreateInfo;
+    {
+        poolCreateInfo.sType            = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolCreateInfo.pNext            = nullptr;
+        poolCreateInfo.flags            = 0;
+        poolCreateInfo.maxSets          = numSets;
+        poolCreateInfo.poolSizeCount    = 2;
+        poolCreateInfo.pPoolSizes       = poolSizes;
+    }
+    auto result = vkCreateDescriptorPool(device, &poolCreateInfo, nullptr, resources.descriptorPool.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan descriptor pool for MIP-map generation");
+
+    std::vector<VkDescriptorSetLayout> setLayouts(numSets, descriptorSetLayout_);
+
+    VkDescriptorSetAllocateInfo allocInfo;
+    {
+        allocInfo.sType                 = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.pNext                 = nullptr;
+        allocInfo.descriptorPool        = resources.descriptorPool;
+        allocInfo.descriptorSetCount    = numSets;
+        allocInfo.pSetLayouts           = setLayouts.data();
+    }
+    resources.descriptorSets.resize(numSets, VK_NULL_HANDLE);
+    result = vkAllocateDescriptorSets(device, &allocInfo, resources.descriptorSets.data());
+    VKThrowIfFailed(result, "failed to allocate Vulkan descriptor sets for MIP-map generation");
+
+    /* Write descriptors; sets with a single destination level bind that level for both storage images */
+    std::vector<VkDescriptorImageInfo>  imageInfos(numSets * 3);
+    std::vector<VkWriteDescriptorSet>   writes(numSets * 3);
+
+    for (std::uint32_t i = 0; i < numSets; ++i)
+    {
+        const std::uint32_t srcMipLevel     = i / 2;
+        const std::uint32_t dst1MipLevel    = srcMipLevel + 1;
+        const std::uint32_t dst2MipLevel    = ((i % 2) == 1 && srcMipLevel + 2 < numMipLevels ? srcMipLevel + 2 : dst1MipLevel);
+        const std::uint32_t mipLevels[3]    = { srcMipLevel, dst1MipLevel, dst2MipLevel };
+
+        for (std::uint32_t binding = 0; binding < 3; ++binding)
+        {
+            auto& imageInfo = imageInfos[i * 3 + binding];
+            {
+                imageInfo.sampler       = VK_NULL_HANDLE;
+                imageInfo.imageView     = resources.imageViews[mipLevels[binding]];
+                imageInfo.imageLayout   = VK_IMAGE_LAYOUT_GENERAL;
+            }
+            auto& write = writes[i * 3 + binding];
+            {
+                write.sType             = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                write.pNext             = nullptr;
+                write.dstSet            = resources.descriptorSets[i];
+                write.dstBinding        = binding;
+                write.dstArrayElement   = 0;
+                write.descriptorCount   = 1;
+                write.descriptorType    = (binding == 0 ? VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER : VK_DESCRIPTOR_TYPE_STORAGE_IMAGE);
+                write.pImageInfo        = &imageInfo;
+                write.pBufferInfo       = nullptr;
+                write.pTexelBufferView  = nullptr;
+            }
+        }
+    }
+
+    vkUpdateDescriptorSets(device, static_cast<std::uint32_t>(writes.size()), writes.data(), 0, nullptr);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
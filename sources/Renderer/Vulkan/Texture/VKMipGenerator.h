@@ -0,0 +1,87 @@
+/*
+ * VKMipGenerator.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_MIP_GENERATOR_H
+#define LLGL_VK_MIP_GENERATOR_H
+
+
+#include <vulkan/vulkan.h>
+#include "../VKPtr.h"
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+class VKTexture;
+struct TextureSubresource;
+
+// Vulkan MIP-map generator singleton for compute-based MIP-map generation of 2D textures.
+class VKMipGenerator
+{
+
+    public:
+
+        // Returns the singleton instance.
+        static VKMipGenerator& Get();
+
+    public:
+
+        VKMipGenerator(const VKMipGenerator&) = delete;
+        VKMipGenerator& operator = (const VKMipGenerator&) = delete;
+
+        VKMipGenerator(VKMipGenerator&&) = delete;
+        VKMipGenerator& operator = (VKMipGenerator&&) = delete;
+
+        void InitializeDevice(const VKPtr<VkDevice>& device, VkPhysicalDevice physicalDevice, const VkPhysicalDeviceFeatures& features);
+        void Clear();
+
+        /*
+        Generates the MIP-maps of the specified subresource with compute dispatches that reduce two MIP-map levels each.
+        The subresource is expected to be in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL layout and is left in that layout.
+        Returns false if the texture is not supported, in which case no commands have been recorded.
+        */
+        bool GenerateMips(VkCommandBuffer commandBuffer, VKTexture& texture, const TextureSubresource& subresource);
+
+    private:
+
+        VKMipGenerator() = default;
+
+        // Returns true if the compute path can be used for the specified texture and subresource.
+        bool IsSupported(const VKTexture& texture, const TextureSubresource& subresource) const;
+
+        // Creates the shader module, descriptor set layout, pipeline layout, and compute pipeline on first use.
+        void CreateResources();
+
+        // Creates the image views and descriptor sets of the specified texture on first use.
+        void CreateTextureResources(VKTexture& texture);
+
+    private:
+
+        const VKPtr<VkDevice>*          device_                 = nullptr;
+        VkPhysicalDevice                physicalDevice_         = VK_NULL_HANDLE;
+        bool                            writeWithoutFormat_     = false;
+
+        VkSampler                       sampler_                = VK_NULL_HANDLE;
+        VkDescriptorSetLayout           descriptorSetLayout_    = VK_NULL_HANDLE;
+        VkPipelineLayout                pipelineLayout_         = VK_NULL_HANDLE;
+        VkPipeline                      pipeline_               = VK_NULL_HANDLE;
+
+        std::mutex                      mutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -54,8 +54,11 @@ void VKRenderBuffer::Create(
         usageFlags
     );
 
-    /* Allocate device memory region */
-    AllocateMemoryRegion(deviceMemoryMngr);
+    /* Allocate device memory region; transient attachments prefer lazily allocated memory */
+    if ((usageFlags & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) != 0)
+        AllocateMemoryRegion(deviceMemoryMngr, VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT);
+    else
+        AllocateMemoryRegion(deviceMemoryMngr);
 
     /* Create depth-stencil image view */
     VkImageSubresourceRange subresourceRange;
@@ -8,10 +8,13 @@
 #include "VKRenderTarget.h"
 #include "VKTexture.h"
 #include "../Memory/VKDeviceMemoryManager.h"
+#include "../RenderState/VKRenderPassCache.h"
+#include "../Ext/VKExtensions.h"
 #include "../../CheckedCast.h"
 #include "../../../Core/Helper.h"
 #include "../VKCore.h"
 #include "../VKTypes.h"
+#include <LLGL/Misc/ForRange.h>
 #include <vector>
 #include <algorithm>
 
@@ -23,15 +26,22 @@ namespace LLGL
 VKRenderTarget::VKRenderTarget(
     const VKPtr<VkDevice>&          device,
     VKDeviceMemoryManager&          deviceMemoryMngr,
+    VKRenderPassCache&              renderPassCache,
+    VKFramebufferCache&             framebufferCache,
+    bool                            dynamicRendering,
     const RenderTargetDescriptor&   desc)
 :
-    resolution_          { desc.resolution                            },
-    framebuffer_         { device, vkDestroyFramebuffer               },
-    defaultRenderPass_   { device                                     },
-    secondaryRenderPass_ { device                                     },
-    depthStencilBuffer_  { device                                     },
-    sampleCountBits_     { VKTypes::ToVkSampleCountBits(desc.samples) }
+    resolution_         { desc.resolution                            },
+    renderPassCache_    { renderPassCache                            },
+    framebufferCache_   { framebufferCache                           },
+    depthStencilBuffer_ { device                                     },
+    sampleCountBits_    { VKTypes::ToVkSampleCountBits(desc.samples) }
 {
+    /* Render passes that are specified by the client are native objects, so only the default render pass can be used with dynamic rendering */
+    dynamicRendering = (dynamicRendering && desc.renderPass == nullptr);
+
+    CreateAttachments(device, deviceMemoryMngr, desc);
+
     if (desc.renderPass)
     {
         /* Get render pass from descriptor */
@@ -39,12 +49,29 @@ VKRenderTarget::VKRenderTarget(
     }
     else
     {
-        /* Create default render pass */
-        CreateDefaultRenderPass(device, desc);
-        renderPass_ = (&defaultRenderPass_);
+        /* Get default render pass from cache */
+        defaultRenderPass_ = CreateRenderPass(desc, false, dynamicRendering);
+        renderPass_ = defaultRenderPass_.get();
     }
-    CreateSecondaryRenderPass(device, desc);
-    CreateFramebuffer(device, deviceMemoryMngr, desc);
+    secondaryRenderPass_ = CreateRenderPass(desc, true, dynamicRendering);
+
+    /* Get framebuffer object from cache, which is shared with all render targets for the same attachments */
+    if (!dynamicRendering)
+    {
+        framebuffer_ = framebufferCache_.GetOrCreate(
+            renderPass_->GetVkRenderPass(),
+            GetVkExtent(),
+            static_cast<std::uint32_t>(imageViewRefs_.size()),
+            imageViewRefs_.data()
+        );
+    }
+}
+
+VKRenderTarget::~VKRenderTarget()
+{
+    framebufferCache_.Release(std::move(framebuffer_));
+    renderPassCache_.Release(std::move(defaultRenderPass_));
+    renderPassCache_.Release(std::move(secondaryRenderPass_));
 }
 
 Extent2D VKRenderTarget::GetResolution() const
@@ -82,6 +109,160 @@ bool VKRenderTarget::HasMultiSampling() const
     return (sampleCountBits_ > VK_SAMPLE_COUNT_1_BIT);
 }
 
+static void SetVkRenderingAttachmentInfo(
+    VkRenderingAttachmentInfoKHR&   dst,
+    VkImageView                     imageView,
+    VkImageLayout                   imageLayout,
+    VkAttachmentLoadOp              loadOp,
+    VkAttachmentStoreOp             storeOp,
+    const VkClearValue*             clearValue)
+{
+    dst.sType               = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+    dst.pNext               = nullptr;
+    dst.imageView           = imageView;
+    dst.imageLayout         = imageLayout;
+    dst.resolveMode         = VK_RESOLVE_MODE_NONE_KHR;
+    dst.resolveImageView    = VK_NULL_HANDLE;
+    dst.resolveImageLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
+    dst.loadOp              = loadOp;
+    dst.storeOp             = storeOp;
+    if (loadOp == VK_ATTACHMENT_LOAD_OP_CLEAR && clearValue != nullptr)
+        dst.clearValue = *clearValue;
+    else
+        dst.clearValue = {};
+}
+
+void VKRenderTarget::BeginRendering(
+    VkCommandBuffer     commandBuffer,
+    const VKRenderPass& renderPass,
+    const VkClearValue* clearValues,
+    VkRenderingFlagsKHR flags,
+    bool                resume)
+{
+    const bool          hasDepthStencil = (depthStencilFormat_ != VK_FORMAT_UNDEFINED);
+    const std::uint32_t numAttachments  = (hasDepthStencil ? numColorAttachments_ + 1u : numColorAttachments_);
+
+    bool loadContent[LLGL_MAX_NUM_COLOR_ATTACHMENTS*2 + 1] = {};
+
+    /* Initialize color attachments with the load and store operations of the specified render pass */
+    VkRenderingAttachmentInfoKHR colorAttachments[LLGL_MAX_NUM_COLOR_ATTACHMENTS];
+
+    for_range(i, numColorAttachments_)
+    {
+        VkAttachmentLoadOp  loadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        VkAttachmentStoreOp storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+
+        if (i < renderPass.GetNumColorAttachments())
+        {
+            const auto& attachmentDesc = renderPass.GetColorAttachmentDesc(i);
+            loadOp  = attachmentDesc.loadOp;
+            storeOp = attachmentDesc.storeOp;
+        }
+
+        if (resume)
+            loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+
+        auto& attachment = colorAttachments[i];
+
+        if (HasMultiSampling())
+        {
+            /* Render into multi-sampled color buffer and resolve it into the texture attachment */
+            SetVkRenderingAttachmentInfo(attachment, imageViewRefs_[numAttachments + i], VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, loadOp, storeOp, &clearValues[i]);
+            attachment.resolveMode          = VK_RESOLVE_MODE_AVERAGE_BIT_KHR;
+            attachment.resolveImageView     = imageViewRefs_[i];
+            attachment.resolveImageLayout   = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            loadContent[numAttachments + i] = (loadOp == VK_ATTACHMENT_LOAD_OP_LOAD);
+        }
+        else
+        {
+            SetVkRenderingAttachmentInfo(attachment, imageViewRefs_[i], VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, loadOp, storeOp, &clearValues[i]);
+            loadContent[i] = (loadOp == VK_ATTACHMENT_LOAD_OP_LOAD);
+        }
+    }
+
+    /* Initialize depth and stencil attachments, which refer to the same image view */
+    VkRenderingAttachmentInfoKHR depthAttachment, stencilAttachment;
+    bool hasDepthAspect = false, hasStencilAspect = false;
+
+    if (hasDepthStencil)
+    {
+        VkAttachmentLoadOp  depthLoadOp     = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        VkAttachmentStoreOp depthStoreOp    = VK_ATTACHMENT_STORE_OP_STORE;
+        VkAttachmentLoadOp  stencilLoadOp   = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        VkAttachmentStoreOp stencilStoreOp  = VK_ATTACHMENT_STORE_OP_STORE;
+
+        if (renderPass.GetDepthStencilIndex() != 0xFFu)
+        {
+            const auto& attachmentDesc = renderPass.GetDepthStencilAttachmentDesc();
+            depthLoadOp     = attachmentDesc.loadOp;
+            depthStoreOp    = attachmentDesc.storeOp;
+            stencilLoadOp   = attachmentDesc.stencilLoadOp;
+            stencilStoreOp  = attachmentDesc.stencilStoreOp;
+        }
+
+        if (resume)
+        {
+            depthLoadOp     = VK_ATTACHMENT_LOAD_OP_LOAD;
+            stencilLoadOp   = VK_ATTACHMENT_LOAD_OP_LOAD;
+        }
+
+        const auto aspectMask = attachmentImages_[numColorAttachments_].subresourceRange.aspectMask;
+        hasDepthAspect      = ((aspectMask & VK_IMAGE_ASPECT_DEPTH_BIT) != 0);
+        hasStencilAspect    = ((aspectMask & VK_IMAGE_ASPECT_STENCIL_BIT) != 0);
+
+        const auto imageView = imageViewRefs_[numColorAttachments_];
+        SetVkRenderingAttachmentInfo(depthAttachment, imageView, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, depthLoadOp, depthStoreOp, &clearValues[numColorAttachments_]);
+        SetVkRenderingAttachmentInfo(stencilAttachment, imageView, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, stencilLoadOp, stencilStoreOp, &clearValues[numColorAttachments_]);
+
+        loadContent[numColorAttachments_] =
+        (
+            (hasDepthAspect   && depthLoadOp   == VK_ATTACHMENT_LOAD_OP_LOAD) ||
+            (hasStencilAspect && stencilLoadOp == VK_ATTACHMENT_LOAD_OP_LOAD)
+        );
+    }
+
+    /* Transition attachments into their attachment layouts, since there is no render pass that would do so */
+    RecordAttachmentBarriers(commandBuffer, true, loadContent);
+
+    /* Begin dynamic rendering instance */
+    VkRenderingInfoKHR renderingInfo;
+    {
+        renderingInfo.sType                 = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+        renderingInfo.pNext                 = nullptr;
+        renderingInfo.flags                 = flags;
+        renderingInfo.renderArea.offset     = { 0, 0 };
+        renderingInfo.renderArea.extent     = GetVkExtent();
+        renderingInfo.layerCount            = 1;
+        renderingInfo.viewMask              = 0;
+        renderingInfo.colorAttachmentCount  = numColorAttachments_;
+        renderingInfo.pColorAttachments     = colorAttachments;
+        renderingInfo.pDepthAttachment      = (hasDepthAspect ? &depthAttachment : nullptr);
+        renderingInfo.pStencilAttachment    = (hasStencilAspect ? &stencilAttachment : nullptr);
+    }
+    vkCmdBeginRenderingKHR(commandBuffer, &renderingInfo);
+}
+
+void VKRenderTarget::EndRendering(VkCommandBuffer commandBuffer)
+{
+    vkCmdEndRenderingKHR(commandBuffer);
+    RecordAttachmentBarriers(commandBuffer, false, nullptr);
+}
+
+void VKRenderTarget::GetInheritanceRenderingInfo(VkCommandBufferInheritanceRenderingInfoKHR& outInfo) const
+{
+    VkFormat colorFormats[LLGL_MAX_NUM_COLOR_ATTACHMENTS];
+
+    outInfo.sType                   = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO_KHR;
+    outInfo.pNext                   = nullptr;
+    outInfo.flags                   = 0;
+    outInfo.viewMask                = 0;
+    outInfo.colorAttachmentCount    = numColorAttachments_;
+    outInfo.pColorAttachmentFormats = colorFormats_;
+    outInfo.rasterizationSamples    = sampleCountBits_;
+
+    renderPass_->GetDynamicRenderingFormats(colorFormats, outInfo.depthAttachmentFormat, outInfo.stencilAttachmentFormat);
+}
+
 
 /*
  * ======= Private: =======
@@ -119,7 +300,8 @@ void VKRenderTarget::CreateDepthStencilForAttachment(VKDeviceMemoryManager& devi
             deviceMemoryMngr,
             GetResolution(),
             GetDepthAttachmentVkFormat(attachmentDesc.type),
-            sampleCountBits_
+            sampleCountBits_,
+            attachmentDesc.transient
         );
     }
     else
@@ -133,13 +315,17 @@ static void Convert(
     VkSampleCountFlagBits       sampleCountBits,
     bool                        loadContent)
 {
+    /* Internal transient buffers are never loaded or stored */
+    const bool storeContent = (src.texture != nullptr || !src.transient);
+    loadContent = (loadContent && storeContent);
+
     dst.flags           = 0;
     dst.format          = format;
     dst.samples         = sampleCountBits;
     dst.loadOp          = (loadContent ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_DONT_CARE);
-    dst.storeOp         = VK_ATTACHMENT_STORE_OP_STORE;
+    dst.storeOp         = (storeContent ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE);
     dst.stencilLoadOp   = (loadContent && HasStencilComponent(src.type) ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_DONT_CARE);
-    dst.stencilStoreOp  = (HasStencilComponent(src.type) ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE);
+    dst.stencilStoreOp  = (storeContent && HasStencilComponent(src.type) ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE);
     dst.initialLayout   = (loadContent ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED);
     dst.finalLayout     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 }
@@ -148,31 +334,48 @@ static void SetVkAttachmentDescForColor(
     VkAttachmentDescription&    dst,
     VkFormat                    format,
     VkSampleCountFlagBits       sampleCountBits,
-    bool                        loadContent)
+    bool                        loadContent,
+    bool                        transient)
 {
+    /* Internal transient buffers are never loaded or stored */
+    loadContent = (loadContent && !transient);
+
     dst.flags           = 0;
     dst.format          = format;
     dst.samples         = sampleCountBits;
     dst.loadOp          = (loadContent ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_DONT_CARE);
-    dst.storeOp         = VK_ATTACHMENT_STORE_OP_STORE;
+    dst.storeOp         = (transient ? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_STORE);
     dst.stencilLoadOp   = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
     dst.stencilStoreOp  = VK_ATTACHMENT_STORE_OP_DONT_CARE;
     dst.initialLayout   = (loadContent ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED);
     dst.finalLayout     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 }
 
-void VKRenderTarget::CreateRenderPass(
-    VkDevice                        device,
+// Returns true if the color attachment with the specified index is transient.
+static bool IsColorAttachmentTransient(const RenderTargetDescriptor& desc, std::uint32_t colorAttachment)
+{
+    for (const auto& attachment : desc.attachments)
+    {
+        if (attachment.type == AttachmentType::Color)
+        {
+            if (colorAttachment == 0)
+                return attachment.transient;
+            --colorAttachment;
+        }
+    }
+    return false;
+}
+
+std::shared_ptr<VKRenderPass> VKRenderTarget::CreateRenderPass(
     const RenderTargetDescriptor&   desc,
-    VKRenderPass&                   renderPass,
-    bool                            loadContent)
+    bool                            loadContent,
+    bool                            dynamicRendering)
 {
     /* Initialize attachment descriptors */
     std::uint32_t numAttachments        = static_cast<std::uint32_t>(desc.attachments.size());
     std::uint32_t numColorAttachments   = 0;
 
     std::vector<VkAttachmentDescription> attachmentDescs(numAttachments);
-    std::vector<VkFormat> colorFormats(numAttachments);
 
     for (const auto& attachment : desc.attachments)
     {
@@ -191,7 +394,7 @@ void VKRenderTarget::CreateRenderPass(
             );
 
             if (attachment.type == AttachmentType::Color)
-                colorFormats[numColorAttachments++] = textureVK->GetVkFormat();
+                ++numColorAttachments;
         }
         else
         {
@@ -216,9 +419,10 @@ void VKRenderTarget::CreateRenderPass(
         {
             SetVkAttachmentDescForColor(
                 attachmentDescs[numAttachments + i],
-                colorFormats[i],
+                colorFormats_[i],
                 sampleCountBits_,
-                loadContent
+                loadContent,
+                IsColorAttachmentTransient(desc, i)
             );
         }
 
@@ -227,27 +431,17 @@ void VKRenderTarget::CreateRenderPass(
             attachmentDescs[i].loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
     }
 
-    /* Create native Vulkan render pass with attachment descriptors */
-    renderPass.CreateVkRenderPassWithDescriptors(
-        device,
+    /* Get render pass with attachment descriptors from cache, which is shared with all compatible render targets */
+    return renderPassCache_.GetOrCreate(
         numAttachments,
         numColorAttachments,
         attachmentDescs.data(),
-        sampleCountBits_
+        sampleCountBits_,
+        dynamicRendering
     );
 }
 
-void VKRenderTarget::CreateDefaultRenderPass(VkDevice device, const RenderTargetDescriptor& desc)
-{
-    CreateRenderPass(device, desc, defaultRenderPass_, false);
-}
-
-void VKRenderTarget::CreateSecondaryRenderPass(VkDevice device, const RenderTargetDescriptor& desc)
-{
-    CreateRenderPass(device, desc, secondaryRenderPass_, true);
-}
-
-void VKRenderTarget::CreateFramebuffer(
+void VKRenderTarget::CreateAttachments(
     const VKPtr<VkDevice>&          device,
     VKDeviceMemoryManager&          deviceMemoryMngr,
     const RenderTargetDescriptor&   desc)
@@ -255,15 +449,27 @@ void VKRenderTarget::CreateFramebuffer(
     depthStencilFormat_     = VK_FORMAT_UNDEFINED;
     numColorAttachments_    = 0;
 
-    /* Create image view for each attachment */
+    /* Get image view for each attachment */
     std::uint32_t numAttachments = static_cast<std::uint32_t>(desc.attachments.size());
 
     if (numAttachments == 0)
         throw std::runtime_error("cannot create render target without attachments");
 
-    imageViews_.reserve(numAttachments);
-    std::vector<VkImageView> imageViewRefs(numAttachments);
-    std::vector<VkFormat> colorFormats(numAttachments);
+    imageViewRefs_.resize(numAttachments);
+    attachmentImages_.resize(numAttachments);
+
+    auto SetAttachmentImage = [this](std::uint32_t index, VkImage image, VkImageAspectFlags aspectMask, std::uint32_t mipLevel, std::uint32_t arrayLayer, bool internal)
+    {
+        auto& dst = attachmentImages_[index];
+        dst.image                               = image;
+        dst.subresourceRange.aspectMask         = aspectMask;
+        dst.subresourceRange.baseMipLevel       = mipLevel;
+        dst.subresourceRange.levelCount         = 1;
+        dst.subresourceRange.baseArrayLayer     = arrayLayer;
+        dst.subresourceRange.layerCount         = 1;
+        dst.depthStencil                        = ((aspectMask & VK_IMAGE_ASPECT_COLOR_BIT) == 0);
+        dst.internal                            = internal;
+    };
 
     for (const auto& attachment : desc.attachments)
     {
@@ -271,27 +477,25 @@ void VKRenderTarget::CreateFramebuffer(
         {
             auto textureVK = LLGL_CAST(VKTexture*, texture);
 
-            /* Create new image view for MIP-level and array layer specified in attachment descriptor */
-            VKPtr<VkImageView> imageView{ device, vkDestroyImageView };
-            {
-                textureVK->CreateImageView(device, attachment.mipLevel, /*numMips:*/ 1, attachment.arrayLayer, /*numLayers:*/ 1, imageView);
+            /* Get image view for MIP-level and array layer specified in attachment descriptor; it is shared with other render targets */
+            VkImageView imageView = textureVK->GetOrCreateAttachmentImageView(device, attachment.mipLevel, attachment.arrayLayer);
 
-                /* Add image view to attachments */
-                if (attachment.type == AttachmentType::Color)
-                {
-                    /* Next color attachment index */
-                    imageViewRefs[numColorAttachments_] = imageView;
-                    colorFormats[numColorAttachments_] = textureVK->GetVkFormat();
-                    ++numColorAttachments_;
-                }
-                else
-                {
-                    /* Store depth-stencil format */
-                    imageViewRefs[numAttachments - 1] = imageView;
-                    depthStencilFormat_ = textureVK->GetVkFormat();
-                }
+            /* Add image view to attachments */
+            if (attachment.type == AttachmentType::Color)
+            {
+                /* Next color attachment index */
+                imageViewRefs_[numColorAttachments_] = imageView;
+                SetAttachmentImage(numColorAttachments_, textureVK->GetVkImage(), textureVK->GetAspectFlags(), attachment.mipLevel, attachment.arrayLayer, false);
+                colorFormats_[numColorAttachments_] = textureVK->GetVkFormat();
+                ++numColorAttachments_;
+            }
+            else
+            {
+                /* Store depth-stencil format */
+                imageViewRefs_[numAttachments - 1] = imageView;
+                SetAttachmentImage(numAttachments - 1, textureVK->GetVkImage(), textureVK->GetAspectFlags(), attachment.mipLevel, attachment.arrayLayer, false);
+                depthStencilFormat_ = textureVK->GetVkFormat();
             }
-            imageViews_.emplace_back(std::move(imageView));
 
             /* Validate texture resolution to render target (to validate correlation between attachments) */
             ValidateMipResolution(*textureVK, attachment.mipLevel);
@@ -302,10 +506,17 @@ void VKRenderTarget::CreateFramebuffer(
             CreateDepthStencilForAttachment(deviceMemoryMngr, attachment);
 
             /* Add depth-stencil image view to attachments */
-            imageViewRefs[numAttachments - 1] = depthStencilBuffer_.GetVkImageView();
+            imageViewRefs_[numAttachments - 1] = depthStencilBuffer_.GetVkImageView();
 
             /* Store depth-stencil format */
             depthStencilFormat_ = depthStencilBuffer_.GetVkFormat();
+
+            VkImageAspectFlags aspectMask = 0;
+            if (depthStencilFormat_ != VK_FORMAT_S8_UINT)
+                aspectMask |= VK_IMAGE_ASPECT_DEPTH_BIT;
+            if (HasStencilComponent(attachment.type))
+                aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
+            SetAttachmentImage(numAttachments - 1, depthStencilBuffer_.GetVkImage(), aspectMask, 0, 0, true);
         }
     }
 
@@ -313,35 +524,97 @@ void VKRenderTarget::CreateFramebuffer(
     if (HasMultiSampling())
     {
         colorBuffers_.reserve(numColorAttachments_);
-        imageViewRefs.reserve(numAttachments + numColorAttachments_);
+        imageViewRefs_.reserve(numAttachments + numColorAttachments_);
+        attachmentImages_.resize(numAttachments + numColorAttachments_);
 
         for (std::uint32_t i = 0; i < numColorAttachments_; ++i)
         {
             /* Create new multi-sampled color buffer and store reference to image view in primary attachment container */
             auto colorBuffer = MakeUnique<VKColorBuffer>(device);
             {
-                colorBuffer->Create(deviceMemoryMngr, GetResolution(), colorFormats[i], sampleCountBits_);
-                imageViewRefs.push_back(colorBuffer->GetVkImageView());
+                colorBuffer->Create(deviceMemoryMngr, GetResolution(), colorFormats_[i], sampleCountBits_, IsColorAttachmentTransient(desc, i));
+                imageViewRefs_.push_back(colorBuffer->GetVkImageView());
+                SetAttachmentImage(numAttachments + i, colorBuffer->GetVkImage(), VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, true);
             }
             colorBuffers_.push_back(std::move(colorBuffer));
         }
     }
+}
+
+void VKRenderTarget::RecordAttachmentBarriers(VkCommandBuffer commandBuffer, bool beginRendering, const bool* loadContent)
+{
+    VkImageMemoryBarrier barriers[LLGL_MAX_NUM_COLOR_ATTACHMENTS*2 + 1];
+    std::uint32_t numBarriers = 0;
+
+    VkPipelineStageFlags srcStageMask = 0, dstStageMask = 0;
 
-    /* Create framebuffer object */
-    VkFramebufferCreateInfo createInfo;
+    const VkPipelineStageFlags shaderStages = (VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+
+    for_range(i, attachmentImages_.size())
     {
-        createInfo.sType            = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-        createInfo.pNext            = nullptr;
-        createInfo.flags            = 0;
-        createInfo.renderPass       = renderPass_->GetVkRenderPass();
-        createInfo.attachmentCount  = (HasMultiSampling() ? numAttachments + numColorAttachments_ : numAttachments);
-        createInfo.pAttachments     = imageViewRefs.data();
-        createInfo.width            = GetResolution().width;
-        createInfo.height           = GetResolution().height;
-        createInfo.layers           = 1;
+        const auto& attachment = attachmentImages_[i];
+
+        /* Internal buffers are never sampled, so they remain in their attachment layout after rendering */
+        if (!beginRendering && attachment.internal)
+            continue;
+
+        const VkImageLayout         attachmentLayout    = (attachment.depthStencil ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+        const VkAccessFlags         attachmentAccess    =
+        (
+            attachment.depthStencil
+                ? (VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT)
+                : (VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT)
+        );
+        const VkPipelineStageFlags  attachmentStages    =
+        (
+            attachment.depthStencil
+                ? (VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT)
+                : VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT
+        );
+
+        auto& barrier = barriers[numBarriers++];
+        {
+            barrier.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.pNext               = nullptr;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image               = attachment.image;
+            barrier.subresourceRange    = attachment.subresourceRange;
+
+            if (beginRendering)
+            {
+                /* Discard previous content unless it is loaded */
+                if (attachment.internal)
+                {
+                    barrier.oldLayout       = (loadContent[i] ? attachmentLayout : VK_IMAGE_LAYOUT_UNDEFINED);
+                    barrier.srcAccessMask   = attachmentAccess;
+                    srcStageMask            |= attachmentStages;
+                }
+                else
+                {
+                    barrier.oldLayout       = (loadContent[i] ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED);
+                    barrier.srcAccessMask   = 0;
+                    srcStageMask            |= shaderStages;
+                }
+                barrier.newLayout       = attachmentLayout;
+                barrier.dstAccessMask   = attachmentAccess;
+                dstStageMask            |= attachmentStages;
+            }
+            else
+            {
+                /* Transition textures back into their default layout (see VKResourceStateTracker) */
+                barrier.oldLayout       = attachmentLayout;
+                barrier.newLayout       = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+                barrier.srcAccessMask   = attachmentAccess;
+                barrier.dstAccessMask   = VK_ACCESS_SHADER_READ_BIT;
+                srcStageMask            |= attachmentStages;
+                dstStageMask            |= shaderStages;
+            }
+        }
     }
-    VkResult result = vkCreateFramebuffer(device, &createInfo, nullptr, framebuffer_.ReleaseAndGetAddressOf());
-    VKThrowIfFailed(result, "failed to create Vulkan framebuffer");
+
+    if (numBarriers > 0)
+        vkCmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, 0, 0, nullptr, 0, nullptr, numBarriers, barriers);
 }
 
 
@@ -15,6 +15,8 @@
 #include "../RenderState/VKRenderPass.h"
 #include "VKDepthStencilBuffer.h"
 #include "VKColorBuffer.h"
+#include "VKFramebufferCache.h"
+#include <LLGL/StaticLimits.h>
 #include <memory>
 
 
@@ -22,6 +24,13 @@ namespace LLGL
 {
 
 
+class VKRenderPassCache;
+
+/*
+Vulkan render target. Render passes and framebuffers are shared with other render targets via VKRenderPassCache and VKFramebufferCache.
+If "VK_KHR_dynamic_rendering" is enabled and no render pass is specified in the descriptor, the render target has no render pass and framebuffer objects at all,
+and is rendered with vkCmdBeginRenderingKHR instead.
+*/
 class VKRenderTarget final : public RenderTarget
 {
 
@@ -30,8 +39,12 @@ class VKRenderTarget final : public RenderTarget
         VKRenderTarget(
             const VKPtr<VkDevice>&          device,
             VKDeviceMemoryManager&          deviceMemoryMngr,
+            VKRenderPassCache&              renderPassCache,
+            VKFramebufferCache&             framebufferCache,
+            bool                            dynamicRendering,
             const RenderTargetDescriptor&   desc
         );
+        ~VKRenderTarget();
 
         Extent2D GetResolution() const override;
         std::uint32_t GetSamples() const override;
@@ -47,10 +60,35 @@ class VKRenderTarget final : public RenderTarget
         // Returns true if this render target has multi-sampling enabled.
         bool HasMultiSampling() const;
 
-        // Returns the Vulkan framebuffer object.
+        /*
+        Records the layout transitions of all attachments and begins a dynamic rendering instance.
+        The load and store operations are taken from the specified render pass, and the clear values are indexed by attachment, i.e. the depth-stencil clear value follows the color clear values.
+        If 'resume' is true, the content of all attachments is loaded, e.g. to continue rendering after a transfer command.
+        */
+        void BeginRendering(
+            VkCommandBuffer     commandBuffer,
+            const VKRenderPass& renderPass,
+            const VkClearValue* clearValues,
+            VkRenderingFlagsKHR flags,
+            bool                resume
+        );
+
+        // Ends the dynamic rendering instance and transitions all texture attachments back into their default layout.
+        void EndRendering(VkCommandBuffer commandBuffer);
+
+        // Fills the inheritance information for secondary command buffers that are executed inside a dynamic rendering instance of this render target.
+        void GetInheritanceRenderingInfo(VkCommandBufferInheritanceRenderingInfoKHR& outInfo) const;
+
+        // Returns true if this render target uses dynamic rendering instead of render pass and framebuffer objects.
+        inline bool IsDynamicRendering() const
+        {
+            return (renderPass_->IsDynamicRendering());
+        }
+
+        // Returns the Vulkan framebuffer object, or VK_NULL_HANDLE if this render target uses dynamic rendering.
         inline VkFramebuffer GetVkFramebuffer() const
         {
-            return framebuffer_;
+            return (framebuffer_ ? framebuffer_->Get() : VK_NULL_HANDLE);
         }
 
         // Returns the Vulkan render pass object.
@@ -62,7 +100,7 @@ class VKRenderTarget final : public RenderTarget
         // Returns the secondary Vulkan render pass object.
         inline VkRenderPass GetSecondaryVkRenderPass() const
         {
-            return secondaryRenderPass_.GetVkRenderPass();
+            return secondaryRenderPass_->GetVkRenderPass();
         }
 
         // Returns the render target resolution as VkExtent2D.
@@ -75,41 +113,53 @@ class VKRenderTarget final : public RenderTarget
 
         void CreateDepthStencilForAttachment(VKDeviceMemoryManager& deviceMemoryMngr, const AttachmentDescriptor& attachmentDesc);
 
-        void CreateRenderPass(
-            VkDevice                        device,
+        std::shared_ptr<VKRenderPass> CreateRenderPass(
             const RenderTargetDescriptor&   desc,
-            VKRenderPass&                   renderPass,
-            bool                            loadContent
+            bool                            loadContent,
+            bool                            dynamicRendering
         );
 
-        void CreateDefaultRenderPass(VkDevice device, const RenderTargetDescriptor& desc);
-        void CreateSecondaryRenderPass(VkDevice device, const RenderTargetDescriptor& desc);
-
-        void CreateFramebuffer(
+        void CreateAttachments(
             const VKPtr<VkDevice>&          device,
             VKDeviceMemoryManager&          deviceMemoryMngr,
             const RenderTargetDescriptor&   desc
         );
 
+        void RecordAttachmentBarriers(VkCommandBuffer commandBuffer, bool beginRendering, const bool* loadContent);
+
     private:
 
+        // Image of a framebuffer attachment for the layout transitions of dynamic rendering.
+        struct AttachmentImage
+        {
+            VkImage                 image;
+            VkImageSubresourceRange subresourceRange;
+            bool                    depthStencil;
+            bool                    internal;           // Internal buffers remain in their attachment layout.
+        };
+
         using VKColorBufferPtr = std::unique_ptr<VKColorBuffer>;
 
-        Extent2D                        resolution_;
+        Extent2D                                resolution_;
+
+        VKRenderPassCache&                      renderPassCache_;
+        VKFramebufferCache&                     framebufferCache_;
 
-        VKPtr<VkFramebuffer>            framebuffer_;
-        const VKRenderPass*             renderPass_             = nullptr;
-        VKRenderPass                    defaultRenderPass_;
-        VKRenderPass                    secondaryRenderPass_;
+        VKFramebufferCache::VKFramebufferPtr    framebuffer_;
+        const VKRenderPass*                     renderPass_             = nullptr;
+        std::shared_ptr<VKRenderPass>           defaultRenderPass_;
+        std::shared_ptr<VKRenderPass>           secondaryRenderPass_;
 
-        std::vector<VKPtr<VkImageView>> imageViews_;
+        std::vector<VkImageView>                imageViewRefs_;                                 // Color attachments, depth-stencil attachment, and multi-sampled color buffers.
+        std::vector<AttachmentImage>            attachmentImages_;                              // Same order as 'imageViewRefs_'; only used for dynamic rendering.
+        VkFormat                                colorFormats_[LLGL_MAX_NUM_COLOR_ATTACHMENTS];
 
-        VKDepthStencilBuffer            depthStencilBuffer_;
-        VkFormat                        depthStencilFormat_     = VK_FORMAT_UNDEFINED;  // Format either from internal depth-stencil buffer or attachmed texture.
-        std::vector<VKColorBufferPtr>   colorBuffers_;                                  // Internal color buffers for multi-sampling
+        VKDepthStencilBuffer                    depthStencilBuffer_;
+        VkFormat                                depthStencilFormat_     = VK_FORMAT_UNDEFINED;  // Format either from internal depth-stencil buffer or attachmed texture.
+        std::vector<VKColorBufferPtr>           colorBuffers_;                                  // Internal color buffers for multi-sampling
 
-        std::uint32_t                   numColorAttachments_    = 0;
-        VkSampleCountFlagBits           sampleCountBits_        = VK_SAMPLE_COUNT_1_BIT;
+        std::uint32_t                           numColorAttachments_    = 0;
+        VkSampleCountFlagBits                   sampleCountBits_        = VK_SAMPLE_COUNT_1_BIT;
 
 };
 
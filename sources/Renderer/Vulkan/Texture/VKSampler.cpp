@@ -36,9 +36,10 @@ static VkBorderColor GetVkBorderColor(const ColorRGBAf& color)
     return VK_BORDER_COLOR_FLOAT_TRANSPARENT_BLACK;
 }
 
-VKSampler::VKSampler(const VKPtr<VkDevice>& device, const SamplerDescriptor& desc) :
-    sampler_ { device, vkDestroySampler }
+static std::shared_ptr<VKPtr<VkSampler>> CreateVkSampler(const VKPtr<VkDevice>& device, const SamplerDescriptor& desc)
 {
+    auto sampler = std::make_shared<VKPtr<VkSampler>>(device, vkDestroySampler);
+
     /* Create sampler state */
     VkSamplerCreateInfo createInfo;
     {
@@ -75,8 +76,28 @@ VKSampler::VKSampler(const VKPtr<VkDevice>& device, const SamplerDescriptor& des
             createInfo.maxLod       = 0.25f;
         }
     }
-    VkResult result = vkCreateSampler(device, &createInfo, nullptr, sampler_.ReleaseAndGetAddressOf());
+    VkResult result = vkCreateSampler(device, &createInfo, nullptr, sampler->ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan sampler");
+
+    return sampler;
+}
+
+VKSampler::VKSampler(const VKPtr<VkDevice>& device, VKSamplerCache& samplerCache, const SamplerDescriptor& desc) :
+    samplerCache_ { samplerCache },
+    desc_         { desc         }
+{
+    sampler_ = samplerCache.GetOrCreate(
+        desc,
+        [&device, &desc]()
+        {
+            return CreateVkSampler(device, desc);
+        }
+    );
+}
+
+VKSampler::~VKSampler()
+{
+    samplerCache_.Release(desc_, std::move(sampler_));
 }
 
 
@@ -12,28 +12,35 @@
 #include <LLGL/Sampler.h>
 #include <vulkan/vulkan.h>
 #include "../VKPtr.h"
+#include "../../SamplerCache.h"
 
 
 namespace LLGL
 {
 
 
+using VKSamplerCache = SamplerCache<VKPtr<VkSampler>>;
+
 class VKSampler final : public Sampler
 {
 
     public:
 
-        VKSampler(const VKPtr<VkDevice>& device, const SamplerDescriptor& desc);
+        // Shares the native sampler with all other samplers of the same descriptor in the specified cache.
+        VKSampler(const VKPtr<VkDevice>& device, VKSamplerCache& samplerCache, const SamplerDescriptor& desc);
+        ~VKSampler();
 
         // Returns the Vulkan sampler object.
         inline VkSampler GetVkSampler() const
         {
-            return sampler_.Get();
+            return sampler_->Get();
         }
 
     private:
 
-        VKPtr<VkSampler> sampler_;
+        VKSamplerCache&                     samplerCache_;
+        SamplerDescriptor                   desc_;
+        std::shared_ptr<VKPtr<VkSampler>>   sampler_;
 
 };
 
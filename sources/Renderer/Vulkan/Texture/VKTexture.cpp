@@ -7,9 +7,15 @@
 
 #include "VKTexture.h"
 #include "../Memory/VKDeviceMemory.h"
+#include "../Memory/VKDeviceMemoryManager.h"
+#include "../Memory/VKExternalMemory.h"
+#include "../VKDevice.h"
 #include "../VKTypes.h"
 #include "../VKCore.h"
+#include "../../../Core/Helper.h"
+#include <LLGL/ResourceFlags.h>
 #include <algorithm>
+#include <stdexcept>
 
 
 namespace LLGL
@@ -17,18 +23,94 @@ namespace LLGL
 
 
 VKTexture::VKTexture(
-    const VKPtr<VkDevice>&      device,
-    VKDeviceMemoryManager&      deviceMemoryMngr,
-    const TextureDescriptor&    desc)
+    const VKPtr<VkDevice>&          device,
+    VKDeviceMemoryManager&          deviceMemoryMngr,
+    const TextureDescriptor&        desc,
+    const VKSharedQueueFamilies&    sharedQueueFamilies)
 :
-    Texture    { desc.type, desc.bindFlags  },
-    image_     { device                     },
-    imageView_ { device, vkDestroyImageView },
-    format_    { VKTypes::Map(desc.format)  }
+    Texture          { desc.type, desc.bindFlags  },
+    image_           { device                     },
+    imageView_       { device, vkDestroyImageView },
+    mipGenResources_ { device                     },
+    format_          { VKTypes::Map(desc.format)  }
+{
+    const bool shared = ((desc.miscFlags & MiscFlags::Shared) != 0);
+
+    /* Create Vulkan image and allocate memory region (sparse textures are bound to memory per tile) */
+    CreateImage(device, desc, sharedQueueFamilies, (shared ? VKGetExportMemoryHandleType() : 0));
+    if (sparse_)
+        InitSparseTiles(device);
+    else if (shared)
+    {
+        /* Allocate dedicated memory that can be exported to other APIs or processes */
+        VkMemoryRequirements requirements;
+        vkGetImageMemoryRequirements(device, GetVkImage(), &requirements);
+
+        externalMemory_ = MakeUnique<VKExternalMemory>(device);
+        externalMemory_->AllocateAndBind(
+            requirements,
+            deviceMemoryMngr.FindMemoryType(requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
+            GetVkImage(),
+            VK_NULL_HANDLE
+        );
+    }
+    else
+        image_.AllocateMemoryRegion(deviceMemoryMngr);
+}
+
+VKTexture::VKTexture(
+    const VKPtr<VkDevice>&          device,
+    VKDeviceMemoryManager&          deviceMemoryMngr,
+    const TextureDescriptor&        desc,
+    const NativeResourceHandle&     nativeHandle,
+    const VKSharedQueueFamilies&    sharedQueueFamilies)
+:
+    Texture          { desc.type, desc.bindFlags  },
+    image_           { device                     },
+    imageView_       { device, vkDestroyImageView },
+    mipGenResources_ { device                     },
+    format_          { VKTypes::Map(desc.format)  }
+{
+    if (nativeHandle.type == NativeHandleType::VkImage)
+    {
+        /* Take native image without ownership; its memory is managed by the client */
+        InitImageParameters(desc);
+        image_.AttachVkImage(VKHandleFromUInt64<VkImage>(nativeHandle.object));
+        ownsImage_ = false;
+    }
+    else
+    {
+        const auto handleTypes = VKGetImportMemoryHandleType(nativeHandle.type);
+        if (handleTypes == 0)
+            throw std::invalid_argument("cannot import Vulkan image from unsupported native handle type");
+
+        /* Create Vulkan image that is bound to the imported device memory */
+        CreateImage(device, desc, sharedQueueFamilies, handleTypes);
+
+        VkMemoryRequirements requirements;
+        vkGetImageMemoryRequirements(device, GetVkImage(), &requirements);
+
+        externalMemory_ = MakeUnique<VKExternalMemory>(device);
+        externalMemory_->ImportAndBind(
+            nativeHandle,
+            requirements,
+            deviceMemoryMngr.FindMemoryType(requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
+            GetVkImage(),
+            VK_NULL_HANDLE
+        );
+    }
+}
+
+VKTexture::~VKTexture()
+{
+    /* Don't destroy native image that was imported */
+    if (!ownsImage_)
+        image_.DetachVkImage();
+}
+
+VKTexture::MipGenResources::MipGenResources(const VKPtr<VkDevice>& device) :
+    descriptorPool { device, vkDestroyDescriptorPool }
 {
-    /* Create Vulkan image and allocate memory region */
-    CreateImage(device, desc);
-    image_.AllocateMemoryRegion(deviceMemoryMngr);
 }
 
 Extent3D VKTexture::GetMipExtent(std::uint32_t mipLevel) const
@@ -189,6 +271,24 @@ void VKTexture::CreateInternalImageView(VkDevice device)
     CreateImageView(device, 0, GetNumMipLevels(), 0, GetNumArrayLayers(), imageView_);
 }
 
+VkImageView VKTexture::GetOrCreateAttachmentImageView(const VKPtr<VkDevice>& device, std::uint32_t mipLevel, std::uint32_t arrayLayer)
+{
+    std::lock_guard<std::mutex> guard{ attachmentImageViewsMutex_ };
+
+    for (const auto& view : attachmentImageViews_)
+    {
+        if (view.mipLevel == mipLevel && view.arrayLayer == arrayLayer)
+            return view.imageView;
+    }
+
+    /* Create new image view for the specified MIP-map level and array layer */
+    AttachmentImageView view{ mipLevel, arrayLayer, VKPtr<VkImageView>{ device, vkDestroyImageView } };
+    CreateImageView(device, mipLevel, /*numMips:*/ 1, arrayLayer, /*numLayers:*/ 1, view.imageView);
+    attachmentImageViews_.push_back(std::move(view));
+
+    return attachmentImageViews_.back().imageView;
+}
+
 static VkImageAspectFlags GetAspectFlagsByFormat(VkFormat format)
 {
     switch (format)
@@ -213,6 +313,206 @@ VkImageAspectFlags VKTexture::GetAspectFlags() const
     return GetAspectFlagsByFormat(format_);
 }
 
+void VKTexture::GetNativeHandle(NativeResourceHandle& outHandle) const
+{
+    outHandle.type          = NativeHandleType::VkImage;
+    outHandle.object        = VKHandleToUInt64(GetVkImage());
+    outHandle.memory        = 0;
+    outHandle.memoryOffset  = 0;
+    outHandle.memorySize    = 0;
+
+    if (externalMemory_)
+    {
+        outHandle.memory        = VKHandleToUInt64(externalMemory_->GetVkDeviceMemory());
+        outHandle.memorySize    = externalMemory_->GetSize();
+    }
+    else if (auto region = GetMemoryRegion())
+    {
+        outHandle.memory        = VKHandleToUInt64(region->GetParentChunk()->GetVkDeviceMemory());
+        outHandle.memoryOffset  = region->GetOffset();
+        outHandle.memorySize    = region->GetSize();
+    }
+}
+
+bool VKTexture::ExportMemory(NativeHandleType handleType, NativeResourceHandle& outHandle) const
+{
+    if (ownsImage_ && externalMemory_)
+        return externalMemory_->Export(handleType, outHandle);
+    return false;
+}
+
+bool VKTexture::GetTiling(TextureTiling& outTiling) const
+{
+    if (!sparse_)
+        return false;
+
+    const auto& granularity = sparseImageReqs_.formatProperties.imageGranularity;
+    outTiling.tileExtent            = { granularity.width, granularity.height, granularity.depth };
+    outTiling.tileSize              = sparseMemoryReqs_.alignment;
+    outTiling.firstPackedMipLevel   = std::min(sparseImageReqs_.imageMipTailFirstLod, numMipLevels_);
+    outTiling.numMipLevels          = numMipLevels_;
+
+    return true;
+}
+
+// Returns the offset and extent in units of tiles for the specified region, clamped to the number of tiles.
+static void GetTileRange(std::int32_t offset, std::uint32_t extent, std::uint32_t granularity, std::uint32_t numTiles, std::uint32_t& outBegin, std::uint32_t& outEnd)
+{
+    const auto begin = static_cast<std::uint32_t>(std::max(0, offset));
+    outBegin    = std::min(begin / granularity, numTiles);
+    outEnd      = std::min((begin + extent + granularity - 1) / granularity, numTiles);
+}
+
+void VKTexture::CommitTiles(
+    VKDevice&               device,
+    VKDeviceMemoryManager&  deviceMemoryMngr,
+    const TextureRegion&    textureRegion,
+    bool                    commit)
+{
+    if (!sparse_)
+        return;
+
+    const auto mipLevel     = textureRegion.subresource.baseMipLevel;
+    const auto layerBegin   = std::min(textureRegion.subresource.baseArrayLayer, numArrayLayers_);
+    const auto layerEnd     = std::min(textureRegion.subresource.baseArrayLayer + textureRegion.subresource.numArrayLayers, numArrayLayers_);
+
+    if (mipLevel >= numMipLevels_)
+        return;
+
+    std::vector<VkSparseImageMemoryBind>    imageBinds;
+    std::vector<VkSparseMemoryBind>         opaqueBinds;
+    std::vector<VKDeviceMemoryRegion*>      regionsToRelease;
+
+    auto AllocTile = [&](VkDeviceSize size) -> VKDeviceMemoryRegion*
+    {
+        auto region = deviceMemoryMngr.Allocate(
+            size,
+            sparseMemoryReqs_.alignment,
+            sparseMemoryReqs_.memoryTypeBits,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+        );
+        if (region == nullptr)
+            throw std::runtime_error("failed to allocate device memory for Vulkan sparse image tile");
+        return region;
+    };
+
+    if (mipLevel >= sparseImageReqs_.imageMipTailFirstLod)
+    {
+        /* Commit or decommit MIP-map tail of the selected array layers */
+        const bool singleMipTail = ((sparseImageReqs_.formatProperties.flags & VK_SPARSE_IMAGE_FORMAT_SINGLE_MIPTAIL_BIT) != 0);
+        const auto tailBegin = (singleMipTail ? 0u : layerBegin);
+        const auto tailEnd   = (singleMipTail ? 1u : layerEnd);
+
+        for (auto layer = tailBegin; layer < tailEnd; ++layer)
+        {
+            auto& tail = mipTails_[layer];
+            if ((tail != nullptr) == commit)
+                continue;
+
+            VkSparseMemoryBind bind;
+            {
+                bind.resourceOffset = sparseImageReqs_.imageMipTailOffset + layer * sparseImageReqs_.imageMipTailStride;
+                bind.size           = sparseImageReqs_.imageMipTailSize;
+                bind.flags          = 0;
+                if (commit)
+                {
+                    tail                = AllocTile(sparseImageReqs_.imageMipTailSize);
+                    bind.memory         = tail->GetParentChunk()->GetVkDeviceMemory();
+                    bind.memoryOffset   = tail->GetOffset();
+                }
+                else
+                {
+                    regionsToRelease.push_back(tail);
+                    tail                = nullptr;
+                    bind.memory         = VK_NULL_HANDLE;
+                    bind.memoryOffset   = 0;
+                }
+            }
+            opaqueBinds.push_back(bind);
+        }
+    }
+    else
+    {
+        /* Commit or decommit all tiles within the region */
+        const auto& granularity = sparseImageReqs_.formatProperties.imageGranularity;
+        const auto  numTiles    = GetNumTiles(mipLevel);
+        const auto  mipExtent   = GetMipExtent(mipLevel);
+
+        std::uint32_t tileBeginX, tileEndX, tileBeginY, tileEndY;
+        GetTileRange(textureRegion.offset.x, textureRegion.extent.width,  granularity.width,  numTiles.width,  tileBeginX, tileEndX);
+        GetTileRange(textureRegion.offset.y, textureRegion.extent.height, granularity.height, numTiles.height, tileBeginY, tileEndY);
+
+        for (auto layer = layerBegin; layer < layerEnd; ++layer)
+        {
+            const auto firstTile = GetTileIndex(layer, mipLevel);
+
+            for (auto y = tileBeginY; y < tileEndY; ++y)
+            {
+                for (auto x = tileBeginX; x < tileEndX; ++x)
+                {
+                    auto& tile = tiles_[firstTile + y * numTiles.width + x];
+                    if ((tile != nullptr) == commit)
+                        continue;
+
+                    VkSparseImageMemoryBind bind;
+                    {
+                        bind.subresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                        bind.subresource.mipLevel   = mipLevel;
+                        bind.subresource.arrayLayer = layer;
+                        bind.offset.x               = static_cast<std::int32_t>(x * granularity.width);
+                        bind.offset.y               = static_cast<std::int32_t>(y * granularity.height);
+                        bind.offset.z               = 0;
+                        bind.extent.width           = std::min(granularity.width,  mipExtent.width  - x * granularity.width);
+                        bind.extent.height          = std::min(granularity.height, mipExtent.height - y * granularity.height);
+                        bind.extent.depth           = 1;
+                        bind.flags                  = 0;
+                        if (commit)
+                        {
+                            tile                = AllocTile(sparseMemoryReqs_.alignment);
+                            bind.memory         = tile->GetParentChunk()->GetVkDeviceMemory();
+                            bind.memoryOffset   = tile->GetOffset();
+                        }
+                        else
+                        {
+                            regionsToRelease.push_back(tile);
+                            tile                = nullptr;
+                            bind.memory         = VK_NULL_HANDLE;
+                            bind.memoryOffset   = 0;
+                        }
+                    }
+                    imageBinds.push_back(bind);
+                }
+            }
+        }
+    }
+
+    /* Update sparse bindings, then release memory of all decommitted tiles */
+    device.BindSparseImageMemory(GetVkImage(), imageBinds, opaqueBinds);
+
+    for (auto region : regionsToRelease)
+        deviceMemoryMngr.Release(region);
+}
+
+void VKTexture::ReleaseTiles(VKDeviceMemoryManager& deviceMemoryMngr)
+{
+    for (auto& tile : tiles_)
+    {
+        if (tile != nullptr)
+        {
+            deviceMemoryMngr.Release(tile);
+            tile = nullptr;
+        }
+    }
+    for (auto& tail : mipTails_)
+    {
+        if (tail != nullptr)
+        {
+            deviceMemoryMngr.Release(tail);
+            tail = nullptr;
+        }
+    }
+}
+
 
 /*
  * ======= Private: =======
@@ -237,6 +537,10 @@ static VkImageCreateFlags GetVkImageCreateFlags(const TextureDescriptor& desc)
             break;
     }
 
+    /* Sparse textures are bound to device memory per tile after creation */
+    if ((desc.miscFlags & MiscFlags::Sparse) != 0)
+        createFlags |= (VK_IMAGE_CREATE_SPARSE_BINDING_BIT | VK_IMAGE_CREATE_SPARSE_RESIDENCY_BIT);
+
     return createFlags;
 }
 
@@ -355,27 +659,110 @@ static VkImageUsageFlags GetVkImageUsageFlags(const TextureDescriptor& desc)
     return usageFlags;
 }
 
-void VKTexture::CreateImage(VkDevice device, const TextureDescriptor& desc)
+void VKTexture::CreateImage(
+    VkDevice                        device,
+    const TextureDescriptor&        desc,
+    const VKSharedQueueFamilies&    sharedQueueFamilies,
+    VkExternalMemoryHandleTypeFlags externalHandleTypes)
 {
     /* Setup texture parameters */
-    auto imageType  = GetVkImageType(desc.type);
+    InitImageParameters(desc);
 
-    extent_         = GetVkImageExtent3D(desc, imageType);
-    numMipLevels_   = NumMipLevels(desc);
-    numArrayLayers_ = GetVkImageArrayLayers(desc, imageType);
+    /* Chain external memory info if the image is bound to shared memory */
+    VkExternalMemoryImageCreateInfo externalInfo;
+    {
+        externalInfo.sType          = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_IMAGE_CREATE_INFO;
+        externalInfo.pNext          = nullptr;
+        externalInfo.handleTypes    = externalHandleTypes;
+    }
 
     /* Create image object */
     image_.CreateVkImage(
         device,
-        imageType,
+        GetVkImageType(desc.type),
         format_,
         extent_,
         numMipLevels_,
         numArrayLayers_,
         GetVkImageCreateFlags(desc),
         GetVkImageSampleCountFlags(desc),
-        GetVkImageUsageFlags(desc)
+        GetVkImageUsageFlags(desc),
+        sharedQueueFamilies,
+        (externalHandleTypes != 0 ? &externalInfo : nullptr)
+    );
+}
+
+void VKTexture::InitImageParameters(const TextureDescriptor& desc)
+{
+    auto imageType  = GetVkImageType(desc.type);
+
+    extent_         = GetVkImageExtent3D(desc, imageType);
+    numMipLevels_   = NumMipLevels(desc);
+    numArrayLayers_ = GetVkImageArrayLayers(desc, imageType);
+    sparse_         = ((desc.miscFlags & MiscFlags::Sparse) != 0);
+}
+
+void VKTexture::InitSparseTiles(VkDevice device)
+{
+    /* Query memory requirements; the alignment denotes the size of each sparse block */
+    vkGetImageMemoryRequirements(device, GetVkImage(), &sparseMemoryReqs_);
+
+    std::uint32_t numRequirements = 0;
+    vkGetImageSparseMemoryRequirements(device, GetVkImage(), &numRequirements, nullptr);
+
+    std::vector<VkSparseImageMemoryRequirements> requirements(numRequirements);
+    vkGetImageSparseMemoryRequirements(device, GetVkImage(), &numRequirements, requirements.data());
+
+    auto it = std::find_if(
+        requirements.begin(),
+        requirements.end(),
+        [](const VkSparseImageMemoryRequirements& entry)
+        {
+            return ((entry.formatProperties.aspectMask & VK_IMAGE_ASPECT_COLOR_BIT) != 0);
+        }
     );
+
+    if (it == requirements.end())
+        throw std::runtime_error("failed to query sparse memory requirements for Vulkan image");
+
+    sparseImageReqs_ = *it;
+
+    /* Initialize tile lists for all MIP-map levels that are not packed into the MIP-map tail */
+    const auto numTiledMips = std::min(sparseImageReqs_.imageMipTailFirstLod, numMipLevels_);
+
+    mipTileOffsets_.resize(numTiledMips);
+    numTilesPerLayer_ = 0;
+
+    for (std::uint32_t mip = 0; mip < numTiledMips; ++mip)
+    {
+        const auto numTiles = GetNumTiles(mip);
+        mipTileOffsets_[mip] = numTilesPerLayer_;
+        numTilesPerLayer_ += numTiles.width * numTiles.height;
+    }
+
+    tiles_.resize(numTilesPerLayer_ * numArrayLayers_, nullptr);
+
+    if (numTiledMips < numMipLevels_)
+    {
+        const bool singleMipTail = ((sparseImageReqs_.formatProperties.flags & VK_SPARSE_IMAGE_FORMAT_SINGLE_MIPTAIL_BIT) != 0);
+        mipTails_.resize(singleMipTail ? 1 : numArrayLayers_, nullptr);
+    }
+}
+
+VkExtent2D VKTexture::GetNumTiles(std::uint32_t mipLevel) const
+{
+    const auto& granularity = sparseImageReqs_.formatProperties.imageGranularity;
+    const auto  mipExtent   = GetMipExtent(mipLevel);
+    return VkExtent2D
+    {
+        (mipExtent.width  + granularity.width  - 1) / granularity.width,
+        (mipExtent.height + granularity.height - 1) / granularity.height
+    };
+}
+
+std::size_t VKTexture::GetTileIndex(std::uint32_t arrayLayer, std::uint32_t mipLevel) const
+{
+    return (arrayLayer * numTilesPerLayer_ + mipTileOffsets_[mipLevel]);
 }
 
 
@@ -14,26 +14,55 @@
 #include <vulkan/vulkan.h>
 #include "../VKPtr.h"
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 
 namespace LLGL
 {
 
 
+class VKDevice;
 class VKDeviceMemoryRegion;
 class VKDeviceMemoryManager;
+class VKExternalMemory;
 
 class VKTexture final : public Texture
 {
 
+    public:
+
+        // Resources for compute-based MIP-map generation. They are created on first use by VKMipGenerator.
+        struct MipGenResources
+        {
+            MipGenResources(const VKPtr<VkDevice>& device);
+
+            VKPtr<VkDescriptorPool>         descriptorPool;
+            std::vector<VkDescriptorSet>    descriptorSets; // Two descriptor sets per source MIP-map level (for one or two destination levels).
+            std::vector<VKPtr<VkImageView>> imageViews;     // One 2D-array image view per MIP-map level.
+        };
+
     public:
 
         VKTexture(
-            const VKPtr<VkDevice>&      device,
-            VKDeviceMemoryManager&      deviceMemoryMngr,
-            const TextureDescriptor&    desc
+            const VKPtr<VkDevice>&          device,
+            VKDeviceMemoryManager&          deviceMemoryMngr,
+            const TextureDescriptor&        desc,
+            const VKSharedQueueFamilies&    sharedQueueFamilies = {}
         );
 
+        // Imports a native VkImage (without ownership) or the device memory of a shared handle.
+        VKTexture(
+            const VKPtr<VkDevice>&          device,
+            VKDeviceMemoryManager&          deviceMemoryMngr,
+            const TextureDescriptor&        desc,
+            const NativeResourceHandle&     nativeHandle,
+            const VKSharedQueueFamilies&    sharedQueueFamilies = {}
+        );
+
+        ~VKTexture();
+
         Extent3D GetMipExtent(std::uint32_t mipLevel) const override;
 
         TextureDescriptor GetDesc() const override;
@@ -62,6 +91,32 @@ class VKTexture final : public Texture
         // Creates the standard image view that is stored within this texture object.
         void CreateInternalImageView(VkDevice device);
 
+        /*
+        Returns the image view of a single MIP-map level and array layer for render target attachments, or creates a new one.
+        These image views are shared between all render targets that refer to the same subresource, so their framebuffers can be shared, too.
+        */
+        VkImageView GetOrCreateAttachmentImageView(const VKPtr<VkDevice>& device, std::uint32_t mipLevel, std::uint32_t arrayLayer);
+
+        // Queries the tiling properties of this texture. Returns false if this is not a sparse texture.
+        bool GetTiling(TextureTiling& outTiling) const;
+
+        // Commits or decommits device memory for all tiles of this sparse texture within the specified region.
+        void CommitTiles(
+            VKDevice&               device,
+            VKDeviceMemoryManager&  deviceMemoryMngr,
+            const TextureRegion&    textureRegion,
+            bool                    commit
+        );
+
+        // Releases the device memory of all committed tiles of this sparse texture.
+        void ReleaseTiles(VKDeviceMemoryManager& deviceMemoryMngr);
+
+        // Returns the native VkImage and its device memory.
+        void GetNativeHandle(NativeResourceHandle& outHandle) const;
+
+        // Exports a shared handle of the device memory. Returns false if this texture was not created with the MiscFlags::Shared flag.
+        bool ExportMemory(NativeHandleType handleType, NativeResourceHandle& outHandle) const;
+
         // Returns the image ascpect flags for the VkFormat of this texture.
         VkImageAspectFlags GetAspectFlags() const;
 
@@ -107,20 +162,82 @@ class VKTexture final : public Texture
             return image_.GetMemoryRegion();
         }
 
+        // Returns true if this texture was created with the MiscFlags::Sparse flag.
+        inline bool IsSparse() const
+        {
+            return sparse_;
+        }
+
+        // Returns true if the device memory of this texture is exported to or imported from a shared handle.
+        inline bool IsExternal() const
+        {
+            return (externalMemory_ != nullptr);
+        }
+
+        // Returns the resources for compute-based MIP-map generation.
+        inline MipGenResources& GetMipGenResources()
+        {
+            return mipGenResources_;
+        }
+
+    private:
+
+        void CreateImage(
+            VkDevice                        device,
+            const TextureDescriptor&        desc,
+            const VKSharedQueueFamilies&    sharedQueueFamilies,
+            VkExternalMemoryHandleTypeFlags externalHandleTypes = 0
+        );
+
+        // Sets the image parameters of the specified descriptor without creating a Vulkan image.
+        void InitImageParameters(const TextureDescriptor& desc);
+
+        // Queries the sparse memory requirements and initializes the tile lists.
+        void InitSparseTiles(VkDevice device);
+
+        // Returns the number of tiles in X and Y direction for the specified MIP-map level.
+        VkExtent2D GetNumTiles(std::uint32_t mipLevel) const;
+
+        // Returns the index of the first tile of the specified array layer and MIP-map level within the 'tiles_' list.
+        std::size_t GetTileIndex(std::uint32_t arrayLayer, std::uint32_t mipLevel) const;
+
     private:
 
-        void CreateImage(VkDevice device, const TextureDescriptor& desc);
+        struct AttachmentImageView
+        {
+            std::uint32_t       mipLevel;
+            std::uint32_t       arrayLayer;
+            VKPtr<VkImageView>  imageView;
+        };
 
     private:
 
         VKDeviceImage       image_;
         VKPtr<VkImageView>  imageView_;
 
+        std::vector<AttachmentImageView>    attachmentImageViews_;
+        std::mutex                          attachmentImageViewsMutex_;
+
+        MipGenResources                     mipGenResources_;
+
         VkFormat            format_         = VK_FORMAT_UNDEFINED;
         VkExtent3D          extent_;
         std::uint32_t       numMipLevels_   = 0;
         std::uint32_t       numArrayLayers_ = 0;
 
+        /* External memory (only used if this texture was created with MiscFlags::Shared or imported from a native handle) */
+        std::unique_ptr<VKExternalMemory>   externalMemory_;
+        bool                                ownsImage_          = true;     // False if a native VkImage was imported.
+
+        /* Sparse residency (only used if this texture was created with MiscFlags::Sparse) */
+        bool                                sparse_             = false;
+        VkMemoryRequirements                sparseMemoryReqs_   = {};
+        VkSparseImageMemoryRequirements     sparseImageReqs_    = {};
+        std::vector<std::size_t>            mipTileOffsets_;                    // Offset of the first tile of each MIP-map level within a single array layer.
+        std::size_t                         numTilesPerLayer_   = 0;
+        std::vector<VKDeviceMemoryRegion*>  tiles_;                             // Committed tiles of all MIP-map levels that are not packed into the MIP-map tail.
+        std::vector<VKDeviceMemoryRegion*>  mipTails_;                          // Committed MIP-map tail of each array layer (or a single one for all layers).
+
 };
 
 
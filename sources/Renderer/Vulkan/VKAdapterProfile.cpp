@@ -0,0 +1,142 @@
+/*
+ * VKAdapterProfile.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKAdapterProfile.h"
+#include <fstream>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+/* ----- Profile file format ----- */
+
+static const char           g_profileFileMagic[8]   = { 'L', 'L', 'G', 'L', 'V', 'K', 'A', 'P' };
+static const std::uint32_t  g_profileFileVersion    = 1;
+
+struct ProfileFileHeader
+{
+    char            magic[8];
+    std::uint32_t   version;
+    std::uint32_t   headerVersion;      // VK_HEADER_VERSION, since the size of the property structures must match
+    std::int32_t    deviceIndex;
+    std::uint32_t   vendorID;
+    std::uint32_t   deviceID;
+    std::uint32_t   driverVersion;
+    std::uint8_t    pipelineCacheUUID[VK_UUID_SIZE];
+    std::uint32_t   numInstanceLayers;
+    std::uint32_t   numInstanceExtensions;
+    std::uint32_t   numDeviceExtensions;
+};
+
+template <typename T>
+static bool ReadArray(std::ifstream& file, std::vector<T>& outArray, std::uint32_t count)
+{
+    outArray.resize(count);
+    return (count == 0 || file.read(reinterpret_cast<char*>(outArray.data()), static_cast<std::streamsize>(sizeof(T) * count)));
+}
+
+template <typename T>
+static void WriteArray(std::ofstream& file, const std::vector<T>& array)
+{
+    if (!array.empty())
+        file.write(reinterpret_cast<const char*>(array.data()), static_cast<std::streamsize>(sizeof(T) * array.size()));
+}
+
+
+/* ----- Functions ----- */
+
+bool VKReadAdapterProfile(const char* filename, VKAdapterProfile& outProfile)
+{
+    std::ifstream file{ filename, std::ios::binary };
+    if (!file.good())
+        return false;
+
+    /* Validate header */
+    ProfileFileHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        return false;
+
+    if (std::memcmp(header.magic, g_profileFileMagic, sizeof(g_profileFileMagic)) != 0 ||
+        header.version          != g_profileFileVersion ||
+        header.headerVersion    != VK_HEADER_VERSION    ||
+        header.deviceIndex      < 0)
+    {
+        return false;
+    }
+
+    /* Read layer and extension properties */
+    VKAdapterProfile profile;
+    {
+        profile.deviceIndex     = header.deviceIndex;
+        profile.vendorID        = header.vendorID;
+        profile.deviceID        = header.deviceID;
+        profile.driverVersion   = header.driverVersion;
+        std::memcpy(profile.pipelineCacheUUID, header.pipelineCacheUUID, VK_UUID_SIZE);
+    }
+
+    if (!ReadArray(file, profile.instanceLayers, header.numInstanceLayers) ||
+        !ReadArray(file, profile.instanceExtensions, header.numInstanceExtensions) ||
+        !ReadArray(file, profile.deviceExtensions, header.numDeviceExtensions))
+    {
+        return false;
+    }
+
+    outProfile = std::move(profile);
+
+    return true;
+}
+
+bool VKWriteAdapterProfile(const char* filename, const VKAdapterProfile& profile)
+{
+    std::ofstream file{ filename, std::ios::binary | std::ios::trunc };
+    if (!file.good())
+        return false;
+
+    ProfileFileHeader header;
+    {
+        std::memcpy(header.magic, g_profileFileMagic, sizeof(g_profileFileMagic));
+        header.version                  = g_profileFileVersion;
+        header.headerVersion            = VK_HEADER_VERSION;
+        header.deviceIndex              = profile.deviceIndex;
+        header.vendorID                 = profile.vendorID;
+        header.deviceID                 = profile.deviceID;
+        header.driverVersion            = profile.driverVersion;
+        std::memcpy(header.pipelineCacheUUID, profile.pipelineCacheUUID, VK_UUID_SIZE);
+        header.numInstanceLayers        = static_cast<std::uint32_t>(profile.instanceLayers.size());
+        header.numInstanceExtensions    = static_cast<std::uint32_t>(profile.instanceExtensions.size());
+        header.numDeviceExtensions      = static_cast<std::uint32_t>(profile.deviceExtensions.size());
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    WriteArray(file, profile.instanceLayers);
+    WriteArray(file, profile.instanceExtensions);
+    WriteArray(file, profile.deviceExtensions);
+
+    return file.good();
+}
+
+bool VKMatchesAdapterProfile(VkPhysicalDevice physicalDevice, const VKAdapterProfile& profile)
+{
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+    return
+    (
+        properties.vendorID         == profile.vendorID         &&
+        properties.deviceID         == profile.deviceID         &&
+        properties.driverVersion    == profile.driverVersion    &&
+        std::memcmp(properties.pipelineCacheUUID, profile.pipelineCacheUUID, VK_UUID_SIZE) == 0
+    );
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
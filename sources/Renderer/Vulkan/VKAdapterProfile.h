@@ -0,0 +1,57 @@
+/*
+ * VKAdapterProfile.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_ADAPTER_PROFILE_H
+#define LLGL_VK_ADAPTER_PROFILE_H
+
+
+#include "Vulkan.h"
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Results of the layer and extension enumeration of a previous run (see RendererConfigurationVulkan::adapterProfileFilename).
+All supported layers and extensions are stored, not only the enabled ones, so the selection of enabled layers and extensions
+is still determined by the current renderer configuration.
+*/
+struct VKAdapterProfile
+{
+    std::vector<VkLayerProperties>      instanceLayers;
+    std::vector<VkExtensionProperties>  instanceExtensions;
+
+    std::int32_t                        deviceIndex                         = -1;   // Index of the physical device in the order of vkEnumeratePhysicalDevices, or -1 if there is no device.
+    std::uint32_t                       vendorID                            = 0;
+    std::uint32_t                       deviceID                            = 0;
+    std::uint32_t                       driverVersion                       = 0;
+    std::uint8_t                        pipelineCacheUUID[VK_UUID_SIZE]     = {};
+    std::vector<VkExtensionProperties>  deviceExtensions;
+};
+
+
+// Reads the adapter profile from file. Returns false if the file does not exist or was written by a different version.
+bool VKReadAdapterProfile(const char* filename, VKAdapterProfile& outProfile);
+
+// Writes the adapter profile to file. Returns false if the file could not be written.
+bool VKWriteAdapterProfile(const char* filename, const VKAdapterProfile& profile);
+
+// Returns true if the specified physical device has the same identity as the device in the adapter profile.
+bool VKMatchesAdapterProfile(VkPhysicalDevice physicalDevice, const VKAdapterProfile& profile);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -15,6 +15,7 @@
 #include "RenderState/VKRenderPass.h"
 #include "RenderState/VKGraphicsPSO.h"
 #include "RenderState/VKComputePSO.h"
+#include "RenderState/VKPipelineLayout.h"
 #include "RenderState/VKResourceHeap.h"
 #include "RenderState/VKPredicateQueryHeap.h"
 #include "Texture/VKSampler.h"
@@ -22,11 +23,18 @@
 #include "Texture/VKRenderTarget.h"
 #include "Buffer/VKBuffer.h"
 #include "Buffer/VKBufferArray.h"
+#include "Buffer/VKStagingBufferPool.h"
+#include "Buffer/VKReadbackPool.h"
+#include "Memory/VKDeviceMemory.h"
 #include "../CheckedCast.h"
 #include "../../Core/Exception.h"
+#include "../../Core/Helper.h"
 #include <LLGL/StaticLimits.h>
 #include <LLGL/TypeInfo.h>
+#include <LLGL/Container/SmallVector.h>
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 
 
 namespace LLGL
@@ -42,6 +50,9 @@ static std::uint32_t GetMaxDrawIndirectCount(const VKPhysicalDevice& physicalDev
         return 1u;
 }
 
+// Size (in bytes) of each host-visible block of indirect arguments for patchable draw commands
+static const VkDeviceSize g_patchBlockSize = 4096;
+
 // Returns the number of native command buffers for the specified descriptor
 static std::uint32_t GetNumVkCommandBuffers(const CommandBufferDescriptor& desc)
 {
@@ -51,18 +62,34 @@ static std::uint32_t GetNumVkCommandBuffers(const CommandBufferDescriptor& desc)
         return std::max(1u, desc.numNativeBuffers);
 }
 
+// Returns the maximum number of native command buffers the ring can grow to for the specified descriptor
+static std::uint32_t GetMaxNumVkCommandBuffers(const CommandBufferDescriptor& desc)
+{
+    if ((desc.flags & CommandBufferFlags::MultiSubmit) != 0)
+        return 1u;
+    else
+        return std::max(GetNumVkCommandBuffers(desc), desc.maxNativeBuffers);
+}
+
 VKCommandBuffer::VKCommandBuffer(
     const VKPhysicalDevice&         physicalDevice,
     VKDevice&                       device,
     VkQueue                         commandQueue,
     const QueueFamilyIndices&       queueFamilyIndices,
+    VKStagingBufferPool&            stagingBufferPool,
+    VKReadbackPool&                 readbackPool,
     const CommandBufferDescriptor&  desc)
 :
-    device_               { device                                  },
-    commandQueue_         { commandQueue                            },
-    commandPool_          { device, vkDestroyCommandPool            },
-    queuePresentFamily_   { queueFamilyIndices.presentFamily        },
-    maxDrawIndirectCount_ { GetMaxDrawIndirectCount(physicalDevice) }
+    device_                 { device                                  },
+    commandQueue_           { commandQueue                            },
+    stagingBufferPool_      { stagingBufferPool                       },
+    readbackPool_           { readbackPool                            },
+    commandPool_            { device, vkDestroyCommandPool            },
+    maxNumCommandBuffers_   { GetMaxNumVkCommandBuffers(desc)         },
+    queuePresentFamily_     { queueFamilyIndices.presentFamily        },
+    maxDrawIndirectCount_   { GetMaxDrawIndirectCount(physicalDevice) },
+    inheritedRenderTarget_  { desc.renderTarget                       },
+    memoryProperties_       { physicalDevice.GetMemoryProperties()    }
 {
     /* Translate creation flags */
     if ((desc.flags & CommandBufferFlags::ImmediateSubmit) != 0)
@@ -77,6 +104,8 @@ VKCommandBuffer::VKCommandBuffer(
 
         if ((desc.flags & CommandBufferFlags::Secondary) != 0)
             usageFlags_ |= VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+        if ((desc.flags & CommandBufferFlags::Secondary) != 0 && desc.renderTarget != nullptr)
+            usageFlags_ |= VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
         if ((desc.flags & CommandBufferFlags::MultiSubmit) == 0)
             usageFlags_ |= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
     }
@@ -84,10 +113,20 @@ VKCommandBuffer::VKCommandBuffer(
     /* Determine number of internal command buffers */
     const auto bufferCount = GetNumVkCommandBuffers(desc);
 
-    /* Create native command buffer objects */
-    CreateCommandPool(queueFamilyIndices.graphicsFamily);
+    /* Create native command buffer objects; command buffers for the asynchronous compute queue must be allocated from its queue family */
+    const bool isComputeCmdBuffer =
+    (
+        (desc.flags & CommandBufferFlags::ComputeQueue) != 0 &&
+        queueFamilyIndices.computeFamily != QueueFamilyIndices::invalidIndex
+    );
+    CreateCommandPool(isComputeCmdBuffer ? queueFamilyIndices.computeFamily : queueFamilyIndices.graphicsFamily);
+
+    /* Fragment shading rates can only be recorded for graphics queues */
+    hasFragmentShadingRate_ = (!isComputeCmdBuffer && HasExtension(VKExt::KHR_fragment_shading_rate));
+
     CreateCommandBuffers(bufferCount);
-    CreateRecordingFences(commandQueue, bufferCount);
+    CreateRecordingFences(bufferCount);
+    patchBlockLists_.resize(bufferCount);
 
     /* Acquire first native command buffer */
     AcquireNextBuffer();
@@ -103,16 +142,69 @@ VKCommandBuffer::~VKCommandBuffer()
     );
 }
 
+VKCommandBuffer::VKPatchBlock::VKPatchBlock(const VKPtr<VkDevice>& device) :
+    buffer { device }
+{
+}
+
+VKCommandBuffer::VKPatchBlock::~VKPatchBlock()
+{
+    // dummy; required to destroy the device memory with its complete type
+}
+
 /* ----- Encoding ----- */
 
 void VKCommandBuffer::Begin()
 {
-    /* Use next internal VkCommandBuffer object to reduce latency */
+    /* Use next available internal VkCommandBuffer object to reduce latency */
     AcquireNextBuffer();
 
-    /* Wait for fence before recording */
-    vkWaitForFences(device_, 1, &recordingFence_, VK_TRUE, UINT64_MAX);
-    vkResetFences(device_, 1, &recordingFence_);
+    /* Reset draw command skipping of pending PSOs from previous recording */
+    skipDraws_      = false;
+    skipDispatches_ = false;
+
+    /* Reset pipeline layout for push constants from previous recording */
+    boundPipelineLayout_ = nullptr;
+
+    /* Reset patch slots; the patch blocks of this native command buffer are no longer in use by the GPU */
+    numPatchBlocks_     = 0;
+    patchBlockOffset_   = 0;
+    patchSlots_.clear();
+
+    /* Specify inheritance for secondary command buffers, which continue the render pass of the specified render target */
+    VkCommandBufferInheritanceInfo inheritanceInfo;
+    {
+        inheritanceInfo.sType                   = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritanceInfo.pNext                   = nullptr;
+        inheritanceInfo.renderPass              = VK_NULL_HANDLE;
+        inheritanceInfo.subpass                 = 0;
+        inheritanceInfo.framebuffer             = VK_NULL_HANDLE;
+        inheritanceInfo.occlusionQueryEnable    = VK_FALSE;
+        inheritanceInfo.queryFlags              = 0;
+        inheritanceInfo.pipelineStatistics      = 0;
+    }
+
+    VkCommandBufferInheritanceRenderingInfoKHR renderingInheritanceInfo;
+
+    if (inheritedRenderTarget_ != nullptr)
+    {
+        StoreFramebufferAttributes(*inheritedRenderTarget_);
+
+        if (dynamicRenderTarget_ != nullptr)
+        {
+            /* Secondary command buffers for dynamic rendering only inherit the attachment formats */
+            dynamicRenderTarget_->GetInheritanceRenderingInfo(renderingInheritanceInfo);
+            inheritanceInfo.pNext = &renderingInheritanceInfo;
+        }
+        else
+        {
+            inheritanceInfo.renderPass = renderPass_;
+
+            /* Framebuffers of swap-chains change with each frame, so only the framebuffer of render targets is known in advance */
+            if (!LLGL::IsInstanceOf<SwapChain>(*inheritedRenderTarget_))
+                inheritanceInfo.framebuffer = framebuffer_;
+        }
+    }
 
     /* Begin recording of current command buffer */
     VkCommandBufferBeginInfo beginInfo;
@@ -120,22 +212,33 @@ void VKCommandBuffer::Begin()
         beginInfo.sType             = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
         beginInfo.pNext             = nullptr;
         beginInfo.flags             = usageFlags_;
-        beginInfo.pInheritanceInfo  = nullptr;
+        beginInfo.pInheritanceInfo  = (bufferLevel_ == VK_COMMAND_BUFFER_LEVEL_SECONDARY ? &inheritanceInfo : nullptr);
     }
     auto result = vkBeginCommandBuffer(commandBuffer_, &beginInfo);
     VKThrowIfFailed(result, "failed to begin Vulkan command buffer");
 
+    /* Resource states and executed secondary command buffers are tracked per recording */
+    resourceStateTracker_.Reset();
+    executedCommandBuffers_.clear();
+
     #if 0//TODO: optimize
     /* Reset all query pools that were in flight during last encoding */
     ResetQueryPoolsInFlight();
     #endif
 
     /* Store new record state */
-    recordState_ = RecordState::OutsideRenderPass;
+    recordState_ = (inheritedRenderTarget_ != nullptr ? RecordState::InsideRenderPass : RecordState::OutsideRenderPass);
+
+    /* All graphics PSOs have a dynamic fragment shading rate if supported, so it must be initialized with each recording */
+    if (hasFragmentShadingRate_)
+        SetFragmentShadingRate(VkExtent2D{ 1, 1 });
 }
 
 void VKCommandBuffer::End()
 {
+    /* Transition all resources back into their default state */
+    RestoreResourceStates();
+
     /* End encoding of current command buffer */
     auto result = vkEndCommandBuffer(commandBuffer_);
     VKThrowIfFailed(result, "failed to end Vulkan command buffer");
@@ -146,16 +249,33 @@ void VKCommandBuffer::End()
     /* Execute command buffer right after encoding for immediate command buffers */
     if (IsImmediateCmdBuffer())
     {
-        auto result = VKSubmitCommandBuffer(commandQueue_, commandBuffer_, GetQueueSubmitFence());
+        stagingBufferPool_.Flush();
+        auto result = VKSubmitCommandBuffer(commandQueue_, commandBuffer_, AcquireQueueSubmitFence());
         VKThrowIfFailed(result, "failed to submit command buffer to Vulkan graphics queue");
     }
 }
 
+std::uint32_t VKCommandBuffer::QueryBeginStalls()
+{
+    const std::uint32_t numStalls = numBeginStalls_;
+    numBeginStalls_ = 0;
+    return numStalls;
+}
+
 void VKCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
 {
     auto& cmdBufferVK = LLGL_CAST(VKCommandBuffer&, deferredCommandBuffer);
+    RestoreResourceStates();
+
+    /* Secondary command buffers can only be executed in a render pass that has been started for secondary command buffers */
+    if (recordState_ == RecordState::RenderPassPending)
+        BeginPendingRenderPass(VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
     VkCommandBuffer cmdBuffers[] = { cmdBufferVK.GetVkCommandBuffer() };
     vkCmdExecuteCommands(commandBuffer_, 1, cmdBuffers);
+
+    /* Keep track of secondary command buffer to bind the submission fence of this command buffer */
+    executedCommandBuffers_.push_back(&cmdBufferVK);
 }
 
 /* ----- Blitting ----- */
@@ -171,18 +291,52 @@ void VKCommandBuffer::UpdateBuffer(
     auto size   = static_cast<VkDeviceSize>(dataSize);
     auto offset = static_cast<VkDeviceSize>(dstOffset);
 
-    if (IsInsideRenderPass())
+    const bool renderPassPaused = BeginTransfer();
     {
-        PauseRenderPass();
+        FlushBufferBarrier(dstBufferVK.GetVkBuffer());
         vkCmdUpdateBuffer(commandBuffer_, dstBufferVK.GetVkBuffer(), offset, size, data);
         BufferPipelineBarrier(dstBufferVK.GetVkBuffer(), offset, size);
-        ResumeRenderPass();
     }
-    else
+    EndTransfer(renderPassPaused);
+}
+
+void VKCommandBuffer::UpdateBuffer(
+    Buffer&                     dstBuffer,
+    std::uint32_t               numRegions,
+    const BufferWriteRegion*    regions)
+{
+    if (numRegions == 0)
+        return;
+
+    auto& dstBufferVK = LLGL_CAST(VKBuffer&, dstBuffer);
+
+    /* Pause render pass and flush pending barriers only once for all regions */
+    VkDeviceSize rangeBegin = ~0ull;
+    VkDeviceSize rangeEnd   = 0;
+
+    const bool renderPassPaused = BeginTransfer();
     {
-        vkCmdUpdateBuffer(commandBuffer_, dstBufferVK.GetVkBuffer(), offset, size, data);
-        BufferPipelineBarrier(dstBufferVK.GetVkBuffer(), offset, size);
+        FlushBufferBarrier(dstBufferVK.GetVkBuffer());
+
+        for (std::uint32_t i = 0; i < numRegions; ++i)
+        {
+            auto size   = static_cast<VkDeviceSize>(regions[i].dataSize);
+            auto offset = static_cast<VkDeviceSize>(regions[i].dstOffset);
+
+            if (size == 0)
+                continue;
+
+            vkCmdUpdateBuffer(commandBuffer_, dstBufferVK.GetVkBuffer(), offset, size, regions[i].data);
+
+            rangeBegin  = std::min(rangeBegin, offset);
+            rangeEnd    = std::max(rangeEnd, offset + size);
+        }
+
+        /* Insert a single barrier for the range that covers all regions */
+        if (rangeBegin < rangeEnd)
+            BufferPipelineBarrier(dstBufferVK.GetVkBuffer(), rangeBegin, rangeEnd - rangeBegin);
     }
+    EndTransfer(renderPassPaused);
 }
 
 void VKCommandBuffer::CopyBuffer(
@@ -202,14 +356,65 @@ void VKCommandBuffer::CopyBuffer(
         region.size         = static_cast<VkDeviceSize>(size);
     }
 
-    if (IsInsideRenderPass())
+    const bool renderPassPaused = BeginTransfer();
     {
-        PauseRenderPass();
+        FlushBufferBarrier(srcBufferVK.GetVkBuffer());
+        FlushBufferBarrier(dstBufferVK.GetVkBuffer());
         vkCmdCopyBuffer(commandBuffer_, srcBufferVK.GetVkBuffer(), dstBufferVK.GetVkBuffer(), 1, &region);
-        ResumeRenderPass();
+        BufferPipelineBarrier(dstBufferVK.GetVkBuffer(), region.dstOffset, region.size);
     }
-    else
-        vkCmdCopyBuffer(commandBuffer_, srcBufferVK.GetVkBuffer(), dstBufferVK.GetVkBuffer(), 1, &region);
+    EndTransfer(renderPassPaused);
+}
+
+void VKCommandBuffer::CopyBuffer(
+    Buffer&                     dstBuffer,
+    Buffer&                     srcBuffer,
+    std::uint32_t               numRegions,
+    const BufferCopyRegion*     regions)
+{
+    if (numRegions == 0)
+        return;
+
+    auto& dstBufferVK = LLGL_CAST(VKBuffer&, dstBuffer);
+    auto& srcBufferVK = LLGL_CAST(VKBuffer&, srcBuffer);
+
+    SmallVector<VkBufferCopy, 16> regionsVK;
+    regionsVK.reserve(numRegions);
+
+    VkDeviceSize rangeBegin = ~0ull;
+    VkDeviceSize rangeEnd   = 0;
+
+    for (std::uint32_t i = 0; i < numRegions; ++i)
+    {
+        if (regions[i].size == 0)
+            continue;
+
+        VkBufferCopy region;
+        {
+            region.srcOffset    = static_cast<VkDeviceSize>(regions[i].srcOffset);
+            region.dstOffset    = static_cast<VkDeviceSize>(regions[i].dstOffset);
+            region.size         = static_cast<VkDeviceSize>(regions[i].size);
+        }
+        regionsVK.push_back(region);
+
+        rangeBegin  = std::min(rangeBegin, region.dstOffset);
+        rangeEnd    = std::max(rangeEnd, region.dstOffset + region.size);
+    }
+
+    if (regionsVK.empty())
+        return;
+
+    /* Pause render pass and flush pending barriers only once for all regions */
+    const bool renderPassPaused = BeginTransfer();
+    {
+        FlushBufferBarrier(srcBufferVK.GetVkBuffer());
+        FlushBufferBarrier(dstBufferVK.GetVkBuffer());
+        vkCmdCopyBuffer(commandBuffer_, srcBufferVK.GetVkBuffer(), dstBufferVK.GetVkBuffer(), static_cast<std::uint32_t>(regionsVK.size()), regionsVK.data());
+
+        /* Insert a single barrier for the range that covers all regions */
+        BufferPipelineBarrier(dstBufferVK.GetVkBuffer(), rangeBegin, rangeEnd - rangeBegin);
+    }
+    EndTransfer(renderPassPaused);
 }
 
 void VKCommandBuffer::CopyBufferFromTexture(
@@ -236,14 +441,81 @@ void VKCommandBuffer::CopyBufferFromTexture(
         region.imageExtent                      = VKTypes::ToVkExtent(srcRegion.extent);
     }
 
-    if (IsInsideRenderPass())
+    const bool renderPassPaused = BeginTransfer();
     {
-        PauseRenderPass();
+        resourceStateTracker_.TransitionTexture(srcTextureVK, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_ACCESS_TRANSFER_READ_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+        resourceStateTracker_.FlushBarriers(commandBuffer_);
         device_.CopyImageToBuffer(commandBuffer_, srcTextureVK, dstBufferVK, region);
-        ResumeRenderPass();
+        BufferPipelineBarrier(dstBufferVK.GetVkBuffer(), region.bufferOffset, VK_WHOLE_SIZE);
     }
-    else
-        device_.CopyImageToBuffer(commandBuffer_, srcTextureVK, dstBufferVK, region);
+    EndTransfer(renderPassPaused);
+}
+
+std::uint64_t VKCommandBuffer::CopyBufferToReadback(Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size)
+{
+    auto& srcBufferVK = LLGL_CAST(VKBuffer&, srcBuffer);
+
+    ReadbackLayout layout;
+    {
+        layout.size = size;
+    }
+    VkBuffer readbackBuffer = VK_NULL_HANDLE;
+    const auto ticket = readbackPool_.Allocate(layout, readbackBuffer);
+
+    VkBufferCopy region;
+    {
+        region.srcOffset    = static_cast<VkDeviceSize>(srcOffset);
+        region.dstOffset    = 0;
+        region.size         = static_cast<VkDeviceSize>(size);
+    }
+
+    const bool renderPassPaused = BeginTransfer();
+    {
+        FlushBufferBarrier(srcBufferVK.GetVkBuffer());
+        vkCmdCopyBuffer(commandBuffer_, srcBufferVK.GetVkBuffer(), readbackBuffer, 1, &region);
+        readbackPool_.RecordCompletion(commandBuffer_, ticket);
+    }
+    EndTransfer(renderPassPaused);
+
+    return ticket;
+}
+
+std::uint64_t VKCommandBuffer::CopyTextureToReadback(Texture& srcTexture, const TextureRegion& srcRegion)
+{
+    auto& srcTextureVK = LLGL_CAST(VKTexture&, srcTexture);
+
+    /* Texels are tightly packed in the readback buffer, array layers and depth slices are stored one after another */
+    const auto format       = VKTypes::Unmap(srcTextureVK.GetVkFormat());
+    const auto& extent      = srcRegion.extent;
+    const auto  numLayers   = extent.depth * srcRegion.subresource.numArrayLayers;
+
+    ReadbackLayout layout;
+    {
+        layout.rowStride    = GetMemoryFootprint(format, extent.width);
+        layout.layerStride  = layout.rowStride * extent.height;
+        layout.size         = static_cast<std::uint64_t>(layout.layerStride) * numLayers;
+    }
+    VkBuffer readbackBuffer = VK_NULL_HANDLE;
+    const auto ticket = readbackPool_.Allocate(layout, readbackBuffer);
+
+    const bool renderPassPaused = BeginTransfer();
+    {
+        resourceStateTracker_.TransitionTexture(srcTextureVK, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_ACCESS_TRANSFER_READ_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+        resourceStateTracker_.FlushBarriers(commandBuffer_);
+        device_.CopyImageToBuffer(
+            commandBuffer_,
+            srcTextureVK.GetVkImage(),
+            readbackBuffer,
+            srcTextureVK.GetVkFormat(),
+            VKTypes::ToVkOffset(srcRegion.offset),
+            VKTypes::ToVkExtent(extent),
+            srcRegion.subresource
+        );
+        readbackPool_.RecordCompletion(commandBuffer_, ticket);
+    }
+    EndTransfer(renderPassPaused);
+
+    return ticket;
 }
 
 void VKCommandBuffer::FillBuffer(
@@ -268,14 +540,13 @@ void VKCommandBuffer::FillBuffer(
     }
 
     /* Encode fill buffer command */
-    if (IsInsideRenderPass())
+    const bool renderPassPaused = BeginTransfer();
     {
-        PauseRenderPass();
+        FlushBufferBarrier(dstBufferVK.GetVkBuffer());
         vkCmdFillBuffer(commandBuffer_, dstBufferVK.GetVkBuffer(), offset, size, value);
-        ResumeRenderPass();
+        BufferPipelineBarrier(dstBufferVK.GetVkBuffer(), offset, size);
     }
-    else
-        vkCmdFillBuffer(commandBuffer_, dstBufferVK.GetVkBuffer(), offset, size, value);
+    EndTransfer(renderPassPaused);
 }
 
 void VKCommandBuffer::CopyTexture(
@@ -285,32 +556,64 @@ void VKCommandBuffer::CopyTexture(
     const TextureLocation&  srcLocation,
     const Extent3D&         extent)
 {
+    const TextureCopyRegion region{ dstLocation, srcLocation, extent };
+    CopyTexture(dstTexture, srcTexture, 1, &region);
+}
+
+void VKCommandBuffer::CopyTexture(
+    Texture&                    dstTexture,
+    Texture&                    srcTexture,
+    std::uint32_t               numRegions,
+    const TextureCopyRegion*    regions)
+{
+    if (numRegions == 0)
+        return;
+
     auto& dstTextureVK = LLGL_CAST(VKTexture&, dstTexture);
     auto& srcTextureVK = LLGL_CAST(VKTexture&, srcTexture);
 
-    VkImageCopy region;
+    /* Convert all regions, so they can be encoded with a single copy command */
+    SmallVector<VkImageCopy, 16> regionsVK;
+    regionsVK.resize(numRegions);
+
+    for (std::uint32_t i = 0; i < numRegions; ++i)
     {
-        region.srcSubresource.aspectMask        = srcTextureVK.GetAspectFlags();
-        region.srcSubresource.mipLevel          = srcLocation.mipLevel;
-        region.srcSubresource.baseArrayLayer    = srcLocation.arrayLayer;
-        region.srcSubresource.layerCount        = 1;
-        region.srcOffset                        = VKTypes::ToVkOffset(srcLocation.offset);
-        region.dstSubresource.aspectMask        = dstTextureVK.GetAspectFlags();
-        region.dstSubresource.mipLevel          = dstLocation.mipLevel;
-        region.dstSubresource.baseArrayLayer    = dstLocation.arrayLayer;
-        region.dstSubresource.layerCount        = 1;
-        region.dstOffset                        = VKTypes::ToVkOffset(dstLocation.offset);
-        region.extent                           = VKTypes::ToVkExtent(extent);
+        const auto& srcLocation = regions[i].srcLocation;
+        const auto& dstLocation = regions[i].dstLocation;
+        auto& region = regionsVK[i];
+        {
+            region.srcSubresource.aspectMask        = srcTextureVK.GetAspectFlags();
+            region.srcSubresource.mipLevel          = srcLocation.mipLevel;
+            region.srcSubresource.baseArrayLayer    = srcLocation.arrayLayer;
+            region.srcSubresource.layerCount        = 1;
+            region.srcOffset                        = VKTypes::ToVkOffset(srcLocation.offset);
+            region.dstSubresource.aspectMask        = dstTextureVK.GetAspectFlags();
+            region.dstSubresource.mipLevel          = dstLocation.mipLevel;
+            region.dstSubresource.baseArrayLayer    = dstLocation.arrayLayer;
+            region.dstSubresource.layerCount        = 1;
+            region.dstOffset                        = VKTypes::ToVkOffset(dstLocation.offset);
+            region.extent                           = VKTypes::ToVkExtent(regions[i].extent);
+        }
     }
 
-    if (IsInsideRenderPass())
+    const bool renderPassPaused = BeginTransfer();
     {
-        PauseRenderPass();
-        device_.CopyTexture(commandBuffer_, srcTextureVK, dstTextureVK, region);
-        ResumeRenderPass();
+        if (&srcTextureVK == &dstTextureVK)
+        {
+            /* Copy between subresources of the same texture must use the general layout */
+            resourceStateTracker_.TransitionTexture(dstTextureVK, VK_IMAGE_LAYOUT_GENERAL, VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+            resourceStateTracker_.FlushBarriers(commandBuffer_);
+            device_.CopyTexture(commandBuffer_, srcTextureVK, dstTextureVK, numRegions, regionsVK.data(), VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL);
+        }
+        else
+        {
+            resourceStateTracker_.TransitionTexture(srcTextureVK, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_ACCESS_TRANSFER_READ_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+            resourceStateTracker_.TransitionTexture(dstTextureVK, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+            resourceStateTracker_.FlushBarriers(commandBuffer_);
+            device_.CopyTexture(commandBuffer_, srcTextureVK, dstTextureVK, numRegions, regionsVK.data());
+        }
     }
-    else
-        device_.CopyTexture(commandBuffer_, srcTextureVK, dstTextureVK, region);
+    EndTransfer(renderPassPaused);
 }
 
 void VKCommandBuffer::CopyTextureFromBuffer(
@@ -337,24 +640,25 @@ void VKCommandBuffer::CopyTextureFromBuffer(
         region.imageExtent                      = VKTypes::ToVkExtent(dstRegion.extent);
     }
 
-    if (IsInsideRenderPass())
+    const bool renderPassPaused = BeginTransfer();
     {
-        PauseRenderPass();
+        resourceStateTracker_.TransitionTexture(dstTextureVK, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+        resourceStateTracker_.FlushBarriers(commandBuffer_);
         device_.CopyBufferToImage(commandBuffer_, srcBufferVK, dstTextureVK, region);
-        ResumeRenderPass();
     }
-    else
-        device_.CopyBufferToImage(commandBuffer_, srcBufferVK, dstTextureVK, region);
+    EndTransfer(renderPassPaused);
 }
 
 void VKCommandBuffer::GenerateMips(Texture& texture)
 {
     auto& textureVK = LLGL_CAST(VKTexture&, texture);
+
+    /* MIP-map generation expects the texture in its default layout */
+    RestoreResourceStates();
+
     device_.GenerateMips(
         commandBuffer_,
-        textureVK.GetVkImage(),
-        textureVK.GetVkFormat(),
-        textureVK.GetVkExtent(),
+        textureVK,
         TextureSubresource{ 0, textureVK.GetNumArrayLayers(), 0, textureVK.GetNumMipLevels() }
     );
 }
@@ -369,13 +673,10 @@ void VKCommandBuffer::GenerateMips(Texture& texture, const TextureSubresource& s
     if (subresource.baseMipLevel   < maxNumMipLevels   && subresource.numMipLevels   > 0 &&
         subresource.baseArrayLayer < maxNumArrayLayers && subresource.numArrayLayers > 0)
     {
-        device_.GenerateMips(
-            commandBuffer_,
-            textureVK.GetVkImage(),
-            textureVK.GetVkFormat(),
-            textureVK.GetVkExtent(),
-            subresource
-        );
+        /* MIP-map generation expects the texture in its default layout */
+        RestoreResourceStates();
+
+        device_.GenerateMips(commandBuffer_, textureVK, subresource);
     }
 }
 
@@ -467,9 +768,10 @@ void VKCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::u
 
 //private
 void VKCommandBuffer::BindResourceHeap(
-    VKResourceHeap&     resourceHeapVK,
-    std::uint32_t       descriptorSet,
-    VkPipelineBindPoint pipelineBindPoint)
+    VKResourceHeap&         resourceHeapVK,
+    std::uint32_t           descriptorSet,
+    VkPipelineBindPoint     pipelineBindPoint,
+    const std::uint32_t*    dynamicOffsets)
 {
     const VkDescriptorSet descriptorSets[1] = { resourceHeapVK.GetVkDescriptorSets()[descriptorSet] };
     vkCmdBindDescriptorSets(
@@ -479,36 +781,66 @@ void VKCommandBuffer::BindResourceHeap(
         0,                                      // First set in SPIR-V (always 0 atm.)
         1,                                      // Number of descriptor sets (always 1 atm.)
         descriptorSets,                         // Descriptor sets
-        0,                                      // No dynamic offsets
-        nullptr
+        resourceHeapVK.GetNumDynamicOffsets(),  // One dynamic offset per dynamic descriptor
+        dynamicOffsets
     );
 }
 
-void VKCommandBuffer::SetResourceHeap(
-    ResourceHeap&           resourceHeap,
+void VKCommandBuffer::BindResourceHeapToPipelines(
+    VKResourceHeap&         resourceHeapVK,
     std::uint32_t           descriptorSet,
-    const PipelineBindPoint bindPoint)
+    const PipelineBindPoint bindPoint,
+    const std::uint32_t*    dynamicOffsets)
 {
-    auto& resourceHeapVK = LLGL_CAST(VKResourceHeap&, resourceHeap);
-
     /* Bind resource heap to pipelines */
     if (bindPoint == PipelineBindPoint::Undefined)
     {
         if (resourceHeapVK.GetBindPoint() == VK_PIPELINE_BIND_POINT_MAX_ENUM)
         {
-            BindResourceHeap(resourceHeapVK, descriptorSet, VK_PIPELINE_BIND_POINT_GRAPHICS);
-            BindResourceHeap(resourceHeapVK, descriptorSet, VK_PIPELINE_BIND_POINT_COMPUTE);
+            BindResourceHeap(resourceHeapVK, descriptorSet, VK_PIPELINE_BIND_POINT_GRAPHICS, dynamicOffsets);
+            BindResourceHeap(resourceHeapVK, descriptorSet, VK_PIPELINE_BIND_POINT_COMPUTE, dynamicOffsets);
         }
         else
-            BindResourceHeap(resourceHeapVK, descriptorSet, resourceHeapVK.GetBindPoint());
+            BindResourceHeap(resourceHeapVK, descriptorSet, resourceHeapVK.GetBindPoint(), dynamicOffsets);
     }
     else
-        BindResourceHeap(resourceHeapVK, descriptorSet, VKTypes::Map(bindPoint));
+        BindResourceHeap(resourceHeapVK, descriptorSet, VKTypes::Map(bindPoint), dynamicOffsets);
 
     /* Insert resource barrier into command buffer */
     resourceHeapVK.SubmitPipelineBarrier(commandBuffer_, descriptorSet);
 }
 
+void VKCommandBuffer::SetResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           descriptorSet,
+    const PipelineBindPoint bindPoint)
+{
+    SetResourceHeap(resourceHeap, descriptorSet, 0, nullptr, bindPoint);
+}
+
+void VKCommandBuffer::SetResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           descriptorSet,
+    std::uint32_t           numDynamicOffsets,
+    const std::uint32_t*    dynamicOffsets,
+    const PipelineBindPoint bindPoint)
+{
+    auto& resourceHeapVK = LLGL_CAST(VKResourceHeap&, resourceHeap);
+
+    /* Vulkan requires exactly one dynamic offset per dynamic descriptor, so fill up missing offsets with zeros */
+    const auto numRequiredOffsets = resourceHeapVK.GetNumDynamicOffsets();
+    if (numDynamicOffsets < numRequiredOffsets)
+    {
+        SmallVector<std::uint32_t, 8> paddedOffsets;
+        paddedOffsets.resize(numRequiredOffsets, 0u);
+        if (dynamicOffsets != nullptr)
+            std::copy(dynamicOffsets, dynamicOffsets + numDynamicOffsets, paddedOffsets.begin());
+        BindResourceHeapToPipelines(resourceHeapVK, descriptorSet, bindPoint, paddedOffsets.data());
+    }
+    else
+        BindResourceHeapToPipelines(resourceHeapVK, descriptorSet, bindPoint, dynamicOffsets);
+}
+
 void VKCommandBuffer::SetResource(
     Resource&       /*resource*/,
     std::uint32_t   /*slot*/,
@@ -536,78 +868,69 @@ void VKCommandBuffer::BeginRenderPass(
     std::uint32_t       numClearValues,
     const ClearValue*   clearValues)
 {
-    if (LLGL::IsInstanceOf<SwapChain>(renderTarget))
-    {
-        /* Get Vulkan swap-chain object */
-        auto& swapChainVK = LLGL_CAST(VKSwapChain&, renderTarget);
-
-        /* Store information about framebuffer attachments */
-        renderPass_                     = swapChainVK.GetSwapChainRenderPass().GetVkRenderPass();
-        secondaryRenderPass_            = swapChainVK.GetSecondaryVkRenderPass();
-        framebuffer_                    = swapChainVK.GetVkFramebuffer();
-        framebufferRenderArea_.extent   = swapChainVK.GetVkExtent();
-        numColorAttachments_            = swapChainVK.GetNumColorAttachments();
-        hasDSVAttachment_               = (swapChainVK.HasDepthAttachment() || swapChainVK.HasStencilAttachment());
-    }
-    else
-    {
-        /* Get Vulkan render target object and store its extent for subsequent commands */
-        auto& renderTargetVK = LLGL_CAST(VKRenderTarget&, renderTarget);
-
-        /* Store information about framebuffer attachments */
-        renderPass_                     = renderTargetVK.GetVkRenderPass();
-        secondaryRenderPass_            = renderTargetVK.GetSecondaryVkRenderPass();
-        framebuffer_                    = renderTargetVK.GetVkFramebuffer();
-        framebufferRenderArea_.extent   = renderTargetVK.GetVkExtent();
-        numColorAttachments_            = renderTargetVK.GetNumColorAttachments();
-        hasDSVAttachment_               = (renderTargetVK.HasDepthAttachment() || renderTargetVK.HasStencilAttachment());
-    }
+    /* Store information about framebuffer attachments */
+    StoreFramebufferAttributes(renderTarget);
 
     scissorRectInvalidated_ = true;
 
-    /* Declare array or clear values */
-    VkClearValue clearValuesVK[LLGL_MAX_NUM_COLOR_ATTACHMENTS * 2 + 1];
-    std::uint32_t numClearValuesVK = 0;
-
     /* Get native render pass object either from RenderTarget or RenderPass interface */
+    numClearValues_ = 0;
+
     if (renderPass != nullptr)
     {
-        /* Get native VkRenderPass object */
         auto renderPassVK = LLGL_CAST(const VKRenderPass*, renderPass);
-        renderPass_ = renderPassVK->GetVkRenderPass();
-        ConvertRenderPassClearValues(*renderPassVK, numClearValuesVK, clearValuesVK, numClearValues, clearValues);
+        if (dynamicRenderTarget_ != nullptr)
+        {
+            /* Take load and store operations from render pass for dynamic rendering */
+            dynamicRenderPass_ = renderPassVK;
+            ConvertDynamicRenderingClearValues(*renderPassVK, clearValues_, numClearValues, clearValues);
+        }
+        else
+        {
+            /* Get native VkRenderPass object (render passes for dynamic rendering only provide their clear values) */
+            if (!renderPassVK->IsDynamicRendering())
+                renderPass_ = renderPassVK->GetVkRenderPass();
+            ConvertRenderPassClearValues(*renderPassVK, numClearValues_, clearValues_, numClearValues, clearValues);
+        }
     }
 
-    /* Record begin of render pass */
-    VkRenderPassBeginInfo beginInfo;
-    {
-        beginInfo.sType             = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        beginInfo.pNext             = nullptr;
-        beginInfo.renderPass        = renderPass_;
-        beginInfo.framebuffer       = framebuffer_;
-        beginInfo.renderArea        = framebufferRenderArea_;
-        beginInfo.clearValueCount   = numClearValuesVK;
-        beginInfo.pClearValues      = clearValuesVK;
-    }
-    vkCmdBeginRenderPass(commandBuffer_, &beginInfo, VK_SUBPASS_CONTENTS_INLINE);
+    /* Submit pending barriers, since they cannot be recorded inside the render pass */
+    RestoreResourceStates();
 
-    /* Store new record state */
-    recordState_ = RecordState::InsideRenderPass;
+    /*
+    Defer begin of render pass until the first command inside the render pass,
+    which determines whether the render pass contains inline commands or secondary command buffers
+    */
+    recordState_ = RecordState::RenderPassPending;
 }
 
 void VKCommandBuffer::EndRenderPass()
 {
-    /* Record and of render pass */
-    vkCmdEndRenderPass(commandBuffer_);
+    /* Record and of render pass (begin render pass first if it is still pending, e.g. for clear operations) */
+    FlushPendingRenderPass();
+    if (dynamicRenderTarget_ != nullptr)
+        dynamicRenderTarget_->EndRendering(commandBuffer_);
+    else
+        vkCmdEndRenderPass(commandBuffer_);
 
     /* Reset render pass and framebuffer attributes */
-    renderPass_     = VK_NULL_HANDLE;
-    framebuffer_    = VK_NULL_HANDLE;
+    renderPass_             = VK_NULL_HANDLE;
+    framebuffer_            = VK_NULL_HANDLE;
+    dynamicRenderTarget_    = nullptr;
+    dynamicRenderPass_      = nullptr;
 
     /* Store new record state */
     recordState_ = RecordState::OutsideRenderPass;
 }
 
+void VKCommandBuffer::NextSubpass()
+{
+    /* Dynamic rendering is only used for render targets without explicit render pass, which always have a single sub-pass */
+    FlushPendingRenderPass();
+    if (dynamicRenderTarget_ == nullptr)
+        vkCmdNextSubpass(commandBuffer_, subpassContents_);
+}
+
 static void ToVkClearColor(VkClearColorValue& dst, const ColorRGBAf& src)
 {
     dst.float32[0] = src.r;
@@ -665,6 +988,7 @@ void VKCommandBuffer::Clear(long flags, const ClearValue& clearValue)
     }
 
     /* Clear all framebuffer attachments */
+    FlushPendingRenderPass();
     ClearFramebufferAttachments(numAttachments, attachments);
 }
 
@@ -709,6 +1033,7 @@ void VKCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const Attac
         }
     }
 
+    FlushPendingRenderPass();
     ClearFramebufferAttachments(numAttachmentsVK, attachmentsVK);
 }
 
@@ -716,8 +1041,24 @@ void VKCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const Attac
 
 void VKCommandBuffer::SetPipelineState(PipelineState& pipelineState)
 {
-    /* Bind native PSO */
     auto& pipelineStateVK = LLGL_CAST(VKPipelineState&, pipelineState);
+
+    /* Store pipeline layout for push constants, which can be recorded even while the PSO is still pending */
+    boundPipelineLayout_ = pipelineStateVK.GetPipelineLayout();
+
+    /* Skip draw or dispatch commands while an asynchronously created PSO is pending, otherwise wait until it is ready */
+    const bool skipCommands = pipelineStateVK.SkipDraws();
+    if (pipelineStateVK.GetBindPoint() == VK_PIPELINE_BIND_POINT_GRAPHICS)
+        skipDraws_ = skipCommands;
+    else
+        skipDispatches_ = skipCommands;
+
+    if (skipCommands)
+        return;
+
+    pipelineStateVK.Wait();
+
+    /* Bind native PSO */
     vkCmdBindPipeline(commandBuffer_, pipelineStateVK.GetBindPoint(), pipelineStateVK.GetVkPipeline());
 
     /* Handle special case for graphics PSOs */
@@ -748,6 +1089,12 @@ void VKCommandBuffer::SetStencilReference(std::uint32_t reference, const Stencil
     vkCmdSetStencilReference(commandBuffer_, VKTypes::Map(stencilFace), reference);
 }
 
+void VKCommandBuffer::SetShadingRate(const ShadingRate rate)
+{
+    if (hasFragmentShadingRate_)
+        SetFragmentShadingRate(VKTypes::ToVkFragmentSize(rate));
+}
+
 void VKCommandBuffer::SetUniform(
     UniformLocation location,
     const void*     data,
@@ -758,11 +1105,35 @@ void VKCommandBuffer::SetUniform(
 
 void VKCommandBuffer::SetUniforms(
     UniformLocation location,
-    std::uint32_t   count,
+    std::uint32_t   /*count*/,
     const void*     data,
     std::uint32_t   dataSize)
 {
-    //TODO
+    if (boundPipelineLayout_ == nullptr || location < 0)
+        return;
+
+    auto first  = static_cast<std::uint32_t>(location) * 4;
+    auto size   = dataSize & ~3u;
+    auto bytes  = reinterpret_cast<const char*>(data);
+
+    /* Push constants for each range that overlaps with the specified range, since each update must include all stages of the affected ranges */
+    for (const auto& range : boundPipelineLayout_->GetPushConstantRanges())
+    {
+        if (size == 0)
+            break;
+
+        const auto end = range.offset + range.size;
+        if (first >= range.offset && first < end)
+        {
+            const auto rangeSize = std::min(size, end - first);
+
+            vkCmdPushConstants(commandBuffer_, boundPipelineLayout_->GetVkPipelineLayout(), range.stageFlags, first, rangeSize, bytes);
+
+            first   += rangeSize;
+            size    -= rangeSize;
+            bytes   += rangeSize;
+        }
+    }
 }
 
 /* ----- Queries ----- */
@@ -771,6 +1142,9 @@ void VKCommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
     auto& queryHeapVK = LLGL_CAST(VKQueryHeap&, queryHeap);
 
+    /* Query sections that start inside a render pass must also end inside of it */
+    FlushPendingRenderPass();
+
     query *= queryHeapVK.GetGroupSize();
 
     if (queryHeapVK.GetType() == QueryType::TimeElapsed)
@@ -814,6 +1188,21 @@ void VKCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
     #endif
 }
 
+void VKCommandBuffer::ResolveQueries(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries)
+{
+    auto& queryHeapVK = LLGL_CAST(VKQueryHeap&, queryHeap);
+
+    /* Query results can only be copied outside of a render pass */
+    if (IsInsideRenderPass())
+    {
+        PauseRenderPass();
+        queryHeapVK.ResolveToReadbackRing(commandBuffer_, firstQuery, numQueries);
+        ResumeRenderPass();
+    }
+    else
+        queryHeapVK.ResolveToReadbackRing(commandBuffer_, firstQuery, numQueries);
+}
+
 void VKCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
 {
     LLGL_ASSERT_VK_EXTENSION(VKExt::EXT_conditional_rendering, VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME);
@@ -874,6 +1263,7 @@ void VKCommandBuffer::SetStreamOutputBuffer(Buffer& buffer)
 void VKCommandBuffer::BeginStreamOutput(std::uint32_t numBuffers, Buffer* const * buffers)
 {
     LLGL_ASSERT_VK_EXTENSION(VKExt::EXT_transform_feedback, VK_EXT_TRANSFORM_FEEDBACK_EXTENSION_NAME);
+    FlushPendingRenderPass();
     //TODO: bind buffers
     vkCmdBeginTransformFeedbackEXT(commandBuffer_, 0, 0, nullptr, nullptr);
 }
@@ -888,52 +1278,92 @@ void VKCommandBuffer::EndStreamOutput()
 
 void VKCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
 {
+    if (skipDraws_)
+        return;
+
+    FlushPendingRenderPass();
     vkCmdDraw(commandBuffer_, numVertices, 1, firstVertex, 0);
 }
 
 void VKCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
 {
+    if (skipDraws_)
+        return;
+
+    FlushPendingRenderPass();
     vkCmdDrawIndexed(commandBuffer_, numIndices, 1, firstIndex, 0, 0);
 }
 
 void VKCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    if (skipDraws_)
+        return;
+
+    FlushPendingRenderPass();
     vkCmdDrawIndexed(commandBuffer_, numIndices, 1, firstIndex, vertexOffset, 0);
 }
 
 void VKCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
 {
+    if (skipDraws_)
+        return;
+
+    FlushPendingRenderPass();
     vkCmdDraw(commandBuffer_, numVertices, numInstances, firstVertex, 0);
 }
 
 void VKCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
 {
+    if (skipDraws_)
+        return;
+
+    FlushPendingRenderPass();
     vkCmdDraw(commandBuffer_, numVertices, numInstances, firstVertex, firstInstance);
 }
 
 void VKCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
 {
+    if (skipDraws_)
+        return;
+
+    FlushPendingRenderPass();
     vkCmdDrawIndexed(commandBuffer_, numIndices, numInstances, firstIndex, 0, 0);
 }
 
 void VKCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    if (skipDraws_)
+        return;
+
+    FlushPendingRenderPass();
     vkCmdDrawIndexed(commandBuffer_, numIndices, numInstances, firstIndex, vertexOffset, 0);
 }
 
 void VKCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
+    if (skipDraws_)
+        return;
+
+    FlushPendingRenderPass();
     vkCmdDrawIndexed(commandBuffer_, numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
 }
 
 void VKCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    if (skipDraws_)
+        return;
+
+    FlushPendingRenderPass();
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     vkCmdDrawIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset, 1, 0);
 }
 
 void VKCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    if (skipDraws_)
+        return;
+
+    FlushPendingRenderPass();
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     if (maxDrawIndirectCount_ < numCommands)
     {
@@ -952,12 +1382,20 @@ void VKCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::ui
 
 void VKCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    if (skipDraws_)
+        return;
+
+    FlushPendingRenderPass();
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     vkCmdDrawIndexedIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset, 1, 0);
 }
 
 void VKCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    if (skipDraws_)
+        return;
+
+    FlushPendingRenderPass();
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     if (maxDrawIndirectCount_ < numCommands)
     {
@@ -974,16 +1412,150 @@ void VKCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset,
         vkCmdDrawIndexedIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset, numCommands, stride);
 }
 
+void VKCommandBuffer::DrawIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride)
+{
+    if (skipDraws_)
+        return;
+
+    LLGL_ASSERT_VK_EXTENSION(VKExt::KHR_draw_indirect_count, VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+
+    FlushPendingRenderPass();
+    auto& bufferVK      = LLGL_CAST(VKBuffer&, buffer);
+    auto& countBufferVK = LLGL_CAST(VKBuffer&, countBuffer);
+    vkCmdDrawIndirectCountKHR(
+        commandBuffer_,
+        bufferVK.GetVkBuffer(),
+        offset,
+        countBufferVK.GetVkBuffer(),
+        countOffset,
+        maxNumCommands,
+        stride
+    );
+}
+
+void VKCommandBuffer::DrawIndexedIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride)
+{
+    if (skipDraws_)
+        return;
+
+    LLGL_ASSERT_VK_EXTENSION(VKExt::KHR_draw_indirect_count, VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+
+    FlushPendingRenderPass();
+    auto& bufferVK      = LLGL_CAST(VKBuffer&, buffer);
+    auto& countBufferVK = LLGL_CAST(VKBuffer&, countBuffer);
+    vkCmdDrawIndexedIndirectCountKHR(
+        commandBuffer_,
+        bufferVK.GetVkBuffer(),
+        offset,
+        countBufferVK.GetVkBuffer(),
+        countOffset,
+        maxNumCommands,
+        stride
+    );
+}
+
+std::uint32_t VKCommandBuffer::DrawPatchable(const DrawIndirectArguments& args)
+{
+    if (skipDraws_)
+        return Constants::invalidPatchSlot;
+
+    FlushPendingRenderPass();
+
+    /* Record indirect draw command whose arguments are read from host-visible memory */
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;
+    auto mappedData = AllocPatchArguments(sizeof(DrawIndirectArguments), buffer, offset);
+    ::memcpy(mappedData, &args, sizeof(args));
+
+    vkCmdDrawIndirect(commandBuffer_, buffer, offset, 1, 0);
+
+    const auto slot = static_cast<std::uint32_t>(patchSlots_.size());
+    patchSlots_.push_back({ mappedData, false });
+    return slot;
+}
+
+std::uint32_t VKCommandBuffer::DrawIndexedPatchable(const DrawIndexedIndirectArguments& args)
+{
+    if (skipDraws_)
+        return Constants::invalidPatchSlot;
+
+    FlushPendingRenderPass();
+
+    /* Record indirect indexed draw command whose arguments are read from host-visible memory */
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;
+    auto mappedData = AllocPatchArguments(sizeof(DrawIndexedIndirectArguments), buffer, offset);
+    ::memcpy(mappedData, &args, sizeof(args));
+
+    vkCmdDrawIndexedIndirect(commandBuffer_, buffer, offset, 1, 0);
+
+    const auto slot = static_cast<std::uint32_t>(patchSlots_.size());
+    patchSlots_.push_back({ mappedData, true });
+    return slot;
+}
+
+bool VKCommandBuffer::PatchDraw(std::uint32_t slot, const DrawIndirectArguments& args)
+{
+    if (slot < patchSlots_.size() && !patchSlots_[slot].indexed)
+    {
+        /* Patch block is host-coherent, so the new arguments are visible with the next submission */
+        ::memcpy(patchSlots_[slot].mappedData, &args, sizeof(args));
+        return true;
+    }
+    return false;
+}
+
+bool VKCommandBuffer::PatchDrawIndexed(std::uint32_t slot, const DrawIndexedIndirectArguments& args)
+{
+    if (slot < patchSlots_.size() && patchSlots_[slot].indexed)
+    {
+        ::memcpy(patchSlots_[slot].mappedData, &args, sizeof(args));
+        return true;
+    }
+    return false;
+}
+
+void VKCommandBuffer::DrawMeshTasks(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
+{
+    if (skipDraws_)
+        return;
+
+    LLGL_ASSERT_VK_EXTENSION(VKExt::EXT_mesh_shader, VK_EXT_MESH_SHADER_EXTENSION_NAME);
+
+    FlushPendingRenderPass();
+    vkCmdDrawMeshTasksEXT(commandBuffer_, numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+}
+
+void VKCommandBuffer::DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    if (skipDraws_)
+        return;
+
+    LLGL_ASSERT_VK_EXTENSION(VKExt::EXT_mesh_shader, VK_EXT_MESH_SHADER_EXTENSION_NAME);
+
+    FlushPendingRenderPass();
+    auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+    vkCmdDrawMeshTasksIndirectEXT(commandBuffer_, bufferVK.GetVkBuffer(), offset, numCommands, stride);
+}
+
 /* ----- Compute ----- */
 
 void VKCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
 {
+    if (skipDispatches_)
+        return;
+
+    RestoreResourceStates();
     vkCmdDispatch(commandBuffer_, numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
 }
 
 void VKCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    if (skipDispatches_)
+        return;
+
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+    RestoreResourceStates();
     vkCmdDispatchIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset);
 }
 
@@ -1020,6 +1592,25 @@ void VKCommandBuffer::SetGraphicsAPIDependentState(const void* stateDesc, std::s
     // dummy
 }
 
+/* ----- Internals ----- */
+
+VkFence VKCommandBuffer::AcquireQueueSubmitFence()
+{
+    /* Reset recording fence right before it is submitted and wait on it before the next recording */
+    vkResetFences(device_, 1, &recordingFence_);
+    BindBatchSubmitFence(recordingFence_);
+    return recordingFence_;
+}
+
+void VKCommandBuffer::BindBatchSubmitFence(VkFence fence)
+{
+    waitFenceList_[commandBufferIndex_] = fence;
+
+    /* Secondary command buffers must not be re-recorded before this command buffer has been completed either */
+    for (auto secondaryCmdBuffer : executedCommandBuffers_)
+        secondaryCmdBuffer->BindBatchSubmitFence(fence);
+}
+
 
 /*
  * ======= Private: =======
@@ -1041,8 +1632,9 @@ void VKCommandBuffer::CreateCommandPool(std::uint32_t queueFamilyIndex)
 
 void VKCommandBuffer::CreateCommandBuffers(std::uint32_t bufferCount)
 {
-    /* Allocate command buffers */
-    commandBufferList_.resize(bufferCount);
+    /* Allocate command buffers and append them to the list */
+    const std::size_t firstBuffer = commandBufferList_.size();
+    commandBufferList_.resize(firstBuffer + bufferCount);
 
     VkCommandBufferAllocateInfo allocInfo;
     {
@@ -1052,19 +1644,21 @@ void VKCommandBuffer::CreateCommandBuffers(std::uint32_t bufferCount)
         allocInfo.level                 = bufferLevel_;
         allocInfo.commandBufferCount    = bufferCount;
     }
-    auto result = vkAllocateCommandBuffers(device_, &allocInfo, commandBufferList_.data());
+    auto result = vkAllocateCommandBuffers(device_, &allocInfo, commandBufferList_.data() + firstBuffer);
     VKThrowIfFailed(result, "failed to allocate Vulkan command buffers");
 }
 
-void VKCommandBuffer::CreateRecordingFences(VkQueue commandQueue, std::uint32_t numFences)
+void VKCommandBuffer::CreateRecordingFences(std::uint32_t numFences)
 {
-    recordingFenceList_.reserve(numFences);
+    recordingFenceList_.reserve(recordingFenceList_.size() + numFences);
+    waitFenceList_.reserve(waitFenceList_.size() + numFences);
 
+    /* Create fences in signaled state, so the command buffer can be created on any thread without accessing the queue */
     VkFenceCreateInfo createInfo;
     {
         createInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
         createInfo.pNext = nullptr;
-        createInfo.flags = 0;
+        createInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
     }
 
     for (std::uint32_t i = 0; i < numFences; ++i)
@@ -1074,10 +1668,8 @@ void VKCommandBuffer::CreateRecordingFences(VkQueue commandQueue, std::uint32_t
             /* Create fence for command buffer recording */
             auto result = vkCreateFence(device_, &createInfo, nullptr, fence.ReleaseAndGetAddressOf());
             VKThrowIfFailed(result, "failed to create Vulkan fence");
-
-            /* Initial fence signal */
-            vkQueueSubmit(commandQueue, 0, nullptr, fence);
         }
+        waitFenceList_.push_back(fence.Get());
         recordingFenceList_.emplace_back(std::move(fence));
     }
 }
@@ -1158,13 +1750,141 @@ void VKCommandBuffer::ConvertRenderPassClearValues(
         dstClearValuesCount += renderPass.GetNumColorAttachments();
 }
 
+void VKCommandBuffer::ConvertDynamicRenderingClearValues(
+    const VKRenderPass& renderPass,
+    VkClearValue*       dstClearValues,
+    std::uint32_t       srcClearValuesCount,
+    const ClearValue*   srcClearValues)
+{
+    const VkClearColorValue         defaultClearColor           = { { 0.0f, 0.0f, 0.0f, 0.0f } };
+    const VkClearDepthStencilValue  defaultClearDepthStencil    = { 1.0f, 0 };
+
+    std::uint32_t srcIndex = 0;
+
+    /* Fill clear values of color attachments in the same order as for native render passes */
+    const std::uint32_t numColorAttachments = std::min<std::uint32_t>(renderPass.GetNumColorAttachments(), numColorAttachments_);
+
+    for (std::uint32_t i = 0; i < numColorAttachments; ++i)
+    {
+        if (renderPass.GetColorAttachmentDesc(i).loadOp == VK_ATTACHMENT_LOAD_OP_CLEAR)
+        {
+            if (srcIndex < srcClearValuesCount)
+                ToVkClearColor(dstClearValues[i].color, srcClearValues[srcIndex++].color);
+            else
+                dstClearValues[i].color = defaultClearColor;
+        }
+    }
+
+    /* Fill clear value of depth-stencil attachment, which follows the color attachments of the render target */
+    if (renderPass.GetDepthStencilIndex() != 0xFFu)
+    {
+        const auto& attachmentDesc = renderPass.GetDepthStencilAttachmentDesc();
+        if (attachmentDesc.loadOp == VK_ATTACHMENT_LOAD_OP_CLEAR || attachmentDesc.stencilLoadOp == VK_ATTACHMENT_LOAD_OP_CLEAR)
+        {
+            auto& dst = dstClearValues[numColorAttachments_];
+            if (srcIndex < srcClearValuesCount)
+                ToVkClearDepthStencil(dst.depthStencil, srcClearValues[srcIndex].depth, srcClearValues[srcIndex].stencil);
+            else
+                dst.depthStencil = defaultClearDepthStencil;
+        }
+    }
+}
+
+void VKCommandBuffer::StoreFramebufferAttributes(RenderTarget& renderTarget)
+{
+    if (LLGL::IsInstanceOf<SwapChain>(renderTarget))
+    {
+        /* Get Vulkan swap-chain object */
+        auto& swapChainVK = LLGL_CAST(VKSwapChain&, renderTarget);
+
+        /* Store information about framebuffer attachments */
+        renderPass_                     = swapChainVK.GetSwapChainRenderPass().GetVkRenderPass();
+        secondaryRenderPass_            = swapChainVK.GetSecondaryVkRenderPass();
+        framebuffer_                    = swapChainVK.GetVkFramebuffer();
+        framebufferRenderArea_.extent   = swapChainVK.GetVkExtent();
+        numColorAttachments_            = swapChainVK.GetNumColorAttachments();
+        hasDSVAttachment_               = (swapChainVK.HasDepthAttachment() || swapChainVK.HasStencilAttachment());
+        dynamicRenderTarget_            = nullptr;
+        dynamicRenderPass_              = nullptr;
+    }
+    else
+    {
+        /* Get Vulkan render target object and store its extent for subsequent commands */
+        auto& renderTargetVK = LLGL_CAST(VKRenderTarget&, renderTarget);
+
+        /* Store information about framebuffer attachments */
+        renderPass_                     = renderTargetVK.GetVkRenderPass();
+        secondaryRenderPass_            = renderTargetVK.GetSecondaryVkRenderPass();
+        framebuffer_                    = renderTargetVK.GetVkFramebuffer();
+        framebufferRenderArea_.extent   = renderTargetVK.GetVkExtent();
+        numColorAttachments_            = renderTargetVK.GetNumColorAttachments();
+        hasDSVAttachment_               = (renderTargetVK.HasDepthAttachment() || renderTargetVK.HasStencilAttachment());
+
+        /* Render targets without render pass and framebuffer objects are rendered with "VK_KHR_dynamic_rendering" */
+        if (renderTargetVK.IsDynamicRendering())
+        {
+            dynamicRenderTarget_    = &renderTargetVK;
+            dynamicRenderPass_      = LLGL_CAST(const VKRenderPass*, renderTargetVK.GetRenderPass());
+        }
+        else
+        {
+            dynamicRenderTarget_    = nullptr;
+            dynamicRenderPass_      = nullptr;
+        }
+    }
+}
+
+static VkRenderingFlagsKHR ToVkRenderingFlags(VkSubpassContents subpassContents)
+{
+    return (subpassContents == VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR : 0);
+}
+
+void VKCommandBuffer::BeginPendingRenderPass(VkSubpassContents subpassContents)
+{
+    if (dynamicRenderTarget_ != nullptr)
+    {
+        /* Record begin of dynamic rendering instance */
+        dynamicRenderTarget_->BeginRendering(commandBuffer_, *dynamicRenderPass_, clearValues_, ToVkRenderingFlags(subpassContents), false);
+        subpassContents_    = subpassContents;
+        recordState_        = RecordState::InsideRenderPass;
+        return;
+    }
+
+    /* Record begin of render pass */
+    VkRenderPassBeginInfo beginInfo;
+    {
+        beginInfo.sType             = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        beginInfo.pNext             = nullptr;
+        beginInfo.renderPass        = renderPass_;
+        beginInfo.framebuffer       = framebuffer_;
+        beginInfo.renderArea        = framebufferRenderArea_;
+        beginInfo.clearValueCount   = numClearValues_;
+        beginInfo.pClearValues      = clearValues_;
+    }
+    vkCmdBeginRenderPass(commandBuffer_, &beginInfo, subpassContents);
+
+    /* Store new record state */
+    subpassContents_    = subpassContents;
+    recordState_        = RecordState::InsideRenderPass;
+}
+
 void VKCommandBuffer::PauseRenderPass()
 {
-    vkCmdEndRenderPass(commandBuffer_);
+    if (dynamicRenderTarget_ != nullptr)
+        dynamicRenderTarget_->EndRendering(commandBuffer_);
+    else
+        vkCmdEndRenderPass(commandBuffer_);
 }
 
 void VKCommandBuffer::ResumeRenderPass()
 {
+    if (dynamicRenderTarget_ != nullptr)
+    {
+        /* Continue dynamic rendering with the content of all attachments */
+        dynamicRenderTarget_->BeginRendering(commandBuffer_, *dynamicRenderPass_, clearValues_, ToVkRenderingFlags(subpassContents_), true);
+        return;
+    }
+
     /* Record begin of render pass */
     VkRenderPassBeginInfo beginInfo;
     {
@@ -1176,7 +1896,7 @@ void VKCommandBuffer::ResumeRenderPass()
         beginInfo.clearValueCount   = 0;
         beginInfo.pClearValues      = nullptr;
     }
-    vkCmdBeginRenderPass(commandBuffer_, &beginInfo, VK_SUBPASS_CONTENTS_INLINE);
+    vkCmdBeginRenderPass(commandBuffer_, &beginInfo, subpassContents_);
 }
 
 bool VKCommandBuffer::IsInsideRenderPass() const
@@ -1184,6 +1904,49 @@ bool VKCommandBuffer::IsInsideRenderPass() const
     return (recordState_ == RecordState::InsideRenderPass);
 }
 
+bool VKCommandBuffer::BeginTransfer()
+{
+    if (IsInsideRenderPass())
+    {
+        PauseRenderPass();
+        return true;
+    }
+    return false;
+}
+
+void VKCommandBuffer::EndTransfer(bool renderPassPaused)
+{
+    if (renderPassPaused)
+    {
+        /* Barriers cannot be deferred into the render pass, so submit them before it is resumed */
+        resourceStateTracker_.RestoreDefaultLayouts(commandBuffer_);
+        ResumeRenderPass();
+    }
+}
+
+void VKCommandBuffer::FlushBufferBarrier(VkBuffer buffer)
+{
+    if (resourceStateTracker_.HasPendingBufferBarrier(buffer))
+        resourceStateTracker_.FlushBarriers(commandBuffer_);
+}
+
+void VKCommandBuffer::RestoreResourceStates()
+{
+    if (resourceStateTracker_.IsDirty())
+        resourceStateTracker_.RestoreDefaultLayouts(commandBuffer_);
+}
+
+void VKCommandBuffer::SetFragmentShadingRate(const VkExtent2D& fragmentSize)
+{
+    /* Primitive and attachment shading rates are not enabled, so keep the pipeline shading rate (non-trivial combiners are optional) */
+    const VkFragmentShadingRateCombinerOpKHR combinerOps[2] =
+    {
+        VK_FRAGMENT_SHADING_RATE_COMBINER_OP_KEEP_KHR,
+        VK_FRAGMENT_SHADING_RATE_COMBINER_OP_KEEP_KHR,
+    };
+    vkCmdSetFragmentShadingRateKHR(commandBuffer_, &fragmentSize, combinerOps);
+}
+
 void VKCommandBuffer::BufferPipelineBarrier(
     VkBuffer                buffer,
     VkDeviceSize            offset,
@@ -1193,28 +1956,99 @@ void VKCommandBuffer::BufferPipelineBarrier(
     VkPipelineStageFlags    srcStageMask,
     VkPipelineStageFlags    dstStageMask)
 {
-    VkBufferMemoryBarrier barrier;
+    /* Defer buffer barrier until the next command that might access the buffer */
+    resourceStateTracker_.InsertBufferBarrier(buffer, offset, size, srcAccessMask, dstAccessMask, srcStageMask, dstStageMask);
+}
+
+// Returns the index of the first native command buffer after 'currentIndex' whose wait fence is signaled, or 'numBuffers' if there is none
+static std::size_t FindAvailableVkCommandBuffer(VkDevice device, const VkFence* waitFences, std::size_t numBuffers, std::size_t currentIndex)
+{
+    for (std::size_t i = 1; i <= numBuffers; ++i)
     {
-        barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
-        barrier.pNext               = nullptr;
-        barrier.srcAccessMask       = srcAccessMask;
-        barrier.dstAccessMask       = dstAccessMask;
-        barrier.srcQueueFamilyIndex = 0;
-        barrier.dstQueueFamilyIndex = 0;
-        barrier.buffer              = buffer;
-        barrier.offset              = offset;
-        barrier.size                = size;
+        const std::size_t index = (currentIndex + i) % numBuffers;
+        if (vkGetFenceStatus(device, waitFences[index]) == VK_SUCCESS)
+            return index;
     }
-    vkCmdPipelineBarrier(commandBuffer_, srcStageMask, dstStageMask, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+    return numBuffers;
 }
 
 void VKCommandBuffer::AcquireNextBuffer()
 {
-    commandBufferIndex_ = (commandBufferIndex_ + 1) % commandBufferList_.size();
+    /* Pick any native command buffer whose previous submission has already been completed */
+    const std::size_t numBuffers = commandBufferList_.size();
+    std::size_t nextIndex = FindAvailableVkCommandBuffer(device_, waitFenceList_.data(), numBuffers, commandBufferIndex_);
+
+    if (nextIndex == numBuffers)
+    {
+        if (numBuffers < maxNumCommandBuffers_)
+        {
+            /* Grow ring by another native command buffer instead of waiting for the GPU */
+            CreateCommandBuffers(1);
+            CreateRecordingFences(1);
+            patchBlockLists_.resize(numBuffers + 1);
+        }
+        else
+        {
+            /* All native command buffers are in flight, so wait until any of them has been completed */
+            vkWaitForFences(device_, static_cast<std::uint32_t>(numBuffers), waitFenceList_.data(), VK_FALSE, UINT64_MAX);
+            nextIndex = FindAvailableVkCommandBuffer(device_, waitFenceList_.data(), numBuffers, commandBufferIndex_);
+            ++numBeginStalls_;
+        }
+    }
+
+    commandBufferIndex_ = nextIndex;
     commandBuffer_      = commandBufferList_[commandBufferIndex_];
     recordingFence_     = recordingFenceList_[commandBufferIndex_].Get();
 }
 
+char* VKCommandBuffer::AllocPatchArguments(VkDeviceSize size, VkBuffer& outBuffer, VkDeviceSize& outOffset)
+{
+    /* Continue with next patch block if the current one is full; blocks are kept for subsequent recordings of the same native command buffer */
+    auto& patchBlocks = patchBlockLists_[commandBufferIndex_];
+    if (numPatchBlocks_ == 0 || patchBlockOffset_ + size > g_patchBlockSize)
+    {
+        if (numPatchBlocks_ == patchBlocks.size())
+        {
+            auto patchBlock = MakeUnique<VKPatchBlock>(device_);
+            {
+                VkBufferCreateInfo createInfo;
+                {
+                    createInfo.sType                    = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+                    createInfo.pNext                    = nullptr;
+                    createInfo.flags                    = 0;
+                    createInfo.size                     = g_patchBlockSize;
+                    createInfo.usage                    = VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+                    createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
+                    createInfo.queueFamilyIndexCount    = 0;
+                    createInfo.pQueueFamilyIndices      = nullptr;
+                }
+                patchBlock->buffer.CreateVkBuffer(device_, createInfo);
+
+                /* Allocate dedicated host-coherent memory, so the arguments can be patched without flushing */
+                const auto& requirements    = patchBlock->buffer.GetRequirements();
+                const auto  memoryTypeIndex = VKFindMemoryType(
+                    memoryProperties_,
+                    requirements.memoryTypeBits,
+                    (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+                );
+                patchBlock->deviceMemory = MakeUnique<VKDeviceMemory>(device_, requirements.size, memoryTypeIndex);
+                patchBlock->buffer.BindMemoryRegion(device_, patchBlock->deviceMemory->Allocate(requirements.size, requirements.alignment));
+                patchBlock->mappedData = reinterpret_cast<char*>(patchBlock->buffer.Map(device_));
+            }
+            patchBlocks.push_back(std::move(patchBlock));
+        }
+        ++numPatchBlocks_;
+        patchBlockOffset_ = 0;
+    }
+
+    auto& patchBlock = *patchBlocks[numPatchBlocks_ - 1];
+    outBuffer           = patchBlock.buffer.GetVkBuffer();
+    outOffset           = patchBlockOffset_;
+    patchBlockOffset_   += size;
+
+    return patchBlock.mappedData + outOffset;
+}
+
 void VKCommandBuffer::ResetQueryPoolsInFlight()
 {
     for (std::size_t i = 0; i < numQueryHeapsInFlight_; ++i)
@@ -10,10 +10,14 @@
 
 
 #include <LLGL/CommandBuffer.h>
+#include <LLGL/StaticLimits.h>
 #include "Vulkan.h"
 #include "VKPtr.h"
 #include "VKCore.h"
+#include "RenderState/VKResourceStateTracker.h"
+#include "Buffer/VKDeviceBuffer.h"
 
+#include <memory>
 #include <vector>
 
 
@@ -25,7 +29,12 @@ class VKDevice;
 class VKPhysicalDevice;
 class VKResourceHeap;
 class VKRenderPass;
+class VKRenderTarget;
 class VKQueryHeap;
+class VKPipelineLayout;
+class VKStagingBufferPool;
+class VKReadbackPool;
+class VKDeviceMemory;
 
 class VKCommandBuffer final : public CommandBuffer
 {
@@ -39,6 +48,8 @@ class VKCommandBuffer final : public CommandBuffer
             VKDevice&                       device,
             VkQueue                         commandQueue,
             const QueueFamilyIndices&       queueFamilyIndices,
+            VKStagingBufferPool&            stagingBufferPool,
+            VKReadbackPool&                 readbackPool,
             const CommandBufferDescriptor&  desc
         );
         ~VKCommandBuffer();
@@ -48,6 +59,8 @@ class VKCommandBuffer final : public CommandBuffer
         void Begin() override;
         void End() override;
 
+        std::uint32_t QueryBeginStalls() override;
+
         void Execute(CommandBuffer& deferredCommandBuffer) override;
 
         /* ----- Blitting ----- */
@@ -59,6 +72,12 @@ class VKCommandBuffer final : public CommandBuffer
             std::uint16_t   dataSize
         ) override;
 
+        void UpdateBuffer(
+            Buffer&                     dstBuffer,
+            std::uint32_t               numRegions,
+            const BufferWriteRegion*    regions
+        ) override;
+
         void CopyBuffer(
             Buffer&         dstBuffer,
             std::uint64_t   dstOffset,
@@ -67,6 +86,13 @@ class VKCommandBuffer final : public CommandBuffer
             std::uint64_t   size
         ) override;
 
+        void CopyBuffer(
+            Buffer&                     dstBuffer,
+            Buffer&                     srcBuffer,
+            std::uint32_t               numRegions,
+            const BufferCopyRegion*     regions
+        ) override;
+
         void CopyBufferFromTexture(
             Buffer&                 dstBuffer,
             std::uint64_t           dstOffset,
@@ -76,6 +102,9 @@ class VKCommandBuffer final : public CommandBuffer
             std::uint32_t           layerStride = 0
         ) override;
 
+        std::uint64_t CopyBufferToReadback(Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size) override;
+        std::uint64_t CopyTextureToReadback(Texture& srcTexture, const TextureRegion& srcRegion) override;
+
         void FillBuffer(
             Buffer&         dstBuffer,
             std::uint64_t   dstOffset,
@@ -91,6 +120,13 @@ class VKCommandBuffer final : public CommandBuffer
             const Extent3D&         extent
         ) override;
 
+        void CopyTexture(
+            Texture&                    dstTexture,
+            Texture&                    srcTexture,
+            std::uint32_t               numRegions,
+            const TextureCopyRegion*    regions
+        ) override;
+
         void CopyTextureFromBuffer(
             Texture&                dstTexture,
             const TextureRegion&    dstRegion,
@@ -127,6 +163,14 @@ class VKCommandBuffer final : public CommandBuffer
             const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined
         ) override;
 
+        void SetResourceHeap(
+            ResourceHeap&           resourceHeap,
+            std::uint32_t           descriptorSet,
+            std::uint32_t           numDynamicOffsets,
+            const std::uint32_t*    dynamicOffsets,
+            const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined
+        ) override;
+
         void SetResource(
             Resource&       resource,
             std::uint32_t   slot,
@@ -152,6 +196,7 @@ class VKCommandBuffer final : public CommandBuffer
         ) override;
 
         void EndRenderPass() override;
+        void NextSubpass() override;
 
         void Clear(long flags, const ClearValue& clearValue = {}) override;
         void ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments) override;
@@ -161,6 +206,7 @@ class VKCommandBuffer final : public CommandBuffer
         void SetPipelineState(PipelineState& pipelineState) override;
         void SetBlendFactor(const ColorRGBAf& color) override;
         void SetStencilReference(std::uint32_t reference, const StencilFace stencilFace = StencilFace::FrontAndBack) override;
+        void SetShadingRate(const ShadingRate rate) override;
 
         void SetUniform(
             UniformLocation location,
@@ -179,6 +225,7 @@ class VKCommandBuffer final : public CommandBuffer
 
         void BeginQuery(QueryHeap& queryHeap, std::uint32_t query = 0) override;
         void EndQuery(QueryHeap& queryHeap, std::uint32_t query = 0) override;
+        void ResolveQueries(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries) override;
 
         void BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query = 0, const RenderConditionMode mode = RenderConditionMode::Wait) override;
         void EndRenderCondition() override;
@@ -208,6 +255,18 @@ class VKCommandBuffer final : public CommandBuffer
         void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset) override;
         void DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
 
+        void DrawIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride) override;
+        void DrawIndexedIndirectCount(Buffer& buffer, std::uint64_t offset, Buffer& countBuffer, std::uint64_t countOffset, std::uint32_t maxNumCommands, std::uint32_t stride) override;
+
+        std::uint32_t DrawPatchable(const DrawIndirectArguments& args) override;
+        std::uint32_t DrawIndexedPatchable(const DrawIndexedIndirectArguments& args) override;
+
+        bool PatchDraw(std::uint32_t slot, const DrawIndirectArguments& args) override;
+        bool PatchDrawIndexed(std::uint32_t slot, const DrawIndexedIndirectArguments& args) override;
+
+        void DrawMeshTasks(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ) override;
+        void DrawMeshTasksIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride) override;
+
         /* ----- Compute ----- */
 
         void Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ) override;
@@ -232,11 +291,11 @@ class VKCommandBuffer final : public CommandBuffer
             return commandBuffer_;
         }
 
-        // Returns the fence used to submit the command buffer to the queue.
-        inline VkFence GetQueueSubmitFence() const
-        {
-            return recordingFence_;
-        }
+        // Resets and returns the fence used to submit the command buffer to the queue.
+        VkFence AcquireQueueSubmitFence();
+
+        // Binds the fence that is signaled by a batched queue submission. It is waited on before the native command buffer is re-recorded.
+        void BindBatchSubmitFence(VkFence fence);
 
         // Returns true if this is an immediate command buffer, otherwise it is a deferred command buffer.
         inline bool IsImmediateCmdBuffer() const
@@ -250,15 +309,34 @@ class VKCommandBuffer final : public CommandBuffer
         {
             Undefined,          // before "Begin"
             OutsideRenderPass,  // after "Begin"
+            RenderPassPending,  // after "BeginRenderPass", but before the first command inside the render pass
             InsideRenderPass,   // after "BeginRenderPass"
             ReadyForSubmit,     // after "End"
         };
 
+        // Host-visible block of indirect arguments for patchable draw commands.
+        struct VKPatchBlock
+        {
+            VKPatchBlock(const VKPtr<VkDevice>& device);
+            ~VKPatchBlock();
+
+            std::unique_ptr<VKDeviceMemory> deviceMemory;
+            VKDeviceBuffer                  buffer;
+            char*                           mappedData  = nullptr;
+        };
+
+        // Indirect arguments of a patchable draw command.
+        struct VKPatchSlot
+        {
+            char*   mappedData;
+            bool    indexed;
+        };
+
     private:
 
         void CreateCommandPool(std::uint32_t queueFamilyIndex);
         void CreateCommandBuffers(std::uint32_t bufferCount);
-        void CreateRecordingFences(VkQueue commandQueue, std::uint32_t numFences);
+        void CreateRecordingFences(std::uint32_t numFences);
 
         void ClearFramebufferAttachments(std::uint32_t numAttachments, const VkClearAttachment* attachments);
 
@@ -270,15 +348,62 @@ class VKCommandBuffer final : public CommandBuffer
             const ClearValue*   srcClearValues
         );
 
+        // Converts the clear values for dynamic rendering, which are indexed by attachment (see VKRenderTarget::BeginRendering).
+        void ConvertDynamicRenderingClearValues(
+            const VKRenderPass& renderPass,
+            VkClearValue*       dstClearValues,
+            std::uint32_t       srcClearValuesCount,
+            const ClearValue*   srcClearValues
+        );
+
+        // Stores the render pass and framebuffer attributes of the specified swap-chain or render target.
+        void StoreFramebufferAttributes(RenderTarget& renderTarget);
+
+        /*
+        Records the begin of the render pass that has been deferred by BeginRenderPass.
+        The subpass contents can only be determined by the first command inside the render pass, i.e. Execute() or any inline command.
+        */
+        void BeginPendingRenderPass(VkSubpassContents subpassContents);
+
+        // Records the begin of the pending render pass for inline commands.
+        inline void FlushPendingRenderPass()
+        {
+            if (recordState_ == RecordState::RenderPassPending)
+                BeginPendingRenderPass(VK_SUBPASS_CONTENTS_INLINE);
+        }
+
         void PauseRenderPass();
         void ResumeRenderPass();
 
         bool IsInsideRenderPass() const;
 
+        // Pauses the render pass if necessary for a transfer command and returns true if the render pass has been paused.
+        bool BeginTransfer();
+
+        // Submits the pending barriers and resumes the render pass if it has been paused by BeginTransfer().
+        void EndTransfer(bool renderPassPaused);
+
+        // Submits the pending barriers if the specified buffer has a pending barrier.
+        void FlushBufferBarrier(VkBuffer buffer);
+
+        // Submits all pending barriers and transitions all tracked resources back into their default state.
+        void RestoreResourceStates();
+
+        // Sets the pipeline fragment shading rate for subsequent draw commands.
+        void SetFragmentShadingRate(const VkExtent2D& fragmentSize);
+
         void BindResourceHeap(
-            VKResourceHeap&     resourceHeapVK,
-            std::uint32_t       descriptorSet,
-            VkPipelineBindPoint pipelineBindPoint
+            VKResourceHeap&         resourceHeapVK,
+            std::uint32_t           descriptorSet,
+            VkPipelineBindPoint     pipelineBindPoint,
+            const std::uint32_t*    dynamicOffsets
+        );
+
+        void BindResourceHeapToPipelines(
+            VKResourceHeap&         resourceHeapVK,
+            std::uint32_t           descriptorSet,
+            const PipelineBindPoint bindPoint,
+            const std::uint32_t*    dynamicOffsets
         );
 
         void BufferPipelineBarrier(
@@ -286,7 +411,7 @@ class VKCommandBuffer final : public CommandBuffer
             VkDeviceSize            offset,
             VkDeviceSize            size,
             VkAccessFlags           srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT,
-            VkAccessFlags           dstAccessMask   = VK_ACCESS_SHADER_READ_BIT,
+            VkAccessFlags           dstAccessMask   = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
             VkPipelineStageFlags    srcStageMask    = VK_PIPELINE_STAGE_TRANSFER_BIT,
             VkPipelineStageFlags    dstStageMask    = VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT | VK_PIPELINE_STAGE_ALL_COMMANDS_BIT
         );
@@ -294,6 +419,9 @@ class VKCommandBuffer final : public CommandBuffer
         // Acquires the next native VkCommandBuffer object.
         void AcquireNextBuffer();
 
+        // Allocates indirect arguments for a patchable draw command within the patch blocks of the current native command buffer.
+        char* AllocPatchArguments(VkDeviceSize size, VkBuffer& outBuffer, VkDeviceSize& outOffset);
+
         #if 1//TODO: optimize
         void ResetQueryPoolsInFlight();
         void AppendQueryPoolInFlight(VKQueryHeap* queryHeap);
@@ -304,6 +432,8 @@ class VKCommandBuffer final : public CommandBuffer
         VKDevice&                       device_;
 
         VkQueue                         commandQueue_               = VK_NULL_HANDLE;
+        VKStagingBufferPool&            stagingBufferPool_;
+        VKReadbackPool&                 readbackPool_;
 
         VKPtr<VkCommandPool>            commandPool_;
 
@@ -313,6 +443,9 @@ class VKCommandBuffer final : public CommandBuffer
 
         std::vector<VKPtr<VkFence>>     recordingFenceList_;
         VkFence                         recordingFence_;
+        std::vector<VkFence>            waitFenceList_;             // Fences to wait on before the respective native command buffer is re-recorded
+        std::size_t                     maxNumCommandBuffers_       = 1;    // Limit for growing the ring of native command buffers
+        std::uint32_t                   numBeginStalls_             = 0;    // Number of Begin() calls that had to wait for a fence
 
         RecordState                     recordState_                = RecordState::Undefined;
 
@@ -326,14 +459,36 @@ class VKCommandBuffer final : public CommandBuffer
         VkRect2D                        framebufferRenderArea_      = { { 0, 0 }, { 0, 0 } };
         std::uint32_t                   numColorAttachments_        = 0;
         bool                            hasDSVAttachment_           = false;
+        VkSubpassContents               subpassContents_            = VK_SUBPASS_CONTENTS_INLINE;
+        VKRenderTarget*                 dynamicRenderTarget_        = nullptr;  // Active render target that uses dynamic rendering instead of a render pass
+        const VKRenderPass*             dynamicRenderPass_          = nullptr;  // Load and store operations for dynamic rendering
+
+        VkClearValue                    clearValues_[LLGL_MAX_NUM_COLOR_ATTACHMENTS*2 + 1];
+        std::uint32_t                   numClearValues_             = 0;
+
+        RenderTarget*                   inheritedRenderTarget_      = nullptr;  // Render target for secondary command buffers
+        std::vector<VKCommandBuffer*>   executedCommandBuffers_;                // Secondary command buffers executed by this primary command buffer
 
         std::uint32_t                   queuePresentFamily_         = 0;
 
         bool                            scissorEnabled_             = false;
         bool                            scissorRectInvalidated_     = true;
+        bool                            skipDraws_                  = false;
+        bool                            skipDispatches_             = false;
+        bool                            hasFragmentShadingRate_     = false;
 
         std::uint32_t                   maxDrawIndirectCount_       = 0;
 
+        const VKPipelineLayout*         boundPipelineLayout_        = nullptr;  // Pipeline layout of the last bound PSO (for push constants)
+
+        VKResourceStateTracker          resourceStateTracker_;
+
+        const VkPhysicalDeviceMemoryProperties&                 memoryProperties_;
+        std::vector<std::vector<std::unique_ptr<VKPatchBlock>>> patchBlockLists_;           // Patch blocks per native command buffer
+        std::size_t                                             numPatchBlocks_     = 0;    // Number of patch blocks used by the current recording
+        VkDeviceSize                                            patchBlockOffset_   = 0;    // Offset within the last used patch block
+        std::vector<VKPatchSlot>                                patchSlots_;
+
         #if 1//TODO: optimize usage of query pools
         std::vector<VKQueryHeap*>       queryHeapsInFlight_;
         std::size_t                     numQueryHeapsInFlight_      = 0;
@@ -9,8 +9,13 @@
 #include "VKCommandBuffer.h"
 #include "RenderState/VKFence.h"
 #include "RenderState/VKQueryHeap.h"
+#include "Buffer/VKStagingBufferPool.h"
 #include "../CheckedCast.h"
+#include "../QueryUtils.h"
 #include "VKCore.h"
+#include "Ext/VKExtensions.h"
+#include "../../Core/ProfilerZone.h"
+#include <LLGL/Container/SmallVector.h>
 
 
 namespace LLGL
@@ -18,6 +23,11 @@ namespace LLGL
 
 
 VkResult VKSubmitCommandBuffer(VkQueue commandQueue, VkCommandBuffer commandBuffer, VkFence fence)
+{
+    return VKSubmitCommandBuffers(commandQueue, 1, &commandBuffer, fence);
+}
+
+VkResult VKSubmitCommandBuffers(VkQueue commandQueue, std::uint32_t numCommandBuffers, const VkCommandBuffer* commandBuffers, VkFence fence)
 {
     VkSubmitInfo submitInfo;
     {
@@ -26,36 +36,99 @@ VkResult VKSubmitCommandBuffer(VkQueue commandQueue, VkCommandBuffer commandBuff
         submitInfo.waitSemaphoreCount   = 0;
         submitInfo.pWaitSemaphores      = nullptr;
         submitInfo.pWaitDstStageMask    = 0;
-        submitInfo.commandBufferCount   = 1;
-        submitInfo.pCommandBuffers      = &commandBuffer;
+        submitInfo.commandBufferCount   = numCommandBuffers;
+        submitInfo.pCommandBuffers      = commandBuffers;
         submitInfo.signalSemaphoreCount = 0;
         submitInfo.pSignalSemaphores    = nullptr;
     }
     return vkQueueSubmit(commandQueue, 1, &submitInfo, fence);
 }
 
-VKCommandQueue::VKCommandQueue(const VKPtr<VkDevice>& device, VkQueue queue) :
-    device_ { device },
-    native_ { queue  }
+VKCommandQueue::VKCommandQueue(const VKPtr<VkDevice>& device, VkQueue queue, std::recursive_mutex& queueMutex, VKStagingBufferPool& stagingBufferPool) :
+    device_            { device            },
+    native_            { queue             },
+    queueMutex_        { queueMutex        },
+    stagingBufferPool_ { stagingBufferPool }
 {
 }
 
+void VKCommandQueue::EnableTimestampCalibration(VkTimeDomainEXT hostTimeDomain, float timestampPeriod)
+{
+    hostTimeDomain_     = hostTimeDomain;
+    timestampPeriod_    = timestampPeriod;
+}
+
 /* ----- Command Buffers ----- */
 
 void VKCommandQueue::Submit(CommandBuffer& commandBuffer)
 {
+    LLGL_PROFILER_ZONE("VKCommandQueue::Submit");
+
     auto& commandBufferVK = LLGL_CAST(VKCommandBuffer&, commandBuffer);
     if (!commandBufferVK.IsImmediateCmdBuffer())
     {
+        std::lock_guard<std::recursive_mutex> guard{ queueMutex_ };
+
+        /* Submit staged uploads first, so they are visible to the command buffer */
+        stagingBufferPool_.Flush();
+
         auto result = VKSubmitCommandBuffer(
             native_,
             commandBufferVK.GetVkCommandBuffer(),
-            commandBufferVK.GetQueueSubmitFence()
+            commandBufferVK.AcquireQueueSubmitFence()
         );
         VKThrowIfFailed(result, "failed to submit command buffer to Vulkan graphics queue");
     }
 }
 
+void VKCommandQueue::Submit(std::uint32_t numCommandBuffers, CommandBuffer* const * commandBuffers)
+{
+    LLGL_PROFILER_ZONE("VKCommandQueue::SubmitBatch");
+
+    /* Gather native command buffers of all deferred command buffers */
+    SmallVector<VKCommandBuffer*, 16> commandBuffersVK;
+    SmallVector<VkCommandBuffer, 16> nativeCommandBuffers;
+
+    for (std::uint32_t i = 0; i < numCommandBuffers; ++i)
+    {
+        auto commandBufferVK = LLGL_CAST(VKCommandBuffer*, commandBuffers[i]);
+        if (!commandBufferVK->IsImmediateCmdBuffer())
+        {
+            commandBuffersVK.push_back(commandBufferVK);
+            nativeCommandBuffers.push_back(commandBufferVK->GetVkCommandBuffer());
+        }
+    }
+
+    if (commandBuffersVK.empty())
+        return;
+
+    if (commandBuffersVK.size() == 1)
+    {
+        /* Submit single command buffer with its own fence */
+        Submit(*commandBuffersVK.front());
+        return;
+    }
+
+    std::lock_guard<std::recursive_mutex> guard{ queueMutex_ };
+
+    /* Submit staged uploads first, so they are visible to all command buffers */
+    stagingBufferPool_.Flush();
+
+    /* Submit all command buffers at once, so only a single fence is signaled for the entire batch */
+    auto fence = AcquireBatchFence();
+
+    auto result = VKSubmitCommandBuffers(
+        native_,
+        static_cast<std::uint32_t>(nativeCommandBuffers.size()),
+        nativeCommandBuffers.data(),
+        fence
+    );
+    VKThrowIfFailed(result, "failed to submit command buffers to Vulkan graphics queue");
+
+    for (auto commandBufferVK : commandBuffersVK)
+        commandBufferVK->BindBatchSubmitFence(fence);
+}
+
 /* ----- Queries ----- */
 
 bool VKCommandQueue::QueryResult(
@@ -77,6 +150,102 @@ bool VKCommandQueue::QueryResult(
     return true;
 }
 
+// Copies the result of the specified query from the oldest completed readback slot into the output entry of the specified size.
+static void CopyReadbackQueryResult(const VKQueryHeap& queryHeapVK, std::uint32_t query, void* data, std::size_t stride)
+{
+    const auto values = queryHeapVK.GetCompletedReadbackValues(query * queryHeapVK.GetGroupSize());
+
+    if (stride == sizeof(QueryPipelineStatistics))
+    {
+        /* Values are written in the order of VkQueryPipelineStatisticFlagBits */
+        auto dst = reinterpret_cast<QueryPipelineStatistics*>(data);
+        dst->inputAssemblyVertices              = values[ 0];
+        dst->inputAssemblyPrimitives            = values[ 1];
+        dst->vertexShaderInvocations            = values[ 2];
+        dst->geometryShaderInvocations          = values[ 3];
+        dst->geometryShaderPrimitives           = values[ 4];
+        dst->clippingInvocations                = values[ 5];
+        dst->clippingPrimitives                 = values[ 6];
+        dst->fragmentShaderInvocations          = values[ 7];
+        dst->tessControlShaderInvocations       = values[ 8];
+        dst->tessEvaluationShaderInvocations    = values[ 9];
+        dst->computeShaderInvocations           = values[10];
+    }
+    else
+    {
+        /* Get elapsed time from difference between start and end timestamps */
+        std::uint64_t result = values[0];
+        if (queryHeapVK.GetType() == QueryType::TimeElapsed)
+            result = queryHeapVK.GetCompletedReadbackValues(query * queryHeapVK.GetGroupSize() + 1)[0] - values[0];
+
+        if (stride == sizeof(std::uint64_t))
+            *reinterpret_cast<std::uint64_t*>(data) = result;
+        else
+            *reinterpret_cast<std::uint32_t*>(data) = static_cast<std::uint32_t>(result);
+    }
+}
+
+std::uint32_t VKCommandQueue::TryGetQueryResults(
+    QueryHeap&      queryHeap,
+    void*           data,
+    std::size_t     dataSize,
+    QueryRange*     outRanges,
+    std::uint32_t   maxRanges)
+{
+    auto& queryHeapVK = LLGL_CAST(VKQueryHeap&, queryHeap);
+
+    const auto numQueries   = queryHeapVK.GetNumQueries() / queryHeapVK.GetGroupSize();
+    const auto stride       = GetQueryResultStride(dataSize, numQueries);
+    if (stride == 0)
+        return 0;
+
+    std::uint32_t numRanges = 0;
+
+    /* Read back all slots whose availability words have been written, in the order they have been resolved */
+    while (auto ranges = queryHeapVK.GetCompletedReadbackRanges())
+    {
+        if (numRanges + ranges->size() > maxRanges)
+            break;
+
+        for (const auto& range : *ranges)
+        {
+            for (std::uint32_t query = range.firstQuery; query < range.firstQuery + range.numQueries; ++query)
+                CopyReadbackQueryResult(queryHeapVK, query, reinterpret_cast<char*>(data) + query * stride, stride);
+            outRanges[numRanges++] = range;
+        }
+
+        queryHeapVK.ReleaseCompletedReadback();
+    }
+
+    return numRanges;
+}
+
+bool VKCommandQueue::QueryCalibratedTimestamps(CalibratedTimestamps& outTimestamps)
+{
+    if (hostTimeDomain_ == VK_TIME_DOMAIN_MAX_ENUM_EXT)
+        return false;
+
+    /* Sample device and host timestamps with "VK_EXT_calibrated_timestamps" */
+    VkCalibratedTimestampInfoEXT timestampInfos[2] = {};
+    {
+        timestampInfos[0].sType         = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT;
+        timestampInfos[0].timeDomain    = VK_TIME_DOMAIN_DEVICE_EXT;
+        timestampInfos[1].sType         = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT;
+        timestampInfos[1].timeDomain    = hostTimeDomain_;
+    }
+    std::uint64_t timestamps[2] = {};
+    std::uint64_t maxDeviation  = 0;
+    if (vkGetCalibratedTimestampsEXT(device_, 2, timestampInfos, timestamps, &maxDeviation) != VK_SUCCESS)
+        return false;
+
+    /* Host time domain matches Timer::Tick; device timestamps increment once per 'timestampPeriod' nanoseconds */
+    outTimestamps.cpuTimestamp  = timestamps[1];
+    outTimestamps.gpuTimestamp  = timestamps[0];
+    outTimestamps.gpuFrequency  = static_cast<std::uint64_t>(1.0e9 / static_cast<double>(timestampPeriod_) + 0.5);
+    outTimestamps.maxDeviation  = maxDeviation;
+    return true;
+}
+
 #if 0
 bool VKCommandBuffer::QueryPipelineStatisticsResult(QueryHeap& queryHeap, QueryPipelineStatistics& result)
 {
@@ -103,18 +272,68 @@ bool VKCommandBuffer::QueryPipelineStatisticsResult(QueryHeap& queryHeap, QueryP
 void VKCommandQueue::Submit(Fence& fence)
 {
     auto& fenceVK = LLGL_CAST(VKFence&, fence);
-    fenceVK.Reset(device_);
-    vkQueueSubmit(native_, 0, nullptr, fenceVK.GetVkFence());
+    std::lock_guard<std::recursive_mutex> guard{ queueMutex_ };
+    stagingBufferPool_.Flush();
+    fenceVK.Submit(native_);
 }
 
 bool VKCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
 {
     auto& fenceVK = LLGL_CAST(VKFence&, fence);
-    return fenceVK.Wait(device_, timeout);
+    return fenceVK.Wait(timeout);
+}
+
+bool VKCommandQueue::WaitFenceValue(Fence& fence, std::uint64_t value, std::uint64_t timeout)
+{
+    auto& fenceVK = LLGL_CAST(VKFence&, fence);
+    return fenceVK.WaitValue(value, timeout);
+}
+
+void VKCommandQueue::SubmitWait(Fence& fence, std::uint64_t value)
+{
+    auto& fenceVK = LLGL_CAST(VKFence&, fence);
+    if (fenceVK.IsTimeline())
+    {
+        /* Submit wait operation without any command buffers; it also applies to all subsequent submissions to this queue */
+        const VkSemaphore           waitSemaphore   = fenceVK.GetVkSemaphore();
+        const VkPipelineStageFlags  waitStageMask   = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+        VkTimelineSemaphoreSubmitInfoKHR timelineInfo;
+        {
+            timelineInfo.sType                      = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+            timelineInfo.pNext                      = nullptr;
+            timelineInfo.waitSemaphoreValueCount    = 1;
+            timelineInfo.pWaitSemaphoreValues       = &value;
+            timelineInfo.signalSemaphoreValueCount  = 0;
+            timelineInfo.pSignalSemaphoreValues     = nullptr;
+        }
+        VkSubmitInfo submitInfo;
+        {
+            submitInfo.sType                        = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.pNext                        = &timelineInfo;
+            submitInfo.waitSemaphoreCount           = 1;
+            submitInfo.pWaitSemaphores              = &waitSemaphore;
+            submitInfo.pWaitDstStageMask            = &waitStageMask;
+            submitInfo.commandBufferCount           = 0;
+            submitInfo.pCommandBuffers              = nullptr;
+            submitInfo.signalSemaphoreCount         = 0;
+            submitInfo.pSignalSemaphores            = nullptr;
+        }
+        std::lock_guard<std::recursive_mutex> guard{ queueMutex_ };
+        auto result = vkQueueSubmit(native_, 1, &submitInfo, VK_NULL_HANDLE);
+        VKThrowIfFailed(result, "failed to submit Vulkan timeline semaphore wait");
+    }
+    else
+    {
+        /* Binary fences cannot be waited on by another queue, so block the CPU instead */
+        fenceVK.WaitValue(value, UINT64_MAX);
+    }
 }
 
 void VKCommandQueue::WaitIdle()
 {
+    std::lock_guard<std::recursive_mutex> guard{ queueMutex_ };
+    stagingBufferPool_.Flush();
     vkQueueWaitIdle(native_);
 }
 
@@ -123,6 +342,46 @@ void VKCommandQueue::WaitIdle()
  * ======= Private: =======
  */
 
+VkFence VKCommandQueue::AcquireBatchFence()
+{
+    /* Reuse oldest fence if its batch has already completed */
+    if (!batchFences_.empty())
+    {
+        auto& fence = batchFences_[batchFenceIndex_];
+        if (vkGetFenceStatus(device_, fence) == VK_SUCCESS)
+        {
+            batchFenceIndex_ = (batchFenceIndex_ + 1) % batchFences_.size();
+            vkResetFences(device_, 1, &fence);
+            return fence;
+        }
+    }
+
+    /* Create new fence and insert it as newest entry into the ring */
+    auto device = device_;
+    VKPtr<VkFence> fence
+    {
+        [device](VkFence obj, VkAllocationCallbacks* allocator)
+        {
+            vkDestroyFence(device, obj, allocator);
+        }
+    };
+
+    VkFenceCreateInfo createInfo;
+    {
+        createInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+    }
+    auto result = vkCreateFence(device_, &createInfo, nullptr, fence.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan fence");
+
+    auto fenceHandle = fence.Get();
+    batchFences_.insert(batchFences_.begin() + batchFenceIndex_, std::move(fence));
+    batchFenceIndex_ = (batchFenceIndex_ + 1) % batchFences_.size();
+
+    return fenceHandle;
+}
+
 VkResult VKCommandQueue::GetQueryResults(
     VKQueryHeap&    queryHeapVK,
     std::uint32_t   firstQuery,
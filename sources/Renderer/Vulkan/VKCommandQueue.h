@@ -14,6 +14,8 @@
 #include "VKPtr.h"
 #include "VKCore.h"
 #include "RenderState/VKFence.h"
+#include <vector>
+#include <mutex>
 
 
 namespace LLGL
@@ -21,10 +23,14 @@ namespace LLGL
 
 
 class VKQueryHeap;
+class VKStagingBufferPool;
 
 // Helper function to submit the specified Vulkan command buffer to a command queue.
 VkResult VKSubmitCommandBuffer(VkQueue commandQueue, VkCommandBuffer commandBuffer, VkFence fence);
 
+// Helper function to submit the specified Vulkan command buffers to a command queue with a single submission.
+VkResult VKSubmitCommandBuffers(VkQueue commandQueue, std::uint32_t numCommandBuffers, const VkCommandBuffer* commandBuffers, VkFence fence);
+
 class VKCommandQueue final : public CommandQueue
 {
 
@@ -32,21 +38,37 @@ class VKCommandQueue final : public CommandQueue
 
         /* ----- Common ----- */
 
-        VKCommandQueue(const VKPtr<VkDevice>& device, VkQueue queue);
+        VKCommandQueue(const VKPtr<VkDevice>& device, VkQueue queue, std::recursive_mutex& queueMutex, VKStagingBufferPool& stagingBufferPool);
+
+        // Enables QueryCalibratedTimestamps with the specified host time domain of "VK_EXT_calibrated_timestamps" and the timestamp period (in nanoseconds) of the physical device.
+        void EnableTimestampCalibration(VkTimeDomainEXT hostTimeDomain, float timestampPeriod);
 
         /* ----- Command Buffers ----- */
 
         void Submit(CommandBuffer& commandBuffer) override;
+        void Submit(std::uint32_t numCommandBuffers, CommandBuffer* const * commandBuffers) override;
 
         /* ----- Queries ----- */
 
         bool QueryResult(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, void* data, std::size_t dataSize) override;
 
+        std::uint32_t TryGetQueryResults(
+            QueryHeap&      queryHeap,
+            void*           data,
+            std::size_t     dataSize,
+            QueryRange*     outRanges,
+            std::uint32_t   maxRanges
+        ) override;
+
+        bool QueryCalibratedTimestamps(CalibratedTimestamps& outTimestamps) override;
+
         /* ----- Fences ----- */
 
         void Submit(Fence& fence) override;
 
         bool WaitFence(Fence& fence, std::uint64_t timeout) override;
+        bool WaitFenceValue(Fence& fence, std::uint64_t value, std::uint64_t timeout) override;
+        void SubmitWait(Fence& fence, std::uint64_t value) override;
         void WaitIdle() override;
 
     private:
@@ -77,10 +99,21 @@ class VKCommandQueue final : public CommandQueue
             VkQueryResultFlags  flags
         );
 
+        // Returns a fence for a batched submission whose previous batch has completed, or creates a new one.
+        VkFence AcquireBatchFence();
+
     private:
 
-        VkDevice    device_;
-        VkQueue     native_ = VK_NULL_HANDLE;
+        VkDevice                    device_;
+        VkQueue                     native_             = VK_NULL_HANDLE;
+        std::recursive_mutex&       queueMutex_;                            // Guards the queue against staged uploads from other threads
+        VKStagingBufferPool&        stagingBufferPool_;                     // Pending staged uploads are flushed before each submission
+
+        std::vector<VKPtr<VkFence>> batchFences_;                           // Ring of fences for batched submissions (oldest at batchFenceIndex_)
+        std::size_t                 batchFenceIndex_    = 0;
+
+        VkTimeDomainEXT             hostTimeDomain_     = VK_TIME_DOMAIN_MAX_ENUM_EXT;  // Host time domain for calibrated timestamps; VK_TIME_DOMAIN_MAX_ENUM_EXT if not supported
+        float                       timestampPeriod_    = 1.0f;                         // Number of nanoseconds per device timestamp tick
 
 };
 
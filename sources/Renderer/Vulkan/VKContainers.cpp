@@ -16,11 +16,11 @@ namespace LLGL
  * VKWriteDescriptorContainer structure
  */
 
-VKWriteDescriptorContainer::VKWriteDescriptorContainer(std::size_t numResourceViewsMax) :
-    bufferInfos      { numResourceViewsMax },
-    imageInfos       { numResourceViewsMax },
-    writeDescriptors { numResourceViewsMax }
+VKWriteDescriptorContainer::VKWriteDescriptorContainer(std::size_t numResourceViewsMax)
 {
+    bufferInfos.resize(numResourceViewsMax);
+    imageInfos.resize(numResourceViewsMax);
+    writeDescriptors.resize(numResourceViewsMax);
 }
 
 VkDescriptorBufferInfo* VKWriteDescriptorContainer::NextBufferInfo()
@@ -10,7 +10,8 @@
 
 
 #include <vulkan/vulkan.h>
-#include <vector>
+#include <LLGL/Container/SmallVector.h>
+#include "../../Core/STLAllocator.h"
 #include <cstdint>
 
 
@@ -18,6 +19,10 @@ namespace LLGL
 {
 
 
+// Container for the descriptor writes of a resource heap update; small updates are stored locally without heap allocations.
+template <typename T>
+using VKWriteDescriptorArray = SmallVector<T, 16, STLAllocator<T>>;
+
 // Helper structure to handle buffer and image information for a descriptor set.
 struct VKWriteDescriptorContainer
 {
@@ -28,16 +33,16 @@ struct VKWriteDescriptorContainer
     VkDescriptorImageInfo* NextImageInfo();
     VkWriteDescriptorSet* NextWriteDescriptor();
 
-    std::vector<VkDescriptorBufferInfo> bufferInfos;
-    std::uint32_t                       numBufferInfos          = 0;
+    VKWriteDescriptorArray<VkDescriptorBufferInfo>  bufferInfos;
+    std::uint32_t                                   numBufferInfos          = 0;
 
-    std::vector<VkDescriptorImageInfo>  imageInfos;
-    std::uint32_t                       numImageInfos           = 0;
+    VKWriteDescriptorArray<VkDescriptorImageInfo>   imageInfos;
+    std::uint32_t                                   numImageInfos           = 0;
 
-    std::vector<VkWriteDescriptorSet>   writeDescriptors;
-    std::uint32_t                       numWriteDescriptors     = 0;
+    VKWriteDescriptorArray<VkWriteDescriptorSet>    writeDescriptors;
+    std::uint32_t                                   numWriteDescriptors     = 0;
 
-    std::uint32_t                       barrierChangeRanges[2]  = {};
+    std::uint32_t                                   barrierChangeRanges[2]  = {};
 };
 
 
@@ -298,6 +298,42 @@ QueueFamilyIndices VKFindQueueFamilies(VkPhysicalDevice device, const VkQueueFla
     return indices;
 }
 
+std::uint32_t VKFindDedicatedTransferQueueFamily(VkPhysicalDevice device)
+{
+    auto queueFamilies = VKQueryQueueFamilyProperties(device);
+
+    for (std::uint32_t i = 0; i < queueFamilies.size(); ++i)
+    {
+        const auto& family = queueFamilies[i];
+        if (family.queueCount > 0 &&
+            (family.queueFlags & VK_QUEUE_TRANSFER_BIT) != 0 &&
+            (family.queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) == 0)
+        {
+            return i;
+        }
+    }
+
+    return QueueFamilyIndices::invalidIndex;
+}
+
+std::uint32_t VKFindDedicatedComputeQueueFamily(VkPhysicalDevice device)
+{
+    auto queueFamilies = VKQueryQueueFamilyProperties(device);
+
+    for (std::uint32_t i = 0; i < queueFamilies.size(); ++i)
+    {
+        const auto& family = queueFamilies[i];
+        if (family.queueCount > 0 &&
+            (family.queueFlags & VK_QUEUE_COMPUTE_BIT) != 0 &&
+            (family.queueFlags & VK_QUEUE_GRAPHICS_BIT) == 0)
+        {
+            return i;
+        }
+    }
+
+    return QueueFamilyIndices::invalidIndex;
+}
+
 VkFormat VKFindSupportedImageFormat(VkPhysicalDevice device, const VkFormat* candidates, std::size_t numCandidates, VkImageTiling tiling, VkFormatFeatureFlags features)
 {
     for (std::size_t i = 0; i < numCandidates; ++i)
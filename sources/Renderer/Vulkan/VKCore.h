@@ -27,18 +27,21 @@ struct QueueFamilyIndices
 
     QueueFamilyIndices() :
         graphicsFamily { invalidIndex },
-        presentFamily  { invalidIndex }
+        presentFamily  { invalidIndex },
+        transferFamily { invalidIndex },
+        computeFamily  { invalidIndex }
     {
     }
 
     union
     {
-        std::uint32_t indices[2];
+        std::uint32_t indices[4];
         struct
         {
             std::uint32_t graphicsFamily;
             std::uint32_t presentFamily;
-            //std::uint32_t transferFamily;
+            std::uint32_t transferFamily; // Optional dedicated transfer queue family
+            std::uint32_t computeFamily;  // Optional asynchronous compute queue family
         };
     };
 
@@ -48,6 +51,13 @@ struct QueueFamilyIndices
     }
 };
 
+// Queue families a resource is shared between. If there is more than one, the resource is created with VK_SHARING_MODE_CONCURRENT.
+struct VKSharedQueueFamilies
+{
+    std::uint32_t count         = 0;
+    std::uint32_t indices[2]    = {};
+};
+
 struct SurfaceSupportDetails
 {
     VkSurfaceCapabilitiesKHR        caps;
@@ -82,6 +92,12 @@ std::vector<VkQueueFamilyProperties> VKQueryQueueFamilyProperties(VkPhysicalDevi
 
 SurfaceSupportDetails VKQuerySurfaceSupport(VkPhysicalDevice device, VkSurfaceKHR surface);
 QueueFamilyIndices VKFindQueueFamilies(VkPhysicalDevice device, const VkQueueFlags flags, VkSurfaceKHR* surface = nullptr);
+
+// Returns the index of a queue family that supports transfer operations but neither graphics nor compute operations, or QueueFamilyIndices::invalidIndex.
+std::uint32_t VKFindDedicatedTransferQueueFamily(VkPhysicalDevice device);
+
+// Returns the index of a queue family that supports compute operations but no graphics operations, or QueueFamilyIndices::invalidIndex.
+std::uint32_t VKFindDedicatedComputeQueueFamily(VkPhysicalDevice device);
 VkFormat VKFindSupportedImageFormat(VkPhysicalDevice device, const VkFormat* candidates, std::size_t numCandidates, VkImageTiling tiling, VkFormatFeatureFlags features);
 
 // Returns the memory type index that supports the specified type bits and properties, or throws an std::runtime_error exception on failure.
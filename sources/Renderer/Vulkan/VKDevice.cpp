@@ -10,6 +10,7 @@
 #include "RenderState/VKFence.h"
 #include "Buffer/VKBuffer.h"
 #include "Texture/VKTexture.h"
+#include "Texture/VKMipGenerator.h"
 #include "Memory/VKDeviceMemoryRegion.h"
 #include "Memory/VKDeviceMemory.h"
 #include <set>
@@ -31,34 +32,52 @@ VKDevice::VKDevice() :
 }
 
 VKDevice::VKDevice(VKDevice&& device) :
-    device_             { std::move(device.device_)      },
-    queueFamilyIndices_ { device.queueFamilyIndices_     },
-    graphicsQueue_      { device.graphicsQueue_          },
-    commandPool_        { std::move(device.commandPool_) }
+    device_              { std::move(device.device_)      },
+    queueFamilyIndices_  { device.queueFamilyIndices_     },
+    graphicsQueue_       { device.graphicsQueue_          },
+    transferQueue_       { device.transferQueue_          },
+    computeQueue_        { device.computeQueue_           },
+    sharedQueueFamilies_ { device.sharedQueueFamilies_    },
+    commandPool_         { std::move(device.commandPool_) },
+    timelineSemaphores_  { device.timelineSemaphores_     }
 {
 }
 
 VKDevice& VKDevice::operator = (VKDevice&& device)
 {
-    device_             = std::move(device.device_);
-    queueFamilyIndices_ = device.queueFamilyIndices_;
-    graphicsQueue_      = device.graphicsQueue_;
-    commandPool_        = std::move(device.commandPool_);
+    device_                 = std::move(device.device_);
+    queueFamilyIndices_     = device.queueFamilyIndices_;
+    graphicsQueue_          = device.graphicsQueue_;
+    transferQueue_          = device.transferQueue_;
+    computeQueue_           = device.computeQueue_;
+    sharedQueueFamilies_    = device.sharedQueueFamilies_;
+    commandPool_            = std::move(device.commandPool_);
+    timelineSemaphores_     = device.timelineSemaphores_;
     return *this;
 }
 
 void VKDevice::WaitIdle()
 {
+    std::lock_guard<std::recursive_mutex> guard{ mutex_ };
     vkDeviceWaitIdle(device_);
 }
 
 // Device-only layers are deprecated -> set 'enabledLayerCount' and 'ppEnabledLayerNames' members to zero during device creation.
 // see https://www.khronos.org/registry/vulkan/specs/1.0/html/vkspec.html#extended-functionality-device-layer-deprecation
 void VKDevice::CreateLogicalDevice(
-    VkPhysicalDevice                physicalDevice,
-    const VkPhysicalDeviceFeatures* features,
-    const char* const*              extensions,
-    std::uint32_t                   numExtensions)
+    VkPhysicalDevice                                        physicalDevice,
+    const VkPhysicalDeviceFeatures*                         features,
+    const char* const*                                      extensions,
+    std::uint32_t                                           numExtensions,
+    bool                                                    dedicatedTransferQueue,
+    bool                                                    asyncComputeQueue,
+    bool                                                    timelineSemaphores,
+    const VkPhysicalDeviceDescriptorIndexingFeaturesEXT*    descriptorIndexingFeatures,
+    bool                                                    dynamicRendering,
+    bool                                                    graphicsPipelineLibrary,
+    bool                                                    meshShaders,
+    bool                                                    fragmentShadingRate,
+    bool                                                    pageableDeviceLocalMemory)
 {
     /* Initialize queue create description */
     queueFamilyIndices_ = VKFindQueueFamilies(physicalDevice, (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT));
@@ -66,6 +85,25 @@ void VKDevice::CreateLogicalDevice(
     std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
     std::set<std::uint32_t> uniqueQueueFamilies = { queueFamilyIndices_.graphicsFamily, queueFamilyIndices_.presentFamily };
 
+    /* Request an additional queue from a compute-only queue family if enabled and available */
+    if (asyncComputeQueue)
+    {
+        queueFamilyIndices_.computeFamily = VKFindDedicatedComputeQueueFamily(physicalDevice);
+        if (queueFamilyIndices_.computeFamily != QueueFamilyIndices::invalidIndex)
+            uniqueQueueFamilies.insert(queueFamilyIndices_.computeFamily);
+    }
+
+    /*
+    Request an additional queue from a transfer-only queue family if enabled and available.
+    Resources that are shared with the compute queue cannot have their ownership transferred, so uploads remain on the graphics queue in that case.
+    */
+    if (dedicatedTransferQueue && queueFamilyIndices_.computeFamily == QueueFamilyIndices::invalidIndex)
+    {
+        queueFamilyIndices_.transferFamily = VKFindDedicatedTransferQueueFamily(physicalDevice);
+        if (queueFamilyIndices_.transferFamily != QueueFamilyIndices::invalidIndex)
+            uniqueQueueFamilies.insert(queueFamilyIndices_.transferFamily);
+    }
+
     float queuePriority = 1.0f;
     for (auto family : uniqueQueueFamilies)
     {
@@ -81,11 +119,92 @@ void VKDevice::CreateLogicalDevice(
         queueCreateInfos.push_back(info);
     }
 
+    /* Enable timeline semaphore feature of extension "VK_KHR_timeline_semaphore" */
+    VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineSemaphoreFeatures;
+    {
+        timelineSemaphoreFeatures.sType             = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+        timelineSemaphoreFeatures.pNext             = nullptr;
+        timelineSemaphoreFeatures.timelineSemaphore = VK_TRUE;
+    }
+
+    /* Enable all supported features of extension "VK_EXT_descriptor_indexing" that were queried from the physical device */
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptorIndexingFeaturesCopy;
+    const void* featuresChain = (timelineSemaphores ? &timelineSemaphoreFeatures : nullptr);
+
+    if (descriptorIndexingFeatures != nullptr)
+    {
+        descriptorIndexingFeaturesCopy          = *descriptorIndexingFeatures;
+        descriptorIndexingFeaturesCopy.sType    = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+        descriptorIndexingFeaturesCopy.pNext    = const_cast<void*>(featuresChain);
+        featuresChain = &descriptorIndexingFeaturesCopy;
+    }
+
+    /* Enable dynamic rendering feature of extension "VK_KHR_dynamic_rendering" */
+    VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeatures;
+
+    if (dynamicRendering)
+    {
+        dynamicRenderingFeatures.sType              = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+        dynamicRenderingFeatures.pNext              = const_cast<void*>(featuresChain);
+        dynamicRenderingFeatures.dynamicRendering   = VK_TRUE;
+        featuresChain = &dynamicRenderingFeatures;
+    }
+
+    /* Enable graphics pipeline library feature of extension "VK_EXT_graphics_pipeline_library" */
+    VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT graphicsPipelineLibraryFeatures;
+
+    if (graphicsPipelineLibrary)
+    {
+        graphicsPipelineLibraryFeatures.sType                   = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+        graphicsPipelineLibraryFeatures.pNext                   = const_cast<void*>(featuresChain);
+        graphicsPipelineLibraryFeatures.graphicsPipelineLibrary = VK_TRUE;
+        featuresChain = &graphicsPipelineLibraryFeatures;
+    }
+
+    /* Enable task and mesh shader features of extension "VK_EXT_mesh_shader" */
+    VkPhysicalDeviceMeshShaderFeaturesEXT meshShaderFeatures;
+
+    if (meshShaders)
+    {
+        meshShaderFeatures.sType                                    = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT;
+        meshShaderFeatures.pNext                                    = const_cast<void*>(featuresChain);
+        meshShaderFeatures.taskShader                               = VK_TRUE;
+        meshShaderFeatures.meshShader                               = VK_TRUE;
+        meshShaderFeatures.multiviewMeshShader                      = VK_FALSE;
+        meshShaderFeatures.primitiveFragmentShadingRateMeshShader   = VK_FALSE;
+        meshShaderFeatures.meshShaderQueries                        = VK_FALSE;
+        featuresChain = &meshShaderFeatures;
+    }
+
+    /* Enable per-pipeline shading rate feature of extension "VK_KHR_fragment_shading_rate"; attachment shading rates are not used */
+    VkPhysicalDeviceFragmentShadingRateFeaturesKHR fragmentShadingRateFeatures;
+
+    if (fragmentShadingRate)
+    {
+        fragmentShadingRateFeatures.sType                           = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FRAGMENT_SHADING_RATE_FEATURES_KHR;
+        fragmentShadingRateFeatures.pNext                           = const_cast<void*>(featuresChain);
+        fragmentShadingRateFeatures.pipelineFragmentShadingRate     = VK_TRUE;
+        fragmentShadingRateFeatures.primitiveFragmentShadingRate    = VK_FALSE;
+        fragmentShadingRateFeatures.attachmentFragmentShadingRate   = VK_FALSE;
+        featuresChain = &fragmentShadingRateFeatures;
+    }
+
+    /* Enable feature of extension "VK_EXT_pageable_device_local_memory" to change the priorities of device memory allocations */
+    VkPhysicalDevicePageableDeviceLocalMemoryFeaturesEXT pageableDeviceLocalMemoryFeatures;
+
+    if (pageableDeviceLocalMemory)
+    {
+        pageableDeviceLocalMemoryFeatures.sType                     = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PAGEABLE_DEVICE_LOCAL_MEMORY_FEATURES_EXT;
+        pageableDeviceLocalMemoryFeatures.pNext                     = const_cast<void*>(featuresChain);
+        pageableDeviceLocalMemoryFeatures.pageableDeviceLocalMemory = VK_TRUE;
+        featuresChain = &pageableDeviceLocalMemoryFeatures;
+    }
+
     /* Create logical device */
     VkDeviceCreateInfo createInfo;
     {
         createInfo.sType                    = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-        createInfo.pNext                    = nullptr;
+        createInfo.pNext                    = featuresChain;
         createInfo.flags                    = 0;
         createInfo.queueCreateInfoCount     = static_cast<std::uint32_t>(queueCreateInfos.size());
         createInfo.pQueueCreateInfos        = queueCreateInfos.data();
@@ -98,14 +217,29 @@ void VKDevice::CreateLogicalDevice(
     auto result = vkCreateDevice(physicalDevice, &createInfo, nullptr, device_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan logical device");
 
+    timelineSemaphores_ = timelineSemaphores;
+
     /* Query device graphics queue */
     vkGetDeviceQueue(device_, queueFamilyIndices_.graphicsFamily, 0, &graphicsQueue_);
 
+    /* Query device transfer queue */
+    if (queueFamilyIndices_.transferFamily != QueueFamilyIndices::invalidIndex)
+        vkGetDeviceQueue(device_, queueFamilyIndices_.transferFamily, 0, &transferQueue_);
+
+    /* Query device compute queue; resources are shared with the graphics queue family, so no ownership transfers are required */
+    if (queueFamilyIndices_.computeFamily != QueueFamilyIndices::invalidIndex)
+    {
+        vkGetDeviceQueue(device_, queueFamilyIndices_.computeFamily, 0, &computeQueue_);
+        sharedQueueFamilies_.count      = 2;
+        sharedQueueFamilies_.indices[0] = queueFamilyIndices_.graphicsFamily;
+        sharedQueueFamilies_.indices[1] = queueFamilyIndices_.computeFamily;
+    }
+
     /* Create default command pool */
-    commandPool_ = CreateCommandPool();
+    commandPool_ = CreateCommandPool(queueFamilyIndices_.graphicsFamily);
 }
 
-VKPtr<VkCommandPool> VKDevice::CreateCommandPool()
+VKPtr<VkCommandPool> VKDevice::CreateCommandPool(std::uint32_t queueFamilyIndex)
 {
     VKPtr<VkCommandPool> commandPool{ device_, vkDestroyCommandPool };
 
@@ -115,7 +249,7 @@ VKPtr<VkCommandPool> VKDevice::CreateCommandPool()
         createInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
         createInfo.pNext            = nullptr;
         createInfo.flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-        createInfo.queueFamilyIndex = queueFamilyIndices_.graphicsFamily;
+        createInfo.queueFamilyIndex = queueFamilyIndex;
     }
     auto result = vkCreateCommandPool(device_, &createInfo, nullptr, commandPool.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan command pool");
@@ -125,6 +259,8 @@ VKPtr<VkCommandPool> VKDevice::CreateCommandPool()
 
 VkCommandBuffer VKDevice::AllocCommandBuffer(bool begin)
 {
+    std::lock_guard<std::recursive_mutex> guard{ mutex_ };
+
     VkCommandBuffer cmdBuffer = VK_NULL_HANDLE;
 
     /* Allocate new primary level command buffer via staging command pool */
@@ -158,6 +294,8 @@ VkCommandBuffer VKDevice::AllocCommandBuffer(bool begin)
 
 void VKDevice::FlushCommandBuffer(VkCommandBuffer cmdBuffer, bool release)
 {
+    std::lock_guard<std::recursive_mutex> guard{ mutex_ };
+
     /* End command buffer record */
     auto result = vkEndCommandBuffer(cmdBuffer);
     VKThrowIfFailed(result, "failed to end recording Vulkan command buffer");
@@ -173,10 +311,11 @@ void VKDevice::FlushCommandBuffer(VkCommandBuffer cmdBuffer, bool release)
             submitInfo.commandBufferCount   = 1;
             submitInfo.pCommandBuffers      = (&cmdBuffer);
         }
-        vkQueueSubmit(graphicsQueue_, 1, &submitInfo, fence.GetVkFence());
+        VkFence fenceHandle = fence.GetVkFence();
+        vkQueueSubmit(graphicsQueue_, 1, &submitInfo, fenceHandle);
 
         /* Wait for fence to be signaled */
-        fence.Wait(device_, ULLONG_MAX);
+        vkWaitForFences(device_, 1, &fenceHandle, VK_TRUE, ULLONG_MAX);
     }
 
     /* Release command buffer (if enabled) */
@@ -184,6 +323,55 @@ void VKDevice::FlushCommandBuffer(VkCommandBuffer cmdBuffer, bool release)
         vkFreeCommandBuffers(device_, commandPool_, 1, &cmdBuffer);
 }
 
+void VKDevice::BindSparseImageMemory(
+    VkImage                                     image,
+    const std::vector<VkSparseImageMemoryBind>& imageBinds,
+    const std::vector<VkSparseMemoryBind>&      opaqueBinds)
+{
+    if (imageBinds.empty() && opaqueBinds.empty())
+        return;
+
+    std::lock_guard<std::recursive_mutex> guard{ mutex_ };
+
+    VkSparseImageMemoryBindInfo imageBindInfo;
+    {
+        imageBindInfo.image     = image;
+        imageBindInfo.bindCount = static_cast<std::uint32_t>(imageBinds.size());
+        imageBindInfo.pBinds    = imageBinds.data();
+    }
+
+    VkSparseImageOpaqueMemoryBindInfo opaqueBindInfo;
+    {
+        opaqueBindInfo.image        = image;
+        opaqueBindInfo.bindCount    = static_cast<std::uint32_t>(opaqueBinds.size());
+        opaqueBindInfo.pBinds       = opaqueBinds.data();
+    }
+
+    VkBindSparseInfo bindSparseInfo = {};
+    {
+        bindSparseInfo.sType = VK_STRUCTURE_TYPE_BIND_SPARSE_INFO;
+        if (!imageBinds.empty())
+        {
+            bindSparseInfo.imageBindCount   = 1;
+            bindSparseInfo.pImageBinds      = &imageBindInfo;
+        }
+        if (!opaqueBinds.empty())
+        {
+            bindSparseInfo.imageOpaqueBindCount = 1;
+            bindSparseInfo.pImageOpaqueBinds    = &opaqueBindInfo;
+        }
+    }
+
+    /* Submit sparse binding to queue and wait for it to complete, so released memory can be reused immediately */
+    VKFence fence{ device_ };
+    VkFence fenceHandle = fence.GetVkFence();
+
+    auto result = vkQueueBindSparse(graphicsQueue_, 1, &bindSparseInfo, fenceHandle);
+    VKThrowIfFailed(result, "failed to bind sparse memory to Vulkan image");
+
+    vkWaitForFences(device_, 1, &fenceHandle, VK_TRUE, ULLONG_MAX);
+}
+
 // Returns the image aspect for the specified Vulkan format
 static VkImageAspectFlags GetImageAspectForVkFormat(VkFormat format)
 {
@@ -272,6 +460,7 @@ void VKDevice::CopyBuffer(
     VkDeviceSize    srcOffset,
     VkDeviceSize    dstOffset)
 {
+    std::lock_guard<std::recursive_mutex> guard{ mutex_ };
     auto cmdBuffer = AllocCommandBuffer();
     {
         CopyBuffer(cmdBuffer, srcBuffer, dstBuffer, size, srcOffset, dstOffset);
@@ -283,16 +472,19 @@ void VKDevice::CopyTexture(
     VkCommandBuffer     commandBuffer,
     VKTexture&          srcTexture,
     VKTexture&          dstTexture,
-    const VkImageCopy&  region)
+    std::uint32_t       numRegions,
+    const VkImageCopy*  regions,
+    VkImageLayout       srcLayout,
+    VkImageLayout       dstLayout)
 {
     vkCmdCopyImage(
         commandBuffer,
         srcTexture.GetVkImage(),
-        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+        srcLayout,
         dstTexture.GetVkImage(),
-        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-        1,
-        &region
+        dstLayout,
+        numRegions,
+        regions
     );
 }
 
@@ -303,13 +495,16 @@ void VKDevice::CopyBufferToImage(
     VkFormat                    format,
     const VkOffset3D&           offset,
     const VkExtent3D&           extent,
-    const TextureSubresource&   subresource)
+    const TextureSubresource&   subresource,
+    VkDeviceSize                srcBufferOffset,
+    std::uint32_t               bufferRowLength,
+    std::uint32_t               bufferImageHeight)
 {
     VkBufferImageCopy region;
     {
-        region.bufferOffset                     = 0;
-        region.bufferRowLength                  = 0;
-        region.bufferImageHeight                = 0;
+        region.bufferOffset                     = srcBufferOffset;
+        region.bufferRowLength                  = bufferRowLength;
+        region.bufferImageHeight                = bufferImageHeight;
         region.imageSubresource.aspectMask      = GetImageAspectForVkFormat(format);
         region.imageSubresource.mipLevel        = subresource.baseMipLevel;
         region.imageSubresource.baseArrayLayer  = subresource.baseArrayLayer;
@@ -369,13 +564,33 @@ void VKDevice::CopyImageToBuffer(
     vkCmdCopyImageToBuffer(
         commandBuffer,
         srcTexture.GetVkImage(),
-        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
         dstBuffer.GetVkBuffer(),
         1,
         &region
     );
 }
 
+void VKDevice::GenerateMips(
+    VkCommandBuffer             commandBuffer,
+    VKTexture&                  texture,
+    const TextureSubresource&   subresource)
+{
+    /* Prefer compute-based MIP-map generation and fall back to image blits for unsupported textures and formats */
+    if (!VKMipGenerator::Get().GenerateMips(commandBuffer, texture, subresource))
+        GenerateMips(commandBuffer, texture.GetVkImage(), texture.GetVkFormat(), texture.GetVkExtent(), subresource);
+}
+
+static VkExtent3D GetNextMipExtent(const VkExtent3D& extent)
+{
+    return VkExtent3D
+    {
+        std::max(1u, extent.width  / 2),
+        std::max(1u, extent.height / 2),
+        std::max(1u, extent.depth  / 2)
+    };
+}
+
 void VKDevice::GenerateMips(
     VkCommandBuffer             commandBuffer,
     VkImage                     image,
@@ -392,124 +607,125 @@ void VKDevice::GenerateMips(
         subresource
     );
 
-    /* Initialize image memory barrier */
-    VkImageMemoryBarrier barrier;
+    /*
+    Initialize image memory barriers: [0] transitions the level before the previous one back to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+    and [1] transitions the previous level to VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, so each MIP level only requires a single barrier batch.
+    All array layers are transitioned and blitted at once.
+    */
+    VkImageMemoryBarrier barriers[2];
 
     const VkImageAspectFlags aspectMask = GetImageAspectForVkFormat(format);
 
-    barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    barrier.pNext                           = nullptr;
-    barrier.srcAccessMask                   = 0;
-    barrier.dstAccessMask                   = 0;
-    barrier.oldLayout                       = VK_IMAGE_LAYOUT_UNDEFINED;
-    barrier.newLayout                       = VK_IMAGE_LAYOUT_UNDEFINED;
-    barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
-    barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
-    barrier.image                           = image;
-    barrier.subresourceRange.aspectMask     = aspectMask;
-    barrier.subresourceRange.baseMipLevel   = subresource.baseMipLevel;
-    barrier.subresourceRange.levelCount     = 1;
-    barrier.subresourceRange.baseArrayLayer = subresource.baseArrayLayer;
-    barrier.subresourceRange.layerCount     = 1;
+    for (auto& barrier : barriers)
+    {
+        barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.pNext                           = nullptr;
+        barrier.srcAccessMask                   = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask                   = VK_ACCESS_TRANSFER_READ_BIT;
+        barrier.oldLayout                       = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout                       = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image                           = image;
+        barrier.subresourceRange.aspectMask     = aspectMask;
+        barrier.subresourceRange.baseMipLevel   = subresource.baseMipLevel;
+        barrier.subresourceRange.levelCount     = 1;
+        barrier.subresourceRange.baseArrayLayer = subresource.baseArrayLayer;
+        barrier.subresourceRange.layerCount     = subresource.numArrayLayers;
+    }
+
+    barriers[0].srcAccessMask   = VK_ACCESS_TRANSFER_READ_BIT;
+    barriers[0].dstAccessMask   = VK_ACCESS_SHADER_READ_BIT;
+    barriers[0].oldLayout       = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    barriers[0].newLayout       = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    /* Determine extent of the first MIP level within the subresource */
+    auto currExtent = extent;
+    for (std::uint32_t mipLevel = 0; mipLevel < subresource.baseMipLevel; ++mipLevel)
+        currExtent = GetNextMipExtent(currExtent);
 
     /* Blit each MIP-map from previous (lower) MIP level */
-    for (std::uint32_t arrayLayer = 0; arrayLayer < subresource.numArrayLayers; ++arrayLayer)
+    for (std::uint32_t mipLevel = 1; mipLevel < subresource.numMipLevels; ++mipLevel)
     {
-        auto currExtent = extent;
+        /* Determine extent of next MIP level */
+        const auto nextExtent = GetNextMipExtent(currExtent);
 
-        for (std::uint32_t mipLevel = 1; mipLevel < subresource.numMipLevels; ++mipLevel)
-        {
-            /* Determine extent of next MIP level */
-            auto nextExtent = currExtent;
-
-            nextExtent.width    = std::max(1u, currExtent.width  / 2);
-            nextExtent.height   = std::max(1u, currExtent.height / 2);
-            nextExtent.depth    = std::max(1u, currExtent.depth  / 2);
-
-            /* Transition previous MIP level to VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL */
-            barrier.srcAccessMask                   = VK_ACCESS_TRANSFER_WRITE_BIT;
-            barrier.dstAccessMask                   = VK_ACCESS_TRANSFER_READ_BIT;
-            barrier.oldLayout                       = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-            barrier.newLayout                       = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-            barrier.subresourceRange.baseMipLevel   = subresource.baseMipLevel + mipLevel - 1;
-            barrier.subresourceRange.baseArrayLayer = subresource.baseArrayLayer + arrayLayer;
-
-            vkCmdPipelineBarrier(
-                commandBuffer,
-                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
-                0, nullptr,
-                0, nullptr,
-                1, &barrier
-            );
-
-            /* Blit previous MIP level into next higher MIP level (with smaller extent) */
-            VkImageBlit blit;
-
-            blit.srcSubresource.aspectMask      = aspectMask;
-            blit.srcSubresource.mipLevel        = subresource.baseMipLevel + mipLevel - 1;
-            blit.srcSubresource.baseArrayLayer  = subresource.baseArrayLayer + arrayLayer;
-            blit.srcSubresource.layerCount      = 1;
-            blit.srcOffsets[0]                  = { 0, 0, 0 };
-            blit.srcOffsets[1].x                = static_cast<std::int32_t>(currExtent.width);
-            blit.srcOffsets[1].y                = static_cast<std::int32_t>(currExtent.height);
-            blit.srcOffsets[1].z                = static_cast<std::int32_t>(currExtent.depth);
-            blit.dstSubresource.aspectMask      = aspectMask;
-            blit.dstSubresource.mipLevel        = subresource.baseMipLevel + mipLevel;
-            blit.dstSubresource.baseArrayLayer  = subresource.baseArrayLayer + arrayLayer;
-            blit.dstSubresource.layerCount      = 1;
-            blit.dstOffsets[0]                  = { 0, 0, 0 };
-            blit.dstOffsets[1].x                = static_cast<std::int32_t>(nextExtent.width);
-            blit.dstOffsets[1].y                = static_cast<std::int32_t>(nextExtent.height);
-            blit.dstOffsets[1].z                = static_cast<std::int32_t>(nextExtent.depth);
-
-            vkCmdBlitImage(
-                commandBuffer,
-                image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                1, &blit,
-                VK_FILTER_LINEAR
-            );
-
-            /* Transition previous MIP level back to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL */
-            barrier.srcAccessMask   = VK_ACCESS_TRANSFER_READ_BIT;
-            barrier.dstAccessMask   = VK_ACCESS_SHADER_READ_BIT;
-            barrier.oldLayout       = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-            barrier.newLayout       = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-            vkCmdPipelineBarrier(
-                commandBuffer,
-                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
-                0, nullptr,
-                0, nullptr,
-                1, &barrier
-            );
-
-            /* Reduce image extent to next MIP level */
-            currExtent = nextExtent;
-        }
+        /* Transition previous MIP level to VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, and the one before back to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL */
+        barriers[1].subresourceRange.baseMipLevel = subresource.baseMipLevel + mipLevel - 1;
 
-        /* Transition last MIP level back to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL */
-        barrier.srcAccessMask                   = VK_ACCESS_TRANSFER_WRITE_BIT;
-        barrier.dstAccessMask                   = VK_ACCESS_SHADER_READ_BIT;
-        barrier.oldLayout                       = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        barrier.newLayout                       = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        barrier.subresourceRange.baseMipLevel   = subresource.numMipLevels - 1;
+        const bool hasReadBarrier = (mipLevel > 1);
+        if (hasReadBarrier)
+            barriers[0].subresourceRange.baseMipLevel = subresource.baseMipLevel + mipLevel - 2;
 
         vkCmdPipelineBarrier(
             commandBuffer,
-            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            (hasReadBarrier ? VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT : VK_PIPELINE_STAGE_TRANSFER_BIT),
+            0,
             0, nullptr,
             0, nullptr,
-            1, &barrier
+            (hasReadBarrier ? 2 : 1), (hasReadBarrier ? &barriers[0] : &barriers[1])
         );
+
+        /* Blit previous MIP level into next higher MIP level (with smaller extent) for all array layers */
+        VkImageBlit blit;
+
+        blit.srcSubresource.aspectMask      = aspectMask;
+        blit.srcSubresource.mipLevel        = subresource.baseMipLevel + mipLevel - 1;
+        blit.srcSubresource.baseArrayLayer  = subresource.baseArrayLayer;
+        blit.srcSubresource.layerCount      = subresource.numArrayLayers;
+        blit.srcOffsets[0]                  = { 0, 0, 0 };
+        blit.srcOffsets[1].x                = static_cast<std::int32_t>(currExtent.width);
+        blit.srcOffsets[1].y                = static_cast<std::int32_t>(currExtent.height);
+        blit.srcOffsets[1].z                = static_cast<std::int32_t>(currExtent.depth);
+        blit.dstSubresource.aspectMask      = aspectMask;
+        blit.dstSubresource.mipLevel        = subresource.baseMipLevel + mipLevel;
+        blit.dstSubresource.baseArrayLayer  = subresource.baseArrayLayer;
+        blit.dstSubresource.layerCount      = subresource.numArrayLayers;
+        blit.dstOffsets[0]                  = { 0, 0, 0 };
+        blit.dstOffsets[1].x                = static_cast<std::int32_t>(nextExtent.width);
+        blit.dstOffsets[1].y                = static_cast<std::int32_t>(nextExtent.height);
+        blit.dstOffsets[1].z                = static_cast<std::int32_t>(nextExtent.depth);
+
+        vkCmdBlitImage(
+            commandBuffer,
+            image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            1, &blit,
+            VK_FILTER_LINEAR
+        );
+
+        /* Reduce image extent to next MIP level */
+        currExtent = nextExtent;
     }
+
+    /* Transition the last two MIP levels back to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL */
+    const std::uint32_t lastMipLevel = subresource.baseMipLevel + subresource.numMipLevels - 1;
+
+    barriers[0].subresourceRange.baseMipLevel   = lastMipLevel - 1;
+    barriers[1].srcAccessMask                   = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barriers[1].dstAccessMask                   = VK_ACCESS_SHADER_READ_BIT;
+    barriers[1].oldLayout                       = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barriers[1].newLayout                       = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    barriers[1].subresourceRange.baseMipLevel   = lastMipLevel;
+
+    const bool hasReadBarrier = (subresource.numMipLevels > 1);
+
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+        0, nullptr,
+        0, nullptr,
+        (hasReadBarrier ? 2 : 1), (hasReadBarrier ? &barriers[0] : &barriers[1])
+    );
 }
 
 void VKDevice::WriteBuffer(VKDeviceBuffer& buffer, const void* data, VkDeviceSize size, VkDeviceSize offset)
 {
     if (auto region = buffer.GetMemoryRegion())
     {
-        /* Map buffer memory to host memory */
+        /* Map buffer memory to host memory; the memory chunk might be shared with buffers of other threads */
+        std::lock_guard<std::recursive_mutex> guard{ mutex_ };
         auto deviceMemory = region->GetParentChunk();
         if (auto memory = deviceMemory->Map(device_, region->GetOffset() + offset, size))
         {
@@ -524,7 +740,8 @@ void VKDevice::ReadBuffer(VKDeviceBuffer& buffer, void* data, VkDeviceSize size,
 {
     if (auto region = buffer.GetMemoryRegion())
     {
-        /* Map buffer memory to host memory */
+        /* Map buffer memory to host memory; the memory chunk might be shared with buffers of other threads */
+        std::lock_guard<std::recursive_mutex> guard{ mutex_ };
         auto deviceMemory = region->GetParentChunk();
         if (auto memory = deviceMemory->Map(device_, region->GetOffset() + offset, size))
         {
@@ -14,6 +14,8 @@
 #include "VKPtr.h"
 #include "VKCore.h"
 #include "Buffer/VKDeviceBuffer.h"
+#include <mutex>
+#include <vector>
 
 
 namespace LLGL
@@ -36,10 +38,19 @@ class VKDevice
         VKDevice& operator = (VKDevice&& device);
 
         void CreateLogicalDevice(
-            VkPhysicalDevice                physicalDevice,
-            const VkPhysicalDeviceFeatures* features,
-            const char* const*              extensions,
-            std::uint32_t                   numExtensions
+            VkPhysicalDevice                                        physicalDevice,
+            const VkPhysicalDeviceFeatures*                         features,
+            const char* const*                                      extensions,
+            std::uint32_t                                           numExtensions,
+            bool                                                    dedicatedTransferQueue      = false,
+            bool                                                    asyncComputeQueue           = false,
+            bool                                                    timelineSemaphores          = false,
+            const VkPhysicalDeviceDescriptorIndexingFeaturesEXT*    descriptorIndexingFeatures  = nullptr,
+            bool                                                    dynamicRendering            = false,
+            bool                                                    graphicsPipelineLibrary     = false,
+            bool                                                    meshShaders                 = false,
+            bool                                                    fragmentShadingRate         = false,
+            bool                                                    pageableDeviceLocalMemory   = false
         );
 
         // Blocks until the VkDevice becomes idle.
@@ -47,10 +58,14 @@ class VKDevice
 
         /* ----- Allocation ----- */
 
-        VKPtr<VkCommandPool> CreateCommandPool();
+        VKPtr<VkCommandPool> CreateCommandPool(std::uint32_t queueFamilyIndex);
 
         /* ----- Queue ----- */
 
+        /*
+        Allocates a command buffer from the device command pool. Recording into this command buffer until FlushCommandBuffer
+        must be guarded by the device mutex if the render system is used from multiple threads (see GetMutex).
+        */
         VkCommandBuffer AllocCommandBuffer(bool begin = true);
         void FlushCommandBuffer(VkCommandBuffer cmdBuffer, bool release = true);
 
@@ -86,7 +101,10 @@ class VKDevice
             VkCommandBuffer     commandBuffer,
             VKTexture&          srcTexture,
             VKTexture&          dstTexture,
-            const VkImageCopy&  region
+            std::uint32_t       numRegions,
+            const VkImageCopy*  regions,
+            VkImageLayout       srcLayout       = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            VkImageLayout       dstLayout       = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
         );
 
         // Copies the source buffer into the destination image (numMipLevels must be 1).
@@ -97,7 +115,10 @@ class VKDevice
             VkFormat                    format,
             const VkOffset3D&           offset,
             const VkExtent3D&           extent,
-            const TextureSubresource&   subresource
+            const TextureSubresource&   subresource,
+            VkDeviceSize                srcBufferOffset     = 0,
+            std::uint32_t               bufferRowLength     = 0,
+            std::uint32_t               bufferImageHeight   = 0
         );
 
         void CopyBufferToImage(
@@ -125,6 +146,14 @@ class VKDevice
             const VkBufferImageCopy&    region
         );
 
+        // Generates the MIP-maps of the specified texture with compute shaders if supported, or with image blits otherwise.
+        void GenerateMips(
+            VkCommandBuffer             commandBuffer,
+            VKTexture&                  texture,
+            const TextureSubresource&   subresource
+        );
+
+        // Generates the MIP-maps of the specified image with one image blit and a single barrier batch per MIP level.
         void GenerateMips(
             VkCommandBuffer             commandBuffer,
             VkImage                     image,
@@ -133,6 +162,16 @@ class VKDevice
             const TextureSubresource&   subresource
         );
 
+        /*
+        Binds the specified memory ranges to a sparse image on the graphics queue and blocks until the binding has completed.
+        Image binds refer to tiles of regular MIP-map levels and opaque binds refer to the MIP-map tail of the image.
+        */
+        void BindSparseImageMemory(
+            VkImage                                     image,
+            const std::vector<VkSparseImageMemoryBind>& imageBinds,
+            const std::vector<VkSparseMemoryBind>&      opaqueBinds
+        );
+
         void WriteBuffer(VKDeviceBuffer& buffer, const void* data, VkDeviceSize size, VkDeviceSize offset = 0);
         void ReadBuffer(VKDeviceBuffer& buffer, void* data, VkDeviceSize size, VkDeviceSize offset = 0);
         void FlushMappedBuffer(VKDeviceBuffer& buffer, VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
@@ -169,18 +208,56 @@ class VKDevice
             return graphicsQueue_;
         }
 
+        // Returns the native VkQueue handle of the dedicated transfer queue, or VK_NULL_HANDLE if there is none.
+        inline VkQueue GetVkTransferQueue() const
+        {
+            return transferQueue_;
+        }
+
+        // Returns the native VkQueue handle of the asynchronous compute queue, or VK_NULL_HANDLE if there is none.
+        inline VkQueue GetVkComputeQueue() const
+        {
+            return computeQueue_;
+        }
+
+        // Returns the queue families that buffers and textures are shared between, i.e. the graphics and asynchronous compute queue families.
+        inline const VKSharedQueueFamilies& GetSharedQueueFamilies() const
+        {
+            return sharedQueueFamilies_;
+        }
+
         // Returns the native VkCommandPool handle.
         inline const VKPtr<VkCommandPool>& GetVkCommandPool() const
         {
             return commandPool_;
         }
 
+        // Returns true if the device was created with the "timelineSemaphore" feature of the "VK_KHR_timeline_semaphore" extension.
+        inline bool HasTimelineSemaphores() const
+        {
+            return timelineSemaphores_;
+        }
+
+        /*
+        Returns the mutex that guards the device queues and the device command pool, since both must be externally synchronized in Vulkan.
+        This is a recursive mutex, so functions that lock it internally can be called while it is already locked.
+        */
+        inline std::recursive_mutex& GetMutex()
+        {
+            return mutex_;
+        }
+
     private:
 
         VKPtr<VkDevice>         device_;
         QueueFamilyIndices      queueFamilyIndices_;
         VkQueue                 graphicsQueue_      = VK_NULL_HANDLE;
+        VkQueue                 transferQueue_      = VK_NULL_HANDLE;
+        VkQueue                 computeQueue_       = VK_NULL_HANDLE;
+        VKSharedQueueFamilies   sharedQueueFamilies_;
         VKPtr<VkCommandPool>    commandPool_;
+        bool                    timelineSemaphores_ = false;
+        std::recursive_mutex    mutex_;
 
 };
 
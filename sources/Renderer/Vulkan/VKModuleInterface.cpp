@@ -34,6 +34,20 @@ namespace ModuleVulkan
     {
         return new VKRenderSystem(*renderSystemDesc);
     }
+
+    void QueryVideoAdapters(const LLGL::RenderSystemDescriptor* /*renderSystemDesc*/, std::vector<LLGL::VideoAdapterDescriptor>& outAdapters)
+    {
+        /* Enumerate physical devices with a temporary instance, since this requires neither layers nor extensions */
+        VkInstanceCreateInfo instanceInfo = {};
+        instanceInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+
+        VkInstance instance = VK_NULL_HANDLE;
+        if (vkCreateInstance(&instanceInfo, nullptr, &instance) == VK_SUCCESS)
+        {
+            VKPhysicalDevice::QueryVideoAdapters(instance, outAdapters);
+            vkDestroyInstance(instance, nullptr);
+        }
+    }
 } // /namespace ModuleVulkan
 
 
@@ -69,6 +83,19 @@ LLGL_EXPORT void* LLGL_RenderSystem_Alloc(const void* renderSystemDesc, int rend
     return nullptr;
 }
 
+LLGL_EXPORT int LLGL_RenderSystem_QueryVideoAdapters(const void* renderSystemDesc, int renderSystemDescSize, void* outAdapters)
+{
+    if (renderSystemDesc != nullptr && static_cast<std::size_t>(renderSystemDescSize) == sizeof(LLGL::RenderSystemDescriptor) && outAdapters != nullptr)
+    {
+        auto desc       = reinterpret_cast<const LLGL::RenderSystemDescriptor*>(renderSystemDesc);
+        auto adapters   = reinterpret_cast<std::vector<LLGL::VideoAdapterDescriptor>*>(outAdapters);
+        const auto numAdapters = adapters->size();
+        LLGL::ModuleVulkan::QueryVideoAdapters(desc, *adapters);
+        return static_cast<int>(adapters->size() - numAdapters);
+    }
+    return 0;
+}
+
 } // /extern "C"
 
 #endif // /LLGL_BUILD_STATIC_LIB
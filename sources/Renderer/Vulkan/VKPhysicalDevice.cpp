@@ -15,6 +15,7 @@
 #include <cstring>
 #include <set>
 #include <limits>
+#include <algorithm>
 
 
 namespace LLGL
@@ -28,6 +29,21 @@ static const char* g_requiredVulkanExtensions[] =
     nullptr,
 };
 
+// Headless render systems don't need any window system integration (WSI) extensions
+static const char* g_requiredVulkanExtensionsHeadless[] =
+{
+    VK_KHR_MAINTENANCE1_EXTENSION_NAME,
+    nullptr,
+};
+
+static std::size_t GetNumExtensions(const char* const* extensions)
+{
+    std::size_t n = 0;
+    while (extensions[n] != nullptr)
+        ++n;
+    return n;
+}
+
 static bool CheckDeviceExtensionSupport(
     VkPhysicalDevice                    physicalDevice,
     const char* const*                  requiredExtensions,
@@ -52,14 +68,15 @@ static bool CheckDeviceExtensionSupport(
 
 static bool IsPhysicalDeviceSuitable(
     VkPhysicalDevice                    physicalDevice,
+    const char* const*                  requiredExtensions,
     std::vector<VkExtensionProperties>& supportedExtensions)
 {
     /* Check if physical devices supports at least these extensions */
     std::vector<VkExtensionProperties> extensions;
     bool suitable = CheckDeviceExtensionSupport(
         physicalDevice,
-        g_requiredVulkanExtensions,
-        (sizeof(g_requiredVulkanExtensions) / sizeof(g_requiredVulkanExtensions[0]) - 1),
+        requiredExtensions,
+        GetNumExtensions(requiredExtensions),
         extensions
     );
 
@@ -73,37 +90,120 @@ static bool IsPhysicalDeviceSuitable(
     return false;
 }
 
-bool VKPhysicalDevice::PickPhysicalDevice(VkInstance instance)
+bool VKPhysicalDevice::PickPhysicalDevice(VkInstance instance, bool headless, int deviceIndex)
 {
+    const char** requiredExtensions = (headless ? g_requiredVulkanExtensionsHeadless : g_requiredVulkanExtensions);
+
     /* Query all physical devices and pick suitable */
     auto physicalDevices = VKQueryPhysicalDevices(instance);
 
-    for (const auto& device : physicalDevices)
+    /* Only consider the explicitly selected device */
+    std::size_t firstIndex = 0;
+    if (deviceIndex >= 0)
     {
-        if (IsPhysicalDeviceSuitable(device, supportedExtensions_))
-        {
-            /* Store reference to all extension names */
-            for (const auto& extension : supportedExtensions_)
-                supportedExtensionNames_.insert(extension.extensionName);
+        if (static_cast<std::size_t>(deviceIndex) >= physicalDevices.size())
+            return false;
+        physicalDevices = { physicalDevices[deviceIndex] };
+        firstIndex = static_cast<std::size_t>(deviceIndex);
+    }
 
-            if (!EnableExtensions(g_requiredVulkanExtensions, true))
+    for (std::size_t i = 0; i < physicalDevices.size(); ++i)
+    {
+        if (IsPhysicalDeviceSuitable(physicalDevices[i], requiredExtensions, supportedExtensions_))
+        {
+            if (InitPhysicalDevice(physicalDevices[i], requiredExtensions, headless))
             {
-                /* Stop considering this physical device, because some required extensions are not supported */
-                supportedExtensionNames_.clear();
-                continue;
+                deviceIndex_ = static_cast<int>(firstIndex + i);
+                return true;
             }
+        }
+    }
 
-            EnableExtensions(GetOptionalExtensions());
+    return false;
+}
 
-            /* Store device and store properties */
-            physicalDevice_ = device;
-            QueryDeviceInfo();
+bool VKPhysicalDevice::PickPhysicalDeviceFromProfile(VkInstance instance, bool headless, int deviceIndex, const VKAdapterProfile& profile)
+{
+    /* Only the device of the profile can be picked without enumerating its extensions */
+    if (profile.deviceIndex < 0 || (deviceIndex >= 0 && deviceIndex != profile.deviceIndex))
+        return false;
 
-            return true;
-        }
+    auto physicalDevices = VKQueryPhysicalDevices(instance);
+    if (static_cast<std::size_t>(profile.deviceIndex) >= physicalDevices.size())
+        return false;
+
+    /* Reject profile if the device or its driver has changed since the profile was written */
+    VkPhysicalDevice device = physicalDevices[profile.deviceIndex];
+    if (!VKMatchesAdapterProfile(device, profile))
+        return false;
+
+    const char** requiredExtensions = (headless ? g_requiredVulkanExtensionsHeadless : g_requiredVulkanExtensions);
+
+    supportedExtensions_ = profile.deviceExtensions;
+    if (!InitPhysicalDevice(device, requiredExtensions, headless))
+    {
+        supportedExtensions_.clear();
+        return false;
     }
 
-    return false;
+    deviceIndex_ = profile.deviceIndex;
+
+    return true;
+}
+
+void VKPhysicalDevice::StoreAdapterProfile(VKAdapterProfile& outProfile) const
+{
+    outProfile.deviceIndex      = deviceIndex_;
+    outProfile.vendorID         = properties_.vendorID;
+    outProfile.deviceID         = properties_.deviceID;
+    outProfile.driverVersion    = properties_.driverVersion;
+    std::memcpy(outProfile.pipelineCacheUUID, properties_.pipelineCacheUUID, VK_UUID_SIZE);
+    outProfile.deviceExtensions = supportedExtensions_;
+}
+
+static long GetVideoAdapterFlags(VkPhysicalDeviceType deviceType)
+{
+    switch (deviceType)
+    {
+        case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:      return VideoAdapterFlags::Discrete;
+        case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:    return VideoAdapterFlags::Integrated;
+        case VK_PHYSICAL_DEVICE_TYPE_CPU:               return VideoAdapterFlags::Software;
+        default:                                        return 0;
+    }
+}
+
+void VKPhysicalDevice::QueryVideoAdapters(VkInstance instance, std::vector<VideoAdapterDescriptor>& outAdapters)
+{
+    for (const auto& device : VKQueryPhysicalDevices(instance))
+    {
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(device, &properties);
+
+        VkPhysicalDeviceMemoryProperties memoryProperties;
+        vkGetPhysicalDeviceMemoryProperties(device, &memoryProperties);
+
+        VideoAdapterDescriptor adapterDesc;
+        {
+            const std::string deviceName = properties.deviceName;
+            adapterDesc.name        = std::wstring(deviceName.begin(), deviceName.end());
+            adapterDesc.vendor      = GetVendorByID(static_cast<unsigned short>(properties.vendorID));
+            adapterDesc.vendorID    = properties.vendorID;
+            adapterDesc.deviceID    = properties.deviceID;
+            adapterDesc.flags       = GetVideoAdapterFlags(properties.deviceType);
+        }
+
+        /* Accumulate device local heaps as dedicated memory and all other heaps as shared memory */
+        for (std::uint32_t i = 0; i < memoryProperties.memoryHeapCount; ++i)
+        {
+            const auto& heap = memoryProperties.memoryHeaps[i];
+            if ((heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0)
+                adapterDesc.videoMemory += heap.size;
+            else
+                adapterDesc.sharedMemory += heap.size;
+        }
+
+        outAdapters.push_back(std::move(adapterDesc));
+    }
 }
 
 static std::vector<Format> GetDefaultSupportedVKTextureFormats()
@@ -189,15 +289,24 @@ void VKPhysicalDevice::QueryDeviceProperties(
     caps.features.hasTessellationShaders            = (features_.tessellationShader != VK_FALSE);
     caps.features.hasTessellatorStage               = caps.features.hasTessellationShaders;
     caps.features.hasComputeShaders                 = true;
+    caps.features.hasMeshShaders                    = SupportsMeshShaders();
     caps.features.hasInstancing                     = true;
     caps.features.hasOffsetInstancing               = true;
     caps.features.hasIndirectDrawing                = (features_.drawIndirectFirstInstance != VK_FALSE);
+    caps.features.hasIndirectCountDrawing           = SupportsExtension(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
     caps.features.hasViewportArrays                 = (features_.multiViewport != VK_FALSE);
     caps.features.hasConservativeRasterization      = SupportsExtension(VK_EXT_CONSERVATIVE_RASTERIZATION_EXTENSION_NAME);
+    caps.features.hasVariableRateShading            = SupportsFragmentShadingRate();
     caps.features.hasStreamOutputs                  = SupportsExtension(VK_EXT_TRANSFORM_FEEDBACK_EXTENSION_NAME);
     caps.features.hasLogicOp                        = (features_.logicOp != VK_FALSE);
     caps.features.hasPipelineStatistics             = (features_.pipelineStatisticsQuery != VK_FALSE);
     caps.features.hasRenderCondition                = SupportsExtension(VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME);
+    caps.features.hasNativeCommandLists             = true;
+    caps.features.hasSparseTextures                 = SupportsSparseTextures();
+    caps.features.hasDescriptorIndexing             = SupportsDescriptorIndexing();
+    caps.features.hasFramebufferFetch               = true; // via input attachments
+    caps.features.hasExternalMemory                 = SupportsExternalMemory();
+    caps.features.hasResidencyPriorities            = SupportsPageableDeviceLocalMemory();
 
     /* Query limits */
     caps.limits.lineWidthRange[0]                   = limits.lineWidthRange[0];
@@ -216,6 +325,12 @@ void VKPhysicalDevice::QueryDeviceProperties(
     caps.limits.maxComputeShaderWorkGroupSize[0]    = limits.maxComputeWorkGroupSize[0];
     caps.limits.maxComputeShaderWorkGroupSize[1]    = limits.maxComputeWorkGroupSize[1];
     caps.limits.maxComputeShaderWorkGroupSize[2]    = limits.maxComputeWorkGroupSize[2];
+    if (SupportsMeshShaders())
+    {
+        caps.limits.maxMeshShaderWorkGroups[0]      = meshShaderProps_.maxTaskWorkGroupCount[0];
+        caps.limits.maxMeshShaderWorkGroups[1]      = meshShaderProps_.maxTaskWorkGroupCount[1];
+        caps.limits.maxMeshShaderWorkGroups[2]      = meshShaderProps_.maxTaskWorkGroupCount[2];
+    }
     caps.limits.maxViewports                        = std::min(limits.maxViewports, LLGL_MAX_NUM_VIEWPORTS_AND_SCISSORS);
     caps.limits.maxViewportSize[0]                  = limits.maxViewportDimensions[0];
     caps.limits.maxViewportSize[1]                  = limits.maxViewportDimensions[1];
@@ -239,14 +354,47 @@ void VKPhysicalDevice::QueryDeviceProperties(
     */
 }
 
-VKDevice VKPhysicalDevice::CreateLogicalDevice()
+// Sparse textures are bound on the graphics queue, so that queue family must support sparse binding
+bool VKPhysicalDevice::SupportsSparseTextures() const
+{
+    if (features_.sparseBinding == VK_FALSE || features_.sparseResidencyImage2D == VK_FALSE)
+        return false;
+
+    const auto queueFamilyIndices   = VKFindQueueFamilies(physicalDevice_, (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT));
+    const auto queueFamilies        = VKQueryQueueFamilyProperties(physicalDevice_);
+
+    if (queueFamilyIndices.graphicsFamily >= queueFamilies.size())
+        return false;
+
+    return ((queueFamilies[queueFamilyIndices.graphicsFamily].queueFlags & VK_QUEUE_SPARSE_BINDING_BIT) != 0);
+}
+
+bool VKPhysicalDevice::SupportsExternalMemory() const
+{
+    #ifdef LLGL_OS_WIN32
+    return (SupportsExtension(VK_KHR_EXTERNAL_MEMORY_EXTENSION_NAME) && SupportsExtension(VK_KHR_EXTERNAL_MEMORY_WIN32_EXTENSION_NAME));
+    #else
+    return (SupportsExtension(VK_KHR_EXTERNAL_MEMORY_EXTENSION_NAME) && SupportsExtension(VK_KHR_EXTERNAL_MEMORY_FD_EXTENSION_NAME));
+    #endif
+}
+
+VKDevice VKPhysicalDevice::CreateLogicalDevice(bool dedicatedTransferQueue, bool asyncComputeQueue)
 {
     VKDevice device;
     device.CreateLogicalDevice(
         physicalDevice_,
         &features_,
         enabledExtensionNames_.data(),
-        static_cast<std::uint32_t>(enabledExtensionNames_.size())
+        static_cast<std::uint32_t>(enabledExtensionNames_.size()),
+        dedicatedTransferQueue,
+        asyncComputeQueue,
+        SupportsTimelineSemaphores(),
+        (SupportsDescriptorIndexing() ? &descriptorIndexingFeatures_ : nullptr),
+        SupportsDynamicRendering(),
+        SupportsGraphicsPipelineLibrary(),
+        SupportsMeshShaders(),
+        SupportsFragmentShadingRate(),
+        SupportsPageableDeviceLocalMemory()
     );
     return device;
 }
@@ -258,15 +406,65 @@ std::uint32_t VKPhysicalDevice::FindMemoryType(std::uint32_t memoryTypeBits, VkM
 
 bool VKPhysicalDevice::SupportsExtension(const char* extension) const
 {
-    auto it = std::find_if(
-        supportedExtensionNames_.begin(),
-        supportedExtensionNames_.end(),
-        [extension](const char* entry)
-        {
-            return (std::strcmp(extension, entry) == 0);
-        }
+    return (supportedExtensionNames_.find(extension) != supportedExtensionNames_.end());
+}
+
+bool VKPhysicalDevice::QueryMemoryBudget(VkPhysicalDeviceMemoryBudgetPropertiesEXT& outMemoryBudget) const
+{
+    if (!HasExtension(VKExt::KHR_get_physical_device_properties2) || !HasExtension(VKExt::EXT_memory_budget))
+        return false;
+
+    /* Query memory properties with budget extension "VK_EXT_memory_budget" chained into output descriptor */
+    outMemoryBudget = {};
+    outMemoryBudget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+    VkPhysicalDeviceMemoryProperties2 memoryPropertiesExt = {};
+    {
+        memoryPropertiesExt.sType   = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+        memoryPropertiesExt.pNext   = &outMemoryBudget;
+    }
+    vkGetPhysicalDeviceMemoryProperties2(physicalDevice_, &memoryPropertiesExt);
+
+    return true;
+}
+
+bool VKPhysicalDevice::QueryHostTimeDomain(VkInstance instance, VkTimeDomainEXT& outTimeDomain) const
+{
+    if (!HasExtension(VKExt::EXT_calibrated_timestamps))
+        return false;
+
+    /* Time domain of Timer::Tick: QueryPerformanceCounter on Win32 and CLOCK_MONOTONIC on Linux and Android */
+    #if defined LLGL_OS_WIN32
+    const VkTimeDomainEXT hostTimeDomain = VK_TIME_DOMAIN_QUERY_PERFORMANCE_COUNTER_EXT;
+    #elif defined LLGL_OS_LINUX || defined LLGL_OS_ANDROID
+    const VkTimeDomainEXT hostTimeDomain = VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT;
+    #else
+    const VkTimeDomainEXT hostTimeDomain = VK_TIME_DOMAIN_MAX_ENUM_EXT; // No calibrateable time domain matches Timer::Tick on this platform
+    #endif
+
+    /* This is an instance procedure, so it is not loaded with the device extension procedures */
+    auto getTimeDomainsProc = reinterpret_cast<PFN_vkGetPhysicalDeviceCalibrateableTimeDomainsEXT>(
+        vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceCalibrateableTimeDomainsEXT")
     );
-    return (it != supportedExtensionNames_.end());
+    if (getTimeDomainsProc == nullptr)
+        return false;
+
+    std::uint32_t numTimeDomains = 0;
+    if (getTimeDomainsProc(physicalDevice_, &numTimeDomains, nullptr) != VK_SUCCESS)
+        return false;
+
+    std::vector<VkTimeDomainEXT> timeDomains(numTimeDomains);
+    if (getTimeDomainsProc(physicalDevice_, &numTimeDomains, timeDomains.data()) != VK_SUCCESS)
+        return false;
+
+    /* Both the device and the host time domain must be calibrateable */
+    const bool hasDeviceTimeDomain  = (std::find(timeDomains.begin(), timeDomains.end(), VK_TIME_DOMAIN_DEVICE_EXT) != timeDomains.end());
+    const bool hasHostTimeDomain    = (std::find(timeDomains.begin(), timeDomains.end(), hostTimeDomain) != timeDomains.end());
+    if (!hasDeviceTimeDomain || !hasHostTimeDomain)
+        return false;
+
+    outTimeDomain = hostTimeDomain;
+    return true;
 }
 
 
@@ -274,6 +472,41 @@ bool VKPhysicalDevice::SupportsExtension(const char* extension) const
  * ======= Private: =======
  */
 
+bool VKPhysicalDevice::InitPhysicalDevice(VkPhysicalDevice device, const char** requiredExtensions, bool headless)
+{
+    /* Store reference to all extension names */
+    supportedExtensionNames_.clear();
+    for (const auto& extension : supportedExtensions_)
+        supportedExtensionNames_.insert(extension.extensionName);
+
+    if (!EnableExtensions(requiredExtensions, true))
+    {
+        /* Stop considering this physical device, because some required extensions are not supported */
+        supportedExtensionNames_.clear();
+        return false;
+    }
+
+    EnableExtensions(GetOptionalExtensions());
+
+    /* Display timing depends on VK_KHR_swapchain, which is not enabled for headless devices */
+    if (headless)
+    {
+        enabledExtensionNames_.erase(
+            std::remove_if(
+                enabledExtensionNames_.begin(), enabledExtensionNames_.end(),
+                [](const char* name) { return (std::strcmp(name, VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME) == 0); }
+            ),
+            enabledExtensionNames_.end()
+        );
+    }
+
+    /* Store device and store properties */
+    physicalDevice_ = device;
+    QueryDeviceInfo();
+
+    return true;
+}
+
 bool VKPhysicalDevice::EnableExtensions(const char** extensions, bool required)
 {
     for (; *extensions != nullptr; ++extensions)
@@ -310,6 +543,34 @@ void VKPhysicalDevice::QueryDeviceInfo()
         vkGetPhysicalDeviceProperties(physicalDevice_, &properties_);
         vkGetPhysicalDeviceMemoryProperties(physicalDevice_, &memoryProperties_);
     }
+
+    /* Timeline semaphores must be enabled explicitly when the logical device is created */
+    if (SupportsExtension(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME))
+        QueryTimelineSemaphoreFeatures();
+
+    /* Descriptor indexing features must be enabled explicitly when the logical device is created */
+    if (SupportsExtension(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME))
+        QueryDescriptorIndexingFeatures();
+
+    /* Dynamic rendering must be enabled explicitly when the logical device is created */
+    if (SupportsExtension(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME))
+        QueryDynamicRenderingFeatures();
+
+    /* Graphics pipeline libraries must be enabled explicitly when the logical device is created */
+    if (SupportsExtension(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME) && SupportsExtension(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME))
+        QueryGraphicsPipelineLibraryFeatures();
+
+    /* Mesh shaders must be enabled explicitly when the logical device is created */
+    if (SupportsExtension(VK_EXT_MESH_SHADER_EXTENSION_NAME))
+        QueryMeshShaderFeaturesAndProperties();
+
+    /* Fragment shading rates must be enabled explicitly when the logical device is created */
+    if (SupportsExtension(VK_KHR_FRAGMENT_SHADING_RATE_EXTENSION_NAME))
+        QueryFragmentShadingRateFeatures();
+
+    /* Pageable device-local memory must be enabled explicitly when the logical device is created; it depends on "VK_EXT_memory_priority" */
+    if (SupportsExtension(VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME) && SupportsExtension(VK_EXT_PAGEABLE_DEVICE_LOCAL_MEMORY_EXTENSION_NAME))
+        QueryPageableDeviceLocalMemoryFeatures();
 }
 
 void VKPhysicalDevice::QueryDeviceFeaturesWithExtensions()
@@ -369,6 +630,115 @@ void VKPhysicalDevice::QueryDeviceMemoryPropertiesWithExtensions()
     vkGetPhysicalDeviceMemoryProperties(physicalDevice_, &memoryProperties_);
 }
 
+void VKPhysicalDevice::QueryTimelineSemaphoreFeatures()
+{
+    /* Query timeline semaphore features chained into output descriptor */
+    timelineSemaphoreFeatures_.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+    timelineSemaphoreFeatures_.pNext = nullptr;
+
+    VkPhysicalDeviceFeatures2 featuresExt = {};
+    {
+        featuresExt.sType   = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        featuresExt.pNext   = &timelineSemaphoreFeatures_;
+    }
+    vkGetPhysicalDeviceFeatures2(physicalDevice_, &featuresExt);
+}
+
+void VKPhysicalDevice::QueryDescriptorIndexingFeatures()
+{
+    /* Query descriptor indexing features chained into output descriptor */
+    descriptorIndexingFeatures_.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+    descriptorIndexingFeatures_.pNext = nullptr;
+
+    VkPhysicalDeviceFeatures2 featuresExt = {};
+    {
+        featuresExt.sType   = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        featuresExt.pNext   = &descriptorIndexingFeatures_;
+    }
+    vkGetPhysicalDeviceFeatures2(physicalDevice_, &featuresExt);
+}
+
+void VKPhysicalDevice::QueryDynamicRenderingFeatures()
+{
+    /* Query dynamic rendering features chained into output descriptor */
+    dynamicRenderingFeatures_.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+    dynamicRenderingFeatures_.pNext = nullptr;
+
+    VkPhysicalDeviceFeatures2 featuresExt = {};
+    {
+        featuresExt.sType   = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        featuresExt.pNext   = &dynamicRenderingFeatures_;
+    }
+    vkGetPhysicalDeviceFeatures2(physicalDevice_, &featuresExt);
+}
+
+void VKPhysicalDevice::QueryGraphicsPipelineLibraryFeatures()
+{
+    /* Query graphics pipeline library features chained into output descriptor */
+    graphicsPipelineLibraryFeatures_.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+    graphicsPipelineLibraryFeatures_.pNext = nullptr;
+
+    VkPhysicalDeviceFeatures2 featuresExt = {};
+    {
+        featuresExt.sType   = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        featuresExt.pNext   = &graphicsPipelineLibraryFeatures_;
+    }
+    vkGetPhysicalDeviceFeatures2(physicalDevice_, &featuresExt);
+}
+
+void VKPhysicalDevice::QueryMeshShaderFeaturesAndProperties()
+{
+    /* Query mesh shader features chained into output descriptor */
+    meshShaderFeatures_.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT;
+    meshShaderFeatures_.pNext = nullptr;
+
+    VkPhysicalDeviceFeatures2 featuresExt = {};
+    {
+        featuresExt.sType   = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        featuresExt.pNext   = &meshShaderFeatures_;
+    }
+    vkGetPhysicalDeviceFeatures2(physicalDevice_, &featuresExt);
+
+    /* Query mesh shader properties for the work group limits */
+    meshShaderProps_.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_PROPERTIES_EXT;
+    meshShaderProps_.pNext = nullptr;
+
+    VkPhysicalDeviceProperties2 propertiesExt = {};
+    {
+        propertiesExt.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        propertiesExt.pNext = &meshShaderProps_;
+    }
+    vkGetPhysicalDeviceProperties2(physicalDevice_, &propertiesExt);
+}
+
+void VKPhysicalDevice::QueryFragmentShadingRateFeatures()
+{
+    /* Query fragment shading rate features chained into output descriptor */
+    fragmentShadingRateFeatures_.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FRAGMENT_SHADING_RATE_FEATURES_KHR;
+    fragmentShadingRateFeatures_.pNext = nullptr;
+
+    VkPhysicalDeviceFeatures2 featuresExt = {};
+    {
+        featuresExt.sType   = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        featuresExt.pNext   = &fragmentShadingRateFeatures_;
+    }
+    vkGetPhysicalDeviceFeatures2(physicalDevice_, &featuresExt);
+}
+
+void VKPhysicalDevice::QueryPageableDeviceLocalMemoryFeatures()
+{
+    /* Query pageable device-local memory features chained into output descriptor */
+    pageableDeviceLocalMemoryFeatures_.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PAGEABLE_DEVICE_LOCAL_MEMORY_FEATURES_EXT;
+    pageableDeviceLocalMemoryFeatures_.pNext = nullptr;
+
+    VkPhysicalDeviceFeatures2 featuresExt = {};
+    {
+        featuresExt.sType   = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        featuresExt.pNext   = &pageableDeviceLocalMemoryFeatures_;
+    }
+    vkGetPhysicalDeviceFeatures2(physicalDevice_, &featuresExt);
+}
+
 
 } // /namespace LLGL
 
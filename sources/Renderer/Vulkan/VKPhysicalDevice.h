@@ -11,7 +11,9 @@
 
 #include "Vulkan.h"
 #include "VKDevice.h"
+#include "VKAdapterProfile.h"
 #include <LLGL/RenderSystemFlags.h>
+#include <LLGL/VideoAdapter.h>
 #include <vector>
 #include <set>
 #include <cstring>
@@ -30,7 +32,20 @@ class VKPhysicalDevice
 
         /* ----- Common ----- */
 
-        bool PickPhysicalDevice(VkInstance instance);
+        // Picks the first suitable physical device or only the one with the specified index (if 'deviceIndex' is non-negative).
+        bool PickPhysicalDevice(VkInstance instance, bool headless = false, int deviceIndex = -1);
+
+        /*
+        Picks the physical device that is stored in the specified adapter profile without enumerating its extensions.
+        Returns false if the device does not match the profile anymore, in which case PickPhysicalDevice must be used instead.
+        */
+        bool PickPhysicalDeviceFromProfile(VkInstance instance, bool headless, int deviceIndex, const VKAdapterProfile& profile);
+
+        // Stores the identity and supported extensions of the picked physical device in the specified adapter profile.
+        void StoreAdapterProfile(VKAdapterProfile& outProfile) const;
+
+        // Appends a video adapter descriptor for each physical device, in the order that is used for the device index.
+        static void QueryVideoAdapters(VkInstance instance, std::vector<VideoAdapterDescriptor>& outAdapters);
 
         void QueryDeviceProperties(
             RendererInfo&               info,
@@ -38,13 +53,31 @@ class VKPhysicalDevice
             VKGraphicsPipelineLimits&   pipelineLimits
         );
 
-        VKDevice CreateLogicalDevice();
+        VKDevice CreateLogicalDevice(bool dedicatedTransferQueue = false, bool asyncComputeQueue = false);
 
         std::uint32_t FindMemoryType(std::uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) const;
 
         // Returns true if the specified Vulkan extension is supported by this physical device.
         bool SupportsExtension(const char* extension) const;
 
+        // Returns true if sparse 2D textures can be bound on the graphics queue of this physical device.
+        bool SupportsSparseTextures() const;
+
+        // Returns true if device memory can be exported and imported with "VK_KHR_external_memory_fd" (or "VK_KHR_external_memory_win32" on Windows).
+        bool SupportsExternalMemory() const;
+
+        /*
+        Queries the memory budget and usage of each memory heap with the "VK_EXT_memory_budget" extension.
+        Returns false if the extension is not available.
+        */
+        bool QueryMemoryBudget(VkPhysicalDeviceMemoryBudgetPropertiesEXT& outMemoryBudget) const;
+
+        /*
+        Queries the host time domain of the "VK_EXT_calibrated_timestamps" extension that matches Timer::Tick.
+        Returns false if the extension is not available or neither the device nor the matching host time domain is calibrateable.
+        */
+        bool QueryHostTimeDomain(VkInstance instance, VkTimeDomainEXT& outTimeDomain) const;
+
         /* ----- Handles ----- */
 
         // Returns the native VkPhysicalDevice handle.
@@ -77,6 +110,56 @@ class VKPhysicalDevice
             return memoryProperties_;
         }
 
+        // Returns true if the physical device supports the "timelineSemaphore" feature of the "VK_KHR_timeline_semaphore" extension.
+        inline bool SupportsTimelineSemaphores() const
+        {
+            return (timelineSemaphoreFeatures_.timelineSemaphore != VK_FALSE);
+        }
+
+        /*
+        Returns true if the physical device supports the features of the "VK_EXT_descriptor_indexing" extension that are required for bindless resource heaps,
+        i.e. "runtimeDescriptorArray", "descriptorBindingPartiallyBound", and "descriptorBindingVariableDescriptorCount".
+        */
+        inline bool SupportsDescriptorIndexing() const
+        {
+            return
+            (
+                descriptorIndexingFeatures_.runtimeDescriptorArray                  != VK_FALSE &&
+                descriptorIndexingFeatures_.descriptorBindingPartiallyBound         != VK_FALSE &&
+                descriptorIndexingFeatures_.descriptorBindingVariableDescriptorCount != VK_FALSE
+            );
+        }
+
+        // Returns true if the physical device supports the "dynamicRendering" feature of the "VK_KHR_dynamic_rendering" extension.
+        inline bool SupportsDynamicRendering() const
+        {
+            return (dynamicRenderingFeatures_.dynamicRendering != VK_FALSE);
+        }
+
+        // Returns true if the physical device supports the "graphicsPipelineLibrary" feature of the "VK_EXT_graphics_pipeline_library" extension.
+        inline bool SupportsGraphicsPipelineLibrary() const
+        {
+            return (graphicsPipelineLibraryFeatures_.graphicsPipelineLibrary != VK_FALSE);
+        }
+
+        // Returns true if the physical device supports the "taskShader" and "meshShader" features of the "VK_EXT_mesh_shader" extension.
+        inline bool SupportsMeshShaders() const
+        {
+            return (meshShaderFeatures_.taskShader != VK_FALSE && meshShaderFeatures_.meshShader != VK_FALSE);
+        }
+
+        // Returns true if the physical device supports the "pipelineFragmentShadingRate" feature of the "VK_KHR_fragment_shading_rate" extension.
+        inline bool SupportsFragmentShadingRate() const
+        {
+            return (fragmentShadingRateFeatures_.pipelineFragmentShadingRate != VK_FALSE);
+        }
+
+        // Returns true if the physical device supports the "pageableDeviceLocalMemory" feature of the "VK_EXT_pageable_device_local_memory" extension.
+        inline bool SupportsPageableDeviceLocalMemory() const
+        {
+            return (pageableDeviceLocalMemoryFeatures_.pageableDeviceLocalMemory != VK_FALSE);
+        }
+
         // Returns the list of names of all supported and enabled extensions.
         inline const std::vector<const char*>& GetExtensionNames() const
         {
@@ -96,17 +179,28 @@ class VKPhysicalDevice
 
     private:
 
+        // Enables the required and optional extensions for the specified device from the list of supported extensions; returns false if a required one is missing.
+        bool InitPhysicalDevice(VkPhysicalDevice device, const char** requiredExtensions, bool headless);
+
         bool EnableExtensions(const char** extensions, bool required = false);
 
         void QueryDeviceInfo();
         void QueryDeviceFeaturesWithExtensions();
         void QueryDevicePropertiesWithExtensions();
         void QueryDeviceMemoryPropertiesWithExtensions();
+        void QueryTimelineSemaphoreFeatures();
+        void QueryDescriptorIndexingFeatures();
+        void QueryDynamicRenderingFeatures();
+        void QueryGraphicsPipelineLibraryFeatures();
+        void QueryMeshShaderFeaturesAndProperties();
+        void QueryFragmentShadingRateFeatures();
+        void QueryPageableDeviceLocalMemoryFeatures();
 
     private:
 
         // Main device objects
         VkPhysicalDevice                                        physicalDevice_             = VK_NULL_HANDLE;
+        int                                                     deviceIndex_                = -1;
         std::vector<VkExtensionProperties>                      supportedExtensions_;
         std::set<const char*, CStringSWO>                       supportedExtensionNames_;
         std::vector<const char*>                                enabledExtensionNames_;
@@ -117,7 +211,15 @@ class VKPhysicalDevice
         VkPhysicalDeviceMemoryProperties                        memoryProperties_           = {};
 
         // Extension specific
-        VkPhysicalDeviceConservativeRasterizationPropertiesEXT  conservRasterProps_         = {};
+        VkPhysicalDeviceConservativeRasterizationPropertiesEXT  conservRasterProps_                = {};
+        VkPhysicalDeviceTimelineSemaphoreFeaturesKHR            timelineSemaphoreFeatures_         = {};
+        VkPhysicalDeviceDescriptorIndexingFeaturesEXT           descriptorIndexingFeatures_        = {};
+        VkPhysicalDeviceDynamicRenderingFeaturesKHR             dynamicRenderingFeatures_          = {};
+        VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT      graphicsPipelineLibraryFeatures_   = {};
+        VkPhysicalDeviceMeshShaderFeaturesEXT                   meshShaderFeatures_                = {};
+        VkPhysicalDeviceMeshShaderPropertiesEXT                 meshShaderProps_                   = {};
+        VkPhysicalDeviceFragmentShadingRateFeaturesKHR          fragmentShadingRateFeatures_       = {};
+        VkPhysicalDevicePageableDeviceLocalMemoryFeaturesEXT    pageableDeviceLocalMemoryFeatures_ = {};
 
 };
 
@@ -100,6 +100,14 @@ class VKPtr
             }
         }
 
+        // Returns the native Vulkan object and resets this handler without deleting the object.
+        T Detach()
+        {
+            T object = object_;
+            object_ = VK_NULL_HANDLE;
+            return object;
+        }
+
         // Releases and returns the address of the native Vulkan object.
         T* ReleaseAndGetAddressOf()
         {
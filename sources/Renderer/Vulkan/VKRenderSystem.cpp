@@ -8,8 +8,10 @@
 #include <LLGL/Platform/Platform.h>
 #include "VKRenderSystem.h"
 #include "Ext/VKExtensionLoader.h"
+#include "Ext/VKExtensionRegistry.h"
 #include "Ext/VKExtensions.h"
 #include "Memory/VKDeviceMemory.h"
+#include "Memory/VKExternalMemory.h"
 #include "../RenderSystemUtils.h"
 #include "../TextureUtils.h"
 #include "../CheckedCast.h"
@@ -18,17 +20,28 @@
 #include "VKCore.h"
 #include "VKTypes.h"
 #include "VKInitializers.h"
+#include "VKSerialization.h"
 #include "RenderState/VKPredicateQueryHeap.h"
 #include "RenderState/VKComputePSO.h"
+#include "Texture/VKMipGenerator.h"
+#include "../../Core/ProfilerZone.h"
 #include <LLGL/Log.h>
 #include <LLGL/ImageFlags.h>
+#include <LLGL/Timer.h>
 #include <limits>
+#include <cstdio>
 
 
 namespace LLGL
 {
 
 
+/* ----- Internal constants ----- */
+
+// Size (in bytes) of the staging ring buffer for buffer and texture uploads.
+static const VkDeviceSize g_stagingBufferPoolSize = 8*1024*1024;
+
+
 /* ----- Internal functions ----- */
 
 static VkResult CreateDebugReportCallbackEXT(VkInstance instance, const VkDebugReportCallbackCreateInfoEXT* createInfo, const VkAllocationCallbacks* allocator, VkDebugReportCallbackEXT* callback)
@@ -47,6 +60,16 @@ static void DestroyDebugReportCallbackEXT(VkInstance instance, VkDebugReportCall
         func(instance, callback, allocator);
 }
 
+// Returns the offset alignment for buffer-to-image copies, which must be a multiple of 4 and of the texel (or block) size.
+static VkDeviceSize GetStagingImageAlignment(const Format format)
+{
+    const auto texelSize = std::max<VkDeviceSize>(1, GetFormatAttribs(format).bitSize / 8);
+    auto alignment = texelSize;
+    while (alignment % 4 != 0)
+        alignment += texelSize;
+    return alignment;
+}
+
 static VkBufferUsageFlags GetStagingVkBufferUsageFlags(long cpuAccessFlags)
 {
     if ((cpuAccessFlags & CPUAccessFlags::Write) != 0)
@@ -61,7 +84,8 @@ static VkBufferUsageFlags GetStagingVkBufferUsageFlags(long cpuAccessFlags)
 VKRenderSystem::VKRenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
     instance_              { vkDestroyInstance                        },
     debugReportCallback_   { instance_, DestroyDebugReportCallbackEXT },
-    defaultPipelineLayout_ { device_, vkDestroyPipelineLayout         }
+    defaultPipelineLayout_ { device_, vkDestroyPipelineLayout         },
+    stagingBufferPool_     { device_                                  }
 {
     /* Extract optional renderer configuartion */
     auto rendererConfigVK = GetRendererConfiguration<RendererConfigurationVulkan>(renderSystemDesc);
@@ -70,36 +94,122 @@ VKRenderSystem::VKRenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
     debugLayerEnabled_ = true;
     #endif
 
+    headless_ = ((renderSystemDesc.flags & RenderSystemFlags::Headless) != 0);
+
+    /* Read optional adapter profile to skip the layer and extension enumeration */
+    const char* adapterProfileFilename = (rendererConfigVK != nullptr ? rendererConfigVK->adapterProfileFilename : nullptr);
+
+    VKAdapterProfile adapterProfile;
+    bool useAdapterProfile = (adapterProfileFilename != nullptr && VKReadAdapterProfile(adapterProfileFilename, adapterProfile));
+    const bool adapterProfileRead = useAdapterProfile;
+
     /* Create Vulkan instance and device objects */
-    CreateInstance(rendererConfigVK);
-    PickPhysicalDevice();
-    CreateLogicalDevice();
+    const std::uint64_t startTime = Timer::Tick();
+
+    CreateInstance(rendererConfigVK, adapterProfile, useAdapterProfile);
+    const std::uint64_t instanceTime = Timer::Tick();
+
+    if (renderSystemDesc.adapterIndex >= 0)
+        PickPhysicalDevice(renderSystemDesc.adapterIndex, adapterProfile, useAdapterProfile);
+    else
+        PickPhysicalDevice((rendererConfigVK != nullptr ? rendererConfigVK->deviceIndex : -1), adapterProfile, useAdapterProfile);
+    const std::uint64_t physicalDeviceTime = Timer::Tick();
+
+    CreateLogicalDevice(
+        ((renderSystemDesc.flags & RenderSystemFlags::DedicatedTransferQueue) != 0),
+        ((renderSystemDesc.flags & RenderSystemFlags::AsyncComputeQueue) != 0)
+    );
+    const std::uint64_t logicalDeviceTime = Timer::Tick();
+
+    /* Write adapter profile for the next run if it was missing or outdated */
+    if (adapterProfileFilename != nullptr && !useAdapterProfile)
+        VKWriteAdapterProfile(adapterProfileFilename, adapterProfile);
 
     /* Create default resources */
     CreateDefaultPipelineLayout();
+    VKMipGenerator::Get().InitializeDevice(device_, physicalDevice_.GetVkPhysicalDevice(), physicalDevice_.GetFeatures());
+
+    /* Create device-wide pipeline cache that is shared between all PSOs */
+    pipelineCache_ = MakeUnique<VKPipelineCache>(device_);
+
+    /* Create device-wide cache of graphics pipeline libraries if fast linking with "VK_EXT_graphics_pipeline_library" is supported */
+    if (physicalDevice_.SupportsGraphicsPipelineLibrary() && HasExtension(VKExt::KHR_pipeline_library) && HasExtension(VKExt::EXT_graphics_pipeline_library))
+        pipelineLibraryCache_ = MakeUnique<VKPipelineLibraryCache>(device_);
 
     /* Create device memory manager */
     deviceMemoryMngr_ = MakeUnique<VKDeviceMemoryManager>(
         device_,
         physicalDevice_.GetMemoryProperties(),
         (rendererConfigVK != nullptr ? rendererConfigVK->minDeviceMemoryAllocationSize : 1024*1024),
-        (rendererConfigVK != nullptr ? rendererConfigVK->reduceDeviceMemoryFragmentation : false)
+        (rendererConfigVK != nullptr ? rendererConfigVK->reduceDeviceMemoryFragmentation : false),
+        (physicalDevice_.SupportsPageableDeviceLocalMemory() && HasExtension(VKExt::EXT_pageable_device_local_memory))
+    );
+
+    /* Create staging ring buffer that is shared by all upload paths */
+    stagingBufferPool_.InitializeDevice(physicalDevice_.GetMemoryProperties(), g_stagingBufferPoolSize);
+
+    /* Create pool for asynchronous readbacks of command buffers */
+    readbackPool_ = MakeUnique<VKReadbackPool>(device_, *deviceMemoryMngr_);
+
+    /* Create device-wide caches for render passes and framebuffers that are shared between all render targets */
+    renderPassCache_    = MakeUnique<VKRenderPassCache>(device_);
+    framebufferCache_   = MakeUnique<VKFramebufferCache>(device_);
+    dynamicRendering_   =
+    (
+        rendererConfigVK != nullptr && rendererConfigVK->dynamicRendering &&
+        physicalDevice_.SupportsDynamicRendering() && HasExtension(VKExt::KHR_dynamic_rendering)
     );
+
+    /* Create device-wide descriptor set allocator that is shared between all resource heaps */
+    descriptorSetAllocator_ = MakeUnique<VKDescriptorSetAllocator>(device_);
+
+    /* Report time spent in each start-up phase */
+    const std::uint64_t endTime = Timer::Tick();
+    const double        ticksToMs = 1000.0 / static_cast<double>(Timer::Frequency());
+
+    RecordStartupPhase("instance creation",                 startTime,          instanceTime        );
+    RecordStartupPhase("physical device selection",         instanceTime,       physicalDeviceTime  );
+    RecordStartupPhase("logical device and extensions",     physicalDeviceTime, logicalDeviceTime   );
+    RecordStartupPhase("default resources and memory",      logicalDeviceTime,  endTime             );
+
+    char reportText[512];
+    std::snprintf(
+        reportText,
+        sizeof(reportText),
+        "Vulkan start-up timing%s:\n"
+        "  instance creation:             %.3f ms\n"
+        "  physical device selection:     %.3f ms\n"
+        "  logical device and extensions: %.3f ms\n"
+        "  default resources and memory:  %.3f ms\n"
+        "  total:                         %.3f ms\n",
+        (useAdapterProfile ? " (adapter profile)" : (adapterProfileRead ? " (adapter profile outdated)" : "")),
+        static_cast<double>(instanceTime        - startTime         ) * ticksToMs,
+        static_cast<double>(physicalDeviceTime  - instanceTime      ) * ticksToMs,
+        static_cast<double>(logicalDeviceTime   - physicalDeviceTime) * ticksToMs,
+        static_cast<double>(endTime             - logicalDeviceTime ) * ticksToMs,
+        static_cast<double>(endTime             - startTime         ) * ticksToMs
+    );
+    SetReport(reportText);
 }
 
 VKRenderSystem::~VKRenderSystem()
 {
     device_.WaitIdle();
+    VKMipGenerator::Get().Clear();
 }
 
 /* ----- Swap-chain ----- */
 
 SwapChain* VKRenderSystem::CreateSwapChain(const SwapChainDescriptor& swapChainDesc, const std::shared_ptr<Surface>& surface)
 {
-    return TakeOwnership(
-        swapChains_,
-        MakeUnique<VKSwapChain>(instance_, physicalDevice_, device_, *deviceMemoryMngr_, swapChainDesc, surface)
-    );
+    if (headless_)
+        throw std::runtime_error("cannot create swap-chain for headless Vulkan render system");
+
+    const std::uint64_t startTick = Timer::Tick();
+    auto swapChain = MakeUnique<VKSwapChain>(instance_, physicalDevice_, device_, *deviceMemoryMngr_, device_.GetMutex(), swapChainDesc, surface);
+    RecordStartupPhase("swap-chain creation", startTick, Timer::Tick());
+
+    return TakeOwnership(swapChains_, std::move(swapChain));
 }
 
 void VKRenderSystem::Release(SwapChain& swapChain)
@@ -114,13 +224,28 @@ CommandQueue* VKRenderSystem::GetCommandQueue()
     return commandQueue_.get();
 }
 
+CommandQueue* VKRenderSystem::GetComputeQueue()
+{
+    return computeQueue_.get();
+}
+
 /* ----- Command buffers ----- */
 
 CommandBuffer* VKRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& commandBufferDesc)
 {
+    /* Command buffers for the asynchronous compute queue fall back to the graphics queue if there is none */
+    const bool isComputeCmdBuffer = ((commandBufferDesc.flags & CommandBufferFlags::ComputeQueue) != 0 && computeQueue_);
     return TakeOwnership(
         commandBuffers_,
-        MakeUnique<VKCommandBuffer>(physicalDevice_, device_, device_.GetVkQueue(), device_.GetQueueFamilyIndices(), commandBufferDesc)
+        MakeUnique<VKCommandBuffer>(
+            physicalDevice_,
+            device_,
+            (isComputeCmdBuffer ? device_.GetVkComputeQueue() : device_.GetVkQueue()),
+            device_.GetQueueFamilyIndices(),
+            stagingBufferPool_,
+            *readbackPool_,
+            commandBufferDesc
+        )
     );
 }
 
@@ -135,53 +260,82 @@ Buffer* VKRenderSystem::CreateBuffer(const BufferDescriptor& bufferDesc, const v
 {
     AssertCreateBuffer(bufferDesc, static_cast<uint64_t>(std::numeric_limits<VkDeviceSize>::max()));
 
-    /* Create staging buffer */
-    VkBufferCreateInfo stagingCreateInfo;
-    BuildVkBufferCreateInfo(
-        stagingCreateInfo,
-        static_cast<VkDeviceSize>(bufferDesc.size),
-        GetStagingVkBufferUsageFlags(bufferDesc.cpuAccessFlags)
-    );
-
-    auto stagingBuffer = CreateStagingBufferAndInitialize(stagingCreateInfo, initialData, bufferDesc.size);
-
     /* Create primary buffer object */
-    auto buffer = TakeOwnership(buffers_, MakeUnique<VKBuffer>(device_, bufferDesc));
+    auto buffer = TakeOwnership(buffers_, MakeUnique<VKBuffer>(device_, bufferDesc, device_.GetSharedQueueFamilies()));
+
+    const auto& requirements = buffer->GetDeviceBuffer().GetRequirements();
+    const bool  isCPUAccessed = (bufferDesc.cpuAccessFlags != 0 || (bufferDesc.miscFlags & MiscFlags::DynamicUsage) != 0);
+    const bool  isShared      = ((bufferDesc.miscFlags & MiscFlags::Shared) != 0);
+
+    /*
+    Place CPU-written buffers in host-visible device memory if it spans the entire VRAM (ReBAR/SAM),
+    so they can be written directly without a staging buffer. Read access is excluded, since reading VRAM from the CPU is slow.
+    */
+    if (isCPUAccessed &&
+        !isShared &&
+        (bufferDesc.cpuAccessFlags & CPUAccessFlags::Read) == 0 &&
+        deviceMemoryMngr_->HasHostVisibleDeviceLocalMemory(requirements.memoryTypeBits))
+    {
+        auto memoryRegion = deviceMemoryMngr_->Allocate(
+            requirements,
+            (VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+        );
+        buffer->BindMemoryRegion(device_, memoryRegion, true);
 
-    /* Allocate device memory */
-    auto memoryRegion = deviceMemoryMngr_->Allocate(
-        buffer->GetDeviceBuffer().GetRequirements(),
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
-    );
-    buffer->BindMemoryRegion(device_, memoryRegion);
+        if (initialData != nullptr)
+            device_.WriteBuffer(buffer->GetDeviceBuffer(), initialData, static_cast<VkDeviceSize>(bufferDesc.size));
 
-    /* Copy staging buffer into hardware buffer */
-    device_.CopyBuffer(stagingBuffer.GetVkBuffer(), buffer->GetVkBuffer(), static_cast<VkDeviceSize>(bufferDesc.size));
+        return buffer;
+    }
+
+    /* Allocate device memory; shared buffers are bound to dedicated memory that is not managed by the device memory manager */
+    if (isShared)
+        buffer->AllocateExternalMemory(device_, *deviceMemoryMngr_);
+    else
+    {
+        auto memoryRegion = deviceMemoryMngr_->Allocate(requirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        buffer->BindMemoryRegion(device_, memoryRegion);
+    }
 
-    if (bufferDesc.cpuAccessFlags != 0 || (bufferDesc.miscFlags & MiscFlags::DynamicUsage) != 0)
+    if (isCPUAccessed)
     {
+        /* Create persistent staging buffer */
+        VkBufferCreateInfo stagingCreateInfo;
+        BuildVkBufferCreateInfo(
+            stagingCreateInfo,
+            static_cast<VkDeviceSize>(bufferDesc.size),
+            GetStagingVkBufferUsageFlags(bufferDesc.cpuAccessFlags)
+        );
+
+        auto stagingBuffer = CreateStagingBufferAndInitialize(stagingCreateInfo, initialData, bufferDesc.size);
+
+        /* Copy staging buffer into hardware buffer */
+        stagingBufferPool_.Flush();
+        device_.CopyBuffer(stagingBuffer.GetVkBuffer(), buffer->GetVkBuffer(), static_cast<VkDeviceSize>(bufferDesc.size));
+
         /* Store ownership of staging buffer */
         buffer->TakeStagingBuffer(std::move(stagingBuffer));
     }
-    else
+    else if (initialData != nullptr)
     {
-        /* Release staging buffer */
-        stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
+        /* Upload initial data without waiting for the GPU */
+        WriteStagedBuffer(buffer->GetVkBuffer(), 0, initialData, static_cast<VkDeviceSize>(bufferDesc.size), false);
     }
 
     return buffer;
 }
 
-BufferArray* VKRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray)
+BufferArray* VKRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets)
 {
     AssertCreateBufferArray(numBuffers, bufferArray);
-    return TakeOwnership(bufferArrays_, MakeUnique<VKBufferArray>(numBuffers, bufferArray));
+    return TakeOwnership(bufferArrays_, MakeUnique<VKBufferArray>(numBuffers, bufferArray, offsets));
 }
 
 void VKRenderSystem::Release(Buffer& buffer)
 {
     /* Release device memory regions for primary buffer and internal staging buffer, then release buffer object */
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+    stagingBufferPool_.Wait();
     bufferVK.GetDeviceBuffer().ReleaseMemoryRegion(*deviceMemoryMngr_);
     bufferVK.GetStagingDeviceBuffer().ReleaseMemoryRegion(*deviceMemoryMngr_);
     RemoveFromUniqueSet(buffers_, &buffer);
@@ -196,9 +350,17 @@ void VKRenderSystem::WriteBuffer(Buffer& buffer, std::uint64_t offset, const voi
 {
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
 
-    if (bufferVK.GetStagingVkBuffer() != VK_NULL_HANDLE)
+    if (bufferVK.IsHostVisible())
+    {
+        /* Write input data directly into host-visible device memory once the GPU no longer uses the buffer */
+        stagingBufferPool_.Flush();
+        device_.WaitIdle();
+        device_.WriteBuffer(bufferVK.GetDeviceBuffer(), data, dataSize, offset);
+    }
+    else if (bufferVK.GetStagingVkBuffer() != VK_NULL_HANDLE)
     {
         /* Copy input data to staging buffer memory */
+        stagingBufferPool_.Flush();
         device_.WriteBuffer(bufferVK.GetStagingDeviceBuffer(), data, dataSize, offset);
 
         /* Copy staging buffer into hardware buffer */
@@ -206,21 +368,28 @@ void VKRenderSystem::WriteBuffer(Buffer& buffer, std::uint64_t offset, const voi
     }
     else
     {
-        /* Create staging buffer */
-        VkBufferCreateInfo stagingCreateInfo;
-        BuildVkBufferCreateInfo(
-            stagingCreateInfo,
-            dataSize,
-            (VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT)
-        );
+        /* Upload data without waiting for the GPU */
+        WriteStagedBuffer(bufferVK.GetVkBuffer(), offset, data, dataSize, true);
+    }
+}
 
-        auto stagingBuffer = CreateStagingBufferAndInitialize(stagingCreateInfo, data, dataSize);
+void VKRenderSystem::WriteBuffer(Buffer& buffer, std::uint32_t numRegions, const BufferWriteRegion* regions)
+{
+    auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
 
-        /* Copy staging buffer into hardware buffer */
-        device_.CopyBuffer(stagingBuffer.GetVkBuffer(), bufferVK.GetVkBuffer(), dataSize, 0, offset);
+    VkDeviceSize totalSize = 0;
+    for (std::uint32_t i = 0; i < numRegions; ++i)
+        totalSize += static_cast<VkDeviceSize>(regions[i].dataSize);
 
-        /* Release device memory region of staging buffer */
-        stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
+    if (bufferVK.GetStagingVkBuffer() == VK_NULL_HANDLE && !bufferVK.IsHostVisible() && stagingBufferPool_.Capacity(totalSize))
+    {
+        /* Gather all regions into the staging ring buffer and upload them with a single copy command */
+        stagingBufferPool_.WriteStagedRegions(bufferVK.GetVkBuffer(), numRegions, regions);
+    }
+    else
+    {
+        /* Fall back to individual uploads for buffers with their own staging buffer, host-visible buffers, or batches that exceed the ring buffer */
+        RenderSystem::WriteBuffer(buffer, numRegions, regions);
     }
 }
 
@@ -228,6 +397,9 @@ void VKRenderSystem::ReadBuffer(Buffer& buffer, std::uint64_t offset, void* data
 {
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
 
+    /* Submit pending uploads before the buffer is read back */
+    stagingBufferPool_.Flush();
+
     if (bufferVK.GetStagingVkBuffer() != VK_NULL_HANDLE)
     {
         /* Copy hardware buffer into staging buffer */
@@ -262,18 +434,21 @@ void VKRenderSystem::ReadBuffer(Buffer& buffer, std::uint64_t offset, void* data
 void* VKRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
 {
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+    stagingBufferPool_.Flush();
     return bufferVK.Map(device_, access, 0, bufferVK.GetSize());
 }
 
 void* VKRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t length)
 {
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+    stagingBufferPool_.Flush();
     return bufferVK.Map(device_, access, static_cast<VkDeviceSize>(offset), static_cast<VkDeviceSize>(length));
 }
 
 void VKRenderSystem::UnmapBuffer(Buffer& buffer)
 {
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+    stagingBufferPool_.Flush();
     bufferVK.Unmap(device_);
 }
 
@@ -281,6 +456,29 @@ void VKRenderSystem::UnmapBuffer(Buffer& buffer)
 
 Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc)
 {
+    /* Sparse textures are created without any memory, so they are only transitioned into sampling-ready state */
+    if ((textureDesc.miscFlags & MiscFlags::Sparse) != 0)
+    {
+        auto textureVK = MakeUnique<VKTexture>(device_, *deviceMemoryMngr_, textureDesc, device_.GetSharedQueueFamilies());
+
+        {
+            std::lock_guard<std::recursive_mutex> guard{ device_.GetMutex() };
+            auto cmdBuffer = device_.AllocCommandBuffer();
+            device_.TransitionImageLayout(
+                cmdBuffer,
+                textureVK->GetVkImage(),
+                textureVK->GetVkFormat(),
+                VK_IMAGE_LAYOUT_UNDEFINED,
+                VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                TextureSubresource{ 0, textureVK->GetNumArrayLayers(), 0, textureVK->GetNumMipLevels() }
+            );
+            device_.FlushCommandBuffer(cmdBuffer);
+        }
+
+        textureVK->CreateInternalImageView(device_);
+        return TakeOwnership(textures_, std::move(textureVK));
+    }
+
     /* Determine size of image for staging buffer */
     const auto imageSize        = NumMipTexels(textureDesc, 0);
     const auto initialDataSize  = static_cast<VkDeviceSize>(GetMemoryFootprint(textureDesc.format, imageSize));
@@ -334,68 +532,104 @@ Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
         initialData = intermediateData.get();
     }
 
-    /* Create staging buffer */
-    VkBufferCreateInfo stagingCreateInfo;
-    BuildVkBufferCreateInfo(
-        stagingCreateInfo,
-        initialDataSize,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT
-    );
-
-    auto stagingBuffer = CreateStagingBufferAndInitialize(stagingCreateInfo, initialData, initialDataSize);
-
     /* Create device texture */
-    auto textureVK  = MakeUnique<VKTexture>(device_, *deviceMemoryMngr_, textureDesc);
+    auto textureVK  = MakeUnique<VKTexture>(device_, *deviceMemoryMngr_, textureDesc, device_.GetSharedQueueFamilies());
 
-    /* Copy staging buffer into hardware texture, then transfer image into sampling-ready state */
-    auto cmdBuffer = device_.AllocCommandBuffer();
-    {
-        const TextureSubresource subresource{ 0, textureVK->GetNumArrayLayers(), 0, textureVK->GetNumMipLevels() };
+    const TextureSubresource subresource{ 0, textureVK->GetNumArrayLayers(), 0, textureVK->GetNumMipLevels() };
+    const bool generateMips = (imageDesc != nullptr && MustGenerateMipsOnCreate(textureDesc));
 
-        device_.TransitionImageLayout(
-            cmdBuffer,
-            textureVK->GetVkImage(),
-            textureVK->GetVkFormat(),
-            VK_IMAGE_LAYOUT_UNDEFINED,
-            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-            subresource
-        );
-
-        device_.CopyBufferToImage(
-            cmdBuffer,
-            stagingBuffer.GetVkBuffer(),
-            textureVK->GetVkImage(),
-            textureVK->GetVkFormat(),
+    if (!generateMips && stagingBufferPool_.Capacity(initialDataSize))
+    {
+        /* Upload initial data via staging ring buffer (on the dedicated transfer queue if enabled) */
+        stagingBufferPool_.WriteImageStaged(
+            *textureVK,
             VkOffset3D{ 0, 0, 0 },
             textureVK->GetVkExtent(),
-            subresource
+            subresource,
+            initialData,
+            initialDataSize,
+            GetStagingImageAlignment(textureDesc.format)
         );
+    }
+    else
+    {
+        /* Record into the shared command buffers exclusively, since resources can be created from multiple threads */
+        std::lock_guard<std::recursive_mutex> guard{ device_.GetMutex() };
 
-        device_.TransitionImageLayout(
-            cmdBuffer,
-            textureVK->GetVkImage(),
-            textureVK->GetVkFormat(),
-            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-            subresource
-        );
+        /* Write initial data into staging ring buffer, or into temporary staging buffer if it exceeds the ring buffer */
+        const bool      useStagingPool  = stagingBufferPool_.Capacity(initialDataSize);
+        VKDeviceBuffer  stagingBuffer   { device_ };
+        VkBuffer        srcBuffer       = VK_NULL_HANDLE;
+        VkDeviceSize    srcBufferOffset = 0;
+        VkCommandBuffer cmdBuffer       = VK_NULL_HANDLE;
 
-        /* Generate MIP-maps if enabled */
-        if (imageDesc != nullptr && MustGenerateMipsOnCreate(textureDesc))
+        if (useStagingPool)
+        {
+            srcBufferOffset = stagingBufferPool_.Write(initialData, initialDataSize, GetStagingImageAlignment(textureDesc.format));
+            srcBuffer       = stagingBufferPool_.GetVkBuffer();
+            cmdBuffer       = stagingBufferPool_.GetCommandBuffer();
+        }
+        else
         {
-            device_.GenerateMips(
+            stagingBufferPool_.Flush();
+
+            VkBufferCreateInfo stagingCreateInfo;
+            BuildVkBufferCreateInfo(
+                stagingCreateInfo,
+                initialDataSize,
+                VK_BUFFER_USAGE_TRANSFER_SRC_BIT
+            );
+
+            stagingBuffer   = CreateStagingBufferAndInitialize(stagingCreateInfo, initialData, initialDataSize);
+            srcBuffer       = stagingBuffer.GetVkBuffer();
+            cmdBuffer       = device_.AllocCommandBuffer();
+        }
+
+        /* Copy staging buffer into hardware texture, then transfer image into sampling-ready state */
+        {
+            device_.TransitionImageLayout(
                 cmdBuffer,
                 textureVK->GetVkImage(),
                 textureVK->GetVkFormat(),
+                VK_IMAGE_LAYOUT_UNDEFINED,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                subresource
+            );
+
+            device_.CopyBufferToImage(
+                cmdBuffer,
+                srcBuffer,
+                textureVK->GetVkImage(),
+                textureVK->GetVkFormat(),
+                VkOffset3D{ 0, 0, 0 },
                 textureVK->GetVkExtent(),
+                subresource,
+                srcBufferOffset
+            );
+
+            device_.TransitionImageLayout(
+                cmdBuffer,
+                textureVK->GetVkImage(),
+                textureVK->GetVkFormat(),
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
                 subresource
             );
+
+            /* Generate MIP-maps if enabled */
+            if (generateMips)
+            {
+                device_.GenerateMips(cmdBuffer, *textureVK, subresource);
+            }
         }
-    }
-    device_.FlushCommandBuffer(cmdBuffer);
 
-    /* Release staging buffer */
-    stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
+        if (!useStagingPool)
+        {
+            /* Submit copy commands and release temporary staging buffer */
+            device_.FlushCommandBuffer(cmdBuffer);
+            stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
+        }
+    }
 
     /* Create image view for texture */
     textureVK->CreateInternalImageView(device_);
@@ -407,7 +641,11 @@ void VKRenderSystem::Release(Texture& texture)
 {
     /* Release device memory region, then release texture object */
     auto& textureVK = LLGL_CAST(VKTexture&, texture);
-    deviceMemoryMngr_->Release(textureVK.GetMemoryRegion());
+    stagingBufferPool_.Wait();
+    if (textureVK.IsSparse())
+        textureVK.ReleaseTiles(*deviceMemoryMngr_);
+    else
+        deviceMemoryMngr_->Release(textureVK.GetMemoryRegion());
     RemoveFromUniqueSet(textures_, &texture);
 }
 
@@ -424,16 +662,31 @@ void VKRenderSystem::WriteTexture(Texture& texture, const TextureRegion& texture
     auto        image           = textureVK.GetVkImage();
     const auto  imageSize       = extent.width * extent.height * extent.depth;
     const void* imageData       = nullptr;
-    const auto  imageDataSize   = static_cast<VkDeviceSize>(GetMemoryFootprint(format, imageSize));
+    auto        imageDataSize   = static_cast<VkDeviceSize>(GetMemoryFootprint(format, imageSize));
+    std::uint32_t bufferRowLength   = 0;
+    std::uint32_t bufferImageHeight = 0;
 
     /* Check if image data must be converted */
-    ByteBuffer intermediateData;
+    ByteBuffer          intermediateData;
+    SrcImageDescriptor  packedImageDesc     = imageDesc;
 
     const auto& formatAttribs = GetFormatAttribs(format);
     if (formatAttribs.bitSize > 0 && (formatAttribs.flags & FormatFlags::IsCompressed) == 0)
     {
-        /* Convert image format (will be null if no conversion is necessary) */
-        intermediateData = ConvertImageBuffer(imageDesc, formatAttribs.format, formatAttribs.dataType, Constants::maxThreadCount);
+        /* Repack strided image data if it must be converted or if its strides cannot be expressed in texels */
+        const std::uint32_t texelSize           = std::max(1u, formatAttribs.bitSize / 8u);
+        const bool          requiresConversion  = (imageDesc.format != formatAttribs.format || imageDesc.dataType != formatAttribs.dataType);
+        const bool          isTexelAligned      = (imageDesc.rowStride % texelSize == 0 && (imageDesc.rowStride == 0 || imageDesc.layerStride % imageDesc.rowStride == 0));
+
+        if (requiresConversion || !isTexelAligned)
+        {
+            ByteBuffer packedData = PackStridedImage(imageDesc, extent, packedImageDesc);
+
+            /* Convert image format (will be null if no conversion is necessary) */
+            intermediateData = ConvertImageBuffer(packedImageDesc, formatAttribs.format, formatAttribs.dataType, Constants::maxThreadCount);
+            if (!intermediateData)
+                intermediateData = std::move(packedData);
+        }
     }
 
     if (intermediateData)
@@ -443,19 +696,50 @@ void VKRenderSystem::WriteTexture(Texture& texture, const TextureRegion& texture
         then use temporary image buffer as source for initial data
         */
         const auto srcImageDataSize = imageSize * ImageFormatSize(imageDesc.format) * DataTypeSize(imageDesc.dataType);
-        AssertImageDataSize(imageDesc.dataSize, static_cast<std::size_t>(srcImageDataSize));
+        AssertImageDataSize(packedImageDesc.dataSize, static_cast<std::size_t>(srcImageDataSize));
         imageData = intermediateData.get();
     }
     else
     {
         /*
         Validate that image data is large enough,
-        then use input data as source for initial data
+        then use input data as source for initial data and pass its strides (in texels) to the buffer-to-image copy
         */
+        if (imageDesc.rowStride != 0 || imageDesc.layerStride != 0)
+        {
+            const auto layout       = CalcSubresourceLayout(format, extent, imageDesc.rowStride, imageDesc.layerStride);
+            const auto blockSize    = std::max(1u, formatAttribs.bitSize / 8u);
+            bufferRowLength     = layout.rowStride / blockSize * formatAttribs.blockWidth;
+            bufferImageHeight   = layout.layerStride / layout.rowStride * formatAttribs.blockHeight;
+            imageDataSize       = layout.dataSize;
+        }
         AssertImageDataSize(imageDesc.dataSize, static_cast<std::size_t>(imageDataSize));
         imageData = imageDesc.data;
     }
 
+    if (stagingBufferPool_.Capacity(imageDataSize))
+    {
+        /* Upload image data via staging ring buffer (on the dedicated transfer queue if enabled) */
+        stagingBufferPool_.WriteImageStaged(
+            textureVK,
+            VkOffset3D{ offset.x, offset.y, offset.z },
+            VkExtent3D{ extent.width, extent.height, extent.depth },
+            subresource,
+            imageData,
+            imageDataSize,
+            GetStagingImageAlignment(format),
+            bufferRowLength,
+            bufferImageHeight
+        );
+        return;
+    }
+
+    /* Record into the shared command buffers exclusively, since resources can be written from multiple threads */
+    std::lock_guard<std::recursive_mutex> guard{ device_.GetMutex() };
+
+    /* Submit pending uploads, then fall back to temporary staging buffer for uploads that exceed the ring buffer */
+    stagingBufferPool_.Flush();
+
     /* Create staging buffer */
     VkBufferCreateInfo stagingCreateInfo;
     BuildVkBufferCreateInfo(
@@ -485,7 +769,10 @@ void VKRenderSystem::WriteTexture(Texture& texture, const TextureRegion& texture
             textureVK.GetVkFormat(),
             VkOffset3D{ offset.x, offset.y, offset.z },
             VkExtent3D{ extent.width, extent.height, extent.depth },
-            subresource
+            subresource,
+            0,
+            bufferRowLength,
+            bufferImageHeight
         );
 
         device_.TransitionImageLayout(
@@ -521,6 +808,12 @@ void VKRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureR
     BuildVkBufferCreateInfo(stagingCreateInfo, imageDataSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT);
     auto stagingBuffer = CreateStagingBuffer(stagingCreateInfo);
 
+    /* Record into the shared command buffers exclusively, since resources can be read from multiple threads */
+    std::lock_guard<std::recursive_mutex> guard{ device_.GetMutex() };
+
+    /* Submit pending uploads before the texture is read back */
+    stagingBufferPool_.Flush();
+
     /* Copy staging buffer into hardware texture, then transfer image into sampling-ready state */
     auto cmdBuffer = device_.AllocCommandBuffer();
     {
@@ -571,11 +864,119 @@ void VKRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureR
     stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
 }
 
+bool VKRenderSystem::QueryTextureTiling(const Texture& texture, TextureTiling& outTiling)
+{
+    auto& textureVK = LLGL_CAST(const VKTexture&, texture);
+    return textureVK.GetTiling(outTiling);
+}
+
+void VKRenderSystem::CommitTextureTiles(Texture& texture, const TextureRegion& textureRegion)
+{
+    auto& textureVK = LLGL_CAST(VKTexture&, texture);
+    textureVK.CommitTiles(device_, *deviceMemoryMngr_, textureRegion, true);
+}
+
+void VKRenderSystem::DecommitTextureTiles(Texture& texture, const TextureRegion& textureRegion)
+{
+    auto& textureVK = LLGL_CAST(VKTexture&, texture);
+    textureVK.CommitTiles(device_, *deviceMemoryMngr_, textureRegion, false);
+}
+
+/* ----- Native resources ----- */
+
+bool VKRenderSystem::QueryNativeHandle(const Resource& resource, NativeResourceHandle& outHandle)
+{
+    switch (resource.GetResourceType())
+    {
+        case ResourceType::Buffer:
+        {
+            auto& bufferVK = LLGL_CAST(const VKBuffer&, resource);
+            bufferVK.GetNativeHandle(outHandle);
+            return true;
+        }
+        case ResourceType::Texture:
+        {
+            auto& textureVK = LLGL_CAST(const VKTexture&, resource);
+            textureVK.GetNativeHandle(outHandle);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+bool VKRenderSystem::ExportResource(Resource& resource, NativeHandleType handleType, NativeResourceHandle& outHandle)
+{
+    switch (resource.GetResourceType())
+    {
+        case ResourceType::Buffer:
+        {
+            auto& bufferVK = LLGL_CAST(const VKBuffer&, resource);
+            return bufferVK.ExportMemory(handleType, outHandle);
+        }
+        case ResourceType::Texture:
+        {
+            auto& textureVK = LLGL_CAST(const VKTexture&, resource);
+            return textureVK.ExportMemory(handleType, outHandle);
+        }
+        default:
+            return false;
+    }
+}
+
+Buffer* VKRenderSystem::ImportBuffer(const BufferDescriptor& bufferDesc, const NativeResourceHandle& nativeHandle)
+{
+    if (nativeHandle.type != NativeHandleType::VkBuffer && VKGetImportMemoryHandleType(nativeHandle.type) == 0)
+        return nullptr;
+
+    AssertCreateBuffer(bufferDesc, static_cast<uint64_t>(std::numeric_limits<VkDeviceSize>::max()));
+    return TakeOwnership(buffers_, MakeUnique<VKBuffer>(device_, *deviceMemoryMngr_, bufferDesc, nativeHandle, device_.GetSharedQueueFamilies()));
+}
+
+Texture* VKRenderSystem::ImportTexture(const TextureDescriptor& textureDesc, const NativeResourceHandle& nativeHandle)
+{
+    if (nativeHandle.type != NativeHandleType::VkImage && VKGetImportMemoryHandleType(nativeHandle.type) == 0)
+        return nullptr;
+
+    auto textureVK = MakeUnique<VKTexture>(device_, *deviceMemoryMngr_, textureDesc, nativeHandle, device_.GetSharedQueueFamilies());
+
+    /* Transition images of imported memory into sampling-ready state; native images must already be in that state */
+    if (nativeHandle.type != NativeHandleType::VkImage)
+    {
+        std::lock_guard<std::recursive_mutex> guard{ device_.GetMutex() };
+        auto cmdBuffer = device_.AllocCommandBuffer();
+        device_.TransitionImageLayout(
+            cmdBuffer,
+            textureVK->GetVkImage(),
+            textureVK->GetVkFormat(),
+            VK_IMAGE_LAYOUT_UNDEFINED,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            TextureSubresource{ 0, textureVK->GetNumArrayLayers(), 0, textureVK->GetNumMipLevels() }
+        );
+        device_.FlushCommandBuffer(cmdBuffer);
+    }
+
+    textureVK->CreateInternalImageView(device_);
+    return TakeOwnership(textures_, std::move(textureVK));
+}
+
+/* ----- Readbacks ----- */
+
+const void* VKRenderSystem::MapReadback(std::uint64_t ticket, ReadbackLayout* outLayout)
+{
+    return readbackPool_->Map(ticket, outLayout);
+}
+
+void VKRenderSystem::UnmapReadback(std::uint64_t ticket)
+{
+    readbackPool_->Unmap(ticket);
+}
+
 /* ----- Sampler States ---- */
 
 Sampler* VKRenderSystem::CreateSampler(const SamplerDescriptor& samplerDesc)
 {
-    return TakeOwnership(samplers_, MakeUnique<VKSampler>(device_, samplerDesc));
+    return TakeOwnership(samplers_, MakeUnique<VKSampler>(device_, samplerCache_, samplerDesc));
 }
 
 void VKRenderSystem::Release(Sampler& sampler)
@@ -589,7 +990,7 @@ ResourceHeap* VKRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor& r
 {
     return TakeOwnership(
         resourceHeaps_,
-        MakeUnique<VKResourceHeap>(device_, resourceHeapDesc, initialResourceViews)
+        MakeUnique<VKResourceHeap>(device_, *descriptorSetAllocator_, resourceHeapDesc, initialResourceViews)
     );
 }
 
@@ -621,7 +1022,7 @@ void VKRenderSystem::Release(RenderPass& renderPass)
 RenderTarget* VKRenderSystem::CreateRenderTarget(const RenderTargetDescriptor& renderTargetDesc)
 {
     AssertCreateRenderTarget(renderTargetDesc);
-    return TakeOwnership(renderTargets_, MakeUnique<VKRenderTarget>(device_, *deviceMemoryMngr_, renderTargetDesc));
+    return TakeOwnership(renderTargets_, MakeUnique<VKRenderTarget>(device_, *deviceMemoryMngr_, *renderPassCache_, *framebufferCache_, dynamicRendering_, renderTargetDesc));
 }
 
 void VKRenderSystem::Release(RenderTarget& renderTarget)
@@ -663,7 +1064,53 @@ PipelineState* VKRenderSystem::CreatePipelineState(const Blob& /*serializedCache
     return nullptr;//TODO
 }
 
-PipelineState* VKRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* /*serializedCache*/)
+PipelineState* VKRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache)
+{
+    LLGL_PROFILER_ZONE("VKRenderSystem::CreateGraphicsPipelineState");
+
+    /* Seed device-wide pipeline cache with the serialized cache from a previous run */
+    if (serializedCache != nullptr && *serializedCache != nullptr)
+        ReadPipelineCache(**serializedCache);
+
+    auto pipelineState = TakeOwnership(
+        pipelineStates_,
+        MakeUnique<VKGraphicsPSO>(
+            device_,
+            defaultPipelineLayout_,
+            (!swapChains_.empty() ? (*swapChains_.begin())->GetRenderPass() : nullptr),
+            pipelineStateDesc,
+            gfxPipelineLimits_,
+            pipelineCache_->GetVkPipelineCache(),
+            pipelineLibraryCache_.get()
+        )
+    );
+
+    if (serializedCache != nullptr)
+        *serializedCache = WritePipelineCache(Serialization::VKIdent_GraphicsPSOIdent);
+
+    return pipelineState;
+}
+
+PipelineState* VKRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache)
+{
+    LLGL_PROFILER_ZONE("VKRenderSystem::CreateComputePipelineState");
+
+    /* Seed device-wide pipeline cache with the serialized cache from a previous run */
+    if (serializedCache != nullptr && *serializedCache != nullptr)
+        ReadPipelineCache(**serializedCache);
+
+    auto pipelineState = TakeOwnership(
+        pipelineStates_,
+        MakeUnique<VKComputePSO>(device_, pipelineStateDesc, defaultPipelineLayout_, pipelineCache_->GetVkPipelineCache())
+    );
+
+    if (serializedCache != nullptr)
+        *serializedCache = WritePipelineCache(Serialization::VKIdent_ComputePSOIdent);
+
+    return pipelineState;
+}
+
+PipelineState* VKRenderSystem::CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc, long flags)
 {
     return TakeOwnership(
         pipelineStates_,
@@ -672,16 +1119,20 @@ PipelineState* VKRenderSystem::CreatePipelineState(const GraphicsPipelineDescrip
             defaultPipelineLayout_,
             (!swapChains_.empty() ? (*swapChains_.begin())->GetRenderPass() : nullptr),
             pipelineStateDesc,
-            gfxPipelineLimits_
+            gfxPipelineLimits_,
+            pipelineCache_->GetVkPipelineCache(),
+            pipelineLibraryCache_.get(),
+            true,
+            flags
         )
     );
 }
 
-PipelineState* VKRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* /*serializedCache*/)
+PipelineState* VKRenderSystem::CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc, long flags)
 {
     return TakeOwnership(
         pipelineStates_,
-        MakeUnique<VKComputePSO>(device_, pipelineStateDesc, defaultPipelineLayout_)
+        MakeUnique<VKComputePSO>(device_, pipelineStateDesc, defaultPipelineLayout_, pipelineCache_->GetVkPipelineCache(), true, flags)
     );
 }
 
@@ -697,7 +1148,7 @@ QueryHeap* VKRenderSystem::CreateQueryHeap(const QueryHeapDescriptor& queryHeapD
     if (queryHeapDesc.renderCondition)
         return TakeOwnership(queryHeaps_, MakeUnique<VKPredicateQueryHeap>(device_, *deviceMemoryMngr_, queryHeapDesc));
     else
-        return TakeOwnership(queryHeaps_, MakeUnique<VKQueryHeap>(device_, queryHeapDesc));
+        return TakeOwnership(queryHeaps_, MakeUnique<VKQueryHeap>(device_, *deviceMemoryMngr_, queryHeapDesc));
 }
 
 void VKRenderSystem::Release(QueryHeap& queryHeap)
@@ -709,7 +1160,7 @@ void VKRenderSystem::Release(QueryHeap& queryHeap)
 
 Fence* VKRenderSystem::CreateFence()
 {
-    return TakeOwnership(fences_, MakeUnique<VKFence>(device_));
+    return TakeOwnership(fences_, MakeUnique<VKFence>(device_, device_.HasTimelineSemaphores()));
 }
 
 void VKRenderSystem::Release(Fence& fence)
@@ -717,6 +1168,78 @@ void VKRenderSystem::Release(Fence& fence)
     RemoveFromUniqueSet(fences_, &fence);
 }
 
+/* ----- Memory ----- */
+
+bool VKRenderSystem::QueryMemoryStatistics(MemoryStatistics& outStats)
+{
+    const auto& memoryProperties = physicalDevice_.GetMemoryProperties();
+
+    /* Query optional memory budget */
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT memoryBudget;
+    const bool hasMemoryBudget = physicalDevice_.QueryMemoryBudget(memoryBudget);
+
+    outStats.heaps.resize(memoryProperties.memoryHeapCount);
+
+    for (std::uint32_t i = 0; i < memoryProperties.memoryHeapCount; ++i)
+    {
+        auto& heapStats = outStats.heaps[i];
+
+        /* Accumulate details of all chunks within this heap */
+        const auto details = deviceMemoryMngr_->QueryHeapDetails(i);
+        const auto freeSize = details.allocatedSize - details.usedSize;
+
+        heapStats.deviceLocal       = ((memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0);
+        heapStats.allocatedSize     = details.allocatedSize;
+        heapStats.usedSize          = details.usedSize;
+        heapStats.numAllocations    = static_cast<std::uint32_t>(details.numChunks);
+        heapStats.numBlocks         = static_cast<std::uint32_t>(details.numBlocks);
+        heapStats.fragmentation     = (freeSize > 0 ? static_cast<float>(details.fragmentedSize) / static_cast<float>(freeSize) : 0.0f);
+
+        if (hasMemoryBudget)
+        {
+            heapStats.budget    = memoryBudget.heapBudget[i];
+            heapStats.usage     = memoryBudget.heapUsage[i];
+        }
+        else
+        {
+            heapStats.budget    = 0;
+            heapStats.usage     = 0;
+        }
+    }
+
+    return true;
+}
+
+/* ----- Residency ----- */
+
+// Returns the device memory region of the specified buffer or texture, or null if it has none (e.g. sparse textures).
+static VKDeviceMemoryRegion* GetResidencyMemoryRegion(Resource* resource)
+{
+    if (resource == nullptr)
+        return nullptr;
+
+    switch (resource->GetResourceType())
+    {
+        case ResourceType::Buffer:
+            return LLGL_CAST(VKBuffer*, resource)->GetDeviceBuffer().GetMemoryRegion();
+        case ResourceType::Texture:
+            return LLGL_CAST(VKTexture*, resource)->GetMemoryRegion();
+        default:
+            return nullptr;
+    }
+}
+
+bool VKRenderSystem::SetResidencyPriority(const ArrayView<Resource*>& resources, ResidencyPriority priority)
+{
+    /* Vulkan only allows to change the priority of device memory; there is no explicit eviction, so MakeResident and Evict are not supported */
+    for (Resource* resource : resources)
+    {
+        if (!deviceMemoryMngr_->SetResidencyPriority(GetResidencyMemoryRegion(resource), priority))
+            return false;
+    }
+    return true;
+}
+
 
 /*
  * ======= Private: =======
@@ -726,23 +1249,26 @@ void VKRenderSystem::Release(Fence& fence)
 #define VK_LAYER_KHRONOS_VALIDATION_NAME "VK_LAYER_KHRONOS_validation"
 #endif
 
-void VKRenderSystem::CreateInstance(const RendererConfigurationVulkan* config)
+void VKRenderSystem::CreateInstance(const RendererConfigurationVulkan* config, VKAdapterProfile& adapterProfile, bool& useAdapterProfile)
 {
-    /* Query instance layer properties */
-    auto layerProperties = VKQueryInstanceLayerProperties();
+    /* Query instance layer and extension properties unless they are taken from the adapter profile */
+    if (!useAdapterProfile)
+    {
+        adapterProfile.instanceLayers       = VKQueryInstanceLayerProperties();
+        adapterProfile.instanceExtensions   = VKQueryInstanceExtensionProperties();
+    }
+
     std::vector<const char*> layerNames;
 
-    for (const auto& prop : layerProperties)
+    for (const auto& prop : adapterProfile.instanceLayers)
     {
         if (IsLayerRequired(prop.layerName, config))
             layerNames.push_back(prop.layerName);
     }
 
-    /* Query instance extension properties */
-    auto extensionProperties = VKQueryInstanceExtensionProperties();
     std::vector<const char*> extensionNames;
 
-    for (const auto& prop : extensionProperties)
+    for (const auto& prop : adapterProfile.instanceExtensions)
     {
         if (IsExtensionRequired(prop.extensionName))
             extensionNames.push_back(prop.extensionName);
@@ -800,6 +1326,15 @@ void VKRenderSystem::CreateInstance(const RendererConfigurationVulkan* config)
 
     /* Create Vulkan instance */
     VkResult result = vkCreateInstance(&instanceInfo, nullptr, instance_.ReleaseAndGetAddressOf());
+
+    if (useAdapterProfile && (result == VK_ERROR_LAYER_NOT_PRESENT || result == VK_ERROR_EXTENSION_NOT_PRESENT))
+    {
+        /* Adapter profile is outdated, e.g. a layer has been uninstalled; try again with full enumeration */
+        useAdapterProfile = false;
+        CreateInstance(config, adapterProfile, useAdapterProfile);
+        return;
+    }
+
     VKThrowIfFailed(result, "failed to create Vulkan instance");
 
     if (debugLayerEnabled_)
@@ -859,11 +1394,18 @@ void VKRenderSystem::CreateDebugReportCallback()
     VKThrowIfFailed(result, "failed to create Vulkan debug report callback");
 }
 
-void VKRenderSystem::PickPhysicalDevice()
+void VKRenderSystem::PickPhysicalDevice(int deviceIndex, VKAdapterProfile& adapterProfile, bool& useAdapterProfile)
 {
-    /* Pick physical device with Vulkan support */
-    if (!physicalDevice_.PickPhysicalDevice(instance_))
-        throw std::runtime_error("failed to find suitable Vulkan device");
+    /* Pick physical device from adapter profile first, otherwise enumerate all physical devices with Vulkan support */
+    if (useAdapterProfile && !physicalDevice_.PickPhysicalDeviceFromProfile(instance_, headless_, deviceIndex, adapterProfile))
+        useAdapterProfile = false;
+
+    if (!useAdapterProfile)
+    {
+        if (!physicalDevice_.PickPhysicalDevice(instance_, headless_, deviceIndex))
+            throw std::runtime_error("failed to find suitable Vulkan device");
+        physicalDevice_.StoreAdapterProfile(adapterProfile);
+    }
 
     /* Query and store rendering capabilities */
     RendererInfo info;
@@ -879,16 +1421,30 @@ void VKRenderSystem::PickPhysicalDevice()
     SetRenderingCaps(caps);
 }
 
-void VKRenderSystem::CreateLogicalDevice()
+void VKRenderSystem::CreateLogicalDevice(bool dedicatedTransferQueue, bool asyncComputeQueue)
 {
     /* Create logical device with all supported physical device feature */
-    device_ = physicalDevice_.CreateLogicalDevice();
+    device_ = physicalDevice_.CreateLogicalDevice(dedicatedTransferQueue, asyncComputeQueue);
 
     /* Create command queue interface */
-    commandQueue_ = MakeUnique<VKCommandQueue>(device_, device_.GetVkQueue());
+    commandQueue_ = MakeUnique<VKCommandQueue>(device_, device_.GetVkQueue(), device_.GetMutex(), stagingBufferPool_);
+
+    /* Create optional command queue interface for asynchronous compute */
+    if (device_.GetVkComputeQueue() != VK_NULL_HANDLE)
+        computeQueue_ = MakeUnique<VKCommandQueue>(device_, device_.GetVkComputeQueue(), device_.GetMutex(), stagingBufferPool_);
 
     /* Load Vulkan device extensions */
     VKLoadDeviceExtensions(device_, physicalDevice_.GetExtensionNames());
+
+    /* Enable calibrated timestamps for all command queues if the host time domain of Timer::Tick is supported */
+    VkTimeDomainEXT hostTimeDomain;
+    if (physicalDevice_.QueryHostTimeDomain(instance_, hostTimeDomain))
+    {
+        const float timestampPeriod = physicalDevice_.GetProperties().limits.timestampPeriod;
+        commandQueue_->EnableTimestampCalibration(hostTimeDomain, timestampPeriod);
+        if (computeQueue_)
+            computeQueue_->EnableTimestampCalibration(hostTimeDomain, timestampPeriod);
+    }
 }
 
 void VKRenderSystem::CreateDefaultPipelineLayout()
@@ -901,6 +1457,36 @@ void VKRenderSystem::CreateDefaultPipelineLayout()
     VKThrowIfFailed(result, "failed to create Vulkan default pipeline layout");
 }
 
+void VKRenderSystem::ReadPipelineCache(const Blob& serializedCache)
+{
+    Serialization::Deserializer reader{ serializedCache };
+
+    /* Read type of PSO */
+    auto seg = reader.ReadSegment();
+    if (seg.ident != Serialization::VKIdent_GraphicsPSOIdent && seg.ident != Serialization::VKIdent_ComputePSOIdent)
+        throw std::runtime_error("serialized cache does not denote a Vulkan graphics or compute PSO");
+
+    /* Merge optional pipeline cache data into device-wide cache */
+    seg = reader.ReadSegmentOnMatch(Serialization::VKIdent_PipelineCache);
+    if (seg.ident == Serialization::VKIdent_PipelineCache)
+        pipelineCache_->Merge(device_, seg.data, seg.size);
+}
+
+std::unique_ptr<Blob> VKRenderSystem::WritePipelineCache(Serialization::IdentType psoIdent)
+{
+    Serialization::Serializer writer;
+
+    /* Write type of PSO */
+    writer.Begin(psoIdent);
+    writer.End();
+
+    /* Write entire content of device-wide pipeline cache, so it can be reused for all PSOs on the next run */
+    if (auto cacheData = pipelineCache_->GetData(device_))
+        writer.WriteSegment(Serialization::VKIdent_PipelineCache, cacheData->GetData(), cacheData->GetSize());
+
+    return writer.Finalize();
+}
+
 bool VKRenderSystem::IsLayerRequired(const char* name, const RendererConfigurationVulkan* config) const
 {
     if (config != nullptr)
@@ -923,6 +1509,14 @@ bool VKRenderSystem::IsLayerRequired(const char* name, const RendererConfigurati
 
 bool VKRenderSystem::IsExtensionRequired(const std::string& name) const
 {
+    /* Headless render systems don't enable any surface extensions, so no window system has to be available */
+    if (debugLayerEnabled_ && name == VK_EXT_DEBUG_REPORT_EXTENSION_NAME)
+        return true;
+    /* External memory device extensions depend on these instance extensions, so they are enabled whenever they are available */
+    if (name == VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME || name == VK_KHR_EXTERNAL_MEMORY_CAPABILITIES_EXTENSION_NAME)
+        return true;
+    if (headless_)
+        return false;
     return
     (
         name == VK_KHR_SURFACE_EXTENSION_NAME
@@ -932,7 +1526,6 @@ bool VKRenderSystem::IsExtensionRequired(const std::string& name) const
         #ifdef LLGL_OS_LINUX
         || name == VK_KHR_XLIB_SURFACE_EXTENSION_NAME
         #endif
-        || (debugLayerEnabled_ && name == VK_EXT_DEBUG_REPORT_EXTENSION_NAME)
     );
 }
 
@@ -962,6 +1555,35 @@ VKDeviceBuffer VKRenderSystem::CreateStagingBufferAndInitialize(
     return stagingBuffer;
 }
 
+void VKRenderSystem::WriteStagedBuffer(VkBuffer dstBuffer, VkDeviceSize dstOffset, const void* data, VkDeviceSize dataSize, bool preserveContent)
+{
+    if (stagingBufferPool_.Capacity(dataSize))
+    {
+        /* Copy data into staging ring buffer and record copy command into pending command buffer */
+        stagingBufferPool_.WriteStaged(dstBuffer, dstOffset, data, dataSize, preserveContent);
+    }
+    else
+    {
+        /* Submit pending uploads, then fall back to temporary staging buffer for uploads that exceed the ring buffer */
+        stagingBufferPool_.Flush();
+
+        VkBufferCreateInfo stagingCreateInfo;
+        BuildVkBufferCreateInfo(
+            stagingCreateInfo,
+            dataSize,
+            (VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT)
+        );
+
+        auto stagingBuffer = CreateStagingBufferAndInitialize(stagingCreateInfo, data, dataSize);
+
+        /* Copy staging buffer into hardware buffer */
+        device_.CopyBuffer(stagingBuffer.GetVkBuffer(), dstBuffer, dataSize, 0, dstOffset);
+
+        /* Release device memory region of staging buffer */
+        stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
+    }
+}
+
 
 } // /namespace LLGL
 
@@ -13,6 +13,7 @@
 #include "VKPhysicalDevice.h"
 #include "VKDevice.h"
 #include "../ContainerTypes.h"
+#include "../Serialization.h"
 #include "Memory/VKDeviceMemoryManager.h"
 
 #include "VKCommandQueue.h"
@@ -21,6 +22,8 @@
 
 #include "Buffer/VKBuffer.h"
 #include "Buffer/VKBufferArray.h"
+#include "Buffer/VKStagingBufferPool.h"
+#include "Buffer/VKReadbackPool.h"
 
 #include "Shader/VKShader.h"
 
@@ -34,6 +37,10 @@
 #include "RenderState/VKPipelineLayout.h"
 #include "RenderState/VKGraphicsPSO.h"
 #include "RenderState/VKResourceHeap.h"
+#include "RenderState/VKPipelineCache.h"
+#include "RenderState/VKPipelineLibraryCache.h"
+#include "RenderState/VKDescriptorSetAllocator.h"
+#include "RenderState/VKRenderPassCache.h"
 
 #include <string>
 #include <memory>
@@ -65,6 +72,7 @@ class VKRenderSystem final : public RenderSystem
         /* ----- Command queues ----- */
 
         CommandQueue* GetCommandQueue() override;
+        CommandQueue* GetComputeQueue() override;
 
         /* ----- Command buffers ----- */
 
@@ -75,12 +83,13 @@ class VKRenderSystem final : public RenderSystem
         /* ----- Buffers ------ */
 
         Buffer* CreateBuffer(const BufferDescriptor& bufferDesc, const void* initialData = nullptr) override;
-        BufferArray* CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray) override;
+        BufferArray* CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray, const std::uint64_t* offsets = nullptr) override;
 
         void Release(Buffer& buffer) override;
         void Release(BufferArray& bufferArray) override;
 
         void WriteBuffer(Buffer& buffer, std::uint64_t offset, const void* data, std::uint64_t dataSize) override;
+        void WriteBuffer(Buffer& buffer, std::uint32_t numRegions, const BufferWriteRegion* regions) override;
         void ReadBuffer(Buffer& buffer, std::uint64_t offset, void* data, std::uint64_t dataSize) override;
 
         void* MapBuffer(Buffer& buffer, const CPUAccess access) override;
@@ -96,6 +105,22 @@ class VKRenderSystem final : public RenderSystem
         void WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc) override;
         void ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc) override;
 
+        bool QueryTextureTiling(const Texture& texture, TextureTiling& outTiling) override;
+        void CommitTextureTiles(Texture& texture, const TextureRegion& textureRegion) override;
+        void DecommitTextureTiles(Texture& texture, const TextureRegion& textureRegion) override;
+
+        /* ----- Native resources ----- */
+
+        bool QueryNativeHandle(const Resource& resource, NativeResourceHandle& outHandle) override;
+        bool ExportResource(Resource& resource, NativeHandleType handleType, NativeResourceHandle& outHandle) override;
+        Buffer* ImportBuffer(const BufferDescriptor& bufferDesc, const NativeResourceHandle& nativeHandle) override;
+        Texture* ImportTexture(const TextureDescriptor& textureDesc, const NativeResourceHandle& nativeHandle) override;
+
+        /* ----- Readbacks ----- */
+
+        const void* MapReadback(std::uint64_t ticket, ReadbackLayout* outLayout = nullptr) override;
+        void UnmapReadback(std::uint64_t ticket) override;
+
         /* ----- Sampler States ---- */
 
         Sampler* CreateSampler(const SamplerDescriptor& samplerDesc) override;
@@ -139,6 +164,8 @@ class VKRenderSystem final : public RenderSystem
         PipelineState* CreatePipelineState(const Blob& serializedCache) override;
         PipelineState* CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache = nullptr) override;
         PipelineState* CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache = nullptr) override;
+        PipelineState* CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc, long flags = 0) override;
+        PipelineState* CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc, long flags = 0) override;
 
         void Release(PipelineState& pipelineState) override;
 
@@ -154,14 +181,25 @@ class VKRenderSystem final : public RenderSystem
 
         void Release(Fence& fence) override;
 
+        /* ----- Memory ----- */
+
+        bool QueryMemoryStatistics(MemoryStatistics& outStats) override;
+
+        /* ----- Residency ----- */
+
+        bool SetResidencyPriority(const ArrayView<Resource*>& resources, ResidencyPriority priority) override;
+
     private:
 
-        void CreateInstance(const RendererConfigurationVulkan* config);
+        void CreateInstance(const RendererConfigurationVulkan* config, VKAdapterProfile& adapterProfile, bool& useAdapterProfile);
         void CreateDebugReportCallback();
-        void PickPhysicalDevice();
-        void CreateLogicalDevice();
+        void PickPhysicalDevice(int deviceIndex, VKAdapterProfile& adapterProfile, bool& useAdapterProfile);
+        void CreateLogicalDevice(bool dedicatedTransferQueue, bool asyncComputeQueue);
         void CreateDefaultPipelineLayout();
 
+        void ReadPipelineCache(const Blob& serializedCache);
+        std::unique_ptr<Blob> WritePipelineCache(Serialization::IdentType psoIdent);
+
         bool IsLayerRequired(const char* name, const RendererConfigurationVulkan* config) const;
         bool IsExtensionRequired(const std::string& name) const;
 
@@ -173,6 +211,9 @@ class VKRenderSystem final : public RenderSystem
             VkDeviceSize                dataSize
         );
 
+        // Writes the specified data into the destination buffer via the staging ring buffer if it is large enough.
+        void WriteStagedBuffer(VkBuffer dstBuffer, VkDeviceSize dstOffset, const void* data, VkDeviceSize dataSize, bool preserveContent);
+
     private:
 
         /* ----- Common objects ----- */
@@ -186,15 +227,27 @@ class VKRenderSystem final : public RenderSystem
         VKPtr<VkPipelineLayout>                 defaultPipelineLayout_;
 
         bool                                    debugLayerEnabled_      = false;
+        bool                                    headless_               = false;
 
         std::unique_ptr<VKDeviceMemoryManager>  deviceMemoryMngr_;
+        std::unique_ptr<VKPipelineCache>        pipelineCache_;
+        std::unique_ptr<VKPipelineLibraryCache> pipelineLibraryCache_;                  // Only created with "VK_EXT_graphics_pipeline_library"
+        VKStagingBufferPool                     stagingBufferPool_;
+        std::unique_ptr<VKReadbackPool>         readbackPool_;
+        std::unique_ptr<VKRenderPassCache>      renderPassCache_;                       // Must be declared before the render targets, since they release their render passes here
+        std::unique_ptr<VKFramebufferCache>     framebufferCache_;
+        std::unique_ptr<VKDescriptorSetAllocator> descriptorSetAllocator_;              // Must be declared before the resource heaps, since they release their descriptor sets here
+        bool                                    dynamicRendering_       = false;        // Render targets use "VK_KHR_dynamic_rendering"
 
         VKGraphicsPipelineLimits                gfxPipelineLimits_;
 
+        VKSamplerCache                          samplerCache_;                          // Must be declared before the samplers, since they release their native objects here
+
         /* ----- Hardware object containers ----- */
 
         HWObjectContainer<VKSwapChain>          swapChains_;
         HWObjectInstance<VKCommandQueue>        commandQueue_;
+        HWObjectInstance<VKCommandQueue>        computeQueue_;
         HWObjectContainer<VKCommandBuffer>      commandBuffers_;
         HWObjectContainer<VKBuffer>             buffers_;
         HWObjectContainer<VKBufferArray>        bufferArrays_;
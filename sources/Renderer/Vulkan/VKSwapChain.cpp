@@ -9,11 +9,17 @@
 #include "VKCore.h"
 #include "VKTypes.h"
 #include "Memory/VKDeviceMemoryManager.h"
+#include "Ext/VKExtensionRegistry.h"
+#include "Ext/VKExtensions.h"
 #include <LLGL/Platform/NativeHandle.h>
+#include <LLGL/Timer.h>
+#include <LLGL/PipelineStateFlags.h>
 #include "../../Core/Helper.h"
 #include "../TextureUtils.h"
+#include <algorithm>
 #include <limits.h>
 #include <set>
+#include <vector>
 
 
 namespace LLGL
@@ -29,6 +35,9 @@ static const std::vector<const char*> g_deviceExtensions
     VK_KHR_SWAPCHAIN_EXTENSION_NAME
 };
 
+// Maximum number of bytes of device memory that are relocated after each presentation.
+static const VkDeviceSize g_maxDefragmentationSizePerFrame = 1024*1024;
+
 static VKPtr<VkImageView> NullVkImageView(const VKPtr<VkDevice>& device)
 {
     return VKPtr<VkImageView>{ device, vkDestroyImageView };
@@ -39,11 +48,17 @@ static VKPtr<VkFramebuffer> NullVkFramebuffer(const VKPtr<VkDevice>& device)
     return VKPtr<VkFramebuffer>{ device, vkDestroyFramebuffer };
 }
 
+static VKPtr<VkFence> NullVkFence(const VKPtr<VkDevice>& device)
+{
+    return VKPtr<VkFence>{ device, vkDestroyFence };
+}
+
 VKSwapChain::VKSwapChain(
     const VKPtr<VkInstance>&        instance,
     VkPhysicalDevice                physicalDevice,
     const VKPtr<VkDevice>&          device,
     VKDeviceMemoryManager&          deviceMemoryMngr,
+    std::recursive_mutex&           queueMutex,
     const SwapChainDescriptor&      desc,
     const std::shared_ptr<Surface>& surface)
 :
@@ -52,6 +67,7 @@ VKSwapChain::VKSwapChain(
     physicalDevice_          { physicalDevice                  },
     device_                  { device                          },
     deviceMemoryMngr_        { deviceMemoryMngr                },
+    queueMutex_              { queueMutex                      },
     surface_                 { instance, vkDestroySurfaceKHR   },
     swapChain_               { device, vkDestroySwapchainKHR   },
     swapChainRenderPass_     { device                          },
@@ -66,15 +82,22 @@ VKSwapChain::VKSwapChain(
     depthStencilBuffer_      { device                          },
     colorBuffers_            { device, device, device          },
     imageAvailableSemaphore_ { device, vkDestroySemaphore      },
-    renderFinishedSemaphore_ { device, vkDestroySemaphore      }
+    renderFinishedSemaphore_ { device, vkDestroySemaphore      },
+    frameLatencyFences_      { NullVkFence(device_),
+                               NullVkFence(device_),
+                               NullVkFence(device_)            },
+    maxFrameLatency_         { std::min(desc.maxFrameLatency,
+                                        maxNumColorBuffers)    }
 {
     SetOrCreateSurface(surface, desc.resolution, desc.fullscreen, nullptr);
 
     CreatePresentSemaphores();
+    CreateFrameLatencyFences();
     CreateGpuSurface();
 
     /* Pick image count for swap-chain and depth-stencil format */
-    numSwapChainBuffers_ = PickSwapChainSize(desc.swapBuffers);
+    presentMode_ = desc.presentMode;
+    numSwapChainBuffers_ = PickSwapChainSize(desc.swapBuffers, maxFrameLatency_);
     depthStencilFormat_ = PickDepthStencilFormat(desc.depthBits, desc.stencilBits);
 
     /* Create Vulkan swap-chain and render pass */
@@ -105,16 +128,61 @@ void VKSwapChain::Present()
         submitInfo.signalSemaphoreCount = 1;
         submitInfo.pSignalSemaphores    = signalSemaphores;
     }
-    auto result = vkQueueSubmit(graphicsQueue_, 1, &submitInfo, VK_NULL_HANDLE);
+
+    /* Signal fence of this frame to limit the number of frames in flight (see WaitForNextFrame) */
+    VkFence frameFence = VK_NULL_HANDLE;
+    if (maxFrameLatency_ > 0)
+    {
+        frameFence = frameLatencyFences_[frameLatencyIndex_].Get();
+        vkWaitForFences(device_, 1, &frameFence, VK_TRUE, UINT64_MAX);
+        vkResetFences(device_, 1, &frameFence);
+        frameLatencyIndex_ = (frameLatencyIndex_ + 1) % maxFrameLatency_;
+    }
+
+    std::unique_lock<std::recursive_mutex> queueLock{ queueMutex_ };
+    auto result = vkQueueSubmit(graphicsQueue_, 1, &submitInfo, frameFence);
     VKThrowIfFailed(result, "failed to submit semaphore to Vulkan graphics queue");
 
     /* Present result on screen */
     VkSwapchainKHR swapChains[] = { swapChain_ };
 
+    /* Tag each present with an ID to query its timing later with VK_GOOGLE_display_timing (see QueryPresentStatistics) */
+    VkPresentTimeGOOGLE presentTime;
+    VkPresentTimesInfoGOOGLE presentTimesInfo;
+    const bool hasDisplayTiming = HasExtension(VKExt::GOOGLE_display_timing);
+    if (hasDisplayTiming)
+    {
+        presentTime.presentID           = ++presentID_;
+        presentTime.desiredPresentTime  = 0;
+
+        presentTimesInfo.sType          = VK_STRUCTURE_TYPE_PRESENT_TIMES_INFO_GOOGLE;
+        presentTimesInfo.pNext          = nullptr;
+        presentTimesInfo.swapchainCount = 1;
+        presentTimesInfo.pTimes         = &presentTime;
+    }
+
+    /* Only present the damage regions if they have been set for this frame (see SetDamageRegions) */
+    VkPresentRegionKHR presentRegion;
+    VkPresentRegionsKHR presentRegionsInfo;
+    const bool hasDamageRegions = !damageRects_.empty();
+    if (hasDamageRegions)
+    {
+        presentRegion.rectangleCount        = static_cast<std::uint32_t>(damageRects_.size());
+        presentRegion.pRectangles           = damageRects_.data();
+
+        presentRegionsInfo.sType            = VK_STRUCTURE_TYPE_PRESENT_REGIONS_KHR;
+        presentRegionsInfo.pNext            = (hasDisplayTiming ? &presentTimesInfo : nullptr);
+        presentRegionsInfo.swapchainCount   = 1;
+        presentRegionsInfo.pRegions         = &presentRegion;
+    }
+
     VkPresentInfoKHR presentInfo;
     {
         presentInfo.sType               = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-        presentInfo.pNext               = nullptr;
+        if (hasDamageRegions)
+            presentInfo.pNext           = &presentRegionsInfo;
+        else
+            presentInfo.pNext           = (hasDisplayTiming ? &presentTimesInfo : nullptr);
         presentInfo.waitSemaphoreCount  = 1;
         presentInfo.pWaitSemaphores     = signalSemaphores;
         presentInfo.swapchainCount      = 1;
@@ -123,12 +191,102 @@ void VKSwapChain::Present()
         presentInfo.pResults            = nullptr;
     }
     result = vkQueuePresentKHR(presentQueue_, &presentInfo);
+    queueLock.unlock();
+    damageRects_.clear();
     VKThrowIfFailed(result, "failed to present Vulkan graphics queue");
 
+    /* Use the time between frames to incrementally defragment device memory */
+    deviceMemoryMngr_.Defragment(g_maxDefragmentationSizePerFrame);
+
     /* Get image index for next presentation */
     AcquireNextPresentImage();
 }
 
+void VKSwapChain::WaitForNextFrame()
+{
+    /* Wait until the GPU has finished the frame that was presented 'maxFrameLatency' frames ago */
+    if (maxFrameLatency_ > 0)
+    {
+        VkFence frameFence = frameLatencyFences_[frameLatencyIndex_].Get();
+        vkWaitForFences(device_, 1, &frameFence, VK_TRUE, UINT64_MAX);
+    }
+}
+
+bool VKSwapChain::SetDamageRegions(std::uint32_t numRegions, const Scissor* regions)
+{
+    if (!HasExtension(VKExt::KHR_incremental_present))
+        return false;
+
+    /* Clamp damage regions to the swap-chain extent, since VK_KHR_incremental_present requires them to be inside the presentable images */
+    damageRects_.clear();
+    damageRects_.reserve(numRegions);
+    for (std::uint32_t i = 0; i < numRegions; ++i)
+    {
+        const std::int32_t x0 = Clamp<std::int32_t>(regions[i].x, 0, static_cast<std::int32_t>(swapChainExtent_.width));
+        const std::int32_t y0 = Clamp<std::int32_t>(regions[i].y, 0, static_cast<std::int32_t>(swapChainExtent_.height));
+        const std::int32_t x1 = Clamp<std::int32_t>(regions[i].x + regions[i].width, x0, static_cast<std::int32_t>(swapChainExtent_.width));
+        const std::int32_t y1 = Clamp<std::int32_t>(regions[i].y + regions[i].height, y0, static_cast<std::int32_t>(swapChainExtent_.height));
+        if (x1 > x0 && y1 > y0)
+        {
+            VkRectLayerKHR rect;
+            {
+                rect.offset = { x0, y0 };
+                rect.extent = { static_cast<std::uint32_t>(x1 - x0), static_cast<std::uint32_t>(y1 - y0) };
+                rect.layer  = 0;
+            }
+            damageRects_.push_back(rect);
+        }
+    }
+
+    return true;
+}
+
+bool VKSwapChain::QueryPresentStatistics(PresentStatistics& outStats)
+{
+    if (!HasExtension(VKExt::GOOGLE_display_timing))
+        return false;
+
+    /* Query refresh cycle once; this is in nanoseconds */
+    if (refreshDuration_ == 0)
+    {
+        VkRefreshCycleDurationGOOGLE refreshCycle;
+        if (vkGetRefreshCycleDurationGOOGLE(device_, swapChain_, &refreshCycle) == VK_SUCCESS)
+            refreshDuration_ = refreshCycle.refreshDuration;
+    }
+
+    /* Only the most recent timings are of interest, so all older ones are discarded by the driver when they are read here */
+    std::uint32_t numTimings = 0;
+    if (vkGetPastPresentationTimingGOOGLE(device_, swapChain_, &numTimings, nullptr) != VK_SUCCESS)
+        return false;
+
+    if (numTimings > 0)
+    {
+        /* Reuse the timings container for each query, so this does not allocate memory in every frame */
+        if (pastPresentTimings_.size() < numTimings)
+            pastPresentTimings_.resize(numTimings);
+        auto result = vkGetPastPresentationTimingGOOGLE(device_, swapChain_, &numTimings, pastPresentTimings_.data());
+        if ((result != VK_SUCCESS && result != VK_INCOMPLETE) || numTimings == 0)
+            return false;
+        lastPresentTiming_ = pastPresentTimings_[numTimings - 1];
+    }
+    else if (lastPresentTiming_.presentID == 0)
+        return false;
+
+    /* Vulkan reports times in nanoseconds, so convert them into the time domain of Timer::Tick */
+    const std::uint64_t frequency = Timer::Frequency();
+    auto NanosecondsToTicks = [frequency](std::uint64_t t) -> std::uint64_t
+    {
+        return (frequency == 1000000000ull ? t : static_cast<std::uint64_t>(static_cast<double>(t) * static_cast<double>(frequency) / 1.0e9));
+    };
+
+    outStats.presentCount   = lastPresentTiming_.presentID;
+    outStats.refreshCount   = (refreshDuration_ > 0 ? (lastPresentTiming_.actualPresentTime + refreshDuration_/2) / refreshDuration_ : 0);
+    outStats.syncTime       = NanosecondsToTicks(lastPresentTiming_.actualPresentTime);
+    outStats.refreshPeriod  = NanosecondsToTicks(refreshDuration_);
+
+    return true;
+}
+
 std::uint32_t VKSwapChain::GetSamples() const
 {
     return swapChainSamples_;
@@ -185,7 +343,10 @@ bool VKSwapChain::ResizeBuffersPrimary(const Extent2D& resolution)
         swapChainExtent_.height != resolution.height)
     {
         /* Wait until graphics queue is idle before resources are destroyed and recreated */
-        vkQueueWaitIdle(graphicsQueue_);
+        {
+            std::lock_guard<std::recursive_mutex> guard{ queueMutex_ };
+            vkQueueWaitIdle(graphicsQueue_);
+        }
 
         /* Recreate presenting semaphores and Vulkan surface */
         CreatePresentSemaphores();
@@ -218,6 +379,22 @@ void VKSwapChain::CreatePresentSemaphores()
     CreateGpuSemaphore(renderFinishedSemaphore_);
 }
 
+void VKSwapChain::CreateFrameLatencyFences()
+{
+    /* Create fences in signaled state, so the first frames do not wait */
+    VkFenceCreateInfo createInfo;
+    {
+        createInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+    }
+    for (std::uint32_t i = 0; i < maxFrameLatency_; ++i)
+    {
+        auto result = vkCreateFence(device_, &createInfo, nullptr, frameLatencyFences_[i].ReleaseAndGetAddressOf());
+        VKThrowIfFailed(result, "failed to create Vulkan fence");
+    }
+}
+
 void VKSwapChain::CreateGpuSurface()
 {
     /* All previous swap-chains must be destroyed before VkSurfaceKHR can be destroyed */
@@ -507,8 +684,34 @@ VkSurfaceFormatKHR VKSwapChain::PickSwapSurfaceFormat(const std::vector<VkSurfac
     return surfaceFormats.front();
 }
 
+static bool IsPresentModeSupported(const std::vector<VkPresentModeKHR>& presentModes, VkPresentModeKHR mode)
+{
+    return (std::find(presentModes.begin(), presentModes.end(), mode) != presentModes.end());
+}
+
 VkPresentModeKHR VKSwapChain::PickSwapPresentMode(const std::vector<VkPresentModeKHR>& presentModes, std::uint32_t vsyncInterval) const
 {
+    /* Pick explicit presentation mode with fallbacks to the closest mode; FIFO is always supported */
+    switch (presentMode_)
+    {
+        case PresentMode::Fifo:
+            return VK_PRESENT_MODE_FIFO_KHR;
+        case PresentMode::Mailbox:
+            if (IsPresentModeSupported(presentModes, VK_PRESENT_MODE_MAILBOX_KHR))
+                return VK_PRESENT_MODE_MAILBOX_KHR;
+            if (IsPresentModeSupported(presentModes, VK_PRESENT_MODE_IMMEDIATE_KHR))
+                return VK_PRESENT_MODE_IMMEDIATE_KHR;
+            return VK_PRESENT_MODE_FIFO_KHR;
+        case PresentMode::Immediate:
+            if (IsPresentModeSupported(presentModes, VK_PRESENT_MODE_IMMEDIATE_KHR))
+                return VK_PRESENT_MODE_IMMEDIATE_KHR;
+            if (IsPresentModeSupported(presentModes, VK_PRESENT_MODE_MAILBOX_KHR))
+                return VK_PRESENT_MODE_MAILBOX_KHR;
+            return VK_PRESENT_MODE_FIFO_KHR;
+        default:
+            break;
+    }
+
     if (vsyncInterval == 0)
     {
         /* Check if MAILBOX or IMMEDIATE presentation mode is available, to avoid vertical synchronization */
@@ -557,9 +760,18 @@ VkFormat VKSwapChain::PickDepthStencilFormat(int depthBits, int stencilBits) con
     );
 }
 
-std::uint32_t VKSwapChain::PickSwapChainSize(std::uint32_t swapBuffers) const
+std::uint32_t VKSwapChain::PickSwapChainSize(std::uint32_t swapBuffers, std::uint32_t maxFrameLatency) const
 {
-    return std::max(surfaceSupportDetails_.caps.minImageCount, std::min(swapBuffers, surfaceSupportDetails_.caps.maxImageCount));
+    /* Use one more image than frames in flight, so the CPU can record the next frame while the previous ones are queued up */
+    if (maxFrameLatency > 0)
+        swapBuffers = maxFrameLatency + 1;
+
+    /* Clamp to surface capabilities; a maximum image count of 0 means there is no limit */
+    std::uint32_t maxImageCount = maxNumColorBuffers;
+    if (surfaceSupportDetails_.caps.maxImageCount > 0)
+        maxImageCount = std::min(maxImageCount, surfaceSupportDetails_.caps.maxImageCount);
+
+    return std::max(surfaceSupportDetails_.caps.minImageCount, std::min(swapBuffers, maxImageCount));
 }
 
 void VKSwapChain::AcquireNextPresentImage()
@@ -18,6 +18,7 @@
 #include "Texture/VKColorBuffer.h"
 #include <memory>
 #include <vector>
+#include <mutex>
 
 
 namespace LLGL
@@ -37,11 +38,15 @@ class VKSwapChain final : public SwapChain
             VkPhysicalDevice                physicalDevice,
             const VKPtr<VkDevice>&          device,
             VKDeviceMemoryManager&          deviceMemoryMngr,
+            std::recursive_mutex&           queueMutex,
             const SwapChainDescriptor&      desc,
             const std::shared_ptr<Surface>& surface
         );
 
         void Present() override;
+        void WaitForNextFrame() override;
+        bool QueryPresentStatistics(PresentStatistics& outStats) override;
+        bool SetDamageRegions(std::uint32_t numRegions, const Scissor* regions) override;
 
         std::uint32_t GetSamples() const override;
 
@@ -90,6 +95,7 @@ class VKSwapChain final : public SwapChain
 
         void CreateGpuSemaphore(VKPtr<VkSemaphore>& semaphore);
         void CreatePresentSemaphores();
+        void CreateFrameLatencyFences();
         void CreateGpuSurface();
 
         void CreateRenderPass(VKRenderPass& renderPass, bool isSecondary);
@@ -110,7 +116,7 @@ class VKSwapChain final : public SwapChain
         VkPresentModeKHR PickSwapPresentMode(const std::vector<VkPresentModeKHR>& presentModes, std::uint32_t vsyncInterval) const;
         VkExtent2D PickSwapExtent(const VkSurfaceCapabilitiesKHR& surfaceCaps, const Extent2D& resolution) const;
         VkFormat PickDepthStencilFormat(int depthBits, int stencilBits) const;
-        std::uint32_t PickSwapChainSize(std::uint32_t swapBuffers) const;
+        std::uint32_t PickSwapChainSize(std::uint32_t swapBuffers, std::uint32_t maxFrameLatency) const;
 
         void AcquireNextPresentImage();
 
@@ -123,6 +129,7 @@ class VKSwapChain final : public SwapChain
         const VKPtr<VkDevice>&  device_;
 
         VKDeviceMemoryManager&  deviceMemoryMngr_;
+        std::recursive_mutex&   queueMutex_;                                // Guards the graphics queue against staged uploads from other threads
 
         VKPtr<VkSurfaceKHR>     surface_;
         SurfaceSupportDetails   surfaceSupportDetails_;
@@ -139,6 +146,7 @@ class VKSwapChain final : public SwapChain
         std::uint32_t           numSwapChainBuffers_                        = 1;
         std::uint32_t           presentImageIndex_                          = 0;
         std::uint32_t           vsyncInterval_                              = 0;
+        PresentMode             presentMode_                                = PresentMode::Undefined;
 
         VKRenderPass            secondaryRenderPass_;
         VkFormat                depthStencilFormat_                         = VK_FORMAT_UNDEFINED;
@@ -151,6 +159,18 @@ class VKSwapChain final : public SwapChain
         VKPtr<VkSemaphore>      imageAvailableSemaphore_;
         VKPtr<VkSemaphore>      renderFinishedSemaphore_;
 
+        VKPtr<VkFence>          frameLatencyFences_[maxNumColorBuffers];    // Signaled when the GPU has finished a presented frame; only used if maxFrameLatency > 0
+        std::uint32_t           maxFrameLatency_                            = 0;
+        std::uint32_t           frameLatencyIndex_                          = 0;
+
+        std::uint32_t                   presentID_          = 0;    // Incremented with each present; only used with VK_GOOGLE_display_timing
+        std::uint64_t                   refreshDuration_    = 0;    // Display refresh cycle (in nanoseconds)
+        VkPastPresentationTimingGOOGLE  lastPresentTiming_  = {};
+
+        std::vector<VkPastPresentationTimingGOOGLE> pastPresentTimings_;    // Container for the timing queries; only used with VK_GOOGLE_display_timing
+
+        std::vector<VkRectLayerKHR>     damageRects_;               // Damage regions for the next present; only used with VK_KHR_incremental_present
+
 };
 
 
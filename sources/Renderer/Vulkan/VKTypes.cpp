@@ -35,6 +35,9 @@ VkShaderStageFlagBits Map(const ShaderType shaderType)
         case ShaderType::Geometry:          return VK_SHADER_STAGE_GEOMETRY_BIT;
         case ShaderType::Fragment:          return VK_SHADER_STAGE_FRAGMENT_BIT;
         case ShaderType::Compute:           return VK_SHADER_STAGE_COMPUTE_BIT;
+        case ShaderType::Task:              return VK_SHADER_STAGE_TASK_BIT_EXT;
+        case ShaderType::Mesh:              return VK_SHADER_STAGE_MESH_BIT_EXT;
+        default:                            break;
     }
     MapFailed("ShaderType", "VkShaderStageFlagBits");
 }
@@ -447,6 +450,21 @@ VkColorComponentFlags ToVkColorComponentFlags(std::uint8_t colorMask)
     return bitmask;
 }
 
+VkExtent2D ToVkFragmentSize(const ShadingRate shadingRate)
+{
+    switch (shadingRate)
+    {
+        case ShadingRate::Rate1x1:  return VkExtent2D{ 1, 1 };
+        case ShadingRate::Rate1x2:  return VkExtent2D{ 1, 2 };
+        case ShadingRate::Rate2x1:  return VkExtent2D{ 2, 1 };
+        case ShadingRate::Rate2x2:  return VkExtent2D{ 2, 2 };
+        case ShadingRate::Rate2x4:  return VkExtent2D{ 2, 4 };
+        case ShadingRate::Rate4x2:  return VkExtent2D{ 4, 2 };
+        case ShadingRate::Rate4x4:  return VkExtent2D{ 4, 4 };
+    }
+    MapFailed("ShadingRate", "VkExtent2D");
+}
+
 Format Unmap(const VkFormat format)
 {
     switch (format)
@@ -57,6 +57,7 @@ VkOffset3D              ToVkOffset(const Offset3D& offset);
 VkExtent3D              ToVkExtent(const Extent3D& extent);
 VkComponentSwizzle      ToVkComponentSwizzle(const TextureSwizzle swizzle);
 VkColorComponentFlags   ToVkColorComponentFlags(std::uint8_t colorMask);
+VkExtent2D              ToVkFragmentSize(const ShadingRate shadingRate);
 
 Format                  Unmap( const VkFormat format );
 
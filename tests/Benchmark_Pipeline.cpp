@@ -0,0 +1,660 @@
+/*
+ * Benchmark_Pipeline.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/Misc/Utility.h>
+#include <LLGL/Misc/VertexFormat.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+/*
+Pipeline state creation benchmark.
+Creates a configurable number of graphics and compute PSO permutations with the shaders from tests/Shaders for each renderer module that can be loaded.
+Graphics permutations vary the rasterizer, blend, and depth states; compute permutations vary the SCALE macro of the compute shader
+(except for SPIR-V, which cannot be specialized with macros, so all compute permutations share the same shader module).
+Each set of PSOs is created in the following modes:
+  - "none":             Without any cache.
+  - "serialized-store": Without any cache, but each PSO is returned as serialized cache (see RenderSystem::CreatePipelineState).
+  - "serialized-load":  From the serialized cache Blob of each PSO.
+  - "cache-cold":       With an empty LLGL::PipelineCache, which stores the data of each new PSO.
+  - "cache-warm":       With a new LLGL::PipelineCache that has loaded the archive of the cold cache.
+For backends whose render system is internally synchronized (Vulkan, Direct3D 12, and Metal), the "none" and "serialized-load" modes
+are also run with multiple threads that each create a slice of the PSOs.
+Results are written as JSON or CSV with the cumulative creation time (sum of all PSOs), the wall-clock time, and the percentiles of a single creation.
+Note that drivers may keep their own in-memory and on-disk caches, so the "none" mode of the first run after a driver update is the only truly cold measurement.
+
+Usage:
+  Benchmark_Pipeline [--format=json|csv] [--output=FILE] [--modules=NAME,...] [--permutations=N] [--threads=N] [--no-compute]
+*/
+
+struct PipelineConfig
+{
+    std::string                 format          = "json";
+    std::string                 output;
+    std::vector<std::string>    modules;
+    std::uint32_t               numPermutations = 64;
+    std::uint32_t               numThreads      = 4;
+    bool                        compute         = true;
+};
+
+struct PipelineResult
+{
+    std::string     module;
+    std::string     device;
+    std::string     kind;                   // Either "graphics" or "compute"
+    std::string     mode;
+    std::uint32_t   numThreads      = 1;
+    std::uint32_t   numPipelines    = 0;
+    std::uint32_t   numFailures     = 0;
+    double          total           = 0.0;  // Cumulative creation time of all PSOs in milliseconds
+    double          wall            = 0.0;  // Wall-clock time in milliseconds
+    double          min             = 0.0;  // Creation times of a single PSO in milliseconds
+    double          p50             = 0.0;
+    double          p95             = 0.0;
+    double          p99             = 0.0;
+    double          max             = 0.0;
+};
+
+using Clock = std::chrono::high_resolution_clock;
+
+// Returns the value at the specified percentile of the sorted samples (nearest-rank method).
+static double Percentile(const std::vector<double>& sortedSamples, double percentile)
+{
+    if (sortedSamples.empty())
+        return 0.0;
+    auto rank = static_cast<std::size_t>(percentile / 100.0 * static_cast<double>(sortedSamples.size()) + 0.5);
+    rank = std::max<std::size_t>(1, std::min(rank, sortedSamples.size()));
+    return sortedSamples[rank - 1];
+}
+
+static std::string EscapeJSON(const std::string& s)
+{
+    std::string result;
+    result.reserve(s.size());
+    for (char c : s)
+    {
+        if (c == '"' || c == '\\')
+            result += '\\';
+        if (static_cast<unsigned char>(c) >= 0x20)
+            result += c;
+    }
+    return result;
+}
+
+static std::string EscapeCSV(const std::string& s)
+{
+    if (s.find_first_of(",\"\n") == std::string::npos)
+        return s;
+    std::string result = "\"";
+    for (char c : s)
+    {
+        if (c == '"')
+            result += '"';
+        result += c;
+    }
+    return result + "\"";
+}
+
+static void WriteResultsJSON(std::ostream& s, const std::vector<PipelineResult>& results)
+{
+    s << "{\n";
+    s << "  \"llglVersion\": \"" << EscapeJSON(LLGL::Version::GetString()) << "\",\n";
+    s << "  \"results\": [";
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& res = results[i];
+        s << (i > 0 ? ",\n    {" : "\n    {");
+        s << "\"module\": \"" << EscapeJSON(res.module) << "\", ";
+        s << "\"device\": \"" << EscapeJSON(res.device) << "\", ";
+        s << "\"kind\": \"" << res.kind << "\", ";
+        s << "\"mode\": \"" << res.mode << "\", ";
+        s << "\"threads\": " << res.numThreads << ", ";
+        s << "\"pipelines\": " << res.numPipelines << ", ";
+        s << "\"failures\": " << res.numFailures << ", ";
+        s << "\"totalMs\": " << res.total << ", ";
+        s << "\"wallMs\": " << res.wall << ", ";
+        s << "\"minMs\": " << res.min << ", ";
+        s << "\"p50Ms\": " << res.p50 << ", ";
+        s << "\"p95Ms\": " << res.p95 << ", ";
+        s << "\"p99Ms\": " << res.p99 << ", ";
+        s << "\"maxMs\": " << res.max;
+        s << "}";
+    }
+
+    s << "\n  ]\n}\n";
+}
+
+static void WriteResultsCSV(std::ostream& s, const std::vector<PipelineResult>& results)
+{
+    s << "module,device,kind,mode,threads,pipelines,failures,totalMs,wallMs,minMs,p50Ms,p95Ms,p99Ms,maxMs\n";
+    for (const auto& res : results)
+    {
+        s << EscapeCSV(res.module) << ',';
+        s << EscapeCSV(res.device) << ',';
+        s << res.kind << ',';
+        s << res.mode << ',';
+        s << res.numThreads << ',';
+        s << res.numPipelines << ',';
+        s << res.numFailures << ',';
+        s << res.total << ',';
+        s << res.wall << ',';
+        s << res.min << ',';
+        s << res.p50 << ',';
+        s << res.p95 << ',';
+        s << res.p99 << ',';
+        s << res.max << '\n';
+    }
+}
+
+class PipelineBenchmark
+{
+
+    private:
+
+        // Function to create the PSO with the specified permutation index.
+        using CreateFunction = std::function<LLGL::PipelineState*(std::uint32_t index)>;
+
+        const PipelineConfig&                   config;
+        std::vector<PipelineResult>&            results;
+
+        std::string                             moduleName;
+        LLGL::RenderSystemPtr                   renderer;
+        LLGL::SwapChain*                        swapChain           = nullptr;
+
+        LLGL::VertexFormat                      vertexFormat;
+        LLGL::Shader*                           vertexShader        = nullptr;
+        LLGL::Shader*                           fragmentShader      = nullptr;
+        std::vector<LLGL::Shader*>              computeShaders;
+        LLGL::PipelineLayout*                   graphicsLayout      = nullptr;
+        LLGL::PipelineLayout*                   computeLayout       = nullptr;
+
+        // Descriptors are stored to register the objects with each new pipeline cache.
+        std::vector<LLGL::ShaderDescriptor>     shaderDescs;
+        std::vector<LLGL::Shader*>              shaders;
+        std::vector<std::string>                shaderPaths;
+        std::vector<std::string>                shaderScales;
+        LLGL::PipelineLayoutDescriptor          graphicsLayoutDesc;
+        LLGL::PipelineLayoutDescriptor          computeLayoutDesc;
+
+    private:
+
+        bool Supported(LLGL::ShadingLanguage language) const
+        {
+            const auto& languages = renderer->GetRenderingCaps().shadingLanguages;
+            return (std::find(languages.begin(), languages.end(), language) != languages.end());
+        }
+
+        // Returns true if the render system can create PSOs from multiple threads (see RenderSystem).
+        bool SupportsMultiThreadedCreation() const
+        {
+            const int id = renderer->GetRendererID();
+            return (id == LLGL::RendererID::Vulkan || id == LLGL::RendererID::Direct3D12 || id == LLGL::RendererID::Metal);
+        }
+
+        LLGL::Shader* LoadShader(
+            LLGL::ShaderType    type,
+            const char*         filename,
+            const char*         entryPoint  = nullptr,
+            const char*         profile     = nullptr,
+            const char*         scale       = nullptr)
+        {
+            const std::string path = std::string("Shaders/") + filename;
+            if (!std::ifstream(path).good())
+                throw std::runtime_error("missing shader file: " + path);
+
+            auto shaderDesc = LLGL::ShaderDescFromFile(type, path.c_str(), entryPoint, profile);
+            if (type == LLGL::ShaderType::Vertex)
+                shaderDesc.vertex.inputAttribs = vertexFormat.attributes;
+
+            const LLGL::ShaderMacro defines[] =
+            {
+                { "SCALE", scale },
+                { nullptr, nullptr }
+            };
+            if (scale != nullptr)
+                shaderDesc.defines = defines;
+
+            auto shader = renderer->CreateShader(shaderDesc);
+            if (auto report = shader->GetReport())
+            {
+                if (report->HasErrors())
+                    throw std::runtime_error("failed to compile shader " + path + ":\n" + report->GetText());
+            }
+
+            // Registering a shader with a pipeline cache hashes its source, so keep the descriptor without the temporary pointers
+            shaderDesc.defines = nullptr;
+            shaderPaths.push_back(path);
+            shaderScales.push_back(scale != nullptr ? scale : "");
+            shaderDescs.push_back(shaderDesc);
+            shaders.push_back(shader);
+
+            return shader;
+        }
+
+        void LoadGraphicsShaders()
+        {
+            if (Supported(LLGL::ShadingLanguage::GLSL))
+            {
+                vertexShader    = LoadShader(LLGL::ShaderType::Vertex,   "Benchmark.vert");
+                fragmentShader  = LoadShader(LLGL::ShaderType::Fragment, "Benchmark.frag");
+            }
+            else if (Supported(LLGL::ShadingLanguage::SPIRV))
+            {
+                vertexShader    = LoadShader(LLGL::ShaderType::Vertex,   "Benchmark.450core.vert.spv");
+                fragmentShader  = LoadShader(LLGL::ShaderType::Fragment, "Benchmark.450core.frag.spv");
+            }
+            else if (Supported(LLGL::ShadingLanguage::HLSL))
+            {
+                vertexShader    = LoadShader(LLGL::ShaderType::Vertex,   "Benchmark.hlsl", "VS", "vs_5_0");
+                fragmentShader  = LoadShader(LLGL::ShaderType::Fragment, "Benchmark.hlsl", "PS", "ps_5_0");
+            }
+            else if (Supported(LLGL::ShadingLanguage::Metal))
+            {
+                vertexShader    = LoadShader(LLGL::ShaderType::Vertex,   "Benchmark.metal", "VS", "1.1");
+                fragmentShader  = LoadShader(LLGL::ShaderType::Fragment, "Benchmark.metal", "PS", "1.1");
+            }
+            else
+                throw std::runtime_error("no supported shading language");
+        }
+
+        // Compiles a small number of compute shader permutations; PSO permutations beyond that reuse these shaders.
+        void LoadComputeShaders()
+        {
+            const auto numVariants = std::max(1u, std::min(config.numPermutations, 8u));
+            for (std::uint32_t i = 0; i < numVariants; ++i)
+            {
+                const std::string scale = std::to_string(i + 1) + ".0";
+                if (Supported(LLGL::ShadingLanguage::GLSL))
+                    computeShaders.push_back(LoadShader(LLGL::ShaderType::Compute, "Benchmark.comp", nullptr, nullptr, scale.c_str()));
+                else if (Supported(LLGL::ShadingLanguage::SPIRV))
+                {
+                    computeShaders.push_back(LoadShader(LLGL::ShaderType::Compute, "Benchmark.450core.comp.spv"));
+                    break;
+                }
+                else if (Supported(LLGL::ShadingLanguage::HLSL))
+                    computeShaders.push_back(LoadShader(LLGL::ShaderType::Compute, "Benchmark.hlsl", "CS", "cs_5_0", scale.c_str()));
+                else if (Supported(LLGL::ShadingLanguage::Metal))
+                    computeShaders.push_back(LoadShader(LLGL::ShaderType::Compute, "Benchmark.metal", "CS", "1.1", scale.c_str()));
+            }
+        }
+
+        void CreateResources()
+        {
+            vertexFormat.AppendAttribute({ "position", LLGL::Format::RG32Float });
+
+            LoadGraphicsShaders();
+
+            graphicsLayoutDesc.bindings =
+            {
+                LLGL::BindingDescriptor
+                {
+                    "Settings", LLGL::ResourceType::Buffer, LLGL::BindFlags::ConstantBuffer,
+                    (LLGL::StageFlags::VertexStage | LLGL::StageFlags::FragmentStage), 1
+                }
+            };
+            graphicsLayout = renderer->CreatePipelineLayout(graphicsLayoutDesc);
+
+            if (config.compute && renderer->GetRenderingCaps().features.hasComputeShaders)
+            {
+                LoadComputeShaders();
+
+                computeLayoutDesc.bindings =
+                {
+                    LLGL::BindingDescriptor
+                    {
+                        "Values", LLGL::ResourceType::Buffer, LLGL::BindFlags::Storage, LLGL::StageFlags::ComputeStage, 2
+                    }
+                };
+                computeLayout = renderer->CreatePipelineLayout(computeLayoutDesc);
+            }
+        }
+
+        // Returns the graphics PSO descriptor for the specified permutation; the depth bias makes all permutations beyond the state combinations unique.
+        LLGL::GraphicsPipelineDescriptor GetGraphicsPipelineDesc(std::uint32_t index) const
+        {
+            const LLGL::CullMode cullModes[] = { LLGL::CullMode::Disabled, LLGL::CullMode::Front, LLGL::CullMode::Back };
+            const LLGL::CompareOp compareOps[] = { LLGL::CompareOp::Less, LLGL::CompareOp::LessEqual };
+
+            LLGL::GraphicsPipelineDescriptor psoDesc;
+            {
+                psoDesc.pipelineLayout                      = graphicsLayout;
+                psoDesc.vertexShader                        = vertexShader;
+                psoDesc.fragmentShader                      = fragmentShader;
+                psoDesc.renderPass                          = swapChain->GetRenderPass();
+                psoDesc.primitiveTopology                   = ((index / 12) % 2 == 0 ? LLGL::PrimitiveTopology::TriangleList : LLGL::PrimitiveTopology::TriangleStrip);
+                psoDesc.rasterizer.cullMode                 = cullModes[index % 3];
+                psoDesc.rasterizer.frontCCW                 = ((index / 24) % 2 != 0);
+                psoDesc.rasterizer.depthBias.constantFactor = static_cast<float>(index / 48);
+                psoDesc.blend.targets[0].blendEnabled       = ((index / 3) % 2 != 0);
+                psoDesc.depth.testEnabled                   = ((index / 6) % 2 != 0);
+                psoDesc.depth.writeEnabled                  = psoDesc.depth.testEnabled;
+                psoDesc.depth.compareOp                     = compareOps[(index / 6) % 2];
+            }
+            return psoDesc;
+        }
+
+        LLGL::ComputePipelineDescriptor GetComputePipelineDesc(std::uint32_t index) const
+        {
+            LLGL::ComputePipelineDescriptor psoDesc;
+            {
+                psoDesc.pipelineLayout  = computeLayout;
+                psoDesc.computeShader   = computeShaders[index % computeShaders.size()];
+            }
+            return psoDesc;
+        }
+
+        static bool HasErrors(LLGL::PipelineState* pso)
+        {
+            if (pso == nullptr)
+                return true;
+            if (auto report = pso->GetReport())
+                return report->HasErrors();
+            return false;
+        }
+
+        // Registers all shaders and pipeline layouts with the specified pipeline cache.
+        void RegisterObjects(LLGL::PipelineCache& cache)
+        {
+            for (std::size_t i = 0; i < shaders.size(); ++i)
+            {
+                const LLGL::ShaderMacro defines[] =
+                {
+                    { "SCALE", shaderScales[i].c_str() },
+                    { nullptr, nullptr }
+                };
+                auto shaderDesc = shaderDescs[i];
+                shaderDesc.source = shaderPaths[i].c_str();
+                if (!shaderScales[i].empty())
+                    shaderDesc.defines = defines;
+                cache.RegisterShader(*shaders[i], shaderDesc);
+            }
+
+            cache.RegisterPipelineLayout(*graphicsLayout, graphicsLayoutDesc);
+            if (computeLayout != nullptr)
+                cache.RegisterPipelineLayout(*computeLayout, computeLayoutDesc);
+        }
+
+        /*
+        Creates all PSOs with the specified callback on the specified number of threads, appends the measured times as a new result,
+        and releases all PSOs afterwards. Each thread creates a contiguous slice of all permutations.
+        */
+        void Measure(const char* kind, const char* mode, std::uint32_t numThreads, const CreateFunction& create)
+        {
+            const auto numPipelines = config.numPermutations;
+            numThreads = std::max(1u, std::min(numThreads, numPipelines));
+
+            std::vector<LLGL::PipelineState*> pipelines(numPipelines, nullptr);
+            std::vector<double> samples(numPipelines, 0.0);
+
+            auto CreateSlice = [&](std::uint32_t begin, std::uint32_t end)
+            {
+                for (std::uint32_t i = begin; i < end; ++i)
+                {
+                    const auto startTime = Clock::now();
+                    pipelines[i] = create(i);
+                    samples[i] = std::chrono::duration<double, std::milli>(Clock::now() - startTime).count();
+                }
+            };
+
+            const auto startTime = Clock::now();
+
+            if (numThreads > 1)
+            {
+                std::vector<std::thread> workers;
+                workers.reserve(numThreads);
+                for (std::uint32_t i = 0; i < numThreads; ++i)
+                    workers.emplace_back(CreateSlice, numPipelines * i / numThreads, numPipelines * (i + 1) / numThreads);
+                for (auto& worker : workers)
+                    worker.join();
+            }
+            else
+                CreateSlice(0, numPipelines);
+
+            const double wallTime = std::chrono::duration<double, std::milli>(Clock::now() - startTime).count();
+
+            PipelineResult result;
+            {
+                result.module       = moduleName;
+                result.device       = renderer->GetRendererInfo().deviceName;
+                result.kind         = kind;
+                result.mode         = mode;
+                result.numThreads   = numThreads;
+                result.numPipelines = numPipelines;
+                result.wall         = wallTime;
+            }
+
+            for (auto pso : pipelines)
+            {
+                if (HasErrors(pso))
+                    result.numFailures++;
+                if (pso != nullptr)
+                    renderer->Release(*pso);
+            }
+
+            for (double sample : samples)
+                result.total += sample;
+
+            std::sort(samples.begin(), samples.end());
+            result.min  = Percentile(samples, 0.0);
+            result.p50  = Percentile(samples, 50.0);
+            result.p95  = Percentile(samples, 95.0);
+            result.p99  = Percentile(samples, 99.0);
+            result.max  = Percentile(samples, 100.0);
+
+            results.push_back(result);
+
+            std::cerr
+                << "  " << kind << " [" << mode << ", " << numThreads << (numThreads == 1 ? " thread" : " threads") << "]: "
+                << result.total << " ms total, " << result.wall << " ms wall, p50 = " << result.p50 << " ms, p99 = " << result.p99 << " ms"
+                << (result.numFailures > 0 ? " (" + std::to_string(result.numFailures) + " failed)" : std::string())
+                << std::endl;
+        }
+
+        template <typename TDesc>
+        void BenchmarkPipelines(const char* kind, const std::function<TDesc(std::uint32_t)>& getDesc)
+        {
+            const auto numPipelines = config.numPermutations;
+            const bool multiThreaded = (config.numThreads > 1 && SupportsMultiThreadedCreation());
+
+            // Without any cache
+            Measure(kind, "none", 1, [&](std::uint32_t i) { return renderer->CreatePipelineState(getDesc(i)); });
+            if (multiThreaded)
+                Measure(kind, "none", config.numThreads, [&](std::uint32_t i) { return renderer->CreatePipelineState(getDesc(i)); });
+
+            // With the serialized cache of each PSO
+            std::vector<std::unique_ptr<LLGL::Blob>> serializedCaches(numPipelines);
+            Measure(kind, "serialized-store", 1, [&](std::uint32_t i) { return renderer->CreatePipelineState(getDesc(i), &serializedCaches[i]); });
+
+            const bool hasSerializedCaches = std::all_of(
+                serializedCaches.begin(), serializedCaches.end(),
+                [](const std::unique_ptr<LLGL::Blob>& blob) { return (blob && blob->GetSize() > 0); }
+            );
+
+            if (hasSerializedCaches)
+            {
+                Measure(kind, "serialized-load", 1, [&](std::uint32_t i) { return renderer->CreatePipelineState(*serializedCaches[i]); });
+                if (multiThreaded)
+                    Measure(kind, "serialized-load", config.numThreads, [&](std::uint32_t i) { return renderer->CreatePipelineState(*serializedCaches[i]); });
+            }
+            else
+                std::cerr << "  skip " << kind << " [serialized-load] (backend does not return serialized caches)" << std::endl;
+
+            serializedCaches.clear();
+
+            // With a pipeline cache; the warm cache only contains the archive of the cold cache, so it starts without PSO objects in memory
+            std::unique_ptr<LLGL::Blob> archive;
+            {
+                LLGL::PipelineCache coldCache{ *renderer };
+                RegisterObjects(coldCache);
+                Measure(kind, "cache-cold", 1, [&](std::uint32_t i) { return coldCache.CreatePipelineState(getDesc(i)); });
+                archive = coldCache.Save(LLGL::PipelineCacheSaveFlags::Compressed);
+            }
+
+            LLGL::PipelineCache warmCache{ *renderer };
+            if (archive && warmCache.Load(std::move(archive)))
+            {
+                RegisterObjects(warmCache);
+                Measure(kind, "cache-warm", 1, [&](std::uint32_t i) { return warmCache.CreatePipelineState(getDesc(i)); });
+            }
+            else
+                std::cerr << "  skip " << kind << " [cache-warm] (failed to load pipeline cache archive)" << std::endl;
+        }
+
+    public:
+
+        PipelineBenchmark(const PipelineConfig& config, std::vector<PipelineResult>& results) :
+            config  { config  },
+            results { results }
+        {
+        }
+
+        void Load(const std::string& rendererModule)
+        {
+            moduleName = rendererModule;
+            renderer = LLGL::RenderSystem::Load(rendererModule);
+
+            // Create small swap-chain, since some renderers (e.g. OpenGL) require a context and all graphics PSOs need a render pass
+            LLGL::SwapChainDescriptor swapChainDesc;
+            {
+                swapChainDesc.resolution = { 256, 256 };
+            }
+            swapChain = renderer->CreateSwapChain(swapChainDesc);
+
+            CreateResources();
+        }
+
+        void Run()
+        {
+            std::cerr << "run pipeline benchmarks for " << moduleName << " (" << renderer->GetRendererInfo().deviceName << ") ..." << std::endl;
+
+            BenchmarkPipelines<LLGL::GraphicsPipelineDescriptor>(
+                "graphics",
+                [this](std::uint32_t i) { return GetGraphicsPipelineDesc(i); }
+            );
+
+            if (!computeShaders.empty())
+            {
+                BenchmarkPipelines<LLGL::ComputePipelineDescriptor>(
+                    "compute",
+                    [this](std::uint32_t i) { return GetComputePipelineDesc(i); }
+                );
+            }
+        }
+
+};
+
+static std::vector<std::string> SplitList(const std::string& s)
+{
+    std::vector<std::string> list;
+    std::stringstream stream(s);
+    for (std::string item; std::getline(stream, item, ',');)
+    {
+        if (!item.empty())
+            list.push_back(item);
+    }
+    return list;
+}
+
+static bool ParseArgument(const std::string& arg, const char* name, std::string& outValue)
+{
+    const std::string prefix = std::string("--") + name + "=";
+    if (arg.compare(0, prefix.size(), prefix) == 0)
+    {
+        outValue = arg.substr(prefix.size());
+        return true;
+    }
+    return false;
+}
+
+int main(int argc, char* argv[])
+{
+    PipelineConfig config;
+
+    // Parse command line arguments
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        std::string value;
+
+        if (ParseArgument(arg, "format", value))
+            config.format = value;
+        else if (ParseArgument(arg, "output", value))
+            config.output = value;
+        else if (ParseArgument(arg, "modules", value))
+            config.modules = SplitList(value);
+        else if (ParseArgument(arg, "permutations", value))
+            config.numPermutations = static_cast<std::uint32_t>(std::max(1, std::stoi(value)));
+        else if (ParseArgument(arg, "threads", value))
+            config.numThreads = static_cast<std::uint32_t>(std::max(1, std::stoi(value)));
+        else if (arg == "--no-compute")
+            config.compute = false;
+        else
+        {
+            std::cerr << "usage: Benchmark_Pipeline [--format=json|csv] [--output=FILE] [--modules=NAME,...] [--permutations=N] [--threads=N] [--no-compute]" << std::endl;
+            return 1;
+        }
+    }
+
+    if (config.format != "json" && config.format != "csv")
+    {
+        std::cerr << "unknown output format: " << config.format << std::endl;
+        return 1;
+    }
+
+    // Benchmark all available renderer modules by default
+    if (config.modules.empty())
+        config.modules = LLGL::RenderSystem::FindModules();
+
+    LLGL::Log::SetReportCallbackStd(&(std::cerr));
+
+    std::vector<PipelineResult> results;
+
+    for (const auto& module : config.modules)
+    {
+        try
+        {
+            PipelineBenchmark benchmark{ config, results };
+            benchmark.Load(module);
+            benchmark.Run();
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "skip module " << module << ": " << e.what() << std::endl;
+        }
+    }
+
+    // Write results to output file or standard output
+    std::ofstream file;
+    if (!config.output.empty())
+    {
+        file.open(config.output);
+        if (!file.good())
+        {
+            std::cerr << "failed to open output file: " << config.output << std::endl;
+            return 1;
+        }
+    }
+
+    std::ostream& output = (file.is_open() ? file : std::cout);
+
+    if (config.format == "csv")
+        WriteResultsCSV(output, results);
+    else
+        WriteResultsJSON(output, results);
+
+    return 0;
+}
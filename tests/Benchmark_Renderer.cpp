@@ -0,0 +1,753 @@
+/*
+ * Benchmark_Renderer.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/Misc/Utility.h>
+#include <LLGL/Misc/VertexFormat.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+/*
+Renderer benchmark suite.
+Measures the CPU cost of draw calls with different binding models, the cost of pipeline switches,
+and the throughput of CommandBuffer::UpdateBuffer for every renderer module that can be loaded.
+Results are written as JSON or CSV, so they can be compared between LLGL versions and hardware configurations.
+The same workload is also run on the Null renderer as a baseline, which does not submit anything to a driver:
+Its CPU time is the overhead of LLGL itself, and the remaining CPU time of each hardware renderer is attributed to the driver.
+With --histograms, the Null renderer is loaded in benchmark mode (see LLGL::RendererConfigurationNull)
+and the results contain the CPU time histograms of each executed command type.
+Note that the baseline includes the overhead of the timer queries in that mode, so it should not be combined with precise driver overhead measurements.
+
+Usage:
+  Benchmark_Renderer [--format=json|csv] [--output=FILE] [--modules=NAME,...] [--frames=N] [--draws=N] [--updates=N] [--histograms] [--no-baseline]
+*/
+
+struct BenchmarkConfig
+{
+    std::string                 format      = "json";
+    std::string                 output;
+    std::vector<std::string>    modules;
+    std::uint32_t               numFrames   = 100;
+    std::uint32_t               numDraws    = 4096;
+    std::uint32_t               numUpdates  = 256;
+    bool                        histograms  = false;
+    bool                        baseline    = true;
+};
+
+struct BenchmarkResult
+{
+    std::string     module;
+    std::string     device;
+    std::string     benchmark;
+    std::string     variant;
+    std::uint32_t   numFrames       = 0;
+    std::uint64_t   numCommands     = 0;        // Number of measured commands over all frames
+    std::uint64_t   numBytes        = 0;        // Number of uploaded bytes over all frames
+    double          cpuTime         = 0.0;      // Time in milliseconds to encode and submit all frames
+    double          totalTime       = 0.0;      // Time in milliseconds until the GPU has finished all frames
+    double          baselineTime    = -1.0;     // CPU time in milliseconds of the Null renderer for the same benchmark, or negative if there is no baseline
+
+    std::vector<LLGL::CommandTimeHistogram> histograms; // CPU time histograms per command type (Null renderer in benchmark mode only)
+};
+
+static const char* g_baselineModule = "Null";
+
+using Clock = std::chrono::high_resolution_clock;
+
+static double ElapsedMilliseconds(Clock::time_point startTime, Clock::time_point endTime)
+{
+    return std::chrono::duration<double, std::milli>(endTime - startTime).count();
+}
+
+static double PerSecond(std::uint64_t count, double milliseconds)
+{
+    return (milliseconds > 0.0 ? static_cast<double>(count) * 1000.0 / milliseconds : 0.0);
+}
+
+static std::string EscapeJSON(const std::string& s)
+{
+    std::string result;
+    result.reserve(s.size());
+    for (char c : s)
+    {
+        if (c == '"' || c == '\\')
+            result += '\\';
+        if (static_cast<unsigned char>(c) >= 0x20)
+            result += c;
+    }
+    return result;
+}
+
+static std::string EscapeCSV(const std::string& s)
+{
+    if (s.find_first_of(",\"\n") == std::string::npos)
+        return s;
+    std::string result = "\"";
+    for (char c : s)
+    {
+        if (c == '"')
+            result += '"';
+        result += c;
+    }
+    return result + "\"";
+}
+
+// Assigns the CPU time of the baseline module to all results with the same benchmark and variant.
+static void AssignBaselineTimes(std::vector<BenchmarkResult>& results)
+{
+    for (const auto& baseline : results)
+    {
+        if (baseline.module != g_baselineModule)
+            continue;
+        for (auto& res : results)
+        {
+            if (res.benchmark == baseline.benchmark && res.variant == baseline.variant)
+                res.baselineTime = baseline.cpuTime;
+        }
+    }
+}
+
+static double DriverTime(const BenchmarkResult& res)
+{
+    return std::max(0.0, res.cpuTime - res.baselineTime);
+}
+
+static void WriteHistogramsJSON(std::ostream& s, const std::vector<LLGL::CommandTimeHistogram>& histograms)
+{
+    s << ", \"histograms\": [";
+    for (std::size_t i = 0; i < histograms.size(); ++i)
+    {
+        const auto& hist = histograms[i];
+        s << (i > 0 ? ", {" : "{");
+        s << "\"command\": \"" << EscapeJSON(hist.command) << "\", ";
+        s << "\"count\": " << hist.numCommands << ", ";
+        s << "\"totalNs\": " << hist.totalTime << ", ";
+        s << "\"minNs\": " << hist.minTime << ", ";
+        s << "\"maxNs\": " << hist.maxTime << ", ";
+        s << "\"buckets\": [";
+        for (std::uint32_t bucket = 0; bucket < LLGL::CommandTimeHistogram::numBuckets; ++bucket)
+            s << (bucket > 0 ? ", " : "") << hist.buckets[bucket];
+        s << "]}";
+    }
+    s << "]";
+}
+
+static void WriteResultsJSON(std::ostream& s, const std::vector<BenchmarkResult>& results, const BenchmarkConfig& config)
+{
+    s << "{\n";
+    s << "  \"llglVersion\": \"" << EscapeJSON(LLGL::Version::GetString()) << "\",\n";
+    s << "  \"numFrames\": " << config.numFrames << ",\n";
+    s << "  \"numDraws\": " << config.numDraws << ",\n";
+    s << "  \"numUpdates\": " << config.numUpdates << ",\n";
+    s << "  \"histogramFirstBucketNs\": " << LLGL::CommandTimeHistogram::firstBucketTime << ",\n";
+    s << "  \"results\": [";
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& res = results[i];
+        s << (i > 0 ? ",\n    {" : "\n    {");
+        s << "\"module\": \"" << EscapeJSON(res.module) << "\", ";
+        s << "\"device\": \"" << EscapeJSON(res.device) << "\", ";
+        s << "\"benchmark\": \"" << EscapeJSON(res.benchmark) << "\", ";
+        s << "\"variant\": \"" << EscapeJSON(res.variant) << "\", ";
+        s << "\"frames\": " << res.numFrames << ", ";
+        s << "\"commands\": " << res.numCommands << ", ";
+        s << "\"bytes\": " << res.numBytes << ", ";
+        s << "\"cpuTimeMs\": " << res.cpuTime << ", ";
+        s << "\"totalTimeMs\": " << res.totalTime << ", ";
+        s << "\"commandsPerSecond\": " << PerSecond(res.numCommands, res.cpuTime) << ", ";
+        s << "\"bytesPerSecond\": " << PerSecond(res.numBytes, res.cpuTime);
+        if (res.baselineTime >= 0.0)
+        {
+            s << ", \"baselineCpuTimeMs\": " << res.baselineTime;
+            s << ", \"driverCpuTimeMs\": " << DriverTime(res);
+        }
+        if (!res.histograms.empty())
+            WriteHistogramsJSON(s, res.histograms);
+        s << "}";
+    }
+
+    s << "\n  ]\n}\n";
+}
+
+static void WriteResultsCSV(std::ostream& s, const std::vector<BenchmarkResult>& results)
+{
+    s << "module,device,benchmark,variant,frames,commands,bytes,cpuTimeMs,totalTimeMs,commandsPerSecond,bytesPerSecond,baselineCpuTimeMs,driverCpuTimeMs\n";
+    for (const auto& res : results)
+    {
+        s << EscapeCSV(res.module) << ',';
+        s << EscapeCSV(res.device) << ',';
+        s << EscapeCSV(res.benchmark) << ',';
+        s << EscapeCSV(res.variant) << ',';
+        s << res.numFrames << ',';
+        s << res.numCommands << ',';
+        s << res.numBytes << ',';
+        s << res.cpuTime << ',';
+        s << res.totalTime << ',';
+        s << PerSecond(res.numCommands, res.cpuTime) << ',';
+        s << PerSecond(res.numBytes, res.cpuTime) << ',';
+        if (res.baselineTime >= 0.0)
+            s << res.baselineTime << ',' << DriverTime(res) << '\n';
+        else
+            s << ",\n";
+    }
+
+    // Write histograms as a second table, since they have a variable number of rows per result
+    bool hasHistograms = false;
+    for (const auto& res : results)
+    {
+        for (const auto& hist : res.histograms)
+        {
+            if (!hasHistograms)
+            {
+                s << "\nmodule,benchmark,variant,command,count,totalNs,minNs,maxNs";
+                for (std::uint32_t bucket = 0; bucket < LLGL::CommandTimeHistogram::numBuckets; ++bucket)
+                    s << ",bucket" << bucket;
+                s << '\n';
+                hasHistograms = true;
+            }
+            s << EscapeCSV(res.module) << ',' << EscapeCSV(res.benchmark) << ',' << EscapeCSV(res.variant) << ',' << EscapeCSV(hist.command) << ',';
+            s << hist.numCommands << ',' << hist.totalTime << ',' << hist.minTime << ',' << hist.maxTime;
+            for (std::uint32_t bucket = 0; bucket < LLGL::CommandTimeHistogram::numBuckets; ++bucket)
+                s << ',' << hist.buckets[bucket];
+            s << '\n';
+        }
+    }
+}
+
+class RendererBenchmark
+{
+
+    private:
+
+        enum class BindingModel
+        {
+            ResourceHeap,       // One descriptor set of a resource heap per draw call
+            DynamicOffset,      // A single descriptor set with a dynamic offset per draw call
+            DirectBinding,      // CommandBuffer::SetResource per draw call
+        };
+
+        struct Object
+        {
+            float offset[4];
+            float color[4];
+        };
+
+    private:
+
+        const BenchmarkConfig&      config;
+        std::vector<BenchmarkResult>& results;
+
+        std::string                 moduleName;
+        LLGL::RenderSystemPtr       renderer;
+        LLGL::SwapChain*            swapChain           = nullptr;
+        LLGL::CommandQueue*         commandQueue        = nullptr;
+        LLGL::CommandBuffer*        commands            = nullptr;
+
+        LLGL::VertexFormat          vertexFormat;
+        LLGL::Buffer*               vertexBuffer        = nullptr;
+        LLGL::Buffer*               constantBuffer      = nullptr;
+        std::vector<LLGL::Buffer*>  objectBuffers;
+        LLGL::Buffer*               uploadBuffer        = nullptr;
+        LLGL::Shader*               vertexShader        = nullptr;
+        LLGL::Shader*               fragmentShader      = nullptr;
+        std::uint32_t               objectStride        = 256;
+
+    private:
+
+        bool Supported(LLGL::ShadingLanguage language) const
+        {
+            const auto& languages = renderer->GetRenderingCaps().shadingLanguages;
+            return (std::find(languages.begin(), languages.end(), language) != languages.end());
+        }
+
+        LLGL::Shader* LoadShader(LLGL::ShaderType type, const char* filename, const char* entryPoint = nullptr, const char* profile = nullptr)
+        {
+            const std::string path = std::string("Shaders/") + filename;
+            if (!std::ifstream(path).good())
+                throw std::runtime_error("missing shader file: " + path);
+
+            auto shaderDesc = LLGL::ShaderDescFromFile(type, path.c_str(), entryPoint, profile);
+            if (type == LLGL::ShaderType::Vertex)
+                shaderDesc.vertex.inputAttribs = vertexFormat.attributes;
+
+            auto shader = renderer->CreateShader(shaderDesc);
+            if (auto report = shader->GetReport())
+            {
+                if (report->HasErrors())
+                    throw std::runtime_error("failed to compile shader " + path + ":\n" + report->GetText());
+            }
+            return shader;
+        }
+
+        void LoadShaders()
+        {
+            if (Supported(LLGL::ShadingLanguage::GLSL))
+            {
+                vertexShader    = LoadShader(LLGL::ShaderType::Vertex,   "Benchmark.vert");
+                fragmentShader  = LoadShader(LLGL::ShaderType::Fragment, "Benchmark.frag");
+            }
+            else if (Supported(LLGL::ShadingLanguage::SPIRV))
+            {
+                vertexShader    = LoadShader(LLGL::ShaderType::Vertex,   "Benchmark.450core.vert.spv");
+                fragmentShader  = LoadShader(LLGL::ShaderType::Fragment, "Benchmark.450core.frag.spv");
+            }
+            else if (Supported(LLGL::ShadingLanguage::HLSL))
+            {
+                vertexShader    = LoadShader(LLGL::ShaderType::Vertex,   "Benchmark.hlsl", "VS", "vs_5_0");
+                fragmentShader  = LoadShader(LLGL::ShaderType::Fragment, "Benchmark.hlsl", "PS", "ps_5_0");
+            }
+            else if (Supported(LLGL::ShadingLanguage::Metal))
+            {
+                vertexShader    = LoadShader(LLGL::ShaderType::Vertex,   "Benchmark.metal", "VS", "1.1");
+                fragmentShader  = LoadShader(LLGL::ShaderType::Fragment, "Benchmark.metal", "PS", "1.1");
+            }
+            else
+                throw std::runtime_error("no supported shading language");
+        }
+
+        void CreateResources()
+        {
+            // Vertex buffer with a single small triangle
+            const float vertices[] = { 0.0f, 0.01f, 0.01f, -0.01f, -0.01f, -0.01f };
+
+            vertexFormat.AppendAttribute({ "position", LLGL::Format::RG32Float });
+            vertexBuffer = renderer->CreateBuffer(LLGL::VertexBufferDesc(sizeof(vertices), vertexFormat), vertices);
+
+            // Constant buffer with one aligned range of constants per object
+            const auto alignment = static_cast<std::uint32_t>(renderer->GetRenderingCaps().limits.minConstantBufferAlignment);
+            objectStride = std::max(objectStride, alignment);
+
+            std::vector<char> objectData(static_cast<std::size_t>(objectStride) * config.numDraws, 0);
+            for (std::uint32_t i = 0; i < config.numDraws; ++i)
+            {
+                auto obj = reinterpret_cast<Object*>(&objectData[static_cast<std::size_t>(objectStride) * i]);
+                obj->offset[0]  = static_cast<float>(i % 64) / 32.0f - 1.0f;
+                obj->offset[1]  = static_cast<float>((i / 64) % 64) / 32.0f - 1.0f;
+                obj->color[0]   = static_cast<float>(i % 7) / 7.0f;
+                obj->color[1]   = static_cast<float>(i % 5) / 5.0f;
+                obj->color[2]   = static_cast<float>(i % 3) / 3.0f;
+                obj->color[3]   = 1.0f;
+            }
+            constantBuffer = renderer->CreateBuffer(LLGL::ConstantBufferDesc(objectData.size()), objectData.data());
+
+            // Small pool of individual constant buffers for direct binding
+            const auto numObjectBuffers = std::min(config.numDraws, 64u);
+            for (std::uint32_t i = 0; i < numObjectBuffers; ++i)
+                objectBuffers.push_back(renderer->CreateBuffer(LLGL::ConstantBufferDesc(sizeof(Object)), &objectData[static_cast<std::size_t>(objectStride) * i]));
+
+            // Upload buffer for UpdateBuffer benchmarks
+            LLGL::BufferDescriptor uploadBufferDesc;
+            {
+                uploadBufferDesc.size       = 65536;
+                uploadBufferDesc.bindFlags  = LLGL::BindFlags::CopyDst;
+            }
+            uploadBuffer = renderer->CreateBuffer(uploadBufferDesc);
+
+            LoadShaders();
+        }
+
+        LLGL::PipelineLayout* CreatePipelineLayout(long bindingFlags)
+        {
+            LLGL::BindingDescriptor binding
+            {
+                "Settings", LLGL::ResourceType::Buffer, LLGL::BindFlags::ConstantBuffer,
+                (LLGL::StageFlags::VertexStage | LLGL::StageFlags::FragmentStage), 1
+            };
+            binding.flags = bindingFlags;
+
+            LLGL::PipelineLayoutDescriptor layoutDesc;
+            layoutDesc.bindings = { binding };
+            return renderer->CreatePipelineLayout(layoutDesc);
+        }
+
+        LLGL::PipelineState* CreatePipelineState(LLGL::PipelineLayout* layout, LLGL::CullMode cullMode)
+        {
+            LLGL::GraphicsPipelineDescriptor psoDesc;
+            {
+                psoDesc.pipelineLayout      = layout;
+                psoDesc.vertexShader        = vertexShader;
+                psoDesc.fragmentShader      = fragmentShader;
+                psoDesc.renderPass          = swapChain->GetRenderPass();
+                psoDesc.rasterizer.cullMode = cullMode;
+            }
+            auto pso = renderer->CreatePipelineState(psoDesc);
+            if (auto report = pso->GetReport())
+            {
+                if (report->HasErrors())
+                    throw std::runtime_error(std::string("failed to create pipeline state:\n") + report->GetText());
+            }
+            return pso;
+        }
+
+        // Runs the specified callback for each frame and appends the measured times as a new result.
+        void Measure(
+            const std::string&                                  benchmark,
+            const std::string&                                  variant,
+            std::uint64_t                                       numCommandsPerFrame,
+            std::uint64_t                                       numBytesPerFrame,
+            bool                                                renderPass,
+            const std::function<void(LLGL::CommandBuffer&)>&    encodeFrame)
+        {
+            auto EncodeAndSubmit = [&]()
+            {
+                commands->Begin();
+                {
+                    if (renderPass)
+                    {
+                        commands->BeginRenderPass(*swapChain);
+                        {
+                            commands->SetViewport(swapChain->GetResolution());
+                            encodeFrame(*commands);
+                        }
+                        commands->EndRenderPass();
+                    }
+                    else
+                        encodeFrame(*commands);
+                }
+                commands->End();
+                commandQueue->Submit(*commands);
+            };
+
+            // Warm up caches and lazily created driver objects, and discard the command statistics of the warm-up frame
+            EncodeAndSubmit();
+            commandQueue->WaitIdle();
+
+            LLGL::CommandStatistics commandStats;
+            renderer->QueryCommandStatistics(commandStats);
+
+            // Measure CPU time to encode and submit all frames, and total time until the GPU is idle
+            double cpuTime = 0.0;
+            const auto startTime = Clock::now();
+
+            for (std::uint32_t frame = 0; frame < config.numFrames; ++frame)
+            {
+                const auto frameStartTime = Clock::now();
+                EncodeAndSubmit();
+                cpuTime += ElapsedMilliseconds(frameStartTime, Clock::now());
+                swapChain->Present();
+            }
+
+            commandQueue->WaitIdle();
+            const auto endTime = Clock::now();
+
+            BenchmarkResult result;
+            {
+                result.module       = moduleName;
+                result.device       = renderer->GetRendererInfo().deviceName;
+                result.benchmark    = benchmark;
+                result.variant      = variant;
+                result.numFrames    = config.numFrames;
+                result.numCommands  = numCommandsPerFrame * config.numFrames;
+                result.numBytes     = numBytesPerFrame * config.numFrames;
+                result.cpuTime      = cpuTime;
+                result.totalTime    = ElapsedMilliseconds(startTime, endTime);
+            }
+
+            if (renderer->QueryCommandStatistics(commandStats))
+                result.histograms = std::move(commandStats.commands);
+
+            results.push_back(result);
+
+            std::cerr << "  " << benchmark << " [" << variant << "]: "
+                << PerSecond(result.numCommands, result.cpuTime) << " commands/s" << std::endl;
+        }
+
+        bool IsBindingModelSupported(BindingModel model, long& outBindingFlags) const
+        {
+            const auto rendererID = renderer->GetRendererID();
+            switch (model)
+            {
+                case BindingModel::ResourceHeap:
+                    outBindingFlags = 0;
+                    return true;
+                case BindingModel::DynamicOffset:
+                    outBindingFlags = LLGL::BindingFlags::DynamicOffset;
+                    return (rendererID == LLGL::RendererID::Vulkan || rendererID == LLGL::RendererID::Direct3D12);
+                case BindingModel::DirectBinding:
+                    if (renderer->GetRenderingCaps().features.hasDirectResourceBinding)
+                    {
+                        outBindingFlags = 0;
+                        return true;
+                    }
+                    outBindingFlags = LLGL::BindingFlags::DynamicBinding;
+                    return (rendererID == LLGL::RendererID::Direct3D12);
+            }
+            return false;
+        }
+
+        void BenchmarkDrawCalls(BindingModel model, const char* variant, bool switchPipelines)
+        {
+            long bindingFlags = 0;
+            if (!IsBindingModelSupported(model, bindingFlags))
+            {
+                std::cerr << "  skip " << variant << " (not supported by renderer)" << std::endl;
+                return;
+            }
+
+            auto layout = CreatePipelineLayout(bindingFlags);
+            LLGL::PipelineState* pso[2] =
+            {
+                CreatePipelineState(layout, LLGL::CullMode::Disabled),
+                CreatePipelineState(layout, LLGL::CullMode::Front),
+            };
+
+            // Create resource heap with one descriptor set per object, or a single descriptor set for dynamic offsets
+            LLGL::ResourceHeap* resourceHeap = nullptr;
+            if (model != BindingModel::DirectBinding)
+            {
+                const auto numViews = (model == BindingModel::ResourceHeap ? config.numDraws : 1u);
+                std::vector<LLGL::ResourceViewDescriptor> resourceViews;
+                resourceViews.reserve(numViews);
+                for (std::uint32_t i = 0; i < numViews; ++i)
+                {
+                    resourceViews.push_back(
+                        LLGL::ResourceViewDescriptor{ constantBuffer, LLGL::BufferViewDescriptor{ LLGL::Format::Undefined, std::uint64_t(objectStride) * i, sizeof(Object) } }
+                    );
+                }
+                resourceHeap = renderer->CreateResourceHeap(LLGL::ResourceHeapDescriptor{ layout }, resourceViews);
+            }
+
+            const std::string benchmark = (switchPipelines ? "PipelineSwitch" : "DrawCalls");
+            const std::uint64_t numCommandsPerFrame = config.numDraws;
+
+            Measure(
+                benchmark, variant, numCommandsPerFrame, 0, true,
+                [&](LLGL::CommandBuffer& cmdBuffer)
+                {
+                    cmdBuffer.SetPipelineState(*pso[0]);
+                    cmdBuffer.SetVertexBuffer(*vertexBuffer);
+
+                    for (std::uint32_t i = 0; i < config.numDraws; ++i)
+                    {
+                        if (switchPipelines)
+                            cmdBuffer.SetPipelineState(*pso[i % 2]);
+
+                        switch (model)
+                        {
+                            case BindingModel::ResourceHeap:
+                                cmdBuffer.SetResourceHeap(*resourceHeap, i);
+                                break;
+                            case BindingModel::DynamicOffset:
+                            {
+                                const std::uint32_t dynamicOffset = objectStride * i;
+                                cmdBuffer.SetResourceHeap(*resourceHeap, 0, 1, &dynamicOffset);
+                            }
+                            break;
+                            case BindingModel::DirectBinding:
+                                cmdBuffer.SetResource(*objectBuffers[i % objectBuffers.size()], 1, LLGL::BindFlags::ConstantBuffer);
+                                break;
+                        }
+
+                        cmdBuffer.Draw(3, 0);
+                    }
+                }
+            );
+
+            if (resourceHeap != nullptr)
+                renderer->Release(*resourceHeap);
+            renderer->Release(*pso[0]);
+            renderer->Release(*pso[1]);
+            renderer->Release(*layout);
+        }
+
+        void BenchmarkUpdateBuffer(std::uint16_t dataSize)
+        {
+            const std::vector<char> data(dataSize, 0x7f);
+            const std::uint64_t numUpdatesPerFrame = config.numUpdates;
+
+            Measure(
+                "UpdateBuffer", std::to_string(dataSize) + " bytes", numUpdatesPerFrame, numUpdatesPerFrame * dataSize, false,
+                [&](LLGL::CommandBuffer& cmdBuffer)
+                {
+                    for (std::uint32_t i = 0; i < config.numUpdates; ++i)
+                        cmdBuffer.UpdateBuffer(*uploadBuffer, 0, data.data(), dataSize);
+                }
+            );
+        }
+
+    public:
+
+        RendererBenchmark(const BenchmarkConfig& config, std::vector<BenchmarkResult>& results) :
+            config  { config  },
+            results { results }
+        {
+        }
+
+        void Load(const std::string& rendererModule)
+        {
+            moduleName = rendererModule;
+
+            // Load Null renderer in benchmark mode to record CPU time histograms per command
+            LLGL::RendererConfigurationNull configNull;
+            configNull.benchmarkMode = true;
+
+            LLGL::RenderSystemDescriptor rendererDesc = rendererModule;
+            if (config.histograms && rendererModule == g_baselineModule)
+            {
+                rendererDesc.rendererConfig     = &configNull;
+                rendererDesc.rendererConfigSize = sizeof(configNull);
+            }
+            renderer = LLGL::RenderSystem::Load(rendererDesc);
+
+            // Create small swap-chain without vertical synchronization, so presenting doesn't limit the throughput
+            LLGL::SwapChainDescriptor swapChainDesc;
+            {
+                swapChainDesc.resolution = { 256, 256 };
+            }
+            swapChain = renderer->CreateSwapChain(swapChainDesc);
+            swapChain->SetVsyncInterval(0);
+
+            commandQueue = renderer->GetCommandQueue();
+            commands = renderer->CreateCommandBuffer();
+
+            CreateResources();
+        }
+
+        void Run()
+        {
+            std::cerr << "run benchmarks for " << moduleName << " (" << renderer->GetRendererInfo().deviceName << ") ..." << std::endl;
+
+            // Draw call throughput for each binding model
+            BenchmarkDrawCalls(BindingModel::ResourceHeap,  "SetResourceHeap",               false);
+            BenchmarkDrawCalls(BindingModel::DynamicOffset, "SetResourceHeap+DynamicOffset", false);
+            BenchmarkDrawCalls(BindingModel::DirectBinding, "SetResource",                   false);
+
+            // Same draw calls with a pipeline switch before each one
+            BenchmarkDrawCalls(BindingModel::ResourceHeap,  "SetResourceHeap",               true);
+
+            // UpdateBuffer throughput for different sizes; the size of a single update is limited to 65532 bytes to keep it 4-byte aligned
+            for (std::uint16_t dataSize : { 16, 256, 1024, 4096, 16384, 65532 })
+                BenchmarkUpdateBuffer(dataSize);
+        }
+
+};
+
+static std::vector<std::string> SplitList(const std::string& s)
+{
+    std::vector<std::string> list;
+    std::stringstream stream(s);
+    for (std::string item; std::getline(stream, item, ',');)
+    {
+        if (!item.empty())
+            list.push_back(item);
+    }
+    return list;
+}
+
+static bool ParseArgument(const std::string& arg, const char* name, std::string& outValue)
+{
+    const std::string prefix = std::string("--") + name + "=";
+    if (arg.compare(0, prefix.size(), prefix) == 0)
+    {
+        outValue = arg.substr(prefix.size());
+        return true;
+    }
+    return false;
+}
+
+static std::uint32_t ParseCount(const std::string& value)
+{
+    return static_cast<std::uint32_t>(std::max(1, std::stoi(value)));
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkConfig config;
+
+    // Parse command line arguments
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        std::string value;
+
+        if (ParseArgument(arg, "format", value))
+            config.format = value;
+        else if (ParseArgument(arg, "output", value))
+            config.output = value;
+        else if (ParseArgument(arg, "modules", value))
+            config.modules = SplitList(value);
+        else if (ParseArgument(arg, "frames", value))
+            config.numFrames = ParseCount(value);
+        else if (ParseArgument(arg, "draws", value))
+            config.numDraws = ParseCount(value);
+        else if (ParseArgument(arg, "updates", value))
+            config.numUpdates = ParseCount(value);
+        else if (arg == "--histograms")
+            config.histograms = true;
+        else if (arg == "--no-baseline")
+            config.baseline = false;
+        else
+        {
+            std::cerr << "usage: Benchmark_Renderer [--format=json|csv] [--output=FILE] [--modules=NAME,...] [--frames=N] [--draws=N] [--updates=N] [--histograms] [--no-baseline]" << std::endl;
+            return 1;
+        }
+    }
+
+    if (config.format != "json" && config.format != "csv")
+    {
+        std::cerr << "unknown output format: " << config.format << std::endl;
+        return 1;
+    }
+
+    // Benchmark all available renderer modules by default
+    if (config.modules.empty())
+        config.modules = LLGL::RenderSystem::FindModules();
+
+    // Always run the baseline module, unless it has been disabled explicitly
+    if (config.baseline && std::find(config.modules.begin(), config.modules.end(), g_baselineModule) == config.modules.end())
+        config.modules.push_back(g_baselineModule);
+
+    LLGL::Log::SetReportCallbackStd(&(std::cerr));
+
+    std::vector<BenchmarkResult> results;
+
+    for (const auto& module : config.modules)
+    {
+        try
+        {
+            RendererBenchmark benchmark{ config, results };
+            benchmark.Load(module);
+            benchmark.Run();
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "skip module " << module << ": " << e.what() << std::endl;
+        }
+    }
+
+    AssignBaselineTimes(results);
+
+    // Write results to output file or standard output
+    std::ofstream file;
+    if (!config.output.empty())
+    {
+        file.open(config.output);
+        if (!file.good())
+        {
+            std::cerr << "failed to open output file: " << config.output << std::endl;
+            return 1;
+        }
+    }
+
+    std::ostream& output = (file.is_open() ? file : std::cout);
+
+    if (config.format == "csv")
+        WriteResultsCSV(output, results);
+    else
+        WriteResultsJSON(output, results, config);
+
+    return 0;
+}
@@ -0,0 +1,248 @@
+/*
+ * Benchmark_Replay.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+/*
+Capture replay benchmark.
+Replays a capture file that has been written by the capture layer (see LLGL::RenderSystemDescriptor::captureFilename)
+and measures the CPU time of each replayed frame. Since the replay issues the captured command stream without any application logic,
+the results of two builds of LLGL (or two renderer modules) can be compared directly to detect performance regressions.
+The first frame of each repetition includes the creation of all initial resources and is reported separately.
+
+Usage:
+  Benchmark_Replay --capture=FILE [--module=NAME] [--repeat=N] [--format=json|csv] [--output=FILE]
+*/
+
+struct ReplayConfig
+{
+    std::string     capture;
+    std::string     module;                 // Renderer module of the capture by default
+    std::string     format      = "json";
+    std::string     output;
+    std::uint32_t   repeat      = 1;
+};
+
+struct ReplayResult
+{
+    std::string             module;
+    std::string             device;
+    double                  firstFrame  = 0.0;  // CPU times in milliseconds
+    std::vector<double>     frames;
+    double                  mean        = 0.0;
+    double                  min         = 0.0;
+    double                  median      = 0.0;
+    double                  max         = 0.0;
+};
+
+static std::string EscapeJSON(const std::string& s)
+{
+    std::string result;
+    result.reserve(s.size());
+    for (char c : s)
+    {
+        if (c == '"' || c == '\\')
+            result += '\\';
+        if (static_cast<unsigned char>(c) >= 0x20)
+            result += c;
+    }
+    return result;
+}
+
+static std::string EscapeCSV(const std::string& s)
+{
+    if (s.find_first_of(",\"\n") == std::string::npos)
+        return s;
+    std::string result = "\"";
+    for (char c : s)
+    {
+        if (c == '"')
+            result += '"';
+        result += c;
+    }
+    return result + "\"";
+}
+
+static void EvaluateResult(ReplayResult& result)
+{
+    if (result.frames.empty())
+        return;
+
+    auto sortedFrames = result.frames;
+    std::sort(sortedFrames.begin(), sortedFrames.end());
+
+    double sum = 0.0;
+    for (double t : sortedFrames)
+        sum += t;
+
+    const auto n = sortedFrames.size();
+    result.mean     = sum / static_cast<double>(n);
+    result.min      = sortedFrames.front();
+    result.max      = sortedFrames.back();
+    result.median   = (n % 2 == 0 ? (sortedFrames[n/2 - 1] + sortedFrames[n/2]) * 0.5 : sortedFrames[n/2]);
+}
+
+static void WriteResultJSON(std::ostream& s, const ReplayConfig& config, const ReplayResult& res)
+{
+    s << "{\n";
+    s << "  \"llglVersion\": \"" << EscapeJSON(LLGL::Version::GetString()) << "\",\n";
+    s << "  \"capture\": \"" << EscapeJSON(config.capture) << "\",\n";
+    s << "  \"module\": \"" << EscapeJSON(res.module) << "\",\n";
+    s << "  \"device\": \"" << EscapeJSON(res.device) << "\",\n";
+    s << "  \"repeat\": " << config.repeat << ",\n";
+    s << "  \"frames\": " << res.frames.size() << ",\n";
+    s << "  \"firstFrameMs\": " << res.firstFrame << ",\n";
+    s << "  \"meanMs\": " << res.mean << ",\n";
+    s << "  \"minMs\": " << res.min << ",\n";
+    s << "  \"medianMs\": " << res.median << ",\n";
+    s << "  \"maxMs\": " << res.max << ",\n";
+    s << "  \"frameTimesMs\": [";
+    for (std::size_t i = 0; i < res.frames.size(); ++i)
+        s << (i > 0 ? ", " : "") << res.frames[i];
+    s << "]\n}\n";
+}
+
+static void WriteResultCSV(std::ostream& s, const ReplayResult& res)
+{
+    s << "module,device,frame,ms\n";
+    for (std::size_t i = 0; i < res.frames.size(); ++i)
+        s << EscapeCSV(res.module) << ',' << EscapeCSV(res.device) << ',' << i << ',' << res.frames[i] << '\n';
+}
+
+static bool ParseArgument(const std::string& arg, const char* name, std::string& outValue)
+{
+    const std::string prefix = std::string("--") + name + "=";
+    if (arg.compare(0, prefix.size(), prefix) == 0)
+    {
+        outValue = arg.substr(prefix.size());
+        return true;
+    }
+    return false;
+}
+
+// Replays the capture and appends the CPU time of each frame to the result.
+static void RunReplay(const ReplayConfig& config, ReplayResult& result)
+{
+    // Load renderer the capture has been written with, unless another renderer is specified
+    std::string moduleName = config.module;
+    if (moduleName.empty())
+    {
+        LLGL::RenderSystemDescriptor nullDesc{ "Null" };
+        auto probe = LLGL::RenderSystem::Load(nullDesc);
+        LLGL::CaptureReplay probeReplay{ *probe, config.capture.c_str() };
+        moduleName = probeReplay.GetCapturedModuleName();
+        LLGL::RenderSystem::Unload(std::move(probe));
+    }
+
+    auto renderer = LLGL::RenderSystem::Load(moduleName);
+    result.module = renderer->GetName();
+    result.device = renderer->GetRendererInfo().deviceName;
+
+    const double ticksToMs = 1000.0 / static_cast<double>(LLGL::Timer::Frequency());
+
+    {
+        LLGL::CaptureReplay replay{ *renderer, config.capture.c_str() };
+
+        for (std::uint32_t i = 0; i < config.repeat; ++i)
+        {
+            if (i > 0)
+                replay.Reset();
+
+            // First frame creates all initial resources, so it is not included in the statistics
+            if (replay.ReplayFrame() && i == 0)
+                result.firstFrame = static_cast<double>(replay.GetLastFrameTicks()) * ticksToMs;
+
+            while (replay.ReplayFrame())
+                result.frames.push_back(static_cast<double>(replay.GetLastFrameTicks()) * ticksToMs);
+        }
+    }
+
+    LLGL::RenderSystem::Unload(std::move(renderer));
+}
+
+int main(int argc, char* argv[])
+{
+    ReplayConfig config;
+
+    // Parse command line arguments
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        std::string value;
+
+        if (ParseArgument(arg, "capture", value))
+            config.capture = value;
+        else if (ParseArgument(arg, "module", value))
+            config.module = value;
+        else if (ParseArgument(arg, "format", value))
+            config.format = value;
+        else if (ParseArgument(arg, "output", value))
+            config.output = value;
+        else if (ParseArgument(arg, "repeat", value))
+            config.repeat = static_cast<std::uint32_t>(std::max(1, std::stoi(value)));
+        else
+        {
+            std::cerr << "usage: Benchmark_Replay --capture=FILE [--module=NAME] [--repeat=N] [--format=json|csv] [--output=FILE]" << std::endl;
+            return 1;
+        }
+    }
+
+    if (config.capture.empty())
+    {
+        std::cerr << "missing capture file: --capture=FILE" << std::endl;
+        return 1;
+    }
+
+    if (config.format != "json" && config.format != "csv")
+    {
+        std::cerr << "unknown output format: " << config.format << std::endl;
+        return 1;
+    }
+
+    LLGL::Log::SetReportCallbackStd(&(std::cerr));
+
+    ReplayResult result;
+
+    try
+    {
+        RunReplay(config, result);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "failed to replay capture " << config.capture << ": " << e.what() << std::endl;
+        return 1;
+    }
+
+    EvaluateResult(result);
+
+    // Write results to output file or standard output
+    std::ofstream file;
+    if (!config.output.empty())
+    {
+        file.open(config.output);
+        if (!file.good())
+        {
+            std::cerr << "failed to open output file: " << config.output << std::endl;
+            return 1;
+        }
+    }
+
+    std::ostream& output = (file.is_open() ? file : std::cout);
+
+    if (config.format == "csv")
+        WriteResultCSV(output, result);
+    else
+        WriteResultJSON(output, config, result);
+
+    return 0;
+}
@@ -0,0 +1,531 @@
+/*
+ * Benchmark_Transfer.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+/*
+Upload and readback bandwidth benchmark.
+Sweeps the transfer size from 256 bytes to 256 MiB for each transfer path of LLGL and each renderer module that can be loaded.
+Paths that are encoded into a command buffer (UpdateBuffer and the texture/buffer copies) are timed with timer queries on the GPU,
+all other paths are timed on the CPU, since they are synchronous from the perspective of the application.
+Results are written as JSON or CSV with the bandwidth (based on the median time) and the latency percentiles of each path and size.
+
+Usage:
+  Benchmark_Transfer [--format=json|csv] [--output=FILE] [--modules=NAME,...] [--iterations=N] [--max-size=BYTES]
+*/
+
+struct TransferConfig
+{
+    std::string                 format          = "json";
+    std::string                 output;
+    std::vector<std::string>    modules;
+    std::uint32_t               maxIterations   = 50;
+    std::uint64_t               minSize         = 256;
+    std::uint64_t               maxSize         = 256ull * 1024ull * 1024ull;
+};
+
+struct TransferResult
+{
+    std::string     module;
+    std::string     device;
+    std::string     path;
+    std::string     timing;                 // Either "gpu" for timer queries or "cpu"
+    std::uint64_t   size            = 0;
+    std::uint32_t   numSamples      = 0;
+    double          min             = 0.0;  // Latencies in milliseconds
+    double          p50             = 0.0;
+    double          p95             = 0.0;
+    double          p99             = 0.0;
+    double          max             = 0.0;
+    double          bandwidth       = 0.0;  // Bandwidth in GB/s (based on the median latency)
+};
+
+using Clock = std::chrono::high_resolution_clock;
+
+// Returns the value at the specified percentile of the sorted samples (nearest-rank method).
+static double Percentile(const std::vector<double>& sortedSamples, double percentile)
+{
+    if (sortedSamples.empty())
+        return 0.0;
+    auto rank = static_cast<std::size_t>(percentile / 100.0 * static_cast<double>(sortedSamples.size()) + 0.5);
+    rank = std::max<std::size_t>(1, std::min(rank, sortedSamples.size()));
+    return sortedSamples[rank - 1];
+}
+
+static std::string FormatSize(std::uint64_t size)
+{
+    if (size >= 1024ull * 1024ull)
+        return std::to_string(size / (1024ull * 1024ull)) + " MiB";
+    if (size >= 1024ull)
+        return std::to_string(size / 1024ull) + " KiB";
+    return std::to_string(size) + " B";
+}
+
+static std::string EscapeJSON(const std::string& s)
+{
+    std::string result;
+    result.reserve(s.size());
+    for (char c : s)
+    {
+        if (c == '"' || c == '\\')
+            result += '\\';
+        if (static_cast<unsigned char>(c) >= 0x20)
+            result += c;
+    }
+    return result;
+}
+
+static std::string EscapeCSV(const std::string& s)
+{
+    if (s.find_first_of(",\"\n") == std::string::npos)
+        return s;
+    std::string result = "\"";
+    for (char c : s)
+    {
+        if (c == '"')
+            result += '"';
+        result += c;
+    }
+    return result + "\"";
+}
+
+static void WriteResultsJSON(std::ostream& s, const std::vector<TransferResult>& results)
+{
+    s << "{\n";
+    s << "  \"llglVersion\": \"" << EscapeJSON(LLGL::Version::GetString()) << "\",\n";
+    s << "  \"results\": [";
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& res = results[i];
+        s << (i > 0 ? ",\n    {" : "\n    {");
+        s << "\"module\": \"" << EscapeJSON(res.module) << "\", ";
+        s << "\"device\": \"" << EscapeJSON(res.device) << "\", ";
+        s << "\"path\": \"" << EscapeJSON(res.path) << "\", ";
+        s << "\"timing\": \"" << res.timing << "\", ";
+        s << "\"size\": " << res.size << ", ";
+        s << "\"samples\": " << res.numSamples << ", ";
+        s << "\"minMs\": " << res.min << ", ";
+        s << "\"p50Ms\": " << res.p50 << ", ";
+        s << "\"p95Ms\": " << res.p95 << ", ";
+        s << "\"p99Ms\": " << res.p99 << ", ";
+        s << "\"maxMs\": " << res.max << ", ";
+        s << "\"bandwidthGBps\": " << res.bandwidth;
+        s << "}";
+    }
+
+    s << "\n  ]\n}\n";
+}
+
+static void WriteResultsCSV(std::ostream& s, const std::vector<TransferResult>& results)
+{
+    s << "module,device,path,timing,size,samples,minMs,p50Ms,p95Ms,p99Ms,maxMs,bandwidthGBps\n";
+    for (const auto& res : results)
+    {
+        s << EscapeCSV(res.module) << ',';
+        s << EscapeCSV(res.device) << ',';
+        s << EscapeCSV(res.path) << ',';
+        s << res.timing << ',';
+        s << res.size << ',';
+        s << res.numSamples << ',';
+        s << res.min << ',';
+        s << res.p50 << ',';
+        s << res.p95 << ',';
+        s << res.p99 << ',';
+        s << res.max << ',';
+        s << res.bandwidth << '\n';
+    }
+}
+
+class TransferBenchmark
+{
+
+    private:
+
+        const TransferConfig&           config;
+        std::vector<TransferResult>&    results;
+
+        std::string                     moduleName;
+        LLGL::RenderSystemPtr           renderer;
+        LLGL::CommandQueue*             commandQueue    = nullptr;
+        LLGL::CommandBuffer*            commands        = nullptr;
+        LLGL::QueryHeap*                timerQuery      = nullptr;
+
+        std::vector<char>               hostData;
+
+    private:
+
+        // Returns the number of timed iterations for the specified transfer size, i.e. fewer iterations for large transfers.
+        std::uint32_t GetNumIterations(std::uint64_t size) const
+        {
+            const std::uint64_t budget = 64ull * 1024ull * 1024ull;
+            const auto iterations = static_cast<std::uint32_t>(std::min<std::uint64_t>(config.maxIterations, budget / size));
+            return std::max(std::min(5u, config.maxIterations), iterations);
+        }
+
+        void AppendResult(const char* path, const char* timing, std::uint64_t size, std::vector<double>& samples)
+        {
+            std::sort(samples.begin(), samples.end());
+
+            TransferResult result;
+            {
+                result.module       = moduleName;
+                result.device       = renderer->GetRendererInfo().deviceName;
+                result.path         = path;
+                result.timing       = timing;
+                result.size         = size;
+                result.numSamples   = static_cast<std::uint32_t>(samples.size());
+                result.min          = Percentile(samples, 0.0);
+                result.p50          = Percentile(samples, 50.0);
+                result.p95          = Percentile(samples, 95.0);
+                result.p99          = Percentile(samples, 99.0);
+                result.max          = Percentile(samples, 100.0);
+                result.bandwidth    = (result.p50 > 0.0 ? static_cast<double>(size) / (result.p50 * 1.0e6) : 0.0);
+            }
+            results.push_back(result);
+
+            std::cerr << "  " << path << " [" << FormatSize(size) << "]: " << result.bandwidth << " GB/s, p50 = " << result.p50 << " ms" << std::endl;
+        }
+
+        // Measures the specified callback on the CPU; one warm-up iteration is not timed.
+        void MeasureCPU(const char* path, std::uint64_t size, const std::function<void()>& callback)
+        {
+            const auto numIterations = GetNumIterations(size);
+
+            std::vector<double> samples;
+            samples.reserve(numIterations);
+
+            callback();
+            for (std::uint32_t i = 0; i < numIterations; ++i)
+            {
+                const auto startTime = Clock::now();
+                callback();
+                samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - startTime).count());
+            }
+
+            AppendResult(path, "cpu", size, samples);
+        }
+
+        // Measures the commands that are encoded by the specified callback with a timer query on the GPU; one warm-up iteration is not timed.
+        void MeasureGPU(const char* path, std::uint64_t size, const std::function<void(LLGL::CommandBuffer&)>& encode)
+        {
+            const auto numIterations = GetNumIterations(size);
+
+            std::vector<double> samples;
+            samples.reserve(numIterations);
+
+            for (std::uint32_t i = 0; i <= numIterations; ++i)
+            {
+                commands->Begin();
+                {
+                    commands->BeginQuery(*timerQuery, 0);
+                    encode(*commands);
+                    commands->EndQuery(*timerQuery, 0);
+                }
+                commands->End();
+                commandQueue->Submit(*commands);
+
+                std::uint64_t elapsedTime = 0;
+                while (!commandQueue->QueryResult(*timerQuery, 0, 1, &elapsedTime, sizeof(elapsedTime)))
+                {
+                    // Wait for query result
+                }
+
+                if (i > 0)
+                    samples.push_back(static_cast<double>(elapsedTime) / 1.0e6);
+            }
+
+            AppendResult(path, "gpu", size, samples);
+        }
+
+        void BenchmarkBuffers(std::uint64_t size)
+        {
+            const auto& limits = renderer->GetRenderingCaps().limits;
+            if (limits.maxBufferSize > 0 && size > limits.maxBufferSize)
+            {
+                std::cerr << "  skip buffers of " << FormatSize(size) << " (exceeds maximum buffer size)" << std::endl;
+                return;
+            }
+
+            LLGL::BufferDescriptor bufferDesc;
+            {
+                bufferDesc.size             = size;
+                bufferDesc.bindFlags        = LLGL::BindFlags::CopySrc | LLGL::BindFlags::CopyDst;
+                bufferDesc.cpuAccessFlags   = LLGL::CPUAccessFlags::Read | LLGL::CPUAccessFlags::Write;
+            }
+            auto buffer = renderer->CreateBuffer(bufferDesc);
+
+            MeasureCPU(
+                "WriteBuffer", size,
+                [&]() { renderer->WriteBuffer(*buffer, 0, hostData.data(), size); }
+            );
+
+            MeasureCPU(
+                "ReadBuffer", size,
+                [&]() { renderer->ReadBuffer(*buffer, 0, hostData.data(), size); }
+            );
+
+            MeasureCPU(
+                "MapBuffer(WriteDiscard)", size,
+                [&]()
+                {
+                    if (auto dst = renderer->MapBuffer(*buffer, LLGL::CPUAccess::WriteDiscard))
+                    {
+                        ::memcpy(dst, hostData.data(), static_cast<std::size_t>(size));
+                        renderer->UnmapBuffer(*buffer);
+                    }
+                }
+            );
+
+            MeasureCPU(
+                "MapBuffer(ReadOnly)", size,
+                [&]()
+                {
+                    if (auto src = renderer->MapBuffer(*buffer, LLGL::CPUAccess::ReadOnly))
+                    {
+                        ::memcpy(hostData.data(), src, static_cast<std::size_t>(size));
+                        renderer->UnmapBuffer(*buffer);
+                    }
+                }
+            );
+
+            // UpdateBuffer is limited to 65536 bytes per command, so larger transfers are split into multiple commands
+            MeasureGPU(
+                "UpdateBuffer", size,
+                [&](LLGL::CommandBuffer& cmdBuffer)
+                {
+                    const std::uint64_t chunkSize = 65532;
+                    for (std::uint64_t offset = 0; offset < size; offset += chunkSize)
+                    {
+                        const auto dataSize = static_cast<std::uint16_t>(std::min(chunkSize, size - offset));
+                        cmdBuffer.UpdateBuffer(*buffer, offset, hostData.data() + offset, dataSize);
+                    }
+                }
+            );
+
+            renderer->Release(*buffer);
+        }
+
+        void BenchmarkTextures(std::uint64_t size, std::uint32_t textureSize)
+        {
+            const auto& limits = renderer->GetRenderingCaps().limits;
+            if (textureSize > limits.max2DTextureSize)
+            {
+                std::cerr << "  skip textures of " << FormatSize(size) << " (exceeds maximum texture size)" << std::endl;
+                return;
+            }
+
+            // Create RGBA8 texture with the transfer size and a buffer for copy commands
+            LLGL::TextureDescriptor textureDesc;
+            {
+                textureDesc.type        = LLGL::TextureType::Texture2D;
+                textureDesc.bindFlags   = LLGL::BindFlags::Sampled | LLGL::BindFlags::CopySrc | LLGL::BindFlags::CopyDst;
+                textureDesc.format      = LLGL::Format::RGBA8UNorm;
+                textureDesc.extent      = { textureSize, textureSize, 1 };
+                textureDesc.mipLevels   = 1;
+            }
+            auto texture = renderer->CreateTexture(textureDesc);
+
+            LLGL::BufferDescriptor bufferDesc;
+            {
+                bufferDesc.size         = size;
+                bufferDesc.bindFlags    = LLGL::BindFlags::CopySrc | LLGL::BindFlags::CopyDst;
+            }
+            auto buffer = renderer->CreateBuffer(bufferDesc);
+
+            const LLGL::TextureRegion region{ LLGL::Offset3D{}, textureDesc.extent };
+
+            MeasureCPU(
+                "WriteTexture", size,
+                [&]()
+                {
+                    const LLGL::SrcImageDescriptor imageDesc{ LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, hostData.data(), static_cast<std::size_t>(size) };
+                    renderer->WriteTexture(*texture, region, imageDesc);
+                }
+            );
+
+            MeasureCPU(
+                "ReadTexture", size,
+                [&]()
+                {
+                    const LLGL::DstImageDescriptor imageDesc{ LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, hostData.data(), static_cast<std::size_t>(size) };
+                    renderer->ReadTexture(*texture, region, imageDesc);
+                }
+            );
+
+            MeasureGPU(
+                "CopyTextureFromBuffer", size,
+                [&](LLGL::CommandBuffer& cmdBuffer) { cmdBuffer.CopyTextureFromBuffer(*texture, region, *buffer, 0); }
+            );
+
+            MeasureGPU(
+                "CopyBufferFromTexture", size,
+                [&](LLGL::CommandBuffer& cmdBuffer) { cmdBuffer.CopyBufferFromTexture(*buffer, 0, *texture, region); }
+            );
+
+            renderer->Release(*buffer);
+            renderer->Release(*texture);
+        }
+
+    public:
+
+        TransferBenchmark(const TransferConfig& config, std::vector<TransferResult>& results) :
+            config  { config  },
+            results { results }
+        {
+        }
+
+        void Load(const std::string& rendererModule)
+        {
+            moduleName = rendererModule;
+            renderer = LLGL::RenderSystem::Load(rendererModule);
+
+            // Create small swap-chain, since some renderers (e.g. OpenGL) require a context to create any resources
+            LLGL::SwapChainDescriptor swapChainDesc;
+            {
+                swapChainDesc.resolution = { 256, 256 };
+            }
+            renderer->CreateSwapChain(swapChainDesc);
+
+            commandQueue = renderer->GetCommandQueue();
+            commands = renderer->CreateCommandBuffer();
+
+            LLGL::QueryHeapDescriptor queryDesc;
+            {
+                queryDesc.type = LLGL::QueryType::TimeElapsed;
+            }
+            timerQuery = renderer->CreateQueryHeap(queryDesc);
+        }
+
+        void Run()
+        {
+            std::cerr << "run transfer benchmarks for " << moduleName << " (" << renderer->GetRendererInfo().deviceName << ") ..." << std::endl;
+
+            // Sweep sizes by powers of 4, so each size is also the size of a square RGBA8 texture
+            std::uint32_t textureSize = 8;
+            for (std::uint64_t size = config.minSize; size <= config.maxSize; size *= 4, textureSize *= 2)
+            {
+                hostData.resize(static_cast<std::size_t>(size), 0x7f);
+                BenchmarkBuffers(size);
+                BenchmarkTextures(size, textureSize);
+            }
+
+            hostData.clear();
+            hostData.shrink_to_fit();
+        }
+
+};
+
+static std::vector<std::string> SplitList(const std::string& s)
+{
+    std::vector<std::string> list;
+    std::stringstream stream(s);
+    for (std::string item; std::getline(stream, item, ',');)
+    {
+        if (!item.empty())
+            list.push_back(item);
+    }
+    return list;
+}
+
+static bool ParseArgument(const std::string& arg, const char* name, std::string& outValue)
+{
+    const std::string prefix = std::string("--") + name + "=";
+    if (arg.compare(0, prefix.size(), prefix) == 0)
+    {
+        outValue = arg.substr(prefix.size());
+        return true;
+    }
+    return false;
+}
+
+int main(int argc, char* argv[])
+{
+    TransferConfig config;
+
+    // Parse command line arguments
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        std::string value;
+
+        if (ParseArgument(arg, "format", value))
+            config.format = value;
+        else if (ParseArgument(arg, "output", value))
+            config.output = value;
+        else if (ParseArgument(arg, "modules", value))
+            config.modules = SplitList(value);
+        else if (ParseArgument(arg, "iterations", value))
+            config.maxIterations = static_cast<std::uint32_t>(std::max(1, std::stoi(value)));
+        else if (ParseArgument(arg, "max-size", value))
+            config.maxSize = std::max<std::uint64_t>(config.minSize, std::stoull(value));
+        else
+        {
+            std::cerr << "usage: Benchmark_Transfer [--format=json|csv] [--output=FILE] [--modules=NAME,...] [--iterations=N] [--max-size=BYTES]" << std::endl;
+            return 1;
+        }
+    }
+
+    if (config.format != "json" && config.format != "csv")
+    {
+        std::cerr << "unknown output format: " << config.format << std::endl;
+        return 1;
+    }
+
+    // Benchmark all available renderer modules by default
+    if (config.modules.empty())
+        config.modules = LLGL::RenderSystem::FindModules();
+
+    LLGL::Log::SetReportCallbackStd(&(std::cerr));
+
+    std::vector<TransferResult> results;
+
+    for (const auto& module : config.modules)
+    {
+        try
+        {
+            TransferBenchmark benchmark{ config, results };
+            benchmark.Load(module);
+            benchmark.Run();
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "skip module " << module << ": " << e.what() << std::endl;
+        }
+    }
+
+    // Write results to output file or standard output
+    std::ofstream file;
+    if (!config.output.empty())
+    {
+        file.open(config.output);
+        if (!file.good())
+        {
+            std::cerr << "failed to open output file: " << config.output << std::endl;
+            return 1;
+        }
+    }
+
+    std::ostream& output = (file.is_open() ? file : std::cout);
+
+    if (config.format == "csv")
+        WriteResultsCSV(output, results);
+    else
+        WriteResultsJSON(output, results);
+
+    return 0;
+}
@@ -0,0 +1,14 @@
+#version 450 core
+
+layout(binding = 1) uniform Settings
+{
+	vec4 offset;
+	vec4 color;
+};
+
+layout(location = 0) out vec4 fColor;
+
+void main()
+{
+	fColor = color;
+}
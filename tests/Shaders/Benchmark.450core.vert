@@ -0,0 +1,19 @@
+#version 450 core
+
+layout(location = 0) in vec2 position;
+
+layout(binding = 1) uniform Settings
+{
+	vec4 offset;
+	vec4 color;
+};
+
+out gl_PerVertex
+{
+	vec4 gl_Position;
+};
+
+void main()
+{
+	gl_Position = vec4(position, 0, 1) + offset;
+}
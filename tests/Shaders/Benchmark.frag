@@ -0,0 +1,14 @@
+#version 330 core
+
+layout(std140) uniform Settings
+{
+	vec4 offset;
+	vec4 color;
+};
+
+out vec4 fColor;
+
+void main()
+{
+	fColor = color;
+}
@@ -0,0 +1,30 @@
+// Benchmark.hlsl
+// HLSL shader for the LLGL renderer benchmark
+
+cbuffer Settings : register(b1)
+{
+    float4 offset;
+    float4 color;
+};
+
+float4 VS(float2 position : POSITION) : SV_Position
+{
+    return float4(position, 0, 1) + offset;
+}
+
+float4 PS() : SV_Target
+{
+    return color;
+}
+
+#ifndef SCALE
+#define SCALE 1.0
+#endif
+
+RWStructuredBuffer<float4> values : register(u2);
+
+[numthreads(64, 1, 1)]
+void CS(uint3 id : SV_DispatchThreadID)
+{
+    values[id.x] = values[id.x] * SCALE + (float4)SCALE;
+}
@@ -0,0 +1,40 @@
+#include <metal_stdlib>
+#include <simd/simd.h>
+
+using namespace metal;
+
+typedef struct
+{
+    float4 offset;
+    float4 color;
+}
+Settings;
+
+typedef struct
+{
+    float2 position [[attribute(0)]];
+}
+VertexIn;
+
+vertex float4 VS(
+    VertexIn            inp         [[stage_in]],
+    constant Settings&  settings    [[buffer(1)]])
+{
+    return float4(inp.position, 0.0, 1.0) + settings.offset;
+}
+
+fragment float4 PS(constant Settings& settings [[buffer(1)]])
+{
+    return settings.color;
+}
+
+#ifndef SCALE
+#define SCALE 1.0
+#endif
+
+kernel void CS(
+    device float4*  values  [[buffer(2)]],
+    uint            id      [[thread_position_in_grid]])
+{
+    values[id] = values[id] * SCALE + float4(SCALE);
+}
@@ -0,0 +1,14 @@
+#version 330 core
+
+in vec2 position;
+
+layout(std140) uniform Settings
+{
+	vec4 offset;
+	vec4 color;
+};
+
+void main()
+{
+	gl_Position = vec4(position, 0, 1) + offset;
+}
@@ -1,4 +1,7 @@
 glslangValidator -V -S vert -o Triangle.vert.spv Triangle.vert
 glslangValidator -V -S frag -o Triangle.frag.spv Triangle.frag
 glslangValidator -V -S comp -o SpirvReflectTest.comp.spv SpirvReflectTest.comp
+glslangValidator -V -S vert -o Benchmark.450core.vert.spv Benchmark.450core.vert
+glslangValidator -V -S frag -o Benchmark.450core.frag.spv Benchmark.450core.frag
+glslangValidator -V -S comp -o Benchmark.450core.comp.spv Benchmark.450core.comp
 pause
\ No newline at end of file
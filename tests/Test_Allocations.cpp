@@ -0,0 +1,427 @@
+/*
+ * Test_Allocations.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/Misc/Utility.h>
+#include <LLGL/Misc/VertexFormat.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+/*
+Steady-state allocation test.
+Renders a reference scene for every renderer module that can be loaded and fails if any memory is allocated in the measured frames.
+Two counters are used: The LLGL allocator callbacks (see LLGL::Allocator::SetCallbacks) count the internal allocations of LLGL on the hot paths,
+and the replaced global operator new counts all other allocations of this process.
+Note that the global operator new of this executable is not used by LLGL if it has been built as DLL on Windows,
+in which case only the allocator callbacks are effective.
+
+Usage:
+  Test_Allocations [--modules=NAME,...] [--warmup=N] [--frames=N]
+*/
+
+static std::atomic<bool>            g_countAllocations{ false };
+static std::atomic<std::uint64_t>   g_numGlobalAllocations{ 0 };
+static std::atomic<std::uint64_t>   g_numLLGLAllocations{ 0 };
+
+void* operator new (std::size_t size)
+{
+    if (g_countAllocations.load(std::memory_order_relaxed))
+        g_numGlobalAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* block = std::malloc(size > 0 ? size : 1))
+        return block;
+    throw std::bad_alloc();
+}
+
+void operator delete (void* block) noexcept
+{
+    std::free(block);
+}
+
+void* operator new [] (std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete [] (void* block) noexcept
+{
+    ::operator delete(block);
+}
+
+// Counting allocator for the internal allocations of LLGL; blocks with a larger alignment than malloc provides store the original pointer in front of the aligned block.
+static void* CountingAllocate(std::size_t size, std::size_t alignment, void* /*userData*/)
+{
+    if (g_countAllocations.load(std::memory_order_relaxed))
+        g_numLLGLAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (alignment <= alignof(std::max_align_t))
+        return std::malloc(size);
+
+    void* block = std::malloc(size + alignment + sizeof(void*));
+    if (block == nullptr)
+        return nullptr;
+
+    auto alignedAddr = (reinterpret_cast<std::uintptr_t>(block) + sizeof(void*) + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    void* alignedBlock = reinterpret_cast<void*>(alignedAddr);
+    reinterpret_cast<void**>(alignedBlock)[-1] = block;
+    return alignedBlock;
+}
+
+static void CountingFree(void* block, std::size_t /*size*/, std::size_t alignment, void* /*userData*/)
+{
+    if (alignment <= alignof(std::max_align_t))
+        std::free(block);
+    else
+        std::free(reinterpret_cast<void**>(block)[-1]);
+}
+
+struct TestConfig
+{
+    std::vector<std::string>    modules;
+    std::uint32_t               numWarmupFrames = 16;
+    std::uint32_t               numFrames       = 100;
+};
+
+class AllocationTest
+{
+
+    private:
+
+        struct Object
+        {
+            float offset[4];
+            float color[4];
+        };
+
+        static const std::uint32_t numObjects = 64;
+
+    private:
+
+        const TestConfig&           config;
+
+        LLGL::RenderSystemPtr       renderer;
+        LLGL::SwapChain*            swapChain       = nullptr;
+        LLGL::CommandQueue*         commandQueue    = nullptr;
+        LLGL::CommandBuffer*        commands        = nullptr;
+
+        LLGL::VertexFormat          vertexFormat;
+        LLGL::Buffer*               vertexBuffer    = nullptr;
+        LLGL::Buffer*               constantBuffer  = nullptr;
+        LLGL::Shader*               vertexShader    = nullptr;
+        LLGL::Shader*               fragmentShader  = nullptr;
+        LLGL::PipelineLayout*       pipelineLayout  = nullptr;
+        LLGL::PipelineState*        pipelines[2]    = {};
+        LLGL::ResourceHeap*         resourceHeap    = nullptr;
+        std::uint32_t               objectStride    = 256;
+        Object                      objectUpdate    = {};
+
+    private:
+
+        bool Supported(LLGL::ShadingLanguage language) const
+        {
+            const auto& languages = renderer->GetRenderingCaps().shadingLanguages;
+            return (std::find(languages.begin(), languages.end(), language) != languages.end());
+        }
+
+        LLGL::Shader* LoadShader(LLGL::ShaderType type, const char* filename, const char* entryPoint = nullptr, const char* profile = nullptr)
+        {
+            const std::string path = std::string("Shaders/") + filename;
+            if (!std::ifstream(path).good())
+                throw std::runtime_error("missing shader file: " + path);
+
+            auto shaderDesc = LLGL::ShaderDescFromFile(type, path.c_str(), entryPoint, profile);
+            if (type == LLGL::ShaderType::Vertex)
+                shaderDesc.vertex.inputAttribs = vertexFormat.attributes;
+
+            auto shader = renderer->CreateShader(shaderDesc);
+            if (auto report = shader->GetReport())
+            {
+                if (report->HasErrors())
+                    throw std::runtime_error("failed to compile shader " + path + ":\n" + report->GetText());
+            }
+            return shader;
+        }
+
+        void LoadShaders()
+        {
+            if (Supported(LLGL::ShadingLanguage::GLSL))
+            {
+                vertexShader    = LoadShader(LLGL::ShaderType::Vertex,   "Benchmark.vert");
+                fragmentShader  = LoadShader(LLGL::ShaderType::Fragment, "Benchmark.frag");
+            }
+            else if (Supported(LLGL::ShadingLanguage::SPIRV))
+            {
+                vertexShader    = LoadShader(LLGL::ShaderType::Vertex,   "Benchmark.450core.vert.spv");
+                fragmentShader  = LoadShader(LLGL::ShaderType::Fragment, "Benchmark.450core.frag.spv");
+            }
+            else if (Supported(LLGL::ShadingLanguage::HLSL))
+            {
+                vertexShader    = LoadShader(LLGL::ShaderType::Vertex,   "Benchmark.hlsl", "VS", "vs_5_0");
+                fragmentShader  = LoadShader(LLGL::ShaderType::Fragment, "Benchmark.hlsl", "PS", "ps_5_0");
+            }
+            else if (Supported(LLGL::ShadingLanguage::Metal))
+            {
+                vertexShader    = LoadShader(LLGL::ShaderType::Vertex,   "Benchmark.metal", "VS", "1.1");
+                fragmentShader  = LoadShader(LLGL::ShaderType::Fragment, "Benchmark.metal", "PS", "1.1");
+            }
+            else
+                throw std::runtime_error("no supported shading language");
+        }
+
+        LLGL::PipelineState* CreatePipelineState(LLGL::CullMode cullMode)
+        {
+            LLGL::GraphicsPipelineDescriptor psoDesc;
+            {
+                psoDesc.pipelineLayout      = pipelineLayout;
+                psoDesc.vertexShader        = vertexShader;
+                psoDesc.fragmentShader      = fragmentShader;
+                psoDesc.renderPass          = swapChain->GetRenderPass();
+                psoDesc.rasterizer.cullMode = cullMode;
+            }
+            auto pso = renderer->CreatePipelineState(psoDesc);
+            if (auto report = pso->GetReport())
+            {
+                if (report->HasErrors())
+                    throw std::runtime_error(std::string("failed to create pipeline state:\n") + report->GetText());
+            }
+            return pso;
+        }
+
+        // Creates the reference scene: small triangles with one constant buffer range per object, two pipeline states, and a resource heap.
+        void CreateScene()
+        {
+            const float vertices[] = { 0.0f, 0.01f, 0.01f, -0.01f, -0.01f, -0.01f };
+
+            vertexFormat.AppendAttribute({ "position", LLGL::Format::RG32Float });
+            vertexBuffer = renderer->CreateBuffer(LLGL::VertexBufferDesc(sizeof(vertices), vertexFormat), vertices);
+
+            const auto alignment = static_cast<std::uint32_t>(renderer->GetRenderingCaps().limits.minConstantBufferAlignment);
+            objectStride = std::max(objectStride, alignment);
+
+            std::vector<char> objectData(static_cast<std::size_t>(objectStride) * numObjects, 0);
+            for (std::uint32_t i = 0; i < numObjects; ++i)
+            {
+                auto obj = reinterpret_cast<Object*>(&objectData[static_cast<std::size_t>(objectStride) * i]);
+                obj->offset[0]  = static_cast<float>(i % 8) / 4.0f - 1.0f;
+                obj->offset[1]  = static_cast<float>(i / 8) / 4.0f - 1.0f;
+                obj->color[0]   = static_cast<float>(i % 7) / 7.0f;
+                obj->color[1]   = static_cast<float>(i % 5) / 5.0f;
+                obj->color[2]   = static_cast<float>(i % 3) / 3.0f;
+                obj->color[3]   = 1.0f;
+            }
+            constantBuffer = renderer->CreateBuffer(LLGL::ConstantBufferDesc(objectData.size()), objectData.data());
+
+            LoadShaders();
+
+            LLGL::PipelineLayoutDescriptor layoutDesc;
+            {
+                layoutDesc.bindings =
+                {
+                    LLGL::BindingDescriptor
+                    {
+                        "Settings", LLGL::ResourceType::Buffer, LLGL::BindFlags::ConstantBuffer,
+                        (LLGL::StageFlags::VertexStage | LLGL::StageFlags::FragmentStage), 1
+                    }
+                };
+            }
+            pipelineLayout = renderer->CreatePipelineLayout(layoutDesc);
+
+            pipelines[0] = CreatePipelineState(LLGL::CullMode::Disabled);
+            pipelines[1] = CreatePipelineState(LLGL::CullMode::Front);
+
+            std::vector<LLGL::ResourceViewDescriptor> resourceViews;
+            for (std::uint32_t i = 0; i < numObjects; ++i)
+            {
+                resourceViews.push_back(
+                    LLGL::ResourceViewDescriptor{ constantBuffer, LLGL::BufferViewDescriptor{ LLGL::Format::Undefined, std::uint64_t(objectStride) * i, sizeof(Object) } }
+                );
+            }
+            resourceHeap = renderer->CreateResourceHeap(LLGL::ResourceHeapDescriptor{ pipelineLayout }, resourceViews);
+        }
+
+        // Encodes, submits, and presents a single frame; this must not allocate any memory in this test itself.
+        void RenderFrame(std::uint32_t frame)
+        {
+            commands->Begin();
+            {
+                // Update the constants of one object per frame
+                objectUpdate.offset[0]  = static_cast<float>(frame % 8) / 4.0f - 1.0f;
+                objectUpdate.color[3]   = 1.0f;
+                commands->UpdateBuffer(*constantBuffer, 0, &objectUpdate, sizeof(objectUpdate));
+
+                commands->BeginRenderPass(*swapChain);
+                {
+                    commands->Clear(LLGL::ClearFlags::Color);
+                    commands->SetViewport(swapChain->GetResolution());
+                    commands->SetVertexBuffer(*vertexBuffer);
+
+                    for (std::uint32_t i = 0; i < numObjects; ++i)
+                    {
+                        if (i % 16 == 0)
+                            commands->SetPipelineState(*pipelines[(i / 16) % 2]);
+                        commands->SetResourceHeap(*resourceHeap, i);
+                        commands->Draw(3, 0);
+                    }
+                }
+                commands->EndRenderPass();
+            }
+            commands->End();
+            commandQueue->Submit(*commands);
+            swapChain->Present();
+        }
+
+    public:
+
+        AllocationTest(const TestConfig& config) :
+            config { config }
+        {
+        }
+
+        void Load(const std::string& rendererModule)
+        {
+            renderer = LLGL::RenderSystem::Load(rendererModule);
+
+            LLGL::SwapChainDescriptor swapChainDesc;
+            {
+                swapChainDesc.resolution = { 256, 256 };
+            }
+            swapChain = renderer->CreateSwapChain(swapChainDesc);
+            swapChain->SetVsyncInterval(0);
+
+            commandQueue = renderer->GetCommandQueue();
+            commands = renderer->CreateCommandBuffer();
+
+            CreateScene();
+        }
+
+        // Renders the warm-up frames and returns the number of allocations of both counters in the measured frames.
+        void Run(std::uint64_t& outNumLLGLAllocations, std::uint64_t& outNumGlobalAllocations)
+        {
+            // Warm up caches, transient pools, and lazily created objects
+            for (std::uint32_t frame = 0; frame < config.numWarmupFrames; ++frame)
+                RenderFrame(frame);
+            commandQueue->WaitIdle();
+
+            // Count all allocations of the steady-state frames
+            g_numLLGLAllocations = 0;
+            g_numGlobalAllocations = 0;
+            g_countAllocations = true;
+
+            for (std::uint32_t frame = 0; frame < config.numFrames; ++frame)
+                RenderFrame(config.numWarmupFrames + frame);
+
+            g_countAllocations = false;
+
+            outNumLLGLAllocations   = g_numLLGLAllocations;
+            outNumGlobalAllocations = g_numGlobalAllocations;
+
+            commandQueue->WaitIdle();
+        }
+
+};
+
+static std::vector<std::string> SplitList(const std::string& s)
+{
+    std::vector<std::string> list;
+    std::stringstream stream(s);
+    for (std::string item; std::getline(stream, item, ',');)
+    {
+        if (!item.empty())
+            list.push_back(item);
+    }
+    return list;
+}
+
+static bool ParseArgument(const std::string& arg, const char* name, std::string& outValue)
+{
+    const std::string prefix = std::string("--") + name + "=";
+    if (arg.compare(0, prefix.size(), prefix) == 0)
+    {
+        outValue = arg.substr(prefix.size());
+        return true;
+    }
+    return false;
+}
+
+static std::uint32_t ParseCount(const std::string& value)
+{
+    return static_cast<std::uint32_t>(std::max(1, std::stoi(value)));
+}
+
+int main(int argc, char* argv[])
+{
+    TestConfig config;
+
+    // Parse command line arguments
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        std::string value;
+
+        if (ParseArgument(arg, "modules", value))
+            config.modules = SplitList(value);
+        else if (ParseArgument(arg, "warmup", value))
+            config.numWarmupFrames = ParseCount(value);
+        else if (ParseArgument(arg, "frames", value))
+            config.numFrames = ParseCount(value);
+        else
+        {
+            std::cerr << "usage: Test_Allocations [--modules=NAME,...] [--warmup=N] [--frames=N]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Install counting allocator before any render system is loaded
+    LLGL::Allocator::Callbacks callbacks;
+    {
+        callbacks.allocate  = CountingAllocate;
+        callbacks.free      = CountingFree;
+    }
+    LLGL::Allocator::SetCallbacks(callbacks);
+
+    LLGL::Log::SetReportCallbackStd(&(std::cerr));
+
+    // Test all available renderer modules by default
+    if (config.modules.empty())
+        config.modules = LLGL::RenderSystem::FindModules();
+
+    int numFailures = 0;
+
+    for (const auto& module : config.modules)
+    {
+        std::uint64_t numLLGLAllocations    = 0;
+        std::uint64_t numGlobalAllocations  = 0;
+
+        try
+        {
+            AllocationTest test{ config };
+            test.Load(module);
+            test.Run(numLLGLAllocations, numGlobalAllocations);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "skip module " << module << ": " << e.what() << std::endl;
+            continue;
+        }
+
+        const bool passed = (numLLGLAllocations == 0 && numGlobalAllocations == 0);
+        if (!passed)
+            ++numFailures;
+
+        std::cout << (passed ? "PASSED " : "FAILED ") << module << ": "
+            << numLLGLAllocations << " LLGL allocation(s) and " << numGlobalAllocations << " other allocation(s) in " << config.numFrames << " steady-state frames" << std::endl;
+    }
+
+    return (numFailures > 0 ? 1 : 0);
+}
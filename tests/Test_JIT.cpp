@@ -14,6 +14,7 @@
 namespace LLGL
 {
 LLGL_EXPORT void TestJIT1();
+LLGL_EXPORT bool TestJIT2();
 }
 
 
@@ -22,10 +23,15 @@ int main()
     try
     {
         LLGL::TestJIT1();
+
+        /* Compare call traces of native and JIT-compiled execution */
+        if (!LLGL::TestJIT2())
+            return 1;
     }
     catch (const std::exception& e)
     {
         std::cerr << e.what() << std::endl;
+        return 1;
     }
 
     return 0;
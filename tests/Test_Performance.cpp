@@ -109,7 +109,7 @@ class PerformanceTest
             std::cout << std::endl;
         }
 
-        void MeasureTime(const std::string& title, const std::function<void()>& callback)
+        std::uint64_t MeasureTime(const std::string& title, const std::function<void()>& callback)
         {
             // Measure time with query
             commands->Begin();
@@ -132,6 +132,15 @@ class PerformanceTest
                     break;
                 }
             }
+
+            return result;
+        }
+
+        void MeasureThroughput(const std::string& title, std::uint64_t numBytes, const std::function<void()>& callback)
+        {
+            const std::uint64_t duration = MeasureTime(title, callback);
+            if (duration > 0)
+                std::cout << "\tthroughput: " << (static_cast<double>(numBytes) / static_cast<double>(duration)) << "GB/s" << "\n\n";
         }
 
         void TestMIPMapGeneration()
@@ -150,6 +159,46 @@ class PerformanceTest
             }
         }
 
+        void TestTextureBufferCopies(LLGL::Format format, const std::string& formatName)
+        {
+            const LLGL::Extent3D    extent      = { config.textureSize, config.textureSize, 1 };
+            const std::uint64_t     numBytes    = LLGL::GetMemoryFootprint(format, extent.width * extent.height);
+
+            // Create texture and buffer for copy commands
+            LLGL::TextureDescriptor textureDesc;
+            {
+                textureDesc.type        = LLGL::TextureType::Texture2D;
+                textureDesc.bindFlags   = LLGL::BindFlags::Sampled | LLGL::BindFlags::CopySrc | LLGL::BindFlags::CopyDst;
+                textureDesc.format      = format;
+                textureDesc.extent      = extent;
+                textureDesc.mipLevels   = 1;
+            }
+            auto texture = renderer->CreateTexture(textureDesc);
+
+            LLGL::BufferDescriptor bufferDesc;
+            {
+                bufferDesc.size         = numBytes;
+                bufferDesc.bindFlags    = LLGL::BindFlags::CopySrc | LLGL::BindFlags::CopyDst;
+            }
+            auto buffer = renderer->CreateBuffer(bufferDesc);
+
+            const LLGL::TextureRegion region{ LLGL::Offset3D{}, extent };
+
+            MeasureThroughput(
+                ( "Copy buffer into texture with size " + std::to_string(config.textureSize) + " and format " + formatName ),
+                numBytes,
+                [&]() { commands->CopyTextureFromBuffer(*texture, region, *buffer, 0); }
+            );
+            MeasureThroughput(
+                ( "Copy texture with size " + std::to_string(config.textureSize) + " and format " + formatName + " into buffer" ),
+                numBytes,
+                [&]() { commands->CopyBufferFromTexture(*buffer, 0, *texture, region); }
+            );
+
+            renderer->Release(*buffer);
+            renderer->Release(*texture);
+        }
+
     public:
 
         void Load(const std::string& rendererModule, const TestConfig& testConfig)
@@ -201,6 +250,12 @@ class PerformanceTest
             }
             commands->End();
             commandQueue->Submit(*commands);
+
+            // Measure throughput of texture/buffer copies for each format with a specialized copy path
+            TestTextureBufferCopies(LLGL::Format::RGBA8UNorm,   "RGBA8UNorm"  );
+            TestTextureBufferCopies(LLGL::Format::R32Float,     "R32Float"    );
+            TestTextureBufferCopies(LLGL::Format::RGBA16Float,  "RGBA16Float" );
+            TestTextureBufferCopies(LLGL::Format::RGBA32Float,  "RGBA32Float" );
         }
 
 };
@@ -0,0 +1,94 @@
+/*
+ * Test_Serialization.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+
+/*
+Serialization boundary test.
+Loads corrupted capture files with the Null renderer and fails if they are not rejected with std::out_of_range.
+Capture files are read with the internal deserializer, so this covers truncated segment headers and truncated segment payloads.
+*/
+
+static const char* g_tempFilename = "Test_Serialization.tmp";
+
+static void WriteTempFile(const void* data, std::size_t size)
+{
+    std::ofstream file{ g_tempFilename, std::ios::binary | std::ios::trunc };
+    file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+}
+
+// Returns true if loading the temporary capture file throws std::out_of_range.
+static bool ThrowsOutOfRange(LLGL::RenderSystem& renderer)
+{
+    try
+    {
+        LLGL::CaptureReplay replay{ renderer, g_tempFilename };
+    }
+    catch (const std::out_of_range&)
+    {
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "unexpected exception: " << e.what() << std::endl;
+    }
+    return false;
+}
+
+int main()
+{
+    int numFailures = 0;
+
+    try
+    {
+        LLGL::Log::SetReportCallbackStd(&(std::cerr));
+
+        auto renderer = LLGL::RenderSystem::Load("Null");
+
+        auto RunTest = [&](const char* name)
+        {
+            const bool passed = ThrowsOutOfRange(*renderer);
+            if (!passed)
+                ++numFailures;
+            std::cout << (passed ? "PASSED " : "FAILED ") << name << std::endl;
+        };
+
+        // Segment header is cut off after the identifier
+        {
+            const std::uint16_t ident = 1;
+            WriteTempFile(&ident, sizeof(ident));
+            RunTest("truncated segment header");
+        }
+
+        // Segment header is complete, but its payload is cut off
+        {
+            char data[sizeof(std::uint16_t) + sizeof(std::size_t) + 4] = {};
+            const std::uint16_t ident   = 1;
+            const std::size_t   size    = 1024;
+            std::memcpy(data, &ident, sizeof(ident));
+            std::memcpy(data + sizeof(ident), &size, sizeof(size));
+            WriteTempFile(data, sizeof(data));
+            RunTest("truncated segment payload");
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        numFailures = 1;
+    }
+
+    std::remove(g_tempFilename);
+
+    return (numFailures > 0 ? 1 : 0);
+}
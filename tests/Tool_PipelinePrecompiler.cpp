@@ -0,0 +1,735 @@
+/*
+ * Tool_PipelinePrecompiler.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/Misc/Utility.h>
+#include <LLGL/Misc/VertexFormat.h>
+#include <LLGL/Misc/TypeNames.h>
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+/*
+Offline shader and pipeline precompiler.
+Reads a manifest of shaders, pipeline layouts, render passes, and pipeline states, and creates all of them for each renderer module that can be loaded.
+For each module, the following files are written into the output directory, which must exist:
+  - "<module>.pipelinecache": Compressed PipelineCache archive with all PSOs of the manifest (see PipelineCache::Save).
+  - "<module>.shaders/":      Compiled DXBC bytecode of all HLSL shaders (see RenderSystemDescriptor::shaderCacheDirectory), only for Direct3D 11 and Direct3D 12.
+The application loads the archive with PipelineCache::Load and registers its objects with the same descriptors as the manifest, so all PSOs are found in the cache.
+Since pipeline cache archives are specific to the renderer, device, and driver, PipelineCache::Load rejects archives that were created on another machine,
+so this tool is meant to run on the target machine, e.g. at installation time, or in a CI job on the same hardware and driver as the shipped build.
+The DXBC bytecode is independent of the device and can be shipped with the application.
+SPIR-V and Metal libraries cannot be generated with LLGL itself: compile them with glslangValidator and the Xcode "metal" tool respectively
+and reference the binaries with "lang = spirv" in the manifest.
+
+The manifest is a text file with sections that start with "[shader]", "[layout]", "[renderpass]", "[graphics]", "[compute]", or "[swapchain]",
+followed by lines of "key = value" pairs. Lines that start with '#' are comments. File names are relative to the directory of the manifest.
+  - [shader]:     name, type (vertex|tesscontrol|tesseval|geometry|fragment|compute), lang (glsl|spirv|hlsl|metal), file, entry, profile,
+                  defines (NAME=VALUE,...), attribs (NAME:FORMAT,...). Multiple shaders can have the same name for different languages;
+                  each backend uses the first one whose language it supports.
+  - [layout]:     name, bindings (see PipelineLayoutDesc(const char*)).
+  - [renderpass]: name, colors (FORMAT,...), depth (FORMAT), stencil (FORMAT), samples, load (undefined|load|clear), store (undefined|store).
+  - [graphics]:   name, layout, renderpass, vertex, tesscontrol, tesseval, geometry, fragment, topology (e.g. TriangleList), cull (none|front|back),
+                  frontccw, polygon (fill|wireframe|points), blend, depthtest, depthwrite, depthcompare (e.g. less), samples.
+  - [compute]:    name, layout, compute.
+  - [swapchain]:  colorbits, depthbits, stencilbits, samples. These must match the primary swap-chain of the application,
+                  since graphics PSOs without a render pass use its render pass.
+Formats are written as in LLGL::ToString (e.g. "RGBA8UNorm") and boolean values as "true" or "false".
+
+Usage:
+  Tool_PipelinePrecompiler --manifest=FILE --output=DIR [--modules=NAME,...]
+*/
+
+struct PrecompilerConfig
+{
+    std::string                 manifest;
+    std::string                 output;
+    std::vector<std::string>    modules;
+};
+
+// Section of the manifest with all its key-value pairs.
+struct ManifestSection
+{
+    std::string                         kind;
+    int                                 line    = 0;
+    std::map<std::string, std::string>  values;
+
+    bool Has(const std::string& key) const
+    {
+        return (values.find(key) != values.end());
+    }
+
+    std::string Get(const std::string& key, const std::string& defaultValue = "") const
+    {
+        auto it = values.find(key);
+        return (it != values.end() ? it->second : defaultValue);
+    }
+
+    [[noreturn]]
+    void Error(const std::string& msg) const
+    {
+        throw std::runtime_error("manifest line " + std::to_string(line) + " [" + kind + "]: " + msg);
+    }
+};
+
+struct Manifest
+{
+    std::string                     directory;
+    std::vector<ManifestSection>    sections;
+};
+
+static std::string Trim(const std::string& s)
+{
+    const auto begin = s.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos)
+        return "";
+    const auto end = s.find_last_not_of(" \t\r\n");
+    return s.substr(begin, end - begin + 1);
+}
+
+static std::string ToLower(std::string s)
+{
+    std::transform(s.begin(), s.end(), s.begin(), [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+    return s;
+}
+
+static std::vector<std::string> SplitList(const std::string& s, char separator = ',')
+{
+    std::vector<std::string> list;
+    std::stringstream stream(s);
+    for (std::string item; std::getline(stream, item, separator);)
+    {
+        item = Trim(item);
+        if (!item.empty())
+            list.push_back(item);
+    }
+    return list;
+}
+
+static Manifest ReadManifest(const std::string& filename)
+{
+    std::ifstream file(filename);
+    if (!file.good())
+        throw std::runtime_error("failed to open manifest: " + filename);
+
+    Manifest manifest;
+
+    const auto dirEnd = filename.find_last_of("/\\");
+    if (dirEnd != std::string::npos)
+        manifest.directory = filename.substr(0, dirEnd + 1);
+
+    int lineNo = 0;
+    for (std::string line; std::getline(file, line);)
+    {
+        ++lineNo;
+        line = Trim(line);
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        if (line.front() == '[' && line.back() == ']')
+        {
+            ManifestSection section;
+            section.kind = ToLower(Trim(line.substr(1, line.size() - 2)));
+            section.line = lineNo;
+            manifest.sections.push_back(section);
+            continue;
+        }
+
+        const auto assign = line.find('=');
+        if (assign == std::string::npos || manifest.sections.empty())
+            throw std::runtime_error("manifest line " + std::to_string(lineNo) + ": expected section or key-value pair");
+
+        manifest.sections.back().values[ToLower(Trim(line.substr(0, assign)))] = Trim(line.substr(assign + 1));
+    }
+
+    return manifest;
+}
+
+template <typename T>
+static T ParseEnum(const ManifestSection& section, const std::string& key, T defaultValue, std::initializer_list<std::pair<const char*, T>> entries)
+{
+    if (!section.Has(key))
+        return defaultValue;
+
+    const std::string value = ToLower(section.Get(key));
+    for (const auto& entry : entries)
+    {
+        if (value == entry.first)
+            return entry.second;
+    }
+
+    section.Error("unknown value for '" + key + "': " + section.Get(key));
+}
+
+static bool ParseBool(const ManifestSection& section, const std::string& key, bool defaultValue)
+{
+    return ParseEnum<bool>(section, key, defaultValue, { { "true", true }, { "false", false }, { "1", true }, { "0", false } });
+}
+
+static std::uint32_t ParseUInt(const ManifestSection& section, const std::string& key, std::uint32_t defaultValue)
+{
+    if (!section.Has(key))
+        return defaultValue;
+    try
+    {
+        return static_cast<std::uint32_t>(std::stoul(section.Get(key)));
+    }
+    catch (const std::exception&)
+    {
+        section.Error("invalid number for '" + key + "': " + section.Get(key));
+    }
+}
+
+// Parses the format by its name as returned by LLGL::ToString (case insensitive).
+static LLGL::Format ParseFormat(const ManifestSection& section, const std::string& value)
+{
+    const std::string name = ToLower(value);
+    for (int i = static_cast<int>(LLGL::Format::Undefined); i <= static_cast<int>(LLGL::Format::BC5SNorm); ++i)
+    {
+        const auto format = static_cast<LLGL::Format>(i);
+        if (const char* formatName = LLGL::ToString(format))
+        {
+            if (name == ToLower(formatName))
+                return format;
+        }
+    }
+    section.Error("unknown format: " + value);
+}
+
+// Shader entry of the manifest; the strings must outlive the descriptor, since it only refers to them.
+struct ShaderEntry
+{
+    const ManifestSection*                              section     = nullptr;
+    std::string                                         name;
+    std::string                                         path;
+    std::string                                         entryPoint;
+    std::string                                         profile;
+    std::vector<std::pair<std::string, std::string>>    defineValues;
+    std::vector<LLGL::ShaderMacro>                      defines;
+    LLGL::VertexFormat                                  vertexFormat;
+    LLGL::ShaderDescriptor                              desc;
+    LLGL::Shader*                                       shader      = nullptr;
+};
+
+class PipelinePrecompiler
+{
+
+    private:
+
+        const PrecompilerConfig&                        config;
+        const Manifest&                                 manifest;
+
+        std::string                                     moduleName;
+        std::string                                     shaderCacheDirectory;
+        LLGL::RenderSystemPtr                           renderer;
+        LLGL::SwapChain*                                swapChain           = nullptr;
+        std::unique_ptr<LLGL::PipelineCache>            cache;
+
+        std::vector<std::unique_ptr<ShaderEntry>>       shaders;
+        std::map<std::string, LLGL::PipelineLayout*>    pipelineLayouts;
+        std::map<std::string, LLGL::RenderPass*>        renderPasses;
+
+        std::uint32_t                                   numPipelines        = 0;
+        std::uint32_t                                   numFailures         = 0;
+
+    private:
+
+        LLGL::ShadingLanguage ParseLanguage(const ManifestSection& section) const
+        {
+            if (!section.Has("lang"))
+                section.Error("missing shader language");
+            return ParseEnum<LLGL::ShadingLanguage>(
+                section, "lang", LLGL::ShadingLanguage::GLSL,
+                {
+                    { "glsl",  LLGL::ShadingLanguage::GLSL  },
+                    { "essl",  LLGL::ShadingLanguage::ESSL  },
+                    { "spirv", LLGL::ShadingLanguage::SPIRV },
+                    { "hlsl",  LLGL::ShadingLanguage::HLSL  },
+                    { "metal", LLGL::ShadingLanguage::Metal },
+                }
+            );
+        }
+
+        bool Supported(LLGL::ShadingLanguage language) const
+        {
+            const auto& languages = renderer->GetRenderingCaps().shadingLanguages;
+            return (std::find(languages.begin(), languages.end(), language) != languages.end());
+        }
+
+        ShaderEntry* FindShader(const std::string& name) const
+        {
+            for (const auto& entry : shaders)
+            {
+                if (entry->name == name)
+                    return entry.get();
+            }
+            return nullptr;
+        }
+
+        // Returns the shader that is referenced by the specified key or null if the key is not specified.
+        LLGL::Shader* GetShader(const ManifestSection& section, const std::string& key, bool& outMissing) const
+        {
+            if (!section.Has(key))
+                return nullptr;
+            if (auto entry = FindShader(section.Get(key)))
+                return entry->shader;
+            outMissing = true;
+            return nullptr;
+        }
+
+        template <typename T>
+        T* FindObject(const ManifestSection& section, const std::string& key, const std::map<std::string, T*>& objects) const
+        {
+            if (!section.Has(key))
+                return nullptr;
+            auto it = objects.find(section.Get(key));
+            if (it == objects.end())
+                section.Error("unknown " + key + ": " + section.Get(key));
+            return it->second;
+        }
+
+        // Selects the first shader of each name whose language is supported by the renderer.
+        void SelectShader(const ManifestSection& section)
+        {
+            const auto name = section.Get("name");
+            if (name.empty())
+                section.Error("missing shader name");
+            if (FindShader(name) != nullptr || !Supported(ParseLanguage(section)))
+                return;
+
+            std::unique_ptr<ShaderEntry> entry{ new ShaderEntry{} };
+            {
+                entry->section      = &section;
+                entry->name         = name;
+                entry->path         = manifest.directory + section.Get("file");
+                entry->entryPoint   = section.Get("entry");
+                entry->profile      = section.Get("profile");
+            }
+
+            if (!std::ifstream(entry->path).good())
+            {
+                std::cerr << "  skip shader " << name << " (missing file: " << entry->path << ")" << std::endl;
+                return;
+            }
+
+            const auto type = ParseEnum<LLGL::ShaderType>(
+                section, "type", LLGL::ShaderType::Undefined,
+                {
+                    { "vertex",      LLGL::ShaderType::Vertex         },
+                    { "tesscontrol", LLGL::ShaderType::TessControl    },
+                    { "tesseval",    LLGL::ShaderType::TessEvaluation },
+                    { "geometry",    LLGL::ShaderType::Geometry       },
+                    { "fragment",    LLGL::ShaderType::Fragment       },
+                    { "compute",     LLGL::ShaderType::Compute        },
+                }
+            );
+            if (type == LLGL::ShaderType::Undefined)
+                section.Error("missing shader type");
+
+            entry->desc = LLGL::ShaderDescFromFile(
+                type,
+                entry->path.c_str(),
+                (entry->entryPoint.empty() ? nullptr : entry->entryPoint.c_str()),
+                (entry->profile.empty() ? nullptr : entry->profile.c_str())
+            );
+
+            for (const auto& attrib : SplitList(section.Get("attribs")))
+            {
+                const auto colon = attrib.find(':');
+                if (colon == std::string::npos)
+                    section.Error("expected NAME:FORMAT for vertex attribute: " + attrib);
+                entry->vertexFormat.AppendAttribute({ attrib.substr(0, colon).c_str(), ParseFormat(section, attrib.substr(colon + 1)) });
+            }
+            entry->desc.vertex.inputAttribs = entry->vertexFormat.attributes;
+
+            for (const auto& define : SplitList(section.Get("defines")))
+            {
+                const auto assign = define.find('=');
+                if (assign != std::string::npos)
+                    entry->defineValues.emplace_back(define.substr(0, assign), define.substr(assign + 1));
+                else
+                    entry->defineValues.emplace_back(define, "");
+            }
+
+            if (!entry->defineValues.empty())
+            {
+                for (const auto& define : entry->defineValues)
+                    entry->defines.push_back({ define.first.c_str(), define.second.c_str() });
+                entry->defines.push_back({ nullptr, nullptr });
+                entry->desc.defines = entry->defines.data();
+            }
+
+            shaders.push_back(std::move(entry));
+        }
+
+        // Compiles all selected shaders at once, which compiles HLSL in parallel (see RenderSystem::CreateShaders).
+        void CreateShaders()
+        {
+            std::vector<LLGL::ShaderDescriptor> shaderDescs;
+            shaderDescs.reserve(shaders.size());
+            for (const auto& entry : shaders)
+                shaderDescs.push_back(entry->desc);
+
+            std::vector<LLGL::Shader*> outShaders(shaders.size(), nullptr);
+            renderer->CreateShaders(static_cast<std::uint32_t>(shaderDescs.size()), shaderDescs.data(), outShaders.data());
+
+            for (std::size_t i = 0; i < shaders.size(); ++i)
+            {
+                auto& entry = *shaders[i];
+                entry.shader = outShaders[i];
+                if (auto report = entry.shader->GetReport())
+                {
+                    if (report->HasErrors())
+                        entry.section->Error("failed to compile shader " + entry.name + ":\n" + report->GetText());
+                }
+                cache->RegisterShader(*entry.shader, entry.desc);
+            }
+        }
+
+        void CreatePipelineLayout(const ManifestSection& section)
+        {
+            const auto layoutDesc = LLGL::PipelineLayoutDesc(section.Get("bindings").c_str());
+            auto pipelineLayout = renderer->CreatePipelineLayout(layoutDesc);
+            cache->RegisterPipelineLayout(*pipelineLayout, layoutDesc);
+            pipelineLayouts[section.Get("name")] = pipelineLayout;
+        }
+
+        void CreateRenderPass(const ManifestSection& section)
+        {
+            const auto loadOp = ParseEnum<LLGL::AttachmentLoadOp>(
+                section, "load", LLGL::AttachmentLoadOp::Load,
+                {
+                    { "undefined", LLGL::AttachmentLoadOp::Undefined },
+                    { "load",      LLGL::AttachmentLoadOp::Load      },
+                    { "clear",     LLGL::AttachmentLoadOp::Clear     },
+                }
+            );
+            const auto storeOp = ParseEnum<LLGL::AttachmentStoreOp>(
+                section, "store", LLGL::AttachmentStoreOp::Store,
+                {
+                    { "undefined", LLGL::AttachmentStoreOp::Undefined },
+                    { "store",     LLGL::AttachmentStoreOp::Store     },
+                }
+            );
+
+            LLGL::RenderPassDescriptor renderPassDesc;
+            {
+                const auto colors = SplitList(section.Get("colors"));
+                if (colors.size() > LLGL_MAX_NUM_COLOR_ATTACHMENTS)
+                    section.Error("too many color attachments");
+                for (std::size_t i = 0; i < colors.size(); ++i)
+                    renderPassDesc.colorAttachments[i] = LLGL::AttachmentFormatDescriptor{ ParseFormat(section, colors[i]), loadOp, storeOp };
+                if (section.Has("depth"))
+                    renderPassDesc.depthAttachment = LLGL::AttachmentFormatDescriptor{ ParseFormat(section, section.Get("depth")), loadOp, storeOp };
+                if (section.Has("stencil"))
+                    renderPassDesc.stencilAttachment = LLGL::AttachmentFormatDescriptor{ ParseFormat(section, section.Get("stencil")), loadOp, storeOp };
+                renderPassDesc.samples = ParseUInt(section, "samples", 1);
+            }
+            auto renderPass = renderer->CreateRenderPass(renderPassDesc);
+            cache->RegisterRenderPass(*renderPass, renderPassDesc);
+            renderPasses[section.Get("name")] = renderPass;
+        }
+
+        LLGL::GraphicsPipelineDescriptor GetGraphicsPipelineDesc(const ManifestSection& section, bool& outMissing) const
+        {
+            LLGL::GraphicsPipelineDescriptor psoDesc;
+            {
+                psoDesc.pipelineLayout          = FindObject(section, "layout", pipelineLayouts);
+                psoDesc.renderPass              = FindObject(section, "renderpass", renderPasses);
+                psoDesc.vertexShader            = GetShader(section, "vertex", outMissing);
+                psoDesc.tessControlShader       = GetShader(section, "tesscontrol", outMissing);
+                psoDesc.tessEvaluationShader    = GetShader(section, "tesseval", outMissing);
+                psoDesc.geometryShader          = GetShader(section, "geometry", outMissing);
+                psoDesc.fragmentShader          = GetShader(section, "fragment", outMissing);
+                psoDesc.primitiveTopology       = ParseEnum<LLGL::PrimitiveTopology>(
+                    section, "topology", LLGL::PrimitiveTopology::TriangleList,
+                    {
+                        { "pointlist",     LLGL::PrimitiveTopology::PointList     },
+                        { "linelist",      LLGL::PrimitiveTopology::LineList      },
+                        { "linestrip",     LLGL::PrimitiveTopology::LineStrip     },
+                        { "trianglelist",  LLGL::PrimitiveTopology::TriangleList  },
+                        { "trianglestrip", LLGL::PrimitiveTopology::TriangleStrip },
+                    }
+                );
+                psoDesc.rasterizer.cullMode     = ParseEnum<LLGL::CullMode>(
+                    section, "cull", LLGL::CullMode::Disabled,
+                    {
+                        { "none",  LLGL::CullMode::Disabled },
+                        { "front", LLGL::CullMode::Front    },
+                        { "back",  LLGL::CullMode::Back     },
+                    }
+                );
+                psoDesc.rasterizer.polygonMode  = ParseEnum<LLGL::PolygonMode>(
+                    section, "polygon", LLGL::PolygonMode::Fill,
+                    {
+                        { "fill",      LLGL::PolygonMode::Fill      },
+                        { "wireframe", LLGL::PolygonMode::Wireframe },
+                        { "points",    LLGL::PolygonMode::Points    },
+                    }
+                );
+                psoDesc.rasterizer.frontCCW             = ParseBool(section, "frontccw", false);
+                psoDesc.rasterizer.multiSampleEnabled   = (ParseUInt(section, "samples", 1) > 1);
+                psoDesc.blend.targets[0].blendEnabled   = ParseBool(section, "blend", false);
+                psoDesc.depth.testEnabled               = ParseBool(section, "depthtest", false);
+                psoDesc.depth.writeEnabled              = ParseBool(section, "depthwrite", psoDesc.depth.testEnabled);
+                psoDesc.depth.compareOp                 = ParseEnum<LLGL::CompareOp>(
+                    section, "depthcompare", LLGL::CompareOp::Less,
+                    {
+                        { "never",        LLGL::CompareOp::NeverPass    },
+                        { "less",         LLGL::CompareOp::Less         },
+                        { "equal",        LLGL::CompareOp::Equal        },
+                        { "lessequal",    LLGL::CompareOp::LessEqual    },
+                        { "greater",      LLGL::CompareOp::Greater      },
+                        { "notequal",     LLGL::CompareOp::NotEqual     },
+                        { "greaterequal", LLGL::CompareOp::GreaterEqual },
+                        { "always",       LLGL::CompareOp::AlwaysPass   },
+                    }
+                );
+            }
+            return psoDesc;
+        }
+
+        LLGL::ComputePipelineDescriptor GetComputePipelineDesc(const ManifestSection& section, bool& outMissing) const
+        {
+            LLGL::ComputePipelineDescriptor psoDesc;
+            {
+                psoDesc.pipelineLayout  = FindObject(section, "layout", pipelineLayouts);
+                psoDesc.computeShader   = GetShader(section, "compute", outMissing);
+            }
+            return psoDesc;
+        }
+
+        // Creates the PSO of the specified section with the pipeline cache and releases it right away, since only the cache entry is needed.
+        void CreatePipelineState(const ManifestSection& section)
+        {
+            const auto name = section.Get("name");
+
+            bool missingShaders = false;
+            LLGL::PipelineState* pso = nullptr;
+
+            if (section.kind == "graphics")
+            {
+                const auto psoDesc = GetGraphicsPipelineDesc(section, missingShaders);
+                if (!missingShaders)
+                    pso = cache->CreatePipelineState(psoDesc);
+            }
+            else
+            {
+                const auto psoDesc = GetComputePipelineDesc(section, missingShaders);
+                if (!missingShaders)
+                    pso = cache->CreatePipelineState(psoDesc);
+            }
+
+            if (missingShaders)
+            {
+                std::cerr << "  skip " << section.kind << " pipeline " << name << " (no shader for this renderer)" << std::endl;
+                return;
+            }
+
+            ++numPipelines;
+
+            if (pso == nullptr)
+            {
+                std::cerr << "  failed to create " << section.kind << " pipeline " << name << std::endl;
+                ++numFailures;
+                return;
+            }
+
+            if (auto report = pso->GetReport())
+            {
+                if (report->HasErrors())
+                {
+                    std::cerr << "  failed to create " << section.kind << " pipeline " << name << ":\n" << report->GetText() << std::endl;
+                    ++numFailures;
+                }
+            }
+
+            renderer->Release(*pso);
+        }
+
+        void WriteArchive()
+        {
+            const std::string filename = config.output + "/" + moduleName + ".pipelinecache";
+
+            auto archive = cache->Save(LLGL::PipelineCacheSaveFlags::Compressed);
+            if (!archive)
+                throw std::runtime_error("failed to save pipeline cache archive");
+
+            std::ofstream file(filename, std::ios::binary);
+            file.write(static_cast<const char*>(archive->GetData()), static_cast<std::streamsize>(archive->GetSize()));
+            if (!file.good())
+                throw std::runtime_error("failed to write pipeline cache archive: " + filename);
+
+            std::cerr << "  wrote " << filename << " (" << archive->GetSize() << " bytes)" << std::endl;
+        }
+
+    public:
+
+        PipelinePrecompiler(const PrecompilerConfig& config, const Manifest& manifest) :
+            config   { config   },
+            manifest { manifest }
+        {
+        }
+
+        ~PipelinePrecompiler()
+        {
+            // Release pipeline cache before its render system
+            cache.reset();
+        }
+
+        void Load(const std::string& rendererModule)
+        {
+            moduleName = rendererModule;
+            shaderCacheDirectory = config.output + "/" + moduleName + ".shaders";
+
+            LLGL::RenderSystemDescriptor rendererDesc{ rendererModule };
+            {
+                rendererDesc.shaderCacheDirectory = shaderCacheDirectory.c_str();
+            }
+            renderer = LLGL::RenderSystem::Load(rendererDesc);
+
+            // Create small swap-chain, since some renderers (e.g. OpenGL) require a context and graphics PSOs without a render pass use its render pass
+            LLGL::SwapChainDescriptor swapChainDesc;
+            {
+                swapChainDesc.resolution = { 256, 256 };
+                for (const auto& section : manifest.sections)
+                {
+                    if (section.kind == "swapchain")
+                    {
+                        swapChainDesc.colorBits     = static_cast<int>(ParseUInt(section, "colorbits", 32));
+                        swapChainDesc.depthBits     = static_cast<int>(ParseUInt(section, "depthbits", 24));
+                        swapChainDesc.stencilBits   = static_cast<int>(ParseUInt(section, "stencilbits", 8));
+                        swapChainDesc.samples       = ParseUInt(section, "samples", 1);
+                    }
+                }
+            }
+            swapChain = renderer->CreateSwapChain(swapChainDesc);
+
+            cache = std::unique_ptr<LLGL::PipelineCache>{ new LLGL::PipelineCache{ *renderer } };
+        }
+
+        // Creates all objects of the manifest and returns the number of PSOs that failed.
+        std::uint32_t Run()
+        {
+            std::cerr << "precompile pipelines for " << moduleName << " (" << renderer->GetRendererInfo().deviceName << ") ..." << std::endl;
+
+            for (const auto& section : manifest.sections)
+            {
+                if (section.kind == "shader")
+                    SelectShader(section);
+                else if (section.kind == "layout")
+                    CreatePipelineLayout(section);
+                else if (section.kind == "renderpass")
+                    CreateRenderPass(section);
+                else if (section.kind != "graphics" && section.kind != "compute" && section.kind != "swapchain")
+                    section.Error("unknown section");
+            }
+
+            CreateShaders();
+
+            for (const auto& section : manifest.sections)
+            {
+                if (section.kind == "graphics" || section.kind == "compute")
+                    CreatePipelineState(section);
+            }
+
+            std::cerr << "  created " << (numPipelines - numFailures) << " of " << numPipelines << " pipelines" << std::endl;
+
+            WriteArchive();
+
+            if (renderer->GetRendererID() == LLGL::RendererID::Direct3D11 || renderer->GetRendererID() == LLGL::RendererID::Direct3D12)
+                std::cerr << "  wrote shader bytecode to " << shaderCacheDirectory << std::endl;
+
+            return numFailures;
+        }
+
+};
+
+static bool ParseArgument(const std::string& arg, const char* name, std::string& outValue)
+{
+    const std::string prefix = std::string("--") + name + "=";
+    if (arg.compare(0, prefix.size(), prefix) == 0)
+    {
+        outValue = arg.substr(prefix.size());
+        return true;
+    }
+    return false;
+}
+
+int main(int argc, char* argv[])
+{
+    PrecompilerConfig config;
+
+    // Parse command line arguments
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        std::string value;
+
+        if (ParseArgument(arg, "manifest", value))
+            config.manifest = value;
+        else if (ParseArgument(arg, "output", value))
+            config.output = value;
+        else if (ParseArgument(arg, "modules", value))
+            config.modules = SplitList(value);
+        else
+        {
+            config.manifest.clear();
+            break;
+        }
+    }
+
+    if (config.manifest.empty() || config.output.empty())
+    {
+        std::cerr << "usage: Tool_PipelinePrecompiler --manifest=FILE --output=DIR [--modules=NAME,...]" << std::endl;
+        return 1;
+    }
+
+    // Precompile for all available renderer modules by default
+    if (config.modules.empty())
+        config.modules = LLGL::RenderSystem::FindModules();
+
+    LLGL::Log::SetReportCallbackStd(&(std::cerr));
+
+    int exitCode = 0;
+
+    try
+    {
+        const Manifest manifest = ReadManifest(config.manifest);
+
+        for (const auto& module : config.modules)
+        {
+            try
+            {
+                PipelinePrecompiler precompiler{ config, manifest };
+                precompiler.Load(module);
+                if (precompiler.Run() > 0)
+                    exitCode = 1;
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "skip module " << module << ": " << e.what() << std::endl;
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return exitCode;
+}
@@ -7,6 +7,7 @@
 
 #include "CsCommandBuffer.h"
 #include "CsHelper.h"
+#include "CsCommandListExecutor.h"
 #include <algorithm>
 
 
@@ -27,6 +28,21 @@ static void Convert(LLGL::ColorRGBAf& dst, ColorRGBA<float>^ src)
 }
 
 
+/*
+ * Zero-copy conversions
+ */
+
+/*
+The value types ViewportStruct, ScissorStruct, ClearValueStruct, and AttachmentClearStruct have the same memory layout as their native counterparts,
+so pinned managed arrays of these types can be reinterpreted as native arrays without intermediate copies.
+*/
+template <typename TNative, typename TManaged>
+static const TNative* ReinterpretPinned(const TManaged* managedArray)
+{
+    return reinterpret_cast<const TNative*>(managedArray);
+}
+
+
 /*
  * CommandBuffer class
  */
@@ -56,6 +72,11 @@ void CommandBuffer::End()
     native_->End();
 }
 
+void CommandBuffer::Execute(CommandList^ commandList)
+{
+    ExecuteNativeCommandList(*native_, commandList->NativeData, static_cast<std::size_t>(commandList->Size));
+}
+
 generic <typename T>
 void CommandBuffer::UpdateBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, array<T>^ data)
 {
@@ -63,6 +84,20 @@ void CommandBuffer::UpdateBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, ar
     native_->UpdateBuffer(*(dstBuffer->NativeSub), dstOffset, dataRef, static_cast<std::uint16_t>(data->Length * sizeof(T)));
 }
 
+generic <typename T> where T : value class
+void CommandBuffer::UpdateBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, array<T>^ data, int startIndex, int count)
+{
+    if (count <= 0 || startIndex < 0 || startIndex + count > data->Length)
+        return;
+    pin_ptr<T> dataRef = &data[startIndex];
+    native_->UpdateBuffer(*(dstBuffer->NativeSub), dstOffset, dataRef, static_cast<std::uint16_t>(count * sizeof(T)));
+}
+
+void CommandBuffer::UpdateBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, IntPtr data, System::UInt16 dataSize)
+{
+    native_->UpdateBuffer(*(dstBuffer->NativeSub), dstOffset, data.ToPointer(), dataSize);
+}
+
 void CommandBuffer::CopyBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, Buffer^ srcBuffer, System::UInt64 srcOffset, System::UInt64 size)
 {
     native_->CopyBuffer(*(dstBuffer->NativeSub), dstOffset, *(srcBuffer->NativeSub), srcOffset, size);
@@ -103,6 +138,25 @@ void CommandBuffer::SetViewports(array<Viewport^>^ viewports)
     native_->SetViewports(numViewports, nativeViewports);
 }
 
+void CommandBuffer::SetViewport(ViewportStruct viewport)
+{
+    pin_ptr<ViewportStruct> viewportRef = &viewport;
+    native_->SetViewport(*ReinterpretPinned<LLGL::Viewport, ViewportStruct>(viewportRef));
+}
+
+void CommandBuffer::SetViewports(array<ViewportStruct>^ viewports)
+{
+    if (viewports->Length == 0)
+        return;
+    pin_ptr<ViewportStruct> viewportsRef = &viewports[0];
+    native_->SetViewports(static_cast<std::uint32_t>(viewports->Length), ReinterpretPinned<LLGL::Viewport, ViewportStruct>(viewportsRef));
+}
+
+void CommandBuffer::SetViewports(IntPtr viewports, unsigned int numViewports)
+{
+    native_->SetViewports(numViewports, static_cast<const LLGL::Viewport*>(viewports.ToPointer()));
+}
+
 static void Convert(LLGL::Scissor& dst, Scissor^ src)
 {
     dst.x       = src->X;
@@ -129,6 +183,25 @@ void CommandBuffer::SetScissors(array<Scissor^>^ scissors)
     native_->SetScissors(numScissors, nativeScissors);
 }
 
+void CommandBuffer::SetScissor(ScissorStruct scissor)
+{
+    pin_ptr<ScissorStruct> scissorRef = &scissor;
+    native_->SetScissor(*ReinterpretPinned<LLGL::Scissor, ScissorStruct>(scissorRef));
+}
+
+void CommandBuffer::SetScissors(array<ScissorStruct>^ scissors)
+{
+    if (scissors->Length == 0)
+        return;
+    pin_ptr<ScissorStruct> scissorsRef = &scissors[0];
+    native_->SetScissors(static_cast<std::uint32_t>(scissors->Length), ReinterpretPinned<LLGL::Scissor, ScissorStruct>(scissorsRef));
+}
+
+void CommandBuffer::SetScissors(IntPtr scissors, unsigned int numScissors)
+{
+    native_->SetScissors(numScissors, static_cast<const LLGL::Scissor*>(scissors.ToPointer()));
+}
+
 /* ----- Input Assembly ------ */
 
 static LLGL::Buffer* GetNative(Buffer^ buffer)
@@ -206,7 +279,7 @@ void CommandBuffer::BeginRenderPass(RenderTarget^ renderTarget, RenderPass^ rend
 {
     LLGL::ClearValue nativeClearValues[10];
 
-    std::uint32_t numClearValues = static_cast<std::uint32_t>(std::max(clearValues->Length, 10));
+    std::uint32_t numClearValues = static_cast<std::uint32_t>(std::min(clearValues->Length, 10));
     for (std::uint32_t i = 0; i < numClearValues; ++i)
         Convert(nativeClearValues[i], clearValues[i]);
 
@@ -218,6 +291,22 @@ void CommandBuffer::BeginRenderPass(RenderTarget^ renderTarget, RenderPass^ rend
     );
 }
 
+void CommandBuffer::BeginRenderPass(RenderTarget^ renderTarget, RenderPass^ renderPass, array<ClearValueStruct>^ clearValues)
+{
+    if (clearValues->Length == 0)
+    {
+        BeginRenderPass(renderTarget, renderPass);
+        return;
+    }
+    pin_ptr<ClearValueStruct> clearValuesRef = &clearValues[0];
+    native_->BeginRenderPass(
+        *renderTarget->Native,
+        (renderPass != nullptr ? renderPass->Native : nullptr),
+        static_cast<std::uint32_t>(clearValues->Length),
+        ReinterpretPinned<LLGL::ClearValue, ClearValueStruct>(clearValuesRef)
+    );
+}
+
 void CommandBuffer::EndRenderPass()
 {
     native_->EndRenderPass();
@@ -234,6 +323,12 @@ void CommandBuffer::Clear(ClearFlags flags, ClearValue^ clearValue)
     native_->Clear(static_cast<long>(flags), nativeClearValue);
 }
 
+void CommandBuffer::Clear(ClearFlags flags, ClearValueStruct clearValue)
+{
+    pin_ptr<ClearValueStruct> clearValueRef = &clearValue;
+    native_->Clear(static_cast<long>(flags), *ReinterpretPinned<LLGL::ClearValue, ClearValueStruct>(clearValueRef));
+}
+
 static void Convert(LLGL::AttachmentClear& dst, AttachmentClear^ src)
 {
     dst.flags           = static_cast<long>(src->Flags);
@@ -252,6 +347,19 @@ void CommandBuffer::ClearAttachments(array<AttachmentClear^>^ attachments)
     native_->ClearAttachments(numAttachments, nativeAttachments);
 }
 
+void CommandBuffer::ClearAttachments(array<AttachmentClearStruct>^ attachments)
+{
+    if (attachments->Length == 0)
+        return;
+    pin_ptr<AttachmentClearStruct> attachmentsRef = &attachments[0];
+    native_->ClearAttachments(static_cast<std::uint32_t>(attachments->Length), ReinterpretPinned<LLGL::AttachmentClear, AttachmentClearStruct>(attachmentsRef));
+}
+
+void CommandBuffer::ClearAttachments(IntPtr attachments, unsigned int numAttachments)
+{
+    native_->ClearAttachments(numAttachments, static_cast<const LLGL::AttachmentClear*>(attachments.ToPointer()));
+}
+
 /* ----- Pipeline States ----- */
 
 void CommandBuffer::SetPipelineState(PipelineState^ pipelineState)
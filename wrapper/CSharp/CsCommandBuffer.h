@@ -15,6 +15,7 @@
 #include "CsPipelineStateFlags.h"
 #include "CsRenderTarget.h"
 #include "CsColor.h"
+#include "CsCommandList.h"
 
 #using <System.dll>
 #using <System.Core.dll>
@@ -50,9 +51,17 @@ public ref class CommandBuffer
         void Begin();
         void End();
 
+        /// <summary>Decodes the specified command list and encodes all its commands into this command buffer with a single native call.</summary>
+        void Execute(CommandList^ commandList);
+
         generic <typename T>
         void UpdateBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, array<T>^ data);
 
+        generic <typename T> where T : value class
+        void UpdateBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, array<T>^ data, int startIndex, int count);
+
+        void UpdateBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, IntPtr data, System::UInt16 dataSize);
+
         void CopyBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, Buffer^ srcBuffer, System::UInt64 srcOffset, System::UInt64 size);
 
         void FillBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, unsigned int value, System::UInt64 fillSize /*= Constants::wholeSize*/);
@@ -65,10 +74,16 @@ public ref class CommandBuffer
         /* ----- Viewport and Scissor ----- */
 
         void SetViewport(Viewport^ viewport);
+        void SetViewport(ViewportStruct viewport);
         void SetViewports(array<Viewport^>^ viewports);
+        void SetViewports(array<ViewportStruct>^ viewports);
+        void SetViewports(IntPtr viewports, unsigned int numViewports);
 
         void SetScissor(Scissor^ scissor);
+        void SetScissor(ScissorStruct scissor);
         void SetScissors(array<Scissor^>^ scissors);
+        void SetScissors(array<ScissorStruct>^ scissors);
+        void SetScissors(IntPtr scissors, unsigned int numScissors);
 
         /* ----- Input Assembly ------ */
 
@@ -87,11 +102,15 @@ public ref class CommandBuffer
         void BeginRenderPass(RenderTarget^ renderTarget);
         void BeginRenderPass(RenderTarget^ renderTarget, RenderPass^ renderPass);
         void BeginRenderPass(RenderTarget^ renderTarget, RenderPass^ renderPass, array<ClearValue^>^ clearValues);
+        void BeginRenderPass(RenderTarget^ renderTarget, RenderPass^ renderPass, array<ClearValueStruct>^ clearValues);
 
         void EndRenderPass();
 
         void Clear(ClearFlags flags, ClearValue^ clearValue);
+        void Clear(ClearFlags flags, ClearValueStruct clearValue);
         void ClearAttachments(array<AttachmentClear^>^ attachments);
+        void ClearAttachments(array<AttachmentClearStruct>^ attachments);
+        void ClearAttachments(IntPtr attachments, unsigned int numAttachments);
 
         /* ----- Pipeline States ----- */
 
@@ -70,6 +70,50 @@ AttachmentClear::AttachmentClear(float depth, unsigned int stencil)
 }
 
 
+/*
+ * ClearValueStruct class
+ */
+
+ClearValueStruct::ClearValueStruct(float r, float g, float b, float a)
+{
+    R       = r;
+    G       = g;
+    B       = b;
+    A       = a;
+    Depth   = 1.0f;
+    Stencil = 0;
+}
+
+ClearValueStruct::ClearValueStruct(float r, float g, float b, float a, float depth, unsigned int stencil)
+{
+    R       = r;
+    G       = g;
+    B       = b;
+    A       = a;
+    Depth   = depth;
+    Stencil = stencil;
+}
+
+
+/*
+ * AttachmentClearStruct class
+ */
+
+AttachmentClearStruct::AttachmentClearStruct(float r, float g, float b, float a, unsigned int colorAttachment)
+{
+    Flags           = ClearFlags::Color;
+    ColorAttachment = colorAttachment;
+    ClearValue      = ClearValueStruct(r, g, b, a);
+}
+
+AttachmentClearStruct::AttachmentClearStruct(float depth, unsigned int stencil)
+{
+    Flags           = ClearFlags::DepthStencil;
+    ColorAttachment = 0;
+    ClearValue      = ClearValueStruct(0.0f, 0.0f, 0.0f, 0.0f, depth, stencil);
+}
+
+
 } // /namespace SharpLLGL
 
 
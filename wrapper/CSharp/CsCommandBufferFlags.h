@@ -82,6 +82,48 @@ public ref class AttachmentClear
 
 };
 
+/*
+Blittable value type with the same memory layout as LLGL::ClearValue.
+Arrays of this type are passed to the native command buffer without any intermediate copies.
+Note that value types are zero-initialized, so Depth must be set explicitly when the depth buffer is to be cleared.
+*/
+[StructLayout(LayoutKind::Sequential)]
+public value class ClearValueStruct
+{
+
+    public:
+
+        ClearValueStruct(float r, float g, float b, float a);
+        ClearValueStruct(float r, float g, float b, float a, float depth, unsigned int stencil);
+
+        float           R;
+        float           G;
+        float           B;
+        float           A;
+        float           Depth;
+        unsigned int    Stencil;
+
+};
+
+/*
+Blittable value type with the same memory layout as LLGL::AttachmentClear.
+Arrays of this type are passed to the native command buffer without any intermediate copies.
+*/
+[StructLayout(LayoutKind::Sequential)]
+public value class AttachmentClearStruct
+{
+
+    public:
+
+        AttachmentClearStruct(float r, float g, float b, float a, unsigned int colorAttachment);
+        AttachmentClearStruct(float depth, unsigned int stencil);
+
+        ClearFlags          Flags;
+        unsigned int        ColorAttachment;
+        ClearValueStruct    ClearValue;
+
+};
+
 
 } // /namespace SharpLLGL
 
@@ -0,0 +1,448 @@
+/*
+ * CsCommandList.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "CsCommandList.h"
+#include "CsHelper.h"
+#include <algorithm>
+#include <cstring>
+
+
+namespace SharpLLGL
+{
+
+
+/*
+ * CommandList class
+ */
+
+static const int g_defaultCommandListCapacity = 4096;
+
+CommandList::CommandList() :
+    CommandList { g_defaultCommandListCapacity }
+{
+}
+
+CommandList::CommandList(int initialCapacity)
+{
+    Reserve(std::max(initialCapacity, 64));
+}
+
+CommandList::~CommandList()
+{
+    this->!CommandList();
+}
+
+CommandList::!CommandList()
+{
+    Release();
+}
+
+void CommandList::Reset()
+{
+    size_           = 0;
+    numCommands_    = 0;
+}
+
+int CommandList::Size::get()
+{
+    return size_;
+}
+
+int CommandList::NumCommands::get()
+{
+    return numCommands_;
+}
+
+const std::uint8_t* CommandList::NativeData::get()
+{
+    return data_;
+}
+
+/* ----- Encoding ----- */
+
+generic <typename T> where T : value class
+void CommandList::UpdateBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, array<T>^ data)
+{
+    if (data->Length == 0)
+        return;
+    pin_ptr<T> dataRef = &data[0];
+    UpdateBuffer(dstBuffer, dstOffset, IntPtr(dataRef), static_cast<System::UInt16>(data->Length * sizeof(T)));
+}
+
+void CommandList::UpdateBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, IntPtr data, System::UInt16 dataSize)
+{
+    auto cmd = AllocCommand<CommandListUpdateBuffer>(CommandListOpcodeUpdateBuffer, dataSize);
+    {
+        cmd->buffer = dstBuffer->NativeSub;
+        cmd->offset = dstOffset;
+        cmd->size   = dataSize;
+        ::memcpy(cmd + 1, data.ToPointer(), dataSize);
+    }
+}
+
+void CommandList::CopyBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, Buffer^ srcBuffer, System::UInt64 srcOffset, System::UInt64 size)
+{
+    auto cmd = AllocCommand<CommandListCopyBuffer>(CommandListOpcodeCopyBuffer);
+    {
+        cmd->dstBuffer  = dstBuffer->NativeSub;
+        cmd->dstOffset  = dstOffset;
+        cmd->srcBuffer  = srcBuffer->NativeSub;
+        cmd->srcOffset  = srcOffset;
+        cmd->size       = size;
+    }
+}
+
+void CommandList::FillBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, unsigned int value, System::UInt64 fillSize)
+{
+    auto cmd = AllocCommand<CommandListFillBuffer>(CommandListOpcodeFillBuffer);
+    {
+        cmd->buffer     = dstBuffer->NativeSub;
+        cmd->offset     = dstOffset;
+        cmd->value      = value;
+        cmd->fillSize   = fillSize;
+    }
+}
+
+/* ----- Viewport and Scissor ----- */
+
+void CommandList::SetViewport(ViewportStruct viewport)
+{
+    auto cmd = AllocCommand<CommandListSetViewport>(CommandListOpcodeSetViewport);
+    {
+        cmd->viewport.x         = viewport.X;
+        cmd->viewport.y         = viewport.Y;
+        cmd->viewport.width     = viewport.Width;
+        cmd->viewport.height    = viewport.Height;
+        cmd->viewport.minDepth  = viewport.MinDepth;
+        cmd->viewport.maxDepth  = viewport.MaxDepth;
+    }
+}
+
+void CommandList::SetScissor(ScissorStruct scissor)
+{
+    auto cmd = AllocCommand<CommandListSetScissor>(CommandListOpcodeSetScissor);
+    {
+        cmd->scissor.x      = scissor.X;
+        cmd->scissor.y      = scissor.Y;
+        cmd->scissor.width  = scissor.Width;
+        cmd->scissor.height = scissor.Height;
+    }
+}
+
+/* ----- Input Assembly ------ */
+
+void CommandList::SetVertexBuffer(Buffer^ buffer)
+{
+    auto cmd = AllocCommand<CommandListSetVertexBuffer>(CommandListOpcodeSetVertexBuffer);
+    cmd->buffer = buffer->NativeSub;
+}
+
+void CommandList::SetVertexBufferArray(BufferArray^ bufferArray)
+{
+    auto cmd = AllocCommand<CommandListSetVertexBufferArray>(CommandListOpcodeSetVertexBufferArray);
+    cmd->bufferArray = bufferArray->Native;
+}
+
+void CommandList::SetIndexBuffer(Buffer^ buffer)
+{
+    auto cmd = AllocCommand<CommandListSetIndexBuffer>(CommandListOpcodeSetIndexBuffer);
+    cmd->buffer = buffer->NativeSub;
+}
+
+/* ----- Resource Heaps ----- */
+
+void CommandList::SetResourceHeap(ResourceHeap^ resourceHeap)
+{
+    SetResourceHeap(resourceHeap, 0, PipelineBindPoint::Undefined);
+}
+
+void CommandList::SetResourceHeap(ResourceHeap^ resourceHeap, unsigned int firstSet)
+{
+    SetResourceHeap(resourceHeap, firstSet, PipelineBindPoint::Undefined);
+}
+
+void CommandList::SetResourceHeap(ResourceHeap^ resourceHeap, unsigned int firstSet, PipelineBindPoint bindPoint)
+{
+    auto cmd = AllocCommand<CommandListSetResourceHeap>(CommandListOpcodeSetResourceHeap);
+    {
+        cmd->resourceHeap   = resourceHeap->Native;
+        cmd->firstSet       = firstSet;
+        cmd->bindPoint      = static_cast<LLGL::PipelineBindPoint>(bindPoint);
+    }
+}
+
+/* ----- Render Passes ----- */
+
+void CommandList::BeginRenderPass(RenderTarget^ renderTarget)
+{
+    BeginRenderPass(renderTarget, nullptr, nullptr);
+}
+
+void CommandList::BeginRenderPass(RenderTarget^ renderTarget, RenderPass^ renderPass)
+{
+    BeginRenderPass(renderTarget, renderPass, nullptr);
+}
+
+void CommandList::BeginRenderPass(RenderTarget^ renderTarget, RenderPass^ renderPass, array<ClearValueStruct>^ clearValues)
+{
+    const int numClearValues = (clearValues != nullptr ? clearValues->Length : 0);
+    const int clearValuesSize = static_cast<int>(sizeof(LLGL::ClearValue)) * numClearValues;
+
+    auto cmd = AllocCommand<CommandListBeginRenderPass>(CommandListOpcodeBeginRenderPass, clearValuesSize);
+    {
+        cmd->renderTarget   = renderTarget->Native;
+        cmd->renderPass     = (renderPass != nullptr ? renderPass->Native : nullptr);
+        cmd->numClearValues = static_cast<std::uint32_t>(numClearValues);
+        if (numClearValues > 0)
+        {
+            /* ClearValueStruct has the same memory layout as LLGL::ClearValue */
+            pin_ptr<ClearValueStruct> clearValuesRef = &clearValues[0];
+            ::memcpy(cmd + 1, clearValuesRef, clearValuesSize);
+        }
+    }
+}
+
+void CommandList::EndRenderPass()
+{
+    AllocOpcode(CommandListOpcodeEndRenderPass);
+}
+
+void CommandList::Clear(ClearFlags flags, ClearValueStruct clearValue)
+{
+    auto cmd = AllocCommand<CommandListClear>(CommandListOpcodeClear);
+    {
+        cmd->flags                  = static_cast<long>(flags);
+        cmd->clearValue.color       = { clearValue.R, clearValue.G, clearValue.B, clearValue.A };
+        cmd->clearValue.depth       = clearValue.Depth;
+        cmd->clearValue.stencil     = clearValue.Stencil;
+    }
+}
+
+/* ----- Pipeline States ----- */
+
+void CommandList::SetPipelineState(PipelineState^ pipelineState)
+{
+    auto cmd = AllocCommand<CommandListSetPipelineState>(CommandListOpcodeSetPipelineState);
+    cmd->pipelineState = pipelineState->Native;
+}
+
+void CommandList::SetBlendFactor(ColorRGBA<float>^ color)
+{
+    auto cmd = AllocCommand<CommandListSetBlendFactor>(CommandListOpcodeSetBlendFactor);
+    cmd->color = { color->R, color->G, color->B, color->A };
+}
+
+void CommandList::SetStencilReference(unsigned int reference)
+{
+    auto cmd = AllocCommand<CommandListSetStencilReference>(CommandListOpcodeSetStencilReference);
+    cmd->reference = reference;
+}
+
+/* ----- Drawing ----- */
+
+void CommandList::Draw(unsigned int numVertices, unsigned int firstVertex)
+{
+    auto cmd = AllocCommand<CommandListDraw>(CommandListOpcodeDraw);
+    {
+        cmd->numVertices = numVertices;
+        cmd->firstVertex = firstVertex;
+    }
+}
+
+void CommandList::DrawIndexed(unsigned int numIndices, unsigned int firstIndex)
+{
+    DrawIndexed(numIndices, firstIndex, 0);
+}
+
+void CommandList::DrawIndexed(unsigned int numIndices, unsigned int firstIndex, int vertexOffset)
+{
+    auto cmd = AllocCommand<CommandListDrawIndexed>(CommandListOpcodeDrawIndexed);
+    {
+        cmd->numIndices     = numIndices;
+        cmd->firstIndex     = firstIndex;
+        cmd->vertexOffset   = vertexOffset;
+    }
+}
+
+void CommandList::DrawInstanced(unsigned int numVertices, unsigned int firstVertex, unsigned int numInstances)
+{
+    DrawInstanced(numVertices, firstVertex, numInstances, 0);
+}
+
+void CommandList::DrawInstanced(unsigned int numVertices, unsigned int firstVertex, unsigned int numInstances, unsigned int firstInstance)
+{
+    auto cmd = AllocCommand<CommandListDrawInstanced>(CommandListOpcodeDrawInstanced);
+    {
+        cmd->numVertices    = numVertices;
+        cmd->firstVertex    = firstVertex;
+        cmd->numInstances   = numInstances;
+        cmd->firstInstance  = firstInstance;
+    }
+}
+
+void CommandList::DrawIndexedInstanced(unsigned int numIndices, unsigned int numInstances, unsigned int firstIndex)
+{
+    DrawIndexedInstanced(numIndices, numInstances, firstIndex, 0, 0);
+}
+
+void CommandList::DrawIndexedInstanced(unsigned int numIndices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset)
+{
+    DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, 0);
+}
+
+void CommandList::DrawIndexedInstanced(unsigned int numIndices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset, unsigned int firstInstance)
+{
+    auto cmd = AllocCommand<CommandListDrawIndexedInstanced>(CommandListOpcodeDrawIndexedInstanced);
+    {
+        cmd->numIndices     = numIndices;
+        cmd->numInstances   = numInstances;
+        cmd->firstIndex     = firstIndex;
+        cmd->vertexOffset   = vertexOffset;
+        cmd->firstInstance  = firstInstance;
+    }
+}
+
+void CommandList::DrawIndirect(Buffer^ buffer, System::UInt64 offset)
+{
+    DrawIndirect(buffer, offset, 1, 0);
+}
+
+void CommandList::DrawIndirect(Buffer^ buffer, System::UInt64 offset, unsigned int numCommands, unsigned int stride)
+{
+    auto cmd = AllocCommand<CommandListDrawIndirect>(CommandListOpcodeDrawIndirect);
+    {
+        cmd->buffer         = buffer->NativeSub;
+        cmd->offset         = offset;
+        cmd->numCommands    = numCommands;
+        cmd->stride         = stride;
+    }
+}
+
+void CommandList::DrawIndexedIndirect(Buffer^ buffer, System::UInt64 offset)
+{
+    DrawIndexedIndirect(buffer, offset, 1, 0);
+}
+
+void CommandList::DrawIndexedIndirect(Buffer^ buffer, System::UInt64 offset, unsigned int numCommands, unsigned int stride)
+{
+    auto cmd = AllocCommand<CommandListDrawIndirect>(CommandListOpcodeDrawIndexedIndirect);
+    {
+        cmd->buffer         = buffer->NativeSub;
+        cmd->offset         = offset;
+        cmd->numCommands    = numCommands;
+        cmd->stride         = stride;
+    }
+}
+
+/* ----- Compute ----- */
+
+void CommandList::Dispatch(unsigned int groupSizeX, unsigned int groupSizeY, unsigned int groupSizeZ)
+{
+    auto cmd = AllocCommand<CommandListDispatch>(CommandListOpcodeDispatch);
+    {
+        cmd->numWorkGroups[0] = groupSizeX;
+        cmd->numWorkGroups[1] = groupSizeY;
+        cmd->numWorkGroups[2] = groupSizeZ;
+    }
+}
+
+void CommandList::DispatchIndirect(Buffer^ buffer, System::UInt64 offset)
+{
+    auto cmd = AllocCommand<CommandListDispatchIndirect>(CommandListOpcodeDispatchIndirect);
+    {
+        cmd->buffer = buffer->NativeSub;
+        cmd->offset = offset;
+    }
+}
+
+/* ----- Debugging ----- */
+
+void CommandList::PushDebugGroup(String^ name)
+{
+    auto nameStr = ToStdString(name);
+    const int length = static_cast<int>(nameStr.size());
+
+    auto cmd = AllocCommand<CommandListPushDebugGroup>(CommandListOpcodePushDebugGroup, length + 1);
+    {
+        cmd->length = static_cast<std::uint32_t>(length);
+        ::memcpy(cmd + 1, nameStr.c_str(), length + 1);
+    }
+}
+
+void CommandList::PopDebugGroup()
+{
+    AllocOpcode(CommandListOpcodePopDebugGroup);
+}
+
+
+/* ----- Private ----- */
+
+void CommandList::Release()
+{
+    if (bufferHandle_.IsAllocated)
+        bufferHandle_.Free();
+    buffer_ = nullptr;
+    data_   = nullptr;
+}
+
+// Grows the pinned buffer to at least the specified size; the buffer is pinned for the entire lifetime of the list, so encoding never goes through the marshaller.
+void CommandList::Reserve(int size)
+{
+    if (buffer_ != nullptr && size <= buffer_->Length)
+        return;
+
+    const int capacity = (buffer_ != nullptr ? std::max(size, buffer_->Length * 2) : size);
+
+    auto newBuffer = gcnew array<Byte>(capacity);
+    auto newBufferHandle = GCHandle::Alloc(newBuffer, GCHandleType::Pinned);
+    auto newData = static_cast<std::uint8_t*>(newBufferHandle.AddrOfPinnedObject().ToPointer());
+
+    if (size_ > 0)
+        ::memcpy(newData, data_, size_);
+
+    Release();
+
+    buffer_         = newBuffer;
+    bufferHandle_   = newBufferHandle;
+    data_           = newData;
+}
+
+template <typename TCommand>
+TCommand* CommandList::AllocCommand(const CommandListOpcode opcode, int payloadSize)
+{
+    const int commandSize = static_cast<int>(sizeof(CommandListOpcode) + sizeof(TCommand)) + payloadSize;
+    Reserve(size_ + commandSize);
+
+    auto pc = data_ + size_;
+    *reinterpret_cast<CommandListOpcode*>(pc) = opcode;
+
+    size_ += commandSize;
+    ++numCommands_;
+
+    return reinterpret_cast<TCommand*>(pc + sizeof(CommandListOpcode));
+}
+
+template <typename TCommand>
+TCommand* CommandList::AllocCommand(const CommandListOpcode opcode)
+{
+    return AllocCommand<TCommand>(opcode, 0);
+}
+
+void CommandList::AllocOpcode(const CommandListOpcode opcode)
+{
+    Reserve(size_ + static_cast<int>(sizeof(CommandListOpcode)));
+    data_[size_] = opcode;
+    size_ += static_cast<int>(sizeof(CommandListOpcode));
+    ++numCommands_;
+}
+
+
+} // /namespace SharpLLGL
+
+
+
+// ================================================================================
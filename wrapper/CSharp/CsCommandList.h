@@ -0,0 +1,173 @@
+/*
+ * CsCommandList.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#pragma once
+
+#include <vcclr.h>
+#include "CsCommandListOpcode.h"
+#include "CsRenderSystemChild.h"
+#include "CsCommandBufferFlags.h"
+#include "CsPipelineStateFlags.h"
+#include "CsRenderTarget.h"
+#include "CsColor.h"
+
+#using <System.dll>
+#using <System.Core.dll>
+#using <System.Runtime.InteropServices.dll>
+
+
+using namespace System;
+using namespace System::Runtime::InteropServices;
+
+
+namespace SharpLLGL
+{
+
+
+/// <summary>
+/// Compact encoder for command buffer commands on the managed side.
+/// All commands are written as opcodes into a pinned byte buffer without any managed-to-native transitions,
+/// and CommandBuffer.Execute replays the entire list with a single native call.
+/// </summary>
+/// <remarks>
+/// The list only stores the native objects of its resources, so they must stay alive until the list has been executed.
+/// A command list can be executed multiple times and is cleared with Reset.
+/// </remarks>
+public ref class CommandList
+{
+
+    public:
+
+        /* ----- Common ----- */
+
+        CommandList();
+        CommandList(int initialCapacity);
+
+        ~CommandList();
+        !CommandList();
+
+        /// <summary>Clears all commands but keeps the capacity of the internal buffer.</summary>
+        void Reset();
+
+        /// <summary>Returns the number of bytes of all encoded commands.</summary>
+        property int Size
+        {
+            int get();
+        }
+
+        /// <summary>Returns the number of encoded commands.</summary>
+        property int NumCommands
+        {
+            int get();
+        }
+
+        /* ----- Encoding ----- */
+
+        generic <typename T> where T : value class
+        void UpdateBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, array<T>^ data);
+
+        void UpdateBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, IntPtr data, System::UInt16 dataSize);
+
+        void CopyBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, Buffer^ srcBuffer, System::UInt64 srcOffset, System::UInt64 size);
+
+        void FillBuffer(Buffer^ dstBuffer, System::UInt64 dstOffset, unsigned int value, System::UInt64 fillSize);
+
+        /* ----- Viewport and Scissor ----- */
+
+        void SetViewport(ViewportStruct viewport);
+        void SetScissor(ScissorStruct scissor);
+
+        /* ----- Input Assembly ------ */
+
+        void SetVertexBuffer(Buffer^ buffer);
+        void SetVertexBufferArray(BufferArray^ bufferArray);
+        void SetIndexBuffer(Buffer^ buffer);
+
+        /* ----- Resource Heaps ----- */
+
+        void SetResourceHeap(ResourceHeap^ resourceHeap);
+        void SetResourceHeap(ResourceHeap^ resourceHeap, unsigned int firstSet);
+        void SetResourceHeap(ResourceHeap^ resourceHeap, unsigned int firstSet, PipelineBindPoint bindPoint);
+
+        /* ----- Render Passes ----- */
+
+        void BeginRenderPass(RenderTarget^ renderTarget);
+        void BeginRenderPass(RenderTarget^ renderTarget, RenderPass^ renderPass);
+        void BeginRenderPass(RenderTarget^ renderTarget, RenderPass^ renderPass, array<ClearValueStruct>^ clearValues);
+
+        void EndRenderPass();
+
+        void Clear(ClearFlags flags, ClearValueStruct clearValue);
+
+        /* ----- Pipeline States ----- */
+
+        void SetPipelineState(PipelineState^ pipelineState);
+        void SetBlendFactor(ColorRGBA<float>^ color);
+        void SetStencilReference(unsigned int reference);
+
+        /* ----- Drawing ----- */
+
+        void Draw(unsigned int numVertices, unsigned int firstVertex);
+        void DrawIndexed(unsigned int numIndices, unsigned int firstIndex);
+        void DrawIndexed(unsigned int numIndices, unsigned int firstIndex, int vertexOffset);
+        void DrawInstanced(unsigned int numVertices, unsigned int firstVertex, unsigned int numInstances);
+        void DrawInstanced(unsigned int numVertices, unsigned int firstVertex, unsigned int numInstances, unsigned int firstInstance);
+        void DrawIndexedInstanced(unsigned int numIndices, unsigned int numInstances, unsigned int firstIndex);
+        void DrawIndexedInstanced(unsigned int numIndices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset);
+        void DrawIndexedInstanced(unsigned int numIndices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset, unsigned int firstInstance);
+
+        void DrawIndirect(Buffer^ buffer, System::UInt64 offset);
+        void DrawIndirect(Buffer^ buffer, System::UInt64 offset, unsigned int numCommands, unsigned int stride);
+        void DrawIndexedIndirect(Buffer^ buffer, System::UInt64 offset);
+        void DrawIndexedIndirect(Buffer^ buffer, System::UInt64 offset, unsigned int numCommands, unsigned int stride);
+
+        /* ----- Compute ----- */
+
+        void Dispatch(unsigned int groupSizeX, unsigned int groupSizeY, unsigned int groupSizeZ);
+        void DispatchIndirect(Buffer^ buffer, System::UInt64 offset);
+
+        /* ----- Debugging ----- */
+
+        void PushDebugGroup(String^ name);
+        void PopDebugGroup();
+
+    internal:
+
+        property const std::uint8_t* NativeData
+        {
+            const std::uint8_t* get();
+        }
+
+    private:
+
+        void Release();
+        void Reserve(int size);
+
+        template <typename TCommand>
+        TCommand* AllocCommand(const CommandListOpcode opcode, int payloadSize);
+
+        template <typename TCommand>
+        TCommand* AllocCommand(const CommandListOpcode opcode);
+
+        void AllocOpcode(const CommandListOpcode opcode);
+
+    private:
+
+        array<Byte>^    buffer_;
+        GCHandle        bufferHandle_;
+        std::uint8_t*   data_           = nullptr;
+        int             size_           = 0;
+        int             numCommands_    = 0;
+
+};
+
+
+} // /namespace SharpLLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,207 @@
+/*
+ * CsCommandListExecutor.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "CsCommandListExecutor.h"
+#include "CsCommandListOpcode.h"
+
+
+/*
+The entire decoder is compiled to native code, so replaying a command list with thousands of commands
+only requires a single managed-to-native transition (in CommandBuffer::Execute) instead of one per command.
+*/
+#pragma managed(push, off)
+
+namespace SharpLLGL
+{
+
+
+static std::size_t ExecuteNativeCommand(LLGL::CommandBuffer& cmdBuffer, const CommandListOpcode opcode, const std::uint8_t* pc)
+{
+    switch (opcode)
+    {
+        case CommandListOpcodeUpdateBuffer:
+        {
+            auto cmd = reinterpret_cast<const CommandListUpdateBuffer*>(pc);
+            cmdBuffer.UpdateBuffer(*(cmd->buffer), cmd->offset, cmd + 1, cmd->size);
+            return (sizeof(*cmd) + cmd->size);
+        }
+        case CommandListOpcodeCopyBuffer:
+        {
+            auto cmd = reinterpret_cast<const CommandListCopyBuffer*>(pc);
+            cmdBuffer.CopyBuffer(*(cmd->dstBuffer), cmd->dstOffset, *(cmd->srcBuffer), cmd->srcOffset, cmd->size);
+            return sizeof(*cmd);
+        }
+        case CommandListOpcodeFillBuffer:
+        {
+            auto cmd = reinterpret_cast<const CommandListFillBuffer*>(pc);
+            cmdBuffer.FillBuffer(*(cmd->buffer), cmd->offset, cmd->value, cmd->fillSize);
+            return sizeof(*cmd);
+        }
+        case CommandListOpcodeSetViewport:
+        {
+            auto cmd = reinterpret_cast<const CommandListSetViewport*>(pc);
+            cmdBuffer.SetViewport(cmd->viewport);
+            return sizeof(*cmd);
+        }
+        case CommandListOpcodeSetScissor:
+        {
+            auto cmd = reinterpret_cast<const CommandListSetScissor*>(pc);
+            cmdBuffer.SetScissor(cmd->scissor);
+            return sizeof(*cmd);
+        }
+        case CommandListOpcodeSetVertexBuffer:
+        {
+            auto cmd = reinterpret_cast<const CommandListSetVertexBuffer*>(pc);
+            cmdBuffer.SetVertexBuffer(*(cmd->buffer));
+            return sizeof(*cmd);
+        }
+        case CommandListOpcodeSetVertexBufferArray:
+        {
+            auto cmd = reinterpret_cast<const CommandListSetVertexBufferArray*>(pc);
+            cmdBuffer.SetVertexBufferArray(*(cmd->bufferArray));
+            return sizeof(*cmd);
+        }
+        case CommandListOpcodeSetIndexBuffer:
+        {
+            auto cmd = reinterpret_cast<const CommandListSetIndexBuffer*>(pc);
+            cmdBuffer.SetIndexBuffer(*(cmd->buffer));
+            return sizeof(*cmd);
+        }
+        case CommandListOpcodeSetResourceHeap:
+        {
+            auto cmd = reinterpret_cast<const CommandListSetResourceHeap*>(pc);
+            cmdBuffer.SetResourceHeap(*(cmd->resourceHeap), cmd->firstSet, cmd->bindPoint);
+            return sizeof(*cmd);
+        }
+        case CommandListOpcodeBeginRenderPass:
+        {
+            auto cmd = reinterpret_cast<const CommandListBeginRenderPass*>(pc);
+            cmdBuffer.BeginRenderPass(
+                *(cmd->renderTarget),
+                cmd->renderPass,
+                cmd->numClearValues,
+                (cmd->numClearValues > 0 ? reinterpret_cast<const LLGL::ClearValue*>(cmd + 1) : nullptr)
+            );
+            return (sizeof(*cmd) + sizeof(LLGL::ClearValue) * cmd->numClearValues);
+        }
+        case CommandListOpcodeEndRenderPass:
+        {
+            cmdBuffer.EndRenderPass();
+            return 0;
+        }
+        case CommandListOpcodeClear:
+        {
+            auto cmd = reinterpret_cast<const CommandListClear*>(pc);
+            cmdBuffer.Clear(cmd->flags, cmd->clearValue);
+            return sizeof(*cmd);
+        }
+        case CommandListOpcodeSetPipelineState:
+        {
+            auto cmd = reinterpret_cast<const CommandListSetPipelineState*>(pc);
+            cmdBuffer.SetPipelineState(*(cmd->pipelineState));
+            return sizeof(*cmd);
+        }
+        case CommandListOpcodeSetBlendFactor:
+        {
+            auto cmd = reinterpret_cast<const CommandListSetBlendFactor*>(pc);
+            cmdBuffer.SetBlendFactor(cmd->color);
+            return sizeof(*cmd);
+        }
+        case CommandListOpcodeSetStencilReference:
+        {
+            auto cmd = reinterpret_cast<const CommandListSetStencilReference*>(pc);
+            cmdBuffer.SetStencilReference(cmd->reference);
+            return sizeof(*cmd);
+        }
+        case CommandListOpcodeDraw:
+        {
+            auto cmd = reinterpret_cast<const CommandListDraw*>(pc);
+            cmdBuffer.Draw(cmd->numVertices, cmd->firstVertex);
+            return sizeof(*cmd);
+        }
+        case CommandListOpcodeDrawIndexed:
+        {
+            auto cmd = reinterpret_cast<const CommandListDrawIndexed*>(pc);
+            cmdBuffer.DrawIndexed(cmd->numIndices, cmd->firstIndex, cmd->vertexOffset);
+            return sizeof(*cmd);
+        }
+        case CommandListOpcodeDrawInstanced:
+        {
+            auto cmd = reinterpret_cast<const CommandListDrawInstanced*>(pc);
+            cmdBuffer.DrawInstanced(cmd->numVertices, cmd->firstVertex, cmd->numInstances, cmd->firstInstance);
+            return sizeof(*cmd);
+        }
+        case CommandListOpcodeDrawIndexedInstanced:
+        {
+            auto cmd = reinterpret_cast<const CommandListDrawIndexedInstanced*>(pc);
+            cmdBuffer.DrawIndexedInstanced(cmd->numIndices, cmd->numInstances, cmd->firstIndex, cmd->vertexOffset, cmd->firstInstance);
+            return sizeof(*cmd);
+        }
+        case CommandListOpcodeDrawIndirect:
+        {
+            auto cmd = reinterpret_cast<const CommandListDrawIndirect*>(pc);
+            cmdBuffer.DrawIndirect(*(cmd->buffer), cmd->offset, cmd->numCommands, cmd->stride);
+            return sizeof(*cmd);
+        }
+        case CommandListOpcodeDrawIndexedIndirect:
+        {
+            auto cmd = reinterpret_cast<const CommandListDrawIndirect*>(pc);
+            cmdBuffer.DrawIndexedIndirect(*(cmd->buffer), cmd->offset, cmd->numCommands, cmd->stride);
+            return sizeof(*cmd);
+        }
+        case CommandListOpcodeDispatch:
+        {
+            auto cmd = reinterpret_cast<const CommandListDispatch*>(pc);
+            cmdBuffer.Dispatch(cmd->numWorkGroups[0], cmd->numWorkGroups[1], cmd->numWorkGroups[2]);
+            return sizeof(*cmd);
+        }
+        case CommandListOpcodeDispatchIndirect:
+        {
+            auto cmd = reinterpret_cast<const CommandListDispatchIndirect*>(pc);
+            cmdBuffer.DispatchIndirect(*(cmd->buffer), cmd->offset);
+            return sizeof(*cmd);
+        }
+        case CommandListOpcodePushDebugGroup:
+        {
+            auto cmd = reinterpret_cast<const CommandListPushDebugGroup*>(pc);
+            cmdBuffer.PushDebugGroup(reinterpret_cast<const char*>(cmd + 1));
+            return (sizeof(*cmd) + cmd->length + 1);
+        }
+        case CommandListOpcodePopDebugGroup:
+        {
+            cmdBuffer.PopDebugGroup();
+            return 0;
+        }
+        default:
+            return 0;
+    }
+}
+
+void ExecuteNativeCommandList(LLGL::CommandBuffer& commandBuffer, const std::uint8_t* data, std::size_t size)
+{
+    auto pc     = data;
+    auto pcEnd  = data + size;
+
+    while (pc < pcEnd)
+    {
+        /* Read opcode */
+        const CommandListOpcode opcode = *reinterpret_cast<const CommandListOpcode*>(pc);
+        pc += sizeof(CommandListOpcode);
+
+        /* Execute command and increment program counter */
+        pc += ExecuteNativeCommand(commandBuffer, opcode, pc);
+    }
+}
+
+
+} // /namespace SharpLLGL
+
+#pragma managed(pop)
+
+
+
+// ================================================================================
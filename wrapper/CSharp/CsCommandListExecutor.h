@@ -0,0 +1,27 @@
+/*
+ * CsCommandListExecutor.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#pragma once
+
+#include <LLGL/CommandBuffer.h>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace SharpLLGL
+{
+
+
+// Decodes the specified native command list and replays all its commands against the native command buffer.
+void ExecuteNativeCommandList(LLGL::CommandBuffer& commandBuffer, const std::uint8_t* data, std::size_t size);
+
+
+} // /namespace SharpLLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,204 @@
+/*
+ * CsCommandListOpcode.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#pragma once
+
+#include <LLGL/CommandBuffer.h>
+#include <cstdint>
+
+
+namespace SharpLLGL
+{
+
+
+/*
+Opcodes and command structures of the native command list that is encoded by the managed CommandList class.
+The layout follows the virtual command buffers of the GL and Null backends:
+each command is a 1-byte opcode, followed by its command structure and an optional payload (e.g. buffer data or a string).
+Commands are tightly packed, so all structures are read and written at unaligned addresses (which is supported on all platforms of this wrapper).
+*/
+enum CommandListOpcode : std::uint8_t
+{
+    CommandListOpcodeUpdateBuffer = 1,
+    CommandListOpcodeCopyBuffer,
+    CommandListOpcodeFillBuffer,
+    CommandListOpcodeSetViewport,
+    CommandListOpcodeSetScissor,
+    CommandListOpcodeSetVertexBuffer,
+    CommandListOpcodeSetVertexBufferArray,
+    CommandListOpcodeSetIndexBuffer,
+    CommandListOpcodeSetResourceHeap,
+    CommandListOpcodeBeginRenderPass,
+    CommandListOpcodeEndRenderPass,
+    CommandListOpcodeClear,
+    CommandListOpcodeSetPipelineState,
+    CommandListOpcodeSetBlendFactor,
+    CommandListOpcodeSetStencilReference,
+    CommandListOpcodeDraw,
+    CommandListOpcodeDrawIndexed,
+    CommandListOpcodeDrawInstanced,
+    CommandListOpcodeDrawIndexedInstanced,
+    CommandListOpcodeDrawIndirect,
+    CommandListOpcodeDrawIndexedIndirect,
+    CommandListOpcodeDispatch,
+    CommandListOpcodeDispatchIndirect,
+    CommandListOpcodePushDebugGroup,
+    CommandListOpcodePopDebugGroup,
+};
+
+
+#pragma pack(push, 1)
+
+struct CommandListUpdateBuffer
+{
+    LLGL::Buffer*   buffer;
+    std::uint64_t   offset;
+    std::uint16_t   size;
+//  std::uint8_t    data[size];
+};
+
+struct CommandListCopyBuffer
+{
+    LLGL::Buffer*   dstBuffer;
+    std::uint64_t   dstOffset;
+    LLGL::Buffer*   srcBuffer;
+    std::uint64_t   srcOffset;
+    std::uint64_t   size;
+};
+
+struct CommandListFillBuffer
+{
+    LLGL::Buffer*   buffer;
+    std::uint64_t   offset;
+    std::uint32_t   value;
+    std::uint64_t   fillSize;
+};
+
+struct CommandListSetViewport
+{
+    LLGL::Viewport viewport;
+};
+
+struct CommandListSetScissor
+{
+    LLGL::Scissor scissor;
+};
+
+struct CommandListSetVertexBuffer
+{
+    LLGL::Buffer* buffer;
+};
+
+struct CommandListSetVertexBufferArray
+{
+    LLGL::BufferArray* bufferArray;
+};
+
+struct CommandListSetIndexBuffer
+{
+    LLGL::Buffer* buffer;
+};
+
+struct CommandListSetResourceHeap
+{
+    LLGL::ResourceHeap*     resourceHeap;
+    std::uint32_t           firstSet;
+    LLGL::PipelineBindPoint bindPoint;
+};
+
+struct CommandListBeginRenderPass
+{
+    LLGL::RenderTarget* renderTarget;
+    LLGL::RenderPass*   renderPass;
+    std::uint32_t       numClearValues;
+//  LLGL::ClearValue    clearValues[numClearValues];
+};
+
+struct CommandListClear
+{
+    long                flags;
+    LLGL::ClearValue    clearValue;
+};
+
+struct CommandListSetPipelineState
+{
+    LLGL::PipelineState* pipelineState;
+};
+
+struct CommandListSetBlendFactor
+{
+    LLGL::ColorRGBAf color;
+};
+
+struct CommandListSetStencilReference
+{
+    std::uint32_t reference;
+};
+
+struct CommandListDraw
+{
+    std::uint32_t numVertices;
+    std::uint32_t firstVertex;
+};
+
+struct CommandListDrawIndexed
+{
+    std::uint32_t   numIndices;
+    std::uint32_t   firstIndex;
+    std::int32_t    vertexOffset;
+};
+
+struct CommandListDrawInstanced
+{
+    std::uint32_t numVertices;
+    std::uint32_t firstVertex;
+    std::uint32_t numInstances;
+    std::uint32_t firstInstance;
+};
+
+struct CommandListDrawIndexedInstanced
+{
+    std::uint32_t   numIndices;
+    std::uint32_t   numInstances;
+    std::uint32_t   firstIndex;
+    std::int32_t    vertexOffset;
+    std::uint32_t   firstInstance;
+};
+
+struct CommandListDrawIndirect
+{
+    LLGL::Buffer*   buffer;
+    std::uint64_t   offset;
+    std::uint32_t   numCommands;
+    std::uint32_t   stride;
+};
+
+struct CommandListDispatch
+{
+    std::uint32_t numWorkGroups[3];
+};
+
+struct CommandListDispatchIndirect
+{
+    LLGL::Buffer*   buffer;
+    std::uint64_t   offset;
+};
+
+struct CommandListPushDebugGroup
+{
+    std::uint32_t length;
+//  char          name[length + 1];
+};
+
+#pragma pack(pop)
+
+
+} // /namespace SharpLLGL
+
+
+
+// ================================================================================
@@ -116,6 +116,44 @@ Scissor::Scissor(Offset2D^ offset, Extent2D^ extent)
 }
 
 
+/*
+ * ViewportStruct class
+ */
+
+ViewportStruct::ViewportStruct(float x, float y, float width, float height)
+{
+    X           = x;
+    Y           = y;
+    Width       = width;
+    Height      = height;
+    MinDepth    = 0.0f;
+    MaxDepth    = 1.0f;
+}
+
+ViewportStruct::ViewportStruct(float x, float y, float width, float height, float minDepth, float maxDepth)
+{
+    X           = x;
+    Y           = y;
+    Width       = width;
+    Height      = height;
+    MinDepth    = minDepth;
+    MaxDepth    = maxDepth;
+}
+
+
+/*
+ * ScissorStruct class
+ */
+
+ScissorStruct::ScissorStruct(int x, int y, int width, int height)
+{
+    X       = x;
+    Y       = y;
+    Width   = width;
+    Height  = height;
+}
+
+
 /*
  * DepthDescriptor class
  */
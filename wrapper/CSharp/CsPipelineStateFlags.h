@@ -204,6 +204,47 @@ public ref class Scissor
 
 };
 
+/*
+Blittable value type with the same memory layout as LLGL::Viewport.
+Arrays of this type are passed to the native command buffer without any intermediate copies.
+*/
+[StructLayout(LayoutKind::Sequential)]
+public value class ViewportStruct
+{
+
+    public:
+
+        ViewportStruct(float x, float y, float width, float height);
+        ViewportStruct(float x, float y, float width, float height, float minDepth, float maxDepth);
+
+        float X;
+        float Y;
+        float Width;
+        float Height;
+        float MinDepth;
+        float MaxDepth;
+
+};
+
+/*
+Blittable value type with the same memory layout as LLGL::Scissor.
+Arrays of this type are passed to the native command buffer without any intermediate copies.
+*/
+[StructLayout(LayoutKind::Sequential)]
+public value class ScissorStruct
+{
+
+    public:
+
+        ScissorStruct(int x, int y, int width, int height);
+
+        int X;
+        int Y;
+        int Width;
+        int Height;
+
+};
+
 public ref class DepthDescriptor
 {
 